@@ -23,8 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/AbstractAsyncResourceLoader.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -40,6 +42,28 @@
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
 
+Containers::Optional<Image2D> decodeImage(ResourceKey key);
+
+/* [AbstractAsyncResourceLoader-implementation] */
+class ImageResourceLoader: public AbstractAsyncResourceLoader<Image2D> {
+    public:
+        ~ImageResourceLoader() { finish(); }
+
+    private:
+        /* Executed on a worker thread */
+        Containers::Pointer<Image2D> doDecode(ResourceKey key) override {
+            Containers::Optional<Image2D> image = decodeImage(key);
+            if(!image) return nullptr;
+
+            return Containers::pointer<Image2D>(std::move(*image));
+        }
+
+        std::size_t doByteSize(const Image2D& image) const override {
+            return image.data().size();
+        }
+};
+/* [AbstractAsyncResourceLoader-implementation] */
+
 #ifdef MAGNUM_TARGET_GL
 Containers::Pointer<GL::Mesh> mesh;
 bool found = false;
@@ -277,4 +301,35 @@ Resource<GL::Mesh> myMesh = manager.get<GL::Mesh>("my-mesh");
 }
 #endif
 
+{
+/* [AbstractAsyncResourceLoader-use] */
+ResourceManager<Image2D> manager;
+Containers::Pointer<ImageResourceLoader> loaderPtr{Containers::InPlaceInit};
+ImageResourceLoader& loader = *loaderPtr;
+manager.setLoader<Image2D>(std::move(loaderPtr));
+
+// Queues the image for decoding, it's in the Loading state until committed
+Resource<Image2D> image = manager.get<Image2D>("image.png");
+
+// Each frame, commit decoded images for at most 2 ms or 16 MB
+loader.commit(std::chrono::milliseconds{2}, 16*1024*1024);
+/* [AbstractAsyncResourceLoader-use] */
+}
+
+{
+Image2D image{PixelFormat::RGBA8Unorm};
+/* [ResourceManager-eviction] */
+ResourceManager<Image2D> manager;
+
+// Keep at most 256 MB of images around
+manager.setByteBudget<Image2D>(256*1024*1024);
+
+// Add an image that can be evicted once it's not used anymore
+const std::size_t size = image.data().size();
+manager.set("image.png", std::move(image),
+        ResourceDataState::Final, ResourcePolicy::Manual)
+    .setByteSize<Image2D>("image.png", size);
+/* [ResourceManager-eviction] */
+}
+
 }
@@ -30,6 +30,7 @@
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Quaternion.h"
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Animation/CompressedTrack.h"
 #include "Magnum/Animation/Easing.h"
 #include "Magnum/Animation/Player.h"
 
@@ -317,6 +318,24 @@ Vector2 position = jump.at(2.2f, hint);         // y = 0.775, hint = 2
 static_cast<void>(position);
 }
 
+{
+const Animation::TrackView<const Float, const Vector3> translation;
+const Animation::TrackView<const Float, const Quaternion> rotation;
+/* [CompressedTrack-usage] */
+/* Allow at most 0.5 mm translation and 0.05° rotation error */
+Animation::CompressedTrack<Vector3> compressedTranslation{translation, 0.0005f};
+Animation::CompressedTrack<Quaternion> compressedRotation{rotation,
+    Float(Rad(0.05_degf))};
+
+Vector3 objectTranslation;
+Quaternion objectRotation;
+
+Animation::Player<Float> player;
+player.add(compressedTranslation, objectTranslation)
+      .add(compressedRotation, objectRotation);
+/* [CompressedTrack-usage] */
+}
+
 {
 const Animation::Track<Float, Vector2> jump;
 /* [Track-performance-strict] */
@@ -23,8 +23,19 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
 #include "Magnum/Audio/Context.h"
 #include "Magnum/Audio/Extensions.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamPlayer.h"
+#include "Magnum/Audio/VoicePool.h"
+#include "Magnum/Math/Vector3.h"
 
 using namespace Magnum;
 
@@ -40,6 +51,56 @@ if(Audio::Context::current().isExtensionSupported<Audio::Extensions::ALC::SOFTX:
 /* [Context-isExtensionSupported] */
 }
 
+{
+Containers::Pointer<Audio::AbstractImporter> importer;
+/* [AbstractImporter-streaming] */
+importer->openFile("music.wav");
+
+Containers::Array<char> chunk{Containers::NoInit,
+    16384*Audio::bufferFormatFrameSize(importer->format())};
+for(std::size_t offset = 0, count;
+    (count = importer->readFrames(offset, chunk)) != 0;
+    offset += count)
+{
+    // process count frames in chunk ...
+}
+/* [AbstractImporter-streaming] */
+}
+
+{
+/* [StreamPlayer] */
+PluginManager::Manager<Audio::AbstractImporter> manager;
+Containers::Pointer<Audio::AbstractImporter> importer =
+    manager.loadAndInstantiate("WavAudioImporter");
+importer->openFile("music.wav");
+
+Audio::Source source;
+Audio::StreamPlayer player{source, *importer};
+player.setLooping(true)
+    .play();
+/* [StreamPlayer] */
+}
+
+{
+Audio::Buffer footstep;
+Vector3 position, listenerPosition;
+Float timeDelta{};
+/* [VoicePool] */
+Audio::VoicePool pool{32};
+
+/* Thousands of emitters, but at most 32 of them mixed at a time */
+for(std::size_t i = 0; i != 5000; ++i) {
+    UnsignedInt id = pool.addEmitter(footstep);
+    pool.setPosition(id, position)
+        .setLooping(id, true)
+        .play(id);
+}
+
+// every frame
+pool.update(listenerPosition, timeDelta);
+/* [VoicePool] */
+}
+
 {
 /* [MAGNUM_ASSERT_AUDIO_EXTENSION_SUPPORTED] */
 MAGNUM_ASSERT_AUDIO_EXTENSION_SUPPORTED(Audio::Extensions::ALC::SOFTX::HRTF);
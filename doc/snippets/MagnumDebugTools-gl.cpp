@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
@@ -31,26 +32,42 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/ColorMap.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/DebugTools/DebugDraw.h"
+#include "Magnum/DebugTools/DynamicResolution.h"
 #include "Magnum/DebugTools/ForceRenderer.h"
 #include "Magnum/DebugTools/FrameProfiler.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/DebugTools/ObjectRenderer.h"
 #include "Magnum/DebugTools/TextureImage.h"
+#include "Magnum/DebugTools/ZoneProfiler.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/CubeMapTexture.h"
+#include "Magnum/GL/DefaultFramebuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Bezier.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/FlattenCurves.h"
+#include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 
 #ifndef MAGNUM_TARGET_GLES
+#include "Magnum/DebugTools/DrawableStatistics.h"
 #include "Magnum/GL/SampleQuery.h"
 #endif
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/BufferImage.h"
 #endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/DebugTools/ObjectPicker.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Shaders/Phong.h"
+#endif
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -107,6 +124,58 @@ new DebugTools::ForceRenderer3D(manager, *object, {0.3f, 1.5f, -0.7f}, force,
 /* [ForceRenderer] */
 }
 
+{
+Containers::ArrayView<const Vector3> navmeshEdges;
+Vector3 contactPoint;
+Range3D bounds;
+SceneGraph::Camera3D* camera{};
+Float frameTime{};
+/* [DebugDraw-usage] */
+DebugTools::DebugDraw debugDraw;
+
+// Shown only in the current frame
+debugDraw.addLines(navmeshEdges, 0x2f83cc_rgbf)
+    .addBox(bounds, 0xdcdcdc_rgbf);
+
+// Stays for two seconds, drawn on top of everything
+debugDraw
+    .setLifetime(2.0f)
+    .setDepthTest(false)
+    .addPoint(contactPoint, 0.1f, 0xcd3431_rgbf)
+    .setLifetime(0.0f)
+    .setDepthTest(true);
+
+// After drawing the scene
+debugDraw.draw(camera->projectionMatrix()*camera->cameraMatrix());
+debugDraw.advance(frameTime);
+/* [DebugDraw-usage] */
+}
+
+{
+DebugTools::DebugDraw debugDraw;
+Containers::ArrayView<const CubicBezier3D> cables;
+/* [DebugDraw-addLineStrips] */
+Containers::Array<UnsignedInt> offsets{NoInit, cables.size() + 1};
+Containers::Array<Vector3> positions{NoInit,
+    MeshTools::flattenCurvesOffsetsInto(cables, 0.01f, offsets)};
+MeshTools::flattenCurvesInto(cables, offsets, positions);
+
+debugDraw.addLineStrips(positions, offsets, 0x3bd267_rgbf);
+/* [DebugDraw-addLineStrips] */
+}
+
+{
+DebugTools::ResourceManager manager;
+SceneGraph::Camera3D* camera{};
+/* [ForceRenderer-instanced] */
+// Contains only force renderers
+SceneGraph::DrawableGroup3D forceDrawables;
+
+// In place of camera->draw(forceDrawables)
+DebugTools::ForceRenderer3D::drawInstanced(manager, *camera, forceDrawables);
+/* [ForceRenderer-instanced] */
+}
+
 #ifndef MAGNUM_TARGET_GLES
 {
 /* [FrameProfiler-setup-delayed] */
@@ -134,6 +203,31 @@ DebugTools::FrameProfiler profiler{{
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+{
+SceneGraph::Drawable3D* terrain{};
+SceneGraph::Drawable3D* treeA{};
+SceneGraph::Drawable3D* treeB{};
+SceneGraph::Camera3D* camera{};
+SceneGraph::DrawableGroup3D drawables;
+/* [DrawableStatistics-usage] */
+DebugTools::DrawableStatistics3D statistics;
+
+// Trees share the same mesh and shader, aggregate them together
+statistics
+    .setName(*treeA, "tree")
+    .setName(*treeB, "tree")
+    .setName(*terrain, "terrain");
+
+// In place of camera->draw(drawables)
+statistics.draw(*camera, drawables);
+
+for(const DebugTools::DrawableStatistics3D::Entry& entry: statistics.entries())
+    Debug{} << entry.name << entry.vertexFetchRatio() << entry.samplesPassed;
+/* [DrawableStatistics-usage] */
+}
+#endif
+
 {
 SceneGraph::Object<SceneGraph::MatrixTransformation3D>* object{};
 /* [ObjectRenderer] */
@@ -148,6 +242,18 @@ new DebugTools::ObjectRenderer3D{manager, *object, "my", &debugDrawables};
 /* [ObjectRenderer] */
 }
 
+{
+DebugTools::ResourceManager manager;
+SceneGraph::Camera3D* camera{};
+/* [ObjectRenderer-instanced] */
+// Contains only object renderers
+SceneGraph::DrawableGroup3D objectDrawables;
+
+// In place of camera->draw(objectDrawables)
+DebugTools::ObjectRenderer3D::drawInstanced(manager, *camera, objectDrawables);
+/* [ObjectRenderer-instanced] */
+}
+
 {
 /* [GLFrameProfiler-usage] */
 DebugTools::GLFrameProfiler profiler{
@@ -156,6 +262,49 @@ DebugTools::GLFrameProfiler profiler{
 /* [GLFrameProfiler-usage] */
 }
 
+{
+auto drawShadows = []() {};
+/* [GLZoneProfiler-usage] */
+DebugTools::GLZoneProfiler profiler;
+
+// Every frame
+{
+    DebugTools::ZoneProfiler::Zone zone{profiler, "shadow pass"};
+    DebugTools::GLZoneProfiler::GpuZone gpuZone{profiler, "shadow pass"};
+    drawShadows();
+}
+
+// Record GPU zones that finished in previous frames
+profiler.collect();
+/* [GLZoneProfiler-usage] */
+}
+
+#if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+{
+Vector2i windowSize;
+auto drawScene = []() {};
+/* [GLDynamicResolution-usage] */
+DebugTools::GLFrameProfiler profiler{
+    DebugTools::GLFrameProfiler::Value::GpuDuration, 4};
+DebugTools::GLDynamicResolution resolution{windowSize,
+    GL::TextureFormat::RGBA8, GL::RenderbufferFormat::DepthComponent24,
+    14.0e6};
+/* The GPU duration is delayed by 3 frames and averaged over 4 */
+resolution.setCooldown(3 + 4);
+
+// Every frame
+profiler.beginFrame();
+resolution.update(profiler);
+resolution.framebuffer()
+    .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+    .bind();
+drawScene();
+resolution.blit(GL::defaultFramebuffer);
+profiler.endFrame();
+/* [GLDynamicResolution-usage] */
+}
+#endif
+
 {
 GL::Texture2D texture;
 Range2Di rect;
@@ -196,6 +345,64 @@ GL::BufferImage2D image = DebugTools::textureSubImage(texture,
 /* [textureSubImage-cubemap-rvalue-buffer] */
 }
 #endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Framebuffer framebuffer{{}};
+auto save = [](const Image2D&) {};
+/* [AsyncReadback-usage] */
+DebugTools::AsyncReadback readback{3};
+UnsignedInt pending[3]{};
+
+// Every frame, after drawing. If all buffers are occupied, skip the capture
+if(readback.pendingCount() < readback.capacity())
+    for(UnsignedInt& id: pending) if(!id) {
+        id = readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+        break;
+    }
+
+// Pick up reads that finished in the meantime, pass them to an image
+// converter or DebugTools::CompareImage
+for(UnsignedInt& id: pending) if(id) {
+    if(Containers::Optional<Image2D> image = readback.tryRetrieve(id)) {
+        save(*image);
+        id = 0;
+    }
+}
+/* [AsyncReadback-usage] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Vector2i cursor, windowSize;
+Matrix4 projection, transformation;
+GL::Mesh mesh;
+UnsignedInt meshId{}, hovered{};
+/* [ObjectPicker-usage] */
+DebugTools::ObjectPicker picker;
+Shaders::Phong shader{Shaders::Phong::Flag::ObjectId};
+
+// Every frame, render the pickable objects into the region around the
+// cursor. Window events have the origin in the top left corner.
+const Vector2i position{cursor.x(), windowSize.y() - cursor.y() - 1};
+const Matrix4 pickMatrix = picker.begin(position, windowSize);
+GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+shader.setProjectionMatrix(pickMatrix*projection)
+    .setTransformationMatrix(transformation)
+    .setObjectId(meshId)
+    .draw(mesh);
+picker.end();
+
+// Then render the scene as usual. Once a result arrives, usually a frame or
+// two later, update the highlight.
+GL::defaultFramebuffer.bind();
+if(Containers::Optional<DebugTools::ObjectPicker::Result> result = picker.poll())
+    hovered = result->objectId;
+/* [ObjectPicker-usage] */
+static_cast<void>(hovered);
+}
+#endif
 }
 
 struct Foo: TestSuite::Tester {
@@ -0,0 +1,65 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/DebugTools/FrameProfiler.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+
+#define DOXYGEN_IGNORE(...) __VA_ARGS__
+
+using namespace Magnum;
+
+int main() {
+
+{
+Vk::Device device{NoCreate};
+Vk::CommandBuffer cmd{NoCreate};
+/* [VkFrameProfiler-usage] */
+DebugTools::VkFrameProfiler profiler{device,
+    DebugTools::VkFrameProfiler::Value::FrameTime|
+    DebugTools::VkFrameProfiler::Value::GpuDuration,
+    {"Shadow pass", "Main pass"}, 50};
+
+DOXYGEN_IGNORE()
+
+/* Each frame, after waiting for the fence of the oldest frame in flight */
+profiler.beginFrame(cmd);
+
+profiler.beginPass(cmd, 0);
+DOXYGEN_IGNORE(/* Record the shadow pass */)
+profiler.endPass(cmd, 0);
+
+profiler.beginPass(cmd, 1);
+DOXYGEN_IGNORE(/* Record the main pass */)
+profiler.endPass(cmd, 1);
+
+profiler.endFrame(cmd);
+DOXYGEN_IGNORE(/* Submit cmd and present */)
+
+profiler.printStatistics(10);
+/* [VkFrameProfiler-usage] */
+}
+
+}
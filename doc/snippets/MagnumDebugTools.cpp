@@ -32,7 +32,9 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/DebugTools/DynamicResolution.h"
 #include "Magnum/DebugTools/FrameProfiler.h"
+#include "Magnum/DebugTools/ZoneProfiler.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Trade/AbstractImporter.h"
 
@@ -100,6 +102,14 @@ CORRADE_COMPARE_WITH(actual.pixels<Color3ub>().flipped<0>(), expected,
     (DebugTools::CompareImage{1.5f, 0.01f}));
 /* [CompareImage-pixels-flip] */
 }
+
+{
+Image2D actual = doProcessing();
+/* [CompareImage-threads] */
+CORRADE_COMPARE_WITH(actual, "expected.png",
+    (DebugTools::CompareImageToFile{1.5f, 0.01f}.setThreadCount(0)));
+/* [CompareImage-threads] */
+}
 }
 };
 
@@ -161,4 +171,55 @@ DebugTools::FrameProfiler profiler{{
 /* [FrameProfiler-setup-immediate] */
 }
 
+{
+DebugTools::FrameProfiler profiler;
+/* [FrameProfiler-time-series] */
+for(std::size_t i = 0; i != profiler.maxFrameCount(); ++i) {
+    profiler.beginFrame();
+    // actual drawing code …
+    profiler.endFrame();
+}
+
+Debug{} << "p50:" << profiler.measurementPercentile(0, 50.0)
+        << "p99:" << profiler.measurementPercentile(0, 99.0);
+profiler.saveTimeSeriesCsv("frames.csv");
+/* [FrameProfiler-time-series] */
+}
+
+{
+auto updatePhysics = []() {};
+auto drawScene = []() {};
+/* [ZoneProfiler-usage] */
+DebugTools::ZoneProfiler profiler;
+profiler.setThreadName("Main");
+
+for(std::size_t i = 0; i != 100; ++i) {
+    DebugTools::ZoneProfiler::Zone frame{profiler, "frame"};
+    {
+        DebugTools::ZoneProfiler::Zone zone{profiler, "physics"};
+        updatePhysics();
+    } {
+        DebugTools::ZoneProfiler::Zone zone{profiler, "draw"};
+        drawScene();
+    }
+}
+
+profiler.saveChromeTrace("trace.json");
+/* [ZoneProfiler-usage] */
+}
+
+{
+Double measuredGpuDuration{};
+Vector2i windowSize;
+/* [DynamicResolution-usage] */
+/* Aim for 60 FPS, with the GPU busy at most 14 ms of the 16.6 ms */
+DebugTools::DynamicResolution resolution{14.0e6};
+
+// Every frame
+resolution.update(measuredGpuDuration);
+Vector2i renderSize = resolution.scaledSize(windowSize);
+/* [DynamicResolution-usage] */
+static_cast<void>(renderSize);
+}
+
 }
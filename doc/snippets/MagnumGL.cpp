@@ -27,18 +27,24 @@
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/CommandList.h"
 #include "Magnum/GL/Context.h"
+#include "Magnum/GL/ContextCapabilityCache.h"
 #include "Magnum/GL/CubeMapTexture.h"
 #include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/FrameGraph.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/PipelineState.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -53,6 +59,7 @@
 #include "Magnum/Primitives/Cube.h"
 #include "Magnum/Primitives/Plane.h"
 #include "Magnum/Shaders/Phong.h"
+#include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/MeshData.h"
 
 #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
@@ -66,6 +73,7 @@
 
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/BufferImage.h"
+#include "Magnum/GL/Fence.h"
 #include "Magnum/GL/PrimitiveQuery.h"
 #include "Magnum/GL/TextureArray.h"
 #include "Magnum/GL/TransformFeedback.h"
@@ -76,10 +84,15 @@
 #include "Magnum/GL/BufferTextureFormat.h"
 #include "Magnum/GL/CubeMapTextureArray.h"
 #include "Magnum/GL/MultisampleTexture.h"
+#include "Magnum/GL/ProgramBinaryCache.h"
+#include "Magnum/GL/TextureStreamer.h"
 #endif
 
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/RectangleTexture.h"
+#include "Magnum/GL/RingBuffer.h"
+#include "Magnum/GL/SparseTextureStreamer.h"
+#include "Magnum/GL/TextureResidency.h"
 #endif
 
 using namespace Magnum;
@@ -296,6 +309,26 @@ explicit MyShader() {
 }
 /* [AbstractShaderProgram-constructor] */
 
+/* [ProgramBinaryCache-usage] */
+explicit MyShader(GL::ProgramBinaryCache& cache) {
+    GL::Shader vert{GL::Version::GL430, GL::Shader::Type::Vertex};
+    GL::Shader frag{GL::Version::GL430, GL::Shader::Type::Fragment};
+    vert.addFile("MyShader.vert");
+    frag.addFile("MyShader.frag");
+
+    /* Compile and link only if the binary isn't cached or got rejected */
+    const std::string key = cache.key({vert, frag});
+    if(!cache.load(*this, key)) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+        attachShaders({vert, frag});
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        cache.save(*this, key);
+    }
+
+    /* Uniform values are reset after loading a binary, set them here */
+}
+/* [ProgramBinaryCache-usage] */
+
 /* [AbstractShaderProgram-uniforms] */
 MyShader& setProjectionMatrix(const Matrix4& matrix) {
     setUniform(0, matrix);
@@ -600,6 +633,55 @@ MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::geometry_shader4);
 }
 #endif
 
+{
+/* [Context-stateStatistics] */
+GL::Context& context = GL::Context::current();
+context.resetStateStatistics();
+
+// draw the frame ...
+
+const GL::Context::StateStatistics& statistics = context.stateStatistics();
+Debug{} << "Texture bindings:" << statistics.textureBindings.issued
+    << "issued," << statistics.textureBindings.elided << "elided";
+/* [Context-stateStatistics] */
+}
+
+{
+struct Object { Matrix4 transformation; Color4 color; };
+Containers::ArrayView<Object> objects;
+Matrix4 projection;
+GL::Mesh mesh;
+/* [AbstractShaderProgram-uniform-cache] */
+Shaders::Phong shader;
+shader.setUniformCacheEnabled(true);
+
+/* The projection, light and material parameters are the same for all objects,
+   so they're uploaded only in the first iteration */
+for(const Object& object: objects) {
+    shader
+        .setProjectionMatrix(projection)
+        .setLightPositions({{0.0f, 0.0f, 10.0f, 0.0f}})
+        .setTransformationMatrix(object.transformation)
+        .setNormalMatrix(object.transformation.normalMatrix())
+        .setDiffuseColor(object.color)
+        .draw(mesh);
+}
+/* [AbstractShaderProgram-uniform-cache] */
+}
+
+{
+/* [Context-setResourceTracking] */
+GL::Context& context = GL::Context::current();
+context.setResourceTracking(true);
+
+// load the level ...
+
+Debug{} << "Textures:" << context.resourceCount(GL::Context::ResourceType::Texture)
+    << "using" << context.resourceMemory(GL::Context::ResourceType::Texture)
+    << "bytes";
+/* [Context-setResourceTracking] */
+}
+
 #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
 {
 char data[1]{};
@@ -903,6 +985,120 @@ GL::defaultFramebuffer.mapForDraw({
 /* [DefaultFramebuffer-usage-map] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+/* [Fence-usage] */
+/* Issue commands reading from the buffer, then insert a fence */
+// ...
+GL::Fence fence;
+
+// ...
+
+/* Some time later, check without blocking whether the GPU is done */
+if(fence.isSignaled()) {
+    // the buffer can be safely modified now
+}
+/* [Fence-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Vector2i size;
+void drawScene(GL::Framebuffer&, void*);
+void blur(GL::Framebuffer&, void*);
+void tonemap(GL::Framebuffer&, void*);
+/* [FrameGraph-usage] */
+GL::FrameGraph graph;
+UnsignedInt hdr = graph.addTexture(GL::TextureFormat::RGBA16F, size);
+UnsignedInt depth = graph.addRenderbuffer(
+    GL::RenderbufferFormat::Depth24Stencil8, size);
+UnsignedInt blurred = graph.addTexture(GL::TextureFormat::RGBA16F, size);
+UnsignedInt output = graph.addTexture(GL::TextureFormat::RGBA8, size);
+
+/* The scene renders into the HDR texture, depth is needed only there */
+UnsignedInt scene = graph.addPass({{}, size}, drawScene);
+graph.write(scene, hdr, GL::Framebuffer::ColorAttachment{0})
+     .write(scene, depth, GL::Framebuffer::BufferAttachment::DepthStencil);
+
+/* Blur samples the HDR texture */
+UnsignedInt blurPass = graph.addPass({{}, size}, blur, &graph);
+graph.read(blurPass, hdr)
+     .write(blurPass, blurred, GL::Framebuffer::ColorAttachment{0});
+
+/* Only the output is preserved after execution, the rest is transient */
+UnsignedInt tonemapPass = graph.addPass({{}, size}, tonemap, &graph);
+graph.read(tonemapPass, blurred)
+     .write(tonemapPass, output, GL::Framebuffer::ColorAttachment{0})
+     .setOutput(output);
+
+graph.compile();
+
+// every frame
+graph.execute();
+/* [FrameGraph-usage] */
+}
+#endif
+
+{
+struct StaticObject {
+    GL::Mesh* mesh;
+    GL::Texture2D* texture;
+    Matrix4 transformation;
+};
+Containers::ArrayView<const StaticObject> objects;
+GL::AbstractShaderProgram shader{NoCreate};
+Int transformationMatrixUniform{};
+/* [CommandList-usage] */
+GL::CommandList list;
+for(const StaticObject& object: objects) {
+    list.bindTexture(0, *object.texture)
+        .setUniform(shader, transformationMatrixUniform, object.transformation)
+        .draw(shader, *object.mesh);
+}
+
+// every frame
+list.replay();
+/* [CommandList-usage] */
+}
+
+{
+/* [ContextCapabilityCache-usage] */
+GL::ContextCapabilityCache cache;
+if(Utility::Directory::exists("capabilities.bin"))
+    cache.deserialize(Utility::Directory::read("capabilities.bin"));
+GL::Context::setCapabilityCache(&cache);
+
+// create the application and any shared or worker contexts …
+
+Utility::Directory::write("capabilities.bin", cache.serialize());
+GL::Context::setCapabilityCache(nullptr);
+/* [ContextCapabilityCache-usage] */
+}
+
+{
+GL::AbstractShaderProgram shader{NoCreate};
+GL::Mesh opaqueMesh{NoCreate}, transparentMesh{NoCreate};
+/* [PipelineState-usage] */
+GL::PipelineState opaque;
+opaque.setDepthTest(true)
+    .setFaceCulling(true);
+
+GL::PipelineState transparent;
+transparent.setDepthTest(true)
+    .setDepthMask(false)
+    .setBlending(true)
+    .setBlendFunction(GL::Renderer::BlendFunction::One,
+                      GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+
+// every frame, only the differing state gets set
+opaque.apply();
+shader.draw(opaqueMesh);
+transparent.apply();
+shader.draw(transparentMesh);
+/* [PipelineState-usage] */
+}
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 struct MyShader {
@@ -1339,6 +1535,106 @@ GL::Renderer::setBlendFunction(
 /* [Renderer-setBlendFunction] */
 }
 
+#ifndef MAGNUM_TARGET_GLES
+{
+struct TransformationUniform {
+    Matrix4 transformationMatrix;
+};
+struct: GL::AbstractShaderProgram {
+    void bindTransformationBuffer(GL::Buffer&, GLintptr, GLsizeiptr) {}
+} shader;
+GL::Mesh mesh;
+Matrix4 transformation;
+bool running = false;
+/* [RingBuffer-usage] */
+/* Enough space for three frames of data */
+GL::RingBuffer ring{3*4096, GL::Buffer::TargetHint::Uniform};
+
+while(running) {
+    GL::RingBuffer::Allocation a = ring.allocateUniform(sizeof(TransformationUniform));
+    Containers::arrayCast<TransformationUniform>(a.data)[0].transformationMatrix =
+        transformation;
+
+    shader.bindTransformationBuffer(ring.buffer(), a.offset, a.data.size());
+    shader.draw(mesh);
+
+    /* Everything allocated this frame is now guarded against overwrite until
+       the GPU finishes the above draw */
+    ring.fence();
+}
+/* [RingBuffer-usage] */
+}
+
+{
+struct TextureHandleUniform {
+    UnsignedLong handle;
+    Int:32;
+    Int:32;
+};
+Containers::ArrayView<GL::Texture2D*> textures;
+Containers::ArrayView<TextureHandleUniform> handles;
+bool running = false;
+/* [TextureResidency-usage] */
+/* At most 512 textures resident, unused ones evicted after 120 frames */
+GL::TextureResidency residency{512, 120};
+
+while(running) {
+    for(std::size_t i = 0; i != textures.size(); ++i)
+        handles[i].handle = residency.use(*textures[i]);
+
+    // upload the handles, draw ...
+
+    residency.nextFrame();
+}
+/* [TextureResidency-usage] */
+}
+
+{
+/* [Texture-sparse] */
+Containers::Array<Vector2i> pageSizes =
+    GL::Texture2D::sparsePageSizes(GL::TextureFormat::RGBA8);
+
+GL::Texture2D texture;
+texture.setSparseStorage(1, GL::TextureFormat::RGBA8, {16384, 16384}, 0);
+
+/* Commit the top left page and upload data to it */
+Range2Di page = Range2Di::fromSize({}, pageSizes[0]);
+ImageView2D image{PixelFormat::RGBA8Unorm, pageSizes[0], {}};
+texture.setPageCommitment(0, page, true)
+       .setSubImage(0, page.min(), image);
+/* [Texture-sparse] */
+}
+
+{
+GL::Texture2D texture;
+bool running = false;
+Trade::ImageData2D loadTile(Int, const Vector2i&);
+/* [SparseTextureStreamer-usage] */
+GL::SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm,
+    {16384, 16384}, 7, {128, 128}};
+streamer.setLoader([](Int level, const Vector2i& tile,
+    const MutableImageView2D& destination, void*)
+{
+    Trade::ImageData2D image = loadTile(level, tile);
+    if(image.size() != destination.size()) return false;
+
+    Utility::copy(image.pixels(), destination.pixels());
+    return true;
+});
+
+// in worker threads
+while(streamer.load());
+
+// on the GL thread, each frame
+while(running) {
+    // bind streamer.feedbackBuffer() and draw ...
+
+    streamer.update();
+}
+/* [SparseTextureStreamer-usage] */
+}
+#endif
+
 #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
 {
 /* [SampleQuery-usage] */
@@ -1557,6 +1853,29 @@ GL::CompressedBufferImage3D image = texture.compressedSubImage(0, range, {},
 #endif
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+GL::Texture2D texture;
+auto decodeInto = [](Containers::ArrayView<char>) {};
+/* [TextureStreamer-usage] */
+GL::TextureStreamer2D streamer{256*256*4};
+
+/* On the GL thread, map a free pixel buffer if there's any */
+if(Containers::Optional<GL::TextureStreamer2D::Staging> staging =
+    streamer.acquire(256*256*4))
+{
+    /* Fill the memory, for example by decoding an image on a worker thread */
+    decodeInto(staging->data);
+
+    /* Once done, issue the upload on the GL thread again. The buffer is
+       recycled once the GPU finishes the copy. */
+    streamer.upload(*staging, texture, 0, {},
+        PixelFormat::RGBA8Unorm, {256, 256});
+}
+/* [TextureStreamer-usage] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 {
 /* [TimeQuery-usage1] */
@@ -1050,6 +1050,18 @@ static_cast<void>(a);
 static_cast<void>(b);
 }
 
+{
+/* [packOctahedral] */
+Vector3 normal = Vector3{1.0f, -2.0f, 0.5f}.normalized();
+
+/* 4 bytes instead of 12 */
+Vector2s packed = Math::pack<Vector2s>(Math::packOctahedral(normal));
+
+Vector3 unpacked = Math::unpackOctahedral(Math::unpack<Vector2>(packed));
+/* [packOctahedral] */
+static_cast<void>(unpacked);
+}
+
 {
 Range1D range, a, b;
 constexpr UnsignedInt dimensions = 1;
@@ -24,14 +24,21 @@
 */
 
 #include <tuple> /* for std::tie() :( */
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Simplify.h"
 #include "Magnum/Trade/MeshData.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -53,6 +60,47 @@ GL::Mesh mesh = MeshTools::compile(meshData, indices, vertices);
 /* [compile-external] */
 }
 
+{
+Trade::MeshData meshData{MeshPrimitive::Lines, 5};
+/* [compile-packed] */
+/* Normals and texture coordinates get converted to smaller types, custom
+   attributes are not uploaded at all */
+GL::Mesh mesh = MeshTools::compile(meshData, {
+    {Trade::MeshAttribute::Normal, VertexFormat::Vector3bNormalized},
+    {Trade::MeshAttribute::TextureCoordinates, VertexFormat::Vector2h}
+});
+/* [compile-packed] */
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+{
+Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes;
+/* [concatenateInto-external] */
+const std::pair<UnsignedInt, UnsignedInt> count =
+    MeshTools::concatenateIndexVertexCount(meshes);
+const std::size_t indexSize = count.first*sizeof(UnsignedInt);
+const std::size_t vertexSize =
+    count.second*MeshTools::concatenateVertexStride(meshes);
+
+/* Allocate the buffers and concatenate directly into their mapped memory */
+GL::Buffer indices, vertices;
+indices.setData({nullptr, indexSize});
+vertices.setData({nullptr, vertexSize});
+Trade::MeshData meshData = MeshTools::concatenateInto(
+    indices.map(0, indexSize, GL::Buffer::MapFlag::Write|
+                              GL::Buffer::MapFlag::InvalidateBuffer),
+    vertices.map(0, vertexSize, GL::Buffer::MapFlag::Write|
+                                GL::Buffer::MapFlag::InvalidateBuffer),
+    meshes, 0);
+
+/* Set up the mesh using the returned layout, then unmap */
+GL::Mesh mesh = MeshTools::compile(meshData, indices, vertices);
+CORRADE_INTERNAL_ASSERT_OUTPUT(indices.unmap());
+CORRADE_INTERNAL_ASSERT_OUTPUT(vertices.unmap());
+/* [concatenateInto-external] */
+}
+#endif
+
 {
 Trade::MeshData meshData{MeshPrimitive::Lines, 5};
 Trade::MeshAttribute myCustomAttribute{};
@@ -73,6 +121,25 @@ mesh.addVertexBuffer(std::move(vertices),
 /* [compile-external-attributes] */
 }
 
+{
+Trade::MeshData chair{MeshPrimitive::Triangles, 0};
+Trade::MeshData table{MeshPrimitive::Triangles, 0};
+Trade::MeshData lamp{MeshPrimitive::Triangles, 0};
+struct: GL::AbstractShaderProgram {} shader;
+/* [compile-batch] */
+GL::Mesh mesh{NoCreate};
+Containers::Array<GL::MeshView> views =
+    MeshTools::compile({chair, table, lamp}, mesh);
+
+/* Draw just the chair */
+shader.draw(views[0]);
+
+/* Draw everything in a single multi-draw call */
+Containers::Reference<GL::MeshView> all[]{views[0], views[1], views[2]};
+shader.draw(all);
+/* [compile-batch] */
+}
+
 {
 /* [compressIndices] */
 Containers::Array<UnsignedInt> indices;
@@ -113,6 +180,29 @@ mesh.setCount(indices.size())
 CORRADE_IGNORE_DEPRECATED_POP
 #endif
 
+{
+Trade::MeshData meshData{MeshPrimitive::Triangles, 5};
+Float distance{};
+struct: GL::AbstractShaderProgram {} shader;
+/* [generateLodChain] */
+/* Full mesh, 1/4 and 1/16 of the triangles */
+UnsignedInt lodOffsets[4];
+Trade::MeshData lods = MeshTools::generateLodChain(meshData, Containers::arrayView({
+    meshData.indexCount(),
+    meshData.indexCount()/4,
+    meshData.indexCount()/16
+}), lodOffsets);
+GL::Mesh mesh = MeshTools::compile(lods);
+
+/* Pick a level based on distance from the camera */
+const UnsignedInt level = Math::min(UnsignedInt(distance/10.0f), 2u);
+GL::MeshView view{mesh};
+view.setIndexRange(lodOffsets[level])
+    .setCount(lodOffsets[level + 1] - lodOffsets[level]);
+shader.draw(view);
+/* [generateLodChain] */
+}
+
 {
 struct MyShader {
     typedef GL::Attribute<0, Vector3> Position;
@@ -132,4 +222,14 @@ mesh.setCount(positions.size())
 /* [interleave1] */
 }
 
+{
+Trade::MeshData meshData{MeshPrimitive::Points, 0};
+/* [interleave-split-positions] */
+/* Positions in the first stream, normals, texture coordinates etc. in the
+   second */
+GL::Mesh mesh = MeshTools::compile(MeshTools::interleave(meshData, {},
+    MeshTools::InterleaveFlag::SplitPositions));
+/* [interleave-split-positions] */
+}
+
 }
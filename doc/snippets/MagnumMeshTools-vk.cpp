@@ -0,0 +1,66 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/MeshTools/CompileVk.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/StagingUploader.h"
+
+#define DOXYGEN_IGNORE(...) __VA_ARGS__
+
+using namespace Magnum;
+
+int main() {
+
+{
+Vk::Device device{NoCreate};
+Vk::StagingUploader uploader{NoCreate};
+Trade::MeshData cube{MeshPrimitive::Triangles, 0}, sphere{MeshPrimitive::Triangles, 0};
+VkPipelineLayout layout{};
+VkRenderPass renderPass{};
+/* [compile-vk] */
+Vk::MemoryAllocator allocator{device};
+
+/* Both meshes get uploaded in a single batch */
+MeshTools::VkMesh cubeMesh = MeshTools::compile(cube, device, allocator, uploader);
+MeshTools::VkMesh sphereMesh = MeshTools::compile(sphere, device, allocator, uploader);
+UnsignedLong value = uploader.flush();
+
+/* Vertex input state of a pipeline matching the mesh layout */
+Vk::GraphicsPipelineCreateInfo info{layout, renderPass, 0, 1};
+MeshTools::addVertexInput(cubeMesh, info);
+DOXYGEN_IGNORE()
+
+/* Submissions drawing the meshes then wait on uploader.semaphore() for
+   `value` */
+/* [compile-vk] */
+static_cast<void>(sphereMesh);
+static_cast<void>(value);
+}
+
+}
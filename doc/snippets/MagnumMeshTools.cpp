@@ -34,6 +34,7 @@
 #include "Magnum/MeshTools/FlipNormals.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Quantize.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Cube.h"
@@ -105,6 +106,33 @@ Containers::Array<Vector3> normals =
 /* [generateFlatNormals] */
 }
 
+{
+Containers::ArrayView<const Vector3> basePositions;
+Containers::ArrayView<const Vector3> morphTargetOffsets;
+Float weight{};
+bool morphing{};
+/* [generateVertexTriangleAdjacency] */
+Containers::ArrayView<const UnsignedInt> indices;
+Containers::Array<Vector3> positions{basePositions.size()};
+Containers::Array<Vector3> normals{basePositions.size()};
+
+/* Calculate the adjacency just once, as the indices don't change */
+MeshTools::VertexTriangleAdjacency adjacency =
+    MeshTools::generateVertexTriangleAdjacency(indices, positions.size());
+
+while(morphing) {
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = basePositions[i] + morphTargetOffsets[i]*weight;
+
+    /* Regenerate the normals using all available threads */
+    MeshTools::generateSmoothNormalsInto(adjacency, indices, positions,
+        normals, 0);
+
+    // upload positions and normals …
+}
+/* [generateVertexTriangleAdjacency] */
+}
+
 {
 /* [interleave2] */
 Containers::ArrayView<const Vector4> positions;
@@ -149,6 +177,19 @@ Trade::MeshData indexed{data.primitive(),
 /* [interleavedLayout-indices] */
 }
 
+{
+Trade::MeshData meshData{MeshPrimitive::Points, 0};
+/* [quantize] */
+std::pair<Trade::MeshData, Matrix4> quantized = MeshTools::quantize(meshData);
+
+/* Draw the quantized mesh with the dequantization transform applied on top
+   of the object transformation */
+Matrix4 transformationMatrix;
+Matrix4 finalTransformationMatrix = transformationMatrix*quantized.second;
+/* [quantize] */
+static_cast<void>(finalTransformationMatrix);
+}
+
 {
 /* [removeDuplicates] */
 Containers::ArrayView<Vector3i> data;
@@ -24,8 +24,19 @@
 */
 
 #include <thread>
+#include <vector>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
+#include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/Renderbuffer.h>
+#include <Magnum/GL/RenderbufferFormat.h>
+#include <Magnum/GL/Texture.h>
+#include <Magnum/GL/TextureFormat.h>
 #include <Magnum/Platform/WindowlessEglApplication.h>
 #include <Magnum/Platform/GLContext.h>
+#include <Magnum/Platform/GLWorkerThreads.h>
 
 using namespace Magnum;
 
@@ -45,3 +56,61 @@ int main() {
     worker.join();
 }
 /* [thread] */
+
+void loadTextures(std::vector<GL::Texture2D>& textures, const std::vector<ImageView2D>& images);
+/* [GLWorkerThreads] */
+void loadTextures(std::vector<GL::Texture2D>& textures, const std::vector<ImageView2D>& images) {
+    /* Share objects with the context that's current on this thread */
+    Platform::GLWorkerThreads<Platform::WindowlessEglContext> workers{4,
+        Platform::WindowlessEglContext::Configuration{}
+            .setSharedContext(eglGetCurrentDisplay(), eglGetCurrentContext())};
+
+    /* Each texture gets created and uploaded on one of the workers */
+    textures.resize(images.size());
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        workers.submit([&textures, &images, i]{
+            GL::Texture2D texture;
+            texture.setStorage(1, GL::TextureFormat::RGBA8, images[i].size())
+                .setSubImage(0, {}, images[i]);
+            textures[i] = std::move(texture);
+        });
+    }
+
+    /* Once this returns, the textures can be used on the main thread */
+    workers.wait();
+}
+/* [GLWorkerThreads] */
+
+void renderFrames(std::vector<Image2D>& frames);
+/* [WindowlessEglContext-multiple-devices] */
+void renderFrames(std::vector<Image2D>& frames) {
+    /* One non-shared context for each device */
+    const UnsignedInt deviceCount =
+        Platform::WindowlessEglContext::deviceCount();
+    std::vector<Platform::WindowlessEglContext::Configuration>
+        configurations(deviceCount);
+    for(UnsignedInt i = 0; i != deviceCount; ++i)
+        configurations[i].setDevice(i);
+
+    Platform::GLWorkerThreads<Platform::WindowlessEglContext> workers{
+        configurations};
+
+    /* A job queue -- each frame gets rendered on the first free device */
+    for(std::size_t i = 0; i != frames.size(); ++i) {
+        workers.submit([&frames, i] {
+            GL::Renderbuffer color;
+            color.setStorage(GL::RenderbufferFormat::RGBA8, {1920, 1080});
+            GL::Framebuffer framebuffer{{{}, {1920, 1080}}};
+            framebuffer.attachRenderbuffer(
+                GL::Framebuffer::ColorAttachment{0}, color);
+
+            // Render frame i here ...
+
+            frames[i] = framebuffer.read(framebuffer.viewport(),
+                {PixelFormat::RGBA8Unorm});
+        });
+    }
+
+    workers.wait();
+}
+/* [WindowlessEglContext-multiple-devices] */
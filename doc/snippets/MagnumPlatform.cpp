@@ -228,3 +228,44 @@ MyApplication::MyApplication(const Arguments& arguments):
 /* [exit-from-constructor] */
 
 }
+
+namespace H {
+
+struct State {
+    Vector3 playerPosition;
+    // …
+};
+
+/* [Sdl2Application-render-thread] */
+class MyApplication: public Platform::Sdl2Application {
+    public:
+        explicit MyApplication(const Arguments& arguments):
+            Platform::Sdl2Application{arguments, Configuration{},
+                GLConfiguration{}.setRenderThreadEnabled(true)} {}
+
+    private:
+        /* Called on the main thread, updates the simulation */
+        void tickEvent() override {
+            // update _simulation …
+            redraw();
+        }
+
+        /* Called on the main thread with the render thread waiting */
+        void renderThreadSyncEvent() override {
+            _rendered = _simulation;
+        }
+
+        /* Called on the render thread, sees only the copy */
+        void drawEvent() override {
+            GL::defaultFramebuffer.clear(GL::FramebufferClear::Color);
+
+            // draw _rendered …
+
+            swapBuffers();
+        }
+
+        State _simulation, _rendered;
+};
+/* [Sdl2Application-render-thread] */
+
+}
@@ -24,10 +24,17 @@
 */
 
 #include "Magnum/Math/Color.h"
+#include "Magnum/Primitives/Cylinder.h"
 #include "Magnum/Primitives/Gradient.h"
+#include "Magnum/Primitives/Icosphere.h"
 #include "Magnum/Primitives/Line.h"
+#include "Magnum/Primitives/MeshCache.h"
 #include "Magnum/Trade/MeshData.h"
 
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Mesh.h"
+#endif
+
 using namespace Magnum;
 
 int main() {
@@ -63,4 +70,25 @@ Primitives::line2D({0.0f, 0.0f}, {1.0f, 0.0f});
 Primitives::line3D({0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f});
 /* [line3D-identity] */
 }
+
+{
+/* [MeshCache] */
+Primitives::MeshCache cache;
+
+/* Generated on the first call, subsequent calls return the same instance */
+const Trade::MeshData& sphere = cache.meshData(Primitives::icosphereSolid, 3);
+const Trade::MeshData& cylinder = cache.meshData(Primitives::cylinderSolid,
+    1, 32, 2.0f, Primitives::CylinderFlags{});
+
+#ifdef MAGNUM_TARGET_GL
+/* Compiled just once as well, all users draw the same GL mesh */
+GL::Mesh& sphereMesh = cache.mesh(Primitives::icosphereSolid, 3);
+#endif
+/* [MeshCache] */
+static_cast<void>(sphere);
+static_cast<void>(cylinder);
+#ifdef MAGNUM_TARGET_GL
+static_cast<void>(sphereMesh);
+#endif
+}
 }
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Timeline.h"
 #include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
@@ -35,6 +37,7 @@
 #include "Magnum/SceneGraph/AnimableGroup.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableQueue.h"
 #include "Magnum/SceneGraph/MatrixTransformation2D.h"
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Object.h"
@@ -131,6 +134,69 @@ class RedCube: public Object3D, public SceneGraph::Drawable3D {
 };
 /* [Drawable-usage-multiple-inheritance] */
 
+namespace B {
+
+/* [Drawable-batch] */
+struct InstanceData {
+    Matrix4 transformation;
+    Matrix3x3 normal;
+};
+
+class CubeDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit CubeDrawable(Object3D& object, SceneGraph::DrawableGroup3D* group, GL::Mesh& mesh, GL::Buffer& instanceBuffer, Shaders::Phong& shader): SceneGraph::Drawable3D{object, group}, _mesh(mesh), _instanceBuffer(instanceBuffer), _shader(shader) {
+            /* All cubes share the same shader, material and mesh */
+            setSortKey(SceneGraph::drawableSortKey(0, 0, 0));
+        }
+
+    private:
+        void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) override {
+            SceneGraph::Drawable3D* self = this;
+            drawBatch({&self, 1}, {&transformationMatrix, 1}, camera);
+        }
+
+        void drawBatch(Containers::ArrayView<SceneGraph::Drawable3D* const>, Containers::ArrayView<const Matrix4> transformationMatrices, SceneGraph::Camera3D& camera) override {
+            /* Upload per-instance transformations of the whole batch */
+            Containers::Array<InstanceData> instanceData{Containers::NoInit, transformationMatrices.size()};
+            for(std::size_t i = 0; i != instanceData.size(); ++i)
+                instanceData[i] = {transformationMatrices[i],
+                                   transformationMatrices[i].normalMatrix()};
+            _instanceBuffer.setData(instanceData, GL::BufferUsage::StreamDraw);
+
+            /* And draw them in a single call */
+            _mesh.setInstanceCount(instanceData.size());
+            _shader.setProjectionMatrix(camera.projectionMatrix())
+                .draw(_mesh);
+        }
+
+        GL::Mesh& _mesh;
+        GL::Buffer& _instanceBuffer;
+        Shaders::Phong& _shader;
+};
+/* [Drawable-batch] */
+
+void foo(SceneGraph::Camera3D& camera, SceneGraph::DrawableGroup3D& drawables);
+void foo(SceneGraph::Camera3D& camera, SceneGraph::DrawableGroup3D& drawables) {
+GL::Mesh mesh;
+GL::Buffer instanceBuffer;
+/* [Drawable-batch-draw] */
+/* A shader and a mesh taking per-instance transformations */
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation};
+mesh.addVertexBufferInstanced(instanceBuffer, 1, 0,
+    Shaders::Phong::TransformationMatrix{},
+    Shaders::Phong::NormalMatrix{});
+
+/* Each frame, sort the drawables and draw the same-state runs as batches */
+SceneGraph::DrawableQueue3D queue;
+queue.clear();
+queue.add(camera, drawables);
+queue.sort();
+queue.draw(camera);
+/* [Drawable-batch-draw] */
+}
+
+}
+
 void draw(const Matrix4&, SceneGraph::Camera3D&);
 void draw(const Matrix4& transformationMatrix, SceneGraph::Camera3D& camera) {
 /* [Drawable-usage-shader] */
@@ -24,6 +24,8 @@
 */
 
 #include <algorithm>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/Intersection.h"
@@ -35,8 +37,15 @@
 #include "Magnum/SceneGraph/MatrixTransformation3D.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
+#include "Magnum/SceneGraph/DrawableQueue.h"
+#include "Magnum/SceneGraph/FlattenedScene.h"
 #include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/PoolAllocator.h"
 #include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/SceneData.h"
 
 using namespace Magnum;
 using namespace Magnum::Math::Literals;
@@ -190,6 +199,66 @@ Object3D& second = first.addChild<Object3D>();
 static_cast<void>(second);
 }
 
+{
+Scene3D scene;
+Object3D* object{};
+SceneGraph::Camera3D* camera{};
+SceneGraph::DrawableGroup3D drawables;
+/* [FlattenedScene-usage] */
+SceneGraph::FlattenedScene<SceneGraph::MatrixTransformation3D> flattened{scene};
+
+/* Each frame, transform objects as usual and then clean all dirty ones in a
+   single linear sweep */
+object->rotateY(15.0_degf);
+flattened.update();
+camera->draw(drawables);
+
+/* Reparenting an object needs a rebuild */
+object->setParent(&scene);
+flattened.rebuild();
+/* [FlattenedScene-usage] */
+}
+
+{
+Scene3D scene;
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [ObjectPool-usage] */
+Containers::Optional<Trade::SceneData> data = importer->scene(0);
+
+/* Create all objects at once, with the imported hierarchy and
+   transformations */
+SceneGraph::ObjectPool<SceneGraph::MatrixTransformation3D> pool{scene,
+    data->field<Int>(Trade::SceneField::Parent),
+    data->field<Matrix4>(Trade::SceneField::Transformation)};
+
+/* Object IDs in the pool match object IDs in the imported scene */
+Object3D& object = pool.object(5);
+/* [ObjectPool-usage] */
+static_cast<void>(object);
+}
+
+{
+/* [PoolAllocator-usage] */
+class Projectile: public Object3D, public SceneGraph::PoolAllocated<Projectile> {
+    public:
+        explicit Projectile(Object3D* parent): Object3D{parent} {}
+
+        // ...
+};
+
+/* The allocator has to be created before the scene */
+SceneGraph::PoolAllocator<Projectile> projectiles{1024};
+Scene3D scene;
+
+/* O(1) allocation from a free slot in the pool */
+Projectile* projectile = new(projectiles) Projectile{&scene};
+
+/* O(1) deallocation, putting the slot back to the free list. The same
+   happens when the scene or the parent object gets destroyed. */
+delete projectile;
+/* [PoolAllocator-usage] */
+}
+
 {
 struct MyFeature {
     explicit MyFeature(SceneGraph::AbstractObject3D&, int, int) {}
@@ -319,6 +388,21 @@ SceneGraph::AnimableGroup3D animables;
 /* [Animable-usage] */
 }
 
+{
+Scene3D scene;
+/* [Animable-multithreading] */
+SceneGraph::AnimableGroup3D animables;
+animables.setThreadCount(0); // use all available cores
+
+/* AnimableObject::animationStep() touches only its own transformation, so
+   steps of different objects can run in parallel */
+for(std::size_t i = 0; i != 5000; ++i)
+    (new AnimableObject(&scene, &animables))
+        ->setThreadSafe(true)
+        .setState(SceneGraph::AnimationState::Running);
+/* [Animable-multithreading] */
+}
+
 {
 SceneGraph::Object<SceneGraph::MatrixTransformation2D> cameraObject;
 /* [Camera-2D] */
@@ -387,4 +471,43 @@ camera.draw(drawableTransformations);
 /* [Drawable-culling] */
 }
 
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D drawableGroup;
+SceneGraph::Drawable3D& drawable = drawableGroup[0];
+Range3D meshBounds;
+/* [Drawable-bvh] */
+/* Bounds of the mesh, relative to the object the drawable is attached to */
+drawable.setBoundingBox(meshBounds);
+
+/* Build the hierarchy once all drawables are added */
+SceneGraph::DrawableBvh3D bvh{drawableGroup};
+
+/* Every frame, draws only drawables intersecting the camera frustum */
+camera.draw(bvh);
+/* [Drawable-bvh] */
+}
+
+{
+Object3D cameraObject;
+SceneGraph::Camera3D camera{cameraObject};
+SceneGraph::DrawableGroup3D opaque, transparent;
+/* [DrawableQueue-usage] */
+SceneGraph::DrawableQueue3D opaqueQueue;
+SceneGraph::DrawableQueue3D transparentQueue{SceneGraph::DepthOrder::BackToFront};
+
+/* Every frame */
+opaqueQueue.clear();
+opaqueQueue.add(camera, opaque);
+opaqueQueue.sort();
+opaqueQueue.draw(camera);
+
+transparentQueue.clear();
+transparentQueue.add(camera, transparent);
+transparentQueue.sort();
+transparentQueue.draw(camera);
+/* [DrawableQueue-usage] */
+}
+
 }
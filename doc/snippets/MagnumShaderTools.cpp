@@ -132,6 +132,23 @@ auto result = converter->validateFile(ShaderTools::Stage::Fragment, "ssao.frag")
 /* [AbstractConverter-usage-callbacks] */
 }
 
+{
+PluginManager::Manager<ShaderTools::AbstractConverter> manager;
+Containers::StringView glsl;
+/* [AbstractConverter-usage-cache] */
+Containers::Pointer<ShaderTools::AbstractConverter> converter =
+    manager.loadAndInstantiate("GlslToSpirvShaderConverter");
+converter->setCacheDirectory("build/shader-cache");
+
+/* Compiles the shader only if this exact permutation wasn't compiled before */
+converter->setDefinitions({
+    {"LIGHT_COUNT", "3"}
+});
+Containers::Array<char> spirv = converter->convertDataToData(
+    ShaderTools::Stage::Fragment, glsl);
+/* [AbstractConverter-usage-cache] */
+}
+
 {
 Containers::Pointer<ShaderTools::AbstractConverter> converter;
 /* [AbstractConverter-setInputFileCallback] */
@@ -26,33 +26,81 @@
 #include <numeric>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/ColorMap.h"
 #include "Magnum/GL/Buffer.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/BufferTexture.h"
+#include "Magnum/GL/BufferTextureFormat.h"
+#endif
+#include "Magnum/GL/Context.h"
 #include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #include "Magnum/GL/Shader.h"
 #include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/RenderbufferFormat.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/TextureArray.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/TextureResidency.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/TransformFeedback.h"
+#endif
 #include "Magnum/GL/Version.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/Primitives/Grid.h"
 #include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Flat.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Shaders/InstanceBuffer.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/CascadedShadowMap.h"
+#endif
+#include "Magnum/Shaders/DepthOnly.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/LightClusters.h"
+#endif
 #include "Magnum/Shaders/MeshVisualizer.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/MorphTargets.h"
+#include "Magnum/Shaders/ParticleSystem.h"
+#include "Magnum/Shaders/ParticleUpdate.h"
+#endif
 #include "Magnum/Shaders/Phong.h"
+#include "Magnum/Shaders/ShaderCache.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/Terrain.h"
+#endif
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Shaders/VertexColor.h"
 #include "Magnum/Trade/LightData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Trade/SkinData.h"
 
 #define DOXYGEN_IGNORE(...) __VA_ARGS__
 
@@ -156,6 +204,40 @@ shader.setColor(0x2f83cc_rgbf)
 /* [DistanceFieldVector-usage2] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix3 transformationMatrix, projectionMatrix;
+GL::Texture2D texture;
+/* [DistanceFieldVector-ubo] */
+GL::Buffer transformationProjectionUniform, materialUniform, drawUniform;
+transformationProjectionUniform.setData({
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+});
+materialUniform.setData({
+    Shaders::DistanceFieldVectorMaterialUniform{}
+        .setColor(0x2f83cc_rgbf)
+        .setOutlineColor(0xdcdcdc_rgbf)
+        .setOutlineRange(0.6f, 0.4f)
+});
+drawUniform.setData({
+    Shaders::DistanceFieldVectorDrawUniform{}
+        .setMaterialId(0)
+});
+
+Shaders::DistanceFieldVector2D shader{
+    Shaders::DistanceFieldVector2D::Flag::UniformBuffers};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindVectorTexture(texture)
+    .draw(mesh);
+/* [DistanceFieldVector-ubo] */
+}
+#endif
+
 {
 /* [Flat-usage-colored1] */
 struct Vertex {
@@ -254,6 +336,106 @@ framebuffer.mapForDraw({
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 transformationProjectionMatrix;
+/* [Flat-skinning] */
+Trade::SkinData3D skin{{}, {}};
+Containers::ArrayView<const Matrix4> jointTransformations; // relative to mesh
+
+/* Combine the current joint transformations with the inverse bind matrices */
+Containers::Array<Matrix4> jointMatrices{skin.joints().size()};
+for(std::size_t i = 0; i != jointMatrices.size(); ++i)
+    jointMatrices[i] = jointTransformations[i]*skin.inverseBindMatrices()[i];
+
+Shaders::Flat3D shader{{}, 1, 1, UnsignedInt(jointMatrices.size())};
+shader.setTransformationProjectionMatrix(transformationProjectionMatrix)
+    .setJointMatrices(jointMatrices)
+    .draw(mesh);
+/* [Flat-skinning] */
+}
+
+{
+GL::Mesh mesh;
+Matrix4 transformation, leftEye, rightEye, leftProjection, rightProjection;
+/* [Flat-multiview] */
+GL::Texture2DArray color, depth;
+color.setStorage(1, GL::TextureFormat::RGBA8, {1024, 1024, 2});
+depth.setStorage(1, GL::TextureFormat::DepthComponent24, {1024, 1024, 2});
+
+GL::Framebuffer framebuffer{{{}, {1024, 1024}}};
+framebuffer
+    .attachTextureMultiview(GL::Framebuffer::ColorAttachment{0}, color, 0, 0, 2)
+    .attachTextureMultiview(GL::Framebuffer::BufferAttachment::Depth, depth, 0, 0, 2);
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::Multiview};
+shader
+    .setTransformationProjectionMatrices({
+        leftProjection*leftEye*transformation,
+        rightProjection*rightEye*transformation})
+    .draw(mesh);
+/* [Flat-multiview] */
+}
+#endif
+
+{
+/* [shaders-async] */
+Shaders::Flat3D::CompileState flatState =
+    Shaders::Flat3D::compile(Shaders::Flat3D::Flag::Textured);
+Shaders::Phong::CompileState phongState =
+    Shaders::Phong::compile(Shaders::Phong::Flag::DiffuseTexture, 2);
+
+while(!flatState.isLinkFinished() || !phongState.isLinkFinished()) {
+    // load assets, update a progress bar, ...
+}
+
+Shaders::Flat3D flat{std::move(flatState)};
+Shaders::Phong phong{std::move(phongState)};
+/* [shaders-async] */
+}
+
+{
+Containers::Array<Containers::Optional<Trade::MaterialData>> materials;
+/* [ShaderCache-usage] */
+Shaders::ShaderCache shaders;
+for(const Containers::Optional<Trade::MaterialData>& material: materials) {
+    Shaders::Phong::Flags flags;
+    if(material->hasAttribute(Trade::MaterialAttribute::AmbientTexture))
+        flags |= Shaders::Phong::Flag::AmbientTexture;
+    if(material->hasAttribute(Trade::MaterialAttribute::DiffuseTexture))
+        flags |= Shaders::Phong::Flag::DiffuseTexture;
+    if(material->hasAttribute(Trade::MaterialAttribute::SpecularTexture))
+        flags |= Shaders::Phong::Flag::SpecularTexture;
+    if(material->hasAttribute(Trade::MaterialAttribute::NormalTexture))
+        flags |= Shaders::Phong::Flag::NormalTexture;
+    if(material->alphaMode() == Trade::MaterialAlphaMode::Mask)
+        flags |= Shaders::Phong::Flag::AlphaMask;
+    shaders.addPhong(flags, 3);
+}
+
+while(shaders.update()) {
+    // load meshes and textures, update a progress bar, ...
+}
+
+// in the draw loop
+Shaders::Phong& shader = shaders.phong(Shaders::Phong::Flag::DiffuseTexture, 3);
+/* [ShaderCache-usage] */
+static_cast<void>(shader);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+/* [ShaderCache-binary] */
+GL::ProgramBinaryCache binaryCache{"shader-cache"};
+GL::Context::current().setProgramBinaryCache(&binaryCache);
+
+Shaders::ShaderCache shaders;
+// add variants ...
+/* [ShaderCache-binary] */
+}
+#endif
+
 {
 GL::Mesh mesh;
 /* [Flat-usage-instancing] */
@@ -274,6 +456,108 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [Flat-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix, transformationMatrix;
+/* [Flat-ubo] */
+GL::Buffer transformationProjectionUniform, materialUniform, drawUniform;
+transformationProjectionUniform.setData({
+    Shaders::TransformationProjectionUniform3D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+});
+materialUniform.setData({
+    Shaders::FlatMaterialUniform{}
+        .setColor(0x2f83cc_rgbf)
+});
+drawUniform.setData({
+    Shaders::FlatDrawUniform{}
+        .setMaterialId(0)
+});
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::UniformBuffers};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw(mesh);
+/* [Flat-ubo] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix;
+Matrix4 transformations[3];
+/* [Flat-multidraw] */
+GL::MeshView redCone{mesh}, yellowCube{mesh}, redSphere{mesh};
+// ...
+
+GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::TransformationProjectionUniform3D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformations[0]),
+    Shaders::TransformationProjectionUniform3D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformations[1]),
+    Shaders::TransformationProjectionUniform3D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformations[2])
+}};
+GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatMaterialUniform{}.setColor(0xcd3431_rgbf),
+    Shaders::FlatMaterialUniform{}.setColor(0xc7cf2f_rgbf)
+}};
+GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatDrawUniform{}.setMaterialId(0),
+    Shaders::FlatDrawUniform{}.setMaterialId(1),
+    Shaders::FlatDrawUniform{}.setMaterialId(0)
+}};
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::MultiDraw, 2, 3};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw({redCone, yellowCube, redSphere});
+/* [Flat-multidraw] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Mesh mesh;
+GL::Buffer transformationProjectionUniform, materialUniform;
+/* [Flat-bindless] */
+GL::MeshView redCone{mesh}, yellowCube{mesh}, redSphere{mesh};
+GL::Texture2D rust, paint, marble;
+// ...
+
+GL::TextureResidency residency;
+GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatDrawUniform{},
+    Shaders::FlatDrawUniform{},
+    Shaders::FlatDrawUniform{}
+}};
+GL::Buffer textureHandleUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::FlatTextureHandleUniform{}.setTextureHandle(residency.use(rust)),
+    Shaders::FlatTextureHandleUniform{}.setTextureHandle(residency.use(paint)),
+    Shaders::FlatTextureHandleUniform{}.setTextureHandle(residency.use(marble))
+}};
+
+Shaders::Flat3D shader{Shaders::Flat3D::Flag::MultiDraw|
+                       Shaders::Flat3D::Flag::Textured|
+                       Shaders::Flat3D::Flag::BindlessTextures, 1, 3};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindTextureHandleBuffer(textureHandleUniform)
+    .draw({redCone, yellowCube, redSphere});
+
+residency.nextFrame();
+/* [Flat-bindless] */
+}
+#endif
+
 {
 struct: GL::AbstractShaderProgram {
 void foo() {
@@ -320,6 +604,180 @@ mesh.setInstanceCount(Containers::arraySize(instanceData))
 /* [Phong-usage-instancing] */
 }
 
+#ifndef MAGNUM_TARGET_GLES
+{
+GL::Mesh mesh;
+Containers::ArrayView<const Matrix4> props;
+Containers::ArrayView<const Color3> propColors;
+bool running{};
+/* [InstanceBuffer-usage] */
+Shaders::Phong shader{Shaders::Phong::Flag::InstancedTransformation|
+                      Shaders::Phong::Flag::VertexColor};
+
+/* Space for three frames of up to 100k instances each */
+Shaders::InstanceBuffer3D instances{
+    Shaders::InstanceBuffer3D::Attribute::TransformationMatrix|
+    Shaders::InstanceBuffer3D::Attribute::NormalMatrix|
+    Shaders::InstanceBuffer3D::Attribute::Color, 100000};
+instances.addToMesh(mesh);
+
+while(running) {
+    instances.begin(mesh, props.size());
+    Containers::StridedArrayView1D<Matrix4> transformations =
+        instances.transformationMatrices();
+    Containers::StridedArrayView1D<Matrix3x3> normals =
+        instances.normalMatrices();
+    Containers::StridedArrayView1D<Color4> colors = instances.colors();
+    for(std::size_t i = 0; i != props.size(); ++i) {
+        transformations[i] = props[i];
+        normals[i] = props[i].normalMatrix();
+        colors[i] = propColors[i];
+    }
+
+    shader.draw(mesh);
+    instances.end();
+}
+/* [InstanceBuffer-usage] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix, transformationMatrix;
+/* [Phong-ubo] */
+GL::Buffer projectionUniform, lightUniform, materialUniform,
+    transformationUniform, drawUniform;
+projectionUniform.setData({
+    Shaders::ProjectionUniform3D{}
+        .setProjectionMatrix(projectionMatrix)
+});
+lightUniform.setData({
+    Shaders::PhongLightUniform{}
+        .setPosition({5.0f, 5.0f, 7.0f, 0.0f})
+        .setColor(0xfff7ed_rgbf)
+});
+materialUniform.setData({
+    Shaders::PhongMaterialUniform{}
+        .setDiffuseColor(0x2f83cc_rgbaf)
+        .setShininess(200.0f)
+});
+transformationUniform.setData({
+    Shaders::TransformationUniform3D{}
+        .setTransformationMatrix(transformationMatrix)
+});
+drawUniform.setData({
+    Shaders::PhongDrawUniform{}
+        .setNormalMatrix(transformationMatrix.normalMatrix())
+        .setMaterialId(0)
+});
+
+Shaders::Phong shader{Shaders::Phong::Flag::UniformBuffers};
+shader
+    .bindProjectionBuffer(projectionUniform)
+    .bindLightBuffer(lightUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw(mesh);
+/* [Phong-ubo] */
+}
+
+{
+GL::Mesh mesh;
+Matrix4 projectionMatrix;
+GL::Buffer projectionUniform, materialUniform, transformationUniform,
+    drawUniform;
+/* [LightClusters-usage] */
+/* Light positions in view space, updated every frame */
+Containers::Array<Shaders::PhongLightUniform> lights{1024};
+// …
+
+GL::Buffer lightUniform;
+lightUniform.setData(lights);
+
+Shaders::LightClusters clusters;
+clusters.update(projectionMatrix, lights);
+
+Shaders::Phong shader{Shaders::Phong::Flag::ClusteredLights, 1024};
+shader
+    .setViewportSize(Vector2{GL::defaultFramebuffer.viewport().size()})
+    .setLightClusterDepthRange(clusters.depthRange())
+    .bindLightClusterTexture(clusters.clusterTexture())
+    .bindLightClusterIndexTexture(clusters.lightIndexTexture())
+    .bindLightBuffer(lightUniform)
+    .bindProjectionBuffer(projectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindTransformationBuffer(transformationUniform)
+    .bindDrawBuffer(drawUniform)
+    .draw(mesh);
+/* [LightClusters-usage] */
+}
+
+{
+Matrix4 projectionMatrix, cameraMatrix;
+Containers::Array<GL::Mesh> meshes;
+Containers::Array<Matrix4> transformations;
+/* [CascadedShadowMap-usage] */
+/* World-space bounding boxes of all meshes */
+Containers::StridedArrayView1D<const Vector3> centers, extents;
+Containers::Array<UnsignedInt> visible{meshes.size()};
+
+Shaders::CascadedShadowMap shadowMap{{2048, 2048}, 4};
+Shaders::DepthOnly shader;
+
+/* With SceneGraph, pass camera.projectionMatrix() and camera.cameraMatrix() */
+shadowMap.update(projectionMatrix, cameraMatrix,
+    Vector3{-1.0f, -3.0f, -0.5f}.normalized());
+
+/* Binding a cascade sets the viewport to the shadow map size as well */
+for(UnsignedInt i = 0; i != shadowMap.cascadeCount(); ++i) {
+    shadowMap.bindCascade(i);
+    const std::size_t count = shadowMap.cullInto(i, centers, extents, visible);
+    for(UnsignedInt j: visible.prefix(count)) shader
+        .setTransformationProjectionMatrix(
+            shadowMap.lightMatrices()[i]*transformations[j])
+        .draw(meshes[j]);
+}
+/* [CascadedShadowMap-usage] */
+}
+
+{
+Matrix4 projectionMatrix, cameraMatrix;
+Vector2 cameraPosition;
+GL::Texture2D heightmap;
+/* [Terrain-usage] */
+/* A single mesh for the finest level, with no vertex data at all */
+GL::Mesh mesh = MeshTools::compile(Primitives::grid3DProcedural(64));
+
+Shaders::Terrain shader;
+shader.setTransformationProjectionMatrix(projectionMatrix*cameraMatrix)
+    .setHeightScale(0.1f)
+    .bindHeightTexture(heightmap);
+
+/* 8x8 patches, the cell count halves with each ring around the camera */
+auto cellCount = [&](Vector2i patch) -> UnsignedInt {
+    const Vector2 center = (Vector2{patch} + Vector2{0.5f})*0.25f - Vector2{1.0f};
+    const Int ring = Int((center - cameraPosition).length()/0.25f);
+    return 64 >> Math::clamp(ring, 0, 6);
+};
+for(Int y = 0; y != 8; ++y) for(Int x = 0; x != 8; ++x) {
+    const UnsignedInt count = cellCount({x, y});
+    mesh.setCount(Shaders::Terrain::vertexCount(count));
+    shader
+        .setPatch(Range2D::fromSize(Vector2{Vector2i{x, y}}*0.25f - Vector2{1.0f},
+            Vector2{0.25f}))
+        .setCellCount(count, {
+            x ? cellCount({x - 1, y}) : count,
+            x != 7 ? cellCount({x + 1, y}) : count,
+            y ? cellCount({x, y - 1}) : count,
+            y != 7 ? cellCount({x, y + 1}) : count})
+        .draw(mesh);
+}
+/* [Terrain-usage] */
+}
+#endif
+
 {
 /* [MeshVisualizer-usage-geom1] */
 struct Vertex {
@@ -435,6 +893,38 @@ shader.setColor(0x2f83cc_rgbf)
 /* [MeshVisualizer-usage-no-geom2] */
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+Matrix4 transformationMatrix, projectionMatrix;
+/* [MeshVisualizer-usage-vertex-pulling] */
+Containers::ArrayView<const UnsignedInt> indices;
+Containers::ArrayView<const Vector4> positions; /* padded to 4 components */
+
+GL::Buffer indexBuffer{GL::Buffer::TargetHint::Texture, indices};
+GL::Buffer positionBuffer{GL::Buffer::TargetHint::Texture, positions};
+GL::BufferTexture indexTexture, positionTexture;
+indexTexture.setBuffer(GL::BufferTextureFormat::R32UI, indexBuffer);
+positionTexture.setBuffer(GL::BufferTextureFormat::RGBA32F, positionBuffer);
+
+/* No attributes, just the vertex count */
+GL::Mesh mesh;
+mesh.setCount(indices.size());
+
+Shaders::MeshVisualizer3D shader{
+    Shaders::MeshVisualizer3D::Flag::Wireframe|
+    Shaders::MeshVisualizer3D::Flag::NoGeometryShader|
+    Shaders::MeshVisualizer3D::Flag::VertexPulling};
+shader.setColor(0x2f83cc_rgbf)
+    .setWireframeColor(0xdcdcdc_rgbf)
+    .setTransformationMatrix(transformationMatrix)
+    .setProjectionMatrix(projectionMatrix)
+    .bindIndexBufferTexture(indexTexture)
+    .bindPositionBufferTexture(positionTexture)
+    .draw(mesh);
+/* [MeshVisualizer-usage-vertex-pulling] */
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 {
 GL::Mesh mesh;
@@ -463,6 +953,114 @@ shader.setColorMapTransformation(0.0f, 1.0f/Math::max(objectIds))
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+UnsignedInt vertexCount{};
+GL::Buffer basePositions, baseNormals, positionDeltas, normalDeltas;
+/* [MorphTargets-transform-feedback] */
+GL::Buffer positions, normals;
+positions.setData({nullptr, vertexCount*sizeof(Vector3)});
+normals.setData({nullptr, vertexCount*sizeof(Vector3)});
+
+/* Deltas of all three morph targets are in a single buffer, one after
+   another */
+GL::Mesh mesh{MeshPrimitive::Points};
+mesh.setCount(vertexCount)
+    .addVertexBuffer(basePositions, 0, Shaders::MorphTargets::Position{})
+    .addVertexBuffer(baseNormals, 0, Shaders::MorphTargets::Normal{})
+    .addVertexBuffer(positionDeltas, 0*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::PositionDelta<0>{})
+    .addVertexBuffer(positionDeltas, 1*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::PositionDelta<1>{})
+    .addVertexBuffer(positionDeltas, 2*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::PositionDelta<2>{})
+    .addVertexBuffer(normalDeltas, 0*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::NormalDelta<0>{})
+    .addVertexBuffer(normalDeltas, 1*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::NormalDelta<1>{})
+    .addVertexBuffer(normalDeltas, 2*vertexCount*sizeof(Vector3),
+        Shaders::MorphTargets::NormalDelta<2>{});
+
+GL::TransformFeedback feedback;
+feedback.attachBuffer(Shaders::MorphTargets::PositionOutput, positions)
+    .attachBuffer(Shaders::MorphTargets::NormalOutput, normals);
+
+Shaders::MorphTargets shader{Shaders::MorphTargets::Flag::Normals, 3};
+shader.setWeights({0.75f, 0.0f, 0.2f});
+
+GL::Renderer::enable(GL::Renderer::Feature::RasterizerDiscard);
+feedback.begin(shader, GL::TransformFeedback::PrimitiveMode::Points);
+shader.draw(mesh);
+feedback.end();
+GL::Renderer::disable(GL::Renderer::Feature::RasterizerDiscard);
+/* [MorphTargets-transform-feedback] */
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+{
+UnsignedInt vertexCount{};
+GL::Buffer basePositions, positionDeltas;
+/* [MorphTargets-compute] */
+GL::Buffer positions;
+positions.setData({nullptr, vertexCount*sizeof(Vector3)});
+
+Shaders::MorphTargets shader{Shaders::MorphTargets::Flag::Compute, 52};
+shader
+    .setWeight(17, 0.75f)
+    .setWeight(41, 0.2f)
+    .bindBasePositionBuffer(basePositions)
+    .bindPositionDeltaBuffer(positionDeltas)
+    .bindPositionBuffer(positions)
+    .dispatch(vertexCount);
+
+/* Make the output visible to vertex attribute fetches */
+GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::VertexAttributeArray);
+/* [MorphTargets-compute] */
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Float timeDelta{};
+UnsignedInt frame{};
+Matrix4 transformationProjectionMatrix;
+/* [ParticleSystem-usage] */
+/* A million particles, each emitter emitting 100k particles per second */
+Shaders::ParticleSystem particles{1000000};
+Shaders::ParticleUpdate update{2};
+update
+    .setEmitterPosition(0, {-2.0f, 0.0f, 0.0f})
+    .setEmitterVelocity(0, {0.0f, 4.0f, 0.0f}, 0.5f)
+    .setEmitterLifetime(0, 5.0f)
+    .setEmitterPosition(1, {2.0f, 0.0f, 0.0f})
+    .setEmitterVelocity(1, {0.0f, 4.0f, 0.0f}, 0.5f)
+    .setEmitterLifetime(1, 5.0f)
+    .setAcceleration({0.0f, -9.81f, 0.0f})
+    .setStartColor(0xffcc33ff_rgbaf)
+    .setEndColor(0xff330000_rgbaf);
+
+Shaders::VertexColor3D shader;
+GL::Renderer::setBlendFunction(
+    GL::Renderer::BlendFunction::SourceAlpha,
+    GL::Renderer::BlendFunction::OneMinusSourceAlpha);
+
+DOXYGEN_IGNORE(/* ... */)
+
+/* Every frame, update the simulation and draw the latest state */
+update
+    .setTimeDelta(timeDelta)
+    .setSeed(frame++);
+particles.update(update);
+
+GL::Renderer::enable(GL::Renderer::Feature::Blending);
+shader.setTransformationProjectionMatrix(transformationProjectionMatrix)
+    .draw(particles.mesh());
+GL::Renderer::disable(GL::Renderer::Feature::Blending);
+/* [ParticleSystem-usage] */
+}
+#endif
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Phong-usage-colored1] */
@@ -580,6 +1178,27 @@ shader.bindTextures(&diffuseAlphaTexture, &diffuseAlphaTexture, nullptr, nullptr
 /* [Phong-usage-alpha] */
 }
 
+{
+Containers::ArrayView<const Vector3> positions;
+/* [Phong-usage-octahedral] */
+Containers::ArrayView<const Vector3> normals = DOXYGEN_IGNORE(positions);
+
+/* 4 bytes per normal instead of 12 */
+Containers::Array<Vector2s> octahedralNormals{NoInit, normals.size()};
+Math::packOctahedralInto(normals,
+    Containers::stridedArrayView(octahedralNormals));
+
+GL::Mesh mesh;
+mesh.addVertexBuffer(GL::Buffer{positions}, 0, Shaders::Phong::Position{})
+    .addVertexBuffer(GL::Buffer{Containers::arrayView(octahedralNormals)}, 0,
+        Shaders::Phong::OctahedralNormal{
+            Shaders::Phong::OctahedralNormal::DataType::Short,
+            Shaders::Phong::OctahedralNormal::DataOption::Normalized});
+
+Shaders::Phong shader{Shaders::Phong::Flag::OctahedralNormals};
+/* [Phong-usage-octahedral] */
+}
+
 #if !defined(__GNUC__) || defined(__clang__) || __GNUC__*100 + __GNUC_MINOR__ >= 500
 {
 /* [Vector-usage1] */
@@ -612,6 +1231,37 @@ shader.setColor(0x2f83cc_rgbf)
 /* [Vector-usage2] */
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+{
+GL::Mesh mesh;
+Matrix3 transformationMatrix, projectionMatrix;
+GL::Texture2D texture;
+/* [Vector-ubo] */
+GL::Buffer transformationProjectionUniform, materialUniform, drawUniform;
+transformationProjectionUniform.setData({
+    Shaders::TransformationProjectionUniform2D{}
+        .setTransformationProjectionMatrix(projectionMatrix*transformationMatrix)
+});
+materialUniform.setData({
+    Shaders::VectorMaterialUniform{}
+        .setColor(0x2f83cc_rgbf)
+});
+drawUniform.setData({
+    Shaders::VectorDrawUniform{}
+        .setMaterialId(0)
+});
+
+Shaders::Vector2D shader{Shaders::Vector2D::Flag::UniformBuffers};
+shader
+    .bindTransformationProjectionBuffer(transformationProjectionUniform)
+    .bindMaterialBuffer(materialUniform)
+    .bindDrawBuffer(drawUniform)
+    .bindVectorTexture(texture)
+    .draw(mesh);
+/* [Vector-ubo] */
+}
+#endif
+
 {
 /* [VertexColor-usage1] */
 struct Vertex {
@@ -25,16 +25,22 @@
 
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/FileCallback.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
+#include "Magnum/Shaders/DistanceFieldVector.h"
 #include "Magnum/Shaders/Vector.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
 #include "Magnum/Text/Renderer.h"
 
 using namespace Magnum;
@@ -122,6 +128,34 @@ font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
 /* [DistanceFieldGlyphCache-usage] */
 }
 
+{
+Text::DistanceFieldGlyphCache cache{Vector2i{2048}, Vector2i{384}, 16};
+ImageView2D glyphA{PixelFormat::R8Unorm, {64, 64}};
+ImageView2D glyphB{PixelFormat::R8Unorm, {64, 64}};
+/* [DistanceFieldGlyphCache-incremental] */
+/* Upload just the new glyph images */
+cache.queueImage({128, 0}, glyphA);
+cache.queueImage({192, 0}, glyphB);
+
+/* Calculate the distance field only for the two regions */
+cache.flush();
+/* [DistanceFieldGlyphCache-incremental] */
+}
+
+{
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+Containers::Pointer<Text::AbstractFont> font;
+Text::MultiChannelDistanceFieldGlyphCache cache{Vector2i{2048}, Vector2i{192}, 16};
+font->fillGlyphCache(cache, "abcdefghijklmnopqrstuvwxyz"
+                            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                            "0123456789?!:;,. ");
+
+Shaders::DistanceFieldVector2D shader{
+    Shaders::DistanceFieldVector2D::Flag::MultiChannel};
+shader.bindVectorTexture(cache.texture());
+/* [MultiChannelDistanceFieldGlyphCache-usage] */
+}
+
 {
 /* [GlyphCache-usage] */
 Containers::Pointer<Text::AbstractFont> font;
@@ -174,6 +208,79 @@ shader.setTransformationProjectionMatrix(projectionMatrix)
     .bindVectorTexture(cache.texture())
     .draw(renderer.mesh());
 /* [Renderer-usage2] */
+
+/* [Renderer-usage3] */
+struct Vertex {
+    Vector2 position;
+    Vector2 textureCoordinates;
+};
+
+/* Scratch memory and a layouter, both reused for all labels and frames */
+Containers::Array<Vertex> vertices{256*4};
+Containers::Pointer<Text::AbstractLayouter> layouter;
+
+UnsignedInt glyphCount;
+Range2D rectangle;
+std::tie(glyphCount, rectangle) = Text::Renderer2D::renderInto(*font, cache,
+    0.15f, "Hello World Countdown: 10",
+    Containers::stridedArrayView(vertices).slice(&Vertex::position),
+    Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates),
+    layouter, Text::Alignment::LineCenter);
+
+/* Upload the first glyphCount*4 vertices to a vertex buffer */
+vertexBuffer.setSubData(0, vertices.prefix(glyphCount*4));
+/* [Renderer-usage3] */
+
+{
+/* [LayoutCache-usage] */
+/* A cache of at most 1 MB of layouts, shared by all labels */
+Text::LayoutCache layoutCache{1024*1024};
+
+/* Item names repeating in many places are laid out just once */
+std::tie(glyphCount, rectangle) = Text::Renderer2D::renderInto(*font, cache,
+    0.15f, "Sword of a Thousand Truths",
+    Containers::stridedArrayView(vertices).slice(&Vertex::position),
+    Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates),
+    layoutCache);
+
+/* Mutable text renderers can use the cache as well */
+renderer.setLayoutCache(&layoutCache);
+
+/* Check how well the cache is doing */
+Debug{} << layoutCache.hitCount() << "hits," << layoutCache.missCount()
+    << "misses," << layoutCache.memoryUsage() << "bytes used";
+/* [LayoutCache-usage] */
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+/* [BatchRenderer-usage] */
+/* Two materials for all labels, referenced by the material ID */
+GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+    Shaders::VectorMaterialUniform{}.setColor(0xffffff_rgbf),
+    Shaders::VectorMaterialUniform{}.setColor(0xcd3431_rgbf)
+}};
+
+/* Capacity for 1024 glyphs in 128 labels, the shader needs to have at least
+   as many draws as is the run capacity */
+Text::BatchRenderer2D batch{*font, cache, 0.15f, 1024, 128,
+    Text::Alignment::LineCenter};
+Shaders::Vector2D batchShader{Shaders::Vector2D::Flag::VertexDrawId,
+    2, batch.runCapacity()};
+
+batch.add("Hello", Matrix3::translation({-0.5f, 0.0f}));
+UnsignedInt countdown = batch.add("Countdown: 10",
+    Matrix3::translation({0.5f, 0.0f}), 1);
+// ...
+
+/* Draw all labels in a single draw call */
+batch.setProjectionMatrix(projectionMatrix)
+    .setTransformation(countdown, Matrix3::translation({0.5f, 0.25f}));
+batchShader
+    .bindMaterialBuffer(materialUniform)
+    .bindVectorTexture(cache.texture());
+batch.draw(batchShader);
+/* [BatchRenderer-usage] */
+#endif
 }
 
 }
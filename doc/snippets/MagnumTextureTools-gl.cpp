@@ -0,0 +1,134 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/TextureTools/DepthPyramid.h"
+#include "Magnum/TextureTools/UploadTexture.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include "Magnum/GL/SampleQuery.h"
+#endif
+
+using namespace Magnum;
+
+int main() {
+
+#ifndef MAGNUM_TARGET_GLES2
+{
+Vector2i windowSize;
+GL::Texture2D depth;
+Matrix4 viewProjection;
+Containers::ArrayView<const Range3D> boundingBoxes;
+/* [DepthPyramid-usage] */
+TextureTools::DepthPyramid pyramid{windowSize};
+
+/* After rendering the scene depth into a texture, build the pyramid and
+   download just the coarsest levels, at most 32x32 pixels */
+pyramid(depth);
+std::vector<Image2D> images;
+for(Int i = Math::max(pyramid.levelCount() - 6, 0); i != pyramid.levelCount(); ++i)
+    images.push_back(pyramid.image(i));
+
+/* Decide which objects to draw in the next frame */
+std::vector<ImageView2D> levels{images.begin(), images.end()};
+Containers::Array<bool> visible{boundingBoxes.size()};
+TextureTools::depthPyramidVisibilityInto(levels, viewProjection,
+    boundingBoxes, visible);
+/* [DepthPyramid-usage] */
+}
+#endif
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+{
+GL::Mesh boundingBoxMesh;
+struct: GL::AbstractShaderProgram {} flatShader;
+/* [DepthPyramid-fallback] */
+struct Object {
+    GL::SampleQuery query{GL::SampleQuery::Target::AnySamplesPassedConservative};
+    bool queried = false, visible = true;
+    // mesh, transformation, …
+};
+std::vector<Object> objects;
+
+/* … after drawing the occluders */
+GL::Renderer::setColorMask(false, false, false, false);
+GL::Renderer::setDepthMask(false);
+for(Object& object: objects) {
+    /* Pick up the previous result if the GPU is done with it already */
+    if(object.queried && object.query.resultAvailable()) {
+        object.visible = object.query.result<bool>();
+        object.queried = false;
+    }
+    if(object.queried) continue;
+
+    object.query.begin();
+    flatShader.draw(boundingBoxMesh);
+    object.query.end();
+    object.queried = true;
+}
+GL::Renderer::setColorMask(true, true, true, true);
+GL::Renderer::setDepthMask(true);
+
+/* Draw only objects that were visible the last time the query finished */
+for(Object& object: objects) if(object.visible) {
+    // draw the object…
+}
+/* [DepthPyramid-fallback] */
+}
+#endif
+
+{
+/* [uploadTexture2D] */
+PluginManager::Manager<Trade::AbstractImporter> manager;
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("AnyImageImporter");
+if(!importer || !importer->openFile("texture.dds"))
+    Fatal{} << "Can't open the file";
+
+Containers::Optional<GL::Texture2D> texture =
+    TextureTools::uploadTexture2D(*importer, 0);
+if(!texture) Fatal{} << "Can't upload the texture";
+
+texture->setMagnificationFilter(GL::SamplerFilter::Linear)
+    .setMinificationFilter(GL::SamplerFilter::Linear, GL::SamplerMipmap::Linear)
+    .setWrapping(GL::SamplerWrapping::ClampToEdge);
+/* [uploadTexture2D] */
+}
+}
@@ -0,0 +1,82 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/TextureTools/GenerateMipmaps.h"
+#include "Magnum/TextureTools/SwizzleImage.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+using namespace Magnum;
+
+int main() {
+
+{
+ImageView2D image{PixelFormat::RGBA8Srgb, {}};
+/* [generateMipmaps] */
+Containers::Array<Image2D> levels = TextureTools::generateMipmaps(image,
+    TextureTools::MipmapFilter::Kaiser, 0);
+
+PluginManager::Manager<Trade::AbstractImageConverter> manager;
+Containers::Pointer<Trade::AbstractImageConverter> converter =
+    manager.loadAndInstantiate("MagnumImageConverter");
+
+/* Base level first, then the generated ones */
+Containers::Array<char> out;
+for(UnsignedInt i = 0; i != levels.size() + 1; ++i) {
+    converter->configuration().setValue("level", i);
+    Containers::Array<char> data = converter->exportToData(
+        i == 0 ? image : ImageView2D{levels[i - 1]});
+    arrayAppend(out, data);
+}
+
+Utility::Directory::write("image.blob", out);
+/* [generateMipmaps] */
+}
+
+{
+PluginManager::Manager<Trade::AbstractImporter> manager;
+/* [swizzleImageInPlace] */
+Containers::Pointer<Trade::AbstractImporter> importer =
+    manager.loadAndInstantiate("TgaImporter");
+importer->configuration().setValue("swizzle", false);
+Containers::Optional<Trade::ImageData2D> image;
+if(!importer->openFile("image.tga") || !(image = importer->image2D(0)))
+    Fatal{} << "Can't import the image";
+
+/* The data are in a BGRA order, swap the first and third channel */
+TextureTools::swizzleImageInPlace(*image, {2, 1, 0, 3});
+/* [swizzleImageInPlace] */
+}
+
+}
@@ -0,0 +1,77 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/Atlas.h"
+#include "Magnum/TextureTools/PackTextureArrays.h"
+
+using namespace Magnum;
+
+int main() {
+
+{
+/* [AtlasPacker-usage] */
+TextureTools::AtlasPacker packer{{1024, 1024}, {1, 1}};
+
+/* Place a new texture whenever it's needed */
+Vector2i size{48, 32};
+Containers::Optional<Vector2i> offset = packer.add(size);
+if(offset) {
+    Range2Di region = Range2Di::fromSize(*offset, size);
+    // upload the texture to region…
+    static_cast<void>(region);
+} else {
+    Debug{} << "Atlas is full," << packer.freeArea() << "pixels left";
+    // create a new atlas…
+}
+/* [AtlasPacker-usage] */
+}
+
+{
+Containers::ArrayView<const ImageView2D> images;
+/* [packTextureArrays] */
+Containers::Array<TextureTools::TextureArrayPlacement> placements{images.size()};
+Containers::Array<Image3D> arrays =
+    TextureTools::packTextureArrays(images, placements, {512, 512}, {2, 2});
+
+// upload each of arrays to a GL::Texture2DArray…
+
+/* When drawing image i, bind array placements[i].array and set up the
+   shader with the matrix and layer */
+for(const TextureTools::TextureArrayPlacement& placement: placements) {
+    Matrix3 textureMatrix = placement.textureMatrix;
+    Int layer = placement.layer;
+    // draw…
+    static_cast<void>(textureMatrix);
+    static_cast<void>(layer);
+}
+/* [packTextureArrays] */
+}
+
+}
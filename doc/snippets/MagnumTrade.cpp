@@ -24,6 +24,8 @@
 */
 
 #include <unordered_map>
+#include <vector>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Resource.h>
@@ -37,8 +39,13 @@
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/MeshTools/Interleave.h"
 #include "Magnum/MeshTools/Transform.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
 #include "Magnum/Trade/AnimationData.h"
+#include "Magnum/Trade/ArrayArena.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/DerivedDataCache.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
@@ -49,6 +56,7 @@
 #include "Magnum/Trade/PbrSpecularGlossinessMaterialData.h"
 #include "Magnum/Trade/PbrMetallicRoughnessMaterialData.h"
 #include "Magnum/Trade/PhongMaterialData.h"
+#include "Magnum/Trade/SceneData.h"
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
@@ -120,8 +128,93 @@ importer->setFileCallback([](const std::string& filename,
 importer->openFile("scene.gltf"); // memory-maps all files
 /* [AbstractImporter-usage-callbacks] */
 }
+
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [MappedFileCallback] */
+MappedFileCallback files;
+importer->setFlags(Trade::ImporterFlag::ZeroCopy);
+importer->setFileCallback(MappedFileCallback::callback, files);
+
+/* The files stay mapped until the importer is done with them */
+importer->openFile("scene.gltf");
+Containers::Optional<Trade::MeshData> mesh = importer->mesh(0);
+
+// use the mesh ...
+
+importer->close();
+files.unmap();
+/* [MappedFileCallback] */
+}
 #endif
 
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [AsyncImporter] */
+importer->openFile("scene.gltf");
+
+/* Query everything needed upfront, the importer can't be used directly while
+   the imports are running */
+const UnsignedInt meshCount = importer->meshCount();
+
+Trade::AsyncImporter async{*importer};
+std::vector<std::future<Containers::Optional<Trade::MeshData>>> meshes;
+for(UnsignedInt i = 0; i != meshCount; ++i)
+    meshes.push_back(async.mesh(i));
+
+/* Process the meshes in order as they get ready, while the rest is still
+   being imported in the background */
+for(std::future<Containers::Optional<Trade::MeshData>>& mesh: meshes) {
+    Containers::Optional<Trade::MeshData> data = mesh.get();
+    if(!data) continue;
+
+    // upload the mesh ...
+}
+/* [AsyncImporter] */
+}
+
+{
+PluginManager::Manager<Trade::AbstractImporter> importerManager;
+PluginManager::Manager<Trade::AbstractSceneConverter> sceneConverterManager;
+PluginManager::Manager<Trade::AbstractImageConverter> imageConverterManager;
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [DerivedDataCache] */
+Containers::Pointer<Trade::AbstractImporter> blobImporter =
+    importerManager.loadAndInstantiate("MagnumImporter");
+Containers::Pointer<Trade::AbstractSceneConverter> blobSceneConverter =
+    sceneConverterManager.loadAndInstantiate("MagnumSceneConverter");
+Containers::Pointer<Trade::AbstractImageConverter> blobImageConverter =
+    imageConverterManager.loadAndInstantiate("MagnumImageConverter");
+Trade::DerivedDataCache cache{"cache/", *blobImporter,
+    *blobSceneConverter, *blobImageConverter};
+
+/* Imported and interleaved only if the file or the pipeline changed since the
+   last run, otherwise the result is directly mapped from the cache */
+Containers::Optional<Trade::MeshData> mesh = cache.mesh(*importer,
+    "chair.gltf", 0, "interleave-v1", [](Trade::MeshData&& mesh, void*) {
+        return Containers::optional(MeshTools::interleave(std::move(mesh)));
+    });
+/* [DerivedDataCache] */
+}
+
+{
+ImageView2D levels[1]{ImageView2D{PixelFormat::RGBA8Unorm, {}}};
+/* [MagnumImageConverter-levels] */
+PluginManager::Manager<Trade::AbstractImageConverter> manager;
+Containers::Pointer<Trade::AbstractImageConverter> converter =
+    manager.loadAndInstantiate("MagnumImageConverter");
+
+Containers::Array<char> out;
+for(UnsignedInt i = 0; i != Containers::arraySize(levels); ++i) {
+    converter->configuration().setValue("level", i);
+    Containers::Array<char> data = converter->exportToData(levels[i]);
+    arrayAppend(out, data);
+}
+
+Utility::Directory::write("image.blob", out);
+/* [MagnumImageConverter-levels] */
+}
+
 {
 Containers::Pointer<Trade::AbstractImporter> importer;
 Int materialIndex;
@@ -159,6 +252,58 @@ importer->setFileCallback([](const std::string& filename,
 /* [AbstractImporter-setFileCallback-template] */
 }
 
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [AbstractImporter-setProfileCallback] */
+importer->setProfileCallback([](Trade::ImporterProfileStage stage,
+    UnsignedLong duration, std::size_t byteCount, void*) {
+        Debug{} << stage << "took" << duration/1.0e6 << "ms for"
+            << byteCount << "bytes";
+    });
+/* [AbstractImporter-setProfileCallback] */
+}
+
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [AbstractSceneConverter-usage-multiple] */
+PluginManager::Manager<Trade::AbstractSceneConverter> manager;
+Containers::Pointer<Trade::AbstractSceneConverter> converter =
+    manager.loadAndInstantiate("AnySceneConverter");
+if(!converter || !converter->beginFile("scene.out"))
+    Fatal{} << "Can't begin conversion to scene.out";
+
+/* Only one mesh is kept in memory at a time */
+for(UnsignedInt i = 0; i != importer->meshCount(); ++i) {
+    Containers::Optional<Trade::MeshData> mesh = importer->mesh(i);
+    if(!mesh || !converter->add(*mesh, importer->meshName(i)))
+        Fatal{} << "Can't convert mesh" << i;
+}
+
+if(!converter->endFile())
+    Fatal{} << "Can't finish conversion to scene.out";
+/* [AbstractSceneConverter-usage-multiple] */
+}
+
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [ArrayArena-usage] */
+Trade::ArrayArena levelArena{16*1024*1024};
+importer->setArrayArena(&levelArena);
+
+Containers::Array<Trade::MeshData> meshes;
+for(UnsignedInt i = 0; i != importer->meshCount(); ++i)
+    if(Containers::Optional<Trade::MeshData> mesh = importer->mesh(i))
+        arrayAppend(meshes, std::move(*mesh));
+
+// ...
+
+/* Unloading the level. The meshes can be destroyed in any order, the memory
+   is freed at once. */
+meshes = nullptr;
+levelArena.release();
+/* [ArrayArena-usage] */
+}
+
 {
 UnsignedInt id{};
 Containers::Pointer<Trade::AbstractImporter> importer;
@@ -199,6 +344,31 @@ for(UnsignedInt i = 0; i != data.trackCount(); ++i) {
 /* [AnimationData-usage-mutable] */
 }
 
+{
+Trade::AnimationData animation{nullptr, {}};
+Float time{};
+Containers::Array<Vector3> positions;
+/* [resampleAnimation] */
+Trade::AnimationData resampled = Trade::resampleAnimation(animation, 60.0f);
+
+/* Frame index and interpolation factor shared by all tracks */
+Containers::StridedArrayView1D<const Float> keys = resampled.track(0).keys();
+const Float frame = Math::clamp(
+    (time - keys[0])/resampled.duration().size()*(keys.size() - 1),
+    0.0f, Float(keys.size() - 1));
+const std::size_t i = Math::min(std::size_t(frame), keys.size() - 2);
+const Float t = frame - i;
+
+for(UnsignedInt j = 0; j != resampled.trackCount(); ++j) {
+    if(resampled.trackTargetType(j) != Trade::AnimationTrackTargetType::Translation3D)
+        continue;
+    Containers::StridedArrayView1D<const Vector3> values =
+        resampled.track<Vector3>(j).values();
+    positions[resampled.trackTarget(j)] = Math::lerp(values[i], values[i + 1], t);
+}
+/* [resampleAnimation] */
+}
+
 {
 /* [ImageData-construction] */
 Containers::Array<char> data;
@@ -377,6 +547,32 @@ if(data.types() & Trade::MaterialType::PbrClearCoat) {
 /* [MaterialData-usage-layers-types] */
 }
 
+{
+Containers::ArrayView<const Trade::MaterialData> materials;
+/* [MaterialData-usage-extraction] */
+struct MaterialUniform {
+    Color4 ambientColor{0.0f, 1.0f};
+    Color4 diffuseColor{1.0f};
+    Float shininess = 80.0f;
+    Float alphaMask = 0.5f;
+};
+
+constexpr Trade::MaterialAttributeTarget targets[]{
+    {Trade::MaterialAttribute::AmbientColor,
+        offsetof(MaterialUniform, ambientColor)},
+    {Trade::MaterialAttribute::DiffuseColor,
+        offsetof(MaterialUniform, diffuseColor)},
+    {Trade::MaterialAttribute::Shininess, offsetof(MaterialUniform, shininess)},
+    {Trade::MaterialAttribute::AlphaMask, offsetof(MaterialUniform, alphaMask)}
+};
+
+/* Defaults are filled by the constructor, present attributes override them */
+Containers::Array<MaterialUniform> uniforms{materials.size()};
+for(std::size_t i = 0; i != materials.size(); ++i)
+    materials[i].extractAttributes(targets, &uniforms[i]);
+/* [MaterialData-usage-extraction] */
+}
+
 {
 /* [MaterialData-populating] */
 Trade::MaterialData data{Trade::MaterialType::PbrMetallicRoughness, {
@@ -638,6 +834,24 @@ Trade::MeshData data{MeshPrimitive::Triangles,
 /* [MeshData-populating] */
 }
 
+{
+Trade::MeshData data{MeshPrimitive::Points, 0};
+Containers::ArrayView<const Float> weights;
+/* [MeshData-morph-targets] */
+/* Base positions */
+Containers::Array<Vector3> positions = data.positions3DAsArray();
+
+/* Add deltas of all morph targets that have a position, scaled by a weight */
+for(UnsignedInt i = 0; i != data.morphTargetCount(); ++i) {
+    if(!data.hasAttribute(Trade::MeshAttribute::Position, i)) continue;
+
+    Containers::Array<Vector3> deltas = data.positions3DAsArray(0, i);
+    for(std::size_t j = 0; j != positions.size(); ++j)
+        positions[j] += weights[i]*deltas[j];
+}
+/* [MeshData-morph-targets] */
+}
+
 {
 struct Vertex {
     Vector3 position;
@@ -758,4 +972,34 @@ Matrix4 transformation =
 static_cast<void>(transformation);
 }
 
+{
+/* [SceneFieldData-usage] */
+Containers::StridedArrayView1D<const Int> parents;
+
+Trade::SceneFieldData data{Trade::SceneField::Parent, parents};
+/* [SceneFieldData-usage] */
+}
+
+{
+Containers::Pointer<Trade::AbstractImporter> importer;
+/* [SceneData-fields] */
+Containers::Optional<Trade::SceneData> scene = importer->scene(0);
+if(!scene || !scene->hasField(Trade::SceneField::Parent) ||
+             !scene->hasField(Trade::SceneField::Transformation) ||
+              scene->fieldType(Trade::SceneField::Transformation) != Trade::SceneFieldType::Matrix4)
+    Fatal{} << "Oh no :(";
+
+/* Calculate absolute transformations of all objects, assuming parents are
+   always listed before their children */
+Containers::StridedArrayView1D<const Int> parents =
+    scene->field<Int>(Trade::SceneField::Parent);
+Containers::StridedArrayView1D<const Matrix4> transformations =
+    scene->field<Matrix4>(Trade::SceneField::Transformation);
+Containers::Array<Matrix4> absolute{Containers::NoInit, scene->objectCount()};
+for(std::size_t i = 0; i != absolute.size(); ++i)
+    absolute[i] = parents[i] == -1 ? transformations[i] :
+        absolute[parents[i]]*transformations[i];
+/* [SceneData-fields] */
+}
+
 }
@@ -24,30 +24,53 @@
 */
 
 #include <string>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/ImageView.h"
 #include "Magnum/Magnum.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/BindlessTable.h"
 #include "Magnum/Vk/BufferCreateInfo.h"
 #include "Magnum/Vk/CommandBuffer.h"
 #include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
 #include "Magnum/Vk/DeviceCreateInfo.h"
 #include "Magnum/Vk/DeviceFeatures.h"
 #include "Magnum/Vk/DeviceProperties.h"
 #include "Magnum/Vk/Extensions.h"
 #include "Magnum/Vk/ExtensionProperties.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
 #include "Magnum/Vk/FramebufferCreateInfo.h"
+#include "Magnum/Vk/FrameCommandPools.h"
+#include "Magnum/Vk/FrameLoop.h"
+#include "Magnum/Vk/FrameDescriptorPools.h"
 #include "Magnum/Vk/InstanceCreateInfo.h"
 #include "Magnum/Vk/Integration.h"
 #include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/ImageStateTracker.h"
 #include "Magnum/Vk/ImageViewCreateInfo.h"
 #include "Magnum/Vk/LayerProperties.h"
 #include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/PipelineCache.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
 #include "Magnum/Vk/Queue.h"
 #include "Magnum/Vk/RenderPassCreateInfo.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
 #include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/StagingUploader.h"
+#include "Magnum/Vk/Swapchain.h"
 #include "MagnumExternal/Vulkan/flextVkGlobal.h"
 
 /* [wrapping-include-createinfo] */
@@ -166,6 +189,40 @@ buffer.bindMemory(memory, 0);
 /* [Buffer-creation-custom-allocation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [Buffer-creation-allocator] */
+Vk::MemoryAllocator allocator{device};
+
+DOXYGEN_IGNORE()
+
+Vk::Buffer buffer{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::VertexBuffer, 1024*1024},
+    allocator, Vk::MemoryFlag::DeviceLocal
+};
+/* [Buffer-creation-allocator] */
+}
+
+{
+Vk::CommandPool pool{DOXYGEN_IGNORE(NoCreate)};
+VkRenderPass renderPass{};
+VkFramebuffer framebuffer{};
+/* [CommandBuffer-recording-secondary] */
+Vk::CommandBuffer secondary = pool.allocate(Vk::CommandBufferLevel::Secondary);
+secondary.begin(Vk::CommandBufferBeginInfo{renderPass, 0, framebuffer});
+DOXYGEN_IGNORE()
+secondary.end();
+
+Vk::CommandBuffer primary = pool.allocate();
+primary.begin();
+/* Begin the render pass with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS */
+DOXYGEN_IGNORE()
+primary.executeCommands({secondary});
+DOXYGEN_IGNORE()
+primary.end();
+/* [CommandBuffer-recording-secondary] */
+}
+
 {
 /* The include should be a no-op here since it was already included above */
 /* [CommandPool-creation] */
@@ -187,6 +244,39 @@ Vk::CommandBuffer commandBuffer = graphicsCommandPool.allocate();
 /* [CommandPool-allocation] */
 }
 
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+VkDescriptorSetLayout layout{};
+/* The include should be a no-op here since it was already included above */
+/* [DescriptorPool-creation] */
+#include <Magnum/Vk/DescriptorPoolCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::DescriptorPool pool{device, Vk::DescriptorPoolCreateInfo{8, {
+    {Vk::DescriptorType::UniformBuffer, 24},
+    {Vk::DescriptorType::CombinedImageSampler, 16}
+}}};
+
+Vk::DescriptorSet set = pool.allocate(layout);
+/* [DescriptorPool-creation] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [DescriptorSetLayout-creation] */
+#include <Magnum/Vk/DescriptorSetLayoutCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::DescriptorSetLayout layout{device, Vk::DescriptorSetLayoutCreateInfo{
+    {0, Vk::DescriptorType::UniformBuffer, 1, Vk::ShaderStage::Vertex},
+    {1, Vk::DescriptorType::CombinedImageSampler, 1, Vk::ShaderStage::Fragment}
+}};
+/* [DescriptorSetLayout-creation] */
+}
+
 {
 Vk::Instance instance;
 /* The include should be a no-op here since it was already included above */
@@ -292,6 +382,218 @@ if(device.isExtensionEnabled<Vk::Extensions::EXT::index_type_uint8>()) {
 /* [Device-isExtensionEnabled] */
 }
 
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [Fence-creation] */
+#include <Magnum/Vk/FenceCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::Fence fence{device, Vk::FenceCreateInfo{
+    Vk::FenceCreateInfo::Flag::Signaled}};
+/* [Fence-creation] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Shader shader{DOXYGEN_IGNORE(NoCreate)};
+Vk::PipelineLayout layout{DOXYGEN_IGNORE(NoCreate)};
+Vk::RenderPass renderPass{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [Pipeline-creation-graphics] */
+#include <Magnum/Vk/PipelineCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::Pipeline pipeline{device, Vk::GraphicsPipelineCreateInfo{
+        layout, renderPass, 0, 1}
+    .addShader(Vk::ShaderStage::Vertex, shader, "ver")
+    .addShader(Vk::ShaderStage::Fragment, shader, "fra")
+    .addVertexBinding(0, sizeof(Vector3) + sizeof(Color3))
+    .addVertexAttribute(0, 0, VertexFormat::Vector3, 0)
+    .addVertexAttribute(1, 0, VertexFormat::Vector3, sizeof(Vector3))
+    .setPrimitive(MeshPrimitive::Triangles)
+    .setViewport(Range2D{{}, {800.0f, 600.0f}})
+    .setDepthTest(true)
+};
+/* [Pipeline-creation-graphics] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Shader shader{DOXYGEN_IGNORE(NoCreate)};
+Vk::PipelineLayout layout{DOXYGEN_IGNORE(NoCreate)};
+/* [Pipeline-creation-compute] */
+Vk::Pipeline pipeline{device, Vk::ComputePipelineCreateInfo{layout, shader}};
+/* [Pipeline-creation-compute] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Shader shader{DOXYGEN_IGNORE(NoCreate)};
+Vk::PipelineLayout layout{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [PipelineCache-usage] */
+#include <Magnum/Vk/PipelineCache.h>
+
+DOXYGEN_IGNORE()
+
+/* Reuse what the previous run compiled, if anything */
+Vk::PipelineCache cache = Vk::PipelineCache::load(device,
+    Utility::Directory::join(Utility::Directory::configurationDir("MyApp"),
+        "pipelines.bin"));
+
+/* Create all pipelines known upfront before rendering the first frame */
+Vk::Pipeline pipeline{device,
+    Vk::ComputePipelineCreateInfo{layout, shader}, cache};
+DOXYGEN_IGNORE()
+
+/* Save the cache for the next run on exit */
+cache.save(Utility::Directory::join(
+    Utility::Directory::configurationDir("MyApp"), "pipelines.bin"));
+/* [PipelineCache-usage] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [PipelineLayout-creation] */
+#include <Magnum/Vk/PipelineLayoutCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::PipelineLayout layout{device, Vk::PipelineLayoutCreateInfo{}
+    .addPushConstantRange(Vk::ShaderStage::Vertex, 0, sizeof(Matrix4))
+};
+/* [PipelineLayout-creation] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Queue queue{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer commandBuffers[2]{
+    Vk::CommandBuffer{NoCreate}, Vk::CommandBuffer{NoCreate}};
+bool running = true;
+/* [Fence-usage] */
+/* One fence per frame in flight, created signaled so the first wait doesn't
+   block */
+Vk::Fence fences[2]{
+    Vk::Fence{device, Vk::FenceCreateInfo{Vk::FenceCreateInfo::Flag::Signaled}},
+    Vk::Fence{device, Vk::FenceCreateInfo{Vk::FenceCreateInfo::Flag::Signaled}}
+};
+
+for(std::size_t frame = 0; running; ++frame) {
+    /* Wait until the GPU is done with the frame that used the same
+       resources two frames ago */
+    Vk::Fence& fence = fences[frame % 2];
+    fence.wait();
+    fence.reset();
+
+    /* Record commandBuffers[frame % 2] while the GPU executes the previous
+       frame */
+    DOXYGEN_IGNORE()
+
+    Vk::SubmitInfo info;
+    info.setCommandBuffers({commandBuffers[frame % 2]});
+    queue.submit({info}, fence);
+}
+/* [Fence-usage] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Queue queue{DOXYGEN_IGNORE(NoCreate)};
+Vk::Fence fences[2]{Vk::Fence{NoCreate}, Vk::Fence{NoCreate}};
+VkRenderPass renderPass{};
+VkFramebuffer framebuffer{};
+UnsignedInt threadCount{}, queueFamily{};
+bool running = true;
+/* The include should be a no-op here since it was already included above */
+/* [FrameCommandPools] */
+#include <Magnum/Vk/FrameCommandPools.h>
+
+DOXYGEN_IGNORE()
+
+/* A pool for each worker and each of the two frames in flight */
+Vk::FrameCommandPools pools{device, queueFamily, threadCount, 2};
+
+while(running) {
+    /* Ensure the GPU is done with the frame slot before it gets reused */
+    fences[pools.frame()].wait();
+    fences[pools.frame()].reset();
+
+    /* Each worker records a part of the scene into a secondary buffer
+       allocated from its own pool */
+    Containers::Array<VkCommandBuffer> secondary{threadCount};
+    DOXYGEN_IGNORE(for(UnsignedInt thread = 0; thread != threadCount; ++thread)) {
+        Vk::CommandBuffer buffer = pools.allocate(thread,
+            Vk::CommandBufferLevel::Secondary);
+        buffer.begin(Vk::CommandBufferBeginInfo{renderPass, 0, framebuffer,
+            Vk::CommandBufferBeginInfo::Flag::OneTimeSubmit});
+        DOXYGEN_IGNORE()
+        buffer.end();
+        secondary[thread] = buffer;
+    }
+
+    /* The main thread puts them together and submits */
+    Vk::CommandBuffer primary = pools.allocate(0);
+    primary.begin(Vk::CommandBufferBeginInfo{
+        Vk::CommandBufferBeginInfo::Flag::OneTimeSubmit});
+    DOXYGEN_IGNORE()
+    primary.executeCommands(secondary);
+    DOXYGEN_IGNORE()
+    primary.end();
+
+    Vk::SubmitInfo info;
+    info.setCommandBuffers({primary});
+    queue.submit({info}, fences[pools.frame()]);
+
+    /* Switch to the other frame slot and reset its pools */
+    pools.nextFrame();
+}
+/* [FrameCommandPools] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Fence fences[2]{Vk::Fence{NoCreate}, Vk::Fence{NoCreate}};
+Vk::CommandBuffer cmd{NoCreate};
+VkDescriptorSetLayout layout{};
+VkPipelineLayout pipelineLayout{};
+UnsignedInt threadCount{};
+bool running = true;
+/* The include should be a no-op here since it was already included above */
+/* [FrameDescriptorPools] */
+#include <Magnum/Vk/FrameDescriptorPools.h>
+
+DOXYGEN_IGNORE()
+
+/* Pools for each worker and each of the two frames in flight, each pool
+   holding at most 64 sets with one uniform buffer each */
+Vk::FrameDescriptorPools pools{device, threadCount, 2, 64, {
+    {Vk::DescriptorType::UniformBuffer, 64}
+}};
+
+while(running) {
+    /* Ensure the GPU is done with the frame slot before it gets reused */
+    fences[pools.frame()].wait();
+    fences[pools.frame()].reset();
+
+    /* Each worker allocates per-draw sets from its own pools */
+    DOXYGEN_IGNORE(UnsignedInt thread{};)
+    Vk::DescriptorSet set = pools.allocate(thread, layout);
+    DOXYGEN_IGNORE()
+    cmd.bindDescriptorSets(Vk::PipelineBindPoint::Graphics, pipelineLayout, 0,
+        {set});
+    DOXYGEN_IGNORE()
+
+    /* Switch to the other frame slot and reset its pools */
+    pools.nextFrame();
+}
+/* [FrameDescriptorPools] */
+}
+
 {
 Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
 Vector2i size;
@@ -359,6 +661,20 @@ image.bindMemory(memory, 0);
 /* [Image-creation-custom-allocation] */
 }
 
+{
+Vk::Device device{NoCreate};
+/* [Image-creation-allocator] */
+Vk::MemoryAllocator allocator{device};
+
+DOXYGEN_IGNORE()
+
+Vk::Image image{device, Vk::ImageCreateInfo2D{
+        Vk::ImageUsage::Sampled, VK_FORMAT_R8G8B8A8_SRGB, {1024, 1024}, 1
+    }, allocator, Vk::MemoryFlag::DeviceLocal
+};
+/* [Image-creation-allocator] */
+}
+
 {
 Vk::Device device{NoCreate};
 /* The include should be a no-op here since it was already included above */
@@ -529,6 +845,123 @@ indices.bindMemory(memory, indicesOffset);
 /* [Memory-mapping] */
 }
 
+{
+Vk::Device device{NoCreate};
+Containers::ArrayView<const char> vertexData, stagingData;
+/* The include should be a no-op here since it was already included above */
+/* [MemoryAllocator] */
+#include <Magnum/Vk/MemoryAllocator.h>
+
+DOXYGEN_IGNORE()
+
+/* Should outlive all resources allocated from it */
+Vk::MemoryAllocator allocator{device};
+
+/* A long-lived vertex buffer */
+Vk::Buffer vertices{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::VertexBuffer, vertexData.size()},
+    allocator, Vk::MemoryFlag::DeviceLocal};
+
+/* A transient staging buffer, the memory gets reused once all linear
+   allocations from the same block are gone */
+Vk::Buffer staging{device,
+    Vk::BufferCreateInfo{Vk::BufferUsage::TransferSource, stagingData.size()},
+    allocator, Vk::MemoryFlag::HostVisible,
+    Vk::MemoryAllocationStrategy::Linear};
+
+/* Map just the range belonging to the buffer */
+Vk::MemoryAllocation& allocation = staging.allocatedMemory();
+Containers::Array<char, Vk::MemoryMapDeleter> mapped =
+    allocation.memory().map(allocation.offset(), allocation.size());
+Utility::copy(stagingData, mapped.prefix(stagingData.size()));
+/* [MemoryAllocator] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [QueryPool-creation] */
+#include <Magnum/Vk/QueryPoolCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::QueryPool timestamps{device,
+    Vk::QueryPoolCreateInfo{Vk::QueryType::Timestamp, 2}};
+Vk::QueryPool statistics{device, Vk::QueryPoolCreateInfo{
+    Vk::QueryPipelineStatistic::InputAssemblyVertices|
+    Vk::QueryPipelineStatistic::VertexShaderInvocations, 1}};
+/* [QueryPool-creation] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::QueryPool pool{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer cmd{DOXYGEN_IGNORE(NoCreate)};
+/* [QueryPool-usage] */
+cmd.resetQueryPool(pool, 0, 2)
+   .writeTimestamp(Vk::PipelineStage::TopOfPipe, pool, 0);
+DOXYGEN_IGNORE()
+cmd.writeTimestamp(Vk::PipelineStage::BottomOfPipe, pool, 1);
+
+DOXYGEN_IGNORE()
+
+/* Once the command buffer finished executing */
+UnsignedLong timestamps[2];
+if(pool.results(0, 2, timestamps)) {
+    Float period = device.properties().properties().properties.limits.timestampPeriod;
+    Debug{} << "GPU time:" << (timestamps[1] - timestamps[0])*period << "ns";
+}
+/* [QueryPool-usage] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Queue queue{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer commandBuffer{DOXYGEN_IGNORE(NoCreate)};
+Vk::Semaphore imageAvailable{DOXYGEN_IGNORE(NoCreate)},
+    renderFinished{DOXYGEN_IGNORE(NoCreate)};
+/* [Queue-submit] */
+Vk::Fence fence{device, Vk::FenceCreateInfo{}};
+
+/* Wait for the swapchain image before writing to it, signal once done so it
+   can be presented */
+Vk::SubmitInfo info;
+info.setWaitSemaphores({imageAvailable},
+        {Vk::PipelineStage::ColorAttachmentOutput})
+    .setCommandBuffers({commandBuffer})
+    .setSignalSemaphores({renderFinished});
+queue.submit({info}, fence);
+
+DOXYGEN_IGNORE()
+
+fence.wait();
+/* [Queue-submit] */
+}
+
+{
+Vk::Queue transferQueue{DOXYGEN_IGNORE(NoCreate)},
+    graphicsQueue{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer upload{DOXYGEN_IGNORE(NoCreate)},
+    draw{DOXYGEN_IGNORE(NoCreate)};
+Vk::Semaphore timeline{DOXYGEN_IGNORE(NoCreate)};
+UnsignedLong frame{};
+/* [Queue-submit-timeline] */
+/* The upload for this frame signals 2*frame + 1 on the transfer queue */
+Vk::SubmitInfo uploadInfo;
+uploadInfo.setCommandBuffers({upload})
+    .setSignalSemaphores({timeline}, {2*frame + 1});
+transferQueue.submit({uploadInfo});
+
+/* Drawing waits for the upload and signals 2*frame + 2 once done */
+Vk::SubmitInfo drawInfo;
+drawInfo.setWaitSemaphores({timeline}, {Vk::PipelineStage::VertexInput},
+        {2*frame + 1})
+    .setCommandBuffers({draw})
+    .setSignalSemaphores({timeline}, {2*frame + 2});
+graphicsQueue.submit({drawInfo});
+/* [Queue-submit-timeline] */
+}
+
 {
 Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
 /* The include should be a no-op here since it was already included above */
@@ -585,6 +1018,31 @@ Vk::RenderPass renderPass{device, Vk::RenderPassCreateInfo{}
 /* [RenderPass-creation-layout] */
 }
 
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* The include should be a no-op here since it was already included above */
+/* [Semaphore-creation] */
+#include <Magnum/Vk/SemaphoreCreateInfo.h>
+
+DOXYGEN_IGNORE()
+
+Vk::Semaphore semaphore{device, Vk::SemaphoreCreateInfo{}};
+/* [Semaphore-creation] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+/* [Semaphore-timeline] */
+Vk::Semaphore timeline{device,
+    Vk::SemaphoreCreateInfo{Vk::SemaphoreType::Timeline}};
+
+DOXYGEN_IGNORE()
+
+/* Block until the GPU finishes the batch that signals the value 3 */
+timeline.wait(3);
+/* [Semaphore-timeline] */
+}
+
 {
 Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
 /* The include should be a no-op here since it was already included above */
@@ -603,6 +1061,129 @@ Vk::Shader shader{device, info};
 /* [Shader-creation] */
 }
 
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Queue transferQueue{DOXYGEN_IGNORE(NoCreate)}, graphicsQueue{DOXYGEN_IGNORE(NoCreate)};
+Vk::Buffer vertices{DOXYGEN_IGNORE(NoCreate)}, indices{DOXYGEN_IGNORE(NoCreate)};
+Vk::Image texture{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer cmd{DOXYGEN_IGNORE(NoCreate)};
+UnsignedInt transferFamily{}, graphicsFamily{};
+Containers::ArrayView<const char> vertexData, indexData;
+ImageView2D image{PixelFormat::RGBA8Unorm, {}};
+/* [StagingUploader-usage] */
+Vk::StagingUploader uploader{device, transferQueue, transferFamily,
+    graphicsFamily};
+
+/* Upload everything, possibly from multiple sources, in one batch */
+uploader.upload(vertices, 0, vertexData);
+uploader.upload(indices, 0, indexData);
+uploader.upload(texture, image, Vk::ImageLayout::ShaderReadOnly);
+UnsignedLong value = uploader.flush();
+
+/* Take over the ownership on the graphics queue and wait for the upload to
+   finish before the vertex input and fragment shader stages */
+uploader.acquire(cmd);
+DOXYGEN_IGNORE()
+Vk::SubmitInfo info;
+info.setWaitSemaphores({uploader.semaphore()},
+        {Vk::PipelineStage::VertexInput|Vk::PipelineStage::FragmentShader},
+        {value})
+    .setCommandBuffers({cmd});
+graphicsQueue.submit({info});
+/* [StagingUploader-usage] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Image color{DOXYGEN_IGNORE(NoCreate)}, depth{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer cmd{DOXYGEN_IGNORE(NoCreate)};
+/* [ImageStateTracker-usage] */
+Vk::ImageStateTracker tracker{device};
+UnsignedInt colorId = tracker.addImage(color, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+UnsignedInt depthId = tracker.addImage(depth, VK_IMAGE_ASPECT_DEPTH_BIT, 1);
+
+/* A compute pass writes both images … */
+tracker
+    .use(colorId, Vk::ImageLayout::General,
+        Vk::PipelineStage::ComputeShader, Vk::Access::ShaderWrite)
+    .use(depthId, Vk::ImageLayout::General,
+        Vk::PipelineStage::ComputeShader, Vk::Access::ShaderWrite)
+    .flush(cmd);
+DOXYGEN_IGNORE()
+
+/* … and a following pass samples them. Both transitions are recorded with a
+   single vkCmdPipelineBarrier() waiting only for the compute shader stage. */
+tracker
+    .use(colorId, Vk::ImageLayout::ShaderReadOnly,
+        Vk::PipelineStage::FragmentShader, Vk::Access::ShaderRead)
+    .use(depthId, Vk::ImageLayout::ShaderReadOnly,
+        Vk::PipelineStage::FragmentShader, Vk::Access::ShaderRead)
+    .flush(cmd);
+/* [ImageStateTracker-usage] */
+}
+
+{
+Vk::Instance instance{DOXYGEN_IGNORE(NoCreate)};
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::Queue queue{DOXYGEN_IGNORE(NoCreate)};
+UnsignedInt queueFamily{};
+VkSurfaceKHR surface{};
+Vector2i windowSize;
+bool running = false;
+/* [FrameLoop-usage] */
+Vk::Swapchain swapchain{instance, device, surface, windowSize,
+    Vk::PresentMode::Mailbox};
+Vk::FrameLoop loop{device, queue, queueFamily, swapchain};
+
+while(running) {
+    /* Waits until the frame slot is free, acquires a swapchain image */
+    Int image = loop.beginFrame();
+    if(image == -1) {
+        loop.recreateSwapchain(windowSize);
+        continue;
+    }
+
+    Vk::CommandBuffer cmd = loop.commandPools().allocate(0);
+    cmd.begin();
+    DOXYGEN_IGNORE()
+    cmd.end();
+
+    /* Submits and presents, the frame slot gets reused frameCount() frames
+       later */
+    if(!loop.endFrame({cmd}))
+        loop.recreateSwapchain(windowSize);
+}
+/* [FrameLoop-usage] */
+}
+
+{
+Vk::Device device{DOXYGEN_IGNORE(NoCreate)};
+Vk::ImageView view{DOXYGEN_IGNORE(NoCreate)};
+Vk::Buffer materials{DOXYGEN_IGNORE(NoCreate)};
+Vk::CommandBuffer cmd{DOXYGEN_IGNORE(NoCreate)};
+VkSampler sampler{};
+/* [BindlessTable-usage] */
+Vk::BindlessTable table{device, {
+    {Vk::DescriptorType::CombinedImageSampler, 4096},
+    {Vk::DescriptorType::StorageBuffer, 1024}
+}, Vk::ShaderStage::Vertex|Vk::ShaderStage::Fragment};
+Vk::PipelineLayout pipelineLayout{device, Vk::PipelineLayoutCreateInfo{
+    table.layout()
+}};
+
+/* Add resources as they get loaded, pass the returned slots to the shaders
+   through per-draw data */
+UnsignedInt textureSlot = table.addImage(0, view,
+    Vk::ImageLayout::ShaderReadOnly, sampler);
+UnsignedInt materialSlot = table.addBuffer(1, materials);
+DOXYGEN_IGNORE(static_cast<void>(textureSlot), static_cast<void>(materialSlot);)
+
+/* Bind the table once for all draws */
+cmd.bindDescriptorSets(Vk::PipelineBindPoint::Graphics, pipelineLayout, 0,
+    {table.set()});
+/* [BindlessTable-usage] */
+}
+
 {
 /* [Integration] */
 VkOffset2D a{64, 32};
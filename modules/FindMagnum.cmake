@@ -87,8 +87,13 @@
 #  WglContext                   - WGL context
 #  OpenGLTester                 - OpenGLTester class
 #  VulkanTester                 - VulkanTester class
+#  BlockCompressionImageConverter - BC and ETC2 block compression image
+#   converter plugin
 #  MagnumFont                   - Magnum bitmap font plugin
 #  MagnumFontConverter          - Magnum bitmap font converter plugin
+#  MagnumImageConverter         - Magnum binary blob image converter plugin
+#  MagnumImporter               - Magnum binary blob importer plugin
+#  MagnumSceneConverter         - Magnum binary blob scene converter plugin
 #  ObjImporter                  - OBJ importer plugin
 #  TgaImageConverter            - TGA image converter plugin
 #  TgaImporter                  - TGA importer plugin
@@ -347,9 +352,10 @@ if(NOT TARGET Magnum::Magnum)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_INCLUDE_DIRECTORIES
         ${MAGNUM_INCLUDE_DIR})
 
-    # Dependent libraries
+    # Dependent libraries. AbstractAsyncResourceLoader uses std::thread.
+    find_package(Threads REQUIRED)
     set_property(TARGET Magnum::Magnum APPEND PROPERTY INTERFACE_LINK_LIBRARIES
-         Corrade::Utility)
+         Corrade::Utility Threads::Threads)
 else()
     set(MAGNUM_LIBRARY Magnum::Magnum)
 endif()
@@ -362,7 +368,9 @@ set(_MAGNUM_LIBRARY_COMPONENTS
     WindowlessEglApplication EglContext OpenGLTester)
 set(_MAGNUM_PLUGIN_COMPONENTS
     AnyAudioImporter AnyImageConverter AnyImageImporter AnySceneConverter
-    AnySceneImporter MagnumFont MagnumFontConverter ObjImporter
+    AnySceneImporter BlockCompressionImageConverter MagnumFont
+    MagnumFontConverter MagnumImageConverter MagnumImporter
+    MagnumSceneConverter ObjImporter
     TgaImageConverter TgaImporter WavAudioImporter)
 set(_MAGNUM_EXECUTABLE_COMPONENTS
     imageconverter sceneconverter shaderconverter gl-info al-info)
@@ -422,11 +430,17 @@ if(MAGNUM_TARGET_GL)
     set(_MAGNUM_DebugTools_Shaders_DEPENDENCY_IS_OPTIONAL ON)
     set(_MAGNUM_DebugTools_GL_DEPENDENCY_IS_OPTIONAL ON)
 endif()
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_DebugTools_DEPENDENCIES Vk)
+endif()
 
 set(_MAGNUM_MeshTools_DEPENDENCIES Trade)
 if(MAGNUM_TARGET_GL)
     list(APPEND _MAGNUM_MeshTools_DEPENDENCIES GL)
 endif()
+if(MAGNUM_TARGET_VK)
+    list(APPEND _MAGNUM_MeshTools_DEPENDENCIES Vk)
+endif()
 
 set(_MAGNUM_OpenGLTester_DEPENDENCIES GL)
 if(MAGNUM_TARGET_HEADLESS OR CORRADE_TARGET_EMSCRIPTEN OR CORRADE_TARGET_ANDROID)
@@ -463,7 +477,8 @@ endif()
 
 set(_MAGNUM_TextureTools_DEPENDENCIES )
 if(MAGNUM_TARGET_GL)
-    list(APPEND _MAGNUM_TextureTools_DEPENDENCIES GL)
+    # Trade is needed only by uploadTexture2D()
+    list(APPEND _MAGNUM_TextureTools_DEPENDENCIES GL Trade)
 endif()
 
 set(_MAGNUM_Trade_DEPENDENCIES )
@@ -498,6 +513,7 @@ set(_MAGNUM_EglContext_DEPENDENCIES GL)
 set(_MAGNUM_GlxContext_DEPENDENCIES GL)
 set(_MAGNUM_WglContext_DEPENDENCIES GL)
 
+set(_MAGNUM_BlockCompressionImageConverter_DEPENDENCIES MagnumImageConverter) # and below
 set(_MAGNUM_MagnumFont_DEPENDENCIES Trade TgaImporter GL) # and below
 set(_MAGNUM_MagnumFontConverter_DEPENDENCIES Trade TgaImageConverter) # and below
 set(_MAGNUM_ObjImporter_DEPENDENCIES MeshTools) # and below
@@ -737,6 +753,13 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
                         INTERFACE_LINK_LIBRARIES ${CMAKE_DL_LIBS})
                 endif()
 
+                # The optional render thread uses std::thread
+                if(MAGNUM_TARGET_GL AND NOT CORRADE_TARGET_EMSCRIPTEN)
+                    find_package(Threads REQUIRED)
+                    set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                        INTERFACE_LINK_LIBRARIES Threads::Threads)
+                endif()
+
                 # With GLVND (since CMake 3.11) we need to explicitly link to
                 # GLX/EGL because libOpenGL doesn't provide it. For EGL we have
                 # our own EGL find module, which makes things simpler. The
@@ -852,10 +875,18 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # Audio library
         elseif(_component STREQUAL Audio)
             find_package(OpenAL)
+            # StreamPlayer uses std::thread
+            find_package(Threads REQUIRED)
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
-                INTERFACE_LINK_LIBRARIES Corrade::PluginManager OpenAL::OpenAL)
+                INTERFACE_LINK_LIBRARIES Corrade::PluginManager OpenAL::OpenAL Threads::Threads)
 
-        # No special setup for DebugTools library
+        # DebugTools library
+        elseif(_component STREQUAL DebugTools)
+            # ZoneProfiler uses std::thread and std::mutex, CompareImage
+            # std::thread
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
 
         # GL library
         elseif(_component STREQUAL GL)
@@ -889,6 +920,11 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL MeshTools)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES CompressIndices.h)
 
+            # Multi-threaded removeDuplicates*() variants use std::thread
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+
         # OpenGLTester library
         elseif(_component STREQUAL OpenGLTester)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_SUFFIX Magnum/GL)
@@ -901,7 +937,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         elseif(_component STREQUAL Primitives)
             set(_MAGNUM_${_COMPONENT}_INCLUDE_PATH_NAMES Cube.h)
 
-        # No special setup for SceneGraph library
+        # SceneGraph library
+        elseif(_component STREQUAL SceneGraph)
+            # Multi-threaded Object::transformations() use std::thread
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
 
         # ShaderTools library
         elseif(_component STREQUAL ShaderTools)
@@ -924,6 +965,11 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
             set_property(TARGET Magnum::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Corrade::PluginManager)
 
+            # AsyncImporter exposes std::future and uses std::thread
+            find_package(Threads REQUIRED)
+            set_property(TARGET Magnum::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES Threads::Threads)
+
         # Vk library
         elseif(_component STREQUAL Vk)
             find_package(Vulkan REQUIRED)
@@ -935,8 +981,12 @@ foreach(_component ${Magnum_FIND_COMPONENTS})
         # No special setup for AnyImageConverter plugin
         # No special setup for AnyImageImporter plugin
         # No special setup for AnySceneImporter plugin
+        # No special setup for BlockCompressionImageConverter plugin
         # No special setup for MagnumFont plugin
         # No special setup for MagnumFontConverter plugin
+        # No special setup for MagnumImageConverter plugin
+        # No special setup for MagnumImporter plugin
+        # No special setup for MagnumSceneConverter plugin
         # No special setup for ObjImporter plugin
         # No special setup for TgaImageConverter plugin
         # No special setup for TgaImporter plugin
@@ -38,8 +38,12 @@ cmake .. ^
     -DWITH_ANYSCENECONVERTER=ON ^
     -DWITH_ANYSCENEIMPORTER=ON ^
     -DWITH_ANYSHADERCONVERTER=ON ^
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON ^
     -DWITH_MAGNUMFONT=ON ^
     -DWITH_MAGNUMFONTCONVERTER=ON ^
+    -DWITH_MAGNUMIMAGECONVERTER=ON ^
+    -DWITH_MAGNUMIMPORTER=ON ^
+    -DWITH_MAGNUMSCENECONVERTER=ON ^
     -DWITH_OBJIMPORTER=ON ^
     -DWITH_TGAIMAGECONVERTER=ON ^
     -DWITH_TGAIMPORTER=ON ^
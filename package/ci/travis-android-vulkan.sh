@@ -87,6 +87,9 @@ cmake .. \
     -DWITH_ANYSCENEIMPORTER=OFF \
     -DWITH_MAGNUMFONT=OFF \
     -DWITH_MAGNUMFONTCONVERTER=OFF \
+    -DWITH_MAGNUMIMAGECONVERTER=OFF \
+    -DWITH_MAGNUMIMPORTER=OFF \
+    -DWITH_MAGNUMSCENECONVERTER=OFF \
     -DWITH_OBJIMPORTER=OFF \
     -DWITH_TGAIMAGECONVERTER=OFF \
     -DWITH_TGAIMPORTER=OFF \
@@ -39,8 +39,12 @@ cmake .. \
     -DWITH_ANYSCENECONVERTER=OFF \
     -DWITH_ANYSCENEIMPORTER=OFF \
     -DWITH_ANYSHADERCONVERTER=OFF \
+    -DWITH_BLOCKCOMPRESSIONIMAGECONVERTER=ON \
     -DWITH_MAGNUMFONT=ON \
     -DWITH_MAGNUMFONTCONVERTER=ON \
+    -DWITH_MAGNUMIMAGECONVERTER=ON \
+    -DWITH_MAGNUMIMPORTER=ON \
+    -DWITH_MAGNUMSCENECONVERTER=ON \
     -DWITH_OBJIMPORTER=OFF \
     -DWITH_TGAIMAGECONVERTER=ON \
     -DWITH_TGAIMPORTER=ON \
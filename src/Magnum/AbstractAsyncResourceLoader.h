@@ -0,0 +1,389 @@
+#ifndef Magnum_AbstractAsyncResourceLoader_h
+#define Magnum_AbstractAsyncResourceLoader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::AbstractAsyncResourceLoader
+ * @m_since_latest
+ */
+
+#include <chrono>
+#include <deque>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/AbstractResourceLoader.h"
+#include "Magnum/Math/Functions.h"
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace Magnum {
+
+/**
+@brief Base for asynchronous resource loaders
+@m_since_latest
+
+A @ref AbstractResourceLoader that decodes resources on background threads and
+commits them to the @ref ResourceManager on the main thread. Compared to a
+plain @ref AbstractResourceLoader, where @ref AbstractResourceLoader::doLoad()
+is executed synchronously from @ref ResourceManager::get(), the request only
+gets queued and the resource stays in @ref ResourceState::Loading (or
+@ref ResourceState::LoadingFallback) until it's decoded and committed.
+
+@section AbstractAsyncResourceLoader-usage Usage and subclassing
+
+Subclassing is done by implementing @ref doDecode(), which is executed on one
+of the worker threads and returns either the decoded resource or
+@cpp nullptr @ce if the resource was not found. The function shouldn't access
+the @ref ResourceManager or any other state shared with the main thread. The
+resources are committed to the manager only when calling @ref commit(),
+usually once per frame, with a time and byte budget to avoid stalls when a lot
+of resources finish decoding at once. The byte size of each resource is
+queried by @ref doByteSize(), which can be overriden to report sizes of
+dynamically allocated data:
+
+@snippet Magnum.cpp AbstractAsyncResourceLoader-implementation
+
+The loader is then added to the manager the same way as any other loader,
+with @ref commit() called from the application main loop:
+
+@snippet Magnum.cpp AbstractAsyncResourceLoader-use
+
+Committed resources are set with @ref ResourceDataState::Final and a policy
+set via @ref setPolicy(), which is @ref ResourcePolicy::Resident by default.
+Their size reported by @ref doByteSize() is passed to
+@ref ResourceManager::setByteSize(), so with a non-resident policy they can
+be evicted after exceeding @ref ResourceManager::setByteBudget() and then
+loaded again on next request. Counts reported by @ref requestedCount(),
+@ref loadedCount() and @ref notFoundCount() are updated the same way as with
+synchronous loaders, i.e. a resource is counted as loaded or not found only
+once it's committed.
+
+@section AbstractAsyncResourceLoader-lifetime Loader lifetime
+
+As the workers call into @ref doDecode(), they have to be stopped before the
+subclass gets destroyed. Call @ref finish() in the subclass destructor, which
+waits until all queued requests are decoded and then joins the worker threads.
+Requests made after @ref finish() are decoded directly on the calling thread.
+
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without threading
+support, the decoding is always done directly in @ref ResourceManager::get(),
+but the results are still committed only through @ref commit().
+*/
+template<class T> class AbstractAsyncResourceLoader: public AbstractResourceLoader<T> {
+    public:
+        /**
+         * @brief Constructor
+         * @param threadCount   Count of worker threads. If set to @cpp 0 @ce,
+         *      @ref std::thread::hardware_concurrency() is used.
+         */
+        explicit AbstractAsyncResourceLoader(UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref finish(), however at that point the subclass is already
+         * destroyed. See @ref AbstractAsyncResourceLoader-lifetime for more
+         * information.
+         */
+        ~AbstractAsyncResourceLoader();
+
+        /**
+         * @brief Count of worker threads
+         *
+         * @cpp 0 @ce after @ref finish() was called and on Emscripten builds
+         * without threading support.
+         */
+        UnsignedInt threadCount() const { return _threads.size(); }
+
+        /**
+         * @brief Policy for committed resources
+         */
+        ResourcePolicy policy() const { return _policy; }
+
+        /**
+         * @brief Set policy for committed resources
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @ref ResourcePolicy::Resident. Affects only resources
+         * committed after calling this function.
+         */
+        AbstractAsyncResourceLoader<T>& setPolicy(ResourcePolicy policy) {
+            _policy = policy;
+            return *this;
+        }
+
+        /**
+         * @brief Count of requests waiting for or being decoded
+         *
+         * @see @ref readyCount()
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Count of decoded resources waiting for a commit
+         *
+         * @see @ref pendingCount(), @ref commit()
+         */
+        std::size_t readyCount() const;
+
+        /**
+         * @brief Commit decoded resources to the manager
+         * @param timeBudget    Time budget for the commit
+         * @param byteBudget    Byte budget for the commit
+         * @return Count of committed resources
+         *
+         * Passes decoded resources to the @ref ResourceManager in the order
+         * they finished decoding, until either the time spent in this function
+         * exceeds @p timeBudget or committing the next resource would exceed
+         * @p byteBudget, with sizes as reported by @ref doByteSize(). At least
+         * one resource is committed if any is ready, even if it alone exceeds
+         * the budget. Not found resources are committed with zero size. Has to
+         * be called from the thread that owns the manager.
+         */
+        std::size_t commit(std::chrono::nanoseconds timeBudget, std::size_t byteBudget = ~std::size_t{});
+
+        /**
+         * @brief Commit all decoded resources to the manager
+         * @return Count of committed resources
+         *
+         * Equivalent to calling @ref commit(std::chrono::nanoseconds, std::size_t)
+         * with an unlimited budget.
+         */
+        std::size_t commit() {
+            return commit(std::chrono::nanoseconds::max());
+        }
+
+        /**
+         * @brief Wait until all requests are decoded
+         *
+         * After this function returns, @ref pendingCount() is @cpp 0 @ce and
+         * everything is ready to be committed.
+         */
+        void wait();
+
+        /**
+         * @brief Finish decoding and stop the worker threads
+         *
+         * Waits until all requests are decoded and joins the worker threads.
+         * Subsequent requests are decoded directly on the calling thread.
+         * Calling this function again does nothing.
+         * @see @ref AbstractAsyncResourceLoader-lifetime
+         */
+        void finish();
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    private:
+    #else
+    protected:
+    #endif
+        /**
+         * @brief Decode a resource
+         *
+         * Called from a worker thread for each requested resource. Return
+         * @cpp nullptr @ce if the resource was not found.
+         */
+        virtual Containers::Pointer<T> doDecode(ResourceKey key) = 0;
+
+        /**
+         * @brief Byte size of a decoded resource
+         *
+         * Used by @ref commit() to track the byte budget. Called from a worker
+         * thread right after @ref doDecode(). Default implementation returns
+         * @cpp sizeof(T) @ce.
+         */
+        virtual std::size_t doByteSize(const T& data) const;
+
+    private:
+        struct Decoded {
+            ResourceKey key;
+            Containers::Pointer<T> data;
+            std::size_t byteSize;
+        };
+
+        void doLoad(ResourceKey key) override;
+
+        Decoded decode(ResourceKey key);
+
+        #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+        void work();
+
+        mutable std::mutex _mutex;
+        std::condition_variable _requestAvailable, _requestsFinished;
+        Containers::Array<std::thread> _threads;
+        bool _quit{};
+        #else
+        Containers::Array<int> _threads;
+        #endif
+        std::deque<ResourceKey> _requests;
+        std::deque<Decoded> _decoded;
+        /* Includes requests currently being decoded */
+        std::size_t _pendingCount{};
+        ResourcePolicy _policy{ResourcePolicy::Resident};
+};
+
+template<class T> AbstractAsyncResourceLoader<T>::AbstractAsyncResourceLoader(UnsignedInt threadCount) {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    if(!threadCount)
+        threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    _threads = Containers::Array<std::thread>{Containers::ValueInit, threadCount};
+    for(std::thread& thread: _threads)
+        thread = std::thread{&AbstractAsyncResourceLoader<T>::work, this};
+    #else
+    static_cast<void>(threadCount);
+    #endif
+}
+
+template<class T> AbstractAsyncResourceLoader<T>::~AbstractAsyncResourceLoader() {
+    finish();
+}
+
+template<class T> std::size_t AbstractAsyncResourceLoader<T>::pendingCount() const {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    std::lock_guard<std::mutex> lock{_mutex};
+    #endif
+    return _pendingCount;
+}
+
+template<class T> std::size_t AbstractAsyncResourceLoader<T>::readyCount() const {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    std::lock_guard<std::mutex> lock{_mutex};
+    #endif
+    return _decoded.size();
+}
+
+template<class T> std::size_t AbstractAsyncResourceLoader<T>::commit(const std::chrono::nanoseconds timeBudget, const std::size_t byteBudget) {
+    const std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    std::size_t count = 0;
+    std::size_t byteCount = 0;
+    for(;;) {
+        Decoded decoded;
+        {
+            #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+            std::lock_guard<std::mutex> lock{_mutex};
+            #endif
+            if(_decoded.empty()) break;
+
+            /* Always commit at least one resource so a resource larger than
+               the budget doesn't block the queue forever */
+            if(count && (byteCount >= byteBudget || byteBudget - byteCount < _decoded.front().byteSize || std::chrono::steady_clock::now() - begin >= timeBudget))
+                break;
+
+            decoded = std::move(_decoded.front());
+            _decoded.pop_front();
+        }
+
+        byteCount += decoded.byteSize;
+        ++count;
+
+        if(decoded.data) {
+            this->set(decoded.key, std::move(decoded.data), ResourceDataState::Final, _policy);
+            this->setByteSize(decoded.key, decoded.byteSize);
+        } else this->setNotFound(decoded.key);
+    }
+
+    return count;
+}
+
+template<class T> void AbstractAsyncResourceLoader<T>::wait() {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    std::unique_lock<std::mutex> lock{_mutex};
+    _requestsFinished.wait(lock, [this]{ return !_pendingCount; });
+    #endif
+}
+
+template<class T> void AbstractAsyncResourceLoader<T>::finish() {
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    if(_threads.isEmpty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _quit = true;
+    }
+    _requestAvailable.notify_all();
+    for(std::thread& thread: _threads) thread.join();
+    _threads = nullptr;
+    #endif
+}
+
+template<class T> std::size_t AbstractAsyncResourceLoader<T>::doByteSize(const T&) const { return sizeof(T); }
+
+template<class T> void AbstractAsyncResourceLoader<T>::doLoad(const ResourceKey key) {
+    /* No threads available, decode directly */
+    if(_threads.isEmpty()) {
+        Decoded decoded = decode(key);
+        #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+        std::lock_guard<std::mutex> lock{_mutex};
+        #endif
+        _decoded.push_back(std::move(decoded));
+        return;
+    }
+
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _requests.push_back(key);
+        ++_pendingCount;
+    }
+    _requestAvailable.notify_one();
+    #endif
+}
+
+template<class T> typename AbstractAsyncResourceLoader<T>::Decoded AbstractAsyncResourceLoader<T>::decode(const ResourceKey key) {
+    Decoded decoded{key, doDecode(key), 0};
+    if(decoded.data) decoded.byteSize = doByteSize(*decoded.data);
+    return decoded;
+}
+
+#if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+template<class T> void AbstractAsyncResourceLoader<T>::work() {
+    for(;;) {
+        ResourceKey key;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _requestAvailable.wait(lock, [this]{ return _quit || !_requests.empty(); });
+            /* Quitting only once all requests are decoded */
+            if(_requests.empty()) return;
+            key = _requests.front();
+            _requests.pop_front();
+        }
+
+        Decoded decoded = decode(key);
+
+        std::lock_guard<std::mutex> lock{_mutex};
+        _decoded.push_back(std::move(decoded));
+        if(!--_pendingCount) _requestsFinished.notify_all();
+    }
+}
+#endif
+
+}
+
+#endif
@@ -75,6 +75,8 @@ the following code, however, the loader destroys itself (and removes itself
 from the manager) before the manager is destroyed.
 
 @snippet Magnum.cpp AbstractResourceLoader-use
+
+@see @ref AbstractAsyncResourceLoader
 */
 template<class T> class AbstractResourceLoader {
     public:
@@ -187,6 +189,18 @@ template<class T> class AbstractResourceLoader {
             set(key, nullptr, ResourceDataState::NotFound, ResourcePolicy::Resident);
         }
 
+        /**
+         * @brief Set byte size of a loaded resource
+         * @m_since_latest
+         *
+         * Should be called after @ref set(), as setting the data resets the
+         * size back to @cpp 0 @ce. See @ref ResourceManager::setByteSize()
+         * for more information.
+         */
+        void setByteSize(ResourceKey key, std::size_t size) {
+            manager->setByteSize(key, size);
+        }
+
     #ifndef DOXYGEN_GENERATING_OUTPUT
     private:
     #else
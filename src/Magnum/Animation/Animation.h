@@ -46,6 +46,8 @@ enum class Extrapolation: UnsignedByte;
 
 template<class T, class K = T> class Player;
 
+template<class R> class CompressedTrack;
+
 template<class K, class V, class R = ResultOf<V>> class Track;
 template<class K> class TrackViewStorage;
 template<class K, class V, class R = ResultOf<V>> class TrackView;
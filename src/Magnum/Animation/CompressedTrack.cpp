@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompressedTrack.h"
+
+#include <cmath>
+#include <Corrade/Containers/GrowableArray.h>
+
+namespace Magnum { namespace Animation {
+
+namespace {
+
+constexpr Float Sqrt1_2 = 0.70710678118654752440f;
+
+/* Component indices for placing the three stored components and the
+   reconstructed one, indexed by the largest component index */
+constexpr UnsignedByte QuaternionComponents[4][4]{
+    {3, 0, 1, 2},
+    {0, 3, 1, 2},
+    {0, 1, 3, 2},
+    {0, 1, 2, 3}
+};
+
+}
+
+PackedQuaternion packQuaternion(const Math::Quaternion<Float>& quaternion) {
+    CORRADE_ASSERT(quaternion.isNormalized(),
+        "Animation::packQuaternion(): quaternion" << quaternion << "is not normalized", {});
+
+    const Float components[4]{
+        quaternion.vector().x(),
+        quaternion.vector().y(),
+        quaternion.vector().z(),
+        quaternion.scalar()
+    };
+
+    UnsignedInt largest = 0;
+    for(UnsignedInt i = 1; i != 4; ++i)
+        if(std::abs(components[i]) > std::abs(components[largest]))
+            largest = i;
+
+    /* Flip the sign so the largest component is positive and doesn't need
+       to be stored */
+    const Float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+    UnsignedLong data = UnsignedLong(largest) << 45;
+    for(UnsignedInt i = 0, shift = 30; i != 4; ++i) {
+        if(i == largest) continue;
+        const Float normalized = Math::clamp(sign*components[i]*Sqrt1_2 + 0.5f, 0.0f, 1.0f);
+        data |= UnsignedLong(normalized*32766.0f + 0.5f) << shift;
+        shift -= 15;
+    }
+
+    return PackedQuaternion{{
+        UnsignedShort(data),
+        UnsignedShort(data >> 16),
+        UnsignedShort(data >> 32)
+    }};
+}
+
+Math::Quaternion<Float> unpackQuaternion(const PackedQuaternion& packed) {
+    const UnsignedLong data = UnsignedLong(packed.data[0])|
+                              UnsignedLong(packed.data[1]) << 16|
+                              UnsignedLong(packed.data[2]) << 32;
+
+    /* Using 32766 instead of 32767 so zero is exactly representable */
+    constexpr Float Scale = 2.0f*Sqrt1_2/32766.0f;
+    Float components[4];
+    components[0] = Float((data >> 30) & 0x7fff)*Scale - Sqrt1_2;
+    components[1] = Float((data >> 15) & 0x7fff)*Scale - Sqrt1_2;
+    components[2] = Float(data & 0x7fff)*Scale - Sqrt1_2;
+    components[3] = std::sqrt(Math::max(1.0f - components[0]*components[0] - components[1]*components[1] - components[2]*components[2], 0.0f));
+
+    const UnsignedByte* const order = QuaternionComponents[(data >> 45) & 0x3];
+    return Math::Quaternion<Float>{
+        {components[order[0]], components[order[1]], components[order[2]]},
+        components[order[3]]};
+}
+
+namespace {
+
+/* Per-type quantization and error calculation, the dequantize() and
+   interpolate() is what's used by CompressedTrack::at() */
+template<class> struct Compression;
+
+template<> struct Compression<Math::Vector3<Float>> {
+    typedef Math::Vector3<Float> Type;
+    typedef Math::Vector3<UnsignedShort> PackedType;
+    typedef Implementation::CompressedTrackTraits<Type>::Dequantization Dequantization;
+
+    static Dequantization dequantization(const Containers::StridedArrayView1D<const Type>& values) {
+        Type min{Constants::inf()}, max{-Constants::inf()};
+        for(const Type& value: values) {
+            min = Math::min(min, value);
+            max = Math::max(max, value);
+        }
+        return {min, (max - min)/65535.0f};
+    }
+
+    static PackedType quantize(const Dequantization& dequantization, const Type& value) {
+        PackedType out;
+        for(std::size_t i = 0; i != 3; ++i) out[i] = dequantization.scale[i] == 0.0f ? 0 :
+            UnsignedShort(Math::clamp((value[i] - dequantization.offset[i])/dequantization.scale[i], 0.0f, 65535.0f) + 0.5f);
+        return out;
+    }
+
+    static Type dequantize(const Dequantization& dequantization, const PackedType& value) {
+        return dequantization.offset + Type{value}*dequantization.scale;
+    }
+
+    static Type interpolate(const Type& a, const Type& b, Float t) {
+        return Math::lerp(a, b, t);
+    }
+
+    static Float error(const Type& a, const Type& b) {
+        return (a - b).length();
+    }
+};
+
+template<> struct Compression<Math::Quaternion<Float>> {
+    typedef Math::Quaternion<Float> Type;
+    typedef PackedQuaternion PackedType;
+    typedef Implementation::CompressedTrackTraits<Type>::Dequantization Dequantization;
+
+    static Dequantization dequantization(const Containers::StridedArrayView1D<const Type>&) {
+        return {};
+    }
+
+    static PackedType quantize(const Dequantization&, const Type& value) {
+        return packQuaternion(value.normalized());
+    }
+
+    static Type dequantize(const Dequantization&, const PackedType& value) {
+        return unpackQuaternion(value);
+    }
+
+    static Type interpolate(const Type& a, const Type& b, Float t) {
+        return Math::lerpShortestPath(a, b, t);
+    }
+
+    /* Rotation angle between the two, q and -q being the same rotation.
+       Calculated from the chord length, which is 2 sin(angle/4), as acos()
+       of the dot product is too imprecise for small angles. */
+    static Float error(Type a, Type b) {
+        a = a.normalized();
+        b = b.normalized();
+        const Float chord = Math::dot(a, b) < 0.0f ? (a + b).dot() : (a - b).dot();
+        return 4.0f*std::asin(Math::min(std::sqrt(chord)*0.5f, 1.0f));
+    }
+};
+
+/* Max count of original keyframes a single reduced segment can span, to
+   keep the reduction linear for long constant tracks */
+constexpr std::size_t MaxSegmentLength = 256;
+
+}
+
+template<class R> CompressedTrack<R>::CompressedTrack() noexcept: _dequantization{}, _bounds{}, _before{}, _after{} {}
+
+template<class R> CompressedTrack<R>::CompressedTrack(const TrackView<const Float, const R, R>& track, const Float maxError): _dequantization{}, _bounds{}, _before{track.before()}, _after{track.after()} {
+    CORRADE_ASSERT(maxError >= 0.0f,
+        "Animation::CompressedTrack: expected non-negative max error but got" << maxError, );
+
+    typedef Compression<R> C;
+    const Containers::StridedArrayView1D<const Float> keys = track.keys();
+    const Containers::StridedArrayView1D<const R> values = track.values();
+    if(keys.empty()) return;
+
+    _bounds[0] = keys.front();
+    _bounds[1] = keys.back();
+    _dequantization = C::dequantization(values);
+
+    /* Quantize everything upfront. The last key is always 65535 unless the
+       track has zero duration. */
+    const Float keyScale = _bounds[1] == _bounds[0] ? 0.0f : 65535.0f/(_bounds[1] - _bounds[0]);
+    Containers::Array<UnsignedShort> quantizedKeys{Containers::NoInit, keys.size()};
+    Containers::Array<typename C::PackedType> quantizedValues{Containers::NoInit, keys.size()};
+    Containers::Array<R> decodedValues{Containers::NoInit, keys.size()};
+    for(std::size_t i = 0; i != keys.size(); ++i) {
+        quantizedKeys[i] = UnsignedShort(Math::clamp((keys[i] - _bounds[0])*keyScale, 0.0f, 65535.0f) + 0.5f);
+        quantizedValues[i] = C::quantize(_dequantization, values[i]);
+        decodedValues[i] = C::dequantize(_dequantization, quantizedValues[i]);
+    }
+
+    /* Greedy keyframe reduction --- from each kept keyframe extend the
+       segment as far as all original keyframes inside it are reconstructed
+       within the error bound. A keyframe can end a segment only if its
+       quantized key is larger than the start, and the largest quantized key
+       is reserved for the very last keyframe. */
+    const std::size_t last = keys.size() - 1;
+    arrayAppend(_keys, quantizedKeys[0]);
+    arrayAppend(_values, quantizedValues[0]);
+    std::size_t start = 0;
+    while(start != last) {
+        const UnsignedShort startKey = quantizedKeys[start];
+        std::size_t end = 0;
+        for(std::size_t i = start + 1; i <= last && i - start <= MaxSegmentLength; ++i) {
+            if(quantizedKeys[i] == startKey || (i != last && quantizedKeys[i] == quantizedKeys[last]))
+                continue;
+
+            bool withinError = true;
+            const Float segmentLength = Float(quantizedKeys[i] - startKey);
+            for(std::size_t j = start + 1; j != i; ++j) {
+                const R reconstructed = C::interpolate(decodedValues[start], decodedValues[i], Float(quantizedKeys[j] - startKey)/segmentLength);
+                if(C::error(reconstructed, values[j]) > maxError) {
+                    withinError = false;
+                    break;
+                }
+            }
+
+            if(!withinError) {
+                /* Not even the nearest usable keyframe is within the error
+                   bound, which can happen only due to quantization. Use it
+                   anyway. */
+                if(!end) end = i;
+                break;
+            }
+
+            end = i;
+        }
+
+        /* Everything after the start has the same quantized key (i.e., a
+           zero-duration track), end with the last keyframe */
+        if(!end) end = last;
+
+        arrayAppend(_keys, quantizedKeys[end]);
+        arrayAppend(_values, quantizedValues[end]);
+        start = end;
+    }
+
+    /* Drop the growable allocator */
+    arrayShrink(_keys);
+    arrayShrink(_values);
+}
+
+template<class R> CompressedTrack<R>::CompressedTrack(CompressedTrack<R>&&) noexcept = default;
+
+template<class R> CompressedTrack<R>::~CompressedTrack() = default;
+
+template<class R> CompressedTrack<R>& CompressedTrack<R>::operator=(CompressedTrack<R>&&) noexcept = default;
+
+template<class R> R CompressedTrack<R>::value(const std::size_t i) const {
+    CORRADE_ASSERT(i < _values.size(),
+        "Animation::CompressedTrack::value(): index" << i << "out of range for" << _values.size() << "keyframes", {});
+    return Compression<R>::dequantize(_dequantization, _values[i]);
+}
+
+template<class R> Float CompressedTrack<R>::key(const std::size_t i) const {
+    CORRADE_ASSERT(i < _keys.size(),
+        "Animation::CompressedTrack::key(): index" << i << "out of range for" << _keys.size() << "keyframes", {});
+    return Math::lerp(_bounds[0], _bounds[1], _keys[i]/65535.0f);
+}
+
+template<class R> R CompressedTrack<R>::at(const Float key, std::size_t& hint) const {
+    typedef Compression<R> C;
+
+    /* No data, return default-constructed value */
+    if(_keys.empty()) return {};
+
+    /* Only one frame or a zero duration, return the first or last value
+       verbatim (or default-constructed, if desired) */
+    const Float range = _bounds[1] - _bounds[0];
+    if(_keys.size() == 1 || range == 0.0f) {
+        if((key < _bounds[0] && _before == Extrapolation::DefaultConstructed) ||
+           (key > _bounds[1] && _after == Extrapolation::DefaultConstructed))
+            return {};
+
+        return C::dequantize(_dequantization, _values[key < _bounds[0] ? 0 : _values.size() - 1]);
+    }
+
+    /* Calculate the key in the quantized range. As the quantized keys are
+       integers, searching for the floor of it gives the same result as
+       searching for the fractional value. */
+    Float frame = (key - _bounds[0])*65535.0f/range;
+    hint = Implementation::findKeyframe(Containers::stridedArrayView(_keys), UnsignedShort(Math::clamp(frame, 0.0f, 65535.0f)), hint);
+
+    /* Special extrapolation outside of range. Usual extrapolation is handled
+       below. */
+    const Float a = _keys[hint];
+    const Float b = _keys[hint + 1];
+    if(frame < a) {
+        if(_before == Extrapolation::DefaultConstructed) return {};
+        if(_before == Extrapolation::Constant) frame = a;
+    } else if(frame >= b) {
+        if(_after == Extrapolation::DefaultConstructed) return {};
+        if(_after == Extrapolation::Constant) frame = b;
+    }
+
+    return C::interpolate(
+        C::dequantize(_dequantization, _values[hint]),
+        C::dequantize(_dequantization, _values[hint + 1]),
+        Math::lerpInverted(a, b, frame));
+}
+
+/* On non-MinGW Windows the instantiations are already marked with extern
+   template. However Clang-CL doesn't propagate the export from the extern
+   template, it seems. */
+#if !defined(CORRADE_TARGET_WINDOWS) || defined(CORRADE_TARGET_MINGW) || defined(CORRADE_TARGET_CLANG_CL)
+#define MAGNUM_EXPORT_HPP MAGNUM_EXPORT
+#else
+#define MAGNUM_EXPORT_HPP
+#endif
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_EXPORT_HPP CompressedTrack<Math::Vector3<Float>>;
+template class MAGNUM_EXPORT_HPP CompressedTrack<Math::Quaternion<Float>>;
+#endif
+
+}}
@@ -0,0 +1,301 @@
+#ifndef Magnum_Animation_CompressedTrack_h
+#define Magnum_Animation_CompressedTrack_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Animation::CompressedTrack, struct @ref Magnum::Animation::PackedQuaternion, function @ref Magnum::Animation::packQuaternion(), @ref Magnum::Animation::unpackQuaternion()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Animation/Track.h"
+#include "Magnum/Math/Quaternion.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Animation {
+
+/**
+@brief Quaternion packed into 48 bits
+@m_since_latest
+
+Stores a normalized quaternion using the *smallest three* encoding --- index
+of the component with the largest absolute value in two bits and the
+remaining three components, which are all in the
+@f$ [-\frac{1}{\sqrt{2}}, \frac{1}{\sqrt{2}}] @f$ range, in 15 bits each.
+The largest component is reconstructed from the unit length constraint. The
+maximal rotation error introduced by the encoding is below
+@f$ 10^{-4} @f$ radians. Use @ref packQuaternion() and
+@ref unpackQuaternion() to convert from and to a @ref Math::Quaternion.
+@see @ref CompressedTrack
+*/
+struct PackedQuaternion {
+    UnsignedShort data[3]; /**< Packed data */
+};
+
+/**
+@brief Pack a quaternion into 48 bits
+@m_since_latest
+
+Expects that the quaternion is normalized. As @f$ q @f$ and @f$ -q @f$
+represent the same rotation, the sign is chosen so the largest component is
+positive.
+@see @ref unpackQuaternion()
+*/
+MAGNUM_EXPORT PackedQuaternion packQuaternion(const Math::Quaternion<Float>& quaternion);
+
+/**
+@brief Unpack a quaternion from 48 bits
+@m_since_latest
+
+The operation is branch-free. The result is normalized up to precision of
+the packed representation.
+@see @ref packQuaternion()
+*/
+MAGNUM_EXPORT Math::Quaternion<Float> unpackQuaternion(const PackedQuaternion& packed);
+
+namespace Implementation {
+template<class> struct CompressedTrackTraits;
+
+template<> struct CompressedTrackTraits<Math::Vector3<Float>> {
+    typedef Math::Vector3<UnsignedShort> PackedType;
+    /* value = offset + packed*scale */
+    struct Dequantization {
+        Math::Vector3<Float> offset, scale;
+    };
+};
+
+template<> struct CompressedTrackTraits<Math::Quaternion<Float>> {
+    typedef PackedQuaternion PackedType;
+    struct Dequantization {};
+};
+
+}
+
+/**
+@brief Compressed animation track
+@tparam R   Result type
+@m_since_latest
+
+Lossy compressed counterpart to @ref Track, meant for large amounts of
+keyframe data such as motion capture clips. Available for
+@ref Math::Vector3 "Vector3" (translation and scaling) and
+@ref Math::Quaternion "Quaternion" (rotation) tracks with @relativeref{Magnum,Float}
+keys. The compression consists of:
+
+-   Keyframe reduction --- keyframes that can be reconstructed by
+    interpolating their neighbors with an error smaller than the requested
+    bound are dropped
+-   Time quantization --- keys are stored as 16-bit offsets relative to the
+    track duration
+-   Value quantization --- @ref Math::Vector3 "Vector3" values are stored as
+    16-bit offsets relative to the range of all values in the track,
+    @ref Math::Quaternion "Quaternion" values are stored as a 48-bit
+    @ref PackedQuaternion
+
+A keyframe then takes 8 bytes instead of 16 or 20 bytes, which together with
+the keyframe reduction typically makes densely sampled motion capture data
+five to ten times smaller.
+
+@section Animation-CompressedTrack-usage Basic usage
+
+The track is created from an existing @ref TrackView, for example one
+returned by @ref Trade::AnimationData::track(), and a maximal allowed error.
+For a @ref Math::Vector3 "Vector3" it's the distance between the original and
+reconstructed value, for a @ref Math::Quaternion "Quaternion" it's the angle
+between the original and reconstructed rotation, in radians. Dropped
+keyframes are checked against the decompressed values, so the bound includes
+the value quantization error as well. The extrapolation behavior is taken
+from the original track.
+
+@snippet MagnumAnimation.cpp CompressedTrack-usage
+
+Values are linearly interpolated on decompression, with quaternions using
+@ref Math::lerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T) "Math::lerpShortestPath()".
+The decoding is branch-free and done only for the two keyframes around the
+requested key, making it suitable for hot loops evaluating many tracks at
+once. Use @ref Player::add(const CompressedTrack<R>&, R&) to play the track
+through a @ref Player.
+
+@section Animation-CompressedTrack-limitations Limitations
+
+The keyframe reduction considers at most 256 consecutive keyframes at a time,
+so a constant track is reduced to one keyframe for each 256 original ones. As
+keys are quantized to 16 bits, tracks having their keyframes spaced by less
+than @f$ \frac{1}{65535} @f$ of their duration lose some of them.
+*/
+template<class R> class CompressedTrack {
+    public:
+        /**
+         * @brief Packed value type
+         *
+         * @ref Math::Vector3 "Math::Vector3<UnsignedShort>" for
+         * @ref Math::Vector3 "Vector3" tracks, @ref PackedQuaternion for
+         * @ref Math::Quaternion "Quaternion" tracks.
+         */
+        typedef typename Implementation::CompressedTrackTraits<R>::PackedType PackedType;
+
+        /** @brief Animation result type */
+        typedef R ResultType;
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates an empty track.
+         */
+        explicit CompressedTrack() noexcept;
+
+        /**
+         * @brief Compress a track
+         * @param track     Track to compress
+         * @param maxError  Maximal allowed error
+         *
+         * Expects that @p maxError is not negative. See the
+         * @ref Animation-CompressedTrack-usage "class documentation" for
+         * details.
+         */
+        explicit CompressedTrack(const TrackView<const Float, const R, R>& track, Float maxError);
+
+        /** @brief Copying is not allowed */
+        CompressedTrack(const CompressedTrack<R>&) = delete;
+
+        /** @brief Move constructor */
+        CompressedTrack(CompressedTrack<R>&&) noexcept;
+
+        ~CompressedTrack();
+
+        /** @brief Copying is not allowed */
+        CompressedTrack<R>& operator=(const CompressedTrack<R>&) = delete;
+
+        /** @brief Move assignment */
+        CompressedTrack<R>& operator=(CompressedTrack<R>&&) noexcept;
+
+        /** @brief Extrapolation behavior before first keyframe */
+        Extrapolation before() const { return _before; }
+
+        /** @brief Extrapolation behavior after last keyframe */
+        Extrapolation after() const { return _after; }
+
+        /**
+         * @brief Duration of the track
+         *
+         * Same as the duration of the original track. If there are no
+         * keyframes, a default-constructed value is returned.
+         */
+        Math::Range1D<Float> duration() const {
+            return Math::Range1D<Float>{_bounds[0], _bounds[1]};
+        }
+
+        /**
+         * @brief Keyframe count
+         *
+         * Count of keyframes after the keyframe reduction.
+         */
+        std::size_t size() const { return _keys.size(); }
+
+        /**
+         * @brief Quantized keys
+         *
+         * The actual key is calculated as @cpp duration().lerp(key/65535.0f) @ce.
+         */
+        Containers::ArrayView<const UnsignedShort> keys() const { return _keys; }
+
+        /** @brief Packed values */
+        Containers::ArrayView<const PackedType> values() const { return _values; }
+
+        /**
+         * @brief Size of the compressed data in bytes
+         *
+         * Size of the @ref keys() and @ref values() arrays, useful for
+         * comparing against the size of the original data.
+         */
+        std::size_t dataSize() const {
+            return _keys.size()*sizeof(UnsignedShort) + _values.size()*sizeof(PackedType);
+        }
+
+        /**
+         * @brief Decompress a value at given key
+         * @param key       Key at which to interpolate
+         * @param hint      Hint for keyframe search
+         *
+         * Equivalent to @ref TrackView::at(K, std::size_t&) const, the @p hint
+         * refers to the reduced keyframes.
+         */
+        R at(Float key, std::size_t& hint) const;
+
+        /**
+         * @brief Decompress a value at given key
+         *
+         * Equivalent to calling @ref at(Float, std::size_t&) const with a
+         * temporary hint.
+         */
+        R at(Float key) const {
+            std::size_t hint{};
+            return at(key, hint);
+        }
+
+        /**
+         * @brief Decompress a value at given keyframe
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        R value(std::size_t i) const;
+
+        /**
+         * @brief Key at given keyframe
+         *
+         * Expects that @p i is less than @ref size().
+         */
+        Float key(std::size_t i) const;
+
+        /**
+         * @brief Track spanning the track duration
+         *
+         * A two-keyframe @ref Math::lerp() "linear" track going from the first
+         * to the last key. Used by @ref Player::add(const CompressedTrack<R>&, R&)
+         * to describe the track duration, returned from @ref Player::track()
+         * for compressed tracks.
+         */
+        TrackView<const Float, const Float, Float> durationTrack() const {
+            return TrackView<const Float, const Float, Float>{_bounds, _bounds, Interpolation::Linear, _before, _after};
+        }
+
+    private:
+        Containers::Array<UnsignedShort> _keys;
+        Containers::Array<PackedType> _values;
+        typename Implementation::CompressedTrackTraits<R>::Dequantization _dequantization;
+        Float _bounds[2];
+        Extrapolation _before, _after;
+};
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_EXPORT CompressedTrack<Math::Vector3<Float>>;
+extern template class MAGNUM_EXPORT CompressedTrack<Math::Quaternion<Float>>;
+#endif
+
+}}
+
+#endif
@@ -27,6 +27,7 @@
 
 #include "Magnum/Math/CubicHermite.h"
 #include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
 
 namespace Magnum { namespace Animation {
 
@@ -124,6 +125,24 @@ template struct MAGNUM_EXPORT TypeTraits<Math::CubicHermite<Math::Vector3<Float>
 template struct MAGNUM_EXPORT TypeTraits<Math::CubicHermite<Math::Complex<Float>>, Math::Complex<Float>>;
 template struct MAGNUM_EXPORT TypeTraits<Math::CubicHermite<Math::Quaternion<Float>>, Math::Quaternion<Float>>;
 
+BatchInterpolator<Math::Quaternion<Float>, Math::Quaternion<Float>> batchInterpolatorFor(Math::Quaternion<Float>(*const interpolator)(const Math::Quaternion<Float>&, const Math::Quaternion<Float>&, Float)) {
+    typedef Math::Quaternion<Float>(*Interpolator)(const Math::Quaternion<Float>&, const Math::Quaternion<Float>&, Float);
+    if(interpolator == static_cast<Interpolator>(Math::slerp))
+        return Math::slerpInto;
+    if(interpolator == static_cast<Interpolator>(Math::slerpShortestPath))
+        return Math::slerpShortestPathInto;
+    return nullptr;
+}
+
+BatchInterpolator<Math::DualQuaternion<Float>, Math::DualQuaternion<Float>> batchInterpolatorFor(Math::DualQuaternion<Float>(*const interpolator)(const Math::DualQuaternion<Float>&, const Math::DualQuaternion<Float>&, Float)) {
+    typedef Math::DualQuaternion<Float>(*Interpolator)(const Math::DualQuaternion<Float>&, const Math::DualQuaternion<Float>&, Float);
+    if(interpolator == static_cast<Interpolator>(Math::sclerp))
+        return Math::sclerpInto;
+    if(interpolator == static_cast<Interpolator>(Math::sclerpShortestPath))
+        return Math::sclerpShortestPathInto;
+    return nullptr;
+}
+
 }
 
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
+ * @brief Alias @ref Magnum::Animation::ResultOf, enum @ref Magnum::Animation::Interpolation. @ref Magnum::Animation::Extrapolation, function @ref Magnum::Animation::interpolatorFor(), @ref Magnum::Animation::interpolate(), @ref Magnum::Animation::interpolateStrict(), @ref Magnum::Animation::interpolateInto(), @ref Magnum::Animation::ease(), @ref Magnum::Animation::easeClamped() @ref Magnum::Animation::unpack(), @ref Magnum::Animation::unpackEase(), @ref Magnum::Animation::unpackEaseClamped()
  */
 
 #include <Corrade/Containers/StridedArrayView.h>
@@ -175,8 +175,8 @@ MAGNUM_EXPORT Debug& operator<<(Debug& debug, Extrapolation value);
 @param frame        Frame at which to interpolate
 @param hint         Hint for keyframe search
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for the last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value.
 
 -   In case the first keyframe is already larger than @p frame or @p frame is
@@ -187,9 +187,13 @@ calculated interpolation factor, returning the interpolated value.
     the interpolator.
 -   In case no keyframes are present, default-constructed value is returned.
 
-The @p hint parameter hints where to start the linear search and is updated
-with keyframe index matching @p frame. If @p frame is earlier than @p hint, the
-search is restarted from the beginning.
+The @p hint parameter hints where to start the search and is updated with
+keyframe index matching @p frame. If @p frame is at or after the keyframe at
+@p hint, a few immediately following keyframes are checked first, so
+evaluating the animation forward with the hint preserved between calls is a
+constant-time operation. If @p frame is earlier than @p hint, is further away
+or the hint is out of bounds, the keyframe is binary-searched in
+@f$ \mathcal{O}(\log n) @f$ time.
 
 Used internally from @ref Track::at() / @ref TrackView::at(), see @ref Track
 documentation for more information.
@@ -200,15 +204,51 @@ documentation for more information.
 */
 template<class K, class V, class R = ResultOf<V>> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), K frame, std::size_t& hint);
 
+/**
+@brief Interpolate animation value at multiple frames
+@param[in] keys         Keys
+@param[in] values       Values
+@param[in] before       Extrapolation mode before first keyframe
+@param[in] after        Extrapolation mode after last keyframe
+@param[in] interpolator Interpolator function
+@param[in] frames       Frames at which to interpolate
+@param[in,out] hints    Hints for keyframe search
+@param[out] results     Where to put the interpolated values
+@m_since_latest
+
+Equivalent to calling @ref interpolate() for each item in @p frames, with
+corresponding item in @p hints and saving the result to corresponding item in
+@p results. Expects that @p frames, @p hints and @p results have the same
+size. Useful for evaluating the same track for many instances at once, for
+example when animating a crowd of characters sharing the same animation at
+different times --- the keyframe data stay in cache for all instances, the
+checks done on every call of @ref interpolate() are done just once, and if the
+hint for each instance is preserved between calls, the keyframe search is a
+constant-time operation when the animations are played forward.
+
+If @p interpolator is @ref Math::slerp(const Quaternion<T>&, const Quaternion<T>&, T) "Math::slerp()",
+@ref Math::slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T) "Math::slerpShortestPath()",
+@ref Math::sclerp(const DualQuaternion<T>&, const DualQuaternion<T>&, T) "Math::sclerp()"
+or @ref Math::sclerpShortestPath(const DualQuaternion<T>&, const DualQuaternion<T>&, T) "Math::sclerpShortestPath()"
+for @ref Magnum::Float "Float" types, the instances are interpolated in
+batches using @ref Math::slerpInto(), @ref Math::slerpShortestPathInto(),
+@ref Math::sclerpInto() or @ref Math::sclerpShortestPathInto() instead. The
+results are then equal to @ref interpolate() only within floating-point
+precision.
+@see @ref TrackView::atInto(), @ref Track::atInto()
+@experimental
+*/
+template<class K, class V, class R> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, Extrapolation before, Extrapolation after, R(*interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<const K>& frames, const Containers::StridedArrayView1D<std::size_t>& hints, const Containers::StridedArrayView1D<R>& results);
+
 /**
 @brief Interpolate animation value with strict constraints
 
-Does a linear search over the keyframes until it finds last keyframe which is
-not larger than @p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
+Searches the keyframes for the last keyframe which is not larger than
+@p frame. Once the keyframe is found, reference to it and the immediately following keyframe is passed to @p interpolator along with
 calculated interpolation factor, returning the interpolated value. The @p hint
-parameter hints where to start the linear search and is updated with keyframe
-index matching @p frame. If @p frame is earlier than @p hint, the search is
-restarted from the beginning.
+parameter hints where to start the search and is updated with keyframe index
+matching @p frame, with the search behaving the same as in
+@ref interpolate().
 
 This is a stricter but more performant version of @ref interpolate() with
 implicit @ref Extrapolation::Extrapolated behavior. Expects that there are
@@ -415,6 +455,107 @@ template<class V, class R> auto interpolatorFor(Interpolation interpolation) ->
     return Implementation::TypeTraits<typename std::remove_const<V>::type, R>::interpolator(interpolation);
 }
 
+namespace Implementation {
+
+/* Returns index of the last keyframe not larger than frame, clamped to
+   [0, keys.size() - 2]. Expects at least two keys. If the frame is at or
+   after the hint, a few following keyframes are tried first, which makes
+   sequential playback a constant-time operation. Otherwise, or if the frame
+   is further away, the rest is binary-searched, so seeking or wrapping
+   around a long track doesn't need to go through all keyframes from the
+   start. */
+template<class K> std::size_t findKeyframe(const Containers::StridedArrayView1D<const K>& keys, const K frame, std::size_t hint) {
+    std::size_t last = keys.size() - 2;
+    if(hint < keys.size() && frame >= keys[hint]) {
+        if(hint >= last) return last;
+        for(std::size_t i = 0; i != 4; ++i) {
+            if(frame < keys[hint + 1]) return hint;
+            if(++hint == last) return last;
+        }
+    } else hint = 0;
+
+    /* Here either hint == 0 or keys[hint] <= frame, the result is in
+       [hint, last] */
+    while(hint < last) {
+        const std::size_t mid = hint + (last - hint + 1)/2;
+        if(frame >= keys[mid]) hint = mid;
+        else last = mid - 1;
+    }
+
+    return hint;
+}
+
+/* Batch variants of builtin interpolators, used by interpolateInto() to
+   process many instances at once. Only the float quaternion and dual
+   quaternion slerp() / sclerp() variants have one, batchInterpolatorFor()
+   returns nullptr for everything else. */
+template<class V, class R> using BatchInterpolator = void(*)(const Containers::StridedArrayView1D<const V>&, const Containers::StridedArrayView1D<const V>&, const Containers::StridedArrayView1D<const Float>&, const Containers::StridedArrayView1D<R>&);
+template<class V, class R> struct HasBatchInterpolator: std::false_type {};
+template<> struct HasBatchInterpolator<Math::Quaternion<Float>, Math::Quaternion<Float>>: std::true_type {};
+template<> struct HasBatchInterpolator<Math::DualQuaternion<Float>, Math::DualQuaternion<Float>>: std::true_type {};
+MAGNUM_EXPORT BatchInterpolator<Math::Quaternion<Float>, Math::Quaternion<Float>> batchInterpolatorFor(Math::Quaternion<Float>(*interpolator)(const Math::Quaternion<Float>&, const Math::Quaternion<Float>&, Float));
+MAGNUM_EXPORT BatchInterpolator<Math::DualQuaternion<Float>, Math::DualQuaternion<Float>> batchInterpolatorFor(Math::DualQuaternion<Float>(*interpolator)(const Math::DualQuaternion<Float>&, const Math::DualQuaternion<Float>&, Float));
+
+template<class K, class V, class R> bool interpolateBatchInto(std::false_type, const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView1D<const V>&, Extrapolation, Extrapolation, R(*)(const V&, const V&, Float), const Containers::StridedArrayView1D<const K>&, const Containers::StridedArrayView1D<std::size_t>&, const Containers::StridedArrayView1D<R>&) {
+    return false;
+}
+
+/* Same as the loop in interpolateInto(), but gathering the keyframe pairs and
+   interpolation phases into a small on-stack buffer which is then passed to
+   the batch interpolator at once */
+template<class K, class V, class R> bool interpolateBatchInto(std::true_type, const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<const K>& frames, const Containers::StridedArrayView1D<std::size_t>& hints, const Containers::StridedArrayView1D<R>& results) {
+    const BatchInterpolator<V, R> batchInterpolator = batchInterpolatorFor(interpolator);
+    if(!batchInterpolator) return false;
+
+    enum: std::size_t { BatchSize = 64 };
+    V a[BatchSize];
+    V b[BatchSize];
+    Float t[BatchSize];
+    bool defaultConstructed[BatchSize];
+    for(std::size_t offset = 0; offset < frames.size(); offset += BatchSize) {
+        const std::size_t count = frames.size() - offset < BatchSize ?
+            frames.size() - offset : std::size_t(BatchSize);
+
+        for(std::size_t j = 0; j != count; ++j) {
+            K frame = frames[offset + j];
+            std::size_t& hint = hints[offset + j];
+            hint = findKeyframe(keys, frame, hint);
+
+            /* Default-constructed values are interpolated together with the
+               rest and overwritten afterwards */
+            defaultConstructed[j] = false;
+            if(frame < keys[hint]) {
+                if(before == Extrapolation::DefaultConstructed)
+                    defaultConstructed[j] = true;
+                else if(before == Extrapolation::Constant) frame = keys[hint];
+            } else if(frame >= keys[hint + 1]) {
+                if(after == Extrapolation::DefaultConstructed)
+                    defaultConstructed[j] = true;
+                else if(after == Extrapolation::Constant) frame = keys[hint + 1];
+            }
+
+            a[j] = values[hint];
+            b[j] = values[hint + 1];
+            t[j] = defaultConstructed[j] ? 0.0f :
+                Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame));
+        }
+
+        const Containers::StridedArrayView1D<R> batchResults = results.slice(offset, offset + count);
+        batchInterpolator(
+            Containers::arrayView(a).prefix(count),
+            Containers::arrayView(b).prefix(count),
+            Containers::arrayView(t).prefix(count),
+            batchResults);
+
+        for(std::size_t j = 0; j != count; ++j)
+            if(defaultConstructed[j]) batchResults[j] = R{};
+    }
+
+    return true;
+}
+
+}
+
 template<class K, class V, class R> R interpolate(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), K frame, std::size_t& hint) {
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolate(): keys and values don't have the same size", {});
 
@@ -430,12 +571,8 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         return interpolator(values[0], values[0], 0.0f);
     }
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    hint = Implementation::findKeyframe(keys, frame, hint);
 
     /* Special extrapolation outside of range. Usual extrapolation is handled
        below. */
@@ -451,16 +588,59 @@ template<class K, class V, class R> R interpolate(const Containers::StridedArray
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
 }
 
+template<class K, class V, class R> void interpolateInto(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, const Extrapolation before, const Extrapolation after, R(*const interpolator)(const V&, const V&, Float), const Containers::StridedArrayView1D<const K>& frames, const Containers::StridedArrayView1D<std::size_t>& hints, const Containers::StridedArrayView1D<R>& results) {
+    CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateInto(): keys and values don't have the same size", );
+    CORRADE_ASSERT(hints.size() == frames.size() && results.size() == frames.size(),
+        "Animation::interpolateInto(): expected hints and results to have" << frames.size() << "items but got" << hints.size() << "and" << results.size(), );
+
+    /* Less than two keyframes isn't worth optimizing for, delegate to the
+       single-value variant */
+    if(keys.size() < 2) {
+        for(std::size_t i = 0; i != frames.size(); ++i)
+            results[i] = interpolate(keys, values, before, after, interpolator, frames[i], hints[i]);
+        return;
+    }
+
+    /* Builtin quaternion and dual quaternion interpolators have a batch
+       variant that interpolates several instances at once */
+    if(Implementation::interpolateBatchInto(Implementation::HasBatchInterpolator<V, R>{}, keys, values, before, after, interpolator, frames, hints, results))
+        return;
+
+    /* Same as in interpolate() */
+    for(std::size_t i = 0; i != frames.size(); ++i) {
+        K frame = frames[i];
+        std::size_t& hint = hints[i];
+
+        /* Find a pair of keys that is around given time */
+        hint = Implementation::findKeyframe(keys, frame, hint);
+
+        /* Special extrapolation outside of range. Usual extrapolation is
+           handled below. */
+        if(frame < keys[hint]) {
+            if(before == Extrapolation::DefaultConstructed) {
+                results[i] = R{};
+                continue;
+            }
+            if(before == Extrapolation::Constant) frame = keys[hint];
+        } else if(frame >= keys[hint + 1]) {
+            if(after == Extrapolation::DefaultConstructed) {
+                results[i] = R{};
+                continue;
+            }
+            if(after == Extrapolation::Constant) frame = keys[hint + 1];
+        }
+
+        results[i] = interpolator(values[hint], values[hint + 1],
+            Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
+    }
+}
+
 template<class K, class V, class R> R interpolateStrict(const Containers::StridedArrayView1D<const K>& keys, const Containers::StridedArrayView1D<const V>& values, R(*const interpolator)(const V&, const V&, Float), const K frame, std::size_t& hint) {
     CORRADE_ASSERT(keys.size() >= 2, "Animation::interpolateStrict(): at least two keyframes required", {});
     CORRADE_ASSERT(keys.size() == values.size(), "Animation::interpolateStrict(): keys and values don't have the same size", {});
 
-    /* Rewind from the beginning if hint is too late */
-    if(hint >= keys.size() || frame < keys[hint]) hint = 0;
-
-    /* Go through the keys until we find a pair that is around given time */
-    while(hint + 2 < keys.size() && frame >= keys[hint + 1])
-        ++hint;
+    /* Find a pair of keys that is around given time */
+    hint = Implementation::findKeyframe(keys, frame, hint);
 
     return interpolator(values[hint], values[hint + 1],
         Math::lerpInverted(Float(keys[hint]), Float(keys[hint + 1]), Float(frame)));
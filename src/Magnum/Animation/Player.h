@@ -175,7 +175,13 @@ never from @ref pause(), @ref stop() or any other API.
 For managing global application you can use @ref Timeline, @ref std::chrono
 APIs or any other type that supports basic arithmetic. The time doesn't have to
 be monotonic or have constant speed, but note that non-continuous and backward
-time jumps may have worse performance than going monotonically forward. See
+time jumps may have worse performance than going monotonically forward. The
+player remembers the last used keyframe for each track and passes it as a hint
+to @ref TrackView::at(K, std::size_t&) const in the next @ref advance(), so
+going forward is a constant-time operation regardless of the track length and
+a jump or a wraparound to the next iteration costs a binary search. This
+applies also to tracks coming from @ref Trade::AnimationData, as those are
+added as @ref TrackView instances as well. See
 @ref Animation-Player-time-type "below" for more information about using
 different time types.
 
@@ -258,6 +264,17 @@ template<class T, class K
          */
         typedef std::pair<UnsignedInt, K>(*Scaler)(T, K);
 
+        /**
+         * @brief Advance multiple players at the same time
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref advance(T) for each item in @p players.
+         * If many players play the same animation, it's more efficient to
+         * evaluate its tracks for all of them at once with
+         * @ref TrackView::atInto() instead.
+         */
+        static void advance(T time, Containers::ArrayView<const Containers::Reference<Player<T, K>>> players);
+
         /**
          * @brief Advance multiple players at the same time
          *
@@ -633,6 +650,23 @@ template<class T, class K
         }
         #endif
 
+        /**
+         * @brief Add a compressed track with a result destination
+         * @m_since_latest
+         *
+         * Equivalent to @ref add(const TrackView<const K, const V, R>&, R&),
+         * but decompressing the values from a @ref CompressedTrack. Available
+         * only for @relativeref{Magnum,Float} keys, you need to include
+         * @ref Magnum/Animation/CompressedTrack.h in order to use it. The
+         * @ref track() function returns
+         * @ref CompressedTrack::durationTrack() for compressed tracks.
+         *
+         * Note that the track ownership is *not* transferred to the
+         * @ref Player and you have to ensure that it's kept in scope for the
+         * whole lifetime of the @ref Player instance.
+         */
+        template<class R> Player<T, K>& add(const CompressedTrack<R>& track, R& destination);
+
         /**
          * @brief State
          *
@@ -823,6 +857,18 @@ template<class T, class K> template<class V, class R> Player<T, K>& Player<T, K>
         }, &destination, nullptr, nullptr);
 }
 
+template<class T, class K> template<class R> Player<T, K>& Player<T, K>::add(const CompressedTrack<R>& track, R& destination) {
+    static_assert(std::is_same<K, Float>::value,
+        "compressed tracks can be used only with Float keys");
+    /* The duration track is referencing memory inside the compressed track,
+       so it stays valid for as long as the compressed track does. The track
+       itself is passed via the user data pointer. */
+    return addInternal(track.durationTrack(),
+        [](const TrackViewStorage<const K>&, K key, std::size_t& hint, void* destination, void(*)(), void* userData) {
+            *static_cast<R*>(destination) = static_cast<const CompressedTrack<R>*>(userData)->at(key, hint);
+        }, &destination, nullptr, const_cast<CompressedTrack<R>*>(&track));
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template<class T, class K> template<class V, class R, class Callback> Player<T, K>& Player<T, K>::addWithCallback(const TrackView<const K, const V, R>& track, Callback callback, void* userData) {
     auto callbackPtr = static_cast<void(*)(K, const R&, void*)>(callback);
@@ -72,10 +72,14 @@ template<class T, class K> struct Player<T, K>::Track  {
 };
 #endif
 
-template<class T, class K> void Player<T, K>::advance(const T time, const std::initializer_list<Containers::Reference<Player<T, K>>> players) {
+template<class T, class K> void Player<T, K>::advance(const T time, const Containers::ArrayView<const Containers::Reference<Player<T, K>>> players) {
     for(Player<T, K>& p: players) p.advance(time);
 }
 
+template<class T, class K> void Player<T, K>::advance(const T time, const std::initializer_list<Containers::Reference<Player<T, K>>> players) {
+    advance(time, Containers::arrayView(players));
+}
+
 template<class T, class K> Player<T, K>::Player(Player<T, K>&&) noexcept = default;
 
 template<class T, class K> Player<T, K>& Player<T, K>::operator=(Player<T, K>&&) noexcept = default;
@@ -23,9 +23,12 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Animation/Player.h"
+#include "Magnum/Math/Quaternion.h"
 
 namespace Magnum { namespace Animation { namespace Test { namespace {
 
@@ -39,6 +42,7 @@ struct Benchmark: TestSuite::Tester {
     void atEmpty();
     void at();
     void atHint();
+    void atHintSeek();
     void atStrict();
     void atStrictInterleaved();
     void atStrictInterleavedDirectInterpolator();
@@ -50,6 +54,13 @@ struct Benchmark: TestSuite::Tester {
     void playerAdvanceRawCallback();
     void playerAdvanceRawCallbackDirectInterpolator();
 
+    void atInstancesVector3();
+    void atIntoInstancesVector3();
+    void atInstancesQuaternion();
+    void atIntoInstancesQuaternion();
+    void atIntoInstancesQuaternionScalar();
+    void playerAdvanceInstances();
+
     Containers::Array<Float> _keys;
     Containers::Array<Int> _values;
     Containers::Array<std::pair<Float, Int>> _interleaved;
@@ -57,10 +68,20 @@ struct Benchmark: TestSuite::Tester {
     Containers::StridedArrayView1D<const Int> _valuesInterleaved;
     TrackView<const Float, const Int> _track;
     TrackView<const Float, const Int> _trackInterleaved;
+
+    Containers::Array<std::pair<Float, Vector3>> _translations;
+    Containers::Array<std::pair<Float, Quaternion>> _rotations;
+    TrackView<const Float, const Vector3> _translationTrack;
+    TrackView<const Float, const Quaternion> _rotationTrack;
 };
 
 namespace {
-    enum: std::size_t { DataSize = 2000 };
+    enum: std::size_t {
+        DataSize = 2000,
+        /* Instances playing the same animation, each at a different time */
+        InstanceCount = 10000,
+        InstanceDataSize = 100
+    };
 }
 
 Benchmark::Benchmark() {
@@ -71,6 +92,7 @@ Benchmark::Benchmark() {
                    &Benchmark::atEmpty,
                    &Benchmark::at,
                    &Benchmark::atHint,
+                   &Benchmark::atHintSeek,
                    &Benchmark::atStrict,
                    &Benchmark::atStrictInterleaved,
                    &Benchmark::atStrictInterleavedDirectInterpolator,
@@ -82,6 +104,13 @@ Benchmark::Benchmark() {
                    &Benchmark::playerAdvanceRawCallback,
                    &Benchmark::playerAdvanceRawCallbackDirectInterpolator}, 10);
 
+    addBenchmarks({&Benchmark::atInstancesVector3,
+                   &Benchmark::atIntoInstancesVector3,
+                   &Benchmark::atInstancesQuaternion,
+                   &Benchmark::atIntoInstancesQuaternion,
+                   &Benchmark::atIntoInstancesQuaternionScalar,
+                   &Benchmark::playerAdvanceInstances}, 5);
+
     _keys = Containers::Array<Float>{DataSize};
     _values = Containers::Array<Int>{Containers::DirectInit, DataSize, 1};
     _interleaved = Containers::Array<std::pair<Float, Int>>{Containers::DirectInit, DataSize, 0.0f, 1};
@@ -94,6 +123,15 @@ Benchmark::Benchmark() {
     _track = TrackView<const Float, const Int>{
         Containers::arrayView(_keys), Containers::arrayView(_values), Math::select};
     _trackInterleaved = {_keysInterleaved, _valuesInterleaved, Math::select};
+
+    _translations = Containers::Array<std::pair<Float, Vector3>>{InstanceDataSize};
+    _rotations = Containers::Array<std::pair<Float, Quaternion>>{InstanceDataSize};
+    for(std::size_t i = 0; i != InstanceDataSize; ++i) {
+        _translations[i] = {Float(i), Vector3{Float(i%3)}};
+        _rotations[i] = {Float(i), Quaternion::rotation(Deg(Float(i%3)*30.0f), Vector3::yAxis())};
+    }
+    _translationTrack = {_translations, Math::lerp};
+    _rotationTrack = {_rotations, Math::slerp};
 }
 
 void Benchmark::interpolateEmpty() {
@@ -154,6 +192,18 @@ void Benchmark::atHint() {
     CORRADE_COMPARE(result, 125000);
 }
 
+void Benchmark::atHintSeek() {
+    Int result{};
+    CORRADE_BENCHMARK(250) {
+        /* Jumping back and forth across the whole track, so the hint is
+           useless and every lookup is a search */
+        std::size_t hint{};
+        for(Float i = 0.0f; i < 500.0f; i += 1.0f)
+            result += _track.at(Int(i) % 2 ? 6000.0f - i : i, hint);
+    }
+    CORRADE_COMPARE(result, 125000);
+}
+
 void Benchmark::atStrict() {
     Int result{};
     CORRADE_BENCHMARK(250) {
@@ -260,6 +310,117 @@ void Benchmark::playerAdvanceRawCallbackDirectInterpolator() {
     CORRADE_COMPARE(result, 125000);
 }
 
+/* Every instance plays the animation delayed by a different amount, advanced
+   by ten frames each iteration */
+Float instanceTime(std::size_t instance, std::size_t iteration) {
+    return Float(instance%InstanceDataSize) + Float(iteration)*0.1f;
+}
+
+void Benchmark::atInstancesVector3() {
+    Containers::Array<std::size_t> hints{Containers::ValueInit, InstanceCount};
+    Containers::Array<Vector3> results{Containers::ValueInit, InstanceCount};
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != InstanceCount; ++i)
+            results[i] = _translationTrack.at(instanceTime(i, iteration), hints[i]);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(results[1], _translationTrack.at(instanceTime(1, iteration - 1)));
+}
+
+void Benchmark::atIntoInstancesVector3() {
+    Containers::Array<Float> frames{Containers::NoInit, InstanceCount};
+    Containers::Array<std::size_t> hints{Containers::ValueInit, InstanceCount};
+    Containers::Array<Vector3> results{Containers::ValueInit, InstanceCount};
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != InstanceCount; ++i)
+            frames[i] = instanceTime(i, iteration);
+        _translationTrack.atInto(frames, hints, results);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(results[1], _translationTrack.at(instanceTime(1, iteration - 1)));
+}
+
+void Benchmark::atInstancesQuaternion() {
+    Containers::Array<std::size_t> hints{Containers::ValueInit, InstanceCount};
+    Containers::Array<Quaternion> results{Containers::ValueInit, InstanceCount};
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != InstanceCount; ++i)
+            results[i] = _rotationTrack.at(instanceTime(i, iteration), hints[i]);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(results[0].axis(), Vector3::yAxis());
+}
+
+void Benchmark::atIntoInstancesQuaternion() {
+    Containers::Array<Float> frames{Containers::NoInit, InstanceCount};
+    Containers::Array<std::size_t> hints{Containers::ValueInit, InstanceCount};
+    Containers::Array<Quaternion> results{Containers::ValueInit, InstanceCount};
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != InstanceCount; ++i)
+            frames[i] = instanceTime(i, iteration);
+        _rotationTrack.atInto(frames, hints, results);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(results[0].axis(), Vector3::yAxis());
+}
+
+void Benchmark::atIntoInstancesQuaternionScalar() {
+    Containers::Array<Float> frames{Containers::NoInit, InstanceCount};
+    Containers::Array<std::size_t> hints{Containers::ValueInit, InstanceCount};
+    Containers::Array<Quaternion> results{Containers::ValueInit, InstanceCount};
+
+    /* A custom interpolator isn't recognized as a builtin one, so this goes
+       through the scalar path instead of Math::slerpInto() */
+    const TrackView<const Float, const Quaternion> track{_rotations,
+        [](const Quaternion& a, const Quaternion& b, Float t) {
+            return Math::slerp(a, b, t);
+        }};
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        for(std::size_t i = 0; i != InstanceCount; ++i)
+            frames[i] = instanceTime(i, iteration);
+        track.atInto(frames, hints, results);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(results[0].axis(), Vector3::yAxis());
+}
+
+void Benchmark::playerAdvanceInstances() {
+    Containers::Array<Player<Float>> players{InstanceCount};
+    Containers::Array<Vector3> translations{Containers::ValueInit, InstanceCount};
+    Containers::Array<Quaternion> rotations{Containers::ValueInit, InstanceCount};
+    Containers::Array<Containers::Reference<Player<Float>>> playerReferences;
+    arrayReserve(playerReferences, InstanceCount);
+    for(std::size_t i = 0; i != InstanceCount; ++i) {
+        players[i].add(_translationTrack, translations[i])
+            .add(_rotationTrack, rotations[i])
+            .play(-Float(i%InstanceDataSize));
+        arrayAppend(playerReferences, players[i]);
+    }
+
+    std::size_t iteration = 0;
+    CORRADE_BENCHMARK(10) {
+        Player<Float>::advance(Float(iteration)*0.1f, playerReferences);
+        ++iteration;
+    }
+
+    CORRADE_COMPARE(translations[1], _translationTrack.at(instanceTime(1, iteration - 1)));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Animation::Test::Benchmark)
@@ -0,0 +1,432 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Animation/CompressedTrack.h"
+#include "Magnum/Animation/Player.h"
+
+namespace Magnum { namespace Animation { namespace Test { namespace {
+
+struct CompressedTrackTest: TestSuite::Tester {
+    explicit CompressedTrackTest();
+
+    void packQuaternion();
+    void packQuaternionNegativeLargest();
+    void packQuaternionRandom();
+    void packQuaternionNotNormalized();
+
+    void constructEmpty();
+    void constructSingleKeyframe();
+    void constructLinear();
+    void constructConstant();
+    void constructZeroDuration();
+    void constructInvalid();
+    void constructMove();
+
+    void atVector3();
+    void atQuaternion();
+    void atExtrapolation();
+    void atHint();
+
+    void keyValueOutOfRange();
+
+    void player();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    Extrapolation extrapolation;
+    Vector3 before, after;
+} ExtrapolationData[]{
+    {"constant", Extrapolation::Constant,
+        {0.0f, 0.0f, 0.0f}, {10.0f, 20.0f, -10.0f}},
+    {"default-constructed", Extrapolation::DefaultConstructed,
+        {}, {}},
+    {"extrapolated", Extrapolation::Extrapolated,
+        {-1.0f, -2.0f, 1.0f}, {11.0f, 22.0f, -11.0f}}
+};
+
+CompressedTrackTest::CompressedTrackTest() {
+    addTests({&CompressedTrackTest::packQuaternion,
+              &CompressedTrackTest::packQuaternionNegativeLargest,
+              &CompressedTrackTest::packQuaternionRandom,
+              &CompressedTrackTest::packQuaternionNotNormalized,
+
+              &CompressedTrackTest::constructEmpty,
+              &CompressedTrackTest::constructSingleKeyframe,
+              &CompressedTrackTest::constructLinear,
+              &CompressedTrackTest::constructConstant,
+              &CompressedTrackTest::constructZeroDuration,
+              &CompressedTrackTest::constructInvalid,
+              &CompressedTrackTest::constructMove,
+
+              &CompressedTrackTest::atVector3,
+              &CompressedTrackTest::atQuaternion});
+
+    addInstancedTests({&CompressedTrackTest::atExtrapolation},
+        Containers::arraySize(ExtrapolationData));
+
+    addTests({&CompressedTrackTest::atHint,
+
+              &CompressedTrackTest::keyValueOutOfRange,
+
+              &CompressedTrackTest::player});
+}
+
+/* Rotation angle between two quaternions, robust for small angles */
+Float rotationError(const Quaternion& a, const Quaternion& b) {
+    const Float chord = Math::dot(a, b) < 0.0f ? (a + b).length() : (a - b).length();
+    return 4.0f*std::asin(Math::min(chord*0.5f, 1.0f));
+}
+
+void CompressedTrackTest::packQuaternion() {
+    /* Identity and axis-aligned rotations have the zero components exactly
+       representable */
+    CORRADE_VERIFY(unpackQuaternion(Animation::packQuaternion({})) == Quaternion{});
+
+    const Quaternion a = Quaternion::rotation(90.0_degf, Vector3::xAxis());
+    CORRADE_COMPARE(unpackQuaternion(Animation::packQuaternion(a)), a);
+
+    const Quaternion b = Quaternion::rotation(35.0_degf, Vector3{1.0f, -2.0f, 3.0f}.normalized());
+    CORRADE_COMPARE_AS(rotationError(unpackQuaternion(Animation::packQuaternion(b)), b), 1.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void CompressedTrackTest::packQuaternionNegativeLargest() {
+    /* The result represents the same rotation, just negated */
+    const Quaternion a = -Quaternion::rotation(20.0_degf, Vector3::zAxis());
+    CORRADE_COMPARE_AS(a.scalar(), 0.0f,
+        TestSuite::Compare::Less);
+    const Quaternion unpacked = unpackQuaternion(Animation::packQuaternion(a));
+    CORRADE_COMPARE(unpacked, -a);
+    CORRADE_COMPARE_AS(unpacked.scalar(), 0.0f,
+        TestSuite::Compare::Greater);
+}
+
+void CompressedTrackTest::packQuaternionRandom() {
+    /* A deterministic set of rotations covering all four possible largest
+       components */
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        const Quaternion q = Quaternion{
+            {Math::sin(Rad(i*1.3f)), Math::cos(Rad(i*0.7f)), Math::sin(Rad(i*2.9f + 1.0f))},
+            Math::cos(Rad(i*0.3f + 0.5f))}.normalized();
+        const Quaternion unpacked = unpackQuaternion(Animation::packQuaternion(q));
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(unpacked.isNormalized());
+        maxError = Math::max(maxError, rotationError(unpacked, q));
+    }
+
+    CORRADE_COMPARE_AS(maxError, 1.0e-4f,
+        TestSuite::Compare::Less);
+}
+
+void CompressedTrackTest::packQuaternionNotNormalized() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::packQuaternion(Quaternion{{1.0f, 2.0f, 3.0f}, 4.0f});
+    CORRADE_COMPARE(out.str(), "Animation::packQuaternion(): quaternion Quaternion({1, 2, 3}, 4) is not normalized\n");
+}
+
+void CompressedTrackTest::constructEmpty() {
+    CompressedTrack<Vector3> a;
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.duration(), Range1D{});
+    CORRADE_COMPARE(a.dataSize(), 0);
+    CORRADE_COMPARE(a.at(3.0f), Vector3{});
+
+    /* Same when compressing an empty track */
+    CompressedTrack<Quaternion> b{TrackView<const Float, const Quaternion>{}, 0.1f};
+    CORRADE_COMPARE(b.size(), 0);
+    CORRADE_COMPARE(b.duration(), Range1D{});
+    CORRADE_COMPARE(b.at(3.0f), Quaternion{});
+}
+
+void CompressedTrackTest::constructSingleKeyframe() {
+    const std::pair<Float, Vector3> data[]{
+        {2.0f, {1.0f, 2.0f, 3.0f}}
+    };
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{data, Math::lerp, Extrapolation::Constant, Extrapolation::DefaultConstructed}, 0.01f};
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a.duration(), (Range1D{2.0f, 2.0f}));
+    CORRADE_COMPARE(a.key(0), 2.0f);
+    CORRADE_COMPARE(a.value(0), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.at(1.0f), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.at(2.0f), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(a.at(3.0f), Vector3{});
+}
+
+void CompressedTrackTest::constructLinear() {
+    /* Keyframes on a line get reduced to just the endpoints */
+    std::pair<Float, Vector3> data[101];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = {i*0.1f, Vector3{1.0f, 2.0f, -1.0f}*(i*0.1f)};
+    const TrackView<const Float, const Vector3> track{data, Math::lerp, Extrapolation::Extrapolated, Extrapolation::Constant};
+
+    CompressedTrack<Vector3> a{track, 0.001f};
+    CORRADE_COMPARE(a.before(), Extrapolation::Extrapolated);
+    CORRADE_COMPARE(a.after(), Extrapolation::Constant);
+    CORRADE_COMPARE(a.duration(), (Range1D{0.0f, 10.0f}));
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a.keys()[0], 0);
+    CORRADE_COMPARE(a.keys()[1], 65535);
+    CORRADE_COMPARE(a.key(0), 0.0f);
+    CORRADE_COMPARE(a.key(1), 10.0f);
+    CORRADE_COMPARE(a.value(0), (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.value(1), (Vector3{10.0f, 20.0f, -10.0f}));
+    CORRADE_COMPARE(a.dataSize(), 2*2 + 2*6);
+}
+
+void CompressedTrackTest::constructConstant() {
+    /* The reduction is limited to 256 consecutive keyframes, so a constant
+       track gets a keyframe each 256 original keyframes, plus the last */
+    std::pair<Float, Quaternion> data[1000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = {i/60.0f, Quaternion::rotation(15.0_degf, Vector3::yAxis())};
+
+    CompressedTrack<Quaternion> a{TrackView<const Float, const Quaternion>{data, Math::slerp}, 0.001f};
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a.keys()[1], 16794); /* 256/999*65535, rounded */
+    CORRADE_COMPARE(a.keys()[4], 65535);
+    CORRADE_COMPARE(a.key(0), 0.0f);
+    CORRADE_COMPARE(a.key(4), 999/60.0f);
+    for(std::size_t i = 0; i != a.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(a.value(i), Quaternion::rotation(15.0_degf, Vector3::yAxis()));
+    }
+}
+
+void CompressedTrackTest::constructZeroDuration() {
+    const std::pair<Float, Vector3> data[]{
+        {1.0f, {1.0f, 0.0f, 0.0f}},
+        {1.0f, {2.0f, 0.0f, 0.0f}},
+        {1.0f, {3.0f, 0.0f, 0.0f}}
+    };
+
+    /* All keys quantize to the same value, the result goes from the first to
+       the last keyframe */
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{data, Math::lerp}, 0.01f};
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a.duration(), (Range1D{1.0f, 1.0f}));
+    CORRADE_COMPARE(a.value(0), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.value(1), (Vector3{3.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.at(0.5f), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.at(1.5f), (Vector3{3.0f, 0.0f, 0.0f}));
+}
+
+void CompressedTrackTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CompressedTrack<Vector3>{TrackView<const Float, const Vector3>{}, -0.1f};
+    CORRADE_COMPARE(out.str(), "Animation::CompressedTrack: expected non-negative max error but got -0.1\n");
+}
+
+void CompressedTrackTest::constructMove() {
+    const std::pair<Float, Vector3> data[]{
+        {0.0f, {1.0f, 0.0f, 0.0f}},
+        {1.0f, {2.0f, 5.0f, 0.0f}}
+    };
+
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{data, Math::lerp, Extrapolation::DefaultConstructed}, 0.01f};
+
+    CompressedTrack<Vector3> b{std::move(a)};
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(b.duration(), (Range1D{0.0f, 1.0f}));
+    CORRADE_COMPARE(b.before(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(b.at(0.5f), (Vector3{1.5f, 2.5f, 0.0f}));
+
+    CompressedTrack<Vector3> c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(c.duration(), (Range1D{0.0f, 1.0f}));
+    CORRADE_COMPARE(c.after(), Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(c.at(0.5f), (Vector3{1.5f, 2.5f, 0.0f}));
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CompressedTrack<Vector3>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CompressedTrack<Vector3>>::value);
+}
+
+void CompressedTrackTest::atVector3() {
+    /* Densely sampled curvy motion, as if from motion capture */
+    Containers::Array<std::pair<Float, Vector3>> data{Containers::NoInit, 601};
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const Float t = i/60.0f;
+        data[i] = {t, Vector3{Math::sin(Rad(t)), 0.5f*Math::cos(Rad(t*1.7f)), t*0.1f}};
+    }
+    const TrackView<const Float, const Vector3> track{Containers::arrayView(data), Math::lerp};
+
+    constexpr Float MaxError = 0.001f;
+    CompressedTrack<Vector3> a{track, MaxError};
+
+    /* The compressed data should be significantly smaller */
+    CORRADE_COMPARE_AS(a.size(), data.size()/3,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(a.dataSize(), data.size()*(sizeof(Float) + sizeof(Vector3))/5,
+        TestSuite::Compare::Less);
+
+    /* All original keyframes are reconstructed within the error bound, with
+       some slack for the key quantization */
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != data.size(); ++i)
+        maxError = Math::max(maxError, (a.at(data[i].first) - data[i].second).length());
+    CORRADE_COMPARE_AS(maxError, MaxError + 5.0e-4f,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressedTrackTest::atQuaternion() {
+    /* Rotation around a wobbling axis */
+    Containers::Array<std::pair<Float, Quaternion>> data{Containers::NoInit, 601};
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const Float t = i/60.0f;
+        data[i] = {t, Quaternion::rotation(Rad(t*2.0f),
+            Vector3{Math::sin(Rad(t*0.5f)), 1.0f, Math::cos(Rad(t*0.3f))}.normalized())};
+    }
+    const TrackView<const Float, const Quaternion> track{Containers::arrayView(data), Math::slerp};
+
+    const Float MaxError = Float(Rad(0.5_degf));
+    CompressedTrack<Quaternion> a{track, MaxError};
+
+    CORRADE_COMPARE_AS(a.size(), data.size()/10,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(a.dataSize(), data.size()*(sizeof(Float) + sizeof(Quaternion))/10,
+        TestSuite::Compare::Less);
+
+    Float maxError = 0.0f;
+    for(std::size_t i = 0; i != data.size(); ++i) {
+        const Quaternion q = a.at(data[i].first);
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(q.isNormalized());
+        maxError = Math::max(maxError, rotationError(q, data[i].second));
+    }
+    CORRADE_COMPARE_AS(maxError, MaxError + 5.0e-4f,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void CompressedTrackTest::atExtrapolation() {
+    auto&& data = ExtrapolationData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::pair<Float, Vector3> keyframes[]{
+        {0.0f, {0.0f, 0.0f, 0.0f}},
+        {5.0f, {5.0f, 10.0f, -5.0f}},
+        {10.0f, {10.0f, 20.0f, -10.0f}}
+    };
+
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{keyframes, Math::lerp, data.extrapolation}, 0.001f};
+    CORRADE_COMPARE(a.at(-1.0f), data.before);
+    CORRADE_COMPARE(a.at(11.0f), data.after);
+}
+
+void CompressedTrackTest::atHint() {
+    /* 86 keys, so each quantizes exactly to a multiple of 65535/85 = 771 */
+    std::pair<Float, Vector3> data[86];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = {Float(i), Vector3{Float(i%2), 0.0f, 0.0f}};
+
+    /* The zig-zag can't be reduced */
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{data, Math::lerp}, 0.01f};
+    CORRADE_COMPARE(a.size(), 86);
+    CORRADE_COMPARE(a.keys()[55], 55*771);
+
+    std::size_t hint = 0;
+    CORRADE_COMPARE(a.at(55.5f, hint), (Vector3{0.5f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(hint, 55);
+    CORRADE_COMPARE(a.at(57.25f, hint), (Vector3{0.75f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(hint, 57);
+}
+
+void CompressedTrackTest::keyValueOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const std::pair<Float, Vector3> data[]{
+        {0.0f, {1.0f, 0.0f, 0.0f}},
+        {1.0f, {2.0f, 5.0f, 0.0f}}
+    };
+    CompressedTrack<Vector3> a{TrackView<const Float, const Vector3>{data, Math::lerp}, 0.01f};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    a.key(2);
+    a.value(2);
+    CORRADE_COMPARE(out.str(),
+        "Animation::CompressedTrack::key(): index 2 out of range for 2 keyframes\n"
+        "Animation::CompressedTrack::value(): index 2 out of range for 2 keyframes\n");
+}
+
+void CompressedTrackTest::player() {
+    /* Keys chosen so they're exactly representable after quantization */
+    const std::pair<Float, Vector3> translationData[]{
+        {0.0f, {0.0f, 0.0f, 0.0f}},
+        {1.0f, {1.0f, 2.0f, 3.0f}},
+        {3.0f, {0.0f, 0.0f, 6.0f}}
+    };
+    const std::pair<Float, Quaternion> rotationData[]{
+        {0.0f, {}},
+        {2.0f, Quaternion::rotation(90.0_degf, Vector3::xAxis())}
+    };
+
+    CompressedTrack<Vector3> translation{TrackView<const Float, const Vector3>{translationData, Math::lerp}, 0.001f};
+    CompressedTrack<Quaternion> rotation{TrackView<const Float, const Quaternion>{rotationData, Math::slerp}, 0.001f};
+
+    Vector3 translationResult;
+    Quaternion rotationResult;
+    Player<Float> player;
+    player.add(translation, translationResult)
+          .add(rotation, rotationResult);
+    CORRADE_COMPARE(player.size(), 2);
+    CORRADE_COMPARE(player.duration(), (Range1D{0.0f, 3.0f}));
+    CORRADE_COMPARE(player.track(1).duration(), (Range1D{0.0f, 2.0f}));
+
+    player.play(10.0f);
+    player.advance(11.5f);
+    CORRADE_COMPARE(translationResult, translation.at(1.5f));
+    CORRADE_COMPARE(translationResult, (Vector3{0.75f, 1.5f, 3.75f}));
+    CORRADE_COMPARE(rotationResult, rotation.at(1.5f));
+
+    player.advance(12.5f);
+    CORRADE_COMPARE(translationResult, (Vector3{0.25f, 0.5f, 5.25f}));
+    CORRADE_COMPARE(rotationResult, Quaternion::rotation(90.0_degf, Vector3::xAxis()));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Animation::Test::CompressedTrackTest)
@@ -63,17 +63,22 @@ struct InterpolationTest: TestSuite::Tester {
 
     void interpolate();
     void interpolateStrict();
+    void interpolateInto();
+    void interpolateIntoQuaternionBatch();
+    void interpolateIntoDualQuaternionBatch();
     void interpolateSingleKeyframe();
     void interpolateNoKeyframe();
 
     void interpolateHint();
     void interpolateStrictHint();
+    void interpolateHintLongTrack();
 
     void interpolateDifferentResultType();
     void interpolateStrictDifferentResultType();
 
     void interpolateError();
     void interpolateStrictError();
+    void interpolateIntoError();
 
     void interpolateIntegerKey();
     void interpolateStrictIntegerKey();
@@ -179,7 +184,10 @@ InterpolationTest::InterpolationTest() {
               &InterpolationTest::interpolatorForCubicHermiteQuaternionInvalid});
 
     addInstancedTests({&InterpolationTest::interpolate,
-                       &InterpolationTest::interpolateStrict},
+                       &InterpolationTest::interpolateStrict,
+                       &InterpolationTest::interpolateInto,
+                       &InterpolationTest::interpolateIntoQuaternionBatch,
+                       &InterpolationTest::interpolateIntoDualQuaternionBatch},
                        Containers::arraySize(Data));
 
     addInstancedTests({&InterpolationTest::interpolateSingleKeyframe},
@@ -191,11 +199,14 @@ InterpolationTest::InterpolationTest() {
                        &InterpolationTest::interpolateStrictHint},
                        Containers::arraySize(HintData));
 
-    addTests({&InterpolationTest::interpolateDifferentResultType,
+    addTests({&InterpolationTest::interpolateHintLongTrack,
+
+              &InterpolationTest::interpolateDifferentResultType,
               &InterpolationTest::interpolateStrictDifferentResultType,
 
               &InterpolationTest::interpolateError,
               &InterpolationTest::interpolateStrictError,
+              &InterpolationTest::interpolateIntoError,
 
               &InterpolationTest::interpolateIntegerKey,
               &InterpolationTest::interpolateStrictIntegerKey,
@@ -476,6 +487,103 @@ void InterpolationTest::interpolateStrict() {
     CORRADE_COMPARE(hint, data.expectedHint);
 }
 
+void InterpolationTest::interpolateInto() {
+    const auto& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Second item starts with a hint that's too late, third with one out of
+       bounds, fourth is at a different time to verify the items are
+       independent */
+    const Float frames[]{data.time, data.time, data.time, 3.0f};
+    std::size_t hints[]{0, 3, 405780454, 0};
+    Float results[4]{};
+    Animation::interpolateInto<Float, Float, Float>(
+        Keys, Values, data.extrapolationBefore, data.extrapolationAfter,
+        Math::lerp, frames, hints, results);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(results[i], data.expectedValue);
+        CORRADE_COMPARE(hints[i], data.expectedHint);
+    }
+    CORRADE_COMPARE(results[3], 1.75f);
+    CORRADE_COMPARE(hints[3], 1);
+}
+
+void InterpolationTest::interpolateIntoQuaternionBatch() {
+    const auto& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The last rotation is on the opposite hemisphere to test the shortest
+       path variant */
+    const Quaternion values[]{
+        Quaternion::rotation(15.0_degf, Vector3::xAxis()),
+        Quaternion::rotation(95.0_degf, Vector3{1.0f, 2.0f, 0.5f}.normalized()),
+        Quaternion::rotation(-35.0_degf, Vector3::zAxis()),
+        -Quaternion::rotation(65.0_degf, Vector3::yAxis())
+    };
+
+    /* More than what fits into a single batch, and not divisible by four,
+       covering the extrapolated ranges as well */
+    Float frames[97];
+    for(std::size_t i = 0; i != Containers::arraySize(frames); ++i)
+        frames[i] = -1.0f + 7.0f*i/(Containers::arraySize(frames) - 1);
+
+    for(auto interpolator: {
+        static_cast<Quaternion(*)(const Quaternion&, const Quaternion&, Float)>(Math::slerp),
+        static_cast<Quaternion(*)(const Quaternion&, const Quaternion&, Float)>(Math::slerpShortestPath)
+    }) {
+        std::size_t hints[Containers::arraySize(frames)]{};
+        Quaternion results[Containers::arraySize(frames)];
+        Animation::interpolateInto<Float, Quaternion, Quaternion>(
+            Keys, values, data.extrapolationBefore, data.extrapolationAfter,
+            interpolator, frames, hints, results);
+        for(std::size_t i = 0; i != Containers::arraySize(frames); ++i) {
+            CORRADE_ITERATION(i);
+            std::size_t hint{};
+            CORRADE_COMPARE(results[i], (Animation::interpolate<Float, Quaternion>(Keys, values, data.extrapolationBefore, data.extrapolationAfter, interpolator, frames[i], hint)));
+            CORRADE_COMPARE(hints[i], hint);
+        }
+    }
+}
+
+void InterpolationTest::interpolateIntoDualQuaternionBatch() {
+    const auto& data = Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* The last transformation is on the opposite hemisphere to test the
+       shortest path variant */
+    const DualQuaternion values[]{
+        DualQuaternion::translation({1.0f, 2.0f, -0.5f})*
+            DualQuaternion::rotation(15.0_degf, Vector3::xAxis()),
+        DualQuaternion::rotation(95.0_degf, Vector3{1.0f, 2.0f, 0.5f}.normalized()),
+        DualQuaternion::translation({-3.0f, 0.5f, 1.0f})*
+            DualQuaternion::rotation(-35.0_degf, Vector3::zAxis()),
+        -DualQuaternion::translation({0.0f, 1.0f, 2.0f})*
+            DualQuaternion::rotation(65.0_degf, Vector3::yAxis())
+    };
+
+    Float frames[97];
+    for(std::size_t i = 0; i != Containers::arraySize(frames); ++i)
+        frames[i] = -1.0f + 7.0f*i/(Containers::arraySize(frames) - 1);
+
+    for(auto interpolator: {
+        static_cast<DualQuaternion(*)(const DualQuaternion&, const DualQuaternion&, Float)>(Math::sclerp),
+        static_cast<DualQuaternion(*)(const DualQuaternion&, const DualQuaternion&, Float)>(Math::sclerpShortestPath)
+    }) {
+        std::size_t hints[Containers::arraySize(frames)]{};
+        DualQuaternion results[Containers::arraySize(frames)];
+        Animation::interpolateInto<Float, DualQuaternion, DualQuaternion>(
+            Keys, values, data.extrapolationBefore, data.extrapolationAfter,
+            interpolator, frames, hints, results);
+        for(std::size_t i = 0; i != Containers::arraySize(frames); ++i) {
+            CORRADE_ITERATION(i);
+            std::size_t hint{};
+            CORRADE_COMPARE(results[i], (Animation::interpolate<Float, DualQuaternion>(Keys, values, data.extrapolationBefore, data.extrapolationAfter, interpolator, frames[i], hint)));
+            CORRADE_COMPARE(hints[i], hint);
+        }
+    }
+}
+
 void InterpolationTest::interpolateSingleKeyframe() {
     const auto& data = SingleKeyframeData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -518,6 +626,49 @@ void InterpolationTest::interpolateStrictHint() {
     CORRADE_COMPARE(hint, 2);
 }
 
+void InterpolationTest::interpolateHintLongTrack() {
+    /* Keys are 0.0, 0.5, 1.0 ... 499.5, values are twice the index, so the
+       interpolated value is always four times the frame */
+    Float keys[1000];
+    Float values[1000];
+    for(std::size_t i = 0; i != Containers::arraySize(keys); ++i) {
+        keys[i] = i*0.5f;
+        values[i] = Float(i)*2.0f;
+    }
+
+    /* The hint is preserved across the calls, testing sequential playback,
+       small and large jumps forward and backward and going outside of the
+       range */
+    const struct {
+        Float frame;
+        std::size_t expectedHint;
+    } frames[] {
+        {0.25f, 0},
+        {0.75f, 1},
+        {3.25f, 6},
+        {499.25f, 998},
+        {600.0f, 998},
+        {250.25f, 500},
+        {250.75f, 501},
+        {-1.0f, 0},
+        {123.0f, 246}
+    };
+
+    std::size_t hint{}, hintStrict{};
+    for(std::size_t i = 0; i != Containers::arraySize(frames); ++i) {
+        CORRADE_ITERATION(frames[i].frame);
+        CORRADE_COMPARE((Animation::interpolate<Float, Float>(
+            keys, values, Extrapolation::Extrapolated,
+            Extrapolation::Extrapolated, Math::lerp, frames[i].frame, hint)),
+            frames[i].frame*4.0f);
+        CORRADE_COMPARE(hint, frames[i].expectedHint);
+        CORRADE_COMPARE((Animation::interpolateStrict<Float, Float>(
+            keys, values, Math::lerp, frames[i].frame, hintStrict)),
+            frames[i].frame*4.0f);
+        CORRADE_COMPARE(hintStrict, frames[i].expectedHint);
+    }
+}
+
 using namespace Math::Literals;
 
 const Half HalfValues[]{3.0_h, 1.0_h, 2.5_h, 0.5_h};
@@ -599,6 +750,26 @@ void InterpolationTest::interpolateStrictError() {
         "Animation::interpolateStrict(): keys and values don't have the same size\n");
 }
 
+void InterpolationTest::interpolateIntoError() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Float frames[3]{};
+    std::size_t hints[3]{};
+    Float results[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Animation::interpolateInto<Float, Float, Float>(Keys, nullptr, Extrapolation::Extrapolated, Extrapolation::Extrapolated, Math::lerp, frames, hints, results);
+    Animation::interpolateInto<Float, Float, Float>(Keys, Values, Extrapolation::Extrapolated, Extrapolation::Extrapolated, Math::lerp, frames, Containers::arrayView(hints).prefix(2), results);
+    Animation::interpolateInto<Float, Float, Float>(Keys, Values, Extrapolation::Extrapolated, Extrapolation::Extrapolated, Math::lerp, frames, hints, Containers::arrayView(results).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "Animation::interpolateInto(): keys and values don't have the same size\n"
+        "Animation::interpolateInto(): expected hints and results to have 3 items but got 2 and 3\n"
+        "Animation::interpolateInto(): expected hints and results to have 3 items but got 3 and 2\n");
+}
+
 void InterpolationTest::ease() {
     auto lerpQuadratic = Animation::ease<Float, Math::lerp, Easing::quadraticIn>();
 
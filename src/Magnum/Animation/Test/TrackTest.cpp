@@ -52,6 +52,7 @@ struct TrackTest: TestSuite::Tester {
 
     void at();
     void atStrict();
+    void atInto();
     void atDifferentResultType();
     void atDifferentResultTypeStrict();
 };
@@ -109,7 +110,8 @@ TrackTest::TrackTest() {
               &TrackTest::convertView});
 
     addInstancedTests({&TrackTest::at,
-                       &TrackTest::atStrict}, Containers::arraySize(AtData));
+                       &TrackTest::atStrict,
+                       &TrackTest::atInto}, Containers::arraySize(AtData));
 
     addTests({&TrackTest::atDifferentResultType,
               &TrackTest::atDifferentResultTypeStrict});
@@ -440,6 +442,29 @@ void TrackTest::at() {
     CORRADE_COMPARE(hint, data.expectedHint);
 }
 
+void TrackTest::atInto() {
+    const auto& data = AtData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Track<Float, Float> a{
+        {{0.0f, 3.0f},
+         {2.0f, 1.0f},
+         {4.0f, 2.5f},
+         {5.0f, 0.5f}}, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+
+    /* The result should be the same independently of the initial hint */
+    const Float frames[]{data.time, data.time, data.time};
+    std::size_t hints[]{0, 3, 405780454};
+    Float results[3]{};
+    a.atInto(frames, hints, results);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(results[i], data.expectedValue);
+        CORRADE_COMPARE(hints[i], data.expectedHint);
+    }
+}
+
 void TrackTest::atStrict() {
     const auto& data = AtData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -53,6 +53,7 @@ struct TrackViewTest: TestSuite::Tester {
 
     void at();
     void atStrict();
+    void atInto();
     void atDifferentResultType();
     void atDifferentResultTypeStrict();
 };
@@ -111,7 +112,8 @@ TrackViewTest::TrackViewTest() {
               &TrackViewTest::convertToConstView});
 
     addInstancedTests({&TrackViewTest::at,
-                       &TrackViewTest::atStrict}, Containers::arraySize(AtData));
+                       &TrackViewTest::atStrict,
+                       &TrackViewTest::atInto}, Containers::arraySize(AtData));
 
     addTests({&TrackViewTest::atDifferentResultType,
               &TrackViewTest::atDifferentResultTypeStrict});
@@ -643,6 +645,25 @@ void TrackViewTest::atStrict() {
     CORRADE_COMPARE(hint, data.expectedHint);
 }
 
+void TrackViewTest::atInto() {
+    const auto& data = AtData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const TrackView<const Float, const Float> a{Keyframes, Math::lerp,
+        data.extrapolationBefore, data.extrapolationAfter};
+
+    /* The result should be the same independently of the initial hint */
+    const Float frames[]{data.time, data.time, data.time};
+    std::size_t hints[]{0, 3, 405780454};
+    Float results[3]{};
+    a.atInto(frames, hints, results);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(results[i], data.expectedValue);
+        CORRADE_COMPARE(hints[i], data.expectedHint);
+    }
+}
+
 using namespace Math::Literals;
 
 const Half HalfValues[]{3.0_h, 1.0_h, 2.5_h, 0.5_h};
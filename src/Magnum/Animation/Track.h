@@ -76,9 +76,11 @@ performance. You have the following options:
 @subsection Animation-Track-performance-hint Keyframe hinting
 
 The @ref Track and @ref TrackView classes are fully stateless and the
-@ref at(K) const function performs a linear search for matching keyframe from
-the beginning every time. You can use @ref at(K, std::size_t&) const to
-remember last used keyframe index and pass it in the next iteration as a hint:
+@ref at(K) const function performs a binary search for matching keyframe every
+time. You can use @ref at(K, std::size_t&) const to remember last used
+keyframe index and pass it in the next iteration as a hint. Evaluating the
+track forward is then a constant-time operation and only seeking or wrapping
+around falls back to the @f$ \mathcal{O}(\log n) @f$ search:
 
 @snippet MagnumAnimation.cpp Track-performance-hint
 
@@ -348,8 +350,9 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
-         * time, use @ref at(K, std::size_t&) const to supply a search hint.
+         * information. Note that this function performs a binary search
+         * every time, use @ref at(K, std::size_t&) const to supply a search
+         * hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
          */
@@ -420,6 +423,18 @@ template<class K, class V, class R
             return interpolateStrict(keys(), values(), interpolator, frame, hint);
         }
 
+        /**
+         * @brief Animated values at given times
+         * @m_since_latest
+         *
+         * Calls @ref interpolateInto(), see its documentation for more
+         * information.
+         * @see @ref at(K, std::size_t&) const
+         */
+        void atInto(const Containers::StridedArrayView1D<const K>& frames, const Containers::StridedArrayView1D<std::size_t>& hints, const Containers::StridedArrayView1D<R>& results) const {
+            interpolateInto(keys(), values(), _before, _after, _interpolator, frames, hints, results);
+        }
+
     private:
         Containers::Array<std::pair<K, V>> _data;
         Interpolator _interpolator;
@@ -725,8 +740,9 @@ template<class K, class V, class R
          * @brief Animated value at a given time
          *
          * Calls @ref interpolate(), see its documentation for more
-         * information. Note that this function performs a linear search every
-         * time, use @ref at(K, std::size_t&) const to supply a search hint.
+         * information. Note that this function performs a binary search
+         * every time, use @ref at(K, std::size_t&) const to supply a search
+         * hint.
          * @see @ref atStrict(K, std::size_t&) const,
          *      @ref at(Interpolator, K) const
          */
@@ -796,6 +812,18 @@ template<class K, class V, class R
         R atStrict(Interpolator interpolator, K frame, std::size_t& hint) const {
             return interpolateStrict<typename std::remove_const<K>::type, typename std::remove_const<V>::type, R>(TrackViewStorage<K>::_keys, values(), interpolator, frame, hint);
         }
+
+        /**
+         * @brief Animated values at given times
+         * @m_since_latest
+         *
+         * Calls @ref interpolateInto(), see its documentation for more
+         * information.
+         * @see @ref at(K, std::size_t&) const
+         */
+        void atInto(const Containers::StridedArrayView1D<const typename std::remove_const<K>::type>& frames, const Containers::StridedArrayView1D<std::size_t>& hints, const Containers::StridedArrayView1D<R>& results) const {
+            interpolateInto<typename std::remove_const<K>::type, typename std::remove_const<V>::type, R>(TrackViewStorage<K>::_keys, values(), TrackViewStorage<K>::_before, TrackViewStorage<K>::_after, interpolator(), frames, hints, results);
+        }
 };
 
 }}
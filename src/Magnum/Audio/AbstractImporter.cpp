@@ -25,12 +25,14 @@
 
 #include "AbstractImporter.h"
 
-#include <Corrade/Containers/Array.h>
+#include <cstring>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
+#include "Magnum/Math/Functions.h"
+
 #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
 #include "Magnum/Audio/configure.h"
 #endif
@@ -73,6 +75,15 @@ AbstractImporter::AbstractImporter(PluginManager::Manager<AbstractImporter>& man
 
 AbstractImporter::AbstractImporter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractImporter>{manager, plugin} {}
 
+void AbstractImporter::setFlags(const ImporterFlags flags) {
+    CORRADE_ASSERT(!isOpened(),
+        "Audio::AbstractImporter::setFlags(): can't be set while a file is opened", );
+    _flags = flags;
+    doSetFlags(flags);
+}
+
+void AbstractImporter::doSetFlags(ImporterFlags) {}
+
 bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     CORRADE_ASSERT(features() & ImporterFeature::OpenData,
         "Audio::AbstractImporter::openData(): feature not supported", {});
@@ -101,7 +112,12 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
         return;
     }
 
+    /* The data are alive only while opening, so the importer has to copy
+       them even if ImporterFlag::ZeroCopy is set */
+    const ImporterFlags flags = _flags;
+    _flags &= ~ImporterFlag::ZeroCopy;
     doOpenData(Utility::Directory::read(filename));
+    _flags = flags;
 }
 
 void AbstractImporter::close() {
@@ -109,6 +125,9 @@ void AbstractImporter::close() {
         doClose();
         CORRADE_INTERNAL_ASSERT(!isOpened());
     }
+
+    _fallbackData = nullptr;
+    _fallbackDataDecoded = false;
 }
 
 BufferFormat AbstractImporter::format() const {
@@ -125,10 +144,79 @@ Containers::Array<char> AbstractImporter::data() {
     CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::data(): no file opened", nullptr);
 
     Containers::Array<char> out = doData();
-    CORRADE_ASSERT(!out.deleter(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter", {});
+    CORRADE_ASSERT(!out.deleter() || out.deleter() == Implementation::nonOwnedArrayDeleter, "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter", {});
     return out;
 }
 
+std::size_t AbstractImporter::frameCount() {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::frameCount(): no file opened", {});
+    return doFrameCount();
+}
+
+std::size_t AbstractImporter::doFrameCount() {
+    CORRADE_ASSERT(!(features() & ImporterFeature::Streaming),
+        "Audio::AbstractImporter::frameCount(): feature advertised but not implemented", {});
+
+    decodeFallbackData();
+    return _fallbackData.size()/bufferFormatFrameSize(doFormat());
+}
+
+std::size_t AbstractImporter::readFrames(const std::size_t offset, const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(isOpened(), "Audio::AbstractImporter::readFrames(): no file opened", {});
+    #ifndef CORRADE_NO_ASSERT
+    const UnsignedInt frameSize = bufferFormatFrameSize(doFormat());
+    #endif
+    CORRADE_ASSERT(data.size() % frameSize == 0,
+        "Audio::AbstractImporter::readFrames(): data size" << data.size() << "is not a multiple of frame size" << frameSize, {});
+
+    const std::size_t count = doReadFrames(offset, data);
+    CORRADE_ASSERT(count <= data.size()/frameSize,
+        "Audio::AbstractImporter::readFrames(): implementation reported" << count << "frames read but expected at most" << data.size()/frameSize, {});
+    return count;
+}
+
+std::size_t AbstractImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> data) {
+    CORRADE_ASSERT(!(features() & ImporterFeature::Streaming),
+        "Audio::AbstractImporter::readFrames(): feature advertised but not implemented", {});
+
+    decodeFallbackData();
+    const std::size_t frameSize = bufferFormatFrameSize(doFormat());
+    const std::size_t begin = Math::min(offset*frameSize, _fallbackData.size());
+    const std::size_t size = Math::min(data.size(), _fallbackData.size() - begin);
+    if(size) std::memcpy(data.data(), _fallbackData.data() + begin, size);
+    return size/frameSize;
+}
+
+void AbstractImporter::decodeFallbackData() {
+    if(_fallbackDataDecoded) return;
+
+    _fallbackData = doData();
+    _fallbackDataDecoded = true;
+}
+
+Debug& operator<<(Debug& debug, const ImporterFlag value) {
+    debug << "Audio::ImporterFlag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ImporterFlag::v: return debug << "::" #v;
+        _c(ZeroCopy)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ImporterFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Audio::ImporterFlags{}", {
+        ImporterFlag::ZeroCopy});
+}
+
+namespace Implementation {
+    void nonOwnedArrayDeleter(char*, std::size_t) { /* does nothing */ }
+}
+
 Debug& operator<<(Debug& debug, const ImporterFeature value) {
     debug << "Audio::ImporterFeature" << Debug::nospace;
 
@@ -136,6 +224,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFeature::v: return debug << "::" #v;
         _c(OpenData)
+        _c(Streaming)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -145,7 +234,8 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
 
 Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Audio::ImporterFeatures{}", {
-        ImporterFeature::OpenData});
+        ImporterFeature::OpenData,
+        ImporterFeature::Streaming});
 }
 
 }}
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Audio::AbstractImporter, enum @ref Magnum::Audio::ImporterFeature, enum set @ref Magnum::Audio::ImporterFeatures
  */
 
+#include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -44,7 +45,14 @@ namespace Magnum { namespace Audio {
 */
 enum class ImporterFeature: UnsignedByte {
     /** Opening files from raw data using @ref AbstractImporter::openData() */
-    OpenData = 1 << 0
+    OpenData = 1 << 0,
+
+    /**
+     * Decoding the data in chunks using @ref AbstractImporter::readFrames()
+     * without having to keep the whole decoded data in memory.
+     * @m_since_latest
+     */
+    Streaming = 1 << 1
 };
 
 /**
@@ -63,6 +71,61 @@ MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, ImporterFeature value);
 /** @debugoperatorenum{ImporterFeatures} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, ImporterFeatures value);
 
+/**
+@brief Audio importer flag
+@m_since_latest
+
+@see @ref ImporterFlags, @ref AbstractImporter::setFlags()
+*/
+enum class ImporterFlag: UnsignedByte {
+    /**
+     * Reference the data passed to @ref AbstractImporter::openData() instead
+     * of copying them. By setting this flag the caller guarantees that the
+     * memory stays in scope and unchanged for as long as the importer is
+     * opened *and* as long as any data returned from
+     * @ref AbstractImporter::data() are in use. Importers that support it may
+     * then return a view on the memory instead of a copy. Data that need to be
+     * converted or decoded are still returned as owned copies, importers that
+     * don't support this flag ignore it.
+     *
+     * The flag has no effect for files opened with
+     * @ref AbstractImporter::openFile(), as the file contents are alive only
+     * while the file is being opened. See documentation of particular
+     * importers for information about whether the flag is supported.
+     */
+    ZeroCopy = 1 << 0
+};
+
+/**
+@brief Audio importer flags
+@m_since_latest
+
+@see @ref AbstractImporter::setFlags()
+*/
+typedef Containers::EnumSet<ImporterFlag> ImporterFlags;
+
+CORRADE_ENUMSET_OPERATORS(ImporterFlags)
+
+/**
+@debugoperatorenum{ImporterFlag}
+@m_since_latest
+*/
+MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, ImporterFlag value);
+
+/**
+@debugoperatorenum{ImporterFlags}
+@m_since_latest
+*/
+MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, ImporterFlags value);
+
+namespace Implementation {
+    /* Used by importers to return non-owning views with
+       ImporterFlag::ZeroCopy. Has to live in the library and not in the
+       plugin, otherwise the deleter pointer would dangle after the plugin
+       gets unloaded. */
+    MAGNUM_AUDIO_EXPORT void nonOwnedArrayDeleter(char*, std::size_t);
+}
+
 /**
 @brief Base for audio importer plugins
 
@@ -79,11 +142,44 @@ around in order to have the returned data valid. Moreover, all returned
 deleters --- this is to avoid potential dangling function pointer calls when
 destructing such instances after the plugin module has been unloaded.
 
+The only exception is when @ref ImporterFlag::ZeroCopy is set and the file is
+opened using @ref openData(). Then @ref data() may return a non-owning view
+on the memory passed to @ref openData() instead of a copy, which saves a copy
+and an allocation for example when loading many short sound effects that are
+uploaded to a @ref Buffer right after. The memory then has to stay alive for
+as long as the returned data are in use.
+
+@section Audio-AbstractImporter-streaming Streaming
+
+Besides getting the whole decoded data using @ref data(), it's possible to
+decode them in chunks of a given frame count using @ref readFrames(). This
+is what @ref StreamPlayer uses to play long tracks without having them fully
+decoded in memory. A frame is one sample for each channel, its size in bytes
+is given by @ref bufferFormatFrameSize().
+
+@snippet MagnumAudio.cpp AbstractImporter-streaming
+
+If the importer advertises @ref ImporterFeature::Streaming, the chunks are
+decoded on demand. Otherwise the whole data are decoded via @ref data() on
+the first call and subsequent reads are served from a copy kept until the
+file is closed, so the API can be used with any importer, but without the
+memory savings.
+
 @section Audio-AbstractImporter-subclassing Subclassing
 
 Plugin implements function @ref doFeatures(), @ref doIsOpened(), one of or both
 @ref doOpenData() and @ref doOpenFile() functions, function @ref doClose() and
 data access functions @ref doFormat(), @ref doFrequency() and @ref doData().
+If @ref ImporterFeature::Streaming is supported, the plugin implements also
+@ref doFrameCount() and @ref doReadFrames().
+
+In order to support @ref ImporterFlag::ZeroCopy, the @ref doOpenData()
+implementation should check for presence of the flag and if it's set,
+reference the passed memory instead of copying it. In case @ref doOpenData()
+is called from the default @ref doOpenFile() implementation, the base
+implementation makes the flag appear unset for the duration of the call. The
+non-owning view returned from @ref doData() has to use the
+@cpp Implementation::nonOwnedArrayDeleter @ce deleter.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -156,6 +252,21 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Features supported by this importer */
         ImporterFeatures features() const { return doFeatures(); }
 
+        /**
+         * @brief Importer flags
+         * @m_since_latest
+         */
+        ImporterFlags flags() const { return _flags; }
+
+        /**
+         * @brief Set importer flags
+         * @m_since_latest
+         *
+         * It's expected that this function is called *before* a file is
+         * opened. By default no flags are set.
+         */
+        void setFlags(ImporterFlags flags);
+
         /** @brief Whether any file is opened */
         bool isOpened() const { return doIsOpened(); }
 
@@ -192,6 +303,34 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Sample data */
         Containers::Array<char> data();
 
+        /**
+         * @brief Frame count
+         * @m_since_latest
+         *
+         * Count of frames in the whole file, with one frame containing one
+         * sample for each channel. If @ref ImporterFeature::Streaming is not
+         * supported, the whole data are decoded to calculate the count. See
+         * @ref Audio-AbstractImporter-streaming for more information.
+         */
+        std::size_t frameCount();
+
+        /**
+         * @brief Read a chunk of frames
+         * @param offset    Offset of the first frame to read
+         * @param data      Where to put the frames
+         * @return Count of frames actually read
+         * @m_since_latest
+         *
+         * Decodes at most @cpp data.size()/bufferFormatFrameSize(format()) @ce
+         * frames starting at @p offset into @p data. The size of @p data is
+         * expected to be a multiple of @ref bufferFormatFrameSize() for
+         * @ref format(). The returned count is less than requested when the
+         * end of the data is reached and zero if @p offset is at or past the
+         * end. See @ref Audio-AbstractImporter-streaming for more
+         * information.
+         */
+        std::size_t readFrames(std::size_t offset, Containers::ArrayView<char> data);
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -202,6 +341,17 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref features() */
         virtual ImporterFeatures doFeatures() const = 0;
 
+        /**
+         * @brief Implementation for @ref setFlags()
+         * @m_since_latest
+         *
+         * Useful when the importer needs to modify some internal state on
+         * flag setup. Default implementation does nothing and this
+         * function doesn't need to be implemented --- the flags are available
+         * through @ref flags().
+         */
+        virtual void doSetFlags(ImporterFlags flags);
+
         /** @brief Implementation for @ref isOpened() */
         virtual bool doIsOpened() const = 0;
 
@@ -228,6 +378,35 @@ class MAGNUM_AUDIO_EXPORT AbstractImporter: public PluginManager::AbstractManagi
 
         /** @brief Implementation for @ref data() */
         virtual Containers::Array<char> doData() = 0;
+
+        /**
+         * @brief Implementation for @ref frameCount()
+         * @m_since_latest
+         *
+         * If @ref ImporterFeature::Streaming is not supported, default
+         * implementation decodes the whole data using @ref doData() and
+         * calculates the count from their size.
+         */
+        virtual std::size_t doFrameCount();
+
+        /**
+         * @brief Implementation for @ref readFrames()
+         * @m_since_latest
+         *
+         * Size of @p data is guaranteed to be a multiple of the frame size.
+         * If @ref ImporterFeature::Streaming is not supported, default
+         * implementation decodes the whole data using @ref doData() and
+         * copies the requested range out of them.
+         */
+        virtual std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> data);
+
+        MAGNUM_AUDIO_LOCAL void decodeFallbackData();
+
+        /* Whole decoded data for importers that don't support streaming, so
+           readFrames() doesn't need to decode everything on every call */
+        Containers::Array<char> _fallbackData;
+        bool _fallbackDataDecoded{};
+        ImporterFlags _flags;
 };
 
 }}
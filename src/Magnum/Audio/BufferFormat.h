@@ -190,6 +190,16 @@ enum class BufferFormat: ALenum {
     Surround71Channel32 = AL_FORMAT_71CHN32
 };
 
+/**
+@brief Size of a single frame in given buffer format
+@m_since_latest
+
+Size of one sample in bytes multiplied by the channel count. Useful for
+converting between byte sizes and frame counts when streaming data, see
+@ref AbstractImporter::readFrames().
+*/
+MAGNUM_AUDIO_EXPORT UnsignedInt bufferFormatFrameSize(BufferFormat format);
+
 /** @debugoperatorenum{BufferFormat} */
 MAGNUM_AUDIO_EXPORT Debug& operator<<(Debug& debug, BufferFormat value);
 
@@ -86,7 +86,11 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
 
     /* Add all objects of the Playables in the PlayableGroups to a vector to
        later setClean() */
+    std::size_t objectCount = 1;
+    for(PlayableGroup<dimensions>& group: groups)
+        objectCount += group.size();
     std::vector<std::reference_wrapper<SceneGraph::AbstractObject<dimensions, Float>>> objects;
+    objects.reserve(objectCount);
 
     objects.push_back(this->object());
     for(PlayableGroup<dimensions>& group: groups) {
@@ -95,8 +99,14 @@ template<UnsignedInt dimensions> void Listener<dimensions>::update(std::initiali
         }
     }
 
-    /* Use the more performant way to set multiple objects clean */
+    /* Use the more performant way to set multiple objects clean, which
+       calculates all transformations in a single pass. Suspend the context
+       while the sources get updated so the implementation can apply all
+       changes at once instead of after each of them. */
+    ALCcontext* const context = alcGetCurrentContext();
+    alcSuspendContext(context);
     SceneGraph::AbstractObject<dimensions, Float>::setClean(objects);
+    alcProcessContext(context);
 }
 
 template<UnsignedInt dimensions> Listener<dimensions>& Listener<dimensions>::setGain(const Float gain) {
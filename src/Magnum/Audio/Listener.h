@@ -118,6 +118,12 @@ template<UnsignedInt dimensions> class Listener: public SceneGraph::AbstractFeat
          * transformation changes to spatial audio behavior. Also updates
          * listener-related configuration for @ref Renderer (position,
          * orientation, gain).
+         *
+         * Absolute transformations of all objects are calculated in a single
+         * batch and the current OpenAL context is suspended for the duration
+         * of the update, so the changes are applied at once. Playables that
+         * were marked dirty but whose resulting position and direction didn't
+         * change don't issue any OpenAL calls.
          */
         void update(std::initializer_list<Containers::Reference<PlayableGroup<dimensions>>> groups);
 
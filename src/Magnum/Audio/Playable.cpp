@@ -27,12 +27,13 @@
 #include "Playable.h"
 
 #include "Magnum/Audio/PlayableGroup.h"
+#include "Magnum/Math/Constants.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
 
 namespace Magnum { namespace Audio {
 
-template<UnsignedInt dimensions> Playable<dimensions>::Playable(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& direction, PlayableGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float>(object, group), _direction{direction}, _gain{1.0f} {
+template<UnsignedInt dimensions> Playable<dimensions>::Playable(SceneGraph::AbstractObject<dimensions, Float>& object, const VectorTypeFor<dimensions, Float>& direction, PlayableGroup<dimensions>* group): SceneGraph::AbstractGroupedFeature<dimensions, Playable<dimensions>, Float>(object, group), _direction{direction}, _gain{1.0f}, _sourcePosition{Constants::nan()}, _sourceDirection{Constants::nan()} {
     SceneGraph::AbstractFeature<dimensions, Float>::setCachedTransformations(SceneGraph::CachedTransformation::Absolute);
 }
 
@@ -49,8 +50,19 @@ template<UnsignedInt dimensions> void Playable<dimensions>::clean(const MatrixTy
     if(playables())
         position = playables()->soundTransformation().transformVector(position);
 
-    _source.setPosition(position);
-    _source.setDirection(Vector3::pad(absoluteTransformationMatrix.rotation()*_direction));
+    const Vector3 direction = Vector3::pad(absoluteTransformationMatrix.rotation()*_direction);
+
+    /* The object is dirty also if just some of its parents or the sound
+       transformation changed, in which case the source may still be at the
+       same place. Don't bother OpenAL in that case. */
+    if(position != _sourcePosition) {
+        _source.setPosition(position);
+        _sourcePosition = position;
+    }
+    if(direction != _sourceDirection) {
+        _source.setDirection(direction);
+        _sourceDirection = direction;
+    }
 
     /** @todo velocity */
 }
@@ -53,8 +53,9 @@ updated from a currently active @ref Listener using @ref Listener::update():
 
 Note that @ref Source::setPosition(), @ref Source::setDirection() and
 @ref Source::setGain() called on @ref source() will be overwritten on next call
-to @ref Listener::update() / @ref PlayableGroup::setGain() / @ref setGain() and
-you have to use other means to update them:
+to @ref Listener::update() that sees a changed transformation /
+@ref PlayableGroup::setGain() / @ref setGain() and you have to use other means
+to update them:
 
 -   Transformation of the source is inherited from the scene. If you want to
     transform it, transform the @ref SceneGraph::Object the playable is
@@ -139,6 +140,11 @@ template<UnsignedInt dimensions> class Playable: public SceneGraph::AbstractGrou
         VectorTypeFor<dimensions, Float> _direction;
         Float _gain;
         Source _source;
+
+        /* Last values passed to the source, to avoid redundant AL calls for
+           playables that were marked dirty but didn't actually move. NaN
+           initially so the first clean() always goes through. */
+        Vector3 _sourcePosition, _sourceDirection;
 };
 
 /**
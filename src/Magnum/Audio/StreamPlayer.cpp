@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StreamPlayer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+struct StreamPlayer::State {
+    explicit State(Source& source, AbstractImporter& importer, std::size_t bufferCount, std::size_t framesPerBuffer);
+
+    /* Fills the buffer with next frames, wrapping around if looping. Returns
+       false if there's nothing more to play. */
+    bool fill(Buffer& buffer);
+
+    /* Resets the scratch list to contain all buffers */
+    Containers::ArrayView<Containers::Reference<Buffer>> bufferList();
+
+    /* Unqueues processed buffers, refills and requeues them */
+    void refill();
+
+    /* Background thread main loop */
+    void run();
+
+    Source& source;
+    AbstractImporter& importer;
+    std::size_t framesPerBuffer;
+    Containers::Array<Buffer> buffers;
+    /* Source::unqueueBuffers() reorders the array it gets, so it's given a
+       freshly reset scratch list every time */
+    Containers::Array<Containers::Reference<Buffer>> scratch;
+
+    /* Accessed only by the thread that's currently streaming */
+    BufferFormat format{};
+    UnsignedInt frequency{};
+    UnsignedInt frameSize{};
+    Containers::Array<char> staging;
+    std::size_t position{};
+    std::size_t queuedCount{};
+
+    std::atomic<bool> looping{false};
+    std::atomic<bool> finished{true};
+    std::atomic<std::size_t> underrunCount{0};
+
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopRequested{};
+};
+
+StreamPlayer::State::State(Source& source, AbstractImporter& importer, const std::size_t bufferCount, const std::size_t framesPerBuffer): source(source), importer(importer), framesPerBuffer{framesPerBuffer}, buffers{Containers::DefaultInit, bufferCount}, scratch{Containers::NoInit, bufferCount} {}
+
+bool StreamPlayer::State::fill(Buffer& buffer) {
+    std::size_t count = importer.readFrames(position, staging);
+    if(!count && looping && position) {
+        position = 0;
+        count = importer.readFrames(position, staging);
+    }
+    if(!count) return false;
+
+    position += count;
+    buffer.setData(format, staging.prefix(count*frameSize), frequency);
+    return true;
+}
+
+Containers::ArrayView<Containers::Reference<Buffer>> StreamPlayer::State::bufferList() {
+    for(std::size_t i = 0; i != buffers.size(); ++i)
+        new(&scratch[i]) Containers::Reference<Buffer>{buffers[i]};
+    return scratch;
+}
+
+void StreamPlayer::State::refill() {
+    Containers::ArrayView<Containers::Reference<Buffer>> unqueued = bufferList();
+    const std::size_t processedCount = source.unqueueBuffers(unqueued);
+    std::size_t filledCount = 0;
+    for(; filledCount != processedCount; ++filledCount)
+        if(!fill(unqueued[filledCount])) break;
+    if(filledCount)
+        source.queueBuffers(unqueued.prefix(filledCount));
+
+    queuedCount = queuedCount - processedCount + filledCount;
+    if(!queuedCount) {
+        finished = true;
+        return;
+    }
+
+    /* The source stops when it plays all queued buffers. If that happened
+       before the new ones got queued, it's an underrun and it needs to be
+       restarted. */
+    if(filledCount && source.state() == Source::State::Stopped) {
+        ++underrunCount;
+        source.play();
+    }
+}
+
+void StreamPlayer::State::run() {
+    /* Wake up twice per buffer duration to have enough time to refill
+       before the queue drains */
+    const std::chrono::milliseconds interval(Math::max(framesPerBuffer*500/Math::max(frequency, 1u), std::size_t{1}));
+
+    std::unique_lock<std::mutex> lock{mutex};
+    while(!condition.wait_for(lock, interval, [this]{ return stopRequested; })) {
+        refill();
+        if(finished) break;
+    }
+}
+
+StreamPlayer::StreamPlayer(Source& source, AbstractImporter& importer, const std::size_t bufferCount, const std::size_t framesPerBuffer) {
+    CORRADE_ASSERT(bufferCount >= 2,
+        "Audio::StreamPlayer: expected at least two buffers but got" << bufferCount, );
+    CORRADE_ASSERT(framesPerBuffer,
+        "Audio::StreamPlayer: frame count per buffer can't be zero", );
+    _state.reset(new State{source, importer, bufferCount, framesPerBuffer});
+}
+
+StreamPlayer::~StreamPlayer() {
+    /* The assertions in the constructor might have left the state empty */
+    if(_state) stop();
+}
+
+Source& StreamPlayer::source() { return _state->source; }
+
+AbstractImporter& StreamPlayer::importer() { return _state->importer; }
+
+std::size_t StreamPlayer::bufferCount() const { return _state->buffers.size(); }
+
+std::size_t StreamPlayer::framesPerBuffer() const { return _state->framesPerBuffer; }
+
+bool StreamPlayer::isLooping() const { return _state->looping; }
+
+StreamPlayer& StreamPlayer::setLooping(const bool looping) {
+    _state->looping = looping;
+    return *this;
+}
+
+StreamPlayer& StreamPlayer::play() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.importer.isOpened(),
+        "Audio::StreamPlayer::play(): no file opened", *this);
+
+    stop();
+
+    state.format = state.importer.format();
+    state.frequency = state.importer.frequency();
+    state.frameSize = bufferFormatFrameSize(state.format);
+    if(state.staging.size() != state.framesPerBuffer*state.frameSize)
+        state.staging = Containers::Array<char>{Containers::NoInit, state.framesPerBuffer*state.frameSize};
+    state.position = 0;
+    state.underrunCount = 0;
+
+    /* Fill as many buffers as there is data for. If there's nothing at all,
+       there's nothing to play. */
+    for(state.queuedCount = 0; state.queuedCount != state.buffers.size(); ++state.queuedCount)
+        if(!state.fill(state.buffers[state.queuedCount])) break;
+    if(!state.queuedCount) return *this;
+
+    state.source.queueBuffers(state.bufferList().prefix(state.queuedCount));
+    state.source.play();
+
+    state.finished = false;
+    state.stopRequested = false;
+    state.thread = std::thread{&State::run, &state};
+    return *this;
+}
+
+StreamPlayer& StreamPlayer::stop() {
+    State& state = *_state;
+    if(!state.thread.joinable()) return *this;
+
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        state.stopRequested = true;
+    }
+    state.condition.notify_all();
+    state.thread.join();
+
+    /* Stopping the source marks all queued buffers as processed, so all of
+       them get unqueued */
+    state.source.stop();
+    state.source.unqueueBuffers(state.bufferList());
+    state.queuedCount = 0;
+    state.finished = true;
+    return *this;
+}
+
+bool StreamPlayer::isPlaying() const { return !_state->finished; }
+
+std::size_t StreamPlayer::underrunCount() const { return _state->underrunCount; }
+
+}}
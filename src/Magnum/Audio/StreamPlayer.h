@@ -0,0 +1,179 @@
+#ifndef Magnum_Audio_StreamPlayer_h
+#define Magnum_Audio_StreamPlayer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::StreamPlayer
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Streaming audio player
+@m_since_latest
+
+Plays audio data decoded from an @ref AbstractImporter in chunks through a
+ring of @ref Buffer instances queued on a @ref Source. Compared to putting the
+whole @ref AbstractImporter::data() into a single buffer, only
+@ref bufferCount() times @ref framesPerBuffer() frames are kept in memory at
+a time, which makes a difference for long music and ambience tracks.
+
+@snippet MagnumAudio.cpp StreamPlayer
+
+After @ref play(), a background thread periodically unqueues buffers that
+finished playing, fills them with next frames using
+@ref AbstractImporter::readFrames() and queues them back. If the source runs
+out of queued data before that happens, it's restarted and the event is
+counted in @ref underrunCount() --- in that case increase the buffer count or
+their size. With @ref setLooping() enabled the playback continues from the
+beginning once the end of the data is reached, otherwise the playback stops
+and @ref isPlaying() becomes @cpp false @ce.
+
+The importer is expected to support @ref ImporterFeature::Streaming to get
+the memory savings, otherwise it decodes the whole data on the first read.
+See @ref Audio-AbstractImporter-streaming for more information.
+
+@section Audio-StreamPlayer-threading Thread safety
+
+While playing, the importer is accessed and the buffer queue of the source
+is modified from the background thread. Don't use the importer, don't attach
+or queue buffers on the source and don't call @ref Source::play(),
+@ref Source::stop() or @ref Source::rewind() on it until @ref stop() is
+called or the player is destroyed. Changing other source properties such as
+gain or position from the main thread is fine.
+*/
+class MAGNUM_AUDIO_EXPORT StreamPlayer {
+    public:
+        /**
+         * @brief Constructor
+         * @param source            Source to play on
+         * @param importer          Importer to decode the data from
+         * @param bufferCount       Count of buffers in the ring. Expected to
+         *      be at least @cpp 2 @ce.
+         * @param framesPerBuffer   Count of frames in each buffer. Expected to
+         *      be non-zero.
+         *
+         * Creates @p bufferCount OpenAL buffers. Both the @p source and the
+         * @p importer are expected to stay alive for the whole player
+         * lifetime. The importer doesn't need to have a file opened at this
+         * point, it's only needed in @ref play().
+         */
+        explicit StreamPlayer(Source& source, AbstractImporter& importer, std::size_t bufferCount = 4, std::size_t framesPerBuffer = 16384);
+
+        /** @brief Copying is not allowed */
+        StreamPlayer(const StreamPlayer&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamPlayer(StreamPlayer&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref stop().
+         */
+        ~StreamPlayer();
+
+        /** @brief Copying is not allowed */
+        StreamPlayer& operator=(const StreamPlayer&) = delete;
+
+        /** @brief Moving is not allowed */
+        StreamPlayer& operator=(StreamPlayer&&) = delete;
+
+        /** @brief Source the player plays on */
+        Source& source();
+
+        /** @brief Importer the player decodes data from */
+        AbstractImporter& importer();
+
+        /** @brief Count of buffers in the ring */
+        std::size_t bufferCount() const;
+
+        /** @brief Count of frames in each buffer */
+        std::size_t framesPerBuffer() const;
+
+        /** @brief Whether the playback is looped */
+        bool isLooping() const;
+
+        /**
+         * @brief Set whether the playback is looped
+         * @return Reference to self (for method chaining)
+         *
+         * Can be changed also during the playback. Default is
+         * @cpp false @ce.
+         */
+        StreamPlayer& setLooping(bool looping);
+
+        /**
+         * @brief Play
+         * @return Reference to self (for method chaining)
+         *
+         * Calls @ref stop() if already playing, fills all buffers with data
+         * from the beginning of the file, queues them on the source, starts
+         * playing it and spawns the background thread refilling the buffers.
+         * Expects that the importer has a file opened.
+         */
+        StreamPlayer& play();
+
+        /**
+         * @brief Stop
+         * @return Reference to self (for method chaining)
+         *
+         * Stops the background thread and the source and unqueues all
+         * buffers from it. Does nothing if not playing.
+         */
+        StreamPlayer& stop();
+
+        /**
+         * @brief Whether the player is playing
+         *
+         * Returns @cpp true @ce after @ref play() until either @ref stop() is
+         * called or all data were played with looping disabled.
+         */
+        bool isPlaying() const;
+
+        /**
+         * @brief Count of buffer underruns
+         *
+         * Count of cases where the source ran out of queued data and had to
+         * be restarted since the last @ref play().
+         */
+        std::size_t underrunCount() const;
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
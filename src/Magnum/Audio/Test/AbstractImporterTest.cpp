@@ -42,9 +42,13 @@ struct AbstractImporterTest: TestSuite::Tester {
 
     void construct();
 
+    void setFlags();
+    void setFlagsFileOpened();
+
     void openData();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openFileAsDataZeroCopy();
 
     void openFileNotImplemented();
     void openDataNotSupported();
@@ -62,17 +66,36 @@ struct AbstractImporterTest: TestSuite::Tester {
     void data();
     void dataNoFile();
     void dataCustomDeleter();
+    void dataNonOwned();
+
+    void frameCount();
+    void frameCountFallback();
+    void frameCountNoFile();
+    void frameCountNotImplemented();
+
+    void readFrames();
+    void readFramesFallback();
+    void readFramesNoFile();
+    void readFramesNotImplemented();
+    void readFramesInvalidSize();
+    void readFramesTooMany();
 
     void debugFeature();
     void debugFeatures();
+    void debugFlag();
+    void debugFlags();
 };
 
 AbstractImporterTest::AbstractImporterTest() {
     addTests({&AbstractImporterTest::construct,
 
+              &AbstractImporterTest::setFlags,
+              &AbstractImporterTest::setFlagsFileOpened,
+
               &AbstractImporterTest::openData,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openFileAsDataZeroCopy,
 
               &AbstractImporterTest::openFileNotImplemented,
               &AbstractImporterTest::openDataNotSupported,
@@ -87,9 +110,24 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::data,
               &AbstractImporterTest::dataNoFile,
               &AbstractImporterTest::dataCustomDeleter,
+              &AbstractImporterTest::dataNonOwned,
+
+              &AbstractImporterTest::frameCount,
+              &AbstractImporterTest::frameCountFallback,
+              &AbstractImporterTest::frameCountNoFile,
+              &AbstractImporterTest::frameCountNotImplemented,
+
+              &AbstractImporterTest::readFrames,
+              &AbstractImporterTest::readFramesFallback,
+              &AbstractImporterTest::readFramesNoFile,
+              &AbstractImporterTest::readFramesNotImplemented,
+              &AbstractImporterTest::readFramesInvalidSize,
+              &AbstractImporterTest::readFramesTooMany,
 
               &AbstractImporterTest::debugFeature,
-              &AbstractImporterTest::debugFeatures});
+              &AbstractImporterTest::debugFeatures,
+              &AbstractImporterTest::debugFlag,
+              &AbstractImporterTest::debugFlags});
 }
 
 void AbstractImporterTest::construct() {
@@ -110,6 +148,50 @@ void AbstractImporterTest::construct() {
     CORRADE_VERIFY(!importer.isOpened());
 }
 
+void AbstractImporterTest::setFlags() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+        void doSetFlags(ImporterFlags flags) override {
+            _flags = flags;
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        ImporterFlags _flags;
+    } importer;
+    CORRADE_COMPARE(importer.flags(), ImporterFlags{});
+    CORRADE_COMPARE(importer._flags, ImporterFlags{});
+
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_COMPARE(importer.flags(), ImporterFlag::ZeroCopy);
+    CORRADE_COMPARE(importer._flags, ImporterFlag::ZeroCopy);
+}
+
+void AbstractImporterTest::setFlagsFileOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::setFlags(): can't be set while a file is opened\n");
+}
+
 void AbstractImporterTest::openData() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
@@ -187,6 +269,32 @@ void AbstractImporterTest::openFileAsDataNotFound() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::openFile(): cannot open file nonexistent.bin\n");
 }
 
+void AbstractImporterTest::openFileAsDataZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char>) override {
+            /* The file data are temporary, so the importer shouldn't see the
+               flag */
+            _opened = !(flags() & ImporterFlag::ZeroCopy);
+        }
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+
+        bool _opened = false;
+    } importer;
+
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(AUDIO_TEST_DIR, "file.bin")));
+
+    /* The flag is restored after */
+    CORRADE_COMPARE(importer.flags(), ImporterFlag::ZeroCopy);
+}
+
 void AbstractImporterTest::openFileNotImplemented() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -389,6 +497,264 @@ void AbstractImporterTest::dataCustomDeleter() {
     CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::data(): implementation is not allowed to use a custom Array deleter\n");
 }
 
+void AbstractImporterTest::dataNonOwned() {
+    char data[]{'H', 'e'};
+    struct Importer: AbstractImporter {
+        explicit Importer(char* data): _data{data} {}
+
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            return Containers::Array<char>{_data, 2, Implementation::nonOwnedArrayDeleter};
+        }
+
+        char* _data;
+    } importer{data};
+
+    /* No assertion should fire */
+    Containers::Array<char> out = importer.data();
+    CORRADE_COMPARE(out.data(), static_cast<void*>(data));
+    CORRADE_COMPARE(out.size(), 2);
+}
+
+void AbstractImporterTest::frameCount() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        std::size_t doFrameCount() override { return 1337; }
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 1337);
+}
+
+void AbstractImporterTest::frameCountFallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            ++dataCalled;
+            return Containers::Array<char>{Containers::ValueInit, 12};
+        }
+
+        Int dataCalled = 0;
+    } importer;
+
+    CORRADE_COMPARE(importer.frameCount(), 3);
+    CORRADE_COMPARE(importer.frameCount(), 3);
+
+    /* The data are decoded just once */
+    CORRADE_COMPARE(importer.dataCalled, 1);
+}
+
+void AbstractImporterTest::frameCountNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.frameCount();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::frameCount(): no file opened\n");
+}
+
+void AbstractImporterTest::frameCountNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.frameCount();
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::frameCount(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::readFrames() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> data) override {
+            data[0] = char('A' + offset);
+            return data.size()/2 - 1;
+        }
+    } importer;
+
+    char out[6]{};
+    CORRADE_COMPARE(importer.readFrames(2, out), 2);
+    CORRADE_COMPARE(out[0], 'C');
+}
+
+void AbstractImporterTest::readFramesFallback() {
+    struct Importer: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override {
+            ++dataCalled;
+            return Containers::Array<char>{Containers::InPlaceInit, {'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'}};
+        }
+
+        bool _opened = true;
+        Int dataCalled = 0;
+    } importer;
+
+    char out[4]{};
+    CORRADE_COMPARE(importer.readFrames(1, out), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<char>({'c', 'd', 'e', 'f'}), TestSuite::Compare::Container);
+
+    /* Partial read at the end */
+    CORRADE_COMPARE(importer.readFrames(3, out), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(2), Containers::arrayView<char>({'g', 'h'}), TestSuite::Compare::Container);
+
+    /* Past the end */
+    CORRADE_COMPARE(importer.readFrames(4, out), 0);
+    CORRADE_COMPARE(importer.readFrames(100, out), 0);
+
+    /* The data are decoded just once while the file is opened */
+    CORRADE_COMPARE(importer.dataCalled, 1);
+
+    /* Closing discards the cached data */
+    importer.close();
+    importer._opened = true;
+    CORRADE_COMPARE(importer.readFrames(0, out), 2);
+    CORRADE_COMPARE(importer.dataCalled, 2);
+}
+
+void AbstractImporterTest::readFramesNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return {}; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.readFrames(0, nullptr);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): no file opened\n");
+}
+
+void AbstractImporterTest::readFramesNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[4];
+    importer.readFrames(0, data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): feature advertised but not implemented\n");
+}
+
+void AbstractImporterTest::readFramesInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        std::size_t doReadFrames(std::size_t, Containers::ArrayView<char>) override { return {}; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[6];
+    importer.readFrames(0, data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): data size 6 is not a multiple of frame size 4\n");
+}
+
+void AbstractImporterTest::readFramesTooMany() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        BufferFormat doFormat() const override { return BufferFormat::Stereo16; }
+        UnsignedInt doFrequency() const override { return {}; }
+        Containers::Array<char> doData() override { return nullptr; }
+        std::size_t doReadFrames(std::size_t, Containers::ArrayView<char>) override { return 3; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    char data[8];
+    importer.readFrames(0, data);
+    CORRADE_COMPARE(out.str(), "Audio::AbstractImporter::readFrames(): implementation reported 3 frames read but expected at most 2\n");
+}
+
 void AbstractImporterTest::debugFeature() {
     std::ostringstream out;
 
@@ -403,6 +769,20 @@ void AbstractImporterTest::debugFeatures() {
     CORRADE_COMPARE(out.str(), "Audio::ImporterFeature::OpenData Audio::ImporterFeatures{}\n");
 }
 
+void AbstractImporterTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << ImporterFlag::ZeroCopy << ImporterFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "Audio::ImporterFlag::ZeroCopy Audio::ImporterFlag(0xf0)\n");
+}
+
+void AbstractImporterTest::debugFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << ImporterFlag::ZeroCopy << ImporterFlags{};
+    CORRADE_COMPARE(out.str(), "Audio::ImporterFlag::ZeroCopy Audio::ImporterFlags{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::AbstractImporterTest)
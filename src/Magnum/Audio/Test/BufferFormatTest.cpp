@@ -34,11 +34,24 @@ namespace Magnum { namespace Audio { namespace Test { namespace {
 struct BufferFormatTest: TestSuite::Tester {
     explicit BufferFormatTest();
 
+    void frameSize();
+
     void debugFormat();
 };
 
 BufferFormatTest::BufferFormatTest() {
-    addTests({&BufferFormatTest::debugFormat});
+    addTests({&BufferFormatTest::frameSize,
+
+              &BufferFormatTest::debugFormat});
+}
+
+void BufferFormatTest::frameSize() {
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Mono8), 1);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::StereoMuLaw), 2);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Stereo16), 4);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::StereoDouble), 16);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Surround61Channel16), 14);
+    CORRADE_COMPARE(bufferFormatFrameSize(BufferFormat::Surround71Channel32), 32);
 }
 
 void BufferFormatTest::debugFormat() {
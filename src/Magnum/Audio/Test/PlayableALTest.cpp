@@ -42,6 +42,7 @@ struct PlayableALTest: TestSuite::Tester {
     explicit PlayableALTest();
 
     void feature();
+    void featureUnchangedTransformation();
     void group();
 
     Context _context;
@@ -52,6 +53,7 @@ PlayableALTest::PlayableALTest():
     _context{arguments().first, arguments().second}
 {
     addTests({&PlayableALTest::feature,
+              &PlayableALTest::featureUnchangedTransformation,
               &PlayableALTest::group});
 }
 
@@ -68,6 +70,29 @@ void PlayableALTest::feature() {
     CORRADE_COMPARE(playable.source().position(), offset);
 }
 
+void PlayableALTest::featureUnchangedTransformation() {
+    Scene3D scene;
+    Object3D object{&scene};
+    Playable3D playable{object};
+
+    constexpr Vector3 offset{1.0f, 2.0f, 3.0f};
+    object.translate(offset);
+    object.setClean();
+    CORRADE_COMPARE(playable.source().position(), offset);
+
+    /* Marking the object dirty without changing the resulting position
+       shouldn't touch the source */
+    playable.source().setPosition({4.0f, 5.0f, 6.0f});
+    object.setDirty();
+    object.setClean();
+    CORRADE_COMPARE(playable.source().position(), (Vector3{4.0f, 5.0f, 6.0f}));
+
+    /* But an actual change should */
+    object.translate(offset);
+    object.setClean();
+    CORRADE_COMPARE(playable.source().position(), offset*2.0f);
+}
+
 void PlayableALTest::group() {
     Scene3D scene;
     Object3D object{&scene};
@@ -0,0 +1,197 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/StreamPlayer.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct StreamPlayerALTest: TestSuite::Tester {
+    explicit StreamPlayerALTest();
+
+    void construct();
+
+    void play();
+    void playEmpty();
+    void playLooping();
+    void stop();
+
+    Context _context;
+};
+
+StreamPlayerALTest::StreamPlayerALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&StreamPlayerALTest::construct,
+
+              &StreamPlayerALTest::play,
+              &StreamPlayerALTest::playEmpty,
+              &StreamPlayerALTest::playLooping,
+              &StreamPlayerALTest::stop});
+}
+
+/* Generates a sawtooth and remembers what was read, the reads happen on the
+   player thread but the test reads the counters only after the player has
+   stopped */
+struct Importer: AbstractImporter {
+    explicit Importer(std::size_t frameCount): _frameCount{frameCount} {}
+
+    ImporterFeatures doFeatures() const override { return ImporterFeature::Streaming; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    BufferFormat doFormat() const override { return BufferFormat::Mono8; }
+    UnsignedInt doFrequency() const override { return 22050; }
+    Containers::Array<char> doData() override { return nullptr; }
+    std::size_t doFrameCount() override { return _frameCount; }
+    std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> data) override {
+        if(offset >= _frameCount) return 0;
+        if(!offset) ++readFromBeginning;
+
+        const std::size_t count = Math::min(data.size(), _frameCount - offset);
+        for(std::size_t i = 0; i != count; ++i)
+            data[i] = char(offset + i);
+        framesRead += count;
+        return count;
+    }
+
+    std::size_t _frameCount;
+    std::atomic<std::size_t> framesRead{0};
+    std::atomic<Int> readFromBeginning{0};
+};
+
+/* Waits until given condition is true, at most a few seconds */
+template<class F> bool waitFor(F condition) {
+    for(Int i = 0; i != 500; ++i) {
+        if(condition()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    return false;
+}
+
+ALint queuedBufferCount(const Source& source) {
+    ALint count;
+    alGetSourcei(source.id(), AL_BUFFERS_QUEUED, &count);
+    return count;
+}
+
+void StreamPlayerALTest::construct() {
+    Source source;
+    Importer importer{1000};
+    StreamPlayer player{source, importer, 3, 256};
+
+    CORRADE_COMPARE(&player.source(), &source);
+    CORRADE_COMPARE(&player.importer(), &importer);
+    CORRADE_COMPARE(player.bufferCount(), 3);
+    CORRADE_COMPARE(player.framesPerBuffer(), 256);
+    CORRADE_VERIFY(!player.isLooping());
+    CORRADE_VERIFY(!player.isPlaying());
+    CORRADE_COMPARE(player.underrunCount(), 0);
+}
+
+void StreamPlayerALTest::play() {
+    Source source;
+    /* About a third of a second, more than what fits into the buffers */
+    Importer importer{7777};
+    StreamPlayer player{source, importer, 3, 1024};
+
+    player.play();
+    CORRADE_VERIFY(player.isPlaying());
+    CORRADE_COMPARE(source.state(), Source::State::Playing);
+    CORRADE_COMPARE(queuedBufferCount(source), 3);
+
+    /* Everything gets played and the source stops by itself */
+    CORRADE_VERIFY(waitFor([&player]{ return !player.isPlaying(); }));
+    CORRADE_COMPARE(source.state(), Source::State::Stopped);
+    CORRADE_COMPARE(importer.framesRead, 7777);
+    CORRADE_COMPARE(importer.readFromBeginning, 1);
+
+    player.stop();
+    CORRADE_COMPARE(queuedBufferCount(source), 0);
+}
+
+void StreamPlayerALTest::playEmpty() {
+    Source source;
+    Importer importer{0};
+    StreamPlayer player{source, importer, 3, 1024};
+
+    player.play();
+    CORRADE_VERIFY(!player.isPlaying());
+    CORRADE_COMPARE(queuedBufferCount(source), 0);
+}
+
+void StreamPlayerALTest::playLooping() {
+    Source source;
+    /* Shorter than what fits into the buffers, so it wraps around right
+       away */
+    Importer importer{1500};
+    StreamPlayer player{source, importer, 3, 1024};
+    player.setLooping(true);
+    CORRADE_VERIFY(player.isLooping());
+
+    player.play();
+    CORRADE_VERIFY(waitFor([&importer]{ return importer.readFromBeginning >= 4; }));
+    CORRADE_VERIFY(player.isPlaying());
+
+    player.stop();
+    CORRADE_VERIFY(!player.isPlaying());
+    CORRADE_COMPARE(source.state(), Source::State::Stopped);
+    CORRADE_COMPARE(queuedBufferCount(source), 0);
+}
+
+void StreamPlayerALTest::stop() {
+    Source source;
+    /* Way longer than the test runs */
+    Importer importer{22050*60};
+    StreamPlayer player{source, importer, 4, 1024};
+
+    player.play();
+    CORRADE_VERIFY(player.isPlaying());
+    CORRADE_COMPARE(queuedBufferCount(source), 4);
+
+    player.stop();
+    CORRADE_VERIFY(!player.isPlaying());
+    CORRADE_COMPARE(source.state(), Source::State::Stopped);
+    CORRADE_COMPARE(queuedBufferCount(source), 0);
+
+    /* Playing again starts from the beginning */
+    player.play();
+    CORRADE_VERIFY(player.isPlaying());
+    CORRADE_COMPARE(importer.readFromBeginning, 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::StreamPlayerALTest)
@@ -0,0 +1,287 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Audio/Context.h"
+#include "Magnum/Audio/Source.h"
+#include "Magnum/Audio/VoicePool.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+struct VoicePoolALTest: TestSuite::Tester {
+    explicit VoicePoolALTest();
+
+    void construct();
+
+    void addRemoveEmitter();
+    void properties();
+
+    void assignMostAudible();
+    void reassign();
+    void virtualTimeAdvances();
+    void finishNotLooping();
+    void stop();
+
+    Context _context;
+};
+
+VoicePoolALTest::VoicePoolALTest():
+    TestSuite::Tester{TestSuite::Tester::TesterConfiguration{}.setSkippedArgumentPrefixes({"magnum"})},
+    _context{arguments().first, arguments().second}
+{
+    addTests({&VoicePoolALTest::construct,
+
+              &VoicePoolALTest::addRemoveEmitter,
+              &VoicePoolALTest::properties,
+
+              &VoicePoolALTest::assignMostAudible,
+              &VoicePoolALTest::reassign,
+              &VoicePoolALTest::virtualTimeAdvances,
+              &VoicePoolALTest::finishNotLooping,
+              &VoicePoolALTest::stop});
+}
+
+/* One second of silence */
+Buffer buffer() {
+    Containers::Array<char> data{Containers::ValueInit, 22050};
+    Buffer buffer;
+    buffer.setData(BufferFormat::Mono8, data, 22050);
+    return buffer;
+}
+
+void VoicePoolALTest::construct() {
+    VoicePool pool{4};
+    CORRADE_COMPARE(pool.voiceCount(), 4);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+    CORRADE_COMPARE(pool.emitterCount(), 0);
+    CORRADE_COMPARE(pool.referenceDistance(), 1.0f);
+    CORRADE_COMPARE(pool.rolloffFactor(), 1.0f);
+}
+
+void VoicePoolALTest::addRemoveEmitter() {
+    Buffer data = buffer();
+    VoicePool pool{2};
+
+    UnsignedInt a = pool.addEmitter(data);
+    UnsignedInt b = pool.addEmitter(data);
+    UnsignedInt c = pool.addEmitter(data);
+    CORRADE_COMPARE(a, 0);
+    CORRADE_COMPARE(b, 1);
+    CORRADE_COMPARE(c, 2);
+    CORRADE_COMPARE(pool.emitterCount(), 3);
+
+    pool.play(b)
+        .update({}, 0.0f);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 1);
+
+    /* Removing frees the voice and the ID gets reused */
+    pool.removeEmitter(b);
+    CORRADE_COMPARE(pool.emitterCount(), 2);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+    CORRADE_COMPARE(pool.addEmitter(data), 1);
+    CORRADE_COMPARE(pool.emitterCount(), 3);
+
+    /* The reused emitter is reset to defaults */
+    CORRADE_VERIFY(!pool.isPlaying(1));
+}
+
+void VoicePoolALTest::properties() {
+    Buffer data = buffer();
+    VoicePool pool{2};
+    pool.setReferenceDistance(2.0f)
+        .setRolloffFactor(0.5f);
+    CORRADE_COMPARE(pool.referenceDistance(), 2.0f);
+    CORRADE_COMPARE(pool.rolloffFactor(), 0.5f);
+
+    UnsignedInt id = pool.addEmitter(data);
+    CORRADE_COMPARE(pool.position(id), Vector3{});
+    CORRADE_COMPARE(pool.gain(id), 1.0f);
+    CORRADE_VERIFY(!pool.isLooping(id));
+    CORRADE_VERIFY(!pool.isPlaying(id));
+    CORRADE_COMPARE(pool.offsetInSeconds(id), 0.0f);
+    CORRADE_VERIFY(!pool.source(id));
+
+    pool.setPosition(id, {1.0f, 2.0f, 3.0f})
+        .setGain(id, 0.25f)
+        .setLooping(id, true)
+        .play(id);
+    CORRADE_COMPARE(pool.position(id), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(pool.gain(id), 0.25f);
+    CORRADE_VERIFY(pool.isLooping(id));
+    CORRADE_VERIFY(pool.isPlaying(id));
+
+    /* The voice gets all properties */
+    pool.update({}, 0.0f);
+    Source* source = pool.source(id);
+    CORRADE_VERIFY(source);
+    CORRADE_COMPARE(source->position(), (Vector3{1.0f, 2.0f, 3.0f}));
+    CORRADE_COMPARE(source->gain(), 0.25f);
+    CORRADE_VERIFY(source->isLooping());
+    CORRADE_COMPARE(source->referenceDistance(), 2.0f);
+    CORRADE_COMPARE(source->rolloffFactor(), 0.5f);
+
+    /* Changes are propagated directly to an assigned voice */
+    pool.setPosition(id, {3.0f, 2.0f, 1.0f})
+        .setGain(id, 0.5f);
+    CORRADE_COMPARE(source->position(), (Vector3{3.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE(source->gain(), 0.5f);
+}
+
+void VoicePoolALTest::assignMostAudible() {
+    Buffer data = buffer();
+    VoicePool pool{2};
+
+    /* Nearest, farthest, loud but far, quiet but near */
+    UnsignedInt nearest = pool.addEmitter(data);
+    UnsignedInt farthest = pool.addEmitter(data);
+    UnsignedInt loud = pool.addEmitter(data);
+    UnsignedInt quiet = pool.addEmitter(data);
+    pool.setPosition(nearest, {1.0f, 0.0f, 0.0f})
+        .setPosition(farthest, {100.0f, 0.0f, 0.0f})
+        .setPosition(loud, {10.0f, 0.0f, 0.0f})
+        .setGain(loud, 10.0f)
+        .setPosition(quiet, {2.0f, 0.0f, 0.0f})
+        .setGain(quiet, 0.01f);
+    for(UnsignedInt id: {nearest, farthest, loud, quiet}) pool.play(id);
+
+    /* Nothing is assigned before an update */
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+
+    pool.update({}, 0.0f);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 2);
+    CORRADE_VERIFY(pool.source(nearest));
+    CORRADE_VERIFY(pool.source(loud));
+    CORRADE_VERIFY(!pool.source(farthest));
+    CORRADE_VERIFY(!pool.source(quiet));
+
+    /* Virtual emitters are still playing */
+    CORRADE_VERIFY(pool.isPlaying(farthest));
+    CORRADE_VERIFY(pool.isPlaying(quiet));
+}
+
+void VoicePoolALTest::reassign() {
+    Buffer data = buffer();
+    VoicePool pool{1};
+
+    UnsignedInt a = pool.addEmitter(data);
+    UnsignedInt b = pool.addEmitter(data);
+    pool.setLooping(a, true)
+        .setLooping(b, true)
+        .setPosition(a, {1.0f, 0.0f, 0.0f})
+        .setPosition(b, {10.0f, 0.0f, 0.0f})
+        .play(a)
+        .play(b);
+
+    pool.update({}, 0.0f);
+    Source* source = pool.source(a);
+    CORRADE_VERIFY(source);
+    CORRADE_VERIFY(!pool.source(b));
+
+    /* Keeping the voice doesn't restart it */
+    pool.update({}, 0.0f);
+    CORRADE_COMPARE(pool.source(a), source);
+
+    /* Listener moves to the other emitter, the voice is taken over */
+    pool.update({10.0f, 0.0f, 0.0f}, 0.0f);
+    CORRADE_VERIFY(!pool.source(a));
+    CORRADE_COMPARE(pool.source(b), source);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 1);
+    CORRADE_COMPARE(source->position(), (Vector3{10.0f, 0.0f, 0.0f}));
+}
+
+void VoicePoolALTest::virtualTimeAdvances() {
+    Buffer data = buffer();
+    VoicePool pool{1};
+
+    UnsignedInt a = pool.addEmitter(data);
+    UnsignedInt b = pool.addEmitter(data);
+    pool.setLooping(b, true)
+        .setPosition(b, {10.0f, 0.0f, 0.0f})
+        .play(a)
+        .play(b);
+
+    pool.update({}, 0.25f);
+    CORRADE_VERIFY(!pool.source(b));
+    CORRADE_COMPARE(pool.offsetInSeconds(b), 0.25f);
+
+    /* Looping wraps the offset around */
+    pool.update({}, 0.5f);
+    pool.update({}, 0.5f);
+    CORRADE_VERIFY(pool.isPlaying(b));
+    CORRADE_COMPARE(pool.offsetInSeconds(b), 0.25f);
+
+    /* The first one finished in the meantime, so the voice goes to the
+       second, continuing from its offset */
+    CORRADE_VERIFY(!pool.isPlaying(a));
+    Source* source = pool.source(b);
+    CORRADE_VERIFY(source);
+    CORRADE_COMPARE_AS(source->offsetInSeconds(), 0.2f,
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void VoicePoolALTest::finishNotLooping() {
+    Buffer data = buffer();
+    VoicePool pool{2};
+
+    UnsignedInt id = pool.addEmitter(data);
+    pool.play(id)
+        .update({}, 0.5f);
+    CORRADE_VERIFY(pool.isPlaying(id));
+    CORRADE_COMPARE(pool.usedVoiceCount(), 1);
+
+    pool.update({}, 0.75f);
+    CORRADE_VERIFY(!pool.isPlaying(id));
+    CORRADE_COMPARE(pool.offsetInSeconds(id), 0.0f);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+}
+
+void VoicePoolALTest::stop() {
+    Buffer data = buffer();
+    VoicePool pool{2};
+
+    UnsignedInt id = pool.addEmitter(data);
+    pool.setLooping(id, true)
+        .play(id)
+        .update({}, 0.5f);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 1);
+
+    pool.stop(id);
+    CORRADE_VERIFY(!pool.isPlaying(id));
+    CORRADE_VERIFY(!pool.source(id));
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+
+    /* Stopped emitters don't get a voice */
+    pool.update({}, 0.5f);
+    CORRADE_COMPARE(pool.usedVoiceCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::VoicePoolALTest)
@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "VoicePool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Audio/Buffer.h"
+#include "Magnum/Audio/Source.h"
+
+namespace Magnum { namespace Audio {
+
+namespace {
+
+struct Emitter {
+    Buffer* buffer;
+    Vector3 position;
+    Float gain;
+    Float duration;
+    Float offset;
+    /* Index into voices, -1 if none */
+    Int voice;
+    bool alive;
+    bool looping;
+    bool playing;
+};
+
+}
+
+struct VoicePool::State {
+    Containers::Array<Source> voices;
+    /* Emitter ID for each voice, -1 if free */
+    Containers::Array<Int> voiceEmitters;
+    Containers::Array<Emitter> emitters;
+    /* IDs of removed emitters available for reuse */
+    Containers::Array<UnsignedInt> freeEmitters;
+    /* Scratch space for sorting by audibility, reused between updates */
+    Containers::Array<std::pair<Float, UnsignedInt>> audible;
+    Containers::Array<bool> chosen;
+
+    Float referenceDistance{1.0f};
+    Float rolloffFactor{1.0f};
+    UnsignedInt usedVoiceCount{};
+
+    void releaseVoice(Emitter& emitter);
+};
+
+void VoicePool::State::releaseVoice(Emitter& emitter) {
+    if(emitter.voice == -1) return;
+
+    voices[emitter.voice].stop()
+        .setBuffer(nullptr);
+    voiceEmitters[emitter.voice] = -1;
+    emitter.voice = -1;
+    --usedVoiceCount;
+}
+
+VoicePool::VoicePool(const UnsignedInt voiceCount): _state{new State} {
+    CORRADE_ASSERT(voiceCount,
+        "Audio::VoicePool: expected a non-zero voice count", );
+
+    _state->voices = Containers::Array<Source>{Containers::DefaultInit, voiceCount};
+    _state->voiceEmitters = Containers::Array<Int>{Containers::DirectInit, voiceCount, -1};
+}
+
+VoicePool::~VoicePool() = default;
+
+UnsignedInt VoicePool::voiceCount() const { return _state->voices.size(); }
+
+UnsignedInt VoicePool::usedVoiceCount() const { return _state->usedVoiceCount; }
+
+UnsignedInt VoicePool::emitterCount() const {
+    return _state->emitters.size() - _state->freeEmitters.size();
+}
+
+Float VoicePool::referenceDistance() const { return _state->referenceDistance; }
+
+VoicePool& VoicePool::setReferenceDistance(const Float distance) {
+    _state->referenceDistance = distance;
+    for(Source& voice: _state->voices) voice.setReferenceDistance(distance);
+    return *this;
+}
+
+Float VoicePool::rolloffFactor() const { return _state->rolloffFactor; }
+
+VoicePool& VoicePool::setRolloffFactor(const Float factor) {
+    _state->rolloffFactor = factor;
+    for(Source& voice: _state->voices) voice.setRolloffFactor(factor);
+    return *this;
+}
+
+UnsignedInt VoicePool::addEmitter(Buffer& buffer) {
+    const Int frequency = buffer.frequency();
+    const Emitter emitter{&buffer, {}, 1.0f,
+        frequency ? Float(buffer.sampleCount())/frequency : 0.0f,
+        0.0f, -1, true, false, false};
+
+    if(!_state->freeEmitters.empty()) {
+        const UnsignedInt id = _state->freeEmitters.back();
+        arrayResize(_state->freeEmitters, _state->freeEmitters.size() - 1);
+        _state->emitters[id] = emitter;
+        return id;
+    }
+
+    arrayAppend(_state->emitters, emitter);
+    return _state->emitters.size() - 1;
+}
+
+void VoicePool::removeEmitter(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::removeEmitter(): invalid emitter" << id, );
+
+    Emitter& emitter = _state->emitters[id];
+    _state->releaseVoice(emitter);
+    emitter.alive = false;
+    emitter.playing = false;
+    emitter.buffer = nullptr;
+    arrayAppend(_state->freeEmitters, id);
+}
+
+Vector3 VoicePool::position(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::position(): invalid emitter" << id, {});
+    return _state->emitters[id].position;
+}
+
+VoicePool& VoicePool::setPosition(const UnsignedInt id, const Vector3& position) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::setPosition(): invalid emitter" << id, *this);
+    Emitter& emitter = _state->emitters[id];
+    emitter.position = position;
+    if(emitter.voice != -1) _state->voices[emitter.voice].setPosition(position);
+    return *this;
+}
+
+Float VoicePool::gain(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::gain(): invalid emitter" << id, {});
+    return _state->emitters[id].gain;
+}
+
+VoicePool& VoicePool::setGain(const UnsignedInt id, const Float gain) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::setGain(): invalid emitter" << id, *this);
+    Emitter& emitter = _state->emitters[id];
+    emitter.gain = gain;
+    if(emitter.voice != -1) _state->voices[emitter.voice].setGain(gain);
+    return *this;
+}
+
+bool VoicePool::isLooping(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::isLooping(): invalid emitter" << id, {});
+    return _state->emitters[id].looping;
+}
+
+VoicePool& VoicePool::setLooping(const UnsignedInt id, const bool looping) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::setLooping(): invalid emitter" << id, *this);
+    Emitter& emitter = _state->emitters[id];
+    emitter.looping = looping;
+    if(emitter.voice != -1) _state->voices[emitter.voice].setLooping(looping);
+    return *this;
+}
+
+VoicePool& VoicePool::play(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::play(): invalid emitter" << id, *this);
+    Emitter& emitter = _state->emitters[id];
+    emitter.playing = true;
+    emitter.offset = 0.0f;
+    /* If the emitter already has a voice, restart it right away */
+    if(emitter.voice != -1) _state->voices[emitter.voice].rewind().play();
+    return *this;
+}
+
+VoicePool& VoicePool::stop(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::stop(): invalid emitter" << id, *this);
+    Emitter& emitter = _state->emitters[id];
+    emitter.playing = false;
+    emitter.offset = 0.0f;
+    _state->releaseVoice(emitter);
+    return *this;
+}
+
+bool VoicePool::isPlaying(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::isPlaying(): invalid emitter" << id, {});
+    return _state->emitters[id].playing;
+}
+
+Float VoicePool::offsetInSeconds(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::offsetInSeconds(): invalid emitter" << id, {});
+    return _state->emitters[id].offset;
+}
+
+Source* VoicePool::source(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->emitters.size() && _state->emitters[id].alive,
+        "Audio::VoicePool::source(): invalid emitter" << id, {});
+    const Int voice = _state->emitters[id].voice;
+    return voice == -1 ? nullptr : &_state->voices[voice];
+}
+
+VoicePool& VoicePool::update(const Vector3& listenerPosition, const Float timeDelta) {
+    State& state = *_state;
+
+    /* Advance time of all playing emitters and calculate their audibility */
+    arrayResize(state.audible, 0);
+    for(std::size_t i = 0; i != state.emitters.size(); ++i) {
+        Emitter& emitter = state.emitters[i];
+        if(!emitter.playing) continue;
+
+        emitter.offset += timeDelta;
+        if(emitter.offset >= emitter.duration) {
+            if(emitter.looping && emitter.duration > 0.0f)
+                emitter.offset = std::fmod(emitter.offset, emitter.duration);
+            else {
+                emitter.playing = false;
+                emitter.offset = 0.0f;
+                state.releaseVoice(emitter);
+                continue;
+            }
+        }
+
+        /* Same as AL_INVERSE_DISTANCE_CLAMPED without the max distance
+           clamping, which doesn't affect the ordering */
+        const Float distance = Math::max((emitter.position - listenerPosition).length(), state.referenceDistance);
+        const Float attenuation = state.referenceDistance/(state.referenceDistance + state.rolloffFactor*(distance - state.referenceDistance));
+        arrayAppend(state.audible, Containers::InPlaceInit, emitter.gain*attenuation, UnsignedInt(i));
+    }
+
+    /* Pick the most audible ones, ties resolved by ID to keep the assignment
+       stable */
+    const std::size_t voiceCount = Math::min(state.audible.size(), state.voices.size());
+    std::partial_sort(state.audible.begin(), state.audible.begin() + voiceCount, state.audible.end(),
+        [](const std::pair<Float, UnsignedInt>& a, const std::pair<Float, UnsignedInt>& b) {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        });
+
+    /* Take voices away from everything that wasn't chosen */
+    arrayResize(state.chosen, state.emitters.size());
+    std::fill(state.chosen.begin(), state.chosen.end(), false);
+    for(std::size_t i = 0; i != voiceCount; ++i)
+        state.chosen[state.audible[i].second] = true;
+    for(std::size_t i = 0; i != state.emitters.size(); ++i)
+        if(!state.chosen[i]) state.releaseVoice(state.emitters[i]);
+
+    /* Assign free voices to chosen emitters that don't have one yet */
+    std::size_t freeVoice = 0;
+    for(std::size_t i = 0; i != voiceCount; ++i) {
+        Emitter& emitter = state.emitters[state.audible[i].second];
+        if(emitter.voice != -1) continue;
+
+        while(state.voiceEmitters[freeVoice] != -1) ++freeVoice;
+        CORRADE_INTERNAL_ASSERT(freeVoice < state.voices.size());
+
+        state.voices[freeVoice].setBuffer(emitter.buffer)
+            .setLooping(emitter.looping)
+            .setPosition(emitter.position)
+            .setGain(emitter.gain)
+            .setOffsetInSeconds(emitter.offset)
+            .play();
+        state.voiceEmitters[freeVoice] = state.audible[i].second;
+        emitter.voice = freeVoice;
+        ++state.usedVoiceCount;
+    }
+
+    return *this;
+}
+
+}}
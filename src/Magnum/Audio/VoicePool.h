@@ -0,0 +1,249 @@
+#ifndef Magnum_Audio_VoicePool_h
+#define Magnum_Audio_VoicePool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Audio::VoicePool
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Audio/Audio.h"
+#include "Magnum/Audio/visibility.h"
+
+namespace Magnum { namespace Audio {
+
+/**
+@brief Pool of voices for a large count of sound emitters
+@m_since_latest
+
+OpenAL implementations can mix only a limited count of sources at a time and
+each @ref Source, even a silent one, costs mixing time. The pool keeps a fixed
+count of real @ref Source instances, called voices, and lightweight emitters
+that have just a buffer, position, gain and playback state. On every
+@ref update() the voices are assigned to the @ref voiceCount() most audible
+playing emitters, while the rest is *virtualized* --- their playback time
+advances, but they aren't mixed. Once a virtual emitter becomes audible
+enough to get a voice, it continues playing from the offset it would be at if
+it was playing all the time.
+
+@snippet MagnumAudio.cpp VoicePool
+
+@section Audio-VoicePool-audibility Audibility
+
+Emitters are ranked by their gain attenuated by distance from the listener,
+using the same formula as
+@ref Renderer::DistanceModel "Renderer::DistanceModel::InverseClamped" with
+the pool-wide @ref referenceDistance() and @ref rolloffFactor(), which are
+applied also to all voices. Only playing emitters are considered.
+
+Voice reassignment happens only in @ref update(), so an emitter started with
+@ref play() is virtual until the next update. An emitter that keeps its voice
+between updates isn't restarted, only its position and gain get updated if
+they changed.
+*/
+class MAGNUM_AUDIO_EXPORT VoicePool {
+    public:
+        /**
+         * @brief Constructor
+         * @param voiceCount    Count of real sources. Expected to be
+         *      non-zero.
+         *
+         * Creates @p voiceCount OpenAL sources.
+         */
+        explicit VoicePool(UnsignedInt voiceCount);
+
+        /** @brief Copying is not allowed */
+        VoicePool(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool(VoicePool&&) = delete;
+
+        ~VoicePool();
+
+        /** @brief Copying is not allowed */
+        VoicePool& operator=(const VoicePool&) = delete;
+
+        /** @brief Moving is not allowed */
+        VoicePool& operator=(VoicePool&&) = delete;
+
+        /** @brief Count of real sources */
+        UnsignedInt voiceCount() const;
+
+        /** @brief Count of voices currently assigned to an emitter */
+        UnsignedInt usedVoiceCount() const;
+
+        /** @brief Count of emitters */
+        UnsignedInt emitterCount() const;
+
+        /** @brief Reference distance used for audibility and all voices */
+        Float referenceDistance() const;
+
+        /**
+         * @brief Set reference distance
+         * @return Reference to self (for method chaining)
+         *
+         * Applied also to all voices via @ref Source::setReferenceDistance().
+         * Default is @cpp 1.0f @ce.
+         */
+        VoicePool& setReferenceDistance(Float distance);
+
+        /** @brief Rolloff factor used for audibility and all voices */
+        Float rolloffFactor() const;
+
+        /**
+         * @brief Set rolloff factor
+         * @return Reference to self (for method chaining)
+         *
+         * Applied also to all voices via @ref Source::setRolloffFactor().
+         * Default is @cpp 1.0f @ce.
+         */
+        VoicePool& setRolloffFactor(Float factor);
+
+        /**
+         * @brief Add an emitter
+         * @param buffer    Buffer to play. Expected to stay alive for the
+         *      whole emitter lifetime.
+         * @return Emitter ID
+         *
+         * The emitter is initially stopped, at origin, with gain
+         * @cpp 1.0f @ce and looping disabled. Duration of the @p buffer is
+         * queried once here. IDs of removed emitters get reused.
+         * @see @ref removeEmitter()
+         */
+        UnsignedInt addEmitter(Buffer& buffer);
+
+        /**
+         * @brief Remove an emitter
+         *
+         * If the emitter has a voice assigned, it's stopped and freed.
+         * Expects that @p id is a valid emitter ID.
+         */
+        void removeEmitter(UnsignedInt id);
+
+        /** @brief Emitter position */
+        Vector3 position(UnsignedInt id) const;
+
+        /**
+         * @brief Set emitter position
+         * @return Reference to self (for method chaining)
+         *
+         * Default is a zero vector.
+         */
+        VoicePool& setPosition(UnsignedInt id, const Vector3& position);
+
+        /** @brief Emitter gain */
+        Float gain(UnsignedInt id) const;
+
+        /**
+         * @brief Set emitter gain
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp 1.0f @ce.
+         */
+        VoicePool& setGain(UnsignedInt id, Float gain);
+
+        /** @brief Whether the emitter is looping */
+        bool isLooping(UnsignedInt id) const;
+
+        /**
+         * @brief Set whether the emitter is looping
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp false @ce.
+         */
+        VoicePool& setLooping(UnsignedInt id, bool looping);
+
+        /**
+         * @brief Play the emitter
+         * @return Reference to self (for method chaining)
+         *
+         * Starts the playback from the beginning. A voice is assigned to the
+         * emitter on the next @ref update() if it's audible enough.
+         */
+        VoicePool& play(UnsignedInt id);
+
+        /**
+         * @brief Stop the emitter
+         * @return Reference to self (for method chaining)
+         *
+         * If the emitter has a voice assigned, it's stopped and freed
+         * immediately.
+         */
+        VoicePool& stop(UnsignedInt id);
+
+        /**
+         * @brief Whether the emitter is playing
+         *
+         * Returns @cpp true @ce after @ref play() until @ref stop() is called
+         * or, if not looping, the playback time reaches the buffer duration
+         * in @ref update(). Independent on whether the emitter has a voice.
+         */
+        bool isPlaying(UnsignedInt id) const;
+
+        /**
+         * @brief Playback offset in seconds
+         *
+         * Advanced in @ref update() for all playing emitters, including
+         * virtual ones.
+         */
+        Float offsetInSeconds(UnsignedInt id) const;
+
+        /**
+         * @brief Source assigned to the emitter
+         *
+         * Returns @cpp nullptr @ce if the emitter is stopped or virtual. The
+         * source is owned by the pool and may get assigned to a different
+         * emitter on next @ref update(), so don't keep the pointer.
+         */
+        Source* source(UnsignedInt id);
+
+        /**
+         * @brief Update voice assignment
+         * @param listenerPosition  Listener position
+         * @param timeDelta         Time since the last update in seconds
+         * @return Reference to self (for method chaining)
+         *
+         * Advances playback offset of all playing emitters by @p timeDelta,
+         * stopping those that aren't looping and reached the end of the
+         * buffer. Then takes voices away from emitters that are no longer
+         * among the @ref voiceCount() most audible and assigns them to the
+         * audible ones that don't have a voice yet, starting the playback at
+         * the emitter offset. See @ref Audio-VoicePool-audibility for more
+         * information.
+         */
+        VoicePool& update(const Vector3& listenerPosition, Float timeDelta);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
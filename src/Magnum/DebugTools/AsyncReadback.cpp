@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncReadback.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/BufferData.h"
+#include "Magnum/DebugTools/TextureImage.h"
+#include "Magnum/GL/AbstractFramebuffer.h"
+#include "Magnum/GL/BufferImage.h"
+#include "Magnum/GL/Fence.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+struct AsyncReadback::Slot {
+    /* Zero if the slot is free */
+    UnsignedInt id{};
+    PixelFormat format{};
+    GL::BufferImage2D image{NoCreate};
+    GL::Fence fence{NoCreate};
+};
+
+AsyncReadback::AsyncReadback(const UnsignedInt capacity) {
+    CORRADE_ASSERT(capacity,
+        "DebugTools::AsyncReadback: capacity can't be zero", );
+    _slots = Containers::Array<Slot>{Containers::ValueInit, capacity};
+}
+
+AsyncReadback::AsyncReadback(AsyncReadback&&) noexcept = default;
+
+AsyncReadback::~AsyncReadback() = default;
+
+AsyncReadback& AsyncReadback::operator=(AsyncReadback&&) noexcept = default;
+
+UnsignedInt AsyncReadback::capacity() const { return _slots.size(); }
+
+UnsignedInt AsyncReadback::pendingCount() const {
+    UnsignedInt count = 0;
+    for(const Slot& slot: _slots) if(slot.id) ++count;
+    return count;
+}
+
+AsyncReadback::Slot* AsyncReadback::find(const UnsignedInt id) {
+    if(id) for(Slot& slot: _slots) if(slot.id == id) return &slot;
+    return nullptr;
+}
+
+AsyncReadback::Slot* AsyncReadback::acquire(const PixelFormat format) {
+    for(Slot& slot: _slots) {
+        if(slot.id) continue;
+
+        /* The buffer is created on first use and kept for subsequent reads
+           of the same format, which then don't need to reallocate */
+        if(!slot.image.buffer().id() || slot.format != format) {
+            slot.image = GL::BufferImage2D{format};
+            slot.format = format;
+        }
+        return &slot;
+    }
+
+    return nullptr;
+}
+
+UnsignedInt AsyncReadback::submit(Slot& slot) {
+    slot.fence = GL::Fence{};
+    slot.id = _nextId;
+    /* Skip zero on overflow, as that denotes a free slot */
+    if(!++_nextId) _nextId = 1;
+    return slot.id;
+}
+
+UnsignedInt AsyncReadback::read(GL::AbstractFramebuffer& framebuffer, const Range2Di& rectangle, const PixelFormat format) {
+    Slot* const slot = acquire(format);
+    CORRADE_ASSERT(slot,
+        "DebugTools::AsyncReadback::read(): all" << _slots.size() << "reads are pending", {});
+    framebuffer.read(rectangle, slot->image, GL::BufferUsage::StreamRead);
+    return submit(*slot);
+}
+
+UnsignedInt AsyncReadback::read(GL::AbstractFramebuffer& framebuffer, const PixelFormat format) {
+    return read(framebuffer, framebuffer.viewport(), format);
+}
+
+UnsignedInt AsyncReadback::read(GL::Texture2D& texture, const Int level, const Range2Di& range, const PixelFormat format) {
+    Slot* const slot = acquire(format);
+    CORRADE_ASSERT(slot,
+        "DebugTools::AsyncReadback::read(): all" << _slots.size() << "reads are pending", {});
+    textureSubImage(texture, level, range, slot->image, GL::BufferUsage::StreamRead);
+    return submit(*slot);
+}
+
+bool AsyncReadback::isReady(const UnsignedInt id) {
+    Slot* const slot = find(id);
+    CORRADE_ASSERT(slot,
+        "DebugTools::AsyncReadback::isReady(): no pending read with ID" << id, {});
+
+    /* Zero timeout never blocks, but unlike Fence::isSignaled() flushes the
+       commands so the fence gets signaled eventually even if the
+       application doesn't flush */
+    const GL::Fence::WaitResult result = slot->fence.clientWait(0);
+    return result == GL::Fence::WaitResult::AlreadySignaled ||
+           result == GL::Fence::WaitResult::ConditionSatisfied;
+}
+
+Containers::Optional<Image2D> AsyncReadback::tryRetrieve(const UnsignedInt id) {
+    CORRADE_ASSERT(find(id),
+        "DebugTools::AsyncReadback::tryRetrieve(): no pending read with ID" << id, {});
+
+    if(!isReady(id)) return {};
+    return retrieve(id);
+}
+
+Image2D AsyncReadback::retrieve(const UnsignedInt id) {
+    Slot* const slot = find(id);
+    CORRADE_ASSERT(slot,
+        "DebugTools::AsyncReadback::retrieve(): no pending read with ID" << id, (Image2D{PixelFormat::RGBA8Unorm}));
+
+    /* If the data aren't there yet, mapping the buffer waits for them */
+    Containers::Array<char> data = bufferSubData<char>(slot->image.buffer(), 0, slot->image.dataSize());
+    slot->id = 0;
+    slot->fence = GL::Fence{NoCreate};
+    return Image2D{slot->image.storage(), slot->format, slot->image.size(), std::move(data)};
+}
+
+void AsyncReadback::discard(const UnsignedInt id) {
+    Slot* const slot = find(id);
+    CORRADE_ASSERT(slot,
+        "DebugTools::AsyncReadback::discard(): no pending read with ID" << id, );
+
+    slot->id = 0;
+    slot->fence = GL::Fence{NoCreate};
+}
+
+}}
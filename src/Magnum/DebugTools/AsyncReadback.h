@@ -0,0 +1,200 @@
+#ifndef Magnum_DebugTools_AsyncReadback_h
+#define Magnum_DebugTools_AsyncReadback_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::AsyncReadback
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/GL/GL.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Non-blocking framebuffer and texture readback
+@m_since_latest
+
+Reading pixels with @ref GL::AbstractFramebuffer::read() into an
+@ref Image2D, which is what @ref screenshot() and @ref textureSubImage() do,
+waits until the GPU finishes rendering everything before and thus stalls the
+pipeline. This class instead reads the pixels into a pixel buffer object and
+inserts a @ref GL::Fence after, returning an ID of the pending read. The data
+can be then retrieved a few frames later, once @ref isReady() returns
+@cpp true @ce, without any stall. Useful for periodic screenshots or capturing
+golden images for @ref CompareImage in long-running tests:
+
+@snippet MagnumDebugTools-gl.cpp AsyncReadback-usage
+
+The class keeps a fixed count of pixel buffers, passed to the constructor,
+and reuses them for subsequent reads to avoid reallocations. Each pending read
+occupies one buffer until it's retrieved with @ref tryRetrieve(),
+@ref retrieve() or dropped with @ref discard(). Reading when all buffers are
+occupied is not allowed, check @ref pendingCount() to skip a capture in that
+case.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" enabled (done by default). See
+    @ref building-features for more information.
+
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT AsyncReadback {
+    public:
+        /**
+         * @brief Constructor
+         * @param capacity  Max count of reads pending at the same time
+         *
+         * Expects that @p capacity is non-zero. The pixel buffers are
+         * created lazily on first use.
+         */
+        explicit AsyncReadback(UnsignedInt capacity = 3);
+
+        /** @brief Copying is not allowed */
+        AsyncReadback(const AsyncReadback&) = delete;
+
+        /** @brief Move constructor */
+        AsyncReadback(AsyncReadback&&) noexcept;
+
+        ~AsyncReadback();
+
+        /** @brief Copying is not allowed */
+        AsyncReadback& operator=(const AsyncReadback&) = delete;
+
+        /** @brief Move assignment */
+        AsyncReadback& operator=(AsyncReadback&&) noexcept;
+
+        /** @brief Max count of reads pending at the same time */
+        UnsignedInt capacity() const;
+
+        /** @brief Count of pending reads */
+        UnsignedInt pendingCount() const;
+
+        /**
+         * @brief Read a framebuffer rectangle
+         * @param framebuffer   Framebuffer to read from
+         * @param rectangle     Rectangle to read
+         * @param format        Pixel format to read the data in
+         * @return ID of the pending read, never @cpp 0 @ce
+         *
+         * Issues a @ref GL::AbstractFramebuffer::read(const Range2Di&, GL::BufferImage2D&, GL::BufferUsage)
+         * into a free pixel buffer and inserts a @ref GL::Fence after it.
+         * Doesn't wait for the data to arrive. Expects that
+         * @ref pendingCount() is less than @ref capacity(). Note that
+         * supplying a format that's incompatible with the framebuffer may
+         * result in GL errors, similarly to
+         * @ref screenshot(GL::AbstractFramebuffer&, PixelFormat, const std::string&).
+         */
+        UnsignedInt read(GL::AbstractFramebuffer& framebuffer, const Range2Di& rectangle, PixelFormat format);
+
+        /**
+         * @brief Read a framebuffer viewport
+         *
+         * Equivalent to calling @ref read(GL::AbstractFramebuffer&, const Range2Di&, PixelFormat)
+         * with @ref GL::AbstractFramebuffer::viewport() as the rectangle.
+         */
+        UnsignedInt read(GL::AbstractFramebuffer& framebuffer, PixelFormat format);
+
+        /**
+         * @brief Read a texture mip level range
+         * @param texture       Texture to read from
+         * @param level         Mip level
+         * @param range         Range to read
+         * @param format        Pixel format to read the data in
+         * @return ID of the pending read, never @cpp 0 @ce
+         *
+         * Like @ref read(GL::AbstractFramebuffer&, const Range2Di&, PixelFormat),
+         * but reading the texture using
+         * @ref textureSubImage(GL::Texture2D&, Int, const Range2Di&, GL::BufferImage2D&, GL::BufferUsage).
+         * The same restrictions on supported pixel formats apply.
+         */
+        UnsignedInt read(GL::Texture2D& texture, Int level, const Range2Di& range, PixelFormat format);
+
+        /**
+         * @brief Whether a read is finished
+         *
+         * Returns @cpp true @ce if the GPU finished the read with given @p id
+         * and its data can be retrieved without a stall. Doesn't block.
+         * Expects that @p id is a pending read.
+         * @see @ref GL::Fence::isSignaled()
+         */
+        bool isReady(UnsignedInt id);
+
+        /**
+         * @brief Retrieve data of a read if it's finished
+         *
+         * If @ref isReady() is @cpp true @ce for given @p id, copies the data
+         * out of the pixel buffer, frees it for another read and returns
+         * them. Otherwise returns @ref Containers::NullOpt and the read stays
+         * pending. Expects that @p id is a pending read.
+         */
+        Containers::Optional<Image2D> tryRetrieve(UnsignedInt id);
+
+        /**
+         * @brief Retrieve data of a read
+         *
+         * Like @ref tryRetrieve(), but if the read isn't finished yet, waits
+         * for it, stalling the pipeline. Expects that @p id is a pending
+         * read.
+         */
+        Image2D retrieve(UnsignedInt id);
+
+        /**
+         * @brief Discard a read
+         *
+         * Frees the pixel buffer used by given @p id for another read without
+         * retrieving its data. Expects that @p id is a pending read.
+         */
+        void discard(UnsignedInt id);
+
+    private:
+        struct Slot;
+
+        MAGNUM_DEBUGTOOLS_LOCAL Slot* find(UnsignedInt id);
+        MAGNUM_DEBUGTOOLS_LOCAL Slot* acquire(PixelFormat format);
+        MAGNUM_DEBUGTOOLS_LOCAL UnsignedInt submit(Slot& slot);
+
+        Containers::Array<Slot> _slots;
+        UnsignedInt _nextId{1};
+};
+
+}}
+#else
+#error this header is available only in the OpenGL ES 3.0 and desktop OpenGL build
+#endif
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <map>
 #include <sstream>
+#include <type_traits>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Containers/Optional.h>
@@ -36,67 +37,354 @@
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
 #include "Magnum/Math/Algorithms/KahanSum.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace DebugTools { namespace Implementation {
 
 namespace {
 
-template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::StridedArrayView2D<Float>& output) {
-    CORRADE_INTERNAL_ASSERT(actual.size() == output.size());
-    CORRADE_INTERNAL_ASSERT(output.size() == expected.size());
+template<class T> using IsExactInteger = std::integral_constant<bool, std::is_integral<T>::value && sizeof(T) <= 2>;
+
+/* Deltas of 8- and 16-bit integer formats are calculated on integers. That's
+   exact and thus gives the same result as converting to floats first, and
+   as there are no specials to handle, the loop can be easily vectorized. */
+template<std::size_t size, class T, class ActualRow, class ExpectedRow> Float calculateImageDeltaRow(std::true_type, const ActualRow& actualRow, const ExpectedRow& expectedRow, const Containers::ArrayView<Float>& outputRow) {
+    Float max{};
+    for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
+        const Math::Vector<size, T>& actualPixel = actualRow[j];
+        const Math::Vector<size, T>& expectedPixel = expectedRow[j];
+
+        Int diff = 0;
+        for(std::size_t c = 0; c != size; ++c)
+            diff += Math::abs(Int(actualPixel[c]) - Int(expectedPixel[c]));
+
+        const Float delta = Float(diff)/size;
+        outputRow[j] = delta;
+        max = Math::max(max, delta);
+    }
 
-    /* Calculate deltas and maximal value of them */
+    return max;
+}
+
+/* Other formats are converted to floats and specials are handled */
+template<std::size_t size, class T, class ActualRow, class ExpectedRow> Float calculateImageDeltaRow(std::false_type, const ActualRow& actualRow, const ExpectedRow& expectedRow, const Containers::ArrayView<Float>& outputRow) {
     Float max{};
-    for(std::size_t i = 0, iMax = expected.size()[0]; i != iMax; ++i) {
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
-        Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
-        Containers::StridedArrayView1D<Float> outputRow = output[i];
+    for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
+        const Math::Vector<size, T>& actualPixel = actualRow[j];
+        const Math::Vector<size, T>& expectedPixel = expectedRow[j];
 
-        for(std::size_t j = 0, jMax = expectedRow.size(); j != jMax; ++j) {
+        Float diffSum{}, finiteDiffSum{};
+        for(std::size_t c = 0; c != size; ++c) {
             /* Explicitly convert from T to Float */
-            auto actualPixel = Math::Vector<size, Float>(actualRow[j]);
-            auto expectedPixel = Math::Vector<size, Float>(expectedRow[j]);
+            const Float actual = Float(actualPixel[c]);
+            const Float expected = Float(expectedPixel[c]);
+
+            /* Mark channels that are NaN in both actual and expected pixels
+               or the same sign of infinity in both as having no difference,
+               otherwise calculate a classic difference */
+            const Float diff = actual == expected || (actual != actual && expected != expected) ? 0.0f : Math::abs(actual - expected);
+
+            /* Save the difference to the output image even with NaN and ±Inf
+               (as the user should know). On the other hand, infs and NaNs
+               should not contribute to the max delta -- because all other
+               differences would be zero compared to them. */
+            diffSum += diff;
+            if(!Math::isNan(diff) && !Math::isInf(diff)) finiteDiffSum += diff;
+        }
 
-            /* First calculate a classic difference */
-            Math::Vector<size, Float> diff = Math::abs(actualPixel - expectedPixel);
+        outputRow[j] = diffSum/size;
+        max = Math::max(max, finiteDiffSum/size);
+    }
 
-            /* Mark pixels that are NaN in both actual and expected pixels as
-               having no difference */
-            diff = Math::lerp(diff, {}, Math::isNan(actualPixel) & Math::isNan(expectedPixel));
+    return max;
+}
 
-            /* Then also mark pixels that are the same sign of infnity in both
-               actual and expected pixel as having no difference */
-            diff = Math::lerp(diff, {}, Math::isInf(actualPixel) & Math::isInf(expectedPixel) & Math::equal(actualPixel, expectedPixel));
+/* Kernels for tightly packed rows. The SIMD variants for the most common
+   formats process as many pixels as they can and delegate the remainder to
+   the scalar variant. Channel differences are summed in the same order as in
+   the scalar code and multiplying by 0.25 is exact, so the output is
+   bit-identical to the scalar code, except for NaN payloads. */
+template<std::size_t size, class T> using RowKernel = Float(*)(const Math::Vector<size, T>*, const Math::Vector<size, T>*, Float*, std::size_t);
 
-            /* Calculate the difference and save it to the output image even
-               with NaN and ±Inf (as the user should know) */
-            outputRow[j] = diff.sum()/size;
+namespace Scalar {
 
-            /* On the other hand, infs and NaNs should not contribute to the
-               max delta -- because all other differences would be zero
-               compared to them */
-            max = Math::max(max, Math::lerp(diff, {}, Math::isNan(diff)|Math::isInf(diff)).sum()/size);
-        }
+template<std::size_t size, class T> Float calculateImageDeltaRow(const Math::Vector<size, T>* const actual, const Math::Vector<size, T>* const expected, Float* const output, const std::size_t count) {
+    return Implementation::calculateImageDeltaRow<size, T>(IsExactInteger<T>{},
+        Containers::ArrayView<const Math::Vector<size, T>>{actual, count},
+        Containers::ArrayView<const Math::Vector<size, T>>{expected, count},
+        Containers::ArrayView<Float>{output, count});
+}
+
+}
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+inline Float horizontalMax(__m128 a) {
+    a = _mm_max_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 3, 2)));
+    a = _mm_max_ps(a, _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(a);
+}
+
+/* Channel difference with the same handling of specials as in the scalar
+   code above */
+inline __m128 channelDelta(const __m128 actual, const __m128 expected) {
+    const __m128 same = _mm_or_ps(_mm_cmpeq_ps(actual, expected),
+        _mm_and_ps(_mm_cmpunord_ps(actual, actual), _mm_cmpunord_ps(expected, expected)));
+    return _mm_andnot_ps(same, _mm_andnot_ps(_mm_set1_ps(-0.0f), _mm_sub_ps(actual, expected)));
+}
+
+/* Zeroes out NaNs and infinities */
+inline __m128 finiteDelta(const __m128 delta) {
+    return _mm_and_ps(delta, _mm_cmplt_ps(delta, _mm_set1_ps(Constants::inf())));
+}
+
+Float calculateImageDeltaRgba8(const Math::Vector<4, UnsignedByte>* const actual, const Math::Vector<4, UnsignedByte>* const expected, Float* const output, const std::size_t count) {
+    const __m128i lowBytes = _mm_set1_epi32(0x00ff00ff);
+    const __m128i lowShorts = _mm_set1_epi32(0x0000ffff);
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    __m128 max = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(actual + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + i));
+
+        /* Absolute difference of each channel, then a sum of the four
+           channels in each 32-bit pixel */
+        const __m128i diff = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+        const __m128i pairs = _mm_add_epi32(_mm_and_si128(diff, lowBytes), _mm_and_si128(_mm_srli_epi32(diff, 8), lowBytes));
+        const __m128i sums = _mm_add_epi32(_mm_and_si128(pairs, lowShorts), _mm_srli_epi32(pairs, 16));
+
+        const __m128 delta = _mm_mul_ps(_mm_cvtepi32_ps(sums), quarter);
+        _mm_storeu_ps(output + i, delta);
+        max = _mm_max_ps(max, delta);
+    }
+
+    return Math::max(horizontalMax(max), Scalar::calculateImageDeltaRow<4, UnsignedByte>(actual + i, expected + i, output + i, count - i));
+}
+
+Float calculateImageDeltaR32f(const Math::Vector<1, Float>* const actual, const Math::Vector<1, Float>* const expected, Float* const output, const std::size_t count) {
+    __m128 max = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const __m128 delta = channelDelta(
+            _mm_loadu_ps(reinterpret_cast<const Float*>(actual + i)),
+            _mm_loadu_ps(reinterpret_cast<const Float*>(expected + i)));
+        _mm_storeu_ps(output + i, delta);
+        max = _mm_max_ps(max, finiteDelta(delta));
     }
 
+    return Math::max(horizontalMax(max), Scalar::calculateImageDeltaRow<1, Float>(actual + i, expected + i, output + i, count - i));
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+namespace F16c {
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C Float calculateImageDeltaRgba16f(const Math::Vector<4, Half>* const actual, const Math::Vector<4, Half>* const expected, Float* const output, const std::size_t count) {
+    const __m128 quarter = _mm_set1_ps(0.25f);
+    __m128 max = _mm_setzero_ps();
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        /* Each 64-bit half of the input is one pixel, converting pixel by
+           pixel and then transposing to have four pixels of one channel in
+           each register */
+        const __m128i a01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(actual + i));
+        const __m128i a23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(actual + i + 2));
+        const __m128i b01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + i));
+        const __m128i b23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(expected + i + 2));
+        __m128 a0 = _mm_cvtph_ps(a01), a1 = _mm_cvtph_ps(_mm_unpackhi_epi64(a01, a01)),
+               a2 = _mm_cvtph_ps(a23), a3 = _mm_cvtph_ps(_mm_unpackhi_epi64(a23, a23));
+        __m128 b0 = _mm_cvtph_ps(b01), b1 = _mm_cvtph_ps(_mm_unpackhi_epi64(b01, b01)),
+               b2 = _mm_cvtph_ps(b23), b3 = _mm_cvtph_ps(_mm_unpackhi_epi64(b23, b23));
+        _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+        _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+        const __m128 d0 = Sse2::channelDelta(a0, b0);
+        const __m128 d1 = Sse2::channelDelta(a1, b1);
+        const __m128 d2 = Sse2::channelDelta(a2, b2);
+        const __m128 d3 = Sse2::channelDelta(a3, b3);
+        const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(d0, d1), d2), d3);
+        const __m128 finiteSum = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            Sse2::finiteDelta(d0), Sse2::finiteDelta(d1)),
+            Sse2::finiteDelta(d2)), Sse2::finiteDelta(d3));
+
+        _mm_storeu_ps(output + i, _mm_mul_ps(sum, quarter));
+        max = _mm_max_ps(max, _mm_mul_ps(finiteSum, quarter));
+    }
+
+    return Math::max(Sse2::horizontalMax(max), Scalar::calculateImageDeltaRow<4, Half>(actual + i, expected + i, output + i, count - i));
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+inline float32x4_t channelDelta(const float32x4_t actual, const float32x4_t expected) {
+    const uint32x4_t same = vorrq_u32(vceqq_f32(actual, expected),
+        vbicq_u32(vmvnq_u32(vceqq_f32(actual, actual)), vceqq_f32(expected, expected)));
+    return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(vabdq_f32(actual, expected)), same));
+}
+
+inline float32x4_t finiteDelta(const float32x4_t delta) {
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(delta), vcltq_f32(delta, vdupq_n_f32(Constants::inf()))));
+}
+
+Float calculateImageDeltaRgba8(const Math::Vector<4, UnsignedByte>* const actual, const Math::Vector<4, UnsignedByte>* const expected, Float* const output, const std::size_t count) {
+    float32x4_t max = vdupq_n_f32(0.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const uint8x16_t diff = vabdq_u8(
+            vld1q_u8(reinterpret_cast<const UnsignedByte*>(actual + i)),
+            vld1q_u8(reinterpret_cast<const UnsignedByte*>(expected + i)));
+        const float32x4_t delta = vmulq_n_f32(vcvtq_f32_u32(vpaddlq_u16(vpaddlq_u8(diff))), 0.25f);
+        vst1q_f32(output + i, delta);
+        max = vmaxq_f32(max, delta);
+    }
+
+    return Math::max(vmaxvq_f32(max), Scalar::calculateImageDeltaRow<4, UnsignedByte>(actual + i, expected + i, output + i, count - i));
+}
+
+Float calculateImageDeltaR32f(const Math::Vector<1, Float>* const actual, const Math::Vector<1, Float>* const expected, Float* const output, const std::size_t count) {
+    float32x4_t max = vdupq_n_f32(0.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const float32x4_t delta = channelDelta(
+            vld1q_f32(reinterpret_cast<const Float*>(actual + i)),
+            vld1q_f32(reinterpret_cast<const Float*>(expected + i)));
+        vst1q_f32(output + i, delta);
+        max = vmaxq_f32(max, finiteDelta(delta));
+    }
+
+    return Math::max(vmaxvq_f32(max), Scalar::calculateImageDeltaRow<1, Float>(actual + i, expected + i, output + i, count - i));
+}
+
+Float calculateImageDeltaRgba16f(const Math::Vector<4, Half>* const actual, const Math::Vector<4, Half>* const expected, Float* const output, const std::size_t count) {
+    float32x4_t max = vdupq_n_f32(0.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        /* The load deinterleaves the channels, so each register has four
+           pixels of one channel */
+        const uint16x4x4_t a = vld4_u16(reinterpret_cast<const UnsignedShort*>(actual + i));
+        const uint16x4x4_t b = vld4_u16(reinterpret_cast<const UnsignedShort*>(expected + i));
+        float32x4_t d[4];
+        for(std::size_t c = 0; c != 4; ++c)
+            d[c] = channelDelta(vcvt_f32_f16(vreinterpret_f16_u16(a.val[c])), vcvt_f32_f16(vreinterpret_f16_u16(b.val[c])));
+        const float32x4_t sum = vaddq_f32(vaddq_f32(vaddq_f32(d[0], d[1]), d[2]), d[3]);
+        const float32x4_t finiteSum = vaddq_f32(vaddq_f32(vaddq_f32(
+            finiteDelta(d[0]), finiteDelta(d[1])),
+            finiteDelta(d[2])), finiteDelta(d[3]));
+
+        vst1q_f32(output + i, vmulq_n_f32(sum, 0.25f));
+        max = vmaxq_f32(max, vmulq_n_f32(finiteSum, 0.25f));
+    }
+
+    return Math::max(vmaxvq_f32(max), Scalar::calculateImageDeltaRow<4, Half>(actual + i, expected + i, output + i, count - i));
+}
+
+}
+#endif
+
+template<std::size_t size, class T> RowKernel<size, T> rowKernel() {
+    return Scalar::calculateImageDeltaRow<size, T>;
+}
+
+template<> RowKernel<4, UnsignedByte> rowKernel<4, UnsignedByte>() {
+    #ifdef CORRADE_TARGET_SSE2
+    return Sse2::calculateImageDeltaRgba8;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return Neon::calculateImageDeltaRgba8;
+    #else
+    return Scalar::calculateImageDeltaRow<4, UnsignedByte>;
+    #endif
+}
+
+template<> RowKernel<1, Float> rowKernel<1, Float>() {
+    #ifdef CORRADE_TARGET_SSE2
+    return Sse2::calculateImageDeltaR32f;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return Neon::calculateImageDeltaR32f;
+    #else
+    return Scalar::calculateImageDeltaRow<1, Float>;
+    #endif
+}
+
+template<> RowKernel<4, Half> rowKernel<4, Half>() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    return Math::Implementation::cpuFeatures().f16c ? F16c::calculateImageDeltaRgba16f : Scalar::calculateImageDeltaRow<4, Half>;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return Neon::calculateImageDeltaRgba16f;
+    #else
+    return Scalar::calculateImageDeltaRow<4, Half>;
+    #endif
+}
+
+template<std::size_t size, class T> Float calculateImageDelta(const Containers::StridedArrayView2D<const Math::Vector<size, T>>& actual, const Containers::StridedArrayView2D<const Math::Vector<size, T>>& expected, const Containers::ArrayView<Float> output, UnsignedInt threadCount) {
+    CORRADE_INTERNAL_ASSERT(actual.size() == expected.size());
+    CORRADE_INTERNAL_ASSERT(output.size() == expected.size()[0]*expected.size()[1]);
+
+    const RowKernel<size, T> kernel = rowKernel<size, T>();
+
+    /* Each thread calculates deltas and their max for a range of rows. The
+       max is the same regardless of how the rows are split. */
+    const std::size_t width = expected.size()[1];
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), output.size());
+    Containers::Array<Float> maxes{Containers::ValueInit, threadCount};
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(expected.size()[0], threadCount, thread);
+        Float max{};
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            const Containers::StridedArrayView1D<const Math::Vector<size, T>> actualRow = actual[i];
+            const Containers::StridedArrayView1D<const Math::Vector<size, T>> expectedRow = expected[i];
+            const Containers::ArrayView<Float> outputRow = output.slice(i*width, (i + 1)*width);
+
+            /* Tightly packed rows are processed through plain pointers, which
+               either go to a SIMD kernel or the compiler can vectorize */
+            if(actualRow.isContiguous() && expectedRow.isContiguous())
+                max = Math::max(max, kernel(
+                    static_cast<const Math::Vector<size, T>*>(actualRow.data()),
+                    static_cast<const Math::Vector<size, T>*>(expectedRow.data()),
+                    outputRow.data(), width));
+            else
+                max = Math::max(max, calculateImageDeltaRow<size, T>(IsExactInteger<T>{}, actualRow, expectedRow, outputRow));
+        }
+        maxes[thread] = max;
+    });
+
+    Float max{};
+    for(const Float threadMax: maxes) max = Math::max(max, threadMax);
     return max;
 }
 
 }
 
-std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
+std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, const UnsignedInt threadCount) {
     /* Calculate a delta image */
     Containers::Array<Float> deltaData{Containers::NoInit,
         std::size_t(expected.size().product())};
-    Containers::StridedArrayView2D<Float> delta{deltaData,
-        {std::size_t(expected.size().y()), std::size_t(expected.size().x())}};
 
     CORRADE_INTERNAL_ASSERT(actualFormat == expected.format());
     #ifdef CORRADE_NO_ASSERT
@@ -115,14 +403,14 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
             case PixelFormat::format:                                       \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), deltaData, threadCount); \
                 break;
         #define _d(first, second, size, T)                                  \
             case PixelFormat::first:                                        \
             case PixelFormat::second:                                       \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), deltaData, threadCount); \
                 break;
         #define _e(first, second, third, size, T)                           \
             case PixelFormat::first:                                        \
@@ -130,7 +418,7 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
             case PixelFormat::third:                                        \
                 max = calculateImageDelta<size, T>(                         \
                     Containers::arrayCast<2, const Math::Vector<size, T>>(actualPixels), \
-                    expected.pixels<Math::Vector<size, T>>(), delta);       \
+                    expected.pixels<Math::Vector<size, T>>(), deltaData, threadCount); \
                 break;
         /* LCOV_EXCL_START */
         _e(R8Unorm, R8Srgb, R8UI, 1, UnsignedByte)
@@ -161,16 +449,14 @@ std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(const Pix
         _c(RG32F, 2, Float)
         _c(RGB32F, 3, Float)
         _c(RGBA32F, 4, Float)
+        _c(R16F, 1, Half)
+        _c(RG16F, 2, Half)
+        _c(RGB16F, 3, Half)
+        _c(RGBA16F, 4, Half)
         /* LCOV_EXCL_STOP */
         #undef _e
         #undef _d
         #undef _c
-
-        case PixelFormat::R16F:
-        case PixelFormat::RG16F:
-        case PixelFormat::RGB16F:
-        case PixelFormat::RGBA16F:
-            CORRADE_ASSERT_UNREACHABLE("DebugTools::CompareImage: half-float formats are not supported yet", {});
     }
     #ifdef __GNUC__
     #pragma GCC diagnostic pop
@@ -294,6 +580,10 @@ void printPixelAt(Debug& out, const Containers::StridedArrayView3D<const char>&
         _c(RG32F, 2, Float)
         _c(RGB32F, 3, Float)
         _c(RGBA32F, 4, Float)
+        _c(R16F, 1, Half)
+        _c(RG16F, 2, Half)
+        _c(RGB16F, 3, Half)
+        _c(RGBA16F, 4, Half)
         /* LCOV_EXCL_STOP */
         #undef _e
         #undef _d
@@ -308,13 +598,6 @@ void printPixelAt(Debug& out, const Containers::StridedArrayView3D<const char>&
         case PixelFormat::RGBA8Srgb:
             out << *reinterpret_cast<const Color4ub*>(pixel);
             break;
-
-        case PixelFormat::R16F:
-        case PixelFormat::RG16F:
-        case PixelFormat::RGB16F:
-        case PixelFormat::RGBA16F:
-            /* Already handled by a printing assert before */
-            CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
     #ifdef __GNUC__
     #pragma GCC diagnostic pop
@@ -415,6 +698,7 @@ class ImageComparatorBase::State {
         Containers::Optional<ImageView2D> expectedImage;
 
         Float maxThreshold, meanThreshold;
+        UnsignedInt threadCount{1};
         Result result{};
         Float max{}, mean{};
         Containers::Array<Float> delta;
@@ -430,6 +714,10 @@ ImageComparatorBase::ImageComparatorBase(PluginManager::Manager<Trade::AbstractI
 
 ImageComparatorBase::~ImageComparatorBase() = default;
 
+void ImageComparatorBase::setThreadCount(const UnsignedInt count) {
+    _state->threadCount = count;
+}
+
 TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected) {
     /* The reference can be pointing to the storage, don't call the assignment
        on itself in that case */
@@ -451,7 +739,7 @@ TestSuite::ComparisonStatusFlags ImageComparatorBase::compare(const PixelFormat
     }
 
     Containers::Array<Float> delta;
-    std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected);
+    std::tie(delta, _state->max, _state->mean) = DebugTools::Implementation::calculateImageDelta(actualFormat, actualPixels, expected, _state->threadCount);
 
     /* Verify the max/mean is never below zero so we didn't mess up when
        calculating specials. Note the inverted condition to catch NaNs in
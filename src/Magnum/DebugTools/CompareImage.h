@@ -44,7 +44,7 @@
 namespace Magnum { namespace DebugTools {
 
 namespace Implementation {
-    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected);
+    MAGNUM_DEBUGTOOLS_EXPORT std::tuple<Containers::Array<Float>, Float, Float> calculateImageDelta(PixelFormat actualFormat, const Containers::StridedArrayView3D<const char>& actualPixels, const ImageView2D& expected, UnsignedInt threadCount = 1);
 
     MAGNUM_DEBUGTOOLS_EXPORT void printDeltaImage(Debug& out, Containers::ArrayView<const Float> delta, const Vector2i& size, Float max, Float maxThreshold, Float meanThreshold);
 
@@ -68,6 +68,8 @@ class MAGNUM_DEBUGTOOLS_EXPORT ImageComparatorBase {
 
         ~ImageComparatorBase();
 
+        void setThreadCount(UnsignedInt count);
+
         TestSuite::ComparisonStatusFlags operator()(const ImageView2D& actual, const ImageView2D& expected);
 
         TestSuite::ComparisonStatusFlags operator()(const std::string& actual, const std::string& expected);
@@ -225,9 +227,9 @@ Supports the following formats:
 -   @ref PixelFormat::RGBA8I, @ref PixelFormat::RGBA16I,
     @ref PixelFormat::RGBA32I and their one-/two-/three-component versions
 -   @ref PixelFormat::RGBA32F and its one-/two-/three-component versions
+-   @ref PixelFormat::RGBA16F and its one-/two-/three-component versions
 
-@ref PixelFormat::RGBA16F and other half-float formats are not supported at the
-moment. Implementation-specific pixel formats can't be supported.
+Implementation-specific pixel formats can't be supported.
 
 Supports all @ref PixelStorage parameters. The images don't need to have the
 same pixel storage parameters, meaning you are able to compare different
@@ -310,6 +312,20 @@ then autodetected from the passed type, with normalized formats preferred. In
 practice this means e.g. @ref Math::Vector2 "Math::Vector2<UnsignedByte>" will
 be understood as @ref PixelFormat::RG8Unorm and there's currently no way to
 interpret it as @ref PixelFormat::RG8UI, for example.
+
+@section DebugTools-CompareImage-performance Performance
+
+Deltas of 8- and 16-bit integer formats are calculated directly on integers
+with a loop that the compiler can vectorize, other formats are converted to
+floats first. For large images, such as screenshots in rendering regression
+tests, the calculation can be additionally split across multiple threads
+using @ref setThreadCount(). Passing @cpp 0 @ce uses all available cores:
+
+@snippet MagnumDebugTools.cpp CompareImage-threads
+
+The same option is available on @ref CompareImageFile, @ref CompareImageToFile
+and @ref CompareFileToImage as well. Regardless of the thread count, the
+calculated max and mean delta are always the same.
 */
 class CompareImage {
     public:
@@ -330,6 +346,22 @@ class CompareImage {
          */
         explicit CompareImage(): _c{0.0f, 0.0f} {}
 
+        /**
+         * @brief Set count of threads used for calculating the delta
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If @cpp 0 @ce, the value of
+         * @ref std::thread::hardware_concurrency() is used. Default is
+         * @cpp 1 @ce. Fewer threads are used for small images. The
+         * calculated max and mean delta don't depend on the thread count.
+         * See @ref DebugTools-CompareImage-performance for more information.
+         */
+        CompareImage& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImage>& comparator() {
             return _c;
@@ -436,6 +468,18 @@ class CompareImageFile {
          */
         explicit CompareImageFile(): _c{nullptr, nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set count of threads used for calculating the delta
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref CompareImage::setThreadCount() for more information.
+         */
+        CompareImageFile& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImageFile>& comparator() {
             return _c;
@@ -499,6 +543,18 @@ class CompareImageToFile {
          */
         explicit CompareImageToFile(): _c{nullptr, nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set count of threads used for calculating the delta
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref CompareImage::setThreadCount() for more information.
+         */
+        CompareImageToFile& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareImageToFile>& comparator() {
             return _c;
@@ -554,6 +610,18 @@ class CompareFileToImage {
          */
         explicit CompareFileToImage(): _c{nullptr, 0.0f, 0.0f} {}
 
+        /**
+         * @brief Set count of threads used for calculating the delta
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref CompareImage::setThreadCount() for more information.
+         */
+        CompareFileToImage& setThreadCount(UnsignedInt count) {
+            _c.setThreadCount(count);
+            return *this;
+        }
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         TestSuite::Comparator<CompareFileToImage>& comparator() {
             return _c;
@@ -582,6 +650,8 @@ template<> constexpr PixelFormat pixelFormatFor<Int>() { return PixelFormat::R32
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Int>>() { return PixelFormat::R32I; }
 template<> constexpr PixelFormat pixelFormatFor<Float>() { return PixelFormat::R32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Float>>() { return PixelFormat::R32F; }
+template<> constexpr PixelFormat pixelFormatFor<Half>() { return PixelFormat::R16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<1, Half>>() { return PixelFormat::R16F; }
 
 /* Two-component types */
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, UnsignedByte>>() { return PixelFormat::RG8Unorm; }
@@ -598,6 +668,8 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Int>>() { return
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Int>>() { return PixelFormat::RG32I; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Float>>() { return PixelFormat::RG32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Float>>() { return PixelFormat::RG32F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<2, Half>>() { return PixelFormat::RG16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector2<Half>>() { return PixelFormat::RG16F; }
 
 /* Three-component types */
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, UnsignedByte>>() { return PixelFormat::RGB8Unorm; }
@@ -620,6 +692,8 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Int>>() { return P
 /* Skipping Math::Color3<Int>, as that isn't much used */
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, Float>>() { return PixelFormat::RGB32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Float>>() { return PixelFormat::RGB32F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<3, Half>>() { return PixelFormat::RGB16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector3<Half>>() { return PixelFormat::RGB16F; }
 
 /* Four-component types */
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, UnsignedByte>>() { return PixelFormat::RGBA8Unorm; }
@@ -643,6 +717,9 @@ template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Int>>() { return P
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, Float>>() { return PixelFormat::RGBA32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Float>>() { return PixelFormat::RGBA32F; }
 template<> constexpr PixelFormat pixelFormatFor<Math::Color4<Float>>() { return PixelFormat::RGBA32F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector<4, Half>>() { return PixelFormat::RGBA16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Vector4<Half>>() { return PixelFormat::RGBA16F; }
+template<> constexpr PixelFormat pixelFormatFor<Math::Color4<Half>>() { return PixelFormat::RGBA16F; }
 /* LCOV_EXCL_STOP */
 
 }
@@ -0,0 +1,307 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DebugDraw.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/RingBuffer.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+struct Vertex {
+    Vector3 position;
+    Color4ub color;
+};
+
+static_assert(sizeof(Vertex) == 16, "improperly packed vertex");
+
+/* Edges of a [-1, 1] cube, in the same order as Primitives::cubeWireframe() */
+constexpr Vector3 CubeCorners[]{
+    {-1.0f, -1.0f,  1.0f},
+    { 1.0f, -1.0f,  1.0f},
+    { 1.0f,  1.0f,  1.0f},
+    {-1.0f,  1.0f,  1.0f},
+    {-1.0f,  1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    {-1.0f, -1.0f, -1.0f}
+};
+
+constexpr UnsignedByte CubeEdges[]{
+    0, 1, 1, 2, 2, 3, 3, 0, /* +Z */
+    4, 5, 5, 6, 6, 7, 7, 4, /* -Z */
+    1, 6, 2, 5,             /* +X */
+    0, 7, 3, 4              /* -X */
+};
+
+}
+
+struct DebugDraw::State {
+    explicit State(std::size_t bufferSize);
+
+    /* Two batches, first depth-tested, second not. Lifetimes are per line,
+       i.e. there's half as many as vertices. */
+    struct Batch {
+        Containers::Array<Vertex> vertices;
+        Containers::Array<Float> lifetimes;
+    } batches[2];
+
+    Float lifetime{};
+    bool depthTest{true};
+
+    Shaders::VertexColor3D shader;
+    GL::Mesh mesh{GL::MeshPrimitive::Lines};
+    GL::Buffer buffer{NoCreate};
+    #ifndef MAGNUM_TARGET_GLES
+    GL::RingBuffer ringBuffer{NoCreate};
+    /* Max vertex count in a single draw when streaming through the ring
+       buffer, a third of its size so three draws can be in flight */
+    std::size_t chunkVertexCount{};
+    #endif
+};
+
+DebugDraw::State::State(const std::size_t bufferSize) {
+    GL::Buffer* vertexBuffer;
+    #ifndef MAGNUM_TARGET_GLES
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>()) {
+        ringBuffer = GL::RingBuffer{bufferSize};
+        chunkVertexCount = bufferSize/3/sizeof(Vertex);
+        /* Round to whole lines */
+        chunkVertexCount -= chunkVertexCount % 2;
+        vertexBuffer = &ringBuffer.buffer();
+    } else
+    #else
+    static_cast<void>(bufferSize);
+    #endif
+    {
+        buffer = GL::Buffer{GL::Buffer::TargetHint::Array};
+        vertexBuffer = &buffer;
+    }
+
+    /* The offset is supplied through base vertex for every draw */
+    mesh.addVertexBuffer(*vertexBuffer, 0,
+        Shaders::VertexColor3D::Position{},
+        Shaders::VertexColor3D::Color4{
+            Shaders::VertexColor3D::Color4::DataType::UnsignedByte,
+            Shaders::VertexColor3D::Color4::DataOption::Normalized});
+}
+
+DebugDraw::DebugDraw(const std::size_t bufferSize) {
+    /* Three chunks with at least one line each */
+    CORRADE_ASSERT(bufferSize >= 3*2*sizeof(Vertex),
+        "DebugTools::DebugDraw: expected buffer size to be at least" << 3*2*sizeof(Vertex) << "bytes, got" << bufferSize, );
+    _state = Containers::pointer<State>(bufferSize);
+}
+
+DebugDraw::DebugDraw(NoCreateT) noexcept {}
+
+DebugDraw::DebugDraw(DebugDraw&&) noexcept = default;
+
+DebugDraw::~DebugDraw() = default;
+
+DebugDraw& DebugDraw::operator=(DebugDraw&&) noexcept = default;
+
+bool DebugDraw::isPersistentlyMapped() const {
+    #ifndef MAGNUM_TARGET_GLES
+    return _state->chunkVertexCount;
+    #else
+    return false;
+    #endif
+}
+
+std::size_t DebugDraw::lineCount() const {
+    return (_state->batches[0].vertices.size() + _state->batches[1].vertices.size())/2;
+}
+
+Float DebugDraw::lifetime() const { return _state->lifetime; }
+
+DebugDraw& DebugDraw::setLifetime(const Float seconds) {
+    _state->lifetime = seconds;
+    return *this;
+}
+
+bool DebugDraw::depthTest() const { return _state->depthTest; }
+
+DebugDraw& DebugDraw::setDepthTest(const bool enabled) {
+    _state->depthTest = enabled;
+    return *this;
+}
+
+DebugDraw& DebugDraw::addLine(const Vector3& a, const Vector3& b, const Color4& color) {
+    State::Batch& batch = _state->batches[_state->depthTest ? 0 : 1];
+    const Color4ub packed = Math::pack<Color4ub>(color);
+    arrayAppend(batch.vertices, {Vertex{a, packed}, Vertex{b, packed}});
+    arrayAppend(batch.lifetimes, _state->lifetime);
+    return *this;
+}
+
+DebugDraw& DebugDraw::addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Color4& color) {
+    CORRADE_ASSERT(positions.size() % 2 == 0,
+        "DebugTools::DebugDraw::addLines(): expected an even position count, got" << positions.size(), *this);
+
+    State::Batch& batch = _state->batches[_state->depthTest ? 0 : 1];
+    const Color4ub packed = Math::pack<Color4ub>(color);
+    const std::size_t vertexOffset = batch.vertices.size();
+    const std::size_t lineOffset = batch.lifetimes.size();
+    arrayResize(batch.vertices, vertexOffset + positions.size());
+    arrayResize(batch.lifetimes, lineOffset + positions.size()/2);
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        batch.vertices[vertexOffset + i] = Vertex{positions[i], packed};
+    for(std::size_t i = 0; i != positions.size()/2; ++i)
+        batch.lifetimes[lineOffset + i] = _state->lifetime;
+    return *this;
+}
+
+DebugDraw& DebugDraw::addLineStrips(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Color4& color) {
+    CORRADE_ASSERT(!offsets.empty(),
+        "DebugTools::DebugDraw::addLineStrips(): expected at least one offset", *this);
+    CORRADE_ASSERT(offsets[offsets.size() - 1] == positions.size(),
+        "DebugTools::DebugDraw::addLineStrips(): expected the last offset to be" << positions.size() << "but got" << offsets[offsets.size() - 1], *this);
+
+    /* Count the lines first to allocate just once */
+    std::size_t lineCount = 0;
+    for(std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        CORRADE_ASSERT(offsets[i] < offsets[i + 1],
+            "DebugTools::DebugDraw::addLineStrips(): offsets" << offsets[i] << "and" << offsets[i + 1] << "at index" << i << "are not increasing", *this);
+        lineCount += offsets[i + 1] - offsets[i] - 1;
+    }
+
+    State::Batch& batch = _state->batches[_state->depthTest ? 0 : 1];
+    const Color4ub packed = Math::pack<Color4ub>(color);
+    const std::size_t lineOffset = batch.lifetimes.size();
+    Vertex* out = arrayAppend(batch.vertices, Containers::NoInit, lineCount*2).data();
+    arrayResize(batch.lifetimes, lineOffset + lineCount);
+    for(std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+        for(std::size_t j = offsets[i] + 1; j != offsets[i + 1]; ++j) {
+            *out++ = Vertex{positions[j - 1], packed};
+            *out++ = Vertex{positions[j], packed};
+        }
+    }
+    for(std::size_t i = 0; i != lineCount; ++i)
+        batch.lifetimes[lineOffset + i] = _state->lifetime;
+    return *this;
+}
+
+DebugDraw& DebugDraw::addPoint(const Vector3& position, const Float size, const Color4& color) {
+    const Float halfSize = size*0.5f;
+    return addLine(position - Vector3::xAxis(halfSize), position + Vector3::xAxis(halfSize), color)
+        .addLine(position - Vector3::yAxis(halfSize), position + Vector3::yAxis(halfSize), color)
+        .addLine(position - Vector3::zAxis(halfSize), position + Vector3::zAxis(halfSize), color);
+}
+
+DebugDraw& DebugDraw::addBox(const Range3D& box, const Color4& color) {
+    return addBox(Matrix4::translation(box.center())*Matrix4::scaling(box.size()*0.5f), color);
+}
+
+DebugDraw& DebugDraw::addBox(const Matrix4& transformation, const Color4& color) {
+    Vector3 positions[Containers::arraySize(CubeEdges)];
+    for(std::size_t i = 0; i != Containers::arraySize(CubeEdges); ++i)
+        positions[i] = transformation.transformPoint(CubeCorners[CubeEdges[i]]);
+    return addLines(positions, color);
+}
+
+void DebugDraw::draw(const Matrix4& transformationProjectionMatrix) {
+    State& state = *_state;
+    state.shader.setTransformationProjectionMatrix(transformationProjectionMatrix);
+
+    for(std::size_t i = 0; i != Containers::arraySize(state.batches); ++i) {
+        const Containers::ArrayView<const Vertex> vertices = state.batches[i].vertices;
+        if(vertices.empty()) continue;
+
+        if(i == 0) GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+        else GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /* Stream through the ring buffer in chunks, fencing after each so
+           the allocations never overlap memory that's still being drawn
+           from */
+        if(state.chunkVertexCount) {
+            for(std::size_t offset = 0; offset < vertices.size(); offset += state.chunkVertexCount) {
+                const Containers::ArrayView<const Vertex> chunk = vertices.slice(offset, std::min(offset + state.chunkVertexCount, vertices.size()));
+                const GL::RingBuffer::Allocation allocation = state.ringBuffer.allocate(chunk.size()*sizeof(Vertex), sizeof(Vertex));
+                Utility::copy(Containers::arrayCast<const char>(chunk), allocation.data);
+                state.mesh.setCount(Int(chunk.size()))
+                    .setBaseVertex(Int(allocation.offset/sizeof(Vertex)));
+                state.shader.draw(state.mesh);
+                state.ringBuffer.fence();
+            }
+        } else
+        #endif
+        {
+            state.buffer.setData(vertices, GL::BufferUsage::StreamDraw);
+            state.mesh.setCount(Int(vertices.size()))
+                .setBaseVertex(0);
+            state.shader.draw(state.mesh);
+        }
+    }
+
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+}
+
+void DebugDraw::advance(const Float seconds) {
+    for(State::Batch& batch: _state->batches) {
+        /* Compact the surviving lines in place */
+        std::size_t out = 0;
+        for(std::size_t i = 0; i != batch.lifetimes.size(); ++i) {
+            const Float lifetime = batch.lifetimes[i] - seconds;
+            if(lifetime <= 0.0f) continue;
+
+            batch.lifetimes[out] = lifetime;
+            batch.vertices[out*2 + 0] = batch.vertices[i*2 + 0];
+            batch.vertices[out*2 + 1] = batch.vertices[i*2 + 1];
+            ++out;
+        }
+
+        arrayResize(batch.vertices, out*2);
+        arrayResize(batch.lifetimes, out);
+    }
+}
+
+void DebugDraw::clear() {
+    for(State::Batch& batch: _state->batches) {
+        arrayResize(batch.vertices, 0);
+        arrayResize(batch.lifetimes, 0);
+    }
+}
+
+}}
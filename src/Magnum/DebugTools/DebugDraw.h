@@ -0,0 +1,249 @@
+#ifndef Magnum_DebugTools_DebugDraw_h
+#define Magnum_DebugTools_DebugDraw_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::DebugDraw
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/Math/Color.h"
+
+#ifdef MAGNUM_TARGET_GL
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Batched line, point and box renderer
+@m_since_latest
+
+Immediate-mode-style drawing of large amounts of debug geometry, such as
+navigation meshes, physics contacts or bounding boxes. Instead of creating a
+mesh for every line, all primitives added with @ref addLine(), @ref addLines(),
+@ref addLineStrips(), @ref addPoint() and @ref addBox() are accumulated in a CPU-side array and
+uploaded and drawn at once with a @ref Shaders::VertexColor3D shader in
+@ref draw():
+
+@snippet MagnumDebugTools-gl.cpp DebugDraw-usage
+
+@section DebugTools-DebugDraw-lifetime Primitive lifetime and depth test
+
+By default, a primitive is drawn only in the first @ref draw() after it was
+added and is discarded in the following @ref advance() call. Primitives added
+after a call to @ref setLifetime() with a positive value stay for the given
+amount of time instead, with @ref advance() counting it down. Similarly,
+primitives added after calling @ref setDepthTest() with @cpp false @ce are
+drawn on top of the scene, ignoring the depth buffer.
+
+@section DebugTools-DebugDraw-streaming Data streaming
+
+On desktop GL with @gl_extension{ARB,buffer_storage} available, the vertex data
+are streamed through a persistently mapped @ref GL::RingBuffer of the size
+passed to the constructor. If the data don't fit into a third of it, they're
+split into multiple draws, each guarded by a fence so the GPU never reads
+memory that's being overwritten. Elsewhere the data are uploaded with
+@ref GL::Buffer::setData() in a single draw for each depth test setting.
+Each line takes 32 bytes of the buffer.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" and `WITH_SCENEGRAPH` enabled (done by
+    default). See @ref building-features for more information.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT DebugDraw {
+    public:
+        /**
+         * @brief Constructor
+         * @param bufferSize    Size of the streaming buffer in bytes
+         *
+         * The @p bufferSize is used only if the persistently mapped buffer is
+         * used, see @ref DebugTools-DebugDraw-streaming for more information.
+         * Expects that it's large enough for at least three lines.
+         */
+        explicit DebugDraw(std::size_t bufferSize = 4*1024*1024);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit DebugDraw(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        DebugDraw(const DebugDraw&) = delete;
+
+        /** @brief Move constructor */
+        DebugDraw(DebugDraw&&) noexcept;
+
+        ~DebugDraw();
+
+        /** @brief Copying is not allowed */
+        DebugDraw& operator=(const DebugDraw&) = delete;
+
+        /** @brief Move assignment */
+        DebugDraw& operator=(DebugDraw&&) noexcept;
+
+        /**
+         * @brief Whether the data are streamed through a persistently mapped buffer
+         *
+         * See @ref DebugTools-DebugDraw-streaming for more information.
+         */
+        bool isPersistentlyMapped() const;
+
+        /**
+         * @brief Count of lines that will be drawn
+         *
+         * Points and boxes are counted as the lines they're made of.
+         */
+        std::size_t lineCount() const;
+
+        /** @brief Lifetime of newly added primitives */
+        Float lifetime() const;
+
+        /**
+         * @brief Set lifetime of newly added primitives
+         * @return Reference to self (for method chaining)
+         *
+         * In seconds, counted down by @ref advance(). Default is
+         * @cpp 0.0f @ce, meaning the primitives are discarded in the first
+         * @ref advance() call after they were added.
+         */
+        DebugDraw& setLifetime(Float seconds);
+
+        /** @brief Whether newly added primitives are depth tested */
+        bool depthTest() const;
+
+        /**
+         * @brief Set whether newly added primitives are depth tested
+         * @return Reference to self (for method chaining)
+         *
+         * Default is @cpp true @ce.
+         */
+        DebugDraw& setDepthTest(bool enabled);
+
+        /**
+         * @brief Add a line
+         * @return Reference to self (for method chaining)
+         */
+        DebugDraw& addLine(const Vector3& a, const Vector3& b, const Color4& color);
+
+        /**
+         * @brief Add lines
+         * @return Reference to self (for method chaining)
+         *
+         * Every two consecutive items of @p positions form a line. Expects
+         * that the position count is even.
+         */
+        DebugDraw& addLines(const Containers::StridedArrayView1D<const Vector3>& positions, const Color4& color);
+
+        /**
+         * @brief Add line strips
+         * @return Reference to self (for method chaining)
+         *
+         * Strip @cpp i @ce connects consecutive items of @p positions from
+         * @cpp offsets[i] @ce to @cpp offsets[i + 1] - 1 @ce, a strip with
+         * @f$ n @f$ vertices being drawn as @f$ n - 1 @f$ lines. The layout
+         * matches output of @ref MeshTools::flattenCurvesOffsetsInto() and
+         * @ref MeshTools::flattenCurvesInto(), so flattened curves can be
+         * added directly:
+         *
+         * @snippet MagnumDebugTools-gl.cpp DebugDraw-addLineStrips
+         *
+         * Expects that @p offsets are non-empty, monotonically increasing
+         * and the last item is equal to @p positions size.
+         */
+        DebugDraw& addLineStrips(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Color4& color);
+
+        /**
+         * @brief Add a point
+         * @return Reference to self (for method chaining)
+         *
+         * Drawn as three axis-aligned lines of length @p size crossing at
+         * @p position, as point size isn't controllable on all platforms.
+         */
+        DebugDraw& addPoint(const Vector3& position, Float size, const Color4& color);
+
+        /**
+         * @brief Add an axis-aligned box
+         * @return Reference to self (for method chaining)
+         *
+         * Drawn as twelve lines of the box edges.
+         */
+        DebugDraw& addBox(const Range3D& box, const Color4& color);
+
+        /**
+         * @brief Add a transformed box
+         * @return Reference to self (for method chaining)
+         *
+         * Draws edges of a cube from @cpp {-1.0f, -1.0f, -1.0f} @ce to
+         * @cpp {1.0f, 1.0f, 1.0f} @ce transformed with @p transformation,
+         * consistently with @ref Primitives::cubeWireframe().
+         */
+        DebugDraw& addBox(const Matrix4& transformation, const Color4& color);
+
+        /**
+         * @brief Draw all primitives
+         *
+         * Draws depth-tested primitives first with
+         * @ref GL::Renderer::Feature::DepthTest enabled, then the rest with
+         * depth test disabled. The depth test is left enabled afterwards.
+         * The primitives are kept until the next @ref advance() call, so
+         * it's possible to draw them into multiple views.
+         */
+        void draw(const Matrix4& transformationProjectionMatrix);
+
+        /**
+         * @brief Advance the time
+         *
+         * Subtracts @p seconds from the lifetime of all primitives and
+         * discards the ones that don't have any lifetime left. Call once per
+         * frame after all @ref draw() calls.
+         */
+        void advance(Float seconds);
+
+        /**
+         * @brief Discard all primitives
+         *
+         * Discards primitives regardless of their lifetime.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -36,7 +36,28 @@ namespace Magnum { namespace DebugTools {
 #ifndef DOXYGEN_GENERATING_OUTPUT
 class Profiler;
 
+class DynamicResolution;
+class FrameProfiler;
+
 #ifdef MAGNUM_TARGET_GL
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class AsyncReadback;
+class ObjectPicker;
+#endif
+
+class DebugDraw;
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+class GLDynamicResolution;
+#endif
+class GLFrameProfiler;
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt> class DrawableStatistics;
+typedef DrawableStatistics<2> DrawableStatistics2D;
+typedef DrawableStatistics<3> DrawableStatistics3D;
+#endif
+
 template<UnsignedInt> class ForceRenderer;
 typedef ForceRenderer<2> ForceRenderer2D;
 typedef ForceRenderer<3> ForceRenderer3D;
@@ -0,0 +1,247 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "DrawableStatistics.h"
+
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StaticArray.h>
+
+#include "Magnum/DebugTools/ColorMap.h"
+#include "Magnum/GL/AbstractFramebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/PipelineStatisticsQuery.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/SampleQuery.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Square.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+struct Queries {
+    explicit Queries():
+        verticesSubmitted{GL::PipelineStatisticsQuery::Target::VerticesSubmitted},
+        vertexShaderInvocations{GL::PipelineStatisticsQuery::Target::VertexShaderInvocations},
+        clippingInputPrimitives{GL::PipelineStatisticsQuery::Target::ClippingInputPrimitives},
+        clippingOutputPrimitives{GL::PipelineStatisticsQuery::Target::ClippingOutputPrimitives},
+        samplesPassed{GL::SampleQuery::Target::SamplesPassed} {}
+
+    GL::PipelineStatisticsQuery verticesSubmitted,
+        vertexShaderInvocations,
+        clippingInputPrimitives,
+        clippingOutputPrimitives;
+    GL::SampleQuery samplesPassed;
+};
+
+}
+
+template<UnsignedInt dimensions> struct DrawableStatistics<dimensions>::State {
+    Containers::Array<Entry> entries;
+    std::unordered_map<const SceneGraph::Drawable<dimensions, Float>*, std::string> names;
+    std::unordered_map<std::string, std::size_t> namedEntries;
+    std::unordered_map<const SceneGraph::Drawable<dimensions, Float>*, std::size_t> unnamedEntries;
+    /* Grown to the largest drawable count seen so far, queries for all
+       drawables are issued first and retrieved only after the whole group is
+       drawn to avoid stalling after every drawable */
+    Containers::Array<Queries> queries;
+    UnsignedInt drawCount{};
+
+    /* Created on first drawOverdraw() call */
+    Containers::Optional<GL::Mesh> square;
+    Containers::Optional<Shaders::Flat2D> shader;
+};
+
+template<UnsignedInt dimensions> Double DrawableStatistics<dimensions>::Entry::vertexFetchRatio() const {
+    return verticesSubmitted ? Double(vertexShaderInvocations)/Double(verticesSubmitted) : 0.0;
+}
+
+template<UnsignedInt dimensions> Double DrawableStatistics<dimensions>::Entry::primitiveClipRatio() const {
+    return clippingInputPrimitives ? 1.0 - Double(clippingOutputPrimitives)/Double(clippingInputPrimitives) : 0.0;
+}
+
+template<UnsignedInt dimensions> DrawableStatistics<dimensions>::DrawableStatistics(): _state{Containers::pointer<State>()} {}
+
+template<UnsignedInt dimensions> DrawableStatistics<dimensions>::DrawableStatistics(DrawableStatistics<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> DrawableStatistics<dimensions>::~DrawableStatistics() = default;
+
+template<UnsignedInt dimensions> DrawableStatistics<dimensions>& DrawableStatistics<dimensions>::operator=(DrawableStatistics<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> DrawableStatistics<dimensions>& DrawableStatistics<dimensions>::setName(const SceneGraph::Drawable<dimensions, Float>& drawable, const std::string& name) {
+    if(name.empty()) _state->names.erase(&drawable);
+    else _state->names[&drawable] = name;
+    return *this;
+}
+
+template<UnsignedInt dimensions> void DrawableStatistics<dimensions>::draw(SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& group) {
+    State& state = *_state;
+
+    const std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable<dimensions, Float>>, MatrixTypeFor<dimensions, Float>>> drawableTransformations = camera.drawableTransformations(group);
+    for(std::size_t i = state.queries.size(); i < drawableTransformations.size(); ++i)
+        arrayAppend(state.queries, InPlaceInit);
+
+    /* Draw everything, wrapping each drawable in its own set of queries */
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        Queries& queries = state.queries[i];
+        queries.verticesSubmitted.begin();
+        queries.vertexShaderInvocations.begin();
+        queries.clippingInputPrimitives.begin();
+        queries.clippingOutputPrimitives.begin();
+        queries.samplesPassed.begin();
+
+        drawableTransformations[i].first.get().draw(drawableTransformations[i].second, camera);
+
+        queries.samplesPassed.end();
+        queries.clippingOutputPrimitives.end();
+        queries.clippingInputPrimitives.end();
+        queries.vertexShaderInvocations.end();
+        queries.verticesSubmitted.end();
+    }
+
+    /* Retrieve the results, blocking until they're available */
+    for(std::size_t i = 0; i != drawableTransformations.size(); ++i) {
+        const SceneGraph::Drawable<dimensions, Float>* const drawable = &drawableTransformations[i].first.get();
+
+        /* Find the entry or create a new one */
+        std::size_t id;
+        const auto foundName = state.names.find(drawable);
+        if(foundName != state.names.end()) {
+            const auto found = state.namedEntries.find(foundName->second);
+            if(found != state.namedEntries.end()) id = found->second;
+            else {
+                id = state.entries.size();
+                arrayAppend(state.entries, Entry{foundName->second, nullptr, 0, 0, 0, 0, 0, 0});
+                state.namedEntries.emplace(foundName->second, id);
+            }
+        } else {
+            const auto found = state.unnamedEntries.find(drawable);
+            if(found != state.unnamedEntries.end()) id = found->second;
+            else {
+                id = state.entries.size();
+                arrayAppend(state.entries, Entry{{}, drawable, 0, 0, 0, 0, 0, 0});
+                state.unnamedEntries.emplace(drawable, id);
+            }
+        }
+
+        Queries& queries = state.queries[i];
+        Entry& entry = state.entries[id];
+        ++entry.drawCount;
+        entry.verticesSubmitted += queries.verticesSubmitted.result<UnsignedLong>();
+        entry.vertexShaderInvocations += queries.vertexShaderInvocations.result<UnsignedLong>();
+        entry.clippingInputPrimitives += queries.clippingInputPrimitives.result<UnsignedLong>();
+        entry.clippingOutputPrimitives += queries.clippingOutputPrimitives.result<UnsignedLong>();
+        entry.samplesPassed += queries.samplesPassed.result<UnsignedLong>();
+    }
+
+    ++state.drawCount;
+}
+
+template<UnsignedInt dimensions> void DrawableStatistics<dimensions>::drawOverdraw(GL::AbstractFramebuffer& framebuffer, SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& group, const UnsignedInt maxOverdraw) {
+    CORRADE_ASSERT(maxOverdraw >= 1 && maxOverdraw <= 255,
+        "DebugTools::DrawableStatistics::drawOverdraw(): expected max overdraw to be in range [1, 255] but got" << maxOverdraw, );
+
+    State& state = *_state;
+    if(!state.square) {
+        state.square = MeshTools::compile(Primitives::squareSolid());
+        state.shader.emplace();
+    }
+
+    /* Count all fragments in the stencil buffer, independently of whether
+       they pass the depth test or not */
+    framebuffer.clearStencil(0)
+        .clear(GL::FramebufferClear::Stencil);
+    GL::Renderer::enable(GL::Renderer::Feature::StencilTest);
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+    GL::Renderer::setColorMask(false, false, false, false);
+    GL::Renderer::setDepthMask(false);
+    GL::Renderer::setStencilFunction(GL::Renderer::StencilFunction::Always, 0, 0xff);
+    GL::Renderer::setStencilOperation(GL::Renderer::StencilOperation::Keep, GL::Renderer::StencilOperation::Increment, GL::Renderer::StencilOperation::Increment);
+    camera.draw(group);
+
+    /* Color each overdraw level with a fullscreen quad, the last level
+       includes also everything above it */
+    GL::Renderer::setColorMask(true, true, true, true);
+    GL::Renderer::setStencilOperation(GL::Renderer::StencilOperation::Keep, GL::Renderer::StencilOperation::Keep, GL::Renderer::StencilOperation::Keep);
+    const Containers::StaticArrayView<256, const Vector3ub> map = ColorMap::turbo();
+    for(UnsignedInt i = 1; i <= maxOverdraw; ++i) {
+        GL::Renderer::setStencilFunction(i == maxOverdraw ?
+            GL::Renderer::StencilFunction::LessOrEqual :
+            GL::Renderer::StencilFunction::Equal, i, 0xff);
+        state.shader->setColor(Math::unpack<Color3>(map[i*255/maxOverdraw]))
+            .draw(*state.square);
+    }
+
+    /* Reset the state back to defaults */
+    GL::Renderer::setStencilFunction(GL::Renderer::StencilFunction::Always, 0, 0xffffffffu);
+    GL::Renderer::setDepthMask(true);
+    GL::Renderer::disable(GL::Renderer::Feature::StencilTest);
+}
+
+template<UnsignedInt dimensions> Containers::ArrayView<const typename DrawableStatistics<dimensions>::Entry> DrawableStatistics<dimensions>::entries() const {
+    return _state->entries;
+}
+
+template<UnsignedInt dimensions> Color3ub DrawableStatistics<dimensions>::heatmapColor(const std::size_t id) const {
+    CORRADE_ASSERT(id < _state->entries.size(),
+        "DebugTools::DrawableStatistics::heatmapColor(): index" << id << "out of range for" << _state->entries.size() << "entries", {});
+
+    UnsignedLong max = 0;
+    for(const Entry& entry: _state->entries)
+        max = Math::max(max, entry.samplesPassed);
+
+    const std::size_t index = max ? _state->entries[id].samplesPassed*255/max : 0;
+    return Color3ub{ColorMap::turbo()[index]};
+}
+
+template<UnsignedInt dimensions> Double DrawableStatistics<dimensions>::averageOverdraw(const Vector2i& viewportSize) const {
+    const UnsignedLong pixelCount = UnsignedLong(viewportSize.product())*_state->drawCount;
+    if(!pixelCount) return 0.0;
+
+    UnsignedLong samplesPassed = 0;
+    for(const Entry& entry: _state->entries)
+        samplesPassed += entry.samplesPassed;
+    return Double(samplesPassed)/Double(pixelCount);
+}
+
+template<UnsignedInt dimensions> void DrawableStatistics<dimensions>::clear() {
+    arrayResize(_state->entries, 0);
+    _state->namedEntries.clear();
+    _state->unnamedEntries.clear();
+    _state->drawCount = 0;
+}
+
+template class MAGNUM_DEBUGTOOLS_EXPORT DrawableStatistics<2>;
+template class MAGNUM_DEBUGTOOLS_EXPORT DrawableStatistics<3>;
+
+}}
@@ -0,0 +1,303 @@
+#ifndef Magnum_DebugTools_DrawableStatistics_h
+#define Magnum_DebugTools_DrawableStatistics_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::DrawableStatistics, typedef @ref Magnum::DebugTools::DrawableStatistics2D, @ref Magnum::DebugTools::DrawableStatistics3D
+ * @m_since_latest
+ */
+#endif
+
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Per-drawable pipeline statistics and overdraw visualization
+@m_since_latest
+
+While @ref GLFrameProfiler::Value::VertexFetchRatio and
+@ref GLFrameProfiler::Value::PrimitiveClipRatio report numbers for the whole
+frame, this class wraps each draw of a @ref SceneGraph::DrawableGroup in
+@ref GL::PipelineStatisticsQuery and @ref GL::SampleQuery instances, making
+it possible to find which drawables are the offenders.
+
+@section DebugTools-DrawableStatistics-usage Usage
+
+Call @ref draw() in place of @ref SceneGraph::Camera::draw(). Drawables
+sharing the same mesh and shader can be aggregated together by giving them
+the same name with @ref setName(), unnamed drawables get a separate entry
+each. The statistics accumulate over all @ref draw() calls until
+@ref clear() is called:
+
+@snippet MagnumDebugTools-gl.cpp DrawableStatistics-usage
+
+As the query results are retrieved right after the group is drawn, the
+@ref draw() call stalls the pipeline. This class is thus meant for debugging
+sessions, not for always-on profiling.
+
+@section DebugTools-DrawableStatistics-overdraw Overdraw visualization
+
+The @ref drawOverdraw() function draws the group with color and depth writes
+disabled and counts the fragments generated for each pixel in the stencil
+buffer. The counts are then visualized on top of the framebuffer contents
+using a @ref ColorMap, from zero overdraw to @p maxOverdraw and above. For
+this the framebuffer is required to have a stencil attachment. Per-drawable
+overdraw can be compared through @ref Entry::samplesPassed, and
+@ref heatmapColor() maps it to a color as well, suitable for example for
+tinting the offending drawables with @ref Shaders::Flat::setColor() or
+@ref Shaders::MeshVisualizer3D::setColor().
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" and `WITH_SCENEGRAPH` enabled (done by
+    default). See @ref building-features for more information.
+
+@requires_gl46 Extension @gl_extension{ARB,pipeline_statistics_query}
+@requires_gl Pipeline statistics queries are not available in OpenGL ES or
+    WebGL.
+@see @ref DrawableStatistics2D, @ref DrawableStatistics3D
+*/
+template<UnsignedInt dimensions> class MAGNUM_DEBUGTOOLS_EXPORT DrawableStatistics {
+    public:
+        /**
+         * @brief Statistics entry
+         *
+         * Accumulated for all draws of drawables with the same name, or of a
+         * single unnamed drawable.
+         */
+        struct Entry {
+            /**
+             * @brief Name
+             *
+             * Empty for unnamed drawables.
+             */
+            std::string name;
+
+            /**
+             * @brief Drawable
+             *
+             * The drawable for an unnamed entry, @cpp nullptr @ce for named
+             * entries.
+             */
+            const SceneGraph::Drawable<dimensions, Float>* drawable;
+
+            /** @brief Count of draws */
+            UnsignedInt drawCount;
+
+            /**
+             * @brief Vertices submitted
+             *
+             * @see @ref GL::PipelineStatisticsQuery::Target::VerticesSubmitted
+             */
+            UnsignedLong verticesSubmitted;
+
+            /**
+             * @brief Vertex shader invocations
+             *
+             * @see @ref GL::PipelineStatisticsQuery::Target::VertexShaderInvocations
+             */
+            UnsignedLong vertexShaderInvocations;
+
+            /**
+             * @brief Primitives entering the clipping stage
+             *
+             * @see @ref GL::PipelineStatisticsQuery::Target::ClippingInputPrimitives
+             */
+            UnsignedLong clippingInputPrimitives;
+
+            /**
+             * @brief Primitives leaving the clipping stage
+             *
+             * @see @ref GL::PipelineStatisticsQuery::Target::ClippingOutputPrimitives
+             */
+            UnsignedLong clippingOutputPrimitives;
+
+            /**
+             * @brief Samples passed
+             *
+             * Count of samples passing the depth and stencil test.
+             * @see @ref GL::SampleQuery::Target::SamplesPassed
+             */
+            UnsignedLong samplesPassed;
+
+            /**
+             * @brief Vertex fetch ratio
+             *
+             * Ratio of @ref vertexShaderInvocations to
+             * @ref verticesSubmitted, same as
+             * @ref GLFrameProfiler::Value::VertexFetchRatio. The lower the
+             * value is, the better the mesh is optimized for post-transform
+             * vertex cache. Returns @cpp 0.0 @ce if no vertices were
+             * submitted.
+             */
+            Double vertexFetchRatio() const;
+
+            /**
+             * @brief Primitive clip ratio
+             *
+             * Ratio of primitives discarded by the clipping stage to
+             * @ref clippingInputPrimitives, same as
+             * @ref GLFrameProfiler::Value::PrimitiveClipRatio. Returns
+             * @cpp 0.0 @ce if no primitives were submitted.
+             */
+            Double primitiveClipRatio() const;
+        };
+
+        /**
+         * @brief Constructor
+         *
+         * Expects an active OpenGL context. The queries are created lazily
+         * in the first @ref draw() call.
+         */
+        explicit DrawableStatistics();
+
+        /** @brief Copying is not allowed */
+        DrawableStatistics(const DrawableStatistics<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        DrawableStatistics(DrawableStatistics<dimensions>&&) noexcept;
+
+        ~DrawableStatistics();
+
+        /** @brief Copying is not allowed */
+        DrawableStatistics<dimensions>& operator=(const DrawableStatistics<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        DrawableStatistics<dimensions>& operator=(DrawableStatistics<dimensions>&&) noexcept;
+
+        /**
+         * @brief Set drawable name
+         * @return Reference to self (for method chaining)
+         *
+         * Drawables with the same name are aggregated into a single
+         * @ref Entry, which is useful for example for drawables sharing the
+         * same mesh and shader. Passing an empty string makes the drawable
+         * unnamed again. Affects only subsequent @ref draw() calls.
+         */
+        DrawableStatistics<dimensions>& setName(const SceneGraph::Drawable<dimensions, Float>& drawable, const std::string& name);
+
+        /**
+         * @brief Draw a drawable group with statistics collection
+         *
+         * Equivalent to @ref SceneGraph::Camera::draw(SceneGraph::DrawableGroup<dimensions, T>&),
+         * except that each drawable is wrapped in pipeline statistics and
+         * sample queries, which are then retrieved and accumulated to
+         * @ref entries(). Stalls the pipeline until all queries are done.
+         */
+        void draw(SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& group);
+
+        /**
+         * @brief Draw an overdraw heatmap of a drawable group
+         * @param framebuffer   Framebuffer to draw to. Expected to be bound
+         *      and have a stencil attachment.
+         * @param camera        Camera
+         * @param group         Drawable group
+         * @param maxOverdraw   Fragment count per pixel that maps to the end
+         *      of the color map. Expected to be in range @f$ [1, 255] @f$.
+         *
+         * Clears the stencil buffer and draws the group with color and depth
+         * writes disabled, incrementing the stencil value for every
+         * generated fragment regardless of the depth test result. Then, for
+         * every fragment count, it draws a fullscreen quad with
+         * @ref ColorMap::turbo() color over pixels with that count. Pixels
+         * with no fragments are left untouched. Doesn't collect any
+         * statistics.
+         *
+         * Stencil test, stencil function and operation, color mask, depth
+         * mask and depth test are left in their default state after the
+         * call --- stencil and depth test disabled, all writes enabled.
+         */
+        void drawOverdraw(GL::AbstractFramebuffer& framebuffer, SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& group, UnsignedInt maxOverdraw = 16);
+
+        /**
+         * @brief Collected entries
+         *
+         * In order in which the drawables or names were first drawn. The
+         * view is invalidated by subsequent calls to @ref draw() and
+         * @ref clear().
+         */
+        Containers::ArrayView<const Entry> entries() const;
+
+        /**
+         * @brief Heatmap color for given entry
+         *
+         * Maps @ref Entry::samplesPassed of entry @p id relative to the
+         * maximum across all entries through @ref ColorMap::turbo(). Expects
+         * that @p id is less than size of @ref entries().
+         */
+        Color3ub heatmapColor(std::size_t id) const;
+
+        /**
+         * @brief Average overdraw
+         *
+         * Total @ref Entry::samplesPassed of all entries divided by product
+         * of @p viewportSize and the number of @ref draw() calls. Ideal
+         * value is @cpp 1.0 @ce with an opaque background-covering scene,
+         * values above indicate how many times on average is a pixel
+         * touched. Returns @cpp 0.0 @ce if nothing was drawn.
+         */
+        Double averageOverdraw(const Vector2i& viewportSize) const;
+
+        /**
+         * @brief Clear collected statistics
+         *
+         * Drawable names set with @ref setName() are kept.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Two-dimensional drawable statistics
+@m_since_latest
+*/
+typedef DrawableStatistics<2> DrawableStatistics2D;
+
+/**
+@brief Three-dimensional drawable statistics
+@m_since_latest
+*/
+typedef DrawableStatistics<3> DrawableStatistics3D;
+
+}}
+#else
+#error this header is available only in the desktop OpenGL build
+#endif
+
+#endif
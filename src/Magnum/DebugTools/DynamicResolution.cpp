@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DynamicResolution.h"
+
+#include <cmath>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include "Magnum/DebugTools/FrameProfiler.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Range.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+DynamicResolution::DynamicResolution(const Double targetDuration, const Float minScale, const Float maxScale): _targetDuration{targetDuration}, _minScale{minScale}, _maxScale{maxScale}, _scale{maxScale} {
+    CORRADE_ASSERT(targetDuration > 0.0,
+        "DebugTools::DynamicResolution: expected a positive target duration, got" << targetDuration, );
+    CORRADE_ASSERT(minScale > 0.0f && minScale <= maxScale && maxScale <= 1.0f,
+        "DebugTools::DynamicResolution: expected 0 < minScale <= maxScale <= 1, got" << minScale << "and" << maxScale, );
+}
+
+DynamicResolution& DynamicResolution::setTargetDuration(const Double duration) {
+    CORRADE_ASSERT(duration > 0.0,
+        "DebugTools::DynamicResolution::setTargetDuration(): expected a positive duration, got" << duration, *this);
+    _targetDuration = duration;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setHysteresis(const Float hysteresis) {
+    CORRADE_ASSERT(hysteresis >= 0.0f && hysteresis < 1.0f,
+        "DebugTools::DynamicResolution::setHysteresis(): expected a value in range [0, 1), got" << hysteresis, *this);
+    _hysteresis = hysteresis;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setCooldown(const UnsignedInt frames) {
+    _cooldown = frames;
+    return *this;
+}
+
+DynamicResolution& DynamicResolution::setScale(const Float scale) {
+    CORRADE_ASSERT(scale >= _minScale && scale <= _maxScale,
+        "DebugTools::DynamicResolution::setScale(): expected a value between" << _minScale << "and" << _maxScale << Debug::nospace << ", got" << scale, *this);
+    _scale = scale;
+    _cooldownRemaining = _cooldown;
+    return *this;
+}
+
+Vector2i DynamicResolution::scaledSize(const Vector2i& size) const {
+    return Math::max(Vector2i{Math::round(Vector2{size}*_scale)}, Vector2i{1});
+}
+
+bool DynamicResolution::update(const Double duration) {
+    if(duration <= 0.0) return false;
+
+    /* The measurement was likely done with the previous scale */
+    if(_cooldownRemaining) {
+        --_cooldownRemaining;
+        return false;
+    }
+
+    /* Inside the hysteresis band, nothing to do */
+    if(duration <= _targetDuration && duration >= _targetDuration*(1.0 - Double(_hysteresis)))
+        return false;
+
+    /* The duration is proportional to the pixel count, which is a square of
+       the scale. Aim for the middle of the band. */
+    const Double middle = _targetDuration*(1.0 - 0.5*Double(_hysteresis));
+    const Float scale = Math::clamp(Float(_scale*std::sqrt(middle/duration)), _minScale, _maxScale);
+    if(scale == _scale) return false;
+
+    _scale = scale;
+    _cooldownRemaining = _cooldown;
+    return true;
+}
+
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+struct GLDynamicResolution::GLState {
+    explicit GLState(GL::TextureFormat colorFormat, GL::RenderbufferFormat depthFormat): colorFormat{colorFormat}, depthFormat{depthFormat} {}
+
+    GL::TextureFormat colorFormat;
+    GL::RenderbufferFormat depthFormat;
+    Vector2i size;
+    GL::Texture2D color{NoCreate};
+    GL::Renderbuffer depth{NoCreate};
+    GL::Framebuffer framebuffer{NoCreate};
+};
+
+GLDynamicResolution::GLDynamicResolution(const Vector2i& size, const GL::TextureFormat colorFormat, const GL::RenderbufferFormat depthFormat, const Double targetDuration, const Float minScale, const Float maxScale): DynamicResolution{targetDuration, minScale, maxScale}, _glState{Containers::InPlaceInit, colorFormat, depthFormat} {
+    setSize(size);
+}
+
+GLDynamicResolution::GLDynamicResolution(GLDynamicResolution&&) noexcept = default;
+
+GLDynamicResolution::~GLDynamicResolution() = default;
+
+GLDynamicResolution& GLDynamicResolution::operator=(GLDynamicResolution&&) noexcept = default;
+
+Vector2i GLDynamicResolution::size() const { return _glState->size; }
+
+GLDynamicResolution& GLDynamicResolution::setSize(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "DebugTools::GLDynamicResolution::setSize(): expected a non-zero size, got" << size, *this);
+
+    /* Immutable storage can't be resized, so recreate everything */
+    GLState& state = *_glState;
+    state.size = size;
+    state.color = GL::Texture2D{};
+    state.color.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, state.colorFormat, size);
+    state.depth = GL::Renderbuffer{};
+    state.depth.setStorage(state.depthFormat, size);
+    state.framebuffer = GL::Framebuffer{{{}, size}};
+    state.framebuffer
+        .attachTexture(GL::Framebuffer::ColorAttachment{0}, state.color, 0)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, state.depth);
+    return *this;
+}
+
+Vector2i GLDynamicResolution::scaledSize() const {
+    return scaledSize(_glState->size);
+}
+
+bool GLDynamicResolution::update(const GLFrameProfiler& profiler) {
+    if(!profiler.isMeasurementAvailable(GLFrameProfiler::Value::GpuDuration))
+        return false;
+    return update(profiler.gpuDurationMean());
+}
+
+GL::Framebuffer& GLDynamicResolution::framebuffer() {
+    return _glState->framebuffer.setViewport({{}, scaledSize()});
+}
+
+GL::Texture2D& GLDynamicResolution::colorTexture() { return _glState->color; }
+
+void GLDynamicResolution::blit(GL::AbstractFramebuffer& destination) {
+    GL::AbstractFramebuffer::blit(_glState->framebuffer, destination,
+        {{}, scaledSize()}, destination.viewport(),
+        GL::FramebufferBlit::Color, GL::FramebufferBlitFilter::Linear);
+}
+#endif
+
+}}
@@ -0,0 +1,308 @@
+#ifndef Magnum_DebugTools_DynamicResolution_h
+#define Magnum_DebugTools_DynamicResolution_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::DynamicResolution, @ref Magnum::DebugTools::GLDynamicResolution
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/DebugTools.h"
+#include "Magnum/DebugTools/visibility.h"
+
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/GL.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Dynamic resolution controller
+@m_since_latest
+
+Picks a render resolution scale each frame so GPU frame duration stays at a
+given target, which keeps the frame rate stable when the GPU gets slower, for
+example due to thermal throttling on mobile devices, or when the scene gets
+temporarily more complex. Feed it with measured GPU frame durations, for
+example from @ref GLFrameProfiler::gpuDurationMean(), and use @ref scale() to
+size the render target:
+
+@snippet MagnumDebugTools.cpp DynamicResolution-usage
+
+For an OpenGL implementation that manages the scaled framebuffer and upscales
+it to the final output see @ref GLDynamicResolution.
+
+@section DebugTools-DynamicResolution-algorithm The algorithm
+
+GPU duration is assumed to be roughly proportional to the pixel count, and
+thus to a square of the scale. If the measured duration is above
+@ref targetDuration(), or below it by more than @ref hysteresis(), the scale
+is changed so the expected duration gets into the middle of the hysteresis
+band, clamped to the @ref minScale() and @ref maxScale() range. Durations
+inside the band keep the scale unchanged, which prevents oscillation. As GPU
+measurements arrive with a delay, after each change the controller ignores the
+next @ref cooldown() measurements, which were likely made with the previous
+scale.
+
+@experimental
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT DynamicResolution {
+    public:
+        /**
+         * @brief Constructor
+         * @param targetDuration    Target GPU frame duration in nanoseconds.
+         *      Expected to be positive.
+         * @param minScale          Minimal scale
+         * @param maxScale          Maximal scale
+         *
+         * Expects that @cpp 0 < minScale <= maxScale <= 1 @ce. The initial
+         * @ref scale() is @p maxScale, @ref hysteresis() is @cpp 0.1f @ce
+         * and @ref cooldown() is @cpp 4 @ce.
+         */
+        explicit DynamicResolution(Double targetDuration, Float minScale = 0.5f, Float maxScale = 1.0f);
+
+        /** @brief Target GPU frame duration in nanoseconds */
+        Double targetDuration() const { return _targetDuration; }
+
+        /**
+         * @brief Set target GPU frame duration
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p duration is positive.
+         */
+        DynamicResolution& setTargetDuration(Double duration);
+
+        /** @brief Minimal scale */
+        Float minScale() const { return _minScale; }
+
+        /** @brief Maximal scale */
+        Float maxScale() const { return _maxScale; }
+
+        /**
+         * @brief Hysteresis
+         *
+         * Fraction of @ref targetDuration() below the target in which the
+         * scale isn't changed.
+         */
+        Float hysteresis() const { return _hysteresis; }
+
+        /**
+         * @brief Set hysteresis
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p hysteresis is in the @f$ [0, 1) @f$ range. Default
+         * is @cpp 0.1f @ce.
+         */
+        DynamicResolution& setHysteresis(Float hysteresis);
+
+        /**
+         * @brief Count of measurements ignored after a scale change
+         *
+         * @see @ref DebugTools-DynamicResolution-algorithm
+         */
+        UnsignedInt cooldown() const { return _cooldown; }
+
+        /**
+         * @brief Set count of measurements ignored after a scale change
+         * @return Reference to self (for method chaining)
+         *
+         * Should be at least the delay with which the durations are measured.
+         * For @ref GLFrameProfiler::Value::GpuDuration it's three frames, if
+         * you feed the controller with @ref GLFrameProfiler::gpuDurationMean(),
+         * add @ref FrameProfiler::maxFrameCount() to it as well. Default is
+         * @cpp 4 @ce.
+         */
+        DynamicResolution& setCooldown(UnsignedInt frames);
+
+        /** @brief Current scale */
+        Float scale() const { return _scale; }
+
+        /**
+         * @brief Set current scale
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p scale is between @ref minScale() and
+         * @ref maxScale(). Restarts the cooldown.
+         */
+        DynamicResolution& setScale(Float scale);
+
+        /**
+         * @brief Scale given size
+         *
+         * Returns @p size multiplied by @ref scale(), rounded to nearest and
+         * at least @cpp 1 @ce in each dimension.
+         */
+        Vector2i scaledSize(const Vector2i& size) const;
+
+        /**
+         * @brief Update the scale with a measured GPU frame duration
+         * @param duration  GPU frame duration in nanoseconds
+         * @return Whether the scale changed
+         *
+         * Expected to be called once a frame. Non-positive durations are
+         * treated as no measurement. See
+         * @ref DebugTools-DynamicResolution-algorithm for more information.
+         */
+        bool update(Double duration);
+
+    private:
+        Double _targetDuration;
+        Float _minScale, _maxScale, _scale, _hysteresis{0.1f};
+        UnsignedInt _cooldown{4}, _cooldownRemaining{};
+};
+
+#if defined(MAGNUM_TARGET_GL) && !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/**
+@brief OpenGL dynamic resolution
+@m_since_latest
+
+A @ref DynamicResolution that owns an offscreen framebuffer the scene gets
+rendered into and upscales its scaled area to the final output. The color and
+depth attachments are allocated for the full size so scale changes don't cause
+any reallocations, only the framebuffer viewport changes:
+
+@snippet MagnumDebugTools-gl.cpp GLDynamicResolution-usage
+
+The upscaling is done with a single
+@ref GL::AbstractFramebuffer::blit() "framebuffer blit" using linear
+filtering, which doesn't need any shader. For a custom upscaling filter, use
+@ref colorTexture() with a full-screen pass drawn with
+@ref MeshTools::fullScreenTriangle() instead of calling @ref blit(), taking
+@ref scaledSize() and @ref size() into account when calculating texture
+coordinates.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+
+@requires_gl30 Extension @gl_extension{ARB,framebuffer_object}
+@requires_gles30 Extension @gl_extension{ANGLE,framebuffer_blit} or
+    @gl_extension{NV,framebuffer_blit} in OpenGL ES 2.0.
+@requires_webgl20 Framebuffer blit is not available in WebGL 1.0.
+
+@experimental
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT GLDynamicResolution: public DynamicResolution {
+    public:
+        /**
+         * @brief Constructor
+         * @param size              Full framebuffer size
+         * @param colorFormat       Color texture format
+         * @param depthFormat       Depth renderbuffer format
+         * @param targetDuration    Target GPU frame duration in nanoseconds
+         * @param minScale          Minimal scale
+         * @param maxScale          Maximal scale
+         *
+         * See @ref DynamicResolution(Double, Float, Float) for more
+         * information. The color texture is attached to
+         * @ref GL::Framebuffer::ColorAttachment "color attachment" @cpp 0 @ce,
+         * the depth renderbuffer to
+         * @ref GL::Framebuffer::BufferAttachment::Depth. Expects that @p size
+         * is non-zero.
+         */
+        explicit GLDynamicResolution(const Vector2i& size, GL::TextureFormat colorFormat, GL::RenderbufferFormat depthFormat, Double targetDuration, Float minScale = 0.5f, Float maxScale = 1.0f);
+
+        /** @brief Copying is not allowed */
+        GLDynamicResolution(const GLDynamicResolution&) = delete;
+
+        /** @brief Move constructor */
+        GLDynamicResolution(GLDynamicResolution&&) noexcept;
+
+        ~GLDynamicResolution();
+
+        /** @brief Copying is not allowed */
+        GLDynamicResolution& operator=(const GLDynamicResolution&) = delete;
+
+        /** @brief Move assignment */
+        GLDynamicResolution& operator=(GLDynamicResolution&&) noexcept;
+
+        /** @brief Full framebuffer size */
+        Vector2i size() const;
+
+        /**
+         * @brief Set full framebuffer size
+         * @return Reference to self (for method chaining)
+         *
+         * Reallocates the attachments, for example when the window gets
+         * resized. Expects that @p size is non-zero.
+         */
+        GLDynamicResolution& setSize(const Vector2i& size);
+
+        /** @brief Scaled framebuffer size */
+        Vector2i scaledSize() const;
+
+        using DynamicResolution::scaledSize;
+        using DynamicResolution::update;
+
+        /**
+         * @brief Update the scale from a frame profiler
+         * @return Whether the scale changed
+         *
+         * If @ref GLFrameProfiler::Value::GpuDuration is available in
+         * @p profiler, calls @ref update(Double) with
+         * @ref GLFrameProfiler::gpuDurationMean(), otherwise does nothing and
+         * returns @cpp false @ce. Expects that the value is enabled in
+         * @p profiler.
+         */
+        bool update(const GLFrameProfiler& profiler);
+
+        /**
+         * @brief Offscreen framebuffer
+         *
+         * The viewport is updated to span @ref scaledSize() every time this
+         * function is called, so call it each frame before binding the
+         * framebuffer for rendering.
+         */
+        GL::Framebuffer& framebuffer();
+
+        /**
+         * @brief Color texture
+         *
+         * Of @ref size(), with only the bottom left @ref scaledSize() area
+         * being rendered to.
+         */
+        GL::Texture2D& colorTexture();
+
+        /**
+         * @brief Upscale to given framebuffer
+         *
+         * Blits the @ref scaledSize() area of the color attachment to the
+         * whole viewport of @p destination with linear filtering.
+         */
+        void blit(GL::AbstractFramebuffer& destination);
+
+    private:
+        struct GLState;
+        Containers::Pointer<GLState> _glState;
+};
+#endif
+
+}}
+
+#endif
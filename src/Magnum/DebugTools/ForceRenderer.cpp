@@ -25,6 +25,9 @@
 
 #include "ForceRenderer.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/DebugTools/ResourceManager.h"
 #include "Magnum/SceneGraph/Camera.h"
@@ -40,6 +43,23 @@ template<UnsignedInt dimensions> ResourceKey shaderKey();
 template<> inline ResourceKey shaderKey<2>() { return ResourceKey("FlatShader2D"); }
 template<> inline ResourceKey shaderKey<3>() { return ResourceKey("FlatShader3D"); }
 
+template<UnsignedInt> struct Instanced;
+template<> struct Instanced<2> {
+    static ResourceKey shader() { return {"FlatShaderVertexColorInstanced2D"}; }
+    static ResourceKey buffer() { return {"force-instances2d"}; }
+    static ResourceKey mesh() { return {"force-instanced2d"}; }
+};
+template<> struct Instanced<3> {
+    static ResourceKey shader() { return {"FlatShaderVertexColorInstanced3D"}; }
+    static ResourceKey buffer() { return {"force-instances3d"}; }
+    static ResourceKey mesh() { return {"force-instanced3d"}; }
+};
+
+template<UnsignedInt dimensions> struct InstanceData {
+    MatrixTypeFor<dimensions, Float> transformation;
+    Color4 color;
+};
+
 constexpr Vector2 positions[]{
     {0.0f,  0.0f},
     {1.0f,  0.0f},
@@ -86,6 +106,53 @@ template<UnsignedInt dimensions> void ForceRenderer<dimensions>::draw(const Matr
         .draw(*_mesh);
 }
 
+template<UnsignedInt dimensions> void ForceRenderer<dimensions>::drawInstanced(ResourceManager& manager, SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& drawables) {
+    /* Gather per-instance data of all force renderers in the group */
+    Containers::Array<InstanceData<dimensions>> instanceData;
+    for(const auto& drawableTransformation: camera.drawableTransformations(drawables)) {
+        auto* const renderer = dynamic_cast<ForceRenderer<dimensions>*>(&drawableTransformation.first.get());
+        if(!renderer) continue;
+
+        arrayAppend(instanceData, InstanceData<dimensions>{
+            Implementation::forceRendererTransformation<dimensions>(drawableTransformation.second.transformPoint(renderer->_forcePosition), renderer->_force)*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{renderer->_options->size()}),
+            renderer->_options->color()});
+    }
+    if(instanceData.empty()) return;
+
+    /* Shader */
+    Resource<GL::AbstractShaderProgram, Shaders::Flat<dimensions>> shader = manager.get<GL::AbstractShaderProgram, Shaders::Flat<dimensions>>(Instanced<dimensions>::shader());
+    if(!shader) manager.set<GL::AbstractShaderProgram>(shader.key(), new Shaders::Flat<dimensions>{Shaders::Flat<dimensions>::Flag::VertexColor|Shaders::Flat<dimensions>::Flag::InstancedTransformation});
+
+    /* Instance buffer, refilled every time */
+    Resource<GL::Buffer> instanceBuffer = manager.get<GL::Buffer>(Instanced<dimensions>::buffer());
+    if(!instanceBuffer) manager.set(instanceBuffer.key(), GL::Buffer{GL::Buffer::TargetHint::Array}, ResourceDataState::Final, ResourcePolicy::Manual);
+    instanceBuffer->setData(instanceData, GL::BufferUsage::DynamicDraw);
+
+    /* Mesh, the same as in the constructor but with the instance buffer
+       attached */
+    Resource<GL::Mesh> mesh = manager.get<GL::Mesh>(Instanced<dimensions>::mesh());
+    if(!mesh) {
+        GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+        vertexBuffer.setData(positions, GL::BufferUsage::StaticDraw);
+        GL::Buffer indexBuffer{GL::Buffer::TargetHint::ElementArray};
+        indexBuffer.setData(indices, GL::BufferUsage::StaticDraw);
+        GL::Mesh instancedMesh{GL::MeshPrimitive::Lines};
+        instancedMesh.setCount(Containers::arraySize(indices))
+            .addVertexBuffer(std::move(vertexBuffer), 0,
+                typename Shaders::Flat<dimensions>::Position(Shaders::Flat<dimensions>::Position::Components::Two))
+            .addVertexBufferInstanced(*instanceBuffer, 1, 0,
+                typename Shaders::Flat<dimensions>::TransformationMatrix{},
+                typename Shaders::Flat<dimensions>::Color4{})
+            .setIndexBuffer(std::move(indexBuffer), 0, GL::MeshIndexType::UnsignedByte, 0, Containers::arraySize(positions));
+        manager.set(mesh.key(), std::move(instancedMesh), ResourceDataState::Final, ResourcePolicy::Manual);
+    }
+    mesh->setInstanceCount(Int(instanceData.size()));
+
+    shader->setTransformationProjectionMatrix(camera.projectionMatrix())
+        .setColor(Color4{1.0f})
+        .draw(*mesh);
+}
+
 template class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer<2>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ForceRenderer<3>;
 
@@ -112,6 +112,16 @@ to it.
 
 @snippet MagnumDebugTools-gl.cpp ForceRenderer
 
+@section DebugTools-ForceRenderer-instanced Instanced drawing
+
+With many force renderers, drawing each of them separately through
+@ref SceneGraph::Camera::draw() results in one draw call per arrow. Put the
+renderers into a dedicated drawable group and draw it with
+@ref drawInstanced() instead, which uploads transformation and color of all of
+them into a single instance buffer and draws them in one instanced draw call:
+
+@snippet MagnumDebugTools-gl.cpp ForceRenderer-instanced
+
 @note This class is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL "TARGET_GL" and `WITH_SCENEGRAPH` enabled (done by
     default). See @ref building-features for more information.
@@ -155,6 +165,31 @@ template<UnsignedInt dimensions> class ForceRenderer: public SceneGraph::Drawabl
 
         ~ForceRenderer();
 
+        /**
+         * @brief Draw all force renderers in a group with a single draw call
+         * @param manager   Resource manager instance
+         * @param camera    Camera to draw with
+         * @param drawables Drawable group
+         * @m_since_latest
+         *
+         * Calculates transformations of all drawables in @p drawables
+         * relative to @p camera, puts transformation and color of each
+         * @ref ForceRenderer into a shared instance buffer and draws all of
+         * them in a single instanced draw call using a
+         * @ref Shaders::Flat shader with @ref Shaders::Flat::Flag::VertexColor
+         * and @ref Shaders::Flat::Flag::InstancedTransformation enabled.
+         * Drawables that aren't a @ref ForceRenderer are skipped, use a
+         * dedicated drawable group for the renderers. The output is the
+         * same as when calling @ref SceneGraph::Camera::draw() on the group.
+         * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+         *      @gl_extension{EXT,instanced_arrays} or
+         *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        static void drawInstanced(ResourceManager& manager, SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& drawables);
+
     private:
         void draw(const MatrixTypeFor<dimensions, Float>& transformationMatrix, SceneGraph::Camera<dimensions, Float>& camera) override;
 
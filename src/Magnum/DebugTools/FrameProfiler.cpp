@@ -25,21 +25,32 @@
 
 #include "FrameProfiler.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <sstream>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/Math/Functions.h"
 #ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Context.h"
 #include "Magnum/GL/TimeQuery.h"
 #ifndef MAGNUM_TARGET_GLES
 #include "Magnum/GL/PipelineStatisticsQuery.h"
 #endif
 #endif
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
+#endif
 
 namespace Magnum { namespace DebugTools {
 
@@ -286,6 +297,96 @@ Double FrameProfiler::measurementMean(const UnsignedInt id) const {
     return measurementMeanInternal(_measurements[id]);
 }
 
+UnsignedInt FrameProfiler::measurementAvailableFrameCount(const Measurement& measurement) const {
+    const UnsignedInt delay = Math::max(measurement._delay, 1u);
+    if(_measuredFrameCount < delay) return 0;
+    return Math::min(_measuredFrameCount - delay + 1, _maxFrameCount);
+}
+
+UnsignedLong FrameProfiler::measurementPercentile(const UnsignedInt id, const Double percentile) const {
+    CORRADE_ASSERT(id < _measurements.size(),
+        "DebugTools::FrameProfiler::measurementPercentile(): index" << id << "out of range for" << _measurements.size() << "measurements", {});
+    CORRADE_ASSERT(_measuredFrameCount >= Math::max(_measurements[id]._delay, 1u), "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after" << Math::max(_measurements[id]._delay, 1u) - _measuredFrameCount << "more frames", {});
+    CORRADE_ASSERT(percentile >= 0.0 && percentile <= 100.0,
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got" << percentile, {});
+
+    /* The data don't need to be in order, so just gather all available
+       values regardless of where the ring buffer starts */
+    const UnsignedInt count = measurementAvailableFrameCount(_measurements[id]);
+    Containers::Array<UnsignedLong> values{Containers::NoInit, count};
+    for(UnsignedInt i = 0; i != count; ++i)
+        values[i] = measurementData(id, i);
+
+    /* Nearest-rank method, the rank is 1-based */
+    const std::size_t rank = Math::max(std::size_t(std::ceil(percentile/100.0*count)), std::size_t{1});
+    UnsignedLong* const nth = values + rank - 1;
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+namespace {
+
+void appendCsvString(std::string& out, const std::string& string) {
+    if(string.find_first_of(",\"\n") == std::string::npos) {
+        out += string;
+        return;
+    }
+
+    out += '"';
+    for(const char c: string) {
+        if(c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+}
+
+std::string FrameProfiler::timeSeriesCsv() const {
+    std::string out = "Frame";
+    for(const Measurement& measurement: _measurements) {
+        out += ',';
+        appendCsvString(out, measurement._name);
+    }
+    out += '\n';
+
+    /* Data of a measurement with delay d for frame k (counted from 0) get
+       retrieved at the end of frame k + d - 1, so with M frames measured so
+       far the last available frame is M - d. The oldest row is the oldest
+       available frame among all measurements, the newest is M - 1 coming
+       from measurements with delay 1. */
+    Long first = _measuredFrameCount;
+    for(const Measurement& measurement: _measurements) {
+        const UnsignedInt count = measurementAvailableFrameCount(measurement);
+        if(!count) continue;
+        first = Math::min(first, Long(_measuredFrameCount) - Math::max(measurement._delay, 1u) - count + 1);
+    }
+
+    for(Long frame = first; frame < Long(_measuredFrameCount); ++frame) {
+        out += std::to_string(frame);
+        for(std::size_t i = 0; i != _measurements.size(); ++i) {
+            out += ',';
+            const UnsignedInt count = measurementAvailableFrameCount(_measurements[i]);
+            const Long measurementFirst = Long(_measuredFrameCount) - Math::max(_measurements[i]._delay, 1u) - count + 1;
+            if(frame < measurementFirst || frame >= measurementFirst + count)
+                continue;
+            out += std::to_string(measurementData(i, frame - measurementFirst));
+        }
+        out += '\n';
+    }
+
+    return out;
+}
+
+bool FrameProfiler::saveTimeSeriesCsv(const std::string& filename) const {
+    if(!Utility::Directory::writeString(filename, timeSeriesCsv())) {
+        Error{} << "DebugTools::FrameProfiler::saveTimeSeriesCsv(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
 namespace {
 
 /* Based on Corrade/TestSuite/Implementation/BenchmarkStats.h */
@@ -438,6 +539,7 @@ struct GLFrameProfiler::State {
     UnsignedShort vertexFetchRatioIndex = 0xffff,
         primitiveClipRatioIndex = 0xffff;
     #endif
+    UnsignedShort gpuMemoryIndex = 0xffff;
     UnsignedLong frameTimeStartFrame[2];
     UnsignedLong cpuDurationStartFrame;
     GL::TimeQuery timeQueries[3]{GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}, GL::TimeQuery{NoCreate}};
@@ -563,6 +665,16 @@ void GLFrameProfiler::setup(const Values values, const UnsignedInt maxFrameCount
         _state->primitiveClipRatioIndex = index++;
     }
     #endif
+    if(values & Value::GpuMemory) {
+        GL::Context::current().setResourceTracking(true);
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "GPU memory", Units::Bytes,
+            [](void*) {},
+            [](void*) {
+                return UnsignedLong(GL::Context::current().resourceMemory());
+            }, nullptr);
+        _state->gpuMemoryIndex = index++;
+    }
     setup(std::move(measurements), maxFrameCount);
 }
 
@@ -575,6 +687,7 @@ auto GLFrameProfiler::values() const -> Values {
     if(_state->vertexFetchRatioIndex != 0xffff) values |= Value::VertexFetchRatio;
     if(_state->primitiveClipRatioIndex != 0xffff) values |= Value::PrimitiveClipRatio;
     #endif
+    if(_state->gpuMemoryIndex != 0xffff) values |= Value::GpuMemory;
     return values;
 }
 
@@ -588,6 +701,7 @@ bool GLFrameProfiler::isMeasurementAvailable(const Value value) const {
         case Value::VertexFetchRatio: index = &_state->vertexFetchRatioIndex; break;
         case Value::PrimitiveClipRatio: index = &_state->primitiveClipRatioIndex; break;
         #endif
+        case Value::GpuMemory: index = &_state->gpuMemoryIndex; break;
     }
     CORRADE_INTERNAL_ASSERT(index);
     CORRADE_ASSERT(*index < measurementCount(),
@@ -627,6 +741,12 @@ Double GLFrameProfiler::primitiveClipRatioMean() const {
 }
 #endif
 
+Double GLFrameProfiler::gpuMemoryMean() const {
+    CORRADE_ASSERT(_state->gpuMemoryIndex < measurementCount(),
+        "DebugTools::GLFrameProfiler::gpuMemoryMean(): not enabled", {});
+    return measurementMean(_state->gpuMemoryIndex);
+}
+
 namespace {
 
 constexpr const char* GLFrameProfilerValueNames[] {
@@ -634,7 +754,8 @@ constexpr const char* GLFrameProfilerValueNames[] {
     "CpuDuration",
     "GpuDuration",
     "VertexFetchRatio",
-    "PrimitiveClipRatio"
+    "PrimitiveClipRatio",
+    "GpuMemory"
 };
 
 }
@@ -656,12 +777,363 @@ Debug& operator<<(Debug& debug, const GLFrameProfiler::Values value) {
         GLFrameProfiler::Value::GpuDuration,
         #ifndef MAGNUM_TARGET_GLES
         GLFrameProfiler::Value::VertexFetchRatio,
-        GLFrameProfiler::Value::PrimitiveClipRatio
+        GLFrameProfiler::Value::PrimitiveClipRatio,
         #endif
+        GLFrameProfiler::Value::GpuMemory
         });
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+struct VkFrameProfiler::State {
+    /* Measurement state for a single pass, pointing back to the shared
+       state. Allocated once in setup() so the pointers stay stable. */
+    struct Pass {
+        State* state;
+        UnsignedInt id;
+    };
+
+    explicit State(Vk::Device& device): device(&device) {}
+
+    /* Resets the query pools for given frame, writes the frame start
+       timestamp and begins the pipeline statistics query. Called from begin
+       callbacks of all GPU measurements, so it has to be done just once per
+       frame. */
+    void beginGpu(UnsignedInt current) {
+        if(gpuBegun) return;
+        gpuBegun = true;
+        this->current = current;
+        if(timestampPools[current].handle()) {
+            commandBuffer->resetQueryPool(timestampPools[current], 0, UnsignedInt(2 + 2*passes.size()))
+                .writeTimestamp(Vk::PipelineStage::TopOfPipe, timestampPools[current], 0);
+        }
+        if(statisticsPools[current].handle()) {
+            commandBuffer->resetQueryPool(statisticsPools[current], 0, 1)
+                .beginQuery(statisticsPools[current], 0);
+        }
+    }
+
+    /* Counterpart to beginGpu(), called from end callbacks */
+    void endGpu(UnsignedInt current) {
+        if(gpuEnded) return;
+        gpuEnded = true;
+        if(statisticsPools[current].handle())
+            commandBuffer->endQuery(statisticsPools[current], 0);
+        if(timestampPools[current].handle())
+            commandBuffer->writeTimestamp(Vk::PipelineStage::BottomOfPipe, timestampPools[current], 1);
+    }
+
+    /* Duration between two timestamps in nanoseconds, zero if the results
+       aren't available yet */
+    UnsignedLong timestampDuration(UnsignedInt previous, UnsignedInt first) {
+        /* Each query is followed by its availability */
+        UnsignedLong data[4];
+        if(!timestampPools[previous].results(first, 2, data, Vk::QueryResultFlag::WithAvailability))
+            return 0;
+        return UnsignedLong(Double(data[2] - data[0])*timestampPeriod);
+    }
+
+    Vk::Device* device;
+    Vk::CommandBuffer* commandBuffer{};
+    UnsignedShort cpuDurationIndex = 0xffff,
+        gpuDurationIndex = 0xffff,
+        frameTimeIndex = 0xffff,
+        vertexFetchRatioIndex = 0xffff,
+        primitiveClipRatioIndex = 0xffff,
+        passIndex = 0xffff;
+    UnsignedInt current{};
+    bool gpuBegun{}, gpuEnded{};
+    Double timestampPeriod{};
+    UnsignedLong frameTimeStartFrame[2];
+    UnsignedLong cpuDurationStartFrame;
+    Containers::Array<Pass> passes;
+    Vk::QueryPool timestampPools[3]{Vk::QueryPool{NoCreate}, Vk::QueryPool{NoCreate}, Vk::QueryPool{NoCreate}};
+    /* Input assembly vertices, vertex shader invocations, clipping
+       invocations and clipping primitives, in this order */
+    Vk::QueryPool statisticsPools[3]{Vk::QueryPool{NoCreate}, Vk::QueryPool{NoCreate}, Vk::QueryPool{NoCreate}};
+};
+
+VkFrameProfiler::VkFrameProfiler(Vk::Device& device): _state{Containers::InPlaceInit, device} {}
+
+VkFrameProfiler::VkFrameProfiler(Vk::Device& device, const Values values, const Containers::ArrayView<const std::string> passNames, const UnsignedInt maxFrameCount): VkFrameProfiler{device}
+{
+    setup(values, passNames, maxFrameCount);
+}
+
+VkFrameProfiler::VkFrameProfiler(Vk::Device& device, const Values values, const std::initializer_list<std::string> passNames, const UnsignedInt maxFrameCount): VkFrameProfiler{device, values, Containers::arrayView(passNames), maxFrameCount} {}
+
+VkFrameProfiler::VkFrameProfiler(Vk::Device& device, const Values values, const UnsignedInt maxFrameCount): VkFrameProfiler{device, values, nullptr, maxFrameCount} {}
+
+VkFrameProfiler::VkFrameProfiler(VkFrameProfiler&&) noexcept = default;
+
+VkFrameProfiler& VkFrameProfiler::operator=(VkFrameProfiler&&) noexcept = default;
+
+VkFrameProfiler::~VkFrameProfiler() = default;
+
+void VkFrameProfiler::setup(const Values values, const Containers::ArrayView<const std::string> passNames, const UnsignedInt maxFrameCount) {
+    _state->frameTimeIndex = _state->cpuDurationIndex = _state->gpuDurationIndex =
+        _state->vertexFetchRatioIndex = _state->primitiveClipRatioIndex =
+            _state->passIndex = 0xffff;
+
+    /* (Re)create the query pools. Timestamps 0 and 1 are for the whole frame,
+       then there's a begin and end timestamp for each pass. */
+    _state->passes = Containers::Array<State::Pass>{Containers::NoInit, passNames.size()};
+    for(std::size_t i = 0; i != passNames.size(); ++i)
+        _state->passes[i] = State::Pass{_state.get(), UnsignedInt(i)};
+    for(Vk::QueryPool& pool: _state->timestampPools) {
+        if(values & Value::GpuDuration || !passNames.empty())
+            pool = Vk::QueryPool{*_state->device, Vk::QueryPoolCreateInfo{Vk::QueryType::Timestamp, UnsignedInt(2 + 2*passNames.size())}};
+        else pool = Vk::QueryPool{NoCreate};
+    }
+    for(Vk::QueryPool& pool: _state->statisticsPools) {
+        if(values & (Value::VertexFetchRatio|Value::PrimitiveClipRatio))
+            pool = Vk::QueryPool{*_state->device, Vk::QueryPoolCreateInfo{
+                Vk::QueryPipelineStatistic::InputAssemblyVertices|
+                Vk::QueryPipelineStatistic::VertexShaderInvocations|
+                Vk::QueryPipelineStatistic::ClippingInvocations|
+                Vk::QueryPipelineStatistic::ClippingPrimitives, 1}};
+        else pool = Vk::QueryPool{NoCreate};
+    }
+    _state->timestampPeriod = _state->device->properties().properties().properties.limits.timestampPeriod;
+
+    UnsignedShort index = 0;
+    Containers::Array<Measurement> measurements;
+    if(values & Value::FrameTime) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "Frame time", Units::Nanoseconds, UnsignedInt(Containers::arraySize(_state->frameTimeStartFrame)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->frameTimeStartFrame[current] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt previous, UnsignedInt current) {
+                auto& self = *static_cast<State*>(state);
+                return self.frameTimeStartFrame[current] -
+                    self.frameTimeStartFrame[previous];
+            }, _state.get());
+        _state->frameTimeIndex = index++;
+    }
+    if(values & Value::CpuDuration) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "CPU duration", Units::Nanoseconds,
+            [](void* state) {
+                static_cast<State*>(state)->cpuDurationStartFrame = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+            },
+            [](void* state) {
+                /* libc++ 10 needs an explicit cast to UnsignedLong */
+                return UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count() - static_cast<State*>(state)->cpuDurationStartFrame);
+            }, _state.get());
+        _state->cpuDurationIndex = index++;
+    }
+    if(values & Value::GpuDuration) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "GPU duration", Units::Nanoseconds,
+            UnsignedInt(Containers::arraySize(_state->timestampPools)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->beginGpu(current);
+            },
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->endGpu(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                return static_cast<State*>(state)->timestampDuration(previous, 0);
+            }, _state.get());
+        _state->gpuDurationIndex = index++;
+    }
+    if(values & Value::VertexFetchRatio) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "Vertex fetch ratio", Units::RatioThousandths,
+            UnsignedInt(Containers::arraySize(_state->statisticsPools)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->beginGpu(current);
+            },
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->endGpu(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                /* Four statistics followed by availability */
+                UnsignedLong data[5];
+                if(!static_cast<State*>(state)->statisticsPools[previous].results(0, 1, data, Vk::QueryResultFlag::WithAvailability))
+                    return UnsignedLong{};
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                if(!data[0]) return UnsignedLong{};
+
+                return data[1]*1000/data[0];
+            }, _state.get());
+        _state->vertexFetchRatioIndex = index++;
+    }
+    if(values & Value::PrimitiveClipRatio) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            "Primitives clipped", Units::PercentageThousandths,
+            UnsignedInt(Containers::arraySize(_state->statisticsPools)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->beginGpu(current);
+            },
+            [](void* state, UnsignedInt current) {
+                static_cast<State*>(state)->endGpu(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                /* Four statistics followed by availability */
+                UnsignedLong data[5];
+                if(!static_cast<State*>(state)->statisticsPools[previous].results(0, 1, data, Vk::QueryResultFlag::WithAvailability))
+                    return UnsignedLong{};
+
+                /* Avoid division by zero if a frame doesn't have any draws */
+                if(!data[2]) return UnsignedLong{};
+
+                return 100000 - data[3]*100000/data[2];
+            }, _state.get());
+        _state->primitiveClipRatioIndex = index++;
+    }
+    if(!passNames.empty()) _state->passIndex = index;
+    for(std::size_t i = 0; i != passNames.size(); ++i) {
+        arrayAppend(measurements, Containers::InPlaceInit,
+            passNames[i], Units::Nanoseconds,
+            UnsignedInt(Containers::arraySize(_state->timestampPools)),
+            [](void* state, UnsignedInt current) {
+                static_cast<State::Pass*>(state)->state->beginGpu(current);
+            },
+            [](void* state, UnsignedInt current) {
+                static_cast<State::Pass*>(state)->state->endGpu(current);
+            },
+            [](void* state, UnsignedInt previous, UnsignedInt) {
+                const State::Pass& pass = *static_cast<State::Pass*>(state);
+                return pass.state->timestampDuration(previous, 2 + 2*pass.id);
+            }, &_state->passes[i]);
+    }
+    setup(std::move(measurements), maxFrameCount);
+}
+
+void VkFrameProfiler::setup(const Values values, const std::initializer_list<std::string> passNames, const UnsignedInt maxFrameCount) {
+    setup(values, Containers::arrayView(passNames), maxFrameCount);
+}
+
+void VkFrameProfiler::setup(const Values values, const UnsignedInt maxFrameCount) {
+    setup(values, nullptr, maxFrameCount);
+}
+
+auto VkFrameProfiler::values() const -> Values {
+    Values values;
+    if(_state->frameTimeIndex != 0xffff) values |= Value::FrameTime;
+    if(_state->cpuDurationIndex != 0xffff) values |= Value::CpuDuration;
+    if(_state->gpuDurationIndex != 0xffff) values |= Value::GpuDuration;
+    if(_state->vertexFetchRatioIndex != 0xffff) values |= Value::VertexFetchRatio;
+    if(_state->primitiveClipRatioIndex != 0xffff) values |= Value::PrimitiveClipRatio;
+    return values;
+}
+
+UnsignedInt VkFrameProfiler::passCount() const {
+    return _state->passes.size();
+}
+
+void VkFrameProfiler::beginFrame(Vk::CommandBuffer& commandBuffer) {
+    _state->commandBuffer = &commandBuffer;
+    _state->gpuBegun = _state->gpuEnded = false;
+    FrameProfiler::beginFrame();
+}
+
+void VkFrameProfiler::endFrame(Vk::CommandBuffer& commandBuffer) {
+    _state->commandBuffer = &commandBuffer;
+    FrameProfiler::endFrame();
+}
+
+void VkFrameProfiler::beginPass(Vk::CommandBuffer& commandBuffer, const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->passes.size(),
+        "DebugTools::VkFrameProfiler::beginPass(): index" << id << "out of range for" << _state->passes.size() << "passes", );
+    if(!isEnabled()) return;
+    commandBuffer.writeTimestamp(Vk::PipelineStage::TopOfPipe, _state->timestampPools[_state->current], 2 + 2*id);
+}
+
+void VkFrameProfiler::endPass(Vk::CommandBuffer& commandBuffer, const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->passes.size(),
+        "DebugTools::VkFrameProfiler::endPass(): index" << id << "out of range for" << _state->passes.size() << "passes", );
+    if(!isEnabled()) return;
+    commandBuffer.writeTimestamp(Vk::PipelineStage::BottomOfPipe, _state->timestampPools[_state->current], 3 + 2*id);
+}
+
+bool VkFrameProfiler::isMeasurementAvailable(const Value value) const {
+    const UnsignedShort* index = nullptr;
+    switch(value) {
+        case Value::FrameTime: index = &_state->frameTimeIndex; break;
+        case Value::CpuDuration: index = &_state->cpuDurationIndex; break;
+        case Value::GpuDuration: index = &_state->gpuDurationIndex; break;
+        case Value::VertexFetchRatio: index = &_state->vertexFetchRatioIndex; break;
+        case Value::PrimitiveClipRatio: index = &_state->primitiveClipRatioIndex; break;
+    }
+    CORRADE_INTERNAL_ASSERT(index);
+    CORRADE_ASSERT(*index < measurementCount(),
+        "DebugTools::VkFrameProfiler::isMeasurementAvailable():" << value << "not enabled", {});
+    return isMeasurementAvailable(*index);
+}
+
+Double VkFrameProfiler::frameTimeMean() const {
+    CORRADE_ASSERT(_state->frameTimeIndex < measurementCount(),
+        "DebugTools::VkFrameProfiler::frameTimeMean(): not enabled", {});
+    return measurementMean(_state->frameTimeIndex);
+}
+
+Double VkFrameProfiler::cpuDurationMean() const {
+    CORRADE_ASSERT(_state->cpuDurationIndex < measurementCount(),
+        "DebugTools::VkFrameProfiler::cpuDurationMean(): not enabled", {});
+    return measurementMean(_state->cpuDurationIndex);
+}
+
+Double VkFrameProfiler::gpuDurationMean() const {
+    CORRADE_ASSERT(_state->gpuDurationIndex < measurementCount(),
+        "DebugTools::VkFrameProfiler::gpuDurationMean(): not enabled", {});
+    return measurementMean(_state->gpuDurationIndex);
+}
+
+Double VkFrameProfiler::vertexFetchRatioMean() const {
+    CORRADE_ASSERT(_state->vertexFetchRatioIndex < measurementCount(),
+        "DebugTools::VkFrameProfiler::vertexFetchRatioMean(): not enabled", {});
+    return measurementMean(_state->vertexFetchRatioIndex);
+}
+
+Double VkFrameProfiler::primitiveClipRatioMean() const {
+    CORRADE_ASSERT(_state->primitiveClipRatioIndex < measurementCount(),
+        "DebugTools::VkFrameProfiler::primitiveClipRatioMean(): not enabled", {});
+    return measurementMean(_state->primitiveClipRatioIndex);
+}
+
+Double VkFrameProfiler::passDurationMean(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _state->passes.size(),
+        "DebugTools::VkFrameProfiler::passDurationMean(): index" << id << "out of range for" << _state->passes.size() << "passes", {});
+    return measurementMean(_state->passIndex + id);
+}
+
+namespace {
+
+constexpr const char* VkFrameProfilerValueNames[] {
+    "FrameTime",
+    "CpuDuration",
+    "GpuDuration",
+    "VertexFetchRatio",
+    "PrimitiveClipRatio"
+};
+
+}
+
+Debug& operator<<(Debug& debug, const VkFrameProfiler::Value value) {
+    debug << "DebugTools::VkFrameProfiler::Value" << Debug::nospace;
+
+    const UnsignedInt bit = Math::log2(UnsignedShort(value));
+    if(1 << bit == UnsignedShort(value))
+        return debug << "::" << Debug::nospace << VkFrameProfilerValueNames[bit];
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const VkFrameProfiler::Values value) {
+    return Containers::enumSetDebugOutput(debug, value, "DebugTools::VkFrameProfiler::Values{}", {
+        VkFrameProfiler::Value::FrameTime,
+        VkFrameProfiler::Value::CpuDuration,
+        VkFrameProfiler::Value::GpuDuration,
+        VkFrameProfiler::Value::VertexFetchRatio,
+        VkFrameProfiler::Value::PrimitiveClipRatio});
+}
+#endif
+
 }}
 
 namespace Corrade { namespace Utility {
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::DebugTools::FrameProfiler, @ref Magnum::DebugTools::GLFrameProfiler
+ * @brief Class @ref Magnum::DebugTools::FrameProfiler, @ref Magnum::DebugTools::GLFrameProfiler, @ref Magnum::DebugTools::VkFrameProfiler
  * @m_since{2020,06}
  */
 
@@ -37,6 +37,10 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/DebugTools/visibility.h"
 
+#ifdef MAGNUM_TARGET_VK
+#include "Magnum/Vk/Vk.h"
+#endif
+
 namespace Magnum { namespace DebugTools {
 
 /**
@@ -82,6 +86,18 @@ And here's a sample output on the terminal --- using a fully configured
 
 @include debugtools-frameprofiler.ansi
 
+@section DebugTools-FrameProfiler-time-series Percentiles and raw data export
+
+A mean hides occasional spikes, which are what the user perceives as
+stutter. Use @ref measurementPercentile() to get for example a 99th
+percentile of given measurement over last @ref maxFrameCount() frames, and
+@ref timeSeriesCsv() or @ref saveTimeSeriesCsv() to export raw per-frame
+values of all measurements for further processing. For a long-running test
+you can for example set the max frame count to the total count of frames
+and save the data at the end:
+
+@snippet MagnumDebugTools.cpp FrameProfiler-time-series
+
 @section DebugTools-FrameProfiler-setup Setting up measurements
 
 Unless you're using this class through @ref GLFrameProfiler, measurements
@@ -351,6 +367,25 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
          */
         Double measurementMean(UnsignedInt id) const;
 
+        /**
+         * @brief Measurement percentile
+         * @m_since_latest
+         *
+         * Returns a value below which given @p percentile of the last
+         * @ref maxFrameCount() measurements falls, calculated using the
+         * nearest-rank method. A @p percentile of @cpp 0.0 @ce returns the
+         * minimum, @cpp 50.0 @ce the median and @cpp 100.0 @ce the maximum.
+         * Useful for catching regressions in tail latency that are invisible
+         * in @ref measurementMean().
+         *
+         * The @p id corresponds to the index of the measurement in the list
+         * passed to @ref setup(). Expects that @p id is less than
+         * @ref measurementCount(), that the measurement is available and that
+         * @p percentile is in the @f$ [0, 100] @f$ range.
+         * @see @ref isMeasurementAvailable()
+         */
+        UnsignedLong measurementPercentile(UnsignedInt id, Double percentile) const;
+
         /**
          * @brief Overview of all measurements
          *
@@ -390,9 +425,37 @@ class MAGNUM_DEBUGTOOLS_EXPORT FrameProfiler {
             printStatistics(out, frequency);
         }
 
+        /**
+         * @brief Per-frame measurement data as CSV
+         * @m_since_latest
+         *
+         * Returns raw values of all measurements for the last
+         * @ref maxFrameCount() frames as comma-separated values, one row per
+         * frame, oldest first. The first column is a frame index counted
+         * from the last time the profiler was enabled, followed by one column
+         * per measurement with measurement names in the header row. The
+         * values are in units returned by @ref measurementUnits(), without
+         * any scaling. As delayed measurements lag behind, cells for frames
+         * for which given measurement isn't available yet are left empty.
+         * If no measurement is available yet, returns just the header.
+         * @see @ref measurementData(), @ref saveTimeSeriesCsv()
+         */
+        std::string timeSeriesCsv() const;
+
+        /**
+         * @brief Save per-frame measurement data as CSV to a file
+         * @m_since_latest
+         *
+         * Saves output of @ref timeSeriesCsv() to @p filename. Prints a
+         * message to @relativeref{Magnum,Error} and returns @cpp false @ce if
+         * the file can't be written, @cpp true @ce otherwise.
+         */
+        bool saveTimeSeriesCsv(const std::string& filename) const;
+
     private:
         UnsignedInt delayedCurrentData(UnsignedInt delay) const;
         Double measurementMeanInternal(const Measurement& measurement) const;
+        UnsignedInt measurementAvailableFrameCount(const Measurement& measurement) const;
         void printStatisticsInternal(Debug& out) const;
 
         bool _enabled = true;
@@ -501,9 +564,9 @@ in the @ref DebugTools-FrameProfiler-usage "FrameProfiler usage documentation":
 
 @snippet MagnumDebugTools-gl.cpp GLFrameProfiler-usage
 
-If none if @ref Value::GpuDuration, @ref Value::VertexFetchRatio and
-@ref Value::PrimitiveClipRatio is not enabled, the class can operate without an
-active OpenGL context.
+If none if @ref Value::GpuDuration, @ref Value::VertexFetchRatio,
+@ref Value::PrimitiveClipRatio and @ref Value::GpuMemory is not enabled, the
+class can operate without an active OpenGL context.
 
 @experimental
 */
@@ -565,8 +628,21 @@ class MAGNUM_DEBUGTOOLS_EXPORT GLFrameProfiler: public FrameProfiler {
              * value requires an active OpenGL context.
              * @requires_gl46 Extension @gl_extension{ARB,pipeline_statistics_query}
              */
-            PrimitiveClipRatio = 1 << 4
+            PrimitiveClipRatio = 1 << 4,
             #endif
+
+            /**
+             * Estimated GPU memory used by all live buffers, textures and
+             * renderbuffers at the end of the frame. Reported in
+             * @ref Units::Bytes with no delay. This value requires an active
+             * OpenGL context, setting it up enables
+             * @ref GL::Context::setResourceTracking() "resource tracking" in
+             * the current context if not already. Objects created before the
+             * tracking was enabled are not counted, so enable it right after
+             * context creation for complete numbers.
+             * @m_since_latest
+             */
+            GpuMemory = 1 << 5
         };
 
         /**
@@ -689,6 +765,16 @@ class MAGNUM_DEBUGTOOLS_EXPORT GLFrameProfiler: public FrameProfiler {
         Double primitiveClipRatioMean() const;
         #endif
 
+        /**
+         * @brief Mean GPU memory use in bytes
+         * @m_since_latest
+         *
+         * Expects that @ref Value::GpuMemory was enabled, and that measurement
+         * data is available. See the flag documentation for more information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double gpuMemoryMean() const;
+
     private:
         using FrameProfiler::setup;
 
@@ -711,6 +797,343 @@ MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, GLFrameProfiler::Value
 MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, GLFrameProfiler::Values value);
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+/**
+@brief Vulkan frame profiler
+@m_since_latest
+
+A @ref FrameProfiler with Vulkan-specific measurements. Instantiate with a
+desired subset of measured values and optionally a list of render pass names
+to measure GPU time of, and then continue the same way as described in the
+@ref DebugTools-FrameProfiler-usage "FrameProfiler usage documentation", except
+that @ref beginFrame() and @ref endFrame() take a command buffer to record the
+queries into and that each pass is delimited with @ref beginPass() and
+@ref endPass():
+
+@snippet MagnumDebugTools-vk.cpp VkFrameProfiler-usage
+
+@section DebugTools-VkFrameProfiler-queries Query pools and synchronization
+
+GPU measurements are done with a ring of three sets of @ref Vk::QueryPool
+instances --- one with timestamps for the whole frame and for each pass, and
+one with pipeline statistics if @ref Value::VertexFetchRatio or
+@ref Value::PrimitiveClipRatio is enabled. The pools for given frame are reset
+in the command buffer passed to @ref beginFrame() and their results are read
+three frames later, without waiting. Thus, if the application has at most two
+frames in flight and waits for the fence of the oldest frame before recording a
+new one, the results are always available by the time they're read and the
+profiler never stalls the pipeline. If a result isn't available yet, the
+measurement is recorded as zero for given frame.
+
+The command buffer passed to @ref beginFrame() has to be submitted before any
+other command buffer containing @ref beginPass() and @ref endPass() for the
+same frame, and the pipeline statistics query requires that @ref beginFrame()
+and @ref endFrame() are given the same primary command buffer, outside of a
+render pass.
+
+If none of @ref Value::GpuDuration, @ref Value::VertexFetchRatio and
+@ref Value::PrimitiveClipRatio is enabled and no passes are specified, no
+query pools are created and the command buffers are unused.
+
+@experimental
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT VkFrameProfiler: public FrameProfiler {
+    public:
+        /**
+         * @brief Measured value
+         *
+         * @see @ref Values, @ref VkFrameProfiler(Vk::Device&, Values, UnsignedInt),
+         *      @ref setup()
+         */
+        enum class Value: UnsignedShort {
+            /**
+             * Measure total frame time (i.e., time between consecutive
+             * @ref beginFrame() calls). Reported in @ref Units::Nanoseconds
+             * with a delay of 2 frames. When converted to seconds, the value
+             * is an inverse of FPS.
+             */
+            FrameTime = 1 << 0,
+
+            /**
+             * Measure CPU frame duration (i.e., CPU time spent between
+             * @ref beginFrame() and @ref endFrame()). Reported in
+             * @ref Units::Nanoseconds with a delay of 1 frame.
+             */
+            CpuDuration = 1 << 1,
+
+            /**
+             * Measure GPU frame duration (i.e., time between the top of the
+             * pipe at @ref beginFrame() and the bottom of the pipe at
+             * @ref endFrame()). Reported in @ref Units::Nanoseconds with a
+             * delay of 3 frames.
+             * @see @ref Vk::CommandBuffer::writeTimestamp()
+             */
+            GpuDuration = 1 << 2,
+
+            /**
+             * Ratio of vertex shader invocations to count of vertices
+             * submitted. For a non-indexed draw the ratio will be 1, for
+             * indexed draws ratio is less than 1. The lower the value is, the
+             * better a mesh is optimized for post-transform vertex cache.
+             * Reported in @ref Units::RatioThousandths with a delay of 3
+             * frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            VertexFetchRatio = 1 << 3,
+
+            /**
+             * Ratio of primitives discarded by the clipping stage to count of
+             * primitives submitted. The ratio is 0 when all primitives pass
+             * the clipping stage and 1 when all are discarded. Can be used to
+             * measure efficiency of a frustum culling algorithm. Reported in
+             * @ref Units::PercentageThousandths with a delay of 3 frames.
+             * @requires_vk_feature @ref Vk::DeviceFeature::PipelineStatisticsQuery
+             */
+            PrimitiveClipRatio = 1 << 4
+        };
+
+        /**
+         * @brief Measured values
+         *
+         * @see @ref VkFrameProfiler(Vk::Device&, Values, UnsignedInt),
+         *      @ref setup()
+         */
+        typedef Containers::EnumSet<Value> Values;
+
+        /**
+         * @brief Constructor
+         * @param device        Device to create the query pools on
+         *
+         * Call @ref setup() to populate the profiler with measurements. The
+         * @p device is expected to stay alive for the whole lifetime of the
+         * profiler.
+         */
+        explicit VkFrameProfiler(Vk::Device& device);
+
+        /**
+         * @brief Construct with given measured values and passes
+         *
+         * Equivalent to constructing an instance with
+         * @ref VkFrameProfiler(Vk::Device&) and calling @ref setup()
+         * afterwards.
+         */
+        explicit VkFrameProfiler(Vk::Device& device, Values values, Containers::ArrayView<const std::string> passNames, UnsignedInt maxFrameCount);
+
+        /** @overload */
+        explicit VkFrameProfiler(Vk::Device& device, Values values, std::initializer_list<std::string> passNames, UnsignedInt maxFrameCount);
+
+        /**
+         * @brief Construct with given measured values
+         *
+         * Equivalent to calling @ref VkFrameProfiler(Vk::Device&, Values, Containers::ArrayView<const std::string>, UnsignedInt)
+         * with an empty @p passNames list.
+         */
+        explicit VkFrameProfiler(Vk::Device& device, Values values, UnsignedInt maxFrameCount);
+
+        /** @brief Copying is not allowed */
+        VkFrameProfiler(const VkFrameProfiler&) = delete;
+
+        /** @brief Move constructor */
+        VkFrameProfiler(VkFrameProfiler&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        VkFrameProfiler& operator=(const VkFrameProfiler&) = delete;
+
+        /** @brief Move assignment */
+        VkFrameProfiler& operator=(VkFrameProfiler&&) noexcept;
+
+        ~VkFrameProfiler();
+
+        /**
+         * @brief Setup measured values and passes
+         * @param values        List of measuremed values
+         * @param passNames     Names of passes to measure GPU duration of.
+         *      Used as measurement names.
+         * @param maxFrameCount Max frame count over which to calculate a
+         *      moving average. Expected to be at least @cpp 1 @ce.
+         *
+         * Creates query pools for the GPU measurements, replacing existing
+         * pools. Calling @ref setup() on an already set up profiler will
+         * replace existing measurements and reset @ref measuredFrameCount()
+         * back to @cpp 0 @ce. Pass measurements are added after all
+         * measurements in @p values. The device is expected to be idle or not
+         * using the previous pools anymore.
+         * @see @ref Vk::QueryPool
+         */
+        void setup(Values values, Containers::ArrayView<const std::string> passNames, UnsignedInt maxFrameCount);
+
+        /** @overload */
+        void setup(Values values, std::initializer_list<std::string> passNames, UnsignedInt maxFrameCount);
+
+        /**
+         * @brief Setup measured values
+         *
+         * Equivalent to calling @ref setup(Values, Containers::ArrayView<const std::string>, UnsignedInt)
+         * with an empty @p passNames list.
+         */
+        void setup(Values values, UnsignedInt maxFrameCount);
+
+        /**
+         * @brief Measured values
+         *
+         * Corresponds to the @p values parameter passed to
+         * @ref VkFrameProfiler(Vk::Device&, Values, Containers::ArrayView<const std::string>, UnsignedInt)
+         * or @ref setup().
+         */
+        Values values() const;
+
+        /**
+         * @brief Count of measured passes
+         *
+         * Corresponds to the size of the @p passNames parameter passed to
+         * @ref VkFrameProfiler(Vk::Device&, Values, Containers::ArrayView<const std::string>, UnsignedInt)
+         * or @ref setup().
+         */
+        UnsignedInt passCount() const;
+
+        /**
+         * @brief Begin a frame
+         *
+         * Resets the query pools for this frame and begins the GPU
+         * measurements in @p commandBuffer, which is expected to be in a
+         * recording state, and then delegates to
+         * @ref FrameProfiler::beginFrame(). If the profiler is disabled, the
+         * function is a no-op.
+         * @see @ref Vk::CommandBuffer::resetQueryPool(),
+         *      @ref Vk::CommandBuffer::writeTimestamp(),
+         *      @ref Vk::CommandBuffer::beginQuery()
+         */
+        void beginFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief End a frame
+         *
+         * Ends the GPU measurements in @p commandBuffer, which is expected to
+         * be in a recording state, and then delegates to
+         * @ref FrameProfiler::endFrame(), which reads the results of GPU
+         * measurements from three frames ago. If the profiler is disabled,
+         * the function is a no-op.
+         * @see @ref Vk::CommandBuffer::writeTimestamp(),
+         *      @ref Vk::CommandBuffer::endQuery()
+         */
+        void endFrame(Vk::CommandBuffer& commandBuffer);
+
+        /**
+         * @brief Begin a pass
+         *
+         * Writes a top-of-pipe timestamp for pass @p id into
+         * @p commandBuffer. Expects that @p id is less than
+         * @ref passCount(). Has to be called between @ref beginFrame() and
+         * @ref endFrame() and be paired with a corresponding @ref endPass().
+         * If the profiler is disabled, the function is a no-op.
+         * @see @ref Vk::CommandBuffer::writeTimestamp()
+         */
+        void beginPass(Vk::CommandBuffer& commandBuffer, UnsignedInt id);
+
+        /**
+         * @brief End a pass
+         *
+         * Writes a bottom-of-pipe timestamp for pass @p id into
+         * @p commandBuffer. Expects that @p id is less than
+         * @ref passCount(). If the profiler is disabled, the function is a
+         * no-op.
+         * @see @ref Vk::CommandBuffer::writeTimestamp()
+         */
+        void endPass(Vk::CommandBuffer& commandBuffer, UnsignedInt id);
+
+        /**
+         * @brief Whether given measurement is available
+         *
+         * Returns @cpp true @ce if enough frames was captured to calculate
+         * given @p value, @cpp false @ce otherwise. Expects that @p value was
+         * enabled.
+         */
+        bool isMeasurementAvailable(Value value) const;
+
+        using FrameProfiler::isMeasurementAvailable;
+
+        /**
+         * @brief Mean frame time in nanoseconds
+         *
+         * Expects that @ref Value::FrameTime was enabled, and that measurement
+         * data is available. See the flag documentation for more information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double frameTimeMean() const;
+
+        /**
+         * @brief Mean CPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::CpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double cpuDurationMean() const;
+
+        /**
+         * @brief Mean GPU frame duration in nanoseconds
+         *
+         * Expects that @ref Value::GpuDuration was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double gpuDurationMean() const;
+
+        /**
+         * @brief Mean vertex fetch ratio in thousandths
+         *
+         * Expects that @ref Value::VertexFetchRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double vertexFetchRatioMean() const;
+
+        /**
+         * @brief Mean primitive clip ratio in percentage thousandths
+         *
+         * Expects that @ref Value::PrimitiveClipRatio was enabled, and that
+         * measurement data is available. See the flag documentation for more
+         * information.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double primitiveClipRatioMean() const;
+
+        /**
+         * @brief Mean GPU duration of a pass in nanoseconds
+         *
+         * Expects that @p id is less than @ref passCount() and that
+         * measurement data is available. Reported with a delay of 3 frames.
+         * @see @ref isMeasurementAvailable(), @ref measurementMean()
+         */
+        Double passDurationMean(UnsignedInt id) const;
+
+    private:
+        using FrameProfiler::setup;
+        using FrameProfiler::beginFrame;
+        using FrameProfiler::endFrame;
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(VkFrameProfiler::Values)
+
+/**
+@debugoperatorclassenum{VkFrameProfiler,VkFrameProfiler::Value}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, VkFrameProfiler::Value value);
+
+/**
+@debugoperatorclassenum{VkFrameProfiler,VkFrameProfiler::Values}
+@m_since_latest
+*/
+MAGNUM_DEBUGTOOLS_EXPORT Debug& operator<<(Debug& debug, VkFrameProfiler::Values value);
+#endif
+
 }}
 
 namespace Corrade { namespace Utility {
@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ObjectPicker.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools {
+
+namespace {
+
+/* Matches Shaders::Generic::ObjectIdOutput, DebugTools doesn't depend on
+   the Shaders library in all configurations */
+constexpr UnsignedInt ObjectIdOutput = 1;
+
+}
+
+ObjectPicker::ObjectPicker(const Int radius, const UnsignedInt capacity): _radius{radius}, _framebuffer{NoCreate} {
+    CORRADE_ASSERT(radius >= 0,
+        "DebugTools::ObjectPicker: radius can't be negative", );
+    CORRADE_ASSERT(capacity,
+        "DebugTools::ObjectPicker: capacity can't be zero", );
+
+    /* The readback creates its buffers lazily, so replacing the default one
+       after the capacity is checked costs nothing */
+    _readback = AsyncReadback{capacity};
+
+    _objectId.setStorage(GL::RenderbufferFormat::R32UI, size());
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent24, size());
+    _framebuffer = GL::Framebuffer{{{}, size()}};
+    _framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _objectId)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+        .mapForDraw({{ObjectIdOutput, GL::Framebuffer::ColorAttachment{0}}})
+        .mapForRead(GL::Framebuffer::ColorAttachment{0});
+    _pending = Containers::Array<Pending>{Containers::ValueInit, capacity};
+}
+
+ObjectPicker::ObjectPicker(ObjectPicker&&) noexcept = default;
+
+ObjectPicker::~ObjectPicker() = default;
+
+ObjectPicker& ObjectPicker::operator=(ObjectPicker&&) noexcept = default;
+
+Matrix4 ObjectPicker::begin(const Vector2i& position, const Vector2i& viewportSize) {
+    _position = position;
+
+    /* The clear index is the draw buffer index, which is the shader output
+       location */
+    _framebuffer.clearColor(ObjectIdOutput, Vector4ui{_backgroundId})
+        .clear(GL::FramebufferClear::Depth)
+        .bind();
+
+    /* Scale the region around the cursor pixel center to the whole NDC
+       range. The translation gets multiplied by the W component, so it
+       works for perspective projections as well. */
+    const Vector2 scale = Vector2{viewportSize}/Vector2{size()};
+    const Vector2 center = (Vector2{position} + Vector2{0.5f})/Vector2{viewportSize}*2.0f - Vector2{1.0f};
+    return Matrix4::translation(Vector3{-center*scale, 0.0f})*
+           Matrix4::scaling(Vector3{scale, 1.0f});
+}
+
+void ObjectPicker::end() {
+    /* Hovering is interested only in recent results, so drop the oldest
+       pick if there's no room for a new one */
+    if(_pendingCount == _pending.size()) {
+        _readback.discard(_pending[0].id);
+        for(UnsignedInt i = 1; i != _pendingCount; ++i)
+            _pending[i - 1] = _pending[i];
+        --_pendingCount;
+    }
+
+    /* Integer reads other than RGBA are implementation-defined on ES, the
+       region is small enough for the extra channels to not matter */
+    _pending[_pendingCount++] = Pending{
+        _readback.read(_framebuffer, {{}, size()}, PixelFormat::RGBA32UI),
+        _position};
+}
+
+ObjectPicker::Result ObjectPicker::result(const Image2D& image, const Vector2i& position) const {
+    const Containers::StridedArrayView2D<const Vector4ui> pixels = image.pixels<Vector4ui>();
+
+    /* The pixel under the cursor if it's not background, otherwise the
+       closest non-background one */
+    Result out{_backgroundId, position};
+    Int closest = -1;
+    for(Int y = 0; y != Int(pixels.size()[0]); ++y) {
+        for(Int x = 0; x != Int(pixels.size()[1]); ++x) {
+            const UnsignedInt id = pixels[y][x].x();
+            if(id == _backgroundId) continue;
+
+            const Int distance = (x - _radius)*(x - _radius) + (y - _radius)*(y - _radius);
+            if(closest == -1 || distance < closest) {
+                closest = distance;
+                out.objectId = id;
+            }
+        }
+    }
+
+    return out;
+}
+
+Containers::Optional<ObjectPicker::Result> ObjectPicker::poll() {
+    /* Find the most recent finished pick, older pending picks are then not
+       interesting anymore */
+    UnsignedInt ready = _pendingCount;
+    for(UnsignedInt i = _pendingCount; i != 0; --i) {
+        if(_readback.isReady(_pending[i - 1].id)) {
+            ready = i - 1;
+            break;
+        }
+    }
+    if(ready == _pendingCount) return {};
+
+    const Image2D image = _readback.retrieve(_pending[ready].id);
+    const Result out = result(image, _pending[ready].position);
+    for(UnsignedInt i = 0; i != ready; ++i)
+        _readback.discard(_pending[i].id);
+
+    /* Keep just the picks that are newer */
+    for(UnsignedInt i = ready + 1; i != _pendingCount; ++i)
+        _pending[i - ready - 1] = _pending[i];
+    _pendingCount -= ready + 1;
+    return out;
+}
+
+}}
@@ -0,0 +1,230 @@
+#ifndef Magnum_DebugTools_ObjectPicker_h
+#define Magnum_DebugTools_ObjectPicker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/** @file
+ * @brief Class @ref Magnum::DebugTools::ObjectPicker
+ * @m_since_latest
+ */
+#endif
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/DebugTools/visibility.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/Math/Matrix4.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Non-blocking object picking
+@m_since_latest
+
+Picking an object under the cursor by reading the @ref Shaders::Flat::ObjectIdOutput "ObjectIdOutput"
+of @ref Shaders::Flat or @ref Shaders::Phong with
+@ref GL::AbstractFramebuffer::read() waits until the GPU finishes all
+rendering and thus stalls the pipeline, which is too costly for hover
+highlighting that picks every frame. This class instead renders only a small
+square region around the cursor into its own @ref GL::RenderbufferFormat::R32UI
+framebuffer and reads it back through an @ref AsyncReadback, delivering the
+picked ID usually one or two frames later:
+
+@snippet MagnumDebugTools-gl.cpp ObjectPicker-usage
+
+The @ref begin() function binds and clears the internal framebuffer and
+returns a matrix that restricts the projection to the picked region. Draw the
+pickable objects with the object ID enabled and the projection multiplied by
+the returned matrix, then call @ref end() to issue the read. Only the region
+is rasterized, so the extra pass is cheap even for large viewports. The
+object ID output is expected at location @cpp 1 @ce, which is what
+@ref Shaders::Generic::ObjectIdOutput uses, the color output is discarded.
+Depth testing should be enabled with @ref GL::Renderer::Feature::DepthTest
+for the closest object to be picked.
+
+Once a read finishes, @ref poll() returns the ID of the pixel under the
+cursor. If that pixel has the background ID, the closest non-background pixel
+in the region is used instead, which makes it easier to pick thin objects
+such as lines. As only the most recent result is interesting for picking,
+older finished reads are dropped and if all reads are pending, the oldest is
+discarded to make room for a new one, so the picking never blocks.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL "TARGET_GL" enabled (done by default). See
+    @ref building-features for more information.
+
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gl30 Extension @gl_extension{EXT,texture_integer}
+@requires_gles30 Integer framebuffer attachments, pixel buffer objects and
+    sync objects are not available in OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT ObjectPicker {
+    public:
+        /**
+         * @brief Picking result
+         *
+         * @see @ref poll()
+         */
+        struct Result {
+            /**
+             * @brief Object ID
+             *
+             * Equal to @ref backgroundId() if nothing was picked.
+             */
+            UnsignedInt objectId;
+
+            /** @brief Cursor position passed to @ref begin() */
+            Vector2i position;
+        };
+
+        /**
+         * @brief Constructor
+         * @param radius    Radius of the picked region around the cursor
+         * @param capacity  Max count of picks pending at the same time
+         *
+         * The picked region is a square of @cpp 2*radius + 1 @ce pixels.
+         * Expects that @p radius is not negative and @p capacity is
+         * non-zero.
+         */
+        explicit ObjectPicker(Int radius = 2, UnsignedInt capacity = 3);
+
+        /** @brief Copying is not allowed */
+        ObjectPicker(const ObjectPicker&) = delete;
+
+        /** @brief Move constructor */
+        ObjectPicker(ObjectPicker&&) noexcept;
+
+        ~ObjectPicker();
+
+        /** @brief Copying is not allowed */
+        ObjectPicker& operator=(const ObjectPicker&) = delete;
+
+        /** @brief Move assignment */
+        ObjectPicker& operator=(ObjectPicker&&) noexcept;
+
+        /** @brief Radius of the picked region */
+        Int radius() const { return _radius; }
+
+        /** @brief Size of the picked region */
+        Vector2i size() const { return Vector2i{2*_radius + 1}; }
+
+        /** @brief Max count of picks pending at the same time */
+        UnsignedInt capacity() const { return _pending.size(); }
+
+        /** @brief Count of pending picks */
+        UnsignedInt pendingCount() const { return _pendingCount; }
+
+        /**
+         * @brief Background ID
+         *
+         * ID the region is cleared to in @ref begin(). Default is
+         * @cpp 0 @ce.
+         */
+        UnsignedInt backgroundId() const { return _backgroundId; }
+
+        /**
+         * @brief Set background ID
+         * @return Reference to self (for method chaining)
+         */
+        ObjectPicker& setBackgroundId(UnsignedInt id) {
+            _backgroundId = id;
+            return *this;
+        }
+
+        /**
+         * @brief Framebuffer the picked region is rendered into
+         *
+         * Has an @ref GL::RenderbufferFormat::R32UI attachment mapped to the
+         * object ID output and a @ref GL::RenderbufferFormat::DepthComponent24
+         * depth attachment, both of @ref size().
+         */
+        GL::Framebuffer& framebuffer() { return _framebuffer; }
+
+        /**
+         * @brief Begin picking
+         * @param position      Cursor position in the framebuffer
+         * @param viewportSize  Size of the viewport the scene is rendered to
+         * @return Matrix to multiply the projection matrix with from the left
+         *
+         * The @p position is in framebuffer coordinates, i.e. with the origin
+         * in the bottom left corner, so window event positions need to be
+         * flipped on the Y axis. Binds @ref framebuffer() for drawing and
+         * clears it to @ref backgroundId() and the default depth. After the
+         * objects are drawn, call @ref end().
+         */
+        Matrix4 begin(const Vector2i& position, const Vector2i& viewportSize);
+
+        /**
+         * @brief End picking
+         *
+         * Issues a non-blocking read of the picked region. If all
+         * @ref capacity() reads are pending, the oldest one is discarded.
+         * The result can be retrieved with @ref poll() once the read
+         * finishes.
+         */
+        void end();
+
+        /**
+         * @brief Poll for a picking result
+         *
+         * Returns the result of the most recent finished pick, if any,
+         * dropping results of older picks that finished as well. Returns
+         * @ref Containers::NullOpt if no pick finished since the last call.
+         * Doesn't block.
+         */
+        Containers::Optional<Result> poll();
+
+    private:
+        struct Pending {
+            UnsignedInt id;
+            Vector2i position;
+        };
+
+        MAGNUM_DEBUGTOOLS_LOCAL Result result(const Image2D& image, const Vector2i& position) const;
+
+        Int _radius;
+        UnsignedInt _backgroundId{};
+        AsyncReadback _readback;
+        GL::Renderbuffer _objectId, _depth;
+        GL::Framebuffer _framebuffer;
+        /* Pending picks, oldest first */
+        Containers::Array<Pending> _pending;
+        UnsignedInt _pendingCount{};
+        Vector2i _position;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL ES 3.0 and desktop OpenGL build
+#endif
+
+#endif
@@ -25,11 +25,15 @@
 
 #include "ObjectRenderer.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+
 #include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/Primitives/Axis.h"
 #include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/VertexColor.h"
 #include "Magnum/Trade/MeshData.h"
 
@@ -42,12 +46,18 @@ template<UnsignedInt> struct Renderer;
 template<> struct Renderer<2> {
     static ResourceKey shader() { return {"VertexColorShader2D"}; }
     static ResourceKey mesh() { return {"object2d"}; }
+    static ResourceKey instancedShader() { return {"FlatShaderVertexColorInstanced2D"}; }
+    static ResourceKey instanceBuffer() { return {"object-instances2d"}; }
+    static ResourceKey instancedMesh() { return {"object-instanced2d"}; }
     static Trade::MeshData meshData() { return Primitives::axis2D(); }
 };
 
 template<> struct Renderer<3> {
     static ResourceKey shader() { return {"VertexColorShader3D"}; }
     static ResourceKey mesh() { return {"object3d"}; }
+    static ResourceKey instancedShader() { return {"FlatShaderVertexColorInstanced3D"}; }
+    static ResourceKey instanceBuffer() { return {"object-instances3d"}; }
+    static ResourceKey instancedMesh() { return {"object-instanced3d"}; }
     static Trade::MeshData meshData() { return Primitives::axis3D(); }
 };
 
@@ -72,6 +82,41 @@ template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::draw(const Mat
         .draw(*_mesh);
 }
 
+template<UnsignedInt dimensions> void ObjectRenderer<dimensions>::drawInstanced(ResourceManager& manager, SceneGraph::Camera<dimensions, Float>& camera, SceneGraph::DrawableGroup<dimensions, Float>& drawables) {
+    /* Gather transformations of all object renderers in the group */
+    Containers::Array<MatrixTypeFor<dimensions, Float>> transformations;
+    for(const auto& drawableTransformation: camera.drawableTransformations(drawables)) {
+        auto* const renderer = dynamic_cast<ObjectRenderer<dimensions>*>(&drawableTransformation.first.get());
+        if(!renderer) continue;
+
+        arrayAppend(transformations, drawableTransformation.second*MatrixTypeFor<dimensions, Float>::scaling(VectorTypeFor<dimensions, Float>{renderer->_options->size()}));
+    }
+    if(transformations.empty()) return;
+
+    /* Shader. Shaders::VertexColor doesn't support instancing, so this uses
+       the flat shader with vertex colors, which gives the same output. */
+    Resource<GL::AbstractShaderProgram, Shaders::Flat<dimensions>> shader = manager.get<GL::AbstractShaderProgram, Shaders::Flat<dimensions>>(Renderer<dimensions>::instancedShader());
+    if(!shader) manager.set<GL::AbstractShaderProgram>(shader.key(), new Shaders::Flat<dimensions>{Shaders::Flat<dimensions>::Flag::VertexColor|Shaders::Flat<dimensions>::Flag::InstancedTransformation});
+
+    /* Instance buffer, refilled every time */
+    Resource<GL::Buffer> instanceBuffer = manager.get<GL::Buffer>(Renderer<dimensions>::instanceBuffer());
+    if(!instanceBuffer) manager.set(instanceBuffer.key(), GL::Buffer{GL::Buffer::TargetHint::Array}, ResourceDataState::Final, ResourcePolicy::Manual);
+    instanceBuffer->setData(transformations, GL::BufferUsage::DynamicDraw);
+
+    /* Mesh with the instance buffer attached */
+    Resource<GL::Mesh> mesh = manager.get<GL::Mesh>(Renderer<dimensions>::instancedMesh());
+    if(!mesh) {
+        GL::Mesh instancedMesh = MeshTools::compile(Renderer<dimensions>::meshData());
+        instancedMesh.addVertexBufferInstanced(*instanceBuffer, 1, 0,
+            typename Shaders::Flat<dimensions>::TransformationMatrix{});
+        manager.set(mesh.key(), std::move(instancedMesh), ResourceDataState::Final, ResourcePolicy::Manual);
+    }
+    mesh->setInstanceCount(Int(transformations.size()));
+
+    shader->setTransformationProjectionMatrix(camera.projectionMatrix())
+        .draw(*mesh);
+}
+
 template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer<2>;
 template class MAGNUM_DEBUGTOOLS_EXPORT ObjectRenderer<3>;
 
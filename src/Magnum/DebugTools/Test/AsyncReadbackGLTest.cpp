@@ -0,0 +1,313 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/AsyncReadback.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct AsyncReadbackGLTest: GL::OpenGLTester {
+    explicit AsyncReadbackGLTest();
+
+    void construct();
+    void constructZeroCapacity();
+
+    void readFramebuffer();
+    void readFramebufferViewport();
+    void readTexture();
+    void tryRetrieve();
+    void discard();
+    void reuse();
+
+    void readFull();
+    void invalidId();
+};
+
+AsyncReadbackGLTest::AsyncReadbackGLTest() {
+    addTests({&AsyncReadbackGLTest::construct,
+              &AsyncReadbackGLTest::constructZeroCapacity,
+
+              &AsyncReadbackGLTest::readFramebuffer,
+              &AsyncReadbackGLTest::readFramebufferViewport,
+              &AsyncReadbackGLTest::readTexture,
+              &AsyncReadbackGLTest::tryRetrieve,
+              &AsyncReadbackGLTest::discard,
+              &AsyncReadbackGLTest::reuse,
+
+              &AsyncReadbackGLTest::readFull,
+              &AsyncReadbackGLTest::invalidId});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sync>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::sync::string() + std::string(" is not available."))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+using namespace Math::Literals;
+
+constexpr Color4ub DataRgba8[]{
+    0x11223344_rgba, 0x22334455_rgba, 0x33445566_rgba, 0x44556677_rgba,
+    0x55667788_rgba, 0x66778899_rgba, 0x778899aa_rgba, 0x8899aabb_rgba,
+    0x99aabbcc_rgba, 0xaabbccdd_rgba, 0xbbccddee_rgba, 0xccddeeff_rgba
+};
+
+const ImageView2D ImageRgba8{PixelFormat::RGBA8Unorm, {4, 3}, DataRgba8};
+
+void AsyncReadbackGLTest::construct() {
+    AsyncReadback readback{5};
+    CORRADE_COMPARE(readback.capacity(), 5);
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+
+    AsyncReadback defaults;
+    CORRADE_COMPARE(defaults.capacity(), 3);
+    CORRADE_COMPARE(defaults.pendingCount(), 0);
+}
+
+void AsyncReadbackGLTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AsyncReadback{0};
+    CORRADE_COMPARE(out.str(), "DebugTools::AsyncReadback: capacity can't be zero\n");
+}
+
+void AsyncReadbackGLTest::readFramebuffer() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback readback;
+    const UnsignedInt id = readback.read(framebuffer, {{1, 1}, {4, 3}}, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(id);
+    CORRADE_COMPARE(readback.pendingCount(), 1);
+
+    Image2D image = readback.retrieve(id);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+    CORRADE_COMPARE(image.format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(image.size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.pixels<Color4ub>()[0]),
+        Containers::arrayView(DataRgba8).slice(5, 8),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.pixels<Color4ub>()[1]),
+        Containers::arrayView(DataRgba8).slice(9, 12),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::readFramebufferViewport() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback readback;
+    const UnsignedInt id = readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = readback.retrieve(id);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{4, 3}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()),
+        Containers::arrayView(DataRgba8),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::readTexture() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback readback;
+    const UnsignedInt id = readback.read(texture, 0, {{}, {4, 3}}, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = readback.retrieve(id);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.size(), (Vector2i{4, 3}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()),
+        Containers::arrayView(DataRgba8),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::tryRetrieve() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback readback;
+    const UnsignedInt id = readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Can't really test that it's not ready yet, as that's up to the driver.
+       After a finish it has to be. */
+    GL::Renderer::finish();
+    CORRADE_VERIFY(readback.isReady(id));
+
+    Containers::Optional<Image2D> image = readback.tryRetrieve(id);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(readback.pendingCount(), 0);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image->data()),
+        Containers::arrayView(DataRgba8),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::discard() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    AsyncReadback readback{2};
+    const UnsignedInt a = readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+    const UnsignedInt b = readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(a != b);
+    CORRADE_COMPARE(readback.pendingCount(), 2);
+
+    readback.discard(a);
+    CORRADE_COMPARE(readback.pendingCount(), 1);
+
+    /* The other read is still there */
+    Image2D image = readback.retrieve(b);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Color4ub>(image.data()),
+        Containers::arrayView(DataRgba8),
+        TestSuite::Compare::Container);
+}
+
+void AsyncReadbackGLTest::reuse() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3})
+        .setSubImage(0, {}, ImageRgba8);
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Reading many times more than the capacity, the buffers get reused */
+    AsyncReadback readback{1};
+    for(std::size_t i = 0; i != 5; ++i) {
+        CORRADE_ITERATION(i);
+
+        const UnsignedInt id = readback.read(framebuffer, {{Int(i % 4), 0}, {Int(i % 4) + 1, 1}}, PixelFormat::RGBA8Unorm);
+        Image2D image = readback.retrieve(id);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(image.size(), (Vector2i{1, 1}));
+        CORRADE_COMPARE(image.pixels<Color4ub>()[0][0], DataRgba8[i % 4]);
+    }
+}
+
+void AsyncReadbackGLTest::readFull() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    GL::Texture2D texture;
+    texture.setStorage(1, GL::TextureFormat::RGBA8, {4, 3});
+    GL::Framebuffer framebuffer{{{}, {4, 3}}};
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment{0}, texture, 0);
+
+    AsyncReadback readback{1};
+    readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    readback.read(framebuffer, PixelFormat::RGBA8Unorm);
+    readback.read(texture, 0, {{}, {4, 3}}, PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::AsyncReadback::read(): all 1 reads are pending\n"
+        "DebugTools::AsyncReadback::read(): all 1 reads are pending\n");
+}
+
+void AsyncReadbackGLTest::invalidId() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    AsyncReadback readback;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    readback.isReady(0);
+    readback.tryRetrieve(1);
+    readback.retrieve(2);
+    readback.discard(3);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::AsyncReadback::isReady(): no pending read with ID 0\n"
+        "DebugTools::AsyncReadback::tryRetrieve(): no pending read with ID 1\n"
+        "DebugTools::AsyncReadback::retrieve(): no pending read with ID 2\n"
+        "DebugTools::AsyncReadback::discard(): no pending read with ID 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::AsyncReadbackGLTest)
@@ -32,6 +32,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/File.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
@@ -42,6 +43,7 @@
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/AbstractImporter.h"
 
@@ -53,13 +55,16 @@ struct CompareImageTest: TestSuite::Tester {
     explicit CompareImageTest();
 
     void formatUnknown();
-    void formatHalf();
     void formatImplementationSpecific();
 
     void calculateDelta();
     void calculateDeltaStorage();
     void calculateDeltaSpecials();
     void calculateDeltaSpecials3();
+    void calculateDeltaHalf();
+    void calculateDeltaNonContiguous();
+    void calculateDeltaContiguousKernels();
+    void calculateDeltaThreads();
 
     void deltaImage();
     void deltaImageScaling();
@@ -70,6 +75,7 @@ struct CompareImageTest: TestSuite::Tester {
     void pixelDeltaEmpty();
     void pixelDeltaOverflow();
     void pixelDeltaSpecials();
+    void pixelDeltaHalf();
 
     void compareDifferentSize();
     void compareDifferentFormat();
@@ -117,22 +123,47 @@ struct CompareImageTest: TestSuite::Tester {
     void pixelsToFileNonZeroDelta();
     void pixelsToFileError();
 
+    void benchmarkRGBA8();
+    void benchmarkR32F();
+
     private:
         Containers::Optional<PluginManager::Manager<Trade::AbstractImporter>> _importerManager;
         Containers::Optional<PluginManager::Manager<Trade::AbstractImageConverter>> _converterManager;
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadsData[]{
+    {"2 threads", 2},
+    {"5 threads", 5},
+    {"all threads", 0}
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} BenchmarkData[]{
+    {"single-threaded", 1},
+    {"all threads", 0}
+};
+
 CompareImageTest::CompareImageTest() {
     addTests({&CompareImageTest::formatUnknown,
-              &CompareImageTest::formatHalf,
               &CompareImageTest::formatImplementationSpecific,
 
               &CompareImageTest::calculateDelta,
               &CompareImageTest::calculateDeltaStorage,
               &CompareImageTest::calculateDeltaSpecials,
               &CompareImageTest::calculateDeltaSpecials3,
+              &CompareImageTest::calculateDeltaHalf,
+              &CompareImageTest::calculateDeltaNonContiguous,
+              &CompareImageTest::calculateDeltaContiguousKernels});
 
-              &CompareImageTest::deltaImage,
+    addInstancedTests({&CompareImageTest::calculateDeltaThreads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&CompareImageTest::deltaImage,
               &CompareImageTest::deltaImageScaling,
               &CompareImageTest::deltaImageColors,
               &CompareImageTest::deltaImageSpecials,
@@ -141,6 +172,7 @@ CompareImageTest::CompareImageTest() {
               &CompareImageTest::pixelDeltaEmpty,
               &CompareImageTest::pixelDeltaOverflow,
               &CompareImageTest::pixelDeltaSpecials,
+              &CompareImageTest::pixelDeltaHalf,
 
               &CompareImageTest::compareDifferentSize,
               &CompareImageTest::compareDifferentFormat,
@@ -212,6 +244,10 @@ CompareImageTest::CompareImageTest() {
         &CompareImageTest::setupExternalPluginManager,
         &CompareImageTest::teardownExternalPluginManager);
 
+    addInstancedBenchmarks({&CompareImageTest::benchmarkRGBA8,
+                            &CompareImageTest::benchmarkR32F}, 10,
+        Containers::arraySize(BenchmarkData));
+
     /* Plugin manager setup is not done here, but in the
        setupExternalPluginManager() function */
 }
@@ -251,20 +287,6 @@ void CompareImageTest::formatUnknown() {
     CORRADE_COMPARE(out.str(), "DebugTools::CompareImage: unknown format PixelFormat(0xdead)\n");
 }
 
-void CompareImageTest::formatHalf() {
-    #ifdef CORRADE_NO_ASSERT
-    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
-    #endif
-
-    std::ostringstream out;
-    Error redirectError{&out};
-
-    ImageView2D image{PixelFormat::RG16F, {}};
-    Implementation::calculateImageDelta(image.format(), image.pixels(), image);
-
-    CORRADE_COMPARE(out.str(), "DebugTools::CompareImage: half-float formats are not supported yet\n");
-}
-
 void CompareImageTest::formatImplementationSpecific() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -386,6 +408,179 @@ void CompareImageTest::calculateDeltaSpecials3() {
     CORRADE_COMPARE(mean, -Constants::nan());
 }
 
+void CompareImageTest::calculateDeltaHalf() {
+    /* Same as calculateDelta(), but with the data converted to halves */
+    Half actualData[9];
+    Half expectedData[9];
+    Float deltaData[9];
+    for(std::size_t i = 0; i != 9; ++i) {
+        actualData[i] = Half{ActualRedData[i]};
+        expectedData[i] = Half{ExpectedRedData[i]};
+        deltaData[i] = Math::abs(Float(actualData[i]) - Float(expectedData[i]));
+    }
+    const ImageView2D actual{PixelStorage{}.setAlignment(1), PixelFormat::R16F, {3, 3}, actualData};
+    const ImageView2D expected{PixelStorage{}.setAlignment(1), PixelFormat::R16F, {3, 3}, expectedData};
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+
+    CORRADE_COMPARE_AS(delta, Containers::arrayView(deltaData), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 1.0f);
+    CORRADE_COMPARE(mean, std::accumulate(deltaData, deltaData + 9, 0.0f)/9.0f);
+}
+
+void CompareImageTest::calculateDeltaNonContiguous() {
+    using namespace Math::Literals;
+
+    /* Every second pixel of the actual image is taken, which has to go
+       through the strided code path */
+    const Color4ub actualData[]{
+        0x56f83aff_rgba, 0xcafebabe_rgba, 0x5647ecff_rgba, 0xcafebabe_rgba,
+        0x235710ff_rgba, 0xcafebabe_rgba, 0xabcd85ff_rgba, 0xcafebabe_rgba
+    };
+    const Color4ub expectedData[]{
+        0x55f83aff_rgba, 0x5610edff_rgba,
+        0x232710ff_rgba, 0xabcdfaff_rgba
+    };
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {4, 2}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {2, 2}, expectedData};
+
+    Containers::Array<Float> delta;
+    Float max, mean;
+    std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels().every({1, 2, 1}), expected);
+
+    CORRADE_COMPARE_AS(delta, (Containers::Array<Float>{Containers::InPlaceInit, {
+        1.0f/4.0f, (55.0f + 1.0f)/4.0f,
+        48.0f/4.0f, 117.0f/4.0f
+    }}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(max, 117.0f/4.0f);
+    CORRADE_COMPARE(mean, 13.875f);
+}
+
+void CompareImageTest::calculateDeltaContiguousKernels() {
+    /* RGBA8, R32F and RGBA16F have dedicated kernels for tightly packed rows,
+       processing four pixels at a time. Their output is compared bit-exactly
+       to the strided code path, with the width not divisible by four to test
+       the remainder as well. */
+    constexpr std::size_t Width = 37;
+    constexpr std::size_t Height = 3;
+
+    const Float specials[]{
+        Constants::inf(), -Constants::inf(), Constants::nan(), 0.0f, -0.0f,
+        1.0e-40f, -65504.0f, 0.75f, 1.0e38f, -1.0e38f
+    };
+    const UnsignedShort halfSpecials[]{
+        0x7c00, 0xfc00, 0x7e00, 0x0000, 0x8000,
+        0x0001, 0xfbff, 0x3a00, 0x7bff, 0x3c01
+    };
+
+    /* The actual data have every pixel twice, taking every second one makes
+       the view non-contiguous */
+    Containers::Array<Color4ub> actualData{Containers::NoInit, 2*Width*Height};
+    Containers::Array<Color4ub> expectedData{Containers::NoInit, Width*Height};
+    Containers::Array<Float> actualFloatData{Containers::NoInit, 2*Width*Height};
+    Containers::Array<Float> expectedFloatData{Containers::NoInit, Width*Height};
+    Containers::Array<Vector4us> actualHalfData{Containers::NoInit, 2*Width*Height};
+    Containers::Array<Vector4us> expectedHalfData{Containers::NoInit, Width*Height};
+    for(std::size_t i = 0; i != Width*Height; ++i) {
+        const Color4ub actual{UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i*31), UnsignedByte(255 - i)};
+        actualData[2*i] = actualData[2*i + 1] = actual;
+        expectedData[i] = i % 5 ? Color4ub{UnsignedByte(i*11), UnsignedByte(i*13 + 1), UnsignedByte(i*3), UnsignedByte(i)} : actual;
+
+        actualFloatData[2*i] = actualFloatData[2*i + 1] = specials[i % 10];
+        expectedFloatData[i] = i % 3 ? specials[(i*7) % 10] : Float(i)*0.125f;
+
+        Vector4us actualHalf, expectedHalf;
+        for(std::size_t c = 0; c != 4; ++c) {
+            actualHalf[c] = halfSpecials[(i + c) % 10];
+            expectedHalf[c] = c == 3 ? actualHalf[c] : halfSpecials[(i*3 + c*7) % 10];
+        }
+        actualHalfData[2*i] = actualHalfData[2*i + 1] = actualHalf;
+        expectedHalfData[i] = expectedHalf;
+    }
+
+    for(const PixelFormat format: {PixelFormat::RGBA8Unorm, PixelFormat::R32F, PixelFormat::RGBA16F}) {
+        CORRADE_ITERATION(format);
+
+        ImageView2D actual{format, {2*Width, Height}, actualData};
+        ImageView2D expected{format, {Width, Height}, expectedData};
+        if(format == PixelFormat::R32F) {
+            actual = ImageView2D{format, {2*Width, Height}, actualFloatData};
+            expected = ImageView2D{format, {Width, Height}, expectedFloatData};
+        } else if(format == PixelFormat::RGBA16F) {
+            actual = ImageView2D{format, {2*Width, Height}, actualHalfData};
+            expected = ImageView2D{format, {Width, Height}, expectedHalfData};
+        }
+
+        Containers::Array<Float> delta;
+        Float max, mean;
+        std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels().every({1, 2, 1}), expected);
+
+        /* Making the actual pixels contiguous */
+        Containers::Array<char> contiguousData{Containers::NoInit, expected.data().size()};
+        Utility::copy(actual.pixels().every({1, 2, 1}), Containers::StridedArrayView3D<char>{contiguousData, expected.pixels().size()});
+        const ImageView2D contiguous{format, {Width, Height}, contiguousData};
+
+        Containers::Array<Float> deltaContiguous;
+        Float maxContiguous, meanContiguous;
+        std::tie(deltaContiguous, maxContiguous, meanContiguous) = Implementation::calculateImageDelta(contiguous.format(), contiguous.pixels(), expected);
+
+        /* NaNs compare unequal, so comparing the bits */
+        CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(deltaContiguous),
+            Containers::arrayCast<const UnsignedInt>(delta),
+            TestSuite::Compare::Container);
+        CORRADE_VERIFY(maxContiguous == max);
+        CORRADE_VERIFY(meanContiguous == mean || (meanContiguous != meanContiguous && mean != mean));
+    }
+}
+
+void CompareImageTest::calculateDeltaThreads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split across multiple threads */
+    Containers::Array<Color4ub> actualData{Containers::NoInit, 256*64};
+    Containers::Array<Color4ub> expectedData{Containers::NoInit, 256*64};
+    Containers::Array<Float> actualFloatData{Containers::NoInit, 256*64};
+    Containers::Array<Float> expectedFloatData{Containers::NoInit, 256*64};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = Color4ub{UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i*31), UnsignedByte(i)};
+        expectedData[i] = Color4ub{UnsignedByte(i*7 + i % 5), UnsignedByte(i*13), UnsignedByte(i*31 - i % 3), UnsignedByte(i)};
+        actualFloatData[i] = Float(i % 97)*0.125f;
+        expectedFloatData[i] = Float(i % 89)*0.125f;
+    }
+    /* Specials shouldn't affect the max even with threads */
+    actualFloatData[5000] = Constants::inf();
+    expectedFloatData[12000] = Constants::nan();
+
+    for(const PixelFormat format: {PixelFormat::RGBA8Unorm, PixelFormat::R32F}) {
+        CORRADE_ITERATION(format);
+
+        const bool isFloat = format == PixelFormat::R32F;
+        const ImageView2D actual = isFloat ?
+            ImageView2D{format, {256, 64}, actualFloatData} :
+            ImageView2D{format, {256, 64}, actualData};
+        const ImageView2D expected = isFloat ?
+            ImageView2D{format, {256, 64}, expectedFloatData} :
+            ImageView2D{format, {256, 64}, expectedData};
+
+        Containers::Array<Float> delta;
+        Float max, mean;
+        std::tie(delta, max, mean) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected);
+
+        Containers::Array<Float> deltaThreaded;
+        Float maxThreaded, meanThreaded;
+        std::tie(deltaThreaded, maxThreaded, meanThreaded) = Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, data.threadCount);
+
+        /* Comparing the max and mean bit-exactly, they should not depend on
+           the thread count */
+        CORRADE_COMPARE_AS(deltaThreaded, delta, TestSuite::Compare::Container);
+        CORRADE_VERIFY(maxThreaded == max);
+        CORRADE_VERIFY(meanThreaded == mean || (meanThreaded != meanThreaded && mean != mean));
+    }
+}
+
 void CompareImageTest::deltaImage() {
     std::ostringstream out;
     Debug d{&out, Debug::Flag::DisableColors};
@@ -543,6 +738,25 @@ void CompareImageTest::pixelDeltaSpecials() {
     #endif
 }
 
+void CompareImageTest::pixelDeltaHalf() {
+    using namespace Math::Literals;
+
+    const Vector2h actualData[]{{0.5_h, 1.0_h}, {0.25_h, 0.0_h}};
+    const Vector2h expectedData[]{{0.25_h, 1.0_h}, {0.25_h, -0.125_h}};
+    const Float delta[]{0.125f, 0.0625f};
+    const ImageView2D actual{PixelFormat::RG16F, {2, 1}, actualData};
+    const ImageView2D expected{PixelFormat::RG16F, {2, 1}, expectedData};
+
+    std::ostringstream out;
+    Debug d{&out, Debug::Flag::DisableColors};
+    Implementation::printPixelDeltas(d, delta, actual.format(), actual.pixels(), expected.pixels(), 0.1f, 0.05f, 10);
+
+    CORRADE_COMPARE(out.str(), "\n"
+        "        Pixels above max/mean threshold:\n"
+        "          [0,0] Vector(0.5, 1), expected Vector(0.25, 1) (Δ = 0.125)\n"
+        "          [1,0] Vector(0.25, 0), expected Vector(0.25, -0.125) (Δ = 0.0625)");
+}
+
 void CompareImageTest::compareDifferentSize() {
     std::stringstream out;
 
@@ -1650,4 +1864,48 @@ void CompareImageTest::pixelsToFileError() {
 
 }}}}
 
+void CompareImageTest::benchmarkRGBA8() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Color4ub> actualData{Containers::NoInit, 1024*1024};
+    Containers::Array<Color4ub> expectedData{Containers::NoInit, 1024*1024};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = Color4ub{UnsignedByte(i*7), UnsignedByte(i*13), UnsignedByte(i*31), UnsignedByte(i)};
+        expectedData[i] = Color4ub{UnsignedByte(i*7 + i % 5), UnsignedByte(i*13), UnsignedByte(i*31 - i % 3), UnsignedByte(i)};
+    }
+    const ImageView2D actual{PixelFormat::RGBA8Unorm, {1024, 1024}, actualData};
+    const ImageView2D expected{PixelFormat::RGBA8Unorm, {1024, 1024}, expectedData};
+
+    const Float expectedMax = std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected));
+
+    Float max{};
+    CORRADE_BENCHMARK(1)
+        max = std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, data.threadCount));
+
+    CORRADE_COMPARE(max, expectedMax);
+}
+
+void CompareImageTest::benchmarkR32F() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Float> actualData{Containers::NoInit, 1024*1024};
+    Containers::Array<Float> expectedData{Containers::NoInit, 1024*1024};
+    for(std::size_t i = 0; i != actualData.size(); ++i) {
+        actualData[i] = Float(i % 97)*0.125f;
+        expectedData[i] = Float(i % 89)*0.125f;
+    }
+    const ImageView2D actual{PixelFormat::R32F, {1024, 1024}, actualData};
+    const ImageView2D expected{PixelFormat::R32F, {1024, 1024}, expectedData};
+
+    const Float expectedMax = std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected));
+
+    Float max{};
+    CORRADE_BENCHMARK(1)
+        max = std::get<1>(Implementation::calculateImageDelta(actual.format(), actual.pixels(), expected, data.threadCount));
+
+    CORRADE_COMPARE(max, expectedMax);
+}
+
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::CompareImageTest)
@@ -0,0 +1,303 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/DebugDraw.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct DebugDrawGLTest: GL::OpenGLTester {
+    explicit DebugDrawGLTest();
+
+    void construct();
+    void constructBufferTooSmall();
+
+    void add();
+    void addLinesOddCount();
+    void addLineStrips();
+    void addLineStripsInvalid();
+    void lifetime();
+    void clear();
+
+    void render();
+    void renderChunked();
+    void renderDepthTest();
+
+    private:
+        GL::Renderbuffer _color{NoCreate}, _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+using namespace Math::Literals;
+
+DebugDrawGLTest::DebugDrawGLTest() {
+    addTests({&DebugDrawGLTest::construct,
+              &DebugDrawGLTest::constructBufferTooSmall,
+
+              &DebugDrawGLTest::add,
+              &DebugDrawGLTest::addLinesOddCount,
+              &DebugDrawGLTest::addLineStrips,
+              &DebugDrawGLTest::addLineStripsInvalid,
+              &DebugDrawGLTest::lifetime,
+              &DebugDrawGLTest::clear});
+
+    addTests({&DebugDrawGLTest::render,
+              &DebugDrawGLTest::renderChunked,
+              &DebugDrawGLTest::renderDepthTest},
+        [this]() {
+            _color = GL::Renderbuffer{};
+            _color.setStorage(
+                #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+                GL::RenderbufferFormat::RGBA8,
+                #else
+                GL::RenderbufferFormat::RGBA4,
+                #endif
+                Vector2i{32});
+            _depth = GL::Renderbuffer{};
+            _depth.setStorage(GL::RenderbufferFormat::DepthComponent16, Vector2i{32});
+            _framebuffer = GL::Framebuffer{{{}, Vector2i{32}}};
+            _framebuffer
+                .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+                .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+                .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+                .bind();
+        },
+        [this]() {
+            _framebuffer = GL::Framebuffer{NoCreate};
+            _color = GL::Renderbuffer{NoCreate};
+            _depth = GL::Renderbuffer{NoCreate};
+        });
+}
+
+/* NDC Y coordinate of the center of given pixel row in a 32x32 framebuffer */
+Float rowY(Int row) { return (row + 0.5f)/16.0f - 1.0f; }
+
+void DebugDrawGLTest::construct() {
+    DebugDraw draw;
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(draw.lineCount(), 0);
+    CORRADE_COMPARE(draw.lifetime(), 0.0f);
+    CORRADE_VERIFY(draw.depthTest());
+    Debug{} << "Persistently mapped:" << draw.isPersistentlyMapped();
+}
+
+void DebugDrawGLTest::constructBufferTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DebugDraw{95};
+    CORRADE_COMPARE(out.str(), "DebugTools::DebugDraw: expected buffer size to be at least 96 bytes, got 95\n");
+}
+
+void DebugDrawGLTest::add() {
+    DebugDraw draw;
+    draw.addLine({}, Vector3::xAxis(), 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 1);
+
+    draw.addPoint({}, 0.5f, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 4);
+
+    draw.addBox(Range3D{{}, Vector3{1.0f}}, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 16);
+
+    draw.setDepthTest(false)
+        .addBox(Matrix4::rotationX(35.0_degf), 0xff3366_rgbf);
+    CORRADE_VERIFY(!draw.depthTest());
+    CORRADE_COMPARE(draw.lineCount(), 28);
+
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}
+    };
+    draw.addLines(positions, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 30);
+}
+
+void DebugDrawGLTest::addLinesOddCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DebugDraw draw;
+    const Vector3 positions[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    draw.addLines(positions, 0xff3366_rgbf);
+    CORRADE_COMPARE(out.str(), "DebugTools::DebugDraw::addLines(): expected an even position count, got 3\n");
+}
+
+void DebugDrawGLTest::addLineStrips() {
+    DebugDraw draw;
+    draw.setLifetime(1.0f);
+
+    /* A three-segment strip and a single-segment one */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f}, {1.0f, 0.0f, 1.0f}
+    };
+    const UnsignedInt offsets[]{0, 4, 6};
+    draw.addLineStrips(positions, offsets, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 4);
+
+    /* No strips at all is a no-op */
+    const UnsignedInt offsetsEmpty[]{0};
+    draw.addLineStrips(nullptr, offsetsEmpty, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 4);
+
+    /* The lines got the lifetime as well */
+    draw.advance(0.5f);
+    CORRADE_COMPARE(draw.lineCount(), 4);
+    draw.advance(0.5f);
+    CORRADE_COMPARE(draw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::addLineStripsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DebugDraw draw;
+    const Vector3 positions[4]{};
+    const UnsignedInt offsets[]{0, 2, 3};
+    const UnsignedInt offsetsNotIncreasing[]{0, 2, 2, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    draw.addLineStrips(positions, nullptr, 0xff3366_rgbf);
+    draw.addLineStrips(positions, offsets, 0xff3366_rgbf);
+    draw.addLineStrips(positions, offsetsNotIncreasing, 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 0);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::DebugDraw::addLineStrips(): expected at least one offset\n"
+        "DebugTools::DebugDraw::addLineStrips(): expected the last offset to be 4 but got 3\n"
+        "DebugTools::DebugDraw::addLineStrips(): offsets 2 and 2 at index 1 are not increasing\n");
+}
+
+void DebugDrawGLTest::lifetime() {
+    DebugDraw draw;
+    draw.addLine({}, Vector3::xAxis(), 0xff3366_rgbf)
+        .setLifetime(1.0f)
+        .addPoint({}, 0.5f, 0xff3366_rgbf)
+        .setDepthTest(false)
+        .setLifetime(2.0f)
+        .addLine({}, Vector3::yAxis(), 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lifetime(), 2.0f);
+    CORRADE_COMPARE(draw.lineCount(), 5);
+
+    /* The zero-lifetime line gets discarded right away */
+    draw.advance(0.5f);
+    CORRADE_COMPARE(draw.lineCount(), 4);
+
+    draw.advance(0.5f);
+    CORRADE_COMPARE(draw.lineCount(), 1);
+
+    draw.advance(1.5f);
+    CORRADE_COMPARE(draw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::clear() {
+    DebugDraw draw;
+    draw.setLifetime(10.0f)
+        .addLine({}, Vector3::xAxis(), 0xff3366_rgbf)
+        .setDepthTest(false)
+        .addLine({}, Vector3::yAxis(), 0xff3366_rgbf);
+    CORRADE_COMPARE(draw.lineCount(), 2);
+
+    draw.clear();
+    CORRADE_COMPARE(draw.lineCount(), 0);
+}
+
+void DebugDrawGLTest::render() {
+    DebugDraw draw;
+    draw.addLine({-1.0f, rowY(16), 0.0f}, {1.0f, rowY(16), 0.0f}, 0xff3366_rgbf);
+    draw.draw({});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[16][16], 0xff3366ff_rgba);
+    CORRADE_COMPARE(image.pixels<Color4ub>()[8][16], 0x00000000_rgba);
+}
+
+void DebugDrawGLTest::renderChunked() {
+    /* Buffer for three lines, thus with persistent mapping each line is a
+       separate draw */
+    DebugDraw draw{96};
+    for(Int row = 4; row < 32; row += 4)
+        draw.addLine({-1.0f, rowY(row), 0.0f}, {1.0f, rowY(row), 0.0f}, Color4{Float(row*8)/255.0f, 1.0f, 0.0f});
+
+    /* Drawing twice to test wraparound */
+    draw.draw({});
+    draw.draw({});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    for(Int row = 4; row < 32; row += 4) {
+        CORRADE_ITERATION(row);
+        CORRADE_COMPARE(image.pixels<Color4ub>()[row][16], (Color4ub{UnsignedByte(row*8), 255, 0, 255}));
+    }
+}
+
+void DebugDrawGLTest::renderDepthTest() {
+    /* Clear depth to the near plane so everything depth-tested fails */
+    GL::Renderer::setClearDepth(0.0f);
+    _framebuffer.clear(GL::FramebufferClear::Depth);
+    GL::Renderer::setClearDepth(1.0f);
+
+    DebugDraw draw;
+    draw.addLine({-1.0f, rowY(8), 0.0f}, {1.0f, rowY(8), 0.0f}, 0xff3366_rgbf)
+        .setDepthTest(false)
+        .addLine({-1.0f, rowY(24), 0.0f}, {1.0f, rowY(24), 0.0f}, 0x33ff66_rgbf);
+    draw.draw({});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[8][16], 0x00000000_rgba);
+    CORRADE_COMPARE(image.pixels<Color4ub>()[24][16], 0x33ff66ff_rgba);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DebugDrawGLTest)
@@ -0,0 +1,292 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/ColorMap.h"
+#include "Magnum/DebugTools/DrawableStatistics.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Square.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/Scene.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct DrawableStatisticsGLTest: GL::OpenGLTester {
+    explicit DrawableStatisticsGLTest();
+
+    void construct();
+
+    void draw();
+    void drawNameReset();
+    void clear();
+    void drawOverdraw();
+    void drawOverdrawInvalidMax();
+    void heatmapColorOutOfRange();
+};
+
+DrawableStatisticsGLTest::DrawableStatisticsGLTest() {
+    addTests({&DrawableStatisticsGLTest::construct,
+
+              &DrawableStatisticsGLTest::draw,
+              &DrawableStatisticsGLTest::drawNameReset,
+              &DrawableStatisticsGLTest::clear,
+              &DrawableStatisticsGLTest::drawOverdraw,
+              &DrawableStatisticsGLTest::drawOverdrawInvalidMax,
+              &DrawableStatisticsGLTest::heatmapColorOutOfRange});
+}
+
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::pipeline_statistics_query>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::pipeline_statistics_query::string() + std::string(" is not available"))
+
+using namespace Math::Literals;
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+
+struct SquareDrawable: SceneGraph::Drawable2D {
+    explicit SquareDrawable(Object2D& object, GL::Mesh& mesh, Shaders::Flat2D& shader, SceneGraph::DrawableGroup2D& drawables): SceneGraph::Drawable2D{object, &drawables}, mesh(mesh), shader(shader) {}
+
+    void draw(const Matrix3& transformationMatrix, SceneGraph::Camera2D& camera) override {
+        shader.setTransformationProjectionMatrix(camera.projectionMatrix()*transformationMatrix)
+            .draw(mesh);
+    }
+
+    GL::Mesh& mesh;
+    Shaders::Flat2D& shader;
+};
+
+/* Two fullscreen squares and one covering the left half, drawn into a 32x32
+   framebuffer with a depth/stencil attachment */
+struct Scene {
+    explicit Scene():
+        mesh{MeshTools::compile(Primitives::squareSolid())},
+        a{scene}, b{scene}, c{scene},
+        drawableA{a, mesh, shader, drawables},
+        drawableB{b, mesh, shader, drawables},
+        drawableC{c, mesh, shader, drawables},
+        camera{scene}
+    {
+        c.scale({0.5f, 1.0f})
+         .translate({-0.5f, 0.0f});
+
+        color.setStorage(GL::RenderbufferFormat::RGBA8, Vector2i{32});
+        depthStencil.setStorage(GL::RenderbufferFormat::Depth24Stencil8, Vector2i{32});
+        framebuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+            .attachRenderbuffer(GL::Framebuffer::BufferAttachment::DepthStencil, depthStencil)
+            .clearColor(0x000000ff_rgbaf)
+            .clear(GL::FramebufferClear::Color)
+            .bind();
+    }
+
+    GL::Mesh mesh;
+    Shaders::Flat2D shader;
+    SceneGraph::Scene<SceneGraph::MatrixTransformation2D> scene;
+    SceneGraph::DrawableGroup2D drawables;
+    Object2D a, b, c;
+    SquareDrawable drawableA, drawableB, drawableC;
+    SceneGraph::Camera2D camera;
+
+    GL::Renderbuffer color, depthStencil;
+    GL::Framebuffer framebuffer{{{}, Vector2i{32}}};
+};
+
+void DrawableStatisticsGLTest::construct() {
+    DrawableStatistics2D statistics;
+    CORRADE_COMPARE(statistics.entries().size(), 0);
+    CORRADE_COMPARE(statistics.averageOverdraw({32, 32}), 0.0);
+}
+
+void DrawableStatisticsGLTest::draw() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Scene s;
+
+    DrawableStatistics2D statistics;
+    statistics
+        .setName(s.drawableA, "fullscreen")
+        .setName(s.drawableB, "fullscreen");
+    statistics.draw(s.camera, s.drawables);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The two named drawables are aggregated together, the unnamed one is
+       separate */
+    Containers::ArrayView<const DrawableStatistics2D::Entry> entries = statistics.entries();
+    CORRADE_COMPARE(entries.size(), 2);
+
+    CORRADE_COMPARE(entries[0].name, std::string{"fullscreen"});
+    CORRADE_VERIFY(!entries[0].drawable);
+    CORRADE_COMPARE(entries[0].drawCount, 2);
+    /* Implementations differ in how they count vertices of strips, so can't
+       test for exact values */
+    CORRADE_COMPARE_AS(entries[0].verticesSubmitted, 8,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(entries[0].vertexShaderInvocations, 0,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE_AS(entries[0].clippingInputPrimitives, 4,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(entries[0].samplesPassed, 2*32*32);
+
+    CORRADE_COMPARE(entries[1].name, std::string{});
+    CORRADE_COMPARE(entries[1].drawable, static_cast<const SceneGraph::Drawable2D*>(&s.drawableC));
+    CORRADE_COMPARE(entries[1].drawCount, 1);
+    CORRADE_COMPARE_AS(entries[1].verticesSubmitted, 4,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(entries[1].samplesPassed, 16*32);
+
+    CORRADE_COMPARE(statistics.averageOverdraw({32, 32}), 2.5);
+    CORRADE_COMPARE(statistics.heatmapColor(0), Color3ub{ColorMap::turbo()[255]});
+    CORRADE_COMPARE(statistics.heatmapColor(1), Color3ub{ColorMap::turbo()[63]});
+
+    /* Drawing again accumulates */
+    statistics.draw(s.camera, s.drawables);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(statistics.entries().size(), 2);
+    CORRADE_COMPARE(statistics.entries()[0].drawCount, 4);
+    CORRADE_COMPARE(statistics.entries()[0].samplesPassed, 4*32*32);
+    CORRADE_COMPARE(statistics.entries()[1].drawCount, 2);
+    CORRADE_COMPARE(statistics.averageOverdraw({32, 32}), 2.5);
+}
+
+void DrawableStatisticsGLTest::drawNameReset() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Scene s;
+
+    DrawableStatistics2D statistics;
+    statistics
+        .setName(s.drawableA, "fullscreen")
+        .setName(s.drawableB, "fullscreen")
+        .setName(s.drawableB, "");
+    statistics.draw(s.camera, s.drawables);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(statistics.entries().size(), 3);
+    CORRADE_COMPARE(statistics.entries()[0].name, std::string{"fullscreen"});
+    CORRADE_COMPARE(statistics.entries()[1].drawable, static_cast<const SceneGraph::Drawable2D*>(&s.drawableB));
+    CORRADE_COMPARE(statistics.entries()[2].drawable, static_cast<const SceneGraph::Drawable2D*>(&s.drawableC));
+}
+
+void DrawableStatisticsGLTest::clear() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Scene s;
+
+    DrawableStatistics2D statistics;
+    statistics
+        .setName(s.drawableA, "fullscreen")
+        .setName(s.drawableB, "fullscreen");
+    statistics.draw(s.camera, s.drawables);
+    statistics.clear();
+    CORRADE_COMPARE(statistics.entries().size(), 0);
+    CORRADE_COMPARE(statistics.averageOverdraw({32, 32}), 0.0);
+
+    /* The names are kept */
+    statistics.draw(s.camera, s.drawables);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(statistics.entries().size(), 2);
+    CORRADE_COMPARE(statistics.entries()[0].name, std::string{"fullscreen"});
+    CORRADE_COMPARE(statistics.entries()[0].drawCount, 2);
+}
+
+void DrawableStatisticsGLTest::drawOverdraw() {
+    Scene s;
+
+    DrawableStatistics2D statistics;
+    statistics.drawOverdraw(s.framebuffer, s.camera, s.drawables, 4);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* No statistics are collected */
+    CORRADE_COMPARE(statistics.entries().size(), 0);
+
+    /* Left half has three fragments per pixel, right half two */
+    Image2D image = s.framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[16][8].rgb(), Color3ub{ColorMap::turbo()[3*255/4]});
+    CORRADE_COMPARE(pixels[16][24].rgb(), Color3ub{ColorMap::turbo()[2*255/4]});
+
+    /* The state is reset back to defaults, so drawing normally should write
+       the color again */
+    s.shader.setColor(0xffffff_rgbf);
+    s.camera.draw(s.drawables);
+    image = s.framebuffer.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[16][24], 0xffffffff_rgba);
+}
+
+void DrawableStatisticsGLTest::drawOverdrawInvalidMax() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene s;
+
+    DrawableStatistics2D statistics;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    statistics.drawOverdraw(s.framebuffer, s.camera, s.drawables, 0);
+    statistics.drawOverdraw(s.framebuffer, s.camera, s.drawables, 256);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::DrawableStatistics::drawOverdraw(): expected max overdraw to be in range [1, 255] but got 0\n"
+        "DebugTools::DrawableStatistics::drawOverdraw(): expected max overdraw to be in range [1, 255] but got 256\n");
+}
+
+void DrawableStatisticsGLTest::heatmapColorOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DrawableStatistics2D statistics;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    statistics.heatmapColor(0);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::DrawableStatistics::heatmapColor(): index 0 out of range for 0 entries\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DrawableStatisticsGLTest)
@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/DebugTools/DynamicResolution.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct DynamicResolutionGLTest: GL::OpenGLTester {
+    explicit DynamicResolutionGLTest();
+
+    void construct();
+    void setSize();
+    void blit();
+};
+
+DynamicResolutionGLTest::DynamicResolutionGLTest() {
+    addTests({&DynamicResolutionGLTest::construct,
+              &DynamicResolutionGLTest::setSize,
+              &DynamicResolutionGLTest::blit});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+constexpr GL::TextureFormat ColorFormat = GL::TextureFormat::RGBA8;
+#else
+constexpr GL::TextureFormat ColorFormat = GL::TextureFormat::RGBA;
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::framebuffer_object>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::framebuffer_object::string() + std::string(" is not supported."))
+#elif defined(MAGNUM_TARGET_GLES2)
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::framebuffer_blit>() && \
+       !GL::Context::current().isExtensionSupported<GL::Extensions::NV::framebuffer_blit>()) \
+        CORRADE_SKIP("Neither ANGLE_framebuffer_blit nor NV_framebuffer_blit is supported.")
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+void DynamicResolutionGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLDynamicResolution resolution{{64, 32}, ColorFormat, GL::RenderbufferFormat::DepthComponent16, 16.0e6, 0.25f};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(resolution.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{64, 32}));
+    CORRADE_VERIFY(resolution.colorTexture().id());
+    CORRADE_COMPARE(resolution.framebuffer().checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+    CORRADE_COMPARE(resolution.framebuffer().viewport(), (Range2Di{{}, {64, 32}}));
+
+    /* The viewport follows the scale */
+    resolution.setScale(0.25f);
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{16, 8}));
+    CORRADE_COMPARE(resolution.framebuffer().viewport(), (Range2Di{{}, {16, 8}}));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DynamicResolutionGLTest::setSize() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLDynamicResolution resolution{{64, 32}, ColorFormat, GL::RenderbufferFormat::DepthComponent16, 16.0e6};
+    resolution.setScale(0.5f);
+    resolution.setSize({20, 40});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(resolution.size(), (Vector2i{20, 40}));
+    CORRADE_COMPARE(resolution.scaledSize(), (Vector2i{10, 20}));
+    CORRADE_COMPARE(resolution.framebuffer().checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+    CORRADE_COMPARE(resolution.framebuffer().viewport(), (Range2Di{{}, {10, 20}}));
+}
+
+void DynamicResolutionGLTest::blit() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLDynamicResolution resolution{{32, 32}, ColorFormat, GL::RenderbufferFormat::DepthComponent16, 16.0e6};
+    resolution.setScale(0.5f);
+
+    GL::Renderer::setClearColor(0xff3366_rgbf);
+    resolution.framebuffer()
+        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth);
+
+    GL::Renderbuffer color;
+    color.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{32});
+    GL::Framebuffer output{{{}, Vector2i{32}}};
+    output.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color);
+    GL::Renderer::setClearColor(0x000000_rgbf);
+    output.clear(GL::FramebufferClear::Color);
+
+    resolution.blit(output);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The 16x16 area got upscaled to the whole output */
+    Image2D image = output.read({{}, Vector2i{32}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    const Containers::StridedArrayView2D<const Color4ub> pixels = image.pixels<Color4ub>();
+    CORRADE_COMPARE(pixels[0][0], 0xff3366ff_rgba);
+    CORRADE_COMPARE(pixels[0][31], 0xff3366ff_rgba);
+    CORRADE_COMPARE(pixels[31][0], 0xff3366ff_rgba);
+    CORRADE_COMPARE(pixels[31][31], 0xff3366ff_rgba);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DynamicResolutionGLTest)
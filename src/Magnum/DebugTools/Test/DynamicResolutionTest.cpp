@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/DebugTools/DynamicResolution.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct DynamicResolutionTest: TestSuite::Tester {
+    explicit DynamicResolutionTest();
+
+    void construct();
+    void setters();
+    void scaledSize();
+
+    void updateDecrease();
+    void updateIncrease();
+    void updateHysteresis();
+    void updateClamp();
+    void updateCooldown();
+    void updateNoMeasurement();
+
+    void constructInvalidTargetDuration();
+    void constructInvalidScale();
+    void setInvalid();
+};
+
+DynamicResolutionTest::DynamicResolutionTest() {
+    addTests({&DynamicResolutionTest::construct,
+              &DynamicResolutionTest::setters,
+              &DynamicResolutionTest::scaledSize,
+
+              &DynamicResolutionTest::updateDecrease,
+              &DynamicResolutionTest::updateIncrease,
+              &DynamicResolutionTest::updateHysteresis,
+              &DynamicResolutionTest::updateClamp,
+              &DynamicResolutionTest::updateCooldown,
+              &DynamicResolutionTest::updateNoMeasurement,
+
+              &DynamicResolutionTest::constructInvalidTargetDuration,
+              &DynamicResolutionTest::constructInvalidScale,
+              &DynamicResolutionTest::setInvalid});
+}
+
+void DynamicResolutionTest::construct() {
+    DynamicResolution resolution{16.0e6, 0.25f, 0.75f};
+    CORRADE_COMPARE(resolution.targetDuration(), 16.0e6);
+    CORRADE_COMPARE(resolution.minScale(), 0.25f);
+    CORRADE_COMPARE(resolution.maxScale(), 0.75f);
+    CORRADE_COMPARE(resolution.scale(), 0.75f);
+    CORRADE_COMPARE(resolution.hysteresis(), 0.1f);
+    CORRADE_COMPARE(resolution.cooldown(), 4);
+}
+
+void DynamicResolutionTest::setters() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setTargetDuration(33.0e6)
+        .setHysteresis(0.2f)
+        .setCooldown(7)
+        .setScale(0.6f);
+    CORRADE_COMPARE(resolution.targetDuration(), 33.0e6);
+    CORRADE_COMPARE(resolution.hysteresis(), 0.2f);
+    CORRADE_COMPARE(resolution.cooldown(), 7);
+    CORRADE_COMPARE(resolution.scale(), 0.6f);
+}
+
+void DynamicResolutionTest::scaledSize() {
+    DynamicResolution resolution{16.0e6, 0.001f};
+    CORRADE_COMPARE(resolution.scaledSize({800, 600}), (Vector2i{800, 600}));
+
+    resolution.setScale(0.5f);
+    CORRADE_COMPARE(resolution.scaledSize({801, 600}), (Vector2i{401, 300}));
+
+    /* Never zero */
+    resolution.setScale(0.001f);
+    CORRADE_COMPARE(resolution.scaledSize({800, 300}), (Vector2i{1, 1}));
+}
+
+void DynamicResolutionTest::updateDecrease() {
+    DynamicResolution resolution{16.0e6};
+
+    /* Aims for the middle of the [14.4, 16] ms band, so 15.2 ms; the duration
+       is proportional to a square of the scale */
+    CORRADE_VERIFY(resolution.update(19.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.894427f);
+}
+
+void DynamicResolutionTest::updateIncrease() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setCooldown(0)
+        .setScale(0.5f);
+
+    CORRADE_VERIFY(resolution.update(9.5e6));
+    CORRADE_COMPARE(resolution.scale(), 0.632456f);
+}
+
+void DynamicResolutionTest::updateHysteresis() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setCooldown(0)
+        .setScale(0.8f);
+
+    /* Inside the band, no change */
+    CORRADE_VERIFY(!resolution.update(16.0e6));
+    CORRADE_VERIFY(!resolution.update(15.0e6));
+    CORRADE_VERIFY(!resolution.update(14.4e6));
+    CORRADE_COMPARE(resolution.scale(), 0.8f);
+
+    /* Outside of it */
+    CORRADE_VERIFY(resolution.update(14.0e6));
+    CORRADE_COMPARE_AS(resolution.scale(), 0.8f, TestSuite::Compare::Greater);
+}
+
+void DynamicResolutionTest::updateClamp() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setCooldown(0);
+
+    /* Already at the max, nothing changes */
+    CORRADE_VERIFY(!resolution.update(1.0e6));
+    CORRADE_COMPARE(resolution.scale(), 1.0f);
+
+    CORRADE_VERIFY(resolution.update(100.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+
+    /* Already at the min, nothing changes */
+    CORRADE_VERIFY(!resolution.update(100.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.5f);
+}
+
+void DynamicResolutionTest::updateCooldown() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setCooldown(2);
+
+    CORRADE_VERIFY(resolution.update(19.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.894427f);
+
+    /* The next two measurements are ignored */
+    CORRADE_VERIFY(!resolution.update(19.0e6));
+    CORRADE_VERIFY(!resolution.update(19.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.894427f);
+
+    CORRADE_VERIFY(resolution.update(19.0e6));
+    CORRADE_COMPARE(resolution.scale(), 0.8f);
+}
+
+void DynamicResolutionTest::updateNoMeasurement() {
+    DynamicResolution resolution{16.0e6};
+    resolution.setCooldown(1);
+
+    /* Doesn't count towards the cooldown either */
+    CORRADE_VERIFY(!resolution.update(0.0));
+    CORRADE_VERIFY(resolution.update(19.0e6));
+    CORRADE_VERIFY(!resolution.update(0.0));
+    CORRADE_VERIFY(!resolution.update(19.0e6));
+    CORRADE_VERIFY(resolution.update(19.0e6));
+}
+
+void DynamicResolutionTest::constructInvalidTargetDuration() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DynamicResolution{0.0};
+    CORRADE_COMPARE(out.str(), "DebugTools::DynamicResolution: expected a positive target duration, got 0\n");
+}
+
+void DynamicResolutionTest::constructInvalidScale() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DynamicResolution{16.0e6, 0.0f, 1.0f};
+    DynamicResolution{16.0e6, 0.75f, 0.5f};
+    DynamicResolution{16.0e6, 0.5f, 1.5f};
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::DynamicResolution: expected 0 < minScale <= maxScale <= 1, got 0 and 1\n"
+        "DebugTools::DynamicResolution: expected 0 < minScale <= maxScale <= 1, got 0.75 and 0.5\n"
+        "DebugTools::DynamicResolution: expected 0 < minScale <= maxScale <= 1, got 0.5 and 1.5\n");
+}
+
+void DynamicResolutionTest::setInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DynamicResolution resolution{16.0e6};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resolution.setTargetDuration(-1.0)
+        .setHysteresis(1.0f)
+        .setScale(0.25f);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::DynamicResolution::setTargetDuration(): expected a positive duration, got -1\n"
+        "DebugTools::DynamicResolution::setHysteresis(): expected a value in range [0, 1), got 1\n"
+        "DebugTools::DynamicResolution::setScale(): expected a value between 0.5 and 1, got 0.25\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::DynamicResolutionTest)
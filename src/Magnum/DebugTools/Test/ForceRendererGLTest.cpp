@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <string>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
@@ -33,6 +34,8 @@
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/DebugTools/ForceRenderer.h"
 #include "Magnum/DebugTools/ResourceManager.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -45,10 +48,6 @@
 
 #include "configure.h"
 
-#ifdef CORRADE_TARGET_ANDROID
-#include "Magnum/GL/Context.h"
-#endif
-
 namespace Magnum { namespace DebugTools { namespace Test { namespace {
 
 struct ForceRendererGLTest: GL::OpenGLTester {
@@ -61,9 +60,18 @@ struct ForceRendererGLTest: GL::OpenGLTester {
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    bool instanced;
+} RenderData[]{
+    {"", false},
+    {"instanced", true}
+};
+
 ForceRendererGLTest::ForceRendererGLTest() {
-    addTests({&ForceRendererGLTest::render2D,
-              &ForceRendererGLTest::render3D});
+    addInstancedTests({&ForceRendererGLTest::render2D,
+                       &ForceRendererGLTest::render3D},
+        Containers::arraySize(RenderData));
 
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
@@ -77,7 +85,30 @@ ForceRendererGLTest::ForceRendererGLTest() {
 
 using namespace Math::Literals;
 
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NO_INSTANCING()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::instanced_arrays>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::instanced_arrays::string() + std::string(" is not supported"))
+#elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#define SKIP_IF_NO_INSTANCING()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>() && \
+       !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::instanced_arrays>() && \
+       !GL::Context::current().isExtensionSupported<GL::Extensions::NV::instanced_arrays>()) \
+        CORRADE_SKIP("GL_{ANGLE,EXT,NV}_instanced_arrays is not supported")
+#elif defined(MAGNUM_TARGET_GLES2)
+#define SKIP_IF_NO_INSTANCING()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ANGLE::instanced_arrays>()) \
+        CORRADE_SKIP(GL::Extensions::ANGLE::instanced_arrays::string() + std::string(" is not supported"))
+#else
+#define SKIP_IF_NO_INSTANCING() do {} while(false)
+#endif
+
 void ForceRendererGLTest::render2D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.instanced) SKIP_IF_NO_INSTANCING();
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation2D> scene;
 
     SceneGraph::DrawableGroup2D drawables;
@@ -105,7 +136,13 @@ void ForceRendererGLTest::render2D() {
         .clear(GL::FramebufferClear::Color)
         .bind();
 
-    camera.draw(drawables);
+    if(data.instanced)
+        ForceRenderer2D::drawInstanced(manager, camera, drawables);
+    else
+        if(data.instanced)
+        ForceRenderer3D::drawInstanced(manager, camera, drawables);
+    else
+        camera.draw(drawables);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -130,6 +167,11 @@ void ForceRendererGLTest::render2D() {
 }
 
 void ForceRendererGLTest::render3D() {
+    auto&& data = RenderData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    if(data.instanced) SKIP_IF_NO_INSTANCING();
+
     SceneGraph::Scene<SceneGraph::MatrixTransformation3D> scene;
 
     SceneGraph::DrawableGroup3D drawables;
@@ -27,6 +27,7 @@
 #include <Corrade/Utility/System.h>
 
 #include "Magnum/DebugTools/FrameProfiler.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
@@ -49,6 +50,7 @@ struct FrameProfilerGLTest: GL::OpenGLTester {
     void vertexFetchRatioDivisionByZero();
     void primitiveClipRatioDivisionByZero();
     #endif
+    void gpuMemory();
 };
 
 struct {
@@ -72,6 +74,8 @@ FrameProfilerGLTest::FrameProfilerGLTest() {
     addTests({&FrameProfilerGLTest::vertexFetchRatioDivisionByZero,
               &FrameProfilerGLTest::primitiveClipRatioDivisionByZero});
     #endif
+
+    addTests({&FrameProfilerGLTest::gpuMemory});
 }
 
 void FrameProfilerGLTest::test() {
@@ -239,6 +243,39 @@ void FrameProfilerGLTest::primitiveClipRatioDivisionByZero() {
 }
 #endif
 
+void FrameProfilerGLTest::gpuMemory() {
+    CORRADE_VERIFY(!GL::Context::current().isResourceTracking());
+
+    GLFrameProfiler profiler{GLFrameProfiler::Value::GpuMemory, 4};
+    CORRADE_VERIFY(GL::Context::current().isResourceTracking());
+
+    GL::Buffer buffer;
+    buffer.setData({nullptr, 1024}, GL::BufferUsage::StaticDraw);
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The measurement has no delay, so all frames have the buffer. There
+       could be other objects created by the tester itself, so not testing
+       for equality. */
+    CORRADE_VERIFY(profiler.isMeasurementAvailable(GLFrameProfiler::Value::GpuMemory));
+    CORRADE_COMPARE_AS(profiler.gpuMemoryMean(), 1024.0,
+        TestSuite::Compare::GreaterOrEqual);
+
+    GL::Context::current().setResourceTracking(false);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerGLTest)
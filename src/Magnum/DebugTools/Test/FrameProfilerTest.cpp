@@ -58,8 +58,13 @@ struct FrameProfilerTest: TestSuite::Tester {
     void frameOutOfBounds();
     void dataNotAvailableYet();
     void meanNotAvailableYet();
+    void percentileNotAvailableYet();
+    void percentileOutOfRange();
 
     void statistics();
+    void percentile();
+    void timeSeriesCsv();
+    void timeSeriesCsvEmpty();
 
     #ifdef MAGNUM_TARGET_GL
     void gl();
@@ -74,6 +79,10 @@ struct FrameProfilerTest: TestSuite::Tester {
     void configurationGLValue();
     void configurationGLValues();
     #endif
+    #ifdef MAGNUM_TARGET_VK
+    void debugVkValue();
+    void debugVkValues();
+    #endif
 };
 
 struct {
@@ -132,8 +141,13 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::frameOutOfBounds,
               &FrameProfilerTest::dataNotAvailableYet,
               &FrameProfilerTest::meanNotAvailableYet,
+              &FrameProfilerTest::percentileNotAvailableYet,
+              &FrameProfilerTest::percentileOutOfRange,
 
-              &FrameProfilerTest::statistics});
+              &FrameProfilerTest::statistics,
+              &FrameProfilerTest::percentile,
+              &FrameProfilerTest::timeSeriesCsv,
+              &FrameProfilerTest::timeSeriesCsvEmpty});
 
     #ifdef MAGNUM_TARGET_GL
     addInstancedTests({&FrameProfilerTest::gl},
@@ -151,7 +165,11 @@ FrameProfilerTest::FrameProfilerTest() {
               &FrameProfilerTest::debugGLValues,
 
               &FrameProfilerTest::configurationGLValue,
-              &FrameProfilerTest::configurationGLValues
+              &FrameProfilerTest::configurationGLValues,
+              #endif
+              #ifdef MAGNUM_TARGET_VK
+              &FrameProfilerTest::debugVkValue,
+              &FrameProfilerTest::debugVkValues
               #endif
               });
 }
@@ -855,12 +873,14 @@ void FrameProfilerTest::measurementOutOfBounds() {
     profiler.measurementDelay(2);
     profiler.measurementData(2, 0);
     profiler.measurementMean(2);
+    profiler.measurementPercentile(2, 50.0);
     CORRADE_COMPARE(out.str(),
         "DebugTools::FrameProfiler::measurementName(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementUnits(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementDelay(): index 2 out of range for 2 measurements\n"
         "DebugTools::FrameProfiler::measurementData(): index 2 out of range for 2 measurements\n"
-        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n");
+        "DebugTools::FrameProfiler::measurementMean(): index 2 out of range for 2 measurements\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): index 2 out of range for 2 measurements\n");
 }
 
 void FrameProfilerTest::frameOutOfBounds() {
@@ -979,6 +999,51 @@ void FrameProfilerTest::meanNotAvailableYet() {
         "DebugTools::FrameProfiler::measurementMean(): measurement data available after 2 more frames\n");
 }
 
+void FrameProfilerTest::percentileNotAvailableYet() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count, 3,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt, UnsignedInt) { return UnsignedLong{}; }, nullptr},
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementPercentile(0, 50.0);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementPercentile(): measurement data available after 2 more frames\n");
+}
+
+void FrameProfilerTest::percentileOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr},
+    }, 3};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.measurementPercentile(0, -0.5);
+    profiler.measurementPercentile(0, 100.5);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got -0.5\n"
+        "DebugTools::FrameProfiler::measurementPercentile(): expected percentile to be in range [0, 100] but got 100.5\n");
+}
+
 void FrameProfilerTest::statistics() {
     UnsignedLong time = 0;
     FrameProfiler profiler{{
@@ -1108,6 +1173,92 @@ void FrameProfilerTest::statistics() {
         "  CPU usage: -.-- %");
 }
 
+void FrameProfilerTest::percentile() {
+    struct State {
+        UnsignedLong values[6];
+        std::size_t i;
+    } state{{50, 10, 40, 20, 30, 5}, 0};
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"", FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void* state) {
+                State& s = *static_cast<State*>(state);
+                return s.values[s.i++];
+            }, &state},
+    }, 5};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 50);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 50);
+
+    for(std::size_t i = 0; i != 4; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+    }
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 10);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 20.0), 10);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 40.0), 20);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 50.0), 30);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 95.0), 50);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 50);
+
+    /* After a wraparound the oldest value is no longer considered */
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 0.0), 5);
+    CORRADE_COMPARE(profiler.measurementPercentile(0, 100.0), 40);
+}
+
+void FrameProfilerTest::timeSeriesCsv() {
+    UnsignedLong immediate = 0, delayed = 0;
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"Immediate", FrameProfiler::Units::Count,
+            [](void*) {},
+            [](void* state) {
+                return *static_cast<UnsignedLong*>(state) += 10;
+            }, &immediate},
+        FrameProfiler::Measurement{"Delayed, \"quoted\"", FrameProfiler::Units::Count, 3,
+            [](void*, UnsignedInt) {},
+            [](void*, UnsignedInt) {},
+            [](void* state, UnsignedInt, UnsignedInt) {
+                return *static_cast<UnsignedLong*>(state) += 100;
+            }, &delayed},
+    }, 3};
+
+    profiler.beginFrame();
+    profiler.endFrame();
+    CORRADE_COMPARE(profiler.timeSeriesCsv(),
+        "Frame,Immediate,\"Delayed, \"\"quoted\"\"\"\n"
+        "0,10,\n");
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        profiler.beginFrame();
+        profiler.endFrame();
+    }
+
+    /* The immediate measurement has the first frame already overwritten, the
+       delayed has only the first two frames */
+    CORRADE_COMPARE(profiler.timeSeriesCsv(),
+        "Frame,Immediate,\"Delayed, \"\"quoted\"\"\"\n"
+        "0,,100\n"
+        "1,20,200\n"
+        "2,30,\n"
+        "3,40,\n");
+}
+
+void FrameProfilerTest::timeSeriesCsvEmpty() {
+    FrameProfiler profiler{{
+        FrameProfiler::Measurement{"Time", FrameProfiler::Units::Nanoseconds,
+            [](void*) {},
+            [](void*) { return UnsignedLong{}; }, nullptr},
+    }, 3};
+    CORRADE_COMPARE(profiler.timeSeriesCsv(), "Frame,Time\n");
+
+    /* Default-constructed profiler has no measurements */
+    CORRADE_COMPARE(FrameProfiler{}.timeSeriesCsv(), "Frame\n");
+}
+
 #ifdef MAGNUM_TARGET_GL
 void FrameProfilerTest::gl() {
     auto&& data = GLData[testCaseInstanceId()];
@@ -1184,11 +1335,13 @@ void FrameProfilerTest::glNotEnabled() {
     profiler.frameTimeMean();
     profiler.cpuDurationMean();
     profiler.gpuDurationMean();
+    profiler.gpuMemoryMean();
     CORRADE_COMPARE(out.str(),
         "DebugTools::GLFrameProfiler::isMeasurementAvailable(): DebugTools::GLFrameProfiler::Value::CpuDuration not enabled\n"
         "DebugTools::GLFrameProfiler::frameTimeMean(): not enabled\n"
         "DebugTools::GLFrameProfiler::cpuDurationMean(): not enabled\n"
-        "DebugTools::GLFrameProfiler::gpuDurationMean(): not enabled\n");
+        "DebugTools::GLFrameProfiler::gpuDurationMean(): not enabled\n"
+        "DebugTools::GLFrameProfiler::gpuMemoryMean(): not enabled\n");
 }
 #endif
 
@@ -1247,6 +1400,22 @@ void FrameProfilerTest::configurationGLValues() {
 }
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+void FrameProfilerTest::debugVkValue() {
+    std::ostringstream out;
+
+    Debug{&out} << VkFrameProfiler::Value::PrimitiveClipRatio << VkFrameProfiler::Value(0xfff0);
+    CORRADE_COMPARE(out.str(), "DebugTools::VkFrameProfiler::Value::PrimitiveClipRatio DebugTools::VkFrameProfiler::Value(0xfff0)\n");
+}
+
+void FrameProfilerTest::debugVkValues() {
+    std::ostringstream out;
+
+    Debug{&out} << (VkFrameProfiler::Value::GpuDuration|VkFrameProfiler::Value::FrameTime) << VkFrameProfiler::Values{};
+    CORRADE_COMPARE(out.str(), "DebugTools::VkFrameProfiler::Value::FrameTime|DebugTools::VkFrameProfiler::Value::GpuDuration DebugTools::VkFrameProfiler::Values{}\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::DebugTools::Test::FrameProfilerTest)
@@ -0,0 +1,267 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/DebugTools/ObjectPicker.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct ObjectPickerGLTest: GL::OpenGLTester {
+    explicit ObjectPickerGLTest();
+
+    void construct();
+    void constructInvalid();
+
+    void matrix();
+    void pick();
+    void pickClosest();
+    void pickNothing();
+    void pickBackgroundId();
+    void pollDropsOlder();
+    void pendingFull();
+};
+
+ObjectPickerGLTest::ObjectPickerGLTest() {
+    addTests({&ObjectPickerGLTest::construct,
+              &ObjectPickerGLTest::constructInvalid,
+
+              &ObjectPickerGLTest::matrix,
+              &ObjectPickerGLTest::pick,
+              &ObjectPickerGLTest::pickClosest,
+              &ObjectPickerGLTest::pickNothing,
+              &ObjectPickerGLTest::pickBackgroundId,
+              &ObjectPickerGLTest::pollDropsOlder,
+              &ObjectPickerGLTest::pendingFull});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sync>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::sync::string() + std::string(" is not available."))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+/* Instead of drawing with an object ID shader, clear single pixels of the
+   region to given IDs */
+void setId(ObjectPicker& picker, const Vector2i& pixel, const UnsignedInt id) {
+    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+    GL::Renderer::setScissor(Range2Di::fromSize(pixel, Vector2i{1}));
+    picker.framebuffer().clearColor(1, Vector4ui{id});
+    GL::Renderer::disable(GL::Renderer::Feature::ScissorTest);
+}
+
+void ObjectPickerGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{3, 5};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.radius(), 3);
+    CORRADE_COMPARE(picker.size(), (Vector2i{7}));
+    CORRADE_COMPARE(picker.capacity(), 5);
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_COMPARE(picker.backgroundId(), 0);
+    CORRADE_COMPARE(picker.framebuffer().viewport(), (Range2Di{{}, Vector2i{7}}));
+    CORRADE_COMPARE(picker.framebuffer().checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+
+    ObjectPicker defaults;
+    CORRADE_COMPARE(defaults.radius(), 2);
+    CORRADE_COMPARE(defaults.capacity(), 3);
+}
+
+void ObjectPickerGLTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ObjectPicker{-1};
+    ObjectPicker{2, 0};
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::ObjectPicker: radius can't be negative\n"
+        "DebugTools::ObjectPicker: capacity can't be zero\n");
+}
+
+void ObjectPickerGLTest::matrix() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{2};
+    const Matrix4 matrix = picker.begin({30, 10}, {100, 50});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Center of the cursor pixel maps to the center of the region, edges of
+       the 5x5 region around it to the NDC edges */
+    const Vector2 center = (Vector2{30.5f, 10.5f}/Vector2{100.0f, 50.0f})*2.0f - Vector2{1.0f};
+    const Vector2 half = Vector2{2.5f}/Vector2{100.0f, 50.0f}*2.0f;
+    CORRADE_COMPARE(matrix.transformPoint({center, 0.5f}), (Vector3{0.0f, 0.0f, 0.5f}));
+    CORRADE_COMPARE(matrix.transformPoint({center - half, 0.0f}), (Vector3{-1.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(matrix.transformPoint({center + half, 0.0f}), (Vector3{1.0f, 1.0f, 0.0f}));
+
+    /* Works with W other than 1 as well */
+    CORRADE_COMPARE(matrix*Vector4{center*2.0f, 0.0f, 2.0f}, (Vector4{0.0f, 0.0f, 0.0f, 2.0f}));
+}
+
+void ObjectPickerGLTest::pick() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{2};
+    picker.begin({30, 10}, {100, 50});
+    setId(picker, {2, 2}, 42);
+    setId(picker, {3, 2}, 17);
+    picker.end();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 1);
+
+    /* Can't really test that it's not ready yet, as that's up to the driver.
+       After a finish it has to be. */
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 42);
+    CORRADE_COMPARE(result->position, (Vector2i{30, 10}));
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+
+    /* Nothing else to retrieve */
+    CORRADE_VERIFY(!picker.poll());
+}
+
+void ObjectPickerGLTest::pickClosest() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{2};
+    picker.begin({30, 10}, {100, 50});
+    setId(picker, {0, 0}, 8);
+    setId(picker, {4, 2}, 7);
+    setId(picker, {3, 4}, 6);
+    picker.end();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The cursor pixel is background, the closest one is used */
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 7);
+}
+
+void ObjectPickerGLTest::pickNothing() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker;
+    picker.begin({30, 10}, {100, 50});
+    picker.end();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 0);
+}
+
+void ObjectPickerGLTest::pickBackgroundId() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{1};
+    picker.setBackgroundId(0xffffffffu);
+    CORRADE_COMPARE(picker.backgroundId(), 0xffffffffu);
+
+    /* Zero is a valid ID now and everything else is cleared to the
+       background */
+    picker.begin({30, 10}, {100, 50});
+    setId(picker, {0, 1}, 0);
+    picker.end();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 0);
+
+    picker.begin({30, 10}, {100, 50});
+    picker.end();
+    GL::Renderer::finish();
+    result = picker.poll();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 0xffffffffu);
+}
+
+void ObjectPickerGLTest::pollDropsOlder() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    ObjectPicker picker{0};
+    picker.begin({30, 10}, {100, 50});
+    setId(picker, {}, 1);
+    picker.end();
+    picker.begin({31, 10}, {100, 50});
+    setId(picker, {}, 2);
+    picker.end();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 2);
+
+    /* Only the newest result is returned */
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 2);
+    CORRADE_COMPARE(result->position, (Vector2i{31, 10}));
+    CORRADE_COMPARE(picker.pendingCount(), 0);
+    CORRADE_VERIFY(!picker.poll());
+}
+
+void ObjectPickerGLTest::pendingFull() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    /* Picking more times than the capacity discards the oldest picks */
+    ObjectPicker picker{0, 2};
+    for(UnsignedInt i = 0; i != 5; ++i) {
+        picker.begin({Int(i), 0}, {100, 50});
+        setId(picker, {}, i + 1);
+        picker.end();
+        CORRADE_COMPARE_AS(picker.pendingCount(), 2,
+            TestSuite::Compare::LessOrEqual);
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(picker.pendingCount(), 2);
+
+    GL::Renderer::finish();
+    Containers::Optional<ObjectPicker::Result> result = picker.poll();
+    CORRADE_VERIFY(result);
+    CORRADE_COMPARE(result->objectId, 5);
+    CORRADE_COMPARE(result->position, (Vector2i{4, 0}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ObjectPickerGLTest)
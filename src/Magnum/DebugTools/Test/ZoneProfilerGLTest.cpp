@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/DebugTools/ZoneProfiler.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct ZoneProfilerGLTest: GL::OpenGLTester {
+    explicit ZoneProfilerGLTest();
+
+    void construct();
+    void constructZeroPendingZones();
+
+    void gpuZone();
+    void gpuZoneNested();
+    void gpuZoneDisabled();
+    void gpuZoneDropped();
+};
+
+ZoneProfilerGLTest::ZoneProfilerGLTest() {
+    addTests({&ZoneProfilerGLTest::construct,
+              &ZoneProfilerGLTest::constructZeroPendingZones,
+
+              &ZoneProfilerGLTest::gpuZone,
+              &ZoneProfilerGLTest::gpuZoneNested,
+              &ZoneProfilerGLTest::gpuZoneDisabled,
+              &ZoneProfilerGLTest::gpuZoneDropped});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::timer_query>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::timer_query::string() + std::string(" is not available"))
+#elif defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query_webgl2>()) \
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query_webgl2::string() + std::string(" is not available"))
+#else
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>()) \
+        CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() + std::string(" is not available"))
+#endif
+
+void ZoneProfilerGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLZoneProfiler profiler{16, 4};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(profiler.maxEventsPerTrack(), 16);
+    CORRADE_COMPARE(profiler.maxPendingGpuZones(), 4);
+    CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 0);
+    CORRADE_COMPARE(profiler.trackCount(), 1);
+    CORRADE_COMPARE(profiler.gpuTrack(), 0);
+    CORRADE_COMPARE(profiler.trackName(profiler.gpuTrack()), "GPU");
+}
+
+void ZoneProfilerGLTest::constructZeroPendingZones() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    GLZoneProfiler{16, 0};
+    CORRADE_COMPARE(out.str(), "DebugTools::GLZoneProfiler: max pending GPU zone count can't be zero\n");
+}
+
+void ZoneProfilerGLTest::gpuZone() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    GL::Renderbuffer color;
+    color.setStorage(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{32});
+    GL::Framebuffer fb{{{}, Vector2i{32}}};
+    fb.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+      .bind();
+
+    GLZoneProfiler profiler;
+
+    const UnsignedLong before = profiler.time();
+    {
+        ZoneProfiler::Zone zone{profiler, "frame"};
+        GLZoneProfiler::GpuZone gpuZone{profiler, "clear"};
+        CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 1);
+        fb.clear(GL::FramebufferClear::Color);
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Not collected yet */
+    CORRADE_COMPARE(profiler.trackEvents(profiler.gpuTrack()).size(), 0);
+
+    GL::Renderer::finish();
+    profiler.collect();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 0);
+
+    /* The CPU zone is on a separate track */
+    CORRADE_COMPARE(profiler.trackCount(), 2);
+    CORRADE_COMPARE(profiler.trackEvents(1).size(), 1);
+
+    Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(profiler.gpuTrack());
+    CORRADE_COMPARE(events.size(), 1);
+    CORRADE_COMPARE(events[0].name, std::string{"clear"});
+    CORRADE_COMPARE(events[0].depth, 0);
+    CORRADE_COMPARE_AS(events[0].end, events[0].begin, TestSuite::Compare::GreaterOrEqual);
+    /* Can't test much else, the clocks are calibrated only roughly. But the
+       GPU zone shouldn't be before the profiler got created. */
+    CORRADE_COMPARE_AS(events[0].end, before, TestSuite::Compare::GreaterOrEqual);
+}
+
+void ZoneProfilerGLTest::gpuZoneNested() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLZoneProfiler profiler;
+    {
+        GLZoneProfiler::GpuZone outer{profiler, "outer"};
+        {
+            GLZoneProfiler::GpuZone inner{profiler, "inner"};
+        }
+
+        /* The inner zone is done, but as it's recorded in order the zones
+           were entered, it waits for the outer */
+        GL::Renderer::finish();
+        profiler.collect();
+        CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 2);
+        CORRADE_COMPARE(profiler.trackEvents(profiler.gpuTrack()).size(), 0);
+    }
+
+    GL::Renderer::finish();
+    profiler.collect();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(profiler.gpuTrack());
+    CORRADE_COMPARE(events.size(), 2);
+    CORRADE_COMPARE(events[0].name, std::string{"outer"});
+    CORRADE_COMPARE(events[0].depth, 0);
+    CORRADE_COMPARE(events[1].name, std::string{"inner"});
+    CORRADE_COMPARE(events[1].depth, 1);
+    CORRADE_COMPARE_AS(events[1].begin, events[0].begin, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[1].end, events[0].end, TestSuite::Compare::LessOrEqual);
+}
+
+void ZoneProfilerGLTest::gpuZoneDisabled() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLZoneProfiler profiler;
+    profiler.disable();
+    {
+        GLZoneProfiler::GpuZone zone{profiler, "a"};
+        CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 0);
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Renderer::finish();
+    profiler.collect();
+    CORRADE_COMPARE(profiler.trackEvents(profiler.gpuTrack()).size(), 0);
+}
+
+void ZoneProfilerGLTest::gpuZoneDropped() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLZoneProfiler profiler{16, 2};
+    for(std::size_t i = 0; i != 3; ++i) {
+        GLZoneProfiler::GpuZone zone{profiler, "a"};
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 2);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 1);
+
+    /* After collecting, the slots can be reused */
+    GL::Renderer::finish();
+    profiler.collect();
+    CORRADE_COMPARE(profiler.pendingGpuZoneCount(), 0);
+    for(std::size_t i = 0; i != 2; ++i) {
+        GLZoneProfiler::GpuZone zone{profiler, "b"};
+    }
+    GL::Renderer::finish();
+    profiler.collect();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(profiler.trackEvents(profiler.gpuTrack()).size(), 4);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ZoneProfilerGLTest)
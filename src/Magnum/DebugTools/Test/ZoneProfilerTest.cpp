@@ -0,0 +1,406 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <thread>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/DebugTools/ZoneProfiler.h"
+
+namespace Magnum { namespace DebugTools { namespace Test { namespace {
+
+struct ZoneProfilerTest: TestSuite::Tester {
+    explicit ZoneProfilerTest();
+
+    void construct();
+    void constructZeroEvents();
+
+    void zone();
+    void nested();
+    void enableDisable();
+    void threads();
+    void multipleProfilers();
+    void threadName();
+    void dropped();
+    void clear();
+
+    void addTrack();
+    void recordInvalidTrack();
+    void trackOutOfRange();
+
+    void chromeTrace();
+    void chromeTraceEscape();
+};
+
+ZoneProfilerTest::ZoneProfilerTest() {
+    addTests({&ZoneProfilerTest::construct,
+              &ZoneProfilerTest::constructZeroEvents,
+
+              &ZoneProfilerTest::zone,
+              &ZoneProfilerTest::nested,
+              &ZoneProfilerTest::enableDisable,
+              &ZoneProfilerTest::threads,
+              &ZoneProfilerTest::multipleProfilers,
+              &ZoneProfilerTest::threadName,
+              &ZoneProfilerTest::dropped,
+              &ZoneProfilerTest::clear,
+
+              &ZoneProfilerTest::addTrack,
+              &ZoneProfilerTest::recordInvalidTrack,
+              &ZoneProfilerTest::trackOutOfRange,
+
+              &ZoneProfilerTest::chromeTrace,
+              &ZoneProfilerTest::chromeTraceEscape});
+}
+
+/* Exposes the protected API for testing */
+struct DeviceProfiler: ZoneProfiler {
+    explicit DeviceProfiler(std::size_t maxEventsPerTrack = 65536): ZoneProfiler{maxEventsPerTrack} {}
+
+    using ZoneProfiler::addTrack;
+    using ZoneProfiler::record;
+    using ZoneProfiler::recordDropped;
+};
+
+void ZoneProfilerTest::construct() {
+    ZoneProfiler profiler{16};
+    CORRADE_COMPARE(profiler.maxEventsPerTrack(), 16);
+    CORRADE_VERIFY(profiler.isEnabled());
+    CORRADE_COMPARE(profiler.trackCount(), 0);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 0);
+
+    /* The time is monotonic */
+    const UnsignedLong a = profiler.time();
+    const UnsignedLong b = profiler.time();
+    CORRADE_COMPARE_AS(b, a, TestSuite::Compare::GreaterOrEqual);
+}
+
+void ZoneProfilerTest::constructZeroEvents() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ZoneProfiler{0};
+    CORRADE_COMPARE(out.str(), "DebugTools::ZoneProfiler: max event count per track can't be zero\n");
+}
+
+void ZoneProfilerTest::zone() {
+    ZoneProfiler profiler;
+
+    const UnsignedLong before = profiler.time();
+    {
+        ZoneProfiler::Zone zone{profiler, "update"};
+        /* Not recorded until the zone ends */
+        CORRADE_COMPARE(profiler.trackCount(), 1);
+        CORRADE_COMPARE(profiler.trackEvents(0).size(), 0);
+    }
+    const UnsignedLong after = profiler.time();
+
+    CORRADE_COMPARE(profiler.trackName(0), "Thread 0");
+    Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(0);
+    CORRADE_COMPARE(events.size(), 1);
+    CORRADE_COMPARE(events[0].name, std::string{"update"});
+    CORRADE_COMPARE(events[0].depth, 0);
+    CORRADE_COMPARE_AS(events[0].begin, before, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[0].end, events[0].begin, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[0].end, after, TestSuite::Compare::LessOrEqual);
+}
+
+void ZoneProfilerTest::nested() {
+    ZoneProfiler profiler;
+
+    {
+        ZoneProfiler::Zone frame{profiler, "frame"};
+        {
+            ZoneProfiler::Zone update{profiler, "update"};
+            ZoneProfiler::Zone physics{profiler, "physics"};
+        } {
+            ZoneProfiler::Zone draw{profiler, "draw"};
+        }
+    }
+
+    /* Recorded in the order the zones ended */
+    Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(0);
+    CORRADE_COMPARE(events.size(), 4);
+    CORRADE_COMPARE(events[0].name, std::string{"physics"});
+    CORRADE_COMPARE(events[0].depth, 2);
+    CORRADE_COMPARE(events[1].name, std::string{"update"});
+    CORRADE_COMPARE(events[1].depth, 1);
+    CORRADE_COMPARE(events[2].name, std::string{"draw"});
+    CORRADE_COMPARE(events[2].depth, 1);
+    CORRADE_COMPARE(events[3].name, std::string{"frame"});
+    CORRADE_COMPARE(events[3].depth, 0);
+
+    /* Children are inside their parents */
+    CORRADE_COMPARE_AS(events[0].begin, events[1].begin, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[0].end, events[1].end, TestSuite::Compare::LessOrEqual);
+    CORRADE_COMPARE_AS(events[2].begin, events[1].end, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[1].begin, events[3].begin, TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(events[2].end, events[3].end, TestSuite::Compare::LessOrEqual);
+}
+
+void ZoneProfilerTest::enableDisable() {
+    ZoneProfiler profiler;
+
+    {
+        ZoneProfiler::Zone a{profiler, "a"};
+        profiler.disable();
+        CORRADE_VERIFY(!profiler.isEnabled());
+
+        /* Not recorded, but the one entered before is */
+        ZoneProfiler::Zone b{profiler, "b"};
+    }
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 1);
+    CORRADE_COMPARE(profiler.trackEvents(0)[0].name, std::string{"a"});
+
+    profiler.enable();
+    CORRADE_VERIFY(profiler.isEnabled());
+    {
+        ZoneProfiler::Zone c{profiler, "c"};
+    }
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 2);
+    CORRADE_COMPARE(profiler.trackEvents(0)[1].name, std::string{"c"});
+    /* The depth got correctly restored */
+    CORRADE_COMPARE(profiler.trackEvents(0)[1].depth, 0);
+}
+
+void ZoneProfilerTest::threads() {
+    ZoneProfiler profiler;
+
+    {
+        ZoneProfiler::Zone zone{profiler, "main"};
+    }
+
+    std::thread threads[3];
+    for(std::thread& thread: threads) thread = std::thread{[&profiler]() {
+        for(std::size_t i = 0; i != 100; ++i) {
+            ZoneProfiler::Zone outer{profiler, "outer"};
+            ZoneProfiler::Zone inner{profiler, "inner"};
+        }
+    }};
+    for(std::thread& thread: threads) thread.join();
+
+    /* Each thread got its own track */
+    CORRADE_COMPARE(profiler.trackCount(), 4);
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 1);
+    for(UnsignedInt i = 1; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(i);
+        CORRADE_COMPARE(events.size(), 200);
+        CORRADE_COMPARE(events[198].name, std::string{"inner"});
+        CORRADE_COMPARE(events[198].depth, 1);
+        CORRADE_COMPARE(events[199].name, std::string{"outer"});
+        CORRADE_COMPARE(events[199].depth, 0);
+    }
+    CORRADE_COMPARE(profiler.droppedEventCount(), 0);
+}
+
+void ZoneProfilerTest::multipleProfilers() {
+    ZoneProfiler a, b;
+
+    /* Alternating between the two shouldn't mix up the per-thread tracks */
+    {
+        ZoneProfiler::Zone zoneA{a, "a"};
+        ZoneProfiler::Zone zoneB{b, "b"};
+        ZoneProfiler::Zone zoneA2{a, "a2"};
+    }
+
+    CORRADE_COMPARE(a.trackCount(), 1);
+    CORRADE_COMPARE(b.trackCount(), 1);
+    CORRADE_COMPARE(a.trackEvents(0).size(), 2);
+    CORRADE_COMPARE(a.trackEvents(0)[0].name, std::string{"a2"});
+    CORRADE_COMPARE(a.trackEvents(0)[0].depth, 1);
+    CORRADE_COMPARE(b.trackEvents(0).size(), 1);
+    CORRADE_COMPARE(b.trackEvents(0)[0].name, std::string{"b"});
+    CORRADE_COMPARE(b.trackEvents(0)[0].depth, 0);
+
+    /* A profiler created after another is destroyed doesn't reuse its
+       tracks even if it happens to be at the same address */
+    Containers::Pointer<ZoneProfiler> c = Containers::pointer<ZoneProfiler>();
+    {
+        ZoneProfiler::Zone zone{*c, "c"};
+    }
+    c = Containers::pointer<ZoneProfiler>();
+    CORRADE_COMPARE(c->trackCount(), 0);
+    {
+        ZoneProfiler::Zone zone{*c, "c"};
+    }
+    CORRADE_COMPARE(c->trackCount(), 1);
+}
+
+void ZoneProfilerTest::threadName() {
+    ZoneProfiler profiler;
+
+    /* Creates the track */
+    profiler.setThreadName("Main");
+    CORRADE_COMPARE(profiler.trackCount(), 1);
+    CORRADE_COMPARE(profiler.trackName(0), "Main");
+
+    /* Subsequent zones go to the same track */
+    {
+        ZoneProfiler::Zone zone{profiler, "a"};
+    }
+    CORRADE_COMPARE(profiler.trackCount(), 1);
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 1);
+}
+
+void ZoneProfilerTest::dropped() {
+    ZoneProfiler profiler{3};
+
+    for(std::size_t i = 0; i != 5; ++i) {
+        ZoneProfiler::Zone zone{profiler, "a"};
+    }
+
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 3);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 2);
+}
+
+void ZoneProfilerTest::clear() {
+    ZoneProfiler profiler{1};
+    profiler.setThreadName("Main");
+
+    for(std::size_t i = 0; i != 2; ++i) {
+        ZoneProfiler::Zone zone{profiler, "a"};
+    }
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 1);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 1);
+
+    profiler.clear();
+    CORRADE_COMPARE(profiler.trackCount(), 1);
+    CORRADE_COMPARE(profiler.trackName(0), "Main");
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 0);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 0);
+
+    {
+        ZoneProfiler::Zone zone{profiler, "b"};
+    }
+    CORRADE_COMPARE(profiler.trackEvents(0).size(), 1);
+    CORRADE_COMPARE(profiler.trackEvents(0)[0].name, std::string{"b"});
+}
+
+void ZoneProfilerTest::addTrack() {
+    DeviceProfiler profiler{2};
+
+    const UnsignedInt track = profiler.addTrack("GPU");
+    CORRADE_COMPARE(track, 0);
+    CORRADE_COMPARE(profiler.trackName(0), "GPU");
+
+    profiler.record(track, {"draw", 100, 200, 0});
+    profiler.record(track, {"blur", 300, 350, 1});
+    profiler.record(track, {"composite", 400, 500, 0});
+    profiler.recordDropped(track);
+
+    Containers::Array<ZoneProfiler::Event> events = profiler.trackEvents(track);
+    CORRADE_COMPARE(events.size(), 2);
+    CORRADE_COMPARE(events[1].name, std::string{"blur"});
+    CORRADE_COMPARE(events[1].begin, 300);
+    CORRADE_COMPARE(events[1].end, 350);
+    CORRADE_COMPARE(events[1].depth, 1);
+    CORRADE_COMPARE(profiler.droppedEventCount(), 2);
+
+    /* Zones on the calling thread get a separate track */
+    {
+        ZoneProfiler::Zone zone{profiler, "a"};
+    }
+    CORRADE_COMPARE(profiler.trackCount(), 2);
+    CORRADE_COMPARE(profiler.trackName(1), "Thread 0");
+}
+
+void ZoneProfilerTest::recordInvalidTrack() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DeviceProfiler profiler;
+    profiler.setThreadName("Main");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.record(0, {"a", 0, 0, 0});
+    profiler.recordDropped(1);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::ZoneProfiler::record(): track 0 was not added with addTrack()\n"
+        "DebugTools::ZoneProfiler::recordDropped(): track 1 was not added with addTrack()\n");
+}
+
+void ZoneProfilerTest::trackOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ZoneProfiler profiler;
+    profiler.setThreadName("Main");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    profiler.trackName(1);
+    profiler.trackEvents(1);
+    CORRADE_COMPARE(out.str(),
+        "DebugTools::ZoneProfiler::trackName(): index 1 out of range for 1 tracks\n"
+        "DebugTools::ZoneProfiler::trackEvents(): index 1 out of range for 1 tracks\n");
+}
+
+void ZoneProfilerTest::chromeTrace() {
+    DeviceProfiler profiler;
+
+    const UnsignedInt track = profiler.addTrack("GPU");
+    profiler.record(track, {"draw", 1000, 2500, 0});
+    profiler.record(track, {"blur", 12345678, 12345679, 1});
+
+    CORRADE_COMPARE(profiler.chromeTrace(),
+        "{\"traceEvents\":[\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}},\n"
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}},\n"
+        "{\"name\":\"draw\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":1.000,\"dur\":1.500},\n"
+        "{\"name\":\"blur\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":12345.678,\"dur\":0.001}\n"
+        "],\"displayTimeUnit\":\"ms\"}\n");
+
+    /* Thread tracks go to the CPU process */
+    profiler.setThreadName("Main");
+    CORRADE_VERIFY(profiler.chromeTrace().find(
+        "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Main\"}}") != std::string::npos);
+}
+
+void ZoneProfilerTest::chromeTraceEscape() {
+    DeviceProfiler profiler;
+
+    const UnsignedInt track = profiler.addTrack("\"quoted\"");
+    profiler.record(track, {"back\\slash\nnew\tline", 0, 0, 0});
+
+    const std::string out = profiler.chromeTrace();
+    CORRADE_VERIFY(out.find(
+        "\"args\":{\"name\":\"\\\"quoted\\\"\"}") != std::string::npos);
+    CORRADE_VERIFY(out.find(
+        "{\"name\":\"back\\\\slash\\u000anew\\u0009line\",") != std::string::npos);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::DebugTools::Test::ZoneProfilerTest)
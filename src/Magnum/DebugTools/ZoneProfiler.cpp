@@ -0,0 +1,432 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ZoneProfiler.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/TimeQuery.h"
+#endif
+
+namespace Magnum { namespace DebugTools {
+
+struct ZoneProfiler::Track {
+    explicit Track(const std::string& name, const std::size_t size, const std::thread::id thread, const bool device): name{name}, thread{thread}, device{device}, events{Containers::NoInit, size} {}
+
+    std::string name;
+    /* Default-constructed for device tracks, which don't belong to any
+       thread */
+    std::thread::id thread;
+    bool device;
+    /* Touched only by the owning thread */
+    UnsignedInt depth{};
+    Containers::Array<Event> events;
+    /* The owning thread writes an event first and then increments the count
+       with a release store, readers load it with acquire and then read only
+       events up to it */
+    std::atomic<std::size_t> count{};
+    std::atomic<std::size_t> dropped{};
+
+    void record(const Event& event) {
+        const std::size_t i = count.load(std::memory_order_relaxed);
+        if(i == events.size()) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        events[i] = event;
+        count.store(i + 1, std::memory_order_release);
+    }
+};
+
+namespace {
+
+/* Each profiler gets a unique ID that the per-thread track cache is keyed
+   with. Using the instance pointer instead could result in a stale cache
+   match if a new profiler gets allocated at the same address. Zero is never
+   used, which makes a zero-initialized cache always miss. */
+std::atomic<UnsignedInt> profilerIdCounter{0};
+
+struct ThreadTrackCache {
+    UnsignedInt profilerId;
+    void* track;
+};
+
+/* Not using CORRADE_THREAD_LOCAL as that's empty on builds without
+   CORRADE_BUILD_MULTITHREADED, and here the cache has to be per-thread
+   always */
+thread_local ThreadTrackCache threadTrackCache{};
+
+}
+
+struct ZoneProfiler::State {
+    explicit State(const std::size_t maxEventsPerTrack): maxEventsPerTrack{maxEventsPerTrack}, id{++profilerIdCounter}, start{std::chrono::steady_clock::now()} {}
+
+    std::size_t maxEventsPerTrack;
+    UnsignedInt id;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<bool> enabled{true};
+
+    /* Guards the track list, not the track contents. Tracks are stored
+       through a pointer so they stay at the same place when the list grows. */
+    mutable std::mutex mutex;
+    Containers::Array<Containers::Pointer<Track>> tracks;
+    UnsignedInt threadTrackCount{};
+};
+
+ZoneProfiler::ZoneProfiler(const std::size_t maxEventsPerTrack) {
+    CORRADE_ASSERT(maxEventsPerTrack,
+        "DebugTools::ZoneProfiler: max event count per track can't be zero", );
+    _state.emplace(maxEventsPerTrack);
+}
+
+ZoneProfiler::~ZoneProfiler() = default;
+
+std::size_t ZoneProfiler::maxEventsPerTrack() const {
+    return _state->maxEventsPerTrack;
+}
+
+bool ZoneProfiler::isEnabled() const {
+    return _state->enabled.load(std::memory_order_relaxed);
+}
+
+void ZoneProfiler::enable() {
+    _state->enabled.store(true, std::memory_order_relaxed);
+}
+
+void ZoneProfiler::disable() {
+    _state->enabled.store(false, std::memory_order_relaxed);
+}
+
+UnsignedLong ZoneProfiler::time() const {
+    /* libc++ 10 needs an explicit cast to UnsignedLong */
+    return UnsignedLong(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _state->start).count());
+}
+
+ZoneProfiler::Track& ZoneProfiler::addTrackInternal(const std::string& name, const bool device) {
+    arrayAppend(_state->tracks, Containers::pointer<Track>(name, _state->maxEventsPerTrack, device ? std::thread::id{} : std::this_thread::get_id(), device));
+    return *_state->tracks.back();
+}
+
+ZoneProfiler::Track& ZoneProfiler::currentThreadTrack() {
+    if(threadTrackCache.profilerId == _state->id)
+        return *static_cast<Track*>(threadTrackCache.track);
+
+    /* Slow path, the thread either didn't enter a zone yet or it used a
+       different profiler in the meantime */
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    const std::thread::id thread = std::this_thread::get_id();
+    Track* track = nullptr;
+    for(Containers::Pointer<Track>& i: _state->tracks) {
+        if(i->device || i->thread != thread) continue;
+        track = i.get();
+        break;
+    }
+    if(!track)
+        track = &addTrackInternal("Thread " + std::to_string(_state->threadTrackCount++), false);
+
+    threadTrackCache.profilerId = _state->id;
+    threadTrackCache.track = track;
+    return *track;
+}
+
+void ZoneProfiler::setThreadName(const std::string& name) {
+    Track& track = currentThreadTrack();
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    track.name = name;
+}
+
+UnsignedInt ZoneProfiler::trackCount() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->tracks.size();
+}
+
+std::string ZoneProfiler::trackName(const UnsignedInt id) const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    CORRADE_ASSERT(id < _state->tracks.size(),
+        "DebugTools::ZoneProfiler::trackName(): index" << id << "out of range for" << _state->tracks.size() << "tracks", {});
+    return _state->tracks[id]->name;
+}
+
+Containers::Array<ZoneProfiler::Event> ZoneProfiler::trackEvents(const UnsignedInt id) const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    CORRADE_ASSERT(id < _state->tracks.size(),
+        "DebugTools::ZoneProfiler::trackEvents(): index" << id << "out of range for" << _state->tracks.size() << "tracks", {});
+    const Track& track = *_state->tracks[id];
+    const std::size_t count = track.count.load(std::memory_order_acquire);
+    Containers::Array<Event> out{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i) out[i] = track.events[i];
+    return out;
+}
+
+std::size_t ZoneProfiler::droppedEventCount() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    std::size_t count = 0;
+    for(const Containers::Pointer<Track>& track: _state->tracks)
+        count += track->dropped.load(std::memory_order_relaxed);
+    return count;
+}
+
+void ZoneProfiler::clear() {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    for(Containers::Pointer<Track>& track: _state->tracks) {
+        track->count.store(0, std::memory_order_release);
+        track->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+UnsignedInt ZoneProfiler::addTrack(const std::string& name) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    addTrackInternal(name, true);
+    return _state->tracks.size() - 1;
+}
+
+void ZoneProfiler::record(const UnsignedInt track, const Event& event) {
+    Track* t;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        CORRADE_ASSERT(track < _state->tracks.size() && _state->tracks[track]->device,
+            "DebugTools::ZoneProfiler::record(): track" << track << "was not added with addTrack()", );
+        t = _state->tracks[track].get();
+    }
+    t->record(event);
+}
+
+void ZoneProfiler::recordDropped(const UnsignedInt track) {
+    Track* t;
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        CORRADE_ASSERT(track < _state->tracks.size() && _state->tracks[track]->device,
+            "DebugTools::ZoneProfiler::recordDropped(): track" << track << "was not added with addTrack()", );
+        t = _state->tracks[track].get();
+    }
+    t->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+
+void appendJsonString(std::string& out, const char* string) {
+    out += '"';
+    for(const char* c = string; *c; ++c) {
+        if(*c == '"' || *c == '\\') {
+            out += '\\';
+            out += *c;
+        } else if(UnsignedByte(*c) < 0x20) {
+            constexpr const char Hex[] = "0123456789abcdef";
+            out += "\\u00";
+            out += Hex[UnsignedByte(*c) >> 4];
+            out += Hex[UnsignedByte(*c) & 0xf];
+        } else out += *c;
+    }
+    out += '"';
+}
+
+/* Microseconds with a nanosecond precision, without going through a float
+   that would lose precision for long captures */
+void appendMicroseconds(std::string& out, const UnsignedLong nanoseconds) {
+    const UnsignedLong fraction = nanoseconds % 1000;
+    out += std::to_string(nanoseconds/1000);
+    out += '.';
+    out += char('0' + fraction/100);
+    out += char('0' + fraction/10 % 10);
+    out += char('0' + fraction % 10);
+}
+
+}
+
+std::string ZoneProfiler::chromeTrace() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    std::string out = "{\"traceEvents\":[\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"CPU\"}},\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+
+    for(std::size_t i = 0; i != _state->tracks.size(); ++i) {
+        const Track& track = *_state->tracks[i];
+        const std::string pidTid = Utility::formatString("\"pid\":{},\"tid\":{}", track.device ? 1 : 0, i);
+
+        out += ",\n{\"name\":\"thread_name\",\"ph\":\"M\",";
+        out += pidTid;
+        out += ",\"args\":{\"name\":";
+        appendJsonString(out, track.name.data());
+        out += "}}";
+
+        const std::size_t count = track.count.load(std::memory_order_acquire);
+        for(std::size_t j = 0; j != count; ++j) {
+            const Event& event = track.events[j];
+            out += ",\n{\"name\":";
+            appendJsonString(out, event.name);
+            out += ",\"ph\":\"X\",";
+            out += pidTid;
+            out += ",\"ts\":";
+            appendMicroseconds(out, event.begin);
+            out += ",\"dur\":";
+            appendMicroseconds(out, event.end - event.begin);
+            out += '}';
+        }
+    }
+
+    out += "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool ZoneProfiler::saveChromeTrace(const std::string& filename) const {
+    if(!Utility::Directory::writeString(filename, chromeTrace())) {
+        Error{} << "DebugTools::ZoneProfiler::saveChromeTrace(): cannot write to file" << filename;
+        return false;
+    }
+
+    return true;
+}
+
+ZoneProfiler::Zone::Zone(ZoneProfiler& profiler, const char* const name): _profiler(profiler), _track{}, _name{name}, _begin{} {
+    if(!profiler.isEnabled()) return;
+
+    _track = &profiler.currentThreadTrack();
+    ++_track->depth;
+    _begin = profiler.time();
+}
+
+ZoneProfiler::Zone::~Zone() {
+    if(!_track) return;
+
+    const UnsignedLong end = _profiler.time();
+    _track->record(Event{_name, _begin, end, --_track->depth});
+}
+
+#ifdef MAGNUM_TARGET_GL
+struct GLZoneProfiler::GpuState {
+    struct Slot {
+        const char* name;
+        UnsignedInt depth;
+        bool ended;
+    };
+
+    /* Slots form a ring, allocated in the order zones are entered. Each slot
+       has a begin and end query at 2*i and 2*i + 1. */
+    Containers::Array<GL::TimeQuery> queries;
+    Containers::Array<Slot> slots;
+    UnsignedInt first{}, count{};
+    UnsignedInt depth{};
+    UnsignedInt track;
+    /* GPU time minus CPU time */
+    Long offset{};
+};
+
+GLZoneProfiler::GLZoneProfiler(const std::size_t maxEventsPerTrack, const UnsignedInt maxPendingGpuZones): ZoneProfiler{maxEventsPerTrack} {
+    CORRADE_ASSERT(maxPendingGpuZones,
+        "DebugTools::GLZoneProfiler: max pending GPU zone count can't be zero", );
+
+    _gpuState.emplace();
+    _gpuState->queries = Containers::Array<GL::TimeQuery>{Containers::DirectInit, 2*maxPendingGpuZones, GL::TimeQuery::Target::Timestamp};
+    _gpuState->slots = Containers::Array<GpuState::Slot>{Containers::ValueInit, maxPendingGpuZones};
+    _gpuState->track = addTrack("GPU");
+
+    calibrate();
+}
+
+GLZoneProfiler::~GLZoneProfiler() = default;
+
+UnsignedInt GLZoneProfiler::maxPendingGpuZones() const {
+    return _gpuState->slots.size();
+}
+
+UnsignedInt GLZoneProfiler::pendingGpuZoneCount() const {
+    return _gpuState->count;
+}
+
+UnsignedInt GLZoneProfiler::gpuTrack() const {
+    return _gpuState->track;
+}
+
+void GLZoneProfiler::calibrate() {
+    /* After a finish the timestamp query gets processed right away, so its
+       result corresponds to the CPU time at which it was issued */
+    GL::Renderer::finish();
+    GL::TimeQuery query{GL::TimeQuery::Target::Timestamp};
+    query.timestamp();
+    const UnsignedLong cpu = time();
+    const UnsignedLong gpu = query.result<UnsignedLong>();
+    _gpuState->offset = Long(gpu) - Long(cpu);
+}
+
+void GLZoneProfiler::collect() {
+    GpuState& state = *_gpuState;
+    while(state.count) {
+        GpuState::Slot& slot = state.slots[state.first];
+        GL::TimeQuery& end = state.queries[2*state.first + 1];
+        if(!slot.ended || !end.resultAvailable()) break;
+
+        /* Convert to the CPU time base, clamping to zero in case the zone
+           started before the profiler got created */
+        const Long begin = Long(state.queries[2*state.first].result<UnsignedLong>()) - state.offset;
+        const Long endTime = Long(end.result<UnsignedLong>()) - state.offset;
+        record(state.track, Event{slot.name,
+            begin < 0 ? 0 : UnsignedLong(begin),
+            endTime < 0 ? 0 : UnsignedLong(endTime),
+            slot.depth});
+
+        state.first = (state.first + 1) % state.slots.size();
+        --state.count;
+    }
+}
+
+GLZoneProfiler::GpuZone::GpuZone(GLZoneProfiler& profiler, const char* const name): _profiler(profiler), _slot{~UnsignedInt{}} {
+    if(!profiler.isEnabled()) return;
+
+    GpuState& state = *profiler._gpuState;
+    if(state.count == state.slots.size()) {
+        profiler.recordDropped(state.track);
+        return;
+    }
+
+    _slot = (state.first + state.count) % state.slots.size();
+    ++state.count;
+    state.slots[_slot] = GpuState::Slot{name, state.depth++, false};
+    state.queries[2*_slot].timestamp();
+}
+
+GLZoneProfiler::GpuZone::~GpuZone() {
+    if(_slot == ~UnsignedInt{}) return;
+
+    GpuState& state = *_profiler._gpuState;
+    state.queries[2*_slot + 1].timestamp();
+    state.slots[_slot].ended = true;
+    --state.depth;
+}
+#endif
+
+}}
@@ -0,0 +1,464 @@
+#ifndef Magnum_DebugTools_ZoneProfiler_h
+#define Magnum_DebugTools_ZoneProfiler_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::DebugTools::ZoneProfiler, @ref Magnum::DebugTools::GLZoneProfiler
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/DebugTools/visibility.h"
+
+namespace Magnum { namespace DebugTools {
+
+/**
+@brief Hierarchical zone profiler
+@m_since_latest
+
+While @ref FrameProfiler aggregates measurements of whole frames, this class
+records individual nested *zones* --- named time intervals marked with a
+@ref Zone instance that lives for the duration of a scope --- on a timeline of
+each thread that entered them. The result can be exported into the
+[Chrome trace event format](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/)
+and inspected in `chrome://tracing` or the [Perfetto UI](https://ui.perfetto.dev),
+showing exactly which part of a frame takes how long:
+
+@snippet MagnumDebugTools.cpp ZoneProfiler-usage
+
+For GPU zones measured with an OpenGL timer query see @ref GLZoneProfiler.
+
+@experimental
+
+@section DebugTools-ZoneProfiler-threads Threads and tracks
+
+Zones entered on a particular thread are recorded into a *track* dedicated to
+that thread, which gets created the first time the thread enters a zone. The
+track is named @cb{.txt} Thread N @ce by default, use @ref setThreadName() to
+give it a better name. Each track has a fixed-size event buffer, allocated
+upfront with a size passed to the constructor, and only the owning thread
+writes to it, so entering and leaving a zone doesn't involve any locks or
+allocations. A mutex is locked only when a thread enters a zone of this
+profiler for the first time. If a buffer gets full, subsequent zones on given
+thread are not recorded and only counted in @ref droppedEventCount().
+
+Zones are recorded when they end, and it's possible to call
+@ref trackEvents() or @ref chromeTrace() while other threads are still
+recording --- zones that didn't end yet will not be included in the output.
+
+@section DebugTools-ZoneProfiler-zone-names Zone names
+
+To avoid allocations, zone names are stored as plain @cpp const char* @ce
+pointers and thus have to stay in scope for the whole lifetime of the
+profiler. The usual case of passing string literals satisfies this.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT ZoneProfiler {
+    public:
+        /**
+         * @brief Recorded event
+         *
+         * @see @ref trackEvents()
+         */
+        struct Event {
+            /**
+             * Zone name, as passed to the @ref Zone constructor. Not owned by
+             * the profiler.
+             */
+            const char* name;
+
+            /**
+             * Zone begin, in nanoseconds since the profiler was created
+             */
+            UnsignedLong begin;
+
+            /**
+             * Zone end, in nanoseconds since the profiler was created
+             */
+            UnsignedLong end;
+
+            /**
+             * Nesting depth of the zone on its track. Top-level zones have a
+             * depth of @cpp 0 @ce.
+             */
+            UnsignedInt depth;
+        };
+
+        class Zone;
+
+        /**
+         * @brief Constructor
+         * @param maxEventsPerTrack     Size of the event buffer allocated for
+         *      every track. Expected to be non-zero.
+         */
+        explicit ZoneProfiler(std::size_t maxEventsPerTrack = 65536);
+
+        /**
+         * @brief Copying is not allowed
+         *
+         * Threads that entered a zone keep a reference to the profiler
+         * instance, so it's not movable either.
+         */
+        ZoneProfiler(const ZoneProfiler&) = delete;
+
+        /** @brief Moving is not allowed */
+        ZoneProfiler(ZoneProfiler&&) = delete;
+
+        virtual ~ZoneProfiler();
+
+        /** @brief Copying is not allowed */
+        ZoneProfiler& operator=(const ZoneProfiler&) = delete;
+
+        /** @brief Moving is not allowed */
+        ZoneProfiler& operator=(ZoneProfiler&&) = delete;
+
+        /** @brief Size of the event buffer allocated for every track */
+        std::size_t maxEventsPerTrack() const;
+
+        /** @brief Whether the profiling is enabled */
+        bool isEnabled() const;
+
+        /**
+         * @brief Enable the profiler
+         *
+         * The profiler is enabled implicitly after construction. Can be called
+         * from any thread.
+         */
+        void enable();
+
+        /**
+         * @brief Disable the profiler
+         *
+         * Zones entered while the profiler is disabled are not recorded,
+         * zones that were entered before will still get recorded on their
+         * end. Can be called from any thread.
+         */
+        void disable();
+
+        /**
+         * @brief Current time
+         *
+         * In nanoseconds since the profiler was created, measured with
+         * @ref std::chrono::steady_clock. Used as a time base for all
+         * @ref Event instances.
+         */
+        UnsignedLong time() const;
+
+        /**
+         * @brief Set name of a track corresponding to the calling thread
+         *
+         * Creates the track if the calling thread didn't enter any zone yet.
+         */
+        void setThreadName(const std::string& name);
+
+        /** @brief Track count */
+        UnsignedInt trackCount() const;
+
+        /**
+         * @brief Track name
+         *
+         * Expects that @p id is less than @ref trackCount().
+         */
+        std::string trackName(UnsignedInt id) const;
+
+        /**
+         * @brief Events recorded in given track
+         *
+         * Returns a copy of all zones that ended so far, in order they ended.
+         * Expects that @p id is less than @ref trackCount().
+         */
+        Containers::Array<Event> trackEvents(UnsignedInt id) const;
+
+        /**
+         * @brief Count of events that didn't fit into track buffers
+         *
+         * Summed across all tracks.
+         * @see @ref maxEventsPerTrack()
+         */
+        std::size_t droppedEventCount() const;
+
+        /**
+         * @brief Discard all recorded events
+         *
+         * Tracks and their names are kept. Expects that no other thread is
+         * recording at the same time.
+         */
+        void clear();
+
+        /**
+         * @brief Events in the Chrome trace event format
+         *
+         * Returns a JSON with events from all tracks, with tracks of
+         * individual threads in a process named @cb{.txt} CPU @ce and tracks
+         * added via @ref addTrack() in a process named @cb{.txt} GPU @ce.
+         * Zones are exported as complete (@cb{.json} "ph": "X" @ce) events
+         * with timestamps in microseconds.
+         */
+        std::string chromeTrace() const;
+
+        /**
+         * @brief Save events in the Chrome trace event format to a file
+         *
+         * Saves output of @ref chromeTrace() to @p filename. Prints a message
+         * to @relativeref{Magnum,Error} and returns @cpp false @ce if the
+         * file can't be written, @cpp true @ce otherwise.
+         */
+        bool saveChromeTrace(const std::string& filename) const;
+
+    protected:
+        /**
+         * @brief Add a track not associated with any thread
+         *
+         * Meant to be used by subclasses for device timelines. Returns ID of
+         * the track, to be used with @ref record(). Can be called from any
+         * thread.
+         */
+        UnsignedInt addTrack(const std::string& name);
+
+        /**
+         * @brief Record an event
+         *
+         * Expects that @p track was returned from @ref addTrack(). Only one
+         * thread is allowed to record into given track.
+         */
+        void record(UnsignedInt track, const Event& event);
+
+        /**
+         * @brief Record a dropped event
+         *
+         * Increments @ref droppedEventCount() for an event that couldn't be
+         * recorded. Expects that @p track was returned from @ref addTrack().
+         */
+        void recordDropped(UnsignedInt track);
+
+    private:
+        struct Track;
+        struct State;
+
+        MAGNUM_DEBUGTOOLS_LOCAL Track& currentThreadTrack();
+        MAGNUM_DEBUGTOOLS_LOCAL Track& addTrackInternal(const std::string& name, bool device);
+
+        Containers::Pointer<State> _state;
+};
+
+/**
+@brief Profiler zone
+@m_since_latest
+
+Records a zone between its construction and destruction on a track of the
+calling thread. See @ref ZoneProfiler for more information.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT ZoneProfiler::Zone {
+    public:
+        /**
+         * @brief Constructor
+         * @param profiler  Profiler to record the zone into
+         * @param name      Zone name. Has to stay in scope for the whole
+         *      lifetime of @p profiler, see
+         *      @ref DebugTools-ZoneProfiler-zone-names for more information.
+         *
+         * If the profiler is disabled, the zone is not recorded.
+         */
+        explicit Zone(ZoneProfiler& profiler, const char* name);
+
+        /** @brief Copying is not allowed */
+        Zone(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone(Zone&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Records the zone.
+         */
+        ~Zone();
+
+        /** @brief Copying is not allowed */
+        Zone& operator=(const Zone&) = delete;
+
+        /** @brief Moving is not allowed */
+        Zone& operator=(Zone&&) = delete;
+
+    private:
+        ZoneProfiler& _profiler;
+        /* Null if the profiler was disabled at the time the zone was
+           entered */
+        Track* _track;
+        const char* _name;
+        UnsignedLong _begin;
+};
+
+#ifdef MAGNUM_TARGET_GL
+/**
+@brief OpenGL zone profiler
+@m_since_latest
+
+In addition to CPU zones recorded by @ref ZoneProfiler, this class can record
+*GPU zones* using a @ref GpuZone instance, which measures time spent by the GPU
+on commands issued during its lifetime using a pair of
+@ref GL::TimeQuery::timestamp() queries. The GPU zones are recorded into a
+dedicated @cb{.txt} GPU @ce track, with timestamps converted to the CPU time
+base of the profiler so they can be matched with the CPU zones that issued the
+commands:
+
+@snippet MagnumDebugTools-gl.cpp GLZoneProfiler-usage
+
+@section DebugTools-GLZoneProfiler-delayed Delayed queries
+
+Similarly to delayed measurements in @ref FrameProfiler, results of the GPU
+zones are not retrieved immediately as that would stall the pipeline. Instead,
+the class keeps a ring of query pairs, with size specified in the constructor,
+and @ref collect(), called once a frame, records only the zones for which the
+GPU already produced a result, without blocking. If the ring gets full,
+subsequent GPU zones are not recorded and only counted in
+@ref droppedEventCount().
+
+@section DebugTools-GLZoneProfiler-calibration Clock calibration
+
+Difference between the CPU and GPU clock is measured in the constructor by
+waiting for the GPU to finish all work and then comparing a GPU timestamp with
+a CPU timestamp. As the two clocks may drift over time, it's possible to
+recalibrate them with @ref calibrate() later, for example when the profiling is
+enabled again. Apart from that, GPU zones are expected to be used only from
+the thread that has the GL context current.
+
+@requires_gl33 Extension @gl_extension{ARB,timer_query}
+@requires_es_extension Extension @gl_extension{EXT,disjoint_timer_query}
+@requires_webgl_extension Extension @webgl_extension{EXT,disjoint_timer_query}
+    on WebGL 1, @gl_extension{EXT,disjoint_timer_query_webgl2} on WebGL 2
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT GLZoneProfiler: public ZoneProfiler {
+    public:
+        class GpuZone;
+
+        /**
+         * @brief Constructor
+         * @param maxEventsPerTrack     Size of the event buffer allocated for
+         *      every track. Expected to be non-zero.
+         * @param maxPendingGpuZones    Max count of GPU zones waiting for a
+         *      result. Expected to be non-zero.
+         *
+         * Creates @cpp 2*maxPendingGpuZones @ce timer queries and calls
+         * @ref calibrate().
+         */
+        explicit GLZoneProfiler(std::size_t maxEventsPerTrack = 65536, UnsignedInt maxPendingGpuZones = 256);
+
+        ~GLZoneProfiler();
+
+        /** @brief Max count of GPU zones waiting for a result */
+        UnsignedInt maxPendingGpuZones() const;
+
+        /** @brief Count of GPU zones waiting for a result */
+        UnsignedInt pendingGpuZoneCount() const;
+
+        /**
+         * @brief ID of the GPU track
+         *
+         * The track is named @cb{.txt} GPU @ce.
+         */
+        UnsignedInt gpuTrack() const;
+
+        /**
+         * @brief Calibrate the CPU and GPU clock difference
+         *
+         * Waits for the GPU to finish all work, thus stalling the pipeline.
+         * See @ref DebugTools-GLZoneProfiler-calibration for more
+         * information.
+         */
+        void calibrate();
+
+        /**
+         * @brief Collect finished GPU zones
+         *
+         * Records all GPU zones for which results are available into
+         * @ref gpuTrack(), in the order they were entered, stopping at the
+         * first zone that's not finished yet. Doesn't block. Expected to be
+         * called once a frame.
+         */
+        void collect();
+
+    private:
+        struct GpuState;
+
+        Containers::Pointer<GpuState> _gpuState;
+};
+
+/**
+@brief GPU profiler zone
+@m_since_latest
+
+Measures time spent by the GPU on commands issued between its construction and
+destruction. See @ref GLZoneProfiler for more information.
+*/
+class MAGNUM_DEBUGTOOLS_EXPORT GLZoneProfiler::GpuZone {
+    public:
+        /**
+         * @brief Constructor
+         * @param profiler  Profiler to record the zone into
+         * @param name      Zone name. Has to stay in scope for the whole
+         *      lifetime of @p profiler, see
+         *      @ref DebugTools-ZoneProfiler-zone-names for more information.
+         *
+         * If the profiler is disabled or all
+         * @ref GLZoneProfiler::maxPendingGpuZones() are pending, the zone is
+         * not recorded.
+         */
+        explicit GpuZone(GLZoneProfiler& profiler, const char* name);
+
+        /** @brief Copying is not allowed */
+        GpuZone(const GpuZone&) = delete;
+
+        /** @brief Moving is not allowed */
+        GpuZone(GpuZone&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Issues the end timestamp query. The zone is recorded in a later
+         * @ref GLZoneProfiler::collect() call.
+         */
+        ~GpuZone();
+
+        /** @brief Copying is not allowed */
+        GpuZone& operator=(const GpuZone&) = delete;
+
+        /** @brief Moving is not allowed */
+        GpuZone& operator=(GpuZone&&) = delete;
+
+    private:
+        GLZoneProfiler& _profiler;
+        /* ~UnsignedInt{} if the zone isn't recorded */
+        UnsignedInt _slot;
+};
+#endif
+
+}}
+
+#endif
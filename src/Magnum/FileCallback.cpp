@@ -25,7 +25,11 @@
 
 #include "FileCallback.h"
 
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Directory.h>
 
 namespace Magnum {
 
@@ -45,4 +49,46 @@ Debug& operator<<(Debug& debug, const InputFileCallbackPolicy value) {
     return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+struct MappedFileCallback::State {
+    std::unordered_map<std::string, Containers::Array<const char, Utility::Directory::MapDeleter>> files;
+};
+
+MappedFileCallback::MappedFileCallback(): _state{Containers::InPlaceInit} {}
+
+MappedFileCallback::MappedFileCallback(MappedFileCallback&&) noexcept = default;
+
+MappedFileCallback::~MappedFileCallback() = default;
+
+MappedFileCallback& MappedFileCallback::operator=(MappedFileCallback&&) noexcept = default;
+
+std::size_t MappedFileCallback::mappedCount() const {
+    return _state->files.size();
+}
+
+bool MappedFileCallback::isMapped(const std::string& filename) const {
+    return _state->files.find(filename) != _state->files.end();
+}
+
+void MappedFileCallback::unmap() {
+    _state->files.clear();
+}
+
+Containers::Optional<Containers::ArrayView<const char>> MappedFileCallback::callback(const std::string& filename, const InputFileCallbackPolicy policy, MappedFileCallback& state) {
+    /* The mappings are kept until unmap() so the memory can be referenced by
+       data returned from importers with ImporterFlag::ZeroCopy. Keeping a
+       mapping around is cheap, as the OS can evict its pages anytime. */
+    if(policy == InputFileCallbackPolicy::Close) return {};
+
+    auto found = state._state->files.find(filename);
+    if(found == state._state->files.end()) {
+        Containers::Array<const char, Utility::Directory::MapDeleter> data = Utility::Directory::mapRead(filename);
+        if(!data) return {};
+        found = state._state->files.emplace(filename, std::move(data)).first;
+    }
+
+    return Containers::ArrayView<const char>{found->second};
+}
+#endif
+
 }
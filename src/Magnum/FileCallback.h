@@ -26,9 +26,12 @@
 */
 
 /** @file
- * @brief Enum @ref Magnum::InputFileCallbackPolicy
+ * @brief Enum @ref Magnum::InputFileCallbackPolicy, class @ref Magnum::MappedFileCallback
  */
 
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/StlForwardString.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/visibility.h"
 
@@ -100,6 +103,86 @@ enum class InputFileCallbackPolicy: UnsignedByte {
 /** @debugoperatorenum{InputFileCallbackPolicy} */
 MAGNUM_EXPORT Debug& operator<<(Debug& debug, InputFileCallbackPolicy value);
 
+#if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Memory-mapping file callback
+@m_since_latest
+
+A file callback for @ref Trade::AbstractImporter::setFileCallback() that
+memory-maps the requested files using @ref Utility::Directory::mapRead()
+instead of reading them to memory. Only the parts of the file that are
+actually accessed get paged in, which means opening a large file doesn't
+require it to be fully read first, and the OS can evict the pages again if
+memory is needed.
+
+The files are mapped on the first request regardless of the
+@ref InputFileCallbackPolicy and repeated requests return the existing
+mapping. @ref InputFileCallbackPolicy::Close is ignored --- the mappings are
+kept alive until @ref unmap() is called or the instance is destroyed, which
+makes it usable together with @ref Trade::ImporterFlag::ZeroCopy, where the
+data returned from an importer reference the file memory directly:
+
+@snippet MagnumTrade.cpp MappedFileCallback
+
+Available only on @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+@ref CORRADE_TARGET_WINDOWS "Windows" platforms.
+*/
+class MAGNUM_EXPORT MappedFileCallback {
+    public:
+        /**
+         * @brief Callback function
+         *
+         * Maps @p filename if not already mapped and returns a view on the
+         * mapped memory. Returns @ref Corrade::Containers::NullOpt if the
+         * file can't be mapped. Does nothing and returns
+         * @ref Corrade::Containers::NullOpt for
+         * @ref InputFileCallbackPolicy::Close. Pass this function together
+         * with the instance to @ref Trade::AbstractImporter::setFileCallback().
+         */
+        static Containers::Optional<Containers::ArrayView<const char>> callback(const std::string& filename, InputFileCallbackPolicy policy, MappedFileCallback& state);
+
+        /** @brief Constructor */
+        explicit MappedFileCallback();
+
+        /** @brief Copying is not allowed */
+        MappedFileCallback(const MappedFileCallback&) = delete;
+
+        /** @brief Move constructor */
+        MappedFileCallback(MappedFileCallback&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps all files. Any data referencing the mapped memory become
+         * dangling.
+         */
+        ~MappedFileCallback();
+
+        /** @brief Copying is not allowed */
+        MappedFileCallback& operator=(const MappedFileCallback&) = delete;
+
+        /** @brief Move assignment */
+        MappedFileCallback& operator=(MappedFileCallback&&) noexcept;
+
+        /** @brief Count of currently mapped files */
+        std::size_t mappedCount() const;
+
+        /** @brief Whether given file is currently mapped */
+        bool isMapped(const std::string& filename) const;
+
+        /**
+         * @brief Unmap all files
+         *
+         * Any data referencing the mapped memory become dangling.
+         */
+        void unmap();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+#endif
+
 }
 
 #endif
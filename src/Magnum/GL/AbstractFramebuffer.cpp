@@ -44,6 +44,7 @@
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/TextureArray.h"
 #endif
+#include "Magnum/GL/Implementation/ContextState.h"
 #include "Magnum/GL/Implementation/FramebufferState.h"
 #include "Magnum/GL/Implementation/RendererState.h"
 #include "Magnum/GL/Implementation/State.h"
@@ -130,11 +131,17 @@ void AbstractFramebuffer::bindInternal(FramebufferTarget target) {
 
 #ifdef MAGNUM_TARGET_GLES2
 void AbstractFramebuffer::bindImplementationSingle(FramebufferTarget) {
-    Implementation::FramebufferState& state = *Context::current().state().framebuffer;
+    Implementation::State& contextState = Context::current().state();
+    Implementation::FramebufferState& state = *contextState.framebuffer;
+    Context::StateStatistics::Counter& statistics = contextState.context->statistics.framebufferBindings;
     CORRADE_INTERNAL_ASSERT(state.readBinding == state.drawBinding);
-    if(state.readBinding == _id) return;
+    if(state.readBinding == _id) {
+        ++statistics.elided;
+        return;
+    }
 
     state.readBinding = state.drawBinding = _id;
+    ++statistics.issued;
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
@@ -146,15 +153,24 @@ void AbstractFramebuffer::bindImplementationSingle(FramebufferTarget) {
 inline
 #endif
 void AbstractFramebuffer::bindImplementationDefault(FramebufferTarget target) {
-    Implementation::FramebufferState& state = *Context::current().state().framebuffer;
+    Implementation::State& contextState = Context::current().state();
+    Implementation::FramebufferState& state = *contextState.framebuffer;
+    Context::StateStatistics::Counter& statistics = contextState.context->statistics.framebufferBindings;
+
+    GLuint* binding;
+    if(target == FramebufferTarget::Read)
+        binding = &state.readBinding;
+    else if(target == FramebufferTarget::Draw)
+        binding = &state.drawBinding;
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    if(*binding == _id) {
+        ++statistics.elided;
+        return;
+    }
 
-    if(target == FramebufferTarget::Read) {
-        if(state.readBinding == _id) return;
-        state.readBinding = _id;
-    } else if(target == FramebufferTarget::Draw) {
-        if(state.drawBinding == _id) return;
-        state.drawBinding = _id;
-    } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    *binding = _id;
+    ++statistics.issued;
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
@@ -173,12 +189,16 @@ FramebufferTarget AbstractFramebuffer::bindInternal() {
 
 #ifdef MAGNUM_TARGET_GLES2
 FramebufferTarget AbstractFramebuffer::bindImplementationSingle() {
-    Implementation::FramebufferState& state = *Context::current().state().framebuffer;
+    Implementation::State& contextState = Context::current().state();
+    Implementation::FramebufferState& state = *contextState.framebuffer;
+    Context::StateStatistics::Counter& statistics = contextState.context->statistics.framebufferBindings;
     CORRADE_INTERNAL_ASSERT(state.readBinding == state.drawBinding);
 
     /* Bind the framebuffer, if not already */
-    if(state.readBinding != _id) {
+    if(state.readBinding == _id) ++statistics.elided;
+    else {
         state.readBinding = state.drawBinding = _id;
+        ++statistics.issued;
 
         /* Binding the framebuffer finally creates it */
         _flags |= ObjectFlag::Created;
@@ -197,16 +217,23 @@ FramebufferTarget AbstractFramebuffer::bindImplementationSingle() {
 inline
 #endif
 FramebufferTarget AbstractFramebuffer::bindImplementationDefault() {
-    Implementation::FramebufferState& state = *Context::current().state().framebuffer;
+    Implementation::State& contextState = Context::current().state();
+    Implementation::FramebufferState& state = *contextState.framebuffer;
+    Context::StateStatistics::Counter& statistics = contextState.context->statistics.framebufferBindings;
 
     /* Return target to which the framebuffer is already bound */
-    if(state.readBinding == _id)
+    if(state.readBinding == _id) {
+        ++statistics.elided;
         return FramebufferTarget::Read;
-    if(state.drawBinding == _id)
+    }
+    if(state.drawBinding == _id) {
+        ++statistics.elided;
         return FramebufferTarget::Draw;
+    }
 
     /* Or bind it, if not already */
     state.readBinding = _id;
+    ++statistics.issued;
 
     /* Binding the framebuffer finally creates it */
     _flags |= ObjectFlag::Created;
@@ -25,7 +25,8 @@
 
 #include "AbstractShaderProgram.h"
 
-#include <Corrade/Containers/Array.h>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -37,6 +38,7 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
+#include "Magnum/GL/Implementation/ContextState.h"
 #ifdef MAGNUM_TARGET_GLES
 #include "Magnum/GL/Implementation/MeshState.h"
 #endif
@@ -292,13 +294,20 @@ Int AbstractShaderProgram::maxTexelOffset() {
 }
 #endif
 
+struct AbstractShaderProgram::UniformCache {
+    /* Offset and size of the cached value in data for each uniform location.
+       Size of zero means the location doesn't have any value cached yet. */
+    Containers::Array<std::pair<std::size_t, std::size_t>> locations;
+    Containers::Array<char> data;
+};
+
 AbstractShaderProgram::AbstractShaderProgram(): _id(glCreateProgram()) {
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
 }
 
 AbstractShaderProgram::AbstractShaderProgram(NoCreateT) noexcept: _id{0} {}
 
-AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id) {
+AbstractShaderProgram::AbstractShaderProgram(AbstractShaderProgram&& other) noexcept: _id(other._id), _uniformCache{std::move(other._uniformCache)} {
     other._id = 0;
 }
 
@@ -315,6 +324,7 @@ AbstractShaderProgram::~AbstractShaderProgram() {
 AbstractShaderProgram& AbstractShaderProgram::operator=(AbstractShaderProgram&& other) noexcept {
     using std::swap;
     swap(_id, other._id);
+    swap(_uniformCache, other._uniformCache);
     return *this;
 }
 
@@ -355,13 +365,46 @@ std::pair<bool, std::string> AbstractShaderProgram::validate() {
     return {success, std::move(message)};
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+std::pair<Containers::Array<char>, GLenum> AbstractShaderProgram::binary() {
+    GLint size{};
+    glGetProgramiv(_id, GL_PROGRAM_BINARY_LENGTH, &size);
+    if(!size) return {};
+
+    Containers::Array<char> data{Containers::NoInit, std::size_t(size)};
+    GLsizei length{};
+    GLenum format{};
+    glGetProgramBinary(_id, size, &length, &format, data);
+
+    /* The driver may in theory write less than what it advertised */
+    if(std::size_t(length) != data.size()) {
+        Containers::Array<char> shrunk{Containers::NoInit, std::size_t(length)};
+        std::memcpy(shrunk, data, length);
+        data = std::move(shrunk);
+    }
+
+    return {std::move(data), format};
+}
+
+bool AbstractShaderProgram::setBinary(const GLenum format, const Containers::ArrayView<const void> data) {
+    glProgramBinary(_id, format, data.data(), data.size());
+
+    /* A rejected binary leaves the program unlinked. That's not an error
+       worth printing, the caller is expected to fall back to compiling the
+       program from source. */
+    GLint success;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    return success;
+}
+#endif
+
 void AbstractShaderProgram::draw(Mesh& mesh) {
     CORRADE_ASSERT(mesh._countSet, "GL::AbstractShaderProgram::draw(): Mesh::setCount() was never called, probably a mistake?", );
 
     /* Nothing to draw, exit without touching any state */
     if(!mesh._count || !mesh._instanceCount) return;
 
-    use();
+    useForDraw();
 
     #ifndef MAGNUM_TARGET_GLES
     mesh.drawInternal(mesh._count, mesh._baseVertex, mesh._instanceCount, mesh._baseInstance, mesh._indexOffset, mesh._indexStart, mesh._indexEnd);
@@ -378,7 +421,7 @@ void AbstractShaderProgram::draw(MeshView& mesh) {
     /* Nothing to draw, exit without touching any state */
     if(!mesh._count || !mesh._instanceCount) return;
 
-    use();
+    useForDraw();
 
     #ifndef MAGNUM_TARGET_GLES
     mesh._original->drawInternal(mesh._count, mesh._baseVertex, mesh._instanceCount, mesh._baseInstance, mesh._indexOffset, mesh._indexStart, mesh._indexEnd);
@@ -392,7 +435,7 @@ void AbstractShaderProgram::draw(MeshView& mesh) {
 void AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>> meshes) {
     if(meshes.empty()) return;
 
-    use();
+    useForDraw();
 
     #ifndef CORRADE_NO_ASSERT
     const Mesh* original = &meshes.begin()->get()._original.get();
@@ -411,12 +454,40 @@ void AbstractShaderProgram::draw(std::initializer_list<Containers::Reference<Mes
     draw(Containers::arrayView(meshes));
 }
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& buffer, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    #ifdef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(drawCount <= 1,
+        "GL::AbstractShaderProgram::drawIndirect(): desktop OpenGL is required for drawing more than one command", );
+    #endif
+
+    /* Nothing to draw, exit without touching any state */
+    if(!drawCount) return;
+
+    useForDraw();
+    mesh.drawIndirectInternal(buffer, offset, drawCount, stride);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void AbstractShaderProgram::drawIndirect(Mesh& mesh, Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    CORRADE_ASSERT(countOffset % 4 == 0,
+        "GL::AbstractShaderProgram::drawIndirect(): count offset" << countOffset << "is not four-byte aligned", );
+
+    /* Nothing to draw, exit without touching any state */
+    if(!maxDrawCount) return;
+
+    useForDraw();
+    mesh.drawIndirectInternal(buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+}
+#endif
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 void AbstractShaderProgram::drawTransformFeedback(Mesh& mesh, TransformFeedback& xfb, UnsignedInt stream) {
     /* Nothing to draw, exit without touching any state */
     if(!mesh._instanceCount) return;
 
-    use();
+    useForDraw();
     mesh.drawInternal(xfb, stream, mesh._instanceCount);
 }
 
@@ -424,22 +495,36 @@ void AbstractShaderProgram::drawTransformFeedback(MeshView& mesh, TransformFeedb
     /* Nothing to draw, exit without touching any state */
     if(!mesh._instanceCount) return;
 
-    use();
+    useForDraw();
     mesh._original->drawInternal(xfb, stream, mesh._instanceCount);
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractShaderProgram::dispatchCompute(const Vector3ui& workgroupCount) {
-    use();
+    useForDraw();
     glDispatchCompute(workgroupCount.x(), workgroupCount.y(), workgroupCount.z());
 }
 #endif
 
 void AbstractShaderProgram::use() {
+    Implementation::State& state = Context::current().state();
+    Context::StateStatistics::Counter& statistics = state.context->statistics.shaderProgramUses;
+
     /* Use only if the program isn't already in use */
-    GLuint& current = Context::current().state().shaderProgram->current;
-    if(current != _id) glUseProgram(current = _id);
+    GLuint& current = state.shaderProgram->current;
+    if(current != _id) {
+        glUseProgram(current = _id);
+        ++statistics.issued;
+    } else ++statistics.elided;
+}
+
+void AbstractShaderProgram::useForDraw() {
+    use();
+
+    /* Issue bindings deferred until now, if any */
+    Implementation::State& state = Context::current().state();
+    if(state.context->deferredBinding) state.flushDeferredBindings();
 }
 
 void AbstractShaderProgram::attachShader(Shader& shader) {
@@ -498,45 +583,63 @@ bool AbstractShaderProgram::link(std::initializer_list<Containers::Reference<Abs
     bool allSuccess = true;
 
     /* Invoke (possibly parallel) linking on all shaders */
-    for(AbstractShaderProgram& shader: shaders) glLinkProgram(shader._id);
+    for(AbstractShaderProgram& shader: shaders) shader.submitLink();
 
-    /* After linking phase, check status of all shaders */
+    /* After linking phase, check status of all shaders. Success of all
+       depends on each of them. */
     Int i = 1;
     for(AbstractShaderProgram& shader: shaders) {
-        GLint success, logLength;
-        glGetProgramiv(shader._id, GL_LINK_STATUS, &success);
-        glGetProgramiv(shader._id, GL_INFO_LOG_LENGTH, &logLength);
-
-        /* Error or warning message. The string is returned null-terminated,
-           scrap the \0 at the end afterwards */
-        std::string message(logLength, '\n');
-        if(message.size() > 1)
-            glGetProgramInfoLog(shader._id, message.size(), nullptr, &message[0]);
-        message.resize(Math::max(logLength, 1)-1);
-
-        /* Show error log */
-        if(!success) {
-            Error out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "failed with the following message:" << Debug::newline << message;
-
-        /* Or just warnings, if any */
-        } else if(!message.empty() && !Implementation::isProgramLinkLogEmpty(message)) {
-            Warning out{Debug::Flag::NoNewlineAtTheEnd};
-            out << "GL::AbstractShaderProgram::link(): linking";
-            if(shaders.size() != 1) out << "of shader" << i;
-            out << "succeeded with the following message:" << Debug::newline << message;
-        }
-
-        /* Success of all depends on each of them */
-        allSuccess = allSuccess && success;
+        allSuccess = shader.checkLinkInternal(shaders.size() != 1 ? i : 0) && allSuccess;
         ++i;
     }
 
     return allSuccess;
 }
 
+void AbstractShaderProgram::submitLink() {
+    /* Linking resets all uniforms to their default values */
+    if(_uniformCache) _uniformCache.emplace();
+    glLinkProgram(_id);
+}
+
+bool AbstractShaderProgram::isLinkFinished() {
+    GLint success;
+    Context::current().state().shaderProgram->completionStatusImplementation(_id, GL_COMPLETION_STATUS_KHR, &success);
+    return success == GL_TRUE;
+}
+
+bool AbstractShaderProgram::checkLink() { return checkLinkInternal(0); }
+
+bool AbstractShaderProgram::checkLinkInternal(const Int id) {
+    GLint success, logLength;
+    glGetProgramiv(_id, GL_LINK_STATUS, &success);
+    glGetProgramiv(_id, GL_INFO_LOG_LENGTH, &logLength);
+
+    /* Error or warning message. The string is returned null-terminated, scrap
+       the \0 at the end afterwards */
+    std::string message(logLength, '\n');
+    if(message.size() > 1)
+        glGetProgramInfoLog(_id, message.size(), nullptr, &message[0]);
+    message.resize(Math::max(logLength, 1)-1);
+
+    /* Show error log */
+    if(!success) {
+        Error out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(id) out << "of shader" << id;
+        out << "failed with the following message:" << Debug::newline << message;
+
+    /* Or just warnings, if any */
+    } else if(!message.empty() && !Implementation::isProgramLinkLogEmpty(message)) {
+        Warning out{Debug::Flag::NoNewlineAtTheEnd};
+        out << "GL::AbstractShaderProgram::link(): linking";
+        if(id) out << "of shader" << id;
+        out << "succeeded with the following message:" << Debug::newline << message;
+    }
+
+    return success;
+}
+
 Int AbstractShaderProgram::uniformLocationInternal(const Containers::ArrayView<const char> name) {
     const GLint location = glGetUniformLocation(_id, name);
     if(location == -1)
@@ -553,8 +656,53 @@ UnsignedInt AbstractShaderProgram::uniformBlockIndexInternal(const Containers::A
 }
 #endif
 
+AbstractShaderProgram& AbstractShaderProgram::setUniformCacheEnabled(const bool enabled) {
+    if(!enabled) _uniformCache = nullptr;
+    else if(!_uniformCache) _uniformCache.emplace();
+    return *this;
+}
+
+bool AbstractShaderProgram::isUniformCached(Implementation::State& state, const Int location, const Containers::ArrayView<const void> data) {
+    Context::StateStatistics::Counter& statistics = state.context->statistics.uniformUploads;
+
+    /* Locations of uniforms that aren't found are -1, OpenGL ignores those
+       so there's nothing to cache */
+    if(!_uniformCache || location < 0) {
+        ++statistics.issued;
+        return false;
+    }
+
+    UniformCache& cache = *_uniformCache;
+    if(std::size_t(location) >= cache.locations.size())
+        arrayAppend(cache.locations, Containers::ValueInit, location - cache.locations.size() + 1);
+
+    /* Same value as last time, skip. Comparing the bytes is fine even for
+       floats, at worst a -0.0f and 0.0f or two different NaNs are considered
+       different and the upload is done. */
+    std::pair<std::size_t, std::size_t>& entry = cache.locations[location];
+    if(entry.second == data.size() && std::memcmp(cache.data + entry.first, data.data(), data.size()) == 0) {
+        ++statistics.elided;
+        return true;
+    }
+
+    /* Different size than last time (or the first upload), allocate a new
+       slot. The old one is abandoned, size changes happen only if the
+       uniform is an array that gets uploaded partially. */
+    if(entry.second != data.size()) {
+        entry.first = cache.data.size();
+        entry.second = data.size();
+        arrayAppend(cache.data, Containers::NoInit, data.size());
+    }
+
+    std::memcpy(cache.data + entry.first, data.data(), data.size());
+    ++statistics.issued;
+    return false;
+}
+
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Float> values) {
-    (this->*Context::current().state().shaderProgram->uniform1fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform1fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLfloat* const values) {
@@ -575,7 +723,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location,  const Containers::ArrayView<const Math::Vector<2, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniform2fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform2fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLfloat>* const values) {
@@ -596,7 +746,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniform3fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform3fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLfloat>* const values) {
@@ -617,7 +769,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniform4fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform4fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLfloat>* const values) {
@@ -638,7 +792,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Int> values) {
-    (this->*Context::current().state().shaderProgram->uniform1ivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform1ivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLint* values) {
@@ -659,7 +815,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, Int>> values) {
-    (this->*Context::current().state().shaderProgram->uniform2ivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform2ivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLint>* const values) {
@@ -680,7 +838,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Int>> values) {
-    (this->*Context::current().state().shaderProgram->uniform3ivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform3ivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLint>* const values) {
@@ -701,7 +861,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Int>> values) {
-    (this->*Context::current().state().shaderProgram->uniform4ivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform4ivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLint>* const values) {
@@ -723,7 +885,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const UnsignedInt> values) {
-    (this->*Context::current().state().shaderProgram->uniform1uivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform1uivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLuint* const values) {
@@ -744,7 +908,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, UnsignedInt>> values) {
-    (this->*Context::current().state().shaderProgram->uniform2uivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform2uivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLuint>* const values) {
@@ -765,7 +931,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, UnsignedInt>> values) {
-    (this->*Context::current().state().shaderProgram->uniform3uivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform3uivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLuint>* const values) {
@@ -786,7 +954,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, UnsignedInt>> values) {
-    (this->*Context::current().state().shaderProgram->uniform4uivImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform4uivImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLuint>* const values) {
@@ -809,7 +979,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 
 #ifndef MAGNUM_TARGET_GLES
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Double> values) {
-    (this->*Context::current().state().shaderProgram->uniform1dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform1dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const GLdouble* const values) {
@@ -822,7 +994,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<2, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniform2dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform2dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<2, GLdouble>* const values) {
@@ -835,7 +1009,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<3, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniform3dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform3dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<3, GLdouble>* const values) {
@@ -848,7 +1024,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::Vector<4, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniform4dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniform4dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::Vector<4, GLdouble>* const values) {
@@ -862,7 +1040,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 2, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 2, GLfloat>* const values) {
@@ -883,7 +1063,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 3, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 3, GLfloat>* const values) {
@@ -904,7 +1086,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 4, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 4, GLfloat>* const values) {
@@ -926,7 +1110,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 
 #ifndef MAGNUM_TARGET_GLES2
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 3, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2x3fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2x3fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 3, GLfloat>* const values) {
@@ -947,7 +1133,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 2, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3x2fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3x2fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 2, GLfloat>* const values) {
@@ -968,7 +1156,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 4, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2x4fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2x4fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 4, GLfloat>* const values) {
@@ -989,7 +1179,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 2, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4x2fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4x2fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 2, GLfloat>* const values) {
@@ -1010,7 +1202,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 4, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3x4fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3x4fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 4, GLfloat>* const values) {
@@ -1031,7 +1225,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 #endif
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 3, Float>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4x3fvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4x3fvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 3, GLfloat>* const values) {
@@ -1054,7 +1250,9 @@ void AbstractShaderProgram::uniformImplementationSSOEXT(const GLint location, co
 
 #ifndef MAGNUM_TARGET_GLES
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 2, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 2, GLdouble>* const values) {
@@ -1067,7 +1265,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 3, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 3, GLdouble>* const values) {
@@ -1080,7 +1280,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 4, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 4, GLdouble>* const values) {
@@ -1093,7 +1295,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 3, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2x3dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2x3dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 3, GLdouble>* const values) {
@@ -1106,7 +1310,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 2, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3x2dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3x2dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 2, GLdouble>* const values) {
@@ -1119,7 +1325,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<2, 4, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix2x4dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix2x4dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<2, 4, GLdouble>* const values) {
@@ -1132,7 +1340,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 2, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4x2dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4x2dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 2, GLdouble>* const values) {
@@ -1145,7 +1355,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<3, 4, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix3x4dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix3x4dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<3, 4, GLdouble>* const values) {
@@ -1158,7 +1370,9 @@ void AbstractShaderProgram::uniformImplementationSSO(const GLint location, const
 }
 
 void AbstractShaderProgram::setUniform(const Int location, const Containers::ArrayView<const Math::RectangularMatrix<4, 3, Double>> values) {
-    (this->*Context::current().state().shaderProgram->uniformMatrix4x3dvImplementation)(location, values.size(), values);
+    Implementation::State& state = Context::current().state();
+    if(isUniformCached(state, location, values)) return;
+    (this->*state.shaderProgram->uniformMatrix4x3dvImplementation)(location, values.size(), values);
 }
 
 void AbstractShaderProgram::uniformImplementationDefault(const GLint location, const GLsizei count, const Math::RectangularMatrix<4, 3, GLdouble>* const values) {
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Tags.h"
 #include "Magnum/GL/AbstractObject.h"
@@ -43,7 +44,10 @@
 
 namespace Magnum { namespace GL {
 
-namespace Implementation { struct ShaderProgramState; }
+namespace Implementation {
+    struct ShaderProgramState;
+    struct State;
+}
 
 /**
 @brief Base for shader program implementations
@@ -421,6 +425,24 @@ use DSA functions to avoid unnecessary calls to @fn_gl{UseProgram}. See
 To achieve least state changes, set all uniforms in one run --- method chaining
 comes in handy.
 
+@subsection GL-AbstractShaderProgram-performance-optimization-uniform-cache Uniform caching
+
+Each @ref setUniform() call results in an OpenGL call, even if the value is
+the same as the one set in the previous draw. On targets where uniform buffers
+aren't available, such as OpenGL ES 2.0 and WebGL 1.0, this can make a
+significant portion of the driver overhead when drawing many objects with
+the same shader. If enabled with @ref setUniformCacheEnabled(), the program
+keeps a copy of all uniform values uploaded through @ref setUniform() and
+skips the upload if the value didn't change:
+
+@snippet MagnumGL.cpp AbstractShaderProgram-uniform-cache
+
+The cache is discarded when the program is linked again and when the caching
+is disabled. If the uniform values are modified by external OpenGL code,
+disable and enable the cache again to make it consistent. Uploads that were
+issued and elided are counted in
+@ref Context::StateStatistics::uniformUploads.
+
 @see @ref portability-shaders
 
 @todo `GL_NUM_{PROGRAM,SHADER}_BINARY_FORMATS` + `GL_{PROGRAM,SHADER}_BINARY_FORMATS` (vector), (@gl_extension{ARB,ES2_compatibility})
@@ -429,7 +451,11 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
     #ifndef MAGNUM_TARGET_GLES2
     friend TransformFeedback;
     #endif
+    friend CommandList;
     friend Implementation::ShaderProgramState;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    friend ProgramBinaryCache;
+    #endif
 
     public:
         #ifndef MAGNUM_TARGET_GLES2
@@ -749,6 +775,66 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         std::pair<bool, std::string> validate();
 
+        /**
+         * @brief Whether uniform caching is enabled
+         * @m_since_latest
+         *
+         * @see @ref setUniformCacheEnabled()
+         */
+        bool isUniformCacheEnabled() const { return !!_uniformCache; }
+
+        /**
+         * @brief Enable or disable uniform caching
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If enabled, values passed to @ref setUniform() are remembered and
+         * calls with values identical to what was set previously for given
+         * location are skipped. Disabling the cache discards all remembered
+         * values. Default is @cpp false @ce. See
+         * @ref GL-AbstractShaderProgram-performance-optimization-uniform-cache
+         * for more information.
+         */
+        AbstractShaderProgram& setUniformCacheEnabled(bool enabled);
+
+        /**
+         * @brief Whether the program linking finished
+         * @m_since_latest
+         *
+         * Can be called only after @ref submitLink(). If
+         * @gl_extension{KHR,parallel_shader_compile} is not available, always
+         * returns @cpp true @ce, which means @ref checkLink() may still block
+         * in that case.
+         * @see @ref Shader::isCompileFinished(),
+         *      @fn_gl_keyword{GetProgram} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isLinkFinished();
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Program binary
+         * @m_since_latest
+         *
+         * Returns the driver-specific binary representation of a linked
+         * program together with its format, which can be later passed to
+         * @ref setBinary() to skip shader compilation and linking. If the
+         * program isn't linked or the driver doesn't provide any binary,
+         * returns an empty array. For best results, the program should have
+         * @ref setRetrievableBinary() enabled before linking. You need to
+         * include @ref Corrade/Containers/Array.h in order to use this
+         * function.
+         * @see @ref ProgramBinaryCache, @fn_gl_keyword{GetProgram} with
+         *      @def_gl{PROGRAM_BINARY_LENGTH}, @fn_gl_keyword{GetProgramBinary}
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Program binaries are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        std::pair<Containers::Array<char>, GLenum> binary();
+        #endif
+
         /**
          * @brief Draw a mesh
          * @param mesh      Mesh to draw
@@ -842,7 +928,11 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          *
          * In OpenGL ES, if @gl_extension{EXT,multi_draw_arrays} is not
          * present, the functionality is emulated using a sequence of
-         * @ref draw(MeshView&) calls.
+         * @ref draw(MeshView&) calls. In WebGL, if
+         * @webgl_extension{WEBGL,multi_draw} is present, all meshes are
+         * submitted with a single call, which is significantly cheaper than
+         * a sequence of draws crossing the JavaScript boundary one by one.
+         * Otherwise the same emulation as on ES is used.
          *
          * If @gl_extension{ARB,vertex_array_object} (part of OpenGL 3.0),
          * OpenGL ES 3.0, WebGL 2.0, @gl_extension{OES,vertex_array_object} in
@@ -850,7 +940,8 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          * 1.0 is available, the associated vertex array object is bound
          * instead of setting up the mesh from scratch.
          * @attention All meshes must be views of the same original mesh and
-         *      must not be instanced.
+         *      except for WebGL with @webgl_extension{WEBGL,multi_draw}
+         *      present must not be instanced.
          * @see @ref draw(MeshView&), @fn_gl{UseProgram},
          *      @fn_gl_keyword{EnableVertexAttribArray}, @fn_gl{BindBuffer},
          *      @fn_gl_keyword{VertexAttribPointer}, @fn_gl_keyword{DisableVertexAttribArray}
@@ -860,7 +951,11 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          *      if the mesh is indexed and @ref MeshView::baseVertex() is not
          *      `0`
          * @requires_gl Specifying base vertex for indexed meshes is not
-         *      available in OpenGL ES or WebGL.
+         *      available in OpenGL ES or WebGL 1.0.
+         * @requires_webgl_extension WebGL 2.0 and extension
+         *      @webgl_extension{WEBGL,multi_draw_instanced_base_vertex_base_instance}
+         *      if the mesh is indexed and @ref MeshView::baseVertex() is not
+         *      `0`
          */
         void draw(Containers::ArrayView<const Containers::Reference<MeshView>> meshes);
 
@@ -870,6 +965,83 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         void draw(std::initializer_list<Containers::Reference<MeshView>> meshes);
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Draw a mesh with parameters sourced from a buffer
+         * @param mesh      Mesh to draw
+         * @param buffer    Buffer containing the draw commands
+         * @param offset    Offset of the first draw command in @p buffer
+         * @param drawCount Draw command count
+         * @param stride    Distance between consecutive draw commands. If
+         *      @cpp 0 @ce, the commands are assumed to be tightly packed.
+         * @m_since_latest
+         *
+         * Expects that @p mesh is compatible with this shader and is fully
+         * set up. The @p buffer is bound to @ref Buffer::TargetHint::DrawIndirect
+         * and is expected to contain @p drawCount draw commands. For a
+         * non-indexed mesh a command is four 32-bit unsigned integers ---
+         * vertex count, instance count, first vertex and base instance; for
+         * an indexed mesh it's five --- index count, instance count, first
+         * index, base vertex and base instance. Everything set by
+         * @ref Mesh::setCount(), @ref Mesh::setInstanceCount(),
+         * @ref Mesh::setBaseInstance(), @ref Mesh::setBaseVertex() as well as
+         * the index offset and range passed to @ref Mesh::setIndexBuffer() is
+         * ignored, the first index in the command is relative to the start of
+         * the index buffer. As the commands can be written by the GPU
+         * directly, for example by a compute shader, the parameters don't
+         * need to be known on the CPU side at all.
+         *
+         * If @gl_extension{ARB,vertex_array_object} (part of OpenGL 3.0) or
+         * OpenGL ES 3.1 is available, the associated vertex array object is
+         * bound instead of setting up the mesh from scratch.
+         * @see @ref draw(Mesh&), @fn_gl{UseProgram}, @fn_gl{BindBuffer},
+         *      @fn_gl_keyword{EnableVertexAttribArray},
+         *      @fn_gl_keyword{VertexAttribPointer},
+         *      @fn_gl_keyword{DisableVertexAttribArray} or
+         *      @fn_gl{BindVertexArray}, @fn_gl_keyword{DrawArraysIndirect}/
+         *      @fn_gl_keyword{MultiDrawArraysIndirect} or
+         *      @fn_gl_keyword{DrawElementsIndirect}/@fn_gl_keyword{MultiDrawElementsIndirect}
+         * @requires_gl40 Extension @gl_extension{ARB,draw_indirect}
+         * @requires_gl43 Extension @gl_extension{ARB,multi_draw_indirect} if
+         *      @p drawCount is not `1`
+         * @requires_gles31 Indirect drawing is not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gl Indirect drawing of more than one command is not
+         *      available in OpenGL ES.
+         * @requires_gles Indirect drawing is not available in WebGL.
+         */
+        void drawIndirect(Mesh& mesh, Buffer& buffer, GLintptr offset, UnsignedInt drawCount = 1, UnsignedInt stride = 0);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Draw a mesh with parameters and draw count sourced from a buffer
+         * @param mesh          Mesh to draw
+         * @param buffer        Buffer containing the draw commands
+         * @param offset        Offset of the first draw command in @p buffer
+         * @param countBuffer   Buffer containing the draw count
+         * @param countOffset   Offset of the draw count in @p countBuffer.
+         *      Expected to be four-byte aligned.
+         * @param maxDrawCount  Max draw command count
+         * @param stride        Distance between consecutive draw commands. If
+         *      @cpp 0 @ce, the commands are assumed to be tightly packed.
+         * @m_since_latest
+         *
+         * Like @ref drawIndirect(Mesh&, Buffer&, GLintptr, UnsignedInt, UnsignedInt),
+         * but the actual draw count is a 32-bit unsigned integer read from
+         * @p countBuffer bound to @ref Buffer::TargetHint::Parameter, clamped
+         * to @p maxDrawCount. Together with commands generated on the GPU, for
+         * example by a culling compute pass, this allows to issue the draws
+         * without reading anything back to the CPU.
+         * @see @fn_gl_keyword{MultiDrawArraysIndirectCount} or
+         *      @fn_gl_keyword{MultiDrawElementsIndirectCount}
+         * @requires_gl46 Extension @gl_extension{ARB,indirect_parameters}
+         * @requires_gl Indirect draw count is not available in OpenGL ES or
+         *      WebGL.
+         */
+        void drawIndirect(Mesh& mesh, Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, UnsignedInt maxDrawCount, UnsignedInt stride = 0);
+        #endif
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         /**
          * @brief Draw a mesh with vertices coming out of transform feedback
@@ -970,6 +1142,29 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         void setRetrievableBinary(bool enabled) {
             glProgramParameteri(_id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, enabled ? GL_TRUE : GL_FALSE);
         }
+
+        /**
+         * @brief Load program binary
+         * @param format    Binary format returned from @ref binary()
+         * @param data      Binary data returned from @ref binary()
+         * @m_since_latest
+         *
+         * Replaces the whole program with given binary, which is equivalent
+         * to attaching and compiling all shaders and calling @ref link(). The
+         * driver is free to reject the binary for example after a driver
+         * update or a hardware change --- in that case the function returns
+         * @cpp false @ce without printing anything and the program has to be
+         * compiled and linked from source as usual. The values of all
+         * uniforms are reset to their defaults after a successful load.
+         * @see @ref ProgramBinaryCache, @fn_gl_keyword{ProgramBinary},
+         *      @fn_gl_keyword{GetProgram} with @def_gl{LINK_STATUS}
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Program binaries are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        bool setBinary(GLenum format, Containers::ArrayView<const void> data);
         #endif
 
         #ifndef MAGNUM_TARGET_WEBGL
@@ -1132,6 +1327,34 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
          */
         bool link();
 
+        /**
+         * @brief Submit the program for linking
+         * @m_since_latest
+         *
+         * Submits the program for linking without waiting for the result.
+         * The attached shaders have to be at least submitted for compilation
+         * using @ref Shader::submitCompile() before. Combined with
+         * @ref isLinkFinished() and @ref checkLink() this allows the
+         * application to do other work while the driver compiles and links
+         * the program in the background, which is especially useful with
+         * @gl_extension{KHR,parallel_shader_compile}.
+         * @see @fn_gl_keyword{LinkProgram}
+         */
+        void submitLink();
+
+        /**
+         * @brief Check the program linking status
+         * @m_since_latest
+         *
+         * Can be called only after @ref submitLink(). Waits for the linking
+         * to finish and returns @cpp false @ce if it failed, @cpp true @ce
+         * otherwise. Linker message (if any) is printed to error output, the
+         * same way as with @ref link().
+         * @see @fn_gl_keyword{GetProgram} with @def_gl{LINK_STATUS} and
+         *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetProgramInfoLog}
+         */
+        bool checkLink();
+
         /**
          * @brief Get uniform location
          * @param name          Uniform name
@@ -1329,6 +1552,9 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         #endif
 
         void bindAttributeLocationInternal(UnsignedInt location, Containers::ArrayView<const char> name);
+
+        /* If id is 0, the shader number isn't printed in the messages */
+        bool MAGNUM_GL_LOCAL checkLinkInternal(Int id);
         #ifndef MAGNUM_TARGET_GLES
         void bindFragmentDataLocationIndexedInternal(UnsignedInt location, UnsignedInt index, Containers::ArrayView<const char> name);
         void bindFragmentDataLocationInternal(UnsignedInt location, Containers::ArrayView<const char> name);
@@ -1343,7 +1569,14 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
         #endif
         #endif
 
+        /* Returns true if the uniform upload can be skipped because the
+           cache contains the same value, otherwise updates the cache.
+           Records the upload in context state statistics. */
+        bool MAGNUM_GL_LOCAL isUniformCached(Implementation::State& state, Int location, Containers::ArrayView<const void> data);
+
         void use();
+        /* Calls use() and issues deferred bindings, if any */
+        void useForDraw();
 
         /*
             Currently, there are three supported ways to call glProgramUniform():
@@ -1480,6 +1713,9 @@ class MAGNUM_GL_EXPORT AbstractShaderProgram: public AbstractObject {
 
         GLuint _id;
 
+        struct UniformCache;
+        Containers::Pointer<UniformCache> _uniformCache;
+
         #if defined(CORRADE_TARGET_WINDOWS) && !defined(MAGNUM_TARGET_GLES2)
         /* Needed for the nv-windows-dangling-transform-feedback-varying-names
            workaround */
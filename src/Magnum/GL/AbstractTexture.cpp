@@ -38,10 +38,12 @@
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/Implementation/ContextState.h"
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
 #include "Magnum/GL/Implementation/RendererState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 #include "Magnum/GL/Implementation/State.h"
 #include "Magnum/GL/Implementation/TextureState.h"
 #include "Magnum/Math/Color.h"
@@ -115,13 +117,27 @@ Int AbstractTexture::maxIntegerSamples() {
 #endif
 
 void AbstractTexture::unbind(const Int textureUnit) {
-    Implementation::TextureState& textureState = *Context::current().state().texture;
+    Implementation::State& state = Context::current().state();
+    Implementation::TextureState& textureState = *state.texture;
+    Context::StateStatistics::Counter& statistics = state.context->statistics.textureBindings;
+
+    /* Unbinding is done immediately, drop a deferred binding to the same
+       unit */
+    AbstractTexture*& deferred = textureState.deferredBindings[textureUnit];
+    if(deferred) {
+        ++statistics.elided;
+        deferred = nullptr;
+    }
 
     /* If given texture unit is already unbound, nothing to do */
-    if(textureState.bindings[textureUnit].second == 0) return;
+    if(textureState.bindings[textureUnit].second == 0) {
+        ++statistics.elided;
+        return;
+    }
 
     /* Unbind the texture, reset state tracker */
-    Context::current().state().texture->unbindImplementation(textureUnit);
+    textureState.unbindImplementation(textureUnit);
+    ++statistics.issued;
     /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous overload of
        operator=) */
     textureState.bindings[textureUnit] = std::pair<GLenum, GLuint>{};
@@ -151,14 +167,34 @@ void AbstractTexture::unbindImplementationDSA(const GLint textureUnit) {
 #endif
 
 void AbstractTexture::unbind(const Int firstTextureUnit, const std::size_t count) {
+    Implementation::State& state = Context::current().state();
+    Implementation::TextureState& textureState = *state.texture;
+
+    /* Unbinding is done immediately, drop deferred bindings to the same
+       units */
+    for(std::size_t i = 0; i != count; ++i) {
+        AbstractTexture*& deferred = textureState.deferredBindings[firstTextureUnit + i];
+        if(deferred) {
+            ++state.context->statistics.textureBindings.elided;
+            deferred = nullptr;
+        }
+    }
+
     /* State tracker is updated in the implementations */
-    Context::current().state().texture->bindMultiImplementation(firstTextureUnit, {nullptr, count});
+    textureState.bindMultiImplementation(firstTextureUnit, {nullptr, count});
 }
 
 /** @todoc const std::initializer_list makes Doxygen grumpy */
 void AbstractTexture::bind(const Int firstTextureUnit, Containers::ArrayView<AbstractTexture* const> textures) {
+    Implementation::State& state = Context::current().state();
+
+    /* If binding is deferred, record each binding separately, they get
+       coalesced again on the next draw */
+    if(state.context->deferredBinding)
+        bindImplementationFallback(firstTextureUnit, textures);
+
     /* State tracker is updated in the implementations */
-    Context::current().state().texture->bindMultiImplementation(firstTextureUnit, {textures.begin(), textures.size()});
+    else state.texture->bindMultiImplementation(firstTextureUnit, {textures.begin(), textures.size()});
 }
 
 void AbstractTexture::bindImplementationFallback(const GLint firstTextureUnit, const Containers::ArrayView<AbstractTexture* const> textures) {
@@ -169,7 +205,9 @@ void AbstractTexture::bindImplementationFallback(const GLint firstTextureUnit, c
 #ifndef MAGNUM_TARGET_GLES
 /** @todoc const Containers::ArrayView makes Doxygen grumpy */
 void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Containers::ArrayView<AbstractTexture* const> textures) {
-    Implementation::TextureState& textureState = *Context::current().state().texture;
+    Implementation::State& state = Context::current().state();
+    Implementation::TextureState& textureState = *state.texture;
+    Context::StateStatistics::Counter& statistics = state.context->statistics.textureBindings;
 
     /* Create array of IDs and also update bindings in state tracker */
     /** @todo VLAs */
@@ -190,7 +228,11 @@ void AbstractTexture::bindImplementationMulti(const GLint firstTextureUnit, Cont
     }
 
     /* Avoid doing the binding if there is nothing different */
-    if(different) glBindTextures(firstTextureUnit, textures.size(), ids);
+    if(different) {
+        glBindTextures(firstTextureUnit, textures.size(), ids);
+        ++statistics.issued;
+        statistics.elided += textures.size() - 1;
+    } else statistics.elided += textures.size();
 }
 #endif
 
@@ -209,11 +251,34 @@ Int AbstractTexture::compressedBlockDataSizeImplementationBitsWorkaround(const G
     /* NVidia (358.16) reports the value in bits instead of bytes */
     return compressedBlockDataSizeImplementationDefault(target, format)/8;
 }
+
+Containers::Array<Vector3i> AbstractTexture::sparsePageSizes(const GLenum target, const TextureFormat format) {
+    GLint count;
+    glGetInternalformativ(target, GLenum(format), GL_NUM_VIRTUAL_PAGE_SIZES_ARB, 1, &count);
+
+    Containers::Array<Vector3i> sizes{Containers::NoInit, std::size_t(count)};
+    if(!count) return sizes;
+
+    /* The queries return all sizes for given direction at once, so it has to
+       go through a temporary */
+    Containers::Array<GLint> values{Containers::NoInit, std::size_t(count)};
+    const GLenum queries[]{GL_VIRTUAL_PAGE_SIZE_X_ARB,
+                           GL_VIRTUAL_PAGE_SIZE_Y_ARB,
+                           GL_VIRTUAL_PAGE_SIZE_Z_ARB};
+    for(std::size_t i = 0; i != 3; ++i) {
+        glGetInternalformativ(target, GLenum(format), queries[i], count, values);
+        for(std::size_t j = 0; j != sizes.size(); ++j)
+            sizes[j][i] = values[j];
+    }
+
+    return sizes;
+}
 #endif
 
 AbstractTexture::AbstractTexture(GLenum target): _target{target}, _flags{ObjectFlag::DeleteOnDestruction} {
     (this->*Context::current().state().texture->createImplementation)();
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
+    Context::current().state().resource->created(Context::ResourceType::Texture, _id);
 }
 
 void AbstractTexture::createImplementationDefault() {
@@ -228,25 +293,43 @@ void AbstractTexture::createImplementationDSA() {
 #endif
 
 AbstractTexture::~AbstractTexture() {
-    /* Moved out or not deleting on destruction, nothing to do */
-    if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
+    /* Moved out, nothing to do */
+    if(!_id) return;
+
+    Implementation::TextureState& textureState = *Context::current().state().texture;
+
+    /* Remove from deferred bindings, which reference the instance and not
+       the ID */
+    for(Int i = textureState.deferredBindingsBegin; i < textureState.deferredBindingsEnd; ++i)
+        if(textureState.deferredBindings[i] == this)
+            textureState.deferredBindings[i] = nullptr;
+
+    /* Not deleting on destruction, nothing else to do */
+    if(!(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
     /* Remove all bindings */
-    for(auto& binding: Context::current().state().texture->bindings) {
+    for(auto& binding: textureState.bindings) {
         /* MSVC 2015 needs the parentheses around */
         /* libstdc++ since GCC 6.3 can't handle just = {} (ambiguous overload
            of operator=) */
         if(binding.second == _id) binding = std::pair<GLenum, GLuint>{};
     }
 
+    #ifndef MAGNUM_TARGET_GLES
+    /* Deleting the texture would release the handle as well, but be nice to
+       drivers that keep residency tracked separately */
+    if(_resident) glMakeTextureHandleNonResidentARB(_handle);
+    #endif
+
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     /* Remove all image bindings */
-    for(auto& binding: Context::current().state().texture->imageBindings) {
+    for(auto& binding: textureState.imageBindings) {
         /* MSVC 2015 needs the parentheses around */
         if(std::get<0>(binding) == _id) binding = {};
     }
     #endif
 
+    Context::current().state().resource->destroyed(Context::ResourceType::Texture, _id);
     glDeleteTextures(1, &_id);
 }
 
@@ -270,10 +353,34 @@ std::string AbstractTexture::label() {
 AbstractTexture& AbstractTexture::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_TEXTURE, _id, label);
+    Context::current().state().resource->label(Context::ResourceType::Texture, _id, label);
     return *this;
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+UnsignedLong AbstractTexture::handle() {
+    if(!_handle) {
+        /* The handle can't be queried for an ID that's only reserved */
+        createIfNotAlready();
+        _handle = glGetTextureHandleARB(_id);
+    }
+    return _handle;
+}
+
+void AbstractTexture::makeResident() {
+    if(_resident) return;
+    glMakeTextureHandleResidentARB(handle());
+    _resident = true;
+}
+
+void AbstractTexture::makeNonResident() {
+    if(!_resident) return;
+    glMakeTextureHandleNonResidentARB(_handle);
+    _resident = false;
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::unbindImage(const Int imageUnit) {
     Implementation::TextureState& textureState = *Context::current().state().texture;
@@ -331,14 +438,37 @@ void AbstractTexture::bindImageInternal(const Int imageUnit, const Int level, co
 #endif
 
 void AbstractTexture::bind(Int textureUnit) {
-    Implementation::TextureState& textureState = *Context::current().state().texture;
+    Implementation::State& state = Context::current().state();
+    Implementation::TextureState& textureState = *state.texture;
+    Context::StateStatistics::Counter& statistics = state.context->statistics.textureBindings;
+
+    /* If binding is deferred, just record it. A binding to the same unit
+       that's not issued yet gets replaced. */
+    if(state.context->deferredBinding) {
+        AbstractTexture*& deferred = textureState.deferredBindings[textureUnit];
+        if(deferred) ++statistics.elided;
+        deferred = this;
+
+        if(textureState.deferredBindingsBegin == textureState.deferredBindingsEnd) {
+            textureState.deferredBindingsBegin = textureUnit;
+            textureState.deferredBindingsEnd = textureUnit + 1;
+        } else {
+            textureState.deferredBindingsBegin = Math::min(textureState.deferredBindingsBegin, textureUnit);
+            textureState.deferredBindingsEnd = Math::max(textureState.deferredBindingsEnd, textureUnit + 1);
+        }
+        return;
+    }
 
     /* If already bound in given texture unit, nothing to do */
-    if(textureState.bindings[textureUnit].second == _id) return;
+    if(textureState.bindings[textureUnit].second == _id) {
+        ++statistics.elided;
+        return;
+    }
 
     /* Update state tracker, bind the texture to the unit */
     textureState.bindings[textureUnit] = {_target, _id};
     (this->*textureState.bindImplementation)(textureUnit);
+    ++statistics.issued;
 }
 
 void AbstractTexture::bindImplementationDefault(GLint textureUnit) {
@@ -505,6 +635,27 @@ void AbstractTexture::generateMipmap() {
     (this->*Context::current().state().texture->mipmapImplementation)();
 }
 
+#ifndef MAGNUM_TARGET_GLES
+void AbstractTexture::setSparse(const Int pageSizeIndex) {
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_TEXTURE_SPARSE_ARB, GL_TRUE);
+    (this->*Context::current().state().texture->parameteriImplementation)(GL_VIRTUAL_PAGE_SIZE_INDEX_ARB, pageSizeIndex);
+}
+
+template<UnsignedInt dimensions> void AbstractTexture::setPageCommitment(const GLint level, const RangeTypeFor<dimensions, Int>& range, const bool commit) {
+    const Vector3i paddedOffset = Vector3i::pad<dimensions>(range.min());
+    const Vector3i paddedSize = Vector3i::pad(Math::Vector<dimensions, Int>(range.size()), 1);
+
+    /* There's only the EXT_direct_state_access variant of this function, so
+       it has to go through a bind always */
+    bindInternal();
+    glTexPageCommitmentARB(_target, level, paddedOffset.x(), paddedOffset.y(), paddedOffset.z(), paddedSize.x(), paddedSize.y(), paddedSize.z(), commit);
+}
+
+template void MAGNUM_GL_EXPORT AbstractTexture::setPageCommitment<1>(GLint, const Range1Di&, bool);
+template void MAGNUM_GL_EXPORT AbstractTexture::setPageCommitment<2>(GLint, const Range2Di&, bool);
+template void MAGNUM_GL_EXPORT AbstractTexture::setPageCommitment<3>(GLint, const Range3Di&, bool);
+#endif
+
 void AbstractTexture::mipmapImplementationDefault() {
     bindInternal();
     glGenerateMipmap(_target);
@@ -521,11 +672,15 @@ void AbstractTexture::bindInternal() {
        functions need to have the texture bound in *currently active* unit,
        so we would need to call glActiveTexture() afterwards anyway. */
 
-    Implementation::TextureState& textureState = *Context::current().state().texture;
+    Implementation::State& state = Context::current().state();
+    Implementation::TextureState& textureState = *state.texture;
+    Context::StateStatistics::Counter& statistics = state.context->statistics.textureBindings;
 
     /* If the texture is already bound in current unit, nothing to do */
-    if(textureState.bindings[textureState.currentTextureUnit].second == _id)
+    if(textureState.bindings[textureState.currentTextureUnit].second == _id) {
+        ++statistics.elided;
         return;
+    }
 
     /* Set internal unit as active if not already, update state tracker */
     CORRADE_INTERNAL_ASSERT(textureState.maxTextureUnits > 1);
@@ -534,7 +689,10 @@ void AbstractTexture::bindInternal() {
         glActiveTexture(GL_TEXTURE0 + (textureState.currentTextureUnit = internalTextureUnit));
 
     /* If already bound in given texture unit, nothing to do */
-    if(textureState.bindings[internalTextureUnit].second == _id) return;
+    if(textureState.bindings[internalTextureUnit].second == _id) {
+        ++statistics.elided;
+        return;
+    }
 
     /* Update state tracker, bind the texture to the unit. Not directly calling
        glBindTexture() here because we may need to include various
@@ -544,6 +702,7 @@ void AbstractTexture::bindInternal() {
        (which is then asserted in createIfNotAlready()) */
     textureState.bindings[internalTextureUnit] = {_target, _id};
     (this->*textureState.bindInternalImplementation)(internalTextureUnit);
+    ++statistics.issued;
 }
 
 #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
@@ -2128,26 +2287,53 @@ Vector3i AbstractTexture::DataHelper<3>::imageSize(AbstractTexture& texture, con
 #ifndef MAGNUM_TARGET_GLES
 void AbstractTexture::DataHelper<1>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Math::Vector< 1, GLsizei >& size) {
     (texture.*Context::current().state().texture->storage1DImplementation)(levels, internalFormat, size);
+    Context::current().state().resource->storage(Context::ResourceType::Texture, texture._id, Implementation::textureStorageMemory(levels, internalFormat, {size[0], 1, 1}, false));
 }
 #endif
 
 void AbstractTexture::DataHelper<2>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector2i& size) {
     (texture.*Context::current().state().texture->storage2DImplementation)(levels, internalFormat, size);
+
+    /* Cube map faces and 1D array layers don't get smaller with each level */
+    Vector3i storageSize{size, 1};
+    bool layered = false;
+    if(texture._target == GL_TEXTURE_CUBE_MAP) {
+        storageSize.z() = 6;
+        layered = true;
+    }
+    #ifndef MAGNUM_TARGET_GLES
+    else if(texture._target == GL_TEXTURE_1D_ARRAY) {
+        storageSize = {size.x(), 1, size.y()};
+        layered = true;
+    }
+    #endif
+    Context::current().state().resource->storage(Context::ResourceType::Texture, texture._id, Implementation::textureStorageMemory(levels, internalFormat, storageSize, layered));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void AbstractTexture::DataHelper<3>::setStorage(AbstractTexture& texture, const GLsizei levels, const TextureFormat internalFormat, const Vector3i& size) {
     (texture.*Context::current().state().texture->storage3DImplementation)(levels, internalFormat, size);
+
+    /* Only 3D textures get smaller in all dimensions with each level, the
+       rest are 2D arrays and cube map arrays */
+    #ifndef MAGNUM_TARGET_GLES2
+    const bool layered = texture._target != GL_TEXTURE_3D;
+    #else
+    const bool layered = texture._target != GL_TEXTURE_3D_OES;
+    #endif
+    Context::current().state().resource->storage(Context::ResourceType::Texture, texture._id, Implementation::textureStorageMemory(levels, internalFormat, size, layered));
 }
 #endif
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 void AbstractTexture::DataHelper<2>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector2i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage2DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Context::current().state().resource->storage(Context::ResourceType::Texture, texture._id, samples*Implementation::textureImageMemory(internalFormat, {size, 1}));
 }
 
 void AbstractTexture::DataHelper<3>::setStorageMultisample(AbstractTexture& texture, const GLsizei samples, const TextureFormat internalFormat, const Vector3i& size, const GLboolean fixedSampleLocations) {
     (texture.*Context::current().state().texture->storage3DMultisampleImplementation)(samples, internalFormat, size, fixedSampleLocations);
+    Context::current().state().resource->storage(Context::ResourceType::Texture, texture._id, samples*Implementation::textureImageMemory(internalFormat, size));
 }
 #endif
 
@@ -2157,6 +2343,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(pixelFormat(image.format())), GLenum(pixelType(image.format(), image.formatExtra())), image.data());
+    Context::current().state().resource->image(texture._id, texture._target, level, Implementation::textureImageMemory(internalFormat, {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView1D& image) {
@@ -2164,6 +2351,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    Context::current().state().resource->image(texture._id, texture._target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 
 void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GLint level, const TextureFormat internalFormat, BufferImage1D& image) {
@@ -2171,6 +2359,7 @@ void AbstractTexture::DataHelper<1>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage1D(texture._target, level, GLint(internalFormat), image.size()[0], 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Context::current().state().resource->image(texture._id, texture._target, level, Implementation::textureImageMemory(internalFormat, {image.size()[0], 1, 1}));
 }
 
 void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage1D& image) {
@@ -2178,6 +2367,7 @@ void AbstractTexture::DataHelper<1>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage1D(texture._target, level, GLenum(image.format()), image.size()[0], 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Context::current().state().resource->image(texture._id, texture._target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 
 void AbstractTexture::DataHelper<1>::setSubImage(AbstractTexture& texture, const GLint level, const Math::Vector<1, GLint>& offset, const ImageView1D& image) {
@@ -2215,6 +2405,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
         + Magnum::Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    Context::current().state().resource->image(texture._id, target, level, Implementation::textureImageMemory(internalFormat, {image.size(), 1}));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, const CompressedImageView2D& image) {
@@ -2224,6 +2415,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(compressedPixelFormat(image.format())), image.size().x(), image.size().y(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
+    Context::current().state().resource->image(texture._id, target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -2232,6 +2424,7 @@ void AbstractTexture::DataHelper<2>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage2D(target, level, GLint(internalFormat), image.size().x(), image.size().y(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Context::current().state().resource->image(texture._id, target, level, Implementation::textureImageMemory(internalFormat, {image.size(), 1}));
 }
 
 void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture, const GLenum target, const GLint level, CompressedBufferImage2D& image) {
@@ -2239,6 +2432,7 @@ void AbstractTexture::DataHelper<2>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage2D(target, level, GLenum(image.format()), image.size().x(), image.size().y(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Context::current().state().resource->image(texture._id, target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 #endif
 
@@ -2287,6 +2481,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
         + Magnum::Implementation::pixelStorageSkipOffset(image)
         #endif
         , image.storage());
+    Context::current().state().resource->image(texture._id, texture._target, level, Implementation::textureImageMemory(internalFormat, image.size()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, const CompressedImageView3D& image) {
@@ -2300,6 +2495,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     #else
     glCompressedTexImage3DOES(texture._target, level, GLenum(compressedPixelFormat(image.format())), image.size().x(), image.size().y(), image.size().z(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()), image.data());
     #endif
+    Context::current().state().resource->image(texture._id, texture._target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.data().size()));
 }
 #endif
 
@@ -2309,6 +2505,7 @@ void AbstractTexture::DataHelper<3>::setImage(AbstractTexture& texture, const GL
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glTexImage3D(texture._target, level, GLint(internalFormat), image.size().x(), image.size().y(), image.size().z(), 0, GLenum(image.format()), GLenum(image.type()), nullptr);
+    Context::current().state().resource->image(texture._id, texture._target, level, Implementation::textureImageMemory(internalFormat, image.size()));
 }
 
 void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture, const GLint level, CompressedBufferImage3D& image) {
@@ -2316,6 +2513,7 @@ void AbstractTexture::DataHelper<3>::setCompressedImage(AbstractTexture& texture
     Context::current().state().renderer->applyPixelStorageUnpack(image.storage());
     texture.bindInternal();
     glCompressedTexImage3D(texture._target, level, GLenum(image.format()), image.size().x(), image.size().y(), image.size().z(), 0, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()), nullptr);
+    Context::current().state().resource->image(texture._id, texture._target, level, Magnum::Implementation::occupiedCompressedImageDataSize(image, image.dataSize()));
 }
 #endif
 
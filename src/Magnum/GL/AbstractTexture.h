@@ -66,6 +66,16 @@ information and usage examples.
 submitted to @ref Texture::setSubImage() "*Texture::setSubImage()", see its
 documentation for details.
 
+@section GL-AbstractTexture-bindless Bindless textures
+
+On desktop GL with @gl_extension{ARB,bindless_texture}, a texture can be
+referenced from a shader directly by a 64-bit @ref handle() instead of being
+bound to a texture unit. The handle has to be made resident with
+@ref makeResident() before a shader accesses it, which for scenes with many
+textures is best managed by @ref TextureResidency. Since the handles are
+supplied in buffers, many draws with distinct textures can be issued without
+any texture binding in between.
+
 @section GL-AbstractTexture-performance-optimization Performance optimizations and security
 
 The engine tracks currently bound textures and images in all available texture
@@ -409,6 +419,73 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
          */
         void bind(Int textureUnit);
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Bindless texture handle
+         * @m_since_latest
+         *
+         * The handle is queried on first call and cached, it stays valid for
+         * the whole lifetime of the texture. Expects that the texture is
+         * complete, i.e. has its storage and all used mip levels set up. Once
+         * the handle is created, the texture storage and sampler state become
+         * immutable and any subsequent attempt to change them is an error.
+         *
+         * The handle can be used by a shader only if it's resident, see
+         * @ref makeResident() and @ref TextureResidency. Handles are usually
+         * passed to shaders in uniform or storage buffers, on the GLSL side a
+         * handle is a @glsl uvec2 @ce that gets converted to a sampler with a
+         * constructor, such as @glsl sampler2D(handle) @ce.
+         * @see @fn_gl_extension_keyword{GetTextureHandle,ARB,bindless_texture}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        UnsignedLong handle();
+
+        /**
+         * @brief Whether the bindless texture handle is resident
+         * @m_since_latest
+         *
+         * Returns the state set by @ref makeResident() and
+         * @ref makeNonResident(), doesn't query the driver. Initially
+         * @cpp false @ce.
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        bool isResident() const { return _resident; }
+
+        /**
+         * @brief Make the bindless texture handle resident
+         * @m_since_latest
+         *
+         * Queries @ref handle() if not already and makes it accessible to
+         * shaders. If the handle is already resident, the function does
+         * nothing. A resident handle is made non-resident again on
+         * destruction of a texture that owns the underlying OpenGL object.
+         * @see @ref makeNonResident(), @ref TextureResidency,
+         *      @fn_gl_extension_keyword{MakeTextureHandleResident,ARB,bindless_texture}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        void makeResident();
+
+        /**
+         * @brief Make the bindless texture handle non-resident
+         * @m_since_latest
+         *
+         * Residency is a limited resource, so textures that aren't going to
+         * be used by shaders for some time should be made non-resident. If
+         * the handle isn't resident, the function does nothing.
+         * @see @ref makeResident(), @ref TextureResidency,
+         *      @fn_gl_extension_keyword{MakeTextureHandleNonResident,ARB,bindless_texture}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        void makeNonResident();
+        #endif
+
     #if !defined(MAGNUM_BUILD_DEPRECATED) || defined(DOXYGEN_GENERATING_OUTPUT)
     protected: /* Destructor was public before */
     #endif
@@ -437,6 +514,7 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
 
         #ifndef MAGNUM_TARGET_GLES
         static Int compressedBlockDataSize(GLenum target, TextureFormat format);
+        static Containers::Array<Vector3i> sparsePageSizes(GLenum target, TextureFormat format);
         #endif
 
         explicit AbstractTexture(GLenum target);
@@ -503,6 +581,11 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
         void invalidateImage(Int level);
         void generateMipmap();
 
+        #ifndef MAGNUM_TARGET_GLES
+        void setSparse(Int pageSizeIndex);
+        template<UnsignedInt dimensions> void setPageCommitment(GLint level, const RangeTypeFor<dimensions, Int>& range, bool commit);
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         template<UnsignedInt dimensions> void image(GLint level, const BasicMutableImageView<dimensions>& image);
         template<UnsignedInt dimensions> void image(GLint level, Image<dimensions>& image);
@@ -715,6 +798,10 @@ class MAGNUM_GL_EXPORT AbstractTexture: public AbstractObject {
 
         GLuint _id;
         ObjectFlags _flags;
+        #ifndef MAGNUM_TARGET_GLES
+        UnsignedLong _handle{};
+        bool _resident{};
+        #endif
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -820,8 +907,16 @@ template<> struct MAGNUM_GL_EXPORT AbstractTexture::DataHelper<3> {
 };
 #endif
 
-inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags} {
+inline AbstractTexture::AbstractTexture(AbstractTexture&& other) noexcept: _target{other._target}, _id{other._id}, _flags{other._flags}
+    #ifndef MAGNUM_TARGET_GLES
+    , _handle{other._handle}, _resident{other._resident}
+    #endif
+{
     other._id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    other._handle = 0;
+    other._resident = false;
+    #endif
 }
 
 inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noexcept {
@@ -829,12 +924,20 @@ inline AbstractTexture& AbstractTexture::operator=(AbstractTexture&& other) noex
     swap(_target, other._target);
     swap(_id, other._id);
     swap(_flags, other._flags);
+    #ifndef MAGNUM_TARGET_GLES
+    swap(_handle, other._handle);
+    swap(_resident, other._resident);
+    #endif
     return *this;
 }
 
 inline GLuint AbstractTexture::release() {
     const GLuint id = _id;
     _id = 0;
+    #ifndef MAGNUM_TARGET_GLES
+    _handle = 0;
+    _resident = false;
+    #endif
     return id;
 }
 
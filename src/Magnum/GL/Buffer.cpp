@@ -33,14 +33,17 @@
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Implementation/State.h"
 #include "Magnum/GL/Implementation/BufferState.h"
+#include "Magnum/GL/Implementation/ContextState.h"
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
 #include "Magnum/GL/Implementation/MeshState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 
 #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
 #include "Magnum/GL/Implementation/TextureState.h"
 #endif
+#include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace GL {
 
@@ -139,22 +142,89 @@ Int Buffer::maxUniformBindings() {
     return value;
 }
 
+namespace {
+
+/* Records a uniform buffer binding to be issued right before the next draw.
+   Returns false if the binding should be done directly. */
+bool deferUniformBinding(Implementation::State& state, Buffer* const buffer, const UnsignedInt index, const GLintptr offset, const GLsizeiptr size) {
+    Implementation::BufferState& bufferState = *state.buffer;
+
+    if(bufferState.deferredUniformBindings.isEmpty())
+        bufferState.deferredUniformBindings = Containers::Array<std::tuple<Buffer*, GLintptr, GLsizeiptr>>{Containers::ValueInit, std::size_t(Buffer::maxUniformBindings())};
+
+    /* Let GL generate an error for an out-of-range index */
+    if(index >= bufferState.deferredUniformBindings.size()) return false;
+
+    /* A binding to the same point that's not issued yet gets replaced */
+    std::tuple<Buffer*, GLintptr, GLsizeiptr>& deferred = bufferState.deferredUniformBindings[index];
+    if(std::get<0>(deferred)) ++state.context->statistics.uniformBufferBindings.elided;
+    deferred = std::make_tuple(buffer, offset, size);
+
+    if(bufferState.deferredUniformBindingsBegin == bufferState.deferredUniformBindingsEnd) {
+        bufferState.deferredUniformBindingsBegin = index;
+        bufferState.deferredUniformBindingsEnd = index + 1;
+    } else {
+        bufferState.deferredUniformBindingsBegin = Math::min(bufferState.deferredUniformBindingsBegin, index);
+        bufferState.deferredUniformBindingsEnd = Math::max(bufferState.deferredUniformBindingsEnd, index + 1);
+    }
+    return true;
+}
+
+/* Unbinding is done immediately, drops deferred uniform buffer bindings to
+   the same points */
+void dropDeferredUniformBindings(Implementation::State& state, const UnsignedInt firstIndex, const std::size_t count) {
+    Implementation::BufferState& bufferState = *state.buffer;
+    for(std::size_t i = firstIndex; i < firstIndex + count && i < bufferState.deferredUniformBindings.size(); ++i) {
+        std::tuple<Buffer*, GLintptr, GLsizeiptr>& deferred = bufferState.deferredUniformBindings[i];
+        if(!std::get<0>(deferred)) continue;
+
+        ++state.context->statistics.uniformBufferBindings.elided;
+        deferred = std::tuple<Buffer*, GLintptr, GLsizeiptr>{};
+    }
+}
+
+}
+
 void Buffer::unbind(const Target target, const UnsignedInt index) {
+    if(target == Target::Uniform) {
+        Implementation::State& state = Context::current().state();
+        dropDeferredUniformBindings(state, index, 1);
+        ++state.context->statistics.uniformBufferBindings.issued;
+    }
+
     glBindBufferBase(GLenum(target), index, 0);
 }
 
 void Buffer::unbind(const Target target, const UnsignedInt firstIndex, const std::size_t count) {
-    Context::current().state().buffer->bindBasesImplementation(target, firstIndex, {nullptr, count});
+    Implementation::State& state = Context::current().state();
+    if(target == Target::Uniform)
+        dropDeferredUniformBindings(state, firstIndex, count);
+
+    state.buffer->bindBasesImplementation(target, firstIndex, {nullptr, count});
 }
 
 /** @todoc const std::initializer_list makes Doxygen grumpy */
 void Buffer::bind(const Target target, const UnsignedInt firstIndex, std::initializer_list<std::tuple<Buffer*, GLintptr, GLsizeiptr>> buffers) {
-    Context::current().state().buffer->bindRangesImplementation(target, firstIndex, {buffers.begin(), buffers.size()});
+    Implementation::State& state = Context::current().state();
+
+    /* If binding is deferred, record each binding separately, they get
+       coalesced again on the next draw */
+    if(target == Target::Uniform && state.context->deferredBinding)
+        bindImplementationFallback(target, firstIndex, {buffers.begin(), buffers.size()});
+    else
+        state.buffer->bindRangesImplementation(target, firstIndex, {buffers.begin(), buffers.size()});
 }
 
 /** @todoc const std::initializer_list makes Doxygen grumpy */
 void Buffer::bind(const Target target, const UnsignedInt firstIndex, std::initializer_list<Buffer*> buffers) {
-    Context::current().state().buffer->bindBasesImplementation(target, firstIndex, {buffers.begin(), buffers.size()});
+    Implementation::State& state = Context::current().state();
+
+    /* If binding is deferred, record each binding separately, they get
+       coalesced again on the next draw */
+    if(target == Target::Uniform && state.context->deferredBinding)
+        bindImplementationFallback(target, firstIndex, {buffers.begin(), buffers.size()});
+    else
+        state.buffer->bindBasesImplementation(target, firstIndex, {buffers.begin(), buffers.size()});
 }
 
 void Buffer::copy(Buffer& read, Buffer& write, const GLintptr readOffset, const GLintptr writeOffset, const GLsizeiptr size) {
@@ -167,6 +237,7 @@ Buffer::Buffer(const TargetHint targetHint): _flags{ObjectFlag::DeleteOnDestruct
     (this->*state.createImplementation)();
     (this->*state.setTargetHintImplementation)(targetHint);
     CORRADE_INTERNAL_ASSERT(_id != Implementation::State::DisengagedBinding);
+    Context::current().state().resource->created(Context::ResourceType::Buffer, _id);
 }
 
 Buffer::Buffer(GLuint id, TargetHint targetHint, ObjectFlags flags) noexcept: _id{id}, _flags{flags} {
@@ -185,15 +256,37 @@ void Buffer::createImplementationDSA() {
 #endif
 
 Buffer::~Buffer() {
-    /* Moved out or not deleting on destruction, nothing to do */
-    if(!_id || !(_flags & ObjectFlag::DeleteOnDestruction)) return;
+    /* Moved out, nothing to do */
+    if(!_id) return;
+
+    Implementation::BufferState& state = *Context::current().state().buffer;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Remove from deferred uniform bindings, which reference the instance and
+       not the ID */
+    for(UnsignedInt i = state.deferredUniformBindingsBegin; i < state.deferredUniformBindingsEnd; ++i)
+        if(std::get<0>(state.deferredUniformBindings[i]) == this)
+            state.deferredUniformBindings[i] = std::tuple<Buffer*, GLintptr, GLsizeiptr>{};
+    #endif
+
+    /* Not deleting on destruction, nothing else to do */
+    if(!(_flags & ObjectFlag::DeleteOnDestruction)) return;
 
-    GLuint* bindings = Context::current().state().buffer->bindings;
+    GLuint* bindings = state.bindings;
 
     /* Remove all current bindings from the state */
     for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
         if(bindings[i] == _id) bindings[i] = 0;
 
+    /* Deleting the buffer resets also vertex attribute bindings to it, so
+       reflect that in the attribute state of the non-VAO code path. Otherwise
+       a new buffer with the same ID could be treated as already bound. */
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    for(Implementation::MeshState::VertexAttribute& attribute: Context::current().state().mesh->vertexAttributes)
+        if(attribute.buffer == _id) attribute.buffer = 0;
+    #endif
+
+    Context::current().state().resource->destroyed(Context::ResourceType::Buffer, _id);
     glDeleteBuffers(1, &_id);
 }
 
@@ -243,34 +336,48 @@ Buffer& Buffer::setLabelInternal(const Containers::ArrayView<const char> label)
     #else
     Context::current().state().debug->labelImplementation(GL_BUFFER_KHR, _id, label);
     #endif
+    Context::current().state().resource->label(Context::ResourceType::Buffer, _id, label);
     return *this;
 }
 #endif
 
 void Buffer::bindInternal(const TargetHint target, Buffer* const buffer) {
+    Implementation::State& state = Context::current().state();
+    Context::StateStatistics::Counter& statistics = state.context->statistics.bufferBindings;
     const GLuint id = buffer ? buffer->_id : 0;
-    GLuint& bound = Context::current().state().buffer->bindings[Implementation::BufferState::indexForTarget(target)];
+    GLuint& bound = state.buffer->bindings[Implementation::BufferState::indexForTarget(target)];
 
     /* Already bound, nothing to do */
-    if(bound == id) return;
+    if(bound == id) {
+        ++statistics.elided;
+        return;
+    }
 
     /* Bind the buffer otherwise, which will also finally create it */
     bound = id;
     if(buffer) buffer->_flags |= ObjectFlag::Created;
     glBindBuffer(GLenum(target), id);
+    ++statistics.issued;
 }
 
 auto Buffer::bindSomewhereInternal(const TargetHint hint) -> TargetHint {
-    GLuint* bindings = Context::current().state().buffer->bindings;
+    Implementation::State& state = Context::current().state();
+    Context::StateStatistics::Counter& statistics = state.context->statistics.bufferBindings;
+    GLuint* bindings = state.buffer->bindings;
     GLuint& hintBinding = bindings[Implementation::BufferState::indexForTarget(hint)];
 
     /* Shortcut - if already bound to hint, return */
-    if(hintBinding == _id) return hint;
+    if(hintBinding == _id) {
+        ++statistics.elided;
+        return hint;
+    }
 
     /* Return first target in which the buffer is bound */
     /** @todo wtf there is one more? */
-    for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i)
-        if(bindings[i] == _id) return Implementation::BufferState::targetForIndex[i-1];
+    for(std::size_t i = 1; i != Implementation::BufferState::TargetCount; ++i) if(bindings[i] == _id) {
+        ++statistics.elided;
+        return Implementation::BufferState::targetForIndex[i-1];
+    }
 
     /* Sorry, this is ugly because GL is also ugly. Blame GL, not me.
 
@@ -290,16 +397,31 @@ auto Buffer::bindSomewhereInternal(const TargetHint hint) -> TargetHint {
     hintBinding = _id;
     _flags |= ObjectFlag::Created;
     glBindBuffer(GLenum(hint), _id);
+    ++statistics.issued;
     return hint;
 }
 
 #ifndef MAGNUM_TARGET_GLES2
 Buffer& Buffer::bind(const Target target, const UnsignedInt index, const GLintptr offset, const GLsizeiptr size) {
+    if(target == Target::Uniform) {
+        Implementation::State& state = Context::current().state();
+        if(state.context->deferredBinding && size && deferUniformBinding(state, this, index, offset, size))
+            return *this;
+        ++state.context->statistics.uniformBufferBindings.issued;
+    }
+
     glBindBufferRange(GLenum(target), index, _id, offset, size);
     return *this;
 }
 
 Buffer& Buffer::bind(const Target target, const UnsignedInt index) {
+    if(target == Target::Uniform) {
+        Implementation::State& state = Context::current().state();
+        if(state.context->deferredBinding && deferUniformBinding(state, this, index, 0, 0))
+            return *this;
+        ++state.context->statistics.uniformBufferBindings.issued;
+    }
+
     glBindBufferBase(GLenum(target), index, _id);
     return *this;
 }
@@ -308,6 +430,7 @@ Buffer& Buffer::bind(const Target target, const UnsignedInt index) {
 #ifndef MAGNUM_TARGET_GLES
 Buffer& Buffer::setStorage(const Containers::ArrayView<const void> data, const StorageFlags flags) {
     (this->*Context::current().state().buffer->storageImplementation)(data, flags);
+    Context::current().state().resource->storage(Context::ResourceType::Buffer, _id, data.size());
     return *this;
 }
 #endif
@@ -330,6 +453,7 @@ Containers::Array<char> Buffer::data() {
 
 Buffer& Buffer::setData(const Containers::ArrayView<const void> data, const BufferUsage usage) {
     (this->*Context::current().state().buffer->dataImplementation)(data.size(), data, usage);
+    Context::current().state().resource->storage(Context::ResourceType::Buffer, _id, data.size());
     return *this;
 }
 
@@ -395,6 +519,12 @@ void Buffer::bindImplementationMulti(const Target target, const GLuint firstInde
     }
 
     glBindBuffersBase(GLenum(target), firstIndex, buffers.size(), ids);
+
+    if(target == Target::Uniform) {
+        Context::StateStatistics::Counter& statistics = Context::current().state().context->statistics.uniformBufferBindings;
+        ++statistics.issued;
+        statistics.elided += buffers.size() - 1;
+    }
 }
 #endif
 
@@ -427,6 +557,12 @@ void Buffer::bindImplementationMulti(const Target target, const GLuint firstInde
     }
 
     glBindBuffersRange(GLenum(target), firstIndex, buffers.size(), ids, offsetsSizes, offsetsSizes + buffers.size());
+
+    if(target == Target::Uniform) {
+        Context::StateStatistics::Counter& statistics = Context::current().state().context->statistics.uniformBufferBindings;
+        ++statistics.issued;
+        statistics.elided += buffers.size() - 1;
+    }
 }
 #endif
 
@@ -644,6 +780,9 @@ Debug& operator<<(Debug& debug, const Buffer::TargetHint value) {
         #endif
         #endif
         _c(ElementArray)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(Parameter)
+        #endif
         #ifndef MAGNUM_TARGET_GLES2
         _c(PixelPack)
         _c(PixelUnpack)
@@ -283,6 +283,18 @@ class MAGNUM_GL_EXPORT Buffer: public AbstractObject {
             /** Used for storing vertex indices. */
             ElementArray = GL_ELEMENT_ARRAY_BUFFER,
 
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Used for supplying draw count for indirect drawing.
+             * @m_since_latest
+             * @see @ref AbstractShaderProgram::drawIndirect(Mesh&, Buffer&, GLintptr, Buffer&, GLintptr, UnsignedInt, UnsignedInt)
+             * @requires_gl46 Extension @gl_extension{ARB,indirect_parameters}
+             * @requires_gl Indirect draw count is not available in OpenGL ES
+             *      or WebGL.
+             */
+            Parameter = GL_PARAMETER_BUFFER,
+            #endif
+
             #ifndef MAGNUM_TARGET_GLES2
             /**
              * Target for pixel pack operations.
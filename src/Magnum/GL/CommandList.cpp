@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CommandList.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/GL/AbstractTexture.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+
+namespace Magnum { namespace GL {
+
+struct CommandList::State {
+    struct Command {
+        /* Function performing the command, resolved at record time */
+        void(*execute)(const Command&, const char* data);
+        /* Used only by uniform commands */
+        UniformFunction uniform;
+        void* first;
+        void* second;
+        /* Uniform location, texture unit or buffer binding index */
+        Int index;
+        std::size_t dataOffset, count;
+    };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    struct BufferRange {
+        Buffer::Target target;
+        GLintptr offset;
+        GLsizeiptr size;
+    };
+    #endif
+
+    static void executeUniform(const Command& command, const char* data);
+    static void executeBindTextures(const Command& command, const char* data);
+    #ifndef MAGNUM_TARGET_GLES2
+    static void executeBindBufferRange(const Command& command, const char* data);
+    static void executeBindBuffer(const Command& command, const char* data);
+    #endif
+    static void executeDraw(const Command& command, const char* data);
+    static void executeDrawView(const Command& command, const char* data);
+
+    /* Appends data aligned to 8 bytes, which is enough for double uniforms
+       and pointers, returns offset of the first byte */
+    std::size_t appendData(const void* data, std::size_t size);
+
+    Containers::Array<Command> commands;
+    Containers::Array<char> data;
+};
+
+void CommandList::State::executeUniform(const Command& command, const char* const data) {
+    command.uniform(*static_cast<AbstractShaderProgram*>(command.first), command.index, data + command.dataOffset, command.count);
+}
+
+void CommandList::State::executeBindTextures(const Command& command, const char* const data) {
+    AbstractTexture::bind(command.index, {reinterpret_cast<AbstractTexture* const*>(data + command.dataOffset), command.count});
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void CommandList::State::executeBindBufferRange(const Command& command, const char* const data) {
+    const BufferRange& range = *reinterpret_cast<const BufferRange*>(data + command.dataOffset);
+    static_cast<Buffer*>(command.first)->bind(range.target, command.index, range.offset, range.size);
+}
+
+void CommandList::State::executeBindBuffer(const Command& command, const char* const data) {
+    const BufferRange& range = *reinterpret_cast<const BufferRange*>(data + command.dataOffset);
+    static_cast<Buffer*>(command.first)->bind(range.target, command.index);
+}
+#endif
+
+void CommandList::State::executeDraw(const Command& command, const char*) {
+    static_cast<AbstractShaderProgram*>(command.first)->draw(*static_cast<Mesh*>(command.second));
+}
+
+void CommandList::State::executeDrawView(const Command& command, const char*) {
+    static_cast<AbstractShaderProgram*>(command.first)->draw(*static_cast<MeshView*>(command.second));
+}
+
+std::size_t CommandList::State::appendData(const void* const in, const std::size_t size) {
+    const std::size_t offset = (data.size() + 7)/8*8;
+    arrayResize(data, Containers::NoInit, offset + size);
+    if(size) std::memcpy(data + offset, in, size);
+    return offset;
+}
+
+CommandList::CommandList(): _state{Containers::InPlaceInit} {}
+
+CommandList::CommandList(CommandList&&) noexcept = default;
+
+CommandList::~CommandList() = default;
+
+CommandList& CommandList::operator=(CommandList&&) noexcept = default;
+
+std::size_t CommandList::size() const { return _state->commands.size(); }
+
+CommandList& CommandList::setUniformInternal(AbstractShaderProgram& shader, const Int location, const UniformFunction function, const Containers::ArrayView<const void> data, const std::size_t count) {
+    const std::size_t offset = _state->appendData(data.data(), data.size());
+    arrayAppend(_state->commands, State::Command{State::executeUniform, function, &shader, nullptr, location, offset, count});
+    return *this;
+}
+
+CommandList& CommandList::bindTexture(const Int textureUnit, AbstractTexture& texture) {
+    AbstractTexture* const textures[]{&texture};
+    return bindTextures(textureUnit, textures);
+}
+
+CommandList& CommandList::bindTextures(const Int firstTextureUnit, const Containers::ArrayView<AbstractTexture* const> textures) {
+    State& state = *_state;
+    const std::size_t size = textures.size()*sizeof(AbstractTexture*);
+
+    /* If the previous command binds textures to units right before this
+       range and its data are at the very end, extend it instead of adding a
+       new command, so the replay does a single multi-bind call */
+    if(!state.commands.empty()) {
+        State::Command& last = state.commands.back();
+        if(last.execute == State::executeBindTextures &&
+           last.index + Int(last.count) == firstTextureUnit &&
+           last.dataOffset + last.count*sizeof(AbstractTexture*) == state.data.size())
+        {
+            const std::size_t offset = state.data.size();
+            arrayResize(state.data, Containers::NoInit, offset + size);
+            std::memcpy(state.data + offset, textures.data(), size);
+            last.count += textures.size();
+            return *this;
+        }
+    }
+
+    const std::size_t offset = state.appendData(textures.data(), size);
+    arrayAppend(state.commands, State::Command{State::executeBindTextures, nullptr, nullptr, nullptr, firstTextureUnit, offset, textures.size()});
+    return *this;
+}
+
+CommandList& CommandList::bindTextures(const Int firstTextureUnit, const std::initializer_list<AbstractTexture*> textures) {
+    return bindTextures(firstTextureUnit, Containers::arrayView(textures));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+CommandList& CommandList::bindBuffer(const Buffer::Target target, const UnsignedInt index, Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    const State::BufferRange range{target, offset, size};
+    const std::size_t dataOffset = _state->appendData(&range, sizeof(range));
+    arrayAppend(_state->commands, State::Command{State::executeBindBufferRange, nullptr, &buffer, nullptr, Int(index), dataOffset, 1});
+    return *this;
+}
+
+CommandList& CommandList::bindBuffer(const Buffer::Target target, const UnsignedInt index, Buffer& buffer) {
+    const State::BufferRange range{target, 0, 0};
+    const std::size_t dataOffset = _state->appendData(&range, sizeof(range));
+    arrayAppend(_state->commands, State::Command{State::executeBindBuffer, nullptr, &buffer, nullptr, Int(index), dataOffset, 1});
+    return *this;
+}
+#endif
+
+CommandList& CommandList::draw(AbstractShaderProgram& shader, Mesh& mesh) {
+    arrayAppend(_state->commands, State::Command{State::executeDraw, nullptr, &shader, &mesh, 0, 0, 0});
+    return *this;
+}
+
+CommandList& CommandList::draw(AbstractShaderProgram& shader, MeshView& mesh) {
+    arrayAppend(_state->commands, State::Command{State::executeDrawView, nullptr, &shader, &mesh, 0, 0, 0});
+    return *this;
+}
+
+void CommandList::replay() {
+    const State& state = *_state;
+    for(const State::Command& command: state.commands)
+        command.execute(command, state.data);
+}
+
+void CommandList::clear() {
+    arrayResize(_state->commands, 0);
+    arrayResize(_state->data, 0);
+}
+
+}}
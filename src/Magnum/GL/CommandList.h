@@ -0,0 +1,232 @@
+#ifndef Magnum_GL_CommandList_h
+#define Magnum_GL_CommandList_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::CommandList
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Recorded list of draw commands
+@m_since_latest
+
+For static parts of a scene, walking the scene graph every frame just to set
+the same uniforms, bind the same textures and draw the same meshes again is
+a waste of CPU time. This class records shader uniform values, texture and
+buffer bindings and draw calls into a compact array once and then replays
+them with @ref replay():
+
+@snippet MagnumGL.cpp CommandList-usage
+
+Uniform values are copied into the list at the time they're recorded, while
+shaders, textures, buffers and meshes are referenced and thus have to stay
+alive for the whole lifetime of the list. Changes done to the meshes after
+recording, such as a different @ref Mesh::setCount(), are reflected on the
+next replay.
+
+@section GL-CommandList-replay Replay overhead
+
+Each command stores a pointer to a function performing it, resolved at
+recording time, so the replay doesn't need to dispatch on the command type.
+Consecutive texture bindings to adjacent units are merged into a single
+multi-bind call already during recording. The replay goes through the same
+state tracker as immediate calls, so shader program uses, mesh bindings and
+texture bindings that are already current are elided --- see
+@ref Context::stateStatistics() for how effective that is. Uniform uploads
+are elided only if the shader has @ref AbstractShaderProgram::setUniformCacheEnabled()
+set.
+
+The class is a CPU-side alternative to the @m_class{m-doc-external} [NV_command_list](https://www.khronos.org/registry/OpenGL/extensions/NV/NV_command_list.txt)
+extension and works on all targets, including OpenGL ES 2.0 and WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT CommandList {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * Creates an empty list.
+         */
+        explicit CommandList();
+
+        /** @brief Copying is not allowed */
+        CommandList(const CommandList&) = delete;
+
+        /** @brief Move constructor */
+        CommandList(CommandList&&) noexcept;
+
+        ~CommandList();
+
+        /** @brief Copying is not allowed */
+        CommandList& operator=(const CommandList&) = delete;
+
+        /** @brief Move assignment */
+        CommandList& operator=(CommandList&&) noexcept;
+
+        /**
+         * @brief Count of recorded commands
+         *
+         * Texture bindings merged into a single multi-bind call count as
+         * one command.
+         */
+        std::size_t size() const;
+
+        /** @brief Whether the list is empty */
+        bool isEmpty() const { return !size(); }
+
+        /**
+         * @brief Record a uniform value
+         * @return Reference to self (for method chaining)
+         *
+         * The @p value is copied into the list and uploaded with
+         * @ref AbstractShaderProgram::setUniform() on @ref replay().
+         */
+        template<class T> CommandList& setUniform(AbstractShaderProgram& shader, Int location, const T& value) {
+            return setUniform(shader, location, Containers::ArrayView<const T>{&value, 1});
+        }
+
+        /**
+         * @brief Record uniform values
+         * @return Reference to self (for method chaining)
+         *
+         * The @p values are copied into the list and uploaded with
+         * @ref AbstractShaderProgram::setUniform() on @ref replay().
+         */
+        template<class T> CommandList& setUniform(AbstractShaderProgram& shader, Int location, Containers::ArrayView<const T> values);
+
+        /**
+         * @brief Record a texture binding
+         * @return Reference to self (for method chaining)
+         *
+         * If the previous command was a texture binding ending at
+         * @p textureUnit, this binding is merged into it.
+         * @see @ref AbstractTexture::bind(Int, Containers::ArrayView<AbstractTexture* const>)
+         */
+        CommandList& bindTexture(Int textureUnit, AbstractTexture& texture);
+
+        /**
+         * @brief Record a texture multi-binding
+         * @return Reference to self (for method chaining)
+         *
+         * Items of @p textures can be @cpp nullptr @ce to unbind given unit.
+         * If the previous command was a texture binding ending at
+         * @p firstTextureUnit, this binding is merged into it.
+         * @see @ref AbstractTexture::bind(Int, Containers::ArrayView<AbstractTexture* const>)
+         */
+        CommandList& bindTextures(Int firstTextureUnit, Containers::ArrayView<AbstractTexture* const> textures);
+
+        /** @overload */
+        CommandList& bindTextures(Int firstTextureUnit, std::initializer_list<AbstractTexture*> textures);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Record an indexed buffer range binding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Buffer::bind(Target, UnsignedInt, GLintptr, GLsizeiptr)
+         * @requires_gles30 Indexed buffer targets are not available in
+         *      OpenGL ES 2.0.
+         * @requires_webgl20 Indexed buffer targets are not available in
+         *      WebGL 1.0.
+         */
+        CommandList& bindBuffer(Buffer::Target target, UnsignedInt index, Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Record an indexed buffer binding
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref Buffer::bind(Target, UnsignedInt)
+         * @requires_gles30 Indexed buffer targets are not available in
+         *      OpenGL ES 2.0.
+         * @requires_webgl20 Indexed buffer targets are not available in
+         *      WebGL 1.0.
+         */
+        CommandList& bindBuffer(Buffer::Target target, UnsignedInt index, Buffer& buffer);
+        #endif
+
+        /**
+         * @brief Record a draw
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref AbstractShaderProgram::draw(Mesh&)
+         */
+        CommandList& draw(AbstractShaderProgram& shader, Mesh& mesh);
+
+        /**
+         * @brief Record a draw of a mesh view
+         * @return Reference to self (for method chaining)
+         *
+         * The view is referenced, not copied.
+         * @see @ref AbstractShaderProgram::draw(MeshView&)
+         */
+        CommandList& draw(AbstractShaderProgram& shader, MeshView& mesh);
+
+        /**
+         * @brief Replay all recorded commands
+         *
+         * Executes the commands in the order they were recorded. Can be
+         * called any number of times.
+         */
+        void replay();
+
+        /**
+         * @brief Clear the list
+         *
+         * Removes all recorded commands, the allocated memory is kept for
+         * recording new ones.
+         */
+        void clear();
+
+    private:
+        typedef void(*UniformFunction)(AbstractShaderProgram&, Int, const void*, std::size_t);
+
+        CommandList& setUniformInternal(AbstractShaderProgram& shader, Int location, UniformFunction function, Containers::ArrayView<const void> data, std::size_t count);
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+template<class T> CommandList& CommandList::setUniform(AbstractShaderProgram& shader, const Int location, const Containers::ArrayView<const T> values) {
+    return setUniformInternal(shader, location, [](AbstractShaderProgram& shader, Int location, const void* data, std::size_t count) {
+        shader.setUniform(location, Containers::ArrayView<const T>{static_cast<const T*>(data), count});
+    }, values, values.size());
+}
+
+}}
+
+#endif
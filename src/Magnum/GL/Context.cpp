@@ -32,6 +32,7 @@
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/GL/AbstractFramebuffer.h"
@@ -44,6 +45,7 @@
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/DebugOutput.h"
 #endif
+#include "Magnum/GL/ContextCapabilityCache.h"
 #include "Magnum/GL/DefaultFramebuffer.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
@@ -56,8 +58,10 @@
 #include "Magnum/GL/Implementation/FramebufferState.h"
 #include "Magnum/GL/Implementation/MeshState.h"
 #include "Magnum/GL/Implementation/RendererState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 #include "Magnum/GL/Implementation/ShaderProgramState.h"
 #include "Magnum/GL/Implementation/TextureState.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
 #ifndef MAGNUM_TARGET_GLES2
 #include "Magnum/GL/Implementation/TransformFeedbackState.h"
 #endif
@@ -106,6 +110,7 @@ constexpr Extension ExtensionList[]{
     _extension(GREMEDY,string_marker),
     _extension(KHR,blend_equation_advanced),
     _extension(KHR,blend_equation_advanced_coherent),
+    _extension(KHR,parallel_shader_compile),
     _extension(KHR,texture_compression_astc_hdr),
     _extension(KHR,texture_compression_astc_ldr),
     _extension(KHR,texture_compression_astc_sliced_3d),
@@ -277,6 +282,7 @@ constexpr Extension ExtensionList[]{
     _extension(EXT,texture_compression_rgtc),
     _extension(EXT,texture_filter_anisotropic),
     _extension(EXT,texture_norm16),
+    _extension(KHR,parallel_shader_compile),
     _extension(OES,texture_float_linear),
     #ifndef MAGNUM_TARGET_GLES2
     _extension(OVR,multiview2),
@@ -375,6 +381,7 @@ constexpr Extension ExtensionList[]{
     _extension(KHR,blend_equation_advanced_coherent),
     _extension(KHR,context_flush_control),
     _extension(KHR,no_error),
+    _extension(KHR,parallel_shader_compile),
     _extension(KHR,texture_compression_astc_hdr),
     _extension(KHR,texture_compression_astc_sliced_3d),
     #ifndef MAGNUM_TARGET_GLES2
@@ -617,6 +624,10 @@ Context*& windowsCurrentContext() {
 #define currentContext windowsCurrentContext()
 #endif
 
+namespace {
+    ContextCapabilityCache* globalCapabilityCache{};
+}
+
 bool Context::hasCurrent() { return currentContext; }
 
 Context& Context::current() {
@@ -635,6 +646,7 @@ Context::Context(NoCreateT, Utility::Arguments& args, Int argc, const char** arg
         .addOption("disable-extensions").setHelp("disable-extensions", "API extensions to disable", "LIST")
         .addOption("gpu-validation", "off").setHelp("gpu-validation", "GPU validation using KHR_debug (if present)", "off|on")
         .addOption("log", "default").setHelp("log", "console logging", "default|quiet|verbose")
+        .addOption("cpu").setHelp("cpu", "CPU instruction set tier for batch functions", "TIER")
         .setFromEnvironment("disable-workarounds")
         .setFromEnvironment("disable-extensions")
         .setFromEnvironment("gpu-validation")
@@ -658,6 +670,12 @@ Context::Context(NoCreateT, Utility::Arguments& args, Int argc, const char** arg
     /* Disable extensions */
     for(auto&& extension: Utility::String::splitWithoutEmptyParts(args.value("disable-extensions")))
         _disabledExtensions.push_back(extension);
+
+    /* Override the CPU tier. The MAGNUM_CPU environment variable is handled
+       directly by Math::cpuTier() so it works without a GL context as well,
+       thus not using setFromEnvironment() here. */
+    if(!args.value("cpu").empty())
+        Math::Implementation::setCpuTier(args.value("cpu").data(), "GL::Context: --magnum-cpu");
 }
 
 Context::Context(Context&& other) noexcept: _version{other._version},
@@ -838,8 +856,32 @@ bool Context::tryCreate() {
         for(const Extension& extension: versions[i].extensions)
             _extensionStatus.set(extension.index(), true);
 
+    /* If a capability cache is set, take the extension list and detected
+       drivers from there instead of querying them. Context flags and profile
+       are a part of the key as they can affect the extension list. */
+    ContextCapabilityCache* const cache = globalCapabilityCache;
+    std::string cacheKey;
+    std::vector<std::string> extensions;
+    bool cached = false;
+    if(cache) {
+        #ifndef MAGNUM_TARGET_GLES
+        GLint profile = 0;
+        if(isVersionSupported(Version::GL320))
+            glGetIntegerv(GL_CONTEXT_PROFILE_MASK, &profile);
+        cacheKey = Utility::formatString("{}\n{}\n{}\n{}\n{}", vendorString(), rendererString(), versionString(), GLint(_flags), profile);
+        #else
+        cacheKey = Utility::formatString("{}\n{}\n{}", vendorString(), rendererString(), versionString());
+        #endif
+
+        UnsignedShort detectedDrivers;
+        if(cache->find(cacheKey, extensions, detectedDrivers)) {
+            _detectedDrivers = DetectedDrivers{DetectedDriver(detectedDrivers)};
+            cached = true;
+        }
+    }
+    if(!cached) extensions = extensionStrings();
+
     /* Check for presence of future and vendor extensions */
-    const std::vector<std::string> extensions = extensionStrings();
     for(const std::string& extension: extensions) {
         for(std::size_t i = future; i != Containers::arraySize(versions); ++i)  {
             const auto found = std::lower_bound(versions[i].extensions.begin(), versions[i].extensions.end(), extension, [](const Extension& a, const std::string& b) { return a.string() < b; });
@@ -850,6 +892,10 @@ bool Context::tryCreate() {
         }
     }
 
+    /* Populate the cache for contexts created later */
+    if(cache && !cached)
+        cache->insert(cacheKey, extensions, UnsignedShort(detectedDriver()));
+
     /* Reset minimal required version to Version::None for whole array */
     for(auto& i: _extensionRequiredVersion) i = Version::None;
 
@@ -901,6 +947,9 @@ bool Context::tryCreate() {
 
     _state.emplace(*this, output);
 
+    if(cached && _internalFlags >= InternalFlag::DisplayVerboseInitializationLog)
+        Debug{output} << "Using extension list from the capability cache";
+
     /* Print a list of used workarounds */
     if(!_driverWorkarounds.empty()) {
         Debug{output} << "Using driver workarounds:";
@@ -1100,15 +1149,23 @@ void Context::resetState(const States states) {
     /* Otherwise just unbind the current VAO and leave the the default */
     } else
     #endif
-    if(states & State::MeshVao)
+    if(states & State::MeshVao) {
         _state->mesh->bindVAOImplementation(0);
 
+        /* On the non-VAO code path, vertex attributes are left enabled
+           after a draw, disable them */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        _state->mesh->disableVertexAttributes();
+        #endif
+    }
+
     if(states & State::PixelStorage) {
         _state->renderer->unpackPixelStorage.reset();
         _state->renderer->packPixelStorage.reset();
     }
 
-    /* Nothing to reset for renderer yet */
+    if(states & State::Renderer)
+        _state->renderer->pipelineStateKnown = 0;
 
     if(states & State::Shaders) {
         /* Nothing to reset for shaders */
@@ -1123,6 +1180,86 @@ void Context::resetState(const States states) {
     #endif
 }
 
+const Context::StateStatistics& Context::stateStatistics() const {
+    return _state->context->statistics;
+}
+
+void Context::resetStateStatistics() {
+    _state->context->statistics = StateStatistics{};
+}
+
+bool Context::isDeferredBinding() const {
+    return _state->context->deferredBinding;
+}
+
+void Context::setDeferredBinding(const bool enabled) {
+    /* Issue everything that was recorded so far */
+    if(!enabled && _state->context->deferredBinding)
+        _state->flushDeferredBindings();
+
+    _state->context->deferredBinding = enabled;
+}
+
+bool Context::isResourceTracking() const {
+    return _state->resource->enabled;
+}
+
+void Context::setResourceTracking(const bool enabled) {
+    if(!enabled) _state->resource->clear();
+    _state->resource->enabled = enabled;
+}
+
+std::size_t Context::resourceCount(const ResourceType type) const {
+    return _state->resource->count[std::size_t(type)];
+}
+
+std::size_t Context::resourceMemory(const ResourceType type) const {
+    return _state->resource->memory[std::size_t(type)];
+}
+
+std::size_t Context::resourceMemory() const {
+    std::size_t memory = 0;
+    for(const std::size_t i: _state->resource->memory) memory += i;
+    return memory;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+std::size_t Context::resourceCount(const std::string& label) const {
+    std::size_t count = 0;
+    for(const auto& resource: _state->resource->resources)
+        if(resource.second.label == label) ++count;
+    return count;
+}
+
+std::size_t Context::resourceMemory(const std::string& label) const {
+    std::size_t memory = 0;
+    for(const auto& resource: _state->resource->resources) {
+        if(resource.second.label != label) continue;
+        memory += resource.second.storage;
+        for(const auto& image: resource.second.images) memory += image.second;
+    }
+    return memory;
+}
+#endif
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+ProgramBinaryCache* Context::programBinaryCache() const {
+    return _state->context->programBinaryCache;
+}
+
+void Context::setProgramBinaryCache(ProgramBinaryCache* const cache) {
+    _state->context->programBinaryCache = cache;
+}
+#endif
+
+ContextCapabilityCache* Context::capabilityCache() {
+    return globalCapabilityCache;
+}
+
+void Context::setCapabilityCache(ContextCapabilityCache* const cache) {
+    globalCapabilityCache = cache;
+}
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 #ifndef MAGNUM_TARGET_WEBGL
 Debug& operator<<(Debug& debug, const Context::Flag value) {
@@ -1210,6 +1347,23 @@ Debug& operator<<(Debug& debug, const Context::DetectedDrivers value) {
         #endif
     });
 }
+
+Debug& operator<<(Debug& debug, const Context::ResourceType value) {
+    debug << "GL::Context::ResourceType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Context::ResourceType::value: return debug << "::" #value;
+        _c(Buffer)
+        _c(Texture)
+        _c(Renderbuffer)
+        _c(Mesh)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
 #endif
 
 }}
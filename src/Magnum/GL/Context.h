@@ -124,7 +124,8 @@ either from the `Platform::*Application` classes or from the
 <application> [--magnum-help] [--magnum-disable-workarounds LIST]
               [--magnum-disable-extensions LIST]
               [--magnum-gpu-validation off|on]
-              [--magnum-log default|quiet|verbose] ...
+              [--magnum-log default|quiet|verbose]
+              [--magnum-cpu TIER] ...
 @endcode
 
 Arguments:
@@ -147,6 +148,9 @@ Arguments:
     (environment: `MAGNUM_LOG`) (default: `default`). If you need to suppress
     the engine startup log from code, the recommended way is to redirect
     @ref Utility-Debug-scoped-output "debug output to null" during context creation.
+-   `--magnum-cpu TIER` --- CPU instruction set tier used by batch functions,
+    one of `sse2`, `sse41`, `avx2`, `avx512`, `neon`, `simd128` or `scalar`
+    (environment: `MAGNUM_CPU`). See @ref Math::cpuTier() for details.
 
 Note that all options are prefixed with `--magnum-` to avoid conflicts with
 options passed to the application itself. Options that don't have this prefix
@@ -296,6 +300,11 @@ class MAGNUM_GL_EXPORT Context {
              * Similar issue can happen the other way. Calling @ref resetState()
              * with @ref State::MeshVao included unbounds any currently bound
              * VAO to fix such case.
+             *
+             * On platforms without VAOs, vertex attributes enabled by the
+             * most recent draw are similarly left enabled to avoid
+             * respecifying them for the next draw. Including
+             * @ref State::MeshVao disables them.
              */
             MeshVao = 1 << 4,
 
@@ -365,6 +374,112 @@ class MAGNUM_GL_EXPORT Context {
          */
         typedef Containers::EnumSet<State> States;
 
+        /**
+         * @brief State tracker statistics
+         * @m_since_latest
+         *
+         * @see @ref stateStatistics(), @ref resetStateStatistics(),
+         *      @ref opengl-state-tracking
+         */
+        struct StateStatistics {
+            /**
+             * @brief Statistics counter
+             *
+             * A multi-bind call with @f$ n @f$ objects counts as one issued
+             * call and @f$ n - 1 @f$ elided calls.
+             */
+            struct Counter {
+                /** @brief Count of issued OpenGL calls */
+                UnsignedLong issued;
+
+                /**
+                 * @brief Count of OpenGL calls elided by the state tracker
+                 *
+                 * Includes calls that were redundant and calls merged into a
+                 * single multi-bind call.
+                 */
+                UnsignedLong elided;
+            };
+
+            /**
+             * @brief Buffer bindings
+             *
+             * Bindings to non-indexed targets, done implicitly when the buffer
+             * is used with non-DSA APIs.
+             */
+            Counter bufferBindings;
+
+            /** @brief Framebuffer bindings */
+            Counter framebufferBindings;
+
+            /** @brief Mesh vertex array object bindings */
+            Counter meshBindings;
+
+            /** @brief Shader program uses */
+            Counter shaderProgramUses;
+
+            /**
+             * @brief Texture bindings
+             *
+             * Both explicit bindings to texture units and implicit bindings
+             * done when the texture is used with non-DSA APIs.
+             */
+            Counter textureBindings;
+
+            /**
+             * @brief Uniform uploads
+             *
+             * Uploads done through @ref AbstractShaderProgram::setUniform().
+             * Calls are elided only for programs that have
+             * @ref AbstractShaderProgram::setUniformCacheEnabled() set.
+             */
+            Counter uniformUploads;
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * @brief Uniform buffer bindings
+             *
+             * Indexed bindings are not tracked, so calls are elided only with
+             * @ref Context::setDeferredBinding() enabled.
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             */
+            Counter uniformBufferBindings;
+            #endif
+        };
+
+        /**
+         * @brief Tracked resource type
+         * @m_since_latest
+         *
+         * @see @ref setResourceTracking(), @ref resourceCount(),
+         *      @ref resourceMemory()
+         */
+        enum class ResourceType: UnsignedByte {
+            /** @ref Buffer instances */
+            Buffer,
+
+            /**
+             * All texture types deriving from @ref AbstractTexture. Buffer
+             * textures don't allocate any memory on their own, their memory
+             * is accounted for in the @ref ResourceType::Buffer they're
+             * attached to.
+             */
+            Texture,
+
+            /** @ref Renderbuffer instances */
+            Renderbuffer,
+
+            /**
+             * @ref Mesh instances. Tracked only if vertex array objects are
+             * supported and the memory is always zero, as the meshes
+             * reference buffers tracked as @ref ResourceType::Buffer.
+             */
+            Mesh
+        };
+
         /**
          * @brief Detected driver
          *
@@ -727,6 +842,208 @@ class MAGNUM_GL_EXPORT Context {
          */
         void resetState(States states = ~States{});
 
+        /**
+         * @brief State tracker statistics
+         * @m_since_latest
+         *
+         * Count of OpenGL calls issued and elided by the state tracker since
+         * the context creation or since the last call to
+         * @ref resetStateStatistics(). Useful for checking how effective the
+         * state tracking is in a particular application:
+         *
+         * @snippet MagnumGL.cpp Context-stateStatistics
+         *
+         * @see @ref opengl-state-tracking
+         */
+        const StateStatistics& stateStatistics() const;
+
+        /**
+         * @brief Reset state tracker statistics
+         * @m_since_latest
+         *
+         * Sets all counters in @ref stateStatistics() to zero.
+         */
+        void resetStateStatistics();
+
+        /**
+         * @brief Whether deferred binding is enabled
+         * @m_since_latest
+         *
+         * @see @ref setDeferredBinding()
+         */
+        bool isDeferredBinding() const;
+
+        /**
+         * @brief Enable or disable deferred binding
+         * @m_since_latest
+         *
+         * If enabled, texture bindings done with @ref AbstractTexture::bind()
+         * and uniform buffer bindings done with @ref Buffer::bind() are
+         * recorded and issued only right before the next draw or compute
+         * dispatch with @ref AbstractShaderProgram. Repeated bindings to the
+         * same unit or binding point are coalesced and consecutive units are
+         * bound with a single multi-bind call if
+         * @gl_extension{ARB,multi_bind} is available. Unbinding is still done
+         * immediately. The bound objects have to stay alive and not be moved
+         * until the next draw, a destroyed object is removed from the
+         * recorded bindings.
+         *
+         * Disabling the deferred binding issues all recorded bindings.
+         * Disabled by default.
+         * @see @ref stateStatistics()
+         */
+        void setDeferredBinding(bool enabled);
+
+        /**
+         * @brief Whether resource tracking is enabled
+         * @m_since_latest
+         *
+         * @see @ref setResourceTracking()
+         */
+        bool isResourceTracking() const;
+
+        /**
+         * @brief Enable or disable resource tracking
+         * @m_since_latest
+         *
+         * If enabled, creation and destruction of @ref Buffer,
+         * @ref AbstractTexture "texture", @ref Renderbuffer and @ref Mesh
+         * instances is recorded together with an estimate of GPU memory
+         * allocated by @ref Buffer::setData(), @ref Buffer::setStorage(),
+         * @ref Renderbuffer::setStorage() and the texture
+         * @cpp setStorage() @ce, @cpp setImage() @ce and
+         * @cpp setCompressedImage() @ce functions. The memory is calculated
+         * from the size and format passed to the functions --- the driver
+         * may need more for alignment or internal bookkeeping, packed and
+         * unsized formats that don't have a generic @ref Magnum::PixelFormat
+         * counterpart are assumed to have four bytes per pixel. Objects
+         * created before the tracking got enabled, and objects created with
+         * @cpp wrap() @ce, are not tracked.
+         *
+         * Disabling the tracking discards everything recorded so far.
+         * Disabled by default.
+         *
+         * @snippet MagnumGL.cpp Context-setResourceTracking
+         *
+         * @see @ref resourceCount(), @ref resourceMemory(),
+         *      @ref DebugTools::GLFrameProfiler::Value::GpuMemory
+         */
+        void setResourceTracking(bool enabled);
+
+        /**
+         * @brief Count of live resources of given type
+         * @m_since_latest
+         *
+         * Always @cpp 0 @ce if resource tracking is not enabled.
+         * @see @ref setResourceTracking()
+         */
+        std::size_t resourceCount(ResourceType type) const;
+
+        /**
+         * @brief Estimated memory used by live resources of given type
+         * @m_since_latest
+         *
+         * In bytes. Always @cpp 0 @ce if resource tracking is not enabled.
+         * @see @ref setResourceTracking()
+         */
+        std::size_t resourceMemory(ResourceType type) const;
+
+        /**
+         * @brief Estimated memory used by all live resources
+         * @m_since_latest
+         *
+         * In bytes, sum of @ref resourceMemory(ResourceType) const for all
+         * types. Always @cpp 0 @ce if resource tracking is not enabled.
+         * @see @ref setResourceTracking()
+         */
+        std::size_t resourceMemory() const;
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Count of live resources with given debug label
+         * @m_since_latest
+         *
+         * Counts resources of all types that had the label set using their
+         * @cpp setLabel() @ce function while resource tracking was enabled.
+         * Labels are tracked even if the driver doesn't support the
+         * @gl_extension{KHR,debug} or @gl_extension{EXT,debug_label}
+         * extensions. The lookup goes through all tracked resources, so it's
+         * not meant to be called in a tight loop.
+         * @see @ref setResourceTracking()
+         * @requires_gles Debug output is not available in WebGL.
+         */
+        std::size_t resourceCount(const std::string& label) const;
+
+        /**
+         * @brief Estimated memory used by live resources with given debug label
+         * @m_since_latest
+         *
+         * In bytes. See @ref resourceCount(const std::string&) const for more
+         * information.
+         * @see @ref setResourceTracking()
+         * @requires_gles Debug output is not available in WebGL.
+         */
+        std::size_t resourceMemory(const std::string& label) const;
+        #endif
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Program binary cache
+         * @m_since_latest
+         *
+         * @see @ref setProgramBinaryCache()
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Program binaries are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        ProgramBinaryCache* programBinaryCache() const;
+
+        /**
+         * @brief Set program binary cache
+         * @m_since_latest
+         *
+         * If set, builtin shaders such as @ref Shaders::Phong or
+         * @ref Shaders::Flat try to load their binary from the cache first
+         * and compile and link from source only if it's not there or the
+         * driver rejects it, saving the binary to the cache afterwards. The
+         * cache is not owned by the context and has to stay alive until it's
+         * unset again or until the context is destroyed. Pass
+         * @cpp nullptr @ce to disable the cache. Not set by default.
+         * @requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+         * @requires_gles30 Program binaries are not available in OpenGL ES
+         *      2.0.
+         * @requires_gles Binary program representations are not supported in
+         *      WebGL.
+         */
+        void setProgramBinaryCache(ProgramBinaryCache* cache);
+        #endif
+
+        /**
+         * @brief Context capability cache
+         * @m_since_latest
+         *
+         * @see @ref setCapabilityCache()
+         */
+        static ContextCapabilityCache* capabilityCache();
+
+        /**
+         * @brief Set context capability cache
+         * @m_since_latest
+         *
+         * If set, contexts created afterwards take their extension list and
+         * detected drivers from the cache instead of querying the driver,
+         * if a context on the same driver was created before, and populate
+         * it otherwise. See @ref ContextCapabilityCache for more
+         * information. The cache is global for all contexts and has to be
+         * set before the contexts are created, typically before
+         * constructing the application. It's not owned by the contexts and
+         * has to stay alive until it's unset again. Pass @cpp nullptr @ce
+         * to disable the cache. Not set by default.
+         */
+        static void setCapabilityCache(ContextCapabilityCache* cache);
+
         /**
          * @brief Detect driver
          *
@@ -827,6 +1144,12 @@ MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Context::DetectedDriver value);
 /** @debugoperatorclassenum{Context,Context::DetectedDrivers} */
 MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Context::DetectedDrivers value);
 
+/**
+@debugoperatorclassenum{Context,Context::ResourceType}
+@m_since_latest
+*/
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Context::ResourceType value);
+
 /** @hideinitializer
 @brief Assert that given OpenGL version is supported
 @param version      Version
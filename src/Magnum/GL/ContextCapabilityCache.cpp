@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ContextCapabilityCache.h"
+
+#include <cstring>
+#include <mutex>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/Endianness.h>
+
+namespace Magnum { namespace GL {
+
+namespace {
+    /* Bump when the format changes */
+    constexpr char Magic[]{'M', 'G', 'C', 'C'};
+    constexpr UnsignedInt FormatVersion = 1;
+
+    /* Stored as little-endian so the data are portable */
+    void appendUnsignedInt(Containers::Array<char>& out, const UnsignedInt value) {
+        const UnsignedInt littleEndian = Utility::Endianness::littleEndian(value);
+        char* const data = arrayAppend(out, Containers::NoInit, sizeof(UnsignedInt)).data();
+        std::memcpy(data, &littleEndian, sizeof(UnsignedInt));
+    }
+
+    void appendString(Containers::Array<char>& out, const std::string& value) {
+        appendUnsignedInt(out, value.size());
+        arrayAppend(out, Containers::arrayView(value.data(), value.size()));
+    }
+
+    /* Both advance the data view and return false if there's not enough data
+       left */
+    bool readUnsignedInt(Containers::ArrayView<const char>& data, UnsignedInt& value) {
+        if(data.size() < sizeof(UnsignedInt)) return false;
+        std::memcpy(&value, data.data(), sizeof(UnsignedInt));
+        value = Utility::Endianness::littleEndian(value);
+        data = data.suffix(sizeof(UnsignedInt));
+        return true;
+    }
+
+    bool readString(Containers::ArrayView<const char>& data, std::string& value) {
+        UnsignedInt size;
+        if(!readUnsignedInt(data, size) || data.size() < size) return false;
+        value.assign(data.data(), size);
+        data = data.suffix(size);
+        return true;
+    }
+}
+
+struct ContextCapabilityCache::State {
+    struct Entry {
+        std::string key;
+        std::vector<std::string> extensions;
+        UnsignedShort detectedDrivers;
+    };
+
+    /* Contexts can be created from multiple threads */
+    mutable std::mutex mutex;
+    /* There's usually just one or two, so a linear lookup is fine */
+    std::vector<Entry> entries;
+
+    void insert(Entry&& entry) {
+        for(Entry& i: entries) if(i.key == entry.key) {
+            i = std::move(entry);
+            return;
+        }
+        entries.push_back(std::move(entry));
+    }
+};
+
+ContextCapabilityCache::ContextCapabilityCache(): _state{Containers::InPlaceInit} {}
+
+ContextCapabilityCache::ContextCapabilityCache(ContextCapabilityCache&&) noexcept = default;
+
+ContextCapabilityCache::~ContextCapabilityCache() = default;
+
+ContextCapabilityCache& ContextCapabilityCache::operator=(ContextCapabilityCache&&) noexcept = default;
+
+std::size_t ContextCapabilityCache::size() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    return _state->entries.size();
+}
+
+void ContextCapabilityCache::clear() {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    _state->entries.clear();
+}
+
+Containers::Array<char> ContextCapabilityCache::serialize() const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+
+    Containers::Array<char> out;
+    arrayAppend(out, Containers::arrayView(Magic));
+    appendUnsignedInt(out, FormatVersion);
+    appendUnsignedInt(out, _state->entries.size());
+    for(const State::Entry& entry: _state->entries) {
+        appendString(out, entry.key);
+        appendUnsignedInt(out, entry.detectedDrivers);
+        appendUnsignedInt(out, entry.extensions.size());
+        for(const std::string& extension: entry.extensions)
+            appendString(out, extension);
+    }
+
+    /* Convert back to a default deleter to not expose a growable array */
+    arrayShrink(out);
+    return out;
+}
+
+bool ContextCapabilityCache::deserialize(Containers::ArrayView<const char> data) {
+    if(data.size() < sizeof(Magic) || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0) {
+        Error{} << "GL::ContextCapabilityCache::deserialize(): invalid signature";
+        return false;
+    }
+    data = data.suffix(sizeof(Magic));
+
+    UnsignedInt version;
+    if(!readUnsignedInt(data, version) || version != FormatVersion) {
+        Error{} << "GL::ContextCapabilityCache::deserialize(): unsupported format version";
+        return false;
+    }
+
+    /* Parse everything first so the cache stays unchanged on error */
+    UnsignedInt entryCount;
+    std::vector<State::Entry> entries;
+    bool valid = readUnsignedInt(data, entryCount);
+    for(UnsignedInt i = 0; valid && i != entryCount; ++i) {
+        State::Entry entry;
+        UnsignedInt detectedDrivers, extensionCount;
+        valid = readString(data, entry.key) &&
+            readUnsignedInt(data, detectedDrivers) &&
+            readUnsignedInt(data, extensionCount) &&
+            /* Each extension needs at least the size, check before
+               allocating to not blow up on garbage */
+            extensionCount <= data.size()/sizeof(UnsignedInt);
+        if(!valid) break;
+
+        entry.detectedDrivers = detectedDrivers;
+        entry.extensions.resize(extensionCount);
+        for(std::string& extension: entry.extensions)
+            if(!(valid = readString(data, extension))) break;
+
+        entries.push_back(std::move(entry));
+    }
+
+    if(!valid || !data.empty()) {
+        Error{} << "GL::ContextCapabilityCache::deserialize(): invalid or truncated data";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    for(State::Entry& entry: entries) _state->insert(std::move(entry));
+    return true;
+}
+
+bool ContextCapabilityCache::find(const std::string& key, std::vector<std::string>& extensions, UnsignedShort& detectedDrivers) const {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    for(const State::Entry& entry: _state->entries) if(entry.key == key) {
+        extensions = entry.extensions;
+        detectedDrivers = entry.detectedDrivers;
+        return true;
+    }
+    return false;
+}
+
+void ContextCapabilityCache::insert(const std::string& key, const std::vector<std::string>& extensions, const UnsignedShort detectedDrivers) {
+    std::lock_guard<std::mutex> lock{_state->mutex};
+    _state->insert(State::Entry{key, extensions, detectedDrivers});
+}
+
+}}
@@ -0,0 +1,133 @@
+#ifndef Magnum_GL_ContextCapabilityCache_h
+#define Magnum_GL_ContextCapabilityCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::ContextCapabilityCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <vector>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Context capability cache
+@m_since_latest
+
+Remembers the list of extensions and detected drivers of created contexts,
+so contexts created later on the same driver don't need to query them again.
+That's useful mainly on platforms where retrieving the extension list is
+slow, such as WebGL, and for applications that create many shared or worker
+contexts. The cache is set globally via @ref Context::setCapabilityCache()
+and used by all contexts created after:
+
+@snippet MagnumGL.cpp ContextCapabilityCache-usage
+
+The entries are keyed by the vendor, renderer and version string together
+with the context flags and profile, so a driver update or a different GPU
+results in a cache miss and the extensions are queried again. The version
+itself, context flags and driver workarounds are still determined on every
+context creation, as that involves only a few cheap queries and the
+workarounds depend on options passed to each context. Implementation limits
+aren't part of the cache as they're queried lazily only when actually needed
+and then cached for the context lifetime already.
+
+With @ref serialize() and @ref deserialize() the cache can be persisted
+across application runs. The serialized data store extension names and not
+their internal indices, so a cache saved by one version of Magnum can be
+loaded by a different version, with extensions unknown to it being ignored.
+
+The cache is safe to be used by contexts created from multiple threads at the
+same time.
+*/
+class MAGNUM_GL_EXPORT ContextCapabilityCache {
+    public:
+        /** @brief Constructor */
+        explicit ContextCapabilityCache();
+
+        /** @brief Copying is not allowed */
+        ContextCapabilityCache(const ContextCapabilityCache&) = delete;
+
+        /** @brief Move constructor */
+        ContextCapabilityCache(ContextCapabilityCache&&) noexcept;
+
+        ~ContextCapabilityCache();
+
+        /** @brief Copying is not allowed */
+        ContextCapabilityCache& operator=(const ContextCapabilityCache&) = delete;
+
+        /** @brief Move assignment */
+        ContextCapabilityCache& operator=(ContextCapabilityCache&&) noexcept;
+
+        /** @brief Count of cached driver configurations */
+        std::size_t size() const;
+
+        /** @brief Whether the cache is empty */
+        bool isEmpty() const { return !size(); }
+
+        /** @brief Clear the cache */
+        void clear();
+
+        /**
+         * @brief Serialize the cache
+         *
+         * Returns a binary representation of all entries that can be passed
+         * to @ref deserialize(), for example in the next application run.
+         */
+        Containers::Array<char> serialize() const;
+
+        /**
+         * @brief Deserialize the cache
+         *
+         * Adds entries from @p data produced by @ref serialize(), replacing
+         * existing entries with the same key. If @p data are not a valid
+         * serialized cache, prints a message to @ref Error and returns
+         * @cpp false @ce, leaving the cache unchanged.
+         */
+        bool deserialize(Containers::ArrayView<const char> data);
+
+    private:
+        friend Context;
+
+        struct State;
+
+        /* Used by Context::tryCreate() */
+        MAGNUM_GL_LOCAL bool find(const std::string& key, std::vector<std::string>& extensions, UnsignedShort& detectedDrivers) const;
+        MAGNUM_GL_LOCAL void insert(const std::string& key, const std::vector<std::string>& extensions, UnsignedShort detectedDrivers);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
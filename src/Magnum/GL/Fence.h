@@ -0,0 +1,217 @@
+#ifndef Magnum_GL_Fence_h
+#define Magnum_GL_Fence_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::Fence
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <utility>
+
+#include "Magnum/GL/AbstractObject.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Fence sync object
+@m_since_latest
+
+Inserted into the command stream on construction and becomes signaled once the
+GPU finishes all commands issued before it. Useful for knowing when it's safe
+to reuse memory the GPU reads from, such as persistently mapped buffers or
+buffers used for pixel uploads:
+
+@snippet MagnumGL.cpp Fence-usage
+
+The @ref isSignaled() query never blocks. Use @ref clientWait() to wait on
+the CPU side with a timeout and @ref wait() to make the GPU wait for the fence
+without blocking the CPU. See also @ref RingBuffer, which uses fences for
+reclaiming streamed memory.
+
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Sync objects are not available in OpenGL ES 2.0.
+@requires_webgl20 Sync objects are not available in WebGL 1.0.
+*/
+class MAGNUM_GL_EXPORT Fence {
+    public:
+        /**
+         * @brief Client wait result
+         *
+         * @see @ref clientWait()
+         * @m_enum_values_as_keywords
+         */
+        enum class WaitResult: GLenum {
+            /** The fence was already signaled when waiting started */
+            AlreadySignaled = GL_ALREADY_SIGNALED,
+
+            /** The fence got signaled before the timeout expired */
+            ConditionSatisfied = GL_CONDITION_SATISFIED,
+
+            /** The timeout expired before the fence got signaled */
+            TimeoutExpired = GL_TIMEOUT_EXPIRED,
+
+            /** An error occurred */
+            WaitFailed = GL_WAIT_FAILED
+        };
+
+        /**
+         * @brief Wrap existing OpenGL sync object
+         * @param id            OpenGL sync object
+         * @param flags         Object creation flags
+         *
+         * The @p id is expected to be in a valid state. Unlike sync created
+         * using a constructor, the OpenGL object is by default not deleted on
+         * destruction, use @p flags for different behavior.
+         * @see @ref release()
+         */
+        static Fence wrap(GLsync id, ObjectFlags flags = {}) {
+            return Fence{id, flags};
+        }
+
+        /**
+         * @brief Constructor
+         *
+         * Creates a new fence and inserts it into the command stream.
+         * @see @ref Fence(NoCreateT), @ref wrap(), @fn_gl_keyword{FenceSync}
+         *      with @def_gl{SYNC_GPU_COMMANDS_COMPLETE}
+         */
+        explicit Fence();
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         * @see @ref Fence(), @ref wrap()
+         */
+        explicit Fence(NoCreateT) noexcept: _id{}, _flags{ObjectFlag::DeleteOnDestruction} {}
+
+        /** @brief Copying is not allowed */
+        Fence(const Fence&) = delete;
+
+        /** @brief Move constructor */
+        Fence(Fence&& other) noexcept: _id{other._id}, _flags{other._flags} {
+            other._id = {};
+        }
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes associated OpenGL sync object.
+         * @see @ref wrap(), @ref release(), @fn_gl_keyword{DeleteSync}
+         */
+        ~Fence();
+
+        /** @brief Copying is not allowed */
+        Fence& operator=(const Fence&) = delete;
+
+        /** @brief Move assignment */
+        Fence& operator=(Fence&& other) noexcept {
+            using std::swap;
+            swap(_id, other._id);
+            swap(_flags, other._flags);
+            return *this;
+        }
+
+        /** @brief OpenGL sync object */
+        GLsync id() const { return _id; }
+
+        /**
+         * @brief Release OpenGL object
+         *
+         * Releases ownership of OpenGL sync object and returns it so it is
+         * not deleted on destruction. The internal state is then equivalent
+         * to moved-from state.
+         * @see @ref wrap()
+         */
+        GLsync release() {
+            const GLsync id = _id;
+            _id = {};
+            return id;
+        }
+
+        /**
+         * @brief Whether the fence is signaled
+         *
+         * Doesn't block. Note that the fence may never become signaled if
+         * the commands preceding it aren't flushed to the GPU --- in that
+         * case call @ref Renderer::flush() or use @ref clientWait(), which
+         * flushes implicitly.
+         * @see @fn_gl_keyword{GetSync} with @def_gl{SYNC_STATUS}
+         */
+        bool isSignaled();
+
+        /**
+         * @brief Wait for the fence on the CPU side
+         * @param timeout   Timeout in nanoseconds. Can be @cpp 0 @ce, in
+         *      which case the function returns immediately.
+         *
+         * Blocks until the fence is signaled or @p timeout expires. Commands
+         * preceding the fence are flushed to the GPU first.
+         * @see @ref isSignaled(), @fn_gl_keyword{ClientWaitSync} with
+         *      @def_gl{SYNC_FLUSH_COMMANDS_BIT}
+         * @requires_webgl20 On WebGL the @p timeout has to be not larger than
+         *      @def_gl{MAX_CLIENT_WAIT_TIMEOUT_WEBGL}, which is usually
+         *      @cpp 0 @ce.
+         */
+        WaitResult clientWait(UnsignedLong timeout);
+
+        /**
+         * @brief Make the GPU wait for the fence
+         *
+         * Doesn't block the CPU, only commands issued after this call are
+         * not executed by the GPU until the fence is signaled. Useful for
+         * synchronizing between multiple contexts.
+         * @see @fn_gl_keyword{WaitSync}
+         */
+        void wait();
+
+    private:
+        explicit Fence(GLsync id, ObjectFlags flags) noexcept: _id{id}, _flags{flags} {}
+
+        GLsync _id;
+        ObjectFlags _flags;
+};
+
+/** @debugoperatorclassenum{Fence,Fence::WaitResult} */
+MAGNUM_GL_EXPORT Debug& operator<<(Debug& debug, Fence::WaitResult value);
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
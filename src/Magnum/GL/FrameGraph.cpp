@@ -0,0 +1,352 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameGraph.h"
+
+#include <vector>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Sampler.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL {
+
+struct FrameGraph::State {
+    struct Resource {
+        bool isTexture;
+        bool output;
+        GLenum format;
+        Vector2i size;
+        /* Pass indices, -1 if not used by any pass. Outputs live until the
+           end, i.e. their last use is the pass count. */
+        Int firstUse, lastUse;
+        /* Index into the attachment pool, -1 if not assigned */
+        Int attachment;
+    };
+
+    struct Write {
+        UnsignedInt resource;
+        Framebuffer::BufferAttachment attachment;
+    };
+
+    struct Pass {
+        Range2Di viewport;
+        PassFunction function;
+        void* state;
+        std::vector<Write> writes;
+        std::vector<UnsignedInt> reads;
+        std::vector<Framebuffer::BufferAttachment> invalidateBefore, invalidateAfter;
+    };
+
+    struct Attachment {
+        bool isTexture;
+        GLenum format;
+        Vector2i size;
+        Texture2D texture{NoCreate};
+        Renderbuffer renderbuffer{NoCreate};
+        /* Last pass the attachment is used in during compile(), -1 if it's
+           free from the start */
+        Int lastUse;
+        bool used;
+    };
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<Attachment> attachments;
+    std::vector<Framebuffer> framebuffers;
+    bool compiled{};
+};
+
+namespace {
+
+#if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+/* Framebuffer::invalidate() takes an initializer list of a different type,
+   so it's one call per attachment */
+void invalidate(Framebuffer& framebuffer, const Framebuffer::BufferAttachment attachment) {
+    const GLenum value = GLenum(attachment);
+    if(value == GLenum(Framebuffer::BufferAttachment::Depth))
+        framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth});
+    else if(value == GLenum(Framebuffer::BufferAttachment::Stencil))
+        framebuffer.invalidate({Framebuffer::InvalidationAttachment::Stencil});
+    #ifndef MAGNUM_TARGET_GLES2
+    else if(value == GLenum(Framebuffer::BufferAttachment::DepthStencil))
+        framebuffer.invalidate({Framebuffer::InvalidationAttachment::Depth,
+                                Framebuffer::InvalidationAttachment::Stencil});
+    #endif
+    else framebuffer.invalidate({Framebuffer::ColorAttachment{value - GL_COLOR_ATTACHMENT0}});
+}
+#endif
+
+}
+
+FrameGraph::FrameGraph(): _state{Containers::InPlaceInit} {}
+
+FrameGraph::FrameGraph(FrameGraph&&) noexcept = default;
+
+FrameGraph::~FrameGraph() = default;
+
+FrameGraph& FrameGraph::operator=(FrameGraph&&) noexcept = default;
+
+UnsignedInt FrameGraph::resourceCount() const { return _state->resources.size(); }
+
+UnsignedInt FrameGraph::passCount() const { return _state->passes.size(); }
+
+std::size_t FrameGraph::attachmentCount() const { return _state->attachments.size(); }
+
+bool FrameGraph::isCompiled() const { return _state->compiled; }
+
+UnsignedInt FrameGraph::addTexture(const TextureFormat format, const Vector2i& size) {
+    CORRADE_ASSERT((size > Vector2i{}).all(),
+        "GL::FrameGraph::addTexture(): expected a positive size, got" << size, {});
+    _state->resources.push_back({true, false, GLenum(format), size, -1, -1, -1});
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt FrameGraph::addRenderbuffer(const RenderbufferFormat format, const Vector2i& size) {
+    CORRADE_ASSERT((size > Vector2i{}).all(),
+        "GL::FrameGraph::addRenderbuffer(): expected a positive size, got" << size, {});
+    _state->resources.push_back({false, false, GLenum(format), size, -1, -1, -1});
+    _state->compiled = false;
+    return _state->resources.size() - 1;
+}
+
+UnsignedInt FrameGraph::addPass(const Range2Di& viewport, const PassFunction function, void* const state) {
+    CORRADE_ASSERT(function,
+        "GL::FrameGraph::addPass(): expected a non-null function", {});
+    _state->passes.push_back({viewport, function, state, {}, {}, {}, {}});
+    _state->compiled = false;
+    return _state->passes.size() - 1;
+}
+
+FrameGraph& FrameGraph::write(const UnsignedInt pass, const UnsignedInt resource, const Framebuffer::BufferAttachment attachment) {
+    State& state = *_state;
+    CORRADE_ASSERT(pass < state.passes.size(),
+        "GL::FrameGraph::write(): pass" << pass << "out of range for" << state.passes.size() << "passes", *this);
+    CORRADE_ASSERT(resource < state.resources.size(),
+        "GL::FrameGraph::write(): resource" << resource << "out of range for" << state.resources.size() << "resources", *this);
+    state.passes[pass].writes.push_back({resource, attachment});
+    state.compiled = false;
+    return *this;
+}
+
+FrameGraph& FrameGraph::read(const UnsignedInt pass, const UnsignedInt resource) {
+    State& state = *_state;
+    CORRADE_ASSERT(pass < state.passes.size(),
+        "GL::FrameGraph::read(): pass" << pass << "out of range for" << state.passes.size() << "passes", *this);
+    CORRADE_ASSERT(resource < state.resources.size(),
+        "GL::FrameGraph::read(): resource" << resource << "out of range for" << state.resources.size() << "resources", *this);
+    CORRADE_ASSERT(state.resources[resource].isTexture,
+        "GL::FrameGraph::read(): resource" << resource << "is a renderbuffer", *this);
+    state.passes[pass].reads.push_back(resource);
+    state.compiled = false;
+    return *this;
+}
+
+FrameGraph& FrameGraph::setOutput(const UnsignedInt resource) {
+    State& state = *_state;
+    CORRADE_ASSERT(resource < state.resources.size(),
+        "GL::FrameGraph::setOutput(): resource" << resource << "out of range for" << state.resources.size() << "resources", *this);
+    state.resources[resource].output = true;
+    state.compiled = false;
+    return *this;
+}
+
+void FrameGraph::compile() {
+    State& state = *_state;
+
+    /* Calculate resource lifetimes */
+    for(State::Resource& resource: state.resources)
+        resource.firstUse = resource.lastUse = resource.attachment = -1;
+    for(std::size_t i = 0; i != state.passes.size(); ++i) {
+        State::Pass& pass = state.passes[i];
+        CORRADE_ASSERT(!pass.writes.empty(),
+            "GL::FrameGraph::compile(): pass" << i << "doesn't write any resource", );
+
+        const auto use = [&](const UnsignedInt id) {
+            State::Resource& resource = state.resources[id];
+            if(resource.firstUse == -1) resource.firstUse = i;
+            resource.lastUse = i;
+        };
+        for(const State::Write& write: pass.writes) use(write.resource);
+        for(const UnsignedInt read: pass.reads) {
+            #ifndef CORRADE_NO_ASSERT
+            for(const State::Write& write: pass.writes)
+                CORRADE_ASSERT(write.resource != read,
+                    "GL::FrameGraph::compile(): pass" << i << "both reads and writes resource" << read, );
+            #endif
+            use(read);
+        }
+    }
+    for(State::Resource& resource: state.resources)
+        if(resource.output && resource.firstUse != -1)
+            resource.lastUse = Int(state.passes.size());
+
+    /* Assign pooled attachments to resources in order of their first use. An
+       attachment can be reused if it has the same format and size and its
+       previous user is done with it. There's usually just a few dozen
+       resources at most, so a quadratic search is fine. */
+    for(State::Attachment& attachment: state.attachments) {
+        attachment.lastUse = -1;
+        attachment.used = false;
+    }
+    for(std::size_t pass = 0; pass != state.passes.size(); ++pass) {
+        for(State::Resource& resource: state.resources) {
+            if(resource.firstUse != Int(pass)) continue;
+
+            std::size_t i = 0;
+            for(; i != state.attachments.size(); ++i) {
+                const State::Attachment& attachment = state.attachments[i];
+                if(attachment.isTexture == resource.isTexture && attachment.format == resource.format && attachment.size == resource.size && attachment.lastUse < resource.firstUse)
+                    break;
+            }
+
+            if(i == state.attachments.size()) {
+                state.attachments.emplace_back();
+                State::Attachment& attachment = state.attachments.back();
+                attachment.isTexture = resource.isTexture;
+                attachment.format = resource.format;
+                attachment.size = resource.size;
+                if(resource.isTexture) {
+                    attachment.texture = Texture2D{};
+                    attachment.texture.setMinificationFilter(SamplerFilter::Linear)
+                        .setMagnificationFilter(SamplerFilter::Linear)
+                        .setWrapping(SamplerWrapping::ClampToEdge)
+                        .setStorage(1, TextureFormat(resource.format), resource.size);
+                } else {
+                    attachment.renderbuffer = Renderbuffer{};
+                    attachment.renderbuffer.setStorage(RenderbufferFormat(resource.format), resource.size);
+                }
+            }
+
+            State::Attachment& attachment = state.attachments[i];
+            attachment.used = true;
+            attachment.lastUse = resource.lastUse;
+            resource.attachment = i;
+        }
+    }
+
+    /* Delete attachments that aren't needed anymore and remap the indices */
+    std::vector<Int> remap(state.attachments.size(), -1);
+    std::vector<State::Attachment> attachments;
+    for(std::size_t i = 0; i != state.attachments.size(); ++i) {
+        if(!state.attachments[i].used) continue;
+        remap[i] = attachments.size();
+        attachments.push_back(std::move(state.attachments[i]));
+    }
+    state.attachments = std::move(attachments);
+    for(State::Resource& resource: state.resources)
+        if(resource.attachment != -1) resource.attachment = remap[resource.attachment];
+
+    /* Create the framebuffers and decide what to invalidate */
+    state.framebuffers.clear();
+    for(std::size_t i = 0; i != state.passes.size(); ++i) {
+        State::Pass& pass = state.passes[i];
+        pass.invalidateBefore.clear();
+        pass.invalidateAfter.clear();
+
+        Framebuffer framebuffer{pass.viewport};
+        for(const State::Write& write: pass.writes) {
+            const State::Resource& resource = state.resources[write.resource];
+            State::Attachment& attachment = state.attachments[resource.attachment];
+            if(resource.isTexture)
+                framebuffer.attachTexture(write.attachment, attachment.texture, 0);
+            else
+                framebuffer.attachRenderbuffer(write.attachment, attachment.renderbuffer);
+
+            if(resource.firstUse == Int(i))
+                pass.invalidateBefore.push_back(write.attachment);
+            if(resource.lastUse == Int(i))
+                pass.invalidateAfter.push_back(write.attachment);
+        }
+        state.framebuffers.push_back(std::move(framebuffer));
+    }
+
+    state.compiled = true;
+}
+
+void FrameGraph::execute() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.compiled,
+        "GL::FrameGraph::execute(): the graph is not compiled", );
+
+    for(std::size_t i = 0; i != state.passes.size(); ++i) {
+        const State::Pass& pass = state.passes[i];
+        Framebuffer& framebuffer = state.framebuffers[i];
+        framebuffer.bind();
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        for(const Framebuffer::BufferAttachment attachment: pass.invalidateBefore)
+            invalidate(framebuffer, attachment);
+        #endif
+
+        pass.function(framebuffer, pass.state);
+
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        for(const Framebuffer::BufferAttachment attachment: pass.invalidateAfter)
+            invalidate(framebuffer, attachment);
+        #endif
+    }
+}
+
+Texture2D& FrameGraph::texture(const UnsignedInt resource) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.compiled,
+        "GL::FrameGraph::texture(): the graph is not compiled", *static_cast<Texture2D*>(nullptr));
+    CORRADE_ASSERT(resource < state.resources.size(),
+        "GL::FrameGraph::texture(): resource" << resource << "out of range for" << state.resources.size() << "resources", *static_cast<Texture2D*>(nullptr));
+    CORRADE_ASSERT(state.resources[resource].isTexture,
+        "GL::FrameGraph::texture(): resource" << resource << "is a renderbuffer", *static_cast<Texture2D*>(nullptr));
+    CORRADE_ASSERT(state.resources[resource].attachment != -1,
+        "GL::FrameGraph::texture(): resource" << resource << "is not used by any pass", *static_cast<Texture2D*>(nullptr));
+    return state.attachments[state.resources[resource].attachment].texture;
+}
+
+Renderbuffer& FrameGraph::renderbuffer(const UnsignedInt resource) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.compiled,
+        "GL::FrameGraph::renderbuffer(): the graph is not compiled", *static_cast<Renderbuffer*>(nullptr));
+    CORRADE_ASSERT(resource < state.resources.size(),
+        "GL::FrameGraph::renderbuffer(): resource" << resource << "out of range for" << state.resources.size() << "resources", *static_cast<Renderbuffer*>(nullptr));
+    CORRADE_ASSERT(!state.resources[resource].isTexture,
+        "GL::FrameGraph::renderbuffer(): resource" << resource << "is a texture", *static_cast<Renderbuffer*>(nullptr));
+    CORRADE_ASSERT(state.resources[resource].attachment != -1,
+        "GL::FrameGraph::renderbuffer(): resource" << resource << "is not used by any pass", *static_cast<Renderbuffer*>(nullptr));
+    return state.attachments[state.resources[resource].attachment].renderbuffer;
+}
+
+void FrameGraph::clear() {
+    State& state = *_state;
+    state.resources.clear();
+    state.passes.clear();
+    state.framebuffers.clear();
+    state.compiled = false;
+}
+
+}}
@@ -0,0 +1,261 @@
+#ifndef Magnum_GL_FrameGraph_h
+#define Magnum_GL_FrameGraph_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::FrameGraph
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Render pass graph with transient attachment pooling
+@m_since_latest
+
+Post-processing chains usually consist of many passes, each rendering into a
+few attachments that are needed only by the next pass or two. Allocating a
+dedicated texture or renderbuffer for each of them wastes memory and, on tiled
+GPUs, not telling the driver which attachments don't need to be loaded from
+or stored to memory wastes a lot of bandwidth. This class takes a declarative
+description of the passes and their attachments and takes care of both:
+
+-   Transient attachments with non-overlapping lifetimes and the same format
+    and size share the same @ref Texture2D or @ref Renderbuffer
+-   Attachments that get written by a pass for the first time are
+    invalidated before the pass, so their previous contents don't need to be
+    loaded, and attachments that aren't used by any later pass and aren't
+    marked as an output are invalidated after the pass, so they don't need to
+    be stored
+-   The textures and renderbuffers are kept in a pool across @ref clear() and
+    @ref compile() calls, so rebuilding the graph with the same attachments,
+    for example when toggling an effect, doesn't allocate anything new
+
+Attachments are declared with @ref addTexture() for those that are sampled by
+a later pass and @ref addRenderbuffer() for those that are only rendered to.
+A pass is added with @ref addPass() together with a function that records the
+actual rendering, @ref write() then attaches a resource to the pass
+framebuffer and @ref read() declares that the pass samples a texture
+resource. The passes are executed in the order they were added. Resources
+whose contents are needed after the graph is executed, such as the final
+image, have to be marked with @ref setOutput():
+
+@snippet MagnumGL.cpp FrameGraph-usage
+
+The graph is then turned into concrete textures, renderbuffers and
+framebuffers with @ref compile() and each @ref execute() runs all passes.
+The pass function gets the pass framebuffer already bound with the viewport
+set, any textures it reads can be accessed through @ref texture(). If a pass
+writes to more than one color attachment, the pass function is responsible
+for calling @ref Framebuffer::mapForDraw() --- the framebuffer is preserved
+until the next @ref compile(), so doing that just once is enough.
+
+@section GL-FrameGraph-limitations Limitations
+
+Texture resources are created with a single mip level, linear filtering and
+clamp-to-edge wrapping. A pass can't render to the default framebuffer,
+instead the output resource is expected to be sampled or blit to it after
+@ref execute(). Invalidation is not available on WebGL 1.0 and a no-op on
+platforms without @gl_extension{ARB,invalidate_subdata} or
+@gl_extension{EXT,discard_framebuffer}, the graph works there but without
+the bandwidth savings.
+*/
+class MAGNUM_GL_EXPORT FrameGraph {
+    public:
+        /**
+         * @brief Pass function
+         *
+         * Gets the pass framebuffer, already bound, and the state pointer
+         * passed to @ref addPass().
+         */
+        typedef void(*PassFunction)(Framebuffer& framebuffer, void* state);
+
+        /**
+         * @brief Constructor
+         *
+         * Doesn't create any OpenGL objects, those are created on the first
+         * @ref compile().
+         */
+        explicit FrameGraph();
+
+        /** @brief Copying is not allowed */
+        FrameGraph(const FrameGraph&) = delete;
+
+        /** @brief Move constructor */
+        FrameGraph(FrameGraph&&) noexcept;
+
+        ~FrameGraph();
+
+        /** @brief Copying is not allowed */
+        FrameGraph& operator=(const FrameGraph&) = delete;
+
+        /** @brief Move assignment */
+        FrameGraph& operator=(FrameGraph&&) noexcept;
+
+        /** @brief Count of declared resources */
+        UnsignedInt resourceCount() const;
+
+        /** @brief Count of declared passes */
+        UnsignedInt passCount() const;
+
+        /**
+         * @brief Count of pooled attachments
+         *
+         * Count of textures and renderbuffers created by the last
+         * @ref compile(). Because of aliasing, it's usually less than
+         * @ref resourceCount().
+         */
+        std::size_t attachmentCount() const;
+
+        /** @brief Whether the graph is compiled */
+        bool isCompiled() const;
+
+        /**
+         * @brief Add a texture resource
+         * @return Resource ID
+         *
+         * The resource can be both written and read by passes. Expects that
+         * @p size is positive.
+         */
+        UnsignedInt addTexture(TextureFormat format, const Vector2i& size);
+
+        /**
+         * @brief Add a renderbuffer resource
+         * @return Resource ID
+         *
+         * The resource can be only written by passes. Expects that @p size
+         * is positive.
+         */
+        UnsignedInt addRenderbuffer(RenderbufferFormat format, const Vector2i& size);
+
+        /**
+         * @brief Add a pass
+         * @param viewport  Framebuffer viewport
+         * @param function  Function recording the pass
+         * @param state     State passed to @p function
+         * @return Pass ID
+         *
+         * Expects that @p function is not @cpp nullptr @ce.
+         */
+        UnsignedInt addPass(const Range2Di& viewport, PassFunction function, void* state = nullptr);
+
+        /**
+         * @brief Write to a resource in a pass
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches @p resource to @p attachment of the @p pass framebuffer.
+         * If the resource is written for the first time, its previous
+         * contents are discarded, otherwise the contents written by previous
+         * passes are preserved. Expects that both IDs are in range.
+         */
+        FrameGraph& write(UnsignedInt pass, UnsignedInt resource, Framebuffer::BufferAttachment attachment);
+
+        /**
+         * @brief Read a resource in a pass
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that both IDs are in range and that @p resource is a
+         * texture resource. The texture is then available through
+         * @ref texture() in the pass function.
+         */
+        FrameGraph& read(UnsignedInt pass, UnsignedInt resource);
+
+        /**
+         * @brief Mark a resource as an output
+         * @return Reference to self (for method chaining)
+         *
+         * Contents of output resources are preserved after @ref execute()
+         * and output resources aren't aliased with any other resources
+         * written afterwards. Expects that @p resource is in range.
+         */
+        FrameGraph& setOutput(UnsignedInt resource);
+
+        /**
+         * @brief Compile the graph
+         *
+         * Calculates resource lifetimes, assigns pooled textures and
+         * renderbuffers to them, creating new ones if needed and deleting
+         * the ones that are no longer used, and creates a framebuffer for
+         * each pass. Expects that each pass writes at least one resource.
+         * Resources not used by any pass don't get any texture or
+         * renderbuffer assigned.
+         */
+        void compile();
+
+        /**
+         * @brief Execute the graph
+         *
+         * For each pass in order binds its framebuffer, invalidates
+         * attachments written for the first time, calls the pass function
+         * and invalidates attachments not needed anymore. Expects that the
+         * graph is compiled.
+         */
+        void execute();
+
+        /**
+         * @brief Texture assigned to a resource
+         *
+         * Expects that the graph is compiled, @p resource is in range, is a
+         * texture resource and is used by at least one pass. Note that due to
+         * aliasing the same texture can be assigned to other resources as
+         * well.
+         */
+        Texture2D& texture(UnsignedInt resource);
+
+        /**
+         * @brief Renderbuffer assigned to a resource
+         *
+         * Expects that the graph is compiled, @p resource is in range, is a
+         * renderbuffer resource and is used by at least one pass. Note that
+         * due to aliasing the same renderbuffer can be assigned to other
+         * resources as well.
+         */
+        Renderbuffer& renderbuffer(UnsignedInt resource);
+
+        /**
+         * @brief Clear the graph
+         *
+         * Removes all resources and passes. The pooled textures and
+         * renderbuffers are kept for reuse by the next @ref compile(), which
+         * deletes the ones that aren't needed anymore.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
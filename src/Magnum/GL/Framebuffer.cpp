@@ -97,6 +97,26 @@ Int Framebuffer::maxColorAttachments() {
     return value;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Int Framebuffer::maxViews() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::OVR::multiview>())
+        return 0;
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::OVR::multiview2>())
+        return 0;
+    #endif
+
+    GLint& value = Context::current().state().framebuffer->maxViews;
+
+    /* Get the value, if not already cached */
+    if(value == 0)
+        glGetIntegerv(GL_MAX_VIEWS_OVR, &value);
+
+    return value;
+}
+#endif
+
 Framebuffer::Framebuffer(const Range2Di& viewport): AbstractFramebuffer{0, viewport, ObjectFlag::DeleteOnDestruction} {
     CORRADE_INTERNAL_ASSERT(viewport != Implementation::FramebufferState::DisengagedViewport);
     _viewport = viewport;
@@ -293,6 +313,13 @@ Framebuffer& Framebuffer::attachTextureLayer(const BufferAttachment attachment,
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+Framebuffer& Framebuffer::attachTextureMultiview(const BufferAttachment attachment, Texture2DArray& texture, const Int level, const Int baseViewIndex, const Int viewCount) {
+    glFramebufferTextureMultiviewOVR(GLenum(bindInternal()), GLenum(attachment), texture.id(), level, baseViewIndex, viewCount);
+    return *this;
+}
+#endif
+
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
 Framebuffer& Framebuffer::attachLayeredTexture(const BufferAttachment attachment, Texture3D& texture, const Int level) {
     (this->*Context::current().state().framebuffer->textureImplementation)(attachment, texture.id(), level);
@@ -419,6 +446,9 @@ Debug& operator<<(Debug& debug, const Framebuffer::Status value) {
         #ifndef MAGNUM_TARGET_GLES
         _c(IncompleteLayerTargets)
         #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(IncompleteViewTargets)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -334,7 +334,20 @@ class MAGNUM_GL_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractO
              * @requires_gl Geometry shaders are not available in OpenGL ES or
              *      WebGL.
              */
-            IncompleteLayerTargets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS
+            IncompleteLayerTargets = GL_FRAMEBUFFER_INCOMPLETE_LAYER_TARGETS,
+            #endif
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Multiview attachments with a mismatched base view index or view
+             * count. See @ref attachTextureMultiview().
+             * @requires_extension Extension @gl_extension{OVR,multiview}
+             * @requires_es_extension Extension @gl_extension{OVR,multiview}
+             * @requires_webgl_extension Extension
+             *      @webgl_extension{OVR,multiview2}
+             * @m_since_latest
+             */
+            IncompleteViewTargets = GL_FRAMEBUFFER_INCOMPLETE_VIEW_TARGETS_OVR
             #endif
         };
 
@@ -353,6 +366,23 @@ class MAGNUM_GL_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractO
          */
         static Int maxColorAttachments();
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Max supported multiview view count
+         * @m_since_latest
+         *
+         * The result is cached, repeated queries don't result in repeated
+         * OpenGL calls. If neither @gl_extension{OVR,multiview} nor
+         * @webgl_extension{OVR,multiview2} in WebGL is available, returns
+         * `0`.
+         * @see @ref attachTextureMultiview(), @fn_gl{Get} with
+         *      @def_gl_extension{MAX_VIEWS,OVR,multiview}
+         * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Multiview is not available in WebGL 1.0.
+         */
+        static Int maxViews();
+        #endif
+
         /**
          * @brief Wrap existing OpenGL framebuffer object
          * @param id            OpenGL framebuffer ID
@@ -779,6 +809,34 @@ class MAGNUM_GL_EXPORT Framebuffer: public AbstractFramebuffer, public AbstractO
         Framebuffer& attachTextureLayer(BufferAttachment attachment, MultisampleTexture2DArray& texture, Int layer);
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Attach a range of texture layers as multiview to given buffer
+         * @param attachment        Buffer attachment
+         * @param texture           Texture
+         * @param level             Mip level
+         * @param baseViewIndex     First layer of the range
+         * @param viewCount         Number of views, at most
+         *      @ref maxViews()
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Attaches @p viewCount layers starting at @p baseViewIndex, with
+         * each layer rendered to by a single draw with a different value of
+         * @glsl gl_ViewID_OVR @ce. Useful for single-pass stereo rendering,
+         * see for example @ref Shaders::Flat::Flag::Multiview. The
+         * framebuffer is bound before the operation (if not already), as
+         * there's no DSA variant of the entry point.
+         * @see @ref detach(), @fn_gl{BindFramebuffer},
+         *      @fn_gl_extension_keyword{FramebufferTextureMultiview,OVR,multiview}
+         * @requires_extension Extension @gl_extension{OVR,multiview}
+         * @requires_es_extension Extension @gl_extension{OVR,multiview}
+         * @requires_webgl_extension Extension
+         *      @webgl_extension{OVR,multiview2}
+         */
+        Framebuffer& attachTextureMultiview(BufferAttachment attachment, Texture2DArray& texture, Int level, Int baseViewIndex, Int viewCount);
+        #endif
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Attach layered cube map texture to given buffer
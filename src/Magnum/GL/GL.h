@@ -70,7 +70,9 @@ class BufferTexture;
 enum class BufferTextureFormat: GLenum;
 #endif
 
+class CommandList;
 class Context;
+class ContextCapabilityCache;
 
 class CubeMapTexture;
 enum class CubeMapCoordinate: GLenum;
@@ -83,6 +85,7 @@ class CubeMapTextureArray;
 /* DimensionTraits forward declaration is not needed */
 
 class Extension;
+class FrameGraph;
 class Framebuffer;
 
 #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -109,12 +112,17 @@ enum class CompressedPixelFormat: GLenum;
 
 /* ObjectFlag, ObjectFlags are used only in conjunction with *::wrap() function */
 
+class PipelineState;
 #ifndef MAGNUM_TARGET_GLES
 class PipelineStatisticsQuery;
 #endif
 #ifndef MAGNUM_TARGET_GLES2
+class Fence;
 class PrimitiveQuery;
 #endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+class ProgramBinaryCache;
+#endif
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 class SampleQuery;
 #endif
@@ -122,6 +130,9 @@ class TimeQuery;
 
 #ifndef MAGNUM_TARGET_GLES
 class RectangleTexture;
+class RingBuffer;
+class SparseTextureStreamer;
+class TextureResidency;
 #endif
 
 class Renderbuffer;
@@ -160,6 +171,15 @@ typedef TextureArray<2> Texture2DArray;
 
 enum class TextureFormat: GLenum;
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+template<UnsignedInt> class TextureStreamer;
+#ifndef MAGNUM_TARGET_GLES
+typedef TextureStreamer<1> TextureStreamer1D;
+#endif
+typedef TextureStreamer<2> TextureStreamer2D;
+typedef TextureStreamer<3> TextureStreamer3D;
+#endif
+
 #ifndef MAGNUM_TARGET_GLES2
 class TransformFeedback;
 #endif
@@ -48,9 +48,12 @@ const Buffer::TargetHint BufferState::targetForIndex[] = {
     Buffer::TargetHint::DispatchIndirect,
     Buffer::TargetHint::DrawIndirect,
     Buffer::TargetHint::ShaderStorage,
-    Buffer::TargetHint::Texture
+    Buffer::TargetHint::Texture,
     #endif
     #endif
+    #ifndef MAGNUM_TARGET_GLES
+    Buffer::TargetHint::Parameter
+    #endif
 };
 
 std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
@@ -72,6 +75,9 @@ std::size_t BufferState::indexForTarget(Buffer::TargetHint target) {
         case Buffer::TargetHint::Texture:           return 13;
         #endif
         #endif
+        #ifndef MAGNUM_TARGET_GLES
+        case Buffer::TargetHint::Parameter:         return 14;
+        #endif
     }
 
     CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -202,6 +208,36 @@ BufferState::BufferState(Context& context, std::vector<std::string>& extensions)
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void BufferState::flushDeferredUniformBindings() {
+    UnsignedInt i = deferredUniformBindingsBegin;
+    while(i < deferredUniformBindingsEnd) {
+        if(!std::get<0>(deferredUniformBindings[i])) {
+            ++i;
+            continue;
+        }
+
+        /* Whole-buffer and range bindings need a different call */
+        const bool whole = !std::get<2>(deferredUniformBindings[i]);
+        UnsignedInt end = i + 1;
+        while(end < deferredUniformBindingsEnd && std::get<0>(deferredUniformBindings[end]) && !std::get<2>(deferredUniformBindings[end]) == whole) ++end;
+
+        if(whole) {
+            /** @todo VLAs */
+            Containers::Array<Buffer*> buffers{Containers::NoInit, end - i};
+            for(UnsignedInt j = 0; j != buffers.size(); ++j)
+                buffers[j] = std::get<0>(deferredUniformBindings[i + j]);
+            bindBasesImplementation(Buffer::Target::Uniform, i, buffers);
+        } else bindRangesImplementation(Buffer::Target::Uniform, i, deferredUniformBindings.slice(i, end));
+
+        i = end;
+    }
+
+    std::fill(deferredUniformBindings.begin() + deferredUniformBindingsBegin, deferredUniformBindings.begin() + deferredUniformBindingsEnd, std::tuple<Buffer*, GLintptr, GLsizeiptr>{});
+    deferredUniformBindingsBegin = deferredUniformBindingsEnd = 0;
+}
+#endif
+
 void BufferState::reset() {
     /* libc++ complains about decrementing enum value otherwise */
     std::fill_n(bindings, std::size_t{TargetCount}, State::DisengagedBinding);
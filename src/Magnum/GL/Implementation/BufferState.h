@@ -26,6 +26,10 @@
 */
 
 #include <vector>
+#ifndef MAGNUM_TARGET_GLES2
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#endif
 
 #include "Magnum/GL/Buffer.h"
 
@@ -33,7 +37,9 @@ namespace Magnum { namespace GL { namespace Implementation {
 
 struct BufferState {
     enum: std::size_t {
-        #ifndef MAGNUM_TARGET_WEBGL
+        #ifndef MAGNUM_TARGET_GLES
+        TargetCount = 14+1
+        #elif !defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 13+1
         #elif !defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL)
         TargetCount = 8+1
@@ -50,6 +56,13 @@ struct BufferState {
 
     void reset();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Binds everything in deferredUniformBindings, each run of consecutive
+       whole-buffer or range bindings with a single bindBasesImplementation()
+       or bindRangesImplementation() call */
+    void flushDeferredUniformBindings();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES2
     void(*bindBasesImplementation)(Buffer::Target, UnsignedInt, Containers::ArrayView<Buffer* const>);
     void(*bindRangesImplementation)(Buffer::Target, UnsignedInt, Containers::ArrayView<const std::tuple<Buffer*, GLintptr, GLsizeiptr>>);
@@ -78,6 +91,16 @@ struct BufferState {
     /* Currently bound buffer for all targets */
     GLuint bindings[TargetCount];
 
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Uniform buffer bindings to issue right before the next draw if deferred
+       binding is enabled, the buffer is null for binding points that have
+       nothing to bind and the size is zero for binding the whole buffer.
+       Everything non-null is in the [deferredUniformBindingsBegin,
+       deferredUniformBindingsEnd) range. Allocated on first use. */
+    Containers::Array<std::tuple<Buffer*, GLintptr, GLsizeiptr>> deferredUniformBindings;
+    UnsignedInt deferredUniformBindingsBegin{}, deferredUniformBindingsEnd{};
+    #endif
+
     /* Limits */
     #ifndef MAGNUM_TARGET_GLES2
     GLint
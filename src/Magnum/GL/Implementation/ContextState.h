@@ -29,13 +29,11 @@
 #include <vector>
 
 #include "Magnum/GL/GL.h"
-
-#ifdef _MSC_VER
-/* Otherwise the member function pointers will have different size based on
-   whether the header was included or not. CAUSES SERIOUS MEMORY CORRUPTION AND
-   IS NOT CAUGHT BY ANY WARNING WHATSOEVER! AARGH! */
+/* Needed for Context::StateStatistics, and on MSVC also so the member
+   function pointers don't have different size based on whether the header
+   was included or not. CAUSES SERIOUS MEMORY CORRUPTION AND IS NOT CAUGHT BY
+   ANY WARNING WHATSOEVER! AARGH! */
 #include "Magnum/GL/Context.h"
-#endif
 
 namespace Magnum { namespace GL { namespace Implementation {
 
@@ -51,6 +49,16 @@ struct ContextState {
 
     bool (Context::*isCoreProfileImplementation)();
     #endif
+
+    /* Whether texture and uniform buffer bindings are recorded and issued
+       only right before a draw */
+    bool deferredBinding{};
+
+    Context::StateStatistics statistics{};
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    ProgramBinaryCache* programBinaryCache{};
+    #endif
 };
 
 }}}
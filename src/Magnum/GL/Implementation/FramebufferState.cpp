@@ -39,6 +39,9 @@ FramebufferState::FramebufferState(Context& context, std::vector<std::string>& e
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     maxSamples{0},
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    maxViews{0},
+    #endif
     #ifndef MAGNUM_TARGET_GLES
     maxDualSourceDrawBuffers{0},
     #endif
@@ -114,6 +114,9 @@ struct FramebufferState {
     #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
     GLint maxSamples;
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    GLint maxViews;
+    #endif
     #ifndef MAGNUM_TARGET_GLES
     GLint maxDualSourceDrawBuffers;
     #endif
@@ -116,7 +116,19 @@ MeshState::MeshState(Context& context, ContextState& contextState, std::vector<s
         multiDrawImplementation = &MeshView::multiDrawImplementationDefault;
     } else multiDrawImplementation = &MeshView::multiDrawImplementationFallback;
     #else
-    multiDrawImplementation = &MeshView::multiDrawImplementationFallback;
+    /* Multi draw implementation on WebGL */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(context.isExtensionSupported<Extensions::WEBGL::multi_draw_instanced_base_vertex_base_instance>()) {
+        extensions.push_back(Extensions::WEBGL::multi_draw_instanced_base_vertex_base_instance::string());
+
+        multiDrawImplementation = &MeshView::multiDrawImplementationWEBGLBaseVertexBaseInstance;
+    } else
+    #endif
+    if(context.isExtensionSupported<Extensions::WEBGL::multi_draw>()) {
+        extensions.push_back(Extensions::WEBGL::multi_draw::string());
+
+        multiDrawImplementation = &MeshView::multiDrawImplementationWEBGL;
+    } else multiDrawImplementation = &MeshView::multiDrawImplementationFallback;
     #endif
     #endif
 
@@ -216,6 +228,25 @@ MeshState::~MeshState() {
 
 void MeshState::reset() {
     currentVAO = State::DisengagedBinding;
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    /* Mark all attributes as possibly enabled and with unknown layout so
+       they get either respecified or disabled on next draw */
+    for(VertexAttribute& attribute: vertexAttributes) {
+        attribute.buffer = State::DisengagedBinding;
+        attribute.enabled = true;
+    }
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+void MeshState::disableVertexAttributes() {
+    for(std::size_t i = 0; i != vertexAttributes.size(); ++i) {
+        if(!vertexAttributes[i].enabled) continue;
+        glDisableVertexAttribArray(i);
+        vertexAttributes[i].enabled = false;
+    }
 }
+#endif
 
 }}}
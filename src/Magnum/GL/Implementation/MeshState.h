@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <string>
+#include <Corrade/Containers/Array.h>
 
 #include "Magnum/GL/Mesh.h"
 
@@ -72,6 +73,31 @@ struct MeshState {
     #endif
 
     GLuint currentVAO;
+
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    /* Shadow copy of the vertex attribute state for the non-VAO code path,
+       so only attributes that differ from what the previous draw set up get
+       respecified. Lazily sized to AbstractShaderProgram::maxVertexAttributes()
+       on the first draw, an entry with buffer set to
+       State::DisengagedBinding is in an unknown state. */
+    struct VertexAttribute {
+        GLuint buffer;
+        GLint size;
+        GLenum type;
+        DynamicAttribute::Kind kind;
+        GLintptr offset;
+        GLsizei stride;
+        bool enabled;
+        /* Temporary, used for finding attributes not used by a mesh */
+        bool used;
+    };
+    Containers::Array<VertexAttribute> vertexAttributes;
+
+    /* Disables all vertex attributes enabled by the non-VAO code path. Used
+       by Context::resetState() to not leak them to external GL code. */
+    void disableVertexAttributes();
+    #endif
+
     #if !defined(MAGNUM_TARGET_WEBGL) && !defined(MAGNUM_TARGET_GLES2)
     GLint maxVertexAttributeStride{};
     #endif
@@ -184,6 +184,35 @@ RendererState::RendererState(Context& context, ContextState& contextState, std::
     #endif
 }
 
+UnsignedInt RendererState::pipelineStateFeature(const Renderer::Feature feature) {
+    switch(feature) {
+        case Renderer::Feature::Blending:
+            return PipelineStateBlending;
+        case Renderer::Feature::DepthTest:
+            return PipelineStateDepthTest;
+        case Renderer::Feature::StencilTest:
+            return PipelineStateStencilTest;
+        case Renderer::Feature::FaceCulling:
+            return PipelineStateFaceCulling;
+        case Renderer::Feature::PolygonOffsetFill:
+            return PipelineStatePolygonOffsetFill;
+        default: return 0;
+    }
+}
+
+UnsignedInt RendererState::pipelineStateFacing(const Renderer::PolygonFacing facing, const UnsignedInt front) {
+    switch(facing) {
+        case Renderer::PolygonFacing::Front:
+            return front;
+        case Renderer::PolygonFacing::Back:
+            return front << 1;
+        case Renderer::PolygonFacing::FrontAndBack:
+            return front|(front << 1);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
 RendererState::PixelStorage::PixelStorage():
     alignment{4}
     #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
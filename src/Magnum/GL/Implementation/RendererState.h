@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 
+#include "Magnum/GL/PipelineState.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/Math/Range.h"
 
@@ -100,6 +101,39 @@ struct RendererState {
     GLint maxCullDistances{}, maxCombinedClipAndCullDistances{};
     #endif
 
+    /* State last applied through PipelineState::apply(). State for which
+       the bit in pipelineStateKnown isn't set may not match GL, either
+       because it was never applied or because it was changed through
+       Renderer or Context::resetState(). Back face bits are front face bits
+       shifted by one. */
+    enum: UnsignedInt {
+        PipelineStateBlending = 1 << 0,
+        PipelineStateDepthTest = 1 << 1,
+        PipelineStateStencilTest = 1 << 2,
+        PipelineStateFaceCulling = 1 << 3,
+        PipelineStatePolygonOffsetFill = 1 << 4,
+        PipelineStateBlendEquation = 1 << 5,
+        PipelineStateBlendFunction = 1 << 6,
+        PipelineStateDepthFunction = 1 << 7,
+        PipelineStateDepthMask = 1 << 8,
+        PipelineStateStencilFunctionFront = 1 << 9,
+        PipelineStateStencilFunctionBack = 1 << 10,
+        PipelineStateStencilOperationFront = 1 << 11,
+        PipelineStateStencilOperationBack = 1 << 12,
+        PipelineStateStencilMaskFront = 1 << 13,
+        PipelineStateStencilMaskBack = 1 << 14,
+        PipelineStateFaceCullingMode = 1 << 15,
+        PipelineStateFrontFace = 1 << 16,
+        PipelineStatePolygonOffset = 1 << 17,
+        PipelineStateColorMask = 1 << 18
+    };
+    PipelineState pipelineState;
+    UnsignedInt pipelineStateKnown{};
+
+    /* Used by the Renderer setters to mark state as unknown */
+    static UnsignedInt pipelineStateFeature(Renderer::Feature feature);
+    static UnsignedInt pipelineStateFacing(Renderer::PolygonFacing facing, UnsignedInt front);
+
     /* Bool parameter is ugly, but this is implementation detail of internal
        API so who cares */
     void applyPixelStorageInternal(const Magnum::PixelStorage& storage, bool unpack);
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "ResourceState.h"
+
+#include <algorithm>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+void ResourceState::created(const Context::ResourceType type, const GLuint id) {
+    if(!enabled || !id) return;
+
+    /* The ID could be reused by the driver for an object that was released
+       and never destroyed through us, drop whatever was recorded for it */
+    destroyed(type, id);
+    resources.emplace(key(type, id), Resource{type, 0, {}, {}});
+    ++count[std::size_t(type)];
+}
+
+void ResourceState::destroyed(const Context::ResourceType type, const GLuint id) {
+    if(!enabled || !id) return;
+
+    const auto found = resources.find(key(type, id));
+    if(found == resources.end()) return;
+
+    std::size_t size = found->second.storage;
+    for(const auto& image: found->second.images) size += image.second;
+    memory[std::size_t(type)] -= size;
+    --count[std::size_t(type)];
+    resources.erase(found);
+}
+
+void ResourceState::storage(const Context::ResourceType type, const GLuint id, const std::size_t size) {
+    if(!enabled) return;
+
+    const auto found = resources.find(key(type, id));
+    if(found == resources.end()) return;
+
+    Resource& resource = found->second;
+    std::size_t& total = memory[std::size_t(type)];
+    total -= resource.storage;
+    for(const auto& image: resource.images) total -= image.second;
+    resource.images.clear();
+    resource.storage = size;
+    total += size;
+}
+
+void ResourceState::image(const GLuint id, const GLenum target, const GLint level, const std::size_t size) {
+    if(!enabled) return;
+
+    const auto found = resources.find(key(Context::ResourceType::Texture, id));
+    if(found == resources.end()) return;
+
+    std::size_t& total = memory[std::size_t(Context::ResourceType::Texture)];
+    const std::pair<GLenum, GLint> image{target, level};
+    for(auto& i: found->second.images) if(i.first == image) {
+        total -= i.second;
+        total += (i.second = size);
+        return;
+    }
+
+    found->second.images.emplace_back(image, size);
+    total += size;
+}
+
+void ResourceState::label(const Context::ResourceType type, const GLuint id, const Containers::ArrayView<const char> label) {
+    if(!enabled) return;
+
+    const auto found = resources.find(key(type, id));
+    if(found == resources.end()) return;
+
+    found->second.label.assign(label.data(), label.size());
+}
+
+void ResourceState::clear() {
+    resources.clear();
+    std::fill_n(count, TypeCount, 0);
+    std::fill_n(memory, TypeCount, 0);
+}
+
+namespace {
+
+#ifndef DOXYGEN_GENERATING_OUTPUT /* It gets *really* confused */
+/* Inverse of the generic-to-GL format mapping, i.e. which pixel format and
+   type corresponds to a texture format. Entries without a texture format are
+   stored as zero and never match. */
+constexpr struct {
+    TextureFormat textureFormat;
+    PixelFormat format;
+    PixelType type;
+} FormatMapping[] {
+    #define _c(input, format, type, textureFormat) {TextureFormat::textureFormat, PixelFormat::format, PixelType::type},
+    #define _n(input, format, type) {TextureFormat{}, PixelFormat::format, PixelType::type},
+    #define _s(input) {TextureFormat{}, PixelFormat{}, PixelType{}},
+    #include "Magnum/GL/Implementation/pixelFormatMapping.hpp"
+    #undef _s
+    #undef _n
+    #undef _c
+};
+
+/* Enum values are the same between CompressedPixelFormat and TextureFormat,
+   the index + 1 is the generic format */
+constexpr CompressedPixelFormat CompressedFormatMapping[] {
+    #define _c(input, format) CompressedPixelFormat::format,
+    #define _s(input) CompressedPixelFormat{},
+    #include "Magnum/GL/Implementation/compressedPixelFormatMapping.hpp"
+    #undef _s
+    #undef _c
+};
+#endif
+
+}
+
+std::size_t textureImageMemory(const TextureFormat format, const Vector3i& size) {
+    const std::size_t pixelCount = std::size_t(size.product());
+
+    for(const auto& mapping: FormatMapping)
+        if(GLenum(mapping.textureFormat) && mapping.textureFormat == format)
+            return pixelCount*pixelSize(mapping.format, mapping.type);
+
+    for(std::size_t i = 0; i != Containers::arraySize(CompressedFormatMapping); ++i) {
+        if(!GLenum(CompressedFormatMapping[i]) || GLenum(CompressedFormatMapping[i]) != GLenum(format)) continue;
+
+        const Magnum::CompressedPixelFormat generic = Magnum::CompressedPixelFormat(i + 1);
+        const Vector3i blockSize = compressedBlockSize(generic);
+        const Vector3i blockCount = (size + blockSize - Vector3i{1})/blockSize;
+        return std::size_t(blockCount.product())*compressedBlockDataSize(generic);
+    }
+
+    /* Packed, unsized or otherwise unknown format, assume four bytes */
+    return pixelCount*4;
+}
+
+std::size_t textureStorageMemory(const GLsizei levels, const TextureFormat format, const Vector3i& size, const bool layered) {
+    std::size_t memory = 0;
+    for(GLsizei level = 0; level != levels; ++level) {
+        Vector3i levelSize = Math::max(size >> level, Vector3i{1});
+        if(layered) levelSize.z() = size.z();
+        memory += textureImageMemory(format, levelSize);
+    }
+    return memory;
+}
+
+}}}
@@ -0,0 +1,87 @@
+#ifndef Magnum_GL_Implementation_ResourceState_h
+#define Magnum_GL_Implementation_ResourceState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/GL/Context.h"
+
+namespace Magnum { namespace GL { namespace Implementation {
+
+/* Bookkeeping for Context::setResourceTracking(). All hooks are no-ops unless
+   the tracking is enabled, so the only overhead in the default case is a
+   single branch. */
+struct ResourceState {
+    enum: std::size_t { TypeCount = std::size_t(Context::ResourceType::Mesh) + 1 };
+
+    struct Resource {
+        Context::ResourceType type;
+        /* Memory allocated by setData() / setStorage() */
+        std::size_t storage;
+        /* Memory allocated by per-level setImage(), keyed by the image target
+           and level */
+        std::vector<std::pair<std::pair<GLenum, GLint>, std::size_t>> images;
+        std::string label;
+    };
+
+    static UnsignedLong key(Context::ResourceType type, GLuint id) {
+        return UnsignedLong(type) << 32 | id;
+    }
+
+    void created(Context::ResourceType type, GLuint id);
+    void destroyed(Context::ResourceType type, GLuint id);
+    /* Replaces all memory recorded for the resource */
+    void storage(Context::ResourceType type, GLuint id, std::size_t size);
+    /* Replaces memory recorded for a single texture image */
+    void image(GLuint id, GLenum target, GLint level, std::size_t size);
+    void label(Context::ResourceType type, GLuint id, Containers::ArrayView<const char> label);
+
+    void clear();
+
+    bool enabled{};
+    std::unordered_map<UnsignedLong, Resource> resources;
+    std::size_t count[TypeCount]{};
+    std::size_t memory[TypeCount]{};
+};
+
+/* Estimated size of a single texture or renderbuffer image with given format,
+   in bytes. Uncompressed formats known to the generic pixel format mapping
+   use their exact pixel size, compressed formats their block size, anything
+   else is assumed to have four bytes per pixel. */
+std::size_t textureImageMemory(TextureFormat format, const Vector3i& size);
+
+/* Estimated size of a whole mip chain with given level count. If `layered`
+   is set, the Z dimension is a layer (or cube map face) count that doesn't
+   get halved with each level. */
+std::size_t textureStorageMemory(GLsizei levels, TextureFormat format, const Vector3i& size, bool layered);
+
+}}}
+
+#endif
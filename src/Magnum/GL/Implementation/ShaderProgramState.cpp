@@ -33,6 +33,20 @@
 
 namespace Magnum { namespace GL { namespace Implementation {
 
+namespace {
+
+/* Without KHR_parallel_shader_compile there's no way to query the status
+   without blocking, so the linking is always reported as finished */
+void
+#ifdef CORRADE_TARGET_WINDOWS
+APIENTRY
+#endif
+completionStatusImplementationFallback(GLuint, GLenum, GLint* value) {
+    *value = GL_TRUE;
+}
+
+}
+
 ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string>& extensions): current(0), maxVertexAttributes(0)
         #ifndef MAGNUM_TARGET_GLES2
         #ifndef MAGNUM_TARGET_WEBGL
@@ -191,8 +205,13 @@ ShaderProgramState::ShaderProgramState(Context& context, std::vector<std::string
         #endif
     }
 
+    /* The extension is already added to the list by ShaderState */
+    if(context.isExtensionSupported<Extensions::KHR::parallel_shader_compile>())
+        completionStatusImplementation = glGetProgramiv;
+    else
+        completionStatusImplementation = completionStatusImplementationFallback;
+
     #ifdef MAGNUM_TARGET_WEBGL
-    static_cast<void>(context);
     static_cast<void>(extensions);
     #endif
 }
@@ -39,6 +39,7 @@
 #include "Magnum/GL/Implementation/MeshState.h"
 #include "Magnum/GL/Implementation/QueryState.h"
 #include "Magnum/GL/Implementation/RendererState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 #include "Magnum/GL/Implementation/ShaderState.h"
 #include "Magnum/GL/Implementation/ShaderProgramState.h"
 #include "Magnum/GL/Implementation/TextureState.h"
@@ -67,6 +68,7 @@ State::State(Context& context, std::ostream* const out) {
     mesh.reset(new MeshState{context, *this->context, extensions});
     query.reset(new QueryState{context, extensions});
     renderer.reset(new RendererState{context, *this->context, extensions});
+    resource.reset(new ResourceState);
     shader.reset(new ShaderState(context, extensions));
     shaderProgram.reset(new ShaderProgramState{context, extensions});
     texture.reset(new TextureState{context, extensions});
@@ -84,4 +86,19 @@ State::State(Context& context, std::ostream* const out) {
 
 State::~State() = default;
 
+void State::flushDeferredBindings() {
+    /* Disabling the deferred binding for the duration of the flush, so the
+       multi-bind fallback implementations bind directly instead of recording
+       the bindings again */
+    const bool deferredBinding = context->deferredBinding;
+    context->deferredBinding = false;
+
+    texture->flushDeferredBindings();
+    #ifndef MAGNUM_TARGET_GLES2
+    buffer->flushDeferredUniformBindings();
+    #endif
+
+    context->deferredBinding = deferredBinding;
+}
+
 }}}
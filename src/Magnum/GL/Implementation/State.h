@@ -41,6 +41,7 @@ struct FramebufferState;
 struct MeshState;
 struct QueryState;
 struct RendererState;
+struct ResourceState;
 struct ShaderState;
 struct ShaderProgramState;
 struct TextureState;
@@ -54,6 +55,10 @@ struct State {
 
     ~State();
 
+    /* Issues texture and uniform buffer bindings recorded while deferred
+       binding is enabled */
+    void flushDeferredBindings();
+
     enum: GLuint { DisengagedBinding = ~0u };
 
     Containers::Pointer<BufferState> buffer;
@@ -65,6 +70,7 @@ struct State {
     Containers::Pointer<MeshState> mesh;
     Containers::Pointer<QueryState> query;
     Containers::Pointer<RendererState> renderer;
+    Containers::Pointer<ResourceState> resource;
     Containers::Pointer<ShaderState> shader;
     Containers::Pointer<ShaderProgramState> shaderProgram;
     Containers::Pointer<TextureState> texture;
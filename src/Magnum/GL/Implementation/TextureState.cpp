@@ -489,6 +489,7 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &maxTextureUnits);
     CORRADE_INTERNAL_ASSERT(maxTextureUnits > 0);
     bindings = Containers::Array<std::pair<GLenum, GLuint>>{Containers::ValueInit, std::size_t(maxTextureUnits)};
+    deferredBindings = Containers::Array<AbstractTexture*>{Containers::ValueInit, std::size_t(maxTextureUnits)};
 
     #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
     if(!context.isDriverWorkaroundDisabled("apple-buffer-texture-unbind-on-buffer-modify")) {
@@ -522,6 +523,24 @@ TextureState::TextureState(Context& context, std::vector<std::string>& extension
 
 TextureState::~TextureState() = default;
 
+void TextureState::flushDeferredBindings() {
+    Int i = deferredBindingsBegin;
+    while(i < deferredBindingsEnd) {
+        if(!deferredBindings[i]) {
+            ++i;
+            continue;
+        }
+
+        Int end = i + 1;
+        while(end < deferredBindingsEnd && deferredBindings[end]) ++end;
+        bindMultiImplementation(i, deferredBindings.slice(i, end));
+        i = end;
+    }
+
+    std::fill(deferredBindings.begin() + deferredBindingsBegin, deferredBindings.begin() + deferredBindingsEnd, nullptr);
+    deferredBindingsBegin = deferredBindingsEnd = 0;
+}
+
 void TextureState::reset() {
     std::fill_n(bindings.begin(), bindings.size(), std::pair<GLenum, GLuint>{{}, State::DisengagedBinding});
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
@@ -58,6 +58,10 @@ struct TextureState {
 
     void reset();
 
+    /* Binds everything in deferredBindings, each run of consecutive units
+       with a single bindMultiImplementation() call */
+    void flushDeferredBindings();
+
     Int(*compressedBlockDataSizeImplementation)(GLenum, TextureFormat);
     void(*unbindImplementation)(GLint);
     void(*bindMultiImplementation)(GLint, Containers::ArrayView<AbstractTexture* const>);
@@ -158,6 +162,11 @@ struct TextureState {
     #endif
 
     Containers::Array<std::pair<GLenum, GLuint>> bindings;
+    /* Textures to bind right before the next draw if deferred binding is
+       enabled, null for units that have nothing to bind. Everything non-null
+       is in the [deferredBindingsBegin, deferredBindingsEnd) range. */
+    Containers::Array<AbstractTexture*> deferredBindings;
+    Int deferredBindingsBegin{}, deferredBindingsEnd{};
     #if defined(CORRADE_TARGET_APPLE) && !defined(MAGNUM_TARGET_GLES)
     Math::BoolVector<80> bufferTextureBound;
     #endif
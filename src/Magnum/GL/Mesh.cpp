@@ -36,10 +36,12 @@
 #include "Magnum/GL/TransformFeedback.h"
 #endif
 #include "Magnum/GL/Implementation/BufferState.h"
+#include "Magnum/GL/Implementation/ContextState.h"
 #ifndef MAGNUM_TARGET_WEBGL
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
 #include "Magnum/GL/Implementation/MeshState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 #include "Magnum/GL/Implementation/State.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -246,6 +248,8 @@ Int Mesh::maxElementsVertices() {
 
 Mesh::Mesh(const MeshPrimitive primitive): _primitive{primitive}, _flags{ObjectFlag::DeleteOnDestruction} {
     (this->*Context::current().state().mesh->createImplementation)(true);
+    /* Without VAOs the ID is zero and the mesh is not tracked */
+    Context::current().state().resource->created(Context::ResourceType::Mesh, _id);
 }
 
 Mesh::Mesh(NoCreateT) noexcept: _id{0}, _primitive{MeshPrimitive::Triangles}, _flags{ObjectFlag::DeleteOnDestruction} {}
@@ -258,6 +262,8 @@ Mesh::~Mesh() {
         /* Remove current vao from the state */
         GLuint& current = Context::current().state().mesh->currentVAO;
         if(current == _id) current = 0;
+
+        Context::current().state().resource->destroyed(Context::ResourceType::Mesh, _id);
     }
 
     if(_constructed) (this->*Context::current().state().mesh->destroyImplementation)(deleteObject);
@@ -336,6 +342,7 @@ Mesh& Mesh::setLabelInternal(const Containers::ArrayView<const char> label) {
     #else
     Context::current().state().debug->labelImplementation(GL_VERTEX_ARRAY_KHR, _id, label);
     #endif
+    Context::current().state().resource->label(Context::ResourceType::Mesh, _id, label);
     return *this;
 }
 #endif
@@ -541,6 +548,65 @@ void Mesh::drawInternal(TransformFeedback& xfb, const UnsignedInt stream, const
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void Mesh::drawIndirectInternal(Buffer& buffer, const GLintptr offset, const UnsignedInt drawCount, const UnsignedInt stride) {
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    (this->*state.bindImplementation)();
+
+    /* The indirect buffer binding is not part of the VAO state, so it's fine
+       to bind it after */
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+
+    /* Single draw */
+    if(drawCount == 1) {
+        /* Non-indexed mesh */
+        if(!_indexBuffer.id())
+            glDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset));
+
+        /* Indexed mesh */
+        else glDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset));
+
+    /* Multi draw */
+    } else {
+        #ifndef MAGNUM_TARGET_GLES
+        /* Non-indexed mesh */
+        if(!_indexBuffer.id())
+            glMultiDrawArraysIndirect(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+
+        /* Indexed mesh */
+        else glMultiDrawElementsIndirect(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), drawCount, stride);
+        #else
+        static_cast<void>(stride);
+        CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        #endif
+    }
+
+    (this->*state.unbindImplementation)();
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void Mesh::drawIndirectInternal(Buffer& buffer, const GLintptr offset, Buffer& countBuffer, const GLintptr countOffset, const UnsignedInt maxDrawCount, const UnsignedInt stride) {
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    (this->*state.bindImplementation)();
+
+    /* Neither of these bindings is part of the VAO state */
+    buffer.bindInternal(Buffer::TargetHint::DrawIndirect);
+    countBuffer.bindInternal(Buffer::TargetHint::Parameter);
+
+    /* Non-indexed mesh */
+    if(!_indexBuffer.id())
+        glMultiDrawArraysIndirectCount(GLenum(_primitive), reinterpret_cast<GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    /* Indexed mesh */
+    else glMultiDrawElementsIndirectCount(GLenum(_primitive), GLenum(_indexType), reinterpret_cast<GLvoid*>(offset), countOffset, maxDrawCount, stride);
+
+    (this->*state.unbindImplementation)();
+}
+#endif
+#endif
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 Mesh& Mesh::draw(AbstractShaderProgram& shader) {
     shader.draw(*this);
@@ -577,11 +643,14 @@ void Mesh::bindVAOImplementationVAO(const GLuint id) {
 }
 
 void Mesh::bindVAO() {
-    GLuint& current = Context::current().state().mesh->currentVAO;
+    Implementation::State& state = Context::current().state();
+    Context::StateStatistics::Counter& statistics = state.context->statistics.meshBindings;
+    GLuint& current = state.mesh->currentVAO;
     if(current != _id) {
         /* Binding the VAO finally creates it */
         _flags |= ObjectFlag::Created;
         bindVAOImplementationVAO(_id);
+        ++statistics.issued;
 
         /* Reset element buffer binding, because binding a different VAO with a
            different index buffer will change that binding as well. (GL state,
@@ -590,8 +659,8 @@ void Mesh::bindVAO() {
            particular, the setIndexBuffer() buffers call this function *and
            then* sets the _indexBuffer, which means at this point the ID will
            be still 0. */
-        Context::current().state().buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = _indexBuffer.id();
-    }
+        state.buffer->bindings[Implementation::BufferState::indexForTarget(Buffer::TargetHint::ElementArray)] = _indexBuffer.id();
+    } else ++statistics.elided;
 }
 
 void Mesh::createImplementationDefault(bool) {
@@ -760,6 +829,11 @@ void Mesh::attributePointerImplementationVAODSAIntelWindows(AttributeLayout&& at
 
 void Mesh::vertexAttribPointer(AttributeLayout& attribute) {
     glEnableVertexAttribArray(attribute.location);
+    vertexAttribPointerNoEnable(attribute);
+    if(attribute.divisor) vertexAttribDivisor(attribute.location, attribute.divisor);
+}
+
+void Mesh::vertexAttribPointerNoEnable(AttributeLayout& attribute) {
     attribute.buffer.bindInternal(Buffer::TargetHint::Array);
 
     #ifndef MAGNUM_TARGET_GLES2
@@ -774,14 +848,14 @@ void Mesh::vertexAttribPointer(AttributeLayout& attribute) {
     {
         glVertexAttribPointer(attribute.location, attribute.size, attribute.type, attribute.kind == DynamicAttribute::Kind::GenericNormalized, attribute.stride, reinterpret_cast<const GLvoid*>(attribute.offset));
     }
+}
 
-    if(attribute.divisor) {
-        #ifndef MAGNUM_TARGET_GLES2
-        glVertexAttribDivisor(attribute.location, attribute.divisor);
-        #else
-        (this->*Context::current().state().mesh->vertexAttribDivisorImplementation)(attribute.location, attribute.divisor);
-        #endif
-    }
+void Mesh::vertexAttribDivisor(const GLuint location, const GLuint divisor) {
+    #ifndef MAGNUM_TARGET_GLES2
+    glVertexAttribDivisor(location, divisor);
+    #else
+    (this->*Context::current().state().mesh->vertexAttribDivisorImplementation)(location, divisor);
+    #endif
 }
 
 #ifndef MAGNUM_TARGET_GLES
@@ -842,9 +916,59 @@ void Mesh::bindIndexBufferImplementationVAODSA(Buffer& buffer) {
 #endif
 
 void Mesh::bindImplementationDefault() {
-    /* Specify vertex attributes */
-    for(AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes))
-        vertexAttribPointer(attribute);
+    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+    Implementation::MeshState& state = *Context::current().state().mesh;
+
+    /* First draw, nothing is known about the attribute state */
+    if(state.vertexAttributes.empty())
+        state.vertexAttributes = Containers::Array<Implementation::MeshState::VertexAttribute>{Containers::DirectInit, std::size_t(AbstractShaderProgram::maxVertexAttributes()), Implementation::MeshState::VertexAttribute{Implementation::State::DisengagedBinding, 0, 0, DynamicAttribute::Kind::Generic, 0, 0, true, false}};
+
+    /* Specify vertex attributes, skipping those that are already set up the
+       same by a previous draw */
+    for(AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes)) {
+        Implementation::MeshState::VertexAttribute& current = state.vertexAttributes[attribute.location];
+        const bool unknown = current.buffer == Implementation::State::DisengagedBinding;
+        current.used = true;
+
+        if(!current.enabled || unknown) {
+            glEnableVertexAttribArray(attribute.location);
+            current.enabled = true;
+        }
+
+        if(current.buffer != attribute.buffer.id() ||
+           current.size != attribute.size ||
+           current.type != attribute.type ||
+           current.kind != attribute.kind ||
+           current.offset != attribute.offset ||
+           current.stride != attribute.stride)
+        {
+            vertexAttribPointerNoEnable(attribute);
+            current.buffer = attribute.buffer.id();
+            current.size = attribute.size;
+            current.type = attribute.type;
+            current.kind = attribute.kind;
+            current.offset = attribute.offset;
+            current.stride = attribute.stride;
+        }
+
+        /* Divisors are reset back to zero in unbindImplementationDefault() */
+        if(attribute.divisor) vertexAttribDivisor(attribute.location, attribute.divisor);
+    }
+
+    /* Disable attributes enabled by previous draws but not used by this
+       mesh, as they could point to buffers too small for this draw */
+    for(std::size_t i = 0; i != state.vertexAttributes.size(); ++i) {
+        Implementation::MeshState::VertexAttribute& current = state.vertexAttributes[i];
+        if(current.enabled && !current.used) {
+            glDisableVertexAttribArray(i);
+            current.enabled = false;
+        }
+        current.used = false;
+    }
+    #else
+    /* ES3 and WebGL 2 always have VAOs */
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    #endif
 
     /* Bind index buffer, if the mesh is indexed */
     if(_indexBuffer.id()) _indexBuffer.bindInternal(Buffer::TargetHint::ElementArray);
@@ -855,18 +979,13 @@ void Mesh::bindImplementationVAO() {
 }
 
 void Mesh::unbindImplementationDefault() {
-    for(const AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes)) {
-        glDisableVertexAttribArray(attribute.location);
-
-        /* Reset also the divisor back so it doesn't affect  */
-        if(attribute.divisor) {
-            #ifndef MAGNUM_TARGET_GLES2
-            glVertexAttribDivisor(attribute.location, 0);
-            #else
-            (this->*Context::current().state().mesh->vertexAttribDivisorImplementation)(attribute.location, 0);
-            #endif
-        }
-    }
+    /* Vertex attributes are left enabled and bound to their buffers, the next
+       bindImplementationDefault() call respecifies or disables only what's
+       different. State::MeshVao in Context::resetState() takes care of
+       disabling them for external GL code. Reset just the divisors back so
+       they don't affect subsequent non-instanced draws. */
+    for(const AttributeLayout& attribute: *reinterpret_cast<std::vector<AttributeLayout>*>(&_attributes))
+        if(attribute.divisor) vertexAttribDivisor(attribute.location, 0);
 }
 
 void Mesh::unbindImplementationVAO() {}
@@ -1080,6 +1080,13 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
         void drawInternal(TransformFeedback& xfb, UnsignedInt stream, Int instanceCount);
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        void drawIndirectInternal(Buffer& buffer, GLintptr offset, UnsignedInt drawCount, UnsignedInt stride);
+        #ifndef MAGNUM_TARGET_GLES
+        void drawIndirectInternal(Buffer& buffer, GLintptr offset, Buffer& countBuffer, GLintptr countOffset, UnsignedInt maxDrawCount, UnsignedInt stride);
+        #endif
+        #endif
+
         void MAGNUM_GL_LOCAL createImplementationDefault(bool);
         void MAGNUM_GL_LOCAL createImplementationVAO(bool createObject);
         #ifndef MAGNUM_TARGET_GLES
@@ -1105,6 +1112,8 @@ class MAGNUM_GL_EXPORT Mesh: public AbstractObject {
         #endif
         #endif
         void MAGNUM_GL_LOCAL vertexAttribPointer(AttributeLayout& attribute);
+        void MAGNUM_GL_LOCAL vertexAttribPointerNoEnable(AttributeLayout& attribute);
+        void MAGNUM_GL_LOCAL vertexAttribDivisor(GLuint location, GLuint divisor);
 
         #ifndef MAGNUM_TARGET_GLES
         void MAGNUM_GL_LOCAL vertexAttribDivisorImplementationVAO(GLuint index, GLuint divisor);
@@ -34,6 +34,22 @@
 #include "Magnum/GL/Implementation/State.h"
 #include "Magnum/GL/Implementation/MeshState.h"
 
+#ifdef MAGNUM_TARGET_WEBGL
+/* The WEBGL_multi_draw and WEBGL_multi_draw_instanced_base_vertex_base_instance
+   entrypoints are not in gl.xml and thus not generated by flextGL. They're
+   implemented in Emscripten's library_webgl.js, declaring them here. */
+extern "C" {
+    void glMultiDrawArraysWEBGL(GLenum mode, const GLint* firsts, const GLsizei* counts, GLsizei drawCount);
+    void glMultiDrawArraysInstancedWEBGL(GLenum mode, const GLint* firsts, const GLsizei* counts, const GLsizei* instanceCounts, GLsizei drawCount);
+    void glMultiDrawElementsWEBGL(GLenum mode, const GLsizei* counts, GLenum type, const GLvoid* const* offsets, GLsizei drawCount);
+    void glMultiDrawElementsInstancedWEBGL(GLenum mode, const GLsizei* counts, GLenum type, const GLvoid* const* offsets, const GLsizei* instanceCounts, GLsizei drawCount);
+    #ifndef MAGNUM_TARGET_GLES2
+    void glMultiDrawArraysInstancedBaseInstanceWEBGL(GLenum mode, const GLint* firsts, const GLsizei* counts, const GLsizei* instanceCounts, const GLuint* baseInstances, GLsizei drawCount);
+    void glMultiDrawElementsInstancedBaseVertexBaseInstanceWEBGL(GLenum mode, const GLsizei* counts, GLenum type, const GLvoid* const* offsets, const GLsizei* instanceCounts, const GLint* baseVertices, const GLuint* baseInstances, GLsizei drawCount);
+    #endif
+}
+#endif
+
 namespace Magnum { namespace GL {
 
 #ifdef MAGNUM_BUILD_DEPRECATED
@@ -151,6 +167,86 @@ void MeshView::multiDrawImplementationDefault(Containers::ArrayView<const Contai
 }
 #endif
 
+#ifdef MAGNUM_TARGET_WEBGL
+void MeshView::multiDrawImplementationWEBGL(Containers::ArrayView<const Containers::Reference<MeshView>> meshes) {
+    multiDrawImplementationWEBGLInternal(meshes, false);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void MeshView::multiDrawImplementationWEBGLBaseVertexBaseInstance(Containers::ArrayView<const Containers::Reference<MeshView>> meshes) {
+    multiDrawImplementationWEBGLInternal(meshes, true);
+}
+#endif
+
+void MeshView::multiDrawImplementationWEBGLInternal(Containers::ArrayView<const Containers::Reference<MeshView>> meshes, const bool baseVertexBaseInstance) {
+    CORRADE_INTERNAL_ASSERT(meshes.size());
+
+    const Implementation::MeshState& state = *Context::current().state().mesh;
+
+    Mesh& original = meshes.begin()->get()._original;
+    Containers::Array<GLsizei> count{meshes.size()};
+    Containers::Array<GLvoid*> indices{meshes.size()};
+    Containers::Array<GLint> baseVertex{meshes.size()};
+    Containers::Array<GLsizei> instanceCount{meshes.size()};
+
+    /* Gather the parameters. Unlike in the EXT_multi_draw_arrays case, the
+       instanced variants allow each view to have a different instance
+       count, so instanced views don't need to go through the fallback. */
+    bool hasBaseVertex = false;
+    bool hasInstanceCount = false;
+    std::size_t i = 0;
+    for(MeshView& mesh: meshes) {
+        count[i] = mesh._count;
+        indices[i] = reinterpret_cast<GLvoid*>(mesh._indexOffset);
+        baseVertex[i] = mesh._baseVertex;
+        instanceCount[i] = mesh._instanceCount;
+
+        if(mesh._baseVertex) hasBaseVertex = true;
+        if(mesh._instanceCount != 1) hasInstanceCount = true;
+
+        ++i;
+    }
+
+    CORRADE_ASSERT(!hasBaseVertex || !original._indexBuffer.id() || baseVertexBaseInstance,
+        "GL::MeshView::draw(): WEBGL_multi_draw_instanced_base_vertex_base_instance is required for base vertex specification in indexed meshes", );
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(baseVertexBaseInstance);
+    #endif
+
+    (original.*state.bindImplementation)();
+
+    /* Non-indexed meshes. The base vertex is passed as the first vertex,
+       same as in the single-draw case. */
+    if(!original._indexBuffer.id()) {
+        if(hasInstanceCount)
+            glMultiDrawArraysInstancedWEBGL(GLenum(original._primitive), baseVertex, count, instanceCount, meshes.size());
+        else
+            glMultiDrawArraysWEBGL(GLenum(original._primitive), baseVertex, count, meshes.size());
+
+    /* Indexed meshes */
+    } else {
+        /* Indexed meshes with base vertex. The base instance isn't exposed
+           on ES, so it's always zero. */
+        #ifndef MAGNUM_TARGET_GLES2
+        if(hasBaseVertex) {
+            Containers::Array<GLuint> baseInstance{Containers::ValueInit, meshes.size()};
+            glMultiDrawElementsInstancedBaseVertexBaseInstanceWEBGL(GLenum(original._primitive), count, GLenum(original._indexType), indices, instanceCount, baseVertex, baseInstance, meshes.size());
+
+        /* Indexed meshes */
+        } else
+        #endif
+        {
+            if(hasInstanceCount)
+                glMultiDrawElementsInstancedWEBGL(GLenum(original._primitive), count, GLenum(original._indexType), indices, instanceCount, meshes.size());
+            else
+                glMultiDrawElementsWEBGL(GLenum(original._primitive), count, GLenum(original._indexType), indices, meshes.size());
+        }
+    }
+
+    (original.*state.unbindImplementation)();
+}
+#endif
+
 #ifdef MAGNUM_TARGET_GLES
 void MeshView::multiDrawImplementationFallback(Containers::ArrayView<const Containers::Reference<MeshView>> meshes) {
     for(MeshView& mesh: meshes) {
@@ -259,6 +259,12 @@ class MAGNUM_GL_EXPORT MeshView {
 
         #ifndef MAGNUM_TARGET_WEBGL
         static MAGNUM_GL_LOCAL void multiDrawImplementationDefault(Containers::ArrayView<const Containers::Reference<MeshView>> meshes);
+        #else
+        static MAGNUM_GL_LOCAL void multiDrawImplementationWEBGL(Containers::ArrayView<const Containers::Reference<MeshView>> meshes);
+        #ifndef MAGNUM_TARGET_GLES2
+        static MAGNUM_GL_LOCAL void multiDrawImplementationWEBGLBaseVertexBaseInstance(Containers::ArrayView<const Containers::Reference<MeshView>> meshes);
+        #endif
+        static MAGNUM_GL_LOCAL void multiDrawImplementationWEBGLInternal(Containers::ArrayView<const Containers::Reference<MeshView>> meshes, bool baseVertexBaseInstance);
         #endif
         static MAGNUM_GL_LOCAL void multiDrawImplementationFallback(Containers::ArrayView<const Containers::Reference<MeshView>> meshes);
 
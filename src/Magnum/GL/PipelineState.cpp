@@ -0,0 +1,374 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineState.h"
+
+#include <initializer_list>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Implementation/State.h"
+#include "Magnum/GL/Implementation/RendererState.h"
+
+namespace Magnum { namespace GL {
+
+PipelineState::PipelineState() noexcept:
+    _blendEquationRgb{Renderer::BlendEquation::Add},
+    _blendEquationAlpha{Renderer::BlendEquation::Add},
+    _blendSourceRgb{Renderer::BlendFunction::One},
+    _blendDestinationRgb{Renderer::BlendFunction::Zero},
+    _blendSourceAlpha{Renderer::BlendFunction::One},
+    _blendDestinationAlpha{Renderer::BlendFunction::Zero},
+    _depthFunction{Renderer::DepthFunction::Less},
+    _faceCullingMode{Renderer::PolygonFacing::Back},
+    _frontFace{Renderer::FrontFace::CounterClockWise},
+    _polygonOffsetFactor{}, _polygonOffsetUnits{},
+    _stencil{
+        {Renderer::StencilFunction::Always, 0, ~UnsignedInt{}, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, ~UnsignedInt{}},
+        {Renderer::StencilFunction::Always, 0, ~UnsignedInt{}, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, Renderer::StencilOperation::Keep, ~UnsignedInt{}}
+    },
+    _features{}, _masks{ColorMask|DepthMask} {}
+
+PipelineState& PipelineState::setBlending(const bool enabled) {
+    _features = enabled ? _features|Blending : _features & ~Blending;
+    return *this;
+}
+
+PipelineState& PipelineState::setBlendEquation(const Renderer::BlendEquation rgb, const Renderer::BlendEquation alpha) {
+    _blendEquationRgb = rgb;
+    _blendEquationAlpha = alpha;
+    return *this;
+}
+
+PipelineState& PipelineState::setBlendFunction(const Renderer::BlendFunction sourceRgb, const Renderer::BlendFunction destinationRgb, const Renderer::BlendFunction sourceAlpha, const Renderer::BlendFunction destinationAlpha) {
+    _blendSourceRgb = sourceRgb;
+    _blendDestinationRgb = destinationRgb;
+    _blendSourceAlpha = sourceAlpha;
+    _blendDestinationAlpha = destinationAlpha;
+    return *this;
+}
+
+PipelineState& PipelineState::setDepthTest(const bool enabled) {
+    _features = enabled ? _features|DepthTest : _features & ~DepthTest;
+    return *this;
+}
+
+PipelineState& PipelineState::setDepthFunction(const Renderer::DepthFunction function) {
+    _depthFunction = function;
+    return *this;
+}
+
+PipelineState& PipelineState::setDepthMask(const bool allow) {
+    _masks = allow ? _masks|DepthMask : _masks & ~DepthMask;
+    return *this;
+}
+
+PipelineState& PipelineState::setStencilTest(const bool enabled) {
+    _features = enabled ? _features|StencilTest : _features & ~StencilTest;
+    return *this;
+}
+
+const PipelineState::Stencil& PipelineState::stencil(const Renderer::PolygonFacing facing) const {
+    CORRADE_ASSERT(facing != Renderer::PolygonFacing::FrontAndBack,
+        "GL::PipelineState: expected either a front or a back facing", _stencil[0]);
+    return _stencil[facing == Renderer::PolygonFacing::Back ? 1 : 0];
+}
+
+Renderer::StencilFunction PipelineState::stencilFunction(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).function;
+}
+
+Int PipelineState::stencilReferenceValue(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).referenceValue;
+}
+
+UnsignedInt PipelineState::stencilFunctionMask(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).functionMask;
+}
+
+PipelineState& PipelineState::setStencilFunction(const Renderer::PolygonFacing facing, const Renderer::StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    for(std::size_t i: {0, 1}) {
+        if(facing == (i ? Renderer::PolygonFacing::Front : Renderer::PolygonFacing::Back))
+            continue;
+        _stencil[i].function = function;
+        _stencil[i].referenceValue = referenceValue;
+        _stencil[i].functionMask = mask;
+    }
+    return *this;
+}
+
+Renderer::StencilOperation PipelineState::stencilFailOperation(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).stencilFail;
+}
+
+Renderer::StencilOperation PipelineState::stencilDepthFailOperation(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).depthFail;
+}
+
+Renderer::StencilOperation PipelineState::stencilDepthPassOperation(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).depthPass;
+}
+
+PipelineState& PipelineState::setStencilOperation(const Renderer::PolygonFacing facing, const Renderer::StencilOperation stencilFail, const Renderer::StencilOperation depthFail, const Renderer::StencilOperation depthPass) {
+    for(std::size_t i: {0, 1}) {
+        if(facing == (i ? Renderer::PolygonFacing::Front : Renderer::PolygonFacing::Back))
+            continue;
+        _stencil[i].stencilFail = stencilFail;
+        _stencil[i].depthFail = depthFail;
+        _stencil[i].depthPass = depthPass;
+    }
+    return *this;
+}
+
+UnsignedInt PipelineState::stencilMask(const Renderer::PolygonFacing facing) const {
+    return stencil(facing).mask;
+}
+
+PipelineState& PipelineState::setStencilMask(const Renderer::PolygonFacing facing, const UnsignedInt allowBits) {
+    for(std::size_t i: {0, 1}) {
+        if(facing == (i ? Renderer::PolygonFacing::Front : Renderer::PolygonFacing::Back))
+            continue;
+        _stencil[i].mask = allowBits;
+    }
+    return *this;
+}
+
+PipelineState& PipelineState::setFaceCulling(const bool enabled) {
+    _features = enabled ? _features|FaceCulling : _features & ~FaceCulling;
+    return *this;
+}
+
+PipelineState& PipelineState::setFaceCullingMode(const Renderer::PolygonFacing mode) {
+    _faceCullingMode = mode;
+    return *this;
+}
+
+PipelineState& PipelineState::setFrontFace(const Renderer::FrontFace mode) {
+    _frontFace = mode;
+    return *this;
+}
+
+PipelineState& PipelineState::setPolygonOffsetFill(const bool enabled) {
+    _features = enabled ? _features|PolygonOffsetFill : _features & ~PolygonOffsetFill;
+    return *this;
+}
+
+PipelineState& PipelineState::setPolygonOffset(const Float factor, const Float units) {
+    _polygonOffsetFactor = factor;
+    _polygonOffsetUnits = units;
+    return *this;
+}
+
+PipelineState& PipelineState::setColorMask(const bool allowRed, const bool allowGreen, const bool allowBlue, const bool allowAlpha) {
+    _masks = (_masks & ~ColorMask)|
+        (allowRed ? ColorMaskRed : 0)|
+        (allowGreen ? ColorMaskGreen : 0)|
+        (allowBlue ? ColorMaskBlue : 0)|
+        (allowAlpha ? ColorMaskAlpha : 0);
+    return *this;
+}
+
+void PipelineState::apply() const {
+    typedef Implementation::RendererState RendererState;
+    RendererState& state = *Context::current().state().renderer;
+    PipelineState& current = state.pipelineState;
+    UnsignedInt& known = state.pipelineStateKnown;
+
+    /* Features. The feature bits are the same as the known state bits. */
+    static_assert(
+        UnsignedInt(Blending) == RendererState::PipelineStateBlending &&
+        UnsignedInt(DepthTest) == RendererState::PipelineStateDepthTest &&
+        UnsignedInt(StencilTest) == RendererState::PipelineStateStencilTest &&
+        UnsignedInt(FaceCulling) == RendererState::PipelineStateFaceCulling &&
+        UnsignedInt(PolygonOffsetFill) == RendererState::PipelineStatePolygonOffsetFill,
+        "feature bits not matching known state bits");
+    constexpr GLenum Features[]{
+        GLenum(Renderer::Feature::Blending),
+        GLenum(Renderer::Feature::DepthTest),
+        GLenum(Renderer::Feature::StencilTest),
+        GLenum(Renderer::Feature::FaceCulling),
+        GLenum(Renderer::Feature::PolygonOffsetFill)
+    };
+    for(std::size_t i = 0; i != Containers::arraySize(Features); ++i) {
+        const UnsignedByte feature = 1 << i;
+        if((known & feature) && (current._features & feature) == (_features & feature))
+            continue;
+
+        if(_features & feature) glEnable(Features[i]);
+        else glDisable(Features[i]);
+        current._features = (current._features & ~feature)|(_features & feature);
+        known |= feature;
+    }
+
+    /* Blend state, only if blending is enabled */
+    if(_features & Blending) {
+        if(!(known & RendererState::PipelineStateBlendEquation) ||
+           current._blendEquationRgb != _blendEquationRgb ||
+           current._blendEquationAlpha != _blendEquationAlpha)
+        {
+            if(_blendEquationRgb == _blendEquationAlpha)
+                glBlendEquation(GLenum(_blendEquationRgb));
+            else
+                glBlendEquationSeparate(GLenum(_blendEquationRgb), GLenum(_blendEquationAlpha));
+            current._blendEquationRgb = _blendEquationRgb;
+            current._blendEquationAlpha = _blendEquationAlpha;
+            known |= RendererState::PipelineStateBlendEquation;
+        }
+
+        if(!(known & RendererState::PipelineStateBlendFunction) ||
+           current._blendSourceRgb != _blendSourceRgb ||
+           current._blendDestinationRgb != _blendDestinationRgb ||
+           current._blendSourceAlpha != _blendSourceAlpha ||
+           current._blendDestinationAlpha != _blendDestinationAlpha)
+        {
+            if(_blendSourceRgb == _blendSourceAlpha && _blendDestinationRgb == _blendDestinationAlpha)
+                glBlendFunc(GLenum(_blendSourceRgb), GLenum(_blendDestinationRgb));
+            else
+                glBlendFuncSeparate(GLenum(_blendSourceRgb), GLenum(_blendDestinationRgb), GLenum(_blendSourceAlpha), GLenum(_blendDestinationAlpha));
+            current._blendSourceRgb = _blendSourceRgb;
+            current._blendDestinationRgb = _blendDestinationRgb;
+            current._blendSourceAlpha = _blendSourceAlpha;
+            current._blendDestinationAlpha = _blendDestinationAlpha;
+            known |= RendererState::PipelineStateBlendFunction;
+        }
+    }
+
+    /* Depth function, only if depth test is enabled */
+    if((_features & DepthTest) && (!(known & RendererState::PipelineStateDepthFunction) || current._depthFunction != _depthFunction)) {
+        glDepthFunc(GLenum(_depthFunction));
+        current._depthFunction = _depthFunction;
+        known |= RendererState::PipelineStateDepthFunction;
+    }
+
+    /* Stencil function and operation, only if stencil test is enabled. If
+       both faces need an update to the same value, a single non-separate
+       call is done. */
+    if(_features & StencilTest) {
+        bool functionUpdate[2];
+        bool operationUpdate[2];
+        for(std::size_t i: {0, 1}) {
+            const Stencil& a = _stencil[i];
+            const Stencil& b = current._stencil[i];
+            functionUpdate[i] = !(known & (RendererState::PipelineStateStencilFunctionFront << i)) ||
+                a.function != b.function ||
+                a.referenceValue != b.referenceValue ||
+                a.functionMask != b.functionMask;
+            operationUpdate[i] = !(known & (RendererState::PipelineStateStencilOperationFront << i)) ||
+                a.stencilFail != b.stencilFail ||
+                a.depthFail != b.depthFail ||
+                a.depthPass != b.depthPass;
+        }
+
+        if(functionUpdate[0] && functionUpdate[1] &&
+           _stencil[0].function == _stencil[1].function &&
+           _stencil[0].referenceValue == _stencil[1].referenceValue &&
+           _stencil[0].functionMask == _stencil[1].functionMask)
+        {
+            glStencilFunc(GLenum(_stencil[0].function), _stencil[0].referenceValue, _stencil[0].functionMask);
+        } else for(std::size_t i: {0, 1}) {
+            if(functionUpdate[i])
+                glStencilFuncSeparate(i ? GL_BACK : GL_FRONT, GLenum(_stencil[i].function), _stencil[i].referenceValue, _stencil[i].functionMask);
+        }
+
+        if(operationUpdate[0] && operationUpdate[1] &&
+           _stencil[0].stencilFail == _stencil[1].stencilFail &&
+           _stencil[0].depthFail == _stencil[1].depthFail &&
+           _stencil[0].depthPass == _stencil[1].depthPass)
+        {
+            glStencilOp(GLenum(_stencil[0].stencilFail), GLenum(_stencil[0].depthFail), GLenum(_stencil[0].depthPass));
+        } else for(std::size_t i: {0, 1}) {
+            if(operationUpdate[i])
+                glStencilOpSeparate(i ? GL_BACK : GL_FRONT, GLenum(_stencil[i].stencilFail), GLenum(_stencil[i].depthFail), GLenum(_stencil[i].depthPass));
+        }
+
+        for(std::size_t i: {0, 1}) {
+            Stencil& b = current._stencil[i];
+            b.function = _stencil[i].function;
+            b.referenceValue = _stencil[i].referenceValue;
+            b.functionMask = _stencil[i].functionMask;
+            b.stencilFail = _stencil[i].stencilFail;
+            b.depthFail = _stencil[i].depthFail;
+            b.depthPass = _stencil[i].depthPass;
+        }
+        known |= RendererState::PipelineStateStencilFunctionFront|
+                 RendererState::PipelineStateStencilFunctionBack|
+                 RendererState::PipelineStateStencilOperationFront|
+                 RendererState::PipelineStateStencilOperationBack;
+    }
+
+    /* Face culling mode, only if face culling is enabled */
+    if((_features & FaceCulling) && (!(known & RendererState::PipelineStateFaceCullingMode) || current._faceCullingMode != _faceCullingMode)) {
+        glCullFace(GLenum(_faceCullingMode));
+        current._faceCullingMode = _faceCullingMode;
+        known |= RendererState::PipelineStateFaceCullingMode;
+    }
+
+    /* Front face affects also two-sided stencil and gl_FrontFacing, so it's
+       applied always */
+    if(!(known & RendererState::PipelineStateFrontFace) || current._frontFace != _frontFace) {
+        glFrontFace(GLenum(_frontFace));
+        current._frontFace = _frontFace;
+        known |= RendererState::PipelineStateFrontFace;
+    }
+
+    /* Polygon offset, only if polygon offset fill is enabled */
+    if((_features & PolygonOffsetFill) && (!(known & RendererState::PipelineStatePolygonOffset) || current._polygonOffsetFactor != _polygonOffsetFactor || current._polygonOffsetUnits != _polygonOffsetUnits)) {
+        glPolygonOffset(_polygonOffsetFactor, _polygonOffsetUnits);
+        current._polygonOffsetFactor = _polygonOffsetFactor;
+        current._polygonOffsetUnits = _polygonOffsetUnits;
+        known |= RendererState::PipelineStatePolygonOffset;
+    }
+
+    /* Write masks affect also framebuffer clear, so they're applied always */
+    if(!(known & RendererState::PipelineStateColorMask) || (current._masks & ColorMask) != (_masks & ColorMask)) {
+        glColorMask(bool(_masks & ColorMaskRed), bool(_masks & ColorMaskGreen), bool(_masks & ColorMaskBlue), bool(_masks & ColorMaskAlpha));
+        current._masks = (current._masks & ~ColorMask)|(_masks & ColorMask);
+        known |= RendererState::PipelineStateColorMask;
+    }
+    if(!(known & RendererState::PipelineStateDepthMask) || (current._masks & DepthMask) != (_masks & DepthMask)) {
+        glDepthMask(bool(_masks & DepthMask));
+        current._masks = (current._masks & ~DepthMask)|(_masks & DepthMask);
+        known |= RendererState::PipelineStateDepthMask;
+    }
+    {
+        bool maskUpdate[2];
+        for(std::size_t i: {0, 1})
+            maskUpdate[i] = !(known & (RendererState::PipelineStateStencilMaskFront << i)) || current._stencil[i].mask != _stencil[i].mask;
+
+        if(maskUpdate[0] && maskUpdate[1] && _stencil[0].mask == _stencil[1].mask)
+            glStencilMask(_stencil[0].mask);
+        else for(std::size_t i: {0, 1}) {
+            if(maskUpdate[i])
+                glStencilMaskSeparate(i ? GL_BACK : GL_FRONT, _stencil[i].mask);
+        }
+
+        current._stencil[0].mask = _stencil[0].mask;
+        current._stencil[1].mask = _stencil[1].mask;
+        known |= RendererState::PipelineStateStencilMaskFront|
+                 RendererState::PipelineStateStencilMaskBack;
+    }
+}
+
+}}
@@ -0,0 +1,474 @@
+#ifndef Magnum_GL_PipelineState_h
+#define Magnum_GL_PipelineState_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::PipelineState
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Fixed-function pipeline state
+@m_since_latest
+
+Describes blending, depth, stencil, face culling, polygon offset and write
+mask state in a single object that's applied with one @ref apply() call,
+instead of calling the individual @ref Renderer setters before each draw:
+
+@snippet MagnumGL.cpp PipelineState-usage
+
+The object is meant to be set up once, for example for each material, and
+then applied as needed. Setters of the individual states are chainable and
+the initial value of each matches the initial value of the corresponding
+@ref Renderer state.
+
+@section GL-PipelineState-diffing State diffing
+
+The state last applied through @ref apply() is tracked, and only the
+difference gets issued to GL --- switching between two pipeline states that
+differ only in the depth function is a single @fn_gl{DepthFunc} call, and
+applying the same state again is a no-op. Additionally, state that has no
+effect is not applied at all --- blend equation and function aren't set if
+@ref setBlending() is disabled, depth function isn't set if
+@ref setDepthTest() is disabled, and similarly for stencil function and
+operation, face culling mode and polygon offset. Such state is applied once
+the corresponding feature gets enabled. Write masks are applied always, as
+they affect framebuffer clearing as well.
+
+Calling the corresponding @ref Renderer setters marks the affected state as
+unknown so the next @ref apply() sets it again, which means it's fine to mix
+the two approaches. Same happens for @ref Context::resetState() with
+@ref Context::State::Renderer. Note that if external GL code modifies the
+state, you need to call @ref Context::resetState() as usual, otherwise the
+tracked state won't match.
+
+Per-draw-buffer state such as @ref Renderer::setColorMask(UnsignedInt, GLboolean, GLboolean, GLboolean, GLboolean)
+or @ref Renderer::setBlendFunction(UnsignedInt, Renderer::BlendFunction, Renderer::BlendFunction)
+isn't described by this class. If you use it, the corresponding global state
+is marked as unknown as well.
+*/
+class MAGNUM_GL_EXPORT PipelineState {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * All state is set to initial GL values --- all features disabled,
+         * @ref Renderer::BlendEquation::Add, blend function
+         * @ref Renderer::BlendFunction::One for source and
+         * @ref Renderer::BlendFunction::Zero for destination,
+         * @ref Renderer::DepthFunction::Less,
+         * @ref Renderer::StencilFunction::Always with reference value
+         * @cpp 0 @ce and all mask bits set, @ref Renderer::StencilOperation::Keep
+         * everywhere, culling of @ref Renderer::PolygonFacing::Back faces,
+         * @ref Renderer::FrontFace::CounterClockWise, zero polygon offset and
+         * all write masks enabled.
+         */
+        explicit PipelineState() noexcept;
+
+        /** @brief Whether blending is enabled */
+        bool isBlending() const { return _features & Blending; }
+
+        /**
+         * @brief Enable or disable blending
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp false @ce.
+         * @see @ref Renderer::Feature::Blending
+         */
+        PipelineState& setBlending(bool enabled);
+
+        /** @brief RGB blend equation */
+        Renderer::BlendEquation blendEquationRgb() const { return _blendEquationRgb; }
+
+        /** @brief Alpha blend equation */
+        Renderer::BlendEquation blendEquationAlpha() const { return _blendEquationAlpha; }
+
+        /**
+         * @brief Set blend equation
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::BlendEquation::Add for both.
+         * @see @ref Renderer::setBlendEquation(Renderer::BlendEquation, Renderer::BlendEquation)
+         */
+        PipelineState& setBlendEquation(Renderer::BlendEquation rgb, Renderer::BlendEquation alpha);
+
+        /**
+         * @brief Set blend equation for both RGB and alpha
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setBlendEquation(Renderer::BlendEquation, Renderer::BlendEquation)
+         * with @p equation for both.
+         */
+        PipelineState& setBlendEquation(Renderer::BlendEquation equation) {
+            return setBlendEquation(equation, equation);
+        }
+
+        /** @brief Source RGB blend function */
+        Renderer::BlendFunction blendSourceRgb() const { return _blendSourceRgb; }
+
+        /** @brief Destination RGB blend function */
+        Renderer::BlendFunction blendDestinationRgb() const { return _blendDestinationRgb; }
+
+        /** @brief Source alpha blend function */
+        Renderer::BlendFunction blendSourceAlpha() const { return _blendSourceAlpha; }
+
+        /** @brief Destination alpha blend function */
+        Renderer::BlendFunction blendDestinationAlpha() const { return _blendDestinationAlpha; }
+
+        /**
+         * @brief Set blend function
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::BlendFunction::One for source and
+         * @ref Renderer::BlendFunction::Zero for destination.
+         * @see @ref Renderer::setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction)
+         */
+        PipelineState& setBlendFunction(Renderer::BlendFunction sourceRgb, Renderer::BlendFunction destinationRgb, Renderer::BlendFunction sourceAlpha, Renderer::BlendFunction destinationAlpha);
+
+        /**
+         * @brief Set blend function for both RGB and alpha
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setBlendFunction(Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction, Renderer::BlendFunction)
+         * with @p source and @p destination for both.
+         */
+        PipelineState& setBlendFunction(Renderer::BlendFunction source, Renderer::BlendFunction destination) {
+            return setBlendFunction(source, destination, source, destination);
+        }
+
+        /** @brief Whether depth test is enabled */
+        bool isDepthTest() const { return _features & DepthTest; }
+
+        /**
+         * @brief Enable or disable depth test
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp false @ce.
+         * @see @ref Renderer::Feature::DepthTest
+         */
+        PipelineState& setDepthTest(bool enabled);
+
+        /** @brief Depth function */
+        Renderer::DepthFunction depthFunction() const { return _depthFunction; }
+
+        /**
+         * @brief Set depth function
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::DepthFunction::Less.
+         * @see @ref Renderer::setDepthFunction()
+         */
+        PipelineState& setDepthFunction(Renderer::DepthFunction function);
+
+        /** @brief Whether depth write is allowed */
+        bool depthMask() const { return _masks & DepthMask; }
+
+        /**
+         * @brief Set depth mask
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp true @ce.
+         * @see @ref Renderer::setDepthMask()
+         */
+        PipelineState& setDepthMask(bool allow);
+
+        /** @brief Whether stencil test is enabled */
+        bool isStencilTest() const { return _features & StencilTest; }
+
+        /**
+         * @brief Enable or disable stencil test
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp false @ce.
+         * @see @ref Renderer::Feature::StencilTest
+         */
+        PipelineState& setStencilTest(bool enabled);
+
+        /**
+         * @brief Stencil function
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        Renderer::StencilFunction stencilFunction(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Stencil reference value
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        Int stencilReferenceValue(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Stencil function mask
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        UnsignedInt stencilFunctionMask(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Set stencil function
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::StencilFunction::Always with
+         * reference value @cpp 0 @ce and all mask bits set for both faces.
+         * @see @ref Renderer::setStencilFunction(Renderer::PolygonFacing, Renderer::StencilFunction, Int, UnsignedInt)
+         */
+        PipelineState& setStencilFunction(Renderer::PolygonFacing facing, Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask);
+
+        /**
+         * @brief Set stencil function for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setStencilFunction(Renderer::PolygonFacing, Renderer::StencilFunction, Int, UnsignedInt)
+         * with @ref Renderer::PolygonFacing::FrontAndBack.
+         */
+        PipelineState& setStencilFunction(Renderer::StencilFunction function, Int referenceValue, UnsignedInt mask) {
+            return setStencilFunction(Renderer::PolygonFacing::FrontAndBack, function, referenceValue, mask);
+        }
+
+        /**
+         * @brief Stencil fail operation
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        Renderer::StencilOperation stencilFailOperation(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Depth fail stencil operation
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        Renderer::StencilOperation stencilDepthFailOperation(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Depth pass stencil operation
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        Renderer::StencilOperation stencilDepthPassOperation(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Set stencil operation
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::StencilOperation::Keep for all
+         * fields and both faces.
+         * @see @ref Renderer::setStencilOperation(Renderer::PolygonFacing, Renderer::StencilOperation, Renderer::StencilOperation, Renderer::StencilOperation)
+         */
+        PipelineState& setStencilOperation(Renderer::PolygonFacing facing, Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass);
+
+        /**
+         * @brief Set stencil operation for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setStencilOperation(Renderer::PolygonFacing, Renderer::StencilOperation, Renderer::StencilOperation, Renderer::StencilOperation)
+         * with @ref Renderer::PolygonFacing::FrontAndBack.
+         */
+        PipelineState& setStencilOperation(Renderer::StencilOperation stencilFail, Renderer::StencilOperation depthFail, Renderer::StencilOperation depthPass) {
+            return setStencilOperation(Renderer::PolygonFacing::FrontAndBack, stencilFail, depthFail, depthPass);
+        }
+
+        /**
+         * @brief Stencil write mask
+         *
+         * Expects that @p facing is either @ref Renderer::PolygonFacing::Front
+         * or @ref Renderer::PolygonFacing::Back.
+         */
+        UnsignedInt stencilMask(Renderer::PolygonFacing facing) const;
+
+        /**
+         * @brief Set stencil write mask
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is all bits set for both faces.
+         * @see @ref Renderer::setStencilMask(Renderer::PolygonFacing, UnsignedInt)
+         */
+        PipelineState& setStencilMask(Renderer::PolygonFacing facing, UnsignedInt allowBits);
+
+        /**
+         * @brief Set stencil write mask for both faces
+         * @return Reference to self (for method chaining)
+         *
+         * Same as calling @ref setStencilMask(Renderer::PolygonFacing, UnsignedInt)
+         * with @ref Renderer::PolygonFacing::FrontAndBack.
+         */
+        PipelineState& setStencilMask(UnsignedInt allowBits) {
+            return setStencilMask(Renderer::PolygonFacing::FrontAndBack, allowBits);
+        }
+
+        /** @brief Whether face culling is enabled */
+        bool isFaceCulling() const { return _features & FaceCulling; }
+
+        /**
+         * @brief Enable or disable face culling
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp false @ce.
+         * @see @ref Renderer::Feature::FaceCulling
+         */
+        PipelineState& setFaceCulling(bool enabled);
+
+        /** @brief Face culling mode */
+        Renderer::PolygonFacing faceCullingMode() const { return _faceCullingMode; }
+
+        /**
+         * @brief Set face culling mode
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::PolygonFacing::Back.
+         * @see @ref Renderer::setFaceCullingMode()
+         */
+        PipelineState& setFaceCullingMode(Renderer::PolygonFacing mode);
+
+        /** @brief Front face */
+        Renderer::FrontFace frontFace() const { return _frontFace; }
+
+        /**
+         * @brief Set front face
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @ref Renderer::FrontFace::CounterClockWise. Unlike
+         * @ref setFaceCullingMode(), this is applied regardless of whether
+         * face culling is enabled, as it affects two-sided stencil and
+         * @glsl gl_FrontFacing @ce as well.
+         * @see @ref Renderer::setFrontFace()
+         */
+        PipelineState& setFrontFace(Renderer::FrontFace mode);
+
+        /** @brief Whether polygon offset for filled polygons is enabled */
+        bool isPolygonOffsetFill() const { return _features & PolygonOffsetFill; }
+
+        /**
+         * @brief Enable or disable polygon offset for filled polygons
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp false @ce.
+         * @see @ref Renderer::Feature::PolygonOffsetFill
+         */
+        PipelineState& setPolygonOffsetFill(bool enabled);
+
+        /** @brief Polygon offset factor */
+        Float polygonOffsetFactor() const { return _polygonOffsetFactor; }
+
+        /** @brief Polygon offset units */
+        Float polygonOffsetUnits() const { return _polygonOffsetUnits; }
+
+        /**
+         * @brief Set polygon offset
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp 0.0f @ce for both.
+         * @see @ref Renderer::setPolygonOffset()
+         */
+        PipelineState& setPolygonOffset(Float factor, Float units);
+
+        /** @brief Whether writing to the red channel is allowed */
+        bool colorMaskRed() const { return _masks & ColorMaskRed; }
+
+        /** @brief Whether writing to the green channel is allowed */
+        bool colorMaskGreen() const { return _masks & ColorMaskGreen; }
+
+        /** @brief Whether writing to the blue channel is allowed */
+        bool colorMaskBlue() const { return _masks & ColorMaskBlue; }
+
+        /** @brief Whether writing to the alpha channel is allowed */
+        bool colorMaskAlpha() const { return _masks & ColorMaskAlpha; }
+
+        /**
+         * @brief Set color mask
+         * @return Reference to self (for method chaining)
+         *
+         * Initial value is @cpp true @ce for all channels.
+         * @see @ref Renderer::setColorMask(GLboolean, GLboolean, GLboolean, GLboolean)
+         */
+        PipelineState& setColorMask(bool allowRed, bool allowGreen, bool allowBlue, bool allowAlpha);
+
+        /**
+         * @brief Apply the state
+         *
+         * Issues only GL calls for state that differs from what was applied
+         * last time. See @ref GL-PipelineState-diffing for more information.
+         */
+        void apply() const;
+
+    private:
+        enum: UnsignedByte {
+            /* Features */
+            Blending = 1 << 0,
+            DepthTest = 1 << 1,
+            StencilTest = 1 << 2,
+            FaceCulling = 1 << 3,
+            PolygonOffsetFill = 1 << 4,
+
+            /* Masks */
+            ColorMaskRed = 1 << 0,
+            ColorMaskGreen = 1 << 1,
+            ColorMaskBlue = 1 << 2,
+            ColorMaskAlpha = 1 << 3,
+            ColorMask = ColorMaskRed|ColorMaskGreen|ColorMaskBlue|ColorMaskAlpha,
+            DepthMask = 1 << 4
+        };
+
+        struct Stencil {
+            Renderer::StencilFunction function;
+            Int referenceValue;
+            UnsignedInt functionMask;
+            Renderer::StencilOperation stencilFail,
+                depthFail,
+                depthPass;
+            UnsignedInt mask;
+        };
+
+        const Stencil& stencil(Renderer::PolygonFacing facing) const;
+
+        Renderer::BlendEquation _blendEquationRgb, _blendEquationAlpha;
+        Renderer::BlendFunction _blendSourceRgb, _blendDestinationRgb,
+            _blendSourceAlpha, _blendDestinationAlpha;
+        Renderer::DepthFunction _depthFunction;
+        Renderer::PolygonFacing _faceCullingMode;
+        Renderer::FrontFace _frontFace;
+        Float _polygonOffsetFactor, _polygonOffsetUnits;
+        /* Front and back */
+        Stencil _stencil[2];
+        UnsignedByte _features, _masks;
+};
+
+}}
+
+#endif
@@ -0,0 +1,139 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Fence.h"
+
+#include "ProgramBinaryCache.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Shader.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/Extensions.h"
+#endif
+
+namespace Magnum { namespace GL {
+
+namespace {
+
+/* Each file starts with this, followed by the binary itself */
+struct Header {
+    char magic[4];
+    UnsignedInt format;
+};
+
+constexpr char Magic[]{'M', 'P', 'B', '1'};
+
+static_assert(sizeof(Header) == 8, "improper size of the file header");
+
+}
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory): _directory{std::move(directory)} {
+    Context& context = Context::current();
+    _driver = Utility::formatString("{}\n{}\n{}\n", context.vendorString(), context.rendererString(), context.versionString());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!context.isExtensionSupported<Extensions::ARB::get_program_binary>()) {
+        _supported = false;
+        return;
+    }
+    #endif
+
+    /* The driver may support the entry points but not provide any format, in
+       which case all binaries would get rejected */
+    GLint formatCount{};
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    _supported = formatCount > 0;
+}
+
+std::string ProgramBinaryCache::key(const std::initializer_list<Containers::Reference<Shader>> shaders) const {
+    Utility::Sha1 sha1;
+    sha1 << _driver;
+    for(const Shader& shader: shaders) {
+        const std::vector<std::string> sources = shader.sources();
+        /* Including the source sizes so concatenating differently split
+           sources doesn't result in the same hash */
+        sha1 << Utility::formatString("{:x} {}\n", UnsignedInt(shader.type()), sources.size());
+        for(const std::string& source: sources)
+            sha1 << Utility::formatString("{}\n", source.size()) << source;
+    }
+
+    return sha1.digest().hexString();
+}
+
+bool ProgramBinaryCache::load(AbstractShaderProgram& program, const std::string& key) {
+    if(!_supported) return false;
+
+    const std::string filename = Utility::Directory::join(_directory, key + ".bin");
+    bool loaded = false;
+    if(Utility::Directory::exists(filename)) {
+        const Containers::Array<char> data = Utility::Directory::read(filename);
+        Header header;
+        if(data.size() > sizeof(Header)) {
+            std::memcpy(&header, data, sizeof(Header));
+            if(std::memcmp(header.magic, Magic, sizeof(Magic)) == 0)
+                loaded = program.setBinary(header.format, data.suffix(sizeof(Header)));
+        }
+
+        /* Not attempting to load the same broken file again next time */
+        if(!loaded) Utility::Directory::rm(filename);
+    }
+
+    /* The program will get compiled from source, prepare it for save() */
+    if(!loaded) program.setRetrievableBinary(true);
+
+    return loaded;
+}
+
+bool ProgramBinaryCache::save(AbstractShaderProgram& program, const std::string& key) {
+    if(!_supported) return false;
+
+    std::pair<Containers::Array<char>, GLenum> binary = program.binary();
+    if(binary.first.empty()) return false;
+
+    Containers::Array<char> data{Containers::NoInit, sizeof(Header) + binary.first.size()};
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.format = binary.second;
+    std::memcpy(data, &header, sizeof(Header));
+    std::memcpy(data + sizeof(Header), binary.first, binary.first.size());
+
+    if(!Utility::Directory::mkpath(_directory)) return false;
+
+    /* Writing to a temporary file first so an interrupted write or another
+       instance of the application never sees a partially written binary */
+    const std::string filename = Utility::Directory::join(_directory, key + ".bin");
+    const std::string temporary = filename + ".tmp";
+    return Utility::Directory::write(temporary, data) &&
+           Utility::Directory::move(temporary, filename);
+}
+
+}}
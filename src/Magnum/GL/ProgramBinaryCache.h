@@ -0,0 +1,148 @@
+#ifndef Magnum_GL_ProgramBinaryCache_h
+#define Magnum_GL_ProgramBinaryCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::ProgramBinaryCache
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <initializer_list>
+#include <string>
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief On-disk program binary cache
+@m_since_latest
+
+Saves linked program binaries retrieved with
+@ref AbstractShaderProgram::binary() into a directory and loads them back on
+subsequent runs, skipping shader compilation and linking altogether. Each
+binary is identified by a key calculated from the shader types and sources
+together with the driver vendor, renderer and version string, so a driver
+update or a different GPU results in a cache miss instead of loading an
+incompatible binary. If the driver rejects a binary anyway, the file is
+removed and the program is expected to be compiled from source as usual:
+
+@snippet MagnumGL.cpp ProgramBinaryCache-usage
+
+The builtin shaders in the @ref Shaders library use the cache automatically
+if it's set via @ref Context::setProgramBinaryCache().
+
+The key doesn't include state set up outside of the shader sources, such as
+attribute or fragment output locations bound with
+@ref AbstractShaderProgram::bindAttributeLocation() or transform feedback
+outputs. If those differ between programs that have the same sources, the
+keys have to be disambiguated by the application, for example by appending a
+suffix.
+
+If @gl_extension{ARB,get_program_binary} is not supported or the driver
+doesn't advertise any program binary formats, @ref isSupported() returns
+@cpp false @ce and @ref load() and @ref save() do nothing.
+
+@requires_gl41 Extension @gl_extension{ARB,get_program_binary}
+@requires_gles30 Program binaries are not available in OpenGL ES 2.0.
+@requires_gles Binary program representations are not supported in WebGL.
+*/
+class MAGNUM_GL_EXPORT ProgramBinaryCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param directory     Directory to store the binaries in. Created
+         *      on first @ref save() if it doesn't exist.
+         *
+         * Queries the driver strings and the count of supported binary formats
+         * from current context.
+         * @see @fn_gl_keyword{Get} with @def_gl{NUM_PROGRAM_BINARY_FORMATS}
+         */
+        explicit ProgramBinaryCache(std::string directory);
+
+        /** @brief Cache directory */
+        std::string directory() const { return _directory; }
+
+        /**
+         * @brief Whether program binaries are supported
+         *
+         * If not, @ref load() and @ref save() always return @cpp false @ce.
+         */
+        bool isSupported() const { return _supported; }
+
+        /**
+         * @brief Calculate a cache key
+         *
+         * Returns a hexadecimal SHA-1 hash of the driver vendor, renderer and
+         * version string together with types and sources of all @p shaders in
+         * given order. The shaders don't need to be compiled.
+         */
+        std::string key(std::initializer_list<Containers::Reference<Shader>> shaders) const;
+
+        /**
+         * @brief Load a program binary
+         *
+         * If a binary with given @p key is present in the cache and the driver
+         * accepts it, replaces @p program with it and returns @cpp true @ce.
+         * Otherwise returns @cpp false @ce and enables
+         * @ref AbstractShaderProgram::setRetrievableBinary() on @p program
+         * so it's prepared for @ref save() after it gets compiled and linked
+         * from source. A binary that's corrupted or rejected by the driver is
+         * removed from the cache.
+         * @see @ref AbstractShaderProgram::setBinary()
+         */
+        bool load(AbstractShaderProgram& program, const std::string& key);
+
+        /**
+         * @brief Save a program binary
+         *
+         * Expects that @p program is linked. Retrieves its binary and writes
+         * it to the cache under given @p key, creating the cache directory if
+         * it doesn't exist yet. Returns @cpp false @ce if the driver doesn't
+         * provide a binary or if the file can't be written, @cpp true @ce
+         * otherwise.
+         * @see @ref AbstractShaderProgram::binary()
+         */
+        bool save(AbstractShaderProgram& program, const std::string& key);
+
+    private:
+        std::string _directory;
+        /* Vendor, renderer and version string, hashed into every key */
+        std::string _driver;
+        bool _supported;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
@@ -32,7 +32,10 @@
 #include "Magnum/GL/Implementation/DebugState.h"
 #endif
 #include "Magnum/GL/Implementation/FramebufferState.h"
+#include "Magnum/GL/Implementation/ResourceState.h"
 #include "Magnum/GL/Implementation/State.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace GL {
 
@@ -70,6 +73,7 @@ Int Renderbuffer::maxSamples() {
 
 Renderbuffer::Renderbuffer(): _flags{ObjectFlag::DeleteOnDestruction} {
     (this->*Context::current().state().framebuffer->createRenderbufferImplementation)();
+    Context::current().state().resource->created(Context::ResourceType::Renderbuffer, _id);
 }
 
 void Renderbuffer::createImplementationDefault() {
@@ -91,6 +95,7 @@ Renderbuffer::~Renderbuffer() {
     GLuint& binding = Context::current().state().framebuffer->renderbufferBinding;
     if(binding == _id) binding = 0;
 
+    Context::current().state().resource->destroyed(Context::ResourceType::Renderbuffer, _id);
     glDeleteRenderbuffers(1, &_id);
 }
 
@@ -114,17 +119,20 @@ std::string Renderbuffer::label() {
 Renderbuffer& Renderbuffer::setLabelInternal(const Containers::ArrayView<const char> label) {
     createIfNotAlready();
     Context::current().state().debug->labelImplementation(GL_RENDERBUFFER, _id, label);
+    Context::current().state().resource->label(Context::ResourceType::Renderbuffer, _id, label);
     return *this;
 }
 #endif
 
 void Renderbuffer::setStorage(const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageImplementation)(internalFormat, size);
+    Context::current().state().resource->storage(Context::ResourceType::Renderbuffer, _id, Implementation::textureImageMemory(TextureFormat(GLenum(internalFormat)), {size, 1}));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderbuffer::setStorageMultisample(const Int samples, const RenderbufferFormat internalFormat, const Vector2i& size) {
     (this->*Context::current().state().framebuffer->renderbufferStorageMultisampleImplementation)(samples, internalFormat, size);
+    Context::current().state().resource->storage(Context::ResourceType::Renderbuffer, _id, Math::max(samples, 1)*Implementation::textureImageMemory(TextureFormat(GLenum(internalFormat)), {size, 1}));
 }
 #endif
 
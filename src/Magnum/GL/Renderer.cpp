@@ -35,6 +35,15 @@
 
 namespace Magnum { namespace GL {
 
+namespace {
+
+/* Marks state as unknown for the next PipelineState::apply() */
+inline void invalidatePipelineState(const UnsignedInt state) {
+    Context::current().state().renderer->pipelineStateKnown &= ~state;
+}
+
+}
+
 Range1D Renderer::lineWidthRange() {
     auto& state = *Context::current().state().renderer;
     Range1D& value = state.lineWidthRange;
@@ -61,10 +70,12 @@ Range1D Renderer::lineWidthRangeImplementationMesaForwardCompatible() {
 #endif
 
 void Renderer::enable(const Feature feature) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFeature(feature));
     glEnable(GLenum(feature));
 }
 
 void Renderer::disable(const Feature feature) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFeature(feature));
     glDisable(GLenum(feature));
 }
 
@@ -74,10 +85,12 @@ void Renderer::setFeature(const Feature feature, const bool enabled) {
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::enable(const Feature feature, const UnsignedInt drawBuffer) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFeature(feature));
     Context::current().state().renderer->enableiImplementation(GLenum(feature), drawBuffer);
 }
 
 void Renderer::disable(const Feature feature, const UnsignedInt drawBuffer) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFeature(feature));
     Context::current().state().renderer->disableiImplementation(GLenum(feature), drawBuffer);
 }
 
@@ -109,10 +122,12 @@ void Renderer::setClearStencil(const Int stencil) {
 }
 
 void Renderer::setFrontFace(const FrontFace mode) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateFrontFace);
     glFrontFace(GLenum(mode));
 }
 
 void Renderer::setFaceCullingMode(const PolygonFacing mode) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateFaceCullingMode);
     glCullFace(GLenum(mode));
 }
 
@@ -134,6 +149,7 @@ void Renderer::setPolygonMode(const PolygonMode mode) {
 #endif
 
 void Renderer::setPolygonOffset(const Float factor, const Float units) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStatePolygonOffset);
     glPolygonOffset(factor, units);
 }
 
@@ -283,77 +299,95 @@ void Renderer::setScissor(const Range2Di& rectangle) {
 }
 
 void Renderer::setStencilFunction(const PolygonFacing facing, const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFacing(facing, Implementation::RendererState::PipelineStateStencilFunctionFront));
     glStencilFuncSeparate(GLenum(facing), GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilFunction(const StencilFunction function, const Int referenceValue, const UnsignedInt mask) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateStencilFunctionFront|Implementation::RendererState::PipelineStateStencilFunctionBack);
     glStencilFunc(GLenum(function), referenceValue, mask);
 }
 
 void Renderer::setStencilOperation(const PolygonFacing facing, const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFacing(facing, Implementation::RendererState::PipelineStateStencilOperationFront));
     glStencilOpSeparate(GLenum(facing), GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setStencilOperation(const StencilOperation stencilFail, const StencilOperation depthFail, const StencilOperation depthPass) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateStencilOperationFront|Implementation::RendererState::PipelineStateStencilOperationBack);
     glStencilOp(GLenum(stencilFail), GLenum(depthFail), GLenum(depthPass));
 }
 
 void Renderer::setDepthFunction(const DepthFunction function) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateDepthFunction);
     glDepthFunc(GLenum(function));
 }
 
 void Renderer::setColorMask(const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateColorMask);
     glColorMask(allowRed, allowGreen, allowBlue, allowAlpha);
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setColorMask(const UnsignedInt drawBuffer, const GLboolean allowRed, const GLboolean allowGreen, const GLboolean allowBlue, const GLboolean allowAlpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateColorMask);
     Context::current().state().renderer->colorMaskiImplementation(drawBuffer, allowRed, allowGreen, allowBlue, allowAlpha);
 }
 #endif
 
 void Renderer::setDepthMask(const GLboolean allow) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateDepthMask);
     glDepthMask(allow);
 }
 
 void Renderer::setStencilMask(const PolygonFacing facing, const UnsignedInt allowBits) {
+    invalidatePipelineState(Implementation::RendererState::pipelineStateFacing(facing, Implementation::RendererState::PipelineStateStencilMaskFront));
     glStencilMaskSeparate(GLenum(facing), allowBits);
 }
 
 void Renderer::setStencilMask(const UnsignedInt allowBits) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateStencilMaskFront|Implementation::RendererState::PipelineStateStencilMaskBack);
     glStencilMask(allowBits);
 }
 
 void Renderer::setBlendEquation(const BlendEquation equation) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendEquation);
     glBlendEquation(GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const BlendEquation rgb, const BlendEquation alpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendEquation);
     glBlendEquationSeparate(GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const BlendFunction source, const BlendFunction destination) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendFunction);
     glBlendFunc(GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendFunction);
     glBlendFuncSeparate(GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 
 #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation equation) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendEquation);
     Context::current().state().renderer->blendEquationiImplementation(drawBuffer, GLenum(equation));
 }
 
 void Renderer::setBlendEquation(const UnsignedInt drawBuffer, const BlendEquation rgb, const BlendEquation alpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendEquation);
     Context::current().state().renderer->blendEquationSeparateiImplementation(drawBuffer, GLenum(rgb), GLenum(alpha));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction source, const BlendFunction destination) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendFunction);
     Context::current().state().renderer->blendFunciImplementation(drawBuffer, GLenum(source), GLenum(destination));
 }
 
 void Renderer::setBlendFunction(const UnsignedInt drawBuffer, const BlendFunction sourceRgb, const BlendFunction destinationRgb, const BlendFunction sourceAlpha, const BlendFunction destinationAlpha) {
+    invalidatePipelineState(Implementation::RendererState::PipelineStateBlendFunction);
     Context::current().state().renderer->blendFuncSeparateiImplementation(drawBuffer, GLenum(sourceRgb), GLenum(destinationRgb), GLenum(sourceAlpha), GLenum(destinationAlpha));
 }
 #endif
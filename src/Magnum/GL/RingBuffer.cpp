@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RingBuffer.h"
+
+#include <deque>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Fence.h"
+
+namespace Magnum { namespace GL {
+
+struct RingBuffer::State {
+    explicit State(std::size_t size, Buffer::TargetHint targetHint): buffer{targetHint}, size{size} {}
+
+    struct Region {
+        Fence fence;
+        /* Virtual end position of the guarded region */
+        UnsignedLong end;
+    };
+
+    Containers::Optional<Allocation> allocate(std::size_t size, std::size_t alignment, bool wait);
+
+    Buffer buffer;
+    Containers::ArrayView<char> data;
+    std::size_t size;
+
+    /* Virtual positions that only grow, the physical offset is the position
+       modulo size. Everything between tail and head is potentially still in
+       use by the GPU, everything between fenced and head is not guarded by
+       any fence yet. */
+    UnsignedLong head{}, fenced{}, tail{};
+    std::deque<Region> regions;
+};
+
+Containers::Optional<RingBuffer::Allocation> RingBuffer::State::allocate(const std::size_t size, const std::size_t alignment, const bool wait) {
+    /* Align the physical offset, wrap around to the beginning if the block
+       doesn't fit into the rest of the buffer */
+    const std::size_t physical = head % this->size;
+    std::size_t offset = (physical + alignment - 1) & ~(alignment - 1);
+    if(offset + size > this->size) offset = 0;
+    const UnsignedLong begin = head + (offset >= physical ? offset - physical : this->size - physical);
+    const UnsignedLong end = begin + size;
+
+    /* Memory written since the last fence isn't guarded by anything, so it
+       can't be reclaimed */
+    CORRADE_ASSERT(end - fenced <= this->size,
+        "GL::RingBuffer::allocate(): allocation of" << size << "bytes would overwrite data allocated since the last fence(), call it more often or use a larger buffer", {});
+
+    /* Reclaim all regions the block overlaps. The zero-timeout wait doesn't
+       block but flushes the commands, so the fence is guaranteed to get
+       signaled eventually. */
+    while(end - tail > this->size) {
+        Region& region = regions.front();
+        if(wait) {
+            while(region.fence.clientWait(1000000000ull) == Fence::WaitResult::TimeoutExpired);
+        } else if(region.fence.clientWait(0) == Fence::WaitResult::TimeoutExpired)
+            return {};
+
+        tail = region.end;
+        regions.pop_front();
+    }
+
+    head = end;
+    return Allocation{GLintptr(offset), data.slice(offset, offset + size)};
+}
+
+RingBuffer::RingBuffer(const std::size_t size, const Buffer::TargetHint targetHint): _state{Containers::InPlaceInit, size, targetHint} {
+    CORRADE_ASSERT(size,
+        "GL::RingBuffer: size can't be zero", );
+
+    _state->buffer.setStorage(size,
+        Buffer::StorageFlag::MapWrite|
+        Buffer::StorageFlag::MapPersistent|
+        Buffer::StorageFlag::MapCoherent);
+    _state->data = _state->buffer.map(0, size,
+        Buffer::MapFlag::Write|
+        Buffer::MapFlag::Persistent|
+        Buffer::MapFlag::Coherent);
+}
+
+RingBuffer::RingBuffer(NoCreateT) noexcept {}
+
+RingBuffer::RingBuffer(RingBuffer&&) noexcept = default;
+
+/* The buffer gets implicitly unmapped on deletion, the fences are deleted
+   by the deque destructor */
+RingBuffer::~RingBuffer() = default;
+
+RingBuffer& RingBuffer::operator=(RingBuffer&&) noexcept = default;
+
+Buffer& RingBuffer::buffer() { return _state->buffer; }
+
+std::size_t RingBuffer::size() const { return _state->size; }
+
+RingBuffer::Allocation RingBuffer::allocate(const std::size_t size, const std::size_t alignment) {
+    State& state = *_state;
+    CORRADE_ASSERT(size <= state.size,
+        "GL::RingBuffer::allocate(): requested" << size << "bytes but the buffer has only" << state.size, {});
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "GL::RingBuffer::allocate(): expected alignment to be a non-zero power of two, got" << alignment, {});
+
+    Containers::Optional<Allocation> out = state.allocate(size, alignment, true);
+    /* Can only fail on a graceful assert */
+    return out ? *out : Allocation{};
+}
+
+Containers::Optional<RingBuffer::Allocation> RingBuffer::tryAllocate(const std::size_t size, const std::size_t alignment) {
+    State& state = *_state;
+    CORRADE_ASSERT(size <= state.size,
+        "GL::RingBuffer::tryAllocate(): requested" << size << "bytes but the buffer has only" << state.size, {});
+    CORRADE_ASSERT(alignment && !(alignment & (alignment - 1)),
+        "GL::RingBuffer::tryAllocate(): expected alignment to be a non-zero power of two, got" << alignment, {});
+
+    return state.allocate(size, alignment, false);
+}
+
+RingBuffer::Allocation RingBuffer::allocateUniform(const std::size_t size) {
+    return allocate(size, Buffer::uniformOffsetAlignment());
+}
+
+void RingBuffer::fence() {
+    State& state = *_state;
+
+    /* Nothing allocated since the last fence */
+    if(state.head == state.fenced) return;
+
+    state.regions.push_back({Fence{}, state.head});
+    state.fenced = state.head;
+}
+
+}}
@@ -0,0 +1,204 @@
+#ifndef Magnum_GL_RingBuffer_h
+#define Magnum_GL_RingBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::RingBuffer
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/Buffer.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Persistently mapped ring buffer
+@m_since_latest
+
+Wraps a @ref Buffer with immutable storage that's mapped persistently and
+coherently for the whole lifetime of the instance, and sub-allocates
+per-frame streaming data from it. Compared to calling @ref Buffer::setSubData()
+every frame, this avoids a driver-side copy of the data as well as implicit
+synchronization stalls, as the data are written directly into memory visible
+to the GPU:
+
+@snippet MagnumGL.cpp RingBuffer-usage
+
+Each @ref allocate() call returns a block of memory together with its offset in
+@ref buffer(), which can be then used for example in
+@ref Buffer::bind(Target, UnsignedInt, GLintptr, GLsizeiptr) or as an offset
+in @ref Mesh::addVertexBuffer(). After issuing all draws that consume the
+allocated data, call @ref fence() --- it inserts a fence into the command
+stream and when a later allocation wraps around to memory guarded by a fence
+that's not signaled yet, @ref allocate() waits for it so the data still in use
+by the GPU aren't overwritten. Sizing the buffer to hold data for about three
+frames makes such waits very rare. If the render thread shouldn't ever block,
+use @ref tryAllocate() instead, which returns @relativeref{Corrade,Containers::NullOpt}
+if the memory isn't available yet.
+
+The fences are managed through @ref Fence instances.
+
+@section GL-RingBuffer-alignment Allocation alignment
+
+Offsets of uniform buffer ranges have to be aligned to
+@ref Buffer::uniformOffsetAlignment() and offsets of shader storage buffer
+ranges to @ref Buffer::shaderStorageOffsetAlignment(). Pass the desired
+alignment to @ref allocate(), or use @ref allocateUniform() which does that
+for you.
+
+@requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+@requires_gl Buffer storage is not available in OpenGL ES and WebGL.
+*/
+class MAGNUM_GL_EXPORT RingBuffer {
+    public:
+        /**
+         * @brief Allocated block
+         *
+         * @see @ref allocate()
+         */
+        struct Allocation {
+            /** @brief Offset of the block in @ref buffer() */
+            GLintptr offset;
+
+            /** @brief Mapped memory of the block */
+            Containers::ArrayView<char> data;
+        };
+
+        /**
+         * @brief Constructor
+         * @param size          Buffer size in bytes
+         * @param targetHint    Target hint of the underlying buffer
+         *
+         * Creates a buffer with @ref Buffer::StorageFlag::MapWrite,
+         * @relativeref{Buffer::StorageFlag,MapPersistent} and
+         * @relativeref{Buffer::StorageFlag,MapCoherent} storage of @p size
+         * bytes and maps it persistently for writing. Expects that @p size is
+         * not zero.
+         */
+        explicit RingBuffer(std::size_t size, Buffer::TargetHint targetHint = Buffer::TargetHint::Array);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit RingBuffer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        RingBuffer(const RingBuffer&) = delete;
+
+        /** @brief Move constructor */
+        RingBuffer(RingBuffer&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pending fences and the underlying buffer.
+         */
+        ~RingBuffer();
+
+        /** @brief Copying is not allowed */
+        RingBuffer& operator=(const RingBuffer&) = delete;
+
+        /** @brief Move assignment */
+        RingBuffer& operator=(RingBuffer&&) noexcept;
+
+        /** @brief Underlying buffer */
+        Buffer& buffer();
+
+        /** @brief Buffer size in bytes */
+        std::size_t size() const;
+
+        /**
+         * @brief Allocate a block
+         * @param size          Block size in bytes
+         * @param alignment     Alignment of the block offset in bytes
+         *
+         * Returns a block of @p size bytes with the offset aligned to
+         * @p alignment following the previous allocation, wrapping around to
+         * the buffer beginning if there's not enough space at the end. If the
+         * block overlaps memory guarded by a previous @ref fence() that's not
+         * signaled yet, waits until the GPU is done with it.
+         *
+         * Expects that @p size is not larger than @ref size() and that
+         * @p alignment is a non-zero power of two. Additionally it's expected
+         * that the allocation doesn't overlap memory allocated since the last
+         * @ref fence() call, call it more often or create a larger buffer if
+         * that happens.
+         * @see @ref tryAllocate(), @ref Fence::clientWait()
+         */
+        Allocation allocate(std::size_t size, std::size_t alignment = 4);
+
+        /**
+         * @brief Try to allocate a block without waiting
+         *
+         * Like @ref allocate(), but if the block overlaps memory guarded by
+         * a fence that's not signaled yet, returns
+         * @relativeref{Corrade,Containers::NullOpt} instead of waiting. The
+         * fence status is polled with a zero timeout, which flushes the
+         * pending commands so the fence gets eventually signaled even if
+         * nothing else flushes them.
+         */
+        Containers::Optional<Allocation> tryAllocate(std::size_t size, std::size_t alignment = 4);
+
+        /**
+         * @brief Allocate a block for uniform buffer data
+         *
+         * Equivalent to calling @ref allocate() with
+         * @ref Buffer::uniformOffsetAlignment() as the alignment.
+         */
+        Allocation allocateUniform(std::size_t size);
+
+        /**
+         * @brief Guard all allocations done since the last fence
+         *
+         * Call after all commands consuming the data allocated since the last
+         * call were issued, usually once per frame. If nothing was allocated
+         * since the last call, the function is a no-op.
+         * @see @ref Fence::Fence()
+         */
+        void fence();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
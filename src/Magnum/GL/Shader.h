@@ -515,6 +515,19 @@ class MAGNUM_GL_EXPORT Shader: public AbstractObject {
          */
         static bool compile(std::initializer_list<Containers::Reference<Shader>> shaders);
 
+        /**
+         * @brief Check compilation status of multiple shaders
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref checkCompile() on all @p shaders, except
+         * that the messages printed to error output contain also the shader
+         * number, the same way as with
+         * @ref compile(std::initializer_list<Containers::Reference<Shader>>).
+         * Returns @cpp false @ce if compilation of any shader failed,
+         * @cpp true @ce if everything succeeded.
+         */
+        static bool checkCompile(std::initializer_list<Containers::Reference<Shader>> shaders);
+
         /**
          * @brief Constructor
          * @param version   Target version
@@ -644,9 +657,52 @@ class MAGNUM_GL_EXPORT Shader: public AbstractObject {
          */
         bool compile();
 
+        /**
+         * @brief Submit the shader for compilation
+         * @m_since_latest
+         *
+         * Uploads the sources and submits the shader for compilation without
+         * waiting for the result. Combined with @ref isCompileFinished() and
+         * @ref checkCompile() this allows the application to do other work
+         * while the driver compiles the shader in the background, which is
+         * especially useful with @gl_extension{KHR,parallel_shader_compile}.
+         * Expects that at least one source was added.
+         * @see @fn_gl_keyword{ShaderSource}, @fn_gl_keyword{CompileShader}
+         */
+        void submitCompile();
+
+        /**
+         * @brief Whether the shader compilation finished
+         * @m_since_latest
+         *
+         * Can be called only after @ref submitCompile(). If
+         * @gl_extension{KHR,parallel_shader_compile} is not available, always
+         * returns @cpp true @ce, which means @ref checkCompile() may still
+         * block in that case.
+         * @see @fn_gl_keyword{GetShader} with
+         *      @def_gl_extension{COMPLETION_STATUS,KHR,parallel_shader_compile}
+         */
+        bool isCompileFinished();
+
+        /**
+         * @brief Check the shader compilation status
+         * @m_since_latest
+         *
+         * Can be called only after @ref submitCompile(). Waits for the
+         * compilation to finish and returns @cpp false @ce if it failed,
+         * @cpp true @ce otherwise. Compiler messages (if any) are printed to
+         * error output, the same way as with @ref compile().
+         * @see @fn_gl_keyword{GetShader} with @def_gl{COMPILE_STATUS} and
+         *      @def_gl{INFO_LOG_LENGTH}, @fn_gl_keyword{GetShaderInfoLog}
+         */
+        bool checkCompile();
+
     private:
         Shader& setLabelInternal(Containers::ArrayView<const char> label);
 
+        /* If id is 0, the shader number isn't printed in the messages */
+        bool MAGNUM_GL_LOCAL checkCompileInternal(Int id);
+
         void MAGNUM_GL_LOCAL addSourceImplementationDefault(std::string source);
         #if defined(CORRADE_TARGET_EMSCRIPTEN) && defined(__EMSCRIPTEN_PTHREADS__)
         void MAGNUM_GL_LOCAL addSourceImplementationEmscriptenPthread(std::string source);
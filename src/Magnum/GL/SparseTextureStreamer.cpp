@@ -0,0 +1,381 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "SparseTextureStreamer.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Fence.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureStreamer.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+    /* Enough to not stall on the readback even with triple buffering */
+    constexpr std::size_t ReadbackCount = 3;
+}
+
+struct SparseTextureStreamer::State {
+    enum class TileState: UnsignedByte {
+        NonResident,
+        Loading,
+        Resident
+    };
+
+    struct Tile {
+        UnsignedLong lastRequestedFrame;
+        TileState state;
+        bool requested;
+    };
+
+    struct Level {
+        Vector2i size;
+        Vector2i tileCount;
+        std::size_t tileOffset;
+    };
+
+    struct Job {
+        std::size_t id;
+        Int level;
+        Vector2i tile;
+        Range2Di range;
+        TextureStreamer2D::Staging staging;
+        bool loaded;
+    };
+
+    struct Readback {
+        Buffer buffer{NoCreate};
+        Fence fence{NoCreate};
+    };
+
+    explicit State(Texture2D& texture, Magnum::PixelFormat format, const Vector2i& tileSize, UnsignedInt stagingBufferCount): texture(texture), format{format}, tileSize{tileSize}, streamer{std::size_t(tileSize.product()*pixelSize(format)), stagingBufferCount} {}
+
+    /* Decomposes a tile ID into a level and tile coordinates */
+    Int levelFor(std::size_t id) const;
+    Range2Di rangeFor(Int level, const Vector2i& tile) const;
+
+    /* Marks the tile and all coarser tiles covering it as requested in
+       current frame */
+    void request(std::size_t id);
+
+    Texture2D& texture;
+    Magnum::PixelFormat format;
+    Vector2i tileSize;
+    UnsignedInt evictionFrameCount{60};
+    Loader loader{};
+    void* loaderState{};
+    UnsignedLong frame{};
+    std::size_t residentCount{}, loadingCount{};
+
+    Containers::Array<Level> levels;
+    Containers::Array<Tile> tiles;
+    Containers::Array<std::size_t> requested;
+    std::size_t requestedCount{};
+
+    TextureStreamer2D streamer;
+    Buffer feedback{NoCreate};
+    Containers::Array<UnsignedInt> feedbackZeros;
+    Readback readbacks[ReadbackCount];
+    std::size_t readbackBegin{}, readbackEnd{};
+
+    /* Accessed from the worker threads */
+    std::mutex mutex;
+    std::deque<Job> queued, finished;
+};
+
+Int SparseTextureStreamer::State::levelFor(const std::size_t id) const {
+    Int level = 0;
+    while(level + 1 != Int(levels.size()) && levels[level + 1].tileOffset <= id)
+        ++level;
+    return level;
+}
+
+Range2Di SparseTextureStreamer::State::rangeFor(const Int level, const Vector2i& tile) const {
+    const Vector2i min = tile*tileSize;
+    return {min, Math::min(min + tileSize, levels[level].size)};
+}
+
+void SparseTextureStreamer::State::request(std::size_t id) {
+    Int level = levelFor(id);
+    Vector2i tile{Int((id - levels[level].tileOffset) % levels[level].tileCount.x()),
+                  Int((id - levels[level].tileOffset)/levels[level].tileCount.x())};
+    for(;;) {
+        Tile& t = tiles[id];
+        t.lastRequestedFrame = frame;
+        if(t.state == TileState::NonResident && !t.requested) {
+            t.requested = true;
+            requested[requestedCount++] = id;
+        }
+
+        if(++level == Int(levels.size())) break;
+        tile = Math::min(tile/2, levels[level].tileCount - Vector2i{1});
+        id = levels[level].tileOffset + tile.y()*levels[level].tileCount.x() + tile.x();
+    }
+}
+
+SparseTextureStreamer::SparseTextureStreamer(Texture2D& texture, const Magnum::PixelFormat format, const Vector2i& size, const Int levelCount, const Vector2i& tileSize, const UnsignedInt stagingBufferCount) {
+    CORRADE_ASSERT(levelCount && stagingBufferCount && tileSize.product(),
+        "GL::SparseTextureStreamer: expected non-zero level count, tile size and staging buffer count, got" << levelCount << Debug::nospace << "," << tileSize << "and" << stagingBufferCount, );
+
+    _state.emplace(texture, format, tileSize, stagingBufferCount);
+    State& state = *_state;
+
+    state.levels = Containers::Array<State::Level>{Containers::NoInit, std::size_t(levelCount)};
+    std::size_t tileCount = 0;
+    for(Int i = 0; i != levelCount; ++i) {
+        State::Level& level = state.levels[i];
+        level.size = Math::max(size >> i, Vector2i{1});
+        level.tileCount = (level.size + tileSize - Vector2i{1})/tileSize;
+        level.tileOffset = tileCount;
+        tileCount += level.tileCount.product();
+    }
+
+    state.tiles = Containers::Array<State::Tile>{Containers::ValueInit, tileCount};
+    state.requested = Containers::Array<std::size_t>{Containers::NoInit, tileCount};
+    state.feedbackZeros = Containers::Array<UnsignedInt>{Containers::ValueInit, tileCount};
+
+    state.feedback = Buffer{Buffer::TargetHint::ShaderStorage};
+    state.feedback.setData(state.feedbackZeros, BufferUsage::DynamicCopy);
+    for(State::Readback& readback: state.readbacks) {
+        readback.buffer = Buffer{Buffer::TargetHint::CopyWrite};
+        readback.buffer.setData({nullptr, tileCount*sizeof(UnsignedInt)}, BufferUsage::StreamRead);
+    }
+}
+
+SparseTextureStreamer::SparseTextureStreamer(NoCreateT) noexcept {}
+
+SparseTextureStreamer::SparseTextureStreamer(SparseTextureStreamer&&) noexcept = default;
+
+/* Acquired staging buffers get implicitly unmapped on deletion */
+SparseTextureStreamer::~SparseTextureStreamer() = default;
+
+SparseTextureStreamer& SparseTextureStreamer::operator=(SparseTextureStreamer&&) noexcept = default;
+
+Magnum::PixelFormat SparseTextureStreamer::format() const { return _state->format; }
+
+Vector2i SparseTextureStreamer::size() const { return _state->levels[0].size; }
+
+Int SparseTextureStreamer::levelCount() const { return _state->levels.size(); }
+
+Vector2i SparseTextureStreamer::tileSize() const { return _state->tileSize; }
+
+Vector2i SparseTextureStreamer::tileCount(const Int level) const {
+    CORRADE_ASSERT(std::size_t(level) < _state->levels.size(),
+        "GL::SparseTextureStreamer::tileCount(): level" << level << "out of range for" << _state->levels.size() << "levels", {});
+    return _state->levels[level].tileCount;
+}
+
+std::size_t SparseTextureStreamer::tileOffset(const Int level) const {
+    CORRADE_ASSERT(std::size_t(level) < _state->levels.size(),
+        "GL::SparseTextureStreamer::tileOffset(): level" << level << "out of range for" << _state->levels.size() << "levels", {});
+    return _state->levels[level].tileOffset;
+}
+
+std::size_t SparseTextureStreamer::totalTileCount() const { return _state->tiles.size(); }
+
+Buffer& SparseTextureStreamer::feedbackBuffer() { return _state->feedback; }
+
+UnsignedInt SparseTextureStreamer::evictionFrameCount() const { return _state->evictionFrameCount; }
+
+SparseTextureStreamer& SparseTextureStreamer::setEvictionFrameCount(const UnsignedInt count) {
+    CORRADE_ASSERT(count,
+        "GL::SparseTextureStreamer::setEvictionFrameCount(): expected a non-zero count", *this);
+    _state->evictionFrameCount = count;
+    return *this;
+}
+
+SparseTextureStreamer& SparseTextureStreamer::setLoader(const Loader loader, void* const state) {
+    _state->loader = loader;
+    _state->loaderState = state;
+    return *this;
+}
+
+UnsignedLong SparseTextureStreamer::frame() const { return _state->frame; }
+
+std::size_t SparseTextureStreamer::residentTileCount() const { return _state->residentCount; }
+
+std::size_t SparseTextureStreamer::loadingTileCount() const { return _state->loadingCount; }
+
+bool SparseTextureStreamer::isResident(const Int level, const Vector2i& tile) const {
+    const State& state = *_state;
+    CORRADE_ASSERT(std::size_t(level) < state.levels.size(),
+        "GL::SparseTextureStreamer::isResident(): level" << level << "out of range for" << state.levels.size() << "levels", {});
+    CORRADE_ASSERT((tile >= Vector2i{}).all() && (tile < state.levels[level].tileCount).all(),
+        "GL::SparseTextureStreamer::isResident(): tile" << tile << "out of range for" << state.levels[level].tileCount << "tiles in level" << level, {});
+    const State::Level& l = state.levels[level];
+    return state.tiles[l.tileOffset + tile.y()*l.tileCount.x() + tile.x()].state == State::TileState::Resident;
+}
+
+void SparseTextureStreamer::request(const Int level, const Vector2i& tile) {
+    State& state = *_state;
+    CORRADE_ASSERT(std::size_t(level) < state.levels.size(),
+        "GL::SparseTextureStreamer::request(): level" << level << "out of range for" << state.levels.size() << "levels", );
+    CORRADE_ASSERT((tile >= Vector2i{}).all() && (tile < state.levels[level].tileCount).all(),
+        "GL::SparseTextureStreamer::request(): tile" << tile << "out of range for" << state.levels[level].tileCount << "tiles in level" << level, );
+    const State::Level& l = state.levels[level];
+    state.request(l.tileOffset + tile.y()*l.tileCount.x() + tile.x());
+}
+
+void SparseTextureStreamer::update() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.loader,
+        "GL::SparseTextureStreamer::update(): no loader set", );
+
+    /* Upload tiles that finished loading. Taking the whole list under the
+       lock so the workers aren't blocked by the uploads. */
+    std::deque<State::Job> finished;
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        finished.swap(state.finished);
+    }
+    for(const State::Job& job: finished) {
+        State::Tile& tile = state.tiles[job.id];
+        --state.loadingCount;
+        if(!job.loaded) {
+            state.streamer.discard(job.staging);
+            tile.state = State::TileState::NonResident;
+            continue;
+        }
+
+        state.texture.setPageCommitment(job.level, job.range, true);
+        state.streamer.upload(job.staging, state.texture, job.level, job.range.min(), PixelStorage{}.setAlignment(1), state.format, job.range.size());
+        tile.state = State::TileState::Resident;
+        ++state.residentCount;
+    }
+
+    /* Process feedback readbacks that the GPU is done with, oldest first.
+       The zero-timeout wait doesn't block but flushes the commands, so the
+       fence is guaranteed to get signaled eventually. */
+    while(state.readbackBegin != state.readbackEnd) {
+        State::Readback& readback = state.readbacks[state.readbackBegin % ReadbackCount];
+        if(readback.fence.clientWait(0) == Fence::WaitResult::TimeoutExpired)
+            break;
+
+        const Containers::ArrayView<const UnsignedInt> values = Containers::arrayCast<const UnsignedInt>(readback.buffer.map(0, state.tiles.size()*sizeof(UnsignedInt), Buffer::MapFlag::Read));
+        for(std::size_t i = 0; i != values.size(); ++i)
+            if(values[i]) state.request(i);
+        readback.buffer.unmap();
+
+        readback.fence = Fence{NoCreate};
+        ++state.readbackBegin;
+    }
+
+    /* Copy the feedback for a readback and clear it for the next frame. If
+       all readbacks are still in flight, the feedback keeps accumulating
+       until the next update. */
+    if(state.readbackEnd - state.readbackBegin != ReadbackCount) {
+        State::Readback& readback = state.readbacks[state.readbackEnd % ReadbackCount];
+        Buffer::copy(state.feedback, readback.buffer, 0, 0, state.tiles.size()*sizeof(UnsignedInt));
+        state.feedback.setSubData(0, state.feedbackZeros);
+        readback.fence = Fence{};
+        ++state.readbackEnd;
+    }
+
+    /* Evict tiles that weren't requested for too long */
+    for(std::size_t i = 0; i != state.tiles.size(); ++i) {
+        State::Tile& tile = state.tiles[i];
+        if(tile.state != State::TileState::Resident || state.frame - tile.lastRequestedFrame < state.evictionFrameCount)
+            continue;
+
+        const Int level = state.levelFor(i);
+        const std::size_t index = i - state.levels[level].tileOffset;
+        const Vector2i coordinates{Int(index % state.levels[level].tileCount.x()),
+                                   Int(index/state.levels[level].tileCount.x())};
+        state.texture.setPageCommitment(level, state.rangeFor(level, coordinates), false);
+        tile.state = State::TileState::NonResident;
+        --state.residentCount;
+    }
+
+    /* Queue loads of requested tiles. Coarser levels have larger IDs, so
+       sorting the IDs in descending order makes them load first. The tiles
+       for which there's no staging buffer left are kept for the next
+       update. */
+    std::sort(state.requested.begin(), state.requested.begin() + state.requestedCount, [](std::size_t a, std::size_t b) { return a > b; });
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i != state.requestedCount; ++i) {
+        const std::size_t id = state.requested[i];
+        State::Tile& tile = state.tiles[id];
+
+        /* Could have been evicted and requested again, or not requested
+           anymore */
+        if(tile.state != State::TileState::NonResident) {
+            tile.requested = false;
+            continue;
+        }
+
+        const Int level = state.levelFor(id);
+        const std::size_t index = id - state.levels[level].tileOffset;
+        const Vector2i coordinates{Int(index % state.levels[level].tileCount.x()),
+                                   Int(index/state.levels[level].tileCount.x())};
+        const Range2Di range = state.rangeFor(level, coordinates);
+
+        Containers::Optional<TextureStreamer2D::Staging> staging;
+        if(!(staging = state.streamer.acquire(range.size().product()*pixelSize(state.format)))) {
+            state.requested[kept++] = id;
+            continue;
+        }
+
+        tile.state = State::TileState::Loading;
+        tile.requested = false;
+        ++state.loadingCount;
+
+        std::lock_guard<std::mutex> lock{state.mutex};
+        state.queued.push_back(State::Job{id, level, coordinates, range, *staging, false});
+    }
+    state.requestedCount = kept;
+
+    ++state.frame;
+}
+
+bool SparseTextureStreamer::load() {
+    State& state = *_state;
+
+    State::Job job;
+    {
+        std::lock_guard<std::mutex> lock{state.mutex};
+        if(state.queued.empty()) return false;
+        job = state.queued.front();
+        state.queued.pop_front();
+    }
+
+    job.loaded = state.loader(job.level, job.tile, MutableImageView2D{PixelStorage{}.setAlignment(1), state.format, job.range.size(), job.staging.data}, state.loaderState);
+
+    std::lock_guard<std::mutex> lock{state.mutex};
+    state.finished.push_back(job);
+    return true;
+}
+
+}}
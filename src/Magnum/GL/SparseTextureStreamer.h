@@ -0,0 +1,317 @@
+#ifndef Magnum_GL_SparseTextureStreamer_h
+#define Magnum_GL_SparseTextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::SparseTextureStreamer
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include <cstddef>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Feedback-driven sparse texture streamer
+@m_since_latest
+
+Streams tiles of a sparse @ref Texture2D in and out based on which parts of it
+got actually sampled. The texture is split into tiles of @ref tileSize(),
+which should be equal to one of the @ref Texture::sparsePageSizes() the
+texture storage was set up with, and tiles in each level are numbered in a
+row-major order, with levels following each other, starting from the largest.
+
+@section GL-SparseTextureStreamer-feedback GPU feedback
+
+Shaders sampling the texture write a non-zero value into the
+@ref feedbackBuffer(), which contains one @glsl uint @ce for each tile, at the
+index of every tile they need. The buffer is bound as a shader storage buffer
+and the index is calculated from @ref tileOffset() and @ref tileCount() of the
+level that is sampled:
+
+@code{.glsl}
+layout(std430, binding = 0) buffer Feedback {
+    uint feedback[];
+};
+
+uniform ivec2 tileCounts[LEVEL_COUNT];
+uniform int tileOffsets[LEVEL_COUNT];
+
+void requestTile(vec2 textureCoordinates) {
+    int level = clamp(int(textureQueryLod(megatexture, textureCoordinates).y),
+                      0, LEVEL_COUNT - 1);
+    ivec2 tile = clamp(ivec2(textureCoordinates*vec2(tileCounts[level])),
+                       ivec2(0), tileCounts[level] - ivec2(1));
+    feedback[tileOffsets[level] + tile.y*tileCounts[level].x + tile.x] = 1u;
+}
+@endcode
+
+Every @ref update() copies the feedback buffer into a staging buffer, clears
+it and, once the GPU is done with the copy, reads it back to schedule loads of
+tiles that were requested. To avoid stalls, the readback happens a few frames
+later. Together with a tile, all coarser tiles covering the same area are
+requested as well and the coarser tiles get loaded first, so the shader can
+fall back to them until the finer tiles arrive. Tiles can be requested also
+manually with @ref request(), for example to load the coarsest levels upfront.
+
+@section GL-SparseTextureStreamer-loading Loading tiles
+
+Tile data are supplied by a @ref Loader function set via @ref setLoader(),
+which gets called with a view pointing directly to mapped pixel buffer memory
+of a @ref TextureStreamer. The loads are executed by @ref load(), which is
+safe to call from any thread --- typically a pool of worker threads decoding
+images calls it in a loop --- while @ref update() uploads the loaded tiles to
+the texture, committing their pages on the GL thread. If a tile comes from
+a @ref Trade::ImageData2D, the loader just copies its pixels to the
+destination:
+
+@snippet MagnumGL.cpp SparseTextureStreamer-usage
+
+Tiles that weren't requested for @ref evictionFrameCount() frames have their
+pages decommitted again, freeing the memory for other tiles.
+
+@section GL-SparseTextureStreamer-limitations Limitations
+
+Only the levels passed to the constructor are streamed, smaller levels that
+form the mip tail of the sparse texture are expected to be committed and
+uploaded by the user. Sampling a tile that isn't resident returns undefined
+values, the shader is expected to clamp the sampled level to tiles that are
+known to be resident, for example by maintaining a minimal LOD texture or
+with @gl_extension{ARB,sparse_texture2}.
+
+The instance references the texture passed in the constructor, which thus
+has to outlive it. Threads calling @ref load() have to finish before the
+instance is destroyed.
+
+@requires_gl43 Extension @gl_extension{ARB,shader_storage_buffer_object}
+@requires_extension Extension @gl_extension{ARB,sparse_texture}
+@requires_gl Sparse textures are not available in OpenGL ES or WebGL.
+*/
+class MAGNUM_GL_EXPORT SparseTextureStreamer {
+    public:
+        /**
+         * @brief Tile loader
+         * @param level         Mip level
+         * @param tile          Tile coordinates in given level
+         * @param destination   Where to put the tile pixels
+         * @param state         State pointer passed to @ref setLoader()
+         * @return Whether the tile was loaded. If @cpp false @ce is
+         *      returned, the tile stays non-resident and gets loaded again
+         *      only after it's requested again.
+         *
+         * The @p destination has @ref format() and a size of the tile,
+         * which can be smaller than @ref tileSize() for tiles at the edge of
+         * a level. Can be called from any thread.
+         */
+        typedef bool(*Loader)(Int level, const Vector2i& tile, const MutableImageView2D& destination, void* state);
+
+        /**
+         * @brief Constructor
+         * @param texture       Sparse texture to stream to
+         * @param format        Format of the tile data
+         * @param size          Size of the largest mip level of the texture
+         * @param levelCount    Count of mip levels to stream
+         * @param tileSize      Tile size
+         * @param stagingBufferCount Count of tiles that can be loaded at the
+         *      same time
+         *
+         * Expects that @p levelCount, @p stagingBufferCount and both
+         * components of @p tileSize are non-zero. The @p texture is expected
+         * to have sparse storage with at least @p levelCount levels set up
+         * with @ref Texture::setSparseStorage().
+         */
+        explicit SparseTextureStreamer(Texture2D& texture, Magnum::PixelFormat format, const Vector2i& size, Int levelCount, const Vector2i& tileSize, UnsignedInt stagingBufferCount = 4);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit SparseTextureStreamer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        SparseTextureStreamer(const SparseTextureStreamer&) = delete;
+
+        /** @brief Move constructor */
+        SparseTextureStreamer(SparseTextureStreamer&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Pending loads are discarded, pages of resident tiles stay
+         * committed.
+         */
+        ~SparseTextureStreamer();
+
+        /** @brief Copying is not allowed */
+        SparseTextureStreamer& operator=(const SparseTextureStreamer&) = delete;
+
+        /** @brief Move assignment */
+        SparseTextureStreamer& operator=(SparseTextureStreamer&&) noexcept;
+
+        /** @brief Format of the tile data */
+        Magnum::PixelFormat format() const;
+
+        /** @brief Size of the largest mip level */
+        Vector2i size() const;
+
+        /** @brief Count of streamed mip levels */
+        Int levelCount() const;
+
+        /** @brief Tile size */
+        Vector2i tileSize() const;
+
+        /**
+         * @brief Tile count in given level
+         *
+         * Expects that @p level is less than @ref levelCount().
+         */
+        Vector2i tileCount(Int level) const;
+
+        /**
+         * @brief Offset of the first tile of given level in the feedback buffer
+         *
+         * Expects that @p level is less than @ref levelCount().
+         */
+        std::size_t tileOffset(Int level) const;
+
+        /** @brief Total tile count in all levels */
+        std::size_t totalTileCount() const;
+
+        /**
+         * @brief Feedback buffer
+         *
+         * Contains @ref totalTileCount() @glsl uint @ce values. See
+         * @ref GL-SparseTextureStreamer-feedback for more information.
+         */
+        Buffer& feedbackBuffer();
+
+        /**
+         * @brief Count of frames after which an unused tile gets evicted
+         *
+         * Default is @cpp 60 @ce.
+         */
+        UnsignedInt evictionFrameCount() const;
+
+        /**
+         * @brief Set count of frames after which an unused tile gets evicted
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p count is non-zero.
+         */
+        SparseTextureStreamer& setEvictionFrameCount(UnsignedInt count);
+
+        /**
+         * @brief Set tile loader
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be called before the first @ref update(). Not thread-safe,
+         * can't be called while @ref load() is running in another thread.
+         */
+        SparseTextureStreamer& setLoader(Loader loader, void* state = nullptr);
+
+        /**
+         * @brief Current frame
+         *
+         * Incremented by every @ref update().
+         */
+        UnsignedLong frame() const;
+
+        /** @brief Count of resident tiles */
+        std::size_t residentTileCount() const;
+
+        /**
+         * @brief Count of tiles being loaded
+         *
+         * Tiles that are either waiting for @ref load(), being loaded or
+         * waiting for an upload in @ref update().
+         */
+        std::size_t loadingTileCount() const;
+
+        /**
+         * @brief Whether a tile is resident
+         *
+         * Expects that @p level is less than @ref levelCount() and @p tile is
+         * less than @ref tileCount() for given level.
+         */
+        bool isResident(Int level, const Vector2i& tile) const;
+
+        /**
+         * @brief Request a tile
+         *
+         * Equivalent to the tile being requested through the
+         * @ref feedbackBuffer() in the current frame, including the coarser
+         * tiles covering it. Expects that @p level is less than
+         * @ref levelCount() and @p tile is less than @ref tileCount() for
+         * given level.
+         */
+        void request(Int level, const Vector2i& tile);
+
+        /**
+         * @brief Update the streaming state
+         *
+         * Uploads tiles finished by @ref load(), processes feedback that got
+         * read back, issues a new feedback readback, evicts tiles that
+         * weren't requested for @ref evictionFrameCount() frames, queues
+         * loads of requested tiles for which there's a free staging buffer
+         * and increments @ref frame(). Expects that a loader was set with
+         * @ref setLoader(). Has to be called from the thread owning the GL
+         * context, once every frame after all draws writing into the
+         * feedback buffer are submitted.
+         */
+        void update();
+
+        /**
+         * @brief Load a queued tile
+         * @return @cpp true @ce if a tile was loaded, @cpp false @ce if no
+         *      tile was queued
+         *
+         * Calls the loader for the oldest queued tile. Thread-safe, can be
+         * called from any thread, including the one owning the GL context.
+         */
+        bool load();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -24,10 +24,12 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Resource.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
@@ -65,12 +67,18 @@ struct AbstractShaderProgramGLTest: OpenGLTester {
     #endif
 
     void linkFailure();
+    void linkAsync();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void binary();
+    void binaryRejected();
+    #endif
     void uniformNotFound();
 
     void uniform();
     void uniformVector();
     void uniformMatrix();
     void uniformArray();
+    void uniformCache();
     #ifndef MAGNUM_TARGET_GLES
     void uniformDouble();
     void uniformDoubleVector();
@@ -104,12 +112,18 @@ AbstractShaderProgramGLTest::AbstractShaderProgramGLTest() {
               #endif
 
               &AbstractShaderProgramGLTest::linkFailure,
+              &AbstractShaderProgramGLTest::linkAsync,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &AbstractShaderProgramGLTest::binary,
+              &AbstractShaderProgramGLTest::binaryRejected,
+              #endif
               &AbstractShaderProgramGLTest::uniformNotFound,
 
               &AbstractShaderProgramGLTest::uniform,
               &AbstractShaderProgramGLTest::uniformVector,
               &AbstractShaderProgramGLTest::uniformMatrix,
               &AbstractShaderProgramGLTest::uniformArray,
+              &AbstractShaderProgramGLTest::uniformCache,
               #ifndef MAGNUM_TARGET_GLES
               &AbstractShaderProgramGLTest::uniformDouble,
               &AbstractShaderProgramGLTest::uniformDoubleVector,
@@ -195,6 +209,12 @@ struct MyPublicShader: AbstractShaderProgram {
     using AbstractShaderProgram::bindFragmentDataLocation;
     #endif
     using AbstractShaderProgram::link;
+    using AbstractShaderProgram::submitLink;
+    using AbstractShaderProgram::checkLink;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    using AbstractShaderProgram::setRetrievableBinary;
+    using AbstractShaderProgram::setBinary;
+    #endif
     using AbstractShaderProgram::uniformLocation;
     #ifndef MAGNUM_TARGET_GLES2
     using AbstractShaderProgram::uniformBlockIndex;
@@ -402,6 +422,143 @@ void AbstractShaderProgramGLTest::linkFailure() {
     CORRADE_VERIFY(!program.link());
 }
 
+void AbstractShaderProgramGLTest::linkAsync() {
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+
+    /* Linking is submitted without waiting for the compilation to finish */
+    vert.submitCompile();
+    frag.submitCompile();
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.submitLink();
+
+    while(!program.isLinkFinished())
+        Utility::System::sleep(100);
+
+    CORRADE_VERIFY(Shader::checkCompile({vert, frag}));
+    CORRADE_VERIFY(program.checkLink());
+    CORRADE_VERIFY(program.isLinkFinished());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(program.uniformLocation("matrix") >= 0);
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void AbstractShaderProgramGLTest::binary() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::ARB::get_program_binary::string() + std::string(" is not supported"));
+    #endif
+
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if(!formatCount)
+        CORRADE_SKIP("The driver doesn't support any program binary formats");
+
+    Utility::Resource rs("AbstractShaderProgramGLTest");
+
+    Shader vert(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Vertex);
+    vert.addSource(rs.get("MyShader.vert"));
+    Shader frag(
+        #ifndef MAGNUM_TARGET_GLES
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        #else
+        Version::GLES200
+        #endif
+        , Shader::Type::Fragment);
+    frag.addSource(rs.get("MyShader.frag"));
+    CORRADE_VERIFY(Shader::compile({vert, frag}));
+
+    MyPublicShader program;
+    program.attachShaders({vert, frag});
+    program.bindAttributeLocation(0, "position");
+    program.setRetrievableBinary(true);
+    CORRADE_VERIFY(program.link());
+
+    std::pair<Containers::Array<char>, GLenum> binary = program.binary();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!binary.first.empty());
+
+    /* The loaded program needs no shaders attached */
+    MyPublicShader loaded;
+    CORRADE_VERIFY(loaded.setBinary(binary.second, binary.first));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(loaded.uniformLocation("matrix") >= 0);
+    CORRADE_VERIFY(loaded.uniformLocation("color") >= 0);
+}
+
+void AbstractShaderProgramGLTest::binaryRejected() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::get_program_binary>())
+        CORRADE_SKIP(Extensions::ARB::get_program_binary::string() + std::string(" is not supported"));
+    #endif
+
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    if(!formatCount)
+        CORRADE_SKIP("The driver doesn't support any program binary formats");
+
+    Containers::Array<GLint> formats{Containers::NoInit, std::size_t(formatCount)};
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats);
+
+    /* A supported format but garbage data. Should fail silently. */
+    const char data[32]{};
+    MyPublicShader program;
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!program.setBinary(formats[0], data));
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "");
+
+    /* An unlinked program has no binary */
+    CORRADE_VERIFY(program.binary().first.empty());
+}
+#endif
+
 void AbstractShaderProgramGLTest::uniformNotFound() {
     MyPublicShader program;
 
@@ -553,6 +710,77 @@ void AbstractShaderProgramGLTest::uniformArray() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+void AbstractShaderProgramGLTest::uniformCache() {
+    MyShader shader;
+    CORRADE_VERIFY(!shader.isUniformCacheEnabled());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Context& context = Context::current();
+    context.resetStateStatistics();
+    const Context::StateStatistics::Counter& statistics = context.stateStatistics().uniformUploads;
+
+    /* Without the cache everything is uploaded */
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    CORRADE_COMPARE(statistics.issued, 2);
+    CORRADE_COMPARE(statistics.elided, 0);
+
+    /* With the cache, only the first of the same values is uploaded */
+    context.resetStateStatistics();
+    shader.setUniformCacheEnabled(true);
+    CORRADE_VERIFY(shader.isUniformCacheEnabled());
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    shader.setUniform(shader.multiplierUniform, 0.35f);
+    shader.setUniform(shader.colorUniform, Vector4(0.3f, 0.7f, 1.0f, 0.25f));
+    shader.setUniform(shader.multiplierUniform, 0.5f);
+    shader.setUniform(shader.colorUniform, Vector4(0.3f, 0.7f, 1.0f, 0.25f));
+    shader.setUniform(shader.multiplierUniform, 0.5f);
+    CORRADE_COMPARE(statistics.issued, 3);
+    CORRADE_COMPARE(statistics.elided, 3);
+
+    /* Uploading a different array size is a cache miss, the same size again
+       a hit */
+    const Vector4 values[] = {
+        {0.5f, 1.0f, 0.4f, 0.0f},
+        {0.0f, 0.1f, 0.7f, 0.3f},
+        {0.9f, 0.8f, 0.3f, 0.1f}
+    };
+    context.resetStateStatistics();
+    shader.setUniform(shader.additionsUniform, values);
+    shader.setUniform(shader.additionsUniform, Containers::arrayView(values).prefix(2));
+    shader.setUniform(shader.additionsUniform, Containers::arrayView(values).prefix(2));
+    shader.setUniform(shader.additionsUniform, values);
+    CORRADE_COMPARE(statistics.issued, 3);
+    CORRADE_COMPARE(statistics.elided, 1);
+
+    /* Nonexistent uniforms are not cached */
+    context.resetStateStatistics();
+    shader.setUniform(-1, 0.5f);
+    shader.setUniform(-1, 0.5f);
+    CORRADE_COMPARE(statistics.issued, 2);
+    CORRADE_COMPARE(statistics.elided, 0);
+
+    /* The cache is preserved on move */
+    MyShader moved{std::move(shader)};
+    CORRADE_VERIFY(moved.isUniformCacheEnabled());
+    CORRADE_VERIFY(!shader.isUniformCacheEnabled());
+    context.resetStateStatistics();
+    moved.setUniform(moved.multiplierUniform, 0.5f);
+    CORRADE_COMPARE(statistics.issued, 0);
+    CORRADE_COMPARE(statistics.elided, 1);
+
+    /* Disabling and enabling the cache discards its contents */
+    context.resetStateStatistics();
+    moved.setUniformCacheEnabled(false)
+        .setUniformCacheEnabled(true);
+    moved.setUniform(moved.multiplierUniform, 0.5f);
+    CORRADE_COMPARE(statistics.issued, 1);
+    CORRADE_COMPARE(statistics.elided, 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 #ifndef MAGNUM_TARGET_GLES
 struct MyDoubleShader: AbstractShaderProgram {
     explicit MyDoubleShader();
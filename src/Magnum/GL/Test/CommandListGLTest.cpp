@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/CommandList.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct CommandListGLTest: OpenGLTester {
+    explicit CommandListGLTest();
+
+    void construct();
+    void constructMove();
+
+    void recordTextureMerging();
+    void replay();
+    void replayMeshView();
+    void clear();
+};
+
+CommandListGLTest::CommandListGLTest() {
+    addTests({&CommandListGLTest::construct,
+              &CommandListGLTest::constructMove,
+
+              &CommandListGLTest::recordTextureMerging,
+              &CommandListGLTest::replay,
+              &CommandListGLTest::replayMeshView,
+              &CommandListGLTest::clear});
+}
+
+struct ColorShader: AbstractShaderProgram {
+    explicit ColorShader();
+
+    Int colorUniform;
+};
+
+ColorShader::ColorShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Fragment);
+    #else
+    Shader vert(Version::GLES200, Shader::Type::Vertex);
+    Shader frag(Version::GLES200, Shader::Type::Fragment);
+    #endif
+
+    vert.addSource(
+        "void main() {\n"
+        "    gl_PointSize = 1.0;\n"
+        "    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define mediump\n"
+        "#endif\n"
+        "#if (defined(GL_ES) && __VERSION__ < 300) || __VERSION__ == 120\n"
+        "#define result gl_FragColor\n"
+        "#endif\n"
+        "uniform mediump vec4 color;\n"
+        "#if (defined(GL_ES) && __VERSION__ >= 300) || (!defined(GL_ES) && __VERSION__ >= 130)\n"
+        "out mediump vec4 result;\n"
+        "#endif\n"
+        "void main() { result = color; }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    colorUniform = uniformLocation("color");
+}
+
+void CommandListGLTest::construct() {
+    CommandList list;
+    CORRADE_COMPARE(list.size(), 0);
+    CORRADE_VERIFY(list.isEmpty());
+}
+
+void CommandListGLTest::constructMove() {
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+
+    CommandList a;
+    a.draw(shader, mesh);
+
+    CommandList b{std::move(a)};
+    CORRADE_COMPARE(b.size(), 1);
+
+    CommandList c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CommandList>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CommandList>::value);
+}
+
+void CommandListGLTest::recordTextureMerging() {
+    Texture2D a, b, c;
+
+    CommandList list;
+
+    /* Adjacent units are merged into a single command */
+    list.bindTexture(0, a)
+        .bindTexture(1, b);
+    CORRADE_COMPARE(list.size(), 1);
+    list.bindTextures(2, {&c, nullptr});
+    CORRADE_COMPARE(list.size(), 1);
+
+    /* A gap in the units is not */
+    list.bindTexture(5, a);
+    CORRADE_COMPARE(list.size(), 2);
+
+    /* Neither is a binding after a different command */
+    ColorShader shader;
+    list.setUniform(shader, shader.colorUniform, Color4{1.0f, 0.5f, 0.25f, 1.0f})
+        .bindTexture(6, b);
+    CORRADE_COMPARE(list.size(), 4);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void CommandListGLTest::replay() {
+    ColorShader shader;
+    shader.setUniformCacheEnabled(true);
+
+    Texture2D texture;
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(1);
+
+    const Color4 colors[]{{1.0f, 0.5f, 0.25f, 1.0f}};
+
+    CommandList list;
+    list.bindTexture(0, texture)
+        .setUniform(shader, shader.colorUniform, Containers::arrayView(colors))
+        .draw(shader, mesh)
+        .setUniform(shader, shader.colorUniform, Color4{1.0f, 0.5f, 0.25f, 1.0f})
+        .draw(shader, mesh);
+    CORRADE_COMPARE(list.size(), 5);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Context& context = Context::current();
+    const Context::StateStatistics& statistics = context.stateStatistics();
+
+    /* First replay uploads the uniform value once, the second time it's the
+       same value so it's elided */
+    context.resetStateStatistics();
+    list.replay();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(statistics.uniformUploads.issued, 1);
+    CORRADE_COMPARE(statistics.uniformUploads.elided, 1);
+
+    /* Second replay has everything already set up, so the only issued calls
+       are the draws themselves */
+    context.resetStateStatistics();
+    list.replay();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(statistics.textureBindings.issued, 0);
+    CORRADE_COMPARE(statistics.uniformUploads.issued, 0);
+    CORRADE_COMPARE(statistics.uniformUploads.elided, 2);
+    CORRADE_COMPARE(statistics.shaderProgramUses.issued, 0);
+}
+
+void CommandListGLTest::replayMeshView() {
+    ColorShader shader;
+
+    Mesh mesh{MeshPrimitive::Points};
+    MeshView view{mesh};
+    view.setCount(1);
+
+    CommandList list;
+    list.draw(shader, view);
+    CORRADE_COMPARE(list.size(), 1);
+
+    /* Changes to the view after recording are reflected */
+    view.setCount(0);
+
+    Context& context = Context::current();
+    context.resetStateStatistics();
+    list.replay();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Zero-count draws are a no-op, so the program isn't even used */
+    CORRADE_COMPARE(context.stateStatistics().shaderProgramUses.issued +
+                    context.stateStatistics().shaderProgramUses.elided, 0);
+}
+
+void CommandListGLTest::clear() {
+    ColorShader shader;
+    Mesh mesh{MeshPrimitive::Points};
+
+    CommandList list;
+    list.setUniform(shader, shader.colorUniform, Color4{})
+        .draw(shader, mesh);
+    CORRADE_COMPARE(list.size(), 2);
+
+    list.clear();
+    CORRADE_COMPARE(list.size(), 0);
+    CORRADE_VERIFY(list.isEmpty());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::CommandListGLTest)
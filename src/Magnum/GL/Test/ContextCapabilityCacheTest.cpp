@@ -0,0 +1,154 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/ContextCapabilityCache.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct ContextCapabilityCacheTest: TestSuite::Tester {
+    explicit ContextCapabilityCacheTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void serializeEmpty();
+    void deserialize();
+    void deserializeInvalid();
+};
+
+ContextCapabilityCacheTest::ContextCapabilityCacheTest() {
+    addTests({&ContextCapabilityCacheTest::construct,
+              &ContextCapabilityCacheTest::constructCopy,
+              &ContextCapabilityCacheTest::constructMove,
+
+              &ContextCapabilityCacheTest::serializeEmpty,
+              &ContextCapabilityCacheTest::deserialize,
+              &ContextCapabilityCacheTest::deserializeInvalid});
+}
+
+/* Little-endian. Two entries, the first with two extensions and detected drivers 0x0102,
+   the second with no extensions and no detected drivers */
+constexpr char Data[]{
+    'M', 'G', 'C', 'C', 1, 0, 0, 0,
+    2, 0, 0, 0,
+        4, 0, 0, 0, 'A', '\n', 'B', '\n',
+        2, 1, 0, 0,
+        2, 0, 0, 0,
+            5, 0, 0, 0, 'G', 'L', '_', 'a', 'b',
+            3, 0, 0, 0, 'G', 'L', '_',
+        1, 0, 0, 0, 'C',
+        0, 0, 0, 0,
+        0, 0, 0, 0
+};
+
+void ContextCapabilityCacheTest::construct() {
+    ContextCapabilityCache cache;
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_VERIFY(cache.isEmpty());
+}
+
+void ContextCapabilityCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ContextCapabilityCache>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ContextCapabilityCache>{});
+}
+
+void ContextCapabilityCacheTest::constructMove() {
+    ContextCapabilityCache a;
+    CORRADE_VERIFY(a.deserialize(Data));
+
+    ContextCapabilityCache b{std::move(a)};
+    CORRADE_COMPARE(b.size(), 2);
+
+    ContextCapabilityCache c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 2);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ContextCapabilityCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ContextCapabilityCache>::value);
+}
+
+void ContextCapabilityCacheTest::serializeEmpty() {
+    ContextCapabilityCache cache;
+    Containers::Array<char> data = cache.serialize();
+    CORRADE_COMPARE_AS(data, Containers::arrayView<char>({
+        'M', 'G', 'C', 'C', 1, 0, 0, 0, 0, 0, 0, 0
+    }), TestSuite::Compare::Container);
+
+    ContextCapabilityCache another;
+    CORRADE_VERIFY(another.deserialize(data));
+    CORRADE_VERIFY(another.isEmpty());
+}
+
+void ContextCapabilityCacheTest::deserialize() {
+    ContextCapabilityCache cache;
+    CORRADE_VERIFY(cache.deserialize(Data));
+    CORRADE_COMPARE(cache.size(), 2);
+
+    /* Serializing gives back the same data */
+    CORRADE_COMPARE_AS(cache.serialize(), Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+
+    /* Deserializing again replaces entries with the same key */
+    CORRADE_VERIFY(cache.deserialize(Data));
+    CORRADE_COMPARE(cache.size(), 2);
+
+    cache.clear();
+    CORRADE_VERIFY(cache.isEmpty());
+}
+
+void ContextCapabilityCacheTest::deserializeInvalid() {
+    ContextCapabilityCache cache;
+    CORRADE_VERIFY(cache.deserialize(Data));
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!cache.deserialize(Containers::arrayView(Data).prefix(3)));
+        CORRADE_VERIFY(!cache.deserialize(Containers::arrayView<char>({'M', 'G', 'C', 'X', 1, 0, 0, 0})));
+        CORRADE_VERIFY(!cache.deserialize(Containers::arrayView<char>({'M', 'G', 'C', 'C', 2, 0, 0, 0})));
+        CORRADE_VERIFY(!cache.deserialize(Containers::arrayView(Data).prefix(sizeof(Data) - 1)));
+        CORRADE_VERIFY(!cache.deserialize(Containers::arrayView<char>({'M', 'G', 'C', 'C', 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\xff', '\xff', '\xff', '\x7f'})));
+    }
+    CORRADE_COMPARE(out.str(),
+        "GL::ContextCapabilityCache::deserialize(): invalid signature\n"
+        "GL::ContextCapabilityCache::deserialize(): invalid signature\n"
+        "GL::ContextCapabilityCache::deserialize(): unsupported format version\n"
+        "GL::ContextCapabilityCache::deserialize(): invalid or truncated data\n"
+        "GL::ContextCapabilityCache::deserialize(): invalid or truncated data\n");
+
+    /* The cache stays unchanged */
+    CORRADE_COMPARE(cache.size(), 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::ContextCapabilityCacheTest)
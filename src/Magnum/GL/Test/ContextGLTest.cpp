@@ -24,10 +24,22 @@
 */
 
 #include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
+#include "Magnum/GL/ContextCapabilityCache.h"
+#include "Magnum/GL/CubeMapTexture.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Platform/GLContext.h"
 
 #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -52,6 +64,27 @@ struct ContextGLTest: OpenGLTester {
     void supportedVersion();
     void isExtensionSupported();
     void isExtensionDisabled();
+
+    void capabilityCache();
+
+    void stateStatistics();
+    void deferredBindingTexture();
+    void deferredBindingTextureReplaced();
+    void deferredBindingTextureUnbind();
+    void deferredBindingTextureDestroyed();
+    #ifndef MAGNUM_TARGET_GLES2
+    void deferredBindingUniformBuffer();
+    void deferredBindingUniformBufferDestroyed();
+    #endif
+
+    void resourceTrackingBuffer();
+    void resourceTrackingTextureStorage();
+    void resourceTrackingTextureImage();
+    void resourceTrackingRenderbuffer();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void resourceTrackingLabel();
+    #endif
+    void resourceTrackingDisable();
 };
 
 ContextGLTest::ContextGLTest() {
@@ -68,7 +101,28 @@ ContextGLTest::ContextGLTest() {
         #endif
         &ContextGLTest::supportedVersion,
         &ContextGLTest::isExtensionSupported,
-        &ContextGLTest::isExtensionDisabled});
+        &ContextGLTest::isExtensionDisabled,
+
+        &ContextGLTest::capabilityCache,
+
+        &ContextGLTest::stateStatistics,
+        &ContextGLTest::deferredBindingTexture,
+        &ContextGLTest::deferredBindingTextureReplaced,
+        &ContextGLTest::deferredBindingTextureUnbind,
+        &ContextGLTest::deferredBindingTextureDestroyed,
+        #ifndef MAGNUM_TARGET_GLES2
+        &ContextGLTest::deferredBindingUniformBuffer,
+        &ContextGLTest::deferredBindingUniformBufferDestroyed,
+        #endif
+
+        &ContextGLTest::resourceTrackingBuffer,
+        &ContextGLTest::resourceTrackingTextureStorage,
+        &ContextGLTest::resourceTrackingTextureImage,
+        &ContextGLTest::resourceTrackingRenderbuffer,
+        #ifndef MAGNUM_TARGET_WEBGL
+        &ContextGLTest::resourceTrackingLabel,
+        #endif
+        &ContextGLTest::resourceTrackingDisable});
 }
 
 void ContextGLTest::makeCurrent() {
@@ -199,6 +253,451 @@ void ContextGLTest::isExtensionDisabled() {
     #endif
 }
 
+std::vector<std::string> extensionNames(const Context& context) {
+    std::vector<std::string> out;
+    for(const Extension& extension: context.supportedExtensions())
+        out.push_back(extension.string());
+    return out;
+}
+
+void ContextGLTest::capabilityCache() {
+    Context& current = Context::current();
+    const std::vector<std::string> expected = extensionNames(current);
+    const Context::DetectedDrivers expectedDrivers = current.detectedDriver();
+
+    ContextCapabilityCache cache;
+    Context::setCapabilityCache(&cache);
+    CORRADE_COMPARE(Context::capabilityCache(), &cache);
+
+    Context::makeCurrent(nullptr);
+
+    /* First context populates the cache */
+    {
+        const char* argv[]{"", "--magnum-log", "off"};
+        Platform::GLContext ctx{Int(Containers::arraySize(argv)), argv};
+        CORRADE_COMPARE(cache.size(), 1);
+        CORRADE_COMPARE_AS(extensionNames(ctx), expected,
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(ctx.detectedDriver(), expectedDrivers);
+    }
+
+    /* Second context takes the extensions and drivers from it, ending up with
+       the same result */
+    {
+        const char* argv[]{"", "--magnum-log", "off"};
+        Platform::GLContext ctx{Int(Containers::arraySize(argv)), argv};
+        CORRADE_COMPARE(cache.size(), 1);
+        CORRADE_COMPARE_AS(extensionNames(ctx), expected,
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE(ctx.detectedDriver(), expectedDrivers);
+    }
+
+    /* A roundtrip through serialization gives back the same */
+    Containers::Array<char> data = cache.serialize();
+    ContextCapabilityCache another;
+    CORRADE_VERIFY(another.deserialize(data));
+    CORRADE_COMPARE(another.size(), 1);
+
+    Context::setCapabilityCache(nullptr);
+    CORRADE_VERIFY(!Context::capabilityCache());
+    Context::makeCurrent(&current);
+}
+
+void ContextGLTest::stateStatistics() {
+    Context& context = Context::current();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+
+    /* Make sure the texture isn't bound to unit 0 */
+    Texture2D::unbind(0);
+
+    context.resetStateStatistics();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 0);
+
+    texture.bind(0);
+    texture.bind(0);
+    texture.bind(0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 1);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 2);
+
+    context.resetStateStatistics();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 0);
+}
+
+void ContextGLTest::deferredBindingTexture() {
+    Context& context = Context::current();
+
+    Texture2D a, b;
+    a.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    b.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    Texture2D::unbind(0);
+    Texture2D::unbind(1);
+
+    CORRADE_VERIFY(!context.isDeferredBinding());
+    context.setDeferredBinding(true);
+    CORRADE_VERIFY(context.isDeferredBinding());
+    context.resetStateStatistics();
+
+    a.bind(0);
+    b.bind(1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Nothing issued yet */
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 0);
+
+    /* Disabling issues the recorded bindings, with a single multi-bind call
+       if possible */
+    context.setDeferredBinding(false);
+    CORRADE_VERIFY(!context.isDeferredBinding());
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::ARB::multi_bind>()) {
+        CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 1);
+        CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 1);
+    } else
+    #endif
+    {
+        CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 2);
+        CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 0);
+    }
+
+    /* The bindings are now tracked as done */
+    context.resetStateStatistics();
+    a.bind(0);
+    b.bind(1);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 2);
+}
+
+void ContextGLTest::deferredBindingTextureReplaced() {
+    Context& context = Context::current();
+
+    Texture2D a, b;
+    a.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    b.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    Texture2D::unbind(0);
+
+    context.setDeferredBinding(true);
+    context.resetStateStatistics();
+
+    /* The first binding never gets issued */
+    a.bind(0);
+    b.bind(0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 1);
+
+    context.setDeferredBinding(false);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 1);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 1);
+
+    /* B is bound, a isn't */
+    b.bind(0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 1);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 2);
+    a.bind(0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 2);
+}
+
+void ContextGLTest::deferredBindingTextureUnbind() {
+    Context& context = Context::current();
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    Texture2D::unbind(0);
+
+    context.setDeferredBinding(true);
+    context.resetStateStatistics();
+
+    /* The unbinding is done immediately and drops the recorded binding. The
+       unit is already unbound so nothing is issued at all. */
+    texture.bind(0);
+    Texture2D::unbind(0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.elided, 2);
+
+    context.setDeferredBinding(false);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+}
+
+void ContextGLTest::deferredBindingTextureDestroyed() {
+    Context& context = Context::current();
+
+    context.setDeferredBinding(true);
+
+    {
+        Texture2D texture;
+        texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+        context.resetStateStatistics();
+        texture.bind(0);
+    }
+
+    /* The destroyed texture isn't bound */
+    context.setDeferredBinding(false);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().textureBindings.issued, 0);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void ContextGLTest::deferredBindingUniformBuffer() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::ARB::uniform_buffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Context& context = Context::current();
+
+    Buffer a, b;
+    a.setData({nullptr, 1024});
+    b.setData({nullptr, 1024});
+
+    context.setDeferredBinding(true);
+    context.resetStateStatistics();
+
+    a.bind(Buffer::Target::Uniform, 0, 0, 256);
+    b.bind(Buffer::Target::Uniform, 1, 256, 256);
+    b.bind(Buffer::Target::Uniform, 2);
+    /* Replaces the previous binding to the same point */
+    a.bind(Buffer::Target::Uniform, 3, 0, 256);
+    a.bind(Buffer::Target::Uniform, 3);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.issued, 0);
+    CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.elided, 1);
+
+    /* Bound with one call for the range bindings and one call for the
+       whole-buffer bindings if multi-bind is available */
+    context.setDeferredBinding(false);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    #ifndef MAGNUM_TARGET_GLES
+    if(context.isExtensionSupported<Extensions::ARB::multi_bind>()) {
+        CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.issued, 2);
+        CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.elided, 3);
+    } else
+    #endif
+    {
+        CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.issued, 4);
+        CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.elided, 1);
+    }
+}
+
+void ContextGLTest::deferredBindingUniformBufferDestroyed() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(Extensions::ARB::uniform_buffer_object::string() + std::string(" is not available."));
+    #endif
+
+    Context& context = Context::current();
+
+    context.setDeferredBinding(true);
+    context.resetStateStatistics();
+
+    {
+        Buffer buffer;
+        buffer.setData({nullptr, 1024});
+        buffer.bind(Buffer::Target::Uniform, 0);
+    }
+
+    /* The destroyed buffer isn't bound */
+    context.setDeferredBinding(false);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.stateStatistics().uniformBufferBindings.issued, 0);
+}
+#endif
+
+void ContextGLTest::resourceTrackingBuffer() {
+    Context& context = Context::current();
+
+    /* Created before tracking got enabled, not counted */
+    Buffer untracked;
+    untracked.setData({nullptr, 4096});
+
+    CORRADE_VERIFY(!context.isResourceTracking());
+    context.setResourceTracking(true);
+    CORRADE_VERIFY(context.isResourceTracking());
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 0);
+    CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 0);
+
+    {
+        Buffer a, b;
+        CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 2);
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 0);
+
+        a.setData({nullptr, 1024});
+        b.setData({nullptr, 256});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 1280);
+
+        /* Reallocation replaces the previous size */
+        a.setData({nullptr, 512});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 768);
+        CORRADE_COMPARE(context.resourceMemory(), 768);
+
+        /* Moves don't affect anything */
+        Buffer c = std::move(b);
+        CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 2);
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 768);
+
+        untracked.setData({nullptr, 2048});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 768);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 0);
+    CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Buffer), 0);
+
+    context.setResourceTracking(false);
+}
+
+void ContextGLTest::resourceTrackingTextureStorage() {
+    Context& context = Context::current();
+    context.setResourceTracking(true);
+
+    {
+        /* 8x8 + 4x4 + 2x2 RGBA8 levels */
+        Texture2D texture;
+        texture.setStorage(3, TextureFormat::RGBA8, {8, 8});
+        CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Texture), 1);
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 336);
+
+        /* Six 4x4 RGBA8 faces */
+        CubeMapTexture cubeMap;
+        cubeMap.setStorage(1, TextureFormat::RGBA8, {4, 4});
+        CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Texture), 2);
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 336 + 384);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Texture), 0);
+    CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 0);
+
+    context.setResourceTracking(false);
+}
+
+void ContextGLTest::resourceTrackingTextureImage() {
+    Context& context = Context::current();
+    context.setResourceTracking(true);
+
+    const char data[4*4*4]{};
+    #ifndef MAGNUM_TARGET_GLES2
+    constexpr TextureFormat format = TextureFormat::RGBA8;
+    #else
+    constexpr TextureFormat format = TextureFormat::RGBA;
+    #endif
+
+    {
+        Texture2D texture;
+        texture.setImage(0, format, ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, data});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 64);
+
+        texture.setImage(1, format, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 80);
+
+        /* Replacing a level replaces its size */
+        texture.setImage(0, format, ImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, data});
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 32);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Texture), 0);
+
+    context.setResourceTracking(false);
+}
+
+void ContextGLTest::resourceTrackingRenderbuffer() {
+    Context& context = Context::current();
+    context.setResourceTracking(true);
+
+    {
+        Renderbuffer renderbuffer;
+        CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Renderbuffer), 1);
+
+        /* RGBA4 isn't among generic formats, so it's estimated as four bytes
+           per pixel as well */
+        renderbuffer.setStorage(
+            #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+            RenderbufferFormat::RGBA8,
+            #else
+            RenderbufferFormat::RGBA4,
+            #endif
+            {4, 4});
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Renderbuffer), 64);
+    }
+
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Renderbuffer), 0);
+    CORRADE_COMPARE(context.resourceMemory(Context::ResourceType::Renderbuffer), 0);
+
+    context.setResourceTracking(false);
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void ContextGLTest::resourceTrackingLabel() {
+    Context& context = Context::current();
+    context.setResourceTracking(true);
+
+    {
+        /* Labels are tracked even if the debug extensions aren't supported */
+        Buffer a, b, c;
+        a.setData({nullptr, 128})
+         .setLabel("terrain");
+        b.setData({nullptr, 64})
+         .setLabel("terrain");
+        c.setData({nullptr, 32})
+         .setLabel("ui");
+
+        Texture2D texture;
+        texture.setStorage(1, TextureFormat::RGBA8, {4, 4})
+            .setLabel("terrain");
+
+        CORRADE_COMPARE(context.resourceCount("terrain"), 3);
+        CORRADE_COMPARE(context.resourceMemory("terrain"), 128 + 64 + 64);
+        CORRADE_COMPARE(context.resourceCount("ui"), 1);
+        CORRADE_COMPARE(context.resourceMemory("ui"), 32);
+        CORRADE_COMPARE(context.resourceCount("nonexistent"), 0);
+        CORRADE_COMPARE(context.resourceMemory("nonexistent"), 0);
+
+        /* Relabeling moves the resource to another label */
+        b.setLabel("ui");
+        CORRADE_COMPARE(context.resourceCount("terrain"), 2);
+        CORRADE_COMPARE(context.resourceMemory("ui"), 96);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    CORRADE_COMPARE(context.resourceCount("terrain"), 0);
+    CORRADE_COMPARE(context.resourceMemory("terrain"), 0);
+
+    context.setResourceTracking(false);
+}
+#endif
+
+void ContextGLTest::resourceTrackingDisable() {
+    Context& context = Context::current();
+    context.setResourceTracking(true);
+
+    Buffer buffer;
+    buffer.setData({nullptr, 1024});
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 1);
+    CORRADE_COMPARE(context.resourceMemory(), 1024);
+
+    /* Disabling discards everything */
+    context.setResourceTracking(false);
+    CORRADE_COMPARE(context.resourceCount(Context::ResourceType::Buffer), 0);
+    CORRADE_COMPARE(context.resourceMemory(), 0);
+
+    /* Re-enabling doesn't know about the buffer anymore, destroying it or
+       changing its size is a no-op */
+    context.setResourceTracking(true);
+    buffer.setData({nullptr, 2048});
+    CORRADE_COMPARE(context.resourceMemory(), 0);
+
+    context.setResourceTracking(false);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ContextGLTest)
@@ -49,6 +49,7 @@ struct ContextTest: TestSuite::Tester {
 
     void debugDetectedDriver();
     void debugDetectedDrivers();
+    void debugResourceType();
 };
 
 ContextTest::ContextTest() {
@@ -63,7 +64,8 @@ ContextTest::ContextTest() {
               &ContextTest::debugFlags,
 
               &ContextTest::debugDetectedDriver,
-              &ContextTest::debugDetectedDrivers});
+              &ContextTest::debugDetectedDrivers,
+              &ContextTest::debugResourceType});
 }
 
 void ContextTest::constructNoCreate() {
@@ -235,6 +237,12 @@ void ContextTest::debugDetectedDrivers() {
     #endif
 }
 
+void ContextTest::debugResourceType() {
+    std::ostringstream out;
+    Debug{&out} << Context::ResourceType::Renderbuffer << Context::ResourceType(0xde);
+    CORRADE_COMPARE(out.str(), "GL::Context::ResourceType::Renderbuffer GL::Context::ResourceType(0xde)\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ContextTest)
@@ -0,0 +1,352 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+/* Measures CPU-side throughput of the various draw paths and of state changes
+   between draws. Each benchmark iteration issues DrawCount draws of a single
+   triangle and then waits for the GPU to finish, so the numbers include the
+   whole driver round trip. */
+
+struct DrawBenchmarkGLTest: OpenGLTester {
+    explicit DrawBenchmarkGLTest();
+
+    void individualMeshView();
+    void individualMesh();
+    void multiDraw();
+    #ifndef MAGNUM_TARGET_GLES2
+    void instanced();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    void indirect();
+    #endif
+
+    void stateChangeUniform();
+    void stateChangeShader();
+    void stateChangeTexture();
+
+    private:
+        Renderbuffer _color;
+        Framebuffer _framebuffer{{{}, Vector2i{32}}};
+        Buffer _vertices;
+        Mesh _mesh;
+        Containers::Array<MeshView> _views;
+        Containers::Array<Containers::Reference<MeshView>> _viewReferences;
+        Containers::Array<Mesh> _meshes;
+};
+
+enum: std::size_t { DrawCount = 1000 };
+
+using namespace Math::Literals;
+
+struct DrawShader: AbstractShaderProgram {
+    typedef Attribute<0, Vector2> Position;
+
+    explicit DrawShader();
+
+    DrawShader& setColor(const Color4& color) {
+        setUniform(_colorUniform, color);
+        return *this;
+    }
+
+    private:
+        Int _colorUniform;
+};
+
+DrawShader::DrawShader() {
+    #ifndef MAGNUM_TARGET_GLES
+    Shader vert(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Vertex);
+    Shader frag(
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        , Shader::Type::Fragment);
+    #elif defined(MAGNUM_TARGET_GLES2)
+    Shader vert(Version::GLES200, Shader::Type::Vertex);
+    Shader frag(Version::GLES200, Shader::Type::Fragment);
+    #else
+    Shader vert(Version::GLES300, Shader::Type::Vertex);
+    Shader frag(Version::GLES300, Shader::Type::Fragment);
+    #endif
+
+    vert.addSource(
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define highp\n"
+        "#endif\n"
+        "#if (defined(GL_ES) && __VERSION__ < 300) || __VERSION__ == 120\n"
+        "#define in attribute\n"
+        "#endif\n"
+        "in highp vec2 position;\n"
+        "void main() {\n"
+        "    gl_Position = vec4(position, 0.0, 1.0);\n"
+        "}\n");
+    frag.addSource(
+        "#if !defined(GL_ES) && __VERSION__ == 120\n"
+        "#define lowp\n"
+        "#endif\n"
+        "#if (defined(GL_ES) && __VERSION__ < 300) || __VERSION__ == 120\n"
+        "#define result gl_FragColor\n"
+        "#endif\n"
+        "uniform lowp vec4 color;\n"
+        "#if (defined(GL_ES) && __VERSION__ >= 300) || (!defined(GL_ES) && __VERSION__ >= 130)\n"
+        "out lowp vec4 result;\n"
+        "#endif\n"
+        "void main() { result = color; }\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    bindAttributeLocation(Position::Location, "position");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _colorUniform = uniformLocation("color");
+}
+
+DrawBenchmarkGLTest::DrawBenchmarkGLTest() {
+    addBenchmarks({&DrawBenchmarkGLTest::individualMeshView,
+                   &DrawBenchmarkGLTest::individualMesh,
+                   &DrawBenchmarkGLTest::multiDraw,
+                   #ifndef MAGNUM_TARGET_GLES2
+                   &DrawBenchmarkGLTest::instanced,
+                   #endif
+                   #ifndef MAGNUM_TARGET_GLES
+                   &DrawBenchmarkGLTest::indirect,
+                   #endif
+
+                   &DrawBenchmarkGLTest::stateChangeUniform,
+                   &DrawBenchmarkGLTest::stateChangeShader,
+                   &DrawBenchmarkGLTest::stateChangeTexture}, 10);
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    _color.setStorage(
+        #if !(defined(MAGNUM_TARGET_WEBGL) && defined(MAGNUM_TARGET_GLES2))
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i{32});
+    _framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment{0}, _color)
+        .bind();
+
+    /* A small triangle for each draw, spread over the viewport so the
+       rasterizer doesn't become the bottleneck */
+    Containers::Array<Vector2> positions{Containers::NoInit, DrawCount*3};
+    for(std::size_t i = 0; i != DrawCount; ++i) {
+        const Vector2 offset{Float(i % 32)/16.0f - 1.0f, Float(i/32 % 32)/16.0f - 1.0f};
+        positions[i*3 + 0] = offset;
+        positions[i*3 + 1] = offset + Vector2::xAxis(1.0f/16.0f);
+        positions[i*3 + 2] = offset + Vector2::yAxis(1.0f/16.0f);
+    }
+    _vertices.setData(positions, BufferUsage::StaticDraw);
+
+    /* One mesh with a view for each triangle */
+    _mesh.setCount(3)
+        .addVertexBuffer(_vertices, 0, DrawShader::Position{});
+    for(std::size_t i = 0; i != DrawCount; ++i) {
+        MeshView& view = arrayAppend(_views, Containers::InPlaceInit, _mesh);
+        view.setCount(3)
+            .setBaseVertex(Int(i*3));
+    }
+    for(MeshView& view: _views)
+        arrayAppend(_viewReferences, Containers::InPlaceInit, view);
+
+    /* A separate mesh (and thus a separate VAO, if supported) for each
+       triangle */
+    for(std::size_t i = 0; i != DrawCount; ++i) {
+        Mesh& mesh = arrayAppend(_meshes, Containers::InPlaceInit);
+        mesh.setCount(3)
+            .addVertexBuffer(_vertices, i*3*sizeof(Vector2), DrawShader::Position{});
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawBenchmarkGLTest::individualMeshView() {
+    DrawShader shader;
+
+    CORRADE_BENCHMARK(1) {
+        for(MeshView& view: _views)
+            shader.draw(view);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawBenchmarkGLTest::individualMesh() {
+    DrawShader shader;
+
+    CORRADE_BENCHMARK(1) {
+        for(Mesh& mesh: _meshes)
+            shader.draw(mesh);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawBenchmarkGLTest::multiDraw() {
+    DrawShader shader;
+
+    /* Falls back to individual draws if multi-draw isn't supported by the
+       driver */
+    CORRADE_BENCHMARK(1) {
+        shader.draw(_viewReferences);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DrawBenchmarkGLTest::instanced() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!Context::current().isExtensionSupported<Extensions::ARB::draw_instanced>())
+        CORRADE_SKIP(Extensions::ARB::draw_instanced::string() + std::string(" is not available."));
+    #endif
+
+    DrawShader shader;
+
+    /* All instances are drawn at the same place as there's no per-instance
+       data, which doesn't matter for the measured overhead */
+    MeshView view{_mesh};
+    view.setCount(3)
+        .setInstanceCount(DrawCount);
+
+    CORRADE_BENCHMARK(1) {
+        shader.draw(view);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void DrawBenchmarkGLTest::indirect() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    /* Count, instance count, first and base instance */
+    Containers::Array<Vector4ui> commandData{Containers::NoInit, DrawCount};
+    for(std::size_t i = 0; i != DrawCount; ++i)
+        commandData[i] = {3, 1, UnsignedInt(i*3), 0};
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    DrawShader shader;
+
+    CORRADE_BENCHMARK(1) {
+        shader.drawIndirect(_mesh, commands, 0, DrawCount);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+void DrawBenchmarkGLTest::stateChangeUniform() {
+    DrawShader shader;
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != DrawCount; ++i)
+            shader.setColor(i % 2 ? 0xff3366ff_rgbaf : 0x3366ffff_rgbaf)
+                .draw(_views[i]);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawBenchmarkGLTest::stateChangeShader() {
+    DrawShader shaders[2];
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != DrawCount; ++i)
+            shaders[i % 2].draw(_views[i]);
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void DrawBenchmarkGLTest::stateChangeTexture() {
+    DrawShader shader;
+
+    /* The shader doesn't sample the textures, but the binding still goes
+       through the state tracker and the driver */
+    Texture2D textures[2];
+    for(Texture2D& texture: textures) texture.setStorage(1,
+        #ifndef MAGNUM_TARGET_GLES2
+        TextureFormat::RGBA8,
+        #else
+        TextureFormat::RGBA,
+        #endif
+        Vector2i{4});
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != DrawCount; ++i) {
+            textures[i % 2].bind(0);
+            shader.draw(_views[i]);
+        }
+        Renderer::finish();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::DrawBenchmarkGLTest)
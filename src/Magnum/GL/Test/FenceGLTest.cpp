@@ -0,0 +1,159 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Fence.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct FenceGLTest: OpenGLTester {
+    explicit FenceGLTest();
+
+    void construct();
+    void constructMove();
+    void wrap();
+
+    void isSignaled();
+    void clientWait();
+    void wait();
+};
+
+FenceGLTest::FenceGLTest() {
+    addTests({&FenceGLTest::construct,
+              &FenceGLTest::constructMove,
+              &FenceGLTest::wrap,
+
+              &FenceGLTest::isSignaled,
+              &FenceGLTest::clientWait,
+              &FenceGLTest::wait});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sync>())  \
+        CORRADE_SKIP(Extensions::ARB::sync::string() + std::string(" is not available."))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+void FenceGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    {
+        const Fence fence;
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(fence.id());
+        CORRADE_VERIFY(glIsSync(fence.id()));
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void FenceGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Fence a;
+    const GLsync id = a.id();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(id);
+
+    Fence b{std::move(a)};
+    CORRADE_VERIFY(!a.id());
+    CORRADE_COMPARE(b.id(), id);
+
+    Fence c;
+    const GLsync cId = c.id();
+    c = std::move(b);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cId);
+    CORRADE_COMPARE(b.id(), cId);
+    CORRADE_COMPARE(c.id(), id);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Fence>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Fence>::value);
+}
+
+void FenceGLTest::wrap() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    GLsync id = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    /* Releasing won't delete anything */
+    {
+        auto fence = Fence::wrap(id, ObjectFlag::DeleteOnDestruction);
+        CORRADE_COMPARE(fence.release(), id);
+    }
+
+    /* ...so we can wrap it again */
+    Fence::wrap(id);
+    CORRADE_VERIFY(glIsSync(id));
+    glDeleteSync(id);
+}
+
+void FenceGLTest::isSignaled() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Fence fence;
+    Renderer::finish();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(fence.isSignaled());
+}
+
+void FenceGLTest::clientWait() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Fence fence;
+    /* Not testing the result here, as that depends on how fast the GPU is.
+       Zero timeout is the only one allowed on WebGL. */
+    const Fence::WaitResult result = fence.clientWait(0);
+    CORRADE_VERIFY(result == Fence::WaitResult::AlreadySignaled ||
+                   result == Fence::WaitResult::TimeoutExpired);
+    Renderer::finish();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(fence.clientWait(0), Fence::WaitResult::AlreadySignaled);
+}
+
+void FenceGLTest::wait() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Fence fence;
+    fence.wait();
+    Renderer::finish();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(fence.isSignaled());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::FenceGLTest)
@@ -0,0 +1,513 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/FrameGraph.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/OpenGL.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct FrameGraphGLTest: OpenGLTester {
+    explicit FrameGraphGLTest();
+
+    void construct();
+    void constructMove();
+
+    void compile();
+    void compileAliasing();
+    void compileAliasingDifferentFormat();
+    void compileOutput();
+    void compileUnusedResource();
+    void compileNoWrites();
+    void compileReadWrite();
+
+    void execute();
+    void executeNotCompiled();
+
+    void pool();
+
+    void invalidSize();
+    void addPassNullFunction();
+    void outOfRange();
+    void readRenderbuffer();
+    void accessNotCompiled();
+    void accessWrongType();
+};
+
+FrameGraphGLTest::FrameGraphGLTest() {
+    addTests({&FrameGraphGLTest::construct,
+              &FrameGraphGLTest::constructMove,
+
+              &FrameGraphGLTest::compile,
+              &FrameGraphGLTest::compileAliasing,
+              &FrameGraphGLTest::compileAliasingDifferentFormat,
+              &FrameGraphGLTest::compileOutput,
+              &FrameGraphGLTest::compileUnusedResource,
+              &FrameGraphGLTest::compileNoWrites,
+              &FrameGraphGLTest::compileReadWrite,
+
+              &FrameGraphGLTest::execute,
+              &FrameGraphGLTest::executeNotCompiled,
+
+              &FrameGraphGLTest::pool,
+
+              &FrameGraphGLTest::invalidSize,
+              &FrameGraphGLTest::addPassNullFunction,
+              &FrameGraphGLTest::outOfRange,
+              &FrameGraphGLTest::readRenderbuffer,
+              &FrameGraphGLTest::accessNotCompiled,
+              &FrameGraphGLTest::accessWrongType});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NO_FRAMEBUFFER_OBJECT()                                     \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::framebuffer_object>()) \
+        CORRADE_SKIP(Extensions::ARB::framebuffer_object::string() + std::string(" is not available."))
+#else
+#define SKIP_IF_NO_FRAMEBUFFER_OBJECT()
+#endif
+
+constexpr TextureFormat ColorFormat =
+    #ifndef MAGNUM_TARGET_GLES2
+    TextureFormat::RGBA8
+    #else
+    TextureFormat::RGBA
+    #endif
+    ;
+
+void noop(Framebuffer&, void*) {}
+
+void FrameGraphGLTest::construct() {
+    FrameGraph graph;
+    CORRADE_COMPARE(graph.resourceCount(), 0);
+    CORRADE_COMPARE(graph.passCount(), 0);
+    CORRADE_COMPARE(graph.attachmentCount(), 0);
+    CORRADE_VERIFY(!graph.isCompiled());
+}
+
+void FrameGraphGLTest::constructMove() {
+    FrameGraph a;
+    a.addTexture(ColorFormat, {16, 16});
+
+    FrameGraph b{std::move(a)};
+    CORRADE_COMPARE(b.resourceCount(), 1);
+
+    FrameGraph c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.resourceCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FrameGraph>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FrameGraph>::value);
+}
+
+void FrameGraphGLTest::compile() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    UnsignedInt color = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt depth = graph.addRenderbuffer(RenderbufferFormat::DepthComponent16, {16, 16});
+    CORRADE_COMPARE(color, 0);
+    CORRADE_COMPARE(depth, 1);
+    CORRADE_COMPARE(graph.resourceCount(), 2);
+
+    UnsignedInt pass = graph.addPass({{}, {16, 16}}, noop);
+    CORRADE_COMPARE(pass, 0);
+    CORRADE_COMPARE(graph.passCount(), 1);
+    graph.write(pass, color, Framebuffer::ColorAttachment{0})
+         .write(pass, depth, Framebuffer::BufferAttachment::Depth)
+         .setOutput(color);
+
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(graph.isCompiled());
+    CORRADE_COMPARE(graph.attachmentCount(), 2);
+    CORRADE_VERIFY(graph.texture(color).id());
+    CORRADE_VERIFY(graph.renderbuffer(depth).id());
+
+    /* Any modification makes it not compiled again */
+    graph.addPass({{}, {16, 16}}, noop);
+    CORRADE_VERIFY(!graph.isCompiled());
+}
+
+void FrameGraphGLTest::compileAliasing() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    /* a -> b -> c, c can reuse the texture of a */
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt c = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass0 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass1 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass2 = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass0, a, Framebuffer::ColorAttachment{0})
+         .read(pass1, a)
+         .write(pass1, b, Framebuffer::ColorAttachment{0})
+         .read(pass2, b)
+         .write(pass2, c, Framebuffer::ColorAttachment{0})
+         .setOutput(c);
+
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(graph.attachmentCount(), 2);
+    CORRADE_COMPARE(graph.texture(a).id(), graph.texture(c).id());
+    CORRADE_VERIFY(graph.texture(a).id() != graph.texture(b).id());
+}
+
+void FrameGraphGLTest::compileAliasingDifferentFormat() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addTexture(ColorFormat, {16, 16});
+    /* Different size */
+    UnsignedInt c = graph.addTexture(ColorFormat, {8, 8});
+    UnsignedInt pass0 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass1 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass2 = graph.addPass({{}, {8, 8}}, noop);
+    graph.write(pass0, a, Framebuffer::ColorAttachment{0})
+         .read(pass1, a)
+         .write(pass1, b, Framebuffer::ColorAttachment{0})
+         .read(pass2, b)
+         .write(pass2, c, Framebuffer::ColorAttachment{0});
+
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(graph.attachmentCount(), 3);
+}
+
+void FrameGraphGLTest::compileOutput() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    /* a is an output, so c can't reuse its texture */
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt c = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass0 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass1 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass2 = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass0, a, Framebuffer::ColorAttachment{0})
+         .read(pass1, a)
+         .write(pass1, b, Framebuffer::ColorAttachment{0})
+         .read(pass2, b)
+         .write(pass2, c, Framebuffer::ColorAttachment{0})
+         .setOutput(a);
+
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(graph.attachmentCount(), 3);
+}
+
+void FrameGraphGLTest::compileUnusedResource() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt unused = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass, a, Framebuffer::ColorAttachment{0});
+
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(graph.attachmentCount(), 1);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.texture(unused);
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::texture(): resource 1 is not used by any pass\n");
+}
+
+void FrameGraphGLTest::compileNoWrites() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass0 = graph.addPass({{}, {16, 16}}, noop);
+    UnsignedInt pass1 = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass0, a, Framebuffer::ColorAttachment{0})
+         .read(pass1, a);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.compile();
+    CORRADE_VERIFY(!graph.isCompiled());
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::compile(): pass 1 doesn't write any resource\n");
+}
+
+void FrameGraphGLTest::compileReadWrite() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass, a, Framebuffer::ColorAttachment{0})
+         .read(pass, a);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.compile();
+    CORRADE_VERIFY(!graph.isCompiled());
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::compile(): pass 0 both reads and writes resource 0\n");
+}
+
+struct ExecuteState {
+    std::vector<Int> order;
+    Int pass;
+    Color4 color;
+};
+
+void clearPass(Framebuffer& framebuffer, void* state) {
+    ExecuteState& s = *static_cast<ExecuteState*>(state);
+    s.order.push_back(s.pass);
+    Renderer::setClearColor(s.color);
+    framebuffer.clear(FramebufferClear::Color);
+}
+
+void FrameGraphGLTest::execute() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    ExecuteState state0{{}, 0, 0x33ccff_rgbf};
+    ExecuteState state1{{}, 1, 0xff3366_rgbf};
+
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt pass0 = graph.addPass({{}, {16, 16}}, clearPass, &state0);
+    UnsignedInt pass1 = graph.addPass({{}, {16, 16}}, clearPass, &state1);
+    graph.write(pass0, a, Framebuffer::ColorAttachment{0})
+         .read(pass1, a)
+         .write(pass1, b, Framebuffer::ColorAttachment{0})
+         .setOutput(b);
+    graph.compile();
+
+    graph.execute();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(state0.order, std::vector<Int>{0}, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(state1.order, std::vector<Int>{1}, TestSuite::Compare::Container);
+
+    /* The output contents are preserved */
+    Framebuffer framebuffer{{{}, {16, 16}}};
+    framebuffer.attachTexture(Framebuffer::ColorAttachment{0}, graph.texture(b), 0);
+    Image2D image = framebuffer.read({{}, {16, 16}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[7][7], 0xff3366ff_rgba);
+
+    /* Executing again calls the passes again */
+    graph.execute();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(state0.order.size(), 2);
+    CORRADE_COMPARE(state1.order.size(), 2);
+}
+
+void FrameGraphGLTest::executeNotCompiled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.execute();
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::execute(): the graph is not compiled\n");
+}
+
+void FrameGraphGLTest::pool() {
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addRenderbuffer(RenderbufferFormat::DepthComponent16, {16, 16});
+    UnsignedInt pass = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass, a, Framebuffer::ColorAttachment{0})
+         .write(pass, b, Framebuffer::BufferAttachment::Depth);
+    graph.compile();
+    const GLuint textureId = graph.texture(a).id();
+    const GLuint renderbufferId = graph.renderbuffer(b).id();
+
+    /* Clearing keeps the pool */
+    graph.clear();
+    CORRADE_COMPARE(graph.resourceCount(), 0);
+    CORRADE_COMPARE(graph.passCount(), 0);
+    CORRADE_VERIFY(!graph.isCompiled());
+    CORRADE_COMPARE(graph.attachmentCount(), 2);
+
+    /* Rebuilding the graph with the texture reuses it, the renderbuffer gets
+       deleted as it's not needed anymore */
+    a = graph.addTexture(ColorFormat, {16, 16});
+    pass = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass, a, Framebuffer::ColorAttachment{0});
+    graph.compile();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(graph.attachmentCount(), 1);
+    CORRADE_COMPARE(graph.texture(a).id(), textureId);
+    CORRADE_VERIFY(!glIsRenderbuffer(renderbufferId));
+}
+
+void FrameGraphGLTest::invalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addTexture(ColorFormat, {16, 0});
+    graph.addRenderbuffer(RenderbufferFormat::DepthComponent16, {-1, 16});
+    CORRADE_COMPARE(out.str(),
+        "GL::FrameGraph::addTexture(): expected a positive size, got Vector(16, 0)\n"
+        "GL::FrameGraph::addRenderbuffer(): expected a positive size, got Vector(-1, 16)\n");
+}
+
+void FrameGraphGLTest::addPassNullFunction() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.addPass({{}, {16, 16}}, nullptr);
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::addPass(): expected a non-null function\n");
+}
+
+void FrameGraphGLTest::outOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+    graph.addTexture(ColorFormat, {16, 16});
+    graph.addPass({{}, {16, 16}}, noop);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.write(1, 0, Framebuffer::ColorAttachment{0});
+    graph.write(0, 1, Framebuffer::ColorAttachment{0});
+    graph.read(1, 0);
+    graph.read(0, 1);
+    graph.setOutput(1);
+    CORRADE_COMPARE(out.str(),
+        "GL::FrameGraph::write(): pass 1 out of range for 1 passes\n"
+        "GL::FrameGraph::write(): resource 1 out of range for 1 resources\n"
+        "GL::FrameGraph::read(): pass 1 out of range for 1 passes\n"
+        "GL::FrameGraph::read(): resource 1 out of range for 1 resources\n"
+        "GL::FrameGraph::setOutput(): resource 1 out of range for 1 resources\n");
+}
+
+void FrameGraphGLTest::readRenderbuffer() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+    graph.addRenderbuffer(RenderbufferFormat::DepthComponent16, {16, 16});
+    graph.addPass({{}, {16, 16}}, noop);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.read(0, 0);
+    CORRADE_COMPARE(out.str(), "GL::FrameGraph::read(): resource 0 is a renderbuffer\n");
+}
+
+void FrameGraphGLTest::accessNotCompiled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    FrameGraph graph;
+    graph.addTexture(ColorFormat, {16, 16});
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.texture(0);
+    graph.renderbuffer(0);
+    CORRADE_COMPARE(out.str(),
+        "GL::FrameGraph::texture(): the graph is not compiled\n"
+        "GL::FrameGraph::renderbuffer(): the graph is not compiled\n");
+}
+
+void FrameGraphGLTest::accessWrongType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_FRAMEBUFFER_OBJECT();
+
+    FrameGraph graph;
+    UnsignedInt a = graph.addTexture(ColorFormat, {16, 16});
+    UnsignedInt b = graph.addRenderbuffer(RenderbufferFormat::DepthComponent16, {16, 16});
+    UnsignedInt pass = graph.addPass({{}, {16, 16}}, noop);
+    graph.write(pass, a, Framebuffer::ColorAttachment{0})
+         .write(pass, b, Framebuffer::BufferAttachment::Depth);
+    graph.compile();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    graph.texture(2);
+    graph.renderbuffer(2);
+    graph.texture(b);
+    graph.renderbuffer(a);
+    CORRADE_COMPARE(out.str(),
+        "GL::FrameGraph::texture(): resource 2 out of range for 2 resources\n"
+        "GL::FrameGraph::renderbuffer(): resource 2 out of range for 2 resources\n"
+        "GL::FrameGraph::texture(): resource 1 is a renderbuffer\n"
+        "GL::FrameGraph::renderbuffer(): resource 0 is a texture\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::FrameGraphGLTest)
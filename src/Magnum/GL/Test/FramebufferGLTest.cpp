@@ -105,6 +105,9 @@ struct FramebufferGLTest: OpenGLTester {
     void attachLayeredCubeMapTextureArray();
     void attachLayeredTexture2DMultisampleArray();
     #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    void attachTextureMultiview();
+    #endif
     void detach();
 
     void multipleColorOutputs();
@@ -248,6 +251,9 @@ FramebufferGLTest::FramebufferGLTest() {
               &FramebufferGLTest::attachLayeredCubeMapTextureArray,
               &FramebufferGLTest::attachLayeredTexture2DMultisampleArray,
               #endif
+              #ifndef MAGNUM_TARGET_GLES2
+              &FramebufferGLTest::attachTextureMultiview,
+              #endif
               &FramebufferGLTest::detach,
 
               &FramebufferGLTest::multipleColorOutputs,
@@ -1010,6 +1016,34 @@ void FramebufferGLTest::attachLayeredTexture2DMultisampleArray() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+void FramebufferGLTest::attachTextureMultiview() {
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(!Context::current().isExtensionSupported<Extensions::OVR::multiview>())
+        CORRADE_SKIP(Extensions::OVR::multiview::string() + std::string(" is not available."));
+    #else
+    if(!Context::current().isExtensionSupported<Extensions::OVR::multiview2>())
+        CORRADE_SKIP(Extensions::OVR::multiview2::string() + std::string(" is not available."));
+    #endif
+
+    CORRADE_VERIFY(Framebuffer::maxViews() >= 2);
+
+    Texture2DArray color;
+    color.setStorage(1, TextureFormat::RGBA8, {128, 128, 4});
+
+    Texture2DArray depthStencil;
+    depthStencil.setStorage(1, TextureFormat::Depth24Stencil8, {128, 128, 4});
+
+    Framebuffer framebuffer{{{}, Vector2i{128}}};
+    framebuffer.attachTextureMultiview(Framebuffer::ColorAttachment{0}, color, 0, 2, 2)
+               .attachTextureMultiview(Framebuffer::BufferAttachment::DepthStencil, depthStencil, 0, 2, 2);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Read), Framebuffer::Status::Complete);
+    CORRADE_COMPARE(framebuffer.checkStatus(FramebufferTarget::Draw), Framebuffer::Status::Complete);
+}
+#endif
+
 void FramebufferGLTest::detach() {
     #ifndef MAGNUM_TARGET_GLES
     if(!Context::current().isExtensionSupported<Extensions::ARB::framebuffer_object>())
@@ -157,12 +157,25 @@ struct MeshGLTest: OpenGLTester {
     void addVertexBufferInstancedDouble();
     #endif
     void resetDivisorAfterInstancedDraw();
+    void drawNonVaoSharedBuffer();
 
     void multiDraw();
     void multiDrawIndexed();
     #ifndef MAGNUM_TARGET_GLES
     void multiDrawBaseVertex();
     #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void drawIndirect();
+    void drawIndirectIndexed();
+    #ifndef MAGNUM_TARGET_GLES
+    void drawIndirectMulti();
+    void drawIndirectCount();
+    void drawIndirectCountOffsetNotAligned();
+    #else
+    void drawIndirectMultiNotSupported();
+    #endif
+    #endif
 };
 
 MeshGLTest::MeshGLTest() {
@@ -279,11 +292,24 @@ MeshGLTest::MeshGLTest() {
               &MeshGLTest::addVertexBufferInstancedDouble,
               #endif
               &MeshGLTest::resetDivisorAfterInstancedDraw,
+              &MeshGLTest::drawNonVaoSharedBuffer,
 
               &MeshGLTest::multiDraw,
               &MeshGLTest::multiDrawIndexed,
               #ifndef MAGNUM_TARGET_GLES
-              &MeshGLTest::multiDrawBaseVertex
+              &MeshGLTest::multiDrawBaseVertex,
+              #endif
+
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &MeshGLTest::drawIndirect,
+              &MeshGLTest::drawIndirectIndexed,
+              #ifndef MAGNUM_TARGET_GLES
+              &MeshGLTest::drawIndirectMulti,
+              &MeshGLTest::drawIndirectCount,
+              &MeshGLTest::drawIndirectCountOffsetNotAligned
+              #else
+              &MeshGLTest::drawIndirectMultiNotSupported
+              #endif
               #endif
               });
 }
@@ -2956,6 +2982,70 @@ void MeshGLTest::resetDivisorAfterInstancedDraw() {
     }
 }
 
+void MeshGLTest::drawNonVaoSharedBuffer() {
+    /* Verifies that the attribute state tracking in the non-VAO code path
+       respecifies attributes that differ between consecutive draws */
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::ARB::vertex_array_object>())
+        CORRADE_SKIP(Extensions::ARB::vertex_array_object::string() + std::string(" is enabled, can't test."));
+    #elif defined(MAGNUM_TARGET_GLES2)
+    if(Context::current().isExtensionSupported<Extensions::OES::vertex_array_object>())
+        CORRADE_SKIP(Extensions::OES::vertex_array_object::string() + std::string(" is enabled, can't test."));
+    #else
+    CORRADE_SKIP("VAOs are always available on this platform, can't test.");
+    #endif
+
+    typedef Attribute<0, Float> Attribute;
+
+    const Float data[]{
+        Math::unpack<Float, UnsignedByte>(96),
+        Math::unpack<Float, UnsignedByte>(48),
+    };
+    Buffer buffer;
+    buffer.setData(data, BufferUsage::StaticDraw);
+
+    Renderbuffer renderbuffer;
+    renderbuffer.setStorage(
+        #ifndef MAGNUM_TARGET_GLES2
+        RenderbufferFormat::RGBA8,
+        #else
+        RenderbufferFormat::RGBA4,
+        #endif
+        Vector2i(1));
+    Framebuffer framebuffer{{{}, Vector2i(1)}};
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer)
+                .bind();
+
+    FloatShader shader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"};
+
+    /* Two meshes sharing the same buffer, differing only in the offset */
+    Mesh a;
+    a.addVertexBuffer(buffer, 0, Attribute{})
+        .setPrimitive(MeshPrimitive::Points)
+        .setCount(1);
+    Mesh b;
+    b.addVertexBuffer(buffer, 4, Attribute{})
+        .setPrimitive(MeshPrimitive::Points)
+        .setCount(1);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Drawing the same mesh twice skips all attribute setup the second time,
+       drawing the other one has to update the offset */
+    for(const std::pair<Mesh*, UnsignedByte> draw: {
+        std::make_pair(&a, UnsignedByte(96)),
+        std::make_pair(&a, UnsignedByte(96)),
+        std::make_pair(&b, UnsignedByte(48)),
+        std::make_pair(&a, UnsignedByte(96))
+    }) {
+        shader.draw(*draw.first);
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+
+        CORRADE_COMPARE(Containers::arrayCast<UnsignedByte>(framebuffer.read({{}, Vector2i{1}}, {PixelFormat::RGBA, PixelType::UnsignedByte}).data())[0], draw.second);
+    }
+}
+
 struct MultiChecker {
     MultiChecker(AbstractShaderProgram&& shader, Mesh& mesh);
 
@@ -3008,6 +3098,9 @@ void MeshGLTest::multiDraw() {
     #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
     if(!Context::current().isExtensionSupported<Extensions::EXT::multi_draw_arrays>())
         Debug() << Extensions::EXT::multi_draw_arrays::string() << "not supported, using fallback implementation";
+    #elif defined(MAGNUM_TARGET_WEBGL)
+    if(!Context::current().isExtensionSupported<Extensions::WEBGL::multi_draw>())
+        Debug() << Extensions::WEBGL::multi_draw::string() << "not supported, using fallback implementation";
     #endif
 
     typedef Attribute<0, Float> Attribute;
@@ -3045,6 +3138,9 @@ void MeshGLTest::multiDrawIndexed() {
     #if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_WEBGL)
     if(!Context::current().isExtensionSupported<Extensions::EXT::multi_draw_arrays>())
         Debug() << Extensions::EXT::multi_draw_arrays::string() << "not supported, using fallback implementation";
+    #elif defined(MAGNUM_TARGET_WEBGL)
+    if(!Context::current().isExtensionSupported<Extensions::WEBGL::multi_draw>())
+        Debug() << Extensions::WEBGL::multi_draw::string() << "not supported, using fallback implementation";
     #endif
 
     Buffer vertices;
@@ -3094,6 +3190,197 @@ void MeshGLTest::multiDrawBaseVertex() {
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+struct IndirectChecker {
+    IndirectChecker();
+
+    template<class T> T get(PixelFormat format, PixelType type);
+
+    Renderbuffer renderbuffer;
+    Framebuffer framebuffer;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+IndirectChecker::IndirectChecker(): framebuffer({{}, Vector2i(1)}) {
+    renderbuffer.setStorage(RenderbufferFormat::RGBA8, Vector2i(1));
+    framebuffer.attachRenderbuffer(Framebuffer::ColorAttachment(0), renderbuffer);
+    framebuffer.bind();
+}
+
+template<class T> T IndirectChecker::get(PixelFormat format, PixelType type) {
+    return Containers::arrayCast<T>(framebuffer.read({{}, Vector2i{1}}, {format, type}).data())[0];
+}
+#endif
+
+bool indirectDrawSupported() {
+    #ifndef MAGNUM_TARGET_GLES
+    return Context::current().isExtensionSupported<Extensions::ARB::draw_indirect>();
+    #else
+    return Context::current().isVersionSupported(Version::GLES310);
+    #endif
+}
+
+const Float indirectVertexData[] = { 0.0f, -0.7f, Math::unpack<Float, UnsignedByte>(96) };
+
+void MeshGLTest::drawIndirect() {
+    if(!indirectDrawSupported())
+        CORRADE_SKIP("Indirect drawing is not supported.");
+
+    Buffer vertices;
+    vertices.setData(indirectVertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(vertices, 4, Attribute<0, Float>{});
+
+    /* Count, instance count, first vertex, base instance. Skipping the first
+       vertex to verify the offset is taken from the command. */
+    const UnsignedInt commandData[]{1, 1, 1, 0};
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    IndirectChecker checker;
+    FloatShader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"}
+        .drawIndirect(mesh, commands, 0);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectIndexed() {
+    if(!indirectDrawSupported())
+        CORRADE_SKIP("Indirect drawing is not supported.");
+
+    Buffer vertices;
+    vertices.setData(indexedVertexData, BufferUsage::StaticDraw);
+
+    constexpr UnsignedShort indexData[] = { 2, 1, 0 };
+    Buffer indices{Buffer::TargetHint::ElementArray};
+    indices.setData(indexData, BufferUsage::StaticDraw);
+
+    /* The index offset is ignored for indirect draws, the first index is
+       taken from the command */
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(vertices, 1*4,  MultipleShader::Position(),
+                         MultipleShader::Normal(), MultipleShader::TextureCoordinates())
+        .setIndexBuffer(indices, 0, MeshIndexType::UnsignedShort);
+
+    /* Count, instance count, first index, base vertex, base instance, with
+       a leading padding to verify the offset is taken into account */
+    const UnsignedInt commandData[]{0, 1, 1, 2, 0, 0};
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    IndirectChecker checker;
+    MultipleShader{}.drawIndirect(mesh, commands, 4);
+    const auto value = checker.get<Color4ub>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, indexedResult);
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void MeshGLTest::drawIndirectMulti() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::multi_draw_indirect>())
+        CORRADE_SKIP(Extensions::ARB::multi_draw_indirect::string() + std::string(" is not available."));
+
+    Buffer vertices;
+    vertices.setData(indirectVertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(vertices, 4, Attribute<0, Float>{});
+
+    /* The first command draws the zero vertex, the second overwrites it with
+       the other one. Each padded to six ints to test the stride. */
+    const UnsignedInt commandData[]{
+        1, 1, 0, 0, 0xdead, 0xbeef,
+        1, 1, 1, 0, 0xdead, 0xbeef
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    IndirectChecker checker;
+    FloatShader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"}
+        .drawIndirect(mesh, commands, 0, 2, 6*4);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectCount() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::indirect_parameters>())
+        CORRADE_SKIP(Extensions::ARB::indirect_parameters::string() + std::string(" is not available."));
+
+    Buffer vertices;
+    vertices.setData(indirectVertexData, BufferUsage::StaticDraw);
+
+    Mesh mesh{MeshPrimitive::Points};
+    mesh.addVertexBuffer(vertices, 4, Attribute<0, Float>{});
+
+    /* The second command would overwrite the output if the count from the
+       buffer wasn't respected */
+    const UnsignedInt commandData[]{
+        1, 1, 1, 0,
+        1, 1, 0, 0
+    };
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    commands.setData(commandData, BufferUsage::StaticDraw);
+
+    const UnsignedInt countData[]{0xdead, 1};
+    Buffer count{Buffer::TargetHint::Parameter};
+    count.setData(countData, BufferUsage::StaticDraw);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    IndirectChecker checker;
+    FloatShader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"}
+        .drawIndirect(mesh, commands, 0, count, 4, 2);
+    const auto value = checker.get<UnsignedByte>(PixelFormat::RGBA, PixelType::UnsignedByte);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(value, 96);
+}
+
+void MeshGLTest::drawIndirectCountOffsetNotAligned() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Mesh mesh{MeshPrimitive::Points};
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+    Buffer count{Buffer::TargetHint::Parameter};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FloatShader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"}
+        .drawIndirect(mesh, commands, 0, count, 3, 2);
+    CORRADE_COMPARE(out.str(), "GL::AbstractShaderProgram::drawIndirect(): count offset 3 is not four-byte aligned\n");
+}
+#else
+void MeshGLTest::drawIndirectMultiNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Mesh mesh{MeshPrimitive::Points};
+    Buffer commands{Buffer::TargetHint::DrawIndirect};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FloatShader{"float", "vec4(valueInterpolated, 0.0, 0.0, 0.0)"}
+        .drawIndirect(mesh, commands, 0, 2);
+    CORRADE_COMPARE(out.str(), "GL::AbstractShaderProgram::drawIndirect(): desktop OpenGL is required for drawing more than one command\n");
+}
+#endif
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::MeshGLTest)
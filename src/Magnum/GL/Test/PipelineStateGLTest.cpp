@@ -0,0 +1,182 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PipelineState.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct PipelineStateGLTest: OpenGLTester {
+    explicit PipelineStateGLTest();
+
+    void apply();
+    void applyDisabledFeatureState();
+    void applyAfterRendererChange();
+    void applyAfterResetState();
+};
+
+PipelineStateGLTest::PipelineStateGLTest() {
+    addTests({&PipelineStateGLTest::apply,
+              &PipelineStateGLTest::applyDisabledFeatureState,
+              &PipelineStateGLTest::applyAfterRendererChange,
+              &PipelineStateGLTest::applyAfterResetState});
+}
+
+GLint getInteger(GLenum parameter) {
+    GLint value;
+    glGetIntegerv(parameter, &value);
+    return value;
+}
+
+void PipelineStateGLTest::apply() {
+    PipelineState state;
+    state.setBlending(true)
+        .setBlendEquation(Renderer::BlendEquation::Subtract, Renderer::BlendEquation::ReverseSubtract)
+        .setBlendFunction(Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::OneMinusSourceAlpha)
+        .setDepthTest(true)
+        .setDepthFunction(Renderer::DepthFunction::LessOrEqual)
+        .setDepthMask(false)
+        .setStencilTest(true)
+        .setStencilFunction(Renderer::PolygonFacing::Back, Renderer::StencilFunction::Equal, 3, 0xf0)
+        .setStencilOperation(Renderer::StencilOperation::Zero, Renderer::StencilOperation::Invert, Renderer::StencilOperation::Replace)
+        .setStencilMask(Renderer::PolygonFacing::Front, 0x0f)
+        .setFaceCulling(true)
+        .setFaceCullingMode(Renderer::PolygonFacing::Front)
+        .setFrontFace(Renderer::FrontFace::ClockWise)
+        .setColorMask(true, false, true, false);
+    state.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_VERIFY(glIsEnabled(GL_STENCIL_TEST));
+    CORRADE_VERIFY(glIsEnabled(GL_CULL_FACE));
+    CORRADE_VERIFY(!glIsEnabled(GL_POLYGON_OFFSET_FILL));
+    CORRADE_COMPARE(getInteger(GL_BLEND_EQUATION_RGB), GL_FUNC_SUBTRACT);
+    CORRADE_COMPARE(getInteger(GL_BLEND_EQUATION_ALPHA), GL_FUNC_REVERSE_SUBTRACT);
+    CORRADE_COMPARE(getInteger(GL_BLEND_SRC_RGB), GL_SRC_ALPHA);
+    CORRADE_COMPARE(getInteger(GL_BLEND_DST_ALPHA), GL_ONE_MINUS_SRC_ALPHA);
+    CORRADE_COMPARE(getInteger(GL_DEPTH_FUNC), GL_LEQUAL);
+    CORRADE_COMPARE(getInteger(GL_DEPTH_WRITEMASK), GL_FALSE);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_FUNC), GL_ALWAYS);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_BACK_FUNC), GL_EQUAL);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_BACK_REF), 3);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_BACK_VALUE_MASK), 0xf0);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_FAIL), GL_ZERO);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_BACK_PASS_DEPTH_FAIL), GL_INVERT);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_BACK_PASS_DEPTH_PASS), GL_REPLACE);
+    CORRADE_COMPARE(getInteger(GL_STENCIL_WRITEMASK), 0x0f);
+    CORRADE_COMPARE(getInteger(GL_CULL_FACE_MODE), GL_FRONT);
+    CORRADE_COMPARE(getInteger(GL_FRONT_FACE), GL_CW);
+
+    GLboolean colorMask[4];
+    glGetBooleanv(GL_COLOR_WRITEMASK, colorMask);
+    CORRADE_VERIFY(colorMask[0]);
+    CORRADE_VERIFY(!colorMask[1]);
+    CORRADE_VERIFY(colorMask[2]);
+    CORRADE_VERIFY(!colorMask[3]);
+
+    /* Go back to the defaults so other tests are not affected */
+    PipelineState{}.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(!glIsEnabled(GL_BLEND));
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_COMPARE(getInteger(GL_DEPTH_WRITEMASK), GL_TRUE);
+    CORRADE_COMPARE(getInteger(GL_FRONT_FACE), GL_CCW);
+}
+
+void PipelineStateGLTest::applyDisabledFeatureState() {
+    PipelineState{}.apply();
+
+    /* The depth function isn't applied as the depth test is disabled */
+    PipelineState state;
+    state.setDepthFunction(Renderer::DepthFunction::Greater);
+    state.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_COMPARE(getInteger(GL_DEPTH_FUNC), GL_LESS);
+
+    /* But it is once it gets enabled */
+    state.setDepthTest(true);
+    state.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_COMPARE(getInteger(GL_DEPTH_FUNC), GL_GREATER);
+
+    PipelineState{}.setDepthTest(true).apply();
+    PipelineState{}.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PipelineStateGLTest::applyAfterRendererChange() {
+    PipelineState state;
+    state.setDepthTest(true)
+        .setDepthFunction(Renderer::DepthFunction::LessOrEqual);
+    state.apply();
+
+    /* Changing the state through Renderer causes the next apply() to set it
+       again, even though the PipelineState instance is the same */
+    Renderer::setDepthFunction(Renderer::DepthFunction::Greater);
+    Renderer::disable(Renderer::Feature::DepthTest);
+    state.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(glIsEnabled(GL_DEPTH_TEST));
+    CORRADE_COMPARE(getInteger(GL_DEPTH_FUNC), GL_LEQUAL);
+
+    PipelineState{}.setDepthTest(true).apply();
+    PipelineState{}.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PipelineStateGLTest::applyAfterResetState() {
+    PipelineState state;
+    state.setFrontFace(Renderer::FrontFace::ClockWise);
+    state.apply();
+
+    /* Simulate external code changing the state behind our back */
+    glFrontFace(GL_CCW);
+    Context::current().resetState(Context::State::Renderer);
+    state.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(getInteger(GL_FRONT_FACE), GL_CW);
+
+    PipelineState{}.apply();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::PipelineStateGLTest)
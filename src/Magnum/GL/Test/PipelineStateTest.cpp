@@ -0,0 +1,232 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/PipelineState.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct PipelineStateTest: TestSuite::Tester {
+    explicit PipelineStateTest();
+
+    void construct();
+
+    void setFeatures();
+    void setBlend();
+    void setDepth();
+    void setStencil();
+    void setStencilFacing();
+    void setStencilFacingInvalid();
+    void setCulling();
+    void setPolygonOffset();
+    void setColorMask();
+};
+
+PipelineStateTest::PipelineStateTest() {
+    addTests({&PipelineStateTest::construct,
+
+              &PipelineStateTest::setFeatures,
+              &PipelineStateTest::setBlend,
+              &PipelineStateTest::setDepth,
+              &PipelineStateTest::setStencil,
+              &PipelineStateTest::setStencilFacing,
+              &PipelineStateTest::setStencilFacingInvalid,
+              &PipelineStateTest::setCulling,
+              &PipelineStateTest::setPolygonOffset,
+              &PipelineStateTest::setColorMask});
+}
+
+void PipelineStateTest::construct() {
+    PipelineState state;
+    CORRADE_VERIFY(!state.isBlending());
+    CORRADE_VERIFY(!state.isDepthTest());
+    CORRADE_VERIFY(!state.isStencilTest());
+    CORRADE_VERIFY(!state.isFaceCulling());
+    CORRADE_VERIFY(!state.isPolygonOffsetFill());
+    CORRADE_VERIFY(state.blendEquationRgb() == Renderer::BlendEquation::Add);
+    CORRADE_VERIFY(state.blendEquationAlpha() == Renderer::BlendEquation::Add);
+    CORRADE_VERIFY(state.blendSourceRgb() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendDestinationRgb() == Renderer::BlendFunction::Zero);
+    CORRADE_VERIFY(state.blendSourceAlpha() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendDestinationAlpha() == Renderer::BlendFunction::Zero);
+    CORRADE_VERIFY(state.depthFunction() == Renderer::DepthFunction::Less);
+    CORRADE_VERIFY(state.depthMask());
+    for(Renderer::PolygonFacing facing: {Renderer::PolygonFacing::Front, Renderer::PolygonFacing::Back}) {
+        CORRADE_ITERATION(facing == Renderer::PolygonFacing::Front ? "front" : "back");
+        CORRADE_VERIFY(state.stencilFunction(facing) == Renderer::StencilFunction::Always);
+        CORRADE_COMPARE(state.stencilReferenceValue(facing), 0);
+        CORRADE_COMPARE(state.stencilFunctionMask(facing), 0xffffffffu);
+        CORRADE_VERIFY(state.stencilFailOperation(facing) == Renderer::StencilOperation::Keep);
+        CORRADE_VERIFY(state.stencilDepthFailOperation(facing) == Renderer::StencilOperation::Keep);
+        CORRADE_VERIFY(state.stencilDepthPassOperation(facing) == Renderer::StencilOperation::Keep);
+        CORRADE_COMPARE(state.stencilMask(facing), 0xffffffffu);
+    }
+    CORRADE_VERIFY(state.faceCullingMode() == Renderer::PolygonFacing::Back);
+    CORRADE_VERIFY(state.frontFace() == Renderer::FrontFace::CounterClockWise);
+    CORRADE_COMPARE(state.polygonOffsetFactor(), 0.0f);
+    CORRADE_COMPARE(state.polygonOffsetUnits(), 0.0f);
+    CORRADE_VERIFY(state.colorMaskRed());
+    CORRADE_VERIFY(state.colorMaskGreen());
+    CORRADE_VERIFY(state.colorMaskBlue());
+    CORRADE_VERIFY(state.colorMaskAlpha());
+}
+
+void PipelineStateTest::setFeatures() {
+    PipelineState state;
+    state.setBlending(true)
+        .setStencilTest(true)
+        .setPolygonOffsetFill(true);
+    CORRADE_VERIFY(state.isBlending());
+    CORRADE_VERIFY(!state.isDepthTest());
+    CORRADE_VERIFY(state.isStencilTest());
+    CORRADE_VERIFY(!state.isFaceCulling());
+    CORRADE_VERIFY(state.isPolygonOffsetFill());
+
+    state.setBlending(false)
+        .setDepthTest(true)
+        .setFaceCulling(true);
+    CORRADE_VERIFY(!state.isBlending());
+    CORRADE_VERIFY(state.isDepthTest());
+    CORRADE_VERIFY(state.isStencilTest());
+    CORRADE_VERIFY(state.isFaceCulling());
+    CORRADE_VERIFY(state.isPolygonOffsetFill());
+}
+
+void PipelineStateTest::setBlend() {
+    PipelineState state;
+    state.setBlendEquation(Renderer::BlendEquation::Subtract, Renderer::BlendEquation::ReverseSubtract)
+        .setBlendFunction(Renderer::BlendFunction::SourceAlpha, Renderer::BlendFunction::OneMinusSourceAlpha, Renderer::BlendFunction::One, Renderer::BlendFunction::DestinationAlpha);
+    CORRADE_VERIFY(state.blendEquationRgb() == Renderer::BlendEquation::Subtract);
+    CORRADE_VERIFY(state.blendEquationAlpha() == Renderer::BlendEquation::ReverseSubtract);
+    CORRADE_VERIFY(state.blendSourceRgb() == Renderer::BlendFunction::SourceAlpha);
+    CORRADE_VERIFY(state.blendDestinationRgb() == Renderer::BlendFunction::OneMinusSourceAlpha);
+    CORRADE_VERIFY(state.blendSourceAlpha() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendDestinationAlpha() == Renderer::BlendFunction::DestinationAlpha);
+
+    state.setBlendEquation(Renderer::BlendEquation::ReverseSubtract)
+        .setBlendFunction(Renderer::BlendFunction::One, Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendEquationRgb() == Renderer::BlendEquation::ReverseSubtract);
+    CORRADE_VERIFY(state.blendEquationAlpha() == Renderer::BlendEquation::ReverseSubtract);
+    CORRADE_VERIFY(state.blendSourceRgb() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendDestinationRgb() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendSourceAlpha() == Renderer::BlendFunction::One);
+    CORRADE_VERIFY(state.blendDestinationAlpha() == Renderer::BlendFunction::One);
+}
+
+void PipelineStateTest::setDepth() {
+    PipelineState state;
+    state.setDepthFunction(Renderer::DepthFunction::LessOrEqual)
+        .setDepthMask(false);
+    CORRADE_VERIFY(state.depthFunction() == Renderer::DepthFunction::LessOrEqual);
+    CORRADE_VERIFY(!state.depthMask());
+    /* Color mask is unaffected */
+    CORRADE_VERIFY(state.colorMaskRed());
+}
+
+void PipelineStateTest::setStencil() {
+    PipelineState state;
+    state.setStencilFunction(Renderer::StencilFunction::Equal, 3, 0xf0)
+        .setStencilOperation(Renderer::StencilOperation::Zero, Renderer::StencilOperation::Invert, Renderer::StencilOperation::Replace)
+        .setStencilMask(0x0f);
+    for(Renderer::PolygonFacing facing: {Renderer::PolygonFacing::Front, Renderer::PolygonFacing::Back}) {
+        CORRADE_ITERATION(facing == Renderer::PolygonFacing::Front ? "front" : "back");
+        CORRADE_VERIFY(state.stencilFunction(facing) == Renderer::StencilFunction::Equal);
+        CORRADE_COMPARE(state.stencilReferenceValue(facing), 3);
+        CORRADE_COMPARE(state.stencilFunctionMask(facing), 0xf0u);
+        CORRADE_VERIFY(state.stencilFailOperation(facing) == Renderer::StencilOperation::Zero);
+        CORRADE_VERIFY(state.stencilDepthFailOperation(facing) == Renderer::StencilOperation::Invert);
+        CORRADE_VERIFY(state.stencilDepthPassOperation(facing) == Renderer::StencilOperation::Replace);
+        CORRADE_COMPARE(state.stencilMask(facing), 0x0fu);
+    }
+}
+
+void PipelineStateTest::setStencilFacing() {
+    PipelineState state;
+    state.setStencilFunction(Renderer::PolygonFacing::Back, Renderer::StencilFunction::Equal, 3, 0xf0)
+        .setStencilOperation(Renderer::PolygonFacing::Front, Renderer::StencilOperation::Zero, Renderer::StencilOperation::Invert, Renderer::StencilOperation::Replace)
+        .setStencilMask(Renderer::PolygonFacing::Back, 0x0fu);
+
+    CORRADE_VERIFY(state.stencilFunction(Renderer::PolygonFacing::Front) == Renderer::StencilFunction::Always);
+    CORRADE_COMPARE(state.stencilReferenceValue(Renderer::PolygonFacing::Front), 0);
+    CORRADE_COMPARE(state.stencilFunctionMask(Renderer::PolygonFacing::Front), 0xffffffffu);
+    CORRADE_VERIFY(state.stencilFailOperation(Renderer::PolygonFacing::Front) == Renderer::StencilOperation::Zero);
+    CORRADE_VERIFY(state.stencilDepthFailOperation(Renderer::PolygonFacing::Front) == Renderer::StencilOperation::Invert);
+    CORRADE_VERIFY(state.stencilDepthPassOperation(Renderer::PolygonFacing::Front) == Renderer::StencilOperation::Replace);
+    CORRADE_COMPARE(state.stencilMask(Renderer::PolygonFacing::Front), 0xffffffffu);
+
+    CORRADE_VERIFY(state.stencilFunction(Renderer::PolygonFacing::Back) == Renderer::StencilFunction::Equal);
+    CORRADE_COMPARE(state.stencilReferenceValue(Renderer::PolygonFacing::Back), 3);
+    CORRADE_COMPARE(state.stencilFunctionMask(Renderer::PolygonFacing::Back), 0xf0u);
+    CORRADE_VERIFY(state.stencilFailOperation(Renderer::PolygonFacing::Back) == Renderer::StencilOperation::Keep);
+    CORRADE_VERIFY(state.stencilDepthFailOperation(Renderer::PolygonFacing::Back) == Renderer::StencilOperation::Keep);
+    CORRADE_VERIFY(state.stencilDepthPassOperation(Renderer::PolygonFacing::Back) == Renderer::StencilOperation::Keep);
+    CORRADE_COMPARE(state.stencilMask(Renderer::PolygonFacing::Back), 0x0fu);
+}
+
+void PipelineStateTest::setStencilFacingInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    PipelineState state;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    state.stencilFunction(Renderer::PolygonFacing::FrontAndBack);
+    CORRADE_COMPARE(out.str(), "GL::PipelineState: expected either a front or a back facing\n");
+}
+
+void PipelineStateTest::setCulling() {
+    PipelineState state;
+    state.setFaceCullingMode(Renderer::PolygonFacing::Front)
+        .setFrontFace(Renderer::FrontFace::ClockWise);
+    CORRADE_VERIFY(state.faceCullingMode() == Renderer::PolygonFacing::Front);
+    CORRADE_VERIFY(state.frontFace() == Renderer::FrontFace::ClockWise);
+}
+
+void PipelineStateTest::setPolygonOffset() {
+    PipelineState state;
+    state.setPolygonOffset(1.5f, -2.0f);
+    CORRADE_COMPARE(state.polygonOffsetFactor(), 1.5f);
+    CORRADE_COMPARE(state.polygonOffsetUnits(), -2.0f);
+}
+
+void PipelineStateTest::setColorMask() {
+    PipelineState state;
+    state.setColorMask(true, false, true, false);
+    CORRADE_VERIFY(state.colorMaskRed());
+    CORRADE_VERIFY(!state.colorMaskGreen());
+    CORRADE_VERIFY(state.colorMaskBlue());
+    CORRADE_VERIFY(!state.colorMaskAlpha());
+    /* Depth mask is unaffected */
+    CORRADE_VERIFY(state.depthMask());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::PipelineStateTest)
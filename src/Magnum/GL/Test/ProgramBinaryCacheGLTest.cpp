@@ -0,0 +1,265 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/ProgramBinaryCache.h"
+#include "Magnum/GL/Shader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct ProgramBinaryCacheGLTest: OpenGLTester {
+    explicit ProgramBinaryCacheGLTest();
+
+    void construct();
+
+    void key();
+
+    void loadSave();
+    void loadMissing();
+    void loadCorrupted();
+    void loadRejected();
+    void saveNotLinked();
+};
+
+ProgramBinaryCacheGLTest::ProgramBinaryCacheGLTest() {
+    addTests({&ProgramBinaryCacheGLTest::construct,
+
+              &ProgramBinaryCacheGLTest::key,
+
+              &ProgramBinaryCacheGLTest::loadSave,
+              &ProgramBinaryCacheGLTest::loadMissing,
+              &ProgramBinaryCacheGLTest::loadCorrupted,
+              &ProgramBinaryCacheGLTest::loadRejected,
+              &ProgramBinaryCacheGLTest::saveNotLinked});
+}
+
+constexpr Version ShaderVersion =
+    #ifndef MAGNUM_TARGET_GLES
+    Version::GL310
+    #else
+    Version::GLES300
+    #endif
+    ;
+
+constexpr const char* VertexSource = R"(
+in highp vec4 position;
+uniform highp mat4 matrix;
+
+void main() {
+    gl_Position = matrix*position;
+}
+)";
+
+constexpr const char* FragmentSource = R"(
+uniform lowp vec4 color;
+out lowp vec4 fragmentColor;
+
+void main() {
+    fragmentColor = color;
+}
+)";
+
+struct MyShader: AbstractShaderProgram {
+    /* Compiles the shaders only if the binary isn't in the cache */
+    explicit MyShader(ProgramBinaryCache& cache, bool& cached) {
+        Shader vert{ShaderVersion, Shader::Type::Vertex};
+        Shader frag{ShaderVersion, Shader::Type::Fragment};
+        vert.addSource(VertexSource);
+        frag.addSource(FragmentSource);
+
+        const std::string key = cache.key({vert, frag});
+        cached = cache.load(*this, key);
+        if(!cached) {
+            CORRADE_INTERNAL_ASSERT_OUTPUT(Shader::compile({vert, frag}));
+            attachShaders({vert, frag});
+            bindAttributeLocation(0, "position");
+            CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+            cache.save(*this, key);
+        }
+    }
+
+    explicit MyShader() {}
+
+    using AbstractShaderProgram::uniformLocation;
+};
+
+std::string keyForSources() {
+    Shader vert{ShaderVersion, Shader::Type::Vertex};
+    Shader frag{ShaderVersion, Shader::Type::Fragment};
+    vert.addSource(VertexSource);
+    frag.addSource(FragmentSource);
+    return ProgramBinaryCache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR}.key({vert, frag});
+}
+
+void ProgramBinaryCacheGLTest::construct() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    CORRADE_COMPARE(cache.directory(), PROGRAMBINARYCACHEGLTEST_SAVE_DIR);
+
+    GLint formatCount{};
+    #ifndef MAGNUM_TARGET_GLES
+    if(Context::current().isExtensionSupported<Extensions::ARB::get_program_binary>())
+    #endif
+    {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    }
+    CORRADE_COMPARE(cache.isSupported(), formatCount > 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ProgramBinaryCacheGLTest::key() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+
+    Shader a{ShaderVersion, Shader::Type::Vertex};
+    Shader b{ShaderVersion, Shader::Type::Vertex};
+    Shader c{ShaderVersion, Shader::Type::Fragment};
+    Shader d{ShaderVersion, Shader::Type::Vertex};
+    Shader e{ShaderVersion, Shader::Type::Vertex};
+    a.addSource(VertexSource);
+    b.addSource(VertexSource);
+    c.addSource(VertexSource);
+    d.addSource("#define A\n")
+     .addSource(VertexSource);
+    e.addSource("#define A\n")
+     .addSource(VertexSource);
+
+    const std::string key = cache.key({a});
+
+    /* SHA-1 in hex */
+    CORRADE_COMPARE(key.size(), 40);
+
+    /* Same sources and types give the same key, the shaders don't need to
+       be compiled for that */
+    CORRADE_COMPARE(cache.key({b}), key);
+    CORRADE_COMPARE(cache.key({d}), cache.key({e}));
+
+    /* Different type, different sources or different order doesn't */
+    CORRADE_VERIFY(cache.key({c}) != key);
+    CORRADE_VERIFY(cache.key({d}) != key);
+    CORRADE_VERIFY(cache.key({a, c}) != cache.key({c, a}));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ProgramBinaryCacheGLTest::loadSave() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("Program binaries are not supported by the driver");
+
+    const std::string filename = Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_SAVE_DIR, keyForSources() + ".bin");
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    bool cached;
+    {
+        MyShader shader{cache, cached};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(!cached);
+    }
+
+    CORRADE_VERIFY(Utility::Directory::exists(filename));
+
+    /* Second time it's taken from the cache */
+    MyShader shader{cache, cached};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cached);
+    CORRADE_VERIFY(shader.uniformLocation("matrix") >= 0);
+    CORRADE_VERIFY(shader.uniformLocation("color") >= 0);
+}
+
+void ProgramBinaryCacheGLTest::loadMissing() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+
+    MyShader shader;
+    CORRADE_VERIFY(!cache.load(shader, "nonexistent"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ProgramBinaryCacheGLTest::loadCorrupted() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("Program binaries are not supported by the driver");
+
+    /* Too short to even contain the header */
+    const std::string filename = Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_SAVE_DIR, "corrupted.bin");
+    CORRADE_VERIFY(Utility::Directory::mkpath(PROGRAMBINARYCACHEGLTEST_SAVE_DIR));
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "MPB"));
+
+    MyShader shader;
+    CORRADE_VERIFY(!cache.load(shader, "corrupted"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The file gets removed so it isn't attempted again */
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+}
+
+void ProgramBinaryCacheGLTest::loadRejected() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("Program binaries are not supported by the driver");
+
+    /* A valid header with a supported format, but garbage data, which the
+       driver should reject */
+    GLint formatCount;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+    Containers::Array<GLint> formats{Containers::NoInit, std::size_t(formatCount)};
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats);
+    char data[8 + 32]{'M', 'P', 'B', '1'};
+    const UnsignedInt formatValue = formats[0];
+    std::memcpy(data + 4, &formatValue, 4);
+    const std::string filename = Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_SAVE_DIR, "rejected.bin");
+    CORRADE_VERIFY(Utility::Directory::mkpath(PROGRAMBINARYCACHEGLTEST_SAVE_DIR));
+    CORRADE_VERIFY(Utility::Directory::write(filename, data));
+
+    MyShader shader;
+    CORRADE_VERIFY(!cache.load(shader, "rejected"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+}
+
+void ProgramBinaryCacheGLTest::saveNotLinked() {
+    ProgramBinaryCache cache{PROGRAMBINARYCACHEGLTEST_SAVE_DIR};
+    if(!cache.isSupported())
+        CORRADE_SKIP("Program binaries are not supported by the driver");
+
+    MyShader shader;
+    CORRADE_VERIFY(!cache.save(shader, "notlinked"));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!Utility::Directory::exists(Utility::Directory::join(PROGRAMBINARYCACHEGLTEST_SAVE_DIR, "notlinked.bin")));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::ProgramBinaryCacheGLTest)
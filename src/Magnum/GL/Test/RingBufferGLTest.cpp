@@ -0,0 +1,350 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/RingBuffer.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct RingBufferGLTest: OpenGLTester {
+    explicit RingBufferGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+    void constructZeroSize();
+
+    void allocate();
+    void allocateAlignment();
+    void allocateUniform();
+    void allocateWrapAround();
+    void allocateTooLarge();
+    void allocateInvalidAlignment();
+    void allocateUnfenced();
+
+    void tryAllocate();
+    void tryAllocateTooLarge();
+    void tryAllocateInvalidAlignment();
+
+    void fenceNothingAllocated();
+};
+
+RingBufferGLTest::RingBufferGLTest() {
+    addTests({&RingBufferGLTest::construct,
+              &RingBufferGLTest::constructNoCreate,
+              &RingBufferGLTest::constructMove,
+              &RingBufferGLTest::constructZeroSize,
+
+              &RingBufferGLTest::allocate,
+              &RingBufferGLTest::allocateAlignment,
+              &RingBufferGLTest::allocateUniform,
+              &RingBufferGLTest::allocateWrapAround,
+              &RingBufferGLTest::allocateTooLarge,
+              &RingBufferGLTest::allocateInvalidAlignment,
+              &RingBufferGLTest::allocateUnfenced,
+
+              &RingBufferGLTest::tryAllocate,
+              &RingBufferGLTest::tryAllocateTooLarge,
+              &RingBufferGLTest::tryAllocateInvalidAlignment,
+
+              &RingBufferGLTest::fenceNothingAllocated});
+}
+
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::buffer_storage>()) \
+        CORRADE_SKIP(Extensions::ARB::buffer_storage::string() + std::string(" is not available."))
+
+void RingBufferGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    {
+        RingBuffer ring{1024, Buffer::TargetHint::Uniform};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_VERIFY(ring.buffer().id() > 0);
+        CORRADE_COMPARE(ring.buffer().targetHint(), Buffer::TargetHint::Uniform);
+        CORRADE_COMPARE(ring.buffer().size(), 1024);
+        CORRADE_COMPARE(ring.size(), 1024);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::constructNoCreate() {
+    {
+        RingBuffer ring{NoCreate};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer a{1024};
+    const GLuint id = a.buffer().id();
+    a.allocate(16);
+    a.fence();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    RingBuffer b{std::move(a)};
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_COMPARE(b.size(), 1024);
+
+    RingBuffer c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.buffer().id(), id);
+    CORRADE_COMPARE(c.size(), 1024);
+
+    /* The following allocation continues after the previous one */
+    CORRADE_COMPARE(c.allocate(16).offset, 16);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<RingBuffer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<RingBuffer>::value);
+}
+
+void RingBufferGLTest::constructZeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    RingBuffer{0};
+    CORRADE_COMPARE(out.str(), "GL::RingBuffer: size can't be zero\n");
+}
+
+void RingBufferGLTest::allocate() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    RingBuffer::Allocation a = ring.allocate(16);
+    CORRADE_COMPARE(a.offset, 0);
+    CORRADE_COMPARE(a.data.size(), 16);
+
+    RingBuffer::Allocation b = ring.allocate(8);
+    CORRADE_COMPARE(b.offset, 16);
+    CORRADE_COMPARE(b.data.size(), 8);
+    CORRADE_COMPARE(b.data.data(), a.data.data() + 16);
+
+    /* Write through the mapping, the data should be visible in the buffer
+       without any explicit flush */
+    constexpr char expected[]{3, 6, 9, 12, 15, 18, 21, 24};
+    Utility::copy(Containers::arrayView(expected), b.data);
+    ring.fence();
+    Renderer::finish();
+
+    Containers::Array<char> data = ring.buffer().subData(16, 8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void RingBufferGLTest::allocateAlignment() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{1024};
+
+    CORRADE_COMPARE(ring.allocate(3, 1).offset, 0);
+    CORRADE_COMPARE(ring.allocate(3, 1).offset, 3);
+    /* Default alignment is four bytes */
+    CORRADE_COMPARE(ring.allocate(3).offset, 8);
+    CORRADE_COMPARE(ring.allocate(3, 256).offset, 256);
+    CORRADE_COMPARE(ring.allocate(3, 2).offset, 260);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::allocateUniform() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{4096, Buffer::TargetHint::Uniform};
+
+    const Int alignment = Buffer::uniformOffsetAlignment();
+    CORRADE_COMPARE(ring.allocateUniform(3).offset, 0);
+    CORRADE_COMPARE(ring.allocateUniform(3).offset, alignment);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::allocateWrapAround() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    /* Three "frames" of 24 bytes, the third doesn't fit to the end so it
+       wraps to the beginning, waiting for the first frame to be done */
+    CORRADE_COMPARE(ring.allocate(24).offset, 0);
+    ring.fence();
+    CORRADE_COMPARE(ring.allocate(24).offset, 24);
+    ring.fence();
+    CORRADE_COMPARE(ring.allocate(24).offset, 0);
+    ring.fence();
+
+    /* This fits after the third frame again, and waits for the second and
+       third */
+    CORRADE_COMPARE(ring.allocate(40).offset, 24);
+    ring.fence();
+
+    /* The whole buffer */
+    CORRADE_COMPARE(ring.allocate(64).offset, 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::allocateTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ring.allocate(65);
+    CORRADE_COMPARE(out.str(), "GL::RingBuffer::allocate(): requested 65 bytes but the buffer has only 64\n");
+}
+
+void RingBufferGLTest::allocateInvalidAlignment() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ring.allocate(16, 0);
+    ring.allocate(16, 12);
+    CORRADE_COMPARE(out.str(),
+        "GL::RingBuffer::allocate(): expected alignment to be a non-zero power of two, got 0\n"
+        "GL::RingBuffer::allocate(): expected alignment to be a non-zero power of two, got 12\n");
+}
+
+void RingBufferGLTest::allocateUnfenced() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+    ring.allocate(32);
+    ring.allocate(24);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ring.allocate(16);
+    CORRADE_COMPARE(out.str(), "GL::RingBuffer::allocate(): allocation of 16 bytes would overwrite data allocated since the last fence(), call it more often or use a larger buffer\n");
+}
+
+void RingBufferGLTest::tryAllocate() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    Containers::Optional<RingBuffer::Allocation> a = ring.tryAllocate(48);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->offset, 0);
+    CORRADE_COMPARE(a->data.size(), 48);
+    ring.fence();
+
+    /* After the GPU is done the fence is signaled, so the wrapped-around
+       allocation succeeds without waiting. There's no reliable way to test
+       the case where the fence isn't signaled yet. */
+    Renderer::finish();
+    Containers::Optional<RingBuffer::Allocation> b = ring.tryAllocate(32);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->offset, 0);
+    CORRADE_COMPARE(b->data.size(), 32);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void RingBufferGLTest::tryAllocateTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ring.tryAllocate(65);
+    CORRADE_COMPARE(out.str(), "GL::RingBuffer::tryAllocate(): requested 65 bytes but the buffer has only 64\n");
+}
+
+void RingBufferGLTest::tryAllocateInvalidAlignment() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ring.tryAllocate(16, 0);
+    CORRADE_COMPARE(out.str(), "GL::RingBuffer::tryAllocate(): expected alignment to be a non-zero power of two, got 0\n");
+}
+
+void RingBufferGLTest::fenceNothingAllocated() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    RingBuffer ring{64};
+
+    /* Shouldn't create any fence and thus the allocation isn't waiting for
+       anything */
+    ring.fence();
+    CORRADE_COMPARE(ring.allocate(64).offset, 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::RingBufferGLTest)
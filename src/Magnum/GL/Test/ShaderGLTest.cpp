@@ -23,8 +23,11 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/String.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
@@ -52,6 +55,8 @@ struct ShaderGLTest: OpenGLTester {
     void compile();
     void compileUtf8();
     void compileNoVersion();
+    void compileAsync();
+    void compileAsyncFailure();
 };
 
 ShaderGLTest::ShaderGLTest() {
@@ -68,7 +73,9 @@ ShaderGLTest::ShaderGLTest() {
               &ShaderGLTest::addFile,
               &ShaderGLTest::compile,
               &ShaderGLTest::compileUtf8,
-              &ShaderGLTest::compileNoVersion});
+              &ShaderGLTest::compileNoVersion,
+              &ShaderGLTest::compileAsync,
+              &ShaderGLTest::compileAsyncFailure});
 }
 
 void ShaderGLTest::construct() {
@@ -302,6 +309,65 @@ void ShaderGLTest::compileNoVersion() {
     CORRADE_VERIFY(shader.compile());
 }
 
+void ShaderGLTest::compileAsync() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader shader(v, Shader::Type::Fragment);
+    shader.addSource("void main() {}\n");
+    shader.submitCompile();
+
+    while(!shader.isCompileFinished())
+        Utility::System::sleep(100);
+
+    CORRADE_VERIFY(shader.checkCompile());
+    CORRADE_VERIFY(shader.isCompileFinished());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ShaderGLTest::compileAsyncFailure() {
+    #ifndef MAGNUM_TARGET_GLES
+    constexpr Version v =
+        #ifndef CORRADE_TARGET_APPLE
+        Version::GL210
+        #else
+        Version::GL310
+        #endif
+        ;
+    #else
+    constexpr Version v = Version::GLES200;
+    #endif
+
+    Shader a(v, Shader::Type::Fragment);
+    a.addSource("void main() {}\n");
+    Shader b(v, Shader::Type::Fragment);
+    b.addSource("[fu] bleh error #:! stuff\n");
+    a.submitCompile();
+    b.submitCompile();
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!Shader::checkCompile({a, b}));
+    }
+
+    /* The actual message is driver-specific, check just the numbered prefix
+       that matches the synchronous compile() */
+    CORRADE_VERIFY(Utility::String::beginsWith(out.str(), "GL::Shader::compile(): compilation of fragment shader 2 failed with the following message:"));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::GL::Test::ShaderGLTest)
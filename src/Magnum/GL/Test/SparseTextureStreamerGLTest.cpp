@@ -0,0 +1,457 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/SparseTextureStreamer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct SparseTextureStreamerGLTest: OpenGLTester {
+    explicit SparseTextureStreamerGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+    void constructZero();
+
+    void levelOutOfRange();
+    void tileOutOfRange();
+    void setEvictionFrameCountZero();
+    void updateNoLoader();
+
+    void request();
+    void requestCoarserFirst();
+    void feedback();
+    void loadFailed();
+    void evict();
+};
+
+SparseTextureStreamerGLTest::SparseTextureStreamerGLTest() {
+    addTests({&SparseTextureStreamerGLTest::construct,
+              &SparseTextureStreamerGLTest::constructNoCreate,
+              &SparseTextureStreamerGLTest::constructMove,
+              &SparseTextureStreamerGLTest::constructZero,
+
+              &SparseTextureStreamerGLTest::levelOutOfRange,
+              &SparseTextureStreamerGLTest::tileOutOfRange,
+              &SparseTextureStreamerGLTest::setEvictionFrameCountZero,
+              &SparseTextureStreamerGLTest::updateNoLoader,
+
+              &SparseTextureStreamerGLTest::request,
+              &SparseTextureStreamerGLTest::requestCoarserFirst,
+              &SparseTextureStreamerGLTest::feedback,
+              &SparseTextureStreamerGLTest::loadFailed,
+              &SparseTextureStreamerGLTest::evict});
+}
+
+#define SKIP_IF_NO_SSBO()                                                   \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::shader_storage_buffer_object>()) \
+        CORRADE_SKIP(Extensions::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."))
+
+/* Sets up a two-level sparse texture where the first level has 2x2 pages,
+   returns the page size or a zero vector if not supported */
+Vector2i sparseTexture(Texture2D& texture) {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::shader_storage_buffer_object>() ||
+       !Context::current().isExtensionSupported<Extensions::ARB::sparse_texture>())
+        return {};
+
+    Containers::Array<Vector2i> sizes = Texture2D::sparsePageSizes(TextureFormat::RGBA8);
+    if(sizes.empty()) return {};
+
+    texture.setSparseStorage(2, TextureFormat::RGBA8, sizes[0]*2, 0);
+    return sizes[0];
+}
+
+#define SKIP_IF_NO_SPARSE_TEXTURE(pageSize)                                 \
+    if(pageSize.isZero())                                                   \
+        CORRADE_SKIP(Extensions::ARB::sparse_texture::string() + std::string(" or ") + Extensions::ARB::shader_storage_buffer_object::string() + std::string(" is not supported."))
+
+struct LoaderState {
+    std::size_t calls;
+    Int lastLevel;
+    Vector2i lastTile;
+    bool fail;
+};
+
+bool loader(Int level, const Vector2i& tile, const MutableImageView2D& destination, void* state) {
+    LoaderState& s = *static_cast<LoaderState*>(state);
+    ++s.calls;
+    s.lastLevel = level;
+    s.lastTile = tile;
+    if(s.fail) return false;
+
+    /* Encode the tile and level into the color so it can be verified */
+    for(Containers::StridedArrayView1D<Color4ub> row: destination.pixels<Color4ub>())
+        for(Color4ub& pixel: row)
+            pixel = {UnsignedByte(tile.x()), UnsignedByte(tile.y()), UnsignedByte(level), 0xff};
+    return true;
+}
+
+void SparseTextureStreamerGLTest::construct() {
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    {
+        SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}, 2};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(streamer.format(), PixelFormat::RGBA8Unorm);
+        CORRADE_COMPARE(streamer.size(), (Vector2i{300, 200}));
+        CORRADE_COMPARE(streamer.levelCount(), 3);
+        CORRADE_COMPARE(streamer.tileSize(), (Vector2i{128, 128}));
+        CORRADE_COMPARE(streamer.evictionFrameCount(), 60);
+        CORRADE_COMPARE(streamer.frame(), 0);
+        CORRADE_COMPARE(streamer.residentTileCount(), 0);
+        CORRADE_COMPARE(streamer.loadingTileCount(), 0);
+
+        /* 300x200, 150x100, 75x50 */
+        CORRADE_COMPARE(streamer.tileCount(0), (Vector2i{3, 2}));
+        CORRADE_COMPARE(streamer.tileCount(1), (Vector2i{2, 1}));
+        CORRADE_COMPARE(streamer.tileCount(2), (Vector2i{1, 1}));
+        CORRADE_COMPARE(streamer.tileOffset(0), 0);
+        CORRADE_COMPARE(streamer.tileOffset(1), 6);
+        CORRADE_COMPARE(streamer.tileOffset(2), 8);
+        CORRADE_COMPARE(streamer.totalTileCount(), 9);
+        CORRADE_COMPARE(streamer.feedbackBuffer().size(), 9*4);
+        CORRADE_VERIFY(!streamer.isResident(1, {1, 0}));
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void SparseTextureStreamerGLTest::constructNoCreate() {
+    {
+        SparseTextureStreamer streamer{NoCreate};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void SparseTextureStreamerGLTest::constructMove() {
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    SparseTextureStreamer a{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}};
+    a.setEvictionFrameCount(5);
+
+    SparseTextureStreamer b{std::move(a)};
+    CORRADE_COMPARE(b.totalTileCount(), 9);
+    CORRADE_COMPARE(b.evictionFrameCount(), 5);
+
+    SparseTextureStreamer c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.totalTileCount(), 9);
+    CORRADE_COMPARE(c.evictionFrameCount(), 5);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SparseTextureStreamer>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SparseTextureStreamer>::value);
+}
+
+void SparseTextureStreamerGLTest::constructZero() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Texture2D texture{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SparseTextureStreamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 0, {128, 128}};
+    SparseTextureStreamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 0}};
+    SparseTextureStreamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::SparseTextureStreamer: expected non-zero level count, tile size and staging buffer count, got 0, Vector(128, 128) and 4\n"
+        "GL::SparseTextureStreamer: expected non-zero level count, tile size and staging buffer count, got 3, Vector(128, 0) and 4\n"
+        "GL::SparseTextureStreamer: expected non-zero level count, tile size and staging buffer count, got 3, Vector(128, 128) and 0\n");
+}
+
+void SparseTextureStreamerGLTest::levelOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.tileCount(3);
+    streamer.tileOffset(3);
+    streamer.isResident(3, {});
+    streamer.request(3, {});
+    CORRADE_COMPARE(out.str(),
+        "GL::SparseTextureStreamer::tileCount(): level 3 out of range for 3 levels\n"
+        "GL::SparseTextureStreamer::tileOffset(): level 3 out of range for 3 levels\n"
+        "GL::SparseTextureStreamer::isResident(): level 3 out of range for 3 levels\n"
+        "GL::SparseTextureStreamer::request(): level 3 out of range for 3 levels\n");
+}
+
+void SparseTextureStreamerGLTest::tileOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.isResident(1, {2, 0});
+    streamer.request(0, {0, -1});
+    CORRADE_COMPARE(out.str(),
+        "GL::SparseTextureStreamer::isResident(): tile Vector(2, 0) out of range for Vector(2, 1) tiles in level 1\n"
+        "GL::SparseTextureStreamer::request(): tile Vector(0, -1) out of range for Vector(3, 2) tiles in level 0\n");
+}
+
+void SparseTextureStreamerGLTest::setEvictionFrameCountZero() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.setEvictionFrameCount(0);
+    CORRADE_COMPARE(out.str(), "GL::SparseTextureStreamer::setEvictionFrameCount(): expected a non-zero count\n");
+}
+
+void SparseTextureStreamerGLTest::updateNoLoader() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NO_SSBO();
+
+    Texture2D texture;
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, {300, 200}, 3, {128, 128}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.update();
+    CORRADE_COMPARE(out.str(), "GL::SparseTextureStreamer::update(): no loader set\n");
+}
+
+void SparseTextureStreamerGLTest::request() {
+    Texture2D texture;
+    const Vector2i pageSize = sparseTexture(texture);
+    SKIP_IF_NO_SPARSE_TEXTURE(pageSize);
+
+    LoaderState state{};
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, pageSize*2, 1, pageSize};
+    streamer.setLoader(loader, &state);
+
+    /* Nothing requested, nothing to load */
+    streamer.update();
+    CORRADE_VERIFY(!streamer.load());
+    CORRADE_COMPARE(state.calls, 0);
+
+    streamer.request(0, {1, 0});
+    streamer.update();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 1);
+    CORRADE_COMPARE(streamer.residentTileCount(), 0);
+    CORRADE_VERIFY(!streamer.isResident(0, {1, 0}));
+
+    CORRADE_VERIFY(streamer.load());
+    CORRADE_VERIFY(!streamer.load());
+    CORRADE_COMPARE(state.calls, 1);
+    CORRADE_COMPARE(state.lastLevel, 0);
+    CORRADE_COMPARE(state.lastTile, (Vector2i{1, 0}));
+
+    /* The upload happens on the next update */
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 0);
+    CORRADE_COMPARE(streamer.residentTileCount(), 1);
+    CORRADE_VERIFY(streamer.isResident(0, {1, 0}));
+    CORRADE_VERIFY(!streamer.isResident(0, {0, 0}));
+
+    Image2D image = texture.subImage(0, Range2Di::fromSize({pageSize.x(), 0}, pageSize), {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[0][0], (Color4ub{1, 0, 0, 0xff}));
+    CORRADE_COMPARE(image.pixels<Color4ub>()[pageSize.y() - 1][pageSize.x() - 1], (Color4ub{1, 0, 0, 0xff}));
+}
+
+void SparseTextureStreamerGLTest::requestCoarserFirst() {
+    Texture2D texture;
+    const Vector2i pageSize = sparseTexture(texture);
+    SKIP_IF_NO_SPARSE_TEXTURE(pageSize);
+
+    /* Just one staging buffer, so only one tile gets loaded at a time */
+    LoaderState state{};
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, pageSize*2, 2, pageSize, 1};
+    streamer.setLoader(loader, &state);
+
+    /* Requesting a tile in the first level requests the one in the second
+       level as well, which gets loaded first */
+    streamer.request(0, {1, 1});
+    streamer.update();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 1);
+    CORRADE_VERIFY(streamer.load());
+    CORRADE_VERIFY(!streamer.load());
+    CORRADE_COMPARE(state.lastLevel, 1);
+    CORRADE_COMPARE(state.lastTile, (Vector2i{0, 0}));
+
+    /* The finer tile waits for a staging buffer to become free */
+    streamer.update();
+    CORRADE_VERIFY(streamer.isResident(1, {0, 0}));
+    Renderer::finish();
+    streamer.update();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 1);
+    CORRADE_VERIFY(streamer.load());
+    CORRADE_COMPARE(state.lastLevel, 0);
+    CORRADE_COMPARE(state.lastTile, (Vector2i{1, 1}));
+
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.residentTileCount(), 2);
+    CORRADE_VERIFY(streamer.isResident(0, {1, 1}));
+}
+
+void SparseTextureStreamerGLTest::feedback() {
+    Texture2D texture;
+    const Vector2i pageSize = sparseTexture(texture);
+    SKIP_IF_NO_SPARSE_TEXTURE(pageSize);
+
+    LoaderState state{};
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, pageSize*2, 1, pageSize};
+    streamer.setLoader(loader, &state);
+
+    /* Simulate a shader writing to the feedback buffer */
+    const UnsignedInt requested[]{1};
+    streamer.feedbackBuffer().setSubData((streamer.tileOffset(0) + 1*2 + 1)*4, requested);
+
+    /* The first update issues a readback, the second processes it once the
+       GPU is done */
+    streamer.update();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 0);
+    Renderer::finish();
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 1);
+
+    CORRADE_VERIFY(streamer.load());
+    CORRADE_COMPARE(state.lastTile, (Vector2i{1, 1}));
+
+    /* The feedback got cleared, so nothing more gets requested */
+    Renderer::finish();
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 0);
+    CORRADE_COMPARE(streamer.residentTileCount(), 1);
+    CORRADE_VERIFY(!streamer.load());
+}
+
+void SparseTextureStreamerGLTest::loadFailed() {
+    Texture2D texture;
+    const Vector2i pageSize = sparseTexture(texture);
+    SKIP_IF_NO_SPARSE_TEXTURE(pageSize);
+
+    LoaderState state{};
+    state.fail = true;
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, pageSize*2, 1, pageSize};
+    streamer.setLoader(loader, &state);
+
+    streamer.request(0, {0, 1});
+    streamer.update();
+    CORRADE_VERIFY(streamer.load());
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 0);
+    CORRADE_COMPARE(streamer.residentTileCount(), 0);
+    CORRADE_VERIFY(!streamer.isResident(0, {0, 1}));
+
+    /* It isn't retried unless requested again */
+    CORRADE_VERIFY(!streamer.load());
+    CORRADE_COMPARE(state.calls, 1);
+}
+
+void SparseTextureStreamerGLTest::evict() {
+    Texture2D texture;
+    const Vector2i pageSize = sparseTexture(texture);
+    SKIP_IF_NO_SPARSE_TEXTURE(pageSize);
+
+    LoaderState state{};
+    SparseTextureStreamer streamer{texture, PixelFormat::RGBA8Unorm, pageSize*2, 1, pageSize};
+    streamer.setLoader(loader, &state)
+        .setEvictionFrameCount(3);
+
+    /* Requested in frame 0, uploaded in frame 1 */
+    streamer.request(0, {0, 0});
+    streamer.update();
+    CORRADE_VERIFY(streamer.load());
+    streamer.update();
+    CORRADE_COMPARE(streamer.residentTileCount(), 1);
+
+    /* Requesting again in frame 2 keeps it resident until frame 5 */
+    streamer.request(0, {0, 0});
+    streamer.update();
+    streamer.update();
+    streamer.update();
+    CORRADE_COMPARE(streamer.frame(), 5);
+    CORRADE_COMPARE(streamer.residentTileCount(), 1);
+
+    streamer.update();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.residentTileCount(), 0);
+    CORRADE_VERIFY(!streamer.isResident(0, {0, 0}));
+
+    /* Re-requesting it loads it again */
+    streamer.request(0, {0, 0});
+    streamer.update();
+    CORRADE_COMPARE(streamer.loadingTileCount(), 1);
+    CORRADE_VERIFY(streamer.load());
+    CORRADE_COMPARE(state.calls, 2);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::SparseTextureStreamerGLTest)
@@ -81,6 +81,15 @@ struct TextureGLTest: OpenGLTester {
     void bindImage3D();
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    void handle();
+    void handleResident();
+    void handleResidentMove();
+
+    void sparsePageSizes2D();
+    void sparseStorage2D();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     template<class T> void sampling1D();
     #endif
@@ -461,6 +470,15 @@ TextureGLTest::TextureGLTest() {
         &TextureGLTest::bindImage3D,
         #endif
 
+        #ifndef MAGNUM_TARGET_GLES
+        &TextureGLTest::handle,
+        &TextureGLTest::handleResident,
+        &TextureGLTest::handleResidentMove,
+
+        &TextureGLTest::sparsePageSizes2D,
+        &TextureGLTest::sparseStorage2D,
+        #endif
+
         #ifndef MAGNUM_TARGET_GLES
         &TextureGLTest::sampling1D<GenericSampler>,
         &TextureGLTest::sampling1D<GLSampler>,
@@ -913,6 +931,123 @@ void TextureGLTest::bindImage3D() {
 }
 #endif
 
+#ifndef MAGNUM_TARGET_GLES
+void TextureGLTest::handle() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    const UnsignedLong handle = texture.handle();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(handle);
+    CORRADE_VERIFY(!texture.isResident());
+
+    /* The handle is cached */
+    CORRADE_COMPARE(texture.handle(), handle);
+}
+
+void TextureGLTest::handleResident() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+
+    texture.makeResident();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(texture.isResident());
+    CORRADE_VERIFY(glIsTextureHandleResidentARB(texture.handle()));
+
+    /* Making resident again is a no-op, which would be a GL error otherwise */
+    texture.makeResident();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    texture.makeNonResident();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!texture.isResident());
+    CORRADE_VERIFY(!glIsTextureHandleResidentARB(texture.handle()));
+
+    /* Same here */
+    texture.makeNonResident();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Destroying a resident texture makes it non-resident first */
+    texture.makeResident();
+}
+
+void TextureGLTest::handleResidentMove() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() + std::string(" is not supported."));
+
+    Texture2D a;
+    a.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    a.makeResident();
+    const UnsignedLong handle = a.handle();
+
+    Texture2D b{std::move(a)};
+    CORRADE_VERIFY(!a.isResident());
+    CORRADE_VERIFY(b.isResident());
+    CORRADE_COMPARE(b.handle(), handle);
+
+    Texture2D c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(c.isResident());
+    CORRADE_COMPARE(c.handle(), handle);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureGLTest::sparsePageSizes2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    Containers::Array<Vector2i> sizes = Texture2D::sparsePageSizes(TextureFormat::RGBA8);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!sizes.empty());
+    for(const Vector2i& size: sizes) {
+        CORRADE_ITERATION(size);
+        CORRADE_VERIFY(size.product());
+    }
+}
+
+void TextureGLTest::sparseStorage2D() {
+    if(!Context::current().isExtensionSupported<Extensions::ARB::sparse_texture>())
+        CORRADE_SKIP(Extensions::ARB::sparse_texture::string() + std::string(" is not supported."));
+
+    Containers::Array<Vector2i> sizes = Texture2D::sparsePageSizes(TextureFormat::RGBA8);
+    if(sizes.empty())
+        CORRADE_SKIP("No sparse page sizes supported for TextureFormat::RGBA8.");
+    const Vector2i pageSize = sizes[0];
+
+    Texture2D texture;
+    texture.setSparseStorage(1, TextureFormat::RGBA8, pageSize*2, 0);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Commit just the last page and upload data to it */
+    texture.setPageCommitment(0, {pageSize, pageSize*2}, true);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Containers::Array<char> data{Containers::DirectInit, std::size_t(pageSize.product()*4), '\x33'};
+    texture.setSubImage(0, pageSize, ImageView2D{PixelFormat::RGBA, PixelType::UnsignedByte, pageSize, data});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = texture.subImage(0, {pageSize, pageSize*2}, {PixelFormat::RGBA, PixelType::UnsignedByte});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(image.data(), data, TestSuite::Compare::Container);
+
+    texture.setPageCommitment(0, {pageSize, pageSize*2}, false);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 #ifndef MAGNUM_TARGET_GLES
 template<class T> void TextureGLTest::sampling1D() {
     setTestCaseTemplateName(std::is_same<T, GenericSampler>::value ?
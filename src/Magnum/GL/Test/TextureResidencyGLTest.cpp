@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/TextureResidency.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TextureResidencyGLTest: OpenGLTester {
+    explicit TextureResidencyGLTest();
+
+    void construct();
+    void constructMove();
+    void constructZeroEvictionFrameCount();
+
+    void use();
+    void useOverBudget();
+    void useOverBudgetAllUsedThisFrame();
+    void remove();
+
+    void nextFrame();
+    void destruct();
+};
+
+TextureResidencyGLTest::TextureResidencyGLTest() {
+    addTests({&TextureResidencyGLTest::construct,
+              &TextureResidencyGLTest::constructMove,
+              &TextureResidencyGLTest::constructZeroEvictionFrameCount,
+
+              &TextureResidencyGLTest::use,
+              &TextureResidencyGLTest::useOverBudget,
+              &TextureResidencyGLTest::useOverBudgetAllUsedThisFrame,
+              &TextureResidencyGLTest::remove,
+
+              &TextureResidencyGLTest::nextFrame,
+              &TextureResidencyGLTest::destruct});
+}
+
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!Context::current().isExtensionSupported<Extensions::ARB::bindless_texture>()) \
+        CORRADE_SKIP(Extensions::ARB::bindless_texture::string() + std::string(" is not available."))
+
+Texture2D completeTexture() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {4, 4});
+    return texture;
+}
+
+void TextureResidencyGLTest::construct() {
+    TextureResidency residency{16, 3};
+    CORRADE_COMPARE(residency.maxResidentCount(), 16);
+    CORRADE_COMPARE(residency.evictionFrameCount(), 3);
+    CORRADE_COMPARE(residency.frame(), 0);
+    CORRADE_COMPARE(residency.residentCount(), 0);
+    CORRADE_COMPARE(residency.evictedCount(), 0);
+}
+
+void TextureResidencyGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D texture = completeTexture();
+
+    TextureResidency a{16, 3};
+    a.use(texture);
+
+    TextureResidency b{std::move(a)};
+    CORRADE_COMPARE(b.maxResidentCount(), 16);
+    CORRADE_COMPARE(b.residentCount(), 1);
+
+    TextureResidency c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.maxResidentCount(), 16);
+    CORRADE_COMPARE(c.residentCount(), 1);
+    CORRADE_VERIFY(c.contains(texture));
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TextureResidency>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TextureResidency>::value);
+}
+
+void TextureResidencyGLTest::constructZeroEvictionFrameCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TextureResidency{16, 0};
+    CORRADE_COMPARE(out.str(), "GL::TextureResidency: eviction frame count can't be zero\n");
+}
+
+void TextureResidencyGLTest::use() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    Texture2D b = completeTexture();
+
+    TextureResidency residency;
+    const UnsignedLong handleA = residency.use(a);
+    const UnsignedLong handleB = residency.use(b);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(handleA, a.handle());
+    CORRADE_COMPARE(handleB, b.handle());
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_VERIFY(b.isResident());
+    CORRADE_VERIFY(residency.contains(a));
+    CORRADE_VERIFY(residency.contains(b));
+    CORRADE_COMPARE(residency.residentCount(), 2);
+
+    /* Using again doesn't add anything */
+    CORRADE_COMPARE(residency.use(a), handleA);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.residentCount(), 2);
+}
+
+void TextureResidencyGLTest::useOverBudget() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    Texture2D b = completeTexture();
+    Texture2D c = completeTexture();
+
+    TextureResidency residency{2};
+    residency.use(a);
+    residency.nextFrame();
+    residency.use(b);
+    residency.nextFrame();
+
+    /* A is used again, which makes B the least recently used */
+    residency.use(a);
+    residency.use(c);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.residentCount(), 2);
+    CORRADE_COMPARE(residency.evictedCount(), 1);
+    CORRADE_VERIFY(residency.contains(a));
+    CORRADE_VERIFY(!residency.contains(b));
+    CORRADE_VERIFY(residency.contains(c));
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_VERIFY(!b.isResident());
+    CORRADE_VERIFY(c.isResident());
+}
+
+void TextureResidencyGLTest::useOverBudgetAllUsedThisFrame() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    Texture2D b = completeTexture();
+
+    /* Both are used in the same frame, so none can be evicted */
+    TextureResidency residency{1};
+    residency.use(a);
+    residency.use(b);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.residentCount(), 2);
+    CORRADE_COMPARE(residency.evictedCount(), 0);
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_VERIFY(b.isResident());
+}
+
+void TextureResidencyGLTest::remove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    Texture2D b = completeTexture();
+
+    TextureResidency residency;
+    residency.use(a);
+    residency.use(b);
+
+    residency.remove(a);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!residency.contains(a));
+    CORRADE_VERIFY(residency.contains(b));
+    CORRADE_VERIFY(!a.isResident());
+    CORRADE_COMPARE(residency.residentCount(), 1);
+    /* Explicit removal isn't counted as an eviction */
+    CORRADE_COMPARE(residency.evictedCount(), 0);
+
+    /* Removing an untracked texture does nothing */
+    residency.remove(a);
+    CORRADE_COMPARE(residency.residentCount(), 1);
+}
+
+void TextureResidencyGLTest::nextFrame() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    Texture2D b = completeTexture();
+    Texture2D c = completeTexture();
+
+    TextureResidency residency{0, 1};
+    residency.use(a);
+    residency.use(b);
+    residency.use(c);
+    residency.nextFrame();
+    CORRADE_COMPARE(residency.frame(), 1);
+    CORRADE_COMPARE(residency.residentCount(), 3);
+
+    /* B is used in the second frame, A and C not */
+    residency.use(b);
+    residency.nextFrame();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(residency.frame(), 2);
+    CORRADE_COMPARE(residency.residentCount(), 1);
+    CORRADE_COMPARE(residency.evictedCount(), 2);
+    CORRADE_VERIFY(!a.isResident());
+    CORRADE_VERIFY(b.isResident());
+    CORRADE_VERIFY(!c.isResident());
+
+    /* Using an evicted texture makes it resident again */
+    residency.use(a);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(a.isResident());
+    CORRADE_COMPARE(residency.residentCount(), 2);
+}
+
+void TextureResidencyGLTest::destruct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    Texture2D a = completeTexture();
+    {
+        TextureResidency residency;
+        residency.use(a);
+        CORRADE_VERIFY(a.isResident());
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(!a.isResident());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TextureResidencyGLTest)
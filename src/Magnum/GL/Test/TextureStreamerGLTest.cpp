@@ -0,0 +1,324 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/GL/TextureStreamer.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace GL { namespace Test { namespace {
+
+struct TextureStreamerGLTest: OpenGLTester {
+    explicit TextureStreamerGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+    void constructZero();
+
+    void acquire();
+    void acquireTooLarge();
+    void acquireAllInUse();
+
+    void upload();
+    void uploadGeneric();
+    void uploadNotAcquired();
+    void uploadTooSmall();
+
+    void discard();
+    void discardNotAcquired();
+};
+
+TextureStreamerGLTest::TextureStreamerGLTest() {
+    addTests({&TextureStreamerGLTest::construct,
+              &TextureStreamerGLTest::constructNoCreate,
+              &TextureStreamerGLTest::constructMove,
+              &TextureStreamerGLTest::constructZero,
+
+              &TextureStreamerGLTest::acquire,
+              &TextureStreamerGLTest::acquireTooLarge,
+              &TextureStreamerGLTest::acquireAllInUse,
+
+              &TextureStreamerGLTest::upload,
+              &TextureStreamerGLTest::uploadGeneric,
+              &TextureStreamerGLTest::uploadNotAcquired,
+              &TextureStreamerGLTest::uploadTooSmall,
+
+              &TextureStreamerGLTest::discard,
+              &TextureStreamerGLTest::discardNotAcquired});
+}
+
+constexpr UnsignedByte Data[]{
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+    0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+
+void TextureStreamerGLTest::construct() {
+    {
+        TextureStreamer2D streamer{1024, 2};
+
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        CORRADE_COMPARE(streamer.bufferSize(), 1024);
+        CORRADE_COMPARE(streamer.bufferCount(), 2);
+        CORRADE_COMPARE(streamer.availableCount(), 2);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::constructNoCreate() {
+    {
+        TextureStreamer2D streamer{NoCreate};
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::constructMove() {
+    TextureStreamer2D a{1024};
+    Containers::Optional<TextureStreamer2D::Staging> staging = a.acquire(16);
+    CORRADE_VERIFY(staging);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    TextureStreamer2D b{std::move(a)};
+    CORRADE_COMPARE(b.bufferSize(), 1024);
+    CORRADE_COMPARE(b.bufferCount(), 3);
+
+    TextureStreamer2D c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.bufferSize(), 1024);
+    CORRADE_COMPARE(c.bufferCount(), 3);
+
+    /* The acquired buffer stays acquired */
+    CORRADE_COMPARE(c.availableCount(), 2);
+    c.discard(*staging);
+    CORRADE_COMPARE(c.availableCount(), 3);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<TextureStreamer2D>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<TextureStreamer2D>::value);
+}
+
+void TextureStreamerGLTest::constructZero() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    TextureStreamer2D{0, 3};
+    TextureStreamer2D{1024, 0};
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureStreamer: expected non-zero buffer size and count, got 0 and 3\n"
+        "GL::TextureStreamer: expected non-zero buffer size and count, got 1024 and 0\n");
+}
+
+void TextureStreamerGLTest::acquire() {
+    TextureStreamer2D streamer{64, 2};
+
+    Containers::Optional<TextureStreamer2D::Staging> a = streamer.acquire(16);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->data.size(), 16);
+    CORRADE_COMPARE(streamer.availableCount(), 1);
+
+    Containers::Optional<TextureStreamer2D::Staging> b = streamer.acquire(64);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(b);
+    CORRADE_VERIFY(b->id != a->id);
+    CORRADE_COMPARE(b->data.size(), 64);
+    CORRADE_COMPARE(streamer.availableCount(), 0);
+
+    /* The memory is writable */
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Data)), a->data);
+
+    streamer.discard(*a);
+    streamer.discard(*b);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::acquireTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TextureStreamer2D streamer{64};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.acquire(65);
+    CORRADE_COMPARE(out.str(), "GL::TextureStreamer::acquire(): requested 65 bytes but the buffers have only 64\n");
+}
+
+void TextureStreamerGLTest::acquireAllInUse() {
+    TextureStreamer2D streamer{64, 2};
+
+    CORRADE_VERIFY(streamer.acquire(16));
+    CORRADE_VERIFY(streamer.acquire(16));
+    CORRADE_VERIFY(!streamer.acquire(16));
+    CORRADE_COMPARE(streamer.availableCount(), 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::upload() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {2, 2});
+
+    TextureStreamer2D streamer{64, 1};
+    Containers::Optional<TextureStreamer2D::Staging> staging = streamer.acquire(sizeof(Data));
+    CORRADE_VERIFY(staging);
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Data)), staging->data);
+
+    streamer.upload(*staging, texture, 0, {}, PixelFormat::RGBA, PixelType::UnsignedByte, {2, 2});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The buffer is given back once the fence guarding the upload is
+       signaled */
+    Renderer::finish();
+    CORRADE_COMPARE(streamer.availableCount(), 1);
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.image(0, {PixelFormat::RGBA, PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(image.data()),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void TextureStreamerGLTest::uploadGeneric() {
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {2, 2});
+
+    TextureStreamer2D streamer{64, 1};
+    Containers::Optional<TextureStreamer2D::Staging> staging = streamer.acquire(sizeof(Data));
+    CORRADE_VERIFY(staging);
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(Data)), staging->data);
+
+    streamer.upload(*staging, texture, 0, {}, Magnum::PixelFormat::RGBA8Unorm, {2, 2});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = texture.image(0, {Magnum::PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(image.data()),
+        Containers::arrayView(Data),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+void TextureStreamerGLTest::uploadNotAcquired() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {2, 2});
+
+    TextureStreamer2D streamer{64, 1};
+    Containers::Optional<TextureStreamer2D::Staging> staging = streamer.acquire(16);
+    CORRADE_VERIFY(staging);
+    streamer.discard(*staging);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.upload(*staging, texture, 0, {}, Magnum::PixelFormat::RGBA8Unorm, {2, 2});
+    streamer.upload(TextureStreamer2D::Staging{1, {}}, texture, 0, {}, Magnum::PixelFormat::RGBA8Unorm, {2, 2});
+    CORRADE_COMPARE(out.str(),
+        "GL::TextureStreamer::upload(): buffer 0 is not acquired\n"
+        "GL::TextureStreamer::upload(): buffer 1 is not acquired\n");
+}
+
+void TextureStreamerGLTest::uploadTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Texture2D texture;
+    texture.setStorage(1, TextureFormat::RGBA8, {2, 2});
+
+    TextureStreamer2D streamer{64, 1};
+    Containers::Optional<TextureStreamer2D::Staging> staging = streamer.acquire(15);
+    CORRADE_VERIFY(staging);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.upload(*staging, texture, 0, {}, Magnum::PixelFormat::RGBA8Unorm, {2, 2});
+    CORRADE_COMPARE(out.str(), "GL::TextureStreamer::upload(): expected at least 16 bytes but got 15\n");
+
+    /* The buffer stays acquired */
+    CORRADE_COMPARE(streamer.availableCount(), 0);
+    streamer.discard(*staging);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::discard() {
+    TextureStreamer2D streamer{64, 1};
+
+    Containers::Optional<TextureStreamer2D::Staging> staging = streamer.acquire(16);
+    CORRADE_VERIFY(staging);
+    CORRADE_COMPARE(streamer.availableCount(), 0);
+
+    streamer.discard(*staging);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(streamer.availableCount(), 1);
+
+    /* The same buffer can be acquired again */
+    Containers::Optional<TextureStreamer2D::Staging> another = streamer.acquire(16);
+    CORRADE_VERIFY(another);
+    CORRADE_COMPARE(another->id, staging->id);
+    streamer.discard(*another);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TextureStreamerGLTest::discardNotAcquired() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TextureStreamer2D streamer{64, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    streamer.discard(TextureStreamer2D::Staging{0, {}});
+    CORRADE_COMPARE(out.str(), "GL::TextureStreamer::discard(): buffer 0 is not acquired\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::GL::Test::TextureStreamerGLTest)
@@ -32,6 +32,8 @@
 #include "Magnum/GL/Implementation/TextureState.h"
 
 #ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/GL/BufferImage.h"
 #endif
@@ -62,6 +64,14 @@ template<> MAGNUM_GL_EXPORT Vector3i maxTextureSize<3>() {
 }
 
 #ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Containers::Array<VectorTypeFor<dimensions, Int>> Texture<dimensions>::sparsePageSizes(const TextureFormat format) {
+    const Containers::Array<Vector3i> sizes = AbstractTexture::sparsePageSizes(Implementation::textureTarget<dimensions>(), format);
+    Containers::Array<VectorTypeFor<dimensions, Int>> out{Containers::NoInit, sizes.size()};
+    for(std::size_t i = 0; i != sizes.size(); ++i)
+        out[i] = Math::Vector<dimensions, Int>::pad(sizes[i]);
+    return out;
+}
+
 template<UnsignedInt dimensions> Image<dimensions> Texture<dimensions>::image(const Int level, Image<dimensions>&& image) {
     this->image(level, image);
     return std::move(image);
@@ -86,6 +86,20 @@ In shader, the texture is used via @glsl sampler1D @ce / @glsl sampler2D @ce /
 @glsl usampler3D @ce. See @ref AbstractShaderProgram documentation for more
 information about usage in shaders.
 
+@section GL-Texture-sparse Sparse textures
+
+On desktop GL with @gl_extension{ARB,sparse_texture}, storage allocated with
+@ref setSparseStorage() only reserves the address space and physical memory is
+committed page by page with @ref setPageCommitment(), which allows textures
+that wouldn't otherwise fit into the video memory. Supported page sizes for a
+particular format can be queried with @ref sparsePageSizes(), the index of the
+chosen page size is then passed to @ref setSparseStorage():
+
+@snippet MagnumGL.cpp Texture-sparse
+
+See the @ref SparseTextureStreamer class for loading the pages on demand based
+on what gets actually rendered.
+
 @see @ref Texture1D, @ref Texture2D, @ref Texture3D, @ref TextureArray,
     @ref CubeMapTexture, @ref CubeMapTextureArray, @ref RectangleTexture,
     @ref BufferTexture, @ref MultisampleTexture
@@ -146,6 +160,26 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureTarget<dimensions>(), format);
         }
+
+        /**
+         * @brief Sparse page sizes
+         * @m_since_latest
+         *
+         * Returns all virtual page sizes supported for sparse textures of
+         * given @p format, in pixels. If the format can't be used for sparse
+         * textures, returns an empty array. The index of the size in the
+         * returned array is meant to be passed to @ref setSparseStorage().
+         * @see @ref GL-Texture-sparse, @fn_gl_keyword{GetInternalformat} with
+         *      @def_gl_extension{NUM_VIRTUAL_PAGE_SIZES,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_X,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_Y,ARB,sparse_texture},
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_Z,ARB,sparse_texture}
+         * @requires_gl43 Extension @gl_extension{ARB,internalformat_query2}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        static Containers::Array<VectorTypeFor<dimensions, Int>> sparsePageSizes(TextureFormat format);
         #endif
 
         /**
@@ -717,6 +751,62 @@ template<UnsignedInt dimensions> class Texture: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set sparse storage
+         * @param levels            Mip level count
+         * @param internalFormat    Internal format
+         * @param size              Size of largest mip level
+         * @param pageSizeIndex     Index into the @ref sparsePageSizes()
+         *      array for @p internalFormat
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Marks the texture as sparse and then calls @ref setStorage(). No
+         * physical memory is allocated for the texture at this point, use
+         * @ref setPageCommitment() to commit it before uploading data. The
+         * @p size is expected to be a multiple of the page size, except for
+         * the smallest mip levels that form the mip tail.
+         * @see @ref GL-Texture-sparse,
+         *      @fn_gl2_keyword{TextureParameter,TexParameter} with
+         *      @def_gl_extension{TEXTURE_SPARSE,ARB,sparse_texture} and
+         *      @def_gl_extension{VIRTUAL_PAGE_SIZE_INDEX,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Texture<dimensions>& setSparseStorage(Int levels, TextureFormat internalFormat, const VectorTypeFor<dimensions, Int>& size, Int pageSizeIndex = 0) {
+            AbstractTexture::setSparse(pageSizeIndex);
+            return setStorage(levels, internalFormat, size);
+        }
+
+        /**
+         * @brief Commit or decommit sparse texture pages
+         * @param level             Mip level
+         * @param range             Range to commit or decommit
+         * @param commit            Whether to commit or decommit the pages
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that the storage was set with @ref setSparseStorage().
+         * The @p range is expected to be aligned to the page size, except
+         * for parts that extend to the edge of the mip level. Decommitting
+         * releases the physical memory and the contents of the range become
+         * undefined. The texture is bound before the operation (if not
+         * already).
+         * @see @ref GL-Texture-sparse, @fn_gl{ActiveTexture},
+         *      @fn_gl{BindTexture} and
+         *      @fn_gl_extension_keyword{TexPageCommitment,ARB,sparse_texture}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Texture<dimensions>& setPageCommitment(Int level, const RangeTypeFor<dimensions, Int>& range, bool commit) {
+            AbstractTexture::setPageCommitment<dimensions>(level, range, commit);
+            return *this;
+        }
+        #endif
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Image size in given mip level
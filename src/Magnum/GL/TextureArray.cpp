@@ -31,6 +31,8 @@
 #include "Magnum/GL/Implementation/maxTextureSize.h"
 
 #ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/GL/BufferImage.h"
 #endif
@@ -54,6 +56,14 @@ template<UnsignedInt dimensions> VectorTypeFor<dimensions+1, Int> TextureArray<d
 }
 
 #ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Containers::Array<VectorTypeFor<dimensions, Int>> TextureArray<dimensions>::sparsePageSizes(const TextureFormat format) {
+    const Containers::Array<Vector3i> sizes = AbstractTexture::sparsePageSizes(Implementation::textureArrayTarget<dimensions>(), format);
+    Containers::Array<VectorTypeFor<dimensions, Int>> out{Containers::NoInit, sizes.size()};
+    for(std::size_t i = 0; i != sizes.size(); ++i)
+        out[i] = Math::Vector<dimensions, Int>::pad(sizes[i]);
+    return out;
+}
+
 template<UnsignedInt dimensions> Image<dimensions+1> TextureArray<dimensions>::image(const Int level, Image<dimensions+1>&& image) {
     this->image(level, image);
     return std::move(image);
@@ -130,6 +130,20 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
         static Int compressedBlockDataSize(TextureFormat format) {
             return AbstractTexture::compressedBlockDataSize(Implementation::textureArrayTarget<dimensions>(), format);
         }
+
+        /**
+         * @brief @copybrief Texture::sparsePageSizes()
+         * @m_since_latest
+         *
+         * See @ref Texture::sparsePageSizes() for more information. The
+         * page size in the layer dimension is always @cpp 1 @ce and thus
+         * isn't included.
+         * @requires_gl43 Extension @gl_extension{ARB,internalformat_query2}
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        static Containers::Array<VectorTypeFor<dimensions, Int>> sparsePageSizes(TextureFormat format);
         #endif
 
         /**
@@ -479,6 +493,40 @@ template<UnsignedInt dimensions> class TextureArray: public AbstractTexture {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief @copybrief Texture::setSparseStorage()
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setSparseStorage() for more information.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        TextureArray<dimensions>& setSparseStorage(Int levels, TextureFormat internalFormat, const VectorTypeFor<dimensions+1, Int>& size, Int pageSizeIndex = 0) {
+            AbstractTexture::setSparse(pageSizeIndex);
+            return setStorage(levels, internalFormat, size);
+        }
+
+        /**
+         * @brief @copybrief Texture::setPageCommitment()
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * See @ref Texture::setPageCommitment() for more information. Each
+         * layer is committed separately, so the layer part of @p range
+         * doesn't need any alignment.
+         * @requires_extension Extension @gl_extension{ARB,sparse_texture}
+         * @requires_gl Sparse textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        TextureArray<dimensions>& setPageCommitment(Int level, const RangeTypeFor<dimensions+1, Int>& range, bool commit) {
+            AbstractTexture::setPageCommitment<dimensions+1>(level, range, commit);
+            return *this;
+        }
+        #endif
+
         #ifndef MAGNUM_TARGET_WEBGL
         /**
          * @brief @copybrief Texture::imageSize()
@@ -0,0 +1,160 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureResidency.h"
+
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/AbstractTexture.h"
+
+namespace Magnum { namespace GL {
+
+struct TextureResidency::State {
+    explicit State(std::size_t maxResidentCount, UnsignedInt evictionFrameCount): maxResidentCount{maxResidentCount}, evictionFrameCount{evictionFrameCount} {}
+
+    struct Entry {
+        AbstractTexture* texture;
+        UnsignedLong lastUsedFrame;
+    };
+
+    /* Makes the entry non-resident and swap-removes it, updating the index
+       of the entry that got moved in its place */
+    void evict(std::size_t i);
+
+    std::size_t maxResidentCount;
+    UnsignedInt evictionFrameCount;
+    UnsignedLong frame{};
+    std::size_t evictedCount{};
+    Containers::Array<Entry> entries;
+    std::unordered_map<const AbstractTexture*, std::size_t> indices;
+};
+
+void TextureResidency::State::evict(const std::size_t i) {
+    entries[i].texture->makeNonResident();
+    indices.erase(entries[i].texture);
+    if(i != entries.size() - 1) {
+        entries[i] = entries.back();
+        indices[entries[i].texture] = i;
+    }
+    arrayRemoveSuffix(entries, 1);
+}
+
+TextureResidency::TextureResidency(const std::size_t maxResidentCount, const UnsignedInt evictionFrameCount): _state{Containers::InPlaceInit, maxResidentCount, evictionFrameCount} {
+    CORRADE_ASSERT(evictionFrameCount,
+        "GL::TextureResidency: eviction frame count can't be zero", );
+}
+
+TextureResidency::TextureResidency(TextureResidency&&) noexcept = default;
+
+TextureResidency::~TextureResidency() {
+    /* Moved out, nothing to do */
+    if(!_state) return;
+
+    for(State::Entry& entry: _state->entries)
+        entry.texture->makeNonResident();
+}
+
+TextureResidency& TextureResidency::operator=(TextureResidency&&) noexcept = default;
+
+std::size_t TextureResidency::maxResidentCount() const {
+    return _state->maxResidentCount;
+}
+
+UnsignedInt TextureResidency::evictionFrameCount() const {
+    return _state->evictionFrameCount;
+}
+
+UnsignedLong TextureResidency::frame() const {
+    return _state->frame;
+}
+
+std::size_t TextureResidency::residentCount() const {
+    return _state->entries.size();
+}
+
+std::size_t TextureResidency::evictedCount() const {
+    return _state->evictedCount;
+}
+
+UnsignedLong TextureResidency::use(AbstractTexture& texture) {
+    State& state = *_state;
+
+    /* Already tracked, just mark as used */
+    const auto found = state.indices.find(&texture);
+    if(found != state.indices.end()) {
+        state.entries[found->second].lastUsedFrame = state.frame;
+        return texture.handle();
+    }
+
+    /* Over budget, evict the least recently used texture. Textures used in
+       this frame can't be evicted, so if there's none the budget gets
+       exceeded. */
+    if(state.maxResidentCount && state.entries.size() >= state.maxResidentCount) {
+        std::size_t oldest = ~std::size_t{};
+        for(std::size_t i = 0; i != state.entries.size(); ++i) {
+            if(state.entries[i].lastUsedFrame == state.frame) continue;
+            if(oldest == ~std::size_t{} || state.entries[i].lastUsedFrame < state.entries[oldest].lastUsedFrame)
+                oldest = i;
+        }
+        if(oldest != ~std::size_t{}) {
+            state.evict(oldest);
+            ++state.evictedCount;
+        }
+    }
+
+    texture.makeResident();
+    state.indices.emplace(&texture, state.entries.size());
+    arrayAppend(state.entries, State::Entry{&texture, state.frame});
+    return texture.handle();
+}
+
+bool TextureResidency::contains(const AbstractTexture& texture) const {
+    return _state->indices.find(&texture) != _state->indices.end();
+}
+
+void TextureResidency::remove(AbstractTexture& texture) {
+    const auto found = _state->indices.find(&texture);
+    if(found == _state->indices.end()) return;
+
+    _state->evict(found->second);
+}
+
+void TextureResidency::nextFrame() {
+    State& state = *_state;
+
+    /* Going backwards so the swap-remove doesn't skip any entries */
+    for(std::size_t i = state.entries.size(); i != 0; --i) {
+        if(state.frame - state.entries[i - 1].lastUsedFrame < state.evictionFrameCount)
+            continue;
+        state.evict(i - 1);
+        ++state.evictedCount;
+    }
+
+    ++state.frame;
+}
+
+}}
@@ -0,0 +1,178 @@
+#ifndef Magnum_GL_TextureResidency_h
+#define Magnum_GL_TextureResidency_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::TextureResidency
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include <cstddef>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Bindless texture residency tracker
+@m_since_latest
+
+Implementations limit how many bindless texture handles can be resident at the
+same time and residency changes aren't free either, so making all textures in
+a large scene resident upfront isn't generally possible. This class makes
+textures resident lazily as they get used and makes them non-resident again
+once they weren't used for a given count of frames or when the count of
+resident textures exceeds a budget, evicting the least recently used ones
+first.
+
+Call @ref use() for every texture a draw references, which returns the
+@ref AbstractTexture::handle() to put into a buffer for the shader, and
+@ref nextFrame() once at the end of every frame:
+
+@snippet MagnumGL.cpp TextureResidency-usage
+
+Textures used in the current frame are never evicted, as the GPU may still
+need them, so the resident count can temporarily exceed the budget if a single
+frame uses more textures than that. The instance references the textures it
+tracks, so a tracked texture has to be either removed with @ref remove() or
+outlive the tracker.
+
+@requires_extension Extension @gl_extension{ARB,bindless_texture}
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+*/
+class MAGNUM_GL_EXPORT TextureResidency {
+    public:
+        /**
+         * @brief Constructor
+         * @param maxResidentCount  Max count of resident textures. If
+         *      @cpp 0 @ce, the count is not limited.
+         * @param evictionFrameCount Count of frames after which an unused
+         *      texture is made non-resident. Expected to be non-zero.
+         */
+        explicit TextureResidency(std::size_t maxResidentCount = 0, UnsignedInt evictionFrameCount = 60);
+
+        /** @brief Copying is not allowed */
+        TextureResidency(const TextureResidency&) = delete;
+
+        /** @brief Move constructor */
+        TextureResidency(TextureResidency&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Makes all tracked textures non-resident.
+         */
+        ~TextureResidency();
+
+        /** @brief Copying is not allowed */
+        TextureResidency& operator=(const TextureResidency&) = delete;
+
+        /** @brief Move assignment */
+        TextureResidency& operator=(TextureResidency&&) noexcept;
+
+        /** @brief Max count of resident textures */
+        std::size_t maxResidentCount() const;
+
+        /** @brief Count of frames after which an unused texture is evicted */
+        UnsignedInt evictionFrameCount() const;
+
+        /**
+         * @brief Current frame
+         *
+         * Starts at @cpp 0 @ce and is incremented by each @ref nextFrame()
+         * call.
+         */
+        UnsignedLong frame() const;
+
+        /** @brief Count of tracked resident textures */
+        std::size_t residentCount() const;
+
+        /**
+         * @brief Count of evicted textures
+         *
+         * Total count of textures made non-resident by @ref use() or
+         * @ref nextFrame(), not including @ref remove(). Useful for tuning
+         * the budget --- a high count means the textures are thrashing.
+         */
+        std::size_t evictedCount() const;
+
+        /**
+         * @brief Use a texture in the current frame
+         *
+         * If the texture isn't tracked yet, makes it resident and if that
+         * exceeds @ref maxResidentCount(), makes the least recently used
+         * texture that wasn't used in the current frame non-resident. Marks
+         * the texture as used in the current frame and returns its handle.
+         * The eviction is linear in the count of resident textures, a lookup
+         * of an already tracked texture is constant-time.
+         * @see @ref AbstractTexture::handle(),
+         *      @ref AbstractTexture::makeResident(),
+         *      @ref AbstractTexture::makeNonResident()
+         */
+        UnsignedLong use(AbstractTexture& texture);
+
+        /**
+         * @brief Whether a texture is tracked
+         *
+         * Tracked textures are resident.
+         */
+        bool contains(const AbstractTexture& texture) const;
+
+        /**
+         * @brief Stop tracking a texture
+         *
+         * Makes the texture non-resident. Has to be called before a tracked
+         * texture is destroyed. If the texture isn't tracked, the function
+         * does nothing.
+         */
+        void remove(AbstractTexture& texture);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Makes all textures that weren't used in the last
+         * @ref evictionFrameCount() frames non-resident and increments
+         * @ref frame().
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TextureStreamer.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferImage.h"
+#include "Magnum/GL/Fence.h"
+#include "Magnum/GL/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+
+namespace Magnum { namespace GL {
+
+namespace {
+    /* Just so Implementation::imageDataSizeFor() can be used before the
+       buffer gets moved into a BufferImage */
+    struct ImageProperties {
+        PixelStorage storage() const { return _storage; }
+        UnsignedInt pixelSize() const { return _pixelSize; }
+
+        PixelStorage _storage;
+        UnsignedInt _pixelSize;
+    };
+}
+
+template<UnsignedInt dimensions> struct TextureStreamer<dimensions>::State {
+    enum class SlotState: UnsignedByte {
+        Free,
+        Acquired,
+        InFlight
+    };
+
+    struct Slot {
+        Buffer buffer{NoCreate};
+        Fence fence{NoCreate};
+        SlotState state{};
+    };
+
+    explicit State(std::size_t bufferSize, UnsignedInt bufferCount): bufferSize{bufferSize}, slots{bufferCount} {}
+
+    /* Gives buffers of finished uploads back to the pool. The zero-timeout
+       wait doesn't block but flushes the commands, so the fence is guaranteed
+       to get signaled eventually. */
+    void reclaim();
+
+    std::size_t bufferSize;
+    Containers::Array<Slot> slots;
+};
+
+template<UnsignedInt dimensions> void TextureStreamer<dimensions>::State::reclaim() {
+    for(Slot& slot: slots) {
+        if(slot.state != SlotState::InFlight || slot.fence.clientWait(0) == Fence::WaitResult::TimeoutExpired)
+            continue;
+
+        slot.fence = Fence{NoCreate};
+        slot.state = SlotState::Free;
+    }
+}
+
+template<UnsignedInt dimensions> TextureStreamer<dimensions>::TextureStreamer(const std::size_t bufferSize, const UnsignedInt bufferCount): _state{Containers::InPlaceInit, bufferSize, bufferCount} {
+    CORRADE_ASSERT(bufferSize && bufferCount,
+        "GL::TextureStreamer: expected non-zero buffer size and count, got" << bufferSize << "and" << bufferCount, );
+
+    for(typename State::Slot& slot: _state->slots) {
+        slot.buffer = Buffer{Buffer::TargetHint::PixelUnpack};
+        slot.buffer.setData({nullptr, bufferSize}, BufferUsage::StreamDraw);
+    }
+}
+
+template<UnsignedInt dimensions> TextureStreamer<dimensions>::TextureStreamer(NoCreateT) noexcept {}
+
+template<UnsignedInt dimensions> TextureStreamer<dimensions>::TextureStreamer(TextureStreamer<dimensions>&&) noexcept = default;
+
+/* The buffers get implicitly unmapped on deletion, the fences are deleted by
+   the array destructor */
+template<UnsignedInt dimensions> TextureStreamer<dimensions>::~TextureStreamer() = default;
+
+template<UnsignedInt dimensions> TextureStreamer<dimensions>& TextureStreamer<dimensions>::operator=(TextureStreamer<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> std::size_t TextureStreamer<dimensions>::bufferSize() const { return _state->bufferSize; }
+
+template<UnsignedInt dimensions> UnsignedInt TextureStreamer<dimensions>::bufferCount() const { return _state->slots.size(); }
+
+template<UnsignedInt dimensions> UnsignedInt TextureStreamer<dimensions>::availableCount() {
+    State& state = *_state;
+    state.reclaim();
+
+    UnsignedInt count = 0;
+    for(const typename State::Slot& slot: state.slots)
+        if(slot.state == State::SlotState::Free) ++count;
+    return count;
+}
+
+template<UnsignedInt dimensions> auto TextureStreamer<dimensions>::acquire(const std::size_t size) -> Containers::Optional<Staging> {
+    State& state = *_state;
+    CORRADE_ASSERT(size <= state.bufferSize,
+        "GL::TextureStreamer::acquire(): requested" << size << "bytes but the buffers have only" << state.bufferSize, {});
+
+    state.reclaim();
+
+    for(std::size_t i = 0; i != state.slots.size(); ++i) {
+        typename State::Slot& slot = state.slots[i];
+        if(slot.state != State::SlotState::Free) continue;
+
+        /* Invalidating so the driver doesn't need to preserve the previous
+           contents, size of zero would fail the mapping */
+        Containers::ArrayView<char> data = slot.buffer.map(0, Math::max(size, std::size_t{1}),
+            Buffer::MapFlag::Write|
+            Buffer::MapFlag::InvalidateBuffer);
+        if(!data) return {};
+
+        slot.state = State::SlotState::Acquired;
+        return Staging{UnsignedInt(i), data.prefix(size)};
+    }
+
+    return {};
+}
+
+template<UnsignedInt dimensions> void TextureStreamer<dimensions>::upload(const Staging& staging, Texture<dimensions>& texture, const Int level, const VectorTypeFor<dimensions, Int>& offset, const PixelStorage storage, const PixelFormat format, const PixelType type, const VectorTypeFor<dimensions, Int>& size) {
+    State& state = *_state;
+    CORRADE_ASSERT(staging.id < state.slots.size() && state.slots[staging.id].state == State::SlotState::Acquired,
+        "GL::TextureStreamer::upload(): buffer" << staging.id << "is not acquired", );
+    CORRADE_ASSERT(Magnum::Implementation::imageDataSizeFor(ImageProperties{storage, pixelSize(format, type)}, size) <= staging.data.size(),
+        "GL::TextureStreamer::upload(): expected at least" << Magnum::Implementation::imageDataSizeFor(ImageProperties{storage, pixelSize(format, type)}, size) << "bytes but got" << staging.data.size(), );
+
+    typename State::Slot& slot = state.slots[staging.id];
+    slot.buffer.unmap();
+
+    /* Temporarily moving the buffer into an image to reuse the pixel storage
+       and format handling of the buffer image upload */
+    BufferImage<dimensions> image{storage, format, type, size, std::move(slot.buffer), staging.data.size()};
+    texture.setSubImage(level, offset, image);
+    slot.buffer = image.release();
+
+    slot.fence = Fence{};
+    slot.state = State::SlotState::InFlight;
+}
+
+template<UnsignedInt dimensions> void TextureStreamer<dimensions>::upload(const Staging& staging, Texture<dimensions>& texture, const Int level, const VectorTypeFor<dimensions, Int>& offset, const PixelStorage storage, const Magnum::PixelFormat format, const VectorTypeFor<dimensions, Int>& size) {
+    upload(staging, texture, level, offset, storage, pixelFormat(format), pixelType(format), size);
+}
+
+template<UnsignedInt dimensions> void TextureStreamer<dimensions>::discard(const Staging& staging) {
+    State& state = *_state;
+    CORRADE_ASSERT(staging.id < state.slots.size() && state.slots[staging.id].state == State::SlotState::Acquired,
+        "GL::TextureStreamer::discard(): buffer" << staging.id << "is not acquired", );
+
+    typename State::Slot& slot = state.slots[staging.id];
+    slot.buffer.unmap();
+    slot.state = State::SlotState::Free;
+}
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+template class MAGNUM_GL_EXPORT TextureStreamer<1>;
+template class MAGNUM_GL_EXPORT TextureStreamer<2>;
+template class MAGNUM_GL_EXPORT TextureStreamer<3>;
+#endif
+
+}}
@@ -0,0 +1,243 @@
+#ifndef Magnum_GL_TextureStreamer_h
+#define Magnum_GL_TextureStreamer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::GL::TextureStreamer, typedef @ref Magnum::GL::TextureStreamer1D, @ref Magnum::GL::TextureStreamer2D, @ref Magnum::GL::TextureStreamer3D
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/visibility.h"
+
+namespace Magnum { namespace GL {
+
+/**
+@brief Texture streamer
+@m_since_latest
+
+Manages a fixed pool of pixel buffers for uploading texture data without
+stalling the GL thread. A pixel buffer is mapped for writing on the GL thread
+with @ref acquire(), the returned memory can be then filled from any thread
+--- for example by a worker decoding an image --- and once that's done, the GL
+thread issues the upload with @ref upload(). The upload itself is
+asynchronous, the driver copies the data from the pixel buffer to the texture
+without the CPU waiting for it. Each upload is guarded by a @ref Fence and the
+buffer is given back to the pool once the fence is signaled, which is polled
+without blocking in @ref acquire() and @ref availableCount():
+
+@snippet MagnumGL.cpp TextureStreamer-usage
+
+If all buffers are in use, @ref acquire() returns
+@relativeref{Corrade,Containers::NullOpt} and the caller is expected to try
+again later, for example in the next frame.
+
+The upload goes through a @ref BufferImage wrapping the pixel buffer, so the
+same restrictions as with @ref Texture::setSubImage(Int, const VectorTypeFor<dimensions, Int>&, BufferImage<dimensions>&)
+apply. Each acquired buffer has to be either uploaded or given back with
+@ref discard().
+
+@requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+template<UnsignedInt dimensions> class MAGNUM_GL_EXPORT TextureStreamer {
+    public:
+        /**
+         * @brief Staging memory
+         *
+         * @see @ref acquire()
+         */
+        struct Staging {
+            /** @brief Pixel buffer index */
+            UnsignedInt id;
+
+            /**
+             * @brief Mapped pixel buffer memory
+             *
+             * Can be written to from any thread until the staging memory is
+             * passed to @ref upload() or @ref discard().
+             */
+            Containers::ArrayView<char> data;
+        };
+
+        /**
+         * @brief Constructor
+         * @param bufferSize    Size of each pixel buffer in bytes
+         * @param bufferCount   Count of pixel buffers in the pool
+         *
+         * Expects that both @p bufferSize and @p bufferCount are non-zero.
+         */
+        explicit TextureStreamer(std::size_t bufferSize, UnsignedInt bufferCount = 3);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit TextureStreamer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        TextureStreamer(const TextureStreamer<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        TextureStreamer(TextureStreamer<dimensions>&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all pixel buffers and pending fences. All acquired staging
+         * memory becomes invalid.
+         */
+        ~TextureStreamer();
+
+        /** @brief Copying is not allowed */
+        TextureStreamer<dimensions>& operator=(const TextureStreamer<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        TextureStreamer<dimensions>& operator=(TextureStreamer<dimensions>&&) noexcept;
+
+        /** @brief Size of each pixel buffer in bytes */
+        std::size_t bufferSize() const;
+
+        /** @brief Count of pixel buffers in the pool */
+        UnsignedInt bufferCount() const;
+
+        /**
+         * @brief Count of pixel buffers available for @ref acquire()
+         *
+         * Polls fences of pending uploads without blocking and gives buffers
+         * of finished uploads back to the pool.
+         * @see @ref Fence::clientWait()
+         */
+        UnsignedInt availableCount();
+
+        /**
+         * @brief Acquire staging memory
+         * @param size      Size in bytes
+         *
+         * Polls fences of pending uploads without blocking and maps a free
+         * pixel buffer for writing. Returns
+         * @relativeref{Corrade,Containers::NullOpt} if all buffers are
+         * acquired or still in use by the GPU. Expects that @p size is not
+         * larger than @ref bufferSize(). Has to be called from the thread
+         * owning the GL context.
+         * @see @ref Buffer::map(GLintptr, GLsizeiptr, Buffer::MapFlags)
+         */
+        Containers::Optional<Staging> acquire(std::size_t size);
+
+        /**
+         * @brief Upload staging memory to a texture
+         * @param staging   Staging memory returned from @ref acquire()
+         * @param texture   Texture to upload to
+         * @param level     Mip level
+         * @param offset    Offset where to put the data in the texture
+         * @param storage   Pixel storage of the staged data
+         * @param format    Format of the staged data
+         * @param type      Data type of the staged data
+         * @param size      Size of the staged image
+         *
+         * Unmaps the pixel buffer, issues the upload with
+         * @ref Texture::setSubImage(Int, const VectorTypeFor<dimensions, Int>&, BufferImage<dimensions>&)
+         * and inserts a @ref Fence guarding the buffer. Expects that
+         * @p staging is acquired and that its size is large enough for the
+         * image. Has to be called from the thread owning the GL context and
+         * only after all writes to the staging memory finished.
+         */
+        void upload(const Staging& staging, Texture<dimensions>& texture, Int level, const VectorTypeFor<dimensions, Int>& offset, PixelStorage storage, PixelFormat format, PixelType type, const VectorTypeFor<dimensions, Int>& size);
+
+        /**
+         * @brief Upload staging memory to a texture with default pixel storage
+         *
+         * Equivalent to calling @ref upload(const Staging&, Texture<dimensions>&, Int, const VectorTypeFor<dimensions, Int>&, PixelStorage, PixelFormat, PixelType, const VectorTypeFor<dimensions, Int>&)
+         * with default-constructed @ref PixelStorage.
+         */
+        void upload(const Staging& staging, Texture<dimensions>& texture, Int level, const VectorTypeFor<dimensions, Int>& offset, PixelFormat format, PixelType type, const VectorTypeFor<dimensions, Int>& size) {
+            upload(staging, texture, level, offset, {}, format, type, size);
+        }
+
+        /**
+         * @brief Upload staging memory to a texture with a generic pixel format
+         *
+         * Converts @p format using @ref pixelFormat(Magnum::PixelFormat) and
+         * @ref pixelType(Magnum::PixelFormat, UnsignedInt) and calls
+         * @ref upload(const Staging&, Texture<dimensions>&, Int, const VectorTypeFor<dimensions, Int>&, PixelStorage, PixelFormat, PixelType, const VectorTypeFor<dimensions, Int>&).
+         */
+        void upload(const Staging& staging, Texture<dimensions>& texture, Int level, const VectorTypeFor<dimensions, Int>& offset, PixelStorage storage, Magnum::PixelFormat format, const VectorTypeFor<dimensions, Int>& size);
+
+        /**
+         * @brief Upload staging memory to a texture with a generic pixel format and default pixel storage
+         *
+         * Equivalent to calling @ref upload(const Staging&, Texture<dimensions>&, Int, const VectorTypeFor<dimensions, Int>&, PixelStorage, Magnum::PixelFormat, const VectorTypeFor<dimensions, Int>&)
+         * with default-constructed @ref PixelStorage.
+         */
+        void upload(const Staging& staging, Texture<dimensions>& texture, Int level, const VectorTypeFor<dimensions, Int>& offset, Magnum::PixelFormat format, const VectorTypeFor<dimensions, Int>& size) {
+            upload(staging, texture, level, offset, {}, format, size);
+        }
+
+        /**
+         * @brief Give staging memory back without uploading
+         *
+         * Unmaps the pixel buffer and makes it immediately available for
+         * @ref acquire() again. Expects that @p staging is acquired.
+         */
+        void discard(const Staging& staging);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+#ifndef MAGNUM_TARGET_GLES
+/** @brief One-dimensional texture streamer */
+typedef TextureStreamer<1> TextureStreamer1D;
+#endif
+
+/** @brief Two-dimensional texture streamer */
+typedef TextureStreamer<2> TextureStreamer2D;
+
+/** @brief Three-dimensional texture streamer */
+typedef TextureStreamer<3> TextureStreamer3D;
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 and WebGL build
+#endif
+
+#endif
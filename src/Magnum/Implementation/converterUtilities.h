@@ -25,6 +25,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <chrono>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/PluginManager/AbstractPlugin.h>
 #include <Corrade/Utility/ConfigurationGroup.h>
@@ -38,6 +39,19 @@ namespace Magnum { namespace Implementation {
 /* Used only in executables where we don't want it to be exported */
 namespace {
 
+/* Adds time elapsed until destruction to given output */
+struct Duration {
+    explicit Duration(std::chrono::high_resolution_clock::duration& output): _output(output), _t{std::chrono::high_resolution_clock::now()} {}
+
+    ~Duration() {
+        _output += std::chrono::high_resolution_clock::now() - _t;
+    }
+
+    private:
+        std::chrono::high_resolution_clock::duration& _output;
+        std::chrono::high_resolution_clock::time_point _t;
+};
+
 void setOptions(PluginManager::AbstractPlugin& plugin, const std::string& options) {
     for(const std::string& option: Utility::String::splitWithoutEmptyParts(options, ',')) {
         auto keyValue = Utility::String::partition(option, '=');
@@ -0,0 +1,75 @@
+#ifndef Magnum_Implementation_threads_h
+#define Magnum_Implementation_threads_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace Implementation {
+
+/* With less items per thread than this the threading overhead outweighs any
+   gains, so fewer threads are used */
+constexpr std::size_t MinItemsPerThread = 1024;
+
+/* Zero thread count means hardware concurrency */
+inline UnsignedInt resolveThreadCount(const UnsignedInt threadCount) {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    /* No threads available, everything is done on the calling thread */
+    static_cast<void>(threadCount);
+    return 1;
+    #else
+    if(threadCount) return threadCount;
+    return Math::max(std::thread::hardware_concurrency(), 1u);
+    #endif
+}
+
+inline UnsignedInt clampThreadCount(const UnsignedInt threadCount, const std::size_t itemCount) {
+    return Math::max(UnsignedInt(Math::min(std::size_t(threadCount), itemCount/MinItemsPerThread)), 1u);
+}
+
+/* Range of items processed by given thread */
+inline std::pair<std::size_t, std::size_t> threadRange(const std::size_t itemCount, const UnsignedInt threadCount, const UnsignedInt thread) {
+    return {itemCount*thread/threadCount, itemCount*(thread + 1)/threadCount};
+}
+
+/* Calls f(0) to f(threadCount - 1), each on a separate thread. The f(0) is
+   executed on the calling thread, so there's no thread spawned if
+   threadCount is 1. */
+template<class F> void runOnThreads(const UnsignedInt threadCount, const F& f) {
+    Containers::Array<std::thread> threads{Containers::ValueInit, threadCount - 1};
+    for(UnsignedInt i = 0; i != threads.size(); ++i)
+        threads[i] = std::thread{[&f](const UnsignedInt thread) { f(thread); }, i + 1};
+    f(0);
+    for(std::thread& thread: threads) thread.join();
+}
+
+}}
+
+#endif
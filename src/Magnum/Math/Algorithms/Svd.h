@@ -78,7 +78,8 @@ and scaling parts. Note, however, that the decomposition is not unique. See the
 [associated test case](https://github.com/mosra/magnum/blob/master/src/Magnum/Math/Algorithms/Test/SvdTest.cpp)
 for an example. Implementation based on *Golub, G. H.; Reinsch, C. (1970).
 "Singular value decomposition and least squares solutions"*.
-@see @ref qr(), @ref Matrix3::rotationShear(), @ref Matrix4::rotationShear()
+@see @ref qr(), @ref svd3x3(), @ref Matrix3::rotationShear(),
+    @ref Matrix4::rotationShear()
 */
 /* The matrix is passed by value because it is changed inside */
 template<std::size_t cols, std::size_t rows, class T> std::tuple<RectangularMatrix<cols, rows, T>, Vector<cols, T>, Matrix<cols, T>> svd(RectangularMatrix<cols, rows, T> m) {
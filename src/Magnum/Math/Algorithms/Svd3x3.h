@@ -0,0 +1,469 @@
+#ifndef Magnum_Math_Algorithms_Svd3x3_h
+#define Magnum_Math_Algorithms_Svd3x3_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Algorithms::svd3x3(), @ref Magnum::Math::Algorithms::svd3x3Into(), @ref Magnum::Math::Algorithms::polarDecomposition(), @ref Magnum::Math::Algorithms::polarDecompositionInto()
+ * @m_since_latest
+ */
+
+#include <cmath>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix.h"
+#include "Magnum/Math/Vector3.h"
+
+namespace Magnum { namespace Math { namespace Algorithms {
+
+namespace Implementation {
+
+/* A fixed-size pack of values the 3x3 SVD kernel operates on in lockstep.
+   All operations are trivial loops over the lanes with no branches, which
+   the compiler turns into SIMD instructions. The lane count is picked so one
+   pack fits into a 256-bit register. */
+template<class T, std::size_t size> struct Svd3x3Lanes {
+    Svd3x3Lanes() = default;
+    explicit Svd3x3Lanes(T value) {
+        for(std::size_t i = 0; i != size; ++i) data[i] = value;
+    }
+
+    T data[size];
+};
+
+/* The mask is stored in the same type as the values, which makes it easier
+   for the compiler to turn the selects into blend instructions */
+template<class T, std::size_t size> struct Svd3x3Mask {
+    T data[size];
+};
+
+template<class T> constexpr std::size_t svd3x3LaneCount() { return 32/sizeof(T); }
+
+#define _c(op)                                                              \
+    template<class T, std::size_t size> inline Svd3x3Lanes<T, size> operator op(const Svd3x3Lanes<T, size>& a, const Svd3x3Lanes<T, size>& b) { \
+        Svd3x3Lanes<T, size> out;                                           \
+        for(std::size_t i = 0; i != size; ++i)                              \
+            out.data[i] = a.data[i] op b.data[i];                           \
+        return out;                                                         \
+    }                                                                       \
+    template<class T, std::size_t size> inline Svd3x3Lanes<T, size> operator op(const Svd3x3Lanes<T, size>& a, T b) { \
+        Svd3x3Lanes<T, size> out;                                           \
+        for(std::size_t i = 0; i != size; ++i)                              \
+            out.data[i] = a.data[i] op b;                                   \
+        return out;                                                         \
+    }                                                                       \
+    template<class T, std::size_t size> inline Svd3x3Lanes<T, size> operator op(T a, const Svd3x3Lanes<T, size>& b) { \
+        Svd3x3Lanes<T, size> out;                                           \
+        for(std::size_t i = 0; i != size; ++i)                              \
+            out.data[i] = a op b.data[i];                                   \
+        return out;                                                         \
+    }
+_c(+)
+_c(-)
+_c(*)
+_c(/)
+#undef _c
+
+template<class T, std::size_t size> inline Svd3x3Lanes<T, size> operator-(const Svd3x3Lanes<T, size>& a) {
+    Svd3x3Lanes<T, size> out;
+    for(std::size_t i = 0; i != size; ++i) out.data[i] = -a.data[i];
+    return out;
+}
+
+template<class T> inline T svd3x3Sqrt(T a) { return std::sqrt(a); }
+template<class T, std::size_t size> inline Svd3x3Lanes<T, size> svd3x3Sqrt(const Svd3x3Lanes<T, size>& a) {
+    Svd3x3Lanes<T, size> out;
+    for(std::size_t i = 0; i != size; ++i) out.data[i] = std::sqrt(a.data[i]);
+    return out;
+}
+
+template<class T> inline T svd3x3Abs(T a) { return std::abs(a); }
+template<class T, std::size_t size> inline Svd3x3Lanes<T, size> svd3x3Abs(const Svd3x3Lanes<T, size>& a) {
+    Svd3x3Lanes<T, size> out;
+    for(std::size_t i = 0; i != size; ++i) out.data[i] = std::abs(a.data[i]);
+    return out;
+}
+
+template<class T> inline bool svd3x3Less(T a, T b) { return a < b; }
+template<class T, std::size_t size> inline Svd3x3Mask<T, size> svd3x3Less(const Svd3x3Lanes<T, size>& a, const Svd3x3Lanes<T, size>& b) {
+    Svd3x3Mask<T, size> out;
+    for(std::size_t i = 0; i != size; ++i) out.data[i] = a.data[i] < b.data[i] ? T(1) : T(0);
+    return out;
+}
+
+template<class T> inline T svd3x3Select(bool mask, T a, T b) { return mask ? a : b; }
+template<class T, std::size_t size> inline Svd3x3Lanes<T, size> svd3x3Select(const Svd3x3Mask<T, size>& mask, const Svd3x3Lanes<T, size>& a, const Svd3x3Lanes<T, size>& b) {
+    Svd3x3Lanes<T, size> out;
+    for(std::size_t i = 0; i != size; ++i) out.data[i] = mask.data[i] != T(0) ? a.data[i] : b.data[i];
+    return out;
+}
+
+/* One Jacobi rotation annihilating the (p, q) element of the symmetric
+   matrix S, with r being the remaining index. The rotation is accumulated
+   into columns p and q of V. */
+template<class T, class V> inline void svd3x3Rotate(V& spp, V& sqq, V& spq, V& spr, V& sqr, V(&v)[3][3], const std::size_t p, const std::size_t q) {
+    const V d = sqq - spp;
+    const V sign = svd3x3Select(svd3x3Less(d, V(T(0))), V(T(-1)), V(T(1)));
+    /* Smaller root of t^2 + 2t(d/(2 spq)) - 1 = 0, rewritten to avoid a
+       division by zero for an already diagonal S */
+    const V tRotate = T(2)*spq*sign/(svd3x3Abs(d) + svd3x3Sqrt(d*d + T(4)*spq*spq) + std::numeric_limits<T>::min());
+    /* Skip the rotation if the off-diagonal element is already negligible.
+       Otherwise the off-diagonal elements would continue converging towards
+       zero in the remaining sweeps and reach the denormal range, which is
+       extremely slow on most CPUs. */
+    const V t = svd3x3Select(svd3x3Less(svd3x3Abs(spq), std::numeric_limits<T>::epsilon()*(spp + sqq)), V(T(0)), tRotate);
+    const V c = T(1)/svd3x3Sqrt(T(1) + t*t);
+    const V s = t*c;
+
+    spp = spp - t*spq;
+    sqq = sqq + t*spq;
+    spq = V(T(0));
+    const V spr1 = c*spr - s*sqr;
+    sqr = s*spr + c*sqr;
+    spr = spr1;
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const V vp = v[p][i];
+        const V vq = v[q][i];
+        v[p][i] = c*vp - s*vq;
+        v[q][i] = s*vp + c*vq;
+    }
+}
+
+/* Swaps eigenvalues p and q if they're not in a descending order, together
+   with the corresponding columns of V. One of the columns gets negated to
+   keep V a proper rotation. */
+template<class T, class V> inline void svd3x3Sort(V& lp, V& lq, V(&v)[3][3], const std::size_t p, const std::size_t q) {
+    const auto swap = svd3x3Less(lp, lq);
+    const V l = lp;
+    lp = svd3x3Select(swap, lq, lp);
+    lq = svd3x3Select(swap, l, lq);
+
+    for(std::size_t i = 0; i != 3; ++i) {
+        const V vp = v[p][i];
+        const V vq = v[q][i];
+        v[p][i] = svd3x3Select(swap, vq, vp);
+        v[q][i] = svd3x3Select(swap, -vp, vq);
+    }
+}
+
+/* Matrices are column-major, the same as Math::Matrix */
+template<class T, class V> void svd3x3(const V(&a)[3][3], V(&u)[3][3], V(&w)[3], V(&v)[3][3]) {
+    /* Eigendecomposition of the symmetric S = A^T A using a fixed number of
+       cyclic Jacobi sweeps. Four sweeps are enough to reach full precision
+       for both floats and doubles, as the convergence is quadratic. */
+    V s[3][3];
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = i; j != 3; ++j)
+            s[i][j] = a[i][0]*a[j][0] + a[i][1]*a[j][1] + a[i][2]*a[j][2];
+
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            v[i][j] = V(T(i == j ? 1 : 0));
+
+    /* Squared Frobenius norm of A, used for a scale-independent degeneracy
+       check below */
+    const V frobenius = s[0][0] + s[1][1] + s[2][2];
+
+    for(std::size_t sweep = 0; sweep != 4; ++sweep) {
+        svd3x3Rotate<T>(s[0][0], s[1][1], s[0][1], s[0][2], s[1][2], v, 0, 1);
+        svd3x3Rotate<T>(s[0][0], s[2][2], s[0][2], s[0][1], s[1][2], v, 0, 2);
+        svd3x3Rotate<T>(s[1][1], s[2][2], s[1][2], s[0][1], s[0][2], v, 1, 2);
+    }
+
+    svd3x3Sort<T>(s[0][0], s[1][1], v, 0, 1);
+    svd3x3Sort<T>(s[0][0], s[2][2], v, 0, 2);
+    svd3x3Sort<T>(s[1][1], s[2][2], v, 1, 2);
+
+    /* B = AV has orthogonal columns with lengths equal to the singular values.
+       Orthonormalizing them via Gram-Schmidt gives U, calculating the third
+       column as a cross product makes it a proper rotation. The last singular
+       value is thus signed, negative if A contains a reflection. */
+    V b[3][3];
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            b[i][j] = a[0][j]*v[i][0] + a[1][j]*v[i][1] + a[2][j]*v[i][2];
+
+    const V threshold = frobenius*(TypeTraits<T>::epsilon()*TypeTraits<T>::epsilon()) + std::numeric_limits<T>::min();
+    const V zero{T(0)};
+    const V one{T(1)};
+
+    /* If the first column is zero, the whole matrix is, pick an arbitrary
+       direction */
+    const V b0lengthSquared = b[0][0]*b[0][0] + b[0][1]*b[0][1] + b[0][2]*b[0][2];
+    const auto b0zero = svd3x3Less(b0lengthSquared, threshold);
+    const V b0lengthInverted = one/svd3x3Sqrt(svd3x3Select(b0zero, one, b0lengthSquared));
+    u[0][0] = svd3x3Select(b0zero, one, b[0][0]*b0lengthInverted);
+    u[0][1] = svd3x3Select(b0zero, zero, b[0][1]*b0lengthInverted);
+    u[0][2] = svd3x3Select(b0zero, zero, b[0][2]*b0lengthInverted);
+
+    /* If the second column is zero after removing the first direction, pick
+       an arbitrary direction perpendicular to the first */
+    const V d01 = u[0][0]*b[1][0] + u[0][1]*b[1][1] + u[0][2]*b[1][2];
+    const V u1[3]{
+        b[1][0] - d01*u[0][0],
+        b[1][1] - d01*u[0][1],
+        b[1][2] - d01*u[0][2]
+    };
+    const V u1lengthSquared = u1[0]*u1[0] + u1[1]*u1[1] + u1[2]*u1[2];
+    const auto u1zero = svd3x3Less(u1lengthSquared, threshold);
+    const V u1lengthInverted = one/svd3x3Sqrt(svd3x3Select(u1zero, one, u1lengthSquared));
+    /* Cross product with the X axis, or with the Y axis if the first
+       direction is too close to X */
+    const auto nearX = svd3x3Less(V(T(0.5)), svd3x3Abs(u[0][0]));
+    const V f[3]{
+        svd3x3Select(nearX, -u[0][2], zero),
+        svd3x3Select(nearX, zero, u[0][2]),
+        svd3x3Select(nearX, u[0][0], -u[0][1])
+    };
+    const V fLengthInverted = one/svd3x3Sqrt(f[0]*f[0] + f[1]*f[1] + f[2]*f[2]);
+    for(std::size_t i = 0; i != 3; ++i)
+        u[1][i] = svd3x3Select(u1zero, f[i]*fLengthInverted, u1[i]*u1lengthInverted);
+
+    u[2][0] = u[0][1]*u[1][2] - u[0][2]*u[1][1];
+    u[2][1] = u[0][2]*u[1][0] - u[0][0]*u[1][2];
+    u[2][2] = u[0][0]*u[1][1] - u[0][1]*u[1][0];
+
+    for(std::size_t i = 0; i != 3; ++i)
+        w[i] = u[i][0]*b[i][0] + u[i][1]*b[i][1] + u[i][2]*b[i][2];
+}
+
+template<class T, class V> void polarDecomposition(const V(&a)[3][3], V(&rotation)[3][3], V(&stretch)[3][3]) {
+    V u[3][3], w[3], v[3][3];
+    svd3x3<T>(a, u, w, v);
+
+    /* R = U V^T, P = V W V^T */
+    for(std::size_t i = 0; i != 3; ++i) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            rotation[i][j] = u[0][j]*v[0][i] + u[1][j]*v[1][i] + u[2][j]*v[2][i];
+            stretch[i][j] = v[0][j]*w[0]*v[0][i] + v[1][j]*w[1]*v[1][i] + v[2][j]*w[2]*v[2][i];
+        }
+    }
+}
+
+}
+
+/**
+@brief Singular value decomposition of a 3x3 matrix
+@m_since_latest
+
+Specialized variant of @ref svd() for 3x3 matrices, meant for physics, shape
+matching and mesh deformation code that needs to decompose large amounts of
+small matrices. Returns @f$ \boldsymbol{U} @f$, diagonal of
+@f$ \boldsymbol{\Sigma} @f$ and non-transposed @f$ \boldsymbol{V} @f$ such
+that @f[
+    \boldsymbol{M} = \boldsymbol{U} \boldsymbol{\Sigma} \boldsymbol{V}^T
+@f]
+
+Compared to @ref svd(), the result is more constrained, which makes it
+directly usable for extracting rotations:
+
+-   Singular values are sorted in descending order by their absolute value
+-   Both @f$ \boldsymbol{U} @f$ and @f$ \boldsymbol{V} @f$ are proper
+    rotations, i.e. with a determinant equal to @cpp 1 @ce. If
+    @f$ \boldsymbol{M} @f$ contains a reflection, it's expressed by the last
+    singular value being negative. The first two singular values are always
+    non-negative.
+-   Degenerate matrices are handled without special-casing --- missing
+    directions in @f$ \boldsymbol{U} @f$ are filled with arbitrary
+    orthonormal vectors.
+
+The implementation calculates an eigendecomposition of
+@f$ \boldsymbol{M}^T \boldsymbol{M} @f$ using a fixed number of cyclic Jacobi
+sweeps, followed by a Gram-Schmidt orthonormalization of
+@f$ \boldsymbol{M} \boldsymbol{V} @f$. There are no data-dependent branches
+or iteration counts, which is what allows the @ref svd3x3Into() variant to
+process several matrices at once in SIMD lanes. The precision is slightly
+lower than with @ref svd(), for @ref Magnum::Float "Float" matrices of a
+roughly unit scale the reconstruction error is in the order of
+@cpp 1.0e-5f @ce.
+@see @ref polarDecomposition()
+*/
+template<class T> std::tuple<Matrix3x3<T>, Vector3<T>, Matrix3x3<T>> svd3x3(const Matrix3x3<T>& m) {
+    T a[3][3], u[3][3], w[3], v[3][3];
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            a[i][j] = m[i][j];
+
+    Implementation::svd3x3<T>(a, u, w, v);
+
+    Matrix3x3<T> outU{Magnum::NoInit}, outV{Magnum::NoInit};
+    for(std::size_t i = 0; i != 3; ++i) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            outU[i][j] = u[i][j];
+            outV[i][j] = v[i][j];
+        }
+    }
+    return std::make_tuple(outU, Vector3<T>{w[0], w[1], w[2]}, outV);
+}
+
+/**
+@brief Singular value decomposition of a range of 3x3 matrices
+@param[in]  matrices    Source matrices
+@param[out] u           Where to put the @f$ \boldsymbol{U} @f$ matrices
+@param[out] w           Where to put diagonals of @f$ \boldsymbol{\Sigma} @f$
+@param[out] v           Where to put the non-transposed
+    @f$ \boldsymbol{V} @f$ matrices
+@m_since_latest
+
+Batch variant of @ref svd3x3(), giving the same results. Expects that all
+views have the same size. The matrices are transposed into a
+structure-of-arrays layout and processed in groups of eight
+@ref Magnum::Float "Float" or four @ref Magnum::Double "Double" matrices at a
+time, with the remainder processed one by one.
+*/
+template<class T> void svd3x3Into(const Corrade::Containers::StridedArrayView1D<const Matrix3x3<T>>& matrices, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& u, const Corrade::Containers::StridedArrayView1D<Vector3<T>>& w, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& v) {
+    CORRADE_ASSERT(u.size() == matrices.size(),
+        "Math::Algorithms::svd3x3Into(): wrong U destination size, got" << u.size() << "but expected" << matrices.size(), );
+    CORRADE_ASSERT(w.size() == matrices.size(),
+        "Math::Algorithms::svd3x3Into(): wrong W destination size, got" << w.size() << "but expected" << matrices.size(), );
+    CORRADE_ASSERT(v.size() == matrices.size(),
+        "Math::Algorithms::svd3x3Into(): wrong V destination size, got" << v.size() << "but expected" << matrices.size(), );
+
+    constexpr std::size_t LaneCount = Implementation::svd3x3LaneCount<T>();
+    typedef Implementation::Svd3x3Lanes<T, LaneCount> Lanes;
+
+    std::size_t i = 0;
+    for(; i + LaneCount <= matrices.size(); i += LaneCount) {
+        Lanes a[3][3], lu[3][3], lw[3], lv[3][3];
+        for(std::size_t l = 0; l != LaneCount; ++l) {
+            const Matrix3x3<T>& m = matrices[i + l];
+            for(std::size_t c = 0; c != 3; ++c)
+                for(std::size_t r = 0; r != 3; ++r)
+                    a[c][r].data[l] = m[c][r];
+        }
+
+        Implementation::svd3x3<T>(a, lu, lw, lv);
+
+        for(std::size_t l = 0; l != LaneCount; ++l) {
+            Matrix3x3<T>& mu = u[i + l];
+            Matrix3x3<T>& mv = v[i + l];
+            Vector3<T>& mw = w[i + l];
+            for(std::size_t c = 0; c != 3; ++c) {
+                for(std::size_t r = 0; r != 3; ++r) {
+                    mu[c][r] = lu[c][r].data[l];
+                    mv[c][r] = lv[c][r].data[l];
+                }
+                mw[c] = lw[c].data[l];
+            }
+        }
+    }
+
+    for(; i != matrices.size(); ++i)
+        std::tie(u[i], w[i], v[i]) = svd3x3(matrices[i]);
+}
+
+/**
+@brief Polar decomposition of a 3x3 matrix
+@m_since_latest
+
+Returns a rotation matrix @f$ \boldsymbol{R} @f$ and a symmetric stretch
+matrix @f$ \boldsymbol{P} @f$ such that @f[
+    \boldsymbol{M} = \boldsymbol{R} \boldsymbol{P}
+@f]
+
+Calculated from @ref svd3x3() as @f$ \boldsymbol{R} = \boldsymbol{U} \boldsymbol{V}^T @f$
+and @f$ \boldsymbol{P} = \boldsymbol{V} \boldsymbol{\Sigma} \boldsymbol{V}^T @f$.
+The rotation is always proper, i.e. with a determinant equal to @cpp 1 @ce.
+If @f$ \boldsymbol{M} @f$ contains a reflection, it ends up in
+@f$ \boldsymbol{P} @f$ which then has one negative eigenvalue, which is the
+commonly desired behavior for shape matching and deformation. For a
+non-degenerate @f$ \boldsymbol{M} @f$ without a reflection, the rotation is
+the closest rotation to @f$ \boldsymbol{M} @f$.
+@see @ref Matrix4::rotation(), @ref Matrix4::rotationShear()
+*/
+template<class T> std::pair<Matrix3x3<T>, Matrix3x3<T>> polarDecomposition(const Matrix3x3<T>& m) {
+    T a[3][3], rotation[3][3], stretch[3][3];
+    for(std::size_t i = 0; i != 3; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            a[i][j] = m[i][j];
+
+    Implementation::polarDecomposition<T>(a, rotation, stretch);
+
+    Matrix3x3<T> outRotation{Magnum::NoInit}, outStretch{Magnum::NoInit};
+    for(std::size_t i = 0; i != 3; ++i) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            outRotation[i][j] = rotation[i][j];
+            outStretch[i][j] = stretch[i][j];
+        }
+    }
+    return {outRotation, outStretch};
+}
+
+/**
+@brief Polar decomposition of a range of 3x3 matrices
+@param[in]  matrices    Source matrices
+@param[out] rotations   Where to put the rotation matrices
+@param[out] stretches   Where to put the stretch matrices
+@m_since_latest
+
+Batch variant of @ref polarDecomposition(), giving the same results. Expects
+that all views have the same size. See @ref svd3x3Into() for more information
+about how the matrices are processed.
+*/
+template<class T> void polarDecompositionInto(const Corrade::Containers::StridedArrayView1D<const Matrix3x3<T>>& matrices, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& rotations, const Corrade::Containers::StridedArrayView1D<Matrix3x3<T>>& stretches) {
+    CORRADE_ASSERT(rotations.size() == matrices.size(),
+        "Math::Algorithms::polarDecompositionInto(): wrong rotation destination size, got" << rotations.size() << "but expected" << matrices.size(), );
+    CORRADE_ASSERT(stretches.size() == matrices.size(),
+        "Math::Algorithms::polarDecompositionInto(): wrong stretch destination size, got" << stretches.size() << "but expected" << matrices.size(), );
+
+    constexpr std::size_t LaneCount = Implementation::svd3x3LaneCount<T>();
+    typedef Implementation::Svd3x3Lanes<T, LaneCount> Lanes;
+
+    std::size_t i = 0;
+    for(; i + LaneCount <= matrices.size(); i += LaneCount) {
+        Lanes a[3][3], rotation[3][3], stretch[3][3];
+        for(std::size_t l = 0; l != LaneCount; ++l) {
+            const Matrix3x3<T>& m = matrices[i + l];
+            for(std::size_t c = 0; c != 3; ++c)
+                for(std::size_t r = 0; r != 3; ++r)
+                    a[c][r].data[l] = m[c][r];
+        }
+
+        Implementation::polarDecomposition<T>(a, rotation, stretch);
+
+        for(std::size_t l = 0; l != LaneCount; ++l) {
+            Matrix3x3<T>& mr = rotations[i + l];
+            Matrix3x3<T>& ms = stretches[i + l];
+            for(std::size_t c = 0; c != 3; ++c) {
+                for(std::size_t r = 0; r != 3; ++r) {
+                    mr[c][r] = rotation[c][r].data[l];
+                    ms[c][r] = stretch[c][r].data[l];
+                }
+            }
+        }
+    }
+
+    for(; i != matrices.size(); ++i)
+        std::tie(rotations[i], stretches[i]) = polarDecomposition(matrices[i]);
+}
+
+}}}
+
+#endif
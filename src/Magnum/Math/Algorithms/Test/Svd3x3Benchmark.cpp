@@ -0,0 +1,149 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Svd.h"
+#include "Magnum/Math/Algorithms/Svd3x3.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test { namespace {
+
+struct Svd3x3Benchmark: Corrade::TestSuite::Tester {
+    explicit Svd3x3Benchmark();
+
+    template<class T> void svdGeneric();
+    template<class T> void svd3x3Loop();
+    template<class T> void svd3x3Batch();
+    template<class T> void polarDecompositionLoop();
+    template<class T> void polarDecompositionBatch();
+};
+
+Svd3x3Benchmark::Svd3x3Benchmark() {
+    addBenchmarks({&Svd3x3Benchmark::svdGeneric<Float>,
+                   &Svd3x3Benchmark::svdGeneric<Double>,
+                   &Svd3x3Benchmark::svd3x3Loop<Float>,
+                   &Svd3x3Benchmark::svd3x3Loop<Double>,
+                   &Svd3x3Benchmark::svd3x3Batch<Float>,
+                   &Svd3x3Benchmark::svd3x3Batch<Double>,
+                   &Svd3x3Benchmark::polarDecompositionLoop<Float>,
+                   &Svd3x3Benchmark::polarDecompositionLoop<Double>,
+                   &Svd3x3Benchmark::polarDecompositionBatch<Float>,
+                   &Svd3x3Benchmark::polarDecompositionBatch<Double>}, 10);
+}
+
+constexpr std::size_t MatrixCount = 10000;
+
+template<class T> Corrade::Containers::Array<Matrix3x3<T>> matrixData() {
+    Corrade::Containers::Array<Matrix3x3<T>> out{Corrade::Containers::NoInit, MatrixCount};
+    for(std::size_t i = 0; i != out.size(); ++i) {
+        const T f = T(i % 1013)/T(1013);
+        out[i] = Matrix4<T>::rotation(Deg<T>(T(360)*f), Vector3<T>{T(1), f, T(1) - f}.normalized()).rotationScaling()*
+            Matrix3x3<T>::fromDiagonal(Vector3<T>{T(0.5) + f, T(1) - f, T(2)*f - T(1)});
+    }
+    return out;
+}
+
+template<class T> void Svd3x3Benchmark::svdGeneric() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Matrix3x3<T>> src = matrixData<T>();
+    Corrade::Containers::Array<Matrix3x3<T>> u{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Vector3<T>> w{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Matrix3x3<T>> v{Corrade::Containers::NoInit, MatrixCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != MatrixCount; ++i)
+            std::tie(u[i], w[i], v[i]) = Algorithms::svd(src[i]);
+    }
+
+    CORRADE_COMPARE(u[1]*Matrix3x3<T>::fromDiagonal(w[1])*v[1].transposed(), src[1]);
+}
+
+template<class T> void Svd3x3Benchmark::svd3x3Loop() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Matrix3x3<T>> src = matrixData<T>();
+    Corrade::Containers::Array<Matrix3x3<T>> u{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Vector3<T>> w{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Matrix3x3<T>> v{Corrade::Containers::NoInit, MatrixCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != MatrixCount; ++i)
+            std::tie(u[i], w[i], v[i]) = Algorithms::svd3x3(src[i]);
+    }
+
+    CORRADE_COMPARE(u[1]*Matrix3x3<T>::fromDiagonal(w[1])*v[1].transposed(), src[1]);
+}
+
+template<class T> void Svd3x3Benchmark::svd3x3Batch() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Matrix3x3<T>> src = matrixData<T>();
+    Corrade::Containers::Array<Matrix3x3<T>> u{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Vector3<T>> w{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Matrix3x3<T>> v{Corrade::Containers::NoInit, MatrixCount};
+
+    CORRADE_BENCHMARK(1) {
+        Algorithms::svd3x3Into<T>(src, u, w, v);
+    }
+
+    CORRADE_COMPARE(u[1]*Matrix3x3<T>::fromDiagonal(w[1])*v[1].transposed(), src[1]);
+}
+
+template<class T> void Svd3x3Benchmark::polarDecompositionLoop() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Matrix3x3<T>> src = matrixData<T>();
+    Corrade::Containers::Array<Matrix3x3<T>> rotations{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Matrix3x3<T>> stretches{Corrade::Containers::NoInit, MatrixCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != MatrixCount; ++i)
+            std::tie(rotations[i], stretches[i]) = Algorithms::polarDecomposition(src[i]);
+    }
+
+    CORRADE_COMPARE(rotations[1]*stretches[1], src[1]);
+}
+
+template<class T> void Svd3x3Benchmark::polarDecompositionBatch() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Matrix3x3<T>> src = matrixData<T>();
+    Corrade::Containers::Array<Matrix3x3<T>> rotations{Corrade::Containers::NoInit, MatrixCount};
+    Corrade::Containers::Array<Matrix3x3<T>> stretches{Corrade::Containers::NoInit, MatrixCount};
+
+    CORRADE_BENCHMARK(1) {
+        Algorithms::polarDecompositionInto<T>(src, rotations, stretches);
+    }
+
+    CORRADE_COMPARE(rotations[1]*stretches[1], src[1]);
+}
+
+}}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::Svd3x3Benchmark)
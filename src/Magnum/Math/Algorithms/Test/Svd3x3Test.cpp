@@ -0,0 +1,291 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Algorithms/Svd3x3.h"
+
+namespace Magnum { namespace Math { namespace Algorithms { namespace Test { namespace {
+
+struct Svd3x3Test: Corrade::TestSuite::Tester {
+    explicit Svd3x3Test();
+
+    template<class T> void svd();
+    template<class T> void svdReflection();
+    template<class T> void svdDegenerate();
+    template<class T> void svdInto();
+    void svdIntoWrongSize();
+
+    template<class T> void polar();
+    template<class T> void polarReflection();
+    template<class T> void polarInto();
+    void polarIntoWrongSize();
+};
+
+Svd3x3Test::Svd3x3Test() {
+    addTests({&Svd3x3Test::svd<Float>,
+              &Svd3x3Test::svd<Double>,
+              &Svd3x3Test::svdReflection<Float>,
+              &Svd3x3Test::svdReflection<Double>,
+              &Svd3x3Test::svdDegenerate<Float>,
+              &Svd3x3Test::svdDegenerate<Double>,
+              &Svd3x3Test::svdInto<Float>,
+              &Svd3x3Test::svdInto<Double>,
+              &Svd3x3Test::svdIntoWrongSize,
+
+              &Svd3x3Test::polar<Float>,
+              &Svd3x3Test::polar<Double>,
+              &Svd3x3Test::polarReflection<Float>,
+              &Svd3x3Test::polarReflection<Double>,
+              &Svd3x3Test::polarInto<Float>,
+              &Svd3x3Test::polarInto<Double>,
+              &Svd3x3Test::polarIntoWrongSize});
+}
+
+/* 11 matrices to test both the SIMD lanes and the remainder for both Float
+   and Double */
+template<class T> Matrix3x3<T> matrix(std::size_t i) {
+    return Matrix4<T>::rotation(Deg<T>(T(35) + T(i)*T(20)), Vector3<T>{T(1), T(i), T(2)}.normalized()).rotationScaling()*
+        Matrix3x3<T>::fromDiagonal(Vector3<T>{T(0.5) + T(i), T(2), T(i)*T(-0.3)})*
+        Matrix4<T>::rotationZ(Deg<T>(T(i)*T(15))).rotationScaling();
+}
+
+template<class T> void Svd3x3Test::svd() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Matrix3x3<T> a = Matrix4<T>::scaling({T(1.5), T(2.0), T(1.0)}).rotationScaling()*Matrix4<T>::rotationZ(Deg<T>(T(35))).rotationScaling();
+
+    Matrix3x3<T> u{Magnum::NoInit};
+    Vector3<T> w{Magnum::NoInit};
+    Matrix3x3<T> v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+
+    /* Singular values are sorted, unlike with svd() */
+    CORRADE_COMPARE(w, (Vector3<T>{T(2.0), T(1.5), T(1.0)}));
+    CORRADE_COMPARE(u*Matrix3x3<T>::fromDiagonal(w)*v.transposed(), a);
+    CORRADE_COMPARE(u*u.transposed(), Matrix3x3<T>{IdentityInit});
+    CORRADE_COMPARE(v*v.transposed(), Matrix3x3<T>{IdentityInit});
+    CORRADE_COMPARE(u.determinant(), T(1));
+    CORRADE_COMPARE(v.determinant(), T(1));
+
+    /* The rotation can be extracted directly, there's no sign flip to take
+       care of */
+    CORRADE_COMPARE(u*v.transposed(), Matrix4<T>::rotationZ(Deg<T>(T(35))).rotationScaling());
+}
+
+template<class T> void Svd3x3Test::svdReflection() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Matrix3x3<T> a = Matrix4<T>::rotationX(Deg<T>(T(-70))).rotationScaling()*Matrix3x3<T>::fromDiagonal(Vector3<T>{T(3.0), T(-0.5), T(2.0)});
+
+    Matrix3x3<T> u{Magnum::NoInit};
+    Vector3<T> w{Magnum::NoInit};
+    Matrix3x3<T> v{Magnum::NoInit};
+    std::tie(u, w, v) = Algorithms::svd3x3(a);
+
+    /* The reflection is in the last singular value, U and V stay proper
+       rotations */
+    CORRADE_COMPARE(w, (Vector3<T>{T(3.0), T(2.0), T(-0.5)}));
+    CORRADE_COMPARE(u*Matrix3x3<T>::fromDiagonal(w)*v.transposed(), a);
+    CORRADE_COMPARE(u.determinant(), T(1));
+    CORRADE_COMPARE(v.determinant(), T(1));
+}
+
+template<class T> void Svd3x3Test::svdDegenerate() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Matrix3x3<T> data[]{
+        Matrix3x3<T>{ZeroInit},
+        /* Rank 1 */
+        Matrix3x3<T>{Vector3<T>{T(1.0), T(2.0), T(3.0)},
+                     Vector3<T>{T(2.0), T(4.0), T(6.0)},
+                     Vector3<T>{T(-1.0), T(-2.0), T(-3.0)}},
+        /* Rank 2, first column zero */
+        Matrix3x3<T>{Vector3<T>{},
+                     Vector3<T>{T(0.0), T(0.0), T(3.0)},
+                     Vector3<T>{T(1.0), T(0.0), T(0.0)}},
+        /* Identical singular values */
+        Matrix4<T>::rotationY(Deg<T>(T(20))).rotationScaling()*T(2.0)
+    };
+    const Vector3<T> expected[]{
+        {},
+        {std::sqrt(T(84.0)), T(0.0), T(0.0)},
+        {T(3.0), T(1.0), T(0.0)},
+        {T(2.0), T(2.0), T(2.0)}
+    };
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+
+        Matrix3x3<T> u{Magnum::NoInit};
+        Vector3<T> w{Magnum::NoInit};
+        Matrix3x3<T> v{Magnum::NoInit};
+        std::tie(u, w, v) = Algorithms::svd3x3(data[i]);
+
+        CORRADE_COMPARE(w, expected[i]);
+        CORRADE_COMPARE(u*Matrix3x3<T>::fromDiagonal(w)*v.transposed(), data[i]);
+        CORRADE_COMPARE(u*u.transposed(), Matrix3x3<T>{IdentityInit});
+        CORRADE_COMPARE(v*v.transposed(), Matrix3x3<T>{IdentityInit});
+        CORRADE_COMPARE(u.determinant(), T(1));
+        CORRADE_COMPARE(v.determinant(), T(1));
+    }
+}
+
+template<class T> void Svd3x3Test::svdInto() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Matrix3x3<T> a[11];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(a); ++i)
+        a[i] = matrix<T>(i);
+
+    Matrix3x3<T> u[11];
+    Vector3<T> w[11];
+    Matrix3x3<T> v[11];
+    Algorithms::svd3x3Into<T>(a, u, w, v);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(a); ++i) {
+        CORRADE_ITERATION(i);
+
+        /* Same result as the single-matrix variant, modulo FMA differences
+           in the vectorized code */
+        Matrix3x3<T> expectedU{Magnum::NoInit};
+        Vector3<T> expectedW{Magnum::NoInit};
+        Matrix3x3<T> expectedV{Magnum::NoInit};
+        std::tie(expectedU, expectedW, expectedV) = Algorithms::svd3x3(a[i]);
+        CORRADE_COMPARE(u[i], expectedU);
+        CORRADE_COMPARE(w[i], expectedW);
+        CORRADE_COMPARE(v[i], expectedV);
+
+        CORRADE_COMPARE(u[i]*Matrix3x3<T>::fromDiagonal(w[i])*v[i].transposed(), a[i]);
+    }
+}
+
+void Svd3x3Test::svdIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Math::Matrix3x3<Float> a[3];
+    Math::Matrix3x3<Float> u[3];
+    Math::Matrix3x3<Float> uWrong[2];
+    Math::Vector3<Float> w[3];
+    Math::Vector3<Float> wWrong[4];
+    Math::Matrix3x3<Float> v[3];
+    Math::Matrix3x3<Float> vWrong[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Algorithms::svd3x3Into<Float>(a, uWrong, w, v);
+    Algorithms::svd3x3Into<Float>(a, u, wWrong, v);
+    Algorithms::svd3x3Into<Float>(a, u, w, vWrong);
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::svd3x3Into(): wrong U destination size, got 2 but expected 3\n"
+        "Math::Algorithms::svd3x3Into(): wrong W destination size, got 4 but expected 3\n"
+        "Math::Algorithms::svd3x3Into(): wrong V destination size, got 2 but expected 3\n");
+}
+
+template<class T> void Svd3x3Test::polar() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Matrix3x3<T> rotation = Matrix4<T>::rotation(Deg<T>(T(75)), Vector3<T>{T(1), T(-1), T(2)}.normalized()).rotationScaling();
+    const Matrix3x3<T> stretch = Matrix4<T>::rotationZ(Deg<T>(T(30))).rotationScaling()*Matrix3x3<T>::fromDiagonal(Vector3<T>{T(1.5), T(0.5), T(3.0)})*Matrix4<T>::rotationZ(Deg<T>(T(-30))).rotationScaling();
+
+    Matrix3x3<T> r{Magnum::NoInit};
+    Matrix3x3<T> p{Magnum::NoInit};
+    std::tie(r, p) = Algorithms::polarDecomposition(rotation*stretch);
+    CORRADE_COMPARE(r, rotation);
+    CORRADE_COMPARE(p, stretch);
+    CORRADE_COMPARE(p, p.transposed());
+}
+
+template<class T> void Svd3x3Test::polarReflection() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Matrix3x3<T> a = Matrix4<T>::rotationY(Deg<T>(T(40))).rotationScaling()*Matrix3x3<T>::fromDiagonal(Vector3<T>{T(1.0), T(1.0), T(-2.0)});
+
+    Matrix3x3<T> r{Magnum::NoInit};
+    Matrix3x3<T> p{Magnum::NoInit};
+    std::tie(r, p) = Algorithms::polarDecomposition(a);
+
+    /* The rotation is always proper, the reflection is moved to the stretch
+       part */
+    CORRADE_COMPARE(r.determinant(), T(1));
+    CORRADE_COMPARE(r*p, a);
+    CORRADE_COMPARE(p, p.transposed());
+    CORRADE_COMPARE(p.determinant(), T(-2.0));
+}
+
+template<class T> void Svd3x3Test::polarInto() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Matrix3x3<T> a[11];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(a); ++i)
+        a[i] = matrix<T>(i);
+
+    Matrix3x3<T> rotations[11];
+    Matrix3x3<T> stretches[11];
+    Algorithms::polarDecompositionInto<T>(a, rotations, stretches);
+
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(a); ++i) {
+        CORRADE_ITERATION(i);
+
+        Matrix3x3<T> expectedRotation{Magnum::NoInit};
+        Matrix3x3<T> expectedStretch{Magnum::NoInit};
+        std::tie(expectedRotation, expectedStretch) = Algorithms::polarDecomposition(a[i]);
+        CORRADE_COMPARE(rotations[i], expectedRotation);
+        CORRADE_COMPARE(stretches[i], expectedStretch);
+
+        CORRADE_COMPARE(rotations[i]*stretches[i], a[i]);
+        CORRADE_COMPARE(rotations[i].determinant(), T(1));
+    }
+}
+
+void Svd3x3Test::polarIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Math::Matrix3x3<Float> a[3];
+    Math::Matrix3x3<Float> rotations[3];
+    Math::Matrix3x3<Float> rotationsWrong[2];
+    Math::Matrix3x3<Float> stretches[3];
+    Math::Matrix3x3<Float> stretchesWrong[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Algorithms::polarDecompositionInto<Float>(a, rotationsWrong, stretches);
+    Algorithms::polarDecompositionInto<Float>(a, rotations, stretchesWrong);
+    CORRADE_COMPARE(out.str(),
+        "Math::Algorithms::polarDecompositionInto(): wrong rotation destination size, got 2 but expected 3\n"
+        "Math::Algorithms::polarDecompositionInto(): wrong stretch destination size, got 4 but expected 3\n");
+}
+
+}}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Algorithms::Test::Svd3x3Test)
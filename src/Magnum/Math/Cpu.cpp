@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Cpu.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+struct CpuState {
+    explicit CpuState();
+
+    CpuTier detected;
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    Implementation::CpuFeatures detectedFeatures;
+    #endif
+
+    /* Written by setCpuTier() while batch functions may be selecting kernels
+       on other threads, so these are atomic. Relaxed ordering is enough, as
+       a kernel selected from a mix of the old and new value is still
+       supported by the CPU. */
+    std::atomic<CpuTier> current;
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    std::atomic<Implementation::CpuFeatures> features;
+    #endif
+};
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+Implementation::CpuFeatures maskCpuFeatures(Implementation::CpuFeatures features, const CpuTier tier, const CpuTier detected) {
+    if(tier < CpuTier::Sse41) features.sse41 = false;
+    if(tier < CpuTier::Avx2) features.avx2 = false;
+    /* F16C is present also on some pre-AVX2 CPUs, so it's disabled only if
+       the tier was explicitly lowered */
+    if(tier < CpuTier::Avx2 && tier < detected) features.f16c = false;
+    if(tier < CpuTier::Avx512) features.avx512 = false;
+    return features;
+}
+#endif
+
+bool isCpuTierSupported(const CpuTier tier, const CpuTier detected) {
+    return tier >= Implementation::BaselineCpuTier && tier <= detected;
+}
+
+void applyCpuTier(CpuState& state, const CpuTier tier) {
+    state.current.store(tier, std::memory_order_relaxed);
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    state.features.store(maskCpuFeatures(state.detectedFeatures, tier, state.detected), std::memory_order_relaxed);
+    #endif
+}
+
+bool applyCpuTier(CpuState& state, const Corrade::Containers::StringView name, const char* const prefix) {
+    CpuTier tier;
+    if(name == "scalar") tier = CpuTier::Scalar;
+    else if(name == "sse2") tier = CpuTier::Sse2;
+    else if(name == "sse41") tier = CpuTier::Sse41;
+    else if(name == "avx2") tier = CpuTier::Avx2;
+    else if(name == "avx512") tier = CpuTier::Avx512;
+    else if(name == "neon") tier = CpuTier::Neon;
+    else if(name == "simd128") tier = CpuTier::Simd128;
+    else {
+        Corrade::Utility::Warning{} << prefix << "unknown CPU tier" << name << Corrade::Utility::Debug::nospace << ", ignoring";
+        return false;
+    }
+
+    if(!isCpuTierSupported(tier, state.detected)) {
+        Corrade::Utility::Warning{} << prefix << tier << "is not supported on this machine, using" << state.current.load(std::memory_order_relaxed);
+        return false;
+    }
+
+    applyCpuTier(state, tier);
+    return true;
+}
+
+CpuState::CpuState() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    /* Each tier implies all lower ones, so stop at the first missing */
+    detectedFeatures = Implementation::detectCpuFeatures();
+    detected = CpuTier::Sse2;
+    if(detectedFeatures.sse41) {
+        detected = CpuTier::Sse41;
+        if(detectedFeatures.avx2 && detectedFeatures.f16c) {
+            detected = CpuTier::Avx2;
+            if(detectedFeatures.avx512)
+                detected = CpuTier::Avx512;
+        }
+    }
+    detectedFeatures = maskCpuFeatures(detectedFeatures, detected, detected);
+    #else
+    detected = Implementation::BaselineCpuTier;
+    #endif
+    applyCpuTier(*this, detected);
+
+    /* Applied right after detection so it affects even the very first kernel
+       call */
+    const char* const name = std::getenv("MAGNUM_CPU");
+    if(name && *name) applyCpuTier(*this, name, "Math::cpuTier(): MAGNUM_CPU");
+}
+
+CpuState& cpuState() {
+    /* Detected just once, the function-local static initialization is
+       thread-safe */
+    static CpuState state;
+    return state;
+}
+
+}
+
+Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, const CpuTier value) {
+    debug << "Math::CpuTier" << Corrade::Utility::Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case CpuTier::value: return debug << "::" #value;
+        _c(Scalar)
+        _c(Sse2)
+        _c(Sse41)
+        _c(Avx2)
+        _c(Avx512)
+        _c(Neon)
+        _c(Simd128)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Corrade::Utility::Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Corrade::Utility::Debug::nospace << ")";
+}
+
+CpuTier detectedCpuTier() {
+    return cpuState().detected;
+}
+
+CpuTier cpuTier() {
+    return cpuState().current.load(std::memory_order_relaxed);
+}
+
+void setCpuTier(const CpuTier tier) {
+    CpuState& state = cpuState();
+    CORRADE_ASSERT(isCpuTierSupported(tier, state.detected),
+        "Math::setCpuTier():" << tier << "not supported, expected a tier between" << Implementation::BaselineCpuTier << "and" << state.detected, );
+
+    applyCpuTier(state, tier);
+}
+
+namespace Implementation {
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+CpuFeatures cpuFeatures() {
+    return cpuState().features.load(std::memory_order_relaxed);
+}
+#endif
+
+bool setCpuTier(const Corrade::Containers::StringView name, const char* const prefix) {
+    return applyCpuTier(cpuState(), name, prefix);
+}
+
+}
+
+}}
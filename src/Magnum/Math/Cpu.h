@@ -0,0 +1,131 @@
+#ifndef Magnum_Math_Cpu_h
+#define Magnum_Math_Cpu_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::Math::CpuTier, function @ref Magnum::Math::detectedCpuTier(), @ref Magnum::Math::cpuTier(), @ref Magnum::Math::setCpuTier()
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/Utility.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@brief CPU instruction set tier
+@m_since_latest
+
+Instruction set used by batch functions such as @ref packInto(),
+@ref transformPointsInto() or @ref slerpInto() and by the batch algorithms in
+@ref MeshTools. The tiers for a particular architecture are ordered, each
+implying all lower ones. The lowest tier for given architecture is a
+compile-time baseline, higher tiers are detected at runtime.
+@see @ref detectedCpuTier(), @ref cpuTier(), @ref setCpuTier()
+*/
+enum class CpuTier: UnsignedByte {
+    /** Plain scalar code, used on architectures without SIMD support */
+    Scalar,
+
+    /** SSE2. Compile-time baseline on x86. */
+    Sse2,
+
+    /** SSE4.1 */
+    Sse41,
+
+    /**
+     * AVX2 together with F16C. While F16C is technically a separate
+     * extension, all CPUs supporting AVX2 support F16C as well. F16C is used
+     * also on CPUs detected as @ref CpuTier::Sse41 if present, unless the
+     * tier is explicitly lowered.
+     */
+    Avx2,
+
+    /** AVX-512 Foundation */
+    Avx512,
+
+    /** NEON. Compile-time baseline on ARM64. */
+    Neon,
+
+    /**
+     * WebAssembly SIMD128. Compile-time baseline on Emscripten if compiled
+     * with `-msimd128`.
+     */
+    Simd128
+};
+
+/**
+@debugoperatorenum{CpuTier}
+@m_since_latest
+*/
+MAGNUM_EXPORT Corrade::Utility::Debug& operator<<(Corrade::Utility::Debug& debug, CpuTier value);
+
+/**
+@brief Detected CPU tier
+@m_since_latest
+
+Highest tier that's both supported by the CPU and has kernels compiled in.
+Detected just once, on first call to any function that needs it. On x86 with
+GCC and Clang, SSE4.1, AVX2 with F16C and AVX-512 are detected at runtime,
+on other compilers the result is always @ref CpuTier::Sse2. On ARM64 it's
+@ref CpuTier::Neon, on Emscripten @ref CpuTier::Simd128 if compiled with
+SIMD support and @ref CpuTier::Scalar otherwise.
+@see @ref cpuTier()
+*/
+MAGNUM_EXPORT CpuTier detectedCpuTier();
+
+/**
+@brief CPU tier used by batch functions
+@m_since_latest
+
+By default same as @ref detectedCpuTier(). It can be lowered with
+@ref setCpuTier() or by setting the `MAGNUM_CPU` environment variable to one
+of `sse2`, `sse41`, `avx2`, `avx512`, `neon`, `simd128` or `scalar`, which is
+useful for testing and benchmarking the lower tiers on a single machine.
+Applications using @ref GL::Context can use the `--magnum-cpu` command-line
+option for the same. A value that's not supported on given machine is
+ignored with a warning.
+*/
+MAGNUM_EXPORT CpuTier cpuTier();
+
+/**
+@brief Set CPU tier used by batch functions
+@m_since_latest
+
+Expects that @p tier is not lower than the compile-time baseline for given
+architecture and not higher than @ref detectedCpuTier(). The change is
+global. It's safe to call this function while batch functions are executing on
+other threads, as the tier is stored atomically --- calls that already picked
+a kernel finish with it and subsequent calls use the new tier. It's however
+meant to be done mainly at application startup or between benchmark runs.
+*/
+MAGNUM_EXPORT void setCpuTier(CpuTier tier);
+
+}}
+
+#endif
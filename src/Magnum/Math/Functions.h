@@ -33,6 +33,7 @@
  */
 
 #include <cstdlib> /* std::div() */
+#include <cstring> /* std::memcpy() */
 #include <type_traits>
 #include <utility>
 #include <Corrade/Utility/StlMath.h>
@@ -745,6 +746,190 @@ template<std::size_t size, class T> inline Vector<size, T> sqrtInverted(const Ve
  * @}
  */
 
+/**
+@{ @name Fast approximate functions
+@m_since_latest
+
+Single-precision approximations of @ref sqrt(), @ref sqrtInverted(),
+@ref sin(), @ref cos(), @ref sincos(), @ref exp() and @ref Vector::normalized()
+for hot loops where full precision isn't needed. The functions are
+branch-light, don't call into the standard C math library and have documented
+error bounds. Results for NaN, infinity or negative inputs of
+@ref sqrtFast() and @ref sqrtInvertedFast() are unspecified. See
+@ref sqrtFastInto() and related functions for batch variants.
+*/
+
+namespace Implementation {
+    inline Float floatFromBits(UnsignedInt bits) {
+        Float out;
+        std::memcpy(&out, &bits, sizeof(Float));
+        return out;
+    }
+    inline UnsignedInt floatToBits(Float value) {
+        UnsignedInt out;
+        std::memcpy(&out, &value, sizeof(Float));
+        return out;
+    }
+
+    /* Sine of an angle in turns. The angle is reduced to [-0.5, 0.5] turns,
+       then mirrored to [-π/2, π/2], where a degree-9 Taylor polynomial is
+       evaluated. */
+    inline Float sinFastTurns(Float turns) {
+        turns -= std::floor(turns + 0.5f);
+        Float angle = turns*6.28318531f;
+        if(angle > 1.57079633f) angle = 3.14159265f - angle;
+        else if(angle < -1.57079633f) angle = -3.14159265f - angle;
+        const Float angle2 = angle*angle;
+        return angle*(1.0f + angle2*(-1.66666667e-1f + angle2*(8.33333333e-3f + angle2*(-1.98412698e-4f + angle2*2.75573192e-6f))));
+    }
+}
+
+/**
+@brief Fast approximate inverse square root
+@m_since_latest
+
+Calculates an initial estimate using an integer bit trick and refines it with
+two Newton-Raphson iterations. Maximal relative error compared to
+@ref sqrtInverted() is below @f$ 5 \cdot 10^{-6} @f$.
+@see @ref sqrtInvertedFastInto()
+*/
+inline Float sqrtInvertedFast(Float value) {
+    const Float half = value*0.5f;
+    Float y = Implementation::floatFromBits(0x5f375a86 - (Implementation::floatToBits(value) >> 1));
+    y = y*(1.5f - half*y*y);
+    y = y*(1.5f - half*y*y);
+    return y;
+}
+
+/**
+@brief Fast approximate square root
+@m_since_latest
+
+Calculated as @p value multiplied by @ref sqrtInvertedFast(), so the maximal
+relative error compared to @ref sqrt() is below @f$ 5 \cdot 10^{-6} @f$ as
+well. Returns @cpp 0.0f @ce for zero input.
+@see @ref sqrtFastInto()
+*/
+inline Float sqrtFast(Float value) {
+    return value*sqrtInvertedFast(value);
+}
+
+/**
+@brief Fast approximate sine
+@m_since_latest
+
+Maximal absolute error compared to @ref sin() is below @f$ 5 \cdot 10^{-6} @f$
+for angles in range @f$ [-2 \pi, 2 \pi] @f$. The range reduction is done in
+single precision, so the error grows with the angle magnitude, staying below
+@f$ 2 \cdot 10^{-5} @f$ for angles in range @f$ [-100, 100] @f$.
+@see @ref cosFast(), @ref sincosFast(), @ref sinFastInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float sinFast(Rad<Float> angle);
+#else
+inline Float sinFast(Unit<Rad, Float> angle) {
+    return Implementation::sinFastTurns(Float(angle)*0.159154943f);
+}
+inline Float sinFast(Unit<Deg, Float> angle) { return sinFast(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate cosine
+@m_since_latest
+
+Same error bounds as @ref sinFast().
+@see @ref sincosFast(), @ref cosFastInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline Float cosFast(Rad<Float> angle);
+#else
+inline Float cosFast(Unit<Rad, Float> angle) {
+    return Implementation::sinFastTurns(Float(angle)*0.159154943f + 0.25f);
+}
+inline Float cosFast(Unit<Deg, Float> angle) { return cosFast(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate sine and cosine
+@m_since_latest
+
+Same as calling @ref sinFast() and @ref cosFast(), with the same error
+bounds.
+@see @ref sincosFastInto()
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+inline std::pair<Float, Float> sincosFast(Rad<Float> angle);
+#else
+inline std::pair<Float, Float> sincosFast(Unit<Rad, Float> angle) {
+    const Float turns = Float(angle)*0.159154943f;
+    return {Implementation::sinFastTurns(turns),
+            Implementation::sinFastTurns(turns + 0.25f)};
+}
+inline std::pair<Float, Float> sincosFast(Unit<Deg, Float> angle) { return sincosFast(Rad<Float>(angle)); }
+#endif
+
+/**
+@brief Fast approximate natural exponential
+@m_since_latest
+
+Splits the exponent into an integral power of two, constructed directly in
+the floating-point representation, and a fractional part approximated with a
+degree-5 polynomial. Maximal relative error compared to @ref exp() is below
+@f$ 10^{-5} @f$ for @p exponent in range @f$ [-87, 88] @f$. Exponents
+outside of this range are clamped, so the function never returns zero,
+denormals or an infinity.
+@see @ref expFastInto()
+*/
+inline Float expFast(Float exponent) {
+    Float y = exponent*1.44269504f;
+    if(y < -126.0f) y = -126.0f;
+    else if(y > 127.0f) y = 127.0f;
+    const Float n = std::floor(y + 0.5f);
+    const Float f = (y - n)*0.693147181f;
+    return (1.0f + f*(1.0f + f*(0.5f + f*(1.66666667e-1f + f*(4.16666667e-2f + f*8.33333333e-3f)))))*Implementation::floatFromBits(UnsignedInt(Int(n) + 127) << 23);
+}
+
+/**
+@brief Fast approximate arc tangent of two values
+@m_since_latest
+
+Returns the angle between the positive X axis and the point
+@f$ (x, y) @f$ in range @f$ [-\pi, \pi] @f$, using a degree-11 polynomial
+approximation. Maximal absolute error compared to @ref std::atan2() is below
+@f$ 3 \cdot 10^{-6} @f$. Returns @cpp 0.0_radf @ce if both @p y and @p x are
+zero.
+@see @ref atan2FastInto()
+*/
+inline Rad<Float> atan2Fast(Float y, Float x) {
+    const Float absX = std::abs(x), absY = std::abs(y);
+    const Float max = absX > absY ? absX : absY;
+    const Float min = absX > absY ? absY : absX;
+    /* Avoiding 0/0 if both are zero */
+    const Float a = min/(max > 1.17549435e-38f ? max : 1.17549435e-38f);
+    const Float a2 = a*a;
+    Float out = a*(0.99997726f + a2*(-0.33262347f + a2*(0.19354346f + a2*(-0.11643287f + a2*(0.05265332f + a2*-0.01172120f)))));
+    if(absY > absX) out = 1.57079633f - out;
+    if(x < 0.0f) out = 3.14159265f - out;
+    return Rad<Float>(y < 0.0f ? -out : out);
+}
+
+/**
+@brief Fast approximate vector normalization
+@m_since_latest
+
+Multiplies @p vector with @ref sqrtInvertedFast() of its
+@ref Vector::dot() "squared length". Maximal relative error compared to
+@ref Vector::normalized() is thus below @f$ 5 \cdot 10^{-6} @f$ as well.
+Result for a zero vector is a zero vector.
+*/
+template<class T> inline typename std::enable_if<std::is_same<typename T::Type, Float>::value, T>::type normalizedFast(const T& vector) {
+    return vector*sqrtInvertedFast(vector.dot());
+}
+
+/**
+ * @}
+ */
+
 /**
 @brief Reflect a vector
 @m_since{2020,06}
@@ -0,0 +1,443 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FunctionsBatch.h"
+
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+namespace {
+
+/* All variants below ignore NaN items in the same way as the scalar loop in
+   Math::minmax() does -- if the item compares false, the current value is
+   kept -- which is also what _mm_min_ps() and _mm_max_ps() do if the item is
+   the first operand. The current minimum and maximum are expected to not be
+   NaN, unless all items in given component are NaN. No value from the range
+   is thus lost, the order in which the partial results get combined may
+   however pick a different zero sign if both -0.0f and +0.0f are present.
+
+   The functions return count of processed items, the rest is processed by
+   the scalar code. */
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+/* Contiguous data are processed as a flat array of floats, twelve at a time,
+   as it's a multiple of all supported vector sizes. The accumulators then hold
+   the components interleaved the same way as the input. */
+std::size_t minmaxContiguous(const Float* const data, const std::size_t count, const std::size_t size, Float* const min, Float* const max) {
+    const std::size_t step = 12/size;
+    if(count < step) return 0;
+
+    Float initMin[12], initMax[12];
+    for(std::size_t k = 0; k != 12; ++k) {
+        initMin[k] = min[k % size];
+        initMax[k] = max[k % size];
+    }
+    __m128 min0 = _mm_loadu_ps(initMin), min1 = _mm_loadu_ps(initMin + 4), min2 = _mm_loadu_ps(initMin + 8);
+    __m128 max0 = _mm_loadu_ps(initMax), max1 = _mm_loadu_ps(initMax + 4), max2 = _mm_loadu_ps(initMax + 8);
+
+    std::size_t i = 0;
+    for(const Float* ptr = data; i + step <= count; i += step, ptr += 12) {
+        const __m128 a = _mm_loadu_ps(ptr);
+        const __m128 b = _mm_loadu_ps(ptr + 4);
+        const __m128 c = _mm_loadu_ps(ptr + 8);
+        min0 = _mm_min_ps(a, min0);
+        min1 = _mm_min_ps(b, min1);
+        min2 = _mm_min_ps(c, min2);
+        max0 = _mm_max_ps(a, max0);
+        max1 = _mm_max_ps(b, max1);
+        max2 = _mm_max_ps(c, max2);
+    }
+
+    _mm_storeu_ps(initMin, min0);
+    _mm_storeu_ps(initMin + 4, min1);
+    _mm_storeu_ps(initMin + 8, min2);
+    _mm_storeu_ps(initMax, max0);
+    _mm_storeu_ps(initMax + 4, max1);
+    _mm_storeu_ps(initMax + 8, max2);
+    for(std::size_t k = 0; k != 12; ++k) {
+        Float& minK = min[k % size];
+        Float& maxK = max[k % size];
+        if(initMin[k] < minK) minK = initMin[k];
+        if(initMax[k] > maxK) maxK = initMax[k];
+    }
+
+    return i;
+}
+
+/* Loads just the first `size` components in order to not read past the end
+   of the view, the remaining lanes are zero and ignored */
+inline __m128 load(const Float* const data, const std::size_t size) {
+    switch(size) {
+        case 1: return _mm_load_ss(data);
+        case 2: return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(data)));
+        case 3: return _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(data))), _mm_load_ss(data + 2));
+    }
+    return _mm_loadu_ps(data);
+}
+
+std::size_t minmaxStrided(const char* data, const std::size_t count, const std::ptrdiff_t stride, const std::size_t size, Float* const min, Float* const max) {
+    Float init[4]{};
+    for(std::size_t k = 0; k != size; ++k) init[k] = min[k];
+    __m128 vmin = _mm_loadu_ps(init);
+    for(std::size_t k = 0; k != size; ++k) init[k] = max[k];
+    __m128 vmax = _mm_loadu_ps(init);
+
+    for(std::size_t i = 0; i != count; ++i, data += stride) {
+        const __m128 a = load(reinterpret_cast<const Float*>(data), size);
+        vmin = _mm_min_ps(a, vmin);
+        vmax = _mm_max_ps(a, vmax);
+    }
+
+    _mm_storeu_ps(init, vmin);
+    for(std::size_t k = 0; k != size; ++k) min[k] = init[k];
+    _mm_storeu_ps(init, vmax);
+    for(std::size_t k = 0; k != size; ++k) max[k] = init[k];
+
+    return count;
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+/* vminq_f32() and vmaxq_f32() propagate NaNs, so an explicit compare and
+   select is used instead */
+inline float32x4_t min(const float32x4_t a, const float32x4_t b) {
+    return vbslq_f32(vcltq_f32(a, b), a, b);
+}
+inline float32x4_t max(const float32x4_t a, const float32x4_t b) {
+    return vbslq_f32(vcgtq_f32(a, b), a, b);
+}
+
+std::size_t minmaxContiguous(const Float* const data, const std::size_t count, const std::size_t size, Float* const min, Float* const max) {
+    const std::size_t step = 12/size;
+    if(count < step) return 0;
+
+    Float initMin[12], initMax[12];
+    for(std::size_t k = 0; k != 12; ++k) {
+        initMin[k] = min[k % size];
+        initMax[k] = max[k % size];
+    }
+    float32x4_t min0 = vld1q_f32(initMin), min1 = vld1q_f32(initMin + 4), min2 = vld1q_f32(initMin + 8);
+    float32x4_t max0 = vld1q_f32(initMax), max1 = vld1q_f32(initMax + 4), max2 = vld1q_f32(initMax + 8);
+
+    std::size_t i = 0;
+    for(const Float* ptr = data; i + step <= count; i += step, ptr += 12) {
+        const float32x4_t a = vld1q_f32(ptr);
+        const float32x4_t b = vld1q_f32(ptr + 4);
+        const float32x4_t c = vld1q_f32(ptr + 8);
+        min0 = min(a, min0);
+        min1 = min(b, min1);
+        min2 = min(c, min2);
+        max0 = max(a, max0);
+        max1 = max(b, max1);
+        max2 = max(c, max2);
+    }
+
+    vst1q_f32(initMin, min0);
+    vst1q_f32(initMin + 4, min1);
+    vst1q_f32(initMin + 8, min2);
+    vst1q_f32(initMax, max0);
+    vst1q_f32(initMax + 4, max1);
+    vst1q_f32(initMax + 8, max2);
+    for(std::size_t k = 0; k != 12; ++k) {
+        Float& minK = min[k % size];
+        Float& maxK = max[k % size];
+        if(initMin[k] < minK) minK = initMin[k];
+        if(initMax[k] > maxK) maxK = initMax[k];
+    }
+
+    return i;
+}
+
+}
+#endif
+
+}
+
+void minmaxFloat(const Corrade::Containers::StridedArrayView2D<const Float>& range, Float* const min, Float* const max) {
+    const std::size_t count = range.size()[0];
+    const std::size_t size = range.size()[1];
+    const char* data = static_cast<const char*>(range.data());
+    const std::ptrdiff_t stride = range.stride()[0];
+
+    std::size_t i = 0;
+    #ifdef CORRADE_TARGET_SSE2
+    i = range.isContiguous() ?
+        Sse2::minmaxContiguous(reinterpret_cast<const Float*>(data), count, size, min, max) :
+        Sse2::minmaxStrided(data, count, stride, size, min, max);
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    if(range.isContiguous())
+        i = Neon::minmaxContiguous(reinterpret_cast<const Float*>(data), count, size, min, max);
+    #endif
+
+    /* Remaining items, same as Implementation::minmax() in the header */
+    for(data += i*stride; i != count; ++i, data += stride) {
+        const Float* const item = reinterpret_cast<const Float*>(data);
+        for(std::size_t k = 0; k != size; ++k) {
+            if(item[k] < min[k])
+                min[k] = item[k];
+            else if(item[k] > max[k])
+                max[k] = item[k];
+        }
+    }
+}
+
+}
+
+namespace {
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+/* Loads four values starting at given index. Contiguous data are loaded
+   directly, strided data and the last incomplete group of values gathered
+   through a temporary array, padding the rest with zeros. */
+inline __m128 load(const Corrade::Containers::StridedArrayView1D<const Float>& src, const std::size_t i, const bool contiguous) {
+    if(contiguous && i + 4 <= src.size())
+        return _mm_loadu_ps(&src[i]);
+
+    Float data[4]{};
+    for(std::size_t j = 0, end = Math::min(src.size() - i, std::size_t{4}); j != end; ++j)
+        data[j] = src[i + j];
+    return _mm_loadu_ps(data);
+}
+
+inline void store(const Corrade::Containers::StridedArrayView1D<Float>& dst, const std::size_t i, const bool contiguous, const __m128 value) {
+    if(contiguous && i + 4 <= dst.size()) {
+        _mm_storeu_ps(&dst[i], value);
+        return;
+    }
+
+    Float data[4];
+    _mm_storeu_ps(data, value);
+    for(std::size_t j = 0, end = Math::min(dst.size() - i, std::size_t{4}); j != end; ++j)
+        dst[i + j] = data[j];
+}
+
+/* Selects a where the mask is set and b elsewhere */
+inline __m128 select(const __m128 mask, const __m128 a, const __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+inline __m128 sqrtInvertedFast(const __m128 a) {
+    const __m128 y = _mm_rsqrt_ps(a);
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(a, _mm_set1_ps(0.5f)), y), y)));
+}
+
+inline __m128 sqrtFast(const __m128 a) {
+    /* Inverse square root of zero is infinity and the multiplication would
+       result in a NaN, mask those out */
+    return _mm_and_ps(_mm_cmpneq_ps(a, _mm_setzero_ps()), _mm_mul_ps(a, sqrtInvertedFast(a)));
+}
+
+/* Same as Implementation::sinFastTurns(), except that the rounding is done
+   via a conversion to integers */
+inline __m128 sinFastTurns(__m128 turns) {
+    turns = _mm_sub_ps(turns, _mm_cvtepi32_ps(_mm_cvtps_epi32(turns)));
+    const __m128 angle = _mm_mul_ps(turns, _mm_set1_ps(6.28318531f));
+
+    /* Mirror angles outside of [-π/2, π/2] to ±π - angle */
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 mirrored = _mm_sub_ps(_mm_or_ps(_mm_and_ps(angle, signMask), _mm_set1_ps(3.14159265f)), angle);
+    const __m128 a = select(_mm_cmpgt_ps(_mm_andnot_ps(signMask, angle), _mm_set1_ps(1.57079633f)), mirrored, angle);
+
+    const __m128 a2 = _mm_mul_ps(a, a);
+    __m128 out = _mm_add_ps(_mm_set1_ps(-1.98412698e-4f), _mm_mul_ps(a2, _mm_set1_ps(2.75573192e-6f)));
+    out = _mm_add_ps(_mm_set1_ps(8.33333333e-3f), _mm_mul_ps(a2, out));
+    out = _mm_add_ps(_mm_set1_ps(-1.66666667e-1f), _mm_mul_ps(a2, out));
+    out = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(a2, out));
+    return _mm_mul_ps(a, out);
+}
+
+inline __m128 sinFast(const __m128 angle) {
+    return sinFastTurns(_mm_mul_ps(angle, _mm_set1_ps(0.159154943f)));
+}
+
+inline __m128 cosFast(const __m128 angle) {
+    return sinFastTurns(_mm_add_ps(_mm_mul_ps(angle, _mm_set1_ps(0.159154943f)), _mm_set1_ps(0.25f)));
+}
+
+inline __m128 expFast(const __m128 exponent) {
+    const __m128 y = _mm_max_ps(_mm_min_ps(_mm_mul_ps(exponent, _mm_set1_ps(1.44269504f)), _mm_set1_ps(127.0f)), _mm_set1_ps(-126.0f));
+    const __m128i n = _mm_cvtps_epi32(y);
+    const __m128 f = _mm_mul_ps(_mm_sub_ps(y, _mm_cvtepi32_ps(n)), _mm_set1_ps(0.693147181f));
+
+    __m128 out = _mm_add_ps(_mm_set1_ps(4.16666667e-2f), _mm_mul_ps(f, _mm_set1_ps(8.33333333e-3f)));
+    out = _mm_add_ps(_mm_set1_ps(1.66666667e-1f), _mm_mul_ps(f, out));
+    out = _mm_add_ps(_mm_set1_ps(0.5f), _mm_mul_ps(f, out));
+    out = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, out));
+    out = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, out));
+
+    /* Power of two constructed directly in the exponent bits */
+    return _mm_mul_ps(out, _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23)));
+}
+
+inline __m128 atan2Fast(const __m128 y, const __m128 x) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 absX = _mm_andnot_ps(signMask, x);
+    const __m128 absY = _mm_andnot_ps(signMask, y);
+    /* Avoiding 0/0 if both are zero */
+    const __m128 a = _mm_div_ps(_mm_min_ps(absX, absY), _mm_max_ps(_mm_max_ps(absX, absY), _mm_set1_ps(1.17549435e-38f)));
+    const __m128 a2 = _mm_mul_ps(a, a);
+
+    __m128 out = _mm_add_ps(_mm_set1_ps(0.05265332f), _mm_mul_ps(a2, _mm_set1_ps(-0.01172120f)));
+    out = _mm_add_ps(_mm_set1_ps(-0.11643287f), _mm_mul_ps(a2, out));
+    out = _mm_add_ps(_mm_set1_ps(0.19354346f), _mm_mul_ps(a2, out));
+    out = _mm_add_ps(_mm_set1_ps(-0.33262347f), _mm_mul_ps(a2, out));
+    out = _mm_add_ps(_mm_set1_ps(0.99997726f), _mm_mul_ps(a2, out));
+    out = _mm_mul_ps(a, out);
+
+    out = select(_mm_cmpgt_ps(absY, absX), _mm_sub_ps(_mm_set1_ps(1.57079633f), out), out);
+    out = select(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_sub_ps(_mm_set1_ps(3.14159265f), out), out);
+    return _mm_xor_ps(out, _mm_and_ps(_mm_cmplt_ps(y, _mm_setzero_ps()), signMask));
+}
+
+template<__m128(*function)(__m128)> void unary(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    const bool contiguous = src.isContiguous() && dst.isContiguous();
+    for(std::size_t i = 0; i < src.size(); i += 4)
+        store(dst, i, contiguous, function(load(src, i, contiguous)));
+}
+
+void sincos(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst) {
+    const bool contiguous = src.isContiguous() && sinDst.isContiguous() && cosDst.isContiguous();
+    for(std::size_t i = 0; i < src.size(); i += 4) {
+        const __m128 turns = _mm_mul_ps(load(src, i, contiguous), _mm_set1_ps(0.159154943f));
+        store(sinDst, i, contiguous, sinFastTurns(turns));
+        store(cosDst, i, contiguous, sinFastTurns(_mm_add_ps(turns, _mm_set1_ps(0.25f))));
+    }
+}
+
+void atan2(const Corrade::Containers::StridedArrayView1D<const Float>& y, const Corrade::Containers::StridedArrayView1D<const Float>& x, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    const bool contiguous = y.isContiguous() && x.isContiguous() && dst.isContiguous();
+    for(std::size_t i = 0; i < y.size(); i += 4)
+        store(dst, i, contiguous, atan2Fast(load(y, i, contiguous), load(x, i, contiguous)));
+}
+
+}
+#else
+namespace Scalar {
+
+inline Float sqrtFast(Float a) { return Math::sqrtFast(a); }
+inline Float sqrtInvertedFast(Float a) { return Math::sqrtInvertedFast(a); }
+inline Float sinFast(Float angle) { return Math::sinFast(Rad<Float>(angle)); }
+inline Float cosFast(Float angle) { return Math::cosFast(Rad<Float>(angle)); }
+inline Float expFast(Float exponent) { return Math::expFast(exponent); }
+
+template<Float(*function)(Float)> void unary(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = function(src[i]);
+}
+
+void sincos(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst) {
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const std::pair<Float, Float> sincos = Math::sincosFast(Rad<Float>(src[i]));
+        sinDst[i] = sincos.first;
+        cosDst[i] = sincos.second;
+    }
+}
+
+void atan2(const Corrade::Containers::StridedArrayView1D<const Float>& y, const Corrade::Containers::StridedArrayView1D<const Float>& x, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    for(std::size_t i = 0; i != y.size(); ++i)
+        dst[i] = Float(Math::atan2Fast(y[i], x[i]));
+}
+
+}
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Simd = Sse2;
+#else
+namespace Simd = Scalar;
+#endif
+
+}
+
+void sqrtFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::sqrtFastInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::unary<Simd::sqrtFast>(src, dst);
+}
+
+void sqrtInvertedFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::sqrtInvertedFastInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::unary<Simd::sqrtInvertedFast>(src, dst);
+}
+
+void sinFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::sinFastInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::unary<Simd::sinFast>(src, dst);
+}
+
+void cosFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::cosFastInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::unary<Simd::cosFast>(src, dst);
+}
+
+void sincosFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst) {
+    CORRADE_ASSERT(src.size() == sinDst.size() && src.size() == cosDst.size(),
+        "Math::sincosFastInto(): wrong destination sizes, got" << sinDst.size() << "and" << cosDst.size() << "but expected" << src.size(), );
+
+    Simd::sincos(src, sinDst, cosDst);
+}
+
+void expFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::expFastInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::unary<Simd::expFast>(src, dst);
+}
+
+void atan2FastInto(const Corrade::Containers::StridedArrayView1D<const Float>& y, const Corrade::Containers::StridedArrayView1D<const Float>& x, const Corrade::Containers::StridedArrayView1D<Float>& dst) {
+    CORRADE_ASSERT(y.size() == x.size(),
+        "Math::atan2FastInto(): expected Y and X views to have the same size, got" << y.size() << "and" << x.size(), );
+    CORRADE_ASSERT(y.size() == dst.size(),
+        "Math::atan2FastInto(): wrong destination size, got" << dst.size() << "but expected" << y.size(), );
+
+    Simd::atan2(y, x, dst);
+}
+
+}}
@@ -32,6 +32,7 @@
 #include <initializer_list>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/visibility.h"
 #include "Magnum/Math/Functions.h"
 
 namespace Magnum { namespace Math {
@@ -190,6 +191,40 @@ namespace Implementation {
         }
         return {firstValid, out};
     }
+
+    /* Float scalars and vectors of up to four components are processed with
+       a SIMD kernel in FunctionsBatch.cpp, treating the range as a 2D array
+       of floats. The kernel expects min and max initialized to the first
+       non-NaN value. */
+    template<class T> using IsMinmaxBatchFloat = std::integral_constant<bool, std::is_same<UnderlyingTypeOf<T>, Float>::value && (std::is_same<T, Float>::value || IsVector<T>::value) && sizeof(T) <= 4*sizeof(Float)>;
+
+    MAGNUM_EXPORT void minmaxFloat(const Corrade::Containers::StridedArrayView2D<const Float>& range, Float* min, Float* max);
+
+    template<class T> inline void minmaxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min, T& max) {
+        minmaxFloat(Corrade::Containers::arrayCast<2, const Float>(range), reinterpret_cast<Float*>(&min), reinterpret_cast<Float*>(&max));
+    }
+
+    template<class T> inline T minBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T out, std::false_type) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            out = Math::min(out, range[i]);
+        return out;
+    }
+    template<class T> inline T minBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T out, std::true_type) {
+        T max{out};
+        minmaxBatch(range, out, max);
+        return out;
+    }
+
+    template<class T> inline T maxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T out, std::false_type) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            out = Math::max(out, range[i]);
+        return out;
+    }
+    template<class T> inline T maxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T out, std::true_type) {
+        T min{out};
+        minmaxBatch(range, min, out);
+        return out;
+    }
 }
 
 /**
@@ -202,11 +237,8 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline T min(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.empty()) return {};
 
-    std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        iOut.second = Math::min(iOut.second, range[iOut.first]);
-
-    return iOut.second;
+    const std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
+    return Implementation::minBatch(range.suffix(iOut.first + 1), iOut.second, Implementation::IsMinmaxBatchFloat<T>{});
 }
 
 /**
@@ -247,11 +279,8 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline T max(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.empty()) return {};
 
-    std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        iOut.second = Math::max(iOut.second, range[iOut.first]);
-
-    return iOut.second;
+    const std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
+    return Implementation::maxBatch(range.suffix(iOut.first + 1), iOut.second, Implementation::IsMinmaxBatchFloat<T>{});
 }
 
 /**
@@ -293,6 +322,14 @@ namespace Implementation {
         for(std::size_t i = 0; i != size; ++i)
             minmax(min[i], max[i], value[i]);
     }
+
+    template<class T> inline void minmaxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min, T& max, std::false_type) {
+        for(std::size_t i = 0; i != range.size(); ++i)
+            minmax(min, max, range[i]);
+    }
+    template<class T> inline void minmaxBatch(const Corrade::Containers::StridedArrayView1D<const T>& range, T& min, T& max, std::true_type) {
+        minmaxBatch(range, min, max);
+    }
 }
 
 /**
@@ -307,10 +344,9 @@ ignored, unless the range is all <em>NaN</em>s.
 template<class T> inline std::pair<T, T> minmax(const Corrade::Containers::StridedArrayView1D<const T>& range) {
     if(range.empty()) return {};
 
-    std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
+    const std::pair<std::size_t, T> iOut = Implementation::firstNonNan(range, IsFloatingPoint<T>{}, IsVector<T>{});
     T min{iOut.second}, max{iOut.second};
-    for(++iOut.first; iOut.first != range.size(); ++iOut.first)
-        Implementation::minmax(min, max, range[iOut.first]);
+    Implementation::minmaxBatch(range.suffix(iOut.first + 1), min, max, Implementation::IsMinmaxBatchFloat<T>{});
 
     return {min, max};
 }
@@ -343,6 +379,99 @@ template<class T, std::size_t size> inline std::pair<T, T> minmax(const T(&array
     return minmax<T>(Corrade::Containers::StridedArrayView1D<const T>{array});
 }
 
+/**
+@brief Fast approximate square root of a range
+@param[in]  src     Source values
+@param[out] dst     Destination values
+@m_since_latest
+
+Batch variant of @ref sqrtFast(), with the same error bounds. Expects that
+@p src and @p dst have the same size. The source and destination views are
+allowed to be the same view, in which case the operation is done in-place,
+but they shouldn't partially overlap.
+
+On x86 this and the other fast batch functions use SSE2 instructions,
+processing four values at a time, with the inverse square root estimate
+coming from the @m_class{m-doc-external} [rsqrtps](https://www.felixcloutier.com/x86/rsqrtps)
+instruction refined with a single Newton-Raphson iteration. On other
+platforms the scalar variants are called in a loop.
+*/
+MAGNUM_EXPORT void sqrtFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast approximate inverse square root of a range
+@param[in]  src     Source values
+@param[out] dst     Destination values
+@m_since_latest
+
+Batch variant of @ref sqrtInvertedFast(), with the same error bounds. Result
+for zero input is unspecified. Expects that @p src and @p dst have the same
+size. See @ref sqrtFastInto() for more information.
+*/
+MAGNUM_EXPORT void sqrtInvertedFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast approximate sine of a range
+@param[in]  src     Source angles in radians
+@param[out] dst     Destination values
+@m_since_latest
+
+Batch variant of @ref sinFast(), with the same error bounds. Expects that
+@p src and @p dst have the same size. See @ref sqrtFastInto() for more
+information.
+*/
+MAGNUM_EXPORT void sinFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast approximate cosine of a range
+@param[in]  src     Source angles in radians
+@param[out] dst     Destination values
+@m_since_latest
+
+Batch variant of @ref cosFast(), with the same error bounds. Expects that
+@p src and @p dst have the same size. See @ref sqrtFastInto() for more
+information.
+*/
+MAGNUM_EXPORT void cosFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast approximate sine and cosine of a range
+@param[in]  src     Source angles in radians
+@param[out] sinDst  Destination sine values
+@param[out] cosDst  Destination cosine values
+@m_since_latest
+
+Batch variant of @ref sincosFast(), with the same error bounds. Expects that
+@p src, @p sinDst and @p cosDst have the same size. See @ref sqrtFastInto()
+for more information.
+*/
+MAGNUM_EXPORT void sincosFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& sinDst, const Corrade::Containers::StridedArrayView1D<Float>& cosDst);
+
+/**
+@brief Fast approximate natural exponential of a range
+@param[in]  src     Source exponents
+@param[out] dst     Destination values
+@m_since_latest
+
+Batch variant of @ref expFast(), with the same error bounds. Expects that
+@p src and @p dst have the same size. See @ref sqrtFastInto() for more
+information.
+*/
+MAGNUM_EXPORT void expFastInto(const Corrade::Containers::StridedArrayView1D<const Float>& src, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
+/**
+@brief Fast approximate arc tangent of a range of value pairs
+@param[in]  y       Source Y values
+@param[in]  x       Source X values
+@param[out] dst     Destination angles in radians
+@m_since_latest
+
+Batch variant of @ref atan2Fast(), with the same error bounds. Expects that
+@p y, @p x and @p dst have the same size. See @ref sqrtFastInto() for more
+information.
+*/
+MAGNUM_EXPORT void atan2FastInto(const Corrade::Containers::StridedArrayView1D<const Float>& y, const Corrade::Containers::StridedArrayView1D<const Float>& x, const Corrade::Containers::StridedArrayView1D<Float>& dst);
+
 /* Since 1.8.17, the original short-hand group closing doesn't work anymore.
    FFS. */
 /**
@@ -0,0 +1,129 @@
+#ifndef Magnum_Math_Implementation_cpuFeatures_h
+#define Magnum_Math_Implementation_cpuFeatures_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <Corrade/configure.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/Math/Cpu.h"
+
+/* SSE2 is a compile-time baseline on x86-64 and NEON on ARM64, so kernels
+   using those are picked with just an #ifdef. Extensions beyond that (SSE4.1,
+   AVX2, F16C, AVX-512) are detected at runtime, which is implemented only on
+   GCC and Clang as the kernels rely on __attribute__((target)) to be compiled
+   without special flags. */
+#if defined(CORRADE_TARGET_SSE2) && (defined(CORRADE_TARGET_GCC) || defined(CORRADE_TARGET_CLANG)) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#define MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+#include <cpuid.h>
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 __attribute__((__target__("sse4.1")))
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 __attribute__((__target__("avx2")))
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C __attribute__((__target__("avx,f16c")))
+#define MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX512 __attribute__((__target__("avx512f")))
+#endif
+
+#if defined(CORRADE_TARGET_ARM) && defined(__ARM_NEON) && defined(__aarch64__)
+#define MAGNUM_MATH_IMPLEMENTATION_NEON
+#endif
+
+#if defined(CORRADE_TARGET_EMSCRIPTEN) && defined(__wasm_simd128__)
+#define MAGNUM_MATH_IMPLEMENTATION_SIMD128
+#endif
+
+namespace Magnum { namespace Math { namespace Implementation {
+
+/* The lowest tier, for which kernels are picked at compile time */
+constexpr CpuTier BaselineCpuTier =
+    #ifdef CORRADE_TARGET_SSE2
+    CpuTier::Sse2
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    CpuTier::Neon
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_SIMD128)
+    CpuTier::Simd128
+    #else
+    CpuTier::Scalar
+    #endif
+    ;
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+struct CpuFeatures {
+    bool sse41;
+    bool avx2;
+    bool f16c;
+    bool avx512;
+};
+
+inline CpuFeatures detectCpuFeatures() {
+    CpuFeatures out{};
+    unsigned int eax, ebx, ecx, edx;
+    if(!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) return out;
+    out.sse41 = ecx & (1 << 19);
+
+    /* AVX-based extensions are usable only if the OS saves the YMM state on
+       context switch, which is checked via OSXSAVE and XGETBV */
+    const bool osxsave = ecx & (1 << 27);
+    const bool avx = ecx & (1 << 28);
+    if(!osxsave || !avx) return out;
+    unsigned int xcr0Low, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if((xcr0Low & 0x6) != 0x6) return out;
+
+    out.f16c = ecx & (1 << 29);
+    if(__get_cpuid_max(0, nullptr) >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        out.avx2 = ebx & (1 << 5);
+        /* AVX-512 additionally needs the OS to save the opmask and upper ZMM
+           state */
+        out.avx512 = (ebx & (1 << 16)) && (xcr0Low & 0xe0) == 0xe0;
+    }
+    return out;
+}
+
+/* Features allowed by the current cpuTier(), i.e. the detected ones with
+   everything above the tier masked away. Returned by value, as the state is
+   loaded atomically in case setCpuTier() is called from another thread. */
+MAGNUM_EXPORT CpuFeatures cpuFeatures();
+
+/* Per-tier kernel table for a single kernel family, with an entry for each of
+   CpuTier::Sse2, Sse41, Avx2 and Avx512. Tiers without a dedicated variant
+   have a nullptr entry, in which case the closest lower one is picked, the
+   SSE2 variant is expected to be always present. */
+template<class T> T cpuKernel(const T(&kernels)[4]) {
+    for(std::size_t i = std::size_t(cpuTier()) - std::size_t(CpuTier::Sse2); i; --i)
+        if(kernels[i]) return kernels[i];
+    return kernels[0];
+}
+#endif
+
+/* Parses a lowercase tier name such as "avx2" and calls setCpuTier() with
+   it. Prints a warning prefixed with `prefix` and returns false if the name is
+   unknown or the tier isn't supported on this machine. Used by cpuTier() for
+   the MAGNUM_CPU environment variable and by GL::Context for --magnum-cpu. */
+MAGNUM_EXPORT bool setCpuTier(Corrade::Containers::StringView name, const char* prefix);
+
+}}}
+
+#endif
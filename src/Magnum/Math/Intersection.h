@@ -167,7 +167,7 @@ condition for whether the plane is intersecting the box: @f[
 
 for plane normal @f$ \boldsymbol n @f$ and determinant @f$ w @f$.
 
-@see @ref aabbFrustum()
+@see @ref aabbFrustum(), @ref rangeFrustumInto()
 */
 template<class T> bool rangeFrustum(const Range3D<T>& range, const Frustum<T>& frustum);
 
@@ -199,6 +199,7 @@ template<class T> bool rayRange(const Vector3<T>& rayOrigin, const Vector3<T>& i
 
 Uses the same method as @ref rangeFrustum(), but does not need to convert to
 center/extents representation.
+@see @ref aabbFrustumInto()
 */
 template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T>& aabbExtents, const Frustum<T>& frustum);
 
@@ -213,6 +214,7 @@ template<class T> bool aabbFrustum(const Vector3<T>& aabbCenter, const Vector3<T
 Checks for each plane of the frustum whether the sphere is behind the plane
 (the points distance larger than the sphere's radius) using
 @ref Distance::pointPlaneScaled().
+@see @ref sphereFrustumInto()
 */
 template<class T> bool sphereFrustum(const Vector3<T>& sphereCenter, T sphereRadius, const Frustum<T>& frustum);
 
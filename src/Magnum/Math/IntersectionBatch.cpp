@@ -0,0 +1,317 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "IntersectionBatch.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+namespace {
+
+/* Objects are gathered four at a time into a structure-of-arrays block and
+   each of the frustum planes is then tested against all four at once. The
+   operations are done in the same order as in the single-object functions,
+   the remainder that doesn't fill a whole block is delegated to them. */
+
+#if defined(CORRADE_TARGET_SSE2) || defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+#define MAGNUM_MATH_INTERSECTION_BATCH_SIMD
+#endif
+
+/* Plane components split into separate arrays so they can be directly
+   broadcast. For boxes the W component is negated and scaled as the final
+   comparison needs it, for spheres it's used as-is. */
+struct Planes {
+    Float nx[6], ny[6], nz[6];
+    Float absNx[6], absNy[6], absNz[6];
+    Float w[6], negScaledW[6];
+};
+
+Planes planes(const Frustum<Float>& frustum, const Float wScale) {
+    Planes out;
+    for(std::size_t p = 0; p != 6; ++p) {
+        const Vector4<Float>& plane = frustum[p];
+        out.nx[p] = plane.x();
+        out.ny[p] = plane.y();
+        out.nz[p] = plane.z();
+        out.absNx[p] = Math::abs(plane.x());
+        out.absNy[p] = Math::abs(plane.y());
+        out.absNz[p] = Math::abs(plane.z());
+        out.w[p] = plane.w();
+        out.negScaledW[p] = -wScale*plane.w();
+    }
+    return out;
+}
+
+/* Box centers and extents, or sphere centers and negative squared radii in
+   the first extent component. The SIMD code loads all arrays even for spheres,
+   so the block is value-initialized to not read uninitialized ey and ez. */
+struct Block {
+    Float x[4], y[4], z[4];
+    Float ex[4], ey[4], ez[4];
+};
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+/* Returns a four-bit mask with bits set for objects that intersect the
+   frustum */
+template<bool sphere> int intersects(const Planes& planes, const Block& block) {
+    const __m128 x = _mm_loadu_ps(block.x);
+    const __m128 y = _mm_loadu_ps(block.y);
+    const __m128 z = _mm_loadu_ps(block.z);
+    const __m128 ex = _mm_loadu_ps(block.ex);
+    const __m128 ey = _mm_loadu_ps(block.ey);
+    const __m128 ez = _mm_loadu_ps(block.ez);
+
+    __m128 outside = _mm_setzero_ps();
+    for(std::size_t p = 0; p != 6; ++p) {
+        const __m128 d = _mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(x, _mm_set1_ps(planes.nx[p])),
+            _mm_mul_ps(y, _mm_set1_ps(planes.ny[p]))),
+            _mm_mul_ps(z, _mm_set1_ps(planes.nz[p])));
+        if(sphere) {
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, _mm_set1_ps(planes.w[p])), ex));
+        } else {
+            const __m128 r = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(ex, _mm_set1_ps(planes.absNx[p])),
+                _mm_mul_ps(ey, _mm_set1_ps(planes.absNy[p]))),
+                _mm_mul_ps(ez, _mm_set1_ps(planes.absNz[p])));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), _mm_set1_ps(planes.negScaledW[p])));
+        }
+    }
+
+    return ~_mm_movemask_ps(outside) & 0xf;
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+template<bool sphere> int intersects(const Planes& planes, const Block& block) {
+    const float32x4_t x = vld1q_f32(block.x);
+    const float32x4_t y = vld1q_f32(block.y);
+    const float32x4_t z = vld1q_f32(block.z);
+    const float32x4_t ex = vld1q_f32(block.ex);
+    const float32x4_t ey = vld1q_f32(block.ey);
+    const float32x4_t ez = vld1q_f32(block.ez);
+
+    uint32x4_t outside = vdupq_n_u32(0);
+    for(std::size_t p = 0; p != 6; ++p) {
+        const float32x4_t d = vaddq_f32(vaddq_f32(
+            vmulq_f32(x, vdupq_n_f32(planes.nx[p])),
+            vmulq_f32(y, vdupq_n_f32(planes.ny[p]))),
+            vmulq_f32(z, vdupq_n_f32(planes.nz[p])));
+        if(sphere) {
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, vdupq_n_f32(planes.w[p])), ex));
+        } else {
+            const float32x4_t r = vaddq_f32(vaddq_f32(
+                vmulq_f32(ex, vdupq_n_f32(planes.absNx[p])),
+                vmulq_f32(ey, vdupq_n_f32(planes.absNy[p]))),
+                vmulq_f32(ez, vdupq_n_f32(planes.absNz[p])));
+            outside = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), vdupq_n_f32(planes.negScaledW[p])));
+        }
+    }
+
+    /* Equivalent of _mm_movemask_ps() */
+    const uint32_t bits[]{1, 2, 4, 8};
+    return ~vaddvq_u32(vandq_u32(outside, vld1q_u32(bits))) & 0xf;
+}
+
+}
+#endif
+
+#if defined(CORRADE_TARGET_SSE2)
+namespace Simd = Sse2;
+#elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+namespace Simd = Neon;
+#endif
+
+/* Gather fills a block item from given index, single tests one item with the
+   scalar function and output saves the result */
+template<bool sphere, class Gather, class Single, class Output> void cull(const std::size_t size, const Frustum<Float>& frustum, const Float wScale, Gather gather, Single single, Output output) {
+    std::size_t i = 0;
+
+    #ifdef MAGNUM_MATH_INTERSECTION_BATCH_SIMD
+    const Planes prepared = planes(frustum, wScale);
+    Block block{};
+    for(; i + 4 <= size; i += 4) {
+        for(std::size_t j = 0; j != 4; ++j) gather(block, j, i + j);
+        const int mask = Simd::intersects<sphere>(prepared, block);
+        for(std::size_t j = 0; j != 4; ++j) output(i + j, mask & (1 << j));
+    }
+    #else
+    static_cast<void>(frustum);
+    static_cast<void>(wScale);
+    static_cast<void>(gather);
+    #endif
+
+    for(; i != size; ++i) output(i, single(i));
+}
+
+template<class Output> void rangeFrustumImplementation(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, Output output) {
+    /* Same as in rangeFrustum(), converting to center/extent without the
+       division by 2 and comparing to 2*-plane.w() instead */
+    cull<false>(ranges.size(), frustum, 2.0f, [&](Block& block, std::size_t j, std::size_t i) {
+        const Range3D<Float>& range = ranges[i];
+        const Vector3<Float> center = range.min() + range.max();
+        const Vector3<Float> extent = range.max() - range.min();
+        block.x[j] = center.x();
+        block.y[j] = center.y();
+        block.z[j] = center.z();
+        block.ex[j] = extent.x();
+        block.ey[j] = extent.y();
+        block.ez[j] = extent.z();
+    }, [&](std::size_t i) {
+        return rangeFrustum(ranges[i], frustum);
+    }, output);
+}
+
+template<class Output> void aabbFrustumImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, Output output) {
+    cull<false>(aabbCenters.size(), frustum, 1.0f, [&](Block& block, std::size_t j, std::size_t i) {
+        const Vector3<Float>& center = aabbCenters[i];
+        const Vector3<Float>& extent = aabbExtents[i];
+        block.x[j] = center.x();
+        block.y[j] = center.y();
+        block.z[j] = center.z();
+        block.ex[j] = extent.x();
+        block.ey[j] = extent.y();
+        block.ez[j] = extent.z();
+    }, [&](std::size_t i) {
+        return aabbFrustum(aabbCenters[i], aabbExtents[i], frustum);
+    }, output);
+}
+
+template<class Output> void sphereFrustumImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, Output output) {
+    cull<true>(sphereCenters.size(), frustum, 1.0f, [&](Block& block, std::size_t j, std::size_t i) {
+        const Vector3<Float>& center = sphereCenters[i];
+        const Float radius = sphereRadii[i];
+        block.x[j] = center.x();
+        block.y[j] = center.y();
+        block.z[j] = center.z();
+        block.ex[j] = -(radius*radius);
+    }, [&](std::size_t i) {
+        return sphereFrustum(sphereCenters[i], sphereRadii[i], frustum);
+    }, output);
+}
+
+/* The index output is written unconditionally and the count increased only
+   if the item is visible, which avoids a hard-to-predict branch. There's
+   always enough space as the count is never larger than the index. */
+struct IndexOutput {
+    explicit IndexOutput(const Corrade::Containers::ArrayView<UnsignedInt>& out, std::size_t& count): out(out), count(count) {}
+
+    void operator()(std::size_t i, bool visible) {
+        out[count] = i;
+        count += visible;
+    }
+
+    const Corrade::Containers::ArrayView<UnsignedInt>& out;
+    std::size_t& count;
+};
+
+struct BoolOutput {
+    explicit BoolOutput(const Corrade::Containers::StridedArrayView1D<bool>& out): out(out) {}
+
+    void operator()(std::size_t i, bool visible) {
+        out[i] = visible;
+    }
+
+    const Corrade::Containers::StridedArrayView1D<bool>& out;
+};
+
+}
+
+void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out) {
+    CORRADE_ASSERT(ranges.size() == out.size(),
+        "Math::Intersection::rangeFrustumInto(): wrong output size, got" << out.size() << "but expected" << ranges.size(), );
+
+    rangeFrustumImplementation(ranges, frustum, BoolOutput{out});
+}
+
+std::size_t rangeFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out) {
+    CORRADE_ASSERT(out.size() >= ranges.size(),
+        "Math::Intersection::rangeFrustumIndicesInto(): output too small, got" << out.size() << "but expected at least" << ranges.size(), {});
+
+    std::size_t count = 0;
+    rangeFrustumImplementation(ranges, frustum, IndexOutput{out, count});
+    return count;
+}
+
+void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out) {
+    CORRADE_ASSERT(aabbCenters.size() == aabbExtents.size(),
+        "Math::Intersection::aabbFrustumInto(): expected center and extent views to have the same size, got" << aabbCenters.size() << "and" << aabbExtents.size(), );
+    CORRADE_ASSERT(aabbCenters.size() == out.size(),
+        "Math::Intersection::aabbFrustumInto(): wrong output size, got" << out.size() << "but expected" << aabbCenters.size(), );
+
+    aabbFrustumImplementation(aabbCenters, aabbExtents, frustum, BoolOutput{out});
+}
+
+std::size_t aabbFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out) {
+    CORRADE_ASSERT(aabbCenters.size() == aabbExtents.size(),
+        "Math::Intersection::aabbFrustumIndicesInto(): expected center and extent views to have the same size, got" << aabbCenters.size() << "and" << aabbExtents.size(), {});
+    CORRADE_ASSERT(out.size() >= aabbCenters.size(),
+        "Math::Intersection::aabbFrustumIndicesInto(): output too small, got" << out.size() << "but expected at least" << aabbCenters.size(), {});
+
+    std::size_t count = 0;
+    aabbFrustumImplementation(aabbCenters, aabbExtents, frustum, IndexOutput{out, count});
+    return count;
+}
+
+void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out) {
+    CORRADE_ASSERT(sphereCenters.size() == sphereRadii.size(),
+        "Math::Intersection::sphereFrustumInto(): expected center and radius views to have the same size, got" << sphereCenters.size() << "and" << sphereRadii.size(), );
+    CORRADE_ASSERT(sphereCenters.size() == out.size(),
+        "Math::Intersection::sphereFrustumInto(): wrong output size, got" << out.size() << "but expected" << sphereCenters.size(), );
+
+    sphereFrustumImplementation(sphereCenters, sphereRadii, frustum, BoolOutput{out});
+}
+
+std::size_t sphereFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out) {
+    CORRADE_ASSERT(sphereCenters.size() == sphereRadii.size(),
+        "Math::Intersection::sphereFrustumIndicesInto(): expected center and radius views to have the same size, got" << sphereCenters.size() << "and" << sphereRadii.size(), {});
+    CORRADE_ASSERT(out.size() >= sphereCenters.size(),
+        "Math::Intersection::sphereFrustumIndicesInto(): output too small, got" << out.size() << "but expected at least" << sphereCenters.size(), {});
+
+    std::size_t count = 0;
+    sphereFrustumImplementation(sphereCenters, sphereRadii, frustum, IndexOutput{out, count});
+    return count;
+}
+
+}}}
@@ -0,0 +1,153 @@
+#ifndef Magnum_Math_IntersectionBatch_h
+#define Magnum_Math_IntersectionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::Intersection::rangeFrustumInto(), @ref Magnum::Math::Intersection::aabbFrustumInto(), @ref Magnum::Math::Intersection::sphereFrustumInto(), @ref Magnum::Math::Intersection::rangeFrustumIndicesInto(), @ref Magnum::Math::Intersection::aabbFrustumIndicesInto(), @ref Magnum::Math::Intersection::sphereFrustumIndicesInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math { namespace Intersection {
+
+/**
+@{ @name Batch frustum culling functions
+
+These functions test an unbounded range of objects against a single frustum,
+as opposed to @ref rangeFrustum(), @ref aabbFrustum() and @ref sphereFrustum()
+operating on a single object. The result is either written as one
+@cpp bool @ce for each object or compacted into a list of indices of objects
+that intersect the frustum.
+
+The objects are processed four at a time, with each frustum plane tested
+against all four at once. On x86 the functions use SSE2 instructions, on
+ARM64 NEON instructions. The calculation is done in the same order as in the
+single-object variants, so the results are the same.
+*/
+
+/**
+@brief Intersection of ranges and a frustum
+@param[in]  ranges  Ranges
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] out     Where to put the results
+@m_since_latest
+
+Equivalent to calling @ref rangeFrustum() for each item of @p ranges and
+saving the result to the corresponding item of @p out. Expects that @p ranges
+and @p out have the same size.
+@see @ref rangeFrustumIndicesInto()
+*/
+MAGNUM_EXPORT void rangeFrustumInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out);
+
+/**
+@brief Indices of ranges intersecting a frustum
+@param[in]  ranges  Ranges
+@param[in]  frustum Frustum planes with normals pointing outwards
+@param[out] out     Where to put the indices
+@return Count of indices written to @p out
+@m_since_latest
+
+Writes indices of items of @p ranges for which @ref rangeFrustum() returns
+@cpp true @ce to @p out, in increasing order. Expects that @p out is at least
+as large as @p ranges.
+@see @ref rangeFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t rangeFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Range3D<Float>>& ranges, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out);
+
+/**
+@brief Intersection of axis-aligned boxes and a frustum
+@param[in]  aabbCenters Centers of the AABBs
+@param[in]  aabbExtents (Half-)extents of the AABBs
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] out         Where to put the results
+@m_since_latest
+
+Equivalent to calling @ref aabbFrustum() for each item of @p aabbCenters and
+@p aabbExtents and saving the result to the corresponding item of @p out.
+Expects that all views have the same size.
+@see @ref aabbFrustumIndicesInto()
+*/
+MAGNUM_EXPORT void aabbFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out);
+
+/**
+@brief Indices of axis-aligned boxes intersecting a frustum
+@param[in]  aabbCenters Centers of the AABBs
+@param[in]  aabbExtents (Half-)extents of the AABBs
+@param[in]  frustum     Frustum planes with normals pointing outwards
+@param[out] out         Where to put the indices
+@return Count of indices written to @p out
+@m_since_latest
+
+Writes indices of items for which @ref aabbFrustum() returns @cpp true @ce to
+@p out, in increasing order. Expects that @p aabbCenters and @p aabbExtents
+have the same size and that @p out is at least as large.
+@see @ref aabbFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t aabbFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbCenters, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& aabbExtents, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out);
+
+/**
+@brief Intersection of spheres and a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] out             Where to put the results
+@m_since_latest
+
+Equivalent to calling @ref sphereFrustum() for each item of @p sphereCenters
+and @p sphereRadii and saving the result to the corresponding item of @p out.
+Expects that all views have the same size.
+@see @ref sphereFrustumIndicesInto()
+*/
+MAGNUM_EXPORT void sphereFrustumInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::StridedArrayView1D<bool>& out);
+
+/**
+@brief Indices of spheres intersecting a frustum
+@param[in]  sphereCenters   Sphere centers
+@param[in]  sphereRadii     Sphere radii
+@param[in]  frustum         Frustum planes with normals pointing outwards
+@param[out] out             Where to put the indices
+@return Count of indices written to @p out
+@m_since_latest
+
+Writes indices of items for which @ref sphereFrustum() returns @cpp true @ce
+to @p out, in increasing order. Expects that @p sphereCenters and
+@p sphereRadii have the same size and that @p out is at least as large.
+@see @ref sphereFrustumInto()
+*/
+MAGNUM_EXPORT std::size_t sphereFrustumIndicesInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& sphereCenters, const Corrade::Containers::StridedArrayView1D<const Float>& sphereRadii, const Frustum<Float>& frustum, const Corrade::Containers::ArrayView<UnsignedInt>& out);
+
+/**
+@}
+*/
+
+}}}
+
+#endif
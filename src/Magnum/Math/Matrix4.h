@@ -32,6 +32,12 @@
 #include "Magnum/Math/Matrix.h"
 #include "Magnum/Math/Vector4.h"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <xmmintrin.h>
+#elif defined(CORRADE_TARGET_ARM) && defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #ifdef CORRADE_TARGET_WINDOWS /* I so HATE windef.h */
 #undef near
 #undef far
@@ -963,6 +969,271 @@ template<class T> class Matrix4: public Matrix4x4<T> {
 MAGNUM_MATRIXn_OPERATOR_IMPLEMENTATION(4, Matrix4)
 #endif
 
+/* SIMD variants of the most common Matrix4<Float> operations. SSE2 is a
+   compile-time baseline on x86-64 and NEON on ARM64, so these are picked with
+   just an #ifdef. Multiplication uses the same operation order as the generic
+   implementation and thus gives the same results, the inverse uses a 2x2 block
+   decomposition instead of cofactor expansion so it's only equal within
+   floating-point precision. As Math is header-only, the kernels have to be
+   inline here. */
+#if !defined(DOXYGEN_GENERATING_OUTPUT) && (defined(CORRADE_TARGET_SSE2) || (defined(CORRADE_TARGET_ARM) && defined(__ARM_NEON) && defined(__aarch64__)))
+namespace Implementation {
+
+#ifdef CORRADE_TARGET_SSE2
+inline __m128 matrix4MultiplyColumn(const __m128 a0, const __m128 a1, const __m128 a2, const __m128 a3, const __m128 b) {
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(a0, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 0, 0, 0))),
+        _mm_mul_ps(a1, _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 1, 1, 1)))),
+        _mm_mul_ps(a2, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 2, 2)))),
+        _mm_mul_ps(a3, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3))));
+}
+
+inline void matrix4Multiply(const Float* const a, const Float* const b, Float* const out) {
+    const __m128 a0 = _mm_loadu_ps(a);
+    const __m128 a1 = _mm_loadu_ps(a + 4);
+    const __m128 a2 = _mm_loadu_ps(a + 8);
+    const __m128 a3 = _mm_loadu_ps(a + 12);
+    for(std::size_t col = 0; col != 4; ++col)
+        _mm_storeu_ps(out + col*4, matrix4MultiplyColumn(a0, a1, a2, a3, _mm_loadu_ps(b + col*4)));
+}
+
+inline void matrix4MultiplyVector(const Float* const a, const Float* const b, Float* const out) {
+    _mm_storeu_ps(out, matrix4MultiplyColumn(_mm_loadu_ps(a), _mm_loadu_ps(a + 4), _mm_loadu_ps(a + 8), _mm_loadu_ps(a + 12), _mm_loadu_ps(b)));
+}
+
+/* 2x2 matrices stored as (m00, m01, m10, m11) in a single register. A*B,
+   adj(A)*B and A*adj(B). */
+inline __m128 matrix2Multiply(const __m128 a, const __m128 b) {
+    return _mm_add_ps(
+        _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+inline __m128 matrix2AdjMultiply(const __m128 a, const __m128 b) {
+    return _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+inline __m128 matrix2MultiplyAdj(const __m128 a, const __m128 b) {
+    return _mm_sub_ps(
+        _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+        _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+inline void matrix4Inverted(const Float* const m, Float* const out) {
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+
+    /* 2x2 sub-blocks A B / C D of the (column-major) matrix */
+    const __m128 a = _mm_movelh_ps(c0, c1);
+    const __m128 b = _mm_movehl_ps(c1, c0);
+    const __m128 c = _mm_movelh_ps(c2, c3);
+    const __m128 d = _mm_movehl_ps(c3, c2);
+
+    /* Determinants of all four blocks at once */
+    const __m128 det = _mm_sub_ps(
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+        _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+    const __m128 detA = _mm_shuffle_ps(det, det, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 detB = _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 detC = _mm_shuffle_ps(det, det, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 detD = _mm_shuffle_ps(det, det, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128 dc = matrix2AdjMultiply(d, c);
+    const __m128 ab = matrix2AdjMultiply(a, b);
+    __m128 x = _mm_sub_ps(_mm_mul_ps(detD, a), matrix2Multiply(b, dc));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(detA, d), matrix2Multiply(c, ab));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(detB, c), matrix2MultiplyAdj(d, ab));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(detC, b), matrix2MultiplyAdj(a, dc));
+
+    /* Determinant of the whole matrix, tr((A#B)(D#C)) summed horizontally */
+    __m128 tr = _mm_mul_ps(ab, _mm_shuffle_ps(dc, dc, _MM_SHUFFLE(3, 1, 2, 0)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(2, 3, 0, 1)));
+    tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+    const __m128 invDetM = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+    x = _mm_mul_ps(x, invDetM);
+    y = _mm_mul_ps(y, invDetM);
+    z = _mm_mul_ps(z, invDetM);
+    w = _mm_mul_ps(w, invDetM);
+
+    _mm_storeu_ps(out, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(out + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(out + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+}
+
+inline void matrix4InvertedRigid(const Float* const m, Float* const out) {
+    __m128 c0 = _mm_loadu_ps(m);
+    __m128 c1 = _mm_loadu_ps(m + 4);
+    __m128 c2 = _mm_loadu_ps(m + 8);
+    __m128 zero = _mm_setzero_ps();
+    /* Rigid transformation has the bottom row (0, 0, 0, 1), so the last
+       column of the transpose is zero */
+    _MM_TRANSPOSE4_PS(c0, c1, c2, zero);
+
+    /* Same operation order as R^T*-t in the generic implementation */
+    const __m128 t = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(m + 12));
+    _mm_storeu_ps(out, c0);
+    _mm_storeu_ps(out + 4, c1);
+    _mm_storeu_ps(out + 8, c2);
+    _mm_storeu_ps(out + 12, _mm_add_ps(_mm_add_ps(
+        _mm_mul_ps(c0, _mm_shuffle_ps(t, t, _MM_SHUFFLE(0, 0, 0, 0))),
+        _mm_mul_ps(c1, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1)))),
+        _mm_mul_ps(c2, _mm_shuffle_ps(t, t, _MM_SHUFFLE(2, 2, 2, 2)))));
+    out[15] = 1.0f;
+}
+#else
+inline float32x4_t matrix4MultiplyColumn(const float32x4_t a0, const float32x4_t a1, const float32x4_t a2, const float32x4_t a3, const float32x4_t b) {
+    return vaddq_f32(vaddq_f32(vaddq_f32(
+        vmulq_laneq_f32(a0, b, 0),
+        vmulq_laneq_f32(a1, b, 1)),
+        vmulq_laneq_f32(a2, b, 2)),
+        vmulq_laneq_f32(a3, b, 3));
+}
+
+inline void matrix4Multiply(const Float* const a, const Float* const b, Float* const out) {
+    const float32x4_t a0 = vld1q_f32(a);
+    const float32x4_t a1 = vld1q_f32(a + 4);
+    const float32x4_t a2 = vld1q_f32(a + 8);
+    const float32x4_t a3 = vld1q_f32(a + 12);
+    for(std::size_t col = 0; col != 4; ++col)
+        vst1q_f32(out + col*4, matrix4MultiplyColumn(a0, a1, a2, a3, vld1q_f32(b + col*4)));
+}
+
+inline void matrix4MultiplyVector(const Float* const a, const Float* const b, Float* const out) {
+    vst1q_f32(out, matrix4MultiplyColumn(vld1q_f32(a), vld1q_f32(a + 4), vld1q_f32(a + 8), vld1q_f32(a + 12), vld1q_f32(b)));
+}
+
+/* 2x2 matrices stored as (m00, m01, m10, m11) in a single register.
+   Swizzles of the form (b0, b3, b0, b3) are done by extracting the pair into
+   the low half and duplicating it. A*B, adj(A)*B and A*adj(B). */
+inline float32x4_t matrix2Multiply(const float32x4_t a, const float32x4_t b) {
+    const float32x2_t b03 = vrev64_f32(vget_low_f32(vextq_f32(b, b, 3)));
+    const float32x2_t b21 = vrev64_f32(vget_low_f32(vextq_f32(b, b, 1)));
+    return vaddq_f32(
+        vmulq_f32(a, vcombine_f32(b03, b03)),
+        vmulq_f32(vrev64q_f32(a), vcombine_f32(b21, b21)));
+}
+inline float32x4_t matrix2AdjMultiply(const float32x4_t a, const float32x4_t b) {
+    return vsubq_f32(
+        vmulq_f32(vcombine_f32(vdup_laneq_f32(a, 3), vdup_laneq_f32(a, 0)), b),
+        vmulq_f32(vcombine_f32(vdup_laneq_f32(a, 1), vdup_laneq_f32(a, 2)), vextq_f32(b, b, 2)));
+}
+inline float32x4_t matrix2MultiplyAdj(const float32x4_t a, const float32x4_t b) {
+    const float32x2_t b30 = vget_low_f32(vextq_f32(b, b, 3));
+    const float32x2_t b21 = vrev64_f32(vget_low_f32(vextq_f32(b, b, 1)));
+    return vsubq_f32(
+        vmulq_f32(a, vcombine_f32(b30, b30)),
+        vmulq_f32(vrev64q_f32(a), vcombine_f32(b21, b21)));
+}
+
+inline void matrix4Inverted(const Float* const m, Float* const out) {
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+
+    /* 2x2 sub-blocks A B / C D of the (column-major) matrix */
+    const float32x4_t a = vcombine_f32(vget_low_f32(c0), vget_low_f32(c1));
+    const float32x4_t b = vcombine_f32(vget_high_f32(c0), vget_high_f32(c1));
+    const float32x4_t c = vcombine_f32(vget_low_f32(c2), vget_low_f32(c3));
+    const float32x4_t d = vcombine_f32(vget_high_f32(c2), vget_high_f32(c3));
+
+    /* Determinants of all four blocks at once */
+    const float32x4_t det = vsubq_f32(
+        vmulq_f32(vuzp1q_f32(c0, c2), vuzp2q_f32(c1, c3)),
+        vmulq_f32(vuzp2q_f32(c0, c2), vuzp1q_f32(c1, c3)));
+    const float32x4_t detA = vdupq_laneq_f32(det, 0);
+    const float32x4_t detB = vdupq_laneq_f32(det, 1);
+    const float32x4_t detC = vdupq_laneq_f32(det, 2);
+    const float32x4_t detD = vdupq_laneq_f32(det, 3);
+
+    const float32x4_t dc = matrix2AdjMultiply(d, c);
+    const float32x4_t ab = matrix2AdjMultiply(a, b);
+    float32x4_t x = vsubq_f32(vmulq_f32(detD, a), matrix2Multiply(b, dc));
+    float32x4_t w = vsubq_f32(vmulq_f32(detA, d), matrix2Multiply(c, ab));
+    float32x4_t y = vsubq_f32(vmulq_f32(detB, c), matrix2MultiplyAdj(d, ab));
+    float32x4_t z = vsubq_f32(vmulq_f32(detC, b), matrix2MultiplyAdj(a, dc));
+
+    /* Determinant of the whole matrix, tr((A#B)(D#C)) summed horizontally */
+    const float32x4_t dcTransposed = vcombine_f32(vget_low_f32(vuzp1q_f32(dc, dc)), vget_low_f32(vuzp2q_f32(dc, dc)));
+    const float32x4_t detM = vsubq_f32(vaddq_f32(vmulq_f32(detA, detD), vmulq_f32(detB, detC)), vdupq_n_f32(vaddvq_f32(vmulq_f32(ab, dcTransposed))));
+
+    const Float sign[]{1.0f, -1.0f, -1.0f, 1.0f};
+    const float32x4_t invDetM = vdivq_f32(vld1q_f32(sign), detM);
+    x = vmulq_f32(x, invDetM);
+    y = vmulq_f32(y, invDetM);
+    z = vmulq_f32(z, invDetM);
+    w = vmulq_f32(w, invDetM);
+
+    vst1q_f32(out, vrev64q_f32(vuzp2q_f32(x, y)));
+    vst1q_f32(out + 4, vrev64q_f32(vuzp1q_f32(x, y)));
+    vst1q_f32(out + 8, vrev64q_f32(vuzp2q_f32(z, w)));
+    vst1q_f32(out + 12, vrev64q_f32(vuzp1q_f32(z, w)));
+}
+
+inline void matrix4InvertedRigid(const Float* const m, Float* const out) {
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    /* Rigid transformation has the bottom row (0, 0, 0, 1), so the last
+       column of the transpose is zero */
+    const float32x4_t t01Low = vtrn1q_f32(c0, c1);
+    const float32x4_t t01High = vtrn2q_f32(c0, c1);
+    const float32x4_t t2Low = vtrn1q_f32(c2, zero);
+    const float32x4_t t2High = vtrn2q_f32(c2, zero);
+    const float32x4_t r0 = vcombine_f32(vget_low_f32(t01Low), vget_low_f32(t2Low));
+    const float32x4_t r1 = vcombine_f32(vget_low_f32(t01High), vget_low_f32(t2High));
+    const float32x4_t r2 = vcombine_f32(vget_high_f32(t01Low), vget_high_f32(t2Low));
+
+    /* Same operation order as R^T*-t in the generic implementation */
+    const float32x4_t t = vsubq_f32(zero, vld1q_f32(m + 12));
+    vst1q_f32(out, r0);
+    vst1q_f32(out + 4, r1);
+    vst1q_f32(out + 8, r2);
+    vst1q_f32(out + 12, vaddq_f32(vaddq_f32(
+        vmulq_laneq_f32(r0, t, 0),
+        vmulq_laneq_f32(r1, t, 1)),
+        vmulq_laneq_f32(r2, t, 2)));
+    out[15] = 1.0f;
+}
+#endif
+
+}
+
+template<> inline Matrix4<Float> Matrix4<Float>::operator*(const Matrix<4, Float>& other) const {
+    Matrix4<Float> out{Magnum::NoInit};
+    Implementation::matrix4Multiply(data(), other.data(), out.data());
+    return out;
+}
+
+template<> inline Vector4<Float> Matrix4<Float>::operator*(const Vector<4, Float>& other) const {
+    Vector4<Float> out{Magnum::NoInit};
+    Implementation::matrix4MultiplyVector(data(), other.data(), out.data());
+    return out;
+}
+
+template<> inline Matrix4<Float> Matrix4<Float>::inverted() const {
+    Matrix4<Float> out{Magnum::NoInit};
+    Implementation::matrix4Inverted(data(), out.data());
+    return out;
+}
+
+template<> inline Matrix4<Float> Matrix4<Float>::invertedRigid() const {
+    CORRADE_ASSERT(isRigidTransformation(),
+        "Math::Matrix4::invertedRigid(): the matrix doesn't represent a rigid transformation:" << Corrade::Utility::Debug::newline << *this, {});
+
+    Matrix4<Float> out{Magnum::NoInit};
+    Implementation::matrix4InvertedRigid(data(), out.data());
+    return out;
+}
+#endif
+
 template<class T> Matrix4<T> Matrix4<T>::rotation(const Rad<T> angle, const Vector3<T>& normalizedAxis) {
     CORRADE_ASSERT(normalizedAxis.isNormalized(),
         "Math::Matrix4::rotation(): axis" << normalizedAxis << "is not normalized", {});
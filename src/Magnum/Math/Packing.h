@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf()
+ * @brief Functions @ref Magnum::Math::pack(), @ref Magnum::Math::unpack(), @ref Magnum::Math::packHalf(), @ref Magnum::Math::unpackHalf(), @ref Magnum::Math::packOctahedral(), @ref Magnum::Math::unpackOctahedral()
  */
 
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
 
 namespace Magnum { namespace Math {
 
@@ -217,6 +218,59 @@ template<std::size_t size> Vector<size, Float> unpackHalf(const Vector<size, Uns
     return out;
 }
 
+/**
+@brief Pack a direction vector into an octahedral representation
+@m_since_latest
+
+Projects the vector onto an octahedron and unfolds its lower half over the
+upper half, resulting in a two-component vector in range @f$ [-1, 1] @f$ with
+a nearly uniform distribution of precision over the whole sphere. The vector
+doesn't need to be normalized, but is expected to be non-zero. The result can
+be further packed into a signed normalized integral type using @ref pack(),
+storing a unit vector in a third of the size of a @ref Magnum::Vector3 "Vector3"
+with better precision than packing the three components directly:
+
+@snippet MagnumMath.cpp packOctahedral
+
+Algorithm used: *Zina H. Cigolle, Sam Donow, Daniel Evangelakos, Michael Mara,
+Morgan McGuire, Quirin Meyer -- A Survey of Efficient Representations for
+Independent Unit Vectors, Journal of Computer Graphics Techniques, 2014*,
+http://jcgt.org/published/0003/02/01/
+@see @ref unpackOctahedral(), @ref packOctahedralInto()
+*/
+template<class FloatingPoint> Vector2<FloatingPoint> packOctahedral(const Vector3<FloatingPoint>& vector) {
+    static_assert(std::is_floating_point<FloatingPoint>::value, "Math::packOctahedral(): only floating-point types are supported");
+    const Vector2<FloatingPoint> projected = vector.xy()/(std::abs(vector.x()) + std::abs(vector.y()) + std::abs(vector.z()));
+    if(vector.z() >= FloatingPoint(0)) return projected;
+
+    /* Fold the lower hemisphere over the diagonals */
+    return {
+        (FloatingPoint(1) - std::abs(projected.y()))*(projected.x() >= FloatingPoint(0) ? FloatingPoint(1) : FloatingPoint(-1)),
+        (FloatingPoint(1) - std::abs(projected.x()))*(projected.y() >= FloatingPoint(0) ? FloatingPoint(1) : FloatingPoint(-1))
+    };
+}
+
+/**
+@brief Unpack a direction vector from an octahedral representation
+@m_since_latest
+
+Inverse to @ref packOctahedral(), the returned vector is normalized. Values
+coming from an integral type have to be unpacked to range @f$ [-1, 1] @f$
+first using @ref unpack(). A GLSL equivalent of this function is used by
+@ref Shaders::Phong with @ref Shaders::Phong::Flag::OctahedralNormals enabled.
+@see @ref unpackOctahedralInto()
+*/
+template<class FloatingPoint> Vector3<FloatingPoint> unpackOctahedral(const Vector2<FloatingPoint>& octahedral) {
+    static_assert(std::is_floating_point<FloatingPoint>::value, "Math::unpackOctahedral(): only floating-point types are supported");
+    Vector3<FloatingPoint> out{octahedral, FloatingPoint(1) - std::abs(octahedral.x()) - std::abs(octahedral.y())};
+
+    /* Unfold the lower hemisphere back */
+    const FloatingPoint t = Math::max(-out.z(), FloatingPoint(0));
+    out.x() += out.x() >= FloatingPoint(0) ? -t : t;
+    out.y() += out.y() >= FloatingPoint(0) ? -t : t;
+    return out.normalized();
+}
+
 /* Since 1.8.17, the original short-hand group closing doesn't work anymore.
    FFS. */
 /**
@@ -22,96 +22,510 @@
     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
     DEALINGS IN THE SOFTWARE.
 */
-
 #include "PackingBatch.h"
 
+#include <cstring>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Math/Packing.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
 #include "Magnum/Math/Implementation/halfTables.hpp"
 
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
 namespace Magnum { namespace Math {
 
 namespace {
 
-template<class T> inline void unpackUnsignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
-        "Math::unpackInto(): second view dimension is not contiguous", );
+/* All kernels below operate on a contiguous run of `count` values. The
+   runKernel() helper calls them either just once for the whole view, if it's
+   contiguous, or once for each row otherwise. The SIMD variants process as
+   many values as they can and delegate the remainder to the scalar variant,
+   which makes them produce the exact same output as the scalar code. */
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+namespace Scalar {
 
-    /* Caching values to avoid inline function calls in ebug builds */
+template<class T> void unpack(const T* src, Float* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
     constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = *srcPtrI++/bitMax;
+    for(std::size_t i = 0; i != count; ++i) {
+        const Float value = src[i]/bitMax;
+        /* Avoiding a max() call in Debug */
+        dst[i] = std::is_signed<T>::value && value < -1.0f ? -1.0f : value;
+    }
+}
 
-        srcPtr += srcStride;
-        dstPtr += dstStride;
+template<class T> void pack(const Float* src, T* dst, const std::size_t count) {
+    /* Caching values to avoid inline function calls in debug builds */
+    constexpr Float bitMax = Implementation::bitMax<T>();
+    for(std::size_t i = 0; i != count; ++i)
+        /** @todo provide a version that doesn't do rounding */
+        dst[i] = T(std::round(src[i]*bitMax));
+}
+
+template<class T, class U> void cast(const T* src, U* dst, const std::size_t count) {
+    for(std::size_t i = 0; i != count; ++i)
+        dst[i] = U(src[i]);
+}
+
+}
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+/* Loading four values and widening them to 32-bit lanes */
+inline __m128i load(const UnsignedByte* src) {
+    Int a;
+    std::memcpy(&a, src, 4);
+    const __m128i zero = _mm_setzero_si128();
+    return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(a), zero), zero);
+}
+inline __m128i load(const Byte* src) {
+    Int a;
+    std::memcpy(&a, src, 4);
+    /* Duplicate each byte into all four bytes of a lane and then shift it
+       back down with sign extension */
+    const __m128i b = _mm_unpacklo_epi8(_mm_cvtsi32_si128(a), _mm_cvtsi32_si128(a));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(b, b), 24);
+}
+inline __m128i load(const UnsignedShort* src) {
+    return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)), _mm_setzero_si128());
+}
+inline __m128i load(const Short* src) {
+    const __m128i a = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+    return _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16);
+}
+inline __m128i load(const UnsignedInt* src) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+inline __m128i load(const Int* src) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+}
+inline __m128 load(const Float* src) {
+    return _mm_loadu_ps(src);
+}
+
+/* Narrowing four 32-bit lanes and storing them. The lanes are sign-extended
+   from the low bits first so the saturating packs keep just the low bits,
+   same as a C++ integer conversion does. */
+inline void storeBytes(void* dst, __m128i a) {
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 24), 24);
+    a = _mm_packs_epi32(a, a);
+    a = _mm_packs_epi16(a, a);
+    const Int b = _mm_cvtsi128_si32(a);
+    std::memcpy(dst, &b, 4);
+}
+inline void storeShorts(void* dst, __m128i a) {
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    _mm_storel_epi64(static_cast<__m128i*>(dst), _mm_packs_epi32(a, a));
+}
+inline void store(UnsignedByte* dst, const __m128i a) { storeBytes(dst, a); }
+inline void store(Byte* dst, const __m128i a) { storeBytes(dst, a); }
+inline void store(UnsignedShort* dst, const __m128i a) { storeShorts(dst, a); }
+inline void store(Short* dst, const __m128i a) { storeShorts(dst, a); }
+inline void store(UnsignedInt* dst, const __m128i a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+}
+inline void store(Int* dst, const __m128i a) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), a);
+}
+inline void store(Float* dst, const __m128 a) {
+    _mm_storeu_ps(dst, a);
+}
+
+template<class T> inline __m128 toFloat(const __m128i a) {
+    return _mm_cvtepi32_ps(a);
+}
+template<> inline __m128 toFloat<UnsignedInt>(const __m128i a) {
+    /* There's no unsigned conversion, so convert the top and bottom 16 bits
+       separately. Both conversions and the multiplication are exact, the
+       final addition rounds just once, same as the scalar conversion. */
+    const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(a, 16));
+    const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(a, _mm_set1_epi32(0xffff)));
+    return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.0f)), lo);
+}
+
+template<class T> inline __m128i fromFloat(const __m128 a) {
+    return _mm_cvttps_epi32(a);
+}
+template<> inline __m128i fromFloat<UnsignedInt>(const __m128 a) {
+    /* Values of 2^31 and above don't fit into a signed integer, convert them
+       with 2^31 subtracted and then flip the top bit back */
+    const __m128 limit = _mm_set1_ps(2147483648.0f);
+    const __m128 big = _mm_cmpge_ps(a, limit);
+    const __m128i b = _mm_cvttps_epi32(_mm_sub_ps(a, _mm_and_ps(big, limit)));
+    return _mm_xor_si128(b, _mm_slli_epi32(_mm_castps_si128(big), 31));
+}
+
+/* Rounding half away from zero, same as std::round(), as opposed to the
+   round-half-to-even done by _mm_cvtps_epi32(). The comparison masks are -1
+   where true, so subtracting the first and adding the second moves the
+   truncated value one away from zero. For values below 2^23 the fractional
+   part is calculated exactly. */
+inline __m128i round(const __m128 a) {
+    const __m128i truncated = _mm_cvttps_epi32(a);
+    const __m128 fraction = _mm_sub_ps(a, _mm_cvtepi32_ps(truncated));
+    return _mm_add_epi32(
+        _mm_sub_epi32(truncated, _mm_castps_si128(_mm_cmpge_ps(fraction, _mm_set1_ps(0.5f)))),
+        _mm_castps_si128(_mm_cmple_ps(fraction, _mm_set1_ps(-0.5f))));
+}
+
+template<class T> void unpack(const T* src, Float* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        __m128 a = _mm_div_ps(_mm_cvtepi32_ps(load(src + i)), bitMax);
+        if(std::is_signed<T>::value) a = _mm_max_ps(a, minusOne);
+        store(dst + i, a);
     }
+    Scalar::unpack(src + i, dst + i, count - i);
 }
 
+template<class T> void pack(const Float* src, T* dst, const std::size_t count) {
+    const __m128 bitMax = _mm_set1_ps(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, round(_mm_mul_ps(load(src + i), bitMax)));
+    Scalar::pack(src + i, dst + i, count - i);
 }
 
-void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+template<class T> void castToFloat(const T* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, toFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
 }
 
-void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackUnsignedIntoImplementation(src, dst);
+template<class T> void castFromFloat(const Float* src, T* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, fromFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
 }
 
-namespace {
+template<class T, class U> void castInteger(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, load(src + i));
+    Scalar::cast(src + i, dst + i, count - i);
+}
 
-template<class T> inline void unpackSignedIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    CORRADE_ASSERT(src.size() == dst.size(),
-        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
-    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
-        "Math::unpackInto(): second view dimension is not contiguous", );
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+/* Exactly the same as the SSE2 variants, just operating on eight values at a
+   time. Every function has to have the target attribute, otherwise the
+   intrinsics can't be inlined into it. */
+namespace Avx2 {
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const UnsignedByte* src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const Byte* src) {
+    return _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const UnsignedShort* src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const Short* src) {
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const UnsignedInt* src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i load(const Int* src) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256 load(const Float* src) {
+    return _mm256_loadu_ps(src);
+}
+
+/* The packs operate within 128-bit lanes, so the two halves get packed
+   together in SSE registers */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void storeBytes(void* dst, __m256i a) {
+    a = _mm256_srai_epi32(_mm256_slli_epi32(a, 24), 24);
+    __m128i b = _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1));
+    b = _mm_packs_epi16(b, b);
+    _mm_storel_epi64(static_cast<__m128i*>(dst), b);
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void storeShorts(void* dst, __m256i a) {
+    a = _mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16);
+    _mm_storeu_si128(static_cast<__m128i*>(dst), _mm_packs_epi32(_mm256_castsi256_si128(a), _mm256_extracti128_si256(a, 1)));
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(UnsignedByte* dst, const __m256i a) { storeBytes(dst, a); }
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(Byte* dst, const __m256i a) { storeBytes(dst, a); }
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(UnsignedShort* dst, const __m256i a) { storeShorts(dst, a); }
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(Short* dst, const __m256i a) { storeShorts(dst, a); }
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(UnsignedInt* dst, const __m256i a) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(Int* dst, const __m256i a) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), a);
+}
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline void store(Float* dst, const __m256 a) {
+    _mm256_storeu_ps(dst, a);
+}
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256 toFloat(const __m256i a) {
+    return _mm256_cvtepi32_ps(a);
+}
+template<> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256 toFloat<UnsignedInt>(const __m256i a) {
+    const __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 16));
+    const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(a, _mm256_set1_epi32(0xffff)));
+    return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.0f)), lo);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i fromFloat(const __m256 a) {
+    return _mm256_cvttps_epi32(a);
+}
+template<> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i fromFloat<UnsignedInt>(const __m256 a) {
+    const __m256 limit = _mm256_set1_ps(2147483648.0f);
+    const __m256 big = _mm256_cmp_ps(a, limit, _CMP_GE_OQ);
+    const __m256i b = _mm256_cvttps_epi32(_mm256_sub_ps(a, _mm256_and_ps(big, limit)));
+    return _mm256_xor_si256(b, _mm256_slli_epi32(_mm256_castps_si256(big), 31));
+}
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 inline __m256i round(const __m256 a) {
+    const __m256i truncated = _mm256_cvttps_epi32(a);
+    const __m256 fraction = _mm256_sub_ps(a, _mm256_cvtepi32_ps(truncated));
+    return _mm256_add_epi32(
+        _mm256_sub_epi32(truncated, _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(0.5f), _CMP_GE_OQ))),
+        _mm256_castps_si256(_mm256_cmp_ps(fraction, _mm256_set1_ps(-0.5f), _CMP_LE_OQ)));
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void unpack(const T* src, Float* dst, const std::size_t count) {
+    const __m256 bitMax = _mm256_set1_ps(Implementation::bitMax<T>());
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        __m256 a = _mm256_div_ps(_mm256_cvtepi32_ps(load(src + i)), bitMax);
+        if(std::is_signed<T>::value) a = _mm256_max_ps(a, minusOne);
+        store(dst + i, a);
+    }
+    Scalar::unpack(src + i, dst + i, count - i);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void pack(const Float* src, T* dst, const std::size_t count) {
+    const __m256 bitMax = _mm256_set1_ps(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        store(dst + i, round(_mm256_mul_ps(load(src + i), bitMax)));
+    Scalar::pack(src + i, dst + i, count - i);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void castToFloat(const T* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        store(dst + i, toFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+template<class T> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void castFromFloat(const Float* src, T* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        store(dst + i, fromFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+template<class T, class U> MAGNUM_MATH_IMPLEMENTATION_TARGET_AVX2 void castInteger(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        store(dst + i, load(src + i));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+/* Loading four values and widening them to 32-bit lanes. The 8-bit loads go
+   through a memcpy() to not read past the end. */
+inline int32x4_t load(const UnsignedByte* src) {
+    UnsignedInt a;
+    std::memcpy(&a, src, 4);
+    return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(a))))));
+}
+inline int32x4_t load(const Byte* src) {
+    UnsignedInt a;
+    std::memcpy(&a, src, 4);
+    return vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_u32(vdup_n_u32(a)))));
+}
+inline int32x4_t load(const UnsignedShort* src) {
+    return vreinterpretq_s32_u32(vmovl_u16(vld1_u16(src)));
+}
+inline int32x4_t load(const Short* src) {
+    return vmovl_s16(vld1_s16(src));
+}
+inline int32x4_t load(const UnsignedInt* src) {
+    return vreinterpretq_s32_u32(vld1q_u32(src));
+}
+inline int32x4_t load(const Int* src) {
+    return vld1q_s32(src);
+}
+inline float32x4_t load(const Float* src) {
+    return vld1q_f32(src);
+}
+
+/* Unlike the SSE packs, the narrowing moves keep just the low bits without
+   saturation, same as a C++ integer conversion does */
+inline void storeBytes(void* dst, const int32x4_t a) {
+    const int16x4_t b = vmovn_s32(a);
+    const Int c = vget_lane_s32(vreinterpret_s32_s8(vmovn_s16(vcombine_s16(b, b))), 0);
+    std::memcpy(dst, &c, 4);
+}
+inline void store(UnsignedByte* dst, const int32x4_t a) { storeBytes(dst, a); }
+inline void store(Byte* dst, const int32x4_t a) { storeBytes(dst, a); }
+inline void store(UnsignedShort* dst, const int32x4_t a) {
+    vst1_u16(dst, vreinterpret_u16_s16(vmovn_s32(a)));
+}
+inline void store(Short* dst, const int32x4_t a) {
+    vst1_s16(dst, vmovn_s32(a));
+}
+inline void store(UnsignedInt* dst, const int32x4_t a) {
+    vst1q_u32(dst, vreinterpretq_u32_s32(a));
+}
+inline void store(Int* dst, const int32x4_t a) {
+    vst1q_s32(dst, a);
+}
+inline void store(Float* dst, const float32x4_t a) {
+    vst1q_f32(dst, a);
+}
+
+template<class T> inline float32x4_t toFloat(const int32x4_t a) {
+    return vcvtq_f32_s32(a);
+}
+template<> inline float32x4_t toFloat<UnsignedInt>(const int32x4_t a) {
+    return vcvtq_f32_u32(vreinterpretq_u32_s32(a));
+}
+
+template<class T> inline int32x4_t fromFloat(const float32x4_t a) {
+    return vcvtq_s32_f32(a);
+}
+template<> inline int32x4_t fromFloat<UnsignedInt>(const float32x4_t a) {
+    return vreinterpretq_s32_u32(vcvtq_u32_f32(a));
+}
+
+template<class T> void unpack(const T* src, Float* dst, const std::size_t count) {
+    const float32x4_t bitMax = vdupq_n_f32(Implementation::bitMax<T>());
+    const float32x4_t minusOne = vdupq_n_f32(-1.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        float32x4_t a = vdivq_f32(vcvtq_f32_s32(load(src + i)), bitMax);
+        if(std::is_signed<T>::value) a = vmaxq_f32(a, minusOne);
+        store(dst + i, a);
+    }
+    Scalar::unpack(src + i, dst + i, count - i);
+}
+
+template<class T> void pack(const Float* src, T* dst, const std::size_t count) {
+    const float32x4_t bitMax = vdupq_n_f32(Implementation::bitMax<T>());
+    std::size_t i = 0;
+    /* vcvtaq rounds half away from zero, same as std::round() */
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, vcvtaq_s32_f32(vmulq_f32(load(src + i), bitMax)));
+    Scalar::pack(src + i, dst + i, count - i);
+}
+
+template<class T> void castToFloat(const T* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, toFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+template<class T> void castFromFloat(const Float* src, T* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, fromFloat<T>(load(src + i)));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+template<class T, class U> void castInteger(const T* src, U* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        store(dst + i, load(src + i));
+    Scalar::cast(src + i, dst + i, count - i);
+}
+
+}
+#endif
+
+/* Picks the best kernel variant available. The SSE2 and NEON variants are
+   chosen at compile time as they're always present on the platforms where
+   they're enabled, on x86 the variant for current cpuTier() is picked from a
+   table at runtime. There's no SSE4.1 or AVX-512 variant, so those tiers use
+   SSE2 and AVX2, respectively. */
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+#define MAGNUM_PACKING_BATCH_KERNEL(name, ...) Implementation::cpuKernel<decltype(&Sse2::name<__VA_ARGS__>)>({Sse2::name<__VA_ARGS__>, nullptr, Avx2::name<__VA_ARGS__>, nullptr})
+#elif defined(CORRADE_TARGET_SSE2)
+#define MAGNUM_PACKING_BATCH_KERNEL(name, ...) Sse2::name<__VA_ARGS__>
+#elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+#define MAGNUM_PACKING_BATCH_KERNEL(name, ...) Neon::name<__VA_ARGS__>
+#else
+#define MAGNUM_PACKING_BATCH_KERNEL(name, ...) Scalar::name<__VA_ARGS__>
+#endif
+
+template<class T, class U> void runKernel(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, void(*const kernel)(const T*, U*, std::size_t)) {
+    /* If both views are contiguous as a whole, process everything in a single
+       run, so the SIMD kernels aren't limited by the (usually tiny) size of
+       the second dimension */
+    if(src.isContiguous() && dst.isContiguous()) {
+        kernel(static_cast<const T*>(src.data()), static_cast<U*>(dst.data()), src.size()[0]*src.size()[1]);
+        return;
+    }
 
     /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
     const char* srcPtr = reinterpret_cast<const char*>(src.data());
     char* dstPtr = reinterpret_cast<char*>(dst.data());
     const std::ptrdiff_t srcStride = src.stride()[0];
     const std::ptrdiff_t dstStride = dst.stride()[0];
     const std::size_t maxJ = src.size()[1];
     for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        Float* dstPtrI = reinterpret_cast<Float*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const Float value = *srcPtrI++/bitMax;
-            /* Avoiding a max() call in Debug */
-            *dstPtrI++ = value < -1.0f ? -1.0f : value;
-        }
+        kernel(reinterpret_cast<const T*>(srcPtr), reinterpret_cast<U*>(dstPtr), maxJ);
 
         srcPtr += srcStride;
         dstPtr += dstStride;
     }
 }
 
+template<class T> inline void unpackIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+    CORRADE_ASSERT(src.template isContiguous<1>() && dst.isContiguous<1>(),
+        "Math::unpackInto(): second view dimension is not contiguous", );
+
+    runKernel(src, dst, MAGNUM_PACKING_BATCH_KERNEL(unpack, T));
+}
+
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    unpackIntoImplementation(src, dst);
+}
+
+void unpackInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
+    unpackIntoImplementation(src, dst);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackIntoImplementation(src, dst);
 }
 
 void unpackInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    unpackSignedIntoImplementation(src, dst);
+    unpackIntoImplementation(src, dst);
 }
 
 namespace {
@@ -122,26 +536,7 @@ template<class T> inline void packIntoImplementation(const Corrade::Containers::
     CORRADE_ASSERT(src.isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::packInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug builds */
-    constexpr Float bitMax = Implementation::bitMax<T>();
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const Float* srcPtrI = reinterpret_cast<const Float*>(srcPtr);
-        T* dstPtrI = reinterpret_cast<T*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            /** @todo provide a version that doesn't do rounding */
-            *dstPtrI++ = std::round(*srcPtrI++*bitMax);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    runKernel(src, dst, MAGNUM_PACKING_BATCH_KERNEL(pack, T));
 }
 
 }
@@ -164,112 +559,95 @@ void packInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, c
 
 namespace {
 
-template<class T, class U> inline void castIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst) {
+template<class T, class U> inline void castIntoImplementation(const Corrade::Containers::StridedArrayView2D<const T>& src, const Corrade::Containers::StridedArrayView2D<U>& dst, void(*const kernel)(const T*, U*, std::size_t)) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::castInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.template isContiguous<1>() && dst.template isContiguous<1>(),
         "Math::castInto(): second view dimension is not contiguous", );
 
-    /** @todo SSE/NEON implementations exploiting second dimension size/stride,
-        contiguity etc */
-
-    /* Caching values to avoid inline function calls in debug buílds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const T* srcPtrI = reinterpret_cast<const T*>(srcPtr);
-        U* dstPtrI = reinterpret_cast<U*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j)
-            *dstPtrI++ = U(*srcPtrI++);
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    runKernel(src, dst, kernel);
 }
 
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, UnsignedByte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, Byte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, UnsignedShort));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, Short));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, UnsignedInt));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castToFloat, Int));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, UnsignedByte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, Byte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, UnsignedShort));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, Short));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, UnsignedInt));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castFromFloat, Int));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedByte>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, UnsignedByte, UnsignedInt));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Byte>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, Byte, Int));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<UnsignedInt>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, UnsignedShort, UnsignedInt));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Short>& src, const Corrade::Containers::StridedArrayView2D<Int>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, Short, Int));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<UnsignedByte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, UnsignedInt, UnsignedByte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Byte>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, Int, Byte));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const UnsignedInt>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, UnsignedInt, UnsignedShort));
 }
 
 void castInto(const Corrade::Containers::StridedArrayView2D<const Int>& src, const Corrade::Containers::StridedArrayView2D<Short>& dst) {
-    castIntoImplementation(src, dst);
+    castIntoImplementation(src, dst, MAGNUM_PACKING_BATCH_KERNEL(castInteger, Int, Short));
 }
 
 static_assert(sizeof(HalfMantissaTable) + sizeof(HalfOffsetTable) + sizeof(HalfExponentTable) == 8576,
@@ -278,29 +656,124 @@ static_assert(sizeof(HalfMantissaTable) + sizeof(HalfOffsetTable) + sizeof(HalfE
 static_assert(sizeof(HalfBaseTable) + sizeof(HalfShiftTable) == 1536,
     "improper size of float->half conversion tables");
 
+namespace {
+
+namespace Scalar {
+
+void unpackHalf(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    UnsignedInt* dstBits = reinterpret_cast<UnsignedInt*>(dst);
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedShort h = src[i];
+        dstBits[i] = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
+    }
+}
+
+void packHalf(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const UnsignedInt* srcBits = reinterpret_cast<const UnsignedInt*>(src);
+    for(std::size_t i = 0; i != count; ++i) {
+        const UnsignedInt f = srcBits[i];
+        dst[i] = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
+    }
+}
+
+}
+
+/* The table-based conversion truncates the mantissa, so the hardware
+   conversions are set up to do the same. Verified to give the same output as
+   the tables for all 2^32 float and 2^16 half values except NaNs. The tables
+   turn NaNs with only the lower 13 mantissa bits set into infinities, while
+   the hardware keeps them NaNs, possibly with a different payload. */
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+namespace F16c {
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C void unpackHalf(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    Scalar::unpackHalf(src + i, dst + i, count - i);
+}
+
+MAGNUM_MATH_IMPLEMENTATION_TARGET_F16C void packHalf(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 overflow = _mm256_set1_ps(65536.0f);
+    const __m128i infinity = _mm_set1_epi16(0x7c00);
+    const __m128i nonSignMask = _mm_set1_epi16(0x7fff);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8) {
+        const __m256 a = _mm256_loadu_ps(src + i);
+        const __m128i h = _mm256_cvtps_ph(a, _MM_FROUND_TO_ZERO);
+
+        /* Rounding towards zero makes values that are too large end up as the
+           largest finite value instead of an infinity. Patch those, keeping
+           the sign. */
+        const __m256 isOverflow = _mm256_cmp_ps(_mm256_and_ps(a, absMask), overflow, _CMP_GE_OQ);
+        const __m128i isOverflow16 = _mm_packs_epi32(
+            _mm_castps_si128(_mm256_castps256_ps128(isOverflow)),
+            _mm_castps_si128(_mm256_extractf128_ps(isOverflow, 1)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(
+            _mm_andnot_si128(_mm_and_si128(isOverflow16, nonSignMask), h),
+            _mm_and_si128(isOverflow16, infinity)));
+    }
+    Scalar::packHalf(src + i, dst + i, count - i);
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+void unpackHalf(const UnsignedShort* src, Float* dst, const std::size_t count) {
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+    Scalar::unpackHalf(src + i, dst + i, count - i);
+}
+
+void packHalf(const Float* src, UnsignedShort* dst, const std::size_t count) {
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    const uint32x4_t truncateMask = vdupq_n_u32(~0x1fffu);
+    const float32x4_t smallestNormal = vdupq_n_f32(6.103515625e-05f);
+    const float32x4_t denormalScale = vdupq_n_f32(16777216.0f);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4) {
+        const uint32x4_t bits = vld1q_u32(reinterpret_cast<const UnsignedInt*>(src + i));
+        const uint32x4_t absBits = vbicq_u32(bits, signMask);
+        const float32x4_t a = vreinterpretq_f32_u32(absBits);
+
+        /* The conversion instruction uses the current rounding mode, which
+           is round-to-nearest by default. Clearing the mantissa bits that
+           don't fit into a half makes it exact for normal numbers, including
+           overflow to infinity. Denormals have the mantissa shifted further,
+           so these are calculated by scaling the value and truncating it to
+           an integer instead. */
+        const uint16x4_t normal = vreinterpret_u16_f16(vcvt_f16_f32(vreinterpretq_f32_u32(vandq_u32(absBits, truncateMask))));
+        const uint16x4_t denormal = vmovn_u32(vcvtq_u32_f32(vmulq_f32(a, denormalScale)));
+        const uint16x4_t h = vbsl_u16(vmovn_u32(vcltq_f32(a, smallestNormal)), denormal, normal);
+        vst1_u16(dst + i, vorr_u16(h, vshrn_n_u32(vandq_u32(bits, signMask), 16)));
+    }
+    Scalar::packHalf(src + i, dst + i, count - i);
+}
+
+}
+#endif
+
+}
+
 void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst) {
     CORRADE_ASSERT(src.size() == dst.size(),
         "Math::unpackHalfInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::unpackHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedShort* srcPtrI = reinterpret_cast<const UnsignedShort*>(srcPtr);
-        UnsignedInt* dstPtrI = reinterpret_cast<UnsignedInt*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedShort h = *srcPtrI++;
-            *dstPtrI++ = HalfMantissaTable[HalfOffsetTable[h >> 10] + (h & 0x3ff)] + HalfExponentTable[h >> 10];
-        }
-
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    runKernel(src, dst, Implementation::cpuFeatures().f16c ? F16c::unpackHalf : Scalar::unpackHalf);
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    runKernel(src, dst, Neon::unpackHalf);
+    #else
+    runKernel(src, dst, Scalar::unpackHalf);
+    #endif
 }
 
 void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& src, const Corrade::Containers::StridedArrayView2D<UnsignedShort>& dst) {
@@ -309,23 +782,65 @@ void packHalfInto(const Corrade::Containers::StridedArrayView2D<const Float>& sr
     CORRADE_ASSERT(src.isContiguous<1>() && dst.isContiguous<1>(),
         "Math::packHalfInto(): second view dimension is not contiguous", );
 
-    /* Caching values to avoid inline function calls in debug builds */
-    const char* srcPtr = reinterpret_cast<const char*>(src.data());
-    char* dstPtr = reinterpret_cast<char*>(dst.data());
-    const std::ptrdiff_t srcStride = src.stride()[0];
-    const std::ptrdiff_t dstStride = dst.stride()[0];
-    const std::size_t maxJ = src.size()[1];
-    for(std::size_t i = 0, maxI = src.size()[0]; i != maxI; ++i) {
-        const UnsignedInt* srcPtrI = reinterpret_cast<const UnsignedInt*>(srcPtr);
-        UnsignedShort* dstPtrI = reinterpret_cast<UnsignedShort*>(dstPtr);
-        for(std::size_t j = 0; j != maxJ; ++j) {
-            const UnsignedInt f = *srcPtrI++;
-            *dstPtrI++ = HalfBaseTable[(f >> 23) & 0x1ff] + ((f & 0x007fffff) >> HalfShiftTable[(f >> 23) & 0x1ff]);
-        }
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    runKernel(src, dst, Implementation::cpuFeatures().f16c ? F16c::packHalf : Scalar::packHalf);
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    runKernel(src, dst, Neon::packHalf);
+    #else
+    runKernel(src, dst, Scalar::packHalf);
+    #endif
+}
 
-        srcPtr += srcStride;
-        dstPtr += dstStride;
-    }
+namespace {
+
+template<class T> inline void packOctahedralIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<T>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packOctahedralInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = pack<Vector2<T>>(packOctahedral(src[i]));
+}
+
+template<class T> inline void unpackOctahedralIntoImplementation(const Corrade::Containers::StridedArrayView1D<const Vector2<T>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackOctahedralInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = unpackOctahedral(unpack<Vector2<Float>>(src[i]));
+}
+
+}
+
+void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Byte>>& dst) {
+    packOctahedralIntoImplementation(src, dst);
+}
+
+void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Short>>& dst) {
+    packOctahedralIntoImplementation(src, dst);
+}
+
+void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::packOctahedralInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = packOctahedral(src[i]);
+}
+
+void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Byte>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    unpackOctahedralIntoImplementation(src, dst);
+}
+
+void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Short>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    unpackOctahedralIntoImplementation(src, dst);
+}
+
+void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::unpackOctahedralInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = unpackOctahedral(src[i]);
 }
 
 }}
@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::castInto()
+ * @brief Functions @ref Magnum::Math::packInto(), @ref Magnum::Math::unpackInto(), @ref Magnum::Math::packHalfInto(), @ref Magnum::Math::unpackHalfInto(), @ref Magnum::Math::castInto(), @ref Magnum::Math::packOctahedralInto(), @ref Magnum::Math::unpackOctahedralInto()
  * @m_since{2020,06}
  */
 
@@ -34,6 +34,7 @@
 
 #include "Magnum/Types.h"
 #include "Magnum/visibility.h"
+#include "Magnum/Math/Math.h"
 
 namespace Magnum { namespace Math {
 
@@ -42,6 +43,15 @@ namespace Magnum { namespace Math {
 
 These functions process an ubounded range of values, as opposed to single
 vectors or scalars.
+
+If both the source and destination views are contiguous as a whole, the data
+are processed in a single run, otherwise each row of the second dimension is
+processed separately. On x86 the functions use SSE2 and, if the CPU supports
+it, AVX2 instructions; on ARM64 NEON instructions are used. Values that don't
+fill the whole SIMD register are processed with scalar code, the output is the
+same in all cases. It's thus advised to pass tightly packed views where
+possible, as the vectorized code can't be used for rows with less than four
+values.
 */
 
 /**
@@ -140,6 +150,14 @@ more suitable for batch conversions of large data amounts. Expects that @p src
 and @p dst have the same size and that the second dimension in both is
 contiguous.
 
+On x86 CPUs with F16C and on ARM64 the conversion is done using hardware
+instructions instead, set up to truncate the mantissa the same way as the
+table-based implementation. The output is the same except for NaNs --- the
+table-based implementation drops the lower 13 mantissa bits, so NaNs that have
+only those bits set become infinities, while the hardware conversion keeps all
+NaNs as NaNs, possibly with a different payload. Same as with @ref packInto(),
+contiguous views are processed in a single run.
+
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
 @see @ref Half
@@ -159,12 +177,71 @@ thus more suitable for batch conversions of large data amounts. Expects that
 @p src and @p dst have the same size and that the second dimension in both is
 contiguous.
 
+On x86 CPUs with F16C and on ARM64 the conversion is done using hardware
+instructions instead, giving the same output except for signaling NaNs, which
+get converted to quiet NaNs.
+
 Algorithm used: *Jeroen van der Zijp -- Fast Half Float Conversions, 2008,
 ftp://ftp.fox-toolkit.org/pub/fasthalffloatconversion.pdf*
 @see @ref Half
 */
 MAGNUM_EXPORT void unpackHalfInto(const Corrade::Containers::StridedArrayView2D<const UnsignedShort>& src, const Corrade::Containers::StridedArrayView2D<Float>& dst);
 
+/**
+@brief Pack direction vectors into an octahedral representation
+@param[in]  src     Source direction vectors
+@param[out] dst     Destination octahedral values
+@m_since_latest
+
+Batch equivalent of calling @ref pack() on the result of
+@ref packOctahedral() for each item, see its documentation for more
+information. Expects that @p src and @p dst have the same size.
+@see @ref unpackOctahedralInto()
+*/
+MAGNUM_EXPORT void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Byte>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Short>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ *
+ * Calls just @ref packOctahedral() for each item, without converting the
+ * result to an integral type.
+ */
+MAGNUM_EXPORT void packOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector2<Float>>& dst);
+
+/**
+@brief Unpack direction vectors from an octahedral representation
+@param[in]  src     Source octahedral values
+@param[out] dst     Destination normalized direction vectors
+@m_since_latest
+
+Batch equivalent of calling @ref unpackOctahedral() on the result of
+@ref unpack() for each item, see its documentation for more information.
+Expects that @p src and @p dst have the same size.
+@see @ref packOctahedralInto()
+*/
+MAGNUM_EXPORT void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Byte>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_EXPORT void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Short>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+ * @overload
+ * @m_since_latest
+ *
+ * Calls just @ref unpackOctahedral() for each item.
+ */
+MAGNUM_EXPORT void unpackOctahedralInto(const Corrade::Containers::StridedArrayView1D<const Vector2<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
 /**
 @brief Cast integer values into a floating-point representation
 @param[in]  src     Source integral values
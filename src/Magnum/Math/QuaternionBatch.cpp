@@ -0,0 +1,478 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QuaternionBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+#if !defined(CORRADE_TARGET_SSE2) && !defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+namespace Scalar {
+
+template<bool shortestPath> void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    for(std::size_t i = 0; i != a.size(); ++i)
+        dst[i] = shortestPath ? slerpShortestPath(a[i], b[i], t[i]) : slerp(a[i], b[i], t[i]);
+}
+
+template<bool shortestPath> void sclerpInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    for(std::size_t i = 0; i != a.size(); ++i)
+        dst[i] = shortestPath ? sclerpShortestPath(a[i], b[i], t[i]) : sclerp(a[i], b[i], t[i]);
+}
+
+template<class T> void normalizeInto(const Corrade::Containers::StridedArrayView1D<const T>& src, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = src[i].normalized();
+}
+
+}
+#else
+namespace Simd {
+
+/* A thin four-lane abstraction over SSE2 and NEON so the fairly involved
+   interpolation math below can be written just once. Four quaternions are
+   processed at a time, transposed to a structure-of-arrays layout. */
+
+#ifdef CORRADE_TARGET_SSE2
+typedef __m128 Float4;
+typedef __m128 Mask4;
+typedef __m128i Int4;
+
+inline Float4 splat(const Float a) { return _mm_set1_ps(a); }
+inline Float4 load(const Float* const a) { return _mm_loadu_ps(a); }
+inline void store(Float* const out, const Float4 a) { _mm_storeu_ps(out, a); }
+inline Float4 add(const Float4 a, const Float4 b) { return _mm_add_ps(a, b); }
+inline Float4 sub(const Float4 a, const Float4 b) { return _mm_sub_ps(a, b); }
+inline Float4 mul(const Float4 a, const Float4 b) { return _mm_mul_ps(a, b); }
+inline Float4 div(const Float4 a, const Float4 b) { return _mm_div_ps(a, b); }
+inline Float4 sqrt(const Float4 a) { return _mm_sqrt_ps(a); }
+inline Float4 min(const Float4 a, const Float4 b) { return _mm_min_ps(a, b); }
+inline Float4 abs(const Float4 a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+inline Float4 neg(const Float4 a) { return _mm_xor_ps(_mm_set1_ps(-0.0f), a); }
+inline Mask4 less(const Float4 a, const Float4 b) { return _mm_cmplt_ps(a, b); }
+inline Mask4 greater(const Float4 a, const Float4 b) { return _mm_cmpgt_ps(a, b); }
+inline Mask4 greaterEqual(const Float4 a, const Float4 b) { return _mm_cmpge_ps(a, b); }
+inline Float4 select(const Mask4 mask, const Float4 a, const Float4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+inline Int4 truncate(const Float4 a) { return _mm_cvttps_epi32(a); }
+inline Float4 toFloat(const Int4 a) { return _mm_cvtepi32_ps(a); }
+inline Int4 addInt(const Int4 a, const Int b) { return _mm_add_epi32(a, _mm_set1_epi32(b)); }
+inline Int4 andInt(const Int4 a, const Int b) { return _mm_and_si128(a, _mm_set1_epi32(b)); }
+inline Mask4 nonZero(const Int4 a) {
+    return _mm_castsi128_ps(_mm_xor_si128(_mm_cmpeq_epi32(a, _mm_setzero_si128()), _mm_set1_epi32(-1)));
+}
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+}
+#else
+typedef float32x4_t Float4;
+typedef uint32x4_t Mask4;
+typedef int32x4_t Int4;
+
+inline Float4 splat(const Float a) { return vdupq_n_f32(a); }
+inline Float4 load(const Float* const a) { return vld1q_f32(a); }
+inline void store(Float* const out, const Float4 a) { vst1q_f32(out, a); }
+inline Float4 add(const Float4 a, const Float4 b) { return vaddq_f32(a, b); }
+inline Float4 sub(const Float4 a, const Float4 b) { return vsubq_f32(a, b); }
+inline Float4 mul(const Float4 a, const Float4 b) { return vmulq_f32(a, b); }
+inline Float4 div(const Float4 a, const Float4 b) { return vdivq_f32(a, b); }
+inline Float4 sqrt(const Float4 a) { return vsqrtq_f32(a); }
+inline Float4 min(const Float4 a, const Float4 b) { return vminq_f32(a, b); }
+inline Float4 abs(const Float4 a) { return vabsq_f32(a); }
+inline Float4 neg(const Float4 a) { return vnegq_f32(a); }
+inline Mask4 less(const Float4 a, const Float4 b) { return vcltq_f32(a, b); }
+inline Mask4 greater(const Float4 a, const Float4 b) { return vcgtq_f32(a, b); }
+inline Mask4 greaterEqual(const Float4 a, const Float4 b) { return vcgeq_f32(a, b); }
+inline Float4 select(const Mask4 mask, const Float4 a, const Float4 b) { return vbslq_f32(mask, a, b); }
+inline Int4 truncate(const Float4 a) { return vcvtq_s32_f32(a); }
+inline Float4 toFloat(const Int4 a) { return vcvtq_f32_s32(a); }
+inline Int4 addInt(const Int4 a, const Int b) { return vaddq_s32(a, vdupq_n_s32(b)); }
+inline Int4 andInt(const Int4 a, const Int b) { return vandq_s32(a, vdupq_n_s32(b)); }
+inline Mask4 nonZero(const Int4 a) { return vtstq_s32(a, a); }
+
+inline void transpose(Float4& a, Float4& b, Float4& c, Float4& d) {
+    const float32x4x2_t ab = vtrnq_f32(a, b);
+    const float32x4x2_t cd = vtrnq_f32(c, d);
+    a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+    b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+    c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+    d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+}
+#endif
+
+/* Polynomial approximations from Cephes, accurate to a few ULPs in the
+   range needed here. Results thus aren't bit-exact with std::sin() and
+   std::acos() but equal within floating-point precision. */
+inline void sincos(Float4 x, Float4& sin, Float4& cos) {
+    const Mask4 negative = less(x, splat(0.0f));
+    x = abs(x);
+
+    /* Reduce to [-π/4, π/4], j is the octant rounded up to an even number */
+    const Int4 j = andInt(addInt(truncate(mul(x, splat(1.27323954473516f))), 1), ~1);
+    const Float4 y = toFloat(j);
+    x = sub(sub(sub(x, mul(y, splat(0.78515625f))), mul(y, splat(2.4187564849853515625e-4f))), mul(y, splat(3.77489497744594108e-8f)));
+
+    const Float4 z = mul(x, x);
+    const Float4 s = add(mul(mul(sub(mul(add(mul(splat(-1.9515295891e-4f), z), splat(8.3321608736e-3f)), z), splat(1.6666654611e-1f)), z), x), x);
+    const Float4 c = add(sub(mul(mul(add(mul(sub(mul(splat(2.443315711809948e-5f), z), splat(1.388731625493765e-3f)), z), splat(4.166664568298827e-2f)), z), z), mul(splat(0.5f), z)), splat(1.0f));
+
+    /* Pick the polynomial and sign based on the quadrant */
+    const Mask4 swap = nonZero(andInt(j, 2));
+    const Float4 sinBase = select(swap, c, s);
+    const Float4 cosBase = select(swap, s, c);
+    sin = select(nonZero(andInt(j, 4)), neg(sinBase), sinBase);
+    sin = select(negative, neg(sin), sin);
+    cos = select(nonZero(andInt(addInt(j, 2), 4)), neg(cosBase), cosBase);
+}
+
+inline Float4 sin(const Float4 x) {
+    Float4 s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+inline Float4 acos(const Float4 x) {
+    const Float4 a = min(abs(x), splat(1.0f));
+
+    /* For |x| > 0.5 acos(x) = 2 asin(sqrt((1 - x)/2)), otherwise it's
+       π/2 - asin(x) */
+    const Mask4 big = greater(a, splat(0.5f));
+    const Float4 z = select(big, mul(splat(0.5f), sub(splat(1.0f), a)), mul(a, a));
+    const Float4 s = select(big, sqrt(z), a);
+    const Float4 asin = add(mul(mul(add(mul(add(mul(add(mul(add(mul(splat(4.2163199048e-2f), z), splat(2.4181311049e-2f)), z), splat(4.5470025998e-2f)), z), splat(7.4953002686e-2f)), z), splat(1.6666752422e-1f)), z), s), s);
+    const Float4 r = select(big, add(asin, asin), sub(splat(1.57079632679489662f), asin));
+    return select(less(x, splat(0.0f)), sub(splat(3.14159265358979324f), r), r);
+}
+
+struct Quaternion4 {
+    Float4 x, y, z, w;
+};
+
+/* Loads four quaternions into a structure-of-arrays layout */
+inline Quaternion4 loadQuaternions(const Float* const* const data, const std::size_t offset) {
+    Quaternion4 out{load(data[0] + offset), load(data[1] + offset), load(data[2] + offset), load(data[3] + offset)};
+    transpose(out.x, out.y, out.z, out.w);
+    return out;
+}
+
+inline void storeQuaternions(Float* const* const data, const std::size_t offset, Quaternion4 q) {
+    transpose(q.x, q.y, q.z, q.w);
+    store(data[0] + offset, q.x);
+    store(data[1] + offset, q.y);
+    store(data[2] + offset, q.z);
+    store(data[3] + offset, q.w);
+}
+
+/* Same operation order as in Math::dot(), Quaternion::operator*() etc. to
+   have the results as close to the scalar code as possible */
+inline Float4 dot(const Quaternion4& a, const Quaternion4& b) {
+    return add(add(add(mul(a.x, b.x), mul(a.y, b.y)), mul(a.z, b.z)), mul(a.w, b.w));
+}
+
+inline Quaternion4 operator+(const Quaternion4& a, const Quaternion4& b) {
+    return {add(a.x, b.x), add(a.y, b.y), add(a.z, b.z), add(a.w, b.w)};
+}
+
+inline Quaternion4 operator-(const Quaternion4& a) {
+    return {neg(a.x), neg(a.y), neg(a.z), neg(a.w)};
+}
+
+inline Quaternion4 operator*(const Float4 a, const Quaternion4& b) {
+    return {mul(a, b.x), mul(a, b.y), mul(a, b.z), mul(a, b.w)};
+}
+
+inline Quaternion4 operator/(const Quaternion4& a, const Float4 b) {
+    return {div(a.x, b), div(a.y, b), div(a.z, b), div(a.w, b)};
+}
+
+inline Quaternion4 operator*(const Quaternion4& a, const Quaternion4& b) {
+    return {
+        add(add(mul(a.w, b.x), mul(b.w, a.x)), sub(mul(a.y, b.z), mul(a.z, b.y))),
+        add(add(mul(a.w, b.y), mul(b.w, a.y)), sub(mul(a.z, b.x), mul(a.x, b.z))),
+        add(add(mul(a.w, b.z), mul(b.w, a.z)), sub(mul(a.x, b.y), mul(a.y, b.x))),
+        sub(mul(a.w, b.w), add(add(mul(a.x, b.x), mul(a.y, b.y)), mul(a.z, b.z)))
+    };
+}
+
+inline Quaternion4 conjugated(const Quaternion4& a) {
+    return {neg(a.x), neg(a.y), neg(a.z), a.w};
+}
+
+inline Quaternion4 select(const Mask4 mask, const Quaternion4& a, const Quaternion4& b) {
+    return {select(mask, a.x, b.x), select(mask, a.y, b.y), select(mask, a.z, b.z), select(mask, a.w, b.w)};
+}
+
+/* Same as Math::slerp() and Math::slerpShortestPath(), including the
+   fallback to a linear interpolation for nearly equal quaternions. Both
+   branches are calculated and the result selected per lane. */
+template<bool shortestPath> void slerp4(const Float* const* const a, const Float* const* const b, const Float* const t, Float* const* const out) {
+    const Quaternion4 qa = loadQuaternions(a, 0);
+    const Quaternion4 qb = loadQuaternions(b, 0);
+    const Float4 t4 = load(t);
+    const Float4 oneMinusT = sub(splat(1.0f), t4);
+
+    const Float4 cosHalfAngle = dot(qa, qb);
+    const Float4 absCosHalfAngle = abs(cosHalfAngle);
+    const Quaternion4 shortestA = select(less(cosHalfAngle, splat(0.0f)), -qa, qa);
+
+    const Quaternion4 linear = oneMinusT*shortestA + t4*qb;
+
+    const Float4 angle = acos(shortestPath ? absCosHalfAngle : cosHalfAngle);
+    const Quaternion4 spherical = (sin(mul(oneMinusT, angle))*(shortestPath ? shortestA : qa) + sin(mul(t4, angle))*qb)/sin(angle);
+
+    const Mask4 useLinear = shortestPath ?
+        greaterEqual(absCosHalfAngle, splat(1.0f - TypeTraits<Float>::epsilon())) :
+        greater(absCosHalfAngle, splat(1.0f - 0.5f*TypeTraits<Float>::epsilon()));
+    storeQuaternions(out, 0, select(useLinear, linear, spherical));
+}
+
+/* Same as Math::sclerp() and Math::sclerpShortestPath() */
+template<bool shortestPath> void sclerp4(const Float* const* const a, const Float* const* const b, const Float* const t, Float* const* const out) {
+    const Quaternion4 aReal = loadQuaternions(a, 0);
+    const Quaternion4 aDual = loadQuaternions(a, 4);
+    Quaternion4 bReal = loadQuaternions(b, 0);
+    Quaternion4 bDual = loadQuaternions(b, 4);
+    const Float4 t4 = load(t);
+
+    const Float4 cosHalfAngle = dot(aReal, bReal);
+
+    /* Nearly equal rotations, interpolate just the translation part. That's
+       translation(lerp(a.translation(), b.translation(), t))*a.real(), the
+       translation being 2*(dual*real^*)_V, which gets halved again. */
+    const Quaternion4 aTranslation = aDual*conjugated(aReal);
+    const Quaternion4 bTranslation = bDual*conjugated(bReal);
+    const Float4 two = splat(2.0f);
+    const Float4 oneMinusT = sub(splat(1.0f), t4);
+    Quaternion4 halfTranslation = oneMinusT*Quaternion4{mul(aTranslation.x, two), mul(aTranslation.y, two), mul(aTranslation.z, two), splat(0.0f)} + t4*Quaternion4{mul(bTranslation.x, two), mul(bTranslation.y, two), mul(bTranslation.z, two), splat(0.0f)};
+    halfTranslation = splat(0.5f)*halfTranslation;
+    const Quaternion4 linearDual = halfTranslation*aReal;
+
+    /* l + εm = q_A^* q_B, negating q_B ensures shortest path */
+    if(shortestPath) {
+        const Mask4 negative = less(cosHalfAngle, splat(0.0f));
+        bReal = select(negative, -bReal, bReal);
+        bDual = select(negative, -bDual, bDual);
+    }
+    const Quaternion4 aRealConjugated = conjugated(aReal);
+    const Quaternion4 l = aRealConjugated*bReal;
+    const Quaternion4 m = aRealConjugated*bDual + conjugated(aDual)*bReal;
+
+    /* a/2 = acos(l_S) - εm_S/|l_V| */
+    const Float4 invr = div(splat(1.0f), sqrt(add(add(mul(l.x, l.x), mul(l.y, l.y)), mul(l.z, l.z))));
+    const Float4 aHalfReal = acos(l.w);
+    const Float4 aHalfDual = mul(neg(m.w), invr);
+
+    /* direction = n_0 = l_V/|l_V|
+       moment = n_ε = (m_V - n_0*(a_ε/2)*l_S)/|l_V| */
+    const Float4 directionX = mul(l.x, invr);
+    const Float4 directionY = mul(l.y, invr);
+    const Float4 directionZ = mul(l.z, invr);
+    const Float4 momentFactor = mul(aHalfDual, l.w);
+    const Float4 momentX = mul(sub(m.x, mul(directionX, momentFactor)), invr);
+    const Float4 momentY = mul(sub(m.y, mul(directionY, momentFactor)), invr);
+    const Float4 momentZ = mul(sub(m.z, mul(directionZ, momentFactor)), invr);
+
+    /* q_ScLERP = q_A*(cos(t*a/2) + n*sin(t*a/2)), with sin(a + εb) =
+       sin(a) + εb cos(a) and cos(a + εb) = cos(a) - εb sin(a) */
+    const Float4 angleReal = mul(t4, aHalfReal);
+    const Float4 angleDual = mul(t4, aHalfDual);
+    Float4 sinReal, cosReal;
+    sincos(angleReal, sinReal, cosReal);
+    const Float4 sinDual = mul(angleDual, cosReal);
+    const Float4 cosDual = neg(mul(angleDual, sinReal));
+    const Quaternion4 powReal{mul(directionX, sinReal), mul(directionY, sinReal), mul(directionZ, sinReal), cosReal};
+    const Quaternion4 powDual{
+        add(mul(directionX, sinDual), mul(momentX, sinReal)),
+        add(mul(directionY, sinDual), mul(momentY, sinReal)),
+        add(mul(directionZ, sinDual), mul(momentZ, sinReal)),
+        cosDual};
+    const Quaternion4 screwReal = aReal*powReal;
+    const Quaternion4 screwDual = aReal*powDual + aDual*powReal;
+
+    const Mask4 useLinear = greaterEqual(abs(cosHalfAngle), splat(1.0f - TypeTraits<Float>::epsilon()));
+    storeQuaternions(out, 0, select(useLinear, aReal, screwReal));
+    storeQuaternions(out, 4, select(useLinear, linearDual, screwDual));
+}
+
+/* Same as Quaternion::normalized() */
+void normalize4(const Float* const* const src, Float* const* const out) {
+    const Quaternion4 q = loadQuaternions(src, 0);
+    storeQuaternions(out, 0, q/sqrt(dot(q, q)));
+}
+
+/* Same as DualQuaternion::normalized(), i.e. a division by a dual length
+   sqrt(|q_0|^2 + ε 2 q_0 q_ε) */
+void normalizeDual4(const Float* const* const src, Float* const* const out) {
+    const Quaternion4 real = loadQuaternions(src, 0);
+    const Quaternion4 dual = loadQuaternions(src, 4);
+    const Float4 lengthReal = sqrt(dot(real, real));
+    const Float4 lengthDual = div(mul(splat(2.0f), dot(real, dual)), mul(splat(2.0f), lengthReal));
+
+    /* (a + εb)/(c + εd) = a/c + ε(bc - ad)/c^2 */
+    const Float4 lengthRealSquared = mul(lengthReal, lengthReal);
+    const Quaternion4 dualOut{
+        div(sub(mul(dual.x, lengthReal), mul(real.x, lengthDual)), lengthRealSquared),
+        div(sub(mul(dual.y, lengthReal), mul(real.y, lengthDual)), lengthRealSquared),
+        div(sub(mul(dual.z, lengthReal), mul(real.z, lengthDual)), lengthRealSquared),
+        div(sub(mul(dual.w, lengthReal), mul(real.w, lengthDual)), lengthRealSquared)};
+    storeQuaternions(out, 0, real/lengthReal);
+    storeQuaternions(out, 4, dualOut);
+}
+
+/* Four items are processed at a time, loaded from wherever the views point
+   to, so the same code handles contiguous and strided views. The remainder
+   is copied to a temporary padded with identities. */
+template<class T, void(*kernel)(const Float* const*, const Float* const*, const Float*, Float* const*)> void interpolateInto(const Corrade::Containers::StridedArrayView1D<const T>& a, const Corrade::Containers::StridedArrayView1D<const T>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    std::size_t i = 0;
+    for(; i + 4 <= a.size(); i += 4) {
+        const Float* const aData[]{a[i].data(), a[i + 1].data(), a[i + 2].data(), a[i + 3].data()};
+        const Float* const bData[]{b[i].data(), b[i + 1].data(), b[i + 2].data(), b[i + 3].data()};
+        const Float tData[]{t[i], t[i + 1], t[i + 2], t[i + 3]};
+        Float* const dstData[]{dst[i].data(), dst[i + 1].data(), dst[i + 2].data(), dst[i + 3].data()};
+        kernel(aData, bData, tData, dstData);
+    }
+
+    if(i != a.size()) {
+        const std::size_t count = a.size() - i;
+        T aTail[4], bTail[4], dstTail[4];
+        Float tTail[4]{};
+        for(std::size_t j = 0; j != count; ++j) {
+            aTail[j] = a[i + j];
+            bTail[j] = b[i + j];
+            tTail[j] = t[i + j];
+        }
+        const Float* const aData[]{aTail[0].data(), aTail[1].data(), aTail[2].data(), aTail[3].data()};
+        const Float* const bData[]{bTail[0].data(), bTail[1].data(), bTail[2].data(), bTail[3].data()};
+        Float* const dstData[]{dstTail[0].data(), dstTail[1].data(), dstTail[2].data(), dstTail[3].data()};
+        kernel(aData, bData, tTail, dstData);
+        for(std::size_t j = 0; j != count; ++j)
+            dst[i + j] = dstTail[j];
+    }
+}
+
+template<bool shortestPath> void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    interpolateInto<Quaternion<Float>, slerp4<shortestPath>>(a, b, t, dst);
+}
+
+template<bool shortestPath> void sclerpInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    interpolateInto<DualQuaternion<Float>, sclerp4<shortestPath>>(a, b, t, dst);
+}
+
+template<class T, void(*kernel)(const Float* const*, Float* const*)> void normalizeInto(const Corrade::Containers::StridedArrayView1D<const T>& src, const Corrade::Containers::StridedArrayView1D<T>& dst) {
+    std::size_t i = 0;
+    for(; i + 4 <= src.size(); i += 4) {
+        const Float* const srcData[]{src[i].data(), src[i + 1].data(), src[i + 2].data(), src[i + 3].data()};
+        Float* const dstData[]{dst[i].data(), dst[i + 1].data(), dst[i + 2].data(), dst[i + 3].data()};
+        kernel(srcData, dstData);
+    }
+
+    if(i != src.size()) {
+        const std::size_t count = src.size() - i;
+        T srcTail[4], dstTail[4];
+        for(std::size_t j = 0; j != count; ++j)
+            srcTail[j] = src[i + j];
+        const Float* const srcData[]{srcTail[0].data(), srcTail[1].data(), srcTail[2].data(), srcTail[3].data()};
+        Float* const dstData[]{dstTail[0].data(), dstTail[1].data(), dstTail[2].data(), dstTail[3].data()};
+        kernel(srcData, dstData);
+        for(std::size_t j = 0; j != count; ++j)
+            dst[i + j] = dstTail[j];
+    }
+}
+
+void normalizeInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    normalizeInto<Quaternion<Float>, normalize4>(src, dst);
+}
+
+void normalizeInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    normalizeInto<DualQuaternion<Float>, normalizeDual4>(src, dst);
+}
+
+}
+#endif
+
+#if !defined(CORRADE_TARGET_SSE2) && !defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+namespace Simd = Scalar;
+#endif
+
+}
+
+void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && dst.size() == a.size(),
+        "Math::slerpInto(): expected all views to have" << a.size() << "items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << dst.size(), );
+
+    Simd::slerpInto<false>(a, b, t, dst);
+}
+
+void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && dst.size() == a.size(),
+        "Math::slerpShortestPathInto(): expected all views to have" << a.size() << "items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << dst.size(), );
+
+    Simd::slerpInto<true>(a, b, t, dst);
+}
+
+void sclerpInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && dst.size() == a.size(),
+        "Math::sclerpInto(): expected all views to have" << a.size() << "items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << dst.size(), );
+
+    Simd::sclerpInto<false>(a, b, t, dst);
+}
+
+void sclerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    CORRADE_ASSERT(b.size() == a.size() && t.size() == a.size() && dst.size() == a.size(),
+        "Math::sclerpShortestPathInto(): expected all views to have" << a.size() << "items but got" << b.size() << Corrade::Utility::Debug::nospace << "," << t.size() << "and" << dst.size(), );
+
+    Simd::sclerpInto<true>(a, b, t, dst);
+}
+
+void normalizeInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::normalizeInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::normalizeInto(src, dst);
+}
+
+void normalizeInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::normalizeInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::normalizeInto(src, dst);
+}
+
+}}
@@ -0,0 +1,153 @@
+#ifndef Magnum_Math_QuaternionBatch_h
+#define Magnum_Math_QuaternionBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::slerpInto(), @ref Magnum::Math::slerpShortestPathInto(), @ref Magnum::Math::sclerpInto(), @ref Magnum::Math::sclerpShortestPathInto(), @ref Magnum::Math::normalizeInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch quaternion functions
+
+These functions interpolate or normalize an unbounded range of quaternions and
+dual quaternions, as opposed to @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T) "slerp()",
+@ref sclerp() or @ref Quaternion::normalized() operating on a single value.
+Useful for example for evaluating a skeletal animation for many instances at
+once, which is what @ref Animation::interpolateInto() does for the builtin
+quaternion interpolators.
+
+The destination view is allowed to be the same as one of the source views, in
+which case the operation is done in-place, but it shouldn't partially overlap.
+On x86 the functions use SSE2 instructions, on ARM64 NEON instructions,
+processing four values at a time in a structure-of-arrays layout, and falling
+back to the per-value functions elsewhere. Normalization is done in the same
+order as in the scalar code, so the output matches
+@ref Quaternion::normalized() and @ref DualQuaternion::normalized(). The
+interpolation uses polynomial approximations of the trigonometric functions
+and is thus equal to the per-value functions only within floating-point
+precision.
+
+Unlike the per-value functions, the interpolation functions don't check that
+the inputs are normalized. To interpolate with the same phase for all items,
+pass a view with a zero stride as the phase.
+*/
+
+/**
+@brief Spherical linear interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] dst     Destination quaternions
+@m_since_latest
+
+Equivalent to calling @ref slerp(const Quaternion<T>&, const Quaternion<T>&, T) "slerp()"
+on each item of @p a, @p b and @p t. Expects that all views have the same
+size.
+@see @ref slerpShortestPathInto()
+*/
+MAGNUM_EXPORT void slerpInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+@brief Spherical linear shortest-path interpolation of quaternions
+@param[in]  a       First quaternions
+@param[in]  b       Second quaternions
+@param[in]  t       Interpolation phases
+@param[out] dst     Destination quaternions
+@m_since_latest
+
+Equivalent to calling @ref slerpShortestPath(const Quaternion<T>&, const Quaternion<T>&, T) "slerpShortestPath()"
+on each item of @p a, @p b and @p t. Expects that all views have the same
+size.
+@see @ref slerpInto()
+*/
+MAGNUM_EXPORT void slerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+@brief Screw linear interpolation of dual quaternions
+@param[in]  a       First dual quaternions
+@param[in]  b       Second dual quaternions
+@param[in]  t       Interpolation phases
+@param[out] dst     Destination dual quaternions
+@m_since_latest
+
+Equivalent to calling @ref sclerp() on each item of @p a, @p b and @p t.
+Expects that all views have the same size.
+@see @ref sclerpShortestPathInto()
+*/
+MAGNUM_EXPORT void sclerpInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst);
+
+/**
+@brief Screw linear shortest-path interpolation of dual quaternions
+@param[in]  a       First dual quaternions
+@param[in]  b       Second dual quaternions
+@param[in]  t       Interpolation phases
+@param[out] dst     Destination dual quaternions
+@m_since_latest
+
+Equivalent to calling @ref sclerpShortestPath() on each item of @p a, @p b and
+@p t. Expects that all views have the same size.
+@see @ref sclerpInto()
+*/
+MAGNUM_EXPORT void sclerpShortestPathInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& a, const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& b, const Corrade::Containers::StridedArrayView1D<const Float>& t, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst);
+
+/**
+@brief Normalize quaternions
+@param[in]  src     Source quaternions
+@param[out] dst     Destination quaternions
+@m_since_latest
+
+Equivalent to calling @ref Quaternion::normalized() on each item of @p src.
+Expects that @p src and @p dst have the same size.
+*/
+MAGNUM_EXPORT void normalizeInto(const Corrade::Containers::StridedArrayView1D<const Quaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<Quaternion<Float>>& dst);
+
+/**
+@brief Normalize dual quaternions
+@param[in]  src     Source dual quaternions
+@param[out] dst     Destination dual quaternions
+@m_since_latest
+
+Equivalent to calling @ref DualQuaternion::normalized() on each item of
+@p src. Expects that @p src and @p dst have the same size.
+*/
+MAGNUM_EXPORT void normalizeInto(const Corrade::Containers::StridedArrayView1D<const DualQuaternion<Float>>& src, const Corrade::Containers::StridedArrayView1D<DualQuaternion<Float>>& dst);
+
+/**
+@}
+*/
+
+}}
+
+#endif
@@ -0,0 +1,203 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Cpu.h"
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct CpuTest: Corrade::TestSuite::Tester {
+    explicit CpuTest();
+
+    void debugTier();
+
+    void detected();
+    void setTier();
+    void setTierName();
+    void setTierNameInvalid();
+    void setTierInvalid();
+
+    void kernelsConsistent();
+};
+
+using Corrade::Utility::Debug;
+using Corrade::Utility::Error;
+using Corrade::Utility::Warning;
+
+CpuTest::CpuTest() {
+    addTests({&CpuTest::debugTier,
+
+              &CpuTest::detected,
+              &CpuTest::setTier,
+              &CpuTest::setTierName,
+              &CpuTest::setTierNameInvalid,
+              &CpuTest::setTierInvalid,
+
+              &CpuTest::kernelsConsistent});
+}
+
+void CpuTest::debugTier() {
+    std::ostringstream out;
+
+    Debug{&out} << CpuTier::Avx2 << CpuTier(0xde);
+    CORRADE_COMPARE(out.str(), "Math::CpuTier::Avx2 Math::CpuTier(0xde)\n");
+}
+
+void CpuTest::detected() {
+    const CpuTier detected = detectedCpuTier();
+    Debug{} << "Detected" << detected << Debug::nospace << ", using" << cpuTier();
+
+    CORRADE_VERIFY(detected >= Implementation::BaselineCpuTier);
+    CORRADE_VERIFY(cpuTier() >= Implementation::BaselineCpuTier);
+    CORRADE_VERIFY(cpuTier() <= detected);
+    #ifndef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    CORRADE_COMPARE(detected, Implementation::BaselineCpuTier);
+    #endif
+}
+
+void CpuTest::setTier() {
+    const CpuTier previous = cpuTier();
+
+    for(UnsignedByte i = UnsignedByte(Implementation::BaselineCpuTier); i <= UnsignedByte(detectedCpuTier()); ++i) {
+        CORRADE_ITERATION(CpuTier(i));
+        setCpuTier(CpuTier(i));
+        CORRADE_COMPARE(cpuTier(), CpuTier(i));
+        #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+        CORRADE_COMPARE(Implementation::cpuFeatures().avx2, CpuTier(i) >= CpuTier::Avx2);
+        CORRADE_COMPARE(Implementation::cpuFeatures().avx512, CpuTier(i) >= CpuTier::Avx512);
+        #endif
+    }
+
+    setCpuTier(previous);
+    CORRADE_COMPARE(cpuTier(), previous);
+}
+
+void CpuTest::setTierName() {
+    const CpuTier previous = cpuTier();
+
+    #ifdef CORRADE_TARGET_SSE2
+    const char* name = "sse2";
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    const char* name = "neon";
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_SIMD128)
+    const char* name = "simd128";
+    #else
+    const char* name = "scalar";
+    #endif
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(Implementation::setCpuTier(name, "Test:"));
+    }
+    CORRADE_COMPARE(cpuTier(), Implementation::BaselineCpuTier);
+    CORRADE_COMPARE(out.str(), "");
+
+    setCpuTier(previous);
+}
+
+void CpuTest::setTierNameInvalid() {
+    const CpuTier previous = cpuTier();
+
+    #ifndef CORRADE_TARGET_ARM
+    const CpuTier unsupported = CpuTier::Neon;
+    const char* unsupportedName = "neon";
+    #else
+    const CpuTier unsupported = CpuTier::Avx2;
+    const char* unsupportedName = "avx2";
+    #endif
+
+    std::ostringstream out;
+    {
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(!Implementation::setCpuTier("avx1024", "Test:"));
+        CORRADE_VERIFY(!Implementation::setCpuTier("AVX2", "Test:"));
+        CORRADE_VERIFY(!Implementation::setCpuTier(unsupportedName, "Test:"));
+    }
+    CORRADE_COMPARE(cpuTier(), previous);
+
+    std::ostringstream expected;
+    Debug{&expected} << "Test:" << unsupported << "is not supported on this machine, using" << previous;
+    CORRADE_COMPARE(out.str(),
+        "Test: unknown CPU tier avx1024, ignoring\n"
+        "Test: unknown CPU tier AVX2, ignoring\n" + expected.str());
+}
+
+void CpuTest::setTierInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const CpuTier previous = cpuTier();
+    const CpuTier invalid = Implementation::BaselineCpuTier == CpuTier::Scalar ? CpuTier::Avx512 : CpuTier::Scalar;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    setCpuTier(invalid);
+    CORRADE_COMPARE(cpuTier(), previous);
+
+    std::ostringstream expected;
+    Debug{&expected} << "Math::setCpuTier():" << invalid << "not supported, expected a tier between" << Implementation::BaselineCpuTier << "and" << detectedCpuTier();
+    CORRADE_COMPARE(out.str(), expected.str());
+}
+
+void CpuTest::kernelsConsistent() {
+    const CpuTier previous = cpuTier();
+
+    /* Odd size to exercise the remainder handling in the SIMD kernels */
+    UnsignedShort packed[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(packed); ++i)
+        packed[i] = UnsignedShort(i*1783);
+    Float expected[Corrade::Containers::arraySize(packed)];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(packed); ++i)
+        expected[i] = unpack<Float>(packed[i]);
+
+    for(UnsignedByte i = UnsignedByte(Implementation::BaselineCpuTier); i <= UnsignedByte(detectedCpuTier()); ++i) {
+        CORRADE_ITERATION(CpuTier(i));
+        setCpuTier(CpuTier(i));
+
+        Float unpacked[Corrade::Containers::arraySize(packed)];
+        unpackInto(
+            Corrade::Containers::StridedArrayView2D<const UnsignedShort>{packed, {Corrade::Containers::arraySize(packed), 1}},
+            Corrade::Containers::StridedArrayView2D<Float>{unpacked, {Corrade::Containers::arraySize(packed), 1}});
+        CORRADE_COMPARE_AS(Corrade::Containers::arrayView(unpacked),
+            Corrade::Containers::arrayView(expected),
+            Corrade::TestSuite::Compare::Container);
+    }
+
+    setCpuTier(previous);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::CpuTest)
@@ -23,12 +23,17 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <vector>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/FunctionsBatch.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Vector4.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -44,6 +49,20 @@ struct FunctionsBatchTest: Corrade::TestSuite::Tester {
 
     void nanIgnoring();
     void nanIgnoringVector();
+
+    template<class T> void minmaxLarge();
+    void minmaxLargeStrided();
+    void minmaxLargeNan();
+
+    void sqrtFastInto();
+    void sqrtInvertedFastInto();
+    void trigonometricFastInto();
+    void expFastInto();
+    void atan2FastInto();
+    void fastIntoStrided();
+    void fastIntoInPlace();
+    void fastIntoEmpty();
+    void fastIntoAssertions();
 };
 
 using namespace Literals;
@@ -52,6 +71,7 @@ typedef Math::Constants<Float> Constants;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Int> Vector3i;
 typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
 
 FunctionsBatchTest::FunctionsBatchTest() {
     addTests({&FunctionsBatchTest::isInf,
@@ -62,7 +82,24 @@ FunctionsBatchTest::FunctionsBatchTest() {
               &FunctionsBatchTest::minmax,
 
               &FunctionsBatchTest::nanIgnoring,
-              &FunctionsBatchTest::nanIgnoringVector});
+              &FunctionsBatchTest::nanIgnoringVector,
+
+              &FunctionsBatchTest::minmaxLarge<Float>,
+              &FunctionsBatchTest::minmaxLarge<Vector2>,
+              &FunctionsBatchTest::minmaxLarge<Vector3>,
+              &FunctionsBatchTest::minmaxLarge<Vector4>,
+              &FunctionsBatchTest::minmaxLargeStrided,
+              &FunctionsBatchTest::minmaxLargeNan,
+
+              &FunctionsBatchTest::sqrtFastInto,
+              &FunctionsBatchTest::sqrtInvertedFastInto,
+              &FunctionsBatchTest::trigonometricFastInto,
+              &FunctionsBatchTest::expFastInto,
+              &FunctionsBatchTest::atan2FastInto,
+              &FunctionsBatchTest::fastIntoStrided,
+              &FunctionsBatchTest::fastIntoInPlace,
+              &FunctionsBatchTest::fastIntoEmpty,
+              &FunctionsBatchTest::fastIntoAssertions});
 }
 
 void FunctionsBatchTest::isInf() {
@@ -284,6 +321,320 @@ void FunctionsBatchTest::nanIgnoringVector() {
     CORRADE_COMPARE(Math::minmax(allNan).second[1], Constants::nan());
 }
 
+template<class> struct TypeName;
+template<> struct TypeName<Float> { static const char* name() { return "Float"; } };
+template<> struct TypeName<Vector2> { static const char* name() { return "Vector2"; } };
+template<> struct TypeName<Vector3> { static const char* name() { return "Vector3"; } };
+template<> struct TypeName<Vector4> { static const char* name() { return "Vector4"; } };
+
+/* Ranges large enough to go through the SIMD code paths, with a size that's
+   not a multiple of the SIMD width to test the remainder handling as well */
+constexpr std::size_t LargeCount = 101;
+
+Float largeValue(std::size_t i, std::size_t component) {
+    return Float(Int(((i + component*37)*2654435761u) % 1000) - 500)*0.25f;
+}
+
+template<class T> T largeValue(std::size_t i, std::false_type) {
+    T out;
+    for(std::size_t j = 0; j != T::Size; ++j) out[j] = largeValue(i, j);
+    return out;
+}
+
+template<class T> T largeValue(std::size_t i, std::true_type) {
+    return largeValue(i, 0);
+}
+
+template<class T> void FunctionsBatchTest::minmaxLarge() {
+    setTestCaseTemplateName(TypeName<T>::name());
+
+    T data[LargeCount];
+    for(std::size_t i = 0; i != LargeCount; ++i)
+        data[i] = largeValue<T>(i, std::is_same<T, Float>{});
+
+    T expectedMin = data[0], expectedMax = data[0];
+    for(const T& i: data) {
+        expectedMin = Math::min(expectedMin, i);
+        expectedMax = Math::max(expectedMax, i);
+    }
+
+    CORRADE_COMPARE(Math::min(data), expectedMin);
+    CORRADE_COMPARE(Math::max(data), expectedMax);
+    CORRADE_COMPARE(Math::minmax(data), std::make_pair(expectedMin, expectedMax));
+}
+
+void FunctionsBatchTest::minmaxLargeStrided() {
+    struct Vertex {
+        Vector3 position;
+        Vector2 textureCoordinates;
+    } vertices[LargeCount];
+    for(std::size_t i = 0; i != LargeCount; ++i) {
+        vertices[i].position = largeValue<Vector3>(i, std::false_type{});
+        /* These shouldn't affect the result */
+        vertices[i].textureCoordinates = Vector2{Constants::inf(), -Constants::inf()};
+    }
+
+    Vector3 expectedMin = vertices[0].position, expectedMax = vertices[0].position;
+    for(const Vertex& i: vertices) {
+        expectedMin = Math::min(expectedMin, i.position);
+        expectedMax = Math::max(expectedMax, i.position);
+    }
+
+    Corrade::Containers::StridedArrayView1D<const Vector3> positions{vertices, &vertices[0].position, LargeCount, sizeof(Vertex)};
+    CORRADE_COMPARE(Math::min(positions), expectedMin);
+    CORRADE_COMPARE(Math::max(positions), expectedMax);
+    CORRADE_COMPARE(Math::minmax(positions), std::make_pair(expectedMin, expectedMax));
+
+    /* Every other item, in reverse */
+    Corrade::Containers::StridedArrayView1D<const Vector3> reversed = positions.flipped<0>().every(2);
+    expectedMin = reversed[0];
+    expectedMax = reversed[0];
+    for(const Vector3& i: reversed) {
+        expectedMin = Math::min(expectedMin, i);
+        expectedMax = Math::max(expectedMax, i);
+    }
+    CORRADE_COMPARE(Math::minmax(reversed), std::make_pair(expectedMin, expectedMax));
+}
+
+void FunctionsBatchTest::minmaxLargeNan() {
+    /* The first component is NaN in the first few items, the second
+       sporadically and the third everywhere */
+    Vector3 data[LargeCount];
+    for(std::size_t i = 0; i != LargeCount; ++i) {
+        data[i] = largeValue<Vector3>(i, std::false_type{});
+        if(i < 5) data[i].x() = Constants::nan();
+        if(i % 7 == 3) data[i].y() = Constants::nan();
+        data[i].z() = Constants::nan();
+    }
+
+    Vector2 expectedMin{Constants::inf()}, expectedMax{-Constants::inf()};
+    for(const Vector3& i: data) {
+        if(i.x() == i.x()) {
+            expectedMin.x() = Math::min(expectedMin.x(), i.x());
+            expectedMax.x() = Math::max(expectedMax.x(), i.x());
+        }
+        if(i.y() == i.y()) {
+            expectedMin.y() = Math::min(expectedMin.y(), i.y());
+            expectedMax.y() = Math::max(expectedMax.y(), i.y());
+        }
+    }
+
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(data);
+    CORRADE_COMPARE(minmax.first.xy(), expectedMin);
+    CORRADE_COMPARE(minmax.second.xy(), expectedMax);
+    CORRADE_COMPARE(minmax.first.z(), Constants::nan());
+    CORRADE_COMPARE(minmax.second.z(), Constants::nan());
+    CORRADE_COMPARE(Math::min(data).xy(), expectedMin);
+    CORRADE_COMPARE(Math::max(data).xy(), expectedMax);
+}
+
+/* Not a multiple of four to test the remainder handling as well */
+constexpr std::size_t FastCount = 1001;
+
+void FunctionsBatchTest::sqrtFastInto() {
+    Float src[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        src[i] = std::pow(10.0f, -20.0f + 40.0f*i/FastCount);
+    src[0] = 0.0f;
+
+    Float dst[FastCount];
+    Math::sqrtFastInto(src, dst);
+    CORRADE_COMPARE(dst[0], 0.0f);
+
+    Double maxError = 0.0;
+    for(std::size_t i = 1; i != FastCount; ++i) {
+        const Double expected = std::sqrt(Double(src[i]));
+        maxError = Math::max(maxError, std::abs(dst[i] - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsBatchTest::sqrtInvertedFastInto() {
+    Float src[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        src[i] = std::pow(10.0f, -20.0f + 40.0f*(i + 1)/FastCount);
+
+    Float dst[FastCount];
+    Math::sqrtInvertedFastInto(src, dst);
+
+    Double maxError = 0.0;
+    for(std::size_t i = 0; i != FastCount; ++i) {
+        const Double expected = 1.0/std::sqrt(Double(src[i]));
+        maxError = Math::max(maxError, std::abs(dst[i] - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsBatchTest::trigonometricFastInto() {
+    Float src[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        src[i] = -2.0f*Constants::pi() + 4.0f*Constants::pi()*i/FastCount;
+
+    Float sin[FastCount], cos[FastCount], sincosSin[FastCount], sincosCos[FastCount];
+    Math::sinFastInto(src, sin);
+    Math::cosFastInto(src, cos);
+    Math::sincosFastInto(src, sincosSin, sincosCos);
+
+    Double maxError = 0.0;
+    for(std::size_t i = 0; i != FastCount; ++i) {
+        maxError = Math::max(maxError, std::abs(sin[i] - std::sin(Double(src[i]))));
+        maxError = Math::max(maxError, std::abs(cos[i] - std::cos(Double(src[i]))));
+        maxError = Math::max(maxError, std::abs(sincosSin[i] - std::sin(Double(src[i]))));
+        maxError = Math::max(maxError, std::abs(sincosCos[i] - std::cos(Double(src[i]))));
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsBatchTest::expFastInto() {
+    Float src[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        src[i] = -87.0f + 175.0f*i/FastCount;
+
+    Float dst[FastCount];
+    Math::expFastInto(src, dst);
+
+    Double maxError = 0.0;
+    for(std::size_t i = 0; i != FastCount; ++i) {
+        const Double expected = std::exp(Double(src[i]));
+        maxError = Math::max(maxError, std::abs(dst[i] - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 1.0e-5,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsBatchTest::atan2FastInto() {
+    Float y[FastCount], x[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i) {
+        const Float angle = -Constants::pi() + 2.0f*Constants::pi()*i/FastCount;
+        y[i] = 5.0f*std::sin(angle);
+        x[i] = 5.0f*std::cos(angle);
+    }
+    y[0] = x[0] = 0.0f;
+
+    Float dst[FastCount];
+    Math::atan2FastInto(y, x, dst);
+    CORRADE_COMPARE(dst[0], 0.0f);
+
+    Double maxError = 0.0;
+    for(std::size_t i = 1; i != FastCount; ++i)
+        maxError = Math::max(maxError, std::abs(dst[i] - std::atan2(Double(y[i]), Double(x[i]))));
+    CORRADE_COMPARE_AS(maxError, 3.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsBatchTest::fastIntoStrided() {
+    struct Particle {
+        Float value;
+        Float result;
+        Float another;
+    } particles[FastCount];
+    Float src[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        particles[i].value = src[i] = 0.1f + 0.03f*i;
+
+    Corrade::Containers::StridedArrayView1D<const Float> values{particles, &particles[0].value, FastCount, sizeof(Particle)};
+    Corrade::Containers::StridedArrayView1D<Float> results{particles, &particles[0].result, FastCount, sizeof(Particle)};
+    Corrade::Containers::StridedArrayView1D<Float> anothers{particles, &particles[0].another, FastCount, sizeof(Particle)};
+
+    /* Strided output should be the same as contiguous */
+    Float expected[FastCount], expectedAnother[FastCount];
+    Math::sqrtFastInto(src, expected);
+    Math::sqrtFastInto(values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::sqrtInvertedFastInto(src, expected);
+    Math::sqrtInvertedFastInto(values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::sinFastInto(src, expected);
+    Math::sinFastInto(values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::cosFastInto(src, expected);
+    Math::cosFastInto(values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::sincosFastInto(src, expected, expectedAnother);
+    Math::sincosFastInto(values, results, anothers);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(anothers, Corrade::Containers::stridedArrayView(expectedAnother),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::expFastInto(src, expected);
+    Math::expFastInto(values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    Math::atan2FastInto(src, src, expected);
+    Math::atan2FastInto(values, values, results);
+    CORRADE_COMPARE_AS(results, Corrade::Containers::stridedArrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* The untouched member should stay the same */
+    for(std::size_t i = 0; i != FastCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(particles[i].value, src[i]);
+    }
+}
+
+void FunctionsBatchTest::fastIntoInPlace() {
+    Float data[FastCount], expected[FastCount];
+    for(std::size_t i = 0; i != FastCount; ++i)
+        data[i] = 0.1f + 0.03f*i;
+
+    Math::expFastInto(data, expected);
+    Math::expFastInto(data, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void FunctionsBatchTest::fastIntoEmpty() {
+    /* Shouldn't crash or touch anything */
+    Math::sqrtFastInto({}, {});
+    Math::sinFastInto({}, {});
+    Math::sincosFastInto({}, {}, {});
+    Math::atan2FastInto({}, {}, {});
+    CORRADE_VERIFY(true);
+}
+
+void FunctionsBatchTest::fastIntoAssertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Float src[2]{};
+    Float dst[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Math::sqrtFastInto(src, dst);
+    Math::sqrtInvertedFastInto(src, dst);
+    Math::sinFastInto(src, dst);
+    Math::cosFastInto(src, dst);
+    Math::sincosFastInto(src, src, dst);
+    Math::expFastInto(src, dst);
+    Math::atan2FastInto(src, dst, src);
+    Math::atan2FastInto(src, src, dst);
+    CORRADE_COMPARE(out.str(),
+        "Math::sqrtFastInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::sqrtInvertedFastInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::sinFastInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::cosFastInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::sincosFastInto(): wrong destination sizes, got 2 and 3 but expected 2\n"
+        "Math::expFastInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::atan2FastInto(): expected Y and X views to have the same size, got 2 and 3\n"
+        "Math::atan2FastInto(): wrong destination size, got 3 but expected 2\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsBatchTest)
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 
-#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector4.h"
 
 #ifdef CORRADE_TARGET_SSE2
 #include <xmmintrin.h>
@@ -48,6 +51,23 @@ struct FunctionsBenchmark: Corrade::TestSuite::Tester {
 
     void sinCosSeparate();
     void sinCosCombined();
+
+    void minmaxScalarLoop();
+    void minmaxContiguous();
+    void minmaxStrided();
+
+    void sqrtLoop();
+    void sqrtFastLoop();
+    void sqrtFastBatch();
+    void sinLoop();
+    void sinFastLoop();
+    void sinFastBatch();
+    void expLoop();
+    void expFastLoop();
+    void expFastBatch();
+    void atan2Loop();
+    void atan2FastLoop();
+    void atan2FastBatch();
 };
 
 FunctionsBenchmark::FunctionsBenchmark() {
@@ -66,9 +86,28 @@ FunctionsBenchmark::FunctionsBenchmark() {
 
     addBenchmarks({&FunctionsBenchmark::sinCosSeparate,
                    &FunctionsBenchmark::sinCosCombined}, 100);
+
+    addBenchmarks({&FunctionsBenchmark::minmaxScalarLoop,
+                   &FunctionsBenchmark::minmaxContiguous,
+                   &FunctionsBenchmark::minmaxStrided}, 10);
+
+    addBenchmarks({&FunctionsBenchmark::sqrtLoop,
+                   &FunctionsBenchmark::sqrtFastLoop,
+                   &FunctionsBenchmark::sqrtFastBatch,
+                   &FunctionsBenchmark::sinLoop,
+                   &FunctionsBenchmark::sinFastLoop,
+                   &FunctionsBenchmark::sinFastBatch,
+                   &FunctionsBenchmark::expLoop,
+                   &FunctionsBenchmark::expFastLoop,
+                   &FunctionsBenchmark::expFastBatch,
+                   &FunctionsBenchmark::atan2Loop,
+                   &FunctionsBenchmark::atan2FastLoop,
+                   &FunctionsBenchmark::atan2FastBatch}, 10);
 }
 
 typedef Math::Constants<Float> Constants;
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
 typedef Math::Deg<Float> Deg;
 typedef Math::Rad<Float> Rad;
 
@@ -215,6 +254,218 @@ void FunctionsBenchmark::sinCosCombined() {
     CORRADE_COMPARE_AS(a, 10.0f, Corrade::TestSuite::Compare::Greater);
 }
 
+/* A million-vertex mesh. The strided variant takes the XYZ part of a Vector4,
+   which is similar to an interleaved position + something else layout. */
+constexpr std::size_t VertexCount = 1000000;
+
+Corrade::Containers::Array<Vector4> vertexData() {
+    Corrade::Containers::Array<Vector4> out{Corrade::Containers::NoInit, VertexCount};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = Vector4{Float(i % 1013), -Float(i % 733), Float(i % 517)*0.5f, 1.0f};
+    return out;
+}
+
+Corrade::Containers::StridedArrayView1D<const Vector3> contiguous(const Corrade::Containers::Array<Vector4>& data) {
+    return {data, reinterpret_cast<const Vector3*>(data.data()), VertexCount*4/3, sizeof(Vector3)};
+}
+
+Corrade::Containers::StridedArrayView1D<const Vector3> strided(const Corrade::Containers::Array<Vector4>& data) {
+    return {data, reinterpret_cast<const Vector3*>(data.data()), VertexCount, sizeof(Vector4)};
+}
+
+void FunctionsBenchmark::minmaxScalarLoop() {
+    Corrade::Containers::Array<Vector4> data = vertexData();
+    Corrade::Containers::StridedArrayView1D<const Vector3> view = contiguous(data);
+
+    /* Equivalent to what Math::minmax() did before, for comparison */
+    std::pair<Vector3, Vector3> minmax;
+    CORRADE_BENCHMARK(1) {
+        Vector3 min = view[0], max = view[0];
+        for(std::size_t i = 1; i != view.size(); ++i) {
+            min = Math::min(min, view[i]);
+            max = Math::max(max, view[i]);
+        }
+        minmax = {min, max};
+    }
+
+    CORRADE_COMPARE(minmax.first, (Vector3{-732.0f, -732.0f, -732.0f}));
+}
+
+void FunctionsBenchmark::minmaxContiguous() {
+    Corrade::Containers::Array<Vector4> data = vertexData();
+    Corrade::Containers::StridedArrayView1D<const Vector3> view = contiguous(data);
+
+    std::pair<Vector3, Vector3> minmax;
+    CORRADE_BENCHMARK(1) {
+        minmax = Math::minmax(view);
+    }
+
+    CORRADE_COMPARE(minmax.first, (Vector3{-732.0f, -732.0f, -732.0f}));
+}
+
+void FunctionsBenchmark::minmaxStrided() {
+    Corrade::Containers::Array<Vector4> data = vertexData();
+    Corrade::Containers::StridedArrayView1D<const Vector3> view = strided(data);
+
+    std::pair<Vector3, Vector3> minmax;
+    CORRADE_BENCHMARK(1) {
+        minmax = Math::minmax(view);
+    }
+
+    CORRADE_COMPARE(minmax.first, (Vector3{0.0f, -732.0f, 0.0f}));
+}
+
+/* Values in range [0.1, 10] for the libm vs fast approximation comparison,
+   similar to what a particle system would process every frame */
+constexpr std::size_t ValueCount = 100000;
+
+Corrade::Containers::Array<Float> valueData() {
+    Corrade::Containers::Array<Float> out{Corrade::Containers::NoInit, ValueCount};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = 0.1f + 9.9f*Float(i % 1013)/1013.0f;
+    return out;
+}
+
+void FunctionsBenchmark::sqrtLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::sqrt(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sqrt(0.1f));
+}
+
+void FunctionsBenchmark::sqrtFastLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::sqrtFast(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sqrt(0.1f));
+}
+
+void FunctionsBenchmark::sqrtFastBatch() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        Math::sqrtFastInto(src, dst);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sqrt(0.1f));
+}
+
+void FunctionsBenchmark::sinLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::sin(Rad(src[i]));
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sin(Rad(0.1f)));
+}
+
+void FunctionsBenchmark::sinFastLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::sinFast(Rad(src[i]));
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sin(Rad(0.1f)));
+}
+
+void FunctionsBenchmark::sinFastBatch() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        Math::sinFastInto(src, dst);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::sin(Rad(0.1f)));
+}
+
+void FunctionsBenchmark::expLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::exp(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::exp(0.1f));
+}
+
+void FunctionsBenchmark::expFastLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Math::expFast(src[i]);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::exp(0.1f));
+}
+
+void FunctionsBenchmark::expFastBatch() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        Math::expFastInto(src, dst);
+    }
+
+    CORRADE_COMPARE(dst[0], Math::exp(0.1f));
+}
+
+void FunctionsBenchmark::atan2Loop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = std::atan2(src[i], src[ValueCount - i - 1]);
+    }
+
+    CORRADE_COMPARE(dst[0], std::atan2(0.1f, src[ValueCount - 1]));
+}
+
+void FunctionsBenchmark::atan2FastLoop() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != ValueCount; ++i)
+            dst[i] = Float(Math::atan2Fast(src[i], src[ValueCount - i - 1]));
+    }
+
+    CORRADE_COMPARE(dst[0], std::atan2(0.1f, src[ValueCount - 1]));
+}
+
+void FunctionsBenchmark::atan2FastBatch() {
+    Corrade::Containers::Array<Float> src = valueData();
+    Corrade::Containers::Array<Float> dst{Corrade::Containers::NoInit, ValueCount};
+    const Corrade::Containers::StridedArrayView1D<const Float> x = Corrade::Containers::stridedArrayView(src).flipped<0>();
+
+    CORRADE_BENCHMARK(1) {
+        Math::atan2FastInto(src, x, dst);
+    }
+
+    CORRADE_COMPARE(dst[0], std::atan2(0.1f, src[ValueCount - 1]));
+}
 
 }}}}
 
@@ -24,8 +24,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <limits>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Functions.h"
@@ -86,6 +88,15 @@ struct FunctionsTest: Corrade::TestSuite::Tester {
     void trigonometric();
     void trigonometricWithBase();
     template<class T> void sincos();
+
+    void sqrtFast();
+    void sqrtInvertedFast();
+    void normalizedFast();
+    void trigonometricFast();
+    void trigonometricFastLargeAngle();
+    void expFast();
+    void expFastClamped();
+    void atan2Fast();
 };
 
 using namespace Literals;
@@ -157,7 +168,15 @@ FunctionsTest::FunctionsTest() {
               #ifndef CORRADE_TARGET_EMSCRIPTEN
               &FunctionsTest::sincos<long double>,
               #endif
-              });
+
+              &FunctionsTest::sqrtFast,
+              &FunctionsTest::sqrtInvertedFast,
+              &FunctionsTest::normalizedFast,
+              &FunctionsTest::trigonometricFast,
+              &FunctionsTest::trigonometricFastLargeAngle,
+              &FunctionsTest::expFast,
+              &FunctionsTest::expFastClamped,
+              &FunctionsTest::atan2Fast});
 }
 
 template<class T> void FunctionsTest::popcount() {
@@ -615,6 +634,112 @@ template<class T> void FunctionsTest::sincos() {
     CORRADE_COMPARE(Math::sincos(Math::Deg<T>(T(30.0))).second, T(0.866025403784438647l));
 }
 
+void FunctionsTest::sqrtFast() {
+    CORRADE_COMPARE(Math::sqrtFast(16.0f), 4.0f);
+    CORRADE_COMPARE(Math::sqrtFast(0.0f), 0.0f);
+
+    /* Go through many orders of magnitude and check the documented bound */
+    Double maxError = 0.0;
+    for(Float a = 1.0e-30f; a < 1.0e30f; a *= 1.0013f) {
+        const Double expected = std::sqrt(Double(a));
+        maxError = Math::max(maxError, std::abs(Math::sqrtFast(a) - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsTest::sqrtInvertedFast() {
+    CORRADE_COMPARE(Math::sqrtInvertedFast(16.0f), 0.25f);
+
+    Double maxError = 0.0;
+    for(Float a = 1.0e-30f; a < 1.0e30f; a *= 1.0013f) {
+        const Double expected = 1.0/std::sqrt(Double(a));
+        maxError = Math::max(maxError, std::abs(Math::sqrtInvertedFast(a) - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsTest::normalizedFast() {
+    /* The subclass type is preserved */
+    const Vector3 a = Math::normalizedFast(Vector3{3.0f, 0.0f, -4.0f});
+    CORRADE_COMPARE(a, (Vector3{0.6f, 0.0f, -0.8f}));
+    CORRADE_VERIFY(a.isNormalized());
+
+    CORRADE_COMPARE(Math::normalizedFast(Vector2{}), Vector2{});
+}
+
+void FunctionsTest::trigonometricFast() {
+    CORRADE_COMPARE(Math::sinFast(30.0_degf), 0.5f);
+    CORRADE_COMPARE(Math::sinFast(Rad(Constants::pi()/6)), 0.5f);
+    CORRADE_COMPARE(Math::sinFast(2*15.0_degf), 0.5f);
+    CORRADE_COMPARE(Math::cosFast(60.0_degf), 0.5f);
+    CORRADE_COMPARE(Math::cosFast(2*Rad(Constants::pi()/6)), 0.5f);
+    CORRADE_COMPARE(Math::sincosFast(30.0_degf).first, 0.5f);
+    CORRADE_COMPARE(Math::sincosFast(30.0_degf).second, 0.8660254037844386f);
+
+    Double maxError = 0.0;
+    for(Float a = -2.0f*Constants::pi(); a <= 2.0f*Constants::pi(); a += 0.0001f) {
+        const std::pair<Float, Float> sincos = Math::sincosFast(Rad(a));
+        maxError = Math::max(maxError, std::abs(Math::sinFast(Rad(a)) - std::sin(Double(a))));
+        maxError = Math::max(maxError, std::abs(Math::cosFast(Rad(a)) - std::cos(Double(a))));
+        maxError = Math::max(maxError, std::abs(sincos.first - std::sin(Double(a))));
+        maxError = Math::max(maxError, std::abs(sincos.second - std::cos(Double(a))));
+    }
+    CORRADE_COMPARE_AS(maxError, 5.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsTest::trigonometricFastLargeAngle() {
+    Double maxError = 0.0;
+    for(Float a = -100.0f; a <= 100.0f; a += 0.001f) {
+        maxError = Math::max(maxError, std::abs(Math::sinFast(Rad(a)) - std::sin(Double(a))));
+        maxError = Math::max(maxError, std::abs(Math::cosFast(Rad(a)) - std::cos(Double(a))));
+    }
+    CORRADE_COMPARE_AS(maxError, 2.0e-5,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsTest::expFast() {
+    CORRADE_COMPARE(Math::expFast(0.0f), 1.0f);
+    CORRADE_COMPARE(Math::expFast(1.0f), Constants::e());
+
+    Double maxError = 0.0;
+    for(Float a = -87.0f; a <= 88.0f; a += 0.001f) {
+        const Double expected = std::exp(Double(a));
+        maxError = Math::max(maxError, std::abs(Math::expFast(a) - expected)/expected);
+    }
+    CORRADE_COMPARE_AS(maxError, 1.0e-5,
+        Corrade::TestSuite::Compare::Less);
+}
+
+void FunctionsTest::expFastClamped() {
+    /* Never zero, denormal or infinity */
+    CORRADE_COMPARE_AS(Math::expFast(-1000.0f), 0.0f,
+        Corrade::TestSuite::Compare::Greater);
+    CORRADE_VERIFY(Math::expFast(-1000.0f) >= std::numeric_limits<Float>::min());
+    CORRADE_VERIFY(!Math::isInf(Math::expFast(1000.0f)));
+}
+
+void FunctionsTest::atan2Fast() {
+    CORRADE_COMPARE_AS(Math::atan2Fast(1.0f, 1.0f), 45.0_degf, Deg);
+    CORRADE_COMPARE_AS(Math::atan2Fast(1.0f, -1.0f), 135.0_degf, Deg);
+    CORRADE_COMPARE_AS(Math::atan2Fast(-1.0f, -1.0f), -135.0_degf, Deg);
+    CORRADE_COMPARE_AS(Math::atan2Fast(-2.0f, 0.0f), -90.0_degf, Deg);
+    CORRADE_COMPARE(Math::atan2Fast(0.0f, 0.0f), 0.0_radf);
+
+    Double maxError = 0.0;
+    for(Float a = -Constants::pi(); a <= Constants::pi(); a += 0.0001f) {
+        for(Float length: {0.001f, 1.0f, 1000.0f}) {
+            const Float y = length*std::sin(a);
+            const Float x = length*std::cos(a);
+            maxError = Math::max(maxError, std::abs(Float(Math::atan2Fast(y, x)) - std::atan2(Double(y), Double(x))));
+        }
+    }
+    CORRADE_COMPARE_AS(maxError, 3.0e-6,
+        Corrade::TestSuite::Compare::Less);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::FunctionsTest)
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #ifndef CORRADE_NO_ASSERT
@@ -30,6 +32,7 @@
 #endif
 
 #include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -43,6 +46,11 @@ struct InterpolationBenchmark: Corrade::TestSuite::Tester {
     void quaternionSlerpShortestPath();
     void dualQuaternionSclerp();
     void dualQuaternionSclerpShortestPath();
+
+    void quaternionSlerpBatch();
+    void quaternionSlerpShortestPathBatch();
+    void dualQuaternionSclerpBatch();
+    void dualQuaternionSclerpShortestPathBatch();
 };
 
 using namespace Math::Literals;
@@ -59,6 +67,11 @@ InterpolationBenchmark::InterpolationBenchmark() {
                    &InterpolationBenchmark::quaternionSlerpShortestPath,
                    &InterpolationBenchmark::dualQuaternionSclerp,
                    &InterpolationBenchmark::dualQuaternionSclerpShortestPath}, 100);
+
+    addBenchmarks({&InterpolationBenchmark::quaternionSlerpBatch,
+                   &InterpolationBenchmark::quaternionSlerpShortestPathBatch,
+                   &InterpolationBenchmark::dualQuaternionSclerpBatch,
+                   &InterpolationBenchmark::dualQuaternionSclerpShortestPathBatch}, 100);
 }
 
 void InterpolationBenchmark::baseline() {
@@ -150,6 +163,58 @@ void InterpolationBenchmark::dualQuaternionSclerpShortestPath() {
     CORRADE_VERIFY(!c.isNormalized());
 }
 
+/* The batch variants interpolate the whole array in a single call, so the
+   result is for all BatchSize values, not just one as in the above */
+constexpr std::size_t BatchSize = 10000;
+
+void InterpolationBenchmark::quaternionSlerpBatch() {
+    Corrade::Containers::Array<Quaternion> a{Corrade::Containers::DirectInit, BatchSize, Quaternion::rotation(225.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Quaternion> b{Corrade::Containers::DirectInit, BatchSize, Quaternion::rotation(0.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Float> t{Corrade::Containers::NoInit, BatchSize};
+    for(std::size_t i = 0; i != BatchSize; ++i) t[i] = i*0.0002f;
+    Corrade::Containers::Array<Quaternion> c{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(1)
+        slerpInto(a, b, t, c);
+
+    CORRADE_VERIFY(c[BatchSize/2].isNormalized());
+}
+
+void InterpolationBenchmark::quaternionSlerpShortestPathBatch() {
+    Corrade::Containers::Array<Quaternion> a{Corrade::Containers::DirectInit, BatchSize, Quaternion::rotation(225.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Quaternion> b{Corrade::Containers::DirectInit, BatchSize, Quaternion::rotation(0.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Float> t{Corrade::Containers::NoInit, BatchSize};
+    for(std::size_t i = 0; i != BatchSize; ++i) t[i] = i*0.0002f;
+    Corrade::Containers::Array<Quaternion> c{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(1)
+        slerpShortestPathInto(a, b, t, c);
+
+    CORRADE_VERIFY(c[BatchSize/2].isNormalized());
+}
+
+void InterpolationBenchmark::dualQuaternionSclerpBatch() {
+    Corrade::Containers::Array<DualQuaternion> a{Corrade::Containers::DirectInit, BatchSize, DualQuaternion::rotation(225.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<DualQuaternion> b{Corrade::Containers::DirectInit, BatchSize, DualQuaternion::rotation(0.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Float> t{Corrade::Containers::NoInit, BatchSize};
+    for(std::size_t i = 0; i != BatchSize; ++i) t[i] = i*0.0001f;
+    Corrade::Containers::Array<DualQuaternion> c{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(1)
+        sclerpInto(a, b, t, c);
+
+    CORRADE_VERIFY(c[BatchSize/2].isNormalized());
+}
+
+void InterpolationBenchmark::dualQuaternionSclerpShortestPathBatch() {
+    Corrade::Containers::Array<DualQuaternion> a{Corrade::Containers::DirectInit, BatchSize, DualQuaternion::rotation(225.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<DualQuaternion> b{Corrade::Containers::DirectInit, BatchSize, DualQuaternion::rotation(0.0_degf, Vector3::zAxis())};
+    Corrade::Containers::Array<Float> t{Corrade::Containers::NoInit, BatchSize};
+    for(std::size_t i = 0; i != BatchSize; ++i) t[i] = i*0.0001f;
+    Corrade::Containers::Array<DualQuaternion> c{Corrade::Containers::NoInit, BatchSize};
+    CORRADE_BENCHMARK(1)
+        sclerpShortestPathInto(a, b, t, c);
+
+    CORRADE_VERIFY(c[BatchSize/2].isNormalized());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::InterpolationBenchmark)
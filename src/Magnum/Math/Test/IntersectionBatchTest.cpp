@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct IntersectionBatchTest: Corrade::TestSuite::Tester {
+    explicit IntersectionBatchTest();
+
+    void rangeFrustum();
+    void rangeFrustumIndices();
+    void aabbFrustum();
+    void aabbFrustumIndices();
+    void sphereFrustum();
+    void sphereFrustumIndices();
+
+    void assertions();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Frustum<Float> Frustum;
+typedef Math::Range3D<Float> Range3D;
+typedef Math::Deg<Float> Deg;
+
+IntersectionBatchTest::IntersectionBatchTest() {
+    addTests({&IntersectionBatchTest::rangeFrustum,
+              &IntersectionBatchTest::rangeFrustumIndices,
+              &IntersectionBatchTest::aabbFrustum,
+              &IntersectionBatchTest::aabbFrustumIndices,
+              &IntersectionBatchTest::sphereFrustum,
+              &IntersectionBatchTest::sphereFrustumIndices,
+
+              &IntersectionBatchTest::assertions});
+}
+
+/* Not a multiple of four so both the SIMD code and the remainder get
+   tested */
+constexpr std::size_t Count = 37;
+
+const Frustum TestFrustum = Frustum::fromMatrix(
+    Matrix4::perspectiveProjection(Deg(60.0f), 1.5f, 0.5f, 20.0f)*
+    Matrix4::lookAt({1.0f, 2.0f, 8.0f}, {}, Vector3::yAxis()).invertedRigid());
+
+/* Spread around the origin so roughly half of the objects are culled */
+Vector3 center(std::size_t i) {
+    return Vector3{Float((i*7) % 23), Float((i*11) % 19), Float((i*5) % 17)} - Vector3{11.5f, 9.5f, 8.0f};
+}
+
+Vector3 extent(std::size_t i) {
+    return Vector3{Float(i % 3), Float(i % 5), Float(i % 2)}*0.5f + Vector3{0.25f};
+}
+
+struct Sphere {
+    Vector3 center;
+    Float radius;
+};
+
+void IntersectionBatchTest::rangeFrustum() {
+    Range3D ranges[Count];
+    bool expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        ranges[i] = Range3D::fromCenter(center(i), extent(i));
+        expected[i] = Intersection::rangeFrustum(ranges[i], TestFrustum);
+    }
+
+    bool out[Count];
+    Intersection::rangeFrustumInto(ranges, TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* Verify the data is actually something useful */
+    std::size_t visible = 0;
+    for(bool i: expected) visible += i;
+    CORRADE_VERIFY(visible > 0);
+    CORRADE_VERIFY(visible < Count);
+}
+
+void IntersectionBatchTest::rangeFrustumIndices() {
+    Range3D ranges[Count];
+    UnsignedInt expected[Count];
+    std::size_t expectedCount = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        ranges[i] = Range3D::fromCenter(center(i), extent(i));
+        if(Intersection::rangeFrustum(ranges[i], TestFrustum))
+            expected[expectedCount++] = i;
+    }
+
+    UnsignedInt out[Count];
+    const std::size_t count = Intersection::rangeFrustumIndicesInto(ranges, TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out).prefix(count),
+        Corrade::Containers::arrayView(expected).prefix(expectedCount),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::aabbFrustum() {
+    /* Interleaved to test strided input */
+    struct Aabb {
+        Vector3 center;
+        Vector3 extent;
+    } aabbs[Count];
+    bool expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        aabbs[i].center = center(i);
+        aabbs[i].extent = extent(i);
+        expected[i] = Intersection::aabbFrustum(aabbs[i].center, aabbs[i].extent, TestFrustum);
+    }
+
+    bool out[Count];
+    Intersection::aabbFrustumInto(
+        Corrade::Containers::stridedArrayView(aabbs, &aabbs[0].center, Count, sizeof(Aabb)),
+        Corrade::Containers::stridedArrayView(aabbs, &aabbs[0].extent, Count, sizeof(Aabb)),
+        TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::aabbFrustumIndices() {
+    Vector3 centers[Count];
+    Vector3 extents[Count];
+    UnsignedInt expected[Count];
+    std::size_t expectedCount = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        centers[i] = center(i);
+        extents[i] = extent(i);
+        if(Intersection::aabbFrustum(centers[i], extents[i], TestFrustum))
+            expected[expectedCount++] = i;
+    }
+
+    UnsignedInt out[Count];
+    const std::size_t count = Intersection::aabbFrustumIndicesInto(centers, extents, TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out).prefix(count),
+        Corrade::Containers::arrayView(expected).prefix(expectedCount),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::sphereFrustum() {
+    Sphere spheres[Count];
+    bool expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        spheres[i].center = center(i);
+        spheres[i].radius = extent(i).x();
+        expected[i] = Intersection::sphereFrustum(spheres[i].center, spheres[i].radius, TestFrustum);
+    }
+
+    bool out[Count];
+    Intersection::sphereFrustumInto(
+        Corrade::Containers::stridedArrayView(spheres, &spheres[0].center, Count, sizeof(Sphere)),
+        Corrade::Containers::stridedArrayView(spheres, &spheres[0].radius, Count, sizeof(Sphere)),
+        TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::sphereFrustumIndices() {
+    Sphere spheres[Count];
+    UnsignedInt expected[Count];
+    std::size_t expectedCount = 0;
+    for(std::size_t i = 0; i != Count; ++i) {
+        spheres[i].center = center(i);
+        spheres[i].radius = extent(i).x();
+        if(Intersection::sphereFrustum(spheres[i].center, spheres[i].radius, TestFrustum))
+            expected[expectedCount++] = i;
+    }
+
+    UnsignedInt out[Count];
+    const std::size_t count = Intersection::sphereFrustumIndicesInto(
+        Corrade::Containers::stridedArrayView(spheres, &spheres[0].center, Count, sizeof(Sphere)),
+        Corrade::Containers::stridedArrayView(spheres, &spheres[0].radius, Count, sizeof(Sphere)),
+        TestFrustum, out);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(out).prefix(count),
+        Corrade::Containers::arrayView(expected).prefix(expectedCount),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void IntersectionBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Range3D ranges[3];
+    Vector3 vectors[3];
+    Float radii[2]{};
+    bool out[2];
+    UnsignedInt indices[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    Intersection::rangeFrustumInto(ranges, TestFrustum, out);
+    Intersection::rangeFrustumIndicesInto(ranges, TestFrustum, indices);
+    Intersection::aabbFrustumInto(vectors, Corrade::Containers::arrayView(vectors).prefix(2), TestFrustum, out);
+    Intersection::aabbFrustumInto(vectors, vectors, TestFrustum, out);
+    Intersection::aabbFrustumIndicesInto(vectors, Corrade::Containers::arrayView(vectors).prefix(2), TestFrustum, indices);
+    Intersection::aabbFrustumIndicesInto(vectors, vectors, TestFrustum, indices);
+    Intersection::sphereFrustumInto(vectors, radii, TestFrustum, out);
+    Intersection::sphereFrustumInto(Corrade::Containers::arrayView(vectors).prefix(2), radii, TestFrustum, Corrade::Containers::arrayView(out).prefix(1));
+    Intersection::sphereFrustumIndicesInto(vectors, radii, TestFrustum, indices);
+    Intersection::sphereFrustumIndicesInto(Corrade::Containers::arrayView(vectors).prefix(2), radii, TestFrustum, Corrade::Containers::arrayView(indices).prefix(1));
+    CORRADE_COMPARE(o.str(),
+        "Math::Intersection::rangeFrustumInto(): wrong output size, got 2 but expected 3\n"
+        "Math::Intersection::rangeFrustumIndicesInto(): output too small, got 2 but expected at least 3\n"
+        "Math::Intersection::aabbFrustumInto(): expected center and extent views to have the same size, got 3 and 2\n"
+        "Math::Intersection::aabbFrustumInto(): wrong output size, got 2 but expected 3\n"
+        "Math::Intersection::aabbFrustumIndicesInto(): expected center and extent views to have the same size, got 3 and 2\n"
+        "Math::Intersection::aabbFrustumIndicesInto(): output too small, got 2 but expected at least 3\n"
+        "Math::Intersection::sphereFrustumInto(): expected center and radius views to have the same size, got 3 and 2\n"
+        "Math::Intersection::sphereFrustumInto(): wrong output size, got 1 but expected 2\n"
+        "Math::Intersection::sphereFrustumIndicesInto(): expected center and radius views to have the same size, got 3 and 2\n"
+        "Math::Intersection::sphereFrustumIndicesInto(): output too small, got 1 but expected at least 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::IntersectionBatchTest)
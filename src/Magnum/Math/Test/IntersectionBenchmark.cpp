@@ -26,10 +26,14 @@
 
 #include <random>
 #include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Intersection.h"
+#include "Magnum/Math/IntersectionBatch.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
 
@@ -102,10 +106,14 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     void rangeFrustumNaive();
     void rangeFrustum();
+    void rangeFrustumBatch();
+    void rangeFrustumBatchIndices();
 
     void rangeCone();
 
     void sphereFrustum();
+    void sphereFrustumBatch();
+    void sphereFrustumBatchIndices();
 
     void sphereConeNaive();
     void sphereCone();
@@ -121,15 +129,23 @@ struct IntersectionBenchmark: Corrade::TestSuite::Tester {
 
     std::vector<Range3D> _boxes;
     std::vector<Vector4> _spheres;
+
+    /* Output for the batch variants */
+    Corrade::Containers::Array<bool> _visible;
+    Corrade::Containers::Array<UnsignedInt> _visibleIndices;
 };
 
 IntersectionBenchmark::IntersectionBenchmark() {
     addBenchmarks({&IntersectionBenchmark::rangeFrustumNaive,
                    &IntersectionBenchmark::rangeFrustum,
+                   &IntersectionBenchmark::rangeFrustumBatch,
+                   &IntersectionBenchmark::rangeFrustumBatchIndices,
 
                    &IntersectionBenchmark::rangeCone,
 
                    &IntersectionBenchmark::sphereFrustum,
+                   &IntersectionBenchmark::sphereFrustumBatch,
+                   &IntersectionBenchmark::sphereFrustumBatchIndices,
 
                    &IntersectionBenchmark::sphereConeNaive,
                    &IntersectionBenchmark::sphereCone,
@@ -157,6 +173,9 @@ IntersectionBenchmark::IntersectionBenchmark() {
         _boxes.emplace_back(center - extents, center + extents);
         _spheres.emplace_back(center, extents.length());
     }
+
+    _visible = Corrade::Containers::Array<bool>{512};
+    _visibleIndices = Corrade::Containers::Array<UnsignedInt>{512};
 }
 
 void IntersectionBenchmark::rangeFrustumNaive() {
@@ -173,6 +192,21 @@ void IntersectionBenchmark::rangeFrustum() {
     }
 }
 
+void IntersectionBenchmark::rangeFrustumBatch() {
+    CORRADE_BENCHMARK(50) {
+        Intersection::rangeFrustumInto(_boxes, _frustum, _visible);
+    }
+}
+
+void IntersectionBenchmark::rangeFrustumBatchIndices() {
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count = Intersection::rangeFrustumIndicesInto(_boxes, _frustum, _visibleIndices);
+    }
+
+    CORRADE_VERIFY(count <= _boxes.size());
+}
+
 void IntersectionBenchmark::rangeCone() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) {
@@ -191,6 +225,29 @@ void IntersectionBenchmark::sphereFrustum() {
     }
 }
 
+void IntersectionBenchmark::sphereFrustumBatch() {
+    const Corrade::Containers::ArrayView<const Vector4> spheres = _spheres;
+    const Corrade::Containers::StridedArrayView1D<const Vector3> centers{spheres, reinterpret_cast<const Vector3*>(spheres.data()), spheres.size(), sizeof(Vector4)};
+    const Corrade::Containers::StridedArrayView1D<const Float> radii{spheres, spheres.data()->data() + 3, spheres.size(), sizeof(Vector4)};
+
+    CORRADE_BENCHMARK(50) {
+        Intersection::sphereFrustumInto(centers, radii, _frustum, _visible);
+    }
+}
+
+void IntersectionBenchmark::sphereFrustumBatchIndices() {
+    const Corrade::Containers::ArrayView<const Vector4> spheres = _spheres;
+    const Corrade::Containers::StridedArrayView1D<const Vector3> centers{spheres, reinterpret_cast<const Vector3*>(spheres.data()), spheres.size(), sizeof(Vector4)};
+    const Corrade::Containers::StridedArrayView1D<const Float> radii{spheres, spheres.data()->data() + 3, spheres.size(), sizeof(Vector4)};
+
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(50) {
+        count = Intersection::sphereFrustumIndicesInto(centers, radii, _frustum, _visibleIndices);
+    }
+
+    CORRADE_VERIFY(count <= _spheres.size());
+}
+
 void IntersectionBenchmark::sphereConeNaive() {
     volatile bool b = false;
     CORRADE_BENCHMARK(50) for(auto& sphere: _spheres) {
@@ -115,6 +115,11 @@ struct Matrix4Test: Corrade::TestSuite::Tester {
     void transform();
     void transformProjection();
 
+    void multiplySpecialized();
+    void multiplyVectorSpecialized();
+    void invertedSpecialized();
+    void invertedRigidSpecialized();
+
     void strictWeakOrdering();
 
     void debug();
@@ -124,6 +129,7 @@ typedef Math::Deg<Float> Deg;
 typedef Math::Rad<Float> Rad;
 typedef Math::Matrix<2, Float> Matrix2x2;
 typedef Math::Matrix<3, Float> Matrix3x3;
+typedef Math::Matrix<4, Float> Matrix4x4;
 typedef Math::Matrix4<Float> Matrix4;
 typedef Math::Matrix4<Int> Matrix4i;
 typedef Math::Vector2<Float> Vector2;
@@ -184,6 +190,11 @@ Matrix4Test::Matrix4Test() {
               &Matrix4Test::transform,
               &Matrix4Test::transformProjection,
 
+              &Matrix4Test::multiplySpecialized,
+              &Matrix4Test::multiplyVectorSpecialized,
+              &Matrix4Test::invertedSpecialized,
+              &Matrix4Test::invertedRigidSpecialized,
+
               &Matrix4Test::strictWeakOrdering,
 
               &Matrix4Test::debug});
@@ -986,6 +997,64 @@ void Matrix4Test::transformProjection() {
     CORRADE_COMPARE(a.transformPoint(v), Vector3(0.0f, 0.0f, 1.0f));
 }
 
+/* Matrix4<Float> has SSE2 / NEON specializations for multiplication and
+   inversion, Matrix<4, Float> always goes through the generic code */
+
+void Matrix4Test::multiplySpecialized() {
+    Matrix4 a = Matrix4::rotation(-74.0_degf, Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::scaling({2.5f, 0.3f, -1.0f});
+    Matrix4 b = Matrix4::perspectiveProjection(35.0_degf, 1.333f, 0.1f, 100.0f)*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+
+    /* The operation order is the same, so the result should be bit-exact */
+    Matrix4 actual = a*b;
+    Matrix4x4 expected = Matrix4x4{a}*Matrix4x4{b};
+    for(std::size_t i = 0; i != 4; ++i) for(std::size_t j = 0; j != 4; ++j) {
+        CORRADE_ITERATION(i, j);
+        CORRADE_COMPARE(actual[i][j], expected[i][j]);
+    }
+}
+
+void Matrix4Test::multiplyVectorSpecialized() {
+    Matrix4 a = Matrix4::rotation(-74.0_degf, Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+    Vector4 v{1.0f, -2.0f, 5.5f, 0.25f};
+
+    Vector4 actual = a*v;
+    Vector4 expected = Matrix4x4{a}*v;
+    for(std::size_t i = 0; i != 4; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(actual[i], expected[i]);
+    }
+}
+
+void Matrix4Test::invertedSpecialized() {
+    Matrix4 a = Matrix4::perspectiveProjection(35.0_degf, 1.333f, 0.1f, 100.0f)*
+                Matrix4::rotation(-74.0_degf, Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::scaling({2.5f, 0.3f, -1.0f})*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+
+    /* Different algorithm, so the result is equal only within precision */
+    Matrix4 inverted = a.inverted();
+    CORRADE_COMPARE(inverted, Matrix4{Matrix4x4{a}.inverted()});
+    CORRADE_COMPARE(a*inverted, Matrix4{});
+    CORRADE_COMPARE(inverted*a, Matrix4{});
+}
+
+void Matrix4Test::invertedRigidSpecialized() {
+    Matrix4 a = Matrix4::rotation(-74.0_degf, Vector3(-1.0f, 0.5f, 2.0f).normalized())*
+                Matrix4::translation({1.0f, 2.0f, -3.0f});
+
+    /* Same operation order as the generic R^T*-t, so bit-exact */
+    Matrix4 actual = a.invertedRigid();
+    Matrix3x3 inverseRotation = a.rotationScaling().transposed();
+    Matrix4 expected = Matrix4::from(inverseRotation, inverseRotation*-a.translation());
+    for(std::size_t i = 0; i != 4; ++i) for(std::size_t j = 0; j != 4; ++j) {
+        CORRADE_ITERATION(i, j);
+        CORRADE_COMPARE(actual[i][j], expected[i][j]);
+    }
+}
+
 void Matrix4Test::strictWeakOrdering() {
     StrictWeakOrdering o;
     const Matrix4 a(Vector4{1.0f, 1.0f, 2.0f, 2.0f}, Vector4{5.0f, 5.0f, 6.0f, 5.0f}, Vector4{5.0f, 5.0f, 6.0f, 5.0f}, Vector4{3.0f, 1.0f, 2.0f, 4.0f});
@@ -23,10 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
 #include "Magnum/Math/Algorithms/GaussJordan.h"
 
 namespace Magnum { namespace Math { namespace Test { namespace {
@@ -36,6 +39,7 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
 
     void multiply3();
     void multiply4();
+    void multiply4Generic();
 
     void comatrix3();
     void invert3();
@@ -44,6 +48,7 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
     void invert3Orthogonal();
     void comatrix4();
     void invert4();
+    void invert4Generic();
     void invert4GaussJordan();
     void invert4Rigid();
     void invert4Orthogonal();
@@ -51,12 +56,20 @@ struct MatrixBenchmark: Corrade::TestSuite::Tester {
     void transformVector3();
     void transformPoint3();
     void transformVector4();
+    void transformVector4Generic();
     void transformPoint4();
+
+    void transformVectors4Loop();
+    void transformVectors4Batch();
+    void transformPoints4Loop();
+    void transformPoints4Batch();
+    void transformPoints4BatchStrided();
 };
 
 MatrixBenchmark::MatrixBenchmark() {
     addBenchmarks({&MatrixBenchmark::multiply3,
-                   &MatrixBenchmark::multiply4}, 500);
+                   &MatrixBenchmark::multiply4,
+                   &MatrixBenchmark::multiply4Generic}, 500);
 
     addBenchmarks({&MatrixBenchmark::comatrix3,
                    &MatrixBenchmark::invert3,
@@ -65,6 +78,7 @@ MatrixBenchmark::MatrixBenchmark() {
                    &MatrixBenchmark::invert3Orthogonal,
                    &MatrixBenchmark::comatrix4,
                    &MatrixBenchmark::invert4,
+                   &MatrixBenchmark::invert4Generic,
                    &MatrixBenchmark::invert4GaussJordan,
                    &MatrixBenchmark::invert4Rigid,
                    &MatrixBenchmark::invert4Orthogonal}, 50);
@@ -72,13 +86,23 @@ MatrixBenchmark::MatrixBenchmark() {
     addBenchmarks({&MatrixBenchmark::transformVector3,
                    &MatrixBenchmark::transformPoint3,
                    &MatrixBenchmark::transformVector4,
+                   &MatrixBenchmark::transformVector4Generic,
                    &MatrixBenchmark::transformPoint4}, 1000);
+
+    addBenchmarks({&MatrixBenchmark::transformVectors4Loop,
+                   &MatrixBenchmark::transformVectors4Batch,
+                   &MatrixBenchmark::transformPoints4Loop,
+                   &MatrixBenchmark::transformPoints4Batch,
+                   &MatrixBenchmark::transformPoints4BatchStrided}, 100);
 }
 
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
 typedef Math::Matrix4<Float> Matrix4;
+/* Matrix4<Float> has SIMD specializations, this one goes through the generic
+   implementation */
+typedef Math::Matrix<4, Float> Matrix4x4;
 typedef Math::Matrix3<Float> Matrix3;
 
 enum: std::size_t { Repeats = 10000 };
@@ -111,6 +135,15 @@ void MatrixBenchmark::multiply4() {
     CORRADE_VERIFY(a.toVector().sum() != 0);
 }
 
+void MatrixBenchmark::multiply4Generic() {
+    Matrix4x4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        a = a*a;
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
 void MatrixBenchmark::comatrix3() {
     Matrix3 a = Data3;
     CORRADE_BENCHMARK(Repeats) {
@@ -174,6 +207,15 @@ void MatrixBenchmark::invert4() {
     CORRADE_VERIFY(a.toVector().sum() != 0);
 }
 
+void MatrixBenchmark::invert4Generic() {
+    Matrix4x4 a = Data4;
+    CORRADE_BENCHMARK(Repeats) {
+        a = a.inverted();
+    }
+
+    CORRADE_VERIFY(a.toVector().sum() != 0);
+}
+
 void MatrixBenchmark::invert4GaussJordan() {
     Matrix4 a = Data4;
     CORRADE_BENCHMARK(Repeats) {
@@ -228,6 +270,16 @@ void MatrixBenchmark::transformVector4() {
     CORRADE_VERIFY(a.sum() != 0);
 }
 
+void MatrixBenchmark::transformVector4Generic() {
+    const Matrix4x4 matrix = Data4;
+    Vector3 a{1.0f, 3.0f, -2.2f};
+    CORRADE_BENCHMARK(Repeats) {
+        a = (matrix*Vector4{a, 0.0f}).xyz();
+    }
+
+    CORRADE_VERIFY(a.sum() != 0);
+}
+
 void MatrixBenchmark::transformPoint4() {
     Vector3 a{1.0f, 3.0f, -2.2f};
     CORRADE_BENCHMARK(Repeats) {
@@ -237,6 +289,68 @@ void MatrixBenchmark::transformPoint4() {
     CORRADE_VERIFY(a.sum() != 0);
 }
 
+Corrade::Containers::Array<Vector3> points() {
+    Corrade::Containers::Array<Vector3> out{Corrade::Containers::NoInit, Repeats};
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = Vector3{1.0f, 3.0f, -2.2f}*Float(i%17);
+    return out;
+}
+
+void MatrixBenchmark::transformVectors4Loop() {
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Data4.transformVector(src[i]);
+    }
+
+    CORRADE_VERIFY(dst[1].sum() != 0);
+}
+
+void MatrixBenchmark::transformVectors4Batch() {
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        transformVectorsInto(Data4, src, dst);
+    }
+
+    CORRADE_VERIFY(dst[1].sum() != 0);
+}
+
+void MatrixBenchmark::transformPoints4Loop() {
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != src.size(); ++i)
+            dst[i] = Data4.transformPoint(src[i]);
+    }
+
+    CORRADE_VERIFY(dst[1].sum() != 0);
+}
+
+void MatrixBenchmark::transformPoints4Batch() {
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInto(Data4, src, dst);
+    }
+
+    CORRADE_VERIFY(dst[1].sum() != 0);
+}
+
+void MatrixBenchmark::transformPoints4BatchStrided() {
+    /* Every other item, which forces the one-at-a-time code path */
+    Corrade::Containers::Array<Vector3> src = points();
+    Corrade::Containers::Array<Vector3> dst{Corrade::Containers::NoInit, src.size()};
+    CORRADE_BENCHMARK(1) {
+        transformPointsInto(Data4,
+            Corrade::Containers::StridedArrayView1D<const Vector3>{src}.every(2),
+            Corrade::Containers::StridedArrayView1D<Vector3>{dst}.every(2));
+    }
+
+    CORRADE_VERIFY(dst[2].sum() != 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::MatrixBenchmark)
@@ -0,0 +1,291 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Packing.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector4.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct PackingBatchBenchmark: Corrade::TestSuite::Tester {
+    explicit PackingBatchBenchmark();
+
+    template<class T> void unpackContiguous();
+    template<class T> void unpackStrided();
+    template<class T> void packContiguous();
+    template<class T> void packStrided();
+    template<class T> void castToFloatContiguous();
+    template<class T> void castToFloatStrided();
+    template<class T> void castFromFloatContiguous();
+    template<class T> void castFromFloatStrided();
+
+    void unpackHalfContiguous();
+    void unpackHalfStrided();
+    void unpackHalfScalar();
+    void packHalfContiguous();
+    void packHalfStrided();
+    void packHalfScalar();
+};
+
+PackingBatchBenchmark::PackingBatchBenchmark() {
+    addBenchmarks({
+        &PackingBatchBenchmark::unpackContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::unpackStrided<UnsignedByte>,
+        &PackingBatchBenchmark::unpackContiguous<Byte>,
+        &PackingBatchBenchmark::unpackStrided<Byte>,
+        &PackingBatchBenchmark::unpackContiguous<UnsignedShort>,
+        &PackingBatchBenchmark::unpackStrided<UnsignedShort>,
+        &PackingBatchBenchmark::unpackContiguous<Short>,
+        &PackingBatchBenchmark::unpackStrided<Short>,
+
+        &PackingBatchBenchmark::packContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::packStrided<UnsignedByte>,
+        &PackingBatchBenchmark::packContiguous<Byte>,
+        &PackingBatchBenchmark::packStrided<Byte>,
+        &PackingBatchBenchmark::packContiguous<UnsignedShort>,
+        &PackingBatchBenchmark::packStrided<UnsignedShort>,
+        &PackingBatchBenchmark::packContiguous<Short>,
+        &PackingBatchBenchmark::packStrided<Short>,
+
+        &PackingBatchBenchmark::castToFloatContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::castToFloatStrided<UnsignedByte>,
+        &PackingBatchBenchmark::castToFloatContiguous<Short>,
+        &PackingBatchBenchmark::castToFloatStrided<Short>,
+        &PackingBatchBenchmark::castToFloatContiguous<UnsignedInt>,
+        &PackingBatchBenchmark::castToFloatStrided<UnsignedInt>,
+        &PackingBatchBenchmark::castToFloatContiguous<Int>,
+        &PackingBatchBenchmark::castToFloatStrided<Int>,
+
+        &PackingBatchBenchmark::castFromFloatContiguous<UnsignedByte>,
+        &PackingBatchBenchmark::castFromFloatStrided<UnsignedByte>,
+        &PackingBatchBenchmark::castFromFloatContiguous<Short>,
+        &PackingBatchBenchmark::castFromFloatStrided<Short>,
+        &PackingBatchBenchmark::castFromFloatContiguous<UnsignedInt>,
+        &PackingBatchBenchmark::castFromFloatStrided<UnsignedInt>,
+        &PackingBatchBenchmark::castFromFloatContiguous<Int>,
+        &PackingBatchBenchmark::castFromFloatStrided<Int>,
+
+        &PackingBatchBenchmark::unpackHalfContiguous,
+        &PackingBatchBenchmark::unpackHalfStrided,
+        &PackingBatchBenchmark::unpackHalfScalar,
+        &PackingBatchBenchmark::packHalfContiguous,
+        &PackingBatchBenchmark::packHalfStrided,
+        &PackingBatchBenchmark::packHalfScalar}, 50);
+}
+
+/* A million of three-component vectors, such as positions or normals. The
+   contiguous variants process a tightly packed array, which can go through
+   the SIMD code paths, the strided variants process the same amount of data
+   padded to four components, which falls back to processing each vector
+   separately. */
+enum: std::size_t { VectorCount = 1000000 };
+
+template<class T> Corrade::Containers::StridedArrayView2D<T> contiguous(Corrade::Containers::Array<Math::Vector4<T>>& data) {
+    return Corrade::Containers::arrayCast<2, T>(Corrade::Containers::arrayCast<Math::Vector3<T>>(Corrade::Containers::arrayCast<T>(data).prefix(VectorCount*3)));
+}
+
+template<class T> Corrade::Containers::StridedArrayView2D<T> strided(Corrade::Containers::Array<Math::Vector4<T>>& data) {
+    return Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(data)).prefix({std::size_t(VectorCount), 3});
+}
+
+template<class T> Corrade::Containers::Array<Math::Vector4<T>> integerData() {
+    Corrade::Containers::Array<Math::Vector4<T>> out{Corrade::Containers::NoInit, VectorCount};
+    for(std::size_t i = 0; i != VectorCount; ++i)
+        out[i] = Math::Vector4<T>{T(i), T(i*3), T(i*7), T(i*11)};
+    return out;
+}
+
+template<class T> Corrade::Containers::Array<Vector4<Float>> floatData() {
+    Corrade::Containers::Array<Vector4<Float>> out{Corrade::Containers::NoInit, VectorCount};
+    for(std::size_t i = 0; i != VectorCount; ++i) {
+        const Float value = Float(i)/Float(VectorCount - 1);
+        out[i] = Vector4<Float>{value, 1.0f - value, value*0.5f, 0.0f};
+        if(std::is_signed<T>::value) out[i] = out[i]*2.0f - Vector4<Float>{1.0f};
+    }
+    return out;
+}
+
+template<class T> void PackingBatchBenchmark::unpackContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> src = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        unpackInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[1][0], Math::unpack<Float>(T(1)));
+}
+
+template<class T> void PackingBatchBenchmark::unpackStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> src = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        unpackInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[1].x(), Math::unpack<Float>(T(1)));
+}
+
+template<class T> void PackingBatchBenchmark::packContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Vector4<Float>> src = floatData<T>();
+    Corrade::Containers::Array<Math::Vector4<T>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        packInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[0][0], Math::pack<T>(src[0][0]));
+}
+
+template<class T> void PackingBatchBenchmark::packStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Vector4<Float>> src = floatData<T>();
+    Corrade::Containers::Array<Math::Vector4<T>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        packInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[1].x(), Math::pack<T>(src[1].x()));
+}
+
+template<class T> void PackingBatchBenchmark::castToFloatContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> src = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        castInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[1][0], Float(T(1)));
+}
+
+template<class T> void PackingBatchBenchmark::castToFloatStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> src = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        castInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[1].x(), Float(T(1)));
+}
+
+template<class T> void PackingBatchBenchmark::castFromFloatContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> data = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> src{Corrade::Containers::ValueInit, VectorCount};
+    castInto(strided(data), strided(src));
+
+    Corrade::Containers::Array<Math::Vector4<T>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        castInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[1][0], T(src[1][0]));
+}
+
+template<class T> void PackingBatchBenchmark::castFromFloatStrided() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Corrade::Containers::Array<Math::Vector4<T>> data = integerData<T>();
+    Corrade::Containers::Array<Vector4<Float>> src{Corrade::Containers::ValueInit, VectorCount};
+    castInto(strided(data), strided(src));
+
+    Corrade::Containers::Array<Math::Vector4<T>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        castInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[1].x(), T(src[1].x()));
+}
+
+/* The contiguous variants use F16C or NEON where available, the strided
+   variants use the lookup tables and the scalar variants go through the
+   non-batch packHalf() / unpackHalf() */
+
+void PackingBatchBenchmark::unpackHalfContiguous() {
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> src = integerData<UnsignedShort>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        unpackHalfInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[1][0], Math::unpackHalf(1));
+}
+
+void PackingBatchBenchmark::unpackHalfStrided() {
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> src = integerData<UnsignedShort>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        unpackHalfInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[1].x(), Math::unpackHalf(1));
+}
+
+void PackingBatchBenchmark::unpackHalfScalar() {
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> src = integerData<UnsignedShort>();
+    Corrade::Containers::Array<Vector4<Float>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != VectorCount; ++i)
+            dst[i].xyz() = Math::unpackHalf(src[i].xyz());
+
+    CORRADE_COMPARE(dst[1].x(), Math::unpackHalf(1));
+}
+
+void PackingBatchBenchmark::packHalfContiguous() {
+    Corrade::Containers::Array<Vector4<Float>> src = floatData<UnsignedShort>();
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        packHalfInto(contiguous(src), contiguous(dst));
+
+    CORRADE_COMPARE(dst[0][0], 0);
+}
+
+void PackingBatchBenchmark::packHalfStrided() {
+    Corrade::Containers::Array<Vector4<Float>> src = floatData<UnsignedShort>();
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        packHalfInto(strided(src), strided(dst));
+
+    CORRADE_COMPARE(dst[0].x(), 0);
+}
+
+void PackingBatchBenchmark::packHalfScalar() {
+    Corrade::Containers::Array<Vector4<Float>> src = floatData<UnsignedShort>();
+    Corrade::Containers::Array<Math::Vector4<UnsignedShort>> dst{Corrade::Containers::ValueInit, VectorCount};
+    CORRADE_BENCHMARK(1)
+        for(std::size_t i = 0; i != VectorCount; ++i)
+            dst[i].xyz() = Math::packHalf(src[i].xyz());
+
+    CORRADE_COMPARE(dst[0].x(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::PackingBatchBenchmark)
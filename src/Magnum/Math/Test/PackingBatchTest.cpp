@@ -27,6 +27,7 @@
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Color.h"
@@ -51,14 +52,25 @@ struct PackingBatchTest: Corrade::TestSuite::Tester {
     void unpackHalf();
     void packHalf();
 
+    template<class T> void packOctahedral();
+    template<class T> void unpackOctahedral();
+
     template<class T> void castUnsignedFloat();
     template<class T> void castSignedFloat();
 
     template<class T> void castUnsignedInteger();
     template<class T> void castSignedInteger();
 
+    template<class T> void unpackContiguous();
+    template<class T> void packContiguous();
+    template<class T> void castFloatContiguous();
+    template<class T, class U> void castIntegerContiguous();
+    void unpackHalfContiguous();
+    void packHalfContiguous();
+
     template<class T> void assertionsPackUnpack();
     void assertionsPackUnpackHalf();
+    void assertionsPackUnpackOctahedral();
     template<class U, class T> void assertionsCast();
 };
 
@@ -75,6 +87,13 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::unpackHalf,
               &PackingBatchTest::packHalf,
 
+              &PackingBatchTest::packOctahedral<Byte>,
+              &PackingBatchTest::packOctahedral<Short>,
+              &PackingBatchTest::packOctahedral<Float>,
+              &PackingBatchTest::unpackOctahedral<Byte>,
+              &PackingBatchTest::unpackOctahedral<Short>,
+              &PackingBatchTest::unpackOctahedral<Float>,
+
               &PackingBatchTest::castUnsignedFloat<UnsignedByte>,
               &PackingBatchTest::castUnsignedFloat<UnsignedShort>,
               &PackingBatchTest::castUnsignedFloat<UnsignedInt>,
@@ -87,11 +106,33 @@ PackingBatchTest::PackingBatchTest() {
               &PackingBatchTest::castSignedInteger<Byte>,
               &PackingBatchTest::castSignedInteger<Short>,
 
+              &PackingBatchTest::unpackContiguous<UnsignedByte>,
+              &PackingBatchTest::unpackContiguous<Byte>,
+              &PackingBatchTest::unpackContiguous<UnsignedShort>,
+              &PackingBatchTest::unpackContiguous<Short>,
+              &PackingBatchTest::packContiguous<UnsignedByte>,
+              &PackingBatchTest::packContiguous<Byte>,
+              &PackingBatchTest::packContiguous<UnsignedShort>,
+              &PackingBatchTest::packContiguous<Short>,
+              &PackingBatchTest::castFloatContiguous<UnsignedByte>,
+              &PackingBatchTest::castFloatContiguous<Byte>,
+              &PackingBatchTest::castFloatContiguous<UnsignedShort>,
+              &PackingBatchTest::castFloatContiguous<Short>,
+              &PackingBatchTest::castFloatContiguous<UnsignedInt>,
+              &PackingBatchTest::castFloatContiguous<Int>,
+              &PackingBatchTest::castIntegerContiguous<UnsignedByte, UnsignedInt>,
+              &PackingBatchTest::castIntegerContiguous<Byte, Int>,
+              &PackingBatchTest::castIntegerContiguous<UnsignedShort, UnsignedInt>,
+              &PackingBatchTest::castIntegerContiguous<Short, Int>,
+              &PackingBatchTest::unpackHalfContiguous,
+              &PackingBatchTest::packHalfContiguous,
+
               &PackingBatchTest::assertionsPackUnpack<UnsignedByte>,
               &PackingBatchTest::assertionsPackUnpack<Byte>,
               &PackingBatchTest::assertionsPackUnpack<UnsignedShort>,
               &PackingBatchTest::assertionsPackUnpack<Short>,
               &PackingBatchTest::assertionsPackUnpackHalf,
+              &PackingBatchTest::assertionsPackUnpackOctahedral,
               &PackingBatchTest::assertionsCast<Float, UnsignedByte>,
               &PackingBatchTest::assertionsCast<Float, Byte>,
               &PackingBatchTest::assertionsCast<Float, UnsignedShort>,
@@ -112,6 +153,7 @@ typedef Math::Vector2<Short> Vector2s;
 typedef Math::Vector2<Float> Vector2;
 typedef Math::Vector2<UnsignedInt> Vector2ui;
 typedef Math::Vector2<Int> Vector2i;
+typedef Math::Vector3<UnsignedShort> Vector3us;
 typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector4<Float> Vector4;
 
@@ -413,6 +455,67 @@ void PackingBatchTest::packHalf() {
         CORRADE_COMPARE(Math::packHalf(data[i].src), data[i].dst);
 }
 
+template<class T> Math::Vector2<T> packOctahedralScalar(const Vector3& vector) {
+    return Math::pack<Math::Vector2<T>>(Math::packOctahedral(vector));
+}
+
+template<> Vector2 packOctahedralScalar<Float>(const Vector3& vector) {
+    return Math::packOctahedral(vector);
+}
+
+template<class T> void PackingBatchTest::packOctahedral() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    struct Data {
+        Vector3 src;
+        Math::Vector2<T> dst;
+    } data[]{
+        {Vector3{0.3f, -0.2f, 0.9f}.normalized(), {}},
+        {Vector3{-0.7f, 0.1f, -0.4f}.normalized(), {}},
+        {Vector3{0.0f, 0.0f, -1.0f}, {}}
+    };
+
+    Corrade::Containers::StridedArrayView1D<const Vector3> src{data, &data[0].src, 3, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Math::Vector2<T>> dst{data, &data[0].dst, 3, sizeof(Data)};
+    packOctahedralInto(src, dst);
+
+    /* Should give the same result as the scalar variant */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(data[i].dst, packOctahedralScalar<T>(data[i].src));
+    }
+}
+
+template<class T> void PackingBatchTest::unpackOctahedral() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    const Vector3 expected[]{
+        Vector3{0.3f, -0.2f, 0.9f}.normalized(),
+        Vector3{-0.7f, 0.1f, -0.4f}.normalized(),
+        Vector3{0.0f, 0.0f, -1.0f}
+    };
+
+    struct Data {
+        Math::Vector2<T> src;
+        Vector3 dst;
+    } data[3];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i)
+        data[i].src = packOctahedralScalar<T>(expected[i]);
+
+    Corrade::Containers::StridedArrayView1D<const Math::Vector2<T>> src{data, &data[0].src, 3, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3> dst{data, &data[0].dst, 3, sizeof(Data)};
+    unpackOctahedralInto(src, dst);
+
+    /* 8-bit values lose quite some precision */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(data[i].dst.isNormalized());
+        CORRADE_COMPARE_AS((data[i].dst - expected[i]).length(),
+            sizeof(T) == 1 ? 0.02f : 0.0001f,
+            Corrade::TestSuite::Compare::LessOrEqual);
+    }
+}
+
 template<class T> void PackingBatchTest::castUnsignedFloat() {
     setTestCaseTemplateName(TypeTraits<T>::name());
 
@@ -573,6 +676,170 @@ template<class T> void PackingBatchTest::castSignedInteger() {
         Corrade::TestSuite::Compare::Container);
 }
 
+/* Pseudo-random values spanning the whole range of given type. For 32-bit
+   types the lowest eight bits are cleared so the values are exactly
+   representable as floats. */
+template<class T> T hashedValue(std::size_t i) {
+    const UnsignedInt value = UnsignedInt(i)*2654435761u;
+    return T(sizeof(T) == 4 ? value & 0xffffff00u : value >> (32 - sizeof(T)*8));
+}
+
+/* The contiguous tests have the input large enough and of a size that isn't
+   divisible by any SIMD width, so both the vectorized code and the scalar
+   remainder get used. The results should be consistent with non-batch
+   APIs. */
+
+template<class T> void PackingBatchTest::unpackContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Math::Vector3<T> src[37];
+    Vector3 dst[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            src[i][j] = hashedValue<T>(i*3 + j);
+
+    unpackInto(Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(src)),
+               Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Math::unpack<Vector3>(src[i]));
+    }
+}
+
+template<class T> void PackingBatchTest::packContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Vector3 src[37];
+    Math::Vector3<T> dst[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        for(std::size_t j = 0; j != 3; ++j) {
+            const Float value = Float(i*3 + j)/Float(Corrade::Containers::arraySize(src)*3 - 1);
+            src[i][j] = std::is_signed<T>::value ? value*2.0f - 1.0f : value;
+        }
+    }
+
+    /* Values exactly in the middle between two integers should be rounded
+       away from zero, same as with std::round() */
+    src[5] = std::is_signed<T>::value ? Vector3{0.5f, -0.5f, 1.0f} : Vector3{0.5f, 0.0f, 1.0f};
+
+    packInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(src)),
+             Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(dst)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Math::pack<Math::Vector3<T>>(src[i]));
+    }
+}
+
+template<class T> void PackingBatchTest::castFloatContiguous() {
+    setTestCaseTemplateName(TypeTraits<T>::name());
+
+    Math::Vector3<T> src[37];
+    Vector3 dst[37];
+    Math::Vector3<T> back[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            src[i][j] = hashedValue<T>(i*3 + j);
+
+    castInto(Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(src)),
+             Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Vector3{src[i]});
+    }
+
+    /* Test the other way around as well */
+    castInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)),
+             Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(back)));
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(back),
+        Corrade::Containers::arrayView(src),
+        Corrade::TestSuite::Compare::Container);
+}
+
+template<class T, class U> void PackingBatchTest::castIntegerContiguous() {
+    setTestCaseTemplateName({TypeTraits<T>::name(), TypeTraits<U>::name()});
+
+    Math::Vector3<T> src[37];
+    Math::Vector3<U> dst[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            src[i][j] = hashedValue<T>(i*3 + j);
+
+    castInto(Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(src)),
+             Corrade::Containers::arrayCast<2, U>(Corrade::Containers::stridedArrayView(dst)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Math::Vector3<U>{src[i]});
+    }
+
+    /* The other way around with values not fitting into the narrower type,
+       only the low bits should be kept */
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(dst); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            dst[i][j] = U(UnsignedInt(i*3 + j)*2654435761u);
+
+    castInto(Corrade::Containers::arrayCast<2, U>(Corrade::Containers::stridedArrayView(dst)),
+             Corrade::Containers::arrayCast<2, T>(Corrade::Containers::stridedArrayView(src)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(src[i], Math::Vector3<T>{dst[i]});
+    }
+}
+
+void PackingBatchTest::unpackHalfContiguous() {
+    Vector3us src[37];
+    Vector3 dst[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            src[i][j] = hashedValue<UnsignedShort>(i*3 + j);
+    /* Denormals, zeros and infinities */
+    src[3] = {0x0001, 0x83ff, 0x8000};
+    src[4] = {0x0000, 0x7c00, 0xfc00};
+
+    unpackHalfInto(Corrade::Containers::arrayCast<2, UnsignedShort>(Corrade::Containers::stridedArrayView(src)),
+                   Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(dst)));
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i) {
+        /* NaNs are not guaranteed to have the same payload */
+        if(Math::isNan(Math::unpackHalf(src[i])).any()) continue;
+
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i], Math::unpackHalf(src[i]));
+    }
+}
+
+void PackingBatchTest::packHalfContiguous() {
+    Vector3 src[37];
+    Vector3us dst[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(src); ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            src[i][j] = (Float(i*3 + j) - 50.0f)*1.337f;
+    /* Denormals, zeros, values too large and infinities */
+    src[3] = {0.0000001337f, -0.00003f, -0.0f};
+    src[4] = {65519.0f, -65536.0f, 1.0e10f};
+    src[5] = {0.0f, Constants::inf(), -Constants::inf()};
+
+    packHalfInto(Corrade::Containers::arrayCast<2, Float>(Corrade::Containers::stridedArrayView(src)),
+                 Corrade::Containers::arrayCast<2, UnsignedShort>(Corrade::Containers::stridedArrayView(dst)));
+
+    /* The scalar packHalf() rounds differently, so compare to processing
+       each vector separately, which doesn't go through the SIMD code path */
+    struct Data {
+        Vector3 src;
+        Vector3us dst;
+    } data[37];
+    for(std::size_t i = 0; i != Corrade::Containers::arraySize(data); ++i)
+        data[i].src = src[i];
+    Corrade::Containers::StridedArrayView1D<Vector3> stridedSrc{data, &data[0].src, 37, sizeof(Data)};
+    Corrade::Containers::StridedArrayView1D<Vector3us> stridedDst{data, &data[0].dst, 37, sizeof(Data)};
+    packHalfInto(Corrade::Containers::arrayCast<2, Float>(stridedSrc),
+                 Corrade::Containers::arrayCast<2, UnsignedShort>(stridedDst));
+    CORRADE_COMPARE_AS(Corrade::Containers::stridedArrayView(dst), stridedDst,
+        Corrade::TestSuite::Compare::Container);
+
+    /* Values too large should be infinities in both cases */
+    CORRADE_COMPARE(dst[4], (Vector3us{0x7bff, 0xfc00, 0x7c00}));
+    CORRADE_COMPARE(dst[5], (Vector3us{0x0000, 0x7c00, 0xfc00}));
+}
+
 template<class T> void PackingBatchTest::assertionsPackUnpack() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -645,6 +912,28 @@ void PackingBatchTest::assertionsPackUnpackHalf() {
         "Math::packHalfInto(): second view dimension is not contiguous\n");
 }
 
+void PackingBatchTest::assertionsPackUnpackOctahedral() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 vectors[2]{};
+    Vector2s packed[1]{};
+    Vector2 packedFloat[1]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packOctahedralInto(vectors, Corrade::Containers::arrayView(packed));
+    packOctahedralInto(vectors, Corrade::Containers::arrayView(packedFloat));
+    unpackOctahedralInto(Corrade::Containers::arrayView(packed), vectors);
+    unpackOctahedralInto(Corrade::Containers::arrayView(packedFloat), vectors);
+    CORRADE_COMPARE(out.str(),
+        "Math::packOctahedralInto(): wrong destination size, got 1 but expected 2\n"
+        "Math::packOctahedralInto(): wrong destination size, got 1 but expected 2\n"
+        "Math::unpackOctahedralInto(): wrong destination size, got 2 but expected 1\n"
+        "Math::unpackOctahedralInto(): wrong destination size, got 2 but expected 1\n");
+}
+
 template<class U, class T> void PackingBatchTest::assertionsCast() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -25,6 +25,7 @@
 
 #include <limits>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 
 #include "Magnum/Math/Packing.h"
 #include "Magnum/Math/Vector3.h"
@@ -47,6 +48,10 @@ struct PackingTest: Corrade::TestSuite::Tester {
     void pack8bitRoundtrip();
     void pack16bitRoundtrip();
 
+    void packOctahedral();
+    void unpackOctahedral();
+    void octahedralRoundtrip();
+
     /* Half (un)pack functions are tested and benchmarked in HalfTest.cpp,
        because there's involved comparison and benchmarks to ground truth */
 };
@@ -56,6 +61,8 @@ using namespace Literals;
 typedef Math::Rad<Float> Rad;
 typedef Math::Vector3<Float> Vector3;
 typedef Math::Vector3<UnsignedByte> Vector3ub;
+typedef Math::Vector2<Float> Vector2;
+typedef Math::Vector2<Short> Vector2s;
 typedef Math::Vector3<Byte> Vector3b;
 
 PackingTest::PackingTest() {
@@ -71,6 +78,10 @@ PackingTest::PackingTest() {
 
     addRepeatedTests({&PackingTest::pack8bitRoundtrip}, 256);
     addRepeatedTests({&PackingTest::pack16bitRoundtrip}, 65536);
+
+    addTests({&PackingTest::packOctahedral,
+              &PackingTest::unpackOctahedral,
+              &PackingTest::octahedralRoundtrip});
 }
 
 void PackingTest::bitMax() {
@@ -319,6 +330,50 @@ void PackingTest::pack16bitRoundtrip() {
     CORRADE_COMPARE(Math::pack<UnsignedShort>(Math::unpack<Float, UnsignedShort>(testCaseRepeatId())), testCaseRepeatId());
 }
 
+void PackingTest::packOctahedral() {
+    /* Upper hemisphere is just a projection */
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{0.0f, 0.0f, 1.0f}), (Vector2{0.0f, 0.0f}));
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{1.0f, 0.0f, 0.0f}), (Vector2{1.0f, 0.0f}));
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{0.0f, -1.0f, 0.0f}), (Vector2{0.0f, -1.0f}));
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{1.0f, 1.0f, 1.0f}.normalized()), (Vector2{1.0f/3.0f, 1.0f/3.0f}));
+
+    /* Lower hemisphere is folded to the corners */
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{0.0f, 0.0f, -1.0f}), (Vector2{1.0f, 1.0f}));
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{1.0f, -1.0f, -2.0f}.normalized()), (Vector2{0.75f, -0.75f}));
+
+    /* The input doesn't need to be normalized */
+    CORRADE_COMPARE(Math::packOctahedral(Vector3{1.0f, -1.0f, -2.0f}), (Vector2{0.75f, -0.75f}));
+}
+
+void PackingTest::unpackOctahedral() {
+    CORRADE_COMPARE(Math::unpackOctahedral(Vector2{0.0f, 0.0f}), (Vector3{0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(Math::unpackOctahedral(Vector2{1.0f, 0.0f}), (Vector3{1.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(Math::unpackOctahedral(Vector2{0.0f, -1.0f}), (Vector3{0.0f, -1.0f, 0.0f}));
+    CORRADE_COMPARE(Math::unpackOctahedral(Vector2{1.0f, 1.0f}), (Vector3{0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(Math::unpackOctahedral(Vector2{0.75f, -0.75f}), Vector3{1.0f, -1.0f, -2.0f}.normalized());
+
+    /* The output is always normalized */
+    CORRADE_VERIFY(Math::unpackOctahedral(Vector2{0.5f, 0.5f}).isNormalized());
+}
+
+void PackingTest::octahedralRoundtrip() {
+    /* Going through a 16-bit representation loses only very little
+       precision */
+    for(const Vector3& vector: {
+        Vector3{0.3f, -0.2f, 0.9f},
+        Vector3{-0.7f, 0.1f, -0.4f},
+        Vector3{0.01f, 0.99f, -0.05f},
+        Vector3{-0.5f, -0.5f, -0.5f}
+    }) {
+        CORRADE_ITERATION(vector);
+        const Vector3 normalized = vector.normalized();
+        const Vector2s packed = Math::pack<Vector2s>(Math::packOctahedral(normalized));
+        const Vector3 unpacked = Math::unpackOctahedral(Math::unpack<Vector2>(packed));
+        CORRADE_COMPARE_AS((unpacked - normalized).length(), 0.0001f,
+            Corrade::TestSuite::Compare::Less);
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Math::Test::PackingTest)
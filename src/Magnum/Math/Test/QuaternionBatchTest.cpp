@@ -0,0 +1,314 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/QuaternionBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct QuaternionBatchTest: Corrade::TestSuite::Tester {
+    explicit QuaternionBatchTest();
+
+    void slerp();
+    void slerpShortestPath();
+    void slerpStrided();
+    void slerpInPlace();
+    void sclerp();
+    void sclerpShortestPath();
+    void normalize();
+    void normalizeStrided();
+    void normalizeDual();
+
+    void assertions();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Quaternion<Float> Quaternion;
+typedef Math::DualQuaternion<Float> DualQuaternion;
+typedef Math::Deg<Float> Deg;
+
+QuaternionBatchTest::QuaternionBatchTest() {
+    addTests({&QuaternionBatchTest::slerp,
+              &QuaternionBatchTest::slerpShortestPath,
+              &QuaternionBatchTest::slerpStrided,
+              &QuaternionBatchTest::slerpInPlace,
+              &QuaternionBatchTest::sclerp,
+              &QuaternionBatchTest::sclerpShortestPath,
+              &QuaternionBatchTest::normalize,
+              &QuaternionBatchTest::normalizeStrided,
+              &QuaternionBatchTest::normalizeDual,
+
+              &QuaternionBatchTest::assertions});
+}
+
+/* Not a multiple of four so both the SIMD code and the remainder get
+   tested */
+constexpr std::size_t Count = 37;
+
+Quaternion rotationA(std::size_t i) {
+    return Quaternion::rotation(Deg(Float((i*29) % 360)), Vector3{1.0f, Float(i % 3), -1.0f}.normalized());
+}
+
+/* Every few items is the same or negated, to test the linear interpolation
+   fallback and shortest path handling */
+Quaternion rotationB(std::size_t i) {
+    if(i % 9 == 4) return rotationA(i);
+    if(i % 9 == 7) return -rotationA(i);
+    return Quaternion::rotation(Deg(Float((i*53 + 40) % 360)), Vector3{-1.0f, 2.0f, Float(i % 4)}.normalized());
+}
+
+DualQuaternion transformationA(std::size_t i) {
+    return DualQuaternion::translation({Float(i)*0.1f - 1.0f, 0.5f, -Float(i)*0.05f})*DualQuaternion{rotationA(i)};
+}
+
+DualQuaternion transformationB(std::size_t i) {
+    return DualQuaternion::translation({1.0f, -Float(i)*0.02f, 0.3f})*DualQuaternion{rotationB(i)};
+}
+
+Float phase(std::size_t i) {
+    return Float(i % 8)/7.0f;
+}
+
+void QuaternionBatchTest::slerp() {
+    Quaternion a[Count];
+    Quaternion b[Count];
+    Float t[Count];
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = rotationA(i);
+        b[i] = rotationB(i);
+        t[i] = phase(i);
+        expected[i] = Math::slerp(a[i], b[i], t[i]);
+    }
+
+    /* The interpolation is equal only within precision, so comparing with
+       fuzzy compare */
+    Quaternion dst[Count];
+    slerpInto(a, b, t, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::slerpShortestPath() {
+    Quaternion a[Count];
+    Quaternion b[Count];
+    Float t[Count];
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = rotationA(i);
+        b[i] = rotationB(i);
+        t[i] = phase(i);
+        expected[i] = Math::slerpShortestPath(a[i], b[i], t[i]);
+    }
+
+    Quaternion dst[Count];
+    slerpShortestPathInto(a, b, t, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::slerpStrided() {
+    struct Keyframe {
+        Float time;
+        Quaternion rotation;
+    } keyframes[Count + 1];
+    for(std::size_t i = 0; i != Count + 1; ++i) {
+        keyframes[i].time = Float(i);
+        keyframes[i].rotation = rotationA(i);
+    }
+
+    /* Interpolating between neighbor keyframes with the same phase for all,
+       i.e. a zero stride */
+    Float t = 0.25f;
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i)
+        expected[i] = Math::slerpShortestPath(keyframes[i].rotation, keyframes[i + 1].rotation, t);
+
+    Corrade::Containers::StridedArrayView1D<const Quaternion> rotations = Corrade::Containers::stridedArrayView(keyframes, &keyframes[0].rotation, Count + 1, sizeof(Keyframe));
+    Quaternion dst[Count];
+    slerpShortestPathInto(rotations.except(1), rotations.suffix(1),
+        Corrade::Containers::StridedArrayView1D<const Float>{Corrade::Containers::arrayView(&t, 1), &t, Count, 0},
+        dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+
+    /* The keyframe times shouldn't get touched by anything */
+    for(std::size_t i = 0; i != Count + 1; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(keyframes[i].time, Float(i));
+    }
+}
+
+void QuaternionBatchTest::slerpInPlace() {
+    Quaternion data[Count];
+    Quaternion b[Count];
+    Float t[Count];
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        data[i] = rotationA(i);
+        b[i] = rotationB(i);
+        t[i] = phase(i);
+        expected[i] = Math::slerpShortestPath(data[i], b[i], t[i]);
+    }
+
+    slerpShortestPathInto(data, b, t, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::sclerp() {
+    DualQuaternion a[Count];
+    DualQuaternion b[Count];
+    Float t[Count];
+    DualQuaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = transformationA(i);
+        b[i] = transformationB(i);
+        t[i] = phase(i);
+        expected[i] = Math::sclerp(a[i], b[i], t[i]);
+    }
+
+    DualQuaternion dst[Count];
+    sclerpInto(a, b, t, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::sclerpShortestPath() {
+    DualQuaternion a[Count];
+    DualQuaternion b[Count];
+    Float t[Count];
+    DualQuaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        a[i] = transformationA(i);
+        b[i] = transformationB(i);
+        t[i] = phase(i);
+        expected[i] = Math::sclerpShortestPath(a[i], b[i], t[i]);
+    }
+
+    DualQuaternion dst[Count];
+    sclerpShortestPathInto(a, b, t, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::normalize() {
+    Quaternion src[Count];
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = rotationA(i)*(Float(i) + 0.5f);
+        expected[i] = src[i].normalized();
+    }
+
+    Quaternion dst[Count];
+    normalizeInto(src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::normalizeStrided() {
+    struct Joint {
+        Quaternion rotation;
+        Float padding;
+    } joints[Count];
+    Quaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        joints[i].rotation = rotationA(i)*(Float(i) + 0.5f);
+        joints[i].padding = 1337.0f;
+        expected[i] = joints[i].rotation.normalized();
+    }
+
+    /* In-place */
+    Corrade::Containers::StridedArrayView1D<Quaternion> rotations = Corrade::Containers::stridedArrayView(joints, &joints[0].rotation, Count, sizeof(Joint));
+    normalizeInto(rotations, rotations);
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(joints[i].rotation, expected[i]);
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(joints[i].padding, 1337.0f);
+    }
+}
+
+void QuaternionBatchTest::normalizeDual() {
+    DualQuaternion src[Count];
+    DualQuaternion expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = transformationA(i)*(Float(i) + 0.5f);
+        expected[i] = src[i].normalized();
+    }
+
+    DualQuaternion dst[Count];
+    normalizeInto(src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void QuaternionBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Quaternion a[2];
+    Quaternion b[3];
+    Float t[2]{};
+    Quaternion dst[2];
+    DualQuaternion dualA[2];
+    DualQuaternion dualB[2];
+    DualQuaternion dualDst[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    slerpInto(a, b, t, dst);
+    slerpShortestPathInto(a, a, t, b);
+    sclerpInto(dualA, dualB, Corrade::Containers::arrayView(t).prefix(1), dualB);
+    sclerpShortestPathInto(dualA, dualB, t, dualDst);
+    normalizeInto(a, b);
+    normalizeInto(dualA, dualDst);
+    CORRADE_COMPARE(out.str(),
+        "Math::slerpInto(): expected all views to have 2 items but got 3, 2 and 2\n"
+        "Math::slerpShortestPathInto(): expected all views to have 2 items but got 2, 2 and 3\n"
+        "Math::sclerpInto(): expected all views to have 2 items but got 2, 1 and 2\n"
+        "Math::sclerpShortestPathInto(): expected all views to have 2 items but got 2, 2 and 3\n"
+        "Math::normalizeInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::normalizeInto(): wrong destination size, got 3 but expected 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::QuaternionBatchTest)
@@ -0,0 +1,248 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/TransformBatch.h"
+
+namespace Magnum { namespace Math { namespace Test { namespace {
+
+struct TransformBatchTest: Corrade::TestSuite::Tester {
+    explicit TransformBatchTest();
+
+    void transformPoints();
+    void transformPointsStrided();
+    void transformPointsInPlace();
+    void transformPointsProjective();
+    void transformVectors();
+    void transformVectorsStrided();
+    void transformVectorsInPlace();
+    void transform();
+
+    void assertions();
+};
+
+typedef Math::Vector3<Float> Vector3;
+typedef Math::Vector4<Float> Vector4;
+typedef Math::Matrix4<Float> Matrix4;
+typedef Math::Deg<Float> Deg;
+
+TransformBatchTest::TransformBatchTest() {
+    addTests({&TransformBatchTest::transformPoints,
+              &TransformBatchTest::transformPointsStrided,
+              &TransformBatchTest::transformPointsInPlace,
+              &TransformBatchTest::transformPointsProjective,
+              &TransformBatchTest::transformVectors,
+              &TransformBatchTest::transformVectorsStrided,
+              &TransformBatchTest::transformVectorsInPlace,
+              &TransformBatchTest::transform,
+
+              &TransformBatchTest::assertions});
+}
+
+/* Not a multiple of four so both the SIMD code and the remainder get
+   tested */
+constexpr std::size_t Count = 37;
+
+const Matrix4 Transformation =
+    Matrix4::translation({1.0f, -2.5f, 3.0f})*
+    Matrix4::rotation(Deg(35.0f), Vector3{1.0f, 2.0f, -0.5f}.normalized())*
+    Matrix4::scaling({2.0f, 0.5f, -1.5f});
+
+template<class T> T value(std::size_t i) {
+    T out;
+    for(std::size_t j = 0; j != T::Size; ++j)
+        out[j] = Float((i*7 + j*13) % 23) - 11.5f;
+    return out;
+}
+
+struct Vertex {
+    Vector3 position;
+    Float padding;
+};
+
+void TransformBatchTest::transformPoints() {
+    Vector3 src[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = value<Vector3>(i);
+        expected[i] = Transformation.transformPoint(src[i]);
+    }
+
+    Vector3 dst[Count];
+    transformPointsInto(Transformation, src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::transformPointsStrided() {
+    Vertex src[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i].position = value<Vector3>(i);
+        src[i].padding = 1337.0f;
+        expected[i] = Transformation.transformPoint(src[i].position);
+    }
+
+    Vertex dst[Count];
+    for(Vertex& i: dst) i.padding = 1337.0f;
+    transformPointsInto(Transformation,
+        Corrade::Containers::stridedArrayView(src, &src[0].position, Count, sizeof(Vertex)),
+        Corrade::Containers::stridedArrayView(dst, &dst[0].position, Count, sizeof(Vertex)));
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i].position, expected[i]);
+        /* The padding shouldn't get overwritten */
+        CORRADE_COMPARE(dst[i].padding, 1337.0f);
+    }
+}
+
+void TransformBatchTest::transformPointsInPlace() {
+    Vector3 data[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        data[i] = value<Vector3>(i);
+        expected[i] = Transformation.transformPoint(data[i]);
+    }
+
+    transformPointsInto(Transformation, data, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::transformPointsProjective() {
+    /* The W component is not 1 here, so the division gets tested as well */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(75.0f), 1.5f, 0.1f, 100.0f)*Transformation;
+
+    Vector3 src[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = value<Vector3>(i);
+        expected[i] = projection.transformPoint(src[i]);
+    }
+
+    Vector3 dst[Count];
+    transformPointsInto(projection, src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::transformVectors() {
+    Vector3 src[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = value<Vector3>(i);
+        expected[i] = Transformation.transformVector(src[i]);
+    }
+
+    Vector3 dst[Count];
+    transformVectorsInto(Transformation, src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::transformVectorsStrided() {
+    Vertex src[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i].position = value<Vector3>(i);
+        src[i].padding = 1337.0f;
+        expected[i] = Transformation.transformVector(src[i].position);
+    }
+
+    Vertex dst[Count];
+    for(Vertex& i: dst) i.padding = 1337.0f;
+    transformVectorsInto(Transformation,
+        Corrade::Containers::stridedArrayView(src, &src[0].position, Count, sizeof(Vertex)),
+        Corrade::Containers::stridedArrayView(dst, &dst[0].position, Count, sizeof(Vertex)));
+    for(std::size_t i = 0; i != Count; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(dst[i].position, expected[i]);
+        CORRADE_COMPARE(dst[i].padding, 1337.0f);
+    }
+}
+
+void TransformBatchTest::transformVectorsInPlace() {
+    Vector3 data[Count];
+    Vector3 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        data[i] = value<Vector3>(i);
+        expected[i] = Transformation.transformVector(data[i]);
+    }
+
+    transformVectorsInto(Transformation, data, data);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(data),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::transform() {
+    Vector4 src[Count];
+    Vector4 expected[Count];
+    for(std::size_t i = 0; i != Count; ++i) {
+        src[i] = value<Vector4>(i);
+        expected[i] = Transformation*src[i];
+    }
+
+    Vector4 dst[Count];
+    transformInto(Transformation, src, dst);
+    CORRADE_COMPARE_AS(Corrade::Containers::arrayView(dst),
+        Corrade::Containers::arrayView(expected),
+        Corrade::TestSuite::Compare::Container);
+}
+
+void TransformBatchTest::assertions() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 src3[2]{};
+    Vector3 dst3[3]{};
+    Vector4 src4[2]{};
+    Vector4 dst4[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    transformPointsInto(Transformation, src3, dst3);
+    transformVectorsInto(Transformation, src3, dst3);
+    transformInto(Transformation, src4, dst4);
+    CORRADE_COMPARE(out.str(),
+        "Math::transformPointsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformVectorsInto(): wrong destination size, got 3 but expected 2\n"
+        "Math::transformInto(): wrong destination size, got 3 but expected 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Math::Test::TransformBatchTest)
@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TransformBatch.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Math {
+
+namespace {
+
+/* If both views are contiguous, the SIMD kernels below process four values
+   at a time, deinterleaving them to a structure-of-arrays layout so each
+   output component is just three or four multiply-adds with a broadcast
+   matrix element. Strided views and the remainder are processed one value at
+   a time with a matrix column in each register, which is still faster than
+   the scalar code. The additions are done in the same order as in
+   RectangularMatrix::operator*() and without FMA, so the output is the same
+   as with the scalar code. */
+
+#if !defined(CORRADE_TARGET_SSE2) && !defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+namespace Scalar {
+
+template<bool point> void transform3(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = point ? matrix.transformPoint(src[i]) : matrix.transformVector(src[i]);
+}
+
+void transform4(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst) {
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dst[i] = matrix*src[i];
+}
+
+}
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+template<bool point> void transform3(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    const Float* const m = matrix.data();
+    std::size_t i = 0;
+
+    if(src.isContiguous() && dst.isContiguous()) {
+        /* Each matrix element is broadcast to all lanes, the last row is
+           needed only for points */
+        const __m128 m00 = _mm_set1_ps(m[0]), m10 = _mm_set1_ps(m[4]), m20 = _mm_set1_ps(m[8]), m30 = _mm_set1_ps(m[12]);
+        const __m128 m01 = _mm_set1_ps(m[1]), m11 = _mm_set1_ps(m[5]), m21 = _mm_set1_ps(m[9]), m31 = _mm_set1_ps(m[13]);
+        const __m128 m02 = _mm_set1_ps(m[2]), m12 = _mm_set1_ps(m[6]), m22 = _mm_set1_ps(m[10]), m32 = _mm_set1_ps(m[14]);
+        const __m128 m03 = _mm_set1_ps(m[3]), m13 = _mm_set1_ps(m[7]), m23 = _mm_set1_ps(m[11]), m33 = _mm_set1_ps(m[15]);
+
+        for(; i + 4 <= src.size(); i += 4) {
+            const Float* const s = src[i].data();
+            Float* const d = dst[i].data();
+
+            /* x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3 to x0 x1 x2 x3,
+               y0 y1 y2 y3, z0 z1 z2 z3 */
+            const __m128 a = _mm_loadu_ps(s);
+            const __m128 b = _mm_loadu_ps(s + 4);
+            const __m128 c = _mm_loadu_ps(s + 8);
+            const __m128 x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+            const __m128 y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+            __m128 ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m10, y)), _mm_mul_ps(m20, z));
+            __m128 oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m01, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m21, z));
+            __m128 oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m02, x), _mm_mul_ps(m12, y)), _mm_mul_ps(m22, z));
+            if(point) {
+                const __m128 ow = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m03, x), _mm_mul_ps(m13, y)), _mm_mul_ps(m23, z)), m33);
+                ox = _mm_div_ps(_mm_add_ps(ox, m30), ow);
+                oy = _mm_div_ps(_mm_add_ps(oy, m31), ow);
+                oz = _mm_div_ps(_mm_add_ps(oz, m32), ow);
+            }
+
+            /* And back to x0 y0 z0 x1, y1 z1 x2 y2, z2 x3 y3 z3 */
+            _mm_storeu_ps(d, _mm_shuffle_ps(_mm_shuffle_ps(ox, oy, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(oz, ox, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(d + 4, _mm_shuffle_ps(_mm_shuffle_ps(oy, oz, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(ox, oy, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(d + 8, _mm_shuffle_ps(_mm_shuffle_ps(oz, ox, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(oy, oz, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+        }
+    }
+
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    for(; i != src.size(); ++i) {
+        const Float* const s = src[i].data();
+        Float* const d = dst[i].data();
+
+        __m128 o = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(s[0])), _mm_mul_ps(c1, _mm_set1_ps(s[1]))), _mm_mul_ps(c2, _mm_set1_ps(s[2])));
+        if(point) {
+            o = _mm_add_ps(o, c3);
+            o = _mm_div_ps(o, _mm_shuffle_ps(o, o, _MM_SHUFFLE(3, 3, 3, 3)));
+        }
+
+        /* Storing just the first three components to not overwrite what's
+           after */
+        _mm_storel_pi(reinterpret_cast<__m64*>(d), o);
+        _mm_store_ss(d + 2, _mm_movehl_ps(o, o));
+    }
+}
+
+void transform4(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst) {
+    const Float* const m = matrix.data();
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const __m128 s = _mm_loadu_ps(src[i].data());
+        _mm_storeu_ps(dst[i].data(), _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c0, _mm_shuffle_ps(s, s, _MM_SHUFFLE(0, 0, 0, 0))),
+            _mm_mul_ps(c1, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm_mul_ps(c2, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 2, 2)))),
+            _mm_mul_ps(c3, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 3)))));
+    }
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+template<bool point> void transform3(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    const Float* const m = matrix.data();
+    std::size_t i = 0;
+
+    if(src.isContiguous() && dst.isContiguous()) {
+        const float32x4_t m00 = vdupq_n_f32(m[0]), m10 = vdupq_n_f32(m[4]), m20 = vdupq_n_f32(m[8]), m30 = vdupq_n_f32(m[12]);
+        const float32x4_t m01 = vdupq_n_f32(m[1]), m11 = vdupq_n_f32(m[5]), m21 = vdupq_n_f32(m[9]), m31 = vdupq_n_f32(m[13]);
+        const float32x4_t m02 = vdupq_n_f32(m[2]), m12 = vdupq_n_f32(m[6]), m22 = vdupq_n_f32(m[10]), m32 = vdupq_n_f32(m[14]);
+        const float32x4_t m03 = vdupq_n_f32(m[3]), m13 = vdupq_n_f32(m[7]), m23 = vdupq_n_f32(m[11]), m33 = vdupq_n_f32(m[15]);
+
+        for(; i + 4 <= src.size(); i += 4) {
+            /* The structured load and store does the deinterleaving */
+            const float32x4x3_t in = vld3q_f32(src[i].data());
+            const float32x4_t x = in.val[0], y = in.val[1], z = in.val[2];
+
+            float32x4x3_t out;
+            out.val[0] = vaddq_f32(vaddq_f32(vmulq_f32(m00, x), vmulq_f32(m10, y)), vmulq_f32(m20, z));
+            out.val[1] = vaddq_f32(vaddq_f32(vmulq_f32(m01, x), vmulq_f32(m11, y)), vmulq_f32(m21, z));
+            out.val[2] = vaddq_f32(vaddq_f32(vmulq_f32(m02, x), vmulq_f32(m12, y)), vmulq_f32(m22, z));
+            if(point) {
+                const float32x4_t w = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_f32(m03, x), vmulq_f32(m13, y)), vmulq_f32(m23, z)), m33);
+                out.val[0] = vdivq_f32(vaddq_f32(out.val[0], m30), w);
+                out.val[1] = vdivq_f32(vaddq_f32(out.val[1], m31), w);
+                out.val[2] = vdivq_f32(vaddq_f32(out.val[2], m32), w);
+            }
+            vst3q_f32(dst[i].data(), out);
+        }
+    }
+
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+    for(; i != src.size(); ++i) {
+        const Float* const s = src[i].data();
+        Float* const d = dst[i].data();
+
+        float32x4_t o = vaddq_f32(vaddq_f32(vmulq_f32(c0, vdupq_n_f32(s[0])), vmulq_f32(c1, vdupq_n_f32(s[1]))), vmulq_f32(c2, vdupq_n_f32(s[2])));
+        if(point) {
+            o = vaddq_f32(o, c3);
+            o = vdivq_f32(o, vdupq_laneq_f32(o, 3));
+        }
+
+        vst1_f32(d, vget_low_f32(o));
+        vst1q_lane_f32(d + 2, o, 2);
+    }
+}
+
+void transform4(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst) {
+    const Float* const m = matrix.data();
+    const float32x4_t c0 = vld1q_f32(m);
+    const float32x4_t c1 = vld1q_f32(m + 4);
+    const float32x4_t c2 = vld1q_f32(m + 8);
+    const float32x4_t c3 = vld1q_f32(m + 12);
+    for(std::size_t i = 0; i != src.size(); ++i) {
+        const float32x4_t s = vld1q_f32(src[i].data());
+        vst1q_f32(dst[i].data(), vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_f32(c0, vdupq_laneq_f32(s, 0)),
+            vmulq_f32(c1, vdupq_laneq_f32(s, 1))),
+            vmulq_f32(c2, vdupq_laneq_f32(s, 2))),
+            vmulq_f32(c3, vdupq_laneq_f32(s, 3))));
+    }
+}
+
+}
+#endif
+
+#if defined(CORRADE_TARGET_SSE2)
+namespace Simd = Sse2;
+#elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+namespace Simd = Neon;
+#else
+namespace Simd = Scalar;
+#endif
+
+}
+
+void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformPointsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::transform3<true>(matrix, src, dst);
+}
+
+void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformVectorsInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::transform3<false>(matrix, src, dst);
+}
+
+void transformInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst) {
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "Math::transformInto(): wrong destination size, got" << dst.size() << "but expected" << src.size(), );
+
+    Simd::transform4(matrix, src, dst);
+}
+
+}}
@@ -0,0 +1,104 @@
+#ifndef Magnum_Math_TransformBatch_h
+#define Magnum_Math_TransformBatch_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Math::transformPointsInto(), @ref Magnum::Math::transformVectorsInto(), @ref Magnum::Math::transformInto()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Types.h"
+#include "Magnum/Math/Math.h"
+#include "Magnum/visibility.h"
+
+namespace Magnum { namespace Math {
+
+/**
+@{ @name Batch transformation functions
+
+These functions transform an ubounded range of points or vectors with a single
+matrix, as opposed to @ref Matrix4::transformPoint() and
+@ref Matrix4::transformVector() operating on a single value.
+
+The source and destination views are allowed to be the same view, in which
+case the transformation is done in-place, but they shouldn't partially
+overlap. If both views are contiguous, the values are processed four at a
+time in a structure-of-arrays layout, otherwise one at a time. On x86 the
+functions use SSE2 instructions, on ARM64 NEON instructions. The operations
+are done in the same order as in the scalar code and no fused multiply-add is
+used, so the output matches the per-value functions.
+*/
+
+/**
+@brief Transform 3D points with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source points
+@param[out] dst     Destination points
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::transformPoint() on each value of @p src,
+including the division by the resulting W component. Expects that @p src and
+@p dst have the same size.
+@see @ref MeshTools::transformPointsInPlace()
+*/
+MAGNUM_EXPORT void transformPointsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform 3D vectors with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to calling @ref Matrix4::transformVector() on each value of
+@p src, i.e. the translation part of the matrix is ignored. Expects that
+@p src and @p dst have the same size.
+@see @ref MeshTools::transformVectorsInPlace()
+*/
+MAGNUM_EXPORT void transformVectorsInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector3<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector3<Float>>& dst);
+
+/**
+@brief Transform homogeneous 4D vectors with a matrix
+@param[in]  matrix  Transformation matrix
+@param[in]  src     Source vectors
+@param[out] dst     Destination vectors
+@m_since_latest
+
+Equivalent to multiplying each value of @p src with @p matrix. Unlike with
+@ref transformPointsInto(), no division by the W component is done. Expects
+that @p src and @p dst have the same size.
+*/
+MAGNUM_EXPORT void transformInto(const Matrix4<Float>& matrix, const Corrade::Containers::StridedArrayView1D<const Vector4<Float>>& src, const Corrade::Containers::StridedArrayView1D<Vector4<Float>>& dst);
+
+/**
+@}
+*/
+
+}}
+
+#endif
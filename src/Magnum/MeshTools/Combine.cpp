@@ -25,6 +25,7 @@
 
 #include "Combine.h"
 
+#include <cstring>
 #include <numeric>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Reference.h>
@@ -40,22 +41,136 @@ namespace Magnum { namespace MeshTools {
 
 namespace {
 
-Trade::MeshData combineIndexedImplementation(const MeshPrimitive primitive, Containers::Array<char>& combinedIndices, const UnsignedInt indexCount, const UnsignedInt indexStride, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> data) {
-    /* Calculate attribute count and vertex stride */
+/* Finds unique index tuples formed by the same row of all `components`,
+   writes a combined index for each row to `indices` and returns the unique
+   tuple count. The first returned-count items of `representatives` are then
+   rows containing each unique tuple. The result is the same as with
+   removeDuplicatesInPlaceInto() on the tuples, i.e. the unique tuples are
+   numbered in order of first occurence, but instead of hashing
+   runtime-sized keys the rows are grouped by a stable LSD radix sort over
+   bytes of the tuples. Bytes that are the same for all rows (such as upper
+   bytes of 32-bit indices in smaller meshes) are skipped. The tuples are
+   read directly from `components`, so besides the output only two arrays of
+   row IDs are needed. */
+UnsignedInt combineIndicesInto(const Containers::ArrayView<const Containers::StridedArrayView2D<const char>> components, const Containers::ArrayView<UnsignedInt> indices, Containers::Array<UnsignedInt>& representatives) {
+    const std::size_t indexCount = indices.size();
+    if(!indexCount) return 0;
+
+    /* Calculate histograms of all bytes in a single pass */
+    std::size_t byteCount = 0;
+    for(const Containers::StridedArrayView2D<const char>& component: components)
+        byteCount += component.size()[1];
+    Containers::Array<UnsignedInt> histograms{Containers::ValueInit, byteCount*256};
+    {
+        std::size_t byte = 0;
+        for(const Containers::StridedArrayView2D<const char>& component: components) {
+            const char* const data = static_cast<const char*>(component.data());
+            const std::ptrdiff_t stride = component.stride()[0];
+            for(std::size_t b = 0; b != component.size()[1]; ++b, ++byte) {
+                UnsignedInt* const histogram = histograms + byte*256;
+                for(std::size_t i = 0; i != indexCount; ++i)
+                    ++histogram[UnsignedByte(data[i*stride + b])];
+            }
+        }
+    }
+
+    /* Sort the row IDs, going from the least significant byte. The order of
+       bytes doesn't matter as we're only interested in grouping equal
+       tuples, not in any particular order of them. */
+    Containers::Array<UnsignedInt> order{Containers::NoInit, indexCount};
+    Containers::Array<UnsignedInt> sorted{Containers::NoInit, indexCount};
+    std::iota(order.begin(), order.end(), 0u);
+    {
+        std::size_t byte = 0;
+        for(const Containers::StridedArrayView2D<const char>& component: components) {
+            const char* const data = static_cast<const char*>(component.data());
+            const std::ptrdiff_t stride = component.stride()[0];
+            for(std::size_t b = 0; b != component.size()[1]; ++b, ++byte) {
+                UnsignedInt* const histogram = histograms + byte*256;
+
+                /* All rows have the same value of this byte, nothing to do */
+                if(histogram[UnsignedByte(data[b])] == indexCount) continue;
+
+                /* Turn the histogram into offsets and scatter the row IDs */
+                UnsignedInt offset = 0;
+                for(std::size_t i = 0; i != 256; ++i) {
+                    const UnsignedInt count = histogram[i];
+                    histogram[i] = offset;
+                    offset += count;
+                }
+                for(const UnsignedInt row: order)
+                    sorted[histogram[UnsignedByte(data[row*stride + b])]++] = row;
+                std::swap(order, sorted);
+            }
+        }
+    }
+
+    /* Equal tuples are now next to each other and because the sort is stable,
+       the first row in each group is where the tuple occured first. Remember
+       the first row of the group for every row. */
+    const auto equal = [&](const UnsignedInt a, const UnsignedInt b) {
+        for(const Containers::StridedArrayView2D<const char>& component: components) {
+            if(std::memcmp(component[a].data(), component[b].data(), component.size()[1]) != 0)
+                return false;
+        }
+        return true;
+    };
+    Containers::ArrayView<UnsignedInt> first = sorted;
+    first[order[0]] = order[0];
+    for(std::size_t i = 1; i != indexCount; ++i)
+        first[order[i]] = equal(order[i], order[i - 1]) ?
+            first[order[i - 1]] : order[i];
+
+    /* Number the unique tuples in order of their first occurence. The first
+       occurence is always before all others, so its index is already known
+       when encountering the others. The sorted row IDs are not needed
+       anymore, so the array is reused for the representatives. */
+    UnsignedInt uniqueCount = 0;
+    for(std::size_t i = 0; i != indexCount; ++i) {
+        if(first[i] == i) {
+            order[uniqueCount] = UnsignedInt(i);
+            indices[i] = uniqueCount++;
+        } else indices[i] = indices[first[i]];
+    }
+
+    representatives = std::move(order);
+    return uniqueCount;
+}
+
+Trade::MeshData combineIndexedImplementation(const MeshPrimitive primitive, const Containers::ArrayView<const Containers::StridedArrayView2D<const char>> components, const UnsignedInt indexCount, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> data) {
+    /* Calculate attribute count, vertex stride and combined index stride */
     UnsignedInt attributeCount = 0;
     UnsignedInt vertexStride = 0;
+    UnsignedInt indexStride = 0;
     for(std::size_t i = 0; i != data.size(); ++i) {
         attributeCount += data[i]->attributeCount();
         for(UnsignedInt j = 0; j != data[i]->attributeCount(); ++j)
             vertexStride += vertexFormatSize(data[i]->attributeFormat(j))*Math::max(data[i]->attributeArraySize(j), UnsignedShort{1});
+        indexStride += components[i].size()[1];
     }
 
-    /* Make the combined index array unique */
+    /* Find unique index combinations */
     Containers::Array<char> indexData{indexCount*sizeof(UnsignedInt)};
     const auto indexDataI = Containers::arrayCast<UnsignedInt>(indexData);
-    const UnsignedInt vertexCount = removeDuplicatesInPlaceInto(
-        Containers::StridedArrayView2D<char>{combinedIndices, {indexCount, indexStride}},
-        indexDataI);
+    Containers::Array<UnsignedInt> representatives;
+    const UnsignedInt vertexCount = combineIndicesInto(components, indexDataI, representatives);
+
+    /* Gather the unique index combinations into a combined index array */
+    Containers::Array<char> combinedIndices{Containers::NoInit,
+        vertexCount*indexStride};
+    {
+        const Containers::StridedArrayView1D<const UnsignedInt> representativesView = representatives.prefix(vertexCount);
+        std::size_t indexOffset = 0;
+        for(const Containers::StridedArrayView2D<const char>& component: components) {
+            const std::size_t indexSize = component.size()[1];
+            duplicateInto(representativesView, component,
+                Containers::StridedArrayView2D<char>{combinedIndices,
+                    combinedIndices.data() + indexOffset,
+                    {vertexCount, indexSize},
+                    {std::ptrdiff_t(indexStride), 1}});
+            indexOffset += indexSize;
+        }
+    }
 
     /* Allocate resulting attribute and vertex data and duplicate the
        attributes there according to the combined index buffer */
@@ -66,9 +181,9 @@ Trade::MeshData combineIndexedImplementation(const MeshPrimitive primitive, Cont
         std::size_t indexOffset = 0;
         std::size_t attributeOffset = 0;
         std::size_t vertexOffset = 0;
-        for(const Trade::MeshData& mesh: data) {
-            const UnsignedInt indexSize = mesh.isIndexed() ?
-                meshIndexTypeSize(mesh.indexType()) : 4;
+        for(std::size_t m = 0; m != data.size(); ++m) {
+            const Trade::MeshData& mesh = data[m];
+            const std::size_t indexSize = components[m].size()[1];
             Containers::StridedArrayView2D<const char> indices{combinedIndices,
                 combinedIndices.data() + indexOffset,
                 {vertexCount, indexSize},
@@ -84,7 +199,7 @@ Trade::MeshData combineIndexedImplementation(const MeshPrimitive primitive, Cont
                 vertexOffset += src.size()[1];
                 attributeData[attributeOffset++] = Trade::MeshAttributeData{
                     mesh.attributeName(i), mesh.attributeFormat(i), dst,
-                    mesh.attributeArraySize(i)};
+                    mesh.attributeArraySize(i), mesh.attributeMorphTargetId(i)};
             }
 
             indexOffset += indexSize;
@@ -112,7 +227,6 @@ Trade::MeshData combineIndexedAttributes(const Containers::ArrayView<const Conta
        uninitialized" in the assert below */
     MeshPrimitive primitive{};
     UnsignedInt indexCount{};
-    UnsignedInt indexStride = 0;
     for(std::size_t i = 0; i != data.size(); ++i) {
         CORRADE_ASSERT(data[i]->isIndexed(),
             "MeshTools::combineIndexedAttributes(): data" << i << "is not indexed",
@@ -126,32 +240,19 @@ Trade::MeshData combineIndexedAttributes(const Containers::ArrayView<const Conta
             CORRADE_ASSERT(data[i]->indexCount() == indexCount,
                 "MeshTools::combineIndexedAttributes(): data" << i << "has" << data[i]->indexCount() << "indices but expected" << indexCount, (Trade::MeshData{MeshPrimitive{}, 0}));
         }
-        indexStride += meshIndexTypeSize(data[i]->indexType());
     }
 
-    /** @todo handle alignment in the above somehow (duplicate() will fail when
-        reading 32-bit values from odd addresses on some platforms) */
+    /** @todo handle alignment in the combined index array somehow
+        (duplicate() will fail when reading 32-bit values from odd addresses
+        on some platforms) */
 
-    /* Create a combined index array */
-    Containers::Array<char> combinedIndices{Containers::NoInit,
-        indexCount*indexStride};
-    {
-        std::size_t indexOffset = 0;
-        for(const Trade::MeshData& mesh: data) {
-            const UnsignedInt indexSize = meshIndexTypeSize(mesh.indexType());
-            Containers::StridedArrayView2D<char> dst{combinedIndices,
-                combinedIndices.data() + indexOffset,
-                {indexCount, indexSize},
-                {std::ptrdiff_t(indexStride), 1}};
-            Utility::copy(mesh.indices(), dst);
-            indexOffset += indexSize;
-        }
-
-        /* Check we pre-calculated correctly */
-        CORRADE_INTERNAL_ASSERT(indexOffset == indexStride);
-    }
+    /* The index tuples are read directly from the index arrays, without
+       making an interleaved copy of them first */
+    Containers::Array<Containers::StridedArrayView2D<const char>> components{data.size()};
+    for(std::size_t i = 0; i != data.size(); ++i)
+        components[i] = data[i]->indices();
 
-    return combineIndexedImplementation(primitive, combinedIndices, indexCount, indexStride, data);
+    return combineIndexedImplementation(primitive, components, indexCount, data);
 }
 
 Trade::MeshData combineIndexedAttributes(std::initializer_list<Containers::Reference<const Trade::MeshData>> data) {
@@ -206,8 +307,15 @@ Trade::MeshData combineFaceAttributes(const Trade::MeshData& mesh, const Trade::
     Utility::copy(combinedFaceIndices[0], combinedFaceIndices[2]);
 
     /* Then combine the two into a single buffer */
-    return combineIndexedImplementation(mesh.primitive(), combinedIndices,
-        meshIndexCount, indexStride,
+    const Containers::StridedArrayView2D<const char> components[]{
+        Containers::StridedArrayView2D<const char>{combinedIndices,
+            {meshIndexCount, meshIndexSize}, {std::ptrdiff_t(indexStride), 1}},
+        Containers::StridedArrayView2D<const char>{combinedIndices,
+            combinedIndices.data() + meshIndexSize,
+            {meshIndexCount, faceIndexSize}, {std::ptrdiff_t(indexStride), 1}}
+    };
+    return combineIndexedImplementation(mesh.primitive(), components,
+        meshIndexCount,
         Containers::arrayView<const Containers::Reference<const Trade::MeshData>>({
             mesh, faceAttributes
         }));
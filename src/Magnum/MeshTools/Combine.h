@@ -78,6 +78,11 @@ Vertex data unreferenced by the index buffers are discarded. This means the
 function can be also called with just a single argument to compact a mesh with
 a sparse index buffer.
 
+The unique index combinations are found with a radix sort over the index
+tuples, reading them directly from the index arrays of @p data. Besides the
+output, the temporary memory used is two 32-bit integers per index, which is
+independent of the count and types of the input index arrays.
+
 Expects that @p data is non-empty and all data have the same primitive and
 index count. All inputs have to be indexed, although the particular
 @ref MeshIndexType doesn't matter. For non-indexed attributes combining can be
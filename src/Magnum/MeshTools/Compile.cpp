@@ -25,22 +25,35 @@
 
 #include "Compile.h"
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 
 #include "Magnum/GL/Buffer.h"
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#endif
 #include "Magnum/GL/Mesh.h"
-#include "Magnum/Math/Vector3.h"
+#include "Magnum/GL/MeshView.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Concatenate.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Meshletize.h"
 #include "Magnum/Trade/MeshData.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <Corrade/Containers/ArrayViewStl.h>
 
 #include "Magnum/Math/Color.h"
-#include "Magnum/MeshTools/CompressIndices.h"
 #define _MAGNUM_NO_DEPRECATED_MESHDATA /* So it doesn't yell here */
 #include "Magnum/Trade/MeshData2D.h"
 #include "Magnum/Trade/MeshData3D.h"
@@ -54,6 +67,90 @@ namespace Magnum { namespace MeshTools {
 
 namespace {
 
+/* Returns a generic attribute definition for given mesh attribute in given
+   format, or NullOpt if the attribute should be skipped, printing a warning
+   for it unless suppressed. Attributes are bound only once for each location,
+   which is tracked in boundAttributes. */
+Containers::Optional<GL::DynamicAttribute> genericAttribute(const Trade::MeshData& meshData, const UnsignedInt i, const VertexFormat format, const CompileFlags flags, Math::BoolVector<16>& boundAttributes) {
+    Containers::Optional<GL::DynamicAttribute> attribute;
+
+    /* Ignore implementation-specific formats because GL needs three
+       separate values to describe them so there's no way to put them in a
+       single 32-bit value :( */
+    const VertexFormat originalFormat = meshData.attributeFormat(i);
+    if(isVertexFormatImplementationSpecific(originalFormat)) {
+        if(!(flags & CompileFlag::NoWarnOnCustomAttributes))
+            Warning{} << "MeshTools::compile(): ignoring attribute" << meshData.attributeName(i) << "with an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(originalFormat));
+        return {};
+    }
+
+    /* Morph target deltas aren't meant to be rendered directly, they're
+       consumed by Shaders::MorphTargets instead */
+    if(meshData.attributeMorphTargetId(i) != -1) return {};
+
+    switch(meshData.attributeName(i)) {
+        case Trade::MeshAttribute::Position:
+            /* Pick 3D position always, the format will properly reduce it
+               to a 2-component version if needed */
+            attribute.emplace(Shaders::Generic3D::Position{}, format);
+            break;
+        case Trade::MeshAttribute::TextureCoordinates:
+            /** @todo have Generic2D derived from Generic that has all
+                attribute definitions common for 2D and 3D */
+            attribute.emplace(Shaders::Generic2D::TextureCoordinates{}, format);
+            break;
+        case Trade::MeshAttribute::Color:
+            /** @todo have Generic2D derived from Generic that has all
+                attribute definitions common for 2D and 3D */
+            /* Pick Color4 always, the format will properly reduce it to a
+               3-component version if needed */
+            attribute.emplace(Shaders::Generic2D::Color4{}, format);
+            break;
+        case Trade::MeshAttribute::Tangent:
+            /* Pick Tangent4 always, the format will properly reduce it to
+               a 3-component version if needed */
+            attribute.emplace(Shaders::Generic3D::Tangent4{}, format);
+            break;
+        case Trade::MeshAttribute::Bitangent:
+            attribute.emplace(Shaders::Generic3D::Bitangent{}, format);
+            break;
+        case Trade::MeshAttribute::Normal:
+            attribute.emplace(Shaders::Generic3D::Normal{}, format);
+            break;
+        #ifndef MAGNUM_TARGET_GLES2
+        case Trade::MeshAttribute::ObjectId:
+            attribute.emplace(Shaders::Generic3D::ObjectId{}, format);
+            break;
+        #endif
+
+        /* To avoid the compiler warning that we didn't handle an enum
+           value. For these a runtime warning is printed below. */
+        /* LCOV_EXCL_START */
+        #ifdef MAGNUM_TARGET_GLES2
+        case Trade::MeshAttribute::ObjectId:
+        #endif
+        case Trade::MeshAttribute::Custom:
+            break;
+        /* LCOV_EXCL_STOP */
+    }
+
+    if(!attribute) {
+        if(!Trade::isMeshAttributeCustom(meshData.attributeName(i)) || !(flags & CompileFlag::NoWarnOnCustomAttributes))
+            Warning{} << "MeshTools::compile(): ignoring unknown/unsupported attribute" << meshData.attributeName(i);
+        return {};
+    }
+
+    /* Ensure each attribute gets bound only once -- so for example when
+       there are two texture coordinate sets, we don't bind them both to
+       the same slot, effectively ignoring the first one */
+    /** @todo revisit when there are secondary generic texture coordinates */
+    if(boundAttributes[attribute->location()])
+        return {};
+    boundAttributes.set(attribute->location(), true);
+
+    return attribute;
+}
+
 GL::Mesh compileInternal(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices, const CompileFlags flags) {
     /* Only this one flag is allowed at this point */
     CORRADE_INTERNAL_ASSERT(!(flags & ~CompileFlag::NoWarnOnCustomAttributes));
@@ -72,77 +169,8 @@ GL::Mesh compileInternal(const Trade::MeshData& meshData, GL::Buffer&& indices,
     Math::BoolVector<16> boundAttributes;
 
     for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i) {
-        Containers::Optional<GL::DynamicAttribute> attribute;
-
-        /* Ignore implementation-specific formats because GL needs three
-           separate values to describe them so there's no way to put them in a
-           single 32-bit value :( */
-        const VertexFormat format = meshData.attributeFormat(i);
-        if(isVertexFormatImplementationSpecific(format)) {
-            if(!(flags & CompileFlag::NoWarnOnCustomAttributes))
-                Warning{} << "MeshTools::compile(): ignoring attribute" << meshData.attributeName(i) << "with an implementation-specific format" << reinterpret_cast<void*>(vertexFormatUnwrap(format));
-            continue;
-        }
-
-        switch(meshData.attributeName(i)) {
-            case Trade::MeshAttribute::Position:
-                /* Pick 3D position always, the format will properly reduce it
-                   to a 2-component version if needed */
-                attribute.emplace(Shaders::Generic3D::Position{}, format);
-                break;
-            case Trade::MeshAttribute::TextureCoordinates:
-                /** @todo have Generic2D derived from Generic that has all
-                    attribute definitions common for 2D and 3D */
-                attribute.emplace(Shaders::Generic2D::TextureCoordinates{}, format);
-                break;
-            case Trade::MeshAttribute::Color:
-                /** @todo have Generic2D derived from Generic that has all
-                    attribute definitions common for 2D and 3D */
-                /* Pick Color4 always, the format will properly reduce it to a
-                   3-component version if needed */
-                attribute.emplace(Shaders::Generic2D::Color4{}, format);
-                break;
-            case Trade::MeshAttribute::Tangent:
-                /* Pick Tangent4 always, the format will properly reduce it to
-                   a 3-component version if needed */
-                attribute.emplace(Shaders::Generic3D::Tangent4{}, format);
-                break;
-            case Trade::MeshAttribute::Bitangent:
-                attribute.emplace(Shaders::Generic3D::Bitangent{}, format);
-                break;
-            case Trade::MeshAttribute::Normal:
-                attribute.emplace(Shaders::Generic3D::Normal{}, format);
-                break;
-            #ifndef MAGNUM_TARGET_GLES2
-            case Trade::MeshAttribute::ObjectId:
-                attribute.emplace(Shaders::Generic3D::ObjectId{}, format);
-                break;
-            #endif
-
-            /* To avoid the compiler warning that we didn't handle an enum
-               value. For these a runtime warning is printed below. */
-            /* LCOV_EXCL_START */
-            #ifdef MAGNUM_TARGET_GLES2
-            case Trade::MeshAttribute::ObjectId:
-            #endif
-            case Trade::MeshAttribute::Custom:
-                break;
-             /* LCOV_EXCL_STOP */
-        }
-
-        if(!attribute) {
-            if(!Trade::isMeshAttributeCustom(meshData.attributeName(i)) || !(flags & CompileFlag::NoWarnOnCustomAttributes))
-                Warning{} << "MeshTools::compile(): ignoring unknown/unsupported attribute" << meshData.attributeName(i);
-            continue;
-        }
-
-        /* Ensure each attribute gets bound only once -- so for example when
-           there are two texture coordinate sets, we don't bind them both to
-           the same slot, effectively ignoring the first one */
-        /** @todo revisit when there are secondary generic texture coordinates */
-        if(boundAttributes[attribute->location()])
-            continue;
-        boundAttributes.set(attribute->location(), true);
+        const Containers::Optional<GL::DynamicAttribute> attribute = genericAttribute(meshData, i, meshData.attributeFormat(i), flags, boundAttributes);
+        if(!attribute) continue;
 
         /* For the first attribute move the buffer in, for all others use the
            reference */
@@ -174,6 +202,128 @@ GL::Mesh compileInternal(const Trade::MeshData& meshData, const CompileFlags fla
     return compileInternal(meshData, std::move(indices), std::move(vertices), flags);
 }
 
+bool isFloat(const VertexFormat format) {
+    return vertexFormatComponentFormat(format) == VertexFormat::Float &&
+        vertexFormatVectorCount(format) == 1;
+}
+
+/* Uploads the data into an immutable storage if possible, the buffer
+   contents are never modified afterwards */
+void uploadImmutable(GL::Buffer& buffer, const Containers::ArrayView<const void> data) {
+    /* Zero-sized storage is an error, while zero-sized data is not */
+    #ifndef MAGNUM_TARGET_GLES
+    if(!data.empty() && GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>())
+        buffer.setStorage(data, {});
+    else
+    #endif
+    {
+        buffer.setData(data, GL::BufferUsage::StaticDraw);
+    }
+}
+
+GL::Mesh compilePacked(const Trade::MeshData& meshData, const Containers::ArrayView<const std::pair<Trade::MeshAttribute, VertexFormat>> formats, const CompileFlags flags) {
+    /* Pick attributes that get bound, in the target format, together with
+       their offsets in a tightly packed interleaved layout. Each attribute is
+       aligned to four bytes, as some drivers have performance issues
+       otherwise. */
+    struct Attribute {
+        UnsignedInt id;
+        VertexFormat format;
+        std::size_t offset;
+    };
+    Containers::Array<Attribute> attributes;
+    Math::BoolVector<16> boundAttributes;
+    std::size_t stride = 0;
+    for(UnsignedInt i = 0; i != meshData.attributeCount(); ++i) {
+        const VertexFormat originalFormat = meshData.attributeFormat(i);
+        VertexFormat format = originalFormat;
+        for(const std::pair<Trade::MeshAttribute, VertexFormat>& f: formats) {
+            if(f.first != meshData.attributeName(i)) continue;
+            format = f.second;
+            break;
+        }
+
+        CORRADE_ASSERT(format == originalFormat || (
+            !isVertexFormatImplementationSpecific(originalFormat) &&
+            isFloat(originalFormat) &&
+            !isVertexFormatImplementationSpecific(format) &&
+            vertexFormatComponentCount(format) == vertexFormatComponentCount(originalFormat) &&
+            vertexFormatVectorCount(format) == 1 &&
+            ((vertexFormatComponentFormat(format) == VertexFormat::Half && !isVertexFormatNormalized(format)) || (
+                (vertexFormatComponentFormat(format) == VertexFormat::Byte ||
+                 vertexFormatComponentFormat(format) == VertexFormat::UnsignedByte ||
+                 vertexFormatComponentFormat(format) == VertexFormat::Short ||
+                 vertexFormatComponentFormat(format) == VertexFormat::UnsignedShort) &&
+                isVertexFormatNormalized(format)))),
+            "MeshTools::compile(): can't convert" << meshData.attributeName(i) << "from" << originalFormat << "to" << format, GL::Mesh{});
+
+        if(!genericAttribute(meshData, i, format, flags, boundAttributes))
+            continue;
+
+        arrayAppend(attributes, Containers::InPlaceInit, i, format, stride);
+        stride += (vertexFormatSize(format)*Math::max(meshData.attributeArraySize(i), UnsignedShort{1}) + 3) & ~std::size_t{3};
+    }
+
+    /* Pack the attributes, converting them on the fly */
+    const UnsignedInt vertexCount = meshData.vertexCount();
+    Containers::Array<char> vertexData{Containers::NoInit, stride*vertexCount};
+    Containers::Array<Trade::MeshAttributeData> attributeData{attributes.size()};
+    for(std::size_t i = 0; i != attributes.size(); ++i) {
+        const Attribute& attribute = attributes[i];
+        const Containers::StridedArrayView2D<const char> src = meshData.attribute(attribute.id);
+        const Containers::StridedArrayView2D<char> dst{vertexData,
+            vertexData.data() + attribute.offset,
+            {vertexCount, vertexFormatSize(attribute.format)*Math::max(meshData.attributeArraySize(attribute.id), UnsignedShort{1})},
+            {std::ptrdiff_t(stride), 1}};
+
+        const VertexFormat componentFormat = vertexFormatComponentFormat(attribute.format);
+        if(attribute.format == meshData.attributeFormat(attribute.id))
+            Utility::copy(src, dst);
+        else if(componentFormat == VertexFormat::Half)
+            Math::packHalfInto(Containers::arrayCast<2, const Float>(src), Containers::arrayCast<2, UnsignedShort>(dst));
+        else if(componentFormat == VertexFormat::Byte)
+            Math::packInto(Containers::arrayCast<2, const Float>(src), Containers::arrayCast<2, Byte>(dst));
+        else if(componentFormat == VertexFormat::UnsignedByte)
+            Math::packInto(Containers::arrayCast<2, const Float>(src), Containers::arrayCast<2, UnsignedByte>(dst));
+        else if(componentFormat == VertexFormat::Short)
+            Math::packInto(Containers::arrayCast<2, const Float>(src), Containers::arrayCast<2, Short>(dst));
+        else if(componentFormat == VertexFormat::UnsignedShort)
+            Math::packInto(Containers::arrayCast<2, const Float>(src), Containers::arrayCast<2, UnsignedShort>(dst));
+        else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+        attributeData[i] = Trade::MeshAttributeData{
+            meshData.attributeName(attribute.id), attribute.format,
+            Containers::StridedArrayView1D<const void>{vertexData,
+                vertexData.data() + attribute.offset, vertexCount,
+                std::ptrdiff_t(stride)},
+            meshData.attributeArraySize(attribute.id)};
+    }
+
+    /* Upload just the index range, not any data around it */
+    Containers::ArrayView<const char> indexData;
+    Trade::MeshIndexData indices;
+    if(meshData.isIndexed()) {
+        indexData = meshData.indexData().slice(meshData.indexOffset(), meshData.indexOffset() + meshData.indexCount()*meshIndexTypeSize(meshData.indexType()));
+        indices = Trade::MeshIndexData{meshData.indexType(), indexData};
+    }
+    const Trade::MeshData packed{meshData.primitive(),
+        {}, indexData, indices,
+        {}, vertexData, std::move(attributeData), vertexCount};
+
+    GL::Buffer indexBuffer{NoCreate};
+    if(packed.isIndexed()) {
+        indexBuffer = GL::Buffer{GL::Buffer::TargetHint::ElementArray};
+        uploadImmutable(indexBuffer, indexData);
+    }
+
+    GL::Buffer vertexBuffer{GL::Buffer::TargetHint::Array};
+    uploadImmutable(vertexBuffer, vertexData);
+
+    /* All remaining attributes get bound, so there's nothing to warn about
+       anymore */
+    return compileInternal(packed, std::move(indexBuffer), std::move(vertexBuffer), CompileFlag::NoWarnOnCustomAttributes);
+}
+
 }
 
 GL::Mesh compile(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices) {
@@ -196,7 +346,25 @@ GL::Mesh compile(const Trade::MeshData& meshData) {
     return compileInternal(meshData, {});
 }
 
-GL::Mesh compile(const Trade::MeshData& meshData, CompileFlags flags) {
+GL::Mesh compile(const Trade::MeshData& meshData, const Meshlets& meshlets, GL::Buffer& meshletBuffer) {
+    CORRADE_ASSERT(meshData.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::compile(): expected a MeshPrimitive::Triangles mesh but got" << meshData.primitive(), GL::Mesh{});
+
+    /* Replace the index buffer with indices in meshlet order, keep the
+       vertex data as-is */
+    const Containers::Array<UnsignedInt> indices = meshlets.indicesAsArray();
+    const Trade::MeshData meshletMeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, meshData.vertexData(), Trade::meshAttributeDataNonOwningArray(meshData.attributeData()),
+        meshData.vertexCount()};
+
+    meshletBuffer.setData(meshlets.meshlets());
+    return compileInternal(meshletMeshData, {});
+}
+
+namespace {
+
+GL::Mesh compileImplementation(const Trade::MeshData& meshData, const Containers::ArrayView<const std::pair<Trade::MeshAttribute, VertexFormat>> formats, CompileFlags flags) {
     /* If we want to generate normals, prepare a new mesh data and recurse,
        with the flags unset */
     if(meshData.primitive() == MeshPrimitive::Triangles && (flags & (CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals))) {
@@ -239,14 +407,108 @@ GL::Mesh compile(const Trade::MeshData& meshData, CompileFlags flags) {
                 generated.attribute<Vector3>(Trade::MeshAttribute::Position),
                 generated.mutableAttribute<Vector3>(Trade::MeshAttribute::Normal));
 
-        return compile(generated, flags & ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals));
+        return compileImplementation(generated, formats, flags & ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals));
+    }
+
+    /* Same for tangents. If normals were requested as well, they're already
+       generated at this point. */
+    if(meshData.primitive() == MeshPrimitive::Triangles && (flags & CompileFlag::GenerateTangents)) {
+        CORRADE_ASSERT(meshData.attributeCount(Trade::MeshAttribute::Position) &&
+                       meshData.attributeCount(Trade::MeshAttribute::Normal) &&
+                       meshData.attributeCount(Trade::MeshAttribute::TextureCoordinates),
+            "MeshTools::compile(): the mesh needs positions, normals and texture coordinates to generate tangents", GL::Mesh{});
+        CORRADE_ASSERT(meshData.attributeFormat(Trade::MeshAttribute::Position) == VertexFormat::Vector3 &&
+                       meshData.attributeFormat(Trade::MeshAttribute::Normal) == VertexFormat::Vector3 &&
+                       meshData.attributeFormat(Trade::MeshAttribute::TextureCoordinates) == VertexFormat::Vector2,
+            "MeshTools::compile(): can't generate tangents for" << meshData.attributeFormat(Trade::MeshAttribute::Position) << "positions," << meshData.attributeFormat(Trade::MeshAttribute::Normal) << "normals and" << meshData.attributeFormat(Trade::MeshAttribute::TextureCoordinates) << "texture coordinates", GL::Mesh{});
+
+        /* If the data already have a four-component tangent array, reuse its
+           location, otherwise mix in an extra one */
+        Trade::MeshAttributeData tangentAttribute;
+        Containers::ArrayView<const Trade::MeshAttributeData> extra;
+        if(!meshData.hasAttribute(Trade::MeshAttribute::Tangent)) {
+            tangentAttribute = Trade::MeshAttributeData{
+                Trade::MeshAttribute::Tangent, VertexFormat::Vector4,
+                nullptr};
+            extra = {&tangentAttribute, 1};
+        } else CORRADE_ASSERT(meshData.attributeFormat(Trade::MeshAttribute::Tangent) == VertexFormat::Vector4,
+            "MeshTools::compile(): can't generate tangents into" << meshData.attributeFormat(Trade::MeshAttribute::Tangent), GL::Mesh{});
+
+        Trade::MeshData generated = interleave(meshData, extra);
+        if(generated.isIndexed())
+            generateTangentsInto(generated.indices(),
+                generated.attribute<Vector3>(Trade::MeshAttribute::Position),
+                generated.attribute<Vector3>(Trade::MeshAttribute::Normal),
+                generated.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+                generated.mutableAttribute<Vector4>(Trade::MeshAttribute::Tangent));
+        else
+            generateTangentsInto(
+                generated.attribute<Vector3>(Trade::MeshAttribute::Position),
+                generated.attribute<Vector3>(Trade::MeshAttribute::Normal),
+                generated.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+                generated.mutableAttribute<Vector4>(Trade::MeshAttribute::Tangent));
+
+        return compileImplementation(generated, formats, flags & ~CompileFlag::GenerateTangents);
     }
 
-    flags &= ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals);
+    flags &= ~(CompileFlag::GenerateFlatNormals|CompileFlag::GenerateSmoothNormals|CompileFlag::GenerateTangents);
+    if(flags & CompileFlag::PackAttributes)
+        return compilePacked(meshData, formats, flags & ~CompileFlag::PackAttributes);
     CORRADE_INTERNAL_ASSERT(!(flags & ~CompileFlag::NoWarnOnCustomAttributes));
     return compileInternal(meshData, flags);
 }
 
+}
+
+GL::Mesh compile(const Trade::MeshData& meshData, const CompileFlags flags) {
+    return compileImplementation(meshData, nullptr, flags);
+}
+
+GL::Mesh compile(const Trade::MeshData& meshData, const Containers::ArrayView<const std::pair<Trade::MeshAttribute, VertexFormat>> formats, const CompileFlags flags) {
+    return compileImplementation(meshData, formats, flags|CompileFlag::PackAttributes);
+}
+
+GL::Mesh compile(const Trade::MeshData& meshData, const std::initializer_list<std::pair<Trade::MeshAttribute, VertexFormat>> formats, const CompileFlags flags) {
+    return compile(meshData, Containers::arrayView(formats), flags);
+}
+
+Containers::Array<GL::MeshView> compile(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, GL::Mesh& mesh, const CompileFlags flags) {
+    CORRADE_ASSERT(!meshes.empty(),
+        "MeshTools::compile(): no meshes passed", {});
+
+    /* All meshes go into a single vertex and index buffer, with indices
+       already adjusted for vertex offsets so no base vertex is needed */
+    Trade::MeshData concatenated = concatenate(meshes);
+    if(concatenated.isIndexed())
+        concatenated = compressIndices(std::move(concatenated));
+    mesh = compile(concatenated, flags);
+
+    /* If any mesh is indexed, the concatenated mesh has trivial indices
+       generated for the non-indexed ones, so each mesh occupies either its
+       index count or its vertex count. Flat normal generation turns an
+       indexed mesh into a non-indexed one in the original index order, so the
+       ranges stay the same, only referencing vertices instead of indices. */
+    Containers::Array<GL::MeshView> views{Containers::NoInit, meshes.size()};
+    Int offset = 0;
+    for(std::size_t i = 0; i != meshes.size(); ++i) {
+        const Trade::MeshData& meshData = meshes[i];
+        const Int count = meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount();
+
+        GL::MeshView& view = *new(&views[i]) GL::MeshView{mesh};
+        view.setCount(count);
+        if(mesh.isIndexed()) view.setIndexRange(offset);
+        else view.setBaseVertex(offset);
+
+        offset += count;
+    }
+
+    return views;
+}
+
+Containers::Array<GL::MeshView> compile(const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, GL::Mesh& mesh, const CompileFlags flags) {
+    return compile(Containers::arrayView(meshes), mesh, flags);
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 CORRADE_IGNORE_DEPRECATED_PUSH
 GL::Mesh compile(const Trade::MeshData2D& meshData) {
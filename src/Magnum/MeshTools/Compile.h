@@ -32,6 +32,9 @@
 #include "Magnum/configure.h"
 
 #ifdef MAGNUM_TARGET_GL
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/Containers.h>
 #include <Corrade/Containers/EnumSet.h>
 
 #include "Magnum/Magnum.h"
@@ -45,6 +48,8 @@
 
 namespace Magnum { namespace MeshTools {
 
+class Meshlets;
+
 /**
 @brief Mesh compilation flag
 @m_since{2019,10}
@@ -81,7 +86,39 @@ enum class CompileFlag: UnsignedByte {
      * this flag to suppress the warning messages.
      * @m_since{2020,06}
      */
-    NoWarnOnCustomAttributes = 1 << 2
+    NoWarnOnCustomAttributes = 1 << 2,
+
+    /**
+     * If the mesh is @ref MeshPrimitive::Triangles, generates tangents using
+     * @ref MeshTools::generateTangents(), with the bitangent direction stored
+     * in the fourth component. Expects that the mesh has
+     * @ref VertexFormat::Vector3 positions and normals and
+     * @ref VertexFormat::Vector2 texture coordinates; normals generated with
+     * @ref CompileFlag::GenerateFlatNormals or
+     * @ref CompileFlag::GenerateSmoothNormals are used as well. If the mesh
+     * is not a triangle mesh, this flag does nothing. If the mesh already has
+     * its own tangents, these get replaced.
+     * @m_since_latest
+     */
+    GenerateTangents = 1 << 3,
+
+    /**
+     * Instead of uploading @ref Trade::MeshData::indexData() and
+     * @ref Trade::MeshData::vertexData() as-is, upload only the index range
+     * and the attributes that get bound to a @ref Shaders::Generic location,
+     * tightly interleaved with each attribute aligned to four bytes. Custom
+     * attributes, attributes of implementation-specific formats and morph
+     * target attributes are not uploaded at all. On desktop GL, if
+     * @gl_extension{ARB,buffer_storage} is supported, the buffers are
+     * allocated as immutable with @ref GL::Buffer::setStorage(), otherwise
+     * @ref GL::Buffer::setData() with @ref GL::BufferUsage::StaticDraw is
+     * used. Implicitly enabled by
+     * @ref compile(const Trade::MeshData&, Containers::ArrayView<const std::pair<Trade::MeshAttribute, VertexFormat>>, CompileFlags),
+     * which additionally allows the attributes to be converted to a smaller
+     * format.
+     * @m_since_latest
+     */
+    PackAttributes = 1 << 4
 };
 
 /**
@@ -116,6 +153,9 @@ possibly also an index buffer, if the mesh is indexed.
     are ignored with a warning. See the @ref compile(const Trade::MeshData&, GL::Buffer&, GL::Buffer&)
     for an example showing how to bind them manually, and
     @ref CompileFlag::NoWarnOnCustomAttributes to suppress the warning.
+-   Morph target attributes are silently ignored, use
+    @ref Shaders::MorphTargets to evaluate them. See
+    @ref Trade-MeshData-morph-targets for more information.
 
 If normal generation is not requested, @ref Trade::MeshData::indexData() and
 @ref Trade::MeshData::vertexData() are uploaded as-is without any further
@@ -147,6 +187,39 @@ MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, Compil
    directly */
 MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData);
 
+/**
+@brief Compile mesh data, uploading only bound attributes in given formats
+@m_since_latest
+
+Behaves like @ref compile(const Trade::MeshData&, CompileFlags) with
+@ref CompileFlag::PackAttributes implicitly enabled --- only the index range
+and attributes that get bound to a @ref Shaders::Generic location are
+uploaded, tightly interleaved into buffers that are never modified afterwards.
+Additionally, attributes listed in @p formats are converted to the
+corresponding format during the upload, which can significantly reduce the
+memory bandwidth spent on vertex fetch:
+
+@snippet MagnumMeshTools-gl.cpp compile-packed
+
+Expects that each listed attribute, if present in the mesh and bound, is
+either already in the target format, or is a single-vector
+@ref VertexFormat::Float based format and the target is a
+@ref VertexFormat::Half or a normalized @ref VertexFormat::Byte,
+@ref VertexFormat::UnsignedByte, @ref VertexFormat::Short or
+@ref VertexFormat::UnsignedShort based format with the same component count.
+Conversion to normalized formats clamps the values to the @f$ [0, 1] @f$ or
+@f$ [-1, 1] @f$ range, it's the caller responsibility to pick formats that
+can represent the data. Formats listed for attributes that are not present in
+the mesh are ignored.
+*/
+MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, Containers::ArrayView<const std::pair<Trade::MeshAttribute, VertexFormat>> formats, CompileFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, std::initializer_list<std::pair<Trade::MeshAttribute, VertexFormat>> formats, CompileFlags flags = {});
+
 /**
 @brief Compile mesh data using external buffers
 @m_since{2020,06}
@@ -194,6 +267,66 @@ MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Bu
  */
 MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, GL::Buffer&& indices, GL::Buffer&& vertices);
 
+/**
+@brief Compile mesh data split into meshlets
+@m_since_latest
+
+Uploads vertex data of @p meshData together with
+@ref Meshlets::indicesAsArray() as 32-bit indices, so triangles of each
+meshlet can be drawn with a @ref GL::MeshView or an indirect draw selecting
+given index range. The original index buffer of @p meshData is ignored,
+vertex attributes get bound the same way as in
+@ref compile(const Trade::MeshData&). The @ref Meshlets::meshlets() array is
+uploaded into @p meshletBuffer, which can be then bound as a shader storage
+buffer for culling the meshlets in a compute shader.
+
+Expects that the @p meshData is a @ref MeshPrimitive::Triangles mesh and that
+@p meshlets were created from it using @ref meshletize().
+*/
+MAGNUM_MESHTOOLS_EXPORT GL::Mesh compile(const Trade::MeshData& meshData, const Meshlets& meshlets, GL::Buffer& meshletBuffer);
+
+/**
+@brief Compile a batch of meshes into shared buffers
+@param[in] meshes   Meshes to compile
+@param[out] mesh    Mesh referencing the shared buffers
+@param[in] flags    Compilation flags
+@m_since_latest
+
+Instead of creating a dedicated vertex and index buffer for each mesh, all
+@p meshes are packed into a single vertex and a single index buffer owned by
+@p mesh and a @ref GL::MeshView describing each of the original meshes is
+returned, in the same order as passed. The views can be drawn one by one or,
+as they all reference the same mesh, also all together with a single
+@ref GL::AbstractShaderProgram::draw(Containers::ArrayView<const Containers::Reference<MeshView>>)
+call, which makes them usable with the multi-draw variants of the builtin
+shaders:
+
+@snippet MagnumMeshTools-gl.cpp compile-batch
+
+The meshes are first merged using @ref concatenate(), which means the same
+restrictions apply --- all meshes are expected to have the same primitive,
+which can't be a strip or a fan, attributes are taken from the first mesh and
+if any mesh is indexed, the resulting mesh is indexed as well. The indices are
+adjusted for vertex offsets of particular meshes, so the views don't need any
+base vertex and thus work also on platforms without
+@gl_extension{ARB,draw_elements_base_vertex}. The index buffer is then
+compressed with @ref compressIndices(Trade::MeshData&&, MeshIndexType) and the
+result is uploaded with @ref compile(const Trade::MeshData&, CompileFlags),
+where @p flags have the same meaning. Expects that @p meshes contains at least
+one item.
+
+The returned views are referencing @p mesh, which means it shouldn't be moved
+or destroyed while the views are in use.
+@see @ref GL::MeshView::setIndexRange(), @ref GL::MeshView::setBaseVertex()
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::MeshView> compile(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, GL::Mesh& mesh, CompileFlags flags = {});
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<GL::MeshView> compile(std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, GL::Mesh& mesh, CompileFlags flags = {});
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Compile 2D mesh data
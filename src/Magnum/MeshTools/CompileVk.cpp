@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CompileVk.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/BoolVector.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/StagingUploader.h"
+
+namespace Magnum { namespace MeshTools {
+
+VkMesh compile(const Trade::MeshData& meshData, Vk::Device& device, Vk::MemoryAllocator& allocator, Vk::StagingUploader& uploader) {
+    CORRADE_ASSERT(meshData.vertexCount(),
+        "MeshTools::compile(): the mesh has no vertices", VkMesh{NoCreate});
+
+    /* Make the data interleaved if they aren't already. The original data
+       are used directly otherwise, without any copy. */
+    Containers::Optional<Trade::MeshData> interleaved;
+    if(!isInterleaved(meshData)) interleaved = interleave(meshData);
+    const Trade::MeshData& data = interleaved ? *interleaved : meshData;
+
+    VkMesh mesh{NoCreate};
+    mesh.primitive = data.primitive();
+
+    /* Attribute offsets are relative to the earliest attribute, which is then
+       the offset at which the vertex buffer gets bound */
+    UnsignedLong vertexOffset = data.vertexData().size();
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
+        vertexOffset = Math::min(vertexOffset, UnsignedLong(data.attributeOffset(i)));
+    if(data.attributeCount()) {
+        mesh.vertexOffset = vertexOffset;
+        mesh.vertexStride = data.attributeStride(0);
+    }
+
+    /* Ensure each known attribute gets bound only once. Using the same
+       locations as Shaders::Generic, there's 16 at most. */
+    Math::BoolVector<16> boundAttributes;
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        /* Morph target deltas aren't meant to be rendered directly */
+        if(data.attributeMorphTargetId(i) != -1) continue;
+
+        UnsignedInt location = ~UnsignedInt{};
+        switch(data.attributeName(i)) {
+            case Trade::MeshAttribute::Position:
+                location = 0;
+                break;
+            case Trade::MeshAttribute::TextureCoordinates:
+                location = 1;
+                break;
+            case Trade::MeshAttribute::Color:
+                location = 2;
+                break;
+            case Trade::MeshAttribute::Tangent:
+                location = 3;
+                break;
+            case Trade::MeshAttribute::Bitangent:
+            case Trade::MeshAttribute::ObjectId:
+                location = 4;
+                break;
+            case Trade::MeshAttribute::Normal:
+                location = 5;
+                break;
+
+            /* To avoid the compiler warning that we didn't handle an enum
+               value. For these a runtime warning is printed below. */
+            /* LCOV_EXCL_START */
+            case Trade::MeshAttribute::Custom:
+                break;
+            /* LCOV_EXCL_STOP */
+        }
+
+        if(location == ~UnsignedInt{}) {
+            Warning{} << "MeshTools::compile(): ignoring unknown/unsupported attribute" << data.attributeName(i);
+            continue;
+        }
+
+        if(boundAttributes[location]) continue;
+        boundAttributes.set(location, true);
+
+        arrayAppend(mesh.attributes, Containers::InPlaceInit, location,
+            data.attributeFormat(i),
+            UnsignedInt(data.attributeOffset(i) - vertexOffset));
+    }
+
+    /* Vertex data, the whole range uploaded as-is */
+    mesh.vertexBuffer = Vk::Buffer{device, Vk::BufferCreateInfo{
+        Vk::BufferUsage::VertexBuffer|Vk::BufferUsage::TransferDestination,
+        data.vertexData().size()
+    }, allocator, Vk::MemoryFlag::DeviceLocal};
+    uploader.upload(mesh.vertexBuffer, 0, data.vertexData());
+
+    /* Index data */
+    if(data.isIndexed()) {
+        mesh.isIndexed = true;
+        mesh.indexType = data.indexType();
+        mesh.indexOffset = data.indexOffset();
+        mesh.count = data.indexCount();
+        mesh.indexBuffer = Vk::Buffer{device, Vk::BufferCreateInfo{
+            Vk::BufferUsage::IndexBuffer|Vk::BufferUsage::TransferDestination,
+            data.indexData().size()
+        }, allocator, Vk::MemoryFlag::DeviceLocal};
+        uploader.upload(mesh.indexBuffer, 0, data.indexData());
+    } else mesh.count = data.vertexCount();
+
+    return mesh;
+}
+
+void addVertexInput(const VkMesh& mesh, Vk::GraphicsPipelineCreateInfo& info, const UnsignedInt binding) {
+    info.setPrimitive(mesh.primitive);
+    if(mesh.attributes.empty()) return;
+
+    info.addVertexBinding(binding, mesh.vertexStride);
+    for(const VkMeshAttribute& attribute: mesh.attributes)
+        info.addVertexAttribute(attribute.location, binding, attribute.format, attribute.offset);
+}
+
+}}
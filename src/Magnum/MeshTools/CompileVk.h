@@ -0,0 +1,187 @@
+#ifndef Magnum_MeshTools_CompileVk_h
+#define Magnum_MeshTools_CompileVk_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::VkMesh, @ref Magnum::MeshTools::VkMeshAttribute, function @ref Magnum::MeshTools::compile(const Trade::MeshData&, Vk::Device&, Vk::MemoryAllocator&, Vk::StagingUploader&), @ref Magnum::MeshTools::addVertexInput()
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_VK
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Vk/Buffer.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Vertex attribute of a Vulkan mesh
+@m_since_latest
+
+@see @ref VkMesh::attributes
+*/
+struct VkMeshAttribute {
+    /** @brief Shader input location */
+    UnsignedInt location;
+
+    /** @brief Attribute format */
+    VertexFormat format;
+
+    /** @brief Offset relative to the start of a vertex in bytes */
+    UnsignedInt offset;
+};
+
+/**
+@brief Vulkan mesh
+@m_since_latest
+
+Device-local vertex and index buffers together with a vertex layout, returned
+from @ref compile(const Trade::MeshData&, Vk::Device&, Vk::MemoryAllocator&, Vk::StagingUploader&).
+The layout is turned into a vertex input state of a graphics pipeline with
+@ref addVertexInput().
+*/
+struct VkMesh {
+    /** @brief Construct without creating the buffers */
+    explicit VkMesh(NoCreateT) noexcept: vertexBuffer{NoCreate}, indexBuffer{NoCreate} {}
+
+    /** @brief Interleaved vertex buffer */
+    Vk::Buffer vertexBuffer;
+
+    /**
+     * @brief Offset of the first vertex in @ref vertexBuffer
+     *
+     * Used as an offset when binding @ref vertexBuffer.
+     */
+    UnsignedLong vertexOffset{};
+
+    /** @brief Stride between consecutive vertices in bytes */
+    UnsignedInt vertexStride{};
+
+    /**
+     * @brief Vertex attributes
+     *
+     * All sourced from @ref vertexBuffer, with offsets relative to the start
+     * of a vertex.
+     */
+    Containers::Array<VkMeshAttribute> attributes;
+
+    /**
+     * @brief Index buffer
+     *
+     * Not created if @ref isIndexed is @cpp false @ce.
+     */
+    Vk::Buffer indexBuffer;
+
+    /**
+     * @brief Offset of the first index in @ref indexBuffer
+     *
+     * Used as an offset when binding @ref indexBuffer.
+     */
+    UnsignedLong indexOffset{};
+
+    /** @brief Whether the mesh is indexed */
+    bool isIndexed{};
+
+    /**
+     * @brief Index type
+     *
+     * Convertible to a Vulkan index type using @ref Vk::vkIndexType().
+     * Unspecified if @ref isIndexed is @cpp false @ce.
+     */
+    MeshIndexType indexType{};
+
+    /** @brief Primitive */
+    MeshPrimitive primitive{};
+
+    /** @brief Index count if the mesh is indexed, vertex count otherwise */
+    UnsignedInt count{};
+};
+
+/**
+@brief Compile mesh data for Vulkan
+@m_since_latest
+
+Creates device-local vertex and index buffers on @p device with memory
+sub-allocated from @p allocator and fills them through @p uploader. The uploads
+are only recorded into the current batch of @p uploader and not flushed, so
+uploading many meshes at once results in just a few large transfers. The buffers can be used only
+after the batch finishes, see @ref Vk::StagingUploader for details.
+
+If the vertex data aren't interleaved, an interleaved copy is made with
+@ref interleave() first. Attribute locations match the
+@ref shaders-generic "generic shader attribute locations" ---
+@ref Trade::MeshAttribute::Position is at location @cpp 0 @ce,
+@ref Trade::MeshAttribute::TextureCoordinates at @cpp 1 @ce,
+@ref Trade::MeshAttribute::Color at @cpp 2 @ce,
+@ref Trade::MeshAttribute::Tangent at @cpp 3 @ce,
+@ref Trade::MeshAttribute::Bitangent and
+@ref Trade::MeshAttribute::ObjectId at @cpp 4 @ce and
+@ref Trade::MeshAttribute::Normal at @cpp 5 @ce. If a location is
+already taken by a previous attribute, the attribute is ignored. Custom
+attributes are ignored with a warning, morph target attributes are ignored
+silently. Unlike with the OpenGL
+@ref compile(const Trade::MeshData&, CompileFlags), implementation-specific
+vertex formats are passed through, as they're directly a @type_vk{Format}.
+
+The whole vertex and index data of @p meshData are uploaded, the offsets of
+the first vertex and the first index are then in @ref VkMesh::vertexOffset and
+@ref VkMesh::indexOffset. Expects that the mesh has at least one vertex.
+
+@snippet MagnumMeshTools-vk.cpp compile-vk
+
+@note This function is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_VK enabled. See @ref building-features for more
+    information.
+
+@see @ref addVertexInput()
+*/
+MAGNUM_MESHTOOLS_EXPORT VkMesh compile(const Trade::MeshData& meshData, Vk::Device& device, Vk::MemoryAllocator& allocator, Vk::StagingUploader& uploader);
+
+/**
+@brief Add a vertex input state of a Vulkan mesh to a pipeline
+@m_since_latest
+
+Adds a per-vertex binding @p binding with @ref VkMesh::vertexStride, all
+@ref VkMesh::attributes sourced from it and sets the primitive to
+@ref VkMesh::primitive.
+@see @ref Vk::GraphicsPipelineCreateInfo::addVertexBinding(),
+    @ref Vk::GraphicsPipelineCreateInfo::addVertexAttribute(),
+    @ref Vk::GraphicsPipelineCreateInfo::setPrimitive()
+*/
+MAGNUM_MESHTOOLS_EXPORT void addVertexInput(const VkMesh& mesh, Vk::GraphicsPipelineCreateInfo& info, UnsignedInt binding = 0);
+
+}}
+#else
+#error this header is available only in the Vulkan build
+#endif
+
+#endif
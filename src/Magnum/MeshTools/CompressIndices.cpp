@@ -157,7 +157,7 @@ Trade::MeshData compressIndices(Trade::MeshData&& data, MeshIndexType atLeast) {
         attributeData[i] = Trade::MeshAttributeData{data.attributeName(i),
             data.attributeFormat(i),
             Containers::StridedArrayView1D<const void>{vertexData, vertexData.data() + data.attributeOffset(i) + offset*stride, newVertexCount, stride},
-            data.attributeArraySize(i)};
+            data.attributeArraySize(i), data.attributeMorphTargetId(i)};
     }
 
     Trade::MeshIndexData indices{result.second, result.first};
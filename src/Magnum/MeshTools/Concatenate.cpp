@@ -25,15 +25,16 @@
 
 #include "Concatenate.h"
 
+#include <cstring>
 #include <numeric>
 #include <unordered_map>
 #include <Corrade/Utility/Algorithms.h>
 
-namespace Magnum { namespace MeshTools {
+#include "Magnum/Implementation/threads.h"
 
-namespace Implementation {
+namespace Magnum { namespace MeshTools {
 
-std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
+std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
     UnsignedInt indexCount = 0;
     UnsignedInt vertexCount = 0;
     for(const Trade::MeshData& mesh: meshes) {
@@ -54,6 +55,12 @@ std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::Arra
     return {indexCount, vertexCount};
 }
 
+std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes) {
+    return concatenateIndexVertexCount(Containers::arrayView(meshes));
+}
+
+namespace {
+
 /* std::hash for enumeration types is only since C++14, so we need to make our
    own. It's amazing how extremely verbose this can get, ugh. */
 struct MeshAttributeHash: std::hash<typename std::underlying_type<Trade::MeshAttribute>::type> {
@@ -62,100 +69,112 @@ struct MeshAttributeHash: std::hash<typename std::underlying_type<Trade::MeshAtt
     }
 };
 
-Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* const assertPrefix) {
-    #ifdef CORRADE_NO_ASSERT
-    static_cast<void>(assertPrefix);
-    #endif
+/* Where data of a particular mesh go in the output and where its mapping to
+   output attributes starts */
+struct MeshOffsets {
+    std::size_t index;
+    std::size_t vertex;
+    std::size_t attribute;
+};
 
-    /* Convert the attributes from offset-only and zero vertex count to
-       absolute, referencing the vertex data array */
+/* Offset-only attribute layout of the concatenated mesh */
+Containers::Array<Trade::MeshAttributeData> concatenateLayout(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
+    /* Make a non-owning copy of the attribute data to avoid
+       interleavedLayout() stealing the original (we still need it to be able
+       to reference the original data). If there's no attributes in the
+       original array, pass just vertex count --- otherwise MeshData will
+       assert on that to avoid it getting lost. */
+    if(meshes.front()->attributeCount())
+        return Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
+            {}, meshes.front()->vertexData(),
+            Trade::meshAttributeDataNonOwningArray(meshes.front()->attributeData())}, {});
+    return Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
+        meshes.front()->vertexCount()}, {});
+}
+
+/* Converts the attributes from offset-only and zero vertex count to absolute,
+   referencing the vertex data array */
+void absoluteAttributes(const Containers::ArrayView<Trade::MeshAttributeData> attributeData, const Containers::ArrayView<char> vertexData, const UnsignedInt vertexCount) {
     for(Trade::MeshAttributeData& attribute: attributeData) {
         attribute = Trade::MeshAttributeData{
             attribute.name(), attribute.format(),
             Containers::StridedArrayView1D<void>{vertexData,
                 vertexData + attribute.offset(vertexData),
                 vertexCount, attribute.stride()},
-            attribute.arraySize()};
+            attribute.arraySize(), attribute.morphTargetId()};
     }
+}
 
+bool isPrimitiveSupported(const MeshPrimitive primitive) {
     /* Only list primitives are supported currently */
     /** @todo delegate to `indexTriangleStrip()` (`duplicate*()`?) etc when
         those are done */
-    CORRADE_ASSERT(
-        meshes.front()->primitive() != MeshPrimitive::LineStrip &&
-        meshes.front()->primitive() != MeshPrimitive::LineLoop &&
-        meshes.front()->primitive() != MeshPrimitive::TriangleStrip &&
-        meshes.front()->primitive() != MeshPrimitive::TriangleFan,
-        assertPrefix << meshes.front()->primitive() << "is not supported, turn it into a plain indexed mesh first",
-        (Trade::MeshData{MeshPrimitive{}, 0}));
+    return primitive != MeshPrimitive::LineStrip &&
+           primitive != MeshPrimitive::LineLoop &&
+           primitive != MeshPrimitive::TriangleStrip &&
+           primitive != MeshPrimitive::TriangleFan;
+}
+
+/* Puts all attributes and index arrays of `meshes` together into `out`, with
+   indices written to `indices` if non-empty. Returns false if the meshes are
+   not compatible. */
+bool concatenateData(Trade::MeshData& out, const Containers::ArrayView<UnsignedInt> indices, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const UnsignedInt threadCount, const char* const assertPrefix) {
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(assertPrefix);
+    #endif
 
-    /* Populate the resulting instance with what we have. It'll be used below
-       for convenient access to vertex / index data */
-    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
-    Trade::MeshData out{meshes.front()->primitive(),
-        /* If the index array is empty, we're creating a non-indexed mesh (not
-           an indexed mesh with zero indices) */
-        std::move(indexData), indices.empty() ?
-            Trade::MeshIndexData{} : Trade::MeshIndexData{indices},
-        std::move(vertexData), std::move(attributeData), vertexCount};
     /* Create an attribute map. Yes, this is an inevitable fugly thing that
        allocates like mad, while everything else is zero-alloc.
        Containers::HashMap can't be here soon enough. */
-    std::unordered_multimap<Trade::MeshAttribute, std::pair<UnsignedInt, bool>, MeshAttributeHash> attributeMap;
+    std::unordered_multimap<Trade::MeshAttribute, UnsignedInt, MeshAttributeHash> attributeMap;
     attributeMap.reserve(out.attributeCount());
     for(UnsignedInt i = 0; i != out.attributeCount(); ++i)
-        attributeMap.emplace(out.attributeName(i), std::make_pair(i, false));
-
-    /* Go through all meshes and put all attributes and index arrays together. */
+        attributeMap.emplace(out.attributeName(i), i);
+
+    /* Calculate where each mesh goes and to which output attribute each of
+       its attributes gets copied. This is done upfront on a single thread so
+       the checks are done in a deterministic order and the copying below can
+       happen independently for each mesh. */
+    std::size_t totalAttributeCount = 0;
+    for(const Trade::MeshData& mesh: meshes)
+        totalAttributeCount += mesh.attributeCount();
+    Containers::Array<MeshOffsets> offsets{Containers::NoInit, meshes.size()};
+    Containers::Array<UnsignedInt> mapping{Containers::NoInit, totalAttributeCount};
+    Containers::Array<bool> assigned{Containers::NoInit, out.attributeCount()};
     std::size_t indexOffset = 0;
     std::size_t vertexOffset = 0;
+    std::size_t attributeOffset = 0;
     for(std::size_t i = 0; i != meshes.size(); ++i) {
         const Trade::MeshData& mesh = meshes[i];
 
         /* This won't fire for i == ~std::size_t{}, as that's where
            out.primitive() comes from */
         CORRADE_ASSERT(mesh.primitive() == out.primitive(),
-            assertPrefix << "expected" << out.primitive() << "but got" << mesh.primitive() << "in mesh" << i,
-            (Trade::MeshData{MeshPrimitive{}, 0}));
+            assertPrefix << "expected" << out.primitive() << "but got" << mesh.primitive() << "in mesh" << i, false);
 
-        /* If the mesh is indexed, copy the indices over, expanded to 32bit */
-        if(mesh.isIndexed()) {
-            Containers::ArrayView<UnsignedInt> dst = indices.slice(indexOffset, indexOffset + mesh.indexCount());
-            mesh.indicesInto(dst);
-            indexOffset += mesh.indexCount();
-
-            /* Adjust indices for current vertex offset */
-            for(UnsignedInt& index: dst) index += vertexOffset;
-
-        /* Otherwise, if we need an index buffer (meaning at least one of the
-           meshes is indexed), generate a trivial index buffer */
-        } else if(!indices.empty()) {
-            std::iota(indices + indexOffset, indices + indexOffset + mesh.vertexCount(), UnsignedInt(vertexOffset));
-            indexOffset += mesh.vertexCount();
-        }
+        offsets[i] = {indexOffset, vertexOffset, attributeOffset};
 
-        /* Reset markers saying which attribute has already been copied */
-        for(auto it = attributeMap.begin(); it != attributeMap.end(); ++it)
-            it->second.second = false;
+        /* Indexed meshes contribute their indices, if we need an index buffer
+           (meaning at least one of the meshes is indexed), non-indexed meshes
+           get a trivial index buffer generated */
+        if(mesh.isIndexed()) indexOffset += mesh.indexCount();
+        else if(!indices.empty()) indexOffset += mesh.vertexCount();
 
-        /* Copy attributes to their destination, skipping ones that don't have
-           any equivalent in the destination mesh */
+        /* Reset markers saying which attribute has already been assigned */
+        for(bool& a: assigned) a = false;
+
+        /* Go through destination attributes of the same name and find the
+           earliest one that hasn't been assigned yet, skipping ones that
+           don't have any equivalent in the destination mesh */
         for(UnsignedInt src = 0; src != mesh.attributeCount(); ++src) {
-            /* Go through destination attributes of the same name and find the
-               earliest one that hasn't been copied yet */
+            /* The range is unordered so we need to go through everything and
+               pick one with smallest ID */
             auto range = attributeMap.equal_range(mesh.attributeName(src));
             UnsignedInt dst = ~UnsignedInt{};
-            auto found = attributeMap.end();
-            for(auto it = range.first; it != range.second; ++it) {
-                if(it->second.second) continue;
-
-                /* The range is unordered so we need to go through everything
-                   and pick one with smallest ID */
-                if(it->second.first < dst) {
-                    dst = it->second.first;
-                    found = it;
-                }
-            }
+            for(auto it = range.first; it != range.second; ++it)
+                if(!assigned[it->second] && it->second < dst) dst = it->second;
+
+            mapping[attributeOffset + src] = dst;
 
             /* No corresponding attribute found, continue */
             if(dst == ~UnsignedInt{}) continue;
@@ -163,51 +182,122 @@ Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedI
             /* Check format compatibility. This won't fire for i ==
                ~std::size_t{}, as that's where out.primitive() comes from */
             CORRADE_ASSERT(out.attributeFormat(dst) == mesh.attributeFormat(src),
-                assertPrefix << "expected" << out.attributeFormat(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeFormat(src) << "in mesh" << i << "attribute" << src,
-                (Trade::MeshData{MeshPrimitive{}, 0}));
+                assertPrefix << "expected" << out.attributeFormat(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeFormat(src) << "in mesh" << i << "attribute" << src, false);
             CORRADE_ASSERT(out.attributeArraySize(dst) == mesh.attributeArraySize(src),
-                assertPrefix << "expected array size" << out.attributeArraySize(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeArraySize(src) << "in mesh" << i << "attribute" << src,
-                (Trade::MeshData{MeshPrimitive{}, 0}));
-
-            /* Copy the data to a slice of the output, mark the attribute as
-               copied */
-            Utility::copy(mesh.attribute(src), out.mutableAttribute(dst)
-                .slice(vertexOffset, vertexOffset + mesh.vertexCount()));
-            found->second.second = true;
+                assertPrefix << "expected array size" << out.attributeArraySize(dst) << "for attribute" << dst << "(" << Debug::nospace << out.attributeName(dst) << Debug::nospace << ") but got" << mesh.attributeArraySize(src) << "in mesh" << i << "attribute" << src, false);
+
+            assigned[dst] = true;
         }
 
-        /* Update vertex offset for the next mesh */
+        attributeOffset += mesh.attributeCount();
         vertexOffset += mesh.vertexCount();
     }
 
+    /* Copy the data. Meshes are distributed among threads based on where
+       their vertices go, each mesh is processed by the thread whose vertex
+       range contains the first vertex of given mesh. Trailing meshes with no
+       vertices are processed by the last thread. */
+    const std::size_t vertexCount = vertexOffset;
+    const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), vertexCount);
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(vertexCount, actualThreadCount, thread);
+        Containers::Array<bool> copied{Containers::NoInit, out.attributeCount()};
+        for(std::size_t i = 0; i != meshes.size(); ++i) {
+            const MeshOffsets& meshOffsets = offsets[i];
+            if(meshOffsets.vertex < range.first || (meshOffsets.vertex >= range.second && thread != actualThreadCount - 1))
+                continue;
+
+            const Trade::MeshData& mesh = meshes[i];
+
+            /* If the mesh is indexed, copy the indices over, expanded to
+               32bit, and adjust them for current vertex offset */
+            if(mesh.isIndexed()) {
+                Containers::ArrayView<UnsignedInt> dst = indices.slice(meshOffsets.index, meshOffsets.index + mesh.indexCount());
+                mesh.indicesInto(dst);
+                for(UnsignedInt& index: dst) index += meshOffsets.vertex;
+
+            /* Otherwise, if we need an index buffer, generate a trivial one */
+            } else if(!indices.empty()) {
+                std::iota(indices + meshOffsets.index, indices + meshOffsets.index + mesh.vertexCount(), UnsignedInt(meshOffsets.vertex));
+            }
+
+            const Containers::ArrayView<const UnsignedInt> meshMapping = mapping.slice(meshOffsets.attribute, meshOffsets.attribute + mesh.attributeCount());
+            for(bool& c: copied) c = false;
+            for(const UnsignedInt dst: meshMapping)
+                if(dst != ~UnsignedInt{}) copied[dst] = true;
+
+            /* Zero-fill attributes that the mesh doesn't have. Done before
+               copying so aliased attributes don't get overwritten. */
+            for(UnsignedInt dst = 0; dst != out.attributeCount(); ++dst) {
+                if(copied[dst]) continue;
+                for(Containers::StridedArrayView1D<char> vertex: out.mutableAttribute(dst).slice(meshOffsets.vertex, meshOffsets.vertex + mesh.vertexCount()))
+                    std::memset(vertex.data(), 0, vertex.size());
+            }
+
+            /* Copy the data to a slice of the output */
+            for(UnsignedInt src = 0; src != mesh.attributeCount(); ++src) {
+                if(meshMapping[src] == ~UnsignedInt{}) continue;
+                Utility::copy(mesh.attribute(src), out.mutableAttribute(meshMapping[src])
+                    .slice(meshOffsets.vertex, meshOffsets.vertex + mesh.vertexCount()));
+            }
+        }
+    });
+
+    return true;
+}
+
+}
+
+namespace Implementation {
+
+Trade::MeshData concatenate(Containers::Array<char>&& indexData, const UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* const assertPrefix) {
+    absoluteAttributes(attributeData, vertexData, vertexCount);
+
+    CORRADE_ASSERT(isPrimitiveSupported(meshes.front()->primitive()),
+        assertPrefix << meshes.front()->primitive() << "is not supported, turn it into a plain indexed mesh first",
+        (Trade::MeshData{MeshPrimitive{}, 0}));
+
+    /* Populate the resulting instance with what we have. It'll be used for
+       convenient access to vertex / index data */
+    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
+    Trade::MeshData out{meshes.front()->primitive(),
+        /* If the index array is empty, we're creating a non-indexed mesh (not
+           an indexed mesh with zero indices) */
+        std::move(indexData), indices.empty() ?
+            Trade::MeshIndexData{} : Trade::MeshIndexData{indices},
+        std::move(vertexData), std::move(attributeData), vertexCount};
+    if(!concatenateData(out, indices, meshes, 1, assertPrefix))
+        return Trade::MeshData{MeshPrimitive{}, 0};
+
     return out;
 }
 
 }
 
+std::size_t concatenateVertexStride(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
+    CORRADE_ASSERT(!meshes.empty(),
+        "MeshTools::concatenateVertexStride(): expected at least one mesh", {});
+
+    const Containers::Array<Trade::MeshAttributeData> attributeData = concatenateLayout(meshes);
+    return attributeData.empty() ? 0 : attributeData[0].stride();
+}
+
+std::size_t concatenateVertexStride(const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes) {
+    return concatenateVertexStride(Containers::arrayView(meshes));
+}
+
 Trade::MeshData concatenate(const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes) {
     CORRADE_ASSERT(!meshes.empty(),
         "MeshTools::concatenate(): expected at least one mesh",
         (Trade::MeshData{MeshPrimitive::Points, 0}));
 
-    /* Calculate final attribute stride and offsets. Make a non-owning copy of
-       the attribute data to avoid interleavedLayout() stealing the original
-       (we still need it to be able to reference the original data). If there's
-       no attributes in the original array, pass just vertex count ---
-       otherwise MeshData will assert on that to avoid it getting lost. */
-    Containers::Array<Trade::MeshAttributeData> attributeData;
-    if(meshes.front()->attributeCount())
-        attributeData = Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
-            {}, meshes.front()->vertexData(),
-            Trade::meshAttributeDataNonOwningArray(meshes.front()->attributeData())}, {});
-    else attributeData =
-        Implementation::interleavedLayout(Trade::MeshData{meshes.front()->primitive(),
-            meshes.front()->vertexCount()}, {});
+    /* Calculate final attribute stride and offsets */
+    Containers::Array<Trade::MeshAttributeData> attributeData = concatenateLayout(meshes);
 
     /* Calculate total index/vertex count and allocate the target memory.
        Index data are allocated with NoInit as the whole array will be written,
        however vertex data might have holes and thus it's zero-initialized. */
-    const std::pair<UnsignedInt, UnsignedInt> indexVertexCount = Implementation::concatenateIndexVertexCount(meshes);
+    const std::pair<UnsignedInt, UnsignedInt> indexVertexCount = concatenateIndexVertexCount(meshes);
     Containers::Array<char> indexData{Containers::NoInit,
         indexVertexCount.first*sizeof(UnsignedInt)};
     Containers::Array<char> vertexData{Containers::ValueInit,
@@ -219,4 +309,43 @@ Trade::MeshData concatenate(std::initializer_list<Containers::Reference<const Tr
     return concatenate(Containers::arrayView(meshes));
 }
 
+Trade::MeshData concatenateInto(const Containers::ArrayView<char> indexData, const Containers::ArrayView<char> vertexData, const Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(!meshes.empty(),
+        "MeshTools::concatenateInto(): no meshes passed",
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+
+    Containers::Array<Trade::MeshAttributeData> attributeData = concatenateLayout(meshes);
+    const std::pair<UnsignedInt, UnsignedInt> indexVertexCount = concatenateIndexVertexCount(meshes);
+    const std::size_t indexDataSize = indexVertexCount.first*sizeof(UnsignedInt);
+    const std::size_t vertexDataSize = attributeData.empty() ? 0 :
+        attributeData[0].stride()*indexVertexCount.second;
+    CORRADE_ASSERT(indexData.size() >= indexDataSize,
+        "MeshTools::concatenateInto(): expected index data of at least" << indexDataSize << "bytes but got" << indexData.size(),
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+    CORRADE_ASSERT(vertexData.size() >= vertexDataSize,
+        "MeshTools::concatenateInto(): expected vertex data of at least" << vertexDataSize << "bytes but got" << vertexData.size(),
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+
+    absoluteAttributes(attributeData, vertexData.prefix(vertexDataSize), indexVertexCount.second);
+
+    CORRADE_ASSERT(isPrimitiveSupported(meshes.front()->primitive()),
+        "MeshTools::concatenateInto():" << meshes.front()->primitive() << "is not supported, turn it into a plain indexed mesh first",
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+
+    const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData.prefix(indexDataSize));
+    Trade::MeshData out{meshes.front()->primitive(),
+        Trade::DataFlag::Mutable, indexData.prefix(indexDataSize),
+        indices.empty() ? Trade::MeshIndexData{} : Trade::MeshIndexData{indices},
+        Trade::DataFlag::Mutable, vertexData.prefix(vertexDataSize),
+        std::move(attributeData), indexVertexCount.second};
+    if(!concatenateData(out, indices, meshes, threadCount, "MeshTools::concatenateInto():"))
+        return Trade::MeshData{MeshPrimitive::Points, 0};
+
+    return out;
+}
+
+Trade::MeshData concatenateInto(const Containers::ArrayView<char> indexData, const Containers::ArrayView<char> vertexData, const std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, const UnsignedInt threadCount) {
+    return concatenateInto(indexData, vertexData, Containers::arrayView(meshes), threadCount);
+}
+
 }}
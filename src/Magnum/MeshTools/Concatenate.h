@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::concatenate(), @ref Magnum::MeshTools::concatenateInto()
+ * @brief Function @ref Magnum::MeshTools::concatenate(), @ref Magnum::MeshTools::concatenateInto(), @ref Magnum::MeshTools::concatenateIndexVertexCount(), @ref Magnum::MeshTools::concatenateVertexStride()
  * @m_since{2020,06}
  */
 
@@ -39,10 +39,47 @@
 namespace Magnum { namespace MeshTools {
 
 namespace Implementation {
-    MAGNUM_MESHTOOLS_EXPORT std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes);
     MAGNUM_MESHTOOLS_EXPORT Trade::MeshData concatenate(Containers::Array<char>&& indexData, UnsignedInt vertexCount, Containers::Array<char>&& vertexData, Containers::Array<Trade::MeshAttributeData>&& attributeData, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, const char* assertPrefix);
 }
 
+/**
+@brief Index and vertex count of concatenated meshes
+@m_since_latest
+
+Returns the total index count and vertex count of a mesh produced by
+@ref concatenate() from @p meshes. If none of the meshes is indexed, the index
+count is @cpp 0 @ce, otherwise it includes trivial indices generated for all
+non-indexed meshes. Together with @ref concatenateVertexStride() this can be
+used to calculate the memory needed by
+@ref concatenateInto(Containers::ArrayView<char>, Containers::ArrayView<char>, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>, UnsignedInt).
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::pair<UnsignedInt, UnsignedInt> concatenateIndexVertexCount(std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes);
+
+/**
+@brief Vertex stride of concatenated meshes
+@m_since_latest
+
+Returns the vertex stride of a mesh produced by @ref concatenate() from
+@p meshes, which is the stride of the first mesh if it's interleaved or a
+tightly-packed size of its attributes otherwise. Returns @cpp 0 @ce if the
+first mesh has no attributes. Expects that @p meshes contains at least one
+item.
+@see @ref concatenateIndexVertexCount()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t concatenateVertexStride(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t concatenateVertexStride(std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes);
+
 /**
 @brief Concatenate meshes together
 @m_since{2020,06}
@@ -99,7 +136,7 @@ template<template<class> class Allocator = Containers::ArrayAllocator> void conc
     CORRADE_ASSERT(!meshes.empty(),
         "MeshTools::concatenateInto(): no meshes passed", );
 
-    std::pair<UnsignedInt, UnsignedInt> indexVertexCount = Implementation::concatenateIndexVertexCount(meshes);
+    std::pair<UnsignedInt, UnsignedInt> indexVertexCount = concatenateIndexVertexCount(meshes);
 
     Containers::Array<char> indexData;
     if(indexVertexCount.first) {
@@ -132,6 +169,41 @@ template<template<class> class Allocator = Containers::ArrayAllocator> void conc
     concatenateInto<Allocator>(destination, Containers::arrayView(meshes));
 }
 
+/**
+@brief Concatenate a list of meshes into caller-provided memory
+@param[out] indexData   Memory to write the index data to
+@param[out] vertexData  Memory to write the vertex data to
+@param[in] meshes       Meshes to concatenate
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Compared to @ref concatenate(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>)
+this function doesn't allocate the index and vertex data but writes them
+directly to @p indexData and @p vertexData, which can be for example a mapped
+GPU buffer. The returned instance references them with
+@ref Trade::DataFlag::Mutable set. Expects that @p meshes contains at least one
+item, @p indexData is at least @ref concatenateIndexVertexCount() "concatenateIndexVertexCount().first"
+times 4 bytes large and @p vertexData is at least
+@ref concatenateIndexVertexCount() "concatenateIndexVertexCount().second"
+times @ref concatenateVertexStride() bytes large:
+
+@snippet MagnumMeshTools-gl.cpp concatenateInto-external
+
+Attributes missing in particular meshes are zero-filled, however unlike with
+@ref concatenate() the padding between attributes, if any, is left
+uninitialized. The meshes are copied on @p threadCount threads, each mesh is
+copied by a single thread and the work is distributed based on vertex count,
+so a single memory pass is done over the output in either case.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData concatenateInto(Containers::ArrayView<char> indexData, Containers::ArrayView<char> vertexData, Containers::ArrayView<const Containers::Reference<const Trade::MeshData>> meshes, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData concatenateInto(Containers::ArrayView<char> indexData, Containers::ArrayView<char> vertexData, std::initializer_list<Containers::Reference<const Trade::MeshData>> meshes, UnsignedInt threadCount = 1);
+
 }}
 
 #endif
@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FlattenCurves.h"
+
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Bezier.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+#include "Magnum/Trade/MeshData.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<UnsignedInt dimensions> UnsignedInt flattenCurvesOffsetsIntoImplementation(const Containers::StridedArrayView1D<const Math::CubicBezier<dimensions, Float>>& curves, const Float tolerance, const Containers::StridedArrayView1D<UnsignedInt>& offsets, const UnsignedInt maxSegments) {
+    CORRADE_ASSERT(offsets.size() == curves.size() + 1,
+        "MeshTools::flattenCurvesOffsetsInto(): expected" << curves.size() + 1 << "offsets but got" << offsets.size(), {});
+    CORRADE_ASSERT(tolerance > 0.0f && maxSegments,
+        "MeshTools::flattenCurvesOffsetsInto(): expected positive tolerance and max segment count but got" << tolerance << "and" << maxSegments, {});
+
+    /* Wang's formula for a cubic, n(n - 1)/8 = 3/4 */
+    const Float factor = 0.75f/tolerance;
+    UnsignedInt offset = 0;
+    for(std::size_t i = 0; i != curves.size(); ++i) {
+        const Math::CubicBezier<dimensions, Float>& curve = curves[i];
+        const Float m = Math::max(
+            (curve[0] - 2.0f*curve[1] + curve[2]).dot(),
+            (curve[1] - 2.0f*curve[2] + curve[3]).dot());
+        const Float segmentCount = std::ceil(std::sqrt(factor*std::sqrt(m)));
+
+        offsets[i] = offset;
+        offset += segmentCount >= Float(maxSegments) ? maxSegments + 1 :
+            Math::max(UnsignedInt(segmentCount), 1u) + 1;
+    }
+
+    offsets[curves.size()] = offset;
+    return offset;
+}
+
+/* Polynomial form of the curve, a*t^3 + b*t^2 + c*t + d, evaluated with
+   the Horner scheme. The SIMD and scalar variants do the same operations in
+   the same order, so the output doesn't depend on which one was used. */
+template<UnsignedInt dimensions> struct Polynomial {
+    Math::Vector<dimensions, Float> a, b, c, d;
+};
+
+template<UnsignedInt dimensions> Polynomial<dimensions> polynomial(const Math::CubicBezier<dimensions, Float>& curve) {
+    return {
+        (curve[3] - curve[0]) + 3.0f*(curve[1] - curve[2]),
+        3.0f*(curve[0] - 2.0f*curve[1] + curve[2]),
+        3.0f*(curve[1] - curve[0]),
+        curve[0]
+    };
+}
+
+template<class VectorType> void flattenCurve(const Polynomial<VectorType::Size>& p, const VectorType& last, const Containers::StridedArrayView1D<VectorType>& positions) {
+    constexpr UnsignedInt Size = VectorType::Size;
+    const std::size_t count = positions.size();
+    const Float step = 1.0f/Float(count - 1);
+
+    /* The last vertex is set to the end point directly to avoid gaps between
+       consecutive curves due to rounding, so it's excluded here */
+    std::size_t j = 0;
+    #if defined(CORRADE_TARGET_SSE2) || defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    #ifdef CORRADE_TARGET_SSE2
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 step4 = _mm_set1_ps(step);
+    #else
+    const Float laneData[]{0.0f, 1.0f, 2.0f, 3.0f};
+    const float32x4_t lane = vld1q_f32(laneData);
+    const float32x4_t step4 = vdupq_n_f32(step);
+    #endif
+    for(; j + 4 <= count - 1; j += 4) {
+        Float values[Size][4];
+        #ifdef CORRADE_TARGET_SSE2
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_set1_ps(Float(j)), lane), step4);
+        for(UnsignedInt k = 0; k != Size; ++k) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.a[k]), t), _mm_set1_ps(p.b[k]));
+            v = _mm_add_ps(_mm_mul_ps(v, t), _mm_set1_ps(p.c[k]));
+            v = _mm_add_ps(_mm_mul_ps(v, t), _mm_set1_ps(p.d[k]));
+            _mm_storeu_ps(values[k], v);
+        }
+        #else
+        const float32x4_t t = vmulq_f32(vaddq_f32(vdupq_n_f32(Float(j)), lane), step4);
+        for(UnsignedInt k = 0; k != Size; ++k) {
+            float32x4_t v = vaddq_f32(vmulq_f32(vdupq_n_f32(p.a[k]), t), vdupq_n_f32(p.b[k]));
+            v = vaddq_f32(vmulq_f32(v, t), vdupq_n_f32(p.c[k]));
+            v = vaddq_f32(vmulq_f32(v, t), vdupq_n_f32(p.d[k]));
+            vst1q_f32(values[k], v);
+        }
+        #endif
+        for(std::size_t l = 0; l != 4; ++l) {
+            VectorType& position = positions[j + l];
+            for(UnsignedInt k = 0; k != Size; ++k)
+                position[k] = values[k][l];
+        }
+    }
+    #endif
+
+    for(; j != count - 1; ++j) {
+        const Float t = Float(j)*step;
+        VectorType& position = positions[j];
+        for(UnsignedInt k = 0; k != Size; ++k)
+            position[k] = ((p.a[k]*t + p.b[k])*t + p.c[k])*t + p.d[k];
+    }
+
+    positions[count - 1] = last;
+}
+
+template<class VectorType> void flattenCurvesIntoImplementation(const Containers::StridedArrayView1D<const Math::CubicBezier<VectorType::Size, Float>>& curves, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<VectorType>& positions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(offsets.size() == curves.size() + 1,
+        "MeshTools::flattenCurvesInto(): expected" << curves.size() + 1 << "offsets but got" << offsets.size(), );
+    CORRADE_ASSERT(positions.size() == offsets[curves.size()],
+        "MeshTools::flattenCurvesInto(): expected" << offsets[curves.size()] << "positions but got" << positions.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != curves.size(); ++i) {
+        CORRADE_ASSERT(offsets[i + 1] >= offsets[i] && offsets[i + 1] - offsets[i] >= 2,
+            "MeshTools::flattenCurvesInto(): expected at least two vertices for curve" << i << "but got offsets" << offsets[i] << "and" << offsets[i + 1], );
+    }
+    #endif
+
+    const UnsignedInt count = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), positions.size());
+    Magnum::Implementation::runOnThreads(count, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(curves.size(), count, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            const Math::CubicBezier<VectorType::Size, Float>& curve = curves[i];
+            flattenCurve(polynomial(curve), VectorType{curve[3]}, positions.slice(offsets[i], offsets[i + 1]));
+        }
+    });
+}
+
+template<class VectorType> Trade::MeshData flattenCurvesImplementation(const Containers::StridedArrayView1D<const Math::CubicBezier<VectorType::Size, Float>>& curves, const Float tolerance, const UnsignedInt threadCount) {
+    Containers::Array<UnsignedInt> offsets{Containers::NoInit, curves.size() + 1};
+    const UnsignedInt vertexCount = flattenCurvesOffsetsInto(curves, tolerance, offsets);
+
+    Containers::Array<char> vertexData{Containers::NoInit, vertexCount*sizeof(VectorType)};
+    const Containers::ArrayView<VectorType> positions = Containers::arrayCast<VectorType>(vertexData);
+    flattenCurvesInto(curves, offsets, positions, threadCount);
+
+    /* Each curve with n vertices has n - 1 segments */
+    Containers::Array<char> indexData{Containers::NoInit, 2*(vertexCount - curves.size())*sizeof(UnsignedInt)};
+    const Containers::ArrayView<UnsignedInt> indices = Containers::arrayCast<UnsignedInt>(indexData);
+    std::size_t index = 0;
+    for(std::size_t i = 0; i != curves.size(); ++i) {
+        for(UnsignedInt j = offsets[i]; j != offsets[i + 1] - 1; ++j) {
+            indices[index++] = j;
+            indices[index++] = j + 1;
+        }
+    }
+
+    Trade::MeshIndexData indexDataDescription{indices};
+    Containers::Array<Trade::MeshAttributeData> attributeData{1};
+    attributeData[0] = Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions};
+    return Trade::MeshData{MeshPrimitive::Lines,
+        std::move(indexData), indexDataDescription,
+        std::move(vertexData), std::move(attributeData)};
+}
+
+template<class VectorType> Trade::MeshData flattenSplineImplementation(const Containers::StridedArrayView1D<const Math::CubicHermite<Math::Vector<VectorType::Size, Float>>>& spline, const Float tolerance, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(spline.size() >= 2,
+        "MeshTools::flattenCurves(): expected at least two spline points but got" << spline.size(),
+        (Trade::MeshData{MeshPrimitive::Lines, 0}));
+
+    Containers::Array<Math::CubicBezier<VectorType::Size, Float>> curves{Containers::NoInit, spline.size() - 1};
+    for(std::size_t i = 0; i != curves.size(); ++i)
+        curves[i] = Math::CubicBezier<VectorType::Size, Float>::fromCubicHermite(spline[i], spline[i + 1]);
+
+    return flattenCurvesImplementation<VectorType>(curves, tolerance, threadCount);
+}
+
+}
+
+UnsignedInt flattenCurvesOffsetsInto(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, const Float tolerance, const Containers::StridedArrayView1D<UnsignedInt>& offsets, const UnsignedInt maxSegments) {
+    return flattenCurvesOffsetsIntoImplementation(curves, tolerance, offsets, maxSegments);
+}
+
+UnsignedInt flattenCurvesOffsetsInto(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, const Float tolerance, const Containers::StridedArrayView1D<UnsignedInt>& offsets, const UnsignedInt maxSegments) {
+    return flattenCurvesOffsetsIntoImplementation(curves, tolerance, offsets, maxSegments);
+}
+
+void flattenCurvesInto(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<Vector2>& positions, const UnsignedInt threadCount) {
+    flattenCurvesIntoImplementation(curves, offsets, positions, threadCount);
+}
+
+void flattenCurvesInto(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<Vector3>& positions, const UnsignedInt threadCount) {
+    flattenCurvesIntoImplementation(curves, offsets, positions, threadCount);
+}
+
+Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, const Float tolerance, const UnsignedInt threadCount) {
+    return flattenCurvesImplementation<Vector2>(curves, tolerance, threadCount);
+}
+
+Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, const Float tolerance, const UnsignedInt threadCount) {
+    return flattenCurvesImplementation<Vector3>(curves, tolerance, threadCount);
+}
+
+Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicHermite2D>& spline, const Float tolerance, const UnsignedInt threadCount) {
+    return flattenSplineImplementation<Vector2>(spline, tolerance, threadCount);
+}
+
+Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicHermite3D>& spline, const Float tolerance, const UnsignedInt threadCount) {
+    return flattenSplineImplementation<Vector3>(spline, tolerance, threadCount);
+}
+
+}}
@@ -0,0 +1,159 @@
+#ifndef Magnum_MeshTools_FlattenCurves_h
+#define Magnum_MeshTools_FlattenCurves_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::flattenCurvesOffsetsInto(), @ref Magnum::MeshTools::flattenCurvesInto(), @ref Magnum::MeshTools::flattenCurves()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Calculate vertex offsets for flattening cubic Bézier curves
+@param[in]  curves      Curves to flatten
+@param[in]  tolerance   Maximal distance of the polyline from the curve
+@param[out] offsets     Where to put the vertex offsets
+@param[in]  maxSegments Maximal segment count for a single curve
+@return Total vertex count, same as the last item of @p offsets
+@m_since_latest
+
+First step of @ref flattenCurvesInto(). For each curve calculates the number
+of segments needed for the uniformly sampled polyline to not be further from
+the curve than @p tolerance using Wang's formula, @f[
+    n = \left\lceil \sqrt{rac{3}{4} rac{M}{\epsilon}} ightceil, \quad
+    M = \max(|oldsymbol{p}_0 - 2oldsymbol{p}_1 + oldsymbol{p}_2|,
+             |oldsymbol{p}_1 - 2oldsymbol{p}_2 + oldsymbol{p}_3|)
+@f]
+
+clamped to @f$ [1, \mathrm{maxSegments}] @f$, which gives more segments to
+curves with a larger curvature and just a single one to straight lines. Each
+curve is then flattened into @f$ n + 1 @f$ vertices, the first item of
+@p offsets is set to @cpp 0 @ce and each following item to the running
+sum of vertex counts. Expects that @p offsets has one item more than
+@p curves and that @p tolerance and @p maxSegments are larger than zero.
+
+The tolerance is in the same units as the curve control points. For a
+screen-space tolerance, transform the control points to screen space first,
+for example with @ref Math::transformPointsInto() --- since Bézier curves
+are affine-invariant, the result is the same as transforming the flattened
+polyline.
+*/
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt flattenCurvesOffsetsInto(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, Float tolerance, const Containers::StridedArrayView1D<UnsignedInt>& offsets, UnsignedInt maxSegments = 256);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt flattenCurvesOffsetsInto(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, Float tolerance, const Containers::StridedArrayView1D<UnsignedInt>& offsets, UnsignedInt maxSegments = 256);
+
+/**
+@brief Flatten cubic Bézier curves into a shared vertex buffer
+@param[in]  curves      Curves to flatten
+@param[in]  offsets     Vertex offsets calculated by
+    @ref flattenCurvesOffsetsInto()
+@param[out] positions   Where to put the polyline vertices
+@param[in]  threadCount Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Curve @cpp i @ce is uniformly sampled into vertices
+@cpp offsets[i] @ce to @cpp offsets[i + 1] - 1 @ce of @p positions, with the
+first and last vertex being exactly the first and last curve control point,
+so consecutive curves sharing an endpoint connect without gaps. Expects that
+@p offsets has one item more than @p curves, each curve has at least two
+vertices and that @p positions has exactly @cpp offsets.back() @ce items.
+
+The curves are converted to a polynomial form and on x86 and ARM64 four
+parameters are evaluated at a time using SIMD instructions. The curves are
+split into @p threadCount contiguous ranges, each processed on a separate
+thread and writing to its own part of @p positions. If there's less than
+about a thousand vertices per thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread. Doesn't allocate apart from the
+thread handles.
+@see @ref flattenCurves()
+*/
+MAGNUM_MESHTOOLS_EXPORT void flattenCurvesInto(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<Vector2>& positions, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void flattenCurvesInto(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, const Containers::StridedArrayView1D<const UnsignedInt>& offsets, const Containers::StridedArrayView1D<Vector3>& positions, UnsignedInt threadCount = 1);
+
+/**
+@brief Flatten cubic Bézier curves into a line mesh
+@param curves       Curves to flatten
+@param tolerance    Maximal distance of the polyline from the curve
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Calls @ref flattenCurvesOffsetsInto() and @ref flattenCurvesInto() and
+returns the result as an indexed @ref MeshPrimitive::Lines mesh with a
+@ref Trade::MeshAttribute::Position of type @ref VertexFormat::Vector2 and
+@ref MeshIndexType::UnsignedInt indices, ready to be uploaded with
+@ref compile() and drawn in a single call together with other line meshes.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicBezier2D>& curves, Float tolerance, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ *
+ * The position attribute is @ref VertexFormat::Vector3.
+ */
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicBezier3D>& curves, Float tolerance, UnsignedInt threadCount = 1);
+
+/**
+@brief Flatten a cubic Hermite spline into a line mesh
+@param spline       Spline points
+@param tolerance    Maximal distance of the polyline from the curve
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Converts each pair of consecutive points to a Bézier curve using
+@ref CubicBezier2D::fromCubicHermite() and delegates to
+@ref flattenCurves(const Containers::StridedArrayView1D<const CubicBezier2D>&, Float, UnsignedInt).
+Expects that @p spline has at least two points.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicHermite2D>& spline, Float tolerance, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData flattenCurves(const Containers::StridedArrayView1D<const CubicHermite3D>& spline, Float tolerance, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
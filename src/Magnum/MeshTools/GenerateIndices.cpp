@@ -293,7 +293,7 @@ Trade::MeshData generateIndices(Trade::MeshData&& data) {
         attributeData[i] = Trade::MeshAttributeData{data.attributeName(i),
             data.attributeFormat(i),
             Containers::StridedArrayView1D<const void>{vertexData, vertexData.data() + data.attributeOffset(i), vertexCount, data.attributeStride(i)},
-            data.attributeArraySize(i)};
+            data.attributeArraySize(i), data.attributeMorphTargetId(i)};
     }
 
     /* Generate the index array */
@@ -28,6 +28,7 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/StridedArrayView.h>
 
+#include "Magnum/Implementation/threads.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector3.h"
 
@@ -88,6 +89,13 @@ std::pair<std::vector<UnsignedInt>, std::vector<Vector3>> generateFlatNormals(co
 }
 #endif
 
+VertexTriangleAdjacency::VertexTriangleAdjacency() noexcept: _offsets{Containers::ValueInit, 1} {}
+
+VertexTriangleAdjacency::VertexTriangleAdjacency(Containers::Array<UnsignedInt>&& offsets, Containers::Array<UnsignedInt>&& corners) noexcept: _offsets{std::move(offsets)}, _corners{std::move(corners)} {
+    CORRADE_ASSERT(!_offsets.empty() && _offsets.back() == _corners.size(),
+        "MeshTools::VertexTriangleAdjacency: expected a non-empty offset array ending with" << _corners.size(), );
+}
+
 namespace {
 
 #if defined(CORRADE_MSVC2019_COMPATIBILITY) && !defined(CORRADE_MSVC2017_COMPATIBILITY)
@@ -98,127 +106,155 @@ namespace {
 using namespace Math::Literals;
 #endif
 
-template<class T> inline void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
-    CORRADE_ASSERT(indices.size() % 3 == 0,
-        "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
-    CORRADE_ASSERT(normals.size() == positions.size(),
-        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+/* Expects that offsets[i + 1] contains count of triangle corners referencing
+   vertex i and offsets[0] is zero. Turns that into a running offset array:
+   offsets[i + 1] - offsets[i] is corner count for vertex i and offsets[i] is
+   offset into the corners array for vertex i. For vertex i,
+   corners[offsets[i]] until corners[offsets[i + 1]] then contains positions
+   in the index array that reference it, in the order they appear in. */
+template<class T> void triangleAdjacencyFromCountsInto(const Containers::StridedArrayView1D<const T>& indices, const Containers::ArrayView<UnsignedInt> offsets, const Containers::ArrayView<UnsignedInt> corners) {
+    for(std::size_t i = 1; i != offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    CORRADE_INTERNAL_ASSERT(offsets.back() == indices.size());
+
+    /* Fill the corners, using offsets[i] as a cursor for vertex i. After
+       that, offsets[i] will be the end of vertex i, i.e. the beginning of
+       vertex i + 1, so it's just shifted by one element from the final
+       state. */
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        corners[offsets[indices[i]]++] = i;
+    for(std::size_t i = offsets.size() - 1; i != 0; --i)
+        offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+}
 
-    if(indices.empty()) return;
+template<class T> VertexTriangleAdjacency generateVertexTriangleAdjacencyImplementation(const Containers::StridedArrayView1D<const T>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateVertexTriangleAdjacency(): index count not divisible by 3", VertexTriangleAdjacency{});
 
-    /* Gather count of triangles for every vertex. This abuses the output
-       storage to avoid extra allocations, zero-initialize it first to avoid
-       random memory getting used. */
-    Containers::StridedArrayView1D<UnsignedInt> triangleCount =
-        Containers::arrayCast<UnsignedInt>(normals);
-    for(UnsignedInt& i: triangleCount) i = 0;
+    Containers::Array<UnsignedInt> offsets{Containers::ValueInit, std::size_t(vertexCount) + 1};
     for(const T index: indices) {
-        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateSmoothNormalsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
-        ++triangleCount[index];
-    }
-
-    /* Turn that into a running offset array:
-       triangleOffset[i + 1] - triangleOffset[i] is triangle count for vertex i
-       triangleOffset[i] is offset into an triangle ID array for vertex i */
-    Containers::Array<UnsignedInt> triangleOffset{Containers::NoInit, positions.size() + 1};
-    triangleOffset[0] = 0;
-    for(std::size_t i = 0; i != triangleCount.size(); ++i)
-        triangleOffset[i + 1] = triangleOffset[i] + triangleCount[i];
-
-    CORRADE_INTERNAL_ASSERT(triangleOffset.back() == indices.size());
-
-    /* Gather triangle IDs for every vertex. For vertex i,
-       triangleIds[triangleOffset[i]] until triangleIds[triangleOffset[i + 1]]
-       contains IDs of triangles that contain it. */
-    Containers::Array<T> triangleIds{Containers::NoInit, indices.size()};
-    for(std::size_t i = 0; i != indices.size(); ++i) {
-        const T triangleId = i/3;
-        const T vertexId = indices[i];
-
-        /* How many triangle IDs is still left to be written, which also means
-           the offset where we put the ID. Decrement that for the next run. */
-        const std::size_t triangleIdsLeftForVertex = triangleCount[vertexId]--;
-        triangleIds[triangleOffset[vertexId + 1] - triangleIdsLeftForVertex] = triangleId;
+        CORRADE_ASSERT(index < vertexCount, "MeshTools::generateVertexTriangleAdjacency(): index" << index << "out of bounds for" << vertexCount << "elements", VertexTriangleAdjacency{});
+        ++offsets[index + 1];
     }
 
-    /* Now, triangleCount should be all zeros, we don't need it anymore and the
-       underlying `normals` array is ready to get filled with real output. */
+    Containers::Array<UnsignedInt> corners{Containers::NoInit, indices.size()};
+    triangleAdjacencyFromCountsInto(indices, offsets, corners);
+    return VertexTriangleAdjacency{std::move(offsets), std::move(corners)};
+}
 
+/* Expects that the adjacency was calculated from the same indices and that
+   all sizes match */
+template<class T> void generateSmoothNormalsIntoImplementation(const Containers::ArrayView<const UnsignedInt> offsets, const Containers::ArrayView<const UnsignedInt> corners, const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
     /* Precalculate cross product and interior angles of each face --- the loop
        below would otherwise calculate it for every vertex, which is at least
        3x as much work */
-    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, indices.size()/3};
-    for(std::size_t i = 0; i != crossAngles.size(); ++i) {
-        const Vector3 v0 = positions[indices[i*3 + 0]];
-        const Vector3 v1 = positions[indices[i*3 + 1]];
-        const Vector3 v2 = positions[indices[i*3 + 2]];
-
-        /* Cross product */
-        crossAngles[i].first = Math::cross(v2 - v1, v0 - v1);
-
-        /* If any of the vectors is zero, the normalization would result in a
-           NaN and the angle calculation will assert. This happens also when
-           any of the original positions is NaN. If that's the case, skip the
-           rest. Given triangle will then contribute with a zero total angle,
-           effectively getting ignored for normal calculation. */
-        const Vector3 v10n = (v1 - v0).normalized();
-        const Vector3 v20n = (v2 - v0).normalized();
-        const Vector3 v21n = (v2 - v1).normalized();
-        if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
-            crossAngles[i].second = Math::Vector3<Rad>{Math::ZeroInit};
-            continue;
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<std::pair<Vector3, Math::Vector3<Rad>>> crossAngles{NoInit, triangleCount};
+    const UnsignedInt triangleThreadCount = Magnum::Implementation::clampThreadCount(threadCount, triangleCount);
+    Magnum::Implementation::runOnThreads(triangleThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, triangleThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            const Vector3 v0 = positions[indices[i*3 + 0]];
+            const Vector3 v1 = positions[indices[i*3 + 1]];
+            const Vector3 v2 = positions[indices[i*3 + 2]];
+
+            /* Cross product */
+            crossAngles[i].first = Math::cross(v2 - v1, v0 - v1);
+
+            /* If any of the vectors is zero, the normalization would result
+               in a NaN and the angle calculation will assert. This happens
+               also when any of the original positions is NaN. If that's the
+               case, skip the rest. Given triangle will then contribute with a
+               zero total angle, effectively getting ignored for normal
+               calculation. */
+            const Vector3 v10n = (v1 - v0).normalized();
+            const Vector3 v20n = (v2 - v0).normalized();
+            const Vector3 v21n = (v2 - v1).normalized();
+            if(Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
+                crossAngles[i].second = Math::Vector3<Rad>{Math::ZeroInit};
+                continue;
+            }
+
+            /* Inner angle at each vertex of the triangle. The last one can be
+               calculated as a remainder to 180°. */
+            /* This using namespace doesn't work with MSVC2019 with
+               /permissive- (it gets lost when instantiating?!), so it's
+               duplicated above */
+            using namespace Math::Literals;
+            crossAngles[i].second[0] = Math::angle(v10n, v20n);
+            crossAngles[i].second[1] = Math::angle(-v10n, v21n);
+            crossAngles[i].second[2] = Rad(180.0_degf)
+                - crossAngles[i].second[0] - crossAngles[i].second[1];
         }
-
-        /* Inner angle at each vertex of the triangle. The last one can be
-           calculated as a remainder to 180°. */
-        /* This using namespace doesn't work with MSVC2019 with /permissive-
-           (it gets lost when instantiating?!), so it's duplicated above */
-        using namespace Math::Literals;
-        crossAngles[i].second[0] = Math::angle(v10n, v20n);
-        crossAngles[i].second[1] = Math::angle(-v10n, v21n);
-        crossAngles[i].second[2] = Rad(180.0_degf)
-            - crossAngles[i].second[0] - crossAngles[i].second[1];
-    }
+    });
 
     /* For every vertex v, calculate normals from all faces it belongs to and
-       average them */
-    for(std::size_t v = 0; v != positions.size(); ++v) {
-        /* normals are an external memory, ensure we accumulate from zero */
-        normals[v] = Vector3{Math::ZeroInit};
-
-        /* Go through all triangles sharing this vertex */
-        for(std::size_t t = triangleOffset[v]; t != triangleOffset[v + 1]; ++t) {
-            const std::size_t baseIndex = triangleIds[t]*3;
-            const T v0i = indices[baseIndex + 0];
-            const T v1i = indices[baseIndex + 1];
-            const T v2i = indices[baseIndex + 2];
-
-            /* Cross product is a vector in direction of the normal with length
-               equal to size of the parallelogram */
-            const std::pair<Vector3, Math::Vector3<Rad>>& crossAngle = crossAngles[triangleIds[t]];
-
-            /* Angle between two sides of the triangle that share vertex `v`.
-               The shared vertex can be one of the three. */
-            Rad angle;
-            if(v == v0i) angle = crossAngle.second[0];
-            else if(v == v1i) angle = crossAngle.second[1];
-            else if(v == v2i) angle = crossAngle.second[2];
-            else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-
-            /* The normal is cross.normalized(), we need to multiply it it by
-               surface area which is cross.length()/2. Since normalization is
-               division by length, multiplying it by length again will be a
-               no-op. Then, since all normals are divided by 2, it doesn't
-               change their ratio for the final normalization so we can omit
-               that as well. Finally we need to weight by the angle, and in
-               that case only the ratio is important as well, so it doesn't
-               matter if degrees or radians. */
-            normals[v] += crossAngle.first*Float(angle);
+       average them. Each vertex is written to only from one thread, so
+       there's no need for any synchronization. */
+    const std::size_t vertexCount = positions.size();
+    const UnsignedInt vertexThreadCount = Magnum::Implementation::clampThreadCount(threadCount, vertexCount);
+    Magnum::Implementation::runOnThreads(vertexThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(vertexCount, vertexThreadCount, thread);
+        for(std::size_t v = range.first; v != range.second; ++v) {
+            /* normals are an external memory, ensure we accumulate from
+               zero */
+            Vector3 normal{Math::ZeroInit};
+
+            /* Go through all triangle corners referencing this vertex. Cross
+               product is a vector in direction of the normal with length
+               equal to size of the parallelogram, the angle is between the
+               two sides of the triangle that share the corner. */
+            for(std::size_t i = offsets[v]; i != offsets[v + 1]; ++i) {
+                const UnsignedInt corner = corners[i];
+                const std::pair<Vector3, Math::Vector3<Rad>>& crossAngle = crossAngles[corner/3];
+
+                /* The normal is cross.normalized(), we need to multiply it it
+                   by surface area which is cross.length()/2. Since
+                   normalization is division by length, multiplying it by
+                   length again will be a no-op. Then, since all normals are
+                   divided by 2, it doesn't change their ratio for the final
+                   normalization so we can omit that as well. Finally we need
+                   to weight by the angle, and in that case only the ratio is
+                   important as well, so it doesn't matter if degrees or
+                   radians. */
+                normal += crossAngle.first*Float(crossAngle.second[corner % 3]);
+            }
+
+            /* Normalize the accumulated direction */
+            normals[v] = normal.normalized();
         }
+    });
+}
 
-        /* Normalize the accumulated direction */
-        normals[v] = normals[v].normalized();
+template<class T> inline void generateSmoothNormalsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateSmoothNormalsInto(): index count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+
+    if(indices.empty()) return;
+
+    /* Gather count of triangle corners for every vertex */
+    Containers::Array<UnsignedInt> offsets{Containers::ValueInit, positions.size() + 1};
+    for(const T index: indices) {
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateSmoothNormalsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+        ++offsets[index + 1];
     }
+
+    Containers::Array<UnsignedInt> corners{Containers::NoInit, indices.size()};
+    triangleAdjacencyFromCountsInto(indices, offsets, corners);
+    generateSmoothNormalsIntoImplementation(offsets, corners, indices, positions, normals, 1);
+}
+
+template<class T> inline void generateSmoothNormalsIntoImplementation(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(adjacency.vertexCount() == positions.size() && adjacency.indexCount() == indices.size(),
+        "MeshTools::generateSmoothNormalsInto(): adjacency calculated for" << adjacency.vertexCount() << "vertices and" << adjacency.indexCount() << "indices but got" << positions.size() << "positions and" << indices.size() << "indices", );
+    CORRADE_ASSERT(normals.size() == positions.size(),
+        "MeshTools::generateSmoothNormalsInto(): bad output size, expected" << positions.size() << "but got" << normals.size(), );
+
+    generateSmoothNormalsIntoImplementation(adjacency.offsets(), adjacency.corners(), indices, positions, normals, Magnum::Implementation::resolveThreadCount(threadCount));
 }
 
 }
@@ -248,6 +284,50 @@ void generateSmoothNormalsInto(const Containers::StridedArrayView2D<const char>&
     }
 }
 
+VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const UnsignedInt vertexCount) {
+    return generateVertexTriangleAdjacencyImplementation(indices, vertexCount);
+}
+VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const UnsignedInt vertexCount) {
+    return generateVertexTriangleAdjacencyImplementation(indices, vertexCount);
+}
+VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const UnsignedInt vertexCount) {
+    return generateVertexTriangleAdjacencyImplementation(indices, vertexCount);
+}
+
+VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView2D<const char>& indices, const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateVertexTriangleAdjacency(): second index view dimension is not contiguous", VertexTriangleAdjacency{});
+    if(indices.size()[1] == 4)
+        return generateVertexTriangleAdjacencyImplementation(Containers::arrayCast<1, const UnsignedInt>(indices), vertexCount);
+    else if(indices.size()[1] == 2)
+        return generateVertexTriangleAdjacencyImplementation(Containers::arrayCast<1, const UnsignedShort>(indices), vertexCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateVertexTriangleAdjacency(): expected index type size 1, 2 or 4 but got" << indices.size()[1], VertexTriangleAdjacency{});
+        return generateVertexTriangleAdjacencyImplementation(Containers::arrayCast<1, const UnsignedByte>(indices), vertexCount);
+    }
+}
+
+void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(adjacency, indices, positions, normals, threadCount);
+}
+void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(adjacency, indices, positions, normals, threadCount);
+}
+void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    generateSmoothNormalsIntoImplementation(adjacency, indices, positions, normals, threadCount);
+}
+
+void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateSmoothNormalsInto(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return generateSmoothNormalsIntoImplementation(adjacency, Containers::arrayCast<1, const UnsignedInt>(indices), positions, normals, threadCount);
+    else if(indices.size()[1] == 2)
+        return generateSmoothNormalsIntoImplementation(adjacency, Containers::arrayCast<1, const UnsignedShort>(indices), positions, normals, threadCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateSmoothNormalsInto(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return generateSmoothNormalsIntoImplementation(adjacency, Containers::arrayCast<1, const UnsignedByte>(indices), positions, normals, threadCount);
+    }
+}
+
 namespace {
 
 template<class T> inline Containers::Array<Vector3> generateSmoothNormalsImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions) {
@@ -277,4 +357,27 @@ Containers::Array<Vector3> generateSmoothNormals(const Containers::StridedArrayV
     return out;
 }
 
+
+Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
+    generateSmoothNormalsInto(adjacency, indices, positions, out, threadCount);
+    return out;
+}
+Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
+    generateSmoothNormalsInto(adjacency, indices, positions, out, threadCount);
+    return out;
+}
+Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
+    generateSmoothNormalsInto(adjacency, indices, positions, out, threadCount);
+    return out;
+}
+
+Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt threadCount) {
+    Containers::Array<Vector3> out{Containers::NoInit, positions.size()};
+    generateSmoothNormalsInto(adjacency, indices, positions, out, threadCount);
+    return out;
+}
+
 }}
@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto(), @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto()
+ * @brief Class @ref Magnum::MeshTools::VertexTriangleAdjacency, function @ref Magnum::MeshTools::generateFlatNormals(), @ref Magnum::MeshTools::generateFlatNormalsInto(), @ref Magnum::MeshTools::generateSmoothNormals(), @ref Magnum::MeshTools::generateSmoothNormalsInto(), @ref Magnum::MeshTools::generateVertexTriangleAdjacency()
  */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/MeshTools/visibility.h"
 
@@ -155,7 +157,11 @@ A variant of @ref generateSmoothNormals() that fills existing memory instead of
 allocating a new array. The @p normals array is expected to have the same size
 as @p positions. Note that even with the output array this function isn't fully
 allocation-free --- it still allocates three additional internal arrays for
-adjacent face calculation.
+adjacent face calculation. If you're regenerating normals for a mesh where
+only positions change, calculate the adjacency just once with
+@ref generateVertexTriangleAdjacency() and use
+@ref generateSmoothNormalsInto(const VertexTriangleAdjacency&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt)
+instead, which can also make use of multiple threads.
 
 Useful when you need to interface for example with STL containers --- in that
 case @cpp #include @ce @ref Corrade/Containers/ArrayViewStl.h to get implicit
@@ -191,6 +197,197 @@ etc. overloads.
 */
 MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals);
 
+
+/**
+@brief Vertex-triangle adjacency
+@m_since_latest
+
+For every vertex lists triangle corners that reference it. A corner is a
+position in the index array, i.e. corner @cpp c @ce is vertex
+@cpp c % 3 @ce of triangle @cpp c/3 @ce. Corners referencing vertex
+@cpp i @ce are @cpp corners()[offsets()[i]] @ce until
+@cpp corners()[offsets()[i + 1]] @ce, in the order in which they appear in
+the index array.
+
+The adjacency depends only on the index array, so for meshes that only change
+their positions (such as when applying morph targets or skinning on the CPU)
+it can be calculated just once using @ref generateVertexTriangleAdjacency() and
+then reused for every call to
+@ref generateSmoothNormalsInto(const VertexTriangleAdjacency&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt),
+avoiding the sorting step:
+
+@snippet MagnumMeshTools.cpp generateVertexTriangleAdjacency
+*/
+class MAGNUM_MESHTOOLS_EXPORT VertexTriangleAdjacency {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Creates an adjacency for zero vertices and zero indices.
+         */
+        explicit VertexTriangleAdjacency() noexcept;
+
+        /**
+         * @brief Constructor
+         * @param offsets   Offsets into @p corners for every vertex
+         * @param corners   Triangle corners referencing every vertex
+         *
+         * Expects that @p offsets is not empty and its last element is the
+         * size of @p corners.
+         */
+        explicit VertexTriangleAdjacency(Containers::Array<UnsignedInt>&& offsets, Containers::Array<UnsignedInt>&& corners) noexcept;
+
+        /** @brief Vertex count */
+        UnsignedInt vertexCount() const { return _offsets.size() - 1; }
+
+        /** @brief Index count the adjacency was calculated for */
+        std::size_t indexCount() const { return _corners.size(); }
+
+        /**
+         * @brief Offsets into @ref corners() for every vertex
+         *
+         * Has @ref vertexCount() + 1 elements, the first is always
+         * @cpp 0 @ce and the last is @ref indexCount().
+         */
+        Containers::ArrayView<const UnsignedInt> offsets() const { return _offsets; }
+
+        /**
+         * @brief Triangle corners referencing every vertex
+         *
+         * Has @ref indexCount() elements, ranges of which are referenced by
+         * @ref offsets().
+         */
+        Containers::ArrayView<const UnsignedInt> corners() const { return _corners; }
+
+    private:
+        Containers::Array<UnsignedInt> _offsets;
+        Containers::Array<UnsignedInt> _corners;
+};
+
+/**
+@brief Generate vertex-triangle adjacency
+@param indices      Triangle face indices
+@param vertexCount  Vertex count
+@m_since_latest
+
+Expects that the index count is divisible by 3 and all indices are less than
+@p vertexCount. The operation is @f$ \mathcal{O}(n + m) @f$ for @f$ n @f$
+indices and @f$ m @f$ vertices, using a counting sort.
+@see @ref generateSmoothNormalsInto(const VertexTriangleAdjacency&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt)
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedInt>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedShort>& indices, UnsignedInt vertexCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedByte>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Generate vertex-triangle adjacency using a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateVertexTriangleAdjacency(const Containers::StridedArrayView1D<const UnsignedInt>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT VertexTriangleAdjacency generateVertexTriangleAdjacency(const Containers::StridedArrayView2D<const char>& indices, UnsignedInt vertexCount);
+
+/**
+@brief Generate smooth normals using a precalculated adjacency
+@param adjacency    Vertex-triangle adjacency
+@param indices      Triangle face indices
+@param positions    Triangle vertex positions
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Allocates the output and calls
+@ref generateSmoothNormalsInto(const VertexTriangleAdjacency&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt),
+see its documentation for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector3> generateSmoothNormals(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate smooth normals into an existing array using a precalculated adjacency
+@param[in] adjacency    Vertex-triangle adjacency
+@param[in] indices      Triangle face indices
+@param[in] positions    Triangle vertex positions
+@param[out] normals     Where to put the generated normals
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Produces the same output as
+@ref generateSmoothNormalsInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&),
+independently of @p threadCount, but instead of discovering adjacent
+triangles on every call it uses @p adjacency calculated by
+@ref generateVertexTriangleAdjacency() from the same @p indices. Expects that
+@p adjacency was calculated for the same index count and a vertex count equal
+to size of @p positions and that @p normals has the same size as
+@p positions. The indices themselves are not checked again, it's the
+caller's responsibility to pass the same indices the adjacency was calculated
+from.
+
+Cross products and angles of all faces are calculated on @p threadCount
+threads, each processing a contiguous range of triangles, after which the
+per-vertex accumulation is done in parallel as well, each thread writing to a
+contiguous range of vertices. Meant for large meshes --- if there's less than
+about a thousand triangles or vertices per thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread. The function still allocates one
+internal array for the per-face data.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate smooth normals into an existing array using a precalculated adjacency and a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateSmoothNormalsInto(const VertexTriangleAdjacency&, const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateSmoothNormalsInto(const VertexTriangleAdjacency& adjacency, const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& normals, UnsignedInt threadCount = 1);
+
 }}
 
 #endif
@@ -0,0 +1,263 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateTangents.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+#if defined(CORRADE_MSVC2019_COMPATIBILITY) && !defined(CORRADE_MSVC2017_COMPATIBILITY)
+/* See GenerateNormals.cpp for details */
+using namespace Math::Literals;
+#endif
+
+/* Per-face tangent and bitangent direction together with interior angles at
+   each corner */
+struct FaceTangent {
+    Vector3 tangent;
+    Vector3 bitangent;
+    Vector3 angles;
+};
+
+/* Vertex attributes compared during welding */
+struct WeldKey {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoordinates;
+};
+
+template<class T> void generateTangentsIntoImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::generateTangentsInto(): index count not divisible by 3", );
+    CORRADE_ASSERT(normals.size() == positions.size() && textureCoordinates.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): expected" << positions.size() << "normals and texture coordinates but got" << normals.size() << "and" << textureCoordinates.size(), );
+    CORRADE_ASSERT(tangents.size() == positions.size(),
+        "MeshTools::generateTangentsInto(): bad output size, expected" << positions.size() << "but got" << tangents.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(), "MeshTools::generateTangentsInto(): index" << index << "out of bounds for" << positions.size() << "elements", );
+    #endif
+
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+    const std::size_t vertexCount = positions.size();
+
+    /* If welding, map each vertex to the first vertex that has the same
+       position, normal and texture coordinates. Accumulation is then done
+       for these representative vertices only. */
+    const bool welding = !!(flags & GenerateTangentsFlag::WeldVertices);
+    Containers::Array<UnsignedInt> weld;
+    if(welding) {
+        Containers::Array<WeldKey> keys{Containers::NoInit, vertexCount};
+        for(std::size_t i = 0; i != vertexCount; ++i)
+            keys[i] = WeldKey{positions[i], normals[i], textureCoordinates[i]};
+
+        /* Sort by the key and then by the vertex ID, so the first vertex in
+           each run of equal keys is the one with the lowest ID */
+        Containers::Array<UnsignedInt> order{Containers::NoInit, vertexCount};
+        for(std::size_t i = 0; i != vertexCount; ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&keys](UnsignedInt a, UnsignedInt b) {
+            const int result = std::memcmp(&keys[a], &keys[b], sizeof(WeldKey));
+            return result < 0 || (result == 0 && a < b);
+        });
+
+        weld = Containers::Array<UnsignedInt>{Containers::NoInit, vertexCount};
+        for(std::size_t i = 0; i != vertexCount; ++i) {
+            if(i && std::memcmp(&keys[order[i]], &keys[order[i - 1]], sizeof(WeldKey)) == 0)
+                weld[order[i]] = weld[order[i - 1]];
+            else weld[order[i]] = order[i];
+        }
+    }
+
+    /* Adjacency of either the original or the welded vertices */
+    VertexTriangleAdjacency adjacency;
+    if(welding) {
+        Containers::Array<UnsignedInt> weldedIndices{Containers::NoInit, indices.size()};
+        for(std::size_t i = 0; i != indices.size(); ++i)
+            weldedIndices[i] = weld[indices[i]];
+        adjacency = generateVertexTriangleAdjacency(weldedIndices, UnsignedInt(vertexCount));
+    } else adjacency = generateVertexTriangleAdjacency(indices, UnsignedInt(vertexCount));
+    const Containers::ArrayView<const UnsignedInt> offsets = adjacency.offsets();
+    const Containers::ArrayView<const UnsignedInt> corners = adjacency.corners();
+
+    /* Calculate the tangent and bitangent direction of each face */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<FaceTangent> faces{Containers::NoInit, triangleCount};
+    const UnsignedInt triangleThreadCount = Magnum::Implementation::clampThreadCount(threadCount, triangleCount);
+    Magnum::Implementation::runOnThreads(triangleThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, triangleThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            FaceTangent& face = faces[i];
+            const Vector3 v0 = positions[indices[i*3 + 0]];
+            const Vector3 v1 = positions[indices[i*3 + 1]];
+            const Vector3 v2 = positions[indices[i*3 + 2]];
+            const Vector2 uv0 = textureCoordinates[indices[i*3 + 0]];
+            const Vector2 uv1 = textureCoordinates[indices[i*3 + 1]];
+            const Vector2 uv2 = textureCoordinates[indices[i*3 + 2]];
+
+            /* Solve [e1 e2] = [tangent bitangent]*[duv1 duv2] */
+            const Vector3 e1 = v1 - v0;
+            const Vector3 e2 = v2 - v0;
+            const Vector2 duv1 = uv1 - uv0;
+            const Vector2 duv2 = uv2 - uv0;
+            const Float determinant = duv1.x()*duv2.y() - duv2.x()*duv1.y();
+            face.tangent = ((e1*duv2.y() - e2*duv1.y())/determinant).normalized();
+            face.bitangent = ((e2*duv1.x() - e1*duv2.x())/determinant).normalized();
+
+            /* If the triangle has zero area in positions or texture
+               coordinates or contains NaNs, the directions are NaNs. Make it
+               contribute with a zero angle, effectively ignoring it. */
+            const Vector3 v10n = e1.normalized();
+            const Vector3 v20n = e2.normalized();
+            const Vector3 v21n = (v2 - v1).normalized();
+            if(determinant == 0.0f || Math::isNan(face.tangent) || Math::isNan(face.bitangent) || Math::isNan(v10n) || Math::isNan(v20n) || Math::isNan(v21n)) {
+                face.tangent = face.bitangent = face.angles = Vector3{Math::ZeroInit};
+                continue;
+            }
+
+            /* Inner angle at each vertex of the triangle, same as in
+               generateSmoothNormalsInto() */
+            using namespace Math::Literals;
+            face.angles[0] = Float(Math::angle(v10n, v20n));
+            face.angles[1] = Float(Math::angle(-v10n, v21n));
+            face.angles[2] = Float(Rad(180.0_degf)) - face.angles[0] - face.angles[1];
+        }
+    });
+
+    /* For every vertex accumulate the directions from all faces it (or the
+       vertex it's welded to) belongs to. Each vertex is written to only from
+       one thread, so there's no need for any synchronization. */
+    const UnsignedInt vertexThreadCount = Magnum::Implementation::clampThreadCount(threadCount, vertexCount);
+    Magnum::Implementation::runOnThreads(vertexThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(vertexCount, vertexThreadCount, thread);
+        for(std::size_t v = range.first; v != range.second; ++v) {
+            const std::size_t representative = welding ? weld[v] : v;
+            Vector3 tangent{Math::ZeroInit};
+            Vector3 bitangent{Math::ZeroInit};
+            for(std::size_t i = offsets[representative]; i != offsets[representative + 1]; ++i) {
+                const UnsignedInt corner = corners[i];
+                const FaceTangent& face = faces[corner/3];
+                tangent += face.tangent*face.angles[corner % 3];
+                bitangent += face.bitangent*face.angles[corner % 3];
+            }
+
+            /* Gram-Schmidt orthogonalization against the normal. If that
+               results in a zero vector, pick an arbitrary perpendicular
+               direction. */
+            const Vector3 normal = normals[v];
+            Vector3 orthogonalized = (tangent - normal*Math::dot(normal, tangent)).normalized();
+            if(Math::isNan(orthogonalized)) {
+                orthogonalized = Math::cross(normal, Vector3::xAxis()).normalized();
+                if(Math::isNan(orthogonalized))
+                    orthogonalized = Math::cross(normal, Vector3::yAxis()).normalized();
+            }
+
+            tangents[v] = Vector4{orthogonalized,
+                Math::dot(Math::cross(normal, orthogonalized), bitangent) < 0.0f ? -1.0f : 1.0f};
+        }
+    });
+}
+
+template<class T> inline void generateTangentsIntoImplementation(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(Containers::arrayCast<1, const T>(indices), positions, normals, textureCoordinates, tangents, flags, threadCount);
+}
+
+}
+
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+}
+
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+}
+
+void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    generateTangentsIntoImplementation(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+}
+
+void generateTangentsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.isContiguous<1>(), "MeshTools::generateTangentsInto(): second index view dimension is not contiguous", );
+    if(indices.size()[1] == 4)
+        return generateTangentsIntoImplementation<UnsignedInt>(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+    else if(indices.size()[1] == 2)
+        return generateTangentsIntoImplementation<UnsignedShort>(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+    else {
+        CORRADE_ASSERT(indices.size()[1] == 1, "MeshTools::generateTangentsInto(): expected index type size 1, 2 or 4 but got" << indices.size()[1], );
+        return generateTangentsIntoImplementation<UnsignedByte>(indices, positions, normals, textureCoordinates, tangents, flags, threadCount);
+    }
+}
+
+void generateTangentsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(positions.size() % 3 == 0,
+        "MeshTools::generateTangentsInto(): vertex count not divisible by 3", );
+
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, positions.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i) indices[i] = i;
+    generateTangentsIntoImplementation(Containers::StridedArrayView1D<const UnsignedInt>{indices}, positions, normals, textureCoordinates, tangents, flags, threadCount);
+}
+
+namespace {
+
+template<class T> inline Containers::Array<Vector4> generateTangentsImplementation(const T& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    Containers::Array<Vector4> out{Containers::NoInit, positions.size()};
+    generateTangentsInto(indices, positions, normals, textureCoordinates, out, flags, threadCount);
+    return out;
+}
+
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, flags, threadCount);
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, flags, threadCount);
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, flags, threadCount);
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    return generateTangentsImplementation(indices, positions, normals, textureCoordinates, flags, threadCount);
+}
+
+Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const GenerateTangentsFlags flags, const UnsignedInt threadCount) {
+    Containers::Array<Vector4> out{Containers::NoInit, positions.size()};
+    generateTangentsInto(positions, normals, textureCoordinates, out, flags, threadCount);
+    return out;
+}
+
+}}
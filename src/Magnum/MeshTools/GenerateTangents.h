@@ -0,0 +1,204 @@
+#ifndef Magnum_MeshTools_GenerateTangents_h
+#define Magnum_MeshTools_GenerateTangents_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::generateTangents(), @ref Magnum::MeshTools::generateTangentsInto(), enum @ref Magnum::MeshTools::GenerateTangentsFlag, enum set @ref Magnum::MeshTools::GenerateTangentsFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Tangent generation flag
+@m_since_latest
+
+@see @ref GenerateTangentsFlags, @ref generateTangents(),
+    @ref generateTangentsInto()
+*/
+enum class GenerateTangentsFlag: UnsignedByte {
+    /**
+     * Treat vertices that have bit-exact same position, normal and texture
+     * coordinates as a single vertex when accumulating the per-face
+     * tangents. Useful for meshes that have vertices split due to some other
+     * attribute such as per-face colors, which would otherwise result in
+     * faceted tangents. Vertices on texture coordinate seams are still
+     * treated separately, as their tangent space is different. The welding
+     * involves an @f$ \mathcal{O}(n \log n) @f$ sort of the vertices.
+     */
+    WeldVertices = 1 << 0
+};
+
+/**
+@brief Tangent generation flags
+@m_since_latest
+
+@see @ref generateTangents(), @ref generateTangentsInto()
+*/
+typedef Containers::EnumSet<GenerateTangentsFlag> GenerateTangentsFlags;
+
+CORRADE_ENUMSET_OPERATORS(GenerateTangentsFlags)
+
+/**
+@brief Generate tangents
+@param indices              Triangle face indices
+@param positions            Vertex positions
+@param normals              Vertex normals
+@param textureCoordinates   Vertex texture coordinates
+@param flags                Flags
+@param threadCount          Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@return Per-vertex tangents with bitangent direction in the fourth component
+@m_since_latest
+
+Allocates the output and calls
+@ref generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<Vector4>&, GenerateTangentsFlags, UnsignedInt),
+see its documentation for more information.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents using a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, GenerateTangentsFlags, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents for a non-indexed mesh
+@m_since_latest
+
+Same as @ref generateTangents(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, GenerateTangentsFlags, UnsignedInt),
+but treating each three consecutive vertices as a triangle. Expects that the
+vertex count is divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Vector4> generateTangents(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents into an existing array
+@param[in] indices              Triangle face indices
+@param[in] positions            Vertex positions
+@param[in] normals              Vertex normals
+@param[in] textureCoordinates   Vertex texture coordinates
+@param[out] tangents            Where to put the generated tangents
+@param[in] flags                Flags
+@param[in] threadCount          Count of threads to use. If @cpp 0 @ce, the
+    value of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+For every triangle calculates directions in which the texture coordinates
+increase and averages them for every vertex from all triangles that share it,
+weighted by the angle at given vertex. The averaged tangent is then
+orthogonalized against the vertex normal and normalized, and the fourth
+component is set to @cpp 1.0f @ce or @cpp -1.0f @ce depending on whether the
+averaged bitangent points in the direction of
+@cpp Math::cross(normal, tangent.xyz()) @ce, which is the format
+@ref Trade::MeshAttribute::Tangent and @ref Shaders::Phong::Tangent4 expect.
+If you need a separate bitangent attribute, calculate it as
+@cpp Math::cross(normal, tangent.xyz())*tangent.w() @ce. Triangles with zero
+area in either positions or texture coordinates or containing NaNs don't
+contribute to the calculated tangents; if a vertex has no contributing
+triangles, an arbitrary tangent perpendicular to its normal is picked.
+
+Expects that the index count is divisible by 3, all indices are in bounds and
+that @p normals, @p textureCoordinates and @p tangents have the same size as
+@p positions. Vertices are split exactly where the input has them split ---
+unlike [MikkTSpace](http://www.mikktspace.com/), this function never
+duplicates vertices, so the index buffer stays valid and no re-welding pass
+is needed afterwards. Use @ref GenerateTangentsFlag::WeldVertices if the mesh
+has vertices split for reasons unrelated to texture coordinates.
+
+Per-face directions are calculated on @p threadCount threads, each processing
+a contiguous range of triangles, after which the per-vertex accumulation is
+done in parallel as well, each thread writing to a contiguous range of
+vertices using a @ref VertexTriangleAdjacency, so there's no need for any
+synchronization. If there's less than about a thousand triangles or vertices
+per thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread.
+@see @ref generateSmoothNormalsInto(),
+    @ref MeshTools::CompileFlag::GenerateTangents
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents into an existing array using a type-erased index array
+@m_since_latest
+
+Expects that the second dimension of @p indices is contiguous and represents
+the actual 1/2/4-byte index type. Based on its size then calls one of the
+@ref generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<Vector4>&, GenerateTangentsFlags, UnsignedInt)
+etc. overloads.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView2D<const char>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Generate tangents for a non-indexed mesh into an existing array
+@m_since_latest
+
+Same as @ref generateTangentsInto(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<const Vector2>&, const Containers::StridedArrayView1D<Vector4>&, GenerateTangentsFlags, UnsignedInt),
+but treating each three consecutive vertices as a triangle. Expects that the
+vertex count is divisible by 3.
+*/
+MAGNUM_MESHTOOLS_EXPORT void generateTangentsInto(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Containers::StridedArrayView1D<Vector4>& tangents, GenerateTangentsFlags flags = {}, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -109,11 +109,14 @@ Containers::StridedArrayView2D<char> interleavedMutableData(Trade::MeshData& dat
 
 namespace Implementation {
 
-Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
     /* Nothing to do here, bye! */
     if(!data.attributeCount() && extra.empty()) return {};
 
-    const bool interleaved = isInterleaved(data);
+    /* With positions split into a separate stream the original layout can't
+       be preserved, so pack everything tightly in that case */
+    const bool split = flags & InterleaveFlag::SplitPositions;
+    const bool interleaved = !split && isInterleaved(data);
 
     /* If the mesh is already interleaved, use the original stride to
        preserve all padding, but remove the initial offset. Otherwise calculate
@@ -128,11 +131,20 @@ Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&&
     } else {
         stride = 0;
         minOffset = 0;
+    }
+
+    /* If splitting, positions get their own tightly-packed stream and aren't
+       counted into the stride of the other attributes */
+    std::size_t positionStride = 0;
+    if(!interleaved) {
         /** @todo explitily assert on impl-specific vertex formats here --
             however it should work when the original is already interleaved and
             nothing in extras is impl-specific */
-        for(UnsignedInt i = 0, max = data.attributeCount(); i != max; ++i)
-            stride += attributeSize(data, i);
+        for(UnsignedInt i = 0, max = data.attributeCount(); i != max; ++i) {
+            if(split && data.attributeName(i) == Trade::MeshAttribute::Position)
+                positionStride += attributeSize(data, i);
+            else stride += attributeSize(data, i);
+        }
     }
 
     /* Add the extra attributes and explicit padding */
@@ -144,7 +156,9 @@ Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&&
             stride += extra[i].stride();
         } else {
             /** @todo explitily assert on impl-specific vertex formats here */
-            stride += attributeSize(extra[i]);
+            if(split && extra[i].name() == Trade::MeshAttribute::Position)
+                positionStride += attributeSize(extra[i]);
+            else stride += attributeSize(extra[i]);
             ++extraAttributeCount;
         }
     }
@@ -168,14 +182,27 @@ Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&&
     }
 
     /* Copy existing attribute layout. If the original is already interleaved,
-       preserve relative attribute offsets, otherwise pack tightly. */
+       preserve relative attribute offsets, otherwise pack tightly. When
+       splitting, the offsets are relative to the start of each stream,
+       interleavedLayout() then puts the second stream after the first. */
     std::size_t offset = 0;
+    std::size_t positionOffset = 0;
     for(UnsignedInt i = 0; i != originalAttributeCount; ++i) {
+        if(split && attributeData[i].name() == Trade::MeshAttribute::Position) {
+            attributeData[i] = Trade::MeshAttributeData{
+                attributeData[i].name(), attributeData[i].format(),
+                positionOffset, 0, std::ptrdiff_t(positionStride),
+                attributeData[i].arraySize(), attributeData[i].morphTargetId()};
+            positionOffset += attributeSize(attributeData[i]);
+            continue;
+        }
+
         if(interleaved) offset = attributeData[i].offset(data.vertexData()) - minOffset;
 
         attributeData[i] = Trade::MeshAttributeData{
             attributeData[i].name(), attributeData[i].format(),
-            offset, 0, std::ptrdiff_t(stride), attributeData[i].arraySize()};
+            offset, 0, std::ptrdiff_t(stride), attributeData[i].arraySize(),
+            attributeData[i].morphTargetId()};
 
         if(!interleaved) offset += attributeSize(attributeData[i]);
     }
@@ -195,9 +222,19 @@ Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&&
             continue;
         }
 
+        if(split && extra[i].name() == Trade::MeshAttribute::Position) {
+            attributeData[attributeIndex++] = Trade::MeshAttributeData{
+                extra[i].name(), extra[i].format(),
+                positionOffset, 0, std::ptrdiff_t(positionStride),
+                extra[i].arraySize(), extra[i].morphTargetId()};
+            positionOffset += attributeSize(extra[i]);
+            continue;
+        }
+
         attributeData[attributeIndex++] = Trade::MeshAttributeData{
             extra[i].name(), extra[i].format(),
-            offset, 0, std::ptrdiff_t(stride), extra[i].arraySize()};
+            offset, 0, std::ptrdiff_t(stride), extra[i].arraySize(),
+            extra[i].morphTargetId()};
 
         offset += attributeSize(extra[i]);
     }
@@ -207,48 +244,63 @@ Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&&
 
 }
 
-Trade::MeshData interleavedLayout(Trade::MeshData&& data, const UnsignedInt vertexCount, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
-    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(std::move(data), extra);
+Trade::MeshData interleavedLayout(Trade::MeshData&& data, const UnsignedInt vertexCount, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    Containers::Array<Trade::MeshAttributeData> attributeData = Implementation::interleavedLayout(std::move(data), extra, flags);
 
     /* If there are no attributes, bail -- return an empty mesh with desired
        vertex count but nothing else */
     if(!attributeData)
         return Trade::MeshData{data.primitive(), vertexCount};
 
+    /* If splitting, positions have their own stride and the rest of the
+       attributes goes after them. Otherwise all strides are the same and the
+       position stream is empty. */
+    const bool split = flags & InterleaveFlag::SplitPositions;
+    std::size_t positionStride = 0;
+    std::size_t stride = 0;
+    for(const Trade::MeshAttributeData& attribute: attributeData) {
+        if(split && attribute.name() == Trade::MeshAttribute::Position)
+            positionStride = attribute.stride();
+        else stride = attribute.stride();
+    }
+
     /* Allocate new data array */
-    Containers::Array<char> vertexData{Containers::NoInit, attributeData[0].stride()*vertexCount};
+    Containers::Array<char> vertexData{Containers::NoInit, (positionStride + stride)*vertexCount};
 
     /* Convert the attributes from offset-only and zero vertex count to
        absolute, referencing the above-allocated data array */
     for(Trade::MeshAttributeData& attribute: attributeData) {
+        const std::size_t streamOffset =
+            split && attribute.name() != Trade::MeshAttribute::Position ?
+                positionStride*vertexCount : 0;
         attribute = Trade::MeshAttributeData{
             attribute.name(), attribute.format(),
             Containers::StridedArrayView1D<void>{vertexData,
-                vertexData + attribute.offset(vertexData),
+                vertexData + streamOffset + attribute.offset(vertexData),
                 vertexCount, attribute.stride()},
-            attribute.arraySize()};
+            attribute.arraySize(), attribute.morphTargetId()};
     }
 
     return Trade::MeshData{data.primitive(), std::move(vertexData), std::move(attributeData)};
 }
 
-Trade::MeshData interleavedLayout(Trade::MeshData&& data, const UnsignedInt vertexCount, const std::initializer_list<Trade::MeshAttributeData> extra) {
-    return interleavedLayout(std::move(data), vertexCount, Containers::arrayView(extra));
+Trade::MeshData interleavedLayout(Trade::MeshData&& data, const UnsignedInt vertexCount, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleavedLayout(std::move(data), vertexCount, Containers::arrayView(extra), flags);
 }
 
-Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt vertexCount, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt vertexCount, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
     return interleavedLayout(
         Trade::MeshData{data.primitive(), {}, data.vertexData(),
             Trade::meshAttributeDataNonOwningArray(data.attributeData()),
             data.vertexCount()},
-        vertexCount, extra);
+        vertexCount, extra, flags);
 }
 
-Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt vertexCount, const std::initializer_list<Trade::MeshAttributeData> extra) {
-    return interleavedLayout(data, vertexCount, Containers::arrayView(extra));
+Trade::MeshData interleavedLayout(const Trade::MeshData& data, const UnsignedInt vertexCount, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleavedLayout(data, vertexCount, Containers::arrayView(extra), flags);
 }
 
-Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
     /* Transfer the indices unchanged, in case the mesh is indexed */
     Containers::Array<char> indexData;
     Trade::MeshIndexData indices;
@@ -272,14 +324,14 @@ Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<c
        steal that data as well */
     Containers::Array<char> vertexData;
     Containers::Array<Trade::MeshAttributeData> attributeData;
-    if(interleaved && extra.empty() && (data.vertexDataFlags() & Trade::DataFlag::Owned)) {
+    if(interleaved && extra.empty() && !(flags & InterleaveFlag::SplitPositions) && (data.vertexDataFlags() & Trade::DataFlag::Owned)) {
         attributeData = data.releaseAttributeData();
         vertexData = data.releaseVertexData();
 
     /* Otherwise do it the hard way */
     } else {
         /* Calculate the layout */
-        Trade::MeshData layout = interleavedLayout(data, vertexCount, extra);
+        Trade::MeshData layout = interleavedLayout(data, vertexCount, extra, flags);
 
         /* Copy existing attributes to new locations */
         for(UnsignedInt i = 0; i != data.attributeCount(); ++i)
@@ -320,21 +372,21 @@ Trade::MeshData interleave(Trade::MeshData&& data, const Containers::ArrayView<c
         std::move(vertexData), std::move(attributeData), vertexCount};
 }
 
-Trade::MeshData interleave(Trade::MeshData&& data, const std::initializer_list<Trade::MeshAttributeData> extra) {
-    return interleave(std::move(data), Containers::arrayView(extra));
+Trade::MeshData interleave(Trade::MeshData&& data, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleave(std::move(data), Containers::arrayView(extra), flags);
 }
 
-Trade::MeshData interleave(const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra) {
+Trade::MeshData interleave(const Trade::MeshData& data, const Containers::ArrayView<const Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
     return interleave(Trade::MeshData{data.primitive(),
         /* If data is not indexed, the reference will be also non-indexed */
         {}, data.indexData(), Trade::MeshIndexData{data.indices()},
         {}, data.vertexData(), Trade::meshAttributeDataNonOwningArray(data.attributeData()),
         data.vertexCount()
-    }, extra);
+    }, extra, flags);
 }
 
-Trade::MeshData interleave(const Trade::MeshData& data, const std::initializer_list<Trade::MeshAttributeData> extra) {
-    return interleave(std::move(data), Containers::arrayView(extra));
+Trade::MeshData interleave(const Trade::MeshData& data, const std::initializer_list<Trade::MeshAttributeData> extra, const InterleaveFlags flags) {
+    return interleave(std::move(data), Containers::arrayView(extra), flags);
 }
 
 }}
@@ -26,11 +26,12 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::isInterleaved(), @ref Magnum::MeshTools::interleavedLayout()
+ * @brief Function @ref Magnum::MeshTools::interleave(), @ref Magnum::MeshTools::interleaveInto(), @ref Magnum::MeshTools::isInterleaved(), @ref Magnum::MeshTools::interleavedLayout(), enum @ref Magnum::MeshTools::InterleaveFlag, enum set @ref Magnum::MeshTools::InterleaveFlags
  */
 
 #include <cstring>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/TypeTraits.h>
 
@@ -40,6 +41,38 @@
 
 namespace Magnum { namespace MeshTools {
 
+/**
+@brief Interleaving flag
+@m_since_latest
+
+@see @ref InterleaveFlags,
+    @ref interleavedLayout(const Trade::MeshData&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags),
+    @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
+*/
+enum class InterleaveFlag: UnsignedInt {
+    /**
+     * Put all @ref Trade::MeshAttribute::Position attributes into a separate
+     * tightly-packed stream at the beginning of the vertex data and interleave
+     * all other attributes in a second stream after it. Useful for depth
+     * prepasses and shadow rendering, which then fetch only the positions
+     * instead of the whole interleaved vertex. See
+     * @ref interleavedLayout(const Trade::MeshData&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
+     * for more information.
+     */
+    SplitPositions = 1 << 0
+};
+
+/**
+@brief Interleaving flags
+@m_since_latest
+
+@see @ref interleavedLayout(const Trade::MeshData&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags),
+    @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
+*/
+typedef Containers::EnumSet<InterleaveFlag> InterleaveFlags;
+
+CORRADE_ENUMSET_OPERATORS(InterleaveFlags)
+
 namespace Implementation {
 
 /* Attribute count, skipping gaps. If the attributes are just gaps, returns
@@ -115,7 +148,7 @@ template<class T, class ...U> void writeInterleaved(std::size_t stride, char* st
 }
 
 /* Used internally by interleavedLayout() and concatenate() */
-MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&& data, Containers::ArrayView<const Trade::MeshAttributeData> extra);
+MAGNUM_MESHTOOLS_EXPORT Containers::Array<Trade::MeshAttributeData> interleavedLayout(Trade::MeshData&& data, Containers::ArrayView<const Trade::MeshAttributeData> extra, InterleaveFlags flags = {});
 
 }
 
@@ -252,34 +285,48 @@ instance with attribute and vertex data transferred from the returned instance:
 
 @snippet MagnumMeshTools.cpp interleavedLayout-indices
 
+If @ref InterleaveFlag::SplitPositions is set in @p flags, all
+@ref Trade::MeshAttribute::Position attributes are tightly packed into a
+dedicated stream at the beginning of the vertex data, and all other attributes
+are tightly packed into a second interleaved stream that follows it. Any
+existing interleaved layout of @p data isn't preserved in that case, and
+padding specified in @p extra is applied to the second stream. Both streams
+live in the same vertex data array and the attributes have a different stride
+in each, so @ref isInterleaved() returns @cpp false @ce for the result.
+@ref compile() binds each attribute with its own offset and stride, so the
+positions and the remaining attributes end up in separate vertex buffer
+bindings and a depth-only pass fetches only the position stream:
+
+@snippet MagnumMeshTools-gl.cpp interleave-split-positions
+
 This function will unconditionally allocate a new array to store all
-@ref Trade::MeshAttributeData, use @ref interleavedLayout(Trade::MeshData&&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>)
+@ref Trade::MeshAttributeData, use @ref interleavedLayout(Trade::MeshData&&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
 to avoid that allocation.
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(const Trade::MeshData& data, UnsignedInt vertexCount, Containers::ArrayView<const Trade::MeshAttributeData> extra = {});
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(const Trade::MeshData& data, UnsignedInt vertexCount, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = {});
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(const Trade::MeshData& data, UnsignedInt vertexCount, std::initializer_list<Trade::MeshAttributeData> extra);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(const Trade::MeshData& data, UnsignedInt vertexCount, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = {});
 
 /**
 @brief Create an interleaved mesh layout
 @m_since{2020,06}
 
-Compared to @ref interleavedLayout(const Trade::MeshData&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>)
+Compared to @ref interleavedLayout(const Trade::MeshData&, UnsignedInt, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
 this function can reuse the @ref Trade::MeshAttributeData array from @p data
 instead of allocating a new one if there are no attributes passed in @p extra
 and the attribute array is owned by the mesh.
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(Trade::MeshData&& data, UnsignedInt vertexCount, Containers::ArrayView<const Trade::MeshAttributeData> extra = {});
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(Trade::MeshData&& data, UnsignedInt vertexCount, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = {});
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(Trade::MeshData&& data, UnsignedInt vertexCount, std::initializer_list<Trade::MeshAttributeData> extra);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleavedLayout(Trade::MeshData&& data, UnsignedInt vertexCount, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = {});
 
 /**
 @brief Interleave mesh data
@@ -292,43 +339,45 @@ corresponding space for given attribute type is reserved, with memory left
 uninitialized). The data layouting is done by @ref interleavedLayout(), see its
 documentation for detailed behavior description. Note that offset-only
 @ref Trade::MeshAttributeData instances are not supported in the @p extra
-array.
+array. If @ref InterleaveFlag::SplitPositions is set in @p flags, positions
+are put into a separate stream, see @ref interleavedLayout() for details.
 
 Expects that each attribute in @p extra has either the same amount of elements
 as @p data vertex count or has none. This function will unconditionally make a
 copy of all data even if @p data is already interleaved and needs no change,
-use @ref interleave(Trade::MeshData&&, Containers::ArrayView<const Trade::MeshAttributeData>)
+use @ref interleave(Trade::MeshData&&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
 to avoid that copy.
 @see @ref isInterleaved(), @ref Trade::MeshData::attributeData()
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(const Trade::MeshData& data, Containers::ArrayView<const Trade::MeshAttributeData> extra = {});
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(const Trade::MeshData& data, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = {});
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(const Trade::MeshData& data, std::initializer_list<Trade::MeshAttributeData> extra);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(const Trade::MeshData& data, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = {});
 
 /**
 @brief Interleave mesh data
 @m_since{2020,06}
 
-Compared to @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>)
+Compared to @ref interleave(const Trade::MeshData&, Containers::ArrayView<const Trade::MeshAttributeData>, InterleaveFlags)
 this function can transfer ownership of @p data index buffer (in case it is
-owned) and vertex buffer (in case it is owned, already interleaved and there's
-no @p extra attributes) to the returned instance instead of making copies of
+owned) and vertex buffer (in case it is owned, already interleaved, there's
+no @p extra attributes and @ref InterleaveFlag::SplitPositions isn't set) to
+the returned instance instead of making copies of
 them.
 @see @ref isInterleaved(), @ref Trade::MeshData::indexDataFlags(),
     @ref Trade::MeshData::vertexDataFlags(),
     @ref Trade::MeshData::attributeData()
 */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, Containers::ArrayView<const Trade::MeshAttributeData> extra = {});
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, Containers::ArrayView<const Trade::MeshAttributeData> extra = {}, InterleaveFlags flags = {});
 
 /**
  * @overload
  * @m_since{2020,06}
  */
-MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, std::initializer_list<Trade::MeshAttributeData> extra);
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData interleave(Trade::MeshData&& data, std::initializer_list<Trade::MeshAttributeData> extra, InterleaveFlags flags = {});
 
 }}
 
@@ -0,0 +1,206 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Meshletize.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+Meshlets::Meshlets(Containers::Array<Meshlet>&& meshlets, Containers::Array<UnsignedInt>&& vertices, Containers::Array<UnsignedByte>&& triangles) noexcept: _meshlets{std::move(meshlets)}, _vertices{std::move(vertices)}, _triangles{std::move(triangles)} {}
+
+Containers::Array<UnsignedInt> Meshlets::indicesAsArray() const {
+    Containers::Array<UnsignedInt> out{Containers::NoInit, _triangles.size()};
+    for(const Meshlet& meshlet: _meshlets) {
+        for(std::size_t i = 0; i != meshlet.triangleCount*3; ++i)
+            out[meshlet.triangleOffset*3 + i] = _vertices[meshlet.vertexOffset + _triangles[meshlet.triangleOffset*3 + i]];
+    }
+    return out;
+}
+
+namespace {
+
+/* Bounding sphere of given points using Ritter's algorithm */
+void boundingSphere(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<const UnsignedInt> vertices, Vector3& center, Float& radius) {
+    /* Pick a point farthest from an arbitrary point and then a point
+       farthest from that one, the initial sphere goes through the two */
+    const auto farthest = [&](const Vector3& from) {
+        UnsignedInt out = vertices[0];
+        Float distance = 0.0f;
+        for(const UnsignedInt vertex: vertices) {
+            const Float d = (positions[vertex] - from).dot();
+            if(d > distance) {
+                distance = d;
+                out = vertex;
+            }
+        }
+        return out;
+    };
+    const Vector3& a = positions[farthest(positions[vertices[0]])];
+    const Vector3& b = positions[farthest(a)];
+    center = (a + b)*0.5f;
+    radius = (b - a).length()*0.5f;
+
+    /* Grow the sphere to include all points outside of it */
+    for(const UnsignedInt vertex: vertices) {
+        const Vector3 direction = positions[vertex] - center;
+        const Float distance = direction.length();
+        if(distance <= radius) continue;
+
+        const Float newRadius = (radius + distance)*0.5f;
+        center += direction*((newRadius - radius)/distance);
+        radius = newRadius;
+    }
+}
+
+void finishMeshlet(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::ArrayView<const UnsignedInt> vertices, const Containers::ArrayView<const UnsignedByte> triangles, Meshlet& meshlet) {
+    boundingSphere(positions, vertices.slice(meshlet.vertexOffset, meshlet.vertexOffset + meshlet.vertexCount), meshlet.center, meshlet.radius);
+
+    /* Cone axis is an average of triangle normals, the cutoff is derived
+       from the normal that deviates from it the most */
+    Containers::Array<Vector3> normals{Containers::NoInit, meshlet.triangleCount};
+    Vector3 axis;
+    for(std::size_t i = 0; i != meshlet.triangleCount; ++i) {
+        const UnsignedByte* triangle = triangles.data() + (meshlet.triangleOffset + i)*3;
+        const Vector3& a = positions[vertices[meshlet.vertexOffset + triangle[0]]];
+        const Vector3& b = positions[vertices[meshlet.vertexOffset + triangle[1]]];
+        const Vector3& c = positions[vertices[meshlet.vertexOffset + triangle[2]]];
+        const Vector3 normal = Math::cross(b - a, c - a);
+        const Float length = normal.length();
+        normals[i] = length == 0.0f ? Vector3{} : normal/length;
+        axis += normals[i];
+    }
+
+    const Float axisLength = axis.length();
+    meshlet.coneAxis = axisLength == 0.0f ? Vector3{} : axis/axisLength;
+    Float minDot = axisLength == 0.0f ? -1.0f : 1.0f;
+    for(const Vector3& normal: normals)
+        if(normal != Vector3{}) minDot = Math::min(minDot, Math::dot(normal, meshlet.coneAxis));
+
+    /* Cones wider than about 84 degrees aren't useful for culling, make the
+       test always fail for those */
+    meshlet.coneCutoff = minDot <= 0.1f ? 1.0f : Math::sqrt(1.0f - minDot*minDot);
+}
+
+template<class T> Meshlets meshletizeImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::meshletize(): index count not divisible by 3, got" << indices.size(),
+        (Meshlets{{}, {}, {}}));
+    CORRADE_ASSERT(maxVertexCount >= 3 && maxVertexCount <= 256,
+        "MeshTools::meshletize(): expected max vertex count to be between 3 and 256, got" << maxVertexCount,
+        (Meshlets{{}, {}, {}}));
+    CORRADE_ASSERT(maxTriangleCount,
+        "MeshTools::meshletize(): expected non-zero max triangle count",
+        (Meshlets{{}, {}, {}}));
+
+    /* Local index of each vertex in the meshlet it was last added to, the
+       meshlet ID is stored separately so the array doesn't need to be
+       cleared for every new meshlet. IDs start from 1, so zero-initialized
+       vertices are not in any meshlet. */
+    Containers::Array<UnsignedByte> vertexLocalIndex{Containers::NoInit, positions.size()};
+    Containers::Array<UnsignedInt> vertexMeshlet{Containers::ValueInit, positions.size()};
+
+    Containers::Array<Meshlet> meshlets;
+    Containers::Array<UnsignedInt> vertices;
+    Containers::Array<UnsignedByte> triangles;
+    arrayReserve(triangles, indices.size());
+    Meshlet* meshlet = nullptr;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt triangle[]{indices[i + 0], indices[i + 1], indices[i + 2]};
+        const UnsignedInt meshletId = meshlets.size();
+
+        UnsignedInt newVertexCount = 0;
+        for(std::size_t j = 0; j != 3; ++j) {
+            CORRADE_ASSERT(triangle[j] < positions.size(),
+                "MeshTools::meshletize(): index" << triangle[j] << "out of bounds for" << positions.size() << "elements",
+                (Meshlets{{}, {}, {}}));
+            /* Duplicate vertices in a degenerate triangle are counted just
+               once */
+            if(vertexMeshlet[triangle[j]] != meshletId && (j < 1 || triangle[j] != triangle[0]) && (j < 2 || triangle[j] != triangle[1]))
+                ++newVertexCount;
+        }
+
+        /* Start a new meshlet if this triangle wouldn't fit */
+        if(!meshlet || meshlet->vertexCount + newVertexCount > maxVertexCount || meshlet->triangleCount == maxTriangleCount) {
+            if(meshlet) finishMeshlet(positions, vertices, triangles, *meshlet);
+            meshlet = &arrayAppend(meshlets, Meshlet{UnsignedInt(vertices.size()), UnsignedInt(triangles.size()/3), 0, 0, {}, 0.0f, {}, 0.0f});
+        }
+
+        const UnsignedInt currentMeshletId = meshlets.size();
+        for(const UnsignedInt vertex: triangle) {
+            if(vertexMeshlet[vertex] != currentMeshletId) {
+                vertexMeshlet[vertex] = currentMeshletId;
+                vertexLocalIndex[vertex] = UnsignedByte(meshlet->vertexCount++);
+                arrayAppend(vertices, vertex);
+            }
+            arrayAppend(triangles, vertexLocalIndex[vertex]);
+        }
+        ++meshlet->triangleCount;
+    }
+
+    if(meshlet) finishMeshlet(positions, vertices, triangles, *meshlet);
+
+    /* Convert back to arrays with default deleters */
+    arrayShrink(meshlets, Containers::DefaultInit);
+    arrayShrink(vertices, Containers::DefaultInit);
+    arrayShrink(triangles, Containers::DefaultInit);
+    return Meshlets{std::move(meshlets), std::move(vertices), std::move(triangles)};
+}
+
+}
+
+Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return meshletizeImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return meshletizeImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    return meshletizeImplementation(indices, positions, maxVertexCount, maxTriangleCount);
+}
+
+Meshlets meshletize(const Trade::MeshData& mesh, const UnsignedInt maxVertexCount, const UnsignedInt maxTriangleCount) {
+    CORRADE_ASSERT(mesh.isIndexed(),
+        "MeshTools::meshletize(): mesh data not indexed",
+        (Meshlets{{}, {}, {}}));
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::meshletize(): expected a MeshPrimitive::Triangles mesh but got" << mesh.primitive(),
+        (Meshlets{{}, {}, {}}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::meshletize(): the mesh has no positions",
+        (Meshlets{{}, {}, {}}));
+
+    const Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    return meshletize(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), maxVertexCount, maxTriangleCount);
+}
+
+}}
@@ -0,0 +1,211 @@
+#ifndef Magnum_MeshTools_Meshletize_h
+#define Magnum_MeshTools_Meshletize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::Meshlet, class @ref Magnum::MeshTools::Meshlets, function @ref Magnum::MeshTools::meshletize()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Meshlet description
+@m_since_latest
+
+Describes a single cluster of a mesh split using @ref meshletize(). The
+layout matches a GLSL structure with the same members in the std430 layout,
+as each @ref Vector3 is followed by a @ref Float. An array of these can be
+thus directly uploaded to a shader storage buffer, such as with
+@ref compile(const Trade::MeshData&, const Meshlets&, GL::Buffer&).
+
+The @ref center, @ref radius, @ref coneAxis and @ref coneCutoff fields can be
+used for culling the whole meshlet before rasterization. With a perspective
+camera at position @f$ \boldsymbol{e} @f$, all triangles of the meshlet face
+away from the camera if the following holds, where @f$ \boldsymbol{c} @f$ is
+@ref center, @f$ r @f$ is @ref radius, @f$ \boldsymbol{a} @f$ is
+@ref coneAxis and @f$ t @f$ is @ref coneCutoff: @f[
+    (\boldsymbol{c} - \boldsymbol{e}) \cdot \boldsymbol{a} \ge
+    t |\boldsymbol{c} - \boldsymbol{e}| + r
+@f]
+@see @ref Meshlets
+*/
+struct Meshlet {
+    /** @brief Offset of the first vertex in @ref Meshlets::vertices() */
+    UnsignedInt vertexOffset;
+
+    /**
+     * @brief Offset of the first triangle
+     *
+     * Local indices of the first triangle start at
+     * @cpp 3*triangleOffset @ce in @ref Meshlets::triangles().
+     */
+    UnsignedInt triangleOffset;
+
+    /** @brief Vertex count */
+    UnsignedInt vertexCount;
+
+    /** @brief Triangle count */
+    UnsignedInt triangleCount;
+
+    /** @brief Bounding sphere center */
+    Vector3 center;
+
+    /** @brief Bounding sphere radius */
+    Float radius;
+
+    /**
+     * @brief Normal cone axis
+     *
+     * Normalized average of all triangle normals.
+     */
+    Vector3 coneAxis;
+
+    /**
+     * @brief Normal cone cutoff
+     *
+     * Sine of the angle between @ref coneAxis and the most deviating triangle
+     * normal. If the normals spread too much for the cone to be useful for
+     * culling, the value is @cpp 1.0f @ce, which makes the culling test
+     * always fail.
+     */
+    Float coneCutoff;
+};
+
+/**
+@brief Mesh split into meshlets
+@m_since_latest
+
+Returned by @ref meshletize(). Each item of @ref meshlets() references a range
+of @ref vertices() containing indices into the original vertex data and a
+range of @ref triangles() containing triplets of 8-bit indices into the range
+of @ref vertices().
+@see @ref compile(const Trade::MeshData&, const Meshlets&, GL::Buffer&)
+*/
+class MAGNUM_MESHTOOLS_EXPORT Meshlets {
+    public:
+        /**
+         * @brief Constructor
+         * @param meshlets  Meshlet descriptions
+         * @param vertices  Vertex indices referenced by meshlets
+         * @param triangles Meshlet-local triangle indices
+         */
+        explicit Meshlets(Containers::Array<Meshlet>&& meshlets, Containers::Array<UnsignedInt>&& vertices, Containers::Array<UnsignedByte>&& triangles) noexcept;
+
+        /** @brief Meshlet descriptions */
+        Containers::ArrayView<const Meshlet> meshlets() const { return _meshlets; }
+
+        /**
+         * @brief Vertex indices
+         *
+         * Indices into the original vertex data, ranges of which are
+         * referenced by @ref Meshlet::vertexOffset and
+         * @ref Meshlet::vertexCount.
+         */
+        Containers::ArrayView<const UnsignedInt> vertices() const { return _vertices; }
+
+        /**
+         * @brief Triangle indices
+         *
+         * Triplets of indices into a range of @ref vertices() for each
+         * meshlet, ranges of which are referenced by
+         * @ref Meshlet::triangleOffset and @ref Meshlet::triangleCount.
+         */
+        Containers::ArrayView<const UnsignedByte> triangles() const { return _triangles; }
+
+        /**
+         * @brief Triangle indices into the original vertex data
+         *
+         * Resolves @ref triangles() through @ref vertices(), producing an
+         * index buffer with all meshlet triangles one after another. The
+         * triangles of meshlet @cpp i @ce start at index
+         * @cpp 3*meshlets()[i].triangleOffset @ce.
+         */
+        Containers::Array<UnsignedInt> indicesAsArray() const;
+
+    private:
+        Containers::Array<Meshlet> _meshlets;
+        Containers::Array<UnsignedInt> _vertices;
+        Containers::Array<UnsignedByte> _triangles;
+};
+
+/**
+@brief Split a triangle mesh into meshlets
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxVertexCount   Max vertex count in a meshlet
+@param maxTriangleCount Max triangle count in a meshlet
+@m_since_latest
+
+Goes through the triangles in order and adds them to the current meshlet
+until either of the limits would be exceeded, after which a new meshlet is
+started. As meshlets are thus formed from consecutive triangles, it's
+recommended to call @ref optimizeVertexCacheInPlace() on the indices first to
+make them spatially coherent, which results in less meshlets with tighter
+bounds. The default limits match recommendations for NVIDIA mesh shaders.
+
+Bounding sphere of each meshlet is calculated from its vertices using Ritter's
+algorithm, the normal cone from normals of its triangles, see @ref Meshlet
+for details. Expects that the index count is divisible by 3, all indices are
+less than size of @p positions, @p maxVertexCount is at least 3 and at most
+256 and @p maxTriangleCount is not zero.
+@see @ref Meshlets::indicesAsArray()
+*/
+MAGNUM_MESHTOOLS_EXPORT Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT Meshlets meshletize(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+/**
+@brief Split a triangle mesh data into meshlets
+@m_since_latest
+
+Expects that the mesh is indexed, is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position. Calls @ref meshletize(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+with indices and positions converted using @ref Trade::MeshData::indicesAsArray()
+and @ref Trade::MeshData::positions3DAsArray().
+*/
+MAGNUM_MESHTOOLS_EXPORT Meshlets meshletize(const Trade::MeshData& mesh, UnsignedInt maxVertexCount = 64, UnsignedInt maxTriangleCount = 124);
+
+}}
+
+#endif
@@ -0,0 +1,105 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Morph.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Adds weight*delta to the output. If both are contiguous, they're treated
+   as flat float arrays and processed four floats at a time, strided views
+   and the remainder go one vector at a time. In both cases it's a multiply
+   followed by an add, without FMA, so the output is the same. */
+void accumulate(const Float weight, const Containers::StridedArrayView1D<const Vector3>& delta, const Containers::StridedArrayView1D<Vector3>& output) {
+    #if defined(CORRADE_TARGET_SSE2) || defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    if(delta.isContiguous() && output.isContiguous()) {
+        const Float* const d = static_cast<const Float*>(delta.data());
+        Float* const o = static_cast<Float*>(output.data());
+        const std::size_t floatCount = output.size()*3;
+        std::size_t j = 0;
+        #ifdef CORRADE_TARGET_SSE2
+        const __m128 w = _mm_set1_ps(weight);
+        for(; j + 4 <= floatCount; j += 4)
+            _mm_storeu_ps(o + j, _mm_add_ps(_mm_loadu_ps(o + j), _mm_mul_ps(w, _mm_loadu_ps(d + j))));
+        #else
+        const float32x4_t w = vdupq_n_f32(weight);
+        for(; j + 4 <= floatCount; j += 4)
+            vst1q_f32(o + j, vaddq_f32(vld1q_f32(o + j), vmulq_f32(w, vld1q_f32(d + j))));
+        #endif
+        for(; j != floatCount; ++j)
+            o[j] += weight*d[j];
+        return;
+    }
+    #endif
+
+    for(std::size_t i = 0; i != output.size(); ++i)
+        output[i] += weight*delta[i];
+}
+
+}
+
+void morphInto(const Containers::ArrayView<const Float> weights, const Containers::StridedArrayView1D<const Vector3>& base, const Containers::StridedArrayView2D<const Vector3>& deltas, const Containers::StridedArrayView1D<Vector3>& output, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(weights.size() == deltas.size()[0],
+        "MeshTools::morphInto(): expected" << deltas.size()[0] << "weights but got" << weights.size(), );
+    CORRADE_ASSERT(base.size() == output.size() && deltas.size()[1] == output.size(),
+        "MeshTools::morphInto(): expected base, delta and output views to have the same size but got" << base.size() << Debug::nospace << "," << deltas.size()[1] << "and" << output.size(), );
+
+    const std::size_t vertexCount = output.size();
+    const UnsignedInt count = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), vertexCount);
+    Magnum::Implementation::runOnThreads(count, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(vertexCount, count, thread);
+        const Containers::StridedArrayView1D<Vector3> outputRange = output.slice(range.first, range.second);
+
+        /* Copy the base values first, unless it's done in-place. Then add
+           one target after another, same as in the shader, which results in
+           a linear access pattern for each target. */
+        const Containers::StridedArrayView1D<const Vector3> baseRange = base.slice(range.first, range.second);
+        if(baseRange.data() != outputRange.data() || baseRange.stride() != outputRange.stride())
+            for(std::size_t i = 0; i != outputRange.size(); ++i)
+                outputRange[i] = baseRange[i];
+
+        for(std::size_t i = 0; i != weights.size(); ++i) {
+            if(weights[i] == 0.0f) continue;
+            accumulate(weights[i], deltas[i].slice(range.first, range.second), outputRange);
+        }
+    });
+}
+
+}}
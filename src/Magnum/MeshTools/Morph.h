@@ -0,0 +1,82 @@
+#ifndef Magnum_MeshTools_Morph_h
+#define Magnum_MeshTools_Morph_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::morphInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Apply morph targets on the CPU
+@param[in] weights      Morph target weights
+@param[in] base         Base attribute values
+@param[in] deltas       Per-target deltas. The first dimension is the morph
+    target, the second the vertex.
+@param[out] output      Where to put the morphed values
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+A CPU counterpart to @ref Shaders::MorphTargets, useful for example for
+offline baking of posed collision meshes. Follows the same data conventions
+--- @p deltas contain deltas of all morph targets one after another, matching
+the buffer layout of @ref Shaders-MorphTargets-compute "the compute variant",
+and each output value is calculated as @f[
+    \boldsymbol{v}' = \boldsymbol{v} + \sum_i w_i \boldsymbol{d}_i
+@f]
+
+with the targets added in order and targets with a zero weight skipped. The
+same function can be used for both positions and normals, in the latter
+case the normals are not renormalized, same as in the shader. Expects that
+@p weights has the same size as the first dimension of @p deltas and that
+@p base, @p output and the second dimension of @p deltas have the same size.
+The @p output view can be the same as @p base for in-place morphing.
+
+For morph target attributes stored in a @ref Trade::MeshData, see
+@ref Trade-MeshData-morph-targets.
+
+On x86 and ARM64 the accumulation is done using SIMD instructions if
+@p output and the deltas of given morph target are contiguous, with the
+output the same as with the scalar code. The vertices are split into
+@p threadCount contiguous ranges, each processed on a separate thread. Meant
+for large meshes --- if there's less than about a thousand vertices per
+thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread. Doesn't allocate apart from the
+thread handles.
+@see @ref skinInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void morphInto(Containers::ArrayView<const Float> weights, const Containers::StridedArrayView1D<const Vector3>& base, const Containers::StridedArrayView2D<const Vector3>& deltas, const Containers::StridedArrayView1D<Vector3>& output, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
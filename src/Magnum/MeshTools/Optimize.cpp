@@ -0,0 +1,419 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Optimize.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/MeshTools/Implementation/Tipsify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+template<class T> void optimizeVertexCacheInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt vertexCount, const UnsignedInt batchSize) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3, got" << indices.size(), );
+    CORRADE_ASSERT(batchSize >= 3,
+        "MeshTools::optimizeVertexCacheInPlace(): expected batch size to be at least 3, got" << batchSize, );
+
+    /* Neighboring triangles for each vertex, per-vertex live triangle count */
+    Containers::Array<UnsignedInt> liveTriangleCount, neighborOffset, neighbors;
+    Implementation::buildAdjacency<T>(indices, vertexCount, liveTriangleCount, neighborOffset, neighbors);
+
+    /* Position of the first neighbor that might not be emitted yet for each
+       vertex, advanced as the neighbors get emitted. Avoids repeatedly going
+       through all neighbors of high-valence vertices. */
+    Containers::Array<UnsignedInt> firstLiveNeighbor{Containers::NoInit, vertexCount};
+    Utility::copy(neighborOffset.prefix(vertexCount), firstLiveNeighbor);
+
+    /* Per-triangle emitted flag, ID of the batch each vertex was last put
+       into and ID of the batch in which each triangle was last added to the
+       candidate list. Batch IDs start from 1 so zero-initialized vertices and
+       triangles aren't in any. */
+    /** @todo Have some bitset/staticbitset class for this */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<bool> emitted{triangleCount};
+    Containers::Array<UnsignedInt> vertexBatch{vertexCount};
+    Containers::Array<UnsignedInt> candidateBatch{triangleCount};
+    UnsignedInt batch = 1;
+    UnsignedInt batchVertexCount = 0;
+
+    /* Vertices in the current batch and triangles neighboring them, which
+       are candidates for being emitted next */
+    Containers::Array<UnsignedInt> batchVertices;
+    Containers::Array<UnsignedInt> candidates;
+
+    /* Output index buffer */
+    Containers::Array<T> outputIndices{Containers::NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+
+    /* Cursor for finding an arbitrary triangle that wasn't emitted yet */
+    std::size_t cursor = 0;
+
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        /* Pick a triangle that has the most vertices already in the batch
+           and still fits into it. On a tie prefer the triangle with vertices
+           that have the least remaining triangles, so the batch finishes
+           what it started instead of leaving isolated triangles behind.
+           Emitted triangles are removed from the candidate list along the
+           way. */
+        UnsignedInt next = ~UnsignedInt{};
+        UnsignedInt nextInBatch = 0;
+        UnsignedInt nextLiveTriangleCount = 0;
+        std::size_t candidateCount = 0;
+        for(const UnsignedInt t: candidates) {
+            if(emitted[t]) continue;
+            candidates[candidateCount++] = t;
+
+            UnsignedInt inBatch = 0;
+            UnsignedInt live = 0;
+            for(std::size_t vi = 0; vi != 3; ++vi) {
+                const UnsignedInt v = indices[t*3 + vi];
+                if(vertexBatch[v] == batch) ++inBatch;
+                live += liveTriangleCount[v];
+            }
+
+            if(batchVertexCount + 3 - inBatch > batchSize) continue;
+            if(next == ~UnsignedInt{} || inBatch > nextInBatch || (inBatch == nextInBatch && live < nextLiveTriangleCount)) {
+                next = t;
+                nextInBatch = inBatch;
+                nextLiveTriangleCount = live;
+            }
+        }
+        arrayResize(candidates, candidateCount);
+
+        /* Nothing fits, start a new batch. Continue from a vertex of the
+           previous batch that has the least live triangles remaining to keep
+           the locality, if there's no such vertex pick the first triangle
+           that wasn't emitted yet. */
+        if(next == ~UnsignedInt{}) {
+            UnsignedInt seedVertex = ~UnsignedInt{};
+            for(const UnsignedInt v: batchVertices) {
+                if(!liveTriangleCount[v]) continue;
+                if(seedVertex == ~UnsignedInt{} || liveTriangleCount[v] < liveTriangleCount[seedVertex])
+                    seedVertex = v;
+            }
+
+            if(seedVertex != ~UnsignedInt{}) {
+                for(UnsignedInt ti = firstLiveNeighbor[seedVertex]; ti != neighborOffset[seedVertex + 1]; ++ti) {
+                    if(emitted[neighbors[ti]]) continue;
+                    next = neighbors[ti];
+                    break;
+                }
+            } else {
+                while(emitted[cursor]) ++cursor;
+                next = cursor;
+            }
+
+            CORRADE_INTERNAL_ASSERT(next != ~UnsignedInt{});
+            ++batch;
+            batchVertexCount = 0;
+            arrayResize(batchVertices, 0);
+            arrayResize(candidates, 0);
+        }
+
+        /* Emit the triangle, add its vertices to the batch and their
+           neighbors to the candidate list. At most batchSize neighbors are
+           added for each vertex, the batch can't fit many more anyway and
+           this avoids quadratic complexity with high-valence vertices. */
+        emitted[next] = true;
+        for(std::size_t vi = 0; vi != 3; ++vi) {
+            const UnsignedInt v = indices[next*3 + vi];
+            outputIndices[outputIndex++] = v;
+            --liveTriangleCount[v];
+
+            if(vertexBatch[v] == batch) continue;
+            vertexBatch[v] = batch;
+            ++batchVertexCount;
+            arrayAppend(batchVertices, v);
+
+            while(firstLiveNeighbor[v] != neighborOffset[v + 1] && emitted[neighbors[firstLiveNeighbor[v]]])
+                ++firstLiveNeighbor[v];
+            UnsignedInt added = 0;
+            for(UnsignedInt ti = firstLiveNeighbor[v]; ti != neighborOffset[v + 1] && added != batchSize; ++ti) {
+                const UnsignedInt t = neighbors[ti];
+                if(emitted[t] || candidateBatch[t] == batch) continue;
+                candidateBatch[t] = batch;
+                arrayAppend(candidates, t);
+                ++added;
+            }
+        }
+    }
+
+    /* Swap original index buffer with optimized */
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> void optimizeOverdrawInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt batchSize) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3, got" << indices.size(), );
+    CORRADE_ASSERT(batchSize >= 3,
+        "MeshTools::optimizeOverdrawInPlace(): expected batch size to be at least 3, got" << batchSize, );
+
+    /* Split the triangles into clusters at batch boundaries, using the same
+       model as in optimizeVertexCacheInPlace(). The first triangle always
+       starts a new batch and batch IDs start from 1 so zero-initialized
+       vertices aren't in any. */
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<UnsignedInt> clusterOffsets;
+    {
+        Containers::Array<UnsignedInt> vertexBatch{positions.size()};
+        UnsignedInt batch = 0;
+        UnsignedInt batchVertexCount = 0;
+        for(std::size_t t = 0; t != triangleCount; ++t) {
+            UnsignedInt notInBatch = 0;
+            for(std::size_t vi = 0; vi != 3; ++vi)
+                if(vertexBatch[indices[t*3 + vi]] != batch) ++notInBatch;
+
+            if(!t || batchVertexCount + notInBatch > batchSize) {
+                arrayAppend(clusterOffsets, UnsignedInt(t));
+                ++batch;
+                batchVertexCount = 0;
+            }
+
+            for(std::size_t vi = 0; vi != 3; ++vi) {
+                UnsignedInt& vertex = vertexBatch[indices[t*3 + vi]];
+                if(vertex == batch) continue;
+                vertex = batch;
+                ++batchVertexCount;
+            }
+        }
+        arrayAppend(clusterOffsets, UnsignedInt(triangleCount));
+    }
+    const std::size_t clusterCount = clusterOffsets.size() - 1;
+
+    /* Calculate area-weighted centroid and normal of each cluster and of the
+       whole mesh. The cross product length is twice the triangle area, the
+       factor of two cancels out in the division. */
+    Containers::Array<Vector3> clusterCentroids{Containers::NoInit, clusterCount};
+    Containers::Array<Vector3> clusterNormals{Containers::NoInit, clusterCount};
+    Vector3 meshCentroid;
+    Float meshArea = 0.0f;
+    for(std::size_t c = 0; c != clusterCount; ++c) {
+        Vector3 centroid;
+        Vector3 normal;
+        Float area = 0.0f;
+        for(std::size_t t = clusterOffsets[c]; t != clusterOffsets[c + 1]; ++t) {
+            const Vector3 a = positions[indices[t*3 + 0]];
+            const Vector3 b = positions[indices[t*3 + 1]];
+            const Vector3 d = positions[indices[t*3 + 2]];
+            const Vector3 cross = Math::cross(b - a, d - a);
+            const Float triangleArea = cross.length();
+            centroid += (a + b + d)*triangleArea;
+            normal += cross;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroid;
+        meshArea += area;
+        /* Degenerate clusters have zero area, their centroid doesn't
+           matter */
+        clusterCentroids[c] = area ? centroid/(3.0f*area) : Vector3{};
+        clusterNormals[c] = normal;
+    }
+    if(meshArea) meshCentroid /= 3.0f*meshArea;
+
+    /* Occlusion estimate for each cluster -- distance of its centroid from
+       the mesh centroid in the direction of the cluster normal. Clusters
+       that are further out are more likely to occlude the rest. */
+    Containers::Array<std::pair<Float, UnsignedInt>> sortKeys{Containers::NoInit, clusterCount};
+    for(std::size_t c = 0; c != clusterCount; ++c) {
+        const Float normalLength = clusterNormals[c].length();
+        const Float occlusion = normalLength ?
+            Math::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c])/normalLength : 0.0f;
+        /* Negated to sort in a descending order, the cluster index makes the
+           order stable */
+        sortKeys[c] = {-occlusion, UnsignedInt(c)};
+    }
+    std::sort(sortKeys.begin(), sortKeys.end());
+
+    /* Write the clusters in the sorted order, then copy back */
+    Containers::Array<T> outputIndices{Containers::NoInit, indices.size()};
+    std::size_t outputIndex = 0;
+    for(const std::pair<Float, UnsignedInt>& key: sortKeys) {
+        for(std::size_t i = clusterOffsets[key.second]*3, end = clusterOffsets[key.second + 1]*3; i != end; ++i)
+            outputIndices[outputIndex++] = indices[i];
+    }
+    CORRADE_INTERNAL_ASSERT(outputIndex == indices.size());
+    Utility::copy(outputIndices, indices);
+}
+
+template<class T> void optimizeVertexFetchInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView2D<char>& data) {
+    /* Assign new locations to vertices in the order of first use */
+    const std::size_t vertexCount = data.size()[0];
+    Containers::Array<UnsignedInt> remapping{Containers::DirectInit, vertexCount, ~UnsignedInt{}};
+    UnsignedInt next = 0;
+    for(T& index: indices) {
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::optimizeVertexFetchInPlace(): index" << index << "out of bounds for" << vertexCount << "elements", );
+        UnsignedInt& remapped = remapping[index];
+        if(remapped == ~UnsignedInt{}) remapped = next++;
+        index = remapped;
+    }
+
+    /* Unreferenced vertices go to the end, in the original order */
+    for(UnsignedInt& remapped: remapping)
+        if(remapped == ~UnsignedInt{}) remapped = next++;
+
+    /* Reorder the data through a temporary copy */
+    Containers::Array<char> reordered{Containers::NoInit, vertexCount*data.size()[1]};
+    const Containers::StridedArrayView2D<char> reorderedView{reordered, {vertexCount, data.size()[1]}};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        Utility::copy(data[i], reorderedView[remapping[i]]);
+    Utility::copy(reorderedView, data);
+}
+
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt vertexCount, const UnsignedInt batchSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, batchSize);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const UnsignedInt vertexCount, const UnsignedInt batchSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, batchSize);
+}
+
+void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const UnsignedInt vertexCount, const UnsignedInt batchSize) {
+    optimizeVertexCacheInPlaceImplementation(indices, vertexCount, batchSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt batchSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, batchSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt batchSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, batchSize);
+}
+
+void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt batchSize) {
+    optimizeOverdrawInPlaceImplementation(indices, positions, batchSize);
+}
+
+void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data) {
+    optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data) {
+    optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data) {
+    optimizeVertexFetchInPlaceImplementation(indices, data);
+}
+
+Trade::MeshData optimizeVertexCache(const Trade::MeshData& data, const UnsignedInt batchSize) {
+    return optimizeVertexCache(reference(data), batchSize);
+}
+
+Trade::MeshData optimizeVertexCache(Trade::MeshData&& data, const UnsignedInt batchSize) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeVertexCache(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeVertexCache(): expected a MeshPrimitive::Triangles mesh but got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned so we can modify the indices. If they are already,
+       this is just a passthrough. */
+    Trade::MeshData out = owned(std::move(data));
+    const UnsignedInt vertexCount = out.vertexCount();
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        optimizeVertexCacheInPlace(out.mutableIndices<UnsignedInt>(), vertexCount, batchSize);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        optimizeVertexCacheInPlace(out.mutableIndices<UnsignedShort>(), vertexCount, batchSize);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        optimizeVertexCacheInPlace(out.mutableIndices<UnsignedByte>(), vertexCount, batchSize);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return out;
+}
+
+Trade::MeshData optimizeOverdraw(const Trade::MeshData& data, const UnsignedInt batchSize) {
+    return optimizeOverdraw(reference(data), batchSize);
+}
+
+Trade::MeshData optimizeOverdraw(Trade::MeshData&& data, const UnsignedInt batchSize) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeOverdraw(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::optimizeOverdraw(): expected a MeshPrimitive::Triangles mesh but got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::optimizeOverdraw(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned so we can modify the indices. If they are already,
+       this is just a passthrough. */
+    Trade::MeshData out = owned(std::move(data));
+    const Containers::Array<Vector3> positions = out.positions3DAsArray();
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        optimizeOverdrawInPlace(out.mutableIndices<UnsignedInt>(), Containers::stridedArrayView(positions), batchSize);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        optimizeOverdrawInPlace(out.mutableIndices<UnsignedShort>(), Containers::stridedArrayView(positions), batchSize);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        optimizeOverdrawInPlace(out.mutableIndices<UnsignedByte>(), Containers::stridedArrayView(positions), batchSize);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return out;
+}
+
+Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data) {
+    return optimizeVertexFetch(reference(data));
+}
+
+Trade::MeshData optimizeVertexFetch(Trade::MeshData&& data) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::optimizeVertexFetch(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.attributeCount(),
+        "MeshTools::optimizeVertexFetch(): can't optimize an attributeless mesh",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Turn the passed data into an interleaved owned mutable instance we can
+       operate on. There's a chance the original data are already like this,
+       in which case this will be just a passthrough. */
+    Trade::MeshData out = owned(interleave(std::move(data)));
+    const Containers::StridedArrayView2D<char> vertexData = interleavedMutableData(out);
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        optimizeVertexFetchInPlace(out.mutableIndices<UnsignedInt>(), vertexData);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        optimizeVertexFetchInPlace(out.mutableIndices<UnsignedShort>(), vertexData);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        optimizeVertexFetchInPlace(out.mutableIndices<UnsignedByte>(), vertexData);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return out;
+}
+
+}}
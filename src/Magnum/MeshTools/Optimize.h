@@ -0,0 +1,226 @@
+#ifndef Magnum_MeshTools_Optimize_h
+#define Magnum_MeshTools_Optimize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::optimizeVertexCacheInPlace(), @ref Magnum::MeshTools::optimizeOverdrawInPlace(), @ref Magnum::MeshTools::optimizeVertexFetchInPlace(), @ref Magnum::MeshTools::optimizeVertexCache(), @ref Magnum::MeshTools::optimizeOverdraw(), @ref Magnum::MeshTools::optimizeVertexFetch()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Optimize a triangle mesh for batch-based vertex reuse in-place
+@param[in,out] indices  Index array to operate on
+@param[in] vertexCount  Vertex count
+@param[in] batchSize    Max count of unique vertices in a batch
+@m_since_latest
+
+Unlike @ref tipsifyInPlace(), which assumes a FIFO post-transform cache of
+given size, this models the vertex reuse of contemporary GPUs, which split the
+index stream into batches of at most @p batchSize unique vertices and reuse
+transformed vertices only within a batch. The triangles are reordered
+greedily so each batch covers as many triangles as possible --- a triangle
+that has the most vertices already in the current batch is picked next,
+preferring vertices that have the least triangles remaining. When no
+remaining triangle fits into the batch, a new one is started from a neighbor
+of the previous batch. The default batch size of 32 matches NVIDIA hardware,
+see *Bernhard Kerbl, Michael Kenzel, Elena Ivanchenko, Dieter Schmalstieg and
+Markus Steinberger --- Revisiting The Vertex Cache: Understanding and
+Optimizing Vertex Processing on the modern GPU, HPG 2018,
+https://arbook.icg.tugraz.at/schmalstieg/Schmalstieg_351.pdf*.
+
+Triangle winding is preserved. Expects that the index count is divisible by
+3, @p batchSize is at least 3 and all indices are less than @p vertexCount.
+Complexity is linear in the triangle count for meshes of bounded vertex
+valence.
+@see @ref optimizeVertexCache(), @ref optimizeOverdrawInPlace(),
+    @ref optimizeVertexFetchInPlace()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt vertexCount, UnsignedInt batchSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, UnsignedInt vertexCount, UnsignedInt batchSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexCacheInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, UnsignedInt vertexCount, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize a triangle mesh for reduced overdraw in-place
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] batchSize    Max count of unique vertices in a batch
+@m_since_latest
+
+Splits the index array into clusters at batch boundaries of the vertex reuse
+model described in @ref optimizeVertexCacheInPlace(), so reordering them
+doesn't affect vertex reuse. The clusters are then sorted by a
+view-independent occlusion estimate --- clusters that are further from the
+mesh centroid in the direction of their average normal are more likely to
+occlude other parts of the mesh from any viewpoint and thus go first. Apart
+from the sort of the clusters the complexity is linear. Algorithm based on
+*Pedro V. Sander, Diego Nehab and Joshua Barczak --- Fast Triangle Reordering
+for Vertex Locality and Reduced Overdraw, SIGGRAPH 2007,
+http://gfx.cs.princeton.edu/pubs/Sander_2007_%3ETR/index.php*.
+
+The function is meant to be called on output of
+@ref optimizeVertexCacheInPlace() with the same @p batchSize. Triangle winding
+and order of triangles within each cluster is preserved. Expects that the
+index count is divisible by 3, @p batchSize is at least 3 and all indices are
+less than size of @p positions.
+@see @ref optimizeOverdraw()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt batchSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt batchSize = 32);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeOverdrawInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize vertex data for fetch locality in-place
+@param[in,out] indices  Index array to operate on
+@param[in,out] data     Vertex data to reorder
+@m_since_latest
+
+Reorders items of @p data in the order they're first referenced by
+@p indices and remaps @p indices accordingly, so consecutive primitives fetch
+vertices from neighboring memory locations. Vertices that are not referenced
+are moved to the end, keeping their relative order, so the vertex count
+doesn't change. Works for any primitive type. Expects that all indices are
+less than size of the first dimension of @p data. Should be called after
+@ref optimizeVertexCacheInPlace() and @ref optimizeOverdrawInPlace(), as these
+change the index order.
+@see @ref optimizeVertexFetch()
+*/
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void optimizeVertexFetchInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView2D<char>& data);
+
+/**
+@brief Optimize mesh data for batch-based vertex reuse
+@m_since_latest
+
+Expects that the mesh is indexed and is a @ref MeshPrimitive::Triangles. Calls
+@ref optimizeVertexCacheInPlace() on a copy of the index data, the index type
+is preserved. Vertex data are passed through unchanged. This function
+unconditionally copies the data, if the data are owned by the instance and
+you don't need the original after the process, call
+@ref optimizeVertexCache(Trade::MeshData&&, UnsignedInt) instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(const Trade::MeshData& data, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize mesh data for batch-based vertex reuse
+@m_since_latest
+
+Compared to @ref optimizeVertexCache(const Trade::MeshData&, UnsignedInt),
+index and vertex data that are owned by the instance are transferred to the
+output without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexCache(Trade::MeshData&& data, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize mesh data for reduced overdraw
+@m_since_latest
+
+Expects that the mesh is indexed, is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position. Calls @ref optimizeOverdrawInPlace() on a
+copy of the index data with positions converted using
+@ref Trade::MeshData::positions3DAsArray(), the index type is preserved.
+Vertex data are passed through unchanged. This function unconditionally
+copies the data, if the data are owned by the instance and you don't need the
+original after the process, call
+@ref optimizeOverdraw(Trade::MeshData&&, UnsignedInt) instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(const Trade::MeshData& data, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize mesh data for reduced overdraw
+@m_since_latest
+
+Compared to @ref optimizeOverdraw(const Trade::MeshData&, UnsignedInt), index
+and vertex data that are owned by the instance are transferred to the output
+without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeOverdraw(Trade::MeshData&& data, UnsignedInt batchSize = 32);
+
+/**
+@brief Optimize mesh data for vertex fetch locality
+@m_since_latest
+
+Expects that the mesh is indexed and has at least one attribute. The vertex
+data are interleaved using @ref interleave() and then
+@ref optimizeVertexFetchInPlace() is called on them, the index type is
+preserved. If the input is already interleaved, attribute offsets and
+paddings are preserved. This function unconditionally copies the data, if the
+data are interleaved and owned by the instance and you don't need the original
+after the process, call @ref optimizeVertexFetch(Trade::MeshData&&) instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(const Trade::MeshData& data);
+
+/**
+@brief Optimize mesh data for vertex fetch locality
+@m_since_latest
+
+Compared to @ref optimizeVertexFetch(const Trade::MeshData&), index and vertex
+data that are owned by the instance and already interleaved are operated on
+in-place, without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData optimizeVertexFetch(Trade::MeshData&& data);
+
+}}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Quantize.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+bool isFloat(const VertexFormat format) {
+    return !isVertexFormatImplementationSpecific(format) &&
+        vertexFormatComponentFormat(format) == VertexFormat::Float &&
+        vertexFormatVectorCount(format) == 1;
+}
+
+}
+
+std::pair<Trade::MeshData, Matrix4> quantize(const Trade::MeshData& data, const QuantizeFlags flags) {
+    const UnsignedInt vertexCount = data.vertexCount();
+
+    /* Bounding box of all positions, including morph targets */
+    Range3D bounds{Vector3{Constants::inf()}, Vector3{-Constants::inf()}};
+    bool hasPositions = false;
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        if(data.attributeName(i) != Trade::MeshAttribute::Position || !isFloat(data.attributeFormat(i)))
+            continue;
+
+        const Containers::StridedArrayView2D<const Float> positions = Containers::arrayCast<2, const Float>(data.attribute(i));
+        for(std::size_t j = 0; j != positions.size()[0]; ++j) {
+            for(std::size_t k = 0; k != positions.size()[1]; ++k) {
+                bounds.min()[k] = Math::min(bounds.min()[k], positions[j][k]);
+                bounds.max()[k] = Math::max(bounds.max()[k], positions[j][k]);
+            }
+        }
+        hasPositions = hasPositions || vertexCount != 0;
+    }
+
+    /* Dequantization transform mapping [-1, 1] back to the bounding box.
+       Unused or flat dimensions get a unit scale to keep the matrix
+       invertible. */
+    Vector3 center, halfSize{1.0f};
+    if(hasPositions) for(std::size_t k = 0; k != 3; ++k) {
+        if(bounds.min()[k] > bounds.max()[k]) continue;
+        center[k] = (bounds.min()[k] + bounds.max()[k])*0.5f;
+        const Float size = (bounds.max()[k] - bounds.min()[k])*0.5f;
+        if(size > 0.0f) halfSize[k] = size;
+    }
+    const Matrix4 transformation = Matrix4::translation(center)*Matrix4::scaling(halfSize);
+
+    /* Decide on the output formats */
+    Containers::Array<Trade::MeshAttributeData> attributes{data.attributeCount()};
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const Trade::MeshAttribute name = data.attributeName(i);
+        const VertexFormat format = data.attributeFormat(i);
+        VertexFormat outputFormat = format;
+        if(isFloat(format)) {
+            const UnsignedInt componentCount = vertexFormatComponentCount(format);
+            if(name == Trade::MeshAttribute::Position)
+                outputFormat = vertexFormat(VertexFormat::Short, componentCount, true);
+            else if(name == Trade::MeshAttribute::Normal ||
+                    name == Trade::MeshAttribute::Tangent ||
+                    name == Trade::MeshAttribute::Bitangent)
+                outputFormat = vertexFormat(flags & QuantizeFlag::HighPrecisionNormals ? VertexFormat::Short : VertexFormat::Byte, componentCount, true);
+            else if(name == Trade::MeshAttribute::Color)
+                outputFormat = vertexFormat(flags & QuantizeFlag::HighPrecisionColors ? VertexFormat::UnsignedShort : VertexFormat::UnsignedByte, componentCount, true);
+            else if(name == Trade::MeshAttribute::TextureCoordinates) {
+                bool normalized = !(flags & QuantizeFlag::HalfTextureCoordinates);
+                if(normalized) {
+                    const Containers::StridedArrayView2D<const Float> src = Containers::arrayCast<2, const Float>(data.attribute(i));
+                    for(std::size_t j = 0; j != src.size()[0] && normalized; ++j)
+                        for(std::size_t k = 0; k != src.size()[1]; ++k)
+                            if(!(src[j][k] >= 0.0f && src[j][k] <= 1.0f)) {
+                                normalized = false;
+                                break;
+                            }
+                }
+                outputFormat = normalized ?
+                    vertexFormat(VertexFormat::UnsignedShort, componentCount, true) :
+                    vertexFormat(VertexFormat::Half, componentCount, false);
+            }
+        }
+
+        attributes[i] = Trade::MeshAttributeData{name, outputFormat, nullptr,
+            data.attributeArraySize(i), data.attributeMorphTargetId(i)};
+    }
+
+    Trade::MeshData layout = interleavedLayout(Trade::MeshData{data.primitive(), vertexCount}, vertexCount, attributes);
+
+    /* Temporary storage for values that need to be transformed or clamped
+       before packing */
+    Containers::Array<Float> scratch;
+
+    for(UnsignedInt i = 0; i != data.attributeCount(); ++i) {
+        const VertexFormat format = data.attributeFormat(i);
+        const VertexFormat outputFormat = layout.attributeFormat(i);
+        if(format == outputFormat) {
+            Utility::copy(data.attribute(i), layout.mutableAttribute(i));
+            continue;
+        }
+
+        const Trade::MeshAttribute name = data.attributeName(i);
+        const Containers::StridedArrayView2D<const Float> src = Containers::arrayCast<2, const Float>(data.attribute(i));
+        const Containers::StridedArrayView2D<char> dst = layout.mutableAttribute(i);
+
+        /* Positions get normalized to the bounding box, colors clamped */
+        if(name == Trade::MeshAttribute::Position || name == Trade::MeshAttribute::Color) {
+            arrayResize(scratch, Containers::NoInit, src.size()[0]*src.size()[1]);
+            const Containers::StridedArrayView2D<Float> scratchView{scratch, src.size()};
+            for(std::size_t j = 0; j != src.size()[0]; ++j) {
+                for(std::size_t k = 0; k != src.size()[1]; ++k) {
+                    scratchView[j][k] = name == Trade::MeshAttribute::Position ?
+                        (src[j][k] - center[k])/halfSize[k] :
+                        Math::clamp(src[j][k], 0.0f, 1.0f);
+                }
+            }
+
+            if(name == Trade::MeshAttribute::Position)
+                Math::packInto(scratchView, Containers::arrayCast<2, Short>(dst));
+            else if(vertexFormatComponentFormat(outputFormat) == VertexFormat::UnsignedShort)
+                Math::packInto(scratchView, Containers::arrayCast<2, UnsignedShort>(dst));
+            else
+                Math::packInto(scratchView, Containers::arrayCast<2, UnsignedByte>(dst));
+
+        /* Texture coordinates are either normalized or half-floats */
+        } else if(name == Trade::MeshAttribute::TextureCoordinates) {
+            if(isVertexFormatNormalized(outputFormat))
+                Math::packInto(src, Containers::arrayCast<2, UnsignedShort>(dst));
+            else
+                Math::packHalfInto(src, Containers::arrayCast<2, UnsignedShort>(dst));
+
+        /* Normals, tangents and bitangents are expected to be in range
+           already */
+        } else {
+            if(vertexFormatComponentFormat(outputFormat) == VertexFormat::Short)
+                Math::packInto(src, Containers::arrayCast<2, Short>(dst));
+            else
+                Math::packInto(src, Containers::arrayCast<2, Byte>(dst));
+        }
+    }
+
+    /* Copy the index data, if any */
+    Containers::Array<char> indexData;
+    Trade::MeshIndexData indices;
+    if(data.isIndexed()) {
+        indexData = Containers::Array<char>{Containers::NoInit, data.indexData().size()};
+        indices = Trade::MeshIndexData{data.indexType(), indexData.slice(data.indexOffset(), data.indexOffset() + data.indexCount()*meshIndexTypeSize(data.indexType()))};
+        Utility::copy(data.indexData(), indexData);
+    }
+
+    Containers::Array<char> vertexData = layout.releaseVertexData();
+    return {Trade::MeshData{data.primitive(),
+        std::move(indexData), indices,
+        std::move(vertexData), layout.releaseAttributeData(), vertexCount},
+        transformation};
+}
+
+}}
@@ -0,0 +1,133 @@
+#ifndef Magnum_MeshTools_Quantize_h
+#define Magnum_MeshTools_Quantize_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::quantize(), enum @ref Magnum::MeshTools::QuantizeFlag, enum set @ref Magnum::MeshTools::QuantizeFlags
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Mesh quantization flag
+@m_since_latest
+
+@see @ref QuantizeFlags, @ref quantize()
+*/
+enum class QuantizeFlag: UnsignedByte {
+    /**
+     * Quantize normals, tangents and bitangents to 16-bit normalized types
+     * instead of 8-bit ones.
+     */
+    HighPrecisionNormals = 1 << 0,
+
+    /**
+     * Store texture coordinates as half-floats even if they're all in the
+     * @f$ [0, 1] @f$ range and would fit into 16-bit normalized types.
+     */
+    HalfTextureCoordinates = 1 << 1,
+
+    /**
+     * Quantize colors to 16-bit normalized types instead of 8-bit ones.
+     */
+    HighPrecisionColors = 1 << 2
+};
+
+/**
+@brief Mesh quantization flags
+@m_since_latest
+
+@see @ref quantize()
+*/
+typedef Containers::EnumSet<QuantizeFlag> QuantizeFlags;
+
+CORRADE_ENUMSET_OPERATORS(QuantizeFlags)
+
+/**
+@brief Quantize mesh attributes to packed vertex formats
+@param data     Input mesh
+@param flags    Flags
+@return Quantized mesh and a position dequantization transformation
+@m_since_latest
+
+Converts floating-point attributes to packed types accepted by
+@ref MeshTools::compile() and builtin shaders, using the batch functions from
+@ref Magnum/Math/PackingBatch.h:
+
+-   @ref Trade::MeshAttribute::Position is converted to
+    @ref VertexFormat::Vector2sNormalized or
+    @ref VertexFormat::Vector3sNormalized. The positions are first
+    normalized to the @f$ [-1, 1] @f$ range using a bounding box of all
+    position attributes including morph targets, the returned matrix
+    transforms them back to the original range and is meant to be
+    multiplied into the transformation used for rendering the mesh. For 2D
+    positions the Z axis of the matrix is an identity.
+-   @ref Trade::MeshAttribute::Normal, @ref Trade::MeshAttribute::Tangent
+    and @ref Trade::MeshAttribute::Bitangent are converted to
+    @ref VertexFormat::Vector3bNormalized or
+    @ref VertexFormat::Vector4bNormalized, or to the
+    @ref VertexFormat::Vector3sNormalized and
+    @ref VertexFormat::Vector4sNormalized if
+    @ref QuantizeFlag::HighPrecisionNormals is set. The values are expected
+    to be in the @f$ [-1, 1] @f$ range.
+-   @ref Trade::MeshAttribute::TextureCoordinates are converted to
+    @ref VertexFormat::Vector2usNormalized if all values are in the
+    @f$ [0, 1] @f$ range, and to @ref VertexFormat::Vector2h otherwise or if
+    @ref QuantizeFlag::HalfTextureCoordinates is set.
+-   @ref Trade::MeshAttribute::Color is converted to
+    @ref VertexFormat::Vector3ubNormalized or
+    @ref VertexFormat::Vector4ubNormalized, or to
+    @ref VertexFormat::Vector3usNormalized and
+    @ref VertexFormat::Vector4usNormalized if
+    @ref QuantizeFlag::HighPrecisionColors is set. The values are clamped to
+    the @f$ [0, 1] @f$ range.
+
+Attributes that aren't in a 32-bit floating-point format, custom attributes
+and attributes with other names are copied unchanged. The output attributes
+are interleaved in the same order as in @p data, index data are copied
+unchanged. Example usage:
+
+@snippet MagnumMeshTools.cpp quantize
+
+The builtin attributes restrict normals to three components, so there's no
+octahedral two-component encoding. If the mesh has no positions, the returned
+matrix is an identity.
+@see @ref interleavedLayout()
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Trade::MeshData, Matrix4> quantize(const Trade::MeshData& data, QuantizeFlags flags = {});
+
+}}
+
+#endif
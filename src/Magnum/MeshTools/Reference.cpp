@@ -111,7 +111,8 @@ Trade::MeshData owned(Trade::MeshData&& data) {
                     vertexData.data() + originalAttributeData[i].offset(originalVertexData),
                     vertexCount,
                     originalAttributeData[i].stride()},
-                originalAttributeData[i].arraySize()};
+                originalAttributeData[i].arraySize(),
+                originalAttributeData[i].morphTargetId()};
         }
     }
 
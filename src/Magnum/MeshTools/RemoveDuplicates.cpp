@@ -34,6 +34,7 @@
 #include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/MurmurHash2.h>
 
+#include "Magnum/Implementation/threads.h"
 #include "Magnum/Math/FunctionsBatch.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Reference.h"
@@ -63,6 +64,91 @@ struct ArrayHash {
     private: std::size_t _size;
 };
 
+namespace {
+
+/* Puts index of the first occurence of each item into `indices`, same as
+   removeDuplicatesInto() but using multiple threads. Each thread first hashes
+   a contiguous chunk of the data and distributes the items into `threadCount`
+   partitions based on the hash. Then each thread deduplicates one partition
+   using an open-addressing table. Because the partitions are filled in the
+   original item order, the first occurence found in a partition is the first
+   occurence in the whole data, which makes the output independent of the
+   thread count. */
+void firstOccurencesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount) {
+    const std::size_t dataSize = data.size()[0];
+    const std::size_t keySize = data.size()[1];
+    const char* const dataBegin = static_cast<const char*>(data.data());
+    const std::ptrdiff_t dataStride = data.stride()[0];
+    const ArrayHash hash{keySize};
+    threadCount = Magnum::Implementation::clampThreadCount(threadCount, dataSize);
+
+    /* Hash each item and count how many items from each chunk go into each
+       partition. The counts are stored partition-major so a prefix sum
+       directly gives the output offsets for each chunk. */
+    Containers::Array<std::size_t> hashes{Containers::NoInit, dataSize};
+    Containers::Array<std::size_t> partitionOffsets{Containers::ValueInit, std::size_t(threadCount)*threadCount + 1};
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        Containers::Array<std::size_t> counts{Containers::ValueInit, threadCount};
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(dataSize, threadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            hashes[i] = hash(dataBegin + std::ptrdiff_t(i)*dataStride);
+            ++counts[hashes[i] % threadCount];
+        }
+        for(UnsignedInt partition = 0; partition != threadCount; ++partition)
+            partitionOffsets[partition*threadCount + thread + 1] = counts[partition];
+    });
+    for(std::size_t i = 1; i != partitionOffsets.size(); ++i)
+        partitionOffsets[i] += partitionOffsets[i - 1];
+
+    /* Scatter the item indices to their partitions, each chunk has its own
+       range in each partition so no synchronization is needed */
+    Containers::Array<UnsignedInt> partitioned{Containers::NoInit, dataSize};
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        Containers::Array<std::size_t> offsets{Containers::NoInit, threadCount};
+        for(UnsignedInt partition = 0; partition != threadCount; ++partition)
+            offsets[partition] = partitionOffsets[partition*threadCount + thread];
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(dataSize, threadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i)
+            partitioned[offsets[hashes[i] % threadCount]++] = i;
+    });
+
+    /* Deduplicate each partition using linear probing. The table stores
+       indices to the original data, which is not modified in this function.
+       Bits of the hash that were used to pick the partition are the same for
+       all items in it, so they're not used for picking the slot. */
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt partition) {
+        const std::size_t begin = partitionOffsets[partition*threadCount];
+        const std::size_t end = partitionOffsets[(partition + 1)*threadCount];
+
+        /* Keeping the load factor under 0.5 */
+        std::size_t capacity = 16;
+        while(capacity < 2*(end - begin)) capacity *= 2;
+        const std::size_t mask = capacity - 1;
+        Containers::Array<UnsignedInt> table{Containers::DirectInit, capacity, ~UnsignedInt{}};
+
+        for(std::size_t i = begin; i != end; ++i) {
+            const UnsignedInt item = partitioned[i];
+            const std::size_t itemHash = hashes[item];
+            const char* const itemData = dataBegin + std::ptrdiff_t(item)*dataStride;
+            for(std::size_t slot = (itemHash/threadCount) & mask; ; slot = (slot + 1) & mask) {
+                const UnsignedInt other = table[slot];
+                if(other == ~UnsignedInt{}) {
+                    table[slot] = item;
+                    indices[item] = item;
+                    break;
+                }
+
+                if(hashes[other] == itemHash && std::memcmp(dataBegin + std::ptrdiff_t(other)*dataStride, itemData, keySize) == 0) {
+                    indices[item] = other;
+                    break;
+                }
+            }
+        }
+    });
+}
+
+}
+
 std::size_t removeDuplicatesInto(const Containers::StridedArrayView2D<const char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
     /* Assuming the second dimension is contiguous so we can calculate the
        hashes easily */
@@ -161,6 +247,43 @@ std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(c
     return {std::move(indices), size};
 }
 
+std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const UnsignedInt threadCount) {
+    /* Assuming the second dimension is contiguous so we can calculate the
+       hashes easily */
+    CORRADE_ASSERT(data.empty()[0] || data.isContiguous<1>(),
+        "MeshTools::removeDuplicatesInPlaceInto(): second data view dimension is not contiguous", {});
+
+    const std::size_t dataSize = data.size()[0];
+    CORRADE_ASSERT(indices.size() == dataSize,
+        "MeshTools::removeDuplicatesInPlaceInto(): output index array has" << indices.size() << "elements but expected" << dataSize, {});
+
+    /* Find first occurences of all items without touching the data */
+    firstOccurencesInto(data, indices, Magnum::Implementation::resolveThreadCount(threadCount));
+
+    /* Then move the unique items to the front and turn the first occurences
+       into indices to the unique prefix. The first occurence of an item is
+       never after the item itself so its index is already remapped and its
+       data already moved. Data in [count, i) are either duplicates or were
+       already moved to the [0, count) range, so nothing gets overwritten. */
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != dataSize; ++i) {
+        const UnsignedInt first = indices[i];
+        if(first == i) {
+            if(i != count)
+                Utility::copy(data[i].asContiguous(), data[count].asContiguous());
+            indices[i] = count++;
+        } else indices[i] = indices[first];
+    }
+
+    return count;
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, const UnsignedInt threadCount) {
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
+    const std::size_t size = removeDuplicatesInPlaceInto(data, indices, threadCount);
+    return {std::move(indices), size};
+}
+
 namespace {
 
 template<class IndexType> std::size_t removeDuplicatesIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<char>& data) {
@@ -207,7 +330,9 @@ std::size_t removeDuplicatesIndexedInPlace(const Containers::StridedArrayView2D<
 
 namespace {
 
-template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon) {
+/* Zero threadCount means the single-threaded std::unordered_map code path is
+   used, otherwise everything is done by firstOccurencesInto() */
+template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView2D<T>& data, T epsilon, const UnsignedInt threadCount = 0) {
     /* Compared to the discrete version, we don't require the second dimension
        to be contiguous, as we calculate the hash from a discretized contiguous
        copy */
@@ -240,10 +365,10 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
 
     /* Table containing original vector index for each discretized vector.
        Reserving more buckets than necessary (i.e. as if each vector was
-       unique). */
+       unique). Not used at all in the multi-threaded case. */
     std::size_t dataSize = data.size()[0];
     std::unordered_map<const void*, UnsignedInt, ArrayHash, ArrayEqual> table{
-        dataSize,
+        threadCount ? 0 : dataSize,
         ArrayHash{data.size()[1]*sizeof(std::size_t)},
         ArrayEqual{data.size()[1]*sizeof(std::size_t)}};
 
@@ -256,10 +381,10 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
        dimension. */
     T moveAmount = T(0.0);
     for(std::size_t moving = 0; moving <= vectorSize; ++moving) {
-        for(std::size_t i = 0; i != dataSize; ++i) {
-            /* Take the original vector and discretize it -- append the move
-               amount to given dimension, subtract the minmal offset and divide
-               by epsilon. */
+        /* Take the original vector and discretize it -- append the move
+           amount to given dimension, subtract the minmal offset and divide by
+           epsilon. */
+        auto discretize = [&](const std::size_t i) {
             const Containers::StridedArrayView1D<T> entry = data[i];
             const Containers::ArrayView<std::size_t> discretizedEntry = discretized.slice(i*vectorSize, (i + 1)*vectorSize);
             for(std::size_t vi = 0; vi != vectorSize; ++vi) {
@@ -270,23 +395,60 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
                 if(vi + 1 == moving) c += moveAmount;
                 discretizedEntry[vi] = (c - offsets[vi])/epsilon;
             }
+            return discretizedEntry;
+        };
+
+        std::size_t uniqueSize;
+        if(!threadCount) {
+            for(std::size_t i = 0; i != dataSize; ++i) {
+                const Containers::ArrayView<std::size_t> discretizedEntry = discretize(i);
+
+                /* Try to insert new entry into the table. The inserted
+                   index points into the new data array that has all
+                   duplicates removed. This is a similar workflow to
+                   removeDuplicatesInPlaceInto() with the only difference that
+                   we're remapping an existing index array several times over
+                   instead of creating a new one */
+                const auto result = table.emplace(discretizedEntry, table.size());
+
+                /* Add the (either new or already existing) index into the
+                   array */
+                remapping[i] = result.first->second;
+
+                /* If this is a new combination, copy the data to new
+                   (earlier) position in the array. Data in
+                   [table.size()-1, i) are already present in the
+                   [0, table.size()-1) range from previous iterations so we
+                   aren't overwriting anything. */
+                if(result.second && i != table.size() - 1)
+                    Utility::copy(data[i], data[table.size() - 1]);
+            }
 
-            /* Try to insert new entry into the table. The inserted index
-               points into the new data array that has all duplicates removed.
-               This is a similar workflow to removeDuplicatesInPlaceInto() with
-               the only difference that we're remapping an existing index array
-               several times over instead of creating a new one */
-            const auto result = table.emplace(discretizedEntry, table.size());
-
-            /* Add the (either new or already existing) index into the array */
-            remapping[i] = result.first->second;
-
-            /* If this is a new combination, copy the data to new (earlier)
-               position in the array. Data in [table.size()-1, i) are already
-               present in the [0, table.size()-1) range from previous
-               iterations so we aren't overwriting anything. */
-            if(result.second && i != table.size() - 1)
-                Utility::copy(entry, data[table.size() - 1]);
+            uniqueSize = table.size();
+        } else {
+            /* Discretize all vectors in parallel, then find first occurences
+               of each and compact the data the same way as in the
+               multi-threaded removeDuplicatesInPlaceInto() */
+            const UnsignedInt discretizeThreadCount = Magnum::Implementation::clampThreadCount(threadCount, dataSize);
+            Magnum::Implementation::runOnThreads(discretizeThreadCount, [&](const UnsignedInt thread) {
+                const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(dataSize, discretizeThreadCount, thread);
+                for(std::size_t i = range.first; i != range.second; ++i)
+                    discretize(i);
+            });
+            firstOccurencesInto(Containers::StridedArrayView2D<const char>{
+                Containers::arrayCast<const char>(discretized.prefix(dataSize*vectorSize)),
+                {dataSize, vectorSize*sizeof(std::size_t)}},
+                remapping.prefix(dataSize), threadCount);
+
+            uniqueSize = 0;
+            for(std::size_t i = 0; i != dataSize; ++i) {
+                const UnsignedInt first = remapping[i];
+                if(first == i) {
+                    if(i != uniqueSize)
+                        Utility::copy(data[i], data[uniqueSize]);
+                    remapping[i] = uniqueSize++;
+                } else remapping[i] = remapping[first];
+            }
         }
 
         /* Remap the resulting index array */
@@ -298,7 +460,7 @@ template<class IndexType, class T> std::size_t removeDuplicatesFuzzyIndexedInPla
 
         /* Next time go only through the unique prefix; clear the table for the
            next pass */
-        dataSize = table.size();
+        dataSize = uniqueSize;
         table.clear();
     }
 
@@ -334,7 +496,7 @@ std::size_t removeDuplicatesFuzzyIndexedInPlace(const Containers::StridedArrayVi
 
 namespace {
 
-template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const T epsilon) {
+template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(const Containers::StridedArrayView2D<T>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const T epsilon, const UnsignedInt threadCount = 0) {
     CORRADE_ASSERT(indices.size() == data.size()[0],
         "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has" << indices.size() << "elements but expected" << data.size()[0], {});
 
@@ -344,13 +506,13 @@ template<class T> std::size_t removeDuplicatesFuzzyInPlaceIntoImplementation(con
     UnsignedInt i = 0;
     for(UnsignedInt& index: indices) index = i++;
 
-    const std::size_t size = removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::stridedArrayView(indices), data, epsilon);
+    const std::size_t size = removeDuplicatesFuzzyIndexedInPlaceImplementation(Containers::stridedArrayView(indices), data, epsilon, threadCount);
     return size;
 }
 
-template<class T> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlaceImplementation(const Containers::StridedArrayView2D<T>& data, const T epsilon) {
+template<class T> std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlaceImplementation(const Containers::StridedArrayView2D<T>& data, const T epsilon, const UnsignedInt threadCount = 0) {
     Containers::Array<UnsignedInt> indices{Containers::NoInit, data.size()[0]};
-    const std::size_t size = removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon);
+    const std::size_t size = removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, threadCount);
     return {std::move(indices), size};
 }
 
@@ -372,6 +534,22 @@ std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2
     return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon);
 }
 
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, const Float epsilon, const UnsignedInt threadCount) {
+    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon, Magnum::Implementation::resolveThreadCount(threadCount));
+}
+
+std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, const Double epsilon, const UnsignedInt threadCount) {
+    return removeDuplicatesFuzzyInPlaceImplementation(data, epsilon, Magnum::Implementation::resolveThreadCount(threadCount));
+}
+
+std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Float epsilon, const UnsignedInt threadCount) {
+    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, Magnum::Implementation::resolveThreadCount(threadCount));
+}
+
+std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, const Double epsilon, const UnsignedInt threadCount) {
+    return removeDuplicatesFuzzyInPlaceIntoImplementation(data, indices, epsilon, Magnum::Implementation::resolveThreadCount(threadCount));
+}
+
 namespace {
 
 template<class T> std::size_t removeDuplicatesFuzzyIndexedInPlaceImplementation(const Containers::StridedArrayView2D<char>& indices, const Containers::StridedArrayView2D<T>& data, const T epsilon) {
@@ -448,7 +626,8 @@ Trade::MeshData removeDuplicates(Trade::MeshData&& data) {
                 uniqueVertexData.data() + ownedInterleaved.attributeOffset(i),
                 uniqueVertexCount,
                 ownedInterleaved.attributeStride(i)},
-            ownedInterleaved.attributeArraySize(i)};
+            ownedInterleaved.attributeArraySize(i),
+            ownedInterleaved.attributeMorphTargetId(i)};
 
     Trade::MeshIndexData indices{indexType, indexData};
     return Trade::MeshData{ownedInterleaved.primitive(),
@@ -84,6 +84,44 @@ Same as above, except that the index array is not allocated but put into
 */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
 
+/**
+@brief Remove duplicate data from given array in-place using multiple threads
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@return The resulting index array and size of unique prefix in the cleaned up
+    @p data array
+@m_since_latest
+
+Produces the same output as
+@ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&),
+independently of @p threadCount. Instead of a single @ref std::unordered_map,
+the items are distributed into @p threadCount partitions based on their hash
+and each partition is deduplicated on a separate thread using an
+open-addressing hash table. Meant for large data --- if there's less than about
+a thousand items per thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread.
+@see @ref removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>&, Float, UnsignedInt)
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>& data, UnsignedInt threadCount);
+
+/**
+@brief Remove duplicate data from given array in-place into given output index array using multiple threads
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[out]    indices  Where to put the resulting index array
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@return Size of unique prefix in the cleaned up @p data array
+@m_since_latest
+
+Same as above, except that the index array is not allocated but put into
+@p indices instead. Expects that @p indices has the same size as @p data.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesInPlaceInto(const Containers::StridedArrayView2D<char>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, UnsignedInt threadCount);
+
 /**
 @brief Remove duplicate data from given array
 @param[in] data     Data array
@@ -202,6 +240,55 @@ MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Conta
  */
 MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Double epsilon = Math::TypeTraits<Double>::epsilon());
 
+/**
+@brief Remove duplicate data from given array using fuzzy comparison in-place using multiple threads
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[in] epsilon      Epsilon value, data closer than this distance will be
+    melt together
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@return Size of unique prefix in the cleaned up @p data array and the resulting
+    index array
+@m_since_latest
+
+Produces the same output as
+@ref removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>&, Float),
+independently of @p threadCount. The data are discretized in parallel and
+each pass is then deduplicated the same way as in
+@ref removeDuplicatesInPlace(const Containers::StridedArrayView2D<char>&, UnsignedInt).
+*/
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Float>& data, Float epsilon, UnsignedInt threadCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::pair<Containers::Array<UnsignedInt>, std::size_t> removeDuplicatesFuzzyInPlace(const Containers::StridedArrayView2D<Double>& data, Double epsilon, UnsignedInt threadCount);
+
+/**
+@brief Remove duplicate data from given array using fuzzy comparison in-place into given output index array using multiple threads
+@param[in,out] data     Data array, duplicate items will be cut away with order
+    preserved
+@param[out] indices     Where to put the resulting index array
+@param[in] epsilon      Epsilon value, data closer than this distance will be
+    melt together
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@return Size of unique prefix in the cleaned up @p data array
+@m_since_latest
+
+Same as above, except that the index array is not allocated but put into
+@p indices instead. Expects that @p indices has the same size as @p data.
+*/
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Float>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Float epsilon, UnsignedInt threadCount);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT std::size_t removeDuplicatesFuzzyInPlaceInto(const Containers::StridedArrayView2D<Double>& data, const Containers::StridedArrayView1D<UnsignedInt>& indices, Double epsilon, UnsignedInt threadCount);
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 /**
 @brief Remove duplicate data from a STL vector using fuzzy comparison in-place
@@ -0,0 +1,469 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Simplify.h"
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* Symmetric 4x4 quadric matrix stored as its 10 unique elements, together
+   with a sum of weights of all planes to calculate an average error */
+struct Quadric {
+    Double a00, a01, a02, a03, a11, a12, a13, a22, a23, a33, weight;
+};
+
+void addPlane(Quadric& q, const Vector3d& normal, const Double distance, const Double weight) {
+    q.a00 += weight*normal.x()*normal.x();
+    q.a01 += weight*normal.x()*normal.y();
+    q.a02 += weight*normal.x()*normal.z();
+    q.a03 += weight*normal.x()*distance;
+    q.a11 += weight*normal.y()*normal.y();
+    q.a12 += weight*normal.y()*normal.z();
+    q.a13 += weight*normal.y()*distance;
+    q.a22 += weight*normal.z()*normal.z();
+    q.a23 += weight*normal.z()*distance;
+    q.a33 += weight*distance*distance;
+    q.weight += weight;
+}
+
+void addQuadric(Quadric& a, const Quadric& b) {
+    a.a00 += b.a00;
+    a.a01 += b.a01;
+    a.a02 += b.a02;
+    a.a03 += b.a03;
+    a.a11 += b.a11;
+    a.a12 += b.a12;
+    a.a13 += b.a13;
+    a.a22 += b.a22;
+    a.a23 += b.a23;
+    a.a33 += b.a33;
+    a.weight += b.weight;
+}
+
+/* Weighted average of squared distances of a point from all planes in a sum
+   of two quadrics */
+Double quadricError(const Quadric& a, const Quadric& b, const Vector3& point) {
+    Quadric q = a;
+    addQuadric(q, b);
+    if(q.weight == 0.0) return 0.0;
+
+    const Vector3d p{point};
+    const Double error =
+        q.a00*p.x()*p.x() + q.a11*p.y()*p.y() + q.a22*p.z()*p.z() +
+        2.0*(q.a01*p.x()*p.y() + q.a02*p.x()*p.z() + q.a12*p.y()*p.z()) +
+        2.0*(q.a03*p.x() + q.a13*p.y() + q.a23*p.z()) + q.a33;
+    /* Could get slightly negative due to rounding errors */
+    return Math::max(error, 0.0)/q.weight;
+}
+
+enum class VertexKind: UnsignedByte {
+    /* Can be collapsed into any neighbor */
+    Manifold,
+    /* Can be collapsed only along a boundary edge */
+    Border,
+    /* Shares a position with another vertex, never collapsed */
+    Locked
+};
+
+struct Collapse {
+    UnsignedInt from, to;
+    Double error;
+};
+
+/* Weight of planes perpendicular to boundary edges relative to planes of
+   triangles */
+constexpr Double BorderWeight = 10.0;
+
+/* Triangles referencing each vertex group, triangles around group `g` are
+   triangles[offsets[g]] to triangles[offsets[g + 1]] */
+template<class T> void buildTriangleAdjacency(const Containers::StridedArrayView1D<T>& indices, const Containers::ArrayView<const UnsignedInt> remap, Containers::Array<UnsignedInt>& offsets, Containers::Array<UnsignedInt>& triangles) {
+    offsets = Containers::Array<UnsignedInt>{Containers::ValueInit, remap.size() + 1};
+    for(const T index: indices) ++offsets[remap[index] + 1];
+    for(std::size_t i = 0; i != remap.size(); ++i)
+        offsets[i + 1] += offsets[i];
+
+    Containers::Array<UnsignedInt> cursor{Containers::NoInit, remap.size()};
+    Utility::copy(offsets.prefix(remap.size()), cursor);
+    triangles = Containers::Array<UnsignedInt>{Containers::NoInit, indices.size()};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        triangles[cursor[remap[indices[i]]]++] = i/3;
+}
+
+/* Applies the collapses to first indexCount indices and removes triangles
+   that became degenerate, returning the new index count */
+template<class T> UnsignedInt applyCollapses(const Containers::StridedArrayView1D<T>& indices, const UnsignedInt indexCount, const Containers::ArrayView<const UnsignedInt> collapseTarget, const Containers::ArrayView<const UnsignedInt> remap) {
+    UnsignedInt out = 0;
+    for(UnsignedInt i = 0; i != indexCount; i += 3) {
+        const UnsignedInt a = collapseTarget[indices[i + 0]];
+        const UnsignedInt b = collapseTarget[indices[i + 1]];
+        const UnsignedInt c = collapseTarget[indices[i + 2]];
+        if(remap[a] == remap[b] || remap[b] == remap[c] || remap[a] == remap[c])
+            continue;
+        indices[out++] = a;
+        indices[out++] = b;
+        indices[out++] = c;
+    }
+    return out;
+}
+
+template<class T> UnsignedInt simplifyInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt targetIndexCount, const Float maxError) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::simplifyInPlace(): index count not divisible by 3, got" << indices.size(), {});
+
+    const UnsignedInt vertexCount = positions.size();
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::simplifyInPlace(): index" << index << "out of bounds for" << vertexCount << "elements", {});
+    #endif
+
+    UnsignedInt indexCount = indices.size();
+    if(indexCount <= targetIndexCount) return indexCount;
+
+    /* Group vertices with bitwise equal positions, each group represented by
+       its vertex with the lowest index. Stable sort ensures those are first
+       in each group. */
+    const auto positionLess = [&positions](const UnsignedInt a, const UnsignedInt b) {
+        const Vector3& pa = positions[a];
+        const Vector3& pb = positions[b];
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(pa[i] < pb[i]) return true;
+            if(pb[i] < pa[i]) return false;
+        }
+        return false;
+    };
+    Containers::Array<UnsignedInt> remap{Containers::NoInit, vertexCount};
+    {
+        Containers::Array<UnsignedInt> order{Containers::NoInit, vertexCount};
+        for(UnsignedInt i = 0; i != vertexCount; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), positionLess);
+        for(UnsignedInt i = 0; i != vertexCount; ++i)
+            remap[order[i]] = i && !positionLess(order[i - 1], order[i]) ?
+                remap[order[i - 1]] : order[i];
+    }
+
+    /* Vertices sharing a position are on an attribute seam, lock them. Every
+       other vertex is alone in its group, so its index can be used directly
+       in place of the group index. */
+    Containers::Array<VertexKind> kinds{Containers::ValueInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i) if(remap[i] != i)
+        kinds[i] = kinds[remap[i]] = VertexKind::Locked;
+
+    /* Identity collapse to remove degenerate triangles from the input, as
+       these would confuse the boundary detection */
+    Containers::Array<UnsignedInt> collapseTarget{Containers::NoInit, vertexCount};
+    for(UnsignedInt i = 0; i != vertexCount; ++i) collapseTarget[i] = i;
+    indexCount = applyCollapses(indices, indexCount, collapseTarget, remap);
+
+    Containers::Array<UnsignedInt> triangleOffsets, triangles;
+    buildTriangleAdjacency(indices.prefix(indexCount), remap, triangleOffsets, triangles);
+
+    /* Count of triangles around group `a` that contain also group `b`. If
+       it's one, the edge is on a boundary. */
+    const auto trianglesWith = [&](const UnsignedInt a, const UnsignedInt b) {
+        UnsignedInt count = 0;
+        for(UnsignedInt i = triangleOffsets[a]; i != triangleOffsets[a + 1]; ++i) {
+            const UnsignedInt t = triangles[i]*3;
+            if(remap[indices[t + 0]] == b ||
+               remap[indices[t + 1]] == b ||
+               remap[indices[t + 2]] == b) ++count;
+        }
+        return count;
+    };
+
+    /* Accumulate triangle planes weighted by their area into per-group
+       quadrics. Boundary edges add a plane going through the edge
+       perpendicular to the triangle, which makes the boundary costly to
+       move away from. Mark vertices on such edges as boundary vertices. */
+    Containers::Array<Quadric> quadrics{Containers::ValueInit, vertexCount};
+    for(UnsignedInt i = 0; i != indexCount; i += 3) {
+        const UnsignedInt groups[]{
+            remap[indices[i + 0]],
+            remap[indices[i + 1]],
+            remap[indices[i + 2]]
+        };
+        const Vector3d p[]{
+            Vector3d{positions[groups[0]]},
+            Vector3d{positions[groups[1]]},
+            Vector3d{positions[groups[2]]}
+        };
+        const Vector3d cross = Math::cross(p[1] - p[0], p[2] - p[0]);
+        const Double crossLength = cross.length();
+        if(crossLength == 0.0) continue;
+
+        const Vector3d normal = cross/crossLength;
+        for(const UnsignedInt group: groups)
+            addPlane(quadrics[group], normal, -Math::dot(normal, p[0]), crossLength*0.5);
+
+        for(std::size_t j = 0; j != 3; ++j) {
+            const UnsignedInt a = groups[j];
+            const UnsignedInt b = groups[(j + 1) % 3];
+            if(trianglesWith(a, b) != 1) continue;
+
+            if(kinds[a] == VertexKind::Manifold) kinds[a] = VertexKind::Border;
+            if(kinds[b] == VertexKind::Manifold) kinds[b] = VertexKind::Border;
+
+            const Vector3d edge = p[(j + 1) % 3] - p[j];
+            const Vector3d edgeNormal = Math::cross(edge, normal);
+            const Double edgeNormalLength = edgeNormal.length();
+            if(edgeNormalLength == 0.0) continue;
+            const Vector3d edgeNormalNormalized = edgeNormal/edgeNormalLength;
+            const Double distance = -Math::dot(edgeNormalNormalized, p[j]);
+            const Double weight = edge.dot()*BorderWeight;
+            addPlane(quadrics[a], edgeNormalNormalized, distance, weight);
+            addPlane(quadrics[b], edgeNormalNormalized, distance, weight);
+        }
+    }
+
+    const Double maxErrorSquared = Double(maxError)*Double(maxError);
+    Containers::Array<Collapse> collapses;
+    Containers::Array<bool> locked{Containers::NoInit, vertexCount};
+    while(indexCount > targetIndexCount) {
+        /* Gather the cheaper valid direction of each edge */
+        arrayResize(collapses, 0);
+        for(UnsignedInt i = 0; i != indexCount; ++i) {
+            const UnsignedInt a = indices[i];
+            const UnsignedInt b = indices[i - i % 3 + (i + 1) % 3];
+            const UnsignedInt groupA = remap[a];
+            const UnsignedInt groupB = remap[b];
+            const bool aLocked = kinds[a] == VertexKind::Locked;
+            const bool bLocked = kinds[b] == VertexKind::Locked;
+            if(aLocked && bLocked) continue;
+
+            /* Interior edges are visited from both neighboring triangles,
+               take them only once */
+            const bool border = trianglesWith(groupA, groupB) == 1;
+            if(!border && groupA > groupB) continue;
+
+            const bool collapseA = !aLocked && (kinds[a] == VertexKind::Manifold || border);
+            const bool collapseB = !bLocked && (kinds[b] == VertexKind::Manifold || border);
+            const Double errorA = collapseA ? quadricError(quadrics[groupA], quadrics[groupB], positions[b]) : Constants::inf();
+            const Double errorB = collapseB ? quadricError(quadrics[groupA], quadrics[groupB], positions[a]) : Constants::inf();
+            if(collapseA && errorA <= errorB)
+                arrayAppend(collapses, Collapse{a, b, errorA});
+            else if(collapseB)
+                arrayAppend(collapses, Collapse{b, a, errorB});
+        }
+
+        std::stable_sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+            return a.error < b.error;
+        });
+
+        /* Apply as many of the cheapest collapses as possible. All vertices
+           around a collapsed one get locked for the rest of this pass, so
+           the adjacency and the flip checks stay valid. */
+        for(UnsignedInt i = 0; i != vertexCount; ++i) {
+            collapseTarget[i] = i;
+            locked[i] = false;
+        }
+        UnsignedInt triangleCount = indexCount/3;
+        const UnsignedInt targetTriangleCount = targetIndexCount/3;
+        UnsignedInt collapsedCount = 0;
+        for(const Collapse& collapse: collapses) {
+            if(collapse.error > maxErrorSquared || triangleCount <= targetTriangleCount)
+                break;
+
+            const UnsignedInt groupTo = remap[collapse.to];
+            if(locked[collapse.from] || locked[groupTo]) continue;
+
+            /* Moving the vertex shouldn't flip or rotate by more than
+               about 75 degrees any of the remaining triangles around it,
+               count those that get removed */
+            const Vector3& target = positions[collapse.to];
+            UnsignedInt removedCount = 0;
+            bool flips = false;
+            for(UnsignedInt j = triangleOffsets[collapse.from]; j != triangleOffsets[collapse.from + 1]; ++j) {
+                const UnsignedInt t = triangles[j]*3;
+                Vector3 p[3];
+                bool removed = false;
+                for(std::size_t k = 0; k != 3; ++k) {
+                    const UnsignedInt index = indices[t + k];
+                    if(remap[index] == groupTo) removed = true;
+                    p[k] = positions[index];
+                }
+                if(removed) {
+                    ++removedCount;
+                    continue;
+                }
+
+                const Vector3 before = Math::cross(p[1] - p[0], p[2] - p[0]);
+                for(std::size_t k = 0; k != 3; ++k)
+                    if(indices[t + k] == collapse.from) p[k] = target;
+                const Vector3 after = Math::cross(p[1] - p[0], p[2] - p[0]);
+                if(Math::dot(before, after) <= 0.25f*before.length()*after.length()) {
+                    flips = true;
+                    break;
+                }
+            }
+            if(flips) continue;
+
+            for(UnsignedInt j = triangleOffsets[collapse.from]; j != triangleOffsets[collapse.from + 1]; ++j) {
+                const UnsignedInt t = triangles[j]*3;
+                for(std::size_t k = 0; k != 3; ++k)
+                    locked[remap[indices[t + k]]] = true;
+            }
+
+            collapseTarget[collapse.from] = collapse.to;
+            addQuadric(quadrics[groupTo], quadrics[collapse.from]);
+            triangleCount -= removedCount;
+            ++collapsedCount;
+        }
+
+        if(!collapsedCount) break;
+
+        indexCount = applyCollapses(indices, indexCount, collapseTarget, remap);
+        buildTriangleAdjacency(indices.prefix(indexCount), remap, triangleOffsets, triangles);
+    }
+
+    return indexCount;
+}
+
+/* Creates a mesh with the vertex data taken from given owned instance and
+   given index data */
+Trade::MeshData withIndexData(Trade::MeshData&& data, Containers::Array<char>&& indexData) {
+    const MeshPrimitive primitive = data.primitive();
+    const MeshIndexType indexType = data.indexType();
+    const UnsignedInt vertexCount = data.vertexCount();
+    const Trade::MeshIndexData indices{indexType, Containers::arrayView(indexData)};
+    Containers::Array<char> vertexData = data.releaseVertexData();
+    Containers::Array<Trade::MeshAttributeData> attributeData = data.releaseAttributeData();
+    return Trade::MeshData{primitive, std::move(indexData), indices,
+        std::move(vertexData), std::move(attributeData), vertexCount};
+}
+
+template<class T> void copyIndicesInto(const Containers::ArrayView<const UnsignedInt> src, const Containers::ArrayView<char> dst) {
+    const Containers::ArrayView<T> dstIndices = Containers::arrayCast<T>(dst);
+    for(std::size_t i = 0; i != src.size(); ++i)
+        dstIndices[i] = src[i];
+}
+
+}
+
+UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt targetIndexCount, const Float maxError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, maxError);
+}
+
+UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt targetIndexCount, const Float maxError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, maxError);
+}
+
+UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt targetIndexCount, const Float maxError) {
+    return simplifyInPlaceImplementation(indices, positions, targetIndexCount, maxError);
+}
+
+Trade::MeshData simplify(const Trade::MeshData& data, const UnsignedInt targetIndexCount, const Float maxError) {
+    return simplify(reference(data), targetIndexCount, maxError);
+}
+
+Trade::MeshData simplify(Trade::MeshData&& data, const UnsignedInt targetIndexCount, const Float maxError) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::simplify(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::simplify(): expected a MeshPrimitive::Triangles mesh but got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::simplify(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned so we can modify the indices. If they are already,
+       this is just a passthrough. */
+    Trade::MeshData out = owned(std::move(data));
+    const Containers::Array<Vector3> positions = out.positions3DAsArray();
+    UnsignedInt indexCount;
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        indexCount = simplifyInPlace(out.mutableIndices<UnsignedInt>(), Containers::stridedArrayView(positions), targetIndexCount, maxError);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        indexCount = simplifyInPlace(out.mutableIndices<UnsignedShort>(), Containers::stridedArrayView(positions), targetIndexCount, maxError);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        indexCount = simplifyInPlace(out.mutableIndices<UnsignedByte>(), Containers::stridedArrayView(positions), targetIndexCount, maxError);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    /* Copy the simplified prefix to a tightly-packed index buffer */
+    const Containers::StridedArrayView2D<const char> indices = out.indices().prefix(indexCount);
+    Containers::Array<char> indexData{Containers::NoInit, indices.size()[0]*indices.size()[1]};
+    Utility::copy(indices, Containers::StridedArrayView2D<char>{indexData, indices.size()});
+    return withIndexData(std::move(out), std::move(indexData));
+}
+
+Trade::MeshData generateLodChain(const Trade::MeshData& data, const Containers::ArrayView<const UnsignedInt> targetIndexCounts, const Containers::StridedArrayView1D<UnsignedInt>& lodIndexOffsets, const Float maxError) {
+    return generateLodChain(reference(data), targetIndexCounts, lodIndexOffsets, maxError);
+}
+
+Trade::MeshData generateLodChain(Trade::MeshData&& data, const Containers::ArrayView<const UnsignedInt> targetIndexCounts, const Containers::StridedArrayView1D<UnsignedInt>& lodIndexOffsets, const Float maxError) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::generateLodChain(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::generateLodChain(): expected a MeshPrimitive::Triangles mesh but got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::generateLodChain(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(lodIndexOffsets.size() == targetIndexCounts.size() + 1,
+        "MeshTools::generateLodChain(): expected" << targetIndexCounts.size() + 1 << "offsets but got" << lodIndexOffsets.size(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Each level is simplified from a prefix of the previous one, collect
+       all of them as 32-bit indices and convert to the original type at the
+       end */
+    const Containers::Array<Vector3> positions = data.positions3DAsArray();
+    Containers::Array<UnsignedInt> level = data.indicesAsArray();
+    UnsignedInt levelIndexCount = level.size();
+    Containers::Array<UnsignedInt> chain;
+    for(std::size_t i = 0; i != targetIndexCounts.size(); ++i) {
+        levelIndexCount = simplifyInPlace(level.prefix(levelIndexCount), Containers::stridedArrayView(positions), targetIndexCounts[i], maxError);
+        lodIndexOffsets[i] = UnsignedInt(chain.size());
+        arrayAppend(chain, Containers::ArrayView<const UnsignedInt>{level}.prefix(levelIndexCount));
+    }
+    lodIndexOffsets[targetIndexCounts.size()] = UnsignedInt(chain.size());
+
+    /* Make the vertex data owned. If they are already, this is just a
+       passthrough. */
+    Trade::MeshData out = owned(std::move(data));
+    Containers::Array<char> indexData{Containers::NoInit, chain.size()*meshIndexTypeSize(out.indexType())};
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        copyIndicesInto<UnsignedInt>(chain, indexData);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        copyIndicesInto<UnsignedShort>(chain, indexData);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        copyIndicesInto<UnsignedByte>(chain, indexData);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return withIndexData(std::move(out), std::move(indexData));
+}
+
+}}
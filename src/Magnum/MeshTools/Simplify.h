@@ -0,0 +1,168 @@
+#ifndef Magnum_MeshTools_Simplify_h
+#define Magnum_MeshTools_Simplify_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::simplifyInPlace(), @ref Magnum::MeshTools::simplify(), @ref Magnum::MeshTools::generateLodChain()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Simplify a triangle mesh in-place
+@param[in,out] indices      Index array to operate on
+@param[in] positions        Vertex positions
+@param[in] targetIndexCount Target index count
+@param[in] maxError         Max allowed error
+@return Index count of the simplified mesh
+@m_since_latest
+
+Iteratively collapses edges with the smallest quadric error metric until the
+index count gets to @p targetIndexCount or there's no collapse with error
+less or equal to @p maxError. The simplified mesh is written to a prefix of
+@p indices of returned size, the rest of the array is left in an unspecified
+state. Based on *Michael Garland and Paul S. Heckbert --- Surface
+Simplification Using Quadric Error Metrics, SIGGRAPH 1997,
+https://www.cs.cmu.edu/~./garland/Papers/quadrics.pdf*.
+
+The error is a square root of an area-weighted average of squared distances
+of the collapsed vertex from planes of triangles originally surrounding it,
+meaning it's in the same units as @p positions. Boundary edges contribute
+additional planes perpendicular to the surface, so the mesh outline is
+preserved as well.
+
+Edges are always collapsed into one of their endpoints, so vertices don't
+get moved and the simplified mesh can share a vertex buffer with the
+original. Vertices that have the same position as some other vertex, which
+happens on attribute seams such as texture coordinate or normal
+discontinuities, are never collapsed, which means the seams stay intact.
+Vertices on mesh boundaries are collapsed only along the boundary.
+Collapses that would flip or considerably rotate a triangle are rejected and
+triangles that become degenerate are removed, including degenerate triangles
+in the input.
+
+The result count doesn't need to reach @p targetIndexCount if there are not
+enough edges to collapse. Expects that the index count is divisible by 3 and
+all indices are less than size of @p positions. It's recommended to pass the
+result through @ref optimizeVertexCacheInPlace() afterwards, as the
+simplification doesn't respect it.
+@see @ref simplify(), @ref generateLodChain()
+*/
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt targetIndexCount, Float maxError = Constants::inf());
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt targetIndexCount, Float maxError = Constants::inf());
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT UnsignedInt simplifyInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt targetIndexCount, Float maxError = Constants::inf());
+
+/**
+@brief Simplify mesh data
+@m_since_latest
+
+Expects that the mesh is indexed, is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position. Calls @ref simplifyInPlace() on a copy of
+the index data with positions converted using
+@ref Trade::MeshData::positions3DAsArray(), the index type is preserved. The
+vertex data are passed through unchanged, including vertices that are no
+longer referenced. This function unconditionally copies the data, if the data
+are owned by the instance and you don't need the original after the process,
+call @ref simplify(Trade::MeshData&&, UnsignedInt, Float) instead.
+@see @ref generateLodChain()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(const Trade::MeshData& data, UnsignedInt targetIndexCount, Float maxError = Constants::inf());
+
+/**
+@brief Simplify mesh data
+@m_since_latest
+
+Compared to @ref simplify(const Trade::MeshData&, UnsignedInt, Float), vertex
+data that are owned by the instance are transferred to the output without a
+copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData simplify(Trade::MeshData&& data, UnsignedInt targetIndexCount, Float maxError = Constants::inf());
+
+/**
+@brief Generate a chain of progressively simplified levels of detail
+@param[in] data             Input mesh
+@param[in] targetIndexCounts Target index count for each level
+@param[out] lodIndexOffsets Where to put offsets of each level in the
+    output index buffer
+@param[in] maxError         Max allowed error
+@m_since_latest
+
+Produces a mesh with the same vertex data as @p data and an index buffer
+containing all levels one after another. Each level is created by calling
+@ref simplifyInPlace() on a copy of the previous level, the first level is
+simplified from @p data. A level with a target index count larger than its
+predecessor is thus the same as the predecessor, which is useful for having
+the original mesh as the first level. Level @cpp i @ce occupies indices from
+@cpp lodIndexOffsets[i] @ce to @cpp lodIndexOffsets[i + 1] @ce, meaning
+@p lodIndexOffsets is expected to have one more item than
+@p targetIndexCounts. When rendering, the whole mesh can be uploaded at once
+and a particular level then selected with a @ref GL::MeshView:
+
+@snippet MagnumMeshTools-gl.cpp generateLodChain
+
+Expects that the mesh is indexed, is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position, the index type is preserved. As each
+level is simplified from its predecessor, the @p maxError limit is relative
+to the predecessor and not to the original mesh. This function
+unconditionally copies the vertex data, if the data are owned by the instance
+and you don't need the original after the process, call
+@ref generateLodChain(Trade::MeshData&&, Containers::ArrayView<const UnsignedInt>, const Containers::StridedArrayView1D<UnsignedInt>&, Float)
+instead.
+@see @ref simplify()
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateLodChain(const Trade::MeshData& data, Containers::ArrayView<const UnsignedInt> targetIndexCounts, const Containers::StridedArrayView1D<UnsignedInt>& lodIndexOffsets, Float maxError = Constants::inf());
+
+/**
+@brief Generate a chain of progressively simplified levels of detail
+@m_since_latest
+
+Compared to @ref generateLodChain(const Trade::MeshData&, Containers::ArrayView<const UnsignedInt>, const Containers::StridedArrayView1D<UnsignedInt>&, Float),
+vertex data that are owned by the instance are transferred to the output
+without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData generateLodChain(Trade::MeshData&& data, Containers::ArrayView<const UnsignedInt> targetIndexCounts, const Containers::StridedArrayView1D<UnsignedInt>& lodIndexOffsets, Float maxError = Constants::inf());
+
+}}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Skin.h"
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace MeshTools {
+
+namespace {
+
+/* The SIMD variants blend the four joint matrices with a matrix column in
+   each register and then transform the position and normal with the blended
+   columns. The additions are done in the same order as in the scalar code,
+   which in turn is the same as in RectangularMatrix::operator*(), and
+   without FMA, so the output is the same everywhere. */
+
+template<bool normals> void skinRange(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normalsIn, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals, const std::size_t begin, const std::size_t end) {
+    for(std::size_t i = begin; i != end; ++i) {
+        const Vector4ui& id = jointIds[i];
+        const Vector4& w = weights[i];
+
+        #if defined(CORRADE_TARGET_SSE2)
+        const Float* const m0 = jointMatrices[id[0]].data();
+        const Float* const m1 = jointMatrices[id[1]].data();
+        const Float* const m2 = jointMatrices[id[2]].data();
+        const Float* const m3 = jointMatrices[id[3]].data();
+        const __m128 w0 = _mm_set1_ps(w[0]), w1 = _mm_set1_ps(w[1]), w2 = _mm_set1_ps(w[2]), w3 = _mm_set1_ps(w[3]);
+        __m128 c[4];
+        for(std::size_t col = 0; col != 4; ++col) c[col] = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(w0, _mm_loadu_ps(m0 + col*4)),
+            _mm_mul_ps(w1, _mm_loadu_ps(m1 + col*4))),
+            _mm_mul_ps(w2, _mm_loadu_ps(m2 + col*4))),
+            _mm_mul_ps(w3, _mm_loadu_ps(m3 + col*4)));
+
+        const Float* const p = positions[i].data();
+        __m128 o = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+            _mm_mul_ps(c[0], _mm_set1_ps(p[0])),
+            _mm_mul_ps(c[1], _mm_set1_ps(p[1]))),
+            _mm_mul_ps(c[2], _mm_set1_ps(p[2]))),
+            c[3]);
+        o = _mm_div_ps(o, _mm_shuffle_ps(o, o, _MM_SHUFFLE(3, 3, 3, 3)));
+        /* Storing just the first three components to not overwrite what's
+           after */
+        Float* const d = skinnedPositions[i].data();
+        _mm_storel_pi(reinterpret_cast<__m64*>(d), o);
+        _mm_store_ss(d + 2, _mm_movehl_ps(o, o));
+
+        if(normals) {
+            const Float* const n = normalsIn[i].data();
+            const __m128 on = _mm_add_ps(_mm_add_ps(
+                _mm_mul_ps(c[0], _mm_set1_ps(n[0])),
+                _mm_mul_ps(c[1], _mm_set1_ps(n[1]))),
+                _mm_mul_ps(c[2], _mm_set1_ps(n[2])));
+            Float* const dn = skinnedNormals[i].data();
+            _mm_storel_pi(reinterpret_cast<__m64*>(dn), on);
+            _mm_store_ss(dn + 2, _mm_movehl_ps(on, on));
+        }
+        #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+        const Float* const m0 = jointMatrices[id[0]].data();
+        const Float* const m1 = jointMatrices[id[1]].data();
+        const Float* const m2 = jointMatrices[id[2]].data();
+        const Float* const m3 = jointMatrices[id[3]].data();
+        const float32x4_t w0 = vdupq_n_f32(w[0]), w1 = vdupq_n_f32(w[1]), w2 = vdupq_n_f32(w[2]), w3 = vdupq_n_f32(w[3]);
+        float32x4_t c[4];
+        for(std::size_t col = 0; col != 4; ++col) c[col] = vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_f32(w0, vld1q_f32(m0 + col*4)),
+            vmulq_f32(w1, vld1q_f32(m1 + col*4))),
+            vmulq_f32(w2, vld1q_f32(m2 + col*4))),
+            vmulq_f32(w3, vld1q_f32(m3 + col*4)));
+
+        const Float* const p = positions[i].data();
+        float32x4_t o = vaddq_f32(vaddq_f32(vaddq_f32(
+            vmulq_n_f32(c[0], p[0]),
+            vmulq_n_f32(c[1], p[1])),
+            vmulq_n_f32(c[2], p[2])),
+            c[3]);
+        o = vdivq_f32(o, vdupq_laneq_f32(o, 3));
+        Float* const d = skinnedPositions[i].data();
+        vst1_f32(d, vget_low_f32(o));
+        vst1q_lane_f32(d + 2, o, 2);
+
+        if(normals) {
+            const Float* const n = normalsIn[i].data();
+            const float32x4_t on = vaddq_f32(vaddq_f32(
+                vmulq_n_f32(c[0], n[0]),
+                vmulq_n_f32(c[1], n[1])),
+                vmulq_n_f32(c[2], n[2]));
+            Float* const dn = skinnedNormals[i].data();
+            vst1_f32(dn, vget_low_f32(on));
+            vst1q_lane_f32(dn + 2, on, 2);
+        }
+        #else
+        const Matrix4 skinMatrix =
+            w[0]*jointMatrices[id[0]] +
+            w[1]*jointMatrices[id[1]] +
+            w[2]*jointMatrices[id[2]] +
+            w[3]*jointMatrices[id[3]];
+        skinnedPositions[i] = skinMatrix.transformPoint(positions[i]);
+        if(normals)
+            skinnedNormals[i] = skinMatrix.rotationScaling()*normalsIn[i];
+        #endif
+    }
+}
+
+template<bool normals> void skinIntoImplementation(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normalsIn, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals, const UnsignedInt threadCount) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != jointIds.size(); ++i) {
+        const Vector4ui& id = jointIds[i];
+        for(std::size_t j = 0; j != 4; ++j)
+            CORRADE_ASSERT(id[j] < jointMatrices.size(),
+                "MeshTools::skinInto(): joint ID" << id[j] << "at vertex" << i << "out of range for" << jointMatrices.size() << "joints", );
+    }
+    #endif
+
+    const std::size_t vertexCount = positions.size();
+    const UnsignedInt count = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), vertexCount);
+    Magnum::Implementation::runOnThreads(count, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(vertexCount, count, thread);
+        skinRange<normals>(jointMatrices, jointIds, weights, positions, normalsIn, skinnedPositions, skinnedNormals, range.first, range.second);
+    });
+}
+
+}
+
+void skinInto(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && weights.size() == positions.size() && skinnedPositions.size() == positions.size(),
+        "MeshTools::skinInto(): expected joint ID, weight and output views to have" << positions.size() << "items but got" << jointIds.size() << Debug::nospace << "," << weights.size() << "and" << skinnedPositions.size(), );
+    skinIntoImplementation<false>(jointMatrices, jointIds, weights, positions, nullptr, skinnedPositions, nullptr, threadCount);
+}
+
+void skinInto(const Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(jointIds.size() == positions.size() && weights.size() == positions.size() && skinnedPositions.size() == positions.size(),
+        "MeshTools::skinInto(): expected joint ID, weight and output views to have" << positions.size() << "items but got" << jointIds.size() << Debug::nospace << "," << weights.size() << "and" << skinnedPositions.size(), );
+    CORRADE_ASSERT(normals.size() == positions.size() && skinnedNormals.size() == positions.size(),
+        "MeshTools::skinInto(): expected normal and skinned normal views to have" << positions.size() << "items but got" << normals.size() << "and" << skinnedNormals.size(), );
+    skinIntoImplementation<true>(jointMatrices, jointIds, weights, positions, normals, skinnedPositions, skinnedNormals, threadCount);
+}
+
+}}
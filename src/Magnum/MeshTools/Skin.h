@@ -0,0 +1,105 @@
+#ifndef Magnum_MeshTools_Skin_h
+#define Magnum_MeshTools_Skin_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::MeshTools::skinInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Skin positions on the CPU
+@param[in] jointMatrices    Joint matrix palette
+@param[in] jointIds         Per-vertex IDs of four joints affecting the
+    vertex
+@param[in] weights          Per-vertex weights of the four joints
+@param[in] positions        Vertex positions
+@param[out] skinnedPositions Where to put the skinned positions
+@param[in] threadCount      Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+A CPU counterpart to skinning in @ref Shaders::Flat and @ref Shaders::Phong,
+useful for example for offline baking of posed collision meshes. Follows the
+same data conventions --- @p jointMatrices is a palette such as produced by
+@ref SceneGraph::Object::jointMatricesInto(), and @p jointIds and @p weights
+are the same four-component per-vertex data as supplied to the
+@ref Shaders::Generic::JointIds and @ref Shaders::Generic::Weights
+attributes, with weights of unused joints set to zero. Each output position
+is calculated as @f[
+    \boldsymbol{p}' = \left(\sum_{i = 0}^3 w_i \boldsymbol{M}_{j_i}\right) \begin{pmatrix} \boldsymbol{p} \ 1 \end{pmatrix}
+@f]
+
+followed by a division by the resulting @f$ w @f$ component, same as
+@ref Matrix4::transformPoint(). Expects that @p jointIds, @p weights and
+@p skinnedPositions have the same size as @p positions and that all joint IDs
+are less than size of @p jointMatrices. The @p skinnedPositions view can be
+the same as @p positions for in-place skinning.
+
+On x86 and ARM64 the matrix blending and transformation is done using SIMD
+instructions, with the additions performed in the same order as in the
+scalar code, so the output is the same on all platforms. The vertices are
+split into @p threadCount contiguous ranges, each processed on a separate
+thread. Meant for large meshes --- if there's less than about a thousand
+vertices per thread, fewer threads are used. On
+@ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without pthreads support
+everything is done on the calling thread. Doesn't allocate apart from the
+thread handles.
+@see @ref morphInto()
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInto(Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, UnsignedInt threadCount = 1);
+
+/**
+@brief Skin positions and normals on the CPU
+@param[in] jointMatrices    Joint matrix palette
+@param[in] jointIds         Per-vertex IDs of four joints affecting the
+    vertex
+@param[in] weights          Per-vertex weights of the four joints
+@param[in] positions        Vertex positions
+@param[in] normals          Vertex normals
+@param[out] skinnedPositions Where to put the skinned positions
+@param[out] skinnedNormals  Where to put the skinned normals
+@param[in] threadCount      Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Like @ref skinInto(Containers::ArrayView<const Matrix4>, const Containers::StridedArrayView1D<const Vector4ui>&, const Containers::StridedArrayView1D<const Vector4>&, const Containers::StridedArrayView1D<const Vector3>&, const Containers::StridedArrayView1D<Vector3>&, UnsignedInt),
+but additionally transforms @p normals with the upper left 3x3 part of the
+blended matrix. Same as in the shaders, that's correct only for joints
+without non-uniform scaling, and the normals are not renormalized. Expects
+that @p normals and @p skinnedNormals have the same size as @p positions as
+well.
+*/
+MAGNUM_MESHTOOLS_EXPORT void skinInto(Containers::ArrayView<const Matrix4> jointMatrices, const Containers::StridedArrayView1D<const Vector4ui>& jointIds, const Containers::StridedArrayView1D<const Vector4>& weights, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView1D<const Vector3>& normals, const Containers::StridedArrayView1D<Vector3>& skinnedPositions, const Containers::StridedArrayView1D<Vector3>& skinnedNormals, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -0,0 +1,334 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SpatialSort.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/Reference.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+Debug& operator<<(Debug& debug, const SpatialCurve value) {
+    debug << "MeshTools::SpatialCurve" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case SpatialCurve::value: return debug << "::" #value;
+        _c(Morton)
+        _c(Hilbert)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+namespace {
+
+/* Bits per axis, giving a 30-bit key */
+constexpr UnsignedInt KeyBits = 10;
+
+/* Spreads the lower 10 bits so there are two zero bits between each */
+UnsignedInt spreadBits(UnsignedInt a) {
+    a &= 0x000003ff;
+    a = (a | (a << 16)) & 0x030000ff;
+    a = (a | (a << 8)) & 0x0300f00f;
+    a = (a | (a << 4)) & 0x030c30c3;
+    a = (a | (a << 2)) & 0x09249249;
+    return a;
+}
+
+UnsignedInt mortonKey(const Vector3ui& a) {
+    return spreadBits(a.x()) | (spreadBits(a.y()) << 1) | (spreadBits(a.z()) << 2);
+}
+
+/* John Skilling --- Programming the Hilbert curve, AIP Conference
+   Proceedings 707, 2004. Converts the coordinates to a transposed Hilbert
+   index, interleaving them then gives the key. */
+UnsignedInt hilbertKey(const Vector3ui& a) {
+    UnsignedInt x[3]{a.x(), a.y(), a.z()};
+
+    /* Inverse undo */
+    for(UnsignedInt q = 1 << (KeyBits - 1); q > 1; q >>= 1) {
+        const UnsignedInt p = q - 1;
+        for(std::size_t i = 0; i != 3; ++i) {
+            if(x[i] & q) x[0] ^= p;
+            else {
+                const UnsignedInt t = (x[0] ^ x[i]) & p;
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    /* Gray encode */
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    UnsignedInt t = 0;
+    for(UnsignedInt q = 1 << (KeyBits - 1); q > 1; q >>= 1)
+        if(x[2] & q) t ^= q - 1;
+    for(UnsignedInt& i: x) i ^= t;
+
+    /* The first coordinate has the most significant bit of each triplet */
+    return (spreadBits(x[0]) << 2) | (spreadBits(x[1]) << 1) | spreadBits(x[2]);
+}
+
+}
+
+void spatialSortOrderInto(const Containers::StridedArrayView1D<const Vector3>& points, const Containers::StridedArrayView1D<UnsignedInt>& order, const SpatialCurve curve, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(order.size() == points.size(),
+        "MeshTools::spatialSortOrderInto(): expected output array size" << points.size() << "but got" << order.size(), );
+
+    const std::size_t size = points.size();
+    if(!size) return;
+
+    const UnsignedInt usedThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), size);
+
+    /* Quantize into a cube enclosing the bounding box so the proportions are
+       kept. If all points are the same, they all get a zero key. */
+    const std::pair<Vector3, Vector3> minmax = Math::minmax(points);
+    const Float extent = (minmax.second - minmax.first).max();
+    const Float scale = extent > 0.0f ? Float((1 << KeyBits) - 1)/extent : 0.0f;
+
+    /* Calculate the keys, interleaved with the original indices so the sort
+       has everything next to each other */
+    Containers::Array<Vector2ui> items{Containers::NoInit, size};
+    Containers::Array<Vector2ui> scratch{Containers::NoInit, size};
+    Magnum::Implementation::runOnThreads(usedThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size, usedThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            const Vector3ui quantized{Math::clamp((points[i] - minmax.first)*scale + Vector3{0.5f}, Vector3{0.0f}, Vector3{Float((1 << KeyBits) - 1)})};
+            items[i] = {curve == SpatialCurve::Morton ?
+                mortonKey(quantized) : hilbertKey(quantized), UnsignedInt(i)};
+        }
+    });
+
+    /* LSD radix sort with 8-bit digits. Each thread counts digits in its
+       range, from these the output offset of every digit in every thread is
+       calculated, keeping the thread ranges in order so the sort is stable,
+       and then each thread scatters its range. Passes where all keys have the
+       same digit are skipped. */
+    Containers::Array<std::size_t> offsets{Containers::NoInit, 256*std::size_t(usedThreadCount)};
+    for(UnsignedInt shift = 0; shift < 3*KeyBits; shift += 8) {
+        Magnum::Implementation::runOnThreads(usedThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size, usedThreadCount, thread);
+            const Containers::ArrayView<std::size_t> counts = offsets.slice(256*thread, 256*(thread + 1));
+            for(std::size_t& count: counts) count = 0;
+            for(std::size_t i = range.first; i != range.second; ++i)
+                ++counts[(items[i].x() >> shift) & 0xff];
+        });
+
+        /* Prefix sum ordered by digit first and thread second */
+        std::size_t offset = 0;
+        bool skip = false;
+        for(std::size_t digit = 0; digit != 256; ++digit) {
+            std::size_t digitCount = 0;
+            for(UnsignedInt thread = 0; thread != usedThreadCount; ++thread) {
+                std::size_t& count = offsets[256*thread + digit];
+                const std::size_t current = count;
+                count = offset;
+                offset += current;
+                digitCount += current;
+            }
+            if(digitCount == size) skip = true;
+        }
+        if(skip) continue;
+
+        Magnum::Implementation::runOnThreads(usedThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size, usedThreadCount, thread);
+            const Containers::ArrayView<std::size_t> threadOffsets = offsets.slice(256*thread, 256*(thread + 1));
+            for(std::size_t i = range.first; i != range.second; ++i)
+                scratch[threadOffsets[(items[i].x() >> shift) & 0xff]++] = items[i];
+        });
+
+        std::swap(items, scratch);
+    }
+
+    for(std::size_t i = 0; i != size; ++i)
+        order[i] = items[i].y();
+}
+
+namespace {
+
+template<class T> void spatialSortVerticesInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    const std::size_t vertexCount = data.size()[0];
+    CORRADE_ASSERT(positions.size() == vertexCount,
+        "MeshTools::spatialSortVerticesInPlace(): expected" << vertexCount << "positions but got" << positions.size(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::spatialSortVerticesInPlace(): index" << index << "out of bounds for" << vertexCount << "elements", );
+    #endif
+
+    Containers::Array<UnsignedInt> order{Containers::NoInit, vertexCount};
+    spatialSortOrderInto(positions, Containers::stridedArrayView(order), curve, threadCount);
+
+    /* Reorder the data through a temporary copy */
+    Containers::Array<char> reordered{Containers::NoInit, vertexCount*data.size()[1]};
+    const Containers::StridedArrayView2D<char> reorderedView{reordered, {vertexCount, data.size()[1]}};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        Utility::copy(data[order[i]], reorderedView[i]);
+    Utility::copy(reorderedView, data);
+
+    /* Remap the indices, reusing the order array for the inverse mapping
+       isn't possible in-place so allocate a new one */
+    if(indices.empty()) return;
+    Containers::Array<UnsignedInt> remapping{Containers::NoInit, vertexCount};
+    for(std::size_t i = 0; i != vertexCount; ++i)
+        remapping[order[i]] = i;
+    for(T& index: indices)
+        index = remapping[index];
+}
+
+template<class T> void spatialSortTrianglesInPlaceImplementation(const Containers::StridedArrayView1D<T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const SpatialCurve curve, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::spatialSortTrianglesInPlace(): index count not divisible by 3, got" << indices.size(), );
+
+    const std::size_t triangleCount = indices.size()/3;
+    Containers::Array<Vector3> centroids{Containers::NoInit, triangleCount};
+    for(std::size_t i = 0; i != triangleCount; ++i) {
+        Vector3 centroid;
+        for(std::size_t j = 0; j != 3; ++j) {
+            const T index = indices[i*3 + j];
+            CORRADE_ASSERT(index < positions.size(),
+                "MeshTools::spatialSortTrianglesInPlace(): index" << index << "out of bounds for" << positions.size() << "elements", );
+            centroid += positions[index];
+        }
+        centroids[i] = centroid/3.0f;
+    }
+
+    Containers::Array<UnsignedInt> order{Containers::NoInit, triangleCount};
+    spatialSortOrderInto(Containers::stridedArrayView(centroids), Containers::stridedArrayView(order), curve, threadCount);
+
+    /* Reorder the triangles through a temporary copy */
+    Containers::Array<T> reordered{Containers::NoInit, indices.size()};
+    for(std::size_t i = 0; i != triangleCount; ++i)
+        for(std::size_t j = 0; j != 3; ++j)
+            reordered[i*3 + j] = indices[order[i]*3 + j];
+    Utility::copy(Containers::stridedArrayView(reordered), indices);
+}
+
+}
+
+void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortVerticesInPlaceImplementation(indices, positions, data, curve, threadCount);
+}
+
+void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortVerticesInPlaceImplementation(indices, positions, data, curve, threadCount);
+}
+
+void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortVerticesInPlaceImplementation(indices, positions, data, curve, threadCount);
+}
+
+void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortVerticesInPlaceImplementation(Containers::StridedArrayView1D<UnsignedInt>{}, positions, data, curve, threadCount);
+}
+
+void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortTrianglesInPlaceImplementation(indices, positions, curve, threadCount);
+}
+
+void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortTrianglesInPlaceImplementation(indices, positions, curve, threadCount);
+}
+
+void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const SpatialCurve curve, const UnsignedInt threadCount) {
+    spatialSortTrianglesInPlaceImplementation(indices, positions, curve, threadCount);
+}
+
+Trade::MeshData spatialSortVertices(const Trade::MeshData& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    return spatialSortVertices(reference(data), curve, threadCount);
+}
+
+Trade::MeshData spatialSortVertices(Trade::MeshData&& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(data.isIndexed() || data.primitive() == MeshPrimitive::Points,
+        "MeshTools::spatialSortVertices(): expected an indexed mesh or a MeshPrimitive::Points but got a non-indexed" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::spatialSortVertices(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Points, 0}));
+
+    /* Turn the passed data into an interleaved owned mutable instance we can
+       operate on. There's a chance the original data are already like this,
+       in which case this will be just a passthrough. */
+    Trade::MeshData out = owned(interleave(std::move(data)));
+    const Containers::Array<Vector3> positions = out.positions3DAsArray();
+    const Containers::StridedArrayView2D<char> vertexData = interleavedMutableData(out);
+    if(!out.isIndexed())
+        spatialSortVerticesInPlace(Containers::stridedArrayView(positions), vertexData, curve, threadCount);
+    else if(out.indexType() == MeshIndexType::UnsignedInt)
+        spatialSortVerticesInPlace(out.mutableIndices<UnsignedInt>(), Containers::stridedArrayView(positions), vertexData, curve, threadCount);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        spatialSortVerticesInPlace(out.mutableIndices<UnsignedShort>(), Containers::stridedArrayView(positions), vertexData, curve, threadCount);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        spatialSortVerticesInPlace(out.mutableIndices<UnsignedByte>(), Containers::stridedArrayView(positions), vertexData, curve, threadCount);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return out;
+}
+
+Trade::MeshData spatialSortTriangles(const Trade::MeshData& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    return spatialSortTriangles(reference(data), curve, threadCount);
+}
+
+Trade::MeshData spatialSortTriangles(Trade::MeshData&& data, const SpatialCurve curve, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(data.isIndexed(),
+        "MeshTools::spatialSortTriangles(): mesh data not indexed",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::spatialSortTriangles(): expected a MeshPrimitive::Triangles mesh but got" << data.primitive(),
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+    CORRADE_ASSERT(data.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::spatialSortTriangles(): the mesh has no positions",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    /* Make the data owned so we can modify the indices. If they are already,
+       this is just a passthrough. */
+    Trade::MeshData out = owned(std::move(data));
+    const Containers::Array<Vector3> positions = out.positions3DAsArray();
+    if(out.indexType() == MeshIndexType::UnsignedInt)
+        spatialSortTrianglesInPlace(out.mutableIndices<UnsignedInt>(), Containers::stridedArrayView(positions), curve, threadCount);
+    else if(out.indexType() == MeshIndexType::UnsignedShort)
+        spatialSortTrianglesInPlace(out.mutableIndices<UnsignedShort>(), Containers::stridedArrayView(positions), curve, threadCount);
+    else if(out.indexType() == MeshIndexType::UnsignedByte)
+        spatialSortTrianglesInPlace(out.mutableIndices<UnsignedByte>(), Containers::stridedArrayView(positions), curve, threadCount);
+    else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+
+    return out;
+}
+
+}}
@@ -0,0 +1,226 @@
+#ifndef Magnum_MeshTools_SpatialSort_h
+#define Magnum_MeshTools_SpatialSort_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::MeshTools::SpatialCurve, function @ref Magnum::MeshTools::spatialSortOrderInto(), @ref Magnum::MeshTools::spatialSortVerticesInPlace(), @ref Magnum::MeshTools::spatialSortTrianglesInPlace(), @ref Magnum::MeshTools::spatialSortVertices(), @ref Magnum::MeshTools::spatialSortTriangles()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Space-filling curve for spatial sorting
+@m_since_latest
+
+@see @ref spatialSortOrderInto(), @ref spatialSortVerticesInPlace(),
+    @ref spatialSortTrianglesInPlace()
+*/
+enum class SpatialCurve: UnsignedByte {
+    /**
+     * Morton curve, also known as Z-order. The key is just an interleaving
+     * of the coordinate bits, which makes it very cheap to calculate, but
+     * the curve makes long jumps between octants.
+     */
+    Morton,
+
+    /**
+     * Hilbert curve. Consecutive cells are always adjacent, which results
+     * in better locality than @ref SpatialCurve::Morton at a slightly higher
+     * cost of key calculation.
+     */
+    Hilbert
+};
+
+/**
+@debugoperatorenum{SpatialCurve}
+@m_since_latest
+*/
+MAGNUM_MESHTOOLS_EXPORT Debug& operator<<(Debug& debug, SpatialCurve value);
+
+/**
+@brief Calculate an order of points along a space-filling curve
+@param[in]  points      Points to sort
+@param[out] order       Where to put the order
+@param[in]  curve       Space-filling curve to use
+@param[in]  threadCount Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+The points are quantized to 10 bits per axis inside a cube enclosing their
+bounding box, a 30-bit key along @p curve is calculated for each and the keys
+are sorted with a stable LSD radix sort. Item @cpp i @ce of @p order is then
+the index of the point that comes @cpp i @ce-th along the curve, points with
+equal keys keep their original relative order. The output is the same
+independently of @p threadCount. With more than one thread, the key
+calculation and each radix sort pass is split into contiguous ranges
+processed in parallel; if there's less than about a thousand points per
+thread, fewer threads are used. On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten"
+builds without pthreads support everything is done on the calling thread.
+
+Expects that @p order has the same size as @p points.
+*/
+MAGNUM_MESHTOOLS_EXPORT void spatialSortOrderInto(const Containers::StridedArrayView1D<const Vector3>& points, const Containers::StridedArrayView1D<UnsignedInt>& order, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder vertices along a space-filling curve in-place
+@param[in,out] indices  Index array to remap
+@param[in] positions    Vertex positions
+@param[in,out] data     Vertex data to reorder
+@param[in] curve        Space-filling curve to use
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Reorders items of @p data in the order given by @ref spatialSortOrderInto()
+for @p positions and remaps @p indices accordingly, so vertices that are close
+in space are close in memory as well. The @p positions view can point to
+@p data, the order is calculated before the data are modified. Works for any
+primitive type. Expects that @p positions has the same size as the first
+dimension of @p data and that all indices are less than it.
+
+Unlike @ref optimizeVertexFetchInPlace(), which orders the vertices by first
+use in the index buffer, the order depends only on the vertex positions. It's
+thus useful for point clouds and meshes that come in an arbitrary order,
+either on its own or before @ref spatialSortTrianglesInPlace().
+@see @ref spatialSortVertices()
+*/
+MAGNUM_MESHTOOLS_EXPORT void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder non-indexed vertices along a space-filling curve in-place
+@m_since_latest
+
+Same as above, but without an index buffer. Meant for
+@ref MeshPrimitive::Points meshes, for other primitives reordering the
+vertices would break the primitives apart.
+*/
+MAGNUM_MESHTOOLS_EXPORT void spatialSortVerticesInPlace(const Containers::StridedArrayView1D<const Vector3>& positions, const Containers::StridedArrayView2D<char>& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder triangles along a space-filling curve in-place
+@param[in,out] indices  Index array to operate on
+@param[in] positions    Vertex positions
+@param[in] curve        Space-filling curve to use
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Reorders the triangles in the order given by @ref spatialSortOrderInto() for
+their centroids. Triangle winding is preserved. The result has good locality
+for rasterization and is a good starting point for building bounding volume
+hierarchies such as @ref TriangleBvh, however it doesn't model vertex reuse
+like @ref optimizeVertexCacheInPlace() does. Expects that the index count is
+divisible by 3 and all indices are less than size of @p positions.
+@see @ref spatialSortTriangles()
+*/
+MAGNUM_MESHTOOLS_EXPORT void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT void spatialSortTrianglesInPlace(const Containers::StridedArrayView1D<UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder mesh vertices along a space-filling curve
+@m_since_latest
+
+Expects that the mesh has a @ref Trade::MeshAttribute::Position and is either
+indexed or a @ref MeshPrimitive::Points. The vertex data are interleaved
+using @ref interleave() and then @ref spatialSortVerticesInPlace() is called
+on them with positions converted using
+@ref Trade::MeshData::positions3DAsArray(), the index type is preserved. This
+function unconditionally copies the data, if the data are interleaved and
+owned by the instance and you don't need the original after the process,
+call @ref spatialSortVertices(Trade::MeshData&&, SpatialCurve, UnsignedInt)
+instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData spatialSortVertices(const Trade::MeshData& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder mesh vertices along a space-filling curve
+@m_since_latest
+
+Compared to @ref spatialSortVertices(const Trade::MeshData&, SpatialCurve, UnsignedInt),
+index and vertex data that are owned by the instance and already interleaved
+are operated on in-place, without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData spatialSortVertices(Trade::MeshData&& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder mesh triangles along a space-filling curve
+@m_since_latest
+
+Expects that the mesh is indexed, is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position. Calls @ref spatialSortTrianglesInPlace()
+on a copy of the index data with positions converted using
+@ref Trade::MeshData::positions3DAsArray(), the index type is preserved.
+Vertex data are passed through unchanged. This function unconditionally
+copies the data, if the data are owned by the instance and you don't need the
+original after the process, call
+@ref spatialSortTriangles(Trade::MeshData&&, SpatialCurve, UnsignedInt)
+instead.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData spatialSortTriangles(const Trade::MeshData& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+/**
+@brief Reorder mesh triangles along a space-filling curve
+@m_since_latest
+
+Compared to @ref spatialSortTriangles(const Trade::MeshData&, SpatialCurve, UnsignedInt),
+index and vertex data that are owned by the instance are transferred to the
+output without a copy.
+*/
+MAGNUM_MESHTOOLS_EXPORT Trade::MeshData spatialSortTriangles(Trade::MeshData&& data, SpatialCurve curve = SpatialCurve::Hilbert, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
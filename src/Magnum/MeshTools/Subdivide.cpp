@@ -0,0 +1,177 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Subdivide.h"
+
+#include <algorithm>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Functions.h"
+
+namespace Magnum { namespace MeshTools { namespace Implementation {
+
+void subdivideSharedEdges(Containers::Array<UnsignedInt>& indices, const std::size_t vertexCount, const UnsignedInt levels, const UnsignedInt threadCount, void(*const resize)(void*, std::size_t), void(*const interpolate)(void*, const Vector2ui*, std::size_t, std::size_t), void* const state) {
+    CORRADE_ASSERT(!(indices.size()%3),
+        "MeshTools::subdivideSharedEdges(): index count is not divisible by 3", );
+    #ifndef CORRADE_NO_ASSERT
+    for(const UnsignedInt index: indices)
+        CORRADE_ASSERT(index < vertexCount,
+            "MeshTools::subdivideSharedEdges(): index" << index << "out of bounds for" << vertexCount << "elements", );
+    #endif
+
+    if(!levels || indices.isEmpty()) return;
+
+    /* Two index buffers to ping-pong between, the last level writes to the
+       first one, the one before to the second and so on. Scratch memory is
+       sized for the last level as well, earlier levels use a prefix. */
+    const std::size_t finalIndexCount = indices.size() << 2*levels;
+    const std::size_t maxSlotCount = finalIndexCount/4;
+    Containers::Array<UnsignedInt> outputs[]{
+        Containers::Array<UnsignedInt>{Containers::NoInit, finalIndexCount},
+        Containers::Array<UnsignedInt>{Containers::NoInit, levels > 1 ? maxSlotCount : 0}
+    };
+    /* Slots, i.e. index positions, bucketed by the lower vertex of the edge
+       starting at them */
+    Containers::Array<UnsignedInt> buckets{Containers::NoInit, maxSlotCount};
+    /* First slot at which the same edge occurs */
+    Containers::Array<UnsignedInt> firstSlots{Containers::NoInit, maxSlotCount};
+    Containers::Array<UnsignedInt> edgeIds{Containers::NoInit, maxSlotCount};
+    /* Unique edge count is at most the slot count */
+    Containers::Array<Vector2ui> edges{Containers::NoInit, maxSlotCount};
+
+    Containers::ArrayView<const UnsignedInt> input = indices;
+    std::size_t currentVertexCount = vertexCount;
+    for(UnsignedInt level = 0; level != levels; ++level) {
+        const std::size_t slotCount = input.size();
+        const std::size_t triangleCount = slotCount/3;
+        const Containers::ArrayView<UnsignedInt> output = outputs[(levels - level - 1)%2].prefix(slotCount*4);
+        const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), slotCount);
+
+        const auto edgeStart = [&](const std::size_t slot) {
+            return input[slot];
+        };
+        const auto edgeEnd = [&](const std::size_t slot) {
+            return input[slot - slot%3 + (slot + 1)%3];
+        };
+
+        /* Bucket the slots by the lower edge vertex with a counting sort. As
+           the slots are processed in order, each bucket is sorted. */
+        Containers::Array<UnsignedInt> bucketOffsets{Containers::ValueInit, currentVertexCount + 2};
+        for(std::size_t slot = 0; slot != slotCount; ++slot)
+            ++bucketOffsets[Math::min(edgeStart(slot), edgeEnd(slot)) + 2];
+        for(std::size_t i = 2; i != bucketOffsets.size(); ++i)
+            bucketOffsets[i] += bucketOffsets[i - 1];
+        for(std::size_t slot = 0; slot != slotCount; ++slot)
+            buckets[bucketOffsets[Math::min(edgeStart(slot), edgeEnd(slot)) + 1]++] = slot;
+
+        /* In each bucket, group slots by the upper edge vertex. The stable
+           sort keeps the lowest slot first in each group. */
+        Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(currentVertexCount, actualThreadCount, thread);
+            for(std::size_t vertex = range.first; vertex != range.second; ++vertex) {
+                UnsignedInt* const begin = buckets + bucketOffsets[vertex];
+                UnsignedInt* const end = buckets + bucketOffsets[vertex + 1];
+                if(begin == end) continue;
+
+                std::stable_sort(begin, end, [&](UnsignedInt a, UnsignedInt b) {
+                    return Math::max(edgeStart(a), edgeEnd(a)) < Math::max(edgeStart(b), edgeEnd(b));
+                });
+                UnsignedInt first = *begin;
+                for(UnsignedInt* slot = begin; slot != end; ++slot) {
+                    if(Math::max(edgeStart(*slot), edgeEnd(*slot)) != Math::max(edgeStart(first), edgeEnd(first)))
+                        first = *slot;
+                    firstSlots[*slot] = first;
+                }
+            }
+        });
+
+        /* Number the unique edges in the order they first occur. Each thread
+           counts first occurrences in its range of triangles, then numbers
+           them starting at the sum of counts of the preceding ranges. */
+        Containers::Array<std::size_t> threadEdgeOffsets{Containers::ValueInit, actualThreadCount + 1};
+        Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, actualThreadCount, thread);
+            std::size_t count = 0;
+            for(std::size_t slot = range.first*3; slot != range.second*3; ++slot)
+                if(firstSlots[slot] == slot) ++count;
+            threadEdgeOffsets[thread + 1] = count;
+        });
+        for(UnsignedInt i = 0; i != actualThreadCount; ++i)
+            threadEdgeOffsets[i + 1] += threadEdgeOffsets[i];
+        const std::size_t edgeCount = threadEdgeOffsets[actualThreadCount];
+
+        Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, actualThreadCount, thread);
+            std::size_t edgeId = threadEdgeOffsets[thread];
+            for(std::size_t slot = range.first*3; slot != range.second*3; ++slot) {
+                if(firstSlots[slot] != slot) continue;
+                edgeIds[slot] = edgeId;
+                edges[edgeId] = {edgeStart(slot), edgeEnd(slot)};
+                ++edgeId;
+            }
+        });
+
+        /* Interpolate the new vertices */
+        resize(state, currentVertexCount + edgeCount);
+        const UnsignedInt interpolateThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), edgeCount);
+        Magnum::Implementation::runOnThreads(interpolateThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(edgeCount, interpolateThreadCount, thread);
+            interpolate(state, edges + range.first, range.second - range.first, currentVertexCount + range.first);
+        });
+
+        /* Create the new faces, in the same layout as subdivideInPlace() */
+        Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, actualThreadCount, thread);
+            for(std::size_t triangle = range.first; triangle != range.second; ++triangle) {
+                const std::size_t i = triangle*3;
+                UnsignedInt newVertices[3];
+                for(std::size_t j = 0; j != 3; ++j)
+                    newVertices[j] = currentVertexCount + edgeIds[firstSlots[i + j]];
+
+                UnsignedInt* const out = output + slotCount + triangle*9;
+                out[0] = input[i];
+                out[1] = newVertices[0];
+                out[2] = newVertices[2];
+
+                out[3] = newVertices[0];
+                out[4] = input[i + 1];
+                out[5] = newVertices[1];
+
+                out[6] = newVertices[2];
+                out[7] = newVertices[1];
+                out[8] = input[i + 2];
+                for(std::size_t j = 0; j != 3; ++j)
+                    output[i + j] = newVertices[j];
+            }
+        });
+
+        input = output;
+        currentVertexCount += edgeCount;
+    }
+
+    indices = std::move(outputs[0]);
+}
+
+}}}
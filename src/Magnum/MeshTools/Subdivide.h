@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace()
+ * @brief Function @ref Magnum::MeshTools::subdivide(), @ref Magnum::MeshTools::subdivideInPlace(), @ref Magnum::MeshTools::subdivideSharedEdges()
  */
 
 #include <Corrade/Containers/GrowableArray.h>
@@ -35,6 +35,8 @@
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/MeshTools/visibility.h"
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 #include <vector>
@@ -59,7 +61,8 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
 Goes through all triangle faces and subdivides them into four new, enlarging
 the @p indices and @p vertices arrays as appropriate. Removing duplicate
 vertices in the mesh is up to the user.
-@see @ref subdivideInPlace(), @ref removeDuplicatesInPlace()
+@see @ref subdivideInPlace(), @ref subdivideSharedEdges(),
+    @ref removeDuplicatesInPlace()
 */
 template<class IndexType, class Vertex, class Interpolator> void subdivide(Containers::Array<IndexType>& indices, Containers::Array<Vertex>& vertices, Interpolator interpolator) {
     CORRADE_ASSERT(!(indices.size()%3), "MeshTools::subdivide(): index count is not divisible by 3", );
@@ -111,7 +114,7 @@ each step. @f[
     \end{array}
 @f]
 
-@see @ref subdivide(), @ref removeDuplicatesInPlace()
+@see @ref subdivideSharedEdges(), @ref removeDuplicatesInPlace()
 */
 template<class IndexType, class Vertex, class Interpolator> void subdivideInPlace(const Containers::StridedArrayView1D<IndexType>& indices, const Containers::StridedArrayView1D<Vertex>& vertices, Interpolator interpolator) {
     CORRADE_ASSERT(!(indices.size()%12), "MeshTools::subdivideInPlace(): can't divide" << indices.size() << "indices to four parts with each having triangle faces", );
@@ -168,6 +171,61 @@ template<class IndexType, class Vertex, class Interpolator> void subdivideInPlac
     subdivideInPlace(Containers::stridedArrayView(indices), vertices, interpolator);
 }
 
+namespace Implementation {
+    MAGNUM_MESHTOOLS_EXPORT void subdivideSharedEdges(Containers::Array<UnsignedInt>& indices, std::size_t vertexCount, UnsignedInt levels, UnsignedInt threadCount, void(*resize)(void*, std::size_t), void(*interpolate)(void*, const Vector2ui*, std::size_t, std::size_t), void* state);
+}
+
+/**
+@brief Subdivide a mesh with shared edge midpoints
+@tparam Vertex          Vertex data type
+@tparam Interpolator    See the @p interpolator function parameter
+@param[in,out] indices  Index array to operate on
+@param[in,out] vertices Vertex array to operate on
+@param levels           Count of subdivision levels
+@param interpolator     Functor or function pointer which interpolates
+    two adjacent vertices: @cpp Vertex interpolator(Vertex a, Vertex b) @ce
+@param threadCount      Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Like @ref subdivide(), subdivides each triangle face into four new, but
+creates just one new vertex for each unique edge instead of one for every
+edge of every face, so there's no need to call @ref removeDuplicatesInPlace()
+afterwards. Unique edges are found with a map bucketed by the lower vertex
+index, the edges, new vertices and new faces are then processed in parallel.
+All @p levels are done in a single call, reusing two index buffers sized for
+the final mesh.
+
+The output is equivalent to calling @ref subdivide() @p levels times followed
+by @ref removeDuplicatesIndexedInPlace(), assuming the interpolator produces
+unique values for different edges --- the new vertices are numbered in the
+order their edges first occur in @p indices and the @p interpolator is called
+with edge endpoints in the order they occur in that face. As each new vertex
+depends only on its edge endpoints, the @p interpolator has to be safe to call
+from multiple threads at once if @p threadCount is not @cpp 1 @ce.
+
+Expects that the index count is divisible by 3 and all indices are less than
+size of @p vertices. The @p indices array is replaced with a new one with a
+default deleter, the @p vertices array is grown using
+@ref Corrade::Containers::arrayResize().
+*/
+template<class Vertex, class Interpolator> void subdivideSharedEdges(Containers::Array<UnsignedInt>& indices, Containers::Array<Vertex>& vertices, UnsignedInt levels, Interpolator interpolator, UnsignedInt threadCount = 1) {
+    struct State {
+        Containers::Array<Vertex>& vertices;
+        Interpolator& interpolator;
+    } state{vertices, interpolator};
+
+    Implementation::subdivideSharedEdges(indices, vertices.size(), levels, threadCount,
+        [](void* state, std::size_t size) {
+            arrayResize(static_cast<State*>(state)->vertices, Containers::NoInit, size);
+        },
+        [](void* state, const Vector2ui* edges, std::size_t count, std::size_t offset) {
+            State& s = *static_cast<State*>(state);
+            for(std::size_t i = 0; i != count; ++i)
+                s.vertices[offset + i] = s.interpolator(s.vertices[edges[i].x()], s.vertices[edges[i].y()]);
+        }, &state);
+}
+
 }}
 
 #endif
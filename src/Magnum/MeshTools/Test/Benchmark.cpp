@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Arguments.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CompressIndices.h"
+#include "Magnum/MeshTools/Concatenate.h"
+#include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/GenerateNormals.h"
+#include "Magnum/MeshTools/Interleave.h"
+#include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Tipsify.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void interleave();
+    void compressIndices();
+    void removeDuplicates();
+    void generateSmoothNormals();
+    void tipsifyInPlace();
+    void concatenate();
+    void duplicate();
+
+    private:
+        const Trade::MeshData& mesh();
+
+        bool _huge;
+        Containers::Optional<Trade::MeshData> _meshes[3];
+};
+
+/* The 20M case needs several gigabytes of memory for the duplicated and
+   concatenated variants, so it's run only when explicitly requested with
+   --meshtools-huge */
+const struct {
+    const char* name;
+    UnsignedInt vertexCount;
+    bool huge;
+} SizeData[]{
+    {"10k vertices, icosphere", 10242, false},
+    {"1M vertices, grid", 1000*1000, false},
+    {"20M vertices, grid", 4472*4472, true}
+};
+
+Benchmark::Benchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"meshtools"})} {
+    addInstancedBenchmarks({&Benchmark::interleave,
+                            &Benchmark::compressIndices,
+                            &Benchmark::removeDuplicates,
+                            &Benchmark::generateSmoothNormals,
+                            &Benchmark::tipsifyInPlace,
+                            &Benchmark::concatenate,
+                            &Benchmark::duplicate}, 5,
+        Containers::arraySize(SizeData));
+
+    Utility::Arguments args{"meshtools"};
+    args.addBooleanOption("huge").setHelp("huge", "run also the 20M vertex cases")
+        .parse(arguments().first, arguments().second);
+    _huge = args.isSet("huge");
+}
+
+#define SKIP_IF_HUGE()                                                      \
+    if(SizeData[testCaseInstanceId()].huge && !_huge)                       \
+        CORRADE_SKIP("Run with --meshtools-huge to enable")
+
+/* Generated on first use and cached, as the larger meshes take a while to
+   create */
+const Trade::MeshData& Benchmark::mesh() {
+    Containers::Optional<Trade::MeshData>& mesh = _meshes[testCaseInstanceId()];
+    if(!mesh) switch(testCaseInstanceId()) {
+        case 0: mesh = Primitives::icosphereSolid(5); break;
+        case 1: mesh = Primitives::grid3DSolid({998, 998}); break;
+        case 2: mesh = Primitives::grid3DSolid({4470, 4470}); break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+    }
+
+    CORRADE_INTERNAL_ASSERT(mesh->vertexCount() == SizeData[testCaseInstanceId()].vertexCount);
+    return *mesh;
+}
+
+void Benchmark::interleave() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    /* Copy positions and normals into two separate blocks so interleave()
+       has to do actual work */
+    const Trade::MeshData& mesh = this->mesh();
+    const UnsignedInt vertexCount = mesh.vertexCount();
+    Containers::Array<char> vertexData{Containers::NoInit, vertexCount*2*sizeof(Vector3)};
+    Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData.slice(0, vertexCount*sizeof(Vector3)));
+    Containers::ArrayView<Vector3> normals = Containers::arrayCast<Vector3>(vertexData.slice(vertexCount*sizeof(Vector3), vertexData.size()));
+    Utility::copy(mesh.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::stridedArrayView(positions));
+    Utility::copy(mesh.attribute<Vector3>(Trade::MeshAttribute::Normal), Containers::stridedArrayView(normals));
+    const Trade::MeshData separate{MeshPrimitive::Triangles, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals}
+    }};
+
+    Containers::Optional<Trade::MeshData> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::interleave(separate);
+
+    CORRADE_VERIFY(isInterleaved(*out));
+    CORRADE_COMPARE(out->vertexCount(), vertexCount);
+}
+
+void Benchmark::compressIndices() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    const Trade::MeshData& mesh = this->mesh();
+
+    std::pair<Containers::Array<char>, MeshIndexType> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::compressIndices(mesh.indices<UnsignedInt>());
+
+    CORRADE_COMPARE(out.second, data.vertexCount <= 65536 ?
+        MeshIndexType::UnsignedShort : MeshIndexType::UnsignedInt);
+}
+
+void Benchmark::removeDuplicates() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    /* Each vertex is present several times in the duplicated mesh */
+    const Trade::MeshData duplicated = MeshTools::duplicate(this->mesh());
+    const Containers::StridedArrayView2D<const char> positions = Containers::arrayCast<2, const char>(duplicated.attribute<Vector3>(Trade::MeshAttribute::Position));
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::removeDuplicates(positions);
+
+    CORRADE_COMPARE(out.second, data.vertexCount);
+}
+
+void Benchmark::generateSmoothNormals() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    const Trade::MeshData& mesh = this->mesh();
+
+    Containers::Array<Vector3> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::generateSmoothNormals(mesh.indices<UnsignedInt>(), mesh.attribute<Vector3>(Trade::MeshAttribute::Position));
+
+    CORRADE_COMPARE(out.size(), data.vertexCount);
+}
+
+void Benchmark::tipsifyInPlace() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    /* The operation is in-place, so it needs a fresh copy every time */
+    const Trade::MeshData& mesh = this->mesh();
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, mesh.indexCount()};
+    Utility::copy(mesh.indices<UnsignedInt>(), Containers::stridedArrayView(indices));
+
+    CORRADE_BENCHMARK(1)
+        MeshTools::tipsifyInPlace(Containers::stridedArrayView(indices), mesh.vertexCount(), 24);
+
+    CORRADE_COMPARE(indices.size(), mesh.indexCount());
+}
+
+void Benchmark::concatenate() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    const Trade::MeshData& mesh = this->mesh();
+
+    Containers::Optional<Trade::MeshData> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::concatenate({mesh, mesh});
+
+    CORRADE_COMPARE(out->vertexCount(), 2*data.vertexCount);
+}
+
+void Benchmark::duplicate() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    const Trade::MeshData& mesh = this->mesh();
+
+    Containers::Optional<Trade::MeshData> out;
+    CORRADE_BENCHMARK(1)
+        out = MeshTools::duplicate(mesh);
+
+    CORRADE_COMPARE(out->vertexCount(), mesh.indexCount());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::Benchmark)
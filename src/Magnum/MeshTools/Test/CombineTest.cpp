@@ -23,11 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <set>
 #include <sstream>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Color.h"
@@ -42,6 +44,7 @@ struct CombineTest: TestSuite::Tester {
     void combineIndexedAttributes();
     void combineIndexedAttributesIndicesOnly();
     void combineIndexedAttributesSingleMesh();
+    void combineIndexedAttributesLarge();
 
     void combineIndexedAttributesNoMeshes();
     void combineIndexedAttributesNotIndexed();
@@ -68,6 +71,7 @@ CombineTest::CombineTest() {
     addTests({&CombineTest::combineIndexedAttributes,
               &CombineTest::combineIndexedAttributesIndicesOnly,
               &CombineTest::combineIndexedAttributesSingleMesh,
+              &CombineTest::combineIndexedAttributesLarge,
 
               &CombineTest::combineIndexedAttributesNoMeshes,
               &CombineTest::combineIndexedAttributesNotIndexed,
@@ -155,6 +159,51 @@ void CombineTest::combineIndexedAttributesIndicesOnly() {
     CORRADE_COMPARE(result.vertexCount(), 2);
 }
 
+void CombineTest::combineIndexedAttributesLarge() {
+    /* Enough data for indices to span multiple bytes and mixed index types
+       to verify the tuples are grouped correctly */
+    Containers::Array<Float> positions{Containers::NoInit, 600};
+    Containers::Array<Float> normals{Containers::NoInit, 300};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = Float(i);
+    for(std::size_t i = 0; i != normals.size(); ++i)
+        normals[i] = -Float(i);
+    Containers::Array<UnsignedInt> positionIndices{Containers::NoInit, 3000};
+    Containers::Array<UnsignedShort> normalIndices{Containers::NoInit, 3000};
+    std::set<std::pair<UnsignedInt, UnsignedShort>> unique;
+    for(std::size_t i = 0; i != positionIndices.size(); ++i) {
+        positionIndices[i] = UnsignedInt((i*7) % positions.size());
+        normalIndices[i] = UnsignedShort((i*i) % normals.size());
+        unique.emplace(positionIndices[i], normalIndices[i]);
+    }
+    Trade::MeshData a{MeshPrimitive::Triangles,
+        {}, positionIndices, Trade::MeshIndexData{positionIndices},
+        {}, positions, {Trade::MeshAttributeData{
+            Trade::meshAttributeCustom(22), Containers::arrayView(positions)}}};
+    Trade::MeshData b{MeshPrimitive::Triangles,
+        {}, normalIndices, Trade::MeshIndexData{normalIndices},
+        {}, normals, {Trade::MeshAttributeData{
+            Trade::meshAttributeCustom(23), Containers::arrayView(normals)}}};
+
+    Trade::MeshData result = MeshTools::combineIndexedAttributes({a, b});
+    CORRADE_COMPARE(result.vertexCount(), unique.size());
+    CORRADE_COMPARE(result.indexCount(), 3000);
+
+    /* Each corner references the original data and the vertices are
+       numbered in order of first occurence */
+    Containers::StridedArrayView1D<const UnsignedInt> indices = result.indices<UnsignedInt>();
+    Containers::StridedArrayView1D<const Float> resultPositions = result.attribute<Float>(0);
+    Containers::StridedArrayView1D<const Float> resultNormals = result.attribute<Float>(1);
+    UnsignedInt nextIndex = 0;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(indices[i], nextIndex, TestSuite::Compare::LessOrEqual);
+        if(indices[i] == nextIndex) ++nextIndex;
+        CORRADE_COMPARE(resultPositions[indices[i]], positions[positionIndices[i]]);
+        CORRADE_COMPARE(resultNormals[indices[i]], normals[normalIndices[i]]);
+    }
+}
+
 void CombineTest::combineIndexedAttributesSingleMesh() {
     const UnsignedInt indices[]{2, 1, 2, 0, 5, 7};
     const Float data[]{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Reference.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -38,6 +39,7 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/MeshView.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -48,6 +50,7 @@
 #include "Magnum/Math/Matrix4.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/Duplicate.h"
+#include "Magnum/MeshTools/Meshletize.h"
 #include "Magnum/Shaders/Flat.h"
 #include "Magnum/Shaders/Phong.h"
 #include "Magnum/Shaders/VertexColor.h"
@@ -103,6 +106,8 @@ struct CompileGLTest: GL::OpenGLTester {
 
         void multipleAttributes();
         void packedAttributes();
+        void packAttributes();
+        void packAttributesInvalidFormat();
 
         void customAttribute();
         void unsupportedAttribute();
@@ -111,10 +116,18 @@ struct CompileGLTest: GL::OpenGLTester {
         void generateNormalsNoPosition();
         void generateNormals2DPosition();
         void generateNormalsNoFloats();
+        void generateTangentsNoTextureCoordinates();
+        void generateTangentsWrongFormat();
 
         void externalBuffers();
         void externalBuffersInvalid();
 
+        void meshlets();
+        void meshletsNotTriangles();
+
+        void batch();
+        void batchNoMeshes();
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
 
@@ -251,10 +264,13 @@ CompileGLTest::CompileGLTest() {
     #endif
 
     addTests({&CompileGLTest::multipleAttributes,
-              &CompileGLTest::packedAttributes},
+              &CompileGLTest::packedAttributes,
+              &CompileGLTest::packAttributes},
         &CompileGLTest::renderSetup,
         &CompileGLTest::renderTeardown);
 
+    addTests({&CompileGLTest::packAttributesInvalidFormat});
+
     addInstancedTests({&CompileGLTest::customAttribute,
                        &CompileGLTest::unsupportedAttribute,
                        &CompileGLTest::implementationSpecificAttributeFormat},
@@ -262,7 +278,9 @@ CompileGLTest::CompileGLTest() {
 
     addTests({&CompileGLTest::generateNormalsNoPosition,
               &CompileGLTest::generateNormals2DPosition,
-              &CompileGLTest::generateNormalsNoFloats});
+              &CompileGLTest::generateNormalsNoFloats,
+              &CompileGLTest::generateTangentsNoTextureCoordinates,
+              &CompileGLTest::generateTangentsWrongFormat});
 
     addInstancedTests({&CompileGLTest::externalBuffers},
         Containers::arraySize(DataExternal),
@@ -271,6 +289,18 @@ CompileGLTest::CompileGLTest() {
 
     addTests({&CompileGLTest::externalBuffersInvalid});
 
+    addTests({&CompileGLTest::meshlets},
+        &CompileGLTest::renderSetup,
+        &CompileGLTest::renderTeardown);
+
+    addTests({&CompileGLTest::meshletsNotTriangles});
+
+    addTests({&CompileGLTest::batch},
+        &CompileGLTest::renderSetup,
+        &CompileGLTest::renderTeardown);
+
+    addTests({&CompileGLTest::batchNoMeshes});
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -1146,6 +1176,116 @@ void CompileGLTest::packedAttributes() {
     #endif
 }
 
+void CompileGLTest::packAttributes() {
+    struct Vertex {
+        Vector2 position;
+        Float custom;
+        Vector2 textureCoordinates;
+    } vertexData[]{
+        {{-0.75f, -0.75f}, 1.0f, {0.0f, 0.0f}},
+        {{ 0.00f, -0.75f}, 2.0f, {0.5f, 0.0f}},
+        {{ 0.75f, -0.75f}, 3.0f, {1.0f, 0.0f}},
+
+        {{-0.75f,  0.00f}, 4.0f, {0.0f, 0.5f}},
+        {{ 0.00f,  0.00f}, 5.0f, {0.5f, 0.5f}},
+        {{ 0.75f,  0.00f}, 6.0f, {1.0f, 0.5f}},
+
+        {{-0.75f,  0.75f}, 7.0f, {0.0f, 1.0f}},
+        {{ 0.0f,   0.75f}, 8.0f, {0.5f, 1.0f}},
+        {{ 0.75f,  0.75f}, 9.0f, {1.0f, 1.0f}}
+    };
+
+    /* Surrounded by unused data that shouldn't get uploaded */
+    const UnsignedInt indexData[]{
+        0xdeadbeef,
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7,
+        0xdeadbeef
+    };
+
+    Trade::MeshData meshData{MeshPrimitive::Triangles,
+        {}, indexData, Trade::MeshIndexData{Containers::arrayView(indexData).slice(1, 25)},
+        {}, vertexData, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::stridedArrayView(vertexData,
+                &vertexData[0].position, Containers::arraySize(vertexData), sizeof(Vertex))},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(15),
+                Containers::stridedArrayView(vertexData,
+                &vertexData[0].custom, Containers::arraySize(vertexData), sizeof(Vertex))},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                Containers::stridedArrayView(vertexData,
+                &vertexData[0].textureCoordinates, Containers::arraySize(vertexData), sizeof(Vertex))},
+        }};
+
+    /* The custom attribute is skipped with a warning as usual, formats for
+       attributes that are not present in the mesh are ignored */
+    std::ostringstream out;
+    GL::Mesh mesh{NoCreate};
+    {
+        Warning redirectWarning{&out};
+        mesh = compile(meshData, {
+            {Trade::MeshAttribute::TextureCoordinates, VertexFormat::Vector2usNormalized},
+            {Trade::MeshAttribute::Normal, VertexFormat::Vector3bNormalized}
+        });
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "MeshTools::compile(): ignoring unknown/unsupported attribute Trade::MeshAttribute::Custom(15)\n");
+    CORRADE_COMPARE(mesh.count(), 24);
+    CORRADE_COMPARE(mesh.indexType(), GL::MeshIndexType::UnsignedInt);
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    _flatTextured2D
+        .bindTexture(_texture)
+        .draw(mesh);
+
+    /* The output should be the same as in the textured case of twoDimensions()
+       -- i.e., neither the skipped custom attribute nor the packing affecting
+       anything */
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read({{}, {32, 32}}, {PixelFormat::RGBA8Unorm}),
+        Utility::Directory::join(COMPILEGLTEST_TEST_DIR, "textured2D.tga"),
+        /* SwiftShader has some minor off-by-one precision differences,
+            llvmpipe as well */
+        (DebugTools::CompareImageToFile{_manager, 1.75f, 0.22f}));
+}
+
+void CompileGLTest::packAttributesInvalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+                VertexFormat::Vector4ubNormalized, nullptr}
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compile(data, {
+        {Trade::MeshAttribute::Position, VertexFormat::Vector2bNormalized}
+    });
+    compile(data, {
+        {Trade::MeshAttribute::Position, VertexFormat::Vector3ub}
+    });
+    compile(data, {
+        {Trade::MeshAttribute::Color, VertexFormat::Vector4h}
+    });
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): can't convert Trade::MeshAttribute::Position from VertexFormat::Vector3 to VertexFormat::Vector2bNormalized\n"
+        "MeshTools::compile(): can't convert Trade::MeshAttribute::Position from VertexFormat::Vector3 to VertexFormat::Vector3ub\n"
+        "MeshTools::compile(): can't convert Trade::MeshAttribute::Color from VertexFormat::Vector4ubNormalized to VertexFormat::Vector4h\n");
+}
+
 void CompileGLTest::customAttribute() {
     auto&& instanceData = CustomAttributeWarningData[testCaseInstanceId()];
     setTestCaseDescription(instanceData.name);
@@ -1254,6 +1394,61 @@ void CompileGLTest::generateNormalsNoFloats() {
         "MeshTools::compile(): can't generate normals into VertexFormat::Vector3h\n");
 }
 
+void CompileGLTest::generateTangentsNoTextureCoordinates() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                VertexFormat::Vector3, nullptr},
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::compile(data, CompileFlag::GenerateTangents);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): the mesh needs positions, normals and texture coordinates to generate tangents\n");
+}
+
+void CompileGLTest::generateTangentsWrongFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                VertexFormat::Vector2, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Tangent,
+                VertexFormat::Vector3, nullptr},
+        }};
+    Trade::MeshData halfFloatData{MeshPrimitive::Triangles,
+        nullptr, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                VertexFormat::Vector3, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                VertexFormat::Vector3h, nullptr},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+                VertexFormat::Vector2, nullptr},
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::compile(data, CompileFlag::GenerateTangents);
+    MeshTools::compile(halfFloatData, CompileFlag::GenerateTangents);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): can't generate tangents into VertexFormat::Vector3\n"
+        "MeshTools::compile(): can't generate tangents for VertexFormat::Vector3 positions, VertexFormat::Vector3h normals and VertexFormat::Vector2 texture coordinates\n");
+}
+
 void CompileGLTest::externalBuffers() {
     auto&& data = DataExternal[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -1356,6 +1551,152 @@ void CompileGLTest::externalBuffersInvalid() {
         "MeshTools::compile(): invalid external buffer(s)\n");
 }
 
+void CompileGLTest::meshlets() {
+    /* Same as in externalBuffers() */
+    Vector2 positions[] {
+        {-0.75f, -0.75f},
+        { 0.00f, -0.75f},
+        { 0.75f, -0.75f},
+
+        {-0.75f,  0.00f},
+        { 0.00f,  0.00f},
+        { 0.75f,  0.00f},
+
+        {-0.75f,  0.75f},
+        { 0.0f,   0.75f},
+        { 0.75f,  0.75f}
+    };
+
+    const UnsignedShort indexData[]{
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7
+    };
+
+    Trade::MeshData meshData{MeshPrimitive::Triangles,
+        {}, indexData, Trade::MeshIndexData{indexData},
+        {}, positions, {Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}}};
+
+    /* Each quad is a separate meshlet */
+    Meshlets meshlets = meshletize(meshData, 4, 2);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 4);
+
+    GL::Buffer meshletBuffer;
+    GL::Mesh mesh = compile(meshData, meshlets, meshletBuffer);
+    CORRADE_COMPARE(mesh.count(), 24);
+    CORRADE_COMPARE(mesh.indexType(), GL::MeshIndexType::UnsignedInt);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    _flat2D
+        .setColor(0xff3366_rgbf)
+        .draw(mesh);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read({{}, {32, 32}}, {PixelFormat::RGBA8Unorm}),
+        Utility::Directory::join(COMPILEGLTEST_TEST_DIR, "flat2D.tga"),
+        (DebugTools::CompareImageToFile{_manager}));
+}
+
+void CompileGLTest::meshletsNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    GL::Buffer meshletBuffer{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compile(Trade::MeshData{MeshPrimitive::Lines, 2}, Meshlets{{}, {}, {}}, meshletBuffer);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n");
+}
+
+
+void CompileGLTest::batch() {
+    /* Same as in externalBuffers(), but with the bottom half indexed and the
+       top half non-indexed, each being a separate mesh */
+    Vector2 bottomPositions[] {
+        {-0.75f, -0.75f},
+        { 0.00f, -0.75f},
+        { 0.75f, -0.75f},
+
+        {-0.75f,  0.00f},
+        { 0.00f,  0.00f},
+        { 0.75f,  0.00f}
+    };
+    const UnsignedShort bottomIndices[]{
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4
+    };
+    Trade::MeshData bottom{MeshPrimitive::Triangles,
+        {}, bottomIndices, Trade::MeshIndexData{bottomIndices},
+        {}, bottomPositions, {Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(bottomPositions)}}};
+
+    Vector2 topPositions[] {
+        {-0.75f,  0.00f}, { 0.00f,  0.00f}, { 0.00f,  0.75f},
+        {-0.75f,  0.00f}, { 0.00f,  0.75f}, {-0.75f,  0.75f},
+        { 0.00f,  0.00f}, { 0.75f,  0.00f}, { 0.75f,  0.75f},
+        { 0.00f,  0.00f}, { 0.75f,  0.75f}, { 0.00f,  0.75f}
+    };
+    Trade::MeshData top{MeshPrimitive::Triangles,
+        {}, topPositions, {Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(topPositions)}}};
+
+    GL::Mesh mesh{NoCreate};
+    Containers::Array<GL::MeshView> views = compile({bottom, top}, mesh);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The 32-bit indices generated by concatenate() got compressed */
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.count(), 24);
+    CORRADE_COMPARE(mesh.indexType(), GL::MeshIndexType::UnsignedShort);
+
+    CORRADE_COMPARE(views.size(), 2);
+    CORRADE_COMPARE(&views[0].mesh(), &mesh);
+    CORRADE_COMPARE(views[0].count(), 12);
+    CORRADE_COMPARE(views[0].baseVertex(), 0);
+    CORRADE_COMPARE(&views[1].mesh(), &mesh);
+    CORRADE_COMPARE(views[1].count(), 12);
+    CORRADE_COMPARE(views[1].baseVertex(), 0);
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Drawing the views separately gives the same result as the original */
+    _framebuffer.clear(GL::FramebufferClear::Color);
+    _flat2D.setColor(0xff3366_rgbf);
+    _flat2D.draw(views[0]);
+    _flat2D.draw(views[1]);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_WITH(
+        _framebuffer.read({{}, {32, 32}}, {PixelFormat::RGBA8Unorm}),
+        Utility::Directory::join(COMPILEGLTEST_TEST_DIR, "flat2D.tga"),
+        (DebugTools::CompareImageToFile{_manager}));
+}
+
+void CompileGLTest::batchNoMeshes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compile(Containers::ArrayView<const Containers::Reference<const Trade::MeshData>>{}, mesh);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::compile(): no meshes passed\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileGLTest)
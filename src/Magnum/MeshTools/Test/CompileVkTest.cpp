@@ -0,0 +1,335 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/CompileVk.h"
+#include "Magnum/Trade/MeshData.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/StagingUploader.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct CompileVkTest: Vk::VulkanTester {
+    explicit CompileVkTest();
+
+    void interleaved();
+    void nonInterleaved();
+    void indexed();
+    void duplicateAttribute();
+    void customAttribute();
+    void noVertices();
+
+    void addVertexInput();
+    void addVertexInputNoAttributes();
+
+    private:
+        /* Timeline semaphores needed by the uploader need a dedicated
+           device */
+        bool createTimelineDevice();
+
+        Vk::DeviceProperties _properties{NoCreate};
+        Containers::Pointer<Vk::Device> _device;
+        Vk::Queue _queue{NoCreate};
+        UnsignedInt _queueFamily{};
+};
+
+CompileVkTest::CompileVkTest() {
+    addTests({&CompileVkTest::interleaved,
+              &CompileVkTest::nonInterleaved,
+              &CompileVkTest::indexed,
+              &CompileVkTest::duplicateAttribute,
+              &CompileVkTest::customAttribute,
+              &CompileVkTest::noVertices,
+
+              &CompileVkTest::addVertexInput,
+              &CompileVkTest::addVertexInputNoAttributes});
+}
+
+bool CompileVkTest::createTimelineDevice() {
+    if(_device) return true;
+
+    _properties = Vk::pickDevice(instance());
+    if(!(_properties.features() & Vk::DeviceFeature::TimelineSemaphore))
+        return false;
+
+    _queueFamily = _properties.pickQueueFamily(Vk::QueueFlag::Graphics);
+    Vk::DeviceCreateInfo info{_properties};
+    info.addQueues(_queueFamily, {0.0f}, {_queue})
+        .setEnabledFeatures(Vk::DeviceFeature::TimelineSemaphore);
+    if(!_properties.isVersionSupported(Vk::Version::Vk12))
+        info.addEnabledExtensions<Vk::Extensions::KHR::timeline_semaphore>();
+    _device.emplace(instance(), info);
+    return true;
+}
+
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoordinates;
+};
+
+void CompileVkTest::interleaved() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    /* Some padding in front to verify the offset is propagated */
+    Containers::Array<char> vertexData{16 + 3*sizeof(Vertex)};
+    Containers::ArrayView<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData.suffix(16));
+    Containers::StridedArrayView1D<Vector3> positions{vertexData,
+        &vertices[0].position, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vector3> normals{vertexData,
+        &vertices[0].normal, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vector2> textureCoordinates{vertexData,
+        &vertices[0].textureCoordinates, 3, sizeof(Vertex)};
+    Trade::MeshData data{MeshPrimitive::TriangleStrip, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, textureCoordinates},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+    }};
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    VkMesh mesh = compile(data, *_device, allocator, uploader);
+    CORRADE_VERIFY(mesh.vertexBuffer.handle());
+    CORRADE_VERIFY(!mesh.indexBuffer.handle());
+    CORRADE_VERIFY(!mesh.isIndexed);
+    CORRADE_COMPARE(mesh.primitive, MeshPrimitive::TriangleStrip);
+    CORRADE_COMPARE(mesh.count, 3);
+    CORRADE_COMPARE(mesh.vertexOffset, 16);
+    CORRADE_COMPARE(mesh.vertexStride, sizeof(Vertex));
+
+    CORRADE_COMPARE(mesh.attributes.size(), 3);
+    CORRADE_COMPARE(mesh.attributes[0].location, 5);
+    CORRADE_COMPARE(mesh.attributes[0].format, VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh.attributes[0].offset, 12);
+    CORRADE_COMPARE(mesh.attributes[1].location, 1);
+    CORRADE_COMPARE(mesh.attributes[1].format, VertexFormat::Vector2);
+    CORRADE_COMPARE(mesh.attributes[1].offset, 24);
+    CORRADE_COMPARE(mesh.attributes[2].location, 0);
+    CORRADE_COMPARE(mesh.attributes[2].format, VertexFormat::Vector3);
+    CORRADE_COMPARE(mesh.attributes[2].offset, 0);
+
+    /* The upload is only recorded, not submitted */
+    CORRADE_COMPARE(uploader.submittedValue(), 0);
+    uploader.semaphore().wait(uploader.flush());
+}
+
+void CompileVkTest::nonInterleaved() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Containers::Array<char> vertexData{3*sizeof(Vector3) + 3*sizeof(Vector2)};
+    Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData.prefix(3*sizeof(Vector3)));
+    Containers::ArrayView<Vector2> textureCoordinates = Containers::arrayCast<Vector2>(vertexData.suffix(3*sizeof(Vector3)));
+    Trade::MeshData data{MeshPrimitive::Triangles, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, textureCoordinates}
+    }};
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    VkMesh mesh = compile(data, *_device, allocator, uploader);
+
+    /* An interleaved copy got made */
+    CORRADE_COMPARE(mesh.vertexOffset, 0);
+    CORRADE_COMPARE(mesh.vertexStride, sizeof(Vector3) + sizeof(Vector2));
+    CORRADE_COMPARE(mesh.count, 3);
+    CORRADE_COMPARE(mesh.attributes.size(), 2);
+    CORRADE_COMPARE(mesh.attributes[0].location, 0);
+    CORRADE_COMPARE(mesh.attributes[0].offset, 0);
+    CORRADE_COMPARE(mesh.attributes[1].location, 1);
+    CORRADE_COMPARE(mesh.attributes[1].offset, sizeof(Vector3));
+
+    uploader.semaphore().wait(uploader.flush());
+}
+
+void CompileVkTest::indexed() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Containers::Array<char> indexData{4 + 6*sizeof(UnsignedShort)};
+    Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData.suffix(4));
+    Containers::Array<char> vertexData{4*sizeof(Vector3)};
+    Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData);
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        std::move(indexData), Trade::MeshIndexData{indices},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+        }};
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    VkMesh mesh = compile(data, *_device, allocator, uploader);
+    CORRADE_VERIFY(mesh.vertexBuffer.handle());
+    CORRADE_VERIFY(mesh.indexBuffer.handle());
+    CORRADE_VERIFY(mesh.isIndexed);
+    CORRADE_COMPARE(mesh.indexType, MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(mesh.indexOffset, 4);
+    CORRADE_COMPARE(mesh.count, 6);
+
+    uploader.semaphore().wait(uploader.flush());
+}
+
+void CompileVkTest::duplicateAttribute() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Containers::Array<char> vertexData{3*sizeof(Vertex)};
+    Containers::ArrayView<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+    Containers::StridedArrayView1D<Vector3> positions{vertexData,
+        &vertices[0].position, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vector3> normals{vertexData,
+        &vertices[0].normal, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<UnsignedInt> objectIds{vertexData,
+        reinterpret_cast<UnsignedInt*>(&vertices[0].textureCoordinates), 3, sizeof(Vertex)};
+    /* Second position is ignored, bitangent and object ID share the same
+       location so only the first one gets used */
+    Trade::MeshData data{MeshPrimitive::Triangles, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Bitangent, normals},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, normals},
+        Trade::MeshAttributeData{Trade::MeshAttribute::ObjectId, objectIds}
+    }};
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    VkMesh mesh = compile(data, *_device, allocator, uploader);
+    CORRADE_COMPARE(mesh.attributes.size(), 2);
+    CORRADE_COMPARE(mesh.attributes[0].location, 4);
+    CORRADE_COMPARE(mesh.attributes[0].offset, 12);
+    CORRADE_COMPARE(mesh.attributes[1].location, 0);
+    CORRADE_COMPARE(mesh.attributes[1].offset, 0);
+
+    uploader.semaphore().wait(uploader.flush());
+}
+
+void CompileVkTest::customAttribute() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Containers::Array<char> vertexData{3*sizeof(Vertex)};
+    Containers::ArrayView<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+    Containers::StridedArrayView1D<Vector3> positions{vertexData,
+        &vertices[0].position, 3, sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vector3> normals{vertexData,
+        &vertices[0].normal, 3, sizeof(Vertex)};
+    Trade::MeshData data{MeshPrimitive::Triangles, std::move(vertexData), {
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(115), normals},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+    }};
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+
+    std::ostringstream out;
+    VkMesh mesh{NoCreate};
+    {
+        Warning redirectWarning{&out};
+        mesh = compile(data, *_device, allocator, uploader);
+    }
+    CORRADE_COMPARE(out.str(), "MeshTools::compile(): ignoring unknown/unsupported attribute Trade::MeshAttribute::Custom(115)\n");
+    CORRADE_COMPARE(mesh.attributes.size(), 1);
+    CORRADE_COMPARE(mesh.attributes[0].location, 0);
+
+    uploader.semaphore().wait(uploader.flush());
+}
+
+void CompileVkTest::noVertices() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Vk::MemoryAllocator allocator{*_device};
+    Vk::StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    compile(Trade::MeshData{MeshPrimitive::Points, 0}, *_device, allocator, uploader);
+    CORRADE_COMPARE(out.str(), "MeshTools::compile(): the mesh has no vertices\n");
+}
+
+void CompileVkTest::addVertexInput() {
+    VkMesh mesh{NoCreate};
+    mesh.primitive = MeshPrimitive::LineStrip;
+    mesh.vertexStride = 20;
+    mesh.attributes = Containers::Array<VkMeshAttribute>{Containers::InPlaceInit, {
+        {0, VertexFormat::Vector3, 8},
+        {1, VertexFormat::Vector2usNormalized, 0}
+    }};
+
+    Vk::GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    MeshTools::addVertexInput(mesh, info, 3);
+    CORRADE_COMPARE(info->pInputAssemblyState->topology, VK_PRIMITIVE_TOPOLOGY_LINE_STRIP);
+
+    const VkPipelineVertexInputStateCreateInfo& vertexInput = *info->pVertexInputState;
+    CORRADE_COMPARE(vertexInput.vertexBindingDescriptionCount, 1);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].binding, 3);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].stride, 20);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].inputRate, VK_VERTEX_INPUT_RATE_VERTEX);
+
+    CORRADE_COMPARE(vertexInput.vertexAttributeDescriptionCount, 2);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].location, 0);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].binding, 3);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].format, VK_FORMAT_R32G32B32_SFLOAT);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].offset, 8);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].location, 1);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].binding, 3);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].format, VK_FORMAT_R16G16_UNORM);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].offset, 0);
+}
+
+void CompileVkTest::addVertexInputNoAttributes() {
+    VkMesh mesh{NoCreate};
+    mesh.primitive = MeshPrimitive::Points;
+
+    /* No binding gets added if there are no attributes */
+    Vk::GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    MeshTools::addVertexInput(mesh, info);
+    CORRADE_COMPARE(info->pInputAssemblyState->topology, VK_PRIMITIVE_TOPOLOGY_POINT_LIST);
+    CORRADE_COMPARE(info->pVertexInputState->vertexBindingDescriptionCount, 0);
+    CORRADE_COMPARE(info->pVertexInputState->vertexAttributeDescriptionCount, 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::CompileVkTest)
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
@@ -45,12 +46,26 @@ struct ConcatenateTest: TestSuite::Tester {
     void concatenateInto();
     void concatenateIntoNoIndexArray();
     void concatenateIntoNonOwnedAttributeArray();
+    void concatenateIndexVertexCountStride();
+    void concatenateIntoExternal();
+    void concatenateIntoExternalThreaded();
 
     void concatenateUnsupportedPrimitive();
     void concatenateInconsistentPrimitive();
     void concatenateInconsistentAttributeType();
     void concatenateInconsistentAttributeArraySize();
     void concatenateIntoNoMeshes();
+    void concatenateIntoExternalTooSmall();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than meshes", 1000}
 };
 
 ConcatenateTest::ConcatenateTest() {
@@ -63,12 +78,19 @@ ConcatenateTest::ConcatenateTest() {
               &ConcatenateTest::concatenateInto,
               &ConcatenateTest::concatenateIntoNoIndexArray,
               &ConcatenateTest::concatenateIntoNonOwnedAttributeArray,
+              &ConcatenateTest::concatenateIndexVertexCountStride,
+              &ConcatenateTest::concatenateIntoExternal});
+
+    addInstancedTests({&ConcatenateTest::concatenateIntoExternalThreaded},
+        Containers::arraySize(ThreadedData));
 
+    addTests({
               &ConcatenateTest::concatenateUnsupportedPrimitive,
               &ConcatenateTest::concatenateInconsistentPrimitive,
               &ConcatenateTest::concatenateInconsistentAttributeType,
               &ConcatenateTest::concatenateInconsistentAttributeArraySize,
-              &ConcatenateTest::concatenateIntoNoMeshes});
+              &ConcatenateTest::concatenateIntoNoMeshes,
+              &ConcatenateTest::concatenateIntoExternalTooSmall});
 }
 
 /* MSVC 2015 doesn't like unnamed bitfields in local structs, so thhis has to
@@ -543,6 +565,153 @@ void ConcatenateTest::concatenateIntoNonOwnedAttributeArray() {
     CORRADE_COMPARE(dst.vertexData().data(), vertexDataPointer);
 }
 
+void ConcatenateTest::concatenateIndexVertexCountStride() {
+    const Vector3 positions[4]{};
+    const UnsignedByte indices[]{0, 1, 2, 2, 1, 3};
+    Trade::MeshData a{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions).prefix(3)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+            Containers::arrayView(positions).prefix(3)}
+    }};
+    Trade::MeshData b{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    /* Non-indexed only */
+    CORRADE_COMPARE(MeshTools::concatenateIndexVertexCount({a, a}),
+        std::make_pair(0u, 6u));
+    /* The first mesh gets a trivial index buffer */
+    CORRADE_COMPARE(MeshTools::concatenateIndexVertexCount({a, b}),
+        std::make_pair(9u, 7u));
+
+    /* Tightly packed attributes of the first mesh */
+    CORRADE_COMPARE(MeshTools::concatenateVertexStride({a, b}), 24);
+    CORRADE_COMPARE(MeshTools::concatenateVertexStride({b, a}), 12);
+    CORRADE_COMPARE(MeshTools::concatenateVertexStride({Trade::MeshData{MeshPrimitive::Triangles, 3}}), 0);
+}
+
+void ConcatenateTest::concatenateIntoExternal() {
+    const Vector3 positionsA[]{
+        {1.0f, 2.0f, 3.0f},
+        {4.0f, 5.0f, 6.0f}
+    };
+    const Vector2 textureCoordinatesA[]{
+        {0.1f, 0.2f},
+        {0.3f, 0.4f}
+    };
+    Trade::MeshData a{MeshPrimitive::Points, nullptr, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positionsA)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates,
+            Containers::arrayView(textureCoordinatesA)}
+    }};
+
+    /* Indexed, misses the texture coordinates, which should be zero-filled
+       even though the memory has garbage in it */
+    const Vector3 positionsB[]{
+        {7.0f, 8.0f, 9.0f},
+        {1.5f, 2.5f, 3.5f},
+        {4.5f, 5.5f, 6.5f}
+    };
+    const UnsignedShort indicesB[]{2, 0, 1, 1};
+    Trade::MeshData b{MeshPrimitive::Points,
+        {}, indicesB, Trade::MeshIndexData{indicesB}, {}, positionsB, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positionsB)}
+        }};
+
+    /* Larger than needed to verify only a prefix is used */
+    char indexData[11*4 + 3];
+    char vertexData[5*20 + 7];
+    std::memset(indexData, 0xcd, sizeof(indexData));
+    std::memset(vertexData, 0xcd, sizeof(vertexData));
+
+    Trade::MeshData dst = MeshTools::concatenateInto(indexData, vertexData, {a, b});
+    CORRADE_COMPARE(dst.primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(dst.indexDataFlags(), Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(dst.vertexDataFlags(), Trade::DataFlag::Mutable);
+    CORRADE_COMPARE(dst.indexData().data(), static_cast<const void*>(indexData));
+    CORRADE_COMPARE(dst.indexData().size(), 6*4);
+    CORRADE_COMPARE(dst.vertexData().data(), static_cast<const void*>(vertexData));
+    CORRADE_COMPARE(dst.vertexData().size(), 5*20);
+    CORRADE_COMPARE(dst.attributeCount(), 2);
+    CORRADE_COMPARE_AS(dst.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f},
+            {1.5f, 2.5f, 3.5f},
+            {4.5f, 5.5f, 6.5f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(dst.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.1f, 0.2f},
+            {0.3f, 0.4f},
+            {}, {}, {} /* Missing in the second mesh */
+        }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(dst.isIndexed());
+    CORRADE_COMPARE(dst.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE_AS(dst.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 1,       /* implicit for the first nonindexed mesh */
+            4, 2, 3, 3  /* offset for the second indexed mesh */
+        }), TestSuite::Compare::Container);
+}
+
+void ConcatenateTest::concatenateIntoExternalThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split among several threads, alternating indexed
+       and non-indexed meshes and ones with and without normals */
+    Containers::Array<Vector3> positions{Containers::NoInit, 100};
+    Containers::Array<UnsignedShort> indices{Containers::NoInit, 150};
+    for(std::size_t i = 0; i != positions.size(); ++i)
+        positions[i] = Vector3{Float(i)};
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        indices[i] = UnsignedShort((i*7) % positions.size());
+    Trade::MeshData indexed{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal,
+                Containers::arrayView(positions)}
+        }};
+    Trade::MeshData nonIndexed{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+            Containers::arrayView(positions)}
+    }};
+    Containers::Array<Containers::Reference<const Trade::MeshData>> meshes;
+    for(std::size_t i = 0; i != 100; ++i)
+        arrayAppend(meshes, Containers::Reference<const Trade::MeshData>{i % 3 != 1 ? indexed : nonIndexed});
+
+    /* Everything should be the same as with concatenate() */
+    Trade::MeshData expected = MeshTools::concatenate(meshes);
+
+    const std::pair<UnsignedInt, UnsignedInt> count = MeshTools::concatenateIndexVertexCount(meshes);
+    const std::size_t stride = MeshTools::concatenateVertexStride(meshes);
+    CORRADE_COMPARE(count.first, expected.indexCount());
+    CORRADE_COMPARE(count.second, expected.vertexCount());
+    CORRADE_COMPARE(stride, expected.attributeStride(0));
+
+    Containers::Array<char> indexData{Containers::NoInit, count.first*4};
+    Containers::Array<char> vertexData{Containers::NoInit, count.second*stride};
+    std::memset(vertexData, 0xcd, vertexData.size());
+    Trade::MeshData dst = MeshTools::concatenateInto(indexData, vertexData, meshes, data.threadCount);
+    CORRADE_COMPARE_AS(dst.indices<UnsignedInt>(),
+        expected.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(dst.attribute<Vector3>(Trade::MeshAttribute::Position),
+        expected.attribute<Vector3>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(dst.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        expected.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+}
+
 void ConcatenateTest::concatenateUnsupportedPrimitive() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -554,8 +723,10 @@ void ConcatenateTest::concatenateUnsupportedPrimitive() {
     Error redirectError{&out};
     MeshTools::concatenate({a});
     MeshTools::concatenateInto(a, {a});
+    MeshTools::concatenateInto(nullptr, nullptr, {a});
     CORRADE_COMPARE(out.str(),
         "MeshTools::concatenate(): MeshPrimitive::TriangleStrip is not supported, turn it into a plain indexed mesh first\n"
+        "MeshTools::concatenateInto(): MeshPrimitive::TriangleStrip is not supported, turn it into a plain indexed mesh first\n"
         "MeshTools::concatenateInto(): MeshPrimitive::TriangleStrip is not supported, turn it into a plain indexed mesh first\n");
 }
 
@@ -647,7 +818,37 @@ void ConcatenateTest::concatenateIntoNoMeshes() {
     std::ostringstream out;
     Error redirectError{&out};
     MeshTools::concatenateInto(destination, {});
-    CORRADE_COMPARE(out.str(), "MeshTools::concatenateInto(): no meshes passed\n");
+    MeshTools::concatenateInto(nullptr, nullptr, {});
+    MeshTools::concatenateVertexStride({});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::concatenateInto(): no meshes passed\n"
+        "MeshTools::concatenateInto(): no meshes passed\n"
+        "MeshTools::concatenateVertexStride(): expected at least one mesh\n");
+}
+
+void ConcatenateTest::concatenateIntoExternalTooSmall() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector3 positions[3]{};
+    const UnsignedByte indices[]{0, 1, 2, 2};
+    Trade::MeshData a{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    char indexData[4*4];
+    char vertexData[3*12];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::concatenateInto(Containers::arrayView(indexData).prefix(15), vertexData, {a});
+    MeshTools::concatenateInto(indexData, Containers::arrayView(vertexData).prefix(35), {a});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::concatenateInto(): expected index data of at least 16 bytes but got 15\n"
+        "MeshTools::concatenateInto(): expected vertex data of at least 36 bytes but got 35\n");
 }
 
 }}}}
@@ -0,0 +1,402 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Bezier.h"
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/Distance.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/FlattenCurves.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct FlattenCurvesTest: TestSuite::Tester {
+    explicit FlattenCurvesTest();
+
+    void offsets();
+    void offsetsMaxSegments();
+    void offsetsEmpty();
+
+    void flatten();
+    void flatten3D();
+    void flattenStrided();
+    void flattenTolerance();
+    void flattenThreaded();
+
+    void mesh();
+    void mesh3D();
+    void meshSpline();
+
+    void offsetsInvalid();
+    void flattenInvalid();
+    void meshSplineInvalid();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
+};
+
+const struct {
+    const char* name;
+    Float tolerance;
+} ToleranceData[] {
+    {"0.1", 0.1f},
+    {"0.01", 0.01f},
+    {"0.001", 0.001f}
+};
+
+FlattenCurvesTest::FlattenCurvesTest() {
+    addTests({&FlattenCurvesTest::offsets,
+              &FlattenCurvesTest::offsetsMaxSegments,
+              &FlattenCurvesTest::offsetsEmpty,
+
+              &FlattenCurvesTest::flatten,
+              &FlattenCurvesTest::flatten3D,
+              &FlattenCurvesTest::flattenStrided});
+
+    addInstancedTests({&FlattenCurvesTest::flattenTolerance},
+        Containers::arraySize(ToleranceData));
+
+    addInstancedTests({&FlattenCurvesTest::flattenThreaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&FlattenCurvesTest::mesh,
+              &FlattenCurvesTest::mesh3D,
+              &FlattenCurvesTest::meshSpline,
+
+              &FlattenCurvesTest::offsetsInvalid,
+              &FlattenCurvesTest::flattenInvalid,
+              &FlattenCurvesTest::meshSplineInvalid});
+}
+
+/* A straight line, an arch and a loop-ish curve. The arch has the second
+   differences of length sqrt(2), which with tolerance 0.01 gives
+   ceil(sqrt(0.75*sqrt(2)/0.01)) = 11 segments. */
+const CubicBezier2D Curves[]{
+    {Vector2{0.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{2.0f, 0.0f}, Vector2{3.0f, 0.0f}},
+    {Vector2{0.0f, 0.0f}, Vector2{0.0f, 1.0f}, Vector2{1.0f, 1.0f}, Vector2{1.0f, 0.0f}},
+    {Vector2{0.0f, 0.0f}, Vector2{10.0f, 5.0f}, Vector2{-3.0f, 8.0f}, Vector2{4.0f, -2.0f}}
+};
+
+void FlattenCurvesTest::offsets() {
+    UnsignedInt offsets[4];
+    CORRADE_COMPARE(flattenCurvesOffsetsInto(Containers::arrayView(Curves).prefix(2), 0.01f, Containers::arrayView(offsets).prefix(3)), 14);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets).prefix(3), Containers::arrayView<UnsignedInt>({
+        0, 2, 14
+    }), TestSuite::Compare::Container);
+
+    /* Same for 3D, with the curves in the XZ plane */
+    CubicBezier3D curves3D[2];
+    for(std::size_t i = 0; i != 2; ++i)
+        for(std::size_t j = 0; j != 4; ++j)
+            curves3D[i][j] = {Curves[i][j].x(), 0.0f, Curves[i][j].y()};
+    CORRADE_COMPARE(flattenCurvesOffsetsInto(curves3D, 0.01f, Containers::arrayView(offsets).prefix(3)), 14);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets).prefix(3), Containers::arrayView<UnsignedInt>({
+        0, 2, 14
+    }), TestSuite::Compare::Container);
+}
+
+void FlattenCurvesTest::offsetsMaxSegments() {
+    UnsignedInt offsets[4];
+    CORRADE_COMPARE(flattenCurvesOffsetsInto(Curves, 0.0001f, offsets, 8), 20);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<UnsignedInt>({
+        0, 2, 11, 20
+    }), TestSuite::Compare::Container);
+}
+
+void FlattenCurvesTest::offsetsEmpty() {
+    UnsignedInt offsets[1]{0xdeadbeef};
+    CORRADE_COMPARE(flattenCurvesOffsetsInto(Containers::StridedArrayView1D<const CubicBezier2D>{}, 0.01f, offsets), 0);
+    CORRADE_COMPARE(offsets[0], 0);
+}
+
+void FlattenCurvesTest::flatten() {
+    UnsignedInt offsets[4];
+    const UnsignedInt vertexCount = flattenCurvesOffsetsInto(Curves, 0.01f, offsets);
+    Containers::Array<Vector2> positions{Containers::NoInit, vertexCount};
+    flattenCurvesInto(Curves, offsets, positions);
+
+    for(std::size_t i = 0; i != Containers::arraySize(Curves); ++i) {
+        CORRADE_ITERATION(i);
+        const UnsignedInt count = offsets[i + 1] - offsets[i];
+        for(UnsignedInt j = 0; j != count; ++j) {
+            CORRADE_ITERATION(j);
+            CORRADE_COMPARE(positions[offsets[i] + j], Curves[i].value(Float(j)/(count - 1)));
+        }
+
+        /* The endpoints are exact */
+        CORRADE_VERIFY(positions[offsets[i]] == Curves[i][0]);
+        CORRADE_VERIFY(positions[offsets[i + 1] - 1] == Curves[i][3]);
+    }
+}
+
+void FlattenCurvesTest::flatten3D() {
+    const CubicBezier3D curves[]{
+        {Vector3{0.0f, 0.0f, 0.0f}, Vector3{0.0f, 1.0f, 2.0f}, Vector3{1.0f, 1.0f, -1.0f}, Vector3{1.0f, 0.0f, 0.5f}},
+        {Vector3{1.0f, 0.0f, 0.5f}, Vector3{3.0f, -2.0f, 0.0f}, Vector3{2.0f, 1.0f, 1.0f}, Vector3{5.0f, 5.0f, 5.0f}}
+    };
+
+    UnsignedInt offsets[3];
+    const UnsignedInt vertexCount = flattenCurvesOffsetsInto(curves, 0.01f, offsets);
+    Containers::Array<Vector3> positions{Containers::NoInit, vertexCount};
+    flattenCurvesInto(curves, offsets, positions);
+
+    for(std::size_t i = 0; i != Containers::arraySize(curves); ++i) {
+        CORRADE_ITERATION(i);
+        const UnsignedInt count = offsets[i + 1] - offsets[i];
+        for(UnsignedInt j = 0; j != count; ++j) {
+            CORRADE_ITERATION(j);
+            CORRADE_COMPARE(positions[offsets[i] + j], curves[i].value(Float(j)/(count - 1)));
+        }
+    }
+
+    /* The curves share an endpoint, which should be exactly the same */
+    CORRADE_VERIFY(positions[offsets[1] - 1] == positions[offsets[1]]);
+}
+
+void FlattenCurvesTest::flattenStrided() {
+    struct Curve {
+        Int padding;
+        CubicBezier2D curve;
+        UnsignedInt offset;
+    } curves[3];
+    for(std::size_t i = 0; i != 3; ++i)
+        curves[i].curve = Curves[i];
+    UnsignedInt offsets[4];
+    flattenCurvesOffsetsInto(Curves, 0.01f, offsets);
+    for(std::size_t i = 0; i != 3; ++i)
+        curves[i].offset = offsets[i];
+
+    Containers::Array<Vector2> expected{Containers::NoInit, offsets[3]};
+    flattenCurvesInto(Curves, offsets, expected);
+
+    struct Vertex {
+        Vector2 position;
+        Float padding;
+    };
+    Containers::Array<Vertex> vertices{Containers::NoInit, offsets[3]};
+    /* The last offset isn't part of the struct, so it goes through a copy */
+    UnsignedInt offsetsCopy[4]{curves[0].offset, curves[1].offset, curves[2].offset, offsets[3]};
+    const Containers::StridedArrayView1D<Vector2> positions = Containers::stridedArrayView(vertices).slice(&Vertex::position);
+    flattenCurvesInto(Containers::stridedArrayView(curves).slice(&Curve::curve), offsetsCopy, positions);
+    CORRADE_COMPARE_AS(positions, Containers::stridedArrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void FlattenCurvesTest::flattenTolerance() {
+    auto&& data = ToleranceData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    UnsignedInt offsets[4];
+    const UnsignedInt vertexCount = flattenCurvesOffsetsInto(Curves, data.tolerance, offsets);
+    Containers::Array<Vector2> positions{Containers::NoInit, vertexCount};
+    flattenCurvesInto(Curves, offsets, positions);
+
+    /* Sample each curve densely and verify all samples are within tolerance
+       of the corresponding polyline segment */
+    for(std::size_t i = 0; i != Containers::arraySize(Curves); ++i) {
+        CORRADE_ITERATION(i);
+        const UnsignedInt segmentCount = offsets[i + 1] - offsets[i] - 1;
+        Float maxDistance = 0.0f;
+        for(UnsignedInt j = 0; j != segmentCount; ++j) {
+            const Vector2 a = positions[offsets[i] + j];
+            const Vector2 b = positions[offsets[i] + j + 1];
+            for(UnsignedInt k = 1; k != 16; ++k) {
+                const Vector2 point = Curves[i].value((j + k/16.0f)/segmentCount);
+                maxDistance = Math::max(maxDistance, Math::Distance::lineSegmentPoint(a, b, point));
+            }
+        }
+        CORRADE_COMPARE_AS(maxDistance, data.tolerance,
+            TestSuite::Compare::LessOrEqual);
+    }
+}
+
+void FlattenCurvesTest::flattenThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Enough curves to be split among several threads */
+    constexpr std::size_t CurveCount = 1000;
+    Containers::Array<CubicBezier2D> curves{Containers::NoInit, CurveCount};
+    for(std::size_t i = 0; i != CurveCount; ++i)
+        curves[i] = {Vector2{Float(i), 0.0f}, Vector2{Float(i) + Float(i%7)*0.25f, 1.0f}, Vector2{Float(i) + 1.0f, Float(i%3)}, Vector2{Float(i) + 1.0f, 0.0f}};
+
+    Containers::Array<UnsignedInt> offsets{Containers::NoInit, CurveCount + 1};
+    const UnsignedInt vertexCount = flattenCurvesOffsetsInto(curves, 0.001f, offsets);
+    CORRADE_COMPARE_AS(vertexCount, 4096,
+        TestSuite::Compare::Greater);
+
+    Containers::Array<Vector2> expected{Containers::NoInit, vertexCount};
+    flattenCurvesInto(curves, offsets, expected);
+
+    /* The output should be exactly the same independently of the thread
+       count */
+    Containers::Array<Vector2> positions{Containers::NoInit, vertexCount};
+    flattenCurvesInto(curves, offsets, positions, data.threadCount);
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(positions[i] == expected[i]);
+    }
+}
+
+void FlattenCurvesTest::mesh() {
+    Trade::MeshData mesh = flattenCurves(Containers::arrayView(Curves).prefix(2), 0.01f);
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Lines);
+    CORRADE_VERIFY(mesh.isIndexed());
+    CORRADE_COMPARE(mesh.indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(mesh.vertexCount(), 14);
+    CORRADE_COMPARE(mesh.attributeCount(), 1);
+    CORRADE_COMPARE(mesh.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector2);
+
+    /* One segment for the line, 11 for the arch, with no segment connecting
+       the two curves */
+    CORRADE_COMPARE(mesh.indexCount(), 24);
+    CORRADE_COMPARE_AS(mesh.indices<UnsignedInt>().prefix(6), Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 3, 3, 4
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.indices<UnsignedInt>().suffix(22), Containers::arrayView<UnsignedInt>({
+        12, 13
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(mesh.attribute<Vector2>(Trade::MeshAttribute::Position)[0], Curves[0][0]);
+    CORRADE_COMPARE(mesh.attribute<Vector2>(Trade::MeshAttribute::Position)[1], Curves[0][3]);
+    CORRADE_COMPARE(mesh.attribute<Vector2>(Trade::MeshAttribute::Position)[13], Curves[1][3]);
+}
+
+void FlattenCurvesTest::mesh3D() {
+    const CubicBezier3D curves[]{
+        {Vector3{0.0f, 0.0f, 0.0f}, Vector3{1.0f, 0.0f, 0.0f}, Vector3{2.0f, 0.0f, 0.0f}, Vector3{3.0f, 0.0f, 0.0f}}
+    };
+
+    Trade::MeshData mesh = flattenCurves(curves, 0.01f);
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(mesh.vertexCount(), 2);
+    CORRADE_COMPARE(mesh.indexCount(), 2);
+    CORRADE_COMPARE(mesh.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3);
+    CORRADE_COMPARE_AS(mesh.attribute<Vector3>(Trade::MeshAttribute::Position), Containers::arrayView<Vector3>({
+        {0.0f, 0.0f, 0.0f},
+        {3.0f, 0.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void FlattenCurvesTest::meshSpline() {
+    const CubicHermite2D spline[]{
+        {Vector2{0.0f, 0.0f}, Vector2{0.0f, 0.0f}, Vector2{0.0f, 3.0f}},
+        {Vector2{3.0f, 0.0f}, Vector2{1.0f, 0.0f}, Vector2{1.0f, 2.0f}},
+        {Vector2{1.0f, 1.0f}, Vector2{2.0f, 2.0f}, Vector2{0.0f, 0.0f}}
+    };
+
+    const CubicBezier2D curves[]{
+        CubicBezier2D::fromCubicHermite(spline[0], spline[1]),
+        CubicBezier2D::fromCubicHermite(spline[1], spline[2])
+    };
+
+    Trade::MeshData mesh = flattenCurves(spline, 0.01f);
+    Trade::MeshData expected = flattenCurves(curves, 0.01f);
+    CORRADE_COMPARE(mesh.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(mesh.indices<UnsignedInt>(),
+        expected.indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh.attribute<Vector2>(Trade::MeshAttribute::Position),
+        expected.attribute<Vector2>(Trade::MeshAttribute::Position),
+        TestSuite::Compare::Container);
+
+    /* The spline passes through the points */
+    CORRADE_COMPARE(mesh.attribute<Vector2>(Trade::MeshAttribute::Position)[0], spline[0].point());
+    CORRADE_COMPARE(mesh.attribute<Vector2>(Trade::MeshAttribute::Position)[mesh.vertexCount() - 1], spline[2].point());
+}
+
+void FlattenCurvesTest::offsetsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt offsets[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattenCurvesOffsetsInto(Curves, 0.01f, Containers::arrayView(offsets).prefix(3));
+    flattenCurvesOffsetsInto(Curves, 0.0f, offsets);
+    flattenCurvesOffsetsInto(Curves, 0.01f, offsets, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::flattenCurvesOffsetsInto(): expected 4 offsets but got 3\n"
+        "MeshTools::flattenCurvesOffsetsInto(): expected positive tolerance and max segment count but got 0 and 256\n"
+        "MeshTools::flattenCurvesOffsetsInto(): expected positive tolerance and max segment count but got 0.01 and 0\n");
+}
+
+void FlattenCurvesTest::flattenInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt offsets[]{0, 2, 14, 20};
+    const UnsignedInt offsetsTooFew[]{0, 2, 3, 20};
+    const UnsignedInt offsetsDecreasing[]{0, 2, 1, 20};
+    Vector2 positions[20];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattenCurvesInto(Curves, Containers::arrayView(offsets).prefix(3), positions);
+    flattenCurvesInto(Curves, offsets, Containers::arrayView(positions).prefix(19));
+    flattenCurvesInto(Curves, offsetsTooFew, positions);
+    flattenCurvesInto(Curves, offsetsDecreasing, positions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::flattenCurvesInto(): expected 4 offsets but got 3\n"
+        "MeshTools::flattenCurvesInto(): expected 20 positions but got 19\n"
+        "MeshTools::flattenCurvesInto(): expected at least two vertices for curve 1 but got offsets 2 and 3\n"
+        "MeshTools::flattenCurvesInto(): expected at least two vertices for curve 1 but got offsets 2 and 1\n");
+}
+
+void FlattenCurvesTest::meshSplineInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const CubicHermite3D spline[1]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattenCurves(spline, 0.01f);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::flattenCurves(): expected at least two spline points but got 1\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::FlattenCurvesTest)
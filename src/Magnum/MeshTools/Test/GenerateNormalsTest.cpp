@@ -37,6 +37,7 @@
 #include "Magnum/MeshTools/Duplicate.h"
 #include "Magnum/MeshTools/GenerateNormals.h"
 #include "Magnum/Primitives/Cylinder.h"
+#include "Magnum/Primitives/UVSphere.h"
 #include "Magnum/Trade/MeshData.h"
 
 namespace Magnum { namespace MeshTools { namespace Test { namespace {
@@ -65,8 +66,36 @@ struct GenerateNormalsTest: TestSuite::Tester {
     void smoothErasedNonContiguous();
     void smoothErasedWrongIndexSize();
 
+    void adjacencyConstructDefault();
+    void adjacencyConstruct();
+    void adjacencyConstructInvalid();
+
+    template<class T> void adjacencyGenerate();
+    void adjacencyGenerateErased();
+    void adjacencyGenerateWrongCount();
+    void adjacencyGenerateOutOfBounds();
+    void adjacencyGenerateErasedNonContiguous();
+    void adjacencyGenerateErasedWrongIndexSize();
+
+    template<class T> void smoothAdjacency();
+    void smoothAdjacencyErased();
+    void smoothAdjacencyThreaded();
+    void smoothAdjacencyMismatch();
+    void smoothAdjacencyIntoWrongSize();
+
     void benchmarkFlat();
     void benchmarkSmooth();
+    void benchmarkSmoothAdjacency();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
 };
 
 GenerateNormalsTest::GenerateNormalsTest() {
@@ -93,10 +122,35 @@ GenerateNormalsTest::GenerateNormalsTest() {
               &GenerateNormalsTest::smoothErased<UnsignedShort>,
               &GenerateNormalsTest::smoothErased<UnsignedInt>,
               &GenerateNormalsTest::smoothErasedNonContiguous,
-              &GenerateNormalsTest::smoothErasedWrongIndexSize});
+              &GenerateNormalsTest::smoothErasedWrongIndexSize,
+
+              &GenerateNormalsTest::adjacencyConstructDefault,
+              &GenerateNormalsTest::adjacencyConstruct,
+              &GenerateNormalsTest::adjacencyConstructInvalid,
+
+              &GenerateNormalsTest::adjacencyGenerate<UnsignedByte>,
+              &GenerateNormalsTest::adjacencyGenerate<UnsignedShort>,
+              &GenerateNormalsTest::adjacencyGenerate<UnsignedInt>,
+              &GenerateNormalsTest::adjacencyGenerateErased,
+              &GenerateNormalsTest::adjacencyGenerateWrongCount,
+              &GenerateNormalsTest::adjacencyGenerateOutOfBounds,
+              &GenerateNormalsTest::adjacencyGenerateErasedNonContiguous,
+              &GenerateNormalsTest::adjacencyGenerateErasedWrongIndexSize,
+
+              &GenerateNormalsTest::smoothAdjacency<UnsignedByte>,
+              &GenerateNormalsTest::smoothAdjacency<UnsignedShort>,
+              &GenerateNormalsTest::smoothAdjacency<UnsignedInt>,
+              &GenerateNormalsTest::smoothAdjacencyErased});
+
+    addInstancedTests({&GenerateNormalsTest::smoothAdjacencyThreaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&GenerateNormalsTest::smoothAdjacencyMismatch,
+              &GenerateNormalsTest::smoothAdjacencyIntoWrongSize});
 
     addBenchmarks({&GenerateNormalsTest::benchmarkFlat,
-                   &GenerateNormalsTest::benchmarkSmooth}, 150);
+                   &GenerateNormalsTest::benchmarkSmooth,
+                   &GenerateNormalsTest::benchmarkSmoothAdjacency}, 150);
 }
 
 /* Two vertices connected by one edge, each wound in another direction */
@@ -456,6 +510,17 @@ void GenerateNormalsTest::benchmarkSmooth() {
     CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
 }
 
+void GenerateNormalsTest::benchmarkSmoothAdjacency() {
+    const VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(BeveledCubeIndices, Containers::arraySize(BeveledCubePositions));
+
+    Containers::Array<Vector3> normals{Containers::NoInit, Containers::arraySize(BeveledCubePositions)};
+    CORRADE_BENCHMARK(10) {
+        generateSmoothNormalsInto(adjacency, BeveledCubeIndices, BeveledCubePositions, normals);
+    }
+
+    CORRADE_COMPARE(Math::min(normals), (Vector3{-0.996072f, -0.997808f, -0.996072f}));
+}
+
 template<class T> void GenerateNormalsTest::smoothErased() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -503,6 +568,231 @@ void GenerateNormalsTest::smoothErasedWrongIndexSize() {
         "MeshTools::generateSmoothNormalsInto(): expected index type size 1, 2 or 4 but got 3\n");
 }
 
+
+void GenerateNormalsTest::adjacencyConstructDefault() {
+    VertexTriangleAdjacency adjacency;
+    CORRADE_COMPARE(adjacency.vertexCount(), 0);
+    CORRADE_COMPARE(adjacency.indexCount(), 0);
+    CORRADE_COMPARE_AS(adjacency.offsets(),
+        Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+    CORRADE_VERIFY(adjacency.corners().empty());
+}
+
+void GenerateNormalsTest::adjacencyConstruct() {
+    Containers::Array<UnsignedInt> offsets{Containers::InPlaceInit, {0, 1, 3}};
+    Containers::Array<UnsignedInt> corners{Containers::InPlaceInit, {2, 0, 1}};
+    const UnsignedInt* offsetsData = offsets.data();
+    const UnsignedInt* cornersData = corners.data();
+
+    VertexTriangleAdjacency adjacency{std::move(offsets), std::move(corners)};
+    CORRADE_COMPARE(adjacency.vertexCount(), 2);
+    CORRADE_COMPARE(adjacency.indexCount(), 3);
+    CORRADE_COMPARE(adjacency.offsets().data(), offsetsData);
+    CORRADE_COMPARE(adjacency.corners().data(), cornersData);
+}
+
+void GenerateNormalsTest::adjacencyConstructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+    VertexTriangleAdjacency{{}, Containers::Array<UnsignedInt>{3}};
+    VertexTriangleAdjacency{Containers::Array<UnsignedInt>{Containers::InPlaceInit, {0, 2}}, Containers::Array<UnsignedInt>{3}};
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::VertexTriangleAdjacency: expected a non-empty offset array ending with 3\n"
+        "MeshTools::VertexTriangleAdjacency: expected a non-empty offset array ending with 3\n");
+}
+
+/* Vertex 4 is not referenced by any triangle, vertex 1 is referenced twice by
+   the last (degenerate) triangle */
+constexpr UnsignedInt AdjacencyIndices[]{
+    0, 1, 2,
+    2, 1, 3,
+    3, 1, 1
+};
+
+template<class T> void GenerateNormalsTest::adjacencyGenerate() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(AdjacencyIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(indices); ++i)
+        indices[i] = AdjacencyIndices[i];
+
+    VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(indices, 5);
+    CORRADE_COMPARE(adjacency.vertexCount(), 5);
+    CORRADE_COMPARE(adjacency.indexCount(), 9);
+    CORRADE_COMPARE_AS(adjacency.offsets(),
+        Containers::arrayView<UnsignedInt>({0, 1, 5, 7, 9, 9}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(adjacency.corners(),
+        Containers::arrayView<UnsignedInt>({
+            0,          /* vertex 0 */
+            1, 4, 7, 8, /* vertex 1 */
+            2, 3,       /* vertex 2 */
+            5, 6        /* vertex 3 */
+                        /* vertex 4 */
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::adjacencyGenerateErased() {
+    const UnsignedShort indices[]{0, 1, 2, 2, 1, 3};
+
+    VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)), 4);
+    CORRADE_COMPARE_AS(adjacency.offsets(),
+        Containers::arrayView<UnsignedInt>({0, 1, 3, 5, 6}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(adjacency.corners(),
+        Containers::arrayView<UnsignedInt>({0, 1, 4, 2, 3, 5}),
+        TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::adjacencyGenerateWrongCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    const UnsignedByte indices[7]{};
+    generateVertexTriangleAdjacency(indices, 1);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateVertexTriangleAdjacency(): index count not divisible by 3\n");
+}
+
+void GenerateNormalsTest::adjacencyGenerateOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    const UnsignedInt indices[] { 0, 1, 2 };
+    generateVertexTriangleAdjacency(indices, 2);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateVertexTriangleAdjacency(): index 2 out of bounds for 2 elements\n");
+}
+
+void GenerateNormalsTest::adjacencyGenerateErasedNonContiguous() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateVertexTriangleAdjacency(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateVertexTriangleAdjacency(): second index view dimension is not contiguous\n");
+}
+
+void GenerateNormalsTest::adjacencyGenerateErasedWrongIndexSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateVertexTriangleAdjacency(Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), 3);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateVertexTriangleAdjacency(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+template<class T> void GenerateNormalsTest::smoothAdjacency() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(BeveledCubeIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(indices); ++i)
+        indices[i] = BeveledCubeIndices[i];
+
+    const VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(indices, Containers::arraySize(BeveledCubePositions));
+
+    /* Should give the same result as without the adjacency. Calling it twice
+       to verify the adjacency is reusable. */
+    Containers::Array<Vector3> expected = generateSmoothNormals(indices, BeveledCubePositions);
+    CORRADE_COMPARE_AS(generateSmoothNormals(adjacency, indices, BeveledCubePositions),
+        expected, TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(generateSmoothNormals(adjacency, indices, BeveledCubePositions),
+        expected, TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothAdjacencyErased() {
+    const UnsignedShort indices[]{0, 1, 2, 3, 4, 5};
+    const Containers::StridedArrayView2D<const char> erased = Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices));
+
+    /* Should generate the same output as flat normals */
+    CORRADE_COMPARE_AS(generateSmoothNormals(generateVertexTriangleAdjacency(erased, 6), erased, TwoTriangles),
+        Containers::arrayView<Vector3>({
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis(),
+            -Vector3::zAxis()
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateNormalsTest::smoothAdjacencyThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split among several threads */
+    const Trade::MeshData sphere = Primitives::uvSphereSolid(100, 200);
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    CORRADE_VERIFY(sphere.indexCount()/3 > 4*1024);
+
+    const VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(sphere.indices(), positions.size());
+    Containers::Array<Vector3> normals{Containers::NoInit, positions.size()};
+    generateSmoothNormalsInto(adjacency, sphere.indices(), positions, normals, data.threadCount);
+
+    /* The output should be exactly the same as single-threaded, independently
+       of the thread count */
+    Containers::Array<Vector3> expected = generateSmoothNormals(sphere.indices(), positions);
+    for(std::size_t i = 0; i != normals.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(normals[i] == expected[i]);
+    }
+}
+
+void GenerateNormalsTest::smoothAdjacencyMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedByte indices[6]{};
+    const Vector3 positions[3];
+    const VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(Containers::arrayView(indices).prefix(3), 3);
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateSmoothNormals(adjacency, indices, positions);
+    generateSmoothNormals(adjacency, Containers::arrayView(indices).prefix(3), Containers::arrayView(positions).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateSmoothNormalsInto(): adjacency calculated for 3 vertices and 3 indices but got 3 positions and 6 indices\n"
+        "MeshTools::generateSmoothNormalsInto(): adjacency calculated for 3 vertices and 3 indices but got 2 positions and 3 indices\n");
+}
+
+void GenerateNormalsTest::smoothAdjacencyIntoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedByte indices[6]{};
+    const Vector3 positions[3];
+    Vector3 normals[4];
+    const VertexTriangleAdjacency adjacency = generateVertexTriangleAdjacency(indices, 3);
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateSmoothNormalsInto(adjacency, indices, positions, normals);
+    CORRADE_COMPARE(out.str(), "MeshTools::generateSmoothNormalsInto(): bad output size, expected 3 but got 4\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateNormalsTest)
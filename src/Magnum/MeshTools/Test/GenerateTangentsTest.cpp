@@ -0,0 +1,429 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/MeshTools/GenerateTangents.h"
+#include "Magnum/Primitives/UVSphere.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct GenerateTangentsTest: TestSuite::Tester {
+    explicit GenerateTangentsTest();
+
+    template<class T> void twoTriangles();
+    void mirrored();
+    void nonIndexed();
+    void weld();
+    void zeroAreaTextureCoordinates();
+    template<class T> void erased();
+    void threaded();
+
+    void wrongCount();
+    void nonIndexedWrongCount();
+    void outOfBounds();
+    void attributeSizeMismatch();
+    void intoWrongSize();
+    void erasedNonContiguous();
+    void erasedWrongIndexSize();
+
+    void benchmark();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
+};
+
+GenerateTangentsTest::GenerateTangentsTest() {
+    addTests({&GenerateTangentsTest::twoTriangles<UnsignedByte>,
+              &GenerateTangentsTest::twoTriangles<UnsignedShort>,
+              &GenerateTangentsTest::twoTriangles<UnsignedInt>,
+              &GenerateTangentsTest::mirrored,
+              &GenerateTangentsTest::nonIndexed,
+              &GenerateTangentsTest::weld,
+              &GenerateTangentsTest::zeroAreaTextureCoordinates,
+              &GenerateTangentsTest::erased<UnsignedByte>,
+              &GenerateTangentsTest::erased<UnsignedShort>,
+              &GenerateTangentsTest::erased<UnsignedInt>});
+
+    addInstancedTests({&GenerateTangentsTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&GenerateTangentsTest::wrongCount,
+              &GenerateTangentsTest::nonIndexedWrongCount,
+              &GenerateTangentsTest::outOfBounds,
+              &GenerateTangentsTest::attributeSizeMismatch,
+              &GenerateTangentsTest::intoWrongSize,
+              &GenerateTangentsTest::erasedNonContiguous,
+              &GenerateTangentsTest::erasedWrongIndexSize});
+
+    addBenchmarks({&GenerateTangentsTest::benchmark}, 150);
+}
+
+/* A quad in the XY plane facing +Z, with texture coordinates matching the XY
+   coordinates */
+const Vector3 QuadPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+const Vector3 QuadNormals[]{
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis(),
+    Vector3::zAxis()
+};
+const Vector2 QuadTextureCoordinates[]{
+    {0.0f, 0.0f},
+    {1.0f, 0.0f},
+    {1.0f, 1.0f},
+    {0.0f, 1.0f}
+};
+
+template<class T> void GenerateTangentsTest::twoTriangles() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 0, 2, 3};
+
+    CORRADE_COMPARE_AS(generateTangents(
+        Containers::stridedArrayView(indices), QuadPositions, QuadNormals,
+        QuadTextureCoordinates),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::mirrored() {
+    const UnsignedInt indices[]{0, 1, 2, 0, 2, 3};
+
+    /* U is flipped, so the tangent points to -X and the bitangent is on the
+       other side than cross(normal, tangent) */
+    const Vector2 textureCoordinates[]{
+        {1.0f, 0.0f},
+        {0.0f, 0.0f},
+        {0.0f, 1.0f},
+        {1.0f, 1.0f}
+    };
+
+    CORRADE_COMPARE_AS(generateTangents(
+        Containers::stridedArrayView(indices), QuadPositions, QuadNormals,
+        textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f},
+            {-1.0f, 0.0f, 0.0f, -1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::nonIndexed() {
+    const Vector3 positions[]{
+        QuadPositions[0], QuadPositions[1], QuadPositions[2],
+        QuadPositions[0], QuadPositions[2], QuadPositions[3]
+    };
+    const Vector2 textureCoordinates[]{
+        QuadTextureCoordinates[0], QuadTextureCoordinates[1],
+        QuadTextureCoordinates[2], QuadTextureCoordinates[0],
+        QuadTextureCoordinates[2], QuadTextureCoordinates[3]
+    };
+    const Vector3 normals[6]{
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(),
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+    };
+
+    CORRADE_COMPARE_AS(generateTangents(positions, normals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::weld() {
+    /* Two non-indexed triangles sharing the origin and the [0, 1, 0] vertex,
+       the second has texture coordinates rotated so its tangent points to
+       +Y. The origin has the same texture coordinates in both, the other
+       shared vertex doesn't, so it's a seam. */
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+
+        {0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f}
+    };
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f},
+
+        {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {0.0f, 1.0f}
+    };
+    const Vector3 normals[6]{
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis(),
+        Vector3::zAxis(), Vector3::zAxis(), Vector3::zAxis()
+    };
+
+    /* Without welding each triangle has its own tangents */
+    CORRADE_COMPARE_AS(generateTangents(positions, normals, textureCoordinates),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+
+            {0.0f, 1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+
+    /* With welding the origin gets an average of both, the seam stays */
+    const Vector4 average{Constants::sqrtHalf(), Constants::sqrtHalf(), 0.0f, 1.0f};
+    CORRADE_COMPARE_AS(generateTangents(positions, normals, textureCoordinates,
+        GenerateTangentsFlag::WeldVertices),
+        Containers::arrayView<Vector4>({
+            average,
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+
+            average,
+            {0.0f, 1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::zeroAreaTextureCoordinates() {
+    const UnsignedInt indices[]{0, 1, 2, 0, 2, 3};
+    const Vector2 textureCoordinates[4]{};
+
+    /* All triangles are ignored, so an arbitrary direction perpendicular to
+       the normal is picked */
+    Containers::Array<Vector4> tangents = generateTangents(
+        Containers::stridedArrayView(indices), QuadPositions, QuadNormals,
+        textureCoordinates);
+    CORRADE_COMPARE(tangents.size(), 4);
+    for(const Vector4& tangent: tangents) {
+        CORRADE_ITERATION(&tangent - tangents.begin());
+        CORRADE_VERIFY(tangent.xyz().isNormalized());
+        CORRADE_COMPARE(Math::dot(tangent.xyz(), Vector3::zAxis()), 0.0f);
+        CORRADE_COMPARE(tangent.w(), 1.0f);
+    }
+}
+
+template<class T> void GenerateTangentsTest::erased() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const T indices[]{0, 1, 2, 0, 2, 3};
+
+    CORRADE_COMPARE_AS(generateTangents(
+        Containers::arrayCast<2, const char>(Containers::stridedArrayView(indices)),
+        QuadPositions, QuadNormals, QuadTextureCoordinates),
+        Containers::arrayView<Vector4>({
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 0.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void GenerateTangentsTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split among several threads */
+    const Trade::MeshData sphere = Primitives::uvSphereSolid(100, 200,
+        Primitives::UVSphereFlag::TextureCoordinates);
+    CORRADE_VERIFY(sphere.indexCount()/3 > 4*1024);
+    const Containers::StridedArrayView1D<const Vector3> positions = sphere.attribute<Vector3>(Trade::MeshAttribute::Position);
+    const Containers::StridedArrayView1D<const Vector3> normals = sphere.attribute<Vector3>(Trade::MeshAttribute::Normal);
+    const Containers::StridedArrayView1D<const Vector2> textureCoordinates = sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates);
+
+    /* The result should be the same independently of the thread count */
+    const Containers::Array<Vector4> expected = generateTangents(
+        sphere.indices(), positions, normals, textureCoordinates);
+    Containers::Array<Vector4> tangents{Containers::NoInit, positions.size()};
+    generateTangentsInto(sphere.indices(), positions, normals,
+        textureCoordinates, tangents, {}, data.threadCount);
+    CORRADE_COMPARE_AS(tangents, expected, TestSuite::Compare::Container);
+
+    /* And it should form a right-handed basis with the normals, as the
+       texture coordinates are not mirrored anywhere. Except for the poles,
+       where directions of all adjacent faces cancel each other out and the
+       handedness is thus arbitrary. */
+    for(std::size_t i = 0; i != tangents.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(tangents[i].xyz().isNormalized());
+        CORRADE_COMPARE(Math::dot(tangents[i].xyz(), normals[i]), 0.0f);
+        if(Math::abs(normals[i].y()) == 1.0f) continue;
+        CORRADE_COMPARE(tangents[i].w(), 1.0f);
+    }
+}
+
+void GenerateTangentsTest::wrongCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedByte indices[7]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::stridedArrayView(indices), QuadPositions,
+        QuadNormals, QuadTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): index count not divisible by 3\n");
+}
+
+void GenerateTangentsTest::nonIndexedWrongCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(QuadPositions, QuadNormals, QuadTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): vertex count not divisible by 3\n");
+}
+
+void GenerateTangentsTest::outOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 2, 3, 4, 0};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::stridedArrayView(indices), QuadPositions,
+        QuadNormals, QuadTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): index 4 out of bounds for 4 elements\n");
+}
+
+void GenerateTangentsTest::attributeSizeMismatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 2};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::stridedArrayView(indices), QuadPositions,
+        Containers::arrayView(QuadNormals).prefix(3), QuadTextureCoordinates);
+    generateTangents(Containers::stridedArrayView(indices), QuadPositions,
+        QuadNormals, Containers::arrayView(QuadTextureCoordinates).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): expected 4 normals and texture coordinates but got 3 and 4\n"
+        "MeshTools::generateTangentsInto(): expected 4 normals and texture coordinates but got 4 and 2\n");
+}
+
+void GenerateTangentsTest::intoWrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 2};
+    Vector4 tangents[5];
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangentsInto(Containers::stridedArrayView(indices), QuadPositions,
+        QuadNormals, QuadTextureCoordinates, tangents);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): bad output size, expected 4 but got 5\n");
+}
+
+void GenerateTangentsTest::erasedNonContiguous() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char indices[6*4]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::StridedArrayView2D<const char>{indices, {6, 2}, {4, 2}}, QuadPositions, QuadNormals, QuadTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): second index view dimension is not contiguous\n");
+}
+
+void GenerateTangentsTest::erasedWrongIndexSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char indices[6*3]{};
+
+    std::stringstream out;
+    Error redirectError{&out};
+    generateTangents(Containers::StridedArrayView2D<const char>{indices, {6, 3}}.every(2), QuadPositions, QuadNormals, QuadTextureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateTangentsInto(): expected index type size 1, 2 or 4 but got 3\n");
+}
+
+void GenerateTangentsTest::benchmark() {
+    const Trade::MeshData sphere = Primitives::uvSphereSolid(16, 32,
+        Primitives::UVSphereFlag::TextureCoordinates);
+
+    Containers::Array<Vector4> tangents{Containers::NoInit, sphere.vertexCount()};
+    CORRADE_BENCHMARK(10) {
+        generateTangentsInto(sphere.indices(),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Position),
+            sphere.attribute<Vector3>(Trade::MeshAttribute::Normal),
+            sphere.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+            tangents);
+    }
+
+    CORRADE_COMPARE(Math::dot(tangents[tangents.size()/2].xyz(), sphere.attribute<Vector3>(Trade::MeshAttribute::Normal)[tangents.size()/2]), 0.0f);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::GenerateTangentsTest)
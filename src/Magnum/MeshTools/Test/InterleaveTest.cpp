@@ -81,6 +81,7 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void interleavedLayoutAlreadyInterleavedExtra();
     void interleavedLayoutNothing();
     void interleavedLayoutRvalue();
+    void interleavedLayoutSplitPositions();
 
     void interleaveMeshData();
     void interleaveMeshDataIndexed();
@@ -92,6 +93,8 @@ struct InterleaveTest: Corrade::TestSuite::Tester {
     void interleaveMeshDataAlreadyInterleavedMove();
     void interleaveMeshDataAlreadyInterleavedMoveNonOwned();
     void interleaveMeshDataNothing();
+    void interleaveMeshDataSplitPositions();
+    void interleaveMeshDataSplitPositionsNoPositions();
 };
 
 InterleaveTest::InterleaveTest() {
@@ -135,6 +138,7 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::interleavedLayoutAlreadyInterleavedExtra,
               &InterleaveTest::interleavedLayoutNothing,
               &InterleaveTest::interleavedLayoutRvalue,
+              &InterleaveTest::interleavedLayoutSplitPositions,
 
               &InterleaveTest::interleaveMeshData,
               &InterleaveTest::interleaveMeshDataIndexed,
@@ -145,7 +149,9 @@ InterleaveTest::InterleaveTest() {
               &InterleaveTest::interleaveMeshDataExtraOffsetOnly,
               &InterleaveTest::interleaveMeshDataAlreadyInterleavedMove,
               &InterleaveTest::interleaveMeshDataAlreadyInterleavedMoveNonOwned,
-              &InterleaveTest::interleaveMeshDataNothing});
+              &InterleaveTest::interleaveMeshDataNothing,
+              &InterleaveTest::interleaveMeshDataSplitPositions,
+              &InterleaveTest::interleaveMeshDataSplitPositionsNoPositions});
 }
 
 void InterleaveTest::attributeCount() {
@@ -966,6 +972,48 @@ void InterleaveTest::interleavedLayoutRvalue() {
     CORRADE_COMPARE(layout.vertexData().size(), 10*20);
 }
 
+void InterleaveTest::interleavedLayoutSplitPositions() {
+    Containers::Array<char> vertexData{3*20};
+    Trade::MeshAttributeData positions{Trade::MeshAttribute::Position,
+        Containers::arrayCast<Vector2>(vertexData.prefix(3*8))};
+    Trade::MeshAttributeData normals{Trade::MeshAttribute::Normal,
+        Containers::arrayCast<Vector3>(vertexData.suffix(3*8))};
+
+    Trade::MeshData data{MeshPrimitive::Triangles,
+        std::move(vertexData), {positions, normals}};
+
+    Trade::MeshData layout = MeshTools::interleavedLayout(data, 7, {
+        Trade::MeshAttributeData{1},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(15),
+            VertexFormat::UnsignedByte, nullptr, 6},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Color,
+            VertexFormat::Vector3, nullptr}
+    }, InterleaveFlag::SplitPositions);
+    /* Two streams with a different stride */
+    CORRADE_VERIFY(!MeshTools::isInterleaved(layout));
+    CORRADE_COMPARE(layout.attributeCount(), 4);
+    CORRADE_COMPARE(layout.attributeName(0), Trade::MeshAttribute::Position);
+    CORRADE_COMPARE(layout.attributeName(1), Trade::MeshAttribute::Normal);
+    CORRADE_COMPARE(layout.attributeName(2), Trade::meshAttributeCustom(15));
+    CORRADE_COMPARE(layout.attributeName(3), Trade::MeshAttribute::Color);
+    CORRADE_COMPARE(layout.attributeFormat(0), VertexFormat::Vector2);
+    CORRADE_COMPARE(layout.attributeFormat(1), VertexFormat::Vector3);
+    CORRADE_COMPARE(layout.attributeFormat(2), VertexFormat::UnsignedByte);
+    CORRADE_COMPARE(layout.attributeFormat(3), VertexFormat::Vector3);
+    /* Positions tightly packed first, the rest interleaved after */
+    CORRADE_COMPARE(layout.attributeStride(0), 8);
+    CORRADE_COMPARE(layout.attributeStride(1), 31);
+    CORRADE_COMPARE(layout.attributeStride(2), 31);
+    CORRADE_COMPARE(layout.attributeStride(3), 31);
+    CORRADE_COMPARE(layout.attributeOffset(0), 0);
+    CORRADE_COMPARE(layout.attributeOffset(1), 7*8);
+    CORRADE_COMPARE(layout.attributeOffset(2), 7*8 + 13);
+    CORRADE_COMPARE(layout.attributeOffset(3), 7*8 + 19);
+    CORRADE_COMPARE(layout.attributeArraySize(2), 6);
+    CORRADE_COMPARE(layout.vertexCount(), 7);
+    CORRADE_COMPARE(layout.vertexData().size(), 7*(8 + 31));
+}
+
 void InterleaveTest::interleaveMeshData() {
     struct {
         Vector2 positions[3];
@@ -1201,6 +1249,78 @@ void InterleaveTest::interleaveMeshDataNothing() {
     CORRADE_COMPARE(interleaved.vertexData().size(), 0);
 }
 
+void InterleaveTest::interleaveMeshDataSplitPositions() {
+    Containers::Array<char> indexData{4};
+    auto indexView = Containers::arrayCast<UnsignedShort>(indexData);
+    indexView[0] = 2;
+    indexView[1] = 1;
+    Containers::Array<char> vertexData{3*24};
+    Containers::StridedArrayView1D<Vector2> positionView{vertexData,
+        reinterpret_cast<Vector2*>(vertexData.data()), 3, 24};
+    Containers::StridedArrayView1D<Vector3> normalView{vertexData,
+        reinterpret_cast<Vector3*>(vertexData.data() + 10), 3, 24};
+    positionView[0] = {1.3f, 0.3f};
+    positionView[1] = {0.87f, 1.1f};
+    positionView[2] = {1.0f, -0.5f};
+    normalView[0] = Vector3::xAxis();
+    normalView[1] = Vector3::yAxis();
+    normalView[2] = Vector3::zAxis();
+
+    Trade::MeshData data{MeshPrimitive::TriangleFan,
+        std::move(indexData), Trade::MeshIndexData{indexView},
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positionView},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normalView}
+        }};
+    CORRADE_VERIFY(MeshTools::isInterleaved(data));
+
+    /* Even though the data are interleaved and owned, they have to be copied
+       to a new layout */
+    Trade::MeshData interleaved = MeshTools::interleave(std::move(data), {}, InterleaveFlag::SplitPositions);
+    CORRADE_VERIFY(!MeshTools::isInterleaved(interleaved));
+    CORRADE_VERIFY(interleaved.vertexData().data() != positionView.data());
+    CORRADE_COMPARE(interleaved.primitive(), MeshPrimitive::TriangleFan);
+    CORRADE_COMPARE_AS(interleaved.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(interleaved.attributeCount(), 2);
+    CORRADE_COMPARE(interleaved.vertexCount(), 3);
+    CORRADE_COMPARE(interleaved.attributeStride(0), 8);
+    CORRADE_COMPARE(interleaved.attributeStride(1), 12);
+    CORRADE_COMPARE(interleaved.attributeOffset(0), 0);
+    CORRADE_COMPARE(interleaved.attributeOffset(1), 3*8);
+    CORRADE_COMPARE(interleaved.vertexData().size(), 3*(8 + 12));
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({{1.3f, 0.3f}, {0.87f, 1.1f}, {1.0f, -0.5f}}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::arrayView<Vector3>({Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()}),
+        TestSuite::Compare::Container);
+}
+
+void InterleaveTest::interleaveMeshDataSplitPositionsNoPositions() {
+    const Vector3 normals[]{Vector3::xAxis(), Vector3::yAxis(), Vector3::zAxis()};
+    const Vector2 textureCoordinates[]{{0.5f, 1.0f}, {0.0f, 0.25f}, {1.0f, 0.0f}};
+    Trade::MeshData data{MeshPrimitive::Points, 3};
+
+    /* With no positions there's just one stream, so it's interleaved */
+    Trade::MeshData interleaved = MeshTools::interleave(data, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::arrayView(normals)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, Containers::arrayView(textureCoordinates)}
+    }, InterleaveFlag::SplitPositions);
+    CORRADE_VERIFY(MeshTools::isInterleaved(interleaved));
+    CORRADE_COMPARE(interleaved.attributeStride(0), 20);
+    CORRADE_COMPARE(interleaved.attributeOffset(0), 0);
+    CORRADE_COMPARE(interleaved.attributeOffset(1), 12);
+    CORRADE_COMPARE(interleaved.vertexData().size(), 3*20);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector3>(Trade::MeshAttribute::Normal),
+        Containers::stridedArrayView(normals),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(interleaved.attribute<Vector2>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::stridedArrayView(textureCoordinates),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::InterleaveTest)
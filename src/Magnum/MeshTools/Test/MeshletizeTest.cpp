@@ -0,0 +1,332 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/Meshletize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct MeshletizeTest: TestSuite::Tester {
+    explicit MeshletizeTest();
+
+    template<class T> void meshletize();
+    void meshletizeGrid();
+    void meshletizeDegenerate();
+    void coneFlat();
+    void coneBackToBack();
+    void sphere();
+    void empty();
+    void invalid();
+
+    void meshData();
+    void meshDataInvalid();
+};
+
+MeshletizeTest::MeshletizeTest() {
+    addTests({&MeshletizeTest::meshletize<UnsignedByte>,
+              &MeshletizeTest::meshletize<UnsignedShort>,
+              &MeshletizeTest::meshletize<UnsignedInt>,
+              &MeshletizeTest::meshletizeGrid,
+              &MeshletizeTest::meshletizeDegenerate,
+              &MeshletizeTest::coneFlat,
+              &MeshletizeTest::coneBackToBack,
+              &MeshletizeTest::sphere,
+              &MeshletizeTest::empty,
+              &MeshletizeTest::invalid,
+
+              &MeshletizeTest::meshData,
+              &MeshletizeTest::meshDataInvalid});
+}
+
+/*
+    5-----6-----7-----8-----9
+    |    /|    /|    /|    /|
+    |  /  |  /  |  /  |  /  |
+    |/    |/    |/    |/    |
+    0-----1-----2-----3-----4
+*/
+const Vector3 StripPositions[]{
+    {0.0f, 0.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {2.0f, 0.0f, 0.0f},
+    {3.0f, 0.0f, 0.0f},
+    {4.0f, 0.0f, 0.0f},
+
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f},
+    {2.0f, 1.0f, 0.0f},
+    {3.0f, 1.0f, 0.0f},
+    {4.0f, 1.0f, 0.0f}
+};
+
+constexpr UnsignedInt StripIndices[]{
+    0, 1, 6, 0, 6, 5,
+    1, 2, 7, 1, 7, 6,
+    2, 3, 8, 2, 8, 7,
+    3, 4, 9, 3, 9, 8
+};
+
+template<class T> void MeshletizeTest::meshletize() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(StripIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(StripIndices); ++i)
+        indices[i] = StripIndices[i];
+
+    /* Two quads fit into the vertex limit, then the triangle limit is hit */
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions, 6, 4);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 2);
+
+    CORRADE_COMPARE(meshlets.meshlets()[0].vertexOffset, 0);
+    CORRADE_COMPARE(meshlets.meshlets()[0].vertexCount, 6);
+    CORRADE_COMPARE(meshlets.meshlets()[0].triangleOffset, 0);
+    CORRADE_COMPARE(meshlets.meshlets()[0].triangleCount, 4);
+    CORRADE_COMPARE(meshlets.meshlets()[1].vertexOffset, 6);
+    CORRADE_COMPARE(meshlets.meshlets()[1].vertexCount, 6);
+    CORRADE_COMPARE(meshlets.meshlets()[1].triangleOffset, 4);
+    CORRADE_COMPARE(meshlets.meshlets()[1].triangleCount, 4);
+
+    CORRADE_COMPARE_AS(meshlets.vertices(), Containers::arrayView<UnsignedInt>({
+        0, 1, 6, 5, 2, 7,
+        2, 3, 8, 7, 4, 9
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(meshlets.triangles(), Containers::arrayView<UnsignedByte>({
+        0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2,
+        0, 1, 2, 0, 2, 3, 1, 4, 5, 1, 5, 2
+    }), TestSuite::Compare::Container);
+
+    /* Triangles are in the original order */
+    CORRADE_COMPARE_AS(meshlets.indicesAsArray(),
+        Containers::arrayView(StripIndices),
+        TestSuite::Compare::Container);
+
+    /* Vertex limit gets hit first */
+    Meshlets meshletsVertexLimit = MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions, 4, 124);
+    CORRADE_COMPARE(meshletsVertexLimit.meshlets().size(), 4);
+    for(const Meshlet& meshlet: meshletsVertexLimit.meshlets()) {
+        CORRADE_ITERATION(&meshlet - meshletsVertexLimit.meshlets().begin());
+        CORRADE_COMPARE(meshlet.vertexCount, 4);
+        CORRADE_COMPARE(meshlet.triangleCount, 2);
+    }
+}
+
+void MeshletizeTest::meshletizeGrid() {
+    /* A 16x16 grid */
+    Containers::Array<Vector3> positions{Containers::NoInit, 17*17};
+    for(UnsignedInt y = 0; y != 17; ++y) for(UnsignedInt x = 0; x != 17; ++x)
+        positions[y*17 + x] = {Float(x), Float(y), 0.0f};
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 16*16*6};
+    for(UnsignedInt y = 0; y != 16; ++y) for(UnsignedInt x = 0; x != 16; ++x) {
+        const UnsignedInt a = y*17 + x, b = a + 1, c = a + 17, d = c + 1;
+        const UnsignedInt quad[]{a, b, d, a, d, c};
+        for(std::size_t i = 0; i != 6; ++i)
+            indices[(y*16 + x)*6 + i] = quad[i];
+    }
+
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(indices), positions, 32, 40);
+
+    /* All limits are respected, ranges are contiguous and local indices in
+       bounds */
+    UnsignedInt vertexOffset = 0, triangleOffset = 0;
+    for(const Meshlet& meshlet: meshlets.meshlets()) {
+        CORRADE_ITERATION(&meshlet - meshlets.meshlets().begin());
+        CORRADE_COMPARE(meshlet.vertexOffset, vertexOffset);
+        CORRADE_COMPARE(meshlet.triangleOffset, triangleOffset);
+        CORRADE_COMPARE_AS(meshlet.vertexCount, 32, TestSuite::Compare::LessOrEqual);
+        CORRADE_COMPARE_AS(meshlet.triangleCount, 40, TestSuite::Compare::LessOrEqual);
+        for(std::size_t i = 0; i != meshlet.triangleCount*3; ++i)
+            CORRADE_COMPARE_AS(UnsignedInt(meshlets.triangles()[meshlet.triangleOffset*3 + i]), meshlet.vertexCount, TestSuite::Compare::Less);
+        vertexOffset += meshlet.vertexCount;
+        triangleOffset += meshlet.triangleCount;
+    }
+    CORRADE_COMPARE(vertexOffset, meshlets.vertices().size());
+    CORRADE_COMPARE(triangleOffset*3, meshlets.triangles().size());
+
+    CORRADE_COMPARE_AS(meshlets.indicesAsArray(), indices,
+        TestSuite::Compare::Container);
+}
+
+void MeshletizeTest::meshletizeDegenerate() {
+    const UnsignedInt indices[]{0, 0, 1, 1, 2, 2, 0, 0, 0};
+
+    /* A degenerate triangle shouldn't count its vertices more than once, so
+       all three triangles fit into a meshlet of three vertices */
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(indices), Containers::arrayView(StripPositions).prefix(3), 3, 124);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 1);
+    CORRADE_COMPARE(meshlets.meshlets()[0].vertexCount, 3);
+    CORRADE_COMPARE(meshlets.meshlets()[0].triangleCount, 3);
+    CORRADE_COMPARE_AS(meshlets.indicesAsArray(),
+        Containers::arrayView(indices),
+        TestSuite::Compare::Container);
+}
+
+void MeshletizeTest::coneFlat() {
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(StripIndices), StripPositions);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 1);
+
+    /* All normals are the same, so the cone has zero width and the cutoff
+       is a sine of zero */
+    const Meshlet& meshlet = meshlets.meshlets()[0];
+    CORRADE_COMPARE(meshlet.coneAxis, Vector3::zAxis());
+    CORRADE_COMPARE(meshlet.coneCutoff, 0.0f);
+
+    /* Bounding sphere going through the two corners */
+    CORRADE_COMPARE(meshlet.center, (Vector3{2.0f, 0.5f, 0.0f}));
+    CORRADE_COMPARE(meshlet.radius, Vector2{2.0f, 0.5f}.length());
+
+    /* Camera behind the plane culls the meshlet, camera in front or on the
+       side doesn't */
+    const auto culled = [&](const Vector3& eye) {
+        return Math::dot(meshlet.center - eye, meshlet.coneAxis) >= meshlet.coneCutoff*(meshlet.center - eye).length() + meshlet.radius;
+    };
+    CORRADE_VERIFY(culled({2.0f, 0.5f, -10.0f}));
+    CORRADE_VERIFY(!culled({2.0f, 0.5f, 10.0f}));
+    CORRADE_VERIFY(!culled({20.0f, 0.5f, 0.0f}));
+}
+
+void MeshletizeTest::coneBackToBack() {
+    /* Two triangles with opposite winding, the cone can't be used for
+       culling */
+    const UnsignedInt indices[]{0, 1, 5, 0, 5, 1};
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 1);
+    CORRADE_COMPARE(meshlets.meshlets()[0].coneCutoff, 1.0f);
+}
+
+void MeshletizeTest::sphere() {
+    /* Points scattered around, Ritter's algorithm gives a sphere that's not
+       minimal but contains all of them */
+    const Vector3 positions[]{
+        {1.0f, 0.0f, 0.0f},
+        {-1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 0.0f, -1.0f},
+        {0.7f, 0.7f, 0.7f},
+        {-0.8f, 0.9f, -0.6f}
+    };
+    const UnsignedInt indices[]{
+        0, 2, 4,
+        1, 3, 5,
+        6, 7, 0
+    };
+    Meshlets meshlets = MeshTools::meshletize(Containers::stridedArrayView(indices), positions);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 1);
+
+    const Meshlet& meshlet = meshlets.meshlets()[0];
+    for(const Vector3& position: positions) {
+        CORRADE_ITERATION(position);
+        CORRADE_COMPARE_AS((position - meshlet.center).length(), meshlet.radius*1.0001f, TestSuite::Compare::LessOrEqual);
+    }
+    CORRADE_COMPARE_AS(meshlet.radius, 1.5f, TestSuite::Compare::Less);
+}
+
+void MeshletizeTest::empty() {
+    Meshlets meshlets = MeshTools::meshletize(Containers::StridedArrayView1D<const UnsignedInt>{}, StripPositions);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 0);
+    CORRADE_COMPARE(meshlets.vertices().size(), 0);
+    CORRADE_COMPARE(meshlets.triangles().size(), 0);
+    CORRADE_COMPARE(meshlets.indicesAsArray().size(), 0);
+}
+
+void MeshletizeTest::invalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[]{0, 1, 10};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::meshletize(Containers::stridedArrayView(indices).prefix(2), StripPositions);
+    MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions, 2, 124);
+    MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions, 257, 124);
+    MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions, 64, 0);
+    MeshTools::meshletize(Containers::stridedArrayView(indices), StripPositions);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::meshletize(): index count not divisible by 3, got 2\n"
+        "MeshTools::meshletize(): expected max vertex count to be between 3 and 256, got 2\n"
+        "MeshTools::meshletize(): expected max vertex count to be between 3 and 256, got 257\n"
+        "MeshTools::meshletize(): expected non-zero max triangle count\n"
+        "MeshTools::meshletize(): index 10 out of bounds for 10 elements\n");
+}
+
+void MeshletizeTest::meshData() {
+    UnsignedShort indices[Containers::arraySize(StripIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(StripIndices); ++i)
+        indices[i] = StripIndices[i];
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, StripPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(StripPositions)}
+        }};
+
+    Meshlets meshlets = MeshTools::meshletize(mesh, 6, 4);
+    CORRADE_COMPARE(meshlets.meshlets().size(), 2);
+    CORRADE_COMPARE_AS(meshlets.indicesAsArray(),
+        Containers::arrayView(StripIndices),
+        TestSuite::Compare::Container);
+}
+
+void MeshletizeTest::meshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+    Float data[1]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::meshletize(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::meshletize(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    MeshTools::meshletize(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, data, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(data)}
+        }});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::meshletize(): mesh data not indexed\n"
+        "MeshTools::meshletize(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::meshletize(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MeshletizeTest)
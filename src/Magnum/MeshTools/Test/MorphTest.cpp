@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Morph.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct MorphTest: TestSuite::Tester {
+    explicit MorphTest();
+
+    void morph();
+    void inPlace();
+    void strided();
+    void noTargets();
+    void threaded();
+
+    void wrongWeightCount();
+    void wrongSize();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
+};
+
+MorphTest::MorphTest() {
+    addTests({&MorphTest::morph,
+              &MorphTest::inPlace,
+              &MorphTest::strided,
+              &MorphTest::noTargets});
+
+    addInstancedTests({&MorphTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&MorphTest::wrongWeightCount,
+              &MorphTest::wrongSize});
+}
+
+/* Same data as in Shaders::MorphTargets tests */
+const Vector3 Base[]{
+    {1.0f, 2.0f, 3.0f},
+    {-1.0f, 0.0f, 0.5f}
+};
+/* Target-major, i.e. deltas of all vertices for target 0 first */
+const Vector3 Deltas[]{
+    {1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 4.0f},
+    {0.0f, 0.0f, 1.0f}, {8.0f, 0.0f, 0.0f}
+};
+const Float Weights[]{0.5f, 0.0f, 0.25f};
+
+void MorphTest::morph() {
+    Vector3 out[2];
+    morphInto(Weights, Base, Containers::StridedArrayView2D<const Vector3>{Deltas, {3, 2}}, out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<Vector3>({
+        {1.5f, 2.0f, 3.25f},
+        {1.0f, 1.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void MorphTest::inPlace() {
+    Vector3 data[]{Base[0], Base[1]};
+    morphInto(Weights, data, Containers::StridedArrayView2D<const Vector3>{Deltas, {3, 2}}, data);
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<Vector3>({
+        {1.5f, 2.0f, 3.25f},
+        {1.0f, 1.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void MorphTest::strided() {
+    /* Interleaved deltas, vertex-major, and an interleaved output */
+    struct Vertex {
+        Vector3 base;
+        Vector3 deltas[3];
+    } vertices[2];
+    for(std::size_t i = 0; i != 2; ++i) {
+        vertices[i].base = Base[i];
+        for(std::size_t j = 0; j != 3; ++j)
+            vertices[i].deltas[j] = Deltas[j*2 + i];
+    }
+    auto view = Containers::stridedArrayView(vertices);
+    Containers::StridedArrayView2D<const Vector3> deltas{vertices, &vertices[0].deltas[0], {3, 2}, {std::ptrdiff_t(sizeof(Vector3)), std::ptrdiff_t(sizeof(Vertex))}};
+
+    struct Output {
+        Int padding;
+        Vector3 position;
+    } out[2];
+    auto outView = Containers::stridedArrayView(out);
+
+    morphInto(Weights, view.slice(&Vertex::base), deltas, outView.slice(&Output::position));
+    CORRADE_COMPARE_AS(outView.slice(&Output::position), Containers::arrayView<Vector3>({
+        {1.5f, 2.0f, 3.25f},
+        {1.0f, 1.0f, 0.5f}
+    }), TestSuite::Compare::Container);
+}
+
+void MorphTest::noTargets() {
+    Vector3 out[2];
+    morphInto(nullptr, Base, Containers::StridedArrayView2D<const Vector3>{nullptr, {0, 2}}, out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView(Base),
+        TestSuite::Compare::Container);
+}
+
+void MorphTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split among several threads, with an odd vertex
+       count to test the remainder handling */
+    constexpr std::size_t VertexCount = 16*1024 + 3;
+    Containers::Array<Vector3> base{Containers::NoInit, VertexCount};
+    Containers::Array<Vector3> deltas{Containers::NoInit, 4*VertexCount};
+    for(std::size_t i = 0; i != VertexCount; ++i)
+        base[i] = {Float(i%17), Float(i%5) - 2.0f, Float(i%11)*0.5f};
+    for(std::size_t i = 0; i != deltas.size(); ++i)
+        deltas[i] = {Float(i%7)*0.25f, -Float(i%3), Float(i%13)*0.125f};
+    const Float weights[]{0.75f, 0.0f, -0.5f, 0.3f};
+    const Containers::StridedArrayView2D<const Vector3> deltas2D{deltas, {4, VertexCount}};
+
+    Containers::Array<Vector3> out{Containers::NoInit, VertexCount};
+    morphInto(weights, base, deltas2D, out, data.threadCount);
+
+    /* The output should be exactly the same as a straightforward
+       calculation, independently of the thread count */
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        Vector3 expected = base[i];
+        expected += weights[0]*deltas2D[0][i];
+        expected += weights[2]*deltas2D[2][i];
+        expected += weights[3]*deltas2D[3][i];
+        CORRADE_VERIFY(out[i] == expected);
+    }
+}
+
+void MorphTest::wrongWeightCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 out[2];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    morphInto(Containers::arrayView(Weights).prefix(2), Base, Containers::StridedArrayView2D<const Vector3>{Deltas, {3, 2}}, out);
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::morphInto(): expected 3 weights but got 2\n");
+}
+
+void MorphTest::wrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 out[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    morphInto(Weights, Base, Containers::StridedArrayView2D<const Vector3>{Deltas, {3, 2}}, out);
+    morphInto(Containers::arrayView(Weights).prefix(2), Base, Containers::StridedArrayView2D<const Vector3>{Deltas, {2, 3}}, Containers::arrayView(out).prefix(2));
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::morphInto(): expected base, delta and output views to have the same size but got 2, 2 and 3\n"
+        "MeshTools::morphInto(): expected base, delta and output views to have the same size but got 2, 3 and 2\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::MorphTest)
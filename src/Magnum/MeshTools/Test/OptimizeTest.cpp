@@ -0,0 +1,551 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Optimize.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct OptimizeTest: TestSuite::Tester {
+    explicit OptimizeTest();
+
+    template<class T> void vertexCache();
+    void vertexCacheOneDegenerateTriangle();
+    void vertexCacheHighValence();
+    void vertexCacheGrid();
+    void vertexCacheInvalidSize();
+
+    template<class T> void overdraw();
+    void overdrawInvalidSize();
+
+    template<class T> void vertexFetch();
+    void vertexFetchOutOfBounds();
+
+    void vertexCacheMeshData();
+    void vertexCacheMeshDataRvalue();
+    void vertexCacheMeshDataInvalid();
+    void overdrawMeshData();
+    void overdrawMeshDataInvalid();
+    void vertexFetchMeshData();
+    void vertexFetchMeshDataInvalid();
+};
+
+/* Same mesh as in TipsifyTest
+
+ 0 ----- 1 ----- 2 ----- 3
+  \ 0  /  \ 7  /  \ 2  /  \
+   \  / 11 \  / 13 \  / 12 \
+    4 ----- 5 ----- 6 ----- 7
+   /  \ 3  /  \ 8  /  \ 5  /
+  / 14 \  / 9  \  / 15 \  /
+ 8 ----- 9 ---- 10 ---- 11          18 ---- 17
+  \ 4  /  \ 1  /  \ 17 /  \           \ 18  /
+   \  / 16 \  / 10 \  / 6  \           \  /
+    12 ---- 13 ---- 14 ---- 15          16
+
+*/
+
+constexpr UnsignedInt Indices[]{
+    4, 1, 0,
+    10, 9, 13,
+    6, 3, 2,
+    9, 5, 4,
+    12, 9, 8,
+    11, 7, 6,
+
+    14, 15, 11,
+    2, 1, 5,
+    10, 6, 5,
+    10, 5, 9,
+    13, 14, 10,
+    1, 4, 5,
+
+    7, 3, 6,
+    6, 2, 5,
+    9, 4, 8,
+    6, 10, 11,
+    13, 9, 12,
+    14, 11, 10,
+
+    16, 17, 18
+};
+
+constexpr std::size_t VertexCount = 19;
+
+/* Two quads facing +Z, the one at Z = -1 is listed first but is occluded by
+   the one at Z = +1 */
+constexpr UnsignedInt QuadIndices[]{
+    0, 1, 2, 0, 2, 3,
+    4, 5, 6, 4, 6, 7
+};
+
+const Vector3 QuadPositions[]{
+    {-1.0f, -1.0f, -1.0f},
+    { 1.0f, -1.0f, -1.0f},
+    { 1.0f,  1.0f, -1.0f},
+    {-1.0f,  1.0f, -1.0f},
+
+    {-1.0f, -1.0f,  1.0f},
+    { 1.0f, -1.0f,  1.0f},
+    { 1.0f,  1.0f,  1.0f},
+    {-1.0f,  1.0f,  1.0f}
+};
+
+/* Count of vertices transformed by a GPU that processes the index buffer in
+   batches of at most batchSize unique vertices */
+template<class T> std::size_t batchTransformCount(const Containers::ArrayView<const T> indices, const std::size_t vertexCount, const UnsignedInt batchSize) {
+    Containers::Array<UnsignedInt> vertexBatch{vertexCount};
+    UnsignedInt batch = 0;
+    UnsignedInt batchVertexCount = 0;
+    std::size_t count = 0;
+    for(std::size_t t = 0; t != indices.size()/3; ++t) {
+        UnsignedInt notInBatch = 0;
+        for(std::size_t vi = 0; vi != 3; ++vi)
+            if(vertexBatch[indices[t*3 + vi]] != batch) ++notInBatch;
+        if(!t || batchVertexCount + notInBatch > batchSize) {
+            ++batch;
+            batchVertexCount = 0;
+        }
+        for(std::size_t vi = 0; vi != 3; ++vi) {
+            UnsignedInt& vertex = vertexBatch[indices[t*3 + vi]];
+            if(vertex == batch) continue;
+            vertex = batch;
+            ++batchVertexCount;
+            ++count;
+        }
+    }
+    return count;
+}
+
+/* Triangles sorted to be comparable independently of their order */
+template<class T> std::vector<Math::Vector3<T>> sortedTriangles(const Containers::ArrayView<const T> indices) {
+    std::vector<Math::Vector3<T>> triangles;
+    for(std::size_t i = 0; i != indices.size(); i += 3)
+        triangles.emplace_back(indices[i], indices[i + 1], indices[i + 2]);
+    std::sort(triangles.begin(), triangles.end(), [](const Math::Vector3<T>& a, const Math::Vector3<T>& b) {
+        return std::make_tuple(a.x(), a.y(), a.z()) < std::make_tuple(b.x(), b.y(), b.z());
+    });
+    return triangles;
+}
+
+OptimizeTest::OptimizeTest() {
+    addTests({&OptimizeTest::vertexCache<UnsignedByte>,
+              &OptimizeTest::vertexCache<UnsignedShort>,
+              &OptimizeTest::vertexCache<UnsignedInt>,
+              &OptimizeTest::vertexCacheOneDegenerateTriangle,
+              &OptimizeTest::vertexCacheHighValence,
+              &OptimizeTest::vertexCacheGrid,
+              &OptimizeTest::vertexCacheInvalidSize,
+
+              &OptimizeTest::overdraw<UnsignedByte>,
+              &OptimizeTest::overdraw<UnsignedShort>,
+              &OptimizeTest::overdraw<UnsignedInt>,
+              &OptimizeTest::overdrawInvalidSize,
+
+              &OptimizeTest::vertexFetch<UnsignedByte>,
+              &OptimizeTest::vertexFetch<UnsignedShort>,
+              &OptimizeTest::vertexFetch<UnsignedInt>,
+              &OptimizeTest::vertexFetchOutOfBounds,
+
+              &OptimizeTest::vertexCacheMeshData,
+              &OptimizeTest::vertexCacheMeshDataRvalue,
+              &OptimizeTest::vertexCacheMeshDataInvalid,
+              &OptimizeTest::overdrawMeshData,
+              &OptimizeTest::overdrawMeshDataInvalid,
+              &OptimizeTest::vertexFetchMeshData,
+              &OptimizeTest::vertexFetchMeshDataInvalid});
+}
+
+template<class T> void OptimizeTest::vertexCache() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    MeshTools::optimizeVertexCacheInPlace(indices, VertexCount, 6);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        4, 1, 0,
+        1, 4, 5,
+        2, 1, 5,
+        9, 5, 4, /* new batch, continuing from 5 or 4 */
+        9, 4, 8,
+        12, 9, 8,
+        13, 9, 12,
+        10, 9, 13, /* new batch, continuing from 13 or 9 */
+        10, 5, 9,
+        10, 6, 5,
+        6, 2, 5,
+        6, 3, 2, /* new batch, continuing from 2 or 6 */
+        7, 3, 6,
+        11, 7, 6,
+        6, 10, 11,
+        14, 11, 10,
+        14, 15, 11, /* new batch, continuing from 14, 10 or 11 */
+        13, 14, 10,
+        16, 17, 18 /* arbitrary triangle */
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(batchTransformCount(Containers::arrayView(Indices), VertexCount, 6), 54);
+    CORRADE_COMPARE(batchTransformCount<T>(indices, VertexCount, 6), 32);
+}
+
+void OptimizeTest::vertexCacheOneDegenerateTriangle() {
+    UnsignedInt indices[]{0, 0, 0};
+    MeshTools::optimizeVertexCacheInPlace(indices, 1);
+
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<UnsignedInt>({0, 0, 0}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheHighValence() {
+    /* A triangle fan with all triangles sharing vertex 0. Only verifies that
+       all triangles make it to the output, the per-vertex candidate limit
+       is there mainly to keep this from getting quadratic. */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 3*1000};
+    for(UnsignedInt i = 0; i != 1000; ++i) {
+        indices[i*3 + 0] = 0;
+        indices[i*3 + 1] = i + 1;
+        indices[i*3 + 2] = i + 2;
+    }
+    const std::vector<Vector3ui> expected = sortedTriangles<UnsignedInt>(indices);
+
+    MeshTools::optimizeVertexCacheInPlace(indices, 1002);
+    CORRADE_COMPARE_AS(sortedTriangles<UnsignedInt>(indices), expected,
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheGrid() {
+    /* A shuffled 15x15 grid, that's 256 vertices and 450 triangles */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, 15*15*6};
+    UnsignedInt* out = indices.data();
+    for(UnsignedInt y = 0; y != 15; ++y) for(UnsignedInt x = 0; x != 15; ++x) {
+        const UnsignedInt a = y*16 + x, b = a + 1, c = a + 16, d = c + 1;
+        for(UnsignedInt i: {a, b, d, a, d, c}) *out++ = i;
+    }
+    const std::size_t orderedTransformCount = batchTransformCount<UnsignedInt>(indices, 256, 32);
+    std::shuffle(reinterpret_cast<Vector3ui*>(indices.begin()), reinterpret_cast<Vector3ui*>(indices.end()), std::minstd_rand{});
+    const std::size_t shuffledTransformCount = batchTransformCount<UnsignedInt>(indices, 256, 32);
+    const std::vector<Vector3ui> expected = sortedTriangles<UnsignedInt>(indices);
+
+    MeshTools::optimizeVertexCacheInPlace(indices, 256);
+    CORRADE_COMPARE_AS(sortedTriangles<UnsignedInt>(indices), expected,
+        TestSuite::Compare::Container);
+
+    /* Should be better than both the shuffled and the row-by-row order, for
+       which it's around 1.07 vertices per triangle */
+    const std::size_t optimizedTransformCount = batchTransformCount<UnsignedInt>(indices, 256, 32);
+    CORRADE_INFO("Vertices transformed: ordered" << orderedTransformCount << Debug::nospace << ", shuffled" << shuffledTransformCount << Debug::nospace << ", optimized" << optimizedTransformCount);
+    CORRADE_VERIFY(optimizedTransformCount < shuffledTransformCount);
+    CORRADE_VERIFY(optimizedTransformCount < orderedTransformCount);
+}
+
+void OptimizeTest::vertexCacheInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[6]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCacheInPlace(Containers::arrayView(indices).prefix(5), 1);
+    MeshTools::optimizeVertexCacheInPlace(indices, 1, 2);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCacheInPlace(): index count not divisible by 3, got 5\n"
+        "MeshTools::optimizeVertexCacheInPlace(): expected batch size to be at least 3, got 2\n");
+}
+
+template<class T> void OptimizeTest::overdraw() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[Containers::arraySize(QuadIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(QuadIndices); ++i)
+        indices[i] = QuadIndices[i];
+
+    /* With batches of 4 vertices each quad is a single cluster, the front
+       one should go first with the triangle order preserved */
+    MeshTools::optimizeOverdrawInPlace(indices, QuadPositions, 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+
+    /* Running again doesn't change anything */
+    MeshTools::optimizeOverdrawInPlace(indices, QuadPositions, 4);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices), Containers::arrayView<T>({
+        4, 5, 6, 4, 6, 7,
+        0, 1, 2, 0, 2, 3
+    }), TestSuite::Compare::Container);
+}
+
+void OptimizeTest::overdrawInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[6]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdrawInPlace(Containers::arrayView(indices).prefix(5), QuadPositions);
+    MeshTools::optimizeOverdrawInPlace(indices, QuadPositions, 2);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdrawInPlace(): index count not divisible by 3, got 5\n"
+        "MeshTools::optimizeOverdrawInPlace(): expected batch size to be at least 3, got 2\n");
+}
+
+template<class T> void OptimizeTest::vertexFetch() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    T indices[]{3, 1, 3, 0, 3, 1};
+    Int data[]{10, 11, 12, 13, 14};
+    MeshTools::optimizeVertexFetchInPlace(indices,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+
+    /* Unreferenced vertices 12 and 14 are at the end, in the original
+       order */
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({0, 1, 0, 2, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(data),
+        Containers::arrayView<Int>({13, 11, 10, 12, 14}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexFetchOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{3, 1, 5};
+    Int data[5]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetchInPlace(indices,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetchInPlace(): index 5 out of bounds for 5 elements\n");
+}
+
+void OptimizeTest::vertexCacheMeshData() {
+    UnsignedShort indices[Containers::arraySize(Indices)];
+    for(std::size_t i = 0; i != Containers::arraySize(Indices); ++i)
+        indices[i] = Indices[i];
+    Float positions[VertexCount]{};
+
+    /* Deliberately not owned to verify the original data isn't modified */
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData optimized = MeshTools::optimizeVertexCache(mesh, 6);
+    CORRADE_COMPARE(optimized.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(optimized.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(optimized.vertexCount(), VertexCount);
+    CORRADE_COMPARE(optimized.attributeCount(), 1);
+    CORRADE_COMPARE_AS(optimized.indices<UnsignedShort>().prefix(9),
+        Containers::arrayView<UnsignedShort>({
+            4, 1, 0,
+            1, 4, 5,
+            2, 1, 5
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(indices[3], 10);
+}
+
+void OptimizeTest::vertexCacheMeshDataRvalue() {
+    Containers::Array<char> indexData{Containers::NoInit, sizeof(Indices)};
+    std::copy(reinterpret_cast<const char*>(Indices), reinterpret_cast<const char*>(Indices) + sizeof(Indices), indexData.begin());
+    Containers::Array<char> vertexData{VertexCount*sizeof(Float)};
+    const void* indexPointer = indexData.data();
+    const void* vertexPointer = vertexData.data();
+
+    Trade::MeshIndexData indices{Containers::arrayCast<const UnsignedInt>(indexData)};
+    Trade::MeshAttributeData attribute{Trade::meshAttributeCustom(42),
+        Containers::arrayCast<const Float>(vertexData)};
+    Trade::MeshData optimized = MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), indices,
+        std::move(vertexData), {attribute}}, 6);
+
+    /* The data should be transferred without a copy */
+    CORRADE_COMPARE(optimized.indexData().data(), indexPointer);
+    CORRADE_COMPARE(optimized.vertexData().data(), vertexPointer);
+    CORRADE_COMPARE_AS(optimized.indices<UnsignedInt>().prefix(9),
+        Containers::arrayView<UnsignedInt>({
+            4, 1, 0,
+            1, 4, 5,
+            2, 1, 5
+        }), TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexCacheMeshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeVertexCache(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexCache(): mesh data not indexed\n"
+        "MeshTools::optimizeVertexCache(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n");
+}
+
+void OptimizeTest::overdrawMeshData() {
+    UnsignedByte indices[Containers::arraySize(QuadIndices)];
+    for(std::size_t i = 0; i != Containers::arraySize(QuadIndices); ++i)
+        indices[i] = QuadIndices[i];
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, QuadPositions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(QuadPositions)}
+        }};
+
+    Trade::MeshData optimized = MeshTools::optimizeOverdraw(mesh, 4);
+    CORRADE_COMPARE(optimized.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(optimized.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE_AS(optimized.indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({
+            4, 5, 6, 4, 6, 7,
+            0, 1, 2, 0, 2, 3
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(optimized.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView(QuadPositions),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::overdrawMeshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+    Float data[1]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeOverdraw(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeOverdraw(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    MeshTools::optimizeOverdraw(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, data, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(data)}
+        }});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeOverdraw(): mesh data not indexed\n"
+        "MeshTools::optimizeOverdraw(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::optimizeOverdraw(): the mesh has no positions\n");
+}
+
+void OptimizeTest::vertexFetchMeshData() {
+    /* Deliberately not interleaved to verify that the function will handle
+       this */
+    struct Vertex {
+        Vector2 positions[5]{
+            {1.0f, 0.0f},
+            {2.0f, 1.0f},
+            {3.0f, 2.0f},
+            {4.0f, 3.0f},
+            {5.0f, 4.0f}
+        };
+        Int ids[5]{10, 11, 12, 13, 14};
+    } vertexData[1];
+
+    const UnsignedShort indices[]{3, 1, 3, 0, 3, 1};
+
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertexData, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(vertexData->positions)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(vertexData->ids)}
+        }};
+
+    Trade::MeshData optimized = MeshTools::optimizeVertexFetch(mesh);
+    CORRADE_COMPARE(optimized.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(optimized.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(optimized.vertexCount(), 5);
+    CORRADE_COMPARE_AS(optimized.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 0, 2, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(optimized.attribute<Vector2>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2>({
+            {4.0f, 3.0f},
+            {2.0f, 1.0f},
+            {1.0f, 0.0f},
+            {3.0f, 2.0f},
+            {5.0f, 4.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(optimized.attribute<Int>(Trade::meshAttributeCustom(42)),
+        Containers::arrayView<Int>({13, 11, 10, 12, 14}),
+        TestSuite::Compare::Container);
+}
+
+void OptimizeTest::vertexFetchMeshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::optimizeVertexFetch(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    MeshTools::optimizeVertexFetch(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::optimizeVertexFetch(): mesh data not indexed\n"
+        "MeshTools::optimizeVertexFetch(): can't optimize an attributeless mesh\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::OptimizeTest)
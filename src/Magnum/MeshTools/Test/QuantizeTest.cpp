@@ -0,0 +1,286 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/MeshTools/Quantize.h"
+#include "Magnum/MeshTools/Transform.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct QuantizeTest: TestSuite::Tester {
+    explicit QuantizeTest();
+
+    void quantize();
+    void quantizeHighPrecision();
+    void quantizeTextureCoordinatesOutOfRange();
+    void quantize2D();
+    void quantizeMorphTargets();
+    void quantizeNoPositions();
+    void quantizePassthrough();
+};
+
+QuantizeTest::QuantizeTest() {
+    addTests({&QuantizeTest::quantize,
+              &QuantizeTest::quantizeHighPrecision,
+              &QuantizeTest::quantizeTextureCoordinatesOutOfRange,
+              &QuantizeTest::quantize2D,
+              &QuantizeTest::quantizeMorphTargets,
+              &QuantizeTest::quantizeNoPositions,
+              &QuantizeTest::quantizePassthrough});
+}
+
+using namespace Math::Literals;
+
+struct Vertex {
+    Vector3 position;
+    Vector3 normal;
+    Vector2 textureCoordinates;
+    Color4 color;
+};
+
+const Vertex Vertices[]{
+    {{-1.0f, 0.0f, 2.0f}, {0.0f, 0.0f, 1.0f}, {0.0f, 1.0f}, {1.0f, 0.0f, 0.0f, 1.0f}},
+    {{3.0f, 4.0f, 2.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 0.0f}, {2.0f, -1.0f, 0.0f, 1.0f}},
+    {{1.0f, 2.0f, 2.0f}, {0.0f, -1.0f, 0.0f}, {0.25f, 0.75f}, {0.0f, 0.0f, 1.0f, 0.0f}}
+};
+
+const UnsignedShort Indices[]{2, 1, 0, 0, 1};
+
+Trade::MeshData mesh() {
+    Containers::StridedArrayView1D<const Vertex> vertices = Vertices;
+    return Trade::MeshData{MeshPrimitive::Triangles,
+        {}, Indices, Trade::MeshIndexData{Indices},
+        {}, Vertices, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Normal, vertices.slice(&Vertex::normal)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, vertices.slice(&Vertex::textureCoordinates)},
+            Trade::MeshAttributeData{Trade::MeshAttribute::Color, vertices.slice(&Vertex::color)}
+        }};
+}
+
+void QuantizeTest::quantize() {
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh());
+    const Trade::MeshData& data = out.first;
+
+    CORRADE_COMPARE(data.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(data.isIndexed());
+    CORRADE_COMPARE(data.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(data.indices<UnsignedShort>(),
+        Containers::arrayView(Indices),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(data.vertexCount(), 3);
+    CORRADE_COMPARE(data.attributeCount(), 4);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3bNormalized);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Color), VertexFormat::Vector4ubNormalized);
+    /* 6 + 3 + 4 + 4 */
+    CORRADE_COMPARE(data.attributeStride(Trade::MeshAttribute::Position), 17);
+
+    /* The positions span the whole range, the flat Z axis has a unit scale */
+    CORRADE_COMPARE(out.second, Matrix4::translation({1.0f, 2.0f, 2.0f})*Matrix4::scaling({2.0f, 2.0f, 1.0f}));
+    CORRADE_COMPARE_AS(data.attribute<Vector3s>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3s>({
+            {-32767, -32767, 0},
+            {32767, 32767, 0},
+            {0, 0, 0}
+        }), TestSuite::Compare::Container);
+
+    /* Dequantizing gives back the original positions */
+    Containers::Array<Vector3> positions = data.positions3DAsArray();
+    MeshTools::transformPointsInPlace(out.second, positions);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector3>({
+        {-1.0f, 0.0f, 2.0f},
+        {3.0f, 4.0f, 2.0f},
+        {1.0f, 2.0f, 2.0f}
+    }), TestSuite::Compare::Container);
+
+    CORRADE_COMPARE_AS(data.attribute<Vector3b>(Trade::MeshAttribute::Normal),
+        Containers::arrayView<Vector3b>({
+            {0, 0, 127},
+            {127, 0, 0},
+            {0, -127, 0}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attribute<Vector2us>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2us>({
+            {0, 65535},
+            {65535, 0},
+            {16384, 49151}
+        }), TestSuite::Compare::Container);
+    /* Out-of-range colors are clamped */
+    CORRADE_COMPARE_AS(data.attribute<Vector4ub>(Trade::MeshAttribute::Color),
+        Containers::arrayView<Vector4ub>({
+            {255, 0, 0, 255},
+            {255, 0, 0, 255},
+            {0, 0, 255, 0}
+        }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizeHighPrecision() {
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(mesh(),
+        QuantizeFlag::HighPrecisionNormals|
+        QuantizeFlag::HalfTextureCoordinates|
+        QuantizeFlag::HighPrecisionColors);
+    const Trade::MeshData& data = out.first;
+
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3sNormalized);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2h);
+    CORRADE_COMPARE(data.attributeFormat(Trade::MeshAttribute::Color), VertexFormat::Vector4usNormalized);
+
+    CORRADE_COMPARE_AS(data.attribute<Vector3s>(Trade::MeshAttribute::Normal),
+        Containers::arrayView<Vector3s>({
+            {0, 0, 32767},
+            {32767, 0, 0},
+            {0, -32767, 0}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attribute<Vector2h>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2h>({
+            {0.0_h, 1.0_h},
+            {1.0_h, 0.0_h},
+            {0.25_h, 0.75_h}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.attribute<Vector4us>(Trade::MeshAttribute::Color),
+        Containers::arrayView<Vector4us>({
+            {65535, 0, 0, 65535},
+            {65535, 0, 0, 65535},
+            {0, 0, 65535, 0}
+        }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizeTextureCoordinatesOutOfRange() {
+    const Vector2 textureCoordinates[]{
+        {0.0f, 0.5f},
+        {1.5f, -0.25f}
+    };
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Lines, {}, textureCoordinates, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, Containers::arrayView(textureCoordinates)}
+    }});
+
+    /* Doesn't fit into a normalized type, so it's a half-float */
+    CORRADE_COMPARE(out.first.attributeFormat(Trade::MeshAttribute::TextureCoordinates), VertexFormat::Vector2h);
+    CORRADE_COMPARE_AS(out.first.attribute<Vector2h>(Trade::MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2h>({
+            {0.0_h, 0.5_h},
+            {1.5_h, -0.25_h}
+        }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantize2D() {
+    const Vector2 positions[]{
+        {10.0f, -4.0f},
+        {20.0f, 4.0f},
+        {15.0f, 0.0f}
+    };
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Triangles, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions)}
+    }});
+    CORRADE_VERIFY(!out.first.isIndexed());
+    CORRADE_COMPARE(out.first.attributeFormat(Trade::MeshAttribute::Position), VertexFormat::Vector2sNormalized);
+    CORRADE_COMPARE_AS(out.first.attribute<Vector2s>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector2s>({
+            {-32767, -32767},
+            {32767, 32767},
+            {0, 0}
+        }), TestSuite::Compare::Container);
+
+    /* The Z axis is an identity */
+    CORRADE_COMPARE(out.second, Matrix4::translation({15.0f, 0.0f, 0.0f})*Matrix4::scaling({5.0f, 4.0f, 1.0f}));
+}
+
+void QuantizeTest::quantizeMorphTargets() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 1.0f},
+        /* Morph target, extends the bounds */
+        {0.0f, 0.0f, 0.0f},
+        {3.0f, 3.0f, 3.0f}
+    };
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Lines, {}, positions, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions).prefix(2)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, Containers::arrayView(positions).suffix(2), 0}
+    }});
+    CORRADE_COMPARE(out.second, Matrix4::translation(Vector3{1.5f})*Matrix4::scaling(Vector3{1.5f}));
+    CORRADE_COMPARE(out.first.attributeMorphTargetId(1), 0);
+    CORRADE_COMPARE_AS(out.first.attribute<Vector3s>(1),
+        Containers::arrayView<Vector3s>({
+            Vector3s{-32767},
+            Vector3s{32767}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(out.first.attribute<Vector3s>(0),
+        Containers::arrayView<Vector3s>({
+            Vector3s{-32767},
+            Vector3s{-10922}
+        }), TestSuite::Compare::Container);
+}
+
+void QuantizeTest::quantizeNoPositions() {
+    const Vector3 normals[]{
+        {0.0f, 1.0f, 0.0f}
+    };
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Points, {}, normals, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Normal, Containers::arrayView(normals)}
+    }});
+    CORRADE_COMPARE(out.second, Matrix4{});
+    CORRADE_COMPARE(out.first.attributeFormat(Trade::MeshAttribute::Normal), VertexFormat::Vector3bNormalized);
+}
+
+void QuantizeTest::quantizePassthrough() {
+    struct Vertex {
+        Vector3ub position;
+        Float custom;
+        Vector2 textureCoordinates;
+    } vertices[]{
+        {{1, 2, 3}, 1.5f, {0.0f, 1.0f}}
+    };
+    Containers::StridedArrayView1D<Vertex> view = vertices;
+    std::pair<Trade::MeshData, Matrix4> out = MeshTools::quantize(Trade::MeshData{MeshPrimitive::Points, {}, vertices, {
+        Trade::MeshAttributeData{Trade::MeshAttribute::Position, view.slice(&Vertex::position)},
+        Trade::MeshAttributeData{Trade::meshAttributeCustom(3), view.slice(&Vertex::custom)},
+        Trade::MeshAttributeData{Trade::MeshAttribute::TextureCoordinates, view.slice(&Vertex::textureCoordinates)}
+    }});
+
+    /* Already packed positions and custom attributes are kept as-is */
+    const Trade::MeshData& data = out.first;
+    CORRADE_COMPARE(out.second, Matrix4{});
+    CORRADE_COMPARE(data.attributeFormat(0), VertexFormat::Vector3ub);
+    CORRADE_COMPARE(data.attributeFormat(1), VertexFormat::Float);
+    CORRADE_COMPARE(data.attributeFormat(2), VertexFormat::Vector2usNormalized);
+    CORRADE_COMPARE(data.attribute<Vector3ub>(0)[0], (Vector3ub{1, 2, 3}));
+    CORRADE_COMPARE(data.attribute<Float>(1)[0], 1.5f);
+    CORRADE_COMPARE(data.attribute<Vector2us>(2)[0], (Vector2us{0, 65535}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::QuantizeTest)
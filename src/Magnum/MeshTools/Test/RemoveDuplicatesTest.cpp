@@ -44,6 +44,7 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void removeDuplicates();
     void removeDuplicatesNonContiguous();
     void removeDuplicatesIntoWrongOutputSize();
+    void removeDuplicatesThreaded();
 
     template<class T> void removeDuplicatesIndexedInPlace();
     void removeDuplicatesIndexedInPlaceSmallType();
@@ -57,6 +58,7 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     template<class T> void removeDuplicatesFuzzyInPlaceMoreDimensions();
     template<class T> void removeDuplicatesFuzzyInPlaceInto();
     void removeDuplicatesFuzzyInPlaceIntoWrongOutputSize();
+    template<class T> void removeDuplicatesFuzzyInPlaceThreaded();
     #ifdef MAGNUM_BUILD_DEPRECATED
     void removeDuplicatesFuzzyStl();
     #endif
@@ -82,7 +84,19 @@ struct RemoveDuplicatesTest: TestSuite::Tester {
     void soakTestFuzzy();
 
     void benchmark();
+    void benchmarkThreaded();
     void benchmarkFuzzy();
+    void benchmarkFuzzyThreaded();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 1000}
 };
 
 const struct {
@@ -164,8 +178,12 @@ const struct {
 RemoveDuplicatesTest::RemoveDuplicatesTest() {
     addTests({&RemoveDuplicatesTest::removeDuplicates,
               &RemoveDuplicatesTest::removeDuplicatesNonContiguous,
-              &RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize,
-              &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
+              &RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize});
+
+    addInstancedTests({&RemoveDuplicatesTest::removeDuplicatesThreaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedByte>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedShort>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlace<UnsignedInt>,
               &RemoveDuplicatesTest::removeDuplicatesIndexedInPlaceSmallType,
@@ -183,7 +201,14 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceMoreDimensions<Double>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Float>,
               &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceInto<Double>,
-              &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize,
+              &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize});
+
+    addInstancedTests<RemoveDuplicatesTest>({
+        &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceThreaded<Float>,
+        &RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceThreaded<Double>},
+        Containers::arraySize(ThreadedData));
+
+    addTests({
               #ifdef MAGNUM_BUILD_DEPRECATED
               &RemoveDuplicatesTest::removeDuplicatesFuzzyStl,
               #endif
@@ -222,7 +247,9 @@ RemoveDuplicatesTest::RemoveDuplicatesTest() {
                       &RemoveDuplicatesTest::soakTestFuzzy}, 10);
 
     addBenchmarks({&RemoveDuplicatesTest::benchmark,
-                   &RemoveDuplicatesTest::benchmarkFuzzy}, 10);
+                   &RemoveDuplicatesTest::benchmarkThreaded,
+                   &RemoveDuplicatesTest::benchmarkFuzzy,
+                   &RemoveDuplicatesTest::benchmarkFuzzyThreaded}, 10);
 }
 
 void RemoveDuplicatesTest::removeDuplicates() {
@@ -276,11 +303,54 @@ void RemoveDuplicatesTest::removeDuplicatesIntoWrongOutputSize() {
     MeshTools::removeDuplicatesInPlaceInto(
         Containers::arrayCast<2, char>(Containers::arrayView(data)),
         output);
+    MeshTools::removeDuplicatesInPlaceInto(
+        Containers::arrayCast<2, char>(Containers::arrayView(data)),
+        output, 4);
     CORRADE_COMPARE(out.str(),
         "MeshTools::removeDuplicatesInto(): output index array has 7 elements but expected 8\n"
+        "MeshTools::removeDuplicatesInPlaceInto(): output index array has 7 elements but expected 8\n"
         "MeshTools::removeDuplicatesInPlaceInto(): output index array has 7 elements but expected 8\n");
 }
 
+void RemoveDuplicatesTest::removeDuplicatesThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Same output as in removeDuplicates() */
+    {
+        Int small[]{-15, 32, 24, -15, 15, 7541, 24, 32};
+        std::pair<Containers::Array<UnsignedInt>, std::size_t> result =
+            MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(small)), data.threadCount);
+        CORRADE_COMPARE_AS(Containers::arrayView(result.first),
+            Containers::arrayView<UnsignedInt>({0, 1, 2, 0, 3, 4, 2, 1}),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(Containers::arrayView(small).prefix(result.second),
+            Containers::arrayView<Int>({-15, 32, 24, 15, 7541}),
+            TestSuite::Compare::Container);
+    }
+
+    /* Enough items to make use of multiple threads, the result should be the
+       same as with the single-threaded variant */
+    Containers::Array<Vector3i> expected{Containers::NoInit, 100000};
+    Containers::Array<Vector3i> actual{Containers::NoInit, expected.size()};
+    std::minstd_rand rand{42};
+    for(std::size_t i = 0; i != expected.size(); ++i) {
+        const Int value = rand() % 20000;
+        expected[i] = actual[i] = {value, value*3, -value};
+    }
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expectedResult =
+        MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(expected)));
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> actualResult =
+        MeshTools::removeDuplicatesInPlace(Containers::arrayCast<2, char>(Containers::arrayView(actual)), data.threadCount);
+    CORRADE_COMPARE(actualResult.second, expectedResult.second);
+    CORRADE_COMPARE_AS(actualResult.first, expectedResult.first,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actual.prefix(actualResult.second),
+        expected.prefix(expectedResult.second),
+        TestSuite::Compare::Container);
+}
+
 template<class T> void RemoveDuplicatesTest::removeDuplicatesIndexedInPlace() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -466,10 +536,42 @@ void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceIntoWrongOutputSize() {
     MeshTools::removeDuplicatesFuzzyInPlaceInto(
         Containers::arrayCast<2, Float>(Containers::stridedArrayView(data)),
         output);
+    MeshTools::removeDuplicatesFuzzyInPlaceInto(
+        Containers::arrayCast<2, Float>(Containers::stridedArrayView(data)),
+        output, Math::TypeTraits<Float>::epsilon(), 4);
     CORRADE_COMPARE(out.str(),
+        "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has 7 elements but expected 8\n"
         "MeshTools::removeDuplicatesFuzzyInPlaceInto(): output index array has 7 elements but expected 8\n");
 }
 
+template<class T> void RemoveDuplicatesTest::removeDuplicatesFuzzyInPlaceThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+    setTestCaseDescription(data.name);
+
+    /* Enough items to make use of multiple threads, with values close to each
+       other both below and above the epsilon. The result should be the same
+       as with the single-threaded variant. */
+    Containers::Array<Math::Vector3<T>> expected{Containers::NoInit, 100000};
+    Containers::Array<Math::Vector3<T>> actual{Containers::NoInit, expected.size()};
+    std::minstd_rand rand{42};
+    for(std::size_t i = 0; i != expected.size(); ++i) {
+        const T value = T(rand() % 2000)*T(0.01) + T(rand() % 4)*T(0.001);
+        expected[i] = actual[i] = {value, value*T(3.0), T(rand() % 3)};
+    }
+
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> expectedResult =
+        MeshTools::removeDuplicatesFuzzyInPlace(Containers::arrayCast<2, T>(Containers::arrayView(expected)), T(0.002));
+    std::pair<Containers::Array<UnsignedInt>, std::size_t> actualResult =
+        MeshTools::removeDuplicatesFuzzyInPlace(Containers::arrayCast<2, T>(Containers::arrayView(actual)), T(0.002), data.threadCount);
+    CORRADE_COMPARE(actualResult.second, expectedResult.second);
+    CORRADE_COMPARE_AS(actualResult.first, expectedResult.first,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(actual.prefix(actualResult.second),
+        expected.prefix(expectedResult.second),
+        TestSuite::Compare::Container);
+}
+
 #ifdef MAGNUM_BUILD_DEPRECATED
 void RemoveDuplicatesTest::removeDuplicatesFuzzyStl() {
     /* Same but with implicit bloat. HEH HEH */
@@ -1101,6 +1203,23 @@ void RemoveDuplicatesTest::benchmark() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkThreaded() {
+    /* Same as above */
+    Vector3i data[10000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i].x() = i/100;
+    std::shuffle(std::begin(data), std::end(data), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    UnsignedInt indices[10000];
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesInPlaceInto(
+            Containers::arrayCast<2, char>(Containers::arrayView(data)),
+            indices, 0);
+
+    CORRADE_COMPARE(count, 100);
+}
+
 void RemoveDuplicatesTest::benchmarkFuzzy() {
     /* Array of 100 unique items with 100 duplicates each, shuffled */
     Vector3 data[10000];
@@ -1118,6 +1237,23 @@ void RemoveDuplicatesTest::benchmarkFuzzy() {
     CORRADE_COMPARE(count, 100);
 }
 
+void RemoveDuplicatesTest::benchmarkFuzzyThreaded() {
+    /* Same as above */
+    Vector3 data[10000];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i].x() = i/100;
+    std::shuffle(std::begin(data), std::end(data), std::minstd_rand{std::random_device{}()});
+
+    std::size_t count;
+    UnsignedInt indices[10000];
+    CORRADE_BENCHMARK(1)
+        count = MeshTools::removeDuplicatesFuzzyInPlaceInto(
+            Containers::arrayCast<2, Float>(Containers::arrayView(data)),
+            indices, Math::TypeTraits<Float>::epsilon(), 0);
+
+    CORRADE_COMPARE(count, 100);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::RemoveDuplicatesTest)
@@ -0,0 +1,432 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/Simplify.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SimplifyTest: TestSuite::Tester {
+    explicit SimplifyTest();
+
+    template<class T> void flat();
+    void seam();
+    void curvedZeroError();
+    void errorThreshold();
+    void targetAboveIndexCount();
+    void degenerate();
+    void invalidSize();
+    void indexOutOfBounds();
+
+    void meshData();
+    void meshDataRvalue();
+    void meshDataInvalid();
+
+    void lodChain();
+    void lodChainInvalid();
+};
+
+SimplifyTest::SimplifyTest() {
+    addTests({&SimplifyTest::flat<UnsignedByte>,
+              &SimplifyTest::flat<UnsignedShort>,
+              &SimplifyTest::flat<UnsignedInt>,
+              &SimplifyTest::seam,
+              &SimplifyTest::curvedZeroError,
+              &SimplifyTest::errorThreshold,
+              &SimplifyTest::targetAboveIndexCount,
+              &SimplifyTest::degenerate,
+              &SimplifyTest::invalidSize,
+              &SimplifyTest::indexOutOfBounds,
+
+              &SimplifyTest::meshData,
+              &SimplifyTest::meshDataRvalue,
+              &SimplifyTest::meshDataInvalid,
+
+              &SimplifyTest::lodChain,
+              &SimplifyTest::lodChainInvalid});
+}
+
+/* A size x size grid of quads in the XY plane, with Z optionally displaced
+   to make it curved. If seam is set, vertices in the middle column are
+   duplicated, with the right half of the grid using the duplicates. */
+template<class T> void grid(const UnsignedInt size, const bool seam, const bool curved, Containers::Array<T>& indices, Containers::Array<Vector3>& positions) {
+    const UnsignedInt seamColumn = size/2;
+    const UnsignedInt columnCount = size + 1 + (seam ? 1 : 0);
+    for(UnsignedInt y = 0; y <= size; ++y) for(UnsignedInt x = 0; x <= size; ++x) {
+        const Vector3 position{Float(x), Float(y),
+            curved ? Math::sin(Rad(x*0.3f))*Math::cos(Rad(y*0.3f)) : 0.0f};
+        arrayAppend(positions, position);
+        if(seam && x == seamColumn) arrayAppend(positions, position);
+    }
+
+    const auto vertex = [&](const UnsignedInt x, const UnsignedInt y, const bool right) {
+        UnsignedInt column = x;
+        if(seam && (x > seamColumn || (x == seamColumn && right))) ++column;
+        return T(y*columnCount + column);
+    };
+    for(UnsignedInt y = 0; y != size; ++y) for(UnsignedInt x = 0; x != size; ++x) {
+        const bool right = x >= seamColumn;
+        const T a = vertex(x, y, right);
+        const T b = vertex(x + 1, y, right);
+        const T c = vertex(x, y + 1, right);
+        const T d = vertex(x + 1, y + 1, right);
+        arrayAppend(indices, {a, b, d, a, d, c});
+    }
+}
+
+/* Sum of areas projected to the XY plane, and count of triangles that are
+   not facing +Z */
+template<class T> Float projectedArea(const Containers::ArrayView<const T> indices, const Containers::ArrayView<const Vector3> positions, UnsignedInt& notFacingCount) {
+    Float area = 0.0f;
+    notFacingCount = 0;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const Float z = Math::cross(
+            positions[indices[i + 1]] - positions[indices[i]],
+            positions[indices[i + 2]] - positions[indices[i]]).z();
+        area += z*0.5f;
+        if(z <= 0.0f) ++notFacingCount;
+    }
+    return area;
+}
+
+template<class T> void SimplifyTest::flat() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Containers::Array<T> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, false, false, indices, positions);
+    CORRADE_COMPARE(indices.size(), 8*8*6);
+
+    /* Everything except the four corners can be collapsed without any
+       error */
+    const UnsignedInt count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 1.0e-4f);
+    CORRADE_COMPARE_AS(indices.prefix(count), Containers::arrayView<T>({
+        0, 8, 80,
+        0, 80, 72
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::seam() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, true, false, indices, positions);
+    CORRADE_COMPARE(positions.size(), 9*10);
+
+    const UnsignedInt count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 1.0e-4f);
+    CORRADE_VERIFY(count < 8*8*6/4);
+
+    /* The simplified mesh should still cover the same area and no triangle
+       should flip */
+    UnsignedInt notFacingCount;
+    CORRADE_COMPARE(projectedArea<UnsignedInt>(indices.prefix(count), positions, notFacingCount), 64.0f);
+    CORRADE_COMPARE(notFacingCount, 0);
+
+    /* No triangle should reference both halves of the seam, i.e. the left
+       columns 0 to 4 and the right columns 5 to 9 */
+    for(std::size_t i = 0; i != count; i += 3) {
+        CORRADE_ITERATION(i);
+        const bool left = indices[i] % 10 < 5;
+        CORRADE_COMPARE(indices[i + 1] % 10 < 5, left);
+        CORRADE_COMPARE(indices[i + 2] % 10 < 5, left);
+    }
+
+    /* And all seam vertices are still referenced, both original and
+       duplicates */
+    for(UnsignedInt y = 0; y != 9; ++y) for(UnsignedInt vertex: {y*10 + 4, y*10 + 5}) {
+        CORRADE_ITERATION(vertex);
+        CORRADE_VERIFY(std::find(indices.begin(), indices.begin() + count, vertex) != indices.begin() + count);
+    }
+}
+
+void SimplifyTest::curvedZeroError() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, false, true, indices, positions);
+
+    /* There's nothing to collapse without introducing an error */
+    CORRADE_COMPARE(MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 0, 0.0f), 8*8*6);
+}
+
+void SimplifyTest::errorThreshold() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(32, false, true, indices, positions);
+
+    Containers::Array<UnsignedInt> indicesLowError{Containers::NoInit, indices.size()};
+    Utility::copy(indices, indicesLowError);
+
+    /* A larger error threshold collapses more, the target index count gets
+       reached if the error isn't limited */
+    const UnsignedInt countLowError = MeshTools::simplifyInPlace(Containers::stridedArrayView(indicesLowError), positions, 0, 0.001f);
+    const UnsignedInt count = MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, indices.size()/10);
+    CORRADE_COMPARE_AS(countLowError, indices.size(), TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(count, countLowError, TestSuite::Compare::Less);
+    CORRADE_COMPARE_AS(count, indices.size()/10, TestSuite::Compare::LessOrEqual);
+}
+
+void SimplifyTest::targetAboveIndexCount() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(2, false, false, indices, positions);
+
+    CORRADE_COMPARE(MeshTools::simplifyInPlace(Containers::stridedArrayView(indices), positions, 24), 24);
+    CORRADE_COMPARE_AS(indices, Containers::arrayView<UnsignedInt>({
+        0, 1, 4, 0, 4, 3,
+        1, 2, 5, 1, 5, 4,
+        3, 4, 7, 3, 7, 6,
+        4, 5, 8, 4, 8, 7
+    }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::degenerate() {
+    UnsignedInt indices[]{0, 0, 1, 0, 1, 2, 2, 1, 2};
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+
+    /* The degenerate triangles are removed even though no simplification
+       is needed to reach the target */
+    CORRADE_COMPARE(MeshTools::simplifyInPlace(indices, positions, 3), 3);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices).prefix(3),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void SimplifyTest::invalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[5]{};
+    const Vector3 positions[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(indices, positions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index count not divisible by 3, got 5\n");
+}
+
+void SimplifyTest::indexOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 3};
+    const Vector3 positions[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplifyInPlace(indices, positions, 0);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplifyInPlace(): index 3 out of bounds for 3 elements\n");
+}
+
+void SimplifyTest::meshData() {
+    Containers::Array<UnsignedShort> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, false, false, indices, positions);
+
+    /* Deliberately not owned to verify the original data isn't modified */
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData simplified = MeshTools::simplify(mesh, 0, 1.0e-4f);
+    CORRADE_COMPARE(simplified.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(simplified.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(simplified.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({
+            0, 8, 80,
+            0, 80, 72
+        }), TestSuite::Compare::Container);
+
+    /* The vertex data are passed through unchanged */
+    CORRADE_COMPARE(simplified.vertexCount(), 81);
+    CORRADE_COMPARE(simplified.attributeCount(), 1);
+    CORRADE_COMPARE_AS(simplified.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+
+    /* The original stays untouched */
+    CORRADE_COMPARE(indices.size(), 8*8*6);
+    CORRADE_COMPARE(indices[2], 10);
+}
+
+void SimplifyTest::meshDataRvalue() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, false, false, indices, positions);
+
+    Containers::Array<char> indexData{Containers::NoInit, indices.size()*sizeof(UnsignedInt)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(indices)), indexData);
+    Containers::Array<char> vertexData{Containers::NoInit, positions.size()*sizeof(Vector3)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(positions)), vertexData);
+    const void* vertexPointer = vertexData.data();
+
+    Trade::MeshIndexData meshIndices{Containers::arrayCast<const UnsignedInt>(indexData)};
+    Trade::MeshAttributeData positionAttribute{Trade::MeshAttribute::Position,
+        Containers::arrayCast<const Vector3>(vertexData)};
+    Trade::MeshData simplified = MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        std::move(indexData), meshIndices,
+        std::move(vertexData), {positionAttribute}}, 0, 1.0e-4f);
+
+    /* The vertex data should be transferred without a copy */
+    CORRADE_COMPARE(simplified.vertexData().data(), vertexPointer);
+    CORRADE_COMPARE_AS(simplified.indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({
+            0, 8, 80,
+            0, 80, 72
+        }), TestSuite::Compare::Container);
+}
+
+void SimplifyTest::meshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+    Float data[1]{};
+    UnsignedInt offsets[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles, 3}, 0);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1}, 0);
+    MeshTools::simplify(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, data, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(data)}
+        }}, 0);
+    MeshTools::generateLodChain(Trade::MeshData{MeshPrimitive::Triangles, 3}, Containers::arrayView<UnsignedInt>({0}), offsets);
+    MeshTools::generateLodChain(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1}, Containers::arrayView<UnsignedInt>({0}), offsets);
+    MeshTools::generateLodChain(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, data, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(data)}
+        }}, Containers::arrayView<UnsignedInt>({0}), offsets);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::simplify(): mesh data not indexed\n"
+        "MeshTools::simplify(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::simplify(): the mesh has no positions\n"
+        "MeshTools::generateLodChain(): mesh data not indexed\n"
+        "MeshTools::generateLodChain(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::generateLodChain(): the mesh has no positions\n");
+}
+
+void SimplifyTest::lodChain() {
+    Containers::Array<UnsignedByte> indices;
+    Containers::Array<Vector3> positions;
+    grid(8, false, false, indices, positions);
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    /* The first level is the original mesh, the last one gets as far as
+       possible */
+    UnsignedInt offsets[4];
+    Trade::MeshData lods = MeshTools::generateLodChain(mesh, Containers::arrayView<UnsignedInt>({384, 96, 0}), offsets, 1.0e-4f);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets),
+        Containers::arrayView<UnsignedInt>({0, 384, 480, 486}),
+        TestSuite::Compare::Container);
+
+    /* All levels are in a single index buffer of the original type, sharing
+       the vertex data */
+    CORRADE_COMPARE(lods.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(lods.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(lods.indexCount(), 486);
+    CORRADE_COMPARE(lods.vertexCount(), 81);
+    CORRADE_COMPARE_AS(lods.indices<UnsignedByte>().prefix(384),
+        Containers::stridedArrayView(indices),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(lods.indices<UnsignedByte>().slice(480, 486),
+        Containers::arrayView<UnsignedByte>({
+            0, 8, 80,
+            0, 80, 72
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(lods.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+
+    /* The intermediate level covers the same area */
+    UnsignedInt notFacingCount;
+    Containers::Array<UnsignedInt> level{Containers::NoInit, 96};
+    for(std::size_t i = 0; i != level.size(); ++i)
+        level[i] = lods.indices<UnsignedByte>()[384 + i];
+    CORRADE_COMPARE(projectedArea<UnsignedInt>(level, positions, notFacingCount), 64.0f);
+    CORRADE_COMPARE(notFacingCount, 0);
+}
+
+void SimplifyTest::lodChainInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+    const Vector3 positions[1];
+    UnsignedInt offsets[3];
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshTools::generateLodChain(mesh, Containers::arrayView<UnsignedInt>({3, 0, 0}), offsets);
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::generateLodChain(): expected 4 offsets but got 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SimplifyTest)
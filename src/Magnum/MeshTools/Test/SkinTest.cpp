@@ -0,0 +1,287 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Skin.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SkinTest: TestSuite::Tester {
+    explicit SkinTest();
+
+    void positions();
+    void positionsNormals();
+    void inPlace();
+    void strided();
+    void threaded();
+
+    void wrongSize();
+    void wrongSizeNormals();
+    void jointOutOfRange();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
+};
+
+SkinTest::SkinTest() {
+    addTests({&SkinTest::positions,
+              &SkinTest::positionsNormals,
+              &SkinTest::inPlace,
+              &SkinTest::strided});
+
+    addInstancedTests({&SkinTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&SkinTest::wrongSize,
+              &SkinTest::wrongSizeNormals,
+              &SkinTest::jointOutOfRange});
+}
+
+using namespace Math::Literals;
+
+const Matrix4 JointMatrices[]{
+    Matrix4::translation(Vector3::xAxis(2.0f)),
+    Matrix4::rotationZ(90.0_degf),
+    Matrix4::scaling(Vector3{3.0f})
+};
+
+const Vector4ui JointIds[]{
+    {0, 0, 0, 0},
+    {1, 0, 2, 0},
+    {2, 1, 0, 0}
+};
+
+const Vector4 Weights[]{
+    {1.0f, 0.0f, 0.0f, 0.0f},
+    {0.5f, 0.25f, 0.25f, 0.0f},
+    {1.0f, 0.0f, 0.0f, 0.0f}
+};
+
+const Vector3 Positions[]{
+    {1.0f, 2.0f, 3.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, -1.0f, 2.0f}
+};
+
+const Vector3 Normals[]{
+    {0.0f, 1.0f, 0.0f},
+    {1.0f, 0.0f, 0.0f},
+    {0.0f, 0.0f, 1.0f}
+};
+
+void SkinTest::positions() {
+    Vector3 out[3];
+    skinInto(JointMatrices, JointIds, Weights, Positions, out);
+    CORRADE_COMPARE_AS(Containers::arrayView(out), Containers::arrayView<Vector3>({
+        /* Translated */
+        {3.0f, 2.0f, 3.0f},
+        /* 0.5 of rotated (0, 1, 0), 0.25 translated (3, 0, 0), 0.25 scaled
+           (3, 0, 0) */
+        {1.5f, 0.5f, 0.0f},
+        /* Scaled */
+        {0.0f, -3.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::positionsNormals() {
+    Vector3 outPositions[3];
+    Vector3 outNormals[3];
+    skinInto(JointMatrices, JointIds, Weights, Positions, Normals, outPositions, outNormals);
+    CORRADE_COMPARE_AS(Containers::arrayView(outPositions), Containers::arrayView<Vector3>({
+        {3.0f, 2.0f, 3.0f},
+        {1.5f, 0.5f, 0.0f},
+        {0.0f, -3.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+    /* Translation doesn't affect the normals, scaling does and they're not
+       renormalized */
+    CORRADE_COMPARE_AS(Containers::arrayView(outNormals), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.5f, 0.0f},
+        {0.0f, 0.0f, 3.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::inPlace() {
+    Vector3 positions[3];
+    Vector3 normals[3];
+    for(std::size_t i = 0; i != 3; ++i) {
+        positions[i] = Positions[i];
+        normals[i] = Normals[i];
+    }
+    skinInto(JointMatrices, JointIds, Weights, positions, normals, positions, normals);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions), Containers::arrayView<Vector3>({
+        {3.0f, 2.0f, 3.0f},
+        {1.5f, 0.5f, 0.0f},
+        {0.0f, -3.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(normals), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.5f, 0.0f},
+        {0.0f, 0.0f, 3.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::strided() {
+    struct Vertex {
+        Vector3 position;
+        Vector4ui jointIds;
+        Vector3 normal;
+        Vector4 weights;
+    } vertices[3];
+    for(std::size_t i = 0; i != 3; ++i)
+        vertices[i] = {Positions[i], JointIds[i], Normals[i], Weights[i]};
+    auto view = Containers::stridedArrayView(vertices);
+
+    struct Output {
+        Vector3 normal;
+        Int padding;
+        Vector3 position;
+    } out[3];
+    auto outView = Containers::stridedArrayView(out);
+
+    skinInto(JointMatrices, view.slice(&Vertex::jointIds), view.slice(&Vertex::weights), view.slice(&Vertex::position), view.slice(&Vertex::normal), outView.slice(&Output::position), outView.slice(&Output::normal));
+    CORRADE_COMPARE_AS(outView.slice(&Output::position), Containers::arrayView<Vector3>({
+        {3.0f, 2.0f, 3.0f},
+        {1.5f, 0.5f, 0.0f},
+        {0.0f, -3.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(outView.slice(&Output::normal), Containers::arrayView<Vector3>({
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.5f, 0.0f},
+        {0.0f, 0.0f, 3.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void SkinTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split among several threads */
+    constexpr std::size_t VertexCount = 16*1024;
+    Containers::Array<Vector4ui> jointIds{Containers::NoInit, VertexCount};
+    Containers::Array<Vector4> weights{Containers::NoInit, VertexCount};
+    Containers::Array<Vector3> positions{Containers::NoInit, VertexCount};
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        jointIds[i] = {UnsignedInt(i%3), UnsignedInt((i + 1)%3), UnsignedInt((i + 2)%3), 0};
+        weights[i] = {0.5f, 0.3f, 0.2f, 0.0f};
+        positions[i] = {Float(i%17), Float(i%5) - 2.0f, Float(i%11)*0.5f};
+    }
+
+    Containers::Array<Vector3> out{Containers::NoInit, VertexCount};
+    Containers::Array<Vector3> outNormals{Containers::NoInit, VertexCount};
+    skinInto(JointMatrices, jointIds, weights, positions, positions, out, outNormals, data.threadCount);
+
+    /* The output should be exactly the same as single-threaded,
+       independently of the thread count, and also the same as the
+       positions-only variant */
+    Containers::Array<Vector3> expected{Containers::NoInit, VertexCount};
+    skinInto(JointMatrices, jointIds, weights, positions, expected);
+    for(std::size_t i = 0; i != VertexCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(out[i] == expected[i]);
+    }
+
+    /* And it should match the calculation done with the math library */
+    for(std::size_t i: {std::size_t{0}, std::size_t{1}, VertexCount/2, VertexCount - 1}) {
+        CORRADE_ITERATION(i);
+        const Matrix4 skinMatrix =
+            weights[i][0]*JointMatrices[jointIds[i][0]] +
+            weights[i][1]*JointMatrices[jointIds[i][1]] +
+            weights[i][2]*JointMatrices[jointIds[i][2]] +
+            weights[i][3]*JointMatrices[jointIds[i][3]];
+        CORRADE_COMPARE(out[i], skinMatrix.transformPoint(positions[i]));
+        CORRADE_COMPARE(outNormals[i], skinMatrix.rotationScaling()*positions[i]);
+    }
+}
+
+void SkinTest::wrongSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 out[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    skinInto(JointMatrices, Containers::arrayView(JointIds).prefix(2), Weights, Positions, out);
+    skinInto(JointMatrices, JointIds, Weights, Positions, Containers::arrayView(out).prefix(2));
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::skinInto(): expected joint ID, weight and output views to have 3 items but got 2, 3 and 3\n"
+        "MeshTools::skinInto(): expected joint ID, weight and output views to have 3 items but got 3, 3 and 2\n");
+}
+
+void SkinTest::wrongSizeNormals() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Vector3 outPositions[3];
+    Vector3 outNormals[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    skinInto(JointMatrices, JointIds, Weights, Positions, Containers::arrayView(Normals).prefix(2), outPositions, outNormals);
+    skinInto(JointMatrices, JointIds, Weights, Positions, Normals, outPositions, Containers::arrayView(outNormals).prefix(2));
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::skinInto(): expected normal and skinned normal views to have 3 items but got 2 and 3\n"
+        "MeshTools::skinInto(): expected normal and skinned normal views to have 3 items but got 3 and 2\n");
+}
+
+void SkinTest::jointOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector4ui jointIds[]{
+        {0, 1, 0, 0},
+        {2, 0, 3, 0},
+        {0, 0, 0, 0}
+    };
+    Vector3 out[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    skinInto(JointMatrices, jointIds, Weights, Positions, out);
+    CORRADE_COMPARE(o.str(),
+        "MeshTools::skinInto(): joint ID 3 at vertex 1 out of range for 3 joints\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SkinTest)
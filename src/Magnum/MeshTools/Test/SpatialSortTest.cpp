@@ -0,0 +1,505 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/SpatialSort.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct SpatialSortTest: TestSuite::Tester {
+    explicit SpatialSortTest();
+
+    void debugCurve();
+
+    void orderMorton();
+    void orderHilbert();
+    void orderAllSame();
+    void orderEmpty();
+    void orderThreaded();
+    void orderInvalidSize();
+
+    template<class T> void vertices();
+    void verticesNonIndexed();
+    void verticesInvalidSize();
+    void verticesOutOfBounds();
+
+    template<class T> void triangles();
+    void trianglesInvalidSize();
+    void trianglesOutOfBounds();
+
+    void verticesMeshData();
+    void verticesMeshDataRvalue();
+    void verticesMeshDataInvalid();
+    void trianglesMeshData();
+    void trianglesMeshDataInvalid();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[]{
+    {"three threads", 3},
+    {"all threads", 0}
+};
+
+SpatialSortTest::SpatialSortTest() {
+    addTests({&SpatialSortTest::debugCurve,
+
+              &SpatialSortTest::orderMorton,
+              &SpatialSortTest::orderHilbert,
+              &SpatialSortTest::orderAllSame,
+              &SpatialSortTest::orderEmpty});
+
+    addInstancedTests({&SpatialSortTest::orderThreaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&SpatialSortTest::orderInvalidSize,
+
+              &SpatialSortTest::vertices<UnsignedInt>,
+              &SpatialSortTest::vertices<UnsignedShort>,
+              &SpatialSortTest::vertices<UnsignedByte>,
+              &SpatialSortTest::verticesNonIndexed,
+              &SpatialSortTest::verticesInvalidSize,
+              &SpatialSortTest::verticesOutOfBounds,
+
+              &SpatialSortTest::triangles<UnsignedInt>,
+              &SpatialSortTest::triangles<UnsignedShort>,
+              &SpatialSortTest::triangles<UnsignedByte>,
+              &SpatialSortTest::trianglesInvalidSize,
+              &SpatialSortTest::trianglesOutOfBounds,
+
+              &SpatialSortTest::verticesMeshData,
+              &SpatialSortTest::verticesMeshDataRvalue,
+              &SpatialSortTest::verticesMeshDataInvalid,
+              &SpatialSortTest::trianglesMeshData,
+              &SpatialSortTest::trianglesMeshDataInvalid});
+}
+
+void SpatialSortTest::debugCurve() {
+    std::ostringstream out;
+    Debug{&out} << SpatialCurve::Morton << SpatialCurve(0xfe);
+    CORRADE_COMPARE(out.str(), "MeshTools::SpatialCurve::Morton MeshTools::SpatialCurve(0xfe)\n");
+}
+
+/* Corners of a cube, shuffled */
+const Vector3 CubeCorners[]{
+    {1.0f, 1.0f, 0.0f}, /* 0 */
+    {0.0f, 0.0f, 1.0f}, /* 1 */
+    {1.0f, 0.0f, 0.0f}, /* 2 */
+    {1.0f, 1.0f, 1.0f}, /* 3 */
+    {0.0f, 0.0f, 0.0f}, /* 4 */
+    {0.0f, 1.0f, 1.0f}, /* 5 */
+    {1.0f, 0.0f, 1.0f}, /* 6 */
+    {0.0f, 1.0f, 0.0f}, /* 7 */
+};
+
+void SpatialSortTest::orderMorton() {
+    UnsignedInt order[8];
+    spatialSortOrderInto(CubeCorners, order, SpatialCurve::Morton);
+
+    /* X changes fastest, Z slowest */
+    CORRADE_COMPARE_AS(Containers::arrayView(order),
+        Containers::arrayView<UnsignedInt>({4, 2, 7, 0, 1, 6, 5, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::orderHilbert() {
+    /* A 4x4x4 grid in a scrambled order, with a non-zero offset and a
+       non-uniform bounding box to verify the quantization doesn't depend on
+       either */
+    Vector3 points[64];
+    for(std::size_t i = 0; i != 64; ++i) {
+        const std::size_t j = (i*37) % 64;
+        points[i] = Vector3{Float(j % 4), Float(j/4 % 4), Float(j/16)}*2.5f + Vector3{-3.0f, 100.0f, 0.5f};
+    }
+
+    UnsignedInt order[64];
+    spatialSortOrderInto(points, order, SpatialCurve::Hilbert);
+
+    /* Every point is there exactly once */
+    bool used[64]{};
+    for(UnsignedInt i: order) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!used[i]);
+        used[i] = true;
+    }
+
+    /* Consecutive points are always neighbors */
+    for(std::size_t i = 1; i != 64; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE((Math::abs(points[order[i]] - points[order[i - 1]])).sum(), 2.5f);
+    }
+}
+
+void SpatialSortTest::orderAllSame() {
+    const Vector3 points[]{
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f},
+        {1.0f, 2.0f, 3.0f}
+    };
+
+    /* All keys are the same, the sort is stable so the order is kept */
+    UnsignedInt order[3];
+    spatialSortOrderInto(points, order);
+    CORRADE_COMPARE_AS(Containers::arrayView(order),
+        Containers::arrayView<UnsignedInt>({0, 1, 2}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::orderEmpty() {
+    spatialSortOrderInto(nullptr, nullptr);
+    CORRADE_VERIFY(true);
+}
+
+void SpatialSortTest::orderThreaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Enough points for the work to be split among multiple threads, with
+       plenty of duplicate keys to verify the sort is stable across thread
+       boundaries */
+    Containers::Array<Vector3> pointStorage{Containers::NoInit, 20000};
+    UnsignedInt state = 1;
+    for(Vector3& i: pointStorage) {
+        Float coordinates[3];
+        for(Float& j: coordinates) {
+            state = state*1664525u + 1013904223u;
+            j = Float(state >> 24);
+        }
+        i = Vector3::from(coordinates);
+    }
+    const Containers::StridedArrayView1D<const Vector3> points = Containers::stridedArrayView(pointStorage);
+
+    for(SpatialCurve curve: {SpatialCurve::Morton, SpatialCurve::Hilbert}) {
+        CORRADE_ITERATION(curve);
+
+        Containers::Array<UnsignedInt> expected{Containers::NoInit, points.size()};
+        spatialSortOrderInto(points, Containers::stridedArrayView(expected), curve, 1);
+
+        Containers::Array<UnsignedInt> actual{Containers::NoInit, points.size()};
+        spatialSortOrderInto(points, Containers::stridedArrayView(actual), curve, data.threadCount);
+
+        CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+    }
+}
+
+void SpatialSortTest::orderInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt order[7];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortOrderInto(CubeCorners, order);
+    CORRADE_COMPARE(out.str(), "MeshTools::spatialSortOrderInto(): expected output array size 8 but got 7\n");
+}
+
+template<class T> void SpatialSortTest::vertices() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    struct Vertex {
+        Vector3 position;
+        Int id;
+    } vertices[8];
+    for(std::size_t i = 0; i != 8; ++i)
+        vertices[i] = {CubeCorners[i], Int(i*10)};
+
+    T indices[]{0, 1, 2, 3, 4, 5, 6, 7, 3, 4, 0};
+
+    spatialSortVerticesInPlace(Containers::stridedArrayView(indices),
+        Containers::stridedArrayView(vertices).slice(&Vertex::position),
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(vertices)),
+        SpatialCurve::Morton);
+
+    /* Vertices are sorted and the indices remapped to point to the same
+       data */
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(vertices).slice(&Vertex::id),
+        Containers::arrayView<Int>({40, 20, 70, 0, 10, 60, 50, 30}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({3, 4, 1, 7, 0, 6, 5, 2, 7, 0, 3}),
+        TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::verticesNonIndexed() {
+    Vector3 positions[8];
+    Utility::copy(Containers::arrayView(CubeCorners), Containers::arrayView(positions));
+
+    spatialSortVerticesInPlace(positions,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(positions)),
+        SpatialCurve::Morton);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f},
+            {0.0f, 1.0f, 0.0f},
+            {1.0f, 1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 1.0f},
+            {1.0f, 1.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::verticesInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 2};
+    Int data[7]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortVerticesInPlace(indices, CubeCorners,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+    CORRADE_COMPARE(out.str(), "MeshTools::spatialSortVerticesInPlace(): expected 7 positions but got 8\n");
+}
+
+void SpatialSortTest::verticesOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{3, 1, 8};
+    Int data[8]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortVerticesInPlace(indices, CubeCorners,
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(data)));
+    CORRADE_COMPARE(out.str(), "MeshTools::spatialSortVerticesInPlace(): index 8 out of bounds for 8 elements\n");
+}
+
+template<class T> void SpatialSortTest::triangles() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f},
+        {10.0f, 0.0f, 0.0f},
+        {11.0f, 0.0f, 0.0f},
+        {10.0f, 1.0f, 0.0f},
+        {0.0f, 10.0f, 0.0f},
+        {1.0f, 10.0f, 0.0f},
+        {0.0f, 11.0f, 0.0f}
+    };
+
+    /* Triangles at +X, at the origin and at +Y, each with a different
+       rotation of the vertices */
+    T indices[]{
+        4, 5, 3,
+        0, 1, 2,
+        8, 6, 7
+    };
+
+    spatialSortTrianglesInPlace(Containers::stridedArrayView(indices), positions, SpatialCurve::Morton);
+
+    /* Triangles are sorted as a whole, keeping the winding */
+    CORRADE_COMPARE_AS(Containers::arrayView(indices),
+        Containers::arrayView<T>({
+            0, 1, 2,
+            4, 5, 3,
+            8, 6, 7
+        }), TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::trianglesInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 2, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortTrianglesInPlace(indices, CubeCorners);
+    CORRADE_COMPARE(out.str(), "MeshTools::spatialSortTrianglesInPlace(): index count not divisible by 3, got 4\n");
+}
+
+void SpatialSortTest::trianglesOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[]{0, 1, 2, 3, 9, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortTrianglesInPlace(indices, CubeCorners);
+    CORRADE_COMPARE(out.str(), "MeshTools::spatialSortTrianglesInPlace(): index 9 out of bounds for 8 elements\n");
+}
+
+void SpatialSortTest::verticesMeshData() {
+    /* Deliberately not interleaved to verify that the function will handle
+       this */
+    struct Vertex {
+        Vector3 positions[8];
+        Int ids[8]{0, 10, 20, 30, 40, 50, 60, 70};
+    } vertexData[1];
+    Utility::copy(Containers::arrayView(CubeCorners), Containers::arrayView(vertexData->positions));
+
+    const UnsignedShort indices[]{0, 1, 2, 3, 4, 5, 6, 7};
+
+    /* Deliberately not owned to verify the original data isn't modified */
+    Trade::MeshData mesh{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, vertexData, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(vertexData->positions)},
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(vertexData->ids)}
+        }};
+
+    Trade::MeshData sorted = spatialSortVertices(mesh, SpatialCurve::Morton);
+    CORRADE_COMPARE(sorted.primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE(sorted.indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(sorted.vertexCount(), 8);
+    CORRADE_COMPARE_AS(sorted.indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({3, 4, 1, 7, 0, 6, 5, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(sorted.attribute<Int>(Trade::meshAttributeCustom(42)),
+        Containers::arrayView<Int>({40, 20, 70, 0, 10, 60, 50, 30}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(sorted.attribute<Vector3>(Trade::MeshAttribute::Position)[0], Vector3{});
+
+    /* The original is untouched */
+    CORRADE_COMPARE(indices[2], 2);
+    CORRADE_COMPARE(vertexData->ids[2], 20);
+}
+
+void SpatialSortTest::verticesMeshDataRvalue() {
+    Containers::Array<char> vertexData{Containers::NoInit, sizeof(CubeCorners)};
+    Utility::copy(Containers::arrayCast<const char>(Containers::arrayView(CubeCorners)), vertexData);
+    const Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData);
+
+    Trade::MeshData mesh{MeshPrimitive::Points,
+        std::move(vertexData), {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions}
+        }};
+
+    /* Data is owned and interleaved, so it should be operated on in-place */
+    const void* originalVertexData = mesh.vertexData();
+    Trade::MeshData sorted = spatialSortVertices(std::move(mesh), SpatialCurve::Morton);
+    CORRADE_VERIFY(!sorted.isIndexed());
+    CORRADE_COMPARE(sorted.vertexData(), originalVertexData);
+    CORRADE_COMPARE_AS(sorted.attribute<Vector3>(Trade::MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.0f, 0.0f, 0.0f},
+            {1.0f, 0.0f, 0.0f},
+            {0.0f, 1.0f, 0.0f},
+            {1.0f, 1.0f, 0.0f},
+            {0.0f, 0.0f, 1.0f},
+            {1.0f, 0.0f, 1.0f},
+            {0.0f, 1.0f, 1.0f},
+            {1.0f, 1.0f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void SpatialSortTest::verticesMeshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortVertices(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    spatialSortVertices(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::spatialSortVertices(): expected an indexed mesh or a MeshPrimitive::Points but got a non-indexed MeshPrimitive::Triangles\n"
+        "MeshTools::spatialSortVertices(): the mesh has no positions\n");
+}
+
+void SpatialSortTest::trianglesMeshData() {
+    const Vector3 positions[]{
+        {0.0f, 10.0f, 0.0f},
+        {1.0f, 10.0f, 0.0f},
+        {0.0f, 11.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f}
+    };
+    const UnsignedByte indices[]{0, 1, 2, 3, 4, 5};
+
+    /* Deliberately not owned to verify the original data isn't modified */
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    Trade::MeshData sorted = spatialSortTriangles(mesh, SpatialCurve::Morton);
+    CORRADE_COMPARE(sorted.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(sorted.indexType(), MeshIndexType::UnsignedByte);
+    CORRADE_COMPARE(sorted.vertexCount(), 6);
+    CORRADE_COMPARE_AS(sorted.indices<UnsignedByte>(),
+        Containers::arrayView<UnsignedByte>({3, 4, 5, 0, 1, 2}),
+        TestSuite::Compare::Container);
+
+    /* The original is untouched */
+    CORRADE_COMPARE(indices[0], 0);
+}
+
+void SpatialSortTest::trianglesMeshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    spatialSortTriangles(Trade::MeshData{MeshPrimitive::Triangles, 3});
+    spatialSortTriangles(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    spatialSortTriangles(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::spatialSortTriangles(): mesh data not indexed\n"
+        "MeshTools::spatialSortTriangles(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::spatialSortTriangles(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SpatialSortTest)
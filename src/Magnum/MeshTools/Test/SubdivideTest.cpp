@@ -50,9 +50,26 @@ struct SubdivideTest: TestSuite::Tester {
     void subdivideInPlaceWrongIndexCount();
     void subdivideInPlaceSmallIndexType();
 
+    void subdivideSharedEdges();
+    void subdivideSharedEdgesMultipleLevels();
+    void subdivideSharedEdgesZeroLevels();
+    void subdivideSharedEdgesWrongIndexCount();
+    void subdivideSharedEdgesIndexOutOfBounds();
+
     /* this is additionally regression-tested in PrimitivesIcosphereTest */
 
     void benchmark();
+    void benchmarkSharedEdges();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
 };
 
 typedef Math::Vector<1, Int> Vector1;
@@ -73,9 +90,19 @@ SubdivideTest::SubdivideTest() {
               &SubdivideTest::subdivideInPlace<UnsignedShort>,
               &SubdivideTest::subdivideInPlace<UnsignedInt>,
               &SubdivideTest::subdivideInPlaceWrongIndexCount,
-              &SubdivideTest::subdivideInPlaceSmallIndexType});
+              &SubdivideTest::subdivideInPlaceSmallIndexType,
+
+              &SubdivideTest::subdivideSharedEdges});
+
+    addInstancedTests({&SubdivideTest::subdivideSharedEdgesMultipleLevels},
+        Containers::arraySize(ThreadedData));
 
-    addBenchmarks({&SubdivideTest::benchmark}, 4);
+    addTests({&SubdivideTest::subdivideSharedEdgesZeroLevels,
+              &SubdivideTest::subdivideSharedEdgesWrongIndexCount,
+              &SubdivideTest::subdivideSharedEdgesIndexOutOfBounds});
+
+    addBenchmarks({&SubdivideTest::benchmark,
+                   &SubdivideTest::benchmarkSharedEdges}, 4);
 }
 
 void SubdivideTest::subdivide() {
@@ -168,6 +195,98 @@ void SubdivideTest::subdivideInPlaceSmallIndexType() {
     CORRADE_COMPARE(out.str(), "MeshTools::subdivideInPlace(): a 1-byte index type is too small for 256 vertices\n");
 }
 
+void SubdivideTest::subdivideSharedEdges() {
+    auto positions = Containers::array<Vector1>({0, 2, 6, 8});
+    auto indices = Containers::array<UnsignedInt>({0, 1, 2, 1, 2, 3});
+    MeshTools::subdivideSharedEdges(indices, positions, 1, interpolator1);
+
+    /* Same as subdivide() above, except that the edge 1-2 shared by the two
+       triangles got just one new vertex and the remaining new vertices are
+       numbered in order of their first occurrence */
+    CORRADE_COMPARE_AS(indices, Containers::arrayView<UnsignedInt>({
+        4, 5, 6, 5, 7, 8, 0, 4, 6, 4, 1, 5, 6, 5, 2, 1, 5, 8, 5, 2, 7, 8, 7, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector1>({
+        0, 2, 6, 8, 1, 4, 3, 7, 5
+    }), TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedEdgesMultipleLevels() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Trade::MeshData icosphere = Primitives::icosphereSolid(0);
+
+    /* Reference output with subdivide() and deduplication after */
+    Containers::Array<UnsignedInt> expectedIndices;
+    arrayResize(expectedIndices, Containers::NoInit, icosphere.indexCount());
+    Utility::copy(icosphere.indices<UnsignedInt>(), expectedIndices);
+    Containers::Array<Vector3> expectedPositions;
+    arrayResize(expectedPositions, Containers::NoInit, icosphere.vertexCount());
+    Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), expectedPositions);
+    for(std::size_t i = 0; i != 4; ++i)
+        MeshTools::subdivide(expectedIndices, expectedPositions, interpolator3);
+    arrayResize(expectedPositions, MeshTools::removeDuplicatesIndexedInPlace(
+        Containers::stridedArrayView(expectedIndices),
+        Containers::arrayCast<2, char>(Containers::stridedArrayView(expectedPositions))));
+
+    Containers::Array<UnsignedInt> indices;
+    arrayResize(indices, Containers::NoInit, icosphere.indexCount());
+    Utility::copy(icosphere.indices<UnsignedInt>(), indices);
+    Containers::Array<Vector3> positions;
+    arrayResize(positions, Containers::NoInit, icosphere.vertexCount());
+    Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), positions);
+    MeshTools::subdivideSharedEdges(indices, positions, 4, interpolator3, data.threadCount);
+
+    /* The output should be the same bit-by-bit, including vertex order */
+    CORRADE_COMPARE(positions.size(), 2562);
+    CORRADE_COMPARE_AS(indices, expectedIndices,
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions, expectedPositions,
+        TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedEdgesZeroLevels() {
+    auto positions = Containers::array<Vector1>({0, 2, 6, 8});
+    auto indices = Containers::array<UnsignedInt>({0, 1, 2, 1, 2, 3});
+    MeshTools::subdivideSharedEdges(indices, positions, 0, interpolator1);
+
+    CORRADE_COMPARE_AS(indices, Containers::arrayView<UnsignedInt>({
+        0, 1, 2, 1, 2, 3
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(positions, Containers::arrayView<Vector1>({
+        0, 2, 6, 8
+    }), TestSuite::Compare::Container);
+}
+
+void SubdivideTest::subdivideSharedEdgesWrongIndexCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    Containers::Array<Vector1> positions{3};
+    Containers::Array<UnsignedInt> indices{2};
+    MeshTools::subdivideSharedEdges(indices, positions, 1, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedEdges(): index count is not divisible by 3\n");
+}
+
+void SubdivideTest::subdivideSharedEdgesIndexOutOfBounds() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::stringstream out;
+    Error redirectError{&out};
+
+    auto positions = Containers::array<Vector1>({0, 2, 6, 8});
+    auto indices = Containers::array<UnsignedInt>({0, 1, 2, 1, 4, 3});
+    MeshTools::subdivideSharedEdges(indices, positions, 1, interpolator1);
+    CORRADE_COMPARE(out.str(), "MeshTools::subdivideSharedEdges(): index 4 out of bounds for 4 elements\n");
+}
+
 void SubdivideTest::benchmark() {
     Trade::MeshData icosphere = Primitives::icosphereSolid(0);
 
@@ -186,6 +305,23 @@ void SubdivideTest::benchmark() {
     }
 }
 
+void SubdivideTest::benchmarkSharedEdges() {
+    Trade::MeshData icosphere = Primitives::icosphereSolid(0);
+
+    CORRADE_BENCHMARK(3) {
+        Containers::Array<UnsignedInt> indices;
+        arrayResize(indices, Containers::NoInit, icosphere.indexCount());
+        Utility::copy(icosphere.indices<UnsignedInt>(), indices);
+
+        Containers::Array<Vector3> positions;
+        arrayResize(positions, Containers::NoInit, icosphere.vertexCount());
+        Utility::copy(icosphere.attribute<Vector3>(Trade::MeshAttribute::Position), positions);
+
+        /* Subdivide 5 times, with no duplicates created along the way */
+        MeshTools::subdivideSharedEdges(indices, positions, 5, interpolator3);
+    }
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::SubdivideTest)
@@ -24,6 +24,7 @@
 */
 
 #include <array>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Math/Matrix3.h"
@@ -40,6 +41,9 @@ struct TransformTest: TestSuite::Tester {
 
     void transformPoints2D();
     void transformPoints3D();
+
+    void transformVectors3DStridedArrayView();
+    void transformPoints3DStridedArrayView();
 };
 
 TransformTest::TransformTest() {
@@ -47,7 +51,10 @@ TransformTest::TransformTest() {
               &TransformTest::transformVectors3D,
 
               &TransformTest::transformPoints2D,
-              &TransformTest::transformPoints3D});
+              &TransformTest::transformPoints3D,
+
+              &TransformTest::transformVectors3DStridedArrayView,
+              &TransformTest::transformPoints3DStridedArrayView});
 }
 
 constexpr static std::array<Vector2, 2> points2D{{
@@ -116,6 +123,42 @@ void TransformTest::transformPoints3D() {
     CORRADE_COMPARE(quaternion, points3DRotatedTranslated);
 }
 
+struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+};
+
+void TransformTest::transformVectors3DStridedArrayView() {
+    /* This goes through Math::transformVectorsInto() */
+    Vertex data[]{
+        {points3D[0], {0.5f, 0.25f}},
+        {points3D[1], {0.75f, 1.0f}}
+    };
+    MeshTools::transformVectorsInPlace(Matrix4::rotationZ(Deg(90.0f)),
+        Containers::stridedArrayView(data, &data[0].position, 2, sizeof(Vertex)));
+
+    CORRADE_COMPARE(data[0].position, points3DRotated[0]);
+    CORRADE_COMPARE(data[1].position, points3DRotated[1]);
+    CORRADE_COMPARE(data[0].textureCoordinates, (Vector2{0.5f, 0.25f}));
+    CORRADE_COMPARE(data[1].textureCoordinates, (Vector2{0.75f, 1.0f}));
+}
+
+void TransformTest::transformPoints3DStridedArrayView() {
+    /* This goes through Math::transformPointsInto() */
+    Vertex data[]{
+        {points3D[0], {0.5f, 0.25f}},
+        {points3D[1], {0.75f, 1.0f}}
+    };
+    MeshTools::transformPointsInPlace(
+        Matrix4::translation(Vector3::yAxis(-1.0f))*Matrix4::rotationZ(Deg(90.0f)),
+        Containers::stridedArrayView(data, &data[0].position, 2, sizeof(Vertex)));
+
+    CORRADE_COMPARE(data[0].position, points3DRotatedTranslated[0]);
+    CORRADE_COMPARE(data[1].position, points3DRotatedTranslated[1]);
+    CORRADE_COMPARE(data[0].textureCoordinates, (Vector2{0.5f, 0.25f}));
+    CORRADE_COMPARE(data[1].textureCoordinates, (Vector2{0.75f, 1.0f}));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TransformTest)
@@ -0,0 +1,479 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/TypeTraits.h"
+#include "Magnum/MeshTools/TriangleBvh.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools { namespace Test { namespace {
+
+struct TriangleBvhTest: TestSuite::Tester {
+    explicit TriangleBvhTest();
+
+    void nodeLayout();
+    template<class T> void build();
+    void buildLeafSize();
+    void empty();
+    void invalid();
+
+    void castRay();
+    void castRayMiss();
+    void occluded();
+    void trianglesInRange();
+    void trianglesInRanges();
+    void threaded();
+    void queryInvalid();
+
+    void meshData();
+    void meshDataNotIndexed();
+    void meshDataInvalid();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0},
+    {"more threads than items", 100000}
+};
+
+TriangleBvhTest::TriangleBvhTest() {
+    addTests({&TriangleBvhTest::nodeLayout,
+              &TriangleBvhTest::build<UnsignedByte>,
+              &TriangleBvhTest::build<UnsignedShort>,
+              &TriangleBvhTest::build<UnsignedInt>,
+              &TriangleBvhTest::buildLeafSize,
+              &TriangleBvhTest::empty,
+              &TriangleBvhTest::invalid,
+
+              &TriangleBvhTest::castRay,
+              &TriangleBvhTest::castRayMiss,
+              &TriangleBvhTest::occluded,
+              &TriangleBvhTest::trianglesInRange,
+              &TriangleBvhTest::trianglesInRanges});
+
+    addInstancedTests({&TriangleBvhTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&TriangleBvhTest::queryInvalid,
+
+              &TriangleBvhTest::meshData,
+              &TriangleBvhTest::meshDataNotIndexed,
+              &TriangleBvhTest::meshDataInvalid});
+}
+
+/* A size x size grid of unit cells on the Z = 0 plane. Cell (x, y) consists
+   of triangles 2*(y*size + x) and 2*(y*size + x) + 1, the first is below the
+   cell diagonal and the second above. */
+void grid(const UnsignedInt size, Containers::Array<UnsignedInt>& indices, Containers::Array<Vector3>& positions) {
+    positions = Containers::Array<Vector3>{Containers::NoInit, (size + 1)*(size + 1)};
+    for(UnsignedInt y = 0; y != size + 1; ++y)
+        for(UnsignedInt x = 0; x != size + 1; ++x)
+            positions[y*(size + 1) + x] = {Float(x), Float(y), 0.0f};
+
+    indices = Containers::Array<UnsignedInt>{Containers::NoInit, size*size*6};
+    for(UnsignedInt y = 0; y != size; ++y) {
+        for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt a = y*(size + 1) + x;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + size + 2;
+            const UnsignedInt d = a + size + 1;
+            const UnsignedInt cell[]{a, b, c, a, c, d};
+            for(UnsignedInt i = 0; i != 6; ++i)
+                indices[(y*size + x)*6 + i] = cell[i];
+        }
+    }
+}
+
+void TriangleBvhTest::nodeLayout() {
+    /* Two nodes in a 64-byte cache line */
+    CORRADE_COMPARE(sizeof(TriangleBvhNode), 32);
+}
+
+template<class T> void TriangleBvhTest::build() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {5.0f, 0.0f, -1.0f},
+        {6.0f, 0.0f, 2.0f},
+        {6.0f, 1.0f, 0.0f},
+    };
+    const T indices[]{3, 4, 5, 0, 1, 2};
+
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), 1);
+
+    /* A root and two leaves */
+    CORRADE_COMPARE(bvh.nodes().size(), 3);
+    CORRADE_COMPARE(bvh.nodes()[0].min, (Vector3{0.0f, 0.0f, -1.0f}));
+    CORRADE_COMPARE(bvh.nodes()[0].max, (Vector3{6.0f, 1.0f, 2.0f}));
+    CORRADE_COMPARE(bvh.nodes()[0].count, 0);
+    CORRADE_COMPARE(bvh.nodes()[0].offset, 2);
+    CORRADE_COMPARE(bvh.nodes()[1].count, 1);
+    CORRADE_COMPARE(bvh.nodes()[2].count, 1);
+
+    /* The triangle with smaller X is in the first leaf, the positions are
+       in leaf order */
+    CORRADE_COMPARE(bvh.nodes()[1].offset, 0);
+    CORRADE_COMPARE(bvh.nodes()[1].min, (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(bvh.nodes()[1].max, (Vector3{1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(bvh.nodes()[2].offset, 1);
+    CORRADE_COMPARE_AS(bvh.triangles(),
+        Containers::arrayView<UnsignedInt>({1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(bvh.positions(),
+        Containers::arrayView<Vector3>({
+            positions[0], positions[1], positions[2],
+            positions[3], positions[4], positions[5]
+        }), TestSuite::Compare::Container);
+}
+
+void TriangleBvhTest::buildLeafSize() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(16, indices, positions);
+
+    for(const UnsignedInt maxLeafSize: {1u, 4u, 16u}) {
+        CORRADE_ITERATION(maxLeafSize);
+
+        TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), maxLeafSize);
+        CORRADE_COMPARE(bvh.nodes()[0].min, (Vector3{0.0f, 0.0f, 0.0f}));
+        CORRADE_COMPARE(bvh.nodes()[0].max, (Vector3{16.0f, 16.0f, 0.0f}));
+
+        /* Each triangle is referenced by exactly one leaf */
+        Containers::Array<UnsignedInt> referenced{Containers::ValueInit, 16*16*2};
+        UnsignedInt leafTriangleCount = 0;
+        for(const TriangleBvhNode& node: bvh.nodes()) {
+            if(!node.count) continue;
+            CORRADE_COMPARE_AS(node.count, maxLeafSize,
+                TestSuite::Compare::LessOrEqual);
+            CORRADE_COMPARE(node.offset, leafTriangleCount);
+            leafTriangleCount += node.count;
+        }
+        CORRADE_COMPARE(leafTriangleCount, 16*16*2);
+        for(const UnsignedInt triangle: bvh.triangles())
+            ++referenced[triangle];
+        for(const UnsignedInt count: referenced)
+            CORRADE_COMPARE(count, 1);
+    }
+}
+
+void TriangleBvhTest::empty() {
+    TriangleBvh bvh = buildTriangleBvh(Containers::StridedArrayView1D<const UnsignedInt>{}, Containers::StridedArrayView1D<const Vector3>{});
+    CORRADE_VERIFY(bvh.nodes().isEmpty());
+    CORRADE_VERIFY(bvh.triangles().isEmpty());
+    CORRADE_VERIFY(bvh.positions().isEmpty());
+
+    CORRADE_VERIFY(!bvh.castRay({}, Vector3::zAxis()));
+    CORRADE_VERIFY(!bvh.occluded({}, Vector3::zAxis()));
+    CORRADE_VERIFY(bvh.trianglesInRange({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}).isEmpty());
+}
+
+void TriangleBvhTest::invalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector3 positions[3]{};
+    const UnsignedInt indices[]{0, 1, 2, 0};
+    const UnsignedInt indicesOutOfBounds[]{0, 1, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+    buildTriangleBvh(Containers::stridedArrayView(indices).prefix(3), Containers::stridedArrayView(positions), 0);
+    buildTriangleBvh(Containers::stridedArrayView(indicesOutOfBounds), Containers::stridedArrayView(positions));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildTriangleBvh(): index count not divisible by 3\n"
+        "MeshTools::buildTriangleBvh(): max leaf size can't be zero\n"
+        "MeshTools::buildTriangleBvh(): index 3 out of bounds for 3 elements\n");
+}
+
+void TriangleBvhTest::castRay() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+
+    /* Below the diagonal of cell (2, 3). Direction isn't normalized, so the
+       distance is in multiples of its length. */
+    TriangleBvhHit hit = bvh.castRay({2.75f, 3.25f, 5.0f}, {0.0f, 0.0f, -2.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit.triangle, 2*(3*10 + 2));
+    CORRADE_COMPARE(hit.distance, 2.5f);
+    CORRADE_COMPARE(hit.barycentric, (Vector2{0.5f, 0.25f}));
+
+    /* Above the diagonal, hit from below */
+    hit = bvh.castRay({2.25f, 3.75f, -1.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit.triangle, 2*(3*10 + 2) + 1);
+    CORRADE_COMPARE(hit.distance, 1.0f);
+    CORRADE_COMPARE(hit.barycentric, (Vector2{0.25f, 0.5f}));
+
+    /* Slanted ray */
+    hit = bvh.castRay({0.0f, 0.0f, 4.0f}, {0.6f, 0.3f, -1.0f});
+    CORRADE_VERIFY(hit);
+    CORRADE_COMPARE(hit.triangle, 2*(1*10 + 2));
+    CORRADE_COMPARE(hit.distance, 4.0f);
+}
+
+void TriangleBvhTest::castRayMiss() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+
+    /* Pointing away */
+    TriangleBvhHit hit = bvh.castRay({2.75f, 3.25f, 5.0f}, {0.0f, 0.0f, 1.0f});
+    CORRADE_VERIFY(!hit);
+    CORRADE_COMPARE(hit.triangle, ~UnsignedInt{});
+
+    /* Outside of the grid */
+    CORRADE_VERIFY(!bvh.castRay({12.0f, 3.25f, 5.0f}, {0.0f, 0.0f, -1.0f}));
+
+    /* Parallel to the grid */
+    CORRADE_VERIFY(!bvh.castRay({-1.0f, 3.25f, 1.0f}, {1.0f, 0.0f, 0.0f}));
+
+    /* Too short */
+    hit = bvh.castRay({2.75f, 3.25f, 5.0f}, {0.0f, 0.0f, -1.0f}, 4.5f);
+    CORRADE_VERIFY(!hit);
+    CORRADE_COMPARE(hit.distance, 4.5f);
+    CORRADE_VERIFY(bvh.castRay({2.75f, 3.25f, 5.0f}, {0.0f, 0.0f, -1.0f}, 5.5f));
+}
+
+void TriangleBvhTest::occluded() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+
+    /* Through the grid */
+    CORRADE_VERIFY(bvh.occluded({2.75f, 3.25f, 1.0f}, {4.25f, 6.5f, -1.0f}));
+
+    /* Both points above */
+    CORRADE_VERIFY(!bvh.occluded({2.75f, 3.25f, 1.0f}, {8.25f, 6.5f, 0.5f}));
+
+    /* Not long enough to reach the grid */
+    CORRADE_VERIFY(!bvh.occluded({2.75f, 3.25f, 1.0f}, {2.75f, 3.25f, 0.5f}));
+
+    /* Ending exactly on the surface doesn't count */
+    CORRADE_VERIFY(!bvh.occluded({2.75f, 3.25f, 1.0f}, {2.75f, 3.25f, 0.0f}));
+}
+
+void TriangleBvhTest::trianglesInRange() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+
+    /* Small box around a point below the diagonal of cell (2, 3) */
+    CORRADE_COMPARE_AS(bvh.trianglesInRange({{2.65f, 3.15f, -0.1f}, {2.85f, 3.35f, 0.1f}}),
+        Containers::arrayView<UnsignedInt>({2*(3*10 + 2)}),
+        TestSuite::Compare::Container);
+
+    /* The box overlaps the bounding box of the second triangle in the cell,
+       but not the triangle itself */
+    CORRADE_COMPARE_AS(bvh.trianglesInRange({{2.8f, 3.05f, -0.1f}, {2.95f, 3.2f, 0.1f}}),
+        Containers::arrayView<UnsignedInt>({2*(3*10 + 2)}),
+        TestSuite::Compare::Container);
+
+    /* Both triangles of the cell */
+    Containers::Array<UnsignedInt> triangles = bvh.trianglesInRange({{2.1f, 3.1f, -1.0f}, {2.9f, 3.9f, 1.0f}});
+    std::sort(triangles.begin(), triangles.end());
+    CORRADE_COMPARE_AS(triangles,
+        Containers::arrayView<UnsignedInt>({2*(3*10 + 2), 2*(3*10 + 2) + 1}),
+        TestSuite::Compare::Container);
+
+    /* Above the grid */
+    CORRADE_VERIFY(bvh.trianglesInRange({{2.1f, 3.1f, 0.5f}, {2.9f, 3.9f, 1.0f}}).isEmpty());
+}
+
+void TriangleBvhTest::trianglesInRanges() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions));
+
+    const Range3D ranges[]{
+        {{2.65f, 3.15f, -0.1f}, {2.85f, 3.35f, 0.1f}},
+        {{2.1f, 3.1f, 0.5f}, {2.9f, 3.9f, 1.0f}},
+        {{5.1f, 7.5f, -0.1f}, {5.2f, 7.9f, 0.1f}},
+    };
+    Containers::Array<UnsignedInt> offsets;
+    Containers::Array<UnsignedInt> triangles;
+    bvh.trianglesInRangesInto(ranges, offsets, triangles);
+    CORRADE_COMPARE_AS(offsets,
+        Containers::arrayView<UnsignedInt>({0, 1, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(triangles,
+        Containers::arrayView<UnsignedInt>({2*(3*10 + 2), 2*(7*10 + 5) + 1}),
+        TestSuite::Compare::Container);
+}
+
+void TriangleBvhTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough for the subtrees and the batched queries to be
+       distributed across threads */
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(64, indices, positions);
+    TriangleBvh bvh = buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), 4, data.threadCount);
+    CORRADE_COMPARE(bvh.nodes()[0].min, (Vector3{0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(bvh.nodes()[0].max, (Vector3{64.0f, 64.0f, 0.0f}));
+
+    /* A slanted ray into each cell, alternating between the two triangles.
+       Each ray hits at distance 3, the segments alternate between ending
+       before and behind the grid. */
+    const Vector3 direction{0.5f, -0.25f, -1.0f};
+    Containers::Array<Vector3> origins{Containers::NoInit, 64*64};
+    Containers::Array<Vector3> directions{Containers::DirectInit, 64*64, direction};
+    Containers::Array<Vector3> ends{Containers::NoInit, 64*64};
+    Containers::Array<UnsignedInt> expected{Containers::NoInit, 64*64};
+    for(UnsignedInt y = 0; y != 64; ++y) {
+        for(UnsignedInt x = 0; x != 64; ++x) {
+            const UnsignedInt i = y*64 + x;
+            const bool second = (x + y) % 2;
+            const Vector3 point{x + (second ? 0.2f : 0.7f), y + (second ? 0.7f : 0.2f), 0.0f};
+            origins[i] = point - direction*3.0f;
+            ends[i] = origins[i] + direction*(i % 2 ? 4.0f : 2.0f);
+            expected[i] = 2*i + second;
+        }
+    }
+
+    Containers::Array<TriangleBvhHit> hits{Containers::NoInit, 64*64};
+    bvh.castRaysInto(origins, directions, hits, Constants::inf(), data.threadCount);
+    Containers::Array<bool> occludedOut{Containers::NoInit, 64*64};
+    bvh.occludedInto(origins, ends, occludedOut, data.threadCount);
+    for(std::size_t i = 0; i != hits.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(hits[i].triangle, expected[i]);
+        CORRADE_COMPARE(hits[i].distance, 3.0f);
+        CORRADE_COMPARE(occludedOut[i], i % 2 == 1);
+    }
+}
+
+void TriangleBvhTest::queryInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    TriangleBvh bvh{{}, {}, {}};
+    const Vector3 points[3]{};
+    TriangleBvhHit hits[2];
+    bool occludedOut[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    bvh.castRaysInto(points, Containers::arrayView(points).prefix(2), hits);
+    bvh.castRaysInto(points, points, hits);
+    bvh.occludedInto(points, Containers::arrayView(points).prefix(2), occludedOut);
+    bvh.occludedInto(points, points, Containers::arrayView(occludedOut).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::TriangleBvh::castRaysInto(): expected direction and hit views to have 3 elements but got 2 and 2\n"
+        "MeshTools::TriangleBvh::castRaysInto(): expected direction and hit views to have 3 elements but got 3 and 2\n"
+        "MeshTools::TriangleBvh::occludedInto(): expected end point and output views to have 3 elements but got 2 and 3\n"
+        "MeshTools::TriangleBvh::occludedInto(): expected end point and output views to have 3 elements but got 3 and 2\n");
+}
+
+void TriangleBvhTest::meshData() {
+    Containers::Array<UnsignedInt> indices;
+    Containers::Array<Vector3> positions;
+    grid(10, indices, positions);
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    TriangleBvh bvh = buildTriangleBvh(mesh);
+    CORRADE_COMPARE(bvh.triangles().size(), 10*10*2);
+    CORRADE_COMPARE(bvh.castRay({2.75f, 3.25f, 5.0f}, {0.0f, 0.0f, -1.0f}).triangle, 2*(3*10 + 2));
+}
+
+void TriangleBvhTest::meshDataNotIndexed() {
+    const Vector3 positions[]{
+        {0.0f, 0.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {1.0f, 1.0f, 0.0f},
+        {5.0f, 0.0f, 0.0f},
+        {6.0f, 0.0f, 0.0f},
+        {6.0f, 1.0f, 0.0f},
+    };
+
+    Trade::MeshData mesh{MeshPrimitive::Triangles,
+        {}, positions, {
+            Trade::MeshAttributeData{Trade::MeshAttribute::Position,
+                Containers::arrayView(positions)}
+        }};
+
+    TriangleBvh bvh = buildTriangleBvh(mesh);
+    CORRADE_COMPARE(bvh.triangles().size(), 2);
+    CORRADE_COMPARE(bvh.castRay({5.75f, 0.25f, 1.0f}, {0.0f, 0.0f, -1.0f}).triangle, 1);
+}
+
+void TriangleBvhTest::meshDataInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    UnsignedInt indices[3]{};
+    Float data[1]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buildTriangleBvh(Trade::MeshData{MeshPrimitive::Lines,
+        {}, indices, Trade::MeshIndexData{indices}, 1});
+    buildTriangleBvh(Trade::MeshData{MeshPrimitive::Triangles,
+        {}, indices, Trade::MeshIndexData{indices},
+        {}, data, {
+            Trade::MeshAttributeData{Trade::meshAttributeCustom(42),
+                Containers::arrayView(data)}
+        }});
+    CORRADE_COMPARE(out.str(),
+        "MeshTools::buildTriangleBvh(): expected a MeshPrimitive::Triangles mesh but got MeshPrimitive::Lines\n"
+        "MeshTools::buildTriangleBvh(): the mesh has no positions\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::MeshTools::Test::TriangleBvhTest)
@@ -29,11 +29,38 @@
  * @brief Function @ref Magnum::MeshTools::transformVectorsInPlace(), @ref Magnum::MeshTools::transformVectors(), @ref Magnum::MeshTools::transformPointsInPlace(), @ref Magnum::MeshTools::transformPoints()
  */
 
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Math/DualQuaternion.h"
 #include "Magnum/Math/DualComplex.h"
+#include "Magnum/Math/TransformBatch.h"
 
 namespace Magnum { namespace MeshTools {
 
+namespace Implementation {
+/* Float matrices with anything that's convertible to a strided view of
+   3D vectors go through the batch functions in Math, the rest falls back
+   to a loop */
+template<class T, class U> using TransformBatch3D = std::integral_constant<bool, std::is_same<T, Float>::value && std::is_convertible<U&&, Corrade::Containers::StridedArrayView1D<Math::Vector3<Float>>>::value>;
+
+template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>& matrix, U&& vectors, std::false_type) {
+    for(auto& vector: vectors) vector = matrix.transformVector(vector);
+}
+template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>& matrix, U&& vectors, std::true_type) {
+    const Corrade::Containers::StridedArrayView1D<Math::Vector3<Float>> view = vectors;
+    Math::transformVectorsInto(matrix, view, view);
+}
+
+template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& matrix, U&& points, std::false_type) {
+    for(auto& point: points) point = matrix.transformPoint(point);
+}
+template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& matrix, U&& points, std::true_type) {
+    const Corrade::Containers::StridedArrayView1D<Math::Vector3<Float>> view = points;
+    Math::transformPointsInto(matrix, view, view);
+}
+
+}
+
 /**
 @brief Transform vectors in-place using given transformation
 
@@ -46,17 +73,24 @@ representations.
 Unlike in @ref transformPointsInPlace(), the transformation does not involve
 translation.
 
+If @p vectors is convertible to a
+@ref Corrade::Containers::StridedArrayView1D of @ref Magnum::Vector3 "Vector3"
+and the transformation is a @ref Magnum::Matrix4 "Matrix4", the operation is
+delegated to @ref Math::transformVectorsInto(), which processes multiple
+vectors at once using SIMD instructions.
+
 Example usage:
 
 @snippet MagnumMeshTools.cpp transformVectors
 
 @see @ref transformVectors(), @ref Matrix3::transformVector(),
     @ref Matrix4::transformVector(), @ref Complex::transformVector(),
-    @ref Quaternion::transformVectorNormalized()
+    @ref Quaternion::transformVectorNormalized(),
+    @ref Math::transformVectorsInto()
 @todo GPU transform feedback implementation (otherwise this is only bad joke)
 */
 template<class T, class U> void transformVectorsInPlace(const Math::Matrix4<T>& matrix, U&& vectors) {
-    for(auto& vector: vectors) vector = matrix.transformVector(vector);
+    Implementation::transformVectorsInPlace(matrix, std::forward<U>(vectors), Implementation::TransformBatch3D<T, U>{});
 }
 
 /** @overload */
@@ -98,16 +132,23 @@ requirements are for other transformation representations.
 Unlike in @ref transformVectorsInPlace(), the transformation also involves
 translation.
 
+If @p points is convertible to a
+@ref Corrade::Containers::StridedArrayView1D of @ref Magnum::Vector3 "Vector3"
+and the transformation is a @ref Magnum::Matrix4 "Matrix4", the operation is
+delegated to @ref Math::transformPointsInto(), which processes multiple
+points at once using SIMD instructions.
+
 Example usage:
 
 @snippet MagnumMeshTools.cpp transformPoints
 
 @see @ref transformPoints(), @ref Matrix3::transformPoint(),
     @ref Matrix4::transformPoint(),
-    @ref DualQuaternion::transformPointNormalized()
+    @ref DualQuaternion::transformPointNormalized(),
+    @ref Math::transformPointsInto()
 */
 template<class T, class U> void transformPointsInPlace(const Math::Matrix4<T>& matrix, U&& points) {
-    for(auto& point: points) point = matrix.transformPoint(point);
+    Implementation::transformPointsInPlace(matrix, std::forward<U>(points), Implementation::TransformBatch3D<T, U>{});
 }
 
 /** @overload */
@@ -0,0 +1,556 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "TriangleBvh.h"
+
+#include <algorithm>
+#include <limits>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace MeshTools {
+
+TriangleBvh::TriangleBvh(Containers::Array<TriangleBvhNode>&& nodes, Containers::Array<UnsignedInt>&& triangles, Containers::Array<Vector3>&& positions) noexcept: _nodes{std::move(nodes)}, _triangles{std::move(triangles)}, _positions{std::move(positions)} {}
+
+namespace {
+
+/* Bin count for the surface area heuristic. More bins give better splits at
+   the cost of slower builds, 16 is the usual tradeoff. */
+constexpr UnsignedInt BinCount = 16;
+
+/* Cost of traversing a node relative to intersecting a triangle */
+constexpr Float TraversalCost = 1.0f;
+
+/* Past this depth nodes are split in the middle by triangle count instead of
+   the heuristic, which bounds the total depth for pathological inputs to
+   32 + 32 levels and thus makes the fixed traversal stack below sufficient */
+constexpr UnsignedInt MaxHeuristicDepth = 32;
+constexpr std::size_t TraversalStackSize = 64;
+
+struct Bounds {
+    void extend(const Vector3& point) {
+        min = Math::min(min, point);
+        max = Math::max(max, point);
+    }
+
+    void extend(const Bounds& other) {
+        min = Math::min(min, other.min);
+        max = Math::max(max, other.max);
+    }
+
+    /* Half of the surface area, as only ratios matter */
+    Float halfArea() const {
+        const Vector3 size = max - min;
+        return size.x()*size.y() + size.y()*size.z() + size.z()*size.x();
+    }
+
+    Vector3 min{Constants::inf()};
+    Vector3 max{-Constants::inf()};
+};
+
+struct BuildState {
+    Containers::ArrayView<const Bounds> bounds;
+    Containers::ArrayView<const Vector3> centroids;
+    Containers::ArrayView<UnsignedInt> triangles;
+    UnsignedInt maxLeafSize;
+};
+
+inline UnsignedInt binIndex(const Float centroid, const Float min, const Float scale) {
+    return Math::min(UnsignedInt((centroid - min)*scale), BinCount - 1);
+}
+
+/* Partitions the triangle range and returns the split point, or begin if the
+   node should be a leaf */
+UnsignedInt split(const BuildState& state, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, const Bounds& bounds, const Bounds& centroidBounds) {
+    const UnsignedInt count = end - begin;
+    UnsignedInt* const triangles = state.triangles.data();
+    const Vector3 extent = centroidBounds.max - centroidBounds.min;
+
+    /* All centroids in a single point or the tree got too deep, split in the
+       middle along the largest axis if the node is too large for a leaf */
+    if(depth >= MaxHeuristicDepth || extent.max() <= 0.0f) {
+        if(count <= state.maxLeafSize) return begin;
+
+        const UnsignedInt axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0 : extent.y() >= extent.z() ? 1 : 2;
+        const UnsignedInt mid = begin + count/2;
+        std::nth_element(triangles + begin, triangles + mid, triangles + end, [&](UnsignedInt a, UnsignedInt b) {
+            return state.centroids[a][axis] < state.centroids[b][axis];
+        });
+        return mid;
+    }
+
+    /* Find the cheapest split across binned centroids on all axes */
+    Float bestCost = Constants::inf();
+    UnsignedInt bestAxis = 0;
+    UnsignedInt bestBin = 0;
+    for(UnsignedInt axis = 0; axis != 3; ++axis) {
+        if(extent[axis] <= 0.0f) continue;
+
+        const Float scale = BinCount/extent[axis];
+        Bounds binBounds[BinCount];
+        UnsignedInt binCounts[BinCount]{};
+        for(UnsignedInt i = begin; i != end; ++i) {
+            const UnsignedInt triangle = triangles[i];
+            const UnsignedInt bin = binIndex(state.centroids[triangle][axis], centroidBounds.min[axis], scale);
+            ++binCounts[bin];
+            binBounds[bin].extend(state.bounds[triangle]);
+        }
+
+        /* Sweep from the right to get the area and count right of each
+           split plane, then from the left to evaluate the cost */
+        Float rightAreas[BinCount - 1];
+        UnsignedInt rightCounts[BinCount - 1];
+        Bounds right;
+        UnsignedInt rightCount = 0;
+        for(UnsignedInt i = BinCount - 1; i != 0; --i) {
+            right.extend(binBounds[i]);
+            rightCount += binCounts[i];
+            rightAreas[i - 1] = right.halfArea();
+            rightCounts[i - 1] = rightCount;
+        }
+
+        Bounds left;
+        UnsignedInt leftCount = 0;
+        for(UnsignedInt i = 0; i != BinCount - 1; ++i) {
+            left.extend(binBounds[i]);
+            leftCount += binCounts[i];
+            if(!leftCount || !rightCounts[i]) continue;
+
+            const Float cost = leftCount*left.halfArea() + rightCounts[i]*rightAreas[i];
+            if(cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = i;
+            }
+        }
+    }
+
+    /* Make a leaf if it's small enough and splitting wouldn't be cheaper */
+    const Float area = bounds.halfArea();
+    if(count <= state.maxLeafSize && count*area <= TraversalCost*area + bestCost)
+        return begin;
+
+    /* The first and last bin are always non-empty, so a split was always
+       found and both sides are non-empty */
+    const Float scale = BinCount/extent[bestAxis];
+    return std::partition(triangles + begin, triangles + end, [&](UnsignedInt triangle) {
+        return binIndex(state.centroids[triangle][bestAxis], centroidBounds.min[bestAxis], scale) <= bestBin;
+    }) - triangles;
+}
+
+/* Appends a subtree to nodes in depth-first order. Inner node offsets are
+   relative to the start of the nodes array. */
+void buildInto(const BuildState& state, Containers::Array<TriangleBvhNode>& nodes, const UnsignedInt begin, const UnsignedInt end, const UnsignedInt depth, const UnsignedInt parallelDepth) {
+    Bounds bounds, centroidBounds;
+    for(UnsignedInt i = begin; i != end; ++i) {
+        const UnsignedInt triangle = state.triangles[i];
+        bounds.extend(state.bounds[triangle]);
+        centroidBounds.extend(state.centroids[triangle]);
+    }
+
+    const std::size_t nodeId = nodes.size();
+    arrayAppend(nodes, TriangleBvhNode{bounds.min, begin, bounds.max, end - begin});
+    if(end - begin == 1) return;
+
+    const UnsignedInt mid = split(state, begin, end, depth, bounds, centroidBounds);
+    if(mid == begin) return;
+
+    /* Build large enough subtrees in parallel, each into its own array,
+       and then append them with inner node offsets adjusted */
+    if(parallelDepth && end - begin >= 2*Magnum::Implementation::MinItemsPerThread) {
+        Containers::Array<TriangleBvhNode> children[2];
+        Magnum::Implementation::runOnThreads(2, [&](const UnsignedInt thread) {
+            buildInto(state, children[thread], thread ? mid : begin, thread ? end : mid, depth + 1, parallelDepth - 1);
+        });
+
+        arrayReserve(nodes, nodes.size() + children[0].size() + children[1].size());
+        for(UnsignedInt i = 0; i != 2; ++i) {
+            const UnsignedInt offset = nodes.size();
+            if(i == 1) nodes[nodeId].offset = offset;
+            for(TriangleBvhNode node: children[i]) {
+                if(!node.count) node.offset += offset;
+                arrayAppend(nodes, node);
+            }
+        }
+    } else {
+        buildInto(state, nodes, begin, mid, depth + 1, 0);
+        nodes[nodeId].offset = nodes.size();
+        buildInto(state, nodes, mid, end, depth + 1, 0);
+    }
+
+    nodes[nodeId].count = 0;
+}
+
+template<class T> TriangleBvh buildTriangleBvhImplementation(const Containers::StridedArrayView1D<const T>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "MeshTools::buildTriangleBvh(): index count not divisible by 3", (TriangleBvh{{}, {}, {}}));
+    CORRADE_ASSERT(maxLeafSize,
+        "MeshTools::buildTriangleBvh(): max leaf size can't be zero", (TriangleBvh{{}, {}, {}}));
+    #ifndef CORRADE_NO_ASSERT
+    for(const T index: indices)
+        CORRADE_ASSERT(index < positions.size(),
+            "MeshTools::buildTriangleBvh(): index" << index << "out of bounds for" << positions.size() << "elements", (TriangleBvh{{}, {}, {}}));
+    #endif
+
+    const std::size_t triangleCount = indices.size()/3;
+    if(!triangleCount) return TriangleBvh{{}, {}, {}};
+
+    const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), triangleCount);
+
+    /* Per-triangle bounds and centroids */
+    Containers::Array<Bounds> bounds{Containers::NoInit, triangleCount};
+    Containers::Array<Vector3> centroids{Containers::NoInit, triangleCount};
+    Containers::Array<UnsignedInt> triangles{Containers::NoInit, triangleCount};
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, actualThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i) {
+            Bounds& triangleBounds = bounds[i];
+            triangleBounds = Bounds{};
+            for(std::size_t j = 0; j != 3; ++j)
+                triangleBounds.extend(positions[indices[i*3 + j]]);
+            centroids[i] = (triangleBounds.min + triangleBounds.max)*0.5f;
+            triangles[i] = i;
+        }
+    });
+
+    /* The subtrees get split among threads at the top levels of the tree */
+    UnsignedInt parallelDepth = 0;
+    while((1u << parallelDepth) < actualThreadCount) ++parallelDepth;
+
+    Containers::Array<TriangleBvhNode> nodes;
+    arrayReserve(nodes, 2*(triangleCount/maxLeafSize) + 1);
+    buildInto(BuildState{bounds, centroids, triangles, maxLeafSize}, nodes, 0, triangleCount, 0, parallelDepth);
+
+    /* Copy the positions in leaf order so the leaf triangles are contiguous
+       in memory */
+    Containers::Array<Vector3> leafPositions{Containers::NoInit, triangleCount*3};
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(triangleCount, actualThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i)
+            for(std::size_t j = 0; j != 3; ++j)
+                leafPositions[i*3 + j] = positions[indices[triangles[i]*3 + j]];
+    });
+
+    /* Convert back to an array with a default deleter */
+    arrayShrink(nodes, Containers::DefaultInit);
+    return TriangleBvh{std::move(nodes), std::move(triangles), std::move(leafPositions)};
+}
+
+/* Zero direction components would result in 0*inf = NaN for rays starting
+   exactly on a slab boundary, a large finite value behaves correctly */
+Vector3 inverseDirection(const Vector3& direction) {
+    Vector3 out{Math::NoInit};
+    for(std::size_t i = 0; i != 3; ++i)
+        out[i] = direction[i] == 0.0f ? std::numeric_limits<Float>::max() : 1.0f/direction[i];
+    return out;
+}
+
+/* Returns the distance where the ray enters the node or infinity if it
+   doesn't hit it before maxDistance */
+inline Float rayNode(const TriangleBvhNode& node, const Vector3& origin, const Vector3& inverseDirection, const Float maxDistance) {
+    const Vector3 t0 = (node.min - origin)*inverseDirection;
+    const Vector3 t1 = (node.max - origin)*inverseDirection;
+    const Float entry = Math::max(Vector3{Math::min(t0, t1)}.max(), 0.0f);
+    const Float exit = Math::min(Vector3{Math::max(t0, t1)}.min(), maxDistance);
+    return entry <= exit ? entry : Constants::inf();
+}
+
+/* Möller-Trumbore, triangles are hit from both sides */
+inline bool rayTriangle(const Vector3& origin, const Vector3& direction, const Vector3* const triangle, Float& distance, Vector2& barycentric) {
+    const Vector3 edge1 = triangle[1] - triangle[0];
+    const Vector3 edge2 = triangle[2] - triangle[0];
+    const Vector3 p = Math::cross(direction, edge2);
+    const Float determinant = Math::dot(edge1, p);
+    /* Ray parallel to the triangle or the triangle is degenerate */
+    if(determinant == 0.0f) return false;
+
+    const Float inverseDeterminant = 1.0f/determinant;
+    const Vector3 s = origin - triangle[0];
+    const Float u = Math::dot(s, p)*inverseDeterminant;
+    if(u < 0.0f || u > 1.0f) return false;
+
+    const Vector3 q = Math::cross(s, edge1);
+    const Float v = Math::dot(direction, q)*inverseDeterminant;
+    if(v < 0.0f || u + v > 1.0f) return false;
+
+    distance = Math::dot(edge2, q)*inverseDeterminant;
+    barycentric = {u, v};
+    return true;
+}
+
+/* Separating axis test of a triangle and a box given by a center and half
+   size */
+bool triangleBox(const Vector3* const triangle, const Vector3& center, const Vector3& halfSize) {
+    const Vector3 v[]{triangle[0] - center, triangle[1] - center, triangle[2] - center};
+
+    /* Box face normals */
+    for(std::size_t i = 0; i != 3; ++i) {
+        if(Math::min(Math::min(v[0][i], v[1][i]), v[2][i]) > halfSize[i] ||
+           Math::max(Math::max(v[0][i], v[1][i]), v[2][i]) < -halfSize[i])
+            return false;
+    }
+
+    const auto separated = [&](const Vector3& axis) {
+        const Float p0 = Math::dot(v[0], axis);
+        const Float p1 = Math::dot(v[1], axis);
+        const Float p2 = Math::dot(v[2], axis);
+        const Float r = Math::dot(halfSize, Math::abs(axis));
+        return Math::min(Math::min(p0, p1), p2) > r ||
+               Math::max(Math::max(p0, p1), p2) < -r;
+    };
+
+    /* Triangle normal */
+    const Vector3 edges[]{v[1] - v[0], v[2] - v[1], v[0] - v[2]};
+    if(separated(Math::cross(edges[0], edges[1]))) return false;
+
+    /* Cross products of triangle edges and box axes */
+    for(const Vector3& edge: edges) {
+        if(separated({0.0f, -edge.z(), edge.y()}) ||
+           separated({edge.z(), 0.0f, -edge.x()}) ||
+           separated({-edge.y(), edge.x(), 0.0f}))
+            return false;
+    }
+
+    return true;
+}
+
+inline bool nodeBox(const TriangleBvhNode& node, const Range3D& range) {
+    return (node.min <= range.max()).all() && (node.max >= range.min()).all();
+}
+
+}
+
+TriangleBvhHit TriangleBvh::castRay(const Vector3& origin, const Vector3& direction, const Float maxDistance) const {
+    TriangleBvhHit hit{~UnsignedInt{}, maxDistance, {}};
+    const Vector3 inverse = inverseDirection(direction);
+    if(_nodes.isEmpty() || rayNode(_nodes[0], origin, inverse, maxDistance) == Constants::inf())
+        return hit;
+
+    /* Nodes to visit later along with their entry distance, so they can be
+       skipped if a closer hit was found meanwhile */
+    std::pair<UnsignedInt, Float> stack[TraversalStackSize];
+    std::size_t stackSize = 0;
+    UnsignedInt nodeId = 0;
+    for(;;) {
+        const TriangleBvhNode& node = _nodes[nodeId];
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                Float distance;
+                Vector2 barycentric;
+                if(rayTriangle(origin, direction, _positions.data() + i*3, distance, barycentric) && distance >= 0.0f && distance < hit.distance) {
+                    hit.triangle = _triangles[i];
+                    hit.distance = distance;
+                    hit.barycentric = barycentric;
+                }
+            }
+        } else {
+            /* Visit the closer child first */
+            UnsignedInt first = nodeId + 1;
+            UnsignedInt second = node.offset;
+            Float firstDistance = rayNode(_nodes[first], origin, inverse, hit.distance);
+            Float secondDistance = rayNode(_nodes[second], origin, inverse, hit.distance);
+            if(secondDistance < firstDistance) {
+                std::swap(first, second);
+                std::swap(firstDistance, secondDistance);
+            }
+
+            if(firstDistance != Constants::inf()) {
+                if(secondDistance != Constants::inf())
+                    stack[stackSize++] = {second, secondDistance};
+                nodeId = first;
+                continue;
+            }
+        }
+
+        /* Pop the next node that can still contain a closer hit */
+        while(stackSize && stack[stackSize - 1].second >= hit.distance)
+            --stackSize;
+        if(!stackSize) break;
+        nodeId = stack[--stackSize].first;
+    }
+
+    return hit;
+}
+
+void TriangleBvh::castRaysInto(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<TriangleBvhHit>& hits, const Float maxDistance, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(directions.size() == origins.size() && hits.size() == origins.size(),
+        "MeshTools::TriangleBvh::castRaysInto(): expected direction and hit views to have" << origins.size() << "elements but got" << directions.size() << "and" << hits.size(), );
+
+    const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), origins.size());
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(origins.size(), actualThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i)
+            hits[i] = castRay(origins[i], directions[i], maxDistance);
+    });
+}
+
+bool TriangleBvh::occluded(const Vector3& from, const Vector3& to) const {
+    const Vector3 direction = to - from;
+    const Vector3 inverse = inverseDirection(direction);
+    if(_nodes.isEmpty() || rayNode(_nodes[0], from, inverse, 1.0f) == Constants::inf())
+        return false;
+
+    UnsignedInt stack[TraversalStackSize];
+    std::size_t stackSize = 0;
+    UnsignedInt nodeId = 0;
+    for(;;) {
+        const TriangleBvhNode& node = _nodes[nodeId];
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i) {
+                Float distance;
+                Vector2 barycentric;
+                if(rayTriangle(from, direction, _positions.data() + i*3, distance, barycentric) && distance > 0.0f && distance < 1.0f)
+                    return true;
+            }
+        } else {
+            const bool first = rayNode(_nodes[nodeId + 1], from, inverse, 1.0f) != Constants::inf();
+            const bool second = rayNode(_nodes[node.offset], from, inverse, 1.0f) != Constants::inf();
+            if(first) {
+                if(second) stack[stackSize++] = node.offset;
+                nodeId = nodeId + 1;
+                continue;
+            }
+            if(second) {
+                nodeId = node.offset;
+                continue;
+            }
+        }
+
+        if(!stackSize) break;
+        nodeId = stack[--stackSize];
+    }
+
+    return false;
+}
+
+void TriangleBvh::occludedInto(const Containers::StridedArrayView1D<const Vector3>& from, const Containers::StridedArrayView1D<const Vector3>& to, const Containers::StridedArrayView1D<bool>& occluded, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(to.size() == from.size() && occluded.size() == from.size(),
+        "MeshTools::TriangleBvh::occludedInto(): expected end point and output views to have" << from.size() << "elements but got" << to.size() << "and" << occluded.size(), );
+
+    const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), from.size());
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(from.size(), actualThreadCount, thread);
+        for(std::size_t i = range.first; i != range.second; ++i)
+            occluded[i] = this->occluded(from[i], to[i]);
+    });
+}
+
+namespace {
+
+void trianglesInRangeInto(const Containers::ArrayView<const TriangleBvhNode> nodes, const Containers::ArrayView<const UnsignedInt> triangles, const Containers::ArrayView<const Vector3> positions, const Range3D& range, Containers::Array<UnsignedInt>& out) {
+    if(nodes.isEmpty() || !nodeBox(nodes[0], range)) return;
+
+    const Vector3 center = range.center();
+    const Vector3 halfSize = range.size()*0.5f;
+
+    /* Visiting the first child first keeps the output in leaf order */
+    UnsignedInt stack[TraversalStackSize];
+    std::size_t stackSize = 0;
+    UnsignedInt nodeId = 0;
+    for(;;) {
+        const TriangleBvhNode& node = nodes[nodeId];
+        if(node.count) {
+            for(UnsignedInt i = node.offset, end = node.offset + node.count; i != end; ++i)
+                if(triangleBox(positions.data() + i*3, center, halfSize))
+                    arrayAppend(out, triangles[i]);
+        } else {
+            const bool first = nodeBox(nodes[nodeId + 1], range);
+            const bool second = nodeBox(nodes[node.offset], range);
+            if(first) {
+                if(second) stack[stackSize++] = node.offset;
+                nodeId = nodeId + 1;
+                continue;
+            }
+            if(second) {
+                nodeId = node.offset;
+                continue;
+            }
+        }
+
+        if(!stackSize) break;
+        nodeId = stack[--stackSize];
+    }
+}
+
+}
+
+Containers::Array<UnsignedInt> TriangleBvh::trianglesInRange(const Range3D& range) const {
+    Containers::Array<UnsignedInt> out;
+    trianglesInRangeInto(_nodes, _triangles, _positions, range, out);
+
+    /* Convert back to an array with a default deleter */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+void TriangleBvh::trianglesInRangesInto(const Containers::StridedArrayView1D<const Range3D>& ranges, Containers::Array<UnsignedInt>& offsets, Containers::Array<UnsignedInt>& triangles) const {
+    offsets = Containers::Array<UnsignedInt>{Containers::NoInit, ranges.size() + 1};
+    triangles = {};
+    for(std::size_t i = 0; i != ranges.size(); ++i) {
+        offsets[i] = triangles.size();
+        trianglesInRangeInto(_nodes, _triangles, _positions, ranges[i], triangles);
+    }
+    offsets[ranges.size()] = triangles.size();
+
+    /* Convert back to an array with a default deleter */
+    arrayShrink(triangles, Containers::DefaultInit);
+}
+
+TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    return buildTriangleBvhImplementation(indices, positions, maxLeafSize, threadCount);
+}
+
+TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    return buildTriangleBvhImplementation(indices, positions, maxLeafSize, threadCount);
+}
+
+TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    return buildTriangleBvhImplementation(indices, positions, maxLeafSize, threadCount);
+}
+
+TriangleBvh buildTriangleBvh(const Trade::MeshData& mesh, const UnsignedInt maxLeafSize, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(mesh.primitive() == MeshPrimitive::Triangles,
+        "MeshTools::buildTriangleBvh(): expected a MeshPrimitive::Triangles mesh but got" << mesh.primitive(),
+        (TriangleBvh{{}, {}, {}}));
+    CORRADE_ASSERT(mesh.hasAttribute(Trade::MeshAttribute::Position),
+        "MeshTools::buildTriangleBvh(): the mesh has no positions",
+        (TriangleBvh{{}, {}, {}}));
+
+    Containers::Array<UnsignedInt> indices;
+    if(mesh.isIndexed()) indices = mesh.indicesAsArray();
+    else {
+        indices = Containers::Array<UnsignedInt>{Containers::NoInit, mesh.vertexCount()};
+        for(UnsignedInt i = 0; i != indices.size(); ++i) indices[i] = i;
+    }
+    const Containers::Array<Vector3> positions = mesh.positions3DAsArray();
+    return buildTriangleBvh(Containers::stridedArrayView(indices), Containers::stridedArrayView(positions), maxLeafSize, threadCount);
+}
+
+}}
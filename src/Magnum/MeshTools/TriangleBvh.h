@@ -0,0 +1,290 @@
+#ifndef Magnum_MeshTools_TriangleBvh_h
+#define Magnum_MeshTools_TriangleBvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::MeshTools::TriangleBvhNode, @ref Magnum::MeshTools::TriangleBvhHit, class @ref Magnum::MeshTools::TriangleBvh, function @ref Magnum::MeshTools::buildTriangleBvh()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/MeshTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace MeshTools {
+
+/**
+@brief Triangle BVH node
+@m_since_latest
+
+A node of a @ref TriangleBvh. The nodes are stored in a single flat array in a
+depth-first order, with the first child of an inner node directly following
+its parent, so traversal needs only one index per node. Each node is 32 bytes,
+meaning two nodes fit into a 64-byte cache line.
+*/
+struct TriangleBvhNode {
+    /** @brief Minimal corner of the node bounding box */
+    Vector3 min;
+
+    /**
+     * @brief Offset
+     *
+     * For a leaf node it's the offset of the first triangle in
+     * @ref TriangleBvh::triangles(), for an inner node it's index of the
+     * second child in @ref TriangleBvh::nodes(). The first child is always
+     * directly after the node.
+     */
+    UnsignedInt offset;
+
+    /** @brief Maximal corner of the node bounding box */
+    Vector3 max;
+
+    /**
+     * @brief Triangle count
+     *
+     * Count of triangles in a leaf node, @cpp 0 @ce for an inner node.
+     */
+    UnsignedInt count;
+};
+
+/**
+@brief Triangle BVH ray hit
+@m_since_latest
+
+Returned by @ref TriangleBvh::castRay() and @ref TriangleBvh::castRaysInto().
+*/
+struct TriangleBvhHit {
+    /**
+     * @brief Triangle ID
+     *
+     * Index of the hit triangle in the original mesh, i.e. the triangle
+     * starting at index @cpp 3*triangle @ce in the index buffer. If nothing
+     * was hit, it's @cpp 0xffffffffu @ce.
+     */
+    UnsignedInt triangle;
+
+    /**
+     * @brief Hit distance
+     *
+     * Distance along the ray in multiples of the ray direction length, i.e.
+     * the hit point is @cpp origin + direction*distance @ce.
+     */
+    Float distance;
+
+    /**
+     * @brief Barycentric coordinates of the hit point
+     *
+     * Weights of the second and third triangle vertex, weight of the first
+     * vertex is @cpp 1.0f - barycentric.sum() @ce.
+     */
+    Vector2 barycentric;
+
+    /** @brief Whether anything was hit */
+    explicit operator bool() const { return triangle != ~UnsignedInt{}; }
+};
+
+/**
+@brief Triangle bounding volume hierarchy
+@m_since_latest
+
+Returned by @ref buildTriangleBvh(). Accelerates ray casts and box queries
+against a triangle mesh on the CPU, making them logarithmic instead of linear
+in the triangle count. The structure is self-contained --- triangle positions
+are copied into it in the order leaves reference them, so the original mesh
+doesn't need to be kept around and the leaf triangles are contiguous in
+memory.
+
+All queries are @cpp const @ce and thus safe to call from multiple threads at
+once. The batched @ref castRaysInto() and @ref occludedInto() can distribute
+the work across threads on their own.
+@see @ref Math::Intersection
+*/
+class MAGNUM_MESHTOOLS_EXPORT TriangleBvh {
+    public:
+        /**
+         * @brief Constructor
+         * @param nodes         Nodes in a depth-first order
+         * @param triangles     Original triangle IDs in leaf order
+         * @param positions     Triangle vertex positions in leaf order,
+         *      three for each item of @p triangles
+         */
+        explicit TriangleBvh(Containers::Array<TriangleBvhNode>&& nodes, Containers::Array<UnsignedInt>&& triangles, Containers::Array<Vector3>&& positions) noexcept;
+
+        /**
+         * @brief Nodes
+         *
+         * The first node is the root, its bounds are the bounds of the whole
+         * mesh. Empty if the mesh had no triangles.
+         */
+        Containers::ArrayView<const TriangleBvhNode> nodes() const { return _nodes; }
+
+        /**
+         * @brief Triangle IDs
+         *
+         * Indices of triangles in the original mesh, ranges of which are
+         * referenced by @ref TriangleBvhNode::offset and
+         * @ref TriangleBvhNode::count of leaf nodes.
+         */
+        Containers::ArrayView<const UnsignedInt> triangles() const { return _triangles; }
+
+        /**
+         * @brief Triangle positions
+         *
+         * Positions of triangle vertices in the same order as
+         * @ref triangles(), three for each triangle.
+         */
+        Containers::ArrayView<const Vector3> positions() const { return _positions; }
+
+        /**
+         * @brief Cast a ray
+         * @param origin        Ray origin
+         * @param direction     Ray direction, doesn't need to be normalized
+         * @param maxDistance   Max distance in multiples of @p direction
+         *      length
+         *
+         * Returns the closest hit in the range @f$ [0, d_{max}) @f$, if any.
+         * Triangles are hit from both sides.
+         */
+        TriangleBvhHit castRay(const Vector3& origin, const Vector3& direction, Float maxDistance = Constants::inf()) const;
+
+        /**
+         * @brief Cast multiple rays
+         * @param origins       Ray origins
+         * @param directions    Ray directions
+         * @param hits          Where to put the hits
+         * @param maxDistance   Max distance in multiples of direction length
+         * @param threadCount   Count of threads to use. If @cpp 0 @ce, the
+         *      value of @ref std::thread::hardware_concurrency() is used.
+         *
+         * Equivalent to calling @ref castRay() for each item. Expects that
+         * all views have the same size.
+         */
+        void castRaysInto(const Containers::StridedArrayView1D<const Vector3>& origins, const Containers::StridedArrayView1D<const Vector3>& directions, const Containers::StridedArrayView1D<TriangleBvhHit>& hits, Float maxDistance = Constants::inf(), UnsignedInt threadCount = 1) const;
+
+        /**
+         * @brief Whether a segment is occluded
+         *
+         * Returns @cpp true @ce if any triangle intersects the line segment
+         * between @p from and @p to, excluding the endpoints themselves.
+         * Stops at the first hit found, which makes it faster than
+         * @ref castRay() for line-of-sight checks.
+         */
+        bool occluded(const Vector3& from, const Vector3& to) const;
+
+        /**
+         * @brief Check occlusion of multiple segments
+         * @param from          Segment start points
+         * @param to            Segment end points
+         * @param occluded      Where to put the results
+         * @param threadCount   Count of threads to use. If @cpp 0 @ce, the
+         *      value of @ref std::thread::hardware_concurrency() is used.
+         *
+         * Equivalent to calling @ref occluded(const Vector3&, const Vector3&) const
+         * for each item. Expects that all views have the same size.
+         */
+        void occludedInto(const Containers::StridedArrayView1D<const Vector3>& from, const Containers::StridedArrayView1D<const Vector3>& to, const Containers::StridedArrayView1D<bool>& occluded, UnsignedInt threadCount = 1) const;
+
+        /**
+         * @brief Triangles intersecting a box
+         *
+         * Returns IDs of all triangles that intersect or are contained in
+         * @p range, in the order they're stored in @ref triangles(). The
+         * test is exact, not just against triangle bounding boxes.
+         */
+        Containers::Array<UnsignedInt> trianglesInRange(const Range3D& range) const;
+
+        /**
+         * @brief Triangles intersecting multiple boxes
+         * @param[in] ranges    Boxes to query
+         * @param[out] offsets  Offsets into @p triangles
+         * @param[out] triangles Triangle IDs
+         *
+         * Triangle IDs for range @cpp i @ce are in
+         * @cpp triangles.slice(offsets[i], offsets[i + 1]) @ce. Both arrays
+         * are replaced with new ones, @p offsets having
+         * @cpp ranges.size() + 1 @ce items. See @ref trianglesInRange() for
+         * more information.
+         */
+        void trianglesInRangesInto(const Containers::StridedArrayView1D<const Range3D>& ranges, Containers::Array<UnsignedInt>& offsets, Containers::Array<UnsignedInt>& triangles) const;
+
+    private:
+        Containers::Array<TriangleBvhNode> _nodes;
+        Containers::Array<UnsignedInt> _triangles;
+        Containers::Array<Vector3> _positions;
+};
+
+/**
+@brief Build a triangle BVH
+@param indices          Triangle indices
+@param positions        Vertex positions
+@param maxLeafSize      Max triangle count in a leaf node
+@param threadCount      Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Builds the hierarchy top-down, splitting each node using a binned surface
+area heuristic over triangle centroids on all three axes. A node is made a
+leaf once splitting it further wouldn't be cheaper according to the
+heuristic, but it never has more than @p maxLeafSize triangles. With more
+than one thread, independent subtrees are built in parallel.
+
+Expects that the index count is divisible by 3, all indices are less than
+size of @p positions and @p maxLeafSize is not zero.
+*/
+MAGNUM_MESHTOOLS_EXPORT TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedInt>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedShort>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+/**
+ * @overload
+ * @m_since_latest
+ */
+MAGNUM_MESHTOOLS_EXPORT TriangleBvh buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedByte>& indices, const Containers::StridedArrayView1D<const Vector3>& positions, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+/**
+@brief Build a triangle BVH for mesh data
+@m_since_latest
+
+Expects that the mesh is a @ref MeshPrimitive::Triangles and has a
+@ref Trade::MeshAttribute::Position. Calls @ref buildTriangleBvh(const Containers::StridedArrayView1D<const UnsignedInt>&, const Containers::StridedArrayView1D<const Vector3>&, UnsignedInt, UnsignedInt)
+with indices and positions converted using @ref Trade::MeshData::indicesAsArray()
+and @ref Trade::MeshData::positions3DAsArray(). If the mesh is not indexed,
+the vertices are treated as consecutive triangles.
+*/
+MAGNUM_MESHTOOLS_EXPORT TriangleBvh buildTriangleBvh(const Trade::MeshData& mesh, UnsignedInt maxLeafSize = 4, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
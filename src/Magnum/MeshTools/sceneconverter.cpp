@@ -24,10 +24,15 @@
 */
 
 #include <algorithm>
-#include <chrono>
+#include <atomic>
+#include <mutex>
 #include <set>
 #include <sstream>
+#include <thread>
+#include <utility>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -37,8 +42,12 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/converterUtilities.h"
 #include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/FunctionsBatch.h"
+#include "Magnum/MeshTools/Meshletize.h"
+#include "Magnum/MeshTools/Optimize.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
+#include "Magnum/MeshTools/Simplify.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/LightData.h"
 #include "Magnum/Trade/MaterialData.h"
@@ -80,6 +89,8 @@ magnum-sceneconverter [-h|--help] [-I|--importer IMPORTER]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…]... [--mesh MESH]
     [--level LEVEL] [--info] [--bounds] [-v|--verbose] [--profile]
+    [--simplify RATIO] [--optimize-vertex-cache] [--optimize-overdraw]
+    [--meshletize] [--optimize-vertex-fetch] [--all-meshes] [--threads N]
     [--] input output
 @endcode
 
@@ -108,7 +119,23 @@ Arguments:
 -   `--info` --- print info about the input file and exit
 -   `--bounds` --- show bounds of known attributes in `--info` output
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
--   `--profile` --- measure import and conversion time
+-   `--profile` --- measure import and conversion time, together with a
+    breakdown of the import into file loading, file opening and import of
+    particular data
+-   `--simplify RATIO` --- simplify the mesh to given ratio of the original
+    index count using @ref MeshTools::simplify(const Trade::MeshData&, UnsignedInt, Float)
+-   `--optimize-vertex-cache` --- optimize the mesh for the post-transform
+    vertex cache using @ref MeshTools::optimizeVertexCache(const Trade::MeshData&, UnsignedInt)
+-   `--optimize-overdraw` --- optimize the mesh for reduced overdraw using
+    @ref MeshTools::optimizeOverdraw(const Trade::MeshData&, UnsignedInt)
+-   `--meshletize` --- reorder the mesh triangles into meshlets using
+    @ref MeshTools::meshletize(const Trade::MeshData&, UnsignedInt, UnsignedInt)
+-   `--optimize-vertex-fetch` --- optimize the mesh for vertex fetch locality
+    using @ref MeshTools::optimizeVertexFetch(const Trade::MeshData&)
+-   `--all-meshes` --- convert all meshes in the file instead of just the one
+    specified with `--mesh`
+-   `--threads N` --- number of threads used with `--all-meshes` (default:
+    `0`, which means hardware concurrency)
 
 If `--info` is given, the utility will print information about all lights,
 materials, meshes, images and textures present in the file.
@@ -130,6 +157,34 @@ doesn't support conversion to a file,
 if no `-C` / `--converter` is specified,
 @ref Trade::AnySceneConverter "AnySceneConverter" is used.
 
+@subsection magnum-sceneconverter-usage-passes Mesh processing passes
+
+The `--only-attributes`, `--remove-duplicates`, `--remove-duplicates-fuzzy`,
+`--simplify`, `--optimize-vertex-cache`, `--optimize-overdraw`,
+`--meshletize` and `--optimize-vertex-fetch` passes are applied on the
+imported mesh before passing it to the converter(s). Any combination of them
+can be specified and they're always applied in the order listed here,
+regardless of the order on the command line. That's the order in which they
+build on each other --- the simplification works best on a deduplicated
+mesh, overdraw optimization reorders batches produced by the vertex cache
+optimization and the vertex fetch optimization follows the final triangle
+order. Since @ref Trade::MeshData can't describe the meshlets themselves,
+`--meshletize` only reorders the triangles so consecutive ranges form
+meshlets with the default @ref MeshTools::meshletize() limits. Except for
+`--only-attributes` and duplicate removal, the passes require an indexed
+triangle mesh.
+
+@subsection magnum-sceneconverter-usage-all-meshes Converting all meshes
+
+With `--all-meshes`, each mesh in the file is imported once, processed with
+the requested passes and converted to a separate output file with the mesh ID
+inserted before the extension, so `out.ply` becomes `out-0.ply`, `out-1.ply`
+etc. The meshes are distributed across `--threads` threads, each having its
+own converter chain. If the importer supports
+@ref Trade::ImporterFeature::ConcurrentImport, the meshes are imported in
+parallel as well, otherwise only the processing and conversion is parallel.
+Meshes that fail to be processed are reported and skipped.
+
 @section magnum-sceneconverter-example Example usage
 
 Printing info about all meshes in a glTF file:
@@ -156,6 +211,16 @@ the processing stats:
 magnum-sceneconverter chair.obj --converter MeshOptimizerSceneConverter -c simplify=true,simplifyTargetIndexCountThreshold=0.5 chair.ply -v
 @endcode
 
+Simplifying all meshes in a glTF file to a quarter of the original index
+count, optimizing them for rendering and saving each to a separate PLY file,
+on all available cores:
+
+@m_class{m-console-wrap}
+
+@code{.sh}
+magnum-sceneconverter scene.gltf --all-meshes --remove-duplicates --simplify 0.25 --optimize-vertex-cache --optimize-overdraw --optimize-vertex-fetch mesh.ply
+@endcode
+
 @see @ref magnum-imageconverter
 */
 
@@ -165,18 +230,6 @@ using namespace Magnum;
 
 namespace {
 
-struct Duration {
-    explicit Duration(std::chrono::high_resolution_clock::duration& output): _output(output), _t{std::chrono::high_resolution_clock::now()} {}
-
-    ~Duration() {
-        _output += std::chrono::high_resolution_clock::now() - _t;
-    }
-
-    private:
-        std::chrono::high_resolution_clock::duration& _output;
-        std::chrono::high_resolution_clock::time_point _t;
-};
-
 /** @todo const Array& doesn't work, minmax() would fail to match */
 template<class T> std::string calculateBounds(Containers::Array<T>&& attribute) {
     /** @todo clean up when Debug::toString() exists */
@@ -194,6 +247,342 @@ UnsignedInt namedAttributeId(const Trade::MeshData& mesh, UnsignedInt id) {
     CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
+/* Requires an indexed triangle mesh, optionally with positions, for given
+   pass */
+bool checkTriangles(const Trade::MeshData& mesh, const char* const pass, const bool positions, const std::string& prefix, std::mutex& outputMutex) {
+    if(mesh.isIndexed() && mesh.primitive() == MeshPrimitive::Triangles && (!positions || mesh.hasAttribute(Trade::MeshAttribute::Position)))
+        return true;
+
+    std::lock_guard<std::mutex> lock{outputMutex};
+    Error{} << prefix << Debug::nospace << pass << "requires an indexed triangle mesh" << (positions ? "with positions" : "");
+    return false;
+}
+
+/* Applies the requested MeshTools passes on a mesh. The passes are always
+   done in the order in which they make sense to be chained, regardless of
+   the order in which they're specified on the command line --- attribute
+   filtering and duplicate removal first, then simplification operating on
+   the deduplicated topology, then reordering of the triangles for the
+   post-transform vertex cache, overdraw and meshlets, and finally reordering
+   of the vertices to follow the final triangle order. The prefix is put in
+   front of verbose and error messages, which are serialized through the
+   mutex to not get interleaved when multiple meshes are processed in
+   parallel. */
+bool processMesh(const Utility::Arguments& args, Trade::MeshData& mesh, const std::string& prefix, std::mutex& outputMutex) {
+    const bool verbose = args.isSet("verbose");
+
+    /* Filter attributes, if requested */
+    if(!args.value("only-attributes").empty()) {
+        std::set<UnsignedInt> only;
+        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
+            only.insert(std::stoi(i));
+
+        Containers::Array<Trade::MeshAttributeData> attributes;
+        for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+            if(only.find(i) != only.end())
+                arrayAppend(attributes, mesh.attributeData(i));
+        }
+
+        const Trade::MeshIndexData indices{mesh.indices()};
+        const UnsignedInt vertexCount = mesh.vertexCount();
+        mesh = Trade::MeshData{mesh.primitive(),
+            mesh.releaseIndexData(), indices,
+            mesh.releaseVertexData(), std::move(attributes),
+            vertexCount};
+    }
+
+    /* Remove duplicates, if requested */
+    if(args.isSet("remove-duplicates")) {
+        const UnsignedInt beforeVertexCount = mesh.vertexCount();
+        mesh = MeshTools::removeDuplicates(std::move(mesh));
+        if(verbose) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << prefix << Debug::nospace << "Duplicate removal:" << beforeVertexCount << "->" << mesh.vertexCount() << "vertices";
+        }
+    }
+
+    /* Remove duplicates with fuzzy comparison, if requested */
+    /** @todo accept two values for float and double fuzzy comparison */
+    if(!args.value("remove-duplicates-fuzzy").empty()) {
+        const UnsignedInt beforeVertexCount = mesh.vertexCount();
+        mesh = MeshTools::removeDuplicatesFuzzy(std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
+        if(verbose) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << prefix << Debug::nospace << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh.vertexCount() << "vertices";
+        }
+    }
+
+    /* Simplify, if requested. The target index count has to be a multiple of
+       three. */
+    if(!args.value("simplify").empty()) {
+        if(!checkTriangles(mesh, "--simplify", true, prefix, outputMutex))
+            return false;
+        const UnsignedInt beforeIndexCount = mesh.indexCount();
+        const UnsignedInt targetIndexCount = UnsignedInt(beforeIndexCount*Math::clamp(args.value<Float>("simplify"), 0.0f, 1.0f))/3*3;
+        mesh = MeshTools::simplify(std::move(mesh), targetIndexCount);
+        if(verbose) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << prefix << Debug::nospace << "Simplification:" << beforeIndexCount << "->" << mesh.indexCount() << "indices";
+        }
+    }
+
+    /* Optimize for the post-transform vertex cache, if requested */
+    if(args.isSet("optimize-vertex-cache")) {
+        if(!checkTriangles(mesh, "--optimize-vertex-cache", false, prefix, outputMutex))
+            return false;
+        mesh = MeshTools::optimizeVertexCache(std::move(mesh));
+    }
+
+    /* Optimize for overdraw, if requested. Works on batches produced by the
+       vertex cache optimization, so it should be done after. */
+    if(args.isSet("optimize-overdraw")) {
+        if(!checkTriangles(mesh, "--optimize-overdraw", true, prefix, outputMutex))
+            return false;
+        mesh = MeshTools::optimizeOverdraw(std::move(mesh));
+    }
+
+    /* Reorder the triangles into meshlets, if requested. MeshData can't
+       describe the meshlets themselves, so only the index buffer reordered
+       into meshlet order is kept. */
+    if(args.isSet("meshletize")) {
+        if(!checkTriangles(mesh, "--meshletize", true, prefix, outputMutex))
+            return false;
+        const MeshTools::Meshlets meshlets = MeshTools::meshletize(mesh);
+        const Containers::Array<UnsignedInt> meshletIndices = meshlets.indicesAsArray();
+        Containers::Array<char> indexData{Containers::NoInit, meshletIndices.size()*sizeof(UnsignedInt)};
+        Utility::copy(Containers::arrayCast<const char>(meshletIndices), indexData);
+        const Trade::MeshIndexData indices{Containers::arrayCast<const UnsignedInt>(indexData)};
+        const UnsignedInt vertexCount = mesh.vertexCount();
+        Containers::Array<char> vertexData = mesh.releaseVertexData();
+        Containers::Array<Trade::MeshAttributeData> attributes = mesh.releaseAttributeData();
+        mesh = Trade::MeshData{MeshPrimitive::Triangles,
+            std::move(indexData), indices,
+            std::move(vertexData), std::move(attributes), vertexCount};
+        if(verbose) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Debug{} << prefix << Debug::nospace << "Meshletization:" << meshlets.meshlets().size() << "meshlets";
+        }
+    }
+
+    /* Optimize for vertex fetch, if requested. Follows the final triangle
+       order, so it has to be done last. */
+    if(args.isSet("optimize-vertex-fetch")) {
+        if(!mesh.isIndexed() || !mesh.attributeCount()) {
+            std::lock_guard<std::mutex> lock{outputMutex};
+            Error{} << prefix << Debug::nospace << "--optimize-vertex-fetch requires an indexed mesh with attributes";
+            return false;
+        }
+        mesh = MeshTools::optimizeVertexFetch(std::move(mesh));
+    }
+
+    return true;
+}
+
+/* The --converter chain. All converters except the last one are expected to
+   support ConvertMesh and the mesh is "piped" from one to the other. Assume
+   there's always one passed --converter option less, and the last is
+   implicitly AnySceneConverter. If the last converter supports
+   ConvertMeshToFile instead of ConvertMesh, it's used instead of the last
+   implicit AnySceneConverter. */
+struct ConverterChain {
+    Containers::Array<Containers::Pointer<Trade::AbstractSceneConverter>> converters;
+    Containers::Array<std::string> names;
+};
+
+bool loadConverters(const Utility::Arguments& args, PluginManager::Manager<Trade::AbstractSceneConverter>& manager, ConverterChain& chain) {
+    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
+        const std::string converterName = i == converterCount ?
+            "AnySceneConverter" : args.arrayValue("converter", i);
+        Containers::Pointer<Trade::AbstractSceneConverter> converter = manager.loadAndInstantiate(converterName);
+        if(!converter) {
+            Debug{} << "Available converter plugins:" << Utility::String::join(manager.aliasList(), ", ");
+            return false;
+        }
+
+        /* Set options, if passed */
+        if(args.isSet("verbose")) converter->setFlags(Trade::SceneConverterFlag::Verbose);
+        if(i < args.arrayValueCount("converter-options"))
+            Implementation::setOptions(*converter, args.arrayValue("converter-options", i));
+
+        /* This is the last --converter (or the implicit AnySceneConverter at
+           the end), it's going to output to a file */
+        const bool last = i + 1 >= converterCount && (converter->features() & Trade::SceneConverterFeature::ConvertMeshToFile);
+        arrayAppend(chain.converters, std::move(converter));
+        arrayAppend(chain.names, converterName);
+        if(last) break;
+    }
+
+    return true;
+}
+
+/* Pipes the mesh through the converter chain and saves the output. Returns
+   zero on success and a process exit code on failure. */
+int convertMesh(const Utility::Arguments& args, ConverterChain& chain, Trade::MeshData&& mesh, const std::string& output, const std::string& prefix, std::mutex& outputMutex, std::chrono::high_resolution_clock::duration& conversionTime) {
+    const std::size_t converterCount = args.arrayValueCount("converter");
+    const bool verbose = converterCount > 1 && args.isSet("verbose");
+    for(std::size_t i = 0; i != chain.converters.size(); ++i) {
+        Trade::AbstractSceneConverter& converter = *chain.converters[i];
+        const std::string& converterName = chain.names[i];
+
+        /* This is the last --converter (or the implicit AnySceneConverter at
+           the end), output to a file and exit the loop */
+        if(i + 1 == chain.converters.size()) {
+            /* No verbose output for just one converter */
+            if(verbose) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Debug{} << prefix << Debug::nospace << "Saving output with" << converterName << Debug::nospace << "...";
+            }
+
+            Implementation::Duration d{conversionTime};
+            if(!converter.convertToFile(output, mesh)) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << prefix << Debug::nospace << "Cannot save file" << output;
+                return 5;
+            }
+
+        /* This is not the last converter, expect that it's capable of
+           ConvertMesh */
+        } else {
+            CORRADE_INTERNAL_ASSERT(i < converterCount);
+            if(verbose) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Debug{} << prefix << Debug::nospace << "Processing (" << Debug::nospace << (i+1) << Debug::nospace << "/" << Debug::nospace << converterCount << Debug::nospace << ") with" << converterName << Debug::nospace << "...";
+            }
+
+            if(!(converter.features() & Trade::SceneConverterFeature::ConvertMesh)) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << prefix << Debug::nospace << converterName << "doesn't support mesh conversion, only" << converter.features();
+                return 6;
+            }
+
+            Implementation::Duration d{conversionTime};
+            Containers::Optional<Trade::MeshData> converted = converter.convert(mesh);
+            if(!converted) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << prefix << Debug::nospace << converterName << "cannot convert the mesh";
+                return 7;
+            }
+            mesh = *std::move(converted);
+        }
+    }
+
+    return 0;
+}
+
+/* Output filename for given mesh in the --all-meshes mode, with the mesh ID
+   inserted before the extension */
+std::string meshOutputFilename(const std::string& output, const UnsignedInt id) {
+    const std::pair<std::string, std::string> nameExtension = Utility::Directory::splitExtension(output);
+    return Utility::formatString("{}-{}{}", nameExtension.first, id, nameExtension.second);
+}
+
+int convertAllMeshes(const Utility::Arguments& args, Trade::AbstractImporter& importer, ConverterChain& firstChain, std::chrono::high_resolution_clock::duration importTime, const Trade::Implementation::ImporterProfile& importerProfile) {
+    const UnsignedInt meshCount = importer.meshCount();
+    if(!meshCount) {
+        Error{} << "No meshes found in" << args.value("input");
+        return 4;
+    }
+
+    /* Zero thread count means hardware concurrency, but there's no point in
+       having more threads than meshes */
+    UnsignedInt threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = Math::min(threadCount, meshCount);
+
+    /* Each thread needs its own converter chain, and because the
+       AnySceneConverter loads and instantiates the concrete plugin on every
+       conversion, also its own plugin manager. The first thread reuses the
+       chain that's already loaded. Everything is set up upfront so errors
+       are reported before any work starts. */
+    Containers::Array<Containers::Pointer<PluginManager::Manager<Trade::AbstractSceneConverter>>> converterManagers{threadCount};
+    Containers::Array<ConverterChain> chains{threadCount};
+    chains[0] = std::move(firstChain);
+    for(UnsignedInt i = 1; i != threadCount; ++i) {
+        converterManagers[i].reset(new PluginManager::Manager<Trade::AbstractSceneConverter>{
+            args.value("plugin-dir").empty() ? std::string{} :
+            Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])});
+        if(!loadConverters(args, *converterManagers[i], chains[i]))
+            return 2;
+    }
+
+    /* Each mesh is imported just once, by the thread that then processes it.
+       If the importer doesn't support concurrent import, the imports are
+       serialized but the processing and conversion still runs in
+       parallel. The profile callback isn't thread-safe, so the imports are
+       serialized when profiling as well. */
+    const bool concurrentImport = (importer.features() & Trade::ImporterFeature::ConcurrentImport) && !args.isSet("profile");
+    const UnsignedInt level = args.value<UnsignedInt>("level");
+    std::atomic<UnsignedInt> next{0};
+    std::atomic<UnsignedInt> failedCount{0};
+    std::atomic<int> firstError{0};
+    std::mutex importMutex;
+    std::mutex outputMutex;
+    Containers::Array<std::chrono::high_resolution_clock::duration> importTimes{Containers::ValueInit, threadCount};
+    Containers::Array<std::chrono::high_resolution_clock::duration> conversionTimes{Containers::ValueInit, threadCount};
+    const auto worker = [&](const UnsignedInt thread) {
+        for(UnsignedInt id; (id = next++) < meshCount; ) {
+            const std::string prefix = Utility::formatString("Mesh {}: ", id);
+
+            Containers::Optional<Trade::MeshData> mesh;
+            {
+                Implementation::Duration d{importTimes[thread]};
+                if(concurrentImport) mesh = importer.mesh(id, level);
+                else {
+                    std::lock_guard<std::mutex> lock{importMutex};
+                    mesh = importer.mesh(id, level);
+                }
+            }
+            int error = 0;
+            if(!mesh) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << prefix << Debug::nospace << "Cannot import the mesh";
+                error = 4;
+            } else {
+                {
+                    Implementation::Duration d{conversionTimes[thread]};
+                    if(!processMesh(args, *mesh, prefix, outputMutex))
+                        error = 4;
+                }
+                if(!error)
+                    error = convertMesh(args, chains[thread], *std::move(mesh), meshOutputFilename(args.value("output"), id), prefix, outputMutex, conversionTimes[thread]);
+            }
+
+            if(error) {
+                ++failedCount;
+                int expected = 0;
+                firstError.compare_exchange_strong(expected, error);
+            }
+        }
+    };
+
+    std::chrono::high_resolution_clock::duration wallTime{};
+    {
+        Implementation::Duration d{wallTime};
+
+        /* The first worker runs on the calling thread */
+        Containers::Array<std::thread> threads{Containers::ValueInit, threadCount - 1};
+        for(UnsignedInt i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{worker, i + 1};
+        worker(0);
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    Debug{} << "Converted" << meshCount - failedCount << "out of" << meshCount << "meshes on" << threadCount << "threads in" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(wallTime).count())/1.0e3f << "seconds";
+
+    if(args.isSet("profile")) {
+        std::chrono::high_resolution_clock::duration conversionTime{};
+        for(UnsignedInt i = 0; i != threadCount; ++i) {
+            importTime += importTimes[i];
+            conversionTime += conversionTimes[i];
+        }
+        Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
+            << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds, summed over all threads";
+        Trade::Implementation::printImporterProfile(importerProfile);
+    }
+
+    return firstError;
+}
+
 }
 
 int main(int argc, char** argv) {
@@ -213,7 +602,14 @@ int main(int argc, char** argv) {
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
         .addBooleanOption("bounds").setHelp("bounds", "show bounds of known attributes in --info output")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
-        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time")
+        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time, including a breakdown of the import")
+        .addOption("simplify").setHelp("simplify", "simplify the mesh to given ratio of the original index count", "RATIO")
+        .addBooleanOption("optimize-vertex-cache").setHelp("optimize-vertex-cache", "optimize the mesh for the post-transform vertex cache")
+        .addBooleanOption("optimize-overdraw").setHelp("optimize-overdraw", "optimize the mesh for reduced overdraw")
+        .addBooleanOption("meshletize").setHelp("meshletize", "reorder the mesh triangles into meshlets")
+        .addBooleanOption("optimize-vertex-fetch").setHelp("optimize-vertex-fetch", "optimize the mesh for vertex fetch locality")
+        .addBooleanOption("all-meshes").setHelp("all-meshes", "convert all meshes in the file instead of just the one specified with --mesh")
+        .addOption("threads", "0").setHelp("threads", "number of threads used with --all-meshes, 0 means hardware concurrency", "N")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --info is passed, we don't need the output argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
@@ -238,7 +634,16 @@ together. All converters in the chain have to support the ConvertMesh feature,
 the last converter either ConvertMesh or ConvertMeshToFile. If the last
 converter doesn't support conversion to a file, AnySceneConverter is used to
 save its output; if no -C / --converter is specified, AnySceneConverter is
-used.)")
+used.
+
+The --only-attributes, --remove-duplicates, --remove-duplicates-fuzzy,
+--simplify, --optimize-vertex-cache, --optimize-overdraw, --meshletize and
+--optimize-vertex-fetch passes are always applied in this order, regardless of
+the order on the command line.
+
+With --all-meshes, each mesh is imported once, processed and converted to a
+separate file with the mesh ID inserted before the output extension. The
+meshes are processed in parallel on --threads threads.)")
         .parse(argc, argv);
 
     PluginManager::Manager<Trade::AbstractImporter> importerManager{
@@ -255,11 +660,16 @@ used.)")
     if(args.isSet("verbose")) importer->setFlags(Trade::ImporterFlag::Verbose);
     Implementation::setOptions(*importer, args.value("importer-options"));
 
-    std::chrono::high_resolution_clock::duration importTime;
+    /* Collect per-stage timing from the importer, if requested */
+    Trade::Implementation::ImporterProfile importerProfile;
+    if(args.isSet("profile"))
+        importer->setProfileCallback(Trade::Implementation::importerProfileCallback, &importerProfile);
+
+    std::chrono::high_resolution_clock::duration importTime{};
 
     /* Open the file */
     {
-        Duration d{importTime};
+        Implementation::Duration d{importTime};
         if(!importer->openFile(args.value("input"))) {
             Error() << "Cannot open file" << args.value("input");
             return 3;
@@ -343,7 +753,7 @@ used.)")
         for(UnsignedInt i = 0; i != importer->lightCount(); ++i) {
             Containers::Optional<Trade::LightData> light;
             {
-                Duration d{importTime};
+                Implementation::Duration d{importTime};
                 if(!(light = importer->light(i))) {
                     error = true;
                     continue;
@@ -365,7 +775,7 @@ used.)")
         for(UnsignedInt i = 0; i != importer->materialCount(); ++i) {
             Containers::Optional<Trade::MaterialData> material;
             {
-                Duration d{importTime};
+                Implementation::Duration d{importTime};
                 if(!(material = importer->material(i))) {
                     error = true;
                     continue;
@@ -400,7 +810,7 @@ used.)")
             for(UnsignedInt j = 0; j != importer->meshLevelCount(i); ++j) {
                 Containers::Optional<Trade::MeshData> mesh;
                 {
-                    Duration d{importTime};
+                    Implementation::Duration d{importTime};
                     if(!(mesh = importer->mesh(i, j))) {
                         error = true;
                         continue;
@@ -483,7 +893,7 @@ used.)")
         for(UnsignedInt i = 0; i != importer->textureCount(); ++i) {
             Containers::Optional<Trade::TextureData> texture;
             {
-                Duration d{importTime};
+                Implementation::Duration d{importTime};
                 if(!(texture = importer->texture(i))) {
                     error = true;
                     continue;
@@ -678,126 +1088,49 @@ used.)")
 
         if(args.isSet("profile")) {
             Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds";
+            Trade::Implementation::printImporterProfile(importerProfile);
         }
 
         return error ? 1 : 0;
     }
 
+    /* Load the converter chain */
+    PluginManager::Manager<Trade::AbstractSceneConverter> converterManager{
+        args.value("plugin-dir").empty() ? std::string{} :
+        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])};
+    ConverterChain converters;
+    if(!loadConverters(args, converterManager, converters))
+        return 2;
+
+    /* Convert all meshes on multiple threads, if requested */
+    if(args.isSet("all-meshes"))
+        return convertAllMeshes(args, *importer, converters, importTime, importerProfile);
+
     Containers::Optional<Trade::MeshData> mesh;
     {
-        Duration d{importTime};
+        Implementation::Duration d{importTime};
         if(!importer->meshCount() || !(mesh = importer->mesh(args.value<UnsignedInt>("mesh"), args.value<UnsignedInt>("level")))) {
             Error{} << "Cannot import the mesh";
             return 4;
         }
     }
 
-    std::chrono::high_resolution_clock::duration conversionTime;
-
-    /* Filter attributes, if requested */
-    if(!args.value("only-attributes").empty()) {
-        std::set<UnsignedInt> only;
-        for(const std::string& i: Utility::String::split(args.value("only-attributes"), ' '))
-            only.insert(std::stoi(i));
-
-        Containers::Array<Trade::MeshAttributeData> attributes;
-        for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
-            if(only.find(i) != only.end())
-                arrayAppend(attributes, mesh->attributeData(i));
-        }
-
-        const Trade::MeshIndexData indices{mesh->indices()};
-        const UnsignedInt vertexCount = mesh->vertexCount();
-        mesh = Trade::MeshData{mesh->primitive(),
-            mesh->releaseIndexData(), indices,
-            mesh->releaseVertexData(), std::move(attributes),
-            vertexCount};
-    }
-
-    /* Remove duplicates, if requested */
-    if(args.isSet("remove-duplicates")) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicates(*std::move(mesh));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
-    }
+    std::chrono::high_resolution_clock::duration conversionTime{};
 
-    /* Remove duplicates with fuzzy comparison, if requested */
-    /** @todo accept two values for float and double fuzzy comparison */
-    if(!args.value("remove-duplicates-fuzzy").empty()) {
-        const UnsignedInt beforeVertexCount = mesh->vertexCount();
-        {
-            Duration d{conversionTime};
-            mesh = MeshTools::removeDuplicatesFuzzy(*std::move(mesh), args.value<Float>("remove-duplicates-fuzzy"));
-        }
-        if(args.isSet("verbose"))
-            Debug{} << "Fuzzy duplicate removal:" << beforeVertexCount << "->" << mesh->vertexCount() << "vertices";
+    /* Process the mesh with the requested MeshTools passes */
+    std::mutex outputMutex;
+    {
+        Implementation::Duration d{conversionTime};
+        if(!processMesh(args, *mesh, {}, outputMutex))
+            return 4;
     }
 
-    /* Load converter plugin */
-    PluginManager::Manager<Trade::AbstractSceneConverter> converterManager{
-        args.value("plugin-dir").empty() ? std::string{} :
-        Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractSceneConverter::pluginSearchPaths()[0])};
-
-    /* Assume there's always one passed --converter option less, and the last
-       is implicitly AnySceneConverter. All converters except the last one are
-       expected to support ConvertMesh and the mesh is "piped" from one to the
-       other. If the last converter supports ConvertMeshToFile instead of
-       ConvertMesh, it's used instead of the last implicit AnySceneConverter. */
-    for(std::size_t i = 0, converterCount = args.arrayValueCount("converter"); i <= converterCount; ++i) {
-        const std::string converterName = i == converterCount ?
-            "AnySceneConverter" : args.arrayValue("converter", i);
-        Containers::Pointer<Trade::AbstractSceneConverter> converter = converterManager.loadAndInstantiate(converterName);
-        if(!converter) {
-            Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
-            return 2;
-        }
-
-        /* Set options, if passed */
-        if(args.isSet("verbose")) converter->setFlags(Trade::SceneConverterFlag::Verbose);
-        if(i < args.arrayValueCount("converter-options"))
-            Implementation::setOptions(*converter, args.arrayValue("converter-options", i));
-
-        /* This is the last --converter (or the implicit AnySceneConverter at
-           the end), output to a file and exit the loop */
-        if(i + 1 >= converterCount && (converter->features() & Trade::SceneConverterFeature::ConvertMeshToFile)) {
-            /* No verbose output for just one converter */
-            if(converterCount > 1 && args.isSet("verbose"))
-                Debug{} << "Saving output with" << converterName << Debug::nospace << "...";
-
-            Duration d{conversionTime};
-            if(!converter->convertToFile(args.value("output"), *mesh)) {
-                Error{} << "Cannot save file" << args.value("output");
-                return 5;
-            }
-
-            break;
-
-        /* This is not the last converter, expect that it's capable of
-           ConvertMesh */
-        } else {
-            CORRADE_INTERNAL_ASSERT(i < converterCount);
-            if(converterCount > 1 && args.isSet("verbose"))
-                Debug{} << "Processing (" << Debug::nospace << (i+1) << Debug::nospace << "/" << Debug::nospace << converterCount << Debug::nospace << ") with" << converterName << Debug::nospace << "...";
-
-            if(!(converter->features() & Trade::SceneConverterFeature::ConvertMesh)) {
-                Error{} << converterName << "doesn't support mesh conversion, only" << converter->features();
-                return 6;
-            }
-
-            Duration d{conversionTime};
-            if(!(mesh = converter->convert(*mesh))) {
-                Error{} << converterName << "cannot convert the mesh";
-                return 7;
-            }
-        }
-    }
+    if(const int error = convertMesh(args, converters, *std::move(mesh), args.value("output"), {}, outputMutex, conversionTime))
+        return error;
 
     if(args.isSet("profile")) {
         Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
             << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds";
+        Trade::Implementation::printImporterProfile(importerProfile);
     }
 }
@@ -25,9 +25,14 @@
 
 #include "AndroidApplication.h"
 
+#include <cstring>
 #include <Corrade/Utility/AndroidLogStreamBuffer.h>
 #include <Corrade/Utility/Debug.h>
+#include <android/api-level.h>
 #include <android_native_app_glue.h>
+#if __ANDROID_API__ >= 24
+#include <android/choreographer.h>
+#endif
 
 #include "Magnum/GL/Version.h"
 #include "Magnum/Platform/GLContext.h"
@@ -42,7 +47,10 @@ extern "C" void ANativeActivity_onCreate(struct ANativeActivity*, void*, size_t)
 namespace Magnum { namespace Platform {
 
 enum class AndroidApplication::Flag: UnsignedByte {
-    Redraw = 1 << 0
+    Redraw = 1 << 0,
+    FrameCallback = 1 << 1,
+    FrameCallbackPosted = 1 << 2,
+    PresentationTime = 1 << 3
 };
 
 struct AndroidApplication::LogOutput {
@@ -63,6 +71,86 @@ AndroidApplication::LogOutput::LogOutput():
     redirectDebug{&debugStream}, redirectWarning{&warningStream}, redirectError{&errorStream}
 {}
 
+namespace {
+    struct Data {
+        Data(Containers::Pointer<AndroidApplication>(*instancer)(const AndroidApplication::Arguments&), void(*nativeActivity)(ANativeActivity*,void*,size_t)): instancer(instancer), nativeActivity{nativeActivity} {}
+
+        Containers::Pointer<AndroidApplication>(*instancer)(const AndroidApplication::Arguments&);
+        Containers::Pointer<AndroidApplication> instance;
+
+        void(*nativeActivity)(ANativeActivity*,void*,size_t);
+    };
+}
+
+#if __ANDROID_API__ >= 24
+struct AndroidApplication::FrameCallback {
+    /* The callbacks get the android_app pointer instead of the application
+       instance, as the instance might get destroyed on APP_CMD_TERM_WINDOW
+       while a callback is still pending */
+    #if __ANDROID_API__ >= 33
+    static void vsync(const AChoreographerFrameCallbackData* callbackData, void* state) {
+        const std::size_t index = AChoreographerFrameCallbackData_getPreferredFrameTimelineIndex(callbackData);
+        frame(state,
+            AChoreographerFrameCallbackData_getFrameTimeNanos(callbackData),
+            AChoreographerFrameCallbackData_getFrameTimelineDeadlineNanos(callbackData, index),
+            AChoreographerFrameCallbackData_getFrameTimelineExpectedPresentationTimeNanos(callbackData, index));
+    }
+    #elif __ANDROID_API__ >= 29
+    static void frame64(const std::int64_t frameTime, void* state) {
+        frame(state, frameTime, 0, 0);
+    }
+    #else
+    static void frame32(const long frameTime, void* state) {
+        frame(state, frameTime, 0, 0);
+    }
+    #endif
+
+    #if __ANDROID_API__ >= 30
+    static void refreshRate(const std::int64_t vsyncPeriod, void* application) {
+        static_cast<AndroidApplication*>(application)->_frameInterval = vsyncPeriod;
+    }
+    #endif
+
+    static void frame(void* state, const Long frameTime, const Long deadline, const Long presentationTime) {
+        auto* const data = static_cast<Data*>(static_cast<android_app*>(state)->userData);
+        if(!data || !data->instance) return;
+        AndroidApplication& app = *data->instance;
+
+        /* A stale callback posted for a previous instance */
+        if(!(app._flags & Flag::FrameCallbackPosted)) return;
+        app._flags &= ~Flag::FrameCallbackPosted;
+
+        /* Frame callbacks were disabled while this one was pending */
+        if(!(app._flags & Flag::FrameCallback)) return;
+
+        app._frameTime = frameTime;
+        app._frameDeadline = deadline ? deadline : frameTime + app._frameInterval;
+        app._framePresentationTime = presentationTime ? presentationTime : frameTime + 2*app._frameInterval;
+
+        /* If the app calls redraw() from within the draw event, a callback
+           for the next frame gets posted from there */
+        if(app._flags & Flag::Redraw) {
+            app._flags &= ~Flag::Redraw;
+            app.drawEvent();
+        }
+    }
+
+    static void post(AndroidApplication& app) {
+        if(app._flags & Flag::FrameCallbackPosted) return;
+
+        AChoreographer* const choreographer = AChoreographer_getInstance();
+        #if __ANDROID_API__ >= 33
+        AChoreographer_postVsyncCallback(choreographer, vsync, app._state);
+        #elif __ANDROID_API__ >= 29
+        AChoreographer_postFrameCallback64(choreographer, frame64, app._state);
+        #else
+        AChoreographer_postFrameCallback(choreographer, frame32, app._state);
+        #endif
+        app._flags |= Flag::FrameCallbackPosted;
+    }
+};
+#endif
+
 AndroidApplication::AndroidApplication(const Arguments& arguments): AndroidApplication{arguments, Configuration{}, GLConfiguration{}} {}
 
 AndroidApplication::AndroidApplication(const Arguments& arguments, const Configuration& configuration): AndroidApplication{arguments, configuration, GLConfiguration{}} {}
@@ -77,6 +165,11 @@ AndroidApplication::AndroidApplication(const Arguments& arguments, NoCreateT): _
 }
 
 AndroidApplication::~AndroidApplication() {
+    #if __ANDROID_API__ >= 30
+    if(_flags & Flag::FrameCallback)
+        AChoreographer_unregisterRefreshRateCallback(AChoreographer_getInstance(), FrameCallback::refreshRate, this);
+    #endif
+
     eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     eglDestroyContext(_display, _glContext);
     eglDestroySurface(_display, _surface);
@@ -176,11 +269,76 @@ Vector2i AndroidApplication::framebufferSize() const {
 }
 
 void AndroidApplication::swapBuffers() {
+    if((_flags & Flag::PresentationTime) && _framePresentationTime)
+        _presentationTimeFunction(_display, _surface, Long(_framePresentationTime));
     eglSwapBuffers(_display, _surface);
 }
 
 void AndroidApplication::redraw() {
     _flags |= Flag::Redraw;
+    #if __ANDROID_API__ >= 24
+    if(_flags & Flag::FrameCallback) FrameCallback::post(*this);
+    #endif
+}
+
+bool AndroidApplication::isFrameCallbackEnabled() const {
+    return !!(_flags & Flag::FrameCallback);
+}
+
+bool AndroidApplication::setFrameCallbackEnabled(const bool enabled) {
+    if(enabled == isFrameCallbackEnabled()) return true;
+
+    #if __ANDROID_API__ >= 24
+    if(enabled) {
+        _flags |= Flag::FrameCallback;
+        #if __ANDROID_API__ >= 30
+        AChoreographer_registerRefreshRateCallback(AChoreographer_getInstance(), FrameCallback::refreshRate, this);
+        #endif
+        /* If a redraw is already requested, schedule it for the next vsync.
+           If a callback is still pending from before the callbacks were
+           disabled, it gets reused. */
+        if(_flags & Flag::Redraw) FrameCallback::post(*this);
+    } else {
+        _flags &= ~Flag::FrameCallback;
+        #if __ANDROID_API__ >= 30
+        AChoreographer_unregisterRefreshRateCallback(AChoreographer_getInstance(), FrameCallback::refreshRate, this);
+        #endif
+        _frameTime = _frameDeadline = _framePresentationTime = 0;
+    }
+
+    return true;
+    #else
+    Error{} << "Platform::AndroidApplication::setFrameCallbackEnabled(): AChoreographer requires Android API level 24 but the application is built for level" << __ANDROID_API__;
+    return false;
+    #endif
+}
+
+bool AndroidApplication::isPresentationTimeEnabled() const {
+    return !!(_flags & Flag::PresentationTime);
+}
+
+bool AndroidApplication::setPresentationTimeEnabled(const bool enabled) {
+    CORRADE_ASSERT(_context->version() != GL::Version::None,
+        "Platform::AndroidApplication::setPresentationTimeEnabled(): no context created", false);
+
+    if(!enabled) {
+        _flags &= ~Flag::PresentationTime;
+        return true;
+    }
+
+    if(!_presentationTimeFunction) {
+        const char* const extensions = eglQueryString(_display, EGL_EXTENSIONS);
+        if(!extensions || !std::strstr(extensions, "EGL_ANDROID_presentation_time")) {
+            Error{} << "Platform::AndroidApplication::setPresentationTimeEnabled(): EGL_ANDROID_presentation_time is not supported";
+            return false;
+        }
+
+        _presentationTimeFunction = reinterpret_cast<EGLBoolean(*)(EGLDisplay, EGLSurface, Long)>(eglGetProcAddress("eglPresentationTimeANDROID"));
+        CORRADE_INTERNAL_ASSERT(_presentationTimeFunction);
+    }
+
+    _flags |= Flag::PresentationTime;
+    return true;
 }
 
 void AndroidApplication::viewportEvent(ViewportEvent& event) {
@@ -191,17 +349,6 @@ void AndroidApplication::mousePressEvent(MouseEvent&) {}
 void AndroidApplication::mouseReleaseEvent(MouseEvent&) {}
 void AndroidApplication::mouseMoveEvent(MouseMoveEvent&) {}
 
-namespace {
-    struct Data {
-        Data(Containers::Pointer<AndroidApplication>(*instancer)(const AndroidApplication::Arguments&), void(*nativeActivity)(ANativeActivity*,void*,size_t)): instancer(instancer), nativeActivity{nativeActivity} {}
-
-        Containers::Pointer<AndroidApplication>(*instancer)(const AndroidApplication::Arguments&);
-        Containers::Pointer<AndroidApplication> instance;
-
-        void(*nativeActivity)(ANativeActivity*,void*,size_t);
-    };
-}
-
 void AndroidApplication::commandEvent(android_app* state, int32_t cmd) {
     Data& data = *static_cast<Data*>(state->userData);
 
@@ -295,14 +442,20 @@ void AndroidApplication::exec(android_app* state, Containers::Pointer<AndroidApp
     state->userData = &data;
 
     for(;;) {
+        /* With frame callbacks enabled, the draw event is called from the
+           AChoreographer callback that's dispatched while polling, so the
+           loop always blocks */
+        const bool redrawFromLoop = data.instance &&
+            (data.instance->_flags & Flag::Redraw) &&
+            !(data.instance->_flags & Flag::FrameCallback);
+
         /* Read all pending events. Block and wait for them only if the app
            doesn't want to redraw immediately WHY THIS GODDAMN THING DOESNT
            HAVE SOMETHING LIKE WAIT FOR EVENT SO I NEED TO TANGLE THIS TANGLED
            MESS OF HELL */
         int ident, events;
         android_poll_source* source;
-        while((ident = ALooper_pollAll(
-            data.instance && (data.instance->_flags & Flag::Redraw) ? 0 : -1,
+        while((ident = ALooper_pollAll(redrawFromLoop ? 0 : -1,
             nullptr, &events, reinterpret_cast<void**>(&source))) >= 0)
         {
             /* Process this event OH SIR MAY MY POOR EXISTENCE CALL THIS
@@ -315,8 +468,10 @@ void AndroidApplication::exec(android_app* state, Containers::Pointer<AndroidApp
         }
 
         /* Redraw the app if it wants to be redrawn. Frame limiting is done by
-           Android itself */
-        if(data.instance && (data.instance->_flags & Flag::Redraw))
+           Android itself. The instance might have been destroyed or frame
+           callbacks enabled during event processing, so check again. */
+        if(data.instance && (data.instance->_flags & Flag::Redraw) &&
+           !(data.instance->_flags & Flag::FrameCallback))
             data.instance->drawEvent();
     }
 
@@ -153,6 +153,48 @@ default the application gets killed and relaunched on screen orientation
 change. See the @ref platforms-android-apps-manifest-screen-resize "manifest file docs"
 for more information.
 
+@section Platform-AndroidApplication-frame-scheduling Frame scheduling
+
+By default, @ref drawEvent() is called from the event loop as fast as the
+buffer swap allows, without any alignment to the display refresh. Calling
+@ref setFrameCallbackEnabled() switches to scheduling frames through
+[AChoreographer](https://developer.android.com/ndk/reference/group/choreographer),
+which calls @ref drawEvent() right after a vsync signal and only if
+@ref redraw() was called. Timing of the current frame is then available
+through @ref frameTime(), @ref frameDeadline() and @ref frameInterval(),
+which the application can use to advance animations by exact display refresh
+intervals or to skip work that wouldn't finish in time.
+
+If the @m_class{m-doc-external} [EGL_ANDROID_presentation_time](https://www.khronos.org/registry/EGL/extensions/ANDROID/EGL_ANDROID_presentation_time.txt)
+extension is available, @ref setPresentationTimeEnabled() additionally tells
+the compositor when each frame is meant to be shown, which avoids frames
+being displayed too early and then held for a longer period, similarly to
+what the Android Frame Pacing library does:
+
+@code{.cpp}
+MyApplication::MyApplication(const Arguments& arguments):
+    Platform::Application{arguments}
+{
+    setFrameCallbackEnabled(true);
+    setPresentationTimeEnabled(true);
+    redraw();
+}
+
+void MyApplication::drawEvent() {
+    // advance animations by the actual refresh interval
+    _animation.advance(frameInterval()*1.0e-9f);
+
+    // draw …
+
+    swapBuffers();
+    redraw();
+}
+@endcode
+
+The frame callback requires Android API level 24, frame deadline and
+expected presentation time reported by the system require API level 33 and
+are estimated from the refresh interval on older versions.
+
 @section Platform-AndroidApplication-output-redirection Redirecting output to Android log buffer
 
 The application by default redirects @ref Corrade::Utility::Debug "Debug",
@@ -345,9 +387,111 @@ class AndroidApplication {
          */
         void swapBuffers();
 
-        /** @copydoc Sdl2Application::redraw() */
+        /**
+         * @brief Redraw immediately
+         *
+         * Marks the window for redrawing, resulting in call to
+         * @ref drawEvent() in the next iteration. You can call it from
+         * @ref drawEvent() itself to redraw immediately without waiting for
+         * user input. If @ref setFrameCallbackEnabled() is active, the
+         * @ref drawEvent() is called after the next vsync signal and this
+         * function has to be called again for each new frame.
+         */
         void redraw();
 
+        /**
+         * @brief Whether frame scheduling through AChoreographer is enabled
+         * @m_since_latest
+         *
+         * @see @ref setFrameCallbackEnabled()
+         */
+        bool isFrameCallbackEnabled() const;
+
+        /**
+         * @brief Enable or disable frame scheduling through AChoreographer
+         * @m_since_latest
+         *
+         * When enabled, @ref drawEvent() is called from an AChoreographer
+         * frame callback after a vsync signal instead of being called
+         * repeatedly from the event loop, and only if @ref redraw() was
+         * called since the previous frame. Timing of the current frame is
+         * available through @ref frameTime(), @ref frameDeadline() and
+         * @ref frameInterval(). See
+         * @ref Platform-AndroidApplication-frame-scheduling for more
+         * information.
+         *
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce if the application was built for Android API level
+         * lower than 24, @cpp true @ce otherwise. Disabled by default.
+         */
+        bool setFrameCallbackEnabled(bool enabled);
+
+        /**
+         * @brief Vsync timestamp of the current frame
+         * @m_since_latest
+         *
+         * Time at which the vsync signal that triggered current
+         * @ref drawEvent() happened, in nanoseconds in the
+         * @cpp CLOCK_MONOTONIC @ce time base. Returns @cpp 0 @ce if
+         * @ref setFrameCallbackEnabled() isn't active or no frame callback
+         * was called yet.
+         * @see @ref frameDeadline(), @ref frameInterval()
+         */
+        UnsignedLong frameTime() const { return _frameTime; }
+
+        /**
+         * @brief Deadline of the current frame
+         * @m_since_latest
+         *
+         * Time by which rendering of the current frame should be submitted
+         * in order to be shown at the expected presentation time, in
+         * nanoseconds in the @cpp CLOCK_MONOTONIC @ce time base. Reported by
+         * the system on Android API level 33 and newer, estimated as
+         * @ref frameTime() plus @ref frameInterval() otherwise. Returns
+         * @cpp 0 @ce if @ref setFrameCallbackEnabled() isn't active or no
+         * frame callback was called yet.
+         */
+        UnsignedLong frameDeadline() const { return _frameDeadline; }
+
+        /**
+         * @brief Display refresh interval
+         * @m_since_latest
+         *
+         * Interval between two vsync signals, in nanoseconds. Reported by
+         * the system on Android API level 30 and newer, and updated when the
+         * refresh rate changes. Is @cpp 16666667 @ce (i.e., 60 Hz) on older
+         * versions.
+         */
+        UnsignedLong frameInterval() const { return _frameInterval; }
+
+        /**
+         * @brief Whether frame presentation time is set
+         * @m_since_latest
+         *
+         * @see @ref setPresentationTimeEnabled()
+         */
+        bool isPresentationTimeEnabled() const;
+
+        /**
+         * @brief Enable or disable setting frame presentation time
+         * @m_since_latest
+         *
+         * When enabled together with @ref setFrameCallbackEnabled(),
+         * @ref swapBuffers() tells the compositor the time at which the
+         * frame is expected to be presented, which prevents the frame from
+         * being shown earlier and then held on screen for longer than the
+         * others. The time is reported by the system on Android API level 33
+         * and newer, estimated as two refresh intervals after
+         * @ref frameTime() otherwise.
+         *
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce if the
+         * @m_class{m-doc-external} [EGL_ANDROID_presentation_time](https://www.khronos.org/registry/EGL/extensions/ANDROID/EGL_ANDROID_presentation_time.txt)
+         * extension is not available, @cpp true @ce otherwise. Expects that
+         * the context is already created. Disabled by default.
+         */
+        bool setPresentationTimeEnabled(bool enabled);
+
     private:
         /**
          * @brief Viewport event
@@ -420,6 +564,7 @@ class AndroidApplication {
 
     private:
         struct LogOutput;
+        struct FrameCallback;
 
         enum class Flag: UnsignedByte;
         typedef Containers::EnumSet<Flag> Flags;
@@ -435,6 +580,10 @@ class AndroidApplication {
         EGLContext _glContext;
         Vector2i _previousMouseMovePosition{-1};
 
+        UnsignedLong _frameTime{}, _frameDeadline{},
+            _framePresentationTime{}, _frameInterval{16666667};
+        EGLBoolean(*_presentationTimeFunction)(EGLDisplay, EGLSurface, Long){};
+
         Containers::Pointer<Platform::GLContext> _context;
         Containers::Pointer<LogOutput> _logOutput;
 
@@ -29,6 +29,9 @@
 
 #include <emscripten/emscripten.h>
 #include <emscripten/html5.h>
+#ifdef __EMSCRIPTEN_PTHREADS__
+#include <emscripten/threading.h>
+#endif
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/Utility/Arguments.h>
@@ -182,13 +185,24 @@ namespace {
         return Key::Unknown;
     }
 
+    /* With pthreads the application may run on a worker that has no access to
+       the DOM, so JS code touching it is executed synchronously on the main
+       thread instead. Without pthreads it's the same as plain EM_ASM. */
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    #define DOM_EM_ASM MAIN_THREAD_EM_ASM
+    #define DOM_EM_ASM_INT MAIN_THREAD_EM_ASM_INT
+    #else
+    #define DOM_EM_ASM EM_ASM_
+    #define DOM_EM_ASM_INT EM_ASM_INT
+    #endif
+
     std::string canvasId() {
         #pragma GCC diagnostic push
         #pragma GCC diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
         /* Note: can't use let or const, as that breaks closure compiler:
             ERROR - [JSC_LANGUAGE_FEATURE] This language feature is only
             supported for ECMASCRIPT6 mode or better: const declaration. */
-        char* id = reinterpret_cast<char*>(EM_ASM_INT({
+        char* id = reinterpret_cast<char*>(DOM_EM_ASM_INT({
             var id = Module['canvas'].id;
             var bytes = lengthBytesUTF8(id) + 1;
             var memory = _malloc(bytes);
@@ -353,9 +367,32 @@ bool EmscriptenApplication::tryCreate(const Configuration& configuration) {
 bool EmscriptenApplication::tryCreate(const Configuration& configuration, const GLConfiguration& glConfiguration) {
     CORRADE_ASSERT(_context->version() == GL::Version::None, "Platform::EmscriptenApplication::tryCreate(): window with OpenGL context already created", false);
 
+    /* Rendering to an OffscreenCanvas is only possible from a worker that got
+       the canvas transferred via OFFSCREENCANVASES_TO_PTHREAD */
+    if(configuration.windowFlags() & Configuration::WindowFlag::OffscreenCanvas) {
+        #ifndef __EMSCRIPTEN_PTHREADS__
+        Error{} << "Platform::EmscriptenApplication::tryCreate(): rendering to an OffscreenCanvas requires the application to be built with -pthread";
+        return false;
+        #else
+        if(emscripten_is_main_runtime_thread()) {
+            Error{} << "Platform::EmscriptenApplication::tryCreate(): rendering to an OffscreenCanvas requires the application to run on a worker, build with -s PROXY_TO_PTHREAD";
+            return false;
+        }
+        #endif
+    }
+
     /* Create emscripten WebGL context */
     EmscriptenWebGLContextAttributes attrs;
     emscripten_webgl_init_context_attributes(&attrs);
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    /* Create the context directly on the OffscreenCanvas owned by this
+       thread instead of proxying all GL calls to the main thread */
+    if(configuration.windowFlags() & Configuration::WindowFlag::OffscreenCanvas) {
+        attrs.proxyContextToMainThread = EMSCRIPTEN_WEBGL_CONTEXT_PROXY_DISALLOW;
+        attrs.renderViaOffscreenBackBuffer = false;
+        _flags |= Flag::OffscreenCanvas;
+    }
+    #endif
     attrs.alpha = glConfiguration.colorBufferSize().a() > 0;
     attrs.depth = glConfiguration.depthBufferSize() > 0;
     attrs.stencil = glConfiguration.stencilBufferSize() > 0;
@@ -471,14 +508,14 @@ Vector2i EmscriptenApplication::framebufferSize() const {
 void EmscriptenApplication::setWindowTitle(const std::string& title) {
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wdollar-in-identifier-extension"
-    EM_ASM_({document.title = UTF8ToString($0);}, title.data());
+    DOM_EM_ASM({document.title = UTF8ToString($0);}, title.data());
     #pragma GCC diagnostic pop
 }
 
 void EmscriptenApplication::setContainerCssClass(const std::string& cssClass) {
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wdollar-in-identifier-extension"
-    EM_ASM_({
+    DOM_EM_ASM({
         /* Handle also the classic #container for backwards compatibility. We
            also need to preserve the mn-container otherwise next time we'd have
            no way to look for it anymore. */
@@ -588,7 +625,7 @@ void EmscriptenApplication::setupCallbacks(bool resizable) {
     /* Note: can't use let or const, as that breaks closure compiler:
         ERROR - [JSC_LANGUAGE_FEATURE] This language feature is only
         supported for ECMASCRIPT6 mode or better: const declaration. */
-    const char* keyboardListeningElement = reinterpret_cast<const char*>(EM_ASM_INT({
+    const char* keyboardListeningElement = reinterpret_cast<const char*>(DOM_EM_ASM_INT({
         var element = Module['keyboardListeningElement'] || document;
 
         if(element === document) return 1; /* EMSCRIPTEN_EVENT_TARGET_DOCUMENT */
@@ -738,7 +775,7 @@ void EmscriptenApplication::setCursor(Cursor cursor) {
     CORRADE_INTERNAL_ASSERT(UnsignedInt(cursor) < Containers::arraySize(CursorMap));
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wdollar-in-identifier-extension"
-    EM_ASM_({Module['canvas'].style.cursor = AsciiToString($0);}, CursorMap[UnsignedInt(cursor)]);
+    DOM_EM_ASM({Module['canvas'].style.cursor = AsciiToString($0);}, CursorMap[UnsignedInt(cursor)]);
     #pragma GCC diagnostic pop
 }
 
@@ -779,6 +816,13 @@ int EmscriptenApplication::exec() {
     if(_flags & Flag::ExitRequested) return 0;
 
     redraw();
+
+    /* When running on a worker, returning from main() would tear down the
+       thread together with the animation frame loop, so keep it alive */
+    #ifdef __EMSCRIPTEN_PTHREADS__
+    if(_flags & Flag::OffscreenCanvas)
+        emscripten_exit_with_live_runtime();
+    #endif
     return 0;
 }
 
@@ -790,23 +834,24 @@ void EmscriptenApplication::redraw() {
        will have a reentrancy issue here. */
     if(_flags & Flag::LoopActive) return;
 
-    /* Start requestAnimationFrame loop */
+    /* Start requestAnimationFrame loop. Using the global functions instead of
+       window.* as those are available in workers as well. */
     _flags |= Flag::LoopActive;
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wdollar-in-identifier-extension"
     EM_ASM({
         /* Animation frame callback */
         var drawEvent = function() {
-            var id = window.requestAnimationFrame(drawEvent);
+            var id = requestAnimationFrame(drawEvent);
 
             /* Call our callback via function pointer returning int with two
             int params */
             if(!dynCall('ii', $0, [$1])) {
-                window.cancelAnimationFrame(id);
+                cancelAnimationFrame(id);
             }
         };
 
-        window.requestAnimationFrame(drawEvent);
+        requestAnimationFrame(drawEvent);
     }, _callback, this);
     #pragma GCC diagnostic pop
 }
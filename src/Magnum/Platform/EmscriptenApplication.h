@@ -200,6 +200,39 @@ application has to redraw all the time anyway this can be disabled using
 @ref Configuration::WindowFlag::AlwaysRequestAnimationFrame. Setting the flag
 will make the main loop behave equivalently to @ref Sdl2Application.
 
+@subsection Platform-EmscriptenApplication-browser-offscreen-canvas Rendering on a worker thread
+
+By default, the application runs on the browser main thread, which means
+rendering competes with DOM layout and JavaScript code on the page. With
+@ref Configuration::WindowFlag::OffscreenCanvas, the application can run on
+a pthread instead, rendering to an [OffscreenCanvas](https://developer.mozilla.org/en-US/docs/Web/API/OffscreenCanvas)
+transferred from the @cb{.html} <canvas> @ce element. This needs the
+application to be built with pthreads, its @cpp main() @ce proxied to a
+worker and the canvas transferred to it:
+
+@code{.sh}
+-pthread -s PROXY_TO_PTHREAD=1 -s OFFSCREENCANVAS_SUPPORT=1 \
+    -s OFFSCREENCANVASES_TO_PTHREAD="#canvas"
+@endcode
+
+The selector passed to `OFFSCREENCANVASES_TO_PTHREAD` has to match the ID of
+@cb{.js} Module.canvas @ce. The WebGL context is then created directly on the
+worker without proxying any GL calls to the main thread, the animation frame
+loop runs on the worker as well and all input events are proxied to it
+asynchronously. Because of that, accepting an event doesn't prevent the
+browser from handling it as well. Code in the class that accesses the DOM,
+such as @ref setWindowTitle() or @ref setCursor(), is executed synchronously
+on the main thread. If the application isn't built with pthreads or isn't
+running on a worker thread, @ref tryCreate() prints a message to
+@relativeref{Magnum,Error} and fails.
+
+@m_class{m-block m-warning}
+
+@par Browser support
+    Animation frames in workers and OffscreenCanvas with WebGL are not
+    available in all browsers yet. Check for support on the JavaScript side
+    and serve a build without the flag as a fallback.
+
 @section Platform-EmscriptenApplication-webgl WebGL-specific behavior
 
 While WebGL itself requires all extensions to be
@@ -880,7 +913,8 @@ class EmscriptenApplication {
             Redraw = 1 << 0,
             TextInputActive = 1 << 1,
             ExitRequested = 1 << 2,
-            LoopActive = 1 << 3
+            LoopActive = 1 << 3,
+            OffscreenCanvas = 1 << 4
         };
         typedef Containers::EnumSet<Flag> Flags;
 
@@ -1167,7 +1201,15 @@ class EmscriptenApplication::Configuration {
              * --- it depends on @ref redraw() being called independently of
              * this flag being set.
              */
-            AlwaysRequestAnimationFrame = 1 << 2
+            AlwaysRequestAnimationFrame = 1 << 2,
+
+            /**
+             * Render to an OffscreenCanvas on a worker thread. See
+             * @ref Platform-EmscriptenApplication-browser-offscreen-canvas
+             * for details and required build flags.
+             * @m_since_latest
+             */
+            OffscreenCanvas = 1 << 3
         };
 
         /**
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2018, 2019, 2020 Jonathan Hale <squareys@googlemail.com>
+    Copyright © 2020 Pablo Escobar <mail@rvrs.in>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EmscriptenFileFetcher.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <emscripten/fetch.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/FileCallback.h"
+
+namespace Magnum { namespace Platform {
+
+namespace {
+
+enum class Status: UnsignedByte {
+    Pending,
+    Fetched,
+    Failed,
+    /* Set right before closing a pending fetch, which calls onerror
+       synchronously */
+    Cancelled
+};
+
+}
+
+struct EmscriptenFileFetcher::State {
+    struct Entry {
+        State* state;
+        std::string filename;
+        emscripten_fetch_t* fetch;
+        Status status;
+        Callback callback;
+        void* userData;
+    };
+
+    static void onSuccess(emscripten_fetch_t* fetch);
+    static void onError(emscripten_fetch_t* fetch);
+
+    void close(Entry& entry);
+
+    Flags flags;
+    std::size_t pendingCount{}, failedCount{};
+    /* Node-based, so the entry pointers passed to emscripten_fetch() stay
+       valid across rehashes */
+    std::unordered_map<std::string, Entry> files;
+};
+
+void EmscriptenFileFetcher::State::onSuccess(emscripten_fetch_t* const fetch) {
+    Entry& entry = *static_cast<Entry*>(fetch->userData);
+    CORRADE_INTERNAL_ASSERT(entry.status == Status::Pending);
+    entry.status = Status::Fetched;
+    entry.fetch = fetch;
+    --entry.state->pendingCount;
+
+    if(entry.callback)
+        entry.callback(entry.filename, Containers::arrayView(fetch->data, std::size_t(fetch->numBytes)), entry.userData);
+}
+
+void EmscriptenFileFetcher::State::onError(emscripten_fetch_t* const fetch) {
+    Entry& entry = *static_cast<Entry*>(fetch->userData);
+    if(entry.status == Status::Cancelled) return;
+
+    CORRADE_INTERNAL_ASSERT(entry.status == Status::Pending);
+    Error{} << "Platform::EmscriptenFileFetcher: cannot fetch" << entry.filename << Debug::nospace << ":" << fetch->status << fetch->statusText;
+
+    /* The fetch is done at this point, so closing it won't call onerror
+       again */
+    entry.status = Status::Failed;
+    entry.fetch = nullptr;
+    --entry.state->pendingCount;
+    ++entry.state->failedCount;
+    emscripten_fetch_close(fetch);
+
+    if(entry.callback)
+        entry.callback(entry.filename, Containers::NullOpt, entry.userData);
+}
+
+void EmscriptenFileFetcher::State::close(Entry& entry) {
+    if(entry.status == Status::Pending) {
+        entry.status = Status::Cancelled;
+        --pendingCount;
+    } else if(entry.status == Status::Failed)
+        --failedCount;
+
+    if(entry.fetch) {
+        emscripten_fetch_close(entry.fetch);
+        entry.fetch = nullptr;
+    }
+}
+
+Containers::Optional<Containers::ArrayView<const char>> EmscriptenFileFetcher::fileCallback(const std::string& filename, const InputFileCallbackPolicy policy, EmscriptenFileFetcher& fetcher) {
+    /* The data are owned by the fetcher, nothing to do on close */
+    if(policy == InputFileCallbackPolicy::Close) return {};
+
+    return fetcher.data(filename);
+}
+
+EmscriptenFileFetcher::EmscriptenFileFetcher(const Flags flags): _state{Containers::InPlaceInit} {
+    _state->flags = flags;
+}
+
+EmscriptenFileFetcher::~EmscriptenFileFetcher() {
+    for(auto& file: _state->files) _state->close(file.second);
+}
+
+EmscriptenFileFetcher::Flags EmscriptenFileFetcher::flags() const {
+    return _state->flags;
+}
+
+void EmscriptenFileFetcher::fetch(const std::string& filename, const Callback callback, void* const userData) {
+    auto found = _state->files.find(filename);
+    if(found != _state->files.end()) {
+        State::Entry& entry = found->second;
+
+        /* Already fetched, call the callback directly */
+        if(entry.status == Status::Fetched) {
+            if(callback)
+                callback(filename, Containers::arrayView(entry.fetch->data, std::size_t(entry.fetch->numBytes)), userData);
+            return;
+        }
+
+        /* In progress, just replace the callback */
+        if(entry.status == Status::Pending) {
+            entry.callback = callback;
+            entry.userData = userData;
+            return;
+        }
+
+        /* Failed, fetch again */
+        CORRADE_INTERNAL_ASSERT(entry.status == Status::Failed);
+        --_state->failedCount;
+    } else found = _state->files.emplace(filename, State::Entry{_state.get(), filename, nullptr, Status::Pending, nullptr, nullptr}).first;
+
+    State::Entry& entry = found->second;
+    entry.status = Status::Pending;
+    entry.callback = callback;
+    entry.userData = userData;
+    ++_state->pendingCount;
+
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    std::strcpy(attr.requestMethod, "GET");
+    /* With PERSIST_FILE the file is looked up in IndexedDB first and
+       downloaded only if not there */
+    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
+    if(_state->flags & Flag::PersistToIndexedDB)
+        attr.attributes |= EMSCRIPTEN_FETCH_PERSIST_FILE;
+    attr.onsuccess = State::onSuccess;
+    attr.onerror = State::onError;
+    attr.userData = &entry;
+    emscripten_fetch_t* const fetch = emscripten_fetch(&attr, filename.data());
+    /* If the fetch failed right away, onerror was already called and closed
+       it */
+    if(entry.status == Status::Pending) entry.fetch = fetch;
+}
+
+std::size_t EmscriptenFileFetcher::pendingCount() const {
+    return _state->pendingCount;
+}
+
+std::size_t EmscriptenFileFetcher::failedCount() const {
+    return _state->failedCount;
+}
+
+bool EmscriptenFileFetcher::isFetched(const std::string& filename) const {
+    const auto found = _state->files.find(filename);
+    return found != _state->files.end() && found->second.status == Status::Fetched;
+}
+
+Containers::Optional<Containers::ArrayView<const char>> EmscriptenFileFetcher::data(const std::string& filename) const {
+    const auto found = _state->files.find(filename);
+    if(found == _state->files.end() || found->second.status != Status::Fetched)
+        return {};
+
+    return Containers::arrayView(found->second.fetch->data, std::size_t(found->second.fetch->numBytes));
+}
+
+void EmscriptenFileFetcher::remove(const std::string& filename) {
+    const auto found = _state->files.find(filename);
+    if(found == _state->files.end()) return;
+
+    _state->close(found->second);
+    _state->files.erase(found);
+}
+
+}}
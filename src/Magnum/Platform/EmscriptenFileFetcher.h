@@ -0,0 +1,224 @@
+#ifndef Magnum_Platform_EmscriptenFileFetcher_h
+#define Magnum_Platform_EmscriptenFileFetcher_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(CORRADE_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+/** @file
+ * @brief Class @ref Magnum::Platform::EmscriptenFileFetcher
+ * @m_since_latest
+ */
+#endif
+
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+
+#if defined(CORRADE_TARGET_EMSCRIPTEN) || defined(DOXYGEN_GENERATING_OUTPUT)
+namespace Magnum { namespace Platform {
+
+/**
+@brief Asynchronous file fetcher for Emscripten
+@m_since_latest
+
+Downloads files in the background using the [Emscripten Fetch API](https://emscripten.org/docs/api_reference/fetch.html),
+optionally caching them in the browser IndexedDB, and keeps the downloaded
+data in memory so they can be passed to importers through a file callback.
+Compared to preloading all assets into the virtual filesystem with
+`--preload-file`, the application can start right away, files are downloaded
+in parallel and subsequent page loads can be served from the IndexedDB cache
+instead of the network.
+
+@section Platform-EmscriptenFileFetcher-usage Usage
+
+Call @ref fetch() for all files you need, optionally with a callback that gets
+called once a particular file is available. The call doesn't block, the
+callbacks are executed from the browser event loop, i.e. in between
+@ref EmscriptenApplication::drawEvent() "drawEvent()" calls. Because importers
+may need more than just the main file, such as external buffers or images, it's
+best to fetch all of them and then open the main file through
+@ref fileCallback() once @ref pendingCount() reaches zero:
+
+@snippet MagnumPlatform-emscripten.cpp EmscriptenFileFetcher-usage
+
+The fetched data stay in memory until @ref remove() is called or the fetcher
+is destroyed. Destroying the fetcher also cancels all downloads that are still
+in progress, without calling their callbacks.
+
+@section Platform-EmscriptenFileFetcher-building Building
+
+The Fetch API needs to be explicitly enabled by passing `-s FETCH=1` to the
+linker. This class is built as a part of the @ref EmscriptenApplication
+library, but as it's in a separate object file, applications not using it
+don't need the flag.
+
+@see @ref Trade::AbstractImporter::setFileCallback()
+*/
+class EmscriptenFileFetcher {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref EmscriptenFileFetcher(Flags)
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Look up the files in the IndexedDB cache first and store
+             * downloaded files there. Enabled by default.
+             */
+            PersistToIndexedDB = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref EmscriptenFileFetcher(Flags)
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Fetch callback
+         *
+         * Called with the file name passed to @ref fetch(), the fetched data
+         * or @ref Containers::NullOpt if the fetch failed, and the user data
+         * pointer. The data are owned by the fetcher.
+         */
+        typedef void(*Callback)(const std::string&, Containers::Optional<Containers::ArrayView<const char>>, void*);
+
+        /**
+         * @brief File callback for importers
+         *
+         * Returns data of a file fetched with @ref fetch(). If the file isn't
+         * fetched yet or the fetch failed, returns @ref Containers::NullOpt.
+         * For @ref InputFileCallbackPolicy::Close it does nothing, the data
+         * stay available until @ref remove() is called. Pass it together with
+         * the fetcher instance to
+         * @ref Trade::AbstractImporter::setFileCallback() or any other API
+         * accepting a file callback.
+         */
+        static Containers::Optional<Containers::ArrayView<const char>> fileCallback(const std::string& filename, InputFileCallbackPolicy policy, EmscriptenFileFetcher& fetcher);
+
+        /** @brief Constructor */
+        explicit EmscriptenFileFetcher(Flags flags = Flag::PersistToIndexedDB);
+
+        /** @brief Copying is not allowed */
+        EmscriptenFileFetcher(const EmscriptenFileFetcher&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Callbacks of pending fetches reference the instance.
+         */
+        EmscriptenFileFetcher(EmscriptenFileFetcher&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Cancels all pending fetches and frees all fetched data.
+         */
+        ~EmscriptenFileFetcher();
+
+        /** @brief Copying is not allowed */
+        EmscriptenFileFetcher& operator=(const EmscriptenFileFetcher&) = delete;
+
+        /** @brief Moving is not allowed */
+        EmscriptenFileFetcher& operator=(EmscriptenFileFetcher&&) = delete;
+
+        /** @brief Flags */
+        Flags flags() const;
+
+        /**
+         * @brief Fetch a file
+         * @param filename  File name or URL, relative to the page
+         * @param callback  Callback to call once the fetch finishes or
+         *      @cpp nullptr @ce
+         * @param userData  User data passed to the callback
+         *
+         * Starts an asynchronous fetch and returns immediately. If the file
+         * is already fetched or a fetch of it is in progress, nothing is
+         * started again --- in the first case the callback is called
+         * immediately, in the second case it replaces the previously set
+         * callback. A file that failed to fetch is fetched again.
+         * @see @ref isFetched(), @ref pendingCount()
+         */
+        void fetch(const std::string& filename, Callback callback = nullptr, void* userData = nullptr);
+
+        /**
+         * @brief Count of fetches in progress
+         *
+         * @see @ref failedCount()
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Count of failed fetches
+         *
+         * Failed files are counted until they're fetched again or removed
+         * with @ref remove().
+         */
+        std::size_t failedCount() const;
+
+        /**
+         * @brief Whether given file is fetched
+         *
+         * Returns @cpp false @ce also if the fetch is in progress, failed or
+         * the file wasn't requested at all.
+         */
+        bool isFetched(const std::string& filename) const;
+
+        /**
+         * @brief Fetched data
+         *
+         * If the file isn't fetched, returns @ref Containers::NullOpt.
+         * @see @ref isFetched(), @ref fileCallback()
+         */
+        Containers::Optional<Containers::ArrayView<const char>> data(const std::string& filename) const;
+
+        /**
+         * @brief Remove a file
+         *
+         * Frees the fetched data. If the fetch is in progress, it's cancelled
+         * without calling the callback. Does nothing if the file wasn't
+         * requested. Data cached in IndexedDB are kept.
+         */
+        void remove(const std::string& filename);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(EmscriptenFileFetcher::Flags)
+
+}}
+#else
+#error this file is available only on Emscripten build
+#endif
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef Magnum_Platform_GLWorkerThreads_h
+#define Magnum_Platform_GLWorkerThreads_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef MAGNUM_TARGET_GL
+/** @file
+ * @brief Class @ref Magnum::Platform::GLWorkerThreads
+ * @m_since_latest
+ */
+#endif
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Platform/GLContext.h"
+
+namespace Magnum { namespace Platform {
+
+/**
+@brief Worker threads with shared OpenGL contexts
+@tparam WindowlessContext   Windowless context class such as
+    @ref WindowlessEglContext or @ref WindowlessGlxContext
+@m_since_latest
+
+Spawns a given count of threads, each with its own windowless OpenGL context
+and its own @ref GLContext instance, and runs tasks submitted with
+@ref submit() on them. When the contexts are created sharing objects with
+the main application context, this can be used to upload textures and buffers
+off the main thread:
+
+@snippet MagnumPlatform-windowless-thread.cpp GLWorkerThreads
+
+Following the advice in @ref platform-windowless-contexts, the windowless
+contexts are created on the thread calling the constructor and then made
+current on the worker threads. Each worker then creates its own
+@ref GLContext, so GL state tracking is isolated between the workers and the
+main thread. This relies on @ref GL::Context::current() being thread-local,
+which is the case only if @ref CORRADE_BUILD_MULTITHREADED is enabled.
+
+After each task, @ref GL::Renderer::finish() is called, so when @ref wait()
+returns, all objects created by the tasks are complete and can be used from
+the other contexts sharing them. Note that only the data are shared between
+contexts --- container objects such as @ref GL::Mesh (vertex array objects)
+or @ref GL::Framebuffer are not and have to be created in the context that
+uses them.
+
+It's also possible to pass a different configuration to each thread, for
+example to render on all GPUs in the system with
+@ref WindowlessEglContext::Configuration::setDevice(). See
+@ref Platform-WindowlessEglApplication-multiple-devices for an example.
+*/
+template<class WindowlessContext> class GLWorkerThreads {
+    public:
+        /**
+         * @brief Constructor
+         * @param count         Worker thread count
+         * @param configuration Configuration of the windowless contexts.
+         *      Use @cpp WindowlessContext::Configuration::setSharedContext() @ce
+         *      to share objects with another context.
+         * @param argc          Count of command-line arguments passed to
+         *      each @ref GLContext
+         * @param argv          Command-line arguments passed to each
+         *      @ref GLContext
+         *
+         * Creates the windowless contexts, spawns the threads and waits until
+         * all of them have their context current and @ref GLContext created.
+         * Workers for which the context creation failed aren't started and
+         * aren't counted in @ref threadCount(), the failure is printed by
+         * the context itself.
+         */
+        explicit GLWorkerThreads(std::size_t count, const typename WindowlessContext::Configuration& configuration, Int argc = 0, const char** argv = nullptr);
+
+        /**
+         * @brief Construct with a configuration for each thread
+         * @param configurations    Configurations of the windowless
+         *      contexts, one worker thread is spawned for each
+         * @param argc              Count of command-line arguments passed to
+         *      each @ref GLContext
+         * @param argv              Command-line arguments passed to each
+         *      @ref GLContext
+         *
+         * Useful for example for creating contexts on different devices.
+         * Apart from that, behaves the same as
+         * @ref GLWorkerThreads(std::size_t, const typename WindowlessContext::Configuration&, Int, const char**).
+         */
+        explicit GLWorkerThreads(Containers::ArrayView<const typename WindowlessContext::Configuration> configurations, Int argc = 0, const char** argv = nullptr);
+
+        /** @brief Copying is not allowed */
+        GLWorkerThreads(const GLWorkerThreads<WindowlessContext>&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLWorkerThreads(GLWorkerThreads<WindowlessContext>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits until all submitted tasks are done, then destroys the
+         * @ref GLContext instances on the worker threads and joins them.
+         */
+        ~GLWorkerThreads();
+
+        /** @brief Copying is not allowed */
+        GLWorkerThreads<WindowlessContext>& operator=(const GLWorkerThreads<WindowlessContext>&) = delete;
+
+        /** @brief Moving is not allowed */
+        GLWorkerThreads<WindowlessContext>& operator=(GLWorkerThreads<WindowlessContext>&&) = delete;
+
+        /**
+         * @brief Count of running worker threads
+         *
+         * Can be less than the count passed to the constructor if creating
+         * some of the contexts failed.
+         */
+        std::size_t threadCount() const { return _workers.size(); }
+
+        /**
+         * @brief Submit a task
+         *
+         * The @p task is executed on the first worker thread that's free,
+         * with its OpenGL context current. Tasks are picked up in the order
+         * they were submitted, but may be finished in a different order if
+         * there's more than one thread. Expects that @ref threadCount() is
+         * not zero.
+         * @see @ref submitIndexed(), @ref wait()
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Submit a task that's given a thread ID
+         *
+         * Like @ref submit(), but the @p task gets an ID of the worker
+         * thread it's executed on, in range @cpp [0, threadCount()) @ce.
+         * Useful for accessing per-thread resources when the contexts don't
+         * share objects, such as when each is on a different device.
+         */
+        void submitIndexed(std::function<void(std::size_t)> task);
+
+        /**
+         * @brief Wait for all submitted tasks to finish
+         *
+         * After this function returns, objects created by the tasks can be
+         * used from contexts sharing them.
+         */
+        void wait();
+
+    private:
+        struct Worker {
+            WindowlessContext context;
+            std::thread thread;
+            std::size_t id;
+        };
+
+        void addWorker(const typename WindowlessContext::Configuration& configuration);
+        void start(Int argc, const char** argv);
+        void run(Worker& worker, Int argc, const char** argv);
+
+        std::vector<Containers::Pointer<Worker>> _workers;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        /* Everything below is guarded by the mutex */
+        std::deque<std::function<void(std::size_t)>> _tasks;
+        std::size_t _runningTaskCount{}, _initializedCount{};
+        std::size_t _failedCount{};
+        bool _exit{};
+};
+
+template<class WindowlessContext> GLWorkerThreads<WindowlessContext>::GLWorkerThreads(const std::size_t count, const typename WindowlessContext::Configuration& configuration, const Int argc, const char** const argv) {
+    _workers.reserve(count);
+    for(std::size_t i = 0; i != count; ++i)
+        addWorker(configuration);
+    start(argc, argv);
+}
+
+template<class WindowlessContext> GLWorkerThreads<WindowlessContext>::GLWorkerThreads(const Containers::ArrayView<const typename WindowlessContext::Configuration> configurations, const Int argc, const char** const argv) {
+    _workers.reserve(configurations.size());
+    for(const typename WindowlessContext::Configuration& configuration: configurations)
+        addWorker(configuration);
+    start(argc, argv);
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::addWorker(const typename WindowlessContext::Configuration& configuration) {
+    /* Context creation isn't thread-safe everywhere, so do it on the
+       constructing thread */
+    Containers::Pointer<Worker> worker{new Worker{WindowlessContext{configuration}, std::thread{}, 0}};
+    if(!worker->context.isCreated()) return;
+    _workers.push_back(std::move(worker));
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::start(const Int argc, const char** const argv) {
+    for(Containers::Pointer<Worker>& worker: _workers)
+        worker->thread = std::thread{&GLWorkerThreads<WindowlessContext>::run, this, std::ref(*worker), argc, argv};
+
+    /* Wait until all workers have their contexts ready, and remove the ones
+       that failed */
+    {
+        std::unique_lock<std::mutex> lock{_mutex};
+        _condition.wait(lock, [this]() {
+            return _initializedCount + _failedCount == _workers.size();
+        });
+    }
+    for(std::size_t i = 0; i != _workers.size(); ) {
+        if(_workers[i]->thread.joinable() && !_workers[i]->context.isCreated()) {
+            _workers[i]->thread.join();
+            _workers.erase(_workers.begin() + i);
+        } else ++i;
+    }
+
+    /* Assign contiguous IDs to the remaining workers. No tasks could have
+       been submitted yet, and the workers read the ID only after locking the
+       mutex in submitIndexed(), so this is safe. */
+    for(std::size_t i = 0; i != _workers.size(); ++i)
+        _workers[i]->id = i;
+}
+
+template<class WindowlessContext> GLWorkerThreads<WindowlessContext>::~GLWorkerThreads() {
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _exit = true;
+    }
+    _condition.notify_all();
+    for(Containers::Pointer<Worker>& worker: _workers)
+        worker->thread.join();
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::submit(std::function<void()> task) {
+    CORRADE_ASSERT(!_workers.empty(),
+        "Platform::GLWorkerThreads::submit(): no worker threads running", );
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _tasks.push_back([task](std::size_t) { task(); });
+    }
+    _condition.notify_all();
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::submitIndexed(std::function<void(std::size_t)> task) {
+    CORRADE_ASSERT(!_workers.empty(),
+        "Platform::GLWorkerThreads::submitIndexed(): no worker threads running", );
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _tasks.push_back(std::move(task));
+    }
+    _condition.notify_all();
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::wait() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    _condition.wait(lock, [this]() {
+        return _tasks.empty() && !_runningTaskCount;
+    });
+}
+
+template<class WindowlessContext> void GLWorkerThreads<WindowlessContext>::run(Worker& worker, const Int argc, const char** const argv) {
+    WindowlessContext& context = worker.context;
+    GLContext glContext{NoCreate, argc, argv};
+    if(!context.makeCurrent() || !glContext.tryCreate()) {
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            /* Destroy the windowless context so the constructor knows this
+               worker failed */
+            context = WindowlessContext{NoCreate};
+            ++_failedCount;
+        }
+        _condition.notify_all();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        ++_initializedCount;
+    }
+    _condition.notify_all();
+
+    for(;;) {
+        std::function<void(std::size_t)> task;
+        std::size_t id;
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _condition.wait(lock, [this]() {
+                return !_tasks.empty() || _exit;
+            });
+            if(_tasks.empty()) break;
+
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+            ++_runningTaskCount;
+            id = worker.id;
+        }
+
+        task(id);
+
+        /* Make sure everything is done before reporting the task as finished
+           so the objects can be safely used from other contexts */
+        GL::Renderer::finish();
+
+        {
+            std::lock_guard<std::mutex> lock{_mutex};
+            --_runningTaskCount;
+        }
+        _condition.notify_all();
+    }
+}
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
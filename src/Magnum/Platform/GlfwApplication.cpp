@@ -44,6 +44,10 @@
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/Version.h"
 #include "Magnum/Platform/GLContext.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/Platform/Implementation/FramePacer.h"
+#endif
 #endif
 
 namespace Magnum { namespace Platform {
@@ -664,6 +668,11 @@ void GlfwApplication::setupCallbacks() {
 }
 
 GlfwApplication::~GlfwApplication() {
+    /* The frame pacer holds GL fences, destroy it while the context is still
+       alive */
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    _framePacer = nullptr;
+    #endif
     glfwDestroyWindow(_window);
     for(auto& cursor: _cursors)
         glfwDestroyCursor(cursor);
@@ -713,10 +722,71 @@ Vector2i GlfwApplication::framebufferSize() const {
 }
 #endif
 
+void GlfwApplication::swapBuffers() {
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    if(_framePacer) _framePacer->beforeSwap();
+    #endif
+    glfwSwapBuffers(_window);
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    if(_framePacer) _framePacer->afterSwap();
+    #endif
+}
+
 void GlfwApplication::setSwapInterval(const Int interval) {
     glfwSwapInterval(interval);
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    _swapInterval = interval;
+    #endif
+}
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+bool GlfwApplication::isFramePacingEnabled() const {
+    return !!_framePacer;
+}
+
+bool GlfwApplication::setFramePacingEnabled(const bool enabled) {
+    if(!enabled) {
+        _framePacer = nullptr;
+        return true;
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!_context || !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sync>()) {
+        Error() << "Platform::GlfwApplication::setFramePacingEnabled():" << GL::Extensions::ARB::sync::string() << "is not supported";
+        return false;
+    }
+    #endif
+
+    if(!_framePacer)
+        _framePacer.emplace(_framePacingMargin);
+    return true;
 }
 
+UnsignedLong GlfwApplication::framePacingMargin() const {
+    return _framePacingMargin;
+}
+
+void GlfwApplication::setFramePacingMargin(const UnsignedLong nanoseconds) {
+    _framePacingMargin = nanoseconds;
+    if(_framePacer) _framePacer->setMargin(nanoseconds);
+}
+
+UnsignedLong GlfwApplication::framePacingLatency() const {
+    return _framePacer ? _framePacer->latency() : 0;
+}
+
+UnsignedLong GlfwApplication::framePacingPeriod() const {
+    if(!_swapInterval) return 0;
+
+    GLFWmonitor* monitor = glfwGetWindowMonitor(_window);
+    if(!monitor) monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* const mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    if(!mode || !mode->refreshRate) return 0;
+
+    return 1000000000ull*(_swapInterval < 0 ? -_swapInterval : _swapInterval)/mode->refreshRate;
+}
+#endif
+
 void GlfwApplication::redraw() { _flags |= Flag::Redraw; }
 
 int GlfwApplication::exec() {
@@ -760,6 +830,17 @@ bool GlfwApplication::mainLoopIteration() {
     if(_flags & Flag::Redraw) {
         _flags &= ~Flag::Redraw;
         drawEvent();
+
+        /* With frame pacing, wait until the GPU is done with the frame and
+           then poll for input as late as possible so the next frame gets
+           finished just before it's presented */
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+        if(_framePacer) {
+            _framePacer->frameDone();
+            _framePacer->beforePoll(framePacingPeriod());
+        }
+        #endif
+
         glfwPollEvents();
     } else glfwWaitEvents();
 
@@ -54,6 +54,9 @@ namespace Magnum { namespace Platform {
 
 namespace Implementation {
     enum class GlfwDpiScalingPolicy: UnsignedByte;
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    class FramePacer;
+    #endif
 }
 
 /** @nosubgrouping
@@ -504,7 +507,7 @@ class GlfwApplication {
          *
          * Paints currently rendered framebuffer on screen.
          */
-        void swapBuffers() { glfwSwapBuffers(_window); }
+        void swapBuffers();
 
         /**
          * @brief Set swap interval
@@ -519,6 +522,59 @@ class GlfwApplication {
          */
         void setSwapInterval(Int interval);
 
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+        /**
+         * @brief Whether frame pacing is enabled
+         * @m_since_latest
+         *
+         * @see @ref setFramePacingEnabled()
+         */
+        bool isFramePacingEnabled() const;
+
+        /**
+         * @brief Enable or disable frame pacing
+         * @m_since_latest
+         *
+         * Works the same as @ref Sdl2Application::setFramePacingEnabled(),
+         * see its documentation for details. As GLFW doesn't provide any
+         * getter for the swap interval, the presentation period is
+         * calculated from the monitor refresh rate and the value last passed
+         * to @ref setSwapInterval(), assuming VSync is enabled if it wasn't
+         * called. If the swap interval is @cpp 0 @ce, input polling isn't
+         * delayed.
+         * @requires_gl32 Extension @gl_extension{ARB,sync}
+         * @requires_gles30 Not available on OpenGL ES 2.0.
+         */
+        bool setFramePacingEnabled(bool enabled);
+
+        /**
+         * @brief Frame pacing margin
+         * @m_since_latest
+         *
+         * In nanoseconds.
+         * @see @ref setFramePacingMargin()
+         */
+        UnsignedLong framePacingMargin() const;
+
+        /**
+         * @brief Set frame pacing margin
+         * @m_since_latest
+         *
+         * See @ref Sdl2Application::setFramePacingMargin() for more
+         * information.
+         */
+        void setFramePacingMargin(UnsignedLong nanoseconds);
+
+        /**
+         * @brief Frame pacing latency
+         * @m_since_latest
+         *
+         * See @ref Sdl2Application::framePacingLatency() for more
+         * information.
+         */
+        UnsignedLong framePacingLatency() const;
+        #endif
+
         /** @copydoc Sdl2Application::redraw() */
         void redraw();
 
@@ -735,6 +791,10 @@ class GlfwApplication {
 
         void setupCallbacks();
 
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+        UnsignedLong framePacingPeriod() const;
+        #endif
+
         GLFWcursor* _cursors[8]{};
         Cursor _cursor = Cursor::Arrow;
 
@@ -748,6 +808,11 @@ class GlfwApplication {
         Flags _flags;
         #ifdef MAGNUM_TARGET_GL
         Containers::Pointer<Platform::GLContext> _context;
+        #ifndef MAGNUM_TARGET_GLES2
+        Containers::Pointer<Implementation::FramePacer> _framePacer;
+        UnsignedLong _framePacingMargin{1000000};
+        Int _swapInterval{1};
+        #endif
         #endif
         int _exitCode = 0;
 
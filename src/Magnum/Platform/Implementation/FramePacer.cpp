@@ -0,0 +1,97 @@
+#ifndef Magnum_Platform_Implementation_dpiScaling_hpp
+#define Magnum_Platform_Implementation_dpiScaling_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FramePacer.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include <chrono>
+#include <thread>
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+namespace {
+
+UnsignedLong now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Don't let a hung GPU block the application forever */
+constexpr UnsignedLong FenceTimeout = 1000000000ull;
+
+}
+
+void FramePacer::beforePoll(const UnsignedLong period) {
+    if(period && _presentTime) {
+        const UnsignedLong wait = _workEstimate + _margin;
+        const UnsignedLong target = _presentTime + period - (wait < period ? wait : period);
+
+        /* If the target is already past, the application is either too slow
+           to make it in a single period or it was idle for a while. Poll
+           immediately in both cases. */
+        const UnsignedLong current = now();
+        if(target > current)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(target - current));
+    }
+
+    _pollTime = now();
+}
+
+void FramePacer::beforeSwap() {
+    _renderFence = GL::Fence{};
+}
+
+void FramePacer::afterSwap() {
+    _presentFence = GL::Fence{};
+}
+
+void FramePacer::frameDone() {
+    /* Nothing to measure if the buffers weren't swapped in the draw event */
+    if(!_renderFence.id() || !_presentFence.id()) return;
+
+    _renderFence.clientWait(FenceTimeout);
+    const UnsignedLong renderTime = now();
+    _presentFence.clientWait(FenceTimeout);
+    _presentTime = now();
+    _renderFence = GL::Fence{NoCreate};
+    _presentFence = GL::Fence{NoCreate};
+
+    /* If pacing got enabled in the middle of a frame, there's no poll time
+       to measure the workload against */
+    if(!_pollTime) return;
+
+    /* Grow the workload estimate immediately to avoid missing the next
+       presentation, but shrink it only slowly to not be affected by
+       occasional short frames */
+    const UnsignedLong work = renderTime - _pollTime;
+    _workEstimate = work > _workEstimate ? work : (_workEstimate*7 + work)/8;
+
+    const UnsignedLong latency = _presentTime - _pollTime;
+    _latency = _latency ? (_latency*7 + latency)/8 : latency;
+}
+
+}}}
+#endif
@@ -0,0 +1,74 @@
+#ifndef Magnum_Platform_Implementation_FramePacer_h
+#define Magnum_Platform_Implementation_FramePacer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Magnum.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Magnum/GL/Fence.h"
+
+namespace Magnum { namespace Platform { namespace Implementation {
+
+/* Frame pacing shared by Sdl2Application and GlfwApplication. The application
+   calls beforePoll() right before polling for input, beforeSwap() and
+   afterSwap() around the buffer swap and frameDone() after drawEvent().
+
+   A fence inserted before the swap tells when the GPU finished rendering, one
+   inserted after the swap approximates when the frame got presented. Waiting
+   for both additionally prevents the CPU from queuing frames ahead of the
+   GPU. The time from input polling to rendering finished is used as an
+   estimate of the frame workload, and the next polling is then delayed so the
+   frame gets done just before the next presentation. All times are in
+   nanoseconds. */
+class FramePacer {
+    public:
+        explicit FramePacer(UnsignedLong margin): _margin{margin} {}
+
+        UnsignedLong margin() const { return _margin; }
+        void setMargin(UnsignedLong margin) { _margin = margin; }
+
+        /* Average time from input polling to the frame getting presented */
+        UnsignedLong latency() const { return _latency; }
+
+        /* Sleeps until the predicted time for polling input, if the period
+           is known. Pass 0 if the presentation isn't synchronized to
+           anything, in which case it doesn't sleep. */
+        void beforePoll(UnsignedLong period);
+
+        void beforeSwap();
+        void afterSwap();
+        void frameDone();
+
+    private:
+        UnsignedLong _margin;
+        UnsignedLong _pollTime{}, _presentTime{}, _workEstimate{}, _latency{};
+        GL::Fence _renderFence{NoCreate}, _presentFence{NoCreate};
+};
+
+}}}
+#endif
+
+#endif
@@ -39,6 +39,7 @@ template<class> class BasicScreenedApplication;
 
 #ifdef MAGNUM_TARGET_GL
 class GLContext;
+template<class> class GLWorkerThreads;
 #endif
 #endif
 
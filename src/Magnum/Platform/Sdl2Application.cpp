@@ -35,11 +35,22 @@
 #pragma clang diagnostic ignored "-Wpragma-pack"
 #endif
 #include <SDL.h>
+#if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006
+/* Magnum/Vk/Vulkan.h is included by Sdl2Application.h already, so SDL doesn't
+   provide its own (conflicting) Vulkan typedefs */
+#include <SDL_vulkan.h>
+#endif
 #ifdef CORRADE_TARGET_CLANG_CL
 #pragma clang diagnostic pop
 #endif
 #ifndef CORRADE_TARGET_EMSCRIPTEN
 #include <tuple>
+#ifdef MAGNUM_TARGET_GL
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
 #else
 #include <emscripten/emscripten.h>
 #include <emscripten/html5.h>
@@ -57,6 +68,10 @@
 #ifdef MAGNUM_TARGET_GL
 #include "Magnum/GL/Version.h"
 #include "Magnum/Platform/GLContext.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/Platform/Implementation/FramePacer.h"
+#endif
 #endif
 
 #if defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT)
@@ -103,6 +118,27 @@ enum class Sdl2Application::Flag: UnsignedByte {
     #endif
 };
 
+#if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+struct Sdl2Application::RenderThread {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    /* Guarded by the mutex. The frame is requested by the main thread and
+       reset back by the render thread once it's drawn. */
+    bool frameRequested{}, exit{};
+    bool viewportEventPending{};
+    SDL_Event viewportEvent;
+    Vector2i windowSize, framebufferSize;
+    Vector2 dpiScaling;
+
+    /* Redraw requested from the render thread, picked up by the main thread,
+       which gets woken up by an event of this type */
+    std::atomic<bool> redraw{};
+    Uint32 wakeupEventType;
+};
+#endif
+
 Sdl2Application::Sdl2Application(const Arguments& arguments): Sdl2Application{arguments, Configuration{}} {}
 
 Sdl2Application::Sdl2Application(const Arguments& arguments, const Configuration& configuration): Sdl2Application{arguments, NoCreate} {
@@ -679,6 +715,13 @@ bool Sdl2Application::tryCreate(const Configuration& configuration, const GLConf
     /* Show the window once we are sure that everything is okay */
     if(!(configuration.windowFlags() & Configuration::WindowFlag::Hidden))
         SDL_ShowWindow(_window);
+
+    /* The thread itself gets started only in the main loop, so the context
+       is usable from the main thread until then */
+    if(glConfiguration.isRenderThreadEnabled()) {
+        _renderThread.emplace();
+        _renderThread->wakeupEventType = SDL_RegisterEvents(1);
+    }
     #endif
 
     /* Return true if the initialization succeeds */
@@ -752,7 +795,13 @@ void Sdl2Application::setContainerCssClass(const std::string& cssClass) {
 
 void Sdl2Application::swapBuffers() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    if(_framePacer) _framePacer->beforeSwap();
+    #endif
     SDL_GL_SwapWindow(_window);
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+    if(_framePacer) _framePacer->afterSwap();
+    #endif
     #else
     SDL_Flip(_surface);
     #endif
@@ -780,7 +829,150 @@ bool Sdl2Application::setSwapInterval(const Int interval) {
     return true;
 }
 
-void Sdl2Application::redraw() { _flags |= Flag::Redraw; }
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+bool Sdl2Application::isFramePacingEnabled() const {
+    return !!_framePacer;
+}
+
+bool Sdl2Application::setFramePacingEnabled(const bool enabled) {
+    if(!enabled) {
+        _framePacer = nullptr;
+        return true;
+    }
+
+    if(_renderThread) {
+        Error() << "Platform::Sdl2Application::setFramePacingEnabled(): frame pacing can't be used together with a render thread";
+        return false;
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!_context || !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::sync>()) {
+        Error() << "Platform::Sdl2Application::setFramePacingEnabled():" << GL::Extensions::ARB::sync::string() << "is not supported";
+        return false;
+    }
+    #endif
+
+    if(!_framePacer)
+        _framePacer.emplace(_framePacingMargin);
+    return true;
+}
+
+UnsignedLong Sdl2Application::framePacingMargin() const {
+    return _framePacingMargin;
+}
+
+void Sdl2Application::setFramePacingMargin(const UnsignedLong nanoseconds) {
+    _framePacingMargin = nanoseconds;
+    if(_framePacer) _framePacer->setMargin(nanoseconds);
+}
+
+UnsignedLong Sdl2Application::framePacingLatency() const {
+    return _framePacer ? _framePacer->latency() : 0;
+}
+
+UnsignedLong Sdl2Application::framePacingPeriod() const {
+    if(_flags & Flag::VSyncEnabled) {
+        SDL_DisplayMode mode;
+        const Int interval = SDL_GL_GetSwapInterval();
+        if(SDL_GetWindowDisplayMode(_window, &mode) == 0 && mode.refresh_rate)
+            return 1000000000ull*(interval < 0 ? -interval : interval)/mode.refresh_rate;
+        return 0;
+    }
+
+    return _minimalLoopPeriod*1000000ull;
+}
+#endif
+
+#if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void Sdl2Application::startRenderThread() {
+    if(_renderThread->thread.joinable()) return;
+
+    /* Release the context from the main thread so it can be made current on
+       the render thread */
+    SDL_GL_MakeCurrent(_window, nullptr);
+    GL::Context::makeCurrent(nullptr);
+    _renderThread->thread = std::thread{&Sdl2Application::renderThreadLoop, this};
+}
+
+void Sdl2Application::stopRenderThread() {
+    if(!_renderThread->thread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock{_renderThread->mutex};
+        _renderThread->exit = true;
+    }
+    _renderThread->condition.notify_all();
+    _renderThread->thread.join();
+    _renderThread->exit = false;
+    _renderThread->frameRequested = false;
+
+    /* Make the context current on the main thread again so GL objects can be
+       destroyed there */
+    SDL_GL_MakeCurrent(_window, _glContext);
+    GL::Context::makeCurrent(_context.get());
+}
+
+void Sdl2Application::renderThreadLoop() {
+    RenderThread& state = *_renderThread;
+    SDL_GL_MakeCurrent(_window, _glContext);
+    GL::Context::makeCurrent(_context.get());
+
+    for(;;) {
+        bool viewportEventPending;
+        SDL_Event viewportEventData;
+        Vector2i windowSize, framebufferSize;
+        Vector2 dpiScaling;
+        {
+            std::unique_lock<std::mutex> lock{state.mutex};
+            state.condition.wait(lock, [&state]() {
+                return state.frameRequested || state.exit;
+            });
+            if(state.exit) break;
+
+            viewportEventPending = state.viewportEventPending;
+            viewportEventData = state.viewportEvent;
+            windowSize = state.windowSize;
+            framebufferSize = state.framebufferSize;
+            dpiScaling = state.dpiScaling;
+            state.viewportEventPending = false;
+        }
+
+        /* The viewport event usually updates GL state, so it has to be called
+           here and not on the main thread */
+        if(viewportEventPending) {
+            ViewportEvent e{viewportEventData, windowSize, framebufferSize, dpiScaling};
+            viewportEvent(e);
+        }
+
+        drawEvent();
+
+        {
+            std::lock_guard<std::mutex> lock{state.mutex};
+            state.frameRequested = false;
+        }
+        state.condition.notify_all();
+    }
+
+    SDL_GL_MakeCurrent(_window, nullptr);
+    GL::Context::makeCurrent(nullptr);
+}
+#endif
+
+void Sdl2Application::redraw() {
+    /* If called from the render thread, hand the request over to the main
+       thread and wake it up in case it's waiting for events */
+    #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(_renderThread && std::this_thread::get_id() == _renderThread->thread.get_id()) {
+        _renderThread->redraw = true;
+        SDL_Event event{};
+        event.type = _renderThread->wakeupEventType;
+        SDL_PushEvent(&event);
+        return;
+    }
+    #endif
+
+    _flags |= Flag::Redraw;
+}
 
 Sdl2Application::~Sdl2Application() {
     /* SDL_DestroyWindow(_window) crashes on windows when _window is nullptr
@@ -789,6 +981,16 @@ Sdl2Application::~Sdl2Application() {
        all. */
 
     #ifdef MAGNUM_TARGET_GL
+    /* Get the context back from the render thread, if not already */
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(_renderThread) stopRenderThread();
+    #endif
+
+    /* The frame pacer holds GL fences, destroy it while the context is still
+       alive */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    _framePacer = nullptr;
+    #endif
     _context.reset();
 
     #ifndef CORRADE_TARGET_EMSCRIPTEN
@@ -812,6 +1014,9 @@ Sdl2Application::~Sdl2Application() {
 int Sdl2Application::exec() {
     #ifndef CORRADE_TARGET_EMSCRIPTEN
     while(mainLoopIteration()) {}
+    #ifdef MAGNUM_TARGET_GL
+    if(_renderThread) stopRenderThread();
+    #endif
     #else
     emscripten_set_main_loop_arg([](void* arg) {
         static_cast<Sdl2Application*>(arg)->mainLoopIteration();
@@ -820,6 +1025,38 @@ int Sdl2Application::exec() {
     return _exitCode;
 }
 
+#if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006
+Containers::Array<Containers::StringView> Sdl2Application::vulkanInstanceExtensions() {
+    unsigned int count;
+    if(!SDL_Vulkan_GetInstanceExtensions(_window, &count, nullptr)) {
+        Error() << "Platform::Sdl2Application::vulkanInstanceExtensions(): cannot query extensions:" << SDL_GetError();
+        return {};
+    }
+
+    Containers::Array<const char*> names{Containers::ValueInit, count};
+    if(!SDL_Vulkan_GetInstanceExtensions(_window, &count, names)) {
+        Error() << "Platform::Sdl2Application::vulkanInstanceExtensions(): cannot query extensions:" << SDL_GetError();
+        return {};
+    }
+
+    /* The strings are static inside SDL */
+    Containers::Array<Containers::StringView> out{Containers::ValueInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = Containers::StringView{names[i], Containers::StringViewFlag::Global};
+    return out;
+}
+
+VkSurfaceKHR Sdl2Application::createVulkanSurface(const VkInstance instance) {
+    VkSurfaceKHR surface;
+    if(!SDL_Vulkan_CreateSurface(_window, instance, &surface)) {
+        Error() << "Platform::Sdl2Application::createVulkanSurface(): cannot create surface:" << SDL_GetError();
+        return {};
+    }
+
+    return surface;
+}
+#endif
+
 void Sdl2Application::exit(const int exitCode) {
     /* On Emscripten this flag is used only to indicate a desire to exit from
        mainLoopIteration() */
@@ -845,6 +1082,17 @@ bool Sdl2Application::mainLoopIteration() {
     const UnsignedInt timeBefore = _minimalLoopPeriod ? SDL_GetTicks() : 0;
     #endif
 
+    #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(_renderThread) startRenderThread();
+    #endif
+
+    /* With frame pacing enabled, poll for input as late as possible so the
+       frame gets finished just before it's presented */
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(_framePacer && (_flags & Flag::Redraw))
+        _framePacer->beforePoll(framePacingPeriod());
+    #endif
+
     #ifdef CORRADE_TARGET_EMSCRIPTEN
     /* The resize event is not fired on window resize, so poll for the canvas
        size here. But only if the window was requested to be resizable, to
@@ -876,6 +1124,12 @@ bool Sdl2Application::mainLoopIteration() {
 
     SDL_Event event;
     while(SDL_PollEvent(&event)) {
+        /* Events used just to wake up the main loop from the render thread */
+        #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        if(_renderThread && event.type == _renderThread->wakeupEventType)
+            continue;
+        #endif
+
         switch(event.type) {
             case SDL_WINDOWEVENT:
                 switch(event.window.event) {
@@ -893,6 +1147,21 @@ bool Sdl2Application::mainLoopIteration() {
                            framebuffer size and not window size on macOS, which
                            is weird. Query the values directly instead to be
                            really sure. */
+                        #ifdef MAGNUM_TARGET_GL
+                        /* With a render thread the event gets delivered there
+                           before the next frame */
+                        if(_renderThread) {
+                            std::lock_guard<std::mutex> lock{_renderThread->mutex};
+                            _renderThread->viewportEventPending = true;
+                            _renderThread->viewportEvent = event;
+                            _renderThread->windowSize = windowSize();
+                            _renderThread->framebufferSize = framebufferSize();
+                            _renderThread->dpiScaling = _dpiScaling;
+                            _flags |= Flag::Redraw;
+                            break;
+                        }
+                        #endif
+
                         ViewportEvent e{event, windowSize(),
                             #ifdef MAGNUM_TARGET_GL
                             framebufferSize(),
@@ -981,11 +1250,48 @@ bool Sdl2Application::mainLoopIteration() {
     if(!(_flags & Flag::NoTickEvent)) tickEvent();
 
     /* Draw event */
+    #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    if(_renderThread) {
+        if(_renderThread->redraw.exchange(false))
+            _flags |= Flag::Redraw;
+
+        if(_flags & Flag::Redraw) {
+            std::unique_lock<std::mutex> lock{_renderThread->mutex};
+
+            /* If the render thread is still busy with the previous frame,
+               give it a moment and then go back to processing events instead
+               of blocking them */
+            RenderThread& state = *_renderThread;
+            if(!state.condition.wait_for(lock, std::chrono::milliseconds(1), [&state]() {
+                return !state.frameRequested;
+            }))
+                return !(_flags & Flag::Exit);
+
+            /* The render thread is idle now, hand it the next frame */
+            _flags &= ~Flag::Redraw;
+            renderThreadSyncEvent();
+            state.frameRequested = true;
+            lock.unlock();
+            state.condition.notify_all();
+            return !(_flags & Flag::Exit);
+        }
+    }
+    #endif
+
     if(_flags & Flag::Redraw) {
         _flags &= ~Flag::Redraw;
         drawEvent();
 
         #ifndef CORRADE_TARGET_EMSCRIPTEN
+        /* With frame pacing, wait until the GPU is done with the frame. The
+           minimal loop period is then handled by the pacing itself. */
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+        if(_framePacer) {
+            _framePacer->frameDone();
+            return !(_flags & Flag::Exit);
+        }
+        #endif
+
         /* If VSync is not enabled, delay to prevent CPU hogging (if set) */
         if(!(_flags & Flag::VSyncEnabled) && _minimalLoopPeriod) {
             const UnsignedInt loopTime = SDL_GetTicks() - timeBefore;
@@ -1151,6 +1457,10 @@ void Sdl2Application::tickEvent() {
     _flags |= Flag::NoTickEvent;
 }
 
+#if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+void Sdl2Application::renderThreadSyncEvent() {}
+#endif
+
 void Sdl2Application::anyEvent(SDL_Event&) {
     /* If this got called, the any event is not implemented by user and thus
        we don't need to call it ever again */
@@ -1182,7 +1492,7 @@ Sdl2Application::GLConfiguration::GLConfiguration():
     #else
     _flags{},
     #endif
-    _srgbCapable{false}
+    _srgbCapable{false}, _renderThread{false}
     #endif
     {}
 
@@ -45,6 +45,13 @@
 #include "Magnum/GL/GL.h"
 #endif
 
+#ifdef MAGNUM_TARGET_VK
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/Vk/Vulkan.h"
+#endif
+
 #ifdef CORRADE_TARGET_WINDOWS /* Windows version of SDL2 redefines main(), we don't want that */
 #define SDL_MAIN_HANDLED
 #endif
@@ -89,6 +96,9 @@ namespace Magnum { namespace Platform {
 
 namespace Implementation {
     enum class Sdl2DpiScalingPolicy: UnsignedByte;
+    #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+    class FramePacer;
+    #endif
 }
 
 /** @nosubgrouping
@@ -328,6 +338,36 @@ same OpenGL entrypoints. This change also allows @ref platforms-gl-es-angle "ANG
 to be used on Windows simply by placing the corresponding `libEGL.dll` and
 `libGLESv2.dll` files next to the application executable.
 
+@section Platform-Sdl2Application-render-thread Rendering on a dedicated thread
+
+By default, event processing, @ref drawEvent() and the buffer swap are all
+done on the main thread, which means a long @ref swapBuffers() delays event
+handling and vice versa. With
+@ref GLConfiguration::setRenderThreadEnabled() the GL context is moved to a
+dedicated render thread for the duration of @ref exec() and the work gets
+split as follows:
+
+-   SDL requires events to be polled on the thread that created the window, so
+    all input and window events, @ref tickEvent() and @ref exitEvent() are
+    still called on the main thread.
+-   @ref drawEvent() is called on the render thread, running concurrently
+    with event processing on the main thread. @ref viewportEvent() is called
+    on the render thread as well, right before the next @ref drawEvent(), so
+    it can update GL state.
+-   When a redraw is requested and the render thread finished the previous
+    frame, @ref renderThreadSyncEvent() is called on the main thread while
+    the render thread waits. That's the only place where it's safe to access
+    state shared by both threads without additional synchronization, so use it
+    to hand over the state needed for rendering the next frame.
+
+@snippet MagnumPlatform.cpp Sdl2Application-render-thread
+
+Only @ref redraw() and @ref swapBuffers() are meant to be called from the
+render thread, all other window and event APIs should be called only from
+the main thread. The GL context is moved back to the main thread once
+@ref exec() returns, so GL objects can be safely destroyed in the application
+destructor. Frame pacing isn't supported together with a render thread.
+
 @section Platform-Sdl2Application-dpi DPI awareness
 
 On displays that match the platform default DPI (96 or 72),
@@ -587,6 +627,44 @@ class Sdl2Application {
         SDL_GLContext glContext() { return _glContext; }
         #endif
 
+        #if defined(MAGNUM_TARGET_VK) && !defined(CORRADE_TARGET_EMSCRIPTEN) && (SDL_MAJOR_VERSION*1000 + SDL_MINOR_VERSION*100 + SDL_PATCHLEVEL >= 2006 || defined(DOXYGEN_GENERATING_OUTPUT))
+        /**
+         * @brief Vulkan instance extensions needed for a window surface
+         * @m_since_latest
+         *
+         * Expects that the window was created with
+         * @ref Configuration::WindowFlag::Vulkan. Pass the returned list to
+         * @ref Vk::InstanceCreateInfo::addEnabledExtensions() --- it contains
+         * @vk_extension{KHR,surface} and the platform-specific surface
+         * extension. The views are global, pointing to memory owned by SDL.
+         * On failure prints a message to @relativeref{Magnum,Error} and
+         * returns an empty array.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with SDL 2.0.6 and newer.
+         *      Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref createVulkanSurface()
+         */
+        Containers::Array<Containers::StringView> vulkanInstanceExtensions();
+
+        /**
+         * @brief Create a Vulkan surface for the window
+         * @m_since_latest
+         *
+         * Expects that the window was created with
+         * @ref Configuration::WindowFlag::Vulkan and that @p instance has
+         * the extensions returned from @ref vulkanInstanceExtensions()
+         * enabled. The surface is owned by the caller and has to be
+         * destroyed with @fn_vk{DestroySurfaceKHR} before the instance is
+         * destroyed. On failure prints a message to
+         * @relativeref{Magnum,Error} and returns @cpp VK_NULL_HANDLE @ce.
+         * Use the surface to create a @ref Vk::Swapchain.
+         * @note This function is available only if Magnum is compiled with
+         *      @ref MAGNUM_TARGET_VK enabled and with SDL 2.0.6 and newer.
+         *      Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        VkSurfaceKHR createVulkanSurface(VkInstance instance);
+        #endif
+
     protected:
         /* Nobody will need to have (and delete) Sdl2Application*, thus this is
            faster than public pure virtual destructor */
@@ -858,6 +936,85 @@ class Sdl2Application {
         }
         #endif
 
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        /**
+         * @brief Whether frame pacing is enabled
+         * @m_since_latest
+         *
+         * @see @ref setFramePacingEnabled()
+         */
+        bool isFramePacingEnabled() const;
+
+        /**
+         * @brief Enable or disable frame pacing
+         * @m_since_latest
+         *
+         * Frame pacing reduces the time between polling for input and the
+         * frame reflecting it appearing on the screen. When enabled, a fence
+         * is inserted before and after the buffer swap in
+         * @ref swapBuffers() and the application waits for both at the end
+         * of the main loop iteration, which measures how long it took from
+         * the input polling until the GPU finished rendering and prevents the
+         * CPU from queuing frames ahead of the GPU. In the next iteration,
+         * input polling is delayed so the frame is predicted to finish
+         * @ref framePacingMargin() before the next presentation.
+         *
+         * If VSync is enabled, the presentation period is calculated from
+         * the display refresh rate and @ref swapInterval(), otherwise
+         * @ref setMinimalLoopPeriod() is used and the minimal loop period
+         * delay is done only by the pacing. If neither is available, input
+         * polling isn't delayed, but the measurement and CPU throttling is
+         * still done. Use @ref framePacingLatency() to query the achieved
+         * latency.
+         *
+         * Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp false @ce if @gl_extension{ARB,sync} is not supported,
+         * @cpp true @ce otherwise. Disabled by default.
+         * @requires_gl32 Extension @gl_extension{ARB,sync}
+         * @requires_gles30 Not available on OpenGL ES 2.0.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten",
+         *      the browser is managing the frequency instead.
+         */
+        bool setFramePacingEnabled(bool enabled);
+
+        /**
+         * @brief Frame pacing margin
+         * @m_since_latest
+         *
+         * In nanoseconds.
+         * @see @ref setFramePacingMargin()
+         */
+        UnsignedLong framePacingMargin() const;
+
+        /**
+         * @brief Set frame pacing margin
+         * @m_since_latest
+         *
+         * Time in nanoseconds by which a frame is scheduled to finish before
+         * the next presentation, to accommodate for frame time variations
+         * and imprecise sleep. A smaller value means lower latency but a
+         * higher chance of missing a presentation. Default is
+         * @cpp 1000000 @ce, i.e. one millisecond. Can be called also when
+         * frame pacing is disabled, the value is used when it gets enabled.
+         * @see @ref setFramePacingEnabled()
+         */
+        void setFramePacingMargin(UnsignedLong nanoseconds);
+
+        /**
+         * @brief Frame pacing latency
+         * @m_since_latest
+         *
+         * Average time in nanoseconds from polling for input to the frame
+         * getting presented over the past few frames, measured by fences
+         * inserted around the buffer swap. Returns @cpp 0 @ce if frame pacing
+         * is disabled or no frame was drawn yet. Note that the presentation
+         * time is only approximate as drivers may finish the swap
+         * asynchronously and it doesn't include the display scanout.
+         * @see @ref setFramePacingEnabled()
+         */
+        UnsignedLong framePacingLatency() const;
+        #endif
+
         /**
          * @brief Redraw immediately
          *
@@ -1160,6 +1317,22 @@ class Sdl2Application {
          */
         virtual void tickEvent();
 
+        #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        /**
+         * @brief Render thread synchronization event
+         * @m_since_latest
+         *
+         * Called on the main thread before each @ref drawEvent() if the
+         * render thread is enabled, while the render thread is waiting. Use
+         * it to hand over state needed for rendering the next frame. Default
+         * implementation does nothing. See
+         * @ref Platform-Sdl2Application-render-thread for more information.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         * @see @ref GLConfiguration::setRenderThreadEnabled()
+         */
+        virtual void renderThreadSyncEvent();
+        #endif
+
     private:
         /**
          * @brief Any event
@@ -1183,6 +1356,18 @@ class Sdl2Application {
         typedef Containers::EnumSet<Flag> Flags;
         CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+        #if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        UnsignedLong framePacingPeriod() const;
+        #endif
+
+        #if defined(MAGNUM_TARGET_GL) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        struct RenderThread;
+
+        void startRenderThread();
+        void stopRenderThread();
+        void renderThreadLoop();
+        #endif
+
         #ifndef CORRADE_TARGET_EMSCRIPTEN
         SDL_Cursor* _cursors[14]{};
         #else
@@ -1209,6 +1394,13 @@ class Sdl2Application {
         SDL_GLContext _glContext{};
         #endif
         Containers::Pointer<Platform::GLContext> _context;
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
+        Containers::Pointer<Implementation::FramePacer> _framePacer;
+        UnsignedLong _framePacingMargin{1000000};
+        #endif
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        Containers::Pointer<RenderThread> _renderThread;
+        #endif
         #endif
 
         Flags _flags;
@@ -1439,6 +1631,30 @@ class Sdl2Application::GLConfiguration {
             _srgbCapable = enabled;
             return *this;
         }
+
+        /**
+         * @brief Whether the GL context lives on a dedicated render thread
+         * @m_since_latest
+         *
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        bool isRenderThreadEnabled() const { return _renderThread; }
+
+        /**
+         * @brief Make the GL context live on a dedicated render thread
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If enabled, @ref drawEvent() is called on a dedicated thread,
+         * overlapping with event processing on the main thread. See
+         * @ref Platform-Sdl2Application-render-thread for details. Default
+         * is @cpp false @ce.
+         * @note Not available in @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         */
+        GLConfiguration& setRenderThreadEnabled(bool enabled) {
+            _renderThread = enabled;
+            return *this;
+        }
         #endif
 
     private:
@@ -1449,6 +1665,7 @@ class Sdl2Application::GLConfiguration {
         GL::Version _version;
         Flags _flags;
         bool _srgbCapable;
+        bool _renderThread;
         #endif
 };
 
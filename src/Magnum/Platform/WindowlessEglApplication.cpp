@@ -86,6 +86,28 @@ bool extensionSupported(const char* const extensions, Containers::ArrayView<cons
 }
 #endif
 
+#ifndef MAGNUM_TARGET_WEBGL
+UnsignedInt WindowlessEglContext::deviceCount() {
+    /* Same extension requirements as in the constructor below. If they're
+       not present, there's just the default display. */
+    const char* const extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if(!extensions ||
+        !(extensionSupported(extensions, "EGL_EXT_device_enumeration") || extensionSupported(extensions, "EGL_EXT_device_base")) ||
+        !extensionSupported(extensions, "EGL_EXT_platform_base") ||
+        !extensionSupported(extensions, "EGL_EXT_platform_device"))
+        return 1;
+
+    EGLint count;
+    auto eglQueryDevices = reinterpret_cast<EGLBoolean(*)(EGLint, EGLDeviceEXT*, EGLint*)>(eglGetProcAddress("eglQueryDevicesEXT"));
+    if(!eglQueryDevices(0, nullptr, &count)) {
+        Error{} << "Platform::WindowlessEglContext::deviceCount(): cannot query EGL devices:" << Implementation::eglErrorString(eglGetError());
+        return 0;
+    }
+
+    return count;
+}
+#endif
+
 WindowlessEglContext::WindowlessEglContext(const Configuration& configuration, GLContext* const magnumContext) {
     #ifndef MAGNUM_TARGET_WEBGL
     /* The user provided a shared context, use the associated display
@@ -77,6 +77,23 @@ class WindowlessEglContext {
     public:
         class Configuration;
 
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Count of available EGL devices
+         * @m_since_latest
+         *
+         * Returns the count of devices that can be selected with
+         * @ref Configuration::setDevice(). If EGL device enumeration isn't
+         * supported, returns @cpp 1 @ce, corresponding to the default
+         * display. Prints a message to @relativeref{Magnum,Error} and returns
+         * @cpp 0 @ce if the devices can't be queried. See
+         * @ref Platform-WindowlessEglApplication-multiple-devices for an
+         * example use.
+         * @requires_gles Device selection is not available in WebGL.
+         */
+        static UnsignedInt deviceCount();
+        #endif
+
         /**
          * @brief Constructor
          * @param configuration Context configuration
@@ -531,6 +548,24 @@ __EGL_VENDOR_LIBRARY_FILENAMES=/usr/share/glvnd/egl_vendor.d/50_mesa.json ./my-a
 @endcode
 @endparblock
 
+@section Platform-WindowlessEglApplication-multiple-devices Rendering on multiple devices
+
+Each @ref WindowlessEglContext has its own `EGLDisplay` for the device selected
+with @ref Configuration::setDevice(), so it's possible to drive all GPUs in
+the system from a single process. Combined with @ref GLWorkerThreads, which
+makes each context current on a dedicated thread with its own
+@ref GLContext, the jobs get distributed to whichever device is free first:
+
+@snippet MagnumPlatform-windowless-thread.cpp WindowlessEglContext-multiple-devices
+
+Since contexts on different devices can't share any objects, each job has to
+upload the data it needs, or keep per-device resources indexed by the thread
+ID passed to @ref GLWorkerThreads::submitIndexed(). Note that
+`eglGetPlatformDisplayEXT()` returns the same `EGLDisplay` for the same
+device, so creating more than one non-shared context for a single device
+isn't supported --- use @ref Configuration::setSharedContext() for additional
+contexts on the same device instead.
+
 @section Platform-WindowlessEglApplication-shared-contexts Shared EGL contexts
 
 Unlike with @ref WindowlessGlxApplication and @ref WindowlessWglApplication,
@@ -182,4 +182,12 @@ Trade::MeshData grid3DWireframe(const Vector2i& subdivisions) {
         UnsignedInt(vertexCount.product())};
 }
 
+Trade::MeshData grid3DProcedural(const UnsignedInt cellCount) {
+    CORRADE_ASSERT(cellCount,
+        "Primitives::grid3DProcedural(): cell count must be non-zero",
+        (Trade::MeshData{MeshPrimitive::Triangles, 0}));
+
+    return Trade::MeshData{MeshPrimitive::Triangles, 6*cellCount*cellCount};
+}
+
 }}
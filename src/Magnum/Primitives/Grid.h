@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DWireframe()
+ * @brief Function @ref Magnum::Primitives::grid3DSolid(), @ref Magnum::Primitives::grid3DWireframe(), @ref Magnum::Primitives::grid3DProcedural()
  */
 
 #include <Corrade/Containers/EnumSet.h>
@@ -131,6 +131,47 @@ axis --- not just long lines crossing each other.
 */
 MAGNUM_PRIMITIVES_EXPORT Trade::MeshData grid3DWireframe(const Vector2i& subdivisions);
 
+/**
+@brief Procedural 3D grid
+@m_since_latest
+
+Attribute-less @ref MeshPrimitive::Triangles mesh with
+@cpp 6*cellCount*cellCount @ce vertices and no index buffer, meant to be drawn
+with a shader that reconstructs the vertex positions from
+@glsl gl_VertexID @ce, such as @ref Shaders::Terrain. Compared to
+@ref grid3DSolid() it costs nothing in vertex memory, which matters for large
+terrains.
+
+Vertex @f$ i @f$ belongs to a cell @f$ c = \lfloor i / 6 \rfloor @f$ at
+column @f$ c \bmod n @f$ and row @f$ \lfloor c / n \rfloor @f$, where
+@f$ n @f$ is @p cellCount. Each cell is made of two counterclockwise triangles
+with corners at the following offsets, in order, which is the same layout as
+in @ref grid3DSolid():
+
+@f[
+    \begin{pmatrix} 0 \\ 0 \end{pmatrix},
+    \begin{pmatrix} 1 \\ 1 \end{pmatrix},
+    \begin{pmatrix} 0 \\ 1 \end{pmatrix},
+    \begin{pmatrix} 0 \\ 0 \end{pmatrix},
+    \begin{pmatrix} 1 \\ 0 \end{pmatrix},
+    \begin{pmatrix} 1 \\ 1 \end{pmatrix}
+@f]
+
+Unlike the @p subdivisions parameter of @ref grid3DSolid(), @p cellCount is
+the count of cells in each direction, not the count of cuts. Drawing a
+smaller count of vertices from the same mesh gives a grid with fewer cells,
+which can be used to select a level of detail per draw without having
+multiple meshes --- see @ref Shaders::Terrain::vertexCount() for an example.
+Expects that @p cellCount is not zero.
+@requires_gl30 The @glsl gl_VertexID @ce builtin is not available in OpenGL
+    2.1.
+@requires_gles30 The @glsl gl_VertexID @ce builtin is not available in OpenGL
+    ES 2.0.
+@requires_webgl20 The @glsl gl_VertexID @ce builtin is not available in WebGL
+    1.0.
+*/
+MAGNUM_PRIMITIVES_EXPORT Trade::MeshData grid3DProcedural(UnsignedInt cellCount);
+
 }}
 
 #endif
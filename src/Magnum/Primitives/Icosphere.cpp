@@ -27,7 +27,6 @@
 
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
-#include "Magnum/MeshTools/RemoveDuplicates.h"
 #include "Magnum/MeshTools/Subdivide.h"
 #include "Magnum/Trade/ArrayAllocator.h"
 #include "Magnum/Trade/MeshData.h"
@@ -84,12 +83,23 @@ constexpr struct VertexSolidStrip {
 }
 
 Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
-    const std::size_t indexCount = Containers::arraySize(Indices)*(1 << subdivisions*2);
-    const std::size_t vertexCount = Containers::arraySize(Vertices) + ((indexCount - Containers::arraySize(Indices))/3);
-
-    Containers::Array<char> indexData{indexCount*sizeof(UnsignedInt)};
-    auto indices = Containers::arrayCast<UnsignedInt>(indexData);
+    /* Build up the subdivided positions. Edges shared by neighboring faces
+       get just one new vertex, so there's no need to remove duplicates
+       afterwards. */
+    Containers::Array<UnsignedInt> indices;
+    arrayResize(indices, Containers::NoInit, Containers::arraySize(Indices));
     std::memcpy(indices.begin(), Indices, sizeof(Indices));
+    Containers::Array<Vector3> subdividedPositions;
+    arrayResize(subdividedPositions, Containers::NoInit, Containers::arraySize(Vertices));
+    for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i)
+        subdividedPositions[i] = Vertices[i].position;
+    MeshTools::subdivideSharedEdges(indices, subdividedPositions, subdivisions, [](const Vector3& a, const Vector3& b) {
+        return (a+b).normalized();
+    });
+
+    Containers::Array<char> indexData{indices.size()*sizeof(UnsignedInt)};
+    std::memcpy(indexData.begin(), indices.begin(), indexData.size());
+    const Trade::MeshIndexData indexView{Containers::arrayCast<const UnsignedInt>(indexData)};
 
     struct Vertex {
         Vector3 position;
@@ -97,39 +107,17 @@ Trade::MeshData icosphereSolid(const UnsignedInt subdivisions) {
     };
     Containers::Array<char> vertexData;
     Containers::arrayResize<Trade::ArrayAllocator>(vertexData,
-        Containers::NoInit, sizeof(Vertex)*vertexCount);
-
-    /* Build up the subdivided positions */
-    {
-        auto vertices = Containers::arrayCast<Vertex>(vertexData);
-        Containers::StridedArrayView1D<Vector3> positions{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
-        for(std::size_t i = 0; i != Containers::arraySize(Vertices); ++i)
-            positions[i] = Vertices[i].position;
-
-        for(std::size_t i = 0; i != subdivisions; ++i) {
-            const std::size_t iterationIndexCount = Containers::arraySize(Indices)*(1 << (i + 1)*2);
-            const std::size_t iterationVertexCount = Containers::arraySize(Vertices) + ((iterationIndexCount - Containers::arraySize(Indices))/3);
-            MeshTools::subdivideInPlace(indices.prefix(iterationIndexCount), positions.prefix(iterationVertexCount), [](const Vector3& a, const Vector3& b) {
-                return (a+b).normalized();
-            });
-        }
-
-        /** @todo i need arrayShrinkAndGiveUpMemoryIfItDoesntCauseRealloc() */
-        Containers::arrayResize<Trade::ArrayAllocator>(vertexData,
-            MeshTools::removeDuplicatesIndexedInPlace(
-                Containers::stridedArrayView(indices),
-                Containers::arrayCast<2, char>(positions))*sizeof(Vertex));
-    }
-
-    /* Build up the views again with correct size, fill the normals */
+        Containers::NoInit, sizeof(Vertex)*subdividedPositions.size());
+
+    /* Fill the interleaved positions and normals */
     auto vertices = Containers::arrayCast<Vertex>(vertexData);
     Containers::StridedArrayView1D<Vector3> positions{vertices, &vertices[0].position, vertices.size(), sizeof(Vertex)};
     Containers::StridedArrayView1D<Vector3> normals{vertices, &vertices[0].normal, vertices.size(), sizeof(Vertex)};
     for(std::size_t i = 0; i != positions.size(); ++i)
-        normals[i] = positions[i];
+        positions[i] = normals[i] = subdividedPositions[i];
 
     return Trade::MeshData{MeshPrimitive::Triangles, std::move(indexData),
-        Trade::MeshIndexData{indices}, std::move(vertexData),
+        indexView, std::move(vertexData),
         {Trade::MeshAttributeData{Trade::MeshAttribute::Position, positions},
          Trade::MeshAttributeData{Trade::MeshAttribute::Normal, normals}}};
 }
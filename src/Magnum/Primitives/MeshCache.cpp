@@ -0,0 +1,86 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCache.h"
+
+#include <unordered_map>
+
+#include "Magnum/Trade/MeshData.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/MeshTools/Compile.h"
+#endif
+
+namespace Magnum { namespace Primitives {
+
+namespace {
+
+struct Entry {
+    explicit Entry(Trade::MeshData&& data): data{std::move(data)} {}
+
+    Trade::MeshData data;
+    #ifdef MAGNUM_TARGET_GL
+    Containers::Pointer<GL::Mesh> mesh;
+    #endif
+};
+
+}
+
+struct MeshCache::State {
+    /* Pointers so the references stay valid on rehash */
+    std::unordered_map<std::string, Containers::Pointer<Entry>> entries;
+};
+
+MeshCache::MeshCache(): _state{Containers::InPlaceInit} {}
+
+MeshCache::MeshCache(MeshCache&&) noexcept = default;
+
+MeshCache::~MeshCache() = default;
+
+MeshCache& MeshCache::operator=(MeshCache&&) noexcept = default;
+
+std::size_t MeshCache::count() const { return _state->entries.size(); }
+
+const Trade::MeshData* MeshCache::find(const std::string& key) const {
+    const auto found = _state->entries.find(key);
+    return found == _state->entries.end() ? nullptr : &found->second->data;
+}
+
+const Trade::MeshData& MeshCache::add(std::string key, Trade::MeshData&& data) {
+    return _state->entries.emplace(std::move(key), Containers::pointer<Entry>(std::move(data))).first->second->data;
+}
+
+#ifdef MAGNUM_TARGET_GL
+GL::Mesh& MeshCache::compiled(const std::string& key) {
+    Entry& entry = *_state->entries.at(key);
+    if(!entry.mesh) entry.mesh = Containers::pointer<GL::Mesh>(MeshTools::compile(entry.data));
+    return *entry.mesh;
+}
+#endif
+
+void MeshCache::clear() { _state->entries.clear(); }
+
+}}
@@ -0,0 +1,158 @@
+#ifndef Magnum_Primitives_MeshCache_h
+#define Magnum_Primitives_MeshCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Primitives::MeshCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <type_traits>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Primitives/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/GL/GL.h"
+#endif
+
+namespace Magnum { namespace Primitives {
+
+namespace Implementation {
+    inline void meshCacheKey(std::string&) {}
+    template<class T, class ...Next> void meshCacheKey(std::string& key, const T& first, const Next&... next) {
+        key.append(reinterpret_cast<const char*>(&first), sizeof(T));
+        meshCacheKey(key, next...);
+    }
+}
+
+/**
+@brief Primitive mesh cache
+@m_since_latest
+
+Generates each primitive just once for a particular set of parameters and then
+returns the same shared instance on subsequent calls. Useful for example for
+debug renderers or tools that draw a lot of the same primitives, which would
+otherwise generate and upload the same data over and over again. The cache is
+keyed by the generator function together with all its parameters, which means
+all parameters have to be specified explicitly, including the defaulted ones:
+
+@snippet MagnumPrimitives.cpp MeshCache
+
+If the generator function is overloaded, such as @ref uvSphereSolid() in
+builds with @ref MAGNUM_BUILD_DEPRECATED enabled, you need to cast it to the
+desired signature first. The parameters are compared bitwise, so for example
+@cpp 0.0f @ce and @cpp -0.0f @ce are treated as different values.
+
+If Magnum is built with OpenGL support, @ref mesh() additionally returns a
+shared @ref GL::Mesh compiled with @ref MeshTools::compile(), so all users of
+the same primitive render from the same GPU buffers.
+
+The returned references stay valid until @ref clear() is called or the cache
+is destroyed.
+*/
+class MAGNUM_PRIMITIVES_EXPORT MeshCache {
+    public:
+        /** @brief Constructor */
+        explicit MeshCache();
+
+        /** @brief Copying is not allowed */
+        MeshCache(const MeshCache&) = delete;
+
+        /** @brief Move constructor */
+        MeshCache(MeshCache&&) noexcept;
+
+        /** @brief Destructor */
+        ~MeshCache();
+
+        /** @brief Copying is not allowed */
+        MeshCache& operator=(const MeshCache&) = delete;
+
+        /** @brief Move assignment */
+        MeshCache& operator=(MeshCache&&) noexcept;
+
+        /** @brief Count of cached primitives */
+        std::size_t count() const;
+
+        /**
+         * @brief Cached primitive data
+         * @param generator     Primitive generator function
+         * @param args          Parameters passed to @p generator
+         *
+         * If @p generator wasn't called with the same @p args before, calls
+         * it and stores the result. Returns a reference to the stored data.
+         */
+        template<class ...Args> const Trade::MeshData& meshData(Trade::MeshData(*generator)(Args...), typename std::common_type<Args>::type... args) {
+            std::string key{reinterpret_cast<const char*>(&generator), sizeof(generator)};
+            Implementation::meshCacheKey(key, args...);
+            if(const Trade::MeshData* const found = find(key)) return *found;
+            return add(std::move(key), generator(args...));
+        }
+
+        #if defined(MAGNUM_TARGET_GL) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Cached compiled primitive mesh
+         * @param generator     Primitive generator function
+         * @param args          Parameters passed to @p generator
+         *
+         * Calls @ref meshData() and, if not done already, compiles the result
+         * using @ref MeshTools::compile(). Returns a reference to the compiled
+         * mesh. Expects that a GL context is active. Available only if Magnum
+         * is compiled with @ref MAGNUM_TARGET_GL enabled (done by default).
+         * @requires_gl
+         */
+        template<class ...Args> GL::Mesh& mesh(Trade::MeshData(*generator)(Args...), typename std::common_type<Args>::type... args) {
+            std::string key{reinterpret_cast<const char*>(&generator), sizeof(generator)};
+            Implementation::meshCacheKey(key, args...);
+            if(!find(key)) add(key, generator(args...));
+            return compiled(key);
+        }
+        #endif
+
+        /**
+         * @brief Clear the cache
+         *
+         * Invalidates all references returned from @ref meshData() and
+         * @ref mesh().
+         */
+        void clear();
+
+    private:
+        const Trade::MeshData* find(const std::string& key) const;
+        const Trade::MeshData& add(std::string key, Trade::MeshData&& data);
+        #ifdef MAGNUM_TARGET_GL
+        GL::Mesh& compiled(const std::string& key);
+        #endif
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
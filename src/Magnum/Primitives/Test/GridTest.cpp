@@ -37,6 +37,7 @@ struct GridTest: TestSuite::Tester {
 
     void solid3D();
     void wireframe3D();
+    void procedural3D();
 };
 
 constexpr struct {
@@ -55,7 +56,8 @@ GridTest::GridTest() {
     addInstancedTests({&GridTest::solid3D},
         Containers::arraySize(Solid3DData));
 
-    addTests({&GridTest::wireframe3D});
+    addTests({&GridTest::wireframe3D,
+              &GridTest::procedural3D});
 }
 
 void GridTest::solid3D() {
@@ -376,6 +378,16 @@ void GridTest::wireframe3D() {
     }), TestSuite::Compare::Container);
 }
 
+void GridTest::procedural3D() {
+    Trade::MeshData grid = grid3DProcedural(5);
+
+    CORRADE_COMPARE(grid.primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(!grid.isIndexed());
+    CORRADE_COMPARE(grid.attributeCount(), 0);
+    CORRADE_COMPARE(grid.vertexCount(), 150);
+    CORRADE_VERIFY(grid.vertexData().empty());
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Primitives::Test::GridTest)
@@ -0,0 +1,142 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Primitives/Cylinder.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Primitives/Icosphere.h"
+#include "Magnum/Primitives/MeshCache.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Primitives { namespace Test { namespace {
+
+struct MeshCacheTest: TestSuite::Tester {
+    explicit MeshCacheTest();
+
+    void construct();
+    void constructMove();
+
+    void meshData();
+    void meshDataDifferentParameters();
+    void meshDataDifferentGenerators();
+    void clear();
+};
+
+MeshCacheTest::MeshCacheTest() {
+    addTests({&MeshCacheTest::construct,
+              &MeshCacheTest::constructMove,
+
+              &MeshCacheTest::meshData,
+              &MeshCacheTest::meshDataDifferentParameters,
+              &MeshCacheTest::meshDataDifferentGenerators,
+              &MeshCacheTest::clear});
+}
+
+void MeshCacheTest::construct() {
+    MeshCache cache;
+    CORRADE_COMPARE(cache.count(), 0);
+}
+
+void MeshCacheTest::constructMove() {
+    MeshCache a;
+    const Trade::MeshData& data = a.meshData(icosphereSolid, 1);
+
+    MeshCache b{std::move(a)};
+    CORRADE_COMPARE(b.count(), 1);
+    CORRADE_COMPARE(&b.meshData(icosphereSolid, 1), &data);
+
+    MeshCache c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.count(), 1);
+    CORRADE_COMPARE(&c.meshData(icosphereSolid, 1), &data);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MeshCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MeshCache>::value);
+}
+
+void MeshCacheTest::meshData() {
+    MeshCache cache;
+
+    const Trade::MeshData& a = cache.meshData(icosphereSolid, 2);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(a.vertexCount(), icosphereSolid(2).vertexCount());
+    CORRADE_COMPARE(a.indexCount(), icosphereSolid(2).indexCount());
+
+    /* Second call returns the same instance */
+    const Trade::MeshData& b = cache.meshData(icosphereSolid, 2);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(&b, &a);
+}
+
+void MeshCacheTest::meshDataDifferentParameters() {
+    MeshCache cache;
+
+    const Trade::MeshData& a = cache.meshData(cylinderSolid, 1, 8, 1.0f, CylinderFlags{});
+    const Trade::MeshData& b = cache.meshData(cylinderSolid, 1, 16, 1.0f, CylinderFlags{});
+    const Trade::MeshData& c = cache.meshData(cylinderSolid, 1, 8, 1.0f, CylinderFlag::CapEnds);
+    const Trade::MeshData& d = cache.meshData(grid3DSolid, Vector2i{2, 3}, GridFlags{});
+    const Trade::MeshData& e = cache.meshData(grid3DSolid, Vector2i{3, 2}, GridFlags{});
+    CORRADE_COMPARE(cache.count(), 5);
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_VERIFY(&a != &c);
+    CORRADE_VERIFY(&d != &e);
+    CORRADE_COMPARE(b.vertexCount(), cylinderSolid(1, 16, 1.0f).vertexCount());
+    CORRADE_COMPARE(c.vertexCount(), cylinderSolid(1, 8, 1.0f, CylinderFlag::CapEnds).vertexCount());
+
+    /* Same parameters again return the existing instances */
+    CORRADE_COMPARE(&cache.meshData(cylinderSolid, 1, 8, 1.0f, CylinderFlag::CapEnds), &c);
+    CORRADE_COMPARE(&cache.meshData(grid3DSolid, Vector2i{2, 3}, GridFlags{}), &d);
+    CORRADE_COMPARE(cache.count(), 5);
+}
+
+void MeshCacheTest::meshDataDifferentGenerators() {
+    MeshCache cache;
+
+    const Trade::MeshData& a = cache.meshData(icosphereSolid, 0);
+    const Trade::MeshData& b = cache.meshData(icosphereWireframe);
+    CORRADE_COMPARE(cache.count(), 2);
+    CORRADE_VERIFY(&a != &b);
+    CORRADE_COMPARE(a.primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(b.primitive(), MeshPrimitive::Lines);
+}
+
+void MeshCacheTest::clear() {
+    MeshCache cache;
+    cache.meshData(icosphereSolid, 0);
+    cache.meshData(icosphereSolid, 1);
+    CORRADE_COMPARE(cache.count(), 2);
+
+    cache.clear();
+    CORRADE_COMPARE(cache.count(), 0);
+
+    cache.meshData(icosphereSolid, 0);
+    CORRADE_COMPARE(cache.count(), 1);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Primitives::Test::MeshCacheTest)
@@ -132,11 +132,11 @@ class Resource {
          * Creates empty resource. Resources are acquired from the manager by
          * calling @ref ResourceManager::get().
          */
-        explicit Resource(): _manager{nullptr}, _lastCheck{0}, _state{ResourceState::Final}, _data{nullptr} {}
+        explicit Resource(): _manager{nullptr}, _slot{nullptr}, _generation{0}, _state{ResourceState::Final}, _data{nullptr} {}
 
         /** @brief Copy constructor */
-        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _lastCheck{other._lastCheck}, _state{other._state}, _data{other._data} {
-            if(_manager) _manager->incrementReferenceCount(_key);
+        Resource(const Resource<T, U>& other): _manager{other._manager}, _key{other._key}, _slot{other._slot}, _generation{other._generation}, _state{other._state}, _data{other._data} {
+            if(_manager) _manager->incrementReferenceCount(*_slot);
         }
 
         /** @brief Move constructor */
@@ -144,7 +144,7 @@ class Resource {
 
         /** @brief Destructor */
         ~Resource() {
-            if(_manager) _manager->decrementReferenceCount(_key);
+            if(_manager) _manager->decrementReferenceCount(*_slot);
         }
 
         /** @brief Copy assignment */
@@ -236,36 +236,43 @@ class Resource {
         friend Implementation::ResourceManagerData<T>;
         #endif
 
-        Resource(Implementation::ResourceManagerData<T>* manager, ResourceKey key): _manager{manager}, _key{key}, _lastCheck{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
-            manager->incrementReferenceCount(key);
+        Resource(Implementation::ResourceManagerData<T>* manager, typename Implementation::ResourceManagerData<T>::Data& slot): _manager{manager}, _key{slot.key}, _slot{&slot}, _generation{0}, _state{ResourceState::NotLoaded}, _data{nullptr} {
+            manager->incrementReferenceCount(slot);
         }
 
         void acquire();
 
         Implementation::ResourceManagerData<T>* _manager;
         ResourceKey _key;
-        std::size_t _lastCheck;
+        /* Manager storage for this resource, stays at the same address for as
+           long as it's referenced */
+        typename Implementation::ResourceManagerData<T>::Data* _slot;
+        /* Data::generation at the time of last acquire() */
+        std::size_t _generation;
         ResourceState _state;
         T* _data;
 };
 
 template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(const Resource<T, U>& other) {
-    if(_manager) _manager->decrementReferenceCount(_key);
+    /* Increment first so self-assignment doesn't free a reference-counted
+       resource */
+    if(other._manager) other._manager->incrementReferenceCount(*other._slot);
+    if(_manager) _manager->decrementReferenceCount(*_slot);
 
     _manager = other._manager;
     _key = other._key;
-    _lastCheck = other._lastCheck;
+    _slot = other._slot;
+    _generation = other._generation;
     _state = other._state;
     _data = other._data;
-
-    if(_manager) _manager->incrementReferenceCount(_key);
     return *this;
 }
 
-template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _lastCheck(other._lastCheck), _state(other._state), _data(other._data) {
+template<class T, class U> Resource<T, U>::Resource(Resource<T, U>&& other) noexcept: _manager(other._manager), _key(other._key), _slot(other._slot), _generation(other._generation), _state(other._state), _data(other._data) {
     other._manager = nullptr;
     other._key = {};
-    other._lastCheck = 0;
+    other._slot = nullptr;
+    other._generation = 0;
     other._state = ResourceState::Final;
     other._data = nullptr;
 }
@@ -274,7 +281,8 @@ template<class T, class U> Resource<T, U>& Resource<T, U>::operator=(Resource<T,
     using std::swap;
     swap(_manager, other._manager);
     swap(_key, other._key);
-    swap(_lastCheck, other._lastCheck);
+    swap(_slot, other._slot);
+    swap(_generation, other._generation);
     swap(_state, other._state);
     swap(_data, other._data);
     return *this;
@@ -285,15 +293,14 @@ template<class T, class U> void Resource<T, U>::acquire() {
     if(_state == ResourceState::Final) return;
 
     /* Nothing changed since last check */
-    if(_manager->lastChange() <= _lastCheck) return;
+    if(_slot->generation == _generation) return;
 
-    /* Acquire new data and save last check time */
-    const typename Implementation::ResourceManagerData<T>::Data& d = _manager->data(_key);
-    _lastCheck = _manager->lastChange();
+    /* Acquire new data and save the generation */
+    _generation = _slot->generation;
 
     /* Try to get the data */
-    _data = d.data;
-    _state = static_cast<ResourceState>(d.state);
+    _data = _slot->data;
+    _state = static_cast<ResourceState>(_slot->state);
 
     /* Data are not available */
     if(!_data) {
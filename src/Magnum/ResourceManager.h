@@ -29,7 +29,9 @@
  * @brief Class @ref Magnum::ResourceManager, @ref Magnum::ResourceDataState, @ref Magnum::ResourcePolicy
  */
 
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Resource.h"
@@ -73,15 +75,20 @@ enum class ResourceDataState: UnsignedByte {
 /**
 @brief Resource policy
 
-@see @ref ResourceManager::set(), @ref ResourceManager::free()
+@see @ref ResourceManager::set(), @ref ResourceManager::free(),
+    @ref ResourceManager::evict()
  */
 enum class ResourcePolicy: UnsignedByte {
-    /** The resource will stay resident for whole lifetime of resource manager. */
+    /**
+     * The resource will stay resident for whole lifetime of resource manager.
+     * It's never evicted, even if the byte budget is exceeded.
+     */
     Resident,
 
     /**
      * The resource will be unloaded when manually calling
-     * @ref ResourceManager::free() if nothing references it.
+     * @ref ResourceManager::free() if nothing references it, or when it gets
+     * evicted after exceeding the byte budget.
      */
     Manual,
 
@@ -108,9 +115,7 @@ template<class T> class ResourceManagerData {
         ResourceManagerData<T>& operator=(const ResourceManagerData<T>&) = delete;
         ResourceManagerData<T>& operator=(ResourceManagerData<T>&&) = delete;
 
-        std::size_t lastChange() const { return _lastChange; }
-
-        std::size_t count() const { return _data.size(); }
+        std::size_t count() const { return _count; }
 
         std::size_t referenceCount(ResourceKey key) const;
 
@@ -120,6 +125,18 @@ template<class T> class ResourceManagerData {
 
         void set(ResourceKey key, T* data, ResourceDataState state, ResourcePolicy policy);
 
+        std::size_t byteSize() const { return _byteSize; }
+
+        std::size_t byteSize(ResourceKey key) const;
+
+        void setByteSize(ResourceKey key, std::size_t size);
+
+        std::size_t byteBudget() const { return _byteBudget; }
+
+        void setByteBudget(std::size_t budget);
+
+        void evict(std::size_t budget);
+
         T* fallback() { return _fallback; }
         const T* fallback() const { return _fallback; }
 
@@ -127,7 +144,7 @@ template<class T> class ResourceManagerData {
 
         void free();
 
-        void clear() { _data.clear(); }
+        void clear();
 
         AbstractResourceLoader<T>* loader() { return _loader; }
         const AbstractResourceLoader<T>* loader() const { return _loader; }
@@ -137,23 +154,38 @@ template<class T> class ResourceManagerData {
         void setLoader(AbstractResourceLoader<T>* loader);
 
     protected:
-        ResourceManagerData(): _fallback(nullptr), _loader(nullptr), _lastChange(0) {}
+        ResourceManagerData(): _count(0), _fallback(nullptr), _loader(nullptr), _lastUse(0), _byteSize(0), _byteBudget(~std::size_t{}) {}
 
     private:
         struct Data;
 
-        const Data& data(ResourceKey key) { return _data[key]; }
+        /* Returns nullptr if the resource isn't there */
+        Data* find(ResourceKey key) const;
+
+        /* Inserts an empty resource if it isn't there yet. The returned
+           pointer stays valid until the resource is erased. */
+        Data& findOrInsert(ResourceKey key);
+
+        void erase(Data& data);
 
-        void incrementReferenceCount(ResourceKey key) {
-            ++_data[key].referenceCount;
+        void incrementReferenceCount(Data& data) {
+            ++data.referenceCount;
+            data.lastUse = ++_lastUse;
         }
 
-        void decrementReferenceCount(ResourceKey key);
+        void decrementReferenceCount(Data& data);
 
-        std::unordered_map<ResourceKey, Data> _data;
+        /* Open-addressed hash table with linear probing, ResourceKey is
+           already a hash so its bits are used directly. The resources are
+           allocated separately so their addresses don't change on rehash and
+           Resource instances can keep a pointer to them. */
+        Containers::Array<Data*> _slots;
+        std::size_t _count;
         T* _fallback;
         AbstractResourceLoader<T>* _loader;
-        std::size_t _lastChange;
+        /* Monotonic counter for ordering resources by their last use */
+        std::size_t _lastUse;
+        std::size_t _byteSize, _byteBudget;
 };
 
 /* Helper class for defining which real types are in the type pack */
@@ -191,6 +223,19 @@ Resource state and policy is configured when setting the resource data in
 @ref set() and can be changed each time the data are updated, although already
 final resources cannot obviously be set as mutable again.
 
+@section ResourceManager-eviction Memory budget and eviction
+
+The manager doesn't know how much memory the resources occupy. Their sizes can
+be reported via @ref setByteSize() and the total is then available through
+@ref byteSize(). After setting a per-type budget with @ref setByteBudget(),
+each time the total size exceeds the budget, least recently used resources
+that aren't referenced and aren't @ref ResourcePolicy::Resident are evicted
+until the total fits again. The eviction can be also triggered explicitly with
+@ref evict(). Evicted resources behave as if they were never set, so if a
+loader is set, they get loaded again the next time they're requested.
+
+@snippet Magnum.cpp ResourceManager-eviction
+
 Basic usage is:
 
 <ul>
@@ -326,6 +371,102 @@ template<class... Types> class ResourceManager: private Implementation::Resource
             return set(key, new typename std::decay<U>::type(std::forward<U>(data)));
         }
 
+        /**
+         * @brief Byte size of all resources of given type
+         * @m_since_latest
+         *
+         * Sum of sizes set via @ref setByteSize().
+         * @see @ref byteBudget()
+         */
+        template<class T> std::size_t byteSize() const {
+            return this->Implementation::ResourceManagerData<T>::byteSize();
+        }
+
+        /**
+         * @brief Byte size of given resource
+         * @m_since_latest
+         *
+         * If the resource doesn't exist or its size wasn't set via
+         * @ref setByteSize(), returns @cpp 0 @ce.
+         */
+        template<class T> std::size_t byteSize(ResourceKey key) const {
+            return this->Implementation::ResourceManagerData<T>::byteSize(key);
+        }
+
+        /**
+         * @brief Set byte size of given resource
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Used for tracking memory usage against the budget set via
+         * @ref setByteBudget(), the manager doesn't use the value for
+         * anything else. Expects that the resource exists. The size is reset
+         * back to @cpp 0 @ce each time the resource data are updated via
+         * @ref set(). If the total size exceeds the budget, calls
+         * @ref evict().
+         */
+        template<class T> ResourceManager<Types...>& setByteSize(ResourceKey key, std::size_t size) {
+            this->Implementation::ResourceManagerData<T>::setByteSize(key, size);
+            return *this;
+        }
+
+        /**
+         * @brief Byte budget for given type
+         * @m_since_latest
+         *
+         * Unlimited by default.
+         */
+        template<class T> std::size_t byteBudget() const {
+            return this->Implementation::ResourceManagerData<T>::byteBudget();
+        }
+
+        /**
+         * @brief Set byte budget for given type
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Each time the total @ref byteSize() of resources of given type
+         * exceeds @p budget after a call to @ref setByteSize(), or right
+         * away in this function, @ref evict() is called with @p budget.
+         * Note that the resources can't be evicted if they're referenced or
+         * resident, so the total size can stay over the budget.
+         */
+        template<class T> ResourceManager<Types...>& setByteBudget(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::setByteBudget(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Evict least recently used resources of given type
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Frees resources that aren't referenced, aren't
+         * @ref ResourcePolicy::Resident, aren't currently loading and have a
+         * non-zero @ref byteSize(ResourceKey) const, starting from the least
+         * recently used ones, until the total @ref byteSize() is not larger
+         * than @p budget. A resource is used when it's acquired via @ref get()
+         * or when a @ref Resource referencing it is destroyed. If a loader is
+         * set, the evicted resources get loaded again on the next @ref get().
+         * Unlike @ref free(), resources with zero size are never evicted.
+         */
+        template<class T> ResourceManager<Types...>& evict(std::size_t budget) {
+            this->Implementation::ResourceManagerData<T>::evict(budget);
+            return *this;
+        }
+
+        /**
+         * @brief Evict least recently used resources of given type to fit the budget
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref evict(std::size_t) with
+         * @ref byteBudget().
+         */
+        template<class T> ResourceManager<Types...>& evict() {
+            return evict<T>(byteBudget<T>());
+        }
+
         /** @brief Fallback for not found resources */
         template<class T> T* fallback() {
             return this->Implementation::ResourceManagerData<T>::fallback();
@@ -460,68 +601,164 @@ template<class T> void safeDelete(T* data) {
 
 template<class T> ResourceManagerData<T>::~ResourceManagerData() {
     /* Loaders are already deleted via freeLoaders() from ResourceManager */
+    for(Data* data: _slots) delete data;
     safeDelete(_fallback);
 }
 
+template<class T> typename ResourceManagerData<T>::Data* ResourceManagerData<T>::find(const ResourceKey key) const {
+    if(_slots.isEmpty()) return nullptr;
+
+    const std::size_t mask = _slots.size() - 1;
+    for(std::size_t i = std::hash<ResourceKey>{}(key) & mask; ; i = (i + 1) & mask) {
+        Data* const data = _slots[i];
+        if(!data || data->key == key) return data;
+    }
+}
+
+template<class T> typename ResourceManagerData<T>::Data& ResourceManagerData<T>::findOrInsert(const ResourceKey key) {
+    if(Data* const found = find(key)) return *found;
+
+    /* Keep the load factor at most 1/2 to have the probe sequences short */
+    if(2*(_count + 1) > _slots.size()) {
+        Containers::Array<Data*> slots{Containers::ValueInit, _slots.isEmpty() ? 16 : _slots.size()*2};
+        const std::size_t mask = slots.size() - 1;
+        for(Data* const data: _slots) {
+            if(!data) continue;
+            std::size_t i = std::hash<ResourceKey>{}(data->key) & mask;
+            while(slots[i]) i = (i + 1) & mask;
+            slots[i] = data;
+        }
+        _slots = std::move(slots);
+    }
+
+    const std::size_t mask = _slots.size() - 1;
+    std::size_t i = std::hash<ResourceKey>{}(key) & mask;
+    while(_slots[i]) i = (i + 1) & mask;
+    _slots[i] = new Data{key};
+    ++_count;
+    return *_slots[i];
+}
+
+template<class T> void ResourceManagerData<T>::erase(Data& data) {
+    const std::size_t mask = _slots.size() - 1;
+    std::size_t hole = std::hash<ResourceKey>{}(data.key) & mask;
+    while(_slots[hole] != &data) hole = (hole + 1) & mask;
+
+    /* Shift the following entries back into the hole unless it would move
+       them before their home slot, so no tombstones are needed */
+    for(std::size_t i = (hole + 1) & mask; _slots[i]; i = (i + 1) & mask) {
+        const std::size_t home = std::hash<ResourceKey>{}(_slots[i]->key) & mask;
+        if(hole <= i ? (hole < home && home <= i) : (hole < home || home <= i))
+            continue;
+        _slots[hole] = _slots[i];
+        hole = i;
+    }
+    _slots[hole] = nullptr;
+
+    --_count;
+    _byteSize -= data.byteSize;
+    delete &data;
+}
+
 template<class T> std::size_t ResourceManagerData<T>::referenceCount(const ResourceKey key) const {
-    auto it = _data.find(key);
-    if(it == _data.end()) return 0;
-    return it->second.referenceCount;
+    const Data* const data = find(key);
+    return data ? data->referenceCount : 0;
 }
 
 template<class T> ResourceState ResourceManagerData<T>::state(const ResourceKey key) const {
-    const auto it = _data.find(key);
+    const Data* const data = find(key);
 
     /* Resource not loaded */
-    if(it == _data.end() || !it->second.data) {
+    if(!data || !data->data) {
         /* Fallback found, add *Fallback to state */
         if(_fallback) {
-            if(it != _data.end() && it->second.state == ResourceDataState::Loading)
+            if(data && data->state == ResourceDataState::Loading)
                 return ResourceState::LoadingFallback;
-            else if(it != _data.end() && it->second.state == ResourceDataState::NotFound)
+            else if(data && data->state == ResourceDataState::NotFound)
                 return ResourceState::NotFoundFallback;
             else return ResourceState::NotLoadedFallback;
         }
 
         /* Fallback not found, loading didn't start yet */
-        if(it == _data.end() || (it->second.state != ResourceDataState::Loading && it->second.state != ResourceDataState::NotFound))
+        if(!data || (data->state != ResourceDataState::Loading && data->state != ResourceDataState::NotFound))
             return ResourceState::NotLoaded;
     }
 
     /* Loading / NotFound without fallback, Mutable / Final */
-    return static_cast<ResourceState>(it->second.state);
+    return static_cast<ResourceState>(data->state);
 }
 
 template<class T> template<class U> Resource<T, U> ResourceManagerData<T>::get(ResourceKey key) {
     /* Ask loader for the data, if they aren't there yet */
-    if(_loader && _data.find(key) == _data.end())
+    if(_loader && !find(key))
         _loader->load(key);
 
-    return Resource<T, U>(this, key);
+    return Resource<T, U>(this, findOrInsert(key));
 }
 
 template<class T> void ResourceManagerData<T>::set(const ResourceKey key, T* const data, const ResourceDataState state, const ResourcePolicy policy) {
-    auto it = _data.find(key);
+    Data* const found = find(key);
 
     /* NotFound / Loading state shouldn't have any data */
     CORRADE_ASSERT((data == nullptr) == (state == ResourceDataState::NotFound || state == ResourceDataState::Loading),
         "ResourceManager::set(): data should be null if and only if state is NotFound or Loading", );
 
     /* Cannot change resource with already final state */
-    CORRADE_ASSERT(it == _data.end() || it->second.state != ResourceDataState::Final,
+    CORRADE_ASSERT(!found || found->state != ResourceDataState::Final,
         "ResourceManager::set(): cannot change already final resource" << key, );
 
-    /* Insert the resource, if not already there */
-    if(it == _data.end())
-        it = _data.emplace(key, Data()).first;
+    /* Insert the resource, if not already there, otherwise delete previous
+       data */
+    Data& d = found ? *found : findOrInsert(key);
+    if(found) safeDelete(d.data);
+
+    d.data = data;
+    d.state = state;
+    d.policy = policy;
+    _byteSize -= d.byteSize;
+    d.byteSize = 0;
+    d.lastUse = ++_lastUse;
+    ++d.generation;
+}
 
-    /* Otherwise delete previous data */
-    else safeDelete(it->second.data);
+template<class T> std::size_t ResourceManagerData<T>::byteSize(const ResourceKey key) const {
+    const Data* const data = find(key);
+    return data ? data->byteSize : 0;
+}
 
-    it->second.data = data;
-    it->second.state = state;
-    it->second.policy = policy;
-    ++_lastChange;
+template<class T> void ResourceManagerData<T>::setByteSize(const ResourceKey key, const std::size_t size) {
+    Data* const data = find(key);
+    CORRADE_ASSERT(data,
+        "ResourceManager::setByteSize(): resource" << key << "doesn't exist", );
+
+    _byteSize = _byteSize - data->byteSize + size;
+    data->byteSize = size;
+
+    if(_byteSize > _byteBudget) evict(_byteBudget);
+}
+
+template<class T> void ResourceManagerData<T>::setByteBudget(const std::size_t budget) {
+    _byteBudget = budget;
+    if(_byteSize > _byteBudget) evict(_byteBudget);
+}
+
+template<class T> void ResourceManagerData<T>::evict(const std::size_t budget) {
+    if(_byteSize <= budget) return;
+
+    /* Gather all evictable resources and order them by last use */
+    std::vector<Data*> candidates;
+    for(Data* const data: _slots) {
+        if(data && data->policy != ResourcePolicy::Resident && !data->referenceCount && data->byteSize && data->state != ResourceDataState::Loading)
+            candidates.push_back(data);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Data* a, const Data* b) {
+        return a->lastUse < b->lastUse;
+    });
+
+    for(Data* const data: candidates) {
+        if(_byteSize <= budget) break;
+        erase(*data);
+    }
 }
 
 template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
@@ -529,16 +766,27 @@ template<class T> void ResourceManagerData<T>::setFallback(T* const data) {
     _fallback = data;
     /* Notify resources also in this case, as some of them could go from empty
        to a fallback (or from a fallback to empty) */
-    ++_lastChange;
+    for(Data* const d: _slots) if(d) ++d->generation;
 }
 
 template<class T> void ResourceManagerData<T>::free() {
-    /* Delete all non-referenced non-resident resources */
-    for(auto it = _data.begin(); it != _data.end(); ) {
-        if(it->second.policy != ResourcePolicy::Resident && !it->second.referenceCount)
-            it = _data.erase(it);
-        else ++it;
+    /* Delete all non-referenced non-resident resources. Gathering them first
+       as erasing shifts the other entries around. */
+    std::vector<Data*> unused;
+    for(Data* const data: _slots) {
+        if(data && data->policy != ResourcePolicy::Resident && !data->referenceCount)
+            unused.push_back(data);
     }
+    for(Data* const data: unused) erase(*data);
+}
+
+template<class T> void ResourceManagerData<T>::clear() {
+    for(Data*& data: _slots) {
+        delete data;
+        data = nullptr;
+    }
+    _count = 0;
+    _byteSize = 0;
 }
 
 template<class T> void ResourceManagerData<T>::setLoader(AbstractResourceLoader<T>* const loader) {
@@ -556,34 +804,36 @@ template<class T> void ResourceManagerData<T>::freeLoader() {
     delete _loader;
 }
 
-template<class T> void ResourceManagerData<T>::decrementReferenceCount(ResourceKey key) {
-    auto it = _data.find(key);
-    CORRADE_INTERNAL_ASSERT(it != _data.end());
+template<class T> void ResourceManagerData<T>::decrementReferenceCount(Data& data) {
+    data.lastUse = ++_lastUse;
 
     /* Free the resource if it is reference counted */
-    if(--it->second.referenceCount == 0 && it->second.policy == ResourcePolicy::ReferenceCounted)
-        _data.erase(it);
+    if(--data.referenceCount == 0 && data.policy == ResourcePolicy::ReferenceCounted)
+        erase(data);
 }
 
 template<class T> struct ResourceManagerData<T>::Data {
-    Data(): data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0) {}
+    explicit Data(ResourceKey key): key(key), data(nullptr), state(ResourceDataState::Mutable), policy(ResourcePolicy::Manual), referenceCount(0), byteSize(0), lastUse(0), generation(1) {}
 
     Data(const Data&) = delete;
-
-    Data(Data&& other): data(other.data), state(other.state), policy(other.policy), referenceCount(other.referenceCount) {
-        other.data = nullptr;
-        other.referenceCount = 0;
-    }
+    Data(Data&&) = delete;
 
     ~Data();
 
     Data& operator=(const Data&) = delete;
     Data& operator=(Data&&) = delete;
 
+    ResourceKey key;
     T* data;
     ResourceDataState state;
     ResourcePolicy policy;
     std::size_t referenceCount;
+    std::size_t byteSize;
+    std::size_t lastUse;
+    /* Incremented on every change affecting Resource instances, which
+       compare it to the value they saw last time. Starts at 1 so a newly
+       created Resource always acquires the data. */
+    std::size_t generation;
 };
 
 template<class T> inline ResourceManagerData<T>::Data::~Data() {
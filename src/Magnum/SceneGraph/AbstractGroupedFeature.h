@@ -100,6 +100,8 @@ template<UnsignedInt dimensions, class Derived, class T> class AbstractGroupedFe
 
     private:
         FeatureGroup<dimensions, Derived, T>* _group;
+        /* Position in the group for constant-time removal */
+        std::size_t _groupIndex{};
 };
 
 /**
@@ -178,7 +178,19 @@ template<UnsignedInt dimensions, class T> class AbstractObject
          *      when possible.
          */
         std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix = MatrixType()) const {
-            return doTransformationMatrices(objects, finalTransformationMatrix);
+            return doTransformationMatrices(objects, finalTransformationMatrix, 1);
+        }
+
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using multiple threads
+         * @m_since_latest
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>&, const MatrixType&) const
+         * but with the work split across @p threadCount threads. See
+         * @ref Object::transformations() for more information.
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix, UnsignedInt threadCount) const {
+            return doTransformationMatrices(objects, finalTransformationMatrix, threadCount);
         }
 
         /* Since 1.8.17, the original short-hand group closing doesn't work
@@ -265,7 +277,7 @@ template<UnsignedInt dimensions, class T> class AbstractObject
 
         virtual MatrixType doTransformationMatrix() const = 0;
         virtual MatrixType doAbsoluteTransformationMatrix() const = 0;
-        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix) const = 0;
+        virtual std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>>& objects, const MatrixType& finalTransformationMatrix, UnsignedInt threadCount) const = 0;
 
         virtual bool doIsDirty() const = 0;
         virtual void doSetDirty() = 0;
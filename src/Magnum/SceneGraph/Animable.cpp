@@ -23,12 +23,26 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include "Animable.h"
+#include "Animable.hpp"
 
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Implementation/threads.h"
+
 namespace Magnum { namespace SceneGraph {
 
+namespace Implementation {
+
+void animableStepsOnThreads(const UnsignedInt threadCount, const std::size_t count, void(*const step)(void*, std::size_t, std::size_t), void* const state) {
+    const UnsignedInt actualThreadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), count);
+    Magnum::Implementation::runOnThreads(actualThreadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(count, actualThreadCount, thread);
+        step(state, range.first, range.second);
+    });
+}
+
+}
+
 Debug& operator<<(Debug& debug, const AnimationState value) {
     debug << "SceneGraph::AnimationState" << Debug::nospace;
 
@@ -106,6 +106,25 @@ just puts itself to rest and waits until some animation changes its state to
 permanently running into separate group, they will not be traversed every time
 the @ref AnimableGroup::step() gets called, saving precious frame time.
 
+@section SceneGraph-Animable-multithreading Stepping animations on multiple threads
+
+With many animables in a single group it might be beneficial to perform the
+animation steps on multiple threads. Animables that don't touch any state
+shared with other animables in their @ref animationStep() can be marked with
+@ref setThreadSafe(), and the group then told to use more threads with
+@ref AnimableGroup::setThreadCount():
+
+@snippet MagnumSceneGraph.cpp Animable-multithreading
+
+The @ref AnimableGroup::step() then first goes through all animables in order
+on the calling thread, updating their state, calling the state change
+callbacks and performing the steps of animables that aren't thread-safe. The
+steps of thread-safe animables are performed after that, split across the
+threads. The state change callbacks are thus always called in a deterministic
+order from the thread calling @ref AnimableGroup::step() and
+@ref animationStarted() or @ref animationResumed() is always called before
+the corresponding @ref animationStep().
+
 @section SceneGraph-Animable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -201,6 +220,35 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
             return *this;
         }
 
+        /**
+         * @brief Whether the animation step is thread-safe
+         * @m_since_latest
+         *
+         * @see @ref setThreadSafe()
+         */
+        bool isThreadSafe() const { return _threadSafe; }
+
+        /**
+         * @brief Mark the animation step as thread-safe
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If enabled and @ref AnimableGroup::setThreadCount() is set to a
+         * value other than @cpp 1 @ce, @ref animationStep() may get called
+         * from a different thread than @ref AnimableGroup::step(),
+         * concurrently with steps of other thread-safe animables in the same
+         * group. The implementation thus shouldn't modify any state shared
+         * with other animables. The @ref animationStarted(),
+         * @ref animationPaused(), @ref animationResumed() and
+         * @ref animationStopped() callbacks are always called from the thread
+         * calling @ref AnimableGroup::step(). Default is @cpp false @ce. See
+         * @ref SceneGraph-Animable-multithreading for more information.
+         */
+        Animable<dimensions, T>& setThreadSafe(bool threadSafe) {
+            _threadSafe = threadSafe;
+            return *this;
+        }
+
         /**
          * @brief Group containing this animable
          *
@@ -298,7 +346,7 @@ template<UnsignedInt dimensions, class T> class Animable: public AbstractGrouped
         Float _duration;
         Float _startTime, _pauseTime;
         AnimationState _previousState, _currentState;
-        bool _repeated;
+        bool _repeated, _threadSafe;
         UnsignedShort _repeatCount;
         UnsignedShort _repeats;
 };
@@ -29,6 +29,8 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Animable.h and @ref AnimableGroup.h
  */
 
+#include <Corrade/Containers/GrowableArray.h>
+
 #include "Magnum/Timeline.h"
 #include "Magnum/Math/Constants.h"
 #include "Magnum/SceneGraph/AnimableGroup.h"
@@ -36,7 +38,14 @@
 
 namespace Magnum { namespace SceneGraph {
 
-template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>{object, group}, _duration{0.0f}, _startTime{Constants::inf()}, _pauseTime{-Constants::inf()}, _previousState{AnimationState::Stopped}, _currentState{AnimationState::Stopped}, _repeated{false}, _repeatCount{0}, _repeats{0} {}
+namespace Implementation {
+    /* Calls step(state, begin, end) for subranges of [0, count) on up to
+       threadCount threads, defined in Animable.cpp to keep <thread> out of
+       this header */
+    MAGNUM_SCENEGRAPH_EXPORT void animableStepsOnThreads(UnsignedInt threadCount, std::size_t count, void(*step)(void*, std::size_t, std::size_t), void* state);
+}
+
+template<UnsignedInt dimensions, class T> Animable<dimensions, T>::Animable(AbstractObject<dimensions, T>& object, AnimableGroup<dimensions, T>* group): AbstractGroupedFeature<dimensions, Animable<dimensions, T>, T>{object, group}, _duration{0.0f}, _startTime{Constants::inf()}, _pauseTime{-Constants::inf()}, _previousState{AnimationState::Stopped}, _currentState{AnimationState::Stopped}, _repeated{false}, _threadSafe{false}, _repeatCount{0}, _repeats{0} {}
 
 template<UnsignedInt dimensions, class T> Animable<dimensions, T>::~Animable() {
     /* Update count of running animations when deleting an animable that's
@@ -70,6 +79,11 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
     if(!_runningCount && !wakeUp) return;
     wakeUp = false;
 
+    /* Steps of thread-safe animables get collected here and performed after
+       the state of all animables is updated */
+    const bool parallel = _threadCount != 1;
+    arrayResize(_parallelSteps, 0);
+
     for(std::size_t i = 0; i != AnimableGroup<dimensions, T>::size(); ++i) {
         Animable<dimensions, T>& animable = (*this)[i];
 
@@ -135,10 +149,25 @@ template<UnsignedInt dimensions, class T> void AnimableGroup<dimensions, T>::ste
             "SceneGraph::AnimableGroup::step(): animation was started in future - probably wrong time passed", );
         CORRADE_ASSERT(delta >= 0.0f,
             "SceneGraph::AnimableGroup::step(): negative delta passed", );
-        animable.animationStep(time - animable._startTime, delta);
+        if(parallel && animable._threadSafe)
+            arrayAppend(_parallelSteps, Containers::InPlaceInit, &animable, time - animable._startTime);
+        else
+            animable.animationStep(time - animable._startTime, delta);
     }
 
     CORRADE_INTERNAL_ASSERT((_runningCount <= AnimableGroup<dimensions, T>::size()));
+
+    if(_parallelSteps.empty()) return;
+
+    struct State {
+        Containers::ArrayView<const std::pair<Animable<dimensions, T>*, Float>> steps;
+        Float delta;
+    } state{_parallelSteps, delta};
+    Implementation::animableStepsOnThreads(_threadCount, _parallelSteps.size(), [](void* state, const std::size_t begin, const std::size_t end) {
+        const State& s = *static_cast<const State*>(state);
+        for(std::size_t i = begin; i != end; ++i)
+            s.steps[i].first->animationStep(s.steps[i].second, s.delta);
+    }, &state);
 }
 
 }}
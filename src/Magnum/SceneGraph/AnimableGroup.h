@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::SceneGraph::AnimableGroup, alias @ref Magnum::SceneGraph::BasicAnimableGroup2D, @ref Magnum::SceneGraph::BasicAnimableGroup3D, typedef @ref Magnum::SceneGraph::AnimableGroup2D, @ref Magnum::SceneGraph::AnimableGroup3D
  */
 
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/SceneGraph/Animable.h"
 #include "Magnum/SceneGraph/FeatureGroup.h"
 #include "Magnum/SceneGraph/visibility.h"
@@ -58,19 +60,48 @@ template<UnsignedInt dimensions, class T> class AnimableGroup: public FeatureGro
          */
         std::size_t runningCount() const { return _runningCount; }
 
+        /**
+         * @brief Count of threads used for animation steps
+         * @m_since_latest
+         *
+         * @see @ref setThreadCount()
+         */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set count of threads used for animation steps
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Steps of animables marked with @ref Animable::setThreadSafe() are
+         * then split across given count of threads in @ref step(). If
+         * @cpp 0 @ce, the value of @ref std::thread::hardware_concurrency()
+         * is used. With too few thread-safe animables, less threads are used.
+         * Default is @cpp 1 @ce. See @ref SceneGraph-Animable-multithreading
+         * for more information.
+         */
+        AnimableGroup<dimensions, T>& setThreadCount(UnsignedInt count) {
+            _threadCount = count;
+            return *this;
+        }
+
         /**
          * @brief Perform animation step
          * @param time      Absolute time (e.g. @ref Timeline::previousFrameTime())
          * @param delta     Time delta for current frame (e.g. @ref Timeline::previousFrameDuration())
          *
          * If there are no running animations the function does nothing.
-         * @see @ref runningCount()
+         * @see @ref runningCount(), @ref setThreadCount()
          */
         void step(Float time, Float delta);
 
     private:
         std::size_t _runningCount;
         bool wakeUp;
+        UnsignedInt _threadCount{1};
+        /* Thread-safe animables and their time to step with in parallel,
+           kept between step() calls to avoid reallocations */
+        Containers::Array<std::pair<Animable<dimensions, T>*, Float>> _parallelSteps;
 };
 
 /**
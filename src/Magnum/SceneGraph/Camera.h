@@ -186,6 +186,63 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         void setViewport(const Vector2i& size);
 
+        /**
+         * @brief Count of threads used for calculating transformations
+         * @m_since_latest
+         *
+         * @see @ref setThreadCount()
+         */
+        UnsignedInt threadCount() const { return _threadCount; }
+
+        /**
+         * @brief Set count of threads used for calculating transformations
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Passed to @ref AbstractObject::transformationMatrices() in
+         * @ref drawableTransformations() and @ref draw(). If @cpp 0 @ce,
+         * the value of @ref std::thread::hardware_concurrency() is used.
+         * The calculated transformations are the same independently of the
+         * thread count. See @ref Object::transformations() for details.
+         * Default is @cpp 1 @ce.
+         */
+        Camera<dimensions, T>& setThreadCount(UnsignedInt count) {
+            _threadCount = count;
+            return *this;
+        }
+
+        /**
+         * @brief Whether transformation caching is enabled
+         * @m_since_latest
+         *
+         * @see @ref setTransformationCachingEnabled()
+         */
+        bool isTransformationCachingEnabled() const {
+            return _transformationCachingEnabled;
+        }
+
+        /**
+         * @brief Enable or disable transformation caching
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * If enabled, @ref drawableTransformations() and @ref draw() don't
+         * recalculate absolute transformations of all drawables every time
+         * but reuse the transformation each @ref Drawable remembered the last
+         * time its object was cleaned, cleaning only objects that are dirty.
+         * The camera-relative transformations are then calculated in a single
+         * batched pass, for 3D @ref Magnum::Float "Float" scenes using
+         * @ref Math::transformInto(). The first draw with caching enabled
+         * marks all objects in the group as dirty to populate the cache. The
+         * @ref threadCount() isn't used in this case. Default is disabled,
+         * see @ref SceneGraph-Drawable-transformation-caching for more
+         * information.
+         */
+        Camera<dimensions, T>& setTransformationCachingEnabled(bool enabled) {
+            _transformationCachingEnabled = enabled;
+            return *this;
+        }
+
         /**
          * @brief Drawable transformations
          *
@@ -213,6 +270,20 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
          */
         void draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations);
 
+        /**
+         * @brief Draw drawables intersecting the camera frustum
+         * @m_since_latest
+         *
+         * Calls @ref DrawableBvh::update() and culls the drawables with
+         * @ref DrawableBvh::cull() against a frustum given by
+         * @ref projectionMatrix() and @ref cameraMatrix(). Transformations
+         * are then calculated and @ref Drawable::draw() called only for
+         * the drawables that weren't culled. Drawables without a bounding box
+         * are always drawn, after all others. See
+         * @ref SceneGraph-Drawable-bounds for more information.
+         */
+        void draw(DrawableBvh<dimensions, T>& bvh);
+
     private:
         /** Recalculates camera matrix */
         void cleanInverted(const MatrixTypeFor<dimensions, T>& invertedAbsoluteTransformationMatrix) override {
@@ -221,6 +292,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
 
         void fixAspectRatio();
 
+        std::vector<MatrixTypeFor<dimensions, T>> cachedTransformationMatrices(Containers::ArrayView<Drawable<dimensions, T>* const> drawables) const;
+
         MatrixTypeFor<dimensions, T> _rawProjectionMatrix;
         AspectRatioPolicy _aspectRatioPolicy;
 
@@ -228,6 +301,8 @@ template<UnsignedInt dimensions, class T> class Camera: public AbstractFeature<d
         MatrixTypeFor<dimensions, T> _cameraMatrix;
 
         Vector2i _viewport;
+        UnsignedInt _threadCount{1};
+        bool _transformationCachingEnabled{};
 };
 
 /**
@@ -29,9 +29,14 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Camera.h
  */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Math/Functions.h"
+#include "Magnum/Math/TransformBatch.h"
 #include "Magnum/SceneGraph/Camera.h"
 #include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
 
 namespace Magnum { namespace SceneGraph {
 
@@ -53,6 +58,17 @@ template<UnsignedInt dimensions, class T> MatrixTypeFor<dimensions, T> aspectRat
         Math::Vector2<T>(T(1), relativeAspectRatio.x()/relativeAspectRatio.y()), T(1)));
 }
 
+template<class T> void applyCameraMatrix(const T& cameraMatrix, const Containers::ArrayView<T> matrices) {
+    for(T& matrix: matrices) matrix = cameraMatrix*matrix;
+}
+
+/* Each column of the matrix is a four-component vector multiplied by the
+   camera matrix, so all of them can go through the batch transformation */
+inline void applyCameraMatrix(const Matrix4& cameraMatrix, const Containers::ArrayView<Matrix4> matrices) {
+    const Containers::ArrayView<Vector4> columns{reinterpret_cast<Vector4*>(matrices.data()), matrices.size()*4};
+    Math::transformInto(cameraMatrix, columns, columns);
+}
+
 }
 
 template<UnsignedInt dimensions, class T> Camera<dimensions, T>::Camera(AbstractObject<dimensions, T>& object): AbstractFeature<dimensions, T>(object), _aspectRatioPolicy(AspectRatioPolicy::NotPreserved) {
@@ -82,6 +98,28 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::setViewpor
     fixAspectRatio();
 }
 
+template<UnsignedInt dimensions, class T> std::vector<MatrixTypeFor<dimensions, T>> Camera<dimensions, T>::cachedTransformationMatrices(const Containers::ArrayView<Drawable<dimensions, T>* const> drawables) const {
+    /* Clean only the dirty objects, the rest has the absolute transformation
+       already remembered from the last time. First use marks the object
+       dirty so it's always cleaned here. */
+    for(Drawable<dimensions, T>* drawable: drawables) {
+        if(!drawable->_transformationCached)
+            drawable->enableTransformationCaching();
+        if(drawable->object().isDirty())
+            drawable->object().setClean();
+    }
+
+    /* Gather the cached transformations and make them relative to the camera
+       in one pass */
+    std::vector<MatrixTypeFor<dimensions, T>> transformations;
+    transformations.reserve(drawables.size());
+    for(Drawable<dimensions, T>* drawable: drawables)
+        transformations.push_back(drawable->_absoluteTransformationMatrix);
+    Implementation::applyCameraMatrix(_cameraMatrix, Containers::arrayView(transformations.data(), transformations.size()));
+
+    return transformations;
+}
+
 template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> Camera<dimensions, T>::drawableTransformations(DrawableGroup<dimensions, T>& group) {
     AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
     CORRADE_ASSERT(scene, "Camera::draw(): cannot draw when camera is not part of any scene", {});
@@ -90,12 +128,19 @@ template<UnsignedInt dimensions, class T> std::vector<std::pair<std::reference_w
     AbstractFeature<dimensions, T>::object().setClean();
 
     /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    std::vector<MatrixTypeFor<dimensions, T>> transformations;
+    if(_transformationCachingEnabled) {
+        Containers::Array<Drawable<dimensions, T>*> drawables{Containers::NoInit, group.size()};
+        for(std::size_t i = 0; i != group.size(); ++i)
+            drawables[i] = &group[i];
+        transformations = cachedTransformationMatrices(drawables);
+    } else {
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+        objects.reserve(group.size());
+        for(std::size_t i = 0; i != group.size(); ++i)
+            objects.push_back(group[i].object());
+        transformations = scene->transformationMatrices(objects, _cameraMatrix, _threadCount);
+    }
 
     /* Combine drawable references and transformation matrices */
     std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>> combined;
@@ -114,18 +159,54 @@ template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(Drawa
     AbstractFeature<dimensions, T>::object().setClean();
 
     /* Compute transformations of all objects in the group relative to the camera */
-    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
-    objects.reserve(group.size());
-    for(std::size_t i = 0; i != group.size(); ++i)
-        objects.push_back(group[i].object());
-    std::vector<MatrixTypeFor<dimensions, T>> transformations =
-        scene->transformationMatrices(objects, _cameraMatrix);
+    std::vector<MatrixTypeFor<dimensions, T>> transformations;
+    if(_transformationCachingEnabled) {
+        Containers::Array<Drawable<dimensions, T>*> drawables{Containers::NoInit, group.size()};
+        for(std::size_t i = 0; i != group.size(); ++i)
+            drawables[i] = &group[i];
+        transformations = cachedTransformationMatrices(drawables);
+    } else {
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+        objects.reserve(group.size());
+        for(std::size_t i = 0; i != group.size(); ++i)
+            objects.push_back(group[i].object());
+        transformations = scene->transformationMatrices(objects, _cameraMatrix, _threadCount);
+    }
 
     /* Perform the drawing */
     for(std::size_t i = 0; i != transformations.size(); ++i)
         group[i].draw(transformations[i], *this);
 }
 
+template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(DrawableBvh<dimensions, T>& bvh) {
+    AbstractObject<dimensions, T>* scene = AbstractFeature<dimensions, T>::object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::Camera::draw(): cannot draw when camera is not part of any scene", );
+
+    /* Compute camera matrix */
+    AbstractFeature<dimensions, T>::object().setClean();
+
+    /* Update world-space bounds of moved drawables and cull them */
+    bvh.update();
+    const Containers::ArrayView<Drawable<dimensions, T>*> visible = bvh.cull(_projectionMatrix*_cameraMatrix);
+
+    /* Compute transformations of only the visible objects relative to the
+       camera */
+    std::vector<MatrixTypeFor<dimensions, T>> transformations;
+    if(_transformationCachingEnabled)
+        transformations = cachedTransformationMatrices(visible);
+    else {
+        std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+        objects.reserve(visible.size());
+        for(Drawable<dimensions, T>* drawable: visible)
+            objects.push_back(drawable->object());
+        transformations = scene->transformationMatrices(objects, _cameraMatrix, _threadCount);
+    }
+
+    /* Perform the drawing */
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        visible[i]->draw(transformations[i], *this);
+}
+
 template<UnsignedInt dimensions, class T> void Camera<dimensions, T>::draw(const std::vector<std::pair<std::reference_wrapper<Drawable<dimensions, T>>, MatrixTypeFor<dimensions, T>>>& drawableTransformations) {
     for(auto&& drawableTransformation: drawableTransformations)
         drawableTransformation.first.get().draw(drawableTransformation.second, *this);
@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::Drawable, @ref Magnum::SceneGraph::DrawableGroup, alias @ref Magnum::SceneGraph::BasicDrawable2D, @ref Magnum::SceneGraph::BasicDrawable3D, @ref Magnum::SceneGraph::BasicDrawableGroup2D, @ref Magnum::SceneGraph::BasicDrawableGroup3D, typedef @ref Magnum::SceneGraph::Drawable2D, @ref Magnum::SceneGraph::Drawable3D, @ref Magnum::SceneGraph::DrawableGroup2D, @ref Magnum::SceneGraph::DrawableGroup3D
  */
 
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Math/Range.h"
 #include "Magnum/SceneGraph/AbstractGroupedFeature.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -133,6 +136,49 @@ get used in any way except being passed to the draw function:
 
 @snippet MagnumSceneGraph.cpp Drawable-culling
 
+@section SceneGraph-Drawable-bounds Frustum culling using bounding boxes
+
+For large scenes where most drawables are outside of the view it's more
+efficient to let the scene graph do the culling. Each drawable can be given an
+optional bounding box relative to its object using @ref setBoundingBox(). The
+box gets transformed to world space every time the object is cleaned and a
+@ref DrawableBvh built from the drawable group then keeps the world-space boxes
+in a bounding volume hierarchy. Passing it to
+@ref Camera::draw(DrawableBvh<dimensions, T>&) draws only drawables that
+intersect the camera frustum, calculating transformations only for those.
+Drawables without a bounding box are never culled.
+
+@snippet MagnumSceneGraph.cpp Drawable-bvh
+
+@section SceneGraph-Drawable-transformation-caching Caching transformations across frames
+
+In mostly static scenes, calculating absolute transformations of all drawables
+from scratch every frame is wasted work. With
+@ref Camera::setTransformationCachingEnabled() the camera instead remembers the
+absolute transformation of each drawable the last time its object was cleaned
+and recalculates only objects that were marked as dirty since then, for example
+by changing their transformation. If you reimplement @ref clean() in a
+subclass, call the @ref Drawable implementation from it, otherwise the cached
+transformation won't be updated.
+
+@section SceneGraph-Drawable-sorting Sorting and batching drawables
+
+To minimize state changes, drawables can be drawn sorted by the state they
+use, through a @ref DrawableQueue. Each drawable is given a sort key with
+@ref setSortKey(), usually composed from IDs of the shader, material and mesh
+it uses using @ref drawableSortKey(). The queue then sorts the drawables by the
+key together with their distance from the camera and submits consecutive runs
+of drawables with the same state to @ref drawBatch(), which can be
+reimplemented to draw all of them at once. For example, with a shader
+supporting @ref Shaders::Phong::Flag::InstancedTransformation:
+
+@snippet MagnumSceneGraph-gl.cpp Drawable-batch
+
+The instance buffer is added to the mesh just once, each frame the queue is
+then filled, sorted and drawn:
+
+@snippet MagnumSceneGraph-gl.cpp Drawable-batch-draw
+
 @section SceneGraph-Drawable-explicit-specializations Explicit template specializations
 
 The following specializations are explicitly compiled into @ref SceneGraph
@@ -187,6 +233,127 @@ template<UnsignedInt dimensions, class T> class Drawable: public AbstractGrouped
          * @ref SceneGraph::Camera::projectionMatrix() "Camera::projectionMatrix()".
          */
         virtual void draw(const MatrixTypeFor<dimensions, T>& transformationMatrix, Camera<dimensions, T>& camera) = 0;
+
+        /**
+         * @brief Draw a batch of drawables using given camera
+         * @param drawables             Drawables in the batch, with this
+         *      drawable being the first
+         * @param transformationMatrices Object transformations relative to
+         *      camera
+         * @param camera                Camera
+         * @m_since_latest
+         *
+         * Called by @ref DrawableQueue::draw() on the first drawable of each
+         * run of drawables having the same state part of @ref sortKey(). The
+         * default implementation calls @ref draw() on each drawable in
+         * @p drawables, reimplement it to draw the whole batch at once, for
+         * example as a single instanced draw. See
+         * @ref SceneGraph-Drawable-sorting for more information.
+         */
+        virtual void drawBatch(Containers::ArrayView<Drawable<dimensions, T>* const> drawables, Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformationMatrices, Camera<dimensions, T>& camera);
+
+        /**
+         * @brief Sort key
+         * @m_since_latest
+         *
+         * Default is @cpp 0 @ce. See @ref setSortKey() for more
+         * information.
+         */
+        UnsignedLong sortKey() const { return _sortKey; }
+
+        /**
+         * @brief Set sort key
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Used by @ref DrawableQueue to order drawables so drawables using
+         * the same state are drawn together and to merge them into batches
+         * for @ref drawBatch(). Only the upper 48 bits are used, the lower 16
+         * bits are replaced with a quantized depth by the queue. Use
+         * @ref drawableSortKey() to compose the key from shader, material and
+         * mesh IDs.
+         */
+        Drawable<dimensions, T>& setSortKey(UnsignedLong key) {
+            _sortKey = key;
+            return *this;
+        }
+
+        /**
+         * @brief Whether the drawable has a bounding box
+         * @m_since_latest
+         *
+         * @see @ref setBoundingBox()
+         */
+        bool hasBoundingBox() const { return _hasBoundingBox; }
+
+        /**
+         * @brief Bounding box relative to the object
+         * @m_since_latest
+         *
+         * If @ref hasBoundingBox() is @cpp false @ce, the value is
+         * unspecified.
+         */
+        RangeTypeFor<dimensions, T> boundingBox() const { return _boundingBox; }
+
+        /**
+         * @brief Set bounding box relative to the object
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Enables @ref CachedTransformation::Absolute and marks the object
+         * as dirty, so the box gets transformed to world space the next time
+         * the object is cleaned. Used by @ref DrawableBvh for frustum
+         * culling, see @ref SceneGraph-Drawable-bounds for more information.
+         * If the drawable doesn't have a bounding box, it's never culled.
+         *
+         * If you reimplement @ref clean() in a subclass, call the
+         * @ref Drawable implementation from it, otherwise the world-space
+         * box won't be updated.
+         * @see @ref absoluteBoundingBox()
+         */
+        Drawable<dimensions, T>& setBoundingBox(const RangeTypeFor<dimensions, T>& box);
+
+        /**
+         * @brief Bounding box in world space
+         * @m_since_latest
+         *
+         * Axis-aligned box enclosing @ref boundingBox() transformed with the
+         * absolute object transformation. Valid as of the last time the
+         * object was cleaned. If @ref hasBoundingBox() is @cpp false @ce,
+         * the value is unspecified.
+         * @see @ref AbstractObject::setClean()
+         */
+        RangeTypeFor<dimensions, T> absoluteBoundingBox() const { return _absoluteBoundingBox; }
+
+    protected:
+        /**
+         * @brief Clean data based on absolute transformation
+         * @m_since_latest
+         *
+         * Recalculates @ref absoluteBoundingBox() if the drawable has a
+         * bounding box and remembers the absolute transformation if
+         * @ref Camera::setTransformationCachingEnabled() "transformation caching"
+         * is used for it.
+         */
+        void clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) override;
+
+    private:
+        #ifndef DOXYGEN_GENERATING_OUTPUT /* https://bugzilla.gnome.org/show_bug.cgi?id=776986 */
+        friend DrawableBvh<dimensions, T>;
+        friend Camera<dimensions, T>;
+        #endif
+
+        /* Called by Camera if transformation caching is enabled */
+        void enableTransformationCaching();
+
+        UnsignedLong _sortKey{};
+        RangeTypeFor<dimensions, T> _boundingBox, _absoluteBoundingBox;
+        bool _hasBoundingBox{};
+        /* Set in clean(), reset by DrawableBvh::update() */
+        bool _absoluteBoundingBoxChanged{};
+        /* Set in clean() if _transformationCached is set */
+        bool _transformationCached{};
+        MatrixTypeFor<dimensions, T> _absoluteTransformationMatrix;
 };
 
 /**
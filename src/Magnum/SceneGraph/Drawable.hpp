@@ -29,12 +29,55 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref Drawable.h
  */
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/Drawable.h"
 
 namespace Magnum { namespace SceneGraph {
 
 template<UnsignedInt dimensions, class T> Drawable<dimensions, T>::Drawable(AbstractObject<dimensions, T>& object, DrawableGroup<dimensions, T>* drawables): AbstractGroupedFeature<dimensions, Drawable<dimensions, T>, T>(object, drawables) {}
 
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::drawBatch(const Containers::ArrayView<Drawable<dimensions, T>* const> drawables, const Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformationMatrices, Camera<dimensions, T>& camera) {
+    for(std::size_t i = 0; i != drawables.size(); ++i)
+        drawables[i]->draw(transformationMatrices[i], camera);
+}
+
+template<UnsignedInt dimensions, class T> Drawable<dimensions, T>& Drawable<dimensions, T>::setBoundingBox(const RangeTypeFor<dimensions, T>& box) {
+    _boundingBox = box;
+    _hasBoundingBox = true;
+    AbstractFeature<dimensions, T>::setCachedTransformations(AbstractFeature<dimensions, T>::cachedTransformations()|CachedTransformation::Absolute);
+
+    /* The object might be already clean, force the box to be recalculated */
+    AbstractFeature<dimensions, T>::object().setDirty();
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::enableTransformationCaching() {
+    _transformationCached = true;
+    AbstractFeature<dimensions, T>::setCachedTransformations(AbstractFeature<dimensions, T>::cachedTransformations()|CachedTransformation::Absolute);
+
+    /* The object might be already clean, force the transformation to be
+       remembered */
+    AbstractFeature<dimensions, T>::object().setDirty();
+}
+
+template<UnsignedInt dimensions, class T> void Drawable<dimensions, T>::clean(const MatrixTypeFor<dimensions, T>& absoluteTransformationMatrix) {
+    if(_transformationCached)
+        _absoluteTransformationMatrix = absoluteTransformationMatrix;
+
+    if(!_hasBoundingBox) return;
+
+    /* Transform the center and project the rotated and scaled half-extents
+       onto the world axes to get the enclosing axis-aligned box */
+    const VectorTypeFor<dimensions, T> center = absoluteTransformationMatrix.transformPoint(_boundingBox.center());
+    const VectorTypeFor<dimensions, T> halfSize = _boundingBox.size()/T(2);
+    VectorTypeFor<dimensions, T> extents;
+    for(UnsignedInt i = 0; i != dimensions; ++i)
+        extents += Math::abs(VectorTypeFor<dimensions, T>::pad(absoluteTransformationMatrix[i]))*halfSize[i];
+
+    _absoluteBoundingBox = {center - extents, center + extents};
+    _absoluteBoundingBoxChanged = true;
+}
+
 }}
 
 #endif
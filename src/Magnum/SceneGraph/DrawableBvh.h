@@ -0,0 +1,231 @@
+#ifndef Magnum_SceneGraph_DrawableBvh_h
+#define Magnum_SceneGraph_DrawableBvh_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DrawableBvh, alias @ref Magnum::SceneGraph::BasicDrawableBvh2D, @ref Magnum::SceneGraph::BasicDrawableBvh3D, typedef @ref Magnum::SceneGraph::DrawableBvh2D, @ref Magnum::SceneGraph::DrawableBvh3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Bounding volume hierarchy of drawables
+@m_since_latest
+
+Spatial index of a @ref DrawableGroup, used to cull drawables outside of the
+camera frustum in @ref Camera::draw(DrawableBvh<dimensions, T>&). Drawables
+that have a bounding box set with @ref Drawable::setBoundingBox() are stored
+in a binary tree of axis-aligned boxes, split at the median along the longest
+axis, with up to @ref leafSize() drawables in each leaf. Drawables without a
+bounding box are stored separately and are never culled.
+
+@snippet MagnumSceneGraph.cpp Drawable-bvh
+
+@section SceneGraph-DrawableBvh-updates Incremental updates
+
+The tree topology is built in @ref rebuild(). Each @ref update() then cleans
+only objects that were marked as dirty since, which recalculates world-space
+boxes of their drawables in @ref Drawable::clean(), and if any box changed,
+refits bounds of the tree nodes in a single bottom-up sweep. The topology
+stays the same, so as objects move far from their original positions, the tree
+gets less efficient and it may be worth calling @ref rebuild() again.
+
+The tree is rebuilt implicitly when the count of drawables in the group
+changes. If a drawable is replaced with another or if a drawable gains a
+bounding box, @ref rebuild() has to be called explicitly.
+
+@section SceneGraph-DrawableBvh-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref DrawableBvh.hpp implementation file to avoid linker
+errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref DrawableBvh2D
+-   @ref DrawableBvh3D
+
+@see @ref SceneGraph-Drawable-bounds, @ref BasicDrawableBvh2D,
+    @ref BasicDrawableBvh3D, @ref DrawableBvh2D, @ref DrawableBvh3D
+*/
+template<UnsignedInt dimensions, class T> class DrawableBvh {
+    public:
+        /**
+         * @brief Constructor
+         * @param group     Drawable group to index
+         * @param leafSize  Max count of drawables in a leaf node
+         *
+         * Calls @ref rebuild(). The @p group is expected to stay alive for
+         * the whole lifetime of the hierarchy. Expects that @p leafSize is
+         * not zero.
+         */
+        explicit DrawableBvh(DrawableGroup<dimensions, T>& group, UnsignedInt leafSize = 16);
+
+        /** @brief Indexed drawable group */
+        DrawableGroup<dimensions, T>& group() { return *_group; }
+        const DrawableGroup<dimensions, T>& group() const { return *_group; } /**< @overload */
+
+        /** @brief Max count of drawables in a leaf node */
+        UnsignedInt leafSize() const { return _leafSize; }
+
+        /** @brief Count of tree nodes */
+        std::size_t nodeCount() const { return _nodes.size(); }
+
+        /** @brief Count of drawables with a bounding box */
+        std::size_t boundedCount() const { return _boundedCount; }
+
+        /** @brief Count of drawables without a bounding box */
+        std::size_t unboundedCount() const {
+            return _drawables.size() - _boundedCount;
+        }
+
+        /**
+         * @brief Rebuild the tree
+         *
+         * Cleans all dirty objects of drawables with a bounding box and
+         * builds the tree from their world-space boxes. Has to be called
+         * after drawables in the group are replaced or get a bounding box.
+         * The allocated memory is reused where possible.
+         */
+        void rebuild();
+
+        /**
+         * @brief Update the tree
+         * @return Count of drawables with a changed bounding box
+         *
+         * If the count of drawables in the group changed since the last
+         * @ref rebuild(), calls it and returns @ref boundedCount().
+         * Otherwise cleans dirty objects of drawables with a bounding box
+         * and refits the node bounds if any of the world-space boxes
+         * changed. Called implicitly from
+         * @ref Camera::draw(DrawableBvh<dimensions, T>&).
+         * @see @ref AbstractObject::setClean()
+         */
+        std::size_t update();
+
+        /**
+         * @brief Cull drawables against a frustum
+         * @param transformationProjectionMatrix World-to-clip-space matrix
+         * @return Drawables intersecting the frustum followed by all drawables
+         *      without a bounding box
+         *
+         * The frustum planes are extracted from
+         * @p transformationProjectionMatrix, for a @ref Camera it's
+         * @ref Camera::projectionMatrix() multiplied with
+         * @ref Camera::cameraMatrix(). Boxes of drawables in leaves that
+         * intersect the frustum are tested in a batch using
+         * @ref Math::Intersection::aabbFrustumIndicesInto() for 3D float
+         * hierarchies and with an equivalent generic test otherwise. Uses the
+         * world-space boxes as of the last @ref update() or @ref rebuild().
+         * The returned view is valid until the next call to this function or
+         * @ref rebuild(). Doesn't allocate.
+         */
+        Containers::ArrayView<Drawable<dimensions, T>*> cull(const MatrixTypeFor<dimensions, T>& transformationProjectionMatrix);
+
+    private:
+        struct Node {
+            Math::Range<dimensions, T> bounds;
+            /* Range of drawables in the whole subtree */
+            UnsignedInt begin, end;
+            /* The first child is always right after its parent, this is the
+               index of the second child. Zero for leaves. */
+            UnsignedInt second;
+        };
+
+        void cleanDirty();
+        UnsignedInt build(Containers::ArrayView<UnsignedInt> order, UnsignedInt begin, UnsignedInt end);
+        void refit();
+
+        DrawableGroup<dimensions, T>* _group;
+        UnsignedInt _leafSize;
+        std::size_t _boundedCount{};
+        /* Preorder, so children are always after their parent */
+        Containers::Array<Node> _nodes;
+        /* Drawables with a bounding box in leaf order, followed by the ones
+           without */
+        Containers::Array<Drawable<dimensions, T>*> _drawables;
+        /* World-space boxes in leaf order as centers and half-extents, which
+           is what the batch culling functions take */
+        Containers::Array<VectorTypeFor<dimensions, T>> _centers, _extents;
+        Containers::Array<Drawable<dimensions, T>*> _visible;
+        Containers::Array<UnsignedInt> _indices;
+};
+
+/**
+@brief Bounding volume hierarchy of drawables for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp DrawableBvh<2, T> @ce. See @ref DrawableBvh
+for more information.
+@see @ref DrawableBvh2D, @ref BasicDrawableBvh3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawableBvh2D = DrawableBvh<2, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy of drawables for two-dimensional float scenes
+@m_since_latest
+
+@see @ref DrawableBvh3D
+*/
+typedef BasicDrawableBvh2D<Float> DrawableBvh2D;
+
+/**
+@brief Bounding volume hierarchy of drawables for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp DrawableBvh<3, T> @ce. See @ref DrawableBvh
+for more information.
+@see @ref DrawableBvh3D, @ref BasicDrawableBvh2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawableBvh3D = DrawableBvh<3, T>;
+#endif
+
+/**
+@brief Bounding volume hierarchy of drawables for three-dimensional float scenes
+@m_since_latest
+
+@see @ref DrawableBvh2D
+*/
+typedef BasicDrawableBvh3D<Float> DrawableBvh3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableBvh<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableBvh<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef Magnum_SceneGraph_DrawableBvh_hpp
+#define Magnum_SceneGraph_DrawableBvh_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref DrawableBvh.h
+ * @m_since_latest
+ */
+
+#include <algorithm>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Frustum planes extracted from a (dimensions + 1)-square matrix, with
+   positive distance inside. For 3D it's the same as Math::Frustum::fromMatrix(),
+   for 2D there are just the left, right, bottom and top lines. */
+template<UnsignedInt dimensions, class T> struct DrawableBvhPlanes {
+    explicit DrawableBvhPlanes(const MatrixTypeFor<dimensions, T>& matrix) {
+        for(UnsignedInt i = 0; i != dimensions; ++i) {
+            planes[2*i] = matrix.row(dimensions) + matrix.row(i);
+            planes[2*i + 1] = matrix.row(dimensions) - matrix.row(i);
+        }
+    }
+
+    /* Same as Math::Intersection::aabbFrustum(), but for any dimension */
+    bool box(const VectorTypeFor<dimensions, T>& center, const VectorTypeFor<dimensions, T>& extents) const {
+        for(const Math::Vector<dimensions + 1, T>& plane: planes) {
+            const VectorTypeFor<dimensions, T> normal = VectorTypeFor<dimensions, T>::pad(plane);
+            if(Math::dot(center, normal) + Math::dot(extents, Math::abs(normal)) < -plane[dimensions])
+                return false;
+        }
+
+        return true;
+    }
+
+    std::size_t boxesIndicesInto(const Containers::ArrayView<const VectorTypeFor<dimensions, T>>& centers, const Containers::ArrayView<const VectorTypeFor<dimensions, T>>& extents, const Containers::ArrayView<UnsignedInt>& out) const {
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != centers.size(); ++i) {
+            out[count] = i;
+            count += box(centers[i], extents[i]);
+        }
+        return count;
+    }
+
+    Math::Vector<dimensions + 1, T> planes[2*dimensions];
+};
+
+/* Use the SIMD-friendly batch test for the 3D float case */
+template<> inline std::size_t DrawableBvhPlanes<3, Float>::boxesIndicesInto(const Containers::ArrayView<const Vector3>& centers, const Containers::ArrayView<const Vector3>& extents, const Containers::ArrayView<UnsignedInt>& out) const {
+    return Math::Intersection::aabbFrustumIndicesInto(centers, extents,
+        Frustum{planes[0], planes[1], planes[2], planes[3], planes[4], planes[5]}, out);
+}
+
+}
+
+template<UnsignedInt dimensions, class T> DrawableBvh<dimensions, T>::DrawableBvh(DrawableGroup<dimensions, T>& group, const UnsignedInt leafSize): _group{&group}, _leafSize{leafSize} {
+    CORRADE_ASSERT(leafSize, "SceneGraph::DrawableBvh: leaf size can't be zero", );
+    rebuild();
+}
+
+template<UnsignedInt dimensions, class T> void DrawableBvh<dimensions, T>::cleanDirty() {
+    /* Cleaning objects one by one is fine, as cleaning an object cleans its
+       dirty parents as well, so each dirty object is processed just once */
+    for(std::size_t i = 0; i != _group->size(); ++i) {
+        Drawable<dimensions, T>& drawable = (*_group)[i];
+        if(drawable._hasBoundingBox && drawable.object().isDirty())
+            drawable.object().setClean();
+    }
+}
+
+template<UnsignedInt dimensions, class T> void DrawableBvh<dimensions, T>::rebuild() {
+    cleanDirty();
+
+    /* Drawables with a bounding box first, the rest after, both in the group
+       order */
+    _drawables = Containers::Array<Drawable<dimensions, T>*>{Containers::NoInit, _group->size()};
+    _boundedCount = 0;
+    for(std::size_t i = 0; i != _group->size(); ++i)
+        if((*_group)[i]._hasBoundingBox) _drawables[_boundedCount++] = &(*_group)[i];
+    for(std::size_t i = 0, unbounded = _boundedCount; i != _group->size(); ++i)
+        if(!(*_group)[i]._hasBoundingBox) _drawables[unbounded++] = &(*_group)[i];
+
+    _centers = Containers::Array<VectorTypeFor<dimensions, T>>{Containers::NoInit, _boundedCount};
+    _extents = Containers::Array<VectorTypeFor<dimensions, T>>{Containers::NoInit, _boundedCount};
+    for(std::size_t i = 0; i != _boundedCount; ++i) {
+        Drawable<dimensions, T>& drawable = *_drawables[i];
+        _centers[i] = drawable._absoluteBoundingBox.center();
+        _extents[i] = drawable._absoluteBoundingBox.size()/T(2);
+        drawable._absoluteBoundingBoxChanged = false;
+    }
+
+    /* Build the tree on a permutation and then reorder the drawables and
+       boxes to leaf order so each leaf is a contiguous range */
+    arrayResize(_nodes, 0);
+    if(_boundedCount) {
+        Containers::Array<UnsignedInt> order{Containers::NoInit, _boundedCount};
+        for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+        build(order, 0, _boundedCount);
+
+        Containers::Array<Drawable<dimensions, T>*> drawables{Containers::NoInit, _drawables.size()};
+        Containers::Array<VectorTypeFor<dimensions, T>> centers{Containers::NoInit, _boundedCount};
+        Containers::Array<VectorTypeFor<dimensions, T>> extents{Containers::NoInit, _boundedCount};
+        for(std::size_t i = 0; i != _boundedCount; ++i) {
+            drawables[i] = _drawables[order[i]];
+            centers[i] = _centers[order[i]];
+            extents[i] = _extents[order[i]];
+        }
+        for(std::size_t i = _boundedCount; i != _drawables.size(); ++i)
+            drawables[i] = _drawables[i];
+        _drawables = std::move(drawables);
+        _centers = std::move(centers);
+        _extents = std::move(extents);
+    }
+
+    if(_visible.size() != _drawables.size())
+        _visible = Containers::Array<Drawable<dimensions, T>*>{Containers::NoInit, _drawables.size()};
+    if(_indices.size() != _leafSize)
+        _indices = Containers::Array<UnsignedInt>{Containers::NoInit, _leafSize};
+}
+
+template<UnsignedInt dimensions, class T> UnsignedInt DrawableBvh<dimensions, T>::build(const Containers::ArrayView<UnsignedInt> order, const UnsignedInt begin, const UnsignedInt end) {
+    /* Bounds of the boxes and of their centers */
+    Math::Range<dimensions, T> bounds{_centers[order[begin]] - _extents[order[begin]], _centers[order[begin]] + _extents[order[begin]]};
+    Math::Range<dimensions, T> centerBounds{_centers[order[begin]], _centers[order[begin]]};
+    for(UnsignedInt i = begin + 1; i != end; ++i) {
+        const VectorTypeFor<dimensions, T>& center = _centers[order[i]];
+        const VectorTypeFor<dimensions, T>& extents = _extents[order[i]];
+        bounds = Math::join(bounds, Math::Range<dimensions, T>{center - extents, center + extents});
+        centerBounds = Math::join(centerBounds, Math::Range<dimensions, T>{center, center});
+    }
+
+    /* Can't hold a reference as the array may get reallocated in the
+       recursive calls */
+    const UnsignedInt id = _nodes.size();
+    arrayAppend(_nodes, Node{bounds, begin, end, 0});
+    if(end - begin <= _leafSize) return id;
+
+    /* Split at the median along the axis where the centers are spread the
+       most */
+    const VectorTypeFor<dimensions, T> size = centerBounds.size();
+    UnsignedInt axis = 0;
+    for(UnsignedInt i = 1; i != dimensions; ++i)
+        if(size[i] > size[axis]) axis = i;
+    const UnsignedInt middle = begin + (end - begin)/2;
+    std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [this, axis](UnsignedInt a, UnsignedInt b) {
+        return _centers[a][axis] < _centers[b][axis];
+    });
+
+    build(order, begin, middle);
+    const UnsignedInt second = build(order, middle, end);
+    _nodes[id].second = second;
+    return id;
+}
+
+template<UnsignedInt dimensions, class T> void DrawableBvh<dimensions, T>::refit() {
+    /* Going backwards, so children are always refit before their parent */
+    for(std::size_t i = _nodes.size(); i != 0; --i) {
+        Node& node = _nodes[i - 1];
+        if(node.second) {
+            node.bounds = Math::join(_nodes[i].bounds, _nodes[node.second].bounds);
+            continue;
+        }
+
+        node.bounds = {_centers[node.begin] - _extents[node.begin], _centers[node.begin] + _extents[node.begin]};
+        for(UnsignedInt j = node.begin + 1; j != node.end; ++j)
+            node.bounds = Math::join(node.bounds, Math::Range<dimensions, T>{_centers[j] - _extents[j], _centers[j] + _extents[j]});
+    }
+}
+
+template<UnsignedInt dimensions, class T> std::size_t DrawableBvh<dimensions, T>::update() {
+    if(_group->size() != _drawables.size()) {
+        rebuild();
+        return _boundedCount;
+    }
+
+    cleanDirty();
+
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _boundedCount; ++i) {
+        Drawable<dimensions, T>& drawable = *_drawables[i];
+        if(!drawable._absoluteBoundingBoxChanged) continue;
+
+        _centers[i] = drawable._absoluteBoundingBox.center();
+        _extents[i] = drawable._absoluteBoundingBox.size()/T(2);
+        drawable._absoluteBoundingBoxChanged = false;
+        ++count;
+    }
+
+    if(count) refit();
+    return count;
+}
+
+template<UnsignedInt dimensions, class T> Containers::ArrayView<Drawable<dimensions, T>*> DrawableBvh<dimensions, T>::cull(const MatrixTypeFor<dimensions, T>& transformationProjectionMatrix) {
+    const Implementation::DrawableBvhPlanes<dimensions, T> planes{transformationProjectionMatrix};
+
+    std::size_t count = 0;
+    if(!_nodes.empty()) {
+        /* The tree is split at the median, so its depth is at most 32 and the
+           stack never holds more than one node per level plus one */
+        UnsignedInt stack[64];
+        std::size_t stackSize = 0;
+        stack[stackSize++] = 0;
+        while(stackSize) {
+            const UnsignedInt id = stack[--stackSize];
+            const Node& node = _nodes[id];
+            if(!planes.box(node.bounds.center(), node.bounds.size()/T(2)))
+                continue;
+
+            /* Push the second child first so the leaves are visited in
+               order */
+            if(node.second) {
+                CORRADE_INTERNAL_ASSERT(stackSize + 2 <= Containers::arraySize(stack));
+                stack[stackSize++] = node.second;
+                stack[stackSize++] = id + 1;
+                continue;
+            }
+
+            const std::size_t visibleCount = planes.boxesIndicesInto(
+                _centers.slice(node.begin, node.end),
+                _extents.slice(node.begin, node.end), _indices);
+            for(std::size_t i = 0; i != visibleCount; ++i)
+                _visible[count++] = _drawables[node.begin + _indices[i]];
+        }
+    }
+
+    for(std::size_t i = _boundedCount; i != _drawables.size(); ++i)
+        _visible[count++] = _drawables[i];
+
+    return _visible.prefix(count);
+}
+
+}}
+
+#endif
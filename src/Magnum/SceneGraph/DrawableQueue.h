@@ -0,0 +1,274 @@
+#ifndef Magnum_SceneGraph_DrawableQueue_h
+#define Magnum_SceneGraph_DrawableQueue_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::DrawableQueue, enum @ref Magnum::SceneGraph::DepthOrder, function @ref Magnum::SceneGraph::drawableSortKey(), alias @ref Magnum::SceneGraph::BasicDrawableQueue2D, @ref Magnum::SceneGraph::BasicDrawableQueue3D, typedef @ref Magnum::SceneGraph::DrawableQueue2D, @ref Magnum::SceneGraph::DrawableQueue3D
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+#include "Magnum/SceneGraph/visibility.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Depth order of drawables in a queue
+@m_since_latest
+
+@see @ref DrawableQueue::setDepthOrder()
+*/
+enum class DepthOrder: UnsignedByte {
+    /** Depth is ignored, drawables are sorted only by the sort key */
+    None,
+
+    /**
+     * Drawables with the same sort key are sorted front to back, which is
+     * useful for opaque objects to minimize overdraw.
+     */
+    FrontToBack,
+
+    /**
+     * Drawables with the same sort key are sorted back to front, which is
+     * needed for correct blending of transparent objects.
+     */
+    BackToFront
+};
+
+/**
+@brief Compose a drawable sort key
+@m_since_latest
+
+Puts @p shader into the upper 16 bits, followed by @p material and @p mesh,
+leaving the lowest 16 bits for the depth calculated by @ref DrawableQueue. The
+drawables are thus sorted primarily by the shader, as that's usually the most
+expensive state change, then by the material and lastly by the mesh.
+@see @ref Drawable::setSortKey()
+*/
+constexpr UnsignedLong drawableSortKey(UnsignedShort shader, UnsignedShort material, UnsignedShort mesh) {
+    return (UnsignedLong(shader) << 48)|(UnsignedLong(material) << 32)|(UnsignedLong(mesh) << 16);
+}
+
+/**
+@brief Drawable queue
+@m_since_latest
+
+Collects drawables together with their camera-relative transformations,
+sorts them to minimize state changes and draws them in batches. Each frame the
+queue is cleared, filled from one or more drawable groups with @ref add(),
+sorted with @ref sort() and then submitted with @ref draw():
+
+@snippet MagnumSceneGraph.cpp DrawableQueue-usage
+
+@section SceneGraph-DrawableQueue-sorting Sorting
+
+The sort key of each drawable is its @ref Drawable::sortKey() with the lowest
+16 bits replaced with a quantized distance from the camera, depending on
+@ref depthOrder(). The keys are sorted with a stable LSD radix sort, skipping
+bytes that are the same for all keys, so the cost is linear in the count of
+drawables. Drawables with equal keys stay in the order they were added in.
+
+@section SceneGraph-DrawableQueue-batching Batching
+
+When drawing, consecutive drawables that have the same state part of the key
+--- the upper 48 bits --- are submitted together to
+@ref Drawable::drawBatch() of the first of them, which can draw them all at
+once, for example as a single instanced draw. See
+@ref SceneGraph-Drawable-sorting for an example.
+
+@section SceneGraph-DrawableQueue-explicit-specializations Explicit template specializations
+
+The following specializations are explicitly compiled into @ref SceneGraph
+library. For other specializations (e.g. using @ref Magnum::Double "Double"
+type) you have to use @ref DrawableQueue.hpp implementation file to avoid
+linker errors. See also @ref compilation-speedup-hpp for more information.
+
+-   @ref DrawableQueue2D
+-   @ref DrawableQueue3D
+
+@see @ref BasicDrawableQueue2D, @ref BasicDrawableQueue3D
+*/
+template<UnsignedInt dimensions, class T> class DrawableQueue {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The queue is initially empty.
+         */
+        explicit DrawableQueue(DepthOrder depthOrder = DepthOrder::FrontToBack);
+
+        /** @brief Depth order */
+        DepthOrder depthOrder() const { return _depthOrder; }
+
+        /**
+         * @brief Set depth order
+         * @return Reference to self (for method chaining)
+         *
+         * Affects only drawables added after this call. In 2D the depth is
+         * always zero, so the order has no effect.
+         */
+        DrawableQueue<dimensions, T>& setDepthOrder(DepthOrder order) {
+            _depthOrder = order;
+            return *this;
+        }
+
+        /** @brief Count of drawables in the queue */
+        std::size_t size() const { return _drawables.size(); }
+
+        /** @brief Whether the queue is empty */
+        bool isEmpty() const { return _drawables.empty(); }
+
+        /** @brief Drawables */
+        Containers::ArrayView<Drawable<dimensions, T>* const> drawables() const { return _drawables; }
+
+        /** @brief Drawable transformations relative to the camera */
+        Containers::ArrayView<const MatrixTypeFor<dimensions, T>> transformationMatrices() const { return _transformationMatrices; }
+
+        /** @brief Sort keys including the depth */
+        Containers::ArrayView<const UnsignedLong> keys() const { return _keys; }
+
+        /**
+         * @brief Add a drawable group
+         * @return Reference to self (for method chaining)
+         *
+         * Calculates transformations of all drawables in @p group relative
+         * to @p camera and appends them to the queue together with their
+         * sort keys.
+         * @see @ref Camera::drawableTransformations()
+         */
+        DrawableQueue<dimensions, T>& add(Camera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group);
+
+        /**
+         * @brief Add drawables intersecting the camera frustum
+         * @return Reference to self (for method chaining)
+         *
+         * Updates @p bvh, culls it with @ref DrawableBvh::cull() against the
+         * frustum of @p camera and appends just the drawables that weren't
+         * culled. See @ref Camera::draw(DrawableBvh<dimensions, T>&) for more
+         * information.
+         */
+        DrawableQueue<dimensions, T>& add(Camera<dimensions, T>& camera, DrawableBvh<dimensions, T>& bvh);
+
+        /**
+         * @brief Add a single drawable
+         * @param drawable              Drawable
+         * @param transformationMatrix  Object transformation relative to the
+         *      camera
+         * @return Reference to self (for method chaining)
+         *
+         * Calculates the sort key from @ref Drawable::sortKey() and depth of
+         * @p transformationMatrix.
+         */
+        DrawableQueue<dimensions, T>& add(Drawable<dimensions, T>& drawable, const MatrixTypeFor<dimensions, T>& transformationMatrix);
+
+        /**
+         * @brief Sort the queue
+         *
+         * Stable, so drawables with equal keys stay in the order they were
+         * added in. Reuses the allocated memory.
+         */
+        void sort();
+
+        /**
+         * @brief Draw the queue
+         * @return Count of batches drawn
+         *
+         * Calls @ref Drawable::drawBatch() for each run of consecutive
+         * drawables with the same state part of the sort key, in the
+         * current order of the queue. The queue is not cleared afterwards.
+         */
+        std::size_t draw(Camera<dimensions, T>& camera);
+
+        /**
+         * @brief Clear the queue
+         *
+         * The allocated memory is kept for the next frame.
+         */
+        void clear();
+
+    private:
+        DepthOrder _depthOrder;
+        Containers::Array<Drawable<dimensions, T>*> _drawables;
+        Containers::Array<MatrixTypeFor<dimensions, T>> _transformationMatrices;
+        Containers::Array<UnsignedLong> _keys;
+        /* Scratch memory for sorting */
+        Containers::Array<UnsignedInt> _indices, _indicesScratch;
+        Containers::Array<UnsignedLong> _keysScratch;
+        Containers::Array<Drawable<dimensions, T>*> _drawablesScratch;
+        Containers::Array<MatrixTypeFor<dimensions, T>> _transformationMatricesScratch;
+};
+
+/**
+@brief Drawable queue for two-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp DrawableQueue<2, T> @ce. See
+@ref DrawableQueue for more information.
+@see @ref DrawableQueue2D, @ref BasicDrawableQueue3D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawableQueue2D = DrawableQueue<2, T>;
+#endif
+
+/**
+@brief Drawable queue for two-dimensional float scenes
+@m_since_latest
+
+@see @ref DrawableQueue3D
+*/
+typedef BasicDrawableQueue2D<Float> DrawableQueue2D;
+
+/**
+@brief Drawable queue for three-dimensional scenes
+@m_since_latest
+
+Convenience alternative to @cpp DrawableQueue<3, T> @ce. See
+@ref DrawableQueue for more information.
+@see @ref DrawableQueue3D, @ref BasicDrawableQueue2D
+*/
+#ifndef CORRADE_MSVC2015_COMPATIBILITY /* Multiple definitions still broken */
+template<class T> using BasicDrawableQueue3D = DrawableQueue<3, T>;
+#endif
+
+/**
+@brief Drawable queue for three-dimensional float scenes
+@m_since_latest
+
+@see @ref DrawableQueue2D
+*/
+typedef BasicDrawableQueue3D<Float> DrawableQueue3D;
+
+#if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableQueue<2, Float>;
+extern template class MAGNUM_SCENEGRAPH_EXPORT DrawableQueue<3, Float>;
+#endif
+
+}}
+
+#endif
@@ -0,0 +1,195 @@
+#ifndef Magnum_SceneGraph_DrawableQueue_hpp
+#define Magnum_SceneGraph_DrawableQueue_hpp
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief @ref compilation-speedup-hpp "Template implementation" for @ref DrawableQueue.h
+ * @m_since_latest
+ */
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
+#include "Magnum/SceneGraph/DrawableQueue.h"
+
+namespace Magnum { namespace SceneGraph {
+
+namespace Implementation {
+
+/* Quantized distance from the camera, there's no depth in 2D */
+template<UnsignedInt dimensions, class T> struct DrawableQueueDepth {
+    static UnsignedShort depth(const MatrixTypeFor<dimensions, T>&) { return 0; }
+};
+template<class T> struct DrawableQueueDepth<3, T> {
+    static UnsignedShort depth(const Math::Matrix4<T>& transformationMatrix) {
+        /* The camera looks along -Z, objects behind it are at zero distance.
+           Bits of a non-negative float are monotonic with its value, so the
+           upper 16 bits (exponent and 7 bits of mantissa) give a logarithmic
+           quantization without having to know the depth range. */
+        const Float distance = Math::max(Float(-transformationMatrix.translation().z()), 0.0f);
+        UnsignedInt bits;
+        std::memcpy(&bits, &distance, sizeof(Float));
+        return bits >> 16;
+    }
+};
+
+}
+
+template<UnsignedInt dimensions, class T> DrawableQueue<dimensions, T>::DrawableQueue(const DepthOrder depthOrder): _depthOrder{depthOrder} {}
+
+template<UnsignedInt dimensions, class T> DrawableQueue<dimensions, T>& DrawableQueue<dimensions, T>::add(Drawable<dimensions, T>& drawable, const MatrixTypeFor<dimensions, T>& transformationMatrix) {
+    UnsignedShort depth = 0;
+    if(_depthOrder == DepthOrder::FrontToBack)
+        depth = Implementation::DrawableQueueDepth<dimensions, T>::depth(transformationMatrix);
+    else if(_depthOrder == DepthOrder::BackToFront)
+        depth = 0xffff - Implementation::DrawableQueueDepth<dimensions, T>::depth(transformationMatrix);
+
+    arrayAppend(_drawables, &drawable);
+    arrayAppend(_transformationMatrices, transformationMatrix);
+    arrayAppend(_keys, (drawable.sortKey() & ~UnsignedLong{0xffff})|depth);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> DrawableQueue<dimensions, T>& DrawableQueue<dimensions, T>::add(Camera<dimensions, T>& camera, DrawableGroup<dimensions, T>& group) {
+    for(auto&& drawableTransformation: camera.drawableTransformations(group))
+        add(drawableTransformation.first.get(), drawableTransformation.second);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> DrawableQueue<dimensions, T>& DrawableQueue<dimensions, T>::add(Camera<dimensions, T>& camera, DrawableBvh<dimensions, T>& bvh) {
+    AbstractObject<dimensions, T>* scene = camera.object().scene();
+    CORRADE_ASSERT(scene, "SceneGraph::DrawableQueue::add(): camera is not part of any scene", *this);
+
+    /* Compute camera matrix */
+    camera.object().setClean();
+
+    /* Update world-space bounds of moved drawables and cull them */
+    bvh.update();
+    const Containers::ArrayView<Drawable<dimensions, T>*> visible = bvh.cull(camera.projectionMatrix()*camera.cameraMatrix());
+
+    /* Compute transformations of only the visible objects relative to the
+       camera */
+    std::vector<std::reference_wrapper<AbstractObject<dimensions, T>>> objects;
+    objects.reserve(visible.size());
+    for(Drawable<dimensions, T>* drawable: visible)
+        objects.push_back(drawable->object());
+    std::vector<MatrixTypeFor<dimensions, T>> transformations =
+        scene->transformationMatrices(objects, camera.cameraMatrix(), camera.threadCount());
+
+    for(std::size_t i = 0; i != transformations.size(); ++i)
+        add(*visible[i], transformations[i]);
+    return *this;
+}
+
+template<UnsignedInt dimensions, class T> void DrawableQueue<dimensions, T>::sort() {
+    const std::size_t size = _keys.size();
+    if(size < 2) return;
+
+    /* Histograms of all eight bytes of the keys, calculated in a single
+       pass */
+    UnsignedInt histograms[8][256]{};
+    for(const UnsignedLong key: _keys)
+        for(std::size_t byte = 0; byte != 8; ++byte)
+            ++histograms[byte][(key >> 8*byte) & 0xff];
+
+    arrayResize(_indices, Containers::NoInit, size);
+    arrayResize(_indicesScratch, Containers::NoInit, size);
+    arrayResize(_keysScratch, Containers::NoInit, size);
+    for(std::size_t i = 0; i != size; ++i) _indices[i] = i;
+
+    /* LSD radix sort, which is stable, ping-ponging between the two key and
+       index arrays. Bytes that are the same in all keys (such as unused bits
+       of the shader, material or mesh IDs) are skipped. */
+    Containers::ArrayView<UnsignedLong> keys = _keys;
+    Containers::ArrayView<UnsignedLong> keysOut = _keysScratch;
+    Containers::ArrayView<UnsignedInt> indices = _indices;
+    Containers::ArrayView<UnsignedInt> indicesOut = _indicesScratch;
+    for(std::size_t byte = 0; byte != 8; ++byte) {
+        UnsignedInt* const histogram = histograms[byte];
+        if(histogram[(keys[0] >> 8*byte) & 0xff] == size) continue;
+
+        /* Turn the counts into output offsets */
+        UnsignedInt offset = 0;
+        for(std::size_t i = 0; i != 256; ++i) {
+            const UnsignedInt count = histogram[i];
+            histogram[i] = offset;
+            offset += count;
+        }
+
+        for(std::size_t i = 0; i != size; ++i) {
+            const UnsignedInt out = histogram[(keys[i] >> 8*byte) & 0xff]++;
+            keysOut[out] = keys[i];
+            indicesOut[out] = indices[i];
+        }
+
+        std::swap(keys, keysOut);
+        std::swap(indices, indicesOut);
+    }
+
+    /* Make the sorted keys the actual keys, if they ended up in the scratch
+       array */
+    if(keys.data() != _keys.data()) std::swap(_keys, _keysScratch);
+
+    /* Reorder the drawables and transformations */
+    arrayResize(_drawablesScratch, Containers::NoInit, size);
+    arrayResize(_transformationMatricesScratch, size);
+    for(std::size_t i = 0; i != size; ++i) {
+        _drawablesScratch[i] = _drawables[indices[i]];
+        _transformationMatricesScratch[i] = _transformationMatrices[indices[i]];
+    }
+    std::swap(_drawables, _drawablesScratch);
+    std::swap(_transformationMatrices, _transformationMatricesScratch);
+}
+
+template<UnsignedInt dimensions, class T> std::size_t DrawableQueue<dimensions, T>::draw(Camera<dimensions, T>& camera) {
+    std::size_t batchCount = 0;
+    for(std::size_t begin = 0, end; begin != _drawables.size(); begin = end) {
+        /* Find the run of drawables with the same state, ignoring depth */
+        const UnsignedLong state = _keys[begin] & ~UnsignedLong{0xffff};
+        for(end = begin + 1; end != _drawables.size() && (_keys[end] & ~UnsignedLong{0xffff}) == state; ++end);
+
+        _drawables[begin]->drawBatch(_drawables.slice(begin, end), _transformationMatrices.slice(begin, end), camera);
+        ++batchCount;
+    }
+
+    return batchCount;
+}
+
+template<UnsignedInt dimensions, class T> void DrawableQueue<dimensions, T>::clear() {
+    arrayResize(_drawables, 0);
+    arrayResize(_transformationMatrices, 0);
+    arrayResize(_keys, 0);
+}
+
+}}
+
+#endif
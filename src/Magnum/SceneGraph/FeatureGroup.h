@@ -29,7 +29,9 @@
  * @brief Class @ref Magnum::SceneGraph::AbstractFeatureGroup, @ref Magnum::SceneGraph::FeatureGroup, alias @ref Magnum::SceneGraph::BasicFeatureGroup2D, @ref Magnum::SceneGraph::BasicFeatureGroup3D, @ref Magnum::SceneGraph::FeatureGroup2D, @ref Magnum::SceneGraph::FeatureGroup3D
  */
 
+#include <initializer_list>
 #include <vector>
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Utility/Assert.h>
 
 #include "Magnum/SceneGraph/SceneGraph.h"
@@ -65,7 +67,8 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
         virtual ~AbstractFeatureGroup();
 
         void add(AbstractFeature<dimensions, T>& feature);
-        void remove(AbstractFeature<dimensions, T>& feature);
+        /* Replaces the feature with the last one */
+        void remove(std::size_t index);
 
         std::vector<std::reference_wrapper<AbstractFeature<dimensions, T>>> _features;
 };
@@ -74,6 +77,17 @@ template<UnsignedInt dimensions, class T> class AbstractFeatureGroup {
 @brief Group of features
 
 See @ref AbstractGroupedFeature for more information.
+
+@section SceneGraph-FeatureGroup-removal Feature removal
+
+Each feature remembers its position in the group, so removing a feature with
+@ref remove(Feature&) is done in constant time by moving the last feature of
+the group in its place. Because of that, the order of remaining features isn't
+preserved. When removing many features at once, for example when unloading a
+part of a scene, it's better to use @ref remove(Containers::ArrayView<const std::reference_wrapper<Feature>>)
+or @ref clear(), which go through the group just once and keep the relative
+order of the remaining features.
+
 @see @ref scenegraph, @ref BasicFeatureGroup2D, @ref BasicFeatureGroup3D,
     @ref FeatureGroup2D, @ref FeatureGroup3D
 */
@@ -119,14 +133,63 @@ template<UnsignedInt dimensions, class Feature, class T> class FeatureGroup: pub
          */
         FeatureGroup<dimensions, Feature, T>& add(Feature& feature);
 
+        /**
+         * @brief Add features to the group
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref add(Feature&) for each feature in
+         * @p features, but allocates just once.
+         */
+        FeatureGroup<dimensions, Feature, T>& add(Containers::ArrayView<const std::reference_wrapper<Feature>> features);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FeatureGroup<dimensions, Feature, T>& add(std::initializer_list<std::reference_wrapper<Feature>> features) {
+            return add(Containers::arrayView(features));
+        }
+
         /**
          * @brief Remove a feature from the group
          * @return Reference to self (for method chaining)
          *
-         * The feature must be part of the group.
+         * The feature must be part of the group. Done in constant time by
+         * moving the last feature in place of the removed one. See
+         * @ref SceneGraph-FeatureGroup-removal for more information.
          * @see @ref add()
          */
         FeatureGroup<dimensions, Feature, T>& remove(Feature& feature);
+
+        /**
+         * @brief Remove features from the group
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * All features are expected to be part of the group, each listed
+         * just once. Goes through the group just once, preserving the
+         * relative order of the remaining features. See
+         * @ref SceneGraph-FeatureGroup-removal for more information.
+         */
+        FeatureGroup<dimensions, Feature, T>& remove(Containers::ArrayView<const std::reference_wrapper<Feature>> features);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        FeatureGroup<dimensions, Feature, T>& remove(std::initializer_list<std::reference_wrapper<Feature>> features) {
+            return remove(Containers::arrayView(features));
+        }
+
+        /**
+         * @brief Remove all features from the group
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * The features aren't deleted.
+         */
+        FeatureGroup<dimensions, Feature, T>& clear();
 };
 
 /**
@@ -183,20 +246,66 @@ template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions
         feature._group->remove(feature);
 
     /* Crossreference the feature and group together */
+    feature._groupIndex = AbstractFeatureGroup<dimensions, T>::_features.size();
     AbstractFeatureGroup<dimensions, T>::add(feature);
     feature._group = this;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::add(Containers::ArrayView<const std::reference_wrapper<Feature>> features) {
+    AbstractFeatureGroup<dimensions, T>::_features.reserve(AbstractFeatureGroup<dimensions, T>::_features.size() + features.size());
+    for(Feature& feature: features) add(feature);
+    return *this;
+}
+
 template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(Feature& feature) {
     CORRADE_ASSERT(feature._group == this,
         "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
 
-    AbstractFeatureGroup<dimensions, T>::remove(feature);
+    /* Update index of the feature that got moved in place of the removed
+       one */
+    const std::size_t index = feature._groupIndex;
+    AbstractFeatureGroup<dimensions, T>::remove(index);
+    if(index < AbstractFeatureGroup<dimensions, T>::_features.size())
+        static_cast<Feature&>(AbstractFeatureGroup<dimensions, T>::_features[index].get())._groupIndex = index;
     feature._group = nullptr;
     return *this;
 }
 
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::remove(Containers::ArrayView<const std::reference_wrapper<Feature>> features) {
+    #ifndef CORRADE_NO_ASSERT
+    for(Feature& feature: features)
+        CORRADE_ASSERT(feature._group == this,
+            "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group", *this);
+    #endif
+
+    /* Mark the features as removed */
+    for(Feature& feature: features) {
+        CORRADE_ASSERT(feature._group,
+            "SceneGraph::AbstractFeatureGroup::remove(): feature listed more than once", *this);
+        feature._group = nullptr;
+    }
+
+    /* Move the remaining features to the front, keeping their order */
+    std::vector<std::reference_wrapper<AbstractFeature<dimensions, T>>>& groupFeatures = AbstractFeatureGroup<dimensions, T>::_features;
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != groupFeatures.size(); ++i) {
+        Feature& feature = static_cast<Feature&>(groupFeatures[i].get());
+        if(!feature._group) continue;
+
+        feature._groupIndex = count;
+        groupFeatures[count++] = feature;
+    }
+    groupFeatures.erase(groupFeatures.begin() + count, groupFeatures.end());
+    return *this;
+}
+
+template<UnsignedInt dimensions, class Feature, class T> FeatureGroup<dimensions, Feature, T>& FeatureGroup<dimensions, Feature, T>::clear() {
+    for(auto i: AbstractFeatureGroup<dimensions, T>::_features) static_cast<Feature&>(i.get())._group = nullptr;
+    AbstractFeatureGroup<dimensions, T>::_features.clear();
+    return *this;
+}
+
 #if defined(CORRADE_TARGET_WINDOWS) && !(defined(CORRADE_TARGET_MINGW) && !defined(CORRADE_TARGET_CLANG))
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<2, Float>;
 extern template class MAGNUM_SCENEGRAPH_EXPORT AbstractFeatureGroup<3, Float>;
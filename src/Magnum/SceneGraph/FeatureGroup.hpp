@@ -29,8 +29,6 @@
  * @brief @ref compilation-speedup-hpp "Template implementation" for @ref FeatureGroup.h
  */
 
-#include <algorithm>
-
 #include "Magnum/SceneGraph/FeatureGroup.h"
 
 namespace Magnum { namespace SceneGraph {
@@ -42,9 +40,9 @@ template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions,
     _features.push_back(feature);
 }
 
-template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::remove(AbstractFeature<dimensions, T>& feature) {
-    _features.erase(std::find_if(_features.begin(), _features.end(),
-        [&feature](AbstractFeature<dimensions, T>& f) { return &f == &feature; }));
+template<UnsignedInt dimensions, class T> void AbstractFeatureGroup<dimensions, T>::remove(const std::size_t index) {
+    _features[index] = _features.back();
+    _features.pop_back();
 }
 
 }}
@@ -0,0 +1,225 @@
+#ifndef Magnum_SceneGraph_FlattenedScene_h
+#define Magnum_SceneGraph_FlattenedScene_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::FlattenedScene
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/Object.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Flattened scene
+@m_since_latest
+
+An optional acceleration structure for updating absolute transformations of
+large scenes. Objects of a @ref Scene are stored in a breadth-first order in
+contiguous arrays together with indices of their parents and their absolute
+transformations. Because every parent is stored before its children,
+@ref update() cleans all dirty objects in a single linear sweep, composing
+each dirty object transformation with the already computed absolute
+transformation of its parent. That's in contrast to @ref Object::setClean(),
+which walks the parent pointers of each object and allocates temporary lists
+on every call.
+
+The objects stay owned by the scene and their API is unchanged ---
+@ref Object::transformationMatrix(), @ref Object::setDirty() or feature
+caching work the same way as without a flattened scene. Only the topology is
+snapshotted, so the flattened scene has to be rebuilt with @ref rebuild()
+after objects are added, removed or reparented:
+
+@snippet MagnumSceneGraph.cpp FlattenedScene-usage
+
+The cached absolute transformations of clean objects are assumed to stay
+valid between calls to @ref update(). Thus, while a flattened scene is in use,
+dirty objects are expected to be cleaned only through @ref update() and not
+through @ref Object::setClean() or @ref Camera::draw(). Calling @ref update()
+before drawing is enough, as the camera then doesn't find any dirty objects.
+@see @ref scenegraph-features-caching
+*/
+template<class Transformation> class FlattenedScene {
+    public:
+        /** @brief Matrix type */
+        typedef typename Object<Transformation>::MatrixType MatrixType;
+
+        /**
+         * @brief Constructor
+         *
+         * Flattens the hierarchy of @p scene and calculates absolute
+         * transformations of all objects, cleaning dirty objects in the
+         * process. The @p scene is expected to stay alive for the whole
+         * lifetime of the flattened scene.
+         * @see @ref rebuild()
+         */
+        explicit FlattenedScene(Scene<Transformation>& scene): _scene(&scene) {
+            rebuild();
+        }
+
+        /** @brief Scene */
+        Scene<Transformation>& scene() { return *_scene; }
+        const Scene<Transformation>& scene() const { return *_scene; } /**< @overload */
+
+        /**
+         * @brief Object count
+         *
+         * Including the scene itself, which is always at index @cpp 0 @ce.
+         */
+        std::size_t size() const { return _objects.size(); }
+
+        /**
+         * @brief Object at given index
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        Object<Transformation>& object(std::size_t id) {
+            CORRADE_ASSERT(id < _objects.size(),
+                "SceneGraph::FlattenedScene::object(): index" << id << "out of range for" << _objects.size() << "objects", *_objects[0]);
+            return *_objects[id];
+        }
+
+        /**
+         * @brief Parent index of an object at given index
+         *
+         * Always less than @p id, except for the scene at index
+         * @cpp 0 @ce, for which @cpp 0xffffffffu @ce is returned. Expects
+         * that @p id is less than @ref size().
+         */
+        UnsignedInt parent(std::size_t id) const {
+            CORRADE_ASSERT(id < _objects.size(),
+                "SceneGraph::FlattenedScene::parent(): index" << id << "out of range for" << _objects.size() << "objects", {});
+            return _parents[id];
+        }
+
+        /**
+         * @brief Absolute transformation of an object at given index
+         *
+         * Valid as of the last call to @ref update() or @ref rebuild().
+         * Expects that @p id is less than @ref size().
+         * @see @ref Object::absoluteTransformation()
+         */
+        const typename Transformation::DataType& absoluteTransformation(std::size_t id) const {
+            CORRADE_ASSERT(id < _objects.size(),
+                "SceneGraph::FlattenedScene::absoluteTransformation(): index" << id << "out of range for" << _objects.size() << "objects", _absoluteTransformations[0]);
+            return _absoluteTransformations[id];
+        }
+
+        /**
+         * @brief Absolute transformation matrix of an object at given index
+         *
+         * Valid as of the last call to @ref update() or @ref rebuild().
+         * Expects that @p id is less than @ref size().
+         * @see @ref Object::absoluteTransformationMatrix()
+         */
+        MatrixType absoluteTransformationMatrix(std::size_t id) const {
+            return Implementation::Transformation<Transformation>::toMatrix(absoluteTransformation(id));
+        }
+
+        /**
+         * @brief Rebuild the flattened hierarchy
+         *
+         * Has to be called after objects are added to or removed from the
+         * scene or reparented. Recalculates absolute transformations of all
+         * objects and cleans the dirty ones. The allocated memory is reused.
+         */
+        void rebuild();
+
+        /**
+         * @brief Update dirty objects
+         * @return Count of objects that were cleaned
+         *
+         * Goes linearly through all objects and for each dirty object
+         * composes its transformation with the absolute transformation of its
+         * parent and cleans it, calling @ref AbstractFeature::clean() and/or
+         * @ref AbstractFeature::cleanInverted() on its features. As marking
+         * an object dirty marks its whole subtree dirty, only the dirty
+         * subtrees are recalculated. Doesn't allocate.
+         * @see @ref Object::isDirty(), @ref Object::setClean()
+         */
+        std::size_t update();
+
+    private:
+        Scene<Transformation>* _scene;
+        /* Breadth-first order, the scene is always first */
+        Containers::Array<Object<Transformation>*> _objects;
+        Containers::Array<UnsignedInt> _parents;
+        Containers::Array<typename Transformation::DataType> _absoluteTransformations;
+};
+
+template<class Transformation> void FlattenedScene<Transformation>::rebuild() {
+    arrayResize(_objects, 0);
+    arrayResize(_parents, 0);
+
+    /* The arrays themselves serve as the queue for the breadth-first
+       traversal */
+    arrayAppend(_objects, static_cast<Object<Transformation>*>(_scene));
+    arrayAppend(_parents, ~UnsignedInt{});
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        for(Object<Transformation>& child: _objects[i]->children()) {
+            arrayAppend(_objects, &child);
+            arrayAppend(_parents, UnsignedInt(i));
+        }
+    }
+
+    /* Calculate all absolute transformations, as there are no cached values
+       for clean objects yet */
+    arrayResize(_absoluteTransformations, _objects.size());
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        Object<Transformation>& object = *_objects[i];
+        _absoluteTransformations[i] = i ?
+            Implementation::Transformation<Transformation>::compose(_absoluteTransformations[_parents[i]], object.transformation()) :
+            object.transformation();
+        if(object.isDirty()) object.setCleanInternal(_absoluteTransformations[i]);
+    }
+}
+
+template<class Transformation> std::size_t FlattenedScene<Transformation>::update() {
+    std::size_t count = 0;
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        Object<Transformation>& object = *_objects[i];
+        if(!object.isDirty()) continue;
+
+        /* A dirty object either has a dirty parent, which was updated earlier
+           in this sweep, or a clean one with a valid cached transformation */
+        _absoluteTransformations[i] = i ?
+            Implementation::Transformation<Transformation>::compose(_absoluteTransformations[_parents[i]], object.transformation()) :
+            object.transformation();
+        object.setCleanInternal(_absoluteTransformations[i]);
+        ++count;
+    }
+
+    return count;
+}
+
+}}
+
+#endif
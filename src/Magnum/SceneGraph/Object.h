@@ -303,6 +303,81 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             #endif
             ) const;
 
+        /**
+         * @brief Transformation matrices of given set of objects relative to this object using multiple threads
+         * @m_since_latest
+         *
+         * Same as @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&) const
+         * but with the work split across @p threadCount threads. See
+         * @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&, UnsignedInt) const
+         * for more information.
+         */
+        std::vector<MatrixType> transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix, UnsignedInt threadCount) const;
+
+        /**
+         * @brief Transformations of given group of objects relative to this object using multiple threads
+         * @param objects               Objects to calculate the
+         *      transformations for
+         * @param finalTransformation   Transformation applied on the
+         *      left-most side
+         * @param threadCount           Count of threads to use. If
+         *      @cpp 0 @ce, the value of @ref std::thread::hardware_concurrency()
+         *      is used.
+         * @m_since_latest
+         *
+         * Produces the same output as @ref transformations(std::vector<std::reference_wrapper<Object<Transformation>>>, const typename Transformation::DataType&) const,
+         * independently of @p threadCount. The objects up the hierarchy are
+         * marked on the calling thread first, after which the transformation
+         * of every object in @p objects and every object where the paths
+         * from multiple objects meet is calculated relative to the nearest
+         * such ancestor, with the objects split across threads. As there's
+         * no shared state between these paths, the work doesn't need any
+         * synchronization. The relative transformations are then composed
+         * together level by level, again on multiple threads.
+         *
+         * Because the threads are spawned on every call, if there's less
+         * than about a thousand objects per thread, fewer threads are used,
+         * and for small sets of objects everything is done on the calling
+         * thread. On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds
+         * without pthreads support everything is done on the calling thread
+         * as well.
+         * @see @ref Camera::setThreadCount()
+         */
+        std::vector<typename Transformation::DataType> transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation, UnsignedInt threadCount) const;
+
+        /**
+         * @brief Calculate a joint matrix palette for skinning
+         * @param joints                Joint objects
+         * @param inverseBindMatrices   Inverse bind matrices of the joints
+         * @param finalTransformationMatrix Transformation applied on the
+         *      left-most side
+         * @param[out] out              Where to put the joint matrices
+         * @param threadCount           Count of threads to use for
+         *      calculating the joint transformations. If @cpp 0 @ce, the
+         *      value of @ref std::thread::hardware_concurrency() is used.
+         * @m_since_latest
+         *
+         * Calculates transformations of @p joints relative to this object
+         * the same way as @ref transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>&, const MatrixType&, UnsignedInt) const
+         * and multiplies each with the corresponding item of
+         * @p inverseBindMatrices in a single tight loop, writing the result
+         * to @p out without any intermediate allocation for the matrices.
+         * The output is directly usable for example with
+         * @ref Shaders::Phong::setJointMatrices() or, converted to
+         * @ref Shaders::TransformationUniform3D, in a joint uniform buffer.
+         * Pass an inverse absolute transformation of the skinned object as
+         * @p finalTransformationMatrix to get the joint matrices relative to
+         * the skinned mesh. Expects that @p inverseBindMatrices and @p out
+         * have the same size as @p joints.
+         *
+         * Calculating palettes of many skinned instances sharing the same
+         * scene at once is done by passing joints of all of them in a single
+         * call, with the per-instance offsets into @p out then used for
+         * example as @ref Shaders::PhongDrawUniform::jointOffset.
+         * @see @ref Trade::SkinData::inverseBindMatrices()
+         */
+        void jointMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& joints, Containers::ArrayView<const MatrixType> inverseBindMatrices, const MatrixType& finalTransformationMatrix, Containers::ArrayView<MatrixType> out, UnsignedInt threadCount = 1) const;
+
         /* Since 1.8.17, the original short-hand group closing doesn't work
            anymore. FFS. */
         /**
@@ -372,6 +447,8 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
         friend Containers::LinkedList<Object<Transformation>>;
         friend Containers::LinkedListItem<Object<Transformation>, Object<Transformation>>;
         #endif
+        friend FlattenedScene<Transformation>;
+        friend ObjectPool<Transformation>;
 
         Object<Transformation>* doScene() override final;
         const Object<Transformation>* doScene() const override final;
@@ -386,16 +463,18 @@ template<class Transformation> class Object: public AbstractObject<Transformatio
             return absoluteTransformationMatrix();
         }
 
-        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix) const override final;
+        std::vector<MatrixType> doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix, UnsignedInt threadCount) const override final;
 
         typename Transformation::DataType MAGNUM_SCENEGRAPH_LOCAL computeJointTransformation(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const std::size_t joint, const typename Transformation::DataType& finalTransformation) const;
+        void MAGNUM_SCENEGRAPH_LOCAL computeJointTransformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& finalTransformation, UnsignedInt threadCount) const;
 
         bool MAGNUM_SCENEGRAPH_LOCAL doIsDirty() const override final { return isDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetDirty() override final { setDirty(); }
         void MAGNUM_SCENEGRAPH_LOCAL doSetClean() override final { setClean(); }
         void doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) override final;
 
-        void MAGNUM_SCENEGRAPH_LOCAL setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
+        /* Not local as it's used by the header-only FlattenedScene */
+        void setCleanInternal(const typename Transformation::DataType& absoluteTransformation);
 
         typedef Implementation::ObjectFlag Flag;
         typedef Implementation::ObjectFlags Flags;
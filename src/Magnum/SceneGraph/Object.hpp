@@ -31,13 +31,49 @@
 
 #include <algorithm>
 #include <stack>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/SceneGraph/AbstractTransformation.h"
 #include "Magnum/SceneGraph/Object.h"
 #include "Magnum/SceneGraph/Scene.h"
 
 namespace Magnum { namespace SceneGraph {
 
+namespace Implementation {
+
+/* Equivalent to Magnum/Implementation/threads.h, which isn't installed and
+   thus can't be used from this header. With less objects per thread than this
+   the threading overhead outweighs any gains, so fewer threads are used. */
+constexpr std::size_t MinObjectsPerThread = 1024;
+
+inline UnsignedInt clampThreadCount(const UnsignedInt threadCount, const std::size_t objectCount) {
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    /* No threads available, everything is done on the calling thread */
+    static_cast<void>(threadCount);
+    static_cast<void>(objectCount);
+    return 1;
+    #else
+    /* Zero thread count means hardware concurrency */
+    const std::size_t count = threadCount ? threadCount : std::thread::hardware_concurrency();
+    return Math::max(UnsignedInt(Math::min(count, objectCount/MinObjectsPerThread)), 1u);
+    #endif
+}
+
+/* Calls f(begin, end) for a subrange of [0, count) on each of threadCount
+   threads, the first subrange is processed on the calling thread */
+template<class F> void runOnThreads(const UnsignedInt threadCount, const std::size_t count, const F& f) {
+    Containers::Array<std::thread> threads{Containers::ValueInit, threadCount - 1};
+    for(UnsignedInt i = 0; i != threads.size(); ++i)
+        threads[i] = std::thread{[&f](const std::size_t begin, const std::size_t end) { f(begin, end); }, count*(i + 1)/threadCount, count*(i + 2)/threadCount};
+    f(0, count/threadCount);
+    for(std::thread& thread: threads) thread.join();
+}
+
+}
+
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::AbstractObject() {}
 template<UnsignedInt dimensions, class T> AbstractObject<dimensions, T>::~AbstractObject() {}
 
@@ -170,17 +206,21 @@ template<class Transformation> void Object<Transformation>::setClean() {
     }
 }
 
-template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
+template<class Transformation> auto Object<Transformation>::doTransformationMatrices(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects, const MatrixType& finalTransformationMatrix, const UnsignedInt threadCount) const -> std::vector<MatrixType> {
     std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
     castObjects.reserve(objects.size());
     /** @todo Ensure this doesn't crash, somehow */
     for(auto o: objects) castObjects.push_back(static_cast<Object<Transformation>&>(o.get()));
 
-    return transformationMatrices(std::move(castObjects), finalTransformationMatrix);
+    return transformationMatrices(std::move(castObjects), finalTransformationMatrix, threadCount);
 }
 
 template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix) const -> std::vector<MatrixType> {
-    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix));
+    return transformationMatrices(objects, finalTransformationMatrix, 1);
+}
+
+template<class Transformation> auto Object<Transformation>::transformationMatrices(const std::vector<std::reference_wrapper<Object<Transformation>>>& objects, const MatrixType& finalTransformationMatrix, const UnsignedInt threadCount) const -> std::vector<MatrixType> {
+    std::vector<typename Transformation::DataType> transformations = this->transformations(std::move(objects), Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix), threadCount);
     std::vector<MatrixType> transformationMatrices(transformations.size());
     for(std::size_t i = 0; i != objects.size(); ++i)
         transformationMatrices[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i]);
@@ -188,6 +228,17 @@ template<class Transformation> auto Object<Transformation>::transformationMatric
     return transformationMatrices;
 }
 
+template<class Transformation> void Object<Transformation>::jointMatricesInto(const std::vector<std::reference_wrapper<Object<Transformation>>>& joints, const Containers::ArrayView<const MatrixType> inverseBindMatrices, const MatrixType& finalTransformationMatrix, const Containers::ArrayView<MatrixType> out, const UnsignedInt threadCount) const {
+    CORRADE_ASSERT(inverseBindMatrices.size() == joints.size(),
+        "SceneGraph::Object::jointMatricesInto(): expected" << joints.size() << "inverse bind matrices but got" << inverseBindMatrices.size(), );
+    CORRADE_ASSERT(out.size() == joints.size(),
+        "SceneGraph::Object::jointMatricesInto(): expected output view to have" << joints.size() << "items but got" << out.size(), );
+
+    const std::vector<typename Transformation::DataType> transformations = this->transformations(joints, Implementation::Transformation<Transformation>::fromMatrix(finalTransformationMatrix), threadCount);
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = Implementation::Transformation<Transformation>::toMatrix(transformations[i])*inverseBindMatrices[i];
+}
+
 /*
 Computing absolute transformations for given list of objects
 
@@ -203,6 +254,10 @@ computed and recursively concatenated together. Resulting transformations for
 joints which were originally in `object` list is then returned.
 */
 template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation) const {
+    return transformations(std::move(objects), finalTransformation, 1);
+}
+
+template<class Transformation> std::vector<typename Transformation::DataType> Object<Transformation>::transformations(std::vector<std::reference_wrapper<Object<Transformation>>> objects, const typename Transformation::DataType& finalTransformation, UnsignedInt threadCount) const {
     CORRADE_ASSERT(objects.size() < 0xFFFFu, "SceneGraph::Object::transformations(): too large scene", {});
 
     /* Remember object count for later */
@@ -272,9 +327,12 @@ template<class Transformation> std::vector<typename Transformation::DataType> Ob
     /* Array of absolute transformations in joints */
     std::vector<typename Transformation::DataType> jointTransformations(jointObjects.size());
 
-    /* Compute transformations for all joints */
-    for(std::size_t i = 0; i != jointTransformations.size(); ++i)
+    /* Compute transformations for all joints, on multiple threads if there's
+       enough of them */
+    threadCount = Implementation::clampThreadCount(threadCount, jointObjects.size());
+    if(threadCount == 1) for(std::size_t i = 0; i != jointTransformations.size(); ++i)
         computeJointTransformation(jointObjects, jointTransformations, i, finalTransformation);
+    else computeJointTransformations(jointObjects, jointTransformations, finalTransformation, threadCount);
 
     /* Copy transformation for second or next occurences from first occurence
        of duplicate object */
@@ -334,6 +392,113 @@ template<class Transformation> typename Transformation::DataType Object<Transfor
     }
 }
 
+template<class Transformation> void Object<Transformation>::computeJointTransformations(const std::vector<std::reference_wrapper<Object<Transformation>>>& jointObjects, std::vector<typename Transformation::DataType>& jointTransformations, const typename Transformation::DataType& finalTransformation, const UnsignedInt threadCount) const {
+    const std::size_t jointCount = jointObjects.size();
+
+    /* Index of parent joint for each joint, ~0 if the path ends at the root */
+    std::vector<UnsignedInt> parentJoints(jointCount, ~UnsignedInt{});
+
+    /* Compute transformations of all joints relative to their parent joint,
+       the same way as computeJointTransformation() does. Second and next
+       occurences of duplicate objects are skipped, as they're copied from the
+       first occurence after. Every non-joint object lies on a path of exactly
+       one joint so the threads clear visited marks of disjoint sets of
+       objects. Joints are however read by paths of their children, so their
+       marks are cleaned only after all threads finish. */
+    Implementation::runOnThreads(threadCount, jointCount, [&](const std::size_t begin, const std::size_t end) {
+        for(std::size_t i = begin; i != end; ++i) {
+            Object<Transformation>* o = &jointObjects[i].get();
+            if(o->counter != i) continue;
+
+            typename Transformation::DataType transformation = o->transformation();
+
+            /* Go up until next joint or root */
+            for(;;) {
+                Object<Transformation>* parent = o->parent();
+
+                /* Root object, compose transformation with final, done */
+                if(!parent) {
+                    CORRADE_INTERNAL_ASSERT(o->isScene());
+                    transformation = Implementation::Transformation<Transformation>::compose(finalTransformation, transformation);
+                    break;
+
+                /* Joint object, remember it for composing later, done */
+                } else if(parent->flags & Flag::Joint) {
+                    parentJoints[i] = parent->counter;
+                    break;
+                }
+
+                /* Else compose transformation with parent, clean its visited
+                   mark and go up the hierarchy */
+                CORRADE_INTERNAL_ASSERT(parent->flags & Flag::Visited);
+                parent->flags &= ~Flag::Visited;
+                transformation = Implementation::Transformation<Transformation>::compose(parent->transformation(), transformation);
+                o = parent;
+            }
+
+            jointTransformations[i] = transformation;
+        }
+    });
+
+    /* Clean visited marks of joints */
+    for(auto i: jointObjects) i.get().flags &= ~Flag::Visited;
+
+    /* Calculate depth of each joint in the joint hierarchy, the walk up is
+       stopped at the first joint with a known depth */
+    std::vector<UnsignedInt> depths(jointCount, ~UnsignedInt{});
+    std::vector<UnsignedInt> path;
+    UnsignedInt maxDepth = 0;
+    for(std::size_t i = 0; i != jointCount; ++i) {
+        if(jointObjects[i].get().counter != i) continue;
+
+        UnsignedInt joint = UnsignedInt(i);
+        while(depths[joint] == ~UnsignedInt{}) {
+            if(parentJoints[joint] == ~UnsignedInt{}) {
+                depths[joint] = 0;
+                break;
+            }
+
+            path.push_back(joint);
+            joint = parentJoints[joint];
+        }
+        for(; !path.empty(); path.pop_back()) {
+            depths[path.back()] = depths[joint] + 1;
+            joint = path.back();
+        }
+
+        maxDepth = Math::max(maxDepth, depths[i]);
+    }
+
+    /* Sort joints by depth, joints directly under the root are already
+       done */
+    std::vector<std::size_t> levelOffsets(maxDepth + 2);
+    for(std::size_t i = 0; i != jointCount; ++i)
+        if(jointObjects[i].get().counter == i && depths[i])
+            ++levelOffsets[depths[i] + 1];
+    for(std::size_t i = 2; i < levelOffsets.size(); ++i)
+        levelOffsets[i] += levelOffsets[i - 1];
+    std::vector<UnsignedInt> levels(levelOffsets.back());
+    {
+        std::vector<std::size_t> offsets{levelOffsets};
+        for(std::size_t i = 0; i != jointCount; ++i)
+            if(jointObjects[i].get().counter == i && depths[i])
+                levels[offsets[depths[i]]++] = UnsignedInt(i);
+    }
+
+    /* Compose the transformations level by level, as each level depends
+       only on the previous one */
+    for(UnsignedInt depth = 1; depth <= maxDepth; ++depth) {
+        const UnsignedInt* const level = levels.data() + levelOffsets[depth];
+        const std::size_t levelSize = levelOffsets[depth + 1] - levelOffsets[depth];
+        Implementation::runOnThreads(Implementation::clampThreadCount(threadCount, levelSize), levelSize, [&](const std::size_t begin, const std::size_t end) {
+            for(std::size_t i = begin; i != end; ++i) {
+                const UnsignedInt joint = level[i];
+                jointTransformations[joint] = Implementation::Transformation<Transformation>::compose(jointTransformations[parentJoints[joint]], jointTransformations[joint]);
+            }
+        });
+    }
+}
+
 template<class Transformation> void Object<Transformation>::doSetClean(const std::vector<std::reference_wrapper<AbstractObject<Transformation::Dimensions, typename Transformation::Type>>>& objects) {
     std::vector<std::reference_wrapper<Object<Transformation>>> castObjects;
     castObjects.reserve(objects.size());
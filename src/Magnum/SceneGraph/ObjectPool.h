@@ -0,0 +1,182 @@
+#ifndef Magnum_SceneGraph_ObjectPool_h
+#define Magnum_SceneGraph_ObjectPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::ObjectPool
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/SceneGraph/Object.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Object pool
+@m_since_latest
+
+Creates a whole object hierarchy at once, for example from an imported
+@ref Trade::SceneData. All objects are allocated in a single contiguous array
+and then linked to their parents in a single pass. That's in contrast to
+creating objects one by one, where each object is a separate allocation and
+each call to @ref Object::setParent() walks the parent chain to check for
+cycles:
+
+@snippet MagnumSceneGraph.cpp ObjectPool-usage
+
+The hierarchy is described by an array of parent indices, where
+@cpp -1 @ce denotes a top-level object that gets attached to the object
+passed in the constructor, and an optional array of object transformations.
+It's validated only once upfront, in a single linear pass over all objects
+and only if @ref CORRADE_NO_ASSERT isn't defined.
+
+Pooled objects behave like any other object --- they can be transformed,
+reparented, have features attached and new objects added as children.
+However, they're owned by the pool and not by their parents. They're
+detached from their parents and destroyed together with the pool, which
+thus has to be destroyed before the objects it's attached to, and they
+shouldn't be deleted individually.
+*/
+template<class Transformation> class ObjectPool {
+    public:
+        /** @brief Matrix type */
+        typedef typename Object<Transformation>::MatrixType MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param parent            Object to attach top-level objects to
+         * @param parents           Parent index for each object or
+         *      @cpp -1 @ce for a top-level object
+         * @param transformations   Transformation for each object
+         *
+         * Expects that @p transformations is either empty or has the same
+         * size as @p parents and that all parent indices are either
+         * @cpp -1 @ce or in bounds and don't form a cycle. Children of
+         * each object are ordered by their index. If @p transformations is
+         * empty, all objects have an identity transformation.
+         */
+        explicit ObjectPool(Object<Transformation>& parent, const Containers::StridedArrayView1D<const Int>& parents, const Containers::StridedArrayView1D<const MatrixType>& transformations = {});
+
+        /** @brief Copying is not allowed */
+        ObjectPool(const ObjectPool<Transformation>&) = delete;
+
+        /** @brief Move constructor */
+        ObjectPool(ObjectPool<Transformation>&&) noexcept = default;
+
+        /**
+         * @brief Destructor
+         *
+         * Detaches all pooled objects from their parents and destroys them,
+         * together with their features and all non-pooled children.
+         */
+        ~ObjectPool();
+
+        /** @brief Copying is not allowed */
+        ObjectPool<Transformation>& operator=(const ObjectPool<Transformation>&) = delete;
+
+        /** @brief Move assignment */
+        ObjectPool<Transformation>& operator=(ObjectPool<Transformation>&&) noexcept = default;
+
+        /** @brief Object count */
+        std::size_t size() const { return _objects.size(); }
+
+        /** @brief All pooled objects */
+        Containers::ArrayView<Object<Transformation>> objects() { return _objects; }
+        Containers::ArrayView<const Object<Transformation>> objects() const { return _objects; } /**< @overload */
+
+        /**
+         * @brief Object at given index
+         *
+         * Expects that @p id is less than @ref size().
+         */
+        Object<Transformation>& object(std::size_t id) {
+            CORRADE_ASSERT(id < _objects.size(),
+                "SceneGraph::ObjectPool::object(): index" << id << "out of range for" << _objects.size() << "objects", _objects[0]);
+            return _objects[id];
+        }
+
+    private:
+        Containers::Array<Object<Transformation>> _objects;
+};
+
+template<class Transformation> ObjectPool<Transformation>::ObjectPool(Object<Transformation>& parent, const Containers::StridedArrayView1D<const Int>& parents, const Containers::StridedArrayView1D<const MatrixType>& transformations) {
+    CORRADE_ASSERT(transformations.empty() || transformations.size() == parents.size(),
+        "SceneGraph::ObjectPool: expected" << parents.size() << "transformations but got" << transformations.size(), );
+
+    #ifndef CORRADE_NO_ASSERT
+    /* Check that all parent chains end with a top-level object. Each chain is
+       walked only until it reaches an object that was already verified, so
+       this is linear in the object count. 1 marks objects on the chain
+       being walked, 2 verified objects. */
+    {
+        Containers::Array<UnsignedByte> state{Containers::ValueInit, parents.size()};
+        for(std::size_t i = 0; i != parents.size(); ++i) {
+            for(std::size_t j = i; !state[j]; ) {
+                state[j] = 1;
+                const Int p = parents[j];
+                if(p == -1) break;
+                CORRADE_ASSERT(p >= 0 && std::size_t(p) < parents.size(),
+                    "SceneGraph::ObjectPool: parent index" << p << "for object" << j << "out of range for" << parents.size() << "objects", );
+                CORRADE_ASSERT(state[p] != 1,
+                    "SceneGraph::ObjectPool: parent of object" << j << "forms a cycle", );
+                j = p;
+            }
+            for(std::size_t j = i; state[j] == 1; ) {
+                state[j] = 2;
+                if(parents[j] == -1) break;
+                j = parents[j];
+            }
+        }
+    }
+    #endif
+
+    _objects = Containers::Array<Object<Transformation>>{Containers::DefaultInit, parents.size()};
+
+    /* The objects are all new, dirty and without children, so there's no need
+       to go through setParent() */
+    for(std::size_t i = 0; i != _objects.size(); ++i) {
+        Object<Transformation>& object = _objects[i];
+        if(!transformations.empty())
+            object.Transformation::setTransformation(Implementation::Transformation<Transformation>::fromMatrix(transformations[i]));
+        Object<Transformation>& objectParent = parents[i] == -1 ? parent : _objects[parents[i]];
+        objectParent.Containers::template LinkedList<Object<Transformation>>::insert(&object);
+    }
+}
+
+template<class Transformation> ObjectPool<Transformation>::~ObjectPool() {
+    /* Detach the objects first so neither the original parents nor other
+       pooled objects attempt to delete them */
+    for(Object<Transformation>& object: _objects)
+        if(Object<Transformation>* parent = object.parent())
+            parent->Containers::template LinkedList<Object<Transformation>>::cut(&object);
+}
+
+}}
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef Magnum_SceneGraph_PoolAllocator_h
+#define Magnum_SceneGraph_PoolAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::SceneGraph::PoolAllocator, @ref Magnum::SceneGraph::PoolAllocated
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/SceneGraph/SceneGraph.h"
+
+namespace Magnum { namespace SceneGraph {
+
+/**
+@brief Pool allocator for objects and features
+@m_since_latest
+
+By default, each object and feature is a separate heap allocation, done with
+@cpp new @ce by the user and released with @cpp delete @ce when its parent
+object is destroyed. For scenes where thousands of short-lived objects, such
+as projectiles or particle effects, are created and destroyed every second,
+that fragments the heap and scatters the objects across memory.
+
+This class keeps instances of a single type @p T in chunks of contiguous
+memory, with a free list linking the unused slots. Allocation and
+deallocation are @f$ \mathcal{O}(1) @f$ and the global allocator is touched
+only when a new chunk needs to be added, which can be avoided altogether by
+calling @ref reserve() upfront. Typically there's one allocator per pooled
+type and scene.
+
+@section SceneGraph-PoolAllocator-usage Usage
+
+A pooled type derives from @ref PoolAllocated with itself as the template
+parameter, which makes it allocatable only with a placement @cpp new @ce
+taking a @ref PoolAllocator. The object hierarchy then destroys pooled
+instances the same way as any other, returning the memory back to the
+allocator instead of the global heap:
+
+@snippet MagnumSceneGraph.cpp PoolAllocator-usage
+
+The same works for features allocated separately from their objects ---
+a @ref Drawable subclass deriving from @ref PoolAllocated is destroyed
+together with its object and its memory returned to the pool.
+
+Each slot stores a pointer to its allocator right before the instance, so
+the allocator doesn't need to be passed on deletion. Because of that, the
+allocator has to outlive all instances allocated from it --- in particular,
+it has to be constructed before the scene that the pooled objects are
+attached to. The allocator is not thread-safe.
+*/
+template<class T> class PoolAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param chunkSize     Count of instances in a single chunk
+         *
+         * Expects that @p chunkSize is non-zero. No memory is allocated
+         * until the first @ref allocate() or @ref reserve() call.
+         */
+        explicit PoolAllocator(std::size_t chunkSize = 64): _chunkSize{chunkSize} {
+            CORRADE_ASSERT(chunkSize,
+                "SceneGraph::PoolAllocator: expected non-zero chunk size", );
+        }
+
+        /** @brief Copying is not allowed */
+        PoolAllocator(const PoolAllocator<T>&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Allocated instances reference the allocator.
+         */
+        PoolAllocator(PoolAllocator<T>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Expects that all instances were deallocated already.
+         */
+        ~PoolAllocator() {
+            CORRADE_ASSERT(!_size,
+                "SceneGraph::PoolAllocator: destroyed with" << _size << "instances still allocated", );
+        }
+
+        /** @brief Copying is not allowed */
+        PoolAllocator<T>& operator=(const PoolAllocator<T>&) = delete;
+
+        /** @brief Moving is not allowed */
+        PoolAllocator<T>& operator=(PoolAllocator<T>&&) = delete;
+
+        /** @brief Count of instances in a single chunk */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /** @brief Count of allocated chunks */
+        std::size_t chunkCount() const { return _chunks.size(); }
+
+        /** @brief Count of instances that fit into allocated chunks */
+        std::size_t capacity() const { return _chunks.size()*_chunkSize; }
+
+        /** @brief Count of currently allocated instances */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Reserve memory for given count of instances
+         *
+         * Adds chunks until @ref capacity() is at least @p capacity. Does
+         * nothing if the capacity is large enough already.
+         */
+        void reserve(std::size_t capacity) {
+            while(this->capacity() < capacity) addChunk();
+        }
+
+        /**
+         * @brief Allocate memory for a single instance
+         *
+         * Takes the first slot from the free list, adding a new chunk if
+         * there's no free slot. The returned memory is suitably aligned for
+         * @p T and uninitialized. You don't need to call this function
+         * directly, use a placement @cpp new @ce with a type deriving from
+         * @ref PoolAllocated instead.
+         */
+        void* allocate() {
+            if(!_free) addChunk();
+            Slot* const slot = _free;
+            _free = slot->next;
+            slot->allocator = this;
+            ++_size;
+            return reinterpret_cast<char*>(slot) + HeaderSize;
+        }
+
+        /**
+         * @brief Deallocate memory for a single instance
+         *
+         * Expects that @p pointer was returned from @ref allocate() and the
+         * instance was destroyed already. The slot is put to the front of the
+         * free list. You don't need to call this function directly, it's
+         * called when a type deriving from @ref PoolAllocated gets deleted.
+         */
+        void deallocate(void* pointer) {
+            Slot* const slot = slotFor(pointer);
+            CORRADE_ASSERT(slot->allocator == this,
+                "SceneGraph::PoolAllocator::deallocate(): the pointer is not allocated from this allocator", );
+            slot->next = _free;
+            _free = slot;
+            --_size;
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Used by PoolAllocated::operator delete() */
+        static PoolAllocator<T>& allocatorFor(void* pointer) {
+            return *slotFor(pointer)->allocator;
+        }
+        #endif
+
+    private:
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+            "over-aligned types are not supported");
+
+        /* While the slot is free, the header is a pointer to the next free
+           slot, otherwise a pointer to the allocator */
+        union Slot {
+            Slot* next;
+            PoolAllocator<T>* allocator;
+        };
+
+        enum: std::size_t {
+            /* Padded so the instance is aligned */
+            HeaderSize = alignof(T) > sizeof(Slot) ? alignof(T) : sizeof(Slot),
+            SlotAlignment = alignof(T) > alignof(Slot) ? alignof(T) : alignof(Slot),
+            SlotSize = (HeaderSize + sizeof(T) + SlotAlignment - 1)/SlotAlignment*SlotAlignment
+        };
+
+        static Slot* slotFor(void* pointer) {
+            return reinterpret_cast<Slot*>(static_cast<char*>(pointer) - HeaderSize);
+        }
+
+        void addChunk() {
+            Containers::Array<char> chunk{Containers::NoInit, _chunkSize*SlotSize};
+            /* Link the slots in reverse so they get allocated in increasing
+               memory order */
+            for(std::size_t i = _chunkSize; i != 0; --i) {
+                Slot* const slot = reinterpret_cast<Slot*>(chunk + (i - 1)*SlotSize);
+                slot->next = _free;
+                _free = slot;
+            }
+            arrayAppend(_chunks, std::move(chunk));
+        }
+
+        Containers::Array<Containers::Array<char>> _chunks;
+        Slot* _free{};
+        std::size_t _chunkSize, _size{};
+};
+
+/**
+@brief Base for types allocated from a @ref PoolAllocator
+@m_since_latest
+
+Derive your object or feature type from this class, with the type itself as
+the template parameter, to make it allocatable from a @ref PoolAllocator. See
+its documentation for more information.
+
+The class provides a class-specific placement @cpp operator new @ce taking
+the allocator and a matching @cpp operator delete @ce, which hides the global
+@cpp operator new @ce --- a pooled type thus can't be accidentally allocated
+with a plain @cpp new @ce, but creating it on stack or as a member is still
+possible. Types further derived from @p T can't be allocated from a
+@cpp PoolAllocator<T> @ce, as they wouldn't fit into its slots.
+*/
+template<class T> class PoolAllocated {
+    public:
+        /**
+         * @brief Allocate from a pool
+         *
+         * Expects that @p size is equal to @cpp sizeof(T) @ce. The function
+         * is @cpp noexcept @ce so the @cpp new @ce expression skips the
+         * construction if the assertion fails in a graceful assert build.
+         * @see @ref PoolAllocator::allocate()
+         */
+        static void* operator new(std::size_t size, PoolAllocator<T>& allocator) noexcept {
+            CORRADE_ASSERT(size == sizeof(T),
+                "SceneGraph::PoolAllocated: can't allocate" << size << "bytes from a pool of" << sizeof(T) << "byte instances", nullptr);
+            static_cast<void>(size);
+            return allocator.allocate();
+        }
+
+        /**
+         * @brief Deallocate back to the pool
+         *
+         * Called implicitly by @cpp delete @ce, for example when the parent
+         * object gets destroyed.
+         * @see @ref PoolAllocator::deallocate()
+         */
+        static void operator delete(void* pointer) noexcept {
+            if(pointer) PoolAllocator<T>::allocatorFor(pointer).deallocate(pointer);
+        }
+
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        /* Called if the constructor throws */
+        static void operator delete(void* pointer, PoolAllocator<T>& allocator) noexcept {
+            allocator.deallocate(pointer);
+        }
+        #endif
+
+    protected:
+        ~PoolAllocated() = default;
+};
+
+}}
+
+#endif
@@ -35,6 +35,7 @@ namespace Magnum { namespace SceneGraph {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
 enum class AspectRatioPolicy: UnsignedByte;
+enum class DepthOrder: UnsignedByte;
 
 /* Enum CachedTransformation and CachedTransformations used only directly */
 
@@ -123,12 +124,30 @@ template<class T> using BasicDrawableGroup3D = DrawableGroup<3, T>;
 typedef BasicDrawableGroup2D<Float> DrawableGroup2D;
 typedef BasicDrawableGroup3D<Float> DrawableGroup3D;
 
+template<UnsignedInt, class> class DrawableBvh;
+template<class T> using BasicDrawableBvh2D = DrawableBvh<2, T>;
+template<class T> using BasicDrawableBvh3D = DrawableBvh<3, T>;
+typedef BasicDrawableBvh2D<Float> DrawableBvh2D;
+typedef BasicDrawableBvh3D<Float> DrawableBvh3D;
+
+template<UnsignedInt, class> class DrawableQueue;
+template<class T> using BasicDrawableQueue2D = DrawableQueue<2, T>;
+template<class T> using BasicDrawableQueue3D = DrawableQueue<3, T>;
+typedef BasicDrawableQueue2D<Float> DrawableQueue2D;
+typedef BasicDrawableQueue3D<Float> DrawableQueue3D;
+
+template<class Transformation> class FlattenedScene;
+
 template<class> class BasicMatrixTransformation2D;
 template<class> class BasicMatrixTransformation3D;
 typedef BasicMatrixTransformation2D<Float> MatrixTransformation2D;
 typedef BasicMatrixTransformation3D<Float> MatrixTransformation3D;
 
 template<class Transformation> class Object;
+template<class Transformation> class ObjectPool;
+
+template<class> class PoolAllocator;
+template<class> class PoolAllocated;
 
 template<class> class BasicRigidMatrixTransformation2D;
 template<class> class BasicRigidMatrixTransformation3D;
@@ -23,8 +23,13 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/SceneGraph/AbstractFeature.hpp"
@@ -48,9 +53,23 @@ struct AnimableTest: TestSuite::Tester {
 
     void deleteWhileRunning();
 
+    void threadSafe();
+    void stepThreaded();
+
     void debug();
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+    bool expectOtherThreads;
+} StepThreadedData[]{
+    {"single thread", 1, false},
+    {"four threads", 4, true},
+    {"hardware concurrency", 0, false},
+    {"more threads than animables", 100000, true}
+};
+
 AnimableTest::AnimableTest() {
     addTests({&AnimableTest::state<Float>,
               &AnimableTest::state<Double>,
@@ -67,7 +86,12 @@ AnimableTest::AnimableTest() {
 
               &AnimableTest::deleteWhileRunning,
 
-              &AnimableTest::debug});
+              &AnimableTest::threadSafe});
+
+    addInstancedTests({&AnimableTest::stepThreaded},
+        Containers::arraySize(StepThreadedData));
+
+    addTests({&AnimableTest::debug});
 }
 
 template<class T> using Object3D = SceneGraph::Object<SceneGraph::BasicMatrixTransformation3D<T>>;
@@ -399,6 +423,143 @@ void AnimableTest::deleteWhileRunning() {
     CORRADE_COMPARE(group.runningCount(), 0);
 }
 
+void AnimableTest::threadSafe() {
+    Object3D<Float> object;
+    AnimableGroup3D group;
+    CORRADE_COMPARE(group.threadCount(), 1);
+
+    OneShotAnimable<Float> animable{object, &group};
+    CORRADE_VERIFY(!animable.isThreadSafe());
+
+    animable.setThreadSafe(true);
+    CORRADE_VERIFY(animable.isThreadSafe());
+
+    group.setThreadCount(3);
+    CORRADE_COMPARE(group.threadCount(), 3);
+}
+
+void AnimableTest::stepThreaded() {
+    auto&& data = StepThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* State change callbacks are recorded into a shared log, which is only
+       safe if they're all called from the main thread */
+    struct Log {
+        std::thread::id mainThread = std::this_thread::get_id();
+        std::vector<std::pair<std::size_t, Int>> events;
+        bool callbackFromOtherThread = false;
+    } log;
+
+    class RecordingAnimable: public SceneGraph::Animable3D {
+        public:
+            explicit RecordingAnimable(AbstractObject3D& object, AnimableGroup3D& group, Log& log, std::size_t id): SceneGraph::Animable3D{object, &group}, _log(log), _id{id} {
+                setDuration(2.0f + id%3);
+            }
+
+            Float time = -1.0f, delta = -1.0f;
+            std::thread::id thread;
+
+        private:
+            void record(Int event) {
+                if(std::this_thread::get_id() != _log.mainThread)
+                    _log.callbackFromOtherThread = true;
+                _log.events.emplace_back(_id, event);
+            }
+
+            void animationStep(Float t, Float d) override {
+                time = t;
+                delta = d;
+                thread = std::this_thread::get_id();
+            }
+
+            void animationStarted() override { record(0); }
+            void animationPaused() override { record(1); }
+            void animationResumed() override { record(2); }
+            void animationStopped() override { record(3); }
+
+            Log& _log;
+            std::size_t _id;
+    };
+
+    /* Every third animable is not thread-safe, these are always stepped on
+       the main thread. The rest is enough to be split across four threads. */
+    Object3D<Float> object;
+    AnimableGroup3D group;
+    group.setThreadCount(data.threadCount);
+    std::vector<std::unique_ptr<RecordingAnimable>> animables;
+    for(std::size_t i = 0; i != 9000; ++i) {
+        animables.emplace_back(new RecordingAnimable{object, group, log, i});
+        animables.back()->setThreadSafe(i%3 != 0)
+            .setState(AnimationState::Running);
+    }
+
+    /* First step starts everything */
+    group.step(1.0f, 0.5f);
+    CORRADE_COMPARE(group.runningCount(), 9000);
+    CORRADE_VERIFY(!log.callbackFromOtherThread);
+    CORRADE_COMPARE(log.events.size(), 9000);
+    for(std::size_t i = 0; i != log.events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(log.events[i].first, i);
+        CORRADE_COMPARE(log.events[i].second, 0);
+    }
+
+    /* Second step advances everything. Pause every seventh animable, those
+       don't get stepped. */
+    log.events.clear();
+    for(std::size_t i = 0; i < animables.size(); i += 7)
+        animables[i]->setState(AnimationState::Paused);
+    group.step(2.5f, 1.5f);
+    CORRADE_COMPARE(group.runningCount(), 9000 - 1286);
+    CORRADE_VERIFY(!log.callbackFromOtherThread);
+    CORRADE_COMPARE(log.events.size(), 1286);
+    for(std::size_t i = 0; i != log.events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(log.events[i].first, i*7);
+        CORRADE_COMPARE(log.events[i].second, 1);
+    }
+
+    bool otherThreads = false;
+    for(std::size_t i = 0; i != animables.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const RecordingAnimable& animable = *animables[i];
+        if(i % 7 == 0) {
+            CORRADE_COMPARE(animable.time, 0.0f);
+            CORRADE_COMPARE(animable.delta, 0.5f);
+        } else {
+            CORRADE_COMPARE(animable.time, 1.5f);
+            CORRADE_COMPARE(animable.delta, 1.5f);
+        }
+
+        if(!animable.isThreadSafe())
+            CORRADE_VERIFY(animable.thread == log.mainThread);
+        else if(animable.thread != log.mainThread)
+            otherThreads = true;
+    }
+
+    /* With enough threads, at least some steps should be done elsewhere */
+    if(data.expectOtherThreads)
+        CORRADE_VERIFY(otherThreads);
+    else if(data.threadCount == 1)
+        CORRADE_VERIFY(!otherThreads);
+
+    /* Third step stops the animations with duration 2 (id%3 == 0), in order
+       and from the main thread */
+    log.events.clear();
+    group.step(3.5f, 1.0f);
+    CORRADE_VERIFY(!log.callbackFromOtherThread);
+    std::size_t expected = 0;
+    for(std::size_t i = 0; i != animables.size(); ++i)
+        if(i % 7 != 0 && i % 3 == 0) ++expected;
+    CORRADE_COMPARE(log.events.size(), expected);
+    for(std::size_t i = 1; i < log.events.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(log.events[i].first, log.events[i - 1].first,
+            TestSuite::Compare::Greater);
+        CORRADE_COMPARE(log.events[i].second, 3);
+    }
+}
+
 void AnimableTest::debug() {
     std::ostringstream o;
     Debug(&o) << AnimationState::Running << AnimationState(0xbe);
@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Arguments.h>
+
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/FlattenedScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void transformationMatrices();
+    void transformationMatricesThreaded();
+    void setClean();
+    void setCleanFlattened();
+    void drawableTransformations();
+    void drawableTransformationsCached();
+
+    private:
+        struct Hierarchy;
+
+        Hierarchy& hierarchy();
+
+        bool _huge;
+        Containers::Pointer<Hierarchy> _hierarchies[4];
+};
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::ObjectPool<SceneGraph::MatrixTransformation3D> ObjectPool3D;
+typedef SceneGraph::FlattenedScene<SceneGraph::MatrixTransformation3D> FlattenedScene3D;
+
+/* The 1M case takes a few hundred megabytes and a while to set up, so it's run
+   only when explicitly requested with --scenegraph-huge */
+const struct {
+    const char* name;
+    std::size_t objectCount;
+    bool huge;
+} SizeData[]{
+    {"1k objects", 1000, false},
+    {"10k objects", 10000, false},
+    {"100k objects", 100000, false},
+    {"1M objects", 1000000, true}
+};
+
+Benchmark::Benchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"scenegraph"})} {
+    addInstancedBenchmarks({&Benchmark::transformationMatrices,
+                            &Benchmark::transformationMatricesThreaded,
+                            &Benchmark::setClean,
+                            &Benchmark::setCleanFlattened,
+                            &Benchmark::drawableTransformations,
+                            &Benchmark::drawableTransformationsCached}, 5,
+        Containers::arraySize(SizeData));
+
+    Utility::Arguments args{"scenegraph"};
+    args.addBooleanOption("huge").setHelp("huge", "run also the 1M object cases")
+        .parse(arguments().first, arguments().second);
+    _huge = args.isSet("huge");
+}
+
+#define SKIP_IF_HUGE()                                                      \
+    if(SizeData[testCaseInstanceId()].huge && !_huge)                       \
+        CORRADE_SKIP("Run with --scenegraph-huge to enable")
+
+class NoopDrawable: public SceneGraph::Drawable3D {
+    public:
+        explicit NoopDrawable(Object3D& object, SceneGraph::DrawableGroup3D& drawables): SceneGraph::Drawable3D{object, &drawables} {}
+
+    private:
+        void draw(const Matrix4&, SceneGraph::Camera3D&) override {}
+};
+
+/* A tree with a branching factor of four, with each object translated by one
+   unit along X relative to its parent */
+Containers::Array<Int> treeParents(std::size_t count) {
+    Containers::Array<Int> out{Containers::NoInit, count};
+    for(std::size_t i = 0; i != count; ++i)
+        out[i] = i < 4 ? -1 : Int(i/4 - 1);
+    return out;
+}
+
+Containers::Array<Matrix4> treeTransformations(std::size_t count) {
+    Containers::Array<Matrix4> out{Containers::NoInit, count};
+    for(Matrix4& i: out) i = Matrix4::translation(Vector3::xAxis(1.0f));
+    return out;
+}
+
+struct Benchmark::Hierarchy {
+    explicit Hierarchy(std::size_t count): pool{scene, Containers::arrayView(treeParents(count)), Containers::arrayView(treeTransformations(count))} {
+        objects.reserve(count);
+        for(Object3D& object: pool.objects()) {
+            new NoopDrawable{object, drawables};
+            objects.push_back(object);
+        }
+    }
+
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    SceneGraph::Camera3D camera{cameraObject};
+    SceneGraph::DrawableGroup3D drawables;
+    /* Owns the objects and the drawables attached to them, has to be
+       destroyed before everything above */
+    ObjectPool3D pool;
+    std::vector<std::reference_wrapper<Object3D>> objects;
+};
+
+/* Created on first use and cached, as the larger hierarchies take a while to
+   set up */
+Benchmark::Hierarchy& Benchmark::hierarchy() {
+    Containers::Pointer<Hierarchy>& hierarchy = _hierarchies[testCaseInstanceId()];
+    if(!hierarchy) hierarchy.reset(new Hierarchy{SizeData[testCaseInstanceId()].objectCount});
+    return *hierarchy;
+}
+
+/* Marks the whole tree dirty, which is what happens when the top-level
+   objects get moved */
+void setTreeDirty(ObjectPool3D& pool) {
+    for(std::size_t i = 0; i != 4; ++i)
+        pool.object(i).setDirty();
+}
+
+void Benchmark::transformationMatrices() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    Hierarchy& hierarchy = this->hierarchy();
+
+    std::vector<Matrix4> out;
+    CORRADE_BENCHMARK(1)
+        out = hierarchy.scene.transformationMatrices(hierarchy.objects);
+
+    CORRADE_COMPARE(out.size(), data.objectCount);
+    CORRADE_COMPARE(out[4], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void Benchmark::transformationMatricesThreaded() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    Hierarchy& hierarchy = this->hierarchy();
+
+    std::vector<Matrix4> out;
+    CORRADE_BENCHMARK(1)
+        out = hierarchy.scene.transformationMatrices(hierarchy.objects, {}, 0);
+
+    CORRADE_COMPARE(out.size(), data.objectCount);
+    CORRADE_COMPARE(out[4], Matrix4::translation(Vector3::xAxis(2.0f)));
+}
+
+void Benchmark::setClean() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    Hierarchy& hierarchy = this->hierarchy();
+    setTreeDirty(hierarchy.pool);
+
+    CORRADE_BENCHMARK(1)
+        Object3D::setClean(hierarchy.objects);
+
+    CORRADE_VERIFY(!hierarchy.pool.object(data.objectCount - 1).isDirty());
+}
+
+void Benchmark::setCleanFlattened() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    Hierarchy& hierarchy = this->hierarchy();
+    FlattenedScene3D flattened{hierarchy.scene};
+    setTreeDirty(hierarchy.pool);
+
+    std::size_t cleaned{};
+    CORRADE_BENCHMARK(1)
+        cleaned = flattened.update();
+
+    CORRADE_COMPARE(cleaned, data.objectCount);
+}
+
+void Benchmark::drawableTransformations() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    Hierarchy& hierarchy = this->hierarchy();
+    hierarchy.camera.setTransformationCachingEnabled(false);
+
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> out;
+    CORRADE_BENCHMARK(1)
+        out = hierarchy.camera.drawableTransformations(hierarchy.drawables);
+
+    CORRADE_COMPARE(out.size(), data.objectCount);
+}
+
+void Benchmark::drawableTransformationsCached() {
+    auto&& data = SizeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+    SKIP_IF_HUGE();
+
+    /* The first call cleans the objects and caches their absolute
+       transformations, the measured call then only multiplies them with the
+       camera matrix */
+    Hierarchy& hierarchy = this->hierarchy();
+    hierarchy.camera.setTransformationCachingEnabled(true);
+    hierarchy.camera.drawableTransformations(hierarchy.drawables);
+
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::Drawable3D>, Matrix4>> out;
+    CORRADE_BENCHMARK(1)
+        out = hierarchy.camera.drawableTransformations(hierarchy.drawables);
+
+    CORRADE_COMPARE(out.size(), data.objectCount);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::Benchmark)
@@ -53,6 +53,7 @@ struct CameraTest: TestSuite::Tester {
 
     template<class T> void draw();
     template<class T> void drawOrdered();
+    template<class T> void drawTransformationCaching();
 };
 
 CameraTest::CameraTest() {
@@ -77,7 +78,9 @@ CameraTest::CameraTest() {
         &CameraTest::draw<Float>,
         &CameraTest::draw<Double>,
         &CameraTest::drawOrdered<Float>,
-        &CameraTest::drawOrdered<Double>});
+        &CameraTest::drawOrdered<Double>,
+        &CameraTest::drawTransformationCaching<Float>,
+        &CameraTest::drawTransformationCaching<Double>});
 }
 
 template<class T> using Object2D = SceneGraph::Object<SceneGraph::BasicMatrixTransformation2D<T>>;
@@ -249,6 +252,84 @@ template<class T> void CameraTest::draw() {
     CORRADE_COMPARE(thirdTransformation, Math::Matrix4<T>{});
 }
 
+template<class T> void CameraTest::drawTransformationCaching() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    class Drawable: public SceneGraph::BasicDrawable3D<T> {
+        public:
+            Drawable(AbstractBasicObject3D<T>& object, BasicDrawableGroup3D<T>* group, Math::Matrix4<T>& result): SceneGraph::BasicDrawable3D<T>{object, group}, result(result) {}
+
+        protected:
+            void draw(const Math::Matrix4<T>& transformationMatrix, BasicCamera3D<T>&) override {
+                result = transformationMatrix;
+            }
+
+        private:
+            Math::Matrix4<T>& result;
+    };
+
+    BasicDrawableGroup3D<T> group;
+    Scene3D<T> scene;
+
+    Object3D<T> first(&scene);
+    Math::Matrix4<T> firstTransformation;
+    first.scale(Math::Vector3<T>{T(5.0)});
+    new Drawable{first, &group, firstTransformation};
+
+    Object3D<T> second(&scene);
+    Math::Matrix4<T> secondTransformation;
+    second.translate(Math::Vector3<T>::yAxis(T(3.0)));
+    new Drawable{second, &group, secondTransformation};
+
+    Object3D<T> third(&second);
+    Math::Matrix4<T> thirdTransformation;
+    third.translate(Math::Vector3<T>::zAxis(T(-1.5)));
+    new Drawable{third, &group, thirdTransformation};
+
+    Object3D<T> cameraObject(&scene);
+    cameraObject.translate(Math::Vector3<T>::zAxis(T(2.0)));
+    BasicCamera3D<T> camera{cameraObject};
+    CORRADE_VERIFY(!camera.isTransformationCachingEnabled());
+
+    camera.setTransformationCachingEnabled(true);
+    CORRADE_VERIFY(camera.isTransformationCachingEnabled());
+
+    /* First draw populates the cache, all objects are clean after */
+    camera.draw(group);
+    CORRADE_VERIFY(!first.isDirty());
+    CORRADE_VERIFY(!second.isDirty());
+    CORRADE_VERIFY(!third.isDirty());
+    CORRADE_COMPARE(firstTransformation, Math::Matrix4<T>::translation(Math::Vector3<T>::zAxis(T(-2.0)))*Math::Matrix4<T>::scaling(Math::Vector3<T>(T(5.0))));
+    CORRADE_COMPARE(secondTransformation, Math::Matrix4<T>::translation({T(0.0), T(3.0), T(-2.0)}));
+    CORRADE_COMPARE(thirdTransformation, Math::Matrix4<T>::translation({T(0.0), T(3.0), T(-3.5)}));
+
+    /* Moving the parent recalculates its subtree, the camera movement gets
+       applied to the cached transformations as well */
+    second.translate(Math::Vector3<T>::xAxis(T(1.0)));
+    cameraObject.translate(Math::Vector3<T>::zAxis(T(1.0)));
+    CORRADE_VERIFY(!first.isDirty());
+    CORRADE_VERIFY(second.isDirty());
+    CORRADE_VERIFY(third.isDirty());
+    camera.draw(group);
+    CORRADE_VERIFY(!second.isDirty());
+    CORRADE_VERIFY(!third.isDirty());
+    CORRADE_COMPARE(firstTransformation, Math::Matrix4<T>::translation(Math::Vector3<T>::zAxis(T(-3.0)))*Math::Matrix4<T>::scaling(Math::Vector3<T>(T(5.0))));
+    CORRADE_COMPARE(secondTransformation, Math::Matrix4<T>::translation({T(1.0), T(3.0), T(-3.0)}));
+    CORRADE_COMPARE(thirdTransformation, Math::Matrix4<T>::translation({T(1.0), T(3.0), T(-4.5)}));
+
+    /* The result is the same as without caching */
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::BasicDrawable3D<T>>, Math::Matrix4<T>>> cached = camera.drawableTransformations(group);
+    camera.setTransformationCachingEnabled(false);
+    std::vector<std::pair<std::reference_wrapper<SceneGraph::BasicDrawable3D<T>>, Math::Matrix4<T>>> uncached = camera.drawableTransformations(group);
+    CORRADE_COMPARE(cached.size(), 3);
+    CORRADE_COMPARE(uncached.size(), 3);
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(&cached[i].first.get() == &uncached[i].first.get());
+        CORRADE_COMPARE(cached[i].second, uncached[i].second);
+    }
+}
+
 template<class T> void CameraTest::drawOrdered() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
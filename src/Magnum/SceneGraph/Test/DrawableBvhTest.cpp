@@ -0,0 +1,325 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
+#include "Magnum/SceneGraph/MatrixTransformation2D.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct DrawableBvhTest: TestSuite::Tester {
+    explicit DrawableBvhTest();
+
+    void boundingBox();
+    void boundingBoxCleanObject();
+
+    void construct();
+    void constructZeroLeafSize();
+    void cull();
+    void cull2D();
+    void update();
+    void updateGroupChanged();
+
+    void cameraDraw();
+};
+
+DrawableBvhTest::DrawableBvhTest() {
+    addTests({&DrawableBvhTest::boundingBox,
+              &DrawableBvhTest::boundingBoxCleanObject,
+
+              &DrawableBvhTest::construct,
+              &DrawableBvhTest::constructZeroLeafSize,
+              &DrawableBvhTest::cull,
+              &DrawableBvhTest::cull2D,
+              &DrawableBvhTest::update,
+              &DrawableBvhTest::updateGroupChanged,
+
+              &DrawableBvhTest::cameraDraw});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation2D> Object2D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation2D> Scene2D;
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+using namespace Math::Literals;
+
+class TestDrawable2D: public Drawable2D {
+    public:
+        explicit TestDrawable2D(Object2D& object, DrawableGroup2D* group, Int id): Drawable2D{object, group}, id{id} {}
+
+        Int id;
+
+    private:
+        void draw(const Matrix3&, Camera2D&) override {}
+};
+
+class TestDrawable3D: public Drawable3D {
+    public:
+        explicit TestDrawable3D(Object3D& object, DrawableGroup3D* group = nullptr, Int id = -1, std::vector<std::pair<Int, Matrix4>>* drawn = nullptr): Drawable3D{object, group}, id{id}, _drawn{drawn} {}
+
+        Int id;
+
+    private:
+        void draw(const Matrix4& transformationMatrix, Camera3D&) override {
+            _drawn->emplace_back(id, transformationMatrix);
+        }
+
+        std::vector<std::pair<Int, Matrix4>>* _drawn;
+};
+
+/* Order of drawables inside a leaf is unspecified, so compare sorted IDs */
+template<class Drawable> std::vector<Int> sortedIds(Containers::ArrayView<SceneGraph::Drawable<Drawable::Dimensions, Float>*> drawables) {
+    std::vector<Int> ids;
+    for(SceneGraph::Drawable<Drawable::Dimensions, Float>* drawable: drawables)
+        ids.push_back(static_cast<Drawable*>(drawable)->id);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+/* Visible range is [-1, 1] on all axes */
+const Matrix4 Projection = Matrix4::orthographicProjection({2.0f, 2.0f}, -1.0f, 1.0f);
+
+void DrawableBvhTest::boundingBox() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.scale({2.0f, 1.0f, 1.0f})
+        .rotateZ(90.0_degf)
+        .translate({10.0f, 0.0f, 0.0f});
+
+    TestDrawable3D drawable{object};
+    CORRADE_VERIFY(!drawable.hasBoundingBox());
+
+    drawable.setBoundingBox({{-1.0f, -0.5f, -0.25f}, {1.0f, 0.5f, 0.25f}});
+    CORRADE_VERIFY(drawable.hasBoundingBox());
+    CORRADE_COMPARE(drawable.boundingBox(), (Range3D{{-1.0f, -0.5f, -0.25f}, {1.0f, 0.5f, 0.25f}}));
+    CORRADE_VERIFY(drawable.cachedTransformations() & CachedTransformation::Absolute);
+
+    /* Scaled along X, then rotated to Y and translated */
+    object.setClean();
+    const Range3D box = drawable.absoluteBoundingBox();
+    CORRADE_COMPARE(box.min(), (Vector3{9.5f, -2.0f, -0.25f}));
+    CORRADE_COMPARE(box.max(), (Vector3{10.5f, 2.0f, 0.25f}));
+}
+
+void DrawableBvhTest::boundingBoxCleanObject() {
+    Scene3D scene;
+    Object3D object{&scene};
+    object.translate({1.0f, 2.0f, 3.0f});
+    object.setClean();
+
+    /* Setting the box marks the object dirty so it gets recalculated even
+       though the object was clean already */
+    TestDrawable3D drawable{object};
+    drawable.setBoundingBox({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+    CORRADE_VERIFY(object.isDirty());
+
+    object.setClean();
+    CORRADE_COMPARE(drawable.absoluteBoundingBox(), (Range3D{{0.0f, 1.0f, 2.0f}, {2.0f, 3.0f, 4.0f}}));
+}
+
+void DrawableBvhTest::construct() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    for(Int i = 0; i != 40; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i)));
+        (new TestDrawable3D{*object, &group, i})->setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+    }
+    TestDrawable3D unbounded{scene, &group};
+
+    DrawableBvh3D bvh{group, 4};
+    CORRADE_COMPARE(&bvh.group(), &group);
+    CORRADE_COMPARE(bvh.leafSize(), 4);
+    CORRADE_COMPARE(bvh.boundedCount(), 40);
+    CORRADE_COMPARE(bvh.unboundedCount(), 1);
+    /* 40 -> 20 -> 10 -> 5 -> 3 + 2, so 16 leaves and 15 inner nodes */
+    CORRADE_COMPARE(bvh.nodeCount(), 31);
+
+    /* All objects with a bounding box got cleaned in the process */
+    for(std::size_t i = 0; i != 40; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!group[i].object().isDirty());
+    }
+}
+
+void DrawableBvhTest::constructZeroLeafSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DrawableGroup3D group;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DrawableBvh3D{group, 0};
+    CORRADE_COMPARE(out.str(), "SceneGraph::DrawableBvh: leaf size can't be zero\n");
+}
+
+void DrawableBvhTest::cull() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    TestDrawable3D unbounded{scene, &group, 1000};
+    for(Int i = 0; i != 100; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i - 50)));
+        (new TestDrawable3D{*object, &group, i})->setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+    }
+
+    DrawableBvh3D bvh{group, 4};
+    Containers::ArrayView<Drawable3D*> visible = bvh.cull(Projection);
+
+    /* Objects at -1, 0 and 1 intersect the frustum, the unbounded drawable is
+       always last */
+    CORRADE_COMPARE(visible.size(), 4);
+    CORRADE_COMPARE(sortedIds<TestDrawable3D>(visible.prefix(3)), (std::vector<Int>{49, 50, 51}));
+    CORRADE_COMPARE(visible[3], static_cast<Drawable3D*>(&unbounded));
+
+    /* Looking elsewhere, only the unbounded drawable is left */
+    visible = bvh.cull(Projection*Matrix4::translation(Vector3::yAxis(5.0f)));
+    CORRADE_COMPARE(visible.size(), 1);
+    CORRADE_COMPARE(visible[0], static_cast<Drawable3D*>(&unbounded));
+}
+
+void DrawableBvhTest::cull2D() {
+    Scene2D scene;
+    DrawableGroup2D group;
+    for(Int i = 0; i != 20; ++i) {
+        Object2D* object = new Object2D{&scene};
+        object->translate(Vector2::yAxis(Float(i)));
+        (new TestDrawable2D{*object, &group, i})->setBoundingBox({-Vector2{0.25f}, Vector2{0.25f}});
+    }
+
+    DrawableBvh2D bvh{group, 2};
+    Containers::ArrayView<Drawable2D*> visible = bvh.cull(Matrix3::projection({2.0f, 2.0f})*Matrix3::translation(Vector2::yAxis(-10.0f)));
+    CORRADE_COMPARE(sortedIds<TestDrawable2D>(visible), (std::vector<Int>{9, 10, 11}));
+}
+
+void DrawableBvhTest::update() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    Object3D* objects[10];
+    for(Int i = 0; i != 10; ++i) {
+        objects[i] = new Object3D{&scene};
+        objects[i]->translate(Vector3::xAxis(Float(10 + i)));
+        (new TestDrawable3D{*objects[i], &group, i})->setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+    }
+
+    DrawableBvh3D bvh{group, 2};
+    CORRADE_COMPARE(bvh.cull(Projection).size(), 0);
+
+    /* Nothing changed */
+    CORRADE_COMPARE(bvh.update(), 0);
+
+    /* Moving objects into the view refits the tree without rebuilding it */
+    const std::size_t nodeCount = bvh.nodeCount();
+    objects[3]->translate(Vector3::xAxis(-13.0f));
+    objects[7]->translate(Vector3::xAxis(-16.5f));
+    CORRADE_COMPARE(bvh.update(), 2);
+    CORRADE_COMPARE(bvh.nodeCount(), nodeCount);
+    CORRADE_VERIFY(!objects[3]->isDirty());
+    CORRADE_COMPARE(sortedIds<TestDrawable3D>(bvh.cull(Projection)), (std::vector<Int>{3, 7}));
+
+    /* Objects cleaned externally are picked up as well */
+    objects[3]->translate(Vector3::xAxis(5.0f));
+    objects[3]->setClean();
+    CORRADE_COMPARE(bvh.update(), 1);
+    CORRADE_COMPARE(sortedIds<TestDrawable3D>(bvh.cull(Projection)), (std::vector<Int>{7}));
+}
+
+void DrawableBvhTest::updateGroupChanged() {
+    Scene3D scene;
+    DrawableGroup3D group;
+    Object3D a{&scene};
+    Object3D b{&scene};
+    TestDrawable3D drawableA{a, &group};
+    drawableA.setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+
+    DrawableBvh3D bvh{group};
+    CORRADE_COMPARE(bvh.boundedCount(), 1);
+
+    /* Adding a drawable rebuilds the tree */
+    TestDrawable3D drawableB{b, &group};
+    drawableB.setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+    CORRADE_COMPARE(bvh.update(), 2);
+    CORRADE_COMPARE(bvh.boundedCount(), 2);
+    CORRADE_COMPARE(bvh.cull(Projection).size(), 2);
+}
+
+void DrawableBvhTest::cameraDraw() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::xAxis(20.0f));
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Projection);
+
+    DrawableGroup3D group;
+    std::vector<std::pair<Int, Matrix4>> drawn;
+    for(Int i = 0; i != 40; ++i) {
+        Object3D* object = new Object3D{&scene};
+        object->translate(Vector3::xAxis(Float(i)));
+        (new TestDrawable3D{*object, &group, i, &drawn})->setBoundingBox({-Vector3{0.25f}, Vector3{0.25f}});
+    }
+
+    /* Only the visible drawables are drawn, with camera-relative
+       transformations */
+    DrawableBvh3D bvh{group, 4};
+    camera.draw(bvh);
+    std::sort(drawn.begin(), drawn.end(), [](const std::pair<Int, Matrix4>& a, const std::pair<Int, Matrix4>& b) {
+        return a.first < b.first;
+    });
+    CORRADE_COMPARE(drawn.size(), 3);
+    CORRADE_COMPARE(drawn[0].first, 19);
+    CORRADE_COMPARE(drawn[0].second, Matrix4::translation(Vector3::xAxis(-1.0f)));
+    CORRADE_COMPARE(drawn[1].first, 20);
+    CORRADE_COMPARE(drawn[1].second, Matrix4{});
+    CORRADE_COMPARE(drawn[2].first, 21);
+    CORRADE_COMPARE(drawn[2].second, Matrix4::translation(Vector3::xAxis(1.0f)));
+
+    /* Moving the camera is picked up */
+    drawn.clear();
+    cameraObject.translate(Vector3::xAxis(18.5f));
+    camera.draw(bvh);
+    std::sort(drawn.begin(), drawn.end(), [](const std::pair<Int, Matrix4>& a, const std::pair<Int, Matrix4>& b) {
+        return a.first < b.first;
+    });
+    CORRADE_COMPARE(drawn.size(), 2);
+    CORRADE_COMPARE(drawn[0].first, 38);
+    CORRADE_COMPARE(drawn[1].first, 39);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DrawableBvhTest)
@@ -0,0 +1,312 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/Camera.h"
+#include "Magnum/SceneGraph/Drawable.h"
+#include "Magnum/SceneGraph/DrawableBvh.h"
+#include "Magnum/SceneGraph/DrawableQueue.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct DrawableQueueTest: TestSuite::Tester {
+    explicit DrawableQueueTest();
+
+    void sortKey();
+
+    void construct();
+    void add();
+    void addGroup();
+    void addBvh();
+    void sort();
+    void sortStable();
+    void sortDepth();
+    void draw();
+    void clear();
+};
+
+DrawableQueueTest::DrawableQueueTest() {
+    addTests({&DrawableQueueTest::sortKey,
+
+              &DrawableQueueTest::construct,
+              &DrawableQueueTest::add,
+              &DrawableQueueTest::addGroup,
+              &DrawableQueueTest::addBvh,
+              &DrawableQueueTest::sort,
+              &DrawableQueueTest::sortStable,
+              &DrawableQueueTest::sortDepth,
+              &DrawableQueueTest::draw,
+              &DrawableQueueTest::clear});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+struct Log {
+    std::vector<Int> drawn;
+    std::vector<std::size_t> batches;
+};
+
+class TestDrawable: public Drawable3D {
+    public:
+        explicit TestDrawable(Object3D& object, DrawableGroup3D* group, Int id, Log& log, bool batched = false): Drawable3D{object, group}, id{id}, _log(log), _batched{batched} {}
+
+        Int id;
+
+    private:
+        void draw(const Matrix4&, Camera3D&) override {
+            _log.drawn.push_back(id);
+        }
+
+        void drawBatch(Containers::ArrayView<Drawable3D* const> drawables, Containers::ArrayView<const Matrix4> transformationMatrices, Camera3D& camera) override {
+            _log.batches.push_back(drawables.size());
+            if(_batched) {
+                for(Drawable3D* drawable: drawables)
+                    _log.drawn.push_back(static_cast<TestDrawable*>(drawable)->id);
+            } else Drawable3D::drawBatch(drawables, transformationMatrices, camera);
+        }
+
+        Log& _log;
+        bool _batched;
+};
+
+std::vector<Int> ids(const DrawableQueue3D& queue) {
+    std::vector<Int> out;
+    for(Drawable3D* drawable: queue.drawables())
+        out.push_back(static_cast<TestDrawable*>(drawable)->id);
+    return out;
+}
+
+void DrawableQueueTest::sortKey() {
+    constexpr UnsignedLong key = drawableSortKey(0x1234, 0x5678, 0x9abc);
+    CORRADE_COMPARE(key, 0x123456789abc0000ull);
+
+    Scene3D scene;
+    Log log;
+    TestDrawable drawable{scene, nullptr, 0, log};
+    CORRADE_COMPARE(drawable.sortKey(), 0);
+    CORRADE_COMPARE(&drawable.setSortKey(key), &drawable);
+    CORRADE_COMPARE(drawable.sortKey(), key);
+}
+
+void DrawableQueueTest::construct() {
+    DrawableQueue3D queue;
+    CORRADE_COMPARE(queue.depthOrder(), DepthOrder::FrontToBack);
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_COMPARE(queue.size(), 0);
+
+    DrawableQueue3D transparent{DepthOrder::BackToFront};
+    CORRADE_COMPARE(transparent.depthOrder(), DepthOrder::BackToFront);
+    CORRADE_COMPARE(&transparent.setDepthOrder(DepthOrder::None), &transparent);
+    CORRADE_COMPARE(transparent.depthOrder(), DepthOrder::None);
+}
+
+void DrawableQueueTest::add() {
+    Scene3D scene;
+    Log log;
+    TestDrawable a{scene, nullptr, 0, log};
+    a.setSortKey(drawableSortKey(1, 2, 3)|0xffff);
+
+    /* The lowest 16 bits of the key get replaced with the depth */
+    DrawableQueue3D queue;
+    queue.add(a, Matrix4::translation(Vector3::zAxis(-2.0f)))
+         .add(a, Matrix4::translation(Vector3::zAxis(5.0f)));
+    CORRADE_COMPARE(queue.size(), 2);
+    CORRADE_COMPARE(queue.drawables()[0], &a);
+    CORRADE_COMPARE(queue.transformationMatrices()[0], Matrix4::translation(Vector3::zAxis(-2.0f)));
+    /* Upper 16 bits of 2.0f */
+    CORRADE_COMPARE(queue.keys()[0], drawableSortKey(1, 2, 3)|0x4000);
+    /* Behind the camera, zero distance */
+    CORRADE_COMPARE(queue.keys()[1], drawableSortKey(1, 2, 3));
+}
+
+void DrawableQueueTest::addGroup() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    cameraObject.translate(Vector3::zAxis(10.0f));
+    Camera3D camera{cameraObject};
+
+    Log log;
+    DrawableGroup3D group;
+    Object3D a{&scene};
+    a.translate(Vector3::xAxis(3.0f));
+    TestDrawable drawableA{a, &group, 0, log};
+    Object3D b{&scene};
+    TestDrawable drawableB{b, &group, 1, log};
+
+    DrawableQueue3D queue;
+    queue.add(camera, group);
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{0, 1}));
+    CORRADE_COMPARE(queue.transformationMatrices()[0], Matrix4::translation({3.0f, 0.0f, -10.0f}));
+    CORRADE_COMPARE(queue.transformationMatrices()[1], Matrix4::translation({0.0f, 0.0f, -10.0f}));
+}
+
+void DrawableQueueTest::addBvh() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    camera.setProjectionMatrix(Matrix4::orthographicProjection({2.0f, 2.0f}, -1.0f, 1.0f));
+
+    Log log;
+    DrawableGroup3D group;
+    Object3D a{&scene};
+    TestDrawable drawableA{a, &group, 0, log};
+    drawableA.setBoundingBox({-Vector3{0.5f}, Vector3{0.5f}});
+    Object3D b{&scene};
+    b.translate(Vector3::xAxis(5.0f));
+    TestDrawable drawableB{b, &group, 1, log};
+    drawableB.setBoundingBox({-Vector3{0.5f}, Vector3{0.5f}});
+
+    /* Only the drawable in the frustum gets added */
+    DrawableBvh3D bvh{group};
+    DrawableQueue3D queue;
+    queue.add(camera, bvh);
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{0}));
+}
+
+void DrawableQueueTest::sort() {
+    Scene3D scene;
+    Log log;
+    const UnsignedLong keys[]{
+        drawableSortKey(2, 0, 1),
+        drawableSortKey(0, 7, 0),
+        drawableSortKey(2, 0, 0),
+        drawableSortKey(1, 0, 0),
+        drawableSortKey(0, 3, 0),
+        drawableSortKey(0, 3, 0x100),
+    };
+    std::vector<Containers::Pointer<TestDrawable>> drawables;
+
+    DrawableQueue3D queue{DepthOrder::None};
+    for(std::size_t i = 0; i != Containers::arraySize(keys); ++i) {
+        drawables.emplace_back(new TestDrawable{scene, nullptr, Int(i), log});
+        drawables.back()->setSortKey(keys[i]);
+        queue.add(*drawables.back(), Matrix4::translation(Vector3::xAxis(Float(i))));
+    }
+
+    queue.sort();
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{4, 5, 1, 3, 2, 0}));
+    CORRADE_COMPARE(queue.keys()[0], drawableSortKey(0, 3, 0));
+    CORRADE_COMPARE(queue.keys()[5], drawableSortKey(2, 0, 1));
+    /* Transformations are reordered together with the drawables */
+    CORRADE_COMPARE(queue.transformationMatrices()[0], Matrix4::translation(Vector3::xAxis(4.0f)));
+    CORRADE_COMPARE(queue.transformationMatrices()[5], Matrix4::translation(Vector3::xAxis(0.0f)));
+}
+
+void DrawableQueueTest::sortStable() {
+    Scene3D scene;
+    Log log;
+    std::vector<Containers::Pointer<TestDrawable>> drawables;
+
+    /* Equal keys interleaved with different ones stay in insertion order */
+    DrawableQueue3D queue{DepthOrder::None};
+    for(Int i = 0; i != 10; ++i) {
+        drawables.emplace_back(new TestDrawable{scene, nullptr, i, log});
+        drawables.back()->setSortKey(drawableSortKey(0, 0, i % 2));
+        queue.add(*drawables.back(), {});
+    }
+
+    queue.sort();
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{0, 2, 4, 6, 8, 1, 3, 5, 7, 9}));
+}
+
+void DrawableQueueTest::sortDepth() {
+    Scene3D scene;
+    Log log;
+    TestDrawable a{scene, nullptr, 0, log};
+    TestDrawable b{scene, nullptr, 1, log};
+    TestDrawable c{scene, nullptr, 2, log};
+    c.setSortKey(drawableSortKey(1, 0, 0));
+
+    /* Depth is sorted only within the same state */
+    DrawableQueue3D queue;
+    queue.add(c, Matrix4::translation(Vector3::zAxis(-0.5f)))
+         .add(a, Matrix4::translation(Vector3::zAxis(-100.0f)))
+         .add(b, Matrix4::translation(Vector3::zAxis(-1.5f)));
+    queue.sort();
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{1, 0, 2}));
+
+    queue.clear();
+    queue.setDepthOrder(DepthOrder::BackToFront)
+         .add(c, Matrix4::translation(Vector3::zAxis(-0.5f)))
+         .add(b, Matrix4::translation(Vector3::zAxis(-1.5f)))
+         .add(a, Matrix4::translation(Vector3::zAxis(-100.0f)));
+    queue.sort();
+    CORRADE_COMPARE(ids(queue), (std::vector<Int>{0, 1, 2}));
+}
+
+void DrawableQueueTest::draw() {
+    Scene3D scene;
+    Object3D cameraObject{&scene};
+    Camera3D camera{cameraObject};
+    Log log;
+
+    TestDrawable a{scene, nullptr, 0, log, true};
+    TestDrawable b{scene, nullptr, 1, log, true};
+    TestDrawable c{scene, nullptr, 2, log};
+    TestDrawable d{scene, nullptr, 3, log};
+    a.setSortKey(drawableSortKey(1, 0, 0));
+    b.setSortKey(drawableSortKey(1, 0, 0));
+    c.setSortKey(drawableSortKey(2, 0, 0));
+    d.setSortKey(drawableSortKey(2, 0, 0));
+
+    /* Different depths don't break the batches */
+    DrawableQueue3D queue;
+    queue.add(c, Matrix4::translation(Vector3::zAxis(-3.0f)))
+         .add(a, Matrix4::translation(Vector3::zAxis(-4.0f)))
+         .add(d, Matrix4::translation(Vector3::zAxis(-2.0f)))
+         .add(b, Matrix4::translation(Vector3::zAxis(-1.0f)));
+    queue.sort();
+    CORRADE_COMPARE(queue.draw(camera), 2);
+    CORRADE_COMPARE(log.batches, (std::vector<std::size_t>{2, 2}));
+    /* The first batch is drawn at once by the drawable, the second goes
+       through the default implementation calling draw() on each */
+    CORRADE_COMPARE(log.drawn, (std::vector<Int>{1, 0, 3, 2}));
+}
+
+void DrawableQueueTest::clear() {
+    Scene3D scene;
+    Log log;
+    TestDrawable a{scene, nullptr, 0, log};
+
+    DrawableQueue3D queue;
+    queue.add(a, {}).add(a, {});
+    CORRADE_COMPARE(queue.size(), 2);
+
+    queue.clear();
+    CORRADE_VERIFY(queue.isEmpty());
+    CORRADE_COMPARE(queue.keys().size(), 0);
+    CORRADE_COMPARE(queue.transformationMatrices().size(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::DrawableQueueTest)
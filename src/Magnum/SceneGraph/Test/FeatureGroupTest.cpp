@@ -0,0 +1,233 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneGraph/AbstractGroupedFeature.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FeatureGroupTest: TestSuite::Tester {
+    explicit FeatureGroupTest();
+
+    void add();
+    void addMultiple();
+    void addFromOtherGroup();
+    void remove();
+    void removeMultiple();
+    void removeNotInGroup();
+    void clear();
+    void destruct();
+};
+
+FeatureGroupTest::FeatureGroupTest() {
+    addTests({&FeatureGroupTest::add,
+              &FeatureGroupTest::addMultiple,
+              &FeatureGroupTest::addFromOtherGroup,
+              &FeatureGroupTest::remove,
+              &FeatureGroupTest::removeMultiple,
+              &FeatureGroupTest::removeNotInGroup,
+              &FeatureGroupTest::clear,
+              &FeatureGroupTest::destruct});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+class Feature: public AbstractGroupedFeature3D<Feature> {
+    public:
+        explicit Feature(AbstractObject3D& object, FeatureGroup3D<Feature>* group = nullptr): AbstractGroupedFeature3D<Feature>{object, group} {}
+};
+
+typedef FeatureGroup3D<Feature> FeatureGroup;
+
+void FeatureGroupTest::add() {
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene};
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(a.group(), &group);
+    CORRADE_COMPARE(b.group(), nullptr);
+
+    group.add(b);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &b);
+    CORRADE_COMPARE(b.group(), &group);
+}
+
+void FeatureGroupTest::addMultiple() {
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene};
+    Feature c{scene};
+
+    group.add({b, c});
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &b);
+    CORRADE_COMPARE(&group[2], &c);
+    CORRADE_COMPARE(c.group(), &group);
+}
+
+void FeatureGroupTest::addFromOtherGroup() {
+    Scene3D scene;
+    FeatureGroup group1;
+    FeatureGroup group2;
+    Feature a{scene, &group1};
+    Feature b{scene, &group1};
+    Feature c{scene, &group1};
+
+    /* The feature gets removed from the original group, the index of the
+       feature moved in its place is updated so it can be removed later */
+    group2.add(a);
+    CORRADE_COMPARE(group1.size(), 2);
+    CORRADE_COMPARE(&group1[0], &c);
+    CORRADE_COMPARE(&group1[1], &b);
+    CORRADE_COMPARE(group2.size(), 1);
+    CORRADE_COMPARE(a.group(), &group2);
+
+    group1.remove(c);
+    CORRADE_COMPARE(group1.size(), 1);
+    CORRADE_COMPARE(&group1[0], &b);
+}
+
+void FeatureGroupTest::remove() {
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene, &group};
+    Feature c{scene, &group};
+    Feature d{scene, &group};
+
+    /* The last feature is moved in place of the removed one */
+    group.remove(b);
+    CORRADE_COMPARE(b.group(), nullptr);
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &d);
+    CORRADE_COMPARE(&group[2], &c);
+
+    /* Removing the moved and the last feature works as well */
+    group.remove(d);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &c);
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 1);
+    CORRADE_COMPARE(&group[0], &a);
+    group.remove(a);
+    CORRADE_VERIFY(group.isEmpty());
+}
+
+void FeatureGroupTest::removeMultiple() {
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene, &group};
+    Feature c{scene, &group};
+    Feature d{scene, &group};
+    Feature e{scene, &group};
+
+    /* The relative order is preserved */
+    group.remove({d, b});
+    CORRADE_COMPARE(b.group(), nullptr);
+    CORRADE_COMPARE(d.group(), nullptr);
+    CORRADE_COMPARE(group.size(), 3);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &c);
+    CORRADE_COMPARE(&group[2], &e);
+
+    /* Indices are updated so single removal works after */
+    group.remove(c);
+    CORRADE_COMPARE(group.size(), 2);
+    CORRADE_COMPARE(&group[0], &a);
+    CORRADE_COMPARE(&group[1], &e);
+}
+
+void FeatureGroupTest::removeNotInGroup() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    group.remove(b);
+    group.remove({a, b});
+    group.remove({a, a});
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group\n"
+        "SceneGraph::AbstractFeatureGroup::remove(): feature is not part of this group\n"
+        "SceneGraph::AbstractFeatureGroup::remove(): feature listed more than once\n");
+
+    /* The group is in an inconsistent state after the last assertion, reset
+       it to avoid accessing the destroyed feature from group destructor */
+    group.clear();
+}
+
+void FeatureGroupTest::clear() {
+    Scene3D scene;
+    FeatureGroup group;
+    Feature a{scene, &group};
+    Feature b{scene, &group};
+
+    group.clear();
+    CORRADE_VERIFY(group.isEmpty());
+    CORRADE_COMPARE(a.group(), nullptr);
+    CORRADE_COMPARE(b.group(), nullptr);
+
+    /* The features can be added again */
+    group.add({b, a});
+    CORRADE_COMPARE(&group[0], &b);
+    CORRADE_COMPARE(&group[1], &a);
+}
+
+void FeatureGroupTest::destruct() {
+    Scene3D scene;
+    Feature a{scene};
+    {
+        FeatureGroup group;
+        group.add(a);
+        CORRADE_COMPARE(a.group(), &group);
+    }
+
+    CORRADE_COMPARE(a.group(), nullptr);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FeatureGroupTest)
@@ -0,0 +1,219 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/FlattenedScene.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct FlattenedSceneTest: TestSuite::Tester {
+    explicit FlattenedSceneTest();
+
+    void construct();
+    void update();
+    void updateSubtree();
+    void rebuild();
+    void outOfRange();
+};
+
+FlattenedSceneTest::FlattenedSceneTest() {
+    addTests({&FlattenedSceneTest::construct,
+              &FlattenedSceneTest::update,
+              &FlattenedSceneTest::updateSubtree,
+              &FlattenedSceneTest::rebuild,
+              &FlattenedSceneTest::outOfRange});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::FlattenedScene<SceneGraph::MatrixTransformation3D> FlattenedScene3D;
+
+class CachingObject: public Object3D, AbstractFeature3D {
+    public:
+        CachingObject(Object3D* parent = nullptr): Object3D(parent), AbstractFeature3D{*this} {
+            setCachedTransformations(CachedTransformation::Absolute);
+        }
+
+        Matrix4 cleanedAbsoluteTransformation;
+        Int cleanCount{};
+
+    protected:
+        void clean(const Matrix4& absoluteTransformation) override {
+            cleanedAbsoluteTransformation = absoluteTransformation;
+            ++cleanCount;
+        }
+};
+
+void FlattenedSceneTest::construct() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    CachingObject b{&scene};
+    CachingObject aa{&a};
+    CachingObject ba{&b};
+    CachingObject aaa{&aa};
+    a.translate(Vector3::xAxis(1.0f));
+    aa.translate(Vector3::yAxis(2.0f));
+    aaa.scale(Vector3{3.0f});
+    ba.translate(Vector3::zAxis(4.0f));
+
+    FlattenedScene3D flattened{scene};
+    CORRADE_COMPARE(&flattened.scene(), &scene);
+
+    /* Breadth-first order with the scene first */
+    CORRADE_COMPARE(flattened.size(), 6);
+    CORRADE_COMPARE(&flattened.object(0), &scene);
+    CORRADE_COMPARE(&flattened.object(1), &a);
+    CORRADE_COMPARE(&flattened.object(2), &b);
+    CORRADE_COMPARE(&flattened.object(3), &aa);
+    CORRADE_COMPARE(&flattened.object(4), &ba);
+    CORRADE_COMPARE(&flattened.object(5), &aaa);
+    CORRADE_COMPARE(flattened.parent(0), 0xffffffffu);
+    CORRADE_COMPARE(flattened.parent(1), 0);
+    CORRADE_COMPARE(flattened.parent(2), 0);
+    CORRADE_COMPARE(flattened.parent(3), 1);
+    CORRADE_COMPARE(flattened.parent(4), 2);
+    CORRADE_COMPARE(flattened.parent(5), 3);
+
+    /* All objects got cleaned with the same transformation as calculated by
+       Object itself */
+    for(std::size_t i = 0; i != flattened.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(!flattened.object(i).isDirty());
+        CORRADE_COMPARE(flattened.absoluteTransformationMatrix(i),
+            flattened.object(i).absoluteTransformationMatrix());
+    }
+    CORRADE_COMPARE(aaa.cleanCount, 1);
+    CORRADE_COMPARE(aaa.cleanedAbsoluteTransformation, aaa.absoluteTransformationMatrix());
+    CORRADE_COMPARE(ba.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::zAxis(4.0f)));
+}
+
+void FlattenedSceneTest::update() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    CachingObject b{&scene};
+    CachingObject aa{&a};
+
+    FlattenedScene3D flattened{scene};
+    CORRADE_COMPARE(a.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(aa.cleanCount, 1);
+
+    /* Nothing dirty, nothing to do */
+    CORRADE_COMPARE(flattened.update(), 0);
+    CORRADE_COMPARE(a.cleanCount, 1);
+
+    /* Only the leaf is updated */
+    aa.translate(Vector3::xAxis(1.0f));
+    CORRADE_COMPARE(flattened.update(), 1);
+    CORRADE_COMPARE(a.cleanCount, 1);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(aa.cleanCount, 2);
+    CORRADE_VERIFY(!aa.isDirty());
+    CORRADE_COMPARE(aa.cleanedAbsoluteTransformation, Matrix4::translation(Vector3::xAxis(1.0f)));
+    CORRADE_COMPARE(flattened.absoluteTransformationMatrix(3), aa.absoluteTransformationMatrix());
+}
+
+void FlattenedSceneTest::updateSubtree() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    CachingObject b{&scene};
+    CachingObject aa{&a};
+    CachingObject aaa{&aa};
+    aaa.translate(Vector3::zAxis(3.0f));
+
+    FlattenedScene3D flattened{scene};
+
+    /* Transforming an object updates its whole subtree but not siblings */
+    a.scale(Vector3{2.0f});
+    CORRADE_COMPARE(flattened.update(), 3);
+    CORRADE_COMPARE(a.cleanCount, 2);
+    CORRADE_COMPARE(b.cleanCount, 1);
+    CORRADE_COMPARE(aa.cleanCount, 2);
+    CORRADE_COMPARE(aaa.cleanCount, 2);
+    CORRADE_COMPARE(aaa.cleanedAbsoluteTransformation,
+        Matrix4::scaling(Vector3{2.0f})*Matrix4::translation(Vector3::zAxis(3.0f)));
+    for(std::size_t i = 0; i != flattened.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(flattened.absoluteTransformationMatrix(i),
+            flattened.object(i).absoluteTransformationMatrix());
+    }
+}
+
+void FlattenedSceneTest::rebuild() {
+    Scene3D scene;
+    CachingObject a{&scene};
+    CachingObject b{&scene};
+    a.translate(Vector3::xAxis(1.0f));
+    b.translate(Vector3::yAxis(2.0f));
+
+    FlattenedScene3D flattened{scene};
+    CORRADE_COMPARE(flattened.size(), 3);
+
+    /* Reparenting makes the object dirty, rebuild picks up the new
+       hierarchy */
+    b.setParent(&a);
+    CachingObject c{&b};
+    flattened.rebuild();
+    CORRADE_COMPARE(flattened.size(), 4);
+    CORRADE_COMPARE(&flattened.object(2), &b);
+    CORRADE_COMPARE(&flattened.object(3), &c);
+    CORRADE_COMPARE(flattened.parent(2), 1);
+    CORRADE_COMPARE(flattened.parent(3), 2);
+    CORRADE_VERIFY(!b.isDirty());
+    CORRADE_VERIFY(!c.isDirty());
+    CORRADE_COMPARE(c.cleanedAbsoluteTransformation,
+        Matrix4::translation({1.0f, 2.0f, 0.0f}));
+    CORRADE_COMPARE(flattened.absoluteTransformationMatrix(3),
+        c.absoluteTransformationMatrix());
+}
+
+void FlattenedSceneTest::outOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+    Object3D a{&scene};
+    FlattenedScene3D flattened{scene};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    flattened.object(2);
+    flattened.parent(2);
+    flattened.absoluteTransformation(2);
+    CORRADE_COMPARE(out.str(),
+        "SceneGraph::FlattenedScene::object(): index 2 out of range for 2 objects\n"
+        "SceneGraph::FlattenedScene::parent(): index 2 out of range for 2 objects\n"
+        "SceneGraph::FlattenedScene::absoluteTransformation(): index 2 out of range for 2 objects\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::FlattenedSceneTest)
@@ -0,0 +1,277 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/ObjectPool.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct ObjectPoolTest: TestSuite::Tester {
+    explicit ObjectPoolTest();
+
+    void construct();
+    void constructNoTransformations();
+    void constructEmpty();
+    void constructMove();
+    void constructInvalidTransformationCount();
+    void constructParentOutOfRange();
+    void constructParentCycle();
+
+    void destructReparented();
+    void destructNonPooledChildren();
+
+    void objectOutOfRange();
+};
+
+ObjectPoolTest::ObjectPoolTest() {
+    addTests({&ObjectPoolTest::construct,
+              &ObjectPoolTest::constructNoTransformations,
+              &ObjectPoolTest::constructEmpty,
+              &ObjectPoolTest::constructMove,
+              &ObjectPoolTest::constructInvalidTransformationCount,
+              &ObjectPoolTest::constructParentOutOfRange,
+              &ObjectPoolTest::constructParentCycle,
+
+              &ObjectPoolTest::destructReparented,
+              &ObjectPoolTest::destructNonPooledChildren,
+
+              &ObjectPoolTest::objectOutOfRange});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+typedef SceneGraph::ObjectPool<SceneGraph::MatrixTransformation3D> ObjectPool3D;
+
+void ObjectPoolTest::construct() {
+    Scene3D scene;
+    Object3D other{&scene};
+
+    /* Children are listed after parents on purpose to verify the order
+       doesn't matter */
+    const Int parents[]{3, -1, 3, -1, 0};
+    const Matrix4 transformations[]{
+        Matrix4::translation(Vector3::xAxis(1.0f)),
+        Matrix4::translation(Vector3::yAxis(2.0f)),
+        Matrix4::scaling(Vector3{3.0f}),
+        Matrix4::translation(Vector3::zAxis(4.0f)),
+        Matrix4::translation(Vector3::xAxis(5.0f))
+    };
+
+    {
+        ObjectPool3D pool{scene, parents, transformations};
+        CORRADE_COMPARE(pool.size(), 5);
+        CORRADE_COMPARE(pool.objects().size(), 5);
+        CORRADE_COMPARE(&pool.objects()[2], &pool.object(2));
+
+        /* Top-level objects are appended after existing children in index
+           order */
+        CORRADE_COMPARE(scene.children().first(), &other);
+        CORRADE_COMPARE(other.nextSibling(), &pool.object(1));
+        CORRADE_COMPARE(pool.object(1).nextSibling(), &pool.object(3));
+        CORRADE_COMPARE(pool.object(3).nextSibling(), nullptr);
+
+        CORRADE_COMPARE(pool.object(3).children().first(), &pool.object(0));
+        CORRADE_COMPARE(pool.object(0).nextSibling(), &pool.object(2));
+        CORRADE_COMPARE(pool.object(0).children().first(), &pool.object(4));
+        CORRADE_VERIFY(pool.object(1).children().isEmpty());
+
+        for(std::size_t i = 0; i != pool.size(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_VERIFY(pool.object(i).isDirty());
+            CORRADE_COMPARE(pool.object(i).scene(), &scene);
+            CORRADE_COMPARE(pool.object(i).transformation(), transformations[i]);
+        }
+
+        CORRADE_COMPARE(pool.object(4).absoluteTransformationMatrix(),
+            Matrix4::translation({6.0f, 0.0f, 4.0f}));
+    }
+
+    /* The pooled objects are detached from the scene on destruction, other
+       objects are kept */
+    CORRADE_COMPARE(scene.children().first(), &other);
+    CORRADE_COMPARE(scene.children().last(), &other);
+}
+
+void ObjectPoolTest::constructNoTransformations() {
+    Scene3D scene;
+
+    const Int parents[]{-1, 0};
+    ObjectPool3D pool{scene, parents};
+    CORRADE_COMPARE(pool.size(), 2);
+    CORRADE_COMPARE(pool.object(1).parent(), &pool.object(0));
+    CORRADE_COMPARE(pool.object(0).transformation(), Matrix4{});
+    CORRADE_COMPARE(pool.object(1).transformation(), Matrix4{});
+}
+
+void ObjectPoolTest::constructEmpty() {
+    Scene3D scene;
+
+    ObjectPool3D pool{scene, Containers::StridedArrayView1D<const Int>{}};
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void ObjectPoolTest::constructMove() {
+    Scene3D scene;
+
+    const Int parents[]{-1, 0};
+    ObjectPool3D a{scene, parents};
+    Object3D* first = &a.object(0);
+
+    ObjectPool3D b{std::move(a)};
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(b.size(), 2);
+    CORRADE_COMPARE(&b.object(0), first);
+
+    const Int otherParents[]{-1};
+    ObjectPool3D c{scene, otherParents};
+    c = std::move(b);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(&c.object(0), first);
+    CORRADE_COMPARE(scene.children().first(), first);
+}
+
+void ObjectPoolTest::constructInvalidTransformationCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+
+    const Int parents[]{-1, 0};
+    const Matrix4 transformations[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ObjectPool3D pool{scene, parents, transformations};
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool: expected 2 transformations but got 1\n");
+}
+
+void ObjectPoolTest::constructParentOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+
+    const Int parents[]{-1, 0, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ObjectPool3D pool{scene, parents};
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_VERIFY(scene.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool: parent index 3 for object 2 out of range for 3 objects\n");
+}
+
+void ObjectPoolTest::constructParentCycle() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+
+    /* 0 is fine, 1 -> 3 -> 2 -> 1 is a cycle */
+    const Int parents[]{-1, 3, 1, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ObjectPool3D pool{scene, parents};
+    CORRADE_COMPARE(pool.size(), 0);
+    CORRADE_VERIFY(scene.children().isEmpty());
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool: parent of object 2 forms a cycle\n");
+}
+
+void ObjectPoolTest::destructReparented() {
+    Scene3D scene;
+    Object3D other{&scene};
+
+    {
+        const Int parents[]{-1, 0};
+        ObjectPool3D pool{scene, parents};
+
+        /* Reparenting pooled objects to non-pooled objects and vice versa
+           works as usual */
+        pool.object(1).setParent(&other);
+        pool.object(0).setParent(&pool.object(1));
+        CORRADE_COMPARE(other.children().first(), &pool.object(1));
+        CORRADE_COMPARE(pool.object(0).parent(), &pool.object(1));
+    }
+
+    CORRADE_VERIFY(other.children().isEmpty());
+    CORRADE_COMPARE(scene.children().first(), &other);
+    CORRADE_COMPARE(scene.children().last(), &other);
+}
+
+void ObjectPoolTest::destructNonPooledChildren() {
+    struct DestructionCounter: Object3D {
+        explicit DestructionCounter(Object3D* parent, Int& destructed): Object3D{parent}, _destructed(destructed) {}
+        ~DestructionCounter() { ++_destructed; }
+
+        Int& _destructed;
+    };
+
+    Scene3D scene;
+    Int destructed = 0;
+
+    {
+        const Int parents[]{-1};
+        ObjectPool3D pool{scene, parents};
+
+        /* Non-pooled children are owned by their pooled parents */
+        new DestructionCounter{&pool.object(0), destructed};
+        new DestructionCounter{&pool.object(0), destructed};
+    }
+
+    CORRADE_COMPARE(destructed, 2);
+    CORRADE_VERIFY(scene.children().isEmpty());
+}
+
+void ObjectPoolTest::objectOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D scene;
+
+    const Int parents[]{-1, 0};
+    ObjectPool3D pool{scene, parents};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    pool.object(2);
+    CORRADE_COMPARE(out.str(), "SceneGraph::ObjectPool::object(): index 2 out of range for 2 objects\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::ObjectPoolTest)
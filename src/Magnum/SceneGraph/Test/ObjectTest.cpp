@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
 #include <sstream>
 #include <Corrade/Containers/Pointer.h>
 #include <Corrade/TestSuite/Tester.h>
@@ -51,6 +52,9 @@ struct ObjectTest: TestSuite::Tester {
     template<class T> void transformationsRelative();
     template<class T> void transformationsOrphan();
     template<class T> void transformationsDuplicate();
+    template<class T> void transformationsThreaded();
+    template<class T> void jointMatrices();
+    template<class T> void jointMatricesInvalid();
     template<class T> void setClean();
     template<class T> void setCleanListHierarchy();
     template<class T> void setCleanListBulk();
@@ -86,6 +90,12 @@ ObjectTest::ObjectTest() {
         &ObjectTest::transformationsOrphan<Double>,
         &ObjectTest::transformationsDuplicate<Float>,
         &ObjectTest::transformationsDuplicate<Double>,
+        &ObjectTest::transformationsThreaded<Float>,
+        &ObjectTest::transformationsThreaded<Double>,
+        &ObjectTest::jointMatrices<Float>,
+        &ObjectTest::jointMatrices<Double>,
+        &ObjectTest::jointMatricesInvalid<Float>,
+        &ObjectTest::jointMatricesInvalid<Double>,
         &ObjectTest::setClean<Float>,
         &ObjectTest::setClean<Double>,
         &ObjectTest::setCleanListHierarchy<Float>,
@@ -393,6 +403,110 @@ template<class T> void ObjectTest::transformationsDuplicate() {
     }));
 }
 
+template<class T> void ObjectTest::transformationsThreaded() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    /* A hierarchy large enough to be split across multiple threads, with
+       objects branching at various depths */
+    Scene3D<T> s;
+    s.translate(Math::Vector3<T>::yAxis(T(1.0)));
+    std::vector<Containers::Pointer<Object3D<T>>> objects;
+    for(std::size_t i = 0; i != 12000; ++i) {
+        Object3D<T>* parent = i < 5 ? &s : objects[(i - 5)/3].get();
+        objects.emplace_back(new Object3D<T>{parent});
+        objects.back()->rotateZ(Math::Deg<T>(T(i%360)))
+            .translate(Math::Vector3<T>::xAxis(T(i%7)));
+    }
+
+    /* Only every other object, so the paths go through non-joint objects as
+       well, some objects duplicated and the scene as well */
+    std::vector<std::reference_wrapper<Object3D<T>>> list;
+    for(std::size_t i = 0; i < objects.size(); i += 2)
+        list.push_back(*objects[i]);
+    for(std::size_t i = 1; i < objects.size(); i += 97)
+        list.push_back(*objects[i]);
+    for(std::size_t i = 0; i < objects.size(); i += 89)
+        list.push_back(*objects[i]);
+    list.push_back(s);
+
+    const Math::Matrix4<T> initial = Math::Matrix4<T>::rotationX(Math::Deg<T>{90.0}).inverted();
+    const std::vector<Math::Matrix4<T>> expected = s.transformations(list, initial);
+    CORRADE_COMPARE(expected.size(), list.size());
+    CORRADE_COMPARE(expected[10], initial*s.transformation()*objects[0]->transformation()*objects[5]->transformation()*objects[20]->transformation());
+    CORRADE_COMPARE(expected.back(), initial*s.transformation());
+
+    /* The output should be bit-exact independently of the thread count and
+       the objects should have all marks cleaned up, so repeated calls work */
+    for(UnsignedInt threadCount: {1, 2, 3, 8, 0}) {
+        CORRADE_ITERATION(threadCount);
+        const std::vector<Math::Matrix4<T>> transformations = s.transformations(list, initial, threadCount);
+        CORRADE_COMPARE(transformations.size(), expected.size());
+        std::size_t different = 0;
+        for(std::size_t i = 0; i != expected.size(); ++i)
+            if(std::memcmp(transformations[i].data(), expected[i].data(), sizeof(Math::Matrix4<T>)) != 0) ++different;
+        CORRADE_COMPARE(different, 0);
+    }
+
+    /* Matrix variant */
+    CORRADE_COMPARE(s.transformationMatrices(list, initial, 4), s.transformationMatrices(list, initial));
+}
+
+template<class T> void ObjectTest::jointMatrices() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    Scene3D<T> s;
+    Object3D<T> mesh{&s};
+    mesh.translate(Math::Vector3<T>::zAxis(T(-3.0)));
+    Object3D<T> root{&s};
+    root.rotateZ(Math::Deg<T>{30.0});
+    Object3D<T> child{&root};
+    child.translate(Math::Vector3<T>::xAxis(T(2.0)));
+
+    const Math::Matrix4<T> inverseBindMatrices[]{
+        Math::Matrix4<T>::scaling(Math::Vector3<T>{T(0.5)}),
+        Math::Matrix4<T>::translation(Math::Vector3<T>::xAxis(T(-2.0))),
+        Math::Matrix4<T>::scaling(Math::Vector3<T>{T(0.5)})
+    };
+    const Math::Matrix4<T> meshInverted = mesh.absoluteTransformationMatrix().inverted();
+
+    /* The joints are relative to the skinned mesh, combined with the inverse
+       bind matrices; duplicates are allowed */
+    Math::Matrix4<T> out[3];
+    s.jointMatricesInto({root, child, root}, inverseBindMatrices, meshInverted, out);
+    CORRADE_COMPARE(out[0], meshInverted*root.transformationMatrix()*inverseBindMatrices[0]);
+    CORRADE_COMPARE(out[1], meshInverted*root.transformationMatrix()*child.transformationMatrix()*inverseBindMatrices[1]);
+    CORRADE_COMPARE(out[2], out[0]);
+
+    /* Same output with multiple threads */
+    Math::Matrix4<T> outThreaded[3];
+    s.jointMatricesInto({root, child, root}, inverseBindMatrices, meshInverted, outThreaded, 4);
+    CORRADE_COMPARE(outThreaded[0], out[0]);
+    CORRADE_COMPARE(outThreaded[1], out[1]);
+    CORRADE_COMPARE(outThreaded[2], out[2]);
+}
+
+template<class T> void ObjectTest::jointMatricesInvalid() {
+    setTestCaseTemplateName(Math::TypeTraits<T>::name());
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Scene3D<T> s;
+    Object3D<T> a{&s};
+    Object3D<T> b{&s};
+    Math::Matrix4<T> inverseBindMatrices[2];
+    Math::Matrix4<T> out[3];
+
+    std::ostringstream o;
+    Error redirectError{&o};
+    s.jointMatricesInto({a, b, a}, inverseBindMatrices, {}, out);
+    s.jointMatricesInto({a, b}, inverseBindMatrices, {}, out);
+    CORRADE_COMPARE(o.str(),
+        "SceneGraph::Object::jointMatricesInto(): expected 3 inverse bind matrices but got 2\n"
+        "SceneGraph::Object::jointMatricesInto(): expected output view to have 2 items but got 3\n");
+}
+
 template<class T> void ObjectTest::setClean() {
     setTestCaseTemplateName(Math::TypeTraits<T>::name());
 
@@ -0,0 +1,302 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <cstdint>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/SceneGraph/AbstractFeature.h"
+#include "Magnum/SceneGraph/MatrixTransformation3D.h"
+#include "Magnum/SceneGraph/PoolAllocator.h"
+#include "Magnum/SceneGraph/Scene.h"
+
+namespace Magnum { namespace SceneGraph { namespace Test { namespace {
+
+struct PoolAllocatorTest: TestSuite::Tester {
+    explicit PoolAllocatorTest();
+
+    void construct();
+    void constructZeroChunkSize();
+    void constructCopy();
+
+    void allocate();
+    void allocateRecycle();
+    void reserve();
+    void deallocateWrongAllocator();
+    void destructNotEmpty();
+
+    void object();
+    void objectDerived();
+    void feature();
+};
+
+PoolAllocatorTest::PoolAllocatorTest() {
+    addTests({&PoolAllocatorTest::construct,
+              &PoolAllocatorTest::constructZeroChunkSize,
+              &PoolAllocatorTest::constructCopy,
+
+              &PoolAllocatorTest::allocate,
+              &PoolAllocatorTest::allocateRecycle,
+              &PoolAllocatorTest::reserve,
+              &PoolAllocatorTest::deallocateWrongAllocator,
+              &PoolAllocatorTest::destructNotEmpty,
+
+              &PoolAllocatorTest::object,
+              &PoolAllocatorTest::objectDerived,
+              &PoolAllocatorTest::feature});
+}
+
+typedef SceneGraph::Object<SceneGraph::MatrixTransformation3D> Object3D;
+typedef SceneGraph::Scene<SceneGraph::MatrixTransformation3D> Scene3D;
+
+void PoolAllocatorTest::construct() {
+    PoolAllocator<Vector3d> allocator{16};
+    CORRADE_COMPARE(allocator.chunkSize(), 16);
+    CORRADE_COMPARE(allocator.chunkCount(), 0);
+    CORRADE_COMPARE(allocator.capacity(), 0);
+    CORRADE_COMPARE(allocator.size(), 0);
+}
+
+void PoolAllocatorTest::constructZeroChunkSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    PoolAllocator<Vector3d>{0};
+    CORRADE_COMPARE(out.str(), "SceneGraph::PoolAllocator: expected non-zero chunk size\n");
+}
+
+void PoolAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<PoolAllocator<Vector3d>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<PoolAllocator<Vector3d>>{});
+    CORRADE_VERIFY(!std::is_move_constructible<PoolAllocator<Vector3d>>{});
+    CORRADE_VERIFY(!std::is_move_assignable<PoolAllocator<Vector3d>>{});
+}
+
+void PoolAllocatorTest::allocate() {
+    PoolAllocator<Vector3d> allocator{3};
+
+    void* a = allocator.allocate();
+    CORRADE_COMPARE(allocator.chunkCount(), 1);
+    CORRADE_COMPARE(allocator.capacity(), 3);
+    CORRADE_COMPARE(allocator.size(), 1);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a) % alignof(Vector3d), 0);
+
+    /* Instances in a chunk are allocated in increasing memory order */
+    void* b = allocator.allocate();
+    void* c = allocator.allocate();
+    CORRADE_VERIFY(b > a);
+    CORRADE_VERIFY(c > b);
+    CORRADE_COMPARE(allocator.chunkCount(), 1);
+    CORRADE_COMPARE(allocator.size(), 3);
+
+    /* The chunk is full, a new one gets added */
+    void* d = allocator.allocate();
+    CORRADE_COMPARE(allocator.chunkCount(), 2);
+    CORRADE_COMPARE(allocator.capacity(), 6);
+    CORRADE_COMPARE(allocator.size(), 4);
+
+    /* The memory is usable */
+    *static_cast<Vector3d*>(a) = {1.0, 2.0, 3.0};
+    *static_cast<Vector3d*>(d) = {4.0, 5.0, 6.0};
+    CORRADE_COMPARE(*static_cast<Vector3d*>(a), (Vector3d{1.0, 2.0, 3.0}));
+    CORRADE_COMPARE(*static_cast<Vector3d*>(d), (Vector3d{4.0, 5.0, 6.0}));
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(c);
+    allocator.deallocate(d);
+    CORRADE_COMPARE(allocator.size(), 0);
+    CORRADE_COMPARE(allocator.capacity(), 6);
+}
+
+void PoolAllocatorTest::allocateRecycle() {
+    PoolAllocator<Vector3d> allocator{4};
+
+    void* a = allocator.allocate();
+    void* b = allocator.allocate();
+    void* c = allocator.allocate();
+
+    /* Most recently freed slots get reused first */
+    allocator.deallocate(a);
+    allocator.deallocate(c);
+    CORRADE_COMPARE(allocator.size(), 1);
+    CORRADE_COMPARE(allocator.allocate(), c);
+    CORRADE_COMPARE(allocator.allocate(), a);
+    CORRADE_COMPARE(allocator.size(), 3);
+    CORRADE_COMPARE(allocator.chunkCount(), 1);
+
+    allocator.deallocate(a);
+    allocator.deallocate(b);
+    allocator.deallocate(c);
+}
+
+void PoolAllocatorTest::reserve() {
+    PoolAllocator<Vector3d> allocator{4};
+
+    allocator.reserve(9);
+    CORRADE_COMPARE(allocator.chunkCount(), 3);
+    CORRADE_COMPARE(allocator.capacity(), 12);
+    CORRADE_COMPARE(allocator.size(), 0);
+
+    /* Smaller capacity is a no-op */
+    allocator.reserve(5);
+    CORRADE_COMPARE(allocator.chunkCount(), 3);
+
+    /* Allocating up to the capacity doesn't add any chunks */
+    void* pointers[12];
+    for(void*& i: pointers) i = allocator.allocate();
+    CORRADE_COMPARE(allocator.chunkCount(), 3);
+    CORRADE_COMPARE(allocator.size(), 12);
+    for(void* i: pointers) allocator.deallocate(i);
+}
+
+void PoolAllocatorTest::deallocateWrongAllocator() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    PoolAllocator<Vector3d> a, b;
+    void* pointer = a.allocate();
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        b.deallocate(pointer);
+    }
+    CORRADE_COMPARE(out.str(), "SceneGraph::PoolAllocator::deallocate(): the pointer is not allocated from this allocator\n");
+    CORRADE_COMPARE(b.size(), 0);
+
+    a.deallocate(pointer);
+}
+
+void PoolAllocatorTest::destructNotEmpty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    {
+        PoolAllocator<Vector3d> allocator;
+        allocator.allocate();
+        allocator.allocate();
+    }
+    CORRADE_COMPARE(out.str(), "SceneGraph::PoolAllocator: destroyed with 2 instances still allocated\n");
+}
+
+struct PooledObject: Object3D, PoolAllocated<PooledObject> {
+    explicit PooledObject(Object3D* parent, Int& destructed): Object3D{parent}, destructed(destructed) {}
+    ~PooledObject() { ++destructed; }
+
+    Int& destructed;
+};
+
+void PoolAllocatorTest::object() {
+    Int destructed = 0;
+
+    /* The allocator has to outlive the scene */
+    PoolAllocator<PooledObject> allocator{8};
+    {
+        Scene3D scene;
+        PooledObject* a = new(allocator) PooledObject{&scene, destructed};
+        PooledObject* b = new(allocator) PooledObject{a, destructed};
+        new(allocator) PooledObject{a, destructed};
+        new(allocator) PooledObject{&scene, destructed};
+        CORRADE_COMPARE(allocator.size(), 4);
+        CORRADE_COMPARE(b->parent(), a);
+
+        /* Deleting an object deletes also its children */
+        delete a;
+        CORRADE_COMPARE(destructed, 3);
+        CORRADE_COMPARE(allocator.size(), 1);
+
+        /* Freed memory gets reused */
+        new(allocator) PooledObject{&scene, destructed};
+        CORRADE_COMPARE(allocator.size(), 2);
+        CORRADE_COMPARE(allocator.chunkCount(), 1);
+    }
+
+    /* The scene deleted the remaining objects */
+    CORRADE_COMPARE(destructed, 5);
+    CORRADE_COMPARE(allocator.size(), 0);
+}
+
+void PoolAllocatorTest::objectDerived() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct DerivedObject: PooledObject {
+        explicit DerivedObject(Object3D* parent, Int& destructed): PooledObject{parent, destructed} {}
+
+        Vector4d extra;
+    };
+
+    Int destructed = 0;
+    PoolAllocator<PooledObject> allocator;
+    Scene3D scene;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!new(allocator) DerivedObject{&scene, destructed});
+    CORRADE_COMPARE(allocator.size(), 0);
+    CORRADE_COMPARE(out.str(), Utility::formatString("SceneGraph::PoolAllocated: can't allocate {} bytes from a pool of {} byte instances\n", sizeof(DerivedObject), sizeof(PooledObject)));
+}
+
+struct PooledFeature: AbstractFeature3D, PoolAllocated<PooledFeature> {
+    explicit PooledFeature(AbstractObject3D& object, Int& destructed): AbstractFeature3D{object}, destructed(destructed) {}
+    ~PooledFeature() { ++destructed; }
+
+    Int& destructed;
+};
+
+void PoolAllocatorTest::feature() {
+    Int destructed = 0;
+
+    PoolAllocator<PooledFeature> allocator;
+    {
+        Scene3D scene;
+        Object3D* object = new Object3D{&scene};
+        new(allocator) PooledFeature{*object, destructed};
+        new(allocator) PooledFeature{*object, destructed};
+        CORRADE_COMPARE(allocator.size(), 2);
+
+        /* Features are deleted together with the object */
+        delete object;
+        CORRADE_COMPARE(destructed, 2);
+        CORRADE_COMPARE(allocator.size(), 0);
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::SceneGraph::Test::PoolAllocatorTest)
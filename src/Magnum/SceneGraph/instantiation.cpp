@@ -27,6 +27,8 @@
 #include "Magnum/SceneGraph/Animable.hpp"
 #include "Magnum/SceneGraph/Camera.hpp"
 #include "Magnum/SceneGraph/Drawable.hpp"
+#include "Magnum/SceneGraph/DrawableBvh.hpp"
+#include "Magnum/SceneGraph/DrawableQueue.hpp"
 #include "Magnum/SceneGraph/DualComplexTransformation.h"
 #include "Magnum/SceneGraph/DualQuaternionTransformation.h"
 #include "Magnum/SceneGraph/FeatureGroup.hpp"
@@ -71,6 +73,10 @@ template class MAGNUM_SCENEGRAPH_EXPORT_HPP Camera<3, Float>;
 
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<2, Float>;
 template class MAGNUM_SCENEGRAPH_EXPORT_HPP Drawable<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawableBvh<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawableBvh<3, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawableQueue<2, Float>;
+template class MAGNUM_SCENEGRAPH_EXPORT_HPP DrawableQueue<3, Float>;
 
 /* These have rotation(const Complex&) and rotation(const Quaternion&) defined
    in a hpp to avoid dragging in Complex / Quaternion for every user */
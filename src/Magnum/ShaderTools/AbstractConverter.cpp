@@ -25,13 +25,17 @@
 
 #include "AbstractConverter.h"
 
+#include <cstring>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/String.h>
 #include <Corrade/Containers/StringStl.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Sha1.h>
 
 #include "Magnum/FileCallback.h"
 
@@ -41,10 +45,97 @@
 
 namespace Magnum { namespace ShaderTools {
 
+namespace {
+
+/* Each cache file starts with this, followed by the recorded dependencies
+   (filename size, filename and SHA-1 digest of the contents for each) and the
+   output data itself */
+struct CacheHeader {
+    char magic[4];
+    UnsignedInt dependencyCount;
+};
+
+constexpr char CacheMagic[]{'M', 'S', 'C', '1'};
+constexpr std::size_t CacheDigestSize = 20;
+
+static_assert(sizeof(CacheHeader) == 8, "improper size of the cache file header");
+static_assert(sizeof(Utility::Sha1::Digest) == CacheDigestSize, "unexpected SHA-1 digest size");
+
+struct CacheDependency {
+    std::string filename;
+    Utility::Sha1::Digest digest;
+};
+
+/* Set as the input file callback for the duration of a cached conversion,
+   records all files the plugin loaded */
+struct CacheRecording {
+    Containers::Optional<Containers::ArrayView<const char>>(*callback)(const std::string&, InputFileCallbackPolicy, void*);
+    void* userData;
+    Containers::Array<CacheDependency> dependencies;
+    /* Used if there's no user callback. The temporary files are released
+       after the conversion, permanent ones only with the converter. */
+    Containers::Array<Containers::Array<char>> temporaryFiles;
+    Containers::Array<Containers::Array<char>> permanentFiles;
+};
+
+Containers::Optional<Containers::ArrayView<const char>> cacheRecordingInputFileCallback(const std::string& filename, const InputFileCallbackPolicy policy, void* const userData) {
+    CacheRecording& recording = *static_cast<CacheRecording*>(userData);
+
+    /* Delegate to the user callback, if there's any; otherwise load the file
+       from the filesystem */
+    Containers::Optional<Containers::ArrayView<const char>> data;
+    if(recording.callback)
+        data = recording.callback(filename, policy, recording.userData);
+    else if(policy != InputFileCallbackPolicy::Close && Utility::Directory::exists(filename)) {
+        Containers::Array<Containers::Array<char>>& files = policy == InputFileCallbackPolicy::LoadPermanent ? recording.permanentFiles : recording.temporaryFiles;
+        arrayAppend(files, Utility::Directory::read(filename));
+        data = Containers::ArrayView<const char>{files[files.size() - 1]};
+    }
+
+    if(policy != InputFileCallbackPolicy::Close && data)
+        arrayAppend(recording.dependencies, CacheDependency{filename, (Utility::Sha1{} << *data).digest()});
+
+    return data;
+}
+
+bool cacheDependencyMatches(Containers::Optional<Containers::ArrayView<const char>>(*const callback)(const std::string&, InputFileCallbackPolicy, void*), void* const userData, const std::string& filename, const Utility::Sha1::Digest& digest) {
+    if(callback) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = callback(filename, InputFileCallbackPolicy::LoadTemporary, userData);
+        if(!data) return false;
+        const bool matches = (Utility::Sha1{} << *data).digest() == digest;
+        callback(filename, InputFileCallbackPolicy::Close, userData);
+        return matches;
+    }
+
+    return Utility::Directory::exists(filename) &&
+        (Utility::Sha1{} << Utility::Directory::read(filename)).digest() == digest;
+}
+
+/* Including the size so concatenating differently split strings doesn't
+   result in the same hash */
+void cacheHashString(Utility::Sha1& sha1, const Containers::StringView string) {
+    sha1 << Utility::formatString("{} ", string.size()) << Containers::ArrayView<const char>{string.data(), string.size()};
+}
+
+}
+
+struct AbstractConverter::CacheState {
+    Containers::String directory;
+
+    /* Recorded by the setters as there's no way to query the configuration
+       from the plugin. Definitions are serialized into a string directly. */
+    Format inputFormat{}, outputFormat{};
+    Containers::String inputFormatVersion, outputFormatVersion;
+    std::string definitions;
+    Containers::String optimizationLevel, debugInfoLevel;
+
+    CacheRecording recording{};
+};
+
 std::string AbstractConverter::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.ShaderTools.AbstractConverter/0.1"
+"cz.mosra.magnum.ShaderTools.AbstractConverter/0.1.1"
 /* [interface] */
     ;
 }
@@ -71,11 +162,13 @@ std::vector<std::string> AbstractConverter::pluginSearchPaths() {
 }
 #endif
 
-AbstractConverter::AbstractConverter() = default;
+AbstractConverter::AbstractConverter(): _cache{Containers::InPlaceInit} {}
+
+AbstractConverter::AbstractConverter(PluginManager::Manager<AbstractConverter>& manager): PluginManager::AbstractManagingPlugin<AbstractConverter>{manager}, _cache{Containers::InPlaceInit} {}
 
-AbstractConverter::AbstractConverter(PluginManager::Manager<AbstractConverter>& manager): PluginManager::AbstractManagingPlugin<AbstractConverter>{manager} {}
+AbstractConverter::AbstractConverter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractConverter>{manager, plugin}, _cache{Containers::InPlaceInit} {}
 
-AbstractConverter::AbstractConverter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractConverter>{manager, plugin} {}
+AbstractConverter::~AbstractConverter() = default;
 
 ConverterFeatures AbstractConverter::features() const {
     const ConverterFeatures features = doFeatures();
@@ -110,6 +203,8 @@ void AbstractConverter::setInputFileCallback(Containers::Optional<Containers::Ar
 void AbstractConverter::doSetInputFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*)(const std::string&, InputFileCallbackPolicy, void*), void*) {}
 
 void AbstractConverter::setInputFormat(const Format format, const Containers::StringView version) {
+    _cache->inputFormat = format;
+    _cache->inputFormatVersion = Containers::String{version};
     return doSetInputFormat(format, version);
 }
 
@@ -118,6 +213,8 @@ void AbstractConverter::setInputFormat(const Format format) {
 }
 
 void AbstractConverter::setOutputFormat(const Format format, const Containers::StringView version) {
+    _cache->outputFormat = format;
+    _cache->outputFormatVersion = Containers::String{version};
     return doSetOutputFormat(format, version);
 }
 
@@ -128,6 +225,21 @@ void AbstractConverter::setOutputFormat(const Format format) {
 void AbstractConverter::setDefinitions(const Containers::ArrayView<const std::pair<Containers::StringView, Containers::StringView>> definitions) {
     CORRADE_ASSERT(features() & ConverterFeature::Preprocess,
         "ShaderTools::AbstractConverter::setDefinitions(): feature not supported", );
+
+    /* A null value means the definition is undefined, which has to be
+       distinguished from an empty value */
+    std::string& serialized = _cache->definitions;
+    serialized.clear();
+    for(const std::pair<Containers::StringView, Containers::StringView>& definition: definitions) {
+        serialized += Utility::formatString("{} ", definition.first.size());
+        serialized.append(definition.first.data(), definition.first.size());
+        if(definition.second.data()) {
+            serialized += Utility::formatString(" {} ", definition.second.size());
+            serialized.append(definition.second.data(), definition.second.size());
+        } else serialized += " -";
+        serialized += '\n';
+    }
+
     doSetDefinitions(definitions);
 }
 
@@ -142,6 +254,7 @@ void AbstractConverter::doSetDefinitions(Containers::ArrayView<const std::pair<C
 void AbstractConverter::setOptimizationLevel(const Containers::StringView level) {
     CORRADE_ASSERT(features() & ConverterFeature::Optimize,
         "ShaderTools::AbstractConverter::setOptimizationLevel(): feature not supported", );
+    _cache->optimizationLevel = Containers::String{level};
     doSetOptimizationLevel(level);
 }
 
@@ -152,6 +265,7 @@ void AbstractConverter::doSetOptimizationLevel(Containers::StringView) {
 void AbstractConverter::setDebugInfoLevel(const Containers::StringView level) {
     CORRADE_ASSERT(features() & ConverterFeature::DebugInfo,
         "ShaderTools::AbstractConverter::setDebugInfoLevel(): feature not supported", );
+    _cache->debugInfoLevel = Containers::String{level};
     doSetDebugInfoLevel(level);
 }
 
@@ -159,6 +273,168 @@ void AbstractConverter::doSetDebugInfoLevel(Containers::StringView) {
     CORRADE_ASSERT_UNREACHABLE("ShaderTools::AbstractConverter::setDebugInfoLevel(): feature advertised but not implemented", );
 }
 
+Containers::StringView AbstractConverter::cacheDirectory() const {
+    return _cache->directory;
+}
+
+void AbstractConverter::setCacheDirectory(const Containers::StringView directory) {
+    _cache->directory = Containers::String{directory};
+}
+
+std::string AbstractConverter::cacheKey(const char* const operation, const Containers::ArrayView<const std::pair<Stage, Containers::ArrayView<const char>>> data) const {
+    const CacheState& state = *_cache;
+
+    Utility::Sha1 sha1;
+    cacheHashString(sha1, pluginInterface());
+    cacheHashString(sha1, plugin());
+    cacheHashString(sha1, operation);
+    /* Quiet and Verbose affect only the printed messages, not the output */
+    sha1 << Utility::formatString("{:x} {:x} {:x}\n",
+        UnsignedInt(_flags & ~(ConverterFlag::Quiet|ConverterFlag::Verbose)),
+        UnsignedInt(state.inputFormat), UnsignedInt(state.outputFormat));
+    cacheHashString(sha1, state.inputFormatVersion);
+    cacheHashString(sha1, state.outputFormatVersion);
+    cacheHashString(sha1, state.definitions);
+    cacheHashString(sha1, state.optimizationLevel);
+    cacheHashString(sha1, state.debugInfoLevel);
+    for(const std::pair<Stage, Containers::ArrayView<const char>>& i: data)
+        sha1 << Utility::formatString("{:x} {}\n", UnsignedInt(i.first), i.second.size()) << i.second;
+
+    return sha1.digest().hexString();
+}
+
+Containers::Array<char> AbstractConverter::cacheLoad(const std::string& key) {
+    const std::string filename = Utility::Directory::join(_cache->directory, key + ".cache");
+    if(!Utility::Directory::exists(filename)) return {};
+
+    /* Anything unexpected in the file is treated as a cache miss, the file
+       gets overwritten with a fresh result after */
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    CacheHeader header;
+    if(data.size() < sizeof(CacheHeader)) return {};
+    std::memcpy(&header, data, sizeof(CacheHeader));
+    if(std::memcmp(header.magic, CacheMagic, sizeof(CacheMagic)) != 0)
+        return {};
+
+    /* Verify that none of the recorded dependencies changed */
+    std::size_t offset = sizeof(CacheHeader);
+    for(UnsignedInt i = 0; i != header.dependencyCount; ++i) {
+        UnsignedInt size;
+        if(data.size() < offset + sizeof(UnsignedInt)) return {};
+        std::memcpy(&size, data + offset, sizeof(UnsignedInt));
+        offset += sizeof(UnsignedInt);
+
+        if(data.size() < offset + size + CacheDigestSize) return {};
+        const std::string dependency{data + offset, size};
+        offset += size;
+        const Utility::Sha1::Digest digest = Utility::Sha1::Digest::fromByteArray(data + offset);
+        offset += CacheDigestSize;
+
+        if(!cacheDependencyMatches(_inputFileCallback, _inputFileCallbackUserData, dependency, digest))
+            return {};
+    }
+
+    /* Copy the output to a new array to not have the caller deal with an
+       offset */
+    Containers::Array<char> out{Containers::NoInit, data.size() - offset};
+    std::memcpy(out, data + offset, out.size());
+    return out;
+}
+
+void AbstractConverter::cacheSave(const std::string& key, const Containers::ArrayView<const char> data) {
+    const Containers::ArrayView<const CacheDependency> dependencies = _cache->recording.dependencies;
+
+    std::size_t size = sizeof(CacheHeader) + data.size();
+    for(const CacheDependency& dependency: dependencies)
+        size += sizeof(UnsignedInt) + dependency.filename.size() + CacheDigestSize;
+
+    Containers::Array<char> out{Containers::NoInit, size};
+    CacheHeader header;
+    std::memcpy(header.magic, CacheMagic, sizeof(CacheMagic));
+    header.dependencyCount = dependencies.size();
+    std::memcpy(out, &header, sizeof(CacheHeader));
+    std::size_t offset = sizeof(CacheHeader);
+    for(const CacheDependency& dependency: dependencies) {
+        const UnsignedInt filenameSize = dependency.filename.size();
+        std::memcpy(out + offset, &filenameSize, sizeof(UnsignedInt));
+        offset += sizeof(UnsignedInt);
+        std::memcpy(out + offset, dependency.filename.data(), filenameSize);
+        offset += filenameSize;
+        std::memcpy(out + offset, dependency.digest.byteArray(), CacheDigestSize);
+        offset += CacheDigestSize;
+    }
+    std::memcpy(out + offset, data, data.size());
+
+    if(!Utility::Directory::mkpath(_cache->directory)) return;
+
+    /* Writing to a temporary file first so an interrupted write or another
+       converter instance never sees a partially written result */
+    const std::string filename = Utility::Directory::join(_cache->directory, key + ".cache");
+    const std::string temporary = filename + ".tmp";
+    if(Utility::Directory::write(temporary, out))
+        Utility::Directory::move(temporary, filename);
+}
+
+void AbstractConverter::cacheRecordBegin() {
+    CacheRecording& recording = _cache->recording;
+    recording.callback = _inputFileCallback;
+    recording.userData = _inputFileCallbackUserData;
+    arrayResize(recording.dependencies, 0);
+
+    /* If the plugin loads files through callbacks, intercept them. Plugins
+       can either query the callback through inputFileCallback() or get it
+       through doSetInputFileCallback(), so do both. */
+    if(doFeatures() & ConverterFeature::InputFileCallback) {
+        _inputFileCallback = cacheRecordingInputFileCallback;
+        _inputFileCallbackUserData = &recording;
+        doSetInputFileCallback(_inputFileCallback, _inputFileCallbackUserData);
+    }
+}
+
+void AbstractConverter::cacheRecordEnd() {
+    CacheRecording& recording = _cache->recording;
+    if(doFeatures() & ConverterFeature::InputFileCallback) {
+        _inputFileCallback = recording.callback;
+        _inputFileCallbackUserData = recording.userData;
+        doSetInputFileCallback(_inputFileCallback, _inputFileCallbackUserData);
+    }
+
+    recording.temporaryFiles = nullptr;
+}
+
+Containers::Array<char> AbstractConverter::cachedConvertDataToData(const Stage stage, const Containers::ArrayView<const char> data) {
+    if(_cache->directory.isEmpty()) return doConvertDataToData(stage, data);
+
+    const std::pair<Stage, Containers::ArrayView<const char>> input[]{{stage, data}};
+    const std::string key = cacheKey("convert", input);
+    Containers::Array<char> out = cacheLoad(key);
+    if(out) return out;
+
+    cacheRecordBegin();
+    out = doConvertDataToData(stage, data);
+    cacheRecordEnd();
+
+    /* Failures are not cached, a subsequent call will try again */
+    if(out) cacheSave(key, out);
+    return out;
+}
+
+Containers::Array<char> AbstractConverter::cachedLinkDataToData(const Containers::ArrayView<const std::pair<Stage, Containers::ArrayView<const char>>> data) {
+    if(_cache->directory.isEmpty()) return doLinkDataToData(data);
+
+    const std::string key = cacheKey("link", data);
+    Containers::Array<char> out = cacheLoad(key);
+    if(out) return out;
+
+    cacheRecordBegin();
+    out = doLinkDataToData(data);
+    cacheRecordEnd();
+
+    /* Failures are not cached, a subsequent call will try again */
+    if(out) cacheSave(key, out);
+    return out;
+}
+
 std::pair<bool, Containers::String> AbstractConverter::validateData(const Stage stage, const Containers::ArrayView<const void> data) {
     CORRADE_ASSERT(features() & ConverterFeature::ValidateData,
         "ShaderTools::AbstractConverter::validateData(): feature not supported", {});
@@ -250,7 +526,7 @@ Containers::Array<char> AbstractConverter::convertDataToData(const Stage stage,
         "ShaderTools::AbstractConverter::convertDataToData(): feature not supported", {});
 
     /* Cast to a non-void type for more convenience */
-    Containers::Array<char> out = doConvertDataToData(stage, Containers::arrayCast<const char>(data));
+    Containers::Array<char> out = cachedConvertDataToData(stage, Containers::arrayCast<const char>(data));
     CORRADE_ASSERT(!out.deleter(),
         "ShaderTools::AbstractConverter::convertDataToData(): implementation is not allowed to use a custom Array deleter", {});
     return out;
@@ -267,7 +543,7 @@ bool AbstractConverter::convertDataToFile(const Stage stage, const Containers::A
     /** @todo this needs expansion once output callbacks are supported as well */
 
     /* Cast to a non-void type for more convenience */
-    Containers::Array<char> out = doConvertDataToData(stage, Containers::arrayCast<const char>(data));
+    Containers::Array<char> out = cachedConvertDataToData(stage, Containers::arrayCast<const char>(data));
     if(!out) return false;
 
     if(!Utility::Directory::write(to, out)) {
@@ -284,7 +560,7 @@ Containers::Array<char> AbstractConverter::convertDataToDataUsingInputFileCallba
         Error{} << prefix << "cannot open file" << from;
         return {};
     }
-    Containers::Array<char> out = doConvertDataToData(stage, *data);
+    Containers::Array<char> out = cachedConvertDataToData(stage, *data);
     _inputFileCallback(from, InputFileCallbackPolicy::Close, _inputFileCallbackUserData);
     return out;
 }
@@ -346,7 +622,7 @@ bool AbstractConverter::doConvertFileToFile(const Stage stage, const Containers:
             return {};
         }
 
-        out = doConvertDataToData(stage, Utility::Directory::read(from));
+        out = cachedConvertDataToData(stage, Utility::Directory::read(from));
     }
 
     if(!out) return false;
@@ -405,7 +681,7 @@ Containers::Array<char> AbstractConverter::doConvertFileToData(const Stage stage
             return {};
         }
 
-        return doConvertDataToData(stage, Utility::Directory::read(from));
+        return cachedConvertDataToData(stage, Utility::Directory::read(from));
     }
 }
 
@@ -418,7 +694,7 @@ Containers::Array<char> AbstractConverter::linkDataToData(const Containers::Arra
         "ShaderTools::AbstractConverter::linkDataToData(): no data passed", {});
 
     /* Cast to a non-void type for more convenience */
-    Containers::Array<char> out = doLinkDataToData(Containers::arrayCast<const std::pair<Stage, Containers::ArrayView<const char>>>(data));
+    Containers::Array<char> out = cachedLinkDataToData(Containers::arrayCast<const std::pair<Stage, Containers::ArrayView<const char>>>(data));
     CORRADE_ASSERT(!out.deleter(),
         "ShaderTools::AbstractConverter::linkDataToData(): implementation is not allowed to use a custom Array deleter", {});
     return out;
@@ -443,7 +719,7 @@ bool AbstractConverter::linkDataToFile(const Containers::ArrayView<const std::pa
     /** @todo this needs expansion once output callbacks are supported as well */
 
     /* Cast to a non-void type for more convenience */
-    Containers::Array<char> out = doLinkDataToData(Containers::arrayCast<const std::pair<Stage, Containers::ArrayView<const char>>>(data));
+    Containers::Array<char> out = cachedLinkDataToData(Containers::arrayCast<const std::pair<Stage, Containers::ArrayView<const char>>>(data));
     if(!out) return false;
 
     if(!Utility::Directory::write(to, out)) {
@@ -474,7 +750,7 @@ Containers::Array<char> AbstractConverter::linkDataToDataUsingInputFileCallbacks
 
     /* If all input files loaded successfully, process */
     Containers::Array<char> out;
-    if(i == from.size()) out = doLinkDataToData(data);
+    if(i == from.size()) out = cachedLinkDataToData(data);
 
     /* Close again all input files that loaded successfully */
     for(std::size_t ii = 0; ii != i; ++ii)
@@ -570,7 +846,7 @@ bool AbstractConverter::doLinkFilesToFile(const Containers::ArrayView<const std:
             data[i].second = fileData[i];
         }
 
-        out = doLinkDataToData(data);
+        out = cachedLinkDataToData(data);
     }
 
     if(!out) return false;
@@ -649,7 +925,7 @@ Containers::Array<char> AbstractConverter::doLinkFilesToData(const Containers::A
             data[i].second = fileData[i];
         }
 
-        return doLinkDataToData(data);
+        return cachedLinkDataToData(data);
     }
 }
 
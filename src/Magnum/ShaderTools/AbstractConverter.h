@@ -31,6 +31,7 @@
  */
 
 #include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -420,6 +421,35 @@ The input file callback signature is the same for
 @ref ShaderTools::AbstractConverter, @ref Trade::AbstractImporter and
 @ref Text::AbstractFont to allow code reuse.
 
+@subsection ShaderTools-AbstractConverter-usage-cache Caching conversion results
+
+Compiling large amounts of shader permutations can take a significant time.
+With @ref setCacheDirectory() the converter stores results of successful
+conversion and linking operations in given directory and, if the same
+operation is requested again, returns the stored result instead of invoking the
+plugin. The caching is transparent to plugin implementations and is done for
+all conversion and linking operations that end up passing the input data to
+@ref doConvertDataToData() or @ref doLinkDataToData() --- in particular,
+plugins that implement only @ref ConverterFeature::ConvertFile or
+@ref ConverterFeature::LinkFile on their own aren't cached.
+
+@snippet MagnumShaderTools.cpp AbstractConverter-usage-cache
+
+The cache key is a SHA-1 hash of the plugin interface and plugin name,
+converter flags, the input and output format and version, preprocessor
+definitions, optimization and debug info level, the shader stage and the input
+data. If the converter supports @ref ConverterFeature::InputFileCallback, all
+files the plugin loads through the callback (such as @cpp #include @ce files)
+are recorded together with hashes of their contents. If the plugin isn't
+instructed otherwise through @ref setInputFileCallback(), the files are loaded
+directly from the filesystem. A cached result is then used only if all
+recorded files still have the same contents. Files read by a plugin bypassing
+the callback are not tracked, and neither is the plugin version --- clear the
+cache directory or use a different one when updating the plugins.
+
+Warnings printed by the plugin during the original conversion are not printed
+again when a cached result is used. Failed operations are not cached.
+
 @section ShaderTools-AbstractConverter-data-dependency Data dependency
 
 The instances returned from various functions *by design* have no dependency on
@@ -504,6 +534,8 @@ class MAGNUM_SHADERTOOLS_EXPORT AbstractConverter: public PluginManager::Abstrac
         /** @brief Plugin manager constructor */
         explicit AbstractConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractConverter();
+
         /** @brief Features supported by this converter */
         ConverterFeatures features() const;
 
@@ -727,6 +759,33 @@ class MAGNUM_SHADERTOOLS_EXPORT AbstractConverter: public PluginManager::Abstrac
          */
         void setDebugInfoLevel(Containers::StringView level);
 
+        /**
+         * @brief Cache directory
+         * @m_since_latest
+         *
+         * Empty if caching is disabled, which is the default.
+         * @see @ref setCacheDirectory()
+         */
+        Containers::StringView cacheDirectory() const;
+
+        /**
+         * @brief Set cache directory
+         * @m_since_latest
+         *
+         * Results of the following @ref convertDataToData(),
+         * @ref convertDataToFile(), @ref convertFileToFile(),
+         * @ref convertFileToData(), @ref linkDataToData(),
+         * @ref linkDataToFile(), @ref linkFilesToFile() and
+         * @ref linkFilesToData() calls are stored in and loaded from
+         * @p directory, which is created if it doesn't exist yet. Pass an
+         * empty string to disable the cache again. See
+         * @ref ShaderTools-AbstractConverter-usage-cache for more information.
+         *
+         * Corresponds to the `--cache-dir` option in
+         * @ref magnum-shaderconverter "magnum-shaderconverter".
+         */
+        void setCacheDirectory(Containers::StringView directory);
+
         /**
          * @brief Validate a shader
          *
@@ -1080,6 +1139,17 @@ class MAGNUM_SHADERTOOLS_EXPORT AbstractConverter: public PluginManager::Abstrac
            convertFileToData() and doConvertFileToData() */
         MAGNUM_SHADERTOOLS_LOCAL Containers::Array<char> convertDataToDataUsingInputFileCallbacks(const char* prefix, const Stage stage, Containers::StringView from);
 
+        /* Calls doConvertDataToData() / doLinkDataToData(), going through the
+           cache if it's enabled. Used everywhere instead of calling the
+           do*() functions directly. */
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Array<char> cachedConvertDataToData(Stage stage, Containers::ArrayView<const char> data);
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Array<char> cachedLinkDataToData(Containers::ArrayView<const std::pair<Stage, Containers::ArrayView<const char>>> data);
+        MAGNUM_SHADERTOOLS_LOCAL std::string cacheKey(const char* operation, Containers::ArrayView<const std::pair<Stage, Containers::ArrayView<const char>>> data) const;
+        MAGNUM_SHADERTOOLS_LOCAL Containers::Array<char> cacheLoad(const std::string& key);
+        MAGNUM_SHADERTOOLS_LOCAL void cacheSave(const std::string& key, Containers::ArrayView<const char> data);
+        MAGNUM_SHADERTOOLS_LOCAL void cacheRecordBegin();
+        MAGNUM_SHADERTOOLS_LOCAL void cacheRecordEnd();
+
         /**
          * @brief Implementation for @ref convertDataToData()
          *
@@ -1106,6 +1176,10 @@ class MAGNUM_SHADERTOOLS_EXPORT AbstractConverter: public PluginManager::Abstrac
 
         ConverterFlags _flags;
 
+        /* Cache directory and everything that's hashed into the cache key */
+        struct CacheState;
+        Containers::Pointer<CacheState> _cache;
+
         Containers::Optional<Containers::ArrayView<const char>>(*_inputFileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _inputFileCallbackUserData{};
 
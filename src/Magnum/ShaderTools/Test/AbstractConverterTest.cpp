@@ -175,6 +175,13 @@ struct AbstractConverterTest: TestSuite::Tester {
     void setInputFileCallbackLinkFilesToDataAsData();
     void setInputFileCallbackLinkFilesToDataAsDataFailed();
 
+    void cacheConvertDataToData();
+    void cacheConvertFileToFile();
+    void cacheConvertFailed();
+    void cacheLinkDataToData();
+    void cacheInputFileCallbackDependency();
+    void cacheInputFileCallbackDependencyFilesystem();
+
     void debugFeature();
     void debugFeatures();
     void debugFlag();
@@ -315,6 +322,13 @@ AbstractConverterTest::AbstractConverterTest() {
               &AbstractConverterTest::setInputFileCallbackLinkFilesToDataAsData,
               &AbstractConverterTest::setInputFileCallbackLinkFilesToDataAsDataFailed,
 
+              &AbstractConverterTest::cacheConvertDataToData,
+              &AbstractConverterTest::cacheConvertFileToFile,
+              &AbstractConverterTest::cacheConvertFailed,
+              &AbstractConverterTest::cacheLinkDataToData,
+              &AbstractConverterTest::cacheInputFileCallbackDependency,
+              &AbstractConverterTest::cacheInputFileCallbackDependencyFilesystem,
+
               &AbstractConverterTest::debugFeature,
               &AbstractConverterTest::debugFeatures,
               &AbstractConverterTest::debugFlag,
@@ -3393,6 +3407,287 @@ void AbstractConverterTest::setInputFileCallbackLinkFilesToDataAsDataFailed() {
     CORRADE_COMPARE(out.str(), "ShaderTools::AbstractConverter::linkFilesToData(): cannot open file file.dat\n");
 }
 
+/* Returns the cache directory, emptied from a previous test run */
+std::string emptyCacheDirectory(const std::string& name) {
+    const std::string directory = Utility::Directory::join(SHADERTOOLS_TEST_OUTPUT_DIR, name);
+    for(const std::string& file: Utility::Directory::list(directory, Utility::Directory::Flag::SkipDotAndDotDot))
+        Utility::Directory::rm(Utility::Directory::join(directory, file));
+    return directory;
+}
+
+void AbstractConverterTest::cacheConvertDataToData() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::ConvertData|ConverterFeature::Preprocess|ConverterFeature::Optimize;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+        void doSetDefinitions(Containers::ArrayView<const std::pair<Containers::StringView, Containers::StringView>>) override {}
+        void doSetOptimizationLevel(Containers::StringView) override {}
+
+        Containers::Array<char> doConvertDataToData(Stage, Containers::ArrayView<const char> data) override {
+            ++convertCalled;
+            return Containers::array({data.back(), data.front()});
+        }
+
+        Int convertCalled = 0;
+    } converter;
+
+    CORRADE_VERIFY(converter.cacheDirectory().isEmpty());
+    const std::string directory = emptyCacheDirectory("cache-convert");
+    converter.setCacheDirectory(directory);
+    CORRADE_COMPARE(converter.cacheDirectory(), Containers::StringView{directory});
+
+    const char data[]{'S', 'P', 'I', 'R', 'V'};
+    CORRADE_COMPARE_AS(converter.convertDataToData(Stage::Vertex, data),
+        Containers::arrayView({'V', 'S'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    /* Second time it's taken from the cache */
+    CORRADE_COMPARE_AS(converter.convertDataToData(Stage::Vertex, data),
+        Containers::arrayView({'V', 'S'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    /* Different stage, definitions, optimization level or output format is a
+       different entry */
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 2);
+    converter.setDefinitions({{"LIGHT_COUNT", "3"}});
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 3);
+    /* An undefined value is different from an empty value */
+    converter.setDefinitions({{"LIGHT_COUNT", nullptr}});
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 4);
+    converter.setDefinitions({{"LIGHT_COUNT", ""}});
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 5);
+    converter.setOptimizationLevel("1");
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 6);
+    converter.setOutputFormat(Format::Spirv, "1.3");
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 7);
+
+    /* Quiet and Verbose don't affect the output, so they aren't a part of the
+       key */
+    converter.setFlags(ConverterFlag::Verbose);
+    converter.convertDataToData(Stage::Fragment, data);
+    CORRADE_COMPARE(converter.convertCalled, 7);
+
+    /* Disabling the cache calls the implementation always */
+    converter.setCacheDirectory({});
+    CORRADE_VERIFY(converter.cacheDirectory().isEmpty());
+    converter.convertDataToData(Stage::Vertex, data);
+    CORRADE_COMPARE(converter.convertCalled, 8);
+}
+
+void AbstractConverterTest::cacheConvertFileToFile() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::ConvertData;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+
+        Containers::Array<char> doConvertDataToData(Stage, Containers::ArrayView<const char> data) override {
+            ++convertCalled;
+            return Containers::array({data.back(), data.front()});
+        }
+
+        Int convertCalled = 0;
+    } converter;
+
+    converter.setCacheDirectory(emptyCacheDirectory("cache-convert-file"));
+
+    const std::string filename = Utility::Directory::join(SHADERTOOLS_TEST_OUTPUT_DIR, "file.dat");
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(converter.convertFileToFile({}, Utility::Directory::join(SHADERTOOLS_TEST_DIR, "file.dat"), filename));
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(converter.convertFileToFile({}, Utility::Directory::join(SHADERTOOLS_TEST_DIR, "file.dat"), filename));
+    CORRADE_COMPARE(converter.convertCalled, 1);
+    CORRADE_COMPARE_AS(filename, "VS",
+        TestSuite::Compare::FileToString);
+
+    /* Different file contents are a different entry */
+    CORRADE_VERIFY(converter.convertFileToFile({}, Utility::Directory::join(SHADERTOOLS_TEST_DIR, "another.dat"), filename));
+    CORRADE_COMPARE(converter.convertCalled, 2);
+}
+
+void AbstractConverterTest::cacheConvertFailed() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::ConvertData;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+
+        Containers::Array<char> doConvertDataToData(Stage, Containers::ArrayView<const char>) override {
+            ++convertCalled;
+            return {};
+        }
+
+        Int convertCalled = 0;
+    } converter;
+
+    const std::string directory = emptyCacheDirectory("cache-convert-failed");
+    converter.setCacheDirectory(directory);
+
+    /* Failures aren't cached, so the implementation gets called again */
+    const char data[]{'S', 'P', 'I', 'R', 'V'};
+    CORRADE_VERIFY(!converter.convertDataToData({}, data));
+    CORRADE_VERIFY(!converter.convertDataToData({}, data));
+    CORRADE_COMPARE(converter.convertCalled, 2);
+    CORRADE_VERIFY(Utility::Directory::list(directory, Utility::Directory::Flag::SkipDotAndDotDot).empty());
+}
+
+void AbstractConverterTest::cacheLinkDataToData() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::LinkData;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+
+        Containers::Array<char> doLinkDataToData(Containers::ArrayView<const std::pair<Stage, Containers::ArrayView<const char>>> data) override {
+            ++linkCalled;
+            return Containers::array({data[0].second[0], data[1].second[0]});
+        }
+
+        Int linkCalled = 0;
+    } converter;
+
+    converter.setCacheDirectory(emptyCacheDirectory("cache-link"));
+
+    CORRADE_COMPARE_AS(converter.linkDataToData({
+        {Stage::Vertex, Containers::arrayView({'V', 'E'})},
+        {Stage::Fragment, Containers::arrayView({'S', 'A'})}
+    }), Containers::arrayView({'V', 'S'}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.linkCalled, 1);
+
+    CORRADE_COMPARE_AS(converter.linkDataToData({
+        {Stage::Vertex, Containers::arrayView({'V', 'E'})},
+        {Stage::Fragment, Containers::arrayView({'S', 'A'})}
+    }), Containers::arrayView({'V', 'S'}), TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.linkCalled, 1);
+
+    /* The same data split differently is a different entry */
+    converter.linkDataToData({
+        {Stage::Vertex, Containers::arrayView({'V'})},
+        {Stage::Fragment, Containers::arrayView({'E', 'S', 'A'})}
+    });
+    CORRADE_COMPARE(converter.linkCalled, 2);
+}
+
+void AbstractConverterTest::cacheInputFileCallbackDependency() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::ConvertData|ConverterFeature::InputFileCallback;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+
+        /* Emulates an #include "common.glsl" */
+        Containers::Array<char> doConvertDataToData(Stage, Containers::ArrayView<const char> data) override {
+            ++convertCalled;
+            Containers::Optional<Containers::ArrayView<const char>> included = inputFileCallback()("common.glsl", InputFileCallbackPolicy::LoadTemporary, inputFileCallbackUserData());
+            if(!included) return {};
+            Containers::Array<char> out = Containers::array({data.front(), included->front()});
+            inputFileCallback()("common.glsl", InputFileCallbackPolicy::Close, inputFileCallbackUserData());
+            return out;
+        }
+
+        Int convertCalled = 0;
+    } converter;
+
+    converter.setCacheDirectory(emptyCacheDirectory("cache-callback"));
+
+    std::string common = "A";
+    converter.setInputFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, std::string& common) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(filename != "common.glsl") return {};
+        if(policy == InputFileCallbackPolicy::Close) return {};
+        return Containers::arrayView(common.data(), common.size());
+    }, common);
+    auto callback = converter.inputFileCallback();
+    void* callbackUserData = converter.inputFileCallbackUserData();
+
+    const char data[]{'x'};
+    CORRADE_COMPARE_AS(converter.convertDataToData({}, data),
+        Containers::arrayView({'x', 'A'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    /* The user callback is restored after */
+    CORRADE_VERIFY(converter.inputFileCallback() == callback);
+    CORRADE_VERIFY(converter.inputFileCallbackUserData() == callbackUserData);
+
+    CORRADE_COMPARE_AS(converter.convertDataToData({}, data),
+        Containers::arrayView({'x', 'A'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    /* Changing the included file invalidates the entry */
+    common = "B";
+    CORRADE_COMPARE_AS(converter.convertDataToData({}, data),
+        Containers::arrayView({'x', 'B'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 2);
+}
+
+void AbstractConverterTest::cacheInputFileCallbackDependencyFilesystem() {
+    struct: AbstractConverter {
+        ConverterFeatures doFeatures() const override {
+            return ConverterFeature::ConvertData|ConverterFeature::InputFileCallback;
+        }
+        void doSetInputFormat(Format, Containers::StringView) override {}
+        void doSetOutputFormat(Format, Containers::StringView) override {}
+
+        /* Emulates an #include of a file from the filesystem */
+        Containers::Array<char> doConvertDataToData(Stage, Containers::ArrayView<const char> data) override {
+            ++convertCalled;
+            /* No callback is set by the user, so the plugin would read from
+               the filesystem directly. With the cache enabled a callback is
+               provided though. */
+            CORRADE_VERIFY(inputFileCallback());
+            if(!inputFileCallback()) return {};
+            Containers::Optional<Containers::ArrayView<const char>> included = inputFileCallback()(include, InputFileCallbackPolicy::LoadTemporary, inputFileCallbackUserData());
+            if(!included) return {};
+            Containers::Array<char> out = Containers::array({data.front(), included->front()});
+            inputFileCallback()(include, InputFileCallbackPolicy::Close, inputFileCallbackUserData());
+            return out;
+        }
+
+        Int convertCalled = 0;
+        std::string include;
+    } converter;
+
+    converter.include = Utility::Directory::join(SHADERTOOLS_TEST_OUTPUT_DIR, "common.glsl");
+    CORRADE_VERIFY(Utility::Directory::writeString(converter.include, "A"));
+
+    converter.setCacheDirectory(emptyCacheDirectory("cache-filesystem"));
+
+    const char data[]{'x'};
+    CORRADE_COMPARE_AS(converter.convertDataToData({}, data),
+        Containers::arrayView({'x', 'A'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+    CORRADE_VERIFY(!converter.inputFileCallback());
+
+    converter.convertDataToData({}, data);
+    CORRADE_COMPARE(converter.convertCalled, 1);
+
+    /* Changing the included file invalidates the entry */
+    CORRADE_VERIFY(Utility::Directory::writeString(converter.include, "B"));
+    CORRADE_COMPARE_AS(converter.convertDataToData({}, data),
+        Containers::arrayView({'x', 'B'}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(converter.convertCalled, 2);
+}
+
 void AbstractConverterTest::debugFeature() {
     std::ostringstream out;
 
@@ -23,9 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <functional>
+#include <sstream>
+#include <thread>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringStl.h>
 #include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
@@ -68,7 +74,7 @@ magnum-shaderconverter [-h|--help] [--validate] [--link]
     [--input-format glsl|spv|spvasm|hlsl|metal]...
     [--output-format glsl|spv|spvasm|hlsl|metal]...
     [--input-version VERSION]... [--output-version VERSION]...
-    [--] input... output
+    [--cache-dir DIR] [--permutations] [-j|--jobs N] [--] input... output
 @endcode
 
 Arguments:
@@ -108,6 +114,13 @@ Arguments:
     converter
 -   `--input-version VERSION` --- input format version for each converter
 -   `--output-version VERSION` --- output format version for each converter
+-   `--cache-dir DIR` --- cache conversion results in given directory.
+    Corresponds to the @ref ShaderTools::AbstractConverter::setCacheDirectory()
+    function.
+-   `--permutations` --- treat `input` as a permutation manifest and `output`
+    as an output directory, see @ref magnum-shaderconverter-permutations below
+-   `-j`, `--jobs N` --- number of threads to compile permutations on. If `0`,
+    the number of hardware threads is used. Default is `0`.
 
 If `--validate` is given, the utility will validate the `input` file using
 passed `--converter` (or @ref ShaderTools::AnyConverter "AnyShaderConverter" if
@@ -142,6 +155,58 @@ Values accepted by `-O` / `--optimize`, `-g` / `--debug-info`, `--input-format`,
 converter-specific, see documentation of a particular converter for more
 information.
 
+@section magnum-shaderconverter-permutations Compiling shader permutations
+
+With `--permutations`, the `input` is a manifest in the
+@ref Corrade::Utility::Configuration format listing shader sources, stages to
+compile them in and definition sets (variants) to compile each of them with.
+All combinations are compiled concurrently on `--jobs` threads, each having its
+own converter instance, and for each the time it took is printed, together
+with any messages printed by the converter if it failed. The utility exits
+with a non-zero code if any of the permutations failed to compile.
+
+@code{.ini}
+# Each source is compiled with each variant. The output is put into a
+# subdirectory named after the variant. If there are no variants, sources are
+# compiled just once without any additional definitions.
+[variant]
+name=textured
+define=TEXTURED
+define=LIGHT_COUNT=3
+[variant]
+name=flat
+undefine=TEXTURED
+
+# Each source is compiled in each stage listed. If there's no stage subgroup,
+# the source is compiled once and the stage is detected from the filename.
+# Relative input paths are relative to the manifest location, output paths
+# are relative to the output directory.
+[source]
+input=Phong.glsl
+[source/stage]
+stage=vertex
+output=Phong.vert.spv
+[source/stage]
+stage=fragment
+output=Phong.frag.spv
+
+[source]
+input=Flat.frag
+output=Flat.frag.spv
+@endcode
+
+Recognized stage names are `vertex`, `fragment`, `geometry`,
+`tessellation-control`, `tessellation-evaluation`, `compute`,
+`ray-generation`, `ray-any-hit`, `ray-closest-hit`, `ray-miss`,
+`ray-intersection`, `ray-callable`, `mesh-task` and `mesh`. The `-D` /
+`--define` and `-U` / `--undefine` options are applied to all permutations
+before definitions of particular variant; all other options are applied to
+each converter instance. Only a single `-C` / `--converter` can be used and
+it's expected to support @ref ShaderTools::ConverterFeature::ConvertFile.
+Capturing converter messages for each permutation separately relies on
+@ref CORRADE_BUILD_MULTITHREADED being enabled, otherwise the messages may be
+interleaved or attributed to a wrong permutation.
+
 @section magnum-shaderconverter-example Example usage
 
 Validate a SPIR-V file for a Vulkan 1.1 target, using
@@ -162,6 +227,13 @@ picked again by @ref ShaderTools::AnyConverter "AnyShaderConverter":
 @code{.sh}
 magnum-shaderconverter phong.frag -DDIFFUSE_TEXTURE -DNORMAL_TEXTURE --input-version "410 core" --output-version opengl4.5 --warning-as-error phong.frag.spv
 @endcode
+
+Compiling all permutations listed in a manifest to a `shaders/` directory on
+eight threads, caching the results for subsequent runs:
+
+@code{.sh}
+magnum-shaderconverter --permutations -j 8 --cache-dir .shadercache shaders.conf shaders/
+@endcode
 */
 
 }
@@ -169,6 +241,312 @@ magnum-shaderconverter phong.frag -DDIFFUSE_TEXTURE -DNORMAL_TEXTURE --input-ver
 using namespace Corrade::Containers::Literals;
 using namespace Magnum;
 
+namespace {
+
+Containers::Optional<ShaderTools::Format> parseFormat(Containers::StringView format) {
+    if(format == ""_s) return ShaderTools::Format::Unspecified;
+    if(format == "glsl"_s) return ShaderTools::Format::Glsl;
+    if(format == "spv"_s) return ShaderTools::Format::Spirv;
+    if(format == "spvasm"_s) return ShaderTools::Format::SpirvAssembly;
+    if(format == "hlsl"_s) return ShaderTools::Format::Hlsl;
+    if(format == "metal"_s) return ShaderTools::Format::Msl;
+    /** @todo wgsl and dxil once i figure out the extensions */
+
+    Error{} << "Unrecognized format" << format << Debug::nospace << ", expected glsl, spv, spvasm, hlsl or metal";
+    return {};
+}
+
+Containers::Optional<ShaderTools::Stage> parseStage(Containers::StringView stage) {
+    if(stage == "vertex"_s) return ShaderTools::Stage::Vertex;
+    if(stage == "fragment"_s) return ShaderTools::Stage::Fragment;
+    if(stage == "geometry"_s) return ShaderTools::Stage::Geometry;
+    if(stage == "tessellation-control"_s) return ShaderTools::Stage::TessellationControl;
+    if(stage == "tessellation-evaluation"_s) return ShaderTools::Stage::TessellationEvaluation;
+    if(stage == "compute"_s) return ShaderTools::Stage::Compute;
+    if(stage == "ray-generation"_s) return ShaderTools::Stage::RayGeneration;
+    if(stage == "ray-any-hit"_s) return ShaderTools::Stage::RayAnyHit;
+    if(stage == "ray-closest-hit"_s) return ShaderTools::Stage::RayClosestHit;
+    if(stage == "ray-miss"_s) return ShaderTools::Stage::RayMiss;
+    if(stage == "ray-intersection"_s) return ShaderTools::Stage::RayIntersection;
+    if(stage == "ray-callable"_s) return ShaderTools::Stage::RayCallable;
+    if(stage == "mesh-task"_s) return ShaderTools::Stage::MeshTask;
+    if(stage == "mesh"_s) return ShaderTools::Stage::Mesh;
+
+    Error{} << "Unrecognized stage" << stage;
+    return {};
+}
+
+struct PermutationDefinition {
+    std::string name, value;
+    bool undefine;
+};
+
+struct PermutationVariant {
+    std::string name;
+    Containers::Array<PermutationDefinition> definitions;
+};
+
+struct Permutation {
+    std::string input, output;
+    ShaderTools::Stage stage;
+    std::size_t variant;
+};
+
+struct PermutationResult {
+    bool success;
+    std::chrono::high_resolution_clock::duration time;
+    std::string messages;
+};
+
+int convertPermutations(const Utility::Arguments& args, PluginManager::Manager<ShaderTools::AbstractConverter>& converterManager) {
+    /* Parse the manifest */
+    const std::string manifestFilename = args.arrayValue("input", 0);
+    const Utility::Configuration manifest{manifestFilename, Utility::Configuration::Flag::ReadOnly};
+    if(!manifest.isValid()) {
+        Error{} << "Cannot open the permutation manifest" << manifestFilename;
+        return 24;
+    }
+
+    Containers::Array<PermutationVariant> variants;
+    for(const Utility::ConfigurationGroup* group: manifest.groups("variant")) {
+        PermutationVariant variant;
+        variant.name = group->value("name");
+        if(variant.name.empty()) {
+            Error{} << "A variant in" << manifestFilename << "has no name";
+            return 25;
+        }
+        for(const std::string& define: group->values("define")) {
+            const Containers::Array3<std::string> nameValue = Utility::String::partition(define, '=');
+            arrayAppend(variant.definitions, PermutationDefinition{nameValue[0], nameValue[2], false});
+        }
+        for(const std::string& undefine: group->values("undefine"))
+            arrayAppend(variant.definitions, PermutationDefinition{undefine, {}, true});
+        arrayAppend(variants, std::move(variant));
+    }
+
+    /* No variants means each source is compiled just once, directly into the
+       output directory */
+    if(variants.empty()) arrayAppend(variants, PermutationVariant{});
+
+    /* Relative inputs are taken relative to the manifest */
+    const std::string inputPath = Utility::Directory::path(manifestFilename);
+    const std::string outputPath = args.value("output");
+    Containers::Array<Permutation> permutations;
+    for(const Utility::ConfigurationGroup* source: manifest.groups("source")) {
+        const std::string input = source->value("input");
+        if(input.empty()) {
+            Error{} << "A source in" << manifestFilename << "has no input";
+            return 25;
+        }
+
+        /* Gather the stages first so the permutations are ordered by variant
+           and then by source */
+        Containers::Array<std::pair<ShaderTools::Stage, std::string>> stages;
+        if(source->hasGroup("stage")) for(const Utility::ConfigurationGroup* stage: source->groups("stage")) {
+            const Containers::Optional<ShaderTools::Stage> parsed = parseStage(stage->value("stage"));
+            if(!parsed) return 25;
+            arrayAppend(stages, Containers::InPlaceInit, *parsed, stage->value("output"));
+        } else arrayAppend(stages, Containers::InPlaceInit, ShaderTools::Stage::Unspecified, source->value("output"));
+
+        for(const std::pair<ShaderTools::Stage, std::string>& stage: stages) {
+            if(stage.second.empty()) {
+                Error{} << "A source" << input << "in" << manifestFilename << "has no output";
+                return 25;
+            }
+
+            for(std::size_t i = 0; i != variants.size(); ++i)
+                arrayAppend(permutations, Permutation{
+                    Utility::Directory::join(inputPath, input),
+                    Utility::Directory::join(Utility::Directory::join(outputPath, variants[i].name), stage.second),
+                    stage.first, i});
+        }
+    }
+
+    if(permutations.empty()) {
+        Error{} << "No sources listed in" << manifestFilename;
+        return 25;
+    }
+
+    /* Create all output directories upfront so the threads don't race on
+       that */
+    for(const Permutation& permutation: permutations) {
+        if(!Utility::Directory::mkpath(Utility::Directory::path(permutation.output))) {
+            Error{} << "Cannot create the output directory for" << permutation.output;
+            return 26;
+        }
+    }
+
+    /* Zero means hardware concurrency, but don't spawn more threads than
+       there's work for */
+    UnsignedInt jobCount = args.value<UnsignedInt>("jobs");
+    if(!jobCount) jobCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    jobCount = UnsignedInt(Math::min(std::size_t(jobCount), permutations.size()));
+
+    /* Definitions from the command line, applied before the variant-specific
+       ones */
+    Containers::Array<std::pair<Containers::StringView, Containers::StringView>> globalDefinitions;
+    for(std::size_t i = 0; i != args.arrayValueCount("define"); ++i) {
+        const Containers::Array3<Containers::StringView> define =
+        args.arrayValue<Containers::StringView>("define", i).partition('=');
+        arrayAppend(globalDefinitions, Containers::InPlaceInit,
+            define[0], define[2]);
+    }
+    for(std::size_t i = 0; i != args.arrayValueCount("undefine"); ++i) {
+        arrayAppend(globalDefinitions, Containers::InPlaceInit,
+            args.arrayValue<Containers::StringView>("undefine", i), nullptr);
+    }
+    bool needsPreprocess = args.isSet("preprocess-only") || !globalDefinitions.empty();
+    for(const PermutationVariant& variant: variants)
+        if(!variant.definitions.empty()) needsPreprocess = true;
+
+    /* Parse format and version, if passed */
+    ShaderTools::Format inputFormat{}, outputFormat{};
+    if(args.arrayValueCount("input-format")) {
+        if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("input-format", 0)))
+            inputFormat = *format;
+        else return 8;
+    }
+    if(args.arrayValueCount("output-format")) {
+        if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("output-format", 0)))
+            outputFormat = *format;
+        else return 9;
+    }
+    const Containers::StringView inputVersion = args.arrayValueCount("input-version") ? args.arrayValue<Containers::StringView>("input-version", 0) : Containers::StringView{};
+    const Containers::StringView outputVersion = args.arrayValueCount("output-version") ? args.arrayValue<Containers::StringView>("output-version", 0) : Containers::StringView{};
+
+    ShaderTools::ConverterFlags flags;
+    if(args.isSet("quiet")) flags |= ShaderTools::ConverterFlag::Quiet;
+    if(args.isSet("verbose")) flags |= ShaderTools::ConverterFlag::Verbose;
+    if(args.isSet("warning-as-error")) flags |= ShaderTools::ConverterFlag::WarningAsError;
+    if(args.isSet("preprocess-only")) flags |= ShaderTools::ConverterFlag::PreprocessOnly;
+
+    /* Instantiate and set up one converter per thread. The plugin manager
+       isn't thread-safe, so this is done upfront. */
+    const std::string converterName = args.arrayValueCount("converter") ?
+        args.arrayValue("converter", 0) : "AnyShaderConverter";
+    Containers::Array<Containers::Pointer<ShaderTools::AbstractConverter>> converters{jobCount};
+    for(Containers::Pointer<ShaderTools::AbstractConverter>& converter: converters) {
+        converter = converterManager.loadAndInstantiate(converterName);
+        if(!converter) {
+            Debug{} << "Available converter plugins:" << Utility::String::join(converterManager.aliasList(), ", ");
+            return 7;
+        }
+
+        if(args.arrayValueCount("converter-options"))
+            Implementation::setOptions(*converter, args.arrayValue("converter-options", 0));
+
+        converter->setInputFormat(inputFormat, inputVersion);
+        converter->setOutputFormat(outputFormat, outputVersion);
+
+        if(needsPreprocess && !(converter->features() & ShaderTools::ConverterFeature::Preprocess)) {
+            Error{} << "The -E / -D / -U options or variant definitions are set, but" << converterName << "doesn't support preprocessing";
+            return 10;
+        }
+
+        if(!args.value<Containers::StringView>("optimize").isEmpty()) {
+            if(!(converter->features() & ShaderTools::ConverterFeature::Optimize)) {
+                Error{} << "The -O option is set, but" << converterName << "doesn't support optimization";
+                return 11;
+            }
+
+            converter->setOptimizationLevel(args.value<Containers::StringView>("optimize"));
+        }
+
+        if(!args.value<Containers::StringView>("debug-info").isEmpty()) {
+            if(!(converter->features() & ShaderTools::ConverterFeature::DebugInfo)) {
+                Error{} << "The -g option is set, but" << converterName << "doesn't support debug info";
+                return 12;
+            }
+
+            converter->setDebugInfoLevel(args.value<Containers::StringView>("debug-info"));
+        }
+
+        if(!(converter->features() & ShaderTools::ConverterFeature::ConvertFile)) {
+            Error{} << converterName << "doesn't support file conversion";
+            return 15;
+        }
+
+        converter->setFlags(flags);
+
+        if(!args.value<Containers::StringView>("cache-dir").isEmpty())
+            converter->setCacheDirectory(args.value<Containers::StringView>("cache-dir"));
+    }
+
+    /* Each thread picks the next permutation that's not taken yet */
+    Containers::Array<PermutationResult> results{Containers::ValueInit, permutations.size()};
+    std::atomic<std::size_t> next{0};
+    auto compile = [&](ShaderTools::AbstractConverter& converter) {
+        Containers::Array<std::pair<Containers::StringView, Containers::StringView>> definitions;
+        std::size_t i;
+        while((i = next++) < permutations.size()) {
+            const Permutation& permutation = permutations[i];
+            PermutationResult& result = results[i];
+
+            /* Debug output redirection is thread-local with
+               CORRADE_BUILD_MULTITHREADED, so the messages can be attributed
+               to the permutation */
+            std::ostringstream out;
+            Warning redirectWarning{&out};
+            Error redirectError{&out};
+
+            {
+                Implementation::Duration d{result.time};
+
+                if(needsPreprocess) {
+                    arrayResize(definitions, 0);
+                    for(const std::pair<Containers::StringView, Containers::StringView>& definition: globalDefinitions)
+                        arrayAppend(definitions, definition);
+                    for(const PermutationDefinition& definition: variants[permutation.variant].definitions)
+                        arrayAppend(definitions, Containers::InPlaceInit,
+                            Containers::StringView{definition.name},
+                            definition.undefine ? Containers::StringView{nullptr} : Containers::StringView{definition.value});
+                    converter.setDefinitions(definitions);
+                }
+
+                result.success = converter.convertFileToFile(permutation.stage, permutation.input, permutation.output);
+            }
+
+            result.messages = out.str();
+        }
+    };
+
+    std::chrono::high_resolution_clock::duration totalTime{};
+    {
+        Implementation::Duration d{totalTime};
+
+        /* The calling thread does the work for the first converter */
+        Containers::Array<std::thread> threads{Containers::ValueInit, jobCount - 1};
+        for(std::size_t i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{compile, std::ref(*converters[i + 1])};
+        compile(*converters[0]);
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    /* Report in the manifest order, independently of the order in which the
+       permutations finished */
+    std::size_t failedCount = 0;
+    for(std::size_t i = 0; i != permutations.size(); ++i) {
+        const Permutation& permutation = permutations[i];
+        const PermutationResult& result = results[i];
+        const Float seconds = UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(result.time).count())/1.0e3f;
+
+        if(result.success) {
+            Debug{} << permutation.input << "->" << permutation.output << "took" << seconds << "seconds";
+            if(!result.messages.empty()) Warning{Debug::Flag::NoNewlineAtTheEnd} << result.messages;
+        } else {
+            ++failedCount;
+            Error{} << "Cannot convert" << permutation.input << "to" << permutation.output << "after" << seconds << "seconds:";
+            if(!result.messages.empty()) Error{Debug::Flag::NoNewlineAtTheEnd} << result.messages;
+        }
+    }
+
+    Debug{} << "Compiled" << permutations.size() - failedCount << "out of" << permutations.size() << "permutations on" << jobCount << "threads in" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(totalTime).count())/1.0e3f << "seconds";
+
+    return failedCount ? 27 : 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
     args.addArrayArgument("input").setHelp("input", "input file(s)")
@@ -191,6 +569,9 @@ int main(int argc, char** argv) {
         .addArrayOption("output-format").setHelp("output-format", "output format for each converter", "glsl|spv|spvasm|hlsl|metal")
         .addArrayOption("input-version").setHelp("input-version", "input format version for each converter", "VERSION")
         .addArrayOption("output-version").setHelp("output-version", "output format version for each converter", "VERSION")
+        .addOption("cache-dir").setHelp("cache-dir", "cache conversion results in given directory", "DIR")
+        .addBooleanOption("permutations").setHelp("permutations", "treat input as a permutation manifest and output as an output directory")
+        .addOption('j', "jobs", "0").setHelp("jobs", "number of threads to compile permutations on, 0 for all hardware threads", "N")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --validate is passed, we don't need the output argument */
             if(error == Utility::Arguments::ParseError::MissingArgument &&
@@ -227,7 +608,11 @@ the chain.
 
 Values accepted by -O / --optimize, -g / --debug-info, --input-format,
 --output-format, --input-version and --output-version are converter-specific,
-see documentation of a particular converter for more information.)")
+see documentation of a particular converter for more information.
+
+If --permutations is given, the input is a manifest listing sources, stages and
+variants to compile, which are then compiled concurrently on --jobs threads
+into the output directory.)")
         .parse(argc, argv);
 
     /* Generic checks */
@@ -262,12 +647,20 @@ see documentation of a particular converter for more information.)")
         Error{} << "Can't set both --quiet and --warning-as-error";
         return 6;
     }
+    if(args.isSet("permutations") && (args.isSet("validate") || args.isSet("link") || args.arrayValueCount("converter") > 1)) {
+        Error{} << "The --permutations option can't be combined with --validate, --link or multiple converters";
+        return 23;
+    }
 
     /* Set up a converter manager */
     PluginManager::Manager<ShaderTools::AbstractConverter> converterManager{
         args.value("plugin-dir").empty() ? std::string{} :
         Utility::Directory::join(args.value("plugin-dir"), ShaderTools::AbstractConverter::pluginSearchPaths()[0])};
 
+    /* Permutations are handled completely separately */
+    if(args.isSet("permutations"))
+        return convertPermutations(args, converterManager);
+
     /* Data passed from one converter to another in case there's more than one */
     Containers::Array<char> data;
 
@@ -287,18 +680,6 @@ see documentation of a particular converter for more information.)")
 
         /* Parse format, if passed */
         ShaderTools::Format inputFormat{}, outputFormat{};
-        auto parseFormat = [](Containers::StringView format) -> Containers::Optional<ShaderTools::Format> {
-            if(format == ""_s) return ShaderTools::Format::Unspecified;
-            if(format == "glsl"_s) return ShaderTools::Format::Glsl;
-            if(format == "spv"_s) return ShaderTools::Format::Spirv;
-            if(format == "spvasm"_s) return ShaderTools::Format::SpirvAssembly;
-            if(format == "hlsl"_s) return ShaderTools::Format::Hlsl;
-            if(format == "metal"_s) return ShaderTools::Format::Msl;
-            /** @todo wgsl and dxil once i figure out the extensions */
-
-            Error{} << "Unrecognized format" << format << Debug::nospace << ", expected glsl, spv, spvasm, hlsl or metal";
-            return {};
-        };
         if(i < args.arrayValueCount("input-format")) {
             if(const Containers::Optional<ShaderTools::Format> format = parseFormat(args.arrayValue<Containers::StringView>("input-format", i)))
                 inputFormat = *format;
@@ -386,6 +767,11 @@ see documentation of a particular converter for more information.)")
 
         converter->setFlags(flags);
 
+        /* Cache directory, applied for all converters. Only conversions that
+           go through data are cached, see the AbstractConverter docs. */
+        if(!args.value<Containers::StringView>("cache-dir").isEmpty())
+            converter->setCacheDirectory(args.value<Containers::StringView>("cache-dir"));
+
         /* If validating, do it just with the first passed converter and then
            exit */
         if(args.isSet("validate")) {
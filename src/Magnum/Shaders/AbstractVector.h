@@ -59,6 +59,26 @@ template<UnsignedInt dimensions> class AbstractVector: public GL::AbstractShader
          */
         typedef typename Generic<dimensions>::TextureCoordinates TextureCoordinates;
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Per-vertex draw ID
+         * @m_since_latest
+         *
+         * @ref Magnum::UnsignedInt. Used only if
+         * @ref Vector::Flag::VertexDrawId or
+         * @ref DistanceFieldVector::Flag::VertexDrawId is set, in which case
+         * it's added to the draw offset to pick an item from the uniform
+         * buffers. Shares the location with the
+         * @ref shaders-generic "generic" @ref Generic::ObjectId attribute.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Integer attributes are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Integer attributes are not available in WebGL
+         *      1.0.
+         */
+        typedef GL::Attribute<Generic<dimensions>::ObjectId::Location, UnsignedInt> DrawId;
+        #endif
+
         enum: UnsignedInt {
             /**
              * Color shader output. @ref shaders-generic "Generic output",
@@ -23,11 +23,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(VERTEX_DRAW_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#extension GL_EXT_gpu_shader4: require
+#endif
+
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -58,6 +67,59 @@ uniform mediump mat3 textureMatrix
     ;
 #endif
 
+/* Uniform buffers */
+
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform TransformationProjection {
+    #ifdef TWO_DIMENSIONS
+    highp mat3 transformationProjectionMatrices[DRAW_COUNT];
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 transformationProjectionMatrices[DRAW_COUNT];
+    #else
+    #error
+    #endif
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    /* Columns of the rotation / scaling part, offset in the first two
+       components and the rest being padding */
+    highp vec4 rotationScaling;
+    highp vec4 offsetReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+#ifdef VERTEX_DRAW_ID
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = OBJECT_ID_ATTRIBUTE_LOCATION)
+#endif
+in highp uint vertexDrawId;
+
+flat out highp uint drawId;
+#endif
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -77,6 +139,29 @@ in mediump vec2 textureCoordinates;
 out mediump vec2 interpolatedTextureCoordinates;
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef VERTEX_DRAW_ID
+    drawId = drawOffset + vertexDrawId;
+    #else
+    #define drawId drawOffset
+    #endif
+    highp
+        #ifdef TWO_DIMENSIONS
+        mat3
+        #elif defined(THREE_DIMENSIONS)
+        mat4
+        #else
+        #error
+        #endif
+        transformationProjectionMatrix = transformationProjectionMatrices[drawId];
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        vec3(textureTransformations[drawId].rotationScaling.xy, 0.0),
+        vec3(textureTransformations[drawId].rotationScaling.zw, 0.0),
+        vec3(textureTransformations[drawId].offsetReserved.xy, 1.0));
+    #endif
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     #elif defined(THREE_DIMENSIONS)
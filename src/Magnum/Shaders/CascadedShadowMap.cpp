@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "CascadedShadowMap.h"
+
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/IntersectionBatch.h"
+#include "Magnum/Math/Matrix4.h"
+
+namespace Magnum { namespace Shaders {
+
+struct CascadedShadowMap::State {
+    explicit State(const Vector2i& size, const UnsignedInt cascadeCount): size{size}, cascadeCount{cascadeCount}, splitDistances{cascadeCount}, lightMatrices{cascadeCount}, framebuffer{{{}, size}} {}
+
+    Vector2i size;
+    UnsignedInt cascadeCount;
+    Float splitLambda{0.75f};
+    Float maxDistance{Constants::inf()};
+    Float casterExtension{};
+
+    Containers::Array<Float> splitDistances;
+    Containers::Array<Matrix4> lightMatrices;
+
+    GL::Texture2DArray texture;
+    GL::Framebuffer framebuffer;
+};
+
+CascadedShadowMap::CascadedShadowMap(const Vector2i& size, const UnsignedInt cascadeCount) {
+    CORRADE_ASSERT(size.min() > 0,
+        "Shaders::CascadedShadowMap: expected a positive size, got" << Debug::packed << size, );
+    CORRADE_ASSERT(cascadeCount,
+        "Shaders::CascadedShadowMap: cascade count can't be zero", );
+
+    _state = Containers::pointer<State>(size, cascadeCount);
+
+    /* Comparison enabled so the texture can be sampled directly as
+       sampler2DArrayShadow with hardware PCF */
+    _state->texture
+        .setMinificationFilter(SamplerFilter::Linear)
+        .setMagnificationFilter(SamplerFilter::Linear)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setCompareMode(GL::SamplerCompareMode::CompareRefToTexture)
+        .setCompareFunction(GL::SamplerCompareFunction::LessOrEqual)
+        .setStorage(1, GL::TextureFormat::DepthComponent24, {size, Int(cascadeCount)});
+
+    /* There's no color attachment */
+    _state->framebuffer.mapForDraw(GL::Framebuffer::DrawAttachment::None);
+}
+
+CascadedShadowMap::CascadedShadowMap(NoCreateT) noexcept {}
+
+CascadedShadowMap::CascadedShadowMap(CascadedShadowMap&&) noexcept = default;
+
+CascadedShadowMap::~CascadedShadowMap() = default;
+
+CascadedShadowMap& CascadedShadowMap::operator=(CascadedShadowMap&&) noexcept = default;
+
+Vector2i CascadedShadowMap::size() const { return _state->size; }
+
+UnsignedInt CascadedShadowMap::cascadeCount() const { return _state->cascadeCount; }
+
+Float CascadedShadowMap::splitLambda() const { return _state->splitLambda; }
+
+CascadedShadowMap& CascadedShadowMap::setSplitLambda(const Float lambda) {
+    CORRADE_ASSERT(lambda >= 0.0f && lambda <= 1.0f,
+        "Shaders::CascadedShadowMap::setSplitLambda(): expected a value in the [0, 1] range, got" << lambda, *this);
+    _state->splitLambda = lambda;
+    return *this;
+}
+
+Float CascadedShadowMap::maxDistance() const { return _state->maxDistance; }
+
+CascadedShadowMap& CascadedShadowMap::setMaxDistance(const Float distance) {
+    _state->maxDistance = distance;
+    return *this;
+}
+
+Float CascadedShadowMap::casterExtension() const { return _state->casterExtension; }
+
+CascadedShadowMap& CascadedShadowMap::setCasterExtension(const Float extension) {
+    _state->casterExtension = extension;
+    return *this;
+}
+
+Containers::ArrayView<const Float> CascadedShadowMap::splitDistances() const {
+    return _state->splitDistances;
+}
+
+Containers::ArrayView<const Matrix4> CascadedShadowMap::lightMatrices() const {
+    return _state->lightMatrices;
+}
+
+Frustum CascadedShadowMap::frustum(const UnsignedInt cascade) const {
+    CORRADE_ASSERT(cascade < _state->cascadeCount,
+        "Shaders::CascadedShadowMap::frustum(): index" << cascade << "out of range for" << _state->cascadeCount << "cascades", {});
+    return Frustum::fromMatrix(_state->lightMatrices[cascade]);
+}
+
+GL::Texture2DArray& CascadedShadowMap::texture() { return _state->texture; }
+
+CascadedShadowMap& CascadedShadowMap::update(const Matrix4& projection, const Matrix4& cameraMatrix, const Vector3& lightDirection) {
+    CORRADE_ASSERT(projection[2][3] == -1.0f && projection[3][3] == 0.0f,
+        "Shaders::CascadedShadowMap::update(): expected a perspective projection", *this);
+    CORRADE_ASSERT(projection[2][2] != -1.0f,
+        "Shaders::CascadedShadowMap::update(): expected a finite far plane", *this);
+    CORRADE_ASSERT(lightDirection.isNormalized(),
+        "Shaders::CascadedShadowMap::update(): light direction" << lightDirection << "is not normalized", *this);
+
+    State& state = *_state;
+
+    /* Extract the near and far plane, same as in LightClusters */
+    const Float near = projection[3][2]/(projection[2][2] - 1.0f);
+    const Float far = projection[3][2]/(projection[2][2] + 1.0f);
+    const Float shadowFar = Math::min(far, state.maxDistance);
+
+    /* Practical split scheme, blending between logarithmic and uniform
+       distribution */
+    for(UnsignedInt i = 0; i != state.cascadeCount; ++i) {
+        const Float t = Float(i + 1)/Float(state.cascadeCount);
+        const Float logarithmic = near*std::pow(shadowFar/near, t);
+        const Float uniform = near + (shadowFar - near)*t;
+        state.splitDistances[i] = Math::lerp(uniform, logarithmic, state.splitLambda);
+    }
+
+    /* World-space corners of the view frustum on the near and far plane. A
+       slice is then a linear interpolation between the two, as the
+       view-space depth changes linearly along each corner ray. */
+    const Matrix4 inverseViewProjection = (projection*cameraMatrix).inverted();
+    Vector3 nearCorners[4];
+    Vector3 farCorners[4];
+    for(std::size_t i = 0; i != 4; ++i) {
+        const Vector2 xy{i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f};
+        nearCorners[i] = inverseViewProjection.transformPoint({xy, -1.0f});
+        farCorners[i] = inverseViewProjection.transformPoint({xy, 1.0f});
+    }
+
+    /* Light rotation, shared by all cascades. Picking a different up vector
+       if the light goes (almost) straight down or up. */
+    const Vector3 up = Math::abs(lightDirection.y()) > 0.99f ?
+        Vector3::zAxis() : Vector3::yAxis();
+    const Matrix4 lightRotation = Matrix4::lookAt({}, lightDirection, up).invertedRigid();
+
+    for(UnsignedInt i = 0; i != state.cascadeCount; ++i) {
+        const Float sliceNear = (i ? state.splitDistances[i - 1] : near);
+        const Float sliceFar = state.splitDistances[i];
+        const Float tNear = (sliceNear - near)/(far - near);
+        const Float tFar = (sliceFar - near)/(far - near);
+
+        Vector3 corners[8];
+        Vector3 center;
+        for(std::size_t j = 0; j != 4; ++j) {
+            corners[2*j + 0] = Math::lerp(nearCorners[j], farCorners[j], tNear);
+            corners[2*j + 1] = Math::lerp(nearCorners[j], farCorners[j], tFar);
+            center += corners[2*j + 0] + corners[2*j + 1];
+        }
+        center /= 8.0f;
+
+        /* Fitting a sphere instead of the tight box makes the projection size
+           independent of camera rotation. The radius is rounded up to avoid
+           precision jitter changing the texel size between frames. */
+        Float radius = 0.0f;
+        for(const Vector3& corner: corners)
+            radius = Math::max(radius, (corner - center).length());
+        radius = std::ceil(radius*16.0f)/16.0f;
+
+        /* Snap the center to shadow map texels in light space so the shadow
+           edges don't shimmer when the camera moves. The projection is made
+           one texel larger than the sphere so the snapping, which moves the
+           center by at most half a texel, doesn't cut off its edges. */
+        const Vector2 texelSize = 2.0f*radius/Vector2{Math::max(state.size - Vector2i{1}, Vector2i{1})};
+        Vector3 lightCenter = lightRotation.transformPoint(center);
+        lightCenter.xy() = Math::round(lightCenter.xy()/texelSize)*texelSize;
+
+        /* The light looks down -Z, the near plane is pushed towards the light
+           by the caster extension */
+        state.lightMatrices[i] =
+            Matrix4::orthographicProjection(texelSize*Vector2{state.size}, -radius - state.casterExtension, radius)*
+            Matrix4::translation(-lightCenter)*lightRotation;
+    }
+
+    return *this;
+}
+
+std::size_t CascadedShadowMap::cullInto(const UnsignedInt cascade, const Containers::StridedArrayView1D<const Vector3>& aabbCenters, const Containers::StridedArrayView1D<const Vector3>& aabbExtents, const Containers::ArrayView<UnsignedInt>& out) const {
+    CORRADE_ASSERT(cascade < _state->cascadeCount,
+        "Shaders::CascadedShadowMap::cullInto(): index" << cascade << "out of range for" << _state->cascadeCount << "cascades", {});
+    return Math::Intersection::aabbFrustumIndicesInto(aabbCenters, aabbExtents, Frustum::fromMatrix(_state->lightMatrices[cascade]), out);
+}
+
+CascadedShadowMap& CascadedShadowMap::bindCascade(const UnsignedInt cascade) {
+    CORRADE_ASSERT(cascade < _state->cascadeCount,
+        "Shaders::CascadedShadowMap::bindCascade(): index" << cascade << "out of range for" << _state->cascadeCount << "cascades", *this);
+    _state->framebuffer
+        .attachTextureLayer(GL::Framebuffer::BufferAttachment::Depth, _state->texture, 0, cascade)
+        .clear(GL::FramebufferClear::Depth)
+        .bind();
+    return *this;
+}
+
+}}
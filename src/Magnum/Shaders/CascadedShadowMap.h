@@ -0,0 +1,271 @@
+#ifndef Magnum_Shaders_CascadedShadowMap_h
+#define Magnum_Shaders_CascadedShadowMap_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::CascadedShadowMap
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Cascaded shadow map for a directional light
+@m_since_latest
+
+Splits the view frustum of a camera into depth slices --- cascades --- and for
+each calculates a light matrix covering the slice, so nearby geometry gets
+shadow map texels of the same density as the far away geometry. All cascades
+are rendered into a single @ref GL::Texture2DArray, one layer per cascade,
+with the depth-only shader @ref DepthOnly.
+
+The split distances are calculated in @ref update() using the practical split
+scheme, which blends between logarithmic and uniform distribution based on
+@ref setSplitLambda(). A value of @cpp 1.0f @ce gives a purely logarithmic
+distribution, which matches the perspective aliasing best but makes the
+nearest cascade very small, @cpp 0.0f @ce gives an uniform distribution.
+The shadowed range can be limited with @ref setMaxDistance(), which is useful
+if the camera far plane is much further away than shadows are needed.
+
+Each cascade is fitted with a bounding sphere of its frustum slice, which
+makes the light projection size independent of camera orientation, and the
+light position is snapped to shadow map texels. Together these avoid
+shimmering of shadow edges when the camera moves or rotates.
+
+@snippet MagnumShaders.cpp CascadedShadowMap-usage
+
+The camera is described by its projection and camera matrix, so with
+@ref SceneGraph::Camera you pass @ref SceneGraph::Camera::projectionMatrix()
+and @ref SceneGraph::Camera::cameraMatrix(). The light direction is in world
+space, pointing from the light towards the scene.
+
+@section Shaders-CascadedShadowMap-culling Per-cascade culling
+
+Each cascade covers only a part of the scene, so drawing all shadow casters
+into every cascade is wasteful. The @ref cullInto() function tests a batch of
+axis-aligned bounding boxes against the frustum of given cascade using
+@ref Math::Intersection::aabbFrustumIndicesInto() and outputs indices of those
+that are visible, which can then be used to draw only the relevant meshes.
+The frustum is extended towards the light by @ref setCasterExtension() to
+include occluders that are outside of the slice but still cast a shadow into
+it.
+
+@section Shaders-CascadedShadowMap-rendering Rendering and sampling
+
+The cascades are rendered one after another, @ref bindCascade() attaches the
+corresponding texture layer to an internal depth-only framebuffer, clears it
+and binds it for drawing. The texture has depth comparison enabled, so it can
+be directly sampled as a @glsl sampler2DArrayShadow @ce. When sampling, pick
+the cascade based on fragment view-space depth compared with
+@ref splitDistances() and transform its world-space position with the
+corresponding matrix from @ref lightMatrices(), remapping the result from
+the @f$ [-1, 1] @f$ range to @f$ [0, 1] @f$.
+
+@requires_gl30 Extension @gl_extension{EXT,texture_array}
+@requires_gles30 Array textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Array textures are not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT CascadedShadowMap {
+    public:
+        /**
+         * @brief Constructor
+         * @param size          Size of the shadow map for each cascade
+         * @param cascadeCount  Count of cascades
+         *
+         * Expects that both components of @p size are positive and
+         * @p cascadeCount is non-zero.
+         */
+        explicit CascadedShadowMap(const Vector2i& size = {2048, 2048}, UnsignedInt cascadeCount = 4);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit CascadedShadowMap(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        CascadedShadowMap(const CascadedShadowMap&) = delete;
+
+        /** @brief Move constructor */
+        CascadedShadowMap(CascadedShadowMap&&) noexcept;
+
+        ~CascadedShadowMap();
+
+        /** @brief Copying is not allowed */
+        CascadedShadowMap& operator=(const CascadedShadowMap&) = delete;
+
+        /** @brief Move assignment */
+        CascadedShadowMap& operator=(CascadedShadowMap&&) noexcept;
+
+        /** @brief Shadow map size for each cascade */
+        Vector2i size() const;
+
+        /** @brief Count of cascades */
+        UnsignedInt cascadeCount() const;
+
+        /** @brief Split distribution lambda */
+        Float splitLambda() const;
+
+        /**
+         * @brief Set split distribution lambda
+         * @return Reference to self (for method chaining)
+         *
+         * Expected to be in the @f$ [0, 1] @f$ range. Default is
+         * @cpp 0.75f @ce. Takes effect in the next @ref update().
+         */
+        CascadedShadowMap& setSplitLambda(Float lambda);
+
+        /** @brief Max shadow distance */
+        Float maxDistance() const;
+
+        /**
+         * @brief Set max shadow distance
+         * @return Reference to self (for method chaining)
+         *
+         * If less than the camera far plane, the cascades are distributed
+         * only up to this distance. Default is
+         * @ref Constants::inf() "Constants::inf()", i.e. up to the far plane.
+         * Takes effect in the next @ref update().
+         */
+        CascadedShadowMap& setMaxDistance(Float distance);
+
+        /** @brief Caster extension */
+        Float casterExtension() const;
+
+        /**
+         * @brief Set caster extension
+         * @return Reference to self (for method chaining)
+         *
+         * Distance by which the light frustum of each cascade is extended
+         * towards the light, to include occluders outside of the cascade.
+         * Default is @cpp 0.0f @ce. Takes effect in the next @ref update().
+         */
+        CascadedShadowMap& setCasterExtension(Float extension);
+
+        /**
+         * @brief Split distances
+         *
+         * View-space distances of the far end of each cascade, calculated in
+         * the last @ref update(). The first cascade starts at the camera near
+         * plane.
+         */
+        Containers::ArrayView<const Float> splitDistances() const;
+
+        /**
+         * @brief Light matrices
+         *
+         * Light projection and view matrix for each cascade, calculated in
+         * the last @ref update(). Transforms world-space positions into the
+         * clip space of given cascade.
+         */
+        Containers::ArrayView<const Matrix4> lightMatrices() const;
+
+        /**
+         * @brief Cascade frustum
+         *
+         * Frustum corresponding to given light matrix, including the caster
+         * extension. Expects that @p cascade is less than
+         * @ref cascadeCount().
+         * @see @ref cullInto()
+         */
+        Frustum frustum(UnsignedInt cascade) const;
+
+        /**
+         * @brief Shadow map texture
+         *
+         * A @ref GL::TextureFormat::DepthComponent24 array texture of
+         * @ref size() and @ref cascadeCount() layers, with depth comparison
+         * enabled.
+         */
+        GL::Texture2DArray& texture();
+
+        /**
+         * @brief Calculate cascade splits and light matrices
+         * @param projection        Camera projection matrix
+         * @param cameraMatrix      Camera matrix, i.e. inverse of the camera
+         *      transformation
+         * @param lightDirection    Light direction in world space
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p projection is a perspective projection with a
+         * finite far plane and @p lightDirection is normalized.
+         */
+        CascadedShadowMap& update(const Matrix4& projection, const Matrix4& cameraMatrix, const Vector3& lightDirection);
+
+        /**
+         * @brief Cull bounding boxes against a cascade
+         * @param cascade       Cascade index
+         * @param aabbCenters   World-space bounding box centers
+         * @param aabbExtents   World-space bounding box half-extents
+         * @param out           Where to put indices of visible boxes
+         * @return Count of indices written to @p out
+         *
+         * Expects that @p cascade is less than @ref cascadeCount(),
+         * @p aabbCenters and @p aabbExtents have the same size and @p out is
+         * at least as large. Delegates to
+         * @ref Math::Intersection::aabbFrustumIndicesInto(), see
+         * @ref Shaders-CascadedShadowMap-culling for more information.
+         */
+        std::size_t cullInto(UnsignedInt cascade, const Containers::StridedArrayView1D<const Vector3>& aabbCenters, const Containers::StridedArrayView1D<const Vector3>& aabbExtents, const Containers::ArrayView<UnsignedInt>& out) const;
+
+        /**
+         * @brief Bind a cascade for rendering
+         * @return Reference to self (for method chaining)
+         *
+         * Attaches layer @p cascade of @ref texture() to an internal
+         * framebuffer, clears its depth and binds it for drawing. Draw the
+         * shadow casters with @ref DepthOnly and
+         * @ref DepthOnly::setTransformationProjectionMatrix() set to the
+         * matrix from @ref lightMatrices() multiplied with the object
+         * transformation. Expects that @p cascade is less than
+         * @ref cascadeCount().
+         */
+        CascadedShadowMap& bindCascade(UnsignedInt cascade);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
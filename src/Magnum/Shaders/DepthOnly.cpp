@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "DepthOnly.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
+#include "Magnum/Math/Matrix4.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int { AlphaTextureUnit = 0 };
+}
+
+DepthOnly::DepthOnly(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt jointCount
+    #endif
+): _flags{flags}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _jointCount{jointCount}
+    #endif
+{
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    #else
+    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
+        .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) {
+        vert.addSource(Utility::formatString(
+            "#define JOINT_COUNT {}\n",
+            jointCount));
+        /* Initializer for the joint matrix array, all identities */
+        #ifndef MAGNUM_TARGET_GLES
+        std::string jointMatrixInitializer;
+        jointMatrixInitializer.reserve(jointCount*11 + 36);
+        jointMatrixInitializer += "#define JOINT_MATRIX_INITIALIZER ";
+        for(UnsignedInt i = 0; i != jointCount; ++i) {
+            if(i) jointMatrixInitializer += ", ";
+            jointMatrixInitializer += "mat4(1.0)";
+        }
+        jointMatrixInitializer += '\n';
+        vert.addSource(std::move(jointMatrixInitializer));
+        #endif
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("DepthOnly.vert"));
+    frag.addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
+        .addSource(rs.get("DepthOnly.frag"));
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(!cache || !cache->load(*this, cacheKey))
+    #endif
+    {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            bindAttributeLocation(Position::Location, "position");
+            if(flags & Flag::AlphaMask)
+                bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(jointCount) {
+                bindAttributeLocation(Weights::Location, "weights");
+                bindAttributeLocation(JointIds::Location, "jointIds");
+            }
+            #endif
+            if(flags & Flag::InstancedTransformation)
+                bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+        }
+        #endif
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(jointCount) _jointMatricesUniform = uniformLocation("jointMatrices");
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        if(flags & Flag::AlphaMask)
+            setUniform(uniformLocation("alphaTexture"), AlphaTextureUnit);
+    }
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setTransformationProjectionMatrix(Matrix4{Math::IdentityInit});
+    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) setJointMatrices(Containers::Array<Matrix4>{Containers::DirectInit, jointCount, Math::IdentityInit});
+    #endif
+    #endif
+}
+
+DepthOnly& DepthOnly::setTransformationProjectionMatrix(const Matrix4& matrix) {
+    setUniform(_transformationProjectionMatrixUniform, matrix);
+    return *this;
+}
+
+DepthOnly& DepthOnly::setAlphaMask(const Float mask) {
+    CORRADE_ASSERT(_flags & Flag::AlphaMask,
+        "Shaders::DepthOnly::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
+    setUniform(_alphaMaskUniform, mask);
+    return *this;
+}
+
+DepthOnly& DepthOnly::bindAlphaTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::AlphaMask,
+        "Shaders::DepthOnly::bindAlphaTexture(): the shader was not created with alpha mask enabled", *this);
+    texture.bind(AlphaTextureUnit);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+DepthOnly& DepthOnly::setJointMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(matrices.size() <= _jointCount,
+        "Shaders::DepthOnly::setJointMatrices(): expected at most" << _jointCount << "items but got" << matrices.size(), *this);
+    if(!matrices.empty()) setUniform(_jointMatricesUniform, matrices);
+    return *this;
+}
+
+DepthOnly& DepthOnly::setJointMatrices(const std::initializer_list<Matrix4> matrices) {
+    return setJointMatrices(Containers::arrayView(matrices));
+}
+
+DepthOnly& DepthOnly::setJointMatrix(const UnsignedInt id, const Matrix4& matrix) {
+    CORRADE_ASSERT(id < _jointCount,
+        "Shaders::DepthOnly::setJointMatrix(): joint ID" << id << "is out of bounds for" << _jointCount << "joints", *this);
+    setUniform(_jointMatricesUniform + id, matrix);
+    return *this;
+}
+#endif
+
+Debug& operator<<(Debug& debug, const DepthOnly::Flag value) {
+    debug << "Shaders::DepthOnly::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case DepthOnly::Flag::v: return debug << "::" #v;
+        _c(AlphaMask)
+        _c(InstancedTransformation)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const DepthOnly::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::DepthOnly::Flags{}", {
+        DepthOnly::Flag::AlphaMask,
+        DepthOnly::Flag::InstancedTransformation});
+}
+
+}}
@@ -0,0 +1,323 @@
+#ifndef Magnum_Shaders_DepthOnly_h
+#define Magnum_Shaders_DepthOnly_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::DepthOnly
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Depth-only shader
+@m_since_latest
+
+Transforms a 3D mesh and writes nothing but depth. Meant for shadow map
+rendering, depth prepasses and occlusion passes, where the color and lighting
+calculations done by @ref Flat or @ref Phong would be wasted. You need to
+provide the @ref Position attribute in your triangle mesh. By default, the
+shader renders the mesh in an identity transformation. Use
+@ref setTransformationProjectionMatrix() to configure the shader.
+
+As there's no color output, the shader is expected to be used with a
+framebuffer that has only a depth attachment, such as the one used by
+@ref CascadedShadowMap. If you render into a framebuffer with color
+attachments, for example in a depth prepass, disable color writes with
+@ref GL::Renderer::setColorMask() for the duration of the pass, as the
+contents of the color attachments would be otherwise undefined.
+
+@section Shaders-DepthOnly-alpha-mask Alpha-masked geometry
+
+With @ref Flag::AlphaMask, the shader additionally samples alpha of a texture
+bound with @ref bindAlphaTexture() and discards fragments with alpha less than
+or equal to @ref setAlphaMask(). The mesh then needs to have also the
+@ref TextureCoordinates attribute. Use this for foliage and other cutout
+geometry, for everything else leave the flag disabled --- a shader with a
+@glsl discard @ce disables early depth test on most hardware.
+
+@section Shaders-DepthOnly-instancing Instanced rendering
+
+Enabling @ref Flag::InstancedTransformation will turn the shader into an
+instanced one. It'll take per-instance transformation from the
+@ref TransformationMatrix attribute, applying it before the matrix set by
+@ref setTransformationProjectionMatrix(). The attribute layout is the same as
+with @ref Flat, so the same instance buffer can be used for both the shadow
+and the main pass.
+
+@section Shaders-DepthOnly-skinning Skinning
+
+Passing a non-zero @p jointCount to the constructor makes the shader take
+per-vertex @ref JointIds and @ref Weights attributes and blend the joint
+matrices set with @ref setJointMatrices() before applying the
+transformation, same as in @ref Flat.
+
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT DepthOnly: public GL::AbstractShaderProgram {
+    public:
+        /**
+         * @brief Vertex position
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector3 "Vector3".
+         */
+        typedef Generic3D::Position Position;
+
+        /**
+         * @brief 2D texture coordinates
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector2 "Vector2". Used only if @ref Flag::AlphaMask
+         * is set.
+         */
+        typedef Generic3D::TextureCoordinates TextureCoordinates;
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint weights
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4 "Vector4". Used only if the shader was created
+         * with a non-zero joint count.
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Generic3D::Weights Weights;
+
+        /**
+         * @brief Joint IDs
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector4ui "Vector4ui". Used only if the shader was
+         * created with a non-zero joint count.
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        typedef Generic3D::JointIds JointIds;
+        #endif
+
+        /**
+         * @brief (Instanced) transformation matrix
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Matrix4. Used only if
+         * @ref Flag::InstancedTransformation is set.
+         * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+         * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+         *      @gl_extension{EXT,instanced_arrays} or
+         *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+         * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+         *      in WebGL 1.0.
+         */
+        typedef Generic3D::TransformationMatrix TransformationMatrix;
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Discard fragments whose alpha in the texture bound with
+             * @ref bindAlphaTexture() is less than or equal to
+             * @ref setAlphaMask(). See @ref Shaders-DepthOnly-alpha-mask for
+             * more information.
+             */
+            AlphaMask = 1 << 0,
+
+            /**
+             * Instanced transformation. Retrieves a per-instance
+             * transformation matrix from the @ref TransformationMatrix
+             * attribute and uses it together with the matrix coming from
+             * @ref setTransformationProjectionMatrix() (first the
+             * per-instance, then the uniform matrix). See
+             * @ref Shaders-DepthOnly-instancing for more information.
+             * @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
+             * @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
+             *      @gl_extension{EXT,instanced_arrays} or
+             *      @gl_extension{NV,instanced_arrays} in OpenGL ES 2.0.
+             * @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays}
+             *      in WebGL 1.0.
+             */
+            InstancedTransformation = 1 << 1
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags         Flags
+         * @param jointCount    Count of joint matrices set with
+         *      @ref setJointMatrices(). If @cpp 0 @ce, skinning is disabled.
+         *      Not available on OpenGL ES 2.0 and WebGL 1.0.
+         */
+        explicit DepthOnly(Flags flags = {}
+            #ifndef MAGNUM_TARGET_GLES2
+            , UnsignedInt jointCount = 0
+            #endif
+        );
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit DepthOnly(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        DepthOnly(const DepthOnly&) = delete;
+
+        /** @brief Move constructor */
+        DepthOnly(DepthOnly&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        DepthOnly& operator=(const DepthOnly&) = delete;
+
+        /** @brief Move assignment */
+        DepthOnly& operator=(DepthOnly&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Joint count
+         *
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+        #endif
+
+        /**
+         * @brief Set transformation and projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Default is an identity matrix. For a shadow pass, this is the light
+         * matrix of given cascade multiplied with the object transformation.
+         * @see @ref CascadedShadowMap::lightMatrices()
+         */
+        DepthOnly& setTransformationProjectionMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Set alpha mask value
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::AlphaMask
+         * enabled. Fragments with alpha values less than or equal to
+         * @p mask are discarded. Default is @cpp 0.5f @ce.
+         */
+        DepthOnly& setAlphaMask(Float mask);
+
+        /**
+         * @brief Bind an alpha texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::AlphaMask
+         * enabled. Only the alpha channel of the texture is used.
+         */
+        DepthOnly& bindAlphaTexture(GL::Texture2D& texture);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         *
+         * Initial values are identity transformations. Expects that the size
+         * of the @p matrices array is not larger than @ref jointCount().
+         * @see @ref setJointMatrix(UnsignedInt, const Matrix4&)
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        DepthOnly& setJointMatrices(Containers::ArrayView<const Matrix4> matrices);
+
+        /**
+         * @overload
+         */
+        DepthOnly& setJointMatrices(std::initializer_list<Matrix4> matrices);
+
+        /**
+         * @brief Set joint matrix for given joint
+         * @return Reference to self (for method chaining)
+         *
+         * Unlike @ref setJointMatrices() updates just a single joint matrix.
+         * Expects that @p id is less than @ref jointCount().
+         * @requires_gles30 Skinning is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Skinning is not available in WebGL 1.0.
+         */
+        DepthOnly& setJointMatrix(UnsignedInt id, const Matrix4& matrix);
+        #endif
+
+    private:
+        /* Prevent accidentally calling irrelevant functions */
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        using GL::AbstractShaderProgram::dispatchCompute;
+        #endif
+
+        Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _jointCount{};
+        #endif
+        Int _transformationProjectionMatrixUniform{0},
+            _alphaMaskUniform{1};
+        #ifndef MAGNUM_TARGET_GLES2
+        Int _jointMatricesUniform{2};
+        #endif
+};
+
+/** @debugoperatorclassenum{DepthOnly,DepthOnly::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, DepthOnly::Flag value);
+
+/** @debugoperatorclassenum{DepthOnly,DepthOnly::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, DepthOnly::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(DepthOnly::Flags)
+
+}}
+
+#endif
@@ -0,0 +1,113 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#if defined(JOINT_COUNT) && !defined(GL_ES) && !defined(NEW_GLSL)
+#extension GL_EXT_gpu_shader4: require
+#endif
+
+#ifndef NEW_GLSL
+#define in attribute
+#define out varying
+#endif
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp mat4 transformationProjectionMatrix
+    #ifndef GL_ES
+    = mat4(1.0)
+    #endif
+    ;
+
+/* Location 1 is the alpha mask in the fragment shader */
+
+#ifdef JOINT_COUNT
+/* Has to be last as it occupies JOINT_COUNT locations */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp mat4 jointMatrices[JOINT_COUNT]
+    #ifndef GL_ES
+    = mat4[](JOINT_MATRIX_INITIALIZER)
+    #endif
+    ;
+#endif
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = POSITION_ATTRIBUTE_LOCATION)
+#endif
+in highp vec4 position;
+
+#ifdef ALPHA_MASK
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TEXTURECOORDINATES_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec2 textureCoordinates;
+
+out mediump vec2 interpolatedTextureCoordinates;
+#endif
+
+#ifdef INSTANCED_TRANSFORMATION
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION)
+#endif
+in highp mat4 instancedTransformationMatrix;
+#endif
+
+#ifdef JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINT_IDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+#endif
+
+void main() {
+    #ifdef JOINT_COUNT
+    /* Blend matrices of all joints affecting this vertex */
+    highp mat4 skinMatrix =
+        weights.x*jointMatrices[jointIds.x] +
+        weights.y*jointMatrices[jointIds.y] +
+        weights.z*jointMatrices[jointIds.z] +
+        weights.w*jointMatrices[jointIds.w];
+    #endif
+
+    gl_Position = transformationProjectionMatrix*
+        #ifdef INSTANCED_TRANSFORMATION
+        instancedTransformationMatrix*
+        #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
+        position;
+
+    #ifdef ALPHA_MASK
+    interpolatedTextureCoordinates = textureCoordinates;
+    #endif
+}
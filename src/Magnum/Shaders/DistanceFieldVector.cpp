@@ -27,11 +27,18 @@
 
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -40,7 +47,43 @@
 
 namespace Magnum { namespace Shaders {
 
-template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(const Flags flags): _flags{flags} {
+#ifndef MAGNUM_TARGET_GLES2
+namespace {
+    enum: Int {
+        /* Not using the zero binding to avoid conflicts with
+           ProjectionBufferBinding from other shaders which can likely stay
+           bound to the same buffer for the whole time. Matching bindings of
+           Flat to make it possible to share the buffers. */
+        TransformationProjectionBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4
+    };
+}
+#endif
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+):
+    _flags{flags}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _materialCount{materialCount}, _drawCount{drawCount}
+    #endif
+{
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::DistanceFieldVector: material count can't be zero", );
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::DistanceFieldVector: draw count can't be zero", );
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -58,40 +101,84 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
     vert.addSource(flags & Flag::TextureTransformation ? "#define TEXTURE_TRANSFORMATION\n" : "")
-        .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        vert.addSource(flags >= Flag::VertexDrawId ? "#define VERTEX_DRAW_ID\n" : "");
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("AbstractVector.vert"));
-    frag.addSource(rs.get("generic.glsl"))
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        frag.addSource(flags >= Flag::VertexDrawId ? "#define VERTEX_DRAW_ID\n" : "");
+    }
+    #endif
+    frag.addSource(flags & Flag::MultiChannel ? "#define MULTI_CHANNEL\n" : "")
+        .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("DistanceFieldVector.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    GL::AbstractShaderProgram::attachShaders({vert, frag});
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(!cache || !cache->load(*this, cacheKey))
     #endif
     {
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        GL::AbstractShaderProgram::attachShaders({vert, frag});
+
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::VertexDrawId)
+                GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::DrawId::Location, "vertexDrawId");
+            #endif
+        }
+        #endif
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
     }
-    #endif
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::link());
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = GL::AbstractShaderProgram::uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = GL::AbstractShaderProgram::uniformLocation("textureMatrix");
-        _colorUniform = GL::AbstractShaderProgram::uniformLocation("color");
-        _outlineColorUniform = GL::AbstractShaderProgram::uniformLocation("outlineColor");
-        _outlineRangeUniform = GL::AbstractShaderProgram::uniformLocation("outlineRange");
-        _smoothnessUniform = GL::AbstractShaderProgram::uniformLocation("smoothness");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = GL::AbstractShaderProgram::uniformLocation("drawOffset");
+        } else
+        #endif
+        {
+            _transformationProjectionMatrixUniform = GL::AbstractShaderProgram::uniformLocation("transformationProjectionMatrix");
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = GL::AbstractShaderProgram::uniformLocation("textureMatrix");
+            _colorUniform = GL::AbstractShaderProgram::uniformLocation("color");
+            _outlineColorUniform = GL::AbstractShaderProgram::uniformLocation("outlineColor");
+            _outlineRangeUniform = GL::AbstractShaderProgram::uniformLocation("outlineRange");
+            _smoothnessUniform = GL::AbstractShaderProgram::uniformLocation("smoothness");
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -100,25 +187,53 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldV
     {
         GL::AbstractShaderProgram::setUniform(GL::AbstractShaderProgram::uniformLocation("vectorTexture"),
             AbstractVector<dimensions>::VectorTextureUnit);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(flags & Flag::TextureTransformation)
+                GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("Material"), MaterialBufferBinding);
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    setColor(Color4{1.0f}); /* Outline color is zero by default */
-    setOutlineRange(0.5f, 1.0f);
-    setSmoothness(0.04f);
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        setColor(Color4{1.0f}); /* Outline color is zero by default */
+        setOutlineRange(0.5f, 1.0f);
+        setSmoothness(0.04f);
+    }
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>::DistanceFieldVector(const Flags flags): DistanceFieldVector{flags, 1, 1} {}
+#endif
+
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
 
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setTextureMatrix(const Matrix3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::DistanceFieldVector::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     GL::AbstractShaderProgram::setUniform(_textureMatrixUniform, matrix);
@@ -126,25 +241,112 @@ template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldV
 }
 
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setColor(const Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_colorUniform, color);
     return *this;
 }
 
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setOutlineColor(const Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setOutlineColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_outlineColorUniform, color);
     return *this;
 }
 
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setOutlineRange(Float start, Float end) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setOutlineRange(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_outlineRangeUniform, Vector2(start, end));
     return *this;
 }
 
 template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setSmoothness(Float value) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::DistanceFieldVector::setSmoothness(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_smoothnessUniform, value);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::DistanceFieldVector::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    GL::AbstractShaderProgram::setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> DistanceFieldVector<dimensions>& DistanceFieldVector<dimensions>::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::DistanceFieldVector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 template class DistanceFieldVector<2>;
 template class DistanceFieldVector<3>;
 
@@ -157,6 +359,11 @@ Debug& operator<<(Debug& debug, const DistanceFieldVectorFlag value) {
         /* LCOV_EXCL_START */
         #define _c(v) case DistanceFieldVectorFlag::v: return debug << "::" #v;
         _c(TextureTransformation)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        _c(VertexDrawId)
+        #endif
+        _c(MultiChannel)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -166,7 +373,12 @@ Debug& operator<<(Debug& debug, const DistanceFieldVectorFlag value) {
 
 Debug& operator<<(Debug& debug, const DistanceFieldVectorFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Shaders::DistanceFieldVector::Flags{}", {
-        DistanceFieldVectorFlag::TextureTransformation
+        DistanceFieldVectorFlag::TextureTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        DistanceFieldVectorFlag::VertexDrawId, /* Superset of UniformBuffers */
+        DistanceFieldVectorFlag::UniformBuffers,
+        #endif
+        DistanceFieldVectorFlag::MultiChannel
         });
 }
 
@@ -23,12 +23,21 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(VERTEX_DRAW_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#extension GL_EXT_gpu_shader4: require
+#endif
+
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
 #define texture texture2D
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -61,6 +70,55 @@ uniform lowp float smoothness
     #endif
     ;
 
+/* Uniform buffers */
+
+#else
+#ifndef VERTEX_DRAW_ID
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+struct DrawUniform {
+    highp uint materialId;
+    highp uint reserved0;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 color;
+    lowp vec4 outlineColor;
+    /* Outline start, end and smoothness in the first three components, the
+       rest being padding */
+    lowp vec4 outlineRangeSmoothnessReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+#endif
+
 #ifdef EXPLICIT_TEXTURE_LAYER
 /* See AbstractVector.h for details about the ID */
 layout(binding = 6)
@@ -77,7 +135,21 @@ out lowp vec4 fragmentColor;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 color = materials[materialId].color;
+    lowp vec4 outlineColor = materials[materialId].outlineColor;
+    lowp vec2 outlineRange = materials[materialId].outlineRangeSmoothnessReserved.xy;
+    lowp float smoothness = materials[materialId].outlineRangeSmoothnessReserved.z;
+    #endif
+
+    #ifndef MULTI_CHANNEL
     lowp float intensity = texture(vectorTexture, interpolatedTextureCoordinates).r;
+    #else
+    /* Median of the three channels */
+    lowp vec3 channels = texture(vectorTexture, interpolatedTextureCoordinates).rgb;
+    lowp float intensity = max(min(channels.r, channels.g), min(max(channels.r, channels.g), channels.b));
+    #endif
 
     /* Fill color */
     fragmentColor = smoothstep(outlineRange.x-smoothness, outlineRange.x+smoothness, intensity)*color;
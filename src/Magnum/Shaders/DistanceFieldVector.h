@@ -26,22 +26,194 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::DistanceFieldVector, typedef @ref Magnum::Shaders::DistanceFieldVector2D, @ref Magnum::Shaders::DistanceFieldVector3D
+ * @brief Class @ref Magnum::Shaders::DistanceFieldVector, typedef @ref Magnum::Shaders::DistanceFieldVector2D, @ref Magnum::Shaders::DistanceFieldVector3D, struct @ref Magnum::Shaders::DistanceFieldVectorDrawUniform, @ref Magnum::Shaders::DistanceFieldVectorMaterialUniform
  */
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Shaders/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Color.h"
+#endif
+
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
     enum class DistanceFieldVectorFlag: UnsignedByte {
-        TextureTransformation = 1 << 0
+        TextureTransformation = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 1,
+        VertexDrawId = UniformBuffers|(1 << 2),
+        #endif
+        MultiChannel = 1 << 3
     };
     typedef Containers::EnumSet<DistanceFieldVectorFlag> DistanceFieldVectorFlags;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for distance field vector shaders
+@m_since_latest
+
+Together with the generic @ref TransformationProjectionUniform2D /
+@ref TransformationProjectionUniform3D contains parameters that are specific
+to each draw call. Material-related properties are expected to be shared among
+multiple draw calls and thus are provided in a separate
+@ref DistanceFieldVectorMaterialUniform structure, referenced by
+@ref materialId.
+@see @ref DistanceFieldVector::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct DistanceFieldVectorDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit DistanceFieldVectorDrawUniform() noexcept: materialId{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit DistanceFieldVectorDrawUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    DistanceFieldVectorDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Material ID
+     *
+     * References a particular material from a
+     * @ref DistanceFieldVectorMaterialUniform array. Useful when an UBO with
+     * more than one material is supplied or when drawing with
+     * @ref DistanceFieldVector::Flag::VertexDrawId. Should be less than the
+     * material count passed to the
+     * @ref DistanceFieldVector::DistanceFieldVector(Flags, UnsignedInt, UnsignedInt)
+     * constructor. Default value is @cpp 0 @ce, meaning the first material
+     * gets used.
+     */
+    UnsignedInt materialId;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    Int:32;
+    #endif
+};
+
+/**
+@brief Material uniform for distance field vector shaders
+@m_since_latest
+
+Describes material properties referenced from
+@ref DistanceFieldVectorDrawUniform::materialId.
+@see @ref DistanceFieldVector::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct DistanceFieldVectorMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit DistanceFieldVectorMaterialUniform() noexcept: color{1.0f, 1.0f, 1.0f, 1.0f}, outlineColor{0.0f, 0.0f, 0.0f, 0.0f}, outlineStart{0.5f}, outlineEnd{1.0f}, smoothness{0.04f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit DistanceFieldVectorMaterialUniform(NoInitT) noexcept: color{NoInit}, outlineColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    DistanceFieldVectorMaterialUniform& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref outlineColor field
+     * @return Reference to self (for method chaining)
+     */
+    DistanceFieldVectorMaterialUniform& setOutlineColor(const Color4& color) {
+        outlineColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref outlineStart and @ref outlineEnd fields
+     * @return Reference to self (for method chaining)
+     */
+    DistanceFieldVectorMaterialUniform& setOutlineRange(Float start, Float end) {
+        outlineStart = start;
+        outlineEnd = end;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref smoothness field
+     * @return Reference to self (for method chaining)
+     */
+    DistanceFieldVectorMaterialUniform& setSmoothness(Float smoothness) {
+        this->smoothness = smoothness;
+        return *this;
+    }
+
+    /**
+     * @brief Fill color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce.
+     * @see @ref DistanceFieldVector::setColor()
+     */
+    Color4 color;
+
+    /**
+     * @brief Outline color
+     *
+     * Default value is @cpp 0x00000000_rgbaf @ce and the outline is not
+     * drawn --- see @ref outlineStart and @ref outlineEnd for more
+     * information.
+     * @see @ref DistanceFieldVector::setOutlineColor()
+     */
+    Color4 outlineColor;
+
+    /**
+     * @brief Outline start
+     *
+     * Describes where fill ends and possible outline starts. Default value
+     * is @cpp 0.5f @ce.
+     * @see @ref DistanceFieldVector::setOutlineRange()
+     */
+    Float outlineStart;
+
+    /**
+     * @brief Outline end
+     *
+     * Describes where outline ends. If set to a value larger than
+     * @ref outlineStart, the outline is not drawn. Default value is
+     * @cpp 1.0f @ce.
+     * @see @ref DistanceFieldVector::setOutlineRange()
+     */
+    Float outlineEnd;
+
+    /**
+     * @brief Smoothness radius
+     *
+     * Default value is @cpp 0.04f @ce.
+     * @see @ref DistanceFieldVector::setSmoothness()
+     */
+    Float smoothness;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+};
+#endif
+
 /**
 @brief Distance field vector shader
 
@@ -72,6 +244,51 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp DistanceFieldVector-usage2
 
+@section Shaders-DistanceFieldVector-ubo Uniform buffers
+
+When @ref Flag::UniformBuffers is enabled, the shader doesn't use any of the
+individual uniform setters and instead takes the parameters from uniform
+buffers. Transformation is supplied in a
+@ref TransformationProjectionUniform2D / @ref TransformationProjectionUniform3D
+buffer bound with @ref bindTransformationProjectionBuffer(), per-draw
+parameters in a @ref DistanceFieldVectorDrawUniform buffer bound with
+@ref bindDrawBuffer() and materials, referenced by
+@ref DistanceFieldVectorDrawUniform::materialId, in a
+@ref DistanceFieldVectorMaterialUniform buffer bound with
+@ref bindMaterialBuffer(). If @ref Flag::TextureTransformation is enabled, the
+texture transformation is taken from a @ref TextureTransformationUniform
+buffer bound with @ref bindTextureTransformationBuffer(). The draw buffers are
+expected to contain at least as many items as the @p drawCount passed to the
+@ref DistanceFieldVector(Flags, UnsignedInt, UnsignedInt) constructor, the
+material buffer at least @p materialCount items. The item is selected with
+@ref setDrawOffset():
+
+@snippet MagnumShaders.cpp DistanceFieldVector-ubo
+
+Enabling @ref Flag::VertexDrawId additionally makes the shader add the value
+of the per-vertex @ref DrawId attribute to the draw offset. A single mesh can
+then contain many pieces, each with its own transformation and material, and
+still be drawn with a single draw call. This is what
+@ref Text::BatchRenderer uses to render many strings at once.
+
+@section Shaders-DistanceFieldVector-multi-channel Multi-channel distance fields
+
+A single-channel distance field rounds off sharp corners unless its resolution
+is high enough. With @ref Flag::MultiChannel enabled, the shader expects a
+multi-channel distance field in the red, green and blue channels of the
+texture, such as one produced by
+@ref TextureTools::multiChannelDistanceField() or
+@ref Text::MultiChannelDistanceFieldGlyphCache, and reconstructs the shape
+from a median of the three, keeping the corners sharp at a two to four times
+smaller texture size. The remaining parameters have the same meaning as with
+a single-channel distance field. A single-channel distance field replicated to
+all three channels renders the same with and without the flag.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+
 @see @ref shaders, @ref DistanceFieldVector2D, @ref DistanceFieldVector3D
 @todo Use fragment shader derivations to have proper smoothness in perspective/
     large zoom levels, make it optional as it might have negative performance
@@ -92,7 +309,51 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
              * @see @ref setTextureMatrix()
              * @m_since{2020,06}
              */
-            TextureTransformation = 1 << 0
+            TextureTransformation = 1 << 0,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindTransformationProjectionBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer()
+             * and @ref bindMaterialBuffer() instead of direct uniform
+             * setters. See @ref Shaders-DistanceFieldVector-ubo for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 1,
+
+            /**
+             * Take the draw index from the per-vertex @ref DrawId attribute.
+             * Implies @ref Flag::UniformBuffers and adds the attribute value
+             * to the offset set in @ref setDrawOffset(), which makes it
+             * possible to draw many differently transformed and colored
+             * pieces of a single mesh in a single draw call. See
+             * @ref Shaders-DistanceFieldVector-ubo for more information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            VertexDrawId = UniformBuffers|(1 << 2),
+            #endif
+
+            /**
+             * Render a multi-channel distance field, reconstructing the shape
+             * from a median of the red, green and blue channel instead of
+             * taking just the red channel. See
+             * @ref Shaders-DistanceFieldVector-multi-channel for more
+             * information.
+             * @m_since_latest
+             */
+            MultiChannel = 1 << 3
         };
 
         /**
@@ -115,6 +376,36 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          */
         explicit DistanceFieldVector(Flags flags = {});
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for given uniform buffer sizes
+         * @param flags         Flags
+         * @param materialCount Size of a @ref DistanceFieldVectorMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationProjectionUniform2D
+         *      / @ref TransformationProjectionUniform3D /
+         *      @ref DistanceFieldVectorDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p materialCount
+         * and @p drawCount describe the uniform buffer sizes as these are
+         * required to have a statically defined size. The draw offset is
+         * then set via @ref setDrawOffset(). Expects that both counts are
+         * non-zero.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref DistanceFieldVector(Flags).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit DistanceFieldVector(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -152,11 +443,42 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          */
         Flags flags() const { return _flags; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref DistanceFieldVectorMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref DistanceFieldVectorDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Initial value is an identity matrix.
+         * Initial value is an identity matrix. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationProjectionUniform2D::transformationProjectionMatrix
+         * / @ref TransformationProjectionUniform3D::transformationProjectionMatrix
+         * and call @ref bindTransformationProjectionBuffer() instead.
          */
         DistanceFieldVector<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
@@ -167,7 +489,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          *
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
-         * identity matrix.
+         * identity matrix. If @ref Flag::UniformBuffers is set, fill
+         * @ref TextureTransformationUniform and call
+         * @ref bindTextureTransformationBuffer() instead.
          */
         DistanceFieldVector<dimensions>& setTextureMatrix(const Matrix3& matrix);
 
@@ -175,7 +499,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          * @brief Set fill color
          * @return Reference to self (for method chaining)
          *
-         * Initial value is @cpp 0xffffffff_rgbaf @ce.
+         * Initial value is @cpp 0xffffffff_rgbaf @ce. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref DistanceFieldVectorMaterialUniform::color and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref setOutlineColor()
          */
         DistanceFieldVector<dimensions>& setColor(const Color4& color);
@@ -185,7 +512,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          * @return Reference to self (for method chaining)
          *
          * Initial value is @cpp 0x00000000_rgbaf @ce and the outline is not
-         * drawn --- see @ref setOutlineRange() for more information.
+         * drawn --- see @ref setOutlineRange() for more information. Expects
+         * that @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref DistanceFieldVectorMaterialUniform::outlineColor and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref setOutlineRange(), @ref setColor()
          */
         DistanceFieldVector<dimensions>& setOutlineColor(const Color4& color);
@@ -202,6 +532,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          * larger than @p start the outline is not drawn. Initial value is
          * @cpp 1.0f @ce.
          *
+         * Expects that @ref Flag::UniformBuffers is not set, in that case
+         * fill @ref DistanceFieldVectorMaterialUniform::outlineStart and
+         * @ref DistanceFieldVectorMaterialUniform::outlineEnd and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref setOutlineColor()
          */
         DistanceFieldVector<dimensions>& setOutlineRange(Float start, Float end);
@@ -212,10 +546,121 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
          *
          * Larger values will make edges look less aliased (but blurry),
          * smaller values will make them look more crisp (but possibly
-         * aliased). Initial value is @cpp 0.04f @ce.
+         * aliased). Initial value is @cpp 0.04f @ce. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref DistanceFieldVectorMaterialUniform::smoothness and call
+         * @ref bindMaterialBuffer() instead.
          */
         DistanceFieldVector<dimensions>& setSmoothness(Float value);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the @ref TransformationProjectionUniform2D
+         * / @ref TransformationProjectionUniform3D, @ref DistanceFieldVectorDrawUniform
+         * and @ref TextureTransformationUniform buffers should be used for
+         * current draw. Expects that @ref Flag::UniformBuffers is set and
+         * @p offset is less than @ref drawCount(). Initial value is
+         * @cpp 0 @ce. If @ref Flag::VertexDrawId is set, the value of the
+         * @ref DrawId attribute is added to this value, which makes each
+         * vertex pick up its own item.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        DistanceFieldVector<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref DistanceFieldVectorDrawUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        DistanceFieldVector<dimensions>& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        DistanceFieldVector<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref DistanceFieldVectorMaterialUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        DistanceFieldVector<dimensions>& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        DistanceFieldVector<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Overloads to remove WTF-factor from method chaining order */
         DistanceFieldVector<dimensions>& bindVectorTexture(GL::Texture2D& texture) {
@@ -234,12 +679,20 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT DistanceFieldVector
         #endif
 
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
             _colorUniform{2},
             _outlineColorUniform{3},
             _outlineRangeUniform{4},
             _smoothnessUniform{5};
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
+        #endif
 };
 
 /** @brief Two-dimensional distance field vector shader */
@@ -25,14 +25,24 @@
 
 #include "Flat.h"
 
+#if defined(MAGNUM_TARGET_GLES) && !defined(MAGNUM_TARGET_GLES2)
+#include <Corrade/Containers/Array.h>
+#endif
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #include "Magnum/GL/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -43,11 +53,61 @@ namespace Magnum { namespace Shaders {
 
 namespace {
     enum: Int { TextureUnit = 0 };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        /* Not using the zero binding to avoid conflicts with
+           ProjectionBufferBinding from other shaders which can likely stay
+           bound to the same buffer for the whole time */
+        TransformationProjectionBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4,
+        /* 5 is used by the light buffer in Phong, using the same binding for
+           joints in both to make it possible to share the joint buffer */
+        JointBufferBinding = 6,
+        #ifndef MAGNUM_TARGET_GLES
+        TextureHandleBufferBinding = 7
+        #endif
+    };
+
+    enum: UnsignedInt { MultiviewViewCount = 2 };
+    #endif
 }
 
-template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _flags(flags) {
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount, const UnsignedInt jointCount
+    #endif
+) {
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & Flag::Textured),
-        "Shaders::Flat: texture transformation enabled but the shader is not textured", );
+        "Shaders::Flat: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Flat: material count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Flat: draw count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags & Flag::Multiview) || !(flags >= Flag::UniformBuffers),
+        "Shaders::Flat: multiview can't be combined with uniform buffers", CompileState{NoCreate});
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(flags >= Flag::BindlessTextures) || (flags & Flag::Textured),
+        "Shaders::Flat: bindless textures enabled but the shader is not textured", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::OVR::multiview2);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    if(flags >= Flag::BindlessTextures)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::bindless_texture);
+    #endif
 
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
@@ -57,7 +117,10 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    /* ARB_bindless_texture is written against GLSL 4.00, which is available
+       on every implementation supporting the extension */
+    const GL::Version version = flags >= Flag::BindlessTextures ? GL::Version::GL400 :
+        GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
     #else
     const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #endif
@@ -73,8 +136,45 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
-        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) {
+        vert.addSource(Utility::formatString(
+            "#define JOINT_COUNT {}\n",
+            jointCount));
+        /* Initializer for the joint matrix array, all identities. With
+           uniform buffers the data come from the buffer instead. */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!(flags >= Flag::UniformBuffers)) {
+            std::string jointMatrixInitializer;
+            jointMatrixInitializer.reserve(jointCount*11 + 36);
+            jointMatrixInitializer += "#define JOINT_MATRIX_INITIALIZER ";
+            for(UnsignedInt i = 0; i != jointCount; ++i) {
+                if(i) jointMatrixInitializer += ", ";
+                jointMatrixInitializer += dimensions == 2 ? "mat3(1.0)" : "mat4(1.0)";
+            }
+            jointMatrixInitializer += '\n';
+            vert.addSource(std::move(jointMatrixInitializer));
+        }
+        #endif
+    }
+    if(flags & Flag::Multiview) {
+        vert.addSource(Utility::formatString(
+            "#define MULTIVIEW\n"
+            "#define VIEW_COUNT {}\n",
+            UnsignedInt(MultiviewViewCount)));
+    }
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.vert"));
     frag.addSource(flags & Flag::Textured ? "#define TEXTURED\n" : "")
         .addSource(flags & Flag::AlphaMask ? "#define ALPHA_MASK\n" : "")
@@ -83,12 +183,48 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
         .addSource(flags & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
         .addSource(flags >= Flag::InstancedObjectId ? "#define INSTANCED_OBJECT_ID\n" : "")
         #endif
-        .addSource(rs.get("generic.glsl"))
+        ;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "")
+            .addSource(flags >= Flag::BindlessTextures ? "#define BINDLESS_TEXTURES\n" : "");
+        #endif
+    }
+    #endif
+    frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Flat.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    Flat<dimensions> out{NoInit};
+    out._flags = flags;
+    #ifndef MAGNUM_TARGET_GLES2
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+    out._jointCount = jointCount;
+    #endif
 
-    attachShaders({vert, frag});
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached, the
+       shaders are then not needed anymore */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(cache && cache->load(out, cacheKey)) {
+        CompileState state{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+        state._cacheKey = std::move(cacheKey);
+        return state;
+    }
+    #endif
+
+    vert.submitCompile();
+    frag.submitCompile();
+
+    out.attachShaders({vert, frag});
 
     /* ES3 has this done in the shader directly and doesn't even provide
        bindFragmentDataLocation() */
@@ -97,66 +233,206 @@ template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): _fla
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
+        out.bindAttributeLocation(Position::Location, "position");
         if(flags & Flag::Textured)
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
         if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
         #ifndef MAGNUM_TARGET_GLES2
         if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            out.bindFragmentDataLocation(ColorOutput, "color");
+            out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
         if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        if(jointCount) {
+            out.bindAttributeLocation(Weights::Location, "weights");
+            out.bindAttributeLocation(JointIds::Location, "jointIds");
+        }
         #endif
         if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
         if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    out.submitLink();
+
+    CompileState state{std::move(out), std::move(vert), std::move(frag), version};
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    state._cacheKey = std::move(cacheKey);
+    #endif
+    return state;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(CompileState&& state): Flat{static_cast<Flat&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a NoCreate'd
+       CompileState. Exiting so we don't crash. */
+    if(!id()) return;
+    #endif
+
+    /* Shaders are empty if the program was loaded from the binary cache */
+    if(state._vert.id()) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::checkCompile({state._vert, state._frag}));
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache())
+            cache->save(*this, state._cacheKey);
+        #endif
+    }
+
+    const Flags flags = _flags;
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _colorUniform = uniformLocation("color");
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+        } else
         #endif
+        {
+            #ifndef MAGNUM_TARGET_GLES2
+            if(!(flags & Flag::Multiview))
+            #endif
+            {
+                _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+            }
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            _colorUniform = uniformLocation("color");
+            if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            if(_jointCount) _jointMatricesUniform = uniformLocation("jointMatrices");
+            #endif
+        }
     }
 
+    /* The per-view matrix array has no explicit location as it'd occupy
+       more than one, query it always */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrices");
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::Textured) setUniform(uniformLocation("textureData"), TextureUnit);
+        if((flags & Flag::Textured)
+            #ifndef MAGNUM_TARGET_GLES
+            && !(flags >= Flag::BindlessTextures)
+            #endif
+        )
+            setUniform(uniformLocation("textureData"), TextureUnit);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            setUniformBlockBinding(uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(flags & Flag::TextureTransformation)
+                setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+            if(_jointCount)
+                setUniformBlockBinding(uniformBlockIndex("Joint"), JointBufferBinding);
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags >= Flag::BindlessTextures)
+                setUniformBlockBinding(uniformBlockIndex("TextureHandle"), TextureHandleBufferBinding);
+            #endif
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    setColor(Magnum::Color4{1.0f});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::Multiview)
+            setTransformationProjectionMatrices({MatrixTypeFor<dimensions, Float>{Math::IdentityInit}, MatrixTypeFor<dimensions, Float>{Math::IdentityInit}});
+        else
+        #endif
+        {
+            setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+        }
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        setColor(Magnum::Color4{1.0f});
+        if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_jointCount) setJointMatrices(Containers::Array<MatrixTypeFor<dimensions, Float>>{Containers::DirectInit, _jointCount, Math::IdentityInit});
+        #endif
+    }
     #endif
 }
 
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount, const UnsignedInt jointCount
+    #endif
+): Flat{compile(flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , materialCount, drawCount, jointCount
+    #endif
+)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags) {
+    return compile(flags, 1, 1, 0);
+}
+
+template<UnsignedInt dimensions> typename Flat<dimensions>::CompileState Flat<dimensions>::compile(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount) {
+    return compile(flags, materialCount, drawCount, 0);
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags): Flat{flags, 1, 1, 0} {}
+
+template<UnsignedInt dimensions> Flat<dimensions>::Flat(const Flags flags, const UnsignedInt materialCount, const UnsignedInt drawCount): Flat{flags, materialCount, drawCount, 0} {}
+#endif
+
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::Multiview),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with multiview enabled, use setTransformationProjectionMatrices() instead", *this);
+    #endif
     setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationProjectionMatrices(const Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices) {
+    CORRADE_ASSERT(_flags & Flag::Multiview,
+        "Shaders::Flat::setTransformationProjectionMatrices(): the shader was not created with multiview enabled", *this);
+    CORRADE_ASSERT(matrices.size() == MultiviewViewCount,
+        "Shaders::Flat::setTransformationProjectionMatrices(): expected" << UnsignedInt(MultiviewViewCount) << "items but got" << matrices.size(), *this);
+    setUniform(_transformationProjectionMatrixUniform, matrices);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTransformationProjectionMatrices(const std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices) {
+    return setTransformationProjectionMatrices(Containers::arrayView(matrices));
+}
+#endif
+
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureMatrix(const Matrix3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Flat::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     setUniform(_textureMatrixUniform, matrix);
@@ -164,6 +440,10 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setTextureM
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_colorUniform, color);
     return *this;
 }
@@ -171,11 +451,19 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setColor(co
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::Textured,
         "Shaders::Flat::bindTexture(): the shader was not created with texturing enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Flat::bindTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     texture.bind(TextureUnit);
     return *this;
 }
 
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMask(Float mask) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setAlphaMask(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Flat::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
     setUniform(_alphaMaskUniform, mask);
@@ -184,11 +472,138 @@ template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setAlphaMas
 
 #ifndef MAGNUM_TARGET_GLES2
 template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setObjectId(UnsignedInt id) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setObjectId(): the shader was created with uniform buffers enabled", *this);
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Flat::setObjectId(): the shader was not created with object ID enabled", *this);
     setUniform(_objectIdUniform, id);
     return *this;
 }
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setJointMatrices(const Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setJointMatrices(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= _jointCount,
+        "Shaders::Flat::setJointMatrices(): expected at most" << _jointCount << "items but got" << matrices.size(), *this);
+    if(!matrices.empty()) setUniform(_jointMatricesUniform, matrices);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setJointMatrices(const std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices) {
+    return setJointMatrices(Containers::arrayView(matrices));
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setJointMatrix(const UnsignedInt id, const MatrixTypeFor<dimensions, Float>& matrix) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Flat::setJointMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(id < _jointCount,
+        "Shaders::Flat::setJointMatrix(): joint ID" << id << "is out of bounds for" << _jointCount << "joints", *this);
+    setUniform(_jointMatricesUniform + id, matrix);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Flat::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindJointBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_jointCount,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with joints", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindJointBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_jointCount,
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with joints", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureHandleBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::Flat::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureHandleBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Flat<dimensions>& Flat<dimensions>::bindTextureHandleBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::Flat::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureHandleBufferBinding, offset, size);
+    return *this;
+}
+#endif
 #endif
 
 template class Flat<2>;
@@ -212,11 +627,19 @@ Debug& operator<<(Debug& debug, const FlatFlag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        _c(Multiview)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        _c(BindlessTextures)
+        #endif
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const FlatFlags value) {
@@ -230,7 +653,16 @@ Debug& operator<<(Debug& debug, const FlatFlags value) {
         FlatFlag::InstancedObjectId, /* Superset of ObjectId */
         FlatFlag::ObjectId,
         #endif
-        FlatFlag::InstancedTransformation});
+        FlatFlag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        FlatFlag::Multiview,
+        #ifndef MAGNUM_TARGET_GLES
+        FlatFlag::MultiDraw, /* Superset of UniformBuffers */
+        FlatFlag::BindlessTextures, /* Superset of UniformBuffers */
+        #endif
+        FlatFlag::UniformBuffers
+        #endif
+        });
 }
 
 }
@@ -27,19 +27,28 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture: require
+#endif
+
 #ifndef NEW_GLSL
 #define fragmentColor gl_FragColor
 #define texture texture2D
 #define in varying
 #endif
 
-#ifdef TEXTURED
+#if defined(TEXTURED) && !defined(BINDLESS_TEXTURES)
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 0)
 #endif
 uniform lowp sampler2D textureData;
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -68,6 +77,68 @@ layout(location = 4)
 uniform highp uint objectId; /* defaults to zero */
 #endif
 
+/* Uniform buffers */
+
+#else
+#ifndef MULTI_DRAW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+struct DrawUniform {
+    highp uint materialId;
+    highp uint objectId;
+    highp uint jointOffset;
+    highp uint reserved0;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 color;
+    /* Alpha mask in the first component, the rest being padding */
+    lowp vec4 alphaMaskReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+#ifdef BINDLESS_TEXTURES
+struct TextureHandleUniform {
+    /* 64-bit handle in the first two components, the rest being padding */
+    highp uvec4 handleReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 7
+    #endif
+) uniform TextureHandle {
+    TextureHandleUniform textureHandles[DRAW_COUNT];
+};
+#endif
+#endif
+
 #ifdef TEXTURED
 in mediump vec2 interpolatedTextureCoordinates;
 #endif
@@ -95,6 +166,20 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp uint objectId = draws[drawId].objectId;
+    #endif
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 color = materials[materialId].color;
+    #ifdef ALPHA_MASK
+    lowp float alphaMask = materials[materialId].alphaMaskReserved.x;
+    #endif
+    #ifdef BINDLESS_TEXTURES
+    lowp sampler2D textureData = sampler2D(textureHandles[drawId].handleReserved.xy);
+    #endif
+    #endif
+
     fragmentColor =
         #ifdef TEXTURED
         texture(textureData, interpolatedTextureCoordinates)*
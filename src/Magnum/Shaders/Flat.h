@@ -26,18 +26,23 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D
+ * @brief Class @ref Magnum::Shaders::Flat, typedef @ref Magnum::Shaders::Flat2D, @ref Magnum::Shaders::Flat3D, struct @ref Magnum::Shaders::FlatDrawUniform, @ref Magnum::Shaders::FlatMaterialUniform
  */
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Color.h"
+#endif
+
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
-    enum class FlatFlag: UnsignedByte {
+    enum class FlatFlag: UnsignedShort {
         Textured = 1 << 0,
         AlphaMask = 1 << 1,
         VertexColor = 1 << 2,
@@ -47,11 +52,219 @@ namespace Implementation {
         InstancedObjectId = (1 << 5)|ObjectId,
         #endif
         InstancedTransformation = 1 << 6,
-        InstancedTextureOffset = (1 << 7)|TextureTransformation
+        InstancedTextureOffset = (1 << 7)|TextureTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 8,
+        Multiview = 1 << 11,
+        #ifndef MAGNUM_TARGET_GLES
+        MultiDraw = UniformBuffers|(1 << 9),
+        BindlessTextures = UniformBuffers|(1 << 10)
+        #endif
+        #endif
     };
     typedef Containers::EnumSet<FlatFlag> FlatFlags;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for flat shaders
+@m_since_latest
+
+Together with the generic @ref TransformationProjectionUniform2D /
+@ref TransformationProjectionUniform3D contains parameters that are specific
+to each draw call. Material-related properties are expected to be shared among
+multiple draw calls and thus are provided in a separate
+@ref FlatMaterialUniform structure, referenced by @ref materialId.
+@see @ref Flat::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit FlatDrawUniform() noexcept: materialId{0}, objectId{0}, jointOffset{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatDrawUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref jointOffset field
+     * @return Reference to self (for method chaining)
+     */
+    FlatDrawUniform& setJointOffset(UnsignedInt offset) {
+        jointOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Material ID
+     *
+     * References a particular material from a @ref FlatMaterialUniform
+     * array. Useful when an UBO with more than one material is supplied or
+     * in a multi-draw scenario. Should be less than the material count passed
+     * to the @ref Flat::Flat(Flags, UnsignedInt, UnsignedInt) constructor.
+     * Default value is @cpp 0 @ce, meaning the first material gets used.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Unlike @ref Flat::setObjectId(), this value is per-draw. Used only if
+     * @ref Flat::Flag::ObjectId is enabled, ignored otherwise. If
+     * @ref Flat::Flag::InstancedObjectId is enabled as well, this value is
+     * added to the ID coming from the @ref Flat::ObjectId attribute. Default
+     * value is @cpp 0 @ce.
+     */
+    UnsignedInt objectId;
+
+    /**
+     * @brief Joint offset
+     *
+     * Index of the first joint matrix from the @ref TransformationUniform2D /
+     * @ref TransformationUniform3D joint buffer used by given draw, the
+     * per-vertex @ref Flat::JointIds are relative to it. Used only if the
+     * shader was created with a non-zero joint count, ignored otherwise.
+     * Default value is @cpp 0 @ce.
+     */
+    UnsignedInt jointOffset;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+};
+
+/**
+@brief Material uniform for flat shaders
+@m_since_latest
+
+Describes material properties referenced from
+@ref FlatDrawUniform::materialId.
+@see @ref Flat::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct FlatMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit FlatMaterialUniform() noexcept: color{1.0f, 1.0f, 1.0f, 1.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatMaterialUniform(NoInitT) noexcept: color{NoInit} {}
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    FlatMaterialUniform& setAlphaMask(Float alphaMask) {
+        this->alphaMask = alphaMask;
+        return *this;
+    }
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce. If
+     * @ref Flat::Flag::Textured is set, the color is multiplied with the
+     * texture.
+     * @see @ref Flat::setColor()
+     */
+    Color4 color;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Used only if @ref Flat::Flag::AlphaMask is enabled, ignored otherwise.
+     * Default value is @cpp 0.5f @ce.
+     * @see @ref Flat::setAlphaMask()
+     */
+    Float alphaMask;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    Int:32;
+    #endif
+};
+
+#ifndef MAGNUM_TARGET_GLES
+/**
+@brief Texture handle uniform for flat shaders
+@m_since_latest
+
+Supplies a bindless texture handle for each draw, indexed the same way as
+@ref FlatDrawUniform.
+@see @ref Flat::bindTextureHandleBuffer(), @ref Shaders-Flat-bindless
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_extension Extension @gl_extension{ARB,bindless_texture}
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+*/
+struct FlatTextureHandleUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit FlatTextureHandleUniform() noexcept: textureHandle{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit FlatTextureHandleUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref textureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    FlatTextureHandleUniform& setTextureHandle(UnsignedLong handle) {
+        textureHandle = handle;
+        return *this;
+    }
+
+    /**
+     * @brief Texture handle
+     *
+     * A resident handle returned from @ref GL::AbstractTexture::handle() or
+     * @ref GL::TextureResidency::use(). Default value is @cpp 0 @ce, which
+     * is not a valid handle and has to be replaced before drawing.
+     */
+    UnsignedLong textureHandle;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    #endif
+};
+#endif
+#endif
+
 /**
 @brief Flat shader
 
@@ -142,6 +355,9 @@ color to a mesh:
 
 @snippet MagnumShaders.cpp Flat-usage-instancing
 
+On desktop GL, @ref InstanceBuffer can be used to stream per-instance data
+that change every frame through a persistently mapped buffer.
+
 @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
 @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
     @gl_extension{EXT,instanced_arrays} or @gl_extension{NV,instanced_arrays}
@@ -149,6 +365,114 @@ color to a mesh:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Flat-skinning Skinning
+
+Passing a non-zero @p jointCount to
+@ref Flat(Flags, UnsignedInt, UnsignedInt, UnsignedInt) makes the shader
+deform the mesh by a palette of joint matrices, with each vertex being
+affected by up to four joints referenced by the @ref JointIds attribute and
+blended together with the @ref Weights attribute. The skinning is applied
+before the instanced and the uniform transformation. In the classic uniform
+scenario the @p materialCount and @p drawCount are ignored and the joint
+matrices are uploaded with @ref setJointMatrices(), initially all being
+identity:
+
+@snippet MagnumShaders.cpp Flat-skinning
+
+The joint matrices are usually calculated as joint transformations relative
+to the skinned object multiplied by the inverse bind matrices from
+@ref Trade::SkinData, for example with
+@ref SceneGraph::Object::jointMatricesInto(). With
+@ref Flag::UniformBuffers, the joint matrices are supplied in a
+@ref TransformationUniform2D / @ref TransformationUniform3D buffer of
+@p jointCount items bound with @ref bindJointBuffer() and
+@ref FlatDrawUniform::jointOffset selects where the joints of given draw
+start, which allows many differently animated instances to be drawn from a
+single buffer.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gles30 Skinning requires integer support in shaders, which is not
+    available in OpenGL ES 2.0 or WebGL 1.0.
+
+@section Shaders-Flat-multiview Single-pass stereo rendering
+
+With @ref Flag::Multiview, the shader renders into two views at once using
+@gl_extension{OVR,multiview2}, which halves the number of draws compared to
+rendering the scene once for each eye. The transformation and projection
+matrix for each view is supplied with @ref setTransformationProjectionMatrices()
+and picked in the shader based on @glsl gl_ViewID_OVR @ce. The framebuffer is
+expected to have two-layer @ref GL::Texture2DArray attachments set up with
+@ref GL::Framebuffer::attachTextureMultiview(), the first layer receiving the
+first view and the second layer the second:
+
+@snippet MagnumShaders.cpp Flat-multiview
+
+The flag can't be combined with @ref Flag::UniformBuffers at the moment.
+
+@requires_extension Extension @gl_extension{OVR,multiview2}
+@requires_es_extension Extension @gl_extension{OVR,multiview2}
+@requires_webgl_extension Extension @webgl_extension{OVR,multiview2}
+@requires_gles30 Multiview is not available in OpenGL ES 2.0.
+@requires_webgl20 Multiview is not available in WebGL 1.0.
+
+@section Shaders-Flat-ubo Uniform buffers
+
+When @ref Flag::UniformBuffers is enabled, the shader doesn't use any of the
+individual uniform setters and instead takes the parameters from uniform
+buffers, which allows the same buffers to be reused across many draws and
+avoids the per-draw uniform upload overhead. Transformation is supplied in
+a @ref TransformationProjectionUniform2D / @ref TransformationProjectionUniform3D
+buffer bound with @ref bindTransformationProjectionBuffer(), per-draw
+parameters in a @ref FlatDrawUniform buffer bound with @ref bindDrawBuffer()
+and materials, referenced by @ref FlatDrawUniform::materialId, in a
+@ref FlatMaterialUniform buffer bound with @ref bindMaterialBuffer(). If
+@ref Flag::TextureTransformation is enabled, the texture transformation is
+taken from a @ref TextureTransformationUniform buffer bound with
+@ref bindTextureTransformationBuffer(). The transformation, draw and texture
+transformation buffers are expected to contain at least as many items as the
+@p drawCount passed to the @ref Flat(Flags, UnsignedInt, UnsignedInt)
+constructor, the material buffer at least @p materialCount items. The item is
+selected with @ref setDrawOffset():
+
+@snippet MagnumShaders.cpp Flat-ubo
+
+On desktop GL, enabling @ref Flag::MultiDraw additionally makes the shader
+add the draw index coming from @glsl gl_DrawID @ce to the draw offset, which
+means a whole list of @ref GL::MeshView instances referencing different parts
+of the same mesh can be drawn with a single
+@ref draw(Containers::ArrayView<const Containers::Reference<GL::MeshView>>)
+call, which then maps to @fn_gl_keyword{MultiDrawElements} or
+@fn_gl_keyword{MultiDrawArrays}:
+
+@snippet MagnumShaders.cpp Flat-multidraw
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers, @gl_extension{ARB,shader_draw_parameters}
+    for @ref Flag::MultiDraw
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+@requires_gl Multi-draw with @glsl gl_DrawID @ce is not available in OpenGL
+    ES or WebGL.
+
+@section Shaders-Flat-bindless Bindless textures
+
+With @ref Flag::MultiDraw, draws referencing different parts of the same mesh
+can be submitted at once, but only as long as they all use the same texture.
+Enabling @ref Flag::BindlessTextures makes the shader take the texture from a
+bindless handle supplied for each draw in a @ref FlatTextureHandleUniform
+buffer bound with @ref bindTextureHandleBuffer(), which is expected to contain
+at least as many items as the @p drawCount passed to the constructor. No
+texture needs to be bound then, so draws with thousands of distinct textures
+can still be issued in a single call. The handles are expected to be resident,
+which is easiest to achieve with @ref GL::TextureResidency:
+
+@snippet MagnumShaders.cpp Flat-bindless
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_extension Extension @gl_extension{ARB,bindless_texture} for
+    @ref Flag::BindlessTextures
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+
 @see @ref shaders, @ref Flat2D, @ref Flat3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::AbstractShaderProgram {
@@ -203,6 +527,32 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         typedef typename Generic<dimensions>::ObjectId ObjectId;
+
+        /**
+         * @brief Joint weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector4.
+         * Used only if the shader was created with a non-zero joint count.
+         * See @ref Shaders-Flat-skinning for more information.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::Weights Weights;
+
+        /**
+         * @brief Joint IDs
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector4ui.
+         * Used only if the shader was created with a non-zero joint count.
+         * See @ref Shaders-Flat-skinning for more information.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef typename Generic<dimensions>::JointIds JointIds;
         #endif
 
         /**
@@ -267,7 +617,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedByte {
+        enum class Flag: UnsignedShort {
             /**
              * Multiply color with a texture.
              * @see @ref setColor(), @ref bindTexture()
@@ -363,7 +713,72 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 7)|TextureTransformation
+            InstancedTextureOffset = (1 << 7)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindTransformationProjectionBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer()
+             * and @ref bindMaterialBuffer() instead of direct uniform
+             * setters. See @ref Shaders-Flat-ubo for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 8,
+
+            /**
+             * Render into two views at once, with the transformation and
+             * projection matrix picked based on @glsl gl_ViewID_OVR @ce.
+             * Expects the matrices to be supplied via
+             * @ref setTransformationProjectionMatrices(), can't be combined
+             * with @ref Flag::UniformBuffers. See
+             * @ref Shaders-Flat-multiview for more information.
+             * @requires_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_es_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_webgl_extension Extension
+             *      @webgl_extension{OVR,multiview2}
+             * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+             * @requires_webgl20 Multiview is not available in WebGL 1.0.
+             * @m_since_latest
+             */
+            Multiview = 1 << 11,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value of
+             * @glsl gl_DrawID @ce to the offset set in @ref setDrawOffset().
+             * See @ref Shaders-Flat-ubo for more information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multi-draw with @glsl gl_DrawID @ce is not
+             *      available in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 9),
+
+            /**
+             * Take the texture from a bindless handle. Implies
+             * @ref Flag::UniformBuffers and expects that
+             * @ref Flag::Textured is enabled as well. Instead of
+             * @ref bindTexture(), the texture handle is taken from a
+             * @ref FlatTextureHandleUniform buffer bound with
+             * @ref bindTextureHandleBuffer(). See @ref Shaders-Flat-bindless
+             * for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             * @m_since_latest
+             */
+            BindlessTextures = UniformBuffers|(1 << 10)
+            #endif
+            #endif
         };
 
         /**
@@ -379,12 +794,130 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         typedef Implementation::FlatFlags Flags;
         #endif
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Flat(Flags) can perform an asynchronous
+         * compilation and linking. See @ref shaders-async for more
+         * information.
+         * @see @ref Flat(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags = {});
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Flat(Flags, UnsignedInt, UnsignedInt) can perform
+         * an asynchronous compilation and linking. See @ref shaders-async
+         * for more information.
+         * @see @ref Flat(CompileState&&), @ref compile(Flags)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+
+        /**
+         * @brief Compile a skinned shader asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Flat(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         * can perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref Flat(CompileState&&)
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount, UnsignedInt jointCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags     Flags
+         *
+         * While this function is meant mainly for the classic uniform
+         * scenario (without @ref Flag::UniformBuffers set), it's equivalent
+         * to @ref Flat(Flags, UnsignedInt, UnsignedInt) with
+         * @p materialCount and @p drawCount set to @cpp 1 @ce.
+         * @see @ref compile(Flags)
          */
         explicit Flat(Flags flags = {});
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for a multi-draw scenario
+         * @param flags         Flags
+         * @param materialCount Size of a @ref FlatMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationProjectionUniform2D
+         *      / @ref TransformationProjectionUniform3D /
+         *      @ref FlatDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p materialCount
+         * and @p drawCount describe the uniform buffer sizes as these are
+         * required to have a statically defined size. The draw offset is
+         * then set via @ref setDrawOffset(). Expects that both counts are
+         * non-zero.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref Flat(Flags).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         * @see @ref compile(Flags, UnsignedInt, UnsignedInt)
+         */
+        explicit Flat(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+
+        /**
+         * @brief Construct a skinned shader
+         * @param flags         Flags
+         * @param materialCount Size of a @ref FlatMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationProjectionUniform2D
+         *      / @ref TransformationProjectionUniform3D /
+         *      @ref FlatDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @param jointCount    Count of joint matrices set with
+         *      @ref setJointMatrices() or size of a
+         *      @ref TransformationUniform2D / @ref TransformationUniform3D
+         *      buffer bound with @ref bindJointBuffer()
+         * @m_since_latest
+         *
+         * Behaves like @ref Flat(Flags, UnsignedInt, UnsignedInt), with
+         * a non-zero @p jointCount additionally enabling skinning. See
+         * @ref Shaders-Flat-skinning for more information.
+         * @see @ref compile(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        explicit Flat(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount, UnsignedInt jointCount);
+        #endif
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit Flat(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -414,14 +947,84 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref FlatMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref FlatDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Joint count
+         * @m_since_latest
+         *
+         * Count of joint matrices, or statically defined size of the
+         * @ref TransformationUniform2D / @ref TransformationUniform3D joint
+         * uniform buffer if @ref Flag::UniformBuffers is set. If zero, the
+         * shader doesn't do skinning.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Initial value is an identity matrix.
+         * Initial value is an identity matrix. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationProjectionUniform2D::transformationProjectionMatrix
+         * / @ref TransformationProjectionUniform3D::transformationProjectionMatrix
+         * and call @ref bindTransformationProjectionBuffer() instead. Expects
+         * that @ref Flag::Multiview is not set either, use
+         * @ref setTransformationProjectionMatrices() in that case.
          */
         Flat<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set per-view transformation and projection matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::Multiview is set and that @p matrices has
+         * exactly two items, the first used for the view with
+         * @glsl gl_ViewID_OVR @ce equal to @cpp 0 @ce and the second for
+         * the view with @glsl gl_ViewID_OVR @ce equal to @cpp 1 @ce. Initial
+         * value is an identity matrix for both. See
+         * @ref Shaders-Flat-multiview for more information.
+         * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Multiview is not available in WebGL 1.0.
+         */
+        Flat<dimensions>& setTransformationProjectionMatrices(Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& setTransformationProjectionMatrices(std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices);
+        #endif
+
         /**
          * @brief Set texture coordinate transformation matrix
          * @return Reference to self (for method chaining)
@@ -429,7 +1032,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
-         * identity matrix.
+         * identity matrix. Expects that @ref Flag::UniformBuffers is not
+         * set, in that case fill @ref TextureTransformationUniform and call
+         * @ref bindTextureTransformationBuffer() instead.
          */
         Flat<dimensions>& setTextureMatrix(const Matrix3& matrix);
 
@@ -439,7 +1044,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          *
          * If @ref Flag::Textured is set, initial value is
          * @cpp 0xffffffff_rgbaf @ce and the color will be multiplied with the
-         * texture.
+         * texture. Expects that @ref Flag::UniformBuffers is not set, in that
+         * case fill @ref FlatMaterialUniform::color and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref bindTexture()
          */
         Flat<dimensions>& setColor(const Magnum::Color4& color);
@@ -462,7 +1069,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * Expects that the shader was created with @ref Flag::AlphaMask
          * enabled. Fragments with alpha values smaller than the mask value
          * will be discarded. Initial value is @cpp 0.5f @ce. See the flag
-         * documentation for further information.
+         * documentation for further information. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref FlatMaterialUniform::alphaMask and call
+         * @ref bindMaterialBuffer() instead.
          *
          * This corresponds to @m_class{m-doc-external} [glAlphaFunc()](https://www.khronos.org/registry/OpenGL-Refpages/gl2.1/xhtml/glAlphaFunc.xml)
          * in classic OpenGL.
@@ -480,14 +1090,214 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
          * @ref Shaders-Flat-object-id for more information. Default is
          * @cpp 0 @ce. If @ref Flag::InstancedObjectId is enabled as well, this
          * value is combined with ID coming from the @ref ObjectId attribute.
+         * Expects that @ref Flag::UniformBuffers is not set, in that case
+         * fill @ref FlatDrawUniform::objectId and call @ref bindDrawBuffer()
+         * instead.
          * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
          * @requires_gles30 Object ID output requires integer support in
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         Flat<dimensions>& setObjectId(UnsignedInt id);
+
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Sets the first @cpp matrices.size() @ce joint matrices, expects
+         * that it's not more than @ref jointCount(). Initial value of all
+         * joint matrices is an identity. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill a
+         * @ref TransformationUniform2D / @ref TransformationUniform3D buffer
+         * and call @ref bindJointBuffer() instead. See
+         * @ref Shaders-Flat-skinning for more information.
+         * @see @ref setJointMatrix()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        Flat<dimensions>& setJointMatrices(Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& setJointMatrices(std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @brief Set joint matrix for given joint
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Unlike @ref setJointMatrices() updates just a single joint matrix.
+         * Expects that @p id is less than @ref jointCount() and that
+         * @ref Flag::UniformBuffers is not set.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        Flat<dimensions>& setJointMatrix(UnsignedInt id, const MatrixTypeFor<dimensions, Float>& matrix);
+
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the @ref TransformationProjectionUniform2D
+         * / @ref TransformationProjectionUniform3D, @ref FlatDrawUniform and
+         * @ref TextureTransformationUniform buffers should be used for
+         * current draw. Expects that @ref Flag::UniformBuffers is set and
+         * @p offset is less than @ref drawCount(). Initial value is
+         * @cpp 0 @ce. If @ref Flag::MultiDraw is set, @glsl gl_DrawID @ce is
+         * added to this value, which makes each draw submitted via
+         * @ref draw(Containers::ArrayView<const Containers::Reference<GL::MeshView>>)
+         * pick up its own item.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref FlatDrawUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref FlatMaterialUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set and
+         * @ref jointCount() is not zero. The buffer is expected to contain
+         * @ref jointCount() instances of @ref TransformationUniform2D /
+         * @ref TransformationUniform3D. See @ref Shaders-Flat-skinning for
+         * more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Flat<dimensions>& bindJointBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindJointBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set a texture handle uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::BindlessTextures is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref FlatTextureHandleUniform. See @ref Shaders-Flat-bindless for
+         * more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Flat<dimensions>& bindTextureHandleBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Flat<dimensions>& bindTextureHandleBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
         #endif
 
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit Flat(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -497,15 +1307,46 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Flat: public GL::Ab
         #endif
 
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{}, _jointCount{};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
             _colorUniform{2},
             _alphaMaskUniform{3};
         #ifndef MAGNUM_TARGET_GLES2
-        Int _objectIdUniform{4};
+        Int _objectIdUniform{4},
+            /* Needs to be last as it occupies jointCount locations */
+            _jointMatricesUniform{5};
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
         #endif
 };
 
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref Flat::compile(). See @ref shaders-async for more information.
+*/
+template<UnsignedInt dimensions> class Flat<dimensions>::CompileState: public Flat<dimensions> {
+    /* Everything deliberately private except for the inheritance */
+    friend class Flat;
+
+    explicit CompileState(NoCreateT): Flat{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(Flat<dimensions>&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): Flat<dimensions>{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    /* If the program was loaded from a GL::ProgramBinaryCache, the shaders
+       are empty and nothing is checked */
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    std::string _cacheKey;
+    #endif
+};
+
 /** @brief 2D flat shader */
 typedef Flat<2> Flat2D;
 
@@ -23,15 +23,52 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(JOINT_COUNT)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
+#ifdef MULTIVIEW
+#extension GL_OVR_multiview2: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifdef MULTIVIEW
+layout(num_views = VIEW_COUNT) in;
+#endif
+
+#ifndef UNIFORM_BUFFERS
+#ifdef MULTIVIEW
+/* Not using an explicit location as the array would occupy VIEW_COUNT
+   locations */
+#ifdef TWO_DIMENSIONS
+uniform highp mat3 transformationProjectionMatrices[VIEW_COUNT]
+    #ifndef GL_ES
+    = mat3[](mat3(1.0), mat3(1.0))
+    #endif
+    ;
+#elif defined(THREE_DIMENSIONS)
+uniform highp mat4 transformationProjectionMatrices[VIEW_COUNT]
+    #ifndef GL_ES
+    = mat4[](mat4(1.0), mat4(1.0))
+    #endif
+    ;
+#else
+#error
+#endif
+#define transformationProjectionMatrix transformationProjectionMatrices[gl_ViewID_OVR]
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -50,6 +87,7 @@ uniform highp mat4 transformationProjectionMatrix
 #else
 #error
 #endif
+#endif
 
 #ifdef TEXTURE_TRANSFORMATION
 #ifdef EXPLICIT_UNIFORM_LOCATION
@@ -62,6 +100,109 @@ uniform mediump mat3 textureMatrix
     ;
 #endif
 
+#ifdef JOINT_COUNT
+/* Has to be last as it occupies JOINT_COUNT locations */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 5)
+#endif
+#ifdef TWO_DIMENSIONS
+uniform highp mat3 jointMatrices[JOINT_COUNT]
+    #ifndef GL_ES
+    = mat3[](JOINT_MATRIX_INITIALIZER)
+    #endif
+    ;
+#elif defined(THREE_DIMENSIONS)
+uniform highp mat4 jointMatrices[JOINT_COUNT]
+    #ifndef GL_ES
+    = mat4[](JOINT_MATRIX_INITIALIZER)
+    #endif
+    ;
+#else
+#error
+#endif
+#endif
+
+/* Uniform buffers */
+
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform TransformationProjection {
+    #ifdef TWO_DIMENSIONS
+    highp mat3 transformationProjectionMatrices[DRAW_COUNT];
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 transformationProjectionMatrices[DRAW_COUNT];
+    #else
+    #error
+    #endif
+};
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    /* Columns of the rotation / scaling part, offset in the first two
+       components and the rest being padding */
+    highp vec4 rotationScaling;
+    highp vec4 offsetReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+#ifdef JOINT_COUNT
+/* Needed only for the joint offset, has to match the declaration in
+   Flat.frag */
+struct DrawUniform {
+    highp uint materialId;
+    highp uint objectId;
+    highp uint jointOffset;
+    highp uint reserved0;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 6
+    #endif
+) uniform Joint {
+    #ifdef TWO_DIMENSIONS
+    highp mat3 jointMatrices[JOINT_COUNT];
+    #elif defined(THREE_DIMENSIONS)
+    highp mat4 jointMatrices[JOINT_COUNT];
+    #else
+    #error
+    #endif
+};
+#endif
+
+#ifdef MULTI_DRAW
+flat out highp uint drawId;
+#endif
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -120,18 +261,81 @@ layout(location = TEXTURE_OFFSET_ATTRIBUTE_LOCATION)
 in mediump vec2 instancedTextureOffset;
 #endif
 
+#ifdef JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINT_IDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+#endif
+
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #else
+    #define drawId drawOffset
+    #endif
+    highp
+        #ifdef TWO_DIMENSIONS
+        mat3
+        #elif defined(THREE_DIMENSIONS)
+        mat4
+        #else
+        #error
+        #endif
+        transformationProjectionMatrix = transformationProjectionMatrices[drawId];
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        vec3(textureTransformations[drawId].rotationScaling.xy, 0.0),
+        vec3(textureTransformations[drawId].rotationScaling.zw, 0.0),
+        vec3(textureTransformations[drawId].offsetReserved.xy, 1.0));
+    #endif
+    #ifdef JOINT_COUNT
+    highp uint jointOffset = draws[drawId].jointOffset;
+    #endif
+    #else
+    #define jointOffset 0u
+    #endif
+
+    #ifdef JOINT_COUNT
+    /* Blend matrices of all joints affecting this vertex */
+    highp
+        #ifdef TWO_DIMENSIONS
+        mat3
+        #elif defined(THREE_DIMENSIONS)
+        mat4
+        #else
+        #error
+        #endif
+        skinMatrix =
+            weights.x*jointMatrices[jointOffset + jointIds.x] +
+            weights.y*jointMatrices[jointOffset + jointIds.y] +
+            weights.z*jointMatrices[jointOffset + jointIds.z] +
+            weights.w*jointMatrices[jointOffset + jointIds.w];
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         vec3(position, 1.0), 0.0);
     #elif defined(THREE_DIMENSIONS)
     gl_Position = transformationProjectionMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         position;
     #else
     #error
@@ -26,11 +26,16 @@
 */
 
 /** @file
- * @brief Struct @ref Magnum::Shaders::Generic, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D
+ * @brief Struct @ref Magnum::Shaders::Generic, typedef @ref Magnum::Shaders::Generic2D, @ref Magnum::Shaders::Generic3D, @ref Magnum::Shaders::TransformationProjectionUniform2D, @ref Magnum::Shaders::TransformationProjectionUniform3D, @ref Magnum::Shaders::ProjectionUniform3D, @ref Magnum::Shaders::TransformationUniform2D, @ref Magnum::Shaders::TransformationUniform3D, @ref Magnum::Shaders::TextureTransformationUniform
  */
 
 #include "Magnum/GL/Attribute.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#endif
+
 namespace Magnum { namespace Shaders {
 
 /**
@@ -122,13 +127,13 @@ both bitangents and object ID for instancing, \n
 <tr>
 <td>6</td>
 <td colspan="3">
-* *Reserved* --- vertex weights
+@ref Weights
 </td>
 </tr>
 <tr>
 <td>7</td>
 <td colspan="3">
-* *Reserved* --- bone indices
+@ref JointIds
 </td>
 </tr>
 <tr>
@@ -146,13 +151,13 @@ both bitangents and object ID for instancing, \n
 <tr>
 <td>10</td>
 <td colspan="2">
-* *Reserved* --- 2nd vertex weights
+* *Reserved* --- 2nd set of joint weights
 </td>
 </tr>
 <tr>
 <td>11</td>
 <td colspan="2">
-* *Reserved* --- 2nd bone indices
+* *Reserved* --- 2nd set of joint IDs
 </td>
 </tr>
 <tr>
@@ -377,7 +382,35 @@ template<UnsignedInt dimensions> struct Generic {
      */
     typedef GL::Attribute<5, Vector3> Normal;
 
-    /* 6, 7 reserved for vertex weights / bone IDs */
+    #ifndef MAGNUM_TARGET_GLES2
+    /**
+     * @brief Joint weights
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4 "Vector4", weights of up to four joints referenced
+     * by @ref JointIds that affect given vertex. Weights of unused joints are
+     * expected to be zero. Currently doesn't have a corresponding
+     * @ref Trade::MeshAttribute.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}, as it's used
+     *      only together with @ref JointIds
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0 or WebGL 1.0.
+     */
+    typedef GL::Attribute<6, Vector4> Weights;
+
+    /**
+     * @brief Joint IDs
+     * @m_since_latest
+     *
+     * @ref Magnum::Vector4ui "Vector4ui", indices of up to four joints that
+     * affect given vertex, with the weights supplied in @ref Weights.
+     * Currently doesn't have a corresponding @ref Trade::MeshAttribute.
+     * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Skinning requires integer support in shaders, which
+     *      is not available in OpenGL ES 2.0 or WebGL 1.0.
+     */
+    typedef GL::Attribute<7, Vector4ui> JointIds;
+    #endif
 
     /**
      * @brief (Instanced) transformation matrix
@@ -436,6 +469,275 @@ typedef Generic<2> Generic2D;
 /** @brief Generic 3D shader definition */
 typedef Generic<3> Generic3D;
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief 2D transformation and projection uniform common for all shaders
+@m_since_latest
+
+Contents of the transformation and projection uniform buffer for shaders
+created with @ref Flat::Flag::UniformBuffers, one item per draw. The layout
+matches the @glsl std140 @ce layout of a @glsl mat3 @ce, which is why the
+matrix is stored padded to a @ref Matrix3x4.
+@see @ref Flat::bindTransformationProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform2D {
+    /** @brief Construct with default parameters */
+    constexpr explicit TransformationProjectionUniform2D() noexcept: transformationProjectionMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform2D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @ref Matrix3x4, with the bottom row being
+     * zeros.
+     */
+    TransformationProjectionUniform2D& setTransformationProjectionMatrix(const Matrix3& matrix) {
+        transformationProjectionMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix, with the bottom row being zeros.
+     * @see @ref Flat::setTransformationProjectionMatrix()
+     */
+    Matrix3x4 transformationProjectionMatrix;
+};
+
+/**
+@brief 3D transformation and projection uniform common for all shaders
+@m_since_latest
+
+Contents of the transformation and projection uniform buffer for shaders
+created with @ref Flat::Flag::UniformBuffers, one item per draw.
+@see @ref Flat::bindTransformationProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationProjectionUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr explicit TransformationProjectionUniform3D() noexcept: transformationProjectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationProjectionUniform3D(NoInitT) noexcept: transformationProjectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationProjectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationProjectionUniform3D& setTransformationProjectionMatrix(const Matrix4& matrix) {
+        transformationProjectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation and projection matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Flat::setTransformationProjectionMatrix()
+     */
+    Matrix4 transformationProjectionMatrix;
+};
+
+/**
+@brief 3D projection uniform common for all shaders
+@m_since_latest
+
+Contents of the projection uniform buffer for shaders created with
+@ref Phong::Flag::UniformBuffers. Unlike the other uniforms, there's just one
+item shared by all draws.
+@see @ref Phong::bindProjectionBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct ProjectionUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr explicit ProjectionUniform3D() noexcept: projectionMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit ProjectionUniform3D(NoInitT) noexcept: projectionMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref projectionMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    ProjectionUniform3D& setProjectionMatrix(const Matrix4& matrix) {
+        projectionMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Projection matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Phong::setProjectionMatrix()
+     */
+    Matrix4 projectionMatrix;
+};
+
+/**
+@brief 2D transformation uniform common for all shaders
+@m_since_latest
+
+Contents of the joint matrix uniform buffer for 2D shaders created with
+@ref Flat::Flag::UniformBuffers and a non-zero joint count, one item per
+joint. The layout matches the @glsl std140 @ce layout of a @glsl mat3 @ce,
+which is why the matrix is stored padded to a @ref Matrix3x4.
+@see @ref Flat::bindJointBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationUniform2D {
+    /** @brief Construct with default parameters */
+    constexpr explicit TransformationUniform2D() noexcept: transformationMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationUniform2D(NoInitT) noexcept: transformationMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @ref Matrix3x4, with the bottom row being
+     * zeros.
+     */
+    TransformationUniform2D& setTransformationMatrix(const Matrix3& matrix) {
+        transformationMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Transformation matrix
+     *
+     * Default value is an identity matrix, with the bottom row being zeros.
+     * @see @ref Flat::setJointMatrices()
+     */
+    Matrix3x4 transformationMatrix;
+};
+
+/**
+@brief 3D transformation uniform common for all shaders
+@m_since_latest
+
+Contents of the transformation uniform buffer for shaders created with
+@ref Phong::Flag::UniformBuffers, one item per draw. Also used for the joint
+matrix uniform buffer of 3D shaders created with a non-zero joint count, one
+item per joint.
+@see @ref Phong::bindTransformationBuffer(), @ref Phong::bindJointBuffer(),
+    @ref Flat::bindJointBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TransformationUniform3D {
+    /** @brief Construct with default parameters */
+    constexpr explicit TransformationUniform3D() noexcept: transformationMatrix{Math::IdentityInit} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TransformationUniform3D(NoInitT) noexcept: transformationMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref transformationMatrix field
+     * @return Reference to self (for method chaining)
+     */
+    TransformationUniform3D& setTransformationMatrix(const Matrix4& matrix) {
+        transformationMatrix = matrix;
+        return *this;
+    }
+
+    /**
+     * @brief Transformation matrix
+     *
+     * Default value is an identity matrix.
+     * @see @ref Phong::setTransformationMatrix()
+     */
+    Matrix4 transformationMatrix;
+};
+
+/**
+@brief Texture transformation uniform common for all shaders
+@m_since_latest
+
+Contents of the texture transformation uniform buffer for shaders created with
+@ref Flat::Flag::UniformBuffers or @ref Phong::Flag::UniformBuffers together
+with @m_class{m-doc} [Flat::Flag::TextureTransformation](@ref Flat::Flag::TextureTransformation)
+or @ref Phong::Flag::TextureTransformation, one item per draw. Instead of a
+full @ref Matrix3, the transformation is stored as a 2x2 rotation and scaling
+part and an offset.
+@see @ref Flat::bindTextureTransformationBuffer(),
+    @ref Phong::bindTextureTransformationBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct TextureTransformationUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit TextureTransformationUniform() noexcept: rotationScaling{1.0f, 0.0f, 0.0f, 1.0f}, offset{0.0f, 0.0f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit TextureTransformationUniform(NoInitT) noexcept: rotationScaling{NoInit}, offset{NoInit} {}
+
+    /**
+     * @brief Set the @ref rotationScaling and @ref offset fields
+     * @return Reference to self (for method chaining)
+     *
+     * The @ref rotationScaling field is set to the two upper left columns of
+     * @p matrix and @ref offset to the translation part.
+     */
+    TextureTransformationUniform& setTextureMatrix(const Matrix3& matrix) {
+        rotationScaling = {matrix[0][0], matrix[0][1], matrix[1][0], matrix[1][1]};
+        offset = matrix.translation();
+        return *this;
+    }
+
+    /**
+     * @brief Rotation and scaling part of the texture matrix
+     *
+     * The two columns of the upper left 2x2 part of the matrix, packed into
+     * a single vector. Default value is
+     * @cpp {1.0f, 0.0f, 0.0f, 1.0f} @ce, i.e. an identity.
+     * @see @ref Flat::setTextureMatrix(), @ref Phong::setTextureMatrix()
+     */
+    Vector4 rotationScaling;
+
+    /**
+     * @brief Offset part of the texture matrix
+     *
+     * Default value is a zero vector.
+     */
+    Vector2 offset;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    #endif
+};
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 struct BaseGeneric {
     enum: UnsignedInt {
@@ -450,6 +752,8 @@ struct BaseGeneric {
     typedef GL::Attribute<2, Magnum::Color4> Color4;
     #ifndef MAGNUM_TARGET_GLES2
     typedef GL::Attribute<4, UnsignedInt> ObjectId;
+    typedef GL::Attribute<6, Vector4> Weights;
+    typedef GL::Attribute<7, Vector4ui> JointIds;
     #endif
 
     typedef GL::Attribute<15, Vector2> TextureOffset;
@@ -458,6 +762,7 @@ struct BaseGeneric {
 template<> struct Generic<2>: BaseGeneric {
     typedef GL::Attribute<0, Vector2> Position;
     /* 1, 2 used by TextureCoordinates and Color */
+    /* 6, 7 used by Weights and JointIds */
 
     typedef GL::Attribute<8, Matrix3> TransformationMatrix;
     /* 9, 10 occupied by TransformationMatrix */
@@ -471,7 +776,7 @@ template<> struct Generic<3>: BaseGeneric {
     typedef GL::Attribute<3, Vector4> Tangent4;
     typedef GL::Attribute<4, Vector3> Bitangent; /* also ObjectId */
     typedef GL::Attribute<5, Vector3> Normal;
-    /* 6, 7 reserved for vertex weights / bone IDs */
+    /* 6, 7 used by Weights and JointIds */
 
     typedef GL::Attribute<8, Matrix4> TransformationMatrix;
     /* 9, 10, 11 occupied by TransformationMatrix */
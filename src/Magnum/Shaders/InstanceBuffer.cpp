@@ -0,0 +1,201 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "InstanceBuffer.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Generic.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+
+/* Attributes are interleaved in the order of the enum values */
+template<UnsignedInt dimensions> std::size_t attributeSize(const Implementation::InstanceBufferAttribute attribute) {
+    switch(attribute) {
+        case Implementation::InstanceBufferAttribute::TransformationMatrix:
+            return sizeof(MatrixTypeFor<dimensions, Float>);
+        case Implementation::InstanceBufferAttribute::NormalMatrix:
+            return sizeof(Matrix3x3);
+        case Implementation::InstanceBufferAttribute::Color:
+            return sizeof(Color4);
+        case Implementation::InstanceBufferAttribute::TextureOffset:
+            return sizeof(Vector2);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+constexpr Implementation::InstanceBufferAttribute AttributeOrder[]{
+    Implementation::InstanceBufferAttribute::TransformationMatrix,
+    Implementation::InstanceBufferAttribute::NormalMatrix,
+    Implementation::InstanceBufferAttribute::Color,
+    Implementation::InstanceBufferAttribute::TextureOffset
+};
+
+template<UnsignedInt dimensions> std::size_t attributeOffset(const Implementation::InstanceBufferAttributes attributes, const Implementation::InstanceBufferAttribute attribute) {
+    std::size_t offset = 0;
+    for(const Implementation::InstanceBufferAttribute i: AttributeOrder) {
+        if(i == attribute) break;
+        if(attributes & i) offset += attributeSize<dimensions>(i);
+    }
+    return offset;
+}
+
+template<UnsignedInt dimensions> UnsignedInt attributeStride(const Implementation::InstanceBufferAttributes attributes) {
+    std::size_t stride = 0;
+    for(const Implementation::InstanceBufferAttribute i: AttributeOrder)
+        if(attributes & i) stride += attributeSize<dimensions>(i);
+    return stride;
+}
+
+}
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>::InstanceBuffer(const Attributes attributes, const UnsignedInt capacity, const UnsignedInt frameCount): _ringBuffer{NoCreate}, _attributes{attributes}, _stride{attributeStride<dimensions>(attributes)}, _capacity{capacity} {
+    CORRADE_ASSERT(attributes,
+        "Shaders::InstanceBuffer: expected at least one attribute", );
+    CORRADE_ASSERT(dimensions == 3 || !(attributes & Attribute::NormalMatrix),
+        "Shaders::InstanceBuffer: normal matrix is available only in 3D", );
+    CORRADE_ASSERT(capacity && frameCount,
+        "Shaders::InstanceBuffer: expected non-zero capacity and frame count but got" << capacity << "and" << frameCount, );
+
+    /* See begin() for why there's the extra space for each frame */
+    _ringBuffer = GL::RingBuffer{frameCount*(std::size_t(capacity)*_stride + _stride - 4), GL::Buffer::TargetHint::Array};
+}
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>::InstanceBuffer(NoCreateT) noexcept: _ringBuffer{NoCreate} {}
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>::InstanceBuffer(InstanceBuffer<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>& InstanceBuffer<dimensions>::operator=(InstanceBuffer<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>& InstanceBuffer<dimensions>::addToMesh(GL::Mesh& mesh) {
+    GL::Buffer& buffer = _ringBuffer.buffer();
+    if(_attributes & Attribute::TransformationMatrix)
+        mesh.addVertexBufferInstanced(buffer, 1, attributeOffset<dimensions>(_attributes, Attribute::TransformationMatrix), _stride, typename Generic<dimensions>::TransformationMatrix{});
+    if(_attributes & Attribute::NormalMatrix)
+        mesh.addVertexBufferInstanced(buffer, 1, attributeOffset<dimensions>(_attributes, Attribute::NormalMatrix), _stride, Generic3D::NormalMatrix{});
+    if(_attributes & Attribute::Color)
+        mesh.addVertexBufferInstanced(buffer, 1, attributeOffset<dimensions>(_attributes, Attribute::Color), _stride, typename Generic<dimensions>::Color4{});
+    if(_attributes & Attribute::TextureOffset)
+        mesh.addVertexBufferInstanced(buffer, 1, attributeOffset<dimensions>(_attributes, Attribute::TextureOffset), _stride, typename Generic<dimensions>::TextureOffset{});
+    return *this;
+}
+
+template<UnsignedInt dimensions> InstanceBuffer<dimensions>& InstanceBuffer<dimensions>::begin(GL::Mesh& mesh, const UnsignedInt count) {
+    CORRADE_ASSERT(!_inFrame,
+        "Shaders::InstanceBuffer::begin(): end() wasn't called for the previous frame", *this);
+    CORRADE_ASSERT(count <= _capacity,
+        "Shaders::InstanceBuffer::begin(): expected at most" << _capacity << "instances but got" << count, *this);
+
+    /* The attributes are added to the mesh with a zero offset and the data
+       are selected with a base instance, so the allocation has to start at a
+       multiple of the stride. All attribute sizes are multiples of four, thus
+       the padding is at most stride - 4 bytes. */
+    const std::size_t size = std::size_t(count)*_stride;
+    const GL::RingBuffer::Allocation allocation = _ringBuffer.allocate(size + _stride - 4, 4);
+    const std::size_t padding = (_stride - allocation.offset % _stride) % _stride;
+    _data = allocation.data.slice(padding, padding + size);
+    _instanceCount = count;
+    _inFrame = true;
+
+    mesh.setInstanceCount(count)
+        .setBaseInstance((allocation.offset + padding)/_stride);
+    return *this;
+}
+
+template<UnsignedInt dimensions> template<class T> Containers::StridedArrayView1D<T> InstanceBuffer<dimensions>::attribute(const Attribute attribute, const char* const name) {
+    CORRADE_ASSERT(_attributes & attribute,
+        "Shaders::InstanceBuffer::" << Debug::nospace << name << Debug::nospace << "(): the buffer was not created with" << attribute, {});
+    CORRADE_ASSERT(_inFrame,
+        "Shaders::InstanceBuffer::" << Debug::nospace << name << Debug::nospace << "(): can be called only between begin() and end()", {});
+    #ifdef CORRADE_NO_ASSERT
+    static_cast<void>(name);
+    #endif
+    return {_data, reinterpret_cast<T*>(_data.data() + attributeOffset<dimensions>(_attributes, attribute)), _instanceCount, std::ptrdiff_t(_stride)};
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>> InstanceBuffer<dimensions>::transformationMatrices() {
+    return attribute<MatrixTypeFor<dimensions, Float>>(Attribute::TransformationMatrix, "transformationMatrices");
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<Matrix3x3> InstanceBuffer<dimensions>::normalMatrices() {
+    return attribute<Matrix3x3>(Attribute::NormalMatrix, "normalMatrices");
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<Color4> InstanceBuffer<dimensions>::colors() {
+    return attribute<Color4>(Attribute::Color, "colors");
+}
+
+template<UnsignedInt dimensions> Containers::StridedArrayView1D<Vector2> InstanceBuffer<dimensions>::textureOffsets() {
+    return attribute<Vector2>(Attribute::TextureOffset, "textureOffsets");
+}
+
+template<UnsignedInt dimensions> void InstanceBuffer<dimensions>::end() {
+    CORRADE_ASSERT(_inFrame,
+        "Shaders::InstanceBuffer::end(): no matching begin() call", );
+    _ringBuffer.fence();
+    _data = nullptr;
+    _inFrame = false;
+}
+
+template class InstanceBuffer<2>;
+template class InstanceBuffer<3>;
+
+namespace Implementation {
+
+Debug& operator<<(Debug& debug, const InstanceBufferAttribute value) {
+    debug << "Shaders::InstanceBuffer::Attribute" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case InstanceBufferAttribute::v: return debug << "::" #v;
+        _c(TransformationMatrix)
+        _c(NormalMatrix)
+        _c(Color)
+        _c(TextureOffset)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const InstanceBufferAttributes value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::InstanceBuffer::Attributes{}", {
+        InstanceBufferAttribute::TransformationMatrix,
+        InstanceBufferAttribute::NormalMatrix,
+        InstanceBufferAttribute::Color,
+        InstanceBufferAttribute::TextureOffset});
+}
+
+}
+
+}}
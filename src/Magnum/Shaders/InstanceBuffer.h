@@ -0,0 +1,316 @@
+#ifndef Magnum_Shaders_InstanceBuffer_h
+#define Magnum_Shaders_InstanceBuffer_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::InstanceBuffer, typedef @ref Magnum::Shaders::InstanceBuffer2D, @ref Magnum::Shaders::InstanceBuffer3D
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/DimensionTraits.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/GL/RingBuffer.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace Implementation {
+    enum class InstanceBufferAttribute: UnsignedByte {
+        TransformationMatrix = 1 << 0,
+        NormalMatrix = 1 << 1,
+        Color = 1 << 2,
+        TextureOffset = 1 << 3
+    };
+    typedef Containers::EnumSet<InstanceBufferAttribute> InstanceBufferAttributes;
+}
+
+/**
+@brief Streaming per-instance data for instanced shaders
+@m_since_latest
+
+Packs per-instance transformation matrices, normal matrices, colors and
+texture offsets into a single interleaved buffer with a layout matching the
+@ref Flat::TransformationMatrix, @ref Phong::TransformationMatrix,
+@ref Phong::NormalMatrix, @ref Flat::Color4 / @ref Phong::Color4 and
+@ref Flat::TextureOffset / @ref Phong::TextureOffset attributes. The data are
+streamed through a persistently mapped @ref GL::RingBuffer, so filling
+instance data every frame is just a direct write to memory visible to the GPU
+without any driver-side copies or synchronization stalls:
+
+@snippet MagnumShaders.cpp InstanceBuffer-usage
+
+The mesh is set up with @ref addToMesh() only once. Each @ref begin() then
+allocates space for given count of instances and points the mesh to it by
+updating its @ref GL::Mesh::setInstanceCount() "instance count" and
+@ref GL::Mesh::setBaseInstance() "base instance", leaving the vertex layout
+untouched. After all draws consuming the data are issued, @ref end() guards
+them against being overwritten while the GPU is still using them. The
+underlying buffer is sized for @p frameCount frames of @p capacity instances
+each, see @ref GL::RingBuffer for details about when the allocation has to
+wait.
+
+Attributes are written through the strided views returned from
+@ref transformationMatrices(), @ref normalMatrices(), @ref colors() and
+@ref textureOffsets(), which are valid only between @ref begin() and
+@ref end(). The shader has to be created with
+@ref Phong::Flag::InstancedTransformation,
+@ref Phong::Flag::VertexColor or @ref Phong::Flag::InstancedTextureOffset
+(or the equivalent @ref Flat::Flag values) for given attribute to be used.
+Note that the color attribute overrides a per-vertex color attribute of the
+mesh, if there's any.
+
+@requires_gl42 Extension @gl_extension{ARB,base_instance}
+@requires_gl44 Extension @gl_extension{ARB,buffer_storage}
+@requires_gl Buffer storage and base instance are not available in OpenGL ES
+    and WebGL.
+*/
+template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT InstanceBuffer {
+    public:
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Attribute
+         *
+         * @see @ref Attributes, @ref InstanceBuffer()
+         */
+        enum class Attribute: UnsignedByte {
+            /**
+             * Transformation matrix, matching
+             * @ref Flat::TransformationMatrix and
+             * @ref Phong::TransformationMatrix
+             */
+            TransformationMatrix = 1 << 0,
+
+            /**
+             * Normal matrix, matching @ref Phong::NormalMatrix. Available only
+             * in 3D.
+             */
+            NormalMatrix = 1 << 1,
+
+            /**
+             * Color, matching @ref Flat::Color4 and @ref Phong::Color4
+             */
+            Color = 1 << 2,
+
+            /**
+             * Texture offset, matching @ref Flat::TextureOffset and
+             * @ref Phong::TextureOffset
+             */
+            TextureOffset = 1 << 3
+        };
+
+        /**
+         * @brief Attributes
+         *
+         * @see @ref InstanceBuffer()
+         */
+        typedef Containers::EnumSet<Attribute> Attributes;
+        #else
+        typedef Implementation::InstanceBufferAttribute Attribute;
+        typedef Implementation::InstanceBufferAttributes Attributes;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param attributes    Per-instance attributes
+         * @param capacity      Max count of instances in a frame
+         * @param frameCount    Count of frames the buffer can hold
+         *
+         * Creates a @ref GL::RingBuffer large enough to hold @p frameCount
+         * frames of @p capacity instances each. Expects that @p attributes,
+         * @p capacity and @p frameCount are all non-zero and that
+         * @ref Attribute::NormalMatrix is used only in 3D.
+         */
+        explicit InstanceBuffer(Attributes attributes, UnsignedInt capacity, UnsignedInt frameCount = 3);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit InstanceBuffer(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        InstanceBuffer(const InstanceBuffer<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        InstanceBuffer(InstanceBuffer<dimensions>&&) noexcept;
+
+        /** @brief Copying is not allowed */
+        InstanceBuffer<dimensions>& operator=(const InstanceBuffer<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        InstanceBuffer<dimensions>& operator=(InstanceBuffer<dimensions>&&) noexcept;
+
+        /** @brief Per-instance attributes */
+        Attributes attributes() const { return _attributes; }
+
+        /** @brief Size of data for one instance in bytes */
+        UnsignedInt stride() const { return _stride; }
+
+        /** @brief Max count of instances in a frame */
+        UnsignedInt capacity() const { return _capacity; }
+
+        /** @brief Underlying ring buffer */
+        GL::RingBuffer& ringBuffer() { return _ringBuffer; }
+
+        /**
+         * @brief Instance count
+         *
+         * Count of instances passed to the last @ref begin() call.
+         */
+        UnsignedInt instanceCount() const { return _instanceCount; }
+
+        /**
+         * @brief Add instanced attributes to a mesh
+         * @return Reference to self (for method chaining)
+         *
+         * Adds all @ref attributes() sourced from @ref ringBuffer() to
+         * @p mesh with a divisor of @cpp 1 @ce. Needs to be done just once
+         * for each mesh, the per-frame data are then selected with
+         * @ref begin().
+         * @see @ref GL::Mesh::addVertexBufferInstanced()
+         */
+        InstanceBuffer<dimensions>& addToMesh(GL::Mesh& mesh);
+
+        /**
+         * @brief Begin a frame
+         * @return Reference to self (for method chaining)
+         *
+         * Allocates space for @p count instances in @ref ringBuffer() and
+         * sets @p mesh instance count and base instance to point to it. If
+         * the memory is still used by the GPU, waits until it's available.
+         * Expects that @p count is not larger than @ref capacity() and that
+         * @ref end() was called after a previous @ref begin().
+         * @see @ref GL::RingBuffer::allocate()
+         */
+        InstanceBuffer<dimensions>& begin(GL::Mesh& mesh, UnsignedInt count);
+
+        /**
+         * @brief Transformation matrices
+         *
+         * Expects that the buffer was created with
+         * @ref Attribute::TransformationMatrix and that it's called between
+         * @ref begin() and @ref end(). The view has @ref instanceCount()
+         * items.
+         */
+        Containers::StridedArrayView1D<MatrixTypeFor<dimensions, Float>> transformationMatrices();
+
+        /**
+         * @brief Normal matrices
+         *
+         * Expects that the buffer was created with
+         * @ref Attribute::NormalMatrix and that it's called between
+         * @ref begin() and @ref end(). The view has @ref instanceCount()
+         * items.
+         * @see @ref Matrix4::normalMatrix()
+         */
+        Containers::StridedArrayView1D<Matrix3x3> normalMatrices();
+
+        /**
+         * @brief Colors
+         *
+         * Expects that the buffer was created with @ref Attribute::Color
+         * and that it's called between @ref begin() and @ref end(). The view
+         * has @ref instanceCount() items.
+         */
+        Containers::StridedArrayView1D<Color4> colors();
+
+        /**
+         * @brief Texture offsets
+         *
+         * Expects that the buffer was created with
+         * @ref Attribute::TextureOffset and that it's called between
+         * @ref begin() and @ref end(). The view has @ref instanceCount()
+         * items.
+         */
+        Containers::StridedArrayView1D<Vector2> textureOffsets();
+
+        /**
+         * @brief End a frame
+         *
+         * Call after all draws consuming the data written since
+         * @ref begin() were issued. Guards the data against being
+         * overwritten until the GPU finishes the draws.
+         * @see @ref GL::RingBuffer::fence()
+         */
+        void end();
+
+    private:
+        template<class T> MAGNUM_SHADERS_LOCAL Containers::StridedArrayView1D<T> attribute(Attribute attribute, const char* name);
+
+        GL::RingBuffer _ringBuffer;
+        Attributes _attributes;
+        UnsignedInt _stride{}, _capacity{}, _instanceCount{};
+        bool _inFrame{};
+        Containers::ArrayView<char> _data;
+};
+
+/**
+@brief 2D instance buffer
+@m_since_latest
+*/
+typedef InstanceBuffer<2> InstanceBuffer2D;
+
+/**
+@brief 3D instance buffer
+@m_since_latest
+*/
+typedef InstanceBuffer<3> InstanceBuffer3D;
+
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/**
+ * @debugoperatorclassenum{InstanceBuffer,InstanceBuffer::Attribute}
+ * @m_since_latest
+ */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, InstanceBuffer<dimensions>::Attribute value);
+
+/**
+ * @debugoperatorclassenum{InstanceBuffer,InstanceBuffer::Attributes}
+ * @m_since_latest
+ */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, InstanceBuffer<dimensions>::Attributes value);
+#else
+namespace Implementation {
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, InstanceBufferAttribute value);
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, InstanceBufferAttributes value);
+    CORRADE_ENUMSET_OPERATORS(InstanceBufferAttributes)
+}
+#endif
+
+}}
+#else
+#error this header is not available in OpenGL ES build
+#endif
+
+#endif
@@ -0,0 +1,230 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LightClusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/Phong.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    /* Keeping the light index texture narrow enough to be within the minimal
+       guaranteed texture size on all platforms */
+    constexpr Int LightIndexTextureWidth = 1024;
+
+    /* Calculates the tile range along one axis overlapped by a sphere of
+       given radius, occupying given depth interval. The view-space extent of
+       a tile grows linearly with depth, so it's enough to check the depth
+       interval endpoints. */
+    Math::Vector2<Int> tileRange(const Float scale, const Float shift, const Int count, const Float center, const Float radius, const Float depthMin, const Float depthMax) {
+        Int first = count, end = 0;
+        for(Int i = 0; i != count; ++i) {
+            const Float a = (-1.0f + 2.0f*Float(i)/Float(count) + shift)/scale;
+            const Float b = (-1.0f + 2.0f*Float(i + 1)/Float(count) + shift)/scale;
+            const Float tileMin = std::min({a*depthMin, a*depthMax, b*depthMin, b*depthMax});
+            const Float tileMax = std::max({a*depthMin, a*depthMax, b*depthMin, b*depthMax});
+            if(tileMin > center + radius || tileMax < center - radius) continue;
+
+            first = Math::min(first, i);
+            end = i + 1;
+        }
+
+        return {first, end};
+    }
+}
+
+struct LightClusters::State {
+    explicit State(const Vector3i& gridSize, const UnsignedInt lightIndexCapacity): gridSize{gridSize}, lightIndexCapacity{lightIndexCapacity}, clusters{std::size_t(gridSize.product())}, lightIndices{lightIndexCapacity}, cursors{std::size_t(gridSize.product())} {}
+
+    Vector3i gridSize;
+    UnsignedInt lightIndexCapacity;
+    UnsignedInt lightIndexCount{};
+    UnsignedInt droppedLightIndexCount{};
+    Range1D depthRange;
+
+    Containers::Array<Vector2ui> clusters;
+    Containers::Array<UnsignedInt> lightIndices;
+    Containers::Array<UnsignedInt> cursors;
+    /* Cluster range for each light, reused between updates */
+    Containers::Array<Range3Di> lightRanges;
+
+    GL::Texture3D clusterTexture;
+    GL::Texture2D lightIndexTexture;
+};
+
+LightClusters::LightClusters(const Vector3i& gridSize, UnsignedInt lightIndexCapacity) {
+    CORRADE_ASSERT(gridSize.min() > 0,
+        "Shaders::LightClusters: expected a positive grid size, got" << Debug::packed << gridSize, );
+    CORRADE_ASSERT(lightIndexCapacity,
+        "Shaders::LightClusters: light index capacity can't be zero", );
+
+    lightIndexCapacity = (lightIndexCapacity + LightIndexTextureWidth - 1)/LightIndexTextureWidth*LightIndexTextureWidth;
+    _state = Containers::pointer<State>(gridSize, lightIndexCapacity);
+
+    /* Integer textures can't be filtered */
+    _state->clusterTexture
+        .setMinificationFilter(SamplerFilter::Nearest)
+        .setMagnificationFilter(SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::RG32UI, gridSize);
+    _state->lightIndexTexture
+        .setMinificationFilter(SamplerFilter::Nearest)
+        .setMagnificationFilter(SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::R32UI, {LightIndexTextureWidth, Int(lightIndexCapacity/LightIndexTextureWidth)});
+}
+
+LightClusters::LightClusters(NoCreateT) noexcept {}
+
+LightClusters::LightClusters(LightClusters&&) noexcept = default;
+
+LightClusters::~LightClusters() = default;
+
+LightClusters& LightClusters::operator=(LightClusters&&) noexcept = default;
+
+Vector3i LightClusters::gridSize() const { return _state->gridSize; }
+
+UnsignedInt LightClusters::lightIndexCapacity() const { return _state->lightIndexCapacity; }
+
+UnsignedInt LightClusters::lightIndexCount() const { return _state->lightIndexCount; }
+
+UnsignedInt LightClusters::droppedLightIndexCount() const { return _state->droppedLightIndexCount; }
+
+Range1D LightClusters::depthRange() const { return _state->depthRange; }
+
+Containers::ArrayView<const Vector2ui> LightClusters::clusters() const {
+    return _state->clusters;
+}
+
+Containers::ArrayView<const UnsignedInt> LightClusters::lightIndices() const {
+    return _state->lightIndices.prefix(_state->lightIndexCount);
+}
+
+GL::Texture3D& LightClusters::clusterTexture() { return _state->clusterTexture; }
+
+GL::Texture2D& LightClusters::lightIndexTexture() { return _state->lightIndexTexture; }
+
+LightClusters& LightClusters::update(const Matrix4& projection, const Containers::ArrayView<const PhongLightUniform> lights) {
+    CORRADE_ASSERT(projection[2][3] == -1.0f && projection[3][3] == 0.0f,
+        "Shaders::LightClusters::update(): expected a perspective projection", *this);
+    CORRADE_ASSERT(projection[2][2] != -1.0f,
+        "Shaders::LightClusters::update(): expected a finite far plane", *this);
+
+    State& state = *_state;
+    const Vector3i& gridSize = state.gridSize;
+
+    /* Extract the near and far plane, depth slices are then distributed
+       exponentially between these two */
+    const Float near = projection[3][2]/(projection[2][2] - 1.0f);
+    const Float far = projection[3][2]/(projection[2][2] + 1.0f);
+    state.depthRange = {near, far};
+    const Float sliceScale = Float(gridSize.z())/std::log(far/near);
+
+    /* Calculate the cluster range for each light */
+    if(state.lightRanges.size() < lights.size())
+        state.lightRanges = Containers::Array<Range3Di>{lights.size()};
+    for(std::size_t i = 0; i != lights.size(); ++i) {
+        const Vector4& position = lights[i].position;
+        const Float range = lights[i].range;
+
+        /* Directional lights and lights with an infinite range affect
+           everything */
+        if(position.w() == 0.0f || range == Constants::inf()) {
+            state.lightRanges[i] = {{}, gridSize};
+            continue;
+        }
+
+        /* Skip lights that are completely in front of the near or behind the
+           far plane */
+        const Float depth = -position.z();
+        const Float depthMin = Math::max(depth - range, near);
+        const Float depthMax = Math::min(depth + range, far);
+        if(depthMin > depthMax) {
+            state.lightRanges[i] = {};
+            continue;
+        }
+
+        const Math::Vector2<Int> x = tileRange(projection[0][0], projection[2][0], gridSize.x(), position.x(), range, depthMin, depthMax);
+        const Math::Vector2<Int> y = tileRange(projection[1][1], projection[2][1], gridSize.y(), position.y(), range, depthMin, depthMax);
+        const Int sliceMin = Math::clamp(Int(std::log(depthMin/near)*sliceScale), 0, gridSize.z() - 1);
+        const Int sliceMax = Math::clamp(Int(std::log(depthMax/near)*sliceScale), 0, gridSize.z() - 1);
+        /* If a light is outside of the frustum sides, the range is empty */
+        state.lightRanges[i] = {{x[0], y[0], sliceMin},
+                                {Math::max(x[0], x[1]), Math::max(y[0], y[1]), sliceMax + 1}};
+    }
+
+    /* Count lights in each cluster */
+    for(Vector2ui& cluster: state.clusters) cluster = {};
+    for(std::size_t i = 0; i != lights.size(); ++i) {
+        const Range3Di& range = state.lightRanges[i];
+        for(Int z = range.min().z(); z < range.max().z(); ++z)
+            for(Int y = range.min().y(); y < range.max().y(); ++y)
+                for(Int x = range.min().x(); x < range.max().x(); ++x)
+                    ++state.clusters[(z*gridSize.y() + y)*gridSize.x() + x].y();
+    }
+
+    /* Convert the counts to offsets, truncating what doesn't fit */
+    UnsignedInt offset = 0;
+    state.droppedLightIndexCount = 0;
+    for(Vector2ui& cluster: state.clusters) {
+        const UnsignedInt count = Math::min(cluster.y(), state.lightIndexCapacity - offset);
+        state.droppedLightIndexCount += cluster.y() - count;
+        cluster = {offset, count};
+        offset += count;
+    }
+    state.lightIndexCount = offset;
+
+    /* Fill the lists. Iterating over lights in the outer loop, so each list
+       is sorted by light index. */
+    std::fill(state.cursors.begin(), state.cursors.end(), 0);
+    for(std::size_t i = 0; i != lights.size(); ++i) {
+        const Range3Di& range = state.lightRanges[i];
+        for(Int z = range.min().z(); z < range.max().z(); ++z)
+            for(Int y = range.min().y(); y < range.max().y(); ++y)
+                for(Int x = range.min().x(); x < range.max().x(); ++x) {
+                    const std::size_t id = (z*gridSize.y() + y)*gridSize.x() + x;
+                    const Vector2ui& cluster = state.clusters[id];
+                    if(state.cursors[id] < cluster.y())
+                        state.lightIndices[cluster.x() + state.cursors[id]++] = UnsignedInt(i);
+                }
+    }
+
+    /* Upload. Only the rows containing some indices are updated. */
+    state.clusterTexture.setSubImage(0, {}, ImageView3D{PixelFormat::RG32UI, gridSize, Containers::arrayView(state.clusters)});
+    if(const Int rows = (state.lightIndexCount + LightIndexTextureWidth - 1)/LightIndexTextureWidth)
+        state.lightIndexTexture.setSubImage(0, {}, ImageView2D{PixelFormat::R32UI, {LightIndexTextureWidth, rows}, state.lightIndices.prefix(rows*LightIndexTextureWidth)});
+
+    return *this;
+}
+
+}}
@@ -0,0 +1,209 @@
+#ifndef Magnum_Shaders_LightClusters_h
+#define Magnum_Shaders_LightClusters_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::LightClusters
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/GL.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+struct PhongLightUniform;
+
+/**
+@brief Per-cluster light lists for clustered shading
+@m_since_latest
+
+Divides the view frustum into a grid of clusters --- tiles in screen space,
+exponentially distributed slices in depth --- and for each cluster builds a
+list of lights that affect it. With @ref Phong::Flag::ClusteredLights the
+shader then looks up the cluster a fragment is in and iterates only over lights
+in that cluster instead of all lights in the scene, which makes the cost per
+fragment depend on the local light density instead of the total light count.
+
+The lists are built on the CPU in @ref update() from the same
+@ref PhongLightUniform array that's uploaded to the light buffer. Each light is
+binned into all clusters its bounding sphere overlaps, which is done
+separately for each axis and is thus linear in the number of lights and
+clusters they cover. Directional lights and lights with an infinite range are
+added to all clusters. The result is uploaded into two textures:
+
+-   @ref clusterTexture() is a @ref GL::TextureFormat::RG32UI 3D texture of
+    @ref gridSize(), containing offset and count of light indices for each
+    cluster
+-   @ref lightIndexTexture() is a @ref GL::TextureFormat::R32UI 2D texture
+    containing the light indices, with cluster lists placed next to each other
+    in a row-major order
+
+@snippet MagnumShaders.cpp LightClusters-usage
+
+The light positions are expected to be in view space, same as for the
+@ref Phong shader itself. The @p projection passed to @ref update() is
+expected to be a perspective projection with a finite far plane, as the depth
+slices are distributed between the near and far plane.
+
+If the total count of light indices exceeds @ref lightIndexCapacity(), the
+lists are truncated and the remaining lights are ignored by the shader. The
+count of dropped indices is available in @ref droppedLightIndexCount(), use it
+to tune the capacity passed to the constructor.
+
+@requires_gl30 Extension @gl_extension{EXT,texture_integer}
+@requires_gles30 Integer textures are not available in OpenGL ES 2.0.
+@requires_webgl20 Integer textures are not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT LightClusters {
+    public:
+        /**
+         * @brief Constructor
+         * @param gridSize              Count of clusters in X, Y and depth
+         * @param lightIndexCapacity    Max count of light indices in all
+         *      clusters together
+         *
+         * The @p lightIndexCapacity is rounded up to a multiple of the light
+         * index texture width. All components of @p gridSize are expected to
+         * be positive and @p lightIndexCapacity non-zero.
+         */
+        explicit LightClusters(const Vector3i& gridSize = {16, 9, 24}, UnsignedInt lightIndexCapacity = 1 << 18);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit LightClusters(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        LightClusters(const LightClusters&) = delete;
+
+        /** @brief Move constructor */
+        LightClusters(LightClusters&&) noexcept;
+
+        ~LightClusters();
+
+        /** @brief Copying is not allowed */
+        LightClusters& operator=(const LightClusters&) = delete;
+
+        /** @brief Move assignment */
+        LightClusters& operator=(LightClusters&&) noexcept;
+
+        /** @brief Count of clusters in X, Y and depth */
+        Vector3i gridSize() const;
+
+        /** @brief Max count of light indices in all clusters together */
+        UnsignedInt lightIndexCapacity() const;
+
+        /**
+         * @brief Count of light indices in all clusters together
+         *
+         * Calculated in the last @ref update(), at most
+         * @ref lightIndexCapacity().
+         */
+        UnsignedInt lightIndexCount() const;
+
+        /**
+         * @brief Count of light indices that didn't fit
+         *
+         * Calculated in the last @ref update(). If non-zero, some clusters
+         * are missing lights that affect them.
+         */
+        UnsignedInt droppedLightIndexCount() const;
+
+        /**
+         * @brief Depth range the clusters are distributed in
+         *
+         * Near and far plane extracted from the projection matrix in the last
+         * @ref update(). Pass it to @ref Phong::setLightClusterDepthRange().
+         */
+        Range1D depthRange() const;
+
+        /**
+         * @brief Cluster data
+         *
+         * Offset into @ref lightIndices() and count of lights for each
+         * cluster, ordered by X, then Y and then depth. Same as the contents
+         * of @ref clusterTexture().
+         */
+        Containers::ArrayView<const Vector2ui> clusters() const;
+
+        /**
+         * @brief Light indices
+         *
+         * Indices into the light array passed to @ref update(), of
+         * @ref lightIndexCount() size. Same as the contents of
+         * @ref lightIndexTexture().
+         */
+        Containers::ArrayView<const UnsignedInt> lightIndices() const;
+
+        /**
+         * @brief Cluster texture
+         *
+         * Pass to @ref Phong::bindLightClusterTexture().
+         */
+        GL::Texture3D& clusterTexture();
+
+        /**
+         * @brief Light index texture
+         *
+         * Pass to @ref Phong::bindLightClusterIndexTexture().
+         */
+        GL::Texture2D& lightIndexTexture();
+
+        /**
+         * @brief Build per-cluster light lists
+         * @param projection    Perspective projection matrix
+         * @param lights        Lights in view space
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p projection is a perspective projection with a
+         * finite far plane. The light indices in the resulting lists
+         * correspond to positions in @p lights.
+         */
+        LightClusters& update(const Matrix4& projection, Containers::ArrayView<const PhongLightUniform> lights);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -37,6 +37,12 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/BufferTexture.h"
+#endif
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #include "Magnum/GL/Texture.h"
 
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
@@ -46,7 +52,11 @@ namespace Magnum { namespace Shaders {
 namespace {
     enum: Int {
         /* First four taken by Phong (A/D/S/N) */
-        ColorMapTextureUnit = 4
+        ColorMapTextureUnit = 4,
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        IndexTextureUnit = 5,
+        PositionTextureUnit = 6
+        #endif
     };
 }
 
@@ -63,6 +73,10 @@ MeshVisualizerBase::MeshVisualizerBase(FlagsBase flags): _flags{flags} {
     CORRADE_ASSERT(countMutuallyExclusive <= 1,
         "Shaders::MeshVisualizer: Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive", );
     #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    CORRADE_ASSERT(!(flags & FlagBase::VertexPulling && flags & FlagBase::InstancedObjectId),
+        "Shaders::MeshVisualizer: Flag::VertexPulling and Flag::InstancedObjectId are mutually exclusive", );
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES2
     if(_flags & FlagBase::Wireframe && !(_flags & FlagBase::NoGeometryShader)) {
@@ -88,6 +102,17 @@ MeshVisualizerBase::MeshVisualizerBase(FlagsBase flags): _flags{flags} {
     }
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(_flags & FlagBase::VertexPulling) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL310);
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::texture_buffer_object);
+        #else
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::texture_buffer);
+        #endif
+    }
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -96,12 +121,21 @@ MeshVisualizerBase::MeshVisualizerBase(FlagsBase flags): _flags{flags} {
 }
 
 GL::Version MeshVisualizerBase::setupShaders(GL::Shader& vert, GL::Shader& frag, const Utility::Resource& rs) const {
+    /* If the driver can give us barycentric coordinates directly, there's no
+       need to derive them from gl_VertexID, which means the mesh doesn't need
+       to be deindexed */
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    const bool fragmentBarycentric = _flags & FlagBase::Wireframe && _flags & FlagBase::NoGeometryShader && GL::Context::current().isExtensionSupported<GL::Extensions::NV::fragment_shader_barycentric>();
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
-    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    const GL::Version version = fragmentBarycentric ? GL::Version::GL450 :
+        GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
     /* Extended in MeshVisualizer3D for TBN visualization */
     CORRADE_INTERNAL_ASSERT(!(_flags & FlagBase::Wireframe) || _flags & FlagBase::NoGeometryShader || version >= GL::Version::GL320);
     #elif !defined(MAGNUM_TARGET_WEBGL)
-    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GLES310, GL::Version::GLES300, GL::Version::GLES200});
+    const GL::Version version = fragmentBarycentric ? GL::Version::GLES320 :
+        GL::Context::current().supportedVersion({GL::Version::GLES310, GL::Version::GLES300, GL::Version::GLES200});
     /* Extended in MeshVisualizer3D for TBN visualization */
     CORRADE_INTERNAL_ASSERT(!(_flags & FlagBase::Wireframe) || _flags & FlagBase::NoGeometryShader || version >= GL::Version::GLES310);
     #else
@@ -117,6 +151,10 @@ GL::Version MeshVisualizerBase::setupShaders(GL::Shader& vert, GL::Shader& frag,
         .addSource(_flags & FlagBase::VertexId ? "#define VERTEX_ID\n" : "")
         .addSource(_flags >= FlagBase::PrimitiveIdFromVertexId ? "#define PRIMITIVE_ID_FROM_VERTEX_ID\n" : "")
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(fragmentBarycentric ? "#define FRAGMENT_BARYCENTRIC\n" : "")
+        .addSource(_flags & FlagBase::VertexPulling ? "#define VERTEX_PULLING\n" : "")
+        #endif
         #ifdef MAGNUM_TARGET_WEBGL
         .addSource("#define SUBSCRIPTING_WORKAROUND\n")
         #elif defined(MAGNUM_TARGET_GLES2)
@@ -133,6 +171,9 @@ GL::Version MeshVisualizerBase::setupShaders(GL::Shader& vert, GL::Shader& frag,
                 "#define PRIMITIVE_ID_FROM_VERTEX_ID\n" :
                 "#define PRIMITIVE_ID\n") : "")
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        .addSource(fragmentBarycentric ? "#define FRAGMENT_BARYCENTRIC\n" : "")
+        #endif
         ;
 
     return version;
@@ -180,6 +221,22 @@ MeshVisualizerBase& MeshVisualizerBase::bindColorMapTexture(GL::Texture2D& textu
 }
 #endif
 
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+MeshVisualizerBase& MeshVisualizerBase::bindIndexBufferTexture(GL::BufferTexture& texture) {
+    CORRADE_ASSERT(_flags & FlagBase::VertexPulling,
+        "Shaders::MeshVisualizer::bindIndexBufferTexture(): the shader was not created with vertex pulling enabled", *this);
+    texture.bind(IndexTextureUnit);
+    return *this;
+}
+
+MeshVisualizerBase& MeshVisualizerBase::bindPositionBufferTexture(GL::BufferTexture& texture) {
+    CORRADE_ASSERT(_flags & FlagBase::VertexPulling,
+        "Shaders::MeshVisualizer::bindPositionBufferTexture(): the shader was not created with vertex pulling enabled", *this);
+    texture.bind(PositionTextureUnit);
+    return *this;
+}
+#endif
+
 }
 
 MeshVisualizer2D::MeshVisualizer2D(const Flags flags): Implementation::MeshVisualizerBase{Implementation::MeshVisualizerBase::FlagBase(UnsignedShort(flags))} {
@@ -232,39 +289,51 @@ MeshVisualizer2D::MeshVisualizer2D(const Flags flags): Implementation::MeshVisua
     #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
-    else
-    #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = !cache ? std::string{} : geom ? cache->key({vert, *geom, frag}) : cache->key({vert, frag});
+    if(!cache || !cache->load(*this, cacheKey))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+        else
         #endif
+            CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) attachShader(*geom);
+        #endif
+
+        /* ES3 has this done in the shader directly */
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedObjectId)
+                bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
         #endif
-    }
-    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
+    }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -290,6 +359,12 @@ MeshVisualizer2D::MeshVisualizer2D(const Flags flags): Implementation::MeshVisua
             setUniform(uniformLocation("colorMapTexture"), ColorMapTextureUnit);
         }
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::VertexPulling) {
+            setUniform(uniformLocation("indexTexture"), IndexTextureUnit);
+            setUniform(uniformLocation("positionTexture"), PositionTextureUnit);
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
@@ -342,6 +417,8 @@ MeshVisualizer3D::MeshVisualizer3D(const Flags flags): Implementation::MeshVisua
         "Shaders::MeshVisualizer3D: at least one visualization feature has to be enabled", );
     CORRADE_ASSERT(!(flags & Flag::NoGeometryShader && flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection)),
         "Shaders::MeshVisualizer3D: geometry shader has to be enabled when rendering TBN direction", );
+    CORRADE_ASSERT(!(flags & Flag::VertexPulling && flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection)),
+        "Shaders::MeshVisualizer3D: Flag::VertexPulling can't be used together with TBN direction", );
     CORRADE_ASSERT(!(flags & Flag::BitangentDirection && flags & Flag::BitangentFromTangentDirection),
         "Shaders::MeshVisualizer3D: Flag::BitangentDirection and Flag::BitangentFromTangentDirection are mutually exclusive", );
     #elif !defined(MAGNUM_TARGET_GLES2)
@@ -426,50 +503,62 @@ MeshVisualizer3D::MeshVisualizer3D(const Flags flags): Implementation::MeshVisua
     #endif
 
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
-    else
-    #endif
-        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-    if(geom) attachShader(*geom);
-    #endif
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = !cache ? std::string{} : geom ? cache->key({vert, *geom, frag}) : cache->key({vert, frag});
+    if(!cache || !cache->load(*this, cacheKey))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
-        #ifndef MAGNUM_TARGET_GLES2
-        if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(geom) CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, *geom, frag}));
+        else
         #endif
+            CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
-        if(flags & Flag::TangentDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Tangent4::Location, "tangent");
-        if(flags & Flag::BitangentDirection)
-            bindAttributeLocation(Bitangent::Location, "bitangent");
-        if(flags & Flag::NormalDirection ||
-           flags & Flag::BitangentFromTangentDirection)
-            bindAttributeLocation(Normal::Location, "normal");
+        if(geom) attachShader(*geom);
         #endif
 
+        /* ES3 has this done in the shader directly */
         #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
         #ifndef MAGNUM_TARGET_GLES
-        if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
         #endif
         {
-            bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            bindAttributeLocation(Position::Location, "position");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::InstancedObjectId)
+                bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            if(flags & Flag::TangentDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                bindAttributeLocation(Tangent4::Location, "tangent");
+            if(flags & Flag::BitangentDirection)
+                bindAttributeLocation(Bitangent::Location, "bitangent");
+            if(flags & Flag::NormalDirection ||
+               flags & Flag::BitangentFromTangentDirection)
+                bindAttributeLocation(Normal::Location, "normal");
+            #endif
+
+            #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+            #ifndef MAGNUM_TARGET_GLES
+            if(!GL::Context::current().isVersionSupported(GL::Version::GL310))
+            #endif
+            {
+                bindAttributeLocation(VertexIndex::Location, "vertexIndex");
+            }
+            #endif
         }
         #endif
-    }
-    #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
+    }
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
@@ -503,6 +592,12 @@ MeshVisualizer3D::MeshVisualizer3D(const Flags flags): Implementation::MeshVisua
         }
         #endif
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(flags & Flag::VertexPulling) {
+            setUniform(uniformLocation("indexTexture"), IndexTextureUnit);
+            setUniform(uniformLocation("positionTexture"), PositionTextureUnit);
+        }
+        #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         if(flags & (Flag::TangentDirection|Flag::BitangentFromTangentDirection|Flag::BitangentDirection|Flag::NormalDirection)) {
             _normalMatrixUniform = uniformLocation("normalMatrix");
             _lineWidthUniform = uniformLocation("lineWidth");
@@ -626,6 +721,9 @@ Debug& operator<<(Debug& debug, const MeshVisualizer2D::Flag value) {
         #endif
         _c(PrimitiveIdFromVertexId)
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _c(VertexPulling)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -655,6 +753,9 @@ Debug& operator<<(Debug& debug, const MeshVisualizer3D::Flag value) {
         #endif
         _c(PrimitiveIdFromVertexId)
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        _c(VertexPulling)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -673,8 +774,11 @@ Debug& operator<<(Debug& debug, const MeshVisualizer2D::Flags value) {
         MeshVisualizer2D::Flag::VertexId,
         MeshVisualizer2D::Flag::PrimitiveIdFromVertexId, /* Superset of PrimitiveId */
         #ifndef MAGNUM_TARGET_WEBGL
-        MeshVisualizer2D::Flag::PrimitiveId
+        MeshVisualizer2D::Flag::PrimitiveId,
+        #endif
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        MeshVisualizer2D::Flag::VertexPulling
         #endif
     });
 }
@@ -696,9 +800,12 @@ Debug& operator<<(Debug& debug, const MeshVisualizer3D::Flags value) {
         MeshVisualizer3D::Flag::VertexId,
         MeshVisualizer3D::Flag::PrimitiveIdFromVertexId, /* Superset of PrimitiveId */
         #ifndef MAGNUM_TARGET_WEBGL
-        MeshVisualizer3D::Flag::PrimitiveId
+        MeshVisualizer3D::Flag::PrimitiveId,
         #endif
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        MeshVisualizer3D::Flag::VertexPulling
+        #endif
     });
 }
 
@@ -44,6 +44,10 @@
 #extension GL_NV_shader_noperspective_interpolation: require
 #endif
 
+#if defined(WIREFRAME_RENDERING) && defined(FRAGMENT_BARYCENTRIC)
+#extension GL_NV_fragment_shader_barycentric: require
+#endif
+
 #if (defined(WIREFRAME_RENDERING) || defined(INSTANCED_OBJECT_ID) || defined(VERTEX_ID) || defined(PRIMITIVE_ID) || defined(PRIMITIVE_ID_FROM_VERTEX_ID)) && !defined(TBN_DIRECTION)
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
@@ -121,6 +125,9 @@ uniform lowp vec2 colorMapOffsetScale
 noperspective
 #endif
 in lowp vec3 dist;
+#elif defined(FRAGMENT_BARYCENTRIC)
+/* Provided by the driver, no need to calculate it in the vertex shader */
+#define barycentric gl_BaryCoordNV
 #else
 in lowp vec3 barycentric;
 #endif
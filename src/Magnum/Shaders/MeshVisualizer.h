@@ -52,7 +52,10 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerBase: public GL::AbstractShaderProgram
             InstancedObjectId = 1 << 2,
             VertexId = 1 << 3,
             PrimitiveId = 1 << 4,
-            PrimitiveIdFromVertexId = (1 << 5)|PrimitiveId
+            PrimitiveIdFromVertexId = (1 << 5)|PrimitiveId,
+            #endif
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            VertexPulling = 1 << 10
             #endif
         };
         typedef Containers::EnumSet<FlagBase> FlagsBase;
@@ -71,6 +74,10 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizerBase: public GL::AbstractShaderProgram
         MeshVisualizerBase& setColorMapTransformation(Float offset, Float scale);
         MeshVisualizerBase& bindColorMapTexture(GL::Texture2D& texture);
         #endif
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        MeshVisualizerBase& bindIndexBufferTexture(GL::BufferTexture& texture);
+        MeshVisualizerBase& bindPositionBufferTexture(GL::BufferTexture& texture);
+        #endif
 
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
@@ -199,11 +206,19 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer2D: public Implementation::MeshVisuali
 
             /** @copydoc MeshVisualizer3D::Flag::PrimitiveIdFromVertexId */
             #ifndef MAGNUM_TARGET_WEBGL
-            PrimitiveIdFromVertexId = (1 << 5)|PrimitiveId
+            PrimitiveIdFromVertexId = (1 << 5)|PrimitiveId,
             #else
-            PrimitiveIdFromVertexId = (1 << 5)|(1 << 4)
+            PrimitiveIdFromVertexId = (1 << 5)|(1 << 4),
             #endif
             #endif
+
+            #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+            /**
+             * @copydoc MeshVisualizer3D::Flag::VertexPulling
+             * @m_since_latest
+             */
+            VertexPulling = 1 << 10
+            #endif
         };
 
         /** @brief Flags */
@@ -315,6 +330,36 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer2D: public Implementation::MeshVisuali
         }
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @copydoc MeshVisualizer3D::bindIndexBufferTexture()
+         * @m_since_latest
+         */
+        MeshVisualizer2D& bindIndexBufferTexture(GL::BufferTexture& texture) {
+            return static_cast<MeshVisualizer2D&>(Implementation::MeshVisualizerBase::bindIndexBufferTexture(texture));
+        }
+
+        /**
+         * @brief Bind a vertex position buffer texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is enabled. The texture is
+         * expected to contain vertex positions in the
+         * @ref GL::BufferTextureFormat::RG32F,
+         * @ref GL::BufferTextureFormat::RGB32F "RGB32F" or
+         * @ref GL::BufferTextureFormat::RGBA32F "RGBA32F" format, only the
+         * first two components are used.
+         * @requires_gl31 Extension @gl_extension{ARB,texture_buffer_object}
+         * @requires_gles32 Extension @gl_extension{ANDROID,extension_pack_es31a} /
+         *      @gl_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        MeshVisualizer2D& bindPositionBufferTexture(GL::BufferTexture& texture) {
+            return static_cast<MeshVisualizer2D&>(Implementation::MeshVisualizerBase::bindPositionBufferTexture(texture));
+        }
+        #endif
+
         /**
          * @brief Set line smoothness
          * @return Reference to self (for method chaining)
@@ -411,6 +456,28 @@ Rendering setup:
 
 @snippet MagnumShaders.cpp MeshVisualizer-usage-no-geom2
 
+@subsection Shaders-MeshVisualizer-wireframe-barycentric Wireframe without a geometry shader using fragment barycentrics
+
+If @gl_extension{NV,fragment_shader_barycentric} is supported, the shader
+created with @ref Flag::NoGeometryShader takes barycentric coordinates from the
+@glsl gl_BaryCoordNV @ce builtin instead of deriving them from
+@glsl gl_VertexID @ce. In that case the mesh doesn't need to be converted to a
+non-indexed array and can be drawn as-is, with the same cost as a plain flat
+shader. The extension is picked up automatically, check for it with
+@ref GL::Context::isExtensionSupported() if you want to skip the
+@ref MeshTools::duplicate() step in your code.
+
+@subsection Shaders-MeshVisualizer-wireframe-vertex-pulling Wireframe of large indexed meshes without a geometry shader
+
+For very large meshes where duplicating all vertices is too expensive and
+fragment barycentrics are not available, enable @ref Flag::VertexPulling
+together with @ref Flag::NoGeometryShader. The shader then fetches the index
+and position of each vertex from buffer textures, with @glsl gl_VertexID @ce
+being the position in the index buffer, so the index and vertex buffers can be
+reused directly with no extra memory:
+
+@snippet MagnumShaders.cpp MeshVisualizer-usage-vertex-pulling
+
 @subsection Shaders-MeshVisualizer-usage-wireframe-no-geom-old Wireframe visualization of non-indexed meshes without a geometry shader on older hardware
 
 You need to provide also the @ref VertexIndex attribute. Mesh setup *in
@@ -741,7 +808,28 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer3D: public Implementation::MeshVisuali
              * @requires_gles Geometry shaders are not available in WebGL.
              * @m_since{2020,06}
              */
-            NormalDirection = 1 << 9
+            NormalDirection = 1 << 9,
+
+            /**
+             * Fetch vertex positions and indices from buffer textures
+             * instead of vertex attributes. Meant for wireframe
+             * visualization of very large indexed meshes without a geometry
+             * shader, where duplicating the vertex data for
+             * @ref Flag::NoGeometryShader would be prohibitively expensive.
+             * The mesh is then drawn as a non-indexed triangle list with
+             * vertex count equal to the index count and no attributes, see
+             * @ref Shaders-MeshVisualizer-wireframe-vertex-pulling for an
+             * example. Mutually exclusive with @ref Flag::InstancedObjectId,
+             * @ref Flag::TangentDirection,
+             * @ref Flag::BitangentFromTangentDirection,
+             * @ref Flag::BitangentDirection and @ref Flag::NormalDirection.
+             * @requires_gl31 Extension @gl_extension{ARB,texture_buffer_object}
+             * @requires_gles32 Extension @gl_extension{ANDROID,extension_pack_es31a} /
+             *      @gl_extension{EXT,texture_buffer}
+             * @requires_gles Buffer textures are not available in WebGL.
+             * @m_since_latest
+             */
+            VertexPulling = 1 << 10
             #endif
         };
 
@@ -953,6 +1041,48 @@ class MAGNUM_SHADERS_EXPORT MeshVisualizer3D: public Implementation::MeshVisuali
         }
         #endif
 
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        /**
+         * @brief Bind an index buffer texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is enabled. The texture is
+         * expected to contain triangle indices in the
+         * @ref GL::BufferTextureFormat::R32UI format. For non-indexed meshes
+         * fill it with a sequence of @cpp 0 @ce to vertex count.
+         * @requires_gl31 Extension @gl_extension{ARB,texture_buffer_object}
+         * @requires_gles32 Extension @gl_extension{ANDROID,extension_pack_es31a} /
+         *      @gl_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        MeshVisualizer3D& bindIndexBufferTexture(GL::BufferTexture& texture) {
+            return static_cast<MeshVisualizer3D&>(Implementation::MeshVisualizerBase::bindIndexBufferTexture(texture));
+        }
+
+        /**
+         * @brief Bind a vertex position buffer texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::VertexPulling is enabled. The texture is
+         * expected to contain vertex positions in the
+         * @ref GL::BufferTextureFormat::RGB32F or
+         * @ref GL::BufferTextureFormat::RGBA32F "RGBA32F" format, the fourth
+         * component is ignored. Note that @ref GL::BufferTextureFormat::RGB32F
+         * requires @gl_extension{ARB,texture_buffer_object_rgb32} on desktop
+         * GL and OpenGL ES 3.2, on older platforms pad the positions to
+         * four components.
+         * @requires_gl31 Extension @gl_extension{ARB,texture_buffer_object}
+         * @requires_gles32 Extension @gl_extension{ANDROID,extension_pack_es31a} /
+         *      @gl_extension{EXT,texture_buffer}
+         * @requires_gles Buffer textures are not available in WebGL.
+         */
+        MeshVisualizer3D& bindPositionBufferTexture(GL::BufferTexture& texture) {
+            return static_cast<MeshVisualizer3D&>(Implementation::MeshVisualizerBase::bindPositionBufferTexture(texture));
+        }
+        #endif
+
         #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
         /**
          * @brief Set line width
@@ -27,6 +27,10 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(VERTEX_PULLING) && defined(GL_ES) && __VERSION__ < 320
+#extension GL_EXT_texture_buffer: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
@@ -95,6 +99,7 @@ uniform highp float lineLength
     ;
 #endif
 
+#ifndef VERTEX_PULLING
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -105,6 +110,19 @@ in highp vec4 position;
 #else
 #error
 #endif
+#else
+/* Index and position are fetched from buffer textures, gl_VertexID being the
+   position in the index buffer */
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 5)
+#endif
+uniform highp usamplerBuffer indexTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 6)
+#endif
+uniform highp samplerBuffer positionTexture;
+#endif
 
 #if defined(TANGENT_DIRECTION) || defined(BITANGENT_FROM_TANGENT_DIRECTION)
 #ifdef EXPLICIT_ATTRIB_LOCATION
@@ -127,7 +145,7 @@ layout(location = NORMAL_ATTRIBUTE_LOCATION)
 in highp vec3 normal;
 #endif
 
-#if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
+#if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER) && !defined(FRAGMENT_BARYCENTRIC)
 #if (!defined(GL_ES) && __VERSION__ < 140) || (defined(GL_ES) && __VERSION__ < 300)
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = 4)
@@ -179,6 +197,17 @@ out highp vec4 normalEndpoint;
 #endif
 
 void main() {
+    #ifdef VERTEX_PULLING
+    highp int pulledIndex = int(texelFetch(indexTexture, gl_VertexID).r);
+    #ifdef TWO_DIMENSIONS
+    highp vec2 position = texelFetch(positionTexture, pulledIndex).xy;
+    #elif defined(THREE_DIMENSIONS)
+    highp vec4 position = vec4(texelFetch(positionTexture, pulledIndex).xyz, 1.0);
+    #else
+    #error
+    #endif
+    #endif
+
     #ifdef TWO_DIMENSIONS
     gl_Position.xywz = vec4(transformationProjectionMatrix*vec3(position, 1.0), 0.0);
     #elif defined(THREE_DIMENSIONS)
@@ -200,7 +229,7 @@ void main() {
     normalEndpoint = projectionMatrix*(transformationMatrix*position + vec4(normalize(normalMatrix*normal)*lineLength, 0.0));
     #endif
 
-    #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER)
+    #if defined(WIREFRAME_RENDERING) && defined(NO_GEOMETRY_SHADER) && !defined(FRAGMENT_BARYCENTRIC)
     barycentric = vec3(0.0);
 
     #ifdef SUBSCRIPTING_WORKAROUND
@@ -233,7 +262,13 @@ void main() {
     #else
     interpolatedVsMappedVertexId
     #endif
-        = colorMapOffset + float(gl_VertexID)*colorMapScale;
+        = colorMapOffset + float(
+            #ifdef VERTEX_PULLING
+            pulledIndex
+            #else
+            gl_VertexID
+            #endif
+            )*colorMapScale;
     #endif
     #ifdef PRIMITIVE_ID_FROM_VERTEX_ID
     #ifdef NO_GEOMETRY_SHADER
@@ -0,0 +1,313 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MorphTargets.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    #ifndef MAGNUM_TARGET_WEBGL
+    enum: UnsignedInt {
+        BasePositionBufferBinding = 0,
+        PositionDeltaBufferBinding = 1,
+        PositionBufferBinding = 2,
+        BaseNormalBufferBinding = 3,
+        NormalDeltaBufferBinding = 4,
+        NormalBufferBinding = 5
+    };
+
+    enum: UnsignedInt { WorkgroupSize = 64 };
+    #endif
+}
+
+MorphTargets::MorphTargets(const Flags flags, const UnsignedInt morphTargetCount): _flags{flags}, _morphTargetCount{morphTargetCount} {
+    CORRADE_ASSERT(morphTargetCount,
+        "Shaders::MorphTargets: expected at least one morph target", );
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_ASSERT(flags & Flag::Compute || morphTargetCount <= MaxTransformFeedbackMorphTargetCount,
+        "Shaders::MorphTargets: at most" << UnsignedInt(MaxTransformFeedbackMorphTargetCount) << "morph targets supported with transform feedback but got" << morphTargetCount, );
+    #else
+    CORRADE_ASSERT(morphTargetCount <= MaxTransformFeedbackMorphTargetCount,
+        "Shaders::MorphTargets: at most" << UnsignedInt(MaxTransformFeedbackMorphTargetCount) << "morph targets supported with transform feedback but got" << morphTargetCount, );
+    #endif
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    const std::string defines = Utility::formatString(
+        "#define MORPH_TARGET_COUNT {}\n{}",
+        morphTargetCount, flags & Flag::Normals ? "#define NORMALS\n" : "");
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(flags & Flag::Compute) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL430);
+        const GL::Version version = GL::Version::GL430;
+        #else
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GLES310);
+        const GL::Version version = GL::Version::GLES310;
+        #endif
+
+        GL::Shader comp = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Compute);
+        comp.addSource(defines)
+            .addSource(rs.get("MorphTargets.comp"));
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(comp.compile());
+        attachShader(comp);
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+        #endif
+        {
+            _vertexCountUniform = uniformLocation("vertexCount");
+            _weightsUniform = uniformLocation("weights");
+        }
+        #ifndef MAGNUM_TARGET_GLES
+        else _weightsUniform = 1;
+        #endif
+
+        return;
+    }
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::transform_feedback);
+    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    /* OpenGL ES needs a fragment shader for the program to link, even though
+       nothing gets rasterized */
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(defines)
+        .addSource(rs.get("MorphTargets.vert"));
+    frag.addSource("void main() {}\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    /* ES3 has this done in the shader directly */
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version)) {
+        bindAttributeLocation(Position::Location, "position");
+        if(flags & Flag::Normals)
+            bindAttributeLocation(Normal::Location, "normal");
+        for(UnsignedInt i = 0; i != morphTargetCount; ++i) {
+            bindAttributeLocation(PositionDelta<0>::Location + i, Utility::formatString("positionDelta{}", i));
+            if(flags & Flag::Normals)
+                bindAttributeLocation(NormalDelta<0>::Location + i, Utility::formatString("normalDelta{}", i));
+        }
+    }
+    #endif
+
+    /* Positions and normals each to a separate buffer, matching
+       PositionOutput and NormalOutput */
+    if(flags & Flag::Normals)
+        setTransformFeedbackOutputs({"morphedPosition", "morphedNormal"}, TransformFeedbackBufferMode::SeparateAttributes);
+    else
+        setTransformFeedbackOutputs({"morphedPosition"}, TransformFeedbackBufferMode::SeparateAttributes);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _weightsUniform = uniformLocation("weights");
+    }
+}
+
+MorphTargets& MorphTargets::setWeights(const Containers::ArrayView<const Float> weights) {
+    CORRADE_ASSERT(weights.size() <= _morphTargetCount,
+        "Shaders::MorphTargets::setWeights(): expected at most" << _morphTargetCount << "items but got" << weights.size(), *this);
+    if(!weights.empty()) setUniform(_weightsUniform, weights);
+    return *this;
+}
+
+MorphTargets& MorphTargets::setWeights(const std::initializer_list<Float> weights) {
+    return setWeights(Containers::arrayView(weights));
+}
+
+MorphTargets& MorphTargets::setWeight(const UnsignedInt id, const Float weight) {
+    CORRADE_ASSERT(id < _morphTargetCount,
+        "Shaders::MorphTargets::setWeight(): morph target ID" << id << "is out of bounds for" << _morphTargetCount << "morph targets", *this);
+    setUniform(_weightsUniform + id, weight);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+MorphTargets& MorphTargets::bindBasePositionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindBasePositionBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BasePositionBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindBasePositionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindBasePositionBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BasePositionBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindPositionDeltaBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindPositionDeltaBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionDeltaBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindPositionDeltaBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindPositionDeltaBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionDeltaBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindPositionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindPositionBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindPositionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindPositionBuffer(): the shader was not created with compute enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, PositionBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindBaseNormalBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindBaseNormalBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindBaseNormalBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BaseNormalBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindBaseNormalBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindBaseNormalBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindBaseNormalBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, BaseNormalBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindNormalDeltaBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindNormalDeltaBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindNormalDeltaBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalDeltaBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindNormalDeltaBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindNormalDeltaBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindNormalDeltaBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalDeltaBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindNormalBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindNormalBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindNormalBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalBufferBinding);
+    return *this;
+}
+
+MorphTargets& MorphTargets::bindNormalBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::bindNormalBuffer(): the shader was not created with compute enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::Normals,
+        "Shaders::MorphTargets::bindNormalBuffer(): the shader was not created with normals enabled", *this);
+    buffer.bind(GL::Buffer::Target::ShaderStorage, NormalBufferBinding, offset, size);
+    return *this;
+}
+
+MorphTargets& MorphTargets::dispatch(const UnsignedInt vertexCount) {
+    CORRADE_ASSERT(_flags & Flag::Compute,
+        "Shaders::MorphTargets::dispatch(): the shader was not created with compute enabled", *this);
+    setUniform(_vertexCountUniform, vertexCount);
+    dispatchCompute({(vertexCount + WorkgroupSize - 1)/WorkgroupSize, 1, 1});
+    return *this;
+}
+#endif
+
+Debug& operator<<(Debug& debug, const MorphTargets::Flag value) {
+    debug << "Shaders::MorphTargets::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case MorphTargets::Flag::v: return debug << "::" #v;
+        _c(Normals)
+        #ifndef MAGNUM_TARGET_WEBGL
+        _c(Compute)
+        #endif
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const MorphTargets::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::MorphTargets::Flags{}", {
+        MorphTargets::Flag::Normals,
+        #ifndef MAGNUM_TARGET_WEBGL
+        MorphTargets::Flag::Compute
+        #endif
+        });
+}
+
+}}
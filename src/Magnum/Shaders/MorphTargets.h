@@ -0,0 +1,440 @@
+#ifndef Magnum_Shaders_MorphTargets_h
+#define Magnum_Shaders_MorphTargets_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::MorphTargets
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <initializer_list>
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Morph target evaluation shader
+@m_since_latest
+
+Evaluates morph targets (also called blend shapes) on the GPU, adding
+per-vertex position and optionally normal deltas scaled by per-target weights
+to a base mesh. The result is written into buffers that are then used as
+regular vertex attributes for rendering with any other shader such as
+@ref Phong, which thus doesn't need to be aware of morph targets at all. The
+deltas are usually coming from morph target attributes of a
+@ref Trade::MeshData, see @ref Trade-MeshData-morph-targets for details.
+
+Compared to morphing on the CPU, the base mesh and all deltas are uploaded
+just once and only the weights are updated every frame. For many instances of
+the same mesh, such as faces of many characters, it's enough to evaluate each
+instance into a different range of the output buffers.
+
+The shader has two variants. By default it's evaluated using transform
+feedback, with @ref Flag::Compute a compute shader is used instead, which
+isn't limited in the count of morph targets.
+
+@section Shaders-MorphTargets-transform-feedback Transform feedback evaluation
+
+The base mesh is described with the @ref Position and optionally @ref Normal
+attributes, the deltas with @ref PositionDelta and @ref NormalDelta. The mesh
+is drawn as @ref MeshPrimitive::Points with rasterization disabled, the
+morphed positions are written to a transform feedback buffer at index
+@ref PositionOutput and normals, if @ref Flag::Normals is enabled, to a buffer
+at index @ref NormalOutput:
+
+@snippet MagnumShaders.cpp MorphTargets-transform-feedback
+
+Because OpenGL guarantees only 16 vertex attributes, this variant is limited to
+@ref MaxTransformFeedbackMorphTargetCount morph targets. For meshes with more
+morph targets it's possible to bind just deltas of the targets with the
+largest weights, as in facial animation usually only a few expressions are
+active at a time. Or use the compute variant, if available.
+
+@section Shaders-MorphTargets-compute Compute evaluation
+
+With @ref Flag::Compute, the base positions, position deltas and the output
+positions are tightly packed three-component float vectors in shader storage
+buffers bound with @ref bindBasePositionBuffer(),
+@ref bindPositionDeltaBuffer() and @ref bindPositionBuffer(), and similarly
+for normals with @ref Flag::Normals. The delta buffer contains deltas of all
+morph targets one after another, i.e. the first morph target for all vertices,
+then the second, etc. Morph targets with a zero weight are skipped without
+reading their deltas. The evaluation is then executed with @ref dispatch():
+
+@snippet MagnumShaders.cpp MorphTargets-compute
+
+Before using the output buffers as vertex attributes, a
+@ref GL::Renderer::MemoryBarrier::VertexAttributeArray memory barrier has to
+be issued.
+
+@requires_gl30 Extension @gl_extension{EXT,transform_feedback}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT MorphTargets: public GL::AbstractShaderProgram {
+    public:
+        /**
+         * @brief Base vertex position
+         *
+         * @ref Magnum::Vector3 "Vector3". Used only if @ref Flag::Compute is
+         * not set.
+         */
+        typedef GL::Attribute<0, Vector3> Position;
+
+        /**
+         * @brief Base normal direction
+         *
+         * @ref Magnum::Vector3 "Vector3". Used only if @ref Flag::Normals is
+         * set and @ref Flag::Compute is not set.
+         */
+        typedef GL::Attribute<1, Vector3> Normal;
+
+        /**
+         * @brief Position delta of given morph target
+         *
+         * @ref Magnum::Vector3 "Vector3". The @p id is expected to be less
+         * than @ref MaxTransformFeedbackMorphTargetCount. Used only if
+         * @ref Flag::Compute is not set.
+         */
+        template<UnsignedInt id> using PositionDelta = GL::Attribute<2 + id, Vector3>;
+
+        /**
+         * @brief Normal delta of given morph target
+         *
+         * @ref Magnum::Vector3 "Vector3". The @p id is expected to be less
+         * than @ref MaxTransformFeedbackMorphTargetCount. Used only if
+         * @ref Flag::Normals is set and @ref Flag::Compute is not set.
+         */
+        template<UnsignedInt id> using NormalDelta = GL::Attribute<9 + id, Vector3>;
+
+        enum: UnsignedInt {
+            /**
+             * Transform feedback buffer index to which morphed positions are
+             * written. Used only if @ref Flag::Compute is not set.
+             */
+            PositionOutput = 0,
+
+            /**
+             * Transform feedback buffer index to which morphed normals are
+             * written. Used only if @ref Flag::Normals is set and
+             * @ref Flag::Compute is not set.
+             */
+            NormalOutput = 1,
+
+            /**
+             * Max count of morph targets evaluated using transform feedback.
+             * Together with the base position and normal it's 16 vertex
+             * attributes, which is the minimum guaranteed by OpenGL.
+             */
+            MaxTransformFeedbackMorphTargetCount = 7
+        };
+
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /** Evaluate normals in addition to positions */
+            Normals = 1 << 0,
+
+            #ifndef MAGNUM_TARGET_WEBGL
+            /**
+             * Evaluate using a compute shader instead of transform feedback.
+             * See @ref Shaders-MorphTargets-compute for more information.
+             * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+             *      @gl_extension{ARB,shader_storage_buffer_object}
+             * @requires_gles31 Compute shaders are not available in OpenGL ES
+             *      3.0 and older.
+             * @requires_gles Compute shaders are not available in WebGL.
+             */
+            Compute = 1 << 1
+            #endif
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags             Flags
+         * @param morphTargetCount  Count of morph targets
+         *
+         * Expects that @p morphTargetCount is at least @cpp 1 @ce and, if
+         * @ref Flag::Compute is not set, at most
+         * @ref MaxTransformFeedbackMorphTargetCount.
+         */
+        explicit MorphTargets(Flags flags, UnsignedInt morphTargetCount);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit MorphTargets(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        MorphTargets(const MorphTargets&) = delete;
+
+        /** @brief Move constructor */
+        MorphTargets(MorphTargets&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        MorphTargets& operator=(const MorphTargets&) = delete;
+
+        /** @brief Move assignment */
+        MorphTargets& operator=(MorphTargets&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /** @brief Morph target count */
+        UnsignedInt morphTargetCount() const { return _morphTargetCount; }
+
+        /**
+         * @brief Set morph target weights
+         * @return Reference to self (for method chaining)
+         *
+         * Sets the first @cpp weights.size() @ce weights, expects that it's
+         * not more than @ref morphTargetCount(). Initial value of all weights
+         * is @cpp 0.0f @ce.
+         * @see @ref setWeight()
+         */
+        MorphTargets& setWeights(Containers::ArrayView<const Float> weights);
+
+        /** @overload */
+        MorphTargets& setWeights(std::initializer_list<Float> weights);
+
+        /**
+         * @brief Set weight of given morph target
+         * @return Reference to self (for method chaining)
+         *
+         * Unlike @ref setWeights() updates just a single weight. Expects that
+         * @p id is less than @ref morphTargetCount().
+         */
+        MorphTargets& setWeight(UnsignedInt id, Float weight);
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        /**
+         * @brief Bind a base position buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Compute is set. The buffer is expected to
+         * contain at least as many tightly packed three-component float
+         * vectors as is the vertex count passed to @ref dispatch().
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindBasePositionBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindBasePositionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a position delta buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Compute is set. The buffer is expected to
+         * contain tightly packed three-component float vectors for all
+         * vertices of the first morph target, followed by all vertices of
+         * the second morph target and so on for all
+         * @ref morphTargetCount() morph targets.
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindPositionDeltaBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindPositionDeltaBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an output position buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Compute is set. Morphed positions are
+         * written into the buffer as tightly packed three-component float
+         * vectors.
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindPositionBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindPositionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a base normal buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that both @ref Flag::Compute and @ref Flag::Normals is set.
+         * Layout is the same as with @ref bindBasePositionBuffer().
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindBaseNormalBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindBaseNormalBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind a normal delta buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that both @ref Flag::Compute and @ref Flag::Normals is set.
+         * Layout is the same as with @ref bindPositionDeltaBuffer().
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindNormalDeltaBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindNormalDeltaBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Bind an output normal buffer
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that both @ref Flag::Compute and @ref Flag::Normals is set.
+         * Layout is the same as with @ref bindPositionBuffer(). The morphed
+         * normals are not renormalized.
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindNormalBuffer(GL::Buffer& buffer);
+        /**
+         * @overload
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& bindNormalBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Evaluate the morph targets using a compute shader
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @ref Flag::Compute is set. Processes @p vertexCount
+         * vertices from the bound buffers, in work groups of 64 vertices.
+         * @see @ref dispatchCompute()
+         * @requires_gl43 Extension @gl_extension{ARB,compute_shader} and
+         *      @gl_extension{ARB,shader_storage_buffer_object}
+         * @requires_gles31 Compute shaders are not available in OpenGL ES
+         *      3.0 and older.
+         * @requires_gles Compute shaders are not available in WebGL.
+         */
+        MorphTargets& dispatch(UnsignedInt vertexCount);
+        #endif
+
+    private:
+        Flags _flags;
+        UnsignedInt _morphTargetCount{};
+        Int _weightsUniform{0};
+        #ifndef MAGNUM_TARGET_WEBGL
+        Int _vertexCountUniform{0};
+        #endif
+};
+
+/** @debugoperatorclassenum{MorphTargets,MorphTargets::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, MorphTargets::Flag value);
+
+/** @debugoperatorclassenum{MorphTargets,MorphTargets::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, MorphTargets::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(MorphTargets::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
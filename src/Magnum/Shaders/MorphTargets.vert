@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Uniforms */
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp float weights[MORPH_TARGET_COUNT]; /* defaults to zero */
+
+/* Inputs. Vertex shader inputs can't be arrays in GLSL ES 3.00, so each morph
+   target delta is a separate attribute. */
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0)
+#endif
+in highp vec3 position;
+
+#ifdef NORMALS
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 1)
+#endif
+in highp vec3 normal;
+#endif
+
+#if MORPH_TARGET_COUNT > 0
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 2)
+#endif
+in highp vec3 positionDelta0;
+#endif
+#if MORPH_TARGET_COUNT > 1
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 3)
+#endif
+in highp vec3 positionDelta1;
+#endif
+#if MORPH_TARGET_COUNT > 2
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 4)
+#endif
+in highp vec3 positionDelta2;
+#endif
+#if MORPH_TARGET_COUNT > 3
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 5)
+#endif
+in highp vec3 positionDelta3;
+#endif
+#if MORPH_TARGET_COUNT > 4
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 6)
+#endif
+in highp vec3 positionDelta4;
+#endif
+#if MORPH_TARGET_COUNT > 5
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 7)
+#endif
+in highp vec3 positionDelta5;
+#endif
+#if MORPH_TARGET_COUNT > 6
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 8)
+#endif
+in highp vec3 positionDelta6;
+#endif
+
+#ifdef NORMALS
+#if MORPH_TARGET_COUNT > 0
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 9)
+#endif
+in highp vec3 normalDelta0;
+#endif
+#if MORPH_TARGET_COUNT > 1
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 10)
+#endif
+in highp vec3 normalDelta1;
+#endif
+#if MORPH_TARGET_COUNT > 2
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 11)
+#endif
+in highp vec3 normalDelta2;
+#endif
+#if MORPH_TARGET_COUNT > 3
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 12)
+#endif
+in highp vec3 normalDelta3;
+#endif
+#if MORPH_TARGET_COUNT > 4
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 13)
+#endif
+in highp vec3 normalDelta4;
+#endif
+#if MORPH_TARGET_COUNT > 5
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 14)
+#endif
+in highp vec3 normalDelta5;
+#endif
+#if MORPH_TARGET_COUNT > 6
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 15)
+#endif
+in highp vec3 normalDelta6;
+#endif
+#endif
+
+/* Outputs, captured with transform feedback */
+
+out highp vec3 morphedPosition;
+#ifdef NORMALS
+out highp vec3 morphedNormal;
+#endif
+
+void main() {
+    morphedPosition = position;
+    #ifdef NORMALS
+    morphedNormal = normal;
+    #endif
+
+    #if MORPH_TARGET_COUNT > 0
+    morphedPosition += weights[0]*positionDelta0;
+    #ifdef NORMALS
+    morphedNormal += weights[0]*normalDelta0;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 1
+    morphedPosition += weights[1]*positionDelta1;
+    #ifdef NORMALS
+    morphedNormal += weights[1]*normalDelta1;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 2
+    morphedPosition += weights[2]*positionDelta2;
+    #ifdef NORMALS
+    morphedNormal += weights[2]*normalDelta2;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 3
+    morphedPosition += weights[3]*positionDelta3;
+    #ifdef NORMALS
+    morphedNormal += weights[3]*normalDelta3;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 4
+    morphedPosition += weights[4]*positionDelta4;
+    #ifdef NORMALS
+    morphedNormal += weights[4]*normalDelta4;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 5
+    morphedPosition += weights[5]*positionDelta5;
+    #ifdef NORMALS
+    morphedNormal += weights[5]*normalDelta5;
+    #endif
+    #endif
+    #if MORPH_TARGET_COUNT > 6
+    morphedPosition += weights[6]*positionDelta6;
+    #ifdef NORMALS
+    morphedNormal += weights[6]*normalDelta6;
+    #endif
+    #endif
+
+    /* Not rasterized, but the output has to be written anyway */
+    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,92 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleSystem.h"
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Shaders/ParticleUpdate.h"
+#include "Magnum/Shaders/VertexColor.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    struct Particle {
+        Vector4 positionAge;
+        Vector4 velocityLifetime;
+        Color4 color;
+    };
+}
+
+ParticleSystem::ParticleSystem(const UnsignedInt particleCount): _particleCount{particleCount} {
+    CORRADE_ASSERT(particleCount,
+        "Shaders::ParticleSystem: expected a non-zero particle count", );
+
+    /* Zero lifetime marks a particle that wasn't spawned yet, so only the
+       first buffer needs to be initialized. The other gets fully overwritten
+       by the first update. */
+    _buffers[0].setData(Containers::Array<char>{Containers::ValueInit, particleCount*sizeof(Particle)}, GL::BufferUsage::DynamicCopy);
+    _buffers[1].setData({nullptr, particleCount*sizeof(Particle)}, GL::BufferUsage::DynamicCopy);
+
+    for(std::size_t i = 0; i != 2; ++i) {
+        _updateMeshes[i].setPrimitive(MeshPrimitive::Points)
+            .setCount(particleCount)
+            .addVertexBuffer(_buffers[i], 0,
+                ParticleUpdate::PositionAge{},
+                ParticleUpdate::VelocityLifetime{},
+                sizeof(Particle::color));
+        _meshes[i].setPrimitive(MeshPrimitive::Points)
+            .setCount(particleCount)
+            .addVertexBuffer(_buffers[i], 0,
+                VertexColor3D::Position{},
+                sizeof(Float),
+                sizeof(Particle::velocityLifetime),
+                VertexColor3D::Color4{});
+        _feedbacks[i].attachBuffer(ParticleUpdate::Output, _buffers[i]);
+    }
+}
+
+ParticleSystem::ParticleSystem(NoCreateT) noexcept:
+    _buffers{GL::Buffer{NoCreate}, GL::Buffer{NoCreate}},
+    _updateMeshes{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}},
+    _meshes{GL::Mesh{NoCreate}, GL::Mesh{NoCreate}},
+    _feedbacks{GL::TransformFeedback{NoCreate}, GL::TransformFeedback{NoCreate}} {}
+
+ParticleSystem& ParticleSystem::update(ParticleUpdate& shader) {
+    const UnsignedInt next = _current ^ 1;
+
+    GL::Renderer::enable(GL::Renderer::Feature::RasterizerDiscard);
+    _feedbacks[next].begin(shader, GL::TransformFeedback::PrimitiveMode::Points);
+    shader.draw(_updateMeshes[_current]);
+    _feedbacks[next].end();
+    GL::Renderer::disable(GL::Renderer::Feature::RasterizerDiscard);
+
+    _current = next;
+    return *this;
+}
+
+}}
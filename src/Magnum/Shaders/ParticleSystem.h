@@ -0,0 +1,142 @@
+#ifndef Magnum_Shaders_ParticleSystem_h
+#define Magnum_Shaders_ParticleSystem_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleSystem
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/TransformFeedback.h"
+#include "Magnum/Shaders/Shaders.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief GPU particle system
+@m_since_latest
+
+Owns two buffers with particle data in the layout described in
+@ref ParticleUpdate together with meshes and transform feedback objects for
+updating them in a ping-pong fashion. Each @ref update() reads one buffer and
+writes into the other using @ref ParticleUpdate, the @ref mesh() then renders
+the latest state as @ref MeshPrimitive::Points with @ref VertexColor3D:
+
+@snippet MagnumShaders.cpp ParticleSystem-usage
+
+The buffers are filled with zeros on construction, which is the only time
+particle data are transferred from the CPU. After that, everything stays on
+the GPU, with per-frame work on the CPU side being only a few uniform updates
+and two draw calls regardless of the particle count. The particle count is
+constant, particles that are not alive are drawn fully transparent, so there's
+no need to read back the count of alive particles either.
+
+@requires_gl40 Extension @gl_extension{ARB,transform_feedback2}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT ParticleSystem {
+    public:
+        /**
+         * @brief Constructor
+         * @param particleCount Particle count
+         *
+         * Expects that @p particleCount is not zero.
+         */
+        explicit ParticleSystem(UnsignedInt particleCount);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL objects
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit ParticleSystem(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ParticleSystem(const ParticleSystem&) = delete;
+
+        /** @brief Move constructor */
+        ParticleSystem(ParticleSystem&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+        /** @brief Move assignment */
+        ParticleSystem& operator=(ParticleSystem&&) noexcept = default;
+
+        /** @brief Particle count */
+        UnsignedInt particleCount() const { return _particleCount; }
+
+        /**
+         * @brief Buffer with the latest particle state
+         *
+         * Changes with every @ref update().
+         */
+        GL::Buffer& buffer() { return _buffers[_current]; }
+
+        /**
+         * @brief Mesh for rendering the latest particle state
+         *
+         * A @ref MeshPrimitive::Points mesh with @ref particleCount()
+         * vertices, having the @ref VertexColor3D::Position and
+         * @ref VertexColor3D::Color4 attributes. Changes with every
+         * @ref update(). Alpha blending has to be enabled for the particles
+         * that are not alive to be invisible.
+         */
+        GL::Mesh& mesh() { return _meshes[_current]; }
+
+        /**
+         * @brief Update the particles
+         * @return Reference to self (for method chaining)
+         *
+         * Draws the latest state with @p shader into the other buffer with
+         * @ref GL::Renderer::Feature::RasterizerDiscard enabled and then
+         * swaps the buffers.
+         */
+        ParticleSystem& update(ParticleUpdate& shader);
+
+    private:
+        UnsignedInt _particleCount{}, _current{};
+        GL::Buffer _buffers[2];
+        GL::Mesh _updateMeshes[2];
+        GL::Mesh _meshes[2];
+        GL::TransformFeedback _feedbacks[2];
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
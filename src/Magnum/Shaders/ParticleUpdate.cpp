@@ -0,0 +1,153 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ParticleUpdate.h"
+
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/Math/Color.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+ParticleUpdate::ParticleUpdate(const UnsignedInt emitterCount): _emitterCount{emitterCount} {
+    CORRADE_ASSERT(emitterCount && emitterCount <= MaxEmitterCount,
+        "Shaders::ParticleUpdate: expected 1 to" << UnsignedInt(MaxEmitterCount) << "emitters but got" << emitterCount, );
+
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::transform_feedback);
+    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    /* OpenGL ES needs a fragment shader for the program to link, even though
+       nothing gets rasterized */
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(Utility::formatString("#define EMITTER_COUNT {}\n", emitterCount))
+        .addSource(rs.get("ParticleUpdate.vert"));
+    frag.addSource("void main() {}\n");
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    /* ES3 has this done in the shader directly */
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version)) {
+        bindAttributeLocation(PositionAge::Location, "positionAge");
+        bindAttributeLocation(VelocityLifetime::Location, "velocityLifetime");
+    }
+    #endif
+
+    /* All outputs interleaved in a single buffer, so the output can be used
+       directly as an input for the next update */
+    setTransformFeedbackOutputs({"outPositionAge", "outVelocityLifetime", "outColor"}, TransformFeedbackBufferMode::InterleavedAttributes);
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    _timeDeltaUniform = uniformLocation("timeDelta");
+    _seedUniform = uniformLocation("seed");
+    _accelerationUniform = uniformLocation("acceleration");
+    _startColorUniform = uniformLocation("startColor");
+    _endColorUniform = uniformLocation("endColor");
+    _emitterPositionsUniform = uniformLocation("emitterPositions");
+    _emitterVelocitiesUniform = uniformLocation("emitterVelocities");
+    _emitterVelocitySpreadsUniform = uniformLocation("emitterVelocitySpreads");
+    _emitterLifetimesUniform = uniformLocation("emitterLifetimes");
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code
+       itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setStartColor(Color4{1.0f});
+    setEndColor(Color4{1.0f});
+    #endif
+}
+
+ParticleUpdate& ParticleUpdate::setTimeDelta(const Float timeDelta) {
+    setUniform(_timeDeltaUniform, timeDelta);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setSeed(const UnsignedInt seed) {
+    setUniform(_seedUniform, seed);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setAcceleration(const Vector3& acceleration) {
+    setUniform(_accelerationUniform, acceleration);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setStartColor(const Color4& color) {
+    setUniform(_startColorUniform, color);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setEndColor(const Color4& color) {
+    setUniform(_endColorUniform, color);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setEmitterPosition(const UnsignedInt id, const Vector3& position) {
+    CORRADE_ASSERT(id < _emitterCount,
+        "Shaders::ParticleUpdate::setEmitterPosition(): emitter ID" << id << "is out of bounds for" << _emitterCount << "emitters", *this);
+    setUniform(_emitterPositionsUniform + id, position);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setEmitterVelocity(const UnsignedInt id, const Vector3& velocity, const Float spread) {
+    CORRADE_ASSERT(id < _emitterCount,
+        "Shaders::ParticleUpdate::setEmitterVelocity(): emitter ID" << id << "is out of bounds for" << _emitterCount << "emitters", *this);
+    setUniform(_emitterVelocitiesUniform + id, velocity);
+    setUniform(_emitterVelocitySpreadsUniform + id, spread);
+    return *this;
+}
+
+ParticleUpdate& ParticleUpdate::setEmitterLifetime(const UnsignedInt id, const Float lifetime) {
+    CORRADE_ASSERT(id < _emitterCount,
+        "Shaders::ParticleUpdate::setEmitterLifetime(): emitter ID" << id << "is out of bounds for" << _emitterCount << "emitters", *this);
+    CORRADE_ASSERT(lifetime >= 0.0f,
+        "Shaders::ParticleUpdate::setEmitterLifetime(): expected a non-negative lifetime but got" << lifetime, *this);
+    setUniform(_emitterLifetimesUniform + id, lifetime);
+    return *this;
+}
+
+}}
@@ -0,0 +1,266 @@
+#ifndef Magnum_Shaders_ParticleUpdate_h
+#define Magnum_Shaders_ParticleUpdate_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ParticleUpdate
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Particle update shader
+@m_since_latest
+
+Simulates particles on the GPU using transform feedback. Each particle is a
+single vertex with the position, age, velocity and lifetime stored in the
+@ref PositionAge and @ref VelocityLifetime attributes. Drawing them as
+@ref MeshPrimitive::Points with rasterization disabled writes the updated
+state together with a color to a single interleaved transform feedback
+buffer at index @ref Output, in the following layout, 48 bytes per
+particle:
+
+@code{.cpp}
+struct Particle {
+    Vector4 positionAge;
+    Vector4 velocityLifetime;
+    Color4 color;
+};
+@endcode
+
+The output buffer is then used as the input for the next update and, with the
+position and color attributes, for rendering with @ref VertexColor3D. Since
+the input and output can't be the same buffer, two buffers are used in a
+ping-pong fashion. Apart from uniform updates, the whole simulation stays on
+the GPU. The @ref ParticleSystem class wraps the buffers, meshes and transform
+feedback objects needed for that, see its documentation for an usage example.
+
+@section Shaders-ParticleUpdate-emitters Emitters and lifetimes
+
+Particles are emitted from up to @ref MaxEmitterCount emitters, the particle
+at index @f$ i @f$ belonging to emitter @f$ i \bmod n @f$ where @f$ n @f$
+is @ref emitterCount(). An emitter is described by its position, base
+velocity, a velocity spread, which is a maximal random offset added to each
+velocity component, and a lifetime of the particles it emits. Emitters have a
+zero lifetime by default, which means they're disabled.
+
+A zero-initialized particle is treated as not spawned yet. When its emitter
+is enabled, the particle is scheduled to spawn after a random delay shorter
+than the emitter lifetime, so the particles are spread evenly over time
+instead of bursting out all at once. After its lifetime elapses, the particle
+is immediately respawned at the current emitter position, or returned back to
+the initial state if the emitter got disabled meanwhile. Each emitter thus
+continuously emits @f$ \frac{p}{n l} @f$ particles per second, where @f$ p @f$
+is the total count of particles and @f$ l @f$ the emitter lifetime.
+
+Alive particles are integrated with a constant acceleration set via
+@ref setAcceleration() and their color is interpolated from
+@ref setStartColor() to @ref setEndColor() over their lifetime. Particles that
+are not alive get a fully transparent color, so with blending enabled they
+can be drawn together with alive particles without any CPU readback of the
+alive count.
+
+Random numbers for spawn delays and velocities are derived from the particle
+index and a seed set via @ref setSeed(), which should be different for every
+update.
+
+@requires_gl30 Extension @gl_extension{EXT,transform_feedback}
+@requires_gles30 Transform feedback is not available in OpenGL ES 2.0.
+@requires_webgl20 Transform feedback is not available in WebGL 1.0.
+*/
+class MAGNUM_SHADERS_EXPORT ParticleUpdate: public GL::AbstractShaderProgram {
+    public:
+        /**
+         * @brief Particle position and age
+         *
+         * @ref Magnum::Vector4 "Vector4", with the XYZ components being the
+         * position and W the age in seconds.
+         */
+        typedef GL::Attribute<0, Vector4> PositionAge;
+
+        /**
+         * @brief Particle velocity and lifetime
+         *
+         * @ref Magnum::Vector4 "Vector4", with the XYZ components being the
+         * velocity and W the lifetime in seconds.
+         */
+        typedef GL::Attribute<1, Vector4> VelocityLifetime;
+
+        enum: UnsignedInt {
+            /**
+             * Transform feedback buffer index to which the interleaved
+             * updated particle data are written.
+             */
+            Output = 0,
+
+            /** Max count of emitters */
+            MaxEmitterCount = 16
+        };
+
+        /**
+         * @brief Constructor
+         * @param emitterCount  Count of emitters
+         *
+         * Expects that @p emitterCount is at least @cpp 1 @ce and at most
+         * @ref MaxEmitterCount.
+         */
+        explicit ParticleUpdate(UnsignedInt emitterCount = 1);
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit ParticleUpdate(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        ParticleUpdate(const ParticleUpdate&) = delete;
+
+        /** @brief Move constructor */
+        ParticleUpdate(ParticleUpdate&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        ParticleUpdate& operator=(const ParticleUpdate&) = delete;
+
+        /** @brief Move assignment */
+        ParticleUpdate& operator=(ParticleUpdate&&) noexcept = default;
+
+        /** @brief Emitter count */
+        UnsignedInt emitterCount() const { return _emitterCount; }
+
+        /**
+         * @brief Set time delta
+         * @return Reference to self (for method chaining)
+         *
+         * Time in seconds by which the particles are advanced in the next
+         * update. Initial value is @cpp 0.0f @ce.
+         */
+        ParticleUpdate& setTimeDelta(Float timeDelta);
+
+        /**
+         * @brief Set random seed
+         * @return Reference to self (for method chaining)
+         *
+         * Should be different for every update, such as a frame counter,
+         * otherwise particles respawned in different updates get the same
+         * velocity offsets. Initial value is @cpp 0 @ce.
+         */
+        ParticleUpdate& setSeed(UnsignedInt seed);
+
+        /**
+         * @brief Set acceleration
+         * @return Reference to self (for method chaining)
+         *
+         * Constant acceleration applied to all alive particles, such as
+         * gravity. Initial value is a zero vector.
+         */
+        ParticleUpdate& setAcceleration(const Vector3& acceleration);
+
+        /**
+         * @brief Set start color
+         * @return Reference to self (for method chaining)
+         *
+         * Color of a particle right after it spawns. Initial value is
+         * @cpp 0xffffffff_rgbaf @ce.
+         * @see @ref setEndColor()
+         */
+        ParticleUpdate& setStartColor(const Color4& color);
+
+        /**
+         * @brief Set end color
+         * @return Reference to self (for method chaining)
+         *
+         * Color of a particle at the end of its lifetime, the color is
+         * linearly interpolated between @ref setStartColor() and this value.
+         * Initial value is @cpp 0xffffffff_rgbaf @ce.
+         */
+        ParticleUpdate& setEndColor(const Color4& color);
+
+        /**
+         * @brief Set emitter position
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p id is less than @ref emitterCount(). Initial value
+         * is a zero vector.
+         */
+        ParticleUpdate& setEmitterPosition(UnsignedInt id, const Vector3& position);
+
+        /**
+         * @brief Set emitter velocity
+         * @return Reference to self (for method chaining)
+         *
+         * Each spawned particle gets @p velocity with each component offset
+         * by a random value in the @f$ [-s, s] @f$ range, where @f$ s @f$ is
+         * @p spread. Expects that @p id is less than @ref emitterCount().
+         * Initial value is a zero vector and a zero spread.
+         */
+        ParticleUpdate& setEmitterVelocity(UnsignedInt id, const Vector3& velocity, Float spread = 0.0f);
+
+        /**
+         * @brief Set emitter particle lifetime
+         * @return Reference to self (for method chaining)
+         *
+         * Lifetime of particles emitted by given emitter in seconds. Setting
+         * it to @cpp 0.0f @ce disables the emitter, particles that are alive
+         * live out their lifetime but aren't respawned. Expects that @p id is
+         * less than @ref emitterCount() and @p lifetime is not negative.
+         * Initial value is @cpp 0.0f @ce.
+         */
+        ParticleUpdate& setEmitterLifetime(UnsignedInt id, Float lifetime);
+
+    private:
+        UnsignedInt _emitterCount{};
+        Int _timeDeltaUniform{},
+            _seedUniform{},
+            _accelerationUniform{},
+            _startColorUniform{},
+            _endColorUniform{},
+            _emitterPositionsUniform{},
+            _emitterVelocitiesUniform{},
+            _emitterVelocitySpreadsUniform{},
+            _emitterLifetimesUniform{};
+};
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
@@ -0,0 +1,145 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Uniforms */
+
+uniform highp float timeDelta; /* defaults to zero */
+
+uniform highp uint seed; /* defaults to zero */
+
+uniform highp vec3 acceleration; /* defaults to zero */
+
+uniform lowp vec4 startColor
+    #ifndef GL_ES
+    = vec4(1.0)
+    #endif
+    ;
+
+uniform lowp vec4 endColor
+    #ifndef GL_ES
+    = vec4(1.0)
+    #endif
+    ;
+
+uniform highp vec3 emitterPositions[EMITTER_COUNT]; /* defaults to zero */
+uniform highp vec3 emitterVelocities[EMITTER_COUNT]; /* defaults to zero */
+uniform highp float emitterVelocitySpreads[EMITTER_COUNT]; /* defaults to zero */
+/* Zero lifetime means the emitter is disabled, which is the default */
+uniform highp float emitterLifetimes[EMITTER_COUNT];
+
+/* Inputs */
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 0)
+#endif
+in highp vec4 positionAge;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = 1)
+#endif
+in highp vec4 velocityLifetime;
+
+/* Outputs, captured with transform feedback into a single interleaved buffer */
+
+out highp vec4 outPositionAge;
+out highp vec4 outVelocityLifetime;
+out lowp vec4 outColor;
+
+/* Integer hash from https://nullprogram.com/blog/2018/07/31/ */
+highp uint hash(highp uint x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/* Random number in the (0, 1] range */
+highp float random(inout highp uint state) {
+    state = hash(state);
+    return (float(state >> 8) + 1.0)/16777216.0;
+}
+
+void main() {
+    highp vec3 position = positionAge.xyz;
+    highp float age = positionAge.w + timeDelta;
+    highp vec3 velocity = velocityLifetime.xyz;
+    highp float lifetime = velocityLifetime.w;
+
+    highp uint id = uint(gl_VertexID);
+    int emitter = int(id % uint(EMITTER_COUNT));
+    highp float emitterLifetime = emitterLifetimes[emitter];
+    highp uint state = hash(id ^ hash(seed));
+
+    bool spawn = false;
+
+    /* Never spawned yet. If the emitter is enabled, delay the spawn by a
+       random fraction of the emitter lifetime so the particles are emitted
+       evenly instead of all bursting out at once. */
+    if(lifetime == 0.0) {
+        if(emitterLifetime > 0.0) {
+            age = -random(state)*emitterLifetime;
+            lifetime = emitterLifetime;
+        } else age = 0.0;
+
+    /* Spawn delay elapsed */
+    } else if(positionAge.w < 0.0 && age >= 0.0) {
+        spawn = true;
+
+    /* Lifetime elapsed. Respawn if the emitter is still enabled, otherwise
+       go back to the initial state. */
+    } else if(age >= lifetime) {
+        if(emitterLifetime > 0.0) spawn = true;
+        else {
+            age = 0.0;
+            lifetime = 0.0;
+        }
+
+    /* Alive, integrate */
+    } else if(age >= 0.0) {
+        velocity += acceleration*timeDelta;
+        position += velocity*timeDelta;
+    }
+
+    if(spawn) {
+        /* Keep the time overshoot so the emission rate is independent of the
+           time step */
+        age = mod(age, emitterLifetime);
+        lifetime = emitterLifetime;
+        position = emitterPositions[emitter];
+        velocity = emitterVelocities[emitter] + emitterVelocitySpreads[emitter]*
+            (vec3(random(state), random(state), random(state))*2.0 - vec3(1.0));
+    }
+
+    outPositionAge = vec4(position, age);
+    outVelocityLifetime = vec4(velocity, lifetime);
+    /* Particles that are not alive are fully transparent */
+    outColor = age >= 0.0 && age < lifetime ?
+        mix(startColor, endColor, age/lifetime) : vec4(0.0);
+
+    /* Not rasterized, but the output has to be written anyway */
+    gl_Position = vec4(0.0, 0.0, 0.0, 1.0);
+}
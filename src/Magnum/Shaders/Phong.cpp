@@ -25,6 +25,7 @@
 
 #include "Phong.h"
 
+#include <cmath>
 #if defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_BUILD_DEPRECATED)
 #include <Corrade/Containers/Array.h>
 #endif
@@ -37,10 +38,19 @@
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #include "Magnum/GL/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Range.h"
+#endif
 
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
 
@@ -51,13 +61,68 @@ namespace {
         AmbientTextureUnit = 0,
         DiffuseTextureUnit = 1,
         SpecularTextureUnit = 2,
-        NormalTextureUnit = 3
+        NormalTextureUnit = 3,
+        #ifndef MAGNUM_TARGET_GLES2
+        LightClusterTextureUnit = 4,
+        LightClusterIndexTextureUnit = 5
+        #endif
     };
+
+    #ifndef MAGNUM_TARGET_GLES2
+    enum: Int {
+        ProjectionBufferBinding = 0,
+        TransformationBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4,
+        LightBufferBinding = 5,
+        JointBufferBinding = 6,
+        #ifndef MAGNUM_TARGET_GLES
+        TextureHandleBufferBinding = 7
+        #endif
+    };
+
+    enum: UnsignedInt { MultiviewViewCount = 2 };
+    #endif
 }
 
-Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _lightCount{lightCount}, _lightColorsUniform{_lightPositionsUniform + Int(lightCount)}, _lightSpecularColorsUniform{_lightPositionsUniform + 2*Int(lightCount)}, _lightRangesUniform{_lightPositionsUniform + 3*Int(lightCount)} {
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt lightCount
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount, const UnsignedInt jointCount
+    #endif
+) {
     CORRADE_ASSERT(!(flags & Flag::TextureTransformation) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture)),
-        "Shaders::Phong: texture transformation enabled but the shader is not textured", );
+        "Shaders::Phong: texture transformation enabled but the shader is not textured", CompileState{NoCreate});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Phong: material count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Phong: draw count can't be zero", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags >= Flag::ClusteredLights) || lightCount,
+        "Shaders::Phong: light count can't be zero with clustered lights", CompileState{NoCreate});
+    CORRADE_ASSERT(!(flags & Flag::Multiview) || !(flags >= Flag::UniformBuffers),
+        "Shaders::Phong: multiview can't be combined with uniform buffers", CompileState{NoCreate});
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(flags >= Flag::BindlessTextures) || (flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture)),
+        "Shaders::Phong: bindless textures enabled but the shader is not textured", CompileState{NoCreate});
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::OVR::multiview2);
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    if(flags >= Flag::MultiDraw)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::shader_draw_parameters);
+    if(flags >= Flag::ClusteredLights)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::EXT::texture_integer);
+    if(flags >= Flag::BindlessTextures)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::bindless_texture);
+    #endif
 
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
@@ -67,7 +132,10 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     Utility::Resource rs("MagnumShaders");
 
     #ifndef MAGNUM_TARGET_GLES
-    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
+    /* ARB_bindless_texture is written against GLSL 4.00, which is available
+       on every implementation supporting the extension */
+    const GL::Version version = flags >= Flag::BindlessTextures ? GL::Version::GL400 :
+        GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300, GL::Version::GL210});
     #else
     const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GLES300, GL::Version::GLES200});
     #endif
@@ -77,7 +145,8 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
 
     #ifndef MAGNUM_TARGET_GLES
     std::string lightInitializerVertex, lightInitializerFragment;
-    if(lightCount) {
+    /* With uniform buffers the initial values come from the buffer */
+    if(lightCount && !(flags >= Flag::UniformBuffers)) {
         using namespace Containers::Literals;
 
         /* Initializer for the light color / position / range arrays -- we need
@@ -124,11 +193,37 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         lightInitializerFragment[lightInitializerFragment.size() - 2] = '\n';
         lightInitializerFragment.resize(lightInitializerFragment.size() - 1);
     }
+
+    /* Same for joint matrices, all being identity */
+    std::string jointInitializer;
+    if(jointCount && !(flags >= Flag::UniformBuffers)) {
+        using namespace Containers::Literals;
+
+        constexpr Containers::StringView jointMatrixInitializerPreamble = "#define JOINT_MATRIX_INITIALIZER "_s;
+        constexpr Containers::StringView jointMatrixInitializerItem = "mat4(1.0), "_s;
+
+        jointInitializer.reserve(
+            jointMatrixInitializerPreamble.size() +
+            jointCount*jointMatrixInitializerItem.size());
+
+        jointInitializer.append(jointMatrixInitializerPreamble.data(), jointMatrixInitializerPreamble.size());
+        for(std::size_t i = 0; i != jointCount; ++i)
+            jointInitializer.append(jointMatrixInitializerItem.data(), jointMatrixInitializerItem.size());
+
+        /* Drop the last comma and add a newline at the end */
+        jointInitializer[jointInitializer.size() - 2] = '\n';
+        jointInitializer.resize(jointInitializer.size() - 1);
+    }
     #endif
 
+    /* Light uniforms start at this location, joint matrices are after all
+       light arrays */
+    const Int lightPositionsUniform = Phong{NoCreate}._lightPositionsUniform;
+
     vert.addSource(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture) ? "#define TEXTURED\n" : "")
         .addSource(flags & Flag::NormalTexture ? "#define NORMAL_TEXTURE\n" : "")
         .addSource(flags & Flag::Bitangent ? "#define BITANGENT\n" : "")
+        .addSource(flags & Flag::OctahedralNormals ? "#define OCTAHEDRAL_NORMALS\n" : "")
         .addSource(flags & Flag::VertexColor ? "#define VERTEX_COLOR\n" : "")
         .addSource(flags & Flag::TextureTransformation ? "#define TEXTURE_TRANSFORMATION\n" : "")
         .addSource(Utility::formatString("#define LIGHT_COUNT {}\n", lightCount))
@@ -137,11 +232,34 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
         #endif
         .addSource(flags & Flag::InstancedTransformation ? "#define INSTANCED_TRANSFORMATION\n" : "")
         .addSource(flags >= Flag::InstancedTextureOffset ? "#define INSTANCED_TEXTURE_OFFSET\n" : "");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(jointCount) vert.addSource(Utility::formatString(
+        "#define JOINT_COUNT {}\n"
+        "#define JOINT_MATRICES_LOCATION {}\n",
+        jointCount,
+        lightPositionsUniform + 4*lightCount));
+    if(flags & Flag::Multiview) vert.addSource(Utility::formatString(
+        "#define MULTIVIEW\n"
+        "#define VIEW_COUNT {}\n",
+        UnsignedInt(MultiviewViewCount)));
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        #ifndef MAGNUM_TARGET_GLES
+        vert.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "");
+        #endif
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) vert.addSource(std::move(lightInitializerVertex));
+    if(!lightInitializerVertex.empty()) vert.addSource(std::move(lightInitializerVertex));
+    if(!jointInitializer.empty()) vert.addSource(std::move(jointInitializer));
     #endif
-    vert.addSource(rs.get("generic.glsl"))
-        .addSource(rs.get("Phong.vert"));
+    vert.addSource(rs.get("generic.glsl"));
+    if(flags & Flag::OctahedralNormals)
+        vert.addSource(rs.get("octahedral.glsl"));
+    vert.addSource(rs.get("Phong.vert"));
     frag.addSource(flags & Flag::AmbientTexture ? "#define AMBIENT_TEXTURE\n" : "")
         .addSource(flags & Flag::DiffuseTexture ? "#define DIFFUSE_TEXTURE\n" : "")
         .addSource(flags & Flag::SpecularTexture ? "#define SPECULAR_TEXTURE\n" : "")
@@ -159,18 +277,61 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
             "#define LIGHT_SPECULAR_COLORS_LOCATION {}\n"
             "#define LIGHT_RANGES_LOCATION {}\n",
             lightCount,
-            _lightPositionsUniform + lightCount,
-            _lightPositionsUniform + 2*lightCount,
-            _lightPositionsUniform + 3*lightCount));
+            lightPositionsUniform + lightCount,
+            lightPositionsUniform + 2*lightCount,
+            lightPositionsUniform + 3*lightCount));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        frag.addSource(flags >= Flag::ClusteredLights ? "#define CLUSTERED_LIGHTS\n" : "");
+        #ifndef MAGNUM_TARGET_GLES
+        frag.addSource(flags >= Flag::MultiDraw ? "#define MULTI_DRAW\n" : "")
+            .addSource(flags >= Flag::BindlessTextures ? "#define BINDLESS_TEXTURES\n" : "");
+        #endif
+    }
+    #endif
     #ifndef MAGNUM_TARGET_GLES
-    if(lightCount) frag.addSource(std::move(lightInitializerFragment));
+    if(!lightInitializerFragment.empty()) frag.addSource(std::move(lightInitializerFragment));
     #endif
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Phong.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+    Phong out{NoInit};
+    out._flags = flags;
+    out._lightCount = lightCount;
+    #ifndef MAGNUM_TARGET_GLES2
+    out._materialCount = materialCount;
+    out._drawCount = drawCount;
+    out._jointCount = jointCount;
+    #endif
+    out._lightColorsUniform = out._lightPositionsUniform + Int(lightCount);
+    out._lightSpecularColorsUniform = out._lightPositionsUniform + 2*Int(lightCount);
+    out._lightRangesUniform = out._lightPositionsUniform + 3*Int(lightCount);
+    #ifndef MAGNUM_TARGET_GLES2
+    out._jointMatricesUniform = out._lightPositionsUniform + 4*Int(lightCount);
+    #endif
+
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached, the
+       shaders are then not needed anymore */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(cache && cache->load(out, cacheKey)) {
+        CompileState state{std::move(out), GL::Shader{NoCreate}, GL::Shader{NoCreate}, version};
+        state._cacheKey = std::move(cacheKey);
+        return state;
+    }
+    #endif
+
+    vert.submitCompile();
+    frag.submitCompile();
 
-    attachShaders({vert, frag});
+    out.attachShaders({vert, frag});
 
     /* ES3 has this done in the shader directly and doesn't even provide
        bindFragmentDataLocation() */
@@ -179,103 +340,239 @@ Phong::Phong(const Flags flags, const UnsignedInt lightCount): _flags{flags}, _l
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
+        out.bindAttributeLocation(Position::Location, "position");
         if(lightCount)
-            bindAttributeLocation(Normal::Location, "normal");
+            out.bindAttributeLocation(Normal::Location, "normal");
         if((flags & Flag::NormalTexture) && lightCount) {
-            bindAttributeLocation(Tangent::Location, "tangent");
+            out.bindAttributeLocation(Tangent::Location, "tangent");
             if(flags & Flag::Bitangent)
-                bindAttributeLocation(Bitangent::Location, "bitangent");
+                out.bindAttributeLocation(Bitangent::Location, "bitangent");
         }
         if(flags & Flag::VertexColor)
-            bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
+            out.bindAttributeLocation(Color3::Location, "vertexColor"); /* Color4 is the same */
         if(flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture))
-            bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
+            out.bindAttributeLocation(TextureCoordinates::Location, "textureCoordinates");
         #ifndef MAGNUM_TARGET_GLES2
         if(flags & Flag::ObjectId) {
-            bindFragmentDataLocation(ColorOutput, "color");
-            bindFragmentDataLocation(ObjectIdOutput, "objectId");
+            out.bindFragmentDataLocation(ColorOutput, "color");
+            out.bindFragmentDataLocation(ObjectIdOutput, "objectId");
         }
         if(flags >= Flag::InstancedObjectId)
-            bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+            out.bindAttributeLocation(ObjectId::Location, "instanceObjectId");
+        if(jointCount) {
+            out.bindAttributeLocation(Weights::Location, "weights");
+            out.bindAttributeLocation(JointIds::Location, "jointIds");
+        }
         #endif
         if(flags & Flag::InstancedTransformation)
-            bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
+            out.bindAttributeLocation(TransformationMatrix::Location, "instancedTransformationMatrix");
         if(flags >= Flag::InstancedTextureOffset)
-            bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
+            out.bindAttributeLocation(TextureOffset::Location, "instancedTextureOffset");
     }
     #endif
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+    out.submitLink();
+
+    CompileState state{std::move(out), std::move(vert), std::move(frag), version};
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    state._cacheKey = std::move(cacheKey);
+    #endif
+    return state;
+}
+
+Phong::Phong(CompileState&& state): Phong{static_cast<Phong&&>(std::move(state))} {
+    #ifdef CORRADE_GRACEFUL_ASSERT
+    /* When graceful assertions fire from within compile(), we get a NoCreate'd
+       CompileState. Exiting so we don't crash. */
+    if(!id()) return;
+    #endif
+
+    /* Shaders are empty if the program was loaded from the binary cache */
+    if(state._vert.id()) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::checkCompile({state._vert, state._frag}));
+        CORRADE_INTERNAL_ASSERT_OUTPUT(checkLink());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache())
+            cache->save(*this, state._cacheKey);
+        #endif
+    }
+
+    const Flags flags = _flags;
+    const UnsignedInt lightCount = _lightCount;
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = state._version;
+    #endif
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationMatrixUniform = uniformLocation("transformationMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = uniformLocation("textureMatrix");
-        _projectionMatrixUniform = uniformLocation("projectionMatrix");
-        _ambientColorUniform = uniformLocation("ambientColor");
-        if(lightCount) {
-            _normalMatrixUniform = uniformLocation("normalMatrix");
-            _diffuseColorUniform = uniformLocation("diffuseColor");
-            _specularColorUniform = uniformLocation("specularColor");
-            _shininessUniform = uniformLocation("shininess");
-            if(flags & Flag::NormalTexture)
-                _normalTextureScaleUniform = uniformLocation("normalTextureScale");
-            _lightPositionsUniform = uniformLocation("lightPositions");
-            _lightColorsUniform = uniformLocation("lightColors");
-            _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
-            _lightRangesUniform = uniformLocation("lightRanges");
-        }
-        if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
         #ifndef MAGNUM_TARGET_GLES2
-        if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = uniformLocation("drawOffset");
+            if(flags >= Flag::ClusteredLights) {
+                _viewportSizeUniform = uniformLocation("viewportSize");
+                _lightClusterDepthScaleBiasUniform = uniformLocation("lightClusterDepthScaleBias");
+            }
+        } else
         #endif
+        {
+            _transformationMatrixUniform = uniformLocation("transformationMatrix");
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = uniformLocation("textureMatrix");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(!(flags & Flag::Multiview))
+            #endif
+            {
+                _projectionMatrixUniform = uniformLocation("projectionMatrix");
+            }
+            _ambientColorUniform = uniformLocation("ambientColor");
+            if(lightCount) {
+                _normalMatrixUniform = uniformLocation("normalMatrix");
+                _diffuseColorUniform = uniformLocation("diffuseColor");
+                _specularColorUniform = uniformLocation("specularColor");
+                _shininessUniform = uniformLocation("shininess");
+                if(flags & Flag::NormalTexture)
+                    _normalTextureScaleUniform = uniformLocation("normalTextureScale");
+                _lightPositionsUniform = uniformLocation("lightPositions");
+                _lightColorsUniform = uniformLocation("lightColors");
+                _lightSpecularColorsUniform = uniformLocation("lightSpecularColors");
+                _lightRangesUniform = uniformLocation("lightRanges");
+            }
+            if(flags & Flag::AlphaMask) _alphaMaskUniform = uniformLocation("alphaMask");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags & Flag::ObjectId) _objectIdUniform = uniformLocation("objectId");
+            if(_jointCount) _jointMatricesUniform = uniformLocation("jointMatrices");
+            #endif
+        }
     }
 
+    /* The per-view matrix array has no explicit location as it'd occupy
+       more than one, query it always */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        _projectionMatrixUniform = uniformLocation("projectionMatrices");
+    #endif
+
     #ifndef MAGNUM_TARGET_GLES
-    if(flags && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    if((flags
+        #ifndef MAGNUM_TARGET_GLES2
+        || _jointCount
+        #endif
+        ) && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
     #endif
     {
-        if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
-        if(lightCount) {
-            if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
-            if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
-            if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+        /* With bindless textures there are no sampler uniforms */
+        #ifndef MAGNUM_TARGET_GLES
+        if(!(flags >= Flag::BindlessTextures))
+        #endif
+        {
+            if(flags & Flag::AmbientTexture) setUniform(uniformLocation("ambientTexture"), AmbientTextureUnit);
+            if(lightCount) {
+                if(flags & Flag::DiffuseTexture) setUniform(uniformLocation("diffuseTexture"), DiffuseTextureUnit);
+                if(flags & Flag::SpecularTexture) setUniform(uniformLocation("specularTexture"), SpecularTextureUnit);
+                if(flags & Flag::NormalTexture) setUniform(uniformLocation("normalTexture"), NormalTextureUnit);
+            }
         }
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            setUniformBlockBinding(uniformBlockIndex("Projection"), ProjectionBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Transformation"), TransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(flags & Flag::TextureTransformation)
+                setUniformBlockBinding(uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            setUniformBlockBinding(uniformBlockIndex("Material"), MaterialBufferBinding);
+            if(lightCount)
+                setUniformBlockBinding(uniformBlockIndex("Light"), LightBufferBinding);
+            if(_jointCount)
+                setUniformBlockBinding(uniformBlockIndex("Joint"), JointBufferBinding);
+            #ifndef MAGNUM_TARGET_GLES
+            if(flags >= Flag::BindlessTextures)
+                setUniformBlockBinding(uniformBlockIndex("TextureHandle"), TextureHandleBufferBinding);
+            #endif
+        }
+        if(flags >= Flag::ClusteredLights) {
+            setUniform(uniformLocation("lightClusterTexture"), LightClusterTextureUnit);
+            setUniform(uniformLocation("lightClusterIndexTexture"), LightClusterIndexTextureUnit);
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    /* Default to fully opaque white so we can see the textures */
-    if(flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
-    else setAmbientColor(Magnum::Color4{0.0f});
-    setTransformationMatrix(Matrix4{Math::IdentityInit});
-    setProjectionMatrix(Matrix4{Math::IdentityInit});
-    if(lightCount) {
-        setDiffuseColor(Magnum::Color4{1.0f});
-        setSpecularColor(Magnum::Color4{1.0f, 0.0f});
-        setShininess(80.0f);
-        if(flags & Flag::NormalTexture)
-            setNormalTextureScale(1.0f);
-        setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
-        Containers::Array<Magnum::Color3> colors{Containers::DirectInit, lightCount, Magnum::Color3{1.0f}};
-        setLightColors(colors);
-        setLightSpecularColors(colors);
-        setLightRanges(Containers::Array<Float>{Containers::DirectInit, lightCount, Constants::inf()});
-        /* Light position is zero by default */
-        setNormalMatrix(Matrix3x3{Math::IdentityInit});
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        /* Default to fully opaque white so we can see the textures */
+        if(flags & Flag::AmbientTexture) setAmbientColor(Magnum::Color4{1.0f});
+        else setAmbientColor(Magnum::Color4{0.0f});
+        setTransformationMatrix(Matrix4{Math::IdentityInit});
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags & Flag::Multiview)
+            setProjectionMatrices({Matrix4{Math::IdentityInit}, Matrix4{Math::IdentityInit}});
+        else
+        #endif
+        {
+            setProjectionMatrix(Matrix4{Math::IdentityInit});
+        }
+        if(lightCount) {
+            setDiffuseColor(Magnum::Color4{1.0f});
+            setSpecularColor(Magnum::Color4{1.0f, 0.0f});
+            setShininess(80.0f);
+            if(flags & Flag::NormalTexture)
+                setNormalTextureScale(1.0f);
+            setLightPositions(Containers::Array<Vector4>{Containers::DirectInit, lightCount, Vector4{0.0f, 0.0f, 1.0f, 0.0f}});
+            Containers::Array<Magnum::Color3> colors{Containers::DirectInit, lightCount, Magnum::Color3{1.0f}};
+            setLightColors(colors);
+            setLightSpecularColors(colors);
+            setLightRanges(Containers::Array<Float>{Containers::DirectInit, lightCount, Constants::inf()});
+            /* Light position is zero by default */
+            setNormalMatrix(Matrix3x3{Math::IdentityInit});
+        }
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
+        /* Object ID is zero by default */
+        #ifndef MAGNUM_TARGET_GLES2
+        if(_jointCount) setJointMatrices(Containers::Array<Matrix4>{Containers::DirectInit, _jointCount, Math::IdentityInit});
+        #endif
     }
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    if(flags & Flag::AlphaMask) setAlphaMask(0.5f);
-    /* Object ID is zero by default */
     #endif
 }
 
+Phong::Phong(const Flags flags, const UnsignedInt lightCount
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount, const UnsignedInt jointCount
+    #endif
+): Phong{compile(flags, lightCount
+    #ifndef MAGNUM_TARGET_GLES2
+    , materialCount, drawCount, jointCount
+    #endif
+)} {}
+
+#ifndef MAGNUM_TARGET_GLES2
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt lightCount) {
+    return compile(flags, lightCount, 1, 1, 0);
+}
+
+Phong::CompileState Phong::compile(const Flags flags, const UnsignedInt lightCount, const UnsignedInt materialCount, const UnsignedInt drawCount) {
+    return compile(flags, lightCount, materialCount, drawCount, 0);
+}
+
+Phong::Phong(const Flags flags, const UnsignedInt lightCount): Phong{flags, lightCount, 1, 1, 0} {}
+
+Phong::Phong(const Flags flags, const UnsignedInt lightCount, const UnsignedInt materialCount, const UnsignedInt drawCount): Phong{flags, lightCount, materialCount, drawCount, 0} {}
+#endif
+
 Phong& Phong::setAmbientColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_ambientColorUniform, color);
     return *this;
 }
@@ -283,11 +580,19 @@ Phong& Phong::setAmbientColor(const Magnum::Color4& color) {
 Phong& Phong::bindAmbientTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::AmbientTexture,
         "Shaders::Phong::bindAmbientTexture(): the shader was not created with ambient texture enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Phong::bindAmbientTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     texture.bind(AmbientTextureUnit);
     return *this;
 }
 
 Phong& Phong::setDiffuseColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_diffuseColorUniform, color);
     return *this;
 }
@@ -295,11 +600,19 @@ Phong& Phong::setDiffuseColor(const Magnum::Color4& color) {
 Phong& Phong::bindDiffuseTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::DiffuseTexture,
         "Shaders::Phong::bindDiffuseTexture(): the shader was not created with diffuse texture enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Phong::bindDiffuseTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     if(_lightCount) texture.bind(DiffuseTextureUnit);
     return *this;
 }
 
 Phong& Phong::setSpecularColor(const Magnum::Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_specularColorUniform, color);
     return *this;
 }
@@ -307,6 +620,10 @@ Phong& Phong::setSpecularColor(const Magnum::Color4& color) {
 Phong& Phong::bindSpecularTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::SpecularTexture,
         "Shaders::Phong::bindSpecularTexture(): the shader was not created with specular texture enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Phong::bindSpecularTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     if(_lightCount) texture.bind(SpecularTextureUnit);
     return *this;
 }
@@ -314,6 +631,10 @@ Phong& Phong::bindSpecularTexture(GL::Texture2D& texture) {
 Phong& Phong::bindNormalTexture(GL::Texture2D& texture) {
     CORRADE_ASSERT(_flags & Flag::NormalTexture,
         "Shaders::Phong::bindNormalTexture(): the shader was not created with normal texture enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Phong::bindNormalTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     if(_lightCount) texture.bind(NormalTextureUnit);
     return *this;
 }
@@ -321,16 +642,28 @@ Phong& Phong::bindNormalTexture(GL::Texture2D& texture) {
 Phong& Phong::bindTextures(GL::Texture2D* ambient, GL::Texture2D* diffuse, GL::Texture2D* specular, GL::Texture2D* normal) {
     CORRADE_ASSERT(_flags & (Flag::AmbientTexture|Flag::DiffuseTexture|Flag::SpecularTexture|Flag::NormalTexture),
         "Shaders::Phong::bindTextures(): the shader was not created with any textures enabled", *this);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_ASSERT(!(_flags >= Flag::BindlessTextures),
+        "Shaders::Phong::bindTextures(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead", *this);
+    #endif
     GL::AbstractTexture::bind(AmbientTextureUnit, {ambient, diffuse, specular, normal});
     return *this;
 }
 
 Phong& Phong::setShininess(Float shininess) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_shininessUniform, shininess);
     return *this;
 }
 
 Phong& Phong::setNormalTextureScale(const Float scale) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setNormalTextureScale(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::NormalTexture,
         "Shaders::Phong::setNormalTextureScale(): the shader was not created with normal texture enabled", *this);
     if(_lightCount) setUniform(_normalTextureScaleUniform, scale);
@@ -338,6 +671,10 @@ Phong& Phong::setNormalTextureScale(const Float scale) {
 }
 
 Phong& Phong::setAlphaMask(Float mask) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setAlphaMask(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::AlphaMask,
         "Shaders::Phong::setAlphaMask(): the shader was not created with alpha mask enabled", *this);
     setUniform(_alphaMaskUniform, mask);
@@ -346,29 +683,86 @@ Phong& Phong::setAlphaMask(Float mask) {
 
 #ifndef MAGNUM_TARGET_GLES2
 Phong& Phong::setObjectId(UnsignedInt id) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setObjectId(): the shader was created with uniform buffers enabled", *this);
     CORRADE_ASSERT(_flags & Flag::ObjectId,
         "Shaders::Phong::setObjectId(): the shader was not created with object ID enabled", *this);
     setUniform(_objectIdUniform, id);
     return *this;
 }
+
+Phong& Phong::setJointMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setJointMatrices(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(matrices.size() <= _jointCount,
+        "Shaders::Phong::setJointMatrices(): expected at most" << _jointCount << "items but got" << matrices.size(), *this);
+    if(!matrices.empty()) setUniform(_jointMatricesUniform, matrices);
+    return *this;
+}
+
+Phong& Phong::setJointMatrices(const std::initializer_list<Matrix4> matrices) {
+    return setJointMatrices(Containers::arrayView(matrices));
+}
+
+Phong& Phong::setJointMatrix(const UnsignedInt id, const Matrix4& matrix) {
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setJointMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(id < _jointCount,
+        "Shaders::Phong::setJointMatrix(): joint ID" << id << "is out of bounds for" << _jointCount << "joints", *this);
+    setUniform(_jointMatricesUniform + id, matrix);
+    return *this;
+}
 #endif
 
 Phong& Phong::setTransformationMatrix(const Matrix4& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     setUniform(_transformationMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setNormalMatrix(const Matrix3x3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     if(_lightCount) setUniform(_normalMatrixUniform, matrix);
     return *this;
 }
 
 Phong& Phong::setProjectionMatrix(const Matrix4& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(!(_flags & Flag::Multiview),
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with multiview enabled, use setProjectionMatrices() instead", *this);
+    #endif
     setUniform(_projectionMatrixUniform, matrix);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setProjectionMatrices(const Containers::ArrayView<const Matrix4> matrices) {
+    CORRADE_ASSERT(_flags & Flag::Multiview,
+        "Shaders::Phong::setProjectionMatrices(): the shader was not created with multiview enabled", *this);
+    CORRADE_ASSERT(matrices.size() == MultiviewViewCount,
+        "Shaders::Phong::setProjectionMatrices(): expected" << UnsignedInt(MultiviewViewCount) << "items but got" << matrices.size(), *this);
+    setUniform(_projectionMatrixUniform, matrices);
+    return *this;
+}
+
+Phong& Phong::setProjectionMatrices(const std::initializer_list<Matrix4> matrices) {
+    return setProjectionMatrices(Containers::arrayView(matrices));
+}
+#endif
+
 Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Phong::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     setUniform(_textureMatrixUniform, matrix);
@@ -376,6 +770,10 @@ Phong& Phong::setTextureMatrix(const Matrix3& matrix) {
 }
 
 Phong& Phong::setLightPositions(const Containers::ArrayView<const Vector4> positions) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightPositions(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == positions.size(),
         "Shaders::Phong::setLightPositions(): expected" << _lightCount << "items but got" << positions.size(), *this);
     if(_lightCount) setUniform(_lightPositionsUniform, positions);
@@ -405,6 +803,10 @@ Phong& Phong::setLightPositions(const std::initializer_list<Vector3> positions)
 #endif
 
 Phong& Phong::setLightPosition(const UnsignedInt id, const Vector4& position) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightPosition(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightPositionsUniform + id, position);
@@ -423,6 +825,10 @@ Phong& Phong::setLightPosition(const Vector3& position) {
 #endif
 
 Phong& Phong::setLightColors(const Containers::ArrayView<const Magnum::Color3> colors) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightColors(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
     if(_lightCount) setUniform(_lightColorsUniform, colors);
@@ -450,6 +856,10 @@ Phong& Phong::setLightColors(const std::initializer_list<Magnum::Color3> colors)
 }
 
 Phong& Phong::setLightColor(const UnsignedInt id, const Magnum::Color3& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightColorsUniform + id, color);
@@ -468,6 +878,10 @@ Phong& Phong::setLightColor(const Magnum::Color4& color) {
 #endif
 
 Phong& Phong::setLightSpecularColors(const Containers::ArrayView<const Magnum::Color3> colors) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightSpecularColors(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == colors.size(),
         "Shaders::Phong::setLightSpecularColors(): expected" << _lightCount << "items but got" << colors.size(), *this);
     if(_lightCount) setUniform(_lightSpecularColorsUniform, colors);
@@ -479,6 +893,10 @@ Phong& Phong::setLightSpecularColors(const std::initializer_list<Magnum::Color3>
 }
 
 Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightSpecularColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightSpecularColor(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightSpecularColorsUniform + id, color);
@@ -486,6 +904,10 @@ Phong& Phong::setLightSpecularColor(const UnsignedInt id, const Magnum::Color3&
 }
 
 Phong& Phong::setLightRanges(const Containers::ArrayView<const Float> ranges) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightRanges(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_lightCount == ranges.size(),
         "Shaders::Phong::setLightRanges(): expected" << _lightCount << "items but got" << ranges.size(), *this);
     if(_lightCount) setUniform(_lightRangesUniform, ranges);
@@ -497,12 +919,182 @@ Phong& Phong::setLightRanges(const std::initializer_list<Float> ranges) {
 }
 
 Phong& Phong::setLightRange(const UnsignedInt id, const Float range) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Phong::setLightRange(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(id < _lightCount,
         "Shaders::Phong::setLightRange(): light ID" << id << "is out of bounds for" << _lightCount << "lights", *this);
     setUniform(_lightRangesUniform + id, range);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+Phong& Phong::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Phong::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, ProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    if(_lightCount) buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindLightBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled", *this);
+    if(_lightCount) buffer.bind(GL::Buffer::Target::Uniform, LightBufferBinding, offset, size);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_jointCount,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with joints", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindJointBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_jointCount,
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with joints", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, JointBufferBinding, offset, size);
+    return *this;
+}
+
+#ifndef MAGNUM_TARGET_GLES
+Phong& Phong::bindTextureHandleBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::Phong::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureHandleBufferBinding);
+    return *this;
+}
+
+Phong& Phong::bindTextureHandleBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::BindlessTextures,
+        "Shaders::Phong::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureHandleBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
+Phong& Phong::setViewportSize(const Vector2& size) {
+    CORRADE_ASSERT(_flags >= Flag::ClusteredLights,
+        "Shaders::Phong::setViewportSize(): the shader was not created with clustered lights enabled", *this);
+    setUniform(_viewportSizeUniform, size);
+    return *this;
+}
+
+Phong& Phong::setLightClusterDepthRange(const Range1D& range) {
+    CORRADE_ASSERT(_flags >= Flag::ClusteredLights,
+        "Shaders::Phong::setLightClusterDepthRange(): the shader was not created with clustered lights enabled", *this);
+    CORRADE_ASSERT(range.min() > 0.0f && range.max() > range.min(),
+        "Shaders::Phong::setLightClusterDepthRange(): expected a positive range, got" << Debug::packed << range, *this);
+    /* The shader calculates the slice as log(depth)*scale + bias, which is
+       log(depth/near)/log(far/near) */
+    const Float scale = 1.0f/std::log(range.max()/range.min());
+    setUniform(_lightClusterDepthScaleBiasUniform, Vector2{scale, -std::log(range.min())*scale});
+    return *this;
+}
+
+Phong& Phong::bindLightClusterTexture(GL::Texture3D& texture) {
+    CORRADE_ASSERT(_flags >= Flag::ClusteredLights,
+        "Shaders::Phong::bindLightClusterTexture(): the shader was not created with clustered lights enabled", *this);
+    texture.bind(LightClusterTextureUnit);
+    return *this;
+}
+
+Phong& Phong::bindLightClusterIndexTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags >= Flag::ClusteredLights,
+        "Shaders::Phong::bindLightClusterIndexTexture(): the shader was not created with clustered lights enabled", *this);
+    texture.bind(LightClusterIndexTextureUnit);
+    return *this;
+}
+#endif
+
 Debug& operator<<(Debug& debug, const Phong::Flag value) {
     debug << "Shaders::Phong::Flag" << Debug::nospace;
 
@@ -514,6 +1106,7 @@ Debug& operator<<(Debug& debug, const Phong::Flag value) {
         _c(SpecularTexture)
         _c(NormalTexture)
         _c(Bitangent)
+        _c(OctahedralNormals)
         _c(AlphaMask)
         _c(VertexColor)
         _c(TextureTransformation)
@@ -523,11 +1116,20 @@ Debug& operator<<(Debug& debug, const Phong::Flag value) {
         #endif
         _c(InstancedTransformation)
         _c(InstancedTextureOffset)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        _c(ClusteredLights)
+        _c(Multiview)
+        #ifndef MAGNUM_TARGET_GLES
+        _c(MultiDraw)
+        _c(BindlessTextures)
+        #endif
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
 
-    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
 }
 
 Debug& operator<<(Debug& debug, const Phong::Flags value) {
@@ -537,6 +1139,7 @@ Debug& operator<<(Debug& debug, const Phong::Flags value) {
         Phong::Flag::SpecularTexture,
         Phong::Flag::NormalTexture,
         Phong::Flag::Bitangent,
+        Phong::Flag::OctahedralNormals,
         Phong::Flag::AlphaMask,
         Phong::Flag::VertexColor,
         Phong::Flag::InstancedTextureOffset, /* Superset of TextureTransformation */
@@ -545,7 +1148,19 @@ Debug& operator<<(Debug& debug, const Phong::Flags value) {
         Phong::Flag::InstancedObjectId, /* Superset of ObjectId */
         Phong::Flag::ObjectId,
         #endif
-        Phong::Flag::InstancedTransformation});
+        Phong::Flag::InstancedTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        Phong::Flag::Multiview,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        Phong::Flag::MultiDraw, /* Superset of UniformBuffers */
+        Phong::Flag::BindlessTextures, /* Superset of UniformBuffers */
+        #endif
+        #ifndef MAGNUM_TARGET_GLES2
+        Phong::Flag::ClusteredLights, /* Superset of UniformBuffers */
+        Phong::Flag::UniformBuffers
+        #endif
+        });
 }
 
 }}
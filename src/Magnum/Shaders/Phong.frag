@@ -27,6 +27,14 @@
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef BINDLESS_TEXTURES
+#extension GL_ARB_bindless_texture: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
@@ -37,6 +45,9 @@
 #define const
 #endif
 
+/* With bindless textures the samplers are created from handles in the
+   TextureHandle uniform buffer instead */
+#ifndef BINDLESS_TEXTURES
 #ifdef AMBIENT_TEXTURE
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 0)
@@ -44,6 +55,31 @@ layout(binding = 0)
 uniform lowp sampler2D ambientTexture;
 #endif
 
+#if LIGHT_COUNT
+#ifdef DIFFUSE_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 1)
+#endif
+uniform lowp sampler2D diffuseTexture;
+#endif
+
+#ifdef SPECULAR_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 2)
+#endif
+uniform lowp sampler2D specularTexture;
+#endif
+
+#ifdef NORMAL_TEXTURE
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 3)
+#endif
+uniform lowp sampler2D normalTexture;
+#endif
+#endif
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 4)
 #endif
@@ -58,13 +94,6 @@ uniform lowp vec4 ambientColor
     ;
 
 #if LIGHT_COUNT
-#ifdef DIFFUSE_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 1)
-#endif
-uniform lowp sampler2D diffuseTexture;
-#endif
-
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 5)
 #endif
@@ -74,20 +103,6 @@ uniform lowp vec4 diffuseColor
     #endif
     ;
 
-#ifdef SPECULAR_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 2)
-#endif
-uniform lowp sampler2D specularTexture;
-#endif
-
-#ifdef NORMAL_TEXTURE
-#ifdef EXPLICIT_TEXTURE_LAYER
-layout(binding = 3)
-#endif
-uniform lowp sampler2D normalTexture;
-#endif
-
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 6)
 #endif
@@ -170,6 +185,121 @@ uniform lowp float lightRanges[LIGHT_COUNT]
     ;
 #endif
 
+/* Uniform buffers */
+
+#else
+#ifndef MULTI_DRAW
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+/* Has to match the declaration in Phong.vert */
+struct DrawUniform {
+    mediump mat3 normalMatrix;
+    highp uint materialId;
+    highp uint objectId;
+    highp uint lightOffset;
+    highp uint lightCount;
+    highp uint jointOffset;
+    highp uint reserved0;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 ambientColor;
+    lowp vec4 diffuseColor;
+    lowp vec4 specularColor;
+    mediump float normalTextureScale;
+    mediump float shininess;
+    lowp float alphaMask;
+    lowp float reserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+
+#ifdef BINDLESS_TEXTURES
+struct TextureHandleUniform {
+    /* 64-bit ambient and diffuse texture handles */
+    highp uvec4 ambientDiffuse;
+    /* 64-bit specular and normal texture handles */
+    highp uvec4 specularNormal;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 7
+    #endif
+) uniform TextureHandle {
+    TextureHandleUniform textureHandles[DRAW_COUNT];
+};
+#endif
+
+#if LIGHT_COUNT
+struct LightUniform {
+    highp vec4 position;
+    /* std140 pads the vec3s to a vec4, range is placed in the last
+       component of the specular color */
+    lowp vec3 color;
+    lowp vec3 specularColor;
+    lowp float range;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 5
+    #endif
+) uniform Light {
+    LightUniform lights[LIGHT_COUNT];
+};
+
+#ifdef CLUSTERED_LIGHTS
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp vec2 viewportSize; /* defaults to zero */
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp vec2 lightClusterDepthScaleBias; /* defaults to zero */
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 4)
+#endif
+uniform highp usampler3D lightClusterTexture;
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 5)
+#endif
+uniform highp usampler2D lightClusterIndexTexture;
+#endif
+#endif
+#endif
+
 #if LIGHT_COUNT
 in mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
@@ -180,7 +310,11 @@ in mediump vec3 transformedTangent;
 in mediump vec3 transformedBitangent;
 #endif
 #endif
+#ifndef UNIFORM_BUFFERS
 in highp vec4 lightDirections[LIGHT_COUNT];
+#else
+in highp vec3 transformedPosition;
+#endif
 in highp vec3 cameraDirection;
 #endif
 
@@ -211,6 +345,41 @@ out highp uint fragmentObjectId;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef OBJECT_ID
+    highp uint objectId = draws[drawId].objectId;
+    #endif
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 ambientColor = materials[materialId].ambientColor;
+    #if LIGHT_COUNT
+    lowp vec4 diffuseColor = materials[materialId].diffuseColor;
+    lowp vec4 specularColor = materials[materialId].specularColor;
+    mediump float shininess = materials[materialId].shininess;
+    #endif
+    #ifdef NORMAL_TEXTURE
+    mediump float normalTextureScale = materials[materialId].normalTextureScale;
+    #endif
+    #ifdef ALPHA_MASK
+    lowp float alphaMask = materials[materialId].alphaMask;
+    #endif
+    #ifdef BINDLESS_TEXTURES
+    #ifdef AMBIENT_TEXTURE
+    lowp sampler2D ambientTexture = sampler2D(textureHandles[drawId].ambientDiffuse.xy);
+    #endif
+    #if LIGHT_COUNT
+    #ifdef DIFFUSE_TEXTURE
+    lowp sampler2D diffuseTexture = sampler2D(textureHandles[drawId].ambientDiffuse.zw);
+    #endif
+    #ifdef SPECULAR_TEXTURE
+    lowp sampler2D specularTexture = sampler2D(textureHandles[drawId].specularNormal.xy);
+    #endif
+    #ifdef NORMAL_TEXTURE
+    lowp sampler2D normalTexture = sampler2D(textureHandles[drawId].specularNormal.zw);
+    #endif
+    #endif
+    #endif
+    #endif
+
     lowp const vec4 finalAmbientColor =
         #ifdef AMBIENT_TEXTURE
         texture(ambientTexture, interpolatedTextureCoordinates)*
@@ -262,27 +431,73 @@ void main() {
     #endif
 
     /* Add diffuse color for each light */
+    #ifndef UNIFORM_BUFFERS
     for(int i = 0; i < LIGHT_COUNT; ++i) {
+        highp vec4 lightDirection = lightDirections[i];
+        lowp vec3 lightColor = lightColors[i];
+        lowp vec3 lightSpecularColor = lightSpecularColors[i];
+        lowp float lightRange = lightRanges[i];
+        mediump float lightCount = float(LIGHT_COUNT);
+    #else
+    #ifndef CLUSTERED_LIGHTS
+    /* The light range is clamped to lights actually present in the buffer */
+    highp uint lightOffset = min(draws[drawId].lightOffset, uint(LIGHT_COUNT));
+    highp uint lightEnd = lightOffset + min(draws[drawId].lightCount, uint(LIGHT_COUNT) - lightOffset);
+    #else
+    /* Find the cluster the fragment is in. Tiles are evenly distributed over
+       the viewport, depth slices exponentially between the near and far
+       plane, same as in LightClusters::update(). */
+    highp ivec3 clusterGridSize = textureSize(lightClusterTexture, 0);
+    highp float clusterSlice = log(max(-transformedPosition.z, 0.000001))*lightClusterDepthScaleBias.x + lightClusterDepthScaleBias.y;
+    highp ivec3 cluster = clamp(ivec3(
+        ivec2(gl_FragCoord.xy*vec2(clusterGridSize.xy)/viewportSize),
+        int(floor(clusterSlice*float(clusterGridSize.z)))),
+        ivec3(0), clusterGridSize - ivec3(1));
+    /* Offset into the light index texture and count of lights */
+    highp uvec2 clusterLights = texelFetch(lightClusterTexture, cluster, 0).xy;
+    highp uint lightIndexTextureWidth = uint(textureSize(lightClusterIndexTexture, 0).x);
+    highp uint lightOffset = 0u;
+    highp uint lightEnd = clusterLights.y;
+    #endif
+    mediump float lightCount = float(lightEnd - lightOffset);
+    for(highp uint j = lightOffset; j < lightEnd; ++j) {
+        #ifndef CLUSTERED_LIGHTS
+        highp uint i = j;
+        #else
+        /* Clamping the index to lights actually present in the buffer */
+        highp uint index = clusterLights.x + j;
+        highp uint i = min(texelFetch(lightClusterIndexTexture, ivec2(int(index % lightIndexTextureWidth), int(index/lightIndexTextureWidth)), 0).r, uint(LIGHT_COUNT - 1));
+        #endif
+
+        /* Direction to the light. Directional lights have the last component
+           set to 0, which gets used to ignore the transformed position. */
+        highp vec4 lightPosition = lights[i].position;
+        highp vec4 lightDirection = vec4(lightPosition.xyz - transformedPosition*lightPosition.w, lightPosition.w);
+        lowp vec3 lightColor = lights[i].color;
+        lowp vec3 lightSpecularColor = lights[i].specularColor;
+        lowp float lightRange = lights[i].range;
+    #endif
+
         /* Attenuation. Directional lights have the .w component set to 0, use
            that to make the distance zero -- which will then ensure the
            attenuation is always 1.0 */
-        highp float dist = length(lightDirections[i].xyz)*lightDirections[i].w;
+        highp float dist = length(lightDirection.xyz)*lightDirection.w;
         /* If range is 0 for whatever reason, clamp it to a small value to
            avoid a NaN when dist is 0 as well (which is the case for
            directional lights). */
-        highp float attenuation = clamp(1.0 - pow(dist/max(lightRanges[i], 0.0001), 4.0), 0.0, 1.0);
+        highp float attenuation = clamp(1.0 - pow(dist/max(lightRange, 0.0001), 4.0), 0.0, 1.0);
         attenuation = attenuation*attenuation/(1.0 + dist*dist);
 
-        highp vec3 normalizedLightDirection = normalize(lightDirections[i].xyz);
+        highp vec3 normalizedLightDirection = normalize(lightDirection.xyz);
         lowp float intensity = max(0.0, dot(normalizedTransformedNormal, normalizedLightDirection))*attenuation;
-        fragmentColor += vec4(finalDiffuseColor.rgb*lightColors[i]*intensity, finalDiffuseColor.a/float(LIGHT_COUNT));
+        fragmentColor += vec4(finalDiffuseColor.rgb*lightColor*intensity, finalDiffuseColor.a/lightCount);
 
         /* Add specular color, if needed */
         if(intensity > 0.001) {
             highp vec3 reflection = reflect(-normalizedLightDirection, normalizedTransformedNormal);
             /* Use attenuation for the specularity as well */
             mediump float specularity = clamp(pow(max(0.0, dot(normalize(cameraDirection), reflection)), shininess), 0.0, 1.0)*attenuation;
-            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColors[i].rgb*specularity, finalSpecularColor.a);
+            fragmentColor += vec4(finalSpecularColor.rgb*lightSpecularColor*specularity, finalSpecularColor.a);
         }
     }
     #endif
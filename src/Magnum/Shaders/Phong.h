@@ -26,15 +26,495 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Phong
+ * @brief Class @ref Magnum::Shaders::Phong, struct @ref Magnum::Shaders::PhongDrawUniform, @ref Magnum::Shaders::PhongMaterialUniform, @ref Magnum::Shaders::PhongLightUniform
  */
 
 #include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Shader.h"
 #include "Magnum/Shaders/Generic.h"
 #include "Magnum/Shaders/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Constants.h"
+#endif
+
 namespace Magnum { namespace Shaders {
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for Phong shaders
+@m_since_latest
+
+Together with the generic @ref TransformationUniform3D contains parameters
+that are specific to each draw call. Material-related properties are expected
+to be shared among multiple draw calls and thus are provided in a separate
+@ref PhongMaterialUniform structure, referenced by @ref materialId. Lights
+are supplied in a separate @ref PhongLightUniform buffer as well, with
+@ref lightOffset and @ref lightCount describing the range of lights affecting
+given draw. For skinned meshes, @ref jointOffset describes where the joint
+matrices of given draw start.
+@see @ref Phong::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PhongDrawUniform() noexcept: normalMatrix{
+        Vector4{1.0f, 0.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 1.0f, 0.0f, 0.0f},
+        Vector4{0.0f, 0.0f, 1.0f, 0.0f}}, materialId{0}, objectId{0}, lightOffset{0}, lightCount{0xffffffffu}, jointOffset{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongDrawUniform(NoInitT) noexcept: normalMatrix{NoInit} {}
+
+    /**
+     * @brief Set the @ref normalMatrix field
+     * @return Reference to self (for method chaining)
+     *
+     * The matrix is expanded to @ref Matrix3x4, with the bottom row being
+     * zeros.
+     */
+    PhongDrawUniform& setNormalMatrix(const Matrix3x3& matrix) {
+        normalMatrix = Matrix3x4{
+            Vector4{matrix[0], 0.0f},
+            Vector4{matrix[1], 0.0f},
+            Vector4{matrix[2], 0.0f}};
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref objectId field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setObjectId(UnsignedInt id) {
+        objectId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref lightOffset and @ref lightCount fields
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setLightOffsetCount(UnsignedInt offset, UnsignedInt count) {
+        lightOffset = offset;
+        lightCount = count;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref jointOffset field
+     * @return Reference to self (for method chaining)
+     */
+    PhongDrawUniform& setJointOffset(UnsignedInt offset) {
+        jointOffset = offset;
+        return *this;
+    }
+
+    /**
+     * @brief Normal matrix
+     *
+     * Default value is an identity matrix, with the bottom row being zeros.
+     * The bottom row is unused and is there only to match the
+     * @glsl std140 @ce layout of a @glsl mat3 @ce. If
+     * @ref Phong::lightCount() is zero, this value is not used.
+     * @see @ref Phong::setNormalMatrix()
+     */
+    Matrix3x4 normalMatrix;
+
+    /**
+     * @brief Material ID
+     *
+     * References a particular material from a @ref PhongMaterialUniform
+     * array. Should be less than the material count passed to the
+     * @ref Phong::Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+     * constructor. Default value is @cpp 0 @ce, meaning the first material
+     * gets used.
+     */
+    UnsignedInt materialId;
+
+    /**
+     * @brief Object ID
+     *
+     * Unlike @ref Phong::setObjectId(), this value is per-draw. Used only if
+     * @ref Phong::Flag::ObjectId is enabled, ignored otherwise. If
+     * @ref Phong::Flag::InstancedObjectId is enabled as well, this value is
+     * added to the ID coming from the @ref Phong::ObjectId attribute. Default
+     * value is @cpp 0 @ce.
+     */
+    UnsignedInt objectId;
+
+    /**
+     * @brief Light offset
+     *
+     * Index of the first light from the @ref PhongLightUniform array that
+     * affects given draw. Default value is @cpp 0 @ce.
+     */
+    UnsignedInt lightOffset;
+
+    /**
+     * @brief Light count
+     *
+     * Count of lights from the @ref PhongLightUniform array, starting at
+     * @ref lightOffset, that affect given draw. The value is clamped to the
+     * count of lights remaining in the array. Default value is
+     * @cpp 0xffffffffu @ce, i.e. all lights starting at @ref lightOffset.
+     */
+    UnsignedInt lightCount;
+
+    /**
+     * @brief Joint offset
+     *
+     * Index of the first joint matrix from the @ref TransformationUniform3D
+     * joint buffer used by given draw, the per-vertex @ref Phong::JointIds
+     * are relative to it. Used only if the shader was created with a
+     * non-zero joint count, ignored otherwise. Default value is @cpp 0 @ce.
+     */
+    UnsignedInt jointOffset;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    Int:32;
+    #endif
+};
+
+/**
+@brief Material uniform for Phong shaders
+@m_since_latest
+
+Describes material properties referenced from
+@ref PhongDrawUniform::materialId.
+@see @ref Phong::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PhongMaterialUniform() noexcept: ambientColor{0.0f, 0.0f, 0.0f, 0.0f}, diffuseColor{1.0f, 1.0f, 1.0f, 1.0f}, specularColor{1.0f, 1.0f, 1.0f, 0.0f}, normalTextureScale{1.0f}, shininess{80.0f}, alphaMask{0.5f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongMaterialUniform(NoInitT) noexcept: ambientColor{NoInit}, diffuseColor{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref ambientColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAmbientColor(const Color4& color) {
+        ambientColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref diffuseColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setDiffuseColor(const Color4& color) {
+        diffuseColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setSpecularColor(const Color4& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureScale field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setNormalTextureScale(Float scale) {
+        normalTextureScale = scale;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref shininess field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setShininess(Float shininess) {
+        this->shininess = shininess;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref alphaMask field
+     * @return Reference to self (for method chaining)
+     */
+    PhongMaterialUniform& setAlphaMask(Float alphaMask) {
+        this->alphaMask = alphaMask;
+        return *this;
+    }
+
+    /**
+     * @brief Ambient color
+     *
+     * Default value is @cpp 0x00000000_rgbaf @ce. Unlike with
+     * @ref Phong::setAmbientColor(), the default doesn't change based on
+     * whether @ref Phong::Flag::AmbientTexture is enabled, so set it to
+     * @cpp 0xffffffff_rgbaf @ce for the ambient texture to have an effect.
+     */
+    Color4 ambientColor;
+
+    /**
+     * @brief Diffuse color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce. If @ref Phong::lightCount()
+     * is zero, this value is not used.
+     * @see @ref Phong::setDiffuseColor()
+     */
+    Color4 diffuseColor;
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff00_rgbaf @ce. If @ref Phong::lightCount()
+     * is zero, this value is not used.
+     * @see @ref Phong::setSpecularColor()
+     */
+    Color4 specularColor;
+
+    /**
+     * @brief Normal texture scale
+     *
+     * Used only if @ref Phong::Flag::NormalTexture is enabled, ignored
+     * otherwise. Default value is @cpp 1.0f @ce.
+     * @see @ref Phong::setNormalTextureScale()
+     */
+    Float normalTextureScale;
+
+    /**
+     * @brief Shininess
+     *
+     * Default value is @cpp 80.0f @ce. If @ref Phong::lightCount() is zero,
+     * this value is not used.
+     * @see @ref Phong::setShininess()
+     */
+    Float shininess;
+
+    /**
+     * @brief Alpha mask value
+     *
+     * Used only if @ref Phong::Flag::AlphaMask is enabled, ignored otherwise.
+     * Default value is @cpp 0.5f @ce.
+     * @see @ref Phong::setAlphaMask()
+     */
+    Float alphaMask;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+};
+
+/**
+@brief Light parameters for Phong shaders
+@m_since_latest
+
+Describes light properties for each light referenced by
+@ref PhongDrawUniform::lightOffset and @ref PhongDrawUniform::lightCount.
+See @ref Shaders-Phong-lights for more information about the light
+parameters.
+@see @ref Phong::bindLightBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct PhongLightUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PhongLightUniform() noexcept: position{0.0f, 0.0f, 1.0f, 0.0f}, color{1.0f, 1.0f, 1.0f}, specularColor{1.0f, 1.0f, 1.0f}, range{Constants::inf()} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongLightUniform(NoInitT) noexcept: position{NoInit}, color{NoInit}, specularColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref position field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setPosition(const Vector4& position) {
+        this->position = position;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setColor(const Color3& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularColor field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setSpecularColor(const Color3& color) {
+        specularColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref range field
+     * @return Reference to self (for method chaining)
+     */
+    PhongLightUniform& setRange(Float range) {
+        this->range = range;
+        return *this;
+    }
+
+    /**
+     * @brief Position
+     *
+     * Camera-relative position of a point light if the fourth component is
+     * @cpp 1.0f @ce, a direction *to* a directional light if it's
+     * @cpp 0.0f @ce. Default value is @cpp {0.0f, 0.0f, 1.0f, 0.0f} @ce
+     * --- a directional "fill" light coming from the camera.
+     * @see @ref Phong::setLightPositions()
+     */
+    Vector4 position;
+
+    /**
+     * @brief Color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightColors()
+     */
+    Color3 color;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    #endif
+
+    /**
+     * @brief Specular color
+     *
+     * Default value is @cpp 0xffffff_rgbf @ce.
+     * @see @ref Phong::setLightSpecularColors()
+     */
+    Color3 specularColor;
+
+    /**
+     * @brief Range
+     *
+     * Default value is @ref Constants::inf(). Not used for directional
+     * lights.
+     * @see @ref Phong::setLightRanges()
+     */
+    Float range;
+};
+
+#ifndef MAGNUM_TARGET_GLES
+/**
+@brief Texture handle uniform for Phong shaders
+@m_since_latest
+
+Supplies bindless texture handles for each draw, indexed the same way as
+@ref PhongDrawUniform. Handles for textures that aren't enabled in
+@ref Phong::flags() are ignored.
+@see @ref Phong::bindTextureHandleBuffer(), @ref Shaders-Phong-bindless
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_extension Extension @gl_extension{ARB,bindless_texture}
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+*/
+struct PhongTextureHandleUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit PhongTextureHandleUniform() noexcept: ambientTextureHandle{0}, diffuseTextureHandle{0}, specularTextureHandle{0}, normalTextureHandle{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit PhongTextureHandleUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref ambientTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongTextureHandleUniform& setAmbientTextureHandle(UnsignedLong handle) {
+        ambientTextureHandle = handle;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref diffuseTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongTextureHandleUniform& setDiffuseTextureHandle(UnsignedLong handle) {
+        diffuseTextureHandle = handle;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref specularTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongTextureHandleUniform& setSpecularTextureHandle(UnsignedLong handle) {
+        specularTextureHandle = handle;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref normalTextureHandle field
+     * @return Reference to self (for method chaining)
+     */
+    PhongTextureHandleUniform& setNormalTextureHandle(UnsignedLong handle) {
+        normalTextureHandle = handle;
+        return *this;
+    }
+
+    /**
+     * @brief Ambient texture handle
+     *
+     * Used only if @ref Phong::Flag::AmbientTexture is enabled, ignored
+     * otherwise. Default value is @cpp 0 @ce.
+     */
+    UnsignedLong ambientTextureHandle;
+
+    /**
+     * @brief Diffuse texture handle
+     *
+     * Used only if @ref Phong::Flag::DiffuseTexture is enabled, ignored
+     * otherwise. Default value is @cpp 0 @ce.
+     */
+    UnsignedLong diffuseTextureHandle;
+
+    /**
+     * @brief Specular texture handle
+     *
+     * Used only if @ref Phong::Flag::SpecularTexture is enabled, ignored
+     * otherwise. Default value is @cpp 0 @ce.
+     */
+    UnsignedLong specularTextureHandle;
+
+    /**
+     * @brief Normal texture handle
+     *
+     * Used only if @ref Phong::Flag::NormalTexture is enabled, ignored
+     * otherwise. Default value is @cpp 0 @ce.
+     */
+    UnsignedLong normalTextureHandle;
+};
+#endif
+#endif
+
 /**
 @brief Phong shader
 
@@ -206,6 +686,22 @@ The strength of the effect can be controlled by
 @ref Trade::MaterialAttribute::NormalTextureScale for a description of the
 factor is used.
 
+@section Shaders-Phong-octahedral Octahedral normals
+
+To save vertex memory and bandwidth, normals and tangent space can be supplied
+in an octahedral representation created with @ref Math::packOctahedral() or
+@ref Math::packOctahedralInto(), usually further packed into a two-component
+signed normalized 8- or 16-bit type. Enable @ref Flag::OctahedralNormals and
+supply an @ref OctahedralNormal attribute instead of @ref Normal. With
+@ref Flag::NormalTexture, supply either a three-component
+@ref OctahedralTangent3 attribute with the bitangent sign in the third
+component instead of @ref Tangent4, or a pair of two-component
+@ref OctahedralTangent and @ref OctahedralBitangent attributes together with
+@ref Flag::Bitangent. The vectors are decoded in the vertex shader, the rest of
+the shading stays the same.
+
+@snippet MagnumShaders.cpp Phong-usage-octahedral
+
 @section Shaders-Phong-object-id Object ID output
 
 The shader supports writing object ID to the framebuffer for object picking or
@@ -239,6 +735,9 @@ well to ensure lighting works:
 
 @snippet MagnumShaders.cpp Phong-usage-instancing
 
+On desktop GL, @ref InstanceBuffer can be used to stream per-instance data
+that change every frame through a persistently mapped buffer.
+
 @requires_gl33 Extension @gl_extension{ARB,instanced_arrays}
 @requires_gles30 Extension @gl_extension{ANGLE,instanced_arrays},
     @gl_extension{EXT,instanced_arrays} or @gl_extension{NV,instanced_arrays}
@@ -246,6 +745,122 @@ well to ensure lighting works:
 @requires_webgl20 Extension @webgl_extension{ANGLE,instanced_arrays} in WebGL
     1.0.
 
+@section Shaders-Phong-skinning Skinning
+
+Similarly to @ref Shaders-Flat-skinning "the Flat shader", passing a non-zero
+@p jointCount to
+@ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt) makes
+the shader deform the mesh by a palette of joint matrices, with each vertex
+being affected by up to four joints given by the @ref JointIds and
+@ref Weights attributes. Besides the position, the normal, tangent and
+bitangent are transformed by the blended joint matrix as well. The joint
+matrices are set with @ref setJointMatrices() or, with
+@ref Flag::UniformBuffers, supplied in a @ref TransformationUniform3D buffer
+bound with @ref bindJointBuffer(), with @ref PhongDrawUniform::jointOffset
+selecting the first joint of given draw.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gles30 Skinning requires integer support in shaders, which is not
+    available in OpenGL ES 2.0 or WebGL 1.0.
+
+@section Shaders-Phong-multiview Single-pass stereo rendering
+
+With @ref Flag::Multiview, the shader renders into two views at once using
+@gl_extension{OVR,multiview2}, with the projection matrix for each view
+supplied with @ref setProjectionMatrices() and picked in the shader based on
+@glsl gl_ViewID_OVR @ce. The transformation matrix, normal matrix and light
+positions are shared by both views, so the per-eye offset is expected to be
+baked into the projection matrices, with the transformation being relative to
+the head. The resulting difference in specular highlights between the eyes is
+negligible in practice. The framebuffer setup is the same as described in
+@ref Shaders-Flat-multiview.
+
+The flag can't be combined with @ref Flag::UniformBuffers at the moment.
+
+@requires_extension Extension @gl_extension{OVR,multiview2}
+@requires_es_extension Extension @gl_extension{OVR,multiview2}
+@requires_webgl_extension Extension @webgl_extension{OVR,multiview2}
+@requires_gles30 Multiview is not available in OpenGL ES 2.0.
+@requires_webgl20 Multiview is not available in WebGL 1.0.
+
+@section Shaders-Phong-ubo Uniform buffers
+
+Similarly to @ref Shaders-Flat-ubo "the Flat shader", enabling
+@ref Flag::UniformBuffers makes the shader take its parameters from uniform
+buffers instead of individual uniform setters, none of which can be used in
+that case. A single @ref ProjectionUniform3D shared by all draws is bound with
+@ref bindProjectionBuffer(), per-draw @ref TransformationUniform3D and
+@ref PhongDrawUniform items are bound with @ref bindTransformationBuffer() and
+@ref bindDrawBuffer(), materials referenced by
+@ref PhongDrawUniform::materialId are in a @ref PhongMaterialUniform buffer
+bound with @ref bindMaterialBuffer() and lights in a @ref PhongLightUniform
+buffer bound with @ref bindLightBuffer(). Each draw then uses the lights from
+the range given by @ref PhongDrawUniform::lightOffset and
+@ref PhongDrawUniform::lightCount. If @ref Flag::TextureTransformation is
+enabled, the texture transformation is taken from a
+@ref TextureTransformationUniform buffer bound with
+@ref bindTextureTransformationBuffer(). The per-draw buffers are expected to
+contain at least as many items as the @p drawCount passed to the
+@ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt) constructor, the
+material buffer at least @p materialCount and the light buffer at least
+@p lightCount items. The draw is selected with @ref setDrawOffset():
+
+@snippet MagnumShaders.cpp Phong-ubo
+
+On desktop GL, enabling @ref Flag::MultiDraw makes the shader add the draw
+index coming from @glsl gl_DrawID @ce to the draw offset, allowing a list of
+@ref GL::MeshView instances to be drawn with a single
+@ref draw(Containers::ArrayView<const Containers::Reference<GL::MeshView>>)
+call.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers, @gl_extension{ARB,shader_draw_parameters}
+    for @ref Flag::MultiDraw
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+@requires_gl Multi-draw with @glsl gl_DrawID @ce is not available in OpenGL
+    ES or WebGL.
+
+@section Shaders-Phong-clustered Clustered lighting
+
+With many lights in a scene, iterating over all of them for every fragment
+gets prohibitively expensive, and splitting them into per-draw ranges via
+@ref PhongDrawUniform::lightOffset and @ref PhongDrawUniform::lightCount
+doesn't help much for large objects. Enabling @ref Flag::ClusteredLights makes
+the shader look up the screen-space tile and depth slice a fragment is in and
+iterate only over lights in that cluster. The per-cluster light lists are
+built with @ref LightClusters from the same @ref PhongLightUniform array that's
+uploaded to the light buffer, the per-draw light range is ignored in this
+case:
+
+@snippet MagnumShaders.cpp LightClusters-usage
+
+Since the lights are still supplied in a uniform buffer, the @p lightCount
+passed to the constructor is limited by the max uniform block size. Lights
+that are farther than @ref LightClusters::depthRange() from the camera, which
+is extracted from the projection matrix, are not binned into any cluster.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} and
+    @gl_extension{EXT,texture_integer} for @ref Flag::ClusteredLights
+@requires_gles30 Uniform buffers and integer textures are not available in
+    OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers and integer textures are not available in
+    WebGL 1.0.
+
+@section Shaders-Phong-bindless Bindless textures
+
+Similarly to @ref Shaders-Flat-bindless "the Flat shader", enabling
+@ref Flag::BindlessTextures makes the shader take the textures from bindless
+handles supplied for each draw in a @ref PhongTextureHandleUniform buffer bound
+with @ref bindTextureHandleBuffer() instead of texture units. Together with
+@ref Flag::MultiDraw, draws with distinct textures can be then submitted in a
+single call.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_extension Extension @gl_extension{ARB,bindless_texture} for
+    @ref Flag::BindlessTextures
+@requires_gl Bindless textures are not available in OpenGL ES or WebGL.
+
 @see @ref shaders
 */
 class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
@@ -305,6 +920,59 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         typedef typename Generic3D::Bitangent Bitangent;
 
+        /**
+         * @brief Octahedral normal direction
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector2 "Vector2", usually stored as a normalized
+         * @ref Magnum::Vector2s "Vector2s" or @ref Magnum::Vector2b "Vector2b".
+         * Shares the location with @ref Normal, use instead of it if
+         * @ref Flag::OctahedralNormals is set.
+         * @see @ref Shaders-Phong-octahedral
+         */
+        typedef GL::Attribute<Generic3D::Normal::Location, Vector2> OctahedralNormal;
+
+        /**
+         * @brief Octahedral tangent direction
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector2 "Vector2". Shares the location with
+         * @ref Tangent, use instead of it if both
+         * @ref Flag::OctahedralNormals and @ref Flag::Bitangent are set. Used
+         * only if @ref Flag::NormalTexture is set.
+         * @see @ref Shaders-Phong-octahedral
+         */
+        typedef GL::Attribute<Generic3D::Tangent::Location, Vector2> OctahedralTangent;
+
+        /**
+         * @brief Octahedral tangent direction with a bitangent sign
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector3 "Vector3", with the first two components being
+         * the octahedral tangent and the third the bitangent sign. Shares the
+         * location with @ref Tangent4, use instead of it if
+         * @ref Flag::OctahedralNormals is set and @ref Flag::Bitangent isn't.
+         * Used only if @ref Flag::NormalTexture is set.
+         * @see @ref Shaders-Phong-octahedral
+         */
+        typedef GL::Attribute<Generic3D::Tangent4::Location, Vector3> OctahedralTangent3;
+
+        /**
+         * @brief Octahedral bitangent direction
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute",
+         * @ref Magnum::Vector2 "Vector2". Shares the location with
+         * @ref Bitangent, use instead of it if @ref Flag::OctahedralNormals is
+         * set. Used only if both @ref Flag::NormalTexture and
+         * @ref Flag::Bitangent are set.
+         * @see @ref Shaders-Phong-octahedral
+         */
+        typedef GL::Attribute<Generic3D::Bitangent::Location, Vector2> OctahedralBitangent;
+
         /**
          * @brief 2D texture coordinates
          *
@@ -347,6 +1015,32 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         typedef Generic3D::ObjectId ObjectId;
+
+        /**
+         * @brief Joint weights
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector4.
+         * Used only if the shader was created with a non-zero joint count.
+         * See @ref Shaders-Phong-skinning for more information.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef Generic3D::Weights Weights;
+
+        /**
+         * @brief Joint IDs
+         * @m_since_latest
+         *
+         * @ref shaders-generic "Generic attribute", @ref Magnum::Vector4ui.
+         * Used only if the shader was created with a non-zero joint count.
+         * See @ref Shaders-Phong-skinning for more information.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        typedef Generic3D::JointIds JointIds;
         #endif
 
         /**
@@ -425,7 +1119,7 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * @see @ref Flags, @ref flags()
          */
-        enum class Flag: UnsignedShort {
+        enum class Flag: UnsignedInt {
             /**
              * Multiply ambient color with a texture.
              * @see @ref setAmbientColor(), @ref bindAmbientTexture()
@@ -480,6 +1174,17 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
              */
             Bitangent = 1 << 11,
 
+            /**
+             * Take normals, tangents and bitangents in an octahedral
+             * representation from the @ref OctahedralNormal,
+             * @ref OctahedralTangent, @ref OctahedralTangent3 and
+             * @ref OctahedralBitangent attributes instead of @ref Normal,
+             * @ref Tangent, @ref Tangent4 and @ref Bitangent. See
+             * @ref Shaders-Phong-octahedral for more information.
+             * @m_since_latest
+             */
+            OctahedralNormals = 1 << 16,
+
             /**
              * Enable texture coordinate transformation. If this flag is set,
              * the shader expects that at least one of
@@ -553,7 +1258,93 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
              *      in WebGL 1.0.
              * @m_since{2020,06}
              */
-            InstancedTextureOffset = (1 << 10)|TextureTransformation
+            InstancedTextureOffset = (1 << 10)|TextureTransformation,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindProjectionBuffer(), @ref bindTransformationBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer(),
+             * @ref bindMaterialBuffer() and @ref bindLightBuffer() instead of
+             * direct uniform setters. See @ref Shaders-Phong-ubo for more
+             * information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 12,
+
+            /**
+             * Use clustered lighting. Implies @ref Flag::UniformBuffers and
+             * instead of the per-draw light range each fragment iterates only
+             * over lights in the cluster it's in, as calculated by
+             * @ref LightClusters. Expects that the cluster data are supplied
+             * via @ref bindLightClusterTexture(),
+             * @ref bindLightClusterIndexTexture(), @ref setViewportSize() and
+             * @ref setLightClusterDepthRange(). See
+             * @ref Shaders-Phong-clustered for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{EXT,texture_integer}
+             * @requires_gles30 Uniform buffers and integer textures are not
+             *      available in OpenGL ES 2.0.
+             * @requires_webgl20 Uniform buffers and integer textures are not
+             *      available in WebGL 1.0.
+             * @m_since_latest
+             */
+            ClusteredLights = UniformBuffers|(1 << 14),
+
+            /**
+             * Render into two views at once, with the projection matrix
+             * picked based on @glsl gl_ViewID_OVR @ce. Expects the matrices
+             * to be supplied via @ref setProjectionMatrices(), can't be
+             * combined with @ref Flag::UniformBuffers. See
+             * @ref Shaders-Phong-multiview for more information.
+             * @requires_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_es_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_webgl_extension Extension
+             *      @webgl_extension{OVR,multiview2}
+             * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+             * @requires_webgl20 Multiview is not available in WebGL 1.0.
+             * @m_since_latest
+             */
+            Multiview = 1 << 17,
+
+            #ifndef MAGNUM_TARGET_GLES
+            /**
+             * Enable multidraw functionality. Implies
+             * @ref Flag::UniformBuffers and adds the value of
+             * @glsl gl_DrawID @ce to the offset set in @ref setDrawOffset().
+             * See @ref Shaders-Phong-ubo for more information.
+             * @requires_gl46 Extension @gl_extension{ARB,uniform_buffer_object}
+             *      and @gl_extension{ARB,shader_draw_parameters}
+             * @requires_gl Multi-draw with @glsl gl_DrawID @ce is not
+             *      available in OpenGL ES or WebGL.
+             * @m_since_latest
+             */
+            MultiDraw = UniformBuffers|(1 << 13),
+
+            /**
+             * Take textures from bindless handles. Implies
+             * @ref Flag::UniformBuffers and expects that at least one of
+             * @ref Flag::AmbientTexture, @ref Flag::DiffuseTexture,
+             * @ref Flag::SpecularTexture or @ref Flag::NormalTexture is
+             * enabled as well. Instead of @ref bindTextures() and related
+             * functions, the texture handles are taken from a
+             * @ref PhongTextureHandleUniform buffer bound with
+             * @ref bindTextureHandleBuffer(). See
+             * @ref Shaders-Phong-bindless for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+             * @requires_gl Bindless textures are not available in OpenGL ES
+             *      or WebGL.
+             * @m_since_latest
+             */
+            BindlessTextures = UniformBuffers|(1 << 15)
+            #endif
+            #endif
         };
 
         /**
@@ -563,13 +1354,135 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         typedef Containers::EnumSet<Flag> Flags;
 
+        class CompileState;
+
+        /**
+         * @brief Compile asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Phong(Flags, UnsignedInt) can perform an
+         * asynchronous compilation and linking. See @ref shaders-async for
+         * more information.
+         * @see @ref Phong(CompileState&&),
+         *      @ref compile(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         */
+        static CompileState compile(Flags flags = {}, UnsignedInt lightCount = 1);
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Compile for a multi-draw scenario asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         * can perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref Phong(CompileState&&), @ref compile(Flags, UnsignedInt)
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+
+        /**
+         * @brief Compile a skinned shader asynchronously
+         * @m_since_latest
+         *
+         * Compared to @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt)
+         * can perform an asynchronous compilation and linking. See
+         * @ref shaders-async for more information.
+         * @see @ref Phong(CompileState&&)
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        static CompileState compile(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount, UnsignedInt jointCount);
+        #endif
+
         /**
          * @brief Constructor
          * @param flags         Flags
          * @param lightCount    Count of light sources
+         *
+         * While this function is meant mainly for the classic uniform
+         * scenario (without @ref Flag::UniformBuffers set), it's equivalent
+         * to @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt) with
+         * @p materialCount and @p drawCount set to @cpp 1 @ce.
+         * @see @ref compile(Flags, UnsignedInt)
          */
         explicit Phong(Flags flags = {}, UnsignedInt lightCount = 1);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for a multi-draw scenario
+         * @param flags         Flags
+         * @param lightCount    Size of a @ref PhongLightUniform buffer bound
+         *      with @ref bindLightBuffer()
+         * @param materialCount Size of a @ref PhongMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationUniform3D /
+         *      @ref PhongDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p lightCount,
+         * @p materialCount and @p drawCount describe the uniform buffer sizes
+         * as these are required to have a statically defined size. The draw
+         * offset is then set via @ref setDrawOffset(). Expects that
+         * @p materialCount and @p drawCount are non-zero. A zero
+         * @p lightCount makes the shader equivalent to @ref Flat3D, same as
+         * in the classic case.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref Phong(Flags, UnsignedInt).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         * @see @ref compile(Flags, UnsignedInt, UnsignedInt, UnsignedInt)
+         */
+        explicit Phong(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount);
+
+        /**
+         * @brief Construct a skinned shader
+         * @param flags         Flags
+         * @param lightCount    Count of light sources or size of a
+         *      @ref PhongLightUniform buffer bound with @ref bindLightBuffer()
+         * @param materialCount Size of a @ref PhongMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationUniform3D /
+         *      @ref PhongDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @param jointCount    Count of joint matrices set with
+         *      @ref setJointMatrices() or size of a
+         *      @ref TransformationUniform3D buffer bound with
+         *      @ref bindJointBuffer()
+         * @m_since_latest
+         *
+         * Behaves like @ref Phong(Flags, UnsignedInt, UnsignedInt, UnsignedInt),
+         * with a non-zero @p jointCount additionally enabling skinning. See
+         * @ref Shaders-Phong-skinning for more information.
+         * @see @ref compile(Flags, UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt)
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        explicit Phong(Flags flags, UnsignedInt lightCount, UnsignedInt materialCount, UnsignedInt drawCount, UnsignedInt jointCount);
+        #endif
+
+        /**
+         * @brief Finalize an asynchronous compilation
+         * @m_since_latest
+         *
+         * Takes an asynchronous compilation state returned by @ref compile()
+         * and forms a ready-to-use shader object. See @ref shaders-async for
+         * more information.
+         */
+        explicit Phong(CompileState&& state);
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -599,9 +1512,53 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
         /** @brief Flags */
         Flags flags() const { return _flags; }
 
-        /** @brief Light count */
+        /**
+         * @brief Light count
+         *
+         * If @ref Flag::UniformBuffers is set, this is the statically
+         * defined size of the @ref PhongLightUniform uniform buffer.
+         */
         UnsignedInt lightCount() const { return _lightCount; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref PhongMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationUniform3D, @ref PhongDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+
+        /**
+         * @brief Joint count
+         * @m_since_latest
+         *
+         * Count of joint matrices, or statically defined size of the
+         * @ref TransformationUniform3D joint uniform buffer if
+         * @ref Flag::UniformBuffers is set. If zero, the shader doesn't do
+         * skinning.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt jointCount() const { return _jointCount; }
+        #endif
+
         /**
          * @brief Set ambient color
          * @return Reference to self (for method chaining)
@@ -762,6 +1719,45 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *      shaders, which is not available in OpenGL ES 2.0 or WebGL 1.0.
          */
         Phong& setObjectId(UnsignedInt id);
+
+        /**
+         * @brief Set joint matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Sets the first @cpp matrices.size() @ce joint matrices, expects
+         * that it's not more than @ref jointCount(). Initial value of all
+         * joint matrices is an identity. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill a
+         * @ref TransformationUniform3D buffer and call
+         * @ref bindJointBuffer() instead. See @ref Shaders-Phong-skinning
+         * for more information.
+         * @see @ref setJointMatrix()
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        Phong& setJointMatrices(Containers::ArrayView<const Matrix4> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& setJointMatrices(std::initializer_list<Matrix4> matrices);
+
+        /**
+         * @brief Set joint matrix for given joint
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Unlike @ref setJointMatrices() updates just a single joint matrix.
+         * Expects that @p id is less than @ref jointCount() and that
+         * @ref Flag::UniformBuffers is not set.
+         * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+         * @requires_gles30 Skinning requires integer support in shaders,
+         *      which is not available in OpenGL ES 2.0 or WebGL 1.0.
+         */
+        Phong& setJointMatrix(UnsignedInt id, const Matrix4& matrix);
         #endif
 
         /**
@@ -793,10 +1789,35 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          *
          * Initial value is an identity matrix (i.e., an orthographic
          * projection of the default @f$ [ -\boldsymbol{1} ; \boldsymbol{1} ] @f$
-         * cube).
+         * cube). Expects that @ref Flag::Multiview is not set, use
+         * @ref setProjectionMatrices() in that case.
          */
         Phong& setProjectionMatrix(const Matrix4& matrix);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set per-view projection matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::Multiview is set and that @p matrices has
+         * exactly two items, the first used for the view with
+         * @glsl gl_ViewID_OVR @ce equal to @cpp 0 @ce and the second for
+         * the view with @glsl gl_ViewID_OVR @ce equal to @cpp 1 @ce. Initial
+         * value is an identity matrix for both. See
+         * @ref Shaders-Phong-multiview for more information.
+         * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Multiview is not available in WebGL 1.0.
+         */
+        Phong& setProjectionMatrices(Containers::ArrayView<const Matrix4> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& setProjectionMatrices(std::initializer_list<Matrix4> matrices);
+        #endif
+
         /**
          * @brief Set texture coordinate transformation matrix
          * @return Reference to self (for method chaining)
@@ -1007,7 +2028,274 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
          */
         Phong& setLightRange(UnsignedInt id, Float range);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the @ref TransformationUniform3D,
+         * @ref PhongDrawUniform and @ref TextureTransformationUniform buffers
+         * should be used for current draw. Expects that
+         * @ref Flag::UniformBuffers is set and @p offset is less than
+         * @ref drawCount(). Initial value is @cpp 0 @ce. If
+         * @ref Flag::MultiDraw is set, @glsl gl_DrawID @ce is added to this
+         * value, which makes each draw submitted via
+         * @ref draw(Containers::ArrayView<const Containers::Reference<GL::MeshView>>)
+         * pick up its own item.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain a single @ref ProjectionUniform3D instance.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationUniform3D.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref PhongDrawUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref PhongMaterialUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a light uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref lightCount() instances of
+         * @ref PhongLightUniform. If @ref lightCount() is zero, this function
+         * is a no-op, as lights don't contribute to the output in that case.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindLightBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a joint matrix uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set and
+         * @ref jointCount() is not zero. The buffer is expected to contain
+         * @ref jointCount() instances of @ref TransformationUniform3D. See
+         * @ref Shaders-Phong-skinning for more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Phong& bindJointBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindJointBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        #ifndef MAGNUM_TARGET_GLES
+        /**
+         * @brief Set a texture handle uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::BindlessTextures is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref PhongTextureHandleUniform. See @ref Shaders-Phong-bindless for
+         * more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_extension Extension @gl_extension{ARB,bindless_texture}
+         * @requires_gl Bindless textures are not available in OpenGL ES or
+         *      WebGL.
+         */
+        Phong& bindTextureHandleBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Phong& bindTextureHandleBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
+        /**
+         * @brief Set viewport size
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Used to calculate the screen-space tile a fragment is in. Expects
+         * that @ref Flag::ClusteredLights is set. Initial value is a zero
+         * vector. See @ref Shaders-Phong-clustered for more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         *      and @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Clustered lighting is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Clustered lighting is not available in WebGL
+         *      1.0.
+         */
+        Phong& setViewportSize(const Vector2& size);
+
+        /**
+         * @brief Set light cluster depth range
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Used to calculate the depth slice a fragment is in, pass
+         * @ref LightClusters::depthRange() here. Expects that
+         * @ref Flag::ClusteredLights is set and that the range is positive.
+         * See @ref Shaders-Phong-clustered for more information.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         *      and @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Clustered lighting is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Clustered lighting is not available in WebGL
+         *      1.0.
+         */
+        Phong& setLightClusterDepthRange(const Range1D& range);
+
+        /**
+         * @brief Bind a light cluster texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::ClusteredLights is set. Pass
+         * @ref LightClusters::clusterTexture() here.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         *      and @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Clustered lighting is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Clustered lighting is not available in WebGL
+         *      1.0.
+         */
+        Phong& bindLightClusterTexture(GL::Texture3D& texture);
+
+        /**
+         * @brief Bind a light cluster index texture
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::ClusteredLights is set. Pass
+         * @ref LightClusters::lightIndexTexture() here.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         *      and @gl_extension{EXT,texture_integer}
+         * @requires_gles30 Clustered lighting is not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Clustered lighting is not available in WebGL
+         *      1.0.
+         */
+        Phong& bindLightClusterIndexTexture(GL::Texture2D& texture);
+        #endif
+
     private:
+        /* Creates the GL shader program object but does nothing else.
+           Internal, used by compile(). */
+        explicit Phong(NoInitT) {}
+
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
         using GL::AbstractShaderProgram::drawTransformFeedback;
@@ -1018,6 +2306,14 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
 
         Flags _flags;
         UnsignedInt _lightCount;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{}, _jointCount{};
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0},
+            _viewportSizeUniform{1},
+            _lightClusterDepthScaleBiasUniform{2};
+        #endif
         Int _transformationMatrixUniform{0},
             _projectionMatrixUniform{1},
             _normalMatrixUniform{2},
@@ -1032,9 +2328,36 @@ class MAGNUM_SHADERS_EXPORT Phong: public GL::AbstractShaderProgram {
             Int _objectIdUniform{10};
             #endif
         Int _lightPositionsUniform{11},
-            _lightColorsUniform, /* 11 + lightCount, set in the constructor */
+            _lightColorsUniform, /* 11 + lightCount, set in compile() */
             _lightSpecularColorsUniform, /* 11 + 2*lightCount */
             _lightRangesUniform; /* 11 + 3*lightCount */
+        #ifndef MAGNUM_TARGET_GLES2
+        Int _jointMatricesUniform; /* 11 + 4*lightCount */
+        #endif
+};
+
+/**
+@brief Asynchronous compilation state
+@m_since_latest
+
+Returned by @ref Phong::compile(). See @ref shaders-async for more
+information.
+*/
+class Phong::CompileState: public Phong {
+    /* Everything deliberately private except for the inheritance */
+    friend class Phong;
+
+    explicit CompileState(NoCreateT): Phong{NoCreate}, _vert{NoCreate}, _frag{NoCreate} {}
+
+    explicit CompileState(Phong&& shader, GL::Shader&& vert, GL::Shader&& frag, GL::Version version): Phong{std::move(shader)}, _vert{std::move(vert)}, _frag{std::move(frag)}, _version{version} {}
+
+    /* If the program was loaded from a GL::ProgramBinaryCache, the shaders
+       are empty and nothing is checked */
+    GL::Shader _vert, _frag;
+    GL::Version _version;
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    std::string _cacheKey;
+    #endif
 };
 
 /** @debugoperatorclassenum{Phong,Phong::Flag} */
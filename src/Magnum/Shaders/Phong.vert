@@ -23,15 +23,32 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#if defined(INSTANCED_OBJECT_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#if (defined(INSTANCED_OBJECT_ID) || defined(JOINT_COUNT)) && !defined(GL_ES) && !defined(NEW_GLSL)
 #extension GL_EXT_gpu_shader4: require
 #endif
 
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
+#ifdef MULTI_DRAW
+#extension GL_ARB_shader_draw_parameters: require
+#endif
+
+#ifdef MULTIVIEW
+#extension GL_OVR_multiview2: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifdef MULTIVIEW
+layout(num_views = VIEW_COUNT) in;
+#endif
+
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -41,6 +58,16 @@ uniform highp mat4 transformationMatrix
     #endif
     ;
 
+#ifdef MULTIVIEW
+/* Not using an explicit location as the array would occupy VIEW_COUNT
+   locations */
+uniform highp mat4 projectionMatrices[VIEW_COUNT]
+    #ifndef GL_ES
+    = mat4[](mat4(1.0), mat4(1.0))
+    #endif
+    ;
+#define projectionMatrix projectionMatrices[gl_ViewID_OVR]
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 1)
 #endif
@@ -49,6 +76,7 @@ uniform highp mat4 projectionMatrix
     = mat4(1.0)
     #endif
     ;
+#endif
 
 #if LIGHT_COUNT
 #ifdef EXPLICIT_UNIFORM_LOCATION
@@ -84,6 +112,102 @@ uniform highp vec4 lightPositions[LIGHT_COUNT]
     ;
 #endif
 
+#ifdef JOINT_COUNT
+/* Follows the light arrays, uses locations JOINT_MATRICES_LOCATION to
+   JOINT_MATRICES_LOCATION + JOINT_COUNT - 1 */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = JOINT_MATRICES_LOCATION)
+#endif
+uniform highp mat4 jointMatrices[JOINT_COUNT]
+    #ifndef GL_ES
+    = mat4[](JOINT_MATRIX_INITIALIZER)
+    #endif
+    ;
+#endif
+
+/* Uniform buffers */
+
+#else
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 0
+    #endif
+) uniform Projection {
+    highp mat4 projectionMatrix;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 1
+    #endif
+) uniform Transformation {
+    highp mat4 transformationMatrices[DRAW_COUNT];
+};
+
+#if LIGHT_COUNT || defined(JOINT_COUNT)
+/* Has to match the declaration in Phong.frag */
+struct DrawUniform {
+    mediump mat3 normalMatrix;
+    highp uint materialId;
+    highp uint objectId;
+    highp uint lightOffset;
+    highp uint lightCount;
+    highp uint jointOffset;
+    highp uint reserved0;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+#endif
+
+#ifdef TEXTURE_TRANSFORMATION
+struct TextureTransformationUniform {
+    /* Columns of the rotation / scaling part, offset in the first two
+       components and the rest being padding */
+    highp vec4 rotationScaling;
+    highp vec4 offsetReserved;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 3
+    #endif
+) uniform TextureTransformation {
+    TextureTransformationUniform textureTransformations[DRAW_COUNT];
+};
+#endif
+
+#ifdef JOINT_COUNT
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 6
+    #endif
+) uniform Joint {
+    highp mat4 jointMatrices[JOINT_COUNT];
+};
+#endif
+
+#ifdef MULTI_DRAW
+flat out highp uint drawId;
+#endif
+#endif
+
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
 #endif
@@ -93,15 +217,23 @@ in highp vec4 position;
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = NORMAL_ATTRIBUTE_LOCATION)
 #endif
-in mediump vec3 normal;
+in mediump
+    #ifndef OCTAHEDRAL_NORMALS
+    vec3
+    #else
+    vec2
+    #endif
+    normal;
 
 #ifdef NORMAL_TEXTURE
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = TANGENT_ATTRIBUTE_LOCATION)
 #endif
 in mediump
-    #ifndef BITANGENT
+    #if !defined(BITANGENT) && !defined(OCTAHEDRAL_NORMALS)
     vec4
+    #elif defined(BITANGENT) && defined(OCTAHEDRAL_NORMALS)
+    vec2
     #else
     vec3
     #endif
@@ -112,7 +244,13 @@ in mediump
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = BITANGENT_ATTRIBUTE_LOCATION)
 #endif
-in mediump vec3 bitangent;
+in mediump
+    #ifndef OCTAHEDRAL_NORMALS
+    vec3
+    #else
+    vec2
+    #endif
+    bitangent;
 #endif
 #endif
 
@@ -162,6 +300,18 @@ layout(location = TEXTURE_OFFSET_ATTRIBUTE_LOCATION)
 in mediump vec2 instancedTextureOffset;
 #endif
 
+#ifdef JOINT_COUNT
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = WEIGHTS_ATTRIBUTE_LOCATION)
+#endif
+in mediump vec4 weights;
+
+#ifdef EXPLICIT_ATTRIB_LOCATION
+layout(location = JOINT_IDS_ATTRIBUTE_LOCATION)
+#endif
+in mediump uvec4 jointIds;
+#endif
+
 #if LIGHT_COUNT
 out mediump vec3 transformedNormal;
 #ifdef NORMAL_TEXTURE
@@ -172,51 +322,138 @@ out mediump vec3 transformedTangent;
 out mediump vec3 transformedBitangent;
 #endif
 #endif
+#ifndef UNIFORM_BUFFERS
 out highp vec4 lightDirections[LIGHT_COUNT];
+#else
+/* With uniform buffers the set of lights is known only per draw, so the
+   light directions are calculated in the fragment shader */
+out highp vec3 transformedPosition;
+#endif
 out highp vec3 cameraDirection;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    #ifdef MULTI_DRAW
+    drawId = drawOffset + uint(gl_DrawIDARB);
+    #else
+    #define drawId drawOffset
+    #endif
+    highp mat4 transformationMatrix = transformationMatrices[drawId];
+    #if LIGHT_COUNT
+    mediump mat3 normalMatrix = draws[drawId].normalMatrix;
+    #endif
+    #ifdef TEXTURE_TRANSFORMATION
+    mediump mat3 textureMatrix = mat3(
+        vec3(textureTransformations[drawId].rotationScaling.xy, 0.0),
+        vec3(textureTransformations[drawId].rotationScaling.zw, 0.0),
+        vec3(textureTransformations[drawId].offsetReserved.xy, 1.0));
+    #endif
+    #ifdef JOINT_COUNT
+    highp uint jointOffset = draws[drawId].jointOffset;
+    #endif
+    #else
+    #define jointOffset 0u
+    #endif
+
+    #ifdef JOINT_COUNT
+    /* Blend matrices of all joints affecting this vertex. The rotation /
+       scaling part is used for normals and tangents, which is correct only
+       for joints without non-uniform scaling, same as is common practice. */
+    highp mat4 skinMatrix =
+        weights.x*jointMatrices[jointOffset + jointIds.x] +
+        weights.y*jointMatrices[jointOffset + jointIds.y] +
+        weights.z*jointMatrices[jointOffset + jointIds.z] +
+        weights.w*jointMatrices[jointOffset + jointIds.w];
+    #if LIGHT_COUNT
+    mediump mat3 skinNormalMatrix = mat3(skinMatrix);
+    #endif
+    #endif
+
     /* Transformed vertex position */
     highp vec4 transformedPosition4 = transformationMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedTransformationMatrix*
         #endif
+        #ifdef JOINT_COUNT
+        skinMatrix*
+        #endif
         position;
-    highp vec3 transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
+    #if !defined(UNIFORM_BUFFERS) || !LIGHT_COUNT
+    highp vec3
+    #endif
+    transformedPosition = transformedPosition4.xyz/transformedPosition4.w;
 
     #if LIGHT_COUNT
+    /* Decode octahedral normal and tangent vectors, if used */
+    #ifndef OCTAHEDRAL_NORMALS
+    mediump vec3 vertexNormal = normal;
+    #else
+    mediump vec3 vertexNormal = unpackOctahedral(normal);
+    #endif
+    #ifdef NORMAL_TEXTURE
+    #ifndef BITANGENT
+    #ifndef OCTAHEDRAL_NORMALS
+    mediump vec4 vertexTangent = tangent;
+    #else
+    mediump vec4 vertexTangent = vec4(unpackOctahedral(tangent.xy), tangent.z);
+    #endif
+    #else
+    #ifndef OCTAHEDRAL_NORMALS
+    mediump vec3 vertexTangent = tangent;
+    mediump vec3 vertexBitangent = bitangent;
+    #else
+    mediump vec3 vertexTangent = unpackOctahedral(tangent);
+    mediump vec3 vertexBitangent = unpackOctahedral(bitangent);
+    #endif
+    #endif
+    #endif
+
     /* Transformed normal and tangent vector */
     transformedNormal = normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
-        normal;
+        #ifdef JOINT_COUNT
+        skinNormalMatrix*
+        #endif
+        vertexNormal;
     #ifdef NORMAL_TEXTURE
     #ifndef BITANGENT
     transformedTangent = vec4(normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
-        tangent.xyz, tangent.w);
+        #ifdef JOINT_COUNT
+        skinNormalMatrix*
+        #endif
+        vertexTangent.xyz, vertexTangent.w);
     #else
     transformedTangent = normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
-        tangent;
+        #ifdef JOINT_COUNT
+        skinNormalMatrix*
+        #endif
+        vertexTangent;
     transformedBitangent = normalMatrix*
         #ifdef INSTANCED_TRANSFORMATION
         instancedNormalMatrix*
         #endif
-        bitangent;
+        #ifdef JOINT_COUNT
+        skinNormalMatrix*
+        #endif
+        vertexBitangent;
     #endif
     #endif
 
+    #ifndef UNIFORM_BUFFERS
     /* Direction to the light. Directional lights have the last component set
        to 0, which gets used to ignore the transformed position. */
     for(int i = 0; i < LIGHT_COUNT; ++i)
         lightDirections[i] = vec4(lightPositions[i].xyz - transformedPosition*lightPositions[i].w, lightPositions[i].w);
+    #endif
 
     /* Direction to the camera */
     cameraDirection = -transformedPosition;
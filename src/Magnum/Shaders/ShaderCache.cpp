@@ -0,0 +1,163 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ShaderCache.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    /* The shader is created once the compilation is finalized, keeping it
+       behind a pointer so references to it survive array growth */
+    template<class Shader, class Key> struct Entry {
+        Key key;
+        Containers::Pointer<typename Shader::CompileState> compileState;
+        Containers::Pointer<Shader> shader;
+    };
+
+    struct PhongKey {
+        Phong::Flags flags;
+        UnsignedInt lightCount;
+
+        bool operator==(const PhongKey& other) const {
+            return flags == other.flags && lightCount == other.lightCount;
+        }
+    };
+
+    typedef Entry<Phong, PhongKey> PhongEntry;
+    typedef Entry<Flat2D, Flat2D::Flags> Flat2DEntry;
+    typedef Entry<Flat3D, Flat3D::Flags> Flat3DEntry;
+
+    template<class Shader, class Key> Entry<Shader, Key>* find(Containers::Array<Entry<Shader, Key>>& entries, const Key& key) {
+        for(Entry<Shader, Key>& entry: entries)
+            if(entry.key == key) return &entry;
+        return nullptr;
+    }
+
+    template<class Shader, class Key> void finalize(Entry<Shader, Key>& entry) {
+        entry.shader = Containers::pointer<Shader>(std::move(*entry.compileState));
+        entry.compileState = nullptr;
+    }
+
+    template<class Shader, class Key> std::size_t pendingCount(const Containers::Array<Entry<Shader, Key>>& entries) {
+        std::size_t count = 0;
+        for(const Entry<Shader, Key>& entry: entries)
+            if(entry.compileState) ++count;
+        return count;
+    }
+
+    template<class Shader, class Key> std::size_t update(Containers::Array<Entry<Shader, Key>>& entries) {
+        std::size_t count = 0;
+        for(Entry<Shader, Key>& entry: entries) {
+            if(!entry.compileState) continue;
+            if(entry.compileState->isLinkFinished()) finalize(entry);
+            else ++count;
+        }
+        return count;
+    }
+
+    template<class Shader, class Key> void finish(Containers::Array<Entry<Shader, Key>>& entries) {
+        for(Entry<Shader, Key>& entry: entries)
+            if(entry.compileState) finalize(entry);
+    }
+
+    template<class Shader, class Key> Shader& get(Entry<Shader, Key>& entry) {
+        if(entry.compileState) finalize(entry);
+        return *entry.shader;
+    }
+}
+
+struct ShaderCache::State {
+    Containers::Array<PhongEntry> phong;
+    Containers::Array<Flat2DEntry> flat2D;
+    Containers::Array<Flat3DEntry> flat3D;
+};
+
+ShaderCache::ShaderCache(): _state{Containers::InPlaceInit} {}
+
+ShaderCache::ShaderCache(ShaderCache&&) noexcept = default;
+
+ShaderCache::~ShaderCache() = default;
+
+ShaderCache& ShaderCache::operator=(ShaderCache&&) noexcept = default;
+
+std::size_t ShaderCache::count() const {
+    return _state->phong.size() + _state->flat2D.size() + _state->flat3D.size();
+}
+
+std::size_t ShaderCache::pendingCount() const {
+    return Shaders::pendingCount(_state->phong) +
+        Shaders::pendingCount(_state->flat2D) +
+        Shaders::pendingCount(_state->flat3D);
+}
+
+ShaderCache& ShaderCache::addPhong(const Phong::Flags flags, const UnsignedInt lightCount) {
+    const PhongKey key{flags, lightCount};
+    if(!find(_state->phong, key))
+        arrayAppend(_state->phong, PhongEntry{key, Containers::pointer<Phong::CompileState>(Phong::compile(flags, lightCount)), nullptr});
+    return *this;
+}
+
+ShaderCache& ShaderCache::addFlat2D(const Flat2D::Flags flags) {
+    if(!find(_state->flat2D, flags))
+        arrayAppend(_state->flat2D, Flat2DEntry{flags, Containers::pointer<Flat2D::CompileState>(Flat2D::compile(flags)), nullptr});
+    return *this;
+}
+
+ShaderCache& ShaderCache::addFlat3D(const Flat3D::Flags flags) {
+    if(!find(_state->flat3D, flags))
+        arrayAppend(_state->flat3D, Flat3DEntry{flags, Containers::pointer<Flat3D::CompileState>(Flat3D::compile(flags)), nullptr});
+    return *this;
+}
+
+std::size_t ShaderCache::update() {
+    return Shaders::update(_state->phong) +
+        Shaders::update(_state->flat2D) +
+        Shaders::update(_state->flat3D);
+}
+
+void ShaderCache::finish() {
+    Shaders::finish(_state->phong);
+    Shaders::finish(_state->flat2D);
+    Shaders::finish(_state->flat3D);
+}
+
+Phong& ShaderCache::phong(const Phong::Flags flags, const UnsignedInt lightCount) {
+    addPhong(flags, lightCount);
+    return get(*find(_state->phong, PhongKey{flags, lightCount}));
+}
+
+Flat2D& ShaderCache::flat2D(const Flat2D::Flags flags) {
+    addFlat2D(flags);
+    return get(*find(_state->flat2D, flags));
+}
+
+Flat3D& ShaderCache::flat3D(const Flat3D::Flags flags) {
+    addFlat3D(flags);
+    return get(*find(_state->flat3D, flags));
+}
+
+}}
@@ -0,0 +1,201 @@
+#ifndef Magnum_Shaders_ShaderCache_h
+#define Magnum_Shaders_ShaderCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::ShaderCache
+ * @m_since_latest
+ */
+
+#include <cstddef>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Shaders/Phong.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Cache of builtin shader variants
+@m_since_latest
+
+Builtin shaders such as @ref Phong or @ref Flat have many variants selected by
+their flags and light count, and creating them lazily on first use causes
+stalls in the middle of a frame. This class instead gets all variants a scene
+needs up front, submits them for compilation together, and then hands out
+shared instances identified by the same parameters.
+
+@section Shaders-ShaderCache-usage Usage
+
+Variants are added with @ref addPhong(), @ref addFlat2D() and
+@ref addFlat3D(). Adding a variant that's already present is a no-op, so
+it's possible to go through all materials in a scene and add a variant for
+each without checking for duplicates. The mapping from materials to shader
+flags is application-specific, an example for @ref Trade::MaterialData could
+look like this:
+
+@snippet MagnumShaders.cpp ShaderCache-usage
+
+The variants are compiled and linked asynchronously as described in
+@ref shaders-async, which means all of them can be processed in parallel if
+the driver supports @gl_extension{KHR,parallel_shader_compile}. Call
+@ref update() periodically to finalize the variants whose linking is done
+without blocking, or @ref finish() to wait for all of them. Shader instances
+are then retrieved with @ref phong(), @ref flat2D() and @ref flat3D(). The
+returned references stay valid for the whole lifetime of the cache. If a
+requested variant is still being compiled, the call waits for it; if it wasn't
+added at all, it's compiled on the spot.
+
+@section Shaders-ShaderCache-binary Persisting compiled variants
+
+The cache doesn't store anything on its own. To avoid compiling the variants
+again on the next run, set up a @ref GL::ProgramBinaryCache with
+@ref GL::Context::setProgramBinaryCache() before adding the variants --- they
+then get loaded from it directly and saved to it after they're finalized.
+
+@snippet MagnumShaders.cpp ShaderCache-binary
+
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT ShaderCache {
+    public:
+        /** @brief Constructor */
+        explicit ShaderCache();
+
+        /** @brief Copying is not allowed */
+        ShaderCache(const ShaderCache&) = delete;
+
+        /** @brief Move constructor */
+        ShaderCache(ShaderCache&&) noexcept;
+
+        ~ShaderCache();
+
+        /** @brief Copying is not allowed */
+        ShaderCache& operator=(const ShaderCache&) = delete;
+
+        /** @brief Move assignment */
+        ShaderCache& operator=(ShaderCache&&) noexcept;
+
+        /**
+         * @brief Count of variants
+         *
+         * Includes variants that are still being compiled.
+         */
+        std::size_t count() const;
+
+        /**
+         * @brief Count of variants that are still being compiled
+         *
+         * @see @ref update(), @ref finish()
+         */
+        std::size_t pendingCount() const;
+
+        /**
+         * @brief Add a @ref Phong variant
+         * @return Reference to self (for method chaining)
+         *
+         * If a variant with the same @p flags and @p lightCount is already
+         * present, does nothing. Otherwise submits it for compilation via
+         * @ref Phong::compile(Phong::Flags, UnsignedInt).
+         */
+        ShaderCache& addPhong(Phong::Flags flags, UnsignedInt lightCount = 1);
+
+        /**
+         * @brief Add a @ref Flat2D variant
+         * @return Reference to self (for method chaining)
+         *
+         * If a variant with the same @p flags is already present, does
+         * nothing. Otherwise submits it for compilation via
+         * @ref Flat::compile(Flags).
+         */
+        ShaderCache& addFlat2D(Flat2D::Flags flags = {});
+
+        /**
+         * @brief Add a @ref Flat3D variant
+         * @return Reference to self (for method chaining)
+         *
+         * If a variant with the same @p flags is already present, does
+         * nothing. Otherwise submits it for compilation via
+         * @ref Flat::compile(Flags).
+         */
+        ShaderCache& addFlat3D(Flat3D::Flags flags = {});
+
+        /**
+         * @brief Finalize variants that finished linking
+         * @return Count of variants that are still being compiled
+         *
+         * Doesn't block. Finalizes all variants for which
+         * @ref GL::AbstractShaderProgram::isLinkFinished() returns
+         * @cpp true @ce. Call periodically while doing other work, for
+         * example loading the scene data.
+         * @see @ref pendingCount(), @ref finish()
+         */
+        std::size_t update();
+
+        /**
+         * @brief Finalize all variants
+         *
+         * Blocks until all variants are compiled and linked. After calling
+         * this function, @ref pendingCount() is @cpp 0 @ce.
+         * @see @ref update()
+         */
+        void finish();
+
+        /**
+         * @brief Get a @ref Phong variant
+         *
+         * If the variant is still being compiled, waits for it. If it wasn't
+         * added, compiles it synchronously. The returned reference is valid
+         * for the whole lifetime of the cache.
+         */
+        Phong& phong(Phong::Flags flags, UnsignedInt lightCount = 1);
+
+        /**
+         * @brief Get a @ref Flat2D variant
+         *
+         * If the variant is still being compiled, waits for it. If it wasn't
+         * added, compiles it synchronously. The returned reference is valid
+         * for the whole lifetime of the cache.
+         */
+        Flat2D& flat2D(Flat2D::Flags flags = {});
+
+        /**
+         * @brief Get a @ref Flat3D variant
+         *
+         * If the variant is still being compiled, waits for it. If it wasn't
+         * added, compiles it synchronously. The returned reference is valid
+         * for the whole lifetime of the cache.
+         */
+        Flat3D& flat3D(Flat3D::Flags flags = {});
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
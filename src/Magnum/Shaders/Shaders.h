@@ -38,6 +38,12 @@
 namespace Magnum { namespace Shaders {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_TARGET_GLES2
+class CascadedShadowMap;
+#endif
+
+class DepthOnly;
+
 template<UnsignedInt> class DistanceFieldVector;
 typedef DistanceFieldVector<2> DistanceFieldVector2D;
 typedef DistanceFieldVector<3> DistanceFieldVector3D;
@@ -52,13 +58,34 @@ typedef Flat<3> Flat3D;
 
 /* Generic is used only statically */
 
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt> class InstanceBuffer;
+typedef InstanceBuffer<2> InstanceBuffer2D;
+typedef InstanceBuffer<3> InstanceBuffer3D;
+#endif
+
+#ifndef MAGNUM_TARGET_GLES2
+class LightClusters;
+#endif
+
 class MeshVisualizer2D;
 class MeshVisualizer3D;
 #ifdef MAGNUM_BUILD_DEPRECATED
 typedef CORRADE_DEPRECATED("use MeshVisualizer3D instead") MeshVisualizer3D MeshVisualizer;
 #endif
 
+#ifndef MAGNUM_TARGET_GLES2
+class MorphTargets;
+class ParticleSystem;
+class ParticleUpdate;
+#endif
+
 class Phong;
+class ShaderCache;
+
+#ifndef MAGNUM_TARGET_GLES2
+class Terrain;
+#endif
 
 template<UnsignedInt> class Vector;
 typedef Vector<2> Vector2D;
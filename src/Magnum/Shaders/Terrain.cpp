@@ -0,0 +1,211 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Terrain.h"
+
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#ifndef MAGNUM_TARGET_WEBGL
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+namespace Magnum { namespace Shaders {
+
+namespace {
+    enum: Int {
+        HeightTextureUnit = 0,
+        ColorTextureUnit = 1
+    };
+}
+
+Terrain::Terrain(const Flags flags): _flags{flags} {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumShaders"))
+        importShaderResources();
+    #endif
+    Utility::Resource rs("MagnumShaders");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version version = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL310, GL::Version::GL300});
+    #else
+    const GL::Version version = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Vertex);
+    GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
+
+    vert.addSource(flags & Flag::ColorTexture ? "#define COLOR_TEXTURE\n" : "")
+        .addSource(rs.get("Terrain.vert"));
+    frag.addSource(flags & Flag::ColorTexture ? "#define COLOR_TEXTURE\n" : "")
+        .addSource(rs.get("generic.glsl"))
+        .addSource(rs.get("Terrain.frag"));
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(!cache || !cache->load(*this, cacheKey))
+    #endif
+    {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        /* No attributes to bind, everything is calculated from gl_VertexID */
+        attachShaders({vert, frag});
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #ifndef MAGNUM_TARGET_WEBGL
+        if(cache) cache->save(*this, cacheKey);
+        #endif
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
+    #endif
+    {
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        _patchUniform = uniformLocation("patch");
+        _cellCountUniform = uniformLocation("cellCount");
+        _neighborCellCountsUniform = uniformLocation("neighborCellCounts");
+        _heightScaleUniform = uniformLocation("heightScale");
+        _lightDirectionUniform = uniformLocation("lightDirection");
+        _colorUniform = uniformLocation("color");
+        _ambientColorUniform = uniformLocation("ambientColor");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shading_language_420pack>(version))
+    #endif
+    {
+        setUniform(uniformLocation("heightTexture"), HeightTextureUnit);
+        if(flags & Flag::ColorTexture)
+            setUniform(uniformLocation("colorTexture"), ColorTextureUnit);
+    }
+
+    /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
+    #ifdef MAGNUM_TARGET_GLES
+    setTransformationProjectionMatrix(Matrix4{Math::IdentityInit});
+    setPatch({{-1.0f, -1.0f}, {1.0f, 1.0f}});
+    setCellCount(1);
+    setHeightScale(1.0f);
+    setLightDirection(Vector3::zAxis());
+    setColor(Color4{1.0f});
+    /* Ambient color is zero by default */
+    #endif
+}
+
+Terrain& Terrain::setTransformationProjectionMatrix(const Matrix4& matrix) {
+    setUniform(_transformationProjectionMatrixUniform, matrix);
+    return *this;
+}
+
+Terrain& Terrain::setPatch(const Range2D& patch) {
+    setUniform(_patchUniform, Vector4{patch.min().x(), patch.min().y(),
+                                      patch.sizeX(), patch.sizeY()});
+    return *this;
+}
+
+Terrain& Terrain::setCellCount(const UnsignedInt cellCount, const Vector4ui& neighborCellCounts) {
+    CORRADE_ASSERT(cellCount,
+        "Shaders::Terrain::setCellCount(): expected non-zero cell count", *this);
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != 4; ++i)
+        CORRADE_ASSERT(neighborCellCounts[i] >= cellCount || (neighborCellCounts[i] && cellCount % neighborCellCounts[i] == 0),
+            "Shaders::Terrain::setCellCount(): neighbor cell count" << neighborCellCounts[i] << "is not a divisor of" << cellCount, *this);
+    #endif
+    setUniform(_cellCountUniform, Int(cellCount));
+    setUniform(_neighborCellCountsUniform, Vector4i{neighborCellCounts});
+    return *this;
+}
+
+Terrain& Terrain::setCellCount(const UnsignedInt cellCount) {
+    return setCellCount(cellCount, Vector4ui{cellCount});
+}
+
+Terrain& Terrain::setHeightScale(const Float scale) {
+    setUniform(_heightScaleUniform, scale);
+    return *this;
+}
+
+Terrain& Terrain::setLightDirection(const Vector3& direction) {
+    setUniform(_lightDirectionUniform, direction);
+    return *this;
+}
+
+Terrain& Terrain::setColor(const Color4& color) {
+    setUniform(_colorUniform, color);
+    return *this;
+}
+
+Terrain& Terrain::setAmbientColor(const Color4& color) {
+    setUniform(_ambientColorUniform, color);
+    return *this;
+}
+
+Terrain& Terrain::bindHeightTexture(GL::Texture2D& texture) {
+    texture.bind(HeightTextureUnit);
+    return *this;
+}
+
+Terrain& Terrain::bindColorTexture(GL::Texture2D& texture) {
+    CORRADE_ASSERT(_flags & Flag::ColorTexture,
+        "Shaders::Terrain::bindColorTexture(): the shader was not created with color texture enabled", *this);
+    texture.bind(ColorTextureUnit);
+    return *this;
+}
+
+Debug& operator<<(Debug& debug, const Terrain::Flag value) {
+    debug << "Shaders::Terrain::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case Terrain::Flag::v: return debug << "::" #v;
+        _c(ColorTexture)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Terrain::Flags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::Terrain::Flags{}", {
+        Terrain::Flag::ColorTexture});
+}
+
+}}
@@ -0,0 +1,292 @@
+#ifndef Magnum_Shaders_Terrain_h
+#define Magnum_Shaders_Terrain_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Shaders::Terrain
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/Shaders/visibility.h"
+
+namespace Magnum { namespace Shaders {
+
+/**
+@brief Procedural terrain shader
+@m_since_latest
+
+Draws a heightmapped terrain patch without any vertex data. Vertex positions
+are reconstructed from @glsl gl_VertexID @ce, heights are sampled from a
+texture bound with @ref bindHeightTexture() and normals are calculated from
+neighboring texels of the same texture. The shader is meant to be used with an
+attribute-less mesh created from @ref Primitives::grid3DProcedural(), which
+means a large terrain costs nothing in vertex memory, only the height texture.
+
+The whole terrain spans the @f$ [-1, 1] @f$ range on the XY plane, same as
+@ref Primitives::grid3DSolid(), with the height texture and an optional color
+texture stretched over it and heights going in the positive Z direction. The
+terrain is drawn in patches, each set with @ref setPatch(), and each with a
+cell count set with @ref setCellCount(). The mesh is drawn with
+@ref vertexCount() vertices for given cell count, so a single mesh created for
+the finest level of detail can be used for all patches:
+
+@snippet MagnumShaders.cpp Terrain-usage
+
+The shading is a single directional light with color set via @ref setColor()
+and a light direction in the terrain model space set via
+@ref setLightDirection(), plus an ambient term from @ref setAmbientColor().
+With @ref Flag::ColorTexture the color is additionally multiplied with a
+texture bound with @ref bindColorTexture().
+
+@section Shaders-Terrain-lod Level of detail
+
+Patches further from the camera can be drawn with fewer cells. To avoid cracks
+between patches with different cell counts, pass cell counts of the four
+neighbors to @ref setCellCount(UnsignedInt, const Vector4ui&). Vertices on an
+edge shared with a coarser neighbor are then snapped to the neighbor vertices.
+The coarser neighbor cell counts are expected to be divisors of the patch cell
+count, which is always the case when the cell counts are powers of two. The
+edges shared with neighbors that have the same or a larger cell count are left
+unchanged, as the neighbor is then responsible for matching this patch.
+
+@requires_gl30 The @glsl gl_VertexID @ce builtin is not available in OpenGL
+    2.1.
+@requires_gles30 The @glsl gl_VertexID @ce builtin is not available in OpenGL
+    ES 2.0.
+@requires_webgl20 The @glsl gl_VertexID @ce builtin is not available in WebGL
+    1.0.
+@see @ref shaders
+*/
+class MAGNUM_SHADERS_EXPORT Terrain: public GL::AbstractShaderProgram {
+    public:
+        /**
+         * @brief Flag
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Multiply the color with a texture bound with
+             * @ref bindColorTexture(). The texture spans the whole terrain.
+             */
+            ColorTexture = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Vertex count for given cell count
+         *
+         * Count of vertices to draw for a patch with @p cellCount cells in
+         * each direction, equivalent to @cpp 6*cellCount*cellCount @ce. Pass
+         * it to @ref GL::Mesh::setCount() before drawing.
+         * @see @ref Primitives::grid3DProcedural()
+         */
+        static constexpr UnsignedInt vertexCount(UnsignedInt cellCount) {
+            return 6*cellCount*cellCount;
+        }
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit Terrain(Flags flags = {});
+
+        /**
+         * @brief Construct without creating the underlying OpenGL object
+         *
+         * The constructed instance is equivalent to a moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         *
+         * This function can be safely used for constructing (and later
+         * destructing) objects even without any OpenGL context being active.
+         * However note that this is a low-level and a potentially dangerous
+         * API, see the documentation of @ref NoCreate for alternatives.
+         */
+        explicit Terrain(NoCreateT) noexcept: AbstractShaderProgram{NoCreate} {}
+
+        /** @brief Copying is not allowed */
+        Terrain(const Terrain&) = delete;
+
+        /** @brief Move constructor */
+        Terrain(Terrain&&) noexcept = default;
+
+        /** @brief Copying is not allowed */
+        Terrain& operator=(const Terrain&) = delete;
+
+        /** @brief Move assignment */
+        Terrain& operator=(Terrain&&) noexcept = default;
+
+        /** @brief Flags */
+        Flags flags() const { return _flags; }
+
+        /**
+         * @brief Set transformation and projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Default is an identity matrix.
+         */
+        Terrain& setTransformationProjectionMatrix(const Matrix4& matrix);
+
+        /**
+         * @brief Set patch area
+         * @return Reference to self (for method chaining)
+         *
+         * Area of the terrain covered by the patch that's drawn next, in the
+         * @f$ [-1, 1] @f$ range of the whole terrain. Default is
+         * @cpp {{-1.0f, -1.0f}, {1.0f, 1.0f}} @ce, i.e. the whole terrain.
+         */
+        Terrain& setPatch(const Range2D& patch);
+
+        /**
+         * @brief Set patch cell count
+         * @return Reference to self (for method chaining)
+         *
+         * Count of cells in each direction of the patch that's drawn next.
+         * The mesh is expected to be drawn with @ref vertexCount() vertices
+         * for the same cell count. Neighbor cell counts are in order
+         * @f$ -X @f$, @f$ +X @f$, @f$ -Y @f$ and @f$ +Y @f$, see
+         * @ref Shaders-Terrain-lod for more information. Expects that
+         * @p cellCount is not zero and all neighbor cell counts are either
+         * not less than @p cellCount or are its divisors. Default is
+         * @cpp 1 @ce for all.
+         */
+        Terrain& setCellCount(UnsignedInt cellCount, const Vector4ui& neighborCellCounts);
+
+        /**
+         * @brief Set patch cell count with all neighbors having the same
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref setCellCount(UnsignedInt, const Vector4ui&)
+         * with @p cellCount used for all neighbors.
+         */
+        Terrain& setCellCount(UnsignedInt cellCount);
+
+        /**
+         * @brief Set height scale
+         * @return Reference to self (for method chaining)
+         *
+         * The first channel of the height texture is multiplied by this
+         * value to get the height in model space. Default is @cpp 1.0f @ce.
+         */
+        Terrain& setHeightScale(Float scale);
+
+        /**
+         * @brief Set light direction
+         * @return Reference to self (for method chaining)
+         *
+         * Direction towards the light in terrain model space, expected to be
+         * normalized. Default is @cpp {0.0f, 0.0f, 1.0f} @ce, i.e. a light
+         * directly above the terrain.
+         */
+        Terrain& setLightDirection(const Vector3& direction);
+
+        /**
+         * @brief Set color
+         * @return Reference to self (for method chaining)
+         *
+         * If @ref Flag::ColorTexture is set, the color is multiplied with the
+         * texture. Default is @cpp 0xffffffff_rgbaf @ce.
+         */
+        Terrain& setColor(const Color4& color);
+
+        /**
+         * @brief Set ambient color
+         * @return Reference to self (for method chaining)
+         *
+         * Added to the diffuse light contribution before multiplying with
+         * the color. Default is @cpp 0x00000000_rgbaf @ce.
+         */
+        Terrain& setAmbientColor(const Color4& color);
+
+        /**
+         * @brief Bind a height texture
+         * @return Reference to self (for method chaining)
+         *
+         * Only the first channel is used. The texture is sampled in the
+         * vertex shader without mipmaps, so a floating-point or a normalized
+         * single-channel format with nearest or linear filtering is
+         * recommended.
+         * @see @ref setHeightScale()
+         */
+        Terrain& bindHeightTexture(GL::Texture2D& texture);
+
+        /**
+         * @brief Bind a color texture
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the shader was created with @ref Flag::ColorTexture
+         * enabled.
+         * @see @ref setColor()
+         */
+        Terrain& bindColorTexture(GL::Texture2D& texture);
+
+    private:
+        /* Prevent accidentally calling irrelevant functions */
+        #ifndef MAGNUM_TARGET_GLES
+        using GL::AbstractShaderProgram::drawTransformFeedback;
+        #endif
+        #ifndef MAGNUM_TARGET_WEBGL
+        using GL::AbstractShaderProgram::dispatchCompute;
+        #endif
+
+        Flags _flags;
+        Int _transformationProjectionMatrixUniform{0},
+            _patchUniform{1},
+            _cellCountUniform{2},
+            _neighborCellCountsUniform{3},
+            _heightScaleUniform{4},
+            _lightDirectionUniform{5},
+            _colorUniform{6},
+            _ambientColorUniform{7};
+};
+
+/** @debugoperatorclassenum{Terrain,Terrain::Flag} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, Terrain::Flag value);
+
+/** @debugoperatorclassenum{Terrain,Terrain::Flags} */
+MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, Terrain::Flags value);
+
+CORRADE_ENUMSET_OPERATORS(Terrain::Flags)
+
+}}
+#else
+#error this header is not available in OpenGL ES 2.0 build
+#endif
+
+#endif
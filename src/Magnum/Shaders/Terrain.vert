@@ -0,0 +1,138 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp mat4 transformationProjectionMatrix
+    #ifndef GL_ES
+    = mat4(1.0)
+    #endif
+    ;
+
+/* Patch offset in XY, size in ZW */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 1)
+#endif
+uniform highp vec4 patch
+    #ifndef GL_ES
+    = vec4(-1.0, -1.0, 2.0, 2.0)
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform mediump int cellCount
+    #ifndef GL_ES
+    = 1
+    #endif
+    ;
+
+/* Cell counts of neighbors in -X, +X, -Y and +Y */
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 3)
+#endif
+uniform mediump ivec4 neighborCellCounts
+    #ifndef GL_ES
+    = ivec4(1)
+    #endif
+    ;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 4)
+#endif
+uniform highp float heightScale
+    #ifndef GL_ES
+    = 1.0
+    #endif
+    ;
+
+/* Locations 5 to 7 are used in the fragment shader */
+
+#ifdef EXPLICIT_TEXTURE_LAYER
+layout(binding = 0)
+#endif
+uniform highp sampler2D heightTexture;
+
+out mediump vec3 normal;
+
+#ifdef COLOR_TEXTURE
+out mediump vec2 interpolatedTextureCoordinates;
+#endif
+
+/* Corners of the two triangles in each cell, same as in
+   Primitives::grid3DSolid() */
+const lowp ivec2 cellCorners[6] = ivec2[](
+    ivec2(0, 0), ivec2(1, 1), ivec2(0, 1),
+    ivec2(0, 0), ivec2(1, 0), ivec2(1, 1));
+
+highp float height(highp vec2 textureCoordinates) {
+    return textureLod(heightTexture, textureCoordinates, 0.0).r*heightScale;
+}
+
+void main() {
+    mediump int cell = gl_VertexID/6;
+    mediump ivec2 position = ivec2(cell % cellCount, cell/cellCount) + cellCorners[gl_VertexID % 6];
+
+    /* Snap vertices on edges shared with a coarser neighbor to vertices of
+       the neighbor to avoid T-junction cracks. The triangles next to the
+       edge become degenerate or get stretched to cover the gap. */
+    if(position.x == 0 && neighborCellCounts.x < cellCount) {
+        mediump int step = cellCount/neighborCellCounts.x;
+        position.y = (position.y/step)*step;
+    } else if(position.x == cellCount && neighborCellCounts.y < cellCount) {
+        mediump int step = cellCount/neighborCellCounts.y;
+        position.y = (position.y/step)*step;
+    }
+    if(position.y == 0 && neighborCellCounts.z < cellCount) {
+        mediump int step = cellCount/neighborCellCounts.z;
+        position.x = (position.x/step)*step;
+    } else if(position.y == cellCount && neighborCellCounts.w < cellCount) {
+        mediump int step = cellCount/neighborCellCounts.w;
+        position.x = (position.x/step)*step;
+    }
+
+    /* The whole terrain spans [-1, 1], the textures span [0, 1] */
+    highp vec2 xy = patch.xy + vec2(position)/float(cellCount)*patch.zw;
+    highp vec2 textureCoordinates = xy*0.5 + vec2(0.5);
+
+    /* Normal from central differences of neighboring texels. A texel is
+       twice its texture coordinate size in model space and the difference
+       spans two texels. */
+    highp vec2 texelSize = vec2(1.0)/vec2(textureSize(heightTexture, 0));
+    highp vec2 slope = vec2(
+        height(textureCoordinates + vec2(texelSize.x, 0.0)) -
+        height(textureCoordinates - vec2(texelSize.x, 0.0)),
+        height(textureCoordinates + vec2(0.0, texelSize.y)) -
+        height(textureCoordinates - vec2(0.0, texelSize.y)))/(4.0*texelSize);
+    normal = normalize(vec3(-slope, 1.0));
+
+    #ifdef COLOR_TEXTURE
+    interpolatedTextureCoordinates = textureCoordinates;
+    #endif
+
+    gl_Position = transformationProjectionMatrix*vec4(xy, height(textureCoordinates), 1.0);
+}
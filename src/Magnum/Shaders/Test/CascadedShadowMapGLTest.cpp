@@ -0,0 +1,305 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/Math/Frustum.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/CascadedShadowMap.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct CascadedShadowMapGLTest: GL::OpenGLTester {
+    explicit CascadedShadowMapGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+
+    void constructInvalid();
+
+    void update();
+    void updateMaxDistance();
+    void updateInvalid();
+    void setSplitLambdaInvalid();
+
+    void cull();
+    void bindCascade();
+    void indexOutOfRange();
+};
+
+using namespace Math::Literals;
+
+constexpr struct {
+    const char* name;
+    Float lambda;
+    Float splits[2];
+} UpdateData[]{
+    {"logarithmic", 1.0f, {10.0f, 100.0f}},
+    {"uniform", 0.0f, {50.5f, 100.0f}},
+    {"practical", 0.5f, {30.25f, 100.0f}}
+};
+
+CascadedShadowMapGLTest::CascadedShadowMapGLTest() {
+    addTests({&CascadedShadowMapGLTest::construct,
+              &CascadedShadowMapGLTest::constructNoCreate,
+              &CascadedShadowMapGLTest::constructMove,
+
+              &CascadedShadowMapGLTest::constructInvalid});
+
+    addInstancedTests({&CascadedShadowMapGLTest::update},
+        Containers::arraySize(UpdateData));
+
+    addTests({&CascadedShadowMapGLTest::updateMaxDistance,
+              &CascadedShadowMapGLTest::updateInvalid,
+              &CascadedShadowMapGLTest::setSplitLambdaInvalid,
+
+              &CascadedShadowMapGLTest::cull,
+              &CascadedShadowMapGLTest::bindCascade,
+              &CascadedShadowMapGLTest::indexOutOfRange});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_array>()) \
+        CORRADE_SKIP(GL::Extensions::EXT::texture_array::string() + std::string(" is not supported"))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+void CascadedShadowMapGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{256, 128}, 3};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(shadowMap.size(), (Vector2i{256, 128}));
+    CORRADE_COMPARE(shadowMap.cascadeCount(), 3);
+    CORRADE_COMPARE(shadowMap.splitLambda(), 0.75f);
+    CORRADE_COMPARE(shadowMap.maxDistance(), Constants::inf());
+    CORRADE_COMPARE(shadowMap.casterExtension(), 0.0f);
+    CORRADE_COMPARE(shadowMap.splitDistances().size(), 3);
+    CORRADE_COMPARE(shadowMap.lightMatrices().size(), 3);
+    CORRADE_VERIFY(shadowMap.texture().id());
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(shadowMap.texture().imageSize(0), (Vector3i{256, 128, 3}));
+    #endif
+}
+
+void CascadedShadowMapGLTest::constructNoCreate() {
+    {
+        CascadedShadowMap shadowMap{NoCreate};
+        CORRADE_VERIFY(true);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void CascadedShadowMapGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap a{{64, 64}, 2};
+    const GLuint id = a.texture().id();
+
+    CascadedShadowMap b{std::move(a)};
+    CORRADE_COMPARE(b.cascadeCount(), 2);
+    CORRADE_COMPARE(b.texture().id(), id);
+
+    CascadedShadowMap c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.cascadeCount(), 2);
+    CORRADE_COMPARE(c.texture().id(), id);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<CascadedShadowMap>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<CascadedShadowMap>::value);
+}
+
+void CascadedShadowMapGLTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CascadedShadowMap{{64, 0}};
+    CascadedShadowMap{{64, 64}, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::CascadedShadowMap: expected a positive size, got {64, 0}\n"
+        "Shaders::CascadedShadowMap: cascade count can't be zero\n");
+}
+
+void CascadedShadowMapGLTest::update() {
+    auto&& data = UpdateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{512, 512}, 2};
+    shadowMap.setSplitLambda(data.lambda);
+
+    const Matrix4 projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f);
+    const Matrix4 cameraTransformation = Matrix4::translation({3.0f, 1.0f, 2.0f})*Matrix4::rotationY(35.0_degf);
+    shadowMap.update(projection, cameraTransformation.invertedRigid(), Vector3{1.0f, -2.0f, 0.5f}.normalized());
+
+    CORRADE_COMPARE_AS(shadowMap.splitDistances(),
+        Containers::arrayView(data.splits),
+        TestSuite::Compare::Container);
+
+    /* All corners of each slice have to be inside the light clip volume */
+    for(UnsignedInt i = 0; i != 2; ++i) {
+        CORRADE_ITERATION(i);
+        const Float near = i ? data.splits[i - 1] : 1.0f;
+        const Float far = data.splits[i];
+        for(const Float depth: {near, far}) for(const Float x: {-1.0f, 1.0f}) for(const Float y: {-1.0f, 1.0f}) {
+            /* With a 90° FoV the frustum at depth d spans from -d to d */
+            const Vector3 point = cameraTransformation.transformPoint({x*depth, y*depth, -depth});
+            const Vector3 clip = shadowMap.lightMatrices()[i].transformPoint(point);
+            CORRADE_ITERATION(clip);
+            CORRADE_COMPARE_AS(Math::abs(clip).max(), 1.0f,
+                TestSuite::Compare::LessOrEqual);
+        }
+    }
+}
+
+void CascadedShadowMapGLTest::updateMaxDistance() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{512, 512}, 2};
+    shadowMap
+        .setSplitLambda(1.0f)
+        .setMaxDistance(25.0f)
+        .update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), {}, -Vector3::yAxis());
+    CORRADE_COMPARE_AS(shadowMap.splitDistances(),
+        Containers::arrayView({5.0f, 25.0f}),
+        TestSuite::Compare::Container);
+}
+
+void CascadedShadowMapGLTest::updateInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{64, 64}, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shadowMap.update(Matrix4::orthographicProjection({2.0f, 2.0f}, 1.0f, 100.0f), {}, -Vector3::yAxis());
+    shadowMap.update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, Constants::inf()), {}, -Vector3::yAxis());
+    shadowMap.update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), {}, {0.0f, -2.0f, 0.0f});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::CascadedShadowMap::update(): expected a perspective projection\n"
+        "Shaders::CascadedShadowMap::update(): expected a finite far plane\n"
+        "Shaders::CascadedShadowMap::update(): light direction Vector(0, -2, 0) is not normalized\n");
+}
+
+void CascadedShadowMapGLTest::setSplitLambdaInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{64, 64}, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shadowMap.setSplitLambda(1.5f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::CascadedShadowMap::setSplitLambda(): expected a value in the [0, 1] range, got 1.5\n");
+}
+
+void CascadedShadowMapGLTest::cull() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    /* Camera at the origin looking down -Z, light going straight down. The
+       first cascade spans from 1 to 10, the second from 10 to 100. */
+    CascadedShadowMap shadowMap{{512, 512}, 2};
+    shadowMap
+        .setSplitLambda(1.0f)
+        .update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), {}, -Vector3::yAxis());
+
+    const Vector3 centers[]{
+        {0.0f, 0.0f, -5.0f},    /* in both */
+        {0.0f, 0.0f, -50.0f},   /* only in the second */
+        {0.0f, 0.0f, 500.0f},   /* in neither */
+    };
+    const Vector3 extents[]{
+        Vector3{0.5f},
+        Vector3{0.5f},
+        Vector3{0.5f}
+    };
+
+    UnsignedInt out[3];
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(shadowMap.cullInto(0, centers, extents, out)),
+        Containers::arrayView<UnsignedInt>({0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(out).prefix(shadowMap.cullInto(1, centers, extents, out)),
+        Containers::arrayView<UnsignedInt>({0, 1}),
+        TestSuite::Compare::Container);
+}
+
+void CascadedShadowMapGLTest::bindCascade() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{64, 64}, 2};
+    shadowMap.bindCascade(0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    shadowMap.bindCascade(1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void CascadedShadowMapGLTest::indexOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    CascadedShadowMap shadowMap{{64, 64}, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shadowMap.frustum(2);
+    shadowMap.cullInto(2, nullptr, nullptr, nullptr);
+    shadowMap.bindCascade(2);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::CascadedShadowMap::frustum(): index 2 out of range for 2 cascades\n"
+        "Shaders::CascadedShadowMap::cullInto(): index 2 out of range for 2 cascades\n"
+        "Shaders::CascadedShadowMap::bindCascade(): index 2 out of range for 2 cascades\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::CascadedShadowMapGLTest)
@@ -0,0 +1,306 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Plane.h"
+#include "Magnum/Shaders/DepthOnly.h"
+#include "Magnum/Shaders/Flat.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct DepthOnlyGLTest: GL::OpenGLTester {
+    explicit DepthOnlyGLTest();
+
+    void construct();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructSkinning();
+    #endif
+    void constructMove();
+
+    void setAlphaMaskNotEnabled();
+    #ifndef MAGNUM_TARGET_GLES2
+    void setWrongJointCountOrId();
+    #endif
+
+    void renderSetup();
+    void renderTeardown();
+
+    void renderOcclusion();
+
+    private:
+        GL::Renderbuffer _color{NoCreate};
+        GL::Renderbuffer _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+using namespace Math::Literals;
+
+constexpr struct {
+    const char* name;
+    DepthOnly::Flags flags;
+} ConstructData[]{
+    {"", {}},
+    {"alpha mask", DepthOnly::Flag::AlphaMask},
+    {"instanced transformation", DepthOnly::Flag::InstancedTransformation},
+    {"alpha mask + instanced transformation", DepthOnly::Flag::AlphaMask|DepthOnly::Flag::InstancedTransformation}
+};
+
+constexpr struct {
+    const char* name;
+    DepthOnly::Flags flags;
+    UnsignedByte alpha;
+    bool occluded;
+} RenderOcclusionData[]{
+    {"", {}, 255, true},
+    {"alpha mask, opaque", DepthOnly::Flag::AlphaMask, 255, true},
+    {"alpha mask, transparent", DepthOnly::Flag::AlphaMask, 0, false}
+};
+
+DepthOnlyGLTest::DepthOnlyGLTest() {
+    addInstancedTests({&DepthOnlyGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({
+        #ifndef MAGNUM_TARGET_GLES2
+        &DepthOnlyGLTest::constructSkinning,
+        #endif
+        &DepthOnlyGLTest::constructMove,
+
+        &DepthOnlyGLTest::setAlphaMaskNotEnabled,
+        #ifndef MAGNUM_TARGET_GLES2
+        &DepthOnlyGLTest::setWrongJointCountOrId
+        #endif
+        });
+
+    addInstancedTests({&DepthOnlyGLTest::renderOcclusion},
+        Containers::arraySize(RenderOcclusionData),
+        &DepthOnlyGLTest::renderSetup,
+        &DepthOnlyGLTest::renderTeardown);
+}
+
+void DepthOnlyGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    DepthOnly shader{data.flags};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DepthOnlyGLTest::constructSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    DepthOnly shader{DepthOnly::Flag::AlphaMask, 16};
+    CORRADE_COMPARE(shader.jointCount(), 16);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+void DepthOnlyGLTest::constructMove() {
+    DepthOnly a{DepthOnly::Flag::AlphaMask};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    DepthOnly b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), DepthOnly::Flag::AlphaMask);
+    CORRADE_VERIFY(!a.id());
+
+    DepthOnly c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), DepthOnly::Flag::AlphaMask);
+    CORRADE_VERIFY(!b.id());
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DepthOnly>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DepthOnly>::value);
+}
+
+void DepthOnlyGLTest::setAlphaMaskNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    DepthOnly shader;
+    GL::Texture2D texture;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setAlphaMask(0.75f)
+        .bindAlphaTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DepthOnly::setAlphaMask(): the shader was not created with alpha mask enabled\n"
+        "Shaders::DepthOnly::bindAlphaTexture(): the shader was not created with alpha mask enabled\n");
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DepthOnlyGLTest::setWrongJointCountOrId() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    DepthOnly shader{{}, 5};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setJointMatrices({Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}, Matrix4{}})
+        .setJointMatrix(5, Matrix4{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DepthOnly::setJointMatrices(): expected at most 5 items but got 6\n"
+        "Shaders::DepthOnly::setJointMatrix(): joint ID 5 is out of bounds for 5 joints\n");
+}
+#endif
+
+constexpr Vector2i RenderSize{16, 16};
+
+void DepthOnlyGLTest::renderSetup() {
+    GL::Renderer::setClearColor(0x111111_rgbf);
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(
+        #if !defined(MAGNUM_TARGET_GLES2) || !defined(MAGNUM_TARGET_WEBGL)
+        GL::RenderbufferFormat::RGBA8,
+        #else
+        GL::RenderbufferFormat::RGBA4,
+        #endif
+        RenderSize);
+    _depth = GL::Renderbuffer{};
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent16, RenderSize);
+    _framebuffer = GL::Framebuffer{{{}, RenderSize}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+        .bind();
+}
+
+void DepthOnlyGLTest::renderTeardown() {
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+    _depth = GL::Renderbuffer{NoCreate};
+
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+}
+
+void DepthOnlyGLTest::renderOcclusion() {
+    auto&& data = RenderOcclusionData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_COMPARE(_framebuffer.checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+
+    GL::Mesh plane = MeshTools::compile(Primitives::planeSolid(Primitives::PlaneFlag::TextureCoordinates));
+
+    /* Fill the depth buffer with a full-screen plane in front, writing no
+       color */
+    DepthOnly depthOnly{data.flags};
+    depthOnly.setTransformationProjectionMatrix(Matrix4::translation(Vector3::zAxis(-0.5f)));
+
+    GL::Texture2D texture{NoCreate};
+    if(data.flags & DepthOnly::Flag::AlphaMask) {
+        const Color4ub pixel{0xff, 0xff, 0xff, data.alpha};
+        texture = GL::Texture2D{};
+        texture.setMinificationFilter(SamplerFilter::Nearest)
+            .setMagnificationFilter(SamplerFilter::Nearest)
+            .setStorage(1,
+                #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+                GL::TextureFormat::RGBA8,
+                #else
+                GL::TextureFormat::RGBA,
+                #endif
+                Vector2i{1})
+            .setSubImage(0, {}, ImageView2D{PixelFormat::RGBA8Unorm, Vector2i{1}, Containers::arrayView(&pixel, 1)});
+        depthOnly.bindAlphaTexture(texture);
+    }
+
+    GL::Renderer::setColorMask(false, false, false, false);
+    depthOnly.draw(plane);
+    GL::Renderer::setColorMask(true, true, true, true);
+
+    /* Then draw a white plane behind it, which should be visible only if the
+       depth-only pass didn't write anything */
+    Flat3D flat;
+    flat.setTransformationProjectionMatrix(Matrix4::translation(Vector3::zAxis(0.5f)))
+        .setColor(0xffffff_rgbf)
+        .draw(plane);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({RenderSize/2, RenderSize/2 + Vector2i{1}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[0][0].rgb(),
+        data.occluded ? 0x111111_rgb : 0xffffff_rgb);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::DepthOnlyGLTest)
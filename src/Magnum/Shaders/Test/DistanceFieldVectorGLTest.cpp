@@ -35,6 +35,11 @@
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/GL/OpenGLTester.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#endif
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/Renderbuffer.h"
@@ -60,9 +65,23 @@ struct DistanceFieldVectorGLTest: GL::OpenGLTester {
     explicit DistanceFieldVectorGLTest();
 
     template<UnsignedInt dimensions> void construct();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffers();
+    #endif
     template<UnsignedInt dimensions> void constructMove();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroMaterials();
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroDraws();
+    #endif
+
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void setUniformUniformBuffersEnabled();
+    template<UnsignedInt dimensions> void bindBufferUniformBuffersNotEnabled();
+    template<UnsignedInt dimensions> void bindTextureTransformationBufferNotEnabled();
+    template<UnsignedInt dimensions> void setWrongDrawOffset();
+    #endif
 
     void renderSetup();
     void renderTeardown();
@@ -72,6 +91,10 @@ struct DistanceFieldVectorGLTest: GL::OpenGLTester {
     void render2D();
     void render3D();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderUniformBuffers2D();
+    #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         std::string _testDir;
@@ -102,9 +125,23 @@ constexpr struct {
     DistanceFieldVector2D::Flags flags;
 } ConstructData[]{
     {"", {}},
-    {"texture transformation", DistanceFieldVector2D::Flag::TextureTransformation}
+    {"texture transformation", DistanceFieldVector2D::Flag::TextureTransformation},
+    {"multi-channel", DistanceFieldVector2D::Flag::MultiChannel}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    DistanceFieldVector2D::Flags flags;
+    UnsignedInt materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", DistanceFieldVector2D::Flag::UniformBuffers, 1, 1},
+    {"texture transformation", DistanceFieldVector2D::Flag::UniformBuffers|DistanceFieldVector2D::Flag::TextureTransformation, 1, 1},
+    {"multiple materials, draws", DistanceFieldVector2D::Flag::UniformBuffers, 8, 48},
+    {"vertex draw ID", DistanceFieldVector2D::Flag::VertexDrawId, 8, 48}
+};
+#endif
+
 const struct {
     const char* name;
     DistanceFieldVector2D::Flags flags;
@@ -124,21 +161,61 @@ const struct {
     {"smooth0.2", {}, {}, 0xffff99_rgbf, 0x9999ff_rgbf, 0.5f, 1.0f, 0.2f,
         "smooth0.2-2D.tga", "smooth0.2-3D.tga", false},
     {"outline", {}, {}, 0xffff99_rgbf, 0x9999ff_rgbf, 0.6f, 0.45f, 0.05f,
+        "outline2D.tga", "outline3D.tga", false},
+    {"outline, multi-channel", DistanceFieldVector2D::Flag::MultiChannel, {},
+        0xffff99_rgbf, 0x9999ff_rgbf, 0.6f, 0.45f, 0.05f,
         "outline2D.tga", "outline3D.tga", false}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+const struct {
+    const char* name;
+    DistanceFieldVector2D::Flags flags;
+    UnsignedInt drawOffset;
+    bool vertexDrawId;
+} RenderUniformBuffersData[] {
+    {"", DistanceFieldVector2D::Flag::UniformBuffers, 1, false},
+    {"vertex draw ID", DistanceFieldVector2D::Flag::VertexDrawId, 0, true}
+};
+#endif
+
 DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
     addInstancedTests<DistanceFieldVectorGLTest>({
         &DistanceFieldVectorGLTest::construct<2>,
         &DistanceFieldVectorGLTest::construct<3>},
         Containers::arraySize(ConstructData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<DistanceFieldVectorGLTest>({
+        &DistanceFieldVectorGLTest::constructUniformBuffers<2>,
+        &DistanceFieldVectorGLTest::constructUniformBuffers<3>},
+        Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
     addTests<DistanceFieldVectorGLTest>({
         &DistanceFieldVectorGLTest::constructMove<2>,
         &DistanceFieldVectorGLTest::constructMove<3>,
 
+        #ifndef MAGNUM_TARGET_GLES2
+        &DistanceFieldVectorGLTest::constructUniformBuffersZeroMaterials<2>,
+        &DistanceFieldVectorGLTest::constructUniformBuffersZeroMaterials<3>,
+        &DistanceFieldVectorGLTest::constructUniformBuffersZeroDraws<2>,
+        &DistanceFieldVectorGLTest::constructUniformBuffersZeroDraws<3>,
+        #endif
+
         &DistanceFieldVectorGLTest::setTextureMatrixNotEnabled<2>,
-        &DistanceFieldVectorGLTest::setTextureMatrixNotEnabled<3>});
+        &DistanceFieldVectorGLTest::setTextureMatrixNotEnabled<3>,
+        #ifndef MAGNUM_TARGET_GLES2
+        &DistanceFieldVectorGLTest::setUniformUniformBuffersEnabled<2>,
+        &DistanceFieldVectorGLTest::setUniformUniformBuffersEnabled<3>,
+        &DistanceFieldVectorGLTest::bindBufferUniformBuffersNotEnabled<2>,
+        &DistanceFieldVectorGLTest::bindBufferUniformBuffersNotEnabled<3>,
+        &DistanceFieldVectorGLTest::bindTextureTransformationBufferNotEnabled<2>,
+        &DistanceFieldVectorGLTest::bindTextureTransformationBufferNotEnabled<3>,
+        &DistanceFieldVectorGLTest::setWrongDrawOffset<2>,
+        &DistanceFieldVectorGLTest::setWrongDrawOffset<3>,
+        #endif
+        });
 
     addTests({&DistanceFieldVectorGLTest::renderDefaults2D,
               &DistanceFieldVectorGLTest::renderDefaults3D},
@@ -151,6 +228,13 @@ DistanceFieldVectorGLTest::DistanceFieldVectorGLTest() {
         &DistanceFieldVectorGLTest::renderSetup,
         &DistanceFieldVectorGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&DistanceFieldVectorGLTest::renderUniformBuffers2D},
+        Containers::arraySize(RenderUniformBuffersData),
+        &DistanceFieldVectorGLTest::renderSetup,
+        &DistanceFieldVectorGLTest::renderTeardown);
+    #endif
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -194,6 +278,36 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructUniformBuffers() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.flags >= DistanceFieldVector2D::Flag::VertexDrawId && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    DistanceFieldVector<dimensions> shader{data.flags, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructMove() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -232,6 +346,144 @@ template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::setTextureMatri
         "Shaders::DistanceFieldVector::setTextureMatrix(): the shader was not created with texture transformation enabled\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructUniformBuffersZeroMaterials() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DistanceFieldVector<dimensions>{DistanceFieldVector<dimensions>::Flag::UniformBuffers, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector: material count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::constructUniformBuffersZeroDraws() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DistanceFieldVector<dimensions>{DistanceFieldVector<dimensions>::Flag::UniformBuffers, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector: draw count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::setUniformUniformBuffersEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    DistanceFieldVector<dimensions> shader{DistanceFieldVector<dimensions>::Flag::UniformBuffers};
+    shader.setTransformationProjectionMatrix({})
+        .setTextureMatrix({})
+        .setColor({})
+        .setOutlineColor({})
+        .setOutlineRange({}, {})
+        .setSmoothness({});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setOutlineColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setOutlineRange(): the shader was created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setSmoothness(): the shader was created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::bindBufferUniformBuffersNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    DistanceFieldVector<dimensions> shader;
+    shader.bindTransformationProjectionBuffer(buffer)
+        .bindTransformationProjectionBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::DistanceFieldVector::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::bindTextureTransformationBufferNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    DistanceFieldVector<dimensions> shader{DistanceFieldVector<dimensions>::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::DistanceFieldVector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+template<UnsignedInt dimensions> void DistanceFieldVectorGLTest::setWrongDrawOffset() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DistanceFieldVector<dimensions>{DistanceFieldVector<dimensions>::Flag::UniformBuffers, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::DistanceFieldVector::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void DistanceFieldVectorGLTest::renderSetup() {
@@ -267,6 +519,37 @@ constexpr GL::TextureFormat TextureFormatR =
     #endif
     ;
 
+void setImage(GL::Texture2D& texture, const ImageView2D& image, const bool multiChannel) {
+    if(!multiChannel) {
+        #ifdef MAGNUM_TARGET_GLES2
+        /* Don't want to bother with the fiasco of single-channel formats and
+           texture storage extensions on ES2 */
+        texture.setImage(0, TextureFormatR, image);
+        #else
+        texture.setStorage(1, TextureFormatR, image.size())
+            .setSubImage(0, {}, image);
+        #endif
+        return;
+    }
+
+    /* A single-channel distance field replicated to all three channels
+       renders the same with Flag::MultiChannel as without, so the same
+       ground truth files can be used */
+    Image2D rgb{PixelFormat::RGB8Unorm, image.size(), Containers::Array<char>{Containers::NoInit, std::size_t(4*((3*image.size().x() + 3)/4)*image.size().y())}};
+    const Containers::StridedArrayView2D<const UnsignedByte> src = image.pixels<UnsignedByte>();
+    const Containers::StridedArrayView2D<Color3ub> dst = rgb.pixels<Color3ub>();
+    for(std::size_t y = 0; y != src.size()[0]; ++y)
+        for(std::size_t x = 0; x != src.size()[1]; ++x)
+            dst[y][x] = Color3ub{src[y][x]};
+
+    #ifdef MAGNUM_TARGET_GLES2
+    texture.setImage(0, GL::TextureFormat::RGB, rgb);
+    #else
+    texture.setStorage(1, GL::TextureFormat::RGB8, rgb.size())
+        .setSubImage(0, {}, rgb);
+    #endif
+}
+
 void DistanceFieldVectorGLTest::renderDefaults2D() {
     if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
        !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
@@ -399,14 +682,7 @@ void DistanceFieldVectorGLTest::render2D() {
         .setMagnificationFilter(GL::SamplerFilter::Linear)
         .setWrapping(GL::SamplerWrapping::ClampToEdge);
 
-    #ifdef MAGNUM_TARGET_GLES2
-    /* Don't want to bother with the fiasco of single-channel formats and
-       texture storage extensions on ES2 */
-    texture.setImage(0, TextureFormatR, *image);
-    #else
-    texture.setStorage(1, TextureFormatR, image->size())
-        .setSubImage(0, {}, *image);
-    #endif
+    setImage(texture, *image, !!(data.flags & DistanceFieldVector2D::Flag::MultiChannel));
 
     DistanceFieldVector2D shader{data.flags};
     shader
@@ -465,14 +741,7 @@ void DistanceFieldVectorGLTest::render3D() {
         .setMagnificationFilter(GL::SamplerFilter::Linear)
         .setWrapping(GL::SamplerWrapping::ClampToEdge);
 
-    #ifdef MAGNUM_TARGET_GLES2
-    /* Don't want to bother with the fiasco of single-channel formats and
-       texture storage extensions on ES2 */
-    texture.setImage(0, TextureFormatR, *image);
-    #else
-    texture.setStorage(1, TextureFormatR, image->size())
-        .setSubImage(0, {}, *image);
-    #endif
+    setImage(texture, *image, !!(data.flags & DistanceFieldVector2D::Flag::MultiChannel));
 
     DistanceFieldVector3D shader{data.flags};
     shader
@@ -514,6 +783,92 @@ void DistanceFieldVectorGLTest::render3D() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorGLTest::renderUniformBuffers2D() {
+    auto&& data = RenderUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.vertexDrawId && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    GL::Mesh square = MeshTools::compile(Primitives::squareSolid(Primitives::SquareFlag::TextureCoordinates));
+
+    /* With a per-vertex draw ID, all four vertices pick the second item */
+    if(data.vertexDrawId) {
+        const UnsignedInt drawIds[]{1, 1, 1, 1};
+        square.addVertexBuffer(GL::Buffer{drawIds}, 0, DistanceFieldVector2D::DrawId{});
+    }
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _manager.loadAndInstantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer);
+
+    GL::Texture2D texture;
+    Containers::Optional<Trade::ImageData2D> image;
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "TestFiles/vector-distancefield.tga")) && (image = importer->image2D(0)));
+    texture.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, TextureFormatR, image->size())
+        .setSubImage(0, {}, *image);
+
+    /* Verify that the draw offset / draw ID and material ID get used by
+       putting the actual data at the second item */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{},
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(
+                Matrix3::projection({2.1f, 2.1f}))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        DistanceFieldVectorDrawUniform{},
+        DistanceFieldVectorDrawUniform{}
+            .setMaterialId(1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        DistanceFieldVectorMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        DistanceFieldVectorMaterialUniform{}
+            .setColor(0xffff99_rgbf)
+            .setOutlineColor(0x9999ff_rgbf)
+            .setOutlineRange(0.5f, 1.0f)
+            .setSmoothness(0.1f)
+    }};
+
+    DistanceFieldVector2D{data.flags, 2, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(data.drawOffset)
+        .bindVectorTexture(texture)
+        .draw(square);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Should be the same as the "smooth0.1" case of render2D() */
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    /* SwiftShader has off-by-one differences when smoothing, Apple A8 a bit
+       more, llvmpipe also */
+    const Float maxThreshold = 32.0f, meanThreshold = 0.942f;
+    #else
+    /* WebGL 1 doesn't have 8bit renderbuffer storage, so it's way worse */
+    const Float maxThreshold = 32.0f, meanThreshold = 2.386f;
+    #endif
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "VectorTestFiles/smooth0.1-2D.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::DistanceFieldVectorGLTest)
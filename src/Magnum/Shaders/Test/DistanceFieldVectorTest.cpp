@@ -37,8 +37,21 @@ struct DistanceFieldVectorTest: TestSuite::Tester {
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformSetters();
+
+    void materialUniformConstructDefault();
+    void materialUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
+    #ifndef MAGNUM_TARGET_GLES2
+    void debugFlagsSupersets();
+    #endif
 };
 
 DistanceFieldVectorTest::DistanceFieldVectorTest() {
@@ -48,8 +61,22 @@ DistanceFieldVectorTest::DistanceFieldVectorTest() {
               &DistanceFieldVectorTest::constructCopy<2>,
               &DistanceFieldVectorTest::constructCopy<3>,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &DistanceFieldVectorTest::uniformSizeAlignment,
+
+              &DistanceFieldVectorTest::drawUniformConstructDefault,
+              &DistanceFieldVectorTest::drawUniformSetters,
+
+              &DistanceFieldVectorTest::materialUniformConstructDefault,
+              &DistanceFieldVectorTest::materialUniformSetters,
+              #endif
+
               &DistanceFieldVectorTest::debugFlag,
-              &DistanceFieldVectorTest::debugFlags});
+              &DistanceFieldVectorTest::debugFlags,
+              #ifndef MAGNUM_TARGET_GLES2
+              &DistanceFieldVectorTest::debugFlagsSupersets
+              #endif
+              });
 }
 
 template<UnsignedInt dimensions> void DistanceFieldVectorTest::constructNoCreate() {
@@ -70,6 +97,61 @@ template<UnsignedInt dimensions> void DistanceFieldVectorTest::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<DistanceFieldVector<dimensions>>{});
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorTest::uniformSizeAlignment() {
+    /* std140 requires array elements to be aligned to a vec4 */
+    CORRADE_COMPARE(sizeof(DistanceFieldVectorDrawUniform), 16);
+    CORRADE_COMPARE(sizeof(DistanceFieldVectorMaterialUniform), 48);
+}
+
+void DistanceFieldVectorTest::drawUniformConstructDefault() {
+    DistanceFieldVectorDrawUniform a;
+    CORRADE_COMPARE(a.materialId, 0);
+
+    constexpr DistanceFieldVectorDrawUniform ca;
+    CORRADE_COMPARE(ca.materialId, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<DistanceFieldVectorDrawUniform>::value);
+}
+
+void DistanceFieldVectorTest::drawUniformSetters() {
+    DistanceFieldVectorDrawUniform a;
+    a.setMaterialId(5);
+    CORRADE_COMPARE(a.materialId, 5);
+}
+
+void DistanceFieldVectorTest::materialUniformConstructDefault() {
+    DistanceFieldVectorMaterialUniform a;
+    CORRADE_COMPARE(a.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.outlineColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.outlineStart, 0.5f);
+    CORRADE_COMPARE(a.outlineEnd, 1.0f);
+    CORRADE_COMPARE(a.smoothness, 0.04f);
+
+    constexpr DistanceFieldVectorMaterialUniform ca;
+    CORRADE_COMPARE(ca.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.outlineColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(ca.outlineStart, 0.5f);
+    CORRADE_COMPARE(ca.outlineEnd, 1.0f);
+    CORRADE_COMPARE(ca.smoothness, 0.04f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<DistanceFieldVectorMaterialUniform>::value);
+}
+
+void DistanceFieldVectorTest::materialUniformSetters() {
+    DistanceFieldVectorMaterialUniform a;
+    a.setColor({0.3f, 0.6f, 0.9f, 0.5f})
+     .setOutlineColor({0.1f, 0.2f, 0.3f, 0.4f})
+     .setOutlineRange(0.6f, 0.4f)
+     .setSmoothness(0.1f);
+    CORRADE_COMPARE(a.color, (Color4{0.3f, 0.6f, 0.9f, 0.5f}));
+    CORRADE_COMPARE(a.outlineColor, (Color4{0.1f, 0.2f, 0.3f, 0.4f}));
+    CORRADE_COMPARE(a.outlineStart, 0.6f);
+    CORRADE_COMPARE(a.outlineEnd, 0.4f);
+    CORRADE_COMPARE(a.smoothness, 0.1f);
+}
+#endif
+
 void DistanceFieldVectorTest::debugFlag() {
     std::ostringstream out;
 
@@ -84,6 +166,16 @@ void DistanceFieldVectorTest::debugFlags() {
     CORRADE_COMPARE(out.str(), "Shaders::DistanceFieldVector::Flag::TextureTransformation|Shaders::DistanceFieldVector::Flag(0xf0) Shaders::DistanceFieldVector::Flags{}\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldVectorTest::debugFlagsSupersets() {
+    /* VertexDrawId is a superset of UniformBuffers so only one should be
+       printed */
+    std::ostringstream out;
+    Debug{&out} << (DistanceFieldVector2D::Flag::UniformBuffers|DistanceFieldVector2D::Flag::VertexDrawId);
+    CORRADE_COMPARE(out.str(), "Shaders::DistanceFieldVector::Flag::VertexDrawId\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::DistanceFieldVectorTest)
@@ -30,11 +30,13 @@
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Mesh.h"
@@ -64,16 +66,36 @@ struct FlatGLTest: GL::OpenGLTester {
     explicit FlatGLTest();
 
     template<UnsignedInt dimensions> void construct();
+    template<UnsignedInt dimensions> void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffers();
+    template<UnsignedInt dimensions> void constructSkinning();
+    #endif
 
     template<UnsignedInt dimensions> void constructMove();
 
     template<UnsignedInt dimensions> void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroMaterials();
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroDraws();
+    #endif
 
     template<UnsignedInt dimensions> void bindTextureNotEnabled();
     template<UnsignedInt dimensions> void setAlphaMaskNotEnabled();
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
     #ifndef MAGNUM_TARGET_GLES2
     template<UnsignedInt dimensions> void setObjectIdNotEnabled();
+    template<UnsignedInt dimensions> void setUniformUniformBuffersEnabled();
+    template<UnsignedInt dimensions> void bindBufferUniformBuffersNotEnabled();
+    template<UnsignedInt dimensions> void bindTextureTransformationBufferNotEnabled();
+    template<UnsignedInt dimensions> void setWrongDrawOffset();
+    template<UnsignedInt dimensions> void setWrongJointCountOrId();
+    template<UnsignedInt dimensions> void bindJointBufferNoJoints();
+    #endif
+    #ifndef MAGNUM_TARGET_GLES
+    template<UnsignedInt dimensions> void constructBindlessTexturesNotTextured();
+    template<UnsignedInt dimensions> void bindTextureHandleBufferNotEnabled();
+    template<UnsignedInt dimensions> void bindTextureBindlessTexturesEnabled();
     #endif
 
     void renderSetup();
@@ -108,6 +130,15 @@ struct FlatGLTest: GL::OpenGLTester {
     void renderInstanced2D();
     void renderInstanced3D();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderUniformBuffers2D();
+    void renderUniformBuffers3D();
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    void renderBindlessTextures2D();
+    #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         std::string _testDir;
@@ -156,6 +187,25 @@ constexpr struct {
     {"instanced texture offset", Flat2D::Flag::Textured|Flat2D::Flag::InstancedTextureOffset}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Flat2D::Flags flags;
+    UnsignedInt materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"classic fallback", {}, 1, 1},
+    {"", Flat2D::Flag::UniformBuffers, 1, 1},
+    {"multiple materials, draws", Flat2D::Flag::UniformBuffers, 16, 48},
+    {"textured + texture transformation", Flat2D::Flag::UniformBuffers|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation, 1, 1},
+    {"alpha mask", Flat2D::Flag::UniformBuffers|Flat2D::Flag::AlphaMask, 1, 1},
+    {"object ID", Flat2D::Flag::UniformBuffers|Flat2D::Flag::ObjectId, 1, 1},
+    {"instanced object ID", Flat2D::Flag::UniformBuffers|Flat2D::Flag::InstancedObjectId, 1, 1},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Flat2D::Flag::MultiDraw|Flat2D::Flag::Textured|Flat2D::Flag::TextureTransformation|Flat2D::Flag::AlphaMask|Flat2D::Flag::InstancedObjectId, 16, 48}
+    #endif
+};
+#endif
+
 const struct {
     const char* name;
     Flat2D::Flags flags;
@@ -214,12 +264,33 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::construct<3>},
         Containers::arraySize(ConstructData));
 
+    addTests<FlatGLTest>({
+        &FlatGLTest::constructAsync<2>,
+        &FlatGLTest::constructAsync<3>});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<FlatGLTest>({
+        &FlatGLTest::constructUniformBuffers<2>,
+        &FlatGLTest::constructUniformBuffers<3>},
+        Containers::arraySize(ConstructUniformBuffersData));
+
+    addTests<FlatGLTest>({
+        &FlatGLTest::constructSkinning<2>,
+        &FlatGLTest::constructSkinning<3>});
+    #endif
+
     addTests<FlatGLTest>({
         &FlatGLTest::constructMove<2>,
         &FlatGLTest::constructMove<3>,
 
         &FlatGLTest::constructTextureTransformationNotTextured<2>,
         &FlatGLTest::constructTextureTransformationNotTextured<3>,
+        #ifndef MAGNUM_TARGET_GLES2
+        &FlatGLTest::constructUniformBuffersZeroMaterials<2>,
+        &FlatGLTest::constructUniformBuffersZeroMaterials<3>,
+        &FlatGLTest::constructUniformBuffersZeroDraws<2>,
+        &FlatGLTest::constructUniformBuffersZeroDraws<3>,
+        #endif
 
         &FlatGLTest::bindTextureNotEnabled<2>,
         &FlatGLTest::bindTextureNotEnabled<3>,
@@ -229,7 +300,27 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::setTextureMatrixNotEnabled<3>,
         #ifndef MAGNUM_TARGET_GLES2
         &FlatGLTest::setObjectIdNotEnabled<2>,
-        &FlatGLTest::setObjectIdNotEnabled<3>
+        &FlatGLTest::setObjectIdNotEnabled<3>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<2>,
+        &FlatGLTest::setUniformUniformBuffersEnabled<3>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<2>,
+        &FlatGLTest::bindBufferUniformBuffersNotEnabled<3>,
+        &FlatGLTest::bindTextureTransformationBufferNotEnabled<2>,
+        &FlatGLTest::bindTextureTransformationBufferNotEnabled<3>,
+        &FlatGLTest::setWrongDrawOffset<2>,
+        &FlatGLTest::setWrongDrawOffset<3>,
+        &FlatGLTest::setWrongJointCountOrId<2>,
+        &FlatGLTest::setWrongJointCountOrId<3>,
+        &FlatGLTest::bindJointBufferNoJoints<2>,
+        &FlatGLTest::bindJointBufferNoJoints<3>,
+        #endif
+        #ifndef MAGNUM_TARGET_GLES
+        &FlatGLTest::constructBindlessTexturesNotTextured<2>,
+        &FlatGLTest::constructBindlessTexturesNotTextured<3>,
+        &FlatGLTest::bindTextureHandleBufferNotEnabled<2>,
+        &FlatGLTest::bindTextureHandleBufferNotEnabled<3>,
+        &FlatGLTest::bindTextureBindlessTexturesEnabled<2>,
+        &FlatGLTest::bindTextureBindlessTexturesEnabled<3>
         #endif
         });
 
@@ -274,6 +365,19 @@ FlatGLTest::FlatGLTest() {
         &FlatGLTest::renderSetup,
         &FlatGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&FlatGLTest::renderUniformBuffers2D,
+              &FlatGLTest::renderUniformBuffers3D},
+        &FlatGLTest::renderSetup,
+        &FlatGLTest::renderTeardown);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    addTests({&FlatGLTest::renderBindlessTextures2D},
+        &FlatGLTest::renderSetup,
+        &FlatGLTest::renderTeardown);
+    #endif
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -322,6 +426,104 @@ template<UnsignedInt dimensions> void FlatGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+template<UnsignedInt dimensions> void FlatGLTest::constructAsync() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    typename Flat<dimensions>::CompileState state = Flat<dimensions>::compile(Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+    CORRADE_COMPARE(state.flags(), Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    Flat<dimensions> shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), Flat<dimensions>::Flag::Textured|Flat<dimensions>::Flag::AlphaMask);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffers() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if((data.flags & Flat2D::Flag::UniformBuffers) && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if((data.flags & Flat2D::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(data.flags >= Flat2D::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    #endif
+
+    Flat<dimensions> shader{data.flags, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::constructSkinning() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    {
+        Flat<dimensions> shader{{}, 1, 1, 16};
+        CORRADE_COMPARE(shader.jointCount(), 16);
+        CORRADE_VERIFY(shader.id());
+        {
+            #ifdef CORRADE_TARGET_APPLE
+            CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+            #endif
+            CORRADE_VERIFY(shader.validate().first);
+        }
+
+        /* Setting fewer matrices than the joint count is allowed */
+        shader.setJointMatrices({MatrixTypeFor<dimensions, Float>{}, MatrixTypeFor<dimensions, Float>{}})
+            .setJointMatrix(15, MatrixTypeFor<dimensions, Float>{});
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    {
+        Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers, 1, 3, 32};
+        CORRADE_COMPARE(shader.jointCount(), 32);
+        CORRADE_VERIFY(shader.id());
+        {
+            #ifdef CORRADE_TARGET_APPLE
+            CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+            #endif
+            CORRADE_VERIFY(shader.validate().first);
+        }
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::constructMove() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -357,6 +559,36 @@ template<UnsignedInt dimensions> void FlatGLTest::constructTextureTransformation
         "Shaders::Flat: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersZeroMaterials() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: material count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::constructUniformBuffersZeroDraws() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: draw count can't be zero\n");
+}
+#endif
+
 template<UnsignedInt dimensions> void FlatGLTest::bindTextureNotEnabled() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -425,6 +657,225 @@ template<UnsignedInt dimensions> void FlatGLTest::setObjectIdNotEnabled() {
     CORRADE_COMPARE(out.str(),
         "Shaders::Flat::setObjectId(): the shader was not created with object ID enabled\n");
 }
+
+template<UnsignedInt dimensions> void FlatGLTest::setUniformUniformBuffersEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers};
+    shader.setTransformationProjectionMatrix({})
+        .setTextureMatrix({})
+        .setColor({})
+        .setAlphaMask({})
+        .setObjectId({})
+        .setJointMatrices({})
+        .setJointMatrix(0, {});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setObjectId(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setJointMatrices(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Flat::setJointMatrix(): the shader was created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindBufferUniformBuffersNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Flat<dimensions> shader;
+    shader.bindTransformationProjectionBuffer(buffer)
+        .bindTransformationProjectionBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .bindJointBuffer(buffer)
+        .bindJointBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Flat::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindTextureTransformationBufferNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::Flat::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::setWrongDrawOffset() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::UniformBuffers, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::setWrongJointCountOrId() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    Flat<dimensions> shader{{}, 1, 1, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setJointMatrices({MatrixTypeFor<dimensions, Float>{}, MatrixTypeFor<dimensions, Float>{}, MatrixTypeFor<dimensions, Float>{}})
+        .setJointMatrix(2, MatrixTypeFor<dimensions, Float>{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::setJointMatrices(): expected at most 2 items but got 3\n"
+        "Shaders::Flat::setJointMatrix(): joint ID 2 is out of bounds for 2 joints\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindJointBufferNoJoints() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers};
+    shader.bindJointBuffer(buffer)
+        .bindJointBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with joints\n"
+        "Shaders::Flat::bindJointBuffer(): the shader was not created with joints\n");
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+template<UnsignedInt dimensions> void FlatGLTest::constructBindlessTexturesNotTextured() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Flat<dimensions>{Flat<dimensions>::Flag::BindlessTextures};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat: bindless textures enabled but the shader is not textured\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindTextureHandleBufferNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Flat<dimensions> shader{Flat<dimensions>::Flag::UniformBuffers|Flat<dimensions>::Flag::Textured};
+    shader.bindTextureHandleBuffer(buffer)
+        .bindTextureHandleBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled\n"
+        "Shaders::Flat::bindTextureHandleBuffer(): the shader was not created with bindless textures enabled\n");
+}
+
+template<UnsignedInt dimensions> void FlatGLTest::bindTextureBindlessTexturesEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(GL::Extensions::ARB::bindless_texture::string() + std::string(" is not supported"));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture;
+    Flat<dimensions> shader{Flat<dimensions>::Flag::BindlessTextures|Flat<dimensions>::Flag::Textured};
+    shader.bindTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Flat::bindTexture(): the shader was created with bindless textures, use bindTextureHandleBuffer() instead\n");
+}
 #endif
 
 constexpr Vector2i RenderSize{80, 80};
@@ -1332,6 +1783,172 @@ void FlatGLTest::renderInstanced3D() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatGLTest::renderUniformBuffers2D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32));
+
+    /* Verify that the draw offset and material ID get used by putting the
+       actual data at the second item */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{},
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(Matrix3::projection({2.1f, 2.1f}))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+            .setMaterialId(1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        FlatMaterialUniform{}
+            .setColor(0x9999ff_rgbf)
+    }};
+
+    Flat2D{Flat2D::Flag::UniformBuffers, 2, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(1)
+        .draw(circle);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Should be exactly the same as renderColored2D() */
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/colored2D.tga"),
+        (DebugTools::CompareImageToFile{_manager}));
+}
+
+#ifndef MAGNUM_TARGET_GLES
+void FlatGLTest::renderBindlessTextures2D() {
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::bindless_texture>())
+        CORRADE_SKIP(GL::Extensions::ARB::bindless_texture::string() + std::string(" is not supported"));
+
+    GL::Mesh circle = MeshTools::compile(Primitives::circle2DSolid(32,
+        Primitives::Circle2DFlag::TextureCoordinates));
+
+    const Color4ub diffuseData[]{ 0x9999ff_rgb };
+    ImageView2D diffuseImage{PixelFormat::RGBA8Unorm, Vector2i{1}, diffuseData};
+    GL::Texture2D texture;
+    texture.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, TextureFormatRGBA, Vector2i{1})
+        .setSubImage(0, {}, diffuseImage)
+        .makeResident();
+
+    /* Verify that the draw offset gets used for the handle as well by putting
+       the actual data at the second item */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{},
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(Matrix3::projection({2.1f, 2.1f}))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+    }};
+    GL::Buffer textureHandleUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatTextureHandleUniform{},
+        FlatTextureHandleUniform{}
+            .setTextureHandle(texture.handle())
+    }};
+
+    /* No texture bound */
+    Flat2D{Flat2D::Flag::Textured|Flat2D::Flag::BindlessTextures, 1, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindTextureHandleBuffer(textureHandleUniform)
+        .setDrawOffset(1)
+        .draw(circle);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Should be the same as renderSinglePixelTextured2D() */
+    const Float maxThreshold = 170.0f, meanThreshold = 0.133f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/colored2D.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
+void FlatGLTest::renderUniformBuffers3D() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Verify that the draw offset and material ID get used by putting the
+       actual data at the second item */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform3D{},
+        TransformationProjectionUniform3D{}
+            .setTransformationProjectionMatrix(
+                Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f)*
+                Matrix4::translation(Vector3::zAxis(-2.15f))*
+                Matrix4::rotationY(-15.0_degf)*
+                Matrix4::rotationX(15.0_degf))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatDrawUniform{},
+        FlatDrawUniform{}
+            .setMaterialId(1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        FlatMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        FlatMaterialUniform{}
+            .setColor(0x9999ff_rgbf)
+    }};
+
+    Flat3D{Flat3D::Flag::UniformBuffers, 2, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(1)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderColored3D() */
+    const Float maxThreshold = 170.0f, meanThreshold = 0.133f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "FlatTestFiles/colored3D.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::FlatGLTest)
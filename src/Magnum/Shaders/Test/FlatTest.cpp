@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -37,6 +38,24 @@ struct FlatTest: TestSuite::Tester {
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    void textureHandleUniformConstructDefault();
+    void textureHandleUniformConstructNoInit();
+    void textureHandleUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -49,6 +68,24 @@ FlatTest::FlatTest() {
               &FlatTest::constructCopy<2>,
               &FlatTest::constructCopy<3>,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &FlatTest::uniformSizeAlignment,
+
+              &FlatTest::drawUniformConstructDefault,
+              &FlatTest::drawUniformConstructNoInit,
+              &FlatTest::drawUniformSetters,
+
+              &FlatTest::materialUniformConstructDefault,
+              &FlatTest::materialUniformConstructNoInit,
+              &FlatTest::materialUniformSetters,
+              #endif
+
+              #ifndef MAGNUM_TARGET_GLES
+              &FlatTest::textureHandleUniformConstructDefault,
+              &FlatTest::textureHandleUniformConstructNoInit,
+              &FlatTest::textureHandleUniformSetters,
+              #endif
+
               &FlatTest::debugFlag,
               &FlatTest::debugFlags,
               &FlatTest::debugFlagsSupersets});
@@ -72,6 +109,139 @@ template<UnsignedInt dimensions> void FlatTest::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<Flat<dimensions>>{});
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void FlatTest::uniformSizeAlignment() {
+    /* std140 requires array elements to be aligned to a vec4 */
+    CORRADE_COMPARE(sizeof(FlatDrawUniform), 16);
+    CORRADE_COMPARE(sizeof(FlatMaterialUniform), 32);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(sizeof(FlatTextureHandleUniform), 16);
+    #endif
+}
+
+void FlatTest::drawUniformConstructDefault() {
+    FlatDrawUniform a;
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
+    CORRADE_COMPARE(a.jointOffset, 0);
+
+    constexpr FlatDrawUniform ca;
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+    CORRADE_COMPARE(ca.jointOffset, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformConstructNoInit() {
+    FlatDrawUniform a;
+    a.materialId = 5;
+    a.objectId = 7;
+    a.jointOffset = 3;
+
+    new(&a) FlatDrawUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.materialId, 5);
+        CORRADE_COMPARE(a.objectId, 7);
+        CORRADE_COMPARE(a.jointOffset, 3);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatDrawUniform>::value);
+}
+
+void FlatTest::drawUniformSetters() {
+    FlatDrawUniform a;
+    a.setMaterialId(5)
+     .setObjectId(7)
+     .setJointOffset(3);
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+    CORRADE_COMPARE(a.jointOffset, 3);
+}
+
+void FlatTest::materialUniformConstructDefault() {
+    FlatMaterialUniform a;
+    CORRADE_COMPARE(a.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr FlatMaterialUniform ca;
+    CORRADE_COMPARE(ca.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatMaterialUniform>::value);
+}
+
+void FlatTest::materialUniformConstructNoInit() {
+    FlatMaterialUniform a;
+    a.color = {0.3f, 0.6f, 0.9f, 1.0f};
+    a.alphaMask = 0.75f;
+
+    new(&a) FlatMaterialUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.color, (Color4{0.3f, 0.6f, 0.9f, 1.0f}));
+        CORRADE_COMPARE(a.alphaMask, 0.75f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatMaterialUniform>::value);
+}
+
+void FlatTest::materialUniformSetters() {
+    FlatMaterialUniform a;
+    a.setColor({0.3f, 0.6f, 0.9f, 0.5f})
+     .setAlphaMask(0.75f);
+    CORRADE_COMPARE(a.color, (Color4{0.3f, 0.6f, 0.9f, 0.5f}));
+    CORRADE_COMPARE(a.alphaMask, 0.75f);
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void FlatTest::textureHandleUniformConstructDefault() {
+    FlatTextureHandleUniform a;
+    CORRADE_COMPARE(a.textureHandle, 0);
+
+    constexpr FlatTextureHandleUniform ca;
+    CORRADE_COMPARE(ca.textureHandle, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<FlatTextureHandleUniform>::value);
+}
+
+void FlatTest::textureHandleUniformConstructNoInit() {
+    FlatTextureHandleUniform a;
+    a.textureHandle = 0x0123456789abcdefull;
+
+    new(&a) FlatTextureHandleUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.textureHandle, 0x0123456789abcdefull);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<FlatTextureHandleUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, FlatTextureHandleUniform>::value);
+}
+
+void FlatTest::textureHandleUniformSetters() {
+    FlatTextureHandleUniform a;
+    a.setTextureHandle(0x0123456789abcdefull);
+    CORRADE_COMPARE(a.textureHandle, 0x0123456789abcdefull);
+}
+#endif
+
 void FlatTest::debugFlag() {
     std::ostringstream out;
 
@@ -99,9 +269,29 @@ void FlatTest::debugFlagsSupersets() {
 
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
-    std::ostringstream out;
-    Debug{&out} << (Flat3D::Flag::InstancedTextureOffset|Flat3D::Flag::TextureTransformation);
-    CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::InstancedTextureOffset\n");
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::InstancedTextureOffset|Flat3D::Flag::TextureTransformation);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::InstancedTextureOffset\n");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::MultiDraw|Flat3D::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::MultiDraw\n");
+    }
+
+    /* BindlessTextures is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Flat3D::Flag::BindlessTextures|Flat3D::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Flat::Flag::BindlessTextures\n");
+    }
+    #endif
 }
 
 }}}}
@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <Corrade/TestSuite/Tester.h>
 
 #include "Magnum/Shaders/Generic.h"
@@ -40,6 +41,34 @@ struct GenericTest: TestSuite::Tester {
     void tbnContiguous();
     void tbnBothNormalAndQuaternion();
     void textureTransformContiguous();
+
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void transformationProjectionUniform2DConstructDefault();
+    void transformationProjectionUniform2DConstructNoInit();
+    void transformationProjectionUniform2DSetters();
+
+    void transformationProjectionUniform3DConstructDefault();
+    void transformationProjectionUniform3DConstructNoInit();
+    void transformationProjectionUniform3DSetters();
+
+    void projectionUniform3DConstructDefault();
+    void projectionUniform3DConstructNoInit();
+    void projectionUniform3DSetters();
+
+    void transformationUniform2DConstructDefault();
+    void transformationUniform2DConstructNoInit();
+    void transformationUniform2DSetters();
+
+    void transformationUniform3DConstructDefault();
+    void transformationUniform3DConstructNoInit();
+    void transformationUniform3DSetters();
+
+    void textureTransformationUniformConstructDefault();
+    void textureTransformationUniformConstructNoInit();
+    void textureTransformationUniformSetters();
+    #endif
 };
 
 GenericTest::GenericTest() {
@@ -48,7 +77,36 @@ GenericTest::GenericTest() {
 
               &GenericTest::tbnContiguous,
               &GenericTest::tbnBothNormalAndQuaternion,
-              &GenericTest::textureTransformContiguous});
+              &GenericTest::textureTransformContiguous,
+
+              #ifndef MAGNUM_TARGET_GLES2
+              &GenericTest::uniformSizeAlignment,
+
+              &GenericTest::transformationProjectionUniform2DConstructDefault,
+              &GenericTest::transformationProjectionUniform2DConstructNoInit,
+              &GenericTest::transformationProjectionUniform2DSetters,
+
+              &GenericTest::transformationProjectionUniform3DConstructDefault,
+              &GenericTest::transformationProjectionUniform3DConstructNoInit,
+              &GenericTest::transformationProjectionUniform3DSetters,
+
+              &GenericTest::projectionUniform3DConstructDefault,
+              &GenericTest::projectionUniform3DConstructNoInit,
+              &GenericTest::projectionUniform3DSetters,
+
+              &GenericTest::transformationUniform2DConstructDefault,
+              &GenericTest::transformationUniform2DConstructNoInit,
+              &GenericTest::transformationUniform2DSetters,
+
+              &GenericTest::transformationUniform3DConstructDefault,
+              &GenericTest::transformationUniform3DConstructNoInit,
+              &GenericTest::transformationUniform3DSetters,
+
+              &GenericTest::textureTransformationUniformConstructDefault,
+              &GenericTest::textureTransformationUniformConstructNoInit,
+              &GenericTest::textureTransformationUniformSetters
+              #endif
+              });
 }
 
 void GenericTest::glslMatch() {
@@ -73,6 +131,13 @@ void GenericTest::glslMatch() {
     CORRADE_COMPARE(BITANGENT_ATTRIBUTE_LOCATION, Generic3D::Bitangent::Location);
     CORRADE_COMPARE(NORMAL_ATTRIBUTE_LOCATION, Generic3D::Normal::Location);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_COMPARE(WEIGHTS_ATTRIBUTE_LOCATION, Generic2D::Weights::Location);
+    CORRADE_COMPARE(WEIGHTS_ATTRIBUTE_LOCATION, Generic3D::Weights::Location);
+    CORRADE_COMPARE(JOINT_IDS_ATTRIBUTE_LOCATION, Generic2D::JointIds::Location);
+    CORRADE_COMPARE(JOINT_IDS_ATTRIBUTE_LOCATION, Generic3D::JointIds::Location);
+    #endif
+
     CORRADE_COMPARE(TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION, Generic2D::TransformationMatrix::Location);
     CORRADE_COMPARE(TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION, Generic3D::TransformationMatrix::Location);
 
@@ -111,6 +176,252 @@ void GenericTest::textureTransformContiguous() {
     //CORRADE_COMPARE(Generic3D::TextureOffset::Location, Generic3D::TextureMatrix::Location + 2);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void GenericTest::uniformSizeAlignment() {
+    /* std140 requires array elements to be aligned to a vec4 */
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform2D), 48);
+    CORRADE_COMPARE(sizeof(TransformationProjectionUniform3D), 64);
+    CORRADE_COMPARE(sizeof(ProjectionUniform3D), 64);
+    CORRADE_COMPARE(sizeof(TransformationUniform2D), 48);
+    CORRADE_COMPARE(sizeof(TransformationUniform3D), 64);
+    CORRADE_COMPARE(sizeof(TextureTransformationUniform), 32);
+}
+
+void GenericTest::transformationProjectionUniform2DConstructDefault() {
+    TransformationProjectionUniform2D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    constexpr TransformationProjectionUniform2D ca;
+    CORRADE_COMPARE(ca.transformationProjectionMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationProjectionUniform2D>::value);
+}
+
+void GenericTest::transformationProjectionUniform2DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationProjectionUniform2D a;
+    a.transformationProjectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationProjectionUniform2D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationProjectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationProjectionUniform2D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationProjectionUniform2D>::value);
+}
+
+void GenericTest::transformationProjectionUniform2DSetters() {
+    TransformationProjectionUniform2D a;
+    a.setTransformationProjectionMatrix(Matrix3::translation({2.0f, 3.0f}));
+    CORRADE_COMPARE(a.transformationProjectionMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {2.0f, 3.0f, 1.0f, 0.0f}}));
+}
+
+void GenericTest::transformationProjectionUniform3DConstructDefault() {
+    TransformationProjectionUniform3D a;
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr TransformationProjectionUniform3D ca;
+    CORRADE_COMPARE(ca.transformationProjectionMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationProjectionUniform3D>::value);
+}
+
+void GenericTest::transformationProjectionUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationProjectionUniform3D a;
+    a.transformationProjectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationProjectionUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationProjectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationProjectionUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationProjectionUniform3D>::value);
+}
+
+void GenericTest::transformationProjectionUniform3DSetters() {
+    TransformationProjectionUniform3D a;
+    a.setTransformationProjectionMatrix(Matrix4::translation({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.transformationProjectionMatrix, Matrix4::translation({2.0f, 3.0f, 4.0f}));
+}
+
+void GenericTest::projectionUniform3DConstructDefault() {
+    ProjectionUniform3D a;
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr ProjectionUniform3D ca;
+    CORRADE_COMPARE(ca.projectionMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<ProjectionUniform3D>::value);
+}
+
+void GenericTest::projectionUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    ProjectionUniform3D a;
+    a.projectionMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) ProjectionUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.projectionMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<ProjectionUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, ProjectionUniform3D>::value);
+}
+
+void GenericTest::projectionUniform3DSetters() {
+    ProjectionUniform3D a;
+    a.setProjectionMatrix(Matrix4::scaling({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.projectionMatrix, Matrix4::scaling({2.0f, 3.0f, 4.0f}));
+}
+
+void GenericTest::transformationUniform2DConstructDefault() {
+    TransformationUniform2D a;
+    CORRADE_COMPARE(a.transformationMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    constexpr TransformationUniform2D ca;
+    CORRADE_COMPARE(ca.transformationMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationUniform2D>::value);
+}
+
+void GenericTest::transformationUniform2DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationUniform2D a;
+    a.transformationMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationUniform2D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationUniform2D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationUniform2D>::value);
+}
+
+void GenericTest::transformationUniform2DSetters() {
+    TransformationUniform2D a;
+    a.setTransformationMatrix(Matrix3::translation({2.0f, 3.0f}));
+    CORRADE_COMPARE(a.transformationMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {2.0f, 3.0f, 1.0f, 0.0f}}));
+}
+
+void GenericTest::transformationUniform3DConstructDefault() {
+    TransformationUniform3D a;
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4{Math::IdentityInit});
+
+    constexpr TransformationUniform3D ca;
+    CORRADE_COMPARE(ca.transformationMatrix, Matrix4{Math::IdentityInit});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TransformationUniform3D>::value);
+}
+
+void GenericTest::transformationUniform3DConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TransformationUniform3D a;
+    a.transformationMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+
+    new(&a) TransformationUniform3D{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.transformationMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TransformationUniform3D, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TransformationUniform3D>::value);
+}
+
+void GenericTest::transformationUniform3DSetters() {
+    TransformationUniform3D a;
+    a.setTransformationMatrix(Matrix4::translation({2.0f, 3.0f, 4.0f}));
+    CORRADE_COMPARE(a.transformationMatrix, Matrix4::translation({2.0f, 3.0f, 4.0f}));
+}
+
+void GenericTest::textureTransformationUniformConstructDefault() {
+    TextureTransformationUniform a;
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(a.offset, Vector2{});
+
+    constexpr TextureTransformationUniform ca;
+    CORRADE_COMPARE(ca.rotationScaling, (Vector4{1.0f, 0.0f, 0.0f, 1.0f}));
+    CORRADE_COMPARE(ca.offset, Vector2{});
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<TextureTransformationUniform>::value);
+}
+
+void GenericTest::textureTransformationUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    TextureTransformationUniform a;
+    a.rotationScaling = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.offset = {0.3f, 1.1f};
+
+    new(&a) TextureTransformationUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.rotationScaling, (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.offset, (Vector2{0.3f, 1.1f}));
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<TextureTransformationUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, TextureTransformationUniform>::value);
+}
+
+void GenericTest::textureTransformationUniformSetters() {
+    TextureTransformationUniform a;
+    a.setTextureMatrix(Matrix3::translation({0.5f, -1.0f})*
+                       Matrix3::scaling({2.0f, 3.0f}));
+    CORRADE_COMPARE(a.rotationScaling, (Vector4{2.0f, 0.0f, 0.0f, 3.0f}));
+    CORRADE_COMPARE(a.offset, (Vector2{0.5f, -1.0f}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::GenericTest)
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/InstanceBuffer.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct InstanceBufferGLTest: GL::OpenGLTester {
+    explicit InstanceBufferGLTest();
+
+    template<UnsignedInt dimensions> void construct();
+    template<UnsignedInt dimensions> void constructMove();
+
+    void beginEnd();
+    void beginWithoutEnd();
+    void attributeNotInFrame();
+};
+
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::buffer_storage>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::buffer_storage::string() + std::string(" is not available.")); \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::base_instance>()) \
+        CORRADE_SKIP(GL::Extensions::ARB::base_instance::string() + std::string(" is not available."))
+
+constexpr struct {
+    const char* name;
+    Implementation::InstanceBufferAttributes attributes;
+    UnsignedInt stride2D, stride3D;
+} ConstructData[]{
+    {"transformation", Implementation::InstanceBufferAttribute::TransformationMatrix, 36, 64},
+    {"color", Implementation::InstanceBufferAttribute::Color, 16, 16},
+    {"transformation, color, texture offset", Implementation::InstanceBufferAttribute::TransformationMatrix|Implementation::InstanceBufferAttribute::Color|Implementation::InstanceBufferAttribute::TextureOffset, 60, 88}
+};
+
+InstanceBufferGLTest::InstanceBufferGLTest() {
+    addInstancedTests<InstanceBufferGLTest>({
+        &InstanceBufferGLTest::construct<2>,
+        &InstanceBufferGLTest::construct<3>},
+        Containers::arraySize(ConstructData));
+
+    addTests<InstanceBufferGLTest>({
+        &InstanceBufferGLTest::constructMove<2>,
+        &InstanceBufferGLTest::constructMove<3>,
+
+        &InstanceBufferGLTest::beginEnd,
+        &InstanceBufferGLTest::beginWithoutEnd,
+        &InstanceBufferGLTest::attributeNotInFrame});
+}
+
+template<UnsignedInt dimensions> void InstanceBufferGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseTemplateName(std::to_string(dimensions));
+    setTestCaseDescription(data.name);
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    InstanceBuffer<dimensions> buffer{data.attributes, 100, 2};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const UnsignedInt stride = dimensions == 2 ? data.stride2D : data.stride3D;
+    CORRADE_VERIFY(buffer.ringBuffer().buffer().id());
+    CORRADE_COMPARE(buffer.attributes(), data.attributes);
+    CORRADE_COMPARE(buffer.stride(), stride);
+    CORRADE_COMPARE(buffer.capacity(), 100);
+    CORRADE_COMPARE(buffer.instanceCount(), 0);
+    /* Space for the alignment padding in each frame */
+    CORRADE_COMPARE(buffer.ringBuffer().size(), 2*(100*stride + stride - 4));
+}
+
+template<UnsignedInt dimensions> void InstanceBufferGLTest::constructMove() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    InstanceBuffer<dimensions> a{InstanceBuffer<dimensions>::Attribute::Color, 16};
+    const GLuint id = a.ringBuffer().buffer().id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    InstanceBuffer<dimensions> b{std::move(a)};
+    CORRADE_COMPARE(b.ringBuffer().buffer().id(), id);
+    CORRADE_COMPARE(b.attributes(), InstanceBuffer<dimensions>::Attribute::Color);
+    CORRADE_COMPARE(b.capacity(), 16);
+    CORRADE_VERIFY(!a.ringBuffer().buffer().id());
+
+    InstanceBuffer<dimensions> c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.ringBuffer().buffer().id(), id);
+    CORRADE_COMPARE(c.stride(), 16);
+    CORRADE_VERIFY(!b.ringBuffer().buffer().id());
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<InstanceBuffer<dimensions>>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<InstanceBuffer<dimensions>>::value);
+}
+
+void InstanceBufferGLTest::beginEnd() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    InstanceBuffer3D buffer{
+        InstanceBuffer3D::Attribute::TransformationMatrix|
+        InstanceBuffer3D::Attribute::NormalMatrix|
+        InstanceBuffer3D::Attribute::Color|
+        InstanceBuffer3D::Attribute::TextureOffset, 4, 2};
+    CORRADE_COMPARE(buffer.stride(), 124);
+
+    GL::Mesh mesh;
+    buffer.addToMesh(mesh);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Two frames, the second has to go after the first */
+    UnsignedInt previousBaseInstance = 0;
+    for(UnsignedInt frame = 0; frame != 2; ++frame) {
+        CORRADE_ITERATION(frame);
+
+        buffer.begin(mesh, 3 - frame);
+        CORRADE_COMPARE(buffer.instanceCount(), 3 - frame);
+        CORRADE_COMPARE(mesh.instanceCount(), 3 - frame);
+        if(frame) CORRADE_COMPARE_AS(mesh.baseInstance(), previousBaseInstance + 3,
+            TestSuite::Compare::GreaterOrEqual);
+        previousBaseInstance = mesh.baseInstance();
+
+        Containers::StridedArrayView1D<Matrix4> transformations = buffer.transformationMatrices();
+        Containers::StridedArrayView1D<Matrix3x3> normals = buffer.normalMatrices();
+        Containers::StridedArrayView1D<Color4> colors = buffer.colors();
+        Containers::StridedArrayView1D<Vector2> textureOffsets = buffer.textureOffsets();
+        CORRADE_COMPARE(transformations.size(), 3 - frame);
+        CORRADE_COMPARE(transformations.stride(), 124);
+        for(std::size_t i = 0; i != transformations.size(); ++i) {
+            transformations[i] = Matrix4::translation(Vector3::xAxis(Float(i + frame)));
+            normals[i] = transformations[i].normalMatrix();
+            colors[i] = Color4{Float(i), Float(frame), 0.5f, 1.0f};
+            textureOffsets[i] = {Float(frame), Float(i)};
+        }
+
+        /* The data are visible through the buffer at the base instance */
+        Containers::Array<char> data = buffer.ringBuffer().buffer().subData(mesh.baseInstance()*124, transformations.size()*124);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+        Containers::StridedArrayView1D<const Color4> colorData{data, reinterpret_cast<const Color4*>(data.data() + 100), transformations.size(), 124};
+        Containers::StridedArrayView1D<const Vector2> textureOffsetData{data, reinterpret_cast<const Vector2*>(data.data() + 116), transformations.size(), 124};
+        for(std::size_t i = 0; i != colorData.size(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(colorData[i], (Color4{Float(i), Float(frame), 0.5f, 1.0f}));
+            CORRADE_COMPARE(textureOffsetData[i], (Vector2{Float(frame), Float(i)}));
+        }
+
+        buffer.end();
+    }
+}
+
+void InstanceBufferGLTest::beginWithoutEnd() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    InstanceBuffer3D buffer{InstanceBuffer3D::Attribute::Color, 4};
+    GL::Mesh mesh;
+    buffer.begin(mesh, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.begin(mesh, 2);
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer::begin(): end() wasn't called for the previous frame\n");
+}
+
+void InstanceBufferGLTest::attributeNotInFrame() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    InstanceBuffer2D buffer{InstanceBuffer2D::Attribute::TransformationMatrix|InstanceBuffer2D::Attribute::Color, 4};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.transformationMatrices();
+    buffer.colors();
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBuffer::transformationMatrices(): can be called only between begin() and end()\n"
+        "Shaders::InstanceBuffer::colors(): can be called only between begin() and end()\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceBufferGLTest)
@@ -0,0 +1,194 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/InstanceBuffer.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct InstanceBufferTest: TestSuite::Tester {
+    explicit InstanceBufferTest();
+
+    template<UnsignedInt dimensions> void constructNoCreate();
+    template<UnsignedInt dimensions> void constructCopy();
+
+    void constructNoAttributes();
+    void constructNormalMatrix2D();
+    void constructZeroCapacity();
+
+    void beginOverCapacity();
+    void attributeNotEnabled();
+    void endWithoutBegin();
+
+    void debugAttribute();
+    void debugAttributes();
+};
+
+InstanceBufferTest::InstanceBufferTest() {
+    addTests({&InstanceBufferTest::constructNoCreate<2>,
+              &InstanceBufferTest::constructNoCreate<3>,
+              &InstanceBufferTest::constructCopy<2>,
+              &InstanceBufferTest::constructCopy<3>,
+
+              &InstanceBufferTest::constructNoAttributes,
+              &InstanceBufferTest::constructNormalMatrix2D,
+              &InstanceBufferTest::constructZeroCapacity,
+
+              &InstanceBufferTest::beginOverCapacity,
+              &InstanceBufferTest::attributeNotEnabled,
+              &InstanceBufferTest::endWithoutBegin,
+
+              &InstanceBufferTest::debugAttribute,
+              &InstanceBufferTest::debugAttributes});
+}
+
+template<UnsignedInt dimensions> void InstanceBufferTest::constructNoCreate() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    {
+        InstanceBuffer<dimensions> buffer{NoCreate};
+        CORRADE_COMPARE(buffer.ringBuffer().buffer().id(), 0);
+        CORRADE_COMPARE(buffer.attributes(), typename InstanceBuffer<dimensions>::Attributes{});
+        CORRADE_COMPARE(buffer.stride(), 0);
+        CORRADE_COMPARE(buffer.capacity(), 0);
+        CORRADE_COMPARE(buffer.instanceCount(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+template<UnsignedInt dimensions> void InstanceBufferTest::constructCopy() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    CORRADE_VERIFY(!std::is_copy_constructible<InstanceBuffer<dimensions>>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<InstanceBuffer<dimensions>>{});
+}
+
+void InstanceBufferTest::constructNoAttributes() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    InstanceBuffer3D{{}, 16};
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer: expected at least one attribute\n");
+}
+
+void InstanceBufferTest::constructNormalMatrix2D() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    InstanceBuffer2D{InstanceBuffer2D::Attribute::TransformationMatrix|InstanceBuffer2D::Attribute::NormalMatrix, 16};
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer: normal matrix is available only in 3D\n");
+}
+
+void InstanceBufferTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    InstanceBuffer3D{InstanceBuffer3D::Attribute::Color, 0};
+    InstanceBuffer3D{InstanceBuffer3D::Attribute::Color, 16, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBuffer: expected non-zero capacity and frame count but got 0 and 3\n"
+        "Shaders::InstanceBuffer: expected non-zero capacity and frame count but got 16 and 0\n");
+}
+
+void InstanceBufferTest::beginOverCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstanceBuffer3D buffer{NoCreate};
+    GL::Mesh mesh{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.begin(mesh, 1);
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer::begin(): expected at most 0 instances but got 1\n");
+}
+
+void InstanceBufferTest::attributeNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstanceBuffer3D buffer{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.transformationMatrices();
+    buffer.normalMatrices();
+    buffer.colors();
+    buffer.textureOffsets();
+    CORRADE_COMPARE(out.str(),
+        "Shaders::InstanceBuffer::transformationMatrices(): the buffer was not created with Shaders::InstanceBuffer::Attribute::TransformationMatrix\n"
+        "Shaders::InstanceBuffer::normalMatrices(): the buffer was not created with Shaders::InstanceBuffer::Attribute::NormalMatrix\n"
+        "Shaders::InstanceBuffer::colors(): the buffer was not created with Shaders::InstanceBuffer::Attribute::Color\n"
+        "Shaders::InstanceBuffer::textureOffsets(): the buffer was not created with Shaders::InstanceBuffer::Attribute::TextureOffset\n");
+}
+
+void InstanceBufferTest::endWithoutBegin() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    InstanceBuffer3D buffer{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.end();
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer::end(): no matching begin() call\n");
+}
+
+void InstanceBufferTest::debugAttribute() {
+    std::ostringstream out;
+
+    Debug{&out} << InstanceBuffer3D::Attribute::NormalMatrix << InstanceBuffer3D::Attribute(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer::Attribute::NormalMatrix Shaders::InstanceBuffer::Attribute(0xf0)\n");
+}
+
+void InstanceBufferTest::debugAttributes() {
+    std::ostringstream out;
+
+    Debug{&out} << (InstanceBuffer3D::Attribute::TransformationMatrix|InstanceBuffer3D::Attribute::TextureOffset) << InstanceBuffer3D::Attributes{};
+    CORRADE_COMPARE(out.str(), "Shaders::InstanceBuffer::Attribute::TransformationMatrix|Shaders::InstanceBuffer::Attribute::TextureOffset Shaders::InstanceBuffer::Attributes{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::InstanceBufferTest)
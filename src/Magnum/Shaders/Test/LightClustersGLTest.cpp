@@ -0,0 +1,226 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Shaders/LightClusters.h"
+#include "Magnum/Shaders/Phong.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct LightClustersGLTest: GL::OpenGLTester {
+    explicit LightClustersGLTest();
+
+    void construct();
+    void constructNoCreate();
+    void constructMove();
+
+    void constructInvalid();
+
+    void update();
+    void updateTruncated();
+    void updateInvalid();
+};
+
+using namespace Math::Literals;
+
+LightClustersGLTest::LightClustersGLTest() {
+    addTests({&LightClustersGLTest::construct,
+              &LightClustersGLTest::constructNoCreate,
+              &LightClustersGLTest::constructMove,
+
+              &LightClustersGLTest::constructInvalid,
+
+              &LightClustersGLTest::update,
+              &LightClustersGLTest::updateTruncated,
+              &LightClustersGLTest::updateInvalid});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_integer>()) \
+        CORRADE_SKIP(GL::Extensions::EXT::texture_integer::string() + std::string(" is not supported"))
+#else
+#define SKIP_IF_NOT_SUPPORTED() do {} while(false)
+#endif
+
+void LightClustersGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    LightClusters clusters{{4, 3, 2}, 1000};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(clusters.gridSize(), (Vector3i{4, 3, 2}));
+    /* Rounded up to the texture width */
+    CORRADE_COMPARE(clusters.lightIndexCapacity(), 1024);
+    CORRADE_COMPARE(clusters.lightIndexCount(), 0);
+    CORRADE_COMPARE(clusters.droppedLightIndexCount(), 0);
+    CORRADE_COMPARE(clusters.clusters().size(), 24);
+    CORRADE_COMPARE(clusters.lightIndices().size(), 0);
+    CORRADE_VERIFY(clusters.clusterTexture().id());
+    CORRADE_VERIFY(clusters.lightIndexTexture().id());
+}
+
+void LightClustersGLTest::constructNoCreate() {
+    {
+        LightClusters clusters{NoCreate};
+        CORRADE_VERIFY(true);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void LightClustersGLTest::constructMove() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    LightClusters a{{4, 3, 2}, 1000};
+    const GLuint id = a.clusterTexture().id();
+
+    LightClusters b{std::move(a)};
+    CORRADE_COMPARE(b.gridSize(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(b.clusterTexture().id(), id);
+
+    LightClusters c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.gridSize(), (Vector3i{4, 3, 2}));
+    CORRADE_COMPARE(c.clusterTexture().id(), id);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<LightClusters>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<LightClusters>::value);
+}
+
+void LightClustersGLTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    LightClusters{{4, 0, 2}};
+    LightClusters{{4, 3, 2}, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusters: expected a positive grid size, got {4, 0, 2}\n"
+        "Shaders::LightClusters: light index capacity can't be zero\n");
+}
+
+void LightClustersGLTest::update() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    /* With a 90° FoV the frustum at depth d spans from -d to d on both X and
+       Y, so the left/bottom tiles are exactly the negative half-spaces */
+    const Matrix4 projection = Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f);
+    const PhongLightUniform lights[]{
+        /* Directional light, in all clusters */
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, 1.0f, 0.0f}),
+        /* Point light in the left bottom near cluster only */
+        PhongLightUniform{}
+            .setPosition({-2.0f, -2.0f, -3.0f, 1.0f})
+            .setRange(0.5f),
+        /* Point light behind the far plane, in no cluster */
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, -200.0f, 1.0f})
+            .setRange(1.0f),
+        /* Point light in the right top far cluster only */
+        PhongLightUniform{}
+            .setPosition({30.0f, 30.0f, -50.0f, 1.0f})
+            .setRange(5.0f),
+    };
+
+    LightClusters clusters{{2, 2, 2}, 1024};
+    clusters.update(projection, lights);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(clusters.depthRange().min(), 1.0f);
+    CORRADE_COMPARE(clusters.depthRange().max(), 100.0f);
+    CORRADE_COMPARE(clusters.lightIndexCount(), 10);
+    CORRADE_COMPARE(clusters.droppedLightIndexCount(), 0);
+    CORRADE_COMPARE_AS(clusters.clusters(), Containers::arrayView<Vector2ui>({
+        {0, 2}, {2, 1}, {3, 1}, {4, 1},
+        {5, 1}, {6, 1}, {7, 1}, {8, 2}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(clusters.lightIndices(), Containers::arrayView<UnsignedInt>({
+        0, 1, 0, 0, 0, 0, 0, 0, 0, 3
+    }), TestSuite::Compare::Container);
+
+    /* Updating again with less lights clears the previous state */
+    clusters.update(projection, Containers::arrayView(lights).prefix(1));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(clusters.lightIndexCount(), 8);
+    CORRADE_COMPARE_AS(clusters.clusters(), Containers::arrayView<Vector2ui>({
+        {0, 1}, {1, 1}, {2, 1}, {3, 1},
+        {4, 1}, {5, 1}, {6, 1}, {7, 1}
+    }), TestSuite::Compare::Container);
+}
+
+void LightClustersGLTest::updateTruncated() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    const PhongLightUniform lights[]{
+        PhongLightUniform{},
+        PhongLightUniform{}
+    };
+
+    /* 2048 indices needed, capacity rounded up to 1024 */
+    LightClusters clusters{{16, 8, 8}, 1};
+    clusters.update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, 100.0f), lights);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(clusters.lightIndexCount(), 1024);
+    CORRADE_COMPARE(clusters.droppedLightIndexCount(), 1024);
+
+    /* The first half of clusters gets both lights, the rest none */
+    CORRADE_COMPARE(clusters.clusters()[511], (Vector2ui{1022, 2}));
+    CORRADE_COMPARE(clusters.clusters()[512], (Vector2ui{1024, 0}));
+}
+
+void LightClustersGLTest::updateInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SKIP_IF_NOT_SUPPORTED();
+
+    LightClusters clusters{{2, 2, 2}, 1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    clusters.update(Matrix4::orthographicProjection({2.0f, 2.0f}, 1.0f, 100.0f), nullptr);
+    clusters.update(Matrix4::perspectiveProjection(90.0_degf, 1.0f, 1.0f, Constants::inf()), nullptr);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::LightClusters::update(): expected a perspective projection\n"
+        "Shaders::LightClusters::update(): expected a finite far plane\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::LightClustersGLTest)
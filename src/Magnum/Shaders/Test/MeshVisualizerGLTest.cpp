@@ -35,6 +35,10 @@
 #include "Magnum/DebugTools/ColorMap.h"
 #include "Magnum/DebugTools/CompareImage.h"
 #include "Magnum/GL/Context.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/BufferTexture.h"
+#include "Magnum/GL/BufferTextureFormat.h"
+#endif
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/GL/Framebuffer.h"
@@ -94,6 +98,8 @@ struct MeshVisualizerGLTest: GL::OpenGLTester {
     #endif
     #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
     void setTangentBitangentNormalNotEnabled3D();
+    void bindBufferTexturesNotEnabled2D();
+    void bindBufferTexturesNotEnabled3D();
     #endif
 
     void renderSetup();
@@ -162,7 +168,11 @@ constexpr struct {
     #ifndef MAGNUM_TARGET_WEBGL
     {"primitive ID", MeshVisualizer2D::Flag::PrimitiveId},
     #endif
-    {"primitive ID from vertex ID", MeshVisualizer2D::Flag::PrimitiveIdFromVertexId}
+    {"primitive ID from vertex ID", MeshVisualizer2D::Flag::PrimitiveIdFromVertexId},
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"wireframe w/o GS, vertex pulling", MeshVisualizer2D::Flag::Wireframe|MeshVisualizer2D::Flag::NoGeometryShader|MeshVisualizer2D::Flag::VertexPulling},
+    {"vertex ID, vertex pulling", MeshVisualizer2D::Flag::VertexId|MeshVisualizer2D::Flag::VertexPulling}
     #endif
 };
 
@@ -177,7 +187,11 @@ constexpr struct {
     #ifndef MAGNUM_TARGET_WEBGL
     {"primitive ID", MeshVisualizer3D::Flag::PrimitiveId},
     #endif
-    {"primitive ID from vertex ID", MeshVisualizer3D::Flag::PrimitiveIdFromVertexId}
+    {"primitive ID from vertex ID", MeshVisualizer3D::Flag::PrimitiveIdFromVertexId},
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"wireframe w/o GS, vertex pulling", MeshVisualizer3D::Flag::Wireframe|MeshVisualizer3D::Flag::NoGeometryShader|MeshVisualizer3D::Flag::VertexPulling},
+    {"vertex ID, vertex pulling", MeshVisualizer3D::Flag::VertexId|MeshVisualizer3D::Flag::VertexPulling}
     #endif
 };
 
@@ -219,7 +233,12 @@ constexpr struct {
         ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"},
     {"both object and vertex id",
         MeshVisualizer2D::Flag::InstancedObjectId|MeshVisualizer2D::Flag::VertexId,
-        ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"}
+        ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"},
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"vertex pulling and object id",
+        MeshVisualizer2D::Flag::VertexPulling|MeshVisualizer2D::Flag::InstancedObjectId,
+        ": Flag::VertexPulling and Flag::InstancedObjectId are mutually exclusive"}
     #endif
 };
 
@@ -242,7 +261,15 @@ constexpr struct {
         ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"},
     {"both vertex and primitive id",
         MeshVisualizer3D::Flag::VertexId|MeshVisualizer3D::Flag::PrimitiveIdFromVertexId,
-        ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"}
+        ": Flag::InstancedObjectId, Flag::VertexId and Flag::PrimitiveId are mutually exclusive"},
+    #endif
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"vertex pulling and object id",
+        MeshVisualizer3D::Flag::VertexPulling|MeshVisualizer3D::Flag::InstancedObjectId,
+        ": Flag::VertexPulling and Flag::InstancedObjectId are mutually exclusive"},
+    {"vertex pulling and tbn direction",
+        MeshVisualizer3D::Flag::VertexPulling|MeshVisualizer3D::Flag::NormalDirection,
+        "3D: Flag::VertexPulling can't be used together with TBN direction"}
     #endif
 };
 
@@ -296,7 +323,14 @@ constexpr struct {
         1.0f, 2.0f, "wireframe3D.tga", "wireframe-nogeo3D.tga"},
     {"no geometry shader, wide/sharp",
         MeshVisualizer3D::Flag::NoGeometryShader,
-        3.0f, 1.0f, "wireframe-wide3D.tga", "wireframe-nogeo3D.tga"}
+        3.0f, 1.0f, "wireframe-wide3D.tga", "wireframe-nogeo3D.tga"},
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    {"vertex pulling", MeshVisualizer3D::Flag::VertexPulling,
+        1.0f, 2.0f, "wireframe3D.tga", nullptr},
+    {"no geometry shader, vertex pulling",
+        MeshVisualizer3D::Flag::NoGeometryShader|MeshVisualizer3D::Flag::VertexPulling,
+        1.0f, 2.0f, "wireframe3D.tga", "wireframe-nogeo3D.tga"}
+    #endif
 };
 
 #ifndef MAGNUM_TARGET_GLES2
@@ -439,6 +473,8 @@ MeshVisualizerGLTest::MeshVisualizerGLTest() {
               #endif
               #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
               &MeshVisualizerGLTest::setTangentBitangentNormalNotEnabled3D,
+              &MeshVisualizerGLTest::bindBufferTexturesNotEnabled2D,
+              &MeshVisualizerGLTest::bindBufferTexturesNotEnabled3D,
               #endif
               });
 
@@ -567,6 +603,16 @@ void MeshVisualizerGLTest::construct2D() {
     ) CORRADE_SKIP("gl_PrimitiveID not supported.");
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags & MeshVisualizer2D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::texture_buffer_object::string() + std::string(" is not supported"));
+    #else
+    if(data.flags & MeshVisualizer2D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_buffer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_buffer::string() + std::string(" is not supported"));
+    #endif
+    #endif
+
     MeshVisualizer2D shader{data.flags};
     CORRADE_COMPARE(shader.flags(), data.flags);
     CORRADE_VERIFY(shader.id());
@@ -609,6 +655,16 @@ void MeshVisualizerGLTest::construct3D() {
     ) CORRADE_SKIP("gl_PrimitiveID not supported.");
     #endif
 
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags & MeshVisualizer3D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::texture_buffer_object::string() + std::string(" is not supported"));
+    #else
+    if(data.flags & MeshVisualizer3D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_buffer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_buffer::string() + std::string(" is not supported"));
+    #endif
+    #endif
+
     MeshVisualizer3D shader{data.flags};
     CORRADE_COMPARE(shader.flags(), data.flags);
     CORRADE_VERIFY(shader.id());
@@ -919,6 +975,42 @@ void MeshVisualizerGLTest::setTangentBitangentNormalNotEnabled3D() {
         "Shaders::MeshVisualizer3D::setLineWidth(): the shader was not created with TBN direction enabled\n"
         "Shaders::MeshVisualizer3D::setLineLength(): the shader was not created with TBN direction enabled\n");
 }
+
+void MeshVisualizerGLTest::bindBufferTexturesNotEnabled2D() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::BufferTexture texture{NoCreate};
+    MeshVisualizer2D shader{NoCreate};
+    shader.bindIndexBufferTexture(texture)
+        .bindPositionBufferTexture(texture);
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizer::bindIndexBufferTexture(): the shader was not created with vertex pulling enabled\n"
+        "Shaders::MeshVisualizer::bindPositionBufferTexture(): the shader was not created with vertex pulling enabled\n");
+}
+
+void MeshVisualizerGLTest::bindBufferTexturesNotEnabled3D() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::BufferTexture texture{NoCreate};
+    MeshVisualizer3D shader{NoCreate};
+    shader.bindIndexBufferTexture(texture)
+        .bindPositionBufferTexture(texture);
+
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MeshVisualizer::bindIndexBufferTexture(): the shader was not created with vertex pulling enabled\n"
+        "Shaders::MeshVisualizer::bindPositionBufferTexture(): the shader was not created with vertex pulling enabled\n");
+}
 #endif
 
 constexpr Vector2i RenderSize{80, 80};
@@ -1445,15 +1537,54 @@ void MeshVisualizerGLTest::renderWireframe3D() {
         CORRADE_SKIP(GL::Extensions::EXT::geometry_shader::string() + std::string(" is not supported"));
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.flags & MeshVisualizer3D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::texture_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::texture_buffer_object::string() + std::string(" is not supported"));
+    #else
+    if(data.flags & MeshVisualizer3D::Flag::VertexPulling && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_buffer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_buffer::string() + std::string(" is not supported"));
+    #endif
+
     #ifdef MAGNUM_TARGET_GLES
     if(GL::Context::current().isExtensionSupported<GL::Extensions::NV::shader_noperspective_interpolation>())
         Debug() << "Using" << GL::Extensions::NV::shader_noperspective_interpolation::string();
     #endif
+    if(data.flags & MeshVisualizer3D::Flag::NoGeometryShader && GL::Context::current().isExtensionSupported<GL::Extensions::NV::fragment_shader_barycentric>())
+        Debug() << "Using" << GL::Extensions::NV::fragment_shader_barycentric::string();
     #endif
 
     const Trade::MeshData sphereData = Primitives::icosphereSolid(1);
 
+    MeshVisualizer3D shader{data.flags|MeshVisualizer3D::Flag::Wireframe};
+
     GL::Mesh sphere{NoCreate};
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    GL::Buffer indices{NoCreate}, positions{NoCreate};
+    GL::BufferTexture indexTexture{NoCreate}, positionTexture{NoCreate};
+    if(data.flags & MeshVisualizer3D::Flag::VertexPulling) {
+        /* Use the indexed data directly, padding the positions to four
+           components as RGB32F buffer textures aren't guaranteed */
+        Containers::Array<Vector3> positions3D = sphereData.positions3DAsArray();
+        Containers::Array<Vector4> positions4D{positions3D.size()};
+        for(std::size_t i = 0; i != positions3D.size(); ++i)
+            positions4D[i] = Vector4{positions3D[i], 1.0f};
+
+        indices = GL::Buffer{GL::Buffer::TargetHint::Texture};
+        indices.setData(sphereData.indicesAsArray());
+        positions = GL::Buffer{GL::Buffer::TargetHint::Texture};
+        positions.setData(positions4D);
+        indexTexture = GL::BufferTexture{};
+        indexTexture.setBuffer(GL::BufferTextureFormat::R32UI, indices);
+        positionTexture = GL::BufferTexture{};
+        positionTexture.setBuffer(GL::BufferTextureFormat::RGBA32F, positions);
+
+        sphere = GL::Mesh{};
+        sphere.setCount(sphereData.indexCount());
+        shader
+            .bindIndexBufferTexture(indexTexture)
+            .bindPositionBufferTexture(positionTexture);
+    } else
+    #endif
     if(data.flags & MeshVisualizer3D::Flag::NoGeometryShader) {
         /* Duplicate the vertices */
         sphere = MeshTools::compile(MeshTools::duplicate(sphereData));
@@ -1472,8 +1603,7 @@ void MeshVisualizerGLTest::renderWireframe3D() {
         }
     } else sphere = MeshTools::compile(sphereData);
 
-    MeshVisualizer3D{data.flags|MeshVisualizer3D::Flag::Wireframe}
-        .setColor(0xffff99_rgbf)
+    shader.setColor(0xffff99_rgbf)
         .setWireframeColor(0x9999ff_rgbf)
         .setWireframeWidth(data.width)
         .setSmoothness(data.smoothness)
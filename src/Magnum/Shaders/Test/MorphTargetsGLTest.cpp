@@ -0,0 +1,439 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/TransformFeedback.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Shaders/MorphTargets.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct MorphTargetsGLTest: GL::OpenGLTester {
+    explicit MorphTargetsGLTest();
+
+    void construct();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void constructCompute();
+    #endif
+    void constructMove();
+
+    void constructZeroMorphTargets();
+    void constructTooManyMorphTargets();
+
+    void setWeightsInvalid();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void bindBuffersNotCompute();
+    void bindNormalBuffersNotEnabled();
+    #endif
+
+    void evaluateTransformFeedback();
+    #ifndef MAGNUM_TARGET_WEBGL
+    void evaluateCompute();
+    #endif
+};
+
+constexpr struct {
+    const char* name;
+    MorphTargets::Flags flags;
+    UnsignedInt morphTargetCount;
+} ConstructData[]{
+    {"one target", {}, 1},
+    {"seven targets", {}, 7},
+    {"normals, three targets", MorphTargets::Flag::Normals, 3},
+    {"normals, seven targets", MorphTargets::Flag::Normals, 7}
+};
+
+constexpr struct {
+    const char* name;
+    MorphTargets::Flags flags;
+} EvaluateData[]{
+    {"positions", {}},
+    {"positions + normals", MorphTargets::Flag::Normals}
+};
+
+MorphTargetsGLTest::MorphTargetsGLTest() {
+    addInstancedTests({&MorphTargetsGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    addTests({&MorphTargetsGLTest::constructCompute});
+    #endif
+
+    addTests({&MorphTargetsGLTest::constructMove,
+
+              &MorphTargetsGLTest::constructZeroMorphTargets,
+              &MorphTargetsGLTest::constructTooManyMorphTargets,
+
+              &MorphTargetsGLTest::setWeightsInvalid,
+              #ifndef MAGNUM_TARGET_WEBGL
+              &MorphTargetsGLTest::bindBuffersNotCompute,
+              &MorphTargetsGLTest::bindNormalBuffersNotEnabled
+              #endif
+              });
+
+    addInstancedTests({
+        &MorphTargetsGLTest::evaluateTransformFeedback,
+        #ifndef MAGNUM_TARGET_WEBGL
+        &MorphTargetsGLTest::evaluateCompute
+        #endif
+        }, Containers::arraySize(EvaluateData));
+}
+
+/* Two vertices, three morph targets */
+constexpr Vector3 BasePositions[]{
+    {1.0f, 2.0f, 3.0f},
+    {-1.0f, 0.0f, 0.5f}
+};
+constexpr Vector3 BaseNormals[]{
+    {0.0f, 0.0f, 1.0f},
+    {0.0f, 1.0f, 0.0f}
+};
+/* Target-major, i.e. deltas of all vertices for target 0 first */
+constexpr Vector3 PositionDeltas[]{
+    {1.0f, 0.0f, 0.0f}, {0.0f, 2.0f, 0.0f},
+    {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 4.0f},
+    {0.0f, 0.0f, 1.0f}, {8.0f, 0.0f, 0.0f}
+};
+constexpr Vector3 NormalDeltas[]{
+    {1.0f, 0.0f, -1.0f}, {0.0f, 0.0f, 0.0f},
+    {0.0f, 0.0f, 0.0f}, {1.0f, -1.0f, 0.0f},
+    {0.0f, 1.0f, -1.0f}, {0.0f, 0.0f, 1.0f}
+};
+constexpr Float Weights[]{0.5f, 0.0f, 0.25f};
+constexpr Vector3 ExpectedPositions[]{
+    {1.5f, 2.0f, 3.25f},
+    {1.0f, 1.0f, 0.5f}
+};
+constexpr Vector3 ExpectedNormals[]{
+    {0.5f, 0.25f, 0.25f},
+    {0.0f, 1.0f, 0.25f}
+};
+
+void MorphTargetsGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    MorphTargets shader{data.flags, data.morphTargetCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.morphTargetCount(), data.morphTargetCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void MorphTargetsGLTest::constructCompute() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP("OpenGL 4.3 is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    /* More than what's possible with transform feedback */
+    MorphTargets shader{MorphTargets::Flag::Compute|MorphTargets::Flag::Normals, 32};
+    CORRADE_COMPARE(shader.flags(), MorphTargets::Flag::Compute|MorphTargets::Flag::Normals);
+    CORRADE_COMPARE(shader.morphTargetCount(), 32);
+    CORRADE_VERIFY(shader.id());
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
+void MorphTargetsGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    MorphTargets a{MorphTargets::Flag::Normals, 3};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    MorphTargets b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), MorphTargets::Flag::Normals);
+    CORRADE_COMPARE(b.morphTargetCount(), 3);
+    CORRADE_VERIFY(!a.id());
+
+    MorphTargets c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), MorphTargets::Flag::Normals);
+    CORRADE_COMPARE(c.morphTargetCount(), 3);
+    CORRADE_VERIFY(!b.id());
+}
+
+void MorphTargetsGLTest::constructZeroMorphTargets() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MorphTargets{{}, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MorphTargets: expected at least one morph target\n");
+}
+
+void MorphTargetsGLTest::constructTooManyMorphTargets() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MorphTargets{{}, 8};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MorphTargets: at most 7 morph targets supported with transform feedback but got 8\n");
+}
+
+void MorphTargetsGLTest::setWeightsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    MorphTargets shader{{}, 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setWeights({0.0f, 1.0f, 0.5f, 0.25f})
+        .setWeight(3, 1.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MorphTargets::setWeights(): expected at most 3 items but got 4\n"
+        "Shaders::MorphTargets::setWeight(): morph target ID 3 is out of bounds for 3 morph targets\n");
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void MorphTargetsGLTest::bindBuffersNotCompute() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    MorphTargets shader{{}, 3};
+    GL::Buffer buffer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.bindBasePositionBuffer(buffer)
+        .bindPositionDeltaBuffer(buffer)
+        .bindPositionBuffer(buffer)
+        .dispatch(16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MorphTargets::bindBasePositionBuffer(): the shader was not created with compute enabled\n"
+        "Shaders::MorphTargets::bindPositionDeltaBuffer(): the shader was not created with compute enabled\n"
+        "Shaders::MorphTargets::bindPositionBuffer(): the shader was not created with compute enabled\n"
+        "Shaders::MorphTargets::dispatch(): the shader was not created with compute enabled\n");
+}
+
+void MorphTargetsGLTest::bindNormalBuffersNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP("OpenGL 4.3 is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    MorphTargets shader{MorphTargets::Flag::Compute, 3};
+    GL::Buffer buffer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.bindBaseNormalBuffer(buffer)
+        .bindNormalDeltaBuffer(buffer)
+        .bindNormalBuffer(buffer);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::MorphTargets::bindBaseNormalBuffer(): the shader was not created with normals enabled\n"
+        "Shaders::MorphTargets::bindNormalDeltaBuffer(): the shader was not created with normals enabled\n"
+        "Shaders::MorphTargets::bindNormalBuffer(): the shader was not created with normals enabled\n");
+}
+#endif
+
+void MorphTargetsGLTest::evaluateTransformFeedback() {
+    auto&& data = EvaluateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>())
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    /* Bind some FB to avoid errors on contexts w/o default FB */
+    GL::Renderbuffer color;
+    color.setStorage(GL::RenderbufferFormat::RGBA8, Vector2i{32});
+    GL::Framebuffer fb{{{}, Vector2i{32}}};
+    fb.attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, color)
+      .bind();
+
+    MorphTargets shader{data.flags, 3};
+    shader.setWeights(Weights);
+
+    GL::Buffer basePositions{GL::Buffer::TargetHint::Array, BasePositions};
+    GL::Buffer baseNormals{GL::Buffer::TargetHint::Array, BaseNormals};
+    GL::Buffer positionDeltas{GL::Buffer::TargetHint::Array, PositionDeltas};
+    GL::Buffer normalDeltas{GL::Buffer::TargetHint::Array, NormalDeltas};
+    GL::Buffer positions{GL::Buffer::TargetHint::TransformFeedback};
+    positions.setData({nullptr, 2*sizeof(Vector3)}, GL::BufferUsage::StaticRead);
+    GL::Buffer normals{GL::Buffer::TargetHint::TransformFeedback};
+    normals.setData({nullptr, 2*sizeof(Vector3)}, GL::BufferUsage::StaticRead);
+
+    GL::Mesh mesh{MeshPrimitive::Points};
+    mesh.setCount(2)
+        .addVertexBuffer(basePositions, 0, MorphTargets::Position{})
+        .addVertexBuffer(positionDeltas, 0, MorphTargets::PositionDelta<0>{})
+        .addVertexBuffer(positionDeltas, 2*sizeof(Vector3), MorphTargets::PositionDelta<1>{})
+        .addVertexBuffer(positionDeltas, 4*sizeof(Vector3), MorphTargets::PositionDelta<2>{});
+    if(data.flags & MorphTargets::Flag::Normals) mesh
+        .addVertexBuffer(baseNormals, 0, MorphTargets::Normal{})
+        .addVertexBuffer(normalDeltas, 0, MorphTargets::NormalDelta<0>{})
+        .addVertexBuffer(normalDeltas, 2*sizeof(Vector3), MorphTargets::NormalDelta<1>{})
+        .addVertexBuffer(normalDeltas, 4*sizeof(Vector3), MorphTargets::NormalDelta<2>{});
+
+    GL::TransformFeedback feedback;
+    feedback.attachBuffer(MorphTargets::PositionOutput, positions);
+    if(data.flags & MorphTargets::Flag::Normals)
+        feedback.attachBuffer(MorphTargets::NormalOutput, normals);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    GL::Renderer::enable(GL::Renderer::Feature::RasterizerDiscard);
+    feedback.begin(shader, GL::TransformFeedback::PrimitiveMode::Points);
+    shader.draw(mesh);
+    feedback.end();
+    GL::Renderer::disable(GL::Renderer::Feature::RasterizerDiscard);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Can't map buffers on WebGL.");
+    #else
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Vector3>(positions.mapRead(0, 2*sizeof(Vector3))),
+        Containers::arrayView(ExpectedPositions),
+        TestSuite::Compare::Container);
+    positions.unmap();
+    if(data.flags & MorphTargets::Flag::Normals) {
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Vector3>(normals.mapRead(0, 2*sizeof(Vector3))),
+            Containers::arrayView(ExpectedNormals),
+            TestSuite::Compare::Container);
+        normals.unmap();
+    }
+    #endif
+}
+
+#ifndef MAGNUM_TARGET_WEBGL
+void MorphTargetsGLTest::evaluateCompute() {
+    auto&& data = EvaluateData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL430))
+        CORRADE_SKIP("OpenGL 4.3 is not supported.");
+    #else
+    if(!GL::Context::current().isVersionSupported(GL::Version::GLES310))
+        CORRADE_SKIP("OpenGL ES 3.1 is not supported.");
+    #endif
+
+    MorphTargets shader{data.flags|MorphTargets::Flag::Compute, 3};
+    shader.setWeights(Weights);
+
+    GL::Buffer basePositions{GL::Buffer::TargetHint::ShaderStorage, BasePositions};
+    GL::Buffer baseNormals{GL::Buffer::TargetHint::ShaderStorage, BaseNormals};
+    GL::Buffer positionDeltas{GL::Buffer::TargetHint::ShaderStorage, PositionDeltas};
+    GL::Buffer normalDeltas{GL::Buffer::TargetHint::ShaderStorage, NormalDeltas};
+    GL::Buffer positions{GL::Buffer::TargetHint::ShaderStorage};
+    positions.setData({nullptr, 2*sizeof(Vector3)}, GL::BufferUsage::StaticRead);
+    GL::Buffer normals{GL::Buffer::TargetHint::ShaderStorage};
+    normals.setData({nullptr, 2*sizeof(Vector3)}, GL::BufferUsage::StaticRead);
+
+    shader.bindBasePositionBuffer(basePositions)
+        .bindPositionDeltaBuffer(positionDeltas)
+        .bindPositionBuffer(positions);
+    if(data.flags & MorphTargets::Flag::Normals) shader
+        .bindBaseNormalBuffer(baseNormals)
+        .bindNormalDeltaBuffer(normalDeltas)
+        .bindNormalBuffer(normals);
+    shader.dispatch(2);
+    GL::Renderer::setMemoryBarrier(GL::Renderer::MemoryBarrier::BufferUpdate);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Vector3>(positions.mapRead(0, 2*sizeof(Vector3))),
+        Containers::arrayView(ExpectedPositions),
+        TestSuite::Compare::Container);
+    positions.unmap();
+    if(data.flags & MorphTargets::Flag::Normals) {
+        CORRADE_COMPARE_AS(Containers::arrayCast<const Vector3>(normals.mapRead(0, 2*sizeof(Vector3))),
+            Containers::arrayView(ExpectedNormals),
+            TestSuite::Compare::Container);
+        normals.unmap();
+    }
+}
+#endif
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::MorphTargetsGLTest)
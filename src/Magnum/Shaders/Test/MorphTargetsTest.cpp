@@ -0,0 +1,90 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Shaders/MorphTargets.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct MorphTargetsTest: TestSuite::Tester {
+    explicit MorphTargetsTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void debugFlag();
+    void debugFlags();
+};
+
+MorphTargetsTest::MorphTargetsTest() {
+    addTests({&MorphTargetsTest::constructNoCreate,
+              &MorphTargetsTest::constructCopy,
+
+              &MorphTargetsTest::debugFlag,
+              &MorphTargetsTest::debugFlags});
+}
+
+void MorphTargetsTest::constructNoCreate() {
+    {
+        MorphTargets shader{NoCreate};
+        CORRADE_COMPARE(shader.id(), 0);
+        CORRADE_COMPARE(shader.flags(), MorphTargets::Flags{});
+        CORRADE_COMPARE(shader.morphTargetCount(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void MorphTargetsTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MorphTargets>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MorphTargets>{});
+}
+
+void MorphTargetsTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << MorphTargets::Flag::Normals << MorphTargets::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::MorphTargets::Flag::Normals Shaders::MorphTargets::Flag(0xf0)\n");
+}
+
+void MorphTargetsTest::debugFlags() {
+    std::ostringstream out;
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    Debug{&out} << (MorphTargets::Flag::Normals|MorphTargets::Flag::Compute) << MorphTargets::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::MorphTargets::Flag::Normals|Shaders::MorphTargets::Flag::Compute Shaders::MorphTargets::Flags{}\n");
+    #else
+    Debug{&out} << MorphTargets::Flag::Normals << MorphTargets::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::MorphTargets::Flag::Normals Shaders::MorphTargets::Flags{}\n");
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::MorphTargetsTest)
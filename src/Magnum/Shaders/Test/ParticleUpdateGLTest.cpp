@@ -0,0 +1,346 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Shaders/ParticleSystem.h"
+#include "Magnum/Shaders/ParticleUpdate.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct ParticleUpdateGLTest: GL::OpenGLTester {
+    explicit ParticleUpdateGLTest();
+
+    void construct();
+    void constructMove();
+    void constructInvalid();
+
+    void setEmitterInvalid();
+
+    void constructSystem();
+    void constructSystemMove();
+    void constructSystemZeroParticles();
+
+    void update();
+    void updateEmitterDisabled();
+};
+
+constexpr struct {
+    const char* name;
+    UnsignedInt emitterCount;
+} ConstructData[]{
+    {"one emitter", 1},
+    {"sixteen emitters", 16}
+};
+
+ParticleUpdateGLTest::ParticleUpdateGLTest() {
+    addInstancedTests({&ParticleUpdateGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({&ParticleUpdateGLTest::constructMove,
+              &ParticleUpdateGLTest::constructInvalid,
+
+              &ParticleUpdateGLTest::setEmitterInvalid,
+
+              &ParticleUpdateGLTest::constructSystem,
+              &ParticleUpdateGLTest::constructSystemMove,
+              &ParticleUpdateGLTest::constructSystemZeroParticles,
+
+              &ParticleUpdateGLTest::update,
+              &ParticleUpdateGLTest::updateEmitterDisabled});
+}
+
+/* Layout written by the shader */
+struct Particle {
+    Vector4 positionAge;
+    Vector4 velocityLifetime;
+    Color4 color;
+};
+
+void ParticleUpdateGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleUpdate shader{data.emitterCount};
+    CORRADE_COMPARE(shader.emitterCount(), data.emitterCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ParticleUpdateGLTest::constructMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleUpdate a{3};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    ParticleUpdate b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.emitterCount(), 3);
+    CORRADE_VERIFY(!a.id());
+
+    ParticleUpdate c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.emitterCount(), 3);
+    CORRADE_VERIFY(!b.id());
+}
+
+void ParticleUpdateGLTest::constructInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ParticleUpdate{0};
+    ParticleUpdate{17};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::ParticleUpdate: expected 1 to 16 emitters but got 0\n"
+        "Shaders::ParticleUpdate: expected 1 to 16 emitters but got 17\n");
+}
+
+void ParticleUpdateGLTest::setEmitterInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::transform_feedback>())
+        CORRADE_SKIP(GL::Extensions::EXT::transform_feedback::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleUpdate shader{2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setEmitterPosition(2, {})
+        .setEmitterVelocity(2, {})
+        .setEmitterLifetime(2, 1.0f)
+        .setEmitterLifetime(1, -1.0f);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::ParticleUpdate::setEmitterPosition(): emitter ID 2 is out of bounds for 2 emitters\n"
+        "Shaders::ParticleUpdate::setEmitterVelocity(): emitter ID 2 is out of bounds for 2 emitters\n"
+        "Shaders::ParticleUpdate::setEmitterLifetime(): emitter ID 2 is out of bounds for 2 emitters\n"
+        "Shaders::ParticleUpdate::setEmitterLifetime(): expected a non-negative lifetime but got -1\n");
+}
+
+void ParticleUpdateGLTest::constructSystem() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>())
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleSystem system{16};
+    CORRADE_COMPARE(system.particleCount(), 16);
+    CORRADE_VERIFY(system.buffer().id());
+    CORRADE_VERIFY(system.mesh().id());
+    CORRADE_COMPARE(system.buffer().size(), Int(16*sizeof(Particle)));
+    CORRADE_COMPARE(system.mesh().primitive(), GL::MeshPrimitive::Points);
+    CORRADE_COMPARE(system.mesh().count(), 16);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ParticleUpdateGLTest::constructSystemMove() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>())
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleSystem a{16};
+    const GLuint id = a.buffer().id();
+    CORRADE_VERIFY(id);
+
+    ParticleSystem b{std::move(a)};
+    CORRADE_COMPARE(b.particleCount(), 16);
+    CORRADE_COMPARE(b.buffer().id(), id);
+    CORRADE_VERIFY(!a.buffer().id());
+
+    ParticleSystem c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.particleCount(), 16);
+    CORRADE_COMPARE(c.buffer().id(), id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void ParticleUpdateGLTest::constructSystemZeroParticles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ParticleSystem{0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::ParticleSystem: expected a non-zero particle count\n");
+}
+
+void ParticleUpdateGLTest::update() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>())
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    ParticleUpdate shader;
+    shader.setEmitterPosition(0, {1.0f, 2.0f, 3.0f})
+        .setEmitterVelocity(0, {0.0f, 1.0f, 0.0f})
+        .setEmitterLifetime(0, 100.0f)
+        .setAcceleration({0.0f, 0.0f, -2.0f})
+        .setStartColor(0xff3366ff_rgbaf)
+        .setEndColor(0xff3366ff_rgbaf);
+
+    ParticleSystem system{16};
+
+    /* First update schedules all particles to spawn after a random delay
+       shorter than the lifetime, none is visible yet */
+    shader.setTimeDelta(0.5f)
+        .setSeed(1);
+    system.update(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Can't map buffers on WebGL.");
+    #else
+    {
+        Containers::ArrayView<const Particle> particles = Containers::arrayCast<const Particle>(system.buffer().mapRead(0, 16*sizeof(Particle)));
+        for(std::size_t i = 0; i != particles.size(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(particles[i].velocityLifetime.w(), 100.0f);
+            CORRADE_COMPARE_AS(particles[i].positionAge.w(), 0.0f,
+                TestSuite::Compare::Less);
+            CORRADE_COMPARE_AS(particles[i].positionAge.w(), -100.0f,
+                TestSuite::Compare::GreaterOrEqual);
+            CORRADE_COMPARE(particles[i].color, Color4{});
+        }
+        system.buffer().unmap();
+    }
+
+    /* After the longest possible delay all are spawned at the emitter */
+    shader.setTimeDelta(100.0f)
+        .setSeed(2);
+    system.update(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Float ages[16];
+    {
+        Containers::ArrayView<const Particle> particles = Containers::arrayCast<const Particle>(system.buffer().mapRead(0, 16*sizeof(Particle)));
+        for(std::size_t i = 0; i != particles.size(); ++i) {
+            CORRADE_ITERATION(i);
+            CORRADE_COMPARE(particles[i].positionAge.xyz(), (Vector3{1.0f, 2.0f, 3.0f}));
+            CORRADE_COMPARE(particles[i].velocityLifetime, (Vector4{0.0f, 1.0f, 0.0f, 100.0f}));
+            CORRADE_COMPARE_AS(particles[i].positionAge.w(), 0.0f,
+                TestSuite::Compare::GreaterOrEqual);
+            CORRADE_COMPARE_AS(particles[i].positionAge.w(), 100.0f,
+                TestSuite::Compare::Less);
+            CORRADE_COMPARE(particles[i].color, 0xff3366ff_rgbaf);
+            ages[i] = particles[i].positionAge.w();
+        }
+        system.buffer().unmap();
+    }
+
+    /* Alive particles are integrated */
+    shader.setTimeDelta(0.5f)
+        .setSeed(3);
+    system.update(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    {
+        Containers::ArrayView<const Particle> particles = Containers::arrayCast<const Particle>(system.buffer().mapRead(0, 16*sizeof(Particle)));
+        for(std::size_t i = 0; i != particles.size(); ++i) {
+            CORRADE_ITERATION(i);
+            /* Particles at the end of their lifetime got respawned, skip
+               those */
+            if(ages[i] + 0.5f >= 100.0f) continue;
+            CORRADE_COMPARE(particles[i].positionAge, (Vector4{1.0f, 2.5f, 2.5f, ages[i] + 0.5f}));
+            CORRADE_COMPARE(particles[i].velocityLifetime, (Vector4{0.0f, 1.0f, -1.0f, 100.0f}));
+        }
+        system.buffer().unmap();
+    }
+    #endif
+}
+
+void ParticleUpdateGLTest::updateEmitterDisabled() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::transform_feedback2>())
+        CORRADE_SKIP(GL::Extensions::ARB::transform_feedback2::string() + std::string(" is not supported."));
+    #endif
+
+    /* Emitter lifetime is zero by default, so nothing gets emitted */
+    ParticleUpdate shader;
+    shader.setEmitterPosition(0, {1.0f, 2.0f, 3.0f})
+        .setTimeDelta(10.0f);
+
+    ParticleSystem system{16};
+    system.update(shader)
+        .update(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifdef MAGNUM_TARGET_WEBGL
+    CORRADE_SKIP("Can't map buffers on WebGL.");
+    #else
+    Containers::ArrayView<const Particle> particles = Containers::arrayCast<const Particle>(system.buffer().mapRead(0, 16*sizeof(Particle)));
+    for(std::size_t i = 0; i != particles.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(particles[i].positionAge, Vector4{});
+        CORRADE_COMPARE(particles[i].velocityLifetime, Vector4{});
+        CORRADE_COMPARE(particles[i].color, Color4{});
+    }
+    system.buffer().unmap();
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ParticleUpdateGLTest)
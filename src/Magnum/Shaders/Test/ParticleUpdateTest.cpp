@@ -0,0 +1,87 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Shaders/ParticleSystem.h"
+#include "Magnum/Shaders/ParticleUpdate.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct ParticleUpdateTest: TestSuite::Tester {
+    explicit ParticleUpdateTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void constructNoCreateSystem();
+    void constructCopySystem();
+};
+
+ParticleUpdateTest::ParticleUpdateTest() {
+    addTests({&ParticleUpdateTest::constructNoCreate,
+              &ParticleUpdateTest::constructCopy,
+
+              &ParticleUpdateTest::constructNoCreateSystem,
+              &ParticleUpdateTest::constructCopySystem});
+}
+
+void ParticleUpdateTest::constructNoCreate() {
+    {
+        ParticleUpdate shader{NoCreate};
+        CORRADE_COMPARE(shader.id(), 0);
+        CORRADE_COMPARE(shader.emitterCount(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ParticleUpdateTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ParticleUpdate>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ParticleUpdate>{});
+}
+
+void ParticleUpdateTest::constructNoCreateSystem() {
+    {
+        ParticleSystem system{NoCreate};
+        CORRADE_COMPARE(system.particleCount(), 0);
+        CORRADE_COMPARE(system.buffer().id(), 0);
+        CORRADE_COMPARE(system.mesh().id(), 0);
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void ParticleUpdateTest::constructCopySystem() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ParticleSystem>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ParticleSystem>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ParticleSystem>{});
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ParticleSystem>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ParticleUpdateTest)
@@ -30,11 +30,13 @@
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/System.h>
 
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#include "Magnum/GL/Buffer.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
@@ -47,11 +49,16 @@
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/Math/Range.h"
 #include "Magnum/MeshTools/Compile.h"
 #include "Magnum/MeshTools/Transform.h"
 #include "Magnum/Primitives/Plane.h"
 #include "Magnum/Primitives/UVSphere.h"
 #include "Magnum/Shaders/Phong.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/LightClusters.h"
+#endif
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/MeshData.h"
@@ -64,10 +71,20 @@ struct PhongGLTest: GL::OpenGLTester {
     explicit PhongGLTest();
 
     void construct();
+    void constructAsync();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffers();
+    void constructSkinning();
+    #endif
 
     void constructMove();
 
     void constructTextureTransformationNotTextured();
+    #ifndef MAGNUM_TARGET_GLES2
+    void constructUniformBuffersZeroMaterials();
+    void constructUniformBuffersZeroDraws();
+    void constructClusteredLightsZeroLights();
+    #endif
 
     void bindTexturesNotEnabled();
     void setAlphaMaskNotEnabled();
@@ -77,6 +94,16 @@ struct PhongGLTest: GL::OpenGLTester {
     #endif
     void setWrongLightCount();
     void setWrongLightId();
+    #ifndef MAGNUM_TARGET_GLES2
+    void setUniformUniformBuffersEnabled();
+    void bindBufferUniformBuffersNotEnabled();
+    void bindTextureTransformationBufferNotEnabled();
+    void clusteredLightsNotEnabled();
+    void setLightClusterDepthRangeInvalid();
+    void setWrongDrawOffset();
+    void setWrongJointCountOrId();
+    void bindJointBufferNoJoints();
+    #endif
 
     void renderSetup();
     void renderTeardown();
@@ -91,6 +118,7 @@ struct PhongGLTest: GL::OpenGLTester {
     template<class T> void renderVertexColor();
 
     void renderShininess();
+    void renderOctahedralNormals();
 
     void renderAlphaSetup();
     void renderAlphaTeardown();
@@ -111,6 +139,11 @@ struct PhongGLTest: GL::OpenGLTester {
 
     void renderInstanced();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderUniformBuffers();
+    void renderClusteredLights();
+    #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         std::string _testDir;
@@ -150,6 +183,9 @@ constexpr struct {
     {"normal texture", Phong::Flag::NormalTexture, 1},
     {"normal texture + separate bitangents", Phong::Flag::NormalTexture|Phong::Flag::Bitangent, 1},
     {"separate bitangents alone", Phong::Flag::Bitangent, 1},
+    {"octahedral normals", Phong::Flag::OctahedralNormals, 1},
+    {"octahedral normals + normal texture", Phong::Flag::OctahedralNormals|Phong::Flag::NormalTexture, 1},
+    {"octahedral normals + normal texture + separate bitangents", Phong::Flag::OctahedralNormals|Phong::Flag::NormalTexture|Phong::Flag::Bitangent, 1},
     {"ambient + diffuse texture", Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture, 1},
     {"ambient + specular texture", Phong::Flag::AmbientTexture|Phong::Flag::SpecularTexture, 1},
     {"diffuse + specular texture", Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture, 1},
@@ -171,6 +207,27 @@ constexpr struct {
     {"instanced normal texture offset", Phong::Flag::NormalTexture|Phong::Flag::InstancedTextureOffset, 3}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Phong::Flags flags;
+    UnsignedInt lightCount, materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"classic fallback", {}, 1, 1, 1},
+    {"", Phong::Flag::UniformBuffers, 1, 1, 1},
+    {"multiple lights, materials, draws", Phong::Flag::UniformBuffers, 8, 16, 24},
+    {"zero lights", Phong::Flag::UniformBuffers, 0, 16, 24},
+    {"ambient + diffuse + specular + normal texture + texture transformation", Phong::Flag::UniformBuffers|Phong::Flag::AmbientTexture|Phong::Flag::DiffuseTexture|Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation, 1, 1, 1},
+    {"alpha mask", Phong::Flag::UniformBuffers|Phong::Flag::AlphaMask, 1, 1, 1},
+    {"object ID", Phong::Flag::UniformBuffers|Phong::Flag::ObjectId, 1, 1, 1},
+    {"instanced object ID", Phong::Flag::UniformBuffers|Phong::Flag::InstancedObjectId, 1, 1, 1},
+    {"clustered lights", Phong::Flag::ClusteredLights, 8, 16, 24},
+    #ifndef MAGNUM_TARGET_GLES
+    {"multidraw with all the things", Phong::Flag::MultiDraw|Phong::Flag::DiffuseTexture|Phong::Flag::NormalTexture|Phong::Flag::TextureTransformation|Phong::Flag::AlphaMask|Phong::Flag::InstancedObjectId, 8, 16, 24}
+    #endif
+};
+#endif
+
 using namespace Math::Literals;
 
 const struct {
@@ -485,9 +542,22 @@ constexpr struct {
 PhongGLTest::PhongGLTest() {
     addInstancedTests({&PhongGLTest::construct}, Containers::arraySize(ConstructData));
 
+    addTests({&PhongGLTest::constructAsync});
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&PhongGLTest::constructUniformBuffers}, Containers::arraySize(ConstructUniformBuffersData));
+
+    addTests({&PhongGLTest::constructSkinning});
+    #endif
+
     addTests({&PhongGLTest::constructMove,
 
               &PhongGLTest::constructTextureTransformationNotTextured,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::constructUniformBuffersZeroMaterials,
+              &PhongGLTest::constructUniformBuffersZeroDraws,
+              &PhongGLTest::constructClusteredLightsZeroLights,
+              #endif
 
               &PhongGLTest::bindTexturesNotEnabled,
               &PhongGLTest::setAlphaMaskNotEnabled,
@@ -496,7 +566,18 @@ PhongGLTest::PhongGLTest() {
               &PhongGLTest::setObjectIdNotEnabled,
               #endif
               &PhongGLTest::setWrongLightCount,
-              &PhongGLTest::setWrongLightId});
+              &PhongGLTest::setWrongLightId,
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongGLTest::setUniformUniformBuffersEnabled,
+              &PhongGLTest::bindBufferUniformBuffersNotEnabled,
+              &PhongGLTest::bindTextureTransformationBufferNotEnabled,
+              &PhongGLTest::clusteredLightsNotEnabled,
+              &PhongGLTest::setLightClusterDepthRangeInvalid,
+              &PhongGLTest::setWrongDrawOffset,
+              &PhongGLTest::setWrongJointCountOrId,
+              &PhongGLTest::bindJointBufferNoJoints
+              #endif
+              });
 
     addTests({&PhongGLTest::renderDefaults},
         &PhongGLTest::renderSetup,
@@ -532,6 +613,10 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
+    addTests({&PhongGLTest::renderOctahedralNormals},
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+
     addInstancedTests({&PhongGLTest::renderAlpha},
         Containers::arraySize(RenderAlphaData),
         &PhongGLTest::renderAlphaSetup,
@@ -569,6 +654,13 @@ PhongGLTest::PhongGLTest() {
         &PhongGLTest::renderSetup,
         &PhongGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&PhongGLTest::renderUniformBuffers,
+              &PhongGLTest::renderClusteredLights},
+        &PhongGLTest::renderSetup,
+        &PhongGLTest::renderTeardown);
+    #endif
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -616,6 +708,106 @@ void PhongGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+void PhongGLTest::constructAsync() {
+    Phong::CompileState state = Phong::compile(Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture, 3);
+    CORRADE_COMPARE(state.flags(), Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture);
+    CORRADE_COMPARE(state.lightCount(), 3);
+
+    while(!state.isLinkFinished())
+        Utility::System::sleep(100);
+
+    Phong shader{std::move(state)};
+    CORRADE_COMPARE(shader.flags(), Phong::Flag::SpecularTexture|Phong::Flag::NormalTexture);
+    CORRADE_COMPARE(shader.lightCount(), 3);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffers() {
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if((data.flags & Phong::Flag::UniformBuffers) && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if((data.flags & Phong::Flag::ObjectId) && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    if(data.flags >= Phong::Flag::MultiDraw && !GL::Context::current().isExtensionSupported<GL::Extensions::ARB::shader_draw_parameters>())
+        CORRADE_SKIP(GL::Extensions::ARB::shader_draw_parameters::string() + std::string(" is not supported"));
+    if(data.flags >= Phong::Flag::ClusteredLights && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_integer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_integer::string() + std::string(" is not supported"));
+    #endif
+
+    Phong shader{data.flags, data.lightCount, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.lightCount(), data.lightCount);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void PhongGLTest::constructSkinning() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    {
+        /* Joint matrices are placed after all light uniforms, test with a
+           nontrivial light count and normal mapping to verify that */
+        Phong shader{Phong::Flag::NormalTexture|Phong::Flag::Bitangent, 3, 1, 1, 16};
+        CORRADE_COMPARE(shader.jointCount(), 16);
+        CORRADE_VERIFY(shader.id());
+        {
+            #ifdef CORRADE_TARGET_APPLE
+            CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+            #endif
+            CORRADE_VERIFY(shader.validate().first);
+        }
+
+        /* Setting fewer matrices than the joint count is allowed */
+        shader.setJointMatrices({Matrix4{}, Matrix4{}})
+            .setJointMatrix(15, Matrix4{})
+            .setLightRange(2, 1.0f);
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    {
+        Phong shader{Phong::Flag::UniformBuffers, 3, 1, 3, 32};
+        CORRADE_COMPARE(shader.jointCount(), 32);
+        CORRADE_VERIFY(shader.id());
+        {
+            #ifdef CORRADE_TARGET_APPLE
+            CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+            #endif
+            CORRADE_VERIFY(shader.validate().first);
+        }
+        MAGNUM_VERIFY_NO_GL_ERROR();
+    }
+}
+#endif
+
 void PhongGLTest::constructMove() {
     Phong a{Phong::Flag::AlphaMask, 3};
     const GLuint id = a.id();
@@ -649,6 +841,44 @@ void PhongGLTest::constructTextureTransformationNotTextured() {
         "Shaders::Phong: texture transformation enabled but the shader is not textured\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::constructUniformBuffersZeroMaterials() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: material count can't be zero\n");
+}
+
+void PhongGLTest::constructUniformBuffersZeroDraws() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: draw count can't be zero\n");
+}
+
+void PhongGLTest::constructClusteredLightsZeroLights() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::ClusteredLights, 0, 1, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong: light count can't be zero with clustered lights\n");
+}
+#endif
+
 void PhongGLTest::bindTexturesNotEnabled() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -756,6 +986,243 @@ void PhongGLTest::setWrongLightId() {
         "Shaders::Phong::setLightRange(): light ID 3 is out of bounds for 3 lights\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::setUniformUniformBuffersEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.setAmbientColor({})
+        .setDiffuseColor({})
+        .setNormalTextureScale({})
+        .setSpecularColor({})
+        .setShininess({})
+        .setAlphaMask({})
+        .setObjectId({})
+        .setTransformationMatrix({})
+        .setNormalMatrix({})
+        .setProjectionMatrix({})
+        .setTextureMatrix({})
+        .setLightPositions({Vector4{}})
+        .setLightPosition(0, Vector4{})
+        .setLightColors({Color3{}})
+        .setLightColor(0, Color3{})
+        .setLightSpecularColors({Color3{}})
+        .setLightSpecularColor(0, Color3{})
+        .setLightRanges({0.0f})
+        .setLightRange(0, {})
+        .setJointMatrices({})
+        .setJointMatrix(0, {});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setAmbientColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setDiffuseColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalTextureScale(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setShininess(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setAlphaMask(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setObjectId(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTransformationMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setNormalMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPositions(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightPosition(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColors(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightSpecularColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRanges(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setLightRange(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setJointMatrices(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Phong::setJointMatrix(): the shader was created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::bindBufferUniformBuffersNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Phong shader;
+    shader.bindProjectionBuffer(buffer)
+        .bindProjectionBuffer(buffer, 0, 16)
+        .bindTransformationBuffer(buffer)
+        .bindTransformationBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .bindLightBuffer(buffer)
+        .bindLightBuffer(buffer, 0, 16)
+        .bindJointBuffer(buffer)
+        .bindJointBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindLightBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Phong::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+void PhongGLTest::clusteredLightsNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Texture2D texture2D;
+    GL::Texture3D texture3D;
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.setViewportSize({})
+        .setLightClusterDepthRange({1.0f, 100.0f})
+        .bindLightClusterTexture(texture3D)
+        .bindLightClusterIndexTexture(texture2D);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setViewportSize(): the shader was not created with clustered lights enabled\n"
+        "Shaders::Phong::setLightClusterDepthRange(): the shader was not created with clustered lights enabled\n"
+        "Shaders::Phong::bindLightClusterTexture(): the shader was not created with clustered lights enabled\n"
+        "Shaders::Phong::bindLightClusterIndexTexture(): the shader was not created with clustered lights enabled\n");
+}
+
+void PhongGLTest::setLightClusterDepthRangeInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_integer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_integer::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Phong shader{Phong::Flag::ClusteredLights, 1, 1, 1};
+    shader.setLightClusterDepthRange({0.0f, 100.0f})
+        .setLightClusterDepthRange({10.0f, 10.0f});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setLightClusterDepthRange(): expected a positive range, got {0, 100}\n"
+        "Shaders::Phong::setLightClusterDepthRange(): expected a positive range, got {10, 10}\n");
+}
+
+void PhongGLTest::bindTextureTransformationBufferNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::Phong::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+void PhongGLTest::setWrongDrawOffset() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Phong{Phong::Flag::UniformBuffers, 1, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+
+void PhongGLTest::setWrongJointCountOrId() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    Phong shader{{}, 1, 1, 1, 2};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setJointMatrices({Matrix4{}, Matrix4{}, Matrix4{}})
+        .setJointMatrix(2, Matrix4{});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::setJointMatrices(): expected at most 2 items but got 3\n"
+        "Shaders::Phong::setJointMatrix(): joint ID 2 is out of bounds for 2 joints\n");
+}
+
+void PhongGLTest::bindJointBufferNoJoints() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Phong shader{Phong::Flag::UniformBuffers};
+    shader.bindJointBuffer(buffer)
+        .bindJointBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with joints\n"
+        "Shaders::Phong::bindJointBuffer(): the shader was not created with joints\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void PhongGLTest::renderSetup() {
@@ -1287,6 +1754,55 @@ void PhongGLTest::renderShininess() {
     }
 }
 
+void PhongGLTest::renderOctahedralNormals() {
+    /* Same as renderShininess() with the default setup, except that the
+       normals are packed to two 16-bit components */
+    Trade::MeshData sphereData = Primitives::uvSphereSolid(16, 32);
+    Containers::Array<Vector3> normals = sphereData.normalsAsArray();
+    Containers::Array<Vector2s> octahedralNormals{NoInit, normals.size()};
+    Math::packOctahedralInto(Containers::stridedArrayView(normals),
+        Containers::stridedArrayView(octahedralNormals));
+
+    GL::Mesh sphere;
+    sphere.setCount(sphereData.indexCount())
+        .addVertexBuffer(GL::Buffer{sphereData.positions3DAsArray()}, 0,
+            Phong::Position{})
+        .addVertexBuffer(GL::Buffer{octahedralNormals}, 0,
+            Phong::OctahedralNormal{
+                Phong::OctahedralNormal::DataType::Short,
+                Phong::OctahedralNormal::DataOption::Normalized})
+        .setIndexBuffer(GL::Buffer{sphereData.indicesAsArray()}, 0,
+            MeshIndexType::UnsignedInt);
+
+    Phong{Phong::Flag::OctahedralNormals}
+        .setLightPositions({{-3.0f, -3.0f, 2.0f, 0.0f}})
+        .setDiffuseColor(0xff3333_rgbf)
+        .setSpecularColor(0xffffff_rgbf)
+        .setShininess(80.0f)
+        .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+        .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    /* Slightly larger than in renderShininess() due to the quantization */
+    const Float maxThreshold = 16.0f, meanThreshold = 0.067f;
+    #else
+    /* WebGL 1 doesn't have 8bit renderbuffer storage, so it's way worse */
+    const Float maxThreshold = 16.667f, meanThreshold = 2.583f;
+    #endif
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join({_testDir, "PhongTestFiles", "shininess80.tga"}),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+
 void PhongGLTest::renderAlphaSetup() {
     renderSetup();
     if(RenderAlphaData[testCaseInstanceId()].blending)
@@ -1854,6 +2370,157 @@ void PhongGLTest::renderInstanced() {
         (DebugTools::CompareImageToFile{_manager, data.maxThreshold, data.meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongGLTest::renderUniformBuffers() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Verify that the draw offset, material ID and light range get used by
+       putting the actual data in the middle of the buffers and surrounding
+       them with garbage */
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+            .setProjectionMatrix(Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f))
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{},
+        TransformationUniform3D{}
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{},
+        PhongDrawUniform{}
+            .setMaterialId(1)
+            .setLightOffsetCount(1, 2)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            .setDiffuseColor(0xff0000_rgbf),
+        PhongMaterialUniform{}
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+    }};
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongLightUniform{}
+            .setColor(0xff0000_rgbf),
+        PhongLightUniform{}
+            .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+            .setColor(0x993366_rgbf),
+        PhongLightUniform{}
+            .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+            .setColor(0x669933_rgbf),
+        PhongLightUniform{}
+            .setColor(0xff0000_rgbf)
+    }};
+
+    Phong{Phong::Flag::UniformBuffers, 4, 2, 2}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .setDrawOffset(1)
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderColored() */
+    const Float maxThreshold = 8.34f, meanThreshold = 0.100f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+
+void PhongGLTest::renderClusteredLights() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_integer>())
+        CORRADE_SKIP(GL::Extensions::EXT::texture_integer::string() + std::string(" is not supported"));
+    #endif
+
+    GL::Mesh sphere = MeshTools::compile(Primitives::uvSphereSolid(16, 32));
+
+    /* Same as renderUniformBuffers(), except that the light range in the draw
+       uniform is garbage, as it's ignored, and there's an additional light
+       behind the far plane that should get culled */
+    const Matrix4 projection = Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.1f, 10.0f);
+    GL::Buffer projectionUniform{GL::Buffer::TargetHint::Uniform, {
+        ProjectionUniform3D{}
+            .setProjectionMatrix(projection)
+    }};
+    GL::Buffer transformationUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationUniform3D{}
+            .setTransformationMatrix(Matrix4::translation(Vector3::zAxis(-2.15f)))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongDrawUniform{}
+            .setLightOffsetCount(2, 1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        PhongMaterialUniform{}
+            .setAmbientColor(0x330033_rgbf)
+            .setDiffuseColor(0xccffcc_rgbf)
+            .setSpecularColor(0x6666ff_rgbf)
+    }};
+    const PhongLightUniform lights[]{
+        PhongLightUniform{}
+            .setPosition({-3.0f, -3.0f, 2.0f, 0.0f})
+            .setColor(0x993366_rgbf),
+        PhongLightUniform{}
+            .setPosition({3.0f, -3.0f, 2.0f, 0.0f})
+            .setColor(0x669933_rgbf),
+        PhongLightUniform{}
+            .setPosition({0.0f, 0.0f, -50.0f, 1.0f})
+            .setColor(0xff0000_rgbf)
+            .setRange(1.0f)
+    };
+    GL::Buffer lightUniform{GL::Buffer::TargetHint::Uniform, lights};
+
+    LightClusters clusters{{4, 4, 8}, 1024};
+    clusters.update(projection, lights);
+    CORRADE_COMPARE(clusters.lightIndexCount(), 2*4*4*8);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Phong{Phong::Flag::ClusteredLights, 3, 1, 1}
+        .bindProjectionBuffer(projectionUniform)
+        .bindTransformationBuffer(transformationUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .bindLightBuffer(lightUniform)
+        .setViewportSize(Vector2{_framebuffer.viewport().size()})
+        .setLightClusterDepthRange(clusters.depthRange())
+        .bindLightClusterTexture(clusters.clusterTexture())
+        .bindLightClusterIndexTexture(clusters.lightIndexTexture())
+        .draw(sphere);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    /* Same thresholds as in renderColored() */
+    const Float maxThreshold = 8.34f, meanThreshold = 0.100f;
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "PhongTestFiles/colored.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::PhongGLTest)
@@ -23,20 +23,46 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <new>
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Shaders/Phong.h"
 
 namespace Magnum { namespace Shaders { namespace Test { namespace {
 
+using namespace Math::Literals;
+
 struct PhongTest: TestSuite::Tester {
     explicit PhongTest();
 
     void constructNoCreate();
     void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformConstructNoInit();
+    void drawUniformSetters();
+
+    void materialUniformConstructDefault();
+    void materialUniformConstructNoInit();
+    void materialUniformSetters();
+
+    void lightUniformConstructDefault();
+    void lightUniformConstructNoInit();
+    void lightUniformSetters();
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    void textureHandleUniformConstructDefault();
+    void textureHandleUniformConstructNoInit();
+    void textureHandleUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
     void debugFlagsSupersets();
@@ -46,6 +72,28 @@ PhongTest::PhongTest() {
     addTests({&PhongTest::constructNoCreate,
               &PhongTest::constructCopy,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &PhongTest::uniformSizeAlignment,
+
+              &PhongTest::drawUniformConstructDefault,
+              &PhongTest::drawUniformConstructNoInit,
+              &PhongTest::drawUniformSetters,
+
+              &PhongTest::materialUniformConstructDefault,
+              &PhongTest::materialUniformConstructNoInit,
+              &PhongTest::materialUniformSetters,
+
+              &PhongTest::lightUniformConstructDefault,
+              &PhongTest::lightUniformConstructNoInit,
+              &PhongTest::lightUniformSetters,
+              #endif
+
+              #ifndef MAGNUM_TARGET_GLES
+              &PhongTest::textureHandleUniformConstructDefault,
+              &PhongTest::textureHandleUniformConstructNoInit,
+              &PhongTest::textureHandleUniformSetters,
+              #endif
+
               &PhongTest::debugFlag,
               &PhongTest::debugFlags,
               &PhongTest::debugFlagsSupersets});
@@ -65,6 +113,243 @@ void PhongTest::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<Phong>{});
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void PhongTest::uniformSizeAlignment() {
+    /* std140 requires array elements to be aligned to a vec4 */
+    CORRADE_COMPARE(sizeof(PhongDrawUniform), 80);
+    CORRADE_COMPARE(sizeof(PhongMaterialUniform), 64);
+    CORRADE_COMPARE(sizeof(PhongLightUniform), 48);
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(sizeof(PhongTextureHandleUniform), 32);
+    #endif
+}
+
+void PhongTest::drawUniformConstructDefault() {
+    PhongDrawUniform a;
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 0);
+    CORRADE_COMPARE(a.objectId, 0);
+    CORRADE_COMPARE(a.lightOffset, 0);
+    CORRADE_COMPARE(a.lightCount, 0xffffffffu);
+    CORRADE_COMPARE(a.jointOffset, 0);
+
+    constexpr PhongDrawUniform ca;
+    CORRADE_COMPARE(ca.normalMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f}}));
+    CORRADE_COMPARE(ca.materialId, 0);
+    CORRADE_COMPARE(ca.objectId, 0);
+    CORRADE_COMPARE(ca.lightOffset, 0);
+    CORRADE_COMPARE(ca.lightCount, 0xffffffffu);
+    CORRADE_COMPARE(ca.jointOffset, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongDrawUniform>::value);
+}
+
+void PhongTest::drawUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongDrawUniform a;
+    a.normalMatrix[2] = {1.5f, 0.3f, 3.1f, 0.5f};
+    a.lightCount = 7;
+
+    new(&a) PhongDrawUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.normalMatrix[2], (Vector4{1.5f, 0.3f, 3.1f, 0.5f}));
+        CORRADE_COMPARE(a.lightCount, 7);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongDrawUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongDrawUniform>::value);
+}
+
+void PhongTest::drawUniformSetters() {
+    PhongDrawUniform a;
+    a.setNormalMatrix(Matrix4::rotationX(90.0_degf).normalMatrix())
+     .setMaterialId(5)
+     .setObjectId(7)
+     .setLightOffsetCount(9, 11)
+     .setJointOffset(3);
+    CORRADE_COMPARE(a.normalMatrix, (Matrix3x4{
+        {1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, -1.0f, 0.0f, 0.0f}}));
+    CORRADE_COMPARE(a.materialId, 5);
+    CORRADE_COMPARE(a.objectId, 7);
+    CORRADE_COMPARE(a.lightOffset, 9);
+    CORRADE_COMPARE(a.lightCount, 11);
+    CORRADE_COMPARE(a.jointOffset, 3);
+}
+
+void PhongTest::materialUniformConstructDefault() {
+    PhongMaterialUniform a;
+    CORRADE_COMPARE(a.ambientColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(a.diffuseColor, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.specularColor, (Color4{1.0f, 1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(a.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(a.shininess, 80.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.5f);
+
+    constexpr PhongMaterialUniform ca;
+    CORRADE_COMPARE(ca.ambientColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+    CORRADE_COMPARE(ca.diffuseColor, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.specularColor, (Color4{1.0f, 1.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(ca.normalTextureScale, 1.0f);
+    CORRADE_COMPARE(ca.shininess, 80.0f);
+    CORRADE_COMPARE(ca.alphaMask, 0.5f);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongMaterialUniform a;
+    a.diffuseColor = {0.3f, 0.6f, 0.9f, 1.0f};
+    a.shininess = 15.0f;
+
+    new(&a) PhongMaterialUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.diffuseColor, (Color4{0.3f, 0.6f, 0.9f, 1.0f}));
+        CORRADE_COMPARE(a.shininess, 15.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongMaterialUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongMaterialUniform>::value);
+}
+
+void PhongTest::materialUniformSetters() {
+    PhongMaterialUniform a;
+    a.setAmbientColor({0.1f, 0.2f, 0.3f, 0.4f})
+     .setDiffuseColor({0.5f, 0.6f, 0.7f, 0.8f})
+     .setSpecularColor({0.9f, 1.0f, 1.1f, 1.2f})
+     .setNormalTextureScale(0.5f)
+     .setShininess(15.0f)
+     .setAlphaMask(0.75f);
+    CORRADE_COMPARE(a.ambientColor, (Color4{0.1f, 0.2f, 0.3f, 0.4f}));
+    CORRADE_COMPARE(a.diffuseColor, (Color4{0.5f, 0.6f, 0.7f, 0.8f}));
+    CORRADE_COMPARE(a.specularColor, (Color4{0.9f, 1.0f, 1.1f, 1.2f}));
+    CORRADE_COMPARE(a.normalTextureScale, 0.5f);
+    CORRADE_COMPARE(a.shininess, 15.0f);
+    CORRADE_COMPARE(a.alphaMask, 0.75f);
+}
+
+void PhongTest::lightUniformConstructDefault() {
+    PhongLightUniform a;
+    CORRADE_COMPARE(a.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(a.color, (Color3{1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.specularColor, (Color3{1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.range, Constants::inf());
+
+    constexpr PhongLightUniform ca;
+    CORRADE_COMPARE(ca.position, (Vector4{0.0f, 0.0f, 1.0f, 0.0f}));
+    CORRADE_COMPARE(ca.color, (Color3{1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.specularColor, (Color3{1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.range, Constants::inf());
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformConstructNoInit() {
+    /* Testing only some fields, should be enough */
+    PhongLightUniform a;
+    a.position = {0.3f, 0.6f, 0.9f, 1.0f};
+    a.range = 15.0f;
+
+    new(&a) PhongLightUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.position, (Vector4{0.3f, 0.6f, 0.9f, 1.0f}));
+        CORRADE_COMPARE(a.range, 15.0f);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongLightUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongLightUniform>::value);
+}
+
+void PhongTest::lightUniformSetters() {
+    PhongLightUniform a;
+    a.setPosition({0.1f, 0.2f, 0.3f, 1.0f})
+     .setColor({0.5f, 0.6f, 0.7f})
+     .setSpecularColor({0.9f, 1.0f, 1.1f})
+     .setRange(15.0f);
+    CORRADE_COMPARE(a.position, (Vector4{0.1f, 0.2f, 0.3f, 1.0f}));
+    CORRADE_COMPARE(a.color, (Color3{0.5f, 0.6f, 0.7f}));
+    CORRADE_COMPARE(a.specularColor, (Color3{0.9f, 1.0f, 1.1f}));
+    CORRADE_COMPARE(a.range, 15.0f);
+}
+#endif
+
+#ifndef MAGNUM_TARGET_GLES
+void PhongTest::textureHandleUniformConstructDefault() {
+    PhongTextureHandleUniform a;
+    CORRADE_COMPARE(a.ambientTextureHandle, 0);
+    CORRADE_COMPARE(a.diffuseTextureHandle, 0);
+    CORRADE_COMPARE(a.specularTextureHandle, 0);
+    CORRADE_COMPARE(a.normalTextureHandle, 0);
+
+    constexpr PhongTextureHandleUniform ca;
+    CORRADE_COMPARE(ca.ambientTextureHandle, 0);
+    CORRADE_COMPARE(ca.diffuseTextureHandle, 0);
+    CORRADE_COMPARE(ca.specularTextureHandle, 0);
+    CORRADE_COMPARE(ca.normalTextureHandle, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<PhongTextureHandleUniform>::value);
+}
+
+void PhongTest::textureHandleUniformConstructNoInit() {
+    PhongTextureHandleUniform a;
+    a.ambientTextureHandle = 0x0123456789abcdefull;
+    a.diffuseTextureHandle = 0x1123456789abcdefull;
+    a.specularTextureHandle = 0x2123456789abcdefull;
+    a.normalTextureHandle = 0x3123456789abcdefull;
+
+    new(&a) PhongTextureHandleUniform{NoInit};
+    {
+        #if defined(__GNUC__) && __GNUC__*100 + __GNUC_MINOR__ >= 601 && __OPTIMIZE__
+        CORRADE_EXPECT_FAIL("GCC 6.1+ misoptimizes and overwrites the value.");
+        #endif
+        CORRADE_COMPARE(a.ambientTextureHandle, 0x0123456789abcdefull);
+        CORRADE_COMPARE(a.diffuseTextureHandle, 0x1123456789abcdefull);
+        CORRADE_COMPARE(a.specularTextureHandle, 0x2123456789abcdefull);
+        CORRADE_COMPARE(a.normalTextureHandle, 0x3123456789abcdefull);
+    }
+
+    CORRADE_VERIFY(std::is_nothrow_constructible<PhongTextureHandleUniform, NoInitT>::value);
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!std::is_convertible<NoInitT, PhongTextureHandleUniform>::value);
+}
+
+void PhongTest::textureHandleUniformSetters() {
+    PhongTextureHandleUniform a;
+    a.setAmbientTextureHandle(0x0123456789abcdefull)
+     .setDiffuseTextureHandle(0x1123456789abcdefull)
+     .setSpecularTextureHandle(0x2123456789abcdefull)
+     .setNormalTextureHandle(0x3123456789abcdefull);
+    CORRADE_COMPARE(a.ambientTextureHandle, 0x0123456789abcdefull);
+    CORRADE_COMPARE(a.diffuseTextureHandle, 0x1123456789abcdefull);
+    CORRADE_COMPARE(a.specularTextureHandle, 0x2123456789abcdefull);
+    CORRADE_COMPARE(a.normalTextureHandle, 0x3123456789abcdefull);
+}
+#endif
+
 void PhongTest::debugFlag() {
     std::ostringstream out;
 
@@ -92,9 +377,29 @@ void PhongTest::debugFlagsSupersets() {
 
     /* InstancedTextureOffset is a superset of TextureTransformation so only
        one should be printed */
-    std::ostringstream out;
-    Debug{&out} << (Phong::Flag::InstancedTextureOffset|Phong::Flag::TextureTransformation);
-    CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::InstancedTextureOffset\n");
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::InstancedTextureOffset|Phong::Flag::TextureTransformation);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::InstancedTextureOffset\n");
+    }
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* MultiDraw is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::MultiDraw|Phong::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::MultiDraw\n");
+    }
+
+    /* BindlessTextures is a superset of UniformBuffers so only one should be
+       printed */
+    {
+        std::ostringstream out;
+        Debug{&out} << (Phong::Flag::BindlessTextures|Phong::Flag::UniformBuffers);
+        CORRADE_COMPARE(out.str(), "Shaders::Phong::Flag::BindlessTextures\n");
+    }
+    #endif
 }
 
 }}}}
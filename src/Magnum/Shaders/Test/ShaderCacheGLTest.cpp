@@ -0,0 +1,178 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Shaders/ShaderCache.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct ShaderCacheGLTest: GL::OpenGLTester {
+    explicit ShaderCacheGLTest();
+
+    void construct();
+    void constructMove();
+
+    void add();
+    void addDuplicate();
+    void update();
+    void finish();
+    void getNotAdded();
+};
+
+ShaderCacheGLTest::ShaderCacheGLTest() {
+    addTests({&ShaderCacheGLTest::construct,
+              &ShaderCacheGLTest::constructMove,
+
+              &ShaderCacheGLTest::add,
+              &ShaderCacheGLTest::addDuplicate,
+              &ShaderCacheGLTest::update,
+              &ShaderCacheGLTest::finish,
+              &ShaderCacheGLTest::getNotAdded});
+}
+
+void ShaderCacheGLTest::construct() {
+    ShaderCache cache;
+    CORRADE_COMPARE(cache.count(), 0);
+    CORRADE_COMPARE(cache.pendingCount(), 0);
+    CORRADE_COMPARE(cache.update(), 0);
+}
+
+void ShaderCacheGLTest::constructMove() {
+    ShaderCache a;
+    a.addFlat3D();
+    Flat3D& flat = a.flat3D();
+
+    ShaderCache b{std::move(a)};
+    CORRADE_COMPARE(b.count(), 1);
+    /* The instance is not moved anywhere */
+    CORRADE_COMPARE(&b.flat3D(), &flat);
+
+    ShaderCache c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.count(), 1);
+    CORRADE_COMPARE(&c.flat3D(), &flat);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ShaderCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ShaderCache>::value);
+}
+
+void ShaderCacheGLTest::add() {
+    ShaderCache cache;
+    cache
+        .addPhong({}, 2)
+        .addPhong(Phong::Flag::DiffuseTexture, 2)
+        .addPhong(Phong::Flag::DiffuseTexture, 3)
+        .addFlat2D(Flat2D::Flag::VertexColor)
+        .addFlat3D(Flat3D::Flag::VertexColor);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.count(), 5);
+
+    Phong& phong = cache.phong(Phong::Flag::DiffuseTexture, 3);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(phong.id());
+    CORRADE_COMPARE(phong.flags(), Phong::Flag::DiffuseTexture);
+    CORRADE_COMPARE(phong.lightCount(), 3);
+
+    Flat2D& flat2D = cache.flat2D(Flat2D::Flag::VertexColor);
+    CORRADE_VERIFY(flat2D.id());
+    CORRADE_COMPARE(flat2D.flags(), Flat2D::Flag::VertexColor);
+
+    Flat3D& flat3D = cache.flat3D(Flat3D::Flag::VertexColor);
+    CORRADE_VERIFY(flat3D.id());
+    CORRADE_COMPARE(flat3D.flags(), Flat3D::Flag::VertexColor);
+
+    /* Retrieving again gives the same instance */
+    CORRADE_COMPARE(&cache.phong(Phong::Flag::DiffuseTexture, 3), &phong);
+    CORRADE_COMPARE(cache.count(), 5);
+}
+
+void ShaderCacheGLTest::addDuplicate() {
+    ShaderCache cache;
+    cache
+        .addPhong(Phong::Flag::AlphaMask, 2)
+        .addPhong(Phong::Flag::AlphaMask, 2)
+        .addFlat3D()
+        .addFlat3D();
+    CORRADE_COMPARE(cache.count(), 2);
+
+    /* Adding an already finalized variant doesn't compile it again */
+    Phong& phong = cache.phong(Phong::Flag::AlphaMask, 2);
+    cache.addPhong(Phong::Flag::AlphaMask, 2);
+    CORRADE_COMPARE(cache.count(), 2);
+    CORRADE_COMPARE(&cache.phong(Phong::Flag::AlphaMask, 2), &phong);
+}
+
+void ShaderCacheGLTest::update() {
+    ShaderCache cache;
+    cache
+        .addPhong({}, 1)
+        .addPhong(Phong::Flag::VertexColor, 4)
+        .addFlat3D(Flat3D::Flag::Textured);
+    CORRADE_COMPARE(cache.pendingCount(), 3);
+
+    /* Without KHR_parallel_shader_compile everything is reported as done
+       right away, with it it's done eventually */
+    std::size_t pending;
+    while((pending = cache.update())) {
+        CORRADE_COMPARE(cache.pendingCount(), pending);
+    }
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.pendingCount(), 0);
+    CORRADE_COMPARE(cache.count(), 3);
+    CORRADE_VERIFY(cache.phong(Phong::Flag::VertexColor, 4).id());
+}
+
+void ShaderCacheGLTest::finish() {
+    ShaderCache cache;
+    cache
+        .addPhong({}, 1)
+        .addFlat2D()
+        .addFlat3D();
+    CORRADE_COMPARE(cache.pendingCount(), 3);
+
+    cache.finish();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.pendingCount(), 0);
+    CORRADE_COMPARE(cache.count(), 3);
+    CORRADE_VERIFY(cache.flat2D().id());
+}
+
+void ShaderCacheGLTest::getNotAdded() {
+    ShaderCache cache;
+
+    /* Compiled on the spot */
+    Phong& phong = cache.phong(Phong::Flag::SpecularTexture, 2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(phong.id());
+    CORRADE_COMPARE(phong.flags(), Phong::Flag::SpecularTexture);
+    CORRADE_COMPARE(cache.count(), 1);
+    CORRADE_COMPARE(cache.pendingCount(), 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::ShaderCacheGLTest)
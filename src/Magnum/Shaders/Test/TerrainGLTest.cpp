@@ -0,0 +1,295 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Renderbuffer.h"
+#include "Magnum/GL/RenderbufferFormat.h"
+#include "Magnum/GL/Renderer.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/MeshTools/Compile.h"
+#include "Magnum/Primitives/Grid.h"
+#include "Magnum/Shaders/Terrain.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct TerrainGLTest: GL::OpenGLTester {
+    explicit TerrainGLTest();
+
+    void construct();
+    void constructMove();
+
+    void setCellCountInvalid();
+    void bindColorTextureNotEnabled();
+
+    void renderSetup();
+    void renderTeardown();
+
+    void renderHeight();
+    void renderPatches();
+
+    private:
+        GL::Renderbuffer _color{NoCreate};
+        GL::Renderbuffer _depth{NoCreate};
+        GL::Framebuffer _framebuffer{NoCreate};
+};
+
+using namespace Math::Literals;
+
+constexpr struct {
+    const char* name;
+    Terrain::Flags flags;
+} ConstructData[]{
+    {"", {}},
+    {"color texture", Terrain::Flag::ColorTexture}
+};
+
+constexpr struct {
+    const char* name;
+    Float height;
+    bool visible;
+} RenderHeightData[]{
+    {"below the near plane", 0.0f, false},
+    {"displaced above it", 0.5f, true}
+};
+
+TerrainGLTest::TerrainGLTest() {
+    addInstancedTests({&TerrainGLTest::construct},
+        Containers::arraySize(ConstructData));
+
+    addTests({&TerrainGLTest::constructMove,
+
+              &TerrainGLTest::setCellCountInvalid,
+              &TerrainGLTest::bindColorTextureNotEnabled});
+
+    addInstancedTests({&TerrainGLTest::renderHeight},
+        Containers::arraySize(RenderHeightData),
+        &TerrainGLTest::renderSetup,
+        &TerrainGLTest::renderTeardown);
+
+    addTests({&TerrainGLTest::renderPatches},
+        &TerrainGLTest::renderSetup,
+        &TerrainGLTest::renderTeardown);
+}
+
+void TerrainGLTest::construct() {
+    auto&& data = ConstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Terrain shader{data.flags};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+
+void TerrainGLTest::constructMove() {
+    Terrain a{Terrain::Flag::ColorTexture};
+    const GLuint id = a.id();
+    CORRADE_VERIFY(id);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Terrain b{std::move(a)};
+    CORRADE_COMPARE(b.id(), id);
+    CORRADE_COMPARE(b.flags(), Terrain::Flag::ColorTexture);
+    CORRADE_VERIFY(!a.id());
+
+    Terrain c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.id(), id);
+    CORRADE_COMPARE(c.flags(), Terrain::Flag::ColorTexture);
+    CORRADE_VERIFY(!b.id());
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Terrain>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Terrain>::value);
+}
+
+void TerrainGLTest::setCellCountInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Terrain shader;
+
+    /* Same, larger or a divisor is fine */
+    shader.setCellCount(8, {8, 16, 4, 1});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.setCellCount(0)
+        .setCellCount(8, {8, 3, 8, 8})
+        .setCellCount(8, {8, 8, 0, 8});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Terrain::setCellCount(): expected non-zero cell count\n"
+        "Shaders::Terrain::setCellCount(): neighbor cell count 3 is not a divisor of 8\n"
+        "Shaders::Terrain::setCellCount(): neighbor cell count 0 is not a divisor of 8\n");
+}
+
+void TerrainGLTest::bindColorTextureNotEnabled() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Terrain shader;
+    GL::Texture2D texture;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    shader.bindColorTexture(texture);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Terrain::bindColorTexture(): the shader was not created with color texture enabled\n");
+}
+
+constexpr Vector2i RenderSize{16, 16};
+
+void TerrainGLTest::renderSetup() {
+    GL::Renderer::setClearColor(0x111111_rgbf);
+    GL::Renderer::enable(GL::Renderer::Feature::DepthTest);
+
+    _color = GL::Renderbuffer{};
+    _color.setStorage(GL::RenderbufferFormat::RGBA8, RenderSize);
+    _depth = GL::Renderbuffer{};
+    _depth.setStorage(GL::RenderbufferFormat::DepthComponent16, RenderSize);
+    _framebuffer = GL::Framebuffer{{{}, RenderSize}};
+    _framebuffer
+        .attachRenderbuffer(GL::Framebuffer::ColorAttachment{0}, _color)
+        .attachRenderbuffer(GL::Framebuffer::BufferAttachment::Depth, _depth)
+        .clear(GL::FramebufferClear::Color|GL::FramebufferClear::Depth)
+        .bind();
+}
+
+void TerrainGLTest::renderTeardown() {
+    _framebuffer = GL::Framebuffer{NoCreate};
+    _color = GL::Renderbuffer{NoCreate};
+    _depth = GL::Renderbuffer{NoCreate};
+
+    GL::Renderer::disable(GL::Renderer::Feature::DepthTest);
+}
+
+/* A constant single-channel height texture */
+GL::Texture2D heightTexture(const Float height) {
+    const Float heights[]{height, height, height, height};
+    GL::Texture2D texture;
+    texture.setMinificationFilter(SamplerFilter::Nearest)
+        .setMagnificationFilter(SamplerFilter::Nearest)
+        .setWrapping(SamplerWrapping::ClampToEdge)
+        .setStorage(1, GL::TextureFormat::R32F, Vector2i{2})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::R32F, Vector2i{2}, heights});
+    return texture;
+}
+
+void TerrainGLTest::renderHeight() {
+    auto&& data = RenderHeightData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    CORRADE_COMPARE(_framebuffer.checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+
+    GL::Mesh mesh = MeshTools::compile(Primitives::grid3DProcedural(4));
+    GL::Texture2D heights = heightTexture(data.height);
+
+    /* Looking down at the terrain with only Z from 0.25 to 1 visible, so the
+       terrain gets drawn only if it got displaced by the height texture */
+    Terrain shader;
+    shader.setTransformationProjectionMatrix(
+            Matrix4::orthographicProjection({2.0f, 2.0f}, 0.0f, 0.75f)*
+            Matrix4::translation(Vector3::zAxis(-1.0f)))
+        .setCellCount(4)
+        .setColor(0xffffff_rgbf)
+        .bindHeightTexture(heights)
+        .draw(mesh);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({RenderSize/2, RenderSize/2 + Vector2i{1}}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(image.pixels<Color4ub>()[0][0].rgb(),
+        data.visible ? 0xffffff_rgb : 0x111111_rgb);
+}
+
+void TerrainGLTest::renderPatches() {
+    CORRADE_COMPARE(_framebuffer.checkStatus(GL::FramebufferTarget::Draw), GL::Framebuffer::Status::Complete);
+
+    /* The mesh is created for the finest level, coarser levels draw only a
+       prefix of it */
+    GL::Mesh mesh = MeshTools::compile(Primitives::grid3DProcedural(8));
+    GL::Texture2D heights = heightTexture(0.0f);
+
+    Terrain shader;
+    shader.setColor(0xffffff_rgbf)
+        .bindHeightTexture(heights);
+
+    /* Four patches with different levels of detail, each stitched to its
+       coarser neighbors. Together they should cover the whole viewport. */
+    const struct {
+        Range2D patch;
+        UnsignedInt cellCount;
+        Vector4ui neighborCellCounts;
+    } patches[]{
+        {{{-1.0f, -1.0f}, {0.0f, 0.0f}}, 8, {8, 4, 8, 2}},
+        {{{ 0.0f, -1.0f}, {1.0f, 0.0f}}, 4, {8, 4, 4, 1}},
+        {{{-1.0f,  0.0f}, {0.0f, 1.0f}}, 2, {2, 1, 8, 2}},
+        {{{ 0.0f,  0.0f}, {1.0f, 1.0f}}, 1, {2, 1, 4, 1}}
+    };
+    for(const auto& patch: patches) {
+        mesh.setCount(Terrain::vertexCount(patch.cellCount));
+        shader.setPatch(patch.patch)
+            .setCellCount(patch.cellCount, patch.neighborCellCounts)
+            .draw(mesh);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    Image2D image = _framebuffer.read({{}, RenderSize}, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    for(const auto row: image.pixels<Color4ub>())
+        for(const Color4ub& pixel: row)
+            CORRADE_COMPARE(pixel.rgb(), 0xffffff_rgb);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::TerrainGLTest)
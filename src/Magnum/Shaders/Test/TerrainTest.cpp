@@ -0,0 +1,94 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Shaders/Terrain.h"
+
+namespace Magnum { namespace Shaders { namespace Test { namespace {
+
+struct TerrainTest: TestSuite::Tester {
+    explicit TerrainTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void vertexCount();
+
+    void debugFlag();
+    void debugFlags();
+};
+
+TerrainTest::TerrainTest() {
+    addTests({&TerrainTest::constructNoCreate,
+              &TerrainTest::constructCopy,
+
+              &TerrainTest::vertexCount,
+
+              &TerrainTest::debugFlag,
+              &TerrainTest::debugFlags});
+}
+
+void TerrainTest::constructNoCreate() {
+    {
+        Terrain shader{NoCreate};
+        CORRADE_COMPARE(shader.id(), 0);
+        CORRADE_COMPARE(shader.flags(), Terrain::Flags{});
+    }
+
+    CORRADE_VERIFY(true);
+}
+
+void TerrainTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Terrain>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Terrain>{});
+}
+
+void TerrainTest::vertexCount() {
+    constexpr UnsignedInt count = Terrain::vertexCount(16);
+    CORRADE_COMPARE(count, 1536);
+    CORRADE_COMPARE(Terrain::vertexCount(1), 6);
+}
+
+void TerrainTest::debugFlag() {
+    std::ostringstream out;
+
+    Debug{&out} << Terrain::Flag::ColorTexture << Terrain::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::Terrain::Flag::ColorTexture Shaders::Terrain::Flag(0xf0)\n");
+}
+
+void TerrainTest::debugFlags() {
+    std::ostringstream out;
+
+    Debug{&out} << Terrain::Flags{Terrain::Flag::ColorTexture|Terrain::Flag(0xf0)} << Terrain::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::Terrain::Flag::ColorTexture|Shaders::Terrain::Flag(0xf0) Shaders::Terrain::Flags{}\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Shaders::Test::TerrainTest)
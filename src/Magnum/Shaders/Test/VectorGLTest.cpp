@@ -34,6 +34,11 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/DebugTools/CompareImage.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#endif
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/GL/OpenGLTester.h"
@@ -60,9 +65,23 @@ struct VectorGLTest: GL::OpenGLTester {
     explicit VectorGLTest();
 
     template<UnsignedInt dimensions> void construct();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffers();
+    #endif
     template<UnsignedInt dimensions> void constructMove();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroMaterials();
+    template<UnsignedInt dimensions> void constructUniformBuffersZeroDraws();
+    #endif
+
     template<UnsignedInt dimensions> void setTextureMatrixNotEnabled();
+    #ifndef MAGNUM_TARGET_GLES2
+    template<UnsignedInt dimensions> void setUniformUniformBuffersEnabled();
+    template<UnsignedInt dimensions> void bindBufferUniformBuffersNotEnabled();
+    template<UnsignedInt dimensions> void bindTextureTransformationBufferNotEnabled();
+    template<UnsignedInt dimensions> void setWrongDrawOffset();
+    #endif
 
     void renderSetup();
     void renderTeardown();
@@ -72,6 +91,10 @@ struct VectorGLTest: GL::OpenGLTester {
     void render2D();
     void render3D();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void renderUniformBuffers2D();
+    #endif
+
     private:
         PluginManager::Manager<Trade::AbstractImporter> _manager{"nonexistent"};
         std::string _testDir;
@@ -105,6 +128,19 @@ constexpr struct {
     {"texture transformation", Vector2D::Flag::TextureTransformation}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+constexpr struct {
+    const char* name;
+    Vector2D::Flags flags;
+    UnsignedInt materialCount, drawCount;
+} ConstructUniformBuffersData[]{
+    {"", Vector2D::Flag::UniformBuffers, 1, 1},
+    {"texture transformation", Vector2D::Flag::UniformBuffers|Vector2D::Flag::TextureTransformation, 1, 1},
+    {"multiple materials, draws", Vector2D::Flag::UniformBuffers, 8, 48},
+    {"vertex draw ID", Vector2D::Flag::VertexDrawId, 8, 48}
+};
+#endif
+
 const struct {
     const char* name;
     Vector2D::Flags flags;
@@ -122,18 +158,55 @@ const struct {
         "vector2D.tga", "vector3D.tga", false}
 };
 
+#ifndef MAGNUM_TARGET_GLES2
+const struct {
+    const char* name;
+    Vector2D::Flags flags;
+    UnsignedInt drawOffset;
+    bool vertexDrawId;
+} RenderUniformBuffersData[] {
+    {"", Vector2D::Flag::UniformBuffers, 1, false},
+    {"vertex draw ID", Vector2D::Flag::VertexDrawId, 0, true}
+};
+#endif
+
 VectorGLTest::VectorGLTest() {
     addInstancedTests<VectorGLTest>({
         &VectorGLTest::construct<2>,
         &VectorGLTest::construct<3>},
         Containers::arraySize(ConstructData));
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests<VectorGLTest>({
+        &VectorGLTest::constructUniformBuffers<2>,
+        &VectorGLTest::constructUniformBuffers<3>},
+        Containers::arraySize(ConstructUniformBuffersData));
+    #endif
+
     addTests<VectorGLTest>({
         &VectorGLTest::constructMove<2>,
         &VectorGLTest::constructMove<3>,
 
+        #ifndef MAGNUM_TARGET_GLES2
+        &VectorGLTest::constructUniformBuffersZeroMaterials<2>,
+        &VectorGLTest::constructUniformBuffersZeroMaterials<3>,
+        &VectorGLTest::constructUniformBuffersZeroDraws<2>,
+        &VectorGLTest::constructUniformBuffersZeroDraws<3>,
+        #endif
+
         &VectorGLTest::setTextureMatrixNotEnabled<2>,
-        &VectorGLTest::setTextureMatrixNotEnabled<3>});
+        &VectorGLTest::setTextureMatrixNotEnabled<3>,
+        #ifndef MAGNUM_TARGET_GLES2
+        &VectorGLTest::setUniformUniformBuffersEnabled<2>,
+        &VectorGLTest::setUniformUniformBuffersEnabled<3>,
+        &VectorGLTest::bindBufferUniformBuffersNotEnabled<2>,
+        &VectorGLTest::bindBufferUniformBuffersNotEnabled<3>,
+        &VectorGLTest::bindTextureTransformationBufferNotEnabled<2>,
+        &VectorGLTest::bindTextureTransformationBufferNotEnabled<3>,
+        &VectorGLTest::setWrongDrawOffset<2>,
+        &VectorGLTest::setWrongDrawOffset<3>,
+        #endif
+        });
 
     addTests({&VectorGLTest::renderDefaults2D,
               &VectorGLTest::renderDefaults3D},
@@ -146,6 +219,13 @@ VectorGLTest::VectorGLTest() {
         &VectorGLTest::renderSetup,
         &VectorGLTest::renderTeardown);
 
+    #ifndef MAGNUM_TARGET_GLES2
+    addInstancedTests({&VectorGLTest::renderUniformBuffers2D},
+        Containers::arraySize(RenderUniformBuffersData),
+        &VectorGLTest::renderSetup,
+        &VectorGLTest::renderTeardown);
+    #endif
+
     /* Load the plugins directly from the build tree. Otherwise they're either
        static and already loaded or not present in the build tree */
     #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
@@ -189,6 +269,36 @@ template<UnsignedInt dimensions> void VectorGLTest::construct() {
     MAGNUM_VERIFY_NO_GL_ERROR();
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void VectorGLTest::constructUniformBuffers() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    auto&& data = ConstructUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.flags >= Vector2D::Flag::VertexDrawId && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    Vector<dimensions> shader{data.flags, data.materialCount, data.drawCount};
+    CORRADE_COMPARE(shader.flags(), data.flags);
+    CORRADE_COMPARE(shader.materialCount(), data.materialCount);
+    CORRADE_COMPARE(shader.drawCount(), data.drawCount);
+    CORRADE_VERIFY(shader.id());
+    {
+        #ifdef CORRADE_TARGET_APPLE
+        CORRADE_EXPECT_FAIL("macOS drivers need insane amount of state to validate properly.");
+        #endif
+        CORRADE_VERIFY(shader.validate().first);
+    }
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+}
+#endif
+
 template<UnsignedInt dimensions> void VectorGLTest::constructMove() {
     setTestCaseTemplateName(std::to_string(dimensions));
 
@@ -227,6 +337,140 @@ template<UnsignedInt dimensions> void VectorGLTest::setTextureMatrixNotEnabled()
         "Shaders::Vector::setTextureMatrix(): the shader was not created with texture transformation enabled\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> void VectorGLTest::constructUniformBuffersZeroMaterials() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector<dimensions>{Vector<dimensions>::Flag::UniformBuffers, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector: material count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void VectorGLTest::constructUniformBuffersZeroDraws() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector<dimensions>{Vector<dimensions>::Flag::UniformBuffers, 1, 0};
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector: draw count can't be zero\n");
+}
+
+template<UnsignedInt dimensions> void VectorGLTest::setUniformUniformBuffersEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    Vector<dimensions> shader{Vector<dimensions>::Flag::UniformBuffers};
+    shader.setTransformationProjectionMatrix({})
+        .setTextureMatrix({})
+        .setBackgroundColor({})
+        .setColor({});
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Vector::setTextureMatrix(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Vector::setBackgroundColor(): the shader was created with uniform buffers enabled\n"
+        "Shaders::Vector::setColor(): the shader was created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void VectorGLTest::bindBufferUniformBuffersNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer;
+    Vector<dimensions> shader;
+    shader.bindTransformationProjectionBuffer(buffer)
+        .bindTransformationProjectionBuffer(buffer, 0, 16)
+        .bindDrawBuffer(buffer)
+        .bindDrawBuffer(buffer, 0, 16)
+        .bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16)
+        .bindMaterialBuffer(buffer)
+        .bindMaterialBuffer(buffer, 0, 16)
+        .setDrawOffset(0);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindDrawBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled\n"
+        "Shaders::Vector::setDrawOffset(): the shader was not created with uniform buffers enabled\n");
+}
+
+template<UnsignedInt dimensions> void VectorGLTest::bindTextureTransformationBufferNotEnabled() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    GL::Buffer buffer{GL::Buffer::TargetHint::Uniform};
+    Vector<dimensions> shader{Vector<dimensions>::Flag::UniformBuffers};
+    shader.bindTextureTransformationBuffer(buffer)
+        .bindTextureTransformationBuffer(buffer, 0, 16);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n"
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled\n");
+}
+
+template<UnsignedInt dimensions> void VectorGLTest::setWrongDrawOffset() {
+    setTestCaseTemplateName(std::to_string(dimensions));
+
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    Vector<dimensions>{Vector<dimensions>::Flag::UniformBuffers, 2, 5}
+        .setDrawOffset(5);
+    CORRADE_COMPARE(out.str(),
+        "Shaders::Vector::setDrawOffset(): draw offset 5 is out of bounds for 5 draws\n");
+}
+#endif
+
 constexpr Vector2i RenderSize{80, 80};
 
 void VectorGLTest::renderSetup() {
@@ -482,6 +726,90 @@ void VectorGLTest::render3D() {
         (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void VectorGLTest::renderUniformBuffers2D() {
+    auto&& data = RenderUniformBuffersData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(data.vertexDrawId && !GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    if(!(_manager.loadState("AnyImageImporter") & PluginManager::LoadState::Loaded) ||
+       !(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("AnyImageImporter / TgaImporter plugins not found.");
+
+    GL::Mesh square = MeshTools::compile(Primitives::squareSolid(Primitives::SquareFlag::TextureCoordinates));
+
+    /* With a per-vertex draw ID, all four vertices pick the second item */
+    if(data.vertexDrawId) {
+        const UnsignedInt drawIds[]{1, 1, 1, 1};
+        square.addVertexBuffer(GL::Buffer{drawIds}, 0, Vector2D::DrawId{});
+    }
+
+    Containers::Pointer<Trade::AbstractImporter> importer = _manager.loadAndInstantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer);
+
+    GL::Texture2D texture;
+    Containers::Optional<Trade::ImageData2D> image;
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "TestFiles/vector.tga")) && (image = importer->image2D(0)));
+    texture.setMinificationFilter(GL::SamplerFilter::Linear)
+        .setMagnificationFilter(GL::SamplerFilter::Linear)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(1, TextureFormatR, image->size())
+        .setSubImage(0, {}, *image);
+
+    /* Verify that the draw offset / draw ID and material ID get used by
+       putting the actual data at the second item */
+    GL::Buffer transformationProjectionUniform{GL::Buffer::TargetHint::Uniform, {
+        TransformationProjectionUniform2D{},
+        TransformationProjectionUniform2D{}
+            .setTransformationProjectionMatrix(
+                Matrix3::projection({2.1f, 2.1f})*
+                Matrix3::rotation(5.0_degf))
+    }};
+    GL::Buffer drawUniform{GL::Buffer::TargetHint::Uniform, {
+        VectorDrawUniform{},
+        VectorDrawUniform{}
+            .setMaterialId(1)
+    }};
+    GL::Buffer materialUniform{GL::Buffer::TargetHint::Uniform, {
+        VectorMaterialUniform{}
+            .setColor(0xff0000_rgbf),
+        VectorMaterialUniform{}
+            .setColor(0xffff99_rgbf)
+            .setBackgroundColor(0x9999ff_rgbf)
+    }};
+
+    Vector2D{data.flags, 2, 2}
+        .bindTransformationProjectionBuffer(transformationProjectionUniform)
+        .bindDrawBuffer(drawUniform)
+        .bindMaterialBuffer(materialUniform)
+        .setDrawOffset(data.drawOffset)
+        .bindVectorTexture(texture)
+        .draw(square);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Should be the same as render2D() with no texture transformation */
+    #if !(defined(MAGNUM_TARGET_GLES2) && defined(MAGNUM_TARGET_WEBGL))
+    /* SwiftShader has differently rasterized edges on four pixels */
+    const Float maxThreshold = 170.0f, meanThreshold = 0.146f;
+    #else
+    /* WebGL 1 doesn't have 8bit renderbuffer storage, so it's way worse */
+    const Float maxThreshold = 170.0f, meanThreshold = 0.962f;
+    #endif
+    CORRADE_COMPARE_WITH(
+        /* Dropping the alpha channel, as it's always 1.0 */
+        Containers::arrayCast<Color3ub>(_framebuffer.read(_framebuffer.viewport(), {PixelFormat::RGBA8Unorm}).pixels<Color4ub>()),
+        Utility::Directory::join(_testDir, "VectorTestFiles/vector2D.tga"),
+        (DebugTools::CompareImageToFile{_manager, maxThreshold, meanThreshold}));
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VectorGLTest)
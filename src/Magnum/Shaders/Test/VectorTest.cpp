@@ -37,8 +37,21 @@ struct VectorTest: TestSuite::Tester {
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
 
+    #ifndef MAGNUM_TARGET_GLES2
+    void uniformSizeAlignment();
+
+    void drawUniformConstructDefault();
+    void drawUniformSetters();
+
+    void materialUniformConstructDefault();
+    void materialUniformSetters();
+    #endif
+
     void debugFlag();
     void debugFlags();
+    #ifndef MAGNUM_TARGET_GLES2
+    void debugFlagsSupersets();
+    #endif
 };
 
 VectorTest::VectorTest() {
@@ -48,8 +61,22 @@ VectorTest::VectorTest() {
               &VectorTest::constructCopy<2>,
               &VectorTest::constructCopy<3>,
 
+              #ifndef MAGNUM_TARGET_GLES2
+              &VectorTest::uniformSizeAlignment,
+
+              &VectorTest::drawUniformConstructDefault,
+              &VectorTest::drawUniformSetters,
+
+              &VectorTest::materialUniformConstructDefault,
+              &VectorTest::materialUniformSetters,
+              #endif
+
               &VectorTest::debugFlag,
-              &VectorTest::debugFlags});
+              &VectorTest::debugFlags,
+              #ifndef MAGNUM_TARGET_GLES2
+              &VectorTest::debugFlagsSupersets
+              #endif
+              });
 }
 
 template<UnsignedInt dimensions> void VectorTest::constructNoCreate() {
@@ -70,6 +97,50 @@ template<UnsignedInt dimensions> void VectorTest::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<Vector<dimensions>>{});
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void VectorTest::uniformSizeAlignment() {
+    /* std140 requires array elements to be aligned to a vec4 */
+    CORRADE_COMPARE(sizeof(VectorDrawUniform), 16);
+    CORRADE_COMPARE(sizeof(VectorMaterialUniform), 32);
+}
+
+void VectorTest::drawUniformConstructDefault() {
+    VectorDrawUniform a;
+    CORRADE_COMPARE(a.materialId, 0);
+
+    constexpr VectorDrawUniform ca;
+    CORRADE_COMPARE(ca.materialId, 0);
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<VectorDrawUniform>::value);
+}
+
+void VectorTest::drawUniformSetters() {
+    VectorDrawUniform a;
+    a.setMaterialId(5);
+    CORRADE_COMPARE(a.materialId, 5);
+}
+
+void VectorTest::materialUniformConstructDefault() {
+    VectorMaterialUniform a;
+    CORRADE_COMPARE(a.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(a.backgroundColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+
+    constexpr VectorMaterialUniform ca;
+    CORRADE_COMPARE(ca.color, (Color4{1.0f, 1.0f, 1.0f, 1.0f}));
+    CORRADE_COMPARE(ca.backgroundColor, (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+
+    CORRADE_VERIFY(std::is_nothrow_default_constructible<VectorMaterialUniform>::value);
+}
+
+void VectorTest::materialUniformSetters() {
+    VectorMaterialUniform a;
+    a.setColor({0.3f, 0.6f, 0.9f, 0.5f})
+     .setBackgroundColor({0.1f, 0.2f, 0.3f, 0.4f});
+    CORRADE_COMPARE(a.color, (Color4{0.3f, 0.6f, 0.9f, 0.5f}));
+    CORRADE_COMPARE(a.backgroundColor, (Color4{0.1f, 0.2f, 0.3f, 0.4f}));
+}
+#endif
+
 void VectorTest::debugFlag() {
     std::ostringstream out;
 
@@ -84,6 +155,16 @@ void VectorTest::debugFlags() {
     CORRADE_COMPARE(out.str(), "Shaders::Vector::Flag::TextureTransformation|Shaders::Vector::Flag(0xf0) Shaders::Vector::Flags{}\n");
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void VectorTest::debugFlagsSupersets() {
+    /* VertexDrawId is a superset of UniformBuffers so only one should be
+       printed */
+    std::ostringstream out;
+    Debug{&out} << (Vector2D::Flag::UniformBuffers|Vector2D::Flag::VertexDrawId);
+    CORRADE_COMPARE(out.str(), "Shaders::Vector::Flag::VertexDrawId\n");
+}
+#endif
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VectorTest)
@@ -23,7 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Shaders/VertexColor.h"
 
@@ -34,6 +36,9 @@ struct VertexColorTest: TestSuite::Tester {
 
     template<UnsignedInt dimensions> void constructNoCreate();
     template<UnsignedInt dimensions> void constructCopy();
+
+    void debugFlag();
+    void debugFlags();
 };
 
 VertexColorTest::VertexColorTest() {
@@ -42,7 +47,10 @@ VertexColorTest::VertexColorTest() {
         &VertexColorTest::constructNoCreate<3>,
 
         &VertexColorTest::constructCopy<2>,
-        &VertexColorTest::constructCopy<3>});
+        &VertexColorTest::constructCopy<3>,
+
+        &VertexColorTest::debugFlag,
+        &VertexColorTest::debugFlags});
 }
 
 template<UnsignedInt dimensions> void VertexColorTest::constructNoCreate() {
@@ -63,6 +71,30 @@ template<UnsignedInt dimensions> void VertexColorTest::constructCopy() {
     CORRADE_VERIFY(!std::is_copy_assignable<VertexColor<dimensions>>{});
 }
 
+void VertexColorTest::debugFlag() {
+    std::ostringstream out;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    Debug{&out} << VertexColor3D::Flag::Multiview << VertexColor3D::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::VertexColor::Flag::Multiview Shaders::VertexColor::Flag(0xf0)\n");
+    #else
+    Debug{&out} << VertexColor3D::Flag(0xf0);
+    CORRADE_COMPARE(out.str(), "Shaders::VertexColor::Flag(0xf0)\n");
+    #endif
+}
+
+void VertexColorTest::debugFlags() {
+    std::ostringstream out;
+
+    #ifndef MAGNUM_TARGET_GLES2
+    Debug{&out} << (VertexColor3D::Flag::Multiview|VertexColor3D::Flag(0xf0)) << VertexColor3D::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::VertexColor::Flag::Multiview|Shaders::VertexColor::Flag(0xf0) Shaders::VertexColor::Flags{}\n");
+    #else
+    Debug{&out} << VertexColor3D::Flags{};
+    CORRADE_COMPARE(out.str(), "Shaders::VertexColor::Flags{}\n");
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Shaders::Test::VertexColorTest)
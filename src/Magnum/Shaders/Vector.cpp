@@ -27,11 +27,18 @@
 
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/Buffer.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -40,7 +47,43 @@
 
 namespace Magnum { namespace Shaders {
 
-template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): _flags{flags} {
+#ifndef MAGNUM_TARGET_GLES2
+namespace {
+    enum: Int {
+        /* Not using the zero binding to avoid conflicts with
+           ProjectionBufferBinding from other shaders which can likely stay
+           bound to the same buffer for the whole time. Matching bindings of
+           Flat to make it possible to share the buffers. */
+        TransformationProjectionBufferBinding = 1,
+        DrawBufferBinding = 2,
+        TextureTransformationBufferBinding = 3,
+        MaterialBufferBinding = 4
+    };
+}
+#endif
+
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags
+    #ifndef MAGNUM_TARGET_GLES2
+    , const UnsignedInt materialCount, const UnsignedInt drawCount
+    #endif
+):
+    _flags{flags}
+    #ifndef MAGNUM_TARGET_GLES2
+    , _materialCount{materialCount}, _drawCount{drawCount}
+    #endif
+{
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || materialCount,
+        "Shaders::Vector: material count can't be zero", );
+    CORRADE_ASSERT(!(flags >= Flag::UniformBuffers) || drawCount,
+        "Shaders::Vector: draw count can't be zero", );
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(flags >= Flag::UniformBuffers)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::uniform_buffer_object);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -58,38 +101,81 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags):
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
     vert.addSource(flags & Flag::TextureTransformation ? "#define TEXTURE_TRANSFORMATION\n" : "")
-        .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n")
-        .addSource(rs.get("generic.glsl"))
+        .addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n");
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        vert.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n",
+            drawCount));
+        vert.addSource(flags >= Flag::VertexDrawId ? "#define VERTEX_DRAW_ID\n" : "");
+    }
+    #endif
+    vert.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("AbstractVector.vert"));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        frag.addSource(Utility::formatString(
+            "#define UNIFORM_BUFFERS\n"
+            "#define DRAW_COUNT {}\n"
+            "#define MATERIAL_COUNT {}\n",
+            drawCount,
+            materialCount));
+        frag.addSource(flags >= Flag::VertexDrawId ? "#define VERTEX_DRAW_ID\n" : "");
+    }
+    #endif
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("Vector.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    GL::AbstractShaderProgram::attachShaders({vert,  frag});
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(!cache || !cache->load(*this, cacheKey))
     #endif
     {
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
-        GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        GL::AbstractShaderProgram::attachShaders({vert,  frag});
+
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::Position::Location, "position");
+            GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::TextureCoordinates::Location, "textureCoordinates");
+            #ifndef MAGNUM_TARGET_GLES2
+            if(flags >= Flag::VertexDrawId)
+                GL::AbstractShaderProgram::bindAttributeLocation(AbstractVector<dimensions>::DrawId::Location, "vertexDrawId");
+            #endif
+        }
+        #endif
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
     }
-    #endif
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::AbstractShaderProgram::link());
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = GL::AbstractShaderProgram::uniformLocation("transformationProjectionMatrix");
-        if(flags & Flag::TextureTransformation)
-            _textureMatrixUniform = GL::AbstractShaderProgram::uniformLocation("textureMatrix");
-        _backgroundColorUniform = GL::AbstractShaderProgram::uniformLocation("backgroundColor");
-        _colorUniform = GL::AbstractShaderProgram::uniformLocation("color");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            _drawOffsetUniform = GL::AbstractShaderProgram::uniformLocation("drawOffset");
+        } else
+        #endif
+        {
+            _transformationProjectionMatrixUniform = GL::AbstractShaderProgram::uniformLocation("transformationProjectionMatrix");
+            if(flags & Flag::TextureTransformation)
+                _textureMatrixUniform = GL::AbstractShaderProgram::uniformLocation("textureMatrix");
+            _backgroundColorUniform = GL::AbstractShaderProgram::uniformLocation("backgroundColor");
+            _colorUniform = GL::AbstractShaderProgram::uniformLocation("color");
+        }
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -97,23 +183,51 @@ template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags):
     #endif
     {
         GL::AbstractShaderProgram::setUniform(GL::AbstractShaderProgram::uniformLocation("vectorTexture"), AbstractVector<dimensions>::VectorTextureUnit);
+        #ifndef MAGNUM_TARGET_GLES2
+        if(flags >= Flag::UniformBuffers) {
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("TransformationProjection"), TransformationProjectionBufferBinding);
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("Draw"), DrawBufferBinding);
+            if(flags & Flag::TextureTransformation)
+                GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("TextureTransformation"), TextureTransformationBufferBinding);
+            GL::AbstractShaderProgram::setUniformBlockBinding(GL::AbstractShaderProgram::uniformBlockIndex("Material"), MaterialBufferBinding);
+        }
+        #endif
     }
 
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
-    if(flags & Flag::TextureTransformation)
-        setTextureMatrix(Matrix3{Math::IdentityInit});
-    setColor(Color4{1.0f}); /* Background color is zero by default */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags >= Flag::UniformBuffers) {
+        /* Draw offset is zero by default */
+    } else
+    #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+        if(flags & Flag::TextureTransformation)
+            setTextureMatrix(Matrix3{Math::IdentityInit});
+        setColor(Color4{1.0f}); /* Background color is zero by default */
+    }
     #endif
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Vector<dimensions>::Vector(const Flags flags): Vector{flags, 1, 1} {}
+#endif
+
 template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Vector::setTransformationProjectionMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
 
 template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setTextureMatrix(const Matrix3& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Vector::setTextureMatrix(): the shader was created with uniform buffers enabled", *this);
+    #endif
     CORRADE_ASSERT(_flags & Flag::TextureTransformation,
         "Shaders::Vector::setTextureMatrix(): the shader was not created with texture transformation enabled", *this);
     GL::AbstractShaderProgram::setUniform(_textureMatrixUniform, matrix);
@@ -121,15 +235,94 @@ template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setText
 }
 
 template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setBackgroundColor(const Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Vector::setBackgroundColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_backgroundColorUniform, color);
     return *this;
 }
 
 template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setColor(const Color4& color) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags >= Flag::UniformBuffers),
+        "Shaders::Vector::setColor(): the shader was created with uniform buffers enabled", *this);
+    #endif
     GL::AbstractShaderProgram::setUniform(_colorUniform, color);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::setDrawOffset(const UnsignedInt offset) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::setDrawOffset(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(offset < _drawCount,
+        "Shaders::Vector::setDrawOffset(): draw offset" << offset << "is out of bounds for" << _drawCount << "draws", *this);
+    GL::AbstractShaderProgram::setUniform(_drawOffsetUniform, offset);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindTransformationProjectionBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindTransformationProjectionBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TransformationProjectionBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindDrawBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindDrawBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindDrawBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, DrawBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindTextureTransformationBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with uniform buffers enabled", *this);
+    CORRADE_ASSERT(_flags & Flag::TextureTransformation,
+        "Shaders::Vector::bindTextureTransformationBuffer(): the shader was not created with texture transformation enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, TextureTransformationBufferBinding, offset, size);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindMaterialBuffer(GL::Buffer& buffer) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding);
+    return *this;
+}
+
+template<UnsignedInt dimensions> Vector<dimensions>& Vector<dimensions>::bindMaterialBuffer(GL::Buffer& buffer, const GLintptr offset, const GLsizeiptr size) {
+    CORRADE_ASSERT(_flags >= Flag::UniformBuffers,
+        "Shaders::Vector::bindMaterialBuffer(): the shader was not created with uniform buffers enabled", *this);
+    buffer.bind(GL::Buffer::Target::Uniform, MaterialBufferBinding, offset, size);
+    return *this;
+}
+#endif
+
 template class Vector<2>;
 template class Vector<3>;
 
@@ -142,6 +335,10 @@ Debug& operator<<(Debug& debug, const VectorFlag value) {
         /* LCOV_EXCL_START */
         #define _c(v) case VectorFlag::v: return debug << "::" #v;
         _c(TextureTransformation)
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(UniformBuffers)
+        _c(VertexDrawId)
+        #endif
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -151,7 +348,11 @@ Debug& operator<<(Debug& debug, const VectorFlag value) {
 
 Debug& operator<<(Debug& debug, const VectorFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Shaders::Vector::Flags{}", {
-        VectorFlag::TextureTransformation
+        VectorFlag::TextureTransformation,
+        #ifndef MAGNUM_TARGET_GLES2
+        VectorFlag::VertexDrawId, /* Superset of UniformBuffers */
+        VectorFlag::UniformBuffers
+        #endif
         });
 }
 
@@ -23,12 +23,21 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#if defined(VERTEX_DRAW_ID) && !defined(GL_ES) && !defined(NEW_GLSL)
+#extension GL_EXT_gpu_shader4: require
+#endif
+
+#if defined(UNIFORM_BUFFERS) && !defined(GL_ES) && __VERSION__ < 140
+#extension GL_ARB_uniform_buffer_object: require
+#endif
+
 #ifndef NEW_GLSL
 #define in varying
 #define fragmentColor gl_FragColor
 #define texture texture2D
 #endif
 
+#ifndef UNIFORM_BUFFERS
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 2)
 #endif
@@ -43,6 +52,52 @@ uniform lowp vec4 color
     #endif
     ;
 
+/* Uniform buffers */
+
+#else
+#ifndef VERTEX_DRAW_ID
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 0)
+#endif
+uniform highp uint drawOffset
+    #ifndef GL_ES
+    = 0u
+    #endif
+    ;
+#define drawId drawOffset
+#else
+flat in highp uint drawId;
+#endif
+
+struct DrawUniform {
+    highp uint materialId;
+    highp uint reserved0;
+    highp uint reserved1;
+    highp uint reserved2;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 2
+    #endif
+) uniform Draw {
+    DrawUniform draws[DRAW_COUNT];
+};
+
+struct MaterialUniform {
+    lowp vec4 color;
+    lowp vec4 backgroundColor;
+};
+
+layout(std140
+    #ifdef EXPLICIT_BINDING
+    , binding = 4
+    #endif
+) uniform Material {
+    MaterialUniform materials[MATERIAL_COUNT];
+};
+#endif
+
 #ifdef EXPLICIT_TEXTURE_LAYER
 /* See AbstractVector.h for details about the ID */
 layout(binding = 6)
@@ -59,6 +114,12 @@ out lowp vec4 fragmentColor;
 #endif
 
 void main() {
+    #ifdef UNIFORM_BUFFERS
+    highp uint materialId = draws[drawId].materialId;
+    lowp vec4 color = materials[materialId].color;
+    lowp vec4 backgroundColor = materials[materialId].backgroundColor;
+    #endif
+
     lowp float intensity = texture(vectorTexture, interpolatedTextureCoordinates).r;
     fragmentColor = mix(backgroundColor, color, intensity);
 }
@@ -26,22 +26,136 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Shaders::Vector, typedef @ref Magnum::Shaders::Vector2D, @ref Magnum::Shaders::Vector3D
+ * @brief Class @ref Magnum::Shaders::Vector, typedef @ref Magnum::Shaders::Vector2D, @ref Magnum::Shaders::Vector3D, struct @ref Magnum::Shaders::VectorDrawUniform, @ref Magnum::Shaders::VectorMaterialUniform
  */
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Shaders/AbstractVector.h"
 #include "Magnum/Shaders/visibility.h"
 
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Color.h"
+#endif
+
 namespace Magnum { namespace Shaders {
 
 namespace Implementation {
     enum class VectorFlag: UnsignedByte {
-        TextureTransformation = 1 << 0
+        TextureTransformation = 1 << 0,
+        #ifndef MAGNUM_TARGET_GLES2
+        UniformBuffers = 1 << 1,
+        VertexDrawId = UniformBuffers|(1 << 2)
+        #endif
     };
     typedef Containers::EnumSet<VectorFlag> VectorFlags;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Per-draw uniform for vector shaders
+@m_since_latest
+
+Together with the generic @ref TransformationProjectionUniform2D /
+@ref TransformationProjectionUniform3D contains parameters that are specific
+to each draw call. Material-related properties are expected to be shared among
+multiple draw calls and thus are provided in a separate
+@ref VectorMaterialUniform structure, referenced by @ref materialId.
+@see @ref Vector::bindDrawBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct VectorDrawUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit VectorDrawUniform() noexcept: materialId{0} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit VectorDrawUniform(NoInitT) noexcept {}
+
+    /**
+     * @brief Set the @ref materialId field
+     * @return Reference to self (for method chaining)
+     */
+    VectorDrawUniform& setMaterialId(UnsignedInt id) {
+        materialId = id;
+        return *this;
+    }
+
+    /**
+     * @brief Material ID
+     *
+     * References a particular material from a @ref VectorMaterialUniform
+     * array. Useful when an UBO with more than one material is supplied or
+     * when drawing with @ref Vector::Flag::VertexDrawId. Should be less than
+     * the material count passed to the
+     * @ref Vector::Vector(Flags, UnsignedInt, UnsignedInt) constructor.
+     * Default value is @cpp 0 @ce, meaning the first material gets used.
+     */
+    UnsignedInt materialId;
+
+    /* Padding to a multiple of vec4 as required by std140 array
+       elements, hidden from Doxygen as it complains about them */
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    Int:32;
+    Int:32;
+    Int:32;
+    #endif
+};
+
+/**
+@brief Material uniform for vector shaders
+@m_since_latest
+
+Describes material properties referenced from
+@ref VectorDrawUniform::materialId.
+@see @ref Vector::bindMaterialBuffer()
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+struct VectorMaterialUniform {
+    /** @brief Construct with default parameters */
+    constexpr explicit VectorMaterialUniform() noexcept: color{1.0f, 1.0f, 1.0f, 1.0f}, backgroundColor{0.0f, 0.0f, 0.0f, 0.0f} {}
+
+    /** @brief Construct without initializing the contents */
+    explicit VectorMaterialUniform(NoInitT) noexcept: color{NoInit}, backgroundColor{NoInit} {}
+
+    /**
+     * @brief Set the @ref color field
+     * @return Reference to self (for method chaining)
+     */
+    VectorMaterialUniform& setColor(const Color4& color) {
+        this->color = color;
+        return *this;
+    }
+
+    /**
+     * @brief Set the @ref backgroundColor field
+     * @return Reference to self (for method chaining)
+     */
+    VectorMaterialUniform& setBackgroundColor(const Color4& color) {
+        backgroundColor = color;
+        return *this;
+    }
+
+    /**
+     * @brief Fill color
+     *
+     * Default value is @cpp 0xffffffff_rgbaf @ce.
+     * @see @ref Vector::setColor()
+     */
+    Color4 color;
+
+    /**
+     * @brief Background color
+     *
+     * Default value is @cpp 0x00000000_rgbaf @ce.
+     * @see @ref Vector::setBackgroundColor()
+     */
+    Color4 backgroundColor;
+};
+#endif
+
 /**
 @brief Vector shader
 
@@ -71,6 +185,37 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp Vector-usage2
 
+@section Shaders-Vector-ubo Uniform buffers
+
+When @ref Flag::UniformBuffers is enabled, the shader doesn't use any of the
+individual uniform setters and instead takes the parameters from uniform
+buffers. Transformation is supplied in a
+@ref TransformationProjectionUniform2D / @ref TransformationProjectionUniform3D
+buffer bound with @ref bindTransformationProjectionBuffer(), per-draw
+parameters in a @ref VectorDrawUniform buffer bound with @ref bindDrawBuffer()
+and materials, referenced by @ref VectorDrawUniform::materialId, in a
+@ref VectorMaterialUniform buffer bound with @ref bindMaterialBuffer(). If
+@ref Flag::TextureTransformation is enabled, the texture transformation is
+taken from a @ref TextureTransformationUniform buffer bound with
+@ref bindTextureTransformationBuffer(). The draw buffers are expected to
+contain at least as many items as the @p drawCount passed to the
+@ref Vector(Flags, UnsignedInt, UnsignedInt) constructor, the material buffer
+at least @p materialCount items. The item is selected with
+@ref setDrawOffset():
+
+@snippet MagnumShaders.cpp Vector-ubo
+
+Enabling @ref Flag::VertexDrawId additionally makes the shader add the value
+of the per-vertex @ref DrawId attribute to the draw offset. A single mesh can
+then contain many pieces, each with its own transformation and material, and
+still be drawn with a single draw call. This is what
+@ref Text::BatchRenderer uses to render many strings at once.
+
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object} for
+    @ref Flag::UniformBuffers
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+
 @see @ref shaders, @ref Vector2D, @ref Vector3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public AbstractVector<dimensions> {
@@ -88,7 +233,41 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
              * @see @ref setTextureMatrix()
              * @m_since{2020,06}
              */
-            TextureTransformation = 1 << 0
+            TextureTransformation = 1 << 0,
+
+            #ifndef MAGNUM_TARGET_GLES2
+            /**
+             * Use uniform buffers. Expects that uniform data are supplied via
+             * @ref bindTransformationProjectionBuffer(),
+             * @ref bindDrawBuffer(), @ref bindTextureTransformationBuffer()
+             * and @ref bindMaterialBuffer() instead of direct uniform
+             * setters. See @ref Shaders-Vector-ubo for more information.
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            UniformBuffers = 1 << 1,
+
+            /**
+             * Take the draw index from the per-vertex @ref DrawId attribute.
+             * Implies @ref Flag::UniformBuffers and adds the attribute value
+             * to the offset set in @ref setDrawOffset(), which makes it
+             * possible to draw many differently transformed and colored
+             * pieces of a single mesh in a single draw call. See
+             * @ref Shaders-Vector-ubo for more information.
+             * @requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+             * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+             * @requires_gles30 Uniform buffers are not available in OpenGL ES
+             *      2.0.
+             * @requires_webgl20 Uniform buffers are not available in WebGL
+             *      1.0.
+             * @m_since_latest
+             */
+            VertexDrawId = UniformBuffers|(1 << 2)
+            #endif
         };
 
         /**
@@ -111,6 +290,36 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
          */
         explicit Vector(Flags flags = {});
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Construct for given uniform buffer sizes
+         * @param flags         Flags
+         * @param materialCount Size of a @ref VectorMaterialUniform buffer
+         *      bound with @ref bindMaterialBuffer()
+         * @param drawCount     Size of a @ref TransformationProjectionUniform2D
+         *      / @ref TransformationProjectionUniform3D /
+         *      @ref VectorDrawUniform / @ref TextureTransformationUniform
+         *      buffer bound with @ref bindTransformationProjectionBuffer(),
+         *      @ref bindDrawBuffer() and @ref bindTextureTransformationBuffer()
+         * @m_since_latest
+         *
+         * If @p flags contains @ref Flag::UniformBuffers, @p materialCount
+         * and @p drawCount describe the uniform buffer sizes as these are
+         * required to have a statically defined size. The draw offset is
+         * then set via @ref setDrawOffset(). Expects that both counts are
+         * non-zero.
+         *
+         * If @p flags don't contain @ref Flag::UniformBuffers,
+         * @p materialCount and @p drawCount is ignored and the constructor
+         * behaves the same as @ref Vector(Flags).
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        explicit Vector(Flags flags, UnsignedInt materialCount, UnsignedInt drawCount);
+        #endif
+
         /**
          * @brief Construct without creating the underlying OpenGL object
          *
@@ -148,11 +357,42 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
          */
         Flags flags() const { return _flags; }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Material count
+         * @m_since_latest
+         *
+         * Statically defined size of the @ref VectorMaterialUniform uniform
+         * buffer. Has use only if @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt materialCount() const { return _materialCount; }
+
+        /**
+         * @brief Draw count
+         * @m_since_latest
+         *
+         * Statically defined size of each of the
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D, @ref VectorDrawUniform and
+         * @ref TextureTransformationUniform uniform buffers. Has use only if
+         * @ref Flag::UniformBuffers is set.
+         * @requires_gles30 Not defined on OpenGL ES 2.0 builds.
+         * @requires_webgl20 Not defined on WebGL 1.0 builds.
+         */
+        UnsignedInt drawCount() const { return _drawCount; }
+        #endif
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Default is an identity matrix.
+         * Default is an identity matrix. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref TransformationProjectionUniform2D::transformationProjectionMatrix
+         * / @ref TransformationProjectionUniform3D::transformationProjectionMatrix
+         * and call @ref bindTransformationProjectionBuffer() instead.
          */
         Vector<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
@@ -163,7 +403,9 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
          *
          * Expects that the shader was created with
          * @ref Flag::TextureTransformation enabled. Initial value is an
-         * identity matrix.
+         * identity matrix. If @ref Flag::UniformBuffers is set, fill
+         * @ref TextureTransformationUniform and call
+         * @ref bindTextureTransformationBuffer() instead.
          */
         Vector<dimensions>& setTextureMatrix(const Matrix3& matrix);
 
@@ -171,7 +413,10 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
          * @brief Set background color
          * @return Reference to self (for method chaining)
          *
-         * Default is @cpp 0x00000000_rgbaf @ce.
+         * Default is @cpp 0x00000000_rgbaf @ce. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref VectorMaterialUniform::backgroundColor and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref setColor()
          */
         Vector<dimensions>& setBackgroundColor(const Color4& color);
@@ -180,11 +425,122 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
          * @brief Set fill color
          * @return Reference to self (for method chaining)
          *
-         * Default is @cpp 0xffffffff_rgbaf @ce.
+         * Default is @cpp 0xffffffff_rgbaf @ce. Expects that
+         * @ref Flag::UniformBuffers is not set, in that case fill
+         * @ref VectorMaterialUniform::color and call
+         * @ref bindMaterialBuffer() instead.
          * @see @ref setBackgroundColor()
          */
         Vector<dimensions>& setColor(const Color4& color);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set a draw offset
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Specifies which item in the @ref TransformationProjectionUniform2D
+         * / @ref TransformationProjectionUniform3D, @ref VectorDrawUniform
+         * and @ref TextureTransformationUniform buffers should be used for
+         * current draw. Expects that @ref Flag::UniformBuffers is set and
+         * @p offset is less than @ref drawCount(). Initial value is
+         * @cpp 0 @ce. If @ref Flag::VertexDrawId is set, the value of the
+         * @ref DrawId attribute is added to this value, which makes each
+         * vertex pick up its own item.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Vector<dimensions>& setDrawOffset(UnsignedInt offset);
+
+        /**
+         * @brief Set a transformation and projection uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref TransformationProjectionUniform2D /
+         * @ref TransformationProjectionUniform3D.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Vector<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Vector<dimensions>& bindTransformationProjectionBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a draw uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref drawCount() instances of
+         * @ref VectorDrawUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Vector<dimensions>& bindDrawBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Vector<dimensions>& bindDrawBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a texture transformation uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that both @ref Flag::UniformBuffers and
+         * @ref Flag::TextureTransformation is set. The buffer is expected to
+         * contain @ref drawCount() instances of
+         * @ref TextureTransformationUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Vector<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Vector<dimensions>& bindTextureTransformationBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+
+        /**
+         * @brief Set a material uniform buffer
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::UniformBuffers is set. The buffer is
+         * expected to contain @ref materialCount() instances of
+         * @ref VectorMaterialUniform.
+         * @requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+         * @requires_gles30 Uniform buffers are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+         */
+        Vector<dimensions>& bindMaterialBuffer(GL::Buffer& buffer);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Vector<dimensions>& bindMaterialBuffer(GL::Buffer& buffer, GLintptr offset, GLsizeiptr size);
+        #endif
+
         #ifndef DOXYGEN_GENERATING_OUTPUT
         /* Overloads to remove WTF-factor from method chaining order */
         Vector<dimensions>& bindVectorTexture(GL::Texture2D& texture) {
@@ -203,10 +559,18 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT Vector: public Abst
         #endif
 
         Flags _flags;
+        #ifndef MAGNUM_TARGET_GLES2
+        UnsignedInt _materialCount{}, _drawCount{};
+        #endif
         Int _transformationProjectionMatrixUniform{0},
             _textureMatrixUniform{1},
             _backgroundColorUniform{2},
             _colorUniform{3};
+        #ifndef MAGNUM_TARGET_GLES2
+        /* Used instead of all other uniforms when Flag::UniformBuffers is
+           set, so it can alias them */
+        Int _drawOffsetUniform{0};
+        #endif
 };
 
 /** @brief Two-dimensional vector shader */
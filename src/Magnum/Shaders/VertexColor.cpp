@@ -25,12 +25,17 @@
 
 #include "VertexColor.h"
 
+#include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Shader.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/ProgramBinaryCache.h"
+#endif
 #include "Magnum/Math/Color.h"
 #include "Magnum/Math/Matrix3.h"
 #include "Magnum/Math/Matrix4.h"
@@ -39,7 +44,18 @@
 
 namespace Magnum { namespace Shaders {
 
-template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
+#ifndef MAGNUM_TARGET_GLES2
+namespace {
+    enum: UnsignedInt { MultiviewViewCount = 2 };
+}
+#endif
+
+template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor(const Flags flags): _flags{flags} {
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::OVR::multiview2);
+    #endif
+
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumShaders"))
@@ -57,47 +73,128 @@ template<UnsignedInt dimensions> VertexColor<dimensions>::VertexColor() {
     GL::Shader frag = Implementation::createCompatibilityShader(rs, version, GL::Shader::Type::Fragment);
 
     vert.addSource(dimensions == 2 ? "#define TWO_DIMENSIONS\n" : "#define THREE_DIMENSIONS\n")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addSource(flags & Flag::Multiview ? Utility::formatString("#define MULTIVIEW\n#define VIEW_COUNT {}\n", UnsignedInt(MultiviewViewCount)) : "")
+        #endif
         .addSource(rs.get("generic.glsl"))
         .addSource(rs.get("VertexColor.vert"));
     frag.addSource(rs.get("generic.glsl"))
         .addSource(rs.get("VertexColor.frag"));
 
-    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
-
-    attachShaders({vert, frag});
-
-    /* ES3 has this done in the shader directly */
-    #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
-    #ifndef MAGNUM_TARGET_GLES
-    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    /* Skip compilation and linking altogether if the binary is cached */
+    GL::ProgramBinaryCache* const cache = GL::Context::current().programBinaryCache();
+    const std::string cacheKey = cache ? cache->key({vert, frag}) : std::string{};
+    if(!cache || !cache->load(*this, cacheKey))
     #endif
     {
-        bindAttributeLocation(Position::Location, "position");
-        bindAttributeLocation(Color3::Location, "color"); /* Color4 is the same */
+        CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+        attachShaders({vert, frag});
+
+        /* ES3 has this done in the shader directly */
+        #if !defined(MAGNUM_TARGET_GLES) || defined(MAGNUM_TARGET_GLES2)
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_attrib_location>(version))
+        #endif
+        {
+            bindAttributeLocation(Position::Location, "position");
+            bindAttributeLocation(Color3::Location, "color"); /* Color4 is the same */
+        }
+        #endif
+
+        CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(cache) cache->save(*this, cacheKey);
+        #endif
     }
-    #endif
-
-    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::explicit_uniform_location>(version))
     #endif
     {
-        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        #ifndef MAGNUM_TARGET_GLES2
+        if(!(flags & Flag::Multiview))
+        #endif
+        {
+            _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrix");
+        }
     }
 
+    /* The per-view matrix array has no explicit location as it'd occupy
+       more than one, query it always */
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        _transformationProjectionMatrixUniform = uniformLocation("transformationProjectionMatrices");
+    #endif
+
     /* Set defaults in OpenGL ES (for desktop they are set in shader code itself) */
     #ifdef MAGNUM_TARGET_GLES
-    setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+    #ifndef MAGNUM_TARGET_GLES2
+    if(flags & Flag::Multiview)
+        setTransformationProjectionMatrices({MatrixTypeFor<dimensions, Float>{Math::IdentityInit}, MatrixTypeFor<dimensions, Float>{Math::IdentityInit}});
+    else
+    #endif
+    {
+        setTransformationProjectionMatrix(MatrixTypeFor<dimensions, Float>{Math::IdentityInit});
+    }
     #endif
 }
 
 template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix) {
+    #ifndef MAGNUM_TARGET_GLES2
+    CORRADE_ASSERT(!(_flags & Flag::Multiview),
+        "Shaders::VertexColor::setTransformationProjectionMatrix(): the shader was created with multiview enabled, use setTransformationProjectionMatrices() instead", *this);
+    #endif
     setUniform(_transformationProjectionMatrixUniform, matrix);
     return *this;
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::setTransformationProjectionMatrices(const Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices) {
+    CORRADE_ASSERT(_flags & Flag::Multiview,
+        "Shaders::VertexColor::setTransformationProjectionMatrices(): the shader was not created with multiview enabled", *this);
+    CORRADE_ASSERT(matrices.size() == MultiviewViewCount,
+        "Shaders::VertexColor::setTransformationProjectionMatrices(): expected" << UnsignedInt(MultiviewViewCount) << "items but got" << matrices.size(), *this);
+    setUniform(_transformationProjectionMatrixUniform, matrices);
+    return *this;
+}
+
+template<UnsignedInt dimensions> VertexColor<dimensions>& VertexColor<dimensions>::setTransformationProjectionMatrices(const std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices) {
+    return setTransformationProjectionMatrices(Containers::arrayView(matrices));
+}
+#endif
+
 template class VertexColor<2>;
 template class VertexColor<3>;
 
+namespace Implementation {
+
+Debug& operator<<(Debug& debug, const VertexColorFlag value) {
+    debug << "Shaders::VertexColor::Flag" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case VertexColorFlag::v: return debug << "::" #v;
+        #ifndef MAGNUM_TARGET_GLES2
+        _c(Multiview)
+        #endif
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const VertexColorFlags value) {
+    return Containers::enumSetDebugOutput(debug, value, "Shaders::VertexColor::Flags{}", {
+        #ifndef MAGNUM_TARGET_GLES2
+        VertexColorFlag::Multiview
+        #endif
+        });
+}
+
+}
+
 }}
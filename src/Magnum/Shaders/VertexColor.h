@@ -29,6 +29,8 @@
  * @brief Class @ref Magnum::Shaders::VertexColor
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/GL/AbstractShaderProgram.h"
 #include "Magnum/Shaders/Generic.h"
@@ -36,6 +38,15 @@
 
 namespace Magnum { namespace Shaders {
 
+namespace Implementation {
+    enum class VertexColorFlag: UnsignedByte {
+        #ifndef MAGNUM_TARGET_GLES2
+        Multiview = 1 << 0
+        #endif
+    };
+    typedef Containers::EnumSet<VertexColorFlag> VertexColorFlags;
+}
+
 /**
 @brief Vertex color shader
 
@@ -67,6 +78,17 @@ Common rendering setup:
 
 @snippet MagnumShaders.cpp VertexColor-usage2
 
+@section Shaders-VertexColor-multiview Single-pass stereo rendering
+
+If @ref Flag::Multiview is enabled, the shader renders into two views at once
+using @gl_extension{OVR,multiview2}, picking a different transformation and
+projection matrix for each based on @glsl gl_ViewID_OVR @ce. The matrices are
+supplied with @ref setTransformationProjectionMatrices() instead of
+@ref setTransformationProjectionMatrix() and the target framebuffer is
+expected to have a two-layer multiview attachment set up with
+@ref GL::Framebuffer::attachTextureMultiview(). See
+@ref Shaders-Flat-multiview for an example, the setup is the same there.
+
 @see @ref shaders, @ref VertexColor2D, @ref VertexColor3D
 */
 template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public GL::AbstractShaderProgram {
@@ -105,7 +127,48 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
             ColorOutput = Generic<dimensions>::ColorOutput
         };
 
-        explicit VertexColor();
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        /**
+         * @brief Flag
+         * @m_since_latest
+         *
+         * @see @ref Flags, @ref flags()
+         */
+        enum class Flag: UnsignedByte {
+            /**
+             * Render into two views at once, with the transformation and
+             * projection matrix picked based on @glsl gl_ViewID_OVR @ce.
+             * Expects the matrices to be supplied via
+             * @ref setTransformationProjectionMatrices(). See
+             * @ref Shaders-VertexColor-multiview for more information.
+             * @requires_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_es_extension Extension @gl_extension{OVR,multiview2}
+             * @requires_webgl_extension Extension
+             *      @webgl_extension{OVR,multiview2}
+             * @m_since_latest
+             */
+            Multiview = 1 << 0
+        };
+
+        /**
+         * @brief Flags
+         * @m_since_latest
+         *
+         * @see @ref flags()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+        #else
+        /* Done this way to be prepared for possible future diversion of 2D
+           and 3D flags (e.g. introducing 3D-specific features) */
+        typedef Implementation::VertexColorFlag Flag;
+        typedef Implementation::VertexColorFlags Flags;
+        #endif
+
+        /**
+         * @brief Constructor
+         * @param flags     Flags
+         */
+        explicit VertexColor(Flags flags = {});
 
         /**
          * @brief Construct without creating the underlying OpenGL object
@@ -133,14 +196,46 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
         /** @brief Move assignment */
         VertexColor<dimensions>& operator=(VertexColor<dimensions>&&) noexcept = default;
 
+        /**
+         * @brief Flags
+         * @m_since_latest
+         */
+        Flags flags() const { return _flags; }
+
         /**
          * @brief Set transformation and projection matrix
          * @return Reference to self (for method chaining)
          *
-         * Default is an identity matrix.
+         * Default is an identity matrix. Expects that
+         * @ref Flag::Multiview is not set, use
+         * @ref setTransformationProjectionMatrices() in that case instead.
          */
         VertexColor<dimensions>& setTransformationProjectionMatrix(const MatrixTypeFor<dimensions, Float>& matrix);
 
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Set per-view transformation and projection matrices
+         * @return Reference to self (for method chaining)
+         * @m_since_latest
+         *
+         * Expects that @ref Flag::Multiview is set and that @p matrices has
+         * exactly two items, the first used for the view with
+         * @glsl gl_ViewID_OVR @ce equal to @cpp 0 @ce and the second for
+         * the view with @glsl gl_ViewID_OVR @ce equal to @cpp 1 @ce. Default
+         * is an identity matrix for both. See
+         * @ref Shaders-VertexColor-multiview for more information.
+         * @requires_gles30 Multiview is not available in OpenGL ES 2.0.
+         * @requires_webgl20 Multiview is not available in WebGL 1.0.
+         */
+        VertexColor<dimensions>& setTransformationProjectionMatrices(Containers::ArrayView<const MatrixTypeFor<dimensions, Float>> matrices);
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        VertexColor<dimensions>& setTransformationProjectionMatrices(std::initializer_list<MatrixTypeFor<dimensions, Float>> matrices);
+        #endif
+
     private:
         /* Prevent accidentally calling irrelevant functions */
         #ifndef MAGNUM_TARGET_GLES
@@ -150,6 +245,7 @@ template<UnsignedInt dimensions> class MAGNUM_SHADERS_EXPORT VertexColor: public
         using GL::AbstractShaderProgram::dispatchCompute;
         #endif
 
+        Flags _flags;
         Int _transformationProjectionMatrixUniform{0};
 };
 
@@ -159,6 +255,20 @@ typedef VertexColor<2> VertexColor2D;
 /** @brief 3D vertex color shader */
 typedef VertexColor<3> VertexColor3D;
 
+#ifdef DOXYGEN_GENERATING_OUTPUT
+/** @debugoperatorclassenum{VertexColor,VertexColor::Flag} */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, VertexColor<dimensions>::Flag value);
+
+/** @debugoperatorclassenum{VertexColor,VertexColor::Flags} */
+template<UnsignedInt dimensions> Debug& operator<<(Debug& debug, VertexColor<dimensions>::Flags value);
+#else
+namespace Implementation {
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, VertexColorFlag value);
+    MAGNUM_SHADERS_EXPORT Debug& operator<<(Debug& debug, VertexColorFlags value);
+    CORRADE_ENUMSET_OPERATORS(VertexColorFlags)
+}
+#endif
+
 }}
 
 #endif
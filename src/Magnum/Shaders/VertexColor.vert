@@ -23,11 +23,39 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#ifdef MULTIVIEW
+#extension GL_OVR_multiview2: require
+#endif
+
 #ifndef NEW_GLSL
 #define in attribute
 #define out varying
 #endif
 
+#ifdef MULTIVIEW
+layout(num_views = VIEW_COUNT) in;
+#endif
+
+#ifdef MULTIVIEW
+/* Not using an explicit location as the array would occupy VIEW_COUNT
+   locations */
+#ifdef TWO_DIMENSIONS
+uniform highp mat3 transformationProjectionMatrices[VIEW_COUNT]
+    #ifndef GL_ES
+    = mat3[](mat3(1.0), mat3(1.0))
+    #endif
+    ;
+#elif defined(THREE_DIMENSIONS)
+uniform highp mat4 transformationProjectionMatrices[VIEW_COUNT]
+    #ifndef GL_ES
+    = mat4[](mat4(1.0), mat4(1.0))
+    #endif
+    ;
+#else
+#error
+#endif
+#define transformationProjectionMatrix transformationProjectionMatrices[gl_ViewID_OVR]
+#else
 #ifdef EXPLICIT_UNIFORM_LOCATION
 layout(location = 0)
 #endif
@@ -46,6 +74,7 @@ uniform highp mat4 transformationProjectionMatrix
 #else
 #error
 #endif
+#endif
 
 #ifdef EXPLICIT_ATTRIB_LOCATION
 layout(location = POSITION_ATTRIBUTE_LOCATION)
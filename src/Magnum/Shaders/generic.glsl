@@ -32,6 +32,8 @@
 #define BITANGENT_ATTRIBUTE_LOCATION 4 /* also ObjectId */
 #define OBJECT_ID_ATTRIBUTE_LOCATION 4 /* also Bitangent */
 #define NORMAL_ATTRIBUTE_LOCATION 5
+#define WEIGHTS_ATTRIBUTE_LOCATION 6
+#define JOINT_IDS_ATTRIBUTE_LOCATION 7
 
 #define TRANSFORMATION_MATRIX_ATTRIBUTE_LOCATION 8
 #define NORMAL_MATRIX_ATTRIBUTE_LOCATION 12
@@ -0,0 +1,269 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/AbstractAsyncResourceLoader.h"
+#include "Magnum/ResourceManager.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct AbstractAsyncResourceLoaderTest: TestSuite::Tester {
+    explicit AbstractAsyncResourceLoaderTest();
+
+    void construct();
+    void constructDefaultThreadCount();
+
+    void load();
+    void loadFallback();
+    void commitByteBudget();
+    void commitTimeBudget();
+    void commitEmpty();
+    void commitByteSizePolicy();
+    void finish();
+};
+
+typedef Magnum::ResourceManager<Int> ResourceManager;
+
+struct IntResourceLoader: AbstractAsyncResourceLoader<Int> {
+    explicit IntResourceLoader(UnsignedInt threadCount = 1): AbstractAsyncResourceLoader<Int>{threadCount} {}
+
+    ~IntResourceLoader() { finish(); }
+
+    private:
+        /* The key is the value itself, "world" is not found */
+        Containers::Pointer<Int> doDecode(ResourceKey key) override {
+            for(Int i: {10, 20, 30, 773})
+                if(key == ResourceKey{std::to_string(i)})
+                    return Containers::pointer<Int>(i);
+            return nullptr;
+        }
+
+        std::size_t doByteSize(const Int& data) const override {
+            return std::size_t(data);
+        }
+};
+
+AbstractAsyncResourceLoaderTest::AbstractAsyncResourceLoaderTest() {
+    addTests({&AbstractAsyncResourceLoaderTest::construct,
+              &AbstractAsyncResourceLoaderTest::constructDefaultThreadCount,
+
+              &AbstractAsyncResourceLoaderTest::load,
+              &AbstractAsyncResourceLoaderTest::loadFallback,
+              &AbstractAsyncResourceLoaderTest::commitByteBudget,
+              &AbstractAsyncResourceLoaderTest::commitTimeBudget,
+              &AbstractAsyncResourceLoaderTest::commitEmpty,
+              &AbstractAsyncResourceLoaderTest::commitByteSizePolicy,
+              &AbstractAsyncResourceLoaderTest::finish});
+}
+
+void AbstractAsyncResourceLoaderTest::construct() {
+    IntResourceLoader loader{3};
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_COMPARE(loader.threadCount(), 3);
+    #else
+    CORRADE_COMPARE(loader.threadCount(), 0);
+    #endif
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.readyCount(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::constructDefaultThreadCount() {
+    IntResourceLoader loader{0};
+    #if !defined(CORRADE_TARGET_EMSCRIPTEN) || defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_VERIFY(loader.threadCount() >= 1);
+    #else
+    CORRADE_COMPARE(loader.threadCount(), 0);
+    #endif
+}
+
+void AbstractAsyncResourceLoaderTest::load() {
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 4u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> hello = rm.get<Int>("773");
+    Resource<Int> world = rm.get<Int>("world");
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+
+    /* Decoded, but not committed yet */
+    loader.wait();
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.readyCount(), 2);
+    CORRADE_COMPARE(hello.state(), ResourceState::Loading);
+    CORRADE_COMPARE(world.state(), ResourceState::Loading);
+    CORRADE_COMPARE(loader.loadedCount(), 0);
+    CORRADE_COMPARE(loader.notFoundCount(), 0);
+
+    /* Requesting an already loading resource doesn't request it again */
+    rm.get<Int>("773");
+    CORRADE_COMPARE(loader.requestedCount(), 2);
+
+    CORRADE_COMPARE(loader.commit(), 2);
+    CORRADE_COMPARE(loader.readyCount(), 0);
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 773);
+    CORRADE_COMPARE(world.state(), ResourceState::NotFound);
+    CORRADE_COMPARE(loader.loadedCount(), 1);
+    CORRADE_COMPARE(loader.notFoundCount(), 1);
+}
+
+void AbstractAsyncResourceLoaderTest::loadFallback() {
+    ResourceManager rm;
+    rm.setFallback(Containers::pointer<Int>(-1));
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> hello = rm.get<Int>("773");
+    CORRADE_COMPARE(hello.state(), ResourceState::LoadingFallback);
+    CORRADE_COMPARE(*hello, -1);
+
+    loader.wait();
+    loader.commit();
+    CORRADE_COMPARE(hello.state(), ResourceState::Final);
+    CORRADE_COMPARE(*hello, 773);
+}
+
+void AbstractAsyncResourceLoaderTest::commitByteBudget() {
+    ResourceManager rm;
+    /* Single thread, so the resources are decoded in order */
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> a = rm.get<Int>("10");
+    Resource<Int> b = rm.get<Int>("20");
+    Resource<Int> c = rm.get<Int>("30");
+    loader.wait();
+    CORRADE_COMPARE(loader.readyCount(), 3);
+
+    /* 10 + 20 is over the budget */
+    CORRADE_COMPARE(loader.commit(std::chrono::nanoseconds::max(), 25), 1);
+    CORRADE_COMPARE(a.state(), ResourceState::Final);
+    CORRADE_COMPARE(b.state(), ResourceState::Loading);
+    CORRADE_COMPARE(c.state(), ResourceState::Loading);
+
+    /* 20 + 30 is over the budget */
+    CORRADE_COMPARE(loader.commit(std::chrono::nanoseconds::max(), 25), 1);
+    CORRADE_COMPARE(b.state(), ResourceState::Final);
+    CORRADE_COMPARE(c.state(), ResourceState::Loading);
+
+    /* 30 alone is over the budget, but it's committed to not block the
+       queue */
+    CORRADE_COMPARE(loader.commit(std::chrono::nanoseconds::max(), 25), 1);
+    CORRADE_COMPARE(c.state(), ResourceState::Final);
+    CORRADE_COMPARE(*c, 30);
+    CORRADE_COMPARE(loader.readyCount(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::commitTimeBudget() {
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    rm.get<Int>("10");
+    rm.get<Int>("20");
+    loader.wait();
+
+    /* With a zero budget it commits just one */
+    CORRADE_COMPARE(loader.commit(std::chrono::nanoseconds::zero()), 1);
+    CORRADE_COMPARE(loader.readyCount(), 1);
+    CORRADE_COMPARE(loader.commit(std::chrono::nanoseconds::zero()), 1);
+    CORRADE_COMPARE(loader.readyCount(), 0);
+    CORRADE_COMPARE(loader.loadedCount(), 2);
+}
+
+void AbstractAsyncResourceLoaderTest::commitEmpty() {
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    CORRADE_COMPARE(loader.commit(), 0);
+}
+
+void AbstractAsyncResourceLoaderTest::commitByteSizePolicy() {
+    ResourceManager rm;
+    /* Single thread, so the resources are decoded in order */
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 1u};
+    IntResourceLoader& loader = *loaderPtr;
+    CORRADE_COMPARE(loader.policy(), ResourcePolicy::Resident);
+    loader.setPolicy(ResourcePolicy::Manual);
+    CORRADE_COMPARE(loader.policy(), ResourcePolicy::Manual);
+    rm.setLoader<Int>(std::move(loaderPtr))
+      .setByteBudget<Int>(25);
+
+    rm.get<Int>("10");
+    rm.get<Int>("20");
+    loader.wait();
+    CORRADE_COMPARE(loader.commit(), 2);
+
+    /* The size gets passed to the manager, which evicts the first resource
+       after exceeding the budget */
+    CORRADE_COMPARE(rm.byteSize<Int>(), 20);
+    CORRADE_COMPARE(rm.byteSize<Int>("20"), 20);
+    CORRADE_COMPARE(rm.state<Int>("10"), ResourceState::NotLoaded);
+
+    /* Requesting it again loads it again */
+    Resource<Int> a = rm.get<Int>("10");
+    CORRADE_COMPARE(loader.requestedCount(), 3);
+    loader.wait();
+    loader.commit();
+    CORRADE_COMPARE(*a, 10);
+}
+
+void AbstractAsyncResourceLoaderTest::finish() {
+    ResourceManager rm;
+    Containers::Pointer<IntResourceLoader> loaderPtr{Containers::InPlaceInit, 2u};
+    IntResourceLoader& loader = *loaderPtr;
+    rm.setLoader<Int>(std::move(loaderPtr));
+
+    Resource<Int> a = rm.get<Int>("10");
+    loader.finish();
+    CORRADE_COMPARE(loader.threadCount(), 0);
+    CORRADE_COMPARE(loader.pendingCount(), 0);
+    CORRADE_COMPARE(loader.readyCount(), 1);
+
+    /* Decoded directly on the calling thread, but still only committed
+       through commit() */
+    Resource<Int> b = rm.get<Int>("20");
+    CORRADE_COMPARE(loader.readyCount(), 2);
+    CORRADE_COMPARE(b.state(), ResourceState::Loading);
+
+    /* Calling it again does nothing */
+    loader.finish();
+
+    CORRADE_COMPARE(loader.commit(), 2);
+    CORRADE_COMPARE(*a, 10);
+    CORRADE_COMPARE(*b, 20);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::AbstractAsyncResourceLoaderTest)
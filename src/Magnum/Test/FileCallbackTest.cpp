@@ -24,6 +24,9 @@
 */
 
 #include <sstream>
+#include <type_traits>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 
@@ -35,10 +38,18 @@ struct FileCallbackTest: TestSuite::Tester {
     explicit FileCallbackTest();
 
     void debugInputFileCallbackPolicy();
+
+    void mappedNonexistent();
+    void mappedClose();
+    void mappedMove();
 };
 
 FileCallbackTest::FileCallbackTest() {
-    addTests({&FileCallbackTest::debugInputFileCallbackPolicy});
+    addTests({&FileCallbackTest::debugInputFileCallbackPolicy,
+
+              &FileCallbackTest::mappedNonexistent,
+              &FileCallbackTest::mappedClose,
+              &FileCallbackTest::mappedMove});
 }
 
 void FileCallbackTest::debugInputFileCallbackPolicy() {
@@ -48,6 +59,54 @@ void FileCallbackTest::debugInputFileCallbackPolicy() {
     CORRADE_COMPARE(out.str(), "InputFileCallbackPolicy::Close InputFileCallbackPolicy(0xf0)\n");
 }
 
+void FileCallbackTest::mappedNonexistent() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    MappedFileCallback files;
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!MappedFileCallback::callback("nonexistent.bin", InputFileCallbackPolicy::LoadTemporary, files));
+    }
+    /* Failed mappings are not remembered */
+    CORRADE_COMPARE(files.mappedCount(), 0);
+    CORRADE_VERIFY(!files.isMapped("nonexistent.bin"));
+    #else
+    CORRADE_SKIP("Memory mapping is not available on this platform.");
+    #endif
+}
+
+void FileCallbackTest::mappedClose() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    MappedFileCallback files;
+
+    /* Closing is a no-op, even for files that were never mapped */
+    CORRADE_VERIFY(!MappedFileCallback::callback("nonexistent.bin", InputFileCallbackPolicy::Close, files));
+    CORRADE_COMPARE(files.mappedCount(), 0);
+    #else
+    CORRADE_SKIP("Memory mapping is not available on this platform.");
+    #endif
+}
+
+void FileCallbackTest::mappedMove() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    MappedFileCallback a;
+    MappedFileCallback b{std::move(a)};
+    CORRADE_COMPARE(b.mappedCount(), 0);
+
+    MappedFileCallback c;
+    c = std::move(b);
+    CORRADE_COMPARE(c.mappedCount(), 0);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MappedFileCallback>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MappedFileCallback>::value);
+    CORRADE_VERIFY(!std::is_copy_constructible<MappedFileCallback>::value);
+    CORRADE_VERIFY(!std::is_copy_assignable<MappedFileCallback>::value);
+    #else
+    CORRADE_SKIP("Memory mapping is not available on this platform.");
+    #endif
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Test::FileCallbackTest)
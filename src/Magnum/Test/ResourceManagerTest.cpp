@@ -25,6 +25,7 @@
 */
 
 #include <sstream>
+#include <vector>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/FormatStl.h>
 
@@ -53,6 +54,13 @@ struct ResourceManagerTest: TestSuite::Tester {
     void defaults();
     void clear();
     void clearWhileReferenced();
+    void manyResources();
+
+    void byteSize();
+    void byteSizeNotFound();
+    void evict();
+    void evictLoading();
+    void byteBudget();
 
     void loader();
     void loaderSetNullptr();
@@ -90,6 +98,13 @@ ResourceManagerTest::ResourceManagerTest() {
               &ResourceManagerTest::defaults,
               &ResourceManagerTest::clear,
               &ResourceManagerTest::clearWhileReferenced,
+              &ResourceManagerTest::manyResources,
+
+              &ResourceManagerTest::byteSize,
+              &ResourceManagerTest::byteSizeNotFound,
+              &ResourceManagerTest::evict,
+              &ResourceManagerTest::evictLoading,
+              &ResourceManagerTest::byteBudget,
 
               &ResourceManagerTest::loader,
               &ResourceManagerTest::loaderSetNullptr,
@@ -432,6 +447,182 @@ void ResourceManagerTest::clearWhileReferenced() {
     CORRADE_COMPARE(out.str(), "ResourceManager: cleared/destroyed while data are still referenced\n");
 }
 
+void ResourceManagerTest::manyResources() {
+    ResourceManager rm;
+
+    /* Acquire resources before they're set, which forces the storage to grow
+       several times. The resources should still point to the right data. */
+    std::vector<Resource<Int>> resources;
+    for(Int i = 0; i != 500; ++i)
+        resources.push_back(rm.get<Int>(std::to_string(i)));
+    CORRADE_COMPARE(rm.count<Int>(), 500);
+
+    for(Int i = 0; i != 1000; ++i)
+        rm.set(std::to_string(i), i, ResourceDataState::Mutable, i % 2 ? ResourcePolicy::Manual : ResourcePolicy::ReferenceCounted);
+    CORRADE_COMPARE(rm.count<Int>(), 1000);
+
+    for(Int i = 0; i != 500; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(resources[i].state(), ResourceState::Mutable);
+        CORRADE_COMPARE(*resources[i], i);
+    }
+
+    /* Freeing removes all unreferenced ones */
+    rm.free();
+    CORRADE_COMPARE(rm.count<Int>(), 500);
+    for(Int i = 0; i != 1000; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(rm.state<Int>(std::to_string(i)), i < 500 ? ResourceState::Mutable : ResourceState::NotLoaded);
+    }
+
+    /* Releasing the references drops the reference-counted even ones, the
+       remaining ones should be still reachable after all the removals */
+    resources.clear();
+    CORRADE_COMPARE(rm.count<Int>(), 250);
+    for(Int i = 0; i != 1000; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(rm.state<Int>(std::to_string(i)), i < 500 && i % 2 ? ResourceState::Mutable : ResourceState::NotLoaded);
+    }
+
+    /* Updating data is picked up by an existing resource */
+    Resource<Int> a = rm.get<Int>("1");
+    CORRADE_COMPARE(*a, 1);
+    rm.set("1", 1337, ResourceDataState::Mutable, ResourcePolicy::Manual);
+    CORRADE_COMPARE(*a, 1337);
+}
+
+void ResourceManagerTest::byteSize() {
+    ResourceManager rm;
+    CORRADE_COMPARE(rm.byteSize<Int>(), 0);
+    CORRADE_COMPARE(rm.byteSize<Int>("a"), 0);
+
+    rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .setByteSize<Int>("a", 10)
+      .setByteSize<Int>("b", 20);
+    CORRADE_COMPARE(rm.byteSize<Int>("a"), 10);
+    CORRADE_COMPARE(rm.byteSize<Int>("b"), 20);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 30);
+    /* Other types are tracked separately */
+    CORRADE_COMPARE(rm.byteSize<Data>(), 0);
+
+    /* Changing the size */
+    rm.setByteSize<Int>("a", 5);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 25);
+
+    /* Updating the data resets the size */
+    rm.set("a", 3, ResourceDataState::Mutable, ResourcePolicy::Manual);
+    CORRADE_COMPARE(rm.byteSize<Int>("a"), 0);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 20);
+
+    /* Freeing subtracts the size */
+    rm.free();
+    CORRADE_COMPARE(rm.byteSize<Int>(), 0);
+
+    rm.set("c", 4, ResourceDataState::Mutable, ResourcePolicy::Resident)
+      .setByteSize<Int>("c", 40);
+    rm.clear();
+    CORRADE_COMPARE(rm.byteSize<Int>(), 0);
+}
+
+void ResourceManagerTest::byteSizeNotFound() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    ResourceManager rm;
+    ResourceKey key{"a"};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    rm.setByteSize<Int>(key, 10);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 0);
+    CORRADE_COMPARE(out.str(), Utility::formatString("ResourceManager::setByteSize(): resource ResourceKey(0x{}) doesn't exist\n", key.hexString()));
+}
+
+void ResourceManagerTest::evict() {
+    ResourceManager rm;
+    rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .set("c", 3, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .set("resident", 4, ResourceDataState::Mutable, ResourcePolicy::Resident)
+      .set("referenced", 5, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .set("empty", 6, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .setByteSize<Int>("a", 10)
+      .setByteSize<Int>("b", 20)
+      .setByteSize<Int>("c", 30)
+      .setByteSize<Int>("resident", 100)
+      .setByteSize<Int>("referenced", 200);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 360);
+
+    /* Using b makes it the most recently used one */
+    {
+        Resource<Int> b = rm.get<Int>("b");
+    }
+    Resource<Int> referenced = rm.get<Int>("referenced");
+
+    /* Evicting a and c gets it to 320, b stays */
+    rm.evict<Int>(330);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 320);
+    CORRADE_COMPARE(rm.count<Int>(), 4);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::Mutable);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::NotLoaded);
+
+    /* Resident, referenced and zero-sized resources are never evicted */
+    rm.evict<Int>(0);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 300);
+    CORRADE_COMPARE(rm.count<Int>(), 3);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("resident"), ResourceState::Mutable);
+    CORRADE_COMPARE(rm.state<Int>("empty"), ResourceState::Mutable);
+    CORRADE_COMPARE(*referenced, 5);
+}
+
+void ResourceManagerTest::evictLoading() {
+    ResourceManager rm;
+    rm.set<Int>("a", nullptr, ResourceDataState::Loading, ResourcePolicy::Manual)
+      .setByteSize<Int>("a", 10);
+
+    /* Resources that are being loaded are not evicted */
+    rm.evict<Int>(0);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::Loading);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 10);
+}
+
+void ResourceManagerTest::byteBudget() {
+    ResourceManager rm;
+    CORRADE_COMPARE(rm.byteBudget<Int>(), ~std::size_t{});
+
+    rm.setByteBudget<Int>(25);
+    CORRADE_COMPARE(rm.byteBudget<Int>(), 25);
+
+    rm.set("a", 1, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .setByteSize<Int>("a", 10)
+      .set("b", 2, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .setByteSize<Int>("b", 10);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 20);
+    CORRADE_COMPARE(rm.count<Int>(), 2);
+
+    /* Exceeding the budget evicts the least recently used one */
+    rm.set("c", 3, ResourceDataState::Mutable, ResourcePolicy::Manual)
+      .setByteSize<Int>("c", 10);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 20);
+    CORRADE_COMPARE(rm.count<Int>(), 2);
+    CORRADE_COMPARE(rm.state<Int>("a"), ResourceState::NotLoaded);
+
+    /* Lowering the budget evicts right away */
+    rm.setByteBudget<Int>(10);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 10);
+    CORRADE_COMPARE(rm.state<Int>("b"), ResourceState::NotLoaded);
+    CORRADE_COMPARE(rm.state<Int>("c"), ResourceState::Mutable);
+
+    /* Growing a resource over the budget evicts it as well */
+    rm.setByteSize<Int>("c", 20);
+    CORRADE_COMPARE(rm.count<Int>(), 0);
+    CORRADE_COMPARE(rm.byteSize<Int>(), 0);
+}
+
 void ResourceManagerTest::loader() {
     class IntResourceLoader: public AbstractResourceLoader<Int> {
         public:
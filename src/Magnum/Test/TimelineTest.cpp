@@ -0,0 +1,167 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/System.h>
+
+#include "Magnum/Timeline.h"
+
+namespace Magnum { namespace Test { namespace {
+
+struct TimelineTest: TestSuite::Tester {
+    explicit TimelineTest();
+
+    void construct();
+    void nextFrame();
+    void nextFrameStopped();
+
+    void fixedTimestep();
+    void fixedTimestepDisabled();
+    void fixedTimestepMaxStepCount();
+    void fixedTimestepRestart();
+    void setFixedTimestepInvalid();
+};
+
+TimelineTest::TimelineTest() {
+    addTests({&TimelineTest::construct,
+              &TimelineTest::nextFrame,
+              &TimelineTest::nextFrameStopped,
+
+              &TimelineTest::fixedTimestep,
+              &TimelineTest::fixedTimestepDisabled,
+              &TimelineTest::fixedTimestepMaxStepCount,
+              &TimelineTest::fixedTimestepRestart,
+              &TimelineTest::setFixedTimestepInvalid});
+}
+
+void TimelineTest::construct() {
+    Timeline timeline;
+    CORRADE_COMPARE(timeline.previousFrameTime(), 0.0f);
+    CORRADE_COMPARE(timeline.previousFrameDuration(), 0.0f);
+    CORRADE_COMPARE(timeline.fixedTimestep(), 0.0f);
+    CORRADE_COMPARE(timeline.maxFixedStepCount(), 0);
+    CORRADE_COMPARE(timeline.fixedStepCount(), 0);
+    CORRADE_COMPARE(timeline.fixedStepInterpolation(), 0.0f);
+}
+
+void TimelineTest::nextFrame() {
+    Timeline timeline;
+    timeline.start();
+    Utility::System::sleep(10);
+    timeline.nextFrame();
+
+    /* Sleep can take longer but not shorter */
+    CORRADE_COMPARE_AS(timeline.previousFrameDuration(), 0.01f,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE(timeline.previousFrameTime(), timeline.previousFrameDuration());
+}
+
+void TimelineTest::nextFrameStopped() {
+    Timeline timeline;
+    timeline.setFixedTimestep(0.001f);
+    Utility::System::sleep(5);
+    timeline.nextFrame();
+    CORRADE_COMPARE(timeline.previousFrameDuration(), 0.0f);
+    CORRADE_COMPARE(timeline.fixedStepCount(), 0);
+}
+
+void TimelineTest::fixedTimestep() {
+    Timeline timeline;
+    timeline.setFixedTimestep(0.01f, 100);
+    CORRADE_COMPARE(timeline.fixedTimestep(), 0.01f);
+    CORRADE_COMPARE(timeline.maxFixedStepCount(), 100);
+
+    timeline.start();
+    Utility::System::sleep(35);
+    timeline.nextFrame();
+
+    /* The steps together with the leftover should make up the whole frame */
+    CORRADE_COMPARE_AS(timeline.fixedStepCount(), 3,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(timeline.fixedStepInterpolation(), 0.0f,
+        TestSuite::Compare::GreaterOrEqual);
+    CORRADE_COMPARE_AS(timeline.fixedStepInterpolation(), 1.0f,
+        TestSuite::Compare::Less);
+    CORRADE_COMPARE_WITH((timeline.fixedStepCount() + timeline.fixedStepInterpolation())*timeline.fixedTimestep(),
+        timeline.previousFrameDuration(),
+        TestSuite::Compare::around(0.0001f));
+}
+
+void TimelineTest::fixedTimestepDisabled() {
+    Timeline timeline;
+    timeline.start();
+    Utility::System::sleep(5);
+    timeline.nextFrame();
+    CORRADE_COMPARE(timeline.fixedStepCount(), 0);
+    CORRADE_COMPARE(timeline.fixedStepInterpolation(), 0.0f);
+}
+
+void TimelineTest::fixedTimestepMaxStepCount() {
+    Timeline timeline;
+    timeline.setFixedTimestep(0.001f, 4);
+    timeline.start();
+    Utility::System::sleep(20);
+    timeline.nextFrame();
+
+    /* The time that couldn't be caught up with is dropped */
+    CORRADE_COMPARE(timeline.fixedStepCount(), 4);
+    CORRADE_COMPARE(timeline.fixedStepInterpolation(), 0.0f);
+}
+
+void TimelineTest::fixedTimestepRestart() {
+    Timeline timeline;
+    timeline.setFixedTimestep(0.001f, 1000);
+    timeline.start();
+    Utility::System::sleep(5);
+    timeline.nextFrame();
+    CORRADE_VERIFY(timeline.fixedStepCount());
+
+    timeline.stop();
+    CORRADE_COMPARE(timeline.fixedStepCount(), 0);
+    CORRADE_COMPARE(timeline.fixedStepInterpolation(), 0.0f);
+}
+
+void TimelineTest::setFixedTimestepInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Timeline timeline;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    timeline.setFixedTimestep(-1.0f);
+    timeline.setFixedTimestep(1.0f, 0);
+    CORRADE_COMPARE(out.str(),
+        "Timeline::setFixedTimestep(): expected non-negative duration, got -1\n"
+        "Timeline::setFixedTimestep(): max step count can't be zero\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Test::TimelineTest)
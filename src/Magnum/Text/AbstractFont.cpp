@@ -28,6 +28,8 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
@@ -45,7 +47,7 @@ namespace Magnum { namespace Text {
 std::string AbstractFont::pluginInterface() {
     return
 /* [interface] */
-"cz.mosra.magnum.Text.AbstractFont/0.3"
+"cz.mosra.magnum.Text.AbstractFont/0.3.2"
 /* [interface] */
     ;
 }
@@ -266,7 +268,25 @@ Containers::Pointer<AbstractGlyphCache> AbstractFont::doCreateGlyphCache() {
 Containers::Pointer<AbstractLayouter> AbstractFont::layout(const AbstractGlyphCache& cache, const Float size, const std::string& text) {
     CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", nullptr);
 
-    return doLayout(cache, size, text);
+    Containers::Pointer<AbstractLayouter> layouter = doLayout(cache, size, text);
+    if(layouter) layouter->_font = this;
+    return layouter;
+}
+
+void AbstractFont::layout(const AbstractGlyphCache& cache, const Float size, const Containers::StringView text, Containers::Pointer<AbstractLayouter>& layouter) {
+    CORRADE_ASSERT(isOpened(), "Text::AbstractFont::layout(): no font opened", );
+
+    /* Reuse the layouter only if it's our own, otherwise the plugin
+       implementation would cast it to a wrong type */
+    if(layouter && layouter->_font == this && doRelayout(*layouter, cache, size, text))
+        return;
+
+    const std::string textString = text;
+    layouter = layout(cache, size, textString);
+}
+
+bool AbstractFont::doRelayout(AbstractLayouter&, const AbstractGlyphCache&, Float, Containers::StringView) {
+    return false;
 }
 
 Debug& operator<<(Debug& debug, const FontFeature value) {
@@ -321,4 +341,34 @@ std::pair<Range2D, Range2D> AbstractLayouter::renderGlyph(const UnsignedInt i, V
     return {quadPosition, textureCoordinates};
 }
 
+void AbstractLayouter::renderGlyphs(const UnsignedInt offset, Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances) {
+    CORRADE_ASSERT(textureCoordinates.size() == quadPositions.size() && advances.size() == quadPositions.size(),
+        "Text::AbstractLayouter::renderGlyphs(): expected views to have the same size but got" << quadPositions.size() << Debug::nospace << "," << textureCoordinates.size() << "and" << advances.size(), );
+    CORRADE_ASSERT(offset + quadPositions.size() <= glyphCount(),
+        "Text::AbstractLayouter::renderGlyphs(): glyphs from" << offset << "to" << offset + quadPositions.size() << "out of bounds for" << glyphCount() << "glyphs", );
+
+    /* Render the glyphs */
+    doRenderGlyphs(offset, quadPositions, textureCoordinates, advances);
+
+    /* Move the quads to cursor and extend the rectangle, same as in
+       renderGlyph() */
+    for(std::size_t i = 0; i != quadPositions.size(); ++i) {
+        Range2D& quadPosition = quadPositions[i];
+        quadPosition.bottomLeft() += cursorPosition;
+        quadPosition.topRight() += cursorPosition;
+
+        if(!rectangle.size().isZero()) {
+            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), quadPosition.bottomLeft());
+            rectangle.topRight() = Math::max(rectangle.topRight(), quadPosition.topRight());
+        } else rectangle = quadPosition;
+
+        cursorPosition += advances[i];
+    }
+}
+
+void AbstractLayouter::doRenderGlyphs(const UnsignedInt offset, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances) {
+    for(std::size_t i = 0; i != quadPositions.size(); ++i)
+        std::tie(quadPositions[i], textureCoordinates[i], advances[i]) = doRenderGlyph(offset + i);
+}
+
 }}
@@ -441,6 +441,24 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
          */
         Containers::Pointer<AbstractLayouter> layout(const AbstractGlyphCache& cache, Float size, const std::string& text);
 
+        /**
+         * @brief Layout the text, reusing an existing layouter
+         * @param cache     Glyph cache
+         * @param size      Font size
+         * @param text      Text to layout
+         * @param layouter  Layouter to reuse or replace
+         * @m_since_latest
+         *
+         * If @p layouter was created by this font and the font implements
+         * @ref doRelayout(), the layouter is filled with @p text in-place,
+         * reusing its internal storage. That makes repeated layouting of
+         * texts of similar length allocation-free. Otherwise, and also if
+         * @p layouter is @cpp nullptr @ce, a new layouter is created with
+         * @ref layout(const AbstractGlyphCache&, Float, const std::string&)
+         * and stored in @p layouter. Expects that a font is opened.
+         */
+        void layout(const AbstractGlyphCache& cache, Float size, Containers::StringView text, Containers::Pointer<AbstractLayouter>& layouter);
+
     protected:
         /**
          * @brief Font metrics
@@ -547,6 +565,19 @@ class MAGNUM_TEXT_EXPORT AbstractFont: public PluginManager::AbstractPlugin {
         /** @brief Implementation for @ref layout() */
         virtual Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) = 0;
 
+        /**
+         * @brief Implementation for @ref layout(const AbstractGlyphCache&, Float, Containers::StringView, Containers::Pointer<AbstractLayouter>&)
+         * @m_since_latest
+         *
+         * Called only with a @p layouter previously returned from
+         * @ref doLayout() of this font. The implementation is expected to
+         * refill it with @p text, update the glyph count using
+         * @ref AbstractLayouter::setGlyphCount() and return @cpp true @ce.
+         * Default implementation returns @cpp false @ce, in which case a new
+         * layouter is created with @ref doLayout() instead.
+         */
+        virtual bool doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache& cache, Float size, Containers::StringView text);
+
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
@@ -569,7 +600,10 @@ Returned by @ref AbstractFont::layout().
 
 Plugin creates private subclass (no need to expose it to end users) and
 implements @ref doRenderGlyph(). Bounds checking on @p i is done automatically
-in the wrapping @ref renderGlyph() function.
+in the wrapping @ref renderGlyph() function. It can additionally implement
+@ref doRenderGlyphs() to render a whole range of glyphs in a single call,
+avoiding a virtual call per glyph. Bounds and view size checking is done
+automatically in the wrapping @ref renderGlyphs() function.
 */
 class MAGNUM_TEXT_EXPORT AbstractLayouter {
     public:
@@ -602,6 +636,27 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         std::pair<Range2D, Range2D> renderGlyph(UnsignedInt i, Vector2& cursorPosition, Range2D& rectangle);
 
+        /**
+         * @brief Render a range of glyphs
+         * @param[in] offset                Index of the first glyph
+         * @param[in,out] cursorPosition    Cursor position
+         * @param[in,out] rectangle         Bounding rectangle
+         * @param[out] quadPositions        Quad positions
+         * @param[out] textureCoordinates   Quad texture coordinates
+         * @param[out] advances             Advances to next glyph
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref renderGlyph() for glyphs starting at
+         * @p offset, one for each element of the views, but with a single
+         * virtual call instead of one per glyph. Fills @p quadPositions,
+         * @p textureCoordinates and @p advances, advances
+         * @p cursorPosition past the last rendered glyph and updates
+         * @p rectangle with extended bounds. Expects that all views have the
+         * same size and @p offset plus the size is not larger than
+         * @ref glyphCount().
+         */
+        void renderGlyphs(UnsignedInt offset, Vector2& cursorPosition, Range2D& rectangle, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances);
+
     protected:
         /**
          * @brief Constructor
@@ -609,6 +664,15 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         explicit AbstractLayouter(UnsignedInt glyphCount);
 
+        /**
+         * @brief Set count of glyphs in laid out text
+         * @m_since_latest
+         *
+         * Meant to be called from @ref AbstractFont::doRelayout()
+         * implementations.
+         */
+        void setGlyphCount(UnsignedInt glyphCount) { _glyphCount = glyphCount; }
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     protected:
     #else
@@ -623,9 +687,28 @@ class MAGNUM_TEXT_EXPORT AbstractLayouter {
          */
         virtual std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) = 0;
 
+        /**
+         * @brief Implementation for @ref renderGlyphs()
+         * @param offset    Index of the first glyph
+         * @m_since_latest
+         *
+         * Fill quad positions (relative to cursor position of given glyph),
+         * texture coordinates and advances of glyphs starting at @p offset.
+         * The views are guaranteed to have the same size and
+         * @p offset plus the size is guaranteed to not be larger than
+         * @ref glyphCount(). Default implementation calls
+         * @ref doRenderGlyph() for each glyph.
+         */
+        virtual void doRenderGlyphs(UnsignedInt offset, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances);
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
+        /* Set by AbstractFont::layout() to know whether the layouter can be
+           reused */
+        friend AbstractFont;
+        const AbstractFont* _font{};
+
         UnsignedInt _glyphCount;
 };
 
@@ -25,14 +25,16 @@
 
 #include "AbstractGlyphCache.h"
 
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
 #include "Magnum/Image.h"
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
-#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
-AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _size{size}, _padding{padding} {
+AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& padding): _atlas{size, padding} {
     /* Default "Not Found" glyph. Can't do just `.insert({0, {}})` because
        that's ambiguous in C++17, due to a new insert(node_type&&) overload. */
     glyphs.insert({0, std::pair<Vector2i, Range2Di>{}});
@@ -41,14 +43,22 @@ AbstractGlyphCache::AbstractGlyphCache(const Vector2i& size, const Vector2i& pad
 AbstractGlyphCache::~AbstractGlyphCache() = default;
 
 std::vector<Range2Di> AbstractGlyphCache::reserve(const std::vector<Vector2i>& sizes) {
-    CORRADE_ASSERT((glyphs.size() == 1 && glyphs.at(0) == std::pair<Vector2i, Range2Di>()),
-        "Text::AbstractGlyphCache::reserve(): reserving space in non-empty cache is not yet implemented", {});
+    std::vector<Vector2i> offsets(sizes.size());
+    if(!_atlas.add(Containers::arrayView(sizes), Containers::arrayView(offsets))) {
+        Error{} << "Text::AbstractGlyphCache::reserve(): cache of size" << _atlas.size() << "is too small to fit" << sizes.size() << "more glyphs," << _atlas.freeArea() << "pixels left";
+        return {};
+    }
+
     glyphs.reserve(glyphs.size() + sizes.size());
-    return TextureTools::atlas(_size, sizes, _padding);
+    std::vector<Range2Di> out;
+    out.reserve(sizes.size());
+    for(std::size_t i = 0; i != sizes.size(); ++i)
+        out.push_back(Range2Di::fromSize(offsets[i], sizes[i]));
+    return out;
 }
 
 void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& position, const Range2Di& rectangle) {
-    const std::pair<Vector2i, Range2Di> glyphData = {position-_padding, rectangle.padded(_padding)};
+    const std::pair<Vector2i, Range2Di> glyphData = {position - _atlas.padding(), rectangle.padded(_atlas.padding())};
 
     /* Overwriting "Not Found" glyph */
     if(glyph == 0) glyphs[0] = glyphData;
@@ -58,8 +68,8 @@ void AbstractGlyphCache::insert(const UnsignedInt glyph, const Vector2i& positio
 }
 
 void AbstractGlyphCache::setImage(const Vector2i& offset, const ImageView2D& image) {
-    CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= _size).all(),
-        "Text::AbstractGlyphCache::setImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << _size, );
+    CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= _atlas.size()).all(),
+        "Text::AbstractGlyphCache::setImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << _atlas.size(), );
 
     doSetImage(offset, image);
 }
@@ -36,6 +36,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/visibility.h"
+#include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace Text {
 
@@ -94,10 +95,20 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         GlyphCacheFeatures features() const { return doFeatures(); }
 
         /** Glyph cache texture size */
-        Vector2i textureSize() const { return _size; }
+        Vector2i textureSize() const { return _atlas.size(); }
 
         /** @brief Glyph padding */
-        Vector2i padding() const { return _padding; }
+        Vector2i padding() const { return _atlas.padding(); }
+
+        /**
+         * @brief Atlas packer
+         * @m_since_latest
+         *
+         * Can be used to query how much space is left in the cache texture.
+         * @see @ref TextureTools::AtlasPacker::freeArea(),
+         *      @ref TextureTools::AtlasPacker::filledHeight()
+         */
+        const TextureTools::AtlasPacker& atlas() const { return _atlas; }
 
         /** @brief Count of glyphs in the cache */
         std::size_t glyphCount() const { return glyphs.size(); }
@@ -134,16 +145,18 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /**
          * @brief Layout glyphs with given sizes to the cache
          *
-         * Returns non-overlapping regions in cache texture to store glyphs.
-         * The reserved space is reused on next call to @ref reserve() if no
-         * glyph was stored there, use @ref insert() to store actual glyph on
-         * given position and @ref setImage() to upload glyph image.
-         *
-         * Glyph @p sizes are expected to be without padding.
+         * Returns non-overlapping regions in cache texture to store glyphs,
+         * use @ref insert() to store actual glyph on given position and
+         * @ref setImage() to upload glyph image. The regions are allocated
+         * using @ref TextureTools::AtlasPacker without touching glyphs
+         * reserved previously, so the cache can be filled incrementally, for
+         * example as new characters appear in rendered text. The reserved
+         * space stays occupied even if no glyph gets stored there.
          *
-         * @attention Cache size must be large enough to contain all rendered
-         *      glyphs.
-         * @see @ref padding()
+         * Glyph @p sizes are expected to be without padding. If the glyphs
+         * don't fit into the remaining space, a message is printed to
+         * @ref Error, an empty vector is returned and nothing is reserved.
+         * @see @ref padding(), @ref atlas()
          */
         std::vector<Range2Di> reserve(const std::vector<Vector2i>& sizes);
 
@@ -198,7 +211,7 @@ class MAGNUM_TEXT_EXPORT AbstractGlyphCache {
         /** @brief Implementation for @ref image() */
         virtual Image2D doImage();
 
-        Vector2i _size, _padding;
+        TextureTools::AtlasPacker _atlas;
         std::unordered_map<UnsignedInt, std::pair<Vector2i, Range2Di>> glyphs;
 };
 
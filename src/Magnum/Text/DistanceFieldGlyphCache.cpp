@@ -25,18 +25,55 @@
 
 #include "DistanceFieldGlyphCache.h"
 
+#include <Corrade/Containers/GrowableArray.h>
+
 #include "Magnum/ImageView.h"
+#include "Magnum/PixelStorage.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
-#ifndef CORRADE_NO_ASSERT
 #include "Magnum/GL/PixelFormat.h"
-#endif
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/TextureTools/DistanceField.h"
 
 namespace Magnum { namespace Text {
 
-DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, const UnsignedInt radius):
+namespace {
+
+bool uploadInput(GL::Texture2D& input, const Vector2i& offset, const ImageView2D& image, const char* const function) {
+    #ifndef CORRADE_NO_ASSERT
+    const GL::PixelFormat format = GL::pixelFormat(image.format());
+    #else
+    static_cast<void>(function);
+    #endif
+    #if !(defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2))
+    CORRADE_ASSERT(format == GL::PixelFormat::Red,
+        "Text::DistanceFieldGlyphCache::" << Debug::nospace << function << Debug::nospace << "(): expected"
+        << GL::PixelFormat::Red << "but got" << format, false);
+    input.setSubImage(0, offset, image);
+    #else
+    #ifndef MAGNUM_TARGET_WEBGL
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_rg>()) {
+        CORRADE_ASSERT(format == GL::PixelFormat::Red || format == GL::PixelFormat::Luminance,
+            "Text::DistanceFieldGlyphCache::" << Debug::nospace << function << Debug::nospace << "(): expected"
+            << GL::PixelFormat::Red << "but got" << format, false);
+        input.setSubImage(0, offset, ImageView2D{image.storage(), GL::PixelFormat::Red, GL::PixelType::UnsignedByte, image.size(), image.data()});
+    } else
+    #endif
+    {
+        CORRADE_ASSERT(format == GL::PixelFormat::Luminance,
+            "Text::DistanceFieldGlyphCache::" << Debug::nospace << function << Debug::nospace << "(): expected"
+            << GL::PixelFormat::Luminance << "but got" << format, false);
+        input.setSubImage(0, offset, image);
+    }
+    #endif
+
+    return true;
+}
+
+}
+
+DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, const UnsignedInt radius, const TextureTools::DistanceFieldAlgorithm algorithm):
     #if !(defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2))
     GlyphCache(GL::TextureFormat::R8, originalSize, size, Vector2i(radius)),
     #elif !defined(MAGNUM_TARGET_WEBGL)
@@ -46,7 +83,7 @@ DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, c
     #else
     GlyphCache(GL::TextureFormat::RGB, originalSize, size, Vector2i(radius)),
     #endif
-    _scale{Vector2(size)/Vector2(originalSize)}, _distanceField{radius}
+    _size{size}, _scale{Vector2(size)/Vector2(originalSize)}, _distanceField{radius, algorithm}
 {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::texture_rg);
@@ -57,41 +94,59 @@ DistanceFieldGlyphCache::DistanceFieldGlyphCache(const Vector2i& originalSize, c
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_rg>())
         Warning() << "Text::DistanceFieldGlyphCache:" << GL::Extensions::EXT::texture_rg::string() << "not supported, using inefficient RGB format for glyph cache texture";
     #endif
-}
 
-void DistanceFieldGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
-    GL::Texture2D input;
-    input.setWrapping(GL::SamplerWrapping::ClampToEdge)
+    /* Unscaled input that gets only partially updated in setImage() /
+       queueImage(). Zero-initialized so the areas not covered by any glyph
+       are treated as outside. */
+    _input.setWrapping(GL::SamplerWrapping::ClampToEdge)
         .setMinificationFilter(GL::SamplerFilter::Linear)
         .setMagnificationFilter(GL::SamplerFilter::Linear);
-
-    #ifndef CORRADE_NO_ASSERT
-    const GL::PixelFormat format = GL::pixelFormat(image.format());
-    #endif
+    Containers::Array<char> zeros{Containers::ValueInit, std::size_t(originalSize.product())};
+    const PixelStorage storage = PixelStorage{}.setAlignment(1);
     #if !(defined(MAGNUM_TARGET_GLES) && defined(MAGNUM_TARGET_GLES2))
-    CORRADE_ASSERT(format == GL::PixelFormat::Red,
-        "Text::DistanceFieldGlyphCache::setImage(): expected"
-        << GL::PixelFormat::Red << "but got" << format, );
-    input.setImage(0, GL::TextureFormat::R8, image);
+    _input.setImage(0, GL::TextureFormat::R8, ImageView2D{storage, GL::PixelFormat::Red, GL::PixelType::UnsignedByte, originalSize, zeros});
     #else
     #ifndef MAGNUM_TARGET_WEBGL
-    if(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_rg>()) {
-        CORRADE_ASSERT(format == GL::PixelFormat::Red || format == GL::PixelFormat::Luminance,
-            "Text::DistanceFieldGlyphCache::setImage(): expected"
-            << GL::PixelFormat::Red << "but got" << format, );
-        input.setImage(0, GL::TextureFormat::Red, ImageView2D{image.storage(), GL::PixelFormat::Red, GL::PixelType::UnsignedByte, image.size(), image.data()});
-    } else
+    if(GL::Context::current().isExtensionSupported<GL::Extensions::EXT::texture_rg>())
+        _input.setImage(0, GL::TextureFormat::Red, ImageView2D{storage, GL::PixelFormat::Red, GL::PixelType::UnsignedByte, originalSize, zeros});
+    else
     #endif
     {
-        CORRADE_ASSERT(format == GL::PixelFormat::Luminance,
-            "Text::DistanceFieldGlyphCache::setImage(): expected"
-            << GL::PixelFormat::Luminance << "but got" << format, );
-        input.setImage(0, GL::TextureFormat::Luminance, image);
+        _input.setImage(0, GL::TextureFormat::Luminance, ImageView2D{storage, GL::PixelFormat::Luminance, GL::PixelType::UnsignedByte, originalSize, zeros});
     }
     #endif
+}
+
+void DistanceFieldGlyphCache::doSetImage(const Vector2i& offset, const ImageView2D& image) {
+    if(!uploadInput(_input, offset, image, "setImage")) return;
+
+    /* Process this image together with everything that was queued before */
+    arrayAppend(_dirtyRectangles, Range2Di::fromSize(offset, image.size()));
+    flush();
+}
+
+void DistanceFieldGlyphCache::queueImage(const Vector2i& offset, const ImageView2D& image) {
+    CORRADE_ASSERT((offset >= Vector2i{} && offset + image.size() <= textureSize()).all(),
+        "Text::DistanceFieldGlyphCache::queueImage():" << Range2Di::fromSize(offset, image.size()) << "out of bounds for texture size" << textureSize(), );
+
+    if(!uploadInput(_input, offset, image, "queueImage")) return;
+
+    arrayAppend(_dirtyRectangles, Range2Di::fromSize(offset, image.size()));
+}
+
+void DistanceFieldGlyphCache::flush() {
+    if(_dirtyRectangles.empty()) return;
+
+    /* Convert the dirty rectangles to the output texture size, rounding
+       outwards so partially covered pixels are recalculated as well */
+    Containers::Array<Range2Di> outputRectangles{Containers::NoInit, _dirtyRectangles.size()};
+    for(std::size_t i = 0; i != _dirtyRectangles.size(); ++i)
+        outputRectangles[i] = {
+            Vector2i{Math::floor(Vector2(_dirtyRectangles[i].min())*_scale)},
+            Math::min(Vector2i{Math::ceil(Vector2(_dirtyRectangles[i].max())*_scale)}, _size)};
 
-    /* Create distance field from input texture */
-    _distanceField(input, texture(), Range2Di::fromSize(offset*_scale, image.size()*_scale), image.size());
+    _distanceField(_input, texture(), {{}, _size}, outputRectangles, textureSize());
+    _dirtyRectangles = {};
 }
 
 void DistanceFieldGlyphCache::setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image) {
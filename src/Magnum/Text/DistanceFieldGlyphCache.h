@@ -32,6 +32,8 @@
 #include "Magnum/configure.h"
 
 #ifdef MAGNUM_TARGET_GL
+#include <Corrade/Containers/Array.h>
+
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/TextureTools/DistanceField.h"
 
@@ -51,6 +53,18 @@ resulting distance field texture.
 
 @snippet MagnumText.cpp DistanceFieldGlyphCache-usage
 
+@section Text-DistanceFieldGlyphCache-incremental Incremental updates
+
+The cache keeps a copy of the unscaled binary input in a texture of
+@ref textureSize() and each @ref setImage() call uploads only the passed
+region to it and recalculates the distance field only in the corresponding
+region of @ref texture(). When inserting glyphs on demand, it's possible to
+upload several glyph images using @ref queueImage() and then process all of
+them at once using @ref flush(), which executes the distance field calculation
+just for the dirty regions in a single framebuffer pass:
+
+@snippet MagnumText.cpp DistanceFieldGlyphCache-incremental
+
 @note This class is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
     for more information.
@@ -64,6 +78,7 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          * @param originalSize      Unscaled glyph cache texture size
          * @param size              Actual glyph cache texture size
          * @param radius            Distance field computation radius
+         * @param algorithm         Distance field computation algorithm
          *
          * See @ref TextureTools::DistanceField for more information about the
          * parameters. Sets internal texture format to red channel only. On
@@ -74,7 +89,7 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          *      possible to convert the RGB texture to Luminance after it has
          *      been rendered when blitting is not supported to save memory?
          */
-        explicit DistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius);
+        explicit DistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius, TextureTools::DistanceFieldAlgorithm algorithm = TextureTools::DistanceFieldAlgorithm::BruteForce);
 
         /**
          * @brief Set distance field cache image
@@ -84,11 +99,48 @@ class MAGNUM_TEXT_EXPORT DistanceFieldGlyphCache: public GlyphCache {
          */
         void setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image);
 
+        /**
+         * @brief Queue an image for distance field processing
+         * @m_since_latest
+         *
+         * Uploads the binary @p image to given @p offset in the unscaled
+         * input texture and records the area as dirty, but doesn't calculate
+         * the distance field yet --- call @ref flush() to process all queued
+         * images at once. Expects the same format as @ref setImage() and
+         * that the image fits into @ref textureSize().
+         * @see @ref dirtyRectangles()
+         */
+        void queueImage(const Vector2i& offset, const ImageView2D& image);
+
+        /**
+         * @brief Regions waiting for distance field processing
+         * @m_since_latest
+         *
+         * Rectangles in the unscaled @ref textureSize() coordinates added by
+         * @ref queueImage() since the last @ref flush().
+         */
+        Containers::ArrayView<const Range2Di> dirtyRectangles() const { return _dirtyRectangles; }
+
+        /**
+         * @brief Process all queued images
+         * @m_since_latest
+         *
+         * Calculates the distance field for all @ref dirtyRectangles() in a
+         * single pass and clears the list. Areas of @ref texture() outside
+         * of the dirty rectangles are left untouched. If there's nothing
+         * queued, the function is a no-op.
+         * @see @ref TextureTools::DistanceField::operator()(GL::Texture2D&, GL::Texture2D&, const Range2Di&, Containers::ArrayView<const Range2Di>, const Vector2i&)
+         */
+        void flush();
+
     private:
         void doSetImage(const Vector2i& offset, const ImageView2D& image) override;
 
+        Vector2i _size;
         Vector2 _scale;
         TextureTools::DistanceField _distanceField;
+        GL::Texture2D _input;
+        Containers::Array<Range2Di> _dirtyRectangles;
 };
 
 }}
@@ -0,0 +1,208 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "LayoutCache.h"
+
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/MurmurHash2.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/Alignment.h"
+
+namespace Magnum { namespace Text {
+
+namespace {
+
+struct Entry {
+    const AbstractFont* font;
+    const AbstractGlyphCache* cache;
+    Float size;
+    Alignment alignment;
+    std::size_t hash;
+    std::string text;
+    Range2D rectangle;
+    /* Positions of all vertices followed by texture coordinates of all
+       vertices */
+    Containers::Array<Vector2> vertices;
+};
+
+std::size_t memoryCost(const std::size_t textSize, const std::size_t vertexCount) {
+    return sizeof(Entry) + textSize + vertexCount*2*sizeof(Vector2);
+}
+
+}
+
+struct LayoutCache::State {
+    std::size_t memoryLimit, memoryUsage{};
+    UnsignedLong hitCount{}, missCount{};
+    /* Most recently used first */
+    std::list<Entry> entries;
+    std::unordered_multimap<std::size_t, std::list<Entry>::iterator> lookup;
+    Containers::Pointer<AbstractLayouter> layouter;
+
+    std::size_t hash(const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Containers::StringView text, Alignment alignment) const;
+    std::list<Entry>::iterator find(const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Containers::StringView text, Alignment alignment, std::size_t hash);
+    void erase(std::list<Entry>::iterator it);
+};
+
+std::size_t LayoutCache::State::hash(const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment) const {
+    std::size_t hash;
+    std::memcpy(&hash, Utility::MurmurHash2{}(text.data(), text.size()).byteArray(), sizeof(std::size_t));
+
+    /* Mix in the rest of the key, boost::hash_combine style */
+    UnsignedInt sizeBits;
+    std::memcpy(&sizeBits, &size, sizeof(Float));
+    for(const std::size_t value: {reinterpret_cast<std::size_t>(&font), reinterpret_cast<std::size_t>(&cache), std::size_t(sizeBits), std::size_t(alignment)})
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+std::list<Entry>::iterator LayoutCache::State::find(const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment, const std::size_t hash) {
+    const auto range = lookup.equal_range(hash);
+    for(auto it = range.first; it != range.second; ++it) {
+        const Entry& entry = *it->second;
+        if(entry.font == &font && entry.cache == &cache && entry.size == size && entry.alignment == alignment && Containers::StringView{entry.text} == text)
+            return it->second;
+    }
+
+    return entries.end();
+}
+
+void LayoutCache::State::erase(const std::list<Entry>::iterator it) {
+    const auto range = lookup.equal_range(it->hash);
+    for(auto i = range.first; i != range.second; ++i) if(i->second == it) {
+        lookup.erase(i);
+        break;
+    }
+
+    memoryUsage -= memoryCost(it->text.size(), it->vertices.size()/2);
+    entries.erase(it);
+}
+
+LayoutCache::LayoutCache(const std::size_t memoryLimit): _state{Containers::InPlaceInit} {
+    CORRADE_ASSERT(memoryLimit,
+        "Text::LayoutCache: memory limit can't be zero", );
+    _state->memoryLimit = memoryLimit;
+}
+
+LayoutCache::LayoutCache(LayoutCache&&) noexcept = default;
+
+LayoutCache::~LayoutCache() = default;
+
+LayoutCache& LayoutCache::operator=(LayoutCache&&) noexcept = default;
+
+std::size_t LayoutCache::memoryLimit() const { return _state->memoryLimit; }
+
+std::size_t LayoutCache::memoryUsage() const { return _state->memoryUsage; }
+
+std::size_t LayoutCache::size() const { return _state->entries.size(); }
+
+UnsignedLong LayoutCache::hitCount() const { return _state->hitCount; }
+
+UnsignedLong LayoutCache::missCount() const { return _state->missCount; }
+
+void LayoutCache::resetCounters() {
+    _state->hitCount = 0;
+    _state->missCount = 0;
+}
+
+void LayoutCache::clear() {
+    _state->entries.clear();
+    _state->lookup.clear();
+    _state->memoryUsage = 0;
+}
+
+Containers::Pointer<AbstractLayouter>& LayoutCache::layouter() {
+    return _state->layouter;
+}
+
+Containers::Optional<std::pair<UnsignedInt, Range2D>> LayoutCache::find(const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates) {
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::LayoutCache::find(): expected positions and texture coordinates to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), {});
+
+    State& state = *_state;
+    const auto found = state.find(font, cache, size, text, alignment, state.hash(font, cache, size, text, alignment));
+    if(found == state.entries.end()) {
+        ++state.missCount;
+        return {};
+    }
+
+    /* Mark as most recently used. Splicing doesn't invalidate the iterators
+       stored in the lookup table. */
+    state.entries.splice(state.entries.begin(), state.entries, found);
+    ++state.hitCount;
+
+    /* Copy only what fits, same as renderInto() */
+    const std::size_t vertexCount = found->vertices.size()/2;
+    for(std::size_t i = 0, iMax = Math::min(vertexCount, positions.size()); i != iMax; ++i) {
+        positions[i] = found->vertices[i];
+        textureCoordinates[i] = found->vertices[vertexCount + i];
+    }
+
+    return std::make_pair(UnsignedInt(vertexCount/4), found->rectangle);
+}
+
+void LayoutCache::insert(const AbstractFont& font, const AbstractGlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment, const Containers::StridedArrayView1D<const Vector2>& positions, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Range2D& rectangle) {
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::LayoutCache::insert(): expected positions and texture coordinates to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), );
+    CORRADE_ASSERT(positions.size() % 4 == 0,
+        "Text::LayoutCache::insert(): expected vertex count to be divisible by four, got" << positions.size(), );
+
+    State& state = *_state;
+    const std::size_t hash = state.hash(font, cache, size, text, alignment);
+
+    /* Replace an existing entry */
+    const auto found = state.find(font, cache, size, text, alignment, hash);
+    if(found != state.entries.end()) state.erase(found);
+
+    /* Don't evict everything for a layout that won't fit anyway */
+    const std::size_t cost = memoryCost(text.size(), positions.size());
+    if(cost > state.memoryLimit) return;
+
+    /* Evict least recently used entries until the new one fits */
+    while(state.memoryUsage + cost > state.memoryLimit)
+        state.erase(std::prev(state.entries.end()));
+
+    Containers::Array<Vector2> vertices{Containers::NoInit, positions.size()*2};
+    for(std::size_t i = 0; i != positions.size(); ++i) {
+        vertices[i] = positions[i];
+        vertices[positions.size() + i] = textureCoordinates[i];
+    }
+
+    state.entries.push_front(Entry{&font, &cache, size, alignment, hash, std::string{text.data(), text.size()}, rectangle, std::move(vertices)});
+    state.lookup.emplace(hash, state.entries.begin());
+    state.memoryUsage += cost;
+}
+
+}}
@@ -0,0 +1,205 @@
+#ifndef Magnum_Text_LayoutCache_h
+#define Magnum_Text_LayoutCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::LayoutCache
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Text/Text.h"
+#include "Magnum/Text/visibility.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Least-recently-used cache of text layouts
+@m_since_latest
+
+Stores glyph quads, i.e. vertex positions and texture coordinates, of
+already laid out texts, keyed by the font, glyph cache, font size, alignment
+and the text itself. When the same text is rendered again, the quads are
+copied from the cache instead of calling
+@ref AbstractFont::layout() and @ref AbstractLayouter::renderGlyph() for
+each glyph again. That's useful especially for UIs with many repeated
+strings such as labels or item names.
+
+The cache is used by passing it to
+@ref AbstractRenderer::renderInto(AbstractFont&, const GlyphCache&, Float, Containers::StringView, const Containers::StridedArrayView1D<Vector2>&, const Containers::StridedArrayView1D<Vector2>&, LayoutCache&, Alignment),
+@ref AbstractRenderer::setLayoutCache() or
+@ref BatchRenderer::setLayoutCache(); it can be shared among any number of
+renderers:
+
+@snippet MagnumText.cpp LayoutCache-usage
+
+The total size of stored layouts is limited by a memory limit passed to the
+constructor. Once a new layout doesn't fit, the least recently used layouts
+are evicted. Layouts larger than the whole limit are not cached at all.
+Cache hits and misses are counted in @ref hitCount() and @ref missCount() to
+help with tuning the limit.
+
+@section Text-LayoutCache-invalidation Invalidation
+
+The font and glyph cache are identified only by their address, and the
+cached texture coordinates depend on where the glyphs are in the glyph cache.
+Thus, if a font or a glyph cache is destroyed or if the glyph cache is
+refilled, the layout cache has to be emptied with @ref clear().
+*/
+class MAGNUM_TEXT_EXPORT LayoutCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param memoryLimit   Memory limit in bytes
+         *
+         * Expects that @p memoryLimit is non-zero.
+         */
+        explicit LayoutCache(std::size_t memoryLimit);
+
+        /** @brief Copying is not allowed */
+        LayoutCache(const LayoutCache&) = delete;
+
+        /** @brief Move constructor */
+        LayoutCache(LayoutCache&&) noexcept;
+
+        ~LayoutCache();
+
+        /** @brief Copying is not allowed */
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        /** @brief Move assignment */
+        LayoutCache& operator=(LayoutCache&&) noexcept;
+
+        /** @brief Memory limit in bytes */
+        std::size_t memoryLimit() const;
+
+        /**
+         * @brief Memory used by the cached layouts in bytes
+         *
+         * Includes the glyph quads, a copy of the text and a bookkeeping
+         * overhead for each layout. Never larger than @ref memoryLimit().
+         */
+        std::size_t memoryUsage() const;
+
+        /** @brief Count of cached layouts */
+        std::size_t size() const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Incremented on every successful @ref find().
+         * @see @ref resetCounters()
+         */
+        UnsignedLong hitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Incremented on every unsuccessful @ref find().
+         * @see @ref resetCounters()
+         */
+        UnsignedLong missCount() const;
+
+        /**
+         * @brief Reset the hit and miss counters
+         *
+         * Doesn't affect the cached layouts.
+         */
+        void resetCounters();
+
+        /**
+         * @brief Clear the cache
+         *
+         * Removes all cached layouts, the hit and miss counters stay
+         * unchanged. Has to be called when a font or a glyph cache is
+         * destroyed or changes, see @ref Text-LayoutCache-invalidation for
+         * more information.
+         */
+        void clear();
+
+        /**
+         * @brief Layouter used for laying out texts that aren't cached
+         *
+         * Used by the renderers on cache misses, so if the font supports
+         * @ref AbstractFont::layout(const AbstractGlyphCache&, Float, Containers::StringView, Containers::Pointer<AbstractLayouter>&) "layouter reuse",
+         * the misses don't allocate a new layouter either.
+         */
+        Containers::Pointer<AbstractLayouter>& layouter();
+
+        /**
+         * @brief Find a cached layout
+         * @param font                  Font
+         * @param cache                 Glyph cache
+         * @param size                  Font size
+         * @param text                  Text
+         * @param alignment             Text alignment
+         * @param positions             Where to put vertex positions
+         * @param textureCoordinates    Where to put texture coordinates
+         * @return Count of glyphs and rectangle spanning the text if found,
+         *      @ref Containers::NullOpt otherwise
+         *
+         * If the layout is found, copies its vertices to @p positions and
+         * @p textureCoordinates, marks it as most recently used and
+         * increments @ref hitCount(). Same as with
+         * @ref AbstractRenderer::renderInto(), only vertices that fit are
+         * copied. Otherwise increments @ref missCount(). Expects that both
+         * views have the same size.
+         */
+        Containers::Optional<std::pair<UnsignedInt, Range2D>> find(const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Containers::StringView text, Alignment alignment, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates);
+
+        /**
+         * @brief Insert a layout
+         * @param font                  Font
+         * @param cache                 Glyph cache
+         * @param size                  Font size
+         * @param text                  Text
+         * @param alignment             Text alignment
+         * @param positions             Vertex positions
+         * @param textureCoordinates    Texture coordinates
+         * @param rectangle             Rectangle spanning the text
+         *
+         * Copies the vertices and the text into the cache as the most
+         * recently used layout, replacing a layout with the same key if
+         * present and evicting least recently used layouts until it fits
+         * into @ref memoryLimit(). If the layout alone is larger than the
+         * limit, nothing is inserted. Expects that both views have the same
+         * size, divisible by four.
+         */
+        void insert(const AbstractFont& font, const AbstractGlyphCache& cache, Float size, Containers::StringView text, Alignment alignment, const Containers::StridedArrayView1D<const Vector2>& positions, const Containers::StridedArrayView1D<const Vector2>& textureCoordinates, const Range2D& rectangle);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+#define Magnum_Text_MultiChannelDistanceFieldGlyphCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Text::MultiChannelDistanceFieldGlyphCache
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include "Magnum/Text/GlyphCache.h"
+
+namespace Magnum { namespace Text {
+
+/**
+@brief Glyph cache with multi-channel distance field rendering
+@m_since_latest
+
+Similar to @ref DistanceFieldGlyphCache, but converts each binary glyph
+image to a multi-channel distance field using
+@ref TextureTools::multiChannelDistanceField(). Unlike a single-channel
+distance field, it keeps sharp glyph corners sharp, so the same quality can be
+achieved with a two to four times smaller texture, saving both memory and
+bandwidth. The internal texture format is RGB. Render the text with
+@ref Shaders::DistanceFieldVector with
+@ref Shaders::DistanceFieldVector::Flag::MultiChannel enabled.
+
+@section Text-MultiChannelDistanceFieldGlyphCache-usage Usage
+
+Usage is the same as with @ref DistanceFieldGlyphCache, the actual texture
+size can be however smaller:
+
+@snippet MagnumText.cpp MultiChannelDistanceFieldGlyphCache-usage
+
+The distance field is calculated on the CPU, optionally on multiple threads.
+As the glyph outlines are reconstructed from the rasterized glyphs, the
+original size should be several times larger than the actual size, see
+@ref TextureTools-multiChannelDistanceFieldInto-algorithm for details.
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+*/
+class MAGNUM_TEXT_EXPORT MultiChannelDistanceFieldGlyphCache: public GlyphCache {
+    public:
+        /**
+         * @brief Constructor
+         * @param originalSize      Unscaled glyph cache texture size
+         * @param size              Actual glyph cache texture size
+         * @param radius            Distance field computation radius
+         * @param threadCount       Count of threads to use for the
+         *      distance field computation. If @cpp 0 @ce, the value of
+         *      @ref std::thread::hardware_concurrency() is used.
+         *
+         * See @ref TextureTools::multiChannelDistanceFieldInto() for more
+         * information about the parameters. Sets internal texture format to
+         * @ref GL::TextureFormat::RGB8, on OpenGL ES 2.0 and WebGL 1.0 to
+         * @ref GL::TextureFormat::RGB.
+         */
+        explicit MultiChannelDistanceFieldGlyphCache(const Vector2i& originalSize, const Vector2i& size, UnsignedInt radius, UnsignedInt threadCount = 1);
+
+        /** @brief Distance field computation radius */
+        UnsignedInt radius() const { return _radius; }
+
+        /**
+         * @brief Set multi-channel distance field cache image
+         *
+         * Uploads already computed multi-channel distance field image to
+         * given offset in distance field texture. Expects that the image is
+         * in @ref PixelFormat::RGB8Unorm.
+         */
+        void setDistanceFieldImage(const Vector2i& offset, const ImageView2D& image);
+
+    private:
+        void doSetImage(const Vector2i& offset, const ImageView2D& image) override;
+
+        Vector2 _scale;
+        UnsignedInt _radius, _threadCount;
+};
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
@@ -25,8 +25,11 @@
 
 #include "Renderer.h"
 
+#include <cstring>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 
 #include "Magnum/Mesh.h"
 #include "Magnum/GL/Context.h"
@@ -34,8 +37,14 @@
 #include "Magnum/GL/Mesh.h"
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Shaders/AbstractVector.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Shaders/Generic.h"
+#include "Magnum/Shaders/Vector.h"
+#endif
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/GlyphCache.h"
+#include "Magnum/Text/LayoutCache.h"
 
 namespace Magnum { namespace Text {
 
@@ -65,98 +74,119 @@ struct Vertex {
     Vector2 position, textureCoordinates;
 };
 
-std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const std::string& text, const Alignment alignment) {
-    /* Output data, reserve memory as when the text would be ASCII-only. In
-       reality the actual vertex count will be smaller, but allocating more at
-       once is better than reallocating many times later. */
-    std::vector<Vertex> vertices;
-    vertices.reserve(text.size()*4);
+#ifndef MAGNUM_TARGET_GLES2
+struct BatchVertex {
+    Vector2 position, textureCoordinates;
+    UnsignedInt drawId;
+};
 
-    /* Total rendered bounds, intial line position, line increment, last+1
-       vertex on previous line */
+template<UnsignedInt> struct BatchTraits;
+template<> struct BatchTraits<2> {
+    typedef Shaders::TransformationProjectionUniform2D TransformationProjectionUniform;
+};
+template<> struct BatchTraits<3> {
+    typedef Shaders::TransformationProjectionUniform3D TransformationProjectionUniform;
+};
+#endif
+
+/* Count of glyphs rendered with a single AbstractLayouter::renderGlyphs()
+   call. The per-glyph data are in a stack buffer so the layout doesn't
+   allocate. */
+constexpr UnsignedInt GlyphBatchSize = 32;
+
+/* Lays out the text into given views. Returns the total count of glyphs,
+   which may be larger than what fits into the views. In that case only the
+   glyphs that fit are written and the caller is expected to fail. */
+std::pair<UnsignedInt, Range2D> renderVerticesInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment, Containers::Pointer<AbstractLayouter>& layouter, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates) {
+    const std::size_t vertexCapacity = positions.size();
+
+    /* Total rendered bounds, intial line position, line increment, vertex
+       count, last+1 vertex on previous line */
     Range2D rectangle;
     Vector2 linePosition;
     const Vector2 lineAdvance = Vector2::yAxis(font.lineHeight()*size/font.size());
+    std::size_t vertexCount = 0;
     std::size_t lastLineLastVertex = 0;
 
-    /* Temp buffer so we don't allocate for each new line */
-    /**
-     * @todo C++1z: use std::string_view to avoid the one allocation and all
-     *      the copying altogether
-     */
-    std::string line;
-    line.reserve(text.size());
-
     /* Render each line separately and align it horizontally */
-    std::size_t pos, prevPos = 0;
-    do {
-        /* Empty line, nothing to do (the rest is done below in while expression) */
-        if((pos = text.find('\n', prevPos)) == prevPos) continue;
-
-        /* Copy the line into the temp buffer */
-        line.assign(text, prevPos, pos-prevPos);
-
-        /* Layout the line */
-        Containers::Pointer<AbstractLayouter> layouter = font.layout(cache, size, line);
-
-        /* Verify that we don't reallocate anything. The only problem might
-           arise when the layouter decides to compose one character from more
-           than one glyph (i.e. accents). Will remove the assert when this
-           issue arises. */
-        CORRADE_INTERNAL_ASSERT(vertices.size() + layouter->glyphCount()*4 <= vertices.capacity());
-
-        /* Bounds of rendered line */
-        Range2D lineRectangle;
-
-        /* Render all glyphs */
-        Vector2 cursorPosition(linePosition);
-        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
-            Range2D quadPosition, textureCoordinates;
-            std::tie(quadPosition, textureCoordinates) = layouter->renderGlyph(i, cursorPosition, lineRectangle);
-
-            /* 0---2
-               |   |
-               |   |
-               |   |
-               1---3 */
-
-            vertices.insert(vertices.end(), {
-                {quadPosition.topLeft(), textureCoordinates.topLeft()},
-                {quadPosition.bottomLeft(), textureCoordinates.bottomLeft()},
-                {quadPosition.topRight(), textureCoordinates.topRight()},
-                {quadPosition.bottomRight(), textureCoordinates.bottomRight()}
-            });
+    const char* const end = text.data() + text.size();
+    const char* lineBegin = text.data();
+    for(;;) {
+        const char* lineEnd = lineBegin;
+        while(lineEnd != end && *lineEnd != '\n') ++lineEnd;
+
+        /* Empty line, nothing to do except moving to the next one */
+        if(lineEnd != lineBegin) {
+            /* Layout the line, reusing the layouter if possible */
+            font.layout(cache, size, Containers::StringView{lineBegin, std::size_t(lineEnd - lineBegin)}, layouter);
+
+            /* Bounds of rendered line */
+            Range2D lineRectangle;
+
+            /* Render the glyphs in batches, without allocating */
+            Vector2 cursorPosition(linePosition);
+            Range2D quadPositions[GlyphBatchSize];
+            Range2D quadTextureCoordinates[GlyphBatchSize];
+            Vector2 advances[GlyphBatchSize];
+            for(UnsignedInt offset = 0; offset < layouter->glyphCount(); offset += GlyphBatchSize) {
+                const UnsignedInt batchSize = Math::min(layouter->glyphCount() - offset, GlyphBatchSize);
+                layouter->renderGlyphs(offset, cursorPosition, lineRectangle,
+                    Containers::arrayView(quadPositions).prefix(batchSize),
+                    Containers::arrayView(quadTextureCoordinates).prefix(batchSize),
+                    Containers::arrayView(advances).prefix(batchSize));
+
+                for(UnsignedInt i = 0; i != batchSize; ++i, vertexCount += 4) {
+                    /* Just count the glyphs that don't fit anymore */
+                    if(vertexCount + 4 > vertexCapacity) continue;
+
+                    /* 0---2
+                       |   |
+                       |   |
+                       |   |
+                       1---3 */
+
+                    positions[vertexCount + 0] = quadPositions[i].topLeft();
+                    positions[vertexCount + 1] = quadPositions[i].bottomLeft();
+                    positions[vertexCount + 2] = quadPositions[i].topRight();
+                    positions[vertexCount + 3] = quadPositions[i].bottomRight();
+                    textureCoordinates[vertexCount + 0] = quadTextureCoordinates[i].topLeft();
+                    textureCoordinates[vertexCount + 1] = quadTextureCoordinates[i].bottomLeft();
+                    textureCoordinates[vertexCount + 2] = quadTextureCoordinates[i].topRight();
+                    textureCoordinates[vertexCount + 3] = quadTextureCoordinates[i].bottomRight();
+                }
+            }
+
+            /** @todo What about top-down text? */
+
+            /* Horizontally align the rendered line */
+            Float alignmentOffsetX = 0.0f;
+            if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
+                alignmentOffsetX = -lineRectangle.centerX();
+            else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
+                alignmentOffsetX = -lineRectangle.right();
+
+            /* Integer alignment */
+            if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
+                alignmentOffsetX = Math::round(alignmentOffsetX);
+
+            /* Align positions and bounds on current line */
+            lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
+            for(std::size_t i = lastLineLastVertex, iMax = Math::min(vertexCount, vertexCapacity); i < iMax; ++i)
+                positions[i].x() += alignmentOffsetX;
+
+            /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
+            if(!rectangle.size().isZero()) {
+                rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
+                rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
+            } else rectangle = lineRectangle;
         }
 
-        /** @todo What about top-down text? */
-
-        /* Horizontally align the rendered line */
-        Float alignmentOffsetX = 0.0f;
-        if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentCenter)
-            alignmentOffsetX = -lineRectangle.centerX();
-        else if((UnsignedByte(alignment) & Implementation::AlignmentHorizontal) == Implementation::AlignmentRight)
-            alignmentOffsetX = -lineRectangle.right();
-
-        /* Integer alignment */
-        if(UnsignedByte(alignment) & Implementation::AlignmentIntegral)
-            alignmentOffsetX = Math::round(alignmentOffsetX);
-
-        /* Align positions and bounds on current line */
-        lineRectangle = lineRectangle.translated(Vector2::xAxis(alignmentOffsetX));
-        for(auto it = vertices.begin()+lastLineLastVertex; it != vertices.end(); ++it)
-            it->position.x() += alignmentOffsetX;
-
-        /* Add final line bounds to total bounds, similarly to AbstractFont::renderGlyph() */
-        if(!rectangle.size().isZero()) {
-            rectangle.bottomLeft() = Math::min(rectangle.bottomLeft(), lineRectangle.bottomLeft());
-            rectangle.topRight() = Math::max(rectangle.topRight(), lineRectangle.topRight());
-        } else rectangle = lineRectangle;
-
-    /* Move to next line */
-    } while(prevPos = pos+1,
-            linePosition -= lineAdvance,
-            lastLineLastVertex = vertices.size(),
-            pos != std::string::npos);
+        /* Move to next line */
+        if(lineEnd == end) break;
+        lineBegin = lineEnd + 1;
+        linePosition -= lineAdvance;
+        lastLineLastVertex = vertexCount;
+    }
 
     /* Vertically align the rendered text */
     Float alignmentOffsetY = 0.0f;
@@ -171,9 +201,46 @@ std::tuple<std::vector<Vertex>, Range2D> renderVerticesInternal(AbstractFont& fo
 
     /* Align positions and bounds */
     rectangle = rectangle.translated(Vector2::yAxis(alignmentOffsetY));
-    for(auto& v: vertices) v.position.y() += alignmentOffsetY;
+    for(std::size_t i = 0, iMax = Math::min(vertexCount, vertexCapacity); i < iMax; ++i)
+        positions[i].y() += alignmentOffsetY;
 
-    return std::make_tuple(std::move(vertices), rectangle);
+    return {UnsignedInt(vertexCount/4), rectangle};
+}
+
+/* Same as above, but looking up the text in the layout cache first if there's
+   any. On a miss the layout cache layouter is used and the result is put
+   into the cache, if it fit. */
+std::pair<UnsignedInt, Range2D> renderVerticesCachedInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment, Containers::Pointer<AbstractLayouter>& layouter, LayoutCache* const layoutCache, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates) {
+    if(!layoutCache)
+        return renderVerticesInto(font, cache, size, text, alignment, layouter, positions, textureCoordinates);
+
+    if(const Containers::Optional<std::pair<UnsignedInt, Range2D>> found = layoutCache->find(font, cache, size, text, alignment, positions, textureCoordinates))
+        return *found;
+
+    const std::pair<UnsignedInt, Range2D> out = renderVerticesInto(font, cache, size, text, alignment, layoutCache->layouter(), positions, textureCoordinates);
+    if(out.first*4 <= positions.size())
+        layoutCache->insert(font, cache, size, text, alignment, positions.prefix(out.first*4), textureCoordinates.prefix(out.first*4), out.second);
+    return out;
+}
+
+/* Reserves memory as when the text would be ASCII-only. In reality the actual
+   vertex count will be smaller, but allocating more at once is better than
+   reallocating many times later. */
+std::tuple<Containers::Array<Vertex>, UnsignedInt, Range2D> renderVerticesInternal(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Alignment alignment) {
+    Containers::Array<Vertex> vertices{text.size()*4};
+    Containers::Pointer<AbstractLayouter> layouter;
+    UnsignedInt glyphCount;
+    Range2D rectangle;
+    std::tie(glyphCount, rectangle) = renderVerticesInto(font, cache, size, text, alignment, layouter, Containers::stridedArrayView(vertices).slice(&Vertex::position), Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates));
+
+    /* The only problem might arise when the layouter decides to compose one
+       character from more than one glyph (i.e. accents). Will remove the
+       assert when this issue arises. */
+    CORRADE_INTERNAL_ASSERT(glyphCount*4 <= vertices.size());
+
+    /* Not shrinking the array to the actual size as the data get copied
+       elsewhere anyway */
+    return std::make_tuple(std::move(vertices), glyphCount, rectangle);
 }
 
 std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const UnsignedInt glyphCount) {
@@ -199,15 +266,15 @@ std::pair<Containers::Array<char>, MeshIndexType> renderIndicesInternal(const Un
     return {std::move(indices), indexType};
 }
 
-std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
+std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCache& cache, Float size, const Containers::StringView text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
     /* Render vertices and upload them */
-    std::vector<Vertex> vertices;
+    Containers::Array<Vertex> vertices;
+    UnsignedInt glyphCount;
     Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
-    vertexBuffer.setData(vertices, usage);
-
-    const UnsignedInt glyphCount = vertices.size()/4;
+    std::tie(vertices, glyphCount, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
+    const UnsignedInt vertexCount = glyphCount*4;
     const UnsignedInt indexCount = glyphCount*6;
+    vertexBuffer.setData(vertices.prefix(vertexCount), usage);
 
     /* Render indices and upload them */
     Containers::Array<char> indices;
@@ -220,37 +287,58 @@ std::tuple<GL::Mesh, Range2D> renderInternal(AbstractFont& font, const GlyphCach
     GL::Mesh mesh;
     mesh.setPrimitive(MeshPrimitive::Triangles)
         .setCount(indexCount)
-        .setIndexBuffer(indexBuffer, 0, indexType, 0, vertices.size());
+        .setIndexBuffer(indexBuffer, 0, indexType, 0, vertexCount);
 
     return std::make_tuple(std::move(mesh), rectangle);
 }
 
 }
 
-std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment) {
-    /* Render vertices */
-    std::vector<Vertex> vertices;
+std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> AbstractRenderer::render(AbstractFont& font, const GlyphCache& cache, Float size, const Containers::StringView text, Alignment alignment) {
+    /* Render vertices directly into the output, reserving memory as when the
+       text would be ASCII-only */
+    std::vector<Vector2> positions(text.size()*4), textureCoordinates(text.size()*4);
+    Containers::Pointer<AbstractLayouter> layouter;
+    UnsignedInt glyphCount;
     Range2D rectangle;
-    std::tie(vertices, rectangle) = renderVerticesInternal(font, cache, size, text, alignment);
-
-    /* Deinterleave the vertices */
-    std::vector<Vector2> positions, textureCoordinates;
-    positions.reserve(vertices.size());
-    positions.reserve(textureCoordinates.size());
-    for(const auto& v: vertices) {
-        positions.push_back(v.position);
-        textureCoordinates.push_back(v.textureCoordinates);
-    }
+    std::tie(glyphCount, rectangle) = renderVerticesInto(font, cache, size, text, alignment, layouter, Containers::arrayView(positions), Containers::arrayView(textureCoordinates));
+    CORRADE_INTERNAL_ASSERT(glyphCount*4 <= positions.size());
+    positions.resize(glyphCount*4);
+    textureCoordinates.resize(glyphCount*4);
 
     /* Render indices */
-    const UnsignedInt glyphCount = vertices.size()/4;
     std::vector<UnsignedInt> indices(glyphCount*6);
     createIndices<UnsignedInt>(indices.data(), glyphCount);
 
     return std::make_tuple(std::move(positions), std::move(textureCoordinates), std::move(indices), rectangle);
 }
 
-template<UnsignedInt dimensions> std::tuple<GL::Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
+std::pair<UnsignedInt, Range2D> AbstractRenderer::renderInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, Containers::Pointer<AbstractLayouter>& layouter, const Alignment alignment) {
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::Renderer::renderInto(): expected positions and texture coordinates to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), {});
+
+    const std::pair<UnsignedInt, Range2D> out = renderVerticesInto(font, cache, size, text, alignment, layouter, positions, textureCoordinates);
+    CORRADE_ASSERT(out.first*4 <= positions.size(),
+        "Text::Renderer::renderInto(): expected space for at least" << out.first*4 << "vertices but got" << positions.size(), {});
+    return out;
+}
+
+std::pair<UnsignedInt, Range2D> AbstractRenderer::renderInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, LayoutCache& layoutCache, const Alignment alignment) {
+    CORRADE_ASSERT(positions.size() == textureCoordinates.size(),
+        "Text::Renderer::renderInto(): expected positions and texture coordinates to have the same size, got" << positions.size() << "and" << textureCoordinates.size(), {});
+
+    const std::pair<UnsignedInt, Range2D> out = renderVerticesCachedInto(font, cache, size, text, alignment, layoutCache.layouter(), &layoutCache, positions, textureCoordinates);
+    CORRADE_ASSERT(out.first*4 <= positions.size(),
+        "Text::Renderer::renderInto(): expected space for at least" << out.first*4 << "vertices but got" << positions.size(), {});
+    return out;
+}
+
+std::pair<UnsignedInt, Range2D> AbstractRenderer::renderInto(AbstractFont& font, const GlyphCache& cache, const Float size, const Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, const Alignment alignment) {
+    Containers::Pointer<AbstractLayouter> layouter;
+    return renderInto(font, cache, size, text, positions, textureCoordinates, layouter, alignment);
+}
+
+template<UnsignedInt dimensions> std::tuple<GL::Mesh, Range2D> Renderer<dimensions>::render(AbstractFont& font, const GlyphCache& cache, Float size, const Containers::StringView text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment) {
     /* Finalize mesh configuration and return the result */
     auto r = renderInternal(font, cache, size, text, vertexBuffer, indexBuffer, usage, alignment);
     GL::Mesh& mesh = std::get<0>(r);
@@ -329,11 +417,12 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
 
     const UnsignedInt vertexCount = glyphCount*4;
 
-    /* Allocate vertex buffer, reset vertex count */
+    /* Allocate vertex buffer and the scratch memory, reset vertex count */
     _vertexBuffer.setData({nullptr, vertexCount*sizeof(Vertex)}, vertexBufferUsage);
     #ifdef CORRADE_TARGET_EMSCRIPTEN
     _vertexBufferData = Containers::Array<UnsignedByte>(vertexCount*sizeof(Vertex));
     #endif
+    _vertexData = Containers::Array<char>{Containers::ValueInit, vertexCount*sizeof(Vertex)};
     _mesh.setCount(0);
 
     /* Render indices */
@@ -357,33 +446,204 @@ void AbstractRenderer::reserve(const uint32_t glyphCount, const GL::BufferUsage
     bufferUnmapImplementation(_indexBuffer);
 }
 
-void AbstractRenderer::render(const std::string& text) {
-    /* Render vertex data */
-    std::vector<Vertex> vertexData;
-    _rectangle = {};
-    std::tie(vertexData, _rectangle) = renderVerticesInternal(font, cache, size, text, _alignment);
-
-    const UnsignedInt glyphCount = vertexData.size()/4;
-    const UnsignedInt vertexCount = glyphCount*4;
-    const UnsignedInt indexCount = glyphCount*6;
+void AbstractRenderer::render(const Containers::StringView text) {
+    /* Render vertex data into the scratch memory, reusing the layouter or
+       looking the layout up in the layout cache */
+    const Containers::ArrayView<Vertex> vertexData = Containers::arrayCast<Vertex>(_vertexData);
+    UnsignedInt glyphCount;
+    std::tie(glyphCount, _rectangle) = renderVerticesCachedInto(font, cache, size, text, _alignment, _layouter, _layoutCache, Containers::stridedArrayView(vertexData).slice(&Vertex::position), Containers::stridedArrayView(vertexData).slice(&Vertex::textureCoordinates));
 
     CORRADE_ASSERT(glyphCount <= _capacity,
         "Text::Renderer::render(): capacity" << _capacity << "too small to render" << glyphCount << "glyphs", );
 
-    /* Interleave the data into mapped buffer*/
-    Containers::ArrayView<Vertex> vertices(static_cast<Vertex*>(bufferMapImplementation(_vertexBuffer,
-        vertexCount*sizeof(Vertex))), vertexCount);
-    CORRADE_INTERNAL_ASSERT_OUTPUT(vertices);
-    std::copy(vertexData.begin(), vertexData.end(), vertices.begin());
-    bufferUnmapImplementation(_vertexBuffer);
+    const UnsignedInt vertexCount = glyphCount*4;
+    const UnsignedInt indexCount = glyphCount*6;
+
+    /* Copy the interleaved data into mapped buffer. Mapping a zero-sized
+       range is an error. */
+    if(vertexCount) {
+        const std::size_t dataSize = vertexCount*sizeof(Vertex);
+        char* const vertices = static_cast<char*>(bufferMapImplementation(_vertexBuffer, dataSize));
+        CORRADE_INTERNAL_ASSERT(vertices);
+        std::memcpy(vertices, _vertexData.data(), dataSize);
+        bufferUnmapImplementation(_vertexBuffer);
+    }
 
     /* Update index count */
     _mesh.setCount(indexCount);
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt dimensions> struct BatchRenderer<dimensions>::Run {
+    MatrixType transformation;
+    Range2D rectangle;
+    UnsignedInt materialId;
+};
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(AbstractFont& font, const GlyphCache& cache, const Float size, const UnsignedInt glyphCapacity, const UnsignedInt runCapacity, const Alignment alignment): _font{&font}, _cache{&cache}, _size{size}, _alignment{alignment}, _glyphCapacity{glyphCapacity}, _runCapacity{runCapacity}, _vertexBuffer{GL::Buffer::TargetHint::Array}, _indexBuffer{GL::Buffer::TargetHint::ElementArray}, _transformationProjectionUniform{GL::Buffer::TargetHint::Uniform}, _drawUniform{GL::Buffer::TargetHint::Uniform} {
+    CORRADE_ASSERT(glyphCapacity,
+        "Text::BatchRenderer: glyph capacity can't be zero", );
+    CORRADE_ASSERT(runCapacity,
+        "Text::BatchRenderer: run capacity can't be zero", );
+
+    typedef typename BatchTraits<dimensions>::TransformationProjectionUniform TransformationProjectionUniform;
+
+    /* Vertex data are laid out into the scratch memory and uploaded from
+       there, the uniforms are assembled in a separate scratch memory in
+       upload() */
+    const std::size_t vertexDataSize = glyphCapacity*4*sizeof(BatchVertex);
+    _vertexData = Containers::Array<char>{Containers::ValueInit, vertexDataSize};
+    _uniformData = Containers::Array<char>{Containers::ValueInit, runCapacity*Math::max(sizeof(TransformationProjectionUniform), sizeof(Shaders::VectorDrawUniform))};
+    _runs = Containers::Array<Run>{Containers::ValueInit, runCapacity};
+    _vertexBuffer.setData({nullptr, vertexDataSize}, GL::BufferUsage::DynamicDraw);
+    _transformationProjectionUniform.setData({nullptr, runCapacity*sizeof(TransformationProjectionUniform)}, GL::BufferUsage::DynamicDraw);
+    _drawUniform.setData({nullptr, runCapacity*sizeof(Shaders::VectorDrawUniform)}, GL::BufferUsage::DynamicDraw);
+
+    /* The indices don't depend on the text, so they're uploaded just once */
+    Containers::Array<char> indexData;
+    MeshIndexType indexType;
+    std::tie(indexData, indexType) = renderIndicesInternal(glyphCapacity);
+    _indexBuffer.setData(indexData, GL::BufferUsage::StaticDraw);
+
+    _mesh.setPrimitive(MeshPrimitive::Triangles)
+        .setCount(0)
+        .setIndexBuffer(_indexBuffer, 0, indexType, 0, glyphCapacity*4)
+        .addVertexBuffer(_vertexBuffer, 0,
+            typename Shaders::AbstractVector<dimensions>::Position(Shaders::AbstractVector<dimensions>::Position::Components::Two),
+            typename Shaders::AbstractVector<dimensions>::TextureCoordinates(),
+            typename Shaders::AbstractVector<dimensions>::DrawId());
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::BatchRenderer(BatchRenderer<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>::~BatchRenderer() = default;
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::operator=(BatchRenderer<dimensions>&&) noexcept = default;
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setProjectionMatrix(const MatrixType& matrix) {
+    _projectionMatrix = matrix;
+    _uniformsDirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> UnsignedInt BatchRenderer<dimensions>::add(const Containers::StringView text, const MatrixType& transformation, const UnsignedInt materialId) {
+    CORRADE_ASSERT(_runCount < _runCapacity,
+        "Text::BatchRenderer::add(): run capacity" << _runCapacity << "exhausted", {});
+
+    /* Lay out the glyphs directly after the previous run, reusing the
+       layouter */
+    const Containers::StridedArrayView1D<BatchVertex> vertices = Containers::arrayCast<BatchVertex>(_vertexData).suffix(_glyphCount*4);
+    UnsignedInt glyphCount;
+    Range2D rectangle;
+    std::tie(glyphCount, rectangle) = renderVerticesCachedInto(*_font, *_cache, _size, text, _alignment, _layouter, _layoutCache, vertices.slice(&BatchVertex::position), vertices.slice(&BatchVertex::textureCoordinates));
+    CORRADE_ASSERT(_glyphCount + glyphCount <= _glyphCapacity,
+        "Text::BatchRenderer::add(): glyph capacity" << _glyphCapacity << "too small to add" << glyphCount << "glyphs to existing" << _glyphCount, {});
+
+    const UnsignedInt run = _runCount++;
+    for(BatchVertex& vertex: vertices.prefix(glyphCount*4))
+        vertex.drawId = run;
+
+    _runs[run].transformation = transformation;
+    _runs[run].rectangle = rectangle;
+    _runs[run].materialId = materialId;
+    _glyphCount += glyphCount;
+    _uniformsDirty = true;
+    return run;
+}
+
+template<UnsignedInt dimensions> Range2D BatchRenderer<dimensions>::rectangle(const UnsignedInt run) const {
+    CORRADE_ASSERT(run < _runCount,
+        "Text::BatchRenderer::rectangle(): index" << run << "out of range for" << _runCount << "runs", {});
+    return _runs[run].rectangle;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setTransformation(const UnsignedInt run, const MatrixType& transformation) {
+    CORRADE_ASSERT(run < _runCount,
+        "Text::BatchRenderer::setTransformation(): index" << run << "out of range for" << _runCount << "runs", *this);
+    _runs[run].transformation = transformation;
+    _uniformsDirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::setMaterialId(const UnsignedInt run, const UnsignedInt materialId) {
+    CORRADE_ASSERT(run < _runCount,
+        "Text::BatchRenderer::setMaterialId(): index" << run << "out of range for" << _runCount << "runs", *this);
+    _runs[run].materialId = materialId;
+    _uniformsDirty = true;
+    return *this;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::clear() {
+    _glyphCount = 0;
+    _runCount = 0;
+    _dirtyGlyphOffset = 0;
+    return *this;
+}
+
+template<UnsignedInt dimensions> void BatchRenderer<dimensions>::upload() {
+    /* Upload only vertices of runs added since the last draw */
+    if(_dirtyGlyphOffset != _glyphCount) {
+        _vertexBuffer.setSubData(_dirtyGlyphOffset*4*sizeof(BatchVertex),
+            _vertexData.slice(_dirtyGlyphOffset*4*sizeof(BatchVertex), _glyphCount*4*sizeof(BatchVertex)));
+        _dirtyGlyphOffset = _glyphCount;
+    }
+
+    if(!_uniformsDirty) return;
+
+    /* The uniforms are small compared to the vertex data, so they're
+       uploaded all at once on any change. The scratch memory is reused for
+       both buffers. */
+    typedef typename BatchTraits<dimensions>::TransformationProjectionUniform TransformationProjectionUniform;
+    const Containers::ArrayView<TransformationProjectionUniform> transformationProjections = Containers::arrayCast<TransformationProjectionUniform>(_uniformData.prefix(_runCount*sizeof(TransformationProjectionUniform)));
+    for(std::size_t i = 0; i != _runCount; ++i)
+        transformationProjections[i].setTransformationProjectionMatrix(_projectionMatrix*_runs[i].transformation);
+    _transformationProjectionUniform.setSubData(0, transformationProjections);
+
+    /* Both VectorDrawUniform and DistanceFieldVectorDrawUniform have the
+       same layout, so the buffer can be used with either shader */
+    const Containers::ArrayView<Shaders::VectorDrawUniform> draws = Containers::arrayCast<Shaders::VectorDrawUniform>(_uniformData.prefix(_runCount*sizeof(Shaders::VectorDrawUniform)));
+    for(std::size_t i = 0; i != _runCount; ++i)
+        draws[i] = Shaders::VectorDrawUniform{}.setMaterialId(_runs[i].materialId);
+    _drawUniform.setSubData(0, draws);
+
+    _uniformsDirty = false;
+}
+
+template<UnsignedInt dimensions> template<class Shader> void BatchRenderer<dimensions>::drawInternal(Shader& shader) {
+    CORRADE_ASSERT(shader.flags() >= Shader::Flag::VertexDrawId,
+        "Text::BatchRenderer::draw(): the shader was not created with vertex draw ID enabled", );
+    CORRADE_ASSERT(shader.drawCount() >= _runCount,
+        "Text::BatchRenderer::draw(): the shader was created with" << shader.drawCount() << "draws but" << _runCount << "runs were added", );
+
+    if(!_runCount) return;
+
+    upload();
+    _mesh.setCount(_glyphCount*6);
+    shader
+        .bindTransformationProjectionBuffer(_transformationProjectionUniform)
+        .bindDrawBuffer(_drawUniform)
+        .setDrawOffset(0)
+        .draw(_mesh);
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::draw(Shaders::Vector<dimensions>& shader) {
+    drawInternal(shader);
+    return *this;
+}
+
+template<UnsignedInt dimensions> BatchRenderer<dimensions>& BatchRenderer<dimensions>::draw(Shaders::DistanceFieldVector<dimensions>& shader) {
+    drawInternal(shader);
+    return *this;
+}
+#endif
+
 #ifndef DOXYGEN_GENERATING_OUTPUT
 template class MAGNUM_TEXT_EXPORT Renderer<2>;
 template class MAGNUM_TEXT_EXPORT Renderer<3>;
+#ifndef MAGNUM_TARGET_GLES2
+template class MAGNUM_TEXT_EXPORT BatchRenderer<2>;
+template class MAGNUM_TEXT_EXPORT BatchRenderer<3>;
+#endif
 #endif
 
 }}
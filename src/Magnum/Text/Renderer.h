@@ -26,7 +26,7 @@
 */
 
 /** @file Text/Renderer.h
- * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D
+ * @brief Class @ref Magnum::Text::AbstractRenderer, @ref Magnum::Text::Renderer, @ref Magnum::Text::BatchRenderer, typedef @ref Magnum::Text::Renderer2D, @ref Magnum::Text::Renderer3D, @ref Magnum::Text::BatchRenderer2D, @ref Magnum::Text::BatchRenderer3D
  */
 
 #include "Magnum/configure.h"
@@ -35,6 +35,9 @@
 #include <string>
 #include <tuple>
 #include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringStl.h>
 
 #include "Magnum/DimensionTraits.h"
 #include "Magnum/Math/Range.h"
@@ -44,8 +47,10 @@
 #include "Magnum/Text/Alignment.h"
 #include "Magnum/Text/visibility.h"
 
-#ifdef CORRADE_TARGET_EMSCRIPTEN
-#include <Corrade/Containers/Array.h>
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Shaders/Shaders.h"
 #endif
 
 namespace Magnum { namespace Text {
@@ -69,7 +74,56 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * Returns tuple with vertex positions, texture coordinates, indices
          * and rectangle spanning the rendered text.
          */
-        static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, Alignment alignment = Alignment::LineLeft);
+        static std::tuple<std::vector<Vector2>, std::vector<Vector2>, std::vector<UnsignedInt>, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, Containers::StringView text, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @brief Render text into caller-provided memory
+         * @param font                  Font
+         * @param cache                 Glyph cache
+         * @param size                  Font size
+         * @param text                  Text to render
+         * @param positions             Where to put vertex positions
+         * @param textureCoordinates    Where to put texture coordinates
+         * @param layouter              Layouter to reuse
+         * @param alignment             Text alignment
+         * @return Count of rendered glyphs and rectangle spanning the
+         *      rendered text
+         * @m_since_latest
+         *
+         * Lays out the glyphs directly into @p positions and
+         * @p textureCoordinates, four vertices per glyph in the same order
+         * as in @ref render(AbstractFont&, const GlyphCache&, Float, Containers::StringView, Alignment).
+         * The views can point for example into an interleaved vertex array.
+         * Indices for the vertices don't depend on the text and can be
+         * generated just once for the maximal glyph count.
+         *
+         * The @p layouter is passed to
+         * @ref AbstractFont::layout(const AbstractGlyphCache&, Float, Containers::StringView, Containers::Pointer<AbstractLayouter>&)
+         * for each line, so if the font supports it and the same layouter
+         * instance is passed to repeated calls, nothing gets allocated.
+         * Expects that both views have the same size, large enough to
+         * contain four vertices for each rendered glyph.
+         */
+        static std::pair<UnsignedInt, Range2D> renderInto(AbstractFont& font, const GlyphCache& cache, Float size, Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, Containers::Pointer<AbstractLayouter>& layouter, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Creates a temporary layouter for each call.
+         */
+        static std::pair<UnsignedInt, Range2D> renderInto(AbstractFont& font, const GlyphCache& cache, Float size, Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, Alignment alignment = Alignment::LineLeft);
+
+        /**
+         * @overload
+         * @m_since_latest
+         *
+         * Looks up the layout in @p layoutCache first and copies the cached
+         * vertices on a hit. On a miss, lays out the text using
+         * @ref LayoutCache::layouter() and inserts the result into
+         * @p layoutCache, unless it didn't fit into the views.
+         */
+        static std::pair<UnsignedInt, Range2D> renderInto(AbstractFont& font, const GlyphCache& cache, Float size, Containers::StringView text, const Containers::StridedArrayView1D<Vector2>& positions, const Containers::StridedArrayView1D<Vector2>& textureCoordinates, LayoutCache& layoutCache, Alignment alignment = Alignment::LineLeft);
 
         /**
          * @brief Capacity for rendered glyphs
@@ -90,11 +144,31 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         /** @brief Mesh */
         GL::Mesh& mesh() { return _mesh; }
 
+        /**
+         * @brief Layout cache
+         * @m_since_latest
+         *
+         * @see @ref setLayoutCache()
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @m_since_latest
+         *
+         * If set, @ref render(Containers::StringView) looks up the text in
+         * @p layoutCache first and inserts it there if not found. The cache
+         * is expected to stay alive for as long as it's used by the
+         * renderer. Pass @cpp nullptr @ce to stop using it. Initially no
+         * layout cache is used.
+         */
+        void setLayoutCache(LayoutCache* layoutCache) { _layoutCache = layoutCache; }
+
         /**
          * @brief Reserve capacity for rendered glyphs
          *
-         * Reallocates memory in buffers to hold @p glyphCount glyphs and
-         * prefills index buffer. Consider using appropriate @p vertexBufferUsage
+         * Reallocates memory in buffers and the CPU-side scratch memory to
+         * hold @p glyphCount glyphs and prefills index buffer. Consider using appropriate @p vertexBufferUsage
          * if the text will be changed frequently. Index buffer is changed
          * only by calling this function, thus @p indexBufferUsage generally
          * doesn't need to be so dynamic if the capacity won't be changed much.
@@ -111,11 +185,17 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
          * filled with @ref reserve(). Rectangle spanning the rendered text is
          * available through @ref rectangle().
          *
+         * The glyphs are laid out into a scratch memory allocated in
+         * @ref reserve() and copied to the mapped vertex buffer, and the
+         * font layouter is reused between calls. Thus, if the font supports
+         * @ref AbstractFont::layout(const AbstractGlyphCache&, Float, Containers::StringView, Containers::Pointer<AbstractLayouter>&) "layouter reuse",
+         * updating the text doesn't allocate.
+         *
          * Initially no text is rendered.
          * @attention The capacity must be large enough to contain all glyphs,
          *      see @ref reserve() for more information.
          */
-        void render(const std::string& text);
+        void render(Containers::StringView text);
 
     #ifndef DOXYGEN_GENERATING_OUTPUT
     protected:
@@ -139,6 +219,11 @@ class MAGNUM_TEXT_EXPORT AbstractRenderer {
         Alignment _alignment;
         UnsignedInt _capacity;
         Range2D _rectangle;
+        /* Interleaved vertex data, laid out there before copying to the
+           mapped buffer as alignment needs to read back the positions */
+        Containers::Array<char> _vertexData;
+        Containers::Pointer<AbstractLayouter> _layouter;
+        LayoutCache* _layoutCache{};
 
         #if defined(MAGNUM_TARGET_GLES2) && !defined(CORRADE_TARGET_EMSCRIPTEN)
         typedef void*(*BufferMapImplementation)(GL::Buffer&, GLsizeiptr);
@@ -183,8 +268,8 @@ mesh:
 
 @snippet MagnumText.cpp Renderer-usage1
 
-See @ref render(AbstractFont&, const GlyphCache&, Float, const std::string&, Alignment)
-and @ref render(AbstractFont&, const GlyphCache&, Float, const std::string&, GL::Buffer&, GL::Buffer&, GL::BufferUsage, Alignment)
+See @ref render(AbstractFont&, const GlyphCache&, Float, Containers::StringView, Alignment)
+and @ref render(AbstractFont&, const GlyphCache&, Float, Containers::StringView, GL::Buffer&, GL::Buffer&, GL::BufferUsage, Alignment)
 for more information.
 
 While this method is sufficient for one-shot rendering of static texts, for
@@ -193,6 +278,19 @@ that doesn't recreate everything on each text change:
 
 @snippet MagnumText.cpp Renderer-usage2
 
+The mutable text rendering doesn't allocate on text updates, if the font
+supports layouter reuse. For texts that are rendered into a custom vertex
+layout or batched together into a single buffer, the glyphs can be laid out
+directly into caller-provided memory with
+@ref renderInto(AbstractFont&, const GlyphCache&, Float, Containers::StringView, const Containers::StridedArrayView1D<Vector2>&, const Containers::StridedArrayView1D<Vector2>&, Containers::Pointer<AbstractLayouter>&, Alignment)
+instead:
+
+@snippet MagnumText.cpp Renderer-usage3
+
+Texts that repeat often, such as labels or item names, can be looked up in a
+@ref LayoutCache instead of being laid out again, see its documentation for
+more information.
+
 @section Text-Renderer-required-opengl-functionality Required OpenGL functionality
 
 Mutable text rendering requires @gl_extension{ARB,map_buffer_range} on desktop
@@ -220,7 +318,7 @@ template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT Renderer: public Abstr
          * Returns mesh prepared for use with @ref Shaders::AbstractVector
          * subclasses and rectangle spanning the rendered text.
          */
-        static std::tuple<GL::Mesh, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, const std::string& text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment = Alignment::LineLeft);
+        static std::tuple<GL::Mesh, Range2D> render(AbstractFont& font, const GlyphCache& cache, Float size, Containers::StringView text, GL::Buffer& vertexBuffer, GL::Buffer& indexBuffer, GL::BufferUsage usage, Alignment alignment = Alignment::LineLeft);
 
         /**
          * @brief Constructor
@@ -243,6 +341,249 @@ typedef Renderer<2> Renderer2D;
 /** @brief Three-dimensional text renderer */
 typedef Renderer<3> Renderer3D;
 
+#ifndef MAGNUM_TARGET_GLES2
+/**
+@brief Batched text renderer
+@m_since_latest
+
+Lays out many independent strings, called *runs*, into a single shared vertex
+buffer with a single shared index buffer, so all of them can be drawn with a
+single draw call. Each run has its own transformation and material, which
+makes it suitable for drawing for example all labels of an UI layer at once,
+instead of having a separate @ref Renderer, buffers and a draw call for each.
+
+The vertices contain, apart from positions and texture coordinates, also a
+per-vertex run index in the @ref Shaders::AbstractVector::DrawId attribute.
+The per-run transformations and material IDs are stored in uniform buffers
+and the shader picks them using the run index. Thus the renderer is meant to
+be used with @ref Shaders::Vector or @ref Shaders::DistanceFieldVector created
+with @ref Shaders::Vector::Flag::VertexDrawId and with draw count of at
+least @ref runCapacity(). The material buffer, referenced by the material IDs,
+and the glyph cache texture are left for the user to bind:
+
+@snippet MagnumText.cpp BatchRenderer-usage
+
+Added runs are laid out immediately, reusing a single font layouter instance,
+and the data are uploaded to the GPU lazily in @ref draw(), only for the
+parts that changed since the last draw. Changing a transformation or a
+material of a run with @ref setTransformation() or @ref setMaterialId() only
+updates the uniform buffers and doesn't touch the vertex data. The runs can't
+be removed individually, @ref clear() removes all of them while keeping the
+allocated memory.
+
+@section Text-BatchRenderer-limits Limitations
+
+The @p runCapacity passed to the constructor is limited by the maximum size
+of an uniform block, which is at least 16 kB. With a @ref Matrix4
+being @cpp 64 @ce bytes, that's at least @cpp 256 @ce runs for
+@ref BatchRenderer3D and @cpp 341 @ce runs for @ref BatchRenderer2D. Larger
+amounts of text have to be split among multiple renderers.
+@see @ref GL::AbstractShaderProgram::maxUniformBlockSize()
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4}
+@requires_gl31 Extension @gl_extension{ARB,uniform_buffer_object}
+@requires_gles30 Uniform buffers are not available in OpenGL ES 2.0.
+@requires_webgl20 Uniform buffers are not available in WebGL 1.0.
+*/
+template<UnsignedInt dimensions> class MAGNUM_TEXT_EXPORT BatchRenderer {
+    public:
+        /** @brief Transformation matrix type */
+        typedef typename DimensionTraits<dimensions, Float>::MatrixType MatrixType;
+
+        /**
+         * @brief Constructor
+         * @param font          Font
+         * @param cache         Glyph cache
+         * @param size          Font size
+         * @param glyphCapacity Capacity for rendered glyphs
+         * @param runCapacity   Capacity for runs
+         * @param alignment     Text alignment
+         *
+         * Allocates the vertex buffer for @p glyphCapacity glyphs and the
+         * uniform buffers for @p runCapacity runs and prefills the index
+         * buffer. Expects that both @p glyphCapacity and @p runCapacity are
+         * non-zero.
+         */
+        explicit BatchRenderer(AbstractFont& font, const GlyphCache& cache, Float size, UnsignedInt glyphCapacity, UnsignedInt runCapacity, Alignment alignment = Alignment::LineLeft);
+        BatchRenderer(AbstractFont&, GlyphCache&&, Float, UnsignedInt, UnsignedInt, Alignment alignment = Alignment::LineLeft) = delete; /**< @overload */
+
+        /** @brief Copying is not allowed */
+        BatchRenderer(const BatchRenderer<dimensions>&) = delete;
+
+        /** @brief Move constructor */
+        BatchRenderer(BatchRenderer<dimensions>&&) noexcept;
+
+        ~BatchRenderer();
+
+        /** @brief Copying is not allowed */
+        BatchRenderer<dimensions>& operator=(const BatchRenderer<dimensions>&) = delete;
+
+        /** @brief Move assignment */
+        BatchRenderer<dimensions>& operator=(BatchRenderer<dimensions>&&) noexcept;
+
+        /** @brief Capacity for rendered glyphs */
+        UnsignedInt glyphCapacity() const { return _glyphCapacity; }
+
+        /** @brief Count of rendered glyphs in all runs */
+        UnsignedInt glyphCount() const { return _glyphCount; }
+
+        /** @brief Capacity for runs */
+        UnsignedInt runCapacity() const { return _runCapacity; }
+
+        /** @brief Count of added runs */
+        UnsignedInt runCount() const { return _runCount; }
+
+        /**
+         * @brief Vertex buffer
+         *
+         * Contains data uploaded in the last @ref draw().
+         */
+        GL::Buffer& vertexBuffer() { return _vertexBuffer; }
+
+        /** @brief Index buffer */
+        GL::Buffer& indexBuffer() { return _indexBuffer; }
+
+        /** @brief Mesh */
+        GL::Mesh& mesh() { return _mesh; }
+
+        /**
+         * @brief Layout cache
+         *
+         * @see @ref setLayoutCache()
+         */
+        LayoutCache* layoutCache() const { return _layoutCache; }
+
+        /**
+         * @brief Set layout cache
+         * @return Reference to self (for method chaining)
+         *
+         * If set, @ref add() looks up the text in @p layoutCache first and
+         * inserts it there if not found. The cache is expected to stay alive
+         * for as long as it's used by the renderer. Pass @cpp nullptr @ce
+         * to stop using it. Initially no layout cache is used.
+         */
+        BatchRenderer<dimensions>& setLayoutCache(LayoutCache* layoutCache) {
+            _layoutCache = layoutCache;
+            return *this;
+        }
+
+        /**
+         * @brief Set projection matrix
+         * @return Reference to self (for method chaining)
+         *
+         * Multiplied with transformations of all runs. Initially an identity
+         * matrix.
+         */
+        BatchRenderer<dimensions>& setProjectionMatrix(const MatrixType& matrix);
+
+        /**
+         * @brief Add a run
+         * @param text              Text to render
+         * @param transformation    Run transformation
+         * @param materialId        Run material ID
+         * @return Run ID
+         *
+         * Lays out @p text after glyphs of previously added runs. The returned
+         * ID is equal to @ref runCount() before the call and can be used to
+         * subsequently change the run transformation and material or query
+         * the rectangle spanning the text. Expects that there's still
+         * capacity for a new run and for all glyphs of @p text.
+         * @see @ref rectangle(), @ref setTransformation(),
+         *      @ref setMaterialId()
+         */
+        UnsignedInt add(Containers::StringView text, const MatrixType& transformation, UnsignedInt materialId = 0);
+
+        /**
+         * @brief Rectangle spanning a run
+         *
+         * In the run coordinate system, i.e. without the run transformation
+         * applied. Expects that @p run is less than @ref runCount().
+         */
+        Range2D rectangle(UnsignedInt run) const;
+
+        /**
+         * @brief Set transformation of a run
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p run is less than @ref runCount().
+         */
+        BatchRenderer<dimensions>& setTransformation(UnsignedInt run, const MatrixType& transformation);
+
+        /**
+         * @brief Set material ID of a run
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that @p run is less than @ref runCount() and that
+         * @p materialId is less than material count of the shader used for
+         * drawing.
+         */
+        BatchRenderer<dimensions>& setMaterialId(UnsignedInt run, UnsignedInt materialId);
+
+        /**
+         * @brief Clear all runs
+         * @return Reference to self (for method chaining)
+         *
+         * Sets both @ref runCount() and @ref glyphCount() to zero, the
+         * allocated capacity stays the same.
+         */
+        BatchRenderer<dimensions>& clear();
+
+        /**
+         * @brief Draw all runs
+         * @return Reference to self (for method chaining)
+         *
+         * Uploads data that changed since the last draw, binds the
+         * transformation and draw uniform buffers to @p shader, resets the
+         * draw offset to @cpp 0 @ce and draws all runs in a single draw
+         * call. If there are no runs, does nothing. Expects that @p shader
+         * was created with @ref Shaders::Vector::Flag::VertexDrawId
+         * and with a draw count of at least @ref runCount().
+         * @see @ref Shaders::Vector::bindTransformationProjectionBuffer(),
+         *      @ref Shaders::Vector::bindDrawBuffer(),
+         *      @ref Shaders::Vector::setDrawOffset()
+         */
+        BatchRenderer<dimensions>& draw(Shaders::Vector<dimensions>& shader);
+
+        /** @overload */
+        BatchRenderer<dimensions>& draw(Shaders::DistanceFieldVector<dimensions>& shader);
+
+    private:
+        struct Run;
+
+        template<class Shader> MAGNUM_TEXT_LOCAL void drawInternal(Shader& shader);
+        MAGNUM_TEXT_LOCAL void upload();
+
+        AbstractFont* _font;
+        const GlyphCache* _cache;
+        Float _size;
+        Alignment _alignment;
+        UnsignedInt _glyphCapacity, _glyphCount{},
+            _runCapacity, _runCount{};
+        /* Vertices of glyphs starting from this one need to be uploaded */
+        UnsignedInt _dirtyGlyphOffset{};
+        bool _uniformsDirty{};
+        MatrixType _projectionMatrix;
+        Containers::Array<char> _vertexData, _uniformData;
+        Containers::Array<Run> _runs;
+        Containers::Pointer<AbstractLayouter> _layouter;
+        LayoutCache* _layoutCache{};
+        GL::Buffer _vertexBuffer, _indexBuffer,
+            _transformationProjectionUniform, _drawUniform;
+        GL::Mesh _mesh;
+};
+
+/**
+@brief Two-dimensional batched text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<2> BatchRenderer2D;
+
+/**
+@brief Three-dimensional batched text renderer
+@m_since_latest
+*/
+typedef BatchRenderer<3> BatchRenderer3D;
+#endif
+
 }}
 #else
 #error this header is available only in the OpenGL build
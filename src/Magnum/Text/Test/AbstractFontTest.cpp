@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -81,6 +82,10 @@ struct AbstractFontTest: TestSuite::Tester {
 
     void layout();
     void layoutNoFont();
+    void layoutReuse();
+    void layoutReuseNotImplemented();
+    void layoutReuseDifferentFont();
+    void layoutReuseNoFont();
 
     void fillGlyphCache();
     void fillGlyphCacheNotSupported();
@@ -136,6 +141,10 @@ AbstractFontTest::AbstractFontTest() {
 
               &AbstractFontTest::layout,
               &AbstractFontTest::layoutNoFont,
+              &AbstractFontTest::layoutReuse,
+              &AbstractFontTest::layoutReuseNotImplemented,
+              &AbstractFontTest::layoutReuseDifferentFont,
+              &AbstractFontTest::layoutReuseNoFont,
 
               &AbstractFontTest::fillGlyphCache,
               &AbstractFontTest::fillGlyphCacheNotSupported,
@@ -990,6 +999,118 @@ void AbstractFontTest::layoutNoFont() {
     CORRADE_COMPARE(out.str(), "Text::AbstractFont::layout(): no font opened\n");
 }
 
+struct ReusableLayouter: AbstractLayouter {
+    explicit ReusableLayouter(UnsignedInt count): AbstractLayouter{count} {}
+    std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override { return {}; }
+
+    using AbstractLayouter::setGlyphCount;
+};
+
+struct ReusingFont: AbstractFont {
+    FontFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doGlyphId(char32_t) override { return {}; }
+    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string& str) override {
+        ++layoutCalls;
+        return Containers::pointer<ReusableLayouter>(UnsignedInt(str.size()));
+    }
+    bool doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache& cache, Float size, Containers::StringView str) override {
+        ++relayoutCalls;
+        static_cast<ReusableLayouter&>(layouter).setGlyphCount(UnsignedInt(cache.textureSize().x()*str.size()*size));
+        return true;
+    }
+
+    Int layoutCalls{}, relayoutCalls{};
+};
+
+void AbstractFontTest::layoutReuse() {
+    ReusingFont font;
+    DummyGlyphCache cache{{100, 200}};
+
+    /* First time a new layouter gets created */
+    Containers::Pointer<AbstractLayouter> layouter;
+    font.layout(cache, 0.25f, "hello", layouter);
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 5);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 0);
+
+    /* Second time it gets reused */
+    AbstractLayouter* const pointer = layouter.get();
+    font.layout(cache, 0.25f, "hey", layouter);
+    CORRADE_VERIFY(layouter.get() == pointer);
+    CORRADE_COMPARE(layouter->glyphCount(), 100*3/4);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 1);
+}
+
+void AbstractFontTest::layoutReuseNotImplemented() {
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string& str) override {
+            return Containers::pointer<ReusableLayouter>(UnsignedInt(str.size()));
+        }
+    } font;
+
+    DummyGlyphCache cache{{100, 200}};
+    Containers::Pointer<AbstractLayouter> layouter;
+    font.layout(cache, 0.25f, "hello", layouter);
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 5);
+
+    /* Without doRelayout() a new layouter gets created every time */
+    font.layout(cache, 0.25f, "hey", layouter);
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 3);
+}
+
+void AbstractFontTest::layoutReuseDifferentFont() {
+    ReusingFont font, another;
+    DummyGlyphCache cache{{100, 200}};
+
+    Containers::Pointer<AbstractLayouter> layouter;
+    another.layout(cache, 0.25f, "hello", layouter);
+    CORRADE_COMPARE(another.layoutCalls, 1);
+
+    /* Layouter from a different font isn't passed to doRelayout() */
+    font.layout(cache, 0.25f, "hey", layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 3);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 0);
+    CORRADE_COMPARE(another.relayoutCalls, 0);
+}
+
+void AbstractFontTest::layoutReuseNoFont() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct MyFont: AbstractFont {
+        FontFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return {}; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) override { return nullptr; }
+    } font;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DummyGlyphCache cache{{100, 200}};
+    Containers::Pointer<AbstractLayouter> layouter;
+    font.layout(cache, 0.25f, "hello", layouter);
+    CORRADE_COMPARE(out.str(), "Text::AbstractFont::layout(): no font opened\n");
+}
+
 void AbstractFontTest::fillGlyphCache() {
     struct MyFont: AbstractFont {
         FontFeatures doFeatures() const override { return {}; }
@@ -41,6 +41,8 @@ struct AbstractGlyphCacheTest: TestSuite::Tester {
     void initialize();
     void access();
     void reserve();
+    void reserveIncremental();
+    void reserveTooSmall();
 
     void setImage();
     void setImageOutOfBounds();
@@ -54,6 +56,8 @@ AbstractGlyphCacheTest::AbstractGlyphCacheTest() {
     addTests({&AbstractGlyphCacheTest::initialize,
               &AbstractGlyphCacheTest::access,
               &AbstractGlyphCacheTest::reserve,
+              &AbstractGlyphCacheTest::reserveIncremental,
+              &AbstractGlyphCacheTest::reserveTooSmall,
 
               &AbstractGlyphCacheTest::setImage,
               &AbstractGlyphCacheTest::setImageOutOfBounds,
@@ -114,6 +118,40 @@ void AbstractGlyphCacheTest::reserve() {
     CORRADE_VERIFY(!cache.reserve({{5, 3}}).empty());
 }
 
+void AbstractGlyphCacheTest::reserveIncremental() {
+    DummyGlyphCache cache{Vector2i{16}};
+
+    std::vector<Range2Di> a = cache.reserve({{8, 4}});
+    CORRADE_COMPARE(a, (std::vector<Range2Di>{
+        Range2Di::fromSize({0, 0}, {8, 4})}));
+    cache.insert(1, {}, a[0]);
+
+    /* Reserving in a non-empty cache doesn't touch the already reserved
+       space */
+    std::vector<Range2Di> b = cache.reserve({{8, 6}, {4, 4}});
+    CORRADE_COMPARE(b, (std::vector<Range2Di>{
+        Range2Di::fromSize({8, 0}, {8, 6}),
+        Range2Di::fromSize({0, 4}, {4, 4})}));
+    CORRADE_COMPARE(cache.atlas().count(), 3);
+    CORRADE_COMPARE(cache.atlas().freeArea(), 256 - 32 - 48 - 16);
+}
+
+void AbstractGlyphCacheTest::reserveTooSmall() {
+    DummyGlyphCache cache{Vector2i{16}};
+    CORRADE_COMPARE(cache.reserve({{16, 10}}).size(), 1);
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(cache.reserve({{16, 8}}).empty());
+    }
+    CORRADE_COMPARE(out.str(), "Text::AbstractGlyphCache::reserve(): cache of size Vector(16, 16) is too small to fit 1 more glyphs, 96 pixels left\n");
+
+    /* Nothing got reserved, so a smaller glyph still fits */
+    CORRADE_COMPARE(cache.reserve({{16, 6}}), (std::vector<Range2Di>{
+        Range2Di::fromSize({0, 10}, {16, 6})}));
+}
+
 void AbstractGlyphCacheTest::setImage() {
     struct MyGlyphCache: AbstractGlyphCache {
         using AbstractGlyphCache::AbstractGlyphCache;
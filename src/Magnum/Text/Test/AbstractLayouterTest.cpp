@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Range.h"
 #include "Magnum/Text/AbstractFont.h"
@@ -34,10 +37,16 @@ struct AbstractLayouterTest: TestSuite::Tester {
     explicit AbstractLayouterTest();
 
     void renderGlyph();
+    void renderGlyphs();
+    void renderGlyphsImplementation();
+    void renderGlyphsInvalid();
 };
 
 AbstractLayouterTest::AbstractLayouterTest() {
-    addTests({&AbstractLayouterTest::renderGlyph});
+    addTests({&AbstractLayouterTest::renderGlyph,
+              &AbstractLayouterTest::renderGlyphs,
+              &AbstractLayouterTest::renderGlyphsImplementation,
+              &AbstractLayouterTest::renderGlyphsInvalid});
 }
 
 void AbstractLayouterTest::renderGlyph() {
@@ -80,6 +89,116 @@ void AbstractLayouterTest::renderGlyph() {
     CORRADE_COMPARE(rectangle, Range2D({2.0f, 0.5f}, {6.1f, 3.0f}));
 }
 
+void AbstractLayouterTest::renderGlyphs() {
+    /* Same as in renderGlyph(), with the default doRenderGlyphs() calling
+       doRenderGlyph() */
+    class Layouter: public AbstractLayouter {
+        public:
+            explicit Layouter(): AbstractLayouter(3) {}
+
+        private:
+            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+                return std::make_tuple(Range2D({1.0f, 0.5f}, {1.1f, 1.0f}),
+                                       Range2D({0.3f, 1.1f}, {-0.5f, 0.7f}),
+                                       Vector2(2.0f, -1.0f));
+            }
+    };
+
+    Range2D rectangle({-1.0f, -1.0f}, {-1.0f, -1.0f});
+    Vector2 cursorPosition(1.0f, 2.0f);
+
+    Layouter l;
+    Range2D quadPositions[3];
+    Range2D textureCoords[3];
+    Vector2 advances[3];
+    l.renderGlyphs(0, cursorPosition, rectangle, quadPositions, textureCoords, advances);
+    CORRADE_COMPARE(quadPositions[0], Range2D({2.0f, 2.5f}, {2.1f, 3.0f}));
+    CORRADE_COMPARE(quadPositions[1], Range2D({4.0f, 1.5f}, {4.1f, 2.0f}));
+    CORRADE_COMPARE(quadPositions[2], Range2D({6.0f, 0.5f}, {6.1f, 1.0f}));
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(textureCoords[i], Range2D({0.3f, 1.1f}, {-0.5f, 0.7f}));
+        CORRADE_COMPARE(advances[i], Vector2(2.0f, -1.0f));
+    }
+    CORRADE_COMPARE(cursorPosition, Vector2(7.0f, -1.0f));
+    CORRADE_COMPARE(rectangle, Range2D({2.0f, 0.5f}, {6.1f, 3.0f}));
+}
+
+void AbstractLayouterTest::renderGlyphsImplementation() {
+    class Layouter: public AbstractLayouter {
+        public:
+            explicit Layouter(): AbstractLayouter(3) {}
+
+        private:
+            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override {
+                CORRADE_FAIL("This shouldn't be called.");
+                return {};
+            }
+
+            void doRenderGlyphs(UnsignedInt offset, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances) override {
+                CORRADE_COMPARE(offset, 1);
+                CORRADE_COMPARE(quadPositions.size(), 2);
+                CORRADE_COMPARE(textureCoordinates.size(), 2);
+                CORRADE_COMPARE(advances.size(), 2);
+                quadPositions[0] = Range2D({0.0f, 0.0f}, {1.0f, 1.0f});
+                quadPositions[1] = Range2D({0.5f, -0.5f}, {1.5f, 0.5f});
+                textureCoordinates[0] = Range2D({0.0f, 0.0f}, {0.5f, 0.5f});
+                textureCoordinates[1] = Range2D({0.5f, 0.5f}, {1.0f, 1.0f});
+                advances[0] = Vector2(1.0f, 0.0f);
+                advances[1] = Vector2(2.0f, 0.0f);
+            }
+    };
+
+    Range2D rectangle;
+    Vector2 cursorPosition(1.0f, 2.0f);
+
+    Layouter l;
+    Range2D quadPositions[2];
+    Range2D textureCoords[2];
+    Vector2 advances[2];
+    l.renderGlyphs(1, cursorPosition, rectangle, quadPositions, textureCoords, advances);
+
+    /* The quads get moved to the cursor, texture coordinates and advances
+       are passed through */
+    CORRADE_COMPARE(quadPositions[0], Range2D({1.0f, 2.0f}, {2.0f, 3.0f}));
+    CORRADE_COMPARE(quadPositions[1], Range2D({2.5f, 1.5f}, {3.5f, 2.5f}));
+    CORRADE_COMPARE(textureCoords[0], Range2D({0.0f, 0.0f}, {0.5f, 0.5f}));
+    CORRADE_COMPARE(textureCoords[1], Range2D({0.5f, 0.5f}, {1.0f, 1.0f}));
+    CORRADE_COMPARE(advances[0], Vector2(1.0f, 0.0f));
+    CORRADE_COMPARE(advances[1], Vector2(2.0f, 0.0f));
+    CORRADE_COMPARE(cursorPosition, Vector2(4.0f, 2.0f));
+    CORRADE_COMPARE(rectangle, Range2D({1.0f, 1.5f}, {3.5f, 3.0f}));
+}
+
+void AbstractLayouterTest::renderGlyphsInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    class Layouter: public AbstractLayouter {
+        public:
+            explicit Layouter(): AbstractLayouter(3) {}
+
+        private:
+            std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt) override { return {}; }
+    };
+
+    Layouter l;
+    Range2D rectangle;
+    Vector2 cursorPosition;
+    Range2D quadPositions[3];
+    Range2D textureCoords[3];
+    Vector2 advances[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    l.renderGlyphs(0, cursorPosition, rectangle, quadPositions, Containers::arrayView(textureCoords).prefix(2), advances);
+    l.renderGlyphs(2, cursorPosition, rectangle, Containers::arrayView(quadPositions).prefix(2), Containers::arrayView(textureCoords).prefix(2), Containers::arrayView(advances).prefix(2));
+    CORRADE_COMPARE(out.str(),
+        "Text::AbstractLayouter::renderGlyphs(): expected views to have the same size but got 3, 2 and 3\n"
+        "Text::AbstractLayouter::renderGlyphs(): glyphs from 2 to 4 out of bounds for 3 glyphs\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::AbstractLayouterTest)
@@ -23,19 +23,34 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
 #include "Magnum/GL/OpenGLTester.h"
 #include "Magnum/Text/DistanceFieldGlyphCache.h"
 
+#ifndef MAGNUM_TARGET_GLES
+#include "Magnum/Image.h"
+#include "Magnum/GL/PixelFormat.h"
+#endif
+
 namespace Magnum { namespace Text { namespace Test { namespace {
 
 struct DistanceFieldGlyphCacheGLTest: GL::OpenGLTester {
     explicit DistanceFieldGlyphCacheGLTest();
 
     void initialize();
+    void queueImage();
+    void setImageFlushesQueue();
 };
 
 DistanceFieldGlyphCacheGLTest::DistanceFieldGlyphCacheGLTest() {
-    addTests({&DistanceFieldGlyphCacheGLTest::initialize});
+    addTests({&DistanceFieldGlyphCacheGLTest::initialize,
+              &DistanceFieldGlyphCacheGLTest::queueImage,
+              &DistanceFieldGlyphCacheGLTest::setImageFlushesQueue});
 }
 
 void DistanceFieldGlyphCacheGLTest::initialize() {
@@ -47,6 +62,64 @@ void DistanceFieldGlyphCacheGLTest::initialize() {
     #endif
 }
 
+void DistanceFieldGlyphCacheGLTest::queueImage() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("The glyph cache would need to be in a Luminance format on ES2.");
+    #else
+    Text::DistanceFieldGlyphCache cache{{64, 64}, {32, 32}, 4};
+
+    /* Make the whole output defined first -- everything is outside */
+    Containers::Array<char> zeros{Containers::ValueInit, 64*64};
+    cache.setImage({}, ImageView2D{PixelFormat::R8Unorm, {64, 64}, zeros});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache.dirtyRectangles().empty());
+
+    /* A filled 16x16 square, queued for processing */
+    Containers::Array<char> glyph{Containers::DirectInit, 16*16, '\xff'};
+    cache.queueImage({32, 32}, ImageView2D{PixelFormat::R8Unorm, {16, 16}, glyph});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(cache.dirtyRectangles().size(), 1);
+    CORRADE_COMPARE(cache.dirtyRectangles()[0], (Range2Di{{32, 32}, {48, 48}}));
+
+    cache.flush();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache.dirtyRectangles().empty());
+
+    /* Flushing again is a no-op */
+    cache.flush();
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D image = cache.texture().image(0, {GL::PixelFormat::Red, GL::PixelType::UnsignedByte});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* Center of the square is inside, the region that wasn't dirty stays
+       untouched */
+    CORRADE_COMPARE_AS(Int(image.pixels<UnsignedByte>()[20][20]), 0x80,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(Int(image.pixels<UnsignedByte>()[4][4]), 0);
+    #endif
+    #endif
+}
+
+void DistanceFieldGlyphCacheGLTest::setImageFlushesQueue() {
+    #ifdef MAGNUM_TARGET_GLES2
+    CORRADE_SKIP("The glyph cache would need to be in a Luminance format on ES2.");
+    #else
+    Text::DistanceFieldGlyphCache cache{{64, 64}, {32, 32}, 4};
+
+    Containers::Array<char> glyph{Containers::DirectInit, 16*16, '\xff'};
+    cache.queueImage({0, 0}, ImageView2D{PixelFormat::R8Unorm, {16, 16}, glyph});
+    cache.queueImage({16, 0}, ImageView2D{PixelFormat::R8Unorm, {16, 16}, glyph});
+    CORRADE_COMPARE(cache.dirtyRectangles().size(), 2);
+
+    /* Processes the queue together with the new image */
+    cache.setImage({32, 0}, ImageView2D{PixelFormat::R8Unorm, {16, 16}, glyph});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache.dirtyRectangles().empty());
+    #endif
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::DistanceFieldGlyphCacheGLTest)
@@ -0,0 +1,340 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <type_traits>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Text/Alignment.h"
+#include "Magnum/Text/LayoutCache.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct LayoutCacheTest: TestSuite::Tester {
+    explicit LayoutCacheTest();
+
+    void construct();
+    void constructZeroLimit();
+    void constructMove();
+
+    void insertFind();
+    void findDifferentKey();
+    void findDoesntFit();
+    void insertReplace();
+    void evict();
+    void insertTooLarge();
+    void clear();
+    void resetCounters();
+
+    void findInvalidViews();
+    void insertInvalidViews();
+};
+
+LayoutCacheTest::LayoutCacheTest() {
+    addTests({&LayoutCacheTest::construct,
+              &LayoutCacheTest::constructZeroLimit,
+              &LayoutCacheTest::constructMove,
+
+              &LayoutCacheTest::insertFind,
+              &LayoutCacheTest::findDifferentKey,
+              &LayoutCacheTest::findDoesntFit,
+              &LayoutCacheTest::insertReplace,
+              &LayoutCacheTest::evict,
+              &LayoutCacheTest::insertTooLarge,
+              &LayoutCacheTest::clear,
+              &LayoutCacheTest::resetCounters,
+
+              &LayoutCacheTest::findInvalidViews,
+              &LayoutCacheTest::insertInvalidViews});
+}
+
+/* The cache only uses the font and glyph cache addresses, so there's no need
+   to have actual instances. *static_cast<AbstractFont*>(nullptr) makes Clang
+   Analyzer grumpy. */
+char fontData[2];
+char glyphCacheData[2];
+const AbstractFont& font = *reinterpret_cast<const AbstractFont*>(&fontData[0]);
+const AbstractFont& anotherFont = *reinterpret_cast<const AbstractFont*>(&fontData[1]);
+const AbstractGlyphCache& glyphCache = *reinterpret_cast<const AbstractGlyphCache*>(&glyphCacheData[0]);
+const AbstractGlyphCache& anotherGlyphCache = *reinterpret_cast<const AbstractGlyphCache*>(&glyphCacheData[1]);
+
+/* One glyph */
+const Vector2 Positions[]{
+    {0.0f, 1.0f}, {0.0f, 0.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}
+};
+const Vector2 TextureCoordinates[]{
+    {0.5f, 0.75f}, {0.5f, 0.25f}, {0.75f, 0.75f}, {0.75f, 0.25f}
+};
+const Range2D Rectangle{{0.0f, 0.0f}, {1.0f, 1.0f}};
+
+void LayoutCacheTest::construct() {
+    LayoutCache cache{1024};
+    CORRADE_COMPARE(cache.memoryLimit(), 1024);
+    CORRADE_COMPARE(cache.memoryUsage(), 0);
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 0);
+    CORRADE_VERIFY(!cache.layouter());
+}
+
+void LayoutCacheTest::constructZeroLimit() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    LayoutCache{0};
+    CORRADE_COMPARE(out.str(), "Text::LayoutCache: memory limit can't be zero\n");
+}
+
+void LayoutCacheTest::constructMove() {
+    LayoutCache a{1024};
+    a.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+
+    LayoutCache b{std::move(a)};
+    CORRADE_COMPARE(b.memoryLimit(), 1024);
+    CORRADE_COMPARE(b.size(), 1);
+
+    LayoutCache c{16};
+    c = std::move(b);
+    CORRADE_COMPARE(c.memoryLimit(), 1024);
+    CORRADE_COMPARE(c.size(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<LayoutCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<LayoutCache>::value);
+}
+
+void LayoutCacheTest::insertFind() {
+    LayoutCache cache{1024};
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+
+    /* Not there yet */
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_VERIFY(cache.memoryUsage() > 1 + 8*sizeof(Vector2));
+    CORRADE_VERIFY(cache.memoryUsage() <= cache.memoryLimit());
+
+    Containers::Optional<std::pair<UnsignedInt, Range2D>> found = cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found->first, 1);
+    CORRADE_COMPARE(found->second, Rectangle);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView(Positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates),
+        Containers::arrayView(TextureCoordinates),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void LayoutCacheTest::findDifferentKey() {
+    LayoutCache cache{1024};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    CORRADE_VERIFY(!cache.find(anotherFont, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, anotherGlyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 2.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "b", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "a", Alignment::LineRight, positions, textureCoordinates));
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 5);
+
+    /* The outputs weren't touched */
+    CORRADE_COMPARE(positions[0], Vector2{});
+    CORRADE_COMPARE(textureCoordinates[0], Vector2{});
+}
+
+void LayoutCacheTest::findDoesntFit() {
+    LayoutCache cache{1024};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+
+    /* Same as with renderInto(), only the vertices that fit are copied and
+       the caller is expected to check the glyph count */
+    Vector2 positions[2];
+    Vector2 textureCoordinates[2];
+    Containers::Optional<std::pair<UnsignedInt, Range2D>> found = cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found->first, 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(positions),
+        Containers::arrayView(Positions).prefix(2),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(textureCoordinates),
+        Containers::arrayView(TextureCoordinates).prefix(2),
+        TestSuite::Compare::Container);
+}
+
+void LayoutCacheTest::insertReplace() {
+    LayoutCache cache{1024};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    const std::size_t memoryUsage = cache.memoryUsage();
+
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, TextureCoordinates, Positions, {});
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.memoryUsage(), memoryUsage);
+
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    Containers::Optional<std::pair<UnsignedInt, Range2D>> found = cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates);
+    CORRADE_VERIFY(found);
+    CORRADE_COMPARE(found->second, Range2D{});
+    CORRADE_COMPARE(positions[0], TextureCoordinates[0]);
+    CORRADE_COMPARE(textureCoordinates[0], Positions[0]);
+}
+
+void LayoutCacheTest::evict() {
+    /* Measure how much a single-glyph layout with a single-character text
+       takes */
+    std::size_t cost;
+    {
+        LayoutCache cache{1024};
+        cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+        cost = cache.memoryUsage();
+    }
+
+    /* Space for two and a half such layouts */
+    LayoutCache cache{cost*5/2};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    cache.insert(font, glyphCache, 1.0f, "b", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    CORRADE_COMPARE(cache.size(), 2);
+    CORRADE_COMPARE(cache.memoryUsage(), cost*2);
+
+    /* Using "a" makes "b" the least recently used, so it gets evicted */
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    cache.insert(font, glyphCache, 1.0f, "c", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    CORRADE_COMPARE(cache.size(), 2);
+    CORRADE_COMPARE(cache.memoryUsage(), cost*2);
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "b", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "c", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_COMPARE(cache.hitCount(), 3);
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void LayoutCacheTest::insertTooLarge() {
+    std::size_t cost;
+    {
+        LayoutCache cache{1024};
+        cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+        cost = cache.memoryUsage();
+    }
+
+    /* A layout with a longer text doesn't fit, but doesn't evict the other
+       one either */
+    LayoutCache cache{cost};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    cache.insert(font, glyphCache, 1.0f, "ab", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+    CORRADE_COMPARE(cache.size(), 1);
+    CORRADE_COMPARE(cache.memoryUsage(), cost);
+
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "ab", Alignment::LineLeft, positions, textureCoordinates));
+}
+
+void LayoutCacheTest::clear() {
+    LayoutCache cache{1024};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+
+    /* The counters stay */
+    cache.clear();
+    CORRADE_COMPARE(cache.size(), 0);
+    CORRADE_COMPARE(cache.memoryUsage(), 0);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_COMPARE(cache.missCount(), 1);
+}
+
+void LayoutCacheTest::resetCounters() {
+    LayoutCache cache{1024};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Positions, TextureCoordinates, Rectangle);
+
+    Vector2 positions[4];
+    Vector2 textureCoordinates[4];
+    CORRADE_VERIFY(cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates));
+    CORRADE_VERIFY(!cache.find(font, glyphCache, 1.0f, "b", Alignment::LineLeft, positions, textureCoordinates));
+
+    /* The layouts stay */
+    cache.resetCounters();
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 0);
+    CORRADE_COMPARE(cache.size(), 1);
+}
+
+void LayoutCacheTest::findInvalidViews() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    LayoutCache cache{1024};
+    Vector2 positions[4];
+    Vector2 textureCoordinates[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.find(font, glyphCache, 1.0f, "a", Alignment::LineLeft, positions, textureCoordinates);
+    CORRADE_COMPARE(out.str(),
+        "Text::LayoutCache::find(): expected positions and texture coordinates to have the same size, got 4 and 3\n");
+}
+
+void LayoutCacheTest::insertInvalidViews() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    LayoutCache cache{1024};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Containers::arrayView(Positions), Containers::arrayView(TextureCoordinates).prefix(3), Rectangle);
+    cache.insert(font, glyphCache, 1.0f, "a", Alignment::LineLeft, Containers::arrayView(Positions).prefix(3), Containers::arrayView(TextureCoordinates).prefix(3), Rectangle);
+    CORRADE_COMPARE(out.str(),
+        "Text::LayoutCache::insert(): expected positions and texture coordinates to have the same size, got 4 and 3\n"
+        "Text::LayoutCache::insert(): expected vertex count to be divisible by four, got 3\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::LayoutCacheTest)
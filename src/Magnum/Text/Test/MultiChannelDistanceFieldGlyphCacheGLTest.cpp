@@ -0,0 +1,124 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Text/MultiChannelDistanceFieldGlyphCache.h"
+#include "Magnum/TextureTools/MultiChannelDistanceField.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct MultiChannelDistanceFieldGlyphCacheGLTest: GL::OpenGLTester {
+    explicit MultiChannelDistanceFieldGlyphCacheGLTest();
+
+    void initialize();
+    void setImage();
+    void setDistanceFieldImage();
+};
+
+MultiChannelDistanceFieldGlyphCacheGLTest::MultiChannelDistanceFieldGlyphCacheGLTest() {
+    addTests({&MultiChannelDistanceFieldGlyphCacheGLTest::initialize,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setImage,
+              &MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage});
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::initialize() {
+    MultiChannelDistanceFieldGlyphCache cache({1024, 2048}, {128, 256}, 16);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(cache.radius(), 16);
+    CORRADE_COMPARE(cache.padding(), (Vector2i{16}));
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(cache.texture().imageSize(0), (Vector2i{128, 256}));
+    #endif
+}
+
+/* A square, downscaled four times to an 8x8 square in a 16x16 output */
+Containers::Array<char> squareData() {
+    Containers::Array<char> data{Containers::ValueInit, 64*64};
+    for(Int y = 16; y != 48; ++y) for(Int x = 16; x != 48; ++x)
+        data[y*64 + x] = '\xff';
+    return data;
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setImage() {
+    Containers::Array<char> input = squareData();
+    const ImageView2D inputImage{PixelFormat::R8Unorm, {64, 64}, input};
+
+    MultiChannelDistanceFieldGlyphCache cache{{128, 128}, {32, 32}, 8, 2};
+    cache.setImage({64, 0}, inputImage);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    /* The uploaded part should be the same as calculated directly, the rest
+       untouched */
+    Image2D expected = TextureTools::multiChannelDistanceField(inputImage, {16, 16}, 8);
+    Image2D actual = cache.texture().image(0, {PixelFormat::RGB8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(actual.size(), (Vector2i{32, 32}));
+
+    const Containers::StridedArrayView2D<const Color3ub> expectedPixels = expected.pixels<Color3ub>();
+    const Containers::StridedArrayView2D<const Color3ub> actualPixels = actual.pixels<Color3ub>();
+    for(std::size_t y = 0; y != 16; ++y) for(std::size_t x = 0; x != 16; ++x) {
+        CORRADE_ITERATION(x, y);
+        CORRADE_COMPARE(actualPixels[y][16 + x], expectedPixels[y][x]);
+    }
+    #else
+    CORRADE_SKIP("Texture image download not available on OpenGL ES.");
+    #endif
+}
+
+void MultiChannelDistanceFieldGlyphCacheGLTest::setDistanceFieldImage() {
+    Color3ub data[4*4];
+    for(std::size_t i = 0; i != Containers::arraySize(data); ++i)
+        data[i] = Color3ub{UnsignedByte(i*16), UnsignedByte(255 - i*16), 0x7f};
+
+    MultiChannelDistanceFieldGlyphCache cache{{64, 64}, {16, 16}, 4};
+    cache.setDistanceFieldImage({4, 8}, ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {4, 4}, data});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D actual = cache.texture().image(0, {PixelFormat::RGB8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    const Containers::StridedArrayView2D<const Color3ub> actualPixels = actual.pixels<Color3ub>();
+    for(std::size_t y = 0; y != 4; ++y) for(std::size_t x = 0; x != 4; ++x) {
+        CORRADE_ITERATION(x, y);
+        CORRADE_COMPARE(actualPixels[8 + y][4 + x], data[y*4 + x]);
+    }
+    #else
+    CORRADE_SKIP("Texture image download not available on OpenGL ES.");
+    #endif
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MultiChannelDistanceFieldGlyphCacheGLTest)
@@ -0,0 +1,224 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/LayoutCache.h"
+#include "Magnum/Text/Renderer.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct RendererBenchmarkGLTest: GL::OpenGLTester {
+    explicit RendererBenchmarkGLTest();
+
+    void render();
+    void renderInto();
+    void renderIntoReuseLayouter();
+    void renderIntoLayoutCache();
+    void mutableText();
+};
+
+const struct {
+    const char* name;
+    std::size_t length;
+} TextData[]{
+    {"16 characters", 16},
+    {"256 characters", 256},
+    {"4k characters", 4096},
+    {"64k characters", 65536}
+};
+
+RendererBenchmarkGLTest::RendererBenchmarkGLTest() {
+    addInstancedBenchmarks({&RendererBenchmarkGLTest::render,
+                            &RendererBenchmarkGLTest::renderInto,
+                            &RendererBenchmarkGLTest::renderIntoReuseLayouter,
+                            &RendererBenchmarkGLTest::renderIntoLayoutCache,
+                            &RendererBenchmarkGLTest::mutableText}, 10,
+        Containers::arraySize(TextData));
+}
+
+/* Same as in RendererGLTest, except that all glyphs have the same size so the
+   quads don't grow with the text length */
+class TestLayouter: public Text::AbstractLayouter {
+    public:
+        explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
+
+        void reset(Float size, std::size_t glyphCount) {
+            _size = size;
+            setGlyphCount(glyphCount);
+        }
+
+    private:
+        std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
+            return std::make_tuple(
+                Range2D({}, Vector2(3.0f, 2.0f)*_size),
+                Range2D::fromSize({(i % 16)*6.0f, 0.0f}, {6.0f, 10.0f}),
+                Vector2::xAxis(4.0f)*_size
+            );
+        }
+
+        Float _size;
+};
+
+class TestFont: public Text::AbstractFont {
+    private:
+        FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, const Float size, const std::string& text) override {
+            return Containers::Pointer<AbstractLayouter>(new TestLayouter(size, text.size()));
+        }
+
+        bool doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache&, const Float size, const Containers::StringView text) override {
+            static_cast<TestLayouter&>(layouter).reset(size, text.size());
+            return true;
+        }
+};
+
+/* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
+char glyphCacheData;
+GlyphCache& nullGlyphCache = *reinterpret_cast<GlyphCache*>(&glyphCacheData);
+
+std::string repeatedText(std::size_t length) {
+    return std::string(length, 'a');
+}
+
+void RendererBenchmarkGLTest::render() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TestFont font;
+    const std::string text = repeatedText(data.length);
+
+    std::vector<Vector2> positions;
+    std::vector<Vector2> textureCoordinates;
+    std::vector<UnsignedInt> indices;
+    Range2D bounds;
+    CORRADE_BENCHMARK(1)
+        std::tie(positions, textureCoordinates, indices, bounds) = Text::AbstractRenderer::render(font, nullGlyphCache, 0.25f, text, Alignment::MiddleCenter);
+
+    CORRADE_COMPARE(positions.size(), data.length*4);
+    CORRADE_COMPARE(indices.size(), data.length*6);
+}
+
+void RendererBenchmarkGLTest::renderInto() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TestFont font;
+    const std::string text = repeatedText(data.length);
+    Containers::Array<Vector2> positions{Containers::NoInit, data.length*4};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, data.length*4};
+
+    UnsignedInt glyphCount{};
+    CORRADE_BENCHMARK(1)
+        glyphCount = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, text, positions, textureCoordinates, Alignment::MiddleCenter).first;
+
+    CORRADE_COMPARE(glyphCount, UnsignedInt(data.length));
+}
+
+void RendererBenchmarkGLTest::renderIntoReuseLayouter() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TestFont font;
+    const std::string text = repeatedText(data.length);
+    Containers::Array<Vector2> positions{Containers::NoInit, data.length*4};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, data.length*4};
+
+    /* Render once so the measured call reuses the layouter allocation */
+    Containers::Pointer<AbstractLayouter> layouter;
+    Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, text, positions, textureCoordinates, layouter, Alignment::MiddleCenter);
+
+    UnsignedInt glyphCount{};
+    CORRADE_BENCHMARK(1)
+        glyphCount = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, text, positions, textureCoordinates, layouter, Alignment::MiddleCenter).first;
+
+    CORRADE_COMPARE(glyphCount, UnsignedInt(data.length));
+}
+
+void RendererBenchmarkGLTest::renderIntoLayoutCache() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    TestFont font;
+    const std::string text = repeatedText(data.length);
+    Containers::Array<Vector2> positions{Containers::NoInit, data.length*4};
+    Containers::Array<Vector2> textureCoordinates{Containers::NoInit, data.length*4};
+
+    /* Big enough to fit the largest text, the first render is a miss that
+       puts the layout into the cache, the measured one is a hit */
+    LayoutCache layoutCache{data.length*4*2*sizeof(Vector2) + 4096};
+    Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, text, positions, textureCoordinates, layoutCache, Alignment::MiddleCenter);
+
+    UnsignedInt glyphCount{};
+    CORRADE_BENCHMARK(1)
+        glyphCount = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, text, positions, textureCoordinates, layoutCache, Alignment::MiddleCenter).first;
+
+    CORRADE_COMPARE(glyphCount, UnsignedInt(data.length));
+    CORRADE_VERIFY(layoutCache.hitCount() >= 1);
+}
+
+void RendererBenchmarkGLTest::mutableText() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    TestFont font;
+    const std::string text = repeatedText(data.length);
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f, Alignment::MiddleCenter);
+    renderer.reserve(data.length, GL::BufferUsage::DynamicDraw, GL::BufferUsage::StaticDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_BENCHMARK(1)
+        renderer.render(text);
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), Int(data.length*6));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::RendererBenchmarkGLTest)
@@ -24,12 +24,19 @@
 */
 
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
 #include "Magnum/GL/Context.h"
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/OpenGLTester.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/Shaders/DistanceFieldVector.h"
+#include "Magnum/Shaders/Vector.h"
+#endif
 #include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/LayoutCache.h"
 #include "Magnum/Text/Renderer.h"
 
 namespace Magnum { namespace Text { namespace Test { namespace {
@@ -41,6 +48,15 @@ struct RendererGLTest: GL::OpenGLTester {
     void renderMesh();
     void renderMeshIndexType();
     void mutableText();
+    void mutableTextReuseLayouter();
+    void renderInto();
+    void renderIntoReuseLayouter();
+    void renderIntoLayoutCache();
+    void mutableTextLayoutCache();
+    #ifndef MAGNUM_TARGET_GLES2
+    void batch();
+    void batchReuseLayouter();
+    #endif
 
     void multiline();
 };
@@ -50,6 +66,15 @@ RendererGLTest::RendererGLTest() {
               &RendererGLTest::renderMesh,
               &RendererGLTest::renderMeshIndexType,
               &RendererGLTest::mutableText,
+              &RendererGLTest::mutableTextReuseLayouter,
+              &RendererGLTest::renderInto,
+              &RendererGLTest::renderIntoReuseLayouter,
+              &RendererGLTest::renderIntoLayoutCache,
+              &RendererGLTest::mutableTextLayoutCache,
+              #ifndef MAGNUM_TARGET_GLES2
+              &RendererGLTest::batch,
+              &RendererGLTest::batchReuseLayouter,
+              #endif
 
               &RendererGLTest::multiline});
 }
@@ -58,6 +83,11 @@ class TestLayouter: public Text::AbstractLayouter {
     public:
         explicit TestLayouter(Float size, std::size_t glyphCount): AbstractLayouter(glyphCount), _size(size) {}
 
+        void reset(Float size, std::size_t glyphCount) {
+            _size = size;
+            setGlyphCount(glyphCount);
+        }
+
     private:
         std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override {
             return std::make_tuple(
@@ -71,17 +101,35 @@ class TestLayouter: public Text::AbstractLayouter {
 };
 
 class TestFont: public Text::AbstractFont {
-    FontFeatures doFeatures() const override { return FontFeature::OpenData; }
+    protected:
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, const Float size, const std::string& text) override {
+            return Containers::Pointer<AbstractLayouter>(new TestLayouter(size, text.size()));
+        }
 
-    bool doIsOpened() const override { return true; }
-    void doClose() override {}
+    private:
+        FontFeatures doFeatures() const override { return FontFeature::OpenData; }
 
-    UnsignedInt doGlyphId(char32_t) override { return 0; }
-    Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
 
-    Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, const Float size, const std::string& text) override {
-        return Containers::Pointer<AbstractLayouter>(new TestLayouter(size, text.size()));
-    }
+        UnsignedInt doGlyphId(char32_t) override { return 0; }
+        Vector2 doGlyphAdvance(UnsignedInt) override { return {}; }
+};
+
+class ReusingTestFont: public TestFont {
+    public:
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, const Float size, const std::string& text) override {
+            ++layoutCalls;
+            return TestFont::doLayout(cache, size, text);
+        }
+
+        bool doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache&, const Float size, const Containers::StringView text) override {
+            ++relayoutCalls;
+            static_cast<TestLayouter&>(layouter).reset(size, text.size());
+            return true;
+        }
+
+        Int layoutCalls{}, relayoutCalls{};
 };
 
 /* *static_cast<GlyphCache*>(nullptr) makes Clang Analyzer grumpy */
@@ -324,6 +372,314 @@ void RendererGLTest::mutableText() {
     #endif
 }
 
+void RendererGLTest::mutableTextReuseLayouter() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    ReusingTestFont font;
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* First render creates the layouter */
+    renderer.render("abcd");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 0);
+    CORRADE_COMPARE(renderer.mesh().count(), 4*6);
+
+    /* Subsequent renders reuse it, including for empty text */
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    renderer.render("");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 0);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D{});
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 2);
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+
+    /* The output is the same as with a fresh layouter */
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    Containers::Array<char> vertices = renderer.vertexBuffer().data();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(vertices).prefix(48),
+        (Containers::Array<Float>{Containers::InPlaceInit, {
+            0.0f,  0.5f, 0.0f, 10.0f,
+            0.0f,  0.0f, 0.0f,  0.0f,
+            0.75f, 0.5f, 6.0f, 10.0f,
+            0.75f, 0.0f, 6.0f,  0.0f,
+
+            1.0f,  0.75f,  6.0f, 10.0f,
+            1.0f, -0.25f,  6.0f,  0.0f,
+            2.5f,  0.75f, 12.0f, 10.0f,
+            2.5f, -0.25f, 12.0f,  0.0f,
+
+            2.75f,  1.0f, 12.0f, 10.0f,
+            2.75f, -0.5f, 12.0f,  0.0f,
+            5.0f,   1.0f, 18.0f, 10.0f,
+            5.0f,  -0.5f, 18.0f,  0.0f
+        }}), TestSuite::Compare::Container);
+    #endif
+}
+
+void RendererGLTest::renderInto() {
+    TestFont font;
+
+    /* Interleaved vertex data with some extra space at the end */
+    struct Vertex {
+        Vector2 textureCoordinates;
+        Float padding;
+        Vector2 position;
+    };
+    Vertex vertices[16]{};
+
+    UnsignedInt glyphCount;
+    Range2D bounds;
+    std::tie(glyphCount, bounds) = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "abc",
+        Containers::stridedArrayView(vertices).slice(&Vertex::position),
+        Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates),
+        Alignment::MiddleRightIntegral);
+    CORRADE_COMPARE(glyphCount, 3);
+
+    /* Same as in renderData() */
+    const Vector2 offset{-5.0f, 0.0f};
+    CORRADE_COMPARE(bounds, Range2D({0.0f, -0.5f}, {5.0f, 1.0f}).translated(offset));
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(vertices).slice(&Vertex::position).prefix(12),
+        Containers::arrayView<Vector2>({
+            Vector2{0.0f,  0.5f} + offset,
+            Vector2{0.0f,  0.0f} + offset,
+            Vector2{0.75f, 0.5f} + offset,
+            Vector2{0.75f, 0.0f} + offset,
+
+            Vector2{1.0f,  0.75f} + offset,
+            Vector2{1.0f, -0.25f} + offset,
+            Vector2{2.5f,  0.75f} + offset,
+            Vector2{2.5f, -0.25f} + offset,
+
+            Vector2{2.75f,  1.0f} + offset,
+            Vector2{2.75f, -0.5f} + offset,
+            Vector2{5.0f,   1.0f} + offset,
+            Vector2{5.0f,  -0.5f} + offset
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates).prefix(12),
+        Containers::arrayView<Vector2>({
+            {0.0f, 10.0f}, {0.0f, 0.0f}, {6.0f, 10.0f}, {6.0f, 0.0f},
+            {6.0f, 10.0f}, {6.0f, 0.0f}, {12.0f, 10.0f}, {12.0f, 0.0f},
+            {12.0f, 10.0f}, {12.0f, 0.0f}, {18.0f, 10.0f}, {18.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+
+    /* The rest is untouched */
+    for(std::size_t i = 12; i != 16; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(vertices[i].position, Vector2{});
+        CORRADE_COMPARE(vertices[i].padding, 0.0f);
+    }
+}
+
+void RendererGLTest::renderIntoReuseLayouter() {
+    ReusingTestFont font;
+    Vector2 positions[8];
+    Vector2 textureCoordinates[8];
+
+    Containers::Pointer<AbstractLayouter> layouter;
+    UnsignedInt glyphCount;
+    Range2D bounds;
+    std::tie(glyphCount, bounds) = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "a\nbc", Containers::arrayView(positions), Containers::arrayView(textureCoordinates), layouter);
+    CORRADE_COMPARE(glyphCount, 3);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 1);
+
+    /* The layouter is reused also across calls */
+    std::tie(glyphCount, bounds) = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "ab", Containers::arrayView(positions), Containers::arrayView(textureCoordinates), layouter);
+    CORRADE_COMPARE(glyphCount, 2);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 2);
+    CORRADE_COMPARE(bounds, Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+}
+
+void RendererGLTest::renderIntoLayoutCache() {
+    ReusingTestFont font;
+    LayoutCache layoutCache{4096};
+    Vector2 positions[12];
+    Vector2 textureCoordinates[12];
+
+    /* First render is a miss, laid out with the cache layouter and put into
+       the cache */
+    UnsignedInt glyphCount;
+    Range2D bounds;
+    std::tie(glyphCount, bounds) = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "abc", Containers::arrayView(positions), Containers::arrayView(textureCoordinates), layoutCache, Alignment::MiddleRightIntegral);
+    CORRADE_COMPARE(glyphCount, 3);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(layoutCache.hitCount(), 0);
+    CORRADE_COMPARE(layoutCache.missCount(), 1);
+    CORRADE_COMPARE(layoutCache.size(), 1);
+    CORRADE_VERIFY(layoutCache.layouter());
+
+    /* Second render of the same text is a hit and doesn't lay out anything */
+    Vector2 cachedPositions[12];
+    Vector2 cachedTextureCoordinates[12];
+    UnsignedInt cachedGlyphCount;
+    Range2D cachedBounds;
+    std::tie(cachedGlyphCount, cachedBounds) = Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "abc", Containers::arrayView(cachedPositions), Containers::arrayView(cachedTextureCoordinates), layoutCache, Alignment::MiddleRightIntegral);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 0);
+    CORRADE_COMPARE(layoutCache.hitCount(), 1);
+    CORRADE_COMPARE(layoutCache.missCount(), 1);
+    CORRADE_COMPARE(cachedGlyphCount, glyphCount);
+    CORRADE_COMPARE(cachedBounds, bounds);
+    CORRADE_COMPARE_AS(Containers::arrayView(cachedPositions),
+        Containers::arrayView(positions),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(cachedTextureCoordinates),
+        Containers::arrayView(textureCoordinates),
+        TestSuite::Compare::Container);
+
+    /* Different alignment is a miss, reusing the cache layouter */
+    Text::AbstractRenderer::renderInto(font, nullGlyphCache, 0.25f, "abc", Containers::arrayView(positions), Containers::arrayView(textureCoordinates), layoutCache);
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 1);
+    CORRADE_COMPARE(layoutCache.missCount(), 2);
+    CORRADE_COMPARE(layoutCache.size(), 2);
+}
+
+void RendererGLTest::mutableTextLayoutCache() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::map_buffer_range>())
+        CORRADE_SKIP(GL::Extensions::ARB::map_buffer_range::string() + std::string(" is not supported"));
+    #elif defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::map_buffer_range>() &&
+       !GL::Context::current().isExtensionSupported<GL::Extensions::OES::mapbuffer>())
+        CORRADE_SKIP("No required extension is supported");
+    #endif
+
+    ReusingTestFont font;
+    LayoutCache layoutCache{4096};
+    Text::Renderer2D renderer(font, nullGlyphCache, 0.25f);
+    CORRADE_VERIFY(!renderer.layoutCache());
+    renderer.setLayoutCache(&layoutCache);
+    CORRADE_COMPARE(renderer.layoutCache(), &layoutCache);
+    renderer.reserve(4, GL::BufferUsage::DynamicDraw, GL::BufferUsage::DynamicDraw);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    renderer.render("abc");
+    renderer.render("ab");
+    renderer.render("abc");
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 1);
+    CORRADE_COMPARE(layoutCache.hitCount(), 1);
+    CORRADE_COMPARE(layoutCache.missCount(), 2);
+
+    /* Same as in mutableText() */
+    CORRADE_COMPARE(renderer.mesh().count(), 3*6);
+    CORRADE_COMPARE(renderer.rectangle(), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void RendererGLTest::batch() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::gpu_shader4>())
+        CORRADE_SKIP(GL::Extensions::EXT::gpu_shader4::string() + std::string(" is not supported"));
+    #endif
+
+    TestFont font;
+    Text::BatchRenderer2D renderer{font, nullGlyphCache, 0.25f, 8, 4};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.glyphCapacity(), 8);
+    CORRADE_COMPARE(renderer.runCapacity(), 4);
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.runCount(), 0);
+
+    /* Each run is laid out after the previous one */
+    CORRADE_COMPARE(renderer.add("abc", Matrix3::translation({1.0f, 2.0f})), 0);
+    CORRADE_COMPARE(renderer.add("ab", Matrix3::scaling(Vector2{2.0f}), 3), 1);
+    CORRADE_COMPARE(renderer.glyphCount(), 5);
+    CORRADE_COMPARE(renderer.runCount(), 2);
+
+    /* The rectangles are without the run transformation, same as in
+       mutableText() and renderIntoReuseLayouter() */
+    CORRADE_COMPARE(renderer.rectangle(0), Range2D({0.0f, -0.5f}, {5.0f, 1.0f}));
+    CORRADE_COMPARE(renderer.rectangle(1), Range2D({0.0f, -0.25f}, {2.5f, 0.75f}));
+
+    /* Nothing is uploaded until drawn */
+    Shaders::Vector2D shader{Shaders::Vector2D::Flag::VertexDrawId, 4, 4};
+    renderer.setMaterialId(0, 2)
+        .setTransformation(1, Matrix3::translation({3.0f, 4.0f}))
+        .setProjectionMatrix(Matrix3::projection({10.0f, 10.0f}))
+        .draw(shader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(renderer.mesh().count(), 5*6);
+
+    /* Drawing with the other shader works too */
+    Shaders::DistanceFieldVector2D distanceFieldShader{Shaders::DistanceFieldVector2D::Flag::VertexDrawId, 4, 4};
+    renderer.draw(distanceFieldShader);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /** @todo How to verify this on ES? */
+    #ifndef MAGNUM_TARGET_GLES
+    struct Vertex {
+        Vector2 position, textureCoordinates;
+        UnsignedInt drawId;
+    };
+    Containers::Array<char> vertexData = renderer.vertexBuffer().data();
+    Containers::StridedArrayView1D<const Vertex> vertices = Containers::arrayCast<const Vertex>(vertexData).prefix(20);
+    CORRADE_COMPARE_AS(vertices.slice(&Vertex::position).prefix(4),
+        Containers::arrayView<Vector2>({
+            {0.0f,  0.5f},
+            {0.0f,  0.0f},
+            {0.75f, 0.5f},
+            {0.75f, 0.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(vertices.slice(&Vertex::drawId),
+        Containers::arrayView<UnsignedInt>({
+            0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            1, 1, 1, 1, 1, 1, 1, 1
+        }), TestSuite::Compare::Container);
+    #endif
+
+    /* Clearing keeps the capacity */
+    renderer.clear();
+    CORRADE_COMPARE(renderer.glyphCount(), 0);
+    CORRADE_COMPARE(renderer.runCount(), 0);
+    CORRADE_COMPARE(renderer.glyphCapacity(), 8);
+    CORRADE_COMPARE(renderer.runCapacity(), 4);
+    CORRADE_COMPARE(renderer.add("abcd", {}), 0);
+    CORRADE_COMPARE(renderer.glyphCount(), 4);
+}
+
+void RendererGLTest::batchReuseLayouter() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::ARB::uniform_buffer_object>())
+        CORRADE_SKIP(GL::Extensions::ARB::uniform_buffer_object::string() + std::string(" is not supported"));
+    #endif
+
+    ReusingTestFont font;
+    Text::BatchRenderer2D renderer{font, nullGlyphCache, 0.25f, 16, 4};
+    renderer.add("abc", {});
+    renderer.add("", {});
+    renderer.add("ab", {});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(font.layoutCalls, 1);
+    CORRADE_COMPARE(font.relayoutCalls, 2);
+    CORRADE_COMPARE(renderer.runCount(), 3);
+    CORRADE_COMPARE(renderer.glyphCount(), 5);
+    CORRADE_COMPARE(renderer.rectangle(1), Range2D{});
+}
+#endif
+
 void RendererGLTest::multiline() {
     class Layouter: public Text::AbstractLayouter {
         public:
@@ -39,6 +39,7 @@ class AbstractFont;
 class AbstractFontConverter;
 class AbstractGlyphCache;
 class AbstractLayouter;
+class LayoutCache;
 
 enum class Alignment: UnsignedByte;
 
@@ -46,10 +47,16 @@ class AbstractGlyphCache;
 #ifdef MAGNUM_TARGET_GL
 class DistanceFieldGlyphCache;
 class GlyphCache;
+class MultiChannelDistanceFieldGlyphCache;
 class AbstractRenderer;
 template<UnsignedInt> class Renderer;
 typedef Renderer<2> Renderer2D;
 typedef Renderer<3> Renderer3D;
+#ifndef MAGNUM_TARGET_GLES2
+template<UnsignedInt> class BatchRenderer;
+typedef BatchRenderer<2> BatchRenderer2D;
+typedef BatchRenderer<3> BatchRenderer3D;
+#endif
 #endif
 #endif
 
@@ -84,7 +84,7 @@ See @ref building, @ref cmake and the @ref Text namespace for more information.
 magnum-fontconverter [--magnum-...] [-h|--help] --font FONT
     --converter CONVERTER [--plugin-dir DIR] [--characters CHARACTERS]
     [--font-size N] [--atlas-size "X Y"] [--output-size "X Y"] [--radius N]
-    [--] input output
+    [--jump-flood] [--] input output
 @endcode
 
 Arguments:
@@ -102,6 +102,9 @@ Arguments:
 -   `--output-size "X Y"` --- output atlas size. If set to zero size, distance
     field computation will not be used. (default: `"256 256"`)
 -   `--radius N` --- distance field computation radius (default: `24`)
+-   `--jump-flood` --- use @ref TextureTools::DistanceFieldAlgorithm::JumpFlood
+    for distance field computation, which is significantly faster for large
+    radii. Not available on OpenGL ES 2.0 and WebGL 1.0.
 -   `--magnum-...` --- engine-specific options (see
     @ref GL-Context-command-line for details)
 
@@ -153,6 +156,9 @@ FontConverter::FontConverter(const Arguments& arguments): Platform::WindowlessAp
         .addOption("atlas-size", "2048 2048").setHelp("atlas-size", "glyph atlas size", "\"X Y\"")
         .addOption("output-size", "256 256").setHelp("output-size", "output atlas size. If set to zero size, distance field computation will not be used.", "\"X Y\"")
         .addOption("radius", "24").setHelp("radius", "distance field computation radius", "N")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addBooleanOption("jump-flood").setHelp("jump-flood", "use the jump flooding algorithm for distance field computation")
+        #endif
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp("Converts font to raster one of given atlas size.")
         .parse(arguments.argc, arguments.argv);
@@ -191,10 +197,15 @@ int FontConverter::exec() {
     if(!args.value<Vector2i>("output-size").isZero()) {
         Debug() << "Populating distance field glyph cache...";
 
+        TextureTools::DistanceFieldAlgorithm algorithm = TextureTools::DistanceFieldAlgorithm::BruteForce;
+        #ifndef MAGNUM_TARGET_GLES2
+        if(args.isSet("jump-flood"))
+            algorithm = TextureTools::DistanceFieldAlgorithm::JumpFlood;
+        #endif
         cache.reset(new Text::DistanceFieldGlyphCache(
             args.value<Vector2i>("atlas-size"),
             args.value<Vector2i>("output-size"),
-            args.value<Int>("radius")));
+            args.value<Int>("radius"), algorithm));
 
     /* Otherwise use normal cache */
     } else {
@@ -25,38 +25,301 @@
 
 #include "Atlas.h"
 
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
 #include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 
 namespace Magnum { namespace TextureTools {
 
-std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
-    if(sizes.empty()) return {};
+namespace {
 
-    /* Size of largest texture */
-    Vector2i maxSize;
-    for(const Vector2i& size: sizes)
-        maxSize = Math::max(maxSize, size);
+/* A horizontal segment of the top edge of everything placed in a layer so
+   far. The segments are sorted by X and cover the whole layer width. */
+struct SkylineNode {
+    Int x, y, width;
+};
 
-    std::vector<Range2Di> atlas;
+/* Returns Y of the lowest position for a rectangle of given width starting
+   at node i, or -1 if it doesn't fit */
+Int fitAt(const std::vector<SkylineNode>& skyline, const std::size_t i, const Vector2i& layerSize, const Vector2i& size) {
+    const Int x = skyline[i].x;
+    if(x + size.x() > layerSize.x()) return -1;
+
+    Int y = 0;
+    Int widthLeft = size.x();
+    for(std::size_t j = i; widthLeft > 0; ++j) {
+        CORRADE_INTERNAL_ASSERT(j < skyline.size());
+        y = Math::max(y, skyline[j].y);
+        if(y + size.y() > layerSize.y()) return -1;
+        widthLeft -= skyline[j].width;
+    }
+
+    return y;
+}
+
+struct Fit {
+    std::size_t node;
+    Int y;
+    bool rotated;
+};
+
+/* Finds the position with the lowest top edge, ties are resolved by taking
+   the leftmost one. The padding is applied after rotation, so it's always
+   in the atlas space. */
+bool findFit(const std::vector<SkylineNode>& skyline, const Vector2i& layerSize, const Vector2i& size, const Vector2i& padding, const bool rotate, Fit& fit) {
+    const Vector2i paddedSize = size + 2*padding;
+    Int bestTop = layerSize.y() + 1;
+    for(std::size_t i = 0; i != skyline.size(); ++i) {
+        const Int y = fitAt(skyline, i, layerSize, paddedSize);
+        if(y != -1 && y + paddedSize.y() < bestTop) {
+            bestTop = y + paddedSize.y();
+            fit = {i, y, false};
+        }
 
-    /* Columns and rows */
-    const Vector2i paddedSize = maxSize+2*padding;
-    const Vector2i gridSize = atlasSize/paddedSize;
-    if(std::size_t(gridSize.product()) < sizes.size()) {
+        if(!rotate || size.x() == size.y()) continue;
+        const Vector2i rotatedSize = Vector2i{size.y(), size.x()} + 2*padding;
+        const Int yRotated = fitAt(skyline, i, layerSize, rotatedSize);
+        if(yRotated != -1 && yRotated + rotatedSize.y() < bestTop) {
+            bestTop = yRotated + rotatedSize.y();
+            fit = {i, yRotated, true};
+        }
+    }
+
+    return bestTop <= layerSize.y();
+}
+
+void place(std::vector<SkylineNode>& skyline, const std::size_t i, const Int y, const Vector2i& size) {
+    const Int x = skyline[i].x;
+    skyline.insert(skyline.begin() + i, SkylineNode{x, y + size.y(), size.x()});
+
+    /* Shrink or remove the nodes that are now covered by the new one */
+    const Int right = x + size.x();
+    const std::size_t next = i + 1;
+    while(next < skyline.size() && skyline[next].x < right) {
+        const Int overlap = right - skyline[next].x;
+        if(overlap < skyline[next].width) {
+            skyline[next].x += overlap;
+            skyline[next].width -= overlap;
+            break;
+        }
+        skyline.erase(skyline.begin() + next);
+    }
+
+    /* Merge neighbors of the same height */
+    for(std::size_t j = i ? i - 1 : 0; j + 1 < skyline.size() && j <= i + 1; ) {
+        if(skyline[j].y == skyline[j + 1].y) {
+            skyline[j].width += skyline[j + 1].width;
+            skyline.erase(skyline.begin() + j + 1);
+        } else ++j;
+    }
+}
+
+/* Sorts by height from the tallest, then by width */
+Containers::Array<UnsignedInt> sortedByHeight(const Containers::StridedArrayView1D<const Vector2i>& sizes, const bool rotate) {
+    Containers::Array<UnsignedInt> order{Containers::NoInit, sizes.size()};
+    for(std::size_t i = 0; i != order.size(); ++i) order[i] = i;
+    const auto key = [&](const UnsignedInt i) {
+        const Vector2i size = sizes[i];
+        /* With rotations allowed, the longer side is considered as height */
+        return rotate ? Vector2i{Math::min(size.x(), size.y()), Math::max(size.x(), size.y())} : size;
+    };
+    std::stable_sort(order.begin(), order.end(), [&](const UnsignedInt a, const UnsignedInt b) {
+        const Vector2i sizeA = key(a), sizeB = key(b);
+        return sizeA.y() > sizeB.y() || (sizeA.y() == sizeB.y() && sizeA.x() > sizeB.x());
+    });
+    return order;
+}
+
+Int atlasArrayInternal(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Containers::StridedArrayView1D<bool>& rotations, const bool rotate, const Vector2i& padding, const Int maxLayerCount) {
+    Containers::Array<UnsignedInt> order = sortedByHeight(sizes, rotate);
+
+    /* Skylines of all layers */
+    std::vector<std::vector<SkylineNode>> layers;
+    for(const UnsignedInt i: order) {
+        const Vector2i size = sizes[i];
+
+        /* Empty items don't occupy any space, put them to the first layer */
+        if(!(size + 2*padding).product()) {
+            offsets[i] = {padding, 0};
+            if(rotate) rotations[i] = false;
+            continue;
+        }
+
+        /* Put the item into the first layer where it fits */
+        std::size_t layer = 0;
+        Fit fit{};
+        for(; layer != layers.size(); ++layer)
+            if(findFit(layers[layer], layerSize, size, padding, rotate, fit))
+                break;
+
+        /* Doesn't fit into any, create a new layer */
+        if(layer == layers.size()) {
+            if(Int(layers.size()) == maxLayerCount) return -1;
+            layers.push_back({SkylineNode{0, 0, layerSize.x()}});
+            /* If it doesn't fit even into an empty layer, it's too large. The
+               public multi-layer APIs check that upfront, so this can happen
+               only in the single-layer case. */
+            if(!findFit(layers.back(), layerSize, size, padding, rotate, fit))
+                return -1;
+        }
+
+        const Int x = layers[layer][fit.node].x;
+        place(layers[layer], fit.node, fit.y, (fit.rotated ? Vector2i{size.y(), size.x()} : size) + 2*padding);
+        offsets[i] = {Vector2i{x, fit.y} + padding, Int(layer)};
+        if(rotate) rotations[i] = fit.rotated;
+    }
+
+    /* If there were only empty items, they're all in the first layer */
+    return Int(Math::max(std::size_t(sizes.empty() ? 0 : 1), layers.size()));
+}
+
+/* Checks that every item fits into an empty layer, either as-is or rotated */
+bool checkSizes(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const bool rotate, const Vector2i& padding) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        const Vector2i size = sizes[i];
+        CORRADE_ASSERT((size >= Vector2i{}).all() && ((size + 2*padding <= layerSize).all() || (rotate && (Vector2i{size.y(), size.x()} + 2*padding <= layerSize).all())),
+            "TextureTools::atlasArray(): expected size" << i << "to be non-negative and fit into" << layerSize << "with padding" << padding << "but got" << sizes[i], false);
+    }
+    #else
+    static_cast<void>(layerSize);
+    static_cast<void>(sizes);
+    static_cast<void>(rotate);
+    static_cast<void>(padding);
+    #endif
+    return true;
+}
+
+}
+
+std::vector<Range2Di> atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding) {
+    if(sizes.empty()) return {};
+
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+    if(atlasArrayInternal(atlasSize, Containers::arrayView(sizes), offsets, nullptr, false, padding, 1) == -1) {
         Error() << "TextureTools::atlas(): requested atlas size" << atlasSize
-                << "is too small to fit" << sizes.size() << paddedSize
+                << "is too small to fit" << sizes.size()
                 << "textures. Generated atlas will be empty.";
-        return atlas;
+        return {};
     }
 
-    /** @todo actual magic implementation, not this joke */
-
+    std::vector<Range2Di> atlas;
     atlas.reserve(sizes.size());
     for(std::size_t i = 0; i != sizes.size(); ++i)
-        atlas.push_back(Range2Di::fromSize(Vector2i(i%gridSize.x(), i/gridSize.x())*paddedSize+padding, sizes[i]));
+        atlas.push_back(Range2Di::fromSize(offsets[i].xy(), sizes[i]));
 
     return atlas;
 }
 
+Int atlasArray(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Vector2i& padding) {
+    CORRADE_ASSERT(offsets.size() == sizes.size(),
+        "TextureTools::atlasArray(): expected sizes and offsets views to have the same size, got" << sizes.size() << "and" << offsets.size(), {});
+    if(!checkSizes(layerSize, sizes, false, padding)) return {};
+    return atlasArrayInternal(layerSize, sizes, offsets, nullptr, false, padding, -1);
+}
+
+Int atlasArray(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Containers::StridedArrayView1D<bool>& rotations, const Vector2i& padding) {
+    CORRADE_ASSERT(offsets.size() == sizes.size() && rotations.size() == sizes.size(),
+        "TextureTools::atlasArray(): expected sizes, offsets and rotations views to have the same size, got" << sizes.size() << Debug::nospace << "," << offsets.size() << "and" << rotations.size(), {});
+    if(!checkSizes(layerSize, sizes, true, padding)) return {};
+    return atlasArrayInternal(layerSize, sizes, offsets, rotations, true, padding, -1);
+}
+
+struct AtlasPacker::State {
+    Vector2i size, padding;
+    std::size_t count, usedArea;
+    std::vector<SkylineNode> skyline;
+};
+
+AtlasPacker::AtlasPacker(const Vector2i& size, const Vector2i& padding): _state{Containers::InPlaceInit} {
+    CORRADE_ASSERT((size >= Vector2i{}).all(),
+        "TextureTools::AtlasPacker: expected non-negative size, got" << size, );
+    _state->size = size;
+    _state->padding = padding;
+    clear();
+}
+
+AtlasPacker::AtlasPacker(AtlasPacker&&) noexcept = default;
+
+AtlasPacker::~AtlasPacker() = default;
+
+AtlasPacker& AtlasPacker::operator=(AtlasPacker&&) noexcept = default;
+
+Vector2i AtlasPacker::size() const { return _state->size; }
+
+Vector2i AtlasPacker::padding() const { return _state->padding; }
+
+std::size_t AtlasPacker::count() const { return _state->count; }
+
+std::size_t AtlasPacker::usedArea() const { return _state->usedArea; }
+
+std::size_t AtlasPacker::freeArea() const {
+    return std::size_t(_state->size.product()) - _state->usedArea;
+}
+
+Int AtlasPacker::filledHeight() const {
+    Int height = 0;
+    for(const SkylineNode& node: _state->skyline)
+        height = Math::max(height, node.y);
+    return height;
+}
+
+Containers::Optional<Vector2i> AtlasPacker::add(const Vector2i& size) {
+    Vector2i offset;
+    if(!add(Containers::stridedArrayView(&size, 1), Containers::stridedArrayView(&offset, 1)))
+        return {};
+    return offset;
+}
+
+bool AtlasPacker::add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector2i>& offsets) {
+    CORRADE_ASSERT(offsets.size() == sizes.size(),
+        "TextureTools::AtlasPacker::add(): expected sizes and offsets views to have the same size, got" << sizes.size() << "and" << offsets.size(), {});
+
+    State& state = *_state;
+
+    /* Make a copy of the skyline so the state can be restored if anything
+       doesn't fit. Usually it's just a few dozen nodes. */
+    std::vector<SkylineNode> skyline = state.skyline;
+    std::size_t usedArea = state.usedArea;
+
+    for(const UnsignedInt i: sortedByHeight(sizes, false)) {
+        const Vector2i size = sizes[i];
+        CORRADE_ASSERT((size >= Vector2i{}).all(),
+            "TextureTools::AtlasPacker::add(): expected non-negative size, got" << size, {});
+
+        /* Empty items don't occupy any space */
+        const Vector2i paddedSize = size + 2*state.padding;
+        if(!paddedSize.product()) {
+            offsets[i] = state.padding;
+            continue;
+        }
+
+        Fit fit;
+        if(!findFit(skyline, state.size, size, state.padding, false, fit))
+            return false;
+
+        const Int x = skyline[fit.node].x;
+        place(skyline, fit.node, fit.y, paddedSize);
+        offsets[i] = Vector2i{x, fit.y} + state.padding;
+        usedArea += paddedSize.product();
+    }
+
+    state.skyline = std::move(skyline);
+    state.usedArea = usedArea;
+    state.count += sizes.size();
+    return true;
+}
+
+void AtlasPacker::clear() {
+    _state->count = 0;
+    _state->usedArea = 0;
+    _state->skyline.assign({SkylineNode{0, 0, _state->size.x()}});
+}
+
 }}
@@ -26,10 +26,13 @@
 */
 
 /** @file
- * @brief Function @ref Magnum::TextureTools::atlas()
+ * @brief Class @ref Magnum::TextureTools::AtlasPacker, function @ref Magnum::TextureTools::atlas(), @ref Magnum::TextureTools::atlasArray()
  */
 
 #include <vector>
+#include <Corrade/Containers/Containers.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Math/Vector2.h"
@@ -49,9 +52,179 @@ into required size, empty vector is returned.
 Padding is added twice to each size and the atlas is laid out so the padding
 don't overlap. Returned sizes are the same as original sizes, i.e. without the
 padding.
+
+Uses the same algorithm as @ref atlasArray(), but with just a single layer and
+without rotations.
 */
 std::vector<Range2Di> MAGNUM_TEXTURETOOLS_EXPORT atlas(const Vector2i& atlasSize, const std::vector<Vector2i>& sizes, const Vector2i& padding = Vector2i());
 
+/**
+@brief Pack textures into a texture array atlas
+@param[in] layerSize    Size of a single layer
+@param[in] sizes        Sizes of all textures in the atlas
+@param[out] offsets     Resulting offsets in the atlas
+@param[in] padding      Padding around each texture
+@return Count of layers used
+@m_since_latest
+
+Packs textures of given @p sizes into as few layers of @p layerSize as
+possible and fills @p offsets with the position of each texture, with the Z
+coordinate being the layer index. The result can be directly used as
+offsets in @ref GL::Texture2DArray::setSubImage().
+
+The packing uses a skyline bottom-left heuristic --- textures are sorted by
+height from the tallest, and each is then placed at the lowest position
+along the top edge ("skyline") of textures placed so far, preferring the
+leftmost position in case of a tie. Compared to laying the textures out in a
+uniform grid, textures of varying sizes waste considerably less space. A new
+layer is started only if a texture doesn't fit into any of the previous
+layers.
+
+Padding is added twice to each size and the atlas is laid out so the padding
+don't overlap. Expects that @p sizes and @p offsets have the same size and
+that all sizes including the padding are non-negative and fit into
+@p layerSize.
+@see @ref atlasArray(const Vector2i&, const Containers::StridedArrayView1D<const Vector2i>&, const Containers::StridedArrayView1D<Vector3i>&, const Containers::StridedArrayView1D<bool>&, const Vector2i&)
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Int atlasArray(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Vector2i& padding = {});
+
+/**
+@brief Pack textures into a texture array atlas, allowing rotations
+@param[in] layerSize    Size of a single layer
+@param[in] sizes        Sizes of all textures in the atlas
+@param[out] offsets     Resulting offsets in the atlas
+@param[out] rotations   Whether given texture was rotated
+@param[in] padding      Padding around each texture
+@return Count of layers used
+@m_since_latest
+
+Like @ref atlasArray(const Vector2i&, const Containers::StridedArrayView1D<const Vector2i>&, const Containers::StridedArrayView1D<Vector3i>&, const Vector2i&),
+but additionally each texture is rotated by 90° if it results in a lower
+skyline. For rotated textures the corresponding item in @p rotations is set
+to @cpp true @ce and the texture occupies a rectangle with width and height
+swapped at given offset. The padding is applied after the rotation, i.e.
+it's always in the atlas space. Expects that @p sizes, @p offsets and @p rotations have the same size.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Int atlasArray(const Vector2i& layerSize, const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector3i>& offsets, const Containers::StridedArrayView1D<bool>& rotations, const Vector2i& padding = {});
+
+/**
+@brief Incremental texture atlas packer
+@m_since_latest
+
+Unlike @ref atlas(), which packs a whole set of textures at once, keeps the
+packing state between calls and allows adding new textures as they're needed
+without touching the already placed ones. Useful for example for filling glyph
+caches lazily as new characters appear in the text.
+
+Uses the same skyline bottom-left heuristic as @ref atlasArray() --- each
+texture is placed at the lowest position along the top edge ("skyline") of
+textures placed so far. When adding more textures at once with
+@ref add(const Containers::StridedArrayView1D<const Vector2i>&, const Containers::StridedArrayView1D<Vector2i>&),
+they're sorted by height first, which results in a tighter packing than
+adding them one by one in an arbitrary order.
+
+@snippet MagnumTextureTools.cpp AtlasPacker-usage
+
+Padding is added twice to each size and the textures are laid out so the
+padding doesn't overlap. Returned offsets are of the textures themselves,
+i.e. without the padding.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT AtlasPacker {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Atlas size
+         * @param padding   Padding around each texture
+         *
+         * Expects that @p size is non-negative.
+         */
+        explicit AtlasPacker(const Vector2i& size, const Vector2i& padding = {});
+
+        /** @brief Copying is not allowed */
+        AtlasPacker(const AtlasPacker&) = delete;
+
+        /** @brief Move constructor */
+        AtlasPacker(AtlasPacker&&) noexcept;
+
+        ~AtlasPacker();
+
+        /** @brief Copying is not allowed */
+        AtlasPacker& operator=(const AtlasPacker&) = delete;
+
+        /** @brief Move assignment */
+        AtlasPacker& operator=(AtlasPacker&&) noexcept;
+
+        /** @brief Atlas size */
+        Vector2i size() const;
+
+        /** @brief Padding around each texture */
+        Vector2i padding() const;
+
+        /** @brief Count of textures added so far */
+        std::size_t count() const;
+
+        /**
+         * @brief Area used by textures added so far
+         *
+         * Including the padding.
+         */
+        std::size_t usedArea() const;
+
+        /**
+         * @brief Free area
+         *
+         * Atlas area minus @ref usedArea(). Note that the skyline packing
+         * can't use space below textures that are already placed, so this is
+         * an upper bound --- there's no guarantee that a texture of given area
+         * fits. Use @ref filledHeight() for an estimate of how much of the
+         * atlas is contiguously free.
+         */
+        std::size_t freeArea() const;
+
+        /**
+         * @brief Filled height
+         *
+         * Height of the tallest point of the skyline. Space above it is
+         * guaranteed to be free.
+         */
+        Int filledHeight() const;
+
+        /**
+         * @brief Add a texture
+         * @return Texture offset or @relativeref{Corrade,Containers::NullOpt}
+         *      if it doesn't fit
+         *
+         * Expects that @p size is non-negative. If the texture doesn't fit,
+         * the state is left unchanged.
+         */
+        Containers::Optional<Vector2i> add(const Vector2i& size);
+
+        /**
+         * @brief Add textures
+         * @param[in] sizes     Texture sizes
+         * @param[out] offsets  Resulting texture offsets
+         * @return Whether all textures fit
+         *
+         * The textures are sorted by height before being added. Either all of
+         * them are added or, if any doesn't fit, none of them and the state is
+         * left unchanged. In that case contents of @p offsets are
+         * unspecified. Expects that @p sizes and @p offsets have the same
+         * size and all sizes are non-negative.
+         */
+        bool add(const Containers::StridedArrayView1D<const Vector2i>& sizes, const Containers::StridedArrayView1D<Vector2i>& offsets);
+
+        /**
+         * @brief Clear the atlas
+         *
+         * Removes all textures, keeping the atlas size and padding.
+         */
+        void clear();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
 }}
 
 #endif
@@ -0,0 +1,330 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ConvertPixelFormat.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/PackingBatch.h"
+#include "Magnum/TextureTools/Implementation/pixelFormatInfo.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+using Implementation::Component;
+using Implementation::FormatInfo;
+using Implementation::formatInfo;
+
+/* sRGB to linear for all 256 values of an 8-bit channel. The function-local
+   static initialization is thread-safe. */
+struct SrgbToLinear {
+    explicit SrgbToLinear() {
+        for(UnsignedInt i = 0; i != 256; ++i)
+            data[i] = Color3::fromSrgb(Vector3{Float(i)/255.0f}).r();
+    }
+
+    Float data[256];
+};
+
+const Float* srgbToLinear() {
+    static const SrgbToLinear lut;
+    return lut.data;
+}
+
+/* Linear to 8-bit sRGB for a linear value quantized to 16 bits. The sRGB
+   curve is steepest near zero, with a slope of 12.92, where one 16-bit step
+   corresponds to about 0.05 of an 8-bit step, so the result differs from the
+   exact calculation only if it's very close to a rounding boundary. */
+struct LinearToSrgb {
+    explicit LinearToSrgb() {
+        for(UnsignedInt i = 0; i != 65536; ++i)
+            data[i] = Math::pack<UnsignedByte>(Color3{Float(i)/65535.0f}.toSrgb().r());
+    }
+
+    UnsignedByte data[65536];
+};
+
+const UnsignedByte* linearToSrgb() {
+    static const LinearToSrgb lut;
+    return lut.data;
+}
+
+/* Copies channels of count pixels, filling missing green and blue with zero
+   and missing alpha with given value. The channel counts are template
+   parameters so the inner loops get fully unrolled. */
+template<class T, bool swapRedBlue, UnsignedInt srcChannelCount, UnsignedInt dstChannelCount> void remap(const void* const srcData, void* const dstData, const std::size_t count, const T alpha) {
+    const T* src = static_cast<const T*>(srcData);
+    T* dst = static_cast<T*>(dstData);
+    for(std::size_t i = 0; i != count; ++i) {
+        T pixel[4]{T{}, T{}, T{}, alpha};
+        for(UnsignedInt c = 0; c != srcChannelCount; ++c)
+            pixel[c] = src[c];
+        if(swapRedBlue && srcChannelCount >= 3 && dstChannelCount >= 3) {
+            const T red = pixel[0];
+            pixel[0] = pixel[2];
+            pixel[2] = red;
+        }
+        for(UnsignedInt c = 0; c != dstChannelCount; ++c)
+            dst[c] = pixel[c];
+
+        src += srcChannelCount;
+        dst += dstChannelCount;
+    }
+}
+
+template<class T> using RemapKernel = void(*)(const void*, void*, std::size_t, T);
+
+template<class T, bool swapRedBlue, UnsignedInt srcChannelCount> RemapKernel<T> remapKernel(const UnsignedInt dstChannelCount) {
+    switch(dstChannelCount) {
+        case 1: return remap<T, swapRedBlue, srcChannelCount, 1>;
+        case 2: return remap<T, swapRedBlue, srcChannelCount, 2>;
+        case 3: return remap<T, swapRedBlue, srcChannelCount, 3>;
+        case 4: return remap<T, swapRedBlue, srcChannelCount, 4>;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T, bool swapRedBlue> RemapKernel<T> remapKernel(const UnsignedInt srcChannelCount, const UnsignedInt dstChannelCount) {
+    switch(srcChannelCount) {
+        case 1: return remapKernel<T, swapRedBlue, 1>(dstChannelCount);
+        case 2: return remapKernel<T, swapRedBlue, 2>(dstChannelCount);
+        case 3: return remapKernel<T, swapRedBlue, 3>(dstChannelCount);
+        case 4: return remapKernel<T, swapRedBlue, 4>(dstChannelCount);
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+template<class T> RemapKernel<T> remapKernel(const UnsignedInt srcChannelCount, const UnsignedInt dstChannelCount, const bool swapRedBlue) {
+    return swapRedBlue ?
+        remapKernel<T, true>(srcChannelCount, dstChannelCount) :
+        remapKernel<T, false>(srcChannelCount, dstChannelCount);
+}
+
+/* Remaps rows of the same component type without going through floats */
+template<class T> void remapRows(const Containers::StridedArrayView3D<const char>& src, const Containers::StridedArrayView3D<char>& dst, const std::size_t begin, const std::size_t end, const RemapKernel<T> kernel, const T alpha) {
+    const std::size_t width = src.size()[1];
+    for(std::size_t y = begin; y != end; ++y)
+        kernel(src[y].data(), dst[y].data(), width, alpha);
+}
+
+/* Decodes a row of source pixels to contiguous floats */
+void decodeRow(const Containers::StridedArrayView2D<const char>& src, const FormatInfo& info, const Containers::ArrayView<Float> dst) {
+    const Containers::StridedArrayView2D<Float> dst2D{dst, {src.size()[0], info.channelCount}};
+    switch(info.component) {
+        case Component::Unorm8:
+            Math::unpackInto(Containers::arrayCast<2, const UnsignedByte>(src), dst2D);
+            return;
+        case Component::Srgb8: {
+            const Float* const lut = srgbToLinear();
+            const UnsignedByte* in = static_cast<const UnsignedByte*>(src.data());
+            const std::size_t count = dst.size();
+            /* Alpha is linear */
+            if(info.channelCount == 4) for(std::size_t i = 0; i != count; i += 4) {
+                dst[i + 0] = lut[in[i + 0]];
+                dst[i + 1] = lut[in[i + 1]];
+                dst[i + 2] = lut[in[i + 2]];
+                dst[i + 3] = Math::unpack<Float>(in[i + 3]);
+            } else for(std::size_t i = 0; i != count; ++i)
+                dst[i] = lut[in[i]];
+        } return;
+        case Component::Snorm8:
+            Math::unpackInto(Containers::arrayCast<2, const Byte>(src), dst2D);
+            return;
+        case Component::Unorm16:
+            Math::unpackInto(Containers::arrayCast<2, const UnsignedShort>(src), dst2D);
+            return;
+        case Component::Snorm16:
+            Math::unpackInto(Containers::arrayCast<2, const Short>(src), dst2D);
+            return;
+        case Component::Half:
+            Math::unpackHalfInto(Containers::arrayCast<2, const UnsignedShort>(src), dst2D);
+            return;
+        case Component::Float:
+            std::memcpy(dst.data(), src.data(), dst.size()*sizeof(Float));
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+/* Encodes contiguous floats to a row of destination pixels, clamping them
+   to the representable range first */
+void encodeRow(const Containers::ArrayView<Float> src, const FormatInfo& info, const Containers::StridedArrayView2D<char>& dst) {
+    const Containers::StridedArrayView2D<const Float> src2D{src, {dst.size()[0], info.channelCount}};
+    switch(info.component) {
+        case Component::Unorm8:
+            for(Float& i: src) i = Math::clamp(i, 0.0f, 1.0f);
+            Math::packInto(src2D, Containers::arrayCast<2, UnsignedByte>(dst));
+            return;
+        case Component::Srgb8: {
+            const UnsignedByte* const lut = linearToSrgb();
+            UnsignedByte* out = static_cast<UnsignedByte*>(dst.data());
+            const std::size_t count = src.size();
+            const auto encode = [lut](const Float value) {
+                return lut[UnsignedInt(Math::clamp(value, 0.0f, 1.0f)*65535.0f + 0.5f)];
+            };
+            /* Alpha is linear */
+            if(info.channelCount == 4) for(std::size_t i = 0; i != count; i += 4) {
+                out[i + 0] = encode(src[i + 0]);
+                out[i + 1] = encode(src[i + 1]);
+                out[i + 2] = encode(src[i + 2]);
+                out[i + 3] = Math::pack<UnsignedByte>(Math::clamp(src[i + 3], 0.0f, 1.0f));
+            } else for(std::size_t i = 0; i != count; ++i)
+                out[i] = encode(src[i]);
+        } return;
+        case Component::Snorm8:
+            for(Float& i: src) i = Math::clamp(i, -1.0f, 1.0f);
+            Math::packInto(src2D, Containers::arrayCast<2, Byte>(dst));
+            return;
+        case Component::Unorm16:
+            for(Float& i: src) i = Math::clamp(i, 0.0f, 1.0f);
+            Math::packInto(src2D, Containers::arrayCast<2, UnsignedShort>(dst));
+            return;
+        case Component::Snorm16:
+            for(Float& i: src) i = Math::clamp(i, -1.0f, 1.0f);
+            Math::packInto(src2D, Containers::arrayCast<2, Short>(dst));
+            return;
+        case Component::Half:
+            Math::packHalfInto(src2D, Containers::arrayCast<2, UnsignedShort>(dst));
+            return;
+        case Component::Float:
+            std::memcpy(dst.data(), src.data(), src.size()*sizeof(Float));
+            return;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+void convertPixelFormatInto(const ImageView2D& src, const MutableImageView2D& dst, const PixelFormatConversionFlags flags, UnsignedInt threadCount) {
+    const FormatInfo srcInfo = formatInfo(src.format());
+    const FormatInfo dstInfo = formatInfo(dst.format());
+    CORRADE_ASSERT(srcInfo.channelCount,
+        "TextureTools::convertPixelFormatInto(): unsupported source format" << src.format(), );
+    CORRADE_ASSERT(dstInfo.channelCount,
+        "TextureTools::convertPixelFormatInto(): unsupported destination format" << dst.format(), );
+    CORRADE_ASSERT(src.size() == dst.size(),
+        "TextureTools::convertPixelFormatInto(): expected destination size" << src.size() << "but got" << dst.size(), );
+
+    const Vector2i size = src.size();
+    if(!size.product()) return;
+
+    const Containers::StridedArrayView3D<const char> srcPixels = src.pixels();
+    const Containers::StridedArrayView3D<char> dstPixels = dst.pixels();
+    const bool swapRedBlue = (flags & PixelFormatConversionFlag::SwapRedBlue) && srcInfo.channelCount >= 3 && dstInfo.channelCount >= 3;
+
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), size.product());
+
+    /* Same format, just copy the rows */
+    if(src.format() == dst.format() && !swapRedBlue) {
+        const std::size_t rowSize = size.x()*pixelSize(src.format());
+        Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size.y(), threadCount, thread);
+            for(std::size_t y = range.first; y != range.second; ++y)
+                std::memcpy(dstPixels[y].data(), srcPixels[y].data(), rowSize);
+        });
+        return;
+    }
+
+    /* Same component type, only the channel count or order differs. Copy
+       the components directly. */
+    if(srcInfo.component == dstInfo.component) {
+        Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size.y(), threadCount, thread);
+            switch(srcInfo.component) {
+                case Component::Unorm8:
+                case Component::Srgb8:
+                    remapRows<UnsignedByte>(srcPixels, dstPixels, range.first, range.second, remapKernel<UnsignedByte>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 0xff);
+                    return;
+                case Component::Snorm8:
+                    remapRows<UnsignedByte>(srcPixels, dstPixels, range.first, range.second, remapKernel<UnsignedByte>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 0x7f);
+                    return;
+                case Component::Unorm16:
+                    remapRows<UnsignedShort>(srcPixels, dstPixels, range.first, range.second, remapKernel<UnsignedShort>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 0xffff);
+                    return;
+                case Component::Snorm16:
+                    remapRows<UnsignedShort>(srcPixels, dstPixels, range.first, range.second, remapKernel<UnsignedShort>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 0x7fff);
+                    return;
+                case Component::Half:
+                    /* 1.0 as a half-float */
+                    remapRows<UnsignedShort>(srcPixels, dstPixels, range.first, range.second, remapKernel<UnsignedShort>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 0x3c00);
+                    return;
+                case Component::Float:
+                    remapRows<Float>(srcPixels, dstPixels, range.first, range.second, remapKernel<Float>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue), 1.0f);
+                    return;
+            }
+
+            CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        });
+        return;
+    }
+
+    /* Otherwise go through floats, one row at a time to stay in cache */
+    const bool needsRemap = srcInfo.channelCount != dstInfo.channelCount || swapRedBlue;
+    const RemapKernel<Float> remapFloats = needsRemap ? remapKernel<Float>(srcInfo.channelCount, dstInfo.channelCount, swapRedBlue) : nullptr;
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size.y(), threadCount, thread);
+
+        /* Per-thread temporary storage */
+        const std::size_t width = size.x();
+        Containers::Array<Float> storage{Containers::NoInit, width*(needsRemap ? 8 : 4)};
+        const Containers::ArrayView<Float> srcFloats = storage.prefix(width*srcInfo.channelCount);
+        const Containers::ArrayView<Float> dstFloats = needsRemap ?
+            storage.slice(width*4, width*(4 + dstInfo.channelCount)) : srcFloats;
+
+        for(std::size_t y = range.first; y != range.second; ++y) {
+            decodeRow(srcPixels[y], srcInfo, srcFloats);
+            if(needsRemap)
+                remapFloats(srcFloats.data(), dstFloats.data(), width, 1.0f);
+            encodeRow(dstFloats, dstInfo, dstPixels[y]);
+        }
+    });
+}
+
+Image2D convertPixelFormat(const ImageView2D& src, const PixelFormat format, const PixelFormatConversionFlags flags, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(formatInfo(format).channelCount,
+        "TextureTools::convertPixelFormat(): unsupported format" << format, (Image2D{format}));
+
+    /* Rows are aligned to four bytes by default */
+    const Vector2i size = src.size();
+    const std::size_t rowLength = 4*((size.x()*pixelSize(format) + 3)/4);
+    Image2D dst{format, size, Containers::Array<char>{Containers::NoInit, rowLength*size.y()}};
+    convertPixelFormatInto(src, dst, flags, threadCount);
+    return dst;
+}
+
+}}
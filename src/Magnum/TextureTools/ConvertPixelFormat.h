@@ -0,0 +1,124 @@
+#ifndef Magnum_TextureTools_ConvertPixelFormat_h
+#define Magnum_TextureTools_ConvertPixelFormat_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::convertPixelFormat(), @ref Magnum::TextureTools::convertPixelFormatInto(), enum @ref Magnum::TextureTools::PixelFormatConversionFlag, enum set @ref Magnum::TextureTools::PixelFormatConversionFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Pixel format conversion flag
+@m_since_latest
+
+@see @ref PixelFormatConversionFlags, @ref convertPixelFormatInto()
+*/
+enum class PixelFormatConversionFlag: UnsignedByte {
+    /**
+     * Swap the red and blue channels. Useful for images in BGR or BGRA
+     * channel order, for which there's no generic @ref PixelFormat, such as
+     * images coming from @ref Trade::TgaImporter "TgaImporter" with the
+     * @cb{.ini} swizzle @ce option disabled. Ignored if the source or the
+     * destination has less than three channels.
+     */
+    SwapRedBlue = 1 << 0
+};
+
+/**
+@brief Pixel format conversion flags
+@m_since_latest
+
+@see @ref convertPixelFormatInto()
+*/
+typedef Containers::EnumSet<PixelFormatConversionFlag> PixelFormatConversionFlags;
+
+CORRADE_ENUMSET_OPERATORS(PixelFormatConversionFlags)
+
+/**
+@brief Convert pixels between formats
+@param[in] src          Source image
+@param[out] dst         Destination image
+@param[in] flags        Conversion flags
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Converts pixels of @p src to the format of @p dst. Both images are expected
+to have the same size and be in one of the one- to four-channel
+@ref PixelFormat::R8Unorm "*8Unorm", @ref PixelFormat::R8Srgb "*8Srgb",
+@ref PixelFormat::R8Snorm "*8Snorm", @ref PixelFormat::R16Unorm "*16Unorm",
+@ref PixelFormat::R16Snorm "*16Snorm", @ref PixelFormat::R16F "*16F" or
+@ref PixelFormat::R32F "*32F" formats. Integer and implementation-specific
+formats are not supported. Any row padding or flipping expressed through the
+image @ref PixelStorage is respected.
+
+-   Normalized values are converted to and from floating-point the same way as
+    @ref Math::unpack() and @ref Math::pack(). Floating-point values outside
+    of the range representable by the destination are clamped.
+-   The RGB channels of the @ref PixelFormat::R8Srgb "*8Srgb" formats are
+    converted to and from linear RGB the same way as
+    @ref Color3::fromSrgb() and @ref Color3::toSrgb(), the alpha channel is
+    treated as linear. Between two @ref PixelFormat::R8Srgb "*8Srgb" formats
+    the values are copied as-is.
+-   If the destination has more channels than the source, missing green and
+    blue channels are set to zero and a missing alpha channel to one.
+    Superfluous source channels are dropped.
+
+Conversions where only the channel count or order differs, such as
+@ref PixelFormat::RGB8Unorm to @ref PixelFormat::RGBA8Unorm, copy the
+components directly without going through floating-point. Other conversions
+go through a floating-point representation, with the packing, unpacking and
+half-float conversion done using the SIMD kernels in
+@ref Magnum/Math/PackingBatch.h and the sRGB curve evaluated via lookup tables
+--- a 256-entry one for decoding and a 65536-entry one indexed by the linear
+value quantized to 16 bits for encoding. Because of the quantization,
+encoding to sRGB may rarely differ by one from @ref Color3::toSrgb(). The rows
+are split across @p threadCount threads, with fewer threads used for small
+images, where the threading overhead would outweigh the gains.
+@see @ref convertPixelFormat(), @ref pixelSize()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void convertPixelFormatInto(const ImageView2D& src, const MutableImageView2D& dst, PixelFormatConversionFlags flags = {}, UnsignedInt threadCount = 1);
+
+/**
+@brief Convert pixels to a different format
+@m_since_latest
+
+Allocates an image of @p format and the same size as @p src, with rows
+aligned to four bytes, and calls @ref convertPixelFormatInto() with it. See
+its documentation for more information.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D convertPixelFormat(const ImageView2D& src, PixelFormat format, PixelFormatConversionFlags flags = {}, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -0,0 +1,222 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPyramid.h"
+
+#ifndef MAGNUM_TARGET_GLES2
+#include <new>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Resource.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/GL/AbstractShaderProgram.h"
+#include "Magnum/GL/Buffer.h"
+#include "Magnum/GL/BufferImage.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/Framebuffer.h"
+#include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Shader.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
+
+#ifdef MAGNUM_BUILD_STATIC
+static void importTextureToolResources() {
+    CORRADE_RESOURCE_INITIALIZE(MagnumTextureTools_RCS)
+}
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+class DepthPyramidShader: public GL::AbstractShaderProgram {
+    public:
+        typedef GL::Attribute<0, Vector2> Position;
+
+        enum class Pass {
+            Copy,
+            Reduce
+        };
+
+        explicit DepthPyramidShader(Pass pass);
+
+        DepthPyramidShader& bindTexture(GL::Texture2D& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+    private:
+        /* Same unit as in DistanceFieldShader */
+        enum: Int { TextureUnit = 7 };
+};
+
+DepthPyramidShader::DepthPyramidShader(const Pass pass) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version v = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL300});
+    #else
+    const GL::Version v = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Shaders::Implementation::createCompatibilityShader(rs, v, GL::Shader::Type::Vertex);
+    GL::Shader frag = Shaders::Implementation::createCompatibilityShader(rs, v, GL::Shader::Type::Fragment);
+
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("DistanceFieldShader.vert"));
+    frag.addSource(pass == Pass::Copy ? "#define DEPTH_PYRAMID_COPY\n" :
+                                        "#define DEPTH_PYRAMID_REDUCE\n")
+        .addSource(rs.get("DepthPyramidShader.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>()) {
+        bindAttributeLocation(Position::Location, "position");
+    }
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    setUniform(uniformLocation("depthData"), TextureUnit);
+}
+
+}
+
+struct DepthPyramid::State {
+    explicit State(const Vector2i& size): size{size}, copyShader{DepthPyramidShader::Pass::Copy}, reduceShader{DepthPyramidShader::Pass::Reduce} {}
+
+    Vector2i size;
+    DepthPyramidShader copyShader, reduceShader;
+    GL::Texture2D texture;
+    Containers::Array<GL::Framebuffer> framebuffers;
+    GL::Mesh mesh;
+};
+
+DepthPyramid::DepthPyramid(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::DepthPyramid: expected a non-zero size, got" << size, );
+
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::framebuffer_object);
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+    #endif
+
+    _state.reset(new State{size});
+
+    /* Level count the same as for a full mip chain */
+    const Int levelCount = Math::log2(size.max()) + 1;
+    _state->texture.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setWrapping(GL::SamplerWrapping::ClampToEdge)
+        .setStorage(levelCount, GL::TextureFormat::R32F, size);
+
+    _state->framebuffers = Containers::Array<GL::Framebuffer>{Containers::NoInit, std::size_t(levelCount)};
+    for(Int i = 0; i != levelCount; ++i) {
+        new(&_state->framebuffers[i]) GL::Framebuffer{{{}, Math::max(size >> i, Vector2i{1})}};
+        _state->framebuffers[i].attachTexture(GL::Framebuffer::ColorAttachment(0), _state->texture, i);
+    }
+
+    _state->mesh.setPrimitive(GL::MeshPrimitive::Triangles)
+        .setCount(3);
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>()) {
+        constexpr Vector2 triangle[] = {
+            Vector2(-1.0,  1.0),
+            Vector2(-1.0, -3.0),
+            Vector2( 3.0,  1.0)
+        };
+        GL::Buffer buffer;
+        buffer.setData(triangle, GL::BufferUsage::StaticDraw);
+        _state->mesh.addVertexBuffer(std::move(buffer), 0, DepthPyramidShader::Position());
+    }
+}
+
+DepthPyramid::DepthPyramid(DepthPyramid&&) noexcept = default;
+
+DepthPyramid::~DepthPyramid() = default;
+
+DepthPyramid& DepthPyramid::operator=(DepthPyramid&&) noexcept = default;
+
+Vector2i DepthPyramid::size() const { return _state->size; }
+
+Int DepthPyramid::levelCount() const { return _state->framebuffers.size(); }
+
+Vector2i DepthPyramid::levelSize(const Int level) const {
+    CORRADE_ASSERT(std::size_t(level) < _state->framebuffers.size(),
+        "TextureTools::DepthPyramid::levelSize(): level" << level << "out of range for" << _state->framebuffers.size() << "levels", {});
+    return Math::max(_state->size >> level, Vector2i{1});
+}
+
+GL::Texture2D& DepthPyramid::texture() { return _state->texture; }
+
+void DepthPyramid::operator()(GL::Texture2D& depth) {
+    /** @todo Disable depth test and blending and then enable it back (if was
+        previously), same as in DistanceField */
+
+    _state->framebuffers[0].bind();
+    _state->copyShader.bindTexture(depth)
+        .draw(_state->mesh);
+
+    /* Each level reads from the previous one, which is the only level enabled
+       to avoid a feedback loop with the level being rendered to */
+    for(std::size_t i = 1; i != _state->framebuffers.size(); ++i) {
+        _state->texture.setBaseLevel(i - 1)
+            .setMaxLevel(i - 1);
+        _state->framebuffers[i].bind();
+        _state->reduceShader.bindTexture(_state->texture)
+            .draw(_state->mesh);
+    }
+
+    _state->texture.setBaseLevel(0)
+        .setMaxLevel(_state->framebuffers.size() - 1);
+}
+
+Image2D DepthPyramid::image(const Int level) {
+    CORRADE_ASSERT(std::size_t(level) < _state->framebuffers.size(),
+        "TextureTools::DepthPyramid::image(): level" << level << "out of range for" << _state->framebuffers.size() << "levels", (Image2D{PixelFormat::R32F}));
+    GL::Framebuffer& framebuffer = _state->framebuffers[level];
+    return framebuffer.read(framebuffer.viewport(), Image2D{PixelFormat::R32F});
+}
+
+GL::BufferImage2D DepthPyramid::image(const Int level, GL::BufferImage2D&& image, const GL::BufferUsage usage) {
+    CORRADE_ASSERT(std::size_t(level) < _state->framebuffers.size(),
+        "TextureTools::DepthPyramid::image(): level" << level << "out of range for" << _state->framebuffers.size() << "levels", std::move(image));
+    GL::Framebuffer& framebuffer = _state->framebuffers[level];
+    return framebuffer.read(framebuffer.viewport(), std::move(image), usage);
+}
+
+}}
+#endif
@@ -0,0 +1,214 @@
+#ifndef Magnum_TextureTools_DepthPyramid_h
+#define Magnum_TextureTools_DepthPyramid_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::TextureTools::DepthPyramid, function @ref Magnum::TextureTools::depthPyramidVisibilityInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/GL/GL.h"
+#include "Magnum/Math/Vector2.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+#if defined(MAGNUM_TARGET_GL) && !defined(MAGNUM_TARGET_GLES2)
+/**
+@brief Hierarchical depth pyramid
+@m_since_latest
+
+Builds a mip chain of a depth buffer where each texel contains the farthest
+depth of the area it covers in the base level, usually called a
+hierarchical Z-buffer or Hi-Z. An object whose nearest depth is farther than
+the pyramid depth over its screen-space bounds is guaranteed to be occluded,
+and thanks to the mip chain this can be checked by looking at just a few
+texels regardless of how large the object is on screen.
+
+The usual workflow is rendering the scene depth, or just a depth prepass of
+large occluders, building the pyramid from it, downloading a few of its
+coarsest levels and testing bounding boxes of the next frame's draw list
+against them with @ref depthPyramidVisibilityInto(). Reading back the data
+with a @ref GL::BufferImage2D and processing them one frame later avoids
+stalling the pipeline, at the cost of objects occasionally appearing a frame
+late:
+
+@snippet MagnumTextureTools-gl.cpp DepthPyramid-usage
+
+@section TextureTools-DepthPyramid-algorithm The algorithm
+
+The base level is a copy of the input depth texture in a
+@ref GL::TextureFormat::R32F texture of the same size, each following level is
+then calculated with a fragment pass taking the maximum of the corresponding
+2x2 texels of the previous level. If the previous level has an odd size, the
+last row and column additionally include the remaining texels, so the
+pyramid stays conservative for non-power-of-two sizes as well. The passes
+use a full-screen triangle and bind their own framebuffers, so the
+framebuffer used for rendering has to be bound again afterwards.
+
+The depth values are expected to be in the default @f$ [0, 1] @f$ range with
+@cpp 1.0f @ce being the farthest.
+
+@section TextureTools-DepthPyramid-fallback OpenGL ES 2.0
+
+Rendering to floating-point textures and integer texel fetches needed by
+the pyramid aren't available in OpenGL ES 2.0 and WebGL 1.0. On OpenGL ES 2.0
+with @gl_extension{EXT,occlusion_query_boolean} the occlusion culling can be
+done with a @ref GL::SampleQuery for each object instead --- drawing its
+bounding box with color and depth writes disabled after the occluders and
+using the query result once it's available to decide whether to draw the
+object. Unlike with the pyramid, the GPU is involved for every object and the
+queries are ordered, so this scales worse with object count. WebGL 1.0 has no
+occlusion query support at all.
+
+@snippet MagnumTextureTools-gl.cpp DepthPyramid-fallback
+
+@note This class is available only if Magnum is compiled with
+    @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
+    for more information.
+
+@requires_gl30 Extension @gl_extension{EXT,gpu_shader4} and
+    @gl_extension{ARB,texture_float}
+@requires_gles30 Not available in OpenGL ES 2.0.
+@requires_gles Rendering to floating-point textures requires
+    @gl_extension{EXT,color_buffer_float} in OpenGL ES 3.0.
+@requires_webgl20 Not available in WebGL 1.0.
+*/
+class MAGNUM_TEXTURETOOLS_EXPORT DepthPyramid {
+    public:
+        /**
+         * @brief Constructor
+         * @param size      Size of the depth buffer
+         *
+         * Prepares the shaders and allocates the pyramid texture with a full
+         * mip chain. Expects that @p size is positive.
+         */
+        explicit DepthPyramid(const Vector2i& size);
+
+        /** @brief Copying is not allowed */
+        DepthPyramid(const DepthPyramid&) = delete;
+
+        /** @brief Move constructor */
+        DepthPyramid(DepthPyramid&&) noexcept;
+
+        ~DepthPyramid();
+
+        /** @brief Copying is not allowed */
+        DepthPyramid& operator=(const DepthPyramid&) = delete;
+
+        /** @brief Move assignment */
+        DepthPyramid& operator=(DepthPyramid&&) noexcept;
+
+        /** @brief Size of the base level */
+        Vector2i size() const;
+
+        /** @brief Level count */
+        Int levelCount() const;
+
+        /**
+         * @brief Size of given level
+         *
+         * Half of the previous level rounded down, but at least
+         * @cpp 1 @ce. Expects that @p level is less than
+         * @ref levelCount().
+         */
+        Vector2i levelSize(Int level) const;
+
+        /**
+         * @brief Pyramid texture
+         *
+         * A @ref GL::TextureFormat::R32F texture with @ref levelCount()
+         * levels, can be used directly in a shader doing the visibility test
+         * on the GPU.
+         */
+        GL::Texture2D& texture();
+
+        /**
+         * @brief Build the pyramid
+         * @param depth     Depth texture of @ref size()
+         *
+         * The @p depth texture is expected to be complete, for example by
+         * having just a single level and nearest filtering set.
+         */
+        void operator()(GL::Texture2D& depth);
+
+        /**
+         * @brief Download given level
+         *
+         * Expects that @p level is less than @ref levelCount(). The image is
+         * in @ref PixelFormat::R32F.
+         */
+        Image2D image(Int level);
+
+        /**
+         * @brief Download given level to a buffer image
+         *
+         * Like @ref image(Int), but the download is done asynchronously into
+         * a buffer.
+         */
+        GL::BufferImage2D image(Int level, GL::BufferImage2D&& image, GL::BufferUsage usage);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+#endif
+
+/**
+@brief Test bounding box visibility against a depth pyramid
+@param[in] levels           Depth pyramid levels
+@param[in] viewProjection   View projection matrix
+@param[in] boxes            Bounding boxes
+@param[out] visibility      Where to put visibility of each box
+@m_since_latest
+
+The @p levels are expected to be consecutive levels of a depth pyramid as
+produced by @ref DepthPyramid, in @ref PixelFormat::R32F, each having half the
+size of the previous rounded down and at least @cpp 1 @ce pixel. It doesn't
+need to start at the base level, the coarser the first level, the less data
+has to be downloaded from the GPU but the less precise the test is.
+
+Each box is transformed with @p viewProjection, which is expected to be the
+one the pyramid was rendered with, and its screen-space bounds are compared
+against the coarsest level where they span at most two texels in each
+direction. The box is reported as visible if its nearest depth isn't farther
+than the farthest depth in the covered texels. The test is conservative ---
+boxes intersecting the near plane are always reported as visible --- while
+boxes completely outside of the view are reported as not visible. Expects
+that @p boxes and @p visibility have the same size.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void depthPyramidVisibilityInto(Containers::ArrayView<const ImageView2D> levels, const Matrix4& viewProjection, const Containers::StridedArrayView1D<const Range3D>& boxes, const Containers::StridedArrayView1D<bool>& visibility);
+
+}}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Depth pyramid construction, either copying the input depth into the base
+   level or taking the farthest depth of the previous level. The previous
+   level is the only one enabled via base and max level, so texel fetches are
+   always from level 0. */
+
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+uniform highp sampler2D depthData;
+
+out highp float depth;
+
+void main() {
+    const highp ivec2 position = ivec2(gl_FragCoord.xy);
+
+    #ifdef DEPTH_PYRAMID_COPY
+    depth = texelFetch(depthData, position, 0).r;
+
+    #elif defined(DEPTH_PYRAMID_REDUCE)
+    /* Each pixel covers 2x2 texels of the previous level. If the previous
+       level has an odd size, the last row and column cover three to not lose
+       the remaining texels. A previous level of size 1 is clamped. */
+    const highp ivec2 size = textureSize(depthData, 0);
+    const highp ivec2 last = size - ivec2(1);
+    const highp ivec2 base = position*2;
+    const highp ivec2 extent = ivec2(base.x + 3 == size.x ? 3 : 2,
+                                     base.y + 3 == size.y ? 3 : 2);
+    highp float farthest = 0.0;
+    for(int y = 0; y < 3; ++y) for(int x = 0; x < 3; ++x) {
+        if(x >= extent.x || y >= extent.y) continue;
+        farthest = max(farthest, texelFetch(depthData, min(base + ivec2(x, y), last), 0).r);
+    }
+    depth = farthest;
+    #else
+    #error no pass selected
+    #endif
+}
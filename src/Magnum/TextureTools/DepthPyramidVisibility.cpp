@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DepthPyramid.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+
+namespace Magnum { namespace TextureTools {
+
+void depthPyramidVisibilityInto(const Containers::ArrayView<const ImageView2D> levels, const Matrix4& viewProjection, const Containers::StridedArrayView1D<const Range3D>& boxes, const Containers::StridedArrayView1D<bool>& visibility) {
+    CORRADE_ASSERT(!levels.empty(),
+        "TextureTools::depthPyramidVisibilityInto(): expected at least one level", );
+    CORRADE_ASSERT(boxes.size() == visibility.size(),
+        "TextureTools::depthPyramidVisibilityInto(): expected boxes and visibility views to have the same size, got" << boxes.size() << "and" << visibility.size(), );
+    const Vector2i size = levels[0].size();
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::depthPyramidVisibilityInto(): expected a non-empty first level", );
+
+    /* Pixel views of all levels, to not have to create them for every box */
+    Containers::Array<Containers::StridedArrayView2D<const Float>> pixels{levels.size()};
+    Containers::Array<Vector2i> levelSizes{Containers::NoInit, levels.size()};
+    for(std::size_t i = 0; i != levels.size(); ++i) {
+        CORRADE_ASSERT(levels[i].format() == PixelFormat::R32F,
+            "TextureTools::depthPyramidVisibilityInto(): expected level" << i << "to be" << PixelFormat::R32F << "but got" << levels[i].format(), );
+        levelSizes[i] = Math::max(size >> Int(i), Vector2i{1});
+        CORRADE_ASSERT(levels[i].size() == levelSizes[i],
+            "TextureTools::depthPyramidVisibilityInto(): expected level" << i << "to have a size of" << levelSizes[i] << "but got" << levels[i].size(), );
+        pixels[i] = levels[i].pixels<Float>();
+    }
+
+    const Int lastLevel = levels.size() - 1;
+    for(std::size_t i = 0; i != boxes.size(); ++i) {
+        const Range3D& box = boxes[i];
+
+        /* Normalized device coordinate bounds of the box. If any corner is
+           behind the camera, the projection isn't meaningful, so treat the
+           box as visible. */
+        Vector3 min{Constants::inf()};
+        Vector3 max{-Constants::inf()};
+        bool behind = false;
+        for(UnsignedInt j = 0; j != 8; ++j) {
+            const Vector4 corner = viewProjection*Vector4{
+                (j & 1 ? box.max() : box.min()).x(),
+                (j & 2 ? box.max() : box.min()).y(),
+                (j & 4 ? box.max() : box.min()).z(), 1.0f};
+            if(corner.w() <= 0.0f) {
+                behind = true;
+                break;
+            }
+            const Vector3 ndc = corner.xyz()/corner.w();
+            min = Math::min(min, ndc);
+            max = Math::max(max, ndc);
+        }
+        if(behind) {
+            visibility[i] = true;
+            continue;
+        }
+
+        /* Outside of the view frustum */
+        if(max.x() < -1.0f || min.x() > 1.0f ||
+           max.y() < -1.0f || min.y() > 1.0f || min.z() > 1.0f) {
+            visibility[i] = false;
+            continue;
+        }
+
+        /* Pixel rectangle in the first level. Both the image and NDC have Y
+           up, so no flipping is needed. */
+        const Vector2 sizef{size};
+        const Vector2i a = Math::clamp(Vector2i{(Math::max(min.xy(), Vector2{-1.0f})*0.5f + Vector2{0.5f})*sizef}, Vector2i{0}, size - Vector2i{1});
+        const Vector2i b = Math::clamp(Vector2i{(Math::min(max.xy(), Vector2{1.0f})*0.5f + Vector2{0.5f})*sizef}, Vector2i{0}, size - Vector2i{1});
+
+        /* Pick the finest level where the rectangle spans at most two texels
+           in each direction */
+        Int level = 0;
+        while(level < lastLevel && ((b >> level) - (a >> level)).max() > 1)
+            ++level;
+
+        /* Odd-sized levels have the remaining texels folded into the last
+           row and column, so clamping maps each pixel to a texel covering
+           it */
+        const Vector2i last = levelSizes[level] - Vector2i{1};
+        const Vector2i levelA = Math::min(a >> level, last);
+        const Vector2i levelB = Math::min(b >> level, last);
+        Float farthest = 0.0f;
+        for(Int y = levelA.y(); y <= levelB.y(); ++y)
+            for(Int x = levelA.x(); x <= levelB.x(); ++x)
+                farthest = Math::max(farthest, pixels[level][y][x]);
+
+        visibility[i] = min.z()*0.5f + 0.5f <= farthest;
+    }
+}
+
+}}
@@ -25,6 +25,8 @@
 
 #include "DistanceField.h"
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/Reference.h>
 #include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/Resource.h>
@@ -36,8 +38,13 @@
 #include "Magnum/GL/Extensions.h"
 #include "Magnum/GL/Framebuffer.h"
 #include "Magnum/GL/Mesh.h"
+#include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Shader.h"
 #include "Magnum/GL/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/TextureArray.h"
+#include "Magnum/GL/TextureFormat.h"
+#endif
 #include "Magnum/Shaders/Implementation/CreateCompatibilityShader.h"
 
 #ifdef MAGNUM_BUILD_STATIC
@@ -54,7 +61,11 @@ class DistanceFieldShader: public GL::AbstractShaderProgram {
     public:
         typedef GL::Attribute<0, Vector2> Position;
 
-        explicit DistanceFieldShader(UnsignedInt radius);
+        explicit DistanceFieldShader(UnsignedInt radius
+            #ifndef MAGNUM_TARGET_GLES2
+            , bool array = false
+            #endif
+        );
 
         DistanceFieldShader& setScaling(const Vector2& scaling) {
             setUniform(scalingUniform, scaling);
@@ -71,6 +82,18 @@ class DistanceFieldShader: public GL::AbstractShaderProgram {
             return *this;
         }
 
+        #ifndef MAGNUM_TARGET_GLES2
+        DistanceFieldShader& setLayer(Int layer) {
+            setUniform(layerUniform, layer);
+            return *this;
+        }
+
+        DistanceFieldShader& bindTexture(GL::Texture2DArray& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+        #endif
+
     private:
         /* ES2 on iOS (apparently independent on the device) has only 8 texture
            units, so be careful to not step over that. ES3 on the same has 16.
@@ -79,10 +102,17 @@ class DistanceFieldShader: public GL::AbstractShaderProgram {
         enum: Int { TextureUnit = 7 };
 
         Int scalingUniform{0},
-            imageSizeInvertedUniform;
+            imageSizeInvertedUniform{1};
+        #ifndef MAGNUM_TARGET_GLES2
+        Int layerUniform{2};
+        #endif
 };
 
-DistanceFieldShader::DistanceFieldShader(const UnsignedInt radius) {
+DistanceFieldShader::DistanceFieldShader(const UnsignedInt radius
+    #ifndef MAGNUM_TARGET_GLES2
+    , const bool array
+    #endif
+) {
     #ifdef MAGNUM_BUILD_STATIC
     /* Import resources on static build, if not already */
     if(!Utility::Resource::hasGroup("MagnumTextureTools"))
@@ -101,8 +131,11 @@ DistanceFieldShader::DistanceFieldShader(const UnsignedInt radius) {
 
     vert.addSource(rs.get("FullScreenTriangle.glsl"))
         .addSource(rs.get("DistanceFieldShader.vert"));
-    frag.addSource(Utility::formatString("#define RADIUS {}\n", radius))
-        .addSource(rs.get("DistanceFieldShader.frag"));
+    frag.addSource(Utility::formatString("#define RADIUS {}\n", radius));
+    #ifndef MAGNUM_TARGET_GLES2
+    if(array) frag.addSource("#define TEXTURE_ARRAY\n");
+    #endif
+    frag.addSource(rs.get("DistanceFieldShader.frag"));
 
     CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
 
@@ -131,6 +164,10 @@ DistanceFieldShader::DistanceFieldShader(const UnsignedInt radius) {
         {
             imageSizeInvertedUniform = uniformLocation("imageSizeInverted");
         }
+
+        #ifndef MAGNUM_TARGET_GLES2
+        if(array) layerUniform = uniformLocation("layer");
+        #endif
     }
 
     #ifndef MAGNUM_TARGET_GLES
@@ -141,21 +178,186 @@ DistanceFieldShader::DistanceFieldShader(const UnsignedInt radius) {
     }
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+class DistanceFieldJumpFloodShader: public GL::AbstractShaderProgram {
+    public:
+        typedef GL::Attribute<0, Vector2> Position;
+
+        enum class Pass {
+            Initialize,
+            Step,
+            Output
+        };
+
+        explicit DistanceFieldJumpFloodShader(Pass pass, UnsignedInt radius);
+
+        DistanceFieldJumpFloodShader& setStepSize(Int size) {
+            setUniform(_stepSizeUniform, size);
+            return *this;
+        }
+
+        DistanceFieldJumpFloodShader& setScaling(const Vector2& scaling) {
+            setUniform(_scalingUniform, scaling);
+            return *this;
+        }
+
+        DistanceFieldJumpFloodShader& bindTexture(GL::Texture2D& texture) {
+            texture.bind(TextureUnit);
+            return *this;
+        }
+
+        DistanceFieldJumpFloodShader& bindSeedTexture(GL::Texture2D& texture) {
+            texture.bind(SeedTextureUnit);
+            return *this;
+        }
+
+    private:
+        /* Same unit as in DistanceFieldShader for the input, the one below
+           for the seeds */
+        enum: Int {
+            TextureUnit = 7,
+            SeedTextureUnit = 5
+        };
+
+        Int _stepSizeUniform{-1},
+            _scalingUniform{-1};
+};
+
+DistanceFieldJumpFloodShader::DistanceFieldJumpFloodShader(const Pass pass, const UnsignedInt radius) {
+    #ifdef MAGNUM_BUILD_STATIC
+    /* Import resources on static build, if not already */
+    if(!Utility::Resource::hasGroup("MagnumTextureTools"))
+        importTextureToolResources();
+    #endif
+    Utility::Resource rs("MagnumTextureTools");
+
+    #ifndef MAGNUM_TARGET_GLES
+    const GL::Version v = GL::Context::current().supportedVersion({GL::Version::GL320, GL::Version::GL300});
+    #else
+    const GL::Version v = GL::Version::GLES300;
+    #endif
+
+    GL::Shader vert = Shaders::Implementation::createCompatibilityShader(rs, v, GL::Shader::Type::Vertex);
+    GL::Shader frag = Shaders::Implementation::createCompatibilityShader(rs, v, GL::Shader::Type::Fragment);
+
+    vert.addSource(rs.get("FullScreenTriangle.glsl"))
+        .addSource(rs.get("DistanceFieldShader.vert"));
+    frag.addSource(pass == Pass::Initialize ? "#define JUMP_FLOOD_INITIALIZE\n" :
+                   pass == Pass::Step ? "#define JUMP_FLOOD_STEP\n" :
+                                        "#define JUMP_FLOOD_OUTPUT\n")
+        .addSource(Utility::formatString("#define RADIUS {}\n", radius))
+        .addSource(rs.get("DistanceFieldJumpFloodShader.frag"));
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(GL::Shader::compile({vert, frag}));
+
+    attachShaders({vert, frag});
+
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::MAGNUM::shader_vertex_id>()) {
+        bindAttributeLocation(Position::Location, "position");
+    }
+
+    CORRADE_INTERNAL_ASSERT_OUTPUT(link());
+
+    if(pass != Pass::Step)
+        setUniform(uniformLocation("textureData"), TextureUnit);
+    if(pass != Pass::Initialize)
+        setUniform(uniformLocation("seedData"), SeedTextureUnit);
+    if(pass == Pass::Step)
+        _stepSizeUniform = uniformLocation("stepSize");
+    if(pass == Pass::Output)
+        _scalingUniform = uniformLocation("scaling");
+}
+#endif
+
 }
 
 struct DistanceField::State {
-    explicit State(UnsignedInt radius): shader{radius}, radius{radius} {}
+    explicit State(UnsignedInt radius, DistanceFieldAlgorithm algorithm): radius{radius}, algorithm{algorithm} {}
+
+    #ifndef MAGNUM_TARGET_GLES2
+    GL::Texture2D& jumpFlood(GL::Texture2D& input, const Vector2i& imageSize);
+    #endif
 
-    DistanceFieldShader shader;
     UnsignedInt radius;
+    DistanceFieldAlgorithm algorithm;
+    Containers::Optional<DistanceFieldShader> shader;
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Texture array variant, created on first use */
+    Containers::Optional<DistanceFieldShader> arrayShader;
+    #endif
+    #ifndef MAGNUM_TARGET_GLES2
+    Containers::Optional<DistanceFieldJumpFloodShader> initializeShader,
+        stepShader, outputShader;
+    /* Ping-pong textures for the jump flooding passes, allocated on first
+       use and reallocated only if the input size changes */
+    GL::Texture2D seeds[2]{GL::Texture2D{NoCreate}, GL::Texture2D{NoCreate}};
+    GL::Framebuffer seedFramebuffers[2]{GL::Framebuffer{NoCreate}, GL::Framebuffer{NoCreate}};
+    Vector2i seedSize;
+    #endif
     GL::Mesh mesh;
 };
 
-DistanceField::DistanceField(const UnsignedInt radius): _state{new State{radius}} {
+#ifndef MAGNUM_TARGET_GLES2
+GL::Texture2D& DistanceField::State::jumpFlood(GL::Texture2D& input, const Vector2i& imageSize) {
+    if(seedSize != imageSize) {
+        for(std::size_t i = 0; i != 2; ++i) {
+            seeds[i] = GL::Texture2D{};
+            seeds[i].setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+                .setMagnificationFilter(GL::SamplerFilter::Nearest)
+                .setStorage(1, GL::TextureFormat::RGBA16I, imageSize);
+            seedFramebuffers[i] = GL::Framebuffer{{{}, imageSize}};
+            seedFramebuffers[i].attachTexture(GL::Framebuffer::ColorAttachment(0), seeds[i], 0);
+        }
+        seedSize = imageSize;
+    }
+
+    /* Each pixel is a seed for itself */
+    seedFramebuffers[0].bind();
+    initializeShader->bindTexture(input)
+        .draw(mesh);
+
+    /* The largest step size needed to propagate seeds over radius + 1 pixels,
+       as the steps N, N/2, ... 1 cover distance of up to 2N - 1 */
+    Int stepSize = 1;
+    while(2*stepSize - 1 < Int(radius) + 1) stepSize *= 2;
+
+    /* Halve the step size each pass, then do one more pass with step 1 */
+    std::size_t current = 0;
+    for(bool extraPass = false; ; ) {
+        seedFramebuffers[current ^ 1].bind();
+        stepShader->setStepSize(stepSize)
+            .bindSeedTexture(seeds[current])
+            .draw(mesh);
+        current ^= 1;
+
+        if(stepSize > 1) stepSize /= 2;
+        else if(!extraPass) extraPass = true;
+        else break;
+    }
+
+    return seeds[current];
+}
+#endif
+
+DistanceField::DistanceField(const UnsignedInt radius, const DistanceFieldAlgorithm algorithm): _state{new State{radius, algorithm}} {
     #ifndef MAGNUM_TARGET_GLES
     MAGNUM_ASSERT_GL_EXTENSION_SUPPORTED(GL::Extensions::ARB::framebuffer_object);
     #endif
 
+    #ifndef MAGNUM_TARGET_GLES2
+    if(algorithm == DistanceFieldAlgorithm::JumpFlood) {
+        #ifndef MAGNUM_TARGET_GLES
+        MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+        #endif
+        _state->initializeShader.emplace(DistanceFieldJumpFloodShader::Pass::Initialize, radius);
+        _state->stepShader.emplace(DistanceFieldJumpFloodShader::Pass::Step, radius);
+        _state->outputShader.emplace(DistanceFieldJumpFloodShader::Pass::Output, radius);
+    } else
+    #endif
+    {
+        _state->shader.emplace(radius);
+    }
+
     _state->mesh.setPrimitive(GL::MeshPrimitive::Triangles)
         .setCount(3);
 
@@ -178,7 +380,26 @@ DistanceField::~DistanceField() = default;
 
 UnsignedInt DistanceField::radius() const { return _state->radius; }
 
-void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, const Vector2i&
+DistanceFieldAlgorithm DistanceField::algorithm() const { return _state->algorithm; }
+
+void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, const Vector2i& imageSize) {
+    process(input, output, rectangle, nullptr, imageSize);
+}
+
+void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, const Containers::ArrayView<const Range2Di> dirtyRectangles, const Vector2i& imageSize) {
+    #ifndef CORRADE_NO_ASSERT
+    for(std::size_t i = 0; i != dirtyRectangles.size(); ++i)
+        CORRADE_ASSERT(rectangle.contains(dirtyRectangles[i]),
+            "TextureTools::DistanceField: dirty rectangle" << i << dirtyRectangles[i] << "not contained in" << rectangle, );
+    #endif
+
+    /* Nothing to do */
+    if(dirtyRectangles.empty()) return;
+
+    process(input, output, rectangle, dirtyRectangles, imageSize);
+}
+
+void DistanceField::process(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, const Containers::ArrayView<const Range2Di> dirtyRectangles, const Vector2i&
     #ifdef MAGNUM_TARGET_GLES
     imageSize
     #endif
@@ -190,11 +411,12 @@ void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, cons
     #endif
 
     /* Framebuffer is instantiated here so it gets correctly unbound at the end
-       (and bound framebuffer reset back to the default) */
+       (and bound framebuffer reset back to the default). If only dirty
+       regions are processed, the clear is done for each of them below. */
     GL::Framebuffer framebuffer{rectangle};
-    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment(0), output, 0)
-        .clear(GL::FramebufferClear::Color)
-        .bind();
+    framebuffer.attachTexture(GL::Framebuffer::ColorAttachment(0), output, 0);
+    if(dirtyRectangles.empty()) framebuffer.clear(GL::FramebufferClear::Color);
+    framebuffer.bind();
 
     const GL::Framebuffer::Status status = framebuffer.checkStatus(GL::FramebufferTarget::Draw);
     if(status != GL::Framebuffer::Status::Complete) {
@@ -203,20 +425,103 @@ void DistanceField::operator()(GL::Texture2D& input, GL::Texture2D& output, cons
         return;
     }
 
-    _state->shader.setScaling(Vector2(imageSize)/Vector2(rectangle.size()))
+    GL::AbstractShaderProgram* shader;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(_state->algorithm == DistanceFieldAlgorithm::JumpFlood) {
+        GL::Texture2D& seeds = _state->jumpFlood(input, imageSize);
+
+        /* The jump flooding passes bound their own framebuffers */
+        framebuffer.bind();
+        _state->outputShader->setScaling(Vector2(imageSize)/Vector2(rectangle.size()))
+            .bindTexture(input)
+            .bindSeedTexture(seeds);
+        shader = &*_state->outputShader;
+    } else
+    #endif
+    {
+        _state->shader->setScaling(Vector2(imageSize)/Vector2(rectangle.size()))
+            .bindTexture(input);
+
+        #ifndef MAGNUM_TARGET_GLES
+        if(!GL::Context::current().isVersionSupported(GL::Version::GL320))
+        #else
+        if(!GL::Context::current().isVersionSupported(GL::Version::GLES300))
+        #endif
+        {
+            _state->shader->setImageSizeInverted(1.0f/Vector2(imageSize));
+        }
+
+        shader = &*_state->shader;
+    }
+
+    /* Draw the mesh over the whole rectangle */
+    if(dirtyRectangles.empty()) {
+        shader->draw(_state->mesh);
+        return;
+    }
+
+    /* Otherwise clear and draw only the dirty regions. The viewport stays the
+       same so the input-to-output mapping is unaffected by the scissor. */
+    GL::Renderer::enable(GL::Renderer::Feature::ScissorTest);
+    for(const Range2Di& dirtyRectangle: dirtyRectangles) {
+        GL::Renderer::setScissor(dirtyRectangle);
+        framebuffer.clear(GL::FramebufferClear::Color);
+        shader->draw(_state->mesh);
+    }
+    GL::Renderer::disable(GL::Renderer::Feature::ScissorTest);
+}
+
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceField::operator()(GL::Texture2DArray& input, GL::Texture2DArray& output, const Range2Di& rectangle, const Vector3i&
+    #ifdef MAGNUM_TARGET_GLES
+    imageSize
+    #endif
+) {
+    CORRADE_ASSERT(_state->algorithm == DistanceFieldAlgorithm::BruteForce,
+        "TextureTools::DistanceField: texture arrays are supported only with the brute force algorithm", );
+    #ifndef MAGNUM_TARGET_GLES
+    MAGNUM_ASSERT_GL_VERSION_SUPPORTED(GL::Version::GL300);
+    #endif
+
+    #ifndef MAGNUM_TARGET_GLES
+    const Vector3i imageSize = input.imageSize(0);
+    #endif
+
+    if(!_state->arrayShader) _state->arrayShader.emplace(_state->radius, true);
+
+    /* The shader and its uniforms are set up just once for all layers */
+    _state->arrayShader->setScaling(Vector2(imageSize.xy())/Vector2(rectangle.size()))
         .bindTexture(input);
 
     #ifndef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isVersionSupported(GL::Version::GL320))
-    #else
-    if(!GL::Context::current().isVersionSupported(GL::Version::GLES300))
-    #endif
     {
-        _state->shader.setImageSizeInverted(1.0f/Vector2(imageSize));
+        _state->arrayShader->setImageSizeInverted(1.0f/Vector2(imageSize.xy()));
     }
+    #endif
+
+    /* A single framebuffer is reused for all layers, only the attachment is
+       changed for each */
+    GL::Framebuffer framebuffer{rectangle};
+    for(Int layer = 0; layer != imageSize.z(); ++layer) {
+        framebuffer.attachTextureLayer(GL::Framebuffer::ColorAttachment(0), output, 0, layer)
+            .clear(GL::FramebufferClear::Color);
+
+        if(layer == 0) {
+            framebuffer.bind();
+
+            const GL::Framebuffer::Status status = framebuffer.checkStatus(GL::FramebufferTarget::Draw);
+            if(status != GL::Framebuffer::Status::Complete) {
+                Error() << "TextureTools::DistanceField: cannot render to given output texture, unexpected framebuffer status"
+                        << status;
+                return;
+            }
+        }
 
-    /* Draw the mesh */
-    _state->shader.draw(_state->mesh);
+        _state->arrayShader->setLayer(layer)
+            .draw(_state->mesh);
+    }
 }
+#endif
 
 }}
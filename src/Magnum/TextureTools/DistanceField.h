@@ -26,7 +26,7 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::TextureTools::DistanceField
+ * @brief Class @ref Magnum::TextureTools::DistanceField, enum @ref Magnum::TextureTools::DistanceFieldAlgorithm
  */
 
 #include "Magnum/configure.h"
@@ -37,12 +37,42 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/GL/GL.h"
 #ifndef MAGNUM_TARGET_GLES
-#include "Magnum/Math/Vector2.h"
+#include "Magnum/Math/Vector3.h"
 #endif
 #include "Magnum/TextureTools/visibility.h"
 
 namespace Magnum { namespace TextureTools {
 
+/**
+@brief Distance field algorithm
+@m_since_latest
+
+@see @ref DistanceField::DistanceField(UnsignedInt, DistanceFieldAlgorithm)
+*/
+enum class DistanceFieldAlgorithm: UnsignedByte {
+    /**
+     * Searches the whole neighborhood of given radius for each output pixel.
+     * The cost grows quadratically with the radius. See
+     * @ref TextureTools-DistanceField-algorithm for more information.
+     */
+    BruteForce,
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /**
+     * Propagates nearest pixel positions using jump flooding in a logarithmic
+     * count of passes over the input image. Gives the same results as
+     * @ref DistanceFieldAlgorithm::BruteForce except for a few pixels where
+     * the jump flooding doesn't find the nearest pixel. See
+     * @ref TextureTools-DistanceField-jump-flood for more information.
+     * @requires_gl30 Extension @gl_extension{EXT,texture_integer} and
+     *      @gl_extension{EXT,gpu_shader4}
+     * @requires_gles30 Integer textures are not available in OpenGL ES 2.0.
+     * @requires_webgl20 Integer textures are not available in WebGL 1.0.
+     */
+    JumpFlood
+    #endif
+};
+
 /**
 @brief Create a signed distance field
 
@@ -68,6 +98,29 @@ was originally colored white and nearest black pixel is farther than @p radius,
 value of 0.0 means that the pixel was originally black and nearest white pixel
 is farther than @p radius. Values around 0.5 are around edges.
 
+@section TextureTools-DistanceField-jump-flood Jump flooding
+
+The above is done with @ref DistanceFieldAlgorithm::BruteForce, which samples
+up to @f$ (2r + 1)^2 @f$ input pixels for each output pixel. With
+@ref DistanceFieldAlgorithm::JumpFlood the input is first converted to a
+texture containing for each pixel the position of the nearest inside and
+outside pixel, initially just the pixel itself for one of them. These
+positions are then propagated between pixels in the distance of
+@f$ 2^{\lceil \log_2 (r + 2) \rceil - 1} @f$ pixels, halving the distance in
+each following pass until it's @cpp 1 @ce, plus one additional pass in the
+distance of @cpp 1 @ce to fix most of the remaining errors. As each pass looks
+only at eight neighbors, the total cost grows just logarithmically with the
+radius. The distances are then calculated and normalized the same way as in
+the brute-force case, the output is thus identical except for rare cases where
+the propagation doesn't find the nearest pixel.
+
+Two ping-pong textures of the size of the input image are allocated for the
+passes and reused for subsequent calls with the same input size.
+
+Based on: *Guodong Rong, Tiow-Seng Tan - Jump Flooding in GPU with
+Applications to Voronoi Diagram and Distance Transform, I3D 2006,
+https://www.comp.nus.edu.sg/~tants/jfa.html*
+
 The resulting texture can be used with bilinear filtering. It can be converted
 back to binary form in shader using e.g. GLSL @glsl smoothstep() @ce function
 with step around 0.5 to create antialiased edges. Or you can exploit the
@@ -100,15 +153,25 @@ class MAGNUM_TEXTURETOOLS_EXPORT DistanceField {
          * @brief Constructor
          * @param radius       Max lookup radius in the input texture
          *
-         * Prepares the shader and other internal state for given @p radius.
+         * @param algorithm    Algorithm to use
+         *
+         * Prepares the shaders and other internal state for given @p radius.
+         * On desktop OpenGL, @ref DistanceFieldAlgorithm::JumpFlood requires
+         * OpenGL 3.0.
          */
-        explicit DistanceField(UnsignedInt radius);
+        explicit DistanceField(UnsignedInt radius, DistanceFieldAlgorithm algorithm = DistanceFieldAlgorithm::BruteForce);
 
         ~DistanceField();
 
         /** @brief Max lookup radius */
         UnsignedInt radius() const;
 
+        /**
+         * @brief Algorithm
+         * @m_since_latest
+         */
+        DistanceFieldAlgorithm algorithm() const;
+
         /**
          * @brief Calculate the distance field
          * @param input        Input texture
@@ -124,7 +187,75 @@ class MAGNUM_TEXTURETOOLS_EXPORT DistanceField {
             #endif
         );
 
+        /**
+         * @brief Calculate the distance field only in given dirty regions
+         * @param input        Input texture
+         * @param output       Output texture
+         * @param rectangle    Rectangle in output texture to which the whole
+         *      @p input maps
+         * @param dirtyRectangles  Rectangles in output texture to update
+         * @param imageSize    Input texture size. Needed only for OpenGL ES,
+         *      on desktop GL the information is gathered automatically using
+         *      @ref GL::Texture2D::imageSize().
+         * @m_since_latest
+         *
+         * Compared to @ref operator()(GL::Texture2D&, GL::Texture2D&, const Range2Di&, const Vector2i&)
+         * the @p input is still mapped to the whole @p rectangle, but only
+         * pixels inside @p dirtyRectangles are cleared and recalculated, the
+         * rest of the output is left untouched. All regions are processed in
+         * a single framebuffer pass with @ref GL::Renderer::Feature::ScissorTest
+         * enabled for each of them, which is useful for updating a few small
+         * areas of a large texture. The dirty rectangles are in absolute
+         * @p output coordinates and are expected to be contained in
+         * @p rectangle. If @p dirtyRectangles is empty, the function does
+         * nothing. The scissor test is disabled again at the end.
+         *
+         * With @ref DistanceFieldAlgorithm::JumpFlood the seed propagation
+         * passes are still done over the whole input, only the final pass is
+         * restricted to the dirty regions.
+         */
+        void operator()(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, Containers::ArrayView<const Range2Di> dirtyRectangles, const Vector2i& imageSize
+            #ifndef MAGNUM_TARGET_GLES
+            = {}
+            #endif
+        );
+
+        #ifndef MAGNUM_TARGET_GLES2
+        /**
+         * @brief Calculate the distance field for all layers of a texture array
+         * @param input        Input texture array
+         * @param output       Output texture array
+         * @param rectangle    Rectangle in each output layer where to render
+         * @param imageSize    Input texture size and layer count. Needed only
+         *      for OpenGL ES, on desktop GL the information is gathered
+         *      automatically using @ref GL::Texture2DArray::imageSize().
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref operator()(GL::Texture2D&, GL::Texture2D&, const Range2Di&, const Vector2i&)
+         * for each layer of @p input and @p output, but the shader, its
+         * uniforms and the framebuffer are set up only once and each layer
+         * then costs just a draw, which makes it suitable for converting
+         * large sets of equally-sized images. The @p output is expected to
+         * have at least as many layers as @p input. Each layer is processed
+         * independently, values from neighboring layers don't affect each
+         * other.
+         *
+         * Available only with @ref DistanceFieldAlgorithm::BruteForce.
+         * @requires_gl30 Extension @gl_extension{EXT,texture_array}
+         * @requires_gles30 Texture arrays are not available in OpenGL ES
+         *      2.0.
+         * @requires_webgl20 Texture arrays are not available in WebGL 1.0.
+         */
+        void operator()(GL::Texture2DArray& input, GL::Texture2DArray& output, const Range2Di& rectangle, const Vector3i& imageSize
+            #ifndef MAGNUM_TARGET_GLES
+            = {}
+            #endif
+        );
+        #endif
+
     private:
+        MAGNUM_LOCAL void process(GL::Texture2D& input, GL::Texture2D& output, const Range2Di& rectangle, Containers::ArrayView<const Range2Di> dirtyRectangles, const Vector2i& imageSize);
+
         struct State;
         Containers::Pointer<State> _state;
 };
@@ -0,0 +1,115 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/* Jump flooding, done in three kinds of passes selected by a define. Each
+   pixel of the seed texture contains coordinates of the nearest inside pixel
+   in RG and of the nearest outside pixel in BA, or -1 if not found yet. */
+
+#ifndef RUNTIME_CONST
+#define const
+#endif
+
+#if defined(JUMP_FLOOD_INITIALIZE) || defined(JUMP_FLOOD_OUTPUT)
+uniform lowp sampler2D textureData;
+#endif
+
+#if defined(JUMP_FLOOD_STEP) || defined(JUMP_FLOOD_OUTPUT)
+uniform highp isampler2D seedData;
+#endif
+
+#ifdef JUMP_FLOOD_STEP
+uniform highp int stepSize;
+#endif
+
+#ifdef JUMP_FLOOD_OUTPUT
+uniform mediump vec2 scaling;
+
+out lowp float value;
+#else
+out highp ivec4 seed;
+#endif
+
+#ifdef JUMP_FLOOD_STEP
+void updateNearest(const highp ivec2 position, const highp ivec2 candidate, inout highp ivec2 nearest, inout highp int nearestDistanceSquared) {
+    if(candidate.x < 0) return;
+    const highp ivec2 delta = candidate - position;
+    const highp int distanceSquared = delta.x*delta.x + delta.y*delta.y;
+    if(distanceSquared < nearestDistanceSquared) {
+        nearest = candidate;
+        nearestDistanceSquared = distanceSquared;
+    }
+}
+#endif
+
+void main() {
+    #ifdef JUMP_FLOOD_INITIALIZE
+    /* Every pixel is the nearest pixel of its own kind */
+    const highp ivec2 position = ivec2(gl_FragCoord.xy);
+    seed = texelFetch(textureData, position, 0).r > 0.5 ?
+        ivec4(position, -1, -1) : ivec4(-1, -1, position);
+
+    #elif defined(JUMP_FLOOD_STEP)
+    /* Look at the eight neighbors in given step distance and take the nearest
+       seeds they know about */
+    const highp ivec2 position = ivec2(gl_FragCoord.xy);
+    const highp ivec2 size = textureSize(seedData, 0);
+    highp ivec2 nearestInside = ivec2(-1);
+    highp ivec2 nearestOutside = ivec2(-1);
+    highp int nearestInsideDistanceSquared = 0x7fffffff;
+    highp int nearestOutsideDistanceSquared = 0x7fffffff;
+    for(int y = -1; y <= 1; ++y) for(int x = -1; x <= 1; ++x) {
+        const highp ivec2 neighbor = position + ivec2(x, y)*stepSize;
+        if(any(lessThan(neighbor, ivec2(0))) || any(greaterThanEqual(neighbor, size)))
+            continue;
+
+        const highp ivec4 neighborSeed = texelFetch(seedData, neighbor, 0);
+        updateNearest(position, neighborSeed.xy, nearestInside, nearestInsideDistanceSquared);
+        updateNearest(position, neighborSeed.zw, nearestOutside, nearestOutsideDistanceSquared);
+    }
+    seed = ivec4(nearestInside, nearestOutside);
+
+    #elif defined(JUMP_FLOOD_OUTPUT)
+    /* Same position calculation as in the brute-force shader */
+    const mediump ivec2 position = ivec2((gl_FragCoord.xy - vec2(0.5))*scaling);
+
+    /* Distance to the nearest pixel of the opposite kind, clamped the same
+       way as in the brute-force shader */
+    const bool isInside = texelFetch(textureData, position, 0).r > 0.5;
+    const highp ivec4 positionSeed = texelFetch(seedData, position, 0);
+    const highp ivec2 nearest = isInside ? positionSeed.zw : positionSeed.xy;
+    highp int minDistanceSquared = (RADIUS+1)*(RADIUS+1);
+    if(nearest.x >= 0) {
+        const highp ivec2 delta = nearest - position;
+        minDistanceSquared = min(minDistanceSquared, delta.x*delta.x + delta.y*delta.y);
+    }
+    const mediump float minDistance = sqrt(float(minDistanceSquared));
+
+    /* Final signed distance, normalized from [-radius-1, radius+1] to [0, 1] */
+    const highp float halfSign = isInside ? 0.5 : -0.5;
+    value = halfSign*minDistance/float(RADIUS + 1) + 0.5;
+    #else
+    #error no pass selected
+    #endif
+}
@@ -45,7 +45,16 @@ uniform mediump vec2 scaling;
 #ifdef EXPLICIT_TEXTURE_LAYER
 layout(binding = 7)
 #endif
+#ifndef TEXTURE_ARRAY
 uniform lowp sampler2D textureData;
+#else
+uniform lowp sampler2DArray textureData;
+
+#ifdef EXPLICIT_UNIFORM_LOCATION
+layout(location = 2)
+#endif
+uniform highp int layer;
+#endif
 
 #ifdef TEXELFETCH_USABLE
 #ifndef GL_ES
@@ -64,11 +73,19 @@ out lowp float value;
 
 #ifdef TEXELFETCH_USABLE
 bool hasValue(const mediump ivec2 position, const mediump ivec2 offset) {
+    #ifndef TEXTURE_ARRAY
     return texelFetch(textureData, position + offset, 0).r > 0.5;
+    #else
+    return texelFetch(textureData, ivec3(position + offset, layer), 0).r > 0.5;
+    #endif
 }
 #else
 bool hasValue(const mediump vec2 position, const mediump ivec2 offset) {
+    #ifndef TEXTURE_ARRAY
     return texture(textureData, position + (vec2(offset) + vec2(0.5))*imageSizeInverted).r > 0.5;
+    #else
+    return texture(textureData, vec3(position + (vec2(offset) + vec2(0.5))*imageSizeInverted, float(layer))).r > 0.5;
+    #endif
 }
 #endif
 
@@ -0,0 +1,192 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "EuclideanDistanceField.h"
+
+#include <limits>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Squared distance transform of a 1D function f into d, with v and z being
+   temporary storage for parabola positions and their boundaries, v having at
+   least n and z at least n + 1 items */
+void distanceTransform(const Float* const f, const Int n, Float* const d, Int* const v, Float* const z) {
+    Int k = 0;
+    v[0] = 0;
+    z[0] = -std::numeric_limits<Float>::infinity();
+    z[1] = +std::numeric_limits<Float>::infinity();
+
+    /* Build the lower envelope of parabolas rooted at each q. As f is
+       finite, the intersection is never below z[0] and k never underflows. */
+    for(Int q = 1; q < n; ++q) {
+        Float s = (f[q] - f[v[k]] + Float((q - v[k])*(q + v[k])))/Float(2*(q - v[k]));
+        while(s <= z[k]) {
+            --k;
+            s = (f[q] - f[v[k]] + Float((q - v[k])*(q + v[k])))/Float(2*(q - v[k]));
+        }
+
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = +std::numeric_limits<Float>::infinity();
+    }
+
+    /* Sample the envelope */
+    k = 0;
+    for(Int q = 0; q < n; ++q) {
+        while(z[k + 1] < Float(q)) ++k;
+        const Int p = v[k];
+        d[q] = Float((q - p)*(q - p)) + f[p];
+    }
+}
+
+}
+
+void euclideanDistanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm ||
+                   input.format() == PixelFormat::RG8Unorm ||
+                   input.format() == PixelFormat::RGB8Unorm ||
+                   input.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::euclideanDistanceFieldInto(): unsupported input format" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::R8Unorm,
+        "TextureTools::euclideanDistanceFieldInto(): expected output format" << PixelFormat::R8Unorm << "but got" << output.format(), );
+    CORRADE_ASSERT(radius < 65535,
+        "TextureTools::euclideanDistanceFieldInto(): expected radius to be less than 65535, got" << radius, );
+
+    const Vector2i outputSize = output.size();
+    if(!outputSize.product()) return;
+
+    const Vector2i inputSize = input.size();
+    CORRADE_ASSERT(inputSize.product(),
+        "TextureTools::euclideanDistanceFieldInto(): expected a non-empty input image", );
+
+    const Containers::StridedArrayView3D<const char> inputPixels = input.pixels();
+    const auto isInside = [&inputPixels](const Int x, const Int y) {
+        return UnsignedByte(inputPixels[y][x][0]) > 127;
+    };
+
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), inputSize.product());
+
+    /* For each input pixel, distance to the nearest pixel of the opposite
+       color in the same column, clamped to radius + 1. Done in two sweeps
+       going row by row to have a cache-friendly access pattern, with the
+       columns split across threads. */
+    const UnsignedShort maxDistance = UnsignedShort(radius + 1);
+    Containers::Array<UnsignedShort> columnDistances{Containers::NoInit, std::size_t(inputSize.product())};
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(inputSize.x(), threadCount, thread);
+        const Int begin = Int(range.first), end = Int(range.second);
+
+        for(Int x = begin; x != end; ++x)
+            columnDistances[x] = maxDistance;
+        for(Int y = 1; y != inputSize.y(); ++y) {
+            UnsignedShort* const row = columnDistances + y*inputSize.x();
+            const UnsignedShort* const prev = row - inputSize.x();
+            for(Int x = begin; x != end; ++x)
+                row[x] = isInside(x, y) != isInside(x, y - 1) ? 1 :
+                    UnsignedShort(Math::min(prev[x] + 1, Int(maxDistance)));
+        }
+        for(Int y = inputSize.y() - 2; y >= 0; --y) {
+            UnsignedShort* const row = columnDistances + y*inputSize.x();
+            const UnsignedShort* const next = row + inputSize.x();
+            for(Int x = begin; x != end; ++x)
+                row[x] = isInside(x, y) != isInside(x, y + 1) ? 1 :
+                    UnsignedShort(Math::min(Int(row[x]), next[x] + 1));
+        }
+    });
+
+    /* For each output row, propagate the squared column distances along the
+       corresponding input row, once for the distance to the nearest inside
+       pixel and once to the nearest outside pixel. For a pixel of given color
+       the distance to the nearest pixel of the same color is zero and to the
+       opposite color it's the column distance. */
+    const Vector2 scaling = Vector2{inputSize}/Vector2{outputSize};
+    const Float maxDistanceSquared = Float(maxDistance)*Float(maxDistance);
+    const Containers::StridedArrayView2D<UnsignedByte> outputPixels = output.pixels<UnsignedByte>();
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(outputSize.y(), threadCount, thread);
+
+        /* Per-thread temporary storage */
+        const std::size_t width = inputSize.x();
+        Containers::Array<Float> f{Containers::NoInit, width*4};
+        Containers::Array<Int> v{Containers::NoInit, width};
+        const Containers::ArrayView<Float> fInside = f.prefix(width);
+        const Containers::ArrayView<Float> fOutside = f.slice(width, width*2);
+        const Containers::ArrayView<Float> dInside = f.slice(width*2, width*3);
+        const Containers::ArrayView<Float> dOutside = f.slice(width*3, width*4);
+        Containers::Array<Float> z{Containers::NoInit, width + 1};
+
+        for(std::size_t outputY = range.first; outputY != range.second; ++outputY) {
+            const Int y = Math::min(Int(Float(outputY)*scaling.y()), inputSize.y() - 1);
+            const UnsignedShort* const row = columnDistances + y*inputSize.x();
+
+            /* Squared distance to the nearest inside and outside pixel in the
+               column */
+            for(Int x = 0; x != inputSize.x(); ++x) {
+                const Float distanceSquared = Float(row[x])*Float(row[x]);
+                if(isInside(x, y)) {
+                    fInside[x] = 0.0f;
+                    fOutside[x] = distanceSquared;
+                } else {
+                    fInside[x] = distanceSquared;
+                    fOutside[x] = 0.0f;
+                }
+            }
+
+            distanceTransform(fInside, inputSize.x(), dInside, v, z);
+            distanceTransform(fOutside, inputSize.x(), dOutside, v, z);
+
+            /* Same normalization as in the GPU implementation */
+            for(Int outputX = 0; outputX != outputSize.x(); ++outputX) {
+                const Int x = Math::min(Int(Float(outputX)*scaling.x()), inputSize.x() - 1);
+                const bool inside = isInside(x, y);
+                const Float distance = Math::sqrt(Math::min(inside ? dOutside[x] : dInside[x], maxDistanceSquared));
+                const Float value = (inside ? 0.5f : -0.5f)*distance/Float(maxDistance) + 0.5f;
+                outputPixels[outputY][outputX] = UnsignedByte(value*255.0f + 0.5f);
+            }
+        }
+    });
+}
+
+Image2D euclideanDistanceField(const ImageView2D& input, const Vector2i& size, const UnsignedInt radius, const UnsignedInt threadCount) {
+    /* Rows are aligned to four bytes by default */
+    const std::size_t rowLength = 4*((size.x() + 3)/4);
+    Image2D output{PixelFormat::R8Unorm, size, Containers::Array<char>{Containers::NoInit, rowLength*size.y()}};
+    euclideanDistanceFieldInto(input, output, radius, threadCount);
+    return output;
+}
+
+}}
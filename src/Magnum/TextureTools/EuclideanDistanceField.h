@@ -0,0 +1,94 @@
+#ifndef Magnum_TextureTools_EuclideanDistanceField_h
+#define Magnum_TextureTools_EuclideanDistanceField_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::euclideanDistanceField(), @ref Magnum::TextureTools::euclideanDistanceFieldInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Create a signed distance field on the CPU
+@param[in] input        Input image
+@param[out] output      Output image
+@param[in] radius       Max distance
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+A CPU counterpart to @ref DistanceField, usable without a GPU context. The
+@p input is treated as a binary image, with a pixel being inside if its first
+channel is larger than @cpp 0.5 @ce, and is expected to be in
+@ref PixelFormat::R8Unorm, @ref PixelFormat::RG8Unorm,
+@ref PixelFormat::RGB8Unorm or @ref PixelFormat::RGBA8Unorm and non-empty. The
+@p output is expected to be in @ref PixelFormat::R8Unorm, its size can be
+different from @p input, usually smaller. The @p radius is expected to be less
+than @cpp 65535 @ce.
+
+Output pixels are calculated the same way as in the
+@ref TextureTools-DistanceField-algorithm "GPU implementation" --- each maps
+to an input pixel, the distance to the nearest input pixel of the opposite
+color is clamped to @p radius + 1, normalized to the @f$ [0, 1] @f$ range with
+values above @cpp 0.5 @ce being inside, and rounded to the output format.
+Apart from rounding differences the results are thus identical.
+
+@section TextureTools-euclideanDistanceFieldInto-algorithm The algorithm
+
+Instead of searching the neighborhood of each pixel, an exact Euclidean
+distance transform is calculated in time linear to the input pixel count and
+independent of @p radius, separately along columns and rows. First, for each
+input pixel the distance to the nearest pixel of the opposite color in the
+same column is found with two linear sweeps. Then, for each input row that
+maps to an output row, the squared distances are propagated along the row by
+calculating a lower envelope of parabolas rooted at each column. The columns
+and the rows are split across @p threadCount threads, with fewer threads used
+for small images, where the threading overhead would outweigh the gains.
+
+Based on: *Pedro F. Felzenszwalb, Daniel P. Huttenlocher - Distance Transforms
+of Sampled Functions, Theory of Computing 8, 2012,
+https://cs.brown.edu/people/pfelzens/dt/*
+@see @ref euclideanDistanceField()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void euclideanDistanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius, UnsignedInt threadCount = 1);
+
+/**
+@brief Create a signed distance field on the CPU
+@m_since_latest
+
+Allocates a @ref PixelFormat::R8Unorm image of @p size and calls
+@ref euclideanDistanceFieldInto() with it. See its documentation for more
+information.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D euclideanDistanceField(const ImageView2D& input, const Vector2i& size, UnsignedInt radius, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateMipmaps.h"
+
+#include "FlipImage.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+
+namespace Magnum { namespace TextureTools {
+
+void flipImageYInPlace(const MutableImageView2D& image, UnsignedInt threadCount) {
+    const Vector2i size = image.size();
+    if(size.y() < 2 || !size.x()) return;
+
+    const Containers::StridedArrayView3D<char> pixels = image.pixels();
+    const std::size_t rowSize = size.x()*image.pixelSize();
+    const std::size_t pairCount = size.y()/2;
+
+    /* Row pairs are the work items, but the thread count is clamped based on
+       pixel count to be consistent with other TextureTools APIs */
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), std::size_t(size.x())*pairCount);
+
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(pairCount, threadCount, thread);
+
+        /* Per-thread temporary row */
+        Containers::Array<char> row{Containers::NoInit, rowSize};
+        for(std::size_t y = range.first; y != range.second; ++y) {
+            char* const a = static_cast<char*>(pixels[y].data());
+            char* const b = static_cast<char*>(pixels[size.y() - y - 1].data());
+            std::memcpy(row.data(), a, rowSize);
+            std::memcpy(a, b, rowSize);
+            std::memcpy(b, row.data(), rowSize);
+        }
+    });
+}
+
+}}
@@ -0,0 +1,67 @@
+#ifndef Magnum_TextureTools_FlipImage_h
+#define Magnum_TextureTools_FlipImage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::flipImageYInPlace()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Flip an image upside down in place
+@param image        Image to flip
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Swaps the first row with the last, the second with the second-to-last etc.,
+converting between the bottom-up row order used by Magnum and OpenGL and the
+top-down order used by most file formats and by Vulkan. Each pair of rows is
+swapped with three @ref std::memcpy() calls through a temporary row, so the
+operation works for any uncompressed pixel format, including
+implementation-specific ones. Row padding expressed through the image
+@ref PixelStorage is respected and left untouched. The row pairs are split
+across @p threadCount threads, with fewer threads used for small images,
+where the threading overhead would outweigh the gains.
+
+A @ref Trade::ImageData2D is implicitly convertible to
+@ref MutableImageView2D, so it can be flipped directly if its
+@ref Trade::ImageData::dataFlags() "dataFlags()" contain
+@ref Trade::DataFlag::Mutable. Importers that support
+@ref Trade::ImporterFlag::YFlip can perform the flip during import instead,
+avoiding the extra pass over the data.
+@see @ref swizzleImageInPlace()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void flipImageYInPlace(const MutableImageView2D& image, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
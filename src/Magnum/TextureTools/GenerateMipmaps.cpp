@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateMipmaps.h"
+
+#include <cmath>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/ConvertPixelFormat.h"
+#include "Magnum/TextureTools/Implementation/pixelFormatInfo.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+Float sinc(Float x) {
+    if(Math::abs(x) < 1.0e-6f) return 1.0f;
+    x *= Constants::pi();
+    return std::sin(x)/x;
+}
+
+/* Modified Bessel function of the first kind of order zero, evaluated with
+   its power series */
+Float bessel0(const Float x) {
+    const Float halfX = 0.5f*x;
+    Float sum = 1.0f, term = 1.0f, k = 0.0f;
+    for(;;) {
+        k += 1.0f;
+        term *= halfX/k;
+        const Float squared = term*term;
+        sum += squared;
+        if(squared < sum*1.0e-7f) return sum;
+    }
+}
+
+/* The filters take a distance in destination pixels. The box is half-open
+   so samples exactly on the edge aren't counted twice. */
+Float box(const Float x) {
+    return x >= -0.5f && x < 0.5f ? 1.0f : 0.0f;
+}
+
+constexpr Float KaiserRadius = 3.0f;
+constexpr Float KaiserAlpha = 4.0f;
+
+Float kaiser(const Float x) {
+    const Float t = x/KaiserRadius;
+    if(t*t >= 1.0f) return 0.0f;
+    return sinc(x)*bessel0(KaiserAlpha*std::sqrt(1.0f - t*t))/bessel0(KaiserAlpha);
+}
+
+constexpr Float LanczosRadius = 3.0f;
+
+Float lanczos(const Float x) {
+    if(Math::abs(x) >= LanczosRadius) return 0.0f;
+    return sinc(x)*sinc(x/LanczosRadius);
+}
+
+/* Source pixel indices and weights for each destination pixel along one
+   dimension, with tapCount taps for each */
+struct Taps {
+    std::size_t tapCount;
+    Containers::Array<Int> indices;
+    Containers::Array<Float> weights;
+};
+
+Taps calculateTaps(const Int srcSize, const Int dstSize, const MipmapFilter filter) {
+    Float radius;
+    Float(*function)(Float);
+    switch(filter) {
+        case MipmapFilter::Box:
+            radius = 0.5f;
+            function = box;
+            break;
+        case MipmapFilter::Kaiser:
+            radius = KaiserRadius;
+            function = kaiser;
+            break;
+        case MipmapFilter::Lanczos:
+            radius = LanczosRadius;
+            function = lanczos;
+            break;
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    /* The filter is scaled to the source pixel size, which is usually 2 but
+       can be slightly more for odd sizes and is 1 for a dimension that's
+       already a single pixel */
+    const Float scale = Float(srcSize)/Float(dstSize);
+    const Float support = radius*scale;
+
+    Taps taps;
+    taps.tapCount = std::size_t(std::ceil(2.0f*support)) + 1;
+    taps.indices = Containers::Array<Int>{Containers::NoInit, dstSize*taps.tapCount};
+    taps.weights = Containers::Array<Float>{Containers::NoInit, dstSize*taps.tapCount};
+    for(Int i = 0; i != dstSize; ++i) {
+        const Float center = (Float(i) + 0.5f)*scale;
+        const Int first = Int(std::floor(center - support));
+
+        Int* const indices = taps.indices + i*taps.tapCount;
+        Float* const weights = taps.weights + i*taps.tapCount;
+        Float sum = 0.0f;
+        for(std::size_t j = 0; j != taps.tapCount; ++j) {
+            const Int index = first + Int(j);
+            const Float weight = function((Float(index) + 0.5f - center)/scale);
+            indices[j] = Math::clamp(index, 0, srcSize - 1);
+            weights[j] = weight;
+            sum += weight;
+        }
+
+        /* Normalize so the image brightness is preserved */
+        for(std::size_t j = 0; j != taps.tapCount; ++j)
+            weights[j] /= sum;
+    }
+
+    return taps;
+}
+
+}
+
+UnsignedInt mipmapLevelCount(const Vector2i& size) {
+    CORRADE_ASSERT(size.product(),
+        "TextureTools::mipmapLevelCount(): expected a non-zero size, got" << size, {});
+    return Math::log2(UnsignedInt(Math::max(size.x(), size.y()))) + 1;
+}
+
+Containers::Array<Image2D> generateMipmaps(const ImageView2D& image, const MipmapFilter filter, UnsignedInt threadCount) {
+    const Implementation::FormatInfo info = Implementation::formatInfo(image.format());
+    CORRADE_ASSERT(info.channelCount,
+        "TextureTools::generateMipmaps(): unsupported format" << image.format(), {});
+    CORRADE_ASSERT(image.size().product(),
+        "TextureTools::generateMipmaps(): expected a non-empty image", {});
+
+    threadCount = Magnum::Implementation::resolveThreadCount(threadCount);
+
+    /* Filter in linear floating-point, with the same channel count as the
+       input */
+    constexpr PixelFormat FloatFormats[]{
+        PixelFormat::R32F,
+        PixelFormat::RG32F,
+        PixelFormat::RGB32F,
+        PixelFormat::RGBA32F
+    };
+    const PixelFormat floatFormat = FloatFormats[info.channelCount - 1];
+    const std::size_t channelCount = info.channelCount;
+
+    Vector2i srcSize = image.size();
+    Containers::Array<Float> src{Containers::NoInit, std::size_t(srcSize.product())*channelCount};
+    convertPixelFormatInto(image, MutableImageView2D{floatFormat, srcSize, src}, {}, threadCount);
+
+    const UnsignedInt levelCount = mipmapLevelCount(srcSize) - 1;
+    Containers::Array<Image2D> out{Containers::DirectInit, levelCount, image.format()};
+    for(UnsignedInt level = 0; level != levelCount; ++level) {
+        const Vector2i dstSize = Math::max(srcSize/2, Vector2i{1});
+        const Taps horizontal = calculateTaps(srcSize.x(), dstSize.x(), filter);
+        const Taps vertical = calculateTaps(srcSize.y(), dstSize.y(), filter);
+
+        /* Filter along rows, each source row into a row of destination
+           width */
+        const std::size_t srcRowSize = srcSize.x()*channelCount;
+        const std::size_t dstRowSize = dstSize.x()*channelCount;
+        Containers::Array<Float> rows{Containers::NoInit, srcSize.y()*dstRowSize};
+        const UnsignedInt rowThreadCount = Magnum::Implementation::clampThreadCount(threadCount, srcSize.y()*dstSize.x());
+        Magnum::Implementation::runOnThreads(rowThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(srcSize.y(), rowThreadCount, thread);
+            for(std::size_t y = range.first; y != range.second; ++y) {
+                const Float* const in = src + y*srcRowSize;
+                Float* const outRow = rows + y*dstRowSize;
+                for(Int x = 0; x != dstSize.x(); ++x) {
+                    const Int* const indices = horizontal.indices + x*horizontal.tapCount;
+                    const Float* const weights = horizontal.weights + x*horizontal.tapCount;
+                    Float* const outPixel = outRow + x*channelCount;
+                    for(std::size_t c = 0; c != channelCount; ++c)
+                        outPixel[c] = 0.0f;
+                    for(std::size_t j = 0; j != horizontal.tapCount; ++j) {
+                        const Float* const inPixel = in + indices[j]*channelCount;
+                        for(std::size_t c = 0; c != channelCount; ++c)
+                            outPixel[c] += weights[j]*inPixel[c];
+                    }
+                }
+            }
+        });
+
+        /* Filter along columns, accumulating whole rows at once so the inner
+           loop is contiguous */
+        Containers::Array<Float> dst{Containers::ValueInit, std::size_t(dstSize.y())*dstRowSize};
+        const UnsignedInt columnThreadCount = Magnum::Implementation::clampThreadCount(threadCount, dstSize.product());
+        Magnum::Implementation::runOnThreads(columnThreadCount, [&](const UnsignedInt thread) {
+            const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(dstSize.y(), columnThreadCount, thread);
+            for(std::size_t y = range.first; y != range.second; ++y) {
+                const Int* const indices = vertical.indices + y*vertical.tapCount;
+                const Float* const weights = vertical.weights + y*vertical.tapCount;
+                Float* const outRow = dst + y*dstRowSize;
+                for(std::size_t j = 0; j != vertical.tapCount; ++j) {
+                    const Float weight = weights[j];
+                    const Float* const in = rows + indices[j]*dstRowSize;
+                    for(std::size_t i = 0; i != dstRowSize; ++i)
+                        outRow[i] += weight*in[i];
+                }
+            }
+        });
+
+        out[level] = convertPixelFormat(ImageView2D{floatFormat, dstSize, dst}, image.format(), {}, threadCount);
+
+        src = std::move(dst);
+        srcSize = dstSize;
+    }
+
+    return out;
+}
+
+}}
@@ -0,0 +1,122 @@
+#ifndef Magnum_TextureTools_GenerateMipmaps_h
+#define Magnum_TextureTools_GenerateMipmaps_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::generateMipmaps(), @ref Magnum::TextureTools::mipmapLevelCount(), enum @ref Magnum::TextureTools::MipmapFilter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Mipmap filter
+@m_since_latest
+
+@see @ref generateMipmaps()
+*/
+enum class MipmapFilter: UnsignedByte {
+    /**
+     * Box filter, averaging each 2x2 block of pixels. Fastest, but the result
+     * is blurrier and more prone to aliasing than with the other filters.
+     * Equivalent to what @ref GL::Texture::generateMipmap() does on most
+     * drivers.
+     */
+    Box,
+
+    /**
+     * Kaiser-windowed sinc filter with a radius of three destination pixels
+     * and @f$ \alpha = 4 @f$. A good tradeoff between sharpness and ringing,
+     * recommended as the default.
+     */
+    Kaiser,
+
+    /**
+     * Lanczos filter with a radius of three destination pixels. Sharper than
+     * @ref MipmapFilter::Kaiser, but with more pronounced ringing around
+     * hard edges.
+     */
+    Lanczos
+};
+
+/**
+@brief Mip level count for given image size
+@m_since_latest
+
+Count of levels in a full mip chain including the base level, i.e. until the
+level is @cpp 1 @ce pixel in both dimensions. Expects that @p size is
+non-zero in both dimensions.
+@see @ref generateMipmaps()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT UnsignedInt mipmapLevelCount(const Vector2i& size);
+
+/**
+@brief Generate mipmaps on the CPU
+@param image        Base image
+@param filter       Filter to use
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Returns all levels of a full mip chain except the base level, i.e.
+@ref mipmapLevelCount() minus one images, with each having half the size of
+the previous one, rounded down and at least @cpp 1 @ce pixel in each
+dimension. The levels are in the same format as @p image, which is expected
+to be non-empty and in one of the formats supported by
+@ref convertPixelFormatInto(). Rows of the output images are aligned to four
+bytes.
+
+Unlike with @ref GL::Texture::generateMipmap(), the result doesn't depend on a
+driver and it can be done offline, for example to be saved together with the
+base level to a format supporting mip levels:
+
+@snippet MagnumTextureTools-trade.cpp generateMipmaps
+
+@section TextureTools-generateMipmaps-algorithm The algorithm
+
+The @p image is first converted to a floating-point representation, with the
+sRGB formats converted to linear RGB, so the filtering is gamma-correct. Each
+level is then calculated from the previous one with a separable
+@p filter, evaluated at destination pixel centers with clamp-to-edge
+addressing, first along rows and then along columns. The intermediate levels
+are kept in floating-point to avoid accumulating quantization errors, and each
+is converted back to the original format at the end, with the negative lobes
+of the @ref MipmapFilter::Kaiser and @ref MipmapFilter::Lanczos filters
+clamped to the range of the format. Colors aren't premultiplied by alpha. The
+rows of each level are split across @p threadCount threads, with fewer
+threads used for small levels, where the threading overhead would outweigh
+the gains.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image2D> generateMipmaps(const ImageView2D& image, MipmapFilter filter = MipmapFilter::Kaiser, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef Magnum_TextureTools_Implementation_pixelFormatInfo_h
+#define Magnum_TextureTools_Implementation_pixelFormatInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/PixelFormat.h"
+
+namespace Magnum { namespace TextureTools { namespace Implementation {
+
+/* Component type and channel count of formats supported by
+   convertPixelFormatInto() and generateMipmaps() */
+enum class Component: UnsignedByte {
+    Unorm8 = 1, Srgb8, Snorm8, Unorm16, Snorm16, Half, Float
+};
+
+struct FormatInfo {
+    Component component;
+    /* Zero if the format isn't supported */
+    UnsignedInt channelCount;
+};
+
+inline FormatInfo formatInfo(const PixelFormat format) {
+    switch(format) {
+        #define _c(suffix, component)                                       \
+            case PixelFormat::R ## suffix: return {Component::component, 1}; \
+            case PixelFormat::RG ## suffix: return {Component::component, 2}; \
+            case PixelFormat::RGB ## suffix: return {Component::component, 3}; \
+            case PixelFormat::RGBA ## suffix: return {Component::component, 4};
+        _c(8Unorm, Unorm8)
+        _c(8Srgb, Srgb8)
+        _c(8Snorm, Snorm8)
+        _c(16Unorm, Unorm16)
+        _c(16Snorm, Snorm16)
+        _c(16F, Half)
+        _c(32F, Float)
+        #undef _c
+        default: return {};
+    }
+}
+
+}}}
+
+#endif
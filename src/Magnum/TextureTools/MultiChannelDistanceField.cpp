@@ -0,0 +1,525 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MultiChannelDistanceField.h"
+
+#include <cmath>
+#include <unordered_map>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Channel masks */
+enum: UnsignedByte {
+    Red = 1 << 0,
+    Green = 1 << 1,
+    Blue = 1 << 2,
+    Cyan = Green|Blue,
+    Magenta = Red|Blue,
+    Yellow = Red|Green,
+    White = Red|Green|Blue
+};
+
+/* Max deviation of the simplified outline from the marching squares output,
+   in input pixels. The staircase artifacts of rasterized slanted edges are
+   below that. */
+constexpr Float SimplifyTolerance = 1.0f;
+
+/* Max distance by which a vertex can move when refitting the edges, in input
+   pixels */
+constexpr Float RefitDistance = 1.5f;
+
+/* Sine of the min angle between two edges for their intersection to be
+   considered stable when refitting */
+constexpr Float RefitSine = 0.1f;
+
+/* Cosine of the min angle by which the outline has to turn in a vertex for it
+   to be a corner. Polygonal approximations of curves turn by less than this
+   in each vertex unless they're very small. */
+constexpr Float CornerCosine = 0.5f;
+
+struct Edge {
+    Vector2 a, b;
+    UnsignedByte channels;
+};
+
+/* Marching squares over samples at input pixel centers, with a ring of
+   outside samples around the image so all contours are closed. Produces
+   closed contours, each as a list of vertices with the inside on the left
+   when going from one vertex to the next. */
+Containers::Array<Containers::Array<Vector2>> extractContours(const Vector2i& size, const Containers::StridedArrayView3D<const char>& pixels) {
+    const auto isInside = [&size, &pixels](const Int x, const Int y) {
+        return x >= 0 && y >= 0 && x < size.x() && y < size.y() &&
+            UnsignedByte(pixels[y][x][0]) > 127;
+    };
+
+    /* Each crossing of a grid edge between two samples gets a unique ID.
+       Horizontal grid edges going right from sample (x, y) have even IDs,
+       vertical going up odd. */
+    const Int stride = size.x() + 2;
+    const auto vertexId = [stride](const Int x, const Int y, const bool vertical) {
+        return UnsignedInt(2*((y + 1)*stride + x + 1) + (vertical ? 1 : 0));
+    };
+    const auto vertexPosition = [](const Int x, const Int y, const bool vertical) {
+        return vertical ? Vector2{x + 0.5f, y + 1.0f} : Vector2{x + 1.0f, y + 0.5f};
+    };
+
+    struct Segment {
+        UnsignedInt from, to;
+        Vector2 a;
+    };
+    Containers::Array<Segment> segments;
+    std::unordered_map<UnsignedInt, UnsignedInt> segmentStartingAt;
+
+    for(Int y = -1; y < size.y(); ++y) for(Int x = -1; x < size.x(); ++x) {
+        /* Cell corners and edges, corner i is shared by edges i - 1 and i */
+        const Vector2i corners[]{{x, y}, {x + 1, y}, {x + 1, y + 1}, {x, y + 1}};
+        const bool inside[]{isInside(x, y), isInside(x + 1, y),
+                            isInside(x + 1, y + 1), isInside(x, y + 1)};
+        const UnsignedInt edgeIds[]{
+            vertexId(x, y, false), vertexId(x + 1, y, true),
+            vertexId(x, y + 1, false), vertexId(x, y, true)};
+        const Vector2 edgePositions[]{
+            vertexPosition(x, y, false), vertexPosition(x + 1, y, true),
+            vertexPosition(x, y + 1, false), vertexPosition(x, y, true)};
+
+        const Int mask = inside[0]*1 + inside[1]*2 + inside[2]*4 + inside[3]*8;
+        if(mask == 0 || mask == 15) continue;
+
+        /* Pairs of crossed edges to connect. Saddles are resolved so the
+           inside is 8-connected, cutting off the outside corners. */
+        Int pairs[2][2];
+        Int pairCount = 1;
+        if(mask == 5) {
+            pairs[0][0] = 0; pairs[0][1] = 1;
+            pairs[1][0] = 2; pairs[1][1] = 3;
+            pairCount = 2;
+        } else if(mask == 10) {
+            pairs[0][0] = 3; pairs[0][1] = 0;
+            pairs[1][0] = 1; pairs[1][1] = 2;
+            pairCount = 2;
+        } else {
+            Int count = 0;
+            for(Int i = 0; i != 4; ++i)
+                if(inside[i] != inside[(i + 1) % 4]) pairs[0][count++] = i;
+            CORRADE_INTERNAL_ASSERT(count == 2);
+        }
+
+        for(Int i = 0; i != pairCount; ++i) {
+            Int from = pairs[i][0], to = pairs[i][1];
+
+            /* A corner on the side that's cut off by the segment. For
+               adjacent edges it's the corner between them, for opposite
+               edges any corner works. */
+            Int reference = 0;
+            if((from + 1) % 4 == to) reference = to;
+            else if((to + 1) % 4 == from) reference = from;
+
+            /* Orient the segment so the inside is on the left */
+            const Vector2 a = edgePositions[from];
+            const Vector2 b = edgePositions[to];
+            const Vector2 corner = Vector2{corners[reference]} + Vector2{0.5f};
+            if((Math::cross(b - a, corner - a) > 0.0f) != inside[reference])
+                std::swap(from, to);
+
+            segmentStartingAt.emplace(edgeIds[from], UnsignedInt(segments.size()));
+            arrayAppend(segments, Segment{edgeIds[from], edgeIds[to], edgePositions[from]});
+        }
+    }
+
+    /* Chain the segments into closed contours */
+    Containers::Array<Containers::Array<Vector2>> contours;
+    Containers::Array<bool> visited{Containers::ValueInit, segments.size()};
+    for(std::size_t i = 0; i != segments.size(); ++i) {
+        if(visited[i]) continue;
+
+        Containers::Array<Vector2> contour;
+        for(std::size_t j = i; !visited[j]; ) {
+            visited[j] = true;
+            arrayAppend(contour, segments[j].a);
+            const auto found = segmentStartingAt.find(segments[j].to);
+            CORRADE_INTERNAL_ASSERT(found != segmentStartingAt.end());
+            j = found->second;
+        }
+
+        arrayAppend(contours, std::move(contour));
+    }
+
+    return contours;
+}
+
+Float distanceToLineSquared(const Vector2& p, const Vector2& a, const Vector2& b) {
+    const Vector2 d = b - a;
+    const Float lengthSquared = d.dot();
+    if(lengthSquared == 0.0f) return (p - a).dot();
+    const Float cross = Math::cross(d, p - a);
+    return cross*cross/lengthSquared;
+}
+
+/* Douglas-Peucker simplification of a closed contour, returns indices of
+   the vertices to keep */
+Containers::Array<UnsignedInt> simplify(const Containers::ArrayView<const Vector2> contour) {
+    const std::size_t n = contour.size();
+    Containers::Array<bool> keep{Containers::ValueInit, n};
+    if(n < 4) for(bool& i: keep) i = true;
+    else {
+        /* Split the contour at the first vertex and the vertex farthest from
+           it and simplify both halves. The second half is processed with
+           indices going past the end. */
+        std::size_t farthest = 0;
+        Float farthestDistance = 0.0f;
+        for(std::size_t i = 1; i != n; ++i) {
+            const Float distance = (contour[i] - contour[0]).dot();
+            if(distance > farthestDistance) {
+                farthestDistance = distance;
+                farthest = i;
+            }
+        }
+
+        keep[0] = keep[farthest] = true;
+        Containers::Array<std::pair<std::size_t, std::size_t>> stack;
+        arrayAppend(stack, std::make_pair(std::size_t{0}, farthest));
+        arrayAppend(stack, std::make_pair(farthest, n));
+        while(stack.size()) {
+            const std::pair<std::size_t, std::size_t> range = stack[stack.size() - 1];
+            arrayRemoveSuffix(stack, 1);
+
+            const Vector2 a = contour[range.first % n];
+            const Vector2 b = contour[range.second % n];
+            std::size_t max = 0;
+            Float maxDistance = SimplifyTolerance*SimplifyTolerance;
+            for(std::size_t i = range.first + 1; i < range.second; ++i) {
+                const Float distance = distanceToLineSquared(contour[i], a, b);
+                if(distance > maxDistance) {
+                    maxDistance = distance;
+                    max = i;
+                }
+            }
+
+            if(!max) continue;
+            keep[max] = true;
+            arrayAppend(stack, std::make_pair(range.first, max));
+            arrayAppend(stack, std::make_pair(max, range.second));
+        }
+    }
+
+    Containers::Array<UnsignedInt> out;
+    for(std::size_t i = 0; i != n; ++i)
+        if(keep[i]) arrayAppend(out, UnsignedInt(i));
+    return out;
+}
+
+/* Fits a line to the contour vertices between each pair of kept vertices and
+   puts the polygon vertices at intersections of consecutive lines. Besides
+   making the edges more precise this recovers corners cut off by the
+   rasterization, which the simplification alone would keep slanted. */
+Containers::Array<Vector2> refit(const Containers::ArrayView<const Vector2> contour, const Containers::ArrayView<const UnsignedInt> kept) {
+    const std::size_t n = contour.size();
+    const std::size_t m = kept.size();
+    Containers::Array<Vector2> out{Containers::NoInit, m};
+    for(std::size_t i = 0; i != m; ++i) out[i] = contour[kept[i]];
+    if(m < 3) return out;
+
+    /* Line through the centroid of the vertices strictly between the two
+       kept vertices, in the direction of their principal axis. With less
+       than two such vertices the line goes through the kept vertices. */
+    Containers::Array<std::pair<Vector2, Vector2>> lines{Containers::ValueInit, m};
+    for(std::size_t i = 0; i != m; ++i) {
+        const std::size_t from = kept[i];
+        std::size_t to = kept[(i + 1) % m];
+        if(to <= from) to += n;
+
+        if(to - from < 3) {
+            lines[i] = {contour[from], (contour[to % n] - contour[from]).normalized()};
+            continue;
+        }
+
+        Vector2 centroid;
+        for(std::size_t j = from + 1; j != to; ++j) centroid += contour[j % n];
+        centroid /= Float(to - from - 1);
+        Float xx{}, yy{}, xy{};
+        for(std::size_t j = from + 1; j != to; ++j) {
+            const Vector2 d = contour[j % n] - centroid;
+            xx += d.x()*d.x();
+            yy += d.y()*d.y();
+            xy += d.x()*d.y();
+        }
+        const Float angle = 0.5f*std::atan2(2.0f*xy, xx - yy);
+        lines[i] = {centroid, {std::cos(angle), std::sin(angle)}};
+    }
+
+    /* Move each vertex to the intersection of its two lines, unless they're
+       nearly parallel or the intersection is too far */
+    for(std::size_t i = 0; i != m; ++i) {
+        const std::pair<Vector2, Vector2>& a = lines[(i + m - 1) % m];
+        const std::pair<Vector2, Vector2>& b = lines[i];
+        const Float denominator = Math::cross(a.second, b.second);
+        if(Math::abs(denominator) < RefitSine) continue;
+
+        const Vector2 intersection = a.first + a.second*(Math::cross(b.first - a.first, b.second)/denominator);
+        if((intersection - out[i]).dot() <= RefitDistance*RefitDistance)
+            out[i] = intersection;
+    }
+
+    return out;
+}
+
+/* Assigns channels to contour edges so edges meeting in a corner differ in
+   at least one channel */
+void colorEdges(const Containers::ArrayView<const Vector2> contour, Containers::Array<Edge>& edges) {
+    const std::size_t n = contour.size();
+    if(n < 2) return;
+
+    Containers::Array<bool> corners{Containers::ValueInit, n};
+    std::size_t cornerCount = 0, firstCorner = 0;
+    for(std::size_t i = 0; i != n; ++i) {
+        const Vector2 in = (contour[i] - contour[(i + n - 1) % n]).normalized();
+        const Vector2 out = (contour[(i + 1) % n] - contour[i]).normalized();
+        if(Math::dot(in, out) < CornerCosine) {
+            if(!cornerCount) firstCorner = i;
+            corners[i] = true;
+            ++cornerCount;
+        }
+    }
+
+    /* Going from the first corner. With more than one corner, colors are
+       cycled for each run of edges between two corners, with the last run
+       differing from both its predecessor and the first run. */
+    const UnsignedByte colors[]{Cyan, Magenta, Yellow};
+    const UnsignedByte teardrop[]{Magenta, White, Yellow};
+    std::size_t run = 0;
+    for(std::size_t i = 0; i != n; ++i) {
+        const std::size_t vertex = (firstCorner + i) % n;
+        if(i && corners[vertex]) ++run;
+
+        UnsignedByte channels;
+        /* A smooth contour has all channels the same */
+        if(!cornerCount || n < 3) channels = White;
+        /* With a single corner, the contour is split into three parts to
+           make the corner distinguishable */
+        else if(cornerCount == 1) channels = teardrop[3*i/n];
+        else channels = colors[run == cornerCount - 1 && run % 3 == 0 ? 1 : run % 3];
+
+        arrayAppend(edges, Edge{contour[vertex], contour[(vertex + 1) % n], channels});
+    }
+}
+
+/* Bucketing of edges into a uniform grid */
+struct Grid {
+    Vector2i size;
+    Float cellSize;
+    Containers::Array<UnsignedInt> offsets;
+    Containers::Array<UnsignedInt> edges;
+
+    Vector2i cell(const Vector2& position) const {
+        return Math::clamp(Vector2i{position/cellSize}, Vector2i{0}, size - Vector2i{1});
+    }
+};
+
+Grid buildGrid(const Vector2i& inputSize, const Float cellSize, const Containers::ArrayView<const Edge> edges) {
+    Grid grid;
+    grid.cellSize = cellSize;
+    grid.size = Vector2i{Vector2{inputSize}/cellSize} + Vector2i{1};
+    grid.offsets = Containers::Array<UnsignedInt>{Containers::ValueInit, std::size_t(grid.size.product()) + 1};
+
+    /* Count edges overlapping each cell first, then turn the counts into
+       offsets and fill the edge indices */
+    for(const Edge& edge: edges) {
+        const Vector2i min = grid.cell(Math::min(edge.a, edge.b));
+        const Vector2i max = grid.cell(Math::max(edge.a, edge.b));
+        for(Int y = min.y(); y <= max.y(); ++y)
+            for(Int x = min.x(); x <= max.x(); ++x)
+                ++grid.offsets[y*grid.size.x() + x + 1];
+    }
+    for(std::size_t i = 1; i != grid.offsets.size(); ++i)
+        grid.offsets[i] += grid.offsets[i - 1];
+
+    grid.edges = Containers::Array<UnsignedInt>{Containers::NoInit, grid.offsets[grid.offsets.size() - 1]};
+    Containers::Array<UnsignedInt> filled{Containers::ValueInit, std::size_t(grid.size.product())};
+    for(std::size_t i = 0; i != edges.size(); ++i) {
+        const Vector2i min = grid.cell(Math::min(edges[i].a, edges[i].b));
+        const Vector2i max = grid.cell(Math::max(edges[i].a, edges[i].b));
+        for(Int y = min.y(); y <= max.y(); ++y) for(Int x = min.x(); x <= max.x(); ++x) {
+            const Int cell = y*grid.size.x() + x;
+            grid.edges[grid.offsets[cell] + filled[cell]++] = UnsignedInt(i);
+        }
+    }
+
+    return grid;
+}
+
+struct Nearest {
+    Float distanceSquared;
+    /* How much the direction to the nearest point is aligned with the edge,
+       used to pick the right edge if the nearest point is a vertex shared by
+       two edges. Zero if the nearest point is inside the edge. */
+    Float alignment;
+    const Edge* edge;
+
+    bool isCloserThan(const Nearest& other) const {
+        return distanceSquared < other.distanceSquared ||
+            (distanceSquared == other.distanceSquared && alignment < other.alignment);
+    }
+};
+
+UnsignedByte pack(const Float distance, const Float maxDistance) {
+    const Float value = 0.5f*Math::clamp(distance/maxDistance, -1.0f, 1.0f) + 0.5f;
+    return UnsignedByte(value*255.0f + 0.5f);
+}
+
+}
+
+void multiChannelDistanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, const UnsignedInt radius, UnsignedInt threadCount) {
+    CORRADE_ASSERT(input.format() == PixelFormat::R8Unorm ||
+                   input.format() == PixelFormat::RG8Unorm ||
+                   input.format() == PixelFormat::RGB8Unorm ||
+                   input.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::multiChannelDistanceFieldInto(): unsupported input format" << input.format(), );
+    CORRADE_ASSERT(output.format() == PixelFormat::RGB8Unorm ||
+                   output.format() == PixelFormat::RGBA8Unorm,
+        "TextureTools::multiChannelDistanceFieldInto(): expected output format" << PixelFormat::RGB8Unorm << "or" << PixelFormat::RGBA8Unorm << "but got" << output.format(), );
+
+    const Vector2i outputSize = output.size();
+    if(!outputSize.product()) return;
+
+    const Vector2i inputSize = input.size();
+    CORRADE_ASSERT(inputSize.product(),
+        "TextureTools::multiChannelDistanceFieldInto(): expected a non-empty input image", );
+
+    /* Reconstruct the outline and assign channels to its edges */
+    const Containers::StridedArrayView3D<const char> inputPixels = input.pixels();
+    Containers::Array<Edge> edges;
+    for(const Containers::Array<Vector2>& contour: extractContours(inputSize, inputPixels)) {
+        const Containers::Array<UnsignedInt> kept = simplify(contour);
+        const Containers::Array<Vector2> polygon = refit(contour, kept);
+        colorEdges(polygon, edges);
+    }
+
+    const Float maxDistance = Float(radius + 1);
+    const Grid grid = buildGrid(inputSize, maxDistance, edges);
+
+    const Vector2 scaling = Vector2{inputSize}/Vector2{outputSize};
+    const Containers::StridedArrayView3D<char> outputPixels = output.pixels();
+    const bool hasAlpha = output.format() == PixelFormat::RGBA8Unorm;
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), outputSize.product());
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(outputSize.y(), threadCount, thread);
+        for(Int outputY = Int(range.first); outputY != Int(range.second); ++outputY) {
+            for(Int outputX = 0; outputX != outputSize.x(); ++outputX) {
+                const Vector2 p = (Vector2{Vector2i{outputX, outputY}} + Vector2{0.5f})*scaling;
+
+                /* Nearest edge of each channel and of any channel within
+                   the max distance */
+                const Nearest none{maxDistance*maxDistance, 0.0f, nullptr};
+                Nearest nearest[]{none, none, none};
+                Nearest nearestAny = none;
+                const Vector2i min = grid.cell(p - Vector2{maxDistance});
+                const Vector2i max = grid.cell(p + Vector2{maxDistance});
+                for(Int cellY = min.y(); cellY <= max.y(); ++cellY) for(Int cellX = min.x(); cellX <= max.x(); ++cellX) {
+                    const Int cell = cellY*grid.size.x() + cellX;
+                    for(UnsignedInt i = grid.offsets[cell]; i != grid.offsets[cell + 1]; ++i) {
+                        const Edge& edge = edges[grid.edges[i]];
+                        const Vector2 d = edge.b - edge.a;
+                        const Float lengthSquared = d.dot();
+                        if(lengthSquared == 0.0f) continue;
+
+                        /* Picking the vertices directly to have the distances
+                           to a shared vertex bit-exact for both edges */
+                        const Float t = Math::dot(p - edge.a, d)/lengthSquared;
+                        Nearest candidate{0.0f, 0.0f, &edge};
+                        if(t <= 0.0f || t >= 1.0f) {
+                            const Vector2 delta = p - (t <= 0.0f ? edge.a : edge.b);
+                            candidate.distanceSquared = delta.dot();
+                            if(candidate.distanceSquared != 0.0f)
+                                candidate.alignment = Math::abs(Math::dot(d, delta))/Math::sqrt(lengthSquared*candidate.distanceSquared);
+                        } else candidate.distanceSquared = (p - (edge.a + d*t)).dot();
+
+                        if(candidate.isCloserThan(nearestAny))
+                            nearestAny = candidate;
+                        for(Int channel = 0; channel != 3; ++channel)
+                            if((edge.channels & (1 << channel)) && candidate.isCloserThan(nearest[channel]))
+                                nearest[channel] = candidate;
+                    }
+                }
+
+                /* True signed distance, positive inside. Far from the
+                   outline it's clamped and the sign is taken from the input
+                   pixel. */
+                Float distance;
+                if(nearestAny.edge) {
+                    const Edge& edge = *nearestAny.edge;
+                    distance = Math::sqrt(nearestAny.distanceSquared);
+                    if(Math::cross(edge.b - edge.a, p - edge.a) < 0.0f)
+                        distance = -distance;
+                } else {
+                    const Vector2i pixel = Math::min(Vector2i{p}, inputSize - Vector2i{1});
+                    distance = UnsignedByte(inputPixels[pixel.y()][pixel.x()][0]) > 127 ? maxDistance : -maxDistance;
+                }
+
+                /* Pseudo-distance to the nearest edge line for each
+                   channel, which is what keeps the corners sharp */
+                Float channels[3];
+                for(Int channel = 0; channel != 3; ++channel) {
+                    if(const Edge* const edge = nearest[channel].edge) {
+                        const Vector2 d = edge->b - edge->a;
+                        channels[channel] = Math::cross(d, p - edge->a)/d.length();
+                    } else channels[channel] = distance < 0.0f ? -maxDistance : maxDistance;
+                }
+
+                /* If the median disagrees with the true distance, fall back
+                   to it */
+                const Float median = Math::max(Math::min(channels[0], channels[1]), Math::min(Math::max(channels[0], channels[1]), channels[2]));
+                if((median < 0.0f) != (distance < 0.0f))
+                    channels[0] = channels[1] = channels[2] = distance;
+
+                const Containers::StridedArrayView1D<char> pixel = outputPixels[outputY][outputX];
+                for(Int channel = 0; channel != 3; ++channel)
+                    pixel[channel] = char(pack(channels[channel], maxDistance));
+                if(hasAlpha) pixel[3] = char(pack(distance, maxDistance));
+            }
+        }
+    });
+}
+
+Image2D multiChannelDistanceField(const ImageView2D& input, const Vector2i& size, const UnsignedInt radius, const UnsignedInt threadCount) {
+    /* Rows are aligned to four bytes by default */
+    const std::size_t rowLength = 4*((3*size.x() + 3)/4);
+    Image2D output{PixelFormat::RGB8Unorm, size, Containers::Array<char>{Containers::NoInit, rowLength*size.y()}};
+    multiChannelDistanceFieldInto(input, output, radius, threadCount);
+    return output;
+}
+
+}}
@@ -0,0 +1,120 @@
+#ifndef Magnum_TextureTools_MultiChannelDistanceField_h
+#define Magnum_TextureTools_MultiChannelDistanceField_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::multiChannelDistanceField(), @ref Magnum::TextureTools::multiChannelDistanceFieldInto()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Create a multi-channel signed distance field on the CPU
+@param[in] input        Input image
+@param[out] output      Output image
+@param[in] radius       Max distance
+@param[in] threadCount  Count of threads to use. If @cpp 0 @ce, the value
+    of @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+A single-channel distance field such as the one produced by
+@ref euclideanDistanceFieldInto() or @ref DistanceField can't represent sharp
+corners, as the bilinearly interpolated distance rounds them off. A
+multi-channel distance field stores distances to differently colored edges of
+the shape in the red, green and blue channels, and the shape is reconstructed
+from a median of the three. Thus, in places where two edges meet in a corner,
+at least one of the channels contains only one of them, and the corner stays
+sharp. Compared to a single-channel distance field, the output can be two to
+four times smaller for the same visual quality. The
+@ref Shaders::DistanceFieldVector shader renders it with
+@ref Shaders::DistanceFieldVector::Flag::MultiChannel enabled.
+
+The @p input is treated as a binary image, with a pixel being inside if its
+first channel is larger than @cpp 0.5 @ce, and is expected to be in
+@ref PixelFormat::R8Unorm, @ref PixelFormat::RG8Unorm,
+@ref PixelFormat::RGB8Unorm or @ref PixelFormat::RGBA8Unorm and non-empty. The
+@p output is expected to be in @ref PixelFormat::RGB8Unorm or
+@ref PixelFormat::RGBA8Unorm, its size can be different from @p input,
+usually smaller. For @ref PixelFormat::RGBA8Unorm the alpha channel contains a
+regular single-channel distance field, which can be used for effects such as
+outlines or shadows that need a true distance. The @p radius is in input
+pixels, same as with @ref euclideanDistanceFieldInto(), and the distances are
+normalized the same way --- clamped to @p radius + 1, mapped to the
+@f$ [0, 1] @f$ range with values above @cpp 0.5 @ce being inside and rounded
+to the output format.
+
+@section TextureTools-multiChannelDistanceFieldInto-algorithm The algorithm
+
+As the input is a raster image and not a vector outline, the outline is
+reconstructed first. Contours between inside and outside pixels are extracted
+with marching squares and simplified to polygons with the Douglas-Peucker
+algorithm. Lines are then fitted to the original contour points of each
+polygon edge and the vertices moved to their intersections, which recovers
+corners cut off by the rasterization. Polygon vertices where the outline turns
+by more than 60° are treated as corners and edges between consecutive corners
+are assigned alternating pairs of channels, so edges meeting in a corner
+always differ in at least one channel.
+
+Then, for each output pixel and each channel, the nearest edge of given
+channel within the @p radius is found and the signed distance to its line is
+stored, which preserves the corners. Edges are bucketed into a grid with cell
+size equal to @p radius + 1, so the cost of each pixel depends only on the
+outline complexity in its neighborhood. Pixels where the median of the three
+channels would disagree with the true inside / outside classification get
+the true distance in all channels, which avoids artifacts where edges of the
+same channel are close to each other. The output rows are split across
+@p threadCount threads, with fewer threads used for small images.
+
+As the outline is reconstructed from pixels, the @p input should be several
+times larger than @p output for the corners to be detected reliably, which is
+the usual case for glyph caches. Corners with an angle larger than 120° are
+rounded.
+
+Based on: *Viktor Chlumský - Shape Decomposition for Multi-channel Distance
+Fields, Czech Technical University in Prague, 2015,
+https://github.com/Chlumsky/msdfgen*
+@see @ref multiChannelDistanceField(),
+    @ref Text::MultiChannelDistanceFieldGlyphCache
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void multiChannelDistanceFieldInto(const ImageView2D& input, const MutableImageView2D& output, UnsignedInt radius, UnsignedInt threadCount = 1);
+
+/**
+@brief Create a multi-channel signed distance field on the CPU
+@m_since_latest
+
+Allocates a @ref PixelFormat::RGB8Unorm image of @p size and calls
+@ref multiChannelDistanceFieldInto() with it. See its documentation for more
+information.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Image2D multiChannelDistanceField(const ImageView2D& input, const Vector2i& size, UnsignedInt radius, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
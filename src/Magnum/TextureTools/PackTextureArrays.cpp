@@ -0,0 +1,131 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PackTextureArrays.h"
+
+#include <cstring>
+#include <vector>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/Atlas.h"
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+struct Group {
+    PixelFormat format;
+    UnsignedInt formatExtra;
+    UnsignedInt pixelSize;
+    Vector2i layerSize;
+};
+
+}
+
+Containers::Array<Image3D> packTextureArrays(const Containers::ArrayView<const ImageView2D> images, const Containers::StridedArrayView1D<TextureArrayPlacement>& placements, const Vector2i& layerSize, const Vector2i& padding) {
+    CORRADE_ASSERT(placements.size() == images.size(),
+        "TextureTools::packTextureArrays(): expected images and placements views to have the same size, got" << images.size() << "and" << placements.size(), {});
+    CORRADE_ASSERT((layerSize > Vector2i{}).all(),
+        "TextureTools::packTextureArrays(): expected a positive layer size, got" << layerSize, {});
+
+    /* Assign each image to a group by format and the smallest power-of-two
+       multiple of the layer size it fits into. Usually there's just a few
+       groups, so a linear search is fine. */
+    std::vector<Group> groups;
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const ImageView2D& image = images[i];
+        Vector2i groupLayerSize = layerSize;
+        while(!(image.size() + 2*padding <= groupLayerSize).all())
+            groupLayerSize *= 2;
+
+        std::size_t group = 0;
+        for(; group != groups.size(); ++group) {
+            const Group& g = groups[group];
+            if(g.format == image.format() && g.formatExtra == image.formatExtra() && g.pixelSize == image.pixelSize() && g.layerSize == groupLayerSize)
+                break;
+        }
+        if(group == groups.size())
+            groups.push_back({image.format(), image.formatExtra(), image.pixelSize(), groupLayerSize});
+
+        placements[i].array = group;
+    }
+
+    /* Image3D has no default constructor, the items are constructed in
+       place once the data are filled */
+    Containers::Array<Image3D> out{Containers::NoInit, groups.size()};
+    Containers::Array<Vector2i> sizes{Containers::NoInit, images.size()};
+    Containers::Array<Vector3i> offsets{Containers::NoInit, images.size()};
+    Containers::Array<UnsignedInt> ids{Containers::NoInit, images.size()};
+    for(std::size_t group = 0; group != groups.size(); ++group) {
+        const Group& g = groups[group];
+
+        /* Gather sizes of images in this group and pack them */
+        std::size_t count = 0;
+        for(std::size_t i = 0; i != images.size(); ++i) {
+            if(placements[i].array != group) continue;
+            ids[count] = i;
+            sizes[count] = images[i].size();
+            ++count;
+        }
+        const Int layerCount = atlasArray(g.layerSize, sizes.prefix(count), offsets.prefix(count), padding);
+
+        /* Rows aligned to four bytes to match the default pixel storage */
+        const std::size_t rowSize = (g.layerSize.x()*g.pixelSize + 3)/4*4;
+        const std::size_t layerDataSize = rowSize*g.layerSize.y();
+        Containers::Array<char> data{Containers::ValueInit, layerDataSize*layerCount};
+
+        const Vector2 layerSizeF{g.layerSize};
+        for(std::size_t j = 0; j != count; ++j) {
+            const ImageView2D& image = images[ids[j]];
+            const Vector2i offset = offsets[j].xy();
+            const Int layer = offsets[j].z();
+
+            TextureArrayPlacement& placement = placements[ids[j]];
+            placement.layer = layer;
+            placement.rectangle = Range2Di::fromSize(offset, image.size());
+            placement.textureMatrix =
+                Matrix3::translation(Vector2{offset}/layerSizeF)*
+                Matrix3::scaling(Vector2{image.size()}/layerSizeF);
+
+            if(!image.data() || !image.size().product()) continue;
+
+            /* Rows of an image are always contiguous */
+            const Containers::StridedArrayView3D<const char> src = image.pixels();
+            const std::size_t srcRowSize = image.size().x()*g.pixelSize;
+            for(Int y = 0; y != image.size().y(); ++y)
+                std::memcpy(data + layer*layerDataSize + (offset.y() + y)*rowSize + offset.x()*g.pixelSize, src[y].data(), srcRowSize);
+        }
+
+        new(&out[group]) Image3D{PixelStorage{}, g.format, g.formatExtra, g.pixelSize, {g.layerSize, layerCount}, std::move(data)};
+    }
+
+    return out;
+}
+
+}}
@@ -0,0 +1,107 @@
+#ifndef Magnum_TextureTools_PackTextureArrays_h
+#define Magnum_TextureTools_PackTextureArrays_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Struct @ref Magnum::TextureTools::TextureArrayPlacement, function @ref Magnum::TextureTools::packTextureArrays()
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Placement of an image in packed texture arrays
+@m_since_latest
+
+@see @ref packTextureArrays()
+*/
+struct TextureArrayPlacement {
+    /** @brief Index of the texture array the image is in */
+    UnsignedInt array;
+
+    /** @brief Layer of the texture array the image is in */
+    Int layer;
+
+    /**
+     * @brief Rectangle the image occupies in the layer
+     *
+     * In pixels, without the padding.
+     */
+    Range2Di rectangle;
+
+    /**
+     * @brief Texture transformation matrix
+     *
+     * Transforms texture coordinates in the @f$ [0, 1] @f$ range of the
+     * original image to the @ref rectangle in the layer. Meant to be passed
+     * to @ref Shaders::Flat::setTextureMatrix() or other shaders with
+     * @ref Shaders::Flat::Flag::TextureTransformation enabled.
+     */
+    Matrix3 textureMatrix;
+};
+
+/**
+@brief Pack images into texture arrays
+@param[in] images       Images to pack
+@param[out] placements  Where each image ended up
+@param[in] layerSize    Layer size for the smallest size class
+@param[in] padding      Padding around each image
+@return Packed texture arrays
+@m_since_latest
+
+Groups the @p images by pixel format and size class and packs each group into
+layers of a separate texture array using @ref atlasArray(), which results in
+as few texture binds as possible compared to having a texture per image. Each
+item of the returned array can be directly uploaded with
+@ref GL::Texture2DArray::setImage() or @ref GL::Texture2DArray::setSubImage():
+
+@snippet MagnumTextureTools.cpp packTextureArrays
+
+The size class of an image is the smallest power-of-two multiple of
+@p layerSize into which the image including @p padding fits, layers of the
+texture array are then of this size. Thus usually all images that fit into
+@p layerSize and share the same format end up in a single array and only
+larger images are put into separate arrays with larger layers. The arrays are
+ordered by first occurrence of given format and size class in @p images.
+
+The pixel format, including the implementation-specific format and extra
+format data, is preserved. Rows of the output images are aligned to four
+bytes and the space not covered by any image is zero-filled. Expects that
+@p images and @p placements have the same size and that @p layerSize is
+positive.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Array<Image3D> packTextureArrays(Containers::ArrayView<const ImageView2D> images, const Containers::StridedArrayView1D<TextureArrayPlacement>& placements, const Vector2i& layerSize, const Vector2i& padding = {});
+
+}}
+
+#endif
@@ -0,0 +1,179 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "GenerateMipmaps.h"
+
+#include "SwizzleImage.h"
+
+#include <cstring>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+#include <immintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+/* Channel count and component size of formats consisting of one to four
+   equally-sized components, zeros if the format isn't supported */
+std::pair<UnsignedInt, UnsignedInt> formatComponents(const PixelFormat format) {
+    switch(format) {
+        #define _c(suffix, size)                                            \
+            case PixelFormat::R ## suffix: return {1, size};                \
+            case PixelFormat::RG ## suffix: return {2, size};               \
+            case PixelFormat::RGB ## suffix: return {3, size};              \
+            case PixelFormat::RGBA ## suffix: return {4, size};
+        _c(8Unorm, 1)
+        _c(8Snorm, 1)
+        _c(8Srgb, 1)
+        _c(8UI, 1)
+        _c(8I, 1)
+        _c(16Unorm, 2)
+        _c(16Snorm, 2)
+        _c(16UI, 2)
+        _c(16I, 2)
+        _c(16F, 2)
+        _c(32UI, 4)
+        _c(32I, 4)
+        _c(32F, 4)
+        #undef _c
+        default: return {};
+    }
+}
+
+/* Permutes bytes of count pixels of pixelSize bytes each. The pixel is
+   copied to a temporary first, so a source byte can be used more than
+   once. */
+void swizzleScalar(char* data, const std::size_t count, const UnsignedByte* const permutation, const std::size_t pixelSize) {
+    char pixel[16];
+    for(std::size_t i = 0; i != count; ++i, data += pixelSize) {
+        std::memcpy(pixel, data, pixelSize);
+        for(std::size_t j = 0; j != pixelSize; ++j)
+            data[j] = pixel[permutation[j]];
+    }
+}
+
+/* Permutes bytes in sixteen-byte blocks, returns the count of bytes
+   processed. The mask is the per-pixel permutation repeated over the whole
+   block, which is possible only if the pixel size divides sixteen. */
+#ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+/* The byte shuffle is SSSE3, which is implied by SSE4.1 */
+MAGNUM_MATH_IMPLEMENTATION_TARGET_SSE41 std::size_t swizzleSsse3(char* const data, const std::size_t size, const UnsignedByte* const mask) {
+    const __m128i shuffle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask));
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        __m128i* const block = reinterpret_cast<__m128i*>(data + i);
+        _mm_storeu_si128(block, _mm_shuffle_epi8(_mm_loadu_si128(block), shuffle));
+    }
+    return i;
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+std::size_t swizzleNeon(char* const data, const std::size_t size, const UnsignedByte* const mask) {
+    const uint8x16_t shuffle = vld1q_u8(mask);
+    std::size_t i = 0;
+    for(; i + 16 <= size; i += 16) {
+        std::uint8_t* const block = reinterpret_cast<std::uint8_t*>(data + i);
+        vst1q_u8(block, vqtbl1q_u8(vld1q_u8(block), shuffle));
+    }
+    return i;
+}
+#endif
+
+typedef std::size_t(*SwizzleBlockKernel)(char*, std::size_t, const UnsignedByte*);
+
+SwizzleBlockKernel swizzleBlockKernel() {
+    #ifdef MAGNUM_MATH_IMPLEMENTATION_X86_DISPATCH
+    if(Math::Implementation::cpuFeatures().sse41) return swizzleSsse3;
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    return swizzleNeon;
+    #endif
+    return nullptr;
+}
+
+}
+
+void swizzleImageInPlace(const MutableImageView2D& image, const Vector4i& channels, UnsignedInt threadCount) {
+    const std::pair<UnsignedInt, UnsignedInt> components = formatComponents(image.format());
+    const UnsignedInt channelCount = components.first;
+    const UnsignedInt componentSize = components.second;
+    CORRADE_ASSERT(channelCount,
+        "TextureTools::swizzleImageInPlace(): unsupported format" << image.format(), );
+    #ifndef CORRADE_NO_ASSERT
+    for(UnsignedInt i = 0; i != channelCount; ++i)
+        CORRADE_ASSERT(channels[i] >= 0 && UnsignedInt(channels[i]) < channelCount,
+            "TextureTools::swizzleImageInPlace(): channel" << channels[i] << "out of range for" << channelCount << "channels", );
+    #endif
+
+    const Vector2i size = image.size();
+    if(!size.product()) return;
+
+    /* Byte permutation of a single pixel, and the same repeated to a
+       sixteen-byte block for the SIMD kernels */
+    const std::size_t pixelSize = channelCount*componentSize;
+    UnsignedByte permutation[16];
+    bool identity = true;
+    for(std::size_t i = 0; i != pixelSize; ++i) {
+        permutation[i] = channels[i/componentSize]*componentSize + i%componentSize;
+        if(permutation[i] != i) identity = false;
+    }
+    if(identity) return;
+
+    UnsignedByte mask[16];
+    SwizzleBlockKernel blockKernel = nullptr;
+    if(16 % pixelSize == 0) {
+        blockKernel = swizzleBlockKernel();
+        for(std::size_t i = 0; i != 16; ++i)
+            mask[i] = (i/pixelSize)*pixelSize + permutation[i%pixelSize];
+    }
+
+    const Containers::StridedArrayView3D<char> pixels = image.pixels();
+    const std::size_t rowSize = size.x()*pixelSize;
+
+    threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(threadCount), size.product());
+
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(size.y(), threadCount, thread);
+        for(std::size_t y = range.first; y != range.second; ++y) {
+            char* const row = static_cast<char*>(pixels[y].data());
+            const std::size_t done = blockKernel ? blockKernel(row, rowSize, mask) : 0;
+            swizzleScalar(row + done, (rowSize - done)/pixelSize, permutation, pixelSize);
+        }
+    });
+}
+
+}}
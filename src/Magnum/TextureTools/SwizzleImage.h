@@ -0,0 +1,83 @@
+#ifndef Magnum_TextureTools_SwizzleImage_h
+#define Magnum_TextureTools_SwizzleImage_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::TextureTools::swizzleImageInPlace()
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/TextureTools/visibility.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Swizzle image channels in place
+@param image        Image to swizzle
+@param channels     Source channel index for each destination channel
+@param threadCount  Count of threads to use. If @cpp 0 @ce, the value of
+    @ref std::thread::hardware_concurrency() is used.
+@m_since_latest
+
+Channel @cpp i @ce of each pixel is replaced with channel
+@cpp channels[i] @ce of the original pixel. Only the first *n* items of
+@p channels are used for an *n*-channel format and each of them is expected
+to be less than *n*. A channel can be used more than once, for example
+@cpp {0, 0, 0, 3} @ce expands red to a grayscale image with alpha preserved.
+The following snippet swaps the red and blue channels of an image imported
+in a BGRA channel order:
+
+@snippet MagnumTextureTools-trade.cpp swizzleImageInPlace
+
+The @p image is expected to be in one of the one- to four-channel
+@ref PixelFormat::R8Unorm "*8Unorm", @ref PixelFormat::R8Snorm "*8Snorm",
+@ref PixelFormat::R8Srgb "*8Srgb", @ref PixelFormat::R8UI "*8UI",
+@ref PixelFormat::R8I "*8I", @ref PixelFormat::R16Unorm "*16Unorm",
+@ref PixelFormat::R16Snorm "*16Snorm", @ref PixelFormat::R16UI "*16UI",
+@ref PixelFormat::R16I "*16I", @ref PixelFormat::R16F "*16F",
+@ref PixelFormat::R32UI "*32UI", @ref PixelFormat::R32I "*32I" or
+@ref PixelFormat::R32F "*32F" formats. As only the component order changes,
+the values are moved bit-exactly without any conversion. Row padding
+expressed through the image @ref PixelStorage is respected.
+
+Formats with four-, eight- and sixteen-byte pixels are processed sixteen
+bytes at a time using a SSSE3 or NEON byte shuffle where available, selected
+at runtime based on @ref Math::cpuTier() on x86. Other formats, and the last
+few pixels of each row, go through a scalar loop with a per-pixel byte
+permutation. The rows are split across @p threadCount threads, with fewer
+threads used for small images, where the threading overhead would outweigh
+the gains. A @ref Trade::ImageData2D with
+@ref Trade::DataFlag::Mutable is implicitly convertible to
+@ref MutableImageView2D and thus can be swizzled directly.
+@see @ref flipImageYInPlace(), @ref convertPixelFormatInto()
+*/
+MAGNUM_TEXTURETOOLS_EXPORT void swizzleImageInPlace(const MutableImageView2D& image, const Vector4i& channels, UnsignedInt threadCount = 1);
+
+}}
+
+#endif
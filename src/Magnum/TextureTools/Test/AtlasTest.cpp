@@ -24,10 +24,16 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/TextureTools/Atlas.h"
 
 namespace Magnum { namespace TextureTools { namespace Test { namespace {
@@ -39,13 +45,47 @@ struct AtlasTest: TestSuite::Tester {
     void createPadding();
     void createEmpty();
     void createTooSmall();
+
+    void array();
+    void arrayPaddingRotations();
+    void arrayEmpty();
+    void arrayNoOverlap();
+    void arrayWrongViewSize();
+    void arrayTooLarge();
+
+    void packer();
+    void packerBatch();
+    void packerEmpty();
+    void packerClear();
+    void packerInvalidSize();
+    void packerWrongViewSize();
+
+    void benchmark();
+    void benchmarkRotations();
 };
 
 AtlasTest::AtlasTest() {
     addTests({&AtlasTest::create,
               &AtlasTest::createPadding,
               &AtlasTest::createEmpty,
-              &AtlasTest::createTooSmall});
+              &AtlasTest::createTooSmall,
+
+              &AtlasTest::array,
+              &AtlasTest::arrayPaddingRotations,
+              &AtlasTest::arrayEmpty,
+              &AtlasTest::arrayNoOverlap,
+              &AtlasTest::arrayWrongViewSize,
+              &AtlasTest::arrayTooLarge,
+
+              &AtlasTest::packer,
+              &AtlasTest::packerBatch,
+              &AtlasTest::packerEmpty,
+              &AtlasTest::packerClear,
+              &AtlasTest::packerInvalidSize,
+              &AtlasTest::packerWrongViewSize});
+
+    addBenchmarks({&AtlasTest::benchmark,
+                   &AtlasTest::benchmarkRotations}, 10);
 }
 
 void AtlasTest::create() {
@@ -55,11 +95,13 @@ void AtlasTest::create() {
         {23, 25}
     });
 
+    /* The tallest goes first, the other two are put on the lowest possible
+       position next to it */
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({0, 0}, {12, 18}),
-        Range2Di::fromSize({32, 0}, {32, 15}),
-        Range2Di::fromSize({0, 25}, {23, 25})}));
+        Range2Di::fromSize({23, 0}, {12, 18}),
+        Range2Di::fromSize({23, 18}, {32, 15}),
+        Range2Di::fromSize({0, 0}, {23, 25})}));
 }
 
 void AtlasTest::createPadding() {
@@ -71,9 +113,9 @@ void AtlasTest::createPadding() {
 
     CORRADE_COMPARE(atlas.size(), 3);
     CORRADE_COMPARE(atlas, (std::vector<Range2Di>{
-        Range2Di::fromSize({2, 1}, {8, 16}),
-        Range2Di::fromSize({34, 1}, {28, 13}),
-        Range2Di::fromSize({2, 26}, {19, 23})}));
+        Range2Di::fromSize({25, 1}, {8, 16}),
+        Range2Di::fromSize({25, 19}, {28, 13}),
+        Range2Di::fromSize({2, 1}, {19, 23})}));
 }
 
 void AtlasTest::createEmpty() {
@@ -86,12 +128,300 @@ void AtlasTest::createTooSmall() {
     Error redirectError{&o};
 
     std::vector<Range2Di> atlas = TextureTools::atlas({64, 32}, {
-        {8, 16},
-        {21, 13},
-        {19, 29}
+        {40, 20},
+        {40, 20}
     }, {2, 1});
     CORRADE_VERIFY(atlas.empty());
-    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 3 Vector(25, 31) textures. Generated atlas will be empty.\n");
+    CORRADE_COMPARE(o.str(), "TextureTools::atlas(): requested atlas size Vector(64, 32) is too small to fit 2 textures. Generated atlas will be empty.\n");
+}
+
+void AtlasTest::array() {
+    const Vector2i sizes[]{
+        {4, 8},
+        {12, 8},
+        {8, 8},
+        {16, 8},
+        {0, 0}
+    };
+    Vector3i offsets[Containers::arraySize(sizes)];
+
+    /* The 8x8 item doesn't fit next to the 12x8 one anymore, so it goes into
+       a new layer, but the 4x8 one after it still fits into the first */
+    CORRADE_COMPARE(atlasArray({16, 16}, sizes, offsets), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {12, 8, 0},
+        {0, 8, 0},
+        {0, 0, 1},
+        {0, 0, 0},
+        {0, 0, 0}
+    }), TestSuite::Compare::Container);
+}
+
+void AtlasTest::arrayPaddingRotations() {
+    const Vector2i sizes[]{
+        {16, 4},
+        {4, 16},
+        {8, 8}
+    };
+    Vector3i offsets[Containers::arraySize(sizes)];
+    bool rotations[Containers::arraySize(sizes)];
+
+    /* The second item fits only when rotated */
+    CORRADE_COMPARE(atlasArray({20, 20}, sizes, offsets, rotations, Vector2i{1, 1}), 2);
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector3i>({
+        {1, 1, 0},
+        {1, 7, 0},
+        {1, 1, 1}
+    }), TestSuite::Compare::Container);
+    CORRADE_VERIFY(!rotations[0]);
+    CORRADE_VERIFY(rotations[1]);
+    CORRADE_VERIFY(!rotations[2]);
+}
+
+void AtlasTest::arrayEmpty() {
+    CORRADE_COMPARE(atlasArray({16, 16}, nullptr, nullptr), 0);
+}
+
+/* Deterministic sizes for the overlap test and benchmarks */
+Containers::Array<Vector2i> generateSizes(const std::size_t count) {
+    Containers::Array<Vector2i> sizes{Containers::NoInit, count};
+    UnsignedInt state = 1;
+    const auto next = [&state](UnsignedInt max) {
+        state = state*1103515245 + 12345;
+        return Int(1 + (state >> 16)%max);
+    };
+    for(Vector2i& size: sizes) size = {next(48), next(48)};
+    return sizes;
+}
+
+void AtlasTest::arrayNoOverlap() {
+    Containers::Array<Vector2i> sizes = generateSizes(500);
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+    Containers::Array<bool> rotations{Containers::NoInit, sizes.size()};
+    const Vector2i layerSize{256};
+    const Vector2i padding{1, 2};
+    const Int layerCount = atlasArray(layerSize, sizes, offsets, rotations, padding);
+
+    /* The area is enough for all items, so there shouldn't be too many
+       layers */
+    CORRADE_COMPARE_AS(layerCount, 10, TestSuite::Compare::Less);
+
+    Containers::Array<Range2Di> rects{Containers::NoInit, sizes.size()};
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const Vector2i size = rotations[i] ? Vector2i{sizes[i].y(), sizes[i].x()} : sizes[i];
+        rects[i] = Range2Di::fromSize(offsets[i].xy() - padding, size + 2*padding);
+        CORRADE_COMPARE_AS(offsets[i].z(), layerCount, TestSuite::Compare::Less);
+        CORRADE_VERIFY((rects[i].min() >= Vector2i{}).all());
+        CORRADE_VERIFY((rects[i].max() <= layerSize).all());
+    }
+
+    for(std::size_t i = 0; i != sizes.size(); ++i) {
+        for(std::size_t j = i + 1; j != sizes.size(); ++j) {
+            if(offsets[i].z() != offsets[j].z()) continue;
+            CORRADE_ITERATION(i << j);
+            CORRADE_VERIFY(!Math::intersects(rects[i], rects[j]));
+        }
+    }
+}
+
+void AtlasTest::arrayWrongViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector2i sizes[2]{};
+    Vector3i offsets[3];
+    bool rotations[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    atlasArray({16, 16}, sizes, offsets);
+    atlasArray({16, 16}, sizes, Containers::arrayView(offsets).prefix(2), Containers::arrayView(rotations).prefix(1));
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::atlasArray(): expected sizes and offsets views to have the same size, got 2 and 3\n"
+        "TextureTools::atlasArray(): expected sizes, offsets and rotations views to have the same size, got 2, 2 and 1\n");
+}
+
+void AtlasTest::arrayTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Vector2i sizes[]{
+        {6, 8},
+        {14, 4},
+    };
+    const Vector2i sizesNegative[]{
+        {8, 8},
+        {4, -1},
+    };
+    Vector3i offsets[2];
+    bool rotations[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    atlasArray({15, 8}, sizes, offsets, Vector2i{1, 0});
+    /* Rotated it would fit */
+    atlasArray({8, 16}, sizes, offsets, rotations, Vector2i{1, 0});
+    atlasArray({16, 16}, sizesNegative, offsets);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::atlasArray(): expected size 1 to be non-negative and fit into Vector(15, 8) with padding Vector(1, 0) but got Vector(14, 4)\n"
+        "TextureTools::atlasArray(): expected size 1 to be non-negative and fit into Vector(16, 16) with padding Vector(0, 0) but got Vector(4, -1)\n");
+}
+
+void AtlasTest::packer() {
+    AtlasPacker packer{Vector2i{64, 32}};
+    CORRADE_COMPARE(packer.size(), (Vector2i{64, 32}));
+    CORRADE_COMPARE(packer.padding(), Vector2i{});
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+    CORRADE_COMPARE(packer.freeArea(), 2048);
+    CORRADE_COMPARE(packer.filledHeight(), 0);
+
+    Containers::Optional<Vector2i> a = packer.add({20, 10});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, (Vector2i{0, 0}));
+
+    /* Placed next to the first one, as it's lower than on top of it */
+    Containers::Optional<Vector2i> b = packer.add({30, 20});
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(*b, (Vector2i{20, 0}));
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.usedArea(), 800);
+    CORRADE_COMPARE(packer.freeArea(), 1248);
+    CORRADE_COMPARE(packer.filledHeight(), 20);
+
+    /* Doesn't fit, state is unchanged */
+    CORRADE_VERIFY(!packer.add({64, 20}));
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.usedArea(), 800);
+    CORRADE_COMPARE(packer.filledHeight(), 20);
+
+    /* Fits exactly into the remaining space on the right */
+    Containers::Optional<Vector2i> c = packer.add({14, 32});
+    CORRADE_VERIFY(c);
+    CORRADE_COMPARE(*c, (Vector2i{50, 0}));
+    CORRADE_COMPARE(packer.count(), 3);
+    CORRADE_COMPARE(packer.filledHeight(), 32);
+}
+
+void AtlasTest::packerBatch() {
+    AtlasPacker packer{Vector2i{16, 16}, Vector2i{1, 1}};
+    CORRADE_COMPARE(packer.padding(), (Vector2i{1, 1}));
+
+    /* The taller one is placed first */
+    const Vector2i sizes[]{{4, 2}, {6, 6}};
+    Vector2i offsets[2];
+    CORRADE_VERIFY(packer.add(sizes, offsets));
+    CORRADE_COMPARE_AS(Containers::arrayView(offsets), Containers::arrayView<Vector2i>({
+        {9, 1},
+        {1, 1}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.usedArea(), 88);
+    CORRADE_COMPARE(packer.freeArea(), 168);
+
+    /* The second doesn't fit, so neither is added */
+    const Vector2i sizes2[]{{4, 4}, {20, 2}};
+    Vector2i offsets2[2];
+    CORRADE_VERIFY(!packer.add(sizes2, offsets2));
+    CORRADE_COMPARE(packer.count(), 2);
+    CORRADE_COMPARE(packer.usedArea(), 88);
+    CORRADE_COMPARE(packer.filledHeight(), 8);
+
+    /* The first one alone is placed at the same position as it would be
+       without the failed batch */
+    Containers::Optional<Vector2i> a = packer.add({4, 4});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, (Vector2i{9, 5}));
+}
+
+void AtlasTest::packerEmpty() {
+    AtlasPacker packer{Vector2i{16, 16}};
+
+    /* Empty sizes don't occupy any space */
+    Containers::Optional<Vector2i> a = packer.add({0, 5});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Vector2i{});
+    CORRADE_COMPARE(packer.count(), 1);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+    CORRADE_COMPARE(packer.filledHeight(), 0);
+
+    /* Empty batch is a no-op */
+    CORRADE_VERIFY(packer.add(nullptr, nullptr));
+    CORRADE_COMPARE(packer.count(), 1);
+}
+
+void AtlasTest::packerClear() {
+    AtlasPacker packer{Vector2i{16, 16}};
+    CORRADE_VERIFY(packer.add({16, 8}));
+    CORRADE_VERIFY(packer.add({16, 8}));
+    CORRADE_VERIFY(!packer.add({1, 1}));
+    CORRADE_COMPARE(packer.freeArea(), 0);
+
+    packer.clear();
+    CORRADE_COMPARE(packer.count(), 0);
+    CORRADE_COMPARE(packer.usedArea(), 0);
+    CORRADE_COMPARE(packer.filledHeight(), 0);
+
+    Containers::Optional<Vector2i> a = packer.add({16, 16});
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(*a, Vector2i{});
+}
+
+void AtlasTest::packerInvalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AtlasPacker{Vector2i{-1, 16}};
+    AtlasPacker packer{Vector2i{16, 16}};
+    packer.add({3, -2});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::AtlasPacker: expected non-negative size, got Vector(-1, 16)\n"
+        "TextureTools::AtlasPacker::add(): expected non-negative size, got Vector(3, -2)\n");
+}
+
+void AtlasTest::packerWrongViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    AtlasPacker packer{Vector2i{16, 16}};
+    const Vector2i sizes[2]{};
+    Vector2i offsets[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packer.add(sizes, offsets);
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::AtlasPacker::add(): expected sizes and offsets views to have the same size, got 2 and 3\n");
+}
+
+void AtlasTest::benchmark() {
+    Containers::Array<Vector2i> sizes = generateSizes(10000);
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+
+    Int layerCount = 0;
+    CORRADE_BENCHMARK(1)
+        layerCount += atlasArray({1024, 1024}, sizes, offsets);
+
+    CORRADE_VERIFY(layerCount);
+}
+
+void AtlasTest::benchmarkRotations() {
+    Containers::Array<Vector2i> sizes = generateSizes(10000);
+    Containers::Array<Vector3i> offsets{Containers::NoInit, sizes.size()};
+    Containers::Array<bool> rotations{Containers::NoInit, sizes.size()};
+
+    Int layerCount = 0;
+    CORRADE_BENCHMARK(1)
+        layerCount += atlasArray({1024, 1024}, sizes, offsets, rotations);
+
+    CORRADE_VERIFY(layerCount);
 }
 
 }}}}
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/TextureTools/Atlas.h"
+#include "Magnum/TextureTools/EuclideanDistanceField.h"
+#include "Magnum/TextureTools/MultiChannelDistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void atlas();
+    void atlasArray();
+    void atlasPacker();
+    void atlasPackerBatch();
+
+    void euclideanDistanceField();
+    void multiChannelDistanceField();
+};
+
+/* The atlas size is picked to be roughly twice the total texture area, so
+   everything fits with a sufficient margin */
+const struct {
+    const char* name;
+    std::size_t count;
+    Vector2i atlasSize;
+} AtlasData[]{
+    {"1k textures", 1000, {2048, 2048}},
+    {"10k textures", 10000, {8192, 8192}},
+    {"100k textures", 100000, {16384, 16384}}
+};
+
+const struct {
+    const char* name;
+    Vector2i inputSize;
+    UnsignedInt threadCount;
+} DistanceFieldData[]{
+    {"256x256", {256, 256}, 1},
+    {"1024x1024", {1024, 1024}, 1},
+    {"1024x1024, all threads", {1024, 1024}, 0},
+    {"4096x4096", {4096, 4096}, 1},
+    {"4096x4096, all threads", {4096, 4096}, 0}
+};
+
+Benchmark::Benchmark() {
+    addInstancedBenchmarks({&Benchmark::atlas,
+                            &Benchmark::atlasArray,
+                            &Benchmark::atlasPacker,
+                            &Benchmark::atlasPackerBatch}, 5,
+        Containers::arraySize(AtlasData));
+
+    addInstancedBenchmarks({&Benchmark::euclideanDistanceField,
+                            &Benchmark::multiChannelDistanceField}, 5,
+        Containers::arraySize(DistanceFieldData));
+}
+
+/* Pseudo-random sizes between 8 and 63 pixels, deterministic so the runs are
+   comparable */
+Containers::Array<Vector2i> textureSizes(std::size_t count) {
+    Containers::Array<Vector2i> out{Containers::NoInit, count};
+    UnsignedInt seed = 1;
+    for(Vector2i& i: out) {
+        seed = seed*1664525u + 1013904223u;
+        i = {Int(8 + (seed >> 8) % 56), Int(8 + (seed >> 20) % 56)};
+    }
+    return out;
+}
+
+void Benchmark::atlas() {
+    auto&& data = AtlasData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Vector2i> sizesArray = textureSizes(data.count);
+    const std::vector<Vector2i> sizes{sizesArray.begin(), sizesArray.end()};
+
+    std::vector<Range2Di> out;
+    CORRADE_BENCHMARK(1)
+        out = TextureTools::atlas(data.atlasSize, sizes, Vector2i{1});
+
+    CORRADE_COMPARE(out.size(), data.count);
+}
+
+void Benchmark::atlasArray() {
+    auto&& data = AtlasData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Small layers so the textures get spread over many of them */
+    Containers::Array<Vector2i> sizes = textureSizes(data.count);
+    Containers::Array<Vector3i> offsets{Containers::NoInit, data.count};
+
+    Int layerCount{};
+    CORRADE_BENCHMARK(1)
+        layerCount = TextureTools::atlasArray({1024, 1024}, sizes, offsets, Vector2i{1});
+
+    CORRADE_VERIFY(layerCount >= 1);
+}
+
+void Benchmark::atlasPacker() {
+    auto&& data = AtlasData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Vector2i> sizes = textureSizes(data.count);
+    Containers::Array<Vector2i> offsets{Containers::NoInit, data.count};
+
+    /* Textures added one by one in the order they arrive, as when filling a
+       glyph cache on demand */
+    AtlasPacker packer{data.atlasSize, Vector2i{1}};
+    CORRADE_BENCHMARK(1) {
+        for(std::size_t i = 0; i != sizes.size(); ++i)
+            offsets[i] = *packer.add(sizes[i]);
+    }
+
+    CORRADE_COMPARE(packer.count(), data.count);
+}
+
+void Benchmark::atlasPackerBatch() {
+    auto&& data = AtlasData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<Vector2i> sizes = textureSizes(data.count);
+    Containers::Array<Vector2i> offsets{Containers::NoInit, data.count};
+
+    AtlasPacker packer{data.atlasSize, Vector2i{1}};
+    bool fits{};
+    CORRADE_BENCHMARK(1)
+        fits = packer.add(sizes, offsets);
+
+    CORRADE_VERIFY(fits);
+    CORRADE_COMPARE(packer.count(), data.count);
+}
+
+/* A grid of alternating discs and squares, so there's both curved edges and
+   sharp corners */
+Containers::Array<char> distanceFieldInput(const Vector2i& size) {
+    Containers::Array<char> out{Containers::NoInit, std::size_t(size.product())};
+    const Vector2i cellSize = size/8;
+    const Int radius = cellSize.x()*3/8;
+    for(Int y = 0; y != size.y(); ++y) {
+        for(Int x = 0; x != size.x(); ++x) {
+            const Vector2i cell = Vector2i{x, y}/cellSize;
+            const Vector2i d = Vector2i{x, y} - cell*cellSize - cellSize/2;
+            const bool inside = (cell.x() + cell.y()) % 2 ?
+                Math::max(Math::abs(d.x()), Math::abs(d.y())) < radius :
+                d.dot() < radius*radius;
+            out[y*size.x() + x] = inside ? '\xff' : '\x00';
+        }
+    }
+    return out;
+}
+
+void Benchmark::euclideanDistanceField() {
+    auto&& data = DistanceFieldData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> input = distanceFieldInput(data.inputSize);
+    const Vector2i outputSize = data.inputSize/8;
+    Containers::Array<char> output{Containers::ValueInit, std::size_t(outputSize.product())};
+
+    CORRADE_BENCHMARK(1)
+        euclideanDistanceFieldInto(
+            ImageView2D{PixelFormat::R8Unorm, data.inputSize, input},
+            MutableImageView2D{PixelFormat::R8Unorm, outputSize, output},
+            16, data.threadCount);
+
+    /* Center of the first disc is inside */
+    CORRADE_VERIFY(UnsignedByte(output[(outputSize.y()/16)*outputSize.x() + outputSize.x()/16]) > 127);
+}
+
+void Benchmark::multiChannelDistanceField() {
+    auto&& data = DistanceFieldData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> input = distanceFieldInput(data.inputSize);
+    const Vector2i outputSize = data.inputSize/8;
+    Containers::Array<char> output{Containers::ValueInit, std::size_t(outputSize.product()*4)};
+
+    CORRADE_BENCHMARK(1)
+        multiChannelDistanceFieldInto(
+            ImageView2D{PixelFormat::R8Unorm, data.inputSize, input},
+            MutableImageView2D{PixelFormat::RGBA8Unorm, outputSize, output},
+            16, data.threadCount);
+
+    /* Center of the first disc is inside according to the true distance in
+       the alpha channel */
+    CORRADE_VERIFY(UnsignedByte(output[((outputSize.y()/16)*outputSize.x() + outputSize.x()/16)*4 + 3]) > 127);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::Benchmark)
@@ -0,0 +1,485 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Half.h"
+#include "Magnum/TextureTools/ConvertPixelFormat.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct ConvertPixelFormatTest: TestSuite::Tester {
+    explicit ConvertPixelFormatTest();
+
+    void addChannels();
+    void removeChannels();
+    void swapRedBlue();
+    void swapRedBlueNotEnoughChannels();
+
+    void unormToFloat();
+    void floatToUnormClamped();
+    void snorm();
+    void half();
+    void srgbToLinear();
+    void linearToSrgb();
+    void srgbToUnorm();
+
+    void sameFormat();
+    void pixelStorage();
+    void threads();
+    void allocating();
+    void empty();
+
+    void invalidSourceFormat();
+    void invalidDestinationFormat();
+    void invalidSize();
+    void allocatingInvalidFormat();
+
+    void benchmarkRgbToRgba();
+    void benchmarkSrgbToFloat();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    PixelFormat srcFormat, dstFormat;
+    PixelFormatConversionFlags flags;
+} ThreadsData[]{
+    {"copy", PixelFormat::RGBA8Unorm, PixelFormat::RGBA8Unorm, {}},
+    {"channel remap", PixelFormat::RGB8Unorm, PixelFormat::RGBA8Unorm, PixelFormatConversionFlag::SwapRedBlue},
+    {"through floats", PixelFormat::RGBA8Srgb, PixelFormat::RGBA16F, {}}
+};
+
+ConvertPixelFormatTest::ConvertPixelFormatTest() {
+    addTests({&ConvertPixelFormatTest::addChannels,
+              &ConvertPixelFormatTest::removeChannels,
+              &ConvertPixelFormatTest::swapRedBlue,
+              &ConvertPixelFormatTest::swapRedBlueNotEnoughChannels,
+
+              &ConvertPixelFormatTest::unormToFloat,
+              &ConvertPixelFormatTest::floatToUnormClamped,
+              &ConvertPixelFormatTest::snorm,
+              &ConvertPixelFormatTest::half,
+              &ConvertPixelFormatTest::srgbToLinear,
+              &ConvertPixelFormatTest::linearToSrgb,
+              &ConvertPixelFormatTest::srgbToUnorm,
+
+              &ConvertPixelFormatTest::sameFormat,
+              &ConvertPixelFormatTest::pixelStorage});
+
+    addInstancedTests({&ConvertPixelFormatTest::threads},
+        Containers::arraySize(ThreadsData));
+
+    addTests({&ConvertPixelFormatTest::allocating,
+              &ConvertPixelFormatTest::empty,
+
+              &ConvertPixelFormatTest::invalidSourceFormat,
+              &ConvertPixelFormatTest::invalidDestinationFormat,
+              &ConvertPixelFormatTest::invalidSize,
+              &ConvertPixelFormatTest::allocatingInvalidFormat});
+
+    addBenchmarks({&ConvertPixelFormatTest::benchmarkRgbToRgba,
+                   &ConvertPixelFormatTest::benchmarkSrgbToFloat}, 10);
+}
+
+void ConvertPixelFormatTest::addChannels() {
+    const Color3ub src[]{
+        {0x11, 0x22, 0x33}, {0x44, 0x55, 0x66},
+        {0x77, 0x88, 0x99}, {0xaa, 0xbb, 0xcc}
+    };
+    Color4ub dst[4];
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 2}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4ub>({
+        {0x11, 0x22, 0x33, 0xff}, {0x44, 0x55, 0x66, 0xff},
+        {0x77, 0x88, 0x99, 0xff}, {0xaa, 0xbb, 0xcc, 0xff}
+    }), TestSuite::Compare::Container);
+
+    /* Missing green and blue are zero */
+    const UnsignedShort srcR[]{0x1122, 0x3344, 0x5566, 0x7788};
+    Math::Vector4<UnsignedShort> dstRgba[4];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R16Unorm, {2, 2}, srcR},
+        MutableImageView2D{PixelFormat::RGBA16Unorm, {2, 2}, dstRgba});
+    CORRADE_COMPARE_AS(Containers::arrayView(dstRgba), Containers::arrayView<Math::Vector4<UnsignedShort>>({
+        {0x1122, 0, 0, 0xffff}, {0x3344, 0, 0, 0xffff},
+        {0x5566, 0, 0, 0xffff}, {0x7788, 0, 0, 0xffff}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::removeChannels() {
+    const Color4 src[]{
+        {0.1f, 0.2f, 0.3f, 0.4f}, {0.5f, 0.6f, 0.7f, 0.8f}
+    };
+    Vector2 dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RG32F, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Vector2>({
+        {0.1f, 0.2f}, {0.5f, 0.6f}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::swapRedBlue() {
+    const Color4ub src[]{
+        {0x11, 0x22, 0x33, 0x44}, {0x55, 0x66, 0x77, 0x88}
+    };
+    Color4ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, dst},
+        PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4ub>({
+        {0x33, 0x22, 0x11, 0x44}, {0x77, 0x66, 0x55, 0x88}
+    }), TestSuite::Compare::Container);
+
+    /* Combined with a conversion through floats */
+    Color4 dstFloat[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {2, 1}, dstFloat},
+        PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(dstFloat), Containers::arrayView<Color4>({
+        Math::unpack<Color4>(Color4ub{0x33, 0x22, 0x11, 0x44}),
+        Math::unpack<Color4>(Color4ub{0x77, 0x66, 0x55, 0x88})
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::swapRedBlueNotEnoughChannels() {
+    const Vector2ub src[]{{0x11, 0x22}, {0x33, 0x44}};
+    Color4ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, dst},
+        PixelFormatConversionFlag::SwapRedBlue);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4ub>({
+        {0x11, 0x22, 0x00, 0xff}, {0x33, 0x44, 0x00, 0xff}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::unormToFloat() {
+    const Color4ub src[]{
+        {0x00, 0xff, 0x33, 0x66}, {0x99, 0xcc, 0xff, 0x00}
+    };
+    Color4 dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4>({
+        {0.0f, 1.0f, 0.2f, 0.4f}, {0.6f, 0.8f, 1.0f, 0.0f}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::floatToUnormClamped() {
+    const Color4 src[]{
+        {-1.0f, 2.0f, 0.2f, 1.0f}, {0.6f, 0.8f, 1.0f, 0.0f}
+    };
+    Color4ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4ub>({
+        {0x00, 0xff, 0x33, 0xff}, {0x99, 0xcc, 0xff, 0x00}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::snorm() {
+    /* Missing alpha is the maximum positive value */
+    const Byte src[]{-127, 0, 127, 64};
+    Math::Vector4<Byte> dst[4];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R8Snorm, {4, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Snorm, {4, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Math::Vector4<Byte>>({
+        {-127, 0, 0, 127}, {0, 0, 0, 127}, {127, 0, 0, 127}, {64, 0, 0, 127}
+    }), TestSuite::Compare::Container);
+
+    /* Through floats, values outside of the range get clamped */
+    const Float srcFloat[]{-2.0f, -1.0f, 0.0f, 1.0f};
+    Short dstShort[4];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R32F, {4, 1}, srcFloat},
+        MutableImageView2D{PixelFormat::R16Snorm, {4, 1}, dstShort});
+    CORRADE_COMPARE_AS(Containers::arrayView(dstShort), Containers::arrayView<Short>({
+        -32767, -32767, 0, 32767
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::half() {
+    const Vector2 src[]{{1.0f, -0.5f}, {0.25f, 3.0f}};
+    Vector2h dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG32F, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RG16F, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Vector2h>({
+        {1.0_h, -0.5_h}, {0.25_h, 3.0_h}
+    }), TestSuite::Compare::Container);
+
+    /* Missing alpha is 1.0 as a half-float, no clamping is done */
+    Color4h dstRgba[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RG16F, {2, 1}, dst},
+        MutableImageView2D{PixelFormat::RGBA16F, {2, 1}, dstRgba});
+    CORRADE_COMPARE_AS(Containers::arrayView(dstRgba), Containers::arrayView<Color4h>({
+        {1.0_h, -0.5_h, 0.0_h, 1.0_h}, {0.25_h, 3.0_h, 0.0_h, 1.0_h}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::srgbToLinear() {
+    Color4ub src[64];
+    for(std::size_t i = 0; i != 64; ++i)
+        src[i] = {UnsignedByte(i*4), UnsignedByte(255 - i*4), UnsignedByte(i), UnsignedByte(i*2)};
+    Color4 dst[64];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {8, 8}, src},
+        MutableImageView2D{PixelFormat::RGBA32F, {8, 8}, dst});
+
+    /* Alpha is linear */
+    Color4 expected[64];
+    for(std::size_t i = 0; i != 64; ++i)
+        expected[i] = Color4::fromSrgbAlpha(src[i]);
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::linearToSrgb() {
+    /* Round trip of all values is lossless */
+    UnsignedByte src[256];
+    for(std::size_t i = 0; i != 256; ++i) src[i] = UnsignedByte(i);
+    Float linear[256];
+    UnsignedByte dst[256];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R8Srgb, {16, 16}, src},
+        MutableImageView2D{PixelFormat::R32F, {16, 16}, linear});
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::R32F, {16, 16}, linear},
+        MutableImageView2D{PixelFormat::R8Srgb, {16, 16}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(src),
+        TestSuite::Compare::Container);
+
+    /* Arbitrary values differ from the exact calculation by at most one,
+       alpha is linear and out-of-range values are clamped */
+    Color4 srcRgba[64];
+    for(std::size_t i = 0; i != 64; ++i)
+        srcRgba[i] = {Float(i)/63.0f, Float(i)/630.0f, Float(i)/31.5f - 0.5f, Float(i)/63.0f};
+    Color4ub dstRgba[64];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA32F, {8, 8}, srcRgba},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {8, 8}, dstRgba});
+    for(std::size_t i = 0; i != 64; ++i) {
+        CORRADE_ITERATION(i);
+        const Color4ub expected = Color4{Math::clamp(Vector4{srcRgba[i]}, 0.0f, 1.0f)}.toSrgbAlpha<UnsignedByte>();
+        for(std::size_t c = 0; c != 3; ++c) {
+            CORRADE_ITERATION(c);
+            CORRADE_COMPARE_AS(Math::abs(Int(dstRgba[i][c]) - Int(expected[c])), 1,
+                TestSuite::Compare::LessOrEqual);
+        }
+        CORRADE_COMPARE(dstRgba[i].a(), expected.a());
+    }
+}
+
+void ConvertPixelFormatTest::srgbToUnorm() {
+    const Color3ub src[]{{0, 128, 255}, {188, 100, 50}};
+    Color3ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 1}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color3ub>({
+        Math::pack<Color3ub>(Color3::fromSrgb(src[0])),
+        Math::pack<Color3ub>(Color3::fromSrgb(src[1]))
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::sameFormat() {
+    /* sRGB formats are copied as-is, not decoded and encoded again */
+    const Color4ub src[]{
+        {0x11, 0x22, 0x33, 0x44}, {0x55, 0x66, 0x77, 0x88}
+    };
+    Color4ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, src},
+        MutableImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView(src),
+        TestSuite::Compare::Container);
+
+    /* And the same if just the channel count differs */
+    Color3ub dstRgb[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, src},
+        MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Srgb, {2, 1}, dstRgb});
+    CORRADE_COMPARE_AS(Containers::arrayView(dstRgb), Containers::arrayView<Color3ub>({
+        {0x11, 0x22, 0x33}, {0x55, 0x66, 0x77}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::pixelStorage() {
+    /* Two-pixel rows padded to eight bytes, skipping the first row and the
+       first pixel */
+    const char src[]{
+        'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x',
+        'x', 'x', 'x', '\x11', '\x22', '\x33', 'x', 'x',
+        'x', 'x', 'x', '\x66', '\x77', '\x88', 'x', 'x'
+    };
+    Color4ub dst[2];
+    convertPixelFormatInto(
+        ImageView2D{PixelStorage{}.setRowLength(2).setSkip({1, 1, 0}), PixelFormat::RGB8Unorm, {1, 2}, src},
+        MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 2}, dst});
+    CORRADE_COMPARE_AS(Containers::arrayView(dst), Containers::arrayView<Color4ub>({
+        {0x11, 0x22, 0x33, 0xff}, {0x66, 0x77, 0x88, 0xff}
+    }), TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::threads() {
+    auto&& data = ThreadsData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough for the work to be split across three threads */
+    const Vector2i size{97, 128};
+    Containers::Array<char> src{Containers::NoInit, std::size_t(size.product()*pixelSize(data.srcFormat))};
+    for(std::size_t i = 0; i != src.size(); ++i)
+        src[i] = char(i*37 + i/7);
+    const ImageView2D srcImage{PixelStorage{}.setAlignment(1), data.srcFormat, size, src};
+
+    Image2D expected = convertPixelFormat(srcImage, data.dstFormat, data.flags, 1);
+    Image2D actual = convertPixelFormat(srcImage, data.dstFormat, data.flags, 3);
+    CORRADE_COMPARE_AS(actual.data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void ConvertPixelFormatTest::allocating() {
+    const Color3ub src[]{
+        {0x11, 0x22, 0x33}, {0x44, 0x55, 0x66}, {0x77, 0x88, 0x99},
+        {0xaa, 0xbb, 0xcc}, {0xdd, 0xee, 0xff}, {0x00, 0x11, 0x22}
+    };
+    Image2D dst = convertPixelFormat(ImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, {3, 2}, src}, PixelFormat::R8Unorm);
+    CORRADE_COMPARE(dst.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(dst.size(), (Vector2i{3, 2}));
+
+    /* Rows are padded to four bytes */
+    CORRADE_COMPARE(dst.data().size(), 8);
+    CORRADE_COMPARE(dst.pixels<UnsignedByte>()[0][2], 0x77);
+    CORRADE_COMPARE(dst.pixels<UnsignedByte>()[1][0], 0xaa);
+}
+
+void ConvertPixelFormatTest::empty() {
+    MutableImageView2D dst{PixelFormat::RGBA8Unorm, {0, 3}, nullptr};
+    convertPixelFormatInto(ImageView2D{PixelFormat::R8Unorm, {0, 3}}, dst);
+
+    Image2D allocated = convertPixelFormat(ImageView2D{PixelFormat::R8Unorm, {4, 0}}, PixelFormat::RGBA32F);
+    CORRADE_COMPARE(allocated.size(), (Vector2i{4, 0}));
+    CORRADE_COMPARE(allocated.data().size(), 0);
+}
+
+void ConvertPixelFormatTest::invalidSourceFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char src[4]{};
+    char dst[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(ImageView2D{PixelFormat::R8UI, {4, 1}, src}, MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, dst});
+    CORRADE_COMPARE(out.str(), "TextureTools::convertPixelFormatInto(): unsupported source format PixelFormat::R8UI\n");
+}
+
+void ConvertPixelFormatTest::invalidDestinationFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char src[4]{};
+    char dst[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(ImageView2D{PixelFormat::R8Unorm, {4, 1}, src}, MutableImageView2D{pixelFormatWrap(0xdead), {4, 1}, dst});
+    CORRADE_COMPARE(out.str(), "TextureTools::convertPixelFormatInto(): unsupported destination format PixelFormat::ImplementationSpecific(0xdead)\n");
+}
+
+void ConvertPixelFormatTest::invalidSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char src[4]{};
+    char dst[8];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormatInto(ImageView2D{PixelFormat::R8Unorm, {4, 1}, src}, MutableImageView2D{PixelFormat::R8Unorm, {4, 2}, dst});
+    CORRADE_COMPARE(out.str(), "TextureTools::convertPixelFormatInto(): expected destination size Vector(4, 1) but got Vector(4, 2)\n");
+}
+
+void ConvertPixelFormatTest::allocatingInvalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char src[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    convertPixelFormat(ImageView2D{PixelFormat::R8Unorm, {4, 1}, src}, PixelFormat::RGBA32UI);
+    CORRADE_COMPARE(out.str(), "TextureTools::convertPixelFormat(): unsupported format PixelFormat::RGBA32UI\n");
+}
+
+void ConvertPixelFormatTest::benchmarkRgbToRgba() {
+    const Vector2i size{1024, 1024};
+    Containers::Array<char> src{Containers::ValueInit, std::size_t(size.product()*3)};
+    Containers::Array<char> dst{Containers::NoInit, std::size_t(size.product()*4)};
+
+    CORRADE_BENCHMARK(1)
+        convertPixelFormatInto(ImageView2D{PixelFormat::RGB8Unorm, size, src}, MutableImageView2D{PixelFormat::RGBA8Unorm, size, dst});
+
+    CORRADE_COMPARE(dst[3], '\xff');
+}
+
+void ConvertPixelFormatTest::benchmarkSrgbToFloat() {
+    const Vector2i size{1024, 1024};
+    Containers::Array<char> src{Containers::ValueInit, std::size_t(size.product()*4)};
+    Containers::Array<char> dst{Containers::NoInit, std::size_t(size.product()*16)};
+
+    CORRADE_BENCHMARK(1)
+        convertPixelFormatInto(ImageView2D{PixelFormat::RGBA8Srgb, size, src}, MutableImageView2D{PixelFormat::RGBA32F, size, dst});
+
+    CORRADE_COMPARE(Containers::arrayCast<Color4>(dst)[0], (Color4{0.0f, 0.0f, 0.0f, 0.0f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::ConvertPixelFormatTest)
@@ -0,0 +1,122 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/Context.h"
+#include "Magnum/GL/Extensions.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/TextureTools/DepthPyramid.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct DepthPyramidGLTest: GL::OpenGLTester {
+    explicit DepthPyramidGLTest();
+
+    void construct();
+    void build();
+};
+
+DepthPyramidGLTest::DepthPyramidGLTest() {
+    addTests({&DepthPyramidGLTest::construct,
+              &DepthPyramidGLTest::build});
+}
+
+#ifndef MAGNUM_TARGET_GLES
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL300))      \
+        CORRADE_SKIP("OpenGL 3.0 is not supported.")
+#else
+#define SKIP_IF_NOT_SUPPORTED()                                             \
+    if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::color_buffer_float>()) \
+        CORRADE_SKIP(GL::Extensions::EXT::color_buffer_float::string() + std::string(" is not supported."))
+#endif
+
+void DepthPyramidGLTest::construct() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    DepthPyramid pyramid{{5, 3}};
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    CORRADE_COMPARE(pyramid.size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(pyramid.levelCount(), 3);
+    CORRADE_COMPARE(pyramid.levelSize(0), (Vector2i{5, 3}));
+    CORRADE_COMPARE(pyramid.levelSize(1), (Vector2i{2, 1}));
+    CORRADE_COMPARE(pyramid.levelSize(2), (Vector2i{1, 1}));
+    CORRADE_VERIFY(pyramid.texture().id());
+}
+
+void DepthPyramidGLTest::build() {
+    SKIP_IF_NOT_SUPPORTED();
+
+    const Float depth[]{
+        0.10f, 0.20f, 0.30f, 0.40f, 0.50f,
+        0.60f, 0.70f, 0.80f, 0.90f, 0.15f,
+        0.25f, 0.35f, 0.45f, 0.55f, 0.65f
+    };
+    GL::Texture2D input;
+    input.setMinificationFilter(GL::SamplerFilter::Nearest)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::R32F, {5, 3})
+        .setSubImage(0, {}, ImageView2D{PixelFormat::R32F, {5, 3}, depth});
+
+    DepthPyramid pyramid{{5, 3}};
+    pyramid(input);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    /* The base level is a copy */
+    Image2D level0 = pyramid.image(0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(level0.size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(level0.data()),
+        Containers::arrayView(depth),
+        TestSuite::Compare::Container);
+
+    /* Odd sizes fold the last column and row into the last texel, so the
+       first texel covers 2x3 and the second 3x3 pixels */
+    Image2D level1 = pyramid.image(1);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(level1.size(), (Vector2i{2, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(level1.data()),
+        Containers::arrayView({0.70f, 0.90f}),
+        TestSuite::Compare::Container);
+
+    Image2D level2 = pyramid.image(2);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(level2.size(), (Vector2i{1, 1}));
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(level2.data()),
+        Containers::arrayView({0.90f}),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DepthPyramidGLTest)
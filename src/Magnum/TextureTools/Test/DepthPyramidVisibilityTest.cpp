@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/TextureTools/DepthPyramid.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+using namespace Math::Literals;
+
+struct DepthPyramidVisibilityTest: TestSuite::Tester {
+    explicit DepthPyramidVisibilityTest();
+
+    void visibility();
+    void visibilityCoarseLevels();
+    void visibilityBehindCamera();
+
+    void noLevels();
+    void wrongViewSize();
+    void invalidFormat();
+    void invalidLevelSize();
+};
+
+DepthPyramidVisibilityTest::DepthPyramidVisibilityTest() {
+    addTests({&DepthPyramidVisibilityTest::visibility,
+              &DepthPyramidVisibilityTest::visibilityCoarseLevels,
+              &DepthPyramidVisibilityTest::visibilityBehindCamera,
+
+              &DepthPyramidVisibilityTest::noLevels,
+              &DepthPyramidVisibilityTest::wrongViewSize,
+              &DepthPyramidVisibilityTest::invalidFormat,
+              &DepthPyramidVisibilityTest::invalidLevelSize});
+}
+
+/* A 4x4 depth buffer with the left half empty and the right half covered by
+   an occluder at depth 0.5, and the pyramid built from it */
+constexpr Float Level0[]{
+    1.0f, 1.0f, 0.5f, 0.5f,
+    1.0f, 1.0f, 0.5f, 0.5f,
+    1.0f, 1.0f, 0.5f, 0.5f,
+    1.0f, 1.0f, 0.5f, 0.5f
+};
+constexpr Float Level1[]{
+    1.0f, 0.5f,
+    1.0f, 0.5f
+};
+constexpr Float Level2[]{
+    1.0f
+};
+
+/* With an identity matrix, the boxes are directly in NDC. Depth of NDC Z of
+   0.8 is 0.9, of -0.5 is 0.25. */
+const Range3D Boxes[]{
+    /* Behind the occluder */
+    {{0.2f, -0.5f, 0.8f}, {0.8f, 0.5f, 0.9f}},
+    /* Same depth, but in the empty half */
+    {{-0.8f, -0.5f, 0.8f}, {-0.2f, 0.5f, 0.9f}},
+    /* In front of the occluder */
+    {{0.2f, -0.5f, -0.5f}, {0.8f, 0.5f, -0.2f}},
+    /* Partially behind the occluder and partially in the empty half */
+    {{-0.5f, -0.5f, 0.8f}, {0.5f, 0.5f, 0.9f}},
+    /* Covering the whole view behind the occluder */
+    {{-2.0f, -2.0f, 0.8f}, {2.0f, 2.0f, 0.9f}},
+    /* Outside of the view */
+    {{1.5f, -0.5f, -0.5f}, {2.0f, 0.5f, 0.5f}},
+    /* Beyond the far plane */
+    {{0.2f, -0.5f, 1.5f}, {0.8f, 0.5f, 2.0f}}
+};
+
+void DepthPyramidVisibilityTest::visibility() {
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {4, 4}, Level0},
+        ImageView2D{PixelFormat::R32F, {2, 2}, Level1},
+        ImageView2D{PixelFormat::R32F, {1, 1}, Level2}
+    };
+
+    bool visibility[Containers::arraySize(Boxes)];
+    depthPyramidVisibilityInto(levels, Matrix4{}, Boxes, visibility);
+    CORRADE_COMPARE_AS(Containers::arrayView(visibility), Containers::arrayView({
+        false, true, true, true, true, false, false
+    }), TestSuite::Compare::Container);
+}
+
+void DepthPyramidVisibilityTest::visibilityCoarseLevels() {
+    /* Only the coarser levels downloaded, the first box still fits into
+       them */
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {2, 2}, Level1},
+        ImageView2D{PixelFormat::R32F, {1, 1}, Level2}
+    };
+
+    bool visibility[Containers::arraySize(Boxes)];
+    depthPyramidVisibilityInto(levels, Matrix4{}, Boxes, visibility);
+    CORRADE_COMPARE_AS(Containers::arrayView(visibility), Containers::arrayView({
+        false, true, true, true, true, false, false
+    }), TestSuite::Compare::Container);
+}
+
+void DepthPyramidVisibilityTest::visibilityBehindCamera() {
+    /* Everything is occluded by something right at the near plane */
+    const Float level0[4]{};
+    const Float level1[1]{};
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {2, 2}, level0},
+        ImageView2D{PixelFormat::R32F, {1, 1}, level1}
+    };
+
+    const Range3D boxes[]{
+        /* In front of the camera, occluded */
+        {{-1.0f, -1.0f, -5.0f}, {1.0f, 1.0f, -4.0f}},
+        /* Around the camera, can't be tested */
+        {{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}}
+    };
+
+    bool visibility[2];
+    depthPyramidVisibilityInto(levels, Matrix4::perspectiveProjection(90.0_degf, 1.0f, 0.1f, 10.0f), boxes, visibility);
+    CORRADE_COMPARE_AS(Containers::arrayView(visibility), Containers::arrayView({
+        false, true
+    }), TestSuite::Compare::Container);
+}
+
+void DepthPyramidVisibilityTest::noLevels() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    bool visibility[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    depthPyramidVisibilityInto(nullptr, Matrix4{}, Containers::arrayView(Boxes).prefix(1), visibility);
+    CORRADE_COMPARE(out.str(), "TextureTools::depthPyramidVisibilityInto(): expected at least one level\n");
+}
+
+void DepthPyramidVisibilityTest::wrongViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {1, 1}, Level2}
+    };
+    bool visibility[2];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    depthPyramidVisibilityInto(levels, Matrix4{}, Containers::arrayView(Boxes).prefix(3), visibility);
+    CORRADE_COMPARE(out.str(), "TextureTools::depthPyramidVisibilityInto(): expected boxes and visibility views to have the same size, got 3 and 2\n");
+}
+
+void DepthPyramidVisibilityTest::invalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {2, 2}, Level1},
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, Level2}
+    };
+    bool visibility[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    depthPyramidVisibilityInto(levels, Matrix4{}, Containers::arrayView(Boxes).prefix(1), visibility);
+    CORRADE_COMPARE(out.str(), "TextureTools::depthPyramidVisibilityInto(): expected level 1 to be PixelFormat::R32F but got PixelFormat::RGBA8Unorm\n");
+}
+
+void DepthPyramidVisibilityTest::invalidLevelSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const ImageView2D levels[]{
+        ImageView2D{PixelFormat::R32F, {4, 4}, Level0},
+        ImageView2D{PixelFormat::R32F, {1, 1}, Level2}
+    };
+    bool visibility[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    depthPyramidVisibilityInto(levels, Matrix4{}, Containers::arrayView(Boxes).prefix(1), visibility);
+    CORRADE_COMPARE(out.str(), "TextureTools::depthPyramidVisibilityInto(): expected level 1 to have a size of Vector(2, 2) but got Vector(1, 1)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::DepthPyramidVisibilityTest)
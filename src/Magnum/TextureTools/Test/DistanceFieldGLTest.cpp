@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/PluginManager/AbstractManager.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -39,6 +40,9 @@
 #include "Magnum/GL/PixelFormat.h"
 #include "Magnum/GL/Texture.h"
 #include "Magnum/GL/TextureFormat.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/TextureArray.h"
+#endif
 #include "Magnum/TextureTools/DistanceField.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -55,6 +59,9 @@ struct DistanceFieldGLTest: GL::OpenGLTester {
     explicit DistanceFieldGLTest();
 
     void test();
+    #ifndef MAGNUM_TARGET_GLES2
+    void textureArray();
+    #endif
     #ifndef MAGNUM_TARGET_WEBGL
     void benchmark();
     #endif
@@ -64,11 +71,44 @@ struct DistanceFieldGLTest: GL::OpenGLTester {
         std::string _testDir;
 };
 
+const struct {
+    const char* name;
+    DistanceFieldAlgorithm algorithm;
+    Float maxThreshold, meanThreshold;
+} TestData[]{
+    /* Some mobile GPUs have slight (off-by-one) rounding errors compared to
+       the ground truth, but it's just a very small amount of pixels (20-50 out
+       of the total 4k pixels, iOS/WebGL has slightly more). That's okay. It's
+       also possible that the ground truth itself has rounding errors ;) */
+    {"brute force", DistanceFieldAlgorithm::BruteForce, 1.0f, 0.178f},
+    #ifndef MAGNUM_TARGET_GLES2
+    /* Jump flooding may not find the nearest pixel in a few cases, resulting
+       in a slightly larger distance */
+    {"jump flood", DistanceFieldAlgorithm::JumpFlood, 8.0f, 0.25f},
+    #endif
+};
+
+const struct {
+    const char* name;
+    DistanceFieldAlgorithm algorithm;
+} BenchmarkData[]{
+    {"brute force", DistanceFieldAlgorithm::BruteForce},
+    #ifndef MAGNUM_TARGET_GLES2
+    {"jump flood", DistanceFieldAlgorithm::JumpFlood},
+    #endif
+};
+
 DistanceFieldGLTest::DistanceFieldGLTest() {
-    addTests({&DistanceFieldGLTest::test});
+    addInstancedTests({&DistanceFieldGLTest::test},
+        Containers::arraySize(TestData));
+
+    #ifndef MAGNUM_TARGET_GLES2
+    addTests({&DistanceFieldGLTest::textureArray});
+    #endif
 
     #ifndef MAGNUM_TARGET_WEBGL
-    addBenchmarks({&DistanceFieldGLTest::benchmark}, 5, BenchmarkType::GpuTime);
+    addInstancedBenchmarks({&DistanceFieldGLTest::benchmark}, 5,
+        Containers::arraySize(BenchmarkData), BenchmarkType::GpuTime);
     #endif
 
     /* Load the plugin directly from the build tree. Otherwise it's either
@@ -96,6 +136,14 @@ DistanceFieldGLTest::DistanceFieldGLTest() {
 }
 
 void DistanceFieldGLTest::test() {
+    auto&& data = TestData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    #ifndef MAGNUM_TARGET_GLES
+    if(data.algorithm == DistanceFieldAlgorithm::JumpFlood && !GL::Context::current().isVersionSupported(GL::Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
     Containers::Pointer<Trade::AbstractImporter> importer;
     if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
         CORRADE_SKIP("TgaImporter plugin not found.");
@@ -149,8 +197,9 @@ void DistanceFieldGLTest::test() {
         .setMagnificationFilter(GL::SamplerFilter::Nearest)
         .setStorage(1, outputFormat, Vector2i{64});
 
-    TextureTools::DistanceField distanceField{32};
+    TextureTools::DistanceField distanceField{32, data.algorithm};
     CORRADE_COMPARE(distanceField.radius(), 32);
+    CORRADE_COMPARE(distanceField.algorithm(), data.algorithm);
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
@@ -204,19 +253,82 @@ void DistanceFieldGLTest::test() {
 
     CORRADE_COMPARE_WITH(*actualOutputImage,
         Utility::Directory::join(_testDir, "output.tga"),
-        /* Some mobile GPUs have slight (off-by-one) rounding errors compared
-           to the ground truth, but it's just a very small amount of pixels
-           (20-50 out of the total 4k pixels, iOS/WebGL has slightly more).
-           That's okay. It's also possible that the ground truth itself has
-           rounding errors ;) */
-        (DebugTools::CompareImageToFile{_manager, 1.0f, 0.178f}));
+        (DebugTools::CompareImageToFile{_manager, data.maxThreshold, data.meanThreshold}));
 }
 
+#ifndef MAGNUM_TARGET_GLES2
+void DistanceFieldGLTest::textureArray() {
+    #ifndef MAGNUM_TARGET_GLES
+    if(!GL::Context::current().isVersionSupported(GL::Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
+    #endif
+
+    Containers::Pointer<Trade::AbstractImporter> importer;
+    if(!(importer = _manager.loadAndInstantiate("TgaImporter")))
+        CORRADE_SKIP("TgaImporter plugin not found.");
+
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(_testDir, "input.tga")));
+    Containers::Optional<Trade::ImageData2D> inputImage = importer->image2D(0);
+    CORRADE_VERIFY(inputImage);
+    CORRADE_COMPARE(inputImage->format(), PixelFormat::R8Unorm);
+
+    /* The same image in all three layers */
+    GL::Texture2DArray input;
+    input.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::R8, {inputImage->size(), 3});
+    for(Int i = 0; i != 3; ++i)
+        input.setSubImage(0, {0, 0, i}, ImageView3D{inputImage->storage(), inputImage->format(), {inputImage->size(), 1}, inputImage->data()});
+
+    GL::Texture2DArray output;
+    output.setMinificationFilter(GL::SamplerFilter::Nearest, GL::SamplerMipmap::Base)
+        .setMagnificationFilter(GL::SamplerFilter::Nearest)
+        .setStorage(1, GL::TextureFormat::R8, {64, 64, 3});
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    TextureTools::DistanceField distanceField{32};
+    distanceField(input, output, {{}, Vector2i{64}}
+        #ifdef MAGNUM_TARGET_GLES
+        , {inputImage->size(), 3}
+        #endif
+        );
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image3D actual = output.image(0, {PixelFormat::R8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(actual.size(), (Vector3i{64, 64, 3}));
+
+    if(_manager.loadState("AnyImageImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("AnyImageImporter plugin not found.");
+
+    /* Each layer should match the single-texture output */
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(
+            (ImageView2D{PixelFormat::R8Unorm, Vector2i{64}, actual.data().slice(i*64*64, (i + 1)*64*64)}),
+            Utility::Directory::join(_testDir, "output.tga"),
+            (DebugTools::CompareImageToFile{_manager, 1.0f, 0.178f}));
+    }
+    #else
+    CORRADE_SKIP("Texture array image download not available on OpenGL ES, can't verify the output.");
+    #endif
+}
+#endif
+
 #ifndef MAGNUM_TARGET_WEBGL
 void DistanceFieldGLTest::benchmark() {
+    auto&& data = BenchmarkData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
     #ifdef MAGNUM_TARGET_GLES
     if(!GL::Context::current().isExtensionSupported<GL::Extensions::EXT::disjoint_timer_query>())
         CORRADE_SKIP(GL::Extensions::EXT::disjoint_timer_query::string() + std::string{" is not supported, can't benchmark"});
+    #else
+    if(data.algorithm == DistanceFieldAlgorithm::JumpFlood && !GL::Context::current().isVersionSupported(GL::Version::GL300))
+        CORRADE_SKIP("OpenGL 3.0 is not supported.");
     #endif
 
     Containers::Pointer<Trade::AbstractImporter> importer;
@@ -270,14 +382,12 @@ void DistanceFieldGLTest::benchmark() {
 
     MAGNUM_VERIFY_NO_GL_ERROR();
 
-    TextureTools::DistanceField distanceField{32};
+    TextureTools::DistanceField distanceField{32, data.algorithm};
 
     /* So it doesn't spam too much */
     GL::DebugOutput::setCallback(nullptr);
 
     CORRADE_BENCHMARK(5) {
-        /* This is creating the shader from scratch every time, so no wonder
-           it's so freaking slow */
         distanceField(input, output, {{}, Vector2i{64}}
             #ifdef MAGNUM_TARGET_GLES
             , inputImage->size()
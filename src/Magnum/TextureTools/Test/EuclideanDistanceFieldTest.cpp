@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/TextureTools/EuclideanDistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct EuclideanDistanceFieldTest: TestSuite::Tester {
+    explicit EuclideanDistanceFieldTest();
+
+    void test();
+    void inputChannels();
+    void emptyOutput();
+
+    void invalidInputFormat();
+    void invalidOutputFormat();
+    void radiusTooLarge();
+    void emptyInput();
+
+    void benchmark();
+};
+
+const struct {
+    const char* name;
+    Vector2i size;
+    UnsignedInt radius;
+    UnsignedInt threadCount;
+} TestData[]{
+    {"same size", {64, 48}, 4, 1},
+    {"same size, large radius", {64, 48}, 40, 1},
+    {"downscaled", {16, 12}, 8, 1},
+    {"downscaled, non-aligned size", {13, 7}, 6, 1},
+    {"upscaled", {128, 96}, 3, 1},
+    {"same size, 3 threads", {64, 48}, 4, 3},
+    {"downscaled, all threads", {16, 12}, 8, 0}
+};
+
+EuclideanDistanceFieldTest::EuclideanDistanceFieldTest() {
+    addInstancedTests({&EuclideanDistanceFieldTest::test},
+        Containers::arraySize(TestData));
+
+    addTests({&EuclideanDistanceFieldTest::inputChannels,
+              &EuclideanDistanceFieldTest::emptyOutput,
+
+              &EuclideanDistanceFieldTest::invalidInputFormat,
+              &EuclideanDistanceFieldTest::invalidOutputFormat,
+              &EuclideanDistanceFieldTest::radiusTooLarge,
+              &EuclideanDistanceFieldTest::emptyInput});
+
+    addBenchmarks({&EuclideanDistanceFieldTest::benchmark}, 10);
+}
+
+/* A few discs and rectangles, partially touching the edges */
+Containers::Array<char> inputData(const Vector2i& size) {
+    Containers::Array<char> data{Containers::ValueInit, std::size_t(size.product())};
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const Vector2i p{x, y};
+        const bool inside =
+            (p - Vector2i{16, 20}).dot() < 12*12 ||
+            (p - Vector2i{50, 8}).dot() < 7*7 ||
+            (x >= 36 && x < 60 && y >= 26 && y < 34) ||
+            (x >= 40 && x < 44 && y >= 30 && y < size.y()) ||
+            (x == 5 && y == 44);
+        data[y*size.x() + x] = inside ? '\xff' : '\x00';
+    }
+    return data;
+}
+
+/* Direct translation of the brute-force DistanceField shader */
+Containers::Array<UnsignedByte> bruteForce(const Containers::StridedArrayView2D<const UnsignedByte>& input, const Vector2i& size, const Int radius) {
+    const Vector2i inputSize{Int(input.size()[1]), Int(input.size()[0])};
+    const Vector2 scaling = Vector2{inputSize}/Vector2{size};
+    Containers::Array<UnsignedByte> out{Containers::NoInit, std::size_t(size.product())};
+    for(Int y = 0; y != size.y(); ++y) for(Int x = 0; x != size.x(); ++x) {
+        const Vector2i position{Int(x*scaling.x()), Int(y*scaling.y())};
+        const bool isInside = input[position.y()][position.x()] > 127;
+        Int minDistanceSquared = (radius + 1)*(radius + 1);
+        for(Int j = -radius; j <= radius; ++j) for(Int i = -radius; i <= radius; ++i) {
+            const Vector2i p = position + Vector2i{i, j};
+            if(p.x() < 0 || p.y() < 0 || p.x() >= inputSize.x() || p.y() >= inputSize.y())
+                continue;
+            if((input[p.y()][p.x()] > 127) != isInside)
+                minDistanceSquared = Math::min(minDistanceSquared, i*i + j*j);
+        }
+
+        const Float value = (isInside ? 0.5f : -0.5f)*Math::sqrt(Float(minDistanceSquared))/Float(radius + 1) + 0.5f;
+        out[y*size.x() + x] = UnsignedByte(value*255.0f + 0.5f);
+    }
+    return out;
+}
+
+void EuclideanDistanceFieldTest::test() {
+    auto&& data = TestData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Vector2i inputSize{64, 48};
+    Containers::Array<char> input = inputData(inputSize);
+    const ImageView2D inputImage{PixelFormat::R8Unorm, inputSize, input};
+
+    Image2D output = euclideanDistanceField(inputImage, data.size, data.radius, data.threadCount);
+    CORRADE_COMPARE(output.format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(output.size(), data.size);
+
+    /* Copy to a tightly packed array for comparison */
+    const Containers::StridedArrayView2D<const UnsignedByte> pixels = output.pixels<UnsignedByte>();
+    Containers::Array<UnsignedByte> actual{Containers::NoInit, std::size_t(data.size.product())};
+    for(Int y = 0; y != data.size.y(); ++y) for(Int x = 0; x != data.size.x(); ++x)
+        actual[y*data.size.x() + x] = pixels[y][x];
+
+    CORRADE_COMPARE_AS(actual,
+        bruteForce(inputImage.pixels<UnsignedByte>(), data.size, data.radius),
+        TestSuite::Compare::Container);
+}
+
+void EuclideanDistanceFieldTest::inputChannels() {
+    /* Only the first channel is taken into account */
+    const Vector2i inputSize{64, 48};
+    Containers::Array<char> input = inputData(inputSize);
+    Containers::Array<char> inputRgba{Containers::ValueInit, input.size()*4};
+    for(std::size_t i = 0; i != input.size(); ++i) {
+        inputRgba[i*4 + 0] = input[i];
+        inputRgba[i*4 + 1] = char(~input[i]);
+        inputRgba[i*4 + 3] = '\xff';
+    }
+
+    Image2D expected = euclideanDistanceField(ImageView2D{PixelFormat::R8Unorm, inputSize, input}, {32, 24}, 5);
+    Image2D actual = euclideanDistanceField(ImageView2D{PixelFormat::RGBA8Unorm, inputSize, inputRgba}, {32, 24}, 5);
+    CORRADE_COMPARE_AS(actual.data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void EuclideanDistanceFieldTest::emptyOutput() {
+    const char input[4]{};
+    Image2D output = euclideanDistanceField(ImageView2D{PixelFormat::R8Unorm, {4, 1}, input}, {0, 5}, 3);
+    CORRADE_COMPARE(output.size(), (Vector2i{0, 5}));
+}
+
+void EuclideanDistanceFieldTest::invalidInputFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char input[8]{};
+    char output[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    euclideanDistanceFieldInto(ImageView2D{PixelFormat::R16Unorm, {4, 1}, input}, MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::euclideanDistanceFieldInto(): unsupported input format PixelFormat::R16Unorm\n");
+}
+
+void EuclideanDistanceFieldTest::invalidOutputFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char input[4]{};
+    char output[8];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    euclideanDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {4, 1}, input}, MutableImageView2D{PixelFormat::RG8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::euclideanDistanceFieldInto(): expected output format PixelFormat::R8Unorm but got PixelFormat::RG8Unorm\n");
+}
+
+void EuclideanDistanceFieldTest::radiusTooLarge() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char input[4]{};
+    char output[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    euclideanDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {4, 1}, input}, MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, output}, 65535);
+    CORRADE_COMPARE(out.str(), "TextureTools::euclideanDistanceFieldInto(): expected radius to be less than 65535, got 65535\n");
+}
+
+void EuclideanDistanceFieldTest::emptyInput() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char output[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    euclideanDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {0, 1}}, MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::euclideanDistanceFieldInto(): expected a non-empty input image\n");
+}
+
+void EuclideanDistanceFieldTest::benchmark() {
+    /* Scale the test pattern up 16 times to get a reasonably sized input */
+    const Vector2i inputSize{1024, 768};
+    Containers::Array<char> pattern = inputData({64, 48});
+    Containers::Array<char> input{Containers::NoInit, std::size_t(inputSize.product())};
+    for(Int y = 0; y != inputSize.y(); ++y) for(Int x = 0; x != inputSize.x(); ++x)
+        input[y*inputSize.x() + x] = pattern[(y/16)*64 + x/16];
+
+    Image2D output{PixelFormat::R8Unorm};
+    CORRADE_BENCHMARK(1)
+        output = euclideanDistanceField(ImageView2D{PixelFormat::R8Unorm, inputSize, input}, {128, 96}, 64);
+
+    CORRADE_COMPARE(output.size(), (Vector2i{128, 96}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::EuclideanDistanceFieldTest)
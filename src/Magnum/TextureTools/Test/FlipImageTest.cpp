@@ -0,0 +1,141 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/TextureTools/FlipImage.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct FlipImageTest: TestSuite::Tester {
+    explicit FlipImageTest();
+
+    void even();
+    void odd();
+    void padding();
+    void singleRow();
+    void empty();
+    void threads();
+};
+
+FlipImageTest::FlipImageTest() {
+    addTests({&FlipImageTest::even,
+              &FlipImageTest::odd,
+              &FlipImageTest::padding,
+              &FlipImageTest::singleRow,
+              &FlipImageTest::empty,
+              &FlipImageTest::threads});
+}
+
+void FlipImageTest::even() {
+    char data[]{
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12,
+        13, 14, 15, 16
+    };
+    flipImageYInPlace(MutableImageView2D{PixelFormat::RG8Unorm, {2, 4}, data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        13, 14, 15, 16,
+        9, 10, 11, 12,
+        5, 6, 7, 8,
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+}
+
+void FlipImageTest::odd() {
+    char data[]{
+        1, 2, 3, 4,
+        5, 6, 7, 8,
+        9, 10, 11, 12
+    };
+    flipImageYInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {1, 3}, data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        9, 10, 11, 12,
+        5, 6, 7, 8,
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+}
+
+void FlipImageTest::padding() {
+    /* The padding bytes should stay untouched */
+    char data[]{
+        1, 2, 3, 'x',
+        4, 5, 6, 'y',
+        7, 8, 9, 'z'
+    };
+    flipImageYInPlace(MutableImageView2D{PixelFormat::R8Unorm, {3, 3}, data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        7, 8, 9, 'x',
+        4, 5, 6, 'y',
+        1, 2, 3, 'z'
+    }), TestSuite::Compare::Container);
+}
+
+void FlipImageTest::singleRow() {
+    char data[]{1, 2, 3, 4};
+    flipImageYInPlace(MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, data});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+}
+
+void FlipImageTest::empty() {
+    /* Shouldn't crash */
+    flipImageYInPlace(MutableImageView2D{PixelFormat::R8Unorm, {0, 4}, nullptr});
+    CORRADE_VERIFY(true);
+}
+
+void FlipImageTest::threads() {
+    /* Large enough for the work to be split across four threads, with an odd
+       height so there's a middle row left in place */
+    const Vector2i size{301, 99};
+    Containers::Array<char> original{Containers::NoInit, std::size_t(size.product()*4)};
+    for(std::size_t i = 0; i != original.size(); ++i)
+        original[i] = char(i*37 + i/11);
+
+    Containers::Array<char> expected{Containers::NoInit, original.size()};
+    Containers::Array<char> actual{Containers::NoInit, original.size()};
+    std::copy(original.begin(), original.end(), expected.begin());
+    std::copy(original.begin(), original.end(), actual.begin());
+
+    flipImageYInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, size, expected}, 1);
+    flipImageYInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, size, actual}, 4);
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+
+    /* Flipping twice gives back the original */
+    flipImageYInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, size, actual}, 4);
+    CORRADE_COMPARE_AS(actual, original, TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::FlipImageTest)
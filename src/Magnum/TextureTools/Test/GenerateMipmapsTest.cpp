@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/GenerateMipmaps.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct GenerateMipmapsTest: TestSuite::Tester {
+    explicit GenerateMipmapsTest();
+
+    void levelCount();
+    void levelCountZeroSize();
+
+    void sizes();
+    void box();
+    void constant();
+    void srgb();
+    void negativeLobesClamped();
+    void singlePixel();
+    void threads();
+
+    void invalidFormat();
+    void empty();
+
+    void benchmark();
+};
+
+using namespace Math::Literals;
+
+const struct {
+    const char* name;
+    MipmapFilter filter;
+} FilterData[]{
+    {"box", MipmapFilter::Box},
+    {"Kaiser", MipmapFilter::Kaiser},
+    {"Lanczos", MipmapFilter::Lanczos}
+};
+
+GenerateMipmapsTest::GenerateMipmapsTest() {
+    addTests({&GenerateMipmapsTest::levelCount,
+              &GenerateMipmapsTest::levelCountZeroSize,
+
+              &GenerateMipmapsTest::sizes,
+              &GenerateMipmapsTest::box});
+
+    addInstancedTests({&GenerateMipmapsTest::constant},
+        Containers::arraySize(FilterData));
+
+    addTests({&GenerateMipmapsTest::srgb,
+              &GenerateMipmapsTest::negativeLobesClamped,
+              &GenerateMipmapsTest::singlePixel});
+
+    addInstancedTests({&GenerateMipmapsTest::threads},
+        Containers::arraySize(FilterData));
+
+    addTests({&GenerateMipmapsTest::invalidFormat,
+              &GenerateMipmapsTest::empty});
+
+    addBenchmarks({&GenerateMipmapsTest::benchmark}, 5);
+}
+
+void GenerateMipmapsTest::levelCount() {
+    CORRADE_COMPARE(mipmapLevelCount({1, 1}), 1);
+    CORRADE_COMPARE(mipmapLevelCount({2, 1}), 2);
+    CORRADE_COMPARE(mipmapLevelCount({5, 1}), 3);
+    CORRADE_COMPARE(mipmapLevelCount({256, 256}), 9);
+    CORRADE_COMPARE(mipmapLevelCount({3, 257}), 9);
+}
+
+void GenerateMipmapsTest::levelCountZeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    mipmapLevelCount({0, 5});
+    CORRADE_COMPARE(out.str(), "TextureTools::mipmapLevelCount(): expected a non-zero size, got Vector(0, 5)\n");
+}
+
+void GenerateMipmapsTest::sizes() {
+    const char data[4*13*6]{};
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {13, 6}, data});
+    CORRADE_COMPARE(levels.size(), 3);
+    CORRADE_COMPARE(levels[0].size(), (Vector2i{6, 3}));
+    CORRADE_COMPARE(levels[1].size(), (Vector2i{3, 1}));
+    CORRADE_COMPARE(levels[2].size(), (Vector2i{1, 1}));
+    for(const Image2D& level: levels)
+        CORRADE_COMPARE(level.format(), PixelFormat::RGBA8Unorm);
+}
+
+void GenerateMipmapsTest::box() {
+    const Float data[]{
+        0.0f, 1.0f, 2.0f, 3.0f,
+        4.0f, 5.0f, 6.0f, 7.0f,
+        8.0f, 9.0f, 10.0f, 11.0f,
+        12.0f, 13.0f, 14.0f, 15.0f
+    };
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::R32F, {4, 4}, data}, MipmapFilter::Box);
+    CORRADE_COMPARE(levels.size(), 2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(levels[0].data()), Containers::arrayView<Float>({
+        2.5f, 4.5f,
+        10.5f, 12.5f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const Float>(levels[1].data()), Containers::arrayView<Float>({
+        7.5f
+    }), TestSuite::Compare::Container);
+}
+
+void GenerateMipmapsTest::constant() {
+    auto&& data = FilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* A constant image stays constant with all filters, including odd
+       sizes */
+    Color4ub pixels[17*9];
+    for(Color4ub& i: pixels) i = 0x336699cc_rgba;
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {17, 9}, pixels}, data.filter);
+    CORRADE_COMPARE(levels.size(), 4);
+    for(const Image2D& level: levels) {
+        CORRADE_ITERATION(level.size());
+        for(const Containers::StridedArrayView1D<const Color4ub> row: level.pixels<Color4ub>())
+            for(const Color4ub& pixel: row)
+                CORRADE_COMPARE(pixel, 0x336699cc_rgba);
+    }
+}
+
+void GenerateMipmapsTest::srgb() {
+    /* Black and white averaged in linear space is 0.5, which is 188 in sRGB.
+       Alpha is linear. */
+    const Color4ub data[]{{0, 0, 0, 0}, {255, 255, 255, 255}};
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Srgb, {2, 1}, data}, MipmapFilter::Box);
+    CORRADE_COMPARE(levels.size(), 1);
+    CORRADE_COMPARE(levels[0].pixels<Color4ub>()[0][0], (Color4ub{188, 188, 188, 128}));
+
+    /* The same as Unorm is averaged directly */
+    levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {2, 1}, data}, MipmapFilter::Box);
+    CORRADE_COMPARE(levels[0].pixels<Color4ub>()[0][0], (Color4ub{128, 128, 128, 128}));
+}
+
+void GenerateMipmapsTest::negativeLobesClamped() {
+    /* A step edge, the Lanczos filter overshoots below zero two pixels before
+       the edge */
+    const Float data[]{
+        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+        1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f
+    };
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::R32F, {16, 1}, data}, MipmapFilter::Lanczos);
+    CORRADE_COMPARE_AS(levels[0].pixels<Float>()[0][2], 0.0f,
+        TestSuite::Compare::Less);
+
+    /* With a normalized format it's clamped instead of wrapping around */
+    UnsignedByte dataUnorm[16];
+    for(std::size_t i = 0; i != 16; ++i) dataUnorm[i] = i < 8 ? 0 : 255;
+    levels = generateMipmaps(ImageView2D{PixelFormat::R8Unorm, {16, 1}, dataUnorm}, MipmapFilter::Lanczos);
+    CORRADE_COMPARE(levels[0].pixels<UnsignedByte>()[0][2], 0);
+}
+
+void GenerateMipmapsTest::singlePixel() {
+    const char data[4]{};
+    Containers::Array<Image2D> levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data});
+    CORRADE_COMPARE(levels.size(), 0);
+}
+
+void GenerateMipmapsTest::threads() {
+    auto&& data = FilterData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough for the work to be split across four threads in the first
+       few levels */
+    const Vector2i size{201, 150};
+    Containers::Array<char> pixels{Containers::NoInit, std::size_t(size.product()*4)};
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = char(i*37 + i/11);
+
+    Containers::Array<Image2D> expected = generateMipmaps(ImageView2D{PixelFormat::RGBA8Srgb, size, pixels}, data.filter, 1);
+    Containers::Array<Image2D> actual = generateMipmaps(ImageView2D{PixelFormat::RGBA8Srgb, size, pixels}, data.filter, 4);
+    CORRADE_COMPARE(actual.size(), expected.size());
+    for(std::size_t i = 0; i != actual.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(actual[i].data(), expected[i].data(),
+            TestSuite::Compare::Container);
+    }
+}
+
+void GenerateMipmapsTest::invalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    generateMipmaps(ImageView2D{PixelFormat::R32UI, {1, 1}, data});
+    CORRADE_COMPARE(out.str(), "TextureTools::generateMipmaps(): unsupported format PixelFormat::R32UI\n");
+}
+
+void GenerateMipmapsTest::empty() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    generateMipmaps(ImageView2D{PixelFormat::R8Unorm, {4, 0}});
+    CORRADE_COMPARE(out.str(), "TextureTools::generateMipmaps(): expected a non-empty image\n");
+}
+
+void GenerateMipmapsTest::benchmark() {
+    const Vector2i size{1024, 1024};
+    Containers::Array<char> pixels{Containers::ValueInit, std::size_t(size.product()*4)};
+
+    Containers::Array<Image2D> levels;
+    CORRADE_BENCHMARK(1)
+        levels = generateMipmaps(ImageView2D{PixelFormat::RGBA8Srgb, size, pixels});
+
+    CORRADE_COMPARE(levels.size(), 10);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::GenerateMipmapsTest)
@@ -0,0 +1,264 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/TextureTools/MultiChannelDistanceField.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct MultiChannelDistanceFieldTest: TestSuite::Tester {
+    explicit MultiChannelDistanceFieldTest();
+
+    void reconstruct();
+    void threads();
+    void alphaChannel();
+    void inputChannels();
+    void emptyOutput();
+
+    void invalidInputFormat();
+    void invalidOutputFormat();
+    void emptyInput();
+
+    void benchmark();
+};
+
+bool square(const Vector2& p) {
+    return p.x() >= 16.0f && p.x() < 48.0f && p.y() >= 16.0f && p.y() < 48.0f;
+}
+
+bool triangle(const Vector2& p) {
+    return p.y() >= 10.0f && p.y() < 54.0f && Math::abs(p.x() - 32.0f) <= (p.y() - 10.0f)*0.6f;
+}
+
+bool disc(const Vector2& p) {
+    return (p - Vector2{32.0f}).dot() < 20.0f*20.0f;
+}
+
+const struct {
+    const char* name;
+    bool(*shape)(const Vector2&);
+    Vector2i size;
+    bool exact;
+} ReconstructData[]{
+    {"square, 8x8", square, {8, 8}, true},
+    {"square, 16x16", square, {16, 16}, true},
+    {"triangle, 16x16", triangle, {16, 16}, false},
+    {"disc, 16x16", disc, {16, 16}, false}
+};
+
+MultiChannelDistanceFieldTest::MultiChannelDistanceFieldTest() {
+    addInstancedTests({&MultiChannelDistanceFieldTest::reconstruct},
+        Containers::arraySize(ReconstructData));
+
+    addTests({&MultiChannelDistanceFieldTest::threads,
+              &MultiChannelDistanceFieldTest::alphaChannel,
+              &MultiChannelDistanceFieldTest::inputChannels,
+              &MultiChannelDistanceFieldTest::emptyOutput,
+
+              &MultiChannelDistanceFieldTest::invalidInputFormat,
+              &MultiChannelDistanceFieldTest::invalidOutputFormat,
+              &MultiChannelDistanceFieldTest::emptyInput});
+
+    addBenchmarks({&MultiChannelDistanceFieldTest::benchmark}, 10);
+}
+
+/* The shape sampled at pixel centers of a 64x64 image */
+Containers::Array<char> inputData(bool(*shape)(const Vector2&)) {
+    Containers::Array<char> data{Containers::ValueInit, 64*64};
+    for(Int y = 0; y != 64; ++y) for(Int x = 0; x != 64; ++x)
+        data[y*64 + x] = shape(Vector2{Vector2i{x, y}} + Vector2{0.5f}) ? '\xff' : '\x00';
+    return data;
+}
+
+/* Bilinearly interpolated value of given channel at a position in input
+   pixels, same as a GPU would do with a clamp-to-edge texture */
+Float sample(const Containers::StridedArrayView2D<const Color4ub>& pixels, const Vector2& scaling, const Vector2& position, const Int channel) {
+    const Vector2i size{Int(pixels.size()[1]), Int(pixels.size()[0])};
+    const Vector2 texel = position/scaling - Vector2{0.5f};
+    const Vector2i a = Math::clamp(Vector2i{Math::floor(texel)}, Vector2i{0}, size - Vector2i{1});
+    const Vector2i b = Math::min(a + Vector2i{1}, size - Vector2i{1});
+    const Vector2 t = Math::clamp(texel - Vector2{a}, Vector2{0.0f}, Vector2{1.0f});
+    const auto value = [&pixels, channel](const Int x, const Int y) {
+        return Float(pixels[y][x][channel]);
+    };
+    return Math::lerp(
+        Math::lerp(value(a.x(), a.y()), value(b.x(), a.y()), t.x()),
+        Math::lerp(value(a.x(), b.y()), value(b.x(), b.y()), t.x()), t.y());
+}
+
+void MultiChannelDistanceFieldTest::reconstruct() {
+    auto&& data = ReconstructData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> input = inputData(data.shape);
+    Image2D output{PixelFormat::RGBA8Unorm, data.size, Containers::Array<char>{Containers::NoInit, std::size_t(data.size.product()*4)}};
+    multiChannelDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {64, 64}, input}, output, 8);
+
+    /* Reconstruct the shape at a 4x higher resolution than the input from
+       the median of the three channels and from the single-channel alpha and
+       count the pixels that differ from the original */
+    const Containers::StridedArrayView2D<const Color4ub> pixels = output.pixels<Color4ub>();
+    const Vector2 scaling = Vector2{64.0f}/Vector2{data.size};
+    std::size_t medianErrors = 0, alphaErrors = 0;
+    for(Int y = 0; y != 256; ++y) for(Int x = 0; x != 256; ++x) {
+        const Vector2 position = (Vector2{Vector2i{x, y}} + Vector2{0.5f})/4.0f;
+        const bool expected = data.shape(position);
+        const Float r = sample(pixels, scaling, position, 0);
+        const Float g = sample(pixels, scaling, position, 1);
+        const Float b = sample(pixels, scaling, position, 2);
+        const Float median = Math::max(Math::min(r, g), Math::min(Math::max(r, g), b));
+        if((median > 127.5f) != expected) ++medianErrors;
+        if((sample(pixels, scaling, position, 3) > 127.5f) != expected) ++alphaErrors;
+    }
+
+    /* Straight edges meeting in a corner should be reconstructed perfectly,
+       for the rest at least not worse than with a single channel */
+    if(data.exact) CORRADE_COMPARE(medianErrors, 0);
+    CORRADE_COMPARE_AS(medianErrors, alphaErrors,
+        TestSuite::Compare::LessOrEqual);
+}
+
+void MultiChannelDistanceFieldTest::threads() {
+    Containers::Array<char> input = inputData(triangle);
+    const ImageView2D inputImage{PixelFormat::R8Unorm, {64, 64}, input};
+
+    Image2D expected = multiChannelDistanceField(inputImage, {16, 16}, 8);
+    Image2D actual = multiChannelDistanceField(inputImage, {16, 16}, 8, 3);
+    CORRADE_COMPARE(actual.format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(actual.size(), (Vector2i{16, 16}));
+    CORRADE_COMPARE_AS(actual.data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void MultiChannelDistanceFieldTest::alphaChannel() {
+    /* The color channels should be the same regardless of whether the alpha
+       is calculated or not */
+    Containers::Array<char> input = inputData(triangle);
+    const ImageView2D inputImage{PixelFormat::R8Unorm, {64, 64}, input};
+
+    Image2D rgb = multiChannelDistanceField(inputImage, {13, 7}, 6);
+    Image2D rgba{PixelFormat::RGBA8Unorm, {13, 7}, Containers::Array<char>{Containers::NoInit, 13*7*4}};
+    multiChannelDistanceFieldInto(inputImage, rgba, 6);
+
+    const Containers::StridedArrayView2D<const Color3ub> rgbPixels = rgb.pixels<Color3ub>();
+    const Containers::StridedArrayView2D<const Color4ub> rgbaPixels = rgba.pixels<Color4ub>();
+    for(Int y = 0; y != 7; ++y) for(Int x = 0; x != 13; ++x) {
+        CORRADE_ITERATION(x, y);
+        CORRADE_COMPARE(rgbaPixels[y][x].rgb(), rgbPixels[y][x]);
+    }
+}
+
+void MultiChannelDistanceFieldTest::inputChannels() {
+    /* Only the first channel is taken into account */
+    Containers::Array<char> input = inputData(triangle);
+    Containers::Array<char> inputRgba{Containers::ValueInit, input.size()*4};
+    for(std::size_t i = 0; i != input.size(); ++i) {
+        inputRgba[i*4 + 0] = input[i];
+        inputRgba[i*4 + 1] = char(~input[i]);
+        inputRgba[i*4 + 3] = '\xff';
+    }
+
+    Image2D expected = multiChannelDistanceField(ImageView2D{PixelFormat::R8Unorm, {64, 64}, input}, {16, 16}, 5);
+    Image2D actual = multiChannelDistanceField(ImageView2D{PixelFormat::RGBA8Unorm, {64, 64}, inputRgba}, {16, 16}, 5);
+    CORRADE_COMPARE_AS(actual.data(), expected.data(),
+        TestSuite::Compare::Container);
+}
+
+void MultiChannelDistanceFieldTest::emptyOutput() {
+    const char input[4]{};
+    Image2D output = multiChannelDistanceField(ImageView2D{PixelFormat::R8Unorm, {4, 1}, input}, {0, 5}, 3);
+    CORRADE_COMPARE(output.size(), (Vector2i{0, 5}));
+}
+
+void MultiChannelDistanceFieldTest::invalidInputFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char input[8]{};
+    char output[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiChannelDistanceFieldInto(ImageView2D{PixelFormat::R16Unorm, {4, 1}, input}, MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::multiChannelDistanceFieldInto(): unsupported input format PixelFormat::R16Unorm\n");
+}
+
+void MultiChannelDistanceFieldTest::invalidOutputFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char input[4]{};
+    char output[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiChannelDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {4, 1}, input}, MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::multiChannelDistanceFieldInto(): expected output format PixelFormat::RGB8Unorm or PixelFormat::RGBA8Unorm but got PixelFormat::R8Unorm\n");
+}
+
+void MultiChannelDistanceFieldTest::emptyInput() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char output[16];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    multiChannelDistanceFieldInto(ImageView2D{PixelFormat::R8Unorm, {0, 1}}, MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 1}, output}, 3);
+    CORRADE_COMPARE(out.str(), "TextureTools::multiChannelDistanceFieldInto(): expected a non-empty input image\n");
+}
+
+void MultiChannelDistanceFieldTest::benchmark() {
+    /* Scale the triangle up 16 times to get a reasonably sized input */
+    const Vector2i inputSize{1024, 1024};
+    Containers::Array<char> pattern = inputData(triangle);
+    Containers::Array<char> input{Containers::NoInit, std::size_t(inputSize.product())};
+    for(Int y = 0; y != inputSize.y(); ++y) for(Int x = 0; x != inputSize.x(); ++x)
+        input[y*inputSize.x() + x] = pattern[(y/16)*64 + x/16];
+
+    Image2D output{PixelFormat::RGB8Unorm};
+    CORRADE_BENCHMARK(1)
+        output = multiChannelDistanceField(ImageView2D{PixelFormat::R8Unorm, inputSize, input}, {128, 128}, 64);
+
+    CORRADE_COMPARE(output.size(), (Vector2i{128, 128}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::MultiChannelDistanceFieldTest)
@@ -0,0 +1,237 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
+#include "Magnum/TextureTools/PackTextureArrays.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct PackTextureArraysTest: TestSuite::Tester {
+    explicit PackTextureArraysTest();
+
+    void pack();
+    void packMultipleLayers();
+    void packPadding();
+    void packImplementationSpecificFormat();
+    void packEmpty();
+
+    void wrongViewSize();
+    void invalidLayerSize();
+};
+
+PackTextureArraysTest::PackTextureArraysTest() {
+    addTests({&PackTextureArraysTest::pack,
+              &PackTextureArraysTest::packMultipleLayers,
+              &PackTextureArraysTest::packPadding,
+              &PackTextureArraysTest::packImplementationSpecificFormat,
+              &PackTextureArraysTest::packEmpty,
+
+              &PackTextureArraysTest::wrongViewSize,
+              &PackTextureArraysTest::invalidLayerSize});
+}
+
+void PackTextureArraysTest::pack() {
+    Color4ub a[4*4];
+    Color4ub b[8*2];
+    UnsignedByte c[4*2];
+    Color4ub d[12*12];
+    for(Color4ub& i: a) i = {0x11, 0x11, 0x11, 0xff};
+    for(Color4ub& i: b) i = {0x22, 0x22, 0x22, 0xff};
+    for(UnsignedByte& i: c) i = 0x33;
+    for(Color4ub& i: d) i = {0x44, 0x44, 0x44, 0xff};
+
+    const ImageView2D images[]{
+        ImageView2D{PixelFormat::RGBA8Unorm, {4, 4}, a},
+        ImageView2D{PixelFormat::RGBA8Unorm, {8, 2}, b},
+        ImageView2D{PixelFormat::R8Unorm, {4, 2}, c},
+        /* Doesn't fit into the layer, gets into an array with 16x16 layers */
+        ImageView2D{PixelFormat::RGBA8Unorm, {12, 12}, d},
+    };
+    TextureArrayPlacement placements[Containers::arraySize(images)];
+
+    Containers::Array<Image3D> out = packTextureArrays(images, placements, {8, 8});
+    CORRADE_COMPARE(out.size(), 3);
+
+    CORRADE_COMPARE(placements[0].array, 0);
+    CORRADE_COMPARE(placements[0].layer, 0);
+    CORRADE_COMPARE(placements[0].rectangle, (Range2Di{{0, 0}, {4, 4}}));
+    CORRADE_COMPARE(placements[0].textureMatrix, Matrix3::scaling({0.5f, 0.5f}));
+    CORRADE_COMPARE(placements[1].array, 0);
+    CORRADE_COMPARE(placements[1].layer, 0);
+    CORRADE_COMPARE(placements[1].rectangle, (Range2Di{{0, 4}, {8, 6}}));
+    CORRADE_COMPARE(placements[1].textureMatrix,
+        Matrix3::translation({0.0f, 0.5f})*Matrix3::scaling({1.0f, 0.25f}));
+    CORRADE_COMPARE(placements[2].array, 1);
+    CORRADE_COMPARE(placements[2].layer, 0);
+    CORRADE_COMPARE(placements[2].rectangle, (Range2Di{{0, 0}, {4, 2}}));
+    CORRADE_COMPARE(placements[3].array, 2);
+    CORRADE_COMPARE(placements[3].layer, 0);
+    CORRADE_COMPARE(placements[3].rectangle, (Range2Di{{0, 0}, {12, 12}}));
+    CORRADE_COMPARE(placements[3].textureMatrix, Matrix3::scaling({0.75f, 0.75f}));
+
+    CORRADE_COMPARE(out[0].format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(out[0].size(), (Vector3i{8, 8, 1}));
+    Containers::StridedArrayView3D<const Color4ub> pixels0 = out[0].pixels<Color4ub>();
+    CORRADE_COMPARE(pixels0[0][0][0], (Color4ub{0x11, 0x11, 0x11, 0xff}));
+    CORRADE_COMPARE(pixels0[0][3][3], (Color4ub{0x11, 0x11, 0x11, 0xff}));
+    CORRADE_COMPARE(pixels0[0][4][7], (Color4ub{0x22, 0x22, 0x22, 0xff}));
+    CORRADE_COMPARE(pixels0[0][5][0], (Color4ub{0x22, 0x22, 0x22, 0xff}));
+    /* Space not covered by any image is zero-filled */
+    CORRADE_COMPARE(pixels0[0][0][4], (Color4ub{}));
+    CORRADE_COMPARE(pixels0[0][7][7], (Color4ub{}));
+
+    CORRADE_COMPARE(out[1].format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(out[1].size(), (Vector3i{8, 8, 1}));
+    Containers::StridedArrayView3D<const UnsignedByte> pixels1 = out[1].pixels<UnsignedByte>();
+    CORRADE_COMPARE(pixels1[0][1][3], 0x33);
+    CORRADE_COMPARE(pixels1[0][2][3], 0);
+
+    CORRADE_COMPARE(out[2].format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE(out[2].size(), (Vector3i{16, 16, 1}));
+    Containers::StridedArrayView3D<const Color4ub> pixels2 = out[2].pixels<Color4ub>();
+    CORRADE_COMPARE(pixels2[0][11][11], (Color4ub{0x44, 0x44, 0x44, 0xff}));
+    CORRADE_COMPARE(pixels2[0][12][12], (Color4ub{}));
+}
+
+void PackTextureArraysTest::packMultipleLayers() {
+    Color4ub data[8*8]{};
+    const ImageView2D images[]{
+        ImageView2D{PixelFormat::RGBA8Unorm, {8, 8}, data},
+        ImageView2D{PixelFormat::RGBA8Unorm, {8, 8}, data},
+        ImageView2D{PixelFormat::RGBA8Unorm, {8, 8}, data},
+    };
+    TextureArrayPlacement placements[Containers::arraySize(images)];
+
+    Containers::Array<Image3D> out = packTextureArrays(images, placements, {8, 8});
+    CORRADE_COMPARE(out.size(), 1);
+    CORRADE_COMPARE(out[0].size(), (Vector3i{8, 8, 3}));
+    for(std::size_t i = 0; i != Containers::arraySize(images); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(placements[i].array, 0);
+        CORRADE_COMPARE(placements[i].layer, Int(i));
+        CORRADE_COMPARE(placements[i].rectangle, (Range2Di{{}, {8, 8}}));
+        CORRADE_COMPARE(placements[i].textureMatrix, Matrix3{});
+    }
+}
+
+void PackTextureArraysTest::packPadding() {
+    Color4ub data[7*7]{};
+    const ImageView2D images[]{
+        /* Fits exactly with the padding */
+        ImageView2D{PixelFormat::RGBA8Unorm, {6, 6}, data},
+        /* Doesn't fit with the padding */
+        ImageView2D{PixelFormat::RGBA8Unorm, {7, 7}, data},
+    };
+    TextureArrayPlacement placements[Containers::arraySize(images)];
+
+    Containers::Array<Image3D> out = packTextureArrays(images, placements, {8, 8}, {1, 1});
+    CORRADE_COMPARE(out.size(), 2);
+    CORRADE_COMPARE(out[0].size(), (Vector3i{8, 8, 1}));
+    CORRADE_COMPARE(out[1].size(), (Vector3i{16, 16, 1}));
+    CORRADE_COMPARE(placements[0].array, 0);
+    CORRADE_COMPARE(placements[0].rectangle, (Range2Di{{1, 1}, {7, 7}}));
+    CORRADE_COMPARE(placements[1].array, 1);
+    CORRADE_COMPARE(placements[1].rectangle, (Range2Di{{1, 1}, {8, 8}}));
+    CORRADE_COMPARE(placements[1].textureMatrix,
+        Matrix3::translation({0.0625f, 0.0625f})*Matrix3::scaling({0.4375f, 0.4375f}));
+}
+
+void PackTextureArraysTest::packImplementationSpecificFormat() {
+    const char data[]{
+        1, 2, 3, 4, 5, 6, 7, 8
+    };
+    const ImageView2D images[]{
+        ImageView2D{PixelStorage{}, 0xdead, 0xbeef, 2, {2, 2}, data},
+        ImageView2D{PixelStorage{}, 0xdead, 0xbeef, 2, {2, 2}, data},
+        /* Different format extra, goes to a separate array */
+        ImageView2D{PixelStorage{}, 0xdead, 0xcafe, 2, {2, 2}, data},
+    };
+    TextureArrayPlacement placements[Containers::arraySize(images)];
+
+    Containers::Array<Image3D> out = packTextureArrays(images, placements, {4, 2});
+    CORRADE_COMPARE(out.size(), 2);
+    CORRADE_VERIFY(isPixelFormatImplementationSpecific(out[0].format()));
+    CORRADE_COMPARE(pixelFormatUnwrap(out[0].format()), 0xdead);
+    CORRADE_COMPARE(out[0].formatExtra(), 0xbeef);
+    CORRADE_COMPARE(out[0].pixelSize(), 2);
+    CORRADE_COMPARE(out[0].size(), (Vector3i{4, 2, 1}));
+    CORRADE_COMPARE(out[1].formatExtra(), 0xcafe);
+    CORRADE_COMPARE(placements[0].rectangle, (Range2Di{{0, 0}, {2, 2}}));
+    CORRADE_COMPARE(placements[1].rectangle, (Range2Di{{2, 0}, {4, 2}}));
+    CORRADE_COMPARE(placements[2].array, 1);
+
+    /* Rows are eight bytes, the second image is at a four-byte offset */
+    const char* outData = out[0].data();
+    CORRADE_COMPARE(outData[4], 1);
+    CORRADE_COMPARE(outData[7], 4);
+    CORRADE_COMPARE(outData[12], 5);
+    CORRADE_COMPARE(outData[15], 8);
+}
+
+void PackTextureArraysTest::packEmpty() {
+    CORRADE_COMPARE(packTextureArrays(nullptr, nullptr, {8, 8}).size(), 0);
+}
+
+void PackTextureArraysTest::wrongViewSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Color4ub data[1]{};
+    const ImageView2D images[]{
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data},
+        ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}
+    };
+    TextureArrayPlacement placements[1];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packTextureArrays(images, placements, {8, 8});
+    CORRADE_COMPARE(out.str(), "TextureTools::packTextureArrays(): expected images and placements views to have the same size, got 2 and 1\n");
+}
+
+void PackTextureArraysTest::invalidLayerSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    packTextureArrays(nullptr, nullptr, {8, 0});
+    CORRADE_COMPARE(out.str(), "TextureTools::packTextureArrays(): expected a positive layer size, got Vector(8, 0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::PackTextureArraysTest)
@@ -0,0 +1,223 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Cpu.h"
+#include "Magnum/TextureTools/SwizzleImage.h"
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct SwizzleImageTest: TestSuite::Tester {
+    explicit SwizzleImageTest();
+
+    void rgba8();
+    void rgb8();
+    void rg16();
+    void rgba32f();
+    void duplicate();
+    void identity();
+    void padding();
+    void scalarFallback();
+    void threads();
+
+    void invalidFormat();
+    void invalidChannel();
+};
+
+SwizzleImageTest::SwizzleImageTest() {
+    addTests({&SwizzleImageTest::rgba8,
+              &SwizzleImageTest::rgb8,
+              &SwizzleImageTest::rg16,
+              &SwizzleImageTest::rgba32f,
+              &SwizzleImageTest::duplicate,
+              &SwizzleImageTest::identity,
+              &SwizzleImageTest::padding,
+              &SwizzleImageTest::scalarFallback,
+              &SwizzleImageTest::threads,
+
+              &SwizzleImageTest::invalidFormat,
+              &SwizzleImageTest::invalidChannel});
+}
+
+void SwizzleImageTest::rgba8() {
+    /* Five pixels, so four go through the SIMD path and one through the
+       scalar remainder */
+    char data[]{
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {5, 1}, data}, {2, 1, 0, 3});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        3, 2, 1, 4, 7, 6, 5, 8, 11, 10, 9, 12, 15, 14, 13, 16, 19, 18, 17, 20
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::rgb8() {
+    /* The fourth item of the swizzle is ignored */
+    char data[]{
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGB8Srgb, {4, 1}, data}, {2, 1, 0, 3});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        3, 2, 1, 6, 5, 4, 9, 8, 7, 12, 11, 10
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::rg16() {
+    /* Components are moved as a whole */
+    UnsignedShort data[]{
+        0x0102, 0x0304, 0x0506, 0x0708, 0x090a, 0x0b0c, 0x0d0e, 0x0f10,
+        0x1112, 0x1314
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RG16UI, {5, 1}, data}, {1, 0, 0, 0});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<UnsignedShort>({
+        0x0304, 0x0102, 0x0708, 0x0506, 0x0b0c, 0x090a, 0x0f10, 0x0d0e,
+        0x1314, 0x1112
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::rgba32f() {
+    Float data[]{
+        1.0f, 2.0f, 3.0f, 4.0f,
+        5.0f, 6.0f, 7.0f, 8.0f
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGBA32F, {2, 1}, data}, {3, 2, 1, 0});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<Float>({
+        4.0f, 3.0f, 2.0f, 1.0f,
+        8.0f, 7.0f, 6.0f, 5.0f
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::duplicate() {
+    char data[]{
+        1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {4, 1}, data}, {0, 0, 0, 3});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        1, 1, 1, 4, 5, 5, 5, 8, 9, 9, 9, 12, 13, 13, 13, 16
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::identity() {
+    /* Only the first channel is used for a single-channel format, so this is
+       a no-op */
+    char data[]{1, 2, 3, 4};
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::R8Unorm, {4, 1}, data}, {0, 2, 1, 3});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        1, 2, 3, 4
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::padding() {
+    /* The padding bytes should stay untouched */
+    char data[]{
+        1, 2, 3, 4, 5, 6, 'x', 'y',
+        7, 8, 9, 10, 11, 12, 'z', 'w'
+    };
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RG8Unorm, {3, 2}, data}, {1, 0, 0, 0});
+    CORRADE_COMPARE_AS(Containers::arrayView(data), Containers::arrayView<char>({
+        2, 1, 4, 3, 6, 5, 'x', 'y',
+        8, 7, 10, 9, 12, 11, 'z', 'w'
+    }), TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::scalarFallback() {
+    #ifndef CORRADE_TARGET_SSE2
+    CORRADE_SKIP("The scalar fallback can be forced only on x86.");
+    #else
+    if(Math::detectedCpuTier() < Math::CpuTier::Sse41)
+        CORRADE_SKIP("The SIMD variant isn't available on this machine.");
+
+    Containers::Array<char> expected{Containers::NoInit, 37*4};
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        expected[i] = char(i*37 + i/11);
+    Containers::Array<char> actual{Containers::NoInit, expected.size()};
+    std::copy(expected.begin(), expected.end(), actual.begin());
+
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {37, 1}, expected}, {3, 0, 2, 1});
+
+    const Math::CpuTier tier = Math::cpuTier();
+    Math::setCpuTier(Math::CpuTier::Sse2);
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGBA8Unorm, {37, 1}, actual}, {3, 0, 2, 1});
+    Math::setCpuTier(tier);
+
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+    #endif
+}
+
+void SwizzleImageTest::threads() {
+    /* Large enough for the work to be split across four threads */
+    const Vector2i size{201, 150};
+    Containers::Array<char> expected{Containers::NoInit, std::size_t(size.product()*3)};
+    for(std::size_t i = 0; i != expected.size(); ++i)
+        expected[i] = char(i*37 + i/11);
+    Containers::Array<char> actual{Containers::NoInit, expected.size()};
+    std::copy(expected.begin(), expected.end(), actual.begin());
+
+    swizzleImageInPlace(MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, size, expected}, {1, 2, 0, 0}, 1);
+    swizzleImageInPlace(MutableImageView2D{PixelStorage{}.setAlignment(1), PixelFormat::RGB8Unorm, size, actual}, {1, 2, 0, 0}, 4);
+    CORRADE_COMPARE_AS(actual, expected, TestSuite::Compare::Container);
+}
+
+void SwizzleImageTest::invalidFormat() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    swizzleImageInPlace(MutableImageView2D{pixelFormatWrap(0xdead), {4, 1}, data}, {0, 0, 0, 0});
+    CORRADE_COMPARE(out.str(), "TextureTools::swizzleImageInPlace(): unsupported format PixelFormat::ImplementationSpecific(0xdead)\n");
+}
+
+void SwizzleImageTest::invalidChannel() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGB8Unorm, {1, 1}, data}, {2, 1, 3, 0});
+    swizzleImageInPlace(MutableImageView2D{PixelFormat::RGB8Unorm, {1, 1}, data}, {-1, 1, 2, 0});
+    CORRADE_COMPARE(out.str(),
+        "TextureTools::swizzleImageInPlace(): channel 3 out of range for 3 channels\n"
+        "TextureTools::swizzleImageInPlace(): channel -1 out of range for 3 channels\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::SwizzleImageTest)
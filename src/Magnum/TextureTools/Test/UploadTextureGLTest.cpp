@@ -0,0 +1,241 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/OpenGLTester.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/TextureTools/UploadTexture.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/TextureStreamer.h"
+#endif
+
+namespace Magnum { namespace TextureTools { namespace Test { namespace {
+
+struct UploadTextureGLTest: GL::OpenGLTester {
+    explicit UploadTextureGLTest();
+
+    void upload();
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    void uploadStreamer();
+    #endif
+    void uploadImportFailed();
+    void uploadLevelImportFailed();
+    void uploadLevelDifferentFormat();
+    void uploadLevelDifferentSize();
+    void uploadImplementationSpecificFormat();
+};
+
+UploadTextureGLTest::UploadTextureGLTest() {
+    addTests({&UploadTextureGLTest::upload,
+              #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+              &UploadTextureGLTest::uploadStreamer,
+              #endif
+              &UploadTextureGLTest::uploadImportFailed,
+              &UploadTextureGLTest::uploadLevelImportFailed,
+              &UploadTextureGLTest::uploadLevelDifferentFormat,
+              &UploadTextureGLTest::uploadLevelDifferentSize,
+              &UploadTextureGLTest::uploadImplementationSpecificFormat});
+}
+
+struct Level {
+    /* Zero size means the import fails */
+    PixelFormat format;
+    Vector2i size;
+};
+
+/* Fills each level with bytes starting at level*16 */
+struct LevelImporter: Trade::AbstractImporter {
+    explicit LevelImporter(Containers::ArrayView<const Level> levels): levels{levels} {}
+
+    Trade::ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doImage2DCount() const override { return 1; }
+    UnsignedInt doImage2DLevelCount(UnsignedInt) override { return levels.size(); }
+    Containers::Optional<Trade::ImageData2D> doImage2D(UnsignedInt, UnsignedInt level) override {
+        const Level& l = levels[level];
+        if(l.size.isZero()) {
+            Error{} << "level" << level << "import failed";
+            return {};
+        }
+
+        Containers::Array<char> data{Containers::NoInit, std::size_t(l.size.product()*pixelSize(l.format))};
+        for(std::size_t i = 0; i != data.size(); ++i)
+            data[i] = char(level*16 + i);
+
+        if(implementationSpecific)
+            return Trade::ImageData2D{PixelStorage{}, 0xdead, 0, pixelSize(l.format), l.size, std::move(data)};
+        return Trade::ImageData2D{l.format, l.size, std::move(data)};
+    }
+
+    Containers::ArrayView<const Level> levels;
+    bool implementationSpecific{};
+};
+
+constexpr Level ThreeLevels[]{
+    {PixelFormat::RGBA8Unorm, {4, 2}},
+    {PixelFormat::RGBA8Unorm, {2, 1}},
+    {PixelFormat::RGBA8Unorm, {1, 1}}
+};
+
+void UploadTextureGLTest::upload() {
+    LevelImporter importer{ThreeLevels};
+
+    Containers::Optional<GL::Texture2D> texture = uploadTexture2D(importer, 0);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(texture);
+
+    #ifndef MAGNUM_TARGET_GLES
+    CORRADE_COMPARE(texture->imageSize(0), (Vector2i{4, 2}));
+    CORRADE_COMPARE(texture->imageSize(1), (Vector2i{2, 1}));
+    CORRADE_COMPARE(texture->imageSize(2), (Vector2i{1, 1}));
+
+    Image2D level1 = texture->image(1, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(level1.data()),
+        Containers::arrayView<UnsignedByte>({16, 17, 18, 19, 20, 21, 22, 23}),
+        TestSuite::Compare::Container);
+
+    Image2D level2 = texture->image(2, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(level2.data()),
+        Containers::arrayView<UnsignedByte>({32, 33, 34, 35}),
+        TestSuite::Compare::Container);
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+void UploadTextureGLTest::uploadStreamer() {
+    LevelImporter importer{ThreeLevels};
+
+    /* The first level is too large for the buffers and gets uploaded
+       directly, the other two go through the streamer */
+    GL::TextureStreamer2D streamer{16, 2};
+
+    Containers::Optional<GL::Texture2D> texture = uploadTexture2D(importer, 0, streamer);
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(texture);
+
+    #ifndef MAGNUM_TARGET_GLES
+    Image2D level0 = texture->image(0, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(level0.size(), (Vector2i{4, 2}));
+    CORRADE_COMPARE(Containers::arrayCast<const UnsignedByte>(level0.data())[31], 31);
+
+    Image2D level1 = texture->image(1, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(level1.data()),
+        Containers::arrayView<UnsignedByte>({16, 17, 18, 19, 20, 21, 22, 23}),
+        TestSuite::Compare::Container);
+
+    Image2D level2 = texture->image(2, {PixelFormat::RGBA8Unorm});
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(level2.data()),
+        Containers::arrayView<UnsignedByte>({32, 33, 34, 35}),
+        TestSuite::Compare::Container);
+    #endif
+}
+#endif
+
+void UploadTextureGLTest::uploadImportFailed() {
+    const Level levels[]{
+        {PixelFormat::RGBA8Unorm, {}}
+    };
+    LevelImporter importer{levels};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!uploadTexture2D(importer, 0));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "level 0 import failed\n");
+}
+
+void UploadTextureGLTest::uploadLevelImportFailed() {
+    const Level levels[]{
+        {PixelFormat::RGBA8Unorm, {4, 2}},
+        {PixelFormat::RGBA8Unorm, {}}
+    };
+    LevelImporter importer{levels};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!uploadTexture2D(importer, 0));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "level 1 import failed\n");
+}
+
+void UploadTextureGLTest::uploadLevelDifferentFormat() {
+    const Level levels[]{
+        {PixelFormat::RGBA8Unorm, {4, 2}},
+        {PixelFormat::RG8Unorm, {2, 1}}
+    };
+    LevelImporter importer{levels};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!uploadTexture2D(importer, 0));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "TextureTools::uploadTexture2D(): expected level 1 to have format PixelFormat::RGBA8Unorm but got PixelFormat::RG8Unorm\n");
+}
+
+void UploadTextureGLTest::uploadLevelDifferentSize() {
+    const Level levels[]{
+        {PixelFormat::RGBA8Unorm, {4, 2}},
+        {PixelFormat::RGBA8Unorm, {2, 1}},
+        {PixelFormat::RGBA8Unorm, {2, 1}}
+    };
+    LevelImporter importer{levels};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!uploadTexture2D(importer, 0));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "TextureTools::uploadTexture2D(): expected level 2 to have size Vector(1, 1) but got Vector(2, 1)\n");
+}
+
+void UploadTextureGLTest::uploadImplementationSpecificFormat() {
+    LevelImporter importer{ThreeLevels};
+    importer.implementationSpecific = true;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!uploadTexture2D(importer, 0));
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_COMPARE(out.str(), "TextureTools::uploadTexture2D(): format PixelFormat::ImplementationSpecific(0xdead) can't be mapped to a texture format\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::TextureTools::Test::UploadTextureGLTest)
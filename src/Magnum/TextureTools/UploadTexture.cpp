@@ -0,0 +1,142 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "UploadTexture.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/GL/TextureFormat.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+#include "Magnum/GL/TextureStreamer.h"
+#endif
+
+namespace Magnum { namespace TextureTools {
+
+namespace {
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Containers::Optional<GL::Texture2D> uploadTexture2DImplementation(Trade::AbstractImporter& importer, const UnsignedInt id, GL::TextureStreamer2D* const streamer)
+#else
+Containers::Optional<GL::Texture2D> uploadTexture2DImplementation(Trade::AbstractImporter& importer, const UnsignedInt id)
+#endif
+{
+    const UnsignedInt levelCount = importer.image2DLevelCount(id);
+    Containers::Optional<Trade::ImageData2D> image = importer.image2D(id, 0);
+    if(!image) return {};
+
+    /* Everything else is expected to match the first level */
+    const bool compressed = image->isCompressed();
+    const Vector2i size = image->size();
+    PixelFormat format{};
+    CompressedPixelFormat compressedFormat{};
+    GL::TextureFormat textureFormat;
+    if(compressed) {
+        compressedFormat = image->compressedFormat();
+        if(!GL::hasTextureFormat(compressedFormat)) {
+            Error{} << "TextureTools::uploadTexture2D(): format" << compressedFormat << "is not supported on this target";
+            return {};
+        }
+        textureFormat = GL::textureFormat(compressedFormat);
+    } else {
+        format = image->format();
+        if(isPixelFormatImplementationSpecific(format) || !GL::hasTextureFormat(format)) {
+            Error{} << "TextureTools::uploadTexture2D(): format" << format << "can't be mapped to a texture format";
+            return {};
+        }
+        textureFormat = GL::textureFormat(format);
+    }
+
+    /* Allocate the whole mip chain at once */
+    GL::Texture2D texture;
+    texture.setStorage(levelCount, textureFormat, size);
+
+    for(UnsignedInt level = 0; level != levelCount; ++level) {
+        if(level) {
+            image = importer.image2D(id, level);
+            if(!image) return {};
+
+            if(image->isCompressed() != compressed || (compressed ? image->compressedFormat() != compressedFormat : image->format() != format)) {
+                Error e;
+                e << "TextureTools::uploadTexture2D(): expected level" << level << "to have format";
+                if(compressed) e << compressedFormat;
+                else e << format;
+                e << "but got";
+                if(image->isCompressed()) e << image->compressedFormat();
+                else e << image->format();
+                return {};
+            }
+
+            const Vector2i expectedSize = Math::max(size >> Int(level), Vector2i{1});
+            if(image->size() != expectedSize) {
+                Error{} << "TextureTools::uploadTexture2D(): expected level" << level << "to have size" << expectedSize << "but got" << image->size();
+                return {};
+            }
+        }
+
+        if(compressed) {
+            texture.setCompressedSubImage(level, {}, CompressedImageView2D(*image));
+            continue;
+        }
+
+        /* Go through a pixel buffer if possible, otherwise upload directly */
+        #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+        if(streamer && image->data().size() <= streamer->bufferSize()) {
+            if(Containers::Optional<GL::TextureStreamer2D::Staging> staging = streamer->acquire(image->data().size())) {
+                Utility::copy(image->data(), staging->data);
+                streamer->upload(*staging, texture, level, {}, image->storage(), format, image->size());
+                continue;
+            }
+        }
+        #endif
+
+        texture.setSubImage(level, {}, ImageView2D(*image));
+    }
+
+    return Containers::Optional<GL::Texture2D>{std::move(texture)};
+}
+
+}
+
+Containers::Optional<GL::Texture2D> uploadTexture2D(Trade::AbstractImporter& importer, const UnsignedInt id) {
+    #if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+    return uploadTexture2DImplementation(importer, id, nullptr);
+    #else
+    return uploadTexture2DImplementation(importer, id);
+    #endif
+}
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+Containers::Optional<GL::Texture2D> uploadTexture2D(Trade::AbstractImporter& importer, const UnsignedInt id, GL::TextureStreamer2D& streamer) {
+    return uploadTexture2DImplementation(importer, id, &streamer);
+}
+#endif
+
+}}
@@ -0,0 +1,97 @@
+#ifndef Magnum_TextureTools_UploadTexture_h
+#define Magnum_TextureTools_UploadTexture_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+/** @file
+ * @brief Function @ref Magnum::TextureTools::uploadTexture2D()
+ * @m_since_latest
+ */
+
+#include "Magnum/configure.h"
+
+#ifdef MAGNUM_TARGET_GL
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/GL/Texture.h"
+#include "Magnum/TextureTools/visibility.h"
+#include "Magnum/Trade/Trade.h"
+
+namespace Magnum { namespace TextureTools {
+
+/**
+@brief Upload an imported image with all its levels to a texture
+@param importer     Importer with an opened file
+@param id           Image ID, expected to be less than
+    @ref Trade::AbstractImporter::image2DCount()
+@m_since_latest
+
+Creates a texture with immutable storage for exactly
+@ref Trade::AbstractImporter::image2DLevelCount() levels in a format matching
+the first level and uploads all levels with
+@ref GL::Texture::setSubImage() or @ref GL::Texture::setCompressedSubImage().
+The storage is thus allocated just once and the driver doesn't need to
+revalidate the texture as levels get added, which would be the case when
+using @ref GL::Texture::setImage():
+
+@snippet MagnumTextureTools-gl.cpp uploadTexture2D
+
+Filtering, wrapping and other sampler parameters are left at their defaults.
+If any level fails to import, if it has a different format than the first
+level or a size that doesn't match the mip chain, or if the format can't be
+mapped to a @ref GL::TextureFormat, a message is printed to
+@relativeref{Magnum,Error} and @relativeref{Corrade,Containers::NullOpt} is
+returned.
+@see @ref GL::textureFormat(Magnum::PixelFormat),
+    @ref GL::textureFormat(Magnum::CompressedPixelFormat)
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Optional<GL::Texture2D> uploadTexture2D(Trade::AbstractImporter& importer, UnsignedInt id);
+
+#if !defined(MAGNUM_TARGET_GLES2) && !defined(MAGNUM_TARGET_WEBGL)
+/**
+@brief Upload an imported image with all its levels to a texture through a texture streamer
+@m_since_latest
+
+Same as @ref uploadTexture2D(Trade::AbstractImporter&, UnsignedInt), but
+uncompressed levels are copied to pixel buffers acquired from @p streamer
+and the driver then copies them to the texture asynchronously. Levels that
+are larger than @ref GL::TextureStreamer::bufferSize() or for which there's
+no pixel buffer available at the moment are uploaded directly, as are
+compressed levels.
+@requires_gl30 Extension @gl_extension{ARB,map_buffer_range}
+@requires_gl32 Extension @gl_extension{ARB,sync}
+@requires_gles30 Pixel buffer objects and sync objects are not available in
+    OpenGL ES 2.0.
+@requires_gles Buffer mapping is not available in WebGL.
+*/
+MAGNUM_TEXTURETOOLS_EXPORT Containers::Optional<GL::Texture2D> uploadTexture2D(Trade::AbstractImporter& importer, UnsignedInt id, GL::TextureStreamer2D& streamer);
+#endif
+
+}}
+#else
+#error this header is available only in the OpenGL build
+#endif
+
+#endif
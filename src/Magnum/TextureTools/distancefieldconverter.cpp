@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Utility/Arguments.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -33,11 +34,16 @@
 #include "Magnum/ImageView.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Range.h"
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/Texture.h"
+#ifndef MAGNUM_TARGET_GLES2
+#include "Magnum/GL/TextureArray.h"
+#endif
 #include "Magnum/GL/TextureFormat.h"
 #include "Magnum/TextureTools/DistanceField.h"
+#include "Magnum/TextureTools/EuclideanDistanceField.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -91,20 +97,29 @@ information.
 
 @code{.sh}
 magnum-distancefieldconverter [--magnum-...] [-h|--help] [--importer IMPORTER]
-    [--converter CONVERTER] [--plugin-dir DIR] --output-size "X Y" --radius N
-    [--] input output
+    [--converter CONVERTER] [--plugin-dir DIR] [--jump-flood] [--cpu]
+    [--threads N] --output-size "X Y" --radius N [--] input... output
 @endcode
 
 Arguments:
 
--   `input` --- input image
--   `output` --- output image
+-   `input` --- input image(s)
+-   `output` --- output image, or an output directory if more than one input
+    is specified
 -   `-h`, `--help` --- display help message and exit
 -   `--importer IMPORTER` --- image importer plugin (default:
     @ref Trade::AnyImageImporter "AnyImageImporter")
 -   `--converter CONVERTER` --- image converter plugin (default:
     @ref Trade::AnyImageConverter "AnyImageConverter")
 -   `--plugin-dir DIR` --- override base plugin dir
+-   `--jump-flood` --- use @ref TextureTools::DistanceFieldAlgorithm::JumpFlood
+    instead of the brute-force algorithm, which is significantly faster for
+    large radii. Not available on OpenGL ES 2.0 and WebGL 1.0.
+-   `--cpu` --- calculate the distance field on the CPU using
+    @ref TextureTools::euclideanDistanceFieldInto() instead. No GL context is
+    created in that case.
+-   `--threads N` --- count of threads to use for the CPU calculation, `0`
+    means all available (default: `0`)
 -   `--output-size "X Y"` --- size of output image
 -   `--radius N` --- distance field computation radius
 -   `--magnum-...` --- engine-specific options (see
@@ -113,6 +128,15 @@ Arguments:
 Images with @ref PixelFormat::R8Unorm, @ref PixelFormat::RGB8Unorm or
 @ref PixelFormat::RGBA8Unorm are accepted on input.
 
+If more than one input is specified, all of them are converted in a single
+run and the results are saved under the same filenames into the `output`
+directory. If all inputs have the same size and format and the brute-force
+algorithm is used, they're uploaded into layers of a texture array and
+converted using a single
+@ref TextureTools::DistanceField::operator()(GL::Texture2DArray&, GL::Texture2DArray&, const Range2Di&, const Vector3i&)
+call per batch, otherwise they're converted one by one, still sharing the
+GL context and the compiled shaders.
+
 The resulting image can be then used with @ref Shaders::DistanceFieldVector
 shader. See also @ref TextureTools::DistanceField for more information about
 the algorithm and parameters.
@@ -127,6 +151,13 @@ This will open monochrome `logo-src.png` image using any plugin that can open
 PNG files and converts it to 256x256 distance field `logo.png` using any plugin
 that can write PNG files.
 
+@code{.sh}
+magnum-distancefieldconverter --output-size "32 32" --radius 8 icons-src/*.png icons/
+@endcode
+
+This converts all PNG icons in the `icons-src/` directory into 32x32 distance
+fields with the same names in the `icons/` directory.
+
 @note This executable is available only if Magnum is compiled with
     @ref MAGNUM_TARGET_GL enabled (done by default). See @ref building-features
     for more information.
@@ -134,6 +165,20 @@ that can write PNG files.
 
 namespace TextureTools {
 
+namespace {
+
+GL::TextureFormat textureFormat(const PixelFormat format) {
+    if(format == PixelFormat::R8Unorm)
+        return GL::TextureFormat::R8;
+    if(format == PixelFormat::RGB8Unorm)
+        return GL::TextureFormat::RGB8;
+    if(format == PixelFormat::RGBA8Unorm)
+        return GL::TextureFormat::RGBA8;
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
 class DistanceFieldConverter: public Platform::WindowlessApplication {
     public:
         explicit DistanceFieldConverter(const Arguments& arguments);
@@ -145,18 +190,24 @@ class DistanceFieldConverter: public Platform::WindowlessApplication {
 };
 
 DistanceFieldConverter::DistanceFieldConverter(const Arguments& arguments): Platform::WindowlessApplication{arguments, NoCreate} {
-    args.addArgument("input").setHelp("input", "input image")
-        .addArgument("output").setHelp("output", "output image")
+    args.addArrayArgument("input").setHelp("input", "input image(s)")
+        .addArgument("output").setHelp("output", "output image, or a directory if more than one input is specified")
         .addOption("importer", "AnyImageImporter").setHelp("importer", "image importer plugin")
         .addOption("converter", "AnyImageConverter").setHelp("converter", "image converter plugin")
         .addOption("plugin-dir").setHelp("plugin-dir", "override base plugin dir", "DIR")
+        #ifndef MAGNUM_TARGET_GLES2
+        .addBooleanOption("jump-flood").setHelp("jump-flood", "use the jump flooding algorithm")
+        #endif
+        .addBooleanOption("cpu").setHelp("cpu", "calculate the distance field on the CPU")
+        .addOption("threads", "0").setHelp("threads", "count of threads to use for the CPU calculation", "N")
         .addNamedArgument("output-size").setHelp("output-size", "size of output image", "\"X Y\"")
         .addNamedArgument("radius").setHelp("radius", "distance field computation radius", "N")
         .addSkippedPrefix("magnum", "engine-specific options")
         .setGlobalHelp("Converts red channel of an image to distance field representation.")
         .parse(arguments.argc, arguments.argv);
 
-    createContext();
+    /* The CPU implementation doesn't need any GL context */
+    if(!args.isSet("cpu")) createContext();
 }
 
 int DistanceFieldConverter::exec() {
@@ -174,50 +225,144 @@ int DistanceFieldConverter::exec() {
     Containers::Pointer<Trade::AbstractImageConverter> converter = converterManager.loadAndInstantiate(args.value("converter"));
     if(!converter) return 2;
 
-    /* Open input file */
-    Containers::Optional<Trade::ImageData2D> image;
-    if(!importer->openFile(args.value("input")) || !(image = importer->image2D(0))) {
-        Error() << "Cannot open file" << args.value("input");
-        return 3;
+    /* Open input files */
+    const std::size_t inputCount = args.arrayValueCount("input");
+    Containers::Array<Trade::ImageData2D> images;
+    arrayReserve(images, inputCount);
+    for(std::size_t i = 0; i != inputCount; ++i) {
+        const std::string input = args.arrayValue("input", i);
+        Containers::Optional<Trade::ImageData2D> image;
+        if(!importer->openFile(input) || !(image = importer->image2D(0))) {
+            Error() << "Cannot open file" << input;
+            return 3;
+        }
+
+        if(image->format() != PixelFormat::R8Unorm &&
+           image->format() != PixelFormat::RGB8Unorm &&
+           image->format() != PixelFormat::RGBA8Unorm) {
+            Error() << "Unsupported image format" << image->format();
+            return 4;
+        }
+
+        arrayAppend(images, std::move(*image));
+    }
+
+    /* With a single input the output is a file, otherwise a directory with
+       the same filenames as the inputs */
+    auto outputFilename = [&](std::size_t i) {
+        return inputCount == 1 ? args.value("output") :
+            Utility::Directory::join(args.value("output"), Utility::Directory::filename(args.arrayValue("input", i)));
+    };
+    if(inputCount > 1 && !Utility::Directory::mkpath(args.value("output"))) {
+        Error() << "Cannot create output directory" << args.value("output");
+        return 5;
     }
 
-    /* Decide about internal format */
-    GL::TextureFormat internalFormat;
-    if(image->format() == PixelFormat::R8Unorm)
-        internalFormat = GL::TextureFormat::R8;
-    else if(image->format() == PixelFormat::RGB8Unorm)
-        internalFormat = GL::TextureFormat::RGB8;
-    else if(image->format() == PixelFormat::RGBA8Unorm)
-        internalFormat = GL::TextureFormat::RGBA8;
-    else {
-        Error() << "Unsupported image format" << image->format();
-        return 4;
+    const Vector2i outputSize = args.value<Vector2i>("output-size");
+    const UnsignedInt radius = args.value<UnsignedInt>("radius");
+
+    /* Calculate on the CPU, if requested */
+    if(args.isSet("cpu")) {
+        for(std::size_t i = 0; i != images.size(); ++i) {
+            Debug() << "Converting image of size" << images[i].size() << "to distance field on the CPU...";
+            Image2D result = TextureTools::euclideanDistanceField(images[i], outputSize, radius, args.value<UnsignedInt>("threads"));
+            if(!converter->exportToFile(result, outputFilename(i))) {
+                Error() << "Cannot save file" << outputFilename(i);
+                return 5;
+            }
+        }
+
+        return 0;
     }
 
-    /* Input texture */
-    GL::Texture2D input;
-    input.setMinificationFilter(SamplerFilter::Linear)
-        .setMagnificationFilter(SamplerFilter::Linear)
-        .setWrapping(SamplerWrapping::ClampToEdge)
-        .setStorage(1, internalFormat, image->size())
-        .setSubImage(0, {}, *image);
-
-    /* Output texture */
-    GL::Texture2D output;
-    output.setStorage(1, GL::TextureFormat::R8, args.value<Vector2i>("output-size"));
-
-    CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
-
-    /* Do it */
-    Debug() << "Converting image of size" << image->size() << "to distance field...";
-    TextureTools::DistanceField{args.value<UnsignedInt>("radius")}(input, output, {{}, args.value<Vector2i>("output-size")}, image->size());
-
-    /* Save image */
-    Image2D result{PixelFormat::R8Unorm};
-    output.image(0, result);
-    if(!converter->exportToFile(result, args.value("output"))) {
-        Error() << "Cannot save file" << args.value("output");
-        return 5;
+    /* Created just once for all images */
+    TextureTools::DistanceFieldAlgorithm algorithm = TextureTools::DistanceFieldAlgorithm::BruteForce;
+    #ifndef MAGNUM_TARGET_GLES2
+    if(args.isSet("jump-flood"))
+        algorithm = TextureTools::DistanceFieldAlgorithm::JumpFlood;
+    #endif
+    TextureTools::DistanceField distanceField{radius, algorithm};
+
+    #ifndef MAGNUM_TARGET_GLES2
+    /* If there's more than one image and all have the same size and format,
+       convert them in batches of texture array layers */
+    bool batch = images.size() > 1 && algorithm == TextureTools::DistanceFieldAlgorithm::BruteForce;
+    for(std::size_t i = 1; batch && i != images.size(); ++i)
+        if(images[i].size() != images[0].size() || images[i].format() != images[0].format())
+            batch = false;
+
+    if(batch) {
+        const GL::TextureFormat internalFormat = textureFormat(images[0].format());
+        const std::size_t maxLayerCount = GL::Texture2DArray::maxSize().z();
+
+        for(std::size_t offset = 0; offset < images.size(); offset += maxLayerCount) {
+            const Int layerCount = Math::min(images.size() - offset, maxLayerCount);
+
+            /* Input texture array */
+            GL::Texture2DArray input;
+            input.setMinificationFilter(SamplerFilter::Linear)
+                .setMagnificationFilter(SamplerFilter::Linear)
+                .setWrapping(SamplerWrapping::ClampToEdge)
+                .setStorage(1, internalFormat, {images[0].size(), layerCount});
+            for(Int i = 0; i != layerCount; ++i) {
+                const Trade::ImageData2D& image = images[offset + i];
+                input.setSubImage(0, {0, 0, i}, ImageView3D{image.storage(), image.format(), {image.size(), 1}, image.data()});
+            }
+
+            /* Output texture array */
+            GL::Texture2DArray output;
+            output.setStorage(1, GL::TextureFormat::R8, {outputSize, layerCount});
+
+            CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
+
+            /* Do it */
+            Debug() << "Converting" << layerCount << "images of size" << images[0].size() << "to distance field...";
+            distanceField(input, output, {{}, outputSize}, {images[0].size(), layerCount});
+
+            /* Save images */
+            Image3D result = output.image(0, {PixelFormat::R8Unorm});
+            const std::size_t layerSize = result.data().size()/layerCount;
+            for(Int i = 0; i != layerCount; ++i) {
+                const ImageView2D layer{result.storage(), result.format(), outputSize, result.data().slice(i*layerSize, (i + 1)*layerSize)};
+                if(!converter->exportToFile(layer, outputFilename(offset + i))) {
+                    Error() << "Cannot save file" << outputFilename(offset + i);
+                    return 5;
+                }
+            }
+        }
+
+        return 0;
+    }
+    #endif
+
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        const Trade::ImageData2D& image = images[i];
+
+        /* Input texture */
+        GL::Texture2D input;
+        input.setMinificationFilter(SamplerFilter::Linear)
+            .setMagnificationFilter(SamplerFilter::Linear)
+            .setWrapping(SamplerWrapping::ClampToEdge)
+            .setStorage(1, textureFormat(image.format()), image.size())
+            .setSubImage(0, {}, image);
+
+        /* Output texture */
+        GL::Texture2D output;
+        output.setStorage(1, GL::TextureFormat::R8, outputSize);
+
+        CORRADE_INTERNAL_ASSERT(GL::Renderer::error() == GL::Renderer::Error::NoError);
+
+        /* Do it */
+        Debug() << "Converting image of size" << image.size() << "to distance field...";
+        distanceField(input, output, {{}, outputSize}, image.size());
+
+        /* Save image */
+        Image2D result{PixelFormat::R8Unorm};
+        output.image(0, result);
+        if(!converter->exportToFile(result, outputFilename(i))) {
+            Error() << "Cannot save file" << outputFilename(i);
+            return 5;
+        }
     }
 
     return 0;
@@ -25,6 +25,7 @@
 
 #include "Timeline.h"
 
+#include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/Debug.h>
 #include <Corrade/Utility/System.h>
 
@@ -39,6 +40,8 @@ void Timeline::start() {
     _startTime = high_resolution_clock::now();
     _previousFrameTime = _startTime;
     _previousFrameDuration = 0;
+    _fixedTimestepAccumulator = 0;
+    _fixedStepCount = 0;
 }
 
 void Timeline::stop() {
@@ -46,6 +49,8 @@ void Timeline::stop() {
     _startTime = high_resolution_clock::time_point();
     _previousFrameTime = _startTime;
     _previousFrameDuration = 0;
+    _fixedTimestepAccumulator = 0;
+    _fixedStepCount = 0;
 }
 
 void Timeline::nextFrame() {
@@ -55,6 +60,33 @@ void Timeline::nextFrame() {
     auto duration = UnsignedInt(duration_cast<microseconds>(now-_previousFrameTime).count());
     _previousFrameDuration = duration/1e6f;
     _previousFrameTime = now;
+
+    if(_fixedTimestep) {
+        _fixedTimestepAccumulator += _previousFrameDuration;
+        _fixedStepCount = UnsignedInt(_fixedTimestepAccumulator/_fixedTimestep);
+
+        /* If the frame took too long, drop the time that can't be caught up
+           with instead of accumulating it forever */
+        if(_fixedStepCount > _maxFixedStepCount) {
+            _fixedStepCount = _maxFixedStepCount;
+            _fixedTimestepAccumulator = 0;
+        } else _fixedTimestepAccumulator -= _fixedStepCount*_fixedTimestep;
+    }
+}
+
+void Timeline::setFixedTimestep(const Float duration, const UnsignedInt maxStepCount) {
+    CORRADE_ASSERT(duration >= 0.0f,
+        "Timeline::setFixedTimestep(): expected non-negative duration, got" << duration, );
+    CORRADE_ASSERT(maxStepCount,
+        "Timeline::setFixedTimestep(): max step count can't be zero", );
+    _fixedTimestep = duration;
+    _maxFixedStepCount = maxStepCount;
+    _fixedTimestepAccumulator = 0;
+    _fixedStepCount = 0;
+}
+
+Float Timeline::fixedStepInterpolation() const {
+    return _fixedTimestep ? _fixedTimestepAccumulator/_fixedTimestep : 0.0f;
 }
 
 Float Timeline::previousFrameTime() const {
@@ -85,6 +85,36 @@ void MyApplication::drawEvent() {
     timeline.nextFrame();
 }
 @endcode
+
+@section Timeline-fixed-timestep Fixed timestep updates
+
+Physics and gameplay logic is often more stable when advanced in steps of a
+constant duration, independently of the rendering framerate. Set the step
+duration using @ref setFixedTimestep() and then, in each frame, run the update
+@ref fixedStepCount() times. Because the accumulated time is generally not a
+multiple of the step duration, use @ref fixedStepInterpolation() to
+interpolate between the last two simulated states for rendering:
+
+@code{.cpp}
+timeline.setFixedTimestep(1.0f/120.0f);
+
+// ...
+
+void MyApplication::drawEvent() {
+    for(UnsignedInt i = 0; i != timeline.fixedStepCount(); ++i)
+        updatePhysics(timeline.fixedTimestep());
+
+    // Draw with the state interpolated by timeline.fixedStepInterpolation()
+
+    swapBuffers();
+    redraw();
+    timeline.nextFrame();
+}
+@endcode
+
+If the frame took so long that more than the maximal step count would be
+needed to catch up, the excess time is dropped to avoid the application
+getting progressively slower.
 */
 class MAGNUM_EXPORT Timeline {
     public:
@@ -94,7 +124,7 @@ class MAGNUM_EXPORT Timeline {
          * Creates stopped timeline.
          * @see @ref start()
          */
-        explicit Timeline(): _previousFrameDuration(0), running(false) {}
+        explicit Timeline(): _previousFrameDuration(0), _fixedTimestep{}, _fixedTimestepAccumulator{}, _maxFixedStepCount{}, _fixedStepCount{}, running(false) {}
 
         /**
          * @brief Start timeline
@@ -134,10 +164,67 @@ class MAGNUM_EXPORT Timeline {
          */
         Float previousFrameDuration() const { return _previousFrameDuration; }
 
+        /**
+         * @brief Fixed timestep duration (in seconds)
+         * @m_since_latest
+         *
+         * If fixed timestep updates are disabled, returns @cpp 0.0f @ce.
+         * @see @ref setFixedTimestep()
+         */
+        Float fixedTimestep() const { return _fixedTimestep; }
+
+        /**
+         * @brief Set fixed timestep duration
+         * @param duration      Step duration in seconds. Set to
+         *      @cpp 0.0f @ce to disable fixed timestep updates.
+         * @param maxStepCount  Max count of steps done in a single frame
+         * @m_since_latest
+         *
+         * Resets the accumulated time. See
+         * @ref Timeline-fixed-timestep for more information. Expects that
+         * @p duration is not negative and @p maxStepCount is not zero.
+         * @see @ref fixedStepCount(), @ref fixedStepInterpolation()
+         */
+        void setFixedTimestep(Float duration, UnsignedInt maxStepCount = 8);
+
+        /**
+         * @brief Max count of fixed timestep steps in a frame
+         * @m_since_latest
+         *
+         * @see @ref setFixedTimestep()
+         */
+        UnsignedInt maxFixedStepCount() const { return _maxFixedStepCount; }
+
+        /**
+         * @brief Count of fixed timestep steps to do in current frame
+         * @m_since_latest
+         *
+         * Calculated in @ref nextFrame() from the duration of previous frame
+         * and time left over from earlier frames, never larger than
+         * @ref maxFixedStepCount(). If the timeline is stopped or fixed
+         * timestep updates are disabled, returns @cpp 0 @ce.
+         * @see @ref setFixedTimestep()
+         */
+        UnsignedInt fixedStepCount() const { return _fixedStepCount; }
+
+        /**
+         * @brief Interpolation factor for fixed timestep updates
+         * @m_since_latest
+         *
+         * Time left over after doing @ref fixedStepCount() steps as a
+         * fraction of @ref fixedTimestep(), in range @f$ [0, 1) @f$. Use it
+         * to interpolate between the two last simulated states when
+         * rendering. If the timeline is stopped or fixed timestep updates
+         * are disabled, returns @cpp 0.0f @ce.
+         */
+        Float fixedStepInterpolation() const;
+
     private:
         std::chrono::high_resolution_clock::time_point _startTime;
         std::chrono::high_resolution_clock::time_point _previousFrameTime;
         Float _previousFrameDuration;
+        Float _fixedTimestep, _fixedTimestepAccumulator;
+        UnsignedInt _maxFixedStepCount, _fixedStepCount;
 
         bool running;
 };
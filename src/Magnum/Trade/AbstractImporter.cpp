@@ -25,9 +25,15 @@
 
 #include "AbstractImporter.h"
 
+#include <algorithm>
+#include <chrono>
+#include <new>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
@@ -35,6 +41,7 @@
 #include "Magnum/FileCallback.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
+#include "Magnum/Trade/ArrayArena.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
@@ -115,6 +122,100 @@ void AbstractImporter::setFileCallback(Containers::Optional<Containers::ArrayVie
 
 void AbstractImporter::doSetFileCallback(Containers::Optional<Containers::ArrayView<const char>>(*)(const std::string&, InputFileCallbackPolicy, void*), void*) {}
 
+void AbstractImporter::setProfileCallback(void(*callback)(ImporterProfileStage, UnsignedLong, std::size_t, void*), void* const userData) {
+    _profileCallback = callback;
+    _profileCallbackUserData = userData;
+}
+
+void AbstractImporter::setArrayArena(ArrayArena* const arena) {
+    _arrayArena = arena;
+}
+
+void AbstractImporter::copyIntoArena(MeshData& mesh) {
+    if(!(mesh.vertexDataFlags() & DataFlag::Owned) || (mesh.isIndexed() && !(mesh.indexDataFlags() & DataFlag::Owned)))
+        return;
+
+    Containers::Array<char> vertexData = _arrayArena->allocate(mesh.vertexData().size());
+    Utility::copy(mesh.vertexData(), vertexData);
+
+    /* Re-route the attributes to the new vertex data */
+    Containers::Array<MeshAttributeData> attributes = _arrayArena->allocate<MeshAttributeData>(mesh.attributeCount());
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        const MeshAttributeData& attribute = mesh.attributeData()[i];
+        new(&attributes[i]) MeshAttributeData{attribute.name(),
+            attribute.format(),
+            Containers::StridedArrayView1D<const void>{vertexData,
+                vertexData.data() + attribute.offset(mesh.vertexData()),
+                mesh.vertexCount(), attribute.stride()},
+            attribute.arraySize(), attribute.morphTargetId()};
+    }
+
+    if(mesh.isIndexed()) {
+        Containers::Array<char> indexData = _arrayArena->allocate(mesh.indexData().size());
+        Utility::copy(mesh.indexData(), indexData);
+        const MeshIndexData indices{mesh.indexType(), indexData.slice(
+            mesh.indexOffset(),
+            mesh.indexOffset() + mesh.indexCount()*meshIndexTypeSize(mesh.indexType()))};
+        mesh = MeshData{mesh.primitive(),
+            std::move(indexData), indices,
+            std::move(vertexData), std::move(attributes), mesh.vertexCount(),
+            mesh.importerState()};
+    } else mesh = MeshData{mesh.primitive(),
+        std::move(vertexData), std::move(attributes), mesh.vertexCount(),
+        mesh.importerState()};
+}
+
+template<UnsignedInt dimensions> void AbstractImporter::copyIntoArena(ImageData<dimensions>& image) {
+    if(!(image.dataFlags() & DataFlag::Owned)) return;
+
+    /* Only the data array is replaced, everything else stays */
+    Containers::Array<char> data = _arrayArena->allocate(image._data.size());
+    Utility::copy(image._data, data);
+    image._data = std::move(data);
+}
+
+void AbstractImporter::copyIntoArena(MaterialData& material) {
+    /* The attributes contain all values inline, so they can be copied
+       directly. Layer offsets are optional. */
+    if(material._data.deleter() == reinterpret_cast<void(*)(MaterialAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter) ||
+       material._layerOffsets.deleter() == reinterpret_cast<void(*)(UnsignedInt*, std::size_t)>(Implementation::nonOwnedArrayDeleter))
+        return;
+
+    Containers::Array<MaterialAttributeData> data = _arrayArena->allocate<MaterialAttributeData>(material._data.size());
+    Utility::copy(material._data, data);
+    material._data = std::move(data);
+
+    if(material._layerOffsets) {
+        Containers::Array<UnsignedInt> layerOffsets = _arrayArena->allocate<UnsignedInt>(material._layerOffsets.size());
+        Utility::copy(material._layerOffsets, layerOffsets);
+        material._layerOffsets = std::move(layerOffsets);
+    }
+}
+
+namespace {
+
+/* Reports time elapsed between construction and destruction to the profiling
+   callback, if there's any */
+struct ProfileScope {
+    explicit ProfileScope(void(*callback)(ImporterProfileStage, UnsignedLong, std::size_t, void*), void* userData, ImporterProfileStage stage): _callback{callback}, _userData{userData}, _stage{stage} {
+        if(_callback) _begin = std::chrono::high_resolution_clock::now();
+    }
+
+    ~ProfileScope() {
+        if(_callback) _callback(_stage, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count(), byteCount, _userData);
+    }
+
+    std::size_t byteCount{};
+
+    private:
+        void(*_callback)(ImporterProfileStage, UnsignedLong, std::size_t, void*);
+        void* _userData;
+        ImporterProfileStage _stage;
+        std::chrono::high_resolution_clock::time_point _begin;
+};
+
+}
+
 bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
     CORRADE_ASSERT(features() & ImporterFeature::OpenData,
         "Trade::AbstractImporter::openData(): feature not supported", {});
@@ -123,10 +224,17 @@ bool AbstractImporter::openData(Containers::ArrayView<const char> data) {
        the check doesn't be done on the plugin side) because for some file
        formats it could be valid (e.g. OBJ or JSON-based formats). */
     close();
-    doOpenData(data);
+    callOpenData(data);
     return isOpened();
 }
 
+void AbstractImporter::callOpenData(const Containers::ArrayView<const char> data) {
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::OpenData};
+    profile.byteCount = data.size();
+    _profileOpenedDataSize += data.size();
+    doOpenData(data);
+}
+
 void AbstractImporter::doOpenData(Containers::ArrayView<const char>) {
     CORRADE_ASSERT_UNREACHABLE("Trade::AbstractImporter::openData(): feature advertised but not implemented", );
 }
@@ -147,6 +255,9 @@ void AbstractImporter::doOpenState(const void*, const std::string&) {
 bool AbstractImporter::openFile(const std::string& filename) {
     close();
 
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::OpenFile};
+    _profileOpenedDataSize = 0;
+
     /* If file loading callbacks are not set or the importer supports handling
        them directly, call into the implementation */
     if(!_fileCallback || (doFeatures() & ImporterFeature::FileCallback)) {
@@ -156,7 +267,7 @@ bool AbstractImporter::openFile(const std::string& filename) {
        the data through to openData(). Mark the file as ready to be closed once
        opening is finished. */
     } else if(doFeatures() & ImporterFeature::OpenData) {
-        /* This needs to be duplicated here and in the doOpenFile()
+        /* This needs to be called both here and in the doOpenFile()
            implementation in order to support both following cases:
             - plugins that don't support FileCallback but have their own
               doOpenFile() implementation (callback needs to be used here,
@@ -166,17 +277,12 @@ bool AbstractImporter::openFile(const std::string& filename) {
               file loading to the default implementation (callback used in the
               base doOpenFile() implementation, because this branch is never
               taken in that case) */
-        const Containers::Optional<Containers::ArrayView<const char>> data = _fileCallback(filename, InputFileCallbackPolicy::LoadTemporary, _fileCallbackUserData);
-        if(!data) {
-            Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
-            return isOpened();
-        }
-        doOpenData(*data);
-        _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
+        openDataThroughFileCallback(filename);
 
     /* Shouldn't get here, the assert is fired already in setFileCallback() */
     } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
+    profile.byteCount = _profileOpenedDataSize;
     return isOpened();
 }
 
@@ -186,13 +292,7 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
     /* If callbacks are set, use them. This is the same implementation as in
        openFile(), see the comment there for details. */
     if(_fileCallback) {
-        const Containers::Optional<Containers::ArrayView<const char>> data = _fileCallback(filename, InputFileCallbackPolicy::LoadTemporary, _fileCallbackUserData);
-        if(!data) {
-            Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
-            return;
-        }
-        doOpenData(*data);
-        _fileCallback(filename, InputFileCallbackPolicy::Close, _fileCallbackUserData);
+        openDataThroughFileCallback(filename);
 
     /* Otherwise open the file directly */
     } else {
@@ -201,10 +301,49 @@ void AbstractImporter::doOpenFile(const std::string& filename) {
             return;
         }
 
-        doOpenData(Utility::Directory::read(filename));
+        doOpenDataTemporary(Utility::Directory::read(filename));
     }
 }
 
+void AbstractImporter::doOpenDataTemporary(const Containers::ArrayView<const char> data) {
+    /* The data are alive only while opening, so the importer has to copy
+       them even if ImporterFlag::ZeroCopy is set */
+    const ImporterFlags flags = _flags;
+    _flags &= ~ImporterFlag::ZeroCopy;
+    callOpenData(data);
+    _flags = flags;
+}
+
+Containers::Optional<Containers::ArrayView<const char>> AbstractImporter::callFileCallback(const std::string& filename, const InputFileCallbackPolicy policy) {
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::FileCallback};
+    Containers::Optional<Containers::ArrayView<const char>> data = _fileCallback(filename, policy, _fileCallbackUserData);
+    if(data) profile.byteCount = data->size();
+    return data;
+}
+
+void AbstractImporter::openDataThroughFileCallback(const std::string& filename) {
+    /* With ImporterFlag::ZeroCopy the callback is expected to keep the memory
+       alive for as long as the imported data are used, so the file is loaded
+       permanently, never closed and the importer can reference it */
+    if(_flags & ImporterFlag::ZeroCopy) {
+        const Containers::Optional<Containers::ArrayView<const char>> data = callFileCallback(filename, InputFileCallbackPolicy::LoadPermanent);
+        if(!data) {
+            Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
+            return;
+        }
+        callOpenData(*data);
+        return;
+    }
+
+    const Containers::Optional<Containers::ArrayView<const char>> data = callFileCallback(filename, InputFileCallbackPolicy::LoadTemporary);
+    if(!data) {
+        Error() << "Trade::AbstractImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    doOpenDataTemporary(*data);
+    callFileCallback(filename, InputFileCallbackPolicy::Close);
+}
+
 void AbstractImporter::close() {
     if(isOpened()) {
         doClose();
@@ -244,7 +383,12 @@ std::string AbstractImporter::doSceneName(UnsignedInt) { return {}; }
 Containers::Optional<SceneData> AbstractImporter::scene(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::scene(): no file opened", {});
     CORRADE_ASSERT(id < doSceneCount(), "Trade::AbstractImporter::scene(): index" << id << "out of range for" << doSceneCount() << "entries", {});
-    return doScene(id);
+    Containers::Optional<SceneData> scene = doScene(id);
+    CORRADE_ASSERT(!scene || (
+        (!scene->_data.deleter() || scene->_data.deleter() == Implementation::nonOwnedArrayDeleter || scene->_data.deleter() == ArrayAllocator<char>::deleter) &&
+        (!scene->_fields.deleter() || scene->_fields.deleter() == reinterpret_cast<void(*)(SceneFieldData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
+        "Trade::AbstractImporter::scene(): implementation is not allowed to use a custom Array deleter", {});
+    return scene;
 }
 
 Containers::Optional<SceneData> AbstractImporter::doScene(UnsignedInt) {
@@ -616,12 +760,15 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const UnsignedInt id, cons
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::mesh(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::Mesh};
     Containers::Optional<MeshData> mesh = doMesh(id, level);
+    if(mesh) profile.byteCount = mesh->indexData().size() + mesh->vertexData().size();
     CORRADE_ASSERT(!mesh || (
         (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == Implementation::nonOwnedArrayDeleter || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
         (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == Implementation::nonOwnedArrayDeleter || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter) &&
         (!mesh->_attributes.deleter() || mesh->_attributes.deleter() == reinterpret_cast<void(*)(MeshAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::mesh(): implementation is not allowed to use a custom Array deleter", {});
+    if(mesh && _arrayArena) copyIntoArena(*mesh);
     return mesh;
 }
 
@@ -639,6 +786,127 @@ Containers::Optional<MeshData> AbstractImporter::mesh(const std::string& name, c
     return mesh(id, level); /* not doMesh(), so we get the checks also */
 }
 
+Containers::Optional<MeshData> AbstractImporter::partialMesh(const UnsignedInt id, const UnsignedInt level, const Containers::ArrayView<const MeshAttribute> attributes, const UnsignedInt offset, const UnsignedInt count) {
+    CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::partialMesh(): no file opened", {});
+    CORRADE_ASSERT(id < doMeshCount(), "Trade::AbstractImporter::partialMesh(): index" << id << "out of range for" << doMeshCount() << "entries", {});
+    #ifndef CORRADE_NO_ASSERT
+    /* Same as in mesh() */
+    if(level) {
+        const UnsignedInt levelCount = doMeshLevelCount(id);
+        CORRADE_ASSERT(levelCount, "Trade::AbstractImporter::partialMesh(): implementation reported zero levels", {});
+        CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::partialMesh(): level" << level << "out of range for" << levelCount << "entries", {});
+    }
+    #endif
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::Mesh};
+    Containers::Optional<MeshData> mesh = doPartialMesh(id, level, attributes, offset, count);
+    if(mesh) profile.byteCount = mesh->indexData().size() + mesh->vertexData().size();
+    CORRADE_ASSERT(!mesh || (
+        (!mesh->_indexData.deleter() || mesh->_indexData.deleter() == Implementation::nonOwnedArrayDeleter || mesh->_indexData.deleter() == ArrayAllocator<char>::deleter) &&
+        (!mesh->_vertexData.deleter() || mesh->_vertexData.deleter() == Implementation::nonOwnedArrayDeleter || mesh->_vertexData.deleter() == ArrayAllocator<char>::deleter) &&
+        (!mesh->_attributes.deleter() || mesh->_attributes.deleter() == reinterpret_cast<void(*)(MeshAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
+        "Trade::AbstractImporter::partialMesh(): implementation is not allowed to use a custom Array deleter", {});
+    if(mesh && _arrayArena) copyIntoArena(*mesh);
+    return mesh;
+}
+
+Containers::Optional<MeshData> AbstractImporter::partialMesh(const UnsignedInt id, const UnsignedInt level, const std::initializer_list<MeshAttribute> attributes, const UnsignedInt offset, const UnsignedInt count) {
+    return partialMesh(id, level, Containers::arrayView(attributes), offset, count);
+}
+
+namespace {
+
+template<class T> void rebaseIndicesInto(const Containers::ArrayView<const UnsignedInt> indices, const UnsignedInt base, const Containers::ArrayView<char> destination) {
+    const Containers::ArrayView<T> out = Containers::arrayCast<T>(destination);
+    for(std::size_t i = 0; i != indices.size(); ++i)
+        out[i] = T(indices[i] - base);
+}
+
+}
+
+Containers::Optional<MeshData> AbstractImporter::doPartialMesh(const UnsignedInt id, const UnsignedInt level, const Containers::ArrayView<const MeshAttribute> attributes, const UnsignedInt offset, const UnsignedInt count) {
+    Containers::Optional<MeshData> mesh = doMesh(id, level);
+    if(!mesh) return {};
+
+    /* The range is in indices for indexed meshes and in vertices otherwise */
+    const UnsignedInt elementCount = mesh->isIndexed() ? mesh->indexCount() : mesh->vertexCount();
+    if(offset > elementCount || (count != ~UnsignedInt{} && count > elementCount - offset)) {
+        Error e;
+        e << "Trade::AbstractImporter::partialMesh(): offset" << offset;
+        if(count != ~UnsignedInt{}) e << "and count" << count;
+        e << "out of range for" << elementCount << (mesh->isIndexed() ? "indices" : "vertices");
+        return {};
+    }
+    const UnsignedInt end = count == ~UnsignedInt{} ? elementCount : offset + count;
+
+    /* For indexed meshes take the index subset and trim the vertices to the
+       referenced range */
+    UnsignedInt vertexBegin = offset, vertexEnd = end;
+    Containers::Array<char> indexData;
+    MeshIndexData indices;
+    if(mesh->isIndexed()) {
+        const Containers::Array<UnsignedInt> allIndices = mesh->indicesAsArray();
+        const Containers::ArrayView<const UnsignedInt> subset = allIndices.slice(offset, end);
+        if(subset.empty()) vertexBegin = vertexEnd = 0;
+        else {
+            vertexBegin = *std::min_element(subset.begin(), subset.end());
+            vertexEnd = *std::max_element(subset.begin(), subset.end()) + 1;
+        }
+
+        const MeshIndexType type = mesh->indexType();
+        indexData = Containers::Array<char>{Containers::NoInit, subset.size()*meshIndexTypeSize(type)};
+        if(type == MeshIndexType::UnsignedByte)
+            rebaseIndicesInto<UnsignedByte>(subset, vertexBegin, indexData);
+        else if(type == MeshIndexType::UnsignedShort)
+            rebaseIndicesInto<UnsignedShort>(subset, vertexBegin, indexData);
+        else rebaseIndicesInto<UnsignedInt>(subset, vertexBegin, indexData);
+        indices = MeshIndexData{type, indexData};
+    }
+    const UnsignedInt vertexCount = vertexEnd - vertexBegin;
+
+    /* Pick the requested attributes and calculate the total vertex data
+       size */
+    Containers::Array<UnsignedInt> attributeIds;
+    std::size_t vertexDataSize = 0;
+    for(UnsignedInt i = 0; i != mesh->attributeCount(); ++i) {
+        if(!attributes.empty() && std::find(attributes.begin(), attributes.end(), mesh->attributeName(i)) == attributes.end())
+            continue;
+        arrayAppend(attributeIds, i);
+        vertexDataSize += mesh->attribute(i).size()[1]*vertexCount;
+    }
+
+    /* Copy each attribute into a tightly packed non-interleaved array */
+    Containers::Array<char> vertexData{Containers::NoInit, vertexDataSize};
+    Containers::Array<MeshAttributeData> attributeData{attributeIds.size()};
+    std::size_t attributeOffset = 0;
+    for(std::size_t i = 0; i != attributeIds.size(); ++i) {
+        const UnsignedInt attributeId = attributeIds[i];
+        const Containers::StridedArrayView2D<const char> src = mesh->attribute(attributeId).slice(vertexBegin, vertexEnd);
+        const std::size_t elementSize = src.size()[1];
+        const Containers::StridedArrayView2D<char> dst{
+            vertexData.slice(attributeOffset, attributeOffset + elementSize*vertexCount),
+            {vertexCount, elementSize}};
+        Utility::copy(src, dst);
+
+        attributeData[i] = MeshAttributeData{mesh->attributeName(attributeId),
+            mesh->attributeFormat(attributeId),
+            Containers::StridedArrayView1D<const void>{vertexData,
+                vertexData.data() + attributeOffset, vertexCount,
+                std::ptrdiff_t(elementSize)},
+            mesh->attributeArraySize(attributeId),
+            mesh->attributeMorphTargetId(attributeId)};
+        attributeOffset += elementSize*vertexCount;
+    }
+
+    if(mesh->isIndexed())
+        return MeshData{mesh->primitive(),
+            std::move(indexData), indices,
+            std::move(vertexData), std::move(attributeData), vertexCount,
+            mesh->importerState()};
+    return MeshData{mesh->primitive(),
+        std::move(vertexData), std::move(attributeData), vertexCount,
+        mesh->importerState()};
+}
+
 MeshAttribute AbstractImporter::meshAttributeForName(const std::string& name) {
     const MeshAttribute out = doMeshAttributeForName(name);
     CORRADE_ASSERT(out == MeshAttribute{} || isMeshAttributeCustom(out),
@@ -779,11 +1047,14 @@ AbstractImporter::material(const UnsignedInt id) {
     CORRADE_ASSERT(isOpened(), "Trade::AbstractImporter::material(): no file opened", {});
     CORRADE_ASSERT(id < doMaterialCount(), "Trade::AbstractImporter::material(): index" << id << "out of range for" << doMaterialCount() << "entries", {});
 
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::Material};
     Containers::Optional<MaterialData> material = doMaterial(id);
+    if(material) profile.byteCount = material->attributeData().size()*sizeof(MaterialAttributeData);
     CORRADE_ASSERT(!material || (
         (!material->_data.deleter() || material->_data.deleter() == reinterpret_cast<void(*)(MaterialAttributeData*, std::size_t)>(Implementation::nonOwnedArrayDeleter)) &&
         (!material->_layerOffsets.deleter() || material->_layerOffsets.deleter() == reinterpret_cast<void(*)(UnsignedInt*, std::size_t)>(Implementation::nonOwnedArrayDeleter))),
         "Trade::AbstractImporter::material(): implementation is not allowed to use a custom Array deleter", {});
+    if(material && _arrayArena) copyIntoArena(*material);
 
     /* GCC 4.8 and clang-cl needs an explicit conversion here */
     #ifdef MAGNUM_BUILD_DEPRECATED
@@ -903,6 +1174,7 @@ Containers::Optional<ImageData1D> AbstractImporter::image1D(const UnsignedInt id
     #endif
     Containers::Optional<ImageData1D> image = doImage1D(id, level);
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image1D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image && _arrayArena) copyIntoArena(*image);
     return image;
 }
 
@@ -968,8 +1240,11 @@ Containers::Optional<ImageData2D> AbstractImporter::image2D(const UnsignedInt id
         CORRADE_ASSERT(level < levelCount, "Trade::AbstractImporter::image2D(): level" << level << "out of range for" << levelCount << "entries", {});
     }
     #endif
+    ProfileScope profile{_profileCallback, _profileCallbackUserData, ImporterProfileStage::Image2D};
     Containers::Optional<ImageData2D> image = doImage2D(id, level);
+    if(image) profile.byteCount = image->data().size();
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image2D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image && _arrayArena) copyIntoArena(*image);
     return image;
 }
 
@@ -1037,6 +1312,7 @@ Containers::Optional<ImageData3D> AbstractImporter::image3D(const UnsignedInt id
     #endif
     Containers::Optional<ImageData3D> image = doImage3D(id, level);
     CORRADE_ASSERT(!image || !image->_data.deleter() || image->_data.deleter() == Implementation::nonOwnedArrayDeleter || image->_data.deleter() == ArrayAllocator<char>::deleter, "Trade::AbstractImporter::image3D(): implementation is not allowed to use a custom Array deleter", {});
+    if(image && _arrayArena) copyIntoArena(*image);
     return image;
 }
 
@@ -1071,6 +1347,7 @@ Debug& operator<<(Debug& debug, const ImporterFeature value) {
         _c(OpenData)
         _c(OpenState)
         _c(FileCallback)
+        _c(ConcurrentImport)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1082,7 +1359,8 @@ Debug& operator<<(Debug& debug, const ImporterFeatures value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFeatures{}", {
         ImporterFeature::OpenData,
         ImporterFeature::OpenState,
-        ImporterFeature::FileCallback});
+        ImporterFeature::FileCallback,
+        ImporterFeature::ConcurrentImport});
 }
 
 Debug& operator<<(Debug& debug, const ImporterFlag value) {
@@ -1092,6 +1370,27 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
         /* LCOV_EXCL_START */
         #define _c(v) case ImporterFlag::v: return debug << "::" #v;
         _c(Verbose)
+        _c(ZeroCopy)
+        _c(YFlip)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ImporterProfileStage value) {
+    debug << "Trade::ImporterProfileStage" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(v) case ImporterProfileStage::v: return debug << "::" #v;
+        _c(FileCallback)
+        _c(OpenData)
+        _c(OpenFile)
+        _c(Mesh)
+        _c(Image2D)
+        _c(Material)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -1101,7 +1400,9 @@ Debug& operator<<(Debug& debug, const ImporterFlag value) {
 
 Debug& operator<<(Debug& debug, const ImporterFlags value) {
     return Containers::enumSetDebugOutput(debug, value, "Trade::ImporterFlags{}", {
-        ImporterFlag::Verbose});
+        ImporterFlag::Verbose,
+        ImporterFlag::ZeroCopy,
+        ImporterFlag::YFlip});
 }
 
 }}
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::AbstractImporter, enum @ref Magnum::Trade::ImporterFeature, enum set @ref Magnum::Trade::ImporterFeatures
  */
 
+#include <initializer_list>
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
@@ -46,13 +47,28 @@ namespace Magnum { namespace Trade {
 @brief Features supported by an importer
 @m_since{2020,06}
 
+Apart from @ref ImporterFeature::ConcurrentImport, no importer functionality
+is thread-safe. Each feature below documents what it allows to be done
+concurrently, see also @ref Trade-AbstractImporter-usage-threads.
 @see @ref ImporterFeatures, @ref AbstractImporter::features()
 */
 enum class ImporterFeature: UnsignedByte {
-    /** Opening files from raw data using @ref AbstractImporter::openData() */
+    /**
+     * Opening files from raw data using @ref AbstractImporter::openData().
+     *
+     * Opening a file modifies the importer state and thus is never
+     * thread-safe --- no other function can be called on the same importer
+     * instance until it finishes.
+     */
     OpenData = 1 << 0,
 
-    /** Opening already loaded state using @ref AbstractImporter::openState() */
+    /**
+     * Opening already loaded state using @ref AbstractImporter::openState().
+     *
+     * Same as with @ref ImporterFeature::OpenData, opening is never
+     * thread-safe. Besides that, the external state is accessed by the
+     * importer without any synchronization.
+     */
     OpenState = 1 << 1,
 
     /**
@@ -63,8 +79,32 @@ enum class ImporterFeature: UnsignedByte {
      *
      * See @ref Trade-AbstractImporter-usage-callbacks and particular importer
      * documentation for more information.
+     *
+     * Setting a callback is never thread-safe. If the importer supports
+     * @ref ImporterFeature::ConcurrentImport as well, the callback may get
+     * called concurrently from multiple threads and thus has to be
+     * thread-safe too.
      */
-    FileCallback = 1 << 2
+    FileCallback = 1 << 2,
+
+    /**
+     * Importing data from an opened file concurrently from multiple threads.
+     * If supported, all functions querying data counts, names and IDs as
+     * well as the data import functions such as
+     * @ref AbstractImporter::mesh(), @ref AbstractImporter::image2D() or
+     * @ref AbstractImporter::material() can be called on the same importer
+     * instance from multiple threads at the same time. Opening and closing a
+     * file, setting flags or file callbacks and accessing the importer state
+     * is still not thread-safe, and the file has to stay opened until all
+     * concurrent calls finish. If not supported, calls to a single importer
+     * instance have to be serialized, calling different instances from
+     * different threads is always fine.
+     *
+     * See @ref Trade-AbstractImporter-usage-threads and @ref AsyncImporter
+     * for more information.
+     * @m_since_latest
+     */
+    ConcurrentImport = 1 << 3
 };
 
 /**
@@ -104,7 +144,46 @@ enum class ImporterFlag: UnsignedByte {
      */
     Verbose = 1 << 0,
 
-    /** @todo Y flip for images, "I want to import just once, don't copy" ... */
+    /**
+     * Reference the data passed to @ref AbstractImporter::openData() instead
+     * of copying them. By setting this flag the caller guarantees that the
+     * memory stays in scope and unchanged for as long as the importer is
+     * opened *and* as long as any data returned from it are in use, for
+     * example when the memory is a mapped file. Importers that support it
+     * may then return @ref MeshData, @ref ImageData and other data
+     * referencing the memory directly, with
+     * @ref ImageData::dataFlags() "dataFlags()",
+     * @ref MeshData::indexDataFlags() "indexDataFlags()" and
+     * @ref MeshData::vertexDataFlags() "vertexDataFlags()" not having
+     * @ref DataFlag::Owned set. Data that need to be converted or decoded
+     * are still returned as owned copies, importers that don't support this
+     * flag ignore it.
+     *
+     * The flag has no effect for files opened with
+     * @ref AbstractImporter::openFile(), as the file contents are alive only
+     * while the file is being opened, except when a file callback is set ---
+     * see @ref AbstractImporter::setFileCallback() and
+     * @ref MappedFileCallback for details. See documentation of particular
+     * importers for information about whether the flag is supported.
+     * @m_since_latest
+     */
+    ZeroCopy = 1 << 1,
+
+    /**
+     * Flip imported images upside down, i.e. return them with the first row
+     * being the top one instead of the bottom one. Useful for APIs such as
+     * Vulkan that expect the top-down row order. Importers that support it
+     * perform the flip while decoding the data, avoiding an extra pass, and
+     * always return an owned copy with @ref ImageData::dataFlags()
+     * "dataFlags()" containing @ref DataFlag::Mutable. Compressed images
+     * and importers that don't support this flag ignore it, for those the
+     * images can be flipped afterwards using
+     * @ref TextureTools::flipImageYInPlace(). See documentation of
+     * particular importers for information about whether the flag is
+     * supported.
+     * @m_since_latest
+     */
+    YFlip = 1 << 2
 };
 
 /**
@@ -129,6 +208,63 @@ MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, ImporterFlag value);
 */
 MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, ImporterFlags value);
 
+/**
+@brief Importer profiling stage
+@m_since_latest
+
+@see @ref AbstractImporter::setProfileCallback()
+*/
+enum class ImporterProfileStage: UnsignedByte {
+    /* Zero used for an invalid value */
+
+    /**
+     * Call to the file callback made by @ref AbstractImporter::openFile().
+     * The byte count is the size of the loaded data, @cpp 0 @ce if loading
+     * failed or if the file was being closed.
+     */
+    FileCallback = 1,
+
+    /**
+     * Opening data, either directly with @ref AbstractImporter::openData() or
+     * as a part of @ref AbstractImporter::openFile(). The byte count is the
+     * size of the data.
+     */
+    OpenData,
+
+    /**
+     * Opening a file with @ref AbstractImporter::openFile(). The byte count
+     * is the size of the file contents passed to the importer, or
+     * @cpp 0 @ce if the importer read the file on its own.
+     */
+    OpenFile,
+
+    /**
+     * Importing a mesh with @ref AbstractImporter::mesh() or
+     * @ref AbstractImporter::partialMesh(). The byte count is the size of
+     * the index and vertex data, @cpp 0 @ce if the import failed.
+     */
+    Mesh,
+
+    /**
+     * Importing a 2D image with @ref AbstractImporter::image2D(). The byte
+     * count is the size of the image data, @cpp 0 @ce if the import failed.
+     */
+    Image2D,
+
+    /**
+     * Importing a material with @ref AbstractImporter::material(). The byte
+     * count is the size of the attribute data, @cpp 0 @ce if the import
+     * failed.
+     */
+    Material
+};
+
+/**
+@debugoperatorenum{ImporterProfileStage}
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, ImporterProfileStage value);
+
 #if defined(MAGNUM_BUILD_DEPRECATED) && !defined(DOXYGEN_GENERATING_OUTPUT)
 /* Could be a concrete type as only MaterialData need this, but that would
    mean I'd need to include MaterialData here */
@@ -195,10 +331,62 @@ loaded data through to @ref openData(), in case the importer supports at least
 @ref ImporterFeature::FileCallback nor @ref ImporterFeature::OpenData,
 @ref setFileCallback() doesn't allow the callbacks to be set.
 
+Instead of mapping the files manually like above, you can use the builtin
+@ref MappedFileCallback, which keeps the files mapped for its whole lifetime.
+If @ref ImporterFlag::ZeroCopy is set as well, the base @ref openFile()
+implementation loads the file with @ref InputFileCallbackPolicy::LoadPermanent
+and doesn't close it afterwards. The importer can then reference the mapped
+memory directly instead of copying it, which means only the parts of the file
+that are actually imported get paged in:
+
+@snippet MagnumTrade.cpp MappedFileCallback
+
 The input file callback signature is the same for @ref Trade::AbstractImporter,
 @ref ShaderTools::AbstractConverter and @ref Text::AbstractFont to allow code
 reuse.
 
+@subsection Trade-AbstractImporter-usage-threads Importing on multiple threads
+
+Unless the importer advertises @ref ImporterFeature::ConcurrentImport, a single
+instance can be used from only one thread at a time. Instead of wrapping the
+calls in a custom thread pool, use the @ref AsyncImporter, which schedules the
+data import on background threads and returns @ref std::future handles to be
+waited for. If the importer supports concurrent import, the work is spread
+across multiple threads, otherwise it's executed serially on a single
+background thread. In both cases the decoding can overlap with other work on
+the calling thread, such as GPU uploads:
+
+@snippet MagnumTrade.cpp AsyncImporter
+
+@subsection Trade-AbstractImporter-usage-profiling Profiling the import
+
+To find out where the time is spent when importing a file, set a profiling
+callback using @ref setProfileCallback(). It gets called after every file
+callback invocation, every file or data opening and every mesh, 2D image and
+material import with the @ref ImporterProfileStage, the duration in
+nanoseconds and count of bytes processed, allowing to distinguish slow file
+access from a slow parsing in the plugin itself. The file callback and data
+opening stages are nested in the file opening stage, so their durations are
+included in it.
+
+@snippet MagnumTrade.cpp AbstractImporter-setProfileCallback
+
+@subsection Trade-AbstractImporter-usage-arena Allocating imported data from an arena
+
+By default, every imported mesh, image and material is backed by its own
+heap allocations. When importing many small resources that share a common
+lifetime, such as all data of a game level, an @ref ArrayArena can be set with
+@ref setArrayArena(). Data of every subsequently imported @ref MeshData,
+@ref ImageData and @ref MaterialData are then copied into the arena, the
+temporary allocations made by the plugin are freed right away and all
+imported data are released together with @ref ArrayArena::release():
+
+@snippet MagnumTrade.cpp ArrayArena-usage
+
+Data that don't have the @ref DataFlag::Owned flag, for example
+@ref ImporterFlag::ZeroCopy views on the input file, are left untouched. The
+remaining data types are imported the usual way.
+
 @subsection Trade-AbstractImporter-usage-state Internal importer state
 
 Some importers, especially ones that make use of well-known external libraries,
@@ -273,6 +461,18 @@ functions, at least one of @ref doOpenData() / @ref doOpenFile() /
 @ref doOpenState() functions, function @ref doClose() and one or more tuples of
 data access functions, based on what features are supported in given format.
 
+In order to support @ref ImporterFlag::ZeroCopy, the @ref doOpenData()
+implementation should check for presence of the flag and if it's set,
+reference the passed memory instead of copying it. The flag should be checked
+only in @ref doOpenData() and the decision remembered for the data access
+functions --- in case @ref doOpenData() is called from the default
+@ref doOpenFile() implementation or with a @ref setFileCallback() "file callback"
+giving out temporary memory, the base implementation makes the flag appear
+unset for the duration of the call. Data referencing the memory can then be
+returned without @ref DataFlag::Owned, but keep in mind that they're not
+allowed to reference any internal importer state, as they're expected to
+outlive it.
+
 In order to support @ref ImporterFeature::FileCallback, the importer needs to
 properly use the callbacks to both load the top-level file in @ref doOpenFile()
 and also load any external files when needed. The @ref doOpenFile() can
@@ -287,6 +487,12 @@ want to import only some data. This is obviously not the case for single-data
 formats like images, as the file contains all the data the user wants to
 import.
 
+An importer should advertise @ref ImporterFeature::ConcurrentImport only if
+all its data access functions are safe to be called concurrently, which is
+usually the case if they only read the state prepared in @ref doOpenData() /
+@ref doOpenFile() and don't cache anything. Errors and other messages printed
+from different threads may interleave, but that's fine.
+
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
 
@@ -434,8 +640,13 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * implementation of that particular importer) and after that the
          * callback is called again with @ref InputFileCallbackPolicy::Close
          * because the semantics of @ref openData() don't require the data to
-         * be alive after. In case you need a different behavior, use
-         * @ref openData() directly.
+         * be alive after. If @ref ImporterFlag::ZeroCopy is set, the file is
+         * loaded with @ref InputFileCallbackPolicy::LoadPermanent instead
+         * and the callback is never asked to close it, as the imported data
+         * can reference it --- the callback is then expected to keep the
+         * memory alive for as long as the imported data are used, such as
+         * the @ref MappedFileCallback does. In case you need a different
+         * behavior, use @ref openData() directly.
          *
          * In case @p callback is @cpp nullptr @ce, the current callback (if
          * any) is reset. This function expects that the importer supports
@@ -483,6 +694,66 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         template<class Callback, class T> void setFileCallback(Callback callback, T& userData);
         #endif
 
+        /**
+         * @brief Profiling callback function
+         * @m_since_latest
+         *
+         * @see @ref Trade-AbstractImporter-usage-profiling
+         */
+        auto profileCallback() const -> void(*)(ImporterProfileStage, UnsignedLong, std::size_t, void*) { return _profileCallback; }
+
+        /**
+         * @brief Profiling callback user data
+         * @m_since_latest
+         *
+         * @see @ref Trade-AbstractImporter-usage-profiling
+         */
+        void* profileCallbackUserData() const { return _profileCallbackUserData; }
+
+        /**
+         * @brief Set profiling callback
+         * @m_since_latest
+         *
+         * The @p callback is called after each stage listed in
+         * @ref ImporterProfileStage finishes, with the duration of the stage
+         * in nanoseconds, the count of bytes processed and the @p userData
+         * pointer. The stages are measured only if a callback is set, in
+         * case @p callback is @cpp nullptr @ce, the current callback (if any)
+         * is reset. Only file callback invocations done by the base
+         * @ref openFile() implementation are measured, not the ones done by
+         * importers supporting @ref ImporterFeature::FileCallback directly.
+         *
+         * If the importer supports @ref ImporterFeature::ConcurrentImport and
+         * data are imported from multiple threads, the callback can be
+         * called from multiple threads at once as well.
+         * @see @ref Trade-AbstractImporter-usage-profiling
+         */
+        void setProfileCallback(void(*callback)(ImporterProfileStage, UnsignedLong, std::size_t, void*), void* userData = nullptr);
+
+        /**
+         * @brief Array arena
+         * @m_since_latest
+         *
+         * @see @ref Trade-AbstractImporter-usage-arena
+         */
+        ArrayArena* arrayArena() const { return _arrayArena; }
+
+        /**
+         * @brief Set an array arena
+         * @m_since_latest
+         *
+         * If set, data of meshes imported with @ref mesh() and
+         * @ref partialMesh(), images imported with @ref image1D(),
+         * @ref image2D() and @ref image3D() and materials imported with
+         * @ref material() are copied into @p arena. Imported data become
+         * inaccessible once the arena is released or destroyed. Pass
+         * @cpp nullptr @ce to use regular allocations again. The arena isn't
+         * owned by the importer and is expected to stay alive for as long as
+         * it's set.
+         * @see @ref Trade-AbstractImporter-usage-arena
+         */
+        void setArrayArena(ArrayArena* arena);
+
         /** @brief Whether any file is opened */
         bool isOpened() const { return doIsOpened(); }
 
@@ -492,7 +763,8 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          * Closes previous file, if it was opened, and tries to open given raw
          * data. Available only if @ref ImporterFeature::OpenData is supported.
          * Returns @cpp true @ce on success, @cpp false @ce otherwise. The
-         * @p data is not expected to be alive after the function exits.
+         * @p data is not expected to be alive after the function exits,
+         * unless @ref ImporterFlag::ZeroCopy is set.
          * @see @ref features(), @ref openFile()
          */
         bool openData(Containers::ArrayView<const char> data);
@@ -1002,6 +1274,44 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         Containers::Optional<MeshData> mesh(const std::string& name, UnsignedInt level = 0);
 
+        /**
+         * @brief Subset of a mesh
+         * @param id            Mesh ID, from range [0, @ref meshCount()).
+         * @param level         Mesh level, from range
+         *      [0, @ref meshLevelCount())
+         * @param attributes    Attributes to import. If empty, all
+         *      attributes are imported.
+         * @param offset        Offset of the first index or, if the mesh is
+         *      not indexed, the first vertex to import
+         * @param count         Count of indices or vertices to import. If
+         *      @cpp ~UnsignedInt{} @ce, everything after @p offset is
+         *      imported.
+         * @m_since_latest
+         *
+         * Compared to @ref mesh(UnsignedInt, UnsignedInt) returns only the
+         * attributes listed in @p attributes, with all their occurrences, and
+         * only the given range of indices or vertices. For an indexed mesh
+         * the vertex data is trimmed to the range of vertices referenced by
+         * the imported indices and the indices are adjusted relatively to the
+         * first referenced vertex. If the range is out of bounds for the
+         * mesh, prints an error message and returns
+         * @ref Containers::NullOpt.
+         *
+         * The returned mesh always owns its data. The attributes are stored
+         * non-interleaved, in the order in which they appear in the original
+         * mesh, and the index type is preserved. Importers that can access the
+         * data selectively implement this function directly, for the rest the
+         * whole mesh is imported first and then trimmed. Expects that a file
+         * is opened.
+         */
+        Containers::Optional<MeshData> partialMesh(UnsignedInt id, UnsignedInt level, Containers::ArrayView<const MeshAttribute> attributes, UnsignedInt offset = 0, UnsignedInt count = ~UnsignedInt{});
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        Containers::Optional<MeshData> partialMesh(UnsignedInt id, UnsignedInt level, std::initializer_list<MeshAttribute> attributes, UnsignedInt offset = 0, UnsignedInt count = ~UnsignedInt{});
+
         /**
          * @brief Mesh attribute for given name
          * @m_since{2020,06}
@@ -1764,6 +2074,16 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
          */
         virtual Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level);
 
+        /**
+         * @brief Implementation for @ref partialMesh()
+         * @m_since_latest
+         *
+         * The @p count is passed through unchanged, so it can be
+         * @cpp ~UnsignedInt{} @ce. Default implementation calls @ref doMesh()
+         * and copies the requested subset out of the returned data.
+         */
+        virtual Containers::Optional<MeshData> doPartialMesh(UnsignedInt id, UnsignedInt level, Containers::ArrayView<const MeshAttribute> attributes, UnsignedInt offset, UnsignedInt count);
+
         /**
          * @brief Implementation for @ref meshAttributeForName()
          * @m_since{2020,06}
@@ -2067,11 +2387,39 @@ class MAGNUM_TRADE_EXPORT AbstractImporter: public PluginManager::AbstractManagi
         /** @brief Implementation for @ref importerState() */
         virtual const void* doImporterState() const;
 
+        /* Calls doOpenData() with ImporterFlag::ZeroCopy temporarily masked
+           away, used for memory that's alive only while opening */
+        MAGNUM_TRADE_LOCAL void doOpenDataTemporary(Containers::ArrayView<const char> data);
+
+        /* Loads the file using the file callback and calls doOpenData() on
+           it, used by openFile() and doOpenFile() */
+        MAGNUM_TRADE_LOCAL void openDataThroughFileCallback(const std::string& filename);
+
+        /* Calls the file callback, measuring it if a profiling callback is
+           set */
+        MAGNUM_TRADE_LOCAL Containers::Optional<Containers::ArrayView<const char>> callFileCallback(const std::string& filename, InputFileCallbackPolicy policy);
+
+        /* Calls doOpenData(), measuring it if a profiling callback is set */
+        MAGNUM_TRADE_LOCAL void callOpenData(Containers::ArrayView<const char> data);
+
+        /* Copy owned data of imported resources into _arrayArena */
+        MAGNUM_TRADE_LOCAL void copyIntoArena(MeshData& mesh);
+        template<UnsignedInt dimensions> MAGNUM_TRADE_LOCAL void copyIntoArena(ImageData<dimensions>& image);
+        MAGNUM_TRADE_LOCAL void copyIntoArena(MaterialData& material);
+
         ImporterFlags _flags;
 
         Containers::Optional<Containers::ArrayView<const char>>(*_fileCallback)(const std::string&, InputFileCallbackPolicy, void*){};
         void* _fileCallbackUserData{};
 
+        void(*_profileCallback)(ImporterProfileStage, UnsignedLong, std::size_t, void*){};
+        void* _profileCallbackUserData{};
+        /* Size of data passed to doOpenData() during openFile(), reported
+           with ImporterProfileStage::OpenFile */
+        std::size_t _profileOpenedDataSize{};
+
+        ArrayArena* _arrayArena{};
+
         /* Used by the templated version only */
         struct FileCallbackTemplate {
             void(*callback)();
@@ -70,11 +70,34 @@ std::vector<std::string> AbstractSceneConverter::pluginSearchPaths() {
 }
 #endif
 
-AbstractSceneConverter::AbstractSceneConverter() = default;
+namespace {
 
-AbstractSceneConverter::AbstractSceneConverter(PluginManager::Manager<AbstractSceneConverter>& manager): PluginManager::AbstractManagingPlugin<AbstractSceneConverter>{manager} {}
+enum class Conversion: UnsignedByte {
+    None,
+    Data,
+    File
+};
 
-AbstractSceneConverter::AbstractSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractSceneConverter>{manager, plugin} {}
+}
+
+struct AbstractSceneConverter::State {
+    bool(*fileCallback)(const std::string&, Containers::ArrayView<const char>, void*){};
+    void* fileCallbackUserData{};
+
+    Conversion conversion{Conversion::None};
+    std::string filename;
+    UnsignedInt meshCount{};
+};
+
+AbstractSceneConverter::AbstractSceneConverter(): _state{Containers::InPlaceInit} {}
+
+AbstractSceneConverter::AbstractSceneConverter(PluginManager::Manager<AbstractSceneConverter>& manager): PluginManager::AbstractManagingPlugin<AbstractSceneConverter>{manager}, _state{Containers::InPlaceInit} {}
+
+AbstractSceneConverter::AbstractSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin): PluginManager::AbstractManagingPlugin<AbstractSceneConverter>{manager, plugin}, _state{Containers::InPlaceInit} {}
+
+/* Can't call doAbort() here as the derived class is already destroyed, the
+   implementation is expected to clean up after itself */
+AbstractSceneConverter::~AbstractSceneConverter() = default;
 
 SceneConverterFeatures AbstractSceneConverter::features() const {
     const SceneConverterFeatures features = doFeatures();
@@ -153,6 +176,163 @@ bool AbstractSceneConverter::doConvertToFile(const std::string& filename, const
     return true;
 }
 
+auto AbstractSceneConverter::fileCallback() const -> bool(*)(const std::string&, Containers::ArrayView<const char>, void*) {
+    return _state->fileCallback;
+}
+
+void* AbstractSceneConverter::fileCallbackUserData() const {
+    return _state->fileCallbackUserData;
+}
+
+void AbstractSceneConverter::setFileCallback(bool(*callback)(const std::string&, Containers::ArrayView<const char>, void*), void* const userData) {
+    CORRADE_ASSERT(_state->conversion == Conversion::None,
+        "Trade::AbstractSceneConverter::setFileCallback(): can't be set while a conversion is in progress", );
+
+    _state->fileCallback = callback;
+    _state->fileCallbackUserData = userData;
+}
+
+bool AbstractSceneConverter::isConverting() const {
+    return _state->conversion != Conversion::None;
+}
+
+void AbstractSceneConverter::abort() {
+    if(_state->conversion == Conversion::None) return;
+
+    doAbort();
+    _state->conversion = Conversion::None;
+    _state->filename = {};
+}
+
+void AbstractSceneConverter::doAbort() {}
+
+bool AbstractSceneConverter::beginData() {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertMultipleToData,
+        "Trade::AbstractSceneConverter::beginData(): multiple data conversion not supported", {});
+
+    abort();
+
+    _state->meshCount = 0;
+    if(!doBeginData()) return false;
+
+    _state->conversion = Conversion::Data;
+    return true;
+}
+
+bool AbstractSceneConverter::doBeginData() {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::beginData(): multiple data conversion advertised but not implemented", {});
+}
+
+Containers::Array<char> AbstractSceneConverter::endData() {
+    CORRADE_ASSERT(_state->conversion == Conversion::Data,
+        "Trade::AbstractSceneConverter::endData(): no data conversion in progress", {});
+
+    /* Reset the state before checking the deleter so the conversion is
+       finished even if the assertion is graceful */
+    Containers::Array<char> out = doEndData();
+    _state->conversion = Conversion::None;
+    CORRADE_ASSERT(!out || !out.deleter() || out.deleter() == Implementation::nonOwnedArrayDeleter || out.deleter() == ArrayAllocator<char>::deleter,
+        "Trade::AbstractSceneConverter::endData(): implementation is not allowed to use a custom Array deleter", {});
+    return out;
+}
+
+Containers::Array<char> AbstractSceneConverter::doEndData() {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::endData(): multiple data conversion advertised but not implemented", {});
+}
+
+bool AbstractSceneConverter::beginFile(const std::string& filename) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertMultipleToFile,
+        "Trade::AbstractSceneConverter::beginFile(): multiple data conversion not supported", {});
+
+    abort();
+
+    /* Create or truncate the file upfront so we fail early if it's not
+       writable and doAdd() / doEndFile() can then just append */
+    if(!_state->fileCallback && !Utility::Directory::write(filename, nullptr)) {
+        Error() << "Trade::AbstractSceneConverter::beginFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    /* The state has to be set already during doBeginFile() so it can call
+       writeFileData() */
+    _state->conversion = Conversion::File;
+    _state->filename = filename;
+    _state->meshCount = 0;
+    if(!doBeginFile(filename)) {
+        _state->conversion = Conversion::None;
+        _state->filename = {};
+        return false;
+    }
+
+    return true;
+}
+
+bool AbstractSceneConverter::doBeginFile(const std::string&) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertMultipleToData, "Trade::AbstractSceneConverter::beginFile(): multiple data conversion advertised but not implemented", false);
+
+    return doBeginData();
+}
+
+bool AbstractSceneConverter::endFile() {
+    CORRADE_ASSERT(_state->conversion == Conversion::File,
+        "Trade::AbstractSceneConverter::endFile(): no file conversion in progress", {});
+
+    const bool out = doEndFile(_state->filename);
+    _state->conversion = Conversion::None;
+    _state->filename = {};
+    return out;
+}
+
+bool AbstractSceneConverter::doEndFile(const std::string&) {
+    CORRADE_ASSERT(features() >= SceneConverterFeature::ConvertMultipleToData, "Trade::AbstractSceneConverter::endFile(): multiple data conversion advertised but not implemented", false);
+
+    const auto data = doEndData();
+    /* No deleter checks as it doesn't matter here */
+    if(!data) return false;
+
+    return writeFileData(data);
+}
+
+bool AbstractSceneConverter::writeFileData(const Containers::ArrayView<const char> data) {
+    CORRADE_ASSERT(_state->conversion == Conversion::File,
+        "Trade::AbstractSceneConverter::writeFileData(): no file conversion in progress", {});
+
+    if(_state->fileCallback) {
+        if(!_state->fileCallback(_state->filename, data, _state->fileCallbackUserData)) {
+            Error() << "Trade::AbstractSceneConverter::writeFileData(): file callback failed for" << _state->filename;
+            return false;
+        }
+    } else if(!Utility::Directory::append(_state->filename, data)) {
+        Error() << "Trade::AbstractSceneConverter::writeFileData(): cannot write to file" << _state->filename;
+        return false;
+    }
+
+    return true;
+}
+
+UnsignedInt AbstractSceneConverter::meshCount() const {
+    CORRADE_ASSERT(_state->conversion != Conversion::None,
+        "Trade::AbstractSceneConverter::meshCount(): no conversion in progress", {});
+    return _state->meshCount;
+}
+
+Containers::Optional<UnsignedInt> AbstractSceneConverter::add(const MeshData& mesh, const std::string& name) {
+    CORRADE_ASSERT(features() & SceneConverterFeature::AddMeshes,
+        "Trade::AbstractSceneConverter::add(): mesh conversion not supported", {});
+    CORRADE_ASSERT(_state->conversion != Conversion::None,
+        "Trade::AbstractSceneConverter::add(): no conversion in progress", {});
+
+    const UnsignedInt id = _state->meshCount;
+    if(!doAdd(id, mesh, name)) return {};
+
+    ++_state->meshCount;
+    return id;
+}
+
+bool AbstractSceneConverter::doAdd(UnsignedInt, const MeshData&, const std::string&) {
+    CORRADE_ASSERT_UNREACHABLE("Trade::AbstractSceneConverter::add(): mesh conversion advertised but not implemented", {});
+}
+
 Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
     debug << "Trade::SceneConverterFeature" << Debug::nospace;
 
@@ -163,6 +343,9 @@ Debug& operator<<(Debug& debug, const SceneConverterFeature value) {
         _c(ConvertMeshInPlace)
         _c(ConvertMeshToData)
         _c(ConvertMeshToFile)
+        _c(ConvertMultipleToData)
+        _c(ConvertMultipleToFile)
+        _c(AddMeshes)
         #undef _c
         /* LCOV_EXCL_STOP */
     }
@@ -176,7 +359,11 @@ Debug& operator<<(Debug& debug, const SceneConverterFeatures value) {
         SceneConverterFeature::ConvertMeshInPlace,
         SceneConverterFeature::ConvertMeshToData,
         /* Implied by ConvertMeshToData, has to be after */
-        SceneConverterFeature::ConvertMeshToFile});
+        SceneConverterFeature::ConvertMeshToFile,
+        SceneConverterFeature::ConvertMultipleToData,
+        /* Implied by ConvertMultipleToData, has to be after */
+        SceneConverterFeature::ConvertMultipleToFile,
+        SceneConverterFeature::AddMeshes});
 }
 
 Debug& operator<<(Debug& debug, const SceneConverterFlag value) {
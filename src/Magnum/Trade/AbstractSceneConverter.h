@@ -30,6 +30,7 @@
  * @m_since{2020,06}
  */
 
+#include <Corrade/Containers/Pointer.h>
 #include <Corrade/PluginManager/AbstractManagingPlugin.h>
 
 #include "Magnum/Magnum.h"
@@ -68,7 +69,33 @@ enum class SceneConverterFeature: UnsignedByte {
      * @ref AbstractSceneConverter::convertToData(const MeshData&). Implies
      * @ref SceneConverterFeature::ConvertMeshToFile.
      */
-    ConvertMeshToData = ConvertMeshToFile|(1 << 3)
+    ConvertMeshToData = ConvertMeshToFile|(1 << 3),
+
+    /**
+     * Converting multiple data items to a file with
+     * @ref AbstractSceneConverter::beginFile(),
+     * @ref AbstractSceneConverter::endFile() and
+     * @ref AbstractSceneConverter::add() "add()" in between.
+     * @m_since_latest
+     */
+    ConvertMultipleToFile = 1 << 4,
+
+    /**
+     * Converting multiple data items to raw data with
+     * @ref AbstractSceneConverter::beginData(),
+     * @ref AbstractSceneConverter::endData() and
+     * @ref AbstractSceneConverter::add() "add()" in between. Implies
+     * @ref SceneConverterFeature::ConvertMultipleToFile.
+     * @m_since_latest
+     */
+    ConvertMultipleToData = ConvertMultipleToFile|(1 << 5),
+
+    /**
+     * Adding meshes to a multi-item conversion with
+     * @ref AbstractSceneConverter::add(const MeshData&, const std::string&).
+     * @m_since_latest
+     */
+    AddMeshes = 1 << 6
 };
 
 /**
@@ -142,6 +169,26 @@ various formats or performing optimizations and other operations on them. See
     exposing functionality of all scene converter plugins on a command line as
     well as performing introspection of scene files.
 
+@section Trade-AbstractSceneConverter-multiple Converting multiple data items
+
+Besides converting a single mesh at a time, converters advertising
+@ref SceneConverterFeature::ConvertMultipleToFile or
+@ref SceneConverterFeature::ConvertMultipleToData can produce a file
+containing multiple data items. The conversion is started with
+@ref beginFile() or @ref beginData(), data items are then added one by one
+with @ref add() and the conversion is finished with @ref endFile() or
+@ref endData(). Only the data that are currently being added need to be kept
+in memory, which makes it possible to convert scenes that wouldn't fit into
+memory all at once:
+
+@snippet MagnumTrade.cpp AbstractSceneConverter-usage-multiple
+
+Converters that implement @ref SceneConverterFeature::ConvertMultipleToFile
+directly write the output incrementally as the data are added. By default
+it's appended to the file given to @ref beginFile(), alternatively all output
+can be redirected to a callback set with @ref setFileCallback(), for example
+to compress it or send it over network without touching the filesystem.
+
 @section Trade-AbstractSceneConverter-data-dependency Data dependency
 
 The instances returned from various functions *by design* have no dependency on
@@ -157,7 +204,11 @@ plugin module has been unloaded.
 
 The plugin needs to implement the @ref doFeatures() function and one or more of
 @ref doConvert(), @ref doConvertInPlace(), @ref doConvertToData() or
-@ref doConvertToFile() functions based on what features are supported.
+@ref doConvertToFile() functions based on what features are supported. For
+converting multiple data items, the plugin implements @ref doBeginFile() and
+@ref doEndFile() or @ref doBeginData() and @ref doEndData() together with
+@ref doAdd(UnsignedInt, const MeshData&, const std::string&). Incremental
+file output is done by calling @ref writeFileData() from these.
 
 You don't need to do most of the redundant sanity checks, these things are
 checked by the implementation:
@@ -170,6 +221,16 @@ checked by the implementation:
     @ref SceneConverterFeature::ConvertMeshToData is supported.
 -   The function @ref doConvertToFile(const std::string&, const MeshData&) is
     called only if @ref SceneConverterFeature::ConvertMeshToFile is supported.
+-   The functions @ref doBeginFile() and @ref doEndFile() are called only
+    if @ref SceneConverterFeature::ConvertMultipleToFile is supported,
+    @ref doBeginData() and @ref doEndData() only if
+    @ref SceneConverterFeature::ConvertMultipleToData is supported.
+-   The function @ref doAdd(UnsignedInt, const MeshData&, const std::string&)
+    is called only if @ref SceneConverterFeature::AddMeshes is supported and
+    a conversion is in progress.
+-   The function @ref doEndFile() or @ref doEndData() is called only if the
+    corresponding conversion is in progress, @ref doAbort() only if any
+    conversion is in progress.
 
 @m_class{m-block m-warning}
 
@@ -217,6 +278,8 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
         /** @brief Plugin manager constructor */
         explicit AbstractSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~AbstractSceneConverter();
+
         /** @brief Features supported by this converter */
         SceneConverterFeatures features() const;
 
@@ -279,6 +342,156 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
          */
         bool convertToFile(const std::string& filename, const MeshData& mesh);
 
+        /**
+         * @brief File callback
+         * @m_since_latest
+         *
+         * @see @ref setFileCallback()
+         */
+        auto fileCallback() const -> bool(*)(const std::string&, Containers::ArrayView<const char>, void*);
+
+        /**
+         * @brief File callback user data
+         * @m_since_latest
+         *
+         * @see @ref setFileCallback()
+         */
+        void* fileCallbackUserData() const;
+
+        /**
+         * @brief Set file output callback
+         * @m_since_latest
+         *
+         * If set, all output produced during a conversion started with
+         * @ref beginFile() is passed to @p callback instead of being written
+         * to the filesystem. The callback gets the filename passed to
+         * @ref beginFile(), a chunk of data to append to it and @p userData.
+         * The chunks are passed in order and are guaranteed to be valid only
+         * during the callback call. The callback is expected to return
+         * @cpp true @ce on success and @cpp false @ce if the data couldn't be
+         * written, in which case the conversion fails. Pass @cpp nullptr @ce
+         * to reset the callback back to writing to the filesystem.
+         *
+         * Expects that no conversion is in progress. The callback affects
+         * only @ref beginFile() and @ref endFile(), not
+         * @ref convertToFile().
+         */
+        void setFileCallback(bool(*callback)(const std::string& filename, Containers::ArrayView<const char> data, void* userData), void* userData = nullptr);
+
+        /**
+         * @brief Whether any conversion is in progress
+         * @m_since_latest
+         *
+         * Returns @cpp true @ce if a conversion was started with
+         * @ref beginFile() or @ref beginData() and not yet finished with
+         * @ref endFile(), @ref endData() or @ref abort().
+         */
+        bool isConverting() const;
+
+        /**
+         * @brief Abort any in-progress conversion
+         * @m_since_latest
+         *
+         * On particular implementations an explicit call to this function may
+         * release allocated resources. If no conversion is in progress, does
+         * nothing. A partially written output file is left as-is.
+         */
+        void abort();
+
+        /**
+         * @brief Begin converting multiple data items to raw data
+         * @m_since_latest
+         *
+         * Available only if @ref SceneConverterFeature::ConvertMultipleToData
+         * is supported. If a conversion is currently in progress, calls
+         * @ref abort() first. Returns @cpp true @ce on success, prints an
+         * error message and returns @cpp false @ce otherwise. The data items
+         * are then added with @ref add() and the conversion is finished with
+         * @ref endData().
+         * @see @ref features(), @ref beginFile()
+         */
+        bool beginData();
+
+        /**
+         * @brief End converting multiple data items to raw data
+         * @m_since_latest
+         *
+         * Expects that a conversion was started with @ref beginData(). On
+         * failure prints an error message and returns @cpp nullptr @ce. In
+         * both cases the conversion is finished and @ref isConverting()
+         * returns @cpp false @ce afterwards.
+         */
+        Containers::Array<char> endData();
+
+        /**
+         * @brief Begin converting multiple data items to a file
+         * @m_since_latest
+         *
+         * Available only if @ref SceneConverterFeature::ConvertMultipleToFile
+         * or @ref SceneConverterFeature::ConvertMultipleToData is supported.
+         * If a conversion is currently in progress, calls @ref abort()
+         * first. Unless a callback is set using @ref setFileCallback(), the
+         * file is created or truncated here. Returns @cpp true @ce on
+         * success, prints an error message and returns @cpp false @ce
+         * otherwise. The data items are then added with @ref add() and the
+         * conversion is finished with @ref endFile().
+         * @see @ref features(), @ref beginData()
+         */
+        bool beginFile(const std::string& filename);
+
+        /**
+         * @brief End converting multiple data items to a file
+         * @m_since_latest
+         *
+         * Expects that a conversion was started with @ref beginFile().
+         * Returns @cpp true @ce on success, prints an error message and
+         * returns @cpp false @ce otherwise. In both cases the conversion is
+         * finished and @ref isConverting() returns @cpp false @ce
+         * afterwards.
+         */
+        bool endFile();
+
+        /**
+         * @brief Count of meshes added to the current conversion
+         * @m_since_latest
+         *
+         * Expects that a conversion is in progress.
+         * @see @ref isConverting()
+         */
+        UnsignedInt meshCount() const;
+
+        /**
+         * @brief Add a mesh to the current conversion
+         * @param mesh      Mesh to add
+         * @param name      Mesh name, if the format supports it
+         * @m_since_latest
+         *
+         * Available only if @ref SceneConverterFeature::AddMeshes is
+         * supported and expects that a conversion is in progress. The mesh
+         * data don't need to be kept around after the function returns. On
+         * success returns ID of the mesh in the output, which is equal to
+         * @ref meshCount() before calling this function. On failure prints an
+         * error message and returns @ref Containers::NullOpt, the conversion
+         * is still in progress and can continue with other data or be
+         * aborted.
+         */
+        Containers::Optional<UnsignedInt> add(const MeshData& mesh, const std::string& name = {});
+
+    protected:
+        /**
+         * @brief Write file data
+         * @m_since_latest
+         *
+         * Meant to be called by implementations of @ref doBeginFile(),
+         * @ref doAdd() and @ref doEndFile() to write the output
+         * incrementally. Appends @p data to the file passed to
+         * @ref beginFile() or passes it to the callback set with
+         * @ref setFileCallback(). Expects that a file conversion is in
+         * progress. Returns @cpp true @ce on success, prints an error message
+         * and returns @cpp false @ce otherwise.
+         */
+        bool writeFileData(Containers::ArrayView<const char> data);
+
     private:
         /**
          * @brief Implementation for @ref features()
@@ -320,7 +533,59 @@ class MAGNUM_TRADE_EXPORT AbstractSceneConverter: public PluginManager::Abstract
          */
         virtual bool doConvertToFile(const std::string& filename, const MeshData& mesh);
 
+        /**
+         * @brief Implementation for @ref abort()
+         * @m_since_latest
+         *
+         * Called only if a conversion is in progress. Default implementation
+         * does nothing.
+         */
+        virtual void doAbort();
+
+        /**
+         * @brief Implementation for @ref beginData()
+         * @m_since_latest
+         */
+        virtual bool doBeginData();
+
+        /**
+         * @brief Implementation for @ref endData()
+         * @m_since_latest
+         */
+        virtual Containers::Array<char> doEndData();
+
+        /**
+         * @brief Implementation for @ref beginFile()
+         * @m_since_latest
+         *
+         * If @ref SceneConverterFeature::ConvertMultipleToData is supported,
+         * default implementation calls @ref doBeginData().
+         */
+        virtual bool doBeginFile(const std::string& filename);
+
+        /**
+         * @brief Implementation for @ref endFile()
+         * @m_since_latest
+         *
+         * If @ref SceneConverterFeature::ConvertMultipleToData is supported,
+         * default implementation calls @ref doEndData() and passes the result
+         * to @ref writeFileData().
+         */
+        virtual bool doEndFile(const std::string& filename);
+
+        /**
+         * @brief Implementation for @ref add(const MeshData&, const std::string&)
+         * @m_since_latest
+         *
+         * The @p id is equal to @ref meshCount(), which gets incremented
+         * only if the function returns @cpp true @ce.
+         */
+        virtual bool doAdd(UnsignedInt id, const MeshData& mesh, const std::string& name);
+
+        struct State;
+
         SceneConverterFlags _flags;
+        Containers::Pointer<State> _state;
 };
 
 }}
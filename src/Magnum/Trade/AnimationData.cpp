@@ -27,6 +27,9 @@
 
 #include <Corrade/Utility/Debug.h>
 
+#include "Magnum/Math/CubicHermite.h"
+#include "Magnum/Math/DualQuaternion.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Math/Vector4.h"
 #include "Magnum/Math/Quaternion.h"
 #include "Magnum/Trade/Implementation/arrayUtilities.h"
@@ -144,6 +147,153 @@ template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermite3D, Math:
 template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermiteComplex, Complex>(Animation::Interpolation) -> Complex(*)(const CubicHermiteComplex&, const CubicHermiteComplex&, Float);
 template MAGNUM_TRADE_EXPORT auto animationInterpolatorFor<CubicHermiteQuaternion, Quaternion>(Animation::Interpolation) -> Quaternion(*)(const CubicHermiteQuaternion&, const CubicHermiteQuaternion&, Float);
 
+namespace {
+
+template<class V> AnimationTrackData resampleTrack(const AnimationData& animation, const UnsignedInt id, const Containers::StridedArrayView1D<const Float>& keys, char* const data) {
+    typedef Animation::ResultOf<V> R;
+    const Animation::TrackView<const Float, const V, R>& track = animation.track<V, R>(id);
+
+    /* Consecutive keys are increasing, so the hint makes each lookup
+       constant-time */
+    const Containers::ArrayView<R> values{reinterpret_cast<R*>(data), keys.size()};
+    std::size_t hint{};
+    for(std::size_t i = 0; i != keys.size(); ++i)
+        values[i] = track.at(keys[i], hint);
+
+    /* Step-wise tracks stay step-wise, everything else including splines and
+       custom interpolators gets interpolated linearly */
+    const Animation::Interpolation interpolation =
+        track.interpolation() == Animation::Interpolation::Constant ?
+            Animation::Interpolation::Constant : Animation::Interpolation::Linear;
+    return AnimationTrackData{animation.trackTargetType(id), animation.trackTarget(id),
+        Animation::TrackView<const Float, const R>{keys, values, interpolation, animationInterpolatorFor<R>(interpolation), track.before(), track.after()}};
+}
+
+/* Result type for the types that don't unpack to themselves */
+AnimationTrackType defaultResultType(const AnimationTrackType type) {
+    switch(type) {
+        case AnimationTrackType::CubicHermite1D:
+            return AnimationTrackType::Float;
+        case AnimationTrackType::CubicHermite2D:
+            return AnimationTrackType::Vector2;
+        case AnimationTrackType::CubicHermite3D:
+            return AnimationTrackType::Vector3;
+        case AnimationTrackType::CubicHermiteComplex:
+            return AnimationTrackType::Complex;
+        case AnimationTrackType::CubicHermiteQuaternion:
+            return AnimationTrackType::Quaternion;
+        default: return type;
+    }
+}
+
+std::size_t resultTypeSize(const AnimationTrackType type) {
+    switch(type) {
+        case AnimationTrackType::Bool:
+        case AnimationTrackType::BoolVector2:
+        case AnimationTrackType::BoolVector3:
+        case AnimationTrackType::BoolVector4:
+            return 1;
+        case AnimationTrackType::Float:
+        case AnimationTrackType::UnsignedInt:
+        case AnimationTrackType::Int:
+        case AnimationTrackType::CubicHermite1D:
+            return 4;
+        case AnimationTrackType::Vector2:
+        case AnimationTrackType::Vector2ui:
+        case AnimationTrackType::Vector2i:
+        case AnimationTrackType::Complex:
+        case AnimationTrackType::CubicHermite2D:
+        case AnimationTrackType::CubicHermiteComplex:
+            return 8;
+        case AnimationTrackType::Vector3:
+        case AnimationTrackType::Vector3ui:
+        case AnimationTrackType::Vector3i:
+        case AnimationTrackType::CubicHermite3D:
+            return 12;
+        case AnimationTrackType::Vector4:
+        case AnimationTrackType::Vector4ui:
+        case AnimationTrackType::Vector4i:
+        case AnimationTrackType::Quaternion:
+        case AnimationTrackType::CubicHermiteQuaternion:
+            return 16;
+        case AnimationTrackType::DualQuaternion:
+            return 32;
+    }
+
+    CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+}
+
+}
+
+AnimationData resampleAnimation(const AnimationData& animation, const Float frameRate) {
+    CORRADE_ASSERT(frameRate > 0.0f,
+        "Trade::resampleAnimation(): expected a positive frame rate, got" << frameRate, (AnimationData{nullptr, nullptr}));
+
+    /* Calculate the frame count and the final data layout. Values of each
+       track are aligned to four bytes so the bool tracks don't cause
+       misaligned access for the others. */
+    const Range1D duration = animation.duration();
+    const std::size_t frameCount = std::size_t(Math::ceil(duration.size()*frameRate)) + 1;
+    std::size_t dataSize = frameCount*sizeof(Float);
+    Containers::Array<std::size_t> trackOffsets{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        const AnimationTrackType type = animation.trackType(i);
+        CORRADE_ASSERT(animation.trackResultType(i) == defaultResultType(type),
+            "Trade::resampleAnimation(): unsupported result type" << animation.trackResultType(i) << "for track" << i << "of" << type, (AnimationData{nullptr, nullptr}));
+        trackOffsets[i] = dataSize;
+        dataSize += (frameCount*resultTypeSize(type) + 3) & ~std::size_t{3};
+    }
+
+    Containers::Array<char> data{Containers::ValueInit, dataSize};
+    const Containers::ArrayView<Float> keys = Containers::arrayCast<Float>(data.prefix(frameCount*sizeof(Float)));
+    for(std::size_t i = 0; i != frameCount; ++i)
+        keys[i] = frameCount == 1 ? duration.min() :
+            duration.min() + duration.size()*(Float(i)/Float(frameCount - 1));
+    /* Avoid the last key being slightly off due to precision */
+    if(frameCount > 1) keys[frameCount - 1] = duration.max();
+
+    Containers::Array<AnimationTrackData> tracks{animation.trackCount()};
+    for(UnsignedInt i = 0; i != animation.trackCount(); ++i) {
+        char* const trackData = data + trackOffsets[i];
+        switch(animation.trackType(i)) {
+            #define _c(type) case AnimationTrackType::type: \
+                tracks[i] = resampleTrack<type>(animation, i, keys, trackData); \
+                break;
+            #define _ct(name, type) case AnimationTrackType::name: \
+                tracks[i] = resampleTrack<type>(animation, i, keys, trackData); \
+                break;
+            _ct(Bool, bool)
+            _c(Float)
+            _c(UnsignedInt)
+            _c(Int)
+            _ct(BoolVector2, Math::BoolVector<2>)
+            _ct(BoolVector3, Math::BoolVector<3>)
+            _ct(BoolVector4, Math::BoolVector<4>)
+            _c(Vector2)
+            _c(Vector2ui)
+            _c(Vector2i)
+            _c(Vector3)
+            _c(Vector3ui)
+            _c(Vector3i)
+            _c(Vector4)
+            _c(Vector4ui)
+            _c(Vector4i)
+            _c(Complex)
+            _c(Quaternion)
+            _c(DualQuaternion)
+            _c(CubicHermite1D)
+            _c(CubicHermite2D)
+            _c(CubicHermite3D)
+            _c(CubicHermiteComplex)
+            _c(CubicHermiteQuaternion)
+            #undef _c
+            #undef _ct
+        }
+    }
+
+    return AnimationData{std::move(data), std::move(tracks), duration};
+}
+
 Debug& operator<<(Debug& debug, const AnimationTrackType value) {
     debug << "Trade::AnimationTrackType" << Debug::nospace;
 
@@ -601,6 +601,43 @@ plugin binary to avoid dangling function pointers on plugin unload.
 */
 template<class V, class R = Animation::ResultOf<V>> MAGNUM_TRADE_EXPORT auto animationInterpolatorFor(Animation::Interpolation interpolation) -> R(*)(const V&, const V&, Float);
 
+/** @relatesalso AnimationData
+@brief Resample an animation to a uniform frame rate
+@param animation    Animation to resample
+@param frameRate    Count of frames per unit of animation time
+@m_since_latest
+
+Evaluates all tracks of @p animation at uniformly spaced times covering the
+whole @ref AnimationData::duration() and returns a new animation where all
+tracks share a single key array. The frame count is calculated as
+@f$ \lceil s f \rceil + 1 @f$, where @f$ s @f$ is the duration size and
+@f$ f @f$ the @p frameRate, and the frames are then spread out so the first
+and last frame lie exactly at the duration boundaries, making the actual frame
+rate slightly higher than requested if the duration isn't a multiple of it.
+
+The returned data contain the key array first, followed by values of each
+track in a contiguous array, in the same order as the tracks. Track values are
+stored in the @ref AnimationData::trackResultType() of the original track,
+which means spline tracks get converted to their unpacked value types. Tracks
+with @ref Animation::Interpolation::Constant are kept step-wise, all other
+tracks use @ref Animation::Interpolation::Linear. Extrapolation behavior,
+track targets and the animation duration are preserved.
+
+Because the keys are uniformly spaced, the result can also be evaluated
+without any key search --- the frame index is calculated directly from the
+time and the values of all tracks of the same type can be interpolated in a
+single loop:
+
+@snippet MagnumTrade.cpp resampleAnimation
+
+Expects that @p frameRate is positive and that the result types of all tracks
+are the default @ref Animation::ResultOf for given track type. Note that
+tracks with @ref Animation::Interpolation::Constant may have their value
+changes shifted by up to one frame.
+@experimental
+*/
+MAGNUM_TRADE_EXPORT AnimationData resampleAnimation(const AnimationData& animation, Float frameRate);
+
 namespace Implementation {
     /* LCOV_EXCL_START */
     template<class> constexpr AnimationTrackType animationTypeFor();
@@ -0,0 +1,123 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ArrayArena.h"
+
+#include <cstdint>
+#include <mutex>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+std::size_t alignedOffset(const char* const data, const std::size_t offset) {
+    const std::size_t misalignment = (reinterpret_cast<std::uintptr_t>(data) + offset) % ArrayArena::Alignment;
+    return misalignment ? offset + ArrayArena::Alignment - misalignment : offset;
+}
+
+}
+
+struct ArrayArena::State {
+    std::mutex mutex;
+    std::size_t chunkSize;
+    std::size_t allocationCount{}, allocatedSize{};
+    Containers::Array<Containers::Array<char>> chunks;
+    /* Chunk the regular allocations are served from. Dedicated chunks for
+       large allocations don't affect it. The pointer stays valid when the
+       chunk array is reallocated. */
+    char* current{};
+    std::size_t currentOffset{};
+};
+
+void ArrayArena::deleter(char*, std::size_t) {}
+
+ArrayArena::ArrayArena(const std::size_t chunkSize): _state{Containers::InPlaceInit} {
+    CORRADE_ASSERT(chunkSize, "Trade::ArrayArena: chunk size can't be zero", );
+    _state->chunkSize = chunkSize;
+}
+
+ArrayArena::ArrayArena(ArrayArena&&) noexcept = default;
+
+ArrayArena::~ArrayArena() = default;
+
+ArrayArena& ArrayArena::operator=(ArrayArena&&) noexcept = default;
+
+std::size_t ArrayArena::chunkSize() const {
+    return _state->chunkSize;
+}
+
+std::size_t ArrayArena::chunkCount() const {
+    return _state->chunks.size();
+}
+
+std::size_t ArrayArena::allocationCount() const {
+    return _state->allocationCount;
+}
+
+std::size_t ArrayArena::allocatedSize() const {
+    return _state->allocatedSize;
+}
+
+Containers::Array<char> ArrayArena::allocate(const std::size_t size) {
+    if(!size) return {};
+
+    State& state = *_state;
+    std::lock_guard<std::mutex> lock{state.mutex};
+    ++state.allocationCount;
+    state.allocatedSize += size;
+
+    std::size_t offset = state.current ? alignedOffset(state.current, state.currentOffset) : 0;
+    if(!state.current || offset + size > state.chunkSize) {
+        /* Allocations that wouldn't fit into an empty chunk get a dedicated
+           one, padded so the start can be aligned. The current chunk is kept
+           for subsequent allocations. */
+        if(size + Alignment - 1 > state.chunkSize) {
+            arrayAppend(state.chunks, Containers::InPlaceInit, Containers::NoInit, size + Alignment - 1);
+            char* const data = state.chunks.back().data();
+            return Containers::Array<char>{data + alignedOffset(data, 0), size, deleter};
+        }
+
+        arrayAppend(state.chunks, Containers::InPlaceInit, Containers::NoInit, state.chunkSize);
+        state.current = state.chunks.back().data();
+        offset = alignedOffset(state.current, 0);
+    }
+
+    state.currentOffset = offset + size;
+    return Containers::Array<char>{state.current + offset, size, deleter};
+}
+
+void ArrayArena::release() {
+    State& state = *_state;
+    std::lock_guard<std::mutex> lock{state.mutex};
+    state.chunks = nullptr;
+    state.current = nullptr;
+    state.currentOffset = 0;
+    state.allocationCount = 0;
+    state.allocatedSize = 0;
+}
+
+}}
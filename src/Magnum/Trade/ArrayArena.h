@@ -0,0 +1,173 @@
+#ifndef Magnum_Trade_ArrayArena_h
+#define Magnum_Trade_ArrayArena_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::ArrayArena
+ * @m_since_latest
+ */
+
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Arena for importer output data
+@m_since_latest
+
+Hands out arrays from large chunks of memory that are freed all at once with
+@ref release() or when the arena is destroyed. When set on an importer via
+@ref AbstractImporter::setArrayArena(), data of all imported meshes, images
+and materials are placed into the arena, turning thousands of small
+long-lived allocations into a few large ones that get freed together, for
+example when a level is unloaded:
+
+@snippet MagnumTrade.cpp ArrayArena-usage
+
+Arrays allocated from the arena have a deleter that does nothing, which means
+they can be safely destructed even after the arena is released, but their
+contents can't be accessed anymore. It's the user responsibility to not use
+any data from the arena after calling @ref release() or destroying the arena.
+Arrays that are larger than @ref chunkSize() get a dedicated chunk. All
+allocations are aligned to @ref Alignment bytes.
+
+The allocation is guarded by a mutex, so a single arena can be shared by
+importers running on multiple threads, such as with @ref AsyncImporter.
+*/
+class MAGNUM_TRADE_EXPORT ArrayArena {
+    public:
+        enum: std::size_t {
+            /** Alignment of all allocations */
+            Alignment = 16
+        };
+
+        /**
+         * @brief Deleter used by arena arrays
+         *
+         * Does nothing, the memory is freed by @ref release(). Can be used to
+         * check whether given array was allocated from an arena.
+         */
+        static void deleter(char* data, std::size_t size);
+
+        /**
+         * @brief Constructor
+         * @param chunkSize     Size of a single memory chunk. Expected to be
+         *      non-zero.
+         *
+         * No memory is allocated until the first call to @ref allocate().
+         */
+        explicit ArrayArena(std::size_t chunkSize = 1024*1024);
+
+        /** @brief Copying is not allowed */
+        ArrayArena(const ArrayArena&) = delete;
+
+        /** @brief Move constructor */
+        ArrayArena(ArrayArena&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Calls @ref release().
+         */
+        ~ArrayArena();
+
+        /** @brief Copying is not allowed */
+        ArrayArena& operator=(const ArrayArena&) = delete;
+
+        /** @brief Move assignment */
+        ArrayArena& operator=(ArrayArena&&) noexcept;
+
+        /** @brief Size of a single memory chunk */
+        std::size_t chunkSize() const;
+
+        /**
+         * @brief Count of allocated chunks
+         *
+         * Includes dedicated chunks for allocations larger than
+         * @ref chunkSize().
+         */
+        std::size_t chunkCount() const;
+
+        /** @brief Count of allocations since the last @ref release() */
+        std::size_t allocationCount() const;
+
+        /**
+         * @brief Total size of all allocations since the last @ref release()
+         *
+         * Doesn't include alignment padding and unused space at the end of
+         * chunks.
+         */
+        std::size_t allocatedSize() const;
+
+        /**
+         * @brief Allocate an array
+         *
+         * The contents are left uninitialized. A zero-sized allocation
+         * returns an empty array without touching the chunks.
+         * @see @ref allocate(std::size_t)
+         */
+        Containers::Array<char> allocate(std::size_t size);
+
+        /**
+         * @brief Allocate a typed array
+         *
+         * Like @ref allocate(std::size_t) but with @p count elements of type
+         * @p T. The elements are left uninitialized and their destructors are
+         * never called, so the type is expected to be trivially destructible.
+         */
+        template<class T> Containers::Array<T> allocate(std::size_t count);
+
+        /**
+         * @brief Release all memory
+         *
+         * All arrays allocated from the arena become dangling. The arena can
+         * be used for new allocations afterwards.
+         */
+        void release();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+template<class T> Containers::Array<T> ArrayArena::allocate(const std::size_t count) {
+    static_assert(std::is_trivially_destructible<T>::value,
+        "the type has to be trivially destructible");
+    static_assert(alignof(T) <= Alignment,
+        "the type is over-aligned");
+    Containers::Array<char> data = allocate(count*sizeof(T));
+    return Containers::Array<T>{reinterpret_cast<T*>(data.release()), count,
+        reinterpret_cast<void(*)(T*, std::size_t)>(deleter)};
+}
+
+}}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AsyncImporter.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+struct AsyncImporter::State {
+    explicit State(AbstractImporter& importer): importer(importer) {}
+
+    void work();
+    template<class T, class F> std::future<T> schedule(F&& f);
+
+    AbstractImporter& importer;
+    /* Queried just once upfront so the ID checks in the scheduling functions
+       don't need to call into the importer while it's used by the workers */
+    UnsignedInt meshCount{}, image2DCount{}, materialCount{};
+
+    std::mutex mutex;
+    std::condition_variable jobAvailable, jobsFinished;
+    std::deque<std::function<void()>> jobs;
+    std::size_t pendingJobCount{};
+    bool quit{};
+    Containers::Array<std::thread> threads;
+};
+
+void AsyncImporter::State::work() {
+    for(;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            jobAvailable.wait(lock, [this]{ return quit || !jobs.empty(); });
+            /* Quitting only once all jobs are done */
+            if(jobs.empty()) return;
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+
+        job();
+
+        std::lock_guard<std::mutex> lock{mutex};
+        if(!--pendingJobCount) jobsFinished.notify_all();
+    }
+}
+
+template<class T, class F> std::future<T> AsyncImporter::State::schedule(F&& f) {
+    /* std::function needs a copyable functor, std::packaged_task isn't */
+    std::shared_ptr<std::packaged_task<T()>> task = std::make_shared<std::packaged_task<T()>>(std::forward<F>(f));
+    std::future<T> future = task->get_future();
+
+    /* No threads available, execute directly */
+    if(threads.isEmpty()) {
+        (*task)();
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        jobs.emplace_back([task]{ (*task)(); });
+        ++pendingJobCount;
+    }
+    jobAvailable.notify_one();
+    return future;
+}
+
+AsyncImporter::AsyncImporter(AbstractImporter& importer, UnsignedInt threadCount): _state{Containers::InPlaceInit, importer} {
+    CORRADE_ASSERT(importer.isOpened(),
+        "Trade::AsyncImporter: no file opened", );
+
+    _state->meshCount = importer.meshCount();
+    _state->image2DCount = importer.image2DCount();
+    _state->materialCount = importer.materialCount();
+
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    /* No threads available, everything is done in the scheduling functions */
+    static_cast<void>(threadCount);
+    #else
+    /* Importers that aren't thread-safe get a single thread, which serializes
+       the calls */
+    if(!(importer.features() & ImporterFeature::ConcurrentImport))
+        threadCount = 1;
+    else if(!threadCount)
+        threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+
+    _state->threads = Containers::Array<std::thread>{Containers::ValueInit, threadCount};
+    for(std::thread& thread: _state->threads)
+        thread = std::thread{&State::work, _state.get()};
+    #endif
+}
+
+AsyncImporter::~AsyncImporter() {
+    {
+        std::lock_guard<std::mutex> lock{_state->mutex};
+        _state->quit = true;
+    }
+    _state->jobAvailable.notify_all();
+    for(std::thread& thread: _state->threads) thread.join();
+}
+
+AbstractImporter& AsyncImporter::importer() { return _state->importer; }
+
+UnsignedInt AsyncImporter::threadCount() const { return _state->threads.size(); }
+
+std::future<Containers::Optional<MeshData>> AsyncImporter::mesh(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(id < _state->meshCount,
+        "Trade::AsyncImporter::mesh(): index" << id << "out of range for" << _state->meshCount << "entries", {});
+    AbstractImporter& importer = _state->importer;
+    return _state->schedule<Containers::Optional<MeshData>>([&importer, id, level]{
+        return importer.mesh(id, level);
+    });
+}
+
+std::future<Containers::Optional<ImageData2D>> AsyncImporter::image2D(const UnsignedInt id, const UnsignedInt level) {
+    CORRADE_ASSERT(id < _state->image2DCount,
+        "Trade::AsyncImporter::image2D(): index" << id << "out of range for" << _state->image2DCount << "entries", {});
+    AbstractImporter& importer = _state->importer;
+    return _state->schedule<Containers::Optional<ImageData2D>>([&importer, id, level]{
+        return importer.image2D(id, level);
+    });
+}
+
+std::future<Containers::Optional<MaterialData>> AsyncImporter::material(const UnsignedInt id) {
+    CORRADE_ASSERT(id < _state->materialCount,
+        "Trade::AsyncImporter::material(): index" << id << "out of range for" << _state->materialCount << "entries", {});
+    AbstractImporter& importer = _state->importer;
+    return _state->schedule<Containers::Optional<MaterialData>>([&importer, id]{
+        /* With MAGNUM_BUILD_DEPRECATED the importer returns a subclass */
+        return Containers::Optional<MaterialData>{importer.material(id)};
+    });
+}
+
+void AsyncImporter::wait() {
+    std::unique_lock<std::mutex> lock{_state->mutex};
+    _state->jobsFinished.wait(lock, [this]{ return !_state->pendingJobCount; });
+}
+
+}}
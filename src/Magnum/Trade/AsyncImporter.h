@@ -0,0 +1,164 @@
+#ifndef Magnum_Trade_AsyncImporter_h
+#define Magnum_Trade_AsyncImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::AsyncImporter
+ * @m_since_latest
+ */
+
+#include <future>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Asynchronous importer front-end
+@m_since_latest
+
+Schedules data import from an @ref AbstractImporter on background threads and
+returns a @ref std::future for each scheduled import. If the importer
+advertises @ref ImporterFeature::ConcurrentImport, the work is distributed
+across all threads, otherwise it's executed serially on a single background
+thread, so it's safe to use with any importer:
+
+@snippet MagnumTrade.cpp AsyncImporter
+
+The importer is expected to have a file opened when the instance is created
+and the data counts are queried just once, in the constructor. The importer
+has to stay opened and can't be used directly until all scheduled imports
+finish --- either wait for all the futures, call @ref wait() or destroy the
+instance, which waits as well. Import failures are reported the same way as
+with the synchronous API, by the future resolving to
+@ref Corrade::Containers::NullOpt.
+
+You need to include the @ref MeshData, @ref ImageData and @ref MaterialData
+headers in order to access the returned data.
+
+On @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten" builds without threading
+support, the imports are executed directly in the scheduling function and the
+returned futures are already ready.
+*/
+class MAGNUM_TRADE_EXPORT AsyncImporter {
+    public:
+        /**
+         * @brief Constructor
+         * @param importer      Importer with a file opened
+         * @param threadCount   Count of background threads. If set to
+         *      @cpp 0 @ce, @ref std::thread::hardware_concurrency() is used.
+         *      Ignored if the importer doesn't support
+         *      @ref ImporterFeature::ConcurrentImport, in that case just a
+         *      single thread is used.
+         *
+         * Expects that @p importer has a file opened.
+         */
+        explicit AsyncImporter(AbstractImporter& importer, UnsignedInt threadCount = 0);
+
+        /** @brief Copying is not allowed */
+        AsyncImporter(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter(AsyncImporter&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits until all scheduled imports finish.
+         */
+        ~AsyncImporter();
+
+        /** @brief Copying is not allowed */
+        AsyncImporter& operator=(const AsyncImporter&) = delete;
+
+        /** @brief Moving is not allowed */
+        AsyncImporter& operator=(AsyncImporter&&) = delete;
+
+        /** @brief Underlying importer */
+        AbstractImporter& importer();
+
+        /**
+         * @brief Count of background threads
+         *
+         * Always @cpp 1 @ce if the importer doesn't support
+         * @ref ImporterFeature::ConcurrentImport, @cpp 0 @ce on Emscripten
+         * builds without threading support.
+         */
+        UnsignedInt threadCount() const;
+
+        /**
+         * @brief Schedule a mesh import
+         * @param id        Mesh ID, from range
+         *      [0, @ref AbstractImporter::meshCount()).
+         * @param level     Mesh level, from range
+         *      [0, @ref AbstractImporter::meshLevelCount())
+         *
+         * Returns a future resolving to the result of
+         * @ref AbstractImporter::mesh(UnsignedInt, UnsignedInt).
+         */
+        std::future<Containers::Optional<MeshData>> mesh(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Schedule a 2D image import
+         * @param id        Image ID, from range
+         *      [0, @ref AbstractImporter::image2DCount()).
+         * @param level     Mip level, from range
+         *      [0, @ref AbstractImporter::image2DLevelCount())
+         *
+         * Returns a future resolving to the result of
+         * @ref AbstractImporter::image2D(UnsignedInt, UnsignedInt).
+         */
+        std::future<Containers::Optional<ImageData2D>> image2D(UnsignedInt id, UnsignedInt level = 0);
+
+        /**
+         * @brief Schedule a material import
+         * @param id        Material ID, from range
+         *      [0, @ref AbstractImporter::materialCount()).
+         *
+         * Returns a future resolving to the result of
+         * @ref AbstractImporter::material(UnsignedInt).
+         */
+        std::future<Containers::Optional<MaterialData>> material(UnsignedInt id);
+
+        /**
+         * @brief Wait for all scheduled imports
+         *
+         * After this function returns, the importer can be used directly
+         * again.
+         */
+        void wait();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,256 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DerivedDataCache.h"
+
+#include <sstream>
+#include <unordered_map>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
+#include <Corrade/Utility/Sha1.h>
+
+#include "Magnum/FileCallback.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Bumped whenever the key composition changes, which makes all previously
+   cached results unreachable */
+constexpr const char CacheVersion[]{"Trade::DerivedDataCache/1"};
+
+/* Including the size so concatenating differently split strings doesn't
+   result in the same hash */
+void hashString(Utility::Sha1& sha1, const Containers::StringView string) {
+    sha1 << Utility::formatString("{} ", string.size()) << Containers::ArrayView<const char>{string.data(), string.size()};
+}
+
+}
+
+struct DerivedDataCache::State {
+    explicit State(const std::string& directory, AbstractImporter& importer, AbstractSceneConverter& sceneConverter, AbstractImageConverter& imageConverter): directory{directory}, importer(importer), sceneConverter(sceneConverter), imageConverter(imageConverter) {}
+
+    Containers::Optional<Utility::Sha1::Digest> sourceDigest(const std::string& filename, const char* prefix);
+    std::string cacheFilename(AbstractImporter& sourceImporter, const Utility::Sha1::Digest& source, const char* type, UnsignedInt id, UnsignedInt level, Containers::StringView pipeline) const;
+    bool openCached(const std::string& filename);
+    bool openSource(AbstractImporter& sourceImporter, const std::string& filename);
+    void save(const std::string& filename, Containers::ArrayView<const char> data) const;
+
+    std::string directory;
+    AbstractImporter& importer;
+    AbstractSceneConverter& sceneConverter;
+    AbstractImageConverter& imageConverter;
+
+    std::unordered_map<std::string, Utility::Sha1::Digest> sourceDigests;
+    /* Source importer and the file it opened on the last cache miss, to
+       avoid reopening the same file for each subsequent miss */
+    AbstractImporter* openedImporter{};
+    std::string openedFilename;
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    MappedFileCallback files;
+    #endif
+
+    std::size_t hitCount{}, missCount{};
+};
+
+Containers::Optional<Utility::Sha1::Digest> DerivedDataCache::State::sourceDigest(const std::string& filename, const char* const prefix) {
+    const auto found = sourceDigests.find(filename);
+    if(found != sourceDigests.end()) return found->second;
+
+    if(!Utility::Directory::exists(filename)) {
+        Error{} << prefix << "cannot open file" << filename;
+        return {};
+    }
+
+    const Utility::Sha1::Digest digest = (Utility::Sha1{} << Utility::Directory::read(filename)).digest();
+    sourceDigests.emplace(filename, digest);
+    return digest;
+}
+
+std::string DerivedDataCache::State::cacheFilename(AbstractImporter& sourceImporter, const Utility::Sha1::Digest& source, const char* const type, const UnsignedInt id, const UnsignedInt level, const Containers::StringView pipeline) const {
+    /* The configuration group can't be serialized on its own, so put a copy
+       of it into a temporary configuration */
+    Utility::Configuration configuration;
+    configuration.addGroup("configuration", new Utility::ConfigurationGroup{sourceImporter.configuration()});
+    std::ostringstream configurationOut;
+    configuration.save(configurationOut);
+
+    Utility::Sha1 sha1;
+    hashString(sha1, CacheVersion);
+    hashString(sha1, sourceImporter.plugin());
+    /* Verbose affects only the printed messages, not the output */
+    sha1 << Utility::formatString("{:x} {} {} {}\n",
+        UnsignedInt(sourceImporter.flags() & ~ImporterFlag::Verbose),
+        type, id, level);
+    hashString(sha1, configurationOut.str());
+    hashString(sha1, pipeline);
+    hashString(sha1, source.hexString());
+
+    return Utility::Directory::join(directory, sha1.digest().hexString() + ".blob");
+}
+
+bool DerivedDataCache::State::openCached(const std::string& filename) {
+    if(!Utility::Directory::exists(filename)) return false;
+
+    /* Anything unexpected in the file is treated as a cache miss and the file
+       gets overwritten with a fresh result after, so there's no need to
+       print anything */
+    Error redirectError{nullptr};
+
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    const Containers::Optional<Containers::ArrayView<const char>> data = MappedFileCallback::callback(filename, InputFileCallbackPolicy::LoadPermanent, files);
+    return data && importer.openData(*data);
+    #else
+    return importer.openData(Utility::Directory::read(filename));
+    #endif
+}
+
+bool DerivedDataCache::State::openSource(AbstractImporter& sourceImporter, const std::string& filename) {
+    if(openedImporter == &sourceImporter && openedFilename == filename && sourceImporter.isOpened())
+        return true;
+
+    openedImporter = nullptr;
+    if(!sourceImporter.openFile(filename)) return false;
+    openedImporter = &sourceImporter;
+    openedFilename = filename;
+    return true;
+}
+
+void DerivedDataCache::State::save(const std::string& filename, const Containers::ArrayView<const char> data) const {
+    if(!Utility::Directory::mkpath(directory)) return;
+
+    /* Writing to a temporary file first so an interrupted write or another
+       cache instance never sees a partially written result */
+    const std::string temporary = filename + ".tmp";
+    if(Utility::Directory::write(temporary, data))
+        Utility::Directory::move(temporary, filename);
+}
+
+DerivedDataCache::DerivedDataCache(const std::string& directory, AbstractImporter& importer, AbstractSceneConverter& sceneConverter, AbstractImageConverter& imageConverter): _state{Containers::InPlaceInit, directory, importer, sceneConverter, imageConverter} {
+    /* Cache files are mapped, so the importer can reference them directly */
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    if(!(importer.flags() & ImporterFlag::ZeroCopy)) {
+        importer.close();
+        importer.setFlags(importer.flags()|ImporterFlag::ZeroCopy);
+    }
+    #endif
+}
+
+DerivedDataCache::DerivedDataCache(DerivedDataCache&&) noexcept = default;
+
+DerivedDataCache::~DerivedDataCache() = default;
+
+DerivedDataCache& DerivedDataCache::operator=(DerivedDataCache&&) noexcept = default;
+
+std::string DerivedDataCache::directory() const {
+    return _state->directory;
+}
+
+std::size_t DerivedDataCache::hitCount() const {
+    return _state->hitCount;
+}
+
+std::size_t DerivedDataCache::missCount() const {
+    return _state->missCount;
+}
+
+Containers::Optional<MeshData> DerivedDataCache::mesh(AbstractImporter& importer, const std::string& filename, const UnsignedInt id, const Containers::StringView pipeline, const MeshProcessor processor, void* const userData) {
+    State& state = *_state;
+
+    const Containers::Optional<Utility::Sha1::Digest> source = state.sourceDigest(filename, "Trade::DerivedDataCache::mesh():");
+    if(!source) return {};
+    const std::string cacheFilename = state.cacheFilename(importer, *source, "mesh", id, 0, pipeline);
+
+    if(state.openCached(cacheFilename) && state.importer.meshCount() == 1) {
+        Containers::Optional<MeshData> mesh;
+        {
+            Error redirectError{nullptr};
+            mesh = state.importer.mesh(0);
+        }
+        if(mesh) {
+            ++state.hitCount;
+            return mesh;
+        }
+    }
+
+    ++state.missCount;
+    if(!state.openSource(importer, filename)) return {};
+    Containers::Optional<MeshData> mesh = importer.mesh(id);
+    if(!mesh) return {};
+    if(processor) {
+        mesh = processor(std::move(*mesh), userData);
+        if(!mesh) return {};
+    }
+
+    /* If the conversion fails, the result is returned uncached */
+    const Containers::Array<char> data = state.sceneConverter.convertToData(*mesh);
+    if(data) state.save(cacheFilename, data);
+    return mesh;
+}
+
+Containers::Optional<ImageData2D> DerivedDataCache::image2D(AbstractImporter& importer, const std::string& filename, const UnsignedInt id, const UnsignedInt level, const Containers::StringView pipeline, const Image2DProcessor processor, void* const userData) {
+    State& state = *_state;
+
+    const Containers::Optional<Utility::Sha1::Digest> source = state.sourceDigest(filename, "Trade::DerivedDataCache::image2D():");
+    if(!source) return {};
+    const std::string cacheFilename = state.cacheFilename(importer, *source, "image2D", id, level, pipeline);
+
+    if(state.openCached(cacheFilename) && state.importer.image2DCount() == 1) {
+        Containers::Optional<ImageData2D> image;
+        {
+            Error redirectError{nullptr};
+            image = state.importer.image2D(0);
+        }
+        if(image) {
+            ++state.hitCount;
+            return image;
+        }
+    }
+
+    ++state.missCount;
+    if(!state.openSource(importer, filename)) return {};
+    Containers::Optional<ImageData2D> image = importer.image2D(id, level);
+    if(!image) return {};
+    if(processor) {
+        image = processor(std::move(*image), userData);
+        if(!image) return {};
+    }
+
+    /* If the conversion fails, the result is returned uncached */
+    const Containers::Array<char> data = state.imageConverter.exportToData(*image);
+    if(data) state.save(cacheFilename, data);
+    return image;
+}
+
+}}
@@ -0,0 +1,228 @@
+#ifndef Magnum_Trade_DerivedDataCache_h
+#define Magnum_Trade_DerivedDataCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::DerivedDataCache
+ * @m_since_latest
+ */
+
+#include <string>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief On-disk cache of imported and processed data
+@m_since_latest
+
+Sits between an @ref AbstractImporter and the consumer and stores results of
+importing and processing meshes and images in a directory, keyed by a SHA-1
+hash of:
+
+-   contents of the source file,
+-   the importer plugin name, its @ref ImporterFlags except for
+    @ref ImporterFlag::Verbose and its plugin configuration,
+-   the mesh or image ID and level,
+-   a caller-supplied *pipeline* string, which should identify the
+    processing done on the data together with its version, so changing the
+    processing invalidates all previous results.
+
+The results are serialized using a scene and image converter that's paired
+with an importer able to read them back --- usually the
+@ref MagnumSceneConverter, @ref MagnumImageConverter and @ref MagnumImporter
+plugins, which store the data in the same memory layout they have at runtime:
+
+@snippet MagnumTrade.cpp DerivedDataCache
+
+If the source importer isn't able to import given data, or if the processing
+function returns @ref Corrade::Containers::NullOpt, the failure is propagated
+to the caller and nothing is cached, so a subsequent call will try again. If
+the converter fails to serialize the result, the result is returned uncached.
+Corrupted or otherwise unreadable cache files are treated as a cache miss and
+get overwritten with a fresh result. Cache files are written under a temporary
+name first and then renamed, so neither an interrupted write nor another cache
+instance ever sees a partially written result.
+
+@section Trade-DerivedDataCache-mapping Memory-mapped cache hits
+
+On @ref CORRADE_TARGET_UNIX "Unix" and non-RT
+@ref CORRADE_TARGET_WINDOWS "Windows" platforms, cache files are
+memory-mapped using a @ref MappedFileCallback and opened with
+@ref ImporterFlag::ZeroCopy, which means importers that support it return
+the cached data as views on the mapped memory without any copying, and only
+the parts that are actually accessed get paged in. The mappings are kept
+alive for as long as the cache instance exists, so data returned from a cache
+hit shouldn't outlive it. On other platforms the cache files are read into
+memory and the importer makes an owned copy of the data.
+
+@section Trade-DerivedDataCache-limitations Limitations
+
+Only the contents of the source file itself are hashed. If the importer loads
+additional files referenced from it, such as external buffers or images, a
+change in those isn't detected --- in that case include their version or hash
+in the pipeline string. The source file is read and hashed on first access,
+the hash is then remembered for the lifetime of the instance, so changes made
+to the source files while the cache instance exists aren't detected either.
+
+The source importer is opened with @ref AbstractImporter::openFile() only on a
+cache miss and stays opened afterwards, so when all results are cached, the
+source files are never parsed. The same applies to cached data --- data
+returned on a cache miss may reference memory owned by the source importer if
+no processing is done, so it needs to stay opened for as long as the data are
+in use.
+*/
+class MAGNUM_TRADE_EXPORT DerivedDataCache {
+    public:
+        /**
+         * @brief Mesh processing function
+         *
+         * Gets a mesh returned by the source importer and the user data
+         * pointer passed to @ref mesh(), returns the processed mesh or
+         * @ref Corrade::Containers::NullOpt on failure.
+         */
+        typedef Containers::Optional<MeshData>(*MeshProcessor)(MeshData&&, void*);
+
+        /**
+         * @brief Image processing function
+         *
+         * Gets an image returned by the source importer and the user data
+         * pointer passed to @ref image2D(), returns the processed image or
+         * @ref Corrade::Containers::NullOpt on failure.
+         */
+        typedef Containers::Optional<ImageData2D>(*Image2DProcessor)(ImageData2D&&, void*);
+
+        /**
+         * @brief Constructor
+         * @param directory         Directory to store the cache files in.
+         *      Created on first write if it doesn't exist.
+         * @param importer          Importer for reading the cache files
+         * @param sceneConverter    Converter for writing cached meshes
+         * @param imageConverter    Converter for writing cached images
+         *
+         * The @p importer is expected to support
+         * @ref ImporterFeature::OpenData and to import exactly one mesh or
+         * one image from the data produced by @p sceneConverter and
+         * @p imageConverter, which are expected to support
+         * @ref SceneConverterFeature::ConvertMeshToData and
+         * @ref ImageConverterFeature::ConvertData /
+         * @ref ImageConverterFeature::ConvertCompressedData, respectively.
+         * All three are expected to stay in scope for the whole lifetime of
+         * the cache.
+         */
+        explicit DerivedDataCache(const std::string& directory, AbstractImporter& importer, AbstractSceneConverter& sceneConverter, AbstractImageConverter& imageConverter);
+
+        /** @brief Copying is not allowed */
+        DerivedDataCache(const DerivedDataCache&) = delete;
+
+        /** @brief Move constructor */
+        DerivedDataCache(DerivedDataCache&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Unmaps all cache files, data returned from cache hits become
+         * dangling.
+         */
+        ~DerivedDataCache();
+
+        /** @brief Copying is not allowed */
+        DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+
+        /** @brief Move assignment */
+        DerivedDataCache& operator=(DerivedDataCache&&) noexcept;
+
+        /** @brief Cache directory */
+        std::string directory() const;
+
+        /**
+         * @brief Count of cache hits
+         *
+         * Count of @ref mesh() and @ref image2D() calls that were satisfied
+         * from the cache.
+         */
+        std::size_t hitCount() const;
+
+        /**
+         * @brief Count of cache misses
+         *
+         * Count of @ref mesh() and @ref image2D() calls that had to import
+         * and process the data, including ones that failed.
+         */
+        std::size_t missCount() const;
+
+        /**
+         * @brief Import and process a mesh through the cache
+         * @param importer  Source importer
+         * @param filename  Source file
+         * @param id        Mesh ID
+         * @param pipeline  String identifying the processing and its version
+         * @param processor Processing function. If @cpp nullptr @ce, the
+         *      imported mesh is cached as-is.
+         * @param userData  User data passed to @p processor
+         *
+         * On a cache hit returns the cached mesh. Otherwise opens
+         * @p filename with @p importer, imports mesh @p id at level
+         * @cpp 0 @ce, processes it with @p processor and stores the result.
+         * Prints a message to @ref Error and returns
+         * @ref Corrade::Containers::NullOpt if @p filename can't be read or
+         * if the import or processing fails.
+         */
+        Containers::Optional<MeshData> mesh(AbstractImporter& importer, const std::string& filename, UnsignedInt id, Containers::StringView pipeline, MeshProcessor processor = nullptr, void* userData = nullptr);
+
+        /**
+         * @brief Import and process a 2D image through the cache
+         * @param importer  Source importer
+         * @param filename  Source file
+         * @param id        Image ID
+         * @param level     Mip level
+         * @param pipeline  String identifying the processing and its version
+         * @param processor Processing function. If @cpp nullptr @ce, the
+         *      imported image is cached as-is.
+         * @param userData  User data passed to @p processor
+         *
+         * On a cache hit returns the cached image. Otherwise opens
+         * @p filename with @p importer, imports image @p id at @p level,
+         * processes it with @p processor and stores the result. Prints a
+         * message to @ref Error and returns
+         * @ref Corrade::Containers::NullOpt if @p filename can't be read or
+         * if the import or processing fails.
+         */
+        Containers::Optional<ImageData2D> image2D(AbstractImporter& importer, const std::string& filename, UnsignedInt id, UnsignedInt level, Containers::StringView pipeline, Image2DProcessor processor = nullptr, void* userData = nullptr);
+
+    private:
+        struct State;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
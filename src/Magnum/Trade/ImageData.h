@@ -100,6 +100,11 @@ first. The following snippet flips the R and B channels of the imported image:
 
 @snippet MagnumTrade.cpp ImageData-usage-mutable
 
+For larger images, @ref TextureTools::swizzleImageInPlace() does the same
+using SIMD byte shuffles and multiple threads. Similarly, an image can be
+flipped upside down with @ref TextureTools::flipImageYInPlace(), or directly
+during import with @ref ImporterFlag::YFlip if the importer supports it.
+
 @see @ref ImageData1D, @ref ImageData2D, @ref ImageData3D,
     @ref Image-pixel-views
 */
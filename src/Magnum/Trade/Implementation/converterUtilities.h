@@ -113,6 +113,32 @@ Containers::Array<ImageInfo> imageInfo(AbstractImporter& importer, bool& error,
     return infos;
 }
 
+/* Per-stage totals collected through AbstractImporter::setProfileCallback(),
+   indexed by ImporterProfileStage minus one */
+struct ImporterProfile {
+    UnsignedLong duration[6]{};
+    std::size_t byteCount[6]{};
+    UnsignedInt callCount[6]{};
+};
+
+void importerProfileCallback(const ImporterProfileStage stage, const UnsignedLong duration, const std::size_t byteCount, void* const userData) {
+    ImporterProfile& profile = *static_cast<ImporterProfile*>(userData);
+    const UnsignedInt i = UnsignedInt(stage) - 1;
+    profile.duration[i] += duration;
+    profile.byteCount[i] += byteCount;
+    ++profile.callCount[i];
+}
+
+void printImporterProfile(const ImporterProfile& profile) {
+    for(UnsignedInt i = 0; i != Containers::arraySize(profile.duration); ++i) {
+        if(!profile.callCount[i]) continue;
+        Debug{} << " " << ImporterProfileStage(i + 1) << Debug::nospace << ":"
+            << UnsignedInt(profile.duration[i]/1000000)/1.0e3f << "seconds,"
+            << profile.callCount[i] << "calls," << profile.byteCount[i]
+            << "bytes";
+    }
+}
+
 }
 
 }}}
@@ -61,8 +61,29 @@ constexpr struct {
     #undef _ct
     #undef _cnt
 };
+
+static_assert(sizeof(AttributeMap)/sizeof(AttributeMap[0]) == Implementation::MaterialAttributeCount,
+    "Implementation::MaterialAttributeCount doesn't match the builtin attribute count");
 #endif
 
+/* Builtin attribute indices sorted by name, to be merged with the sorted base
+   layer attributes in MaterialData::populateAttributeIds(). Calculated just
+   once, the function-local static initialization is thread-safe. */
+const UnsignedByte* attributeMapSortedByName() {
+    static const struct Sorted {
+        Sorted() {
+            for(UnsignedByte i = 0; i != Implementation::MaterialAttributeCount; ++i)
+                ids[i] = i;
+            std::sort(ids, ids + Implementation::MaterialAttributeCount, [](UnsignedByte a, UnsignedByte b) {
+                return AttributeMap[a].name < AttributeMap[b].name;
+            });
+        }
+
+        UnsignedByte ids[Implementation::MaterialAttributeCount];
+    } sorted;
+    return sorted.ids;
+}
+
 }
 
 UnsignedInt materialTextureSwizzleComponentCount(const MaterialTextureSwizzle swizzle) {
@@ -243,6 +264,8 @@ MaterialData::MaterialData(const MaterialTypes types, Containers::Array<Material
 
         begin = end;
     }
+
+    populateAttributeIds();
 }
 
 MaterialData::MaterialData(const MaterialTypes types, const std::initializer_list<MaterialAttributeData> attributeData, const std::initializer_list<UnsignedInt> layerData, const void* const importerState): MaterialData{types, Implementation::initializerListToArrayWithDefaultDeleter(attributeData), Implementation::initializerListToArrayWithDefaultDeleter(layerData), importerState} {}
@@ -274,10 +297,36 @@ MaterialData::MaterialData(const MaterialTypes types, DataFlags, const Container
         begin = end;
     }
     #endif
+
+    populateAttributeIds();
 }
 
 MaterialData::MaterialData(MaterialData&&) noexcept = default;
 
+void MaterialData::populateAttributeIds() {
+    std::memset(_attributeIds, 0xff, sizeof(_attributeIds));
+
+    /* Both the base layer and the builtin names are sorted, so a single merge
+       pass is enough to find all builtin attributes */
+    const UnsignedByte* const sorted = attributeMapSortedByName();
+    /* After releaseAttributeData() the layer offsets may point outside of the
+       (now empty) attribute array */
+    const std::size_t end = _layerOffsets ?
+        std::min(std::size_t(_layerOffsets[0]), _data.size()) : _data.size();
+    std::size_t i = 0, j = 0;
+    while(i != end && j != Implementation::MaterialAttributeCount) {
+        const Containers::StringView name = _data[i].name();
+        const Containers::StringView builtinName = AttributeMap[sorted[j]].name;
+        if(name < builtinName) ++i;
+        else if(builtinName < name) ++j;
+        else {
+            _attributeIds[sorted[j]] = UnsignedByte(i < 0xfe ? i : 0xfe);
+            ++i;
+            ++j;
+        }
+    }
+}
+
 MaterialData::~MaterialData() = default;
 
 MaterialData& MaterialData::operator=(MaterialData&&) noexcept = default;
@@ -504,6 +553,15 @@ UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const Containers
     return found - begin;
 }
 
+UnsignedInt MaterialData::attributeFor(const UnsignedInt layer, const MaterialAttribute name) const {
+    if(!layer) {
+        const UnsignedByte id = _attributeIds[UnsignedInt(name) - 1];
+        if(id == 0xff) return ~UnsignedInt{};
+        if(id != 0xfe) return id;
+    }
+    return attributeFor(layer, AttributeMap[UnsignedInt(name) - 1].name);
+}
+
 bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::StringView name) const {
     CORRADE_ASSERT(layer < layerCount(),
         "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
@@ -511,9 +569,10 @@ bool MaterialData::hasAttribute(const UnsignedInt layer, const Containers::Strin
 }
 
 bool MaterialData::hasAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
-    return hasAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::hasAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::hasAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    return attributeFor(layer, name) != ~UnsignedInt{};
 }
 
 bool MaterialData::hasAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -553,7 +612,12 @@ UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const Containers:
 UnsignedInt MaterialData::attributeId(const UnsignedInt layer, const MaterialAttribute name) const {
     const Containers::StringView string = attributeString(name);
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeId(): invalid name" << name, {});
-    return attributeId(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeId(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeId(): attribute" << string << "not found in layer" << layer, {});
+    return id;
 }
 
 UnsignedInt MaterialData::attributeId(const Containers::StringView layer, const Containers::StringView name) const {
@@ -627,7 +691,12 @@ MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const
 MaterialAttributeType MaterialData::attributeType(const UnsignedInt layer, const MaterialAttribute name) const {
     const Containers::StringView string = attributeString(name);
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeType(): invalid name" << name, {});
-    return attributeType(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeType(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attributeType(): attribute" << string << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id]._data.type;
 }
 
 MaterialAttributeType MaterialData::attributeType(const Containers::StringView layer, const UnsignedInt id) const {
@@ -693,7 +762,12 @@ const void* MaterialData::attribute(const UnsignedInt layer, const Containers::S
 const void* MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
     const Containers::StringView string = attributeString(name);
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << string << "not found in layer" << layer, {});
+    return _data[layerOffset(layer) + id].value();
 }
 
 const void* MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -764,9 +838,12 @@ const void* MaterialData::tryAttribute(const UnsignedInt layer, const Containers
 }
 
 const void* MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return nullptr;
+    return _data[layerOffset(layer) + id].value();
 }
 #endif
 
@@ -824,12 +901,52 @@ Float MaterialData::alphaMask() const {
     return attributeOr(MaterialAttribute::AlphaMask, 0.5f);
 }
 
+UnsignedInt MaterialData::extractAttributes(const UnsignedInt layer, const Containers::ArrayView<const MaterialAttributeTarget> targets, void* const destination) const {
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::extractAttributes(): index" << layer << "out of range for" << layerCount() << "layers", {});
+
+    const UnsignedInt offset = layerOffset(layer);
+    UnsignedInt count = 0;
+    for(std::size_t i = 0; i != targets.size(); ++i) {
+        const MaterialAttribute name = targets[i].name();
+        CORRADE_ASSERT(attributeString(name).data(),
+            "Trade::MaterialData::extractAttributes(): invalid name" << name << "at index" << i, {});
+        const MaterialAttributeType type = AttributeMap[UnsignedInt(name) - 1].type;
+        CORRADE_ASSERT(type != MaterialAttributeType::String,
+            "Trade::MaterialData::extractAttributes(): can't extract string attribute" << name << "at index" << i, {});
+
+        const UnsignedInt id = attributeFor(layer, name);
+        if(id == ~UnsignedInt{}) continue;
+
+        const MaterialAttributeData& data = _data[offset + id];
+        CORRADE_ASSERT(data._data.type == type,
+            "Trade::MaterialData::extractAttributes(): expected" << type << "for" << name << "but got" << data._data.type, {});
+        std::memcpy(static_cast<char*>(destination) + targets[i].offset(), data.value(), materialAttributeTypeSize(type));
+        ++count;
+    }
+
+    return count;
+}
+
+UnsignedInt MaterialData::extractAttributes(const UnsignedInt layer, const std::initializer_list<MaterialAttributeTarget> targets, void* const destination) const {
+    return extractAttributes(layer, Containers::arrayView(targets), destination);
+}
+
+UnsignedInt MaterialData::extractAttributes(const std::initializer_list<MaterialAttributeTarget> targets, void* const destination) const {
+    return extractAttributes(0, Containers::arrayView(targets), destination);
+}
+
 Containers::Array<UnsignedInt> MaterialData::releaseLayerData() {
-    return std::move(_layerOffsets);
+    Containers::Array<UnsignedInt> out = std::move(_layerOffsets);
+    /* All attributes are now in the base layer */
+    populateAttributeIds();
+    return out;
 }
 
 Containers::Array<MaterialAttributeData> MaterialData::releaseAttributeData() {
-    return std::move(_data);
+    Containers::Array<MaterialAttributeData> out = std::move(_data);
+    populateAttributeIds();
+    return out;
 }
 
 Debug& operator<<(Debug& debug, const MaterialLayer value) {
@@ -1066,7 +1066,12 @@ MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, MaterialAttributeType value)
 
 namespace Implementation {
     template<class> struct MaterialAttributeTypeFor;
-    enum: std::size_t { MaterialAttributeDataSize = 64 };
+    enum: std::size_t {
+        MaterialAttributeDataSize = 64,
+        /* Count of builtin MaterialAttribute values, checked against the
+           actual count in MaterialData.cpp */
+        MaterialAttributeCount = 60
+    };
 }
 
 /**
@@ -1438,6 +1443,45 @@ enum class MaterialAlphaMode: UnsignedByte {
 /** @debugoperatorenum{MaterialAlphaMode} */
 MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, MaterialAlphaMode value);
 
+/**
+@brief Material attribute extraction target
+@m_since_latest
+
+Describes where to put a value of a builtin @ref MaterialAttribute in a
+destination structure when calling @ref MaterialData::extractAttributes(). The
+type and size of the value is implied by the attribute name. See
+@ref Trade-MaterialData-usage-extraction for an example.
+*/
+class MaterialAttributeTarget {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Leaves contents at unspecified values. Provided as a convenience for
+         * initialization of the target array, expected to be replaced with
+         * concrete values later.
+         */
+        constexpr explicit MaterialAttributeTarget() noexcept: _name{}, _offset{} {}
+
+        /**
+         * @brief Constructor
+         * @param name      Attribute name
+         * @param offset    Byte offset of the value in the destination
+         *      structure
+         */
+        constexpr /*implicit*/ MaterialAttributeTarget(MaterialAttribute name, std::size_t offset) noexcept: _name{name}, _offset{offset} {}
+
+        /** @brief Attribute name */
+        constexpr MaterialAttribute name() const { return _name; }
+
+        /** @brief Byte offset of the value in the destination structure */
+        constexpr std::size_t offset() const { return _offset; }
+
+    private:
+        MaterialAttribute _name;
+        std::size_t _offset;
+};
+
 /**
 @brief Material data
 @m_since_latest
@@ -1532,6 +1576,17 @@ accessor APIs. The above can be written in a more compact way using
 
 @snippet MagnumTrade.cpp MaterialData-usage-layers-types
 
+@subsection Trade-MaterialData-usage-extraction Bulk attribute extraction
+
+When translating a large amount of materials to a renderer-specific
+representation, such as uniform buffer contents, querying the attributes one
+by one can be replaced with a single @ref extractAttributes() call. It copies
+values of all listed builtin attributes to given offsets in a destination
+structure and leaves the destination untouched for attributes that aren't
+present, so defaults can be filled in beforehand:
+
+@snippet MagnumTrade.cpp MaterialData-usage-extraction
+
 @section Trade-MaterialData-populating Populating an instance
 
 A @ref MaterialData instance by default takes over ownership of an
@@ -1621,6 +1676,13 @@ half-float types. Conversely, @ref Magnum::Double "Double" types are currently
 not supported either as there isn't currently seen any need for extended
 precision.
 
+Apart from that, the instance contains a table mapping each builtin
+@ref MaterialAttribute to its position in the base material, calculated
+during construction. Thanks to that, querying base material attributes via
+the @ref MaterialAttribute overloads doesn't involve any string comparisons.
+Attributes in other layers and attributes queried by a string name are found
+with a binary search.
+
 @m_class{m-block m-warning}
 
 @par Max representable data size
@@ -2490,6 +2552,43 @@ class MAGNUM_TRADE_EXPORT MaterialData {
             return attributeOr<T>(0, name, defaultValue);
         }/**< @overload */
 
+        /**
+         * @brief Extract attribute values into a structure
+         * @param layer         Layer ID
+         * @param targets       Attribute names and offsets in the destination
+         * @param destination   Destination structure
+         * @return Count of attributes found and copied
+         * @m_since_latest
+         *
+         * For each item in @p targets, if the attribute is present in given
+         * layer, copies its value to @p destination at
+         * @ref MaterialAttributeTarget::offset(). Attributes that aren't
+         * present leave the corresponding destination memory untouched. The
+         * @p layer is expected to be smaller than @ref layerCount() const, the
+         * names are expected to be valid and not of
+         * @ref MaterialAttributeType::String. The attributes, if present, are
+         * expected to have the same type as implied by the name. See
+         * @ref Trade-MaterialData-usage-extraction for an example.
+         */
+        UnsignedInt extractAttributes(UnsignedInt layer, Containers::ArrayView<const MaterialAttributeTarget> targets, void* destination) const;
+
+        /** @overload */
+        UnsignedInt extractAttributes(UnsignedInt layer, std::initializer_list<MaterialAttributeTarget> targets, void* destination) const;
+
+        /**
+         * @brief Extract base material attribute values into a structure
+         * @m_since_latest
+         *
+         * Equivalent to calling @ref extractAttributes(UnsignedInt, Containers::ArrayView<const MaterialAttributeTarget>, void*) const
+         * with @p layer set to @cpp 0 @ce.
+         */
+        UnsignedInt extractAttributes(Containers::ArrayView<const MaterialAttributeTarget> targets, void* destination) const {
+            return extractAttributes(0, targets, destination);
+        }
+
+        /** @overload */
+        UnsignedInt extractAttributes(std::initializer_list<MaterialAttributeTarget> targets, void* destination) const;
+
         /**
          * @brief Whether a material is double-sided
          *
@@ -2586,10 +2685,17 @@ class MAGNUM_TRADE_EXPORT MaterialData {
             return layer && _layerOffsets ? _layerOffsets[layer - 1] : 0;
         }
         UnsignedInt attributeFor(UnsignedInt layer, Containers::StringView name) const;
+        /* Uses the _attributeIds table for the base layer. Expects the name
+           to be valid. */
+        UnsignedInt attributeFor(UnsignedInt layer, MaterialAttribute name) const;
+        void populateAttributeIds();
 
         Containers::Array<MaterialAttributeData> _data;
         Containers::Array<UnsignedInt> _layerOffsets;
         MaterialTypes _types;
+        /* For each builtin attribute its ID in the base layer, 0xff if not
+           present and 0xfe if the ID doesn't fit into a byte */
+        UnsignedByte _attributeIds[Implementation::MaterialAttributeCount];
         const void* _importerState;
 };
 
@@ -2743,7 +2849,12 @@ template<class T> T MaterialData::attribute(const UnsignedInt layer, const Conta
 template<class T> T MaterialData::attribute(const UnsignedInt layer, const MaterialAttribute name) const {
     const Containers::StringView string = attributeString(name);
     CORRADE_ASSERT(string.data(), "Trade::MaterialData::attribute(): invalid name" << name, {});
-    return attribute<T>(layer, string);
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    CORRADE_ASSERT(id != ~UnsignedInt{},
+        "Trade::MaterialData::attribute(): attribute" << string << "not found in layer" << layer, {});
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attribute(const Containers::StringView layer, const UnsignedInt id) const {
@@ -2798,9 +2909,12 @@ template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Unsig
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const UnsignedInt layer, const MaterialAttribute name) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
-    return tryAttribute<T>(layer, string);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::tryAttribute(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::tryAttribute(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return {};
+    return attribute<T>(layer, id);
 }
 
 template<class T> Containers::Optional<T> MaterialData::tryAttribute(const Containers::StringView layer, const Containers::StringView name) const {
@@ -2837,9 +2951,12 @@ template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const Con
 }
 
 template<class T> T MaterialData::attributeOr(const UnsignedInt layer, const MaterialAttribute name, const T& defaultValue) const {
-    const Containers::StringView string = attributeString(name);
-    CORRADE_ASSERT(string.data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
-    return attributeOr<T>(layer, string, defaultValue);
+    CORRADE_ASSERT(attributeString(name).data(), "Trade::MaterialData::attributeOr(): invalid name" << name, {});
+    CORRADE_ASSERT(layer < layerCount(),
+        "Trade::MaterialData::attributeOr(): index" << layer << "out of range for" << layerCount() << "layers", {});
+    const UnsignedInt id = attributeFor(layer, name);
+    if(id == ~UnsignedInt{}) return defaultValue;
+    return attribute<T>(layer, id);
 }
 
 template<class T> T MaterialData::attributeOr(const Containers::StringView layer, const Containers::StringView name, const T& defaultValue) const {
@@ -0,0 +1,588 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MeshCodec.h"
+
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/MeshData.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Both streams start with a header containing a tag byte (which includes the
+   format version), three zero bytes and the vertex count and stride or the
+   index count, in the endianness of the machine that wrote it */
+constexpr UnsignedByte VertexBufferTag = 0xa1;
+constexpr UnsignedByte IndexBufferTag = 0xe1;
+constexpr std::size_t VertexBufferHeaderSize = 12;
+constexpr std::size_t IndexBufferHeaderSize = 8;
+
+/* Vertices are processed in blocks so the decoded block stays in cache while
+   its bytes are written one channel at a time. Each block and each byte of
+   the vertex stores a 2-bit mode for every group of 16 values, four modes per
+   byte, followed by the data of all groups. */
+constexpr std::size_t VertexBlockSize = 256;
+constexpr std::size_t VertexGroupSize = 16;
+constexpr std::size_t VertexGroupDataSize[]{0, 4, 8, 16};
+
+/* Sizes of the recent edge and vertex FIFOs used by the index codec. Codes
+   0xf are reserved in both, so only 15 edges and 14 vertices are
+   addressable. */
+constexpr std::size_t IndexEdgeFifoSize = 16;
+constexpr std::size_t IndexVertexFifoSize = 16;
+
+inline UnsignedByte zigzagEncode(const UnsignedByte delta) {
+    return UnsignedByte((delta << 1) ^ (delta & 0x80 ? 0xff : 0x00));
+}
+
+#ifndef CORRADE_TARGET_SSE2
+inline UnsignedByte zigzagDecode(const UnsignedByte value) {
+    return UnsignedByte((value >> 1) ^ (value & 1 ? 0xff : 0x00));
+}
+
+/* Decodes a group of 16 values in given mode, undoes the zigzag encoding and
+   adds them up to the previous value. Returns the last value, which is the
+   base for the next group. */
+UnsignedByte decodeVertexGroup(const UnsignedByte* const in, const UnsignedInt mode, UnsignedByte previous, UnsignedByte* const out) {
+    for(std::size_t i = 0; i != VertexGroupSize; ++i) {
+        UnsignedByte value;
+        if(mode == 0) value = 0;
+        else if(mode == 1) value = (in[i/4] >> 2*(i%4)) & 0x03;
+        else if(mode == 2) value = (in[i/2] >> 4*(i%2)) & 0x0f;
+        else value = in[i];
+        previous += zigzagDecode(value);
+        out[i] = previous;
+    }
+    return previous;
+}
+#else
+UnsignedByte decodeVertexGroup(const UnsignedByte* const in, const UnsignedInt mode, const UnsignedByte previous, UnsignedByte* const out) {
+    /* Unpack to one value per byte. The 2-bit and 4-bit values are extracted
+       with shifts and masks and then interleaved back to the original
+       order. */
+    __m128i values;
+    if(mode == 0) values = _mm_setzero_si128();
+    else if(mode == 1) {
+        Int packed;
+        std::memcpy(&packed, in, 4);
+        const __m128i data = _mm_cvtsi32_si128(packed);
+        const __m128i mask = _mm_set1_epi8(0x03);
+        const __m128i a = _mm_and_si128(data, mask);
+        const __m128i b = _mm_and_si128(_mm_srli_epi16(data, 2), mask);
+        const __m128i c = _mm_and_si128(_mm_srli_epi16(data, 4), mask);
+        const __m128i d = _mm_and_si128(_mm_srli_epi16(data, 6), mask);
+        values = _mm_unpacklo_epi16(_mm_unpacklo_epi8(a, b), _mm_unpacklo_epi8(c, d));
+    } else if(mode == 2) {
+        const __m128i data = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in));
+        const __m128i mask = _mm_set1_epi8(0x0f);
+        values = _mm_unpacklo_epi8(_mm_and_si128(data, mask), _mm_and_si128(_mm_srli_epi16(data, 4), mask));
+    } else values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+
+    /* Zigzag decode, (value >> 1) ^ -(value & 1). There's no 8-bit shift so
+       a 16-bit one is used and the bit shifted in from the neighbor masked
+       away. */
+    __m128i deltas = _mm_xor_si128(
+        _mm_and_si128(_mm_srli_epi16(values, 1), _mm_set1_epi8(0x7f)),
+        _mm_sub_epi8(_mm_setzero_si128(), _mm_and_si128(values, _mm_set1_epi8(0x01))));
+
+    /* Inclusive prefix sum in four steps, then add the previous value */
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 1));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 2));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 4));
+    deltas = _mm_add_epi8(deltas, _mm_slli_si128(deltas, 8));
+    deltas = _mm_add_epi8(deltas, _mm_set1_epi8(char(previous)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), deltas);
+    return out[VertexGroupSize - 1];
+}
+#endif
+
+bool readVertexBufferHeader(const Containers::ArrayView<const char> data, std::size_t& count, std::size_t& stride) {
+    if(data.size() < VertexBufferHeaderSize || UnsignedByte(data[0]) != VertexBufferTag || data[1] || data[2] || data[3])
+        return false;
+    UnsignedInt values[2];
+    std::memcpy(values, data + 4, 8);
+    count = values[0];
+    stride = values[1];
+    return true;
+}
+
+bool readIndexBufferHeader(const Containers::ArrayView<const char> data, std::size_t& count) {
+    if(data.size() < IndexBufferHeaderSize || UnsignedByte(data[0]) != IndexBufferTag || data[1] || data[2] || data[3])
+        return false;
+    UnsignedInt value;
+    std::memcpy(&value, data + 4, 4);
+    count = value;
+    return true;
+}
+
+void writeHeader(Containers::Array<char>& out, const UnsignedByte tag, const UnsignedInt first, const UnsignedInt second, const std::size_t size) {
+    char header[VertexBufferHeaderSize]{char(tag)};
+    const UnsignedInt values[]{first, second};
+    std::memcpy(header + 4, values, 8);
+    arrayAppend(out, Containers::arrayView(header, size));
+}
+
+/* State of the index codec, shared by the encoder and decoder. The FIFOs
+   are initialized to ~0u, which is an invalid value, so an edge or vertex
+   that wasn't written yet is never matched by the encoder and is detected as
+   invalid by the decoder. */
+struct IndexCodecState {
+    UnsignedInt edges[IndexEdgeFifoSize][2];
+    UnsignedInt vertices[IndexVertexFifoSize];
+    std::size_t edgeOffset = 0, vertexOffset = 0;
+    UnsignedInt next = 0, last = 0;
+
+    explicit IndexCodecState() {
+        for(auto& edge: edges) edge[0] = edge[1] = ~UnsignedInt{};
+        for(UnsignedInt& vertex: vertices) vertex = ~UnsignedInt{};
+    }
+
+    /* Position 0 is the most recently pushed entry */
+    const UnsignedInt* edge(const std::size_t position) const {
+        return edges[(edgeOffset - 1 - position) % IndexEdgeFifoSize];
+    }
+    UnsignedInt vertex(const std::size_t position) const {
+        return vertices[(vertexOffset - 1 - position) % IndexVertexFifoSize];
+    }
+
+    void pushEdge(const UnsignedInt a, const UnsignedInt b) {
+        edges[edgeOffset % IndexEdgeFifoSize][0] = a;
+        edges[edgeOffset % IndexEdgeFifoSize][1] = b;
+        ++edgeOffset;
+    }
+    void pushVertex(const UnsignedInt a) {
+        vertices[vertexOffset % IndexVertexFifoSize] = a;
+        ++vertexOffset;
+    }
+};
+
+/* Returns a 4-bit code for a vertex, updating the state and appending the
+   explicit delta to varints if it's neither the next vertex nor in the
+   FIFO */
+UnsignedByte encodeIndexVertex(IndexCodecState& state, const UnsignedInt vertex, Containers::Array<char>& varints) {
+    if(vertex == state.next) {
+        ++state.next;
+        state.pushVertex(vertex);
+        return 0;
+    }
+
+    for(std::size_t i = 0; i != IndexVertexFifoSize - 2; ++i)
+        if(state.vertex(i) == vertex) return UnsignedByte(i + 1);
+
+    const Int delta = Int(vertex - state.last);
+    UnsignedInt zigzag = (UnsignedInt(delta) << 1) ^ UnsignedInt(delta >> 31);
+    while(zigzag >= 0x80) {
+        arrayAppend(varints, char(0x80|(zigzag & 0x7f)));
+        zigzag >>= 7;
+    }
+    arrayAppend(varints, char(zigzag));
+    state.last = vertex;
+    state.pushVertex(vertex);
+    return 15;
+}
+
+/* Inverse of encodeIndexVertex(). Returns false if the code references an
+   unset FIFO entry or the varint is truncated. */
+bool decodeIndexVertex(IndexCodecState& state, const UnsignedByte code, const UnsignedByte*& in, const UnsignedByte* const end, UnsignedInt& vertex) {
+    if(code == 0) {
+        vertex = state.next++;
+        state.pushVertex(vertex);
+        return true;
+    }
+
+    if(code != 15) {
+        vertex = state.vertex(code - 1);
+        return vertex != ~UnsignedInt{};
+    }
+
+    UnsignedInt zigzag = 0;
+    for(UnsignedInt shift = 0; ; shift += 7) {
+        if(in == end || shift > 28) return false;
+        const UnsignedByte byte = *in++;
+        zigzag |= UnsignedInt(byte & 0x7f) << shift;
+        if(!(byte & 0x80)) break;
+    }
+    vertex = state.last + UnsignedInt(Int(zigzag >> 1) ^ -Int(zigzag & 1));
+    state.last = vertex;
+    state.pushVertex(vertex);
+    return true;
+}
+
+}
+
+Containers::Array<char> encodeVertexBuffer(const Containers::StridedArrayView2D<const char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "Trade::encodeVertexBuffer(): second view dimension is not contiguous", {});
+
+    const std::size_t count = vertices.size()[0];
+    const std::size_t stride = vertices.size()[1];
+    const char* const data = static_cast<const char*>(vertices.data());
+    const std::ptrdiff_t vertexStride = vertices.stride()[0];
+
+    Containers::Array<char> out;
+    arrayReserve(out, VertexBufferHeaderSize + count*stride/2);
+    writeHeader(out, VertexBufferTag, count, stride, VertexBufferHeaderSize);
+
+    /* Previous value of each byte, the first vertex is relative to zero */
+    Containers::Array<UnsignedByte> previous{Containers::ValueInit, stride};
+    UnsignedByte values[VertexBlockSize];
+    for(std::size_t blockBegin = 0; blockBegin < count; blockBegin += VertexBlockSize) {
+        const std::size_t blockSize = Math::min(count - blockBegin, VertexBlockSize);
+        const std::size_t groupCount = (blockSize + VertexGroupSize - 1)/VertexGroupSize;
+
+        for(std::size_t byte = 0; byte != stride; ++byte) {
+            /* Zigzag-encoded deltas, padded with zeros to whole groups */
+            UnsignedByte last = previous[byte];
+            for(std::size_t i = 0; i != blockSize; ++i) {
+                const UnsignedByte value = data[(blockBegin + i)*vertexStride + byte];
+                values[i] = zigzagEncode(UnsignedByte(value - last));
+                last = value;
+            }
+            previous[byte] = last;
+            for(std::size_t i = blockSize; i != groupCount*VertexGroupSize; ++i)
+                values[i] = 0;
+
+            /* Group modes, four in each byte, then data of all groups */
+            const std::size_t modeOffset = out.size();
+            for(char& mode: arrayAppend(out, Containers::NoInit, (groupCount + 3)/4))
+                mode = 0;
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                const UnsignedByte* const groupValues = values + group*VertexGroupSize;
+                UnsignedByte bits = 0;
+                for(std::size_t i = 0; i != VertexGroupSize; ++i)
+                    bits |= groupValues[i];
+
+                UnsignedInt mode;
+                if(!bits) mode = 0;
+                else if(bits < 0x04) mode = 1;
+                else if(bits < 0x10) mode = 2;
+                else mode = 3;
+                out[modeOffset + group/4] |= char(mode << 2*(group%4));
+
+                if(mode == 1) for(std::size_t i = 0; i != 4; ++i)
+                    arrayAppend(out, char(groupValues[i*4 + 0]|
+                                          groupValues[i*4 + 1] << 2|
+                                          groupValues[i*4 + 2] << 4|
+                                          groupValues[i*4 + 3] << 6));
+                else if(mode == 2) for(std::size_t i = 0; i != 8; ++i)
+                    arrayAppend(out, char(groupValues[i*2 + 0]|
+                                          groupValues[i*2 + 1] << 4));
+                else if(mode == 3) arrayAppend(out,
+                    Containers::arrayView(reinterpret_cast<const char*>(groupValues), VertexGroupSize));
+            }
+        }
+    }
+
+    /* Convert back to a default deleter to make the output usable in plugins
+       that get unloaded */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+Containers::Optional<std::pair<std::size_t, std::size_t>> decodedVertexBufferSize(const Containers::ArrayView<const char> data) {
+    std::size_t count, stride;
+    if(!readVertexBufferHeader(data, count, stride)) return {};
+    return std::make_pair(count, stride);
+}
+
+bool decodeVertexBuffer(const Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices) {
+    CORRADE_ASSERT(vertices.isContiguous<1>(),
+        "Trade::decodeVertexBuffer(): second view dimension is not contiguous", {});
+
+    std::size_t count, stride;
+    if(!readVertexBufferHeader(data, count, stride)) {
+        Error{} << "Trade::decodeVertexBuffer(): invalid header";
+        return false;
+    }
+    if(vertices.size()[0] != count || vertices.size()[1] != stride) {
+        Error{} << "Trade::decodeVertexBuffer(): expected" << count << "vertices with" << stride << "bytes each but got" << vertices.size()[0] << "with" << vertices.size()[1];
+        return false;
+    }
+
+    char* const out = static_cast<char*>(vertices.data());
+    const std::ptrdiff_t vertexStride = vertices.stride()[0];
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data()) + VertexBufferHeaderSize;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.end());
+
+    Containers::Array<UnsignedByte> previous{Containers::ValueInit, stride};
+    UnsignedByte values[VertexGroupSize];
+    for(std::size_t blockBegin = 0; blockBegin < count; blockBegin += VertexBlockSize) {
+        const std::size_t blockSize = Math::min(count - blockBegin, VertexBlockSize);
+        const std::size_t groupCount = (blockSize + VertexGroupSize - 1)/VertexGroupSize;
+        const std::size_t modeSize = (groupCount + 3)/4;
+
+        for(std::size_t byte = 0; byte != stride; ++byte) {
+            if(std::size_t(end - in) < modeSize) {
+                Error{} << "Trade::decodeVertexBuffer(): data too short";
+                return false;
+            }
+            const UnsignedByte* const modes = in;
+            in += modeSize;
+
+            /* The padding values at the end of the last group are zero, so
+               the last value of the last group is the last vertex value */
+            UnsignedByte last = previous[byte];
+            for(std::size_t group = 0; group != groupCount; ++group) {
+                const UnsignedInt mode = (modes[group/4] >> 2*(group%4)) & 0x03;
+                if(std::size_t(end - in) < VertexGroupDataSize[mode]) {
+                    Error{} << "Trade::decodeVertexBuffer(): data too short";
+                    return false;
+                }
+                last = decodeVertexGroup(in, mode, last, values);
+                in += VertexGroupDataSize[mode];
+
+                const std::size_t groupBegin = blockBegin + group*VertexGroupSize;
+                const std::size_t groupSize = Math::min(count - groupBegin, VertexGroupSize);
+                for(std::size_t i = 0; i != groupSize; ++i)
+                    out[(groupBegin + i)*vertexStride + byte] = values[i];
+            }
+            previous[byte] = last;
+        }
+    }
+
+    if(in != end) {
+        Error{} << "Trade::decodeVertexBuffer(): expected" << (in - reinterpret_cast<const UnsignedByte*>(data.data())) << "bytes but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+Containers::Array<char> encodeIndexBuffer(const Containers::StridedArrayView1D<const UnsignedInt>& indices) {
+    CORRADE_ASSERT(indices.size() % 3 == 0,
+        "Trade::encodeIndexBuffer(): expected a triangle index count, got" << indices.size(), {});
+
+    Containers::Array<char> out;
+    arrayReserve(out, IndexBufferHeaderSize + indices.size()/2);
+    writeHeader(out, IndexBufferTag, indices.size(), 0, IndexBufferHeaderSize);
+
+    IndexCodecState state;
+    Containers::Array<char> varints;
+    for(std::size_t i = 0; i != indices.size(); i += 3) {
+        const UnsignedInt triangle[]{indices[i], indices[i + 1], indices[i + 2]};
+
+        /* Find a recent edge shared with this triangle. The edges are stored
+           reversed, so a neighbor triangle with the same winding finds them
+           directly. */
+        std::size_t edge = IndexEdgeFifoSize - 1;
+        std::size_t rotation = 0;
+        for(std::size_t position = 0; position != IndexEdgeFifoSize - 1 && edge == IndexEdgeFifoSize - 1; ++position) {
+            const UnsignedInt* const candidate = state.edge(position);
+            for(std::size_t j = 0; j != 3; ++j) {
+                if(candidate[0] == triangle[j] && candidate[1] == triangle[(j + 1)%3]) {
+                    edge = position;
+                    rotation = j;
+                    break;
+                }
+            }
+        }
+
+        arrayResize(varints, 0);
+        if(edge != IndexEdgeFifoSize - 1) {
+            /* Rotate so the shared edge is first, only the third vertex needs
+               to be encoded */
+            const UnsignedInt a = triangle[rotation];
+            const UnsignedInt b = triangle[(rotation + 1)%3];
+            const UnsignedInt c = triangle[(rotation + 2)%3];
+            const UnsignedByte code = encodeIndexVertex(state, c, varints);
+            arrayAppend(out, char(edge << 4|code));
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        } else {
+            const UnsignedByte codeA = encodeIndexVertex(state, triangle[0], varints);
+            const UnsignedByte codeB = encodeIndexVertex(state, triangle[1], varints);
+            const UnsignedByte codeC = encodeIndexVertex(state, triangle[2], varints);
+            arrayAppend(out, char(0xf0|codeA));
+            arrayAppend(out, char(codeB|codeC << 4));
+            state.pushEdge(triangle[1], triangle[0]);
+            state.pushEdge(triangle[2], triangle[1]);
+            state.pushEdge(triangle[0], triangle[2]);
+        }
+        arrayAppend(out, varints);
+    }
+
+    /* Convert back to a default deleter to make the output usable in plugins
+       that get unloaded */
+    arrayShrink(out, Containers::DefaultInit);
+    return out;
+}
+
+Containers::Optional<std::size_t> decodedIndexBufferSize(const Containers::ArrayView<const char> data) {
+    std::size_t count;
+    if(!readIndexBufferHeader(data, count)) return {};
+    return count;
+}
+
+bool decodeIndexBuffer(const Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices) {
+    std::size_t count;
+    if(!readIndexBufferHeader(data, count) || count % 3) {
+        Error{} << "Trade::decodeIndexBuffer(): invalid header";
+        return false;
+    }
+    if(indices.size() != count) {
+        Error{} << "Trade::decodeIndexBuffer(): expected" << count << "indices but got" << indices.size();
+        return false;
+    }
+
+    const UnsignedByte* in = reinterpret_cast<const UnsignedByte*>(data.data()) + IndexBufferHeaderSize;
+    const UnsignedByte* const end = reinterpret_cast<const UnsignedByte*>(data.end());
+
+    IndexCodecState state;
+    for(std::size_t i = 0; i != count; i += 3) {
+        if(in == end) {
+            Error{} << "Trade::decodeIndexBuffer(): data too short";
+            return false;
+        }
+        const UnsignedByte code = *in++;
+        const std::size_t edge = code >> 4;
+
+        UnsignedInt a, b, c;
+        if(edge != IndexEdgeFifoSize - 1) {
+            const UnsignedInt* const shared = state.edge(edge);
+            a = shared[0];
+            b = shared[1];
+            if(a == ~UnsignedInt{} || !decodeIndexVertex(state, code & 0x0f, in, end, c)) {
+                Error{} << "Trade::decodeIndexBuffer(): invalid data for triangle" << i/3;
+                return false;
+            }
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        } else {
+            if(in == end) {
+                Error{} << "Trade::decodeIndexBuffer(): data too short";
+                return false;
+            }
+            const UnsignedByte codes = *in++;
+            if(!decodeIndexVertex(state, code & 0x0f, in, end, a) ||
+               !decodeIndexVertex(state, codes & 0x0f, in, end, b) ||
+               !decodeIndexVertex(state, codes >> 4, in, end, c)) {
+                Error{} << "Trade::decodeIndexBuffer(): invalid data for triangle" << i/3;
+                return false;
+            }
+            state.pushEdge(b, a);
+            state.pushEdge(c, b);
+            state.pushEdge(a, c);
+        }
+
+        indices[i] = a;
+        indices[i + 1] = b;
+        indices[i + 2] = c;
+    }
+
+    if(in != end) {
+        Error{} << "Trade::decodeIndexBuffer(): expected" << (in - reinterpret_cast<const UnsignedByte*>(data.data())) << "bytes but got" << data.size();
+        return false;
+    }
+
+    return true;
+}
+
+Containers::Array<char> encodeVertexData(const MeshData& mesh) {
+    /* Encode per vertex if the data are a single interleaved array with no
+       extra data at the end, otherwise fall back to a sequence of bytes */
+    std::size_t stride = 0;
+    if(mesh.attributeCount() && mesh.vertexCount()) {
+        stride = mesh.attributeStride(0);
+        for(UnsignedInt i = 1; i != mesh.attributeCount() && stride; ++i)
+            if(mesh.attributeStride(i) != stride) stride = 0;
+        if(stride && mesh.vertexData().size() != mesh.vertexCount()*stride)
+            stride = 0;
+    }
+
+    const Containers::ArrayView<const char> data = mesh.vertexData();
+    if(!stride)
+        return encodeVertexBuffer(Containers::StridedArrayView2D<const char>{data, {data.size(), 1}});
+    return encodeVertexBuffer(Containers::StridedArrayView2D<const char>{data, {mesh.vertexCount(), stride}});
+}
+
+Containers::Optional<Containers::Array<char>> decodeVertexData(const Containers::ArrayView<const char> data) {
+    const Containers::Optional<std::pair<std::size_t, std::size_t>> size = decodedVertexBufferSize(data);
+    if(!size) {
+        Error{} << "Trade::decodeVertexData(): invalid header";
+        return {};
+    }
+
+    Containers::Array<char> out{Containers::NoInit, size->first*size->second};
+    if(!decodeVertexBuffer(data, Containers::StridedArrayView2D<char>{Containers::arrayView(out), {size->first, size->second}}))
+        return {};
+    return Containers::optional(std::move(out));
+}
+
+Containers::Array<char> encodeIndexData(const MeshData& mesh) {
+    CORRADE_ASSERT(mesh.isIndexed() && mesh.primitive() == MeshPrimitive::Triangles,
+        "Trade::encodeIndexData(): expected an indexed triangle mesh", {});
+    CORRADE_ASSERT(mesh.indexCount() % 3 == 0,
+        "Trade::encodeIndexData(): expected a triangle index count, got" << mesh.indexCount(), {});
+
+    const Containers::Array<UnsignedInt> indices = mesh.indicesAsArray();
+    return encodeIndexBuffer(Containers::stridedArrayView(indices));
+}
+
+Containers::Optional<Containers::Array<char>> decodeIndexData(const Containers::ArrayView<const char> data, const MeshIndexType type) {
+    const Containers::Optional<std::size_t> count = decodedIndexBufferSize(data);
+    if(!count) {
+        Error{} << "Trade::decodeIndexData(): invalid header";
+        return {};
+    }
+
+    /* 32-bit indices are decoded directly into the output */
+    Containers::Array<char> out{Containers::NoInit, *count*meshIndexTypeSize(type)};
+    if(type == MeshIndexType::UnsignedInt) {
+        if(!decodeIndexBuffer(data, Containers::stridedArrayView(Containers::arrayCast<UnsignedInt>(out))))
+            return {};
+        return Containers::optional(std::move(out));
+    }
+
+    /* Otherwise narrow to the requested type, checking that all indices fit */
+    Containers::Array<UnsignedInt> indices{Containers::NoInit, *count};
+    if(!decodeIndexBuffer(data, Containers::stridedArrayView(indices)))
+        return {};
+    const UnsignedInt max = type == MeshIndexType::UnsignedShort ? 0xffff : 0xff;
+    for(std::size_t i = 0; i != indices.size(); ++i) {
+        if(indices[i] > max) {
+            Error{} << "Trade::decodeIndexData(): index" << indices[i] << "doesn't fit into" << type;
+            return {};
+        }
+        if(type == MeshIndexType::UnsignedShort)
+            reinterpret_cast<UnsignedShort*>(out.data())[i] = indices[i];
+        else
+            reinterpret_cast<UnsignedByte*>(out.data())[i] = indices[i];
+    }
+
+    return Containers::optional(std::move(out));
+}
+
+}}
@@ -0,0 +1,193 @@
+#ifndef Magnum_Trade_MeshCodec_h
+#define Magnum_Trade_MeshCodec_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Function @ref Magnum::Trade::encodeVertexBuffer(), @ref Magnum::Trade::decodeVertexBuffer(), @ref Magnum::Trade::encodeIndexBuffer(), @ref Magnum::Trade::decodeIndexBuffer(), @ref Magnum::Trade::encodeVertexData(), @ref Magnum::Trade::decodeVertexData(), @ref Magnum::Trade::encodeIndexData(), @ref Magnum::Trade::decodeIndexData()
+ * @m_since_latest
+ */
+
+#include <utility>
+#include <Corrade/Containers/Containers.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Trade.h"
+#include "Magnum/Trade/visibility.h"
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Encode a vertex buffer
+@param vertices     Vertex data. First dimension is the vertices, second
+    dimension is the bytes of each vertex. The second dimension is expected to
+    be contiguous.
+@m_since_latest
+
+Produces a lossless, byte-oriented encoding of the vertex data that's
+typically a fraction of the original size, especially when vertices close to
+each other in memory have similar values, such as after a vertex cache
+optimization. Each byte of the vertex is encoded separately as a difference
+to the same byte of the previous vertex, zigzag-encoded so small negative
+differences are small as well and then packed in groups of 16 using either 0,
+2, 4 or 8 bits per value, whichever is the smallest that fits the whole
+group. The output doesn't depend on the platform the encoding is done on.
+
+Decode the data back with @ref decodeVertexBuffer(), use
+@ref decodedVertexBufferSize() to query the size of the original data. For
+encoding vertex data of a whole @ref MeshData see @ref encodeVertexData().
+@see @ref encodeIndexBuffer()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<char> encodeVertexBuffer(const Containers::StridedArrayView2D<const char>& vertices);
+
+/**
+@brief Vertex count and stride of an encoded vertex buffer
+@m_since_latest
+
+Expects that @p data is an output of @ref encodeVertexBuffer(). Returns the
+vertex count and stride, or @ref Containers::NullOpt if the data are too short
+or don't contain a valid header. Doesn't print any message in that case and
+doesn't validate the encoded data itself, that's done only in
+@ref decodeVertexBuffer().
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<std::pair<std::size_t, std::size_t>> decodedVertexBufferSize(Containers::ArrayView<const char> data);
+
+/**
+@brief Decode a vertex buffer
+@param[in] data         Data produced by @ref encodeVertexBuffer()
+@param[out] vertices    Where to put the decoded vertices
+@m_since_latest
+
+The @p vertices view is expected to have the size returned by
+@ref decodedVertexBufferSize() and a contiguous second dimension. If the data
+are invalid or the size doesn't match, prints a message to
+@relativeref{Magnum,Error} and returns @cpp false @ce, the contents of
+@p vertices are unspecified in that case. On platforms with SSE2 the groups
+are decoded with SIMD instructions.
+*/
+MAGNUM_TRADE_EXPORT bool decodeVertexBuffer(Containers::ArrayView<const char> data, const Containers::StridedArrayView2D<char>& vertices);
+
+/**
+@brief Encode a triangle index buffer
+@param indices      Triangle indices
+@m_since_latest
+
+Expects that the index count is divisible by three. Each triangle is encoded
+using a single byte in the common case, referencing either an edge of one of
+the recently encoded triangles, a recently used vertex or the next vertex
+that wasn't referenced yet. The remaining cases are encoded as a variable-length
+difference to the last such vertex. This works best if the indices were
+optimized for vertex cache locality and vertices were ordered by their first
+use, such as after @ref MeshTools::tipsifyInPlace().
+
+Decode the data back with @ref decodeIndexBuffer(), use
+@ref decodedIndexBufferSize() to query the index count. For encoding index
+data of a whole @ref MeshData see @ref encodeIndexData().
+
+@attention The decoded triangles can have their vertices rotated, for example
+    a triangle @cpp {3, 5, 4} @ce may be decoded as @cpp {5, 4, 3} @ce.
+    The winding order and the order of triangles is preserved.
+
+@see @ref encodeVertexBuffer()
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<char> encodeIndexBuffer(const Containers::StridedArrayView1D<const UnsignedInt>& indices);
+
+/**
+@brief Index count of an encoded index buffer
+@m_since_latest
+
+Expects that @p data is an output of @ref encodeIndexBuffer(). Returns the
+index count, or @ref Containers::NullOpt if the data are too short or don't
+contain a valid header. Doesn't print any message in that case and doesn't
+validate the encoded data itself, that's done only in
+@ref decodeIndexBuffer().
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<std::size_t> decodedIndexBufferSize(Containers::ArrayView<const char> data);
+
+/**
+@brief Decode a triangle index buffer
+@param[in] data         Data produced by @ref encodeIndexBuffer()
+@param[out] indices     Where to put the decoded indices
+@m_since_latest
+
+The @p indices view is expected to have the size returned by
+@ref decodedIndexBufferSize(). If the data are invalid or the size doesn't
+match, prints a message to @relativeref{Magnum,Error} and returns
+@cpp false @ce, the contents of @p indices are unspecified in that case.
+*/
+MAGNUM_TRADE_EXPORT bool decodeIndexBuffer(Containers::ArrayView<const char> data, const Containers::StridedArrayView1D<UnsignedInt>& indices);
+
+/**
+@brief Encode vertex data of a mesh
+@m_since_latest
+
+Calls @ref encodeVertexBuffer() on @ref MeshData::vertexData(). If all
+attributes share the same positive stride and the vertex data size matches
+the vertex count multiplied by it, the data are encoded per vertex, otherwise
+they're treated as a sequence of bytes, which compresses considerably worse.
+Attributes that aren't interleaved can be made so using
+@ref MeshTools::interleave(). The output can be decoded back with
+@ref decodeVertexData(), the attribute offsets and strides stay the same.
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<char> encodeVertexData(const MeshData& mesh);
+
+/**
+@brief Decode vertex data of a mesh
+@m_since_latest
+
+Decodes data produced by @ref encodeVertexData() to a newly allocated array.
+If the data are invalid, prints a message to @relativeref{Magnum,Error} and
+returns @ref Containers::NullOpt.
+@see @ref decodeVertexBuffer()
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> decodeVertexData(Containers::ArrayView<const char> data);
+
+/**
+@brief Encode index data of a mesh
+@m_since_latest
+
+Expects that the mesh is indexed and its primitive is
+@ref MeshPrimitive::Triangles. Calls @ref encodeIndexBuffer() on
+@ref MeshData::indicesAsArray(), the index type and any data outside of the
+index range are not preserved. The output can be decoded back with
+@ref decodeIndexData().
+*/
+MAGNUM_TRADE_EXPORT Containers::Array<char> encodeIndexData(const MeshData& mesh);
+
+/**
+@brief Decode index data of a mesh
+@m_since_latest
+
+Decodes data produced by @ref encodeIndexData() to a newly allocated array of
+given @p type. If the data are invalid or any of the decoded indices doesn't
+fit into @p type, prints a message to @relativeref{Magnum,Error} and returns
+@ref Containers::NullOpt.
+@see @ref decodeIndexBuffer()
+*/
+MAGNUM_TRADE_EXPORT Containers::Optional<Containers::Array<char>> decodeIndexData(Containers::ArrayView<const char> data, MeshIndexType type);
+
+}}
+
+#endif
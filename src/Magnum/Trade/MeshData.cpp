@@ -36,6 +36,19 @@
 
 namespace Magnum { namespace Trade {
 
+#ifndef CORRADE_NO_ASSERT
+namespace {
+
+/* Suffix for assertion messages about morph target attributes, empty for
+   attributes that aren't a morph target */
+std::string morphTargetString(const Int morphTargetId) {
+    return morphTargetId == -1 ? std::string{} :
+        Utility::format(" in morph target {}", morphTargetId);
+}
+
+}
+#endif
+
 MeshIndexData::MeshIndexData(const MeshIndexType type, const Containers::ArrayView<const void> data) noexcept: _type{type}, _data{data} {
     /* Yes, this calls into a constexpr function defined in the header --
        because I feel that makes more sense than duplicating the full assert
@@ -60,7 +73,7 @@ MeshIndexData::MeshIndexData(const Containers::StridedArrayView2D<const char>& d
     _data = data.asContiguous();
 }
 
-MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize) noexcept: MeshAttributeData{nullptr, name, format, data, arraySize} {
+MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize, const Int morphTargetId) noexcept: MeshAttributeData{nullptr, name, format, data, arraySize, morphTargetId} {
     /* Yes, this calls into a constexpr function defined in the header --
        because I feel that makes more sense than duplicating the full assert
        logic */
@@ -69,7 +82,7 @@ MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexForma
         "Trade::MeshAttributeData: expected stride to be positive and enough to fit" << format << Debug::nospace << (arraySize ? Utility::format("[{}]", arraySize).data() : "") << Debug::nospace << ", got" << data.stride(), );
 }
 
-MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView2D<const char>& data, UnsignedShort arraySize) noexcept: MeshAttributeData{nullptr, name, format, Containers::StridedArrayView1D<const void>{{data.data(), ~std::size_t{}}, data.size()[0], data.stride()[0]}, arraySize} {
+MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView2D<const char>& data, UnsignedShort arraySize, const Int morphTargetId) noexcept: MeshAttributeData{nullptr, name, format, Containers::StridedArrayView1D<const void>{{data.data(), ~std::size_t{}}, data.size()[0], data.stride()[0]}, arraySize, morphTargetId} {
     /* Yes, this calls into a constexpr function defined in the header --
        because I feel that makes more sense than duplicating the full assert
        logic */
@@ -268,7 +281,7 @@ MeshAttributeData MeshData::attributeData(UnsignedInt id) const {
     CORRADE_ASSERT(id < _attributes.size(),
         "Trade::MeshData::attributeData(): index" << id << "out of range for" << _attributes.size() << "attributes", MeshAttributeData{});
     const MeshAttributeData& attribute = _attributes[id];
-    return MeshAttributeData{attribute._name, attribute._format, attributeDataViewInternal(attribute)};
+    return MeshAttributeData{attribute._name, attribute._format, attributeDataViewInternal(attribute), attribute._arraySize, attribute._morphTargetId};
 }
 
 MeshAttribute MeshData::attributeName(UnsignedInt id) const {
@@ -302,16 +315,29 @@ UnsignedShort MeshData::attributeArraySize(UnsignedInt id) const {
     return _attributes[id]._arraySize;
 }
 
-UnsignedInt MeshData::attributeCount(const MeshAttribute name) const {
+Int MeshData::attributeMorphTargetId(UnsignedInt id) const {
+    CORRADE_ASSERT(id < _attributes.size(),
+        "Trade::MeshData::attributeMorphTargetId(): index" << id << "out of range for" << _attributes.size() << "attributes", {});
+    return _attributes[id]._morphTargetId;
+}
+
+UnsignedInt MeshData::morphTargetCount() const {
+    Int max = -1;
+    for(const MeshAttributeData& attribute: _attributes)
+        if(attribute._morphTargetId > max) max = attribute._morphTargetId;
+    return max + 1;
+}
+
+UnsignedInt MeshData::attributeCount(const MeshAttribute name, const Int morphTargetId) const {
     UnsignedInt count = 0;
     for(const MeshAttributeData& attribute: _attributes)
-        if(attribute._name == name) ++count;
+        if(attribute._name == name && attribute._morphTargetId == morphTargetId) ++count;
     return count;
 }
 
-UnsignedInt MeshData::attributeFor(const MeshAttribute name, UnsignedInt id) const {
+UnsignedInt MeshData::attributeFor(const MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
     for(std::size_t i = 0; i != _attributes.size(); ++i) {
-        if(_attributes[i]._name != name) continue;
+        if(_attributes[i]._name != name || _attributes[i]._morphTargetId != morphTargetId) continue;
         if(id-- == 0) return i;
     }
 
@@ -322,33 +348,33 @@ UnsignedInt MeshData::attributeFor(const MeshAttribute name, UnsignedInt id) con
     #endif
 }
 
-UnsignedInt MeshData::attributeId(const MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeId(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+UnsignedInt MeshData::attributeId(const MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeId(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attributeId;
 }
 
-VertexFormat MeshData::attributeFormat(MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeFormat(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+VertexFormat MeshData::attributeFormat(MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeFormat(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attributeFormat(attributeId);
 }
 
-std::size_t MeshData::attributeOffset(MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeOffset(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+std::size_t MeshData::attributeOffset(MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeOffset(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attributeOffset(attributeId);
 }
 
-UnsignedInt MeshData::attributeStride(MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeStride(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+UnsignedInt MeshData::attributeStride(MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeStride(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attributeStride(attributeId);
 }
 
-UnsignedShort MeshData::attributeArraySize(MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeArraySize(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+UnsignedShort MeshData::attributeArraySize(MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attributeArraySize(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attributeArraySize(attributeId);
 }
 
@@ -396,17 +422,17 @@ Containers::StridedArrayView2D<char> MeshData::mutableAttribute(UnsignedInt id)
         out.size(), out.stride()};
 }
 
-Containers::StridedArrayView2D<const char> MeshData::attribute(MeshAttribute name, UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attribute(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+Containers::StridedArrayView2D<const char> MeshData::attribute(MeshAttribute name, UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::attribute(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return attribute(attributeId);
 }
 
-Containers::StridedArrayView2D<char> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id) {
+Containers::StridedArrayView2D<char> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id, const Int morphTargetId) {
     CORRADE_ASSERT(_vertexDataFlags & DataFlag::Mutable,
         "Trade::MeshData::mutableAttribute(): vertex data not mutable", {});
-    const UnsignedInt attributeId = attributeFor(name, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::mutableAttribute(): index" << id << "out of range for" << attributeCount(name) << name << "attributes", {});
+    const UnsignedInt attributeId = attributeFor(name, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::mutableAttribute(): index" << id << "out of range for" << attributeCount(name, morphTargetId) << name << "attributes" << Debug::nospace << morphTargetString(morphTargetId), {});
     return mutableAttribute(attributeId);
 }
 
@@ -434,9 +460,9 @@ Containers::Array<UnsignedInt> MeshData::indicesAsArray() const {
     return output;
 }
 
-void MeshData::positions2DInto(const Containers::StridedArrayView1D<Vector2> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Position, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position) << "position attributes", );
+void MeshData::positions2DInto(const Containers::StridedArrayView1D<Vector2> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Position, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position, morphTargetId) << "position attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::positions2DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -478,15 +504,15 @@ void MeshData::positions2DInto(const Containers::StridedArrayView1D<Vector2> des
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
-Containers::Array<Vector2> MeshData::positions2DAsArray(const UnsignedInt id) const {
+Containers::Array<Vector2> MeshData::positions2DAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector2> out{_vertexCount};
-    positions2DInto(out, id);
+    positions2DInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Position, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions3DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position) << "position attributes", );
+void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Position, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::positions3DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Position, morphTargetId) << "position attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::positions3DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -559,9 +585,9 @@ void MeshData::positions3DInto(const Containers::StridedArrayView1D<Vector3> des
     }
 }
 
-Containers::Array<Vector3> MeshData::positions3DAsArray(const UnsignedInt id) const {
+Containers::Array<Vector3> MeshData::positions3DAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector3> out{_vertexCount};
-    positions3DInto(out, id);
+    positions3DInto(out, id, morphTargetId);
     return out;
 }
 
@@ -583,9 +609,9 @@ void tangentsOrNormalsInto(const Containers::StridedArrayView1D<const void> attr
 
 }
 
-void MeshData::tangentsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Tangent, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::tangentsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Tangent) << "tangent attributes", );
+void MeshData::tangentsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Tangent, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::tangentsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Tangent, morphTargetId) << "tangent attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::tangentsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -606,15 +632,15 @@ void MeshData::tangentsInto(const Containers::StridedArrayView1D<Vector3> destin
     tangentsOrNormalsInto(attributeDataViewInternal(attribute), destination, format);
 }
 
-Containers::Array<Vector3> MeshData::tangentsAsArray(const UnsignedInt id) const {
+Containers::Array<Vector3> MeshData::tangentsAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector3> out{_vertexCount};
-    tangentsInto(out, id);
+    tangentsInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::bitangentSignsInto(const Containers::StridedArrayView1D<Float> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Tangent, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::bitangentSignsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Tangent) << "tangent attributes", );
+void MeshData::bitangentSignsInto(const Containers::StridedArrayView1D<Float> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Tangent, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::bitangentSignsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Tangent, morphTargetId) << "tangent attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::bitangentSignsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -633,15 +659,15 @@ void MeshData::bitangentSignsInto(const Containers::StridedArrayView1D<Float> de
     else CORRADE_ASSERT_UNREACHABLE("Trade::MeshData::bitangentSignsInto(): expected four-component tangents, but got" << attribute._format, );
 }
 
-Containers::Array<Float> MeshData::bitangentSignsAsArray(const UnsignedInt id) const {
+Containers::Array<Float> MeshData::bitangentSignsAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Float> out{_vertexCount};
-    bitangentSignsInto(out, id);
+    bitangentSignsInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::bitangentsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Bitangent, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::bitangentsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Bitangent) << "bitangent attributes", );
+void MeshData::bitangentsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Bitangent, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::bitangentsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Bitangent, morphTargetId) << "bitangent attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::bitangentsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -649,15 +675,15 @@ void MeshData::bitangentsInto(const Containers::StridedArrayView1D<Vector3> dest
     tangentsOrNormalsInto(attributeDataViewInternal(attribute), destination, attribute._format);
 }
 
-Containers::Array<Vector3> MeshData::bitangentsAsArray(const UnsignedInt id) const {
+Containers::Array<Vector3> MeshData::bitangentsAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector3> out{_vertexCount};
-    bitangentsInto(out, id);
+    bitangentsInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::normalsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Normal, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::normalsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Normal) << "normal attributes", );
+void MeshData::normalsInto(const Containers::StridedArrayView1D<Vector3> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Normal, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::normalsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Normal, morphTargetId) << "normal attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::normalsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -665,15 +691,15 @@ void MeshData::normalsInto(const Containers::StridedArrayView1D<Vector3> destina
     tangentsOrNormalsInto(attributeDataViewInternal(attribute), destination, attribute._format);
 }
 
-Containers::Array<Vector3> MeshData::normalsAsArray(const UnsignedInt id) const {
+Containers::Array<Vector3> MeshData::normalsAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector3> out{_vertexCount};
-    normalsInto(out, id);
+    normalsInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::TextureCoordinates, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::textureCoordinates2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::TextureCoordinates) << "texture coordinate attributes", );
+void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vector2> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::TextureCoordinates, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::textureCoordinates2DInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::TextureCoordinates, morphTargetId) << "texture coordinate attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::textureCoordinates2DInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -704,15 +730,15 @@ void MeshData::textureCoordinates2DInto(const Containers::StridedArrayView1D<Vec
     else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
-Containers::Array<Vector2> MeshData::textureCoordinates2DAsArray(const UnsignedInt id) const {
+Containers::Array<Vector2> MeshData::textureCoordinates2DAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Vector2> out{_vertexCount};
-    textureCoordinates2DInto(out, id);
+    textureCoordinates2DInto(out, id, morphTargetId);
     return out;
 }
 
-void MeshData::colorsInto(const Containers::StridedArrayView1D<Color4> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::Color, id);
-    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::colorsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Color) << "color attributes", );
+void MeshData::colorsInto(const Containers::StridedArrayView1D<Color4> destination, const UnsignedInt id, const Int morphTargetId) const {
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::Color, id, morphTargetId);
+    CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::colorsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::Color, morphTargetId) << "color attributes" << Debug::nospace << morphTargetString(morphTargetId), );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::colorsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
     CORRADE_ASSERT(!isVertexFormatImplementationSpecific(attribute._format),
@@ -757,14 +783,14 @@ void MeshData::colorsInto(const Containers::StridedArrayView1D<Color4> destinati
     }
 }
 
-Containers::Array<Color4> MeshData::colorsAsArray(const UnsignedInt id) const {
+Containers::Array<Color4> MeshData::colorsAsArray(const UnsignedInt id, const Int morphTargetId) const {
     Containers::Array<Color4> out{_vertexCount};
-    colorsInto(out, id);
+    colorsInto(out, id, morphTargetId);
     return out;
 }
 
 void MeshData::objectIdsInto(const Containers::StridedArrayView1D<UnsignedInt> destination, const UnsignedInt id) const {
-    const UnsignedInt attributeId = attributeFor(MeshAttribute::ObjectId, id);
+    const UnsignedInt attributeId = attributeFor(MeshAttribute::ObjectId, id, -1);
     CORRADE_ASSERT(attributeId != ~UnsignedInt{}, "Trade::MeshData::objectIdsInto(): index" << id << "out of range for" << attributeCount(MeshAttribute::ObjectId) << "object ID attributes", );
     CORRADE_ASSERT(destination.size() == _vertexCount, "Trade::MeshData::objectIdsInto(): expected a view with" << _vertexCount << "elements but got" << destination.size(), );
     const MeshAttributeData& attribute = _attributes[attributeId];
@@ -339,7 +339,7 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * initialization of the attribute array for @ref MeshData, expected to
          * be replaced with concrete values later.
          */
-        constexpr explicit MeshAttributeData() noexcept: _format{}, _name{}, _isOffsetOnly{false}, _vertexCount{}, _stride{}, _arraySize{}, _data{} {}
+        constexpr explicit MeshAttributeData() noexcept: _format{}, _name{}, _isOffsetOnly{false}, _morphTargetId{-1}, _vertexCount{}, _stride{}, _arraySize{}, _data{} {}
 
         /**
          * @brief Type-erased constructor
@@ -348,12 +348,17 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * @param data      Attribute data
          * @param arraySize Array size. Use @cpp 0 @ce for non-array
          *      attributes.
+         * @param morphTargetId Morph target ID. Use @cpp -1 @ce for
+         *      attributes that aren't a morph target.
          *
          * Expects that @p data stride is large enough to fit all @p arraySize
          * items of @p type, @p type corresponds to @p name and @p arraySize is
-         * zero for builtin attributes.
+         * zero for builtin attributes. The @p morphTargetId is expected to be
+         * either @cpp -1 @ce or less than @cpp 128 @ce and @p name to be
+         * allowed as a morph target, see @ref Trade-MeshData-morph-targets for
+         * more information.
          */
-        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize = 0) noexcept;
+        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize = 0, Int morphTargetId = -1) noexcept;
 
         /**
          * @brief Constructor
@@ -362,23 +367,27 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * @param data      Attribute data
          * @param arraySize Array size. Use @cpp 0 @ce for non-array
          *      attributes.
+         * @param morphTargetId Morph target ID. Use @cpp -1 @ce for
+         *      attributes that aren't a morph target.
          *
          * Expects that the second dimension of @p data is contiguous and its
          * size matches @p type and @p arraSize, that @p type corresponds to
          * @p name and @p arraySize is zero for builtin attributes.
          */
-        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, const Containers::StridedArrayView2D<const char>& data, UnsignedShort arraySize = 0) noexcept;
+        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, const Containers::StridedArrayView2D<const char>& data, UnsignedShort arraySize = 0, Int morphTargetId = -1) noexcept;
 
         /** @overload */
-        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, std::nullptr_t, UnsignedShort arraySize = 0) noexcept: MeshAttributeData{nullptr, name, format, nullptr, arraySize} {}
+        explicit MeshAttributeData(MeshAttribute name, VertexFormat format, std::nullptr_t, UnsignedShort arraySize = 0, Int morphTargetId = -1) noexcept: MeshAttributeData{nullptr, name, format, nullptr, arraySize, morphTargetId} {}
 
         /**
          * @brief Constructor
          * @param name      Attribute name
          * @param data      Attribute data
+         * @param morphTargetId Morph target ID. Use @cpp -1 @ce for
+         *      attributes that aren't a morph target.
          *
          * Detects @ref VertexFormat based on @p T and calls
-         * @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort).
+         * @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort, Int).
          * For most types known by Magnum, the detected @ref VertexFormat is of
          * the same name as the type (so e.g. @ref Magnum::Vector3ui "Vector3ui"
          * gets recognized as @ref VertexFormat::Vector3ui), with the
@@ -409,25 +418,27 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * @todo Pick a type based on the combination of T and name? E.g., for
          *      a Tangent it would pick Vector3sNormalized instead of Vector3s
          */
-        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView1D<T>& data) noexcept;
+        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView1D<T>& data, Int morphTargetId = -1) noexcept;
 
         /** @overload */
-        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::ArrayView<T>& data) noexcept: MeshAttributeData{name, Containers::stridedArrayView(data)} {}
+        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::ArrayView<T>& data, Int morphTargetId = -1) noexcept: MeshAttributeData{name, Containers::stridedArrayView(data), morphTargetId} {}
 
         /**
          * @brief Construct an array attribute
          * @param name      Attribute name
          * @param data      Attribute data
+         * @param morphTargetId Morph target ID. Use @cpp -1 @ce for
+         *      attributes that aren't a morph target.
          *
          * Detects @ref VertexFormat based on @p T and calls
-         * @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort)
+         * @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort, Int)
          * with the second dimension size passed to @p arraySize. Expects that
          * the second dimension is contiguous. At the moment only custom
          * attributes can be arrays, which means this function can't be used
          * with a builtin @p name. See @ref MeshAttributeData(MeshAttribute, const Containers::StridedArrayView1D<T>&)
          * for details about @ref VertexFormat detection.
          */
-        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView2D<T>& data) noexcept;
+        template<class T> constexpr explicit MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView2D<T>& data, Int morphTargetId = -1) noexcept;
 
         /**
          * @brief Construct an offset-only attribute
@@ -438,6 +449,8 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * @param stride        Attribute stride
          * @param arraySize     Array size. Use @cpp 0 @ce for non-array
          *      attributes.
+         * @param morphTargetId Morph target ID. Use @cpp -1 @ce for
+         *      attributes that aren't a morph target.
          *
          * Instances created this way refer to an offset in unspecified
          * external vertex data instead of containing the data view directly.
@@ -452,12 +465,12 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          *
          * Note that due to the @cpp constexpr @ce nature of this constructor,
          * no @p format / @p arraySize checks against @p stride can be done.
-         * You're encouraged to use the @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort)
+         * You're encouraged to use the @ref MeshAttributeData(MeshAttribute, VertexFormat, const Containers::StridedArrayView1D<const void>&, UnsignedShort, Int)
          * constructor if you want additional safeguards.
-         * @see @ref isOffsetOnly(), @ref arraySize(),
+         * @see @ref isOffsetOnly(), @ref arraySize(), @ref morphTargetId(),
          *      @ref data(Containers::ArrayView<const void>) const
          */
-        explicit constexpr MeshAttributeData(MeshAttribute name, VertexFormat format, std::size_t offset, UnsignedInt vertexCount, std::ptrdiff_t stride, UnsignedShort arraySize = 0) noexcept;
+        explicit constexpr MeshAttributeData(MeshAttribute name, VertexFormat format, std::size_t offset, UnsignedInt vertexCount, std::ptrdiff_t stride, UnsignedShort arraySize = 0, Int morphTargetId = -1) noexcept;
 
         /**
          * @brief Construct a pad value
@@ -468,7 +481,7 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * passed to @ref MeshData.
          * @see @ref stride()
          */
-        constexpr explicit MeshAttributeData(Int padding): _format{}, _name{}, _isOffsetOnly{false}, _vertexCount{0}, _stride{
+        constexpr explicit MeshAttributeData(Int padding): _format{}, _name{}, _isOffsetOnly{false}, _morphTargetId{-1}, _vertexCount{0}, _stride{
             (CORRADE_CONSTEXPR_ASSERT(padding >= -32768 && padding <= 32767,
                 "Trade::MeshAttributeData: at most 32k padding supported, got" << padding), Short(padding))
         }, _arraySize{}, _data{nullptr} {}
@@ -479,7 +492,7 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
          * Returns @cpp true @ce if the attribute doesn't contain the data view
          * directly, but instead refers to unspecified external vertex data.
          * @see @ref data(Containers::ArrayView<const void>) const,
-         *      @ref MeshAttributeData(MeshAttribute, VertexFormat, std::size_t, UnsignedInt, std::ptrdiff_t, UnsignedShort)
+         *      @ref MeshAttributeData(MeshAttribute, VertexFormat, std::size_t, UnsignedInt, std::ptrdiff_t, UnsignedShort, Int)
          */
         constexpr bool isOffsetOnly() const { return _isOffsetOnly; }
 
@@ -511,6 +524,15 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
         /** @brief Attribute array size */
         constexpr UnsignedShort arraySize() const { return _arraySize; }
 
+        /**
+         * @brief Attribute morph target ID
+         * @m_since_latest
+         *
+         * Returns @cpp -1 @ce if the attribute isn't a morph target.
+         * @see @ref Trade-MeshData-morph-targets
+         */
+        constexpr Int morphTargetId() const { return _morphTargetId; }
+
         /**
          * @brief Type-erased attribute data
          *
@@ -545,13 +567,15 @@ class MAGNUM_TRADE_EXPORT MeshAttributeData {
         friend MeshData;
 
         /* nullptr first, to avoid accidental matches as much as possible */
-        constexpr explicit MeshAttributeData(std::nullptr_t, MeshAttribute name, VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize) noexcept;
+        constexpr explicit MeshAttributeData(std::nullptr_t, MeshAttribute name, VertexFormat format, const Containers::StridedArrayView1D<const void>& data, UnsignedShort arraySize, Int morphTargetId) noexcept;
 
         VertexFormat _format;
         MeshAttribute _name;
         bool _isOffsetOnly;
-        /* 1 byte free for more stuff on 64b (23, aligned to 24) and on 32b
-           (19, aligned to 20) */
+        /* -1 for attributes that aren't a morph target, which is why it's
+           limited to 128 morph targets. Takes the last free byte (24 bytes on
+           64b, 20 bytes on 32b). */
+        Byte _morphTargetId;
 
         /* Vertex count in MeshData is currently 32-bit, so this doesn't need
            to be 64-bit either */
@@ -600,7 +624,7 @@ The simplest usage is through the convenience functions @ref positions2DAsArray(
 @ref colorsAsArray() and @ref objectIdsAsArray(). Each of these takes an index
 (as there can be multiple sets of texture coordinates, for example) and you're
 expected to check for attribute presence first with either @ref hasAttribute()
-or @ref attributeCount(MeshAttribute) const:
+or @ref attributeCount(MeshAttribute, Int) const:
 
 @snippet MagnumTrade.cpp MeshData-usage
 
@@ -693,6 +717,31 @@ you can also supply implementation-specific values that are not available in
 the generic @ref MeshPrimitive enum, similarly see also
 @ref Trade-MeshAttributeData-custom-vertex-format for details on
 implementation-specific @ref VertexFormat values.
+
+@section Trade-MeshData-morph-targets Morph targets
+
+Attributes can be additionally marked as belonging to a morph target (also
+called a blend shape) by passing a non-negative morph target ID to
+@ref MeshAttributeData. Such attributes contain per-vertex deltas that are
+added to the base attribute of the same name, scaled by a per-target weight
+--- usually coming from an animation. Only @ref MeshAttribute::Position,
+@ref MeshAttribute::Tangent, @ref MeshAttribute::Bitangent,
+@ref MeshAttribute::Normal, @ref MeshAttribute::TextureCoordinates,
+@ref MeshAttribute::Color and custom attributes can be morph targets and at
+most 128 morph targets are supported.
+
+The delta streams live alongside the base attributes in the same
+@ref vertexData(). All named accessors such as @ref hasAttribute(),
+@ref attributeCount(MeshAttribute, Int) const,
+@ref attribute(MeshAttribute, UnsignedInt, Int) const or
+@ref positions3DAsArray() take an optional morph target ID, defaulting to
+@cpp -1 @ce, which means only attributes that aren't a morph target are
+considered. The count of morph targets is returned by @ref morphTargetCount():
+
+@snippet MagnumTrade.cpp MeshData-morph-targets
+
+The deltas can be then evaluated on the GPU for example using
+@ref Shaders::MorphTargets.
 @see @ref AbstractImporter::mesh()
 */
 class MAGNUM_TRADE_EXPORT MeshData {
@@ -1139,7 +1188,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * attribute-less mesh. See also @ref indexCount() which returns count
          * of elements in the @ref indices() array and @ref vertexCount() which
          * returns count of elements in every @ref attribute() array.
-         * @see @ref attributeCount(MeshAttribute) const
+         * @see @ref attributeCount(MeshAttribute, Int) const
          */
         UnsignedInt attributeCount() const { return UnsignedInt(_attributes.size()); }
 
@@ -1177,7 +1226,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @brief Attribute format
          *
          * The @p id is expected to be smaller than @ref attributeCount() const.
-         * You can also use @ref attributeFormat(MeshAttribute, UnsignedInt) const
+         * You can also use @ref attributeFormat(MeshAttribute, UnsignedInt, Int) const
          * to directly get a type of given named attribute.
          * @see @ref attributeName(), @ref indexType()
          */
@@ -1191,7 +1240,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * between pointers returned from @ref vertexData() and a particular
          * @ref attribute(). The @p id is expected to be smaller than
          * @ref attributeCount() const. You can also use
-         * @ref attributeOffset(MeshAttribute, UnsignedInt) const to
+         * @ref attributeOffset(MeshAttribute, UnsignedInt, Int) const to
          * directly get an offset of given named attribute.
          * @see @ref indexOffset(), @ref MeshTools::isInterleaved()
          */
@@ -1203,7 +1252,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * Stride between consecutive elements of given attribute in the
          * @ref vertexData() array. The @p id is expected to be smaller
          * than @ref attributeCount() const. You can also use
-         * @ref attributeStride(MeshAttribute, UnsignedInt) const to
+         * @ref attributeStride(MeshAttribute, UnsignedInt, Int) const to
          * directly get a stride of given named attribute.
          * @see @ref MeshTools::isInterleaved()
          */
@@ -1216,26 +1265,50 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @cpp int[30] @ce), returns array size, otherwise returns @cpp 0 @ce.
          * At the moment only custom attributes can be arrays, no builtin
          * @ref MeshAttribute is an array attribute. You can also use
-         * @ref attributeArraySize(MeshAttribute, UnsignedInt) const to
+         * @ref attributeArraySize(MeshAttribute, UnsignedInt, Int) const to
          * directly get array size of given named attribute.
          *
          * Note that this is different from vertex count, which is exposed
          * through @ref vertexCount(), and is an orthogonal concept to having
          * multiple attributes of the same name (for example two sets of
          * texture coordinates), which is exposed through
-         * @ref attributeCount(MeshAttribute) const. See
+         * @ref attributeCount(MeshAttribute, Int) const. See
          * @ref Trade-MeshData-populating-custom for an example.
          * @see @ref isMeshAttributeCustom()
          */
         UnsignedShort attributeArraySize(UnsignedInt id) const;
 
+        /**
+         * @brief Attribute morph target ID
+         * @m_since_latest
+         *
+         * Returns @cpp -1 @ce if given attribute isn't a morph target. The
+         * @p id is expected to be smaller than @ref attributeCount() const.
+         * @see @ref morphTargetCount(), @ref Trade-MeshData-morph-targets
+         */
+        Int attributeMorphTargetId(UnsignedInt id) const;
+
+        /**
+         * @brief Morph target count
+         * @m_since_latest
+         *
+         * Count of morph targets referenced by the attributes, i.e. the
+         * largest @ref attributeMorphTargetId() plus one. If there are no
+         * morph target attributes, returns @cpp 0 @ce.
+         * @see @ref Trade-MeshData-morph-targets
+         */
+        UnsignedInt morphTargetCount() const;
+
         /**
          * @brief Whether the mesh has given attribute
          *
-         * @see @ref attributeCount(MeshAttribute) const
+         * If @p morphTargetId is not @cpp -1 @ce, checks for presence of the
+         * attribute in given morph target, otherwise only attributes that
+         * aren't a morph target are considered.
+         * @see @ref attributeCount(MeshAttribute, Int) const
          */
-        bool hasAttribute(MeshAttribute name) const {
-            return attributeCount(name);
+        bool hasAttribute(MeshAttribute name, Int morphTargetId = -1) const {
+            return attributeCount(name, morphTargetId);
         }
 
         /**
@@ -1243,58 +1316,62 @@ class MAGNUM_TRADE_EXPORT MeshData {
          *
          * Unlike @ref attributeCount() const this returns count for given
          * attribute name --- for example a mesh can have more than one set of
-         * texture coordinates.
+         * texture coordinates. If @p morphTargetId is not @cpp -1 @ce, counts
+         * the attributes in given morph target, otherwise only attributes
+         * that aren't a morph target are counted.
          * @see @ref hasAttribute()
          */
-        UnsignedInt attributeCount(MeshAttribute name) const;
+        UnsignedInt attributeCount(MeshAttribute name, Int morphTargetId = -1) const;
 
         /**
          * @brief Absolute ID of a named attribute
          *
          * The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const.
+         * @ref attributeCount(MeshAttribute, Int) const for given
+         * @p morphTargetId. The same applies to all other accessors taking a
+         * @ref MeshAttribute and a morph target ID.
          */
-        UnsignedInt attributeId(MeshAttribute name, UnsignedInt id = 0) const;
+        UnsignedInt attributeId(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Format of a named attribute
          *
          * The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const.
+         * @ref attributeCount(MeshAttribute, Int) const.
          * @see @ref attributeFormat(UnsignedInt) const
          */
-        VertexFormat attributeFormat(MeshAttribute name, UnsignedInt id = 0) const;
+        VertexFormat attributeFormat(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Offset of a named attribute
          *
          * Byte offset of the first element of given named attribute from the
          * beginning of the @ref vertexData() array. The @p id is expected to
-         * be smaller than @ref attributeCount(MeshAttribute) const.
+         * be smaller than @ref attributeCount(MeshAttribute, Int) const.
          * @see @ref attributeOffset(UnsignedInt) const
          */
-        std::size_t attributeOffset(MeshAttribute name, UnsignedInt id = 0) const;
+        std::size_t attributeOffset(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Stride of a named attribute
          *
          * Stride between consecutive elements of given named attribute in the
          * @ref vertexData() array. The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const.
+         * @ref attributeCount(MeshAttribute, Int) const.
          * @see @ref attributeStride(UnsignedInt) const
          */
-        UnsignedInt attributeStride(MeshAttribute name, UnsignedInt id = 0) const;
+        UnsignedInt attributeStride(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Array size of a named attribute
          *
          * The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const. Note that this is
+         * @ref attributeCount(MeshAttribute, Int) const. Note that this is
          * different from vertex count, and is an orthogonal concept to having
          * multiple attributes of the same name --- see
          * @ref attributeArraySize(UnsignedInt) const for more information.
          */
-        UnsignedShort attributeArraySize(MeshAttribute name, UnsignedInt id = 0) const;
+        UnsignedShort attributeArraySize(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Data for given attribute
@@ -1337,8 +1414,8 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @ref objectIdsAsArray() accessors to get common attributes converted
          * to usual types, but note that these operations involve extra
          * allocation and data conversion.
-         * @see @ref attribute(MeshAttribute, UnsignedInt) const,
-         *      @ref mutableAttribute(MeshAttribute, UnsignedInt),
+         * @see @ref attribute(MeshAttribute, UnsignedInt, Int) const,
+         *      @ref mutableAttribute(MeshAttribute, UnsignedInt, Int),
          *      @ref isVertexFormatImplementationSpecific(),
          *      @ref attributeArraySize()
          */
@@ -1379,37 +1456,37 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @brief Data for given named attribute
          *
          * The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const. The second dimension
+         * @ref attributeCount(MeshAttribute, Int) const. The second dimension
          * represents the actual data type (its size is equal to format size
          * for known @ref VertexFormat values and to attribute stride for
          * implementation-specific values) and is guaranteed to be contiguous.
          * Use the templated overload below to get the attribute in a concrete
          * type.
          * @see @ref attribute(UnsignedInt) const,
-         *      @ref mutableAttribute(MeshAttribute, UnsignedInt),
+         *      @ref mutableAttribute(MeshAttribute, UnsignedInt, Int),
          *      @ref Corrade::Containers::StridedArrayView::isContiguous(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::StridedArrayView2D<const char> attribute(MeshAttribute name, UnsignedInt id = 0) const;
+        Containers::StridedArrayView2D<const char> attribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Mutable data for given named attribute
          *
-         * Like @ref attribute(MeshAttribute, UnsignedInt) const, but returns a
+         * Like @ref attribute(MeshAttribute, UnsignedInt, Int) const, but returns a
          * mutable view. Expects that the mesh is mutable.
          * @see @ref vertexDataFlags()
          */
-        Containers::StridedArrayView2D<char> mutableAttribute(MeshAttribute name, UnsignedInt id = 0);
+        Containers::StridedArrayView2D<char> mutableAttribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1);
 
         /**
          * @brief Data for given named attribute in a concrete type
          *
          * The @p id is expected to be smaller than
-         * @ref attributeCount(MeshAttribute) const and @p T is expected to
-         * correspond to @ref attributeFormat(MeshAttribute, UnsignedInt) const.
+         * @ref attributeCount(MeshAttribute, Int) const and @p T is expected to
+         * correspond to @ref attributeFormat(MeshAttribute, UnsignedInt, Int) const.
          * Expects that the vertex format is *not* implementation-specific, in
          * that case you can only access the attribute via the typeless
-         * @ref attribute(MeshAttribute, UnsignedInt) const above. You can also
+         * @ref attribute(MeshAttribute, UnsignedInt, Int) const above. You can also
          * use the non-templated @ref positions2DAsArray(),
          * @ref positions3DAsArray(), @ref normalsAsArray(),
          * @ref textureCoordinates2DAsArray() and @ref colorsAsArray()
@@ -1417,10 +1494,10 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * note that these operations involve extra data conversion and an
          * allocation.
          * @see @ref attribute(UnsignedInt) const,
-         *      @ref mutableAttribute(MeshAttribute, UnsignedInt),
+         *      @ref mutableAttribute(MeshAttribute, UnsignedInt, Int),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        template<class T, class = typename std::enable_if<!std::is_array<T>::value>::type> Containers::StridedArrayView1D<const T> attribute(MeshAttribute name, UnsignedInt id = 0) const;
+        template<class T, class = typename std::enable_if<!std::is_array<T>::value>::type> Containers::StridedArrayView1D<const T> attribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Data for given named array attribute in a concrete type
@@ -1431,16 +1508,16 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * contiguous and have the same size as reported by
          * @ref attributeArraySize() for given attribute.
          */
-        template<class T, class = typename std::enable_if<std::is_array<T>::value>::type> Containers::StridedArrayView2D<const typename std::remove_extent<T>::type> attribute(MeshAttribute name, UnsignedInt id = 0) const;
+        template<class T, class = typename std::enable_if<std::is_array<T>::value>::type> Containers::StridedArrayView2D<const typename std::remove_extent<T>::type> attribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Mutable data for given named attribute in a concrete type
          *
-         * Like @ref attribute(MeshAttribute, UnsignedInt) const, but returns a
+         * Like @ref attribute(MeshAttribute, UnsignedInt, Int) const, but returns a
          * mutable view. Expects that the mesh is mutable.
          * @see @ref vertexDataFlags()
          */
-        template<class T, class = typename std::enable_if<!std::is_array<T>::value>::type> Containers::StridedArrayView1D<T> mutableAttribute(MeshAttribute name, UnsignedInt id = 0);
+        template<class T, class = typename std::enable_if<!std::is_array<T>::value>::type> Containers::StridedArrayView1D<T> mutableAttribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1);
 
         /**
          * @brief Mutable data for given named array attribute in a concrete type
@@ -1451,7 +1528,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * contiguous and have the same size as reported by
          * @ref attributeArraySize() for given attribute.
          */
-        template<class T, class = typename std::enable_if<std::is_array<T>::value>::type> Containers::StridedArrayView2D<typename std::remove_extent<T>::type> mutableAttribute(MeshAttribute name, UnsignedInt id = 0);
+        template<class T, class = typename std::enable_if<std::is_array<T>::value>::type> Containers::StridedArrayView2D<typename std::remove_extent<T>::type> mutableAttribute(MeshAttribute name, UnsignedInt id = 0, Int morphTargetId = -1);
 
         /**
          * @brief Indices as 32-bit integers
@@ -1476,17 +1553,17 @@ class MAGNUM_TRADE_EXPORT MeshData {
         /**
          * @brief Positions as 2D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Position as the first argument. Converts
          * the position array from an arbitrary underlying type and returns it
          * in a newly-allocated array. If the underlying type is
          * three-component, the last component is dropped. Expects that the
          * vertex format is *not* implementation-specific, in that case you can
-         * only access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * only access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref positions2DInto(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector2> positions2DAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector2> positions2DAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Positions as 2D float vectors into a pre-allocated view
@@ -1496,22 +1573,22 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @p destination is sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void positions2DInto(Containers::StridedArrayView1D<Vector2> destination, UnsignedInt id = 0) const;
+        void positions2DInto(Containers::StridedArrayView1D<Vector2> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Positions as 3D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Position as the first argument. Converts
          * the position array from an arbitrary underlying type and returns it
          * in a newly-allocated array. If the underlying type is two-component,
          * the Z component is set to @cpp 0.0f @ce. Expects that the vertex
          * format is *not* implementation-specific, in that case you can only
-         * access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref positions3DInto(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector3> positions3DAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector3> positions3DAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Positions as 3D float vectors into a pre-allocated view
@@ -1521,17 +1598,17 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @p destination is sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void positions3DInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0) const;
+        void positions3DInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Tangents as 3D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Tangent as the first argument. Converts the
          * tangent array from an arbitrary underlying type and returns it in a
          * newly-allocated array. Expects that the vertex format is *not*
          * implementation-specific, in that case you can only access the
-         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          *
          * If the tangents contain a fourth component with bitangent direction,
          * it's ignored here --- use @ref bitangentSignsAsArray() to get those
@@ -1541,7 +1618,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          *      @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector3> tangentsAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector3> tangentsAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Tangents as 3D float vectors into a pre-allocated view
@@ -1551,7 +1628,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void tangentsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0) const;
+        void tangentsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Bitangent signs as floats
@@ -1564,7 +1641,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          *      @ref normalsAsArray(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Float> bitangentSignsAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Float> bitangentSignsAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Bitangent signs as floats into a pre-allocated view
@@ -1574,17 +1651,17 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @p destination is sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void bitangentSignsInto(Containers::StridedArrayView1D<Float> destination, UnsignedInt id = 0) const;
+        void bitangentSignsInto(Containers::StridedArrayView1D<Float> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Bitangents as 3D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Bitangent as the first argument. Converts
          * the bitangent array from an arbitrary underlying type and returns it
          * in a newly-allocated array. Expects that the vertex format is *not*
          * implementation-specific, in that case you can only access the
-         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          *
          * Note that in some cases the bitangents aren't provided directly but
          * calculated from normals and four-component tangents. In that case
@@ -1595,7 +1672,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
          *      @ref normalsAsArray(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector3> bitangentsAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector3> bitangentsAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Bitangents as 3D float vectors into a pre-allocated view
@@ -1605,22 +1682,22 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @p destination is sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void bitangentsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0) const;
+        void bitangentsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Normals as 3D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Normal as the first argument. Converts the
          * normal array from an arbitrary underlying type and returns it in a
          * newly-allocated array. Expects that the vertex format is *not*
          * implementation-specific, in that case you can only access the
-         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref normalsInto(), @ref tangentsAsArray(),
          *      @ref bitangentsAsArray(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector3> normalsAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector3> normalsAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Normals as 3D float vectors into a pre-allocated view
@@ -1630,22 +1707,22 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void normalsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0) const;
+        void normalsInto(Containers::StridedArrayView1D<Vector3> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Texture coordinates as 2D float vectors
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::TextureCoordinates as the first argument.
          * Converts the texture coordinate array from an arbitrary underlying
          * type and returns it in a newly-allocated array. Expects that the
          * vertex format is *not* implementation-specific, in that case you can
          * only access the attribute via the typeless
-         * @ref attribute(MeshAttribute, UnsignedInt) const.
+         * @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref textureCoordinates2DInto(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Vector2> textureCoordinates2DAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Vector2> textureCoordinates2DAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Texture coordinates as 2D float vectors into a pre-allocated view
@@ -1655,22 +1732,22 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * @p destination is sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void textureCoordinates2DInto(Containers::StridedArrayView1D<Vector2> destination, UnsignedInt id = 0) const;
+        void textureCoordinates2DInto(Containers::StridedArrayView1D<Vector2> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Colors as RGBA floats
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::Color as the first argument. Converts the
          * color array from an arbitrary underlying type and returns it in a
          * newly-allocated array. If the underlying type is three-component,
          * the alpha component is set to @cpp 1.0f @ce. Expects that the vertex
          * format is *not* implementation-specific, in that case you can only
-         * access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * access the attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref colorsInto(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
-        Containers::Array<Color4> colorsAsArray(UnsignedInt id = 0) const;
+        Containers::Array<Color4> colorsAsArray(UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Colors as RGBA floats into a pre-allocated view
@@ -1680,17 +1757,17 @@ class MAGNUM_TRADE_EXPORT MeshData {
          * sized to contain exactly all data.
          * @see @ref vertexCount()
          */
-        void colorsInto(Containers::StridedArrayView1D<Color4> destination, UnsignedInt id = 0) const;
+        void colorsInto(Containers::StridedArrayView1D<Color4> destination, UnsignedInt id = 0, Int morphTargetId = -1) const;
 
         /**
          * @brief Object IDs as 32-bit integers
          *
-         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt) const
+         * Convenience alternative to @ref attribute(MeshAttribute, UnsignedInt, Int) const
          * with @ref MeshAttribute::ObjectId as the first argument. Converts
          * the object ID array from an arbitrary underlying type and returns it
          * in a newly-allocated array. Expects that the vertex format is *not*
          * implementation-specific, in that case you can only access the
-         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt) const.
+         * attribute via the typeless @ref attribute(MeshAttribute, UnsignedInt, Int) const.
          * @see @ref objectIdsInto(), @ref attributeFormat(),
          *      @ref isVertexFormatImplementationSpecific()
          */
@@ -1772,7 +1849,7 @@ class MAGNUM_TRADE_EXPORT MeshData {
         friend AbstractSceneConverter;
 
         /* Internal helper that doesn't assert, unlike attributeId() */
-        UnsignedInt attributeFor(MeshAttribute name, UnsignedInt id) const;
+        UnsignedInt attributeFor(MeshAttribute name, UnsignedInt id, Int morphTargetId) const;
 
         /* Like attribute(), but returning just a 1D view */
         Containers::StridedArrayView1D<const void> attributeDataViewInternal(const MeshAttributeData& attribute) const;
@@ -2060,15 +2137,31 @@ namespace Implementation {
     constexpr bool isAttributeArrayAllowed(MeshAttribute name) {
         return isMeshAttributeCustom(name);
     }
+
+    constexpr bool isMorphTargetAllowed(MeshAttribute name) {
+        return name == MeshAttribute::Position ||
+               name == MeshAttribute::Tangent ||
+               name == MeshAttribute::Bitangent ||
+               name == MeshAttribute::Normal ||
+               name == MeshAttribute::TextureCoordinates ||
+               name == MeshAttribute::Color ||
+               /* Custom attributes can be anything */
+               isMeshAttributeCustom(name);
+    }
     #endif
 }
 
-constexpr MeshAttributeData::MeshAttributeData(std::nullptr_t, const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView1D<const void>& data, const UnsignedShort arraySize) noexcept:
+constexpr MeshAttributeData::MeshAttributeData(std::nullptr_t, const MeshAttribute name, const VertexFormat format, const Containers::StridedArrayView1D<const void>& data, const UnsignedShort arraySize, const Int morphTargetId) noexcept:
     _format{(CORRADE_CONSTEXPR_ASSERT(!arraySize || !isVertexFormatImplementationSpecific(format),
         "Trade::MeshAttributeData: array attributes can't have an implementation-specific format"), format)},
     _name{(CORRADE_CONSTEXPR_ASSERT(Implementation::isVertexFormatCompatibleWithAttribute(name, format),
         "Trade::MeshAttributeData:" << format << "is not a valid format for" << name), name)},
-    _isOffsetOnly{false}, _vertexCount{UnsignedInt(data.size())},
+    _isOffsetOnly{false},
+    _morphTargetId{(CORRADE_CONSTEXPR_ASSERT(morphTargetId >= -1 && morphTargetId < 128,
+        "Trade::MeshAttributeData: expected morph target ID to be either -1 or less than 128 but got" << morphTargetId),
+        CORRADE_CONSTEXPR_ASSERT(morphTargetId == -1 || Implementation::isMorphTargetAllowed(name),
+        "Trade::MeshAttributeData: morph target not allowed for" << name), Byte(morphTargetId))},
+    _vertexCount{UnsignedInt(data.size())},
     /** @todo support zero / negative stride? would be hard to transfer to GL */
     _stride{(CORRADE_CONSTEXPR_ASSERT(!(UnsignedInt(data.stride()) & 0xffff8000),
         "Trade::MeshAttributeData: expected stride to be positive and at most 32k, got" << data.stride()),
@@ -2077,12 +2170,17 @@ constexpr MeshAttributeData::MeshAttributeData(std::nullptr_t, const MeshAttribu
         "Trade::MeshAttributeData:" << name << "can't be an array attribute"), arraySize)},
     _data{data.data()} {}
 
-constexpr MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const std::size_t offset, const UnsignedInt vertexCount, const std::ptrdiff_t stride, UnsignedShort arraySize) noexcept:
+constexpr MeshAttributeData::MeshAttributeData(const MeshAttribute name, const VertexFormat format, const std::size_t offset, const UnsignedInt vertexCount, const std::ptrdiff_t stride, UnsignedShort arraySize, const Int morphTargetId) noexcept:
     _format{(CORRADE_CONSTEXPR_ASSERT(!arraySize || !isVertexFormatImplementationSpecific(format),
         "Trade::MeshAttributeData: array attributes can't have an implementation-specific format"), format)},
     _name{(CORRADE_CONSTEXPR_ASSERT(Implementation::isVertexFormatCompatibleWithAttribute(name, format),
         "Trade::MeshAttributeData:" << format << "is not a valid format for" << name), name)},
-    _isOffsetOnly{true}, _vertexCount{vertexCount},
+    _isOffsetOnly{true},
+    _morphTargetId{(CORRADE_CONSTEXPR_ASSERT(morphTargetId >= -1 && morphTargetId < 128,
+        "Trade::MeshAttributeData: expected morph target ID to be either -1 or less than 128 but got" << morphTargetId),
+        CORRADE_CONSTEXPR_ASSERT(morphTargetId == -1 || Implementation::isMorphTargetAllowed(name),
+        "Trade::MeshAttributeData: morph target not allowed for" << name), Byte(morphTargetId))},
+    _vertexCount{vertexCount},
     /** @todo support zero / negative stride? would be hard to transfer to GL */
     _stride{(CORRADE_CONSTEXPR_ASSERT(!(UnsignedInt(stride) & 0xffff8000),
         "Trade::MeshAttributeData: expected stride to be positive and at most 32k, got" << stride),
@@ -2091,9 +2189,9 @@ constexpr MeshAttributeData::MeshAttributeData(const MeshAttribute name, const V
         "Trade::MeshAttributeData:" << name << "can't be an array attribute"), arraySize)},
     _data{offset} {}
 
-template<class T> constexpr MeshAttributeData::MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView1D<T>& data) noexcept: MeshAttributeData{nullptr, name, Implementation::vertexFormatFor<typename std::remove_const<T>::type>(), data, 0} {}
+template<class T> constexpr MeshAttributeData::MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView1D<T>& data, const Int morphTargetId) noexcept: MeshAttributeData{nullptr, name, Implementation::vertexFormatFor<typename std::remove_const<T>::type>(), data, 0, morphTargetId} {}
 
-template<class T> constexpr MeshAttributeData::MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView2D<T>& data) noexcept: MeshAttributeData{(CORRADE_CONSTEXPR_ASSERT(data.stride()[1] == sizeof(T), "Trade::MeshAttributeData: second view dimension is not contiguous"), nullptr), name, Implementation::vertexFormatFor<typename std::remove_const<T>::type>(), Containers::StridedArrayView1D<const void>{{data.data(), ~std::size_t{}}, data.size()[0], data.stride()[0]}, UnsignedShort(data.size()[1])} {}
+template<class T> constexpr MeshAttributeData::MeshAttributeData(MeshAttribute name, const Containers::StridedArrayView2D<T>& data, const Int morphTargetId) noexcept: MeshAttributeData{(CORRADE_CONSTEXPR_ASSERT(data.stride()[1] == sizeof(T), "Trade::MeshAttributeData: second view dimension is not contiguous"), nullptr), name, Implementation::vertexFormatFor<typename std::remove_const<T>::type>(), Containers::StridedArrayView1D<const void>{{data.data(), ~std::size_t{}}, data.size()[0], data.stride()[0]}, UnsignedShort(data.size()[1]), morphTargetId} {}
 
 template<class T> Containers::ArrayView<const T> MeshData::indices() const {
     CORRADE_ASSERT(isIndexed(),
@@ -2177,47 +2275,47 @@ template<class T, class> Containers::StridedArrayView2D<typename std::remove_ext
     return Containers::arrayCast<2, typename std::remove_extent<T>::type>(data);
 }
 
-template<class T, class> Containers::StridedArrayView1D<const T> MeshData::attribute(MeshAttribute name, UnsignedInt id) const {
-    Containers::StridedArrayView2D<const char> data = attribute(name, id);
+template<class T, class> Containers::StridedArrayView1D<const T> MeshData::attribute(MeshAttribute name, UnsignedInt id, Int morphTargetId) const {
+    Containers::StridedArrayView2D<const char> data = attribute(name, id, morphTargetId);
     #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
     if(!data.stride()[1]) return {};
     #endif
     #ifndef CORRADE_NO_ASSERT
-    if(!checkAttributeTypeCompatibility<T>(_attributes[attributeFor(name, id)], "Trade::MeshData::attribute():")) return {};
+    if(!checkAttributeTypeCompatibility<T>(_attributes[attributeFor(name, id, morphTargetId)], "Trade::MeshData::attribute():")) return {};
     #endif
     return Containers::arrayCast<1, const T>(data);
 }
 
-template<class T, class> Containers::StridedArrayView2D<const typename std::remove_extent<T>::type> MeshData::attribute(MeshAttribute name, UnsignedInt id) const {
-    Containers::StridedArrayView2D<const char> data = attribute(name, id);
+template<class T, class> Containers::StridedArrayView2D<const typename std::remove_extent<T>::type> MeshData::attribute(MeshAttribute name, UnsignedInt id, Int morphTargetId) const {
+    Containers::StridedArrayView2D<const char> data = attribute(name, id, morphTargetId);
     #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
     if(!data.stride()[1]) return {};
     #endif
     #ifndef CORRADE_NO_ASSERT
-    const MeshAttributeData& attribute = _attributes[attributeFor(name, id)];
+    const MeshAttributeData& attribute = _attributes[attributeFor(name, id, morphTargetId)];
     if(!checkAttributeTypeCompatibility<T>(attribute, "Trade::MeshData::attribute():")) return {};
     #endif
     return Containers::arrayCast<2, const typename std::remove_extent<T>::type>(data);
 }
 
-template<class T, class> Containers::StridedArrayView1D<T> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id) {
-    Containers::StridedArrayView2D<char> data = mutableAttribute(name, id);
+template<class T, class> Containers::StridedArrayView1D<T> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id, Int morphTargetId) {
+    Containers::StridedArrayView2D<char> data = mutableAttribute(name, id, morphTargetId);
     #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
     if(!data.stride()[1]) return {};
     #endif
     #ifndef CORRADE_NO_ASSERT
-    if(!checkAttributeTypeCompatibility<T>(_attributes[attributeFor(name, id)], "Trade::MeshData::mutableAttribute():")) return {};
+    if(!checkAttributeTypeCompatibility<T>(_attributes[attributeFor(name, id, morphTargetId)], "Trade::MeshData::mutableAttribute():")) return {};
     #endif
     return Containers::arrayCast<1, T>(data);
 }
 
-template<class T, class> Containers::StridedArrayView2D<typename std::remove_extent<T>::type> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id) {
-    Containers::StridedArrayView2D<char> data = mutableAttribute(name, id);
+template<class T, class> Containers::StridedArrayView2D<typename std::remove_extent<T>::type> MeshData::mutableAttribute(MeshAttribute name, UnsignedInt id, Int morphTargetId) {
+    Containers::StridedArrayView2D<char> data = mutableAttribute(name, id, morphTargetId);
     #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
     if(!data.stride()[1]) return {};
     #endif
     #ifndef CORRADE_NO_ASSERT
-    const MeshAttributeData& attribute = _attributes[attributeFor(name, id)];
+    const MeshAttributeData& attribute = _attributes[attributeFor(name, id, morphTargetId)];
     if(!checkAttributeTypeCompatibility<T>(attribute, "Trade::MeshData::mutableAttribute():")) return {};
     #endif
     return Containers::arrayCast<2, typename std::remove_extent<T>::type>(data);
@@ -25,9 +25,103 @@
 
 #include "SceneData.h"
 
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
+#include "Magnum/Trade/Implementation/arrayUtilities.h"
+
 namespace Magnum { namespace Trade {
 
-SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* const importerState): _children2D{std::move(children2D)}, _children3D{std::move(children3D)}, _importerState{importerState} {}
+UnsignedInt sceneFieldTypeSize(const SceneFieldType type) {
+    switch(type) {
+        case SceneFieldType::Int: return sizeof(Int);
+        case SceneFieldType::Matrix3: return sizeof(Matrix3);
+        case SceneFieldType::Matrix4: return sizeof(Matrix4);
+    }
+
+    CORRADE_ASSERT_UNREACHABLE("Trade::sceneFieldTypeSize(): invalid type" << type, {});
+}
+
+namespace {
+
+#ifndef CORRADE_NO_ASSERT
+bool isSceneFieldTypeCompatible(const SceneField name, const SceneFieldType type) {
+    switch(name) {
+        case SceneField::Parent:
+        case SceneField::Mesh:
+        case SceneField::MeshMaterial:
+        case SceneField::Light:
+            return type == SceneFieldType::Int;
+        case SceneField::Transformation:
+            return type == SceneFieldType::Matrix3 ||
+                   type == SceneFieldType::Matrix4;
+    }
+
+    return false;
+}
+#endif
+
+}
+
+SceneFieldData::SceneFieldData(const SceneField name, const SceneFieldType type, const Containers::StridedArrayView1D<const void>& data) noexcept: _name{name}, _type{type}, _data{data} {
+    CORRADE_ASSERT(isSceneFieldTypeCompatible(name, type),
+        "Trade::SceneFieldData:" << type << "is not a valid type for" << name, );
+    CORRADE_ASSERT(data.empty() || std::ptrdiff_t(sceneFieldTypeSize(type)) <= data.stride(),
+        "Trade::SceneFieldData: expected stride to be positive and enough to fit" << type << Debug::nospace << ", got" << data.stride(), );
+}
+
+SceneData::SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* const importerState): _objectCount{}, _dataFlags{DataFlag::Owned|DataFlag::Mutable}, _children2D{std::move(children2D)}, _children3D{std::move(children3D)}, _importerState{importerState} {}
+
+SceneData::SceneData(const UnsignedInt objectCount, Containers::Array<char>&& data, Containers::Array<SceneFieldData>&& fields, const void* const importerState) noexcept: _objectCount{objectCount}, _dataFlags{DataFlag::Owned|DataFlag::Mutable}, _importerState{importerState}, _fields{std::move(fields)}, _data{std::move(data)} {
+    #ifndef CORRADE_NO_ASSERT
+    /* Not checking what's already checked in SceneFieldData constructors */
+    for(std::size_t i = 0; i != _fields.size(); ++i) {
+        const SceneFieldData& field = _fields[i];
+        CORRADE_ASSERT(field._type != SceneFieldType{},
+            "Trade::SceneData: field" << i << "doesn't specify anything", );
+        CORRADE_ASSERT(field._data.size() == _objectCount,
+            "Trade::SceneData: field" << i << "has" << field._data.size() << "entries but" << _objectCount << "expected", );
+        for(std::size_t j = 0; j != i; ++j)
+            CORRADE_ASSERT(_fields[j]._name != field._name,
+                "Trade::SceneData: duplicate field" << field._name, );
+        if(!_objectCount) continue;
+        const void* const begin = field._data.data();
+        const void* const end = static_cast<const char*>(field._data.data()) + (_objectCount - 1)*field._data.stride() + sceneFieldTypeSize(field._type);
+        CORRADE_ASSERT(begin >= _data.begin() && end <= _data.end(),
+            "Trade::SceneData: field" << i << "[" << Debug::nospace << begin << Debug::nospace << ":" << Debug::nospace << end << Debug::nospace << "] is not contained in passed data array [" << Debug::nospace << static_cast<const void*>(_data.begin()) << Debug::nospace << ":" << Debug::nospace << static_cast<const void*>(_data.end()) << Debug::nospace << "]", );
+    }
+    #endif
+
+    /* Populate the top-level object lists for code that doesn't use the
+       fields directly */
+    const SceneFieldData* transformation = nullptr;
+    const SceneFieldData* parent = nullptr;
+    for(const SceneFieldData& field: _fields) {
+        if(field._name == SceneField::Transformation) transformation = &field;
+        else if(field._name == SceneField::Parent) parent = &field;
+    }
+    std::vector<UnsignedInt>& children = transformation && transformation->_type == SceneFieldType::Matrix3 ? _children2D : _children3D;
+    if(parent) {
+        const Containers::StridedArrayView1D<const Int> parents = Containers::arrayCast<1, const Int>(Containers::arrayCast<2, const char>(parent->_data, sizeof(Int)));
+        for(std::size_t i = 0; i != parents.size(); ++i)
+            if(parents[i] == -1) children.push_back(i);
+    } else {
+        children.reserve(_objectCount);
+        for(UnsignedInt i = 0; i != _objectCount; ++i) children.push_back(i);
+    }
+}
+
+SceneData::SceneData(const UnsignedInt objectCount, Containers::Array<char>&& data, const std::initializer_list<SceneFieldData> fields, const void* const importerState): SceneData{objectCount, std::move(data), Implementation::initializerListToArrayWithDefaultDeleter(fields), importerState} {}
+
+SceneData::SceneData(const UnsignedInt objectCount, const DataFlags dataFlags, const Containers::ArrayView<const void> data, Containers::Array<SceneFieldData>&& fields, const void* const importerState) noexcept: SceneData{objectCount, Containers::Array<char>{const_cast<char*>(static_cast<const char*>(data.data())), data.size(), Implementation::nonOwnedArrayDeleter}, std::move(fields), importerState} {
+    CORRADE_ASSERT(!(dataFlags & DataFlag::Owned),
+        "Trade::SceneData: can't construct with non-owned data but" << dataFlags, );
+    _dataFlags = dataFlags;
+}
+
+SceneData::SceneData(const UnsignedInt objectCount, const DataFlags dataFlags, const Containers::ArrayView<const void> data, const std::initializer_list<SceneFieldData> fields, const void* const importerState): SceneData{objectCount, dataFlags, data, Implementation::initializerListToArrayWithDefaultDeleter(fields), importerState} {}
 
 SceneData::SceneData(SceneData&&)
     #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
@@ -35,10 +129,134 @@ SceneData::SceneData(SceneData&&)
     #endif
     = default;
 
+SceneData::~SceneData() = default;
+
 SceneData& SceneData::operator=(SceneData&&)
     #if !defined(__GNUC__) || __GNUC__*100 + __GNUC_MINOR__ != 409
     noexcept
     #endif
     = default;
 
+Containers::ArrayView<char> SceneData::mutableData() & {
+    CORRADE_ASSERT(_dataFlags & DataFlag::Mutable,
+        "Trade::SceneData::mutableData(): data not mutable", {});
+    return _data;
+}
+
+SceneField SceneData::fieldName(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _fields.size(),
+        "Trade::SceneData::fieldName(): index" << id << "out of range for" << _fields.size() << "fields", {});
+    return _fields[id]._name;
+}
+
+SceneFieldType SceneData::fieldType(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _fields.size(),
+        "Trade::SceneData::fieldType(): index" << id << "out of range for" << _fields.size() << "fields", {});
+    return _fields[id]._type;
+}
+
+bool SceneData::hasField(const SceneField name) const {
+    for(const SceneFieldData& field: _fields)
+        if(field._name == name) return true;
+    return false;
+}
+
+UnsignedInt SceneData::fieldId(const SceneField name) const {
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        if(_fields[i]._name == name) return i;
+    CORRADE_ASSERT_UNREACHABLE("Trade::SceneData::fieldId(): field" << name << "not found", {});
+}
+
+SceneFieldType SceneData::fieldType(const SceneField name) const {
+    for(const SceneFieldData& field: _fields)
+        if(field._name == name) return field._type;
+    CORRADE_ASSERT_UNREACHABLE("Trade::SceneData::fieldType(): field" << name << "not found", {});
+}
+
+Containers::StridedArrayView2D<const char> SceneData::field(const UnsignedInt id) const {
+    CORRADE_ASSERT(id < _fields.size(),
+        "Trade::SceneData::field(): index" << id << "out of range for" << _fields.size() << "fields", nullptr);
+    const SceneFieldData& field = _fields[id];
+    /* Build a 2D view using information about the type size */
+    return Containers::arrayCast<2, const char>(field._data,
+        sceneFieldTypeSize(field._type));
+}
+
+Containers::StridedArrayView2D<char> SceneData::mutableField(const UnsignedInt id) {
+    CORRADE_ASSERT(_dataFlags & DataFlag::Mutable,
+        "Trade::SceneData::mutableField(): data not mutable", {});
+    CORRADE_ASSERT(id < _fields.size(),
+        "Trade::SceneData::mutableField(): index" << id << "out of range for" << _fields.size() << "fields", nullptr);
+    const SceneFieldData& field = _fields[id];
+    /* Build a 2D view using information about the type size */
+    auto out = Containers::arrayCast<2, const char>(field._data,
+        sceneFieldTypeSize(field._type));
+    /** @todo some arrayConstCast? UGH */
+    return Containers::StridedArrayView2D<char>{
+        /* The view size is there only for a size assert, we're pretty sure the
+           view is valid */
+        {static_cast<char*>(const_cast<void*>(out.data())), ~std::size_t{}},
+        out.size(), out.stride()};
+}
+
+Containers::StridedArrayView2D<const char> SceneData::field(const SceneField name) const {
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        if(_fields[i]._name == name) return field(i);
+    CORRADE_ASSERT_UNREACHABLE("Trade::SceneData::field(): field" << name << "not found", nullptr);
+}
+
+Containers::StridedArrayView2D<char> SceneData::mutableField(const SceneField name) {
+    CORRADE_ASSERT(_dataFlags & DataFlag::Mutable,
+        "Trade::SceneData::mutableField(): data not mutable", {});
+    for(std::size_t i = 0; i != _fields.size(); ++i)
+        if(_fields[i]._name == name) return mutableField(i);
+    CORRADE_ASSERT_UNREACHABLE("Trade::SceneData::mutableField(): field" << name << "not found", nullptr);
+}
+
+Containers::Array<SceneFieldData> SceneData::releaseFieldData() {
+    return std::move(_fields);
+}
+
+Containers::Array<char> SceneData::releaseData() {
+    _objectCount = 0;
+    _fields = nullptr;
+    Containers::Array<char> out = std::move(_data);
+    _data = Containers::Array<char>{out.data(), 0, Implementation::nonOwnedArrayDeleter};
+    return out;
+}
+
+Debug& operator<<(Debug& debug, const SceneField value) {
+    debug << "Trade::SceneField" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case SceneField::value: return debug << "::" #value;
+        _c(Parent)
+        _c(Transformation)
+        _c(Mesh)
+        _c(MeshMaterial)
+        _c(Light)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const SceneFieldType value) {
+    debug << "Trade::SceneFieldType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case SceneFieldType::value: return debug << "::" #value;
+        _c(Int)
+        _c(Matrix3)
+        _c(Matrix4)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedShort(value)) << Debug::nospace << ")";
+}
+
 }}
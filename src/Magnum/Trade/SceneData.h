@@ -25,21 +25,194 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+
 /** @file
- * @brief Class @ref Magnum::Trade::SceneData
+ * @brief Class @ref Magnum::Trade::SceneData, @ref Magnum::Trade::SceneFieldData, enum @ref Magnum::Trade::SceneField, @ref Magnum::Trade::SceneFieldType, function @ref Magnum::Trade::sceneFieldTypeSize()
  */
 
+#include <initializer_list>
 #include <string>
 #include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
 
-#include "Magnum/Types.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Trade/Data.h"
+#include "Magnum/Trade/Trade.h"
 #include "Magnum/Trade/visibility.h"
 
 namespace Magnum { namespace Trade {
 
+/**
+@brief Scene field name
+@m_since_latest
+
+Each field describes one property of all objects in a @ref SceneData. See the
+documentation of particular values for the expected @ref SceneFieldType.
+@see @ref SceneFieldData
+*/
+enum class SceneField: UnsignedShort {
+    /* Zero used for an invalid value */
+
+    /**
+     * Parent object. Type is @ref SceneFieldType::Int, @cpp -1 @ce for
+     * top-level objects.
+     */
+    Parent = 1,
+
+    /**
+     * Transformation relative to the parent. Type is
+     * @ref SceneFieldType::Matrix3 for 2D scenes and
+     * @ref SceneFieldType::Matrix4 for 3D scenes.
+     */
+    Transformation,
+
+    /**
+     * ID of a mesh associated with the object, corresponding to the ID passed
+     * to @ref AbstractImporter::mesh(). Type is @ref SceneFieldType::Int,
+     * @cpp -1 @ce for objects without a mesh.
+     */
+    Mesh,
+
+    /**
+     * ID of a material used by the object mesh, corresponding to the ID
+     * passed to @ref AbstractImporter::material(). Type is
+     * @ref SceneFieldType::Int, @cpp -1 @ce if the mesh has no material
+     * assigned.
+     */
+    MeshMaterial,
+
+    /**
+     * ID of a light associated with the object, corresponding to the ID
+     * passed to @ref AbstractImporter::light(). Type is
+     * @ref SceneFieldType::Int, @cpp -1 @ce for objects without a light.
+     */
+    Light
+};
+
+/**
+@debugoperatorenum{SceneField}
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, SceneField value);
+
+/**
+@brief Scene field type
+@m_since_latest
+
+@see @ref SceneFieldData, @ref sceneFieldTypeSize()
+*/
+enum class SceneFieldType: UnsignedShort {
+    /* Zero used for an invalid value */
+
+    Int = 1,        /**< @relativeref{Magnum,Int} */
+    Matrix3,        /**< @relativeref{Magnum,Matrix3} */
+    Matrix4         /**< @relativeref{Magnum,Matrix4} */
+};
+
+/**
+@debugoperatorenum{SceneFieldType}
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT Debug& operator<<(Debug& debug, SceneFieldType value);
+
+/**
+@brief Size of given scene field type
+@m_since_latest
+*/
+MAGNUM_TRADE_EXPORT UnsignedInt sceneFieldTypeSize(SceneFieldType type);
+
+/**
+@brief Scene field data
+@m_since_latest
+
+Convenience type for populating @ref SceneData. The data are then accessible
+through @ref SceneData APIs, the accessors here are mainly for introspection.
+The most straightforward usage is constructing an instance from a @ref SceneField and a strided view,
+with the @ref SceneFieldType inferred from the view type:
+
+@snippet MagnumTrade.cpp SceneFieldData-usage
+*/
+class MAGNUM_TRADE_EXPORT SceneFieldData {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * Leaves contents at unspecified values. Provided as a convenience for
+         * initialization of the field array for @ref SceneData, expected to be
+         * replaced with concrete values later.
+         */
+        constexpr explicit SceneFieldData() noexcept: _name{}, _type{} {}
+
+        /**
+         * @brief Type-erased constructor
+         * @param name      Field name
+         * @param type      Field type
+         * @param data      Field data
+         *
+         * Expects that @p type is allowed for @p name, see documentation of
+         * particular @ref SceneField values for details.
+         */
+        explicit SceneFieldData(SceneField name, SceneFieldType type, const Containers::StridedArrayView1D<const void>& data) noexcept;
+
+        /**
+         * @brief Constructor
+         * @param name      Field name
+         * @param data      Field data
+         *
+         * Detects @ref SceneFieldType based on @p T and calls
+         * @ref SceneFieldData(SceneField, SceneFieldType, const Containers::StridedArrayView1D<const void>&).
+         */
+        template<class T> explicit SceneFieldData(SceneField name, const Containers::StridedArrayView1D<T>& data) noexcept;
+
+        /** @overload */
+        template<class T> explicit SceneFieldData(SceneField name, const Containers::ArrayView<T>& data) noexcept: SceneFieldData{name, Containers::stridedArrayView(data)} {}
+
+        /** @brief Field name */
+        SceneField name() const { return _name; }
+
+        /** @brief Field type */
+        SceneFieldType type() const { return _type; }
+
+        /** @brief Type-erased field data */
+        Containers::StridedArrayView1D<const void> data() const { return _data; }
+
+    private:
+        friend SceneData;
+
+        SceneField _name;
+        SceneFieldType _type;
+        Containers::StridedArrayView1D<const void> _data;
+};
+
 /**
 @brief Scene data
 
+Provides access to the scene hierarchy, either as a list of top-level object
+IDs referencing @ref ObjectData2D / @ref ObjectData3D instances returned by
+@ref AbstractImporter::object2D() / @ref AbstractImporter::object3D(), or in
+a column-oriented form with all properties of all objects stored in contiguous
+arrays.
+
+@section Trade-SceneData-fields Column-oriented scene data
+
+The column-oriented form stores each property, such as a parent or a
+transformation, for all objects in a single typed strided field, similarly to
+how @ref MeshData stores vertex attributes. Compared to the per-object
+@ref ObjectData3D instances, which are separately allocated and each contain
+their own list of children, the whole scene is held in a single allocation
+and can be processed in bulk:
+
+@snippet MagnumTrade.cpp SceneData-fields
+
+An importer fills the fields with data in one go. A field that isn't present
+means none of the objects has that property, a missing
+@ref SceneField::Parent means all objects are top-level. The
+@ref children2D() / @ref children3D() lists are populated from the
+@ref SceneField::Parent field --- the top-level objects are treated as 3D,
+unless the @ref SceneField::Transformation field is
+@ref SceneFieldType::Matrix3.
+
 @see @ref AbstractImporter::scene()
 */
 class MAGNUM_TRADE_EXPORT SceneData {
@@ -52,6 +225,51 @@ class MAGNUM_TRADE_EXPORT SceneData {
          */
         explicit SceneData(std::vector<UnsignedInt> children2D, std::vector<UnsignedInt> children3D, const void* importerState = nullptr);
 
+        /**
+         * @brief Construct column-oriented scene data
+         * @param objectCount       Object count
+         * @param data              Data for all fields
+         * @param fields            Description of all fields
+         * @param importerState     Importer-specific state
+         * @m_since_latest
+         *
+         * Each field is expected to have exactly @p objectCount entries, be
+         * contained in @p data and be present at most once. The
+         * @ref dataFlags() are implicitly set to a combination of
+         * @ref DataFlag::Owned and @ref DataFlag::Mutable. See
+         * @ref Trade-SceneData-fields for more information.
+         */
+        explicit SceneData(UnsignedInt objectCount, Containers::Array<char>&& data, Containers::Array<SceneFieldData>&& fields, const void* importerState = nullptr) noexcept;
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        explicit SceneData(UnsignedInt objectCount, Containers::Array<char>&& data, std::initializer_list<SceneFieldData> fields, const void* importerState = nullptr);
+
+        /**
+         * @brief Construct non-owned column-oriented scene data
+         * @param objectCount       Object count
+         * @param dataFlags         Data flags
+         * @param data              View on data for all fields
+         * @param fields            Description of all fields
+         * @param importerState     Importer-specific state
+         * @m_since_latest
+         *
+         * Compared to @ref SceneData(UnsignedInt, Containers::Array<char>&&, Containers::Array<SceneFieldData>&&, const void*)
+         * creates an instance that doesn't own the passed data. The
+         * @p dataFlags parameter can contain @ref DataFlag::Mutable to
+         * indicate the external data can be modified, and is expected to
+         * *not* have @ref DataFlag::Owned set.
+         */
+        explicit SceneData(UnsignedInt objectCount, DataFlags dataFlags, Containers::ArrayView<const void> data, Containers::Array<SceneFieldData>&& fields, const void* importerState = nullptr) noexcept;
+
+        /**
+         * @overload
+         * @m_since_latest
+         */
+        explicit SceneData(UnsignedInt objectCount, DataFlags dataFlags, Containers::ArrayView<const void> data, std::initializer_list<SceneFieldData> fields, const void* importerState = nullptr);
+
         /** @brief Copying is not allowed */
         SceneData(const SceneData&) = delete;
 
@@ -65,6 +283,8 @@ class MAGNUM_TRADE_EXPORT SceneData {
             #endif
             ;
 
+        ~SceneData();
+
         /** @brief Copying is not allowed */
         SceneData& operator=(const SceneData&) = delete;
 
@@ -84,6 +304,211 @@ class MAGNUM_TRADE_EXPORT SceneData {
         /** @brief Three-dimensional child objects */
         const std::vector<UnsignedInt>& children3D() const { return _children3D; }
 
+        /**
+         * @brief Object count
+         * @m_since_latest
+         *
+         * Count of entries in each field. Always @cpp 0 @ce for scenes
+         * created with @ref SceneData(std::vector<UnsignedInt>, std::vector<UnsignedInt>, const void*).
+         */
+        UnsignedInt objectCount() const { return _objectCount; }
+
+        /**
+         * @brief Data flags
+         * @m_since_latest
+         *
+         * @see @ref releaseData(), @ref mutableData(), @ref mutableField()
+         */
+        DataFlags dataFlags() const { return _dataFlags; }
+
+        /**
+         * @brief Raw data
+         * @m_since_latest
+         *
+         * @see @ref releaseData()
+         */
+        Containers::ArrayView<const char> data() const & { return _data; }
+
+        /** @brief Taking a view to a r-value instance is not allowed */
+        Containers::ArrayView<const char> data() const && = delete;
+
+        /**
+         * @brief Mutable raw data
+         * @m_since_latest
+         *
+         * Like @ref data(), but returns a non-const view. Expects that the
+         * scene is mutable.
+         * @see @ref dataFlags()
+         */
+        Containers::ArrayView<char> mutableData() &;
+
+        /** @brief Taking a view to a r-value instance is not allowed */
+        Containers::ArrayView<char> mutableData() && = delete;
+
+        /**
+         * @brief Raw field metadata
+         * @m_since_latest
+         *
+         * @see @ref releaseFieldData()
+         */
+        Containers::ArrayView<const SceneFieldData> fieldData() const & { return _fields; }
+
+        /** @brief Taking a view to a r-value instance is not allowed */
+        Containers::ArrayView<const SceneFieldData> fieldData() const && = delete;
+
+        /**
+         * @brief Field count
+         * @m_since_latest
+         */
+        UnsignedInt fieldCount() const { return _fields.size(); }
+
+        /**
+         * @brief Field name
+         * @m_since_latest
+         *
+         * The @p id is expected to be smaller than @ref fieldCount().
+         */
+        SceneField fieldName(UnsignedInt id) const;
+
+        /**
+         * @brief Field type
+         * @m_since_latest
+         *
+         * The @p id is expected to be smaller than @ref fieldCount().
+         */
+        SceneFieldType fieldType(UnsignedInt id) const;
+
+        /**
+         * @brief Whether the scene has given field
+         * @m_since_latest
+         */
+        bool hasField(SceneField name) const;
+
+        /**
+         * @brief Absolute ID of a named field
+         * @m_since_latest
+         *
+         * The field is expected to exist.
+         * @see @ref hasField()
+         */
+        UnsignedInt fieldId(SceneField name) const;
+
+        /**
+         * @brief Type of a named field
+         * @m_since_latest
+         *
+         * The field is expected to exist.
+         * @see @ref hasField()
+         */
+        SceneFieldType fieldType(SceneField name) const;
+
+        /**
+         * @brief Data for given field
+         * @m_since_latest
+         *
+         * The @p id is expected to be smaller than @ref fieldCount(). The
+         * second dimension represents the actual data type (its size is equal
+         * to @ref sceneFieldTypeSize()) and is guaranteed to be contiguous.
+         * Use the templated overload below to get the field in a concrete
+         * type.
+         */
+        Containers::StridedArrayView2D<const char> field(UnsignedInt id) const;
+
+        /**
+         * @brief Mutable data for given field
+         * @m_since_latest
+         *
+         * Like @ref field(UnsignedInt) const, but returns a mutable view.
+         * Expects that the scene is mutable.
+         * @see @ref dataFlags()
+         */
+        Containers::StridedArrayView2D<char> mutableField(UnsignedInt id);
+
+        /**
+         * @brief Data for given field in a concrete type
+         * @m_since_latest
+         *
+         * The @p id is expected to be smaller than @ref fieldCount() and
+         * @p T is expected to correspond to @ref fieldType(UnsignedInt) const.
+         */
+        template<class T> Containers::StridedArrayView1D<const T> field(UnsignedInt id) const;
+
+        /**
+         * @brief Mutable data for given field in a concrete type
+         * @m_since_latest
+         *
+         * Like @ref field(UnsignedInt) const, but returns a mutable view.
+         * Expects that the scene is mutable.
+         * @see @ref dataFlags()
+         */
+        template<class T> Containers::StridedArrayView1D<T> mutableField(UnsignedInt id);
+
+        /**
+         * @brief Data for given named field
+         * @m_since_latest
+         *
+         * The field is expected to exist.
+         * @see @ref hasField(), @ref field(UnsignedInt) const
+         */
+        Containers::StridedArrayView2D<const char> field(SceneField name) const;
+
+        /**
+         * @brief Mutable data for given named field
+         * @m_since_latest
+         *
+         * Like @ref field(SceneField) const, but returns a mutable view.
+         * Expects that the scene is mutable.
+         * @see @ref dataFlags()
+         */
+        Containers::StridedArrayView2D<char> mutableField(SceneField name);
+
+        /**
+         * @brief Data for given named field in a concrete type
+         * @m_since_latest
+         *
+         * The field is expected to exist and @p T is expected to correspond
+         * to @ref fieldType(SceneField) const.
+         * @see @ref hasField()
+         */
+        template<class T> Containers::StridedArrayView1D<const T> field(SceneField name) const;
+
+        /**
+         * @brief Mutable data for given named field in a concrete type
+         * @m_since_latest
+         *
+         * Like @ref field(SceneField) const, but returns a mutable view.
+         * Expects that the scene is mutable.
+         * @see @ref dataFlags()
+         */
+        template<class T> Containers::StridedArrayView1D<T> mutableField(SceneField name);
+
+        /**
+         * @brief Release field data storage
+         * @m_since_latest
+         *
+         * Releases the ownership of the field data array and resets internal
+         * field-related state to default. The scene then behaves like if it
+         * has no fields. Note that the returned array has a custom no-op
+         * deleter when the data are not owned by the scene, and while the
+         * returned array type is mutable, the actual memory might be not.
+         * @see @ref fieldData()
+         */
+        Containers::Array<SceneFieldData> releaseFieldData();
+
+        /**
+         * @brief Release data storage
+         * @m_since_latest
+         *
+         * Releases the ownership of the data array and resets internal
+         * field-related state to default. The scene then behaves like if it
+         * has no fields and no objects. Note that the returned array has a
+         * custom no-op deleter when the data are not owned by the scene, and
+         * while the returned array type is mutable, the actual memory might be
+         * not.
+         * @see @ref data(), @ref dataFlags()
+         */
+        Containers::Array<char> releaseData();
+
         /**
          * @brief Importer-specific state
          *
@@ -92,11 +517,93 @@ class MAGNUM_TRADE_EXPORT SceneData {
         const void* importerState() const { return _importerState; }
 
     private:
+        /* For custom deleter checks. Not done in the constructors here because
+           the restriction is pointless when used outside of plugin
+           implementations. */
+        friend AbstractImporter;
+
+        #ifndef CORRADE_NO_ASSERT
+        template<class T> bool checkFieldTypeCompatibility(const SceneFieldData& field, const char* prefix) const;
+        #endif
+
+        UnsignedInt _objectCount;
+        DataFlags _dataFlags;
         std::vector<UnsignedInt> _children2D,
             _children3D;
         const void* _importerState;
+        Containers::Array<SceneFieldData> _fields;
+        Containers::Array<char> _data;
 };
 
+namespace Implementation {
+    /* LCOV_EXCL_START */
+    template<class T> constexpr SceneFieldType sceneFieldTypeFor() {
+        /* C++ why there isn't an obvious way to do such a thing?! */
+        static_assert(sizeof(T) == 0, "unsupported field type");
+        return {};
+    }
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    template<> constexpr SceneFieldType sceneFieldTypeFor<Int>() { return SceneFieldType::Int; }
+    template<> constexpr SceneFieldType sceneFieldTypeFor<Matrix3>() { return SceneFieldType::Matrix3; }
+    template<> constexpr SceneFieldType sceneFieldTypeFor<Matrix4>() { return SceneFieldType::Matrix4; }
+    #endif
+    /* LCOV_EXCL_STOP */
+}
+
+template<class T> SceneFieldData::SceneFieldData(const SceneField name, const Containers::StridedArrayView1D<T>& data) noexcept: SceneFieldData{name, Implementation::sceneFieldTypeFor<typename std::remove_const<T>::type>(), data} {}
+
+#ifndef CORRADE_NO_ASSERT
+template<class T> bool SceneData::checkFieldTypeCompatibility(const SceneFieldData& field, const char* const prefix) const {
+    CORRADE_ASSERT(Implementation::sceneFieldTypeFor<T>() == field._type,
+        prefix << "improper type requested for" << field._name << "of type" << field._type, false);
+    return true;
+}
+#endif
+
+template<class T> Containers::StridedArrayView1D<const T> SceneData::field(const UnsignedInt id) const {
+    Containers::StridedArrayView2D<const char> data = field(id);
+    #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
+    if(!data.stride()[1]) return {};
+    #endif
+    #ifndef CORRADE_NO_ASSERT
+    if(!checkFieldTypeCompatibility<T>(_fields[id], "Trade::SceneData::field():")) return {};
+    #endif
+    return Containers::arrayCast<1, const T>(data);
+}
+
+template<class T> Containers::StridedArrayView1D<T> SceneData::mutableField(const UnsignedInt id) {
+    Containers::StridedArrayView2D<char> data = mutableField(id);
+    #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
+    if(!data.stride()[1]) return {};
+    #endif
+    #ifndef CORRADE_NO_ASSERT
+    if(!checkFieldTypeCompatibility<T>(_fields[id], "Trade::SceneData::mutableField():")) return {};
+    #endif
+    return Containers::arrayCast<1, T>(data);
+}
+
+template<class T> Containers::StridedArrayView1D<const T> SceneData::field(const SceneField name) const {
+    Containers::StridedArrayView2D<const char> data = field(name);
+    #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
+    if(!data.stride()[1]) return {};
+    #endif
+    #ifndef CORRADE_NO_ASSERT
+    if(!checkFieldTypeCompatibility<T>(_fields[fieldId(name)], "Trade::SceneData::field():")) return {};
+    #endif
+    return Containers::arrayCast<1, const T>(data);
+}
+
+template<class T> Containers::StridedArrayView1D<T> SceneData::mutableField(const SceneField name) {
+    Containers::StridedArrayView2D<char> data = mutableField(name);
+    #ifdef CORRADE_GRACEFUL_ASSERT /* Sigh. Brittle. Better idea? */
+    if(!data.stride()[1]) return {};
+    #endif
+    #ifndef CORRADE_NO_ASSERT
+    if(!checkFieldTypeCompatibility<T>(_fields[fieldId(name)], "Trade::SceneData::mutableField():")) return {};
+    #endif
+    return Containers::arrayCast<1, T>(data);
+}
+
 }}
 
 #endif
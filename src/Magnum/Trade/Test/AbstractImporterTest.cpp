@@ -23,19 +23,25 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/PixelFormat.h"
 #include "Magnum/FileCallback.h"
+#include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/ArrayAllocator.h"
+#include "Magnum/Trade/ArrayArena.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
 #include "Magnum/Trade/LightData.h"
@@ -71,6 +77,8 @@ struct AbstractImporterTest: TestSuite::Tester {
     void openData();
     void openFileAsData();
     void openFileAsDataNotFound();
+    void openDataZeroCopy();
+    void openFileAsDataZeroCopy();
 
     void openFileNotImplemented();
     void openDataNotSupported();
@@ -90,6 +98,20 @@ struct AbstractImporterTest: TestSuite::Tester {
     void setFileCallbackOpenFileThroughBaseImplementationFailed();
     void setFileCallbackOpenFileAsData();
     void setFileCallbackOpenFileAsDataFailed();
+    void setFileCallbackOpenFileAsDataZeroCopy();
+    void setFileCallbackOpenFileAsDataZeroCopyFailed();
+    void setFileCallbackMapped();
+
+    void setProfileCallback();
+    void profileOpenData();
+    void profileOpenFile();
+    void profileOpenFileThroughCallback();
+    void profileOpenFileThroughCallbackZeroCopy();
+    void profileData();
+
+    void setArrayArena();
+    void arrayArena();
+    void arrayArenaNonOwned();
 
     void thingCountNotImplemented();
     void thingCountNoFile();
@@ -107,6 +129,8 @@ struct AbstractImporterTest: TestSuite::Tester {
     void sceneNameOutOfRange();
     void sceneNotImplemented();
     void sceneOutOfRange();
+    void sceneCustomDataDeleter();
+    void sceneCustomFieldDataDeleter();
 
     void animation();
     void animationNameNotImplemented();
@@ -178,6 +202,18 @@ struct AbstractImporterTest: TestSuite::Tester {
     void meshCustomVertexDataDeleter();
     void meshCustomAttributesDeleter();
 
+    void partialMesh();
+    void partialMeshNonIndexed();
+    void partialMeshAllAttributes();
+    void partialMeshEmptyRange();
+    void partialMeshRangeOutOfBounds();
+    void partialMeshFailed();
+    void partialMeshOverride();
+    void partialMeshNoFile();
+    void partialMeshOutOfRange();
+    void partialMeshLevelOutOfRange();
+    void partialMeshCustomDeleter();
+
     void meshAttributeName();
     void meshAttributeNameNotImplemented();
     void meshAttributeNameNotCustom();
@@ -273,6 +309,7 @@ struct AbstractImporterTest: TestSuite::Tester {
     void debugFeatures();
     void debugFlag();
     void debugFlags();
+    void debugProfileStage();
 };
 
 constexpr struct {
@@ -294,6 +331,8 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::openData,
               &AbstractImporterTest::openFileAsData,
               &AbstractImporterTest::openFileAsDataNotFound,
+              &AbstractImporterTest::openDataZeroCopy,
+              &AbstractImporterTest::openFileAsDataZeroCopy,
 
               &AbstractImporterTest::openFileNotImplemented,
               &AbstractImporterTest::openDataNotSupported,
@@ -313,6 +352,20 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::setFileCallbackOpenFileThroughBaseImplementationFailed,
               &AbstractImporterTest::setFileCallbackOpenFileAsData,
               &AbstractImporterTest::setFileCallbackOpenFileAsDataFailed,
+              &AbstractImporterTest::setFileCallbackOpenFileAsDataZeroCopy,
+              &AbstractImporterTest::setFileCallbackOpenFileAsDataZeroCopyFailed,
+              &AbstractImporterTest::setFileCallbackMapped,
+
+              &AbstractImporterTest::setProfileCallback,
+              &AbstractImporterTest::profileOpenData,
+              &AbstractImporterTest::profileOpenFile,
+              &AbstractImporterTest::profileOpenFileThroughCallback,
+              &AbstractImporterTest::profileOpenFileThroughCallbackZeroCopy,
+              &AbstractImporterTest::profileData,
+
+              &AbstractImporterTest::setArrayArena,
+              &AbstractImporterTest::arrayArena,
+              &AbstractImporterTest::arrayArenaNonOwned,
 
               &AbstractImporterTest::thingCountNotImplemented,
               &AbstractImporterTest::thingCountNoFile,
@@ -333,6 +386,8 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::sceneNameOutOfRange,
               &AbstractImporterTest::sceneNotImplemented,
               &AbstractImporterTest::sceneOutOfRange,
+              &AbstractImporterTest::sceneCustomDataDeleter,
+              &AbstractImporterTest::sceneCustomFieldDataDeleter,
 
               &AbstractImporterTest::animation,
               &AbstractImporterTest::animationNameNotImplemented,
@@ -404,6 +459,18 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::meshCustomVertexDataDeleter,
               &AbstractImporterTest::meshCustomAttributesDeleter,
 
+              &AbstractImporterTest::partialMesh,
+              &AbstractImporterTest::partialMeshNonIndexed,
+              &AbstractImporterTest::partialMeshAllAttributes,
+              &AbstractImporterTest::partialMeshEmptyRange,
+              &AbstractImporterTest::partialMeshRangeOutOfBounds,
+              &AbstractImporterTest::partialMeshFailed,
+              &AbstractImporterTest::partialMeshOverride,
+              &AbstractImporterTest::partialMeshNoFile,
+              &AbstractImporterTest::partialMeshOutOfRange,
+              &AbstractImporterTest::partialMeshLevelOutOfRange,
+              &AbstractImporterTest::partialMeshCustomDeleter,
+
               &AbstractImporterTest::meshAttributeName,
               &AbstractImporterTest::meshAttributeNameNotImplemented,
               &AbstractImporterTest::meshAttributeNameNotCustom,
@@ -498,7 +565,8 @@ AbstractImporterTest::AbstractImporterTest() {
               &AbstractImporterTest::debugFeature,
               &AbstractImporterTest::debugFeatures,
               &AbstractImporterTest::debugFlag,
-              &AbstractImporterTest::debugFlags});
+              &AbstractImporterTest::debugFlags,
+              &AbstractImporterTest::debugProfileStage});
 }
 
 void AbstractImporterTest::construct() {
@@ -643,6 +711,52 @@ void AbstractImporterTest::openFileAsDataNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file nonexistent.bin\n");
 }
 
+void AbstractImporterTest::openDataZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char>) override {
+            _opened = true;
+            flagsWhenOpening = flags();
+        }
+
+        bool _opened = false;
+        ImporterFlags flagsWhenOpening;
+    } importer;
+
+    /* The memory passed to openData() is guaranteed to be kept alive, so the
+       importer should see the flag */
+    importer.setFlags(ImporterFlag::Verbose|ImporterFlag::ZeroCopy);
+    const char a5 = '\xa5';
+    CORRADE_VERIFY(importer.openData({&a5, 1}));
+    CORRADE_COMPARE(importer.flagsWhenOpening, ImporterFlag::Verbose|ImporterFlag::ZeroCopy);
+}
+
+void AbstractImporterTest::openFileAsDataZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char>) override {
+            _opened = true;
+            flagsWhenOpening = flags();
+        }
+
+        bool _opened = false;
+        ImporterFlags flagsWhenOpening;
+    } importer;
+
+    /* The file data are temporary, so the flag should be masked away for the
+       duration of doOpenData() but then restored again */
+    importer.setFlags(ImporterFlag::Verbose|ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_COMPARE(importer.flagsWhenOpening, ImporterFlag::Verbose);
+    CORRADE_COMPARE(importer.flags(), ImporterFlag::Verbose|ImporterFlag::ZeroCopy);
+}
+
 void AbstractImporterTest::openFileNotImplemented() {
     #ifdef CORRADE_NO_ASSERT
     CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
@@ -1055,6 +1169,473 @@ void AbstractImporterTest::setFileCallbackOpenFileAsDataFailed() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file file.dat\n");
 }
 
+void AbstractImporterTest::setFileCallbackOpenFileAsDataZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = (data.size() == 1 && data[0] == '\xb0');
+            flagsWhenOpening = flags();
+        }
+
+        bool _opened = false;
+        ImporterFlags flagsWhenOpening;
+    } importer;
+
+    struct State {
+        const char data = '\xb0';
+        bool loaded = false;
+        bool closed = false;
+        bool calledNotSureWhy = false;
+    } state;
+
+    importer.setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, State& state) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(filename == "file.dat" && policy == InputFileCallbackPolicy::LoadPermanent) {
+            state.loaded = true;
+            return Containers::arrayView(&state.data, 1);
+        }
+
+        if(filename == "file.dat" && policy == InputFileCallbackPolicy::Close) {
+            state.closed = true;
+            return {};
+        }
+
+        state.calledNotSureWhy = true;
+        return {};
+    }, state);
+
+    /* The memory is requested permanently and never closed, so the importer
+       should see the flag */
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer.openFile("file.dat"));
+    CORRADE_COMPARE(importer.flagsWhenOpening, ImporterFlag::ZeroCopy);
+    CORRADE_COMPARE(importer.flags(), ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(state.loaded);
+    CORRADE_VERIFY(!state.closed);
+    CORRADE_VERIFY(!state.calledNotSureWhy);
+}
+
+void AbstractImporterTest::setFileCallbackOpenFileAsDataZeroCopyFailed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    } importer;
+
+    importer.setFileCallback([](const std::string&, InputFileCallbackPolicy, void*) {
+        return Containers::Optional<Containers::ArrayView<const char>>{};
+    });
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(!importer.openFile("file.dat"));
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file file.dat\n");
+}
+
+void AbstractImporterTest::setFileCallbackMapped() {
+    #if defined(CORRADE_TARGET_UNIX) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return !!_data; }
+        void doClose() override { _data = nullptr; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            if(data.size() == 1 && data[0] == '\xa5') _data = data;
+        }
+
+        Containers::ArrayView<const char> _data;
+    } importer;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_DIR, "file.bin");
+
+    MappedFileCallback files;
+    importer.setFlags(ImporterFlag::ZeroCopy);
+    importer.setFileCallback(MappedFileCallback::callback, files);
+    CORRADE_COMPARE(files.mappedCount(), 0);
+
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE(files.mappedCount(), 1);
+    CORRADE_VERIFY(files.isMapped(filename));
+
+    /* Opening the file again returns the same mapping */
+    const void* const mapped = importer._data.data();
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE(files.mappedCount(), 1);
+    CORRADE_COMPARE(static_cast<const void*>(importer._data.data()), mapped);
+    CORRADE_COMPARE(importer._data[0], '\xa5');
+
+    importer.close();
+    files.unmap();
+    CORRADE_COMPARE(files.mappedCount(), 0);
+    CORRADE_VERIFY(!files.isMapped(filename));
+
+    /* Nonexistent files fail gracefully */
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer.openFile("nonexistent.bin"));
+    }
+    CORRADE_COMPARE(files.mappedCount(), 0);
+    /* There's an error from Directory::mapRead() before */
+    CORRADE_VERIFY(out.str().find("Trade::AbstractImporter::openFile(): cannot open file nonexistent.bin\n") != std::string::npos);
+    #else
+    CORRADE_SKIP("Memory mapping is not available on this platform.");
+    #endif
+}
+
+/* Prints the stage and byte count of every reported event */
+void printProfileStage(const ImporterProfileStage stage, UnsignedLong, const std::size_t byteCount, void* const userData) {
+    Debug{static_cast<std::ostringstream*>(userData)} << stage << byteCount;
+}
+
+void AbstractImporterTest::setProfileCallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    } importer;
+
+    CORRADE_VERIFY(!importer.profileCallback());
+    CORRADE_VERIFY(!importer.profileCallbackUserData());
+
+    int a = 0;
+    auto lambda = [](ImporterProfileStage, UnsignedLong, std::size_t, void*) {};
+    importer.setProfileCallback(lambda, &a);
+    CORRADE_COMPARE(importer.profileCallback(), lambda);
+    CORRADE_COMPARE(importer.profileCallbackUserData(), &a);
+
+    importer.setProfileCallback(nullptr);
+    CORRADE_VERIFY(!importer.profileCallback());
+    CORRADE_VERIFY(!importer.profileCallbackUserData());
+}
+
+void AbstractImporterTest::profileOpenData() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = data.size() == 3;
+        }
+
+        bool _opened = false;
+    } importer;
+
+    std::ostringstream out;
+    importer.setProfileCallback(printProfileStage, &out);
+
+    const char data[]{'a', 'b', 'c'};
+    CORRADE_VERIFY(importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::ImporterProfileStage::OpenData 3\n");
+}
+
+void AbstractImporterTest::profileOpenFile() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = data.size() == 1;
+        }
+
+        bool _opened = false;
+    } importer;
+
+    std::ostringstream out;
+    importer.setProfileCallback(printProfileStage, &out);
+
+    /* The data opening is nested in the file opening */
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(TRADE_TEST_DIR, "file.bin")));
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterProfileStage::OpenData 1\n"
+        "Trade::ImporterProfileStage::OpenFile 1\n");
+}
+
+void AbstractImporterTest::profileOpenFileThroughCallback() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = data.size() == 2;
+        }
+
+        bool _opened = false;
+    } importer;
+
+    struct State {
+        const char data[2]{'a', 'b'};
+    } state;
+    importer.setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, State& state) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(filename == "file.dat" && policy == InputFileCallbackPolicy::LoadTemporary)
+            return Containers::arrayView(state.data);
+        return {};
+    }, state);
+
+    std::ostringstream out;
+    importer.setProfileCallback(printProfileStage, &out);
+
+    CORRADE_VERIFY(importer.openFile("file.dat"));
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterProfileStage::FileCallback 2\n"
+        "Trade::ImporterProfileStage::OpenData 2\n"
+        "Trade::ImporterProfileStage::FileCallback 0\n"
+        "Trade::ImporterProfileStage::OpenFile 2\n");
+
+    /* A failed load reports zero bytes */
+    out.str({});
+    {
+        std::ostringstream error;
+        Error redirectError{&error};
+        CORRADE_VERIFY(!importer.openFile("nonexistent.dat"));
+    }
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterProfileStage::FileCallback 0\n"
+        "Trade::ImporterProfileStage::OpenFile 0\n");
+}
+
+void AbstractImporterTest::profileOpenFileThroughCallbackZeroCopy() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+        bool doIsOpened() const override { return _opened; }
+        void doClose() override { _opened = false; }
+
+        void doOpenData(Containers::ArrayView<const char> data) override {
+            _opened = data.size() == 2;
+        }
+
+        bool _opened = false;
+    } importer;
+
+    struct State {
+        const char data[2]{'a', 'b'};
+    } state;
+    importer.setFileCallback([](const std::string& filename, InputFileCallbackPolicy policy, State& state) -> Containers::Optional<Containers::ArrayView<const char>> {
+        if(filename == "file.dat" && policy == InputFileCallbackPolicy::LoadPermanent)
+            return Containers::arrayView(state.data);
+        return {};
+    }, state);
+    importer.setFlags(ImporterFlag::ZeroCopy);
+
+    std::ostringstream out;
+    importer.setProfileCallback(printProfileStage, &out);
+
+    /* The file is never closed */
+    CORRADE_VERIFY(importer.openFile("file.dat"));
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterProfileStage::FileCallback 2\n"
+        "Trade::ImporterProfileStage::OpenData 2\n"
+        "Trade::ImporterProfileStage::OpenFile 2\n");
+
+    /* A failed load reports zero bytes */
+    out.str({});
+    {
+        std::ostringstream error;
+        Error redirectError{&error};
+        CORRADE_VERIFY(!importer.openFile("nonexistent.dat"));
+    }
+    CORRADE_COMPARE(out.str(),
+        "Trade::ImporterProfileStage::FileCallback 0\n"
+        "Trade::ImporterProfileStage::OpenFile 0\n");
+}
+
+void AbstractImporterTest::profileData() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 2; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+            if(id == 1) return {};
+            Containers::Array<char> indexData{3*sizeof(UnsignedShort)};
+            Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData);
+            indices[0] = 0;
+            indices[1] = 1;
+            indices[2] = 2;
+            return MeshData{MeshPrimitive::Triangles,
+                std::move(indexData), MeshIndexData{indices},
+                Containers::Array<char>{3*sizeof(Vector3)}, {MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 0, 3, sizeof(Vector3)}}};
+        }
+
+        UnsignedInt doImage2DCount() const override { return 2; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+            if(id == 1) return {};
+            return ImageData2D{PixelFormat::RGBA8Unorm, {2, 3}, Containers::Array<char>{2*3*4}};
+        }
+
+        UnsignedInt doMaterialCount() const override { return 2; }
+        Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override {
+            if(id == 1) return {};
+            return MaterialData{{}, {
+                {MaterialAttribute::Shininess, 15.0f},
+                {MaterialAttribute::AlphaMask, 0.5f}
+            }};
+        }
+    } importer;
+
+    std::ostringstream out;
+    importer.setProfileCallback(printProfileStage, &out);
+
+    CORRADE_VERIFY(importer.mesh(0));
+    CORRADE_VERIFY(!importer.mesh(1));
+    CORRADE_VERIFY(importer.partialMesh(0, 0, {MeshAttribute::Position}, 1, 2));
+    CORRADE_VERIFY(importer.image2D(0));
+    CORRADE_VERIFY(!importer.image2D(1));
+    CORRADE_VERIFY(importer.material(0));
+    CORRADE_VERIFY(!importer.material(1));
+    /* The partial mesh has two indices and two vertices */
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+        "Trade::ImporterProfileStage::Mesh 42\n"
+        "Trade::ImporterProfileStage::Mesh 0\n"
+        "Trade::ImporterProfileStage::Mesh 28\n"
+        "Trade::ImporterProfileStage::Image2D 24\n"
+        "Trade::ImporterProfileStage::Image2D 0\n"
+        "Trade::ImporterProfileStage::Material {}\n"
+        "Trade::ImporterProfileStage::Material 0\n",
+        2*sizeof(MaterialAttributeData)));
+}
+
+void AbstractImporterTest::setArrayArena() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    } importer;
+
+    CORRADE_VERIFY(!importer.arrayArena());
+
+    ArrayArena arena;
+    importer.setArrayArena(&arena);
+    CORRADE_COMPARE(importer.arrayArena(), &arena);
+
+    importer.setArrayArena(nullptr);
+    CORRADE_VERIFY(!importer.arrayArena());
+}
+
+void AbstractImporterTest::arrayArena() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+            Containers::Array<char> indexData{Containers::NoInit, 4*sizeof(UnsignedShort)};
+            Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData);
+            indices[0] = 0xffff; /* padding */
+            indices[1] = 2;
+            indices[2] = 1;
+            indices[3] = 0;
+            Containers::Array<char> vertexData{Containers::NoInit, 3*sizeof(Vector3)};
+            Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData);
+            positions[0] = {1.0f, 2.0f, 3.0f};
+            positions[1] = {4.0f, 5.0f, 6.0f};
+            positions[2] = {7.0f, 8.0f, 9.0f};
+            return MeshData{MeshPrimitive::Triangles,
+                std::move(indexData), MeshIndexData{indices.suffix(1)},
+                std::move(vertexData), {MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}}};
+        }
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            Containers::Array<char> data{Containers::NoInit, 4};
+            data[0] = 'a';
+            data[1] = 'b';
+            data[2] = 'c';
+            data[3] = 'd';
+            return ImageData2D{PixelFormat::R8Unorm, {2, 2}, std::move(data)};
+        }
+
+        UnsignedInt doMaterialCount() const override { return 1; }
+        Containers::Optional<MaterialData> doMaterial(UnsignedInt) override {
+            return MaterialData{{}, {
+                {MaterialAttribute::Shininess, 15.0f},
+                {MaterialAttribute::AlphaMask, 0.5f}
+            }, {1, 2}};
+        }
+    } importer;
+
+    ArrayArena arena;
+    importer.setArrayArena(&arena);
+
+    Containers::Optional<MeshData> mesh = importer.mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->indexOffset(), 2);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 1, 0}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f},
+            {4.0f, 5.0f, 6.0f},
+            {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+
+    Containers::Optional<ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 2}));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView({'a', 'b', 'c', 'd'}),
+        TestSuite::Compare::Container);
+
+    Containers::Optional<MaterialData> material = importer.material(0);
+    CORRADE_VERIFY(material);
+    CORRADE_COMPARE(material->layerCount(), 2);
+    CORRADE_COMPARE(material->attribute<Float>(MaterialAttribute::Shininess), 15.0f);
+    CORRADE_COMPARE(material->attribute<Float>(1, MaterialAttribute::AlphaMask), 0.5f);
+
+    /* Index, vertex and attribute data for the mesh, image data, material
+       attributes and layer offsets */
+    CORRADE_COMPARE(arena.allocationCount(), 6);
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+
+    /* All data come from the arena */
+    Containers::Array<char> indexData = mesh->releaseIndexData();
+    Containers::Array<char> vertexData = mesh->releaseVertexData();
+    Containers::Array<char> imageData = image->release();
+    CORRADE_VERIFY(indexData.deleter() == ArrayArena::deleter);
+    CORRADE_VERIFY(vertexData.deleter() == ArrayArena::deleter);
+    CORRADE_VERIFY(imageData.deleter() == ArrayArena::deleter);
+}
+
+void AbstractImporterTest::arrayArenaNonOwned() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doImage2DCount() const override { return 1; }
+        Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+            return ImageData2D{PixelFormat::R8Unorm, {2, 2}, DataFlags{}, data};
+        }
+
+        const char data[4]{'a', 'b', 'c', 'd'};
+    } importer;
+
+    ArrayArena arena;
+    importer.setArrayArena(&arena);
+
+    /* Non-owned data are left untouched */
+    Containers::Optional<ImageData2D> image = importer.image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->data().data(), importer.data);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+}
+
 void AbstractImporterTest::thingCountNotImplemented() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -1557,6 +2138,54 @@ void AbstractImporterTest::sceneOutOfRange() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::scene(): index 8 out of range for 8 entries\n");
 }
 
+void AbstractImporterTest::sceneCustomDataDeleter() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doSceneCount() const override { return 1; }
+        Containers::Optional<SceneData> doScene(UnsignedInt) override {
+            return SceneData{0, Containers::Array<char>{nullptr, 0, [](char*, std::size_t) {}}, {}};
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.scene(0);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::scene(): implementation is not allowed to use a custom Array deleter\n");
+}
+
+void AbstractImporterTest::sceneCustomFieldDataDeleter() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doSceneCount() const override { return 1; }
+        Containers::Optional<SceneData> doScene(UnsignedInt) override {
+            return SceneData{0, nullptr, Containers::Array<SceneFieldData>{&parents, 1, [](SceneFieldData*, std::size_t) {}}};
+        }
+
+        SceneFieldData parents{SceneField::Parent, SceneFieldType::Int, nullptr};
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.scene(0);
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::scene(): implementation is not allowed to use a custom Array deleter\n");
+}
+
 void AbstractImporterTest::animation() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -2955,6 +3584,267 @@ void AbstractImporterTest::meshCustomAttributesDeleter() {
     );
 }
 
+/* Interleaved positions, texture coordinates and normals. The indices
+   reference vertices 0-3 in the first half and 3-5 in the second. */
+struct PartialMeshImporter: AbstractImporter {
+    explicit PartialMeshImporter(bool indexed = true): indexed{indexed} {}
+
+    ImporterFeatures doFeatures() const override { return {}; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 1; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+        struct Vertex {
+            Vector3 position;
+            Vector2 textureCoordinates;
+            Vector3 normal;
+        };
+        Containers::Array<char> vertexData{6*sizeof(Vertex)};
+        Containers::ArrayView<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+        for(std::size_t i = 0; i != vertices.size(); ++i)
+            vertices[i] = {Vector3{Float(i)}, Vector2{Float(i)*10.0f}, Vector3{Float(i)*100.0f}};
+        Containers::Array<MeshAttributeData> attributes{Containers::InPlaceInit, {
+            MeshAttributeData{MeshAttribute::Position, Containers::stridedArrayView(vertices).slice(&Vertex::position)},
+            MeshAttributeData{MeshAttribute::TextureCoordinates, Containers::stridedArrayView(vertices).slice(&Vertex::textureCoordinates)},
+            MeshAttributeData{MeshAttribute::Normal, Containers::stridedArrayView(vertices).slice(&Vertex::normal)}
+        }};
+
+        if(!indexed) return MeshData{MeshPrimitive::Triangles,
+            std::move(vertexData), std::move(attributes), MeshData::ImplicitVertexCount, &state};
+
+        const UnsignedShort indexValues[]{0, 1, 2, 4, 3, 5};
+        Containers::Array<char> indexData{sizeof(indexValues)};
+        Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData);
+        std::copy(indexValues, indexValues + 6, indices.begin());
+        return MeshData{MeshPrimitive::Triangles,
+            std::move(indexData), MeshIndexData{indices},
+            std::move(vertexData), std::move(attributes), MeshData::ImplicitVertexCount, &state};
+    }
+
+    bool indexed;
+    int state;
+};
+
+void AbstractImporterTest::partialMesh() {
+    PartialMeshImporter importer;
+
+    Containers::Optional<MeshData> mesh = importer.partialMesh(0, 0, {MeshAttribute::Normal, MeshAttribute::Position}, 3, 3);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->importerState(), &importer.state);
+
+    /* The indices are rebased to the first referenced vertex, with the type
+       preserved */
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({1, 0, 2}),
+        TestSuite::Compare::Container);
+
+    /* Vertices 3 to 5, the attributes in the original order and not
+       interleaved */
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeName(0), MeshAttribute::Position);
+    CORRADE_COMPARE(mesh->attributeName(1), MeshAttribute::Normal);
+    CORRADE_COMPARE(mesh->attributeOffset(0), 0);
+    CORRADE_COMPARE(mesh->attributeStride(0), sizeof(Vector3));
+    CORRADE_COMPARE(mesh->attributeOffset(1), 3*sizeof(Vector3));
+    CORRADE_COMPARE(mesh->attributeStride(1), sizeof(Vector3));
+    CORRADE_COMPARE(mesh->vertexData().size(), 6*sizeof(Vector3));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            Vector3{3.0f}, Vector3{4.0f}, Vector3{5.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        Containers::arrayView<Vector3>({
+            Vector3{300.0f}, Vector3{400.0f}, Vector3{500.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::partialMeshNonIndexed() {
+    PartialMeshImporter importer{false};
+
+    /* The range is in vertices, count defaulting to the rest of the mesh */
+    std::initializer_list<MeshAttribute> attributes{MeshAttribute::TextureCoordinates};
+    Containers::Optional<MeshData> mesh = importer.partialMesh(0, 0, Containers::arrayView(attributes), 4);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->importerState(), &importer.state);
+    CORRADE_COMPARE(mesh->vertexCount(), 2);
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            Vector2{40.0f}, Vector2{50.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::partialMeshAllAttributes() {
+    PartialMeshImporter importer;
+
+    Containers::Optional<MeshData> mesh = importer.partialMesh(0, 0, {}, 0, 3);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 3);
+    CORRADE_COMPARE(mesh->attributeOffset(2), 3*(sizeof(Vector3) + sizeof(Vector2)));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            Vector2{0.0f}, Vector2{10.0f}, Vector2{20.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void AbstractImporterTest::partialMeshEmptyRange() {
+    PartialMeshImporter importer;
+
+    Containers::Optional<MeshData> mesh = importer.partialMesh(0, 0, {MeshAttribute::Position}, 6, 0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_VERIFY(mesh->isIndexed());
+    CORRADE_COMPARE(mesh->indexCount(), 0);
+    CORRADE_COMPARE(mesh->vertexCount(), 0);
+    CORRADE_COMPARE(mesh->attributeCount(), 1);
+}
+
+void AbstractImporterTest::partialMeshRangeOutOfBounds() {
+    PartialMeshImporter indexed;
+    PartialMeshImporter nonIndexed{false};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!indexed.partialMesh(0, 0, {}, 7));
+    CORRADE_VERIFY(!indexed.partialMesh(0, 0, {}, 4, 3));
+    CORRADE_VERIFY(!nonIndexed.partialMesh(0, 0, {}, 2, 5));
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::partialMesh(): offset 7 out of range for 6 indices\n"
+        "Trade::AbstractImporter::partialMesh(): offset 4 and count 3 out of range for 6 indices\n"
+        "Trade::AbstractImporter::partialMesh(): offset 2 and count 5 out of range for 6 vertices\n");
+}
+
+void AbstractImporterTest::partialMeshFailed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+            return {};
+        }
+    } importer;
+
+    CORRADE_VERIFY(!importer.partialMesh(0, 0, {MeshAttribute::Position}));
+}
+
+void AbstractImporterTest::partialMeshOverride() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 3; }
+        UnsignedInt doMeshLevelCount(UnsignedInt) override { return 3; }
+        Containers::Optional<MeshData> doPartialMesh(UnsignedInt id, UnsignedInt level, Containers::ArrayView<const MeshAttribute> attributes, UnsignedInt offset, UnsignedInt count) override {
+            /* doMesh() isn't implemented, so this would fail if the default
+               implementation was called */
+            if(id == 2 && level == 1 && attributes.size() == 1 && attributes[0] == MeshAttribute::Normal && offset == 7 && count == ~UnsignedInt{})
+                return MeshData{MeshPrimitive::Points, 15};
+            return {};
+        }
+    } importer;
+
+    Containers::Optional<MeshData> mesh = importer.partialMesh(2, 1, {MeshAttribute::Normal}, 7);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 15);
+}
+
+void AbstractImporterTest::partialMeshNoFile() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.partialMesh(0, 0, {});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::partialMesh(): no file opened\n");
+}
+
+void AbstractImporterTest::partialMeshOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 8; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.partialMesh(8, 0, {});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::partialMesh(): index 8 out of range for 8 entries\n");
+}
+
+void AbstractImporterTest::partialMeshLevelOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 8; }
+        UnsignedInt doMeshLevelCount(UnsignedInt id) override { return id ? 3 : 0; }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.partialMesh(0, 1, {});
+    importer.partialMesh(7, 3, {});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractImporter::partialMesh(): implementation reported zero levels\n"
+        "Trade::AbstractImporter::partialMesh(): level 3 out of range for 3 entries\n");
+}
+
+void AbstractImporterTest::partialMeshCustomDeleter() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 1; }
+        Containers::Optional<MeshData> doPartialMesh(UnsignedInt, UnsignedInt, Containers::ArrayView<const MeshAttribute>, UnsignedInt, UnsignedInt) override {
+            return MeshData{MeshPrimitive::Triangles, Containers::Array<char>{nullptr, 0, [](char*, std::size_t) {}}, {MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, nullptr}}};
+        }
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    importer.partialMesh(0, 0, {});
+    CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::partialMesh(): implementation is not allowed to use a custom Array deleter\n");
+}
+
 void AbstractImporterTest::meshAttributeName() {
     struct: AbstractImporter {
         ImporterFeatures doFeatures() const override { return {}; }
@@ -4632,15 +5522,22 @@ void AbstractImporterTest::debugFeatures() {
 void AbstractImporterTest::debugFlag() {
     std::ostringstream out;
 
-    Debug{&out} << ImporterFlag::Verbose << ImporterFlag(0xf0);
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag(0xf0)\n");
+    Debug{&out} << ImporterFlag::Verbose << ImporterFlag::ZeroCopy << ImporterFlag::YFlip << ImporterFlag(0xf0);
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose Trade::ImporterFlag::ZeroCopy Trade::ImporterFlag::YFlip Trade::ImporterFlag(0xf0)\n");
+}
+
+void AbstractImporterTest::debugProfileStage() {
+    std::ostringstream out;
+
+    Debug{&out} << ImporterProfileStage::OpenFile << ImporterProfileStage(0xf0);
+    CORRADE_COMPARE(out.str(), "Trade::ImporterProfileStage::OpenFile Trade::ImporterProfileStage(0xf0)\n");
 }
 
 void AbstractImporterTest::debugFlags() {
     std::ostringstream out;
 
-    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag(0xf0)) << ImporterFlags{};
-    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag(0xf0) Trade::ImporterFlags{}\n");
+    Debug{&out} << (ImporterFlag::Verbose|ImporterFlag::YFlip|ImporterFlag(0xf0)) << ImporterFlags{};
+    CORRADE_COMPARE(out.str(), "Trade::ImporterFlag::Verbose|Trade::ImporterFlag::YFlip|Trade::ImporterFlag(0xf0) Trade::ImporterFlags{}\n");
 }
 
 }}}}
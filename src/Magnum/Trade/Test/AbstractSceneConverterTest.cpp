@@ -24,11 +24,13 @@
 */
 
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Compare/FileToString.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Algorithms.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Math/Vector3.h"
@@ -71,6 +73,17 @@ struct AbstractSceneConverterTest: TestSuite::Tester {
     void convertMeshToFileThroughDataNotWritable();
     void convertMeshToFileNotImplemented();
 
+    void convertMultipleToData();
+    void convertMultipleToFile();
+    void convertMultipleToFileCallback();
+    void convertMultipleToFileThroughData();
+    void convertMultipleToFileNotWritable();
+    void convertMultipleAddFailed();
+    void convertMultipleAbort();
+    void convertMultipleNotSupported();
+    void convertMultipleNotImplemented();
+    void convertMultipleNoConversionInProgress();
+
     void debugFeature();
     void debugFeatures();
     void debugFlag();
@@ -106,6 +119,17 @@ AbstractSceneConverterTest::AbstractSceneConverterTest() {
               &AbstractSceneConverterTest::convertMeshToFileThroughDataNotWritable,
               &AbstractSceneConverterTest::convertMeshToFileNotImplemented,
 
+              &AbstractSceneConverterTest::convertMultipleToData,
+              &AbstractSceneConverterTest::convertMultipleToFile,
+              &AbstractSceneConverterTest::convertMultipleToFileCallback,
+              &AbstractSceneConverterTest::convertMultipleToFileThroughData,
+              &AbstractSceneConverterTest::convertMultipleToFileNotWritable,
+              &AbstractSceneConverterTest::convertMultipleAddFailed,
+              &AbstractSceneConverterTest::convertMultipleAbort,
+              &AbstractSceneConverterTest::convertMultipleNotSupported,
+              &AbstractSceneConverterTest::convertMultipleNotImplemented,
+              &AbstractSceneConverterTest::convertMultipleNoConversionInProgress,
+
               &AbstractSceneConverterTest::debugFeature,
               &AbstractSceneConverterTest::debugFeatures,
               &AbstractSceneConverterTest::debugFlag,
@@ -524,6 +548,282 @@ void AbstractSceneConverterTest::convertMeshToFileNotImplemented() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractSceneConverter::convertToFile(): mesh conversion advertised but not implemented\n");
 }
 
+void AbstractSceneConverterTest::convertMultipleToData() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginData() override {
+            arrayAppend(data, 'B');
+            return true;
+        }
+
+        bool doAdd(UnsignedInt id, const MeshData& mesh, const std::string& name) override {
+            arrayAppend(data, {char('0' + id), char(mesh.vertexCount()), name[0]});
+            return true;
+        }
+
+        Containers::Array<char> doEndData() override {
+            arrayAppend(data, 'E');
+            Containers::Array<char> out{Containers::NoInit, data.size()};
+            Utility::copy(data, out);
+            data = {};
+            return out;
+        }
+
+        Containers::Array<char> data;
+    } converter;
+
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_VERIFY(converter.beginData());
+    CORRADE_VERIFY(converter.isConverting());
+    CORRADE_COMPARE(converter.meshCount(), 0);
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 'a'}, "x"), 0);
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Lines, 'b'}, "y"), 1);
+    CORRADE_COMPARE(converter.meshCount(), 2);
+
+    Containers::Array<char> out = converter.endData();
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_COMPARE_AS(out, Containers::arrayView({'B', '0', 'a', 'x', '1', 'b', 'y', 'E'}), TestSuite::Compare::Container);
+}
+
+void AbstractSceneConverterTest::convertMultipleToFile() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToFile|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginFile(const std::string&) override {
+            return writeFileData(Containers::arrayView({'B'}));
+        }
+
+        /* Each mesh is written right away, nothing is kept in memory */
+        bool doAdd(UnsignedInt, const MeshData& mesh, const std::string&) override {
+            return writeFileData(Containers::arrayView({char(mesh.vertexCount())}));
+        }
+
+        bool doEndFile(const std::string&) override {
+            return writeFileData(Containers::arrayView({'E'}));
+        }
+    } converter;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "multiple.out");
+
+    /* Write some garbage first to verify the file gets truncated */
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "garbage"));
+
+    CORRADE_VERIFY(converter.beginFile(filename));
+    CORRADE_COMPARE_AS(filename, "B", TestSuite::Compare::FileToString);
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 'a'}), 0);
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 'b'}), 1);
+    CORRADE_COMPARE_AS(filename, "Bab", TestSuite::Compare::FileToString);
+    CORRADE_VERIFY(converter.endFile());
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_COMPARE_AS(filename, "BabE", TestSuite::Compare::FileToString);
+}
+
+void AbstractSceneConverterTest::convertMultipleToFileCallback() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToFile|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginFile(const std::string&) override { return true; }
+
+        bool doAdd(UnsignedInt, const MeshData& mesh, const std::string&) override {
+            return writeFileData(Containers::arrayView({char(mesh.vertexCount()), char(mesh.vertexCount())}));
+        }
+
+        bool doEndFile(const std::string&) override {
+            return writeFileData(Containers::arrayView({'E'}));
+        }
+    } converter;
+
+    std::string out;
+    converter.setFileCallback([](const std::string& filename, Containers::ArrayView<const char> data, void* userData) {
+        std::string& out = *static_cast<std::string*>(userData);
+        out += filename;
+        out += ':';
+        out += std::string{data.data(), data.size()};
+        out += ';';
+        return true;
+    }, &out);
+    CORRADE_VERIFY(converter.fileCallback());
+    CORRADE_COMPARE(converter.fileCallbackUserData(), &out);
+
+    /* The file shouldn't get touched at all */
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "multiple.out");
+    Utility::Directory::rm(filename);
+
+    CORRADE_VERIFY(converter.beginFile(filename));
+    CORRADE_VERIFY(converter.add(MeshData{MeshPrimitive::Triangles, 'a'}));
+    CORRADE_VERIFY(converter.add(MeshData{MeshPrimitive::Triangles, 'b'}));
+    CORRADE_VERIFY(converter.endFile());
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+    CORRADE_COMPARE(out,
+        filename + ":aa;" +
+        filename + ":bb;" +
+        filename + ":E;");
+}
+
+void AbstractSceneConverterTest::convertMultipleToFileThroughData() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginData() override { return true; }
+
+        bool doAdd(UnsignedInt, const MeshData& mesh, const std::string&) override {
+            count += mesh.vertexCount();
+            return true;
+        }
+
+        Containers::Array<char> doEndData() override {
+            return Containers::array({char(count)});
+        }
+
+        UnsignedInt count{};
+    } converter;
+
+    const std::string filename = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "multiple.out");
+
+    /* Remove previous file, if any */
+    Utility::Directory::rm(filename);
+    CORRADE_VERIFY(!Utility::Directory::exists(filename));
+
+    /* doBeginFile() should call doBeginData() and doEndFile() doEndData() */
+    CORRADE_VERIFY(converter.beginFile(filename));
+    CORRADE_VERIFY(converter.add(MeshData{MeshPrimitive::Triangles, 0x0f}));
+    CORRADE_VERIFY(converter.add(MeshData{MeshPrimitive::Triangles, 0xe0}));
+    CORRADE_VERIFY(converter.endFile());
+    CORRADE_COMPARE_AS(filename,
+        "\xef", TestSuite::Compare::FileToString);
+}
+
+void AbstractSceneConverterTest::convertMultipleToFileNotWritable() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToFile; }
+
+        bool doBeginFile(const std::string&) override {
+            CORRADE_FAIL("This shouldn't get called");
+            return true;
+        }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter.beginFile("/some/path/that/does/not/exist"));
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_COMPARE(out.str(),
+        "Utility::Directory::write(): can't open /some/path/that/does/not/exist\n"
+        "Trade::AbstractSceneConverter::beginFile(): cannot write to file /some/path/that/does/not/exist\n");
+}
+
+void AbstractSceneConverterTest::convertMultipleAddFailed() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginData() override { return true; }
+
+        bool doAdd(UnsignedInt, const MeshData& mesh, const std::string&) override {
+            return mesh.primitive() == MeshPrimitive::Triangles;
+        }
+    } converter;
+
+    CORRADE_VERIFY(converter.beginData());
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 3}), 0);
+    CORRADE_VERIFY(!converter.add(MeshData{MeshPrimitive::Lines, 2}));
+
+    /* The failed mesh isn't counted, the conversion continues */
+    CORRADE_VERIFY(converter.isConverting());
+    CORRADE_COMPARE(converter.meshCount(), 1);
+    CORRADE_COMPARE(converter.add(MeshData{MeshPrimitive::Triangles, 3}), 1);
+}
+
+void AbstractSceneConverterTest::convertMultipleAbort() {
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData; }
+
+        bool doBeginData() override { return true; }
+
+        void doAbort() override { ++abortCount; }
+
+        Int abortCount{};
+    } converter;
+
+    /* Not converting, shouldn't call doAbort() */
+    converter.abort();
+    CORRADE_COMPARE(converter.abortCount, 0);
+
+    CORRADE_VERIFY(converter.beginData());
+    converter.abort();
+    CORRADE_VERIFY(!converter.isConverting());
+    CORRADE_COMPARE(converter.abortCount, 1);
+
+    /* Beginning a new conversion aborts the previous one */
+    CORRADE_VERIFY(converter.beginData());
+    CORRADE_VERIFY(converter.beginData());
+    CORRADE_VERIFY(converter.isConverting());
+    CORRADE_COMPARE(converter.abortCount, 2);
+}
+
+void AbstractSceneConverterTest::convertMultipleNotSupported() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToFile; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginData();
+    converter.add(MeshData{MeshPrimitive::Triangles, 3});
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractSceneConverter::beginData(): multiple data conversion not supported\n"
+        "Trade::AbstractSceneConverter::add(): mesh conversion not supported\n");
+}
+
+void AbstractSceneConverterTest::convertMultipleNotImplemented() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.beginData();
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractSceneConverter::beginData(): multiple data conversion advertised but not implemented\n");
+}
+
+void AbstractSceneConverterTest::convertMultipleNoConversionInProgress() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractSceneConverter {
+        SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMultipleToData|SceneConverterFeature::AddMeshes; }
+
+        bool doBeginData() override { return true; }
+    } converter;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    converter.meshCount();
+    converter.add(MeshData{MeshPrimitive::Triangles, 3});
+    converter.endData();
+    converter.endFile();
+
+    /* Data conversion in progress, file functions still can't be used */
+    converter.beginData();
+    converter.endFile();
+    CORRADE_COMPARE(out.str(),
+        "Trade::AbstractSceneConverter::meshCount(): no conversion in progress\n"
+        "Trade::AbstractSceneConverter::add(): no conversion in progress\n"
+        "Trade::AbstractSceneConverter::endData(): no data conversion in progress\n"
+        "Trade::AbstractSceneConverter::endFile(): no file conversion in progress\n"
+        "Trade::AbstractSceneConverter::endFile(): no file conversion in progress\n");
+}
+
 void AbstractSceneConverterTest::debugFeature() {
     std::ostringstream out;
 
@@ -25,6 +25,7 @@
 
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Math/CubicHermite.h"
@@ -61,6 +62,13 @@ struct AnimationDataTest: TestSuite::Tester {
 
     void release();
 
+    void resample();
+    void resampleSpline();
+    void resampleConstant();
+    void resampleZeroDuration();
+    void resampleInvalidFrameRate();
+    void resampleCustomResultType();
+
     void debugAnimationTrackType();
     void debugAnimationTrackTargetType();
 };
@@ -102,6 +110,13 @@ AnimationDataTest::AnimationDataTest() {
 
               &AnimationDataTest::release,
 
+              &AnimationDataTest::resample,
+              &AnimationDataTest::resampleSpline,
+              &AnimationDataTest::resampleConstant,
+              &AnimationDataTest::resampleZeroDuration,
+              &AnimationDataTest::resampleInvalidFrameRate,
+              &AnimationDataTest::resampleCustomResultType,
+
               &AnimationDataTest::debugAnimationTrackType,
               &AnimationDataTest::debugAnimationTrackTargetType});
 }
@@ -654,6 +669,206 @@ void AnimationDataTest::release() {
     CORRADE_COMPARE(static_cast<const void*>(released.data()), keyframes);
 }
 
+void AnimationDataTest::resample() {
+    const std::pair<Float, Vector2> translation[] {
+        {0.0f, {0.0f, 2.0f}},
+        {1.5f, {3.0f, 5.0f}},
+        {2.0f, {1.0f, 1.0f}}
+    };
+    const std::pair<Float, Quaternion> rotation[] {
+        {0.5f, Quaternion::rotation(30.0_degf, Vector3::zAxis())},
+        {2.0f, Quaternion::rotation(120.0_degf, Vector3::zAxis())}
+    };
+
+    AnimationData animation{nullptr, {
+        AnimationTrackData{AnimationTrackTargetType::Translation2D, 3,
+            Animation::TrackView<const Float, const Vector2>{translation,
+                Animation::Interpolation::Linear, Animation::Extrapolation::Extrapolated}},
+        AnimationTrackData{AnimationTrackTargetType::Rotation3D, 7,
+            Animation::TrackView<const Float, const Quaternion>{rotation,
+                Animation::Interpolation::Spherical, Animation::Extrapolation::DefaultConstructed, Animation::Extrapolation::Constant}}
+        }};
+    CORRADE_COMPARE(animation.duration(), (Range1D{0.0f, 2.0f}));
+
+    /* 2*1.75 rounds up to 4 frames, plus one for the end */
+    AnimationData resampled = resampleAnimation(animation, 1.75f);
+    CORRADE_COMPARE(resampled.dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{0.0f, 2.0f}));
+    CORRADE_COMPARE(resampled.trackCount(), 2);
+
+    CORRADE_COMPARE(resampled.trackType(0), AnimationTrackType::Vector2);
+    CORRADE_COMPARE(resampled.trackResultType(0), AnimationTrackType::Vector2);
+    CORRADE_COMPARE(resampled.trackTargetType(0), AnimationTrackTargetType::Translation2D);
+    CORRADE_COMPARE(resampled.trackTarget(0), 3);
+
+    CORRADE_COMPARE(resampled.trackType(1), AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(resampled.trackResultType(1), AnimationTrackType::Quaternion);
+    CORRADE_COMPARE(resampled.trackTargetType(1), AnimationTrackTargetType::Rotation3D);
+    CORRADE_COMPARE(resampled.trackTarget(1), 7);
+
+    const Animation::TrackView<const Float, const Vector2>& resampledTranslation = resampled.track<Vector2>(0);
+    CORRADE_COMPARE(resampledTranslation.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(resampledTranslation.before(), Animation::Extrapolation::Extrapolated);
+    CORRADE_COMPARE(resampledTranslation.after(), Animation::Extrapolation::Extrapolated);
+    CORRADE_COMPARE_AS(resampledTranslation.keys(), Containers::arrayView({
+        0.0f, 0.5f, 1.0f, 1.5f, 2.0f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(resampledTranslation.values(), Containers::arrayView<Vector2>({
+        {0.0f, 2.0f}, {1.0f, 3.0f}, {2.0f, 4.0f}, {3.0f, 5.0f}, {1.0f, 1.0f}
+    }), TestSuite::Compare::Container);
+
+    /* The spherical interpolation is replaced with a linear one, the value
+       before the first original keyframe is default-constructed */
+    const Animation::TrackView<const Float, const Quaternion>& resampledRotation = resampled.track<Quaternion>(1);
+    CORRADE_COMPARE(resampledRotation.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE(resampledRotation.before(), Animation::Extrapolation::DefaultConstructed);
+    CORRADE_COMPARE(resampledRotation.after(), Animation::Extrapolation::Constant);
+    CORRADE_COMPARE_AS(resampledRotation.values(), Containers::arrayView<Quaternion>({
+        Quaternion{},
+        Quaternion::rotation(30.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(60.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(90.0_degf, Vector3::zAxis()),
+        Quaternion::rotation(120.0_degf, Vector3::zAxis())
+    }), TestSuite::Compare::Container);
+
+    /* All tracks share the same keys, stored at the front of the data */
+    CORRADE_COMPARE(resampledRotation.keys().data(), resampledTranslation.keys().data());
+    CORRADE_COMPARE(resampledRotation.keys().data(), static_cast<const void*>(resampled.data().data()));
+    CORRADE_COMPARE(resampled.data().size(), 5*4 + 5*8 + 5*16);
+
+    /* Evaluating gives the same results as the original at the frames and
+       approximately the same in between */
+    CORRADE_COMPARE(resampledTranslation.at(0.75f), (Vector2{1.5f, 3.5f}));
+    CORRADE_COMPARE(resampledTranslation.at(2.5f), animation.track<Vector2>(0).at(2.5f));
+}
+
+void AnimationDataTest::resampleSpline() {
+    const std::pair<Float, CubicHermite3D> keyframes[] {
+        {1.0f, {{}, {0.0f, 0.0f, 0.0f}, {3.0f, 0.0f, 0.0f}}},
+        {3.0f, {{3.0f, 0.0f, 0.0f}, {2.0f, 4.0f, 6.0f}, {}}}
+    };
+
+    AnimationData animation{nullptr, {
+        AnimationTrackData{AnimationTrackTargetType::Translation3D, 0,
+            Animation::TrackView<const Float, const CubicHermite3D>{keyframes,
+                Animation::Interpolation::Spline}}
+        }};
+
+    AnimationData resampled = resampleAnimation(animation, 2.0f);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{1.0f, 3.0f}));
+    CORRADE_COMPARE(resampled.trackCount(), 1);
+    CORRADE_COMPARE(resampled.trackType(0), AnimationTrackType::Vector3);
+    CORRADE_COMPARE(resampled.trackResultType(0), AnimationTrackType::Vector3);
+
+    const Animation::TrackView<const Float, const Vector3>& track = resampled.track<Vector3>(0);
+    CORRADE_COMPARE(track.interpolation(), Animation::Interpolation::Linear);
+    CORRADE_COMPARE_AS(track.keys(), Containers::arrayView({
+        1.0f, 1.5f, 2.0f, 2.5f, 3.0f
+    }), TestSuite::Compare::Container);
+
+    const Animation::TrackView<const Float, const CubicHermite3D, Vector3>& original = animation.track<CubicHermite3D>(0);
+    for(std::size_t i = 0; i != track.size(); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(track.values()[i], original.at(track.keys()[i]));
+    }
+}
+
+void AnimationDataTest::resampleConstant() {
+    const std::pair<Float, bool> visibility[] {
+        {0.0f, true},
+        {0.6f, false},
+        {1.0f, true}
+    };
+    const std::pair<Float, Int> frame[] {
+        {0.0f, 3},
+        {1.0f, -5}
+    };
+
+    AnimationData animation{nullptr, {
+        AnimationTrackData{AnimationTrackTargetType(129), 0,
+            Animation::TrackView<const Float, const bool>{visibility,
+                Animation::Interpolation::Constant}},
+        AnimationTrackData{AnimationTrackTargetType(130), 1,
+            Animation::TrackView<const Float, const Int>{frame,
+                Animation::Interpolation::Constant}}
+        }};
+
+    AnimationData resampled = resampleAnimation(animation, 4.0f);
+    CORRADE_COMPARE(resampled.trackCount(), 2);
+
+    const Animation::TrackView<const Float, const bool>& resampledVisibility = resampled.track<bool>(0);
+    CORRADE_COMPARE(resampledVisibility.interpolation(), Animation::Interpolation::Constant);
+    CORRADE_COMPARE_AS(resampledVisibility.values(), Containers::arrayView({
+        true, true, true, false, true
+    }), TestSuite::Compare::Container);
+
+    const Animation::TrackView<const Float, const Int>& resampledFrame = resampled.track<Int>(1);
+    CORRADE_COMPARE(resampledFrame.interpolation(), Animation::Interpolation::Constant);
+    CORRADE_COMPARE_AS(resampledFrame.values(), Containers::arrayView({
+        3, 3, 3, 3, -5
+    }), TestSuite::Compare::Container);
+
+    /* The bool values are padded to keep the following track aligned */
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(resampledFrame.values().data()) % 4, 0);
+    CORRADE_COMPARE(resampled.data().size(), 5*4 + 8 + 5*4);
+}
+
+void AnimationDataTest::resampleZeroDuration() {
+    const std::pair<Float, Float> keyframes[] {
+        {2.5f, 7.0f}
+    };
+
+    AnimationData animation{nullptr, {
+        AnimationTrackData{AnimationTrackTargetType(129), 0,
+            Animation::TrackView<const Float, const Float>{keyframes,
+                Animation::Interpolation::Linear}}
+        }};
+    CORRADE_COMPARE(animation.duration(), (Range1D{2.5f, 2.5f}));
+
+    /* There's always at least one frame */
+    AnimationData resampled = resampleAnimation(animation, 60.0f);
+    CORRADE_COMPARE(resampled.duration(), (Range1D{2.5f, 2.5f}));
+    CORRADE_COMPARE_AS(resampled.track<Float>(0).keys(), Containers::arrayView({
+        2.5f
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(resampled.track<Float>(0).values(), Containers::arrayView({
+        7.0f
+    }), TestSuite::Compare::Container);
+}
+
+void AnimationDataTest::resampleInvalidFrameRate() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    AnimationData animation{nullptr, nullptr};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampleAnimation(animation, 0.0f);
+    resampleAnimation(animation, -24.0f);
+    CORRADE_COMPARE(out.str(),
+        "Trade::resampleAnimation(): expected a positive frame rate, got 0\n"
+        "Trade::resampleAnimation(): expected a positive frame rate, got -24\n");
+}
+
+void AnimationDataTest::resampleCustomResultType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    AnimationData animation{nullptr, {
+        AnimationTrackData{AnimationTrackType::Vector3i,
+            AnimationTrackType::Vector3,
+            AnimationTrackTargetType::Scaling3D, 0, {}}
+        }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    resampleAnimation(animation, 30.0f);
+    CORRADE_COMPARE(out.str(), "Trade::resampleAnimation(): unsupported result type Trade::AnimationTrackType::Vector3 for track 0 of Trade::AnimationTrackType::Vector3i\n");
+}
+
 void AnimationDataTest::debugAnimationTrackType() {
     std::ostringstream out;
 
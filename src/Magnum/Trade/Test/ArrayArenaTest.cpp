@@ -0,0 +1,216 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdint>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/ArrayArena.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct ArrayArenaTest: TestSuite::Tester {
+    explicit ArrayArenaTest();
+
+    void construct();
+    void constructZeroChunkSize();
+    void constructMove();
+
+    void allocate();
+    void allocateEmpty();
+    void allocateTyped();
+    void allocateLarge();
+    void allocateNewChunk();
+
+    void release();
+};
+
+ArrayArenaTest::ArrayArenaTest() {
+    addTests({&ArrayArenaTest::construct,
+              &ArrayArenaTest::constructZeroChunkSize,
+              &ArrayArenaTest::constructMove,
+
+              &ArrayArenaTest::allocate,
+              &ArrayArenaTest::allocateEmpty,
+              &ArrayArenaTest::allocateTyped,
+              &ArrayArenaTest::allocateLarge,
+              &ArrayArenaTest::allocateNewChunk,
+
+              &ArrayArenaTest::release});
+}
+
+void ArrayArenaTest::construct() {
+    ArrayArena arena{4096};
+    CORRADE_COMPARE(arena.chunkSize(), 4096);
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 0);
+}
+
+void ArrayArenaTest::constructZeroChunkSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    ArrayArena{0};
+    CORRADE_COMPARE(out.str(), "Trade::ArrayArena: chunk size can't be zero\n");
+}
+
+void ArrayArenaTest::constructMove() {
+    ArrayArena a{4096};
+    Containers::Array<char> data = a.allocate(16);
+    data[0] = 'x';
+
+    ArrayArena b{std::move(a)};
+    CORRADE_COMPARE(b.chunkSize(), 4096);
+    CORRADE_COMPARE(b.chunkCount(), 1);
+    CORRADE_COMPARE(b.allocationCount(), 1);
+    /* The memory is still there */
+    CORRADE_COMPARE(data[0], 'x');
+
+    ArrayArena c{1024};
+    c = std::move(b);
+    CORRADE_COMPARE(c.chunkSize(), 4096);
+    CORRADE_COMPARE(c.chunkCount(), 1);
+    CORRADE_COMPARE(data[0], 'x');
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ArrayArena>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ArrayArena>::value);
+}
+
+void ArrayArenaTest::allocate() {
+    ArrayArena arena{4096};
+
+    Containers::Array<char> a = arena.allocate(3);
+    Containers::Array<char> b = arena.allocate(17);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(b.size(), 17);
+    CORRADE_VERIFY(a.deleter() == ArrayArena::deleter);
+    CORRADE_VERIFY(b.deleter() == ArrayArena::deleter);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % ArrayArena::Alignment, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % ArrayArena::Alignment, 0);
+
+    /* Both come from the same chunk, after each other */
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+    CORRADE_COMPARE(b.data() - a.data(), 16);
+    CORRADE_COMPARE(arena.allocationCount(), 2);
+    CORRADE_COMPARE(arena.allocatedSize(), 20);
+
+    /* The memory is writable and the allocations don't overlap */
+    for(char& i: a) i = 'a';
+    for(char& i: b) i = 'b';
+    CORRADE_COMPARE(a[2], 'a');
+    CORRADE_COMPARE(b[0], 'b');
+}
+
+void ArrayArenaTest::allocateEmpty() {
+    ArrayArena arena{4096};
+
+    Containers::Array<char> a = arena.allocate(0);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+}
+
+void ArrayArenaTest::allocateTyped() {
+    ArrayArena arena{4096};
+
+    Containers::Array<Vector3> a = arena.allocate<Vector3>(5);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % ArrayArena::Alignment, 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 5*sizeof(Vector3));
+
+    a[4] = {1.0f, 2.0f, 3.0f};
+    CORRADE_COMPARE(a[4], (Vector3{1.0f, 2.0f, 3.0f}));
+}
+
+void ArrayArenaTest::allocateLarge() {
+    ArrayArena arena{64};
+
+    Containers::Array<char> a = arena.allocate(16);
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+
+    /* Gets a dedicated chunk */
+    Containers::Array<char> b = arena.allocate(100);
+    CORRADE_COMPARE(b.size(), 100);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % ArrayArena::Alignment, 0);
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+
+    /* Small allocations continue in the original chunk */
+    Containers::Array<char> c = arena.allocate(16);
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    CORRADE_COMPARE(c.data() - a.data(), 16);
+}
+
+void ArrayArenaTest::allocateNewChunk() {
+    ArrayArena arena{128};
+
+    Containers::Array<char> a = arena.allocate(80);
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+
+    /* Doesn't fit into the rest of the first chunk */
+    Containers::Array<char> b = arena.allocate(80);
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % ArrayArena::Alignment, 0);
+
+    /* Continues in the second chunk */
+    Containers::Array<char> c = arena.allocate(8);
+    CORRADE_COMPARE(arena.chunkCount(), 2);
+    CORRADE_COMPARE(c.data() - b.data(), 80);
+}
+
+void ArrayArenaTest::release() {
+    ArrayArena arena{64};
+    {
+        Containers::Array<char> a = arena.allocate(40);
+        Containers::Array<char> b = arena.allocate(400);
+        CORRADE_COMPARE(arena.chunkCount(), 2);
+    }
+
+    arena.release();
+    CORRADE_COMPARE(arena.chunkCount(), 0);
+    CORRADE_COMPARE(arena.allocationCount(), 0);
+    CORRADE_COMPARE(arena.allocatedSize(), 0);
+
+    /* Can be used again */
+    Containers::Array<char> c = arena.allocate(16);
+    CORRADE_COMPARE(c.size(), 16);
+    CORRADE_COMPARE(arena.chunkCount(), 1);
+
+    /* Destructing arrays after the release is fine as the deleter does
+       nothing */
+    Containers::Array<char> d = arena.allocate(16);
+    arena.release();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ArrayArenaTest)
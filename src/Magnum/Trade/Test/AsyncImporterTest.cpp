@@ -0,0 +1,315 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AsyncImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MaterialData.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct AsyncImporterTest: TestSuite::Tester {
+    explicit AsyncImporterTest();
+
+    void construct();
+    void constructNotConcurrent();
+    void constructNotOpened();
+
+    void mesh();
+    void image2D();
+    void material();
+    void failed();
+    void notConcurrent();
+    void wait();
+
+    void outOfRange();
+};
+
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0}
+};
+
+AsyncImporterTest::AsyncImporterTest() {
+    addTests({&AsyncImporterTest::construct,
+              &AsyncImporterTest::constructNotConcurrent,
+              &AsyncImporterTest::constructNotOpened});
+
+    addInstancedTests({&AsyncImporterTest::mesh,
+                       &AsyncImporterTest::image2D,
+                       &AsyncImporterTest::material},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&AsyncImporterTest::failed,
+              &AsyncImporterTest::notConcurrent,
+              &AsyncImporterTest::wait,
+
+              &AsyncImporterTest::outOfRange});
+}
+
+/* Mesh vertex count, image width and material shininess is derived from the
+   ID, mesh level 1 has the vertex count counting down instead */
+struct Importer: AbstractImporter {
+    explicit Importer(ImporterFeatures features = ImporterFeature::ConcurrentImport): features{features} {}
+
+    ImporterFeatures doFeatures() const override { return features; }
+    bool doIsOpened() const override { return true; }
+    void doClose() override {}
+
+    UnsignedInt doMeshCount() const override { return 100; }
+    UnsignedInt doMeshLevelCount(UnsignedInt) override { return 2; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt level) override {
+        return MeshData{MeshPrimitive::Points, level ? 1000 - id : id + 1};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 50; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        return ImageData2D{PixelFormat::RGBA8Unorm, {Int(id) + 1, 1}, Containers::Array<char>{Containers::ValueInit, 4*(std::size_t(id) + 1)}};
+    }
+
+    UnsignedInt doMaterialCount() const override { return 25; }
+    Containers::Optional<MaterialData> doMaterial(UnsignedInt id) override {
+        return MaterialData{MaterialType::Phong, {
+            {MaterialAttribute::Shininess, Float(id)}
+        }};
+    }
+
+    ImporterFeatures features;
+};
+
+void AsyncImporterTest::construct() {
+    Importer importer;
+
+    {
+        AsyncImporter async{importer, 3};
+        CORRADE_COMPARE(&async.importer(), &importer);
+        #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+        CORRADE_COMPARE(async.threadCount(), 0);
+        #else
+        CORRADE_COMPARE(async.threadCount(), 3);
+        #endif
+    } {
+        AsyncImporter async{importer};
+        #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+        CORRADE_COMPARE(async.threadCount(), 0);
+        #else
+        CORRADE_VERIFY(async.threadCount() >= 1);
+        #endif
+    }
+
+    CORRADE_VERIFY(!std::is_copy_constructible<AsyncImporter>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<AsyncImporter>{});
+    CORRADE_VERIFY(!std::is_move_constructible<AsyncImporter>{});
+    CORRADE_VERIFY(!std::is_move_assignable<AsyncImporter>{});
+}
+
+void AsyncImporterTest::constructNotConcurrent() {
+    Importer importer{ImporterFeatures{}};
+
+    /* The thread count is ignored */
+    AsyncImporter async{importer, 3};
+    #if defined(CORRADE_TARGET_EMSCRIPTEN) && !defined(__EMSCRIPTEN_PTHREADS__)
+    CORRADE_COMPARE(async.threadCount(), 0);
+    #else
+    CORRADE_COMPARE(async.threadCount(), 1);
+    #endif
+}
+
+void AsyncImporterTest::constructNotOpened() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return false; }
+        void doClose() override {}
+    } importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    AsyncImporter async{importer};
+    CORRADE_COMPARE(out.str(), "Trade::AsyncImporter: no file opened\n");
+}
+
+void AsyncImporterTest::mesh() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer;
+    AsyncImporter async{importer, data.threadCount};
+
+    std::vector<std::future<Containers::Optional<MeshData>>> meshes;
+    for(UnsignedInt i = 0; i != 100; ++i) meshes.push_back(async.mesh(i, i % 2));
+
+    for(UnsignedInt i = 0; i != 100; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<MeshData> mesh = meshes[i].get();
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), i % 2 ? 1000 - i : i + 1);
+    }
+}
+
+void AsyncImporterTest::image2D() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer;
+    AsyncImporter async{importer, data.threadCount};
+
+    std::vector<std::future<Containers::Optional<ImageData2D>>> images;
+    for(UnsignedInt i = 0; i != 50; ++i) images.push_back(async.image2D(i));
+
+    for(UnsignedInt i = 0; i != 50; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<ImageData2D> image = images[i].get();
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), (Vector2i{Int(i) + 1, 1}));
+    }
+}
+
+void AsyncImporterTest::material() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Importer importer;
+    AsyncImporter async{importer, data.threadCount};
+
+    std::vector<std::future<Containers::Optional<MaterialData>>> materials;
+    for(UnsignedInt i = 0; i != 25; ++i) materials.push_back(async.material(i));
+
+    for(UnsignedInt i = 0; i != 25; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<MaterialData> material = materials[i].get();
+        CORRADE_VERIFY(material);
+        CORRADE_COMPARE(material->attribute<Float>(MaterialAttribute::Shininess), Float(i));
+    }
+}
+
+void AsyncImporterTest::failed() {
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return ImporterFeature::ConcurrentImport; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 2; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+            if(id == 1) return {};
+            return MeshData{MeshPrimitive::Points, 3};
+        }
+    } importer;
+
+    AsyncImporter async{importer, 2};
+    std::future<Containers::Optional<MeshData>> a = async.mesh(0);
+    std::future<Containers::Optional<MeshData>> b = async.mesh(1);
+    CORRADE_VERIFY(a.get());
+    CORRADE_VERIFY(!b.get());
+}
+
+void AsyncImporterTest::notConcurrent() {
+    /* An importer that doesn't advertise concurrent import should never be
+       called from more than one thread at a time */
+    struct: AbstractImporter {
+        ImporterFeatures doFeatures() const override { return {}; }
+        bool doIsOpened() const override { return true; }
+        void doClose() override {}
+
+        UnsignedInt doMeshCount() const override { return 16; }
+        Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+            const Int current = ++active;
+            Int previous = maxActive.load();
+            while(current > previous && !maxActive.compare_exchange_weak(previous, current));
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            --active;
+            return MeshData{MeshPrimitive::Points, id};
+        }
+
+        std::atomic<Int> active{0}, maxActive{0};
+    } importer;
+
+    {
+        AsyncImporter async{importer, 8};
+        for(UnsignedInt i = 0; i != 16; ++i) async.mesh(i);
+    }
+
+    CORRADE_COMPARE(importer.maxActive.load(), 1);
+}
+
+void AsyncImporterTest::wait() {
+    Importer importer;
+    AsyncImporter async{importer, 4};
+
+    std::vector<std::future<Containers::Optional<MeshData>>> meshes;
+    for(UnsignedInt i = 0; i != 100; ++i) meshes.push_back(async.mesh(i));
+
+    async.wait();
+    for(UnsignedInt i = 0; i != 100; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_VERIFY(meshes[i].wait_for(std::chrono::seconds{0}) == std::future_status::ready);
+    }
+
+    /* The importer can be used directly again */
+    CORRADE_COMPARE(importer.mesh(5)->vertexCount(), 6);
+}
+
+void AsyncImporterTest::outOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Importer importer;
+    AsyncImporter async{importer, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!async.mesh(100).valid());
+    CORRADE_VERIFY(!async.image2D(50).valid());
+    CORRADE_VERIFY(!async.material(25).valid());
+    CORRADE_COMPARE(out.str(),
+        "Trade::AsyncImporter::mesh(): index 100 out of range for 100 entries\n"
+        "Trade::AsyncImporter::image2D(): index 50 out of range for 50 entries\n"
+        "Trade::AsyncImporter::material(): index 25 out of range for 25 entries\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AsyncImporterTest)
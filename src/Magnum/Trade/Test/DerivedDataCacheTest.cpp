@@ -0,0 +1,549 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector2.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/DerivedDataCache.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct DerivedDataCacheTest: TestSuite::Tester {
+    explicit DerivedDataCacheTest();
+
+    void construct();
+    void constructCopy();
+    void constructMove();
+
+    void mesh();
+    void meshProcessed();
+    void meshSourceChanged();
+    void meshImporterConfigurationChanged();
+    void meshImportFailed();
+    void meshProcessingFailed();
+    void meshCorruptedCache();
+    void image2D();
+    void image2DProcessed();
+
+    void fileNotFound();
+
+    void setup();
+
+    std::string _directory, _source;
+};
+
+DerivedDataCacheTest::DerivedDataCacheTest() {
+    addTests({&DerivedDataCacheTest::construct,
+              &DerivedDataCacheTest::constructCopy,
+              &DerivedDataCacheTest::constructMove});
+
+    addTests({&DerivedDataCacheTest::mesh,
+              &DerivedDataCacheTest::meshProcessed,
+              &DerivedDataCacheTest::meshSourceChanged,
+              &DerivedDataCacheTest::meshImporterConfigurationChanged,
+              &DerivedDataCacheTest::meshImportFailed,
+              &DerivedDataCacheTest::meshProcessingFailed,
+              &DerivedDataCacheTest::meshCorruptedCache,
+              &DerivedDataCacheTest::image2D,
+              &DerivedDataCacheTest::image2DProcessed},
+        &DerivedDataCacheTest::setup,
+        &DerivedDataCacheTest::setup);
+
+    addTests({&DerivedDataCacheTest::fileNotFound});
+
+    _directory = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "DerivedDataCacheTestFiles/cache");
+    _source = Utility::Directory::join(TRADE_TEST_OUTPUT_DIR, "DerivedDataCacheTestFiles/source.bin");
+}
+
+/* Removes all cache files and resets the source file */
+void DerivedDataCacheTest::setup() {
+    if(Utility::Directory::exists(_directory))
+        for(const std::string& file: Utility::Directory::list(_directory, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot))
+            CORRADE_VERIFY(Utility::Directory::rm(Utility::Directory::join(_directory, file)));
+
+    CORRADE_VERIFY(Utility::Directory::mkpath(Utility::Directory::path(_source)));
+    CORRADE_VERIFY(Utility::Directory::writeString(_source, "hello"));
+}
+
+std::size_t cacheFileCount(const std::string& directory) {
+    if(!Utility::Directory::exists(directory)) return 0;
+    return Utility::Directory::list(directory, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot).size();
+}
+
+/* Mesh vertex count and image width is the source file size, mesh 1 and image
+   1 fail to import */
+struct SourceImporter: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+    bool doIsOpened() const override { return opened; }
+    void doClose() override { opened = false; }
+    void doOpenData(Containers::ArrayView<const char> data) override {
+        opened = true;
+        size = data.size();
+        ++openCount;
+    }
+
+    UnsignedInt doMeshCount() const override { return 2; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt id, UnsignedInt) override {
+        ++importCount;
+        if(id == 1) {
+            Error{} << "mesh import failed";
+            return {};
+        }
+        return MeshData{MeshPrimitive::Points, UnsignedInt(size)};
+    }
+
+    UnsignedInt doImage2DCount() const override { return 2; }
+    UnsignedInt doImage2DLevelCount(UnsignedInt) override { return 2; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt) override {
+        ++importCount;
+        if(id == 1) {
+            Error{} << "image import failed";
+            return {};
+        }
+        return ImageData2D{PixelFormat::RGBA8Unorm, {Int(size), 1}, Containers::Array<char>{Containers::ValueInit, 4*size}};
+    }
+
+    bool opened{};
+    std::size_t size{};
+    Int openCount{}, importCount{};
+};
+
+/* A trivial serialization format -- a type character followed by the mesh
+   vertex count or image width */
+struct BlobSceneConverter: AbstractSceneConverter {
+    SceneConverterFeatures doFeatures() const override { return SceneConverterFeature::ConvertMeshToData; }
+    Containers::Array<char> doConvertToData(const MeshData& mesh) override {
+        Containers::Array<char> out{Containers::NoInit, 5};
+        out[0] = 'M';
+        const UnsignedInt vertexCount = mesh.vertexCount();
+        std::memcpy(out + 1, &vertexCount, 4);
+        return out;
+    }
+};
+
+struct BlobImageConverter: AbstractImageConverter {
+    ImageConverterFeatures doFeatures() const override { return ImageConverterFeature::ConvertData; }
+    Containers::Array<char> doExportToData(const ImageView2D& image) override {
+        Containers::Array<char> out{Containers::NoInit, 5};
+        out[0] = 'I';
+        const Int width = image.size().x();
+        std::memcpy(out + 1, &width, 4);
+        return out;
+    }
+};
+
+struct BlobImporter: AbstractImporter {
+    ImporterFeatures doFeatures() const override { return ImporterFeature::OpenData; }
+    bool doIsOpened() const override { return !!data; }
+    void doClose() override { data = nullptr; }
+    void doOpenData(Containers::ArrayView<const char> in) override {
+        if(in.size() != 5 || (in[0] != 'M' && in[0] != 'I')) {
+            Error{} << "invalid blob";
+            return;
+        }
+        data = Containers::Array<char>{Containers::NoInit, in.size()};
+        std::memcpy(data, in, in.size());
+    }
+
+    UnsignedInt doMeshCount() const override { return data[0] == 'M'; }
+    Containers::Optional<MeshData> doMesh(UnsignedInt, UnsignedInt) override {
+        UnsignedInt vertexCount;
+        std::memcpy(&vertexCount, data + 1, 4);
+        return MeshData{MeshPrimitive::Points, vertexCount};
+    }
+
+    UnsignedInt doImage2DCount() const override { return data[0] == 'I'; }
+    Containers::Optional<ImageData2D> doImage2D(UnsignedInt, UnsignedInt) override {
+        Int width;
+        std::memcpy(&width, data + 1, 4);
+        return ImageData2D{PixelFormat::RGBA8Unorm, {width, 1}, Containers::Array<char>{Containers::ValueInit, 4*std::size_t(width)}};
+    }
+
+    Containers::Array<char> data;
+};
+
+void DerivedDataCacheTest::construct() {
+    BlobImporter importer;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    DerivedDataCache cache{"some/directory", importer, sceneConverter, imageConverter};
+    CORRADE_COMPARE(cache.directory(), "some/directory");
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 0);
+}
+
+void DerivedDataCacheTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DerivedDataCache>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DerivedDataCache>{});
+}
+
+void DerivedDataCacheTest::constructMove() {
+    BlobImporter importer;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    DerivedDataCache a{"some/directory", importer, sceneConverter, imageConverter};
+
+    DerivedDataCache b{std::move(a)};
+    CORRADE_COMPARE(b.directory(), "some/directory");
+
+    DerivedDataCache c{"another", importer, sceneConverter, imageConverter};
+    c = std::move(b);
+    CORRADE_COMPARE(c.directory(), "some/directory");
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DerivedDataCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DerivedDataCache>::value);
+}
+
+void DerivedDataCacheTest::mesh() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+
+    /* First run imports the data and populates the cache */
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.openCount, 1);
+        CORRADE_COMPARE(importer.importCount, 1);
+        CORRADE_COMPARE(cacheFileCount(_directory), 1);
+
+        /* Second request in the same run is a hit */
+        mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.importCount, 1);
+    }
+
+    /* Next run doesn't touch the source importer at all */
+    importer.close();
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 0);
+        CORRADE_VERIFY(!importer.isOpened());
+        CORRADE_COMPARE(importer.openCount, 1);
+        CORRADE_COMPARE(importer.importCount, 1);
+    }
+}
+
+void DerivedDataCacheTest::meshProcessed() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    UnsignedInt multiplier = 3;
+    DerivedDataCache::MeshProcessor processor = [](MeshData&& mesh, void* userData) {
+        return Containers::optional(MeshData{mesh.primitive(), mesh.vertexCount()*(*static_cast<UnsignedInt*>(userData))});
+    };
+
+    Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "triple-v1", processor, &multiplier);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 15);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* The processed result is cached, the processor isn't called */
+    multiplier = 1000;
+    mesh = cache.mesh(importer, _source, 0, "triple-v1", processor, &multiplier);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 15);
+    CORRADE_COMPARE(cache.hitCount(), 1);
+
+    /* A different pipeline string is a different result. The source file
+       stays opened from the previous miss, so it's not opened again. */
+    multiplier = 2;
+    mesh = cache.mesh(importer, _source, 0, "double-v1", processor, &multiplier);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 10);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(importer.openCount, 1);
+    CORRADE_COMPARE(importer.importCount, 2);
+
+    /* Unprocessed mesh is a different result as well */
+    mesh = cache.mesh(importer, _source, 0, "double-v1");
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 5);
+    CORRADE_COMPARE(cache.missCount(), 3);
+    CORRADE_COMPARE(cacheFileCount(_directory), 3);
+}
+
+void DerivedDataCacheTest::meshSourceChanged() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.missCount(), 1);
+    }
+
+    CORRADE_VERIFY(Utility::Directory::writeString(_source, "hello world"));
+
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 11);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(importer.openCount, 2);
+        CORRADE_COMPARE(cacheFileCount(_directory), 2);
+    }
+}
+
+void DerivedDataCacheTest::meshImporterConfigurationChanged() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* Verbose output doesn't affect the result */
+    importer.close();
+    importer.setFlags(ImporterFlag::Verbose);
+    CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    /* Other flags do */
+    importer.close();
+    importer.setFlags(ImporterFlag::YFlip);
+    CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+    CORRADE_COMPARE(cache.missCount(), 2);
+
+    /* Configuration does as well */
+    importer.configuration().setValue("welding", true);
+    CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(cache.missCount(), 3);
+    CORRADE_COMPARE(cacheFileCount(_directory), 3);
+}
+
+void DerivedDataCacheTest::meshImportFailed() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(!cache.mesh(importer, _source, 1, "pipeline"));
+        CORRADE_VERIFY(!cache.mesh(importer, _source, 1, "pipeline"));
+    }
+    CORRADE_COMPARE(out.str(),
+        "mesh import failed\n"
+        "mesh import failed\n");
+
+    /* Failures are not cached */
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(importer.importCount, 2);
+    CORRADE_COMPARE(cacheFileCount(_directory), 0);
+}
+
+void DerivedDataCacheTest::meshProcessingFailed() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    DerivedDataCache::MeshProcessor processor = [](MeshData&&, void*) {
+        return Containers::Optional<MeshData>{};
+    };
+
+    CORRADE_VERIFY(!cache.mesh(importer, _source, 0, "pipeline", processor));
+    CORRADE_VERIFY(!cache.mesh(importer, _source, 0, "pipeline", processor));
+
+    /* Failures are not cached */
+    CORRADE_COMPARE(cache.hitCount(), 0);
+    CORRADE_COMPARE(cache.missCount(), 2);
+    CORRADE_COMPARE(importer.importCount, 2);
+    CORRADE_COMPARE(cacheFileCount(_directory), 0);
+}
+
+void DerivedDataCacheTest::meshCorruptedCache() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+        CORRADE_COMPARE(cacheFileCount(_directory), 1);
+    }
+
+    for(const std::string& file: Utility::Directory::list(_directory, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot))
+        CORRADE_VERIFY(Utility::Directory::writeString(Utility::Directory::join(_directory, file), "garbage"));
+
+    /* The corrupted file is a silent miss and gets overwritten */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.hitCount(), 0);
+        CORRADE_COMPARE(cache.missCount(), 1);
+        CORRADE_COMPARE(out.str(), "");
+    } {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<MeshData> mesh = cache.mesh(importer, _source, 0, "pipeline");
+        CORRADE_VERIFY(mesh);
+        CORRADE_COMPARE(mesh->vertexCount(), 5);
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 0);
+    }
+
+    CORRADE_COMPARE(cacheFileCount(_directory), 1);
+}
+
+void DerivedDataCacheTest::image2D() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<ImageData2D> image = cache.image2D(importer, _source, 0, 0, "pipeline");
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), (Vector2i{5, 1}));
+        CORRADE_COMPARE(cache.missCount(), 1);
+
+        /* Mesh with the same ID and pipeline is a different result */
+        CORRADE_VERIFY(cache.mesh(importer, _source, 0, "pipeline"));
+        CORRADE_COMPARE(cache.missCount(), 2);
+        CORRADE_COMPARE(cacheFileCount(_directory), 2);
+
+        /* So is a different level */
+        CORRADE_VERIFY(cache.image2D(importer, _source, 0, 1, "pipeline"));
+        CORRADE_COMPARE(cache.missCount(), 3);
+        CORRADE_COMPARE(cacheFileCount(_directory), 3);
+
+        /* Failures are not cached */
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!cache.image2D(importer, _source, 1, 0, "pipeline"));
+        CORRADE_COMPARE(out.str(), "image import failed\n");
+        CORRADE_COMPARE(cache.missCount(), 4);
+        CORRADE_COMPARE(cacheFileCount(_directory), 3);
+    }
+
+    importer.close();
+    {
+        DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+        Containers::Optional<ImageData2D> image = cache.image2D(importer, _source, 0, 0, "pipeline");
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->size(), (Vector2i{5, 1}));
+        CORRADE_COMPARE(cache.hitCount(), 1);
+        CORRADE_COMPARE(cache.missCount(), 0);
+        CORRADE_VERIFY(!importer.isOpened());
+    }
+}
+
+void DerivedDataCacheTest::image2DProcessed() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    DerivedDataCache::Image2DProcessor processor = [](ImageData2D&& image, void*) {
+        return Containers::optional(ImageData2D{image.format(), image.size()*Vector2i{2, 1}, Containers::Array<char>{Containers::ValueInit, image.data().size()*2}});
+    };
+
+    Containers::Optional<ImageData2D> image = cache.image2D(importer, _source, 0, 0, "double-v1", processor);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{10, 1}));
+    CORRADE_COMPARE(cache.missCount(), 1);
+
+    image = cache.image2D(importer, _source, 0, 0, "double-v1", processor);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), (Vector2i{10, 1}));
+    CORRADE_COMPARE(cache.hitCount(), 1);
+    CORRADE_COMPARE(importer.importCount, 1);
+}
+
+void DerivedDataCacheTest::fileNotFound() {
+    BlobImporter blobImporter;
+    BlobSceneConverter sceneConverter;
+    BlobImageConverter imageConverter;
+    SourceImporter importer;
+    DerivedDataCache cache{_directory, blobImporter, sceneConverter, imageConverter};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!cache.mesh(importer, "nonexistent.bin", 0, "pipeline"));
+    CORRADE_VERIFY(!cache.image2D(importer, "nonexistent.bin", 0, 0, "pipeline"));
+    CORRADE_COMPARE(out.str(),
+        "Trade::DerivedDataCache::mesh(): cannot open file nonexistent.bin\n"
+        "Trade::DerivedDataCache::image2D(): cannot open file nonexistent.bin\n");
+    CORRADE_COMPARE(cache.missCount(), 0);
+    CORRADE_COMPARE(importer.openCount, 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::DerivedDataCacheTest)
@@ -24,12 +24,15 @@
 */
 
 #include <algorithm>
+#include <cstddef>
 #include <sstream>
+#include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
 #include <Corrade/Containers/StringStl.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
 #include "Magnum/Math/Color.h"
@@ -136,6 +139,12 @@ class MaterialDataTest: public TestSuite::Tester {
         void accessNotFoundInLayerIndex();
         void accessNotFoundInLayerString();
 
+        void accessManyAttributesInBaseLayer();
+
+        void extractAttributes();
+        void extractAttributesLayer();
+        void extractAttributesInvalid();
+
         void releaseAttributes();
         void releaseLayers();
 
@@ -272,6 +281,12 @@ MaterialDataTest::MaterialDataTest() {
               &MaterialDataTest::accessNotFoundInLayerIndex,
               &MaterialDataTest::accessNotFoundInLayerString,
 
+              &MaterialDataTest::accessManyAttributesInBaseLayer,
+
+              &MaterialDataTest::extractAttributes,
+              &MaterialDataTest::extractAttributesLayer,
+              &MaterialDataTest::extractAttributesInvalid,
+
               &MaterialDataTest::releaseAttributes,
               &MaterialDataTest::releaseLayers,
 
@@ -2337,6 +2352,115 @@ void MaterialDataTest::accessInvalidAttributeName() {
         "Trade::MaterialData::attributeOr(): invalid name Trade::MaterialAttribute(0xfefe)\n");
 }
 
+void MaterialDataTest::accessManyAttributesInBaseLayer() {
+    /* The builtin attribute lookup table stores IDs in a byte, attributes
+       with an ID larger than that should fall back to a binary search */
+    Containers::Array<MaterialAttributeData> attributes;
+    for(UnsignedInt i = 0; i != 300; ++i)
+        arrayAppend(attributes, MaterialAttributeData{Utility::formatString("A{:.3}", i), i});
+    arrayAppend(attributes, MaterialAttributeData{MaterialAttribute::DiffuseColor, 0xff3366aa_rgbaf});
+    arrayAppend(attributes, MaterialAttributeData{MaterialAttribute::AlphaBlend, true});
+
+    MaterialData data{{}, std::move(attributes)};
+    CORRADE_COMPARE(data.attributeCount(), 302);
+
+    /* AlphaBlend is sorted before the custom attributes, DiffuseColor after */
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::AlphaBlend), 0);
+    CORRADE_COMPARE(data.attributeId(MaterialAttribute::DiffuseColor), 301);
+    CORRADE_COMPARE(data.attribute<Color4>(MaterialAttribute::DiffuseColor), 0xff3366aa_rgbaf);
+    CORRADE_VERIFY(data.attribute<bool>(MaterialAttribute::AlphaBlend));
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::AmbientColor));
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::Shininess));
+}
+
+struct PhongUniform {
+    Color4 ambientColor;
+    Color4 diffuseColor;
+    Float shininess;
+    UnsignedInt diffuseTexture;
+};
+
+void MaterialDataTest::extractAttributes() {
+    MaterialData data{{}, {
+        {MaterialAttribute::DiffuseColor, 0xff3366aa_rgbaf},
+        {MaterialAttribute::Shininess, 96.0f},
+        {MaterialAttribute::DiffuseTexture, 5u},
+        {MaterialAttribute::DoubleSided, true}
+    }};
+
+    PhongUniform uniform{0x000000ff_rgbaf, 0xffffffff_rgbaf, 80.0f, ~UnsignedInt{}};
+    CORRADE_COMPARE(data.extractAttributes({
+        {MaterialAttribute::AmbientColor, offsetof(PhongUniform, ambientColor)},
+        {MaterialAttribute::DiffuseColor, offsetof(PhongUniform, diffuseColor)},
+        {MaterialAttribute::Shininess, offsetof(PhongUniform, shininess)},
+        {MaterialAttribute::DiffuseTexture, offsetof(PhongUniform, diffuseTexture)}
+    }, &uniform), 3);
+
+    /* The ambient color isn't present, so it's left at the default */
+    CORRADE_COMPARE(uniform.ambientColor, 0x000000ff_rgbaf);
+    CORRADE_COMPARE(uniform.diffuseColor, 0xff3366aa_rgbaf);
+    CORRADE_COMPARE(uniform.shininess, 96.0f);
+    CORRADE_COMPARE(uniform.diffuseTexture, 5);
+}
+
+void MaterialDataTest::extractAttributesLayer() {
+    MaterialData data{{}, {
+        {MaterialAttribute::DiffuseColor, 0xff3366aa_rgbaf},
+        {MaterialLayer::ClearCoat},
+        {MaterialAttribute::LayerFactor, 0.35f},
+        {MaterialAttribute::Roughness, 0.125f}
+    }, {1, 4}};
+
+    const MaterialAttributeTarget targets[]{
+        {MaterialAttribute::LayerFactor, 0},
+        {MaterialAttribute::Roughness, sizeof(Float)},
+        {MaterialAttribute::DiffuseColor, 2*sizeof(Float)}
+    };
+
+    Float out[2 + 4]{};
+    CORRADE_COMPARE(data.extractAttributes(1, targets, out), 2);
+    CORRADE_COMPARE(out[0], 0.35f);
+    CORRADE_COMPARE(out[1], 0.125f);
+    /* Diffuse color is only in the base layer */
+    CORRADE_COMPARE(out[2], 0.0f);
+
+    /* The base layer has just the diffuse color */
+    CORRADE_COMPARE(data.extractAttributes(targets, out), 1);
+    CORRADE_COMPARE(Color4::from(out + 2), 0xff3366aa_rgbaf);
+}
+
+void MaterialDataTest::extractAttributesInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    MaterialData data{{}, {
+        {MaterialLayer::ClearCoat},
+        {"Shininess", 5u}
+    }};
+
+    UnsignedInt destination[4];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    data.extractAttributes(1, Containers::ArrayView<const MaterialAttributeTarget>{}, destination);
+    data.extractAttributes({
+        {MaterialAttribute::DiffuseColor, 0},
+        {MaterialAttribute(0xfefe), 0}
+    }, destination);
+    data.extractAttributes({
+        {MaterialAttribute::LayerName, 0}
+    }, destination);
+    data.extractAttributes({
+        {MaterialAttribute::Shininess, 0}
+    }, destination);
+    CORRADE_COMPARE(out.str(),
+        "Trade::MaterialData::extractAttributes(): index 1 out of range for 1 layers\n"
+        "Trade::MaterialData::extractAttributes(): invalid name Trade::MaterialAttribute(0xfefe) at index 1\n"
+        "Trade::MaterialData::extractAttributes(): can't extract string attribute Trade::MaterialAttribute::LayerName at index 0\n"
+        "Trade::MaterialData::extractAttributes(): expected Trade::MaterialAttributeType::Float for Trade::MaterialAttribute::Shininess but got Trade::MaterialAttributeType::UnsignedInt\n");
+}
+
 void MaterialDataTest::releaseAttributes() {
     MaterialData data{{}, {
         {"DiffuseColor", 0xff3366aa_rgbaf},
@@ -2354,6 +2478,8 @@ void MaterialDataTest::releaseAttributes() {
     /* This is based on the layer offsets, not an actual attribute count, so
        it's inconsistent, yes */
     CORRADE_COMPARE(data.attributeCount(), 1);
+    /* The builtin attribute lookup shouldn't find anything anymore */
+    CORRADE_VERIFY(!data.hasAttribute(MaterialAttribute::DiffuseColor));
 }
 
 void MaterialDataTest::releaseLayers() {
@@ -2375,6 +2501,9 @@ void MaterialDataTest::releaseLayers() {
     /* No layer offsets anymore, so this is the total attribute count instead
        of the base material attribute count. It's inconsistent, yes. */
     CORRADE_COMPARE(data.attributeCount(), 2);
+    /* The attribute from the first layer is now in the base material */
+    CORRADE_VERIFY(data.hasAttribute(MaterialAttribute::DiffuseColor));
+    CORRADE_COMPARE(data.attribute<UnsignedInt>(MaterialAttribute::NormalTexture), 0);
 }
 
 void MaterialDataTest::templateLayerAccess() {
@@ -0,0 +1,454 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/MeshCodec.h"
+#include "Magnum/Trade/MeshData.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MeshCodecTest: TestSuite::Tester {
+    explicit MeshCodecTest();
+
+    void vertexBuffer();
+    void vertexBufferStrided();
+    void vertexBufferCompression();
+    void vertexBufferNotContiguous();
+    void vertexBufferInvalid();
+    void vertexBufferWrongSize();
+
+    void indexBuffer();
+    void indexBufferCompression();
+    void indexBufferNotTriangles();
+    void indexBufferInvalid();
+    void indexBufferWrongSize();
+
+    void vertexData();
+    void vertexDataNotInterleaved();
+    void indexData();
+    void indexDataDoesntFit();
+    void indexDataNotIndexedTriangles();
+};
+
+const struct {
+    const char* name;
+    std::size_t count, stride;
+} VertexBufferData[]{
+    {"empty", 0, 12},
+    {"single vertex", 1, 12},
+    {"partial group", 13, 12},
+    {"whole block", 256, 12},
+    {"partial block", 1000, 12},
+    {"single byte", 1000, 1}
+};
+
+MeshCodecTest::MeshCodecTest() {
+    addInstancedTests({&MeshCodecTest::vertexBuffer},
+        Containers::arraySize(VertexBufferData));
+
+    addTests({&MeshCodecTest::vertexBufferStrided,
+              &MeshCodecTest::vertexBufferCompression,
+              &MeshCodecTest::vertexBufferNotContiguous,
+              &MeshCodecTest::vertexBufferInvalid,
+              &MeshCodecTest::vertexBufferWrongSize,
+
+              &MeshCodecTest::indexBuffer,
+              &MeshCodecTest::indexBufferCompression,
+              &MeshCodecTest::indexBufferNotTriangles,
+              &MeshCodecTest::indexBufferInvalid,
+              &MeshCodecTest::indexBufferWrongSize,
+
+              &MeshCodecTest::vertexData,
+              &MeshCodecTest::vertexDataNotInterleaved,
+              &MeshCodecTest::indexData,
+              &MeshCodecTest::indexDataDoesntFit,
+              &MeshCodecTest::indexDataNotIndexedTriangles});
+}
+
+/* A mix of slowly changing, constant and noisy bytes, to exercise all group
+   modes */
+Containers::Array<char> vertices(const std::size_t count, const std::size_t stride) {
+    Containers::Array<char> out{Containers::NoInit, count*stride};
+    UnsignedInt seed = 17;
+    for(std::size_t i = 0; i != count; ++i) {
+        for(std::size_t j = 0; j != stride; ++j) {
+            seed = seed*1103515245 + 12345;
+            char value;
+            if(j % 4 == 0) value = char(i/3 + (seed >> 16) % 3);
+            else if(j % 4 == 1) value = char(j);
+            else if(j % 4 == 2) value = char(i/40);
+            else value = char(seed >> 16);
+            out[i*stride + j] = value;
+        }
+    }
+    return out;
+}
+
+/* A grid of quads made of two triangles each */
+Containers::Array<UnsignedInt> gridIndices(const UnsignedInt size) {
+    Containers::Array<UnsignedInt> out{Containers::NoInit, size*size*6};
+    for(UnsignedInt y = 0; y != size; ++y) {
+        for(UnsignedInt x = 0; x != size; ++x) {
+            const UnsignedInt a = y*(size + 1) + x;
+            const UnsignedInt b = a + 1;
+            const UnsignedInt c = a + size + 1;
+            const UnsignedInt d = c + 1;
+            UnsignedInt* const quad = out + (y*size + x)*6;
+            quad[0] = a; quad[1] = b; quad[2] = d;
+            quad[3] = a; quad[4] = d; quad[5] = c;
+        }
+    }
+    return out;
+}
+
+/* The decoder is allowed to rotate the triangles, so rotate each to have the
+   smallest index first to make them comparable */
+void normalizeTriangles(Containers::ArrayView<UnsignedInt> indices) {
+    for(std::size_t i = 0; i < indices.size(); i += 3) {
+        UnsignedInt* const t = indices + i;
+        while(t[0] > t[1] || t[0] > t[2]) {
+            const UnsignedInt first = t[0];
+            t[0] = t[1];
+            t[1] = t[2];
+            t[2] = first;
+        }
+    }
+}
+
+void MeshCodecTest::vertexBuffer() {
+    auto&& data = VertexBufferData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> input = vertices(data.count, data.stride);
+    Containers::Array<char> encoded = encodeVertexBuffer(Containers::StridedArrayView2D<const char>{Containers::arrayView(input), {data.count, data.stride}});
+
+    Containers::Optional<std::pair<std::size_t, std::size_t>> size = decodedVertexBufferSize(encoded);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(size->first, data.count);
+    CORRADE_COMPARE(size->second, data.stride);
+
+    Containers::Array<char> output{Containers::ValueInit, data.count*data.stride};
+    CORRADE_VERIFY(decodeVertexBuffer(encoded, Containers::StridedArrayView2D<char>{Containers::arrayView(output), {data.count, data.stride}}));
+    CORRADE_COMPARE_AS(output, input, TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::vertexBufferStrided() {
+    /* Encode only the first 8 bytes of each vertex and decode into every
+       other row of the output */
+    Containers::Array<char> input = vertices(300, 12);
+    Containers::Array<char> encoded = encodeVertexBuffer(Containers::StridedArrayView2D<const char>{Containers::arrayView(input), {300, 12}}.prefix({300, 8}));
+
+    Containers::Array<char> output{Containers::ValueInit, 600*8};
+    Containers::StridedArrayView2D<char> outputView = Containers::StridedArrayView2D<char>{Containers::arrayView(output), {600, 8}}.every({2, 1});
+    CORRADE_VERIFY(decodeVertexBuffer(encoded, outputView));
+
+    for(std::size_t i = 0; i != 300; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_AS(output.slice(i*16, i*16 + 8),
+            input.slice(i*12, i*12 + 8),
+            TestSuite::Compare::Container);
+        CORRADE_COMPARE_AS(output.slice(i*16 + 8, i*16 + 16),
+            Containers::arrayView<char>({0, 0, 0, 0, 0, 0, 0, 0}),
+            TestSuite::Compare::Container);
+    }
+}
+
+void MeshCodecTest::vertexBufferCompression() {
+    /* Positions of a regular grid, neighbors differ only a little */
+    Containers::Array<Vector3s> positions{Containers::NoInit, 64*64};
+    for(std::size_t y = 0; y != 64; ++y)
+        for(std::size_t x = 0; x != 64; ++x)
+            positions[y*64 + x] = {Short(x*7), Short(y*7), Short(x + y)};
+
+    Containers::Array<char> encoded = encodeVertexBuffer(Containers::arrayCast<2, const char>(Containers::stridedArrayView(positions)));
+    CORRADE_COMPARE_AS(encoded.size(), positions.size()*sizeof(Vector3s)/3,
+        TestSuite::Compare::Less);
+}
+
+void MeshCodecTest::vertexBufferNotContiguous() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    char data[16]{};
+    const Containers::StridedArrayView2D<char> view{data, {4, 2}, {4, 2}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeVertexBuffer(view);
+    decodeVertexBuffer(encodeVertexBuffer(Containers::StridedArrayView2D<const char>{data, {4, 2}}), view);
+    CORRADE_COMPARE(out.str(),
+        "Trade::encodeVertexBuffer(): second view dimension is not contiguous\n"
+        "Trade::decodeVertexBuffer(): second view dimension is not contiguous\n");
+}
+
+void MeshCodecTest::vertexBufferInvalid() {
+    Containers::Array<char> input = vertices(100, 12);
+    Containers::Array<char> encoded{Containers::ValueInit, 581};
+    Containers::Array<char> encodedData = encodeVertexBuffer(Containers::StridedArrayView2D<const char>{Containers::arrayView(input), {100, 12}});
+    CORRADE_COMPARE(encodedData.size(), 580);
+    for(std::size_t i = 0; i != encodedData.size(); ++i)
+        encoded[i] = encodedData[i];
+
+    Containers::Array<char> output{Containers::NoInit, 100*12};
+    const Containers::StridedArrayView2D<char> outputView{Containers::arrayView(output), {100, 12}};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVertexBuffer(encoded.prefix(3), outputView));
+    CORRADE_VERIFY(!decodeVertexBuffer(encoded.prefix(579), outputView));
+    /* With one extra zero byte at the end */
+    CORRADE_VERIFY(!decodeVertexBuffer(encoded, outputView));
+    CORRADE_COMPARE(out.str(),
+        "Trade::decodeVertexBuffer(): invalid header\n"
+        "Trade::decodeVertexBuffer(): data too short\n"
+        "Trade::decodeVertexBuffer(): expected 580 bytes but got 581\n");
+}
+
+void MeshCodecTest::vertexBufferWrongSize() {
+    Containers::Array<char> input = vertices(10, 12);
+    Containers::Array<char> encoded = encodeVertexBuffer(Containers::StridedArrayView2D<const char>{Containers::arrayView(input), {10, 12}});
+
+    char output[120];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeVertexBuffer(encoded, Containers::StridedArrayView2D<char>{output, {12, 10}}));
+    CORRADE_COMPARE(out.str(), "Trade::decodeVertexBuffer(): expected 10 vertices with 12 bytes each but got 12 with 10\n");
+}
+
+void MeshCodecTest::indexBuffer() {
+    /* A grid, followed by triangles with large indices that have to be
+       encoded explicitly, a degenerate one, and ones referencing recently
+       used vertices */
+    Containers::Array<UnsignedInt> input;
+    arrayAppend(input, gridIndices(8));
+    arrayAppend(input, {
+        0xfffffffe, 3, 0x7fffffff,
+        5, 5, 5,
+        0x7fffffff, 3, 1000000,
+        2, 1, 0
+    });
+
+    Containers::Array<char> encoded = encodeIndexBuffer(Containers::stridedArrayView(input));
+    Containers::Optional<std::size_t> size = decodedIndexBufferSize(encoded);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(*size, input.size());
+
+    Containers::Array<UnsignedInt> output{Containers::NoInit, input.size()};
+    CORRADE_VERIFY(decodeIndexBuffer(encoded, Containers::stridedArrayView(output)));
+
+    normalizeTriangles(input);
+    normalizeTriangles(output);
+    CORRADE_COMPARE_AS(output, input, TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::indexBufferCompression() {
+    Containers::Array<UnsignedInt> input = gridIndices(64);
+
+    /* A row-major grid isn't the best case as the vertices shared with the
+       previous row are out of the FIFO already, but it should still be at
+       most two and a half bytes per triangle instead of twelve */
+    Containers::Array<char> encoded = encodeIndexBuffer(Containers::stridedArrayView(input));
+    CORRADE_COMPARE_AS(encoded.size(), input.size()/3*5/2,
+        TestSuite::Compare::Less);
+}
+
+void MeshCodecTest::indexBufferNotTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedInt indices[4]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeIndexBuffer(indices);
+    CORRADE_COMPARE(out.str(), "Trade::encodeIndexBuffer(): expected a triangle index count, got 4\n");
+}
+
+void MeshCodecTest::indexBufferInvalid() {
+    const UnsignedInt indices[]{0, 1, 2};
+    Containers::Array<char> encoded = encodeIndexBuffer(indices);
+    /* 8-byte header, a no-edge code with the first vertex being the next
+       vertex and a byte with codes of the remaining two */
+    CORRADE_COMPARE(encoded.size(), 10);
+
+    UnsignedInt output[3];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeIndexBuffer(encoded.prefix(4), output));
+    CORRADE_VERIFY(!decodeIndexBuffer(encoded.prefix(9), output));
+
+    /* Reference the most recent edge, which isn't there yet */
+    encoded[8] = '\x01';
+    CORRADE_VERIFY(!decodeIndexBuffer(encoded.prefix(9), output));
+    CORRADE_COMPARE(out.str(),
+        "Trade::decodeIndexBuffer(): invalid header\n"
+        "Trade::decodeIndexBuffer(): data too short\n"
+        "Trade::decodeIndexBuffer(): invalid data for triangle 0\n");
+}
+
+void MeshCodecTest::indexBufferWrongSize() {
+    const UnsignedInt indices[]{0, 1, 2};
+    Containers::Array<char> encoded = encodeIndexBuffer(indices);
+
+    UnsignedInt output[6];
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeIndexBuffer(encoded, output));
+    CORRADE_COMPARE(out.str(), "Trade::decodeIndexBuffer(): expected 3 indices but got 6\n");
+}
+
+void MeshCodecTest::vertexData() {
+    struct Vertex {
+        Vector3 position;
+        Vector3s normal;
+        Short padding;
+    };
+    Containers::Array<char> vertexData{Containers::NoInit, 100*sizeof(Vertex)};
+    Containers::StridedArrayView1D<Vertex> vertices = Containers::arrayCast<Vertex>(vertexData);
+    for(std::size_t i = 0; i != vertices.size(); ++i)
+        vertices[i] = {{Float(i), Float(i % 10), 0.0f}, {0, 0, 32767}, 0};
+
+    MeshData mesh{MeshPrimitive::Points, {}, Containers::arrayView(vertexData), {
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+        MeshAttributeData{MeshAttribute::Normal, VertexFormat::Vector3sNormalized, vertices.slice(&Vertex::normal)}
+    }};
+
+    /* Encoded per vertex */
+    Containers::Array<char> encoded = encodeVertexData(mesh);
+    Containers::Optional<std::pair<std::size_t, std::size_t>> size = decodedVertexBufferSize(encoded);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(size->first, 100);
+    CORRADE_COMPARE(size->second, sizeof(Vertex));
+
+    Containers::Optional<Containers::Array<char>> decoded = decodeVertexData(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE_AS(*decoded, vertexData, TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::vertexDataNotInterleaved() {
+    Containers::Array<char> vertexData{Containers::ValueInit, 10*sizeof(Vector3) + 10*sizeof(Vector2)};
+    Containers::ArrayView<Vector3> positions = Containers::arrayCast<Vector3>(vertexData.prefix(10*sizeof(Vector3)));
+    Containers::ArrayView<Vector2> textureCoordinates = Containers::arrayCast<Vector2>(vertexData.suffix(10*sizeof(Vector3)));
+    for(std::size_t i = 0; i != 10; ++i) {
+        positions[i] = {Float(i), 1.0f, 2.0f};
+        textureCoordinates[i] = {0.5f, Float(i)};
+    }
+
+    MeshData mesh{MeshPrimitive::Points, {}, Containers::arrayView(vertexData), {
+        MeshAttributeData{MeshAttribute::Position, positions},
+        MeshAttributeData{MeshAttribute::TextureCoordinates, textureCoordinates}
+    }};
+
+    /* Encoded as a sequence of bytes */
+    Containers::Array<char> encoded = encodeVertexData(mesh);
+    Containers::Optional<std::pair<std::size_t, std::size_t>> size = decodedVertexBufferSize(encoded);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(size->first, vertexData.size());
+    CORRADE_COMPARE(size->second, 1);
+
+    Containers::Optional<Containers::Array<char>> decoded = decodeVertexData(encoded);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE_AS(*decoded, vertexData, TestSuite::Compare::Container);
+}
+
+void MeshCodecTest::indexData() {
+    Containers::Array<UnsignedInt> grid = gridIndices(4);
+    Containers::Array<char> indexData{Containers::NoInit, grid.size()*sizeof(UnsignedShort)};
+    Containers::ArrayView<UnsignedShort> indices = Containers::arrayCast<UnsignedShort>(indexData);
+    for(std::size_t i = 0; i != grid.size(); ++i)
+        indices[i] = grid[i];
+
+    MeshData mesh{MeshPrimitive::Triangles, std::move(indexData), MeshIndexData{indices}, 25};
+
+    Containers::Array<char> encoded = encodeIndexData(mesh);
+    Containers::Optional<std::size_t> size = decodedIndexBufferSize(encoded);
+    CORRADE_VERIFY(size);
+    CORRADE_COMPARE(*size, grid.size());
+
+    Containers::Optional<Containers::Array<char>> decoded = decodeIndexData(encoded, MeshIndexType::UnsignedShort);
+    CORRADE_VERIFY(decoded);
+    CORRADE_COMPARE(decoded->size(), grid.size()*sizeof(UnsignedShort));
+
+    Containers::ArrayView<const UnsignedShort> decodedIndices = Containers::arrayCast<const UnsignedShort>(*decoded);
+    Containers::Array<UnsignedInt> output{Containers::NoInit, grid.size()};
+    for(std::size_t i = 0; i != grid.size(); ++i)
+        output[i] = decodedIndices[i];
+    normalizeTriangles(grid);
+    normalizeTriangles(output);
+    CORRADE_COMPARE_AS(output, grid, TestSuite::Compare::Container);
+
+    /* Decoding to 32-bit indices works as well */
+    Containers::Optional<Containers::Array<char>> decoded32 = decodeIndexData(encoded, MeshIndexType::UnsignedInt);
+    CORRADE_VERIFY(decoded32);
+    CORRADE_COMPARE(decoded32->size(), grid.size()*sizeof(UnsignedInt));
+}
+
+void MeshCodecTest::indexDataDoesntFit() {
+    const UnsignedInt indices[]{0, 1, 256};
+    Containers::Array<char> encoded = encodeIndexBuffer(indices);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!decodeIndexData(encoded, MeshIndexType::UnsignedByte));
+    CORRADE_VERIFY(!decodeIndexData(encoded.prefix(3), MeshIndexType::UnsignedInt));
+    CORRADE_COMPARE(out.str(),
+        "Trade::decodeIndexData(): index 256 doesn't fit into MeshIndexType::UnsignedByte\n"
+        "Trade::decodeIndexData(): invalid header\n");
+}
+
+void MeshCodecTest::indexDataNotIndexedTriangles() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const UnsignedShort indices[4]{};
+    MeshData nonIndexed{MeshPrimitive::Triangles, 3};
+    MeshData lines{MeshPrimitive::Lines, {}, indices, MeshIndexData{indices}, 1};
+    MeshData triangles{MeshPrimitive::Triangles, {}, indices, MeshIndexData{indices}, 1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    encodeIndexData(nonIndexed);
+    encodeIndexData(lines);
+    encodeIndexData(triangles);
+    CORRADE_COMPARE(out.str(),
+        "Trade::encodeIndexData(): expected an indexed triangle mesh\n"
+        "Trade::encodeIndexData(): expected an indexed triangle mesh\n"
+        "Trade::encodeIndexData(): expected a triangle index count, got 4\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MeshCodecTest)
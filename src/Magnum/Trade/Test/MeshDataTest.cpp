@@ -77,6 +77,10 @@ struct MeshDataTest: TestSuite::Tester {
     void constructArrayAttributeOffsetOnly();
     void constructArrayAttributeNotAllowed();
 
+    void constructMorphTargetAttribute();
+    void constructMorphTargetAttributeInvalidId();
+    void constructMorphTargetAttributeNotAllowed();
+
     void construct();
 
     void constructZeroIndices();
@@ -164,6 +168,9 @@ struct MeshDataTest: TestSuite::Tester {
     void attributeNotFound();
     void attributeWrongType();
 
+    void morphTargets();
+    void morphTargetNotFound();
+
     void releaseIndexData();
     void releaseAttributeData();
     void releaseVertexData();
@@ -236,7 +243,11 @@ MeshDataTest::MeshDataTest() {
               &MeshDataTest::constructArrayAttributeTypeErased,
               &MeshDataTest::constructArrayAttributeNullptr,
               &MeshDataTest::constructArrayAttributeOffsetOnly,
-              &MeshDataTest::constructArrayAttributeNotAllowed});
+              &MeshDataTest::constructArrayAttributeNotAllowed,
+
+              &MeshDataTest::constructMorphTargetAttribute,
+              &MeshDataTest::constructMorphTargetAttributeInvalidId,
+              &MeshDataTest::constructMorphTargetAttributeNotAllowed});
 
     addInstancedTests({&MeshDataTest::construct},
         Containers::arraySize(ConstructData));
@@ -385,6 +396,9 @@ MeshDataTest::MeshDataTest() {
               &MeshDataTest::attributeNotFound,
               &MeshDataTest::attributeWrongType,
 
+              &MeshDataTest::morphTargets,
+              &MeshDataTest::morphTargetNotFound,
+
               &MeshDataTest::releaseIndexData,
               &MeshDataTest::releaseAttributeData,
               &MeshDataTest::releaseVertexData});
@@ -960,6 +974,65 @@ void MeshDataTest::constructArrayAttributeNotAllowed() {
         "Trade::MeshAttributeData: array attributes can't have an implementation-specific format\n");
 }
 
+void MeshDataTest::constructMorphTargetAttribute() {
+    Vector3 positionData[3];
+    Containers::StridedArrayView1D<Vector3> positions{positionData};
+
+    MeshAttributeData a{MeshAttribute::Position, positions};
+    CORRADE_COMPARE(a.morphTargetId(), -1);
+
+    MeshAttributeData b{MeshAttribute::Position, positions, 5};
+    CORRADE_COMPARE(b.name(), MeshAttribute::Position);
+    CORRADE_COMPARE(b.format(), VertexFormat::Vector3);
+    CORRADE_COMPARE(b.arraySize(), 0);
+    CORRADE_COMPARE(b.morphTargetId(), 5);
+    CORRADE_COMPARE(b.data().data(), positionData);
+
+    MeshAttributeData c{MeshAttribute::Normal, VertexFormat::Vector3, nullptr, 0, 127};
+    CORRADE_COMPARE(c.morphTargetId(), 127);
+
+    MeshAttributeData d{MeshAttribute::Color, VertexFormat::Vector4, 16, 3, 32, 0, 2};
+    CORRADE_VERIFY(d.isOffsetOnly());
+    CORRADE_COMPARE(d.morphTargetId(), 2);
+
+    /* Custom attributes can be both arrays and morph targets */
+    MeshAttributeData e{meshAttributeCustom(13), VertexFormat::Float, Containers::arrayCast<2, const char>(positions), 3, 1};
+    CORRADE_COMPARE(e.arraySize(), 3);
+    CORRADE_COMPARE(e.morphTargetId(), 1);
+
+    constexpr MeshAttributeData cf{MeshAttribute::TextureCoordinates, VertexFormat::Vector2, 0, 3, 8, 0, 4};
+    constexpr Int morphTargetId = cf.morphTargetId();
+    CORRADE_COMPARE(morphTargetId, 4);
+}
+
+void MeshDataTest::constructMorphTargetAttributeInvalidId() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, nullptr, 0, 128};
+    MeshAttributeData{MeshAttribute::Position, VertexFormat::Vector3, 0, 3, 12, 0, -2};
+    CORRADE_COMPARE(out.str(),
+        "Trade::MeshAttributeData: expected morph target ID to be either -1 or less than 128 but got 128\n"
+        "Trade::MeshAttributeData: expected morph target ID to be either -1 or less than 128 but got -2\n");
+}
+
+void MeshDataTest::constructMorphTargetAttributeNotAllowed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MeshAttributeData{MeshAttribute::ObjectId, VertexFormat::UnsignedInt, nullptr, 0, 0};
+    MeshAttributeData{MeshAttribute::ObjectId, VertexFormat::UnsignedInt, 0, 3, 4, 0, 1};
+    CORRADE_COMPARE(out.str(),
+        "Trade::MeshAttributeData: morph target not allowed for Trade::MeshAttribute::ObjectId\n"
+        "Trade::MeshAttributeData: morph target not allowed for Trade::MeshAttribute::ObjectId\n");
+}
+
 void MeshDataTest::construct() {
     auto&& instanceData = ConstructData[testCaseInstanceId()];
     setTestCaseDescription(instanceData.name);
@@ -2939,6 +3012,93 @@ void MeshDataTest::attributeWrongType() {
     CORRADE_COMPARE(out.str(), "Trade::MeshData::attribute(): improper type requested for Trade::MeshAttribute::Position of format VertexFormat::Vector3\n");
 }
 
+void MeshDataTest::morphTargets() {
+    struct Vertex {
+        Vector3 position;
+        Vector3 positionDelta0;
+        Vector3 normal;
+        Vector3 positionDelta2;
+        Vector3 normalDelta2;
+    } vertexData[]{
+        {{1.0f, 2.0f, 3.0f}, {0.1f, 0.0f, 0.0f}, Vector3::zAxis(), {0.0f, 0.2f, 0.0f}, Vector3::xAxis()},
+        {{4.0f, 5.0f, 6.0f}, {0.3f, 0.0f, 0.0f}, Vector3::yAxis(), {0.0f, 0.4f, 0.0f}, Vector3::zAxis()}
+    };
+    auto vertices = Containers::stridedArrayView(vertexData);
+
+    MeshData data{MeshPrimitive::Points, DataFlags{}, vertexData, {
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::positionDelta0), 0},
+        MeshAttributeData{MeshAttribute::Normal, vertices.slice(&Vertex::normal)},
+        MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::positionDelta2), 2},
+        MeshAttributeData{MeshAttribute::Normal, vertices.slice(&Vertex::normalDelta2), 2}
+    }};
+    CORRADE_COMPARE(data.morphTargetCount(), 3);
+    CORRADE_COMPARE(data.attributeMorphTargetId(0), -1);
+    CORRADE_COMPARE(data.attributeMorphTargetId(1), 0);
+    CORRADE_COMPARE(data.attributeMorphTargetId(2), -1);
+    CORRADE_COMPARE(data.attributeMorphTargetId(3), 2);
+    CORRADE_COMPARE(data.attributeMorphTargetId(4), 2);
+
+    /* Named access without a morph target ID sees only the base attributes */
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Position), 1);
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Normal), 1);
+    CORRADE_COMPARE(data.attributeId(MeshAttribute::Normal), 2);
+    CORRADE_COMPARE_AS(data.positions3DAsArray(), Containers::arrayView<Vector3>({
+        {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}
+    }), TestSuite::Compare::Container);
+
+    /* Morph target 0 has just positions */
+    CORRADE_VERIFY(data.hasAttribute(MeshAttribute::Position, 0));
+    CORRADE_VERIFY(!data.hasAttribute(MeshAttribute::Normal, 0));
+    CORRADE_COMPARE(data.attributeId(MeshAttribute::Position, 0, 0), 1);
+    CORRADE_COMPARE(data.attributeOffset(MeshAttribute::Position, 0, 0), sizeof(Vector3));
+    CORRADE_COMPARE(data.attributeStride(MeshAttribute::Position, 0, 0), sizeof(Vertex));
+    CORRADE_COMPARE(data.attributeFormat(MeshAttribute::Position, 0, 0), VertexFormat::Vector3);
+    CORRADE_COMPARE_AS(data.attribute<Vector3>(MeshAttribute::Position, 0, 0),
+        Containers::arrayView<Vector3>({{0.1f, 0.0f, 0.0f}, {0.3f, 0.0f, 0.0f}}),
+        TestSuite::Compare::Container);
+
+    /* Morph target 1 is empty */
+    CORRADE_VERIFY(!data.hasAttribute(MeshAttribute::Position, 1));
+
+    /* Morph target 2 has both */
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Position, 2), 1);
+    CORRADE_COMPARE(data.attributeCount(MeshAttribute::Normal, 2), 1);
+    CORRADE_COMPARE_AS(data.positions3DAsArray(0, 2), Containers::arrayView<Vector3>({
+        {0.0f, 0.2f, 0.0f}, {0.0f, 0.4f, 0.0f}
+    }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.normalsAsArray(0, 2), Containers::arrayView<Vector3>({
+        Vector3::xAxis(), Vector3::zAxis()
+    }), TestSuite::Compare::Container);
+
+    /* The ID is preserved in the attribute data */
+    CORRADE_COMPARE(data.attributeData(3).morphTargetId(), 2);
+}
+
+void MeshDataTest::morphTargetNotFound() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    MeshAttributeData positions{MeshAttribute::Position, VertexFormat::Vector3, nullptr};
+    MeshAttributeData positionDeltas{MeshAttribute::Position, VertexFormat::Vector3, nullptr, 0, 1};
+    MeshData data{MeshPrimitive::Points, nullptr, {positions, positionDeltas}};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    data.attributeMorphTargetId(2);
+    data.attributeId(MeshAttribute::Position, 0, 0);
+    data.attribute(MeshAttribute::Position, 1, 1);
+    data.positions3DAsArray(0, 2);
+    data.normalsAsArray(0, 1);
+    CORRADE_COMPARE(out.str(),
+        "Trade::MeshData::attributeMorphTargetId(): index 2 out of range for 2 attributes\n"
+        "Trade::MeshData::attributeId(): index 0 out of range for 0 Trade::MeshAttribute::Position attributes in morph target 0\n"
+        "Trade::MeshData::attribute(): index 1 out of range for 1 Trade::MeshAttribute::Position attributes in morph target 1\n"
+        "Trade::MeshData::positions3DInto(): index 0 out of range for 0 position attributes in morph target 2\n"
+        "Trade::MeshData::normalsInto(): index 0 out of range for 0 normal attributes in morph target 1\n");
+}
+
 void MeshDataTest::releaseIndexData() {
     Containers::Array<char> indexData{23};
     auto indexView = Containers::arrayCast<UnsignedShort>(indexData.slice(6, 12));
@@ -23,9 +23,15 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Magnum.h"
+#include "Magnum/Math/Matrix3.h"
+#include "Magnum/Math/Matrix4.h"
 #include "Magnum/Trade/SceneData.h"
 
 namespace Magnum { namespace Trade { namespace Test { namespace {
@@ -33,15 +39,138 @@ namespace Magnum { namespace Trade { namespace Test { namespace {
 struct SceneDataTest: TestSuite::Tester {
     explicit SceneDataTest();
 
+    void debugField();
+    void debugFieldType();
+    void fieldTypeSize();
+
+    void constructFieldDefault();
+    void constructField();
+    void constructFieldWrongType();
+    void constructFieldWrongStride();
+
     void construct();
     void constructCopy();
     void constructMove();
+
+    void constructFields();
+    void constructFields2D();
+    void constructFieldsNoParent();
+    void constructFieldsNotOwned();
+    void constructFieldsNotOwnedFlagOwned();
+    void constructFieldsMovedFrom();
+    void constructFieldsNothing();
+    void constructFieldsWrongCount();
+    void constructFieldsDuplicate();
+    void constructFieldsNotContained();
+
+    void mutableAccessNotAllowed();
+    void fieldNotFound();
+    void fieldOutOfRange();
+    void fieldWrongType();
+
+    void releaseFieldData();
+    void releaseData();
 };
 
 SceneDataTest::SceneDataTest() {
-    addTests({&SceneDataTest::construct,
+    addTests({&SceneDataTest::debugField,
+              &SceneDataTest::debugFieldType,
+              &SceneDataTest::fieldTypeSize,
+
+              &SceneDataTest::constructFieldDefault,
+              &SceneDataTest::constructField,
+              &SceneDataTest::constructFieldWrongType,
+              &SceneDataTest::constructFieldWrongStride,
+
+              &SceneDataTest::construct,
               &SceneDataTest::constructCopy,
-              &SceneDataTest::constructMove});
+              &SceneDataTest::constructMove,
+
+              &SceneDataTest::constructFields,
+              &SceneDataTest::constructFields2D,
+              &SceneDataTest::constructFieldsNoParent,
+              &SceneDataTest::constructFieldsNotOwned,
+              &SceneDataTest::constructFieldsNotOwnedFlagOwned,
+              &SceneDataTest::constructFieldsMovedFrom,
+              &SceneDataTest::constructFieldsNothing,
+              &SceneDataTest::constructFieldsWrongCount,
+              &SceneDataTest::constructFieldsDuplicate,
+              &SceneDataTest::constructFieldsNotContained,
+
+              &SceneDataTest::mutableAccessNotAllowed,
+              &SceneDataTest::fieldNotFound,
+              &SceneDataTest::fieldOutOfRange,
+              &SceneDataTest::fieldWrongType,
+
+              &SceneDataTest::releaseFieldData,
+              &SceneDataTest::releaseData});
+}
+
+void SceneDataTest::debugField() {
+    std::ostringstream out;
+    Debug{&out} << SceneField::Transformation << SceneField(0xdead);
+    CORRADE_COMPARE(out.str(), "Trade::SceneField::Transformation Trade::SceneField(0xdead)\n");
+}
+
+void SceneDataTest::debugFieldType() {
+    std::ostringstream out;
+    Debug{&out} << SceneFieldType::Matrix3 << SceneFieldType(0xdead);
+    CORRADE_COMPARE(out.str(), "Trade::SceneFieldType::Matrix3 Trade::SceneFieldType(0xdead)\n");
+}
+
+void SceneDataTest::fieldTypeSize() {
+    CORRADE_COMPARE(sceneFieldTypeSize(SceneFieldType::Int), 4);
+    CORRADE_COMPARE(sceneFieldTypeSize(SceneFieldType::Matrix3), 36);
+    CORRADE_COMPARE(sceneFieldTypeSize(SceneFieldType::Matrix4), 64);
+}
+
+void SceneDataTest::constructFieldDefault() {
+    SceneFieldData data;
+    CORRADE_COMPARE(data.name(), SceneField{});
+    CORRADE_COMPARE(data.type(), SceneFieldType{});
+
+    constexpr SceneFieldData cdata;
+    CORRADE_COMPARE(cdata.name(), SceneField{});
+    CORRADE_COMPARE(cdata.type(), SceneFieldType{});
+}
+
+void SceneDataTest::constructField() {
+    const Int parents[]{-1, 0, 0};
+    SceneFieldData data{SceneField::Parent, Containers::arrayView(parents)};
+    CORRADE_COMPARE(data.name(), SceneField::Parent);
+    CORRADE_COMPARE(data.type(), SceneFieldType::Int);
+    CORRADE_COMPARE(data.data().size(), 3);
+    CORRADE_COMPARE(data.data().stride(), sizeof(Int));
+    CORRADE_VERIFY(data.data().data() == parents);
+}
+
+void SceneDataTest::constructFieldWrongType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Matrix4 transformations[3];
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneFieldData{SceneField::Parent, Containers::arrayView(transformations)};
+    CORRADE_COMPARE(out.str(), "Trade::SceneFieldData: Trade::SceneFieldType::Matrix4 is not a valid type for Trade::SceneField::Parent\n");
+}
+
+void SceneDataTest::constructFieldWrongStride() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const char data[64]{};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneFieldData{SceneField::Transformation, SceneFieldType::Matrix3, Containers::StridedArrayView1D<const void>{data, 2, 16}};
+    SceneFieldData{SceneField::Parent, SceneFieldType::Int, Containers::StridedArrayView1D<const void>{data + 60, 2, -4}};
+    CORRADE_COMPARE(out.str(),
+        "Trade::SceneFieldData: expected stride to be positive and enough to fit Trade::SceneFieldType::Matrix3, got 16\n"
+        "Trade::SceneFieldData: expected stride to be positive and enough to fit Trade::SceneFieldType::Int, got -4\n");
 }
 
 void SceneDataTest::construct() {
@@ -80,6 +209,362 @@ void SceneDataTest::constructMove() {
     CORRADE_VERIFY(std::is_nothrow_move_assignable<SceneData>::value);
 }
 
+using namespace Math::Literals;
+
+struct Object {
+    Int parent;
+    Int mesh;
+    Matrix4 transformation;
+};
+
+void SceneDataTest::constructFields() {
+    Containers::Array<char> data{sizeof(Object)*4};
+    Containers::ArrayView<Object> objects = Containers::arrayCast<Object>(data);
+    objects[0] = {-1, 2, Matrix4::translation(Vector3::xAxis())};
+    objects[1] = {0, -1, Matrix4::scaling(Vector3{2.0f})};
+    objects[2] = {-1, 0, Matrix4{}};
+    objects[3] = {2, 1, Matrix4::translation(Vector3::yAxis())};
+
+    const void* importerState = reinterpret_cast<const void*>(std::size_t(0xdeadbeef));
+    const Object* objectData = objects.data();
+    SceneData scene{4, std::move(data), {
+        SceneFieldData{SceneField::Parent,
+            Containers::StridedArrayView1D<Int>{objects, &objects[0].parent, objects.size(), sizeof(Object)}},
+        SceneFieldData{SceneField::Transformation,
+            Containers::StridedArrayView1D<Matrix4>{objects, &objects[0].transformation, objects.size(), sizeof(Object)}},
+        SceneFieldData{SceneField::Mesh,
+            Containers::StridedArrayView1D<Int>{objects, &objects[0].mesh, objects.size(), sizeof(Object)}}
+    }, importerState};
+
+    CORRADE_COMPARE(scene.objectCount(), 4);
+    CORRADE_COMPARE(scene.dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_VERIFY(scene.data().data() == static_cast<const void*>(objectData));
+    CORRADE_VERIFY(scene.mutableData().data() == static_cast<const void*>(objectData));
+    CORRADE_COMPARE(scene.data().size(), sizeof(Object)*4);
+    CORRADE_COMPARE(scene.importerState(), importerState);
+
+    /* Top-level objects derived from the parent field */
+    CORRADE_COMPARE_AS(scene.children2D(), std::vector<UnsignedInt>{},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.children3D(), (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+
+    CORRADE_COMPARE(scene.fieldData().size(), 3);
+    CORRADE_COMPARE(scene.fieldCount(), 3);
+    CORRADE_COMPARE(scene.fieldName(1), SceneField::Transformation);
+    CORRADE_COMPARE(scene.fieldType(1), SceneFieldType::Matrix4);
+    CORRADE_VERIFY(scene.hasField(SceneField::Mesh));
+    CORRADE_VERIFY(!scene.hasField(SceneField::Light));
+    CORRADE_COMPARE(scene.fieldId(SceneField::Mesh), 2);
+    CORRADE_COMPARE(scene.fieldType(SceneField::Parent), SceneFieldType::Int);
+
+    /* Type-erased access */
+    CORRADE_COMPARE(scene.field(1).size()[0], 4);
+    CORRADE_COMPARE(scene.field(1).size()[1], sizeof(Matrix4));
+    CORRADE_COMPARE(scene.field(1).stride()[0], sizeof(Object));
+    CORRADE_COMPARE(scene.mutableField(SceneField::Mesh).size()[1], sizeof(Int));
+
+    /* Typed access */
+    CORRADE_COMPARE_AS(scene.field<Int>(0),
+        Containers::arrayView<Int>({-1, 0, -1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.field<Int>(SceneField::Mesh),
+        Containers::arrayView<Int>({2, -1, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(scene.field<Matrix4>(SceneField::Transformation)[1], Matrix4::scaling(Vector3{2.0f}));
+
+    /* Mutable access */
+    scene.mutableField<Int>(SceneField::Mesh)[1] = 3;
+    scene.mutableField<Matrix4>(1)[2] = Matrix4::rotationX(90.0_degf);
+    CORRADE_COMPARE(objects[1].mesh, 3);
+    CORRADE_COMPARE(objects[2].transformation, Matrix4::rotationX(90.0_degf));
+}
+
+void SceneDataTest::constructFields2D() {
+    Containers::Array<char> data{sizeof(Matrix3)*3};
+    Containers::ArrayView<Matrix3> transformations = Containers::arrayCast<Matrix3>(data);
+    transformations[1] = Matrix3::translation(Vector2::xAxis());
+
+    SceneData scene{3, std::move(data), {
+        SceneFieldData{SceneField::Transformation, transformations}
+    }};
+
+    /* No parent field, so all objects are top-level and 2D */
+    CORRADE_COMPARE_AS(scene.children2D(), (std::vector<UnsignedInt>{0, 1, 2}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.children3D(), std::vector<UnsignedInt>{},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(scene.field<Matrix3>(SceneField::Transformation)[1], Matrix3::translation(Vector2::xAxis()));
+}
+
+void SceneDataTest::constructFieldsNoParent() {
+    Containers::Array<char> data{sizeof(Int)*2};
+    Containers::ArrayView<Int> meshes = Containers::arrayCast<Int>(data);
+    meshes[0] = 1;
+    meshes[1] = -1;
+
+    SceneData scene{2, std::move(data), {
+        SceneFieldData{SceneField::Mesh, meshes}
+    }};
+
+    /* No transformation field, treated as 3D */
+    CORRADE_COMPARE_AS(scene.children2D(), std::vector<UnsignedInt>{},
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(scene.children3D(), (std::vector<UnsignedInt>{0, 1}),
+        TestSuite::Compare::Container);
+}
+
+void SceneDataTest::constructFieldsNotOwned() {
+    Int data[]{-1, 0, 1};
+
+    SceneData scene{3, DataFlag::Mutable, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+
+    CORRADE_COMPARE(scene.dataFlags(), DataFlag::Mutable);
+    CORRADE_VERIFY(scene.data().data() == static_cast<const void*>(data));
+    CORRADE_COMPARE_AS(scene.children3D(), std::vector<UnsignedInt>{0},
+        TestSuite::Compare::Container);
+
+    scene.mutableField<Int>(SceneField::Parent)[2] = 0;
+    CORRADE_COMPARE(data[2], 0);
+}
+
+void SceneDataTest::constructFieldsNotOwnedFlagOwned() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Int data[]{-1};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData{1, DataFlag::Owned, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: can't construct with non-owned data but Trade::DataFlag::Owned\n");
+}
+
+void SceneDataTest::constructFieldsMovedFrom() {
+    Containers::Array<char> data{sizeof(Int)*3};
+    Containers::ArrayView<Int> parents = Containers::arrayCast<Int>(data);
+    parents[0] = -1;
+    parents[1] = 0;
+    parents[2] = -1;
+
+    SceneData a{3, std::move(data), {
+        SceneFieldData{SceneField::Parent, parents}
+    }};
+
+    SceneData b{std::move(a)};
+    CORRADE_COMPARE(b.objectCount(), 3);
+    CORRADE_COMPARE(b.fieldCount(), 1);
+    CORRADE_VERIFY(b.data().data() == static_cast<const void*>(parents.data()));
+    CORRADE_COMPARE_AS(b.children3D(), (std::vector<UnsignedInt>{0, 2}),
+        TestSuite::Compare::Container);
+
+    SceneData c{{}, {}};
+    c = std::move(b);
+    CORRADE_COMPARE(c.objectCount(), 3);
+    CORRADE_COMPARE_AS(c.field<Int>(SceneField::Parent),
+        Containers::arrayView<Int>({-1, 0, -1}),
+        TestSuite::Compare::Container);
+}
+
+void SceneDataTest::constructFieldsNothing() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData{0, nullptr, {SceneFieldData{}}};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: field 0 doesn't specify anything\n");
+}
+
+void SceneDataTest::constructFieldsWrongCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Array<char> data{sizeof(Int)*3};
+    Containers::ArrayView<Int> view = Containers::arrayCast<Int>(data);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData{3, std::move(data), {
+        SceneFieldData{SceneField::Parent, view},
+        SceneFieldData{SceneField::Mesh, view.prefix(2)}
+    }};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: field 1 has 2 entries but 3 expected\n");
+}
+
+void SceneDataTest::constructFieldsDuplicate() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Array<char> data{sizeof(Int)*3};
+    Containers::ArrayView<Int> view = Containers::arrayCast<Int>(data);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData{3, std::move(data), {
+        SceneFieldData{SceneField::Mesh, view},
+        SceneFieldData{SceneField::Parent, view},
+        SceneFieldData{SceneField::Mesh, view}
+    }};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: duplicate field Trade::SceneField::Mesh\n");
+}
+
+void SceneDataTest::constructFieldsNotContained() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Containers::Array<char> data{reinterpret_cast<char*>(0xbadda9), 12, [](char*, std::size_t){}};
+    Containers::ArrayView<Int> view{reinterpret_cast<Int*>(0xbadda9 + 4), 3};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    SceneData{3, std::move(data), {
+        SceneFieldData{SceneField::Parent, view}
+    }};
+    CORRADE_COMPARE(out.str(), "Trade::SceneData: field 0 [0xbaddad:0xbaddb9] is not contained in passed data array [0xbadda9:0xbaddb5]\n");
+}
+
+void SceneDataTest::mutableAccessNotAllowed() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    const Int data[]{-1, 0};
+    SceneData scene{2, {}, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.mutableData();
+    scene.mutableField(0);
+    scene.mutableField<Int>(0);
+    scene.mutableField(SceneField::Parent);
+    scene.mutableField<Int>(SceneField::Parent);
+    CORRADE_COMPARE(out.str(),
+        "Trade::SceneData::mutableData(): data not mutable\n"
+        "Trade::SceneData::mutableField(): data not mutable\n"
+        "Trade::SceneData::mutableField(): data not mutable\n"
+        "Trade::SceneData::mutableField(): data not mutable\n"
+        "Trade::SceneData::mutableField(): data not mutable\n");
+}
+
+void SceneDataTest::fieldNotFound() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Int data[]{-1, 0};
+    SceneData scene{2, DataFlag::Mutable, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.fieldId(SceneField::Mesh);
+    scene.fieldType(SceneField::Mesh);
+    scene.field(SceneField::Mesh);
+    scene.field<Int>(SceneField::Mesh);
+    scene.mutableField(SceneField::Mesh);
+    scene.mutableField<Int>(SceneField::Mesh);
+    CORRADE_COMPARE(out.str(),
+        "Trade::SceneData::fieldId(): field Trade::SceneField::Mesh not found\n"
+        "Trade::SceneData::fieldType(): field Trade::SceneField::Mesh not found\n"
+        "Trade::SceneData::field(): field Trade::SceneField::Mesh not found\n"
+        "Trade::SceneData::field(): field Trade::SceneField::Mesh not found\n"
+        "Trade::SceneData::mutableField(): field Trade::SceneField::Mesh not found\n"
+        "Trade::SceneData::mutableField(): field Trade::SceneField::Mesh not found\n");
+}
+
+void SceneDataTest::fieldOutOfRange() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Int data[]{-1, 0};
+    SceneData scene{2, DataFlag::Mutable, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.fieldName(1);
+    scene.fieldType(1);
+    scene.field(1);
+    scene.field<Int>(1);
+    scene.mutableField(1);
+    scene.mutableField<Int>(1);
+    CORRADE_COMPARE(out.str(),
+        "Trade::SceneData::fieldName(): index 1 out of range for 1 fields\n"
+        "Trade::SceneData::fieldType(): index 1 out of range for 1 fields\n"
+        "Trade::SceneData::field(): index 1 out of range for 1 fields\n"
+        "Trade::SceneData::field(): index 1 out of range for 1 fields\n"
+        "Trade::SceneData::mutableField(): index 1 out of range for 1 fields\n"
+        "Trade::SceneData::mutableField(): index 1 out of range for 1 fields\n");
+}
+
+void SceneDataTest::fieldWrongType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Int data[]{-1, 0};
+    SceneData scene{2, DataFlag::Mutable, data, {
+        SceneFieldData{SceneField::Parent, Containers::arrayView(data)}
+    }};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    scene.field<Matrix4>(0);
+    scene.mutableField<Matrix3>(SceneField::Parent);
+    CORRADE_COMPARE(out.str(),
+        "Trade::SceneData::field(): improper type requested for Trade::SceneField::Parent of type Trade::SceneFieldType::Int\n"
+        "Trade::SceneData::mutableField(): improper type requested for Trade::SceneField::Parent of type Trade::SceneFieldType::Int\n");
+}
+
+void SceneDataTest::releaseFieldData() {
+    Containers::Array<char> data{sizeof(Int)*2};
+    Containers::ArrayView<Int> view = Containers::arrayCast<Int>(data);
+
+    SceneData scene{2, std::move(data), {
+        SceneFieldData{SceneField::Parent, view}
+    }};
+
+    Containers::Array<SceneFieldData> released = scene.releaseFieldData();
+    CORRADE_COMPARE(released.size(), 1);
+    CORRADE_COMPARE(released[0].name(), SceneField::Parent);
+    CORRADE_COMPARE(scene.fieldCount(), 0);
+    /* The data and object count stay */
+    CORRADE_COMPARE(scene.objectCount(), 2);
+    CORRADE_VERIFY(scene.data().data() == static_cast<const void*>(view.data()));
+}
+
+void SceneDataTest::releaseData() {
+    Containers::Array<char> data{sizeof(Int)*2};
+    Containers::ArrayView<Int> view = Containers::arrayCast<Int>(data);
+
+    SceneData scene{2, std::move(data), {
+        SceneFieldData{SceneField::Parent, view}
+    }};
+
+    Containers::Array<char> released = scene.releaseData();
+    CORRADE_VERIFY(released.data() == static_cast<const void*>(view.data()));
+    CORRADE_COMPARE(released.size(), sizeof(Int)*2);
+    CORRADE_COMPARE(scene.objectCount(), 0);
+    CORRADE_COMPARE(scene.fieldCount(), 0);
+    CORRADE_VERIFY(scene.data().data() == static_cast<const void*>(view.data()));
+    CORRADE_COMPARE(scene.data().size(), 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::SceneDataTest)
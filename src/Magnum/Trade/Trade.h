@@ -43,6 +43,9 @@ namespace Magnum { namespace Trade {
 class AbstractImageConverter;
 class AbstractImporter;
 class AbstractSceneConverter;
+class ArrayArena;
+class AsyncImporter;
+class DerivedDataCache;
 
 #ifdef MAGNUM_BUILD_DEPRECATED
 typedef CORRADE_DEPRECATED("use InputFileCallbackPolicy instead") InputFileCallbackPolicy ImporterFileCallbackPolicy;
@@ -55,6 +58,7 @@ enum class MaterialLayer: UnsignedInt;
 enum class MaterialType: UnsignedInt;
 enum class MaterialAlphaMode: UnsignedByte;
 class MaterialAttributeData;
+class MaterialAttributeTarget;
 class MaterialData;
 #ifdef MAGNUM_BUILD_DEPRECATED
 typedef CORRADE_DEPRECATED("use MaterialData instead") MaterialData AbstractMaterialData;
@@ -98,6 +102,9 @@ class PbrMetallicRoughnessMaterialData;
 class PbrSpecularGlossinessMaterialData;
 class PhongMaterialData;
 class TextureData;
+enum class SceneField: UnsignedShort;
+enum class SceneFieldType: UnsignedShort;
+class SceneFieldData;
 class SceneData;
 
 template<UnsignedInt> class SkinData;
@@ -23,6 +23,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <mutex>
+#include <thread>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/StaticArray.h>
@@ -35,6 +38,7 @@
 
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Implementation/converterUtilities.h"
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/AbstractImageConverter.h"
 #include "Magnum/Trade/ImageData.h"
@@ -69,7 +73,9 @@ magnum-imageconverter [-h|--help] [-I|--importer IMPORTER]
     [-C|--converter CONVERTER] [--plugin-dir DIR]
     [-i|--importer-options key=val,key2=val2,…]
     [-c|--converter-options key=val,key2=val2,…] [--image IMAGE]
-    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--] input output
+    [--level LEVEL] [--in-place] [--info] [-v|--verbose] [--profile]
+    [--batch] [--threads N] [--output-extension EXT]
+    [--] input output
 @endcode
 
 Arguments:
@@ -91,6 +97,14 @@ Arguments:
 -   `--in-place` --- overwrite the input image with the output
 -   `--info` --- print info about the input file and exit
 -   `-v`, `--verbose` --- verbose output from importer and converter plugins
+-   `--profile` --- measure import and conversion time, together with a
+    breakdown of the import into file loading, file opening and image import
+-   `--batch` --- treat `input` as a wildcard pattern or a file with a list of
+    inputs and `output` as an output directory
+-   `--threads N` --- number of threads used in batch mode (default: `0`,
+    which means hardware concurrency)
+-   `--output-extension EXT` --- extension of output files in batch mode
+    (default: keep the input extension)
 
 Specifying `--importer raw:&lt;format&gt;` will treat the input as a raw
 tightly-packed square of pixels in given @ref PixelFormat. Specifying `-C` /
@@ -107,6 +121,22 @@ converter plugin configuration. If the `=` character is omitted, it's
 equivalent to saying `key=true`; configuration subgroups are delimited with
 `/`.
 
+@subsection magnum-imageconverter-usage-batch Batch mode
+
+If `--batch` is given, `input` is either a pattern with `*` and `?`
+wildcards in the filename part, or a text file listing one input file per
+line. Each input is converted into the `output` directory, keeping its
+filename and changing the extension to `--output-extension`, if specified.
+With `--in-place` each input is overwritten with its output instead.
+
+The files are distributed across `--threads` worker threads. Each thread
+loads the importer and converter plugins just once and reuses them for all
+files it processes, which avoids the process startup and plugin loading
+overhead of calling the utility once for each file. Files that fail to be
+converted are reported and skipped, and at the end the utility prints the
+number of converted files together with the aggregate throughput. The raw
+importer and `--info` are not supported in batch mode.
+
 @section magnum-imageconverter-example Example usage
 
 Converting a JPEG file to a PNG:
@@ -135,6 +165,26 @@ inspection:
 magnum-imageconverter image.dds --converter raw data.dat
 @endcode
 
+Converting all PNG files in a directory to RLE-compressed TGAs in another
+directory, on all available cores:
+
+@m_class{m-console-wrap}
+
+@code{.sh}
+magnum-imageconverter --batch "textures/*.png" out/ --output-extension tga -C TgaImageConverter -c rle
+@endcode
+
+Compressing a PNG file to BC7 using the
+@ref Trade::BlockCompressionImageConverter "BlockCompressionImageConverter"
+plugin on all available cores, producing a blob that can be imported with
+@ref Trade::MagnumImporter "MagnumImporter" and uploaded to a GPU directly:
+
+@m_class{m-console-wrap}
+
+@code{.sh}
+magnum-imageconverter image.png image.blob -C BlockCompressionImageConverter -c format=bc7,threads=0
+@endcode
+
 @see @ref magnum-sceneconverter
 */
 
@@ -142,6 +192,195 @@ magnum-imageconverter image.dds --converter raw data.dat
 
 using namespace Magnum;
 
+namespace {
+
+/* Matches a filename against a pattern with * and ? wildcards */
+bool matchesWildcard(const char* pattern, const char* string) {
+    /* On a mismatch go back to the last star and let it eat one more
+       character */
+    const char* star = nullptr;
+    const char* starString = nullptr;
+    while(*string) {
+        if(*pattern == '?' || (*pattern != '*' && *pattern == *string)) {
+            ++pattern;
+            ++string;
+        } else if(*pattern == '*') {
+            star = pattern++;
+            starString = string;
+        } else if(star) {
+            pattern = star + 1;
+            string = ++starString;
+        } else return false;
+    }
+
+    while(*pattern == '*') ++pattern;
+    return !*pattern;
+}
+
+/* Expands a wildcard pattern or reads a list of files */
+Containers::Optional<std::vector<std::string>> batchInputs(const std::string& input) {
+    std::vector<std::string> inputs;
+    if(input.find_first_of("*?") != std::string::npos) {
+        const std::string path = Utility::Directory::path(input);
+        const std::string pattern = Utility::Directory::filename(input);
+        if(!Utility::Directory::isDirectory(path.empty() ? "." : path)) {
+            Error{} << "Cannot list directory" << path;
+            return {};
+        }
+        for(const std::string& file: Utility::Directory::list(path.empty() ? "." : path, Utility::Directory::Flag::SkipDirectories|Utility::Directory::Flag::SkipDotAndDotDot|Utility::Directory::Flag::SortAscending))
+            if(matchesWildcard(pattern.data(), file.data()))
+                inputs.push_back(Utility::Directory::join(path, file));
+    } else {
+        /** @todo simplify once readString() reliably returns an Optional */
+        if(!Utility::Directory::exists(input)) {
+            Error{} << "Cannot open file" << input;
+            return {};
+        }
+        for(std::string& line: Utility::String::splitWithoutEmptyParts(Utility::Directory::readString(input), '\n')) {
+            Utility::String::trimInPlace(line);
+            if(!line.empty()) inputs.push_back(std::move(line));
+        }
+    }
+
+    return inputs;
+}
+
+int batch(const Utility::Arguments& args) {
+    if(args.isSet("info")) {
+        Error{} << "The --info option can't be used together with --batch";
+        return 1;
+    }
+    if(Utility::String::beginsWith(args.value("importer"), "raw:")) {
+        Error{} << "The raw importer can't be used together with --batch";
+        return 1;
+    }
+
+    Containers::Optional<std::vector<std::string>> inputs = batchInputs(args.value("input"));
+    if(!inputs) return 3;
+    if(inputs->empty()) {
+        Error{} << "No input files found in" << args.value("input");
+        return 3;
+    }
+
+    const bool inPlace = args.isSet("in-place");
+    const std::string outputDirectory = inPlace ? std::string{} : args.value("output");
+    if(!inPlace && !Utility::Directory::mkpath(outputDirectory)) {
+        Error{} << "Cannot create output directory" << outputDirectory;
+        return 5;
+    }
+    const std::string outputExtension = args.value("output-extension");
+
+    /* Zero thread count means hardware concurrency, but there's no point in
+       having more threads than files */
+    UnsignedInt threadCount = args.value<UnsignedInt>("threads");
+    if(!threadCount) threadCount = Math::max(std::thread::hardware_concurrency(), 1u);
+    threadCount = UnsignedInt(Math::min(std::size_t(threadCount), inputs->size()));
+
+    /* Each thread gets its own plugin managers and plugin instances. Plugin
+       managers are not thread-safe and the proxy plugins such as
+       AnyImageImporter load and instantiate the concrete plugin for every
+       file, so the managers can't be shared. Everything is set up upfront
+       on the main thread so errors are reported before any work starts. */
+    const bool rawConverter = args.value("converter") == "raw";
+    Containers::Array<Containers::Pointer<PluginManager::Manager<Trade::AbstractImporter>>> importerManagers{threadCount};
+    Containers::Array<Containers::Pointer<PluginManager::Manager<Trade::AbstractImageConverter>>> converterManagers{threadCount};
+    Containers::Array<Containers::Pointer<Trade::AbstractImporter>> importers{threadCount};
+    Containers::Array<Containers::Pointer<Trade::AbstractImageConverter>> converters{threadCount};
+    for(UnsignedInt i = 0; i != threadCount; ++i) {
+        importerManagers[i].reset(new PluginManager::Manager<Trade::AbstractImporter>{
+            args.value("plugin-dir").empty() ? std::string{} :
+            Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])});
+        if(!(importers[i] = importerManagers[i]->loadAndInstantiate(args.value("importer")))) {
+            Debug{} << "Available importer plugins:" << Utility::String::join(importerManagers[i]->aliasList(), ", ");
+            return 1;
+        }
+        if(args.isSet("verbose")) importers[i]->setFlags(Trade::ImporterFlag::Verbose);
+        Implementation::setOptions(*importers[i], args.value("importer-options"));
+
+        if(rawConverter) continue;
+
+        converterManagers[i].reset(new PluginManager::Manager<Trade::AbstractImageConverter>{
+            args.value("plugin-dir").empty() ? std::string{} :
+            Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImageConverter::pluginSearchPaths()[0])});
+        if(!(converters[i] = converterManagers[i]->loadAndInstantiate(args.value("converter")))) {
+            Debug{} << "Available converter plugins:" << Utility::String::join(converterManagers[i]->aliasList(), ", ");
+            return 2;
+        }
+        if(args.isSet("verbose")) converters[i]->setFlags(Trade::ImageConverterFlag::Verbose);
+        Implementation::setOptions(*converters[i], args.value("converter-options"));
+    }
+
+    const UnsignedInt imageId = args.value<UnsignedInt>("image");
+    const UnsignedInt level = args.value<UnsignedInt>("level");
+
+    /* The work queue is just an index into the input list, each thread takes
+       the next file once it's done with the previous one. Messages from the
+       threads are serialized to not get interleaved. */
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> failedCount{0};
+    std::atomic<std::size_t> imageDataSize{0};
+    std::mutex outputMutex;
+    const auto worker = [&](const UnsignedInt thread) {
+        Trade::AbstractImporter& importer = *importers[thread];
+        for(std::size_t i; (i = next++) < inputs->size(); ) {
+            const std::string& input = (*inputs)[i];
+            std::string output;
+            if(inPlace) output = input;
+            else {
+                output = Utility::Directory::join(outputDirectory, Utility::Directory::filename(input));
+                if(!outputExtension.empty())
+                    output = Utility::Directory::splitExtension(output).first + "." + outputExtension;
+            }
+
+            Containers::Optional<Trade::ImageData2D> image;
+            if(!importer.openFile(input) || !(image = importer.image2D(imageId, level))) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << "Cannot import" << input;
+                ++failedCount;
+                continue;
+            }
+            importer.close();
+
+            if(rawConverter ? !Utility::Directory::write(output, image->data()) : !converters[thread]->exportToFile(*image, output)) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Error{} << "Cannot save file" << output;
+                ++failedCount;
+                continue;
+            }
+
+            imageDataSize += image->data().size();
+
+            if(args.isSet("verbose")) {
+                std::lock_guard<std::mutex> lock{outputMutex};
+                Debug{} << "Converted" << input << "to" << output;
+            }
+        }
+    };
+
+    std::chrono::high_resolution_clock::duration batchTime{};
+    {
+        Implementation::Duration d{batchTime};
+
+        /* The first worker runs on the calling thread */
+        Containers::Array<std::thread> threads{Containers::ValueInit, threadCount - 1};
+        for(UnsignedInt i = 0; i != threads.size(); ++i)
+            threads[i] = std::thread{worker, i + 1};
+        worker(0);
+        for(std::thread& thread: threads) thread.join();
+    }
+
+    const Double seconds = std::chrono::duration<Double>(batchTime).count();
+    const std::size_t convertedCount = inputs->size() - failedCount;
+    Debug{} << "Converted" << convertedCount << "out of" << inputs->size() << "files with"
+        << imageDataSize/1.0e6 << "MB of image data in" << seconds << "seconds on"
+        << threadCount << "threads," << convertedCount/seconds << "files/s,"
+        << imageDataSize/1.0e6/seconds << "MB/s";
+
+    return failedCount ? 6 : 0;
+}
+
+}
+
 int main(int argc, char** argv) {
     Utility::Arguments args;
     args.addArgument("input").setHelp("input", "input image")
@@ -156,6 +395,10 @@ int main(int argc, char** argv) {
         .addBooleanOption("in-place").setHelp("in-place", "overwrite the input image with the output")
         .addBooleanOption("info").setHelp("info", "print info about the input file and exit")
         .addBooleanOption('v', "verbose").setHelp("verbose", "verbose output from importer and converter plugins")
+        .addBooleanOption("profile").setHelp("profile", "measure import and conversion time, including a breakdown of the import")
+        .addBooleanOption("batch").setHelp("batch", "treat input as a wildcard pattern or a file with a list of inputs and output as an output directory")
+        .addOption("threads", "0").setHelp("threads", "number of threads used in batch mode, 0 means hardware concurrency", "N")
+        .addOption("output-extension").setHelp("output-extension", "extension of output files in batch mode, keeps the input extension if empty", "EXT")
         .setParseErrorCallback([](const Utility::Arguments& args, Utility::Arguments::ParseError error, const std::string& key) {
             /* If --in-place or --info is passed, we don't need the output
                argument */
@@ -179,9 +422,17 @@ be specified.
 The -i / --importer-options and -c / --converter-options arguments accept a
 comma-separated list of key/value pairs to set in the importer / converter
 plugin configuration. If the = character is omitted, it's equivalent to saying
-key=true; configuration subgroups are delimited with /.)")
+key=true; configuration subgroups are delimited with /.
+
+If --batch is given, input is either a pattern with * and ? wildcards in the
+filename part or a text file listing one input file per line, and each input
+is converted into the output directory, optionally changing the extension to
+--output-extension. The files are processed on --threads threads, each reusing
+its own importer and converter instances.)")
         .parse(argc, argv);
 
+    if(args.isSet("batch")) return batch(args);
+
     PluginManager::Manager<Trade::AbstractImporter> importerManager{
         args.value("plugin-dir").empty() ? std::string{} :
         Utility::Directory::join(args.value("plugin-dir"), Trade::AbstractImporter::pluginSearchPaths()[0])};
@@ -190,6 +441,8 @@ key=true; configuration subgroups are delimited with /.)")
        given format */
     /** @todo implement image slicing and then use `--slice "0 0 w h"` to
         specify non-rectangular size (and +x +y to specify padding?) */
+    std::chrono::high_resolution_clock::duration importTime{};
+    Trade::Implementation::ImporterProfile importerProfile;
     Containers::Optional<Trade::ImageData2D> image;
     if(Utility::String::beginsWith(args.value("importer"), "raw:")) {
         /** @todo Any chance to do this without using internal APIs? */
@@ -205,7 +458,11 @@ key=true; configuration subgroups are delimited with /.)")
             Error{} << "Cannot open file" << args.value("input");
             return 3;
         }
-        Containers::Array<char> data = Utility::Directory::read(args.value("input"));
+        Containers::Array<char> data;
+        {
+            Implementation::Duration d{importTime};
+            data = Utility::Directory::read(args.value("input"));
+        }
         auto side = Int(std::sqrt(data.size()/pixelSize));
         if(data.size() % pixelSize || side*side*pixelSize != data.size()) {
             Error{} << "File of size" << data.size() << "is not a tightly-packed square of" << format;
@@ -232,12 +489,19 @@ key=true; configuration subgroups are delimited with /.)")
         if(args.isSet("verbose")) importer->setFlags(Trade::ImporterFlag::Verbose);
         Implementation::setOptions(*importer, args.value("importer-options"));
 
+        /* Collect per-stage timing from the importer, if requested */
+        if(args.isSet("profile"))
+            importer->setProfileCallback(Trade::Implementation::importerProfileCallback, &importerProfile);
+
         /* Print image info, if requested */
         if(args.isSet("info")) {
             /* Open the file, but don't fail when an image can't be opened */
-            if(!importer->openFile(args.value("input"))) {
-                Error() << "Cannot open file" << args.value("input");
-                return 3;
+            {
+                Implementation::Duration d{importTime};
+                if(!importer->openFile(args.value("input"))) {
+                    Error() << "Cannot open file" << args.value("input");
+                    return 3;
+                }
             }
 
             if(!importer->image1DCount() && !importer->image2DCount() && !importer->image2DCount()) {
@@ -249,8 +513,11 @@ key=true; configuration subgroups are delimited with /.)")
                In case the images have all just a single level and no names,
                write them in a compact way without listing levels. */
             bool error = false, compact = true;
-            Containers::Array<Trade::Implementation::ImageInfo> infos =
-                Trade::Implementation::imageInfo(*importer, error, compact);
+            Containers::Array<Trade::Implementation::ImageInfo> infos;
+            {
+                Implementation::Duration d{importTime};
+                infos = Trade::Implementation::imageInfo(*importer, error, compact);
+            }
 
             for(const Trade::Implementation::ImageInfo& info: infos) {
                 Debug d;
@@ -267,16 +534,22 @@ key=true; configuration subgroups are delimited with /.)")
                 else d << Math::Vector<1, Int>(info.size.x());
             }
 
+            if(args.isSet("profile")) {
+                Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds";
+                Trade::Implementation::printImporterProfile(importerProfile);
+            }
+
             return error ? 1 : 0;
         }
 
         /* Open input file and the desired image */
+        Implementation::Duration d{importTime};
         if(!importer->openFile(args.value("input"))) {
             Error() << "Cannot open file" << args.value("input");
             return 3;
         }
 
-         if(!(image = importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
+        if(!(image = importer->image2D(args.value<UnsignedInt>("image"), args.value<UnsignedInt>("level")))) {
             Error() << "Cannot import the image";
             return 4;
         }
@@ -296,9 +569,19 @@ key=true; configuration subgroups are delimited with /.)")
         d << "to" << output;
     }
 
+    std::chrono::high_resolution_clock::duration conversionTime{};
+
     /* Save raw data, if requested */
     if(args.value("converter") == "raw") {
-        Utility::Directory::write(output, image->data());
+        {
+            Implementation::Duration d{conversionTime};
+            Utility::Directory::write(output, image->data());
+        }
+        if(args.isSet("profile")) {
+            Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, writing"
+                << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds";
+            Trade::Implementation::printImporterProfile(importerProfile);
+        }
         return 0;
     }
 
@@ -317,8 +600,17 @@ key=true; configuration subgroups are delimited with /.)")
     Implementation::setOptions(*converter, args.value("converter-options"));
 
     /* Save output file */
-    if(!converter->exportToFile(*image, output)) {
-        Error() << "Cannot save file" << output;
-        return 5;
+    {
+        Implementation::Duration d{conversionTime};
+        if(!converter->exportToFile(*image, output)) {
+            Error() << "Cannot save file" << output;
+            return 5;
+        }
+    }
+
+    if(args.isSet("profile")) {
+        Debug{} << "Import took" << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(importTime).count())/1.0e3f << "seconds, conversion"
+            << UnsignedInt(std::chrono::duration_cast<std::chrono::milliseconds>(conversionTime).count())/1.0e3f << "seconds";
+        Trade::Implementation::printImporterProfile(importerProfile);
     }
 }
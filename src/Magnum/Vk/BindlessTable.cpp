@@ -0,0 +1,298 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BindlessTable.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+struct Binding {
+    DescriptorType type;
+    UnsignedInt capacity;
+    /* Slots below this index were used at some point, the ones above were
+       never touched */
+    UnsignedInt next{};
+    UnsignedInt usedCount{};
+    /* Slots below next that were removed, reused in LIFO order */
+    Containers::Array<UnsignedInt> freeSlots;
+    Containers::Array<bool> used;
+};
+
+bool isImageType(const DescriptorType type) {
+    return type == DescriptorType::CombinedImageSampler ||
+           type == DescriptorType::SampledImage ||
+           type == DescriptorType::StorageImage;
+}
+
+bool isBufferType(const DescriptorType type) {
+    return type == DescriptorType::UniformBuffer ||
+           type == DescriptorType::StorageBuffer;
+}
+
+}
+
+struct BindlessTable::State {
+    explicit State(Device& device): device(device), layout{NoCreate}, pool{NoCreate}, set{NoCreate} {}
+
+    UnsignedInt takeSlot(Binding& binding) {
+        UnsignedInt slot;
+        if(binding.freeSlots.empty()) slot = binding.next++;
+        else {
+            slot = binding.freeSlots.back();
+            arrayRemoveSuffix(binding.freeSlots);
+        }
+        binding.used[slot] = true;
+        ++binding.usedCount;
+        return slot;
+    }
+
+    void write(UnsignedInt binding, UnsignedInt slot, const VkDescriptorImageInfo* imageInfo, const VkDescriptorBufferInfo* bufferInfo) {
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = set;
+        write.dstBinding = binding;
+        write.dstArrayElement = slot;
+        write.descriptorCount = 1;
+        write.descriptorType = VkDescriptorType(bindings[binding].type);
+        write.pImageInfo = imageInfo;
+        write.pBufferInfo = bufferInfo;
+        device->UpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
+
+    void writeImage(UnsignedInt binding, UnsignedInt slot, VkImageView view, ImageLayout layout, VkSampler sampler) {
+        VkDescriptorImageInfo info{};
+        /* Vulkan ignores the sampler for other types, but keep it clean */
+        if(bindings[binding].type == DescriptorType::CombinedImageSampler)
+            info.sampler = sampler;
+        info.imageView = view;
+        info.imageLayout = VkImageLayout(layout);
+        write(binding, slot, &info, nullptr);
+    }
+
+    void writeBuffer(UnsignedInt binding, UnsignedInt slot, VkBuffer buffer, UnsignedLong offset, UnsignedLong size) {
+        VkDescriptorBufferInfo info{};
+        info.buffer = buffer;
+        info.offset = offset;
+        info.range = size;
+        write(binding, slot, nullptr, &info);
+    }
+
+    void writeSampler(UnsignedInt binding, UnsignedInt slot, VkSampler sampler) {
+        VkDescriptorImageInfo info{};
+        info.sampler = sampler;
+        write(binding, slot, &info, nullptr);
+    }
+
+    Device& device;
+    DescriptorSetLayout layout;
+    DescriptorPool pool;
+    /* Doesn't own the handle, freed implicitly with the pool */
+    DescriptorSet set;
+    Containers::Array<Binding> bindings;
+};
+
+BindlessTable::BindlessTable(Device& device, const Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>> bindings, const ShaderStages stages) {
+    CORRADE_ASSERT(!bindings.empty(),
+        "Vk::BindlessTable: expected at least one binding", );
+
+    _state.emplace(device);
+    _state->bindings = Containers::Array<Binding>{Containers::ValueInit, bindings.size()};
+
+    Containers::Array<DescriptorSetLayoutBinding> layoutBindings;
+    arrayReserve(layoutBindings, bindings.size());
+    for(std::size_t i = 0; i != bindings.size(); ++i) {
+        const DescriptorType type = bindings[i].first;
+        const UnsignedInt capacity = bindings[i].second;
+        CORRADE_ASSERT(type == DescriptorType::Sampler || isImageType(type) || isBufferType(type),
+            "Vk::BindlessTable: unsupported" << type << "for binding" << i, );
+        CORRADE_ASSERT(capacity,
+            "Vk::BindlessTable: expected non-zero capacity for binding" << i, );
+
+        arrayAppend(layoutBindings, Containers::InPlaceInit,
+            UnsignedInt(i), type, capacity, stages,
+            DescriptorSetLayoutBinding::Flag::UpdateAfterBind|
+            DescriptorSetLayoutBinding::Flag::UpdateUnusedWhilePending|
+            DescriptorSetLayoutBinding::Flag::PartiallyBound);
+
+        Binding& binding = _state->bindings[i];
+        binding.type = type;
+        binding.capacity = capacity;
+        binding.used = Containers::Array<bool>{Containers::ValueInit, capacity};
+    }
+
+    _state->layout = DescriptorSetLayout{device, DescriptorSetLayoutCreateInfo{layoutBindings,
+        DescriptorSetLayoutCreateInfo::Flag::UpdateAfterBindPool}};
+    _state->pool = DescriptorPool{device, DescriptorPoolCreateInfo{1, bindings,
+        DescriptorPoolCreateInfo::Flag::UpdateAfterBind}};
+    _state->set = _state->pool.allocate(_state->layout);
+}
+
+BindlessTable::BindlessTable(Device& device, const std::initializer_list<std::pair<DescriptorType, UnsignedInt>> bindings, const ShaderStages stages): BindlessTable{device, Containers::arrayView(bindings), stages} {}
+
+BindlessTable::BindlessTable(NoCreateT) noexcept {}
+
+BindlessTable::BindlessTable(BindlessTable&&) noexcept = default;
+
+BindlessTable::~BindlessTable() = default;
+
+BindlessTable& BindlessTable::operator=(BindlessTable&&) noexcept = default;
+
+DescriptorSetLayout& BindlessTable::layout() {
+    return _state->layout;
+}
+
+DescriptorSet& BindlessTable::set() {
+    return _state->set;
+}
+
+UnsignedInt BindlessTable::bindingCount() const {
+    return _state ? _state->bindings.size() : 0;
+}
+
+DescriptorType BindlessTable::descriptorType(const UnsignedInt binding) const {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::descriptorType(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    return _state->bindings[binding].type;
+}
+
+UnsignedInt BindlessTable::capacity(const UnsignedInt binding) const {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::capacity(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    return _state->bindings[binding].capacity;
+}
+
+UnsignedInt BindlessTable::usedCount(const UnsignedInt binding) const {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::usedCount(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    return _state->bindings[binding].usedCount;
+}
+
+bool BindlessTable::isUsed(const UnsignedInt binding, const UnsignedInt slot) const {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::isUsed(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    CORRADE_ASSERT(slot < _state->bindings[binding].capacity,
+        "Vk::BindlessTable::isUsed(): slot" << slot << "out of range for" << _state->bindings[binding].capacity << "descriptors in binding" << binding, {});
+    return _state->bindings[binding].used[slot];
+}
+
+UnsignedInt BindlessTable::addImage(const UnsignedInt binding, const VkImageView view, const ImageLayout layout, const VkSampler sampler) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::addImage(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    Binding& b = _state->bindings[binding];
+    CORRADE_ASSERT(isImageType(b.type),
+        "Vk::BindlessTable::addImage(): binding" << binding << "is" << b.type, {});
+    CORRADE_ASSERT(!b.freeSlots.empty() || b.next < b.capacity,
+        "Vk::BindlessTable::addImage(): binding" << binding << "is full with" << b.capacity << "descriptors", {});
+
+    const UnsignedInt slot = _state->takeSlot(b);
+    _state->writeImage(binding, slot, view, layout, sampler);
+    return slot;
+}
+
+UnsignedInt BindlessTable::addBuffer(const UnsignedInt binding, const VkBuffer buffer, const UnsignedLong offset, const UnsignedLong size) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::addBuffer(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    Binding& b = _state->bindings[binding];
+    CORRADE_ASSERT(isBufferType(b.type),
+        "Vk::BindlessTable::addBuffer(): binding" << binding << "is" << b.type, {});
+    CORRADE_ASSERT(!b.freeSlots.empty() || b.next < b.capacity,
+        "Vk::BindlessTable::addBuffer(): binding" << binding << "is full with" << b.capacity << "descriptors", {});
+
+    const UnsignedInt slot = _state->takeSlot(b);
+    _state->writeBuffer(binding, slot, buffer, offset, size);
+    return slot;
+}
+
+UnsignedInt BindlessTable::addSampler(const UnsignedInt binding, const VkSampler sampler) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::addSampler(): index" << binding << "out of range for" << bindingCount() << "bindings", {});
+    Binding& b = _state->bindings[binding];
+    CORRADE_ASSERT(b.type == DescriptorType::Sampler,
+        "Vk::BindlessTable::addSampler(): binding" << binding << "is" << b.type, {});
+    CORRADE_ASSERT(!b.freeSlots.empty() || b.next < b.capacity,
+        "Vk::BindlessTable::addSampler(): binding" << binding << "is full with" << b.capacity << "descriptors", {});
+
+    const UnsignedInt slot = _state->takeSlot(b);
+    _state->writeSampler(binding, slot, sampler);
+    return slot;
+}
+
+void BindlessTable::setImage(const UnsignedInt binding, const UnsignedInt slot, const VkImageView view, const ImageLayout layout, const VkSampler sampler) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::setImage(): index" << binding << "out of range for" << bindingCount() << "bindings", );
+    CORRADE_ASSERT(isImageType(_state->bindings[binding].type),
+        "Vk::BindlessTable::setImage(): binding" << binding << "is" << _state->bindings[binding].type, );
+    CORRADE_ASSERT(slot < _state->bindings[binding].capacity && _state->bindings[binding].used[slot],
+        "Vk::BindlessTable::setImage(): slot" << slot << "in binding" << binding << "is not used", );
+
+    _state->writeImage(binding, slot, view, layout, sampler);
+}
+
+void BindlessTable::setBuffer(const UnsignedInt binding, const UnsignedInt slot, const VkBuffer buffer, const UnsignedLong offset, const UnsignedLong size) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::setBuffer(): index" << binding << "out of range for" << bindingCount() << "bindings", );
+    CORRADE_ASSERT(isBufferType(_state->bindings[binding].type),
+        "Vk::BindlessTable::setBuffer(): binding" << binding << "is" << _state->bindings[binding].type, );
+    CORRADE_ASSERT(slot < _state->bindings[binding].capacity && _state->bindings[binding].used[slot],
+        "Vk::BindlessTable::setBuffer(): slot" << slot << "in binding" << binding << "is not used", );
+
+    _state->writeBuffer(binding, slot, buffer, offset, size);
+}
+
+void BindlessTable::setSampler(const UnsignedInt binding, const UnsignedInt slot, const VkSampler sampler) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::setSampler(): index" << binding << "out of range for" << bindingCount() << "bindings", );
+    CORRADE_ASSERT(_state->bindings[binding].type == DescriptorType::Sampler,
+        "Vk::BindlessTable::setSampler(): binding" << binding << "is" << _state->bindings[binding].type, );
+    CORRADE_ASSERT(slot < _state->bindings[binding].capacity && _state->bindings[binding].used[slot],
+        "Vk::BindlessTable::setSampler(): slot" << slot << "in binding" << binding << "is not used", );
+
+    _state->writeSampler(binding, slot, sampler);
+}
+
+void BindlessTable::remove(const UnsignedInt binding, const UnsignedInt slot) {
+    CORRADE_ASSERT(binding < bindingCount(),
+        "Vk::BindlessTable::remove(): index" << binding << "out of range for" << bindingCount() << "bindings", );
+    Binding& b = _state->bindings[binding];
+    CORRADE_ASSERT(slot < b.capacity && b.used[slot],
+        "Vk::BindlessTable::remove(): slot" << slot << "in binding" << binding << "is not used", );
+
+    b.used[slot] = false;
+    --b.usedCount;
+    arrayAppend(b.freeSlots, slot);
+}
+
+}}
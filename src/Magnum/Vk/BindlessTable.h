@@ -0,0 +1,298 @@
+#ifndef Magnum_Vk_BindlessTable_h
+#define Magnum_Vk_BindlessTable_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Vk::BindlessTable
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Shader.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Bindless resource table
+@m_since_latest
+
+A single large descriptor set containing arrays of all images and buffers used
+by the application, bound once and indexed from per-draw data in the shader
+instead of allocating and binding a descriptor set for every draw.
+
+@section Vk-BindlessTable-creation Table creation
+
+The constructor takes a descriptor type and capacity for each binding. Binding
+indices correspond to the order in which they're passed. The table creates a
+@ref DescriptorSetLayout with
+@ref DescriptorSetLayoutCreateInfo::Flag::UpdateAfterBindPool and all bindings
+having @ref DescriptorSetLayoutBinding::Flag::UpdateAfterBind,
+@ref DescriptorSetLayoutBinding::Flag::UpdateUnusedWhilePending "UpdateUnusedWhilePending"
+and @ref DescriptorSetLayoutBinding::Flag::PartiallyBound "PartiallyBound",
+a @ref DescriptorPool with
+@ref DescriptorPoolCreateInfo::Flag::UpdateAfterBind large enough for all
+descriptors, and allocates a single @ref DescriptorSet from it. The set is
+then bound using @ref CommandBuffer::bindDescriptorSets() once per command
+buffer, with @ref layout() being a part of the pipeline layout:
+
+@snippet MagnumVk.cpp BindlessTable-usage
+
+Only @ref DescriptorType::Sampler, @relativeref{DescriptorType,CombinedImageSampler},
+@relativeref{DescriptorType,SampledImage},
+@relativeref{DescriptorType,StorageImage},
+@relativeref{DescriptorType,UniformBuffer} and
+@relativeref{DescriptorType,StorageBuffer} bindings are supported.
+
+@section Vk-BindlessTable-slots Slot allocation
+
+Each binding is an array of slots. @ref addImage(), @ref addBuffer() and
+@ref addSampler() take a free slot in given binding, write the descriptor into
+it with @fn_vk{UpdateDescriptorSets} and return the slot index, which is then
+passed to the shader for example through a push constant or a per-draw storage
+buffer. Removing a descriptor with @ref remove() puts its slot into a per-binding
+free list and subsequent additions reuse the most recently freed slots first,
+keeping the used range compact. A descriptor in an existing slot can be also
+replaced using @ref setImage(), @ref setBuffer() and @ref setSampler().
+
+Thanks to the update-after-bind flags, descriptors can be written while the
+set is bound in command buffers that are recorded or pending execution, as
+long as the particular slot isn't used by any of them. In particular, a slot
+should be removed only once the GPU finished all frames that accessed it, for
+example by delaying the @ref remove() call by @ref FrameLoop::frameCount()
+frames. Unused slots don't need to contain valid descriptors thanks to the
+partially bound flag.
+
+@section Vk-BindlessTable-requirements Device requirements
+
+The table needs Vulkan 1.2 or the @vk_extension{EXT,descriptor_indexing}
+extension enabled on the device together with
+@ref DeviceFeature::DescriptorBindingUpdateUnusedWhilePending,
+@ref DeviceFeature::DescriptorBindingPartiallyBound and the update-after-bind
+feature for each used descriptor type, such as
+@ref DeviceFeature::DescriptorBindingSampledImageUpdateAfterBind. Indexing the
+arrays with a non-uniform value in the shader additionally needs for example
+@ref DeviceFeature::ShaderSampledImageArrayNonUniformIndexing. The capacity of
+each binding is limited by the `maxDescriptorSetUpdateAfterBind*` limits of
+the device.
+*/
+class MAGNUM_VK_EXPORT BindlessTable {
+    public:
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the table on
+         * @param bindings  Descriptor type and capacity for each binding
+         * @param stages    Shader stages accessing the bindings. The default
+         *      value means all stages.
+         *
+         * Expects that @p bindings is non-empty, all capacities are non-zero
+         * and all types are one of the supported types listed in the
+         * @ref Vk-BindlessTable-creation "class documentation".
+         * @see @fn_vk_keyword{CreateDescriptorSetLayout},
+         *      @fn_vk_keyword{CreateDescriptorPool},
+         *      @fn_vk_keyword{AllocateDescriptorSets}
+         */
+        explicit BindlessTable(Device& device, Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>> bindings, ShaderStages stages = ~ShaderStages{});
+
+        /** @overload */
+        explicit BindlessTable(Device& device, std::initializer_list<std::pair<DescriptorType, UnsignedInt>> bindings, ShaderStages stages = ~ShaderStages{});
+
+        /**
+         * @brief Construct without creating the table
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit BindlessTable(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        BindlessTable(const BindlessTable&) = delete;
+
+        /** @brief Move constructor */
+        BindlessTable(BindlessTable&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys the descriptor pool, implicitly freeing the descriptor
+         * set, and the descriptor set layout.
+         */
+        ~BindlessTable();
+
+        /** @brief Copying is not allowed */
+        BindlessTable& operator=(const BindlessTable&) = delete;
+
+        /** @brief Move assignment */
+        BindlessTable& operator=(BindlessTable&&) noexcept;
+
+        /** @brief Descriptor set layout */
+        DescriptorSetLayout& layout();
+
+        /** @brief Descriptor set */
+        DescriptorSet& set();
+
+        /**
+         * @brief Binding count
+         *
+         * Returns @cpp 0 @ce for a moved-from instance.
+         */
+        UnsignedInt bindingCount() const;
+
+        /**
+         * @brief Descriptor type of given binding
+         *
+         * Expects that @p binding is less than @ref bindingCount().
+         */
+        DescriptorType descriptorType(UnsignedInt binding) const;
+
+        /**
+         * @brief Capacity of given binding
+         *
+         * Expects that @p binding is less than @ref bindingCount().
+         */
+        UnsignedInt capacity(UnsignedInt binding) const;
+
+        /**
+         * @brief Count of used slots in given binding
+         *
+         * Expects that @p binding is less than @ref bindingCount().
+         */
+        UnsignedInt usedCount(UnsignedInt binding) const;
+
+        /**
+         * @brief Whether given slot is used
+         *
+         * Expects that @p binding is less than @ref bindingCount() and
+         * @p slot is less than @ref capacity().
+         */
+        bool isUsed(UnsignedInt binding, UnsignedInt slot) const;
+
+        /**
+         * @brief Add an image descriptor
+         * @param binding   Binding index
+         * @param view      Image view
+         * @param layout    Layout the image is in when accessed through the
+         *      descriptor
+         * @param sampler   Sampler for a
+         *      @ref DescriptorType::CombinedImageSampler binding, ignored
+         *      otherwise
+         * @return Slot index
+         *
+         * Expects that @p binding is less than @ref bindingCount(), is a
+         * @ref DescriptorType::CombinedImageSampler,
+         * @relativeref{DescriptorType,SampledImage} or
+         * @relativeref{DescriptorType,StorageImage} binding and that it has a
+         * free slot.
+         * @see @ref setImage(), @ref remove(),
+         *      @fn_vk_keyword{UpdateDescriptorSets}
+         */
+        UnsignedInt addImage(UnsignedInt binding, VkImageView view, ImageLayout layout = ImageLayout::ShaderReadOnly, VkSampler sampler = {});
+
+        /**
+         * @brief Add a buffer descriptor
+         * @param binding   Binding index
+         * @param buffer    Buffer
+         * @param offset    Offset into the buffer
+         * @param size      Size of the buffer range. The default value means
+         *      the whole buffer from @p offset.
+         * @return Slot index
+         *
+         * Expects that @p binding is less than @ref bindingCount(), is a
+         * @ref DescriptorType::UniformBuffer or
+         * @relativeref{DescriptorType,StorageBuffer} binding and that it has
+         * a free slot.
+         * @see @ref setBuffer(), @ref remove(),
+         *      @fn_vk_keyword{UpdateDescriptorSets}
+         */
+        UnsignedInt addBuffer(UnsignedInt binding, VkBuffer buffer, UnsignedLong offset = 0, UnsignedLong size = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Add a sampler descriptor
+         * @param binding   Binding index
+         * @param sampler   Sampler
+         * @return Slot index
+         *
+         * Expects that @p binding is less than @ref bindingCount(), is a
+         * @ref DescriptorType::Sampler binding and that it has a free slot.
+         * @see @ref setSampler(), @ref remove(),
+         *      @fn_vk_keyword{UpdateDescriptorSets}
+         */
+        UnsignedInt addSampler(UnsignedInt binding, VkSampler sampler);
+
+        /**
+         * @brief Replace an image descriptor in a used slot
+         *
+         * Same as @ref addImage(), but writes into an existing @p slot that's
+         * expected to be used.
+         */
+        void setImage(UnsignedInt binding, UnsignedInt slot, VkImageView view, ImageLayout layout = ImageLayout::ShaderReadOnly, VkSampler sampler = {});
+
+        /**
+         * @brief Replace a buffer descriptor in a used slot
+         *
+         * Same as @ref addBuffer(), but writes into an existing @p slot
+         * that's expected to be used.
+         */
+        void setBuffer(UnsignedInt binding, UnsignedInt slot, VkBuffer buffer, UnsignedLong offset = 0, UnsignedLong size = VK_WHOLE_SIZE);
+
+        /**
+         * @brief Replace a sampler descriptor in a used slot
+         *
+         * Same as @ref addSampler(), but writes into an existing @p slot
+         * that's expected to be used.
+         */
+        void setSampler(UnsignedInt binding, UnsignedInt slot, VkSampler sampler);
+
+        /**
+         * @brief Remove a descriptor
+         *
+         * Expects that @p binding is less than @ref bindingCount() and
+         * @p slot is used. The slot is put into a free list and reused by a
+         * subsequent addition to the same binding. The descriptor itself
+         * isn't touched, the slot is expected to not be accessed by any
+         * pending command buffer anymore once it gets reused.
+         */
+        void remove(UnsignedInt binding, UnsignedInt slot);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
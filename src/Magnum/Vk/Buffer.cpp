@@ -60,7 +60,7 @@ Buffer Buffer::wrap(Device& device, const VkBuffer handle, const HandleFlags fla
     return out;
 }
 
-Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate} {
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateBuffer(device, info, nullptr, &_handle));
 }
 
@@ -72,9 +72,13 @@ Buffer::Buffer(Device& device, const BufferCreateInfo& info, const MemoryFlags m
     }});
 }
 
-Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate} {}
+Buffer::Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, const MemoryFlags memoryFlags, const MemoryAllocationStrategy strategy): Buffer{device, info, NoAllocate} {
+    bindAllocatedMemory(allocator.allocate(memoryRequirements(), memoryFlags, strategy));
+}
+
+Buffer::Buffer(NoCreateT): _device{}, _handle{}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {}
 
-Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{std::move(other._dedicatedMemory)} {
+Buffer::Buffer(Buffer&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _dedicatedMemory{std::move(other._dedicatedMemory)}, _allocatedMemory{std::move(other._allocatedMemory)} {
     other._handle = {};
 }
 
@@ -89,6 +93,7 @@ Buffer& Buffer::operator=(Buffer&& other) noexcept {
     swap(other._handle, _handle);
     swap(other._flags, _flags);
     swap(other._dedicatedMemory, _dedicatedMemory);
+    swap(other._allocatedMemory, _allocatedMemory);
     return *this;
 }
 
@@ -127,6 +132,21 @@ Memory& Buffer::dedicatedMemory() {
     return _dedicatedMemory;
 }
 
+void Buffer::bindAllocatedMemory(MemoryAllocation&& allocation) {
+    bindMemory(allocation.memory(), allocation.offset());
+    _allocatedMemory = std::move(allocation);
+}
+
+bool Buffer::hasAllocatedMemory() const {
+    return _allocatedMemory.allocator();
+}
+
+MemoryAllocation& Buffer::allocatedMemory() {
+    CORRADE_ASSERT(_allocatedMemory.allocator(),
+        "Vk::Buffer::allocatedMemory(): buffer doesn't have memory from an allocator", _allocatedMemory);
+    return _allocatedMemory;
+}
+
 VkBuffer Buffer::release() {
     const VkBuffer handle = _handle;
     _handle = {};
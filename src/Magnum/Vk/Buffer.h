@@ -35,6 +35,7 @@
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -76,6 +77,20 @@ available through @ref dedicatedMemory(). This matches current behavior of the
 above, except that you have more control over choosing and allocating the
 memory.
 
+@subsection Vk-Buffer-creation-allocator Sub-allocating from a memory allocator
+
+To avoid having a dedicated allocation for each buffer, pass a
+@ref MemoryAllocator to the
+@ref Buffer(Device&, const BufferCreateInfo&, MemoryAllocator&, MemoryFlags, MemoryAllocationStrategy)
+constructor. The buffer then owns a @ref MemoryAllocation sub-range of a larger
+memory block, subsequently accessible through @ref allocatedMemory(), and
+gives it back to the allocator on destruction.
+
+@snippet MagnumVk.cpp Buffer-creation-allocator
+
+Equivalently, a @ref MemoryAllocation from @ref MemoryAllocator::allocate()
+can be bound using @ref bindAllocatedMemory().
+
 @see @ref Image
 */
 class MAGNUM_VK_EXPORT Buffer {
@@ -119,6 +134,22 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct a buffer with memory from an allocator
+         * @param device        Vulkan device to create the buffer on
+         * @param info          Buffer creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         * @param strategy      Allocation strategy
+         *
+         * Compared to @ref Buffer(Device&, const BufferCreateInfo&, MemoryFlags)
+         * sub-allocates the memory from @p allocator, which is then available
+         * through @ref allocatedMemory(). The @p allocator is expected to
+         * outlive the buffer.
+         * @see @ref MemoryAllocator::allocate(), @ref bindAllocatedMemory()
+         */
+        explicit Buffer(Device& device, const BufferCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags, MemoryAllocationStrategy strategy = MemoryAllocationStrategy::General);
+
         /**
          * @brief Construct without creating the buffer
          *
@@ -203,6 +234,34 @@ class MAGNUM_VK_EXPORT Buffer {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Bind buffer memory from an allocator
+         *
+         * Equivalent to @ref bindMemory() with @ref MemoryAllocation::memory()
+         * and @ref MemoryAllocation::offset(), with the additional effect
+         * that @p allocation ownership transfers to the buffer and is then
+         * available through @ref allocatedMemory(). Assumes that the
+         * allocation satisfies buffer memory requirements.
+         */
+        void bindAllocatedMemory(MemoryAllocation&& allocation);
+
+        /**
+         * @brief Whether the buffer has memory from an allocator
+         *
+         * Returns @cpp true @ce if the buffer memory was bound using
+         * @ref bindAllocatedMemory(), @cpp false @ce otherwise.
+         * @see @ref allocatedMemory()
+         */
+        bool hasAllocatedMemory() const;
+
+        /**
+         * @brief Buffer memory from an allocator
+         *
+         * Expects that the buffer has memory from an allocator.
+         * @see @ref hasAllocatedMemory()
+         */
+        MemoryAllocation& allocatedMemory();
+
         /**
          * @brief Release the underlying Vulkan buffer
          *
@@ -230,6 +289,7 @@ class MAGNUM_VK_EXPORT Buffer {
         VkBuffer _handle;
         HandleFlags _flags;
         Memory _dedicatedMemory;
+        MemoryAllocation _allocatedMemory;
 };
 
 }}
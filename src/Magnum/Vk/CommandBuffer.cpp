@@ -25,12 +25,38 @@
 
 #include "CommandBuffer.h"
 
+#include <Corrade/Containers/ArrayView.h>
+
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
 #include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Pipeline.h"
 
 namespace Magnum { namespace Vk {
 
+CommandBufferBeginInfo::CommandBufferBeginInfo(const Flags flags): _info{}, _inheritanceInfo{} {
+    _info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    _info.flags = VkCommandBufferUsageFlags(flags);
+
+    /* Ignored for primary buffers but required to be valid for secondary, so
+       always point to something */
+    _inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    _info.pInheritanceInfo = &_inheritanceInfo;
+}
+
+CommandBufferBeginInfo::CommandBufferBeginInfo(const VkRenderPass renderPass, const UnsignedInt subpass, const VkFramebuffer framebuffer, const Flags flags): CommandBufferBeginInfo{flags|Flag::RenderPassContinue} {
+    _inheritanceInfo.renderPass = renderPass;
+    _inheritanceInfo.subpass = subpass;
+    _inheritanceInfo.framebuffer = framebuffer;
+}
+
+CommandBufferBeginInfo::CommandBufferBeginInfo(NoInitT) noexcept {}
+
+CommandBufferBeginInfo::CommandBufferBeginInfo(const VkCommandBufferBeginInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info), _inheritanceInfo{} {}
+
 CommandBuffer CommandBuffer::wrap(Device& device, const VkCommandPool pool, const VkCommandBuffer handle, const HandleFlags flags) {
     CommandBuffer out{NoCreate};
     out._device = &device;
@@ -64,6 +90,58 @@ void CommandBuffer::reset(const CommandBufferResetFlags flags) {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).ResetCommandBuffer(_handle, VkCommandBufferResetFlags(flags)));
 }
 
+CommandBuffer& CommandBuffer::begin(const CommandBufferBeginInfo& info) {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).BeginCommandBuffer(_handle, info));
+    return *this;
+}
+
+void CommandBuffer::end() {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).EndCommandBuffer(_handle));
+}
+
+CommandBuffer& CommandBuffer::executeCommands(const Containers::ArrayView<const VkCommandBuffer> buffers) {
+    (**_device).CmdExecuteCommands(_handle, buffers.size(), buffers.data());
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::executeCommands(const std::initializer_list<VkCommandBuffer> buffers) {
+    return executeCommands(Containers::arrayView(buffers));
+}
+
+CommandBuffer& CommandBuffer::bindPipeline(Pipeline& pipeline) {
+    (**_device).CmdBindPipeline(_handle, VkPipelineBindPoint(pipeline.bindPoint()), pipeline);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::bindDescriptorSets(const PipelineBindPoint bindPoint, const VkPipelineLayout layout, const UnsignedInt firstSet, const Containers::ArrayView<const VkDescriptorSet> descriptorSets, const Containers::ArrayView<const UnsignedInt> dynamicOffsets) {
+    (**_device).CmdBindDescriptorSets(_handle, VkPipelineBindPoint(bindPoint), layout, firstSet, descriptorSets.size(), descriptorSets.data(), dynamicOffsets.size(), dynamicOffsets.data());
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::bindDescriptorSets(const PipelineBindPoint bindPoint, const VkPipelineLayout layout, const UnsignedInt firstSet, const std::initializer_list<VkDescriptorSet> descriptorSets, const std::initializer_list<UnsignedInt> dynamicOffsets) {
+    return bindDescriptorSets(bindPoint, layout, firstSet, Containers::arrayView(descriptorSets), Containers::arrayView(dynamicOffsets));
+}
+
+CommandBuffer& CommandBuffer::resetQueryPool(const VkQueryPool pool, const UnsignedInt first, const UnsignedInt count) {
+    (**_device).CmdResetQueryPool(_handle, pool, first, count);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::beginQuery(const VkQueryPool pool, const UnsignedInt query) {
+    (**_device).CmdBeginQuery(_handle, pool, query, 0);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::endQuery(const VkQueryPool pool, const UnsignedInt query) {
+    (**_device).CmdEndQuery(_handle, pool, query);
+    return *this;
+}
+
+CommandBuffer& CommandBuffer::writeTimestamp(const PipelineStage stage, const VkQueryPool pool, const UnsignedInt query) {
+    (**_device).CmdWriteTimestamp(_handle, VkPipelineStageFlagBits(stage), pool, query);
+    return *this;
+}
+
 VkCommandBuffer CommandBuffer::release() {
     const VkCommandBuffer handle = _handle;
     _handle = nullptr;
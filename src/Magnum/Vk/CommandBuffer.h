@@ -26,10 +26,11 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Vk::CommandBuffer, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
+ * @brief Class @ref Magnum::Vk::CommandBuffer, @ref Magnum::Vk::CommandBufferBeginInfo, enum @ref Magnum::Vk::CommandPoolResetFlag, enum set @ref Magnum::Vk::CommandPoolResetFlags
  * @m_since_latest
  */
 
+#include <initializer_list>
 #include <Corrade/Containers/EnumSet.h>
 #include <Corrade/Containers/Reference.h>
 
@@ -67,12 +68,163 @@ typedef Containers::EnumSet<CommandBufferResetFlag> CommandBufferResetFlags;
 
 CORRADE_ENUMSET_OPERATORS(CommandBufferResetFlags)
 
+/**
+@brief Command buffer begin info
+@m_since_latest
+
+Wraps a @type_vk_keyword{CommandBufferBeginInfo} together with a
+@type_vk_keyword{CommandBufferInheritanceInfo}. See
+@ref Vk-CommandBuffer-recording "Command buffer recording" for usage
+information.
+*/
+class MAGNUM_VK_EXPORT CommandBufferBeginInfo {
+    public:
+        /**
+         * @brief Command buffer begin flag
+         *
+         * Wraps @type_vk_keyword{CommandBufferUsageFlagBits}.
+         * @see @ref Flags, @ref CommandBufferBeginInfo(Flags)
+         * @m_enum_values_as_keywords
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Each recording of the command buffer will be submitted only
+             * once and the buffer reset and recorded again between each
+             * submission.
+             */
+            OneTimeSubmit = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+
+            /**
+             * A secondary command buffer is entirely inside a render pass.
+             * Ignored for primary command buffers. Set implicitly by
+             * @ref CommandBufferBeginInfo(VkRenderPass, UnsignedInt, VkFramebuffer, Flags).
+             */
+            RenderPassContinue = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+
+            /**
+             * The command buffer can be resubmitted to a queue while it's
+             * still pending execution.
+             */
+            SimultaneousUse = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT
+        };
+
+        /**
+         * @brief Command buffer begin flags
+         *
+         * Type-safe wrapper for @type_vk_keyword{CommandBufferUsageFlags}.
+         * @see @ref CommandBufferBeginInfo(Flags)
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param flags     Command buffer begin flags
+         *
+         * The following @type_vk{CommandBufferBeginInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`
+         * -    `pInheritanceInfo` to an internal
+         *      @type_vk{CommandBufferInheritanceInfo} structure with just
+         *      `sType` set. It's ignored for primary command buffers and
+         *      required for secondary command buffers.
+         */
+        explicit CommandBufferBeginInfo(Flags flags = {});
+
+        /**
+         * @brief Construct for a secondary command buffer inside a render pass
+         * @param renderPass    Render pass the secondary command buffer will
+         *      be executed in
+         * @param subpass       Subpass index the secondary command buffer will
+         *      be executed in
+         * @param framebuffer   Framebuffer the secondary command buffer will
+         *      be rendering to. Can be @cpp VK_NULL_HANDLE @ce if not known,
+         *      but specifying it may allow the driver to optimize better.
+         * @param flags         Command buffer begin flags.
+         *      @ref Flag::RenderPassContinue is added implicitly.
+         *
+         * Compared to @ref CommandBufferBeginInfo(Flags), the following
+         * @type_vk{CommandBufferInheritanceInfo} fields are pre-filled in
+         * addition:
+         *
+         * -    `renderPass`
+         * -    `subpass`
+         * -    `framebuffer`
+         */
+        explicit CommandBufferBeginInfo(VkRenderPass renderPass, UnsignedInt subpass, VkFramebuffer framebuffer = {}, Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit CommandBufferBeginInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit CommandBufferBeginInfo(const VkCommandBufferBeginInfo& info);
+
+        /**
+         * @brief Copying is not allowed
+         *
+         * The structure contains a pointer to itself.
+         */
+        CommandBufferBeginInfo(const CommandBufferBeginInfo&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandBufferBeginInfo(CommandBufferBeginInfo&&) = delete;
+
+        /** @brief Copying is not allowed */
+        CommandBufferBeginInfo& operator=(const CommandBufferBeginInfo&) = delete;
+
+        /** @brief Moving is not allowed */
+        CommandBufferBeginInfo& operator=(CommandBufferBeginInfo&&) = delete;
+
+        /** @brief Underlying @type_vk{CommandBufferBeginInfo} structure */
+        VkCommandBufferBeginInfo& operator*() { return _info; }
+        /** @overload */
+        const VkCommandBufferBeginInfo& operator*() const { return _info; }
+        /** @overload */
+        VkCommandBufferBeginInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkCommandBufferBeginInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkCommandBufferBeginInfo*() const { return &_info; }
+
+    private:
+        VkCommandBufferBeginInfo _info;
+        VkCommandBufferInheritanceInfo _inheritanceInfo;
+};
+
+CORRADE_ENUMSET_OPERATORS(CommandBufferBeginInfo::Flags)
+
 /**
 @brief Command buffer
 @m_since_latest
 
 Wraps a @type_vk_keyword{CommandBuffer}. A command buffer instance is usually
 allocated from a @ref CommandPool, see its documentation for usage information.
+
+@section Vk-CommandBuffer-recording Command buffer recording
+
+Recording is delimited by @ref begin() and @ref end(). Secondary command
+buffers that are meant to be executed inside a render pass need to know the
+render pass and subpass they'll be executed in, which is done by passing them
+to @ref CommandBufferBeginInfo. The secondary buffers are then executed from
+a primary one using @ref executeCommands():
+
+@snippet MagnumVk.cpp CommandBuffer-recording-secondary
+
+Recording into different command buffers from multiple threads is possible
+only if each thread allocates its buffers from a different pool. See
+@ref FrameCommandPools for a class managing a set of per-thread pools across
+frames in flight.
 */
 class MAGNUM_VK_EXPORT CommandBuffer {
     public:
@@ -141,6 +293,114 @@ class MAGNUM_VK_EXPORT CommandBuffer {
          */
         void reset(CommandBufferResetFlags flags = {});
 
+        /**
+         * @brief Begin command buffer recording
+         * @return Reference to self (for method chaining)
+         *
+         * @see @fn_vk_keyword{BeginCommandBuffer}
+         */
+        CommandBuffer& begin(const CommandBufferBeginInfo& info = CommandBufferBeginInfo{});
+
+        /**
+         * @brief End command buffer recording
+         *
+         * @see @fn_vk_keyword{EndCommandBuffer}
+         */
+        void end();
+
+        /**
+         * @brief Execute secondary command buffers
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that this is a primary command buffer in recording state
+         * and all @p buffers are secondary command buffers in executable
+         * state. If called inside a render pass, the render pass has to be
+         * begun with @type_vk{SubpassContents} set to
+         * @val_vk{SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS,SubpassContents}
+         * and the secondary buffers recorded with
+         * @ref CommandBufferBeginInfo::Flag::RenderPassContinue.
+         * @see @fn_vk_keyword{CmdExecuteCommands}
+         */
+        CommandBuffer& executeCommands(Containers::ArrayView<const VkCommandBuffer> buffers);
+        /** @overload */
+        CommandBuffer& executeCommands(std::initializer_list<VkCommandBuffer> buffers);
+
+        /**
+         * @brief Bind a pipeline
+         * @return Reference to self (for method chaining)
+         *
+         * Binds @p pipeline to the bind point given by
+         * @ref Pipeline::bindPoint().
+         * @see @fn_vk_keyword{CmdBindPipeline}
+         */
+        CommandBuffer& bindPipeline(Pipeline& pipeline);
+
+        /**
+         * @brief Bind descriptor sets
+         * @param bindPoint         Pipeline bind point
+         * @param layout            Pipeline layout the sets are used with
+         * @param firstSet          Index of the first set to bind
+         * @param descriptorSets    Descriptor sets to bind
+         * @param dynamicOffsets    Offsets for dynamic uniform and storage
+         *      buffer descriptors, in the order of sets and bindings
+         * @return Reference to self (for method chaining)
+         *
+         * @see @fn_vk_keyword{CmdBindDescriptorSets}
+         */
+        CommandBuffer& bindDescriptorSets(PipelineBindPoint bindPoint, VkPipelineLayout layout, UnsignedInt firstSet, Containers::ArrayView<const VkDescriptorSet> descriptorSets, Containers::ArrayView<const UnsignedInt> dynamicOffsets = {});
+        /** @overload */
+        CommandBuffer& bindDescriptorSets(PipelineBindPoint bindPoint, VkPipelineLayout layout, UnsignedInt firstSet, std::initializer_list<VkDescriptorSet> descriptorSets, std::initializer_list<UnsignedInt> dynamicOffsets = {});
+
+        /**
+         * @brief Reset queries in a query pool
+         * @param pool      Query pool
+         * @param first     Index of the first query to reset
+         * @param count     Count of queries to reset
+         * @return Reference to self (for method chaining)
+         *
+         * Has to be called before the queries are used. Expects to be called
+         * outside of a render pass.
+         * @see @fn_vk_keyword{CmdResetQueryPool}
+         */
+        CommandBuffer& resetQueryPool(VkQueryPool pool, UnsignedInt first, UnsignedInt count);
+
+        /**
+         * @brief Begin a query
+         * @param pool      Query pool
+         * @param query     Query index
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the query was reset and that there's no other active
+         * query of the same type in this command buffer. If the query is
+         * begun inside a render pass, it has to end in the same subpass.
+         * @see @ref endQuery(), @fn_vk_keyword{CmdBeginQuery}
+         */
+        CommandBuffer& beginQuery(VkQueryPool pool, UnsignedInt query);
+
+        /**
+         * @brief End a query
+         * @param pool      Query pool
+         * @param query     Query index
+         * @return Reference to self (for method chaining)
+         *
+         * @see @ref beginQuery(), @fn_vk_keyword{CmdEndQuery}
+         */
+        CommandBuffer& endQuery(VkQueryPool pool, UnsignedInt query);
+
+        /**
+         * @brief Write a timestamp
+         * @param stage     Pipeline stage after which the timestamp is
+         *      written
+         * @param pool      Query pool of @ref QueryType::Timestamp
+         * @param query     Query index
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that the query was reset. The timestamp is written once all
+         * previously submitted commands reach @p stage.
+         * @see @fn_vk_keyword{CmdWriteTimestamp}
+         */
+        CommandBuffer& writeTimestamp(PipelineStage stage, VkQueryPool pool, UnsignedInt query);
+
         /**
          * @brief Release the underlying Vulkan command buffer
          *
@@ -0,0 +1,131 @@
+#ifndef Magnum_Vk_DescriptorSet_h
+#define Magnum_Vk_DescriptorSet_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::DescriptorSet
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Descriptor set
+@m_since_latest
+
+Wraps a @type_vk_keyword{DescriptorSet}. A descriptor set instance is usually
+allocated from a @ref DescriptorPool, see its documentation for usage
+information. The set is then bound for use by a pipeline using
+@ref CommandBuffer::bindDescriptorSets().
+*/
+class MAGNUM_VK_EXPORT DescriptorSet {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device    Vulkan device the descriptor set is created on
+         * @param pool      Descriptor pool the set is allocated from
+         * @param handle    The @type_vk{DescriptorSet} handle
+         * @param flags     Handle flags
+         *
+         * The @p handle is expected to be originating from @p device and
+         * @p pool. The Vulkan descriptor set is by default not freed on
+         * destruction, use @p flags for different behavior. Freeing a set
+         * individually is only possible if the pool was created with
+         * @ref DescriptorPoolCreateInfo::Flag::FreeDescriptorSet.
+         * @see @ref release()
+         */
+        static DescriptorSet wrap(Device& device, VkDescriptorPool pool, VkDescriptorSet handle, HandleFlags flags = {});
+
+        /**
+         * @brief Construct without creating the instance
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit DescriptorSet(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        DescriptorSet(const DescriptorSet&) = delete;
+
+        /** @brief Move constructor */
+        DescriptorSet(DescriptorSet&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees associated @type_vk{DescriptorSet} handle if the instance
+         * was created using @ref wrap() with
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{FreeDescriptorSets}, @ref release()
+         */
+        ~DescriptorSet();
+
+        /** @brief Copying is not allowed */
+        DescriptorSet& operator=(const DescriptorSet&) = delete;
+
+        /** @brief Move assignment */
+        DescriptorSet& operator=(DescriptorSet&& other) noexcept;
+
+        /** @brief Underlying @type_vk{DescriptorSet} handle */
+        VkDescriptorSet handle() { return _handle; }
+        /** @overload */
+        operator VkDescriptorSet() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Release the underlying Vulkan descriptor set
+         *
+         * Releases ownership of the Vulkan descriptor set and returns its
+         * handle so @fn_vk{FreeDescriptorSets} is not called on destruction.
+         * The internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkDescriptorSet release();
+
+    private:
+        friend DescriptorPool;
+
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkDescriptorPool _pool;
+        VkDescriptorSet _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DescriptorSetLayout.h"
+#include "DescriptorSetLayoutCreateInfo.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Handle.h"
+
+namespace Magnum { namespace Vk {
+
+DescriptorSetLayoutBinding::DescriptorSetLayoutBinding(const UnsignedInt binding, const DescriptorType descriptorType, const UnsignedInt descriptorCount, const ShaderStages stages, const Flags flags): _binding{}, _flags{flags} {
+    _binding.binding = binding;
+    _binding.descriptorType = VkDescriptorType(descriptorType);
+    _binding.descriptorCount = descriptorCount;
+    /* ~ShaderStages{} has all 32 bits set, while VK_SHADER_STAGE_ALL has the
+       top bit cleared to fit into a signed int */
+    _binding.stageFlags = VkShaderStageFlags(stages) & VK_SHADER_STAGE_ALL;
+}
+
+DescriptorSetLayoutBinding::DescriptorSetLayoutBinding(NoInitT) noexcept {}
+
+DescriptorSetLayoutBinding::DescriptorSetLayoutBinding(const VkDescriptorSetLayoutBinding& binding):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _binding(binding), _flags{} {}
+
+struct DescriptorSetLayoutCreateInfo::State {
+    Containers::Array<VkDescriptorSetLayoutBinding> bindings;
+    Containers::Array<VkDescriptorBindingFlags> bindingFlags;
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo;
+};
+
+DescriptorSetLayoutCreateInfo::DescriptorSetLayoutCreateInfo(const Containers::ArrayView<const DescriptorSetLayoutBinding> bindings, const Flags flags): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    _info.flags = VkDescriptorSetLayoutCreateFlags(flags);
+
+    if(!bindings.empty()) {
+        _state.emplace();
+        _state->bindings = Containers::Array<VkDescriptorSetLayoutBinding>{Containers::NoInit, bindings.size()};
+        for(std::size_t i = 0; i != bindings.size(); ++i)
+            _state->bindings[i] = *bindings[i];
+        _info.bindingCount = _state->bindings.size();
+        _info.pBindings = _state->bindings;
+
+        /* Binding flags are in a separate structure, add it only if any
+           binding has them so the layout can be created on Vulkan 1.0
+           without EXT_descriptor_indexing as well */
+        bool hasFlags = false;
+        for(const DescriptorSetLayoutBinding& binding: bindings) {
+            if(binding.flags()) {
+                hasFlags = true;
+                break;
+            }
+        }
+        if(hasFlags) {
+            _state->bindingFlags = Containers::Array<VkDescriptorBindingFlags>{Containers::NoInit, bindings.size()};
+            for(std::size_t i = 0; i != bindings.size(); ++i)
+                _state->bindingFlags[i] = VkDescriptorBindingFlags(bindings[i].flags());
+            _state->bindingFlagsInfo = {};
+            _state->bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            _state->bindingFlagsInfo.bindingCount = _state->bindingFlags.size();
+            _state->bindingFlagsInfo.pBindingFlags = _state->bindingFlags;
+            _info.pNext = &_state->bindingFlagsInfo;
+        }
+    }
+}
+
+DescriptorSetLayoutCreateInfo::DescriptorSetLayoutCreateInfo(const std::initializer_list<DescriptorSetLayoutBinding> bindings, const Flags flags): DescriptorSetLayoutCreateInfo{Containers::arrayView(bindings), flags} {}
+
+DescriptorSetLayoutCreateInfo::DescriptorSetLayoutCreateInfo(NoInitT) noexcept {}
+
+DescriptorSetLayoutCreateInfo::DescriptorSetLayoutCreateInfo(const VkDescriptorSetLayoutCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+DescriptorSetLayoutCreateInfo::DescriptorSetLayoutCreateInfo(DescriptorSetLayoutCreateInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    /** @todo this is now more like a destructible move, do it more selectively
+        and clear only what's really ours and not external? */
+    other._info.pNext = nullptr;
+    other._info.bindingCount = 0;
+    other._info.pBindings = nullptr;
+}
+
+DescriptorSetLayoutCreateInfo::~DescriptorSetLayoutCreateInfo() = default;
+
+DescriptorSetLayoutCreateInfo& DescriptorSetLayoutCreateInfo::operator=(DescriptorSetLayoutCreateInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+DescriptorSetLayout DescriptorSetLayout::wrap(Device& device, const VkDescriptorSetLayout handle, const HandleFlags flags) {
+    DescriptorSetLayout out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+DescriptorSetLayout::DescriptorSetLayout(Device& device, const DescriptorSetLayoutCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateDescriptorSetLayout(device, info, nullptr, &_handle));
+}
+
+DescriptorSetLayout::DescriptorSetLayout(NoCreateT): _device{}, _handle{} {}
+
+DescriptorSetLayout::DescriptorSetLayout(DescriptorSetLayout&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+DescriptorSetLayout::~DescriptorSetLayout() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyDescriptorSetLayout(*_device, _handle, nullptr);
+}
+
+DescriptorSetLayout& DescriptorSetLayout::operator=(DescriptorSetLayout&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+VkDescriptorSetLayout DescriptorSetLayout::release() {
+    const VkDescriptorSetLayout handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+Debug& operator<<(Debug& debug, const DescriptorType value) {
+    debug << "Vk::DescriptorType" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::DescriptorType::value: return debug << "::" << Debug::nospace << #value;
+        _c(Sampler)
+        _c(CombinedImageSampler)
+        _c(SampledImage)
+        _c(StorageImage)
+        _c(UniformTexelBuffer)
+        _c(StorageTexelBuffer)
+        _c(UniformBuffer)
+        _c(StorageBuffer)
+        _c(UniformBufferDynamic)
+        _c(StorageBufferDynamic)
+        _c(InputAttachment)
+        _c(AccelerationStructure)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Vulkan docs have the values in decimal, so not converting to hex */
+    return debug << "(" << Debug::nospace << Int(value) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,291 @@
+#ifndef Magnum_Vk_DescriptorSetLayoutCreateInfo_h
+#define Magnum_Vk_DescriptorSetLayoutCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::DescriptorSetLayoutBinding, @ref Magnum::Vk::DescriptorSetLayoutCreateInfo
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Shader.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Descriptor set layout binding
+@m_since_latest
+
+Wraps a @type_vk_keyword{DescriptorSetLayoutBinding}. See
+@ref Vk-DescriptorSetLayout-creation "Descriptor set layout creation" for
+usage information.
+*/
+class MAGNUM_VK_EXPORT DescriptorSetLayoutBinding {
+    public:
+        /**
+         * @brief Descriptor set layout binding flag
+         * @m_since_latest
+         *
+         * Wraps @type_vk_keyword{DescriptorBindingFlagBits}.
+         * @see @ref Flags, @ref DescriptorSetLayoutBinding()
+         * @m_enum_values_as_keywords
+         * @requires_vk12 Extension @vk_extension{EXT,descriptor_indexing}
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Descriptors in this binding can be updated after a command
+             * buffer using them was recorded. The layout has to be created
+             * with @ref DescriptorSetLayoutCreateInfo::Flag::UpdateAfterBindPool.
+             * @requires_vk_feature Feature corresponding to the descriptor
+             *      type, such as
+             *      @ref DeviceFeature::DescriptorBindingSampledImageUpdateAfterBind
+             */
+            UpdateAfterBind = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
+
+            /**
+             * Descriptors in this binding that aren't used by any pending
+             * command buffer can be updated while the set is in use.
+             * @requires_vk_feature @ref DeviceFeature::DescriptorBindingUpdateUnusedWhilePending
+             */
+            UpdateUnusedWhilePending = VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT,
+
+            /**
+             * Descriptors in this binding that aren't dynamically used by a
+             * shader don't need to contain valid descriptors.
+             * @requires_vk_feature @ref DeviceFeature::DescriptorBindingPartiallyBound
+             */
+            PartiallyBound = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+
+            /**
+             * The binding has a variable size specified at descriptor set
+             * allocation. Only allowed on the last binding.
+             * @requires_vk_feature @ref DeviceFeature::DescriptorBindingVariableDescriptorCount
+             */
+            VariableDescriptorCount = VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT
+        };
+
+        /**
+         * @brief Descriptor set layout binding flags
+         * @m_since_latest
+         *
+         * Type-safe wrapper for @type_vk_keyword{DescriptorBindingFlags}.
+         * @see @ref DescriptorSetLayoutBinding()
+         * @requires_vk12 Extension @vk_extension{EXT,descriptor_indexing}
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param binding           Binding index
+         * @param descriptorType    Descriptor type
+         * @param descriptorCount   Descriptor count. Arrays of descriptors
+         *      are accessed as an array in the shader.
+         * @param stages            Shader stages accessing the binding. The
+         *      default value means all stages.
+         * @param flags             Binding flags
+         *
+         * The following @type_vk{DescriptorSetLayoutBinding} fields are
+         * pre-filled, everything else is zero-filled:
+         *
+         * -    `binding`
+         * -    `descriptorType`
+         * -    `descriptorCount`
+         * -    `stageFlags` to @p stages, with all bits set translated to
+         *      @val_vk{SHADER_STAGE_ALL,ShaderStageFlagBits}
+         *
+         * The @p flags don't have a corresponding field in
+         * @type_vk{DescriptorSetLayoutBinding}, they're available through
+         * @ref flags() and @ref DescriptorSetLayoutCreateInfo puts them into
+         * a @type_vk_keyword{DescriptorSetLayoutBindingFlagsCreateInfo}
+         * structure if any binding has them non-empty.
+         */
+        /*implicit*/ DescriptorSetLayoutBinding(UnsignedInt binding, DescriptorType descriptorType, UnsignedInt descriptorCount = 1, ShaderStages stages = ~ShaderStages{}, Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that the structure has to be fully initialized afterwards in
+         * order to be usable.
+         */
+        explicit DescriptorSetLayoutBinding(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. The @ref flags() are empty.
+         */
+        explicit DescriptorSetLayoutBinding(const VkDescriptorSetLayoutBinding& binding);
+
+        /** @brief Underlying @type_vk{DescriptorSetLayoutBinding} structure */
+        VkDescriptorSetLayoutBinding& operator*() { return _binding; }
+        /** @overload */
+        const VkDescriptorSetLayoutBinding& operator*() const { return _binding; }
+        /** @overload */
+        VkDescriptorSetLayoutBinding* operator->() { return &_binding; }
+        /** @overload */
+        const VkDescriptorSetLayoutBinding* operator->() const { return &_binding; }
+        /** @overload */
+        operator const VkDescriptorSetLayoutBinding*() const { return &_binding; }
+
+        /**
+         * @brief Binding flags
+         * @m_since_latest
+         */
+        Flags flags() const { return _flags; }
+
+    private:
+        VkDescriptorSetLayoutBinding _binding;
+        Flags _flags;
+};
+
+CORRADE_ENUMSET_OPERATORS(DescriptorSetLayoutBinding::Flags)
+
+/**
+@brief Descriptor set layout creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{DescriptorSetLayoutCreateInfo}. See
+@ref Vk-DescriptorSetLayout-creation "Descriptor set layout creation" for
+usage information.
+*/
+class MAGNUM_VK_EXPORT DescriptorSetLayoutCreateInfo {
+    public:
+        /**
+         * @brief Descriptor set layout creation flag
+         *
+         * Wraps @type_vk_keyword{DescriptorSetLayoutCreateFlagBits}.
+         * @see @ref Flags, @ref DescriptorSetLayoutCreateInfo()
+         * @m_enum_values_as_keywords
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Descriptor sets using this layout have to be allocated from a
+             * pool created with
+             * @ref DescriptorPoolCreateInfo::Flag::UpdateAfterBind.
+             *
+             * @requires_vk12 Extension @vk_extension{EXT,descriptor_indexing}
+             */
+            UpdateAfterBindPool = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT
+        };
+
+        /**
+         * @brief Descriptor set layout creation flags
+         *
+         * Type-safe wrapper for @type_vk_keyword{DescriptorSetLayoutCreateFlags}.
+         * @see @ref DescriptorSetLayoutCreateInfo()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param bindings  Descriptor set layout bindings
+         * @param flags     Descriptor set layout creation flags
+         *
+         * The following @type_vk{DescriptorSetLayoutCreateInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`
+         * -    `bindingCount` and `pBindings` to a copy of @p bindings
+         *
+         * If any of the @p bindings has non-empty
+         * @ref DescriptorSetLayoutBinding::flags(), the `pNext` chain
+         * contains also a @type_vk{DescriptorSetLayoutBindingFlagsCreateInfo}
+         * structure with the following fields pre-filled in addition to
+         * `sType`:
+         * -    `bindingCount` and `pBindingFlags` to flags of all @p bindings
+         */
+        explicit DescriptorSetLayoutCreateInfo(Containers::ArrayView<const DescriptorSetLayoutBinding> bindings, Flags flags = {});
+
+        /** @overload */
+        explicit DescriptorSetLayoutCreateInfo(std::initializer_list<DescriptorSetLayoutBinding> bindings, Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit DescriptorSetLayoutCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit DescriptorSetLayoutCreateInfo(const VkDescriptorSetLayoutCreateInfo& info);
+
+        /** @brief Copying is not allowed */
+        DescriptorSetLayoutCreateInfo(const DescriptorSetLayoutCreateInfo&) = delete;
+
+        /** @brief Move constructor */
+        DescriptorSetLayoutCreateInfo(DescriptorSetLayoutCreateInfo&& other) noexcept;
+
+        ~DescriptorSetLayoutCreateInfo();
+
+        /** @brief Copying is not allowed */
+        DescriptorSetLayoutCreateInfo& operator=(const DescriptorSetLayoutCreateInfo&) = delete;
+
+        /** @brief Move assignment */
+        DescriptorSetLayoutCreateInfo& operator=(DescriptorSetLayoutCreateInfo&& other) noexcept;
+
+        /** @brief Underlying @type_vk{DescriptorSetLayoutCreateInfo} structure */
+        VkDescriptorSetLayoutCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkDescriptorSetLayoutCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkDescriptorSetLayoutCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkDescriptorSetLayoutCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkDescriptorSetLayoutCreateInfo*() const { return &_info; }
+
+    private:
+        VkDescriptorSetLayoutCreateInfo _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(DescriptorSetLayoutCreateInfo::Flags)
+
+}}
+
+/* Make the definition complete -- it doesn't make sense to have a CreateInfo
+   without the corresponding object anyway. */
+#include "Magnum/Vk/DescriptorSetLayout.h"
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef Magnum_Vk_DescriptorType_h
+#define Magnum_Vk_DescriptorType_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Enum @ref Magnum::Vk::DescriptorType
+ * @m_since_latest
+ */
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Descriptor type
+@m_since_latest
+
+Wraps a @type_vk_keyword{DescriptorType}.
+@m_enum_values_as_keywords
+@see @ref DescriptorSetLayoutBinding, @ref DescriptorPoolCreateInfo
+*/
+enum class DescriptorType: Int {
+    /** Sampler */
+    Sampler = VK_DESCRIPTOR_TYPE_SAMPLER,
+
+    /** Combined image and sampler */
+    CombinedImageSampler = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+
+    /** Sampled image */
+    SampledImage = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+
+    /** Storage image */
+    StorageImage = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+
+    /** Uniform texel buffer */
+    UniformTexelBuffer = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,
+
+    /** Storage texel buffer */
+    StorageTexelBuffer = VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,
+
+    /** Uniform buffer */
+    UniformBuffer = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+
+    /** Storage buffer */
+    StorageBuffer = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+
+    /** Uniform buffer with a dynamic offset */
+    UniformBufferDynamic = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+
+    /** Storage buffer with a dynamic offset */
+    StorageBufferDynamic = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
+
+    /** Input attachment */
+    InputAttachment = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,
+
+    /**
+     * Acceleration structure
+     *
+     * @requires_vk_extension Extension @vk_extension{KHR,acceleration_structure}
+     */
+    AccelerationStructure = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR
+};
+
+/**
+@debugoperatorenum{DescriptorType}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, DescriptorType value);
+
+}}
+
+#endif
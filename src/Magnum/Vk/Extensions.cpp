@@ -38,6 +38,7 @@ constexpr InstanceExtension InstanceExtensions[] {
     Extensions::EXT::debug_report{},
     Extensions::EXT::debug_utils{},
     Extensions::EXT::validation_features{},
+    Extensions::KHR::surface{},
 };
 constexpr InstanceExtension InstanceExtensions11[] {
     Extensions::KHR::device_group_creation{},
@@ -76,6 +77,7 @@ constexpr Extension DeviceExtensions[] {
     Extensions::KHR::pipeline_library{},
     Extensions::KHR::ray_query{},
     Extensions::KHR::ray_tracing_pipeline{},
+    Extensions::KHR::swapchain{},
 };
 constexpr Extension DeviceExtensions11[] {
     Extensions::KHR::_16bit_storage{},
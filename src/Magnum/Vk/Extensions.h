@@ -90,11 +90,12 @@ namespace EXT {
     _extension(1,  EXT,debug_utils,                         Vk10, None) // #129
     _extension(2,  EXT,validation_features,                 Vk10, None) // #248
 } namespace KHR {
-    _extension(10, KHR,get_physical_device_properties2,     Vk10, Vk11) // #60
-    _extension(11, KHR,device_group_creation,               Vk10, Vk11) // #71
-    _extension(12, KHR,external_memory_capabilities,        Vk10, Vk11) // #72
-    _extension(13, KHR,external_semaphore_capabilities,     Vk10, Vk11) // #77
-    _extension(14, KHR,external_fence_capabilities,         Vk10, Vk11) // #113
+    _extension(10, KHR,surface,                             Vk10, None) // #1
+    _extension(11, KHR,get_physical_device_properties2,     Vk10, Vk11) // #60
+    _extension(12, KHR,device_group_creation,               Vk10, Vk11) // #71
+    _extension(13, KHR,external_memory_capabilities,        Vk10, Vk11) // #72
+    _extension(14, KHR,external_semaphore_capabilities,     Vk10, Vk11) // #77
+    _extension(15, KHR,external_fence_capabilities,         Vk10, Vk11) // #113
 }
 #undef _extension
 
@@ -125,47 +126,48 @@ namespace EXT {
 } namespace IMG {
     _extension(20, IMG,format_pvrtc,                        Vk10, None) // #55
 } namespace KHR {
-    _extension(30, KHR,sampler_mirror_clamp_to_edge,        Vk10, Vk12) // #15
-    _extension(31, KHR,multiview,                           Vk10, Vk11) // #54
-    _extension(32, KHR,device_group,                        Vk10, Vk11) // #61
-    _extension(33, KHR,shader_draw_parameters,              Vk10, Vk11) // #64
-    _extension(34, KHR,maintenance1,                        Vk10, Vk11) // #70
-    _extension(35, KHR,external_semaphore,                  Vk10, Vk11) // #78
-    _extension(36, KHR,shader_float16_int8,                 Vk10, Vk12) // #83
-   _extension_(37, KHR,16bit_storage,_16bit_storage,        Vk10, Vk11) // #84
-    _extension(38, KHR,descriptor_update_template,          Vk10, Vk11) // #86
-    _extension(39, KHR,external_memory,                     Vk10, Vk11) // #73
-    _extension(40, KHR,imageless_framebuffer,               Vk10, Vk12) // #109
-    _extension(41, KHR,create_renderpass2,                  Vk10, Vk12) // #110
-    _extension(42, KHR,external_fence,                      Vk10, Vk11) // #114
-    _extension(43, KHR,maintenance2,                        Vk10, Vk11) // #118
-    _extension(44, KHR,variable_pointers,                   Vk10, Vk11) // #121
-    _extension(45, KHR,dedicated_allocation,                Vk10, Vk11) // #128
-    _extension(46, KHR,storage_buffer_storage_class,        Vk10, Vk11) // #142
-    _extension(47, KHR,relaxed_block_layout,                Vk10, Vk11) // #145
-    _extension(48, KHR,get_memory_requirements2,            Vk10, Vk11) // #147
-    _extension(49, KHR,image_format_list,                   Vk10, Vk12) // #148
-    _extension(50, KHR,acceleration_structure,              Vk11, None) // #151
-    _extension(51, KHR,sampler_ycbcr_conversion,            Vk10, Vk11) // #157
-    _extension(52, KHR,bind_memory2,                        Vk10, Vk11) // #158
-    _extension(53, KHR,maintenance3,                        Vk10, Vk11) // #169
-    _extension(54, KHR,draw_indirect_count,                 Vk10, Vk12) // #170
-    _extension(55, KHR,shader_subgroup_extended_types,      Vk11, Vk12) // #176
-   _extension_(56, KHR,8bit_storage,_8bit_storage,          Vk10, Vk12) // #178
-    _extension(57, KHR,shader_atomic_int64,                 Vk10, Vk12) // #181
-    _extension(58, KHR,driver_properties,                   Vk10, Vk12) // #197
-    _extension(59, KHR,shader_float_controls,               Vk10, Vk12) // #198
-    _extension(60, KHR,depth_stencil_resolve,               Vk10, Vk12) // #200
-    _extension(61, KHR,timeline_semaphore,                  Vk10, Vk12) // #208
-    _extension(62, KHR,vulkan_memory_model,                 Vk10, Vk12) // #212
-    _extension(63, KHR,spirv_1_4,                           Vk11, Vk12) // #237
-    _extension(64, KHR,separate_depth_stencil_layouts,      Vk10, Vk12) // #242
-    _extension(65, KHR,uniform_buffer_standard_layout,      Vk10, Vk12) // #254
-    _extension(66, KHR,buffer_device_address,               Vk10, Vk12) // #258
-    _extension(67, KHR,deferred_host_operations,            Vk10, None) // #259
-    _extension(68, KHR,pipeline_library,                    Vk10, None) // #291
-    _extension(69, KHR,ray_tracing_pipeline,                Vk11, None) // #348
-    _extension(70, KHR,ray_query,                           Vk11, None) // #349
+    _extension(30, KHR,swapchain,                           Vk10, None) // #2
+    _extension(31, KHR,sampler_mirror_clamp_to_edge,        Vk10, Vk12) // #15
+    _extension(32, KHR,multiview,                           Vk10, Vk11) // #54
+    _extension(33, KHR,device_group,                        Vk10, Vk11) // #61
+    _extension(34, KHR,shader_draw_parameters,              Vk10, Vk11) // #64
+    _extension(35, KHR,maintenance1,                        Vk10, Vk11) // #70
+    _extension(36, KHR,external_semaphore,                  Vk10, Vk11) // #78
+    _extension(37, KHR,shader_float16_int8,                 Vk10, Vk12) // #83
+   _extension_(38, KHR,16bit_storage,_16bit_storage,        Vk10, Vk11) // #84
+    _extension(39, KHR,descriptor_update_template,          Vk10, Vk11) // #86
+    _extension(40, KHR,external_memory,                     Vk10, Vk11) // #73
+    _extension(41, KHR,imageless_framebuffer,               Vk10, Vk12) // #109
+    _extension(42, KHR,create_renderpass2,                  Vk10, Vk12) // #110
+    _extension(43, KHR,external_fence,                      Vk10, Vk11) // #114
+    _extension(44, KHR,maintenance2,                        Vk10, Vk11) // #118
+    _extension(45, KHR,variable_pointers,                   Vk10, Vk11) // #121
+    _extension(46, KHR,dedicated_allocation,                Vk10, Vk11) // #128
+    _extension(47, KHR,storage_buffer_storage_class,        Vk10, Vk11) // #142
+    _extension(48, KHR,relaxed_block_layout,                Vk10, Vk11) // #145
+    _extension(49, KHR,get_memory_requirements2,            Vk10, Vk11) // #147
+    _extension(50, KHR,image_format_list,                   Vk10, Vk12) // #148
+    _extension(51, KHR,acceleration_structure,              Vk11, None) // #151
+    _extension(52, KHR,sampler_ycbcr_conversion,            Vk10, Vk11) // #157
+    _extension(53, KHR,bind_memory2,                        Vk10, Vk11) // #158
+    _extension(54, KHR,maintenance3,                        Vk10, Vk11) // #169
+    _extension(55, KHR,draw_indirect_count,                 Vk10, Vk12) // #170
+    _extension(56, KHR,shader_subgroup_extended_types,      Vk11, Vk12) // #176
+   _extension_(57, KHR,8bit_storage,_8bit_storage,          Vk10, Vk12) // #178
+    _extension(58, KHR,shader_atomic_int64,                 Vk10, Vk12) // #181
+    _extension(59, KHR,driver_properties,                   Vk10, Vk12) // #197
+    _extension(60, KHR,shader_float_controls,               Vk10, Vk12) // #198
+    _extension(61, KHR,depth_stencil_resolve,               Vk10, Vk12) // #200
+    _extension(62, KHR,timeline_semaphore,                  Vk10, Vk12) // #208
+    _extension(63, KHR,vulkan_memory_model,                 Vk10, Vk12) // #212
+    _extension(64, KHR,spirv_1_4,                           Vk11, Vk12) // #237
+    _extension(65, KHR,separate_depth_stencil_layouts,      Vk10, Vk12) // #242
+    _extension(66, KHR,uniform_buffer_standard_layout,      Vk10, Vk12) // #254
+    _extension(67, KHR,buffer_device_address,               Vk10, Vk12) // #258
+    _extension(68, KHR,deferred_host_operations,            Vk10, None) // #259
+    _extension(69, KHR,pipeline_library,                    Vk10, None) // #291
+    _extension(70, KHR,ray_tracing_pipeline,                Vk11, None) // #348
+    _extension(71, KHR,ray_query,                           Vk11, None) // #349
 }
 #undef _extension
 
@@ -0,0 +1,189 @@
+#ifndef Magnum_Vk_Fence_h
+#define Magnum_Vk_Fence_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Fence
+ * @m_since_latest
+ */
+
+#include "Magnum/Tags.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Fence
+@m_since_latest
+
+Wraps a @type_vk_keyword{Fence}, which is used for synchronizing the host with
+work submitted to a @ref Queue.
+
+@section Vk-Fence-creation Fence creation
+
+A fence is created unsignaled by default. Pass
+@ref FenceCreateInfo::Flag::Signaled to create it signaled --- that's useful
+for per-frame fences that are waited on before the first submission happens:
+
+@snippet MagnumVk.cpp Fence-creation
+
+@section Vk-Fence-usage Fence usage
+
+A fence is passed to @ref Queue::submit() and gets signaled once all submitted
+work finishes. Afterwards it has to be @ref reset() before it can be used in
+another submit. With one fence per frame in flight, the host can record frame
+@f$ N + 1 @f$ while the GPU is still executing frame @f$ N @f$ and block only
+once it runs too far ahead:
+
+@snippet MagnumVk.cpp Fence-usage
+
+@see @ref Semaphore
+*/
+class MAGNUM_VK_EXPORT Fence {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device        Vulkan device the fence is created on
+         * @param handle        The @type_vk{Fence} handle
+         * @param flags         Handle flags
+         *
+         * The @p handle is expected to be of an existing Vulkan fence.
+         * Unlike a fence created using a constructor, the Vulkan fence is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static Fence wrap(Device& device, VkFence handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the fence on
+         * @param info      Fence creation info
+         *
+         * @see @fn_vk_keyword{CreateFence}
+         */
+        explicit Fence(Device& device, const FenceCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the fence
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Fence(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        Fence(const Fence&) = delete;
+
+        /** @brief Move constructor */
+        Fence(Fence&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{Fence} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyFence}, @ref release()
+         */
+        ~Fence();
+
+        /** @brief Copying is not allowed */
+        Fence& operator=(const Fence&) = delete;
+
+        /** @brief Move assignment */
+        Fence& operator=(Fence&& other) noexcept;
+
+        /** @brief Underlying @type_vk{Fence} handle */
+        VkFence handle() { return _handle; }
+        /** @overload */
+        operator VkFence() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Whether the fence is signaled
+         *
+         * Doesn't block.
+         * @see @fn_vk_keyword{GetFenceStatus}, @ref wait()
+         */
+        bool isSignaled();
+
+        /**
+         * @brief Reset the fence
+         *
+         * Puts the fence back to unsignaled state so it can be used in
+         * another @ref Queue::submit().
+         * @see @fn_vk_keyword{ResetFences}
+         */
+        void reset();
+
+        /**
+         * @brief Wait for the fence to become signaled
+         * @param timeout   Timeout in nanoseconds
+         * @return @cpp true @ce if the fence was signaled, @cpp false @ce if
+         *      the wait timed out
+         *
+         * With @p timeout set to @cpp 0 @ce the function is equivalent to
+         * @ref isSignaled().
+         * @see @fn_vk_keyword{WaitForFences}
+         */
+        bool wait(UnsignedLong timeout);
+
+        /**
+         * @brief Wait indefinitely for the fence to become signaled
+         *
+         * Equivalent to calling @ref wait(UnsignedLong) with the largest
+         * possible timeout.
+         */
+        void wait();
+
+        /**
+         * @brief Release the underlying Vulkan fence
+         *
+         * Releases ownership of the Vulkan fence and returns its handle so
+         * @fn_vk{DestroyFence} is not called on destruction. The internal
+         * state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkFence release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkFence _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
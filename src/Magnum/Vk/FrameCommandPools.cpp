@@ -0,0 +1,127 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameCommandPools.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+struct ThreadPool {
+    explicit ThreadPool(NoCreateT): pool{NoCreate} {}
+
+    CommandPool pool;
+    /* Buffers allocated from the pool, kept around across resets so they
+       can be handed out again. Not owning the handles, the pool frees them
+       all on destruction. Indexed by CommandBufferLevel. */
+    Containers::Array<VkCommandBuffer> buffers[2];
+    std::size_t usedBufferCount[2]{};
+};
+
+}
+
+struct FrameCommandPools::State {
+    explicit State(Device& device, UnsignedInt threadCount, UnsignedInt frameCount, CommandPoolResetFlags resetFlags): device(device), threadCount{threadCount}, frameCount{frameCount}, resetFlags{resetFlags} {}
+
+    ThreadPool& current(UnsignedInt thread) {
+        return pools[frame*threadCount + thread];
+    }
+
+    Device& device;
+    UnsignedInt threadCount, frameCount, frame{};
+    CommandPoolResetFlags resetFlags;
+    /* Frame-major, so all pools of a frame are next to each other */
+    Containers::Array<ThreadPool> pools;
+};
+
+FrameCommandPools::FrameCommandPools(Device& device, const UnsignedInt queueFamilyIndex, const UnsignedInt threadCount, const UnsignedInt frameCount, const CommandPoolResetFlags resetFlags): _state{Containers::InPlaceInit, device, threadCount, frameCount, resetFlags} {
+    CORRADE_ASSERT(threadCount && frameCount,
+        "Vk::FrameCommandPools: expected non-zero thread and frame count, got" << threadCount << "and" << frameCount, );
+
+    _state->pools = Containers::Array<ThreadPool>{Containers::DirectInit, std::size_t(threadCount)*frameCount, NoCreate};
+    for(ThreadPool& pool: _state->pools)
+        pool.pool = CommandPool{device, CommandPoolCreateInfo{queueFamilyIndex, CommandPoolCreateInfo::Flag::Transient}};
+}
+
+FrameCommandPools::FrameCommandPools(NoCreateT) noexcept {}
+
+FrameCommandPools::FrameCommandPools(FrameCommandPools&&) noexcept = default;
+
+FrameCommandPools::~FrameCommandPools() = default;
+
+FrameCommandPools& FrameCommandPools::operator=(FrameCommandPools&&) noexcept = default;
+
+UnsignedInt FrameCommandPools::threadCount() const {
+    return _state ? _state->threadCount : 0;
+}
+
+UnsignedInt FrameCommandPools::frameCount() const {
+    return _state ? _state->frameCount : 0;
+}
+
+UnsignedInt FrameCommandPools::frame() const {
+    return _state ? _state->frame : 0;
+}
+
+CommandPool& FrameCommandPools::pool(const UnsignedInt thread) {
+    CORRADE_ASSERT(thread < _state->threadCount,
+        "Vk::FrameCommandPools::pool(): index" << thread << "out of range for" << _state->threadCount << "threads", _state->pools[0].pool);
+    return _state->current(thread).pool;
+}
+
+CommandBuffer FrameCommandPools::allocate(const UnsignedInt thread, const CommandBufferLevel level) {
+    CORRADE_ASSERT(thread < _state->threadCount,
+        "Vk::FrameCommandPools::allocate(): index" << thread << "out of range for" << _state->threadCount << "threads", CommandBuffer{NoCreate});
+
+    ThreadPool& pool = _state->current(thread);
+    const std::size_t levelIndex = level == CommandBufferLevel::Secondary ? 1 : 0;
+    Containers::Array<VkCommandBuffer>& buffers = pool.buffers[levelIndex];
+    std::size_t& used = pool.usedBufferCount[levelIndex];
+
+    /* No recycled buffer left, allocate a new one and take over its handle */
+    if(used == buffers.size())
+        arrayAppend(buffers, pool.pool.allocate(level).release());
+
+    return CommandBuffer::wrap(_state->device, pool.pool, buffers[used++]);
+}
+
+void FrameCommandPools::nextFrame() {
+    _state->frame = (_state->frame + 1) % _state->frameCount;
+    for(UnsignedInt thread = 0; thread != _state->threadCount; ++thread) {
+        ThreadPool& pool = _state->current(thread);
+        pool.pool.reset(_state->resetFlags);
+        pool.usedBufferCount[0] = pool.usedBufferCount[1] = 0;
+    }
+}
+
+}}
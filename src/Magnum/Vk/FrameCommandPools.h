@@ -0,0 +1,182 @@
+#ifndef Magnum_Vk_FrameCommandPools_h
+#define Magnum_Vk_FrameCommandPools_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FrameCommandPools
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/CommandPool.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Per-thread command pools for frames in flight
+@m_since_latest
+
+A @ref CommandPool and all command buffers allocated from it can be used only
+from one thread at a time. To record command buffers in parallel, each
+recording thread needs its own pool, and to not overwrite command buffers that
+the GPU is still executing, each frame in flight needs its own set of those.
+This class manages a grid of @ref CommandPool instances, one for each thread
+and each frame in flight, and recycles the command buffers allocated from
+them.
+
+@section Vk-FrameCommandPools-usage Usage
+
+Each worker thread allocates its command buffers using @ref allocate() with
+its own thread index. Because the pools are distinct for each thread index, no
+locking is needed. The buffers stay valid until the same frame slot comes
+around again, at which point @ref nextFrame() resets the whole pool at once
+with @ref CommandPool::reset() --- that's significantly cheaper than resetting
+or freeing each buffer separately --- and the already allocated buffers get
+handed out again from @ref allocate() instead of allocating new ones.
+
+Secondary command buffers recorded by the workers inside a render pass are
+then executed from a primary buffer with @ref CommandBuffer::executeCommands():
+
+@snippet MagnumVk.cpp FrameCommandPools
+
+Calling @ref nextFrame() is expected to happen on a single thread while no
+other thread is recording and only after the GPU finished executing the
+command buffers from the frame slot that's going to be reused, for example by
+waiting on a per-frame @ref Fence.
+*/
+class MAGNUM_VK_EXPORT FrameCommandPools {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device to create the pools on
+         * @param queueFamilyIndex  Queue family index the command buffers
+         *      will be submitted to
+         * @param threadCount       Count of recording threads
+         * @param frameCount        Count of frames in flight
+         * @param resetFlags        Flags passed to @ref CommandPool::reset()
+         *      in @ref nextFrame()
+         *
+         * Expects that both @p threadCount and @p frameCount are non-zero.
+         * Creates @p threadCount times @p frameCount command pools with
+         * @ref CommandPoolCreateInfo::Flag::Transient set. The current frame
+         * index is @cpp 0 @ce.
+         * @see @fn_vk_keyword{CreateCommandPool}
+         */
+        explicit FrameCommandPools(Device& device, UnsignedInt queueFamilyIndex, UnsignedInt threadCount, UnsignedInt frameCount, CommandPoolResetFlags resetFlags = {});
+
+        /**
+         * @brief Construct without creating the pools
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FrameCommandPools(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameCommandPools(const FrameCommandPools&) = delete;
+
+        /** @brief Move constructor */
+        FrameCommandPools(FrameCommandPools&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all pools and implicitly all command buffers allocated
+         * from them.
+         */
+        ~FrameCommandPools();
+
+        /** @brief Copying is not allowed */
+        FrameCommandPools& operator=(const FrameCommandPools&) = delete;
+
+        /** @brief Move assignment */
+        FrameCommandPools& operator=(FrameCommandPools&&) noexcept;
+
+        /** @brief Count of recording threads */
+        UnsignedInt threadCount() const;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const;
+
+        /**
+         * @brief Current frame index
+         *
+         * Always less than @ref frameCount().
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Command pool for given thread in the current frame
+         *
+         * Expects that @p thread is less than @ref threadCount(). The pool
+         * can be used directly for allocating command buffers that should
+         * live only until the pool is reset in @ref nextFrame(), however
+         * buffers allocated this way are not recycled.
+         */
+        CommandPool& pool(UnsignedInt thread);
+
+        /**
+         * @brief Allocate a command buffer for given thread in the current frame
+         *
+         * Expects that @p thread is less than @ref threadCount(). Returns a
+         * buffer that was already allocated from the same pool in a previous
+         * use of the current frame slot, if there's one available for given
+         * @p level, otherwise allocates a new one with
+         * @ref CommandPool::allocate(). The returned instance doesn't own the
+         * handle, the buffer is valid until the pool is destroyed and can be
+         * recorded into until the next @ref nextFrame() call that switches to
+         * the same frame slot.
+         *
+         * Calling this function concurrently from multiple threads is safe as
+         * long as each thread uses a different @p thread index.
+         */
+        CommandBuffer allocate(UnsignedInt thread, CommandBufferLevel level = CommandBufferLevel::Primary);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Switches to the next frame slot, wrapping around after
+         * @ref frameCount(), and resets all pools belonging to it using
+         * @ref CommandPool::reset() with the flags passed in the constructor.
+         * All command buffers allocated in this slot before are put back to
+         * the initial state and will be returned again by @ref allocate().
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
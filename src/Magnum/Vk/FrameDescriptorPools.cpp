@@ -0,0 +1,148 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "FrameDescriptorPools.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+struct ThreadPools {
+    /* Pools are never destroyed, only reset, so the list grows to fit the
+       largest frame seen so far */
+    Containers::Array<DescriptorPool> pools;
+    /* Index of the pool to allocate from, all pools before are exhausted */
+    std::size_t current{};
+    /* Count of sets allocated from the current pool since its last reset */
+    std::size_t currentSetCount{};
+};
+
+}
+
+struct FrameDescriptorPools::State {
+    explicit State(Device& device, UnsignedInt threadCount, UnsignedInt frameCount, UnsignedInt maxSets): device(device), threadCount{threadCount}, frameCount{frameCount}, maxSets{maxSets} {}
+
+    ThreadPools& current(UnsignedInt thread) {
+        return pools[frame*threadCount + thread];
+    }
+
+    void addPool(ThreadPools& pools) {
+        arrayAppend(pools.pools, DescriptorPool{device, DescriptorPoolCreateInfo{maxSets, poolSizes}});
+    }
+
+    Device& device;
+    UnsignedInt threadCount, frameCount, frame{}, maxSets;
+    Containers::Array<std::pair<DescriptorType, UnsignedInt>> poolSizes;
+    /* Frame-major, so all pools of a frame are next to each other */
+    Containers::Array<ThreadPools> pools;
+};
+
+FrameDescriptorPools::FrameDescriptorPools(Device& device, const UnsignedInt threadCount, const UnsignedInt frameCount, const UnsignedInt maxSets, const Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>> poolSizes): _state{Containers::InPlaceInit, device, threadCount, frameCount, maxSets} {
+    CORRADE_ASSERT(threadCount && frameCount,
+        "Vk::FrameDescriptorPools: expected non-zero thread and frame count, got" << threadCount << "and" << frameCount, );
+
+    _state->poolSizes = Containers::Array<std::pair<DescriptorType, UnsignedInt>>{poolSizes.size()};
+    for(std::size_t i = 0; i != poolSizes.size(); ++i)
+        _state->poolSizes[i] = poolSizes[i];
+
+    _state->pools = Containers::Array<ThreadPools>{std::size_t(threadCount)*frameCount};
+    for(ThreadPools& pools: _state->pools)
+        _state->addPool(pools);
+}
+
+FrameDescriptorPools::FrameDescriptorPools(Device& device, const UnsignedInt threadCount, const UnsignedInt frameCount, const UnsignedInt maxSets, const std::initializer_list<std::pair<DescriptorType, UnsignedInt>> poolSizes): FrameDescriptorPools{device, threadCount, frameCount, maxSets, Containers::arrayView(poolSizes)} {}
+
+FrameDescriptorPools::FrameDescriptorPools(NoCreateT) noexcept {}
+
+FrameDescriptorPools::FrameDescriptorPools(FrameDescriptorPools&&) noexcept = default;
+
+FrameDescriptorPools::~FrameDescriptorPools() = default;
+
+FrameDescriptorPools& FrameDescriptorPools::operator=(FrameDescriptorPools&&) noexcept = default;
+
+UnsignedInt FrameDescriptorPools::threadCount() const {
+    return _state ? _state->threadCount : 0;
+}
+
+UnsignedInt FrameDescriptorPools::frameCount() const {
+    return _state ? _state->frameCount : 0;
+}
+
+UnsignedInt FrameDescriptorPools::frame() const {
+    return _state ? _state->frame : 0;
+}
+
+std::size_t FrameDescriptorPools::poolCount(const UnsignedInt thread) const {
+    CORRADE_ASSERT(thread < _state->threadCount,
+        "Vk::FrameDescriptorPools::poolCount(): index" << thread << "out of range for" << _state->threadCount << "threads", {});
+    return _state->pools[_state->frame*_state->threadCount + thread].pools.size();
+}
+
+DescriptorSet FrameDescriptorPools::allocate(const UnsignedInt thread, const VkDescriptorSetLayout layout) {
+    CORRADE_ASSERT(thread < _state->threadCount,
+        "Vk::FrameDescriptorPools::allocate(): index" << thread << "out of range for" << _state->threadCount << "threads", DescriptorSet{NoCreate});
+
+    ThreadPools& pools = _state->current(thread);
+    for(;;) {
+        if(Containers::Optional<DescriptorSet> set = pools.pools[pools.current].tryAllocate(layout)) {
+            ++pools.currentSetCount;
+            return std::move(*set);
+        }
+
+        /* If nothing was allocated from the pool yet, the set doesn't fit
+           into an empty pool and trying with another would loop forever */
+        CORRADE_ASSERT(pools.currentSetCount,
+            "Vk::FrameDescriptorPools::allocate(): the set doesn't fit into an empty pool", DescriptorSet{NoCreate});
+
+        /* The current pool is exhausted, move to the next one and create it
+           if there's none left */
+        pools.currentSetCount = 0;
+        if(++pools.current == pools.pools.size())
+            _state->addPool(pools);
+    }
+}
+
+void FrameDescriptorPools::nextFrame() {
+    _state->frame = (_state->frame + 1) % _state->frameCount;
+    for(UnsignedInt thread = 0; thread != _state->threadCount; ++thread) {
+        ThreadPools& pools = _state->current(thread);
+        /* Reset only the pools that were used since the last reset, the
+           remaining ones are still empty */
+        for(std::size_t i = 0; i <= pools.current; ++i)
+            pools.pools[i].reset();
+        pools.current = 0;
+        pools.currentSetCount = 0;
+    }
+}
+
+}}
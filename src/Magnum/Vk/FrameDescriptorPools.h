@@ -0,0 +1,186 @@
+#ifndef Magnum_Vk_FrameDescriptorPools_h
+#define Magnum_Vk_FrameDescriptorPools_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FrameDescriptorPools
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <utility>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/DescriptorPool.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Per-thread growable descriptor pools for frames in flight
+@m_since_latest
+
+Descriptor sets that change every draw are best allocated from a pool that
+gets reset as a whole once the GPU is done with the frame, instead of
+allocating and freeing each set separately. This class manages a list of
+@ref DescriptorPool instances for each recording thread and each frame in
+flight, in the same way as @ref FrameCommandPools does for command buffers.
+
+@section Vk-FrameDescriptorPools-usage Usage
+
+The constructor takes the count of threads and frames in flight together with
+a size of each pool. Each thread then allocates its descriptor sets using
+@ref allocate() with its own thread index, so no locking is needed. The
+allocation is linear --- when the current pool gets exhausted, the next pool
+of the same thread and frame slot is used, and if there's none, a new one
+with the same size is created. The pools are thus growing to fit the largest
+frame and are never destroyed until the instance itself is.
+
+Once the same frame slot comes around again, @ref nextFrame() resets all its
+pools at once with @ref DescriptorPool::reset(), freeing all descriptor sets
+allocated from them in the previous use of the slot:
+
+@snippet MagnumVk.cpp FrameDescriptorPools
+
+Calling @ref nextFrame() is expected to happen on a single thread while no
+other thread is allocating and only after the GPU finished executing the
+command buffers from the frame slot that's going to be reused, for example by
+waiting on a per-frame @ref Fence.
+*/
+class MAGNUM_VK_EXPORT FrameDescriptorPools {
+    public:
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to create the pools on
+         * @param threadCount   Count of allocating threads
+         * @param frameCount    Count of frames in flight
+         * @param maxSets       Max count of descriptor sets allocated from
+         *      a single pool
+         * @param poolSizes     Count of descriptors of each type in a single
+         *      pool
+         *
+         * Expects that @p threadCount and @p frameCount are non-zero. Creates
+         * one pool for each thread and frame upfront, subsequent pools are
+         * created on demand in @ref allocate(). The @p maxSets and
+         * @p poolSizes are passed to @ref DescriptorPoolCreateInfo, see its
+         * documentation for additional requirements. The current frame index
+         * is @cpp 0 @ce.
+         * @see @fn_vk_keyword{CreateDescriptorPool}
+         */
+        explicit FrameDescriptorPools(Device& device, UnsignedInt threadCount, UnsignedInt frameCount, UnsignedInt maxSets, Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>> poolSizes);
+
+        /** @overload */
+        explicit FrameDescriptorPools(Device& device, UnsignedInt threadCount, UnsignedInt frameCount, UnsignedInt maxSets, std::initializer_list<std::pair<DescriptorType, UnsignedInt>> poolSizes);
+
+        /**
+         * @brief Construct without creating the pools
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FrameDescriptorPools(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameDescriptorPools(const FrameDescriptorPools&) = delete;
+
+        /** @brief Move constructor */
+        FrameDescriptorPools(FrameDescriptorPools&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys all pools and implicitly all descriptor sets allocated
+         * from them.
+         */
+        ~FrameDescriptorPools();
+
+        /** @brief Copying is not allowed */
+        FrameDescriptorPools& operator=(const FrameDescriptorPools&) = delete;
+
+        /** @brief Move assignment */
+        FrameDescriptorPools& operator=(FrameDescriptorPools&&) noexcept;
+
+        /** @brief Count of allocating threads */
+        UnsignedInt threadCount() const;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const;
+
+        /**
+         * @brief Current frame index
+         *
+         * Always less than @ref frameCount().
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Count of pools created for given thread in the current frame
+         *
+         * Expects that @p thread is less than @ref threadCount(). Useful for
+         * tuning the pool size --- ideally there should be just one pool per
+         * thread and frame.
+         */
+        std::size_t poolCount(UnsignedInt thread) const;
+
+        /**
+         * @brief Allocate a descriptor set for given thread in the current frame
+         *
+         * Expects that @p thread is less than @ref threadCount() and that a
+         * set of given @p layout fits into an empty pool. Allocates from the
+         * current pool of given thread, moving to the next pool or creating a
+         * new one if it's exhausted. The returned instance doesn't own the
+         * handle, the set is valid until the next @ref nextFrame() call that
+         * switches to the same frame slot.
+         *
+         * Calling this function concurrently from multiple threads is safe as
+         * long as each thread uses a different @p thread index.
+         * @see @ref DescriptorPool::tryAllocate()
+         */
+        DescriptorSet allocate(UnsignedInt thread, VkDescriptorSetLayout layout);
+
+        /**
+         * @brief Advance to the next frame
+         *
+         * Switches to the next frame slot, wrapping around after
+         * @ref frameCount(), and resets all pools belonging to it using
+         * @ref DescriptorPool::reset(). All descriptor sets allocated in this
+         * slot before are freed.
+         */
+        void nextFrame();
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
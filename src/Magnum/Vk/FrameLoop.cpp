@@ -0,0 +1,176 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "FrameLoop.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Reference.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/Fence.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/FrameCommandPools.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+#include "Magnum/Vk/Swapchain.h"
+
+namespace Magnum { namespace Vk {
+
+struct FrameLoop::State {
+    explicit State(Device& device, Queue& queue, UnsignedInt queueFamilyIndex, Swapchain& swapchain, UnsignedInt frameCount, UnsignedInt threadCount): queue(queue), swapchain(swapchain), pools{device, queueFamilyIndex, threadCount, frameCount} {}
+
+    ~State() {
+        /* Nothing from the frame slots can be destroyed while the GPU still
+           uses it */
+        queue.waitIdle();
+    }
+
+    Queue& queue;
+    Swapchain& swapchain;
+    FrameCommandPools pools;
+    Containers::Array<Fence> fences;
+    Containers::Array<Semaphore> imageAvailable;
+    Containers::Array<Semaphore> renderFinished;
+    /* Frame slot that last rendered to given swapchain image, ~UnsignedInt{}
+       if none */
+    Containers::Array<UnsignedInt> imageFrames;
+    bool started{};
+    Int image{-1};
+};
+
+FrameLoop::FrameLoop(Device& device, Queue& queue, const UnsignedInt queueFamilyIndex, Swapchain& swapchain, const UnsignedInt frameCount, const UnsignedInt threadCount) {
+    CORRADE_ASSERT(frameCount,
+        "Vk::FrameLoop: expected non-zero frame count", );
+
+    _state.emplace(device, queue, queueFamilyIndex, swapchain, frameCount, threadCount);
+    _state->fences = Containers::Array<Fence>{Containers::DirectInit, frameCount, NoCreate};
+    _state->imageAvailable = Containers::Array<Semaphore>{Containers::DirectInit, frameCount, NoCreate};
+    _state->renderFinished = Containers::Array<Semaphore>{Containers::DirectInit, frameCount, NoCreate};
+    for(UnsignedInt i = 0; i != frameCount; ++i) {
+        /* Signaled so the first wait in each slot doesn't block */
+        _state->fences[i] = Fence{device, FenceCreateInfo{FenceCreateInfo::Flag::Signaled}};
+        _state->imageAvailable[i] = Semaphore{device, SemaphoreCreateInfo{}};
+        _state->renderFinished[i] = Semaphore{device, SemaphoreCreateInfo{}};
+    }
+}
+
+FrameLoop::FrameLoop(NoCreateT) noexcept {}
+
+FrameLoop::FrameLoop(FrameLoop&&) noexcept = default;
+
+FrameLoop::~FrameLoop() = default;
+
+FrameLoop& FrameLoop::operator=(FrameLoop&&) noexcept = default;
+
+UnsignedInt FrameLoop::frameCount() const {
+    return _state ? _state->pools.frameCount() : 0;
+}
+
+UnsignedInt FrameLoop::frame() const {
+    return _state ? _state->pools.frame() : 0;
+}
+
+Int FrameLoop::image() const {
+    return _state ? _state->image : -1;
+}
+
+FrameCommandPools& FrameLoop::commandPools() {
+    return _state->pools;
+}
+
+Swapchain& FrameLoop::swapchain() {
+    return _state->swapchain;
+}
+
+Int FrameLoop::beginFrame() {
+    State& state = *_state;
+    CORRADE_ASSERT(state.image == -1,
+        "Vk::FrameLoop::beginFrame(): the previous frame wasn't ended", -1);
+
+    /* Switch to the next frame slot once the GPU is done with it. The very
+       first frame uses the initial slot directly. */
+    if(state.started) {
+        const UnsignedInt next = (state.pools.frame() + 1) % state.pools.frameCount();
+        state.fences[next].wait();
+        state.pools.nextFrame();
+    } else state.started = true;
+    const UnsignedInt frame = state.pools.frame();
+
+    const Int image = state.swapchain.acquire(state.imageAvailable[frame]);
+    if(image == -1) return -1;
+
+    /* The image can be still rendered to from another slot if the swapchain
+       has less images than there are frames in flight or if it hands them
+       out of order */
+    const std::size_t imageCount = state.swapchain.images().size();
+    if(state.imageFrames.size() != imageCount)
+        state.imageFrames = Containers::Array<UnsignedInt>{Containers::DirectInit, imageCount, ~UnsignedInt{}};
+    UnsignedInt& imageFrame = state.imageFrames[image];
+    if(imageFrame != ~UnsignedInt{} && imageFrame != frame)
+        state.fences[imageFrame].wait();
+    imageFrame = frame;
+
+    return state.image = image;
+}
+
+bool FrameLoop::endFrame(const Containers::ArrayView<const VkCommandBuffer> commandBuffers, const PipelineStages waitStages) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.image != -1,
+        "Vk::FrameLoop::endFrame(): no frame in progress", {});
+
+    const UnsignedInt frame = state.pools.frame();
+    SubmitInfo info;
+    info.setWaitSemaphores({state.imageAvailable[frame]}, {waitStages})
+        .setCommandBuffers(commandBuffers)
+        .setSignalSemaphores({state.renderFinished[frame]});
+
+    Fence& fence = state.fences[frame];
+    fence.reset();
+    state.queue.submit({info}, fence);
+
+    const UnsignedInt image = state.image;
+    state.image = -1;
+    return state.swapchain.present(state.queue, image, state.renderFinished[frame]);
+}
+
+bool FrameLoop::endFrame(const std::initializer_list<VkCommandBuffer> commandBuffers, const PipelineStages waitStages) {
+    return endFrame(Containers::arrayView(commandBuffers), waitStages);
+}
+
+bool FrameLoop::recreateSwapchain(const Vector2i& size) {
+    State& state = *_state;
+    CORRADE_ASSERT(state.image == -1,
+        "Vk::FrameLoop::recreateSwapchain(): a frame is in progress", {});
+
+    /* The original images can't be used by anything anymore, including
+       presentation, which the fences don't cover */
+    state.queue.waitIdle();
+    state.imageFrames = nullptr;
+    return state.swapchain.recreate(size);
+}
+
+}}
@@ -0,0 +1,196 @@
+#ifndef Magnum_Vk_FrameLoop_h
+#define Magnum_Vk_FrameLoop_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Vk::FrameLoop
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Frame loop with multiple frames in flight
+@m_since_latest
+
+Drives rendering into a @ref Swapchain with a fixed number of frames in
+flight, so the host can record frame @f$ N + 1 @f$ while the GPU is still
+executing frame @f$ N @f$. Each frame slot has its own @ref Fence, a
+@ref Semaphore signaled once the swapchain image is acquired and a
+@ref Semaphore signaled once rendering finishes, and command buffers are
+allocated from a @ref FrameCommandPools instance with one pool per recording
+thread and frame slot.
+
+@section Vk-FrameLoop-usage Usage
+
+@ref beginFrame() waits until the GPU finished the work previously submitted
+in the next frame slot, recycles its command pools and acquires a swapchain
+image. Command buffers are then allocated from @ref commandPools() and
+recorded, and @ref endFrame() submits them to the queue and presents the
+image. If either of the two report the swapchain as out of date, typically
+after the window got resized, call @ref recreateSwapchain() with the new size:
+
+@snippet MagnumVk.cpp FrameLoop-usage
+
+Low-latency presentation is a matter of creating the @ref Swapchain with
+@ref PresentMode::Mailbox or @ref PresentMode::Immediate. Two frames in flight
+are usually enough, more frames add latency without improving throughput.
+*/
+class MAGNUM_VK_EXPORT FrameLoop {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device
+         * @param queue             Queue to submit to and present on
+         * @param queueFamilyIndex  Family index of @p queue
+         * @param swapchain         Swapchain to present to
+         * @param frameCount        Count of frames in flight
+         * @param threadCount       Count of recording threads passed to
+         *      @ref FrameCommandPools
+         *
+         * Expects that @p frameCount is non-zero. The @p queue and
+         * @p swapchain are expected to outlive the instance. Creates
+         * @p frameCount fences in a signaled state and two semaphores for
+         * each frame.
+         */
+        explicit FrameLoop(Device& device, Queue& queue, UnsignedInt queueFamilyIndex, Swapchain& swapchain, UnsignedInt frameCount = 2, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Construct without creating the frame loop
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit FrameLoop(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        FrameLoop(const FrameLoop&) = delete;
+
+        /** @brief Move constructor */
+        FrameLoop(FrameLoop&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Waits for the queue to become idle so no fence, semaphore or
+         * command buffer is destroyed while still in use.
+         * @see @ref Queue::waitIdle()
+         */
+        ~FrameLoop();
+
+        /** @brief Copying is not allowed */
+        FrameLoop& operator=(const FrameLoop&) = delete;
+
+        /** @brief Move assignment */
+        FrameLoop& operator=(FrameLoop&&) noexcept;
+
+        /** @brief Count of frames in flight */
+        UnsignedInt frameCount() const;
+
+        /**
+         * @brief Current frame slot
+         *
+         * Always less than @ref frameCount().
+         */
+        UnsignedInt frame() const;
+
+        /**
+         * @brief Swapchain image acquired for the current frame
+         *
+         * Index into @ref Swapchain::images(), or @cpp -1 @ce if no frame is
+         * currently in progress.
+         */
+        Int image() const;
+
+        /** @brief Command pools for the current frame */
+        FrameCommandPools& commandPools();
+
+        /** @brief Swapchain */
+        Swapchain& swapchain();
+
+        /**
+         * @brief Begin a frame
+         *
+         * Switches to the next frame slot, waits on its fence and recycles
+         * its command pools with @ref FrameCommandPools::nextFrame(). Then
+         * acquires a swapchain image and, if the image is still being
+         * rendered to in a different frame slot, waits for that one as well.
+         * Returns the acquired image index or @cpp -1 @ce if the swapchain
+         * is out of date, in which case @ref recreateSwapchain() should be
+         * called and the frame started again.
+         * @see @ref Fence::wait(), @ref Swapchain::acquire()
+         */
+        Int beginFrame();
+
+        /**
+         * @brief End a frame
+         * @param commandBuffers    Command buffers to submit
+         * @param waitStages        Pipeline stages that wait for the
+         *      swapchain image to be acquired
+         *
+         * Expects that @ref beginFrame() was successfully called before.
+         * Submits @p commandBuffers to the queue, signaling the frame fence
+         * once they finish, and presents the image after that. The command
+         * buffers are expected to transition the image to
+         * @ref ImageLayout::PresentSource. Returns @cpp false @ce if the
+         * swapchain should be recreated with @ref recreateSwapchain(),
+         * @cpp true @ce otherwise.
+         * @see @ref Queue::submit(), @ref Swapchain::present()
+         */
+        bool endFrame(Containers::ArrayView<const VkCommandBuffer> commandBuffers, PipelineStages waitStages = PipelineStage::ColorAttachmentOutput);
+        /** @overload */
+        bool endFrame(std::initializer_list<VkCommandBuffer> commandBuffers, PipelineStages waitStages = PipelineStage::ColorAttachmentOutput);
+
+        /**
+         * @brief Recreate the swapchain
+         *
+         * Waits for the queue to become idle and calls
+         * @ref Swapchain::recreate(). Returns @cpp false @ce if the new size
+         * is zero, in which case rendering should be paused until the window
+         * gets a non-zero size again. Expects that no frame is in progress.
+         */
+        bool recreateSwapchain(const Vector2i& size);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -69,7 +69,7 @@ Image Image::wrap(Device& device, const VkImage handle, const VkFormat format, c
     return out;
 }
 
-Image::Image(Device& device, const ImageCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _format{info->format}, _dedicatedMemory{NoCreate} {
+Image::Image(Device& device, const ImageCreateInfo& info, NoAllocateT): _device{&device}, _flags{HandleFlag::DestroyOnDestruction}, _format{info->format}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {
     MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateImage(device, info, nullptr, &_handle));
 }
 
@@ -81,9 +81,13 @@ Image::Image(Device& device, const ImageCreateInfo& info, const MemoryFlags memo
     }});
 }
 
-Image::Image(NoCreateT): _device{}, _handle{}, _format{}, _dedicatedMemory{NoCreate} {}
+Image::Image(Device& device, const ImageCreateInfo& info, MemoryAllocator& allocator, const MemoryFlags memoryFlags, const MemoryAllocationStrategy strategy): Image{device, info, NoAllocate} {
+    bindAllocatedMemory(allocator.allocate(memoryRequirements(), memoryFlags, strategy));
+}
+
+Image::Image(NoCreateT): _device{}, _handle{}, _format{}, _dedicatedMemory{NoCreate}, _allocatedMemory{NoCreate} {}
 
-Image::Image(Image&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _format{other._format}, _dedicatedMemory{std::move(other._dedicatedMemory)} {
+Image::Image(Image&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags}, _format{other._format}, _dedicatedMemory{std::move(other._dedicatedMemory)}, _allocatedMemory{std::move(other._allocatedMemory)} {
     other._handle = {};
 }
 
@@ -99,6 +103,7 @@ Image& Image::operator=(Image&& other) noexcept {
     swap(other._flags, _flags);
     swap(other._format, _format);
     swap(other._dedicatedMemory, _dedicatedMemory);
+    swap(other._allocatedMemory, _allocatedMemory);
     return *this;
 }
 
@@ -137,6 +142,21 @@ Memory& Image::dedicatedMemory() {
     return _dedicatedMemory;
 }
 
+void Image::bindAllocatedMemory(MemoryAllocation&& allocation) {
+    bindMemory(allocation.memory(), allocation.offset());
+    _allocatedMemory = std::move(allocation);
+}
+
+bool Image::hasAllocatedMemory() const {
+    return _allocatedMemory.allocator();
+}
+
+MemoryAllocation& Image::allocatedMemory() {
+    CORRADE_ASSERT(_allocatedMemory.allocator(),
+        "Vk::Image::allocatedMemory(): image doesn't have memory from an allocator", _allocatedMemory);
+    return _allocatedMemory;
+}
+
 VkImage Image::release() {
     const VkImage handle = _handle;
     _handle = {};
@@ -32,6 +32,7 @@
 
 #include "Magnum/Magnum.h"
 #include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
@@ -144,6 +145,13 @@ enum class ImageLayout: Int {
      */
     TransferDestination = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 
+    /**
+     * Layout for presenting a swapchain image to a surface. Used as the final
+     * layout of images acquired from a @ref Swapchain.
+     * @requires_vk_extension Extension @vk_extension{KHR,swapchain}
+     */
+    PresentSource = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+
     /** @todo remaining ones from @vk_extension{KHR,maintenance2} (1.1),
         @vk_extension{KHR,separate_depth_stencil_layouts} (1.2) */
 };
@@ -184,6 +192,20 @@ available through @ref dedicatedMemory(). This matches current behavior of the
 above, except that you have more control over choosing and allocating the
 memory.
 
+@subsection Vk-Image-creation-allocator Sub-allocating from a memory allocator
+
+To avoid having a dedicated allocation for each image, pass a
+@ref MemoryAllocator to the
+@ref Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags, MemoryAllocationStrategy)
+constructor. The image then owns a @ref MemoryAllocation sub-range of a larger
+memory block, subsequently accessible through @ref allocatedMemory(), and
+gives it back to the allocator on destruction.
+
+@snippet MagnumVk.cpp Image-creation-allocator
+
+Equivalently, a @ref MemoryAllocation from @ref MemoryAllocator::allocate()
+can be bound using @ref bindAllocatedMemory().
+
 @see @ref Buffer
 */
 class MAGNUM_VK_EXPORT Image {
@@ -235,6 +257,22 @@ class MAGNUM_VK_EXPORT Image {
          */
         explicit Image(Device& device, const ImageCreateInfo& info, MemoryFlags memoryFlags);
 
+        /**
+         * @brief Construct an image with memory from an allocator
+         * @param device        Vulkan device to create the image on
+         * @param info          Image creation info
+         * @param allocator     Memory allocator
+         * @param memoryFlags   Memory allocation flags
+         * @param strategy      Allocation strategy
+         *
+         * Compared to @ref Image(Device&, const ImageCreateInfo&, MemoryFlags)
+         * sub-allocates the memory from @p allocator, which is then available
+         * through @ref allocatedMemory(). The @p allocator is expected to
+         * outlive the image.
+         * @see @ref MemoryAllocator::allocate(), @ref bindAllocatedMemory()
+         */
+        explicit Image(Device& device, const ImageCreateInfo& info, MemoryAllocator& allocator, MemoryFlags memoryFlags, MemoryAllocationStrategy strategy = MemoryAllocationStrategy::General);
+
         /**
          * @brief Construct without creating the image
          *
@@ -322,6 +360,34 @@ class MAGNUM_VK_EXPORT Image {
          */
         Memory& dedicatedMemory();
 
+        /**
+         * @brief Bind image memory from an allocator
+         *
+         * Equivalent to @ref bindMemory() with @ref MemoryAllocation::memory()
+         * and @ref MemoryAllocation::offset(), with the additional effect
+         * that @p allocation ownership transfers to the image and is then
+         * available through @ref allocatedMemory(). Assumes that the
+         * allocation satisfies image memory requirements.
+         */
+        void bindAllocatedMemory(MemoryAllocation&& allocation);
+
+        /**
+         * @brief Whether the image has memory from an allocator
+         *
+         * Returns @cpp true @ce if the image memory was bound using
+         * @ref bindAllocatedMemory(), @cpp false @ce otherwise.
+         * @see @ref allocatedMemory()
+         */
+        bool hasAllocatedMemory() const;
+
+        /**
+         * @brief Image memory from an allocator
+         *
+         * Expects that the image has memory from an allocator.
+         * @see @ref hasAllocatedMemory()
+         */
+        MemoryAllocation& allocatedMemory();
+
         /**
          * @brief Release the underlying Vulkan image
          *
@@ -362,6 +428,7 @@ class MAGNUM_VK_EXPORT Image {
         VkFormat _format;
 
         Memory _dedicatedMemory;
+        MemoryAllocation _allocatedMemory;
 };
 
 }}
@@ -0,0 +1,351 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "ImageStateTracker.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Pipeline.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+constexpr Accesses WriteAccesses =
+    Access::ShaderWrite|
+    Access::ColorAttachmentWrite|
+    Access::DepthStencilAttachmentWrite|
+    Access::TransferWrite|
+    Access::HostWrite|
+    Access::MemoryWrite;
+
+struct TrackedImage {
+    VkImage handle;
+    VkImageAspectFlags aspects;
+    UnsignedInt levelCount, layerCount;
+    /* Offset of the first subresource, level-major */
+    std::size_t offset;
+};
+
+struct Subresource {
+    ImageLayout layout;
+    /* Stages and write accesses of the last write, including layout
+       transitions */
+    PipelineStages writeStages;
+    Accesses writeAccesses;
+    /* Stages that read since the last write, and stages and access types to
+       which the last write was made visible */
+    PipelineStages readStages;
+    PipelineStages visibleStages;
+    Accesses visibleAccesses;
+    /* Index of a barrier in the pending batch, valid only if batch matches
+       the current batch */
+    UnsignedInt barrier;
+    UnsignedInt batch;
+};
+
+bool sameState(const Subresource& a, const Subresource& b) {
+    return a.layout == b.layout &&
+        a.writeStages == b.writeStages &&
+        a.writeAccesses == b.writeAccesses &&
+        a.readStages == b.readStages &&
+        a.visibleStages == b.visibleStages &&
+        a.visibleAccesses == b.visibleAccesses;
+}
+
+}
+
+struct ImageStateTracker::State {
+    explicit State(Device& device): device(device) {}
+
+    Device& device;
+    Containers::Array<TrackedImage> images;
+    Containers::Array<Subresource> subresources;
+
+    Containers::Array<VkImageMemoryBarrier> barriers;
+    PipelineStages sourceStages, destinationStages;
+    /* Starting from 1 so zero-initialized subresources aren't pending */
+    UnsignedInt batch{1};
+};
+
+ImageStateTracker::ImageStateTracker(Device& device): _state{Containers::InPlaceInit, device} {}
+
+ImageStateTracker::ImageStateTracker(NoCreateT) noexcept {}
+
+ImageStateTracker::ImageStateTracker(ImageStateTracker&&) noexcept = default;
+
+ImageStateTracker::~ImageStateTracker() = default;
+
+ImageStateTracker& ImageStateTracker::operator=(ImageStateTracker&&) noexcept = default;
+
+UnsignedInt ImageStateTracker::imageCount() const {
+    return _state ? UnsignedInt(_state->images.size()) : 0;
+}
+
+UnsignedInt ImageStateTracker::addImage(const VkImage image, const VkImageAspectFlags aspects, const UnsignedInt levelCount, const UnsignedInt layerCount, const ImageLayout layout) {
+    CORRADE_ASSERT(levelCount && layerCount,
+        "Vk::ImageStateTracker::addImage(): expected non-zero level and layer count, got" << levelCount << "and" << layerCount, {});
+
+    State& state = *_state;
+    const std::size_t offset = state.subresources.size();
+    arrayAppend(state.images, TrackedImage{image, aspects, levelCount, layerCount, offset});
+    Subresource subresource{};
+    subresource.layout = layout;
+    for(std::size_t i = 0, count = std::size_t(levelCount)*layerCount; i != count; ++i)
+        arrayAppend(state.subresources, subresource);
+    return state.images.size() - 1;
+}
+
+ImageLayout ImageStateTracker::layout(const UnsignedInt id, const UnsignedInt level, const UnsignedInt layer) const {
+    const State& state = *_state;
+    CORRADE_ASSERT(id < state.images.size(),
+        "Vk::ImageStateTracker::layout(): index" << id << "out of range for" << state.images.size() << "images", {});
+    const TrackedImage& image = state.images[id];
+    CORRADE_ASSERT(level < image.levelCount && layer < image.layerCount,
+        "Vk::ImageStateTracker::layout(): level" << level << "and layer" << layer << "out of range for an image with" << image.levelCount << "levels and" << image.layerCount << "layers", {});
+    return state.subresources[image.offset + level*image.layerCount + layer].layout;
+}
+
+ImageStateTracker& ImageStateTracker::use(const UnsignedInt id, const UnsignedInt level, const UnsignedInt levelCount, const UnsignedInt layer, const UnsignedInt layerCount, const ImageLayout layout, const PipelineStages stages, const Accesses accesses) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.images.size(),
+        "Vk::ImageStateTracker::use(): index" << id << "out of range for" << state.images.size() << "images", *this);
+    const TrackedImage& image = state.images[id];
+    CORRADE_ASSERT(levelCount && layerCount && level + levelCount <= image.levelCount && layer + layerCount <= image.layerCount,
+        "Vk::ImageStateTracker::use(): levels" << level << Debug::nospace << ":" << Debug::nospace << level + levelCount << "and layers" << layer << Debug::nospace << ":" << Debug::nospace << layer + layerCount << "out of range for an image with" << image.levelCount << "levels and" << image.layerCount << "layers", *this);
+    CORRADE_ASSERT(layout != ImageLayout::Undefined && layout != ImageLayout::Preinitialized,
+        "Vk::ImageStateTracker::use(): can't transition to" << layout, *this);
+    CORRADE_ASSERT(stages,
+        "Vk::ImageStateTracker::use(): expected at least one stage", *this);
+
+    const bool write = !!(accesses & WriteAccesses);
+
+    /* Decides what barrier, if any, is needed to go from given state to the
+       new use and updates the state. Returns false if no barrier is
+       needed. */
+    auto transition = [&](Subresource& s, ImageLayout& oldLayout, PipelineStages& srcStages, Accesses& srcAccesses) {
+        oldLayout = s.layout;
+        const bool changesLayout = s.layout != layout;
+
+        /* A layout transition is a write, so it's treated the same as a
+           write access */
+        if(changesLayout || write) {
+            /* Nothing accessed the contents yet, nothing to wait for */
+            if(!changesLayout && !s.writeStages && !s.readStages) {
+                srcStages = {};
+                srcAccesses = {};
+            } else {
+                srcStages = s.writeStages|s.readStages;
+                srcAccesses = s.writeAccesses;
+            }
+
+            s.layout = layout;
+            s.writeStages = stages;
+            s.writeAccesses = accesses & WriteAccesses;
+            /* The barrier itself makes the transition visible to the
+               reads it's done for */
+            s.readStages = write ? PipelineStages{} : stages;
+            s.visibleStages = write ? PipelineStages{} : stages;
+            s.visibleAccesses = write ? Accesses{} : accesses;
+            return changesLayout || !!srcStages;
+        }
+
+        /* A read after a read in the same layout or a read of a write that's
+           already visible to these stages doesn't need anything */
+        s.readStages |= stages;
+        if(!s.writeStages || (!(stages & ~s.visibleStages) && !(accesses & ~s.visibleAccesses)))
+            return false;
+
+        srcStages = s.writeStages;
+        srcAccesses = s.writeAccesses;
+        s.visibleStages |= stages;
+        s.visibleAccesses |= accesses;
+        return true;
+    };
+
+    auto appendBarrier = [&](const ImageLayout oldLayout, const PipelineStages srcStages, const Accesses srcAccesses, const UnsignedInt barrierLevel, const UnsignedInt barrierLevelCount, const UnsignedInt barrierLayer, const UnsignedInt barrierLayerCount) {
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VkAccessFlags(srcAccesses);
+        barrier.dstAccessMask = VkAccessFlags(accesses);
+        barrier.oldLayout = VkImageLayout(oldLayout);
+        barrier.newLayout = VkImageLayout(layout);
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = image.handle;
+        barrier.subresourceRange.aspectMask = image.aspects;
+        barrier.subresourceRange.baseMipLevel = barrierLevel;
+        barrier.subresourceRange.levelCount = barrierLevelCount;
+        barrier.subresourceRange.baseArrayLayer = barrierLayer;
+        barrier.subresourceRange.layerCount = barrierLayerCount;
+        arrayAppend(state.barriers, barrier);
+
+        state.sourceStages |= srcStages ? srcStages : PipelineStage::TopOfPipe;
+        state.destinationStages |= stages;
+        return UnsignedInt(state.barriers.size() - 1);
+    };
+
+    /* Common case first --- if all subresources in the range are in the same
+       state and not used in this batch yet, a single barrier covers them
+       all */
+    Subresource& first = state.subresources[image.offset + level*image.layerCount + layer];
+    bool uniform = true;
+    for(UnsignedInt l = level; uniform && l != level + levelCount; ++l) {
+        for(UnsignedInt i = layer; i != layer + layerCount; ++i) {
+            const Subresource& s = state.subresources[image.offset + l*image.layerCount + i];
+            if(s.batch == state.batch || !sameState(s, first)) {
+                uniform = false;
+                break;
+            }
+        }
+    }
+    if(uniform) {
+        ImageLayout oldLayout;
+        PipelineStages srcStages;
+        Accesses srcAccesses;
+        Subresource updated = first;
+        updated.barrier = ~UnsignedInt{};
+        if(transition(updated, oldLayout, srcStages, srcAccesses))
+            updated.barrier = appendBarrier(oldLayout, srcStages, srcAccesses, level, levelCount, layer, layerCount);
+        updated.batch = state.batch;
+        for(UnsignedInt l = level; l != level + levelCount; ++l)
+            for(UnsignedInt i = layer; i != layer + layerCount; ++i)
+                state.subresources[image.offset + l*image.layerCount + i] = updated;
+        return *this;
+    }
+
+    /* Otherwise go subresource by subresource, merging runs of consecutive
+       layers that need the same barrier */
+    for(UnsignedInt l = level; l != level + levelCount; ++l) {
+        UnsignedInt run = ~UnsignedInt{};
+        for(UnsignedInt i = layer; i != layer + layerCount; ++i) {
+            Subresource& s = state.subresources[image.offset + l*image.layerCount + i];
+
+            /* Already used in this batch. The previous use has to be
+               compatible with this one and if it needed a barrier, the
+               barrier gets extended for this use as well. */
+            if(s.batch == state.batch) {
+                CORRADE_ASSERT(s.layout == layout && !write && !s.writeAccesses,
+                    "Vk::ImageStateTracker::use(): level" << l << "layer" << i << "of image" << id << "already used with" << s.layout << "and" << s.writeAccesses << "in this batch, flush() first", *this);
+                if(s.barrier != ~UnsignedInt{}) {
+                    state.barriers[s.barrier].dstAccessMask |= VkAccessFlags(accesses);
+                    state.destinationStages |= stages;
+                    s.readStages |= stages;
+                    s.visibleStages |= stages;
+                    s.visibleAccesses |= accesses;
+                    run = ~UnsignedInt{};
+                    continue;
+                }
+            }
+
+            ImageLayout oldLayout;
+            PipelineStages srcStages;
+            Accesses srcAccesses;
+            s.batch = state.batch;
+            s.barrier = ~UnsignedInt{};
+            if(!transition(s, oldLayout, srcStages, srcAccesses)) {
+                run = ~UnsignedInt{};
+                continue;
+            }
+
+            /* Extend the barrier for the previous layer if it's the same */
+            if(run != ~UnsignedInt{}) {
+                VkImageMemoryBarrier& previous = state.barriers[run];
+                if(previous.oldLayout == VkImageLayout(oldLayout) && previous.srcAccessMask == VkAccessFlags(srcAccesses)) {
+                    ++previous.subresourceRange.layerCount;
+                    state.sourceStages |= srcStages ? srcStages : PipelineStage::TopOfPipe;
+                    s.barrier = run;
+                    continue;
+                }
+            }
+
+            run = s.barrier = appendBarrier(oldLayout, srcStages, srcAccesses, l, 1, i, 1);
+        }
+    }
+
+    return *this;
+}
+
+ImageStateTracker& ImageStateTracker::use(const UnsignedInt id, const ImageLayout layout, const PipelineStages stages, const Accesses accesses) {
+    CORRADE_ASSERT(id < _state->images.size(),
+        "Vk::ImageStateTracker::use(): index" << id << "out of range for" << _state->images.size() << "images", *this);
+    const TrackedImage& image = _state->images[id];
+    return use(id, 0, image.levelCount, 0, image.layerCount, layout, stages, accesses);
+}
+
+ImageStateTracker& ImageStateTracker::setState(const UnsignedInt id, const ImageLayout layout, const PipelineStages stages, const Accesses accesses) {
+    State& state = *_state;
+    CORRADE_ASSERT(id < state.images.size(),
+        "Vk::ImageStateTracker::setState(): index" << id << "out of range for" << state.images.size() << "images", *this);
+    const TrackedImage& image = state.images[id];
+
+    Subresource subresource{};
+    subresource.layout = layout;
+    subresource.writeStages = stages;
+    subresource.writeAccesses = accesses & WriteAccesses;
+    if(!(accesses & WriteAccesses)) {
+        subresource.readStages = stages;
+        subresource.visibleStages = stages;
+        subresource.visibleAccesses = accesses;
+    }
+    for(std::size_t i = image.offset, end = image.offset + std::size_t(image.levelCount)*image.layerCount; i != end; ++i) {
+        CORRADE_ASSERT(state.subresources[i].batch != state.batch,
+            "Vk::ImageStateTracker::setState(): image" << id << "is used in the pending batch, flush() first", *this);
+        state.subresources[i] = subresource;
+    }
+
+    return *this;
+}
+
+Containers::ArrayView<const VkImageMemoryBarrier> ImageStateTracker::pendingBarriers() const {
+    return _state->barriers;
+}
+
+PipelineStages ImageStateTracker::pendingSourceStages() const {
+    return _state->sourceStages;
+}
+
+PipelineStages ImageStateTracker::pendingDestinationStages() const {
+    return _state->destinationStages;
+}
+
+void ImageStateTracker::flush(CommandBuffer& commandBuffer) {
+    State& state = *_state;
+
+    if(!state.barriers.empty())
+        state.device->CmdPipelineBarrier(commandBuffer, VkPipelineStageFlags(state.sourceStages), VkPipelineStageFlags(state.destinationStages), 0, 0, nullptr, 0, nullptr, state.barriers.size(), state.barriers.data());
+
+    /* Keep the allocation for the next batch */
+    arrayResize(state.barriers, 0);
+    state.sourceStages = {};
+    state.destinationStages = {};
+    ++state.batch;
+}
+
+}}
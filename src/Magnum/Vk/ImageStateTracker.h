@@ -0,0 +1,225 @@
+#ifndef Magnum_Vk_ImageStateTracker_h
+#define Magnum_Vk_ImageStateTracker_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::ImageStateTracker
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Image layout and access tracker
+@m_since_latest
+
+Remembers the layout and the last access of each mip level and array layer of
+registered images and, when an image is used in a different way, computes the
+minimal set of @type_vk{ImageMemoryBarrier} structures needed for that use
+instead of conservative full pipeline stalls. Barriers for all uses declared
+between two pass boundaries are then merged into a single
+@fn_vk_keyword{CmdPipelineBarrier} call:
+
+@snippet MagnumVk.cpp ImageStateTracker-usage
+
+@section Vk-ImageStateTracker-rules Barrier rules
+
+For each subresource, a barrier is emitted in the following cases:
+
+-   When the layout changes. The source stages are all stages that accessed
+    the subresource since the last write and the source access is the last
+    write, if any. Layout transitions from @ref ImageLayout::Undefined don't
+    preserve the image contents.
+-   For a write in the same layout after a previous access --- with a
+    memory dependency on the previous write, or just an execution dependency
+    if the subresource was only read since.
+-   For a read in the same layout after a write, unless the write was
+    already made visible to the same stages and access types by an earlier
+    barrier.
+
+Reads following reads in the same layout don't need any barrier. Uses of the
+same subresource between two calls to @ref flush() are merged into a single
+barrier, which means they're expected to be reads in the same layout --- a
+layout change or a write after a use in the same batch needs a @ref flush()
+in between.
+
+@section Vk-ImageStateTracker-external External layout changes
+
+If the image layout is changed outside of the tracker, such as by a render
+pass with a @ref AttachmentDescription final layout or by a
+@ref StagingUploader, use @ref setState() to update the tracked state
+without recording any barrier.
+*/
+class MAGNUM_VK_EXPORT ImageStateTracker {
+    public:
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device
+         *
+         * The tracker has no images registered initially, use
+         * @ref addImage() to add them.
+         */
+        explicit ImageStateTracker(Device& device);
+
+        /**
+         * @brief Construct without creating the internal state
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit ImageStateTracker(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        ImageStateTracker(const ImageStateTracker&) = delete;
+
+        /** @brief Move constructor */
+        ImageStateTracker(ImageStateTracker&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Barriers that weren't flushed are discarded.
+         */
+        ~ImageStateTracker();
+
+        /** @brief Copying is not allowed */
+        ImageStateTracker& operator=(const ImageStateTracker&) = delete;
+
+        /** @brief Move assignment */
+        ImageStateTracker& operator=(ImageStateTracker&&) noexcept;
+
+        /** @brief Count of registered images */
+        UnsignedInt imageCount() const;
+
+        /**
+         * @brief Register an image
+         * @param image         Image handle
+         * @param aspects       Image aspects to transition, such as
+         *      @val_vk{IMAGE_ASPECT_COLOR_BIT,ImageAspectFlagBits}
+         * @param levelCount    Mip level count
+         * @param layerCount    Array layer count
+         * @param layout        Layout the image is currently in
+         * @return ID of the image, to be used in subsequent calls
+         *
+         * Expects that @p levelCount and @p layerCount are both non-zero.
+         * All subresources are assumed to not have been accessed yet. The
+         * image is expected to stay alive for as long as barriers for it are
+         * recorded.
+         */
+        UnsignedInt addImage(VkImage image, VkImageAspectFlags aspects, UnsignedInt levelCount, UnsignedInt layerCount = 1, ImageLayout layout = ImageLayout::Undefined);
+
+        /**
+         * @brief Image layout
+         *
+         * Layout of given subresource after all barriers recorded so far.
+         * Expects that @p id, @p level and @p layer are in bounds.
+         */
+        ImageLayout layout(UnsignedInt id, UnsignedInt level = 0, UnsignedInt layer = 0) const;
+
+        /**
+         * @brief Declare an image use
+         * @param id            Image ID
+         * @param level         First mip level
+         * @param levelCount    Mip level count
+         * @param layer         First array layer
+         * @param layerCount    Array layer count
+         * @param layout        Layout the subresources need to be in
+         * @param stages        Pipeline stages that access the subresources
+         * @param accesses      Access types
+         * @return Reference to self (for method chaining)
+         *
+         * Appends barriers needed for the use, if any, to the pending batch
+         * submitted with @ref flush(). Expects that the subresource range is
+         * in bounds, @p layout is neither @ref ImageLayout::Undefined nor
+         * @ref ImageLayout::Preinitialized and @p stages is non-empty. See
+         * @ref Vk-ImageStateTracker-rules for details.
+         */
+        ImageStateTracker& use(UnsignedInt id, UnsignedInt level, UnsignedInt levelCount, UnsignedInt layer, UnsignedInt layerCount, ImageLayout layout, PipelineStages stages, Accesses accesses);
+
+        /**
+         * @brief Declare a use of all image subresources
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref use(UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt, UnsignedInt, ImageLayout, PipelineStages, Accesses)
+         * with all mip levels and array layers of the image.
+         */
+        ImageStateTracker& use(UnsignedInt id, ImageLayout layout, PipelineStages stages, Accesses accesses);
+
+        /**
+         * @brief Set image state without a barrier
+         * @return Reference to self (for method chaining)
+         *
+         * Records that all subresources of the image were transitioned to
+         * @p layout and written by @p stages with @p accesses outside of the
+         * tracker. Expects that the image isn't used in the pending batch.
+         */
+        ImageStateTracker& setState(UnsignedInt id, ImageLayout layout, PipelineStages stages, Accesses accesses);
+
+        /** @brief Barriers waiting for the next @ref flush() */
+        Containers::ArrayView<const VkImageMemoryBarrier> pendingBarriers() const;
+
+        /**
+         * @brief Source stages of the pending barriers
+         *
+         * Union of all stages the pending barriers wait for. If there are
+         * pending barriers but none of them waits for a previous access,
+         * contains just @ref PipelineStage::TopOfPipe.
+         */
+        PipelineStages pendingSourceStages() const;
+
+        /** @brief Destination stages of the pending barriers */
+        PipelineStages pendingDestinationStages() const;
+
+        /**
+         * @brief Record pending barriers
+         *
+         * If there are any pending barriers, records all of them into
+         * @p commandBuffer with a single @fn_vk_keyword{CmdPipelineBarrier}
+         * call, with source and destination stages being
+         * @ref pendingSourceStages() and @ref pendingDestinationStages().
+         * Otherwise does nothing. The @p commandBuffer is expected to be in a
+         * recording state and outside of a render pass.
+         */
+        void flush(CommandBuffer& commandBuffer);
+
+    private:
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
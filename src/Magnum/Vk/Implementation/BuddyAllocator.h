@@ -0,0 +1,139 @@
+#ifndef Magnum_Vk_Implementation_BuddyAllocator_h
+#define Magnum_Vk_Implementation_BuddyAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Magnum.h"
+
+namespace Magnum { namespace Vk { namespace Implementation {
+
+/* A binary buddy allocator operating on offsets into a memory block. Level 0
+   is the whole block, each next level halves the node size down to the
+   minimal node size. Free nodes of each level are kept in an unordered list,
+   the caller is responsible for remembering the node size of each allocation
+   in order to free it again. Header-only so it can be tested without a
+   Vulkan device. */
+class BuddyAllocator {
+    public:
+        /* Both size and minNodeSize are expected to be powers of two */
+        explicit BuddyAllocator(UnsignedLong size, UnsignedLong minNodeSize): _size{size}, _minNodeSize{minNodeSize}, _usedSize{} {
+            CORRADE_INTERNAL_ASSERT(size >= minNodeSize && minNodeSize && !(size & (size - 1)) && !(minNodeSize & (minNodeSize - 1)));
+            std::size_t levelCount = 1;
+            for(UnsignedLong nodeSize = size; nodeSize > minNodeSize; nodeSize >>= 1)
+                ++levelCount;
+            _freeNodes = Containers::Array<Containers::Array<UnsignedLong>>{levelCount};
+            arrayAppend(_freeNodes[0], UnsignedLong{});
+        }
+
+        UnsignedLong size() const { return _size; }
+        UnsignedLong usedSize() const { return _usedSize; }
+        bool isEmpty() const { return !_usedSize; }
+
+        /* Node size needed for an allocation of given size and alignment.
+           Nodes are always aligned to their size, so the alignment is
+           satisfied by making the node large enough. */
+        UnsignedLong nodeSize(UnsignedLong size, UnsignedLong alignment) const {
+            UnsignedLong nodeSize = _minNodeSize;
+            while(nodeSize < size || nodeSize < alignment) nodeSize <<= 1;
+            return nodeSize;
+        }
+
+        /* Returns ~UnsignedLong{} if there's no node of given size left */
+        UnsignedLong allocate(UnsignedLong nodeSize) {
+            if(nodeSize > _size) return ~UnsignedLong{};
+
+            /* Find the smallest free node that's large enough */
+            const std::size_t level = levelFor(nodeSize);
+            std::size_t found = level + 1;
+            while(found && _freeNodes[found - 1].isEmpty()) --found;
+            if(!found) return ~UnsignedLong{};
+            --found;
+
+            Containers::Array<UnsignedLong>& freeNodes = _freeNodes[found];
+            const UnsignedLong offset = freeNodes[freeNodes.size() - 1];
+            arrayRemoveSuffix(freeNodes);
+
+            /* Split it down to the desired level, the upper halves become
+               free nodes of each level */
+            for(std::size_t i = found + 1; i <= level; ++i)
+                arrayAppend(_freeNodes[i], offset + (_size >> i));
+
+            _usedSize += nodeSize;
+            return offset;
+        }
+
+        void free(UnsignedLong offset, UnsignedLong nodeSize) {
+            CORRADE_INTERNAL_ASSERT(_usedSize >= nodeSize);
+            _usedSize -= nodeSize;
+
+            /* Merge with the buddy for as long as it's free */
+            std::size_t level = levelFor(nodeSize);
+            while(level) {
+                const UnsignedLong levelSize = _size >> level;
+                const UnsignedLong buddy = offset ^ levelSize;
+                Containers::Array<UnsignedLong>& freeNodes = _freeNodes[level];
+                std::size_t i = 0;
+                while(i != freeNodes.size() && freeNodes[i] != buddy) ++i;
+                if(i == freeNodes.size()) break;
+
+                freeNodes[i] = freeNodes[freeNodes.size() - 1];
+                arrayRemoveSuffix(freeNodes);
+                offset &= ~levelSize;
+                --level;
+            }
+
+            arrayAppend(_freeNodes[level], offset);
+        }
+
+        UnsignedLong largestFreeSize() const {
+            for(std::size_t i = 0; i != _freeNodes.size(); ++i)
+                if(!_freeNodes[i].isEmpty()) return _size >> i;
+            return 0;
+        }
+
+        std::size_t freeNodeCount() const {
+            std::size_t count = 0;
+            for(const Containers::Array<UnsignedLong>& freeNodes: _freeNodes)
+                count += freeNodes.size();
+            return count;
+        }
+
+    private:
+        std::size_t levelFor(UnsignedLong nodeSize) const {
+            std::size_t level = 0;
+            while((_size >> level) > nodeSize) ++level;
+            return level;
+        }
+
+        UnsignedLong _size, _minNodeSize, _usedSize;
+        Containers::Array<Containers::Array<UnsignedLong>> _freeNodes;
+};
+
+}}}
+
+#endif
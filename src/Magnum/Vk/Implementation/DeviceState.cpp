@@ -30,6 +30,7 @@
 #include "Magnum/Vk/Extensions.h"
 #include "Magnum/Vk/Image.h"
 #include "Magnum/Vk/RenderPass.h"
+#include "Magnum/Vk/Semaphore.h"
 #include "Magnum/Vk/Version.h"
 
 namespace Magnum { namespace Vk { namespace Implementation {
@@ -70,6 +71,18 @@ DeviceState::DeviceState(Device& device) {
     } else {
         createRenderPassImplementation = &RenderPass::createImplementationDefault;
     }
+
+    /* Timeline semaphores have no fallback, if neither is available the KHR
+       entrypoints are null and any use is a user error */
+    if(device.isVersionSupported(Version::Vk12)) {
+        getSemaphoreValueImplementation = &Semaphore::getValueImplementation12;
+        signalSemaphoreImplementation = &Semaphore::signalImplementation12;
+        waitSemaphoresImplementation = &Semaphore::waitImplementation12;
+    } else {
+        getSemaphoreValueImplementation = &Semaphore::getValueImplementationKHR;
+        signalSemaphoreImplementation = &Semaphore::signalImplementationKHR;
+        waitSemaphoresImplementation = &Semaphore::waitImplementationKHR;
+    }
 }
 
 }}}
@@ -46,6 +46,9 @@ struct DeviceState {
     VkResult(*bindBufferMemoryImplementation)(Device&, UnsignedInt, const VkBindBufferMemoryInfo*);
     VkResult(*bindImageMemoryImplementation)(Device&, UnsignedInt, const VkBindImageMemoryInfo*);
     VkResult(*createRenderPassImplementation)(Device&, const RenderPassCreateInfo&, const VkAllocationCallbacks*, VkRenderPass*);
+    VkResult(*getSemaphoreValueImplementation)(Device&, VkSemaphore, UnsignedLong*);
+    VkResult(*signalSemaphoreImplementation)(Device&, const VkSemaphoreSignalInfo&);
+    VkResult(*waitSemaphoresImplementation)(Device&, const VkSemaphoreWaitInfo&, UnsignedLong);
 };
 
 }}}
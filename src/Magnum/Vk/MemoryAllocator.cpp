@@ -0,0 +1,308 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MemoryAllocator.h"
+
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/Implementation/BuddyAllocator.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+/* Smallest general allocation. Makes the buddy allocator state reasonably
+   small even for large blocks. */
+constexpr UnsignedLong MinNodeSize = 256;
+
+UnsignedLong alignUp(const UnsignedLong offset, const UnsignedLong alignment) {
+    return ((offset + alignment - 1)/alignment)*alignment;
+}
+
+}
+
+struct MemoryAllocator::Block {
+    explicit Block(Memory&& memory, UnsignedInt memoryType, MemoryAllocationStrategy strategy, bool dedicated): memory{std::move(memory)}, memoryType{memoryType}, strategy{strategy}, dedicated{dedicated} {}
+
+    Memory memory;
+    UnsignedInt memoryType;
+    MemoryAllocationStrategy strategy;
+    /* A block allocated for a single allocation larger than blockSize */
+    bool dedicated;
+    UnsignedInt allocationCount{};
+
+    /* Used only by general non-dedicated blocks */
+    Containers::Optional<Implementation::BuddyAllocator> buddy;
+    /* Used only by linear blocks */
+    UnsignedLong linearOffset{};
+};
+
+struct MemoryAllocator::State {
+    explicit State(Device& device, UnsignedLong blockSize): device(device), blockSize{blockSize} {}
+
+    Block& addBlock(UnsignedLong size, UnsignedInt memoryType, MemoryAllocationStrategy strategy, bool dedicated);
+
+    Device& device;
+    UnsignedLong blockSize;
+    /* Node size of the buddy allocators, also used as the minimal alignment
+       of linear allocations */
+    UnsignedLong granularity;
+    /* Blocks of all strategies, indexed by memory type. Pointers so the
+       allocations can keep referencing them when the array is modified. */
+    Containers::Array<Containers::Array<Containers::Pointer<Block>>> pools;
+};
+
+MemoryAllocator::Block& MemoryAllocator::State::addBlock(const UnsignedLong size, const UnsignedInt memoryType, const MemoryAllocationStrategy strategy, const bool dedicated) {
+    Containers::Pointer<Block>& block = arrayAppend(pools[memoryType], Containers::InPlaceInit, Containers::pointer<Block>(Memory{device, MemoryAllocateInfo{size, memoryType}}, memoryType, strategy, dedicated));
+    if(!dedicated && strategy == MemoryAllocationStrategy::General)
+        block->buddy.emplace(size, granularity);
+    return *block;
+}
+
+MemoryAllocation::MemoryAllocation(NoCreateT) noexcept: _allocator{}, _block{}, _offset{}, _size{}, _nodeSize{}, _memoryType{}, _strategy{} {}
+
+MemoryAllocation::MemoryAllocation(MemoryAllocation&& other) noexcept: _allocator{other._allocator}, _block{other._block}, _offset{other._offset}, _size{other._size}, _nodeSize{other._nodeSize}, _memoryType{other._memoryType}, _strategy{other._strategy} {
+    other._allocator = {};
+    other._block = {};
+}
+
+MemoryAllocation::~MemoryAllocation() {
+    if(_allocator) _allocator->free(*this);
+}
+
+MemoryAllocation& MemoryAllocation::operator=(MemoryAllocation&& other) noexcept {
+    using std::swap;
+    swap(other._allocator, _allocator);
+    swap(other._block, _block);
+    swap(other._offset, _offset);
+    swap(other._size, _size);
+    swap(other._nodeSize, _nodeSize);
+    swap(other._memoryType, _memoryType);
+    swap(other._strategy, _strategy);
+    return *this;
+}
+
+Memory& MemoryAllocation::memory() {
+    CORRADE_ASSERT(_block,
+        "Vk::MemoryAllocation::memory(): the allocation is in a moved-out state", *static_cast<Memory*>(nullptr));
+    return static_cast<MemoryAllocator::Block*>(_block)->memory;
+}
+
+MemoryAllocator::MemoryAllocator(Device& device, const UnsignedLong blockSize): _state{Containers::InPlaceInit, device, blockSize} {
+    CORRADE_ASSERT(blockSize && !(blockSize & (blockSize - 1)),
+        "Vk::MemoryAllocator: expected a power-of-two block size, got" << blockSize, );
+
+    DeviceProperties& properties = device.properties();
+    _state->pools = Containers::Array<Containers::Array<Containers::Pointer<Block>>>{properties.memoryCount()};
+
+    /* Rounding the allocations to bufferImageGranularity, which means buffers
+       and optimally-tiled images can be put into the same block without
+       aliasing each other's pages. It's always a power of two and usually
+       not larger than a few kB. */
+    _state->granularity = MinNodeSize;
+    while(_state->granularity < properties.properties().properties.limits.bufferImageGranularity)
+        _state->granularity <<= 1;
+    _state->granularity = Math::min(_state->granularity, blockSize);
+}
+
+MemoryAllocator::~MemoryAllocator() {
+    #ifndef CORRADE_NO_ASSERT
+    UnsignedInt allocationCount = 0;
+    for(const Containers::Array<Containers::Pointer<Block>>& pool: _state->pools)
+        for(const Containers::Pointer<Block>& block: pool)
+            allocationCount += block->allocationCount;
+    CORRADE_ASSERT(!allocationCount,
+        "Vk::MemoryAllocator: destroyed with" << allocationCount << "live allocations", );
+    #endif
+}
+
+UnsignedLong MemoryAllocator::blockSize() const { return _state->blockSize; }
+
+MemoryAllocation MemoryAllocator::allocate(const MemoryRequirements& requirements, const MemoryFlags memoryFlags, const MemoryAllocationStrategy strategy) {
+    State& state = *_state;
+    const UnsignedInt memoryType = state.device.properties().pickMemory(memoryFlags, requirements.memories());
+    const UnsignedLong size = requirements.size();
+    const UnsignedLong alignment = Math::max(requirements.alignment(), state.granularity);
+
+    MemoryAllocation out{NoCreate};
+    out._allocator = this;
+    out._size = size;
+    out._memoryType = memoryType;
+    out._strategy = strategy;
+
+    /* Allocations larger than the block size get a block of their own */
+    if(size > state.blockSize) {
+        Block& block = state.addBlock(size, memoryType, strategy, true);
+        ++block.allocationCount;
+        out._block = &block;
+        out._nodeSize = size;
+        return out;
+    }
+
+    /* Linear allocations bump an offset in the first block that has enough
+       space left */
+    if(strategy == MemoryAllocationStrategy::Linear) {
+        Block* found = nullptr;
+        UnsignedLong offset{};
+        for(Containers::Pointer<Block>& block: state.pools[memoryType]) {
+            if(block->dedicated || block->strategy != MemoryAllocationStrategy::Linear)
+                continue;
+            offset = alignUp(block->linearOffset, alignment);
+            if(offset + size <= block->memory.size()) {
+                found = block.get();
+                break;
+            }
+        }
+
+        if(!found) {
+            found = &state.addBlock(state.blockSize, memoryType, strategy, false);
+            offset = 0;
+        }
+
+        found->linearOffset = offset + size;
+        ++found->allocationCount;
+        out._block = found;
+        out._offset = offset;
+        out._nodeSize = size;
+        return out;
+    }
+
+    /* General allocations take a buddy node from the first block that has
+       one. All general blocks have the same size and granularity so the node
+       size is the same for all of them. */
+    Block* found = nullptr;
+    UnsignedLong offset{};
+    UnsignedLong nodeSize{};
+    for(Containers::Pointer<Block>& block: state.pools[memoryType]) {
+        if(!block->buddy) continue;
+        nodeSize = block->buddy->nodeSize(size, alignment);
+        offset = block->buddy->allocate(nodeSize);
+        if(offset != ~UnsignedLong{}) {
+            found = block.get();
+            break;
+        }
+    }
+
+    if(!found) {
+        found = &state.addBlock(state.blockSize, memoryType, strategy, false);
+        nodeSize = found->buddy->nodeSize(size, alignment);
+        offset = found->buddy->allocate(nodeSize);
+        CORRADE_INTERNAL_ASSERT(offset == 0);
+    }
+
+    ++found->allocationCount;
+    out._block = found;
+    out._offset = offset;
+    out._nodeSize = nodeSize;
+    return out;
+}
+
+void MemoryAllocator::free(MemoryAllocation& allocation) {
+    Block& block = *static_cast<Block*>(allocation._block);
+    Containers::Array<Containers::Pointer<Block>>& pool = _state->pools[allocation._memoryType];
+    CORRADE_INTERNAL_ASSERT(block.allocationCount);
+    --block.allocationCount;
+
+    bool remove = false;
+    if(block.dedicated) {
+        remove = true;
+
+    /* A linear block gets reused once all its allocations are freed */
+    } else if(block.strategy == MemoryAllocationStrategy::Linear) {
+        if(!block.allocationCount) block.linearOffset = 0;
+
+    /* An empty general block is freed, unless it's the last one, to avoid
+       allocating it again right after */
+    } else {
+        block.buddy->free(allocation._offset, allocation._nodeSize);
+        if(!block.allocationCount) for(const Containers::Pointer<Block>& other: pool) {
+            if(other.get() != &block && other->buddy) {
+                remove = true;
+                break;
+            }
+        }
+    }
+
+    if(remove) {
+        std::size_t i = 0;
+        while(pool[i].get() != &block) ++i;
+        pool[i] = std::move(pool[pool.size() - 1]);
+        arrayRemoveSuffix(pool);
+    }
+}
+
+MemoryAllocator::Statistics MemoryAllocator::statistics() const {
+    Statistics out{};
+    for(const Containers::Array<Containers::Pointer<Block>>& pool: _state->pools) {
+        for(const Containers::Pointer<Block>& block: pool) {
+            const UnsignedLong size = block->memory.size();
+            ++out.blockCount;
+            out.blockSize += size;
+            out.allocationCount += block->allocationCount;
+
+            if(block->dedicated) {
+                out.usedSize += size;
+            } else if(block->strategy == MemoryAllocationStrategy::Linear) {
+                out.usedSize += block->linearOffset;
+            } else {
+                out.usedSize += block->buddy->usedSize();
+                out.freeSize += size - block->buddy->usedSize();
+                out.largestFreeSize = Math::max(out.largestFreeSize, block->buddy->largestFreeSize());
+                out.freeRangeCount += block->buddy->freeNodeCount();
+            }
+        }
+    }
+
+    return out;
+}
+
+Float MemoryAllocator::Statistics::fragmentation() const {
+    if(!freeSize) return 0.0f;
+    return 1.0f - Float(largestFreeSize)/Float(freeSize);
+}
+
+Debug& operator<<(Debug& debug, const MemoryAllocationStrategy value) {
+    debug << "Vk::MemoryAllocationStrategy" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::MemoryAllocationStrategy::value: return debug << "::" << Debug::nospace << #value;
+        _c(General)
+        _c(Linear)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,316 @@
+#ifndef Magnum_Vk_MemoryAllocator_h
+#define Magnum_Vk_MemoryAllocator_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::MemoryAllocator, @ref Magnum::Vk::MemoryAllocation, enum @ref Magnum::Vk::MemoryAllocationStrategy
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Memory allocation strategy
+@m_since_latest
+
+@see @ref MemoryAllocator::allocate()
+*/
+enum class MemoryAllocationStrategy: UnsignedByte {
+    /**
+     * General-purpose allocation, meant for long-lived resources. Allocated
+     * from a buddy allocator, the space is returned back to the pool when the
+     * @ref MemoryAllocation is destroyed.
+     */
+    General,
+
+    /**
+     * Linear allocation, meant for transient resources such as per-frame
+     * staging buffers. Allocated by bumping an offset in a memory block, which
+     * is very fast but the space is reused only once all allocations from
+     * given block are destroyed.
+     */
+    Linear
+};
+
+/**
+@debugoperatorenum{MemoryAllocationStrategy}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, MemoryAllocationStrategy value);
+
+/**
+@brief Memory sub-allocation
+@m_since_latest
+
+A sub-range of a @ref Memory block owned by a @ref MemoryAllocator. Returned
+from @ref MemoryAllocator::allocate(), the range is given back to the allocator
+on destruction. See @ref MemoryAllocator for more information.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocation {
+    public:
+        /**
+         * @brief Construct without allocating
+         *
+         * The constructed instance is equivalent to moved-from state. Move
+         * another object over it to make it useful.
+         */
+        explicit MemoryAllocation(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation(const MemoryAllocation&) = delete;
+
+        /** @brief Move constructor */
+        MemoryAllocation(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Returns the range back to the allocator, if any.
+         */
+        ~MemoryAllocation();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocation& operator=(const MemoryAllocation&) = delete;
+
+        /** @brief Move assignment */
+        MemoryAllocation& operator=(MemoryAllocation&& other) noexcept;
+
+        /**
+         * @brief Allocator owning the memory
+         *
+         * Returns @cpp nullptr @ce for a @ref MemoryAllocation(NoCreateT)
+         * or moved-out instance.
+         */
+        MemoryAllocator* allocator() const { return _allocator; }
+
+        /**
+         * @brief Memory block the range is allocated from
+         *
+         * The block is shared with other allocations, so when mapping it, be
+         * sure to map only the @ref offset() and @ref size() range or
+         * coordinate the mapping with other users of the block. Expects that
+         * the instance isn't in a moved-out state.
+         */
+        Memory& memory();
+
+        /** @brief Offset of the range in @ref memory() */
+        UnsignedLong offset() const { return _offset; }
+
+        /** @brief Size of the range */
+        UnsignedLong size() const { return _size; }
+
+        /** @brief Memory type index */
+        UnsignedInt memoryType() const { return _memoryType; }
+
+        /** @brief Allocation strategy */
+        MemoryAllocationStrategy strategy() const { return _strategy; }
+
+    private:
+        friend MemoryAllocator;
+
+        MemoryAllocator* _allocator;
+        void* _block;
+        UnsignedLong _offset, _size, _nodeSize;
+        UnsignedInt _memoryType;
+        MemoryAllocationStrategy _strategy;
+};
+
+/**
+@brief Device memory allocator
+@m_since_latest
+
+Instead of allocating a dedicated @ref Memory for each @ref Buffer and
+@ref Image, which quickly runs into the @m_class{m-doc-external} [maxMemoryAllocationCount](https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkPhysicalDeviceLimits.html)
+limit and wastes space on alignment, the allocator allocates large memory
+blocks and sub-allocates ranges from them. Pass it to the
+@ref Buffer(Device&, const BufferCreateInfo&, MemoryAllocator&, MemoryFlags, MemoryAllocationStrategy)
+or @ref Image(Device&, const ImageCreateInfo&, MemoryAllocator&, MemoryFlags, MemoryAllocationStrategy)
+constructor and the resource then owns the @ref MemoryAllocation, returning it
+back to the allocator on destruction:
+
+@snippet MagnumVk.cpp MemoryAllocator
+
+Blocks are kept in a separate pool for each memory type and each
+@ref MemoryAllocationStrategy. General allocations use a buddy allocator, which
+rounds each size up to a power of two, at least as large as the alignment and
+the @m_class{m-doc-external} [bufferImageGranularity](https://www.khronos.org/registry/vulkan/specs/1.2-extensions/man/html/VkPhysicalDeviceLimits.html)
+limit, so buffers and optimally tiled images can share a block. A general block
+that becomes empty is freed, unless it's the last general block of given
+memory type. Linear allocations are much cheaper, however a linear block is
+reused only after all allocations from it are destroyed. Allocations larger
+than the block size get a dedicated block of their own.
+
+The allocator has to outlive all allocations made from it. It's not
+thread-safe, synchronize the access externally if you need to allocate from
+multiple threads.
+
+@section Vk-MemoryAllocator-statistics Allocation statistics
+
+Use @ref statistics() to see how many blocks are allocated, how much of the
+space is used and how fragmented the free space is. The allocator doesn't
+move existing allocations, but a high @ref Statistics::fragmentation() value
+is a hint that recreating long-lived resources in a new allocator would
+reclaim space.
+*/
+class MAGNUM_VK_EXPORT MemoryAllocator {
+    public:
+        /**
+         * @brief Allocation statistics
+         *
+         * @see @ref statistics()
+         */
+        struct Statistics {
+            /**
+             * @brief Count of allocated memory blocks
+             *
+             * Each block is one @fn_vk{AllocateMemory} call, including
+             * dedicated blocks for allocations larger than
+             * @ref blockSize().
+             */
+            UnsignedInt blockCount;
+
+            /** @brief Total size of all allocated memory blocks */
+            UnsignedLong blockSize;
+
+            /** @brief Count of live allocations */
+            UnsignedInt allocationCount;
+
+            /**
+             * @brief Size used by live allocations
+             *
+             * Includes the padding added to general allocations in order to
+             * round them up to a power of two, and the space in linear blocks
+             * that's not reused yet.
+             */
+            UnsignedLong usedSize;
+
+            /**
+             * @brief Total size of free space in general blocks
+             *
+             * Space in linear blocks isn't counted.
+             */
+            UnsignedLong freeSize;
+
+            /**
+             * @brief Size of the largest free range in a general block
+             *
+             * An allocation larger than this will need a new block.
+             */
+            UnsignedLong largestFreeSize;
+
+            /** @brief Count of free ranges in general blocks */
+            UnsignedInt freeRangeCount;
+
+            /**
+             * @brief Fragmentation of the free space
+             *
+             * Calculated as @f$ 1 - \frac{s_\text{largest}}{s_\text{free}} @f$,
+             * where @f$ s_\text{largest} @f$ is @ref largestFreeSize and
+             * @f$ s_\text{free} @f$ is @ref freeSize. Returns @cpp 0.0f @ce
+             * if all free space is in a single range or if there's no free
+             * space, and values close to @cpp 1.0f @ce if the free space is
+             * split into many small ranges.
+             */
+            Float fragmentation() const;
+        };
+
+        /**
+         * @brief Constructor
+         * @param device        Vulkan device to allocate the memory on
+         * @param blockSize     Size of a memory block
+         *
+         * Expects that @p blockSize is a power of two. No memory is allocated
+         * upfront.
+         */
+        explicit MemoryAllocator(Device& device, UnsignedLong blockSize = 64*1024*1024);
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator(const MemoryAllocator&) = delete;
+
+        /**
+         * @brief Moving is not allowed
+         *
+         * Allocations reference the allocator, so it can't change its
+         * address.
+         */
+        MemoryAllocator(MemoryAllocator&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Frees all memory blocks. Expects that there are no live
+         * allocations.
+         */
+        ~MemoryAllocator();
+
+        /** @brief Copying is not allowed */
+        MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        MemoryAllocator& operator=(MemoryAllocator&&) = delete;
+
+        /** @brief Memory block size */
+        UnsignedLong blockSize() const;
+
+        /**
+         * @brief Allocate memory
+         * @param requirements  Memory requirements, for example from
+         *      @ref Buffer::memoryRequirements()
+         * @param memoryFlags   Memory flags
+         * @param strategy      Allocation strategy
+         *
+         * Picks a memory type using @ref DeviceProperties::pickMemory() and
+         * sub-allocates a correctly aligned range of it, allocating a new
+         * block if no existing block has enough space.
+         * @see @ref Buffer::bindAllocatedMemory(),
+         *      @ref Image::bindAllocatedMemory()
+         */
+        MemoryAllocation allocate(const MemoryRequirements& requirements, MemoryFlags memoryFlags, MemoryAllocationStrategy strategy = MemoryAllocationStrategy::General);
+
+        /** @brief Allocation statistics */
+        Statistics statistics() const;
+
+    private:
+        friend MemoryAllocation;
+
+        struct Block;
+        struct State;
+
+        MAGNUM_VK_LOCAL void free(MemoryAllocation& allocation);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
@@ -0,0 +1,465 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Pipeline.h"
+#include "PipelineCreateInfo.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Enums.h"
+
+namespace Magnum { namespace Vk {
+
+struct GraphicsPipelineCreateInfo::State {
+    explicit State();
+
+    Containers::Array<Containers::String> entrypoints;
+    Containers::Array<VkPipelineShaderStageCreateInfo> stages;
+    Containers::Array<VkVertexInputBindingDescription> bindings;
+    Containers::Array<VkVertexInputAttributeDescription> attributes;
+    Containers::Array<VkPipelineColorBlendAttachmentState> colorBlendAttachments;
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    VkViewport viewport{};
+    VkRect2D scissor{};
+    VkPipelineViewportStateCreateInfo viewportState{};
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    VkPipelineColorBlendStateCreateInfo colorBlend{};
+    VkDynamicState dynamicStates[2]{VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamic{};
+};
+
+GraphicsPipelineCreateInfo::State::State() {
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    /* Viewport and scissor are dynamic by default, so the pointers are left
+       null until setViewport() is called */
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    rasterization.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterization.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterization.cullMode = VK_CULL_MODE_NONE;
+    rasterization.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.lineWidth = 1.0f;
+
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+    depthStencil.maxDepthBounds = 1.0f;
+
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+
+    dynamic.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamic.dynamicStateCount = Containers::arraySize(dynamicStates);
+    dynamic.pDynamicStates = dynamicStates;
+}
+
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(const VkPipelineLayout layout, const VkRenderPass renderPass, const UnsignedInt subpass, const UnsignedInt colorAttachmentCount, const Flags flags): _info{}, _state{Containers::InPlaceInit} {
+    _info.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    _info.flags = VkPipelineCreateFlags(flags);
+
+    _state->colorBlendAttachments = Containers::Array<VkPipelineColorBlendAttachmentState>{Containers::ValueInit, colorAttachmentCount};
+    for(VkPipelineColorBlendAttachmentState& attachment: _state->colorBlendAttachments)
+        attachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT|VK_COLOR_COMPONENT_G_BIT|VK_COLOR_COMPONENT_B_BIT|VK_COLOR_COMPONENT_A_BIT;
+    _state->colorBlend.attachmentCount = colorAttachmentCount;
+    _state->colorBlend.pAttachments = _state->colorBlendAttachments;
+
+    _info.pVertexInputState = &_state->vertexInput;
+    _info.pInputAssemblyState = &_state->inputAssembly;
+    _info.pViewportState = &_state->viewportState;
+    _info.pRasterizationState = &_state->rasterization;
+    _info.pMultisampleState = &_state->multisample;
+    _info.pDepthStencilState = &_state->depthStencil;
+    _info.pColorBlendState = &_state->colorBlend;
+    _info.pDynamicState = &_state->dynamic;
+    _info.layout = layout;
+    _info.renderPass = renderPass;
+    _info.subpass = subpass;
+    _info.basePipelineIndex = -1;
+}
+
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(NoInitT) noexcept {}
+
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(const VkGraphicsPipelineCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+GraphicsPipelineCreateInfo::GraphicsPipelineCreateInfo(GraphicsPipelineCreateInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    /** @todo this is now more like a destructible move, do it more selectively
+        and clear only what's really ours and not external? */
+    other._info.stageCount = 0;
+    other._info.pStages = nullptr;
+    other._info.pVertexInputState = nullptr;
+    other._info.pInputAssemblyState = nullptr;
+    other._info.pViewportState = nullptr;
+    other._info.pRasterizationState = nullptr;
+    other._info.pMultisampleState = nullptr;
+    other._info.pDepthStencilState = nullptr;
+    other._info.pColorBlendState = nullptr;
+    other._info.pDynamicState = nullptr;
+}
+
+GraphicsPipelineCreateInfo::~GraphicsPipelineCreateInfo() = default;
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::operator=(GraphicsPipelineCreateInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::addShader(const ShaderStage stage, const VkShaderModule shader, const Containers::StringView entrypoint) {
+    if(!_state) _state.emplace();
+
+    arrayAppend(_state->entrypoints, Containers::String::nullTerminatedGlobalView(entrypoint));
+    VkPipelineShaderStageCreateInfo& info = arrayAppend(_state->stages, VkPipelineShaderStageCreateInfo{});
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    info.stage = VkShaderStageFlagBits(stage);
+    info.module = shader;
+
+    /* Both arrays might get reallocated and short entrypoint copies are
+       stored inline in the String instances, so update all pointers every
+       time */
+    for(std::size_t i = 0; i != _state->stages.size(); ++i)
+        _state->stages[i].pName = _state->entrypoints[i].data();
+    _info.stageCount = _state->stages.size();
+    _info.pStages = _state->stages;
+    return *this;
+}
+
+void GraphicsPipelineCreateInfo::addBindingInternal(const UnsignedInt binding, const UnsignedInt stride, const VkVertexInputRate rate) {
+    if(!_state) _state.emplace();
+
+    /* The array might get reallocated, so update the pointer every time */
+    arrayAppend(_state->bindings, VkVertexInputBindingDescription{binding, stride, rate});
+    _state->vertexInput.vertexBindingDescriptionCount = _state->bindings.size();
+    _state->vertexInput.pVertexBindingDescriptions = _state->bindings;
+    _info.pVertexInputState = &_state->vertexInput;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::addVertexBinding(const UnsignedInt binding, const UnsignedInt stride) {
+    addBindingInternal(binding, stride, VK_VERTEX_INPUT_RATE_VERTEX);
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::addInstanceBinding(const UnsignedInt binding, const UnsignedInt stride) {
+    addBindingInternal(binding, stride, VK_VERTEX_INPUT_RATE_INSTANCE);
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::addVertexAttribute(const UnsignedInt location, const UnsignedInt binding, const VertexFormat format, const UnsignedInt offset) {
+    if(!_state) _state.emplace();
+
+    /* The array might get reallocated, so update the pointer every time */
+    arrayAppend(_state->attributes, VkVertexInputAttributeDescription{location, binding, vkFormat(format), offset});
+    _state->vertexInput.vertexAttributeDescriptionCount = _state->attributes.size();
+    _state->vertexInput.pVertexAttributeDescriptions = _state->attributes;
+    _info.pVertexInputState = &_state->vertexInput;
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::setPrimitive(const MeshPrimitive primitive) {
+    if(!_state) _state.emplace();
+
+    _state->inputAssembly.topology = vkPrimitiveTopology(primitive);
+    _info.pInputAssemblyState = &_state->inputAssembly;
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::setViewport(const Range3D& viewport, const Range2Di& scissor) {
+    if(!_state) _state.emplace();
+
+    _state->viewport.x = viewport.min().x();
+    _state->viewport.y = viewport.min().y();
+    _state->viewport.width = viewport.sizeX();
+    _state->viewport.height = viewport.sizeY();
+    _state->viewport.minDepth = viewport.min().z();
+    _state->viewport.maxDepth = viewport.max().z();
+    _state->scissor.offset = {scissor.min().x(), scissor.min().y()};
+    _state->scissor.extent = {UnsignedInt(scissor.sizeX()), UnsignedInt(scissor.sizeY())};
+    _state->viewportState.pViewports = &_state->viewport;
+    _state->viewportState.pScissors = &_state->scissor;
+    _info.pViewportState = &_state->viewportState;
+
+    /* The viewport and scissor are the only dynamic state so far, so there's
+       nothing dynamic left */
+    _info.pDynamicState = nullptr;
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::setViewport(const Range2D& viewport) {
+    return setViewport(Range3D{Vector3{viewport.min(), 0.0f}, Vector3{viewport.max(), 1.0f}}, Range2Di{viewport});
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::setDepthTest(const bool enabled) {
+    if(!_state) _state.emplace();
+
+    _state->depthStencil.depthTestEnable = enabled;
+    _state->depthStencil.depthWriteEnable = enabled;
+    _info.pDepthStencilState = &_state->depthStencil;
+    return *this;
+}
+
+GraphicsPipelineCreateInfo& GraphicsPipelineCreateInfo::setFaceCulling(const bool enabled) {
+    if(!_state) _state.emplace();
+
+    _state->rasterization.cullMode = enabled ? VK_CULL_MODE_BACK_BIT : VK_CULL_MODE_NONE;
+    _info.pRasterizationState = &_state->rasterization;
+    return *this;
+}
+
+struct ComputePipelineCreateInfo::State {
+    Containers::String entrypoint;
+};
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo(const VkPipelineLayout layout, const VkShaderModule shader, const Containers::StringView entrypoint, const Flags flags): _info{}, _state{Containers::InPlaceInit} {
+    _info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    _info.flags = VkPipelineCreateFlags(flags);
+    _info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    _info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    _info.stage.module = shader;
+
+    /* The state is on the heap, so the pointer stays valid even if a short
+       copy is stored inline in the String */
+    _state->entrypoint = Containers::String::nullTerminatedGlobalView(entrypoint);
+    _info.stage.pName = _state->entrypoint.data();
+    _info.layout = layout;
+    _info.basePipelineIndex = -1;
+}
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo(NoInitT) noexcept {}
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo(const VkComputePipelineCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+ComputePipelineCreateInfo::ComputePipelineCreateInfo(ComputePipelineCreateInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    other._info.stage.pName = nullptr;
+}
+
+ComputePipelineCreateInfo::~ComputePipelineCreateInfo() = default;
+
+ComputePipelineCreateInfo& ComputePipelineCreateInfo::operator=(ComputePipelineCreateInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+Pipeline Pipeline::wrap(Device& device, const PipelineBindPoint bindPoint, const VkPipeline handle, const HandleFlags flags) {
+    Pipeline out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._bindPoint = bindPoint;
+    out._flags = flags;
+    return out;
+}
+
+Pipeline::Pipeline(Device& device, const GraphicsPipelineCreateInfo& info, const VkPipelineCache cache): _device{&device}, _bindPoint{PipelineBindPoint::Graphics}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateGraphicsPipelines(device, cache, 1, info, nullptr, &_handle));
+}
+
+Pipeline::Pipeline(Device& device, const ComputePipelineCreateInfo& info, const VkPipelineCache cache): _device{&device}, _bindPoint{PipelineBindPoint::Compute}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateComputePipelines(device, cache, 1, info, nullptr, &_handle));
+}
+
+Pipeline::Pipeline(NoCreateT): _device{}, _handle{}, _bindPoint{} {}
+
+Pipeline::Pipeline(Pipeline&& other) noexcept: _device{other._device}, _handle{other._handle}, _bindPoint{other._bindPoint}, _flags{other._flags} {
+    other._handle = {};
+}
+
+Pipeline::~Pipeline() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyPipeline(*_device, _handle, nullptr);
+}
+
+Pipeline& Pipeline::operator=(Pipeline&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._bindPoint, _bindPoint);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+VkPipeline Pipeline::release() {
+    const VkPipeline handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+Debug& operator<<(Debug& debug, const PipelineStage value) {
+    debug << "Vk::PipelineStage" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::PipelineStage::value: return debug << "::" << Debug::nospace << #value;
+        _c(TopOfPipe)
+        _c(DrawIndirect)
+        _c(VertexInput)
+        _c(VertexShader)
+        _c(TessellationControlShader)
+        _c(TessellationEvaluationShader)
+        _c(GeometryShader)
+        _c(FragmentShader)
+        _c(EarlyFragmentTests)
+        _c(LateFragmentTests)
+        _c(ColorAttachmentOutput)
+        _c(ComputeShader)
+        _c(Transfer)
+        _c(BottomOfPipe)
+        _c(Host)
+        _c(AllGraphics)
+        _c(AllCommands)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Flag bits should be in hex, unlike plain values */
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const PipelineStages value) {
+    return Containers::enumSetDebugOutput(debug, value, "Vk::PipelineStages{}", {
+        Vk::PipelineStage::TopOfPipe,
+        Vk::PipelineStage::DrawIndirect,
+        Vk::PipelineStage::VertexInput,
+        Vk::PipelineStage::VertexShader,
+        Vk::PipelineStage::TessellationControlShader,
+        Vk::PipelineStage::TessellationEvaluationShader,
+        Vk::PipelineStage::GeometryShader,
+        Vk::PipelineStage::FragmentShader,
+        Vk::PipelineStage::EarlyFragmentTests,
+        Vk::PipelineStage::LateFragmentTests,
+        Vk::PipelineStage::ColorAttachmentOutput,
+        Vk::PipelineStage::ComputeShader,
+        Vk::PipelineStage::Transfer,
+        Vk::PipelineStage::BottomOfPipe,
+        Vk::PipelineStage::Host,
+        Vk::PipelineStage::AllGraphics,
+        Vk::PipelineStage::AllCommands});
+}
+
+Debug& operator<<(Debug& debug, const Access value) {
+    debug << "Vk::Access" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::Access::value: return debug << "::" << Debug::nospace << #value;
+        _c(IndirectCommandRead)
+        _c(IndexRead)
+        _c(VertexAttributeRead)
+        _c(UniformRead)
+        _c(InputAttachmentRead)
+        _c(ShaderRead)
+        _c(ShaderWrite)
+        _c(ColorAttachmentRead)
+        _c(ColorAttachmentWrite)
+        _c(DepthStencilAttachmentRead)
+        _c(DepthStencilAttachmentWrite)
+        _c(TransferRead)
+        _c(TransferWrite)
+        _c(HostRead)
+        _c(HostWrite)
+        _c(MemoryRead)
+        _c(MemoryWrite)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Flag bits should be in hex, unlike plain values */
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const Accesses value) {
+    return Containers::enumSetDebugOutput(debug, value, "Vk::Accesses{}", {
+        Vk::Access::IndirectCommandRead,
+        Vk::Access::IndexRead,
+        Vk::Access::VertexAttributeRead,
+        Vk::Access::UniformRead,
+        Vk::Access::InputAttachmentRead,
+        Vk::Access::ShaderRead,
+        Vk::Access::ShaderWrite,
+        Vk::Access::ColorAttachmentRead,
+        Vk::Access::ColorAttachmentWrite,
+        Vk::Access::DepthStencilAttachmentRead,
+        Vk::Access::DepthStencilAttachmentWrite,
+        Vk::Access::TransferRead,
+        Vk::Access::TransferWrite,
+        Vk::Access::HostRead,
+        Vk::Access::HostWrite,
+        Vk::Access::MemoryRead,
+        Vk::Access::MemoryWrite});
+}
+
+Debug& operator<<(Debug& debug, const PipelineBindPoint value) {
+    debug << "Vk::PipelineBindPoint" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::PipelineBindPoint::value: return debug << "::" << Debug::nospace << #value;
+        _c(Graphics)
+        _c(Compute)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Vulkan docs have the values in decimal, so not converting to hex */
+    return debug << "(" << Debug::nospace << Int(value) << Debug::nospace << ")";
+}
+
+}}
@@ -0,0 +1,389 @@
+#ifndef Magnum_Vk_Pipeline_h
+#define Magnum_Vk_Pipeline_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Pipeline, enum @ref Magnum::Vk::PipelineBindPoint, @ref Magnum::Vk::PipelineStage, @ref Magnum::Vk::Access, enum set @ref Magnum::Vk::PipelineStages, @ref Magnum::Vk::Accesses
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Pipeline stage
+@m_since_latest
+
+Wraps @type_vk_keyword{PipelineStageFlagBits}.
+@m_enum_values_as_keywords
+@see @ref PipelineStages, @ref SubmitInfo::setWaitSemaphores()
+*/
+enum class PipelineStage: UnsignedInt {
+    /** Top of the pipe, where commands are initially received */
+    TopOfPipe = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+
+    /** Where indirect draw and dispatch data are consumed */
+    DrawIndirect = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+
+    /** Where vertex and index buffers are consumed */
+    VertexInput = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+
+    /** Vertex shader */
+    VertexShader = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+
+    /** Tessellation control shader */
+    TessellationControlShader = VK_PIPELINE_STAGE_TESSELLATION_CONTROL_SHADER_BIT,
+
+    /** Tessellation evaluation shader */
+    TessellationEvaluationShader = VK_PIPELINE_STAGE_TESSELLATION_EVALUATION_SHADER_BIT,
+
+    /** Geometry shader */
+    GeometryShader = VK_PIPELINE_STAGE_GEOMETRY_SHADER_BIT,
+
+    /** Fragment shader */
+    FragmentShader = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+
+    /**
+     * Early fragment tests, including depth / stencil load operations for
+     * framebuffer attachments
+     */
+    EarlyFragmentTests = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,
+
+    /**
+     * Late fragment tests, including depth / stencil store operations for
+     * framebuffer attachments
+     */
+    LateFragmentTests = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+
+    /**
+     * Where final color values are output from the pipeline, including color
+     * load and store operations for framebuffer attachments. Commonly used
+     * as a wait stage for a semaphore signaled on swapchain image
+     * acquisition.
+     */
+    ColorAttachmentOutput = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+
+    /** Compute shader */
+    ComputeShader = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+
+    /** Copy, blit, resolve and clear commands */
+    Transfer = VK_PIPELINE_STAGE_TRANSFER_BIT,
+
+    /** Bottom of the pipe, where all commands complete execution */
+    BottomOfPipe = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+
+    /** Host access to device memory */
+    Host = VK_PIPELINE_STAGE_HOST_BIT,
+
+    /** All graphics stages */
+    AllGraphics = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT,
+
+    /** All commands */
+    AllCommands = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT
+};
+
+/**
+@debugoperatorenum{PipelineStage}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, PipelineStage value);
+
+/**
+@brief Pipeline stages
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{PipelineStageFlags}.
+@see @ref SubmitInfo::setWaitSemaphores()
+*/
+typedef Containers::EnumSet<PipelineStage> PipelineStages;
+
+CORRADE_ENUMSET_OPERATORS(PipelineStages)
+
+/**
+@debugoperatorenum{PipelineStages}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, PipelineStages value);
+
+/**
+@brief Memory access type
+@m_since_latest
+
+Wraps @type_vk_keyword{AccessFlagBits}.
+@m_enum_values_as_keywords
+@see @ref Accesses, @ref ImageStateTracker
+*/
+enum class Access: UnsignedInt {
+    /** Read of indirect draw and dispatch commands */
+    IndirectCommandRead = VK_ACCESS_INDIRECT_COMMAND_READ_BIT,
+
+    /** Read of an index buffer */
+    IndexRead = VK_ACCESS_INDEX_READ_BIT,
+
+    /** Read of a vertex buffer */
+    VertexAttributeRead = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+
+    /** Read of a uniform buffer */
+    UniformRead = VK_ACCESS_UNIFORM_READ_BIT,
+
+    /** Read of an input attachment in a fragment shader */
+    InputAttachmentRead = VK_ACCESS_INPUT_ATTACHMENT_READ_BIT,
+
+    /** Read of a storage buffer, storage or sampled image in a shader */
+    ShaderRead = VK_ACCESS_SHADER_READ_BIT,
+
+    /** Write to a storage buffer or a storage image in a shader */
+    ShaderWrite = VK_ACCESS_SHADER_WRITE_BIT,
+
+    /** Read of a color attachment, such as for blending */
+    ColorAttachmentRead = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT,
+
+    /** Write to a color or resolve attachment */
+    ColorAttachmentWrite = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+
+    /** Read of a depth/stencil attachment in depth or stencil tests */
+    DepthStencilAttachmentRead = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+
+    /** Write to a depth/stencil attachment */
+    DepthStencilAttachmentWrite = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+
+    /** Read in a copy, blit or resolve command */
+    TransferRead = VK_ACCESS_TRANSFER_READ_BIT,
+
+    /** Write in a copy, blit, resolve or clear command */
+    TransferWrite = VK_ACCESS_TRANSFER_WRITE_BIT,
+
+    /** Read by the host */
+    HostRead = VK_ACCESS_HOST_READ_BIT,
+
+    /** Write by the host */
+    HostWrite = VK_ACCESS_HOST_WRITE_BIT,
+
+    /** Any read */
+    MemoryRead = VK_ACCESS_MEMORY_READ_BIT,
+
+    /** Any write */
+    MemoryWrite = VK_ACCESS_MEMORY_WRITE_BIT
+};
+
+/**
+@debugoperatorenum{Access}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, Access value);
+
+/**
+@brief Memory access types
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{AccessFlags}.
+@see @ref ImageStateTracker
+*/
+typedef Containers::EnumSet<Access> Accesses;
+
+CORRADE_ENUMSET_OPERATORS(Accesses)
+
+/**
+@debugoperatorenum{Accesses}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, Accesses value);
+
+/**
+@brief Pipeline bind point
+@m_since_latest
+
+Wraps @type_vk_keyword{PipelineBindPoint}.
+@m_enum_values_as_keywords
+@see @ref Pipeline::bindPoint(), @ref CommandBuffer::bindPipeline()
+*/
+enum class PipelineBindPoint: Int {
+    /** Graphics pipeline */
+    Graphics = VK_PIPELINE_BIND_POINT_GRAPHICS,
+
+    /** Compute pipeline */
+    Compute = VK_PIPELINE_BIND_POINT_COMPUTE
+};
+
+/**
+@debugoperatorenum{PipelineBindPoint}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, PipelineBindPoint value);
+
+/**
+@brief Pipeline
+@m_since_latest
+
+Wraps a graphics or compute @type_vk_keyword{Pipeline}.
+
+@section Vk-Pipeline-creation-graphics Graphics pipeline creation
+
+A @ref GraphicsPipelineCreateInfo takes a @ref PipelineLayout, a
+@ref RenderPass together with a subpass index and the count of color
+attachments in that subpass. Then you add shaders using
+@ref GraphicsPipelineCreateInfo::addShader() and describe the vertex layout
+with @ref GraphicsPipelineCreateInfo::addVertexBinding() and
+@ref GraphicsPipelineCreateInfo::addVertexAttribute(). Other state has
+defaults suitable for opaque rendering without depth test, and if no viewport
+is set, viewport and scissor are left as dynamic state to be specified at draw
+time:
+
+@snippet MagnumVk.cpp Pipeline-creation-graphics
+
+@section Vk-Pipeline-creation-compute Compute pipeline creation
+
+A @ref ComputePipelineCreateInfo takes a @ref PipelineLayout and a single
+compute @ref Shader together with its entrypoint name:
+
+@snippet MagnumVk.cpp Pipeline-creation-compute
+
+@section Vk-Pipeline-cache Pipeline caching
+
+Pipeline creation is where the driver compiles the SPIR-V to GPU-specific code
+and can take a significant amount of time. Both constructors optionally take a
+@ref PipelineCache, which lets the driver reuse the compiled code both within a
+single run and --- if the cache is persisted with @ref PipelineCache::save()
+and @ref PipelineCache::load() --- across application runs as well. See the
+@ref PipelineCache documentation for more information.
+
+@section Vk-Pipeline-usage Pipeline usage
+
+A pipeline is bound to a command buffer using
+@ref CommandBuffer::bindPipeline(), which takes the bind point from
+@ref bindPoint().
+*/
+class MAGNUM_VK_EXPORT Pipeline {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device    Vulkan device the pipeline is created on
+         * @param bindPoint Pipeline bind point
+         * @param handle    The @type_vk{Pipeline} handle
+         * @param flags     Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a pipeline created using a constructor, the Vulkan pipeline is by
+         * default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static Pipeline wrap(Device& device, PipelineBindPoint bindPoint, VkPipeline handle, HandleFlags flags = {});
+
+        /**
+         * @brief Construct a graphics pipeline
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Graphics pipeline creation info
+         * @param cache     Pipeline cache to use or @cpp nullptr @ce
+         *
+         * The @ref bindPoint() is set to @ref PipelineBindPoint::Graphics.
+         * @see @fn_vk_keyword{CreateGraphicsPipelines}
+         */
+        explicit Pipeline(Device& device, const GraphicsPipelineCreateInfo& info, VkPipelineCache cache = {});
+
+        /**
+         * @brief Construct a compute pipeline
+         * @param device    Vulkan device to create the pipeline on
+         * @param info      Compute pipeline creation info
+         * @param cache     Pipeline cache to use or @cpp nullptr @ce
+         *
+         * The @ref bindPoint() is set to @ref PipelineBindPoint::Compute.
+         * @see @fn_vk_keyword{CreateComputePipelines}
+         */
+        explicit Pipeline(Device& device, const ComputePipelineCreateInfo& info, VkPipelineCache cache = {});
+
+        /**
+         * @brief Construct without creating the pipeline
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Pipeline(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        Pipeline(const Pipeline&) = delete;
+
+        /** @brief Move constructor */
+        Pipeline(Pipeline&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{Pipeline} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyPipeline}, @ref release()
+         */
+        ~Pipeline();
+
+        /** @brief Copying is not allowed */
+        Pipeline& operator=(const Pipeline&) = delete;
+
+        /** @brief Move assignment */
+        Pipeline& operator=(Pipeline&& other) noexcept;
+
+        /** @brief Underlying @type_vk{Pipeline} handle */
+        VkPipeline handle() { return _handle; }
+        /** @overload */
+        operator VkPipeline() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /** @brief Pipeline bind point */
+        PipelineBindPoint bindPoint() const { return _bindPoint; }
+
+        /**
+         * @brief Release the underlying Vulkan pipeline
+         *
+         * Releases ownership of the Vulkan pipeline and returns its handle so
+         * @fn_vk{DestroyPipeline} is not called on destruction. The internal
+         * state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkPipeline release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkPipeline _handle;
+        PipelineBindPoint _bindPoint;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
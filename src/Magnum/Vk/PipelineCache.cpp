@@ -0,0 +1,178 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PipelineCache.h"
+
+#include <cstring>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+/* Each file starts with this, followed by the data from
+   vkGetPipelineCacheData(). The driver puts a similar header at the front of
+   the data as well, but it doesn't include the driver version and some
+   drivers are known to not validate the data thoroughly enough, so checking
+   it on our side too. */
+struct Header {
+    char magic[4];
+    UnsignedInt vendorId;
+    UnsignedInt deviceId;
+    UnsignedInt driverVersion;
+    UnsignedByte pipelineCacheUuid[VK_UUID_SIZE];
+};
+
+constexpr char Magic[]{'M', 'P', 'C', '1'};
+
+static_assert(sizeof(Header) == 32, "improper size of the file header");
+
+Header headerForDevice(Device& device) {
+    const VkPhysicalDeviceProperties& properties = device.properties().properties().properties;
+    Header header;
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.vendorId = properties.vendorID;
+    header.deviceId = properties.deviceID;
+    header.driverVersion = properties.driverVersion;
+    std::memcpy(header.pipelineCacheUuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    return header;
+}
+
+}
+
+PipelineCache PipelineCache::wrap(Device& device, const VkPipelineCache handle, const HandleFlags flags) {
+    PipelineCache out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+PipelineCache PipelineCache::load(Device& device, const std::string& filename) {
+    if(Utility::Directory::exists(filename)) {
+        const Containers::Array<char> data = Utility::Directory::read(filename);
+        const Header expected = headerForDevice(device);
+        /* A file with a different header is left in place, it'll get
+           overwritten on the next save() */
+        if(data.size() > sizeof(Header) && std::memcmp(data, &expected, sizeof(Header)) == 0)
+            return PipelineCache{device, data.suffix(sizeof(Header))};
+    }
+
+    return PipelineCache{device};
+}
+
+PipelineCache::PipelineCache(Device& device, const Containers::ArrayView<const void> data): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    VkPipelineCacheCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    info.initialDataSize = data.size();
+    info.pInitialData = data.data();
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreatePipelineCache(device, &info, nullptr, &_handle));
+}
+
+PipelineCache::PipelineCache(NoCreateT): _device{}, _handle{} {}
+
+PipelineCache::PipelineCache(PipelineCache&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+PipelineCache::~PipelineCache() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyPipelineCache(*_device, _handle, nullptr);
+}
+
+PipelineCache& PipelineCache::operator=(PipelineCache&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+Containers::Array<char> PipelineCache::data() {
+    std::size_t size;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).GetPipelineCacheData(*_device, _handle, &size, nullptr));
+    Containers::Array<char> out{Containers::NoInit, size};
+
+    /* If another thread created a pipeline through this cache in the
+       meantime, the data may be larger now and VK_INCOMPLETE is returned. The
+       truncated data are still valid though, the new pipeline just won't be
+       included. */
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR_INCOMPLETE((**_device).GetPipelineCacheData(*_device, _handle, &size, out.data()));
+    CORRADE_INTERNAL_ASSERT(size <= out.size());
+    if(size != out.size()) {
+        Containers::Array<char> truncated{Containers::NoInit, size};
+        std::memcpy(truncated, out, size);
+        out = std::move(truncated);
+    }
+
+    return out;
+}
+
+PipelineCache& PipelineCache::merge(const Containers::ArrayView<const VkPipelineCache> caches) {
+    #ifndef CORRADE_NO_ASSERT
+    for(const VkPipelineCache cache: caches)
+        CORRADE_ASSERT(cache != _handle,
+            "Vk::PipelineCache::merge(): can't merge a cache into itself", *this);
+    #endif
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).MergePipelineCaches(*_device, _handle, caches.size(), caches.data()));
+    return *this;
+}
+
+PipelineCache& PipelineCache::merge(const std::initializer_list<VkPipelineCache> caches) {
+    return merge(Containers::arrayView(caches));
+}
+
+bool PipelineCache::save(const std::string& filename) {
+    const Containers::Array<char> cacheData = data();
+
+    Containers::Array<char> fileData{Containers::NoInit, sizeof(Header) + cacheData.size()};
+    const Header header = headerForDevice(*_device);
+    std::memcpy(fileData, &header, sizeof(Header));
+    std::memcpy(fileData + sizeof(Header), cacheData, cacheData.size());
+
+    const std::string path = Utility::Directory::path(filename);
+    if(!path.empty() && !Utility::Directory::mkpath(path)) return false;
+
+    /* Writing to a temporary file first so an interrupted write or another
+       instance of the application never sees a partially written cache */
+    const std::string temporary = filename + ".tmp";
+    return Utility::Directory::write(temporary, fileData) &&
+           Utility::Directory::move(temporary, filename);
+}
+
+VkPipelineCache PipelineCache::release() {
+    const VkPipelineCache handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
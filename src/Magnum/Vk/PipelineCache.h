@@ -0,0 +1,216 @@
+#ifndef Magnum_Vk_PipelineCache_h
+#define Magnum_Vk_PipelineCache_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::PipelineCache
+ * @m_since_latest
+ */
+
+#include <initializer_list>
+#include <string>
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Pipeline cache
+@m_since_latest
+
+Wraps a @type_vk_keyword{PipelineCache}. Passing it to the @ref Pipeline
+constructors lets the driver reuse compiled shader code for pipelines that
+were already created through the same cache, which is especially significant
+for the first frames of an application where the pipeline creation would
+otherwise be a major source of stalls.
+
+@section Vk-PipelineCache-creation Pipeline cache creation
+
+Default-constructed cache is empty. Alternatively it can be populated with
+data retrieved earlier using @ref data(), in which case the driver validates
+the data and silently ignores it if it's incompatible with the device.
+
+@section Vk-PipelineCache-disk Persisting the cache on disk
+
+The @ref load() and @ref save() functions store the cache contents in a file,
+prefixed with a header identifying the device vendor, device ID, driver
+version and the @cpp pipelineCacheUUID @ce from @ref DeviceProperties. On
+load, if the file doesn't exist or the header doesn't match current device, an
+empty cache is created instead and the file gets overwritten on the next
+@ref save() --- so a driver update or a different GPU results in a cold cache
+instead of feeding the driver stale data.
+
+To get the most out of the cache, load it at startup, create all pipelines
+that are known upfront before rendering the first frame and save it on exit:
+
+@snippet MagnumVk.cpp PipelineCache-usage
+
+@section Vk-PipelineCache-threading Thread safety
+
+A pipeline cache is internally synchronized, so it's safe to create pipelines
+from multiple threads using the same cache. If the contention becomes a
+problem, each thread can use its own cache, which are then combined together
+using @ref merge().
+*/
+class MAGNUM_VK_EXPORT PipelineCache {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device    Vulkan device the pipeline cache is created on
+         * @param handle    The @type_vk{PipelineCache} handle
+         * @param flags     Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a pipeline cache created using a constructor, the Vulkan pipeline
+         * cache is by default not deleted on destruction, use @p flags for
+         * different behavior.
+         * @see @ref release()
+         */
+        static PipelineCache wrap(Device& device, VkPipelineCache handle, HandleFlags flags = {});
+
+        /**
+         * @brief Load a pipeline cache from a file
+         * @param device    Vulkan device to create the pipeline cache on
+         * @param filename  File to load the cache from
+         *
+         * If @p filename exists and its header matches the vendor ID, device
+         * ID, driver version and pipeline cache UUID of @p device, the cache
+         * is populated with its contents. Otherwise an empty cache is
+         * created. See @ref Vk-PipelineCache-disk for more information.
+         * @see @ref save(), @ref DeviceProperties::properties()
+         */
+        static PipelineCache load(Device& device, const std::string& filename);
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the pipeline cache on
+         * @param data      Initial data retrieved earlier with @ref data()
+         *
+         * @see @fn_vk_keyword{CreatePipelineCache}
+         */
+        explicit PipelineCache(Device& device, Containers::ArrayView<const void> data = {});
+
+        /**
+         * @brief Construct without creating the pipeline cache
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit PipelineCache(NoCreateT);
+
+        /** @brief Copying is not allowed */
+        PipelineCache(const PipelineCache&) = delete;
+
+        /** @brief Move constructor */
+        PipelineCache(PipelineCache&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{PipelineCache} handle, unless the
+         * instance was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyPipelineCache}, @ref release()
+         */
+        ~PipelineCache();
+
+        /** @brief Copying is not allowed */
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        /** @brief Move assignment */
+        PipelineCache& operator=(PipelineCache&& other) noexcept;
+
+        /** @brief Underlying @type_vk{PipelineCache} handle */
+        VkPipelineCache handle() { return _handle; }
+        /** @overload */
+        operator VkPipelineCache() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Cache data
+         *
+         * The returned data can be passed to
+         * @ref PipelineCache(Device&, Containers::ArrayView<const void>) on
+         * a subsequent run.
+         * @see @fn_vk_keyword{GetPipelineCacheData}, @ref save()
+         */
+        Containers::Array<char> data();
+
+        /**
+         * @brief Merge other caches into this one
+         * @return Reference to self (for method chaining)
+         *
+         * Expects that none of @p caches is this cache.
+         * @see @fn_vk_keyword{MergePipelineCaches}
+         */
+        PipelineCache& merge(Containers::ArrayView<const VkPipelineCache> caches);
+        /** @overload */
+        PipelineCache& merge(std::initializer_list<VkPipelineCache> caches);
+
+        /**
+         * @brief Save the cache to a file
+         *
+         * Writes @ref data() prefixed with a header identifying the device
+         * to @p filename, creating the parent directory if it doesn't exist.
+         * The data are written to a temporary file first and then moved over
+         * the original, so an interrupted write never leaves a partial file
+         * behind. Returns @cpp false @ce if the file can't be written,
+         * @cpp true @ce otherwise.
+         * @see @ref load()
+         */
+        bool save(const std::string& filename);
+
+        /**
+         * @brief Release the underlying Vulkan pipeline cache
+         *
+         * Releases ownership of the Vulkan pipeline cache and returns its
+         * handle so @fn_vk{DestroyPipelineCache} is not called on
+         * destruction. The internal state is then equivalent to moved-from
+         * state.
+         * @see @ref wrap()
+         */
+        VkPipelineCache release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkPipelineCache _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
@@ -0,0 +1,406 @@
+#ifndef Magnum_Vk_PipelineCreateInfo_h
+#define Magnum_Vk_PipelineCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::GraphicsPipelineCreateInfo, @ref Magnum::Vk::ComputePipelineCreateInfo
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/StringView.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Shader.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Graphics pipeline creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{GraphicsPipelineCreateInfo} together with all
+fixed-function state structures it references. See
+@ref Vk-Pipeline-creation-graphics "Graphics pipeline creation" for usage
+information.
+*/
+class MAGNUM_VK_EXPORT GraphicsPipelineCreateInfo {
+    public:
+        /**
+         * @brief Graphics pipeline creation flag
+         *
+         * Wraps @type_vk_keyword{PipelineCreateFlagBits}.
+         * @see @ref Flags, @ref GraphicsPipelineCreateInfo()
+         * @m_enum_values_as_keywords
+         */
+        enum class Flag: UnsignedInt {
+            /**
+             * Disable optimization. Can be used to trade runtime performance
+             * for faster pipeline creation during development.
+             */
+            DisableOptimization = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT,
+
+            /** Allow derivatives to be created from this pipeline */
+            AllowDerivatives = VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT,
+
+            /** The pipeline is a derivative of a previously created one */
+            Derivative = VK_PIPELINE_CREATE_DERIVATIVE_BIT
+        };
+
+        /**
+         * @brief Graphics pipeline creation flags
+         *
+         * Type-safe wrapper for @type_vk_keyword{PipelineCreateFlags}.
+         * @see @ref GraphicsPipelineCreateInfo()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param layout                Pipeline layout
+         * @param renderPass            Render pass the pipeline will be used
+         *      with
+         * @param subpass               Subpass index in @p renderPass
+         * @param colorAttachmentCount  Count of color attachments in
+         *      @p subpass
+         * @param flags                 Graphics pipeline creation flags
+         *
+         * The following @type_vk{GraphicsPipelineCreateInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`
+         * -    `pVertexInputState` to an empty vertex input state
+         * -    `pInputAssemblyState` with `topology` set to
+         *      @val_vk{PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,PrimitiveTopology}
+         * -    `pViewportState` with one viewport and one scissor rectangle
+         * -    `pRasterizationState` with `polygonMode` set to
+         *      @val_vk{POLYGON_MODE_FILL,PolygonMode}, no face culling,
+         *      `frontFace` set to
+         *      @val_vk{FRONT_FACE_COUNTER_CLOCKWISE,FrontFace} and
+         *      `lineWidth` set to @cpp 1.0f @ce
+         * -    `pMultisampleState` with `rasterizationSamples` set to
+         *      @val_vk{SAMPLE_COUNT_1_BIT,SampleCountFlagBits}
+         * -    `pDepthStencilState` with depth and stencil test disabled
+         * -    `pColorBlendState` with @p colorAttachmentCount attachments,
+         *      each with blending disabled and `colorWriteMask` enabling
+         *      all four channels
+         * -    `pDynamicState` with @val_vk{DYNAMIC_STATE_VIEWPORT,DynamicState}
+         *      and @val_vk{DYNAMIC_STATE_SCISSOR,DynamicState}
+         * -    `layout`
+         * -    `renderPass`
+         * -    `subpass`
+         * -    `basePipelineIndex` to @cpp -1 @ce
+         *
+         * You need to call @ref addShader() at least for the vertex stage for
+         * a valid setup.
+         */
+        explicit GraphicsPipelineCreateInfo(VkPipelineLayout layout, VkRenderPass renderPass, UnsignedInt subpass, UnsignedInt colorAttachmentCount, Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit GraphicsPipelineCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         * Calling any of the setters replaces the corresponding pointed-to
+         * state structure with an internally managed one.
+         */
+        explicit GraphicsPipelineCreateInfo(const VkGraphicsPipelineCreateInfo& info);
+
+        /** @brief Copying is not allowed */
+        GraphicsPipelineCreateInfo(const GraphicsPipelineCreateInfo&) = delete;
+
+        /** @brief Move constructor */
+        GraphicsPipelineCreateInfo(GraphicsPipelineCreateInfo&& other) noexcept;
+
+        ~GraphicsPipelineCreateInfo();
+
+        /** @brief Copying is not allowed */
+        GraphicsPipelineCreateInfo& operator=(const GraphicsPipelineCreateInfo&) = delete;
+
+        /** @brief Move assignment */
+        GraphicsPipelineCreateInfo& operator=(GraphicsPipelineCreateInfo&& other) noexcept;
+
+        /**
+         * @brief Add a shader
+         * @param stage         Shader stage
+         * @param shader        Shader module
+         * @param entrypoint    Entrypoint name
+         * @return Reference to self (for method chaining)
+         *
+         * Appends a new @type_vk{PipelineShaderStageCreateInfo} to `pStages`
+         * and increases `stageCount`. If @p entrypoint is not
+         * @ref Corrade::Containers::StringViewFlag::Global "global" and
+         * @ref Corrade::Containers::StringViewFlag::NullTerminated "null-terminated",
+         * an internal copy is made.
+         */
+        GraphicsPipelineCreateInfo& addShader(ShaderStage stage, VkShaderModule shader, Containers::StringView entrypoint = "main");
+
+        /**
+         * @brief Add a per-vertex binding
+         * @param binding   Binding index
+         * @param stride    Stride between consecutive vertices in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * Appends a new @type_vk{VertexInputBindingDescription} with
+         * @val_vk{VERTEX_INPUT_RATE_VERTEX,VertexInputRate} to
+         * `pVertexInputState->pVertexBindingDescriptions`.
+         * @see @ref addInstanceBinding()
+         */
+        GraphicsPipelineCreateInfo& addVertexBinding(UnsignedInt binding, UnsignedInt stride);
+
+        /**
+         * @brief Add a per-instance binding
+         * @param binding   Binding index
+         * @param stride    Stride between consecutive instances in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * Appends a new @type_vk{VertexInputBindingDescription} with
+         * @val_vk{VERTEX_INPUT_RATE_INSTANCE,VertexInputRate} to
+         * `pVertexInputState->pVertexBindingDescriptions`.
+         * @see @ref addVertexBinding()
+         */
+        GraphicsPipelineCreateInfo& addInstanceBinding(UnsignedInt binding, UnsignedInt stride);
+
+        /**
+         * @brief Add a vertex attribute
+         * @param location  Shader input location
+         * @param binding   Binding index the attribute is sourced from
+         * @param format    Attribute format
+         * @param offset    Offset of the attribute relative to the start of
+         *      the vertex or instance in bytes
+         * @return Reference to self (for method chaining)
+         *
+         * Appends a new @type_vk{VertexInputAttributeDescription} to
+         * `pVertexInputState->pVertexAttributeDescriptions`. The @p format
+         * is converted using @ref vkFormat(Magnum::VertexFormat).
+         */
+        GraphicsPipelineCreateInfo& addVertexAttribute(UnsignedInt location, UnsignedInt binding, VertexFormat format, UnsignedInt offset);
+
+        /**
+         * @brief Set primitive topology
+         * @return Reference to self (for method chaining)
+         *
+         * Sets `pInputAssemblyState->topology` to a value converted using
+         * @ref vkPrimitiveTopology(). Default is
+         * @ref MeshPrimitive::Triangles.
+         */
+        GraphicsPipelineCreateInfo& setPrimitive(MeshPrimitive primitive);
+
+        /**
+         * @brief Set a fixed viewport and scissor rectangle
+         * @param viewport  Viewport rectangle, with Z coordinates being
+         *      the depth range
+         * @param scissor   Scissor rectangle
+         * @return Reference to self (for method chaining)
+         *
+         * Sets `pViewportState->pViewports` and `pScissors` and removes
+         * @val_vk{DYNAMIC_STATE_VIEWPORT,DynamicState} and
+         * @val_vk{DYNAMIC_STATE_SCISSOR,DynamicState} from `pDynamicState`.
+         * Changing the viewport then requires creating a new pipeline, so
+         * this is mainly useful for fixed-size offscreen rendering.
+         */
+        GraphicsPipelineCreateInfo& setViewport(const Range3D& viewport, const Range2Di& scissor);
+
+        /**
+         * @brief Set a fixed viewport
+         *
+         * Equivalent to calling @ref setViewport(const Range3D&, const Range2Di&)
+         * with depth range set to @f$ [0, 1] @f$ and the scissor rectangle
+         * covering the whole viewport.
+         */
+        GraphicsPipelineCreateInfo& setViewport(const Range2D& viewport);
+
+        /**
+         * @brief Enable or disable depth test
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, sets `pDepthStencilState->depthTestEnable` and
+         * `depthWriteEnable` to @cpp VK_TRUE @ce and `depthCompareOp` to
+         * @val_vk{COMPARE_OP_LESS_OR_EQUAL,CompareOp}. Disabled by default.
+         * The subpass is expected to have a depth attachment.
+         */
+        GraphicsPipelineCreateInfo& setDepthTest(bool enabled);
+
+        /**
+         * @brief Enable or disable back face culling
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, sets `pRasterizationState->cullMode` to
+         * @val_vk{CULL_MODE_BACK_BIT,CullModeFlagBits}, otherwise to
+         * @val_vk{CULL_MODE_NONE,CullModeFlagBits}. Disabled by default.
+         */
+        GraphicsPipelineCreateInfo& setFaceCulling(bool enabled);
+
+        /** @brief Underlying @type_vk{GraphicsPipelineCreateInfo} structure */
+        VkGraphicsPipelineCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkGraphicsPipelineCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkGraphicsPipelineCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkGraphicsPipelineCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkGraphicsPipelineCreateInfo*() const { return &_info; }
+
+    private:
+        void addBindingInternal(UnsignedInt binding, UnsignedInt stride, VkVertexInputRate rate);
+
+        VkGraphicsPipelineCreateInfo _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(GraphicsPipelineCreateInfo::Flags)
+
+/**
+@brief Compute pipeline creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{ComputePipelineCreateInfo}. See
+@ref Vk-Pipeline-creation-compute "Compute pipeline creation" for usage
+information.
+*/
+class MAGNUM_VK_EXPORT ComputePipelineCreateInfo {
+    public:
+        /**
+         * @brief Compute pipeline creation flag
+         *
+         * Wraps @type_vk_keyword{PipelineCreateFlagBits}.
+         * @see @ref Flags, @ref ComputePipelineCreateInfo()
+         * @m_enum_values_as_keywords
+         */
+        enum class Flag: UnsignedInt {
+            /** @copydoc GraphicsPipelineCreateInfo::Flag::DisableOptimization */
+            DisableOptimization = VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT,
+
+            /** @copydoc GraphicsPipelineCreateInfo::Flag::AllowDerivatives */
+            AllowDerivatives = VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT,
+
+            /** @copydoc GraphicsPipelineCreateInfo::Flag::Derivative */
+            Derivative = VK_PIPELINE_CREATE_DERIVATIVE_BIT
+        };
+
+        /**
+         * @brief Compute pipeline creation flags
+         *
+         * Type-safe wrapper for @type_vk_keyword{PipelineCreateFlags}.
+         * @see @ref ComputePipelineCreateInfo()
+         */
+        typedef Containers::EnumSet<Flag> Flags;
+
+        /**
+         * @brief Constructor
+         * @param layout        Pipeline layout
+         * @param shader        Compute shader module
+         * @param entrypoint    Entrypoint name
+         * @param flags         Compute pipeline creation flags
+         *
+         * The following @type_vk{ComputePipelineCreateInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `flags`
+         * -    `stage.stage` to @val_vk{SHADER_STAGE_COMPUTE_BIT,ShaderStageFlagBits}
+         * -    `stage.module` to @p shader
+         * -    `stage.pName` to @p entrypoint. If it's not
+         *      @ref Corrade::Containers::StringViewFlag::Global "global" and
+         *      @ref Corrade::Containers::StringViewFlag::NullTerminated "null-terminated",
+         *      an internal copy is made.
+         * -    `layout`
+         * -    `basePipelineIndex` to @cpp -1 @ce
+         */
+        explicit ComputePipelineCreateInfo(VkPipelineLayout layout, VkShaderModule shader, Containers::StringView entrypoint = "main", Flags flags = {});
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit ComputePipelineCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit ComputePipelineCreateInfo(const VkComputePipelineCreateInfo& info);
+
+        /** @brief Copying is not allowed */
+        ComputePipelineCreateInfo(const ComputePipelineCreateInfo&) = delete;
+
+        /** @brief Move constructor */
+        ComputePipelineCreateInfo(ComputePipelineCreateInfo&& other) noexcept;
+
+        ~ComputePipelineCreateInfo();
+
+        /** @brief Copying is not allowed */
+        ComputePipelineCreateInfo& operator=(const ComputePipelineCreateInfo&) = delete;
+
+        /** @brief Move assignment */
+        ComputePipelineCreateInfo& operator=(ComputePipelineCreateInfo&& other) noexcept;
+
+        /** @brief Underlying @type_vk{ComputePipelineCreateInfo} structure */
+        VkComputePipelineCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkComputePipelineCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkComputePipelineCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkComputePipelineCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkComputePipelineCreateInfo*() const { return &_info; }
+
+    private:
+        VkComputePipelineCreateInfo _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+CORRADE_ENUMSET_OPERATORS(ComputePipelineCreateInfo::Flags)
+
+}}
+
+/* Make the definition complete -- it doesn't make sense to have a CreateInfo
+   without the corresponding object anyway. */
+#include "Magnum/Vk/Pipeline.h"
+
+#endif
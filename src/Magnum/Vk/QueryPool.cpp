@@ -0,0 +1,102 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "QueryPool.h"
+#include "QueryPoolCreateInfo.h"
+
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Assert.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Result.h"
+
+namespace Magnum { namespace Vk {
+
+QueryPoolCreateInfo::QueryPoolCreateInfo(const QueryType type, const UnsignedInt count): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    _info.queryType = VkQueryType(type);
+    _info.queryCount = count;
+}
+
+QueryPoolCreateInfo::QueryPoolCreateInfo(const QueryPipelineStatistics statistics, const UnsignedInt count): QueryPoolCreateInfo{QueryType::PipelineStatistics, count} {
+    _info.pipelineStatistics = VkQueryPipelineStatisticFlags(statistics);
+}
+
+QueryPoolCreateInfo::QueryPoolCreateInfo(NoInitT) noexcept {}
+
+QueryPoolCreateInfo::QueryPoolCreateInfo(const VkQueryPoolCreateInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+QueryPool QueryPool::wrap(Device& device, const VkQueryPool handle, const HandleFlags flags) {
+    QueryPool out{NoCreate};
+    out._device = &device;
+    out._handle = handle;
+    out._flags = flags;
+    return out;
+}
+
+QueryPool::QueryPool(Device& device, const QueryPoolCreateInfo& info): _device{&device}, _flags{HandleFlag::DestroyOnDestruction} {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(device->CreateQueryPool(device, info, nullptr, &_handle));
+}
+
+QueryPool::QueryPool(NoCreateT) noexcept: _device{}, _handle{} {}
+
+QueryPool::QueryPool(QueryPool&& other) noexcept: _device{other._device}, _handle{other._handle}, _flags{other._flags} {
+    other._handle = {};
+}
+
+QueryPool::~QueryPool() {
+    if(_handle && (_flags & HandleFlag::DestroyOnDestruction))
+        (**_device).DestroyQueryPool(*_device, _handle, nullptr);
+}
+
+QueryPool& QueryPool::operator=(QueryPool&& other) noexcept {
+    using std::swap;
+    swap(other._device, _device);
+    swap(other._handle, _handle);
+    swap(other._flags, _flags);
+    return *this;
+}
+
+bool QueryPool::results(const UnsignedInt first, const UnsignedInt count, const Containers::ArrayView<UnsignedLong> data, const QueryResultFlags flags) {
+    CORRADE_ASSERT(count && data.size() && data.size() % count == 0,
+        "Vk::QueryPool::results(): expected data size to be a non-zero multiple of" << count << "but got" << data.size(), {});
+
+    const Result result = Result((**_device).GetQueryPoolResults(*_device, _handle, first, count, data.size()*sizeof(UnsignedLong), data.data(), data.size()/count*sizeof(UnsignedLong), VK_QUERY_RESULT_64_BIT|VkQueryResultFlags(flags)));
+    CORRADE_INTERNAL_ASSERT(result == Result::Success || result == Result::NotReady);
+    return result == Result::Success;
+}
+
+VkQueryPool QueryPool::release() {
+    const VkQueryPool handle = _handle;
+    _handle = {};
+    return handle;
+}
+
+}}
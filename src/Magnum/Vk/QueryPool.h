@@ -0,0 +1,223 @@
+#ifndef Magnum_Vk_QueryPool_h
+#define Magnum_Vk_QueryPool_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::QueryPool, enum @ref Magnum::Vk::QueryResultFlag, enum set @ref Magnum::Vk::QueryResultFlags
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/EnumSet.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Query result flag
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryResultFlagBits}.
+@see @ref QueryResultFlags, @ref QueryPool::results()
+@m_enum_values_as_keywords
+*/
+enum class QueryResultFlag: UnsignedInt {
+    /**
+     * Wait for the results to become available. Without this flag,
+     * @ref QueryPool::results() returns @cpp false @ce if any of the results
+     * isn't available yet.
+     */
+    Wait = VK_QUERY_RESULT_WAIT_BIT,
+
+    /**
+     * Write an availability value after the results of each query. The value
+     * is non-zero if the result is available and zero otherwise, in which
+     * case the result values are undefined.
+     */
+    WithAvailability = VK_QUERY_RESULT_WITH_AVAILABILITY_BIT,
+
+    /**
+     * Write partial results for queries that aren't available yet. Not
+     * allowed for @ref QueryType::Timestamp queries.
+     */
+    Partial = VK_QUERY_RESULT_PARTIAL_BIT
+};
+
+/**
+@brief Query result flags
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{QueryResultFlags}.
+@see @ref QueryPool::results()
+*/
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+
+CORRADE_ENUMSET_OPERATORS(QueryResultFlags)
+
+/**
+@brief Query pool
+@m_since_latest
+
+Wraps a @type_vk_keyword{QueryPool}, a fixed-size set of queries of a single
+@ref QueryType.
+
+@section Vk-QueryPool-creation Query pool creation
+
+The @ref QueryPoolCreateInfo takes a query type and a query count. For
+pipeline statistics queries, the set of queried statistics is passed instead
+of the type:
+
+@snippet MagnumVk.cpp QueryPool-creation
+
+@section Vk-QueryPool-usage Query pool usage
+
+Queries have to be reset with @ref CommandBuffer::resetQueryPool() before
+each use. Timestamps are then written with
+@ref CommandBuffer::writeTimestamp(), other query types are delimited by
+@ref CommandBuffer::beginQuery() and @ref CommandBuffer::endQuery(). Results
+are retrieved on the host with @ref results(), always as 64-bit values:
+
+@snippet MagnumVk.cpp QueryPool-usage
+
+To avoid stalling, query results are usually read only a few frames later,
+after the command buffer that wrote them is known to have finished. See
+@ref DebugTools::VkFrameProfiler for a ready-to-use solution.
+*/
+class MAGNUM_VK_EXPORT QueryPool {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device    Vulkan device the query pool is created on
+         * @param handle    The @type_vk{QueryPool} handle
+         * @param flags     Handle flags
+         *
+         * The @p handle is expected to be originating from @p device. Unlike
+         * a query pool created using a constructor, the Vulkan query pool is
+         * by default not deleted on destruction, use @p flags for different
+         * behavior.
+         * @see @ref release()
+         */
+        static QueryPool wrap(Device& device, VkQueryPool handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the query pool on
+         * @param info      Query pool creation info
+         *
+         * @see @fn_vk_keyword{CreateQueryPool}
+         */
+        explicit QueryPool(Device& device, const QueryPoolCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the query pool
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit QueryPool(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        QueryPool(const QueryPool&) = delete;
+
+        /** @brief Move constructor */
+        QueryPool(QueryPool&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{QueryPool} handle, unless the instance
+         * was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroyQueryPool}, @ref release()
+         */
+        ~QueryPool();
+
+        /** @brief Copying is not allowed */
+        QueryPool& operator=(const QueryPool&) = delete;
+
+        /** @brief Move assignment */
+        QueryPool& operator=(QueryPool&& other) noexcept;
+
+        /** @brief Underlying @type_vk{QueryPool} handle */
+        VkQueryPool handle() { return _handle; }
+        /** @overload */
+        operator VkQueryPool() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Retrieve query results
+         * @param first     Index of the first query
+         * @param count     Count of queries
+         * @param data      Where to put the results
+         * @param flags     Query result flags
+         * @return @cpp true @ce if all results were available, @cpp false @ce
+         *      otherwise
+         *
+         * Results of the queries are written consecutively into @p data as
+         * 64-bit values, with each query taking the same count of values ---
+         * one for timestamp and occlusion queries, one for each enabled
+         * statistic for pipeline statistics queries and one more if
+         * @ref QueryResultFlag::WithAvailability is set. Expects that
+         * @p count is non-zero and the size of @p data is a multiple of it.
+         *
+         * If @ref QueryResultFlag::Wait is not set, the function doesn't
+         * block. In that case, if some results aren't available, the function
+         * returns @cpp false @ce and the corresponding values in @p data are
+         * left untouched, unless @ref QueryResultFlag::WithAvailability or
+         * @ref QueryResultFlag::Partial is set.
+         * @see @fn_vk_keyword{GetQueryPoolResults}
+         */
+        bool results(UnsignedInt first, UnsignedInt count, Containers::ArrayView<UnsignedLong> data, QueryResultFlags flags = {});
+
+        /**
+         * @brief Release the underlying Vulkan query pool
+         *
+         * Releases ownership of the Vulkan query pool and returns its handle
+         * so @fn_vk{DestroyQueryPool} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkQueryPool release();
+
+    private:
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkQueryPool _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
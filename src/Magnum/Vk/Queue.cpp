@@ -0,0 +1,198 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Queue.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayTuple.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk {
+
+struct SubmitInfo::State {
+    Containers::ArrayTuple waitSemaphores;
+    Containers::Array<VkCommandBuffer> commandBuffers;
+    Containers::ArrayTuple signalSemaphores;
+    VkTimelineSemaphoreSubmitInfo timelineInfo{};
+};
+
+SubmitInfo::SubmitInfo(): _info{} {
+    _info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+}
+
+SubmitInfo::SubmitInfo(NoInitT) noexcept {}
+
+SubmitInfo::SubmitInfo(const VkSubmitInfo& info):
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(info) {}
+
+SubmitInfo::SubmitInfo(SubmitInfo&& other) noexcept:
+    /* Can't use {} with GCC 4.8 here because it tries to initialize the first
+       member instead of doing a copy */
+    _info(other._info),
+    _state{std::move(other._state)}
+{
+    /* Ensure the previous instance doesn't reference state that's now ours */
+    other._info.pNext = nullptr;
+    other._info.waitSemaphoreCount = 0;
+    other._info.pWaitSemaphores = nullptr;
+    other._info.pWaitDstStageMask = nullptr;
+    other._info.commandBufferCount = 0;
+    other._info.pCommandBuffers = nullptr;
+    other._info.signalSemaphoreCount = 0;
+    other._info.pSignalSemaphores = nullptr;
+}
+
+SubmitInfo::~SubmitInfo() = default;
+
+SubmitInfo& SubmitInfo::operator=(SubmitInfo&& other) noexcept {
+    using std::swap;
+    swap(other._info, _info);
+    swap(other._state, _state);
+    return *this;
+}
+
+void SubmitInfo::updateTimelineInfo() {
+    VkTimelineSemaphoreSubmitInfo& timelineInfo = _state->timelineInfo;
+    if(timelineInfo.waitSemaphoreValueCount || timelineInfo.signalSemaphoreValueCount) {
+        timelineInfo.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+        _info.pNext = &timelineInfo;
+    } else if(_info.pNext == &timelineInfo) _info.pNext = nullptr;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const PipelineStages> stages) {
+    return setWaitSemaphores(semaphores, stages, nullptr);
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<PipelineStages> stages) {
+    return setWaitSemaphores(Containers::arrayView(semaphores), Containers::arrayView(stages));
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const PipelineStages> stages, const Containers::ArrayView<const UnsignedLong> values) {
+    CORRADE_ASSERT(stages.size() == semaphores.size(),
+        "Vk::SubmitInfo::setWaitSemaphores(): expected" << semaphores.size() << "stage masks but got" << stages.size(), *this);
+    CORRADE_ASSERT(values.empty() || values.size() == semaphores.size(),
+        "Vk::SubmitInfo::setWaitSemaphores(): expected" << semaphores.size() << "values but got" << values.size(), *this);
+
+    if(!_state) _state.emplace();
+
+    Containers::ArrayView<VkSemaphore> semaphoresCopy;
+    Containers::ArrayView<VkPipelineStageFlags> stagesCopy;
+    Containers::ArrayView<UnsignedLong> valuesCopy;
+    _state->waitSemaphores = Containers::ArrayTuple{
+        {NoInit, semaphores.size(), semaphoresCopy},
+        {NoInit, semaphores.size(), stagesCopy},
+        {NoInit, values.size(), valuesCopy}
+    };
+    Utility::copy(semaphores, semaphoresCopy);
+    for(std::size_t i = 0; i != stages.size(); ++i)
+        stagesCopy[i] = VkPipelineStageFlags(stages[i]);
+    Utility::copy(values, valuesCopy);
+
+    _info.waitSemaphoreCount = semaphores.size();
+    _info.pWaitSemaphores = semaphoresCopy;
+    _info.pWaitDstStageMask = stagesCopy;
+    _state->timelineInfo.waitSemaphoreValueCount = values.size();
+    _state->timelineInfo.pWaitSemaphoreValues = valuesCopy;
+    updateTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setWaitSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<PipelineStages> stages, const std::initializer_list<UnsignedLong> values) {
+    return setWaitSemaphores(Containers::arrayView(semaphores), Containers::arrayView(stages), Containers::arrayView(values));
+}
+
+SubmitInfo& SubmitInfo::setCommandBuffers(const Containers::ArrayView<const VkCommandBuffer> buffers) {
+    if(!_state) _state.emplace();
+
+    _state->commandBuffers = Containers::Array<VkCommandBuffer>{NoInit, buffers.size()};
+    Utility::copy(buffers, _state->commandBuffers);
+
+    _info.commandBufferCount = buffers.size();
+    _info.pCommandBuffers = _state->commandBuffers;
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setCommandBuffers(const std::initializer_list<VkCommandBuffer> buffers) {
+    return setCommandBuffers(Containers::arrayView(buffers));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores) {
+    return setSignalSemaphores(semaphores, nullptr);
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<VkSemaphore> semaphores) {
+    return setSignalSemaphores(Containers::arrayView(semaphores));
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const Containers::ArrayView<const VkSemaphore> semaphores, const Containers::ArrayView<const UnsignedLong> values) {
+    CORRADE_ASSERT(values.empty() || values.size() == semaphores.size(),
+        "Vk::SubmitInfo::setSignalSemaphores(): expected" << semaphores.size() << "values but got" << values.size(), *this);
+
+    if(!_state) _state.emplace();
+
+    Containers::ArrayView<VkSemaphore> semaphoresCopy;
+    Containers::ArrayView<UnsignedLong> valuesCopy;
+    _state->signalSemaphores = Containers::ArrayTuple{
+        {NoInit, semaphores.size(), semaphoresCopy},
+        {NoInit, values.size(), valuesCopy}
+    };
+    Utility::copy(semaphores, semaphoresCopy);
+    Utility::copy(values, valuesCopy);
+
+    _info.signalSemaphoreCount = semaphores.size();
+    _info.pSignalSemaphores = semaphoresCopy;
+    _state->timelineInfo.signalSemaphoreValueCount = values.size();
+    _state->timelineInfo.pSignalSemaphoreValues = valuesCopy;
+    updateTimelineInfo();
+    return *this;
+}
+
+SubmitInfo& SubmitInfo::setSignalSemaphores(const std::initializer_list<VkSemaphore> semaphores, const std::initializer_list<UnsignedLong> values) {
+    return setSignalSemaphores(Containers::arrayView(semaphores), Containers::arrayView(values));
+}
+
+void Queue::submit(const Containers::ArrayView<const Containers::Reference<const SubmitInfo>> infos, const VkFence fence) {
+    Containers::Array<VkSubmitInfo> vkInfos{NoInit, infos.size()};
+    for(std::size_t i = 0; i != infos.size(); ++i)
+        vkInfos[i] = **infos[i];
+
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).QueueSubmit(_handle, vkInfos.size(), vkInfos, fence));
+}
+
+void Queue::submit(const std::initializer_list<Containers::Reference<const SubmitInfo>> infos, const VkFence fence) {
+    submit(Containers::arrayView(infos), fence);
+}
+
+void Queue::waitIdle() {
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS((**_device).QueueWaitIdle(_handle));
+}
+
+}}
@@ -25,24 +25,235 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+
 /** @file
- * @brief Class @ref Magnum::Vk::Queue
+ * @brief Class @ref Magnum::Vk::Queue, @ref Magnum::Vk::SubmitInfo
  * @m_since_latest
  */
 
+#include <initializer_list>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Containers/Reference.h>
+
 #include "Magnum/Tags.h"
+#include "Magnum/Vk/Pipeline.h"
 #include "Magnum/Vk/Vk.h"
 #include "Magnum/Vk/Vulkan.h"
 #include "Magnum/Vk/visibility.h"
 
 namespace Magnum { namespace Vk {
 
+/**
+@brief Queue submission info
+@m_since_latest
+
+Wraps a @type_vk_keyword{SubmitInfo} and
+@type_vk_keyword{TimelineSemaphoreSubmitInfo}. A single instance describes one
+batch of command buffers together with semaphores the batch waits on before
+executing and semaphores it signals after it finishes. See
+@ref Vk-Queue-submit "Queue submission" for usage information.
+
+All arrays passed to the setters are copied into the instance, so the data
+don't need to stay in scope until @ref Queue::submit() is called.
+*/
+class MAGNUM_VK_EXPORT SubmitInfo {
+    public:
+        /**
+         * @brief Constructor
+         *
+         * The following @type_vk{SubmitInfo} fields are pre-filled in
+         * addition to `sType`, everything else is zero-filled:
+         *
+         * -    *(none)*
+         *
+         * Use @ref setWaitSemaphores(), @ref setCommandBuffers() and
+         * @ref setSignalSemaphores() to fill the rest.
+         */
+        explicit SubmitInfo();
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit SubmitInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit SubmitInfo(const VkSubmitInfo& info);
+
+        /** @brief Copying is not allowed */
+        SubmitInfo(const SubmitInfo&) = delete;
+
+        /** @brief Move constructor */
+        SubmitInfo(SubmitInfo&& other) noexcept;
+
+        ~SubmitInfo();
+
+        /** @brief Copying is not allowed */
+        SubmitInfo& operator=(const SubmitInfo&) = delete;
+
+        /** @brief Move assignment */
+        SubmitInfo& operator=(SubmitInfo&& other) noexcept;
+
+        /**
+         * @brief Set semaphores to wait on
+         * @param semaphores    Semaphores to wait on before executing the
+         *      command buffers
+         * @param stages        Pipeline stages at which each corresponding
+         *      wait happens. Expected to have the same size as
+         *      @p semaphores.
+         * @return Reference to self (for method chaining)
+         *
+         * The following @type_vk{SubmitInfo} fields are set by this function:
+         *
+         * -    `waitSemaphoreCount` and `pWaitSemaphores` to a copy of
+         *      @p semaphores
+         * -    `pWaitDstStageMask` to a copy of @p stages
+         *
+         * If any values were set for timeline semaphores by a previous call
+         * to @ref setWaitSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const PipelineStages>, Containers::ArrayView<const UnsignedLong>),
+         * they're cleared.
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const PipelineStages> stages);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<PipelineStages> stages);
+
+        /**
+         * @brief Set semaphores to wait on, including timeline semaphore values
+         * @param semaphores    Semaphores to wait on before executing the
+         *      command buffers
+         * @param stages        Pipeline stages at which each corresponding
+         *      wait happens. Expected to have the same size as
+         *      @p semaphores.
+         * @param values        Values to wait for. Expected to have the same
+         *      size as @p semaphores, values corresponding to
+         *      @ref SemaphoreType::Binary semaphores are ignored.
+         * @return Reference to self (for method chaining)
+         *
+         * In addition to what's done in
+         * @ref setWaitSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const PipelineStages>),
+         * a @type_vk{TimelineSemaphoreSubmitInfo} structure is connected to
+         * the `pNext` chain, with the following fields set:
+         *
+         * -    `waitSemaphoreValueCount` and `pWaitSemaphoreValues` to a copy
+         *      of @p values
+         *
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore} and
+         *      @ref DeviceFeature::TimelineSemaphore enabled on the device
+         */
+        SubmitInfo& setWaitSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const PipelineStages> stages, Containers::ArrayView<const UnsignedLong> values);
+        /** @overload */
+        SubmitInfo& setWaitSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<PipelineStages> stages, std::initializer_list<UnsignedLong> values);
+
+        /**
+         * @brief Set command buffers to execute
+         * @return Reference to self (for method chaining)
+         *
+         * The following @type_vk{SubmitInfo} fields are set by this function:
+         *
+         * -    `commandBufferCount` and `pCommandBuffers` to a copy of
+         *      @p buffers
+         */
+        SubmitInfo& setCommandBuffers(Containers::ArrayView<const VkCommandBuffer> buffers);
+        /** @overload */
+        SubmitInfo& setCommandBuffers(std::initializer_list<VkCommandBuffer> buffers);
+
+        /**
+         * @brief Set semaphores to signal
+         * @param semaphores    Semaphores to signal once all command buffers
+         *      finish executing
+         * @return Reference to self (for method chaining)
+         *
+         * The following @type_vk{SubmitInfo} fields are set by this function:
+         *
+         * -    `signalSemaphoreCount` and `pSignalSemaphores` to a copy of
+         *      @p semaphores
+         *
+         * If any values were set for timeline semaphores by a previous call
+         * to @ref setSignalSemaphores(Containers::ArrayView<const VkSemaphore>, Containers::ArrayView<const UnsignedLong>),
+         * they're cleared.
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const VkSemaphore> semaphores);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<VkSemaphore> semaphores);
+
+        /**
+         * @brief Set semaphores to signal, including timeline semaphore values
+         * @param semaphores    Semaphores to signal once all command buffers
+         *      finish executing
+         * @param values        Values to signal. Expected to have the same
+         *      size as @p semaphores, values corresponding to
+         *      @ref SemaphoreType::Binary semaphores are ignored.
+         * @return Reference to self (for method chaining)
+         *
+         * In addition to what's done in
+         * @ref setSignalSemaphores(Containers::ArrayView<const VkSemaphore>),
+         * a @type_vk{TimelineSemaphoreSubmitInfo} structure is connected to
+         * the `pNext` chain, with the following fields set:
+         *
+         * -    `signalSemaphoreValueCount` and `pSignalSemaphoreValues` to a
+         *      copy of @p values
+         *
+         * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore} and
+         *      @ref DeviceFeature::TimelineSemaphore enabled on the device
+         */
+        SubmitInfo& setSignalSemaphores(Containers::ArrayView<const VkSemaphore> semaphores, Containers::ArrayView<const UnsignedLong> values);
+        /** @overload */
+        SubmitInfo& setSignalSemaphores(std::initializer_list<VkSemaphore> semaphores, std::initializer_list<UnsignedLong> values);
+
+        /** @brief Underlying @type_vk{SubmitInfo} structure */
+        VkSubmitInfo& operator*() { return _info; }
+        /** @overload */
+        const VkSubmitInfo& operator*() const { return _info; }
+        /** @overload */
+        VkSubmitInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkSubmitInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkSubmitInfo*() const { return &_info; }
+
+    private:
+        /* Connects the timeline info to the pNext chain if there's any value
+           to pass, disconnects it otherwise */
+        MAGNUM_VK_LOCAL void updateTimelineInfo();
+
+        VkSubmitInfo _info;
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
 /**
 @brief Queue
 @m_since_latest
 
 Wraps a @type_vk_keyword{Queue}. See @ref Device class docs for an introduction
 on how to create a queue.
+
+@section Vk-Queue-submit Queue submission
+
+Work is submitted to a queue in batches described by @ref SubmitInfo. Each
+batch lists command buffers to execute, @ref Semaphore "Semaphore"s to wait on
+before the execution reaches given @ref PipelineStages and semaphores to
+signal once it finishes. A @ref Fence can be passed to @ref submit() to get
+notified on the host once all batches finish. The submission itself doesn't
+block, so with a fence per frame in flight the host can record frame
+@f$ N + 1 @f$ while the GPU is still busy with frame @f$ N @f$:
+
+@snippet MagnumVk.cpp Queue-submit
+
+With timeline semaphores, the per-batch wait and signal values are specified
+together with the semaphores, which allows for example a transfer queue and a
+graphics queue to overlap without any fences involved:
+
+@snippet MagnumVk.cpp Queue-submit-timeline
+
 @see @ref DeviceCreateInfo::addQueues()
 */
 class MAGNUM_VK_EXPORT Queue {
@@ -77,6 +288,28 @@ class MAGNUM_VK_EXPORT Queue {
         /** @overload */
         operator VkQueue() { return _handle; }
 
+        /**
+         * @brief Submit work to the queue
+         * @param infos     Submission batches
+         * @param fence     Fence to signal once all batches finish, or
+         *      @cpp VK_NULL_HANDLE @ce
+         *
+         * Doesn't wait for the work to finish. The @p fence, if passed, is
+         * expected to be unsignaled.
+         * @see @fn_vk_keyword{QueueSubmit}, @ref Fence::wait(),
+         *      @ref Fence::reset()
+         */
+        void submit(Containers::ArrayView<const Containers::Reference<const SubmitInfo>> infos, VkFence fence = {});
+        /** @overload */
+        void submit(std::initializer_list<Containers::Reference<const SubmitInfo>> infos, VkFence fence = {});
+
+        /**
+         * @brief Wait for the queue to become idle
+         *
+         * @see @fn_vk_keyword{QueueWaitIdle}
+         */
+        void waitIdle();
+
     private:
         /* Can't be a reference because of the NoCreate constructor */
         Device* _device;
@@ -45,6 +45,7 @@ Debug& operator<<(Debug& debug, const Result value) {
         _c(ThreadDone)
         _c(OperationDeferred)
         _c(OperationNotDeferred)
+        _c(Suboptimal)
         _c(ErrorOutOfHostMemory)
         _c(ErrorOutOfDeviceMemory)
         _c(ErrorInitializationFailed)
@@ -62,6 +63,9 @@ Debug& operator<<(Debug& debug, const Result value) {
         _c(ErrorInvalidExternalHandle)
         _c(ErrorFragmentation)
         _c(ErrorInvalidOpaqueCaptureAddress)
+        _c(ErrorSurfaceLost)
+        _c(ErrorNativeWindowInUse)
+        _c(ErrorOutOfDate)
         _c(ErrorValidationFailed)
         #undef _c
         /* LCOV_EXCL_STOP */
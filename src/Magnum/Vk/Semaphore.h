@@ -0,0 +1,212 @@
+#ifndef Magnum_Vk_Semaphore_h
+#define Magnum_Vk_Semaphore_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Semaphore
+ * @m_since_latest
+ */
+
+#include "Magnum/Tags.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+namespace Implementation { struct DeviceState; }
+
+/**
+@brief Semaphore
+@m_since_latest
+
+Wraps a @type_vk_keyword{Semaphore}, which is used for synchronizing work
+submitted to one or more @ref Queue "Queue"s.
+
+@section Vk-Semaphore-creation Semaphore creation
+
+By default, a @ref SemaphoreType::Binary semaphore is created. Binary
+semaphores are signaled and waited on only by the device, in the
+@ref SubmitInfo::setSignalSemaphores() and
+@ref SubmitInfo::setWaitSemaphores() lists passed to @ref Queue::submit(), and
+are commonly used to order work across different queues --- for example a
+graphics queue waiting on uploads done on a transfer queue:
+
+@snippet MagnumVk.cpp Semaphore-creation
+
+@section Vk-Semaphore-timeline Timeline semaphores
+
+With Vulkan 1.2 or @vk_extension{KHR,timeline_semaphore} and
+@ref DeviceFeature::TimelineSemaphore enabled, a @ref SemaphoreType::Timeline
+semaphore can be created instead. It has a monotonically increasing 64-bit
+value that the device signals and waits for in a submit, with the values
+specified in @ref SubmitInfo::setSignalSemaphores() and
+@ref SubmitInfo::setWaitSemaphores(). The host can query the value using
+@ref value(), wait for a particular value with @ref wait() and
+@ref signal() a value as well. A single timeline semaphore can thus replace a
+whole set of per-frame fences:
+
+@snippet MagnumVk.cpp Semaphore-timeline
+
+@see @ref Fence
+*/
+class MAGNUM_VK_EXPORT Semaphore {
+    public:
+        /**
+         * @brief Wrap existing Vulkan handle
+         * @param device        Vulkan device the semaphore is created on
+         * @param handle        The @type_vk{Semaphore} handle
+         * @param flags         Handle flags
+         *
+         * The @p handle is expected to be of an existing Vulkan semaphore.
+         * Unlike a semaphore created using a constructor, the Vulkan
+         * semaphore is by default not deleted on destruction, use @p flags
+         * for different behavior.
+         * @see @ref release()
+         */
+        static Semaphore wrap(Device& device, VkSemaphore handle, HandleFlags flags = {});
+
+        /**
+         * @brief Constructor
+         * @param device    Vulkan device to create the semaphore on
+         * @param info      Semaphore creation info
+         *
+         * @see @fn_vk_keyword{CreateSemaphore}
+         */
+        explicit Semaphore(Device& device, const SemaphoreCreateInfo& info);
+
+        /**
+         * @brief Construct without creating the semaphore
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Semaphore(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        Semaphore(const Semaphore&) = delete;
+
+        /** @brief Move constructor */
+        Semaphore(Semaphore&& other) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{Semaphore} handle, unless the
+         * instance was created using @ref wrap() without
+         * @ref HandleFlag::DestroyOnDestruction specified.
+         * @see @fn_vk_keyword{DestroySemaphore}, @ref release()
+         */
+        ~Semaphore();
+
+        /** @brief Copying is not allowed */
+        Semaphore& operator=(const Semaphore&) = delete;
+
+        /** @brief Move assignment */
+        Semaphore& operator=(Semaphore&& other) noexcept;
+
+        /** @brief Underlying @type_vk{Semaphore} handle */
+        VkSemaphore handle() { return _handle; }
+        /** @overload */
+        operator VkSemaphore() { return _handle; }
+
+        /** @brief Handle flags */
+        HandleFlags handleFlags() const { return _flags; }
+
+        /**
+         * @brief Current timeline semaphore value
+         *
+         * Expects that the semaphore was created as
+         * @ref SemaphoreType::Timeline. Doesn't block.
+         * @see @fn_vk_keyword{GetSemaphoreCounterValue}
+         */
+        UnsignedLong value();
+
+        /**
+         * @brief Signal a timeline semaphore value from the host
+         *
+         * Expects that the semaphore was created as
+         * @ref SemaphoreType::Timeline and @p value is larger than the
+         * current value and all values used in pending signal operations.
+         * @see @fn_vk_keyword{SignalSemaphore}
+         */
+        void signal(UnsignedLong value);
+
+        /**
+         * @brief Wait for a timeline semaphore to reach given value
+         * @param value     Value to wait for
+         * @param timeout   Timeout in nanoseconds
+         * @return @cpp true @ce if the semaphore reached @p value,
+         *      @cpp false @ce if the wait timed out
+         *
+         * Expects that the semaphore was created as
+         * @ref SemaphoreType::Timeline.
+         * @see @fn_vk_keyword{WaitSemaphores}
+         */
+        bool wait(UnsignedLong value, UnsignedLong timeout);
+
+        /**
+         * @brief Wait indefinitely for a timeline semaphore to reach given value
+         *
+         * Equivalent to calling @ref wait(UnsignedLong, UnsignedLong) with
+         * the largest possible timeout.
+         */
+        void wait(UnsignedLong value);
+
+        /**
+         * @brief Release the underlying Vulkan semaphore
+         *
+         * Releases ownership of the Vulkan semaphore and returns its handle
+         * so @fn_vk{DestroySemaphore} is not called on destruction. The
+         * internal state is then equivalent to moved-from state.
+         * @see @ref wrap()
+         */
+        VkSemaphore release();
+
+    private:
+        friend Implementation::DeviceState;
+
+        MAGNUM_VK_LOCAL static VkResult getValueImplementationKHR(Device& device, VkSemaphore semaphore, UnsignedLong* value);
+        MAGNUM_VK_LOCAL static VkResult getValueImplementation12(Device& device, VkSemaphore semaphore, UnsignedLong* value);
+
+        MAGNUM_VK_LOCAL static VkResult signalImplementationKHR(Device& device, const VkSemaphoreSignalInfo& info);
+        MAGNUM_VK_LOCAL static VkResult signalImplementation12(Device& device, const VkSemaphoreSignalInfo& info);
+
+        MAGNUM_VK_LOCAL static VkResult waitImplementationKHR(Device& device, const VkSemaphoreWaitInfo& info, UnsignedLong timeout);
+        MAGNUM_VK_LOCAL static VkResult waitImplementation12(Device& device, const VkSemaphoreWaitInfo& info, UnsignedLong timeout);
+
+        /* Can't be a reference because of the NoCreate constructor */
+        Device* _device;
+
+        VkSemaphore _handle;
+        HandleFlags _flags;
+};
+
+}}
+
+#endif
@@ -0,0 +1,151 @@
+#ifndef Magnum_Vk_SemaphoreCreateInfo_h
+#define Magnum_Vk_SemaphoreCreateInfo_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::SemaphoreCreateInfo, enum @ref Magnum::Vk::SemaphoreType
+ * @m_since_latest
+ */
+
+#include "Magnum/Tags.h"
+#include "Magnum/Magnum.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/Vulkan.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Semaphore type
+@m_since_latest
+
+Wraps a @type_vk_keyword{SemaphoreType}.
+@m_enum_values_as_keywords
+@see @ref SemaphoreCreateInfo::SemaphoreCreateInfo(SemaphoreType, UnsignedLong)
+*/
+enum class SemaphoreType: Int {
+    /**
+     * Binary semaphore, having either a signaled or an unsignaled state. Can
+     * be signaled and waited on only by the device.
+     */
+    Binary = VK_SEMAPHORE_TYPE_BINARY,
+
+    /**
+     * Timeline semaphore, having a monotonically increasing 64-bit payload.
+     * Can be signaled and waited on by both the host and the device.
+     * @requires_vk12 Extension @vk_extension{KHR,timeline_semaphore} and
+     *      @ref DeviceFeature::TimelineSemaphore enabled on the device
+     */
+    Timeline = VK_SEMAPHORE_TYPE_TIMELINE
+};
+
+/**
+@brief Semaphore creation info
+@m_since_latest
+
+Wraps a @type_vk_keyword{SemaphoreCreateInfo} and
+@type_vk_keyword{SemaphoreTypeCreateInfo}. See
+@ref Vk-Semaphore-creation "Semaphore creation" for usage information.
+*/
+class MAGNUM_VK_EXPORT SemaphoreCreateInfo {
+    public:
+        /**
+         * @brief Constructor
+         * @param type          Semaphore type
+         * @param initialValue  Initial payload value. Used only if @p type is
+         *      @ref SemaphoreType::Timeline, expected to be @cpp 0 @ce
+         *      otherwise.
+         *
+         * The following @type_vk{SemaphoreCreateInfo} fields are pre-filled
+         * in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `pNext` to a @type_vk{SemaphoreTypeCreateInfo} structure if
+         *      @p type is @ref SemaphoreType::Timeline
+         *
+         * The following @type_vk{SemaphoreTypeCreateInfo} fields are
+         * pre-filled in addition to `sType`, everything else is zero-filled:
+         *
+         * -    `semaphoreType` to @p type
+         * -    `initialValue`
+         */
+        explicit SemaphoreCreateInfo(SemaphoreType type = SemaphoreType::Binary, UnsignedLong initialValue = 0);
+
+        /**
+         * @brief Construct without initializing the contents
+         *
+         * Note that not even the `sType` field is set --- the structure has to
+         * be fully initialized afterwards in order to be usable.
+         */
+        explicit SemaphoreCreateInfo(NoInitT) noexcept;
+
+        /**
+         * @brief Construct from existing data
+         *
+         * Copies the existing values verbatim, pointers are kept unchanged
+         * without taking over the ownership. Modifying the newly created
+         * instance will not modify the original data nor the pointed-to data.
+         */
+        explicit SemaphoreCreateInfo(const VkSemaphoreCreateInfo& info);
+
+        /**
+         * @brief Copying is not allowed
+         *
+         * The structure may contain a pointer to itself.
+         */
+        SemaphoreCreateInfo(const SemaphoreCreateInfo&) = delete;
+
+        /** @brief Moving is not allowed */
+        SemaphoreCreateInfo(SemaphoreCreateInfo&&) = delete;
+
+        /** @brief Copying is not allowed */
+        SemaphoreCreateInfo& operator=(const SemaphoreCreateInfo&) = delete;
+
+        /** @brief Moving is not allowed */
+        SemaphoreCreateInfo& operator=(SemaphoreCreateInfo&&) = delete;
+
+        /** @brief Underlying @type_vk{SemaphoreCreateInfo} structure */
+        VkSemaphoreCreateInfo& operator*() { return _info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo& operator*() const { return _info; }
+        /** @overload */
+        VkSemaphoreCreateInfo* operator->() { return &_info; }
+        /** @overload */
+        const VkSemaphoreCreateInfo* operator->() const { return &_info; }
+        /** @overload */
+        operator const VkSemaphoreCreateInfo*() const { return &_info; }
+
+    private:
+        VkSemaphoreCreateInfo _info;
+        VkSemaphoreTypeCreateInfo _typeInfo;
+};
+
+}}
+
+/* Make the definition complete -- it doesn't make sense to have a CreateInfo
+   without the corresponding object anyway. */
+#include "Magnum/Vk/Semaphore.h"
+
+#endif
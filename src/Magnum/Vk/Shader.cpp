@@ -27,6 +27,8 @@
 #include "ShaderCreateInfo.h"
 
 #include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/EnumSet.hpp>
+#include <Corrade/Utility/Debug.h>
 
 #include "Magnum/Vk/Assert.h"
 #include "Magnum/Vk/Device.h"
@@ -115,4 +117,34 @@ VkShaderModule Shader::release() {
     return handle;
 }
 
+Debug& operator<<(Debug& debug, const ShaderStage value) {
+    debug << "Vk::ShaderStage" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::ShaderStage::value: return debug << "::" << Debug::nospace << #value;
+        _c(Vertex)
+        _c(TessellationControl)
+        _c(TessellationEvaluation)
+        _c(Geometry)
+        _c(Fragment)
+        _c(Compute)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    /* Flag bits should be in hex, unlike plain values */
+    return debug << "(" << Debug::nospace << reinterpret_cast<void*>(UnsignedInt(value)) << Debug::nospace << ")";
+}
+
+Debug& operator<<(Debug& debug, const ShaderStages value) {
+    return Containers::enumSetDebugOutput(debug, value, "Vk::ShaderStages{}", {
+        Vk::ShaderStage::Vertex,
+        Vk::ShaderStage::TessellationControl,
+        Vk::ShaderStage::TessellationEvaluation,
+        Vk::ShaderStage::Geometry,
+        Vk::ShaderStage::Fragment,
+        Vk::ShaderStage::Compute});
+}
+
 }}
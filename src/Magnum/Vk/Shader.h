@@ -26,10 +26,12 @@
 */
 
 /** @file
- * @brief Class @ref Magnum::Vk::Shader
+ * @brief Class @ref Magnum::Vk::Shader, enum @ref Magnum::Vk::ShaderStage, enum set @ref Magnum::Vk::ShaderStages
  * @m_since_latest
  */
 
+#include <Corrade/Containers/EnumSet.h>
+
 #include "Magnum/Magnum.h"
 #include "Magnum/Tags.h"
 #include "Magnum/Vk/Handle.h"
@@ -39,6 +41,59 @@
 
 namespace Magnum { namespace Vk {
 
+/**
+@brief Shader stage
+@m_since_latest
+
+Wraps @type_vk_keyword{ShaderStageFlagBits}.
+@m_enum_values_as_keywords
+@see @ref ShaderStages,
+    @ref GraphicsPipelineCreateInfo::addShader(),
+    @ref PipelineLayoutCreateInfo::addPushConstantRange()
+*/
+enum class ShaderStage: UnsignedInt {
+    /** Vertex stage */
+    Vertex = VK_SHADER_STAGE_VERTEX_BIT,
+
+    /** Tessellation control stage */
+    TessellationControl = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+
+    /** Tessellation evaluation stage */
+    TessellationEvaluation = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
+
+    /** Geometry stage */
+    Geometry = VK_SHADER_STAGE_GEOMETRY_BIT,
+
+    /** Fragment stage */
+    Fragment = VK_SHADER_STAGE_FRAGMENT_BIT,
+
+    /** Compute stage */
+    Compute = VK_SHADER_STAGE_COMPUTE_BIT
+};
+
+/**
+@debugoperatorenum{ShaderStage}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, ShaderStage value);
+
+/**
+@brief Shader stages
+@m_since_latest
+
+Type-safe wrapper for @type_vk_keyword{ShaderStageFlags}.
+@see @ref PipelineLayoutCreateInfo::addPushConstantRange()
+*/
+typedef Containers::EnumSet<ShaderStage> ShaderStages;
+
+CORRADE_ENUMSET_OPERATORS(ShaderStages)
+
+/**
+@debugoperatorenum{ShaderStages}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, ShaderStages value);
+
 /**
 @brief Shader
 @m_since_latest
@@ -0,0 +1,300 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StagingUploader.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+
+namespace Magnum { namespace Vk {
+
+namespace {
+
+struct Slot {
+    explicit Slot(NoCreateT): buffer{NoCreate}, commandBuffer{NoCreate} {}
+
+    /* The mapping has to go away before the buffer memory, so it's
+       declared after */
+    Buffer buffer;
+    Containers::Array<char, MemoryMapDeleter> mapped;
+    CommandBuffer commandBuffer;
+    /* Semaphore value signaled by the last batch using this slot, 0 if it
+       wasn't submitted yet */
+    UnsignedLong value{};
+};
+
+}
+
+struct StagingUploader::State {
+    explicit State(Device& device, Queue& queue, UnsignedInt queueFamily, UnsignedInt destinationQueueFamily, UnsignedLong bufferSize, UnsignedInt bufferCount);
+
+    Slot& current() { return slots[currentSlot]; }
+
+    Device& device;
+    Queue queue;
+    UnsignedInt queueFamily, destinationQueueFamily;
+    UnsignedLong bufferSize;
+
+    Semaphore semaphore;
+    /* Has to be destroyed after the command buffers in the slots */
+    CommandPool pool;
+    Containers::Array<Slot> slots;
+
+    UnsignedInt currentSlot{};
+    UnsignedLong offset{}, submitted{};
+    bool recording{};
+
+    /* Acquire barriers for uploads in the batch that's being recorded and
+       for uploads flushed since the last acquire() */
+    Containers::Array<VkBufferMemoryBarrier> pendingBufferBarriers, flushedBufferBarriers;
+    Containers::Array<VkImageMemoryBarrier> pendingImageBarriers, flushedImageBarriers;
+};
+
+StagingUploader::State::State(Device& device, Queue& queue, const UnsignedInt queueFamily, const UnsignedInt destinationQueueFamily, const UnsignedLong bufferSize, const UnsignedInt bufferCount): device(device), queue(queue), queueFamily{queueFamily}, destinationQueueFamily{destinationQueueFamily}, bufferSize{bufferSize}, semaphore{device, SemaphoreCreateInfo{SemaphoreType::Timeline}}, pool{device, CommandPoolCreateInfo{queueFamily, CommandPoolCreateInfo::Flag::Transient|CommandPoolCreateInfo::Flag::ResetCommandBuffer}} {
+    slots = Containers::Array<Slot>{Containers::DirectInit, bufferCount, NoCreate};
+    for(Slot& slot: slots) {
+        slot.buffer = Buffer{device, BufferCreateInfo{BufferUsage::TransferSource, bufferSize}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+        slot.mapped = slot.buffer.dedicatedMemory().map();
+        slot.commandBuffer = pool.allocate();
+    }
+}
+
+StagingUploader::StagingUploader(Device& device, Queue& queue, const UnsignedInt queueFamily, const UnsignedInt destinationQueueFamily, const UnsignedLong bufferSize, const UnsignedInt bufferCount) {
+    CORRADE_ASSERT(bufferSize && bufferCount,
+        "Vk::StagingUploader: expected non-zero buffer size and count, got" << bufferSize << "and" << bufferCount, );
+
+    _state.emplace(device, queue, queueFamily, destinationQueueFamily, bufferSize, bufferCount);
+}
+
+StagingUploader::StagingUploader(NoCreateT) noexcept {}
+
+StagingUploader::StagingUploader(StagingUploader&&) noexcept = default;
+
+StagingUploader::~StagingUploader() {
+    /* The staging buffers and command buffers can't go away while the GPU
+       is still copying from them */
+    if(_state && _state->submitted)
+        _state->semaphore.wait(_state->submitted);
+}
+
+StagingUploader& StagingUploader::operator=(StagingUploader&&) noexcept = default;
+
+UnsignedLong StagingUploader::bufferSize() const {
+    return _state ? _state->bufferSize : 0;
+}
+
+UnsignedInt StagingUploader::bufferCount() const {
+    return _state ? UnsignedInt(_state->slots.size()) : 0;
+}
+
+Semaphore& StagingUploader::semaphore() {
+    return _state->semaphore;
+}
+
+UnsignedLong StagingUploader::submittedValue() const {
+    return _state ? _state->submitted : 0;
+}
+
+UnsignedLong StagingUploader::reserve(const UnsignedLong size, const UnsignedLong alignment) {
+    State& state = *_state;
+
+    /* Not enough space left in the current batch, submit it and continue
+       with the next slot */
+    UnsignedLong offset = (state.offset + alignment - 1)/alignment*alignment;
+    if(state.recording && offset + size > state.bufferSize) {
+        flush();
+        offset = 0;
+    }
+
+    /* Start a new batch. If the slot was used before, wait until the GPU is
+       done copying from it. */
+    if(!state.recording) {
+        Slot& slot = state.current();
+        if(slot.value) state.semaphore.wait(slot.value);
+        slot.commandBuffer.reset();
+        slot.commandBuffer.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit});
+        state.recording = true;
+    }
+
+    state.offset = offset + size;
+    return offset;
+}
+
+void StagingUploader::upload(Buffer& buffer, const UnsignedLong offset, const Containers::ArrayView<const void> data) {
+    State& state = *_state;
+
+    const Containers::ArrayView<const char> src{static_cast<const char*>(data.data()), data.size()};
+    for(std::size_t done = 0; done != src.size(); ) {
+        /* Fill whatever is left in the current staging buffer, the rest goes
+           to the next batch */
+        if(state.recording && state.offset == state.bufferSize) flush();
+        const UnsignedLong size = Math::min(UnsignedLong(src.size() - done), state.recording ? state.bufferSize - state.offset : state.bufferSize);
+        const UnsignedLong stagingOffset = reserve(size, 1);
+        Slot& slot = state.current();
+
+        Utility::copy(src.slice(done, done + size), slot.mapped.slice(stagingOffset, stagingOffset + size));
+
+        VkBufferCopy region{};
+        region.srcOffset = stagingOffset;
+        region.dstOffset = offset + done;
+        region.size = size;
+        state.device->CmdCopyBuffer(slot.commandBuffer, slot.buffer, buffer, 1, &region);
+
+        /* With the same queue family the semaphore wait on the destination
+           queue is enough, otherwise the range has to be released to the
+           destination family and acquired there in acquire() */
+        if(state.queueFamily != state.destinationQueueFamily) {
+            VkBufferMemoryBarrier barrier{};
+            barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.srcQueueFamilyIndex = state.queueFamily;
+            barrier.dstQueueFamilyIndex = state.destinationQueueFamily;
+            barrier.buffer = buffer;
+            barrier.offset = offset + done;
+            barrier.size = size;
+            state.device->CmdPipelineBarrier(slot.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+            arrayAppend(state.pendingBufferBarriers, barrier);
+        }
+
+        done += size;
+    }
+}
+
+void StagingUploader::upload(Image& image, const ImageView2D& data, const ImageLayout layout, const Int level) {
+    State& state = *_state;
+
+    const std::size_t pixelSize = data.pixelSize();
+    const UnsignedLong size = pixelSize*data.size().product();
+    CORRADE_ASSERT(size <= state.bufferSize,
+        "Vk::StagingUploader::upload(): image of" << size << "bytes doesn't fit into a staging buffer of" << state.bufferSize << "bytes", );
+
+    /* The buffer offset has to be a multiple of both 4 and the texel size */
+    const UnsignedLong stagingOffset = reserve(size, 4*pixelSize);
+    Slot& slot = state.current();
+
+    /* Copy the rows tightly packed, so the copy region doesn't need to
+       describe the source pixel storage */
+    Utility::copy(data.pixels(), Containers::StridedArrayView3D<char>{
+        slot.mapped.slice(stagingOffset, stagingOffset + size),
+        {std::size_t(data.size().y()), std::size_t(data.size().x()), pixelSize}});
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = level;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.layerCount = 1;
+    state.device->CmdPipelineBarrier(slot.commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = stagingOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = level;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {UnsignedInt(data.size().x()), UnsignedInt(data.size().y()), 1};
+    state.device->CmdCopyBufferToImage(slot.commandBuffer, slot.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+    /* Transition to the final layout. If the queue families differ, this is
+       the release half of the ownership transfer, with the acquire half
+       recorded in acquire() doing the same layout transition. */
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = 0;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VkImageLayout(layout);
+    if(state.queueFamily != state.destinationQueueFamily) {
+        barrier.srcQueueFamilyIndex = state.queueFamily;
+        barrier.dstQueueFamilyIndex = state.destinationQueueFamily;
+    }
+    state.device->CmdPipelineBarrier(slot.commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    if(state.queueFamily != state.destinationQueueFamily) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+        arrayAppend(state.pendingImageBarriers, barrier);
+    }
+}
+
+UnsignedLong StagingUploader::flush() {
+    State& state = *_state;
+    if(!state.recording) return state.submitted;
+
+    Slot& slot = state.current();
+    slot.commandBuffer.end();
+
+    const UnsignedLong value = ++state.submitted;
+    SubmitInfo info;
+    info.setCommandBuffers({slot.commandBuffer})
+        .setSignalSemaphores({state.semaphore}, {value});
+    state.queue.submit({info});
+    slot.value = value;
+
+    state.currentSlot = (state.currentSlot + 1) % state.slots.size();
+    state.offset = 0;
+    state.recording = false;
+
+    /* The uploads from this batch can be acquired now */
+    arrayAppend(state.flushedBufferBarriers, state.pendingBufferBarriers);
+    arrayAppend(state.flushedImageBarriers, state.pendingImageBarriers);
+    state.pendingBufferBarriers = {};
+    state.pendingImageBarriers = {};
+
+    return value;
+}
+
+void StagingUploader::acquire(CommandBuffer& commandBuffer) {
+    State& state = *_state;
+    if(state.flushedBufferBarriers.empty() && state.flushedImageBarriers.empty())
+        return;
+
+    state.device->CmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, state.flushedBufferBarriers.size(), state.flushedBufferBarriers.data(), state.flushedImageBarriers.size(), state.flushedImageBarriers.data());
+    state.flushedBufferBarriers = {};
+    state.flushedImageBarriers = {};
+}
+
+}}
@@ -0,0 +1,222 @@
+#ifndef Magnum_Vk_StagingUploader_h
+#define Magnum_Vk_StagingUploader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Vk::StagingUploader
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Batched staging uploader
+@m_since_latest
+
+Uploads data to device-local @ref Buffer and @ref Image memory through a ring
+of host-visible staging buffers, recording the copies on a dedicated transfer
+queue. Uploads are accumulated into a batch --- the data is copied into the
+current staging buffer right away and a copy command is recorded into a
+command buffer associated with it. The batch is submitted with @ref flush(),
+or implicitly once the current staging buffer is full, after which the next
+staging buffer in the ring is used.
+
+Completion of each batch is signaled on a timeline @ref Semaphore, with the
+value incremented for every submitted batch. A staging buffer is reused only
+after the GPU finished the batch that last used it, which is the only case
+where the uploader blocks. Work on other queues that depends on the uploaded
+data waits on @ref semaphore() with the value returned from @ref flush(),
+without any host synchronization:
+
+@snippet MagnumVk.cpp StagingUploader-usage
+
+@section Vk-StagingUploader-queue-families Queue family ownership transfer
+
+If the transfer queue is from a different family than the queue that uses the
+resources, ownership of the uploaded ranges has to be transferred. In that
+case the uploader records a release barrier after each copy and
+@ref acquire() then records the matching acquire barriers for all flushed
+uploads into a command buffer on the destination queue, which has to be
+submitted waiting on @ref semaphore(). If both families are the same,
+@ref acquire() does nothing and only the semaphore wait is needed.
+
+@section Vk-StagingUploader-meshes Uploading meshes
+
+There's no dependency on the @ref Trade library, so mesh data are uploaded as
+plain buffer ranges --- for example @ref Trade::MeshData::vertexData() and
+@ref Trade::MeshData::indexData() into two device-local buffers.
+
+@requires_vk12 Extension @vk_extension{KHR,timeline_semaphore} and
+    @ref DeviceFeature::TimelineSemaphore enabled on the device
+*/
+class MAGNUM_VK_EXPORT StagingUploader {
+    public:
+        /**
+         * @brief Constructor
+         * @param device            Vulkan device
+         * @param queue             Queue to submit the copies to
+         * @param queueFamily       Family of @p queue
+         * @param destinationQueueFamily Family of the queue that uses the
+         *      uploaded resources
+         * @param bufferSize        Size of each staging buffer in bytes
+         * @param bufferCount       Count of staging buffers in the ring
+         *
+         * Creates @p bufferCount host-visible and host-coherent staging
+         * buffers of @p bufferSize bytes each, persistently mapped, a
+         * command pool on @p queueFamily and a timeline @ref Semaphore
+         * with an initial value of @cpp 0 @ce. Expects that both
+         * @p bufferSize and @p bufferCount are non-zero.
+         */
+        explicit StagingUploader(Device& device, Queue& queue, UnsignedInt queueFamily, UnsignedInt destinationQueueFamily, UnsignedLong bufferSize = 16*1024*1024, UnsignedInt bufferCount = 3);
+
+        /**
+         * @brief Construct without creating the underlying Vulkan objects
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit StagingUploader(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        StagingUploader(const StagingUploader&) = delete;
+
+        /** @brief Move constructor */
+        StagingUploader(StagingUploader&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Uploads recorded but not flushed are discarded. Waits until all
+         * submitted batches finish and then destroys the staging buffers,
+         * the command pool and the semaphore.
+         */
+        ~StagingUploader();
+
+        /** @brief Copying is not allowed */
+        StagingUploader& operator=(const StagingUploader&) = delete;
+
+        /** @brief Move assignment */
+        StagingUploader& operator=(StagingUploader&&) noexcept;
+
+        /** @brief Size of each staging buffer in bytes */
+        UnsignedLong bufferSize() const;
+
+        /** @brief Count of staging buffers in the ring */
+        UnsignedInt bufferCount() const;
+
+        /**
+         * @brief Timeline semaphore signaled by submitted batches
+         *
+         * Each batch submitted with @ref flush() signals a value one larger
+         * than the previous batch.
+         */
+        Semaphore& semaphore();
+
+        /**
+         * @brief Value signaled by the last submitted batch
+         *
+         * Initially @cpp 0 @ce. Waiting on @ref semaphore() for this value
+         * waits for all uploads flushed so far.
+         */
+        UnsignedLong submittedValue() const;
+
+        /**
+         * @brief Upload data to a buffer
+         * @param buffer    Destination buffer
+         * @param offset    Offset in the destination buffer
+         * @param data      Data to upload
+         *
+         * Copies @p data into the staging memory and records a copy to
+         * @p buffer. If the data don't fit into the remaining space of the
+         * current staging buffer, they're split across multiple batches.
+         * The @p buffer is expected to be created with
+         * @ref BufferUsage::TransferDestination and to stay alive until
+         * the upload finishes.
+         * @see @fn_vk_keyword{CmdCopyBuffer}
+         */
+        void upload(Buffer& buffer, UnsignedLong offset, Containers::ArrayView<const void> data);
+
+        /**
+         * @brief Upload an image
+         * @param image     Destination image
+         * @param data      Image data to upload
+         * @param layout    Layout to transition the image to after the
+         *      upload
+         * @param level     Mip level
+         *
+         * Copies @p data into the staging memory with rows tightly packed
+         * and records a copy to given @p level of @p image, starting at the
+         * origin. Previous contents of the level are discarded. The image is
+         * expected to be a color image created with
+         * @ref ImageUsage::TransferDestination, having a format matching
+         * @p data and to stay alive until the upload finishes. The whole
+         * image is expected to fit into a single staging buffer.
+         * @see @fn_vk_keyword{CmdCopyBufferToImage},
+         *      @fn_vk_keyword{CmdPipelineBarrier}
+         */
+        void upload(Image& image, const ImageView2D& data, ImageLayout layout, Int level = 0);
+
+        /**
+         * @brief Submit the current batch
+         * @return Semaphore value signaled once the batch finishes
+         *
+         * If there are no recorded uploads, nothing is submitted and
+         * @ref submittedValue() is returned.
+         * @see @ref Queue::submit()
+         */
+        UnsignedLong flush();
+
+        /**
+         * @brief Record queue family ownership acquire barriers
+         *
+         * If the destination queue family is different from the transfer
+         * queue family, records acquire barriers for all uploads flushed
+         * since the last call into @p commandBuffer. Otherwise does
+         * nothing. The @p commandBuffer is expected to be in a recording
+         * state and submitted to a queue of the destination family, waiting
+         * on @ref semaphore() for the value returned from @ref flush().
+         * @see @fn_vk_keyword{CmdPipelineBarrier}
+         */
+        void acquire(CommandBuffer& commandBuffer);
+
+    private:
+        MAGNUM_VK_LOCAL UnsignedLong reserve(UnsignedLong size, UnsignedLong alignment);
+
+        struct State;
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
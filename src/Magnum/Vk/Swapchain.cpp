@@ -0,0 +1,269 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "Swapchain.h"
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/Debug.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Vk/Assert.h"
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Instance.h"
+#include "Magnum/Vk/Integration.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Result.h"
+
+namespace Magnum { namespace Vk {
+
+struct Swapchain::State {
+    explicit State(Instance& instance, Device& device, VkSurfaceKHR surface, UnsignedInt imageCount, ImageUsages usages): instance(instance), device(device), surface{surface}, requestedImageCount{imageCount}, usages{usages} {}
+
+    ~State() {
+        if(handle) device->DestroySwapchainKHR(device, handle, nullptr);
+    }
+
+    Instance& instance;
+    Device& device;
+    VkSurfaceKHR surface;
+    VkSwapchainKHR handle{};
+    VkFormat format{};
+    VkColorSpaceKHR colorSpace{};
+    PresentMode presentMode{PresentMode::Fifo};
+    UnsignedInt requestedImageCount;
+    ImageUsages usages;
+    Vector2i size;
+    /* Not owning the handles, they're destroyed together with the
+       swapchain */
+    Containers::Array<Image> images;
+};
+
+bool Swapchain::isPresentationSupported(Instance& instance, DeviceProperties& properties, const UnsignedInt queueFamilyIndex, const VkSurfaceKHR surface) {
+    VkBool32 supported;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(instance->GetPhysicalDeviceSurfaceSupportKHR(properties, queueFamilyIndex, surface, &supported));
+    return supported;
+}
+
+Swapchain::Swapchain(Instance& instance, Device& device, const VkSurfaceKHR surface, const Vector2i& size, const PresentMode presentMode, const UnsignedInt imageCount, const ImageUsages usages): _state{Containers::InPlaceInit, instance, device, surface, imageCount, usages} {
+    const VkPhysicalDevice physicalDevice = device.properties();
+
+    /* Pick the surface format, preferring sRGB. If the surface has no
+       preference, it reports a single undefined format. */
+    UnsignedInt formatCount;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(instance->GetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, nullptr));
+    Containers::Array<VkSurfaceFormatKHR> formats{NoInit, formatCount};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR_INCOMPLETE(instance->GetPhysicalDeviceSurfaceFormatsKHR(physicalDevice, surface, &formatCount, formats));
+    CORRADE_ASSERT(formatCount,
+        "Vk::Swapchain: the surface reports no supported formats", );
+    if(formatCount == 1 && formats[0].format == VK_FORMAT_UNDEFINED) {
+        _state->format = VK_FORMAT_B8G8R8A8_SRGB;
+        _state->colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    } else {
+        _state->format = formats[0].format;
+        _state->colorSpace = formats[0].colorSpace;
+        for(const VkSurfaceFormatKHR& format: formats.prefix(formatCount)) {
+            if((format.format == VK_FORMAT_B8G8R8A8_SRGB || format.format == VK_FORMAT_R8G8B8A8_SRGB) && format.colorSpace == VK_COLOR_SPACE_SRGB_NONLINEAR_KHR) {
+                _state->format = format.format;
+                _state->colorSpace = format.colorSpace;
+                break;
+            }
+        }
+    }
+
+    /* Use the requested present mode if supported, FIFO otherwise as that's
+       the only one guaranteed to be available */
+    UnsignedInt presentModeCount;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(instance->GetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, nullptr));
+    Containers::Array<VkPresentModeKHR> presentModes{NoInit, presentModeCount};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR_INCOMPLETE(instance->GetPhysicalDeviceSurfacePresentModesKHR(physicalDevice, surface, &presentModeCount, presentModes));
+    for(const VkPresentModeKHR mode: presentModes.prefix(presentModeCount)) {
+        if(PresentMode(mode) == presentMode) {
+            _state->presentMode = presentMode;
+            break;
+        }
+    }
+
+    create(size);
+}
+
+Swapchain::Swapchain(NoCreateT) noexcept {}
+
+Swapchain::Swapchain(Swapchain&&) noexcept = default;
+
+Swapchain::~Swapchain() = default;
+
+Swapchain& Swapchain::operator=(Swapchain&&) noexcept = default;
+
+VkSwapchainKHR Swapchain::handle() {
+    return _state ? _state->handle : VkSwapchainKHR{};
+}
+
+VkFormat Swapchain::format() const {
+    return _state ? _state->format : VkFormat{};
+}
+
+Vector2i Swapchain::size() const {
+    return _state ? _state->size : Vector2i{};
+}
+
+PresentMode Swapchain::presentMode() const {
+    return _state ? _state->presentMode : PresentMode::Fifo;
+}
+
+Containers::ArrayView<Image> Swapchain::images() {
+    return _state ? Containers::ArrayView<Image>{_state->images} : nullptr;
+}
+
+bool Swapchain::create(const Vector2i& size) {
+    State& state = *_state;
+
+    VkSurfaceCapabilitiesKHR capabilities;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(state.instance->GetPhysicalDeviceSurfaceCapabilitiesKHR(state.device.properties(), state.surface, &capabilities));
+
+    /* If the surface dictates the size, use it, otherwise clamp the
+       requested one to the supported range. A zero size happens for
+       minimized windows, there's nothing to create in that case. */
+    const Vector2i extent = capabilities.currentExtent.width != ~UnsignedInt{} ?
+        Vector2i{capabilities.currentExtent} :
+        Math::clamp(size, Vector2i{capabilities.minImageExtent}, Vector2i{capabilities.maxImageExtent});
+    if(!extent.product()) return false;
+
+    /* Zero maximum means there's no limit */
+    UnsignedInt imageCount = Math::max(state.requestedImageCount, capabilities.minImageCount);
+    if(capabilities.maxImageCount)
+        imageCount = Math::min(imageCount, capabilities.maxImageCount);
+
+    /* Pick the first supported composite alpha mode, preferring opaque */
+    VkCompositeAlphaFlagBitsKHR compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    for(const VkCompositeAlphaFlagBitsKHR candidate: {
+        VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR,
+        VK_COMPOSITE_ALPHA_PRE_MULTIPLIED_BIT_KHR,
+        VK_COMPOSITE_ALPHA_POST_MULTIPLIED_BIT_KHR,
+        VK_COMPOSITE_ALPHA_INHERIT_BIT_KHR
+    }) {
+        if(capabilities.supportedCompositeAlpha & candidate) {
+            compositeAlpha = candidate;
+            break;
+        }
+    }
+
+    VkSwapchainCreateInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    info.surface = state.surface;
+    info.minImageCount = imageCount;
+    info.imageFormat = state.format;
+    info.imageColorSpace = state.colorSpace;
+    info.imageExtent = VkExtent2D(Vector2ui{extent});
+    info.imageArrayLayers = 1;
+    info.imageUsage = VkImageUsageFlags(state.usages);
+    info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.preTransform = capabilities.currentTransform;
+    info.compositeAlpha = compositeAlpha;
+    info.presentMode = VkPresentModeKHR(state.presentMode);
+    info.clipped = VK_TRUE;
+    info.oldSwapchain = state.handle;
+
+    VkSwapchainKHR handle;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(state.device->CreateSwapchainKHR(state.device, &info, nullptr, &handle));
+    if(state.handle)
+        state.device->DestroySwapchainKHR(state.device, state.handle, nullptr);
+    state.handle = handle;
+    state.size = extent;
+
+    UnsignedInt count;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(state.device->GetSwapchainImagesKHR(state.device, handle, &count, nullptr));
+    Containers::Array<VkImage> images{NoInit, count};
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS_OR_INCOMPLETE(state.device->GetSwapchainImagesKHR(state.device, handle, &count, images));
+    state.images = Containers::Array<Image>{Containers::DirectInit, count, NoCreate};
+    for(std::size_t i = 0; i != count; ++i)
+        state.images[i] = Image::wrap(state.device, images[i], state.format);
+
+    return true;
+}
+
+bool Swapchain::recreate(const Vector2i& size) {
+    CORRADE_ASSERT(_state,
+        "Vk::Swapchain::recreate(): the swapchain wasn't created", {});
+    return create(size);
+}
+
+Int Swapchain::acquire(const VkSemaphore semaphore, const VkFence fence) {
+    CORRADE_ASSERT(_state && _state->handle,
+        "Vk::Swapchain::acquire(): the swapchain has zero size, call recreate() first", -1);
+
+    /* A suboptimal swapchain still signals the semaphore and the fence, so
+       the image can be rendered to and the recreation postponed until it's
+       reported from present() */
+    UnsignedInt image;
+    const Result result = Result(_state->device->AcquireNextImageKHR(_state->device, _state->handle, ~UnsignedLong{}, semaphore, fence, &image));
+    if(result == Result::ErrorOutOfDate) return -1;
+    if(result != Result::Suboptimal)
+        MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(result);
+    return image;
+}
+
+bool Swapchain::present(Queue& queue, const UnsignedInt image, const VkSemaphore semaphore) {
+    CORRADE_ASSERT(_state && image < _state->images.size(),
+        "Vk::Swapchain::present(): index" << image << "out of range for" << (_state ? _state->images.size() : 0) << "images", {});
+
+    VkPresentInfoKHR info{};
+    info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    if(semaphore) {
+        info.waitSemaphoreCount = 1;
+        info.pWaitSemaphores = &semaphore;
+    }
+    info.swapchainCount = 1;
+    info.pSwapchains = &_state->handle;
+    info.pImageIndices = &image;
+
+    const Result result = Result(_state->device->QueuePresentKHR(queue, &info));
+    if(result == Result::ErrorOutOfDate || result == Result::Suboptimal)
+        return false;
+    MAGNUM_VK_INTERNAL_ASSERT_SUCCESS(result);
+    return true;
+}
+
+Debug& operator<<(Debug& debug, const PresentMode value) {
+    debug << "Vk::PresentMode" << Debug::nospace;
+
+    switch(value) {
+        /* LCOV_EXCL_START */
+        #define _c(value) case Vk::PresentMode::value: return debug << "::" << Debug::nospace << #value;
+        _c(Immediate)
+        _c(Mailbox)
+        _c(Fifo)
+        _c(FifoRelaxed)
+        #undef _c
+        /* LCOV_EXCL_STOP */
+    }
+
+    return debug << "(" << Debug::nospace << Int(value) << Debug::nospace << ")";
+}
+
+}}
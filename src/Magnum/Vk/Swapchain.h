@@ -0,0 +1,274 @@
+#ifndef Magnum_Vk_Swapchain_h
+#define Magnum_Vk_Swapchain_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+/** @file
+ * @brief Class @ref Magnum::Vk::Swapchain, enum @ref Magnum::Vk::PresentMode
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+
+#include "Magnum/Magnum.h"
+#include "Magnum/Tags.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Vk.h"
+#include "Magnum/Vk/visibility.h"
+
+namespace Magnum { namespace Vk {
+
+/**
+@brief Present mode
+@m_since_latest
+
+Wraps a @type_vk_keyword{PresentModeKHR}.
+@see @ref Swapchain
+@m_enum_values_as_keywords
+*/
+enum class PresentMode: Int {
+    /**
+     * Images are presented immediately, without waiting for a vertical
+     * blank. Lowest latency, but may result in visible tearing.
+     */
+    Immediate = VK_PRESENT_MODE_IMMEDIATE_KHR,
+
+    /**
+     * Images are presented on a vertical blank, but a newly presented image
+     * replaces the one that's waiting in the queue instead of blocking. Low
+     * latency without tearing, at the cost of rendering frames that never
+     * get shown.
+     */
+    Mailbox = VK_PRESENT_MODE_MAILBOX_KHR,
+
+    /**
+     * Images are queued and presented on a vertical blank, the application
+     * blocks when the queue is full. Equivalent to a classic V-Sync and the
+     * only mode that's guaranteed to be supported.
+     */
+    Fifo = VK_PRESENT_MODE_FIFO_KHR,
+
+    /**
+     * Like @ref PresentMode::Fifo, but if the application is late and the
+     * queue was empty at the last vertical blank, the image is presented
+     * immediately, possibly with tearing.
+     */
+    FifoRelaxed = VK_PRESENT_MODE_FIFO_RELAXED_KHR
+};
+
+/**
+@debugoperatorenum{PresentMode}
+@m_since_latest
+*/
+MAGNUM_VK_EXPORT Debug& operator<<(Debug& debug, PresentMode value);
+
+/**
+@brief Swapchain
+@m_since_latest
+
+Wraps a @type_vk_keyword{SwapchainKHR} together with its images. The surface
+it presents to is created outside of this class, for example with
+@ref Platform::Sdl2Application::createVulkanSurface(), and needs the
+@vk_extension{KHR,surface} extension together with the platform-specific
+surface extension enabled on the @ref Instance, and @vk_extension{KHR,swapchain}
+enabled on the @ref Device.
+
+@section Vk-Swapchain-creation Swapchain creation
+
+The constructor queries the surface capabilities and picks the surface format,
+image count and composite alpha mode automatically. An sRGB
+@val_vk{FORMAT_B8G8R8A8_SRGB,Format} or @val_vk{FORMAT_R8G8B8A8_SRGB,Format}
+format is preferred if available, the actually used one is available through
+@ref format(). If the requested @ref PresentMode isn't supported by the
+surface, @ref PresentMode::Fifo is used instead --- check @ref presentMode()
+for the mode that was actually picked. For lowest latency, request
+@ref PresentMode::Mailbox or @ref PresentMode::Immediate.
+
+@section Vk-Swapchain-usage Swapchain usage
+
+An image is acquired with @ref acquire(), rendered to and then presented back
+with @ref present(). The @ref images() are in an undefined layout after being
+acquired for the first time and are expected to be in
+@ref ImageLayout::PresentSource when presented.
+
+When the window gets resized, the swapchain gets out of date, which is
+signalized by @ref acquire() returning @cpp -1 @ce and @ref present()
+returning @cpp false @ce. Call @ref recreate() with the new window size then.
+In most cases you'll want to use the @ref FrameLoop class, which wraps the
+whole acquire, submit and present sequence with multiple frames in flight.
+*/
+class MAGNUM_VK_EXPORT Swapchain {
+    public:
+        /**
+         * @brief Whether presentation to a surface is supported
+         * @param instance          Vulkan instance the surface is created on
+         * @param properties        Physical device
+         * @param queueFamilyIndex  Queue family index
+         * @param surface           Surface to present to
+         *
+         * Use to pick a queue family for the @ref Device that's able to
+         * present to given surface.
+         * @see @fn_vk_keyword{GetPhysicalDeviceSurfaceSupportKHR}
+         */
+        static bool isPresentationSupported(Instance& instance, DeviceProperties& properties, UnsignedInt queueFamilyIndex, VkSurfaceKHR surface);
+
+        /**
+         * @brief Constructor
+         * @param instance      Vulkan instance the @p surface is created on
+         * @param device        Vulkan device to create the swapchain on
+         * @param surface       Surface to present to
+         * @param size          Size of the swapchain images. Used only if
+         *      the surface doesn't dictate it on its own, clamped to the
+         *      supported range.
+         * @param presentMode   Requested present mode
+         * @param imageCount    Requested image count, clamped to the range
+         *      supported by the surface
+         * @param usages        Image usages
+         *
+         * The @p surface isn't owned by the swapchain and is expected to
+         * outlive it.
+         * @see @fn_vk_keyword{GetPhysicalDeviceSurfaceCapabilitiesKHR},
+         *      @fn_vk_keyword{GetPhysicalDeviceSurfaceFormatsKHR},
+         *      @fn_vk_keyword{GetPhysicalDeviceSurfacePresentModesKHR},
+         *      @fn_vk_keyword{CreateSwapchainKHR},
+         *      @fn_vk_keyword{GetSwapchainImagesKHR}
+         */
+        explicit Swapchain(Instance& instance, Device& device, VkSurfaceKHR surface, const Vector2i& size, PresentMode presentMode = PresentMode::Fifo, UnsignedInt imageCount = 3, ImageUsages usages = ImageUsage::ColorAttachment);
+
+        /**
+         * @brief Construct without creating the swapchain
+         *
+         * The constructed instance is equivalent to moved-from state. Useful
+         * in cases where you will overwrite the instance later anyway. Move
+         * another object over it to make it useful.
+         */
+        explicit Swapchain(NoCreateT) noexcept;
+
+        /** @brief Copying is not allowed */
+        Swapchain(const Swapchain&) = delete;
+
+        /** @brief Move constructor */
+        Swapchain(Swapchain&&) noexcept;
+
+        /**
+         * @brief Destructor
+         *
+         * Destroys associated @type_vk{SwapchainKHR} handle and implicitly
+         * all its images.
+         * @see @fn_vk_keyword{DestroySwapchainKHR}
+         */
+        ~Swapchain();
+
+        /** @brief Copying is not allowed */
+        Swapchain& operator=(const Swapchain&) = delete;
+
+        /** @brief Move assignment */
+        Swapchain& operator=(Swapchain&&) noexcept;
+
+        /** @brief Underlying @type_vk{SwapchainKHR} handle */
+        VkSwapchainKHR handle();
+        /** @overload */
+        operator VkSwapchainKHR() { return handle(); }
+
+        /** @brief Image format */
+        VkFormat format() const;
+
+        /** @brief Image size */
+        Vector2i size() const;
+
+        /**
+         * @brief Present mode
+         *
+         * Either the mode passed to the constructor or
+         * @ref PresentMode::Fifo if it wasn't supported by the surface.
+         */
+        PresentMode presentMode() const;
+
+        /**
+         * @brief Swapchain images
+         *
+         * The images aren't owned by the instance and are valid until the
+         * next @ref recreate() call. Their count may be larger than what was
+         * requested in the constructor.
+         */
+        Containers::ArrayView<Image> images();
+
+        /**
+         * @brief Recreate the swapchain
+         * @param size      New image size. Used only if the surface doesn't
+         *      dictate it on its own.
+         *
+         * Creates a new swapchain with the same parameters as before,
+         * passing the original one as @cpp oldSwapchain @ce, and replaces
+         * the @ref images(). Expects that none of the original images are
+         * used by the device anymore, for example by waiting on all
+         * per-frame fences. Returns @cpp false @ce and keeps the original
+         * swapchain if the resulting size would be zero, which happens when
+         * the window gets minimized.
+         */
+        bool recreate(const Vector2i& size);
+
+        /**
+         * @brief Acquire the next image
+         * @param semaphore Semaphore to signal once the image is ready for
+         *      rendering
+         * @param fence     Fence to signal once the image is ready for
+         *      rendering, or @cpp VK_NULL_HANDLE @ce
+         *
+         * Returns an index into @ref images(), or @cpp -1 @ce if the
+         * swapchain is out of date and has to be recreated with
+         * @ref recreate(). The @p semaphore and @p fence are left
+         * unsignaled in that case.
+         * @see @fn_vk_keyword{AcquireNextImageKHR}
+         */
+        Int acquire(VkSemaphore semaphore, VkFence fence = {});
+
+        /**
+         * @brief Present an image
+         * @param queue         Queue to present on
+         * @param image         Index of an image previously returned from
+         *      @ref acquire()
+         * @param semaphore     Semaphore to wait on before presenting, or
+         *      @cpp VK_NULL_HANDLE @ce
+         *
+         * Returns @cpp false @ce if the swapchain is out of date or no
+         * longer matches the surface exactly and should be recreated with
+         * @ref recreate(), @cpp true @ce otherwise.
+         * @see @fn_vk_keyword{QueuePresentKHR}
+         */
+        bool present(Queue& queue, UnsignedInt image, VkSemaphore semaphore = {});
+
+    private:
+        struct State;
+
+        MAGNUM_VK_LOCAL bool create(const Vector2i& size);
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
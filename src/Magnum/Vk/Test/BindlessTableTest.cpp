@@ -0,0 +1,118 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/BindlessTable.h"
+#include "Magnum/Vk/Device.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct BindlessTableTest: TestSuite::Tester {
+    explicit BindlessTableTest();
+
+    void constructNoCreate();
+    void constructNoBindings();
+    void constructUnsupportedType();
+    void constructZeroCapacity();
+    void constructCopy();
+};
+
+BindlessTableTest::BindlessTableTest() {
+    addTests({&BindlessTableTest::constructNoCreate,
+              &BindlessTableTest::constructNoBindings,
+              &BindlessTableTest::constructUnsupportedType,
+              &BindlessTableTest::constructZeroCapacity,
+              &BindlessTableTest::constructCopy});
+}
+
+void BindlessTableTest::constructNoCreate() {
+    {
+        BindlessTable table{NoCreate};
+        CORRADE_COMPARE(table.bindingCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, BindlessTable>::value));
+}
+
+void BindlessTableTest::constructNoBindings() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    /* The assertions fire before any Vulkan call, so a device without any
+       function pointers is enough */
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BindlessTable{device, Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>>{}};
+    CORRADE_COMPARE(out.str(), "Vk::BindlessTable: expected at least one binding\n");
+}
+
+void BindlessTableTest::constructUnsupportedType() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BindlessTable{device, {
+        {DescriptorType::SampledImage, 1024},
+        {DescriptorType::UniformBufferDynamic, 16}
+    }};
+    CORRADE_COMPARE(out.str(), "Vk::BindlessTable: unsupported Vk::DescriptorType::UniformBufferDynamic for binding 1\n");
+}
+
+void BindlessTableTest::constructZeroCapacity() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    BindlessTable{device, {
+        {DescriptorType::SampledImage, 1024},
+        {DescriptorType::StorageBuffer, 0}
+    }};
+    CORRADE_COMPARE(out.str(), "Vk::BindlessTable: expected non-zero capacity for binding 1\n");
+}
+
+void BindlessTableTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<BindlessTable>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<BindlessTable>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::BindlessTableTest)
@@ -43,6 +43,7 @@ struct BufferTest: TestSuite::Tester {
     void constructCopy();
 
     void dedicatedMemoryNotDedicated();
+    void allocatedMemoryNotAllocated();
 };
 
 BufferTest::BufferTest() {
@@ -53,7 +54,8 @@ BufferTest::BufferTest() {
               &BufferTest::constructNoCreate,
               &BufferTest::constructCopy,
 
-              &BufferTest::dedicatedMemoryNotDedicated});
+              &BufferTest::dedicatedMemoryNotDedicated,
+              &BufferTest::allocatedMemoryNotAllocated});
 }
 
 void BufferTest::createInfoConstruct() {
@@ -113,6 +115,20 @@ void BufferTest::dedicatedMemoryNotDedicated() {
     CORRADE_COMPARE(out.str(), "Vk::Buffer::dedicatedMemory(): buffer doesn't have a dedicated memory\n");
 }
 
+void BufferTest::allocatedMemoryNotAllocated() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Buffer buffer{NoCreate};
+    CORRADE_VERIFY(!buffer.hasAllocatedMemory());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    buffer.allocatedMemory();
+    CORRADE_COMPARE(out.str(), "Vk::Buffer::allocatedMemory(): buffer doesn't have memory from an allocator\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::BufferTest)
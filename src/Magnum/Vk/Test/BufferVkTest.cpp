@@ -29,6 +29,7 @@
 #include "Magnum/Vk/DeviceProperties.h"
 #include "Magnum/Vk/Handle.h"
 #include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Result.h"
 #include "Magnum/Vk/VulkanTester.h"
 
@@ -46,8 +47,10 @@ struct BufferVkTest: VulkanTester {
 
     void bindMemory();
     void bindDedicatedMemory();
+    void bindAllocatedMemory();
 
     void directAllocation();
+    void allocatorAllocation();
 };
 
 BufferVkTest::BufferVkTest() {
@@ -60,8 +63,10 @@ BufferVkTest::BufferVkTest() {
 
               &BufferVkTest::bindMemory,
               &BufferVkTest::bindDedicatedMemory,
+              &BufferVkTest::bindAllocatedMemory,
 
-              &BufferVkTest::directAllocation});
+              &BufferVkTest::directAllocation,
+              &BufferVkTest::allocatorAllocation});
 }
 
 void BufferVkTest::construct() {
@@ -159,6 +164,21 @@ void BufferVkTest::bindDedicatedMemory() {
     CORRADE_COMPARE(buffer.dedicatedMemory().handle(), handle);
 }
 
+void BufferVkTest::bindAllocatedMemory() {
+    MemoryAllocator allocator{device()};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::StorageBuffer, 16384}, NoAllocate};
+    MemoryAllocation allocation = allocator.allocate(buffer.memoryRequirements(), MemoryFlag::DeviceLocal);
+    const UnsignedLong offset = allocation.offset();
+
+    buffer.bindAllocatedMemory(std::move(allocation));
+    CORRADE_VERIFY(!allocation.allocator());
+    CORRADE_VERIFY(!buffer.hasDedicatedMemory());
+    CORRADE_VERIFY(buffer.hasAllocatedMemory());
+    CORRADE_COMPARE(buffer.allocatedMemory().allocator(), &allocator);
+    CORRADE_COMPARE(buffer.allocatedMemory().offset(), offset);
+}
+
 void BufferVkTest::directAllocation() {
     Buffer buffer{device(),
         BufferCreateInfo{BufferUsage::StorageBuffer, 16384},
@@ -169,6 +189,28 @@ void BufferVkTest::directAllocation() {
     CORRADE_VERIFY(buffer.dedicatedMemory().handle());
 }
 
+void BufferVkTest::allocatorAllocation() {
+    MemoryAllocator allocator{device()};
+
+    {
+        Buffer a{device(), BufferCreateInfo{BufferUsage::StorageBuffer, 16384}, allocator, MemoryFlag::DeviceLocal};
+        Buffer b{device(), BufferCreateInfo{BufferUsage::StorageBuffer, 16384}, allocator, MemoryFlag::DeviceLocal};
+        CORRADE_VERIFY(!a.hasDedicatedMemory());
+        CORRADE_VERIFY(a.hasAllocatedMemory());
+        CORRADE_VERIFY(b.hasAllocatedMemory());
+        CORRADE_COMPARE(a.allocatedMemory().strategy(), MemoryAllocationStrategy::General);
+
+        /* Both are sub-allocated from the same block */
+        CORRADE_COMPARE(allocator.statistics().blockCount, 1);
+        CORRADE_COMPARE(allocator.statistics().allocationCount, 2);
+        CORRADE_COMPARE(a.allocatedMemory().memory().handle(), b.allocatedMemory().memory().handle());
+        CORRADE_VERIFY(a.allocatedMemory().offset() != b.allocatedMemory().offset());
+    }
+
+    /* The allocations are given back on destruction */
+    CORRADE_COMPARE(allocator.statistics().allocationCount, 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::BufferVkTest)
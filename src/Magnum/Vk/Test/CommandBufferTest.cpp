@@ -33,15 +33,83 @@ namespace Magnum { namespace Vk { namespace Test { namespace {
 struct CommandBufferTest: TestSuite::Tester {
     explicit CommandBufferTest();
 
+    void beginInfoConstruct();
+    void beginInfoConstructRenderPass();
+    void beginInfoConstructNoInit();
+    void beginInfoConstructFromVk();
+    void beginInfoConstructCopy();
+
     void constructNoCreate();
     void constructCopy();
 };
 
 CommandBufferTest::CommandBufferTest() {
-    addTests({&CommandBufferTest::constructNoCreate,
+    addTests({&CommandBufferTest::beginInfoConstruct,
+              &CommandBufferTest::beginInfoConstructRenderPass,
+              &CommandBufferTest::beginInfoConstructNoInit,
+              &CommandBufferTest::beginInfoConstructFromVk,
+              &CommandBufferTest::beginInfoConstructCopy,
+
+              &CommandBufferTest::constructNoCreate,
               &CommandBufferTest::constructCopy});
 }
 
+void CommandBufferTest::beginInfoConstruct() {
+    CommandBufferBeginInfo info{CommandBufferBeginInfo::Flag::OneTimeSubmit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO);
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+
+    /* The inheritance info is always there so it's usable for secondary
+       buffers as well */
+    CORRADE_VERIFY(info->pInheritanceInfo);
+    CORRADE_COMPARE(info->pInheritanceInfo->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    CORRADE_VERIFY(!info->pInheritanceInfo->renderPass);
+    CORRADE_COMPARE(info->pInheritanceInfo->subpass, 0);
+    CORRADE_VERIFY(!info->pInheritanceInfo->framebuffer);
+}
+
+void CommandBufferTest::beginInfoConstructRenderPass() {
+    auto renderPass = reinterpret_cast<VkRenderPass>(0xdeadbeef);
+    auto framebuffer = reinterpret_cast<VkFramebuffer>(0xcafe);
+
+    CommandBufferBeginInfo info{renderPass, 3, framebuffer, CommandBufferBeginInfo::Flag::OneTimeSubmit};
+    CORRADE_COMPARE(info->flags, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT|VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT);
+    CORRADE_VERIFY(info->pInheritanceInfo);
+    CORRADE_COMPARE(info->pInheritanceInfo->sType, VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO);
+    CORRADE_COMPARE(info->pInheritanceInfo->renderPass, renderPass);
+    CORRADE_COMPARE(info->pInheritanceInfo->subpass, 3);
+    CORRADE_COMPARE(info->pInheritanceInfo->framebuffer, framebuffer);
+}
+
+void CommandBufferTest::beginInfoConstructNoInit() {
+    CommandBufferBeginInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) CommandBufferBeginInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<CommandBufferBeginInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, CommandBufferBeginInfo>::value));
+}
+
+void CommandBufferTest::beginInfoConstructFromVk() {
+    VkCommandBufferBeginInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    CommandBufferBeginInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void CommandBufferTest::beginInfoConstructCopy() {
+    /* The structure points to itself, so neither copies nor moves are
+       allowed */
+    CORRADE_VERIFY(!std::is_copy_constructible<CommandBufferBeginInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<CommandBufferBeginInfo>{});
+    CORRADE_VERIFY(!std::is_move_constructible<CommandBufferBeginInfo>{});
+    CORRADE_VERIFY(!std::is_move_assignable<CommandBufferBeginInfo>{});
+}
+
 void CommandBufferTest::constructNoCreate() {
     {
         CommandBuffer buffer{NoCreate};
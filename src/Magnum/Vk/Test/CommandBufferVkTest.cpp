@@ -40,6 +40,9 @@ struct CommandBufferVkTest: VulkanTester {
     void wrap();
 
     void reset();
+
+    void beginEnd();
+    void executeCommands();
 };
 
 CommandBufferVkTest::CommandBufferVkTest() {
@@ -47,7 +50,10 @@ CommandBufferVkTest::CommandBufferVkTest() {
               &CommandBufferVkTest::constructMove,
               &CommandBufferVkTest::wrap,
 
-              &CommandBufferVkTest::reset});
+              &CommandBufferVkTest::reset,
+
+              &CommandBufferVkTest::beginEnd,
+              &CommandBufferVkTest::executeCommands});
 }
 
 void CommandBufferVkTest::construct() {
@@ -122,6 +128,38 @@ void CommandBufferVkTest::reset() {
     CORRADE_VERIFY(true);
 }
 
+void CommandBufferVkTest::beginEnd() {
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    CommandBuffer a = pool.allocate();
+    a.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit});
+    a.end();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+void CommandBufferVkTest::executeCommands() {
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+
+    CommandBuffer a = pool.allocate(CommandBufferLevel::Secondary);
+    CommandBuffer b = pool.allocate(CommandBufferLevel::Secondary);
+    a.begin();
+    a.end();
+    b.begin();
+    b.end();
+
+    CommandBuffer primary = pool.allocate();
+    primary.begin()
+        .executeCommands({a, b})
+        .end();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::CommandBufferVkTest)
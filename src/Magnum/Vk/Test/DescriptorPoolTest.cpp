@@ -0,0 +1,207 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct DescriptorPoolTest: TestSuite::Tester {
+    explicit DescriptorPoolTest();
+
+    void createInfoConstruct();
+    void createInfoConstructNoSets();
+    void createInfoConstructNoPools();
+    void createInfoConstructZeroDescriptorCount();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+    void createInfoConstructCopy();
+    void createInfoConstructMove();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void setConstructNoCreate();
+    void setConstructCopy();
+};
+
+DescriptorPoolTest::DescriptorPoolTest() {
+    addTests({&DescriptorPoolTest::createInfoConstruct,
+              &DescriptorPoolTest::createInfoConstructNoSets,
+              &DescriptorPoolTest::createInfoConstructNoPools,
+              &DescriptorPoolTest::createInfoConstructZeroDescriptorCount,
+              &DescriptorPoolTest::createInfoConstructNoInit,
+              &DescriptorPoolTest::createInfoConstructFromVk,
+              &DescriptorPoolTest::createInfoConstructCopy,
+              &DescriptorPoolTest::createInfoConstructMove,
+
+              &DescriptorPoolTest::constructNoCreate,
+              &DescriptorPoolTest::constructCopy,
+
+              &DescriptorPoolTest::setConstructNoCreate,
+              &DescriptorPoolTest::setConstructCopy});
+}
+
+void DescriptorPoolTest::createInfoConstruct() {
+    DescriptorPoolCreateInfo info{5, {
+        {DescriptorType::UniformBuffer, 3},
+        {DescriptorType::CombinedImageSampler, 7}
+    }, DescriptorPoolCreateInfo::Flag::FreeDescriptorSet};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO);
+    CORRADE_COMPARE(info->flags, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT);
+    CORRADE_COMPARE(info->maxSets, 5);
+    CORRADE_COMPARE(info->poolSizeCount, 2);
+    CORRADE_VERIFY(info->pPoolSizes);
+    CORRADE_COMPARE(info->pPoolSizes[0].type, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    CORRADE_COMPARE(info->pPoolSizes[0].descriptorCount, 3);
+    CORRADE_COMPARE(info->pPoolSizes[1].type, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    CORRADE_COMPARE(info->pPoolSizes[1].descriptorCount, 7);
+}
+
+void DescriptorPoolTest::createInfoConstructNoSets() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorPoolCreateInfo{0, {{DescriptorType::UniformBuffer, 3}}};
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorPoolCreateInfo: there has to be at least one set\n");
+}
+
+void DescriptorPoolTest::createInfoConstructNoPools() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorPoolCreateInfo{5, Containers::ArrayView<const std::pair<DescriptorType, UnsignedInt>>{}};
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorPoolCreateInfo: there has to be at least one pool\n");
+}
+
+void DescriptorPoolTest::createInfoConstructZeroDescriptorCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    DescriptorPoolCreateInfo{5, {
+        {DescriptorType::UniformBuffer, 3},
+        {DescriptorType::StorageImage, 0}
+    }};
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorPoolCreateInfo: expected non-zero descriptor count for Vk::DescriptorType::StorageImage\n");
+}
+
+void DescriptorPoolTest::createInfoConstructNoInit() {
+    DescriptorPoolCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) DescriptorPoolCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<DescriptorPoolCreateInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, DescriptorPoolCreateInfo>::value));
+}
+
+void DescriptorPoolTest::createInfoConstructFromVk() {
+    VkDescriptorPoolCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    DescriptorPoolCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void DescriptorPoolTest::createInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DescriptorPoolCreateInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DescriptorPoolCreateInfo>{});
+}
+
+void DescriptorPoolTest::createInfoConstructMove() {
+    DescriptorPoolCreateInfo a{5, {
+        {DescriptorType::UniformBuffer, 3},
+        {DescriptorType::CombinedImageSampler, 7}
+    }};
+
+    DescriptorPoolCreateInfo b = std::move(a);
+    CORRADE_COMPARE(a->poolSizeCount, 0);
+    CORRADE_VERIFY(!a->pPoolSizes);
+    CORRADE_COMPARE(b->maxSets, 5);
+    CORRADE_COMPARE(b->poolSizeCount, 2);
+    CORRADE_VERIFY(b->pPoolSizes);
+    CORRADE_COMPARE(b->pPoolSizes[1].descriptorCount, 7);
+
+    DescriptorPoolCreateInfo c{VkDescriptorPoolCreateInfo{}};
+    c = std::move(b);
+    CORRADE_COMPARE(b->poolSizeCount, 0);
+    CORRADE_VERIFY(!b->pPoolSizes);
+    CORRADE_COMPARE(c->maxSets, 5);
+    CORRADE_COMPARE(c->poolSizeCount, 2);
+    CORRADE_VERIFY(c->pPoolSizes);
+    CORRADE_COMPARE(c->pPoolSizes[1].descriptorCount, 7);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DescriptorPoolCreateInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DescriptorPoolCreateInfo>::value);
+}
+
+void DescriptorPoolTest::constructNoCreate() {
+    {
+        DescriptorPool pool{NoCreate};
+        CORRADE_VERIFY(!pool.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, DescriptorPool>::value));
+}
+
+void DescriptorPoolTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<DescriptorPool, const DescriptorPool&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<DescriptorPool, const DescriptorPool&>{}));
+}
+
+void DescriptorPoolTest::setConstructNoCreate() {
+    {
+        DescriptorSet set{NoCreate};
+        CORRADE_VERIFY(!set.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, DescriptorSet>::value));
+}
+
+void DescriptorPoolTest::setConstructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<DescriptorSet, const DescriptorSet&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<DescriptorSet, const DescriptorSet&>{}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::DescriptorPoolTest)
@@ -0,0 +1,243 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorPoolCreateInfo.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct DescriptorPoolVkTest: VulkanTester {
+    explicit DescriptorPoolVkTest();
+
+    void construct();
+    void constructMove();
+
+    void wrap();
+
+    void allocate();
+    void tryAllocateExhausted();
+    void reset();
+
+    void setConstructMove();
+    void setWrap();
+
+    void bindDescriptorSets();
+};
+
+DescriptorPoolVkTest::DescriptorPoolVkTest() {
+    addTests({&DescriptorPoolVkTest::construct,
+              &DescriptorPoolVkTest::constructMove,
+
+              &DescriptorPoolVkTest::wrap,
+
+              &DescriptorPoolVkTest::allocate,
+              &DescriptorPoolVkTest::tryAllocateExhausted,
+              &DescriptorPoolVkTest::reset,
+
+              &DescriptorPoolVkTest::setConstructMove,
+              &DescriptorPoolVkTest::setWrap,
+
+              &DescriptorPoolVkTest::bindDescriptorSets});
+}
+
+void DescriptorPoolVkTest::construct() {
+    {
+        DescriptorPool pool{device(), DescriptorPoolCreateInfo{8, {
+            {DescriptorType::UniformBuffer, 8},
+            {DescriptorType::CombinedImageSampler, 16}
+        }}};
+        CORRADE_VERIFY(pool.handle());
+        CORRADE_COMPARE(pool.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void DescriptorPoolVkTest::constructMove() {
+    DescriptorPool a{device(), DescriptorPoolCreateInfo{8, {
+        {DescriptorType::UniformBuffer, 8}
+    }}};
+    VkDescriptorPool handle = a.handle();
+
+    DescriptorPool b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    DescriptorPool c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DescriptorPool>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DescriptorPool>::value);
+}
+
+void DescriptorPoolVkTest::wrap() {
+    VkDescriptorPool pool{};
+    CORRADE_COMPARE(Result(device()->CreateDescriptorPool(device(),
+        DescriptorPoolCreateInfo{8, {
+            {DescriptorType::UniformBuffer, 8}
+        }},
+        nullptr, &pool)), Result::Success);
+
+    auto wrapped = DescriptorPool::wrap(device(), pool, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), pool);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), pool);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyDescriptorPool(device(), pool, nullptr);
+}
+
+void DescriptorPoolVkTest::allocate() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{8, {
+        {DescriptorType::UniformBuffer, 8}
+    }}};
+
+    DescriptorSet set = pool.allocate(layout);
+    CORRADE_VERIFY(set.handle());
+    /* Freed only together with the pool */
+    CORRADE_COMPARE(set.handleFlags(), HandleFlags{});
+}
+
+void DescriptorPoolVkTest::tryAllocateExhausted() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{2, {
+        {DescriptorType::UniformBuffer, 2}
+    }}};
+
+    Containers::Optional<DescriptorSet> a = pool.tryAllocate(layout);
+    Containers::Optional<DescriptorSet> b = pool.tryAllocate(layout);
+    CORRADE_VERIFY(a);
+    CORRADE_VERIFY(b);
+    CORRADE_VERIFY(a->handle());
+    CORRADE_VERIFY(b->handle());
+
+    /* The pool is full now */
+    CORRADE_VERIFY(!pool.tryAllocate(layout));
+}
+
+void DescriptorPoolVkTest::reset() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }}};
+
+    CORRADE_VERIFY(pool.tryAllocate(layout));
+    CORRADE_VERIFY(!pool.tryAllocate(layout));
+
+    /* After a reset there's space again */
+    pool.reset();
+    CORRADE_VERIFY(pool.tryAllocate(layout));
+}
+
+void DescriptorPoolVkTest::setConstructMove() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{8, {
+        {DescriptorType::UniformBuffer, 8}
+    }}};
+
+    DescriptorSet a = pool.allocate(layout);
+    VkDescriptorSet handle = a.handle();
+
+    DescriptorSet b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+
+    DescriptorSet c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(c.handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DescriptorSet>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DescriptorSet>::value);
+}
+
+void DescriptorPoolVkTest::setWrap() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    /* Freeing individual sets needs the flag */
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }, DescriptorPoolCreateInfo::Flag::FreeDescriptorSet}};
+
+    {
+        DescriptorSet set = DescriptorSet::wrap(device(), pool, pool.allocate(layout).release(), HandleFlag::DestroyOnDestruction);
+        CORRADE_VERIFY(set.handle());
+        CORRADE_VERIFY(!pool.tryAllocate(layout));
+    }
+
+    /* The set got freed on destruction so there's space again */
+    CORRADE_VERIFY(pool.tryAllocate(layout));
+}
+
+void DescriptorPoolVkTest::bindDescriptorSets() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer, 1, ShaderStage::Compute}
+    }};
+    DescriptorPool pool{device(), DescriptorPoolCreateInfo{1, {
+        {DescriptorType::UniformBuffer, 1}
+    }}};
+    DescriptorSet set = pool.allocate(layout);
+    PipelineLayout pipelineLayout{device(), PipelineLayoutCreateInfo{layout}};
+
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Compute)}};
+    CommandBuffer cmd = commandPool.allocate();
+    cmd.begin()
+        .bindDescriptorSets(PipelineBindPoint::Compute, pipelineLayout, 0, {set})
+        .end();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::DescriptorPoolVkTest)
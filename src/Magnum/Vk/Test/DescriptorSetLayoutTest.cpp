@@ -0,0 +1,236 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct DescriptorSetLayoutTest: TestSuite::Tester {
+    explicit DescriptorSetLayoutTest();
+
+    void bindingConstruct();
+    void bindingConstructDefaults();
+    void bindingConstructFlags();
+    void bindingConstructNoInit();
+    void bindingConstructFromVk();
+
+    void createInfoConstruct();
+    void createInfoConstructBindingFlags();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+    void createInfoConstructCopy();
+    void createInfoConstructMove();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void debugDescriptorType();
+};
+
+DescriptorSetLayoutTest::DescriptorSetLayoutTest() {
+    addTests({&DescriptorSetLayoutTest::bindingConstruct,
+              &DescriptorSetLayoutTest::bindingConstructDefaults,
+              &DescriptorSetLayoutTest::bindingConstructFlags,
+              &DescriptorSetLayoutTest::bindingConstructNoInit,
+              &DescriptorSetLayoutTest::bindingConstructFromVk,
+
+              &DescriptorSetLayoutTest::createInfoConstruct,
+              &DescriptorSetLayoutTest::createInfoConstructBindingFlags,
+              &DescriptorSetLayoutTest::createInfoConstructNoInit,
+              &DescriptorSetLayoutTest::createInfoConstructFromVk,
+              &DescriptorSetLayoutTest::createInfoConstructCopy,
+              &DescriptorSetLayoutTest::createInfoConstructMove,
+
+              &DescriptorSetLayoutTest::constructNoCreate,
+              &DescriptorSetLayoutTest::constructCopy,
+
+              &DescriptorSetLayoutTest::debugDescriptorType});
+}
+
+void DescriptorSetLayoutTest::bindingConstruct() {
+    DescriptorSetLayoutBinding binding{15, DescriptorType::SampledImage, 3, ShaderStage::Fragment|ShaderStage::Compute};
+    CORRADE_COMPARE(binding->binding, 15);
+    CORRADE_COMPARE(binding->descriptorType, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE);
+    CORRADE_COMPARE(binding->descriptorCount, 3);
+    CORRADE_COMPARE(binding->stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT|VK_SHADER_STAGE_COMPUTE_BIT);
+    CORRADE_VERIFY(!binding->pImmutableSamplers);
+}
+
+void DescriptorSetLayoutTest::bindingConstructDefaults() {
+    DescriptorSetLayoutBinding binding{2, DescriptorType::UniformBuffer};
+    CORRADE_COMPARE(binding->binding, 2);
+    CORRADE_COMPARE(binding->descriptorType, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    CORRADE_COMPARE(binding->descriptorCount, 1);
+    CORRADE_COMPARE(binding->stageFlags, VK_SHADER_STAGE_ALL);
+    CORRADE_COMPARE(VkDescriptorBindingFlags(binding.flags()), 0);
+}
+
+void DescriptorSetLayoutTest::bindingConstructFlags() {
+    DescriptorSetLayoutBinding binding{1, DescriptorType::StorageBuffer, 256, ShaderStage::Compute, DescriptorSetLayoutBinding::Flag::UpdateAfterBind|DescriptorSetLayoutBinding::Flag::PartiallyBound};
+    CORRADE_COMPARE(binding->binding, 1);
+    CORRADE_COMPARE(binding->descriptorCount, 256);
+    CORRADE_COMPARE(VkDescriptorBindingFlags(binding.flags()), VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT|VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT);
+}
+
+void DescriptorSetLayoutTest::bindingConstructNoInit() {
+    DescriptorSetLayoutBinding binding{NoInit};
+    binding->binding = 0xdead;
+    new(&binding) DescriptorSetLayoutBinding{NoInit};
+    CORRADE_COMPARE(binding->binding, 0xdead);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<DescriptorSetLayoutBinding, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, DescriptorSetLayoutBinding>::value));
+}
+
+void DescriptorSetLayoutTest::bindingConstructFromVk() {
+    VkDescriptorSetLayoutBinding vkBinding;
+    vkBinding.binding = 0xdead;
+
+    DescriptorSetLayoutBinding binding{vkBinding};
+    CORRADE_COMPARE(binding->binding, 0xdead);
+}
+
+void DescriptorSetLayoutTest::createInfoConstruct() {
+    DescriptorSetLayoutCreateInfo info{{
+        {0, DescriptorType::UniformBuffer},
+        {3, DescriptorType::CombinedImageSampler, 2, ShaderStage::Fragment}
+    }, DescriptorSetLayoutCreateInfo::Flag::UpdateAfterBindPool};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO);
+    CORRADE_COMPARE(info->flags, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT);
+    CORRADE_COMPARE(info->bindingCount, 2);
+    CORRADE_VERIFY(info->pBindings);
+    CORRADE_COMPARE(info->pBindings[0].binding, 0);
+    CORRADE_COMPARE(info->pBindings[0].descriptorType, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+    CORRADE_COMPARE(info->pBindings[1].binding, 3);
+    CORRADE_COMPARE(info->pBindings[1].descriptorType, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
+    CORRADE_COMPARE(info->pBindings[1].descriptorCount, 2);
+    CORRADE_COMPARE(info->pBindings[1].stageFlags, VK_SHADER_STAGE_FRAGMENT_BIT);
+    /* No binding flags, so no structure in the chain */
+    CORRADE_VERIFY(!info->pNext);
+}
+
+void DescriptorSetLayoutTest::createInfoConstructBindingFlags() {
+    DescriptorSetLayoutCreateInfo info{{
+        {0, DescriptorType::UniformBuffer},
+        {1, DescriptorType::SampledImage, 1024, ~ShaderStages{}, DescriptorSetLayoutBinding::Flag::UpdateAfterBind|DescriptorSetLayoutBinding::Flag::PartiallyBound}
+    }, DescriptorSetLayoutCreateInfo::Flag::UpdateAfterBindPool};
+    CORRADE_COMPARE(info->bindingCount, 2);
+    CORRADE_VERIFY(info->pNext);
+
+    const auto& flags = *static_cast<const VkDescriptorSetLayoutBindingFlagsCreateInfo*>(info->pNext);
+    CORRADE_COMPARE(flags.sType, VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO);
+    CORRADE_VERIFY(!flags.pNext);
+    CORRADE_COMPARE(flags.bindingCount, 2);
+    CORRADE_VERIFY(flags.pBindingFlags);
+    CORRADE_COMPARE(flags.pBindingFlags[0], 0);
+    CORRADE_COMPARE(flags.pBindingFlags[1], VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT|VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT);
+
+    /* The chain is transferred on move */
+    DescriptorSetLayoutCreateInfo b = std::move(info);
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_VERIFY(b->pNext);
+}
+
+void DescriptorSetLayoutTest::createInfoConstructNoInit() {
+    DescriptorSetLayoutCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) DescriptorSetLayoutCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<DescriptorSetLayoutCreateInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, DescriptorSetLayoutCreateInfo>::value));
+}
+
+void DescriptorSetLayoutTest::createInfoConstructFromVk() {
+    VkDescriptorSetLayoutCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    DescriptorSetLayoutCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void DescriptorSetLayoutTest::createInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<DescriptorSetLayoutCreateInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<DescriptorSetLayoutCreateInfo>{});
+}
+
+void DescriptorSetLayoutTest::createInfoConstructMove() {
+    DescriptorSetLayoutCreateInfo a{{
+        {0, DescriptorType::UniformBuffer},
+        {3, DescriptorType::Sampler}
+    }};
+
+    DescriptorSetLayoutCreateInfo b = std::move(a);
+    CORRADE_COMPARE(a->bindingCount, 0);
+    CORRADE_VERIFY(!a->pBindings);
+    CORRADE_COMPARE(b->bindingCount, 2);
+    CORRADE_VERIFY(b->pBindings);
+    CORRADE_COMPARE(b->pBindings[1].binding, 3);
+
+    DescriptorSetLayoutCreateInfo c{VkDescriptorSetLayoutCreateInfo{}};
+    c = std::move(b);
+    CORRADE_COMPARE(b->bindingCount, 0);
+    CORRADE_VERIFY(!b->pBindings);
+    CORRADE_COMPARE(c->bindingCount, 2);
+    CORRADE_VERIFY(c->pBindings);
+    CORRADE_COMPARE(c->pBindings[1].binding, 3);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<DescriptorSetLayoutCreateInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<DescriptorSetLayoutCreateInfo>::value);
+}
+
+void DescriptorSetLayoutTest::constructNoCreate() {
+    {
+        DescriptorSetLayout layout{NoCreate};
+        CORRADE_VERIFY(!layout.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, DescriptorSetLayout>::value));
+}
+
+void DescriptorSetLayoutTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<DescriptorSetLayout, const DescriptorSetLayout&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<DescriptorSetLayout, const DescriptorSetLayout&>{}));
+}
+
+void DescriptorSetLayoutTest::debugDescriptorType() {
+    std::ostringstream out;
+    Debug{&out} << DescriptorType::StorageBufferDynamic << DescriptorType(-10007655);
+    CORRADE_COMPARE(out.str(), "Vk::DescriptorType::StorageBufferDynamic Vk::DescriptorType(-10007655)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::DescriptorSetLayoutTest)
@@ -0,0 +1,63 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/FrameCommandPools.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameCommandPoolsTest: TestSuite::Tester {
+    explicit FrameCommandPoolsTest();
+
+    void constructNoCreate();
+    void constructCopy();
+};
+
+FrameCommandPoolsTest::FrameCommandPoolsTest() {
+    addTests({&FrameCommandPoolsTest::constructNoCreate,
+              &FrameCommandPoolsTest::constructCopy});
+}
+
+void FrameCommandPoolsTest::constructNoCreate() {
+    {
+        FrameCommandPools pools{NoCreate};
+        CORRADE_COMPARE(pools.threadCount(), 0);
+        CORRADE_COMPARE(pools.frameCount(), 0);
+        CORRADE_COMPARE(pools.frame(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, FrameCommandPools>::value));
+}
+
+void FrameCommandPoolsTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FrameCommandPools>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FrameCommandPools>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameCommandPoolsTest)
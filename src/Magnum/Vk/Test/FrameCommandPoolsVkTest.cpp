@@ -0,0 +1,155 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <thread>
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/FrameCommandPools.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameCommandPoolsVkTest: VulkanTester {
+    explicit FrameCommandPoolsVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocateRecycle();
+    void recordParallel();
+};
+
+FrameCommandPoolsVkTest::FrameCommandPoolsVkTest() {
+    addTests({&FrameCommandPoolsVkTest::construct,
+              &FrameCommandPoolsVkTest::constructMove,
+
+              &FrameCommandPoolsVkTest::allocateRecycle,
+              &FrameCommandPoolsVkTest::recordParallel});
+}
+
+void FrameCommandPoolsVkTest::construct() {
+    FrameCommandPools pools{device(), device().properties().pickQueueFamily(QueueFlag::Graphics), 4, 2};
+    CORRADE_COMPARE(pools.threadCount(), 4);
+    CORRADE_COMPARE(pools.frameCount(), 2);
+    CORRADE_COMPARE(pools.frame(), 0);
+
+    /* Each thread gets a different pool */
+    CORRADE_VERIFY(pools.pool(0).handle());
+    CORRADE_VERIFY(pools.pool(3).handle());
+    CORRADE_VERIFY(pools.pool(0).handle() != pools.pool(3).handle());
+}
+
+void FrameCommandPoolsVkTest::constructMove() {
+    FrameCommandPools a{device(), device().properties().pickQueueFamily(QueueFlag::Graphics), 2, 3};
+    VkCommandPool handle = a.pool(1).handle();
+
+    FrameCommandPools b = std::move(a);
+    CORRADE_COMPARE(a.threadCount(), 0);
+    CORRADE_COMPARE(b.threadCount(), 2);
+    CORRADE_COMPARE(b.frameCount(), 3);
+    CORRADE_COMPARE(b.pool(1).handle(), handle);
+
+    FrameCommandPools c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.threadCount(), 0);
+    CORRADE_COMPARE(c.threadCount(), 2);
+    CORRADE_COMPARE(c.pool(1).handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FrameCommandPools>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FrameCommandPools>::value);
+}
+
+void FrameCommandPoolsVkTest::allocateRecycle() {
+    FrameCommandPools pools{device(), device().properties().pickQueueFamily(QueueFlag::Graphics), 1, 2};
+
+    /* The returned instances don't own the handles */
+    CommandBuffer a = pools.allocate(0);
+    CommandBuffer b = pools.allocate(0, CommandBufferLevel::Secondary);
+    CORRADE_VERIFY(a.handle());
+    CORRADE_VERIFY(b.handle());
+    CORRADE_COMPARE(a.handleFlags(), HandleFlags{});
+    VkCommandBuffer aHandle = a.handle();
+    VkCommandBuffer bHandle = b.handle();
+
+    /* The other frame has a different pool and different buffers */
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 1);
+    CommandBuffer c = pools.allocate(0);
+    CORRADE_VERIFY(c.handle() != aHandle);
+
+    /* Back in the first frame the buffers are reused, each for the same
+       level */
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 0);
+    CORRADE_COMPARE(pools.allocate(0, CommandBufferLevel::Secondary).handle(), bHandle);
+    CORRADE_COMPARE(pools.allocate(0).handle(), aHandle);
+
+    /* Allocating more than last time gives a new buffer */
+    CommandBuffer d = pools.allocate(0);
+    CORRADE_VERIFY(d.handle() != aHandle);
+}
+
+void FrameCommandPoolsVkTest::recordParallel() {
+    const UnsignedInt threadCount = 4;
+    FrameCommandPools pools{device(), device().properties().pickQueueFamily(QueueFlag::Graphics), threadCount, 2};
+    Fence fence{device(), FenceCreateInfo{}};
+
+    for(UnsignedInt frame = 0; frame != 3; ++frame) {
+        /* Each thread records its own secondary buffer */
+        Containers::Array<VkCommandBuffer> secondary{threadCount};
+        {
+            Containers::Array<std::thread> threads{threadCount};
+            for(UnsignedInt i = 0; i != threadCount; ++i) threads[i] = std::thread{[&pools, &secondary, i]() {
+                CommandBuffer buffer = pools.allocate(i, CommandBufferLevel::Secondary);
+                buffer.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit})
+                    .end();
+                secondary[i] = buffer;
+            }};
+            for(std::thread& thread: threads) thread.join();
+        }
+
+        CommandBuffer primary = pools.allocate(0);
+        primary.begin(CommandBufferBeginInfo{CommandBufferBeginInfo::Flag::OneTimeSubmit})
+            .executeCommands(secondary)
+            .end();
+
+        SubmitInfo info;
+        info.setCommandBuffers({primary});
+        queue().submit({info}, fence);
+        CORRADE_VERIFY(fence.wait(~UnsignedLong{}));
+        fence.reset();
+
+        pools.nextFrame();
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameCommandPoolsVkTest)
@@ -0,0 +1,86 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/FrameDescriptorPools.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameDescriptorPoolsTest: TestSuite::Tester {
+    explicit FrameDescriptorPoolsTest();
+
+    void constructNoCreate();
+    void constructZeroCount();
+    void constructCopy();
+};
+
+FrameDescriptorPoolsTest::FrameDescriptorPoolsTest() {
+    addTests({&FrameDescriptorPoolsTest::constructNoCreate,
+              &FrameDescriptorPoolsTest::constructZeroCount,
+              &FrameDescriptorPoolsTest::constructCopy});
+}
+
+void FrameDescriptorPoolsTest::constructNoCreate() {
+    {
+        FrameDescriptorPools pools{NoCreate};
+        CORRADE_COMPARE(pools.threadCount(), 0);
+        CORRADE_COMPARE(pools.frameCount(), 0);
+        CORRADE_COMPARE(pools.frame(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, FrameDescriptorPools>::value));
+}
+
+void FrameDescriptorPoolsTest::constructZeroCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    /* The assertion fires before any Vulkan call, so a device without any
+       function pointers is enough */
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FrameDescriptorPools{device, 0, 3, 16, {{DescriptorType::UniformBuffer, 16}}};
+    FrameDescriptorPools{device, 2, 0, 16, {{DescriptorType::UniformBuffer, 16}}};
+    CORRADE_COMPARE(out.str(),
+        "Vk::FrameDescriptorPools: expected non-zero thread and frame count, got 0 and 3\n"
+        "Vk::FrameDescriptorPools: expected non-zero thread and frame count, got 2 and 0\n");
+}
+
+void FrameDescriptorPoolsTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FrameDescriptorPools>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FrameDescriptorPools>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameDescriptorPoolsTest)
@@ -0,0 +1,133 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Vk/DescriptorSet.h"
+#include "Magnum/Vk/DescriptorSetLayoutCreateInfo.h"
+#include "Magnum/Vk/DescriptorType.h"
+#include "Magnum/Vk/FrameDescriptorPools.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameDescriptorPoolsVkTest: VulkanTester {
+    explicit FrameDescriptorPoolsVkTest();
+
+    void construct();
+    void constructMove();
+
+    void allocateGrow();
+    void allocateRecycle();
+};
+
+FrameDescriptorPoolsVkTest::FrameDescriptorPoolsVkTest() {
+    addTests({&FrameDescriptorPoolsVkTest::construct,
+              &FrameDescriptorPoolsVkTest::constructMove,
+
+              &FrameDescriptorPoolsVkTest::allocateGrow,
+              &FrameDescriptorPoolsVkTest::allocateRecycle});
+}
+
+void FrameDescriptorPoolsVkTest::construct() {
+    FrameDescriptorPools pools{device(), 4, 2, 16, {
+        {DescriptorType::UniformBuffer, 16}
+    }};
+    CORRADE_COMPARE(pools.threadCount(), 4);
+    CORRADE_COMPARE(pools.frameCount(), 2);
+    CORRADE_COMPARE(pools.frame(), 0);
+    CORRADE_COMPARE(pools.poolCount(0), 1);
+    CORRADE_COMPARE(pools.poolCount(3), 1);
+}
+
+void FrameDescriptorPoolsVkTest::constructMove() {
+    FrameDescriptorPools a{device(), 2, 3, 16, {
+        {DescriptorType::UniformBuffer, 16}
+    }};
+
+    FrameDescriptorPools b = std::move(a);
+    CORRADE_COMPARE(a.threadCount(), 0);
+    CORRADE_COMPARE(b.threadCount(), 2);
+    CORRADE_COMPARE(b.frameCount(), 3);
+    CORRADE_COMPARE(b.poolCount(1), 1);
+
+    FrameDescriptorPools c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.threadCount(), 0);
+    CORRADE_COMPARE(c.threadCount(), 2);
+    CORRADE_COMPARE(c.poolCount(1), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<FrameDescriptorPools>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<FrameDescriptorPools>::value);
+}
+
+void FrameDescriptorPoolsVkTest::allocateGrow() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    FrameDescriptorPools pools{device(), 1, 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    /* The returned instances don't own the handles */
+    DescriptorSet a = pools.allocate(0, layout);
+    DescriptorSet b = pools.allocate(0, layout);
+    CORRADE_VERIFY(a.handle());
+    CORRADE_VERIFY(b.handle());
+    CORRADE_COMPARE(a.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(pools.poolCount(0), 1);
+
+    /* The first pool is full, a new one gets created */
+    DescriptorSet c = pools.allocate(0, layout);
+    CORRADE_VERIFY(c.handle());
+    CORRADE_COMPARE(pools.poolCount(0), 2);
+}
+
+void FrameDescriptorPoolsVkTest::allocateRecycle() {
+    DescriptorSetLayout layout{device(), DescriptorSetLayoutCreateInfo{
+        {0, DescriptorType::UniformBuffer}
+    }};
+    FrameDescriptorPools pools{device(), 1, 2, 2, {
+        {DescriptorType::UniformBuffer, 2}
+    }};
+
+    for(UnsignedInt i = 0; i != 5; ++i) pools.allocate(0, layout);
+    CORRADE_COMPARE(pools.poolCount(0), 3);
+
+    /* The other frame starts with a single pool */
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 1);
+    CORRADE_COMPARE(pools.poolCount(0), 1);
+
+    /* Back in the first frame the pools got reset and are reused without
+       creating new ones */
+    pools.nextFrame();
+    CORRADE_COMPARE(pools.frame(), 0);
+    for(UnsignedInt i = 0; i != 5; ++i) pools.allocate(0, layout);
+    CORRADE_COMPARE(pools.poolCount(0), 3);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameDescriptorPoolsVkTest)
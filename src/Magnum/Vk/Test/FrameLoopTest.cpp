@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/FrameLoop.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Swapchain.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct FrameLoopTest: TestSuite::Tester {
+    explicit FrameLoopTest();
+
+    void constructNoCreate();
+    void constructZeroFrames();
+    void constructCopy();
+};
+
+FrameLoopTest::FrameLoopTest() {
+    addTests({&FrameLoopTest::constructNoCreate,
+              &FrameLoopTest::constructZeroFrames,
+              &FrameLoopTest::constructCopy});
+}
+
+void FrameLoopTest::constructNoCreate() {
+    {
+        FrameLoop loop{NoCreate};
+        CORRADE_COMPARE(loop.frameCount(), 0);
+        CORRADE_COMPARE(loop.frame(), 0);
+        CORRADE_COMPARE(loop.image(), -1);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, FrameLoop>::value));
+}
+
+void FrameLoopTest::constructZeroFrames() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    /* The assertion fires before any Vulkan call, so a device without any
+       function pointers is enough */
+    Device device{NoCreate};
+    Queue queue{NoCreate};
+    Swapchain swapchain{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    FrameLoop{device, queue, 0, swapchain, 0};
+    CORRADE_COMPARE(out.str(), "Vk::FrameLoop: expected non-zero frame count\n");
+}
+
+void FrameLoopTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<FrameLoop>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<FrameLoop>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::FrameLoopTest)
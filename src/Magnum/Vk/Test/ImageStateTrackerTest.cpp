@@ -0,0 +1,417 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+*/
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/ImageStateTracker.h"
+#include "Magnum/Vk/Pipeline.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ImageStateTrackerTest: TestSuite::Tester {
+    explicit ImageStateTrackerTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void addImage();
+    void addImageZeroLevels();
+
+    void transition();
+    void transitionFromUndefinedNoAccess();
+    void readAfterWrite();
+    void readAfterRead();
+    void readAfterReadDifferentStage();
+    void writeAfterRead();
+    void writeAfterWrite();
+    void writeWithoutPreviousAccess();
+    void mergeUsesInBatch();
+    void mergeLayerRuns();
+    void subresourceRange();
+    void setState();
+
+    void useInvalid();
+    void useConflictingInBatch();
+    void setStateUsedInBatch();
+};
+
+ImageStateTrackerTest::ImageStateTrackerTest() {
+    addTests({&ImageStateTrackerTest::constructNoCreate,
+              &ImageStateTrackerTest::constructCopy,
+
+              &ImageStateTrackerTest::addImage,
+              &ImageStateTrackerTest::addImageZeroLevels,
+
+              &ImageStateTrackerTest::transition,
+              &ImageStateTrackerTest::transitionFromUndefinedNoAccess,
+              &ImageStateTrackerTest::readAfterWrite,
+              &ImageStateTrackerTest::readAfterRead,
+              &ImageStateTrackerTest::readAfterReadDifferentStage,
+              &ImageStateTrackerTest::writeAfterRead,
+              &ImageStateTrackerTest::writeAfterWrite,
+              &ImageStateTrackerTest::writeWithoutPreviousAccess,
+              &ImageStateTrackerTest::mergeUsesInBatch,
+              &ImageStateTrackerTest::mergeLayerRuns,
+              &ImageStateTrackerTest::subresourceRange,
+              &ImageStateTrackerTest::setState,
+
+              &ImageStateTrackerTest::useInvalid,
+              &ImageStateTrackerTest::useConflictingInBatch,
+              &ImageStateTrackerTest::setStateUsedInBatch});
+}
+
+/* None of the tests call flush(), so there are no Vulkan calls and a device
+   without any function pointers is enough */
+
+void ImageStateTrackerTest::constructNoCreate() {
+    {
+        ImageStateTracker tracker{NoCreate};
+        CORRADE_COMPARE(tracker.imageCount(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, ImageStateTracker>::value));
+}
+
+void ImageStateTrackerTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ImageStateTracker>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ImageStateTracker>{});
+}
+
+void ImageStateTrackerTest::addImage() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    CORRADE_COMPARE(tracker.imageCount(), 0);
+
+    CORRADE_COMPARE(tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 3), 0);
+    CORRADE_COMPARE(tracker.addImage({}, VK_IMAGE_ASPECT_DEPTH_BIT, 1, 4, ImageLayout::General), 1);
+    CORRADE_COMPARE(tracker.imageCount(), 2);
+    CORRADE_COMPARE(tracker.layout(0, 2), ImageLayout::Undefined);
+    CORRADE_COMPARE(tracker.layout(1, 0, 3), ImageLayout::General);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStages{});
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStages{});
+}
+
+void ImageStateTrackerTest::addImageZeroLevels() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 0, 3);
+    tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 2, 0);
+    CORRADE_COMPARE(out.str(),
+        "Vk::ImageStateTracker::addImage(): expected non-zero level and layer count, got 0 and 3\n"
+        "Vk::ImageStateTracker::addImage(): expected non-zero level and layer count, got 2 and 0\n");
+}
+
+void ImageStateTrackerTest::transition() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 2);
+    tracker.setState(id, ImageLayout::ColorAttachment, PipelineStage::ColorAttachmentOutput, Access::ColorAttachmentWrite);
+
+    tracker.use(id, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.layout(id, 1), ImageLayout::ShaderReadOnly);
+
+    /* A single barrier for the whole image */
+    Containers::ArrayView<const VkImageMemoryBarrier> barriers = tracker.pendingBarriers();
+    CORRADE_COMPARE(barriers.size(), 1);
+    CORRADE_COMPARE(barriers[0].oldLayout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    CORRADE_COMPARE(barriers[0].newLayout, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    CORRADE_COMPARE(barriers[0].srcAccessMask, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    CORRADE_COMPARE(barriers[0].dstAccessMask, VK_ACCESS_SHADER_READ_BIT);
+    CORRADE_COMPARE(barriers[0].srcQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barriers[0].dstQueueFamilyIndex, VK_QUEUE_FAMILY_IGNORED);
+    CORRADE_COMPARE(barriers[0].subresourceRange.aspectMask, VK_IMAGE_ASPECT_COLOR_BIT);
+    CORRADE_COMPARE(barriers[0].subresourceRange.baseMipLevel, 0);
+    CORRADE_COMPARE(barriers[0].subresourceRange.levelCount, 2);
+    CORRADE_COMPARE(barriers[0].subresourceRange.baseArrayLayer, 0);
+    CORRADE_COMPARE(barriers[0].subresourceRange.layerCount, 1);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::ColorAttachmentOutput);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader);
+}
+
+void ImageStateTrackerTest::transitionFromUndefinedNoAccess() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+
+    /* Nothing to wait for, the source stage is top of pipe */
+    tracker.use(id, ImageLayout::TransferDestination, PipelineStage::Transfer, Access::TransferWrite);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].oldLayout, VK_IMAGE_LAYOUT_UNDEFINED);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].newLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, 0);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].dstAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::TopOfPipe);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::Transfer);
+}
+
+void ImageStateTrackerTest::readAfterWrite() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.setState(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderWrite);
+
+    /* Same layout, but the write has to be made visible */
+    tracker.use(id, ImageLayout::General, PipelineStage::FragmentShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].oldLayout, VK_IMAGE_LAYOUT_GENERAL);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].newLayout, VK_IMAGE_LAYOUT_GENERAL);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, VK_ACCESS_SHADER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].dstAccessMask, VK_ACCESS_SHADER_READ_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::ComputeShader);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader);
+}
+
+void ImageStateTrackerTest::readAfterRead() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.setState(id, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead);
+
+    /* Reading in the same layout and stage as before needs nothing */
+    tracker.use(id, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStages{});
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStages{});
+}
+
+void ImageStateTrackerTest::readAfterReadDifferentStage() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.setState(id, ImageLayout::TransferDestination, PipelineStage::Transfer, Access::TransferWrite);
+
+    /* The first read needs a transition, the second read in the same batch
+       extends it */
+    tracker.use(id, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead)
+           .use(id, ImageLayout::ShaderReadOnly, PipelineStage::ComputeShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].dstAccessMask, VK_ACCESS_SHADER_READ_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::Transfer);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader|PipelineStage::ComputeShader);
+}
+
+void ImageStateTrackerTest::writeAfterRead() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.setState(id, ImageLayout::General, PipelineStage::FragmentShader, Access::ShaderRead);
+
+    /* Only an execution dependency on the read is needed */
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderWrite);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, 0);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].dstAccessMask, VK_ACCESS_SHADER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::FragmentShader);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::ComputeShader);
+}
+
+void ImageStateTrackerTest::writeAfterWrite() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.setState(id, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderRead|Access::ShaderWrite);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, VK_ACCESS_TRANSFER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].dstAccessMask, VK_ACCESS_SHADER_READ_BIT|VK_ACCESS_SHADER_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::Transfer);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::ComputeShader);
+}
+
+void ImageStateTrackerTest::writeWithoutPreviousAccess() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1, 1, ImageLayout::General);
+
+    /* The image is already in the right layout and nothing touched it yet */
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderWrite);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+}
+
+void ImageStateTrackerTest::mergeUsesInBatch() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt a = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    UnsignedInt b = tracker.addImage({}, VK_IMAGE_ASPECT_DEPTH_BIT, 1);
+    tracker.setState(a, ImageLayout::ColorAttachment, PipelineStage::ColorAttachmentOutput, Access::ColorAttachmentWrite);
+    tracker.setState(b, ImageLayout::DepthStencilAttachment, PipelineStage::LateFragmentTests, Access::DepthStencilAttachmentWrite);
+
+    /* Barriers for both images end up in the same batch, with the stages
+       merged */
+    tracker.use(a, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead)
+           .use(b, ImageLayout::ShaderReadOnly, PipelineStage::ComputeShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 2);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].subresourceRange.aspectMask, VK_IMAGE_ASPECT_COLOR_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].srcAccessMask, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[1].subresourceRange.aspectMask, VK_IMAGE_ASPECT_DEPTH_BIT);
+    CORRADE_COMPARE(tracker.pendingBarriers()[1].srcAccessMask, VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::ColorAttachmentOutput|PipelineStage::LateFragmentTests);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader|PipelineStage::ComputeShader);
+}
+
+void ImageStateTrackerTest::mergeLayerRuns() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1, 4);
+
+    /* Layer 1 is transitioned first, then all of them. Layer 0 gets a
+       barrier, layer 1 reuses the first one and layers 2 and 3 share a
+       third. */
+    tracker.use(id, 0, 1, 1, 1, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead)
+           .use(id, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::InputAttachmentRead);
+    Containers::ArrayView<const VkImageMemoryBarrier> barriers = tracker.pendingBarriers();
+    CORRADE_COMPARE(barriers.size(), 3);
+    CORRADE_COMPARE(barriers[0].subresourceRange.baseArrayLayer, 1);
+    CORRADE_COMPARE(barriers[0].subresourceRange.layerCount, 1);
+    CORRADE_COMPARE(barriers[0].dstAccessMask, VK_ACCESS_SHADER_READ_BIT|VK_ACCESS_INPUT_ATTACHMENT_READ_BIT);
+    CORRADE_COMPARE(barriers[1].subresourceRange.baseArrayLayer, 0);
+    CORRADE_COMPARE(barriers[1].subresourceRange.layerCount, 1);
+    CORRADE_COMPARE(barriers[1].dstAccessMask, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT);
+    CORRADE_COMPARE(barriers[2].subresourceRange.baseArrayLayer, 2);
+    CORRADE_COMPARE(barriers[2].subresourceRange.layerCount, 2);
+    CORRADE_COMPARE(barriers[2].dstAccessMask, VK_ACCESS_INPUT_ATTACHMENT_READ_BIT);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::TopOfPipe);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader);
+}
+
+void ImageStateTrackerTest::subresourceRange() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 3, 2, ImageLayout::General);
+    tracker.setState(id, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+
+    /* Levels 1 and 2 of the second layer, a single barrier */
+    tracker.use(id, 1, 2, 1, 1, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].subresourceRange.baseMipLevel, 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].subresourceRange.levelCount, 2);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].subresourceRange.baseArrayLayer, 1);
+    CORRADE_COMPARE(tracker.pendingBarriers()[0].subresourceRange.layerCount, 1);
+    CORRADE_COMPARE(tracker.layout(id, 0, 1), ImageLayout::General);
+    CORRADE_COMPARE(tracker.layout(id, 1, 0), ImageLayout::General);
+    CORRADE_COMPARE(tracker.layout(id, 1, 1), ImageLayout::ShaderReadOnly);
+    CORRADE_COMPARE(tracker.layout(id, 2, 1), ImageLayout::ShaderReadOnly);
+}
+
+void ImageStateTrackerTest::setState() {
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 2);
+
+    tracker.setState(id, ImageLayout::ColorAttachment, PipelineStage::ColorAttachmentOutput, Access::ColorAttachmentWrite);
+    CORRADE_COMPARE(tracker.layout(id, 0), ImageLayout::ColorAttachment);
+    CORRADE_COMPARE(tracker.layout(id, 1), ImageLayout::ColorAttachment);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+}
+
+void ImageStateTrackerTest::useInvalid() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 3, 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    tracker.layout(1);
+    tracker.layout(id, 3, 0);
+    tracker.use(1, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+    tracker.use(id, 1, 3, 0, 1, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+    tracker.use(id, 0, 1, 1, 0, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+    tracker.use(id, ImageLayout::Preinitialized, PipelineStage::Transfer, Access::TransferWrite);
+    tracker.use(id, ImageLayout::General, {}, Access::TransferWrite);
+    tracker.setState(1, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+    CORRADE_COMPARE(out.str(),
+        "Vk::ImageStateTracker::layout(): index 1 out of range for 1 images\n"
+        "Vk::ImageStateTracker::layout(): level 3 and layer 0 out of range for an image with 3 levels and 2 layers\n"
+        "Vk::ImageStateTracker::use(): index 1 out of range for 1 images\n"
+        "Vk::ImageStateTracker::use(): levels 1:4 and layers 0:1 out of range for an image with 3 levels and 2 layers\n"
+        "Vk::ImageStateTracker::use(): levels 0:1 and layers 1:1 out of range for an image with 3 levels and 2 layers\n"
+        "Vk::ImageStateTracker::use(): can't transition to Vk::ImageLayout::Preinitialized\n"
+        "Vk::ImageStateTracker::use(): expected at least one stage\n"
+        "Vk::ImageStateTracker::setState(): index 1 out of range for 1 images\n");
+}
+
+void ImageStateTrackerTest::useConflictingInBatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1, 2);
+    tracker.setState(id, ImageLayout::TransferDestination, PipelineStage::Transfer, Access::TransferWrite);
+    tracker.use(id, 0, 1, 1, 1, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    /* Different layout */
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderRead);
+    /* A write */
+    tracker.use(id, 0, 1, 1, 1, ImageLayout::ShaderReadOnly, PipelineStage::ComputeShader, Access::ShaderWrite);
+    CORRADE_COMPARE(out.str(),
+        "Vk::ImageStateTracker::use(): level 0 layer 1 of image 0 already used with Vk::ImageLayout::ShaderReadOnly and Vk::Accesses{} in this batch, flush() first\n"
+        "Vk::ImageStateTracker::use(): level 0 layer 1 of image 0 already used with Vk::ImageLayout::ShaderReadOnly and Vk::Accesses{} in this batch, flush() first\n");
+}
+
+void ImageStateTrackerTest::setStateUsedInBatch() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+    ImageStateTracker tracker{device};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderWrite);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    tracker.setState(id, ImageLayout::General, PipelineStage::Transfer, Access::TransferWrite);
+    CORRADE_COMPARE(out.str(),
+        "Vk::ImageStateTracker::setState(): image 0 is used in the pending batch, flush() first\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ImageStateTrackerTest)
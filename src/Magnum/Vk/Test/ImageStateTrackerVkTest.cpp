@@ -0,0 +1,136 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/ImageStateTracker.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct ImageStateTrackerVkTest: VulkanTester {
+    explicit ImageStateTrackerVkTest();
+
+    void constructMove();
+
+    void flush();
+    void flushEmpty();
+};
+
+ImageStateTrackerVkTest::ImageStateTrackerVkTest() {
+    addTests({&ImageStateTrackerVkTest::constructMove,
+
+              &ImageStateTrackerVkTest::flush,
+              &ImageStateTrackerVkTest::flushEmpty});
+}
+
+void ImageStateTrackerVkTest::constructMove() {
+    ImageStateTracker a{device()};
+    a.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+
+    ImageStateTracker b = std::move(a);
+    CORRADE_COMPARE(a.imageCount(), 0);
+    CORRADE_COMPARE(b.imageCount(), 1);
+
+    ImageStateTracker c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(c.imageCount(), 1);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ImageStateTracker>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ImageStateTracker>::value);
+}
+
+void ImageStateTrackerVkTest::flush() {
+    Image a{device(), ImageCreateInfo2D{ImageUsage::TransferDestination|ImageUsage::Sampled,
+        VK_FORMAT_R8G8B8A8_UNORM, {256, 256}, 8}, MemoryFlag::DeviceLocal};
+    Image b{device(), ImageCreateInfo2D{ImageUsage::TransferDestination|ImageUsage::Sampled,
+        VK_FORMAT_R8G8B8A8_UNORM, {16, 16}, 1}, MemoryFlag::DeviceLocal};
+
+    ImageStateTracker tracker{device()};
+    UnsignedInt idA = tracker.addImage(a, VK_IMAGE_ASPECT_COLOR_BIT, 8);
+    UnsignedInt idB = tracker.addImage(b, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    cmd.begin();
+    tracker.use(idA, ImageLayout::TransferDestination, PipelineStage::Transfer, Access::TransferWrite)
+           .use(idB, ImageLayout::TransferDestination, PipelineStage::Transfer, Access::TransferWrite);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 2);
+    tracker.flush(cmd);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+
+    /* Both images are now used again, without any conflict with the previous
+       batch */
+    tracker.use(idA, ImageLayout::ShaderReadOnly, PipelineStage::FragmentShader, Access::ShaderRead)
+           .use(idB, ImageLayout::ShaderReadOnly, PipelineStage::ComputeShader, Access::ShaderRead);
+    CORRADE_COMPARE(tracker.pendingBarriers().size(), 2);
+    CORRADE_COMPARE(tracker.pendingSourceStages(), PipelineStage::Transfer);
+    CORRADE_COMPARE(tracker.pendingDestinationStages(), PipelineStage::FragmentShader|PipelineStage::ComputeShader);
+    tracker.flush(cmd);
+    cmd.end();
+
+    Fence fence{device(), FenceCreateInfo{}};
+    SubmitInfo info;
+    info.setCommandBuffers({cmd});
+    queue().submit({info}, fence);
+    fence.wait();
+
+    CORRADE_COMPARE(tracker.layout(idA, 7), ImageLayout::ShaderReadOnly);
+    CORRADE_COMPARE(tracker.layout(idB), ImageLayout::ShaderReadOnly);
+}
+
+void ImageStateTrackerVkTest::flushEmpty() {
+    ImageStateTracker tracker{device()};
+    UnsignedInt id = tracker.addImage({}, VK_IMAGE_ASPECT_COLOR_BIT, 1, 1, ImageLayout::General);
+
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    /* Nothing to wait for, so no barrier is recorded */
+    cmd.begin();
+    tracker.use(id, ImageLayout::General, PipelineStage::ComputeShader, Access::ShaderWrite);
+    CORRADE_VERIFY(tracker.pendingBarriers().empty());
+    tracker.flush(cmd);
+    cmd.end();
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::ImageStateTrackerVkTest)
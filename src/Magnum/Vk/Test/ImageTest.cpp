@@ -51,6 +51,7 @@ struct ImageTest: TestSuite::Tester {
     void constructCopy();
 
     void dedicatedMemoryNotDedicated();
+    void allocatedMemoryNotAllocated();
 };
 
 ImageTest::ImageTest() {
@@ -68,7 +69,8 @@ ImageTest::ImageTest() {
               &ImageTest::constructNoCreate,
               &ImageTest::constructCopy,
 
-              &ImageTest::dedicatedMemoryNotDedicated});
+              &ImageTest::dedicatedMemoryNotDedicated,
+              &ImageTest::allocatedMemoryNotAllocated});
 }
 
 void ImageTest::createInfoConstruct() {
@@ -219,6 +221,20 @@ void ImageTest::dedicatedMemoryNotDedicated() {
     CORRADE_COMPARE(out.str(), "Vk::Image::dedicatedMemory(): image doesn't have a dedicated memory\n");
 }
 
+void ImageTest::allocatedMemoryNotAllocated() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Image image{NoCreate};
+    CORRADE_VERIFY(!image.hasAllocatedMemory());
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    image.allocatedMemory();
+    CORRADE_COMPARE(out.str(), "Vk::Image::allocatedMemory(): image doesn't have memory from an allocator\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::ImageTest)
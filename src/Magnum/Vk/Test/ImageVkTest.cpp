@@ -30,6 +30,7 @@
 #include "Magnum/Vk/Handle.h"
 #include "Magnum/Vk/ImageCreateInfo.h"
 #include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
 #include "Magnum/Vk/Result.h"
 #include "Magnum/Vk/VulkanTester.h"
 
@@ -53,8 +54,10 @@ struct ImageVkTest: VulkanTester {
 
     void bindMemory();
     void bindDedicatedMemory();
+    void bindAllocatedMemory();
 
     void directAllocation();
+    void allocatorAllocation();
 };
 
 ImageVkTest::ImageVkTest() {
@@ -73,8 +76,10 @@ ImageVkTest::ImageVkTest() {
 
               &ImageVkTest::bindMemory,
               &ImageVkTest::bindDedicatedMemory,
+              &ImageVkTest::bindAllocatedMemory,
 
-              &ImageVkTest::directAllocation});
+              &ImageVkTest::directAllocation,
+              &ImageVkTest::allocatorAllocation});
 }
 
 void ImageVkTest::construct1D() {
@@ -264,6 +269,22 @@ void ImageVkTest::bindDedicatedMemory() {
     CORRADE_COMPARE(image.dedicatedMemory().handle(), handle);
 }
 
+void ImageVkTest::bindAllocatedMemory() {
+    MemoryAllocator allocator{device()};
+
+    Image image{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+        VK_FORMAT_R8G8B8A8_UNORM, {256, 256}, 8}, NoAllocate};
+    MemoryAllocation allocation = allocator.allocate(image.memoryRequirements(), MemoryFlag::DeviceLocal);
+    const UnsignedLong offset = allocation.offset();
+
+    image.bindAllocatedMemory(std::move(allocation));
+    CORRADE_VERIFY(!allocation.allocator());
+    CORRADE_VERIFY(!image.hasDedicatedMemory());
+    CORRADE_VERIFY(image.hasAllocatedMemory());
+    CORRADE_COMPARE(image.allocatedMemory().allocator(), &allocator);
+    CORRADE_COMPARE(image.allocatedMemory().offset(), offset);
+}
+
 void ImageVkTest::directAllocation() {
     Image image{device(), ImageCreateInfo2D{ImageUsage::Sampled,
         VK_FORMAT_R8G8B8A8_UNORM, {256, 256}, 8}, MemoryFlag::DeviceLocal};
@@ -273,6 +294,30 @@ void ImageVkTest::directAllocation() {
     CORRADE_VERIFY(image.dedicatedMemory().handle());
 }
 
+void ImageVkTest::allocatorAllocation() {
+    MemoryAllocator allocator{device()};
+
+    {
+        Image a{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+            VK_FORMAT_R8G8B8A8_UNORM, {256, 256}, 8}, allocator, MemoryFlag::DeviceLocal};
+        Image b{device(), ImageCreateInfo2D{ImageUsage::Sampled,
+            VK_FORMAT_R8G8B8A8_UNORM, {256, 256}, 8}, allocator, MemoryFlag::DeviceLocal};
+        CORRADE_VERIFY(!a.hasDedicatedMemory());
+        CORRADE_VERIFY(a.hasAllocatedMemory());
+        CORRADE_VERIFY(b.hasAllocatedMemory());
+        CORRADE_COMPARE(a.allocatedMemory().strategy(), MemoryAllocationStrategy::General);
+
+        /* Both are sub-allocated from the same block */
+        CORRADE_COMPARE(allocator.statistics().blockCount, 1);
+        CORRADE_COMPARE(allocator.statistics().allocationCount, 2);
+        CORRADE_COMPARE(a.allocatedMemory().memory().handle(), b.allocatedMemory().memory().handle());
+        CORRADE_VERIFY(a.allocatedMemory().offset() != b.allocatedMemory().offset());
+    }
+
+    /* The allocations are given back on destruction */
+    CORRADE_COMPARE(allocator.statistics().allocationCount, 0);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::ImageVkTest)
@@ -0,0 +1,250 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/Implementation/BuddyAllocator.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorTest: TestSuite::Tester {
+    explicit MemoryAllocatorTest();
+
+    void buddyConstruct();
+    void buddyNodeSize();
+    void buddyAllocate();
+    void buddyAllocateFull();
+    void buddyFreeMerge();
+
+    void allocationConstructNoCreate();
+    void allocationConstructCopy();
+    void allocationMemoryMovedOut();
+
+    void constructCopy();
+    void constructInvalidBlockSize();
+
+    void statisticsFragmentation();
+
+    void debugStrategy();
+};
+
+MemoryAllocatorTest::MemoryAllocatorTest() {
+    addTests({&MemoryAllocatorTest::buddyConstruct,
+              &MemoryAllocatorTest::buddyNodeSize,
+              &MemoryAllocatorTest::buddyAllocate,
+              &MemoryAllocatorTest::buddyAllocateFull,
+              &MemoryAllocatorTest::buddyFreeMerge,
+
+              &MemoryAllocatorTest::allocationConstructNoCreate,
+              &MemoryAllocatorTest::allocationConstructCopy,
+              &MemoryAllocatorTest::allocationMemoryMovedOut,
+
+              &MemoryAllocatorTest::constructCopy,
+              &MemoryAllocatorTest::constructInvalidBlockSize,
+
+              &MemoryAllocatorTest::statisticsFragmentation,
+
+              &MemoryAllocatorTest::debugStrategy});
+}
+
+void MemoryAllocatorTest::buddyConstruct() {
+    Implementation::BuddyAllocator buddy{1024, 64};
+    CORRADE_COMPARE(buddy.size(), 1024);
+    CORRADE_COMPARE(buddy.usedSize(), 0);
+    CORRADE_VERIFY(buddy.isEmpty());
+    CORRADE_COMPARE(buddy.largestFreeSize(), 1024);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 1);
+}
+
+void MemoryAllocatorTest::buddyNodeSize() {
+    Implementation::BuddyAllocator buddy{1024, 64};
+
+    /* Rounded up to the minimal size */
+    CORRADE_COMPARE(buddy.nodeSize(1, 1), 64);
+    CORRADE_COMPARE(buddy.nodeSize(64, 16), 64);
+
+    /* Rounded up to the next power of two */
+    CORRADE_COMPARE(buddy.nodeSize(65, 16), 128);
+    CORRADE_COMPARE(buddy.nodeSize(300, 4), 512);
+
+    /* Alignment larger than the size */
+    CORRADE_COMPARE(buddy.nodeSize(100, 256), 256);
+}
+
+void MemoryAllocatorTest::buddyAllocate() {
+    Implementation::BuddyAllocator buddy{1024, 64};
+
+    /* Splitting the whole block down to 128 bytes leaves a free 512, 256 and
+       128 node */
+    CORRADE_COMPARE(buddy.allocate(128), 0);
+    CORRADE_COMPARE(buddy.usedSize(), 128);
+    CORRADE_VERIFY(!buddy.isEmpty());
+    CORRADE_COMPARE(buddy.freeNodeCount(), 3);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 512);
+
+    /* The free 128 node is used */
+    CORRADE_COMPARE(buddy.allocate(128), 128);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 2);
+
+    /* The free 512 node is used */
+    CORRADE_COMPARE(buddy.allocate(512), 512);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 256);
+
+    /* The free 256 node is split into a 128 node and two 64 nodes, one of
+       which is used */
+    CORRADE_COMPARE(buddy.allocate(64), 256);
+    CORRADE_COMPARE(buddy.usedSize(), 832);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 2);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 128);
+}
+
+void MemoryAllocatorTest::buddyAllocateFull() {
+    Implementation::BuddyAllocator buddy{1024, 64};
+
+    /* Larger than the whole block */
+    CORRADE_COMPARE(buddy.allocate(2048), ~UnsignedLong{});
+
+    CORRADE_COMPARE(buddy.allocate(512), 0);
+    CORRADE_COMPARE(buddy.allocate(256), 512);
+
+    /* Only a 256 node left */
+    CORRADE_COMPARE(buddy.allocate(512), ~UnsignedLong{});
+    CORRADE_COMPARE(buddy.allocate(256), 768);
+    CORRADE_COMPARE(buddy.allocate(64), ~UnsignedLong{});
+    CORRADE_COMPARE(buddy.usedSize(), 1024);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 0);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 0);
+}
+
+void MemoryAllocatorTest::buddyFreeMerge() {
+    Implementation::BuddyAllocator buddy{1024, 64};
+
+    CORRADE_COMPARE(buddy.allocate(256), 0);
+    CORRADE_COMPARE(buddy.allocate(256), 256);
+    CORRADE_COMPARE(buddy.allocate(256), 512);
+
+    /* A buddy of the freed node isn't free, so it doesn't merge */
+    buddy.free(0, 256);
+    CORRADE_COMPARE(buddy.usedSize(), 512);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 2);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 256);
+
+    /* Freeing the buddy merges the two into a 512 node */
+    buddy.free(256, 256);
+    CORRADE_COMPARE(buddy.freeNodeCount(), 2);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 512);
+
+    /* Freeing the last merges everything back into a single node */
+    buddy.free(512, 256);
+    CORRADE_VERIFY(buddy.isEmpty());
+    CORRADE_COMPARE(buddy.freeNodeCount(), 1);
+    CORRADE_COMPARE(buddy.largestFreeSize(), 1024);
+
+    /* The whole block can be allocated again */
+    CORRADE_COMPARE(buddy.allocate(1024), 0);
+}
+
+void MemoryAllocatorTest::allocationConstructNoCreate() {
+    {
+        MemoryAllocation allocation{NoCreate};
+        CORRADE_VERIFY(!allocation.allocator());
+        CORRADE_COMPARE(allocation.offset(), 0);
+        CORRADE_COMPARE(allocation.size(), 0);
+    }
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<MemoryAllocation, NoCreateT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, MemoryAllocation>::value));
+}
+
+void MemoryAllocatorTest::allocationConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocation>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocation>{});
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<MemoryAllocation>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<MemoryAllocation>::value);
+}
+
+void MemoryAllocatorTest::allocationMemoryMovedOut() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    MemoryAllocation allocation{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    allocation.memory();
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocation::memory(): the allocation is in a moved-out state\n");
+}
+
+void MemoryAllocatorTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<MemoryAllocator>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<MemoryAllocator>{});
+    CORRADE_VERIFY(!std::is_move_constructible<MemoryAllocator>{});
+    CORRADE_VERIFY(!std::is_move_assignable<MemoryAllocator>{});
+}
+
+void MemoryAllocatorTest::constructInvalidBlockSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Device device{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    MemoryAllocator{device, 0};
+    MemoryAllocator{device, 3*1024*1024};
+    CORRADE_COMPARE(out.str(),
+        "Vk::MemoryAllocator: expected a power-of-two block size, got 0\n"
+        "Vk::MemoryAllocator: expected a power-of-two block size, got 3145728\n");
+}
+
+void MemoryAllocatorTest::statisticsFragmentation() {
+    MemoryAllocator::Statistics statistics{};
+    CORRADE_COMPARE(statistics.fragmentation(), 0.0f);
+
+    statistics.freeSize = 1024;
+    statistics.largestFreeSize = 1024;
+    CORRADE_COMPARE(statistics.fragmentation(), 0.0f);
+
+    statistics.largestFreeSize = 256;
+    CORRADE_COMPARE(statistics.fragmentation(), 0.75f);
+}
+
+void MemoryAllocatorTest::debugStrategy() {
+    std::ostringstream out;
+    Debug{&out} << MemoryAllocationStrategy::Linear << MemoryAllocationStrategy(0xf0);
+    CORRADE_COMPARE(out.str(), "Vk::MemoryAllocationStrategy::Linear Vk::MemoryAllocationStrategy(0xf0)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorTest)
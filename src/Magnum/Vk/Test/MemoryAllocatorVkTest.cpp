@@ -0,0 +1,234 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/MemoryAllocateInfo.h"
+#include "Magnum/Vk/MemoryAllocator.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct MemoryAllocatorVkTest: VulkanTester {
+    explicit MemoryAllocatorVkTest();
+
+    void construct();
+
+    void allocate();
+    void allocateLinear();
+    void allocateDedicated();
+    void allocateNewBlock();
+    void allocateMove();
+
+    void map();
+};
+
+MemoryAllocatorVkTest::MemoryAllocatorVkTest() {
+    addTests({&MemoryAllocatorVkTest::construct,
+
+              &MemoryAllocatorVkTest::allocate,
+              &MemoryAllocatorVkTest::allocateLinear,
+              &MemoryAllocatorVkTest::allocateDedicated,
+              &MemoryAllocatorVkTest::allocateNewBlock,
+              &MemoryAllocatorVkTest::allocateMove,
+
+              &MemoryAllocatorVkTest::map});
+}
+
+void MemoryAllocatorVkTest::construct() {
+    MemoryAllocator allocator{device(), 1024*1024};
+    CORRADE_COMPARE(allocator.blockSize(), 1024*1024);
+
+    /* No memory is allocated upfront */
+    MemoryAllocator::Statistics statistics = allocator.statistics();
+    CORRADE_COMPARE(statistics.blockCount, 0);
+    CORRADE_COMPARE(statistics.blockSize, 0);
+    CORRADE_COMPARE(statistics.allocationCount, 0);
+}
+
+void MemoryAllocatorVkTest::allocate() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::VertexBuffer, 1000}, NoAllocate};
+    const MemoryRequirements requirements = buffer.memoryRequirements();
+
+    {
+        MemoryAllocation a = allocator.allocate(requirements, MemoryFlag::DeviceLocal);
+        MemoryAllocation b = allocator.allocate(requirements, MemoryFlag::DeviceLocal);
+        CORRADE_COMPARE(a.allocator(), &allocator);
+        CORRADE_COMPARE(a.size(), requirements.size());
+        CORRADE_COMPARE(a.strategy(), MemoryAllocationStrategy::General);
+        CORRADE_COMPARE(a.memoryType(), device().properties().pickMemory(MemoryFlag::DeviceLocal, requirements.memories()));
+
+        /* Both are from the same block, correctly aligned and not
+           overlapping */
+        CORRADE_COMPARE(a.memory().handle(), b.memory().handle());
+        CORRADE_COMPARE(a.memory().size(), 1024*1024);
+        CORRADE_COMPARE(a.offset() % requirements.alignment(), 0);
+        CORRADE_COMPARE(b.offset() % requirements.alignment(), 0);
+        CORRADE_VERIFY(a.offset() + a.size() <= b.offset() || b.offset() + b.size() <= a.offset());
+
+        MemoryAllocator::Statistics statistics = allocator.statistics();
+        CORRADE_COMPARE(statistics.blockCount, 1);
+        CORRADE_COMPARE(statistics.blockSize, 1024*1024);
+        CORRADE_COMPARE(statistics.allocationCount, 2);
+        CORRADE_COMPARE(statistics.usedSize + statistics.freeSize, 1024*1024);
+        CORRADE_VERIFY(statistics.usedSize >= 2*requirements.size());
+        CORRADE_VERIFY(statistics.largestFreeSize <= statistics.freeSize);
+    }
+
+    /* The last general block isn't freed when it becomes empty */
+    MemoryAllocator::Statistics statistics = allocator.statistics();
+    CORRADE_COMPARE(statistics.blockCount, 1);
+    CORRADE_COMPARE(statistics.allocationCount, 0);
+    CORRADE_COMPARE(statistics.usedSize, 0);
+    CORRADE_COMPARE(statistics.freeSize, 1024*1024);
+    CORRADE_COMPARE(statistics.largestFreeSize, 1024*1024);
+    CORRADE_COMPARE(statistics.freeRangeCount, 1);
+    CORRADE_COMPARE(statistics.fragmentation(), 0.0f);
+}
+
+void MemoryAllocatorVkTest::allocateLinear() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::TransferSource, 1000}, NoAllocate};
+    const MemoryRequirements requirements = buffer.memoryRequirements();
+
+    UnsignedLong firstOffset;
+    {
+        MemoryAllocation a = allocator.allocate(requirements, MemoryFlag::HostVisible, MemoryAllocationStrategy::Linear);
+        MemoryAllocation b = allocator.allocate(requirements, MemoryFlag::HostVisible, MemoryAllocationStrategy::Linear);
+        CORRADE_COMPARE(a.strategy(), MemoryAllocationStrategy::Linear);
+        CORRADE_COMPARE(a.memory().handle(), b.memory().handle());
+        CORRADE_COMPARE(a.offset(), 0);
+        CORRADE_VERIFY(b.offset() >= a.offset() + a.size());
+        CORRADE_COMPARE(b.offset() % requirements.alignment(), 0);
+        firstOffset = a.offset();
+
+        /* The used size is the bumped offset */
+        MemoryAllocator::Statistics statistics = allocator.statistics();
+        CORRADE_COMPARE(statistics.blockCount, 1);
+        CORRADE_COMPARE(statistics.usedSize, b.offset() + b.size());
+        CORRADE_COMPARE(statistics.freeSize, 0);
+    }
+
+    /* Once all allocations are freed, the block is reused from the start */
+    MemoryAllocation c = allocator.allocate(requirements, MemoryFlag::HostVisible, MemoryAllocationStrategy::Linear);
+    CORRADE_COMPARE(c.offset(), firstOffset);
+    CORRADE_COMPARE(allocator.statistics().blockCount, 1);
+}
+
+void MemoryAllocatorVkTest::allocateDedicated() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::VertexBuffer, 3*1024*1024}, NoAllocate};
+    const MemoryRequirements requirements = buffer.memoryRequirements();
+
+    {
+        /* Larger than the block size, gets a block of its own */
+        MemoryAllocation a = allocator.allocate(requirements, MemoryFlag::DeviceLocal);
+        CORRADE_COMPARE(a.offset(), 0);
+        CORRADE_COMPARE(a.memory().size(), requirements.size());
+
+        MemoryAllocator::Statistics statistics = allocator.statistics();
+        CORRADE_COMPARE(statistics.blockCount, 1);
+        CORRADE_COMPARE(statistics.blockSize, requirements.size());
+        CORRADE_COMPARE(statistics.usedSize, requirements.size());
+    }
+
+    /* Dedicated blocks are freed right away */
+    CORRADE_COMPARE(allocator.statistics().blockCount, 0);
+}
+
+void MemoryAllocatorVkTest::allocateNewBlock() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::VertexBuffer, 600*1024}, NoAllocate};
+    const MemoryRequirements requirements = buffer.memoryRequirements();
+
+    /* Rounded up to 1 MB, so each takes a whole block */
+    MemoryAllocation a = allocator.allocate(requirements, MemoryFlag::DeviceLocal);
+    {
+        MemoryAllocation b = allocator.allocate(requirements, MemoryFlag::DeviceLocal);
+        CORRADE_VERIFY(a.memory().handle() != b.memory().handle());
+        CORRADE_COMPARE(allocator.statistics().blockCount, 2);
+        CORRADE_COMPARE(allocator.statistics().freeSize, 0);
+    }
+
+    /* An empty block gets freed if it's not the last one */
+    CORRADE_COMPARE(allocator.statistics().blockCount, 1);
+}
+
+void MemoryAllocatorVkTest::allocateMove() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::VertexBuffer, 1000}, NoAllocate};
+    MemoryAllocation a = allocator.allocate(buffer.memoryRequirements(), MemoryFlag::DeviceLocal);
+    const UnsignedLong offset = a.offset();
+    VkDeviceMemory handle = a.memory();
+
+    MemoryAllocation b = std::move(a);
+    CORRADE_VERIFY(!a.allocator());
+    CORRADE_COMPARE(b.allocator(), &allocator);
+    CORRADE_COMPARE(b.offset(), offset);
+    CORRADE_COMPARE(b.memory().handle(), handle);
+
+    MemoryAllocation c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.allocator());
+    CORRADE_COMPARE(c.allocator(), &allocator);
+    CORRADE_COMPARE(c.offset(), offset);
+    CORRADE_COMPARE(c.memory().handle(), handle);
+
+    /* Moving doesn't free anything */
+    CORRADE_COMPARE(allocator.statistics().allocationCount, 1);
+}
+
+void MemoryAllocatorVkTest::map() {
+    MemoryAllocator allocator{device(), 1024*1024};
+
+    Buffer buffer{device(), BufferCreateInfo{BufferUsage::TransferSource, 1000}, NoAllocate};
+    const MemoryRequirements requirements = buffer.memoryRequirements();
+    MemoryAllocation a = allocator.allocate(requirements, MemoryFlag::HostVisible);
+
+    /* Map and write just the allocation range */
+    {
+        Containers::Array<char, MemoryMapDeleter> mapped = a.memory().map(a.offset(), a.size());
+        CORRADE_COMPARE(mapped.size(), a.size());
+        mapped[37] = 'c';
+    }
+
+    /* Map the whole block and read back at the allocation offset */
+    {
+        Containers::Array<const char, MemoryMapDeleter> mapped = a.memory().mapRead();
+        CORRADE_COMPARE(mapped[a.offset() + 37], 'c');
+    }
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::MemoryAllocatorVkTest)
@@ -0,0 +1,85 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/PipelineCache.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineCacheTest: TestSuite::Tester {
+    explicit PipelineCacheTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void mergeSelf();
+};
+
+PipelineCacheTest::PipelineCacheTest() {
+    addTests({&PipelineCacheTest::constructNoCreate,
+              &PipelineCacheTest::constructCopy,
+
+              &PipelineCacheTest::mergeSelf});
+}
+
+void PipelineCacheTest::constructNoCreate() {
+    {
+        PipelineCache cache{NoCreate};
+        CORRADE_VERIFY(!cache.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, PipelineCache>::value));
+}
+
+void PipelineCacheTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<PipelineCache, const PipelineCache&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<PipelineCache, const PipelineCache&>{}));
+}
+
+void PipelineCacheTest::mergeSelf() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    /* The assertion fires before any Vulkan call, so a fake handle and a
+       device without any function pointers is enough */
+    Device device{NoCreate};
+    const VkPipelineCache handle = reinterpret_cast<VkPipelineCache>(0xdead);
+    PipelineCache cache = PipelineCache::wrap(device, handle);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    cache.merge({reinterpret_cast<VkPipelineCache>(0xbeef), handle});
+    CORRADE_COMPARE(out.str(), "Vk::PipelineCache::merge(): can't merge a cache into itself\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineCacheTest)
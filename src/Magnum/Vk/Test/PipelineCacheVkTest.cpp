@@ -0,0 +1,231 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/PipelineCache.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineCacheVkTest: VulkanTester {
+    explicit PipelineCacheVkTest();
+
+    void construct();
+    void constructData();
+    void constructMove();
+
+    void wrap();
+
+    void merge();
+
+    void saveLoad();
+    void loadNonexistent();
+    void loadDifferentHeader();
+    void loadTooShort();
+};
+
+PipelineCacheVkTest::PipelineCacheVkTest() {
+    addTests({&PipelineCacheVkTest::construct,
+              &PipelineCacheVkTest::constructData,
+              &PipelineCacheVkTest::constructMove,
+
+              &PipelineCacheVkTest::wrap,
+
+              &PipelineCacheVkTest::merge,
+
+              &PipelineCacheVkTest::saveLoad,
+              &PipelineCacheVkTest::loadNonexistent,
+              &PipelineCacheVkTest::loadDifferentHeader,
+              &PipelineCacheVkTest::loadTooShort});
+}
+
+/* Populates the cache with a single compute pipeline so there's something
+   besides the driver header in it */
+void populate(Device& device, PipelineCache& cache) {
+    Shader shader{device, ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "compute-noop.spv"))}};
+    PipelineLayout layout{device, PipelineLayoutCreateInfo{}};
+    Pipeline{device, ComputePipelineCreateInfo{layout, shader}, cache};
+}
+
+void PipelineCacheVkTest::construct() {
+    {
+        PipelineCache cache{device()};
+        CORRADE_VERIFY(cache.handle());
+        CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+        /* Even an empty cache has the driver header in it */
+        CORRADE_VERIFY(!cache.data().empty());
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineCacheVkTest::constructData() {
+    PipelineCache a{device()};
+    populate(device(), a);
+    Containers::Array<char> data = a.data();
+
+    PipelineCache b{device(), data};
+    CORRADE_VERIFY(b.handle());
+
+    /* The driver is free to reorganize the data, so not comparing the
+       contents, just verifying something got in */
+    CORRADE_VERIFY(!b.data().empty());
+}
+
+void PipelineCacheVkTest::constructMove() {
+    PipelineCache a{device()};
+    VkPipelineCache handle = a.handle();
+
+    PipelineCache b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    PipelineCache c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PipelineCache>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PipelineCache>::value);
+}
+
+void PipelineCacheVkTest::wrap() {
+    VkPipelineCacheCreateInfo info{};
+    info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    VkPipelineCache cache{};
+    CORRADE_COMPARE(Result(device()->CreatePipelineCache(device(), &info,
+        nullptr, &cache)), Result::Success);
+
+    auto wrapped = PipelineCache::wrap(device(), cache, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), cache);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), cache);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyPipelineCache(device(), cache, nullptr);
+}
+
+void PipelineCacheVkTest::merge() {
+    PipelineCache a{device()};
+    PipelineCache b{device()};
+    populate(device(), b);
+    PipelineCache c{device()};
+
+    a.merge({b, c});
+
+    /* Can't really verify the contents, only that the merged cache is not
+       smaller than the one it was merged from */
+    CORRADE_COMPARE_AS(a.data().size(), b.data().size(),
+        TestSuite::Compare::GreaterOrEqual);
+}
+
+void PipelineCacheVkTest::saveLoad() {
+    const std::string filename = Utility::Directory::join(PIPELINECACHEVKTEST_SAVE_DIR, "cache.bin");
+    if(Utility::Directory::exists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    {
+        PipelineCache cache{device()};
+        populate(device(), cache);
+        CORRADE_VERIFY(cache.save(filename));
+    }
+
+    CORRADE_VERIFY(Utility::Directory::exists(filename));
+    /* The temporary file shouldn't be left behind */
+    CORRADE_VERIFY(!Utility::Directory::exists(filename + ".tmp"));
+
+    /* The file has our 32-byte header in front of the driver data */
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_COMPARE_AS(data.size(), 32,
+        TestSuite::Compare::Greater);
+    CORRADE_COMPARE(std::string(data.data(), 4), "MPC1");
+
+    PipelineCache cache = PipelineCache::load(device(), filename);
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+    CORRADE_VERIFY(!cache.data().empty());
+}
+
+void PipelineCacheVkTest::loadNonexistent() {
+    PipelineCache cache = PipelineCache::load(device(),
+        Utility::Directory::join(PIPELINECACHEVKTEST_SAVE_DIR, "nonexistent.bin"));
+
+    /* An empty cache is created instead */
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_COMPARE(cache.handleFlags(), HandleFlag::DestroyOnDestruction);
+}
+
+void PipelineCacheVkTest::loadDifferentHeader() {
+    const std::string filename = Utility::Directory::join(PIPELINECACHEVKTEST_SAVE_DIR, "different.bin");
+    {
+        PipelineCache cache{device()};
+        populate(device(), cache);
+        CORRADE_VERIFY(cache.save(filename));
+    }
+
+    /* Pretend the file was made by a different driver version */
+    Containers::Array<char> data = Utility::Directory::read(filename);
+    CORRADE_COMPARE_AS(data.size(), 32,
+        TestSuite::Compare::Greater);
+    ++data[12];
+    CORRADE_VERIFY(Utility::Directory::write(filename, data));
+
+    /* An empty cache is created instead, the file is left in place to get
+       overwritten on the next save */
+    PipelineCache cache = PipelineCache::load(device(), filename);
+    CORRADE_VERIFY(cache.handle());
+    CORRADE_VERIFY(Utility::Directory::exists(filename));
+}
+
+void PipelineCacheVkTest::loadTooShort() {
+    const std::string filename = Utility::Directory::join(PIPELINECACHEVKTEST_SAVE_DIR, "short.bin");
+    CORRADE_VERIFY(Utility::Directory::mkpath(PIPELINECACHEVKTEST_SAVE_DIR));
+    CORRADE_VERIFY(Utility::Directory::writeString(filename, "MPC1"));
+
+    PipelineCache cache = PipelineCache::load(device(), filename);
+    CORRADE_VERIFY(cache.handle());
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineCacheVkTest)
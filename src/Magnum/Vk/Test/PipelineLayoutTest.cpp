@@ -0,0 +1,170 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineLayoutTest: TestSuite::Tester {
+    explicit PipelineLayoutTest();
+
+    void createInfoConstruct();
+    void createInfoConstructEmpty();
+    void createInfoConstructNoInit();
+    void createInfoConstructFromVk();
+    void createInfoConstructCopy();
+    void createInfoConstructMove();
+    void createInfoPushConstantRanges();
+
+    void constructNoCreate();
+    void constructCopy();
+};
+
+PipelineLayoutTest::PipelineLayoutTest() {
+    addTests({&PipelineLayoutTest::createInfoConstruct,
+              &PipelineLayoutTest::createInfoConstructEmpty,
+              &PipelineLayoutTest::createInfoConstructNoInit,
+              &PipelineLayoutTest::createInfoConstructFromVk,
+              &PipelineLayoutTest::createInfoConstructCopy,
+              &PipelineLayoutTest::createInfoConstructMove,
+              &PipelineLayoutTest::createInfoPushConstantRanges,
+
+              &PipelineLayoutTest::constructNoCreate,
+              &PipelineLayoutTest::constructCopy});
+}
+
+const VkDescriptorSetLayout LayoutA = reinterpret_cast<VkDescriptorSetLayout>(0xdead);
+const VkDescriptorSetLayout LayoutB = reinterpret_cast<VkDescriptorSetLayout>(0xbeef);
+
+void PipelineLayoutTest::createInfoConstruct() {
+    /** @todo use a real flag once it exists */
+    PipelineLayoutCreateInfo info{{LayoutA, LayoutB}, PipelineLayoutCreateInfo::Flag(VK_PIPELINE_LAYOUT_CREATE_FLAG_BITS_MAX_ENUM)};
+    CORRADE_COMPARE(info->flags, VK_PIPELINE_LAYOUT_CREATE_FLAG_BITS_MAX_ENUM);
+    CORRADE_COMPARE(info->setLayoutCount, 2);
+    CORRADE_VERIFY(info->pSetLayouts);
+    CORRADE_COMPARE(info->pSetLayouts[0], LayoutA);
+    CORRADE_COMPARE(info->pSetLayouts[1], LayoutB);
+    CORRADE_COMPARE(info->pushConstantRangeCount, 0);
+    CORRADE_VERIFY(!info->pPushConstantRanges);
+}
+
+void PipelineLayoutTest::createInfoConstructEmpty() {
+    PipelineLayoutCreateInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO);
+    CORRADE_COMPARE(info->flags, 0);
+    CORRADE_COMPARE(info->setLayoutCount, 0);
+    CORRADE_VERIFY(!info->pSetLayouts);
+}
+
+void PipelineLayoutTest::createInfoConstructNoInit() {
+    PipelineLayoutCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) PipelineLayoutCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<PipelineLayoutCreateInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, PipelineLayoutCreateInfo>::value));
+}
+
+void PipelineLayoutTest::createInfoConstructFromVk() {
+    VkPipelineLayoutCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    PipelineLayoutCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void PipelineLayoutTest::createInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<PipelineLayoutCreateInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<PipelineLayoutCreateInfo>{});
+}
+
+void PipelineLayoutTest::createInfoConstructMove() {
+    PipelineLayoutCreateInfo a{{LayoutA, LayoutB}};
+    a.addPushConstantRange(ShaderStage::Vertex, 0, 64);
+
+    PipelineLayoutCreateInfo b = std::move(a);
+    CORRADE_COMPARE(a->setLayoutCount, 0);
+    CORRADE_VERIFY(!a->pSetLayouts);
+    CORRADE_COMPARE(a->pushConstantRangeCount, 0);
+    CORRADE_VERIFY(!a->pPushConstantRanges);
+    CORRADE_COMPARE(b->setLayoutCount, 2);
+    CORRADE_VERIFY(b->pSetLayouts);
+    CORRADE_COMPARE(b->pSetLayouts[1], LayoutB);
+    CORRADE_COMPARE(b->pushConstantRangeCount, 1);
+    CORRADE_VERIFY(b->pPushConstantRanges);
+    CORRADE_COMPARE(b->pPushConstantRanges[0].size, 64);
+
+    PipelineLayoutCreateInfo c{VkPipelineLayoutCreateInfo{}};
+    c = std::move(b);
+    CORRADE_COMPARE(b->setLayoutCount, 0);
+    CORRADE_VERIFY(!b->pSetLayouts);
+    CORRADE_COMPARE(c->setLayoutCount, 2);
+    CORRADE_VERIFY(c->pSetLayouts);
+    CORRADE_COMPARE(c->pSetLayouts[1], LayoutB);
+    CORRADE_COMPARE(c->pushConstantRangeCount, 1);
+    CORRADE_COMPARE(c->pPushConstantRanges[0].size, 64);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<PipelineLayoutCreateInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<PipelineLayoutCreateInfo>::value);
+}
+
+void PipelineLayoutTest::createInfoPushConstantRanges() {
+    PipelineLayoutCreateInfo info;
+    info.addPushConstantRange(ShaderStage::Vertex|ShaderStage::Fragment, 0, 64)
+        .addPushConstantRange(ShaderStage::Compute, 64, 16);
+    CORRADE_COMPARE(info->pushConstantRangeCount, 2);
+    CORRADE_VERIFY(info->pPushConstantRanges);
+    CORRADE_COMPARE(info->pPushConstantRanges[0].stageFlags, VK_SHADER_STAGE_VERTEX_BIT|VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(info->pPushConstantRanges[0].offset, 0);
+    CORRADE_COMPARE(info->pPushConstantRanges[0].size, 64);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].stageFlags, VK_SHADER_STAGE_COMPUTE_BIT);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].offset, 64);
+    CORRADE_COMPARE(info->pPushConstantRanges[1].size, 16);
+}
+
+void PipelineLayoutTest::constructNoCreate() {
+    {
+        PipelineLayout layout{NoCreate};
+        CORRADE_VERIFY(!layout.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, PipelineLayout>::value));
+}
+
+void PipelineLayoutTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<PipelineLayout, const PipelineLayout&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<PipelineLayout, const PipelineLayout&>{}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineLayoutTest)
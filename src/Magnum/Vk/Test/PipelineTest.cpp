@@ -0,0 +1,448 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <new>
+#include <sstream>
+#include <Corrade/Containers/String.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineTest: TestSuite::Tester {
+    explicit PipelineTest();
+
+    void graphicsCreateInfoConstruct();
+    void graphicsCreateInfoConstructNoInit();
+    void graphicsCreateInfoConstructFromVk();
+    void graphicsCreateInfoConstructCopy();
+    void graphicsCreateInfoConstructMove();
+    void graphicsCreateInfoAddShader();
+    void graphicsCreateInfoAddShaderEntrypointCopy();
+    void graphicsCreateInfoVertexInput();
+    void graphicsCreateInfoPrimitive();
+    void graphicsCreateInfoViewport();
+    void graphicsCreateInfoDepthTestFaceCulling();
+    void graphicsCreateInfoSetterOnFromVk();
+
+    void computeCreateInfoConstruct();
+    void computeCreateInfoConstructEntrypointCopy();
+    void computeCreateInfoConstructNoInit();
+    void computeCreateInfoConstructFromVk();
+    void computeCreateInfoConstructCopy();
+    void computeCreateInfoConstructMove();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void debugPipelineStage();
+    void debugPipelineStages();
+    void debugAccess();
+    void debugAccesses();
+    void debugBindPoint();
+};
+
+PipelineTest::PipelineTest() {
+    addTests({&PipelineTest::graphicsCreateInfoConstruct,
+              &PipelineTest::graphicsCreateInfoConstructNoInit,
+              &PipelineTest::graphicsCreateInfoConstructFromVk,
+              &PipelineTest::graphicsCreateInfoConstructCopy,
+              &PipelineTest::graphicsCreateInfoConstructMove,
+              &PipelineTest::graphicsCreateInfoAddShader,
+              &PipelineTest::graphicsCreateInfoAddShaderEntrypointCopy,
+              &PipelineTest::graphicsCreateInfoVertexInput,
+              &PipelineTest::graphicsCreateInfoPrimitive,
+              &PipelineTest::graphicsCreateInfoViewport,
+              &PipelineTest::graphicsCreateInfoDepthTestFaceCulling,
+              &PipelineTest::graphicsCreateInfoSetterOnFromVk,
+
+              &PipelineTest::computeCreateInfoConstruct,
+              &PipelineTest::computeCreateInfoConstructEntrypointCopy,
+              &PipelineTest::computeCreateInfoConstructNoInit,
+              &PipelineTest::computeCreateInfoConstructFromVk,
+              &PipelineTest::computeCreateInfoConstructCopy,
+              &PipelineTest::computeCreateInfoConstructMove,
+
+              &PipelineTest::constructNoCreate,
+              &PipelineTest::constructCopy,
+
+              &PipelineTest::debugPipelineStage,
+              &PipelineTest::debugPipelineStages,
+              &PipelineTest::debugAccess,
+              &PipelineTest::debugAccesses,
+              &PipelineTest::debugBindPoint});
+}
+
+using namespace Containers::Literals;
+
+void PipelineTest::graphicsCreateInfoConstruct() {
+    GraphicsPipelineCreateInfo info{reinterpret_cast<VkPipelineLayout>(0xdead), reinterpret_cast<VkRenderPass>(0xbeef), 3, 2, GraphicsPipelineCreateInfo::Flag::DisableOptimization};
+    CORRADE_COMPARE(info->flags, VK_PIPELINE_CREATE_DISABLE_OPTIMIZATION_BIT);
+    CORRADE_COMPARE(info->stageCount, 0);
+    CORRADE_VERIFY(!info->pStages);
+    CORRADE_COMPARE(info->layout, reinterpret_cast<VkPipelineLayout>(0xdead));
+    CORRADE_COMPARE(info->renderPass, reinterpret_cast<VkRenderPass>(0xbeef));
+    CORRADE_COMPARE(info->subpass, 3);
+    CORRADE_COMPARE(info->basePipelineIndex, -1);
+
+    CORRADE_VERIFY(info->pVertexInputState);
+    CORRADE_COMPARE(info->pVertexInputState->sType, VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO);
+    CORRADE_COMPARE(info->pVertexInputState->vertexBindingDescriptionCount, 0);
+    CORRADE_COMPARE(info->pVertexInputState->vertexAttributeDescriptionCount, 0);
+
+    CORRADE_VERIFY(info->pInputAssemblyState);
+    CORRADE_COMPARE(info->pInputAssemblyState->topology, VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
+
+    CORRADE_VERIFY(info->pViewportState);
+    CORRADE_COMPARE(info->pViewportState->viewportCount, 1);
+    CORRADE_VERIFY(!info->pViewportState->pViewports);
+    CORRADE_COMPARE(info->pViewportState->scissorCount, 1);
+    CORRADE_VERIFY(!info->pViewportState->pScissors);
+
+    CORRADE_VERIFY(info->pRasterizationState);
+    CORRADE_COMPARE(info->pRasterizationState->polygonMode, VK_POLYGON_MODE_FILL);
+    CORRADE_COMPARE(info->pRasterizationState->cullMode, VK_CULL_MODE_NONE);
+    CORRADE_COMPARE(info->pRasterizationState->lineWidth, 1.0f);
+
+    CORRADE_VERIFY(info->pMultisampleState);
+    CORRADE_COMPARE(info->pMultisampleState->rasterizationSamples, VK_SAMPLE_COUNT_1_BIT);
+
+    CORRADE_VERIFY(info->pDepthStencilState);
+    CORRADE_COMPARE(info->pDepthStencilState->depthTestEnable, VK_FALSE);
+    CORRADE_COMPARE(info->pDepthStencilState->depthWriteEnable, VK_FALSE);
+
+    CORRADE_VERIFY(info->pColorBlendState);
+    CORRADE_COMPARE(info->pColorBlendState->attachmentCount, 2);
+    CORRADE_VERIFY(info->pColorBlendState->pAttachments);
+    CORRADE_COMPARE(info->pColorBlendState->pAttachments[1].blendEnable, VK_FALSE);
+    CORRADE_COMPARE(info->pColorBlendState->pAttachments[1].colorWriteMask, VK_COLOR_COMPONENT_R_BIT|VK_COLOR_COMPONENT_G_BIT|VK_COLOR_COMPONENT_B_BIT|VK_COLOR_COMPONENT_A_BIT);
+
+    CORRADE_VERIFY(info->pDynamicState);
+    CORRADE_COMPARE(info->pDynamicState->dynamicStateCount, 2);
+    CORRADE_COMPARE(info->pDynamicState->pDynamicStates[0], VK_DYNAMIC_STATE_VIEWPORT);
+    CORRADE_COMPARE(info->pDynamicState->pDynamicStates[1], VK_DYNAMIC_STATE_SCISSOR);
+}
+
+void PipelineTest::graphicsCreateInfoConstructNoInit() {
+    GraphicsPipelineCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) GraphicsPipelineCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<GraphicsPipelineCreateInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, GraphicsPipelineCreateInfo>::value));
+}
+
+void PipelineTest::graphicsCreateInfoConstructFromVk() {
+    VkGraphicsPipelineCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    GraphicsPipelineCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void PipelineTest::graphicsCreateInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<GraphicsPipelineCreateInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<GraphicsPipelineCreateInfo>{});
+}
+
+void PipelineTest::graphicsCreateInfoConstructMove() {
+    GraphicsPipelineCreateInfo a{{}, {}, 0, 1};
+    a.addShader(ShaderStage::Vertex, reinterpret_cast<VkShaderModule>(0xdead), "ver");
+    const VkPipelineColorBlendStateCreateInfo* colorBlend = a->pColorBlendState;
+
+    GraphicsPipelineCreateInfo b = std::move(a);
+    CORRADE_COMPARE(a->stageCount, 0);
+    CORRADE_VERIFY(!a->pStages);
+    CORRADE_VERIFY(!a->pColorBlendState);
+    CORRADE_COMPARE(b->stageCount, 1);
+    CORRADE_VERIFY(b->pStages);
+    CORRADE_COMPARE(b->pStages[0].pName, "ver"_s);
+    /* The state is on the heap so the pointers shouldn't change */
+    CORRADE_COMPARE(b->pColorBlendState, colorBlend);
+
+    GraphicsPipelineCreateInfo c{VkGraphicsPipelineCreateInfo{}};
+    c = std::move(b);
+    CORRADE_COMPARE(b->stageCount, 0);
+    CORRADE_VERIFY(!b->pStages);
+    CORRADE_COMPARE(c->stageCount, 1);
+    CORRADE_COMPARE(c->pStages[0].pName, "ver"_s);
+    CORRADE_COMPARE(c->pColorBlendState, colorBlend);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<GraphicsPipelineCreateInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<GraphicsPipelineCreateInfo>::value);
+}
+
+void PipelineTest::graphicsCreateInfoAddShader() {
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.addShader(ShaderStage::Vertex, reinterpret_cast<VkShaderModule>(0xdead))
+        .addShader(ShaderStage::Fragment, reinterpret_cast<VkShaderModule>(0xbeef), "fra");
+    CORRADE_COMPARE(info->stageCount, 2);
+    CORRADE_VERIFY(info->pStages);
+    CORRADE_COMPARE(info->pStages[0].sType, VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO);
+    CORRADE_COMPARE(info->pStages[0].stage, VK_SHADER_STAGE_VERTEX_BIT);
+    CORRADE_COMPARE(info->pStages[0].module, reinterpret_cast<VkShaderModule>(0xdead));
+    CORRADE_COMPARE(info->pStages[0].pName, "main"_s);
+    CORRADE_COMPARE(info->pStages[1].sType, VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO);
+    CORRADE_COMPARE(info->pStages[1].stage, VK_SHADER_STAGE_FRAGMENT_BIT);
+    CORRADE_COMPARE(info->pStages[1].module, reinterpret_cast<VkShaderModule>(0xbeef));
+    CORRADE_COMPARE(info->pStages[1].pName, "fra"_s);
+}
+
+void PipelineTest::graphicsCreateInfoAddShaderEntrypointCopy() {
+    Containers::String vertex = "vertexMain!";
+    Containers::String fragment = "fragmentMain!";
+
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.addShader(ShaderStage::Vertex, {}, vertex.prefix(vertex.size() - 1))
+        .addShader(ShaderStage::Fragment, {}, fragment.prefix(fragment.size() - 1));
+
+    /* Overwrite the originals to verify a copy was made. The first copy is
+       short enough to be stored inline, which should survive the array
+       reallocation on the second add. */
+    vertex[0] = fragment[0] = '?';
+    CORRADE_COMPARE(info->stageCount, 2);
+    CORRADE_COMPARE(info->pStages[0].pName, "vertexMain"_s);
+    CORRADE_COMPARE(info->pStages[1].pName, "fragmentMain"_s);
+}
+
+void PipelineTest::graphicsCreateInfoVertexInput() {
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.addVertexBinding(0, 24)
+        .addInstanceBinding(1, 64)
+        .addVertexAttribute(0, 0, VertexFormat::Vector3, 0)
+        .addVertexAttribute(3, 0, VertexFormat::Vector2ubNormalized, 12)
+        .addVertexAttribute(5, 1, VertexFormat::Matrix4x4, 0);
+
+    const VkPipelineVertexInputStateCreateInfo& vertexInput = *info->pVertexInputState;
+    CORRADE_COMPARE(vertexInput.vertexBindingDescriptionCount, 2);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].binding, 0);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].stride, 24);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[0].inputRate, VK_VERTEX_INPUT_RATE_VERTEX);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[1].binding, 1);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[1].stride, 64);
+    CORRADE_COMPARE(vertexInput.pVertexBindingDescriptions[1].inputRate, VK_VERTEX_INPUT_RATE_INSTANCE);
+
+    CORRADE_COMPARE(vertexInput.vertexAttributeDescriptionCount, 3);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].location, 0);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].binding, 0);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].format, VK_FORMAT_R32G32B32_SFLOAT);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[0].offset, 0);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].location, 3);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].format, VK_FORMAT_R8G8_UNORM);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[1].offset, 12);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[2].location, 5);
+    CORRADE_COMPARE(vertexInput.pVertexAttributeDescriptions[2].binding, 1);
+}
+
+void PipelineTest::graphicsCreateInfoPrimitive() {
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.setPrimitive(MeshPrimitive::LineStrip);
+    CORRADE_COMPARE(info->pInputAssemblyState->topology, VK_PRIMITIVE_TOPOLOGY_LINE_STRIP);
+}
+
+void PipelineTest::graphicsCreateInfoViewport() {
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.setViewport({{2.5f, 3.0f, 0.25f}, {802.5f, 603.0f, 0.75f}}, {{2, 3}, {700, 500}});
+    CORRADE_VERIFY(!info->pDynamicState);
+
+    const VkPipelineViewportStateCreateInfo& viewportState = *info->pViewportState;
+    CORRADE_COMPARE(viewportState.viewportCount, 1);
+    CORRADE_VERIFY(viewportState.pViewports);
+    CORRADE_COMPARE(viewportState.pViewports->x, 2.5f);
+    CORRADE_COMPARE(viewportState.pViewports->y, 3.0f);
+    CORRADE_COMPARE(viewportState.pViewports->width, 800.0f);
+    CORRADE_COMPARE(viewportState.pViewports->height, 600.0f);
+    CORRADE_COMPARE(viewportState.pViewports->minDepth, 0.25f);
+    CORRADE_COMPARE(viewportState.pViewports->maxDepth, 0.75f);
+    CORRADE_COMPARE(viewportState.scissorCount, 1);
+    CORRADE_VERIFY(viewportState.pScissors);
+    CORRADE_COMPARE(viewportState.pScissors->offset.x, 2);
+    CORRADE_COMPARE(viewportState.pScissors->offset.y, 3);
+    CORRADE_COMPARE(viewportState.pScissors->extent.width, 698);
+    CORRADE_COMPARE(viewportState.pScissors->extent.height, 497);
+
+    /* The 2D overload should set the full depth range and a matching
+       scissor */
+    info.setViewport(Range2D{{0.0f, 0.0f}, {640.0f, 480.0f}});
+    CORRADE_COMPARE(viewportState.pViewports->width, 640.0f);
+    CORRADE_COMPARE(viewportState.pViewports->minDepth, 0.0f);
+    CORRADE_COMPARE(viewportState.pViewports->maxDepth, 1.0f);
+    CORRADE_COMPARE(viewportState.pScissors->offset.x, 0);
+    CORRADE_COMPARE(viewportState.pScissors->extent.width, 640);
+    CORRADE_COMPARE(viewportState.pScissors->extent.height, 480);
+}
+
+void PipelineTest::graphicsCreateInfoDepthTestFaceCulling() {
+    GraphicsPipelineCreateInfo info{{}, {}, 0, 1};
+    info.setDepthTest(true)
+        .setFaceCulling(true);
+    CORRADE_COMPARE(info->pDepthStencilState->depthTestEnable, VK_TRUE);
+    CORRADE_COMPARE(info->pDepthStencilState->depthWriteEnable, VK_TRUE);
+    CORRADE_COMPARE(info->pDepthStencilState->depthCompareOp, VK_COMPARE_OP_LESS_OR_EQUAL);
+    CORRADE_COMPARE(info->pRasterizationState->cullMode, VK_CULL_MODE_BACK_BIT);
+
+    info.setDepthTest(false)
+        .setFaceCulling(false);
+    CORRADE_COMPARE(info->pDepthStencilState->depthTestEnable, VK_FALSE);
+    CORRADE_COMPARE(info->pDepthStencilState->depthWriteEnable, VK_FALSE);
+    CORRADE_COMPARE(info->pRasterizationState->cullMode, VK_CULL_MODE_NONE);
+}
+
+void PipelineTest::graphicsCreateInfoSetterOnFromVk() {
+    VkPipelineRasterizationStateCreateInfo rasterization{};
+    VkGraphicsPipelineCreateInfo vkInfo{};
+    vkInfo.pRasterizationState = &rasterization;
+
+    /* Setters should lazily create the state and replace only the affected
+       structures */
+    GraphicsPipelineCreateInfo info{vkInfo};
+    info.setPrimitive(MeshPrimitive::Points);
+    CORRADE_VERIFY(info->pInputAssemblyState);
+    CORRADE_COMPARE(info->pInputAssemblyState->topology, VK_PRIMITIVE_TOPOLOGY_POINT_LIST);
+    CORRADE_COMPARE(info->pRasterizationState, &rasterization);
+    CORRADE_VERIFY(!info->pViewportState);
+}
+
+void PipelineTest::computeCreateInfoConstruct() {
+    ComputePipelineCreateInfo info{reinterpret_cast<VkPipelineLayout>(0xdead), reinterpret_cast<VkShaderModule>(0xbeef), "main", ComputePipelineCreateInfo::Flag::AllowDerivatives};
+    CORRADE_COMPARE(info->flags, VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT);
+    CORRADE_COMPARE(info->stage.sType, VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO);
+    CORRADE_COMPARE(info->stage.stage, VK_SHADER_STAGE_COMPUTE_BIT);
+    CORRADE_COMPARE(info->stage.module, reinterpret_cast<VkShaderModule>(0xbeef));
+    CORRADE_COMPARE(info->stage.pName, "main"_s);
+    CORRADE_COMPARE(info->layout, reinterpret_cast<VkPipelineLayout>(0xdead));
+    CORRADE_COMPARE(info->basePipelineIndex, -1);
+}
+
+void PipelineTest::computeCreateInfoConstructEntrypointCopy() {
+    Containers::String entrypoint = "computeMain!";
+
+    ComputePipelineCreateInfo info{{}, {}, entrypoint.prefix(entrypoint.size() - 1)};
+    entrypoint[0] = '?';
+    CORRADE_COMPARE(info->stage.pName, "computeMain"_s);
+}
+
+void PipelineTest::computeCreateInfoConstructNoInit() {
+    ComputePipelineCreateInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) ComputePipelineCreateInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<ComputePipelineCreateInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, ComputePipelineCreateInfo>::value));
+}
+
+void PipelineTest::computeCreateInfoConstructFromVk() {
+    VkComputePipelineCreateInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    ComputePipelineCreateInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void PipelineTest::computeCreateInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<ComputePipelineCreateInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<ComputePipelineCreateInfo>{});
+}
+
+void PipelineTest::computeCreateInfoConstructMove() {
+    Containers::String entrypoint = "computeMain";
+
+    ComputePipelineCreateInfo a{{}, {}, entrypoint};
+    const char* name = a->stage.pName;
+
+    ComputePipelineCreateInfo b = std::move(a);
+    CORRADE_VERIFY(!a->stage.pName);
+    CORRADE_COMPARE(b->stage.pName, name);
+
+    ComputePipelineCreateInfo c{VkComputePipelineCreateInfo{}};
+    c = std::move(b);
+    CORRADE_VERIFY(!b->stage.pName);
+    CORRADE_COMPARE(c->stage.pName, name);
+    CORRADE_COMPARE(c->stage.pName, "computeMain"_s);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<ComputePipelineCreateInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<ComputePipelineCreateInfo>::value);
+}
+
+void PipelineTest::constructNoCreate() {
+    {
+        Pipeline pipeline{NoCreate};
+        CORRADE_VERIFY(!pipeline.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, Pipeline>::value));
+}
+
+void PipelineTest::constructCopy() {
+    CORRADE_VERIFY(!(std::is_constructible<Pipeline, const Pipeline&>{}));
+    CORRADE_VERIFY(!(std::is_assignable<Pipeline, const Pipeline&>{}));
+}
+
+void PipelineTest::debugPipelineStage() {
+    std::ostringstream out;
+    Debug{&out} << PipelineStage::ColorAttachmentOutput << PipelineStage(0xdeadcafe);
+    CORRADE_COMPARE(out.str(), "Vk::PipelineStage::ColorAttachmentOutput Vk::PipelineStage(0xdeadcafe)\n");
+}
+
+void PipelineTest::debugPipelineStages() {
+    std::ostringstream out;
+    Debug{&out} << (PipelineStage::VertexInput|PipelineStage::Transfer) << PipelineStages{};
+    CORRADE_COMPARE(out.str(), "Vk::PipelineStage::VertexInput|Vk::PipelineStage::Transfer Vk::PipelineStages{}\n");
+}
+
+void PipelineTest::debugAccess() {
+    std::ostringstream out;
+    Debug{&out} << Access::ShaderWrite << Access(0xdeadcafe);
+    CORRADE_COMPARE(out.str(), "Vk::Access::ShaderWrite Vk::Access(0xdeadcafe)\n");
+}
+
+void PipelineTest::debugAccesses() {
+    std::ostringstream out;
+    Debug{&out} << (Access::ShaderRead|Access::TransferWrite) << Accesses{};
+    CORRADE_COMPARE(out.str(), "Vk::Access::ShaderRead|Vk::Access::TransferWrite Vk::Accesses{}\n");
+}
+
+void PipelineTest::debugBindPoint() {
+    std::ostringstream out;
+    Debug{&out} << PipelineBindPoint::Compute << PipelineBindPoint(-10007655);
+    CORRADE_COMPARE(out.str(), "Vk::PipelineBindPoint::Compute Vk::PipelineBindPoint(-10007655)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineTest)
@@ -0,0 +1,202 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Math/Range.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/PipelineCache.h"
+#include "Magnum/Vk/PipelineCreateInfo.h"
+#include "Magnum/Vk/PipelineLayoutCreateInfo.h"
+#include "Magnum/Vk/RenderPassCreateInfo.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/ShaderCreateInfo.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct PipelineVkTest: VulkanTester {
+    explicit PipelineVkTest();
+
+    void constructGraphics();
+    void constructGraphicsCache();
+    void constructCompute();
+    void constructMove();
+
+    void wrap();
+
+    void bind();
+};
+
+PipelineVkTest::PipelineVkTest() {
+    addTests({&PipelineVkTest::constructGraphics,
+              &PipelineVkTest::constructGraphicsCache,
+              &PipelineVkTest::constructCompute,
+              &PipelineVkTest::constructMove,
+
+              &PipelineVkTest::wrap,
+
+              &PipelineVkTest::bind});
+}
+
+void PipelineVkTest::constructGraphics() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "triangle-shaders.spv"))}};
+    RenderPass renderPass{device(), RenderPassCreateInfo{}
+        .setAttachments({VK_FORMAT_R8G8B8A8_UNORM})
+        .addSubpass(SubpassDescription{}.setColorAttachments({0}))
+    };
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+
+    {
+        Pipeline pipeline{device(), GraphicsPipelineCreateInfo{layout, renderPass, 0, 1}
+            .addShader(ShaderStage::Vertex, shader, "ver")
+            .addShader(ShaderStage::Fragment, shader, "fra")
+            .addVertexBinding(0, 2*4*4)
+            .addVertexAttribute(0, 0, VertexFormat::Vector4, 0)
+            .addVertexAttribute(1, 0, VertexFormat::Vector4, 4*4)
+            .setPrimitive(MeshPrimitive::Triangles)
+            .setViewport(Range2D{{}, {256.0f, 256.0f}})};
+        CORRADE_VERIFY(pipeline.handle());
+        CORRADE_COMPARE(pipeline.handleFlags(), HandleFlag::DestroyOnDestruction);
+        CORRADE_COMPARE(pipeline.bindPoint(), PipelineBindPoint::Graphics);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineVkTest::constructGraphicsCache() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "triangle-shaders.spv"))}};
+    RenderPass renderPass{device(), RenderPassCreateInfo{}
+        .setAttachments({VK_FORMAT_R8G8B8A8_UNORM})
+        .addSubpass(SubpassDescription{}.setColorAttachments({0}))
+    };
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+    PipelineCache cache{device()};
+
+    {
+        Pipeline pipeline{device(), GraphicsPipelineCreateInfo{layout, renderPass, 0, 1}
+            .addShader(ShaderStage::Vertex, shader, "ver")
+            .addShader(ShaderStage::Fragment, shader, "fra"), cache};
+        CORRADE_VERIFY(pipeline.handle());
+        CORRADE_COMPARE(pipeline.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* The cache should have something in it now, at least the header */
+    CORRADE_VERIFY(!cache.data().empty());
+}
+
+void PipelineVkTest::constructCompute() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "compute-noop.spv"))}};
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+
+    {
+        Pipeline pipeline{device(), ComputePipelineCreateInfo{layout, shader}};
+        CORRADE_VERIFY(pipeline.handle());
+        CORRADE_COMPARE(pipeline.handleFlags(), HandleFlag::DestroyOnDestruction);
+        CORRADE_COMPARE(pipeline.bindPoint(), PipelineBindPoint::Compute);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void PipelineVkTest::constructMove() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "compute-noop.spv"))}};
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+
+    Pipeline a{device(), ComputePipelineCreateInfo{layout, shader}};
+    VkPipeline handle = a.handle();
+
+    Pipeline b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(b.bindPoint(), PipelineBindPoint::Compute);
+
+    Pipeline c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(c.bindPoint(), PipelineBindPoint::Compute);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Pipeline>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Pipeline>::value);
+}
+
+void PipelineVkTest::wrap() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "compute-noop.spv"))}};
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+
+    VkPipeline pipeline{};
+    CORRADE_COMPARE(Result(device()->CreateComputePipelines(device(), {}, 1,
+        ComputePipelineCreateInfo{layout, shader},
+        nullptr, &pipeline)), Result::Success);
+
+    auto wrapped = Pipeline::wrap(device(), PipelineBindPoint::Compute, pipeline, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), pipeline);
+    CORRADE_COMPARE(wrapped.bindPoint(), PipelineBindPoint::Compute);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), pipeline);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyPipeline(device(), pipeline, nullptr);
+}
+
+void PipelineVkTest::bind() {
+    Shader shader{device(), ShaderCreateInfo{
+        Utility::Directory::read(Utility::Directory::join(VK_TEST_DIR, "compute-noop.spv"))}};
+    PipelineLayout layout{device(), PipelineLayoutCreateInfo{}};
+    Pipeline pipeline{device(), ComputePipelineCreateInfo{layout, shader}};
+
+    CommandPool pool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Compute)}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin()
+        .bindPipeline(pipeline)
+        .end();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::PipelineVkTest)
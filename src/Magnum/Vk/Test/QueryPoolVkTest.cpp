@@ -0,0 +1,158 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/ArrayView.h>
+
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Pipeline.h"
+#include "Magnum/Vk/QueryPoolCreateInfo.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct QueryPoolVkTest: VulkanTester {
+    explicit QueryPoolVkTest();
+
+    void construct();
+    void constructMove();
+    void wrap();
+
+    void timestamps();
+    void resultsNotReady();
+};
+
+QueryPoolVkTest::QueryPoolVkTest() {
+    addTests({&QueryPoolVkTest::construct,
+              &QueryPoolVkTest::constructMove,
+              &QueryPoolVkTest::wrap,
+
+              &QueryPoolVkTest::timestamps,
+              &QueryPoolVkTest::resultsNotReady});
+}
+
+void QueryPoolVkTest::construct() {
+    {
+        QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 4}};
+        CORRADE_VERIFY(pool.handle());
+        CORRADE_COMPARE(pool.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void QueryPoolVkTest::constructMove() {
+    QueryPool a{device(), QueryPoolCreateInfo{QueryType::Timestamp, 4}};
+    VkQueryPool handle = a.handle();
+
+    QueryPool b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    QueryPool c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<QueryPool>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<QueryPool>::value);
+}
+
+void QueryPoolVkTest::wrap() {
+    VkQueryPool pool{};
+    CORRADE_COMPARE(Result(device()->CreateQueryPool(device(),
+        QueryPoolCreateInfo{QueryType::Timestamp, 4},
+        nullptr, &pool)), Result::Success);
+    CORRADE_VERIFY(pool);
+
+    auto wrapped = QueryPool::wrap(device(), pool, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), pool);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), pool);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroyQueryPool(device(), pool, nullptr);
+}
+
+void QueryPoolVkTest::timestamps() {
+    QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 2}};
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    cmd.begin()
+        .resetQueryPool(pool, 0, 2)
+        .writeTimestamp(PipelineStage::TopOfPipe, pool, 0)
+        .writeTimestamp(PipelineStage::BottomOfPipe, pool, 1)
+        .end();
+
+    Fence fence{device(), FenceCreateInfo{}};
+    SubmitInfo info;
+    info.setCommandBuffers({cmd});
+    queue().submit({info}, fence);
+    fence.wait();
+
+    /* Each query followed by its availability */
+    UnsignedLong data[4]{};
+    CORRADE_VERIFY(pool.results(0, 2, data, QueryResultFlag::WithAvailability));
+    CORRADE_VERIFY(data[1]);
+    CORRADE_VERIFY(data[3]);
+    CORRADE_VERIFY(data[2] >= data[0]);
+}
+
+void QueryPoolVkTest::resultsNotReady() {
+    QueryPool pool{device(), QueryPoolCreateInfo{QueryType::Timestamp, 1}};
+    CommandPool commandPool{device(), CommandPoolCreateInfo{
+        device().properties().pickQueueFamily(QueueFlag::Graphics)}};
+    CommandBuffer cmd = commandPool.allocate();
+
+    /* Reset but never written */
+    cmd.begin()
+        .resetQueryPool(pool, 0, 1)
+        .end();
+
+    Fence fence{device(), FenceCreateInfo{}};
+    SubmitInfo info;
+    info.setCommandBuffers({cmd});
+    queue().submit({info}, fence);
+    fence.wait();
+
+    UnsignedLong data[2]{0xdeadbeef, 0xdeadbeef};
+    CORRADE_VERIFY(!pool.results(0, 1, data, QueryResultFlag::WithAvailability));
+    CORRADE_COMPARE(data[1], 0);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::QueryPoolVkTest)
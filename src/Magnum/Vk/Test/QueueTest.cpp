@@ -0,0 +1,287 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Queue.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct QueueTest: TestSuite::Tester {
+    explicit QueueTest();
+
+    void submitInfoConstruct();
+    void submitInfoConstructNoInit();
+    void submitInfoConstructFromVk();
+    void submitInfoConstructCopy();
+    void submitInfoConstructMove();
+
+    void submitInfoWaitSemaphores();
+    void submitInfoWaitSemaphoresTimeline();
+    void submitInfoWaitSemaphoresWrongStageCount();
+    void submitInfoWaitSemaphoresWrongValueCount();
+    void submitInfoCommandBuffers();
+    void submitInfoSignalSemaphores();
+    void submitInfoSignalSemaphoresTimeline();
+    void submitInfoSignalSemaphoresWrongValueCount();
+    void submitInfoTimelineReset();
+
+    void constructNoCreate();
+};
+
+QueueTest::QueueTest() {
+    addTests({&QueueTest::submitInfoConstruct,
+              &QueueTest::submitInfoConstructNoInit,
+              &QueueTest::submitInfoConstructFromVk,
+              &QueueTest::submitInfoConstructCopy,
+              &QueueTest::submitInfoConstructMove,
+
+              &QueueTest::submitInfoWaitSemaphores,
+              &QueueTest::submitInfoWaitSemaphoresTimeline,
+              &QueueTest::submitInfoWaitSemaphoresWrongStageCount,
+              &QueueTest::submitInfoWaitSemaphoresWrongValueCount,
+              &QueueTest::submitInfoCommandBuffers,
+              &QueueTest::submitInfoSignalSemaphores,
+              &QueueTest::submitInfoSignalSemaphoresTimeline,
+              &QueueTest::submitInfoSignalSemaphoresWrongValueCount,
+              &QueueTest::submitInfoTimelineReset,
+
+              &QueueTest::constructNoCreate});
+}
+
+const VkSemaphore SemaphoreA = reinterpret_cast<VkSemaphore>(0xdead);
+const VkSemaphore SemaphoreB = reinterpret_cast<VkSemaphore>(0xbeef);
+const VkCommandBuffer CommandBufferA = reinterpret_cast<VkCommandBuffer>(0xcafe);
+
+void QueueTest::submitInfoConstruct() {
+    SubmitInfo info;
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_SUBMIT_INFO);
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->waitSemaphoreCount, 0);
+    CORRADE_COMPARE(info->commandBufferCount, 0);
+    CORRADE_COMPARE(info->signalSemaphoreCount, 0);
+}
+
+void QueueTest::submitInfoConstructNoInit() {
+    SubmitInfo info{NoInit};
+    info->sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+    new(&info) SubmitInfo{NoInit};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+
+    CORRADE_VERIFY((std::is_nothrow_constructible<SubmitInfo, NoInitT>::value));
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoInitT, SubmitInfo>::value));
+}
+
+void QueueTest::submitInfoConstructFromVk() {
+    VkSubmitInfo vkInfo;
+    vkInfo.sType = VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2;
+
+    SubmitInfo info{vkInfo};
+    CORRADE_COMPARE(info->sType, VK_STRUCTURE_TYPE_FORMAT_PROPERTIES_2);
+}
+
+void QueueTest::submitInfoConstructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<SubmitInfo>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<SubmitInfo>{});
+}
+
+void QueueTest::submitInfoConstructMove() {
+    SubmitInfo a;
+    a.setWaitSemaphores({SemaphoreA}, {PipelineStage::Transfer}, {5})
+     .setCommandBuffers({CommandBufferA})
+     .setSignalSemaphores({SemaphoreB});
+    const void* timelineInfo = a->pNext;
+    CORRADE_VERIFY(timelineInfo);
+
+    /* The state is heap-allocated, so all pointers including the pNext chain
+       stay valid */
+    SubmitInfo b = std::move(a);
+    CORRADE_VERIFY(!a->pNext);
+    CORRADE_COMPARE(a->waitSemaphoreCount, 0);
+    CORRADE_VERIFY(!a->pWaitSemaphores);
+    CORRADE_COMPARE(a->commandBufferCount, 0);
+    CORRADE_VERIFY(!a->pCommandBuffers);
+    CORRADE_COMPARE(a->signalSemaphoreCount, 0);
+    CORRADE_VERIFY(!a->pSignalSemaphores);
+    CORRADE_COMPARE(b->pNext, timelineInfo);
+    CORRADE_COMPARE(b->waitSemaphoreCount, 1);
+    CORRADE_COMPARE(b->pWaitSemaphores[0], SemaphoreA);
+    CORRADE_COMPARE(b->commandBufferCount, 1);
+    CORRADE_COMPARE(b->pCommandBuffers[0], CommandBufferA);
+    CORRADE_COMPARE(b->signalSemaphoreCount, 1);
+    CORRADE_COMPARE(b->pSignalSemaphores[0], SemaphoreB);
+
+    SubmitInfo c{VkSubmitInfo{}};
+    c = std::move(b);
+    CORRADE_VERIFY(!b->pNext);
+    CORRADE_COMPARE(b->waitSemaphoreCount, 0);
+    CORRADE_COMPARE(c->pNext, timelineInfo);
+    CORRADE_COMPARE(c->waitSemaphoreCount, 1);
+    CORRADE_COMPARE(c->pWaitSemaphores[0], SemaphoreA);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<SubmitInfo>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<SubmitInfo>::value);
+}
+
+void QueueTest::submitInfoWaitSemaphores() {
+    SubmitInfo info;
+    info.setWaitSemaphores({SemaphoreA, SemaphoreB}, {
+        PipelineStage::ColorAttachmentOutput,
+        PipelineStage::VertexInput|PipelineStage::Transfer});
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pWaitSemaphores);
+    CORRADE_COMPARE(info->pWaitSemaphores[0], SemaphoreA);
+    CORRADE_COMPARE(info->pWaitSemaphores[1], SemaphoreB);
+    CORRADE_VERIFY(info->pWaitDstStageMask);
+    CORRADE_COMPARE(info->pWaitDstStageMask[0], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    CORRADE_COMPARE(info->pWaitDstStageMask[1], VK_PIPELINE_STAGE_VERTEX_INPUT_BIT|VK_PIPELINE_STAGE_TRANSFER_BIT);
+}
+
+void QueueTest::submitInfoWaitSemaphoresTimeline() {
+    SubmitInfo info;
+    info.setWaitSemaphores({SemaphoreA, SemaphoreB}, {
+        PipelineStage::Transfer,
+        PipelineStage::ComputeShader}, {0, 37});
+    CORRADE_COMPARE(info->waitSemaphoreCount, 2);
+    CORRADE_COMPARE(info->pWaitSemaphores[1], SemaphoreB);
+    CORRADE_COMPARE(info->pWaitDstStageMask[1], VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    CORRADE_VERIFY(info->pNext);
+
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 2);
+    CORRADE_VERIFY(timelineInfo.pWaitSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pWaitSemaphoreValues[0], 0);
+    CORRADE_COMPARE(timelineInfo.pWaitSemaphoreValues[1], 37);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 0);
+}
+
+void QueueTest::submitInfoWaitSemaphoresWrongStageCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SubmitInfo info;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setWaitSemaphores({SemaphoreA, SemaphoreB}, {PipelineStage::Transfer});
+    CORRADE_COMPARE(out.str(), "Vk::SubmitInfo::setWaitSemaphores(): expected 2 stage masks but got 1\n");
+}
+
+void QueueTest::submitInfoWaitSemaphoresWrongValueCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SubmitInfo info;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setWaitSemaphores({SemaphoreA}, {PipelineStage::Transfer}, {1, 2});
+    CORRADE_COMPARE(out.str(), "Vk::SubmitInfo::setWaitSemaphores(): expected 1 values but got 2\n");
+}
+
+void QueueTest::submitInfoCommandBuffers() {
+    SubmitInfo info;
+    info.setCommandBuffers({CommandBufferA, {}});
+    CORRADE_COMPARE(info->commandBufferCount, 2);
+    CORRADE_VERIFY(info->pCommandBuffers);
+    CORRADE_COMPARE(info->pCommandBuffers[0], CommandBufferA);
+    CORRADE_COMPARE(info->pCommandBuffers[1], VkCommandBuffer{});
+}
+
+void QueueTest::submitInfoSignalSemaphores() {
+    SubmitInfo info;
+    info.setSignalSemaphores({SemaphoreB, SemaphoreA});
+    CORRADE_VERIFY(!info->pNext);
+    CORRADE_COMPARE(info->signalSemaphoreCount, 2);
+    CORRADE_VERIFY(info->pSignalSemaphores);
+    CORRADE_COMPARE(info->pSignalSemaphores[0], SemaphoreB);
+    CORRADE_COMPARE(info->pSignalSemaphores[1], SemaphoreA);
+}
+
+void QueueTest::submitInfoSignalSemaphoresTimeline() {
+    SubmitInfo info;
+    info.setSignalSemaphores({SemaphoreB}, {15});
+    CORRADE_COMPARE(info->signalSemaphoreCount, 1);
+    CORRADE_COMPARE(info->pSignalSemaphores[0], SemaphoreB);
+    CORRADE_VERIFY(info->pNext);
+
+    const auto& timelineInfo = *static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext);
+    CORRADE_COMPARE(timelineInfo.sType, VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO);
+    CORRADE_COMPARE(timelineInfo.waitSemaphoreValueCount, 0);
+    CORRADE_COMPARE(timelineInfo.signalSemaphoreValueCount, 1);
+    CORRADE_VERIFY(timelineInfo.pSignalSemaphoreValues);
+    CORRADE_COMPARE(timelineInfo.pSignalSemaphoreValues[0], 15);
+}
+
+void QueueTest::submitInfoSignalSemaphoresWrongValueCount() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    SubmitInfo info;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    info.setSignalSemaphores({SemaphoreA, SemaphoreB}, {1});
+    CORRADE_COMPARE(out.str(), "Vk::SubmitInfo::setSignalSemaphores(): expected 2 values but got 1\n");
+}
+
+void QueueTest::submitInfoTimelineReset() {
+    SubmitInfo info;
+    info.setWaitSemaphores({SemaphoreA}, {PipelineStage::Transfer}, {3})
+        .setSignalSemaphores({SemaphoreB}, {4});
+    CORRADE_VERIFY(info->pNext);
+
+    /* Setting binary semaphores again keeps the timeline info connected as
+       long as there are any values left */
+    info.setWaitSemaphores({SemaphoreA}, {PipelineStage::Transfer});
+    CORRADE_VERIFY(info->pNext);
+    CORRADE_COMPARE(static_cast<const VkTimelineSemaphoreSubmitInfo*>(info->pNext)->waitSemaphoreValueCount, 0);
+
+    info.setSignalSemaphores({SemaphoreB});
+    CORRADE_VERIFY(!info->pNext);
+}
+
+void QueueTest::constructNoCreate() {
+    {
+        Queue queue{NoCreate};
+        CORRADE_VERIFY(!queue.handle());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, Queue>::value));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::QueueTest)
@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+#include "Magnum/Vk/Version.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct QueueVkTest: VulkanTester {
+    explicit QueueVkTest();
+
+    void submit();
+    void submitSemaphores();
+    void submitTimeline();
+    void waitIdle();
+};
+
+QueueVkTest::QueueVkTest() {
+    addTests({&QueueVkTest::submit,
+              &QueueVkTest::submitSemaphores,
+              &QueueVkTest::submitTimeline,
+              &QueueVkTest::waitIdle});
+}
+
+void QueueVkTest::submit() {
+    Fence fence{device(), FenceCreateInfo{}};
+
+    SubmitInfo a, b;
+    queue().submit({a, b}, fence);
+    CORRADE_VERIFY(fence.wait(~UnsignedLong{}));
+}
+
+void QueueVkTest::submitSemaphores() {
+    Semaphore semaphore{device(), SemaphoreCreateInfo{}};
+    Fence fence{device(), FenceCreateInfo{}};
+
+    /* The second batch waits on the semaphore signaled by the first */
+    SubmitInfo a, b;
+    a.setSignalSemaphores({semaphore});
+    b.setWaitSemaphores({semaphore}, {PipelineStage::AllCommands});
+    queue().submit({a, b}, fence);
+    CORRADE_VERIFY(fence.wait(~UnsignedLong{}));
+}
+
+void QueueVkTest::submitTimeline() {
+    DeviceProperties properties = pickDevice(instance());
+    if(!(properties.features() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Queue queue{NoCreate};
+    DeviceCreateInfo info{properties};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(!properties.isVersionSupported(Version::Vk12))
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    Device device{instance(), info};
+
+    Semaphore semaphore{device, SemaphoreCreateInfo{SemaphoreType::Timeline}};
+
+    /* The batch waits for a value signaled from the host and then signals a
+       larger one */
+    SubmitInfo submitInfo;
+    submitInfo
+        .setWaitSemaphores({semaphore}, {PipelineStage::AllCommands}, {1})
+        .setSignalSemaphores({semaphore}, {2});
+    queue.submit({submitInfo});
+    CORRADE_VERIFY(!semaphore.wait(2, 0));
+
+    semaphore.signal(1);
+    semaphore.wait(2);
+    CORRADE_COMPARE(semaphore.value(), 2);
+}
+
+void QueueVkTest::waitIdle() {
+    SubmitInfo info;
+    queue().submit({info});
+    queue().waitIdle();
+
+    /* Does not do anything visible, so just test that it didn't blow up */
+    CORRADE_VERIFY(true);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::QueueVkTest)
@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/Handle.h"
+#include "Magnum/Vk/Result.h"
+#include "Magnum/Vk/SemaphoreCreateInfo.h"
+#include "Magnum/Vk/Version.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SemaphoreVkTest: VulkanTester {
+    explicit SemaphoreVkTest();
+
+    void construct();
+    void constructTimeline();
+    void constructMove();
+    void wrap();
+
+    void timelineSignalWait();
+};
+
+SemaphoreVkTest::SemaphoreVkTest() {
+    addTests({&SemaphoreVkTest::construct,
+              &SemaphoreVkTest::constructTimeline,
+              &SemaphoreVkTest::constructMove,
+              &SemaphoreVkTest::wrap,
+
+              &SemaphoreVkTest::timelineSignalWait});
+}
+
+void SemaphoreVkTest::construct() {
+    {
+        Semaphore semaphore{device(), SemaphoreCreateInfo{}};
+        CORRADE_VERIFY(semaphore.handle());
+        CORRADE_COMPARE(semaphore.handleFlags(), HandleFlag::DestroyOnDestruction);
+    }
+
+    /* Shouldn't crash or anything */
+    CORRADE_VERIFY(true);
+}
+
+void SemaphoreVkTest::constructTimeline() {
+    DeviceProperties properties = pickDevice(instance());
+    if(!(properties.features() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Queue queue{NoCreate};
+    DeviceCreateInfo info{properties};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(!properties.isVersionSupported(Version::Vk12))
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    Device device{instance(), info};
+
+    Semaphore semaphore{device, SemaphoreCreateInfo{SemaphoreType::Timeline, 37}};
+    CORRADE_VERIFY(semaphore.handle());
+    CORRADE_COMPARE(semaphore.value(), 37);
+}
+
+void SemaphoreVkTest::constructMove() {
+    Semaphore a{device(), SemaphoreCreateInfo{}};
+    VkSemaphore handle = a.handle();
+
+    Semaphore b = std::move(a);
+    CORRADE_VERIFY(!a.handle());
+    CORRADE_COMPARE(b.handle(), handle);
+    CORRADE_COMPARE(b.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    Semaphore c{NoCreate};
+    c = std::move(b);
+    CORRADE_VERIFY(!b.handle());
+    CORRADE_COMPARE(b.handleFlags(), HandleFlags{});
+    CORRADE_COMPARE(c.handle(), handle);
+    CORRADE_COMPARE(c.handleFlags(), HandleFlag::DestroyOnDestruction);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<Semaphore>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<Semaphore>::value);
+}
+
+void SemaphoreVkTest::wrap() {
+    VkSemaphore semaphore{};
+    CORRADE_COMPARE(Result(device()->CreateSemaphore(device(),
+        SemaphoreCreateInfo{},
+        nullptr, &semaphore)), Result::Success);
+    CORRADE_VERIFY(semaphore);
+
+    auto wrapped = Semaphore::wrap(device(), semaphore, HandleFlag::DestroyOnDestruction);
+    CORRADE_COMPARE(wrapped.handle(), semaphore);
+
+    /* Release the handle again, destroy by hand */
+    CORRADE_COMPARE(wrapped.release(), semaphore);
+    CORRADE_VERIFY(!wrapped.handle());
+    device()->DestroySemaphore(device(), semaphore, nullptr);
+}
+
+void SemaphoreVkTest::timelineSignalWait() {
+    DeviceProperties properties = pickDevice(instance());
+    if(!(properties.features() & DeviceFeature::TimelineSemaphore))
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Queue queue{NoCreate};
+    DeviceCreateInfo info{properties};
+    info.addQueues(QueueFlag::Graphics, {0.0f}, {queue})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(!properties.isVersionSupported(Version::Vk12))
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    Device device{instance(), info};
+
+    Semaphore semaphore{device, SemaphoreCreateInfo{SemaphoreType::Timeline}};
+    CORRADE_COMPARE(semaphore.value(), 0);
+
+    /* Waiting for a value that wasn't reached yet times out */
+    CORRADE_VERIFY(!semaphore.wait(3, 0));
+
+    semaphore.signal(3);
+    CORRADE_COMPARE(semaphore.value(), 3);
+
+    /* Waiting for a value that was already reached returns immediately */
+    CORRADE_VERIFY(semaphore.wait(2, 0));
+    semaphore.wait(3);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SemaphoreVkTest)
@@ -23,8 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
 
 #include "Magnum/Vk/ShaderCreateInfo.h"
 
@@ -42,6 +44,9 @@ struct ShaderTest: TestSuite::Tester {
 
     void constructNoCreate();
     void constructCopy();
+
+    void debugStage();
+    void debugStages();
 };
 
 ShaderTest::ShaderTest() {
@@ -53,7 +58,10 @@ ShaderTest::ShaderTest() {
               &ShaderTest::createInfoConstructMove,
 
               &ShaderTest::constructNoCreate,
-              &ShaderTest::constructCopy});
+              &ShaderTest::constructCopy,
+
+              &ShaderTest::debugStage,
+              &ShaderTest::debugStages});
 }
 
 void ShaderTest::createInfoConstruct() {
@@ -182,6 +190,18 @@ void ShaderTest::constructCopy() {
     CORRADE_VERIFY(!(std::is_assignable<Shader, const Shader&>{}));
 }
 
+void ShaderTest::debugStage() {
+    std::ostringstream out;
+    Debug{&out} << ShaderStage::Fragment << ShaderStage(0xdeadcafe);
+    CORRADE_COMPARE(out.str(), "Vk::ShaderStage::Fragment Vk::ShaderStage(0xdeadcafe)\n");
+}
+
+void ShaderTest::debugStages() {
+    std::ostringstream out;
+    Debug{&out} << (ShaderStage::Vertex|ShaderStage::Compute) << ShaderStages{};
+    CORRADE_COMPARE(out.str(), "Vk::ShaderStage::Vertex|Vk::ShaderStage::Compute Vk::ShaderStages{}\n");
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Vk::Test::ShaderTest)
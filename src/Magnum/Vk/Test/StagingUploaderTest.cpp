@@ -0,0 +1,88 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Device.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/StagingUploader.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct StagingUploaderTest: TestSuite::Tester {
+    explicit StagingUploaderTest();
+
+    void constructNoCreate();
+    void constructZeroSize();
+    void constructCopy();
+};
+
+StagingUploaderTest::StagingUploaderTest() {
+    addTests({&StagingUploaderTest::constructNoCreate,
+              &StagingUploaderTest::constructZeroSize,
+              &StagingUploaderTest::constructCopy});
+}
+
+void StagingUploaderTest::constructNoCreate() {
+    {
+        StagingUploader uploader{NoCreate};
+        CORRADE_COMPARE(uploader.bufferSize(), 0);
+        CORRADE_COMPARE(uploader.bufferCount(), 0);
+        CORRADE_COMPARE(uploader.submittedValue(), 0);
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, StagingUploader>::value));
+}
+
+void StagingUploaderTest::constructZeroSize() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    /* The assertion fires before any Vulkan call, so a device without any
+       function pointers is enough */
+    Device device{NoCreate};
+    Queue queue{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    StagingUploader{device, queue, 0, 0, 0, 3};
+    StagingUploader{device, queue, 0, 0, 1024, 0};
+    CORRADE_COMPARE(out.str(),
+        "Vk::StagingUploader: expected non-zero buffer size and count, got 0 and 3\n"
+        "Vk::StagingUploader: expected non-zero buffer size and count, got 1024 and 0\n");
+}
+
+void StagingUploaderTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<StagingUploader>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<StagingUploader>{});
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::StagingUploaderTest)
@@ -0,0 +1,245 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Vk/BufferCreateInfo.h"
+#include "Magnum/Vk/CommandBuffer.h"
+#include "Magnum/Vk/CommandPoolCreateInfo.h"
+#include "Magnum/Vk/DeviceCreateInfo.h"
+#include "Magnum/Vk/DeviceFeatures.h"
+#include "Magnum/Vk/DeviceProperties.h"
+#include "Magnum/Vk/Enums.h"
+#include "Magnum/Vk/Extensions.h"
+#include "Magnum/Vk/FenceCreateInfo.h"
+#include "Magnum/Vk/ImageCreateInfo.h"
+#include "Magnum/Vk/Memory.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Semaphore.h"
+#include "Magnum/Vk/StagingUploader.h"
+#include "Magnum/Vk/VulkanTester.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct StagingUploaderVkTest: VulkanTester {
+    explicit StagingUploaderVkTest();
+
+    void construct();
+    void constructMove();
+
+    void uploadBuffer();
+    void uploadBufferSplit();
+    void uploadImage();
+    void flushEmpty();
+
+    private:
+        /* Timeline semaphores need a dedicated device */
+        bool createTimelineDevice();
+
+        DeviceProperties _properties{NoCreate};
+        Containers::Pointer<Device> _device;
+        Queue _queue{NoCreate};
+        UnsignedInt _queueFamily{};
+};
+
+StagingUploaderVkTest::StagingUploaderVkTest() {
+    addTests({&StagingUploaderVkTest::construct,
+              &StagingUploaderVkTest::constructMove,
+
+              &StagingUploaderVkTest::uploadBuffer,
+              &StagingUploaderVkTest::uploadBufferSplit,
+              &StagingUploaderVkTest::uploadImage,
+              &StagingUploaderVkTest::flushEmpty});
+}
+
+bool StagingUploaderVkTest::createTimelineDevice() {
+    if(_device) return true;
+
+    _properties = pickDevice(instance());
+    if(!(_properties.features() & DeviceFeature::TimelineSemaphore))
+        return false;
+
+    _queueFamily = _properties.pickQueueFamily(QueueFlag::Graphics);
+    DeviceCreateInfo info{_properties};
+    info.addQueues(_queueFamily, {0.0f}, {_queue})
+        .setEnabledFeatures(DeviceFeature::TimelineSemaphore);
+    if(!_properties.isVersionSupported(Version::Vk12))
+        info.addEnabledExtensions<Extensions::KHR::timeline_semaphore>();
+    _device.emplace(instance(), info);
+    return true;
+}
+
+void StagingUploaderVkTest::construct() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    CORRADE_COMPARE(uploader.bufferSize(), 4096);
+    CORRADE_COMPARE(uploader.bufferCount(), 2);
+    CORRADE_COMPARE(uploader.submittedValue(), 0);
+    CORRADE_VERIFY(uploader.semaphore().handle());
+    CORRADE_COMPARE(uploader.semaphore().value(), 0);
+}
+
+void StagingUploaderVkTest::constructMove() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    StagingUploader a{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+    VkSemaphore handle = a.semaphore().handle();
+
+    StagingUploader b = std::move(a);
+    CORRADE_COMPARE(a.bufferCount(), 0);
+    CORRADE_COMPARE(b.bufferCount(), 2);
+    CORRADE_COMPARE(b.semaphore().handle(), handle);
+
+    StagingUploader c{NoCreate};
+    c = std::move(b);
+    CORRADE_COMPARE(b.bufferCount(), 0);
+    CORRADE_COMPARE(c.bufferCount(), 2);
+    CORRADE_COMPARE(c.semaphore().handle(), handle);
+
+    CORRADE_VERIFY(std::is_nothrow_move_constructible<StagingUploader>::value);
+    CORRADE_VERIFY(std::is_nothrow_move_assignable<StagingUploader>::value);
+}
+
+void StagingUploaderVkTest::uploadBuffer() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    /* Host-visible so the result can be verified directly */
+    Buffer buffer{*_device, BufferCreateInfo{BufferUsage::TransferDestination, 16}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+    StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+
+    const char a[]{'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+    const char b[]{'0', '1', '2', '3'};
+    uploader.upload(buffer, 0, a);
+    uploader.upload(buffer, 12, b);
+
+    /* Both uploads go into a single batch */
+    UnsignedLong value = uploader.flush();
+    CORRADE_COMPARE(value, 1);
+    CORRADE_COMPARE(uploader.submittedValue(), 1);
+
+    uploader.semaphore().wait(value);
+    Containers::Array<const char, MemoryMapDeleter> mapped = buffer.dedicatedMemory().mapRead();
+    CORRADE_COMPARE_AS(Containers::arrayView(mapped).prefix(8),
+        Containers::arrayView(a),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(Containers::arrayView(mapped).suffix(12),
+        Containers::arrayView(b),
+        TestSuite::Compare::Container);
+}
+
+void StagingUploaderVkTest::uploadBufferSplit() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Buffer buffer{*_device, BufferCreateInfo{BufferUsage::TransferDestination, 40}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+    /* Tiny staging buffers, so the data has to be split across batches and
+       the ring wraps around */
+    StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 16, 2};
+
+    char data[40];
+    for(std::size_t i = 0; i != 40; ++i) data[i] = 'A' + i;
+    uploader.upload(buffer, 0, data);
+
+    /* Two full batches got submitted implicitly, the last one explicitly */
+    CORRADE_COMPARE(uploader.submittedValue(), 2);
+    UnsignedLong value = uploader.flush();
+    CORRADE_COMPARE(value, 3);
+
+    uploader.semaphore().wait(value);
+    Containers::Array<const char, MemoryMapDeleter> mapped = buffer.dedicatedMemory().mapRead();
+    CORRADE_COMPARE_AS(Containers::arrayView(mapped),
+        Containers::arrayView(data),
+        TestSuite::Compare::Container);
+}
+
+void StagingUploaderVkTest::uploadImage() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    Image image{*_device, ImageCreateInfo2D{ImageUsage::TransferDestination|ImageUsage::TransferSource, vkFormat(PixelFormat::RGBA8Unorm), {3, 2}, 1}, MemoryFlag::DeviceLocal};
+    Buffer readback{*_device, BufferCreateInfo{BufferUsage::TransferDestination, 3*2*4}, MemoryFlag::HostVisible|MemoryFlag::HostCoherent};
+    StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+
+    const UnsignedInt pixels[]{
+        0x11223344, 0x55667788, 0x99aabbcc,
+        0xddeeff00, 0x01234567, 0x89abcdef
+    };
+    uploader.upload(image, ImageView2D{PixelFormat::RGBA8Unorm, {3, 2}, pixels}, ImageLayout::TransferSource);
+    UnsignedLong value = uploader.flush();
+
+    /* Copy the image back to a host-visible buffer, waiting on the upload
+       on the GPU side */
+    CommandPool pool{*_device, CommandPoolCreateInfo{_queueFamily}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = {3, 2, 1};
+    (**_device)->CmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback, 1, &region);
+    cmd.end();
+
+    Fence fence{*_device, FenceCreateInfo{}};
+    SubmitInfo info;
+    info.setWaitSemaphores({uploader.semaphore()}, {PipelineStage::Transfer}, {value})
+        .setCommandBuffers({cmd});
+    _queue.submit({info}, fence);
+    CORRADE_VERIFY(fence.wait(~UnsignedLong{}));
+
+    Containers::Array<const char, MemoryMapDeleter> mapped = readback.dedicatedMemory().mapRead();
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(mapped),
+        Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
+void StagingUploaderVkTest::flushEmpty() {
+    if(!createTimelineDevice())
+        CORRADE_SKIP("Timeline semaphores not supported, can't test.");
+
+    StagingUploader uploader{*_device, _queue, _queueFamily, _queueFamily, 4096, 2};
+
+    /* Nothing recorded, nothing submitted */
+    CORRADE_COMPARE(uploader.flush(), 0);
+    CORRADE_COMPARE(uploader.submittedValue(), 0);
+
+    /* Acquiring with the same queue family is a no-op */
+    CommandPool pool{*_device, CommandPoolCreateInfo{_queueFamily}};
+    CommandBuffer cmd = pool.allocate();
+    cmd.begin();
+    uploader.acquire(cmd);
+    cmd.end();
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::StagingUploaderVkTest)
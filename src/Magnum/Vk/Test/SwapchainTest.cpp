@@ -0,0 +1,114 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <sstream>
+#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Vk/Image.h"
+#include "Magnum/Vk/Queue.h"
+#include "Magnum/Vk/Swapchain.h"
+
+namespace Magnum { namespace Vk { namespace Test { namespace {
+
+struct SwapchainTest: TestSuite::Tester {
+    explicit SwapchainTest();
+
+    void constructNoCreate();
+    void constructCopy();
+
+    void acquireNoSwapchain();
+    void presentNoSwapchain();
+
+    void debugPresentMode();
+};
+
+SwapchainTest::SwapchainTest() {
+    addTests({&SwapchainTest::constructNoCreate,
+              &SwapchainTest::constructCopy,
+
+              &SwapchainTest::acquireNoSwapchain,
+              &SwapchainTest::presentNoSwapchain,
+
+              &SwapchainTest::debugPresentMode});
+}
+
+void SwapchainTest::constructNoCreate() {
+    {
+        Swapchain swapchain{NoCreate};
+        CORRADE_VERIFY(!swapchain.handle());
+        CORRADE_COMPARE(swapchain.format(), VkFormat{});
+        CORRADE_COMPARE(swapchain.size(), Vector2i{});
+        CORRADE_COMPARE(swapchain.presentMode(), PresentMode::Fifo);
+        CORRADE_VERIFY(swapchain.images().empty());
+    }
+
+    /* Implicit construction is not allowed */
+    CORRADE_VERIFY(!(std::is_convertible<NoCreateT, Swapchain>::value));
+}
+
+void SwapchainTest::constructCopy() {
+    CORRADE_VERIFY(!std::is_copy_constructible<Swapchain>{});
+    CORRADE_VERIFY(!std::is_copy_assignable<Swapchain>{});
+}
+
+void SwapchainTest::acquireNoSwapchain() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Swapchain swapchain{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_COMPARE(swapchain.acquire({}), -1);
+    CORRADE_COMPARE(out.str(), "Vk::Swapchain::acquire(): the swapchain has zero size, call recreate() first\n");
+}
+
+void SwapchainTest::presentNoSwapchain() {
+    #ifdef CORRADE_NO_ASSERT
+    CORRADE_SKIP("CORRADE_NO_ASSERT defined, can't test assertions");
+    #endif
+
+    Swapchain swapchain{NoCreate};
+    Queue queue{NoCreate};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!swapchain.present(queue, 0));
+    CORRADE_COMPARE(out.str(), "Vk::Swapchain::present(): index 0 out of range for 0 images\n");
+}
+
+void SwapchainTest::debugPresentMode() {
+    std::ostringstream out;
+    Debug{&out} << PresentMode::Mailbox << PresentMode(-10007655);
+    CORRADE_COMPARE(out.str(), "Vk::PresentMode::Mailbox Vk::PresentMode(-10007655)\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Vk::Test::SwapchainTest)
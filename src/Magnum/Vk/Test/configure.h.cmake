@@ -24,3 +24,4 @@
 */
 
 #define VK_TEST_DIR "${VK_TEST_DIR}"
+#define PIPELINECACHEVKTEST_SAVE_DIR "${PIPELINECACHEVKTEST_SAVE_DIR}"
@@ -36,11 +36,23 @@
 namespace Magnum { namespace Vk {
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
+enum class Access: UnsignedInt;
+typedef Containers::EnumSet<Access> Accesses;
+class BindlessTable;
 class Buffer;
 class BufferCreateInfo;
 class CommandBuffer;
+class CommandBufferBeginInfo;
 class CommandPool;
 class CommandPoolCreateInfo;
+class ComputePipelineCreateInfo;
+class DescriptorPool;
+class DescriptorPoolCreateInfo;
+class DescriptorSet;
+class DescriptorSetLayout;
+class DescriptorSetLayoutBinding;
+class DescriptorSetLayoutCreateInfo;
+enum class DescriptorType: Int;
 class Device;
 class DeviceCreateInfo;
 enum class DeviceFeature: UnsignedShort;
@@ -49,13 +61,20 @@ class DeviceProperties;
 enum class DeviceType: Int;
 class Extension;
 class ExtensionProperties;
+class Fence;
+class FenceCreateInfo;
 class Framebuffer;
 class FramebufferCreateInfo;
+class FrameCommandPools;
+class FrameLoop;
+class FrameDescriptorPools;
+class GraphicsPipelineCreateInfo;
 enum class HandleFlag: UnsignedByte;
 typedef Containers::EnumSet<HandleFlag> HandleFlags;
 class Image;
 enum class ImageLayout: Int;
 class ImageCreateInfo;
+class ImageStateTracker;
 /* Not forward-declaring ImageCreateInfo1D etc right now, I see no need */
 class ImageView;
 class ImageViewCreateInfo;
@@ -67,20 +86,46 @@ class InstanceExtensionProperties;
 class LayerProperties;
 class Memory;
 class MemoryAllocateInfo;
+class MemoryAllocation;
+enum class MemoryAllocationStrategy: UnsignedByte;
+class MemoryAllocator;
 class MemoryMapDeleter;
 class MemoryRequirements;
 enum class MemoryFlag: UnsignedInt;
 typedef Containers::EnumSet<MemoryFlag> MemoryFlags;
 enum class MemoryHeapFlag: UnsignedInt;
 typedef Containers::EnumSet<MemoryHeapFlag> MemoryHeapFlags;
+class Pipeline;
+enum class PipelineBindPoint: Int;
+class PipelineCache;
+class PipelineLayout;
+class PipelineLayoutCreateInfo;
+enum class PipelineStage: UnsignedInt;
+typedef Containers::EnumSet<PipelineStage> PipelineStages;
+enum class PresentMode: Int;
+enum class QueryPipelineStatistic: UnsignedInt;
+typedef Containers::EnumSet<QueryPipelineStatistic> QueryPipelineStatistics;
+class QueryPool;
+class QueryPoolCreateInfo;
+enum class QueryResultFlag: UnsignedInt;
+typedef Containers::EnumSet<QueryResultFlag> QueryResultFlags;
+enum class QueryType: Int;
 class Queue;
 enum class QueueFlag: UnsignedInt;
 typedef Containers::EnumSet<QueueFlag> QueueFlags;
 class RenderPass;
 class RenderPassCreateInfo;
 enum class Result: Int;
+class Semaphore;
+class SemaphoreCreateInfo;
+enum class SemaphoreType: Int;
 class Shader;
 class ShaderCreateInfo;
+enum class ShaderStage: UnsignedInt;
+typedef Containers::EnumSet<ShaderStage> ShaderStages;
+class StagingUploader;
+class SubmitInfo;
+class Swapchain;
 enum class Version: UnsignedInt;
 #endif
 
@@ -1770,6 +1770,11 @@ typedef void (APIENTRY *GLDEBUGPROC)(GLenum source,GLenum type,GLuint id,GLenum
 
 #define GL_BLEND_ADVANCED_COHERENT_KHR 0x9285
 
+/* GL_KHR_parallel_shader_compile */
+
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+
 /* GL_NV_sample_locations */
 
 #define GL_SAMPLE_LOCATION_SUBPIXEL_BITS_NV 0x933D
@@ -1873,6 +1878,10 @@ struct FlextGL {
 
     void(APIENTRY *BlendBarrierKHR)(void);
 
+    /* GL_KHR_parallel_shader_compile */
+
+    void(APIENTRY *MaxShaderCompilerThreadsKHR)(GLuint);
+
     /* GL_NV_sample_locations */
 
     void(APIENTRY *FramebufferSampleLocationsfvNV)(GLenum, GLuint, GLsizei, const GLfloat *);
@@ -2677,6 +2686,10 @@ extern FLEXTGL_EXPORT FlextGL flextGL;
 
 #define glBlendBarrierKHR flextGL.BlendBarrierKHR
 
+/* GL_KHR_parallel_shader_compile */
+
+#define glMaxShaderCompilerThreadsKHR flextGL.MaxShaderCompilerThreadsKHR
+
 /* GL_NV_sample_locations */
 
 #define glFramebufferSampleLocationsfvNV flextGL.FramebufferSampleLocationsfvNV
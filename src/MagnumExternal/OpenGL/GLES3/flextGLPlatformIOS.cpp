@@ -129,6 +129,7 @@
 #undef glObjectPtrLabelKHR
 #undef glPopDebugGroupKHR
 #undef glPushDebugGroupKHR
+#undef glMaxShaderCompilerThreadsKHR
 #undef glGetGraphicsResetStatusKHR
 #undef glGetnUniformfvKHR
 #undef glGetnUniformivKHR
@@ -321,6 +322,11 @@ void flextGLInit(Magnum::GL::Context&) {
     flextGL.PushDebugGroupKHR = reinterpret_cast<void(APIENTRY*)(GLenum, GLuint, GLsizei, const GLchar *)>(glPushDebugGroupKHR);
     #endif
 
+    /* GL_KHR_parallel_shader_compile */
+    #if GL_KHR_parallel_shader_compile
+    flextGL.MaxShaderCompilerThreadsKHR = reinterpret_cast<void(APIENTRY*)(GLuint)>(glMaxShaderCompilerThreadsKHR);
+    #endif
+
     /* GL_KHR_robustness */
     #if GL_KHR_robustness
     flextGL.GetGraphicsResetStatusKHR = reinterpret_cast<GLenum(APIENTRY*)(void)>(glGetGraphicsResetStatusKHR);
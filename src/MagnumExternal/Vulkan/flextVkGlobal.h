@@ -119,6 +119,17 @@ extern FLEXTVK_EXPORT FlextVkInstance flextVkInstance;
 /* VK_KHR_sampler_ycbcr_conversion */
 
 
+/* VK_KHR_surface */
+
+#define vkDestroySurfaceKHR flextVkInstance.DestroySurfaceKHR
+#define vkGetPhysicalDeviceSurfaceCapabilitiesKHR flextVkInstance.GetPhysicalDeviceSurfaceCapabilitiesKHR
+#define vkGetPhysicalDeviceSurfaceFormatsKHR flextVkInstance.GetPhysicalDeviceSurfaceFormatsKHR
+#define vkGetPhysicalDeviceSurfacePresentModesKHR flextVkInstance.GetPhysicalDeviceSurfacePresentModesKHR
+#define vkGetPhysicalDeviceSurfaceSupportKHR flextVkInstance.GetPhysicalDeviceSurfaceSupportKHR
+
+/* VK_KHR_swapchain */
+
+
 /* VK_KHR_timeline_semaphore */
 
 
@@ -289,6 +300,17 @@ extern FLEXTVK_EXPORT FlextVkDevice flextVkDevice;
 #define vkCreateSamplerYcbcrConversionKHR flextVkDevice.CreateSamplerYcbcrConversionKHR
 #define vkDestroySamplerYcbcrConversionKHR flextVkDevice.DestroySamplerYcbcrConversionKHR
 
+/* VK_KHR_surface */
+
+
+/* VK_KHR_swapchain */
+
+#define vkAcquireNextImageKHR flextVkDevice.AcquireNextImageKHR
+#define vkCreateSwapchainKHR flextVkDevice.CreateSwapchainKHR
+#define vkDestroySwapchainKHR flextVkDevice.DestroySwapchainKHR
+#define vkGetSwapchainImagesKHR flextVkDevice.GetSwapchainImagesKHR
+#define vkQueuePresentKHR flextVkDevice.QueuePresentKHR
+
 /* VK_KHR_timeline_semaphore */
 
 #define vkGetSemaphoreCounterValueKHR flextVkDevice.GetSemaphoreCounterValueKHR
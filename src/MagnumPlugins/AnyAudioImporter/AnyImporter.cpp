@@ -39,7 +39,9 @@ AnyImporter::AnyImporter(PluginManager::AbstractManager& manager, const std::str
 
 AnyImporter::~AnyImporter() = default;
 
-ImporterFeatures AnyImporter::doFeatures() const { return {}; }
+/* Streaming is delegated to the concrete importer, which falls back to
+   decoding everything if it doesn't support it */
+ImporterFeatures AnyImporter::doFeatures() const { return ImporterFeature::Streaming; }
 
 bool AnyImporter::doIsOpened() const { return !!_in; }
 
@@ -77,6 +79,7 @@ void AnyImporter::doOpenFile(const std::string& filename) {
     /* Try to open the file (error output should be printed by the plugin
        itself) */
     Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
+    importer->setFlags(flags());
     if(!importer->openFile(filename)) return;
 
     /* Success, save the instance */
@@ -89,6 +92,10 @@ UnsignedInt AnyImporter::doFrequency() const { return _in->frequency(); }
 
 Containers::Array<char> AnyImporter::doData() { return _in->data(); }
 
+std::size_t AnyImporter::doFrameCount() { return _in->frameCount(); }
+
+std::size_t AnyImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> data) { return _in->readFrames(offset, data); }
+
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyAudioImporter, Magnum::Audio::AnyImporter,
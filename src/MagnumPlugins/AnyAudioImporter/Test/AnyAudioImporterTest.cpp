@@ -100,6 +100,11 @@ void AnyImporterTest::load() {
     CORRADE_COMPARE(importer->frequency(), 96000);
     CORRADE_COMPARE(importer->data().size(), 4);
 
+    /* Streaming is delegated as well */
+    CORRADE_COMPARE(importer->frameCount(), 2);
+    char frame[2];
+    CORRADE_COMPARE(importer->readFrames(1, frame), 1);
+
     importer->close();
     CORRADE_VERIFY(!importer->isOpened());
 }
@@ -25,6 +25,7 @@
 
 #include "AnyImageImporter.h"
 
+#include <unordered_map>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
@@ -38,22 +39,63 @@
 
 namespace Magnum { namespace Trade {
 
-AnyImageImporter::AnyImageImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
+struct AnyImageImporter::Cache {
+    /* Concrete importer instances, keyed by the plugin name they were
+       instantiated with, kept across close() so they don't need to be
+       instantiated again for each opened file */
+    std::unordered_map<std::string, Containers::Pointer<AbstractImporter>> importers;
+};
 
-AnyImageImporter::AnyImageImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+AnyImageImporter::AnyImageImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager}, _cache{Containers::InPlaceInit} {}
+
+AnyImageImporter::AnyImageImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin}, _cache{Containers::InPlaceInit} {}
 
 AnyImageImporter::AnyImageImporter(AnyImageImporter&&) noexcept = default;
 
 AnyImageImporter::~AnyImageImporter() = default;
 
-ImporterFeatures AnyImageImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures AnyImageImporter::doFeatures() const {
+    /* Concurrent import is possible if the concrete importer supports it, as
+       all data access functions just delegate to it */
+    return ImporterFeature::OpenData|(_in ? _in->features() & ImporterFeature::ConcurrentImport : ImporterFeatures{});
+}
 
-bool AnyImageImporter::doIsOpened() const { return !!_in; }
+bool AnyImageImporter::doIsOpened() const { return _in && _in->isOpened(); }
 
 void AnyImageImporter::doClose() {
+    /* The instance stays in the cache for reuse */
+    _in->close();
     _in = nullptr;
 }
 
+AbstractImporter* AnyImageImporter::instance(const std::string& plugin, const char* const messagePrefix) {
+    /* If we have an instance already, the plugin is loaded */
+    auto found = _cache->importers.find(plugin);
+    if(found == _cache->importers.end()) {
+        if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+            Error{} << messagePrefix << "cannot load the" << plugin << "plugin";
+            return nullptr;
+        }
+
+        found = _cache->importers.emplace(plugin, static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin)).first;
+    }
+
+    if(flags() & ImporterFlag::Verbose) {
+        Debug d;
+        d << messagePrefix << "using" << plugin;
+        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
+        CORRADE_INTERNAL_ASSERT(metadata);
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Propagate flags. The instance is not opened at this point, so this is
+       allowed even if it's reused from a previous file. */
+    AbstractImporter* const importer = found->second.get();
+    importer->setFlags(flags());
+    return importer;
+}
+
 void AnyImageImporter::doOpenFile(const std::string& filename) {
     CORRADE_INTERNAL_ASSERT(manager());
 
@@ -118,31 +160,16 @@ void AnyImageImporter::doOpenFile(const std::string& filename) {
         Error{} << "Trade::AnyImageImporter::openFile(): cannot determine the format of" << filename;
         return;
     }
-    if(flags() & ImporterFlag::Verbose) {
-        Debug d;
-        d << "Trade::AnyImageImporter::openFile(): using" << plugin;
-        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
-        CORRADE_INTERNAL_ASSERT(metadata);
-        if(plugin != metadata->name())
-            d << "(provided by" << metadata->name() << Debug::nospace << ")";
-    }
-
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error{} << "Trade::AnyImageImporter::openFile(): cannot load the" << plugin << "plugin";
-        return;
-    }
-
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+    /* Load and instantiate the plugin or reuse an existing instance */
+    AbstractImporter* const importer = instance(plugin, "Trade::AnyImageImporter::openFile():");
+    if(!importer) return;
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
     if(!importer->openFile(filename)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = importer;
 }
 
 void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
@@ -157,6 +184,10 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* https://github.com/BinomialLLC/basis_universal/blob/7d784c728844c007d8c95d63231f7adcc0f65364/transcoder/basisu_file_headers.h#L78 */
     if(dataString.hasPrefix("sB"_s))
         plugin = "BasisImporter";
+    /* https://en.wikipedia.org/wiki/GIF#File_format */
+    else if(dataString.hasPrefix("GIF87a"_s) ||
+            dataString.hasPrefix("GIF89a"_s))
+        plugin = "GifImporter";
     /* https://docs.microsoft.com/cs-cz/windows/desktop/direct3ddds/dx-graphics-dds-pguide */
     else if(dataString.hasPrefix("DDS "_s))
         plugin = "DdsImporter";
@@ -172,6 +203,53 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* https://en.wikipedia.org/wiki/Portable_Network_Graphics#File_header */
     else if(dataString.hasPrefix("\x89PNG\x0d\x0a\x1a\x0a"_s))
         plugin = "PngImporter";
+    /* http://www.libpng.org/pub/mng/spec/mng-1.0-20010209-pdg.html#mng-sig */
+    else if(dataString.hasPrefix("\x8aMNG\x0d\x0a\x1a\x0a"_s))
+        plugin = "MngImporter";
+    /* https://www.iana.org/assignments/media-types/image/jp2, the first is a
+       JP2 signature box, the second a raw J2K codestream */
+    else if(dataString.hasPrefix("\x00\x00\x00\x0cjP  \x0d\x0a\x87\x0a"_s) ||
+            dataString.hasPrefix("\xff\x4f\xff\x51"_s))
+        plugin = "Jpeg2000Importer";
+    /* https://www.adobe.com/devnet-apps/photoshop/fileformatashtml/#50577409_19840 */
+    else if(dataString.hasPrefix("8BPS"_s))
+        plugin = "PsdImporter";
+    /* https://paulbourke.net/dataformats/sgirgb/sgiversion.html */
+    else if(dataString.hasPrefix("\x01\xda"_s))
+        plugin = "SgiImporter";
+    /* https://paulbourke.net/dataformats/softimagepic/ */
+    else if(dataString.hasPrefix("\x53\x80\xf6\x34"_s))
+        plugin = "PicImporter";
+    /* https://docs.microsoft.com/en-us/previous-versions/ms997538(v=msdn.10),
+       reserved zero followed by type 1 for icons and 2 for cursors. An
+       uncompressed TGA without an ID and colormap starts with the same four
+       bytes as a cursor, so check also that the image count is non-zero and
+       the reserved byte of the first directory entry is zero. */
+    else if(data.size() >= 22 &&
+            (dataString.hasPrefix("\x00\x00\x01\x00"_s) ||
+             dataString.hasPrefix("\x00\x00\x02\x00"_s)) &&
+            (data[4] || data[5]) && data[9] == 0)
+        plugin = "IcoImporter";
+    /* https://en.wikipedia.org/wiki/Netpbm#File_formats, P1 and P4 is a
+       bitmap, P2 and P5 a graymap, P3 and P6 a pixmap. Has to be followed by
+       a whitespace. */
+    else if(data.size() >= 3 && data[0] == 'P' && data[1] >= '1' && data[1] <= '6' && (data[2] == ' ' || data[2] == '\t' || data[2] == '\n' || data[2] == '\r')) {
+        if(data[1] == '1' || data[1] == '4') plugin = "PbmImporter";
+        else if(data[1] == '2' || data[1] == '5') plugin = "PgmImporter";
+        else plugin = "PpmImporter";
+    }
+    /* https://en.wikipedia.org/wiki/BMP_file_format#Bitmap_file_header. Just
+       two bytes, so check also that the header is large enough and the
+       reserved fields are zero. */
+    else if(data.size() >= 26 && dataString.hasPrefix("BM"_s) &&
+            data[6] == 0 && data[7] == 0 && data[8] == 0 && data[9] == 0)
+        plugin = "BmpImporter";
+    /* https://en.wikipedia.org/wiki/PCX#PCX_file_format, a 128-byte header
+       with a manufacturer byte, version 0 to 5 and RLE encoding */
+    else if(data.size() >= 128 && data[0] == 0x0a &&
+            (data[1] == 0 || data[1] == 2 || data[1] == 3 || data[1] == 4 || data[1] == 5) &&
+            data[2] == 1)
+        plugin = "PcxImporter";
     /* http://paulbourke.net/dataformats/tiff/,
        http://paulbourke.net/dataformats/tiff/tiff_summary.pdf */
     else if(dataString.hasPrefix("II\x2a\x00"_s) ||
@@ -214,30 +292,16 @@ void AnyImageImporter::doOpenData(Containers::ArrayView<const char> data) {
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error{} << "Trade::AnyImageImporter::openData(): cannot load the" << plugin << "plugin";
-        return;
-    }
-    if(flags() & ImporterFlag::Verbose) {
-        Debug d;
-        d << "Trade::AnyImageImporter::openData(): using" << plugin;
-        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
-        CORRADE_INTERNAL_ASSERT(metadata);
-        if(plugin != metadata->name())
-            d << "(provided by" << metadata->name() << Debug::nospace << ")";
-    }
-
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+    /* Load and instantiate the plugin or reuse an existing instance */
+    AbstractImporter* const importer = instance(plugin, "Trade::AnyImageImporter::openData():");
+    if(!importer) return;
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
     if(!importer->openData(data)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = importer;
 }
 
 UnsignedInt AnyImageImporter::doImage2DCount() const { return _in->image2DCount(); }
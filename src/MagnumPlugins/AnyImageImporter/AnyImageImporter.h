@@ -56,46 +56,65 @@ namespace Magnum { namespace Trade {
 Detects file type based on file extension, loads corresponding plugin and then
 tries to open the file with it. Supported formats:
 
--   Basis Universal (`*.basis`), loaded @ref BasisImporter or any other plugin
-    that provides it
--   Windows Bitmap (`*.bmp`), loaded with any plugin that provides `BmpImporter`
+-   Basis Universal (`*.basis` or data with corresponding signature), loaded
+    @ref BasisImporter or any other plugin that provides it
+-   Windows Bitmap (`*.bmp` or data with corresponding signature), loaded
+    with any plugin that provides `BmpImporter`
 -   DirectDraw Surface (`*.dds` or data with corresponding signature), loaded
     with @ref DdsImporter or any other plugin that provides it
--   Graphics Interchange Format (`*.gif`), loaded with any plugin that provides
-    `GifImporter`
+-   Graphics Interchange Format (`*.gif` or data with corresponding
+    signature), loaded with any plugin that provides `GifImporter`
 -   OpenEXR (`*.exr` or data with corresponding signature), loaded with any
     plugin that provides `OpenExrImporter`
 -   Radiance HDR (`*.hdr` or data with corresponding signature), loaded with
     any plugin that provides `HdrImporter`
--   Windows icon/cursor (`*.ico`, `*.cur`), loaded with @ref IcoImporter or any
-    other plugin that provides it
+-   Windows icon/cursor (`*.ico`, `*.cur` or data with corresponding
+    signature), loaded with @ref IcoImporter or any other plugin that provides
+    it
 -   JPEG (`*.jpg`, `*.jpe`, `*.jpeg` or data with corresponding signature),
     loaded with @ref JpegImporter or any other plugin that provides it
--   JPEG 2000 (`*.jp2`), loaded with any plugin that provides
-    `Jpeg2000Importer`
--   Multiple-image Network Graphics (`*.mng`), loaded with any plugin that
-    provides `MngImporter`
--   Portable Bitmap (`*.pbm`), loaded with any plugin that provides `PbmImporter`
--   ZSoft PCX (`*.pcx`), loaded with any plugin that provides `PcxImporter`
--   Portable Graymap (`*.pgm`), loaded with any plugin that provides
-    `PgmImporter`
--   Softimage PIC (`*.pic`), loaded with any plugin that provides `PicImporter`
+-   JPEG 2000 (`*.jp2` or data with corresponding signature), loaded with any
+    plugin that provides `Jpeg2000Importer`
+-   Multiple-image Network Graphics (`*.mng` or data with corresponding
+    signature), loaded with any plugin that provides `MngImporter`
+-   Portable Bitmap (`*.pbm` or data with corresponding signature), loaded
+    with any plugin that provides `PbmImporter`
+-   ZSoft PCX (`*.pcx` or data with corresponding signature), loaded with any
+    plugin that provides `PcxImporter`
+-   Portable Graymap (`*.pgm` or data with corresponding signature), loaded
+    with any plugin that provides `PgmImporter`
+-   Softimage PIC (`*.pic` or data with corresponding signature), loaded with
+    any plugin that provides `PicImporter`
 -   Portable Anymap (`*.pnm`), loaded with any plugin that provides
     `PnmImporter`
 -   Portable Network Graphics (`*.png` or data with corresponding signature),
     loaded with @ref PngImporter or any other plugin that provides it
--   Portable Pixmap (`*.ppm`), loaded with any plugin that provides `PpmImporter`
--   Adobe Photoshop (`*.psd`), loaded with any plugin that provides `PsdImporter`
--   Silicon Graphics (`*.sgi`, `*.bw`, `*.rgb`, `*.rgba`), loaded with any
-    plugin that provides `SgiImporter`
+-   Portable Pixmap (`*.ppm` or data with corresponding signature), loaded
+    with any plugin that provides `PpmImporter`
+-   Adobe Photoshop (`*.psd` or data with corresponding signature), loaded
+    with any plugin that provides `PsdImporter`
+-   Silicon Graphics (`*.sgi`, `*.bw`, `*.rgb`, `*.rgba` or data with
+    corresponding signature), loaded with any plugin that provides
+    `SgiImporter`
 -   Tagged Image File Format (`*.tif`, `*.tiff` or data with corresponding
     signature), loaded with any plugin that provides `TiffImporter`
 -   Truevision TGA (`*.tga`, `*.vda`, `*.icb`, `*.vst` or data with
     corresponding signature), loaded with @ref TgaImporter or any other plugin
     that provides it
 
-Detecting file type through @ref openData() is supported only for a subset of
-formats that are marked as such in the list above.
+Detecting file type through @ref openData() is supported for formats that are
+marked as such in the list above. Portable Anymap data are detected as one of
+Portable Bitmap, Graymap or Pixmap based on the signature.
+
+Instances of the concrete importer plugins are not destroyed on
+@ref close() but kept around and reused when a file of the same format is
+opened next time, which avoids repeated plugin instantiation and
+configuration parsing when importing many small files. The instances are
+destroyed together with the @ref AnyImageImporter instance.
+
+Once a file is opened, @ref ImporterFeature::ConcurrentImport is advertised if
+the concrete importer supports it, allowing the plugin to be used with
+@ref AsyncImporter the same way as the concrete importer.
 
 @section Trade-AnyImageImporter-usage Usage
 
@@ -166,7 +185,12 @@ class MAGNUM_ANYIMAGEIMPORTER_EXPORT AnyImageImporter: public AbstractImporter {
         MAGNUM_ANYIMAGEIMPORTER_LOCAL UnsignedInt doImage2DLevelCount(UnsignedInt id) override;
         MAGNUM_ANYIMAGEIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id, UnsignedInt level) override;
 
-        Containers::Pointer<AbstractImporter> _in;
+        MAGNUM_ANYIMAGEIMPORTER_LOCAL AbstractImporter* instance(const std::string& plugin, const char* messagePrefix);
+
+        struct Cache;
+
+        Containers::Pointer<Cache> _cache;
+        AbstractImporter* _in{};
 };
 
 }}
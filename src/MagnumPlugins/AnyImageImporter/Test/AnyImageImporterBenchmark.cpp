@@ -0,0 +1,101 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Measures the dispatch overhead of AnyImageImporter compared to using the
+   concrete plugin directly. The file is tiny so the overhead dominates. */
+
+struct AnyImageImporterBenchmark: TestSuite::Tester {
+    explicit AnyImageImporterBenchmark();
+
+    void direct();
+    void any();
+
+    private:
+        void benchmark(const char* plugin);
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+AnyImageImporterBenchmark::AnyImageImporterBenchmark() {
+    addBenchmarks({&AnyImageImporterBenchmark::direct,
+                   &AnyImageImporterBenchmark::any}, 100);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef ANYIMAGEIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(ANYIMAGEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void AnyImageImporterBenchmark::benchmark(const char* const plugin) {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, cannot test");
+
+    const Containers::Array<char> data = Utility::Directory::read(TGA_FILE);
+    CORRADE_VERIFY(data);
+
+    /* Instantiate outside of the benchmark loop, the AnyImageImporter then
+       instantiates the concrete plugin on every open */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate(plugin);
+
+    Containers::Optional<ImageData2D> image;
+    CORRADE_BENCHMARK(100) {
+        CORRADE_VERIFY(importer->openData(data));
+        image = importer->image2D(0);
+    }
+
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(3, 2));
+}
+
+void AnyImageImporterBenchmark::direct() {
+    benchmark("TgaImporter");
+}
+
+void AnyImageImporterBenchmark::any() {
+    benchmark("AnyImageImporter");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AnyImageImporterBenchmark)
@@ -44,11 +44,14 @@ struct AnyImageImporterTest: TestSuite::Tester {
 
     void load();
     void detect();
+    void detectData();
 
     void unknownExtension();
     void unknownSignature();
     void emptyData();
 
+    void reuse();
+
     void verbose();
 
     /* Explicitly forbid system-wide plugin dependencies */
@@ -116,6 +119,33 @@ const struct {
     {"TIFF, but no zero byte", "MM\xff\x2a"_s, "4d4dff2a"}
 };
 
+/* Manufacturer byte, version 5, RLE encoding and 8 bits per pixel, with the
+   rest of the 128-byte header zero-filled */
+constexpr char PcxData[128]{'\x0a', '\x05', '\x01', '\x08'};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* plugin;
+} DetectDataData[]{
+    {"Basis", "sB\x13\x00"_s, "BasisImporter"},
+    {"BMP", "BM\x46\x00\x00\x00\x00\x00\x00\x00\x36\x00\x00\x00\x28\x00\x00\x00\x02\x00\x00\x00\x02\x00\x00\x00"_s, "BmpImporter"},
+    {"GIF87a", "GIF87a\x01\x00\x01\x00"_s, "GifImporter"},
+    {"GIF89a", "GIF89a\x01\x00\x01\x00"_s, "GifImporter"},
+    {"ICO", "\x00\x00\x01\x00\x01\x00\x10\x10\x00\x00\x01\x00\x20\x00\x68\x04\x00\x00\x16\x00\x00\x00"_s, "IcoImporter"},
+    {"CUR", "\x00\x00\x02\x00\x01\x00\x20\x20\x00\x00\x04\x00\x04\x00\x30\x01\x00\x00\x16\x00\x00\x00"_s, "IcoImporter"},
+    {"JPEG 2000", "\x00\x00\x00\x0cjP  \x0d\x0a\x87\x0a"_s, "Jpeg2000Importer"},
+    {"JPEG 2000 codestream", "\xff\x4f\xff\x51\x00\x2f"_s, "Jpeg2000Importer"},
+    {"MNG", "\x8aMNG\x0d\x0a\x1a\x0a"_s, "MngImporter"},
+    {"PBM", "P4\n3 2\n"_s, "PbmImporter"},
+    {"PGM", "P2 3 2 255\n"_s, "PgmImporter"},
+    {"PPM", "P6\r\n3 2\r\n255\r\n"_s, "PpmImporter"},
+    {"PCX", {PcxData, sizeof(PcxData)}, "PcxImporter"},
+    {"PIC", "\x53\x80\xf6\x34"_s, "PicImporter"},
+    {"PSD", "8BPS\x00\x01"_s, "PsdImporter"},
+    {"SGI", "\x01\xda\x00\x01"_s, "SgiImporter"}
+};
+
 AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::load},
         Containers::arraySize(LoadData));
@@ -123,12 +153,17 @@ AnyImageImporterTest::AnyImageImporterTest() {
     addInstancedTests({&AnyImageImporterTest::detect},
         Containers::arraySize(DetectData));
 
+    addInstancedTests({&AnyImageImporterTest::detectData},
+        Containers::arraySize(DetectDataData));
+
     addTests({&AnyImageImporterTest::unknownExtension});
 
     addInstancedTests({&AnyImageImporterTest::unknownSignature},
         Containers::arraySize(DetectUnknownData));
 
-    addTests({&AnyImageImporterTest::emptyData});
+    addTests({&AnyImageImporterTest::emptyData,
+
+              &AnyImageImporterTest::reuse});
 
     addInstancedTests({&AnyImageImporterTest::verbose},
         Containers::arraySize(LoadData));
@@ -156,8 +191,12 @@ void AnyImageImporterTest::load() {
     Containers::Array<char> storage;
     importer->setFileCallback(data.callback, storage);
 
+    CORRADE_COMPARE(importer->features(), ImporterFeature::OpenData);
     CORRADE_VERIFY(importer->openFile(data.filename));
 
+    /* TgaImporter supports concurrent import, which should get propagated */
+    CORRADE_COMPARE(importer->features(), ImporterFeature::OpenData|ImporterFeature::ConcurrentImport);
+
     /* Check only size, as it is good enough proof that it is working */
     Containers::Optional<ImageData2D> image = importer->image2D(0);
     CORRADE_VERIFY(image);
@@ -189,6 +228,25 @@ void AnyImageImporterTest::detect() {
     #endif
 }
 
+void AnyImageImporterTest::detectData() {
+    auto&& data = DetectDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.data));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} is not static and was not found in nonexistent\nTrade::AnyImageImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #else
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} was not found\nTrade::AnyImageImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #endif
+}
+
 void AnyImageImporterTest::unknownExtension() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -222,6 +280,32 @@ void AnyImageImporterTest::emptyData() {
     CORRADE_COMPARE(output.str(), "Trade::AnyImageImporter::openData(): file is empty\n");
 }
 
+void AnyImageImporterTest::reuse() {
+    if(!(_manager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnyImageImporter");
+    CORRADE_VERIFY(importer->openFile(TGA_FILE));
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+
+    /* Opening the same format again, this time from data, reuses the cached
+       instance, which should behave the same as a fresh one */
+    Containers::Array<char> data = Utility::Directory::read(TGA_FILE);
+    CORRADE_VERIFY(importer->openData(data));
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(3, 2));
+
+    /* Opening a file that fails leaves the importer in a closed state */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->openFile("image.xcf"));
+    }
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
 void AnyImageImporterTest::verbose() {
     auto&& data = LoadData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
@@ -25,13 +25,19 @@
 
 #include "AnySceneImporter.h"
 
+#include <cstring>
+#include <unordered_map>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/PluginManager/PluginMetadata.h>
 #include <Corrade/Utility/Assert.h>
 #include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Corrade/Utility/FormatStl.h>
 #include <Corrade/Utility/String.h>
 
+#include "Magnum/Math/Functions.h"
 #include "Magnum/Trade/AnimationData.h"
 #include "Magnum/Trade/CameraData.h"
 #include "Magnum/Trade/ImageData.h"
@@ -53,20 +59,65 @@
 
 namespace Magnum { namespace Trade {
 
-AnySceneImporter::AnySceneImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager} {}
+struct AnySceneImporter::Cache {
+    /* Concrete importer instances, keyed by the plugin name they were
+       instantiated with, kept across close() so they don't need to be
+       instantiated again for each opened file */
+    std::unordered_map<std::string, Containers::Pointer<AbstractImporter>> importers;
+};
 
-AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+AnySceneImporter::AnySceneImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager}, _cache{Containers::InPlaceInit} {}
+
+AnySceneImporter::AnySceneImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin}, _cache{Containers::InPlaceInit} {}
 
 AnySceneImporter::~AnySceneImporter() = default;
 
-ImporterFeatures AnySceneImporter::doFeatures() const { return {}; }
+ImporterFeatures AnySceneImporter::doFeatures() const {
+    /* Concurrent import is possible if the concrete importer supports it, as
+       all data access functions just delegate to it */
+    return ImporterFeature::OpenData|(_in ? _in->features() & ImporterFeature::ConcurrentImport : ImporterFeatures{});
+}
 
-bool AnySceneImporter::doIsOpened() const { return !!_in; }
+bool AnySceneImporter::doIsOpened() const { return _in && _in->isOpened(); }
 
 void AnySceneImporter::doClose() {
+    /* The instance stays in the cache for reuse */
+    _in->close();
     _in = nullptr;
 }
 
+AbstractImporter* AnySceneImporter::instance(const std::string& plugin, const char* const messagePrefix) {
+    /* If we have an instance already, the plugin is loaded */
+    auto found = _cache->importers.find(plugin);
+    if(found == _cache->importers.end()) {
+        if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
+            Error{} << messagePrefix << "cannot load the" << plugin << "plugin";
+            return nullptr;
+        }
+
+        found = _cache->importers.emplace(plugin, static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin)).first;
+    }
+
+    if(flags() & ImporterFlag::Verbose) {
+        Debug d;
+        d << messagePrefix << "using" << plugin;
+        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
+        CORRADE_INTERNAL_ASSERT(metadata);
+        if(plugin != metadata->name())
+            d << "(provided by" << metadata->name() << Debug::nospace << ")";
+    }
+
+    /* Propagate flags and the file callback so external files referenced
+       from the scene go through it as well. The instance is not opened at
+       this point, so this is allowed even if it's reused from a previous
+       file. */
+    AbstractImporter* const importer = found->second.get();
+    importer->setFlags(flags());
+    if(importer->features() & ImporterFeature::FileCallback)
+        importer->setFileCallback(fileCallback(), fileCallbackUserData());
+    return importer;
+}
+
 void AnySceneImporter::doOpenFile(const std::string& filename) {
     CORRADE_INTERNAL_ASSERT(manager());
 
@@ -135,30 +186,116 @@ void AnySceneImporter::doOpenFile(const std::string& filename) {
         return;
     }
 
-    /* Try to load the plugin */
-    if(!(manager()->load(plugin) & PluginManager::LoadState::Loaded)) {
-        Error{} << "Trade::AnySceneImporter::openFile(): cannot load the" << plugin << "plugin";
+    /* Load and instantiate the plugin or reuse an existing instance */
+    AbstractImporter* const importer = instance(plugin, "Trade::AnySceneImporter::openFile():");
+    if(!importer) return;
+
+    /* Try to open the file (error output should be printed by the plugin
+       itself) */
+    if(!importer->openFile(filename)) return;
+
+    /* Success, remember the instance */
+    _in = importer;
+}
+
+void AnySceneImporter::doOpenData(Containers::ArrayView<const char> data) {
+    using namespace Containers::Literals;
+
+    CORRADE_INTERNAL_ASSERT(manager());
+
+    /* So we can use the convenient hasPrefix() API */
+    const Containers::StringView dataString = data;
+
+    /* Skip leading whitespace for text-based formats */
+    std::size_t textBegin = 0;
+    while(textBegin < data.size() && (data[textBegin] == ' ' || data[textBegin] == '\t' || data[textBegin] == '\n' || data[textBegin] == '\r'))
+        ++textBegin;
+    const Containers::StringView text = dataString.slice(textBegin, data.size());
+
+    std::string plugin;
+    /* https://github.com/KhronosGroup/glTF/tree/master/specification/2.0#binary-header */
+    if(dataString.hasPrefix("glTF"_s))
+        plugin = "GltfImporter";
+    /* https://archive.blender.org/wiki/index.php/Dev:Source/Architecture/File_Format/#file-header */
+    else if(dataString.hasPrefix("BLENDER"_s))
+        plugin = "BlenderImporter";
+    /* https://code.blender.org/2013/08/fbx-binary-file-format-specification/,
+       the ASCII variant starts with a comment */
+    else if(dataString.hasPrefix("Kaydara FBX Binary  \x00"_s) ||
+            dataString.hasPrefix("; FBX"_s))
+        plugin = "FbxImporter";
+    /* http://paulbourke.net/dataformats/ply/ */
+    else if(dataString.hasPrefix("ply\n"_s) ||
+            dataString.hasPrefix("ply\r\n"_s))
+        plugin = "StanfordImporter";
+    /* http://paulbourke.net/dataformats/directx/#xfilefrm_Header */
+    else if(dataString.hasPrefix("xof "_s))
+        plugin = "DirectXImporter";
+    /* http://paulbourke.net/dataformats/ms3d/ms3dspec.h */
+    else if(dataString.hasPrefix("MS3D000000"_s))
+        plugin = "MilkshapeImporter";
+    /* http://www.inivis.com/ac3d/man/ac3dfileformat.html */
+    else if(dataString.hasPrefix("AC3D"_s))
+        plugin = "Ac3dImporter";
+    /* http://static.lightwave3d.com/sdk/2015/html/filefmts/lwo2.html, an IFF
+       container with a LightWave object form type */
+    else if(data.size() >= 12 && dataString.hasPrefix("FORM"_s) &&
+            (dataString.slice(8, 12) == "LWO2"_s ||
+             dataString.slice(8, 12) == "LWOB"_s ||
+             dataString.slice(8, 12) == "LWO3"_s))
+        plugin = "LightWaveImporter";
+    /* https://en.wikipedia.org/wiki/.3ds, a main chunk with ID 0x4d4d and
+       size matching the data size. Both little-endian. */
+    else if(data.size() >= 6 && dataString.hasPrefix("\x4d\x4d"_s) && [data]() {
+            UnsignedInt size;
+            std::memcpy(&size, data.data() + 2, 4);
+            Utility::Endianness::littleEndianInPlace(size);
+            return size == data.size();
+        }()) plugin = "3dsImporter";
+    /* A binary STL is a 80-byte header followed by a 32-bit triangle count
+       and 50 bytes for each triangle, so check the size matches. An ASCII STL
+       starts with "solid", which a binary STL header can start with too, so
+       check the binary variant first. */
+    else if(data.size() >= 84 && [data]() {
+            UnsignedInt count;
+            std::memcpy(&count, data.data() + 80, 4);
+            Utility::Endianness::littleEndianInPlace(count);
+            return 84 + std::size_t(count)*50 == data.size();
+        }()) plugin = "StlImporter";
+    else if(text.hasPrefix("solid"_s))
+        plugin = "StlImporter";
+    /* The only JSON-based format */
+    else if(text.hasPrefix("{"_s))
+        plugin = "GltfImporter";
+    /* Looking only for the root element in the first kilobyte, as there can
+       be an arbitrarily long XML declaration and comments before */
+    else if(text.hasPrefix("<"_s) && std::string{text.data(), Math::min(text.size(), std::size_t{1024})}.find("<COLLADA") != std::string::npos)
+        plugin = "ColladaImporter";
+    else if(!data.size()) {
+        Error{} << "Trade::AnySceneImporter::openData(): file is empty";
+        return;
+    } else {
+        /* FFS so much casting to avoid implicit sign extension ruining
+           everything */
+        UnsignedInt signature = UnsignedInt(UnsignedByte(data[0])) << 24;
+        if(data.size() > 1) signature |= UnsignedInt(UnsignedByte(data[1])) << 16;
+        if(data.size() > 2) signature |= UnsignedInt(UnsignedByte(data[2])) << 8;
+        if(data.size() > 3) signature |= UnsignedInt(UnsignedByte(data[3]));
+        /* If there's less than four bytes, cut the rest away */
+        Error{} << "Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x" << Debug::nospace << Utility::formatString("{:.8x}", signature).substr(0, data.size() < 4 ? data.size()*2 : std::string::npos);
         return;
-    }
-    if(flags() & ImporterFlag::Verbose) {
-        Debug d;
-        d << "Trade::AnySceneImporter::openFile(): using" << plugin;
-        PluginManager::PluginMetadata* metadata = manager()->metadata(plugin);
-        CORRADE_INTERNAL_ASSERT(metadata);
-        if(plugin != metadata->name())
-            d << "(provided by" << metadata->name() << Debug::nospace << ")";
     }
 
-    /* Instantiate the plugin, propagate flags */
-    Containers::Pointer<AbstractImporter> importer = static_cast<PluginManager::Manager<AbstractImporter>*>(manager())->instantiate(plugin);
-    importer->setFlags(flags());
+    /* Load and instantiate the plugin or reuse an existing instance */
+    AbstractImporter* const importer = instance(plugin, "Trade::AnySceneImporter::openData():");
+    if(!importer) return;
 
     /* Try to open the file (error output should be printed by the plugin
        itself) */
-    if(!importer->openFile(filename)) return;
+    if(!importer->openData(data)) return;
 
-    /* Success, save the instance */
-    _in = std::move(importer);
+    /* Success, remember the instance */
+    _in = importer;
 }
 
 UnsignedInt AnySceneImporter::doAnimationCount() const { return _in->animationCount(); }
@@ -56,38 +56,43 @@ namespace Magnum { namespace Trade {
 Detects file type based on file extension, loads corresponding plugin and then
 tries to open the file with it. Supported formats:
 
--   3ds Max 3DS and ASE (`*.3ds`, `*.ase`), loaded with any plugin that
-    provides `3dsImporter`
--   AC3D (`*.ac`), loaded with any plugin that provides `Ac3dImporter`
--   Blender 3D (`*.blend`), loaded with any plugin that provides
-    `BlenderImporter`
+-   3ds Max 3DS and ASE (`*.3ds`, `*.ase` or 3DS data with corresponding
+    signature), loaded with any plugin that provides `3dsImporter`
+-   AC3D (`*.ac` or data with corresponding signature), loaded with any
+    plugin that provides `Ac3dImporter`
+-   Blender 3D (`*.blend` or data with corresponding signature), loaded with
+    any plugin that provides `BlenderImporter`
 -   Biovision BVH (`*.bvh`), loaded with any plugin that provides `BvhImporter`
 -   CharacterStudio Motion (`*.csm`), loaded with any plugin that provides
     `CsmImporter`
--   COLLADA (`*.dae`), loaded with any plugin that provides `ColladaImporter`
--   DirectX X (`*.x`), loaded with any plugin that provides `DirectXImporter`
+-   COLLADA (`*.dae` or data with corresponding signature), loaded with any
+    plugin that provides `ColladaImporter`
+-   DirectX X (`*.x` or data with corresponding signature), loaded with any
+    plugin that provides `DirectXImporter`
 -   AutoCAD DXF (`*.dxf`), loaded with any plugin that provides `DxfImporter`
--   Autodesk FBX (`*.fbx`), loaded with any plugin that provides `FbxImporter`
--   glTF (`*.gltf`, `*.glb`), loaded with any plugin that provides
-    `GltfImporter`
+-   Autodesk FBX (`*.fbx` or data with corresponding signature), loaded with
+    any plugin that provides `FbxImporter`
+-   glTF (`*.gltf`, `*.glb` or data with corresponding signature), loaded with
+    any plugin that provides `GltfImporter`
 -   Industry Foundation Classes (IFC/Step) (`*.ifc`), loaded with any plugin
     that provides `IfcImporter`
 -   Irrlicht Mesh and Scene (`*.irrmesh`, `*.irr`), loaded with any plugin that
     provides `IrrlichtImporter`
--   LightWave, LightWave Scene (`*.lwo`, `*.lws`), loaded with any plugin that
-    provides `LightWaveImporter`
+-   LightWave, LightWave Scene (`*.lwo`, `*.lws` or LightWave Object data
+    with corresponding signature), loaded with any plugin that provides
+    `LightWaveImporter`
 -   Modo (`*.lxo`), loaded with any plugin that provides `ModoImporter`
--   Milkshape 3D (`*.ms3d`), loaded with any plugin that provides
-    `MilkshapeImporter`
+-   Milkshape 3D (`*.ms3d` or data with corresponding signature), loaded with
+    any plugin that provides `MilkshapeImporter`
 -   Wavefront OBJ (`*.obj`), loaded with @ref ObjImporter or any other plugin
     that provides it
 -   Ogre XML (`*.xml`), loaded with any plugin that provides `OgreImporter`
 -   OpenGEX (`*.ogex`), loaded with @ref OpenGexImporter or any other plugin
     that provides it
--   Stanford (`*.ply`), loaded with @ref StanfordImporter or any other plugin
-    that provides it
--   Stereolitography (`*.stl`), loaded with any plugin that provides
-    `StlImporter`
+-   Stanford (`*.ply` or data with corresponding signature), loaded with
+    @ref StanfordImporter or any other plugin that provides it
+-   Stereolitography (`*.stl` or data with corresponding signature), loaded
+    with any plugin that provides `StlImporter`
 -   TrueSpace (`*.cob`, `*.scn`), loaded with any plugin that provides
     `TrueSpaceImporter`
 -   Unreal (`*.3d`), loaded with any plugin that provides `UnrealImporter`
@@ -95,7 +100,21 @@ tries to open the file with it. Supported formats:
     `ValveImporter`
 -   XGL (`*.xgl`, `*.zgl`), loaded with any plugin that provides `XglImporter`
 
-Only loading from files is supported.
+Detecting file type through @ref openData() is supported for formats that are
+marked as such in the list above. A JSON object is assumed to be a glTF file.
+If a file callback is set and the concrete importer supports
+@ref ImporterFeature::FileCallback, the callback is propagated to it so
+external files referenced by the scene can be loaded.
+
+Instances of the concrete importer plugins are not destroyed on
+@ref close() but kept around and reused when a file of the same format is
+opened next time, which avoids repeated plugin instantiation and
+configuration parsing when importing many small files. The instances are
+destroyed together with the @ref AnySceneImporter instance.
+
+Once a file is opened, @ref ImporterFeature::ConcurrentImport is advertised if
+the concrete importer supports it, allowing the plugin to be used with
+@ref AsyncImporter the same way as the concrete importer.
 
 @section Trade-AnySceneImporter-usage Usage
 
@@ -143,6 +162,7 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doClose() override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
 
         MAGNUM_ANYSCENEIMPORTER_LOCAL UnsignedInt doAnimationCount() const override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doAnimationName(UnsignedInt id) override;
@@ -238,7 +258,12 @@ class MAGNUM_ANYSCENEIMPORTER_EXPORT AnySceneImporter: public AbstractImporter {
         MAGNUM_ANYSCENEIMPORTER_LOCAL std::string doImage3DName(UnsignedInt id) override;
         MAGNUM_ANYSCENEIMPORTER_LOCAL Containers::Optional<ImageData3D> doImage3D(UnsignedInt id, UnsignedInt level) override;
 
-        Containers::Pointer<AbstractImporter> _in;
+        MAGNUM_ANYSCENEIMPORTER_LOCAL AbstractImporter* instance(const std::string& plugin, const char* messagePrefix);
+
+        struct Cache;
+
+        Containers::Pointer<Cache> _cache;
+        AbstractImporter* _in{};
 };
 
 }}
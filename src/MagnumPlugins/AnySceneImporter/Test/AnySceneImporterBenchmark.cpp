@@ -0,0 +1,98 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Measures the dispatch overhead of AnySceneImporter compared to using the
+   concrete plugin directly. The file is tiny so the overhead dominates. */
+
+struct AnySceneImporterBenchmark: TestSuite::Tester {
+    explicit AnySceneImporterBenchmark();
+
+    void direct();
+    void any();
+
+    private:
+        void benchmark(const char* plugin);
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+AnySceneImporterBenchmark::AnySceneImporterBenchmark() {
+    addBenchmarks({&AnySceneImporterBenchmark::direct,
+                   &AnySceneImporterBenchmark::any}, 100);
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef ANYSCENEIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(ANYSCENEIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void AnySceneImporterBenchmark::benchmark(const char* const plugin) {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    /* Instantiate outside of the benchmark loop, the AnySceneImporter then
+       instantiates the concrete plugin on every open. It supports only
+       openFile(), so the file is read from disk in both cases. */
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate(plugin);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(100) {
+        CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+}
+
+void AnySceneImporterBenchmark::direct() {
+    benchmark("ObjImporter");
+}
+
+void AnySceneImporterBenchmark::any() {
+    benchmark("AnySceneImporter");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::AnySceneImporterBenchmark)
@@ -26,6 +26,7 @@
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
@@ -53,8 +54,13 @@ struct AnySceneImporterTest: TestSuite::Tester {
     void loadDeprecatedMeshData();
     #endif
     void detect();
+    void detectData();
 
     void unknown();
+    void unknownData();
+    void emptyData();
+
+    void reuse();
 
     void verbose();
 
@@ -85,6 +91,47 @@ constexpr struct {
     /* Not testing everything, only the most important ones */
 };
 
+using namespace Containers::Literals;
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* plugin;
+} DetectDataData[]{
+    {"Blender", "BLENDER-v279"_s, "BlenderImporter"},
+    {"COLLADA", "<?xml version=\"1.0\"?>\n<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\">"_s, "ColladaImporter"},
+    {"DirectX X", "xof 0303txt 0032"_s, "DirectXImporter"},
+    {"FBX binary", "Kaydara FBX Binary  \x00\x1a\x00"_s, "FbxImporter"},
+    {"FBX ASCII", "; FBX 7.4.0 project file"_s, "FbxImporter"},
+    {"glTF binary", "glTF\x02\x00\x00\x00"_s, "GltfImporter"},
+    {"glTF", "  \n{\"asset\": {\"version\": \"2.0\"}}"_s, "GltfImporter"},
+    {"LightWave Object", "FORM\x00\x00\x00\x04LWO2"_s, "LightWaveImporter"},
+    {"Milkshape 3D", "MS3D000000\x04\x00\x00\x00"_s, "MilkshapeImporter"},
+    {"AC3D", "AC3Db\nMATERIAL"_s, "Ac3dImporter"},
+    {"3DS", "\x4d\x4d\x0a\x00\x00\x00\x02\x00\x0a\x00"_s, "3dsImporter"},
+    {"Stanford PLY", "ply\nformat ascii 1.0"_s, "StanfordImporter"},
+    {"Stanford PLY CRLF", "ply\r\nformat ascii 1.0"_s, "StanfordImporter"},
+    {"STL ASCII", "solid robot\nfacet normal 0 0 1"_s, "StlImporter"},
+    /* 80-byte header starting with "solid" and zero triangles, should still
+       get detected as binary STL */
+    {"STL binary", "solid binary header which is exactly eighty bytes long..........................\x00\x00\x00\x00"_s, "StlImporter"}
+};
+
+const struct {
+    const char* name;
+    Containers::StringView data;
+    const char* signature;
+} DetectUnknownDataData[]{
+    {"unknown", "\x25\x3a\x00\x56 blablabla"_s, "253a0056"},
+    {"short", "\x33"_s, "33"},
+    /* 3DS main chunk ID but the size doesn't match */
+    {"3DS with wrong size", "\x4d\x4d\xff\x00\x00\x00\x02\x00"_s, "4d4dff00"},
+    /* IFF but not a LightWave object */
+    {"IFF", "FORM\x00\x00\x00\x04AIFF"_s, "464f524d"},
+    /* XML but not COLLADA */
+    {"XML", "<?xml version=\"1.0\"?>\n<svg>"_s, "3c3f786d"}
+};
+
 AnySceneImporterTest::AnySceneImporterTest() {
     addInstancedTests({&AnySceneImporterTest::load},
         Containers::arraySize(LoadData));
@@ -96,7 +143,17 @@ AnySceneImporterTest::AnySceneImporterTest() {
     addInstancedTests({&AnySceneImporterTest::detect},
         Containers::arraySize(DetectData));
 
-    addTests({&AnySceneImporterTest::unknown,
+    addInstancedTests({&AnySceneImporterTest::detectData},
+        Containers::arraySize(DetectDataData));
+
+    addTests({&AnySceneImporterTest::unknown});
+
+    addInstancedTests({&AnySceneImporterTest::unknownData},
+        Containers::arraySize(DetectUnknownDataData));
+
+    addTests({&AnySceneImporterTest::emptyData,
+
+              &AnySceneImporterTest::reuse,
 
               &AnySceneImporterTest::verbose});
 
@@ -121,6 +178,9 @@ void AnySceneImporterTest::load() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
     CORRADE_VERIFY(importer->openFile(data.filename));
 
+    /* ObjImporter supports concurrent import, which should get propagated */
+    CORRADE_COMPARE(importer->features(), ImporterFeature::OpenData|ImporterFeature::ConcurrentImport);
+
     /* Check only size, as it is good enough proof that it is working */
     Containers::Optional<MeshData> mesh = importer->mesh(0);
     CORRADE_VERIFY(mesh);
@@ -171,6 +231,25 @@ void AnySceneImporterTest::detect() {
     #endif
 }
 
+void AnySceneImporterTest::detectData() {
+    auto&& data = DetectDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.data));
+    /* Can't use raw string literals in macros on GCC 4.8 */
+    #ifndef CORRADE_PLUGINMANAGER_NO_DYNAMIC_PLUGIN_SUPPORT
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} is not static and was not found in nonexistent\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #else
+    CORRADE_COMPARE(out.str(), Utility::formatString(
+"PluginManager::Manager::load(): plugin {0} was not found\nTrade::AnySceneImporter::openData(): cannot load the {0} plugin\n", data.plugin));
+    #endif
+}
+
 void AnySceneImporterTest::unknown() {
     std::ostringstream output;
     Error redirectError{&output};
@@ -181,6 +260,56 @@ void AnySceneImporterTest::unknown() {
     CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openFile(): cannot determine the format of mesh.wtf\n");
 }
 
+void AnySceneImporterTest::unknownData() {
+    auto&& data = DetectUnknownDataData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(data.data));
+
+    CORRADE_COMPARE(output.str(), Utility::formatString("Trade::AnySceneImporter::openData(): cannot determine the format from signature 0x{}\n", data.signature));
+}
+
+void AnySceneImporterTest::emptyData() {
+    std::ostringstream output;
+    Error redirectError{&output};
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(!importer->openData(nullptr));
+
+    CORRADE_COMPARE(output.str(), "Trade::AnySceneImporter::openData(): file is empty\n");
+}
+
+void AnySceneImporterTest::reuse() {
+    if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("AnySceneImporter");
+    CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    importer->close();
+    CORRADE_VERIFY(!importer->isOpened());
+
+    /* Opening the same format again reuses the cached instance, which should
+       behave the same as a fresh one */
+    CORRADE_VERIFY(importer->openFile(OBJ_FILE));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+
+    /* Opening a file that fails leaves the importer in a closed state */
+    {
+        std::ostringstream out;
+        Error redirectError{&out};
+        CORRADE_VERIFY(!importer->openFile("mesh.wtf"));
+    }
+    CORRADE_VERIFY(!importer->isOpened());
+}
+
 void AnySceneImporterTest::verbose() {
     if(!(_manager.loadState("ObjImporter") & PluginManager::LoadState::Loaded))
         CORRADE_SKIP("ObjImporter plugin not enabled, cannot test");
@@ -271,6 +271,12 @@ bool AnyConverter::doConvertFileToFile(const Stage stage, const Containers::Stri
     if(!_state->optimizationLevel.isEmpty())
         converter->setOptimizationLevel(_state->optimizationLevel);
 
+    /* Propagate the cache directory. The conversion is cached by the
+       concrete plugin as this plugin only implements file conversion, which
+       isn't cached. */
+    if(!cacheDirectory().isEmpty())
+        converter->setCacheDirectory(cacheDirectory());
+
     /* Try to convert the file (error output should be printed by the plugin
        itself) */
     return converter->convertFileToFile(stage, from, to);
@@ -279,4 +285,4 @@ bool AnyConverter::doConvertFileToFile(const Stage stage, const Containers::Stri
 }}
 
 CORRADE_PLUGIN_REGISTER(AnyShaderConverter, Magnum::ShaderTools::AnyConverter,
-    "cz.mosra.magnum.ShaderTools.AbstractConverter/0.1")
+    "cz.mosra.magnum.ShaderTools.AbstractConverter/0.1.1")
@@ -86,7 +86,9 @@ Supported conversion paths:
 -   SPIR-V Assembly to SPIR-V Assembly, converted with any plugin that provides
     `SpirvAssemblyShaderConverter`
 
-Only validating and converting files is supported.
+Only validating and converting files is supported. A cache directory set via
+@ref setCacheDirectory() is propagated to the concrete plugin, which then does
+the actual caching.
 
 @section ShaderTools-AnyConverter-usage Usage
 
@@ -61,6 +61,7 @@ struct AnyConverterTest: TestSuite::Tester {
     void convertPropagatePreprocess();
     void convertPropagateDebugInfo();
     void convertPropagateOptimization();
+    void convertPropagateCacheDirectory();
 
     void detectValidate();
     void detectConvert();
@@ -114,7 +115,8 @@ AnyConverterTest::AnyConverterTest() {
               &AnyConverterTest::convertPropagateOutputVersion,
               &AnyConverterTest::convertPropagatePreprocess,
               &AnyConverterTest::convertPropagateDebugInfo,
-              &AnyConverterTest::convertPropagateOptimization});
+              &AnyConverterTest::convertPropagateOptimization,
+              &AnyConverterTest::convertPropagateCacheDirectory});
 
     addInstancedTests({&AnyConverterTest::detectValidate},
         Containers::arraySize(DetectValidateData));
@@ -545,6 +547,47 @@ void AnyConverterTest::convertPropagateOptimization() {
         "ShaderTools::SpirvToolsConverter::convertDataToData(): optimization level should be 0, 1, s, legalizeHlsl, vulkanToWebGpu, webGpuToVulkan or empty but got 2\n");
 }
 
+void AnyConverterTest::convertPropagateCacheDirectory() {
+    PluginManager::Manager<AbstractConverter> manager{MAGNUM_PLUGINS_SHADERCONVERTER_INSTALL_DIR};
+    #ifdef ANYSHADERCONVERTER_PLUGIN_FILENAME
+    CORRADE_VERIFY(manager.load(ANYSHADERCONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    if(manager.load("GlslangShaderConverter") < PluginManager::LoadState::Loaded)
+        CORRADE_SKIP("GlslangShaderConverter plugin can't be loaded.");
+
+    /* Start with an empty cache */
+    const std::string cacheDirectory = Utility::Directory::join(ANYSHADERCONVERTER_TEST_OUTPUT_DIR, "cache");
+    for(const std::string& file: Utility::Directory::list(cacheDirectory, Utility::Directory::Flag::SkipDotAndDotDot))
+        CORRADE_VERIFY(Utility::Directory::rm(Utility::Directory::join(cacheDirectory, file)));
+
+    Containers::Pointer<AbstractConverter> converter = manager.instantiate("AnyShaderConverter");
+    converter->setCacheDirectory(cacheDirectory);
+
+    const std::string inputFilename = Utility::Directory::join(ANYSHADERCONVERTER_TEST_DIR, "file.glsl");
+    const std::string outputFilename = Utility::Directory::join(ANYSHADERCONVERTER_TEST_OUTPUT_DIR, "file.spv");
+
+    /* The first conversion prints a warning */
+    {
+        std::ostringstream out;
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(converter->convertFileToFile(Stage::Fragment, inputFilename, outputFilename));
+        CORRADE_VERIFY(!out.str().empty());
+    }
+    CORRADE_COMPARE(Utility::Directory::list(cacheDirectory, Utility::Directory::Flag::SkipDotAndDotDot).size(), 1);
+
+    /* The second is taken from the cache, so the plugin doesn't get invoked
+       and thus doesn't print anything */
+    Utility::Directory::rm(outputFilename);
+    {
+        std::ostringstream out;
+        Warning redirectWarning{&out};
+        CORRADE_VERIFY(converter->convertFileToFile(Stage::Fragment, inputFilename, outputFilename));
+        CORRADE_COMPARE(out.str(), "");
+    }
+    CORRADE_VERIFY(Utility::Directory::exists(outputFilename));
+}
+
 void AnyConverterTest::detectValidate() {
     auto&& data = DetectValidateData[testCaseInstanceId()];
     setTestCaseDescription(data.name);
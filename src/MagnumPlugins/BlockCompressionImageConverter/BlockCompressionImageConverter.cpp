@@ -0,0 +1,881 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "BlockCompressionImageConverter.h"
+
+#include <cstring>
+#include <utility>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Constants.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Implementation/cpuFeatures.h"
+#include "MagnumPlugins/MagnumImageConverter/MagnumImageConverter.h"
+
+#ifdef CORRADE_TARGET_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+/* Fetches a 4x4 block of pixels in row-major order, expanded to RGBA with
+   missing channels being zero and alpha opaque. Blocks crossing the image
+   edge repeat the last row and column. */
+void fetchBlock(const Containers::StridedArrayView3D<const char>& pixels, const std::size_t blockX, const std::size_t blockY, Vector4ub(&texels)[16]) {
+    const std::size_t channelCount = pixels.size()[2];
+    for(std::size_t y = 0; y != 4; ++y) {
+        const std::size_t row = Math::min(blockY*4 + y, pixels.size()[0] - 1);
+        for(std::size_t x = 0; x != 4; ++x) {
+            const std::size_t column = Math::min(blockX*4 + x, pixels.size()[1] - 1);
+            Vector4ub& texel = texels[y*4 + x];
+            texel = {0, 0, 0, 255};
+            for(std::size_t c = 0; c != channelCount; ++c)
+                texel[c] = UnsignedByte(pixels[row][column][c]);
+        }
+    }
+}
+
+/* Principal axis of the points around their mean, calculated with a few
+   power iterations on the covariance matrix, starting from the bounding box
+   diagonal. Returns a zero vector if all points are the same. */
+template<class T> T principalAxis(const T(&points)[16], const T& mean) {
+    constexpr std::size_t size = T::Size;
+    Float covariance[size][size]{};
+    T min{Constants::inf()}, max{-Constants::inf()};
+    for(const T& point: points) {
+        const T delta = point - mean;
+        for(std::size_t i = 0; i != size; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                covariance[i][j] += delta[i]*delta[j];
+        min = Math::min(min, point);
+        max = Math::max(max, point);
+    }
+
+    T axis = max - min;
+    for(std::size_t iteration = 0; iteration != 8; ++iteration) {
+        T next;
+        for(std::size_t i = 0; i != size; ++i)
+            for(std::size_t j = 0; j != size; ++j)
+                next[i] += covariance[i][j]*axis[j];
+
+        /* Normalizing by the largest component is enough to prevent
+           overflows and cheaper than a square root */
+        const Float scale = Math::abs(next).max();
+        if(scale == 0.0f) return {};
+        axis = next/scale;
+    }
+
+    return axis.normalized();
+}
+
+/* Endpoints of the points projected on given axis going through the mean */
+template<class T> void boundingEndpoints(const T(&points)[16], const T& mean, const T& axis, T& a, T& b) {
+    Float min = Constants::inf(), max = -Constants::inf();
+    for(const T& point: points) {
+        const Float t = Math::dot(point - mean, axis);
+        min = Math::min(min, t);
+        max = Math::max(max, t);
+    }
+
+    a = Math::clamp(mean + axis*min, 0.0f, 255.0f);
+    b = Math::clamp(mean + axis*max, 0.0f, 255.0f);
+}
+
+/* Least-squares fit of the two endpoints to the points, given interpolation
+   weights of each point with 0 being the first endpoint and 1 the second.
+   Returns false if the system is degenerate, such as when all points use the
+   same weight. */
+template<class T> bool fitEndpoints(const T(&points)[16], const Float(&weights)[16], T& a, T& b) {
+    Float aa{}, bb{}, ab{};
+    T ax, bx;
+    for(std::size_t i = 0; i != 16; ++i) {
+        const Float w = weights[i];
+        const Float iw = 1.0f - w;
+        aa += iw*iw;
+        bb += w*w;
+        ab += iw*w;
+        ax += points[i]*iw;
+        bx += points[i]*w;
+    }
+
+    const Float determinant = aa*bb - ab*ab;
+    if(Math::abs(determinant) < 1.0e-6f) return false;
+
+    a = Math::clamp((ax*bb - bx*ab)/determinant, 0.0f, 255.0f);
+    b = Math::clamp((bx*aa - ax*ab)/determinant, 0.0f, 255.0f);
+    return true;
+}
+
+/* Search for the closest palette entry for each point, which is where most
+   of the BC1 and BC7 encoding time goes. Palette entries and points have four
+   channels in the 0-255 range and there's at most 16 entries. The SIMD
+   variants handle palettes with a multiple of four entries, calculating the
+   error to four entries at once. Ties pick the lowest index in all variants,
+   so the output is the same. */
+
+namespace Scalar {
+
+Int closestPaletteIndices(const Vector4i* const palette, const UnsignedInt paletteSize, const Vector4i(&points)[16], UnsignedByte(&indices)[16]) {
+    Int error = 0;
+    for(std::size_t i = 0; i != 16; ++i) {
+        Int best = Math::dot(palette[0] - points[i], palette[0] - points[i]);
+        UnsignedByte bestIndex = 0;
+        for(UnsignedInt j = 1; j != paletteSize; ++j) {
+            const Int e = Math::dot(palette[j] - points[i], palette[j] - points[i]);
+            if(e < best) {
+                best = e;
+                bestIndex = UnsignedByte(j);
+            }
+        }
+        error += best;
+        indices[i] = bestIndex;
+    }
+
+    return error;
+}
+
+}
+
+#if defined(CORRADE_TARGET_SSE2) || defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+/* Picks the smallest of the per-lane minimal errors, and the lowest index in
+   case of a tie */
+inline Int closestLane(const Int(&errors)[4], const Int(&laneIndices)[4], UnsignedByte& index) {
+    Int best = errors[0];
+    Int bestIndex = laneIndices[0];
+    for(std::size_t l = 1; l != 4; ++l) {
+        if(errors[l] < best || (errors[l] == best && laneIndices[l] < bestIndex)) {
+            best = errors[l];
+            bestIndex = laneIndices[l];
+        }
+    }
+
+    index = UnsignedByte(bestIndex);
+    return best;
+}
+#endif
+
+#ifdef CORRADE_TARGET_SSE2
+namespace Sse2 {
+
+Int closestPaletteIndices(const Vector4i* const palette, const UnsignedInt paletteSize, const Vector4i(&points)[16], UnsignedByte(&indices)[16]) {
+    /* Channel differences fit into 16 bits, so pairs of them can be squared
+       and summed into 32 bits with a single madd. Each group of four palette
+       entries has the red and green channels interleaved in one register and
+       blue and alpha in another. */
+    const UnsignedInt groupCount = paletteSize/4;
+    __m128i rg[4], ba[4];
+    for(UnsignedInt g = 0; g != groupCount; ++g) {
+        const Vector4i* const p = palette + g*4;
+        rg[g] = _mm_setr_epi16(p[0].x(), p[0].y(), p[1].x(), p[1].y(), p[2].x(), p[2].y(), p[3].x(), p[3].y());
+        ba[g] = _mm_setr_epi16(p[0].z(), p[0].w(), p[1].z(), p[1].w(), p[2].z(), p[2].w(), p[3].z(), p[3].w());
+    }
+
+    const __m128i laneIndices = _mm_setr_epi32(0, 1, 2, 3);
+    Int error = 0;
+    for(std::size_t i = 0; i != 16; ++i) {
+        const __m128i pointRg = _mm_set1_epi32(points[i].y() << 16|points[i].x());
+        const __m128i pointBa = _mm_set1_epi32(points[i].w() << 16|points[i].z());
+
+        __m128i best{}, bestIndex = laneIndices;
+        for(UnsignedInt g = 0; g != groupCount; ++g) {
+            const __m128i drg = _mm_sub_epi16(rg[g], pointRg);
+            const __m128i dba = _mm_sub_epi16(ba[g], pointBa);
+            const __m128i e = _mm_add_epi32(_mm_madd_epi16(drg, drg), _mm_madd_epi16(dba, dba));
+            if(!g) {
+                best = e;
+                continue;
+            }
+
+            /* Strictly less, so a lower index wins a tie */
+            const __m128i less = _mm_cmplt_epi32(e, best);
+            best = _mm_or_si128(_mm_and_si128(less, e), _mm_andnot_si128(less, best));
+            bestIndex = _mm_or_si128(_mm_and_si128(less, _mm_add_epi32(laneIndices, _mm_set1_epi32(g*4))), _mm_andnot_si128(less, bestIndex));
+        }
+
+        Int errors[4], errorIndices[4];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(errors), best);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(errorIndices), bestIndex);
+        error += closestLane(errors, errorIndices, indices[i]);
+    }
+
+    return error;
+}
+
+}
+#endif
+
+#ifdef MAGNUM_MATH_IMPLEMENTATION_NEON
+namespace Neon {
+
+Int closestPaletteIndices(const Vector4i* const palette, const UnsignedInt paletteSize, const Vector4i(&points)[16], UnsignedByte(&indices)[16]) {
+    /* Each group of four palette entries has one register per channel */
+    const UnsignedInt groupCount = paletteSize/4;
+    int32x4_t channels[4][4];
+    for(UnsignedInt g = 0; g != groupCount; ++g) {
+        for(std::size_t c = 0; c != 4; ++c) {
+            const Int values[]{palette[g*4][c], palette[g*4 + 1][c], palette[g*4 + 2][c], palette[g*4 + 3][c]};
+            channels[g][c] = vld1q_s32(values);
+        }
+    }
+
+    const Int laneIndexData[]{0, 1, 2, 3};
+    const int32x4_t laneIndices = vld1q_s32(laneIndexData);
+    Int error = 0;
+    for(std::size_t i = 0; i != 16; ++i) {
+        int32x4_t best{}, bestIndex = laneIndices;
+        for(UnsignedInt g = 0; g != groupCount; ++g) {
+            int32x4_t e = vdupq_n_s32(0);
+            for(std::size_t c = 0; c != 4; ++c) {
+                const int32x4_t d = vsubq_s32(channels[g][c], vdupq_n_s32(points[i][c]));
+                e = vmlaq_s32(e, d, d);
+            }
+            if(!g) {
+                best = e;
+                continue;
+            }
+
+            /* Strictly less, so a lower index wins a tie */
+            const uint32x4_t less = vcltq_s32(e, best);
+            best = vbslq_s32(less, e, best);
+            bestIndex = vbslq_s32(less, vaddq_s32(laneIndices, vdupq_n_s32(g*4)), bestIndex);
+        }
+
+        Int errors[4], errorIndices[4];
+        vst1q_s32(errors, best);
+        vst1q_s32(errorIndices, bestIndex);
+        error += closestLane(errors, errorIndices, indices[i]);
+    }
+
+    return error;
+}
+
+}
+#endif
+
+Int closestPaletteIndices(const Vector4i* const palette, const UnsignedInt paletteSize, const Vector4i(&points)[16], UnsignedByte(&indices)[16]) {
+    #ifdef CORRADE_TARGET_SSE2
+    if(paletteSize % 4 == 0)
+        return Sse2::closestPaletteIndices(palette, paletteSize, points, indices);
+    #elif defined(MAGNUM_MATH_IMPLEMENTATION_NEON)
+    if(paletteSize % 4 == 0)
+        return Neon::closestPaletteIndices(palette, paletteSize, points, indices);
+    #endif
+    return Scalar::closestPaletteIndices(palette, paletteSize, points, indices);
+}
+
+/* BC1 color block */
+
+UnsignedShort packRgb565(const Vector3& color) {
+    const Vector3i c{Math::clamp(color, 0.0f, 255.0f)*Vector3{31.0f, 63.0f, 31.0f}/255.0f + Vector3{0.5f}};
+    return (c.r() << 11)|(c.g() << 5)|c.b();
+}
+
+Vector3i unpackRgb565(const UnsignedShort color) {
+    const Int r = color >> 11 & 0x1f;
+    const Int g = color >> 5 & 0x3f;
+    const Int b = color & 0x1f;
+    return {(r << 3)|(r >> 2), (g << 2)|(g >> 4), (b << 3)|(b >> 2)};
+}
+
+/* Interpolation weights of the four-color BC1 palette entries */
+constexpr Float Bc1Weights[]{0.0f, 1.0f, 1.0f/3.0f, 2.0f/3.0f};
+
+/* Orders the endpoints so the block decodes in the four-color mode and
+   calculates the indices, returning the total squared error */
+Int bc1Indices(const Vector3(&points)[16], UnsignedShort& c0, UnsignedShort& c1, UnsignedInt& indices) {
+    if(c0 < c1) std::swap(c0, c1);
+
+    /* The alpha channel is unused and kept at zero */
+    Vector4i palette[4];
+    palette[0] = {unpackRgb565(c0), 0};
+    palette[1] = {unpackRgb565(c1), 0};
+    palette[2] = (palette[0]*2 + palette[1])/3;
+    palette[3] = (palette[0] + palette[1]*2)/3;
+
+    /* Same endpoints decode in the three-color mode, where only the first
+       entry is the same as in the four-color mode */
+    const UnsignedInt paletteSize = c0 == c1 ? 1 : 4;
+
+    Vector4i integerPoints[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        integerPoints[i] = {Vector3i{points[i]}, 0};
+
+    UnsignedByte pointIndices[16];
+    const Int error = closestPaletteIndices(palette, paletteSize, integerPoints, pointIndices);
+    indices = 0;
+    for(std::size_t i = 0; i != 16; ++i)
+        indices |= UnsignedInt(pointIndices[i]) << 2*i;
+
+    return error;
+}
+
+void encodeBc1Color(const Vector4ub(&texels)[16], char* const out) {
+    Vector3 points[16];
+    Vector3 mean;
+    for(std::size_t i = 0; i != 16; ++i) {
+        points[i] = Vector3{texels[i].xyz()};
+        mean += points[i];
+    }
+    mean /= 16.0f;
+
+    UnsignedShort c0, c1;
+    UnsignedInt indices;
+    const Vector3 axis = principalAxis(points, mean);
+    if(axis.isZero()) {
+        c0 = c1 = packRgb565(mean);
+        bc1Indices(points, c0, c1, indices);
+    } else {
+        Vector3 a, b;
+        boundingEndpoints(points, mean, axis, a, b);
+        c0 = packRgb565(b);
+        c1 = packRgb565(a);
+        Int error = bc1Indices(points, c0, c1, indices);
+
+        /* Refine the endpoints using the weights from the first pass */
+        Float weights[16];
+        for(std::size_t i = 0; i != 16; ++i)
+            weights[i] = Bc1Weights[indices >> 2*i & 0x3];
+        if(fitEndpoints(points, weights, b, a)) {
+            UnsignedShort refined0 = packRgb565(b);
+            UnsignedShort refined1 = packRgb565(a);
+            UnsignedInt refinedIndices;
+            if(bc1Indices(points, refined0, refined1, refinedIndices) < error) {
+                c0 = refined0;
+                c1 = refined1;
+                indices = refinedIndices;
+            }
+        }
+    }
+
+    out[0] = char(c0 & 0xff);
+    out[1] = char(c0 >> 8);
+    out[2] = char(c1 & 0xff);
+    out[3] = char(c1 >> 8);
+    for(std::size_t i = 0; i != 4; ++i)
+        out[4 + i] = char(indices >> 8*i & 0xff);
+}
+
+/* BC4 single-channel block, used also for BC3 alpha and BC5 */
+
+void encodeBc4Channel(const UnsignedByte(&values)[16], char* const out) {
+    UnsignedByte min = 255, max = 0;
+    for(const UnsignedByte value: values) {
+        min = Math::min(min, value);
+        max = Math::max(max, value);
+    }
+
+    /* With the first endpoint larger the block uses the eight-value mode,
+       where the indices go from the first endpoint (0) over six interpolated
+       values (2 to 7) to the second (1). Same endpoints decode to the first
+       endpoint with all indices zero. */
+    UnsignedLong indices = 0;
+    if(max != min) {
+        const Int range = max - min;
+        for(std::size_t i = 0; i != 16; ++i) {
+            const Int t = ((max - values[i])*7 + range/2)/range;
+            const UnsignedLong index = t == 0 ? 0 : t == 7 ? 1 : t + 1;
+            indices |= index << 3*i;
+        }
+    }
+
+    out[0] = char(max);
+    out[1] = char(min);
+    for(std::size_t i = 0; i != 6; ++i)
+        out[2 + i] = char(indices >> 8*i & 0xff);
+}
+
+template<std::size_t channel> void extractChannel(const Vector4ub(&texels)[16], UnsignedByte(&values)[16]) {
+    for(std::size_t i = 0; i != 16; ++i)
+        values[i] = texels[i][channel];
+}
+
+void encodeBc1(const Vector4ub(&texels)[16], char* const out) {
+    encodeBc1Color(texels, out);
+}
+
+void encodeBc3(const Vector4ub(&texels)[16], char* const out) {
+    UnsignedByte alpha[16];
+    extractChannel<3>(texels, alpha);
+    encodeBc4Channel(alpha, out);
+    encodeBc1Color(texels, out + 8);
+}
+
+void encodeBc4(const Vector4ub(&texels)[16], char* const out) {
+    UnsignedByte red[16];
+    extractChannel<0>(texels, red);
+    encodeBc4Channel(red, out);
+}
+
+void encodeBc5(const Vector4ub(&texels)[16], char* const out) {
+    UnsignedByte values[16];
+    extractChannel<0>(texels, values);
+    encodeBc4Channel(values, out);
+    extractChannel<1>(texels, values);
+    encodeBc4Channel(values, out + 8);
+}
+
+/* BC7 block, using mode 6 with a single subset, 7-bit RGBA endpoints with
+   unique p-bits and 4-bit indices */
+
+constexpr Int Bc7Weights[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+/* Quantizes an endpoint to seven bits per channel plus a p-bit, picking the
+   p-bit that gives a smaller error */
+Vector4i quantizeBc7Endpoint(const Vector4& endpoint, UnsignedInt& pBit) {
+    Vector4i best;
+    Float bestError = Constants::inf();
+    for(UnsignedInt p = 0; p != 2; ++p) {
+        const Vector4i quantized{Math::clamp((endpoint - Vector4{Float(p)})*0.5f + Vector4{0.5f}, 0.0f, 127.0f)};
+        const Vector4 delta = Vector4{quantized*2 + Vector4i{Int(p)}} - endpoint;
+        const Float error = Math::dot(delta, delta);
+        if(error < bestError) {
+            bestError = error;
+            best = quantized;
+            pBit = p;
+        }
+    }
+
+    return best;
+}
+
+Int bc7Indices(const Vector4(&points)[16], const Vector4i& e0, const Vector4i& e1, UnsignedByte(&indices)[16]) {
+    Vector4i palette[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        palette[i] = (e0*(64 - Bc7Weights[i]) + e1*Bc7Weights[i] + Vector4i{32})/64;
+
+    Vector4i integerPoints[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        integerPoints[i] = Vector4i{points[i]};
+
+    return closestPaletteIndices(palette, 16, integerPoints, indices);
+}
+
+/* Writes bits LSB-first, the output is expected to be zero-initialized */
+struct BitWriter {
+    void write(const UnsignedInt value, const UnsignedInt bits) {
+        for(UnsignedInt i = 0; i != bits; ++i, ++offset)
+            if(value >> i & 1) data[offset >> 3] |= 1 << (offset & 7);
+    }
+
+    UnsignedByte* data;
+    std::size_t offset;
+};
+
+void encodeBc7(const Vector4ub(&texels)[16], char* const out) {
+    Vector4 points[16];
+    Vector4 mean;
+    for(std::size_t i = 0; i != 16; ++i) {
+        points[i] = Vector4{texels[i]};
+        mean += points[i];
+    }
+    mean /= 16.0f;
+
+    Vector4 a = mean, b = mean;
+    const Vector4 axis = principalAxis(points, mean);
+    if(!axis.isZero()) boundingEndpoints(points, mean, axis, a, b);
+
+    UnsignedInt p0, p1;
+    Vector4i q0 = quantizeBc7Endpoint(a, p0);
+    Vector4i q1 = quantizeBc7Endpoint(b, p1);
+    UnsignedByte indices[16];
+    Int error = bc7Indices(points, q0*2 + Vector4i{Int(p0)}, q1*2 + Vector4i{Int(p1)}, indices);
+
+    /* Refine the endpoints using the weights from the first pass */
+    Float weights[16];
+    for(std::size_t i = 0; i != 16; ++i)
+        weights[i] = Bc7Weights[indices[i]]/64.0f;
+    if(error && fitEndpoints(points, weights, a, b)) {
+        UnsignedInt refinedP0, refinedP1;
+        const Vector4i refined0 = quantizeBc7Endpoint(a, refinedP0);
+        const Vector4i refined1 = quantizeBc7Endpoint(b, refinedP1);
+        UnsignedByte refinedIndices[16];
+        if(bc7Indices(points, refined0*2 + Vector4i{Int(refinedP0)}, refined1*2 + Vector4i{Int(refinedP1)}, refinedIndices) < error) {
+            q0 = refined0;
+            q1 = refined1;
+            p0 = refinedP0;
+            p1 = refinedP1;
+            std::memcpy(indices, refinedIndices, sizeof(indices));
+        }
+    }
+
+    /* The most significant index bit of the first pixel is implicitly zero,
+       swap the endpoints if it isn't */
+    if(indices[0] & 0x8) {
+        std::swap(q0, q1);
+        std::swap(p0, p1);
+        for(UnsignedByte& index: indices) index = 15 - index;
+    }
+
+    UnsignedByte block[16]{};
+    BitWriter writer{block, 0};
+    writer.write(1 << 6, 7);
+    for(std::size_t c = 0; c != 4; ++c) {
+        writer.write(q0[c], 7);
+        writer.write(q1[c], 7);
+    }
+    writer.write(p0, 1);
+    writer.write(p1, 1);
+    writer.write(indices[0], 3);
+    for(std::size_t i = 1; i != 16; ++i)
+        writer.write(indices[i], 4);
+    std::memcpy(out, block, 16);
+}
+
+/* ETC2 RGB block, using just the individual and differential modes that are
+   shared with ETC1 */
+
+constexpr Int EtcModifiers[8][2]{
+    {2, 8}, {5, 17}, {9, 29}, {13, 42},
+    {18, 60}, {24, 80}, {33, 106}, {47, 183}
+};
+
+/* Picks the modifier table giving the smallest error for a subblock with
+   given base color, returns the error and fills the table and per-pixel
+   modifier indices. Modifier index 0 and 1 is the small and large positive
+   modifier, 2 and 3 the small and large negative. */
+Int etcSubblock(const Vector3i(&pixels)[8], const Vector3i& base, UnsignedInt& table, UnsignedByte(&modifiers)[8]) {
+    Int bestError = 0x7fffffff;
+    for(UnsignedInt t = 0; t != 8; ++t) {
+        const Int candidates[]{EtcModifiers[t][0], EtcModifiers[t][1], -EtcModifiers[t][0], -EtcModifiers[t][1]};
+        Int error = 0;
+        UnsignedByte indices[8];
+        for(std::size_t i = 0; i != 8; ++i) {
+            Int best = 0x7fffffff;
+            for(UnsignedByte m = 0; m != 4; ++m) {
+                const Vector3i delta = Math::clamp(base + Vector3i{candidates[m]}, 0, 255) - pixels[i];
+                const Int e = Math::dot(delta, delta);
+                if(e < best) {
+                    best = e;
+                    indices[i] = m;
+                }
+            }
+            error += best;
+        }
+
+        if(error < bestError) {
+            bestError = error;
+            table = t;
+            std::memcpy(modifiers, indices, sizeof(indices));
+        }
+    }
+
+    return bestError;
+}
+
+void encodeEtc2Color(const Vector4ub(&texels)[16], char* const out) {
+    Int bestError = 0x7fffffff;
+    UnsignedByte block[8]{};
+
+    for(UnsignedInt flip = 0; flip != 2; ++flip) {
+        /* Without flip the subblocks are 2x4 side by side, with flip 4x2
+           above each other. Pixel positions are column-major. */
+        Vector3i pixels[2][8];
+        UnsignedByte positions[2][8];
+        Vector3 average[2];
+        for(UnsignedInt y = 0; y != 4; ++y) {
+            for(UnsignedInt x = 0; x != 4; ++x) {
+                const UnsignedInt subblock = flip ? y/2 : x/2;
+                const UnsignedInt i = flip ? (y % 2)*4 + x : y*2 + x % 2;
+                pixels[subblock][i] = Vector3i{texels[y*4 + x].xyz()};
+                positions[subblock][i] = x*4 + y;
+                average[subblock] += Vector3{pixels[subblock][i]};
+            }
+        }
+        average[0] /= 8.0f;
+        average[1] /= 8.0f;
+
+        for(UnsignedInt differential = 0; differential != 2; ++differential) {
+            Vector3i color[2], base[2];
+            if(differential) {
+                /* 5-bit base color and a 3-bit signed delta for the second
+                   subblock, clamped so it never overflows, which would make
+                   an ETC2 decoder interpret the block in a different mode */
+                color[0] = Vector3i{average[0]*31.0f/255.0f + Vector3{0.5f}};
+                const Vector3i second{average[1]*31.0f/255.0f + Vector3{0.5f}};
+                color[1] = Math::clamp(second - color[0], -4, 3);
+                for(UnsignedInt s = 0; s != 2; ++s) {
+                    const Vector3i c = s ? color[0] + color[1] : color[0];
+                    base[s] = c*8 + c/4;
+                }
+            } else {
+                /* Individual 4-bit colors */
+                for(UnsignedInt s = 0; s != 2; ++s) {
+                    color[s] = Vector3i{average[s]*15.0f/255.0f + Vector3{0.5f}};
+                    base[s] = color[s]*17;
+                }
+            }
+
+            UnsignedInt tables[2];
+            UnsignedByte modifiers[2][8];
+            const Int error =
+                etcSubblock(pixels[0], base[0], tables[0], modifiers[0]) +
+                etcSubblock(pixels[1], base[1], tables[1], modifiers[1]);
+            if(error >= bestError) continue;
+            bestError = error;
+
+            for(std::size_t c = 0; c != 3; ++c)
+                block[c] = differential ?
+                    UnsignedByte(color[0][c] << 3|(color[1][c] & 0x7)) :
+                    UnsignedByte(color[0][c] << 4|color[1][c]);
+            block[3] = UnsignedByte(tables[0] << 5|tables[1] << 2|differential << 1|flip);
+
+            UnsignedInt msb = 0, lsb = 0;
+            for(UnsignedInt s = 0; s != 2; ++s) {
+                for(std::size_t i = 0; i != 8; ++i) {
+                    msb |= UnsignedInt(modifiers[s][i] >> 1) << positions[s][i];
+                    lsb |= UnsignedInt(modifiers[s][i] & 1) << positions[s][i];
+                }
+            }
+            block[4] = UnsignedByte(msb >> 8);
+            block[5] = UnsignedByte(msb & 0xff);
+            block[6] = UnsignedByte(lsb >> 8);
+            block[7] = UnsignedByte(lsb & 0xff);
+        }
+    }
+
+    std::memcpy(out, block, 8);
+}
+
+/* EAC alpha block of ETC2 RGBA */
+
+constexpr Int EacModifiers[16][8]{
+    {-3, -6, -9, -15, 2, 5, 8, 14},
+    {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12},
+    {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11},
+    {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10},
+    {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},
+    {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},
+    {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},
+    {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},
+    {-3, -5, -7, -9, 2, 4, 6, 8}
+};
+
+void encodeEacAlpha(const Vector4ub(&texels)[16], char* const out) {
+    Int min = 255, max = 0;
+    for(const Vector4ub& texel: texels) {
+        min = Math::min(min, Int(texel.a()));
+        max = Math::max(max, Int(texel.a()));
+    }
+
+    /* For each table, the multipliers closest to covering the value range
+       are tried with the base centered in it. The most negative modifier is
+       always at index 3 and the most positive at 7. */
+    Int bestError = 0x7fffffff;
+    Int bestBase{}, bestMultiplier{}, bestTable{};
+    UnsignedByte bestIndices[16]{};
+    for(Int t = 0; t != 16 && bestError; ++t) {
+        const Int span = EacModifiers[t][7] - EacModifiers[t][3];
+        const Int center = (max - min + span/2)/span;
+        for(Int multiplier = Math::max(center - 1, 1); multiplier <= Math::min(center + 1, 15); ++multiplier) {
+            const Int base = Math::clamp((min + max - (EacModifiers[t][3] + EacModifiers[t][7])*multiplier + 1)/2, 0, 255);
+
+            Int error = 0;
+            UnsignedByte indices[16];
+            for(UnsignedInt y = 0; y != 4; ++y) {
+                for(UnsignedInt x = 0; x != 4; ++x) {
+                    const Int value = texels[y*4 + x].a();
+                    Int best = 0x7fffffff;
+                    for(UnsignedByte m = 0; m != 8; ++m) {
+                        const Int e = Math::abs(Math::clamp(base + EacModifiers[t][m]*multiplier, 0, 255) - value);
+                        if(e < best) {
+                            best = e;
+                            indices[x*4 + y] = m;
+                        }
+                    }
+                    error += best*best;
+                }
+            }
+
+            if(error < bestError) {
+                bestError = error;
+                bestBase = base;
+                bestMultiplier = multiplier;
+                bestTable = t;
+                std::memcpy(bestIndices, indices, sizeof(indices));
+            }
+        }
+    }
+
+    /* The indices are stored big-endian in column-major order */
+    UnsignedLong bits = 0;
+    for(const UnsignedByte index: bestIndices)
+        bits = bits << 3|index;
+
+    out[0] = char(bestBase);
+    out[1] = char(bestMultiplier << 4|bestTable);
+    for(std::size_t i = 0; i != 6; ++i)
+        out[2 + i] = char(bits >> 8*(5 - i) & 0xff);
+}
+
+void encodeEtc2(const Vector4ub(&texels)[16], char* const out) {
+    encodeEtc2Color(texels, out);
+}
+
+void encodeEtc2Alpha(const Vector4ub(&texels)[16], char* const out) {
+    encodeEacAlpha(texels, out);
+    encodeEtc2Color(texels, out + 8);
+}
+
+Containers::Optional<CompressedImage2D> compress(const ImageView2D& image, const Utility::ConfigurationGroup& configuration, const ImageConverterFlags flags, const char* const prefix) {
+    bool srgb;
+    switch(image.format()) {
+        case PixelFormat::R8Unorm:
+        case PixelFormat::RG8Unorm:
+        case PixelFormat::RGB8Unorm:
+        case PixelFormat::RGBA8Unorm:
+            srgb = false;
+            break;
+        case PixelFormat::R8Srgb:
+        case PixelFormat::RG8Srgb:
+        case PixelFormat::RGB8Srgb:
+        case PixelFormat::RGBA8Srgb:
+            srgb = true;
+            break;
+        default:
+            Error{} << prefix << "unsupported format" << image.format();
+            return {};
+    }
+
+    const std::string formatName = configuration.value("format");
+    CompressedPixelFormat format;
+    std::size_t blockSize;
+    void(*encode)(const Vector4ub(&)[16], char*);
+    if(formatName == "bc1") {
+        format = srgb ? CompressedPixelFormat::Bc1RGBSrgb : CompressedPixelFormat::Bc1RGBUnorm;
+        blockSize = 8;
+        encode = encodeBc1;
+    } else if(formatName == "bc3") {
+        format = srgb ? CompressedPixelFormat::Bc3RGBASrgb : CompressedPixelFormat::Bc3RGBAUnorm;
+        blockSize = 16;
+        encode = encodeBc3;
+    } else if(formatName == "bc4") {
+        format = CompressedPixelFormat::Bc4RUnorm;
+        blockSize = 8;
+        encode = encodeBc4;
+    } else if(formatName == "bc5") {
+        format = CompressedPixelFormat::Bc5RGUnorm;
+        blockSize = 16;
+        encode = encodeBc5;
+    } else if(formatName == "bc7") {
+        format = srgb ? CompressedPixelFormat::Bc7RGBASrgb : CompressedPixelFormat::Bc7RGBAUnorm;
+        blockSize = 16;
+        encode = encodeBc7;
+    } else if(formatName == "etc2") {
+        format = srgb ? CompressedPixelFormat::Etc2RGB8Srgb : CompressedPixelFormat::Etc2RGB8Unorm;
+        blockSize = 8;
+        encode = encodeEtc2;
+    } else if(formatName == "etc2a") {
+        format = srgb ? CompressedPixelFormat::Etc2RGBA8Srgb : CompressedPixelFormat::Etc2RGBA8Unorm;
+        blockSize = 16;
+        encode = encodeEtc2Alpha;
+    } else {
+        Error{} << prefix << "unsupported target format" << formatName;
+        return {};
+    }
+
+    if(!image.size().product()) {
+        Error{} << prefix << "can't compress an empty image";
+        return {};
+    }
+
+    const Containers::StridedArrayView3D<const char> pixels = image.pixels();
+    const std::size_t blocksX = (image.size().x() + 3)/4;
+    const std::size_t blocksY = (image.size().y() + 3)/4;
+    Containers::Array<char> data{Containers::NoInit, blocksX*blocksY*blockSize};
+
+    /* Zero thread count means hardware concurrency, small images use less
+       threads. Each thread compresses a range of whole rows of blocks. */
+    const UnsignedInt threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(configuration.value<UnsignedInt>("threads")), std::size_t(image.size().product()));
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(blocksY, threadCount, thread);
+        Vector4ub texels[16];
+        for(std::size_t y = range.first; y != range.second; ++y) {
+            for(std::size_t x = 0; x != blocksX; ++x) {
+                fetchBlock(pixels, x, y, texels);
+                encode(texels, data + (y*blocksX + x)*blockSize);
+            }
+        }
+    });
+
+    if(flags & ImageConverterFlag::Verbose)
+        Debug{} << prefix << "compressed" << blocksX*blocksY << "blocks to" << format << "on" << threadCount << "threads";
+
+    return CompressedImage2D{CompressedPixelStorage{}
+        .setCompressedBlockSize({4, 4, 1})
+        .setCompressedBlockDataSize(Int(blockSize)),
+        format, image.size(), std::move(data)};
+}
+
+}
+
+BlockCompressionImageConverter::BlockCompressionImageConverter() = default;
+
+BlockCompressionImageConverter::BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+
+BlockCompressionImageConverter::~BlockCompressionImageConverter() = default;
+
+ImageConverterFeatures BlockCompressionImageConverter::doFeatures() const {
+    return ImageConverterFeature::ConvertCompressedImage|ImageConverterFeature::ConvertData;
+}
+
+Containers::Optional<CompressedImage2D> BlockCompressionImageConverter::doExportToCompressedImage(const ImageView2D& image) {
+    return compress(image, configuration(), flags(), "Trade::BlockCompressionImageConverter::exportToCompressedImage():");
+}
+
+Containers::Array<char> BlockCompressionImageConverter::doExportToData(const ImageView2D& image) {
+    Containers::Optional<CompressedImage2D> compressed = compress(image, configuration(), flags(), "Trade::BlockCompressionImageConverter::exportToData():");
+    if(!compressed) return nullptr;
+
+    /* Wrap the compressed data in a blob, passing the level through */
+    MagnumImageConverter converter;
+    converter.configuration().setValue("level", configuration().value<UnsignedInt>("level"));
+    return converter.exportToData(CompressedImageView2D{*compressed});
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(BlockCompressionImageConverter, Magnum::Trade::BlockCompressionImageConverter,
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1")
@@ -0,0 +1,175 @@
+#ifndef Magnum_Trade_BlockCompressionImageConverter_h
+#define Magnum_Trade_BlockCompressionImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::BlockCompressionImageConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "MagnumPlugins/BlockCompressionImageConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_BUILD_STATIC
+    #ifdef BlockCompressionImageConverter_EXPORTS
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT
+#define MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Block compression image converter plugin
+@m_since_latest
+
+Compresses images to BC1, BC3, BC4, BC5, BC7, ETC2 RGB or ETC2 RGBA formats,
+optionally on multiple threads. The result is available either as a
+@ref CompressedImage2D through @ref exportToCompressedImage() or, when
+exporting to a file or data, wrapped in Magnum's own binary blob format using
+the @ref MagnumImageConverter plugin, which can be then imported with
+@ref MagnumImporter and uploaded to a GPU texture directly.
+
+@section Trade-BlockCompressionImageConverter-usage Usage
+
+This plugin depends on the @ref Trade library and the
+@ref MagnumImageConverter plugin and is built if
+`WITH_BLOCKCOMPRESSIONIMAGECONVERTER` is enabled when building Magnum. To use
+as a dynamic plugin, load @cpp "BlockCompressionImageConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_BLOCKCOMPRESSIONIMAGECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::BlockCompressionImageConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `BlockCompressionImageConverter` component of the `Magnum`
+package and link to the `Magnum::BlockCompressionImageConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED BlockCompressionImageConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::BlockCompressionImageConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+The plugin can be used from the @ref magnum-imageconverter "magnum-imageconverter"
+utility as well, for example to compress an image to BC7 on all available
+cores:
+
+@code{.sh}
+magnum-imageconverter image.png image.blob \
+    -C BlockCompressionImageConverter -c format=bc7,threads=0
+@endcode
+
+@section Trade-BlockCompressionImageConverter-behavior Behavior and limitations
+
+Accepts @ref PixelFormat::R8Unorm, @ref PixelFormat::RG8Unorm,
+@ref PixelFormat::RGB8Unorm, @ref PixelFormat::RGBA8Unorm and their sRGB
+variants. Missing green and blue channels are treated as zero and missing
+alpha as fully opaque. The target format is chosen with the
+@cb{.ini} format @ce @ref Trade-BlockCompressionImageConverter-configuration "configuration option":
+
+-   @cb{.ini} bc1 @ce produces @ref CompressedPixelFormat::Bc1RGBUnorm, or
+    @ref CompressedPixelFormat::Bc1RGBSrgb for sRGB input, ignoring the
+    alpha channel
+-   @cb{.ini} bc3 @ce produces @ref CompressedPixelFormat::Bc3RGBAUnorm or
+    @ref CompressedPixelFormat::Bc3RGBASrgb
+-   @cb{.ini} bc4 @ce produces @ref CompressedPixelFormat::Bc4RUnorm from the
+    red channel
+-   @cb{.ini} bc5 @ce produces @ref CompressedPixelFormat::Bc5RGUnorm from the
+    red and green channels
+-   @cb{.ini} bc7 @ce produces @ref CompressedPixelFormat::Bc7RGBAUnorm or
+    @ref CompressedPixelFormat::Bc7RGBASrgb
+-   @cb{.ini} etc2 @ce produces @ref CompressedPixelFormat::Etc2RGB8Unorm or
+    @ref CompressedPixelFormat::Etc2RGB8Srgb, ignoring the alpha channel
+-   @cb{.ini} etc2a @ce produces @ref CompressedPixelFormat::Etc2RGBA8Unorm
+    or @ref CompressedPixelFormat::Etc2RGBA8Srgb
+
+The encoders favor speed over the last bits of quality. Color endpoints are
+fitted along the principal axis of each 4x4 block and then refined with a
+least-squares pass, sRGB data are compressed as-is without decoding to linear
+space first. BC7 uses only the single-subset mode 6, the ETC2 encoder emits
+only the individual and differential modes shared with ETC1 and the alpha
+channel of ETC2 RGBA is searched exhaustively over all EAC modifier tables and
+multipliers. The search for the closest palette entries in BC1 and BC7 is done
+with SSE2 or NEON where available, with the same output as the scalar code.
+Images with sizes not divisible by four are padded by repeating the last row
+and column, the resulting @ref CompressedImage2D has the original size.
+
+The blocks are independent, so with the @cb{.ini} threads @ce option set to a
+value other than @cpp 1 @ce, rows of blocks are compressed on multiple
+threads.
+
+@section Trade-BlockCompressionImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values.
+
+@snippet MagnumPlugins/BlockCompressionImageConverter/BlockCompressionImageConverter.conf configuration_
+
+See @ref plugins-configuration for more information.
+*/
+class MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_EXPORT BlockCompressionImageConverter: public AbstractImageConverter {
+    public:
+        /** @brief Default constructor */
+        explicit BlockCompressionImageConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit BlockCompressionImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~BlockCompressionImageConverter();
+
+    private:
+        MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
+        MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL Containers::Optional<CompressedImage2D> doExportToCompressedImage(const ImageView2D& image) override;
+        MAGNUM_BLOCKCOMPRESSIONIMAGECONVERTER_LOCAL Containers::Array<char> doExportToData(const ImageView2D& image) override;
+};
+
+}}
+
+#endif
@@ -0,0 +1,463 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cmath>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include "Magnum/Image.h"
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector4.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct BlockCompressionImageConverterTest: TestSuite::Tester {
+    explicit BlockCompressionImageConverterTest();
+
+    void compress();
+    void compressUniform();
+    void compressSrgb();
+    void compressNonMultipleOfFour();
+    void compressThreads();
+
+    void unsupportedFormat();
+    void unknownTargetFormat();
+    void emptyImage();
+
+    void exportToData();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    const char* format;
+    CompressedPixelFormat expected;
+    Int blockDataSize;
+    UnsignedInt channels;
+    Float maxError;
+} CompressData[]{
+    {"BC1", "bc1", CompressedPixelFormat::Bc1RGBUnorm, 8, 3, 8.0f},
+    {"BC3", "bc3", CompressedPixelFormat::Bc3RGBAUnorm, 16, 4, 7.0f},
+    {"BC4", "bc4", CompressedPixelFormat::Bc4RUnorm, 8, 1, 2.5f},
+    {"BC5", "bc5", CompressedPixelFormat::Bc5RGUnorm, 16, 2, 2.5f},
+    {"BC7", "bc7", CompressedPixelFormat::Bc7RGBAUnorm, 16, 4, 6.0f},
+    {"ETC2 RGB", "etc2", CompressedPixelFormat::Etc2RGB8Unorm, 8, 3, 9.0f},
+    {"ETC2 RGBA", "etc2a", CompressedPixelFormat::Etc2RGBA8Unorm, 16, 4, 8.0f}
+};
+
+BlockCompressionImageConverterTest::BlockCompressionImageConverterTest() {
+    addInstancedTests({&BlockCompressionImageConverterTest::compress},
+        Containers::arraySize(CompressData));
+
+    addTests({&BlockCompressionImageConverterTest::compressUniform,
+              &BlockCompressionImageConverterTest::compressSrgb,
+              &BlockCompressionImageConverterTest::compressNonMultipleOfFour,
+              &BlockCompressionImageConverterTest::compressThreads,
+
+              &BlockCompressionImageConverterTest::unsupportedFormat,
+              &BlockCompressionImageConverterTest::unknownTargetFormat,
+              &BlockCompressionImageConverterTest::emptyImage,
+
+              &BlockCompressionImageConverterTest::exportToData});
+
+    /* Load the plugins directly from the build tree. Otherwise they're static
+       and already loaded. */
+    #if defined(MAGNUMIMAGECONVERTER_PLUGIN_FILENAME) && defined(BLOCKCOMPRESSIONIMAGECONVERTER_PLUGIN_FILENAME)
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(BLOCKCOMPRESSIONIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+/* A smooth image with each channel varying differently */
+Image2D smoothImage(const Vector2i& size) {
+    Image2D image{PixelFormat::RGBA8Unorm, size, Containers::Array<char>{Containers::NoInit, std::size_t(size.product()*4)}};
+    const Containers::StridedArrayView2D<Vector4ub> pixels = image.pixels<Vector4ub>();
+    for(Int y = 0; y != size.y(); ++y)
+        for(Int x = 0; x != size.x(); ++x)
+            for(Int c = 0; c != 4; ++c)
+                pixels[y][x][c] = UnsignedByte(127.5f + 127.5f*std::sin(x*0.04f*(c + 1) + y*0.03f*(3 - c) + c));
+    return image;
+}
+
+/* Minimal reference decoders, written directly from the format
+   specifications. Texels are in row-major order. */
+
+Vector3i unpackRgb565(const UnsignedInt color) {
+    const Int r = color >> 11 & 0x1f, g = color >> 5 & 0x3f, b = color & 0x1f;
+    return {(r << 3)|(r >> 2), (g << 2)|(g >> 4), (b << 3)|(b >> 2)};
+}
+
+void decodeBc1(const UnsignedByte* block, Vector4ub(&texels)[16]) {
+    const UnsignedInt c0 = block[0]|block[1] << 8;
+    const UnsignedInt c1 = block[2]|block[3] << 8;
+    Vector3i palette[4]{unpackRgb565(c0), unpackRgb565(c1)};
+    if(c0 > c1) {
+        palette[2] = (palette[0]*2 + palette[1])/3;
+        palette[3] = (palette[0] + palette[1]*2)/3;
+    } else palette[2] = (palette[0] + palette[1])/2;
+    for(std::size_t i = 0; i != 16; ++i) {
+        const UnsignedInt index = block[4 + i/4] >> 2*(i % 4) & 0x3;
+        texels[i] = {Vector3ub{palette[index]}, texels[i].a()};
+    }
+}
+
+void decodeBc4(const UnsignedByte* block, Vector4ub(&texels)[16], const std::size_t channel) {
+    const Int r0 = block[0], r1 = block[1];
+    Int palette[8]{r0, r1};
+    if(r0 > r1) for(Int i = 1; i != 7; ++i)
+        palette[i + 1] = ((7 - i)*r0 + i*r1)/7;
+    else {
+        for(Int i = 1; i != 5; ++i)
+            palette[i + 1] = ((5 - i)*r0 + i*r1)/5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    UnsignedLong bits = 0;
+    for(std::size_t i = 0; i != 6; ++i)
+        bits |= UnsignedLong(block[2 + i]) << 8*i;
+    for(std::size_t i = 0; i != 16; ++i)
+        texels[i][channel] = UnsignedByte(palette[bits >> 3*i & 0x7]);
+}
+
+void decodeBc7Mode6(const UnsignedByte* block, Vector4ub(&texels)[16]) {
+    std::size_t offset = 0;
+    const auto read = [&](UnsignedInt bits) {
+        UnsignedInt value = 0;
+        for(UnsignedInt i = 0; i != bits; ++i, ++offset)
+            value |= (block[offset/8] >> offset % 8 & 1) << i;
+        return value;
+    };
+    CORRADE_COMPARE(read(7), 1 << 6);
+    Vector4i e0, e1;
+    for(std::size_t c = 0; c != 4; ++c) {
+        e0[c] = read(7) << 1;
+        e1[c] = read(7) << 1;
+    }
+    e0 += Vector4i{Int(read(1))};
+    e1 += Vector4i{Int(read(1))};
+    constexpr Int Weights[]{0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+    for(std::size_t i = 0; i != 16; ++i) {
+        const Int w = Weights[read(i ? 4 : 3)];
+        texels[i] = Vector4ub{(e0*(64 - w) + e1*w + Vector4i{32})/64};
+    }
+}
+
+void decodeEtc1(const UnsignedByte* block, Vector4ub(&texels)[16]) {
+    constexpr Int Modifiers[8][2]{
+        {2, 8}, {5, 17}, {9, 29}, {13, 42},
+        {18, 60}, {24, 80}, {33, 106}, {47, 183}
+    };
+    const bool differential = block[3] & 0x2;
+    const bool flip = block[3] & 0x1;
+    const UnsignedInt tables[]{UnsignedInt(block[3] >> 5), UnsignedInt(block[3] >> 2 & 0x7)};
+    Vector3i base[2];
+    for(std::size_t c = 0; c != 3; ++c) {
+        if(differential) {
+            const Int first = block[c] >> 3;
+            /* Sign-extend the 3-bit delta. The encoder shouldn't produce
+               overflowing colors, which ETC2 would decode as other modes. */
+            const Int second = first + ((block[c] & 0x7) ^ 0x4) - 0x4;
+            CORRADE_VERIFY(second >= 0 && second < 32);
+            base[0][c] = (first << 3)|(first >> 2);
+            base[1][c] = (second << 3)|(second >> 2);
+        } else {
+            base[0][c] = (block[c] >> 4)*17;
+            base[1][c] = (block[c] & 0xf)*17;
+        }
+    }
+    const UnsignedInt msb = block[4] << 8|block[5];
+    const UnsignedInt lsb = block[6] << 8|block[7];
+    for(UnsignedInt y = 0; y != 4; ++y) {
+        for(UnsignedInt x = 0; x != 4; ++x) {
+            const UnsignedInt subblock = flip ? y/2 : x/2;
+            const UnsignedInt p = x*4 + y;
+            const Int modifier = Modifiers[tables[subblock]][lsb >> p & 1];
+            const Vector3i color = Math::clamp(base[subblock] + Vector3i{msb >> p & 1 ? -modifier : modifier}, 0, 255);
+            texels[y*4 + x] = {Vector3ub{color}, texels[y*4 + x].a()};
+        }
+    }
+}
+
+void decodeEacAlpha(const UnsignedByte* block, Vector4ub(&texels)[16]) {
+    constexpr Int Modifiers[16][8]{
+        {-3, -6, -9, -15, 2, 5, 8, 14},
+        {-3, -7, -10, -13, 2, 6, 9, 12},
+        {-2, -5, -8, -13, 1, 4, 7, 12},
+        {-2, -4, -6, -13, 1, 3, 5, 12},
+        {-3, -6, -8, -12, 2, 5, 7, 11},
+        {-3, -7, -9, -11, 2, 6, 8, 10},
+        {-4, -7, -8, -11, 3, 6, 7, 10},
+        {-3, -5, -8, -11, 2, 4, 7, 10},
+        {-2, -6, -8, -10, 1, 5, 7, 9},
+        {-2, -5, -8, -10, 1, 4, 7, 9},
+        {-2, -4, -8, -10, 1, 3, 7, 9},
+        {-2, -5, -7, -10, 1, 4, 6, 9},
+        {-3, -4, -7, -10, 2, 3, 6, 9},
+        {-1, -2, -3, -10, 0, 1, 2, 9},
+        {-4, -6, -8, -9, 3, 5, 7, 8},
+        {-3, -5, -7, -9, 2, 4, 6, 8}
+    };
+    const Int base = block[0];
+    const Int multiplier = block[1] >> 4;
+    const Int table = block[1] & 0xf;
+    UnsignedLong bits = 0;
+    for(std::size_t i = 0; i != 6; ++i)
+        bits = bits << 8|block[2 + i];
+    for(UnsignedInt y = 0; y != 4; ++y)
+        for(UnsignedInt x = 0; x != 4; ++x)
+            texels[y*4 + x].a() = UnsignedByte(Math::clamp(base + Modifiers[table][bits >> (45 - 3*(x*4 + y)) & 0x7]*multiplier, 0, 255));
+}
+
+void decodeBlock(const CompressedPixelFormat format, const UnsignedByte* block, Vector4ub(&texels)[16]) {
+    for(Vector4ub& texel: texels) texel = {0, 0, 0, 255};
+    switch(format) {
+        case CompressedPixelFormat::Bc1RGBUnorm:
+            return decodeBc1(block, texels);
+        case CompressedPixelFormat::Bc3RGBAUnorm:
+            decodeBc4(block, texels, 3);
+            return decodeBc1(block + 8, texels);
+        case CompressedPixelFormat::Bc4RUnorm:
+            return decodeBc4(block, texels, 0);
+        case CompressedPixelFormat::Bc5RGUnorm:
+            decodeBc4(block, texels, 0);
+            return decodeBc4(block + 8, texels, 1);
+        case CompressedPixelFormat::Bc7RGBAUnorm:
+            return decodeBc7Mode6(block, texels);
+        case CompressedPixelFormat::Etc2RGB8Unorm:
+            return decodeEtc1(block, texels);
+        case CompressedPixelFormat::Etc2RGBA8Unorm:
+            decodeEacAlpha(block, texels);
+            return decodeEtc1(block + 8, texels);
+        default: CORRADE_INTERNAL_ASSERT_UNREACHABLE();
+    }
+}
+
+void BlockCompressionImageConverterTest::compress() {
+    auto&& data = CompressData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    CORRADE_COMPARE(converter->features(), ImageConverterFeature::ConvertCompressedImage|ImageConverterFeature::ConvertData);
+    converter->configuration().setValue("format", data.format);
+
+    Image2D image = smoothImage({16, 16});
+    Containers::Optional<CompressedImage2D> compressed = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(compressed);
+    CORRADE_COMPARE(compressed->format(), data.expected);
+    CORRADE_COMPARE(compressed->size(), (Vector2i{16, 16}));
+    CORRADE_COMPARE(compressed->storage().compressedBlockSize(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE(compressed->storage().compressedBlockDataSize(), data.blockDataSize);
+    CORRADE_COMPARE(compressed->data().size(), 16*data.blockDataSize);
+
+    /* Decode back and calculate the RMSE over the channels the format
+       stores */
+    const Containers::StridedArrayView2D<const Vector4ub> pixels = image.pixels<Vector4ub>();
+    Float error = 0.0f;
+    for(std::size_t block = 0; block != 16; ++block) {
+        Vector4ub texels[16];
+        decodeBlock(data.expected, reinterpret_cast<const UnsignedByte*>(compressed->data() + block*data.blockDataSize), texels);
+        for(std::size_t i = 0; i != 16; ++i) {
+            const Vector4ub original = pixels[(block/4)*4 + i/4][(block % 4)*4 + i % 4];
+            for(std::size_t c = 0; c != data.channels; ++c)
+                error += Math::pow<2>(Float(texels[i][c]) - Float(original[c]));
+        }
+    }
+    error = std::sqrt(error/(256*data.channels));
+    CORRADE_COMPARE_AS(error, data.maxError, TestSuite::Compare::Less);
+}
+
+void BlockCompressionImageConverterTest::compressUniform() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    const Vector4ub pixels[16]{
+        {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37},
+        {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37},
+        {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37},
+        {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37}, {255, 0, 0, 37}
+    };
+    const ImageView2D image{PixelFormat::RGBA8Unorm, {4, 4}, pixels};
+
+    /* Both endpoints are pure red in RGB565, all indices zero */
+    converter->configuration().setValue("format", "bc1");
+    Containers::Optional<CompressedImage2D> bc1 = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(bc1);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(bc1->data()),
+        Containers::arrayView<UnsignedByte>({0x00, 0xf8, 0x00, 0xf8, 0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+
+    /* The alpha and RGB parts decode exactly */
+    converter->configuration().setValue("format", "bc3");
+    Containers::Optional<CompressedImage2D> bc3 = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(bc3);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(bc3->data()),
+        Containers::arrayView<UnsignedByte>({37, 37, 0, 0, 0, 0, 0, 0,
+            0x00, 0xf8, 0x00, 0xf8, 0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+
+    /* ETC2 alpha is exact as well */
+    converter->configuration().setValue("format", "etc2a");
+    Containers::Optional<CompressedImage2D> etc2a = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(etc2a);
+    Vector4ub texels[16];
+    decodeBlock(CompressedPixelFormat::Etc2RGBA8Unorm, reinterpret_cast<const UnsignedByte*>(etc2a->data().data()), texels);
+    for(const Vector4ub& texel: texels) CORRADE_COMPARE(texel.a(), 37);
+}
+
+void BlockCompressionImageConverterTest::compressSrgb() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    Image2D image = smoothImage({4, 4});
+    const ImageView2D srgb{PixelFormat::RGBA8Srgb, image.size(), image.data()};
+
+    converter->configuration().setValue("format", "bc7");
+    Containers::Optional<CompressedImage2D> bc7 = converter->exportToCompressedImage(srgb);
+    CORRADE_VERIFY(bc7);
+    CORRADE_COMPARE(bc7->format(), CompressedPixelFormat::Bc7RGBASrgb);
+
+    /* The data are compressed as-is */
+    Containers::Optional<CompressedImage2D> bc7Unorm = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(bc7Unorm);
+    CORRADE_COMPARE_AS(bc7->data(), bc7Unorm->data(), TestSuite::Compare::Container);
+
+    /* BC4 has no sRGB variant */
+    converter->configuration().setValue("format", "bc4");
+    Containers::Optional<CompressedImage2D> bc4 = converter->exportToCompressedImage(srgb);
+    CORRADE_VERIFY(bc4);
+    CORRADE_COMPARE(bc4->format(), CompressedPixelFormat::Bc4RUnorm);
+}
+
+void BlockCompressionImageConverterTest::compressNonMultipleOfFour() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->configuration().setValue("format", "bc4");
+
+    /* A 5x3 R8 image with rows padded to four bytes. The last column and
+       row get repeated, so the second block has all values the same. */
+    const UnsignedByte pixels[]{
+        0, 10, 20, 30, 200, 0, 0, 0,
+        0, 10, 20, 30, 200, 0, 0, 0,
+        0, 10, 20, 30, 200, 0, 0, 0
+    };
+    Containers::Optional<CompressedImage2D> compressed = converter->exportToCompressedImage(ImageView2D{PixelFormat::R8Unorm, {5, 3}, pixels});
+    CORRADE_VERIFY(compressed);
+    CORRADE_COMPARE(compressed->size(), (Vector2i{5, 3}));
+    CORRADE_COMPARE(compressed->data().size(), 16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedByte>(compressed->data().suffix(8)),
+        Containers::arrayView<UnsignedByte>({200, 200, 0, 0, 0, 0, 0, 0}),
+        TestSuite::Compare::Container);
+
+    /* The first block has the full range */
+    CORRADE_COMPARE(UnsignedByte(compressed->data()[0]), 30);
+    CORRADE_COMPARE(UnsignedByte(compressed->data()[1]), 0);
+}
+
+void BlockCompressionImageConverterTest::compressThreads() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->configuration().setValue("format", "bc7");
+
+    Image2D image = smoothImage({256, 128});
+    Containers::Optional<CompressedImage2D> single = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(single);
+
+    converter->configuration().setValue("threads", 0);
+    Containers::Optional<CompressedImage2D> threaded = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(threaded);
+    CORRADE_COMPARE_AS(threaded->data(), single->data(), TestSuite::Compare::Container);
+}
+
+void BlockCompressionImageConverterTest::unsupportedFormat() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    const char data[8]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->exportToCompressedImage(ImageView2D{PixelFormat::RG16F, {1, 1}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::exportToCompressedImage(): unsupported format PixelFormat::RG16F\n");
+}
+
+void BlockCompressionImageConverterTest::unknownTargetFormat() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->configuration().setValue("format", "bc6h");
+
+    const char data[4]{};
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->exportToData(ImageView2D{PixelFormat::RGBA8Unorm, {1, 1}, data}));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::exportToData(): unsupported target format bc6h\n");
+}
+
+void BlockCompressionImageConverterTest::emptyImage() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!converter->exportToCompressedImage(ImageView2D{PixelFormat::RGBA8Unorm, {0, 4}, nullptr}));
+    CORRADE_COMPARE(out.str(), "Trade::BlockCompressionImageConverter::exportToCompressedImage(): can't compress an empty image\n");
+}
+
+void BlockCompressionImageConverterTest::exportToData() {
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("BlockCompressionImageConverter");
+    converter->configuration().setValue("format", "bc7");
+    converter->configuration().setValue("level", 2);
+
+    Image2D image = smoothImage({8, 4});
+    Containers::Array<char> data = converter->exportToData(image);
+    CORRADE_VERIFY(data);
+
+    const auto& header = *reinterpret_cast<const Implementation::Image2DBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.flags, UnsignedInt(Implementation::ImageBlobFlagCompressed));
+    CORRADE_COMPARE(header.level, 2);
+    CORRADE_COMPARE(CompressedPixelFormat(header.format), CompressedPixelFormat::Bc7RGBAUnorm);
+    CORRADE_COMPARE(header.size[0], 8);
+    CORRADE_COMPARE(header.size[1], 4);
+    CORRADE_COMPARE(header.compressedBlockDataSize, 16);
+    CORRADE_COMPARE(header.dataSize, 32);
+
+    /* The payload is the same as when compressing directly */
+    Containers::Optional<CompressedImage2D> compressed = converter->exportToCompressedImage(image);
+    CORRADE_VERIFY(compressed);
+    CORRADE_COMPARE_AS(data.slice(header.dataOffset, header.dataOffset + header.dataSize),
+        compressed->data(),
+        TestSuite::Compare::Container);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::BlockCompressionImageConverterTest)
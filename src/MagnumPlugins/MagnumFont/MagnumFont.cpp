@@ -25,17 +25,24 @@
 
 #include "MagnumFont.h"
 
+#include <algorithm>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringStl.h>
 #include <Corrade/Utility/Configuration.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/Unicode.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/GL/TextureFormat.h"
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/GlyphCache.h"
 #include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
 #include "MagnumPlugins/TgaImporter/TgaImporter.h"
 
 namespace Magnum { namespace Text {
@@ -51,6 +58,11 @@ struct MagnumFont::Data {
     Containers::Optional<std::string> filePath;
     std::unordered_map<char32_t, UnsignedInt> glyphId;
     std::vector<Vector2> glyphAdvance;
+
+    /* Used only by the binary variant, the image references the blob
+       memory */
+    Containers::Array<char> blob;
+    Containers::ArrayView<const Trade::Implementation::FontGlyphBlob> glyphs;
 };
 
 namespace {
@@ -58,13 +70,18 @@ namespace {
         public:
             explicit MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize, std::vector<UnsignedInt>&& glyphs);
 
+            /* Used by MagnumFont::doRelayout(), reusing the glyph storage */
+            void reset(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, Float fontSize, Float textSize);
+            std::vector<UnsignedInt>& glyphs() { return _glyphs; }
+
         private:
             std::tuple<Range2D, Range2D, Vector2> doRenderGlyph(UnsignedInt i) override;
+            void doRenderGlyphs(UnsignedInt offset, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances) override;
 
-            const std::vector<Vector2>& glyphAdvance;
-            const AbstractGlyphCache& cache;
-            const Float fontSize, textSize;
-            const std::vector<UnsignedInt> glyphs;
+            const std::vector<Vector2>* _glyphAdvance;
+            const AbstractGlyphCache* _cache;
+            Float _fontSize, _textSize;
+            std::vector<UnsignedInt> _glyphs;
     };
 }
 
@@ -80,9 +97,172 @@ bool MagnumFont::doIsOpened() const { return _opened && _opened->image; }
 
 void MagnumFont::doClose() { _opened = nullptr; }
 
+namespace {
+
+/* Used to check that the enum values are known, as builtin functions would
+   assert on them otherwise */
+constexpr UnsignedInt PixelFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/pixelFormatMapping.hpp"
+    #undef _c
+    ;
+constexpr UnsignedInt CompressedPixelFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/compressedPixelFormatMapping.hpp"
+    #undef _c
+    ;
+
+/* Checks that the blob at given offset has a valid header with given type and
+   is in bounds */
+bool validateBlob(const Containers::ArrayView<const char> data, const std::size_t offset, const Trade::Implementation::BlobType type, const std::size_t headerSize) {
+    if(data.size() - offset < headerSize) {
+        Error{} << "Text::MagnumFont::openData(): expected at least" << headerSize << "bytes for a blob header at offset" << offset << "but got" << data.size() - offset;
+        return false;
+    }
+
+    const auto& header = *reinterpret_cast<const Trade::Implementation::BlobHeader*>(data.data() + offset);
+    if(!std::equal(header.magic, header.magic + 4, Trade::Implementation::BlobMagic)) {
+        Error{} << "Text::MagnumFont::openData(): invalid blob signature at offset" << offset;
+        return false;
+    }
+    if(header.endianness != Trade::Implementation::BlobEndianness) {
+        Error{} << "Text::MagnumFont::openData(): blob at offset" << offset << "has a different endianness";
+        return false;
+    }
+    if(header.version != Trade::Implementation::BlobVersion) {
+        Error{} << "Text::MagnumFont::openData(): unsupported blob version" << header.version << "at offset" << offset << Debug::nospace << ", expected" << Trade::Implementation::BlobVersion;
+        return false;
+    }
+    if(header.type != type) {
+        Error{} << "Text::MagnumFont::openData(): expected blob type" << UnsignedInt(type) << "at offset" << offset << "but got" << UnsignedInt(header.type);
+        return false;
+    }
+    if(header.size < headerSize || header.size > data.size() - offset) {
+        Error{} << "Text::MagnumFont::openData(): blob at offset" << offset << "has an invalid size" << header.size << "for" << data.size() - offset << "remaining bytes";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+auto MagnumFont::openBinaryData(const Containers::ArrayView<const char> data) -> Metrics {
+    /* Font blob with glyph and character data */
+    if(!validateBlob(data, 0, Trade::Implementation::BlobType::Font, sizeof(Trade::Implementation::FontBlobHeader)))
+        return {};
+    const auto& header = *reinterpret_cast<const Trade::Implementation::FontBlobHeader*>(data.data());
+    if(header.glyphOffset > header.header.size || (header.header.size - header.glyphOffset)/sizeof(Trade::Implementation::FontGlyphBlob) < header.glyphCount ||
+       header.characterOffset > header.header.size || (header.header.size - header.characterOffset)/sizeof(Trade::Implementation::FontCharacterBlob) < header.characterCount) {
+        Error{} << "Text::MagnumFont::openData(): font blob has glyph or character data out of bounds";
+        return {};
+    }
+    if(!header.glyphCount) {
+        Error{} << "Text::MagnumFont::openData(): font blob has no glyphs";
+        return {};
+    }
+
+    /* Image blob with the glyph cache image directly after */
+    const std::size_t imageOffset = header.header.size;
+    if(!validateBlob(data, imageOffset, Trade::Implementation::BlobType::Image2D, sizeof(Trade::Implementation::Image2DBlobHeader)))
+        return {};
+    const auto& imageHeader = *reinterpret_cast<const Trade::Implementation::Image2DBlobHeader*>(data.data() + imageOffset);
+    if(imageHeader.dataOffset > imageHeader.header.size || imageHeader.dataSize > imageHeader.header.size - imageHeader.dataOffset) {
+        Error{} << "Text::MagnumFont::openData(): image blob has data out of bounds";
+        return {};
+    }
+    if(imageHeader.flags & ~Trade::Implementation::ImageBlobFlagCompressed || imageHeader.level) {
+        Error{} << "Text::MagnumFont::openData(): expected a single-level image blob";
+        return {};
+    }
+    if(imageHeader.size[0] < 0 || imageHeader.size[1] < 0 ||
+       imageHeader.rowLength < 0 || imageHeader.imageHeight < 0 ||
+       imageHeader.skip[0] < 0 || imageHeader.skip[1] < 0 ||
+       imageHeader.skip[2] < 0 || imageHeader.compressedBlockSize[0] < 0 ||
+       imageHeader.compressedBlockSize[1] < 0 ||
+       imageHeader.compressedBlockSize[2] < 0 ||
+       imageHeader.compressedBlockDataSize < 0) {
+        Error{} << "Text::MagnumFont::openData(): image blob has an invalid size or storage";
+        return {};
+    }
+    /* Implementation-specific formats can't be mapped to a GL texture format,
+       so allow only the generic ones */
+    if(imageHeader.flags & Trade::Implementation::ImageBlobFlagCompressed) {
+        if(!imageHeader.format || imageHeader.format > CompressedPixelFormatCount) {
+            Error{} << "Text::MagnumFont::openData(): image blob has an invalid format" << CompressedPixelFormat(imageHeader.format);
+            return {};
+        }
+    } else {
+        const PixelFormat format = PixelFormat(imageHeader.format);
+        if(!imageHeader.format || imageHeader.format > PixelFormatCount || imageHeader.pixelSize != pixelSize(format) || (imageHeader.alignment != 1 && imageHeader.alignment != 2 && imageHeader.alignment != 4 && imageHeader.alignment != 8)) {
+            Error{} << "Text::MagnumFont::openData(): image blob has an invalid format" << format;
+            return {};
+        }
+
+        /* The same check as done in the ImageData constructor */
+        const std::size_t expectedDataSize = Magnum::Implementation::imageDataSize(ImageView2D{
+            PixelStorage{}
+                .setAlignment(imageHeader.alignment)
+                .setRowLength(imageHeader.rowLength)
+                .setImageHeight(imageHeader.imageHeight)
+                .setSkip({imageHeader.skip[0], imageHeader.skip[1], imageHeader.skip[2]}),
+            format, 0, imageHeader.pixelSize,
+            {imageHeader.size[0], imageHeader.size[1]}});
+        if(imageHeader.dataSize < expectedDataSize) {
+            Error{} << "Text::MagnumFont::openData(): image blob has" << imageHeader.dataSize << "bytes of data but expected at least" << expectedDataSize;
+            return {};
+        }
+    }
+
+    /* Everything okay. Copy the data as they're not guaranteed to stay in
+       scope, but otherwise reference everything directly. */
+    _opened->blob = Containers::Array<char>{Containers::NoInit, data.size()};
+    std::copy(data.begin(), data.end(), _opened->blob.begin());
+    const char* const blob = _opened->blob.data();
+    _opened->glyphs = {reinterpret_cast<const Trade::Implementation::FontGlyphBlob*>(blob + header.glyphOffset), header.glyphCount};
+
+    /* Glyph advances */
+    _opened->glyphAdvance.reserve(header.glyphCount);
+    for(const Trade::Implementation::FontGlyphBlob& glyph: _opened->glyphs)
+        _opened->glyphAdvance.emplace_back(glyph.advance[0], glyph.advance[1]);
+
+    /* Fill character->glyph map */
+    const Containers::ArrayView<const Trade::Implementation::FontCharacterBlob> characters{reinterpret_cast<const Trade::Implementation::FontCharacterBlob*>(blob + header.characterOffset), header.characterCount};
+    _opened->glyphId.reserve(characters.size());
+    for(const Trade::Implementation::FontCharacterBlob& character: characters)
+        _opened->glyphId.emplace(character.character, character.glyph < header.glyphCount ? character.glyph : 0);
+
+    /* The image data reference the blob memory */
+    const Containers::ArrayView<const char> imageData{blob + imageOffset + imageHeader.dataOffset, std::size_t(imageHeader.dataSize)};
+    const Vector2i size{imageHeader.size[0], imageHeader.size[1]};
+    if(imageHeader.flags & Trade::Implementation::ImageBlobFlagCompressed) {
+        _opened->image.emplace(CompressedPixelStorage{}
+            .setRowLength(imageHeader.rowLength)
+            .setImageHeight(imageHeader.imageHeight)
+            .setSkip({imageHeader.skip[0], imageHeader.skip[1], imageHeader.skip[2]})
+            .setCompressedBlockSize({imageHeader.compressedBlockSize[0], imageHeader.compressedBlockSize[1], imageHeader.compressedBlockSize[2]})
+            .setCompressedBlockDataSize(imageHeader.compressedBlockDataSize),
+            CompressedPixelFormat(imageHeader.format), size, Trade::DataFlags{}, imageData);
+    } else {
+        _opened->image.emplace(PixelStorage{}
+            .setAlignment(imageHeader.alignment)
+            .setRowLength(imageHeader.rowLength)
+            .setImageHeight(imageHeader.imageHeight)
+            .setSkip({imageHeader.skip[0], imageHeader.skip[1], imageHeader.skip[2]}),
+            PixelFormat(imageHeader.format), size, Trade::DataFlags{}, imageData);
+    }
+
+    return {header.size, header.ascent, header.descent, header.lineHeight};
+}
+
 auto MagnumFont::doOpenData(const Containers::ArrayView<const char> data, const Float) -> Metrics {
     if(!_opened) _opened.emplace();
 
+    /* The binary variant is self-contained, so it doesn't need a file path or
+       a file callback */
+    if(data.size() >= 4 && std::equal(data.begin(), data.begin() + 4, Trade::Implementation::BlobMagic))
+        return openBinaryData(data);
+
     if(!_opened->filePath && !fileCallback()) {
         Error{} << "Text::MagnumFont::openData(): the font can be opened only from the filesystem or if a file callback is present";
         return {};
@@ -152,6 +332,35 @@ Vector2 MagnumFont::doGlyphAdvance(const UnsignedInt glyph) {
 }
 
 Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
+    /* The binary variant uploads the image directly from the blob memory, in
+       whatever format it is */
+    if(_opened->blob) {
+        const auto& header = *reinterpret_cast<const Trade::Implementation::FontBlobHeader*>(_opened->blob.data());
+        const Vector2i originalImageSize{header.originalImageSize[0], header.originalImageSize[1]};
+        const Vector2i padding{header.padding[0], header.padding[1]};
+
+        Containers::Pointer<AbstractGlyphCache> cache;
+        if(_opened->image->isCompressed()) {
+            cache.reset(new Text::GlyphCache(GL::textureFormat(_opened->image->compressedFormat()), originalImageSize, _opened->image->size(), padding));
+            /* AbstractGlyphCache::setImage() doesn't support compressed
+               images, so upload to the texture directly */
+            static_cast<Text::GlyphCache&>(*cache).texture().setCompressedSubImage(0, {}, CompressedImageView2D{*_opened->image});
+        } else {
+            cache.reset(new Text::GlyphCache(GL::textureFormat(_opened->image->format()), originalImageSize, _opened->image->size(), padding));
+            cache->setImage({}, *_opened->image);
+        }
+
+        /* Fill glyph map */
+        for(std::size_t i = 0; i != _opened->glyphs.size(); ++i) {
+            const Trade::Implementation::FontGlyphBlob& glyph = _opened->glyphs[i];
+            cache->insert(i, {glyph.position[0], glyph.position[1]},
+                {{glyph.rectangle[0], glyph.rectangle[1]},
+                 {glyph.rectangle[2], glyph.rectangle[3]}});
+        }
+
+        return cache;
+    }
+
     /* Set cache image */
     Containers::Pointer<AbstractGlyphCache> cache(new Text::GlyphCache(
         _opened->conf.value<Vector2i>("originalImageSize"),
@@ -167,46 +376,87 @@ Containers::Pointer<AbstractGlyphCache> MagnumFont::doCreateGlyphCache() {
     return cache;
 }
 
-Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) {
+void MagnumFont::glyphsInto(const Containers::StringView text, std::vector<UnsignedInt>& glyphs) const {
     /* Get glyph codes from characters */
-    std::vector<UnsignedInt> glyphs;
+    glyphs.clear();
     glyphs.reserve(text.size());
     for(std::size_t i = 0; i != text.size(); ) {
         UnsignedInt codepoint;
-        std::tie(codepoint, i) = Utility::Unicode::nextChar(text, i);
+        std::tie(codepoint, i) = Utility::Unicode::nextChar(Containers::ArrayView<const char>{text.data(), text.size()}, i);
         const auto it = _opened->glyphId.find(codepoint);
         glyphs.push_back(it == _opened->glyphId.end() ? 0 : it->second);
     }
+}
 
+Containers::Pointer<AbstractLayouter> MagnumFont::doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) {
+    std::vector<UnsignedInt> glyphs;
+    glyphsInto(text, glyphs);
     return Containers::Pointer<MagnumFontLayouter>(new MagnumFontLayouter(_opened->glyphAdvance, cache, this->size(), size, std::move(glyphs)));
 }
 
+bool MagnumFont::doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache& cache, Float size, const Containers::StringView text) {
+    /* The font could have been reopened since, so update everything */
+    auto& magnumFontLayouter = static_cast<MagnumFontLayouter&>(layouter);
+    glyphsInto(text, magnumFontLayouter.glyphs());
+    magnumFontLayouter.reset(_opened->glyphAdvance, cache, this->size(), size);
+    return true;
+}
+
 namespace {
 
-MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), glyphAdvance(glyphAdvance), cache(cache), fontSize(fontSize), textSize(textSize), glyphs(std::move(glyphs)) {}
+MagnumFontLayouter::MagnumFontLayouter(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize, std::vector<UnsignedInt>&& glyphs): AbstractLayouter(glyphs.size()), _glyphAdvance{&glyphAdvance}, _cache{&cache}, _fontSize{fontSize}, _textSize{textSize}, _glyphs(std::move(glyphs)) {}
+
+void MagnumFontLayouter::reset(const std::vector<Vector2>& glyphAdvance, const AbstractGlyphCache& cache, const Float fontSize, const Float textSize) {
+    _glyphAdvance = &glyphAdvance;
+    _cache = &cache;
+    _fontSize = fontSize;
+    _textSize = textSize;
+    setGlyphCount(_glyphs.size());
+}
 
 std::tuple<Range2D, Range2D, Vector2> MagnumFontLayouter::doRenderGlyph(const UnsignedInt i) {
+    const AbstractGlyphCache& cache = *_cache;
+
     /* Position of the texture in the resulting glyph, texture coordinates */
     Vector2i position;
     Range2Di rectangle;
-    std::tie(position, rectangle) = cache[glyphs[i]];
+    std::tie(position, rectangle) = cache[_glyphs[i]];
 
     /* Normalized texture coordinates */
     const auto textureCoordinates = Range2D(rectangle).scaled(1.0f/Vector2(cache.textureSize()));
 
     /* Quad rectangle, computed from texture rectangle, denormalized to
        requested text size */
-    const auto quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(textSize/fontSize));
+    const auto quadRectangle = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(Vector2(_textSize/_fontSize));
 
     /* Advance for given glyph, denormalized to requested text size */
-    const Vector2 advance = glyphAdvance[glyphs[i]]*(textSize/fontSize);
+    const Vector2 advance = (*_glyphAdvance)[_glyphs[i]]*(_textSize/_fontSize);
 
     return std::make_tuple(quadRectangle, textureCoordinates, advance);
 }
 
+void MagnumFontLayouter::doRenderGlyphs(const UnsignedInt offset, const Containers::StridedArrayView1D<Range2D>& quadPositions, const Containers::StridedArrayView1D<Range2D>& textureCoordinates, const Containers::StridedArrayView1D<Vector2>& advances) {
+    const AbstractGlyphCache& cache = *_cache;
+
+    /* Same as doRenderGlyph(), with the scaling factors calculated just
+       once */
+    const Vector2 textureScale = 1.0f/Vector2(cache.textureSize());
+    const Vector2 quadScale{_textSize/_fontSize};
+    for(std::size_t i = 0; i != quadPositions.size(); ++i) {
+        const UnsignedInt glyph = _glyphs[offset + i];
+        Vector2i position;
+        Range2Di rectangle;
+        std::tie(position, rectangle) = cache[glyph];
+
+        textureCoordinates[i] = Range2D(rectangle).scaled(textureScale);
+        quadPositions[i] = Range2D(Range2Di::fromSize(position, rectangle.size())).scaled(quadScale);
+        advances[i] = (*_glyphAdvance)[glyph]*quadScale;
+    }
+}
+
 }
 
 }}
 
 CORRADE_PLUGIN_REGISTER(MagnumFont, Magnum::Text::MagnumFont,
-    "cz.mosra.magnum.Text.AbstractFont/0.3")
+    "cz.mosra.magnum.Text.AbstractFont/0.3.2")
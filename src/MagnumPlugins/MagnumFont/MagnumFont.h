@@ -116,6 +116,22 @@ rectangle=45 0 44 25
 # ...
 @endcode
 
+@section Text-MagnumFont-binary Binary variant
+
+Besides the above, the plugin can open a single-file binary variant, produced
+by @ref MagnumFontConverter with the @cb{.ini} binary @ce
+@ref Text-MagnumFontConverter-configuration "configuration option" enabled.
+The file is recognized by its signature, so it can be opened with both
+@ref openFile() and @ref openData() and doesn't need any file callback. It
+contains the same font properties, glyph and character data in a packed form,
+followed by the glyph cache image in the blob format used by
+@ref Trade::MagnumImporter "MagnumImporter", which can be either
+uncompressed or compressed. No text parsing or image decoding is done on
+opening, the data are only validated and copied, and @ref createGlyphCache()
+uploads the image directly from the file memory in whatever format it's
+stored in. Compressed images need the GL driver to support given compressed
+texture format.
+
 @section Text-MagnumFont-usage Usage
 
 This plugin depends on the @ref Text library and the
@@ -173,6 +189,10 @@ class MAGNUM_MAGNUMFONT_EXPORT MagnumFont: public AbstractFont {
         MAGNUM_MAGNUMFONT_LOCAL Vector2 doGlyphAdvance(UnsignedInt glyph) override;
         MAGNUM_MAGNUMFONT_LOCAL Containers::Pointer<AbstractGlyphCache> doCreateGlyphCache() override;
         MAGNUM_MAGNUMFONT_LOCAL Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache& cache, Float size, const std::string& text) override;
+        MAGNUM_MAGNUMFONT_LOCAL bool doRelayout(AbstractLayouter& layouter, const AbstractGlyphCache& cache, Float size, Containers::StringView text) override;
+
+        MAGNUM_MAGNUMFONT_LOCAL Metrics openBinaryData(Containers::ArrayView<const char> data);
+        MAGNUM_MAGNUMFONT_LOCAL void glyphsInto(Containers::StringView text, std::vector<UnsignedInt>& glyphs) const;
 
         struct Data;
         Containers::Pointer<Data> _opened;
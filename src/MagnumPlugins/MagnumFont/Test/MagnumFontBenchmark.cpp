@@ -0,0 +1,200 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <tuple>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Text/AbstractFont.h"
+#include "Magnum/Text/AbstractGlyphCache.h"
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Text { namespace Test { namespace {
+
+struct MagnumFontBenchmark: TestSuite::Tester {
+    explicit MagnumFontBenchmark();
+
+    void layout();
+    void relayout();
+    void renderGlyph();
+    void renderGlyphs();
+
+    private:
+        Containers::Pointer<AbstractFont> openFont();
+        std::string text() const;
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
+        PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    std::size_t length;
+} TextData[]{
+    {"16 characters", 16},
+    {"256 characters", 256},
+    {"4k characters", 4096},
+    {"64k characters", 65536}
+};
+
+struct DummyGlyphCache: AbstractGlyphCache {
+    using AbstractGlyphCache::AbstractGlyphCache;
+
+    GlyphCacheFeatures doFeatures() const override { return {}; }
+    void doSetImage(const Vector2i&, const ImageView2D&) override {}
+};
+
+MagnumFontBenchmark::MagnumFontBenchmark() {
+    addInstancedBenchmarks({&MagnumFontBenchmark::layout,
+                            &MagnumFontBenchmark::relayout,
+                            &MagnumFontBenchmark::renderGlyph,
+                            &MagnumFontBenchmark::renderGlyphs}, 10,
+        Containers::arraySize(TextData));
+
+    /* Load the plugins directly from the build tree. Otherwise they're static
+       and already loaded. */
+    _fontManager.registerExternalManager(_importerManager);
+    #if defined(TGAIMPORTER_PLUGIN_FILENAME) && defined(MAGNUMFONT_PLUGIN_FILENAME)
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_fontManager.load(MAGNUMFONT_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+Containers::Pointer<AbstractFont> MagnumFontBenchmark::openFont() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+    CORRADE_INTERNAL_ASSERT_OUTPUT(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+    return font;
+}
+
+/* Repeats the word from the test font until the requested length, so both
+   glyphs that are in the cache and glyphs that aren't get exercised */
+std::string MagnumFontBenchmark::text() const {
+    const std::size_t length = TextData[testCaseInstanceId()].length;
+    std::string out;
+    out.reserve(length);
+    for(std::size_t i = 0; i != length; ++i) out += "Wave "[i % 5];
+    return out;
+}
+
+void MagnumFontBenchmark::layout() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = openFont();
+    DummyGlyphCache cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+    const std::string text = this->text();
+
+    Containers::Pointer<AbstractLayouter> layouter;
+    CORRADE_BENCHMARK(1)
+        layouter = font->layout(cache, 0.5f, text);
+
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), UnsignedInt(data.length));
+}
+
+void MagnumFontBenchmark::relayout() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = openFont();
+    DummyGlyphCache cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+    const std::string text = this->text();
+
+    /* Lay out once so the measured call only refills the existing storage */
+    Containers::Pointer<AbstractLayouter> layouter;
+    font->layout(cache, 0.5f, text, layouter);
+
+    CORRADE_BENCHMARK(1)
+        font->layout(cache, 0.5f, text, layouter);
+
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), UnsignedInt(data.length));
+}
+
+void MagnumFontBenchmark::renderGlyph() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = openFont();
+    DummyGlyphCache cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+    Containers::Pointer<AbstractLayouter> layouter = font->layout(cache, 0.5f, text());
+
+    Containers::Array<Range2D> positions{Containers::NoInit, data.length};
+    Containers::Array<Range2D> textureCoordinates{Containers::NoInit, data.length};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    CORRADE_BENCHMARK(1) {
+        cursorPosition = {};
+        rectangle = {};
+        for(UnsignedInt i = 0; i != layouter->glyphCount(); ++i) {
+            Vector2 advance;
+            std::tie(positions[i], textureCoordinates[i]) = layouter->renderGlyph(i, advance, rectangle);
+            positions[i] = positions[i].translated(cursorPosition);
+            cursorPosition += advance;
+        }
+    }
+
+    CORRADE_COMPARE(positions[0], Range2D({0.78125f, 1.0625f}, {1.28125f, 4.8125f}));
+}
+
+void MagnumFontBenchmark::renderGlyphs() {
+    auto&& data = TextData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractFont> font = openFont();
+    DummyGlyphCache cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+    Containers::Pointer<AbstractLayouter> layouter = font->layout(cache, 0.5f, text());
+
+    Containers::Array<Range2D> positions{Containers::NoInit, data.length};
+    Containers::Array<Range2D> textureCoordinates{Containers::NoInit, data.length};
+    Containers::Array<Vector2> advances{Containers::NoInit, data.length};
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    CORRADE_BENCHMARK(1) {
+        cursorPosition = {};
+        rectangle = {};
+        layouter->renderGlyphs(0, cursorPosition, rectangle, positions, textureCoordinates, advances);
+    }
+
+    CORRADE_COMPARE(positions[0], Range2D({0.78125f, 1.0625f}, {1.28125f, 4.8125f}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontBenchmark)
@@ -39,6 +39,7 @@ struct MagnumFontGLTest: GL::OpenGLTester {
     explicit MagnumFontGLTest();
 
     void createGlyphCache();
+    void createGlyphCacheBinary();
 
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
@@ -46,7 +47,8 @@ struct MagnumFontGLTest: GL::OpenGLTester {
 };
 
 MagnumFontGLTest::MagnumFontGLTest() {
-    addTests({&MagnumFontGLTest::createGlyphCache});
+    addTests({&MagnumFontGLTest::createGlyphCache,
+              &MagnumFontGLTest::createGlyphCacheBinary});
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -72,6 +74,23 @@ void MagnumFontGLTest::createGlyphCache() {
     /** @todo properly test contents */
 }
 
+void MagnumFontGLTest::createGlyphCacheBinary() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.blob"), 0.0f));
+
+    Containers::Pointer<AbstractGlyphCache> cache = font->createGlyphCache();
+
+    MAGNUM_VERIFY_NO_GL_ERROR();
+    CORRADE_VERIFY(cache);
+    CORRADE_COMPARE(cache->textureSize(), Vector2i{1536});
+    CORRADE_COMPARE(cache->padding(), Vector2i{24});
+    CORRADE_COMPARE(cache->glyphCount(), 3);
+    CORRADE_COMPARE((*cache)[2].first, (Vector2i{25, 34} - Vector2i{24}));
+
+    /** @todo properly test contents */
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontGLTest)
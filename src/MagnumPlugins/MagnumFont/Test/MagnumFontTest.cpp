@@ -26,9 +26,12 @@
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/StridedArrayView.h>
+#include <Corrade/Containers/StringView.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/FileCallback.h"
 #include "Magnum/Text/AbstractFont.h"
@@ -45,22 +48,57 @@ struct MagnumFontTest: TestSuite::Tester {
     void nonexistent();
     void properties();
     void layout();
+    void layoutBatch();
+    void relayout();
 
     void fileCallbackImage();
     void fileCallbackImageNotFound();
 
+    void binary();
+    void binaryInvalid();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<Trade::AbstractImporter> _importerManager{"nonexistent"};
     PluginManager::Manager<AbstractFont> _fontManager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    std::size_t size;
+    std::size_t offset;
+    char value;
+    const char* message;
+} BinaryInvalidData[]{
+    {"too short", 32, 0, 'M',
+        "expected at least 72 bytes for a blob header at offset 0 but got 32"},
+    {"different endianness", 0, 6, '\x01',
+        "blob at offset 0 has a different endianness"},
+    {"glyph data out of bounds", 0, 48, '\x64',
+        "font blob has glyph or character data out of bounds"},
+    {"no image", 208, 0, 'M',
+        "expected at least 104 bytes for a blob header at offset 208 but got 0"},
+    {"not an image", 0, 208 + 5, '\x01',
+        "expected blob type 2 at offset 208 but got 1"},
+    {"image with multiple levels", 0, 208 + 20, '\x01',
+        "expected a single-level image blob"},
+    {"image data too short", 0, 208 + 96, '\x04',
+        "image blob has 4 bytes of data but expected at least 6"}
+};
+
 MagnumFontTest::MagnumFontTest() {
     addTests({&MagnumFontTest::nonexistent,
               &MagnumFontTest::properties,
               &MagnumFontTest::layout,
+              &MagnumFontTest::layoutBatch,
+              &MagnumFontTest::relayout,
 
               &MagnumFontTest::fileCallbackImage,
-              &MagnumFontTest::fileCallbackImageNotFound});
+              &MagnumFontTest::fileCallbackImageNotFound,
+
+              &MagnumFontTest::binary});
+
+    addInstancedTests({&MagnumFontTest::binaryInvalid},
+        Containers::arraySize(BinaryInvalidData));
 
     /* Load the plugins directly from the build tree. Otherwise they're static
        and already loaded. */
@@ -140,6 +178,93 @@ void MagnumFontTest::layout() {
     CORRADE_COMPARE(cursorPosition, Vector2(0.375f, 0.0f));
 }
 
+void MagnumFontTest::layoutBatch() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+
+    /* Same as in layout() */
+    struct DummyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    auto layouter = font->layout(cache, 0.5f, "Wave");
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 4);
+
+    Range2D positions[4];
+    Range2D textureCoordinates[4];
+    Vector2 advances[4];
+    Vector2 cursorPosition;
+    Range2D rectangle;
+    layouter->renderGlyphs(0, cursorPosition, rectangle, positions, textureCoordinates, advances);
+
+    /* The quads are moved to the cursor position, unlike in layout() where
+       the cursor is reset for each glyph */
+    CORRADE_COMPARE(positions[0], Range2D({0.78125f, 1.0625f}, {1.28125f, 4.8125f}));
+    CORRADE_COMPARE(positions[1], Range2D({0.71875f, 0.0f}, {0.71875f, 0.0f}));
+    CORRADE_COMPARE(positions[2], Range2D({0.96875f, 0.0f}, {0.96875f, 0.0f}));
+    CORRADE_COMPARE(positions[3], Range2D({2.0f, 0.375f}, {3.5f, 1.25f}));
+    CORRADE_COMPARE(textureCoordinates[0], Range2D({0, 0.03125f}, {0.0625f, 0.5f}));
+    CORRADE_COMPARE(textureCoordinates[1], Range2D());
+    CORRADE_COMPARE(textureCoordinates[2], Range2D());
+    CORRADE_COMPARE(textureCoordinates[3], Range2D({0.0625f, 0.015625f}, {0.25f, 0.125f}));
+    CORRADE_COMPARE(advances[0], Vector2(0.71875f, 0.0f));
+    CORRADE_COMPARE(advances[1], Vector2(0.25f, 0.0f));
+    CORRADE_COMPARE(advances[2], Vector2(0.25f, 0.0f));
+    CORRADE_COMPARE(advances[3], Vector2(0.375f, 0.0f));
+    CORRADE_COMPARE(cursorPosition, Vector2(1.59375f, 0.0f));
+    CORRADE_COMPARE(rectangle, Range2D({0.71875f, 0.0f}, {3.5f, 4.8125f}));
+}
+
+void MagnumFontTest::relayout() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    CORRADE_VERIFY(font->openFile(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.conf"), 0.0f));
+
+    struct DummyGlyphCache: AbstractGlyphCache {
+        using AbstractGlyphCache::AbstractGlyphCache;
+
+        GlyphCacheFeatures doFeatures() const override { return {}; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+    } cache{Vector2i{256}};
+    cache.insert(font->glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font->glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    Containers::Pointer<AbstractLayouter> layouter;
+    font->layout(cache, 0.5f, "Wave", layouter);
+    CORRADE_VERIFY(layouter);
+    CORRADE_COMPARE(layouter->glyphCount(), 4);
+
+    /* The same layouter instance is reused with a different text and size */
+    AbstractLayouter* const pointer = layouter.get();
+    font->layout(cache, 0.25f, "eW", layouter);
+    CORRADE_VERIFY(layouter.get() == pointer);
+    CORRADE_COMPARE(layouter->glyphCount(), 2);
+
+    Range2D rectangle;
+    Range2D position;
+    Range2D textureCoordinates;
+
+    /* 'e', scaled to half the size compared to layout() */
+    Vector2 cursorPosition;
+    std::tie(position, textureCoordinates) = layouter->renderGlyph(0, cursorPosition = {}, rectangle);
+    CORRADE_COMPARE(position, Range2D({0.390625f, 0.1875f}, {1.140625f, 0.625f}));
+    CORRADE_COMPARE(textureCoordinates, Range2D({0.0625f, 0.015625f}, {0.25f, 0.125f}));
+    CORRADE_COMPARE(cursorPosition, Vector2(0.1875f, 0.0f));
+
+    /* 'W' */
+    std::tie(position, textureCoordinates) = layouter->renderGlyph(1, cursorPosition = {}, rectangle);
+    CORRADE_COMPARE(position, Range2D({0.390625f, 0.53125f}, {0.640625f, 2.40625f}));
+    CORRADE_COMPARE(textureCoordinates, Range2D({0, 0.03125f}, {0.0625f, 0.5f}));
+    CORRADE_COMPARE(cursorPosition, Vector2(0.359375f, 0.0f));
+}
+
 void MagnumFontTest::fileCallbackImage() {
     Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
     CORRADE_VERIFY(font->features() & FontFeature::FileCallback);
@@ -175,6 +300,40 @@ void MagnumFontTest::fileCallbackImageNotFound() {
     CORRADE_COMPARE(out.str(), "Trade::AbstractImporter::openFile(): cannot open file font.tga\n");
 }
 
+void MagnumFontTest::binary() {
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    /* The binary file is self-contained, so it can be opened from data
+       without any file callback */
+    CORRADE_VERIFY(font->openData(Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.blob")), 0.0f));
+    CORRADE_COMPARE(font->size(), 16.0f);
+    CORRADE_COMPARE(font->ascent(), 25.0f);
+    CORRADE_COMPARE(font->descent(), -10.0f);
+    CORRADE_COMPARE(font->lineHeight(), 39.7333f);
+    CORRADE_COMPARE(font->glyphId(U'W'), 2);
+    CORRADE_COMPARE(font->glyphId(U'e'), 1);
+    CORRADE_COMPARE(font->glyphId(U'a'), 0);
+    CORRADE_COMPARE(font->glyphId(U'X'), 0);
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'W')), Vector2(23.0f, 0.0f));
+    CORRADE_COMPARE(font->glyphAdvance(font->glyphId(U'e')), Vector2(12.0f, 0.0f));
+}
+
+void MagnumFontTest::binaryInvalid() {
+    auto&& data = BinaryInvalidData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.blob"));
+    CORRADE_COMPARE(file.size(), 336);
+    file[data.offset] = data.value;
+
+    Containers::Pointer<AbstractFont> font = _fontManager.instantiate("MagnumFont");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!font->openData(file.prefix(data.size ? data.size : file.size()), 0.0f));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Text::MagnumFont::openData(): {}\n", data.message));
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Text::Test::MagnumFontTest)
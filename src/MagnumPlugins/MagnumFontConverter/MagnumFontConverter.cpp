@@ -29,6 +29,7 @@
 #include <sstream>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Configuration.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 
 #include "Magnum/Image.h"
@@ -37,6 +38,7 @@
 #include "Magnum/Math/ConfigurationValue.h"
 #include "Magnum/Text/AbstractFont.h"
 #include "Magnum/Text/AbstractGlyphCache.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
 #include "MagnumPlugins/TgaImageConverter/TgaImageConverter.h"
 
 namespace Magnum { namespace Text {
@@ -49,12 +51,100 @@ FontConverterFeatures MagnumFontConverter::doFeatures() const {
     return FontConverterFeature::ExportFont|FontConverterFeature::ConvertData|FontConverterFeature::MultiFile;
 }
 
+namespace {
+
+/* Font blob with the glyph and character data, followed by an image blob with
+   the glyph cache image, all in a single file */
+Containers::Array<char> exportBinary(AbstractFont& font, AbstractGlyphCache& cache, const std::vector<UnsignedInt>& inverseGlyphIdMap, const std::vector<std::pair<char32_t, UnsignedInt>>& characters) {
+    const Image2D image = cache.image();
+
+    const std::size_t glyphOffset = Trade::Implementation::alignBlobOffset(sizeof(Trade::Implementation::FontBlobHeader));
+    const std::size_t characterOffset = Trade::Implementation::alignBlobOffset(glyphOffset + inverseGlyphIdMap.size()*sizeof(Trade::Implementation::FontGlyphBlob));
+    const std::size_t fontBlobSize = Trade::Implementation::alignBlobOffset(characterOffset + characters.size()*sizeof(Trade::Implementation::FontCharacterBlob));
+    const std::size_t imageDataOffset = Trade::Implementation::alignBlobOffset(sizeof(Trade::Implementation::Image2DBlobHeader));
+    const std::size_t imageBlobSize = Trade::Implementation::alignBlobOffset(imageDataOffset + image.data().size());
+
+    /* Zero-initialized so the padding and reserved fields are deterministic */
+    Containers::Array<char> out{Containers::ValueInit, fontBlobSize + imageBlobSize};
+
+    auto& header = *reinterpret_cast<Trade::Implementation::FontBlobHeader*>(out.data());
+    std::copy(Trade::Implementation::BlobMagic, Trade::Implementation::BlobMagic + 4, header.header.magic);
+    header.header.version = Trade::Implementation::BlobVersion;
+    header.header.type = Trade::Implementation::BlobType::Font;
+    header.header.endianness = Trade::Implementation::BlobEndianness;
+    header.header.size = fontBlobSize;
+    header.size = font.size();
+    header.ascent = font.ascent();
+    header.descent = font.descent();
+    header.lineHeight = font.lineHeight();
+    header.originalImageSize[0] = cache.textureSize().x();
+    header.originalImageSize[1] = cache.textureSize().y();
+    header.padding[0] = cache.padding().x();
+    header.padding[1] = cache.padding().y();
+    header.glyphCount = inverseGlyphIdMap.size();
+    header.characterCount = characters.size();
+    header.glyphOffset = glyphOffset;
+    header.characterOffset = characterOffset;
+
+    /* Same as in the text variant, padding is removed from the glyph
+       properties */
+    auto* const glyphs = reinterpret_cast<Trade::Implementation::FontGlyphBlob*>(out.data() + glyphOffset);
+    for(std::size_t i = 0; i != inverseGlyphIdMap.size(); ++i) {
+        const std::pair<Vector2i, Range2Di> glyph = cache[inverseGlyphIdMap[i]];
+        const Vector2 advance = font.glyphAdvance(inverseGlyphIdMap[i]);
+        const Vector2i position = glyph.first + cache.padding();
+        const Range2Di rectangle = glyph.second.padded(-cache.padding());
+        glyphs[i].advance[0] = advance.x();
+        glyphs[i].advance[1] = advance.y();
+        glyphs[i].position[0] = position.x();
+        glyphs[i].position[1] = position.y();
+        glyphs[i].rectangle[0] = rectangle.left();
+        glyphs[i].rectangle[1] = rectangle.bottom();
+        glyphs[i].rectangle[2] = rectangle.right();
+        glyphs[i].rectangle[3] = rectangle.top();
+    }
+
+    auto* const characterBlobs = reinterpret_cast<Trade::Implementation::FontCharacterBlob*>(out.data() + characterOffset);
+    for(std::size_t i = 0; i != characters.size(); ++i) {
+        characterBlobs[i].character = characters[i].first;
+        characterBlobs[i].glyph = characters[i].second;
+    }
+
+    /* The image blob, same as what MagnumImageConverter would produce */
+    auto& imageHeader = *reinterpret_cast<Trade::Implementation::Image2DBlobHeader*>(out.data() + fontBlobSize);
+    std::copy(Trade::Implementation::BlobMagic, Trade::Implementation::BlobMagic + 4, imageHeader.header.magic);
+    imageHeader.header.version = Trade::Implementation::BlobVersion;
+    imageHeader.header.type = Trade::Implementation::BlobType::Image2D;
+    imageHeader.header.endianness = Trade::Implementation::BlobEndianness;
+    imageHeader.header.size = imageBlobSize;
+    imageHeader.format = UnsignedInt(image.format());
+    imageHeader.formatExtra = image.formatExtra();
+    imageHeader.pixelSize = image.pixelSize();
+    imageHeader.size[0] = image.size().x();
+    imageHeader.size[1] = image.size().y();
+    imageHeader.alignment = image.storage().alignment();
+    imageHeader.rowLength = image.storage().rowLength();
+    imageHeader.imageHeight = image.storage().imageHeight();
+    imageHeader.skip[0] = image.storage().skip().x();
+    imageHeader.skip[1] = image.storage().skip().y();
+    imageHeader.skip[2] = image.storage().skip().z();
+    imageHeader.dataOffset = imageDataOffset;
+    imageHeader.dataSize = image.data().size();
+    std::copy(image.data().begin(), image.data().end(), out.begin() + fontBlobSize + imageDataOffset);
+
+    return out;
+}
+
+}
+
 std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter::doExportFontToData(AbstractFont& font, AbstractGlyphCache& cache, const std::string& filename, const std::u32string& characters) const {
     if(!(cache.features() & GlyphCacheFeature::ImageDownload)) {
         Error{} << "Text::MagnumFontConverter::exportFontToData(): passed glyph cache doesn't support image download";
         return {};
     }
 
+    const bool binary = configuration().value<bool>("binary");
+
     Utility::Configuration configuration;
 
     configuration.setValue("version", 1);
@@ -92,14 +182,34 @@ std::vector<std::pair<std::string, Containers::Array<char>>> MagnumFontConverter
         inverseGlyphIdMap[map.second] = map.first;
 
     /* Character->glyph map, map glyph IDs to new ones */
+    std::vector<std::pair<char32_t, UnsignedInt>> characterGlyphs;
+    characterGlyphs.reserve(characters.size());
     for(const char32_t c: characters) {
-        Utility::ConfigurationGroup* group = configuration.addGroup("char");
         const UnsignedInt glyphId = font.glyphId(c);
-        group->setValue("unicode", c);
 
         /* Map old glyph ID to new, if not found, map to glyph 0 */
         auto found = glyphIdMap.find(glyphId);
-        group->setValue("glyph", found == glyphIdMap.end() ? 0 : glyphIdMap.at(glyphId));
+        characterGlyphs.emplace_back(c, found == glyphIdMap.end() ? 0 : found->second);
+    }
+
+    /* The binary variant is a single file with characters sorted by the
+       codepoint */
+    if(binary) {
+        std::sort(characterGlyphs.begin(), characterGlyphs.end());
+        characterGlyphs.erase(std::unique(characterGlyphs.begin(), characterGlyphs.end(),
+            [](const std::pair<char32_t, UnsignedInt>& a, const std::pair<char32_t, UnsignedInt>& b) {
+                return a.first == b.first;
+            }), characterGlyphs.end());
+
+        std::vector<std::pair<std::string, Containers::Array<char>>> out;
+        out.emplace_back(filename + ".blob", exportBinary(font, cache, inverseGlyphIdMap, characterGlyphs));
+        return out;
+    }
+
+    for(const std::pair<char32_t, UnsignedInt>& c: characterGlyphs) {
+        Utility::ConfigurationGroup* group = configuration.addGroup("char");
+        group->setValue("unicode", c.first);
+        group->setValue("glyph", c.second);
     }
 
     /* Save glyph properties in order which preserves their IDs, remove padding
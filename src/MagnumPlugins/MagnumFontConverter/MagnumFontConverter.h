@@ -58,6 +58,12 @@ Expects filename prefix, creates two files, `prefix.conf` and `prefix.tga`. See
 @ref MagnumFont for more information about the font. The plugin requires the
 passed @ref AbstractGlyphCache to support @ref GlyphCacheFeature::ImageDownload.
 
+If the @cb{.ini} binary @ce @ref Text-MagnumFontConverter-configuration "configuration option"
+is enabled, a single `prefix.blob` file is created instead, containing the
+glyph data and the glyph cache image in a binary form that's loadable by
+@ref MagnumFont without any parsing or image decoding. See
+@ref Text-MagnumFont-binary for more information.
+
 @section Text-MagnumFontConverter-usage Usage
 
 This plugin depends on the @ref Text library and the
@@ -94,6 +100,15 @@ you need to instantiate a manager for them and register it with
 @snippet plugins.cpp MagnumFontConverter-imageconverter-register
 
 See @ref building, @ref cmake and @ref plugins for more information.
+
+@section Text-MagnumFontConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/MagnumFontConverter/MagnumFontConverter.conf configuration_
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_MAGNUMFONTCONVERTER_EXPORT MagnumFontConverter: public Text::AbstractFontConverter {
     public:
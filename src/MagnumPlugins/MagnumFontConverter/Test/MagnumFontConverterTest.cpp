@@ -43,10 +43,48 @@
 
 namespace Magnum { namespace Text { namespace Test { namespace {
 
+/* Fake font, used by both the text and binary export tests */
+class FakeFont: public Text::AbstractFont {
+    public:
+        explicit FakeFont(): _opened(false) {}
+
+    private:
+        void doClose() { _opened = false; }
+        bool doIsOpened() const { return _opened; }
+        Metrics doOpenFile(const std::string&, Float) {
+            _opened = true;
+            return {16.0f, 25.0f, -10.0f, 39.7333f};
+        }
+        FontFeatures doFeatures() const { return {}; }
+        Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) { return nullptr; }
+
+        UnsignedInt doGlyphId(const char32_t character) {
+            switch(character) {
+                case 'W': return 2;
+                case 'e': return 1;
+            }
+
+            return 0;
+        }
+
+        Vector2 doGlyphAdvance(const UnsignedInt glyph) {
+            switch(glyph) {
+                case 0: return {8, 0};
+                case 1: return {12, 0};
+                case 2: return {23, 0};
+            }
+
+            CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+
+        bool _opened;
+};
+
 struct MagnumFontConverterTest: TestSuite::Tester {
     explicit MagnumFontConverterTest();
 
     void exportFont();
+    void exportFontBinary();
     void exportFontNoGlyphCacheImageDownload();
 
     /* Explicitly forbid system-wide plugin dependencies */
@@ -57,6 +95,7 @@ struct MagnumFontConverterTest: TestSuite::Tester {
 
 MagnumFontConverterTest::MagnumFontConverterTest() {
     addTests({&MagnumFontConverterTest::exportFont,
+              &MagnumFontConverterTest::exportFontBinary,
               &MagnumFontConverterTest::exportFontNoGlyphCacheImageDownload});
 
     /* Load the plugins directly from the build tree. Otherwise they are static
@@ -80,42 +119,7 @@ void MagnumFontConverterTest::exportFont() {
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.conf"));
     Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.tga"));
 
-    /* Fake font with fake cache */
-    class FakeFont: public Text::AbstractFont {
-        public:
-            explicit FakeFont(): _opened(false) {}
-
-        private:
-            void doClose() { _opened = false; }
-            bool doIsOpened() const { return _opened; }
-            Metrics doOpenFile(const std::string&, Float) {
-                _opened = true;
-                return {16.0f, 25.0f, -10.0f, 39.7333f};
-            }
-            FontFeatures doFeatures() const { return {}; }
-            Containers::Pointer<AbstractLayouter> doLayout(const AbstractGlyphCache&, Float, const std::string&) { return nullptr; }
-
-            UnsignedInt doGlyphId(const char32_t character) {
-                switch(character) {
-                    case 'W': return 2;
-                    case 'e': return 1;
-                }
-
-                return 0;
-            }
-
-            Vector2 doGlyphAdvance(const UnsignedInt glyph) {
-                switch(glyph) {
-                    case 0: return {8, 0};
-                    case 1: return {12, 0};
-                    case 2: return {23, 0};
-                }
-
-                CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-            }
-
-            bool _opened;
-    } font;
+    FakeFont font;
     font.openFile({}, {});
 
     /* Create fake cache */
@@ -153,6 +157,39 @@ void MagnumFontConverterTest::exportFont() {
     CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
 }
 
+void MagnumFontConverterTest::exportFontBinary() {
+    /* Remove previously created files */
+    Utility::Directory::rm(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.blob"));
+
+    FakeFont font;
+    font.openFile({}, {});
+
+    /* Same as in exportFont(), but with the cache image matching font.tga so
+       the output can be compared against a file */
+    struct MyCache: AbstractGlyphCache {
+        explicit MyCache(): AbstractGlyphCache{Vector2i{1536}, Vector2i{24}} {}
+
+        GlyphCacheFeatures doFeatures() const override { return GlyphCacheFeature::ImageDownload; }
+        void doSetImage(const Vector2i&, const ImageView2D&) override {}
+        Image2D doImage() override {
+            Containers::Array<char> data{Containers::InPlaceInit, {
+                1, 2, 3, 4, 5, 6
+            }};
+            return Image2D{PixelStorage{}.setAlignment(1), PixelFormat::R8Unorm, {3, 2}, std::move(data)};
+        }
+    } cache;
+    cache.insert(font.glyphId(U'W'), {25, 34}, {{0, 8}, {16, 128}});
+    cache.insert(font.glyphId(U'e'), {25, 12}, {{16, 4}, {64, 32}});
+
+    Containers::Pointer<AbstractFontConverter> converter = _fontConverterManager.instantiate("MagnumFontConverter");
+    converter->configuration().setValue("binary", true);
+    CORRADE_VERIFY(converter->exportFontToFile(font, cache, Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font"), "Wave"));
+
+    CORRADE_COMPARE_AS(Utility::Directory::join(MAGNUMFONTCONVERTER_TEST_WRITE_DIR, "font.blob"),
+                       Utility::Directory::join(MAGNUMFONT_TEST_DIR, "font.blob"),
+                       TestSuite::Compare::File);
+}
+
 void MagnumFontConverterTest::exportFontNoGlyphCacheImageDownload() {
     struct MyFont: AbstractFont {
         /* Supports neither file nor data opening */
@@ -0,0 +1,120 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImageConverter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MagnumImageConverter::MagnumImageConverter() = default;
+
+MagnumImageConverter::MagnumImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
+
+MagnumImageConverter::~MagnumImageConverter() = default;
+
+ImageConverterFeatures MagnumImageConverter::doFeatures() const {
+    return ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertCompressedData;
+}
+
+namespace {
+
+/* Fills the parts of the header and the data common for both compressed and
+   uncompressed images */
+Containers::Array<char> convert(const UnsignedInt flags, const UnsignedInt level, const UnsignedInt format, const Vector2i& size, const Containers::ArrayView<const char> data) {
+    const std::size_t dataOffset = Implementation::alignBlobOffset(sizeof(Implementation::Image2DBlobHeader));
+    const std::size_t blobSize = Implementation::alignBlobOffset(dataOffset + data.size());
+
+    /* Zero-initialized so the padding and reserved fields are deterministic */
+    Containers::Array<char> out{Containers::ValueInit, blobSize};
+
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(out.data());
+    std::copy(Implementation::BlobMagic, Implementation::BlobMagic + 4, header.header.magic);
+    header.header.version = Implementation::BlobVersion;
+    header.header.type = Implementation::BlobType::Image2D;
+    header.header.endianness = Implementation::BlobEndianness;
+    header.header.size = blobSize;
+    header.flags = flags;
+    header.level = level;
+    header.format = format;
+    header.size[0] = size.x();
+    header.size[1] = size.y();
+    header.dataOffset = dataOffset;
+    header.dataSize = data.size();
+
+    std::copy(data.begin(), data.end(), out.begin() + dataOffset);
+
+    return out;
+}
+
+}
+
+Containers::Array<char> MagnumImageConverter::doExportToData(const ImageView2D& image) {
+    Containers::Array<char> out = convert(0,
+        configuration().value<UnsignedInt>("level"),
+        UnsignedInt(image.format()), image.size(), image.data());
+
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(out.data());
+    header.formatExtra = image.formatExtra();
+    header.pixelSize = image.pixelSize();
+    header.alignment = image.storage().alignment();
+    header.rowLength = image.storage().rowLength();
+    header.imageHeight = image.storage().imageHeight();
+    header.skip[0] = image.storage().skip().x();
+    header.skip[1] = image.storage().skip().y();
+    header.skip[2] = image.storage().skip().z();
+
+    return out;
+}
+
+Containers::Array<char> MagnumImageConverter::doExportToData(const CompressedImageView2D& image) {
+    Containers::Array<char> out = convert(Implementation::ImageBlobFlagCompressed,
+        configuration().value<UnsignedInt>("level"),
+        UnsignedInt(image.format()), image.size(), image.data());
+
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(out.data());
+    header.rowLength = image.storage().rowLength();
+    header.imageHeight = image.storage().imageHeight();
+    header.skip[0] = image.storage().skip().x();
+    header.skip[1] = image.storage().skip().y();
+    header.skip[2] = image.storage().skip().z();
+    header.compressedBlockSize[0] = image.storage().compressedBlockSize().x();
+    header.compressedBlockSize[1] = image.storage().compressedBlockSize().y();
+    header.compressedBlockSize[2] = image.storage().compressedBlockSize().z();
+    header.compressedBlockDataSize = image.storage().compressedBlockDataSize();
+
+    return out;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImageConverter, Magnum::Trade::MagnumImageConverter,
+    "cz.mosra.magnum.Trade.AbstractImageConverter/0.2.1")
@@ -0,0 +1,143 @@
+#ifndef Magnum_Trade_MagnumImageConverter_h
+#define Magnum_Trade_MagnumImageConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImageConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "MagnumPlugins/MagnumImageConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMAGECONVERTER_BUILD_STATIC
+    #ifdef MagnumImageConverter_EXPORTS
+        #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMAGECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMAGECONVERTER_EXPORT
+#define MAGNUM_MAGNUMIMAGECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob image converter plugin
+@m_since_latest
+
+Converts uncompressed and compressed 2D images to Magnum's own binary blob
+format (`*.blob`), which can be imported back with zero parsing using the
+@ref MagnumImporter plugin.
+
+@section Trade-MagnumImageConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMIMAGECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MagnumImageConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MAGNUMIMAGECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImageConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumImageConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumImageConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImageConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImageConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumImageConverter-behavior Behavior and limitations
+
+The image data are written as-is, together with the @ref PixelFormat or
+@ref CompressedPixelFormat, including implementation-specific formats, and
+the @ref PixelStorage or @ref CompressedPixelStorage parameters, so the
+imported image has exactly the same layout as the original and can be
+uploaded to a GPU texture directly. The header and data are aligned to 16
+bytes and the output size is padded to 16 bytes as well, so multiple outputs
+can be concatenated into a single file.
+
+Each output contains a single image level, with the level index taken from
+the @cb{.ini} level @ce @ref Trade-MagnumImageConverter-configuration "configuration option".
+A full mip chain is created by converting each level with the option set
+accordingly and concatenating the outputs in order:
+
+@snippet MagnumTrade.cpp MagnumImageConverter-levels
+
+The data are written in the machine endianness, the @ref MagnumImporter
+rejects files written on a machine with a different endianness.
+
+@section Trade-MagnumImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration(). See
+below for all options and their default values.
+
+@snippet MagnumPlugins/MagnumImageConverter/MagnumImageConverter.conf configuration_
+
+See @ref plugins-configuration for more information.
+*/
+class MAGNUM_MAGNUMIMAGECONVERTER_EXPORT MagnumImageConverter: public AbstractImageConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImageConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumImageConverter();
+
+    private:
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL ImageConverterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL Containers::Array<char> doExportToData(const ImageView2D& image) override;
+        MAGNUM_MAGNUMIMAGECONVERTER_LOCAL Containers::Array<char> doExportToData(const CompressedImageView2D& image) override;
+};
+
+}}
+
+#endif
@@ -0,0 +1,258 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImageConverterTest: TestSuite::Tester {
+    explicit MagnumImageConverterTest();
+
+    void convert();
+    void convertCompressed();
+    void convertLevel();
+    void convertToFile();
+
+    void roundTrip();
+    void roundTripLevels();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+/* A 3x2 RGB8 image with rows aligned to four bytes, skipping the first pixel
+   of each 4-pixel row */
+constexpr char Pixels[]{
+    0, 0, 0,  1,  2,  3,  4,  5,  6,  7,  8,  9,
+    0, 0, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18
+};
+
+ImageView2D image() {
+    return ImageView2D{PixelStorage{}.setRowLength(4).setSkip({1, 0, 0}),
+        PixelFormat::RGB8Unorm, {3, 2}, Pixels};
+}
+
+/* A single 4x4 BC1 block */
+constexpr char CompressedPixels[]{
+    'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'
+};
+
+MagnumImageConverterTest::MagnumImageConverterTest() {
+    addTests({&MagnumImageConverterTest::convert,
+              &MagnumImageConverterTest::convertCompressed,
+              &MagnumImageConverterTest::convertLevel,
+              &MagnumImageConverterTest::convertToFile,
+
+              &MagnumImageConverterTest::roundTrip,
+              &MagnumImageConverterTest::roundTripLevels});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(MAGNUMIMAGECONVERTER_TEST_OUTPUT_DIR));
+}
+
+void MagnumImageConverterTest::convert() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+    CORRADE_COMPARE(converter->features(), ImageConverterFeature::ConvertData|ImageConverterFeature::ConvertCompressedData);
+
+    Containers::Array<char> data = converter->exportToData(image());
+
+    /* Header has 104 bytes, data 24, everything aligned to 16 bytes */
+    CORRADE_COMPARE(data.size(), 144);
+
+    const auto& header = *reinterpret_cast<const Implementation::Image2DBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.header.version, 1);
+    CORRADE_VERIFY(header.header.type == Implementation::BlobType::Image2D);
+    CORRADE_COMPARE(header.header.endianness, 0x0102);
+    CORRADE_COMPARE(header.header.size, 144);
+    CORRADE_COMPARE(header.flags, 0);
+    CORRADE_COMPARE(header.level, 0);
+    CORRADE_COMPARE(PixelFormat(header.format), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(header.formatExtra, 0);
+    CORRADE_COMPARE(header.pixelSize, 3);
+    CORRADE_COMPARE(header.size[0], 3);
+    CORRADE_COMPARE(header.size[1], 2);
+    CORRADE_COMPARE(header.alignment, 4);
+    CORRADE_COMPARE(header.rowLength, 4);
+    CORRADE_COMPARE(header.imageHeight, 0);
+    CORRADE_COMPARE(header.skip[0], 1);
+    CORRADE_COMPARE(header.skip[1], 0);
+    CORRADE_COMPARE(header.skip[2], 0);
+    CORRADE_COMPARE(header.compressedBlockDataSize, 0);
+    CORRADE_COMPARE(header.dataOffset, 112);
+    CORRADE_COMPARE(header.dataSize, 24);
+
+    /* The data are copied as-is, including the skipped pixels */
+    CORRADE_COMPARE_AS(data.slice(112, 136),
+        Containers::arrayView(Pixels),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImageConverterTest::convertCompressed() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+
+    Containers::Array<char> data = converter->exportToData(CompressedImageView2D{
+        CompressedPixelStorage{}
+            .setCompressedBlockSize({4, 4, 1})
+            .setCompressedBlockDataSize(8),
+        CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, CompressedPixels});
+
+    /* Header has 104 bytes, data 8 */
+    CORRADE_COMPARE(data.size(), 128);
+
+    const auto& header = *reinterpret_cast<const Implementation::Image2DBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.flags, UnsignedInt(Implementation::ImageBlobFlagCompressed));
+    CORRADE_COMPARE(CompressedPixelFormat(header.format), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(header.pixelSize, 0);
+    CORRADE_COMPARE(header.alignment, 0);
+    CORRADE_COMPARE(header.size[0], 4);
+    CORRADE_COMPARE(header.size[1], 4);
+    CORRADE_COMPARE(header.compressedBlockSize[0], 4);
+    CORRADE_COMPARE(header.compressedBlockSize[1], 4);
+    CORRADE_COMPARE(header.compressedBlockSize[2], 1);
+    CORRADE_COMPARE(header.compressedBlockDataSize, 8);
+    CORRADE_COMPARE(header.dataOffset, 112);
+    CORRADE_COMPARE(header.dataSize, 8);
+    CORRADE_COMPARE_AS(data.slice(112, 120),
+        Containers::arrayView(CompressedPixels),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImageConverterTest::convertLevel() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+    converter->configuration().setValue("level", 3);
+
+    Containers::Array<char> data = converter->exportToData(image());
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(reinterpret_cast<const Implementation::Image2DBlobHeader*>(data.data())->level, 3);
+}
+
+void MagnumImageConverterTest::convertToFile() {
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+
+    const std::string filename = Utility::Directory::join(MAGNUMIMAGECONVERTER_TEST_OUTPUT_DIR, "image.blob");
+    CORRADE_VERIFY(converter->exportToFile(image(), filename));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter->exportToData(image()),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImageConverterTest::roundTrip() {
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+    Containers::Array<char> data = converter->exportToData(image());
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->image2DCount(), 1);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 1);
+
+    Containers::Optional<Trade::ImageData2D> imported = importer->image2D(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(imported->size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE(imported->storage().rowLength(), 4);
+    CORRADE_COMPARE(imported->storage().skip(), (Vector3i{1, 0, 0}));
+    CORRADE_COMPARE_AS(imported->data(),
+        Containers::arrayView(Pixels),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->pixels<Vector3ub>()[1][2], (Vector3ub{16, 17, 18}));
+}
+
+void MagnumImageConverterTest::roundTripLevels() {
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("MagnumImageConverter");
+
+    /* Two levels of a compressed image followed by an uncompressed image */
+    const CompressedImageView2D levels[]{
+        {CompressedPixelFormat::Bc1RGBAUnorm, {4, 4}, CompressedPixels},
+        {CompressedPixelFormat::Bc1RGBAUnorm, {2, 2}, CompressedPixels}
+    };
+    Containers::Array<char> data;
+    for(UnsignedInt i = 0; i != Containers::arraySize(levels); ++i) {
+        converter->configuration().setValue("level", i);
+        Containers::Array<char> level = converter->exportToData(levels[i]);
+        CORRADE_VERIFY(level);
+        arrayAppend(data, level);
+    }
+    converter->configuration().setValue("level", 0);
+    Containers::Array<char> second = converter->exportToData(image());
+    CORRADE_VERIFY(second);
+    arrayAppend(data, second);
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->image2DCount(), 2);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 2);
+    CORRADE_COMPARE(importer->image2DLevelCount(1), 1);
+
+    Containers::Optional<Trade::ImageData2D> level1 = importer->image2D(0, 1);
+    CORRADE_VERIFY(level1);
+    CORRADE_VERIFY(level1->isCompressed());
+    CORRADE_COMPARE(level1->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(level1->size(), (Vector2i{2, 2}));
+
+    Containers::Optional<Trade::ImageData2D> uncompressed = importer->image2D(1);
+    CORRADE_VERIFY(uncompressed);
+    CORRADE_VERIFY(!uncompressed->isCompressed());
+    CORRADE_COMPARE(uncompressed->size(), (Vector2i{3, 2}));
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImageConverterTest)
@@ -0,0 +1,179 @@
+#ifndef Magnum_Trade_BlobHeader_h
+#define Magnum_Trade_BlobHeader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+
+#include "Magnum/Types.h"
+
+/* Used by MagnumImporter, MagnumImageConverter, MagnumSceneConverter,
+   MagnumFont and MagnumFontConverter, which is why it isn't directly inside
+   MagnumImporter.cpp. OTOH it doesn't
+   need to be exposed publicly, which is why it has no docblocks. */
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/* A file is a sequence of blobs, each starting with a BlobHeader. All values
+   are in the endianness of the machine that wrote the file, all offsets are
+   relative to the beginning of given blob and all data arrays start at an
+   offset aligned to BlobAlignment, so they can be used directly from a
+   memory-mapped file. The blob size is padded to BlobAlignment as well, so
+   blobs can be concatenated. */
+constexpr char BlobMagic[4]{'M', 'G', 'N', 'B'};
+constexpr UnsignedByte BlobVersion = 1;
+constexpr UnsignedShort BlobEndianness = 0x0102;
+constexpr std::size_t BlobAlignment = 16;
+
+enum class BlobType: UnsignedByte {
+    Mesh = 1,
+    Image2D = 2,
+    Font = 3
+};
+
+struct BlobHeader {
+    char magic[4];                  /* BlobMagic */
+    UnsignedByte version;           /* BlobVersion */
+    BlobType type;
+    UnsignedShort endianness;       /* BlobEndianness, byte-swapped if the
+                                       file has a different endianness */
+    UnsignedLong size;              /* Size of the whole blob, including the
+                                       header and padding */
+};
+
+static_assert(sizeof(BlobHeader) == 16, "BlobHeader size is not 16 bytes");
+
+/* A mesh blob is a MeshBlobHeader, followed by attributeCount
+   MeshAttributeBlob entries and then the index and vertex data. Compressed
+   index data are an output of encodeIndexData(), with indexOffset being zero
+   and indexDataSize being the encoded size, compressed vertex data are an
+   output of encodeVertexData() and vertexDataSize is the encoded size as
+   well. The attribute offsets are relative to the decoded vertex data. */
+enum: UnsignedInt {
+    MeshBlobFlagCompressedIndices = 1 << 0,
+    MeshBlobFlagCompressedVertices = 1 << 1
+};
+
+struct MeshBlobHeader {
+    BlobHeader header;
+    UnsignedInt primitive;          /* MeshPrimitive */
+    UnsignedInt indexType;          /* MeshIndexType, 0 if not indexed */
+    UnsignedInt indexCount;
+    UnsignedInt vertexCount;
+    UnsignedLong indexDataOffset;
+    UnsignedLong indexDataSize;
+    UnsignedLong indexOffset;       /* Relative to index data */
+    UnsignedLong vertexDataOffset;
+    UnsignedLong vertexDataSize;
+    UnsignedInt attributeCount;
+    UnsignedInt flags;              /* MeshBlobFlag* */
+};
+
+static_assert(sizeof(MeshBlobHeader) == 80, "MeshBlobHeader size is not 80 bytes");
+
+struct MeshAttributeBlob {
+    UnsignedInt format;             /* VertexFormat */
+    UnsignedShort name;             /* MeshAttribute */
+    UnsignedShort arraySize;
+    UnsignedLong offset;            /* Relative to vertex data */
+    Short stride;
+    UnsignedShort reserved1;
+    UnsignedInt reserved2;
+};
+
+static_assert(sizeof(MeshAttributeBlob) == 24, "MeshAttributeBlob size is not 24 bytes");
+
+/* An image blob is an Image2DBlobHeader followed by the data of a single image
+   level. A level chain is a sequence of consecutive image blobs, the first
+   having level 0 and each next one having the level incremented, with the
+   same format. */
+enum: UnsignedInt {
+    ImageBlobFlagCompressed = 1 << 0
+};
+
+struct Image2DBlobHeader {
+    BlobHeader header;
+    UnsignedInt flags;              /* ImageBlobFlag* */
+    UnsignedInt level;
+    UnsignedInt format;             /* PixelFormat or CompressedPixelFormat */
+    UnsignedInt formatExtra;        /* 0 if compressed */
+    UnsignedInt pixelSize;          /* 0 if compressed */
+    Int size[2];
+    Int alignment;                  /* 0 if compressed */
+    Int rowLength;
+    Int imageHeight;
+    Int skip[3];
+    Int compressedBlockSize[3];     /* 0 if not compressed */
+    Int compressedBlockDataSize;    /* 0 if not compressed */
+    UnsignedInt reserved;
+    UnsignedLong dataOffset;
+    UnsignedLong dataSize;
+};
+
+static_assert(sizeof(Image2DBlobHeader) == 104, "Image2DBlobHeader size is not 104 bytes");
+
+/* A font blob is a FontBlobHeader followed by glyphCount FontGlyphBlob
+   entries and characterCount FontCharacterBlob entries sorted by the
+   codepoint. It's followed by an image blob with a single level containing
+   the glyph cache image. Not recognized by MagnumImporter. */
+struct FontBlobHeader {
+    BlobHeader header;
+    Float size;
+    Float ascent;
+    Float descent;
+    Float lineHeight;
+    Int originalImageSize[2];
+    Int padding[2];
+    UnsignedInt glyphCount;
+    UnsignedInt characterCount;
+    UnsignedLong glyphOffset;
+    UnsignedLong characterOffset;
+};
+
+static_assert(sizeof(FontBlobHeader) == 72, "FontBlobHeader size is not 72 bytes");
+
+struct FontGlyphBlob {
+    Float advance[2];
+    Int position[2];                /* Relative to baseline, without padding */
+    Int rectangle[4];               /* Left, bottom, right, top, without
+                                       padding */
+};
+
+static_assert(sizeof(FontGlyphBlob) == 32, "FontGlyphBlob size is not 32 bytes");
+
+struct FontCharacterBlob {
+    UnsignedInt character;          /* UTF-32 codepoint */
+    UnsignedInt glyph;
+};
+
+static_assert(sizeof(FontCharacterBlob) == 8, "FontCharacterBlob size is not 8 bytes");
+
+constexpr std::size_t alignBlobOffset(const std::size_t offset) {
+    return (offset + BlobAlignment - 1)/BlobAlignment*BlobAlignment;
+}
+
+}}}
+
+#endif
@@ -0,0 +1,462 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumImporter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshCodec.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+struct MagnumImporter::State {
+    Containers::Array<char> data;
+    bool zeroCopy;
+    /* Offsets of all mesh blobs in the data */
+    Containers::Array<std::size_t> meshes;
+    /* Offsets of all image level blobs in the data and index of the first
+       level of each image in imageLevels */
+    Containers::Array<std::size_t> imageLevels;
+    Containers::Array<UnsignedInt> images;
+};
+
+MagnumImporter::MagnumImporter() = default;
+
+MagnumImporter::MagnumImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+MagnumImporter::~MagnumImporter() = default;
+
+ImporterFeatures MagnumImporter::doFeatures() const {
+    /* doMesh() and doImage2D() only read the data stored in doOpenData() */
+    return ImporterFeature::OpenData|ImporterFeature::ConcurrentImport;
+}
+
+bool MagnumImporter::doIsOpened() const { return !!_state; }
+
+void MagnumImporter::doClose() { _state = nullptr; }
+
+namespace {
+
+/* Used to check that the enum values are known, as builtin functions would
+   assert on them otherwise */
+constexpr UnsignedInt MeshPrimitiveCount = 0
+    #define _c(primitive) + 1
+    #include "Magnum/Implementation/meshPrimitiveMapping.hpp"
+    #undef _c
+    ;
+constexpr UnsignedInt VertexFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/vertexFormatMapping.hpp"
+    #undef _c
+    ;
+constexpr UnsignedInt PixelFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/pixelFormatMapping.hpp"
+    #undef _c
+    ;
+constexpr UnsignedInt CompressedPixelFormatCount = 0
+    #define _c(format) + 1
+    #include "Magnum/Implementation/compressedPixelFormatMapping.hpp"
+    #undef _c
+    ;
+
+/* Checks that the ranges referenced by a mesh blob are in bounds and the data
+   can be passed to MeshData without triggering any assertion */
+bool validateMesh(const char* const blob, const std::size_t offset) {
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(blob);
+    const std::size_t size = header.header.size;
+
+    if(size < sizeof(Implementation::MeshBlobHeader) || (size - sizeof(Implementation::MeshBlobHeader))/sizeof(Implementation::MeshAttributeBlob) < header.attributeCount) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "is too short for its header";
+        return false;
+    }
+    if(header.indexDataOffset > size || header.indexDataSize > size - header.indexDataOffset ||
+       header.vertexDataOffset > size || header.vertexDataSize > size - header.vertexDataOffset) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has data out of bounds";
+        return false;
+    }
+    if(header.flags & ~(Implementation::MeshBlobFlagCompressedIndices|Implementation::MeshBlobFlagCompressedVertices)) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has unknown flags" << reinterpret_cast<void*>(std::size_t(header.flags));
+        return false;
+    }
+
+    /* For compressed vertex data, the attribute bounds are checked against
+       the decoded size. The data themselves are validated only when decoding
+       in doMesh(). */
+    std::size_t vertexDataSize = header.vertexDataSize;
+    if(header.flags & Implementation::MeshBlobFlagCompressedVertices) {
+        const Containers::Optional<std::pair<std::size_t, std::size_t>> decodedSize = decodedVertexBufferSize({blob + header.vertexDataOffset, std::size_t(header.vertexDataSize)});
+        if(!decodedSize) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has invalid compressed vertices";
+            return false;
+        }
+        vertexDataSize = decodedSize->first*decodedSize->second;
+    }
+
+    const MeshPrimitive primitive = MeshPrimitive(header.primitive);
+    if(!isMeshPrimitiveImplementationSpecific(primitive) && (!header.primitive || header.primitive > MeshPrimitiveCount)) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has an invalid primitive" << primitive;
+        return false;
+    }
+
+    /* Index data are allowed to be present only if there are some indices */
+    if(header.indexType) {
+        const MeshIndexType type = MeshIndexType(header.indexType);
+        if(type != MeshIndexType::UnsignedByte &&
+           type != MeshIndexType::UnsignedShort &&
+           type != MeshIndexType::UnsignedInt) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has an invalid index type" << header.indexType;
+            return false;
+        }
+        /* Compressed indices always decode to exactly indexCount indices */
+        if(header.flags & Implementation::MeshBlobFlagCompressedIndices) {
+            const Containers::Optional<std::size_t> indexCount = decodedIndexBufferSize({blob + header.indexDataOffset, std::size_t(header.indexDataSize)});
+            if(header.indexOffset || !indexCount || *indexCount != header.indexCount) {
+                Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has invalid compressed indices";
+                return false;
+            }
+        } else if(header.indexOffset > header.indexDataSize || (header.indexDataSize - header.indexOffset)/meshIndexTypeSize(type) < header.indexCount) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has indices out of bounds";
+            return false;
+        }
+    } else if(header.flags & Implementation::MeshBlobFlagCompressedIndices) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has invalid compressed indices";
+        return false;
+    }
+    if(!header.indexCount && header.indexDataSize) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has index data but no indices";
+        return false;
+    }
+
+    if(header.vertexCount == MeshData::ImplicitVertexCount) {
+        Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has an invalid vertex count";
+        return false;
+    }
+
+    const auto* const attributes = reinterpret_cast<const Implementation::MeshAttributeBlob*>(blob + sizeof(Implementation::MeshBlobHeader));
+    for(std::size_t i = 0; i != header.attributeCount; ++i) {
+        const Implementation::MeshAttributeBlob& attribute = attributes[i];
+        const MeshAttribute name = MeshAttribute(attribute.name);
+        const VertexFormat format = VertexFormat(attribute.format);
+        if(!isVertexFormatImplementationSpecific(format) && (!attribute.format || attribute.format > VertexFormatCount)) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has an invalid format" << format << "for attribute" << i;
+            return false;
+        }
+        if(!Implementation::isVertexFormatCompatibleWithAttribute(name, format) || (attribute.arraySize && (!Implementation::isAttributeArrayAllowed(name) || isVertexFormatImplementationSpecific(format)))) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has an invalid" << name << "attribute" << i;
+            return false;
+        }
+        if(attribute.stride < 0 || attribute.offset > vertexDataSize) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has attribute" << i << "out of bounds";
+            return false;
+        }
+
+        /* Size of implementation-specific formats is not known, so the range
+           can't be checked */
+        if(!header.vertexCount || isVertexFormatImplementationSpecific(format))
+            continue;
+        const std::size_t elementSize = vertexFormatSize(format)*(attribute.arraySize ? attribute.arraySize : 1);
+        if(UnsignedLong(header.vertexCount - 1)*attribute.stride + elementSize > vertexDataSize - attribute.offset) {
+            Error{} << "Trade::MagnumImporter::openData(): mesh blob at offset" << offset << "has attribute" << i << "out of bounds";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Checks that the image blob is in bounds, the data can be passed to
+   ImageData without triggering any assertion and, if it's not the first
+   level, that it continues the level chain of the previous blob */
+bool validateImage2D(const char* const blob, const std::size_t offset, const Implementation::Image2DBlobHeader* const previous) {
+    const auto& header = *reinterpret_cast<const Implementation::Image2DBlobHeader*>(blob);
+    const std::size_t size = header.header.size;
+
+    if(size < sizeof(Implementation::Image2DBlobHeader)) {
+        Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "is too short for its header";
+        return false;
+    }
+    if(header.dataOffset > size || header.dataSize > size - header.dataOffset) {
+        Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has data out of bounds";
+        return false;
+    }
+    if(header.flags & ~Implementation::ImageBlobFlagCompressed) {
+        Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has unknown flags" << reinterpret_cast<void*>(std::size_t(header.flags));
+        return false;
+    }
+    if(header.size[0] < 0 || header.size[1] < 0 || header.rowLength < 0 ||
+       header.imageHeight < 0 || header.skip[0] < 0 || header.skip[1] < 0 ||
+       header.skip[2] < 0) {
+        Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid size or storage";
+        return false;
+    }
+
+    if(header.flags & Implementation::ImageBlobFlagCompressed) {
+        const CompressedPixelFormat format = CompressedPixelFormat(header.format);
+        if(!isCompressedPixelFormatImplementationSpecific(format) && (!header.format || header.format > CompressedPixelFormatCount)) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid format" << format;
+            return false;
+        }
+        if(header.compressedBlockSize[0] < 0 ||
+           header.compressedBlockSize[1] < 0 ||
+           header.compressedBlockSize[2] < 0 ||
+           header.compressedBlockDataSize < 0) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid size or storage";
+            return false;
+        }
+    } else {
+        const PixelFormat format = PixelFormat(header.format);
+        if(!isPixelFormatImplementationSpecific(format) && (!header.format || header.format > PixelFormatCount)) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid format" << format;
+            return false;
+        }
+        if(isPixelFormatImplementationSpecific(format) ? !header.pixelSize : header.pixelSize != pixelSize(format)) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid pixel size" << header.pixelSize << "for" << format;
+            return false;
+        }
+        if(header.alignment != 1 && header.alignment != 2 &&
+           header.alignment != 4 && header.alignment != 8) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has an invalid size or storage";
+            return false;
+        }
+
+        /* The same check as done in the ImageData constructor */
+        const std::size_t expectedDataSize = Magnum::Implementation::imageDataSize(ImageView2D{
+            PixelStorage{}
+                .setAlignment(header.alignment)
+                .setRowLength(header.rowLength)
+                .setImageHeight(header.imageHeight)
+                .setSkip({header.skip[0], header.skip[1], header.skip[2]}),
+            format, header.formatExtra, header.pixelSize,
+            {header.size[0], header.size[1]}});
+        if(header.dataSize < expectedDataSize) {
+            Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "has" << header.dataSize << "bytes of data but expected at least" << expectedDataSize;
+            return false;
+        }
+    }
+
+    /* Subsequent levels have to directly follow the previous level */
+    if(header.level && (!previous || previous->level + 1 != header.level || previous->flags != header.flags || previous->format != header.format || previous->formatExtra != header.formatExtra)) {
+        Error{} << "Trade::MagnumImporter::openData(): image blob at offset" << offset << "is level" << header.level << "but doesn't follow level" << header.level - 1 << "of the same format";
+        return false;
+    }
+
+    return true;
+}
+
+}
+
+void MagnumImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    if(data.empty()) {
+        Error{} << "Trade::MagnumImporter::openData(): the file is empty";
+        return;
+    }
+
+    /* Go through all blobs and validate them */
+    Containers::Array<std::size_t> meshes;
+    Containers::Array<std::size_t> imageLevels;
+    Containers::Array<UnsignedInt> images;
+    /* Used for validating the image level chains */
+    const Implementation::Image2DBlobHeader* previous = nullptr;
+    for(std::size_t offset = 0; offset != data.size(); ) {
+        if(data.size() - offset < sizeof(Implementation::BlobHeader)) {
+            Error{} << "Trade::MagnumImporter::openData(): expected at least" << sizeof(Implementation::BlobHeader) << "bytes for a blob header at offset" << offset << "but got" << data.size() - offset;
+            return;
+        }
+
+        const auto& header = *reinterpret_cast<const Implementation::BlobHeader*>(data.data() + offset);
+        if(!std::equal(header.magic, header.magic + 4, Implementation::BlobMagic)) {
+            Error{} << "Trade::MagnumImporter::openData(): invalid blob signature at offset" << offset;
+            return;
+        }
+        if(header.endianness != Implementation::BlobEndianness) {
+            Error{} << "Trade::MagnumImporter::openData(): blob at offset" << offset << "has a different endianness";
+            return;
+        }
+        if(header.version != Implementation::BlobVersion) {
+            Error{} << "Trade::MagnumImporter::openData(): unsupported blob version" << header.version << "at offset" << offset << Debug::nospace << ", expected" << Implementation::BlobVersion;
+            return;
+        }
+        if(header.size < sizeof(Implementation::BlobHeader) || header.size > data.size() - offset) {
+            Error{} << "Trade::MagnumImporter::openData(): blob at offset" << offset << "has an invalid size" << header.size << "for" << data.size() - offset << "remaining bytes";
+            return;
+        }
+
+        if(header.type == Implementation::BlobType::Mesh) {
+            if(!validateMesh(data.data() + offset, offset)) return;
+            arrayAppend(meshes, offset);
+            previous = nullptr;
+        } else if(header.type == Implementation::BlobType::Image2D) {
+            if(!validateImage2D(data.data() + offset, offset, previous)) return;
+            previous = reinterpret_cast<const Implementation::Image2DBlobHeader*>(data.data() + offset);
+            if(!previous->level) arrayAppend(images, UnsignedInt(imageLevels.size()));
+            arrayAppend(imageLevels, offset);
+        } else {
+            Error{} << "Trade::MagnumImporter::openData(): unknown blob type" << UnsignedInt(header.type) << "at offset" << offset;
+            return;
+        }
+
+        offset += header.size;
+    }
+
+    Containers::Pointer<State> state{Containers::InPlaceInit};
+    state->meshes = std::move(meshes);
+    state->imageLevels = std::move(imageLevels);
+    state->images = std::move(images);
+
+    /* If the caller guarantees the data stay in scope, just reference them
+       instead of making a copy */
+    if(flags() & ImporterFlag::ZeroCopy) {
+        state->data = Containers::Array<char>{const_cast<char*>(data.data()), data.size(), Implementation::nonOwnedArrayDeleter};
+        state->zeroCopy = true;
+    } else {
+        state->data = Containers::Array<char>{Containers::NoInit, data.size()};
+        std::copy(data.begin(), data.end(), state->data.begin());
+        state->zeroCopy = false;
+    }
+
+    _state = std::move(state);
+}
+
+UnsignedInt MagnumImporter::doMeshCount() const { return _state->meshes.size(); }
+
+Containers::Optional<MeshData> MagnumImporter::doMesh(const UnsignedInt id, UnsignedInt) {
+    const char* const blob = _state->data.data() + _state->meshes[id];
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(blob);
+    const auto* const attributeBlobs = reinterpret_cast<const Implementation::MeshAttributeBlob*>(blob + sizeof(Implementation::MeshBlobHeader));
+
+    /* The attributes are relative to the vertex data, so they don't need to
+       be adjusted if the data are copied */
+    Containers::Array<MeshAttributeData> attributes{header.attributeCount};
+    for(std::size_t i = 0; i != header.attributeCount; ++i) {
+        const Implementation::MeshAttributeBlob& attribute = attributeBlobs[i];
+        attributes[i] = MeshAttributeData{MeshAttribute(attribute.name),
+            VertexFormat(attribute.format), std::size_t(attribute.offset),
+            header.vertexCount, attribute.stride, attribute.arraySize};
+    }
+
+    const Containers::ArrayView<const char> indexData{blob + header.indexDataOffset, std::size_t(header.indexDataSize)};
+    const Containers::ArrayView<const char> vertexData{blob + header.vertexDataOffset, std::size_t(header.vertexDataSize)};
+    const std::size_t indexSize = header.indexType ? meshIndexTypeSize(MeshIndexType(header.indexType)) : 0;
+
+    /* Compressed data have to be decoded, so the mesh can't reference them
+       even if zero-copy import was requested */
+    if(_state->zeroCopy && !header.flags) {
+        MeshIndexData indices;
+        if(header.indexType) indices = MeshIndexData{MeshIndexType(header.indexType), indexData.slice(header.indexOffset, header.indexOffset + header.indexCount*indexSize)};
+        return MeshData{MeshPrimitive(header.primitive),
+            DataFlags{}, indexData, indices,
+            DataFlags{}, vertexData, std::move(attributes), header.vertexCount};
+    }
+
+    Containers::Array<char> indexDataCopy;
+    if(header.flags & Implementation::MeshBlobFlagCompressedIndices) {
+        Containers::Optional<Containers::Array<char>> decoded = decodeIndexData(indexData, MeshIndexType(header.indexType));
+        if(!decoded) {
+            Error{} << "Trade::MagnumImporter::mesh(): can't decode indices of mesh" << id;
+            return {};
+        }
+        indexDataCopy = std::move(*decoded);
+    } else {
+        indexDataCopy = Containers::Array<char>{Containers::NoInit, indexData.size()};
+        std::copy(indexData.begin(), indexData.end(), indexDataCopy.begin());
+    }
+
+    Containers::Array<char> vertexDataCopy;
+    if(header.flags & Implementation::MeshBlobFlagCompressedVertices) {
+        Containers::Optional<Containers::Array<char>> decoded = decodeVertexData(vertexData);
+        if(!decoded) {
+            Error{} << "Trade::MagnumImporter::mesh(): can't decode vertices of mesh" << id;
+            return {};
+        }
+        vertexDataCopy = std::move(*decoded);
+    } else {
+        vertexDataCopy = Containers::Array<char>{Containers::NoInit, vertexData.size()};
+        std::copy(vertexData.begin(), vertexData.end(), vertexDataCopy.begin());
+    }
+
+    MeshIndexData indices;
+    if(header.indexType) indices = MeshIndexData{MeshIndexType(header.indexType), indexDataCopy.slice(header.indexOffset, header.indexOffset + header.indexCount*indexSize)};
+    return MeshData{MeshPrimitive(header.primitive),
+        std::move(indexDataCopy), indices,
+        std::move(vertexDataCopy), std::move(attributes), header.vertexCount};
+}
+
+UnsignedInt MagnumImporter::doImage2DCount() const { return _state->images.size(); }
+
+UnsignedInt MagnumImporter::doImage2DLevelCount(const UnsignedInt id) {
+    const std::size_t end = id + 1 < _state->images.size() ?
+        _state->images[id + 1] : _state->imageLevels.size();
+    return end - _state->images[id];
+}
+
+Containers::Optional<ImageData2D> MagnumImporter::doImage2D(const UnsignedInt id, const UnsignedInt level) {
+    const char* const blob = _state->data.data() + _state->imageLevels[_state->images[id] + level];
+    const auto& header = *reinterpret_cast<const Implementation::Image2DBlobHeader*>(blob);
+
+    const Vector2i size{header.size[0], header.size[1]};
+    const Containers::ArrayView<const char> data{blob + header.dataOffset, std::size_t(header.dataSize)};
+    Containers::Array<char> dataCopy;
+    if(!_state->zeroCopy) {
+        dataCopy = Containers::Array<char>{Containers::NoInit, data.size()};
+        std::copy(data.begin(), data.end(), dataCopy.begin());
+    }
+
+    if(header.flags & Implementation::ImageBlobFlagCompressed) {
+        const CompressedPixelStorage storage = CompressedPixelStorage{}
+            .setRowLength(header.rowLength)
+            .setImageHeight(header.imageHeight)
+            .setSkip({header.skip[0], header.skip[1], header.skip[2]})
+            .setCompressedBlockSize({header.compressedBlockSize[0], header.compressedBlockSize[1], header.compressedBlockSize[2]})
+            .setCompressedBlockDataSize(header.compressedBlockDataSize);
+        if(_state->zeroCopy)
+            return ImageData2D{storage, CompressedPixelFormat(header.format), size, DataFlags{}, data};
+        return ImageData2D{storage, CompressedPixelFormat(header.format), size, std::move(dataCopy)};
+    }
+
+    const PixelStorage storage = PixelStorage{}
+        .setAlignment(header.alignment)
+        .setRowLength(header.rowLength)
+        .setImageHeight(header.imageHeight)
+        .setSkip({header.skip[0], header.skip[1], header.skip[2]});
+    if(_state->zeroCopy)
+        return ImageData2D{storage, PixelFormat(header.format), header.formatExtra, header.pixelSize, size, DataFlags{}, data};
+    return ImageData2D{storage, PixelFormat(header.format), header.formatExtra, header.pixelSize, size, std::move(dataCopy)};
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumImporter, Magnum::Trade::MagnumImporter,
+    "cz.mosra.magnum.Trade.AbstractImporter/0.3.3")
@@ -0,0 +1,168 @@
+#ifndef Magnum_Trade_MagnumImporter_h
+#define Magnum_Trade_MagnumImporter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumImporter
+ * @m_since_latest
+ */
+
+#include <Corrade/Containers/Pointer.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+
+#include "MagnumPlugins/MagnumImporter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMIMPORTER_BUILD_STATIC
+    #ifdef MagnumImporter_EXPORTS
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMIMPORTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMIMPORTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMIMPORTER_EXPORT
+#define MAGNUM_MAGNUMIMPORTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob importer plugin
+@m_since_latest
+
+Imports Magnum's own binary blob format (`*.blob`), produced by the
+@ref MagnumSceneConverter and @ref MagnumImageConverter plugins. The blobs
+store @ref MeshData and 2D @ref ImageData in the same memory layout they have
+at runtime, so importing involves no parsing, only a validation of the
+headers.
+
+@section Trade-MagnumImporter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMIMPORTER` is enabled when building Magnum. To use as a dynamic
+plugin, load @cpp "MagnumImporter" @ce via @ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MAGNUMIMPORTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumImporter)
+@endcode
+
+To use as a static plugin or use this as a dependency of another plugin with
+CMake, you need to request the `MagnumImporter` component of the `Magnum`
+package and link to the `Magnum::MagnumImporter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumImporter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumImporter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumImporter-behavior Behavior and limitations
+
+A file is a sequence of blobs, each having a header with a signature, format
+version, endianness marker and size. Every mesh blob is imported as a separate
+mesh. An image blob containing level @cpp 0 @ce starts a new 2D image, blobs
+with subsequent levels directly following it are imported as its mip levels.
+All headers are validated when the file is opened, so mesh and image import
+itself can't fail, except for meshes with compressed data described below.
+Files written on a machine with a different endianness are
+not supported.
+
+Images are stored with their @ref PixelFormat or @ref CompressedPixelFormat,
+including implementation-specific formats, and the original
+@ref PixelStorage or @ref CompressedPixelStorage parameters. The index, vertex
+and image data arrays in the file are aligned to 16 bytes, so they are
+suitably aligned for direct access if the file itself is --- which is the
+case for memory-mapped files and for the internal copy the importer makes
+--- and images can be uploaded with @ref GL::Texture::setSubImage() without
+any processing.
+
+The importer supports @ref ImporterFlag::ZeroCopy. If it's set and a file is
+opened with @ref openData() or with @ref openFile() together with
+@ref MappedFileCallback, the meshes and images are returned as views on the
+passed memory, without @ref DataFlag::Owned or @ref DataFlag::Mutable set.
+Only the parts of a mapped file that are actually accessed get paged in, which
+makes loading time proportional just to the I/O bandwidth. Otherwise the file
+is copied on opening and each imported mesh or image gets an owned copy of its
+data.
+
+Mesh index and vertex data can be compressed with @ref encodeIndexData() and
+@ref encodeVertexData(), which is controlled by the
+@ref Trade-MagnumSceneConverter-configuration "MagnumSceneConverter configuration".
+Compressed data are decoded on import into an owned array even if
+@ref ImporterFlag::ZeroCopy is set, indices are decoded back to their original
+type. The encoded data are validated only during decoding, so in this case
+@ref mesh() can fail.
+
+The importer supports @ref ImporterFeature::ConcurrentImport, mesh and image
+import only reads the data copied or referenced during opening.
+*/
+class MAGNUM_MAGNUMIMPORTER_EXPORT MagnumImporter: public AbstractImporter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumImporter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumImporter();
+
+    private:
+        struct State;
+
+        ImporterFeatures MAGNUM_MAGNUMIMPORTER_LOCAL doFeatures() const override;
+        bool MAGNUM_MAGNUMIMPORTER_LOCAL doIsOpened() const override;
+        void MAGNUM_MAGNUMIMPORTER_LOCAL doOpenData(Containers::ArrayView<const char> data) override;
+        void MAGNUM_MAGNUMIMPORTER_LOCAL doClose() override;
+
+        UnsignedInt MAGNUM_MAGNUMIMPORTER_LOCAL doMeshCount() const override;
+        Containers::Optional<MeshData> MAGNUM_MAGNUMIMPORTER_LOCAL doMesh(UnsignedInt id, UnsignedInt level) override;
+
+        UnsignedInt MAGNUM_MAGNUMIMPORTER_LOCAL doImage2DCount() const override;
+        UnsignedInt MAGNUM_MAGNUMIMPORTER_LOCAL doImage2DLevelCount(UnsignedInt id) override;
+        Containers::Optional<ImageData2D> MAGNUM_MAGNUMIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
+
+        Containers::Pointer<State> _state;
+};
+
+}}
+
+#endif
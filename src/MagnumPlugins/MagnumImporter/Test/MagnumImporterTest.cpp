@@ -0,0 +1,698 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumImporterTest: TestSuite::Tester {
+    explicit MagnumImporterTest();
+
+    void emptyFile();
+    void shortHeader();
+    void invalidSignature();
+    void differentEndianness();
+    void unsupportedVersion();
+    void invalidSize();
+    void unknownType();
+    void invalidMesh();
+
+    void mesh();
+    void meshZeroCopy();
+    void multipleBlobs();
+
+    void invalidImage();
+    void imageLevelDifferentFormat();
+    void imageLevelNotFollowing();
+
+    void image();
+    void imageZeroCopy();
+    void imageCompressed();
+    void imageLevels();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+/* Header, two attribute descriptors, ten bytes of index data with the indices
+   starting at offset 2, then three interleaved vertices */
+constexpr std::size_t IndexDataOffset = 128;
+constexpr std::size_t VertexDataOffset = 144;
+constexpr std::size_t BlobSize = 208;
+
+struct Vertex {
+    Vector3 position;
+    Vector2 textureCoordinates;
+};
+
+Containers::Array<char> meshBlob() {
+    Containers::Array<char> out{Containers::ValueInit, BlobSize};
+
+    auto& header = *reinterpret_cast<Implementation::MeshBlobHeader*>(out.data());
+    std::copy(Implementation::BlobMagic, Implementation::BlobMagic + 4, header.header.magic);
+    header.header.version = Implementation::BlobVersion;
+    header.header.type = Implementation::BlobType::Mesh;
+    header.header.endianness = Implementation::BlobEndianness;
+    header.header.size = BlobSize;
+    header.primitive = UnsignedInt(MeshPrimitive::Triangles);
+    header.indexType = UnsignedInt(MeshIndexType::UnsignedShort);
+    header.indexCount = 3;
+    header.vertexCount = 3;
+    header.indexDataOffset = IndexDataOffset;
+    header.indexDataSize = 10;
+    header.indexOffset = 2;
+    header.vertexDataOffset = VertexDataOffset;
+    header.vertexDataSize = 3*sizeof(Vertex);
+    header.attributeCount = 2;
+
+    auto* attributes = reinterpret_cast<Implementation::MeshAttributeBlob*>(out.data() + sizeof(Implementation::MeshBlobHeader));
+    attributes[0].format = UnsignedInt(VertexFormat::Vector3);
+    attributes[0].name = UnsignedShort(MeshAttribute::Position);
+    attributes[0].offset = offsetof(Vertex, position);
+    attributes[0].stride = sizeof(Vertex);
+    attributes[1].format = UnsignedInt(VertexFormat::Vector2);
+    attributes[1].name = UnsignedShort(MeshAttribute::TextureCoordinates);
+    attributes[1].offset = offsetof(Vertex, textureCoordinates);
+    attributes[1].stride = sizeof(Vertex);
+
+    auto* indices = reinterpret_cast<UnsignedShort*>(out.data() + IndexDataOffset);
+    indices[0] = 0xffff;
+    indices[1] = 2;
+    indices[2] = 0;
+    indices[3] = 1;
+    indices[4] = 0xffff;
+
+    auto* vertices = reinterpret_cast<Vertex*>(out.data() + VertexDataOffset);
+    vertices[0] = {{1.0f, 2.0f, 3.0f}, {0.0f, 0.5f}};
+    vertices[1] = {{4.0f, 5.0f, 6.0f}, {0.5f, 1.0f}};
+    vertices[2] = {{7.0f, 8.0f, 9.0f}, {1.0f, 0.0f}};
+
+    return out;
+}
+
+/* Header and a 3x2 RGB8 image with four-byte-aligned rows */
+constexpr std::size_t ImageDataOffset = 112;
+constexpr std::size_t ImageBlobSize = 144;
+
+Containers::Array<char> imageBlob(const UnsignedInt level = 0, const char first = 0) {
+    Containers::Array<char> out{Containers::ValueInit, ImageBlobSize};
+
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(out.data());
+    std::copy(Implementation::BlobMagic, Implementation::BlobMagic + 4, header.header.magic);
+    header.header.version = Implementation::BlobVersion;
+    header.header.type = Implementation::BlobType::Image2D;
+    header.header.endianness = Implementation::BlobEndianness;
+    header.header.size = ImageBlobSize;
+    header.level = level;
+    header.format = UnsignedInt(PixelFormat::RGB8Unorm);
+    header.pixelSize = 3;
+    header.size[0] = 3;
+    header.size[1] = 2;
+    header.alignment = 4;
+    header.dataOffset = ImageDataOffset;
+    header.dataSize = 24;
+
+    /* Each image gets different data so they can be distinguished */
+    for(std::size_t i = 0; i != 24; ++i)
+        out[ImageDataOffset + i] = first + i;
+
+    return out;
+}
+
+const struct {
+    const char* name;
+    void(*modify)(Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob*);
+    const char* message;
+} InvalidMeshData[]{
+    {"too short for the attributes",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.attributeCount = 6;
+        }, "is too short for its header"},
+    {"vertex data out of bounds",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.vertexDataSize = 65;
+        }, "has data out of bounds"},
+    {"index data out of bounds",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.indexDataOffset = 1000;
+        }, "has data out of bounds"},
+    {"unknown flags",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.flags = 0x4;
+        }, "has unknown flags 0x4"},
+    {"invalid compressed vertices",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.flags = Implementation::MeshBlobFlagCompressedVertices;
+        }, "has invalid compressed vertices"},
+    {"invalid primitive",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.primitive = 0xdead;
+        }, "has an invalid primitive MeshPrimitive(0xdead)"},
+    {"invalid index type",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.indexType = 3;
+        }, "has an invalid index type 3"},
+    {"indices out of bounds",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.indexCount = 5;
+        }, "has indices out of bounds"},
+    {"invalid compressed indices",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.flags = Implementation::MeshBlobFlagCompressedIndices;
+        }, "has invalid compressed indices"},
+    {"compressed indices but no index type",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.indexType = 0;
+            header.flags = Implementation::MeshBlobFlagCompressedIndices;
+        }, "has invalid compressed indices"},
+    {"index data but no indices",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.indexType = 0;
+            header.indexCount = 0;
+        }, "has index data but no indices"},
+    {"implicit vertex count",
+        [](Implementation::MeshBlobHeader& header, Implementation::MeshAttributeBlob*) {
+            header.vertexCount = MeshData::ImplicitVertexCount;
+        }, "has an invalid vertex count"},
+    {"invalid vertex format",
+        [](Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob* attributes) {
+            attributes[1].format = 0xdead;
+        }, "has an invalid format VertexFormat(0xdead) for attribute 1"},
+    {"format not compatible with the attribute",
+        [](Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob* attributes) {
+            attributes[0].format = UnsignedInt(VertexFormat::Int);
+        }, "has an invalid Trade::MeshAttribute::Position attribute 0"},
+    {"array for a builtin attribute",
+        [](Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob* attributes) {
+            attributes[0].arraySize = 2;
+        }, "has an invalid Trade::MeshAttribute::Position attribute 0"},
+    {"negative stride",
+        [](Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob* attributes) {
+            attributes[1].stride = -20;
+        }, "has attribute 1 out of bounds"},
+    {"attribute out of bounds",
+        [](Implementation::MeshBlobHeader&, Implementation::MeshAttributeBlob* attributes) {
+            attributes[1].offset = 16;
+        }, "has attribute 1 out of bounds"},
+};
+
+const struct {
+    const char* name;
+    void(*modify)(Implementation::Image2DBlobHeader&);
+    const char* message;
+} InvalidImageData[]{
+    {"too short for the header",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.header.size = 96;
+        }, "is too short for its header"},
+    {"data out of bounds",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.dataSize = 33;
+        }, "has data out of bounds"},
+    {"unknown flags",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.flags = 0x10;
+        }, "has unknown flags 0x10"},
+    {"negative size",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.size[1] = -1;
+        }, "has an invalid size or storage"},
+    {"negative skip",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.skip[2] = -1;
+        }, "has an invalid size or storage"},
+    {"invalid format",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.format = 0xdead;
+        }, "has an invalid format PixelFormat(0xdead)"},
+    {"invalid compressed format",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.flags = Implementation::ImageBlobFlagCompressed;
+            header.format = 0xdead;
+        }, "has an invalid format CompressedPixelFormat(0xdead)"},
+    {"negative compressed block size",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.flags = Implementation::ImageBlobFlagCompressed;
+            header.format = UnsignedInt(CompressedPixelFormat::Bc1RGBAUnorm);
+            header.compressedBlockDataSize = -8;
+        }, "has an invalid size or storage"},
+    {"pixel size not matching the format",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.pixelSize = 4;
+        }, "has an invalid pixel size 4 for PixelFormat::RGB8Unorm"},
+    {"zero implementation-specific pixel size",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.format = UnsignedInt(pixelFormatWrap(0xdead));
+            header.pixelSize = 0;
+        }, "has an invalid pixel size 0 for PixelFormat::ImplementationSpecific(0xdead)"},
+    {"invalid alignment",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.alignment = 3;
+        }, "has an invalid size or storage"},
+    {"data too small",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.rowLength = 5;
+        }, "has 24 bytes of data but expected at least 32"},
+    {"level without a previous level",
+        [](Implementation::Image2DBlobHeader& header) {
+            header.level = 1;
+        }, "is level 1 but doesn't follow level 0 of the same format"},
+};
+
+MagnumImporterTest::MagnumImporterTest() {
+    addTests({&MagnumImporterTest::emptyFile,
+              &MagnumImporterTest::shortHeader,
+              &MagnumImporterTest::invalidSignature,
+              &MagnumImporterTest::differentEndianness,
+              &MagnumImporterTest::unsupportedVersion,
+              &MagnumImporterTest::invalidSize,
+              &MagnumImporterTest::unknownType});
+
+    addInstancedTests({&MagnumImporterTest::invalidMesh},
+        Containers::arraySize(InvalidMeshData));
+
+    addTests({&MagnumImporterTest::mesh,
+              &MagnumImporterTest::meshZeroCopy,
+              &MagnumImporterTest::multipleBlobs});
+
+    addInstancedTests({&MagnumImporterTest::invalidImage},
+        Containers::arraySize(InvalidImageData));
+
+    addTests({&MagnumImporterTest::imageLevelDifferentFormat,
+              &MagnumImporterTest::imageLevelNotFollowing,
+
+              &MagnumImporterTest::image,
+              &MagnumImporterTest::imageZeroCopy,
+              &MagnumImporterTest::imageCompressed,
+              &MagnumImporterTest::imageLevels});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void MagnumImporterTest::emptyFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    char a{};
+    /* Explicitly checking non-null but empty view */
+    CORRADE_VERIFY(!importer->openData({&a, 0}));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): the file is empty\n");
+}
+
+void MagnumImporterTest::shortHeader() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data.prefix(15)));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): expected at least 16 bytes for a blob header at offset 0 but got 15\n");
+}
+
+void MagnumImporterTest::invalidSignature() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+    data[3] = 'X';
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): invalid blob signature at offset 0\n");
+}
+
+void MagnumImporterTest::differentEndianness() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+    reinterpret_cast<Implementation::BlobHeader*>(data.data())->endianness = 0x0201;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): blob at offset 0 has a different endianness\n");
+}
+
+void MagnumImporterTest::unsupportedVersion() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+    reinterpret_cast<Implementation::BlobHeader*>(data.data())->version = 2;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): unsupported blob version 2 at offset 0, expected 1\n");
+}
+
+void MagnumImporterTest::invalidSize() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+    reinterpret_cast<Implementation::BlobHeader*>(data.data())->size = BlobSize + 16;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): blob at offset 0 has an invalid size 224 for 208 remaining bytes\n");
+}
+
+void MagnumImporterTest::unknownType() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> data = meshBlob();
+    reinterpret_cast<Implementation::BlobHeader*>(data.data())->type = Implementation::BlobType(0x7f);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): unknown blob type 127 at offset 0\n");
+}
+
+void MagnumImporterTest::invalidMesh() {
+    auto&& data = InvalidMeshData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> blob = meshBlob();
+    data.modify(*reinterpret_cast<Implementation::MeshBlobHeader*>(blob.data()),
+        reinterpret_cast<Implementation::MeshAttributeBlob*>(blob.data() + sizeof(Implementation::MeshBlobHeader)));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(blob));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::openData(): mesh blob at offset 0 {}\n", data.message));
+}
+
+void MagnumImporterTest::mesh() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    CORRADE_COMPARE(importer->features(), ImporterFeature::OpenData|ImporterFeature::ConcurrentImport);
+
+    Containers::Optional<MeshData> mesh;
+    {
+        Containers::Array<char> data = meshBlob();
+        CORRADE_VERIFY(importer->openData(data));
+        CORRADE_COMPARE(importer->meshCount(), 1);
+        mesh = importer->mesh(0);
+    }
+
+    /* The data is a copy, so it's still valid after the original memory is
+       gone */
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indexData().size(), 10);
+    CORRADE_COMPARE(mesh->indexOffset(), 2);
+    CORRADE_COMPARE(mesh->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(mesh->vertexCount(), 3);
+    CORRADE_COMPARE(mesh->attributeCount(), 2);
+    CORRADE_COMPARE(mesh->attributeStride(MeshAttribute::Position), sizeof(Vertex));
+    CORRADE_COMPARE(mesh->attributeOffset(MeshAttribute::TextureCoordinates), offsetof(Vertex, textureCoordinates));
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        Containers::arrayView<Vector2>({
+            {0.0f, 0.5f}, {0.5f, 1.0f}, {1.0f, 0.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::meshZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    Containers::Array<char> data = meshBlob();
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(mesh->vertexDataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(mesh->indexData().data()), static_cast<const void*>(data.data() + IndexDataOffset));
+    CORRADE_COMPARE(static_cast<const void*>(mesh->vertexData().data()), static_cast<const void*>(data.data() + VertexDataOffset));
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({2, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+
+    /* Closing the importer doesn't affect the returned data */
+    importer->close();
+    CORRADE_COMPARE(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates)[2], (Vector2{1.0f, 0.0f}));
+}
+
+void MagnumImporterTest::multipleBlobs() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* Second blob is non-indexed, with a different primitive */
+    Containers::Array<char> first = meshBlob();
+    Containers::Array<char> second = meshBlob();
+    auto& header = *reinterpret_cast<Implementation::MeshBlobHeader*>(second.data());
+    header.primitive = UnsignedInt(MeshPrimitive::Points);
+    header.indexType = 0;
+    header.indexCount = 0;
+    header.indexDataSize = 0;
+
+    Containers::Array<char> data{Containers::NoInit, 2*BlobSize};
+    std::copy(first.begin(), first.end(), data.begin());
+    std::copy(second.begin(), second.end(), data.begin() + BlobSize);
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 2);
+
+    Containers::Optional<MeshData> a = importer->mesh(0);
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a->primitive(), MeshPrimitive::Triangles);
+    CORRADE_VERIFY(a->isIndexed());
+
+    Containers::Optional<MeshData> b = importer->mesh(1);
+    CORRADE_VERIFY(b);
+    CORRADE_COMPARE(b->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!b->isIndexed());
+    CORRADE_COMPARE(b->vertexCount(), 3);
+    CORRADE_COMPARE(b->attribute<Vector3>(MeshAttribute::Position)[1], (Vector3{4.0f, 5.0f, 6.0f}));
+}
+
+void MagnumImporterTest::invalidImage() {
+    auto&& data = InvalidImageData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> blob = imageBlob();
+    data.modify(*reinterpret_cast<Implementation::Image2DBlobHeader*>(blob.data()));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(blob));
+    CORRADE_COMPARE(out.str(), Utility::formatString("Trade::MagnumImporter::openData(): image blob at offset 0 {}\n", data.message));
+}
+
+void MagnumImporterTest::imageLevelDifferentFormat() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Array<char> first = imageBlob();
+    Containers::Array<char> second = imageBlob(1);
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(second.data());
+    header.format = UnsignedInt(PixelFormat::RGB8Srgb);
+
+    Containers::Array<char> data{Containers::NoInit, 2*ImageBlobSize};
+    std::copy(first.begin(), first.end(), data.begin());
+    std::copy(second.begin(), second.end(), data.begin() + ImageBlobSize);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): image blob at offset 144 is level 1 but doesn't follow level 0 of the same format\n");
+}
+
+void MagnumImporterTest::imageLevelNotFollowing() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* A mesh blob in between interrupts the level chain */
+    Containers::Array<char> first = imageBlob();
+    Containers::Array<char> mesh = meshBlob();
+    Containers::Array<char> second = imageBlob(1);
+
+    Containers::Array<char> data{Containers::NoInit, 2*ImageBlobSize + BlobSize};
+    std::copy(first.begin(), first.end(), data.begin());
+    std::copy(mesh.begin(), mesh.end(), data.begin() + ImageBlobSize);
+    std::copy(second.begin(), second.end(), data.begin() + ImageBlobSize + BlobSize);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::MagnumImporter::openData(): image blob at offset 352 is level 1 but doesn't follow level 0 of the same format\n");
+}
+
+void MagnumImporterTest::image() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    Containers::Optional<ImageData2D> image;
+    {
+        Containers::Array<char> data = imageBlob(0, 'a');
+        CORRADE_VERIFY(importer->openData(data));
+        CORRADE_COMPARE(importer->image2DCount(), 1);
+        CORRADE_COMPARE(importer->image2DLevelCount(0), 1);
+        image = importer->image2D(0);
+    }
+
+    /* The data is a copy, so it's still valid after the original memory is
+       gone */
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(!image->isCompressed());
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->pixelSize(), 3);
+    CORRADE_COMPARE(image->size(), (Vector2i{3, 2}));
+    CORRADE_COMPARE(image->storage().alignment(), 4);
+    CORRADE_COMPARE(image->data().size(), 24);
+    CORRADE_COMPARE(image->data()[0], 'a');
+    CORRADE_COMPARE(image->data()[23], 'a' + 23);
+}
+
+void MagnumImporterTest::imageZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    /* Implementation-specific format with custom storage */
+    Containers::Array<char> data = imageBlob();
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(data.data());
+    header.format = UnsignedInt(pixelFormatWrap(0xdead));
+    header.formatExtra = 0xbeef;
+    header.pixelSize = 2;
+    header.alignment = 1;
+    header.rowLength = 4;
+    header.skip[0] = 1;
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), static_cast<const void*>(data.data() + ImageDataOffset));
+    CORRADE_COMPARE(image->format(), pixelFormatWrap(0xdead));
+    CORRADE_COMPARE(image->formatExtra(), 0xbeef);
+    CORRADE_COMPARE(image->pixelSize(), 2);
+    CORRADE_COMPARE(image->storage().alignment(), 1);
+    CORRADE_COMPARE(image->storage().rowLength(), 4);
+    CORRADE_COMPARE(image->storage().skip(), (Vector3i{1, 0, 0}));
+    CORRADE_COMPARE(image->data().size(), 24);
+}
+
+void MagnumImporterTest::imageCompressed() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* A single 4x4 BC1 block */
+    Containers::Array<char> data = imageBlob();
+    auto& header = *reinterpret_cast<Implementation::Image2DBlobHeader*>(data.data());
+    header.flags = Implementation::ImageBlobFlagCompressed;
+    header.format = UnsignedInt(CompressedPixelFormat::Bc1RGBAUnorm);
+    header.pixelSize = 0;
+    header.alignment = 0;
+    header.size[0] = 4;
+    header.size[1] = 4;
+    header.compressedBlockSize[0] = 4;
+    header.compressedBlockSize[1] = 4;
+    header.compressedBlockSize[2] = 1;
+    header.compressedBlockDataSize = 8;
+    header.dataSize = 8;
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_VERIFY(image->isCompressed());
+    CORRADE_COMPARE(image->compressedFormat(), CompressedPixelFormat::Bc1RGBAUnorm);
+    CORRADE_COMPARE(image->size(), (Vector2i{4, 4}));
+    CORRADE_COMPARE(image->compressedStorage().compressedBlockSize(), (Vector3i{4, 4, 1}));
+    CORRADE_COMPARE(image->compressedStorage().compressedBlockDataSize(), 8);
+    CORRADE_COMPARE_AS(image->data(),
+        data.slice(ImageDataOffset, ImageDataOffset + 8),
+        TestSuite::Compare::Container);
+}
+
+void MagnumImporterTest::imageLevels() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("MagnumImporter");
+
+    /* First image has three levels, second just one, with a mesh after */
+    Containers::Array<char> data{Containers::NoInit, 4*ImageBlobSize + BlobSize};
+    for(UnsignedInt i = 0; i != 4; ++i) {
+        Containers::Array<char> level = imageBlob(i == 3 ? 0 : i, 'a' + i);
+        std::copy(level.begin(), level.end(), data.begin() + i*ImageBlobSize);
+    }
+    Containers::Array<char> mesh = meshBlob();
+    std::copy(mesh.begin(), mesh.end(), data.begin() + 4*ImageBlobSize);
+
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->image2DCount(), 2);
+    CORRADE_COMPARE(importer->image2DLevelCount(0), 3);
+    CORRADE_COMPARE(importer->image2DLevelCount(1), 1);
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    for(UnsignedInt i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<ImageData2D> image = importer->image2D(0, i);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE(image->data()[0], 'a' + i);
+    }
+
+    Containers::Optional<ImageData2D> image = importer->image2D(1);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->data()[0], 'd');
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumImporterTest)
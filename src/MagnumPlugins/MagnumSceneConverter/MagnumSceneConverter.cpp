@@ -0,0 +1,118 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "MagnumSceneConverter.h"
+
+#include <algorithm>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/VertexFormat.h"
+#include "Magnum/Trade/MeshCodec.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+namespace Magnum { namespace Trade {
+
+MagnumSceneConverter::MagnumSceneConverter() = default;
+
+MagnumSceneConverter::MagnumSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractSceneConverter{manager, plugin} {}
+
+MagnumSceneConverter::~MagnumSceneConverter() = default;
+
+SceneConverterFeatures MagnumSceneConverter::doFeatures() const {
+    return SceneConverterFeature::ConvertMeshToData;
+}
+
+Containers::Array<char> MagnumSceneConverter::doConvertToData(const MeshData& mesh) {
+    /* Compress the data if requested. Only triangle indices can be
+       compressed, for other meshes the option is ignored. */
+    UnsignedInt flags = 0;
+    Containers::Array<char> compressedIndexData;
+    Containers::ArrayView<const char> indexData = mesh.indexData();
+    if(configuration().value<bool>("compressIndices") && mesh.isIndexed() && mesh.primitive() == MeshPrimitive::Triangles && mesh.indexCount() % 3 == 0) {
+        compressedIndexData = encodeIndexData(mesh);
+        indexData = compressedIndexData;
+        flags |= Implementation::MeshBlobFlagCompressedIndices;
+    }
+    Containers::Array<char> compressedVertexData;
+    Containers::ArrayView<const char> vertexData = mesh.vertexData();
+    if(configuration().value<bool>("compressVertices")) {
+        compressedVertexData = encodeVertexData(mesh);
+        vertexData = compressedVertexData;
+        flags |= Implementation::MeshBlobFlagCompressedVertices;
+    }
+
+    /* Attribute descriptors right after the header, then index and vertex
+       data, each aligned */
+    const std::size_t attributeOffset = sizeof(Implementation::MeshBlobHeader);
+    const std::size_t indexDataOffset = Implementation::alignBlobOffset(attributeOffset + mesh.attributeCount()*sizeof(Implementation::MeshAttributeBlob));
+    const std::size_t vertexDataOffset = Implementation::alignBlobOffset(indexDataOffset + indexData.size());
+    const std::size_t size = Implementation::alignBlobOffset(vertexDataOffset + vertexData.size());
+
+    /* Zero-initialized so the padding and reserved fields are deterministic */
+    Containers::Array<char> out{Containers::ValueInit, size};
+
+    auto& header = *reinterpret_cast<Implementation::MeshBlobHeader*>(out.data());
+    std::copy(Implementation::BlobMagic, Implementation::BlobMagic + 4, header.header.magic);
+    header.header.version = Implementation::BlobVersion;
+    header.header.type = Implementation::BlobType::Mesh;
+    header.header.endianness = Implementation::BlobEndianness;
+    header.header.size = size;
+    header.primitive = UnsignedInt(mesh.primitive());
+    if(mesh.isIndexed()) {
+        header.indexType = UnsignedInt(mesh.indexType());
+        header.indexCount = mesh.indexCount();
+        /* Compressed indices contain just the index range */
+        header.indexOffset = flags & Implementation::MeshBlobFlagCompressedIndices ? 0 : mesh.indexOffset();
+    }
+    header.vertexCount = mesh.vertexCount();
+    header.indexDataOffset = indexDataOffset;
+    header.indexDataSize = indexData.size();
+    header.vertexDataOffset = vertexDataOffset;
+    header.vertexDataSize = vertexData.size();
+    header.attributeCount = mesh.attributeCount();
+    header.flags = flags;
+
+    auto* const attributes = reinterpret_cast<Implementation::MeshAttributeBlob*>(out.data() + attributeOffset);
+    for(UnsignedInt i = 0; i != mesh.attributeCount(); ++i) {
+        attributes[i].format = UnsignedInt(mesh.attributeFormat(i));
+        attributes[i].name = UnsignedShort(mesh.attributeName(i));
+        attributes[i].arraySize = mesh.attributeArraySize(i);
+        attributes[i].offset = mesh.attributeOffset(i);
+        attributes[i].stride = Short(mesh.attributeStride(i));
+    }
+
+    std::copy(indexData.begin(), indexData.end(), out.begin() + indexDataOffset);
+    std::copy(vertexData.begin(), vertexData.end(), out.begin() + vertexDataOffset);
+
+    return out;
+}
+
+}}
+
+CORRADE_PLUGIN_REGISTER(MagnumSceneConverter, Magnum::Trade::MagnumSceneConverter,
+    "cz.mosra.magnum.Trade.AbstractSceneConverter/0.1")
@@ -0,0 +1,146 @@
+#ifndef Magnum_Trade_MagnumSceneConverter_h
+#define Magnum_Trade_MagnumSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::MagnumSceneConverter
+ * @m_since_latest
+ */
+
+#include <Corrade/Utility/VisibilityMacros.h>
+
+#include "Magnum/Trade/AbstractSceneConverter.h"
+
+#include "MagnumPlugins/MagnumSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_MAGNUMSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumSceneConverter_EXPORTS
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_MAGNUMSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL CORRADE_VISIBILITY_LOCAL
+#else
+#define MAGNUM_MAGNUMSCENECONVERTER_EXPORT
+#define MAGNUM_MAGNUMSCENECONVERTER_LOCAL
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Magnum blob scene converter plugin
+@m_since_latest
+
+Converts a @ref MeshData to Magnum's own binary blob format (`*.blob`), which
+can be imported back with zero parsing using the @ref MagnumImporter plugin.
+
+@section Trade-MagnumSceneConverter-usage Usage
+
+This plugin depends on the @ref Trade library and is built if
+`WITH_MAGNUMSCENECONVERTER` is enabled when building Magnum. To use as a
+dynamic plugin, load @cpp "MagnumSceneConverter" @ce via
+@ref Corrade::PluginManager::Manager.
+
+Additionally, if you're using Magnum as a CMake subproject, do the following:
+
+@code{.cmake}
+set(WITH_MAGNUMSCENECONVERTER ON CACHE BOOL "" FORCE)
+add_subdirectory(magnum EXCLUDE_FROM_ALL)
+
+# So the dynamically loaded plugin gets built implicitly
+add_dependencies(your-app Magnum::MagnumSceneConverter)
+@endcode
+
+To use as a static plugin or as a dependency of another plugin with CMake, you
+need to request the `MagnumSceneConverter` component of the `Magnum` package
+and link to the `Magnum::MagnumSceneConverter` target:
+
+@code{.cmake}
+find_package(Magnum REQUIRED MagnumSceneConverter)
+
+# ...
+target_link_libraries(your-app PRIVATE Magnum::MagnumSceneConverter)
+@endcode
+
+See @ref building, @ref cmake, @ref plugins and @ref file-formats for more
+information.
+
+@section Trade-MagnumSceneConverter-behavior Behavior and limitations
+
+The index and vertex data are written as-is, including any padding and data
+not referenced by the attributes, so the imported mesh has exactly the same
+layout as the original. All attribute properties including array sizes,
+custom attribute names and implementation-specific vertex formats and
+primitives are preserved. The header and data arrays are aligned to 16 bytes
+and the output size is padded to 16 bytes as well, so multiple outputs can be
+concatenated into a single file.
+
+The data are written in the machine endianness, the @ref MagnumImporter
+rejects files written on a machine with a different endianness.
+
+The index and vertex data can be compressed using the
+@cb{.ini} compressIndices @ce and @cb{.ini} compressVertices @ce
+@ref Trade-MagnumSceneConverter-configuration "configuration options", which
+use @ref encodeIndexData() and @ref encodeVertexData(). This makes the files
+considerably smaller, at the cost of the data having to be decoded on import,
+so they can't be memory-mapped directly anymore. Only indices of
+@ref MeshPrimitive::Triangles meshes are compressed, for other meshes the
+option is ignored. Compressed indices can have the vertices of each triangle
+rotated and any index data outside of the index range are dropped. Vertex data
+compress best if the attributes are interleaved with no padding at the end,
+such as after @ref MeshTools::interleave().
+
+@section Trade-MagnumSceneConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/MagnumSceneConverter/MagnumSceneConverter.conf configuration_
+
+See @ref plugins-configuration for more information.
+*/
+class MAGNUM_MAGNUMSCENECONVERTER_EXPORT MagnumSceneConverter: public AbstractSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit MagnumSceneConverter();
+
+        /** @brief Plugin manager constructor */
+        explicit MagnumSceneConverter(PluginManager::AbstractManager& manager, const std::string& plugin);
+
+        ~MagnumSceneConverter();
+
+    private:
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL SceneConverterFeatures doFeatures() const override;
+        MAGNUM_MAGNUMSCENECONVERTER_LOCAL Containers::Array<char> doConvertToData(const MeshData& mesh) override;
+};
+
+}}
+
+#endif
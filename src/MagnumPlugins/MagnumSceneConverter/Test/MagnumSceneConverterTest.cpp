@@ -0,0 +1,348 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
+
+#include "Magnum/Mesh.h"
+#include "Magnum/Math/Vector3.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AbstractSceneConverter.h"
+#include "Magnum/Trade/MeshCodec.h"
+#include "Magnum/Trade/MeshData.h"
+#include "MagnumPlugins/MagnumImporter/BlobHeader.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+struct MagnumSceneConverterTest: TestSuite::Tester {
+    explicit MagnumSceneConverterTest();
+
+    void convert();
+    void convertNonIndexed();
+    void convertToFile();
+    void convertCompressed();
+    void convertCompressedNotTriangles();
+
+    void roundTrip();
+    void roundTripCompressed();
+
+    /* Explicitly forbid system-wide plugin dependencies */
+    PluginManager::Manager<AbstractSceneConverter> _converterManager{"nonexistent"};
+    PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
+};
+
+constexpr MeshAttribute CustomAttribute = meshAttributeCustom(3);
+
+/* Positions, a custom array attribute and an attribute with an
+   implementation-specific format, with some padding at the end */
+struct Vertex {
+    Vector3 position;
+    Short custom[3];
+    UnsignedShort implementationSpecific;
+    Int padding;
+};
+
+constexpr UnsignedInt IndexData[]{0xdeadbeef, 2, 1, 0, 1};
+
+constexpr Vertex VertexData[]{
+    {{1.0f, 2.0f, 3.0f}, {1, 2, 3}, 0xaa, 0},
+    {{4.0f, 5.0f, 6.0f}, {4, 5, 6}, 0xbb, 0},
+    {{7.0f, 8.0f, 9.0f}, {7, 8, 9}, 0xcc, 0}
+};
+
+MeshData mesh() {
+    const Containers::StridedArrayView1D<const Vertex> vertices = VertexData;
+    return MeshData{MeshPrimitive::Triangles,
+        {}, IndexData, MeshIndexData{Containers::arrayView(IndexData).suffix(1)},
+        {}, VertexData, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{CustomAttribute, VertexFormat::Short,
+                vertices.slice(&Vertex::custom), 3},
+            MeshAttributeData{MeshAttribute::ObjectId, vertexFormatWrap(0x1234),
+                vertices.slice(&Vertex::implementationSpecific)}
+        }};
+}
+
+constexpr UnsignedShort TriangleIndexData[]{0, 1, 2, 2, 1, 0};
+
+/* Same as above, but with a whole number of triangles so the indices can be
+   compressed */
+MeshData triangleMesh() {
+    const Containers::StridedArrayView1D<const Vertex> vertices = VertexData;
+    return MeshData{MeshPrimitive::Triangles,
+        {}, TriangleIndexData, MeshIndexData{TriangleIndexData},
+        {}, VertexData, {
+            MeshAttributeData{MeshAttribute::Position, vertices.slice(&Vertex::position)},
+            MeshAttributeData{CustomAttribute, VertexFormat::Short,
+                vertices.slice(&Vertex::custom), 3},
+            MeshAttributeData{MeshAttribute::ObjectId, vertexFormatWrap(0x1234),
+                vertices.slice(&Vertex::implementationSpecific)}
+        }};
+}
+
+MagnumSceneConverterTest::MagnumSceneConverterTest() {
+    addTests({&MagnumSceneConverterTest::convert,
+              &MagnumSceneConverterTest::convertNonIndexed,
+              &MagnumSceneConverterTest::convertToFile,
+              &MagnumSceneConverterTest::convertCompressed,
+              &MagnumSceneConverterTest::convertCompressedNotTriangles,
+
+              &MagnumSceneConverterTest::roundTrip,
+              &MagnumSceneConverterTest::roundTripCompressed});
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef MAGNUMSCENECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_converterManager.load(MAGNUMSCENECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+    /* Optional plugins that don't have to be here */
+    #ifdef MAGNUMIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_importerManager.load(MAGNUMIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+
+    /* Create the output directory if it doesn't exist yet */
+    CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::mkpath(MAGNUMSCENECONVERTER_TEST_OUTPUT_DIR));
+}
+
+void MagnumSceneConverterTest::convert() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    CORRADE_COMPARE(converter->features(), SceneConverterFeature::ConvertMeshToData);
+
+    Containers::Array<char> data = converter->convertToData(mesh());
+    CORRADE_COMPARE(data.size(), 272);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.header.version, 1);
+    CORRADE_VERIFY(header.header.type == Implementation::BlobType::Mesh);
+    CORRADE_COMPARE(header.header.endianness, 0x0102);
+    CORRADE_COMPARE(header.header.size, 272);
+    CORRADE_COMPARE(MeshPrimitive(header.primitive), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(MeshIndexType(header.indexType), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(header.indexCount, 4);
+    CORRADE_COMPARE(header.vertexCount, 3);
+    CORRADE_COMPARE(header.attributeCount, 3);
+    CORRADE_COMPARE(header.flags, 0);
+
+    /* Header has 80 bytes, attributes 72, index data 20, vertex data 72.
+       Everything aligned to 16 bytes. */
+    CORRADE_COMPARE(header.indexDataOffset, 160);
+    CORRADE_COMPARE(header.indexDataSize, 20);
+    CORRADE_COMPARE(header.indexOffset, 4);
+    CORRADE_COMPARE(header.vertexDataOffset, 192);
+    CORRADE_COMPARE(header.vertexDataSize, 72);
+
+    const auto* attributes = reinterpret_cast<const Implementation::MeshAttributeBlob*>(data.data() + sizeof(Implementation::MeshBlobHeader));
+    CORRADE_COMPARE(MeshAttribute(attributes[0].name), MeshAttribute::Position);
+    CORRADE_COMPARE(VertexFormat(attributes[0].format), VertexFormat::Vector3);
+    CORRADE_COMPARE(attributes[0].offset, 0);
+    CORRADE_COMPARE(attributes[0].stride, sizeof(Vertex));
+    CORRADE_COMPARE(attributes[0].arraySize, 0);
+    CORRADE_COMPARE(MeshAttribute(attributes[1].name), CustomAttribute);
+    CORRADE_COMPARE(VertexFormat(attributes[1].format), VertexFormat::Short);
+    CORRADE_COMPARE(attributes[1].offset, 12);
+    CORRADE_COMPARE(attributes[1].arraySize, 3);
+    CORRADE_COMPARE(MeshAttribute(attributes[2].name), MeshAttribute::ObjectId);
+    CORRADE_COMPARE(VertexFormat(attributes[2].format), vertexFormatWrap(0x1234));
+    CORRADE_COMPARE(attributes[2].offset, 18);
+
+    /* The data are copied as-is, including the leading index */
+    CORRADE_COMPARE_AS(Containers::arrayCast<const UnsignedInt>(data.slice(160, 180)),
+        Containers::arrayView(IndexData),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.slice(192, 264),
+        Containers::arrayCast<const char>(Containers::arrayView(VertexData)),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::convertNonIndexed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const Vector3 positions[]{{1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}};
+    Containers::Array<char> data = converter->convertToData(MeshData{MeshPrimitive::Lines,
+        {}, positions, {
+            MeshAttributeData{MeshAttribute::Position, Containers::arrayView(positions)}
+        }});
+
+    /* Header has 80 bytes, attributes 24, vertex data 24 */
+    CORRADE_COMPARE(data.size(), 144);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(MeshPrimitive(header.primitive), MeshPrimitive::Lines);
+    CORRADE_COMPARE(header.indexType, 0);
+    CORRADE_COMPARE(header.indexCount, 0);
+    CORRADE_COMPARE(header.indexDataSize, 0);
+    CORRADE_COMPARE(header.vertexDataOffset, 112);
+    CORRADE_COMPARE(header.vertexDataSize, 24);
+    CORRADE_COMPARE(header.vertexCount, 2);
+}
+
+void MagnumSceneConverterTest::convertToFile() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+
+    const std::string filename = Utility::Directory::join(MAGNUMSCENECONVERTER_TEST_OUTPUT_DIR, "mesh.blob");
+    CORRADE_VERIFY(converter->convertToFile(filename, mesh()));
+    CORRADE_COMPARE_AS(Utility::Directory::read(filename),
+        converter->convertToData(mesh()),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::convertCompressed() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compressIndices", true);
+    converter->configuration().setValue("compressVertices", true);
+
+    const MeshData mesh = triangleMesh();
+    Containers::Array<char> data = converter->convertToData(mesh);
+    CORRADE_VERIFY(data);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.flags, Implementation::MeshBlobFlagCompressedIndices|Implementation::MeshBlobFlagCompressedVertices);
+    CORRADE_COMPARE(MeshIndexType(header.indexType), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(header.indexCount, 6);
+    CORRADE_COMPARE(header.indexOffset, 0);
+    CORRADE_COMPARE(header.vertexCount, 3);
+
+    /* The encoded data are stored instead of the original */
+    CORRADE_COMPARE_AS(data.slice(header.indexDataOffset, header.indexDataOffset + header.indexDataSize),
+        encodeIndexData(mesh),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(data.slice(header.vertexDataOffset, header.vertexDataOffset + header.vertexDataSize),
+        encodeVertexData(mesh),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::convertCompressedNotTriangles() {
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compressIndices", true);
+
+    /* Four indices can't be compressed, so they're stored as-is. Vertex
+       compression isn't enabled. */
+    Containers::Array<char> data = converter->convertToData(mesh());
+    CORRADE_VERIFY(data);
+
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(data.data());
+    CORRADE_COMPARE(header.flags, 0);
+    CORRADE_COMPARE_AS(data, converter->convertToData(mesh()),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(header.indexOffset, 4);
+    CORRADE_COMPARE(header.indexDataSize, 20);
+}
+
+void MagnumSceneConverterTest::roundTrip() {
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    Containers::Array<char> data = converter->convertToData(mesh());
+    CORRADE_VERIFY(data);
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    CORRADE_VERIFY(importer->openData(data));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedInt);
+    CORRADE_COMPARE(imported->indexOffset(), 4);
+    CORRADE_COMPARE_AS(imported->indices<UnsignedInt>(),
+        Containers::arrayView<UnsignedInt>({2, 1, 0, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 3);
+    CORRADE_COMPARE_AS(imported->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {1.0f, 2.0f, 3.0f}, {4.0f, 5.0f, 6.0f}, {7.0f, 8.0f, 9.0f}
+        }), TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->attributeArraySize(CustomAttribute), 3);
+    CORRADE_COMPARE_AS(imported->attribute<Short[]>(CustomAttribute)[2],
+        Containers::arrayView<Short>({7, 8, 9}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->attributeFormat(MeshAttribute::ObjectId), vertexFormatWrap(0x1234));
+    CORRADE_COMPARE(imported->attributeOffset(MeshAttribute::ObjectId), 18);
+    CORRADE_COMPARE(imported->attributeStride(MeshAttribute::ObjectId), sizeof(Vertex));
+    CORRADE_COMPARE_AS(imported->vertexData(),
+        Containers::arrayCast<const char>(Containers::arrayView(VertexData)),
+        TestSuite::Compare::Container);
+}
+
+void MagnumSceneConverterTest::roundTripCompressed() {
+    if(!(_importerManager.loadState("MagnumImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("MagnumImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractSceneConverter> converter = _converterManager.instantiate("MagnumSceneConverter");
+    converter->configuration().setValue("compressIndices", true);
+    converter->configuration().setValue("compressVertices", true);
+    Containers::Array<char> data = converter->convertToData(triangleMesh());
+    CORRADE_VERIFY(data);
+
+    /* Compressed data get decoded even with zero-copy import */
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("MagnumImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    CORRADE_VERIFY(importer->openData(data));
+
+    Containers::Optional<MeshData> imported = importer->mesh(0);
+    CORRADE_VERIFY(imported);
+    CORRADE_COMPARE(imported->indexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(imported->vertexDataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(imported->indexType(), MeshIndexType::UnsignedShort);
+    CORRADE_COMPARE(imported->indexOffset(), 0);
+    /* The second triangle shares an edge with the first and gets rotated */
+    CORRADE_COMPARE_AS(imported->indices<UnsignedShort>(),
+        Containers::arrayView<UnsignedShort>({0, 1, 2, 0, 2, 1}),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE(imported->vertexCount(), 3);
+    CORRADE_COMPARE(imported->attributeCount(), 3);
+    CORRADE_COMPARE(imported->attributeOffset(MeshAttribute::ObjectId), 18);
+    CORRADE_COMPARE_AS(imported->vertexData(),
+        Containers::arrayCast<const char>(Containers::arrayView(VertexData)),
+        TestSuite::Compare::Container);
+
+    /* Corrupted compressed data are detected only on import. Make the first
+       triangle reference an edge that doesn't exist yet. */
+    const auto& header = *reinterpret_cast<const Implementation::MeshBlobHeader*>(data.data());
+    data[header.indexDataOffset + 8] = '\x01';
+    CORRADE_VERIFY(importer->openData(data));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(),
+        "Trade::decodeIndexBuffer(): invalid data for triangle 0\n"
+        "Trade::MagnumImporter::mesh(): can't decode indices of mesh 0\n");
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::MagnumSceneConverterTest)
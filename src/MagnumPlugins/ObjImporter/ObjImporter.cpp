@@ -25,16 +25,18 @@
 
 #include "ObjImporter.h"
 
-#include <fstream>
-#include <limits>
-#include <sstream>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
 #include <unordered_map>
+#include <vector>
 #include <Corrade/Containers/GrowableArray.h>
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/DebugStl.h>
-#include <Corrade/Utility/String.h>
 
+#include "Magnum/Implementation/threads.h"
 #include "Magnum/Mesh.h"
 #include "Magnum/MeshTools/CompressIndices.h"
 #include "Magnum/MeshTools/RemoveDuplicates.h"
@@ -45,39 +47,136 @@
 namespace Magnum { namespace Trade {
 
 struct ObjImporter::File {
+    struct Mesh {
+        /* Byte range in the file */
+        std::size_t begin, end;
+        /* Indices of the first vertex data in this mesh, 1-based */
+        UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
+    };
+
     std::unordered_map<std::string, UnsignedInt> meshesForName;
     std::vector<std::string> meshNames;
-    std::vector<std::tuple<std::streampos, std::streampos, UnsignedInt, UnsignedInt, UnsignedInt>> meshes;
-    Containers::Pointer<std::istream> in;
+    Containers::Array<Mesh> meshes;
+    /* Copy of the file contents with a null terminator at the end, so
+       std::strtof() can be used directly on it */
+    Containers::Array<char> data;
 };
 
 namespace {
 
-void ignoreLine(std::istream& in) {
-    in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
 }
 
-template<std::size_t size> Math::Vector<size, Float> extractFloatData(const std::string& str, Float* extra = nullptr) {
-    std::vector<std::string> data = Utility::String::splitWithoutEmptyParts(str, ' ');
-    if(data.size() < size || data.size() > size + (extra ? 1 : 0)) {
-        Error() << "Trade::ObjImporter::mesh(): invalid float array size";
-        throw 0;
+/* A single line, trimmed and split into a keyword and its contents */
+struct Line {
+    const char* keywordBegin;
+    const char* keywordEnd;
+    const char* contentsBegin;
+    const char* contentsEnd;
+
+    bool isKeyword(const char* keyword) const {
+        const std::size_t size = std::strlen(keyword);
+        return std::size_t(keywordEnd - keywordBegin) == size && std::memcmp(keywordBegin, keyword, size) == 0;
     }
+};
+
+/* Parses the line starting at `it`, moves `it` past its end. Returns false if
+   the line is empty or a comment. */
+bool parseLine(const char*& it, const char* const end, Line& line) {
+    const char* lineEnd = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    if(!lineEnd) lineEnd = end;
+
+    const char* begin = it;
+    it = lineEnd == end ? end : lineEnd + 1;
+
+    /* Trim the line */
+    while(begin != lineEnd && isWhitespace(*begin)) ++begin;
+    while(lineEnd != begin && isWhitespace(*(lineEnd - 1))) --lineEnd;
+
+    /* Ignore empty lines and comments */
+    if(begin == lineEnd || *begin == '#') return false;
+
+    line.keywordBegin = begin;
+    while(begin != lineEnd && !isWhitespace(*begin)) ++begin;
+    line.keywordEnd = begin;
+    while(begin != lineEnd && isWhitespace(*begin)) ++begin;
+    line.contentsBegin = begin;
+    line.contentsEnd = lineEnd;
+    return true;
+}
 
-    Math::Vector<size, Float> output;
+/* Finds the end of a token starting at `it` */
+const char* tokenEnd(const char* it, const char* const end) {
+    while(it != end && !isWhitespace(*it)) ++it;
+    return it;
+}
+
+const char* nextToken(const char* it, const char* const end) {
+    while(it != end && isWhitespace(*it)) ++it;
+    return it;
+}
+
+std::size_t tokenCount(const char* it, const char* const end) {
+    std::size_t count = 0;
+    while((it = nextToken(it, end)) != end) {
+        it = tokenEnd(it, end);
+        ++count;
+    }
+    return count;
+}
 
-    for(std::size_t i = 0; i != size; ++i)
-        output[i] = std::stof(data[i]);
+/* The token is always followed by a whitespace, a newline or the null
+   terminator, so std::strtof() can't run past it. Unlike std::stof(), no
+   std::string is allocated for the conversion. */
+bool parseFloat(const char* const begin, const char* const end, Float& out, std::ostream* const errorOutput) {
+    char* parsedEnd;
+    errno = 0;
+    out = std::strtof(begin, &parsedEnd);
+    if(parsedEnd != end || errno == ERANGE) {
+        Error{errorOutput} << "Trade::ObjImporter::mesh(): error while converting numeric data";
+        return false;
+    }
+    return true;
+}
 
-    if(data.size() == size+1) {
+bool parseIndex(const char* begin, const char* const end, UnsignedInt& out, std::ostream* const errorOutput) {
+    if(begin == end) {
+        Error{errorOutput} << "Trade::ObjImporter::mesh(): error while converting numeric data";
+        return false;
+    }
+
+    unsigned long long value = 0;
+    for(; begin != end; ++begin) {
+        if(*begin < '0' || *begin > '9' || (value = value*10 + (*begin - '0')) > 0xffffffffull) {
+            Error{errorOutput} << "Trade::ObjImporter::mesh(): error while converting numeric data";
+            return false;
+        }
+    }
+
+    out = UnsignedInt(value);
+    return true;
+}
+
+template<std::size_t size> bool extractFloatData(const Line& line, Math::Vector<size, Float>& output, std::ostream* const errorOutput, Float* extra = nullptr) {
+    const std::size_t count = tokenCount(line.contentsBegin, line.contentsEnd);
+    if(count < size || count > size + (extra ? 1 : 0)) {
+        Error{errorOutput} << "Trade::ObjImporter::mesh(): invalid float array size";
+        return false;
+    }
+
+    const char* it = line.contentsBegin;
+    for(std::size_t i = 0; i != count; ++i) {
+        it = nextToken(it, line.contentsEnd);
+        const char* const end = tokenEnd(it, line.contentsEnd);
         /* This should be obvious from the first if, but add this just to make
            Clang Analyzer happy */
-        CORRADE_INTERNAL_ASSERT(extra);
-
-        *extra = std::stof(data.back());
+        CORRADE_INTERNAL_ASSERT(i < size || extra);
+        if(!parseFloat(it, end, i < size ? output[i] : *extra, errorOutput)) return false;
+        it = end;
     }
 
-    return output;
+    return true;
 }
 
 }
@@ -88,63 +187,47 @@ ObjImporter::ObjImporter(PluginManager::AbstractManager& manager, const std::str
 
 ObjImporter::~ObjImporter() = default;
 
-ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures ObjImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::ConcurrentImport; }
 
 void ObjImporter::doClose() { _file.reset(); }
 
 bool ObjImporter::doIsOpened() const { return !!_file; }
 
-void ObjImporter::doOpenFile(const std::string& filename) {
-    Containers::Pointer<std::istream> in{new std::ifstream{filename, std::ios::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
-    _file.reset(new File);
-    _file->in = std::move(in);
-    parseMeshNames();
-}
-
 void ObjImporter::doOpenData(Containers::ArrayView<const char> data) {
     _file.reset(new File);
-    _file->in.reset(new std::istringstream{{data.begin(), data.size()}});
+    _file->data = Containers::Array<char>{Containers::NoInit, data.size() + 1};
+    std::memcpy(_file->data.data(), data.data(), data.size());
+    _file->data[data.size()] = '\0';
 
     parseMeshNames();
 }
 
 void ObjImporter::parseMeshNames() {
+    const char* const begin = _file->data.data();
+    const char* const end = _file->data.end() - 1;
+
     /* First mesh starts at the beginning, its indices start from 1. The end
        offset will be updated to proper value later. */
     UnsignedInt positionIndexOffset = 1;
     UnsignedInt normalIndexOffset = 1;
     UnsignedInt textureCoordinateIndexOffset = 1;
-    _file->meshes.emplace_back(0, 0, positionIndexOffset, normalIndexOffset, textureCoordinateIndexOffset);
+    arrayAppend(_file->meshes, File::Mesh{0, 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset});
 
     /* The first mesh doesn't have name by default but we might find it later,
        so we need to track whether there are any data before first name */
     bool thisIsFirstMeshAndItHasNoData = true;
     _file->meshNames.emplace_back();
 
-    while(_file->in->good()) {
+    for(const char* it = begin; it != end; ) {
         /* The previous object might end at the beginning of this line */
-        const std::streampos end = _file->in->tellg();
-
-        /* Comment line */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
+        const std::size_t lineBegin = it - begin;
 
-        /* Parse the keyword */
-        std::string keyword;
-        *_file->in >> keyword;
+        Line line;
+        if(!parseLine(it, end, line)) continue;
 
         /* Mesh name */
-        if(keyword == "o") {
-            std::string name;
-            std::getline(*_file->in, name);
-            name = Utility::String::trim(name);
+        if(line.isKeyword("o")) {
+            std::string name{line.contentsBegin, line.contentsEnd};
 
             /* This is the name of first mesh */
             if(thisIsFirstMeshAndItHasNoData) {
@@ -156,54 +239,44 @@ void ObjImporter::parseMeshNames() {
                 _file->meshNames.back() = std::move(name);
 
                 /* Update its begin offset to be more precise */
-                std::get<0>(_file->meshes.back()) = _file->in->tellg();
+                _file->meshes.back().begin = it - begin;
 
             /* Otherwise this is a name of new mesh */
             } else {
                 /* Set end of the previous one */
-                std::get<1>(_file->meshes.back()) = end;
+                _file->meshes.back().end = lineBegin;
 
                 /* Save name and offset of the new one. The end offset will be
                    updated later. */
                 if(!name.empty())
                     _file->meshesForName.emplace(name, _file->meshes.size());
                 _file->meshNames.emplace_back(std::move(name));
-                _file->meshes.emplace_back(_file->in->tellg(), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset);
+                arrayAppend(_file->meshes, File::Mesh{std::size_t(it - begin), 0, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset});
             }
 
-            continue;
-
         /* If there are any data/indices before the first name, it means that
            the first object is unnamed. We need to check for them. */
 
         /* Vertex data, update index offset for the following meshes */
-        } else if(keyword == "v") {
+        } else if(line.isKeyword("v")) {
             ++positionIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vt") {
+        } else if(line.isKeyword("vt")) {
             ++textureCoordinateIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
-        } else if(keyword == "vn") {
+        } else if(line.isKeyword("vn")) {
             ++normalIndexOffset;
             thisIsFirstMeshAndItHasNoData = false;
 
         /* Index data, just mark that we found something for first unnamed
            object */
-        } else if(thisIsFirstMeshAndItHasNoData) for(const std::string& data: {"p", "l", "f"}) {
-            if(keyword == data) {
-                thisIsFirstMeshAndItHasNoData = false;
-                break;
-            }
+        } else if(line.isKeyword("p") || line.isKeyword("l") || line.isKeyword("f")) {
+            thisIsFirstMeshAndItHasNoData = false;
         }
-
-        /* Ignore the rest of the line */
-        ignoreLine(*_file->in);
     }
 
     /* Set end of the last object */
-    _file->in->clear();
-    _file->in->seekg(0, std::ios::end);
-    std::get<1>(_file->meshes.back()) = _file->in->tellg();
+    _file->meshes.back().end = end - begin;
 }
 
 UnsignedInt ObjImporter::doMeshCount() const { return _file->meshes.size(); }
@@ -233,13 +306,10 @@ template<class T> bool checkAndDuplicateInto(const Containers::StridedArrayView1
 
 }
 
-Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
-    /* Seek the file, set mesh parsing parameters */
-    std::streampos begin, end;
-    UnsignedInt positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset;
-    std::tie(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset) = _file->meshes[id];
-    _file->in->seekg(begin);
+namespace {
 
+/* Data parsed from a contiguous range of lines */
+struct MeshChunk {
     Containers::Optional<MeshPrimitive> primitive;
     Containers::Array<Vector3> positions;
     Containers::Array<Vector3> normals;
@@ -248,157 +318,250 @@ Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt)
        of data. First positions, then normals, then texture coordinates. */
     Containers::Array<Vector3ui> indices;
     std::size_t textureCoordinateIndexCount = 0, normalIndexCount = 0;
+};
 
-    try { while(_file->in->good() && _file->in->tellg() < end) {
-        /* Ignore comments */
-        if(_file->in->peek() == '#') {
-            ignoreLine(*_file->in);
-            continue;
-        }
-
-        /* Get the line */
-        std::string line;
-        std::getline(*_file->in, line);
-        line = Utility::String::trim(line);
-
-        /* Ignore empty lines */
-        if(line.empty()) continue;
-
-        /* Split the line into keyword and contents */
-        const std::size_t keywordEnd = line.find(' ');
-        const std::string keyword = line.substr(0, keywordEnd);
-        const std::string contents = keywordEnd != std::string::npos ?
-            Utility::String::ltrim(line.substr(keywordEnd+1)) : "";
+/* Parses lines in given range. As the indices are absolute in the file, the
+   file can be split at arbitrary line boundaries and the parts parsed
+   independently. */
+bool parseMeshChunk(const char* it, const char* const end, const UnsignedInt positionIndexOffset, const UnsignedInt textureCoordinateIndexOffset, const UnsignedInt normalIndexOffset, MeshChunk& out, std::ostream* const errorOutput) {
+    while(it != end) {
+        /* Ignore empty lines and comments */
+        Line line;
+        if(!parseLine(it, end, line)) continue;
 
         /* Vertex position */
-        if(keyword == "v") {
+        if(line.isKeyword("v")) {
             Float extra{1.0f};
-            const Vector3 data = extractFloatData<3>(contents, &extra);
+            Vector3 data;
+            if(!extractFloatData<3>(line, data, errorOutput, &extra))
+                return false;
             if(!Math::TypeTraits<Float>::equals(extra, 1.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
-                return Containers::NullOpt;
+                Error{errorOutput} << "Trade::ObjImporter::mesh(): homogeneous coordinates are not supported";
+                return false;
             }
 
-            arrayAppend(positions, data);
+            arrayAppend(out.positions, data);
 
         /* Texture coordinate */
-        } else if(keyword == "vt") {
+        } else if(line.isKeyword("vt")) {
             Float extra{0.0f};
-            const Vector2 data = extractFloatData<2>(contents, &extra);
+            Vector2 data;
+            if(!extractFloatData<2>(line, data, errorOutput, &extra))
+                return false;
             if(!Math::TypeTraits<Float>::equals(extra, 0.0f)) {
-                Error() << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
-                return Containers::NullOpt;
+                Error{errorOutput} << "Trade::ObjImporter::mesh(): 3D texture coordinates are not supported";
+                return false;
             }
 
-            arrayAppend(textureCoordinates, data);
+            arrayAppend(out.textureCoordinates, data);
 
         /* Normal */
-        } else if(keyword == "vn") {
-            arrayAppend(normals, Vector3{extractFloatData<3>(contents)});
+        } else if(line.isKeyword("vn")) {
+            Vector3 data;
+            if(!extractFloatData<3>(line, data, errorOutput))
+                return false;
+
+            arrayAppend(out.normals, data);
 
         /* Indices */
-        } else if(keyword == "p" || keyword == "l" || keyword == "f") {
-            const std::vector<std::string> indexTuples = Utility::String::splitWithoutEmptyParts(contents, ' ');
+        } else if(line.isKeyword("p") || line.isKeyword("l") || line.isKeyword("f")) {
+            const std::size_t indexTupleCount = tokenCount(line.contentsBegin, line.contentsEnd);
 
             /* Points */
-            if(keyword == "p") {
+            if(line.isKeyword("p")) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Points) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Points;
-                    return Containers::NullOpt;
+                if(out.primitive && out.primitive != MeshPrimitive::Points) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Points;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 1) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for point";
-                    return Containers::NullOpt;
+                if(indexTupleCount != 1) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): wrong index count for point";
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Points;
+                out.primitive = MeshPrimitive::Points;
 
             /* Lines */
-            } else if(keyword == "l") {
+            } else if(line.isKeyword("l")) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Lines) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Lines;
-                    return Containers::NullOpt;
+                if(out.primitive && out.primitive != MeshPrimitive::Lines) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Lines;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() != 2) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for line";
-                    return Containers::NullOpt;
+                if(indexTupleCount != 2) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): wrong index count for line";
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Lines;
+                out.primitive = MeshPrimitive::Lines;
 
             /* Faces */
-            } else if(keyword == "f") {
+            } else if(line.isKeyword("f")) {
                 /* Check that we don't mix the primitives in one mesh */
-                if(primitive && primitive != MeshPrimitive::Triangles) {
-                    Error() << "Trade::ObjImporter::mesh(): mixed primitive" << *primitive << "and" << MeshPrimitive::Triangles;
-                    return Containers::NullOpt;
+                if(out.primitive && out.primitive != MeshPrimitive::Triangles) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): mixed primitive" << *out.primitive << "and" << MeshPrimitive::Triangles;
+                    return false;
                 }
 
                 /* Check vertex count per primitive */
-                if(indexTuples.size() < 3) {
-                    Error() << "Trade::ObjImporter::mesh(): wrong index count for triangle";
-                    return Containers::NullOpt;
-                } else if(indexTuples.size() != 3) {
-                    Error() << "Trade::ObjImporter::mesh(): polygons are not supported";
-                    return Containers::NullOpt;
+                if(indexTupleCount < 3) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): wrong index count for triangle";
+                    return false;
+                } else if(indexTupleCount != 3) {
+                    Error{errorOutput} << "Trade::ObjImporter::mesh(): polygons are not supported";
+                    return false;
                 }
 
-                primitive = MeshPrimitive::Triangles;
+                out.primitive = MeshPrimitive::Triangles;
 
             } else CORRADE_INTERNAL_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 
-            for(const std::string& indexTuple: indexTuples) {
-                std::vector<std::string> indexStrings = Utility::String::split(indexTuple, '/');
-                if(indexStrings.size() > 3) {
-                    Error() << "Trade::ObjImporter::mesh(): invalid index data";
-                    return Containers::NullOpt;
+            const char* tupleIt = line.contentsBegin;
+            for(std::size_t i = 0; i != indexTupleCount; ++i) {
+                tupleIt = nextToken(tupleIt, line.contentsEnd);
+                const char* const tupleEnd = tokenEnd(tupleIt, line.contentsEnd);
+
+                /* Split the tuple on slashes */
+                const char* parts[4]{tupleIt};
+                std::size_t partCount = 1;
+                for(const char* c = tupleIt; c != tupleEnd; ++c) if(*c == '/') {
+                    if(partCount == 3) {
+                        Error{errorOutput} << "Trade::ObjImporter::mesh(): invalid index data";
+                        return false;
+                    }
+                    parts[partCount++] = c + 1;
                 }
+                parts[partCount] = tupleEnd + 1;
 
                 Vector3ui index;
 
                 /* Position indices */
-                index[0] = std::stoul(indexStrings[0]) - positionIndexOffset;
+                if(!parseIndex(parts[0], parts[1] - 1, index[0], errorOutput))
+                    return false;
+                index[0] -= positionIndexOffset;
 
                 /* Texture coordinates */
-                if(indexStrings.size() == 2 || (indexStrings.size() == 3 && !indexStrings[1].empty())) {
-                    index[2] = std::stoul(indexStrings[1]) - textureCoordinateIndexOffset;
-                    ++textureCoordinateIndexCount;
+                if(partCount == 2 || (partCount == 3 && parts[2] - parts[1] > 1)) {
+                    if(!parseIndex(parts[1], parts[2] - 1, index[2], errorOutput))
+                        return false;
+                    index[2] -= textureCoordinateIndexOffset;
+                    ++out.textureCoordinateIndexCount;
                 }
 
                 /* Normal indices */
-                if(indexStrings.size() == 3) {
-                    index[1] = std::stoul(indexStrings[2]) - normalIndexOffset;
-                    ++normalIndexCount;
+                if(partCount == 3) {
+                    if(!parseIndex(parts[2], parts[3] - 1, index[1], errorOutput))
+                        return false;
+                    index[1] -= normalIndexOffset;
+                    ++out.normalIndexCount;
                 }
 
-                arrayAppend(indices, index);
+                arrayAppend(out.indices, index);
+                tupleIt = tupleEnd;
             }
 
         /* Ignore unsupported keywords, error out on unknown keywords */
-        } else if(![&keyword](){
-            /* Using lambda to emulate for-else construct like in Python */
-            for(const std::string expected: {"mtllib", "usemtl", "g", "s"})
-                if(keyword == expected) return true;
+        } else if(!line.isKeyword("mtllib") && !line.isKeyword("usemtl") && !line.isKeyword("g") && !line.isKeyword("s")) {
+            Error{errorOutput} << "Trade::ObjImporter::mesh(): unknown keyword" << std::string{line.keywordBegin, line.keywordEnd};
             return false;
-        }()) {
-            Error() << "Trade::ObjImporter::mesh(): unknown keyword" << keyword;
+        }
+    }
+
+    return true;
+}
+
+/* Meshes smaller than this are not split further */
+constexpr std::size_t MinBytesPerThread = 64*1024;
+
+/* Moves the position to the beginning of the next line */
+const char* nextLine(const char* const it, const char* const end) {
+    const char* const lineEnd = static_cast<const char*>(std::memchr(it, '\n', end - it));
+    return lineEnd ? lineEnd + 1 : end;
+}
+
+}
+
+Containers::Optional<MeshData> ObjImporter::doMesh(UnsignedInt id, UnsignedInt) {
+    /* Set mesh parsing parameters */
+    const File::Mesh& mesh = _file->meshes[id];
+    const UnsignedInt positionIndexOffset = mesh.positionIndexOffset;
+    const UnsignedInt textureCoordinateIndexOffset = mesh.textureCoordinateIndexOffset;
+    const UnsignedInt normalIndexOffset = mesh.normalIndexOffset;
+    const char* const begin = _file->data.data() + mesh.begin;
+    const char* const end = _file->data.data() + mesh.end;
+
+    /* Split the mesh into chunks of whole lines, each parsed on a separate
+       thread. Small meshes use less threads, as there the threading overhead
+       would outweigh the gains. */
+    UnsignedInt threadCount = Magnum::Implementation::resolveThreadCount(configuration().value<UnsignedInt>("threads"));
+    threadCount = Math::max(UnsignedInt(Math::min(std::size_t(threadCount), std::size_t(end - begin)/MinBytesPerThread)), 1u);
+    Containers::Array<const char*> chunkBoundaries{Containers::NoInit, threadCount + 1};
+    chunkBoundaries[0] = begin;
+    for(UnsignedInt i = 1; i != threadCount; ++i) {
+        /* Move to a start of a line at or after the split point */
+        const char* const split = std::min(std::max(begin + std::size_t(end - begin)*i/threadCount, chunkBoundaries[i - 1] + 1), end);
+        chunkBoundaries[i] = nextLine(split - 1, end);
+    }
+    chunkBoundaries[threadCount] = end;
+
+    Containers::Array<MeshChunk> chunks{threadCount};
+    if(threadCount == 1) {
+        if(!parseMeshChunk(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunks[0], Error::output()))
             return Containers::NullOpt;
+    } else {
+        /* Errors are not printed from the threads, as their order wouldn't be
+           deterministic */
+        Containers::Array<bool> chunkSucceeded{Containers::ValueInit, threadCount};
+        Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+            chunkSucceeded[thread] = parseMeshChunk(chunkBoundaries[thread], chunkBoundaries[thread + 1], positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunks[thread], nullptr);
+        });
+
+        /* The chunks can't fail individually and primitives can't be mixed
+           across chunks either */
+        bool succeeded = true;
+        Containers::Optional<MeshPrimitive> chunkPrimitive;
+        for(std::size_t i = 0; i != threadCount; ++i) {
+            if(!chunkSucceeded[i]) succeeded = false;
+            if(!chunks[i].primitive) continue;
+            if(chunkPrimitive && *chunkPrimitive != *chunks[i].primitive)
+                succeeded = false;
+            chunkPrimitive = chunks[i].primitive;
         }
 
-    }} catch(const std::exception&) {
-        Error() << "Trade::ObjImporter::mesh(): error while converting numeric data";
-        return Containers::NullOpt;
-    } catch(...) {
-        /* Error message already printed */
-        return Containers::NullOpt;
+        /* On failure parse the whole mesh again on this thread to print the
+           first error in the file */
+        if(!succeeded) {
+            MeshChunk chunk;
+            CORRADE_INTERNAL_ASSERT_OUTPUT(!parseMeshChunk(begin, end, positionIndexOffset, textureCoordinateIndexOffset, normalIndexOffset, chunk, Error::output()));
+            return Containers::NullOpt;
+        }
+
+        /* Merge the chunks into the first one, in order */
+        MeshChunk& out = chunks[0];
+        for(std::size_t i = 1; i != threadCount; ++i) {
+            MeshChunk& chunk = chunks[i];
+            if(!out.primitive) out.primitive = chunk.primitive;
+            arrayAppend(out.positions, chunk.positions);
+            arrayAppend(out.normals, chunk.normals);
+            arrayAppend(out.textureCoordinates, chunk.textureCoordinates);
+            arrayAppend(out.indices, chunk.indices);
+            out.textureCoordinateIndexCount += chunk.textureCoordinateIndexCount;
+            out.normalIndexCount += chunk.normalIndexCount;
+        }
     }
 
+    const Containers::Optional<MeshPrimitive>& primitive = chunks[0].primitive;
+    const Containers::Array<Vector3>& positions = chunks[0].positions;
+    const Containers::Array<Vector3>& normals = chunks[0].normals;
+    const Containers::Array<Vector2>& textureCoordinates = chunks[0].textureCoordinates;
+    Containers::Array<Vector3ui>& indices = chunks[0].indices;
+    const std::size_t textureCoordinateIndexCount = chunks[0].textureCoordinateIndexCount;
+    const std::size_t normalIndexCount = chunks[0].normalIndexCount;
+
     /* There should be at least indexed position data */
     if(positions.empty() || indices.empty()) {
         Error() << "Trade::ObjImporter::mesh(): incomplete position data";
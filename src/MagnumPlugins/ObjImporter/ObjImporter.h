@@ -98,6 +98,27 @@ positions with optional @ref VertexFormat::Vector3 normals and
 @ref VertexFormat::Vector2 texture coordinates, if present in the source file.
 
 Polygons (quads etc.) and material properties are currently not supported.
+
+The file is copied into memory on opening and the meshes are parsed directly
+from it, without any allocations except for the output data. The importer
+supports @ref ImporterFeature::ConcurrentImport, different meshes can be
+imported from multiple threads at the same time.
+
+A single mesh can be parsed on multiple threads as well, by setting the
+@cb{.ini} threads @ce @ref Trade-ObjImporter-configuration "configuration option".
+The mesh is split into chunks of whole lines that are parsed independently and
+then concatenated in order, so the result is the same as with a single thread.
+If parsing fails, the mesh is parsed again on the calling thread in order to
+report the first error in the file.
+
+@section Trade-ObjImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/ObjImporter/ObjImporter.conf configuration_
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
     public:
@@ -116,7 +137,6 @@ class MAGNUM_OBJIMPORTER_EXPORT ObjImporter: public AbstractImporter {
 
         MAGNUM_OBJIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_OBJIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
-        MAGNUM_OBJIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_OBJIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_OBJIMPORTER_LOCAL UnsignedInt doMeshCount() const override;
@@ -0,0 +1,152 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/FormatStl.h>
+
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/MeshData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Reports parsed OBJ bytes per second. The input size can be changed with
+   --input-size, in megabytes. */
+
+struct ObjImporterBenchmark: TestSuite::Tester {
+    explicit ObjImporterBenchmark();
+
+    void mesh();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    private:
+        std::size_t _inputSize;
+        std::size_t _bytes;
+        std::chrono::high_resolution_clock::time_point _begin;
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    bool textureCoordinates, normals;
+} AttributeData[]{
+    {"positions", false, false},
+    {"positions, normals", false, true},
+    {"positions, texture coordinates, normals", true, true}
+};
+
+ObjImporterBenchmark::ObjImporterBenchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"input"})} {
+    addCustomInstancedBenchmarks({&ObjImporterBenchmark::mesh}, 5,
+        Containers::arraySize(AttributeData),
+        &ObjImporterBenchmark::throughputBegin,
+        &ObjImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+
+    Utility::Arguments args{"input"};
+    args.addOption("size", "16").setHelp("size", "approximate file size", "MB")
+        .parse(arguments().first, arguments().second);
+    _inputSize = args.value<std::size_t>("size")*1024*1024;
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef OBJIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void ObjImporterBenchmark::throughputBegin() {
+    _bytes = 0;
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t ObjImporterBenchmark::throughputEnd() {
+    const std::uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return duration ? _bytes*1000000000ull/duration : 0;
+}
+
+/* A grid with two triangles per cell, roughly 50 bytes per vertex plus 30
+   bytes per face and attribute */
+std::string generateObj(const bool textureCoordinates, const bool normals, const std::size_t byteCount) {
+    const std::size_t size = std::size_t(std::sqrt(Double(byteCount)/(80 + (textureCoordinates + normals)*80)));
+
+    std::string out;
+    out.reserve(byteCount + byteCount/4);
+    for(std::size_t y = 0; y != size; ++y) for(std::size_t x = 0; x != size; ++x)
+        out += Utility::formatString("v {} {} {}\n", Float(x)/size, Float(y)/size, Float(x*y % 7)*0.01f);
+    if(textureCoordinates)
+        for(std::size_t y = 0; y != size; ++y) for(std::size_t x = 0; x != size; ++x)
+            out += Utility::formatString("vt {} {}\n", Float(x)/size, Float(y)/size);
+    if(normals)
+        for(std::size_t y = 0; y != size; ++y) for(std::size_t x = 0; x != size; ++x)
+            out += Utility::formatString("vn {} {} {}\n", Float(x % 3)*0.1f, Float(y % 3)*0.1f, 0.98f);
+
+    const char* const faceFormat =
+        textureCoordinates ? "{0}/{0}/{0}" :
+        normals ? "{0}//{0}" : "{0}";
+    const auto vertex = [&](std::size_t x, std::size_t y) {
+        return Utility::formatString(faceFormat, y*size + x + 1);
+    };
+    for(std::size_t y = 0; y + 1 < size; ++y) for(std::size_t x = 0; x + 1 < size; ++x) {
+        out += "f " + vertex(x, y) + ' ' + vertex(x + 1, y) + ' ' + vertex(x + 1, y + 1) + '\n';
+        out += "f " + vertex(x, y) + ' ' + vertex(x + 1, y + 1) + ' ' + vertex(x, y + 1) + '\n';
+    }
+
+    return out;
+}
+
+void ObjImporterBenchmark::mesh() {
+    auto&& data = AttributeData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const std::string obj = generateObj(data.textureCoordinates, data.normals, _inputSize);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+
+    /* The file is parsed on open and when importing the mesh, so measure
+       both */
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({obj.data(), obj.size()}));
+        mesh = importer->mesh(0);
+        _bytes += obj.size();
+    }
+
+    CORRADE_VERIFY(mesh);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterBenchmark)
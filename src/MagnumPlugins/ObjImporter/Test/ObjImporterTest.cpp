@@ -33,6 +33,7 @@
 #include "Magnum/Mesh.h"
 #include "Magnum/Math/Vector3.h"
 #include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/AsyncImporter.h"
 #include "Magnum/Trade/MeshData.h"
 
 #include "configure.h"
@@ -92,10 +93,26 @@ struct ObjImporterTest: TestSuite::Tester {
     void unsupportedKeyword();
     void unknownKeyword();
 
+    void windowsLineEndings();
+    void concurrentImport();
+    void threaded();
+    void threadedError();
+
+    void benchmark();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
 
+const struct {
+    const char* name;
+    UnsignedInt threadCount;
+} ThreadedData[]{
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0}
+};
+
 ObjImporterTest::ObjImporterTest() {
     addTests({&ObjImporterTest::pointMesh,
               &ObjImporterTest::lineMesh,
@@ -145,7 +162,18 @@ ObjImporterTest::ObjImporterTest() {
               &ObjImporterTest::wrongNormalIndexCount,
 
               &ObjImporterTest::unsupportedKeyword,
-              &ObjImporterTest::unknownKeyword});
+              &ObjImporterTest::unknownKeyword,
+
+              &ObjImporterTest::windowsLineEndings,
+              &ObjImporterTest::concurrentImport});
+
+    addInstancedTests({&ObjImporterTest::threaded},
+        Containers::arraySize(ThreadedData));
+
+    addTests({&ObjImporterTest::threadedError});
+
+    addInstancedBenchmarks({&ObjImporterTest::benchmark}, 5,
+        Containers::arraySize(ThreadedData));
 
     #ifdef OBJIMPORTER_PLUGIN_FILENAME
     CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(OBJIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
@@ -797,6 +825,145 @@ void ObjImporterTest::unknownKeyword() {
     CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): unknown keyword bleh\n");
 }
 
+void ObjImporterTest::windowsLineEndings() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_VERIFY(importer->openData(
+        "# A comment\r\n"
+        "o MeshName \r\n"
+        "v 0.5 2 3\r\n"
+        "v 0 1.5 1\r\n"
+        "\r\n"
+        "l 1 2\r\n"));
+    CORRADE_COMPARE(importer->meshCount(), 1);
+    CORRADE_COMPARE(importer->meshName(0), "MeshName");
+
+    const Containers::Optional<MeshData> data = importer->mesh(0);
+    CORRADE_VERIFY(data);
+    CORRADE_COMPARE(data->primitive(), MeshPrimitive::Lines);
+    CORRADE_COMPARE_AS(data->attribute<Vector3>(MeshAttribute::Position),
+        Containers::arrayView<Vector3>({
+            {0.5f, 2.0f, 3.0f},
+            {0.0f, 1.5f, 1.0f}
+        }), TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::concurrentImport() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_COMPARE(importer->features(), ImporterFeature::OpenData|ImporterFeature::ConcurrentImport);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(OBJIMPORTER_TEST_DIR, "moreMeshes.obj")));
+    CORRADE_COMPARE(importer->meshCount(), 3);
+
+    /* Import each mesh on its own thread, the results should be the same as
+       when importing serially */
+    AsyncImporter async{*importer, 3};
+    std::future<Containers::Optional<MeshData>> futures[]{
+        async.mesh(0), async.mesh(1), async.mesh(2)
+    };
+    const MeshPrimitive expected[]{
+        MeshPrimitive::Points, MeshPrimitive::Lines, MeshPrimitive::Triangles
+    };
+    for(std::size_t i = 0; i != 3; ++i) {
+        CORRADE_ITERATION(i);
+        Containers::Optional<MeshData> data = futures[i].get();
+        CORRADE_VERIFY(data);
+        CORRADE_COMPARE(data->primitive(), expected[i]);
+    }
+}
+
+/* A grid of size x size quads with positions, texture coordinates and
+   normals. If errorLine is non-empty, it's put in the middle of the faces. */
+std::string grid(const Int size, const char* const errorLine = "") {
+    std::ostringstream out;
+    out << "o Grid\n";
+    for(Int y = 0; y <= size; ++y) for(Int x = 0; x <= size; ++x)
+        out << "v " << x*0.125f << " " << y*0.125f << " " << (x*y % 7)*0.5f << "\n";
+    for(Int y = 0; y <= size; ++y) for(Int x = 0; x <= size; ++x)
+        out << "vt " << Float(x)/size << " " << Float(y)/size << "\n";
+    out << "vn 0 0 1\n";
+    for(Int y = 0; y != size; ++y) for(Int x = 0; x != size; ++x) {
+        if(y == size/2 && x == 0) out << errorLine;
+        const Int a = y*(size + 1) + x + 1;
+        const Int b = a + 1;
+        const Int c = a + size + 1;
+        const Int d = c + 1;
+        out << "f " << a << "/" << a << "/1 " << b << "/" << b << "/1 " << d << "/" << d << "/1\n"
+            << "f " << a << "/" << a << "/1 " << d << "/" << d << "/1 " << c << "/" << c << "/1\n";
+    }
+    return out.str();
+}
+
+void ObjImporterTest::threaded() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* About 300 kB of text, so it's split into at least four chunks */
+    const std::string file = grid(64);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    CORRADE_COMPARE(importer->configuration().value<UnsignedInt>("threads"), 1);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+    Containers::Optional<MeshData> expected = importer->mesh(0);
+    CORRADE_VERIFY(expected);
+
+    /* The result should be the same as when parsing on a single thread */
+    importer->configuration().setValue("threads", data.threadCount);
+    Containers::Optional<MeshData> mesh = importer->mesh(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->vertexCount(), 65*65);
+    CORRADE_COMPARE_AS(mesh->indices<UnsignedInt>(),
+        expected->indices<UnsignedInt>(),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Position),
+        expected->attribute<Vector3>(MeshAttribute::Position),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector3>(MeshAttribute::Normal),
+        expected->attribute<Vector3>(MeshAttribute::Normal),
+        TestSuite::Compare::Container);
+    CORRADE_COMPARE_AS(mesh->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        expected->attribute<Vector2>(MeshAttribute::TextureCoordinates),
+        TestSuite::Compare::Container);
+}
+
+void ObjImporterTest::threadedError() {
+    /* Mixed primitives in the middle and an invalid float at the end. With
+       four threads the primitive mismatch is likely across chunks, while the
+       float error is in the last chunk and thus found first. The error
+       printed should still be the first one in the file. */
+    const std::string file = grid(64, "l 1 2\n") + "vn 0 bleh 1\n";
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", 4);
+    CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer->mesh(0));
+    CORRADE_COMPARE(out.str(), "Trade::ObjImporter::mesh(): mixed primitive MeshPrimitive::Triangles and MeshPrimitive::Lines\n");
+}
+
+void ObjImporterTest::benchmark() {
+    auto&& data = ThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* About 7 MB of text */
+    constexpr Int Size = 256;
+    const std::string file = grid(Size);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("ObjImporter");
+    importer->configuration().setValue("threads", data.threadCount);
+
+    Containers::Optional<MeshData> mesh;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData({file.data(), file.size()}));
+        mesh = importer->mesh(0);
+    }
+
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->vertexCount(), (Size + 1)*(Size + 1));
+    CORRADE_COMPARE(mesh->indexCount(), Size*Size*6);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ObjImporterTest)
@@ -0,0 +1,135 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cmath>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/ImageView.h"
+#include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImageConverter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Reports input pixel bytes per second. The input size can be changed with
+   --input-size, in megabytes. */
+
+struct TgaImageConverterBenchmark: TestSuite::Tester {
+    explicit TgaImageConverterBenchmark();
+
+    void exportToData();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    private:
+        std::size_t _inputSize;
+        std::size_t _bytes;
+        std::chrono::high_resolution_clock::time_point _begin;
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImageConverter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    PixelFormat format;
+    bool rle;
+    UnsignedInt threads;
+} FormatData[]{
+    {"RGB", PixelFormat::RGB8Unorm, false, 1},
+    {"RGBA", PixelFormat::RGBA8Unorm, false, 1},
+    {"grayscale", PixelFormat::R8Unorm, false, 1},
+    {"RGB, RLE", PixelFormat::RGB8Unorm, true, 1},
+    {"RGBA, RLE", PixelFormat::RGBA8Unorm, true, 1},
+    {"grayscale, RLE", PixelFormat::R8Unorm, true, 1},
+    {"RGBA, RLE, all threads", PixelFormat::RGBA8Unorm, true, 0}
+};
+
+TgaImageConverterBenchmark::TgaImageConverterBenchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"input"})} {
+    addCustomInstancedBenchmarks({&TgaImageConverterBenchmark::exportToData}, 10,
+        Containers::arraySize(FormatData),
+        &TgaImageConverterBenchmark::throughputBegin,
+        &TgaImageConverterBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+
+    Utility::Arguments args{"input"};
+    args.addOption("size", "16").setHelp("size", "approximate input image size", "MB")
+        .parse(arguments().first, arguments().second);
+    _inputSize = args.value<std::size_t>("size")*1024*1024;
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMAGECONVERTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void TgaImageConverterBenchmark::throughputBegin() {
+    _bytes = 0;
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t TgaImageConverterBenchmark::throughputEnd() {
+    const std::uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return duration ? _bytes*1000000000ull/duration : 0;
+}
+
+void TgaImageConverterBenchmark::exportToData() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Four-byte aligned rows so the default pixel storage fits */
+    const std::size_t pixelSize = Magnum::pixelSize(data.format);
+    const Int size = Math::min(Int(std::sqrt(Double(_inputSize/pixelSize))), 65535) & ~3;
+    Containers::Array<char> pixels{Containers::NoInit, std::size_t(size*size)*pixelSize};
+    /* Runs of 16 same pixels, so RLE has something to compress */
+    for(std::size_t i = 0; i != pixels.size(); ++i)
+        pixels[i] = char((i/pixelSize/16)*37 + i%pixelSize);
+    const ImageView2D image{data.format, Vector2i{size}, pixels};
+
+    Containers::Pointer<AbstractImageConverter> converter = _manager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", data.rle);
+    converter->configuration().setValue("threads", data.threads);
+
+    Containers::Array<char> out;
+    CORRADE_BENCHMARK(1) {
+        out = converter->exportToData(image);
+        _bytes += pixels.size();
+    }
+
+    CORRADE_VERIFY(out);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterBenchmark)
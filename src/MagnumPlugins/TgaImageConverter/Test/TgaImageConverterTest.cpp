@@ -29,6 +29,8 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 
@@ -50,6 +52,9 @@ struct TgaImageConverterTest: TestSuite::Tester {
     void rgb();
     void rgba();
 
+    void rle();
+    void rleThreaded();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImageConverter> _converterManager{"nonexistent"};
     PluginManager::Manager<AbstractImporter> _importerManager{"nonexistent"};
@@ -92,6 +97,15 @@ constexpr char OriginalDataRGBA[] = {
 };
 const ImageView2D OriginalRGBA{PixelFormat::RGBA8Unorm, {2, 3}, OriginalDataRGBA};
 
+const struct {
+    const char* name;
+    UnsignedInt threads;
+} RleThreadedData[] {
+    {"single thread", 1},
+    {"four threads", 4},
+    {"hardware concurrency", 0}
+};
+
 TgaImageConverterTest::TgaImageConverterTest() {
     addTests({&TgaImageConverterTest::wrongFormat});
 
@@ -100,6 +114,11 @@ TgaImageConverterTest::TgaImageConverterTest() {
         &TgaImageConverterTest::rgba},
         Containers::arraySize(VerboseData));
 
+    addTests({&TgaImageConverterTest::rle});
+
+    addInstancedTests({&TgaImageConverterTest::rleThreaded},
+        Containers::arraySize(RleThreadedData));
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef TGAIMAGECONVERTER_PLUGIN_FILENAME
@@ -185,6 +204,86 @@ void TgaImageConverterTest::rgba() {
     CORRADE_COMPARE(out.str(), data.message32);
 }
 
+void TgaImageConverterTest::rle() {
+    const char data[] = {
+        1, 1, 1, 2, 3, 3,
+        4, 5, 6, 6, 6, 7
+    };
+    ImageView2D image{PixelStorage{}.setAlignment(1),
+        PixelFormat::R8Unorm, {6, 2}, data};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    Containers::Array<char> array = converter->exportToData(image);
+    CORRADE_VERIFY(array);
+
+    /* Grayscale RLE image type */
+    CORRADE_COMPARE(array[2], 11);
+
+    /* Runs of two and more same pixels are repeat packets, the rest is put
+       into raw packets. No packet crosses the scanline boundary. */
+    const char expected[] = {
+        '\x82', 1,
+        '\x00', 2,
+        '\x81', 3,
+
+        '\x01', 4, 5,
+        '\x82', 6,
+        '\x00', 7
+    };
+    CORRADE_COMPARE_AS(array.suffix(18), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+}
+
+void TgaImageConverterTest::rleThreaded() {
+    auto&& data = RleThreadedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    /* Large enough to be split across four threads, with a mixture of long
+       runs, short runs and runs longer than what fits into a single packet */
+    const Vector2i size{700, 512};
+    Containers::Array<char> pixels{Containers::NoInit, std::size_t(size.product())*4};
+    for(std::size_t y = 0; y != std::size_t(size.y()); ++y) {
+        for(std::size_t x = 0; x != std::size_t(size.x()); ++x) {
+            char* pixel = pixels + (y*size.x() + x)*4;
+            pixel[0] = char(x/300);
+            pixel[1] = char(y % 7 ? x/3 : x);
+            pixel[2] = char(y);
+            pixel[3] = char(255);
+        }
+    }
+    ImageView2D image{PixelFormat::RGBA8Unorm, size, pixels};
+
+    Containers::Pointer<AbstractImageConverter> converter = _converterManager.instantiate("TgaImageConverter");
+    converter->configuration().setValue("rle", true);
+    converter->configuration().setValue("threads", data.threads);
+    Containers::Array<char> array = converter->exportToData(image);
+    CORRADE_VERIFY(array);
+    CORRADE_COMPARE(array[2], 10);
+
+    /* The output should be the same as when encoded on a single thread */
+    converter->configuration().setValue("threads", 1);
+    Containers::Array<char> expected = converter->exportToData(image);
+    CORRADE_COMPARE_AS(Containers::arrayView(array), Containers::arrayView(expected),
+        TestSuite::Compare::Container);
+
+    /* And compressed, at least a bit */
+    CORRADE_COMPARE_AS(array.size(), pixels.size(),
+        TestSuite::Compare::Less);
+
+    if(!(_importerManager.loadState("TgaImporter") & PluginManager::LoadState::Loaded))
+        CORRADE_SKIP("TgaImporter plugin not enabled, can't test the result");
+
+    Containers::Pointer<AbstractImporter> importer = _importerManager.instantiate("TgaImporter");
+    CORRADE_VERIFY(importer->openData(array));
+    Containers::Optional<Trade::ImageData2D> converted = importer->image2D(0);
+    CORRADE_VERIFY(converted);
+    CORRADE_COMPARE(converted->size(), size);
+    CORRADE_COMPARE(converted->format(), PixelFormat::RGBA8Unorm);
+    CORRADE_COMPARE_AS(converted->data(), Containers::arrayView(pixels),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImageConverterTest)
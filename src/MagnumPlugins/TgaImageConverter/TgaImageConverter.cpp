@@ -25,13 +25,16 @@
 
 #include "TgaImageConverter.h"
 
+#include <cstring>
 #include <fstream>
 #include <tuple>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/ImageView.h"
+#include "Magnum/Implementation/threads.h"
 #include "Magnum/PixelFormat.h"
 #include "Magnum/Math/Swizzle.h"
 #include "Magnum/Math/Vector4.h"
@@ -39,6 +42,49 @@
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* RLE-encodes a single scanline of width pixels. Packets never cross
+   scanline boundaries, as recommended by the TGA 2.0 specification, which is
+   also what allows the scanlines to be encoded independently. The output
+   needs to have space for at least width*(pixelSize + 1) bytes, returns the
+   actual encoded size. */
+std::size_t encodeRleScanline(const char* const src, const std::size_t width, const std::size_t pixelSize, char* const dst) {
+    char* out = dst;
+    std::size_t i = 0;
+    while(i < width) {
+        /* Count how many times the current pixel repeats, a single packet can
+           hold at most 128 */
+        std::size_t run = 1;
+        while(i + run < width && run < 128 && std::memcmp(src + (i + run)*pixelSize, src + i*pixelSize, pixelSize) == 0)
+            ++run;
+
+        /* Two or more same pixels are a repeat packet, high bit set and the
+           pixel stored just once */
+        if(run > 1) {
+            *out++ = char(0x80|(run - 1));
+            std::memcpy(out, src + i*pixelSize, pixelSize);
+            out += pixelSize;
+            i += run;
+            continue;
+        }
+
+        /* Otherwise gather pixels into a raw packet until there are two same
+           pixels next to each other, which start a new repeat packet */
+        std::size_t count = 1;
+        while(i + count < width && count < 128 && !(i + count + 1 < width && std::memcmp(src + (i + count)*pixelSize, src + (i + count + 1)*pixelSize, pixelSize) == 0))
+            ++count;
+        *out++ = char(count - 1);
+        std::memcpy(out, src + i*pixelSize, count*pixelSize);
+        out += count*pixelSize;
+        i += count;
+    }
+
+    return out - dst;
+}
+
+}
+
 TgaImageConverter::TgaImageConverter() = default;
 
 TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImageConverter{manager, plugin} {}
@@ -46,6 +92,8 @@ TgaImageConverter::TgaImageConverter(PluginManager::AbstractManager& manager, co
 ImageConverterFeatures TgaImageConverter::doFeatures() const { return ImageConverterFeature::ConvertData; }
 
 Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& image) {
+    const bool rle = configuration().value<bool>("rle");
+
     /* Initialize data buffer */
     const auto pixelSize = UnsignedByte(image.pixelSize());
     Containers::Array<char> data{Containers::ValueInit, sizeof(Implementation::TgaHeader) + pixelSize*image.size().product()};
@@ -55,10 +103,10 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
     switch(image.format()) {
         case PixelFormat::RGB8Unorm:
         case PixelFormat::RGBA8Unorm:
-            header->imageType = 2;
+            header->imageType = rle ? 10 : 2;
             break;
         case PixelFormat::R8Unorm:
-            header->imageType = 3;
+            header->imageType = rle ? 11 : 3;
             break;
         default:
             Error() << "Trade::TgaImageConverter::exportToData(): unsupported pixel format" << image.format();
@@ -85,7 +133,43 @@ Containers::Array<char> TgaImageConverter::doExportToData(const ImageView2D& ima
             pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
     }
 
-    return data;
+    if(!rle) return data;
+
+    /* Encode each scanline into its own fixed-size slot of a scratch buffer
+       large enough for the worst case, the slots are then compacted into the
+       output. The scanlines are independent, so they can be distributed
+       across threads with no synchronization. */
+    const std::size_t width = image.size().x();
+    const std::size_t height = image.size().y();
+    const std::size_t rowSize = width*pixelSize;
+    const std::size_t maxEncodedRowSize = width*(pixelSize + 1);
+    Containers::Array<char> scratch{Containers::NoInit, maxEncodedRowSize*height};
+    Containers::Array<std::size_t> encodedRowSizes{Containers::NoInit, height};
+
+    /* Zero thread count means hardware concurrency, small images use less
+       threads. Each thread encodes a range of whole rows. */
+    const UnsignedInt threadCount = Magnum::Implementation::clampThreadCount(Magnum::Implementation::resolveThreadCount(configuration().value<UnsignedInt>("threads")), width*height);
+    Magnum::Implementation::runOnThreads(threadCount, [&](const UnsignedInt thread) {
+        const std::pair<std::size_t, std::size_t> range = Magnum::Implementation::threadRange(height, threadCount, thread);
+        for(std::size_t row = range.first; row != range.second; ++row)
+            encodedRowSizes[row] = encodeRleScanline(pixels.data() + row*rowSize, width, pixelSize, scratch.data() + row*maxEncodedRowSize);
+    });
+
+    std::size_t encodedSize = sizeof(Implementation::TgaHeader);
+    for(const std::size_t size: encodedRowSizes) encodedSize += size;
+
+    Containers::Array<char> out{Containers::NoInit, encodedSize};
+    std::memcpy(out.data(), data.data(), sizeof(Implementation::TgaHeader));
+    char* outPixels = out.data() + sizeof(Implementation::TgaHeader);
+    for(std::size_t row = 0; row != height; ++row) {
+        std::memcpy(outPixels, scratch.data() + row*maxEncodedRowSize, encodedRowSizes[row]);
+        outPixels += encodedRowSizes[row];
+    }
+
+    if(flags() & ImageConverterFlag::Verbose)
+        Debug{} << "Trade::TgaImageConverter::exportToData(): RLE-compressed" << data.size() - sizeof(Implementation::TgaHeader) << "bytes to" << encodedSize - sizeof(Implementation::TgaHeader) << "on" << threadCount << "threads";
+
+    return out;
 }
 
 }}
@@ -91,8 +91,20 @@ information.
 
 @section Trade-TgaImageConverter-behavior Behavior and limitations
 
-The output is always uncompressed. If you want to make use of RLE compression
-and have the files smaller, use the @ref StbImageConverter plugin instead.
+The output is uncompressed by default. RLE compression can be enabled with
+the @cb{.ini} rle @ce @ref Trade-TgaImageConverter-configuration "configuration option".
+Each scanline is encoded separately, so the encoding can be split across
+multiple threads by setting the @cb{.ini} threads @ce option. The output is
+the same regardless of the thread count.
+
+@section Trade-TgaImageConverter-configuration Plugin-specific configuration
+
+It's possible to tune various output options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImageConverter/TgaImageConverter.conf configuration_
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_TGAIMAGECONVERTER_EXPORT TgaImageConverter: public AbstractImageConverter {
     public:
@@ -0,0 +1,188 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/Containers/Optional.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Arguments.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Trade/AbstractImporter.h"
+#include "Magnum/Trade/ImageData.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test { namespace {
+
+/* Reports decoded pixel bytes per second. The input size can be changed with
+   --input-size, in megabytes. */
+
+struct TgaImporterBenchmark: TestSuite::Tester {
+    explicit TgaImporterBenchmark();
+
+    void image2D();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    private:
+        std::size_t _inputSize;
+        std::size_t _bytes;
+        std::chrono::high_resolution_clock::time_point _begin;
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    UnsignedByte imageType;
+    UnsignedByte channels;
+    bool swizzle;
+} FormatData[]{
+    {"RGB", 2, 3, true},
+    {"RGB, no swizzle", 2, 3, false},
+    {"RGBA", 2, 4, true},
+    {"RGBA, no swizzle", 2, 4, false},
+    {"grayscale", 3, 1, true},
+    {"RGB, RLE", 10, 3, true},
+    {"RGB, RLE, no swizzle", 10, 3, false},
+    {"RGBA, RLE", 10, 4, true},
+    {"RGBA, RLE, no swizzle", 10, 4, false},
+    {"grayscale, RLE", 11, 1, true}
+};
+
+TgaImporterBenchmark::TgaImporterBenchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"input"})} {
+    addCustomInstancedBenchmarks({&TgaImporterBenchmark::image2D}, 10,
+        Containers::arraySize(FormatData),
+        &TgaImporterBenchmark::throughputBegin,
+        &TgaImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+
+    Utility::Arguments args{"input"};
+    args.addOption("size", "16").setHelp("size", "approximate decoded image size", "MB")
+        .parse(arguments().first, arguments().second);
+    _inputSize = args.value<std::size_t>("size")*1024*1024;
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef TGAIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(TGAIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void TgaImporterBenchmark::throughputBegin() {
+    _bytes = 0;
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t TgaImporterBenchmark::throughputEnd() {
+    const std::uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return duration ? _bytes*1000000000ull/duration : 0;
+}
+
+/* Runs of eight equal pixels alternating with noise, so the RLE variant has
+   both repeat and raw packets */
+Containers::Array<char> generateTga(const UnsignedByte imageType, const UnsignedByte channels, const std::size_t byteCount) {
+    const std::size_t size = Math::min(std::size_t(std::sqrt(Double(byteCount/channels))), std::size_t{65535});
+
+    Containers::Array<char> pixels{Containers::NoInit, size*size*channels};
+    for(std::size_t y = 0; y != size; ++y) for(std::size_t x = 0; x != size; ++x) {
+        for(std::size_t c = 0; c != channels; ++c) {
+            const std::size_t i = (y*size + x)*channels + c;
+            pixels[i] = char(x % 64 < 48 ? (x/8)*13 + y*7 + c*5 : x*31 + y*7 + c);
+        }
+    }
+
+    Containers::Array<char> out;
+    const char header[]{
+        0, 0, char(imageType), 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        char(size & 0xff), char(size >> 8),
+        char(size & 0xff), char(size >> 8),
+        char(channels*8), 0
+    };
+    arrayAppend(out, Containers::arrayView(header));
+
+    if(imageType < 9) {
+        arrayAppend(out, Containers::arrayView(pixels));
+        return out;
+    }
+
+    const auto pixel = [&](std::size_t y, std::size_t x) {
+        return pixels.slice((y*size + x)*channels, (y*size + x + 1)*channels);
+    };
+    const auto equal = [&](std::size_t y, std::size_t a, std::size_t b) {
+        return std::memcmp(pixel(y, a).data(), pixel(y, b).data(), channels) == 0;
+    };
+    for(std::size_t y = 0; y != size; ++y) {
+        std::size_t x = 0;
+        while(x < size) {
+            std::size_t run = 1;
+            while(x + run < size && run < 128 && equal(y, x, x + run)) ++run;
+            if(run > 1) {
+                arrayAppend(out, char(0x80|(run - 1)));
+                arrayAppend(out, pixel(y, x));
+                x += run;
+                continue;
+            }
+
+            std::size_t raw = 1;
+            while(x + raw < size && raw < 128 && !(x + raw + 1 < size && equal(y, x + raw, x + raw + 1))) ++raw;
+            arrayAppend(out, char(raw - 1));
+            arrayAppend(out, pixels.slice((y*size + x)*channels, (y*size + x + raw)*channels));
+            x += raw;
+        }
+    }
+
+    return out;
+}
+
+void TgaImporterBenchmark::image2D() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> tga = generateTga(data.imageType, data.channels, _inputSize);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->configuration().setValue("swizzle", data.swizzle);
+    CORRADE_VERIFY(importer->openData(tga));
+
+    Containers::Optional<ImageData2D> image;
+    CORRADE_BENCHMARK(1) {
+        image = importer->image2D(0);
+        _bytes += image->data().size();
+    }
+
+    CORRADE_VERIFY(image);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::TgaImporterBenchmark)
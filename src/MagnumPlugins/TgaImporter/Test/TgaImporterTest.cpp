@@ -28,11 +28,13 @@
 #include <Corrade/Containers/Optional.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/FormatStl.h>
 
 #include "Magnum/PixelFormat.h"
+#include "Magnum/Math/Color.h"
 #include "Magnum/Trade/AbstractImporter.h"
 #include "Magnum/Trade/ImageData.h"
 
@@ -58,6 +60,17 @@ struct TgaImporterTest: TestSuite::Tester {
     void grayscale8Rle();
 
     void rleTooLarge();
+    void rleLongRun();
+
+    void noSwizzle();
+
+    void zeroCopy();
+    void zeroCopyConverted();
+    void zeroCopyNoSwizzle();
+    void zeroCopyFile();
+
+    void yFlip();
+    void yFlipZeroCopy();
 
     void openTwice();
     void importTwice();
@@ -123,6 +136,32 @@ const struct {
         "RLE file too short at pixel 0"}
 };
 
+const struct {
+    const char* name;
+    Containers::ArrayView<const char> data;
+} NoSwizzleData[] {
+    {"", Containers::arrayView(Color24)},
+    {"RLE", Containers::arrayView(Color24Rle)}
+};
+
+const struct {
+    const char* name;
+    Containers::ArrayView<const char> data;
+    char expected[18];
+} YFlipData[] {
+    {"", Containers::arrayView(Color24), {
+        7, 6, 5, 8, 7, 6,
+        5, 4, 3, 6, 5, 4,
+        3, 2, 1, 4, 3, 2
+    }},
+    /* The repeated run spans the last two rows */
+    {"RLE", Containers::arrayView(Color24Rle), {
+        6, 5, 4, 6, 5, 4,
+        5, 4, 3, 6, 5, 4,
+        3, 2, 1, 4, 3, 2
+    }}
+};
+
 TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::openEmpty});
 
@@ -146,7 +185,21 @@ TgaImporterTest::TgaImporterTest() {
     addTests({&TgaImporterTest::grayscale8,
               &TgaImporterTest::grayscale8Rle,
 
-              &TgaImporterTest::rleTooLarge});
+              &TgaImporterTest::rleTooLarge,
+              &TgaImporterTest::rleLongRun});
+
+    addInstancedTests({&TgaImporterTest::noSwizzle},
+        Containers::arraySize(NoSwizzleData));
+
+    addTests({&TgaImporterTest::zeroCopy,
+              &TgaImporterTest::zeroCopyConverted,
+              &TgaImporterTest::zeroCopyNoSwizzle,
+              &TgaImporterTest::zeroCopyFile});
+
+    addInstancedTests({&TgaImporterTest::yFlip},
+        Containers::arraySize(YFlipData));
+
+    addTests({&TgaImporterTest::yFlipZeroCopy});
 
     addTests({&TgaImporterTest::openTwice,
               &TgaImporterTest::importTwice});
@@ -421,6 +474,193 @@ void TgaImporterTest::rleTooLarge() {
     CORRADE_COMPARE(out.str(), "Trade::TgaImporter::image2D(): RLE data larger than advertised Vector(2, 3) pixels at byte 28\n");
 }
 
+void TgaImporterTest::rleLongRun() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    const char data[] = {
+        0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\x83', 0, 1, 0, 32, 0,
+        /* 1 pixel 128x repeated */
+        '\xff', 1, 2, 3, 4,
+        /* 3 pixels as-is */
+        '\x02', 5, 6, 7, 8,
+                 6, 7, 8, 9,
+                 7, 8, 9, 10
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* The run is filled by repeatedly doubling the filled prefix, verify all
+       pixels got there and nothing more */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->size(), Vector2i(131, 1));
+    Containers::ArrayView<const Color4ub> pixels = Containers::arrayCast<const Color4ub>(image->data());
+    CORRADE_COMPARE(pixels.size(), 131);
+    for(std::size_t i = 0; i != 128; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(pixels[i], (Color4ub{3, 2, 1, 4}));
+    }
+    CORRADE_COMPARE(pixels[128], (Color4ub{7, 6, 5, 8}));
+    CORRADE_COMPARE(pixels[129], (Color4ub{8, 7, 6, 9}));
+    CORRADE_COMPARE(pixels[130], (Color4ub{9, 8, 7, 10}));
+}
+
+void TgaImporterTest::noSwizzle() {
+    auto&& data = NoSwizzleData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->configuration().setValue("swizzle", false);
+    importer->setFlags(ImporterFlag::Verbose);
+    CORRADE_VERIFY(importer->openData(data.data));
+
+    std::ostringstream out;
+    Containers::Optional<Trade::ImageData2D> image;
+    {
+        Debug redirectOutput{&out};
+        image = importer->image2D(0);
+    }
+    CORRADE_VERIFY(image);
+
+    /* The data are in the original BGR order, the format stays the same */
+    const char pixels[] = {
+        1, 2, 3, 2, 3, 4,
+        3, 4, 5, 4, 5, 6,
+        5, 6, 7, 6, 7, 8
+    };
+    const char pixelsRle[] = {
+        1, 2, 3, 2, 3, 4,
+        3, 4, 5, 4, 5, 6,
+        4, 5, 6, 4, 5, 6
+    };
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(),
+        Containers::arrayView(testCaseInstanceId() ? pixelsRle : pixels),
+        TestSuite::Compare::Container);
+
+    /* No conversion message printed */
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void TgaImporterTest::zeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* Grayscale data should be referenced directly */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(image->format(), PixelFormat::R8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), data + 18);
+    CORRADE_COMPARE(image->data().size(), 6);
+
+    /* The image should stay valid even after the importer is closed */
+    importer->close();
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(data).suffix(18),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::zeroCopyConverted() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    /* Colored data need BGR to RGB conversion, so they're copied even with
+       the flag set */
+    CORRADE_VERIFY(importer->openData(Color24));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+
+    /* And RLE data need decoding */
+    CORRADE_VERIFY(importer->openData(Color24Rle));
+    image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+}
+
+void TgaImporterTest::zeroCopyNoSwizzle() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->configuration().setValue("swizzle", false);
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    /* With the conversion disabled, colored data can be referenced directly
+       as well */
+    CORRADE_VERIFY(importer->openData(Color24));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlags{});
+    CORRADE_COMPARE(static_cast<const void*>(image->data().data()), Color24 + 18);
+
+    /* RLE data still need decoding */
+    CORRADE_VERIFY(importer->openData(Color24Rle));
+    image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+}
+
+void TgaImporterTest::zeroCopyFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    /* The file is uncompressed grayscale, but the file data are alive only
+       while opening, so it has to be copied */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(TGAIMPORTER_TEST_DIR, "file.tga")));
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->size(), (Vector2i{2, 3}));
+}
+
+void TgaImporterTest::yFlip() {
+    auto&& data = YFlipData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::YFlip);
+    CORRADE_VERIFY(importer->openData(data.data));
+
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE(image->format(), PixelFormat::RGB8Unorm);
+    CORRADE_COMPARE(image->size(), Vector2i(2, 3));
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView(data.expected),
+        TestSuite::Compare::Container);
+}
+
+void TgaImporterTest::yFlipZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy|ImporterFlag::YFlip);
+
+    const char data[] = {
+        0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 3, 0, 8, 0,
+        1, 2,
+        3, 4,
+        5, 6
+    };
+    CORRADE_VERIFY(importer->openData(data));
+
+    /* Grayscale data would be referenced directly, but the flip needs a
+       copy */
+    Containers::Optional<Trade::ImageData2D> image = importer->image2D(0);
+    CORRADE_VERIFY(image);
+    CORRADE_COMPARE(image->dataFlags(), DataFlag::Owned|DataFlag::Mutable);
+    CORRADE_COMPARE_AS(image->data(), Containers::arrayView<char>({
+        5, 6,
+        3, 4,
+        1, 2
+    }), TestSuite::Compare::Container);
+}
+
 void TgaImporterTest::openTwice() {
     Containers::Pointer<AbstractImporter> importer = _manager.instantiate("TgaImporter");
 
@@ -25,28 +25,90 @@
 
 #include "TgaImporter.h"
 
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/Optional.h>
-#include <Corrade/Utility/Algorithms.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/PixelFormat.h"
-#include "Magnum/Math/Swizzle.h"
-#include "Magnum/Math/Vector4.h"
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/Vector2.h"
 #include "Magnum/Trade/ImageData.h"
 #include "MagnumPlugins/TgaImporter/TgaHeader.h"
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Copies count pixels from src to dst, swapping the first and third channel
+   if swizzle is set. The source is not aligned in any way (the header is 18
+   bytes), so the four-byte pixels are loaded and stored through memcpy(),
+   which compilers turn into plain unaligned moves and vectorize the whole
+   loop. The three-byte pixels are done byte-by-byte, which still vectorizes
+   at least partially. In-place operation (src == dst) is allowed. */
+void copyPixels(const char* src, char* dst, const std::size_t count, const std::size_t pixelSize, const bool swizzle) {
+    if(!swizzle || pixelSize == 1) {
+        if(src != dst) std::memcpy(dst, src, count*pixelSize);
+        return;
+    }
+
+    if(pixelSize == 4) {
+        for(std::size_t i = 0; i != count; ++i) {
+            UnsignedInt pixel;
+            std::memcpy(&pixel, src + i*4, 4);
+            /* Swap the first and third byte in memory order */
+            #ifndef CORRADE_TARGET_BIG_ENDIAN
+            pixel = (pixel & 0xff00ff00u)|((pixel & 0x000000ffu) << 16)|((pixel & 0x00ff0000u) >> 16);
+            #else
+            pixel = (pixel & 0x00ff00ffu)|((pixel & 0xff000000u) >> 16)|((pixel & 0x0000ff00u) << 16);
+            #endif
+            std::memcpy(dst + i*4, &pixel, 4);
+        }
+    } else {
+        CORRADE_INTERNAL_ASSERT(pixelSize == 3);
+        for(std::size_t i = 0; i != count; ++i) {
+            const char b = src[i*3 + 0];
+            const char g = src[i*3 + 1];
+            const char r = src[i*3 + 2];
+            dst[i*3 + 0] = r;
+            dst[i*3 + 1] = g;
+            dst[i*3 + 2] = b;
+        }
+    }
+}
+
+/* Fills count pixels in dst with a single pixel from src. Single-byte pixels
+   are a memset(), wider pixels are put once and then the filled prefix gets
+   repeatedly doubled with memcpy(), so a run takes log2(count) calls instead
+   of a call per pixel. */
+void fillPixels(const char* src, char* dst, const std::size_t count, const std::size_t pixelSize, const bool swizzle) {
+    if(pixelSize == 1) {
+        std::memset(dst, *src, count);
+        return;
+    }
+
+    copyPixels(src, dst, 1, pixelSize, swizzle);
+    const std::size_t size = count*pixelSize;
+    for(std::size_t filled = pixelSize; filled < size; filled *= 2)
+        std::memcpy(dst + filled, dst, Math::min(filled, size - filled));
+}
+
+}
+
 TgaImporter::TgaImporter() = default;
 
 TgaImporter::TgaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
 TgaImporter::~TgaImporter() = default;
 
-ImporterFeatures TgaImporter::doFeatures() const { return ImporterFeature::OpenData; }
+ImporterFeatures TgaImporter::doFeatures() const {
+    /* doImage2D() only reads the data stored in doOpenData() */
+    return ImporterFeature::OpenData|ImporterFeature::ConcurrentImport;
+}
 
 bool TgaImporter::doIsOpened() const { return _in; }
 
@@ -59,14 +121,23 @@ void TgaImporter::doOpenData(const Containers::ArrayView<const char> data) {
        side, because empty file is valid in some formats (OBJ or glTF). We also
        can't do the full import here because then doImage2D() would need to
        copy the imported data instead anyway. This way it'll also work nicely
-       with a future openMemory(). */
+       with ImporterFlag::ZeroCopy. */
     if(data.empty()) {
         Error{} << "Trade::TgaImporter::openData(): the file is empty";
         return;
     }
 
+    /* If the caller guarantees the data stay in scope, just reference them
+       instead of making a copy */
+    if(flags() & ImporterFlag::ZeroCopy) {
+        _in = Containers::Array<char>{const_cast<char*>(data.data()), data.size(), Implementation::nonOwnedArrayDeleter};
+        _zeroCopy = true;
+        return;
+    }
+
     _in = Containers::Array<char>{data.size()};
     std::copy(data.begin(), data.end(), _in.begin());
+    _zeroCopy = false;
 }
 
 UnsignedInt TgaImporter::doImage2DCount() const { return 1; }
@@ -129,17 +200,47 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
     const std::size_t pixelSize = header.bpp/8;
     const std::size_t outputSize = std::size_t(size.product())*pixelSize;
 
-    /* Copy data directly if not RLE */
-    Containers::Array<char> data{outputSize};
+    /* Adjust pixel storage if row size is not four byte aligned */
+    PixelStorage storage;
+    if((size.x()*header.bpp/8)%4 != 0)
+        storage.setAlignment(1);
+
+    /* Files that are larger are allowed if not RLE */
     Containers::ArrayView<const char> srcPixels = _in.suffix(sizeof(Implementation::TgaHeader));
-    if(!rle) {
-        /* Files that are larger are allowed in this case (but not for RLE) */
-        if(srcPixels.size() < outputSize) {
-            Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
-            return Containers::NullOpt;
-        }
+    if(!rle && srcPixels.size() < outputSize) {
+        Error{} << "Trade::TgaImporter::image2D(): file too short, expected" << outputSize + sizeof(Implementation::TgaHeader) << "bytes but got" << _in.size();
+        return Containers::NullOpt;
+    }
+
+    /* Colored data are stored as BGR(A) and have to be swizzled, unless the
+       consumer says it can deal with that on its own */
+    const bool swizzle = format != PixelFormat::R8Unorm && configuration().value<bool>("swizzle");
+
+    /* TGA rows are bottom-up by default, same as what Magnum expects */
+    const bool flip = flags() & ImporterFlag::YFlip;
+
+    /* Uncompressed data that don't need any conversion can be referenced
+       directly if the caller guarantees the data stay in scope */
+    if(!rle && !swizzle && !flip && _zeroCopy)
+        return ImageData2D{storage, format, size, DataFlags{}, srcPixels.prefix(outputSize)};
+
+    if(swizzle && (flags() & ImporterFlag::Verbose)) {
+        if(format == PixelFormat::RGB8Unorm)
+            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
+        else
+            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
+    }
 
-        Utility::copy(srcPixels.prefix(data.size()), data);
+    /* Copy data directly if not RLE, swizzling them on the way. If flipping,
+       the rows are copied in reverse order, which is the same amount of
+       work. */
+    Containers::Array<char> data{Containers::NoInit, outputSize};
+    const std::size_t rowSize = size.x()*pixelSize;
+    if(!rle) {
+        if(!flip)
+            copyPixels(srcPixels.data(), data.data(), size.product(), pixelSize, swizzle);
+        else for(std::size_t y = 0, height = size.y(); y != height; ++y)
+            copyPixels(srcPixels.data() + y*rowSize, data.data() + (height - y - 1)*rowSize, size.x(), pixelSize, swizzle);
 
     /* Otherwise decode */
     } else {
@@ -154,9 +255,9 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
 
             /* First bit set to 1 means copying the following pixel given
                number of times, 0 means copying the following number of
-               pixels once. We represent that operation with a stride. */
-            const std::size_t dataSize = (rleHeader & 0x80 ? 1 : count)*pixelSize;
-            const std::ptrdiff_t stride = rleHeader & 0x80 ? 0 : pixelSize;
+               pixels once */
+            const bool repeat = rleHeader & 0x80;
+            const std::size_t dataSize = (repeat ? 1 : count)*pixelSize;
 
             /* Check bounds */
             if(1 + dataSize > srcPixels.size()) {
@@ -169,35 +270,33 @@ Containers::Optional<ImageData2D> TgaImporter::doImage2D(UnsignedInt, UnsignedIn
             }
 
             /* Copy the data */
-            Containers::StridedArrayView2D<const char> src{
-                srcPixels.slice(1, 1 + dataSize),
-                {count, pixelSize}, {stride, 1}};
-            Containers::StridedArrayView2D<char> dst{
-                dstPixels.prefix(count*pixelSize),
-                {count, pixelSize}};
-            Utility::copy(src, dst);
+            if(repeat)
+                fillPixels(srcPixels.data() + 1, dstPixels.data(), count, pixelSize, swizzle);
+            else
+                copyPixels(srcPixels.data() + 1, dstPixels.data(), count, pixelSize, swizzle);
 
             /* Update views for the next round */
             srcPixels = srcPixels.suffix(1 + dataSize);
             dstPixels = dstPixels.suffix(count*pixelSize);
         }
-    }
-
-    /* Adjust pixel storage if row size is not four byte aligned */
-    PixelStorage storage;
-    if((size.x()*header.bpp/8)%4 != 0)
-        storage.setAlignment(1);
 
-    if(format == PixelFormat::RGB8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGR to RGB";
-        for(Vector3ub& pixel: Containers::arrayCast<Vector3ub>(data))
-            pixel = Math::gather<'b', 'g', 'r'>(pixel);
-    } else if(format == PixelFormat::RGBA8Unorm) {
-        if(flags() & ImporterFlag::Verbose)
-            Debug{} << "Trade::TgaImporter::image2D(): converting from BGRA to RGBA";
-        for(Vector4ub& pixel: Containers::arrayCast<Vector4ub>(data))
-            pixel = Math::gather<'b', 'g', 'r', 'a'>(pixel);
+        /* The output isn't zero-initialized, so fill what the RLE data
+           didn't cover */
+        if(!dstPixels.empty())
+            std::memset(dstPixels.data(), 0, dstPixels.size());
+
+        /* RLE packets can span rows, so the flip is done as a separate pass
+           over the decoded data, swapping pairs of rows */
+        if(flip && size.x()) {
+            Containers::Array<char> row{Containers::NoInit, rowSize};
+            for(std::size_t y = 0, height = size.y(); y < height/2; ++y) {
+                char* const a = data.data() + y*rowSize;
+                char* const b = data.data() + (height - y - 1)*rowSize;
+                std::memcpy(row.data(), a, rowSize);
+                std::memcpy(a, b, rowSize);
+                std::memcpy(b, row.data(), rowSize);
+            }
+        }
     }
 
     return ImageData2D{storage, format, size, std::move(data)};
@@ -98,6 +98,42 @@ are imported with default @ref PixelStorage parameters except for alignment,
 which may be changed to `1` if the data require it.
 
 RLE compression is supported, paletted images are not.
+
+The BGR to RGB conversion is done in a single pass together with copying the
+data out of the file. RLE-compressed runs of a single pixel are filled with
+@ref std::memset() or a doubling @ref std::memcpy(), literal runs are copied
+as a whole. If the consumer is able to swizzle the channels on its own, such
+as with @ref GL::Texture::setSwizzle(), the conversion can be disabled with
+the @cb{.ini} swizzle @ce @ref Trade-TgaImporter-configuration "configuration option".
+Colored images are then returned in the original BGR(A) channel order, with
+the format still reported as @ref PixelFormat::RGB8Unorm or
+@ref PixelFormat::RGBA8Unorm, as there's no generic BGR pixel format.
+
+The importer supports @ref ImporterFlag::ZeroCopy. If it's set and a file
+is opened with @ref openData(), uncompressed grayscale images are returned
+as a view on the passed memory, without @ref DataFlag::Owned set. The same is
+done for uncompressed colored images if the @cb{.ini} swizzle @ce option is
+disabled. Otherwise colored images need a BGR to RGB conversion and
+RLE-compressed images need decoding, so these are always returned as an owned
+copy.
+
+The importer supports @ref ImporterFlag::YFlip. For uncompressed images the
+rows are copied out of the file in reverse order, at no extra cost. For
+RLE-compressed images, where a run can span more than one row, the decoded
+rows are swapped in a separate pass. Flipped images are always returned as
+an owned copy.
+
+The importer supports @ref ImporterFeature::ConcurrentImport, image import
+only reads the data copied or referenced during opening.
+
+@section Trade-TgaImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration(). See
+below for all options and their default values:
+
+@snippet MagnumPlugins/TgaImporter/TgaImporter.conf configuration_
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
     public:
@@ -118,6 +154,7 @@ class MAGNUM_TGAIMPORTER_EXPORT TgaImporter: public AbstractImporter {
         Containers::Optional<ImageData2D> MAGNUM_TGAIMPORTER_LOCAL doImage2D(UnsignedInt id, UnsignedInt level) override;
 
         Containers::Array<char> _in;
+        bool _zeroCopy{};
 };
 
 }}
@@ -0,0 +1,158 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018, 2019,
+                2020 Vladimír Vondruš <mosra@centrum.cz>
+    Copyright © 2016 Alice Margatroid <loveoverwhelming@gmail.com>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/GrowableArray.h>
+#include <Corrade/PluginManager/Manager.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Arguments.h>
+
+#include "Magnum/Audio/AbstractImporter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Audio { namespace Test { namespace {
+
+/* Reports sample bytes per second. The input size can be changed with
+   --input-size, in megabytes. */
+
+struct WavImporterBenchmark: TestSuite::Tester {
+    explicit WavImporterBenchmark();
+
+    void data();
+
+    void throughputBegin();
+    std::uint64_t throughputEnd();
+
+    private:
+        std::size_t _inputSize;
+        std::size_t _bytes;
+        std::chrono::high_resolution_clock::time_point _begin;
+
+        /* Explicitly forbid system-wide plugin dependencies */
+        PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
+};
+
+const struct {
+    const char* name;
+    UnsignedShort audioFormat;
+    UnsignedShort channels;
+    UnsignedShort bitsPerSample;
+    bool bigEndian;
+} FormatData[]{
+    {"stereo 16-bit PCM", 1, 2, 16, false},
+    {"stereo 16-bit PCM, big-endian", 1, 2, 16, true},
+    {"stereo 32-bit float", 3, 2, 32, false},
+    {"stereo 32-bit float, big-endian", 3, 2, 32, true},
+    {"stereo A-law", 6, 2, 8, false}
+};
+
+WavImporterBenchmark::WavImporterBenchmark(): TestSuite::Tester{TesterConfiguration{}.setSkippedArgumentPrefixes({"input"})} {
+    addCustomInstancedBenchmarks({&WavImporterBenchmark::data}, 10,
+        Containers::arraySize(FormatData),
+        &WavImporterBenchmark::throughputBegin,
+        &WavImporterBenchmark::throughputEnd,
+        BenchmarkUnits::Bytes);
+
+    Utility::Arguments args{"input"};
+    args.addOption("size", "16").setHelp("size", "approximate sample data size", "MB")
+        .parse(arguments().first, arguments().second);
+    _inputSize = args.value<std::size_t>("size")*1024*1024;
+
+    /* Load the plugin directly from the build tree. Otherwise it's static and
+       already loaded. */
+    #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
+    CORRADE_INTERNAL_ASSERT_OUTPUT(_manager.load(WAVAUDIOIMPORTER_PLUGIN_FILENAME) & PluginManager::LoadState::Loaded);
+    #endif
+}
+
+void WavImporterBenchmark::throughputBegin() {
+    _bytes = 0;
+    _begin = std::chrono::high_resolution_clock::now();
+}
+
+std::uint64_t WavImporterBenchmark::throughputEnd() {
+    const std::uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - _begin).count();
+    return duration ? _bytes*1000000000ull/duration : 0;
+}
+
+void appendInteger(Containers::Array<char>& out, const UnsignedInt value, const std::size_t size, const bool bigEndian) {
+    for(std::size_t i = 0; i != size; ++i)
+        arrayAppend(out, char(value >> 8*(bigEndian ? size - i - 1 : i)));
+}
+
+Containers::Array<char> generateWav(const UnsignedShort audioFormat, const UnsignedShort channels, const UnsignedShort bitsPerSample, const bool bigEndian, std::size_t byteCount) {
+    const UnsignedInt sampleRate = 48000;
+    const UnsignedInt blockAlign = channels*bitsPerSample/8;
+    byteCount -= byteCount % blockAlign;
+
+    Containers::Array<char> out;
+    arrayAppend(out, Containers::arrayView(bigEndian ? "RIFX" : "RIFF", 4));
+    appendInteger(out, UnsignedInt(4 + 8 + 16 + 8 + byteCount), 4, bigEndian);
+    arrayAppend(out, Containers::arrayView("WAVE", 4));
+
+    arrayAppend(out, Containers::arrayView("fmt ", 4));
+    appendInteger(out, 16, 4, bigEndian);
+    appendInteger(out, audioFormat, 2, bigEndian);
+    appendInteger(out, channels, 2, bigEndian);
+    appendInteger(out, sampleRate, 4, bigEndian);
+    appendInteger(out, sampleRate*blockAlign, 4, bigEndian);
+    appendInteger(out, blockAlign, 2, bigEndian);
+    appendInteger(out, bitsPerSample, 2, bigEndian);
+
+    arrayAppend(out, Containers::arrayView("data", 4));
+    appendInteger(out, UnsignedInt(byteCount), 4, bigEndian);
+    Containers::ArrayView<char> samples = arrayAppend(out, Containers::NoInit, byteCount);
+    for(std::size_t i = 0; i != samples.size(); ++i)
+        samples[i] = char(i*37);
+
+    return out;
+}
+
+void WavImporterBenchmark::data() {
+    auto&& data = FormatData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    const Containers::Array<char> wav = generateWav(data.audioFormat, data.channels, data.bitsPerSample, data.bigEndian, _inputSize);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+
+    /* The samples are copied (and endian-swapped) on open, then copied again
+       when retrieved, so measure both */
+    Containers::Array<char> samples;
+    CORRADE_BENCHMARK(1) {
+        CORRADE_VERIFY(importer->openData(wav));
+        samples = importer->data();
+        _bytes += samples.size();
+    }
+
+    CORRADE_COMPARE(samples.size(), wav.size() - 44);
+}
+
+}}}}
+
+CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterBenchmark)
@@ -28,15 +28,46 @@
 #include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/DebugStl.h>
 #include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
+#include "Magnum/Audio/BufferFormat.h"
+#include "Magnum/Math/Packing.h"
 
 #include "configure.h"
 
 namespace Magnum { namespace Audio { namespace Test { namespace {
 
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool openData;
+} ReadFramesData[]{
+    {"mono8 with junk, file", "mono8junk.wav", false},
+    {"mono8 with junk, data", "mono8junk.wav", true},
+    {"stereo16, file", "stereo16.wav", false},
+    {"mono16 big-endian, file", "mono16be.wav", false},
+    {"stereo64f big-endian, file", "stereo64fbe.wav", false},
+    {"stereo64f big-endian, data", "stereo64fbe.wav", true}
+};
+
+constexpr struct {
+    const char* name;
+    const char* filename;
+    bool openData;
+} Pcm16Data[]{
+    {"mono8, file", "mono8.wav", false},
+    {"stereo8 A-Law, data", "stereo8ALaw.wav", true},
+    {"stereo8 μ-Law, file", "stereo8MuLaw.wav", false},
+    {"mono32f big-endian, file", "mono32fbe.wav", false},
+    {"stereo64f, file", "stereo64f.wav", false},
+    {"stereo64f big-endian, data", "stereo64fbe.wav", true}
+};
+
 struct WavImporterTest: TestSuite::Tester {
     explicit WavImporterTest();
 
@@ -78,6 +109,22 @@ struct WavImporterTest: TestSuite::Tester {
     void surround51Channel16();
     void surround71Channel24();
 
+    void readFrames();
+    void readFramesPastEnd();
+
+    void zeroCopy();
+    void zeroCopyBigEndian();
+    void zeroCopyFile();
+
+    void pcm16Mono8();
+    void pcm16ALaw();
+    void pcm16MuLaw();
+    void pcm16Float();
+    void pcm16Double();
+    void pcm16Mono16();
+    void pcm16ReadFrames();
+    void pcm16ZeroCopy();
+
     /* Explicitly forbid system-wide plugin dependencies */
     PluginManager::Manager<AbstractImporter> _manager{"nonexistent"};
 };
@@ -121,6 +168,27 @@ WavImporterTest::WavImporterTest() {
               &WavImporterTest::surround51Channel16,
               &WavImporterTest::surround71Channel24});
 
+    addInstancedTests({&WavImporterTest::readFrames},
+        Containers::arraySize(ReadFramesData));
+
+    addTests({&WavImporterTest::readFramesPastEnd,
+
+              &WavImporterTest::zeroCopy,
+              &WavImporterTest::zeroCopyBigEndian,
+              &WavImporterTest::zeroCopyFile,
+
+              &WavImporterTest::pcm16Mono8,
+              &WavImporterTest::pcm16ALaw,
+              &WavImporterTest::pcm16MuLaw,
+              &WavImporterTest::pcm16Float,
+              &WavImporterTest::pcm16Double,
+              &WavImporterTest::pcm16Mono16});
+
+    addInstancedTests({&WavImporterTest::pcm16ReadFrames},
+        Containers::arraySize(Pcm16Data));
+
+    addTests({&WavImporterTest::pcm16ZeroCopy});
+
     /* Load the plugin directly from the build tree. Otherwise it's static and
        already loaded. */
     #ifdef WAVAUDIOIMPORTER_PLUGIN_FILENAME
@@ -469,6 +537,252 @@ void WavImporterTest::surround71Channel24() {
     CORRADE_COMPARE(out.str(), "Audio::WavImporter::openData(): unsupported format Audio::WavAudioFormat::Extensible\n");
 }
 
+void WavImporterTest::readFrames() {
+    auto&& data = ReadFramesData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->features() & ImporterFeature::Streaming);
+
+    const std::string filename = Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, data.filename);
+    if(data.openData)
+        CORRADE_VERIFY(importer->openData(Utility::Directory::read(filename)));
+    else
+        CORRADE_VERIFY(importer->openFile(filename));
+
+    Containers::Array<char> expected = importer->data();
+    const UnsignedInt frameSize = bufferFormatFrameSize(importer->format());
+    CORRADE_COMPARE(importer->frameCount(), expected.size()/frameSize);
+
+    /* Read in chunks that don't divide the frame count to test the last
+       partial chunk as well */
+    Containers::Array<char> out{Containers::ValueInit, expected.size()};
+    Containers::Array<char> chunk{Containers::NoInit, 7*frameSize};
+    std::size_t offset = 0;
+    while(const std::size_t count = importer->readFrames(offset, chunk)) {
+        CORRADE_COMPARE_AS(offset + count, importer->frameCount(), TestSuite::Compare::LessOrEqual);
+        std::copy(chunk.begin(), chunk.begin() + count*frameSize, out.begin() + offset*frameSize);
+        offset += count;
+    }
+    CORRADE_COMPARE(offset, importer->frameCount());
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+
+    /* Reading again from the middle gives the same result */
+    if(importer->frameCount() > 1) {
+        CORRADE_COMPARE(importer->readFrames(1, chunk.prefix(frameSize)), 1);
+        CORRADE_COMPARE_AS(chunk.prefix(frameSize), expected.slice(frameSize, 2*frameSize), TestSuite::Compare::Container);
+    }
+}
+
+void WavImporterTest::readFramesPastEnd() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav")));
+    CORRADE_COMPARE(importer->frameCount(), 2);
+
+    Containers::Array<char> chunk{Containers::ValueInit, 4*2};
+    CORRADE_COMPARE(importer->readFrames(1, chunk), 1);
+    CORRADE_COMPARE(Containers::arrayCast<UnsignedShort>(chunk)[0], 0xc571);
+    CORRADE_COMPARE(importer->readFrames(2, chunk), 0);
+    CORRADE_COMPARE(importer->readFrames(100, chunk), 0);
+}
+
+void WavImporterTest::zeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav"));
+    CORRADE_VERIFY(importer->openData(file));
+
+    /* The data reference the input memory */
+    Containers::Array<char> data = importer->data();
+    CORRADE_VERIFY(data.deleter());
+    CORRADE_VERIFY(data.data() >= file.data() && data.data() + data.size() <= file.data() + file.size());
+    CORRADE_COMPARE_AS(data, Containers::arrayView<char>({
+        '\xde', '\xfe', '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+
+    /* Streaming works as well */
+    char frame[2];
+    CORRADE_COMPARE(importer->readFrames(1, frame), 1);
+    CORRADE_COMPARE_AS(Containers::arrayView(frame), Containers::arrayView<char>({
+        '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+}
+
+void WavImporterTest::zeroCopyBigEndian() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, Utility::Endianness::isBigEndian() ? "mono16.wav" : "mono16be.wav"));
+    CORRADE_VERIFY(importer->openData(file));
+
+    /* The data need to be converted, so they're copied */
+    Containers::Array<char> data = importer->data();
+    CORRADE_VERIFY(!data.deleter());
+    CORRADE_VERIFY(data.data() < file.data() || data.data() >= file.data() + file.size());
+}
+
+void WavImporterTest::zeroCopyFile() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+
+    /* The flag has no effect on files, the data are read into an owned
+       array */
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav")));
+    Containers::Array<char> data = importer->data();
+    CORRADE_VERIFY(!data.deleter());
+    CORRADE_COMPARE_AS(data, Containers::arrayView<char>({
+        '\xde', '\xfe', '\xca', '\x7e'
+    }), TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16Mono8() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8.wav")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 22050);
+    CORRADE_COMPARE(importer->frameCount(), 2136);
+
+    Containers::Array<char> data = importer->data();
+    CORRADE_COMPARE(data.size(), 2136*2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Short>(data).prefix(4),
+        Containers::arrayView<Short>({-256, -256, -256, -256}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16ALaw() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8ALaw.wav")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 8000);
+
+    Containers::Array<char> data = importer->data();
+    CORRADE_COMPARE(data.size(), 4096*2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Short>(data).prefix(8),
+        Containers::arrayView<Short>({-40, -24, -8, -8, -8, 8, 8, 8}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16MuLaw() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono8MuLaw.wav")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 8000);
+
+    Containers::Array<char> data = importer->data();
+    CORRADE_COMPARE(data.size(), 4096*2);
+    CORRADE_COMPARE_AS(Containers::arrayCast<Short>(data).prefix(8),
+        Containers::arrayView<Short>({32, 16, 0, 8, 0, 0, 0, -8}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16Float() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono32f.wav")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE(importer->frequency(), 48000);
+
+    /* Rounding of the packing differs between platforms, so compare with a
+       one-step tolerance */
+    Containers::Array<char> data = importer->data();
+    const Containers::ArrayView<const Short> shorts = Containers::arrayCast<const Short>(data);
+    const Float expected[]{0.0f, 0.00467603f, 0.010391f, 0.0166854f};
+    for(std::size_t i = 0; i != Containers::arraySize(expected); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(Math::unpack<Float>(shorts[i]), expected[i],
+            TestSuite::Compare::around(1.0f/32767.0f));
+    }
+}
+
+void WavImporterTest::pcm16Double() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo64f.wav")));
+
+    CORRADE_COMPARE(importer->format(), BufferFormat::Stereo16);
+    CORRADE_COMPARE(importer->frequency(), 8000);
+
+    Containers::Array<char> data = importer->data();
+    CORRADE_COMPARE(data.size(), 375888/4);
+    const Containers::ArrayView<const Short> shorts = Containers::arrayCast<const Short>(data);
+    const Double expected[]{0.0, 0.0, 0.0, 0.0, 3.0517578125e-05, 6.103515625e-05, -9.1552734375e-05, 0.0};
+    for(std::size_t i = 0; i != Containers::arraySize(expected); ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE_WITH(Math::unpack<Float>(shorts[i]), Float(expected[i]),
+            TestSuite::Compare::around(1.0f/32767.0f));
+    }
+}
+
+void WavImporterTest::pcm16Mono16() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+    CORRADE_VERIFY(importer->openFile(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "mono16be.wav")));
+
+    /* Formats that are already 16-bit are passed through unchanged */
+    CORRADE_COMPARE(importer->format(), BufferFormat::Mono16);
+    CORRADE_COMPARE_AS(Containers::arrayCast<UnsignedShort>(importer->data()),
+        Containers::arrayView<UnsignedShort>({0x101d, 0xc571}),
+        TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16ReadFrames() {
+    auto&& data = Pcm16Data[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->configuration().setValue("pcm16", true);
+
+    const std::string filename = Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, data.filename);
+    if(data.openData)
+        CORRADE_VERIFY(importer->openData(Utility::Directory::read(filename)));
+    else
+        CORRADE_VERIFY(importer->openFile(filename));
+
+    const BufferFormat format = importer->format();
+    CORRADE_VERIFY(format == BufferFormat::Mono16 || format == BufferFormat::Stereo16);
+
+    Containers::Array<char> expected = importer->data();
+    const UnsignedInt frameSize = bufferFormatFrameSize(format);
+    CORRADE_COMPARE(importer->frameCount(), expected.size()/frameSize);
+
+    /* Read in chunks that don't divide the frame count to test the last
+       partial chunk as well */
+    Containers::Array<char> out{Containers::ValueInit, expected.size()};
+    Containers::Array<char> chunk{Containers::NoInit, 7*frameSize};
+    std::size_t offset = 0;
+    while(const std::size_t count = importer->readFrames(offset, chunk)) {
+        std::copy(chunk.begin(), chunk.begin() + count*frameSize, out.begin() + offset*frameSize);
+        offset += count;
+    }
+    CORRADE_COMPARE(offset, importer->frameCount());
+    CORRADE_COMPARE_AS(out, expected, TestSuite::Compare::Container);
+}
+
+void WavImporterTest::pcm16ZeroCopy() {
+    Containers::Pointer<AbstractImporter> importer = _manager.instantiate("WavAudioImporter");
+    importer->setFlags(ImporterFlag::ZeroCopy);
+    importer->configuration().setValue("pcm16", true);
+
+    const Containers::Array<char> file = Utility::Directory::read(Utility::Directory::join(WAVAUDIOIMPORTER_TEST_DIR, "stereo8.wav"));
+    CORRADE_VERIFY(importer->openData(file));
+
+    /* The data need to be converted, so they're copied */
+    CORRADE_COMPARE(importer->format(), BufferFormat::Stereo16);
+    Containers::Array<char> data = importer->data();
+    CORRADE_VERIFY(!data.deleter());
+    CORRADE_COMPARE_AS(Containers::arrayCast<Short>(data),
+        Containers::arrayView<Short>({0x5e00, 0x7e00, 0x4a00, -0x0200}),
+        TestSuite::Compare::Container);
+}
+
 }}}}
 
 CORRADE_TEST_MAIN(Magnum::Audio::Test::WavImporterTest)
@@ -26,10 +26,18 @@
 
 #include "WavImporter.h"
 
+#include <cstring>
+#include <fstream>
+#include <Corrade/Containers/StridedArrayView.h>
 #include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Debug.h>
+#include <Corrade/Utility/DebugStl.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/EndiannessBatch.h>
 
+#include "Magnum/Math/Functions.h"
+#include "Magnum/Math/PackingBatch.h"
 #include "MagnumPlugins/WavAudioImporter/WavHeader.h"
 
 namespace Magnum { namespace Audio {
@@ -43,15 +51,80 @@ WavImporter::WavImporter() = default;
 
 WavImporter::WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
 
-ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData; }
+WavImporter::~WavImporter() = default;
 
-bool WavImporter::doIsOpened() const { return !!_data; }
+ImporterFeatures WavImporter::doFeatures() const { return ImporterFeature::OpenData|ImporterFeature::Streaming; }
+
+bool WavImporter::doIsOpened() const { return _data || _file; }
+
+namespace {
+
+/* How much of a file to read upfront when opening it for streaming. All
+   chunks before the data chunk are expected to fit in there, otherwise the
+   whole file is read. */
+constexpr std::size_t StreamingHeaderSize = 64*1024;
+
+/* G.711 decoders, used only to fill the lookup tables below */
+Short decodeALaw(UnsignedByte value) {
+    value ^= 0x55;
+    Int out = (value & 0x0f) << 4;
+    const Int segment = (value & 0x70) >> 4;
+    if(segment == 0) out += 8;
+    else out = (out + 0x108) << (segment - 1);
+    return Short((value & 0x80) ? out : -out);
+}
+
+Short decodeMuLaw(UnsignedByte value) {
+    value = ~value;
+    const Int out = (((value & 0x0f) << 3) + 0x84) << ((value & 0x70) >> 4);
+    return Short((value & 0x80) ? 0x84 - out : out - 0x84);
+}
+
+struct G711Tables {
+    explicit G711Tables() {
+        for(UnsignedInt i = 0; i != 256; ++i) {
+            aLaw[i] = decodeALaw(i);
+            muLaw[i] = decodeMuLaw(i);
+        }
+    }
+
+    Short aLaw[256];
+    Short muLaw[256];
+};
+
+const G711Tables& g711Tables() {
+    static const G711Tables tables;
+    return tables;
+}
+
+BufferFormat pcm16Format(const BufferFormat format) {
+    switch(format) {
+        case BufferFormat::Mono8:
+        case BufferFormat::MonoALaw:
+        case BufferFormat::MonoMuLaw:
+        case BufferFormat::MonoFloat:
+        case BufferFormat::MonoDouble:
+            return BufferFormat::Mono16;
+        case BufferFormat::Stereo8:
+        case BufferFormat::StereoALaw:
+        case BufferFormat::StereoMuLaw:
+        case BufferFormat::StereoFloat:
+        case BufferFormat::StereoDouble:
+            return BufferFormat::Stereo16;
+        default:
+            return format;
+    }
+}
+
+}
+
+bool WavImporter::parseHeaders(const Containers::ArrayView<const char> data, const std::size_t fileSize, bool& incomplete) {
+    incomplete = false;
 
-void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Check file size */
-    if(data.size() < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
-        Error() << "Audio::WavImporter::openData(): the file is too short:" << data.size() << "bytes";
-        return;
+    if(fileSize < sizeof(WavHeaderChunk) + sizeof(WavFormatChunk) + sizeof(RiffChunk)) {
+        Error() << "Audio::WavImporter::openData(): the file is too short:" << fileSize << "bytes";
+        return false;
     }
 
     /* Get the RIFF/WAV header */
@@ -61,7 +134,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     if((std::strncmp(header.chunk.chunkId, "RIFF", 4) != 0 && std::strncmp(header.chunk.chunkId, "RIFX", 4) != 0) ||
        std::strncmp(header.format, "WAVE", 4) != 0) {
         Error() << "Audio::WavImporter::openData(): the file signature is invalid";
-        return;
+        return false;
     }
 
     /* Check if the file is Big-Endian. While RIFX files are extremely rare,
@@ -73,10 +146,10 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         Utility::Endianness::swapInPlace(header.chunk.chunkSize);
 
     /* Check file size */
-    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != data.size()) {
+    if(header.chunk.chunkSize < 36 || header.chunk.chunkSize + 8 != fileSize) {
         Error() << "Audio::WavImporter::openData(): the file has improper size, expected"
-                << header.chunk.chunkSize + 8 << "but got" << data.size();
-        return;
+                << header.chunk.chunkSize + 8 << "but got" << fileSize;
+        return false;
     }
 
     const RiffChunk* dataChunk = nullptr;
@@ -90,6 +163,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
 
     /* Skip any chunks that aren't the format or data chunk */
     while(headerSize + offset <= header.chunk.chunkSize) {
+        /* If the data is just a prefix of the file, the chunk headers might
+           not fit into it. Let the caller read more. */
+        if(headerSize + offset + sizeof(WavFormatChunk) > data.size() && data.size() != fileSize) {
+            incomplete = true;
+            return false;
+        }
+
         const RiffChunk* currChunk = reinterpret_cast<const RiffChunk*>(data.begin() + headerSize + offset);
         UnsignedInt chunkSize = currChunk->chunkSize;
         if(hasBigEndianData != Utility::Endianness::isBigEndian())
@@ -100,7 +180,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         if(std::strncmp(currChunk->chunkId, "fmt ", 4) == 0) {
             if(formatChunk) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many format chunks";
-                return;
+                return false;
             }
 
             formatChunk = WavFormatChunk{*reinterpret_cast<const WavFormatChunk*>(currChunk)};
@@ -108,7 +188,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
         } else if(std::strncmp(currChunk->chunkId, "data", 4) == 0) {
             if(dataChunk != nullptr) {
                 Error() << "Audio::WavImporter::openData(): the file contains too many data chunks";
-                return;
+                return false;
             }
 
             dataChunk = currChunk;
@@ -120,13 +200,13 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
     /* Make sure we actually got a format chunk */
     if(!formatChunk) {
         Error() << "Audio::WavImporter::openData(): the file contains no format chunk";
-        return;
+        return false;
     }
 
     /* Make sure we actually got a data chunk */
     if(dataChunk == nullptr) {
         Error() << "Audio::WavImporter::openData(): the file contains no data chunk";
-        return;
+        return false;
     }
 
     /* Fix endianness on Format chunk */
@@ -152,7 +232,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): PCM with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check IEEE Float format */
@@ -169,7 +249,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): IEEE with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check A-Law format */
@@ -182,7 +262,7 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): ALaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Check μ-Law format */
@@ -195,58 +275,221 @@ void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
             Error() << "Audio::WavImporter::openData(): MuLaw with unsupported channel count"
                     << formatChunk->numChannels << "with" << formatChunk->bitsPerSample
                     << "bits per sample";
-            return;
+            return false;
         }
 
     /* Unknown/unimplemented format */
     } else {
         Error() << "Audio::WavImporter::openData(): unsupported format" << formatChunk->audioFormat;
-        return;
+        return false;
     }
 
     /* Size sanity checks */
-    if(headerSize + offset > data.size()) {
+    if(headerSize + offset > fileSize) {
         Error() << "Audio::WavImporter::openData(): file size doesn't match computed size";
-        return;
+        return false;
     }
 
     /* Format sanity checks */
     if(formatChunk->blockAlign != formatChunk->numChannels * formatChunk->bitsPerSample / 8 ||
        formatChunk->byteRate != formatChunk->sampleRate * formatChunk->blockAlign) {
         Error() << "Audio::WavImporter::openData(): the file is corrupted";
-        return;
+        return false;
     }
 
-    /* Save frequency */
+    /* Save frequency and data location */
     _frequency = formatChunk->sampleRate;
+    _bitsPerSample = formatChunk->bitsPerSample;
+    _swapEndianness = hasBigEndianData != Utility::Endianness::isBigEndian();
+    _dataOffset = reinterpret_cast<const char*>(dataChunk + 1) - data.data();
+    _dataSize = dataChunkSize;
+
+    /* Decide about the format the data get converted to, if any */
+    _fileFormat = _format;
+    if(configuration().value<bool>("pcm16"))
+        _format = pcm16Format(_format);
 
-    /* Copy the data */
-    const char* dataChunkPtr = reinterpret_cast<const char*>(dataChunk + 1);
-    _data = Containers::Array<char>(dataChunkSize);
-    std::copy(dataChunkPtr, dataChunkPtr+dataChunkSize, _data->begin());
-
-    /* Fix the data endianness */
-    if(hasBigEndianData != Utility::Endianness::isBigEndian()) {
-        if(formatChunk->bitsPerSample == 16)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(*_data));
-        else if(formatChunk->bitsPerSample == 32)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(*_data));
-        else if(formatChunk->bitsPerSample == 64)
-            Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(*_data));
-        else CORRADE_INTERNAL_ASSERT(formatChunk->bitsPerSample == 8);
+    return true;
+}
+
+void WavImporter::swapEndianness(const Containers::ArrayView<char> data) const {
+    if(!_swapEndianness) return;
+
+    if(_bitsPerSample == 16)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint16_t>(data));
+    else if(_bitsPerSample == 32)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint32_t>(data));
+    else if(_bitsPerSample == 64)
+        Utility::Endianness::swapInPlace(Containers::arrayCast<std::uint64_t>(data));
+    else CORRADE_INTERNAL_ASSERT(_bitsPerSample == 8);
+}
+
+void WavImporter::decode(const Containers::ArrayView<const char> data, const Containers::ArrayView<char> out) const {
+    const Containers::ArrayView<Short> outShort = Containers::arrayCast<Short>(out);
+
+    /* Both A-Law and μ-Law are just a 256-entry table lookup */
+    if(_fileFormat == BufferFormat::MonoALaw || _fileFormat == BufferFormat::StereoALaw ||
+       _fileFormat == BufferFormat::MonoMuLaw || _fileFormat == BufferFormat::StereoMuLaw) {
+        CORRADE_INTERNAL_ASSERT(outShort.size() == data.size());
+        const Short* const table =
+            _fileFormat == BufferFormat::MonoALaw || _fileFormat == BufferFormat::StereoALaw ?
+                g711Tables().aLaw : g711Tables().muLaw;
+        for(std::size_t i = 0; i != data.size(); ++i)
+            outShort[i] = table[UnsignedByte(data[i])];
+
+    /* 8-bit PCM is unsigned, centered around 128 */
+    } else if(_fileFormat == BufferFormat::Mono8 || _fileFormat == BufferFormat::Stereo8) {
+        CORRADE_INTERNAL_ASSERT(outShort.size() == data.size());
+        for(std::size_t i = 0; i != data.size(); ++i)
+            outShort[i] = Short((Int(UnsignedByte(data[i])) - 128)*256);
+
+    /* Floats get clamped to the [-1, 1] range and then packed. Doubles are
+       converted to floats first, which is all the precision 16 bits need. */
+    } else {
+        Containers::Array<Float> scratch{Containers::NoInit, outShort.size()};
+        if(_fileFormat == BufferFormat::MonoFloat || _fileFormat == BufferFormat::StereoFloat) {
+            const Containers::ArrayView<const Float> in = Containers::arrayCast<const Float>(data);
+            CORRADE_INTERNAL_ASSERT(in.size() == scratch.size());
+            for(std::size_t i = 0; i != in.size(); ++i)
+                scratch[i] = Math::clamp(in[i], -1.0f, 1.0f);
+        } else {
+            CORRADE_INTERNAL_ASSERT(_fileFormat == BufferFormat::MonoDouble || _fileFormat == BufferFormat::StereoDouble);
+            const Containers::ArrayView<const Double> in = Containers::arrayCast<const Double>(data);
+            CORRADE_INTERNAL_ASSERT(in.size() == scratch.size());
+            for(std::size_t i = 0; i != in.size(); ++i)
+                scratch[i] = Float(Math::clamp(in[i], -1.0, 1.0));
+        }
+
+        Math::packInto(Containers::StridedArrayView2D<const Float>{scratch, {scratch.size(), 1}},
+            Containers::StridedArrayView2D<Short>{outShort, {outShort.size(), 1}});
+    }
+}
+
+void WavImporter::doOpenData(Containers::ArrayView<const char> data) {
+    bool incomplete;
+    if(!parseHeaders(data, data.size(), incomplete)) return;
+
+    /* If the data don't need any endian swapping or conversion and the user
+       guarantees the memory stays around, reference them directly */
+    if((flags() & ImporterFlag::ZeroCopy) && !_swapEndianness && _format == _fileFormat) {
+        _data = Containers::Array<char>{const_cast<char*>(data.data()) + _dataOffset, _dataSize, Implementation::nonOwnedArrayDeleter};
+        _zeroCopy = true;
+        return;
+    }
+
+    /* Copy the data and fix their endianness */
+    _data = Containers::Array<char>(_dataSize);
+    std::copy(data.begin() + _dataOffset, data.begin() + _dataOffset + _dataSize, _data->begin());
+    swapEndianness(*_data);
+    _zeroCopy = false;
+
+    /* Convert the data if requested */
+    if(_format != _fileFormat) {
+        Containers::Array<char> decoded{Containers::NoInit, _dataSize/bufferFormatFrameSize(_fileFormat)*bufferFormatFrameSize(_format)};
+        decode(*_data, decoded);
+        _data = std::move(decoded);
+    }
+}
+
+void WavImporter::doOpenFile(const std::string& filename) {
+    /* Parse just the headers and keep the file open for streaming the data
+       in readFrames() */
+    Containers::Pointer<std::ifstream> file{new std::ifstream{filename, std::ios::binary}};
+    if(!*file) {
+        Error() << "Audio::WavImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+
+    file->seekg(0, std::ios::end);
+    const std::size_t fileSize = file->tellg();
+    file->seekg(0, std::ios::beg);
+    Containers::Array<char> header{Containers::NoInit, Math::min(fileSize, StreamingHeaderSize)};
+    file->read(header.data(), header.size());
+
+    bool incomplete;
+    if(!parseHeaders(header, fileSize, incomplete)) {
+        /* If the chunks before the data don't fit into the header, read the
+           whole file and go through openData() instead */
+        if(incomplete) doOpenData(Utility::Directory::read(filename));
+        return;
     }
+
+    _file = std::move(file);
 }
 
-void WavImporter::doClose() { _data = Containers::NullOpt; }
+void WavImporter::doClose() {
+    _data = Containers::NullOpt;
+    _file = nullptr;
+    _scratch = nullptr;
+    _zeroCopy = false;
+}
 
 BufferFormat WavImporter::doFormat() const { return _format; }
 
 UnsignedInt WavImporter::doFrequency() const { return _frequency; }
 
 Containers::Array<char> WavImporter::doData() {
-    Containers::Array<char> copy(_data->size());
-    std::copy(_data->begin(), _data->end(), copy.begin());
-    return copy;
+    if(_zeroCopy)
+        return Containers::Array<char>{_data->data(), _data->size(), Implementation::nonOwnedArrayDeleter};
+
+    if(_data) {
+        Containers::Array<char> copy{Containers::NoInit, _data->size()};
+        std::copy(_data->begin(), _data->end(), copy.begin());
+        return copy;
+    }
+
+    Containers::Array<char> out{Containers::NoInit, _dataSize};
+    _file->clear();
+    _file->seekg(_dataOffset, std::ios::beg);
+    if(!_file->read(out.data(), out.size())) {
+        Error() << "Audio::WavImporter::data(): cannot read the file";
+        return nullptr;
+    }
+    swapEndianness(out);
+    if(_format == _fileFormat) return out;
+
+    Containers::Array<char> decoded{Containers::NoInit, _dataSize/bufferFormatFrameSize(_fileFormat)*bufferFormatFrameSize(_format)};
+    decode(out, decoded);
+    return decoded;
+}
+
+std::size_t WavImporter::doFrameCount() {
+    return _dataSize/bufferFormatFrameSize(_fileFormat);
+}
+
+std::size_t WavImporter::doReadFrames(const std::size_t offset, const Containers::ArrayView<char> data) {
+    const std::size_t frameSize = bufferFormatFrameSize(_format);
+    const std::size_t frameCount = doFrameCount();
+    if(offset >= frameCount) return 0;
+    const std::size_t count = Math::min(data.size()/frameSize, frameCount - offset);
+    const Containers::ArrayView<char> out = data.prefix(count*frameSize);
+
+    /* Data opened from memory are already converted */
+    if(_data) {
+        std::memcpy(out.data(), _data->data() + offset*frameSize, out.size());
+        return count;
+    }
+
+    /* If converting, read the file data into a scratch buffer first. It's
+       kept around to avoid allocating on every call when streaming. */
+    const std::size_t fileFrameSize = bufferFormatFrameSize(_fileFormat);
+    Containers::ArrayView<char> in = out;
+    if(_format != _fileFormat) {
+        if(_scratch.size() < count*fileFrameSize)
+            _scratch = Containers::Array<char>{Containers::NoInit, count*fileFrameSize};
+        in = _scratch.prefix(count*fileFrameSize);
+    }
+
+    /* Clear the EOF bit potentially set by a previous read */
+    _file->clear();
+    _file->seekg(_dataOffset + offset*fileFrameSize, std::ios::beg);
+    if(!_file->read(in.data(), in.size())) {
+        Error() << "Audio::WavImporter::readFrames(): cannot read the file";
+        return 0;
+    }
+    swapEndianness(in);
+    if(_format != _fileFormat) decode(in, out);
+    return count;
 }
 
 }}
@@ -30,8 +30,10 @@
  * @brief Class @ref Magnum::Audio::WavImporter
  */
 
+#include <iosfwd>
 #include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
+#include <Corrade/Containers/Pointer.h>
 
 #include "Magnum/Audio/AbstractImporter.h"
 
@@ -108,6 +110,45 @@ See @ref building, @ref cmake and @ref plugins for more information.
 @section Audio-WavImporter-limitations Behavior and limitations
 
 Multi-channel formats are not supported.
+
+The plugin supports @ref ImporterFeature::Streaming. When opened via
+@ref openFile(), only the headers are parsed and the file is kept open, with
+@ref readFrames() reading just the requested range and @ref data() reading
+the whole data chunk on every call. This makes it suitable for long tracks
+played through @ref StreamPlayer. If the chunks preceding the data chunk
+don't fit into the first 64 kB of the file, the whole file is read into
+memory instead. Data opened via @ref openData() are copied and then served
+from memory.
+
+The plugin supports @ref ImporterFlag::ZeroCopy. If it's set and a file is
+opened with @ref openData(), @ref data() and @ref readFrames() reference the
+sample data in the passed memory instead of copying them, as all supported
+formats can be passed to @ref Buffer::setData() directly. The only exception
+are files with a different endianness than the machine, which have to be
+converted and thus are always copied.
+
+@section Audio-WavImporter-pcm16 Conversion to 16-bit PCM
+
+Not all OpenAL implementations support the A-Law, μ-Law and floating-point
+formats, and those that do often convert them in software on every playback.
+With the @cb{.ini} pcm16 @ce @ref Audio-WavImporter-configuration "configuration option"
+enabled, 8-bit PCM, A-Law, μ-Law and floating-point files are converted
+on import to @ref BufferFormat::Mono16 / @ref BufferFormat::Stereo16, which
+every implementation handles natively. A-Law and μ-Law samples are decoded
+through a 256-entry lookup table, floating-point samples are clamped to the
+@f$ [-1, 1] @f$ range and packed using @ref Math::packInto(). The conversion
+is done also for data streamed via @ref readFrames(), with
+@ref frameCount() staying the same. @ref ImporterFlag::ZeroCopy has no effect
+on converted files.
+
+@section Audio-WavImporter-configuration Plugin-specific configuration
+
+It's possible to tune various import options through @ref configuration().
+See below for all options and their default values:
+
+@snippet MagnumPlugins/WavAudioImporter/WavAudioImporter.conf configuration_
+
+See @ref plugins-configuration for more information.
 */
 class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
     public:
@@ -117,19 +158,41 @@ class MAGNUM_WAVAUDIOIMPORTER_EXPORT WavImporter: public AbstractImporter {
         /** @brief Plugin manager constructor */
         explicit WavImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        ~WavImporter();
+
     private:
         MAGNUM_WAVAUDIOIMPORTER_LOCAL ImporterFeatures doFeatures() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL void doClose() override;
 
         MAGNUM_WAVAUDIOIMPORTER_LOCAL BufferFormat doFormat() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL UnsignedInt doFrequency() const override;
         MAGNUM_WAVAUDIOIMPORTER_LOCAL Containers::Array<char> doData() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doFrameCount() override;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL std::size_t doReadFrames(std::size_t offset, Containers::ArrayView<char> data) override;
+
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL bool parseHeaders(Containers::ArrayView<const char> data, std::size_t fileSize, bool& incomplete);
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void swapEndianness(Containers::ArrayView<char> data) const;
+        MAGNUM_WAVAUDIOIMPORTER_LOCAL void decode(Containers::ArrayView<const char> data, Containers::ArrayView<char> out) const;
 
+        /* Either the whole decoded data if opened via openData() (or a view
+           on the input with ImporterFlag::ZeroCopy) or a file the data are
+           streamed from if opened via openFile() */
         Containers::Optional<Containers::Array<char>> _data;
-        BufferFormat _format;
+        Containers::Pointer<std::ifstream> _file;
+        /* File data read by readFrames() before converting them, if the
+           pcm16 option is enabled */
+        Containers::Array<char> _scratch;
+        /* _format is what's reported to the user, _fileFormat is what the
+           file contains. They differ only with the pcm16 option enabled. */
+        BufferFormat _format, _fileFormat;
         UnsignedInt _frequency;
+        UnsignedInt _bitsPerSample;
+        bool _swapEndianness;
+        bool _zeroCopy{};
+        std::size_t _dataOffset, _dataSize;
 };
 
 }}